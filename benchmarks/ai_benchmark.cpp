@@ -0,0 +1,173 @@
+/// @file ai_benchmark.cpp
+/// @brief Stress benchmarks for AISystem at open-world scale.
+///
+/// Every agent runs the same three-branch tree built from the built-in
+/// tasks: flee from its top threat when below 30% health, attack its
+/// blackboard target when it has one, patrol four waypoints otherwise.
+/// One agent in ten flees and three attack; the rest patrol.  Nothing
+/// moves the agents, so each keeps its branch and the work per tick
+/// stays constant.
+///
+/// Agents share one tree or each own a copy, which AISystem compiles
+/// and batches separately.  Times are per 50 ms frame; "updated" is the
+/// brains ticked per frame, and "allocs"/"allocBytes" the heap activity
+/// per frame after the timed loop.
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "alloc_counter.hpp"
+#include "cgs/ecs/component_storage.hpp"
+#include "cgs/ecs/entity.hpp"
+#include "cgs/game/ai_components.hpp"
+#include "cgs/game/ai_system.hpp"
+#include "cgs/game/behavior_tree.hpp"
+#include "cgs/game/combat_components.hpp"
+#include "cgs/game/components.hpp"
+#include "cgs/game/math_types.hpp"
+
+using namespace cgs::ecs;
+using namespace cgs::game;
+
+namespace {
+
+constexpr int64_t kFrameMs = 50;
+constexpr float kFrameSeconds = static_cast<float>(kFrameMs) / 1000.0f;
+constexpr float kAreaPerAgent = 100.0f;
+constexpr uint32_t kAgentsPerPlayer = 100;
+constexpr int kCountedFrames = 8;
+
+/// Tree instancing.
+enum TreeMode : int64_t { kShared = 0, kCloned = 1 };
+
+const BlackboardKey<Entity> kTarget("target");
+
+/// @p count agents and one player per kAgentsPerPlayer of them, driven
+/// by an AISystem ticking every @p intervalMs.
+class Scenario {
+public:
+    Scenario(std::size_t count, int64_t intervalMs, int64_t treeMode)
+        : ai_(brains_, transforms_, movements_, stats_, threatLists_,
+              static_cast<float>(intervalMs) / 1000.0f) {
+        const float interval = ai_.GetDefaultTickInterval();
+        const float size = std::sqrt(static_cast<float>(count) * kAreaPerAgent);
+        std::mt19937 rng(24);
+        std::uniform_real_distribution<float> coord(0.0f, size);
+        std::uniform_real_distribution<float> offset(-15.0f, 15.0f);
+
+        const auto players = static_cast<uint32_t>(count / kAgentsPerPlayer) + 1;
+        const auto firstPlayer = static_cast<uint32_t>(count);
+        for (uint32_t p = 0; p < players; ++p) {
+            Entity e(firstPlayer + p, 0);
+            transforms_.Add(e, Transform{{coord(rng), 0.0f, coord(rng)}, {}, {1.0f, 1.0f, 1.0f}});
+            stats_.Add(e, Stats{1000, 1000, 0, 0, {}});
+        }
+
+        std::shared_ptr<BTNode> shared = buildTree();
+        for (std::size_t i = 0; i < count; ++i) {
+            Entity e(static_cast<uint32_t>(i), 0);
+            const Entity player(firstPlayer + static_cast<uint32_t>(i / kAgentsPerPlayer), 0);
+            const Vector3& playerPos = transforms_.Get(player).position;
+
+            AIBrain brain;
+            brain.behaviorTree = treeMode == kCloned ? buildTree() : shared;
+            int32_t health = 100;
+            Vector3 position(coord(rng), 0.0f, coord(rng));
+            if (i % 10 == 0) {
+                // Fleeing: hurt, and its top threat is close.
+                health = 20;
+                position = playerPos + Vector3(5.0f, 0.0f, 0.0f);
+                ThreatList threats;
+                threats.AddThreat(player, 100.0f);
+                threatLists_.Add(e, std::move(threats));
+            } else if (i % 10 <= 3) {
+                // Attacking: its target is in range.
+                position = playerPos + Vector3(1.0f, 0.0f, 1.0f);
+                brain.blackboard.Set(kTarget, player);
+            } else {
+                std::vector<Vector3> waypoints{position + Vector3(offset(rng), 0.0f, 0.0f),
+                                               position + Vector3(0.0f, 0.0f, offset(rng)),
+                                               position - Vector3(offset(rng), 0.0f, 0.0f),
+                                               position - Vector3(0.0f, 0.0f, offset(rng))};
+                brain.blackboard.Set("waypoints", std::move(waypoints));
+                brain.blackboard.Set("patrol_index", std::size_t{0});
+            }
+            brain.homePosition = position;
+            // Spread the brains over their interval, as spawns would be.
+            brain.timeSinceLastTick = interval * static_cast<float>(i % 64) / 64.0f;
+
+            transforms_.Add(e, Transform{position, {}, {1.0f, 1.0f, 1.0f}});
+            movements_.Add(e, Movement{4.0f, 4.0f, {}, MovementState::Idle});
+            stats_.Add(e, Stats{health, 100, 0, 0, {}});
+            brains_.Add(e, std::move(brain));
+        }
+
+        // Compile the trees and lay out tree state before timing.
+        const int64_t warmup = intervalMs / kFrameMs + 1;
+        for (int64_t frame = 0; frame < warmup; ++frame) {
+            ai_.Execute(kFrameSeconds);
+        }
+    }
+
+    void tick() { ai_.Execute(kFrameSeconds); }
+
+    [[nodiscard]] const AISystem& ai() const { return ai_; }
+
+private:
+    std::shared_ptr<BTNode> buildTree() {
+        const auto& stats = stats_;
+
+        auto flee = std::make_unique<BTSequence>();
+        flee->AddChild(std::make_unique<BTCondition>([&stats](BTContext& ctx) {
+            const auto& s = stats.Get(ctx.entity);
+            return s.health * 10 < s.maxHealth * 3;
+        }));
+        flee->AddChild(ai_.CreateFleeTask());
+
+        auto attack = std::make_unique<BTSequence>();
+        attack->AddChild(std::make_unique<BTCondition>(
+            [](BTContext& ctx) { return ctx.blackboard->Has(kTarget); }));
+        attack->AddChild(ai_.CreateAttackTask());
+
+        auto root = std::make_shared<BTSelector>();
+        root->AddChild(std::move(flee));
+        root->AddChild(std::move(attack));
+        root->AddChild(ai_.CreatePatrolTask());
+        return root;
+    }
+
+    ComponentStorage<AIBrain> brains_;
+    ComponentStorage<Transform> transforms_;
+    ComponentStorage<Movement> movements_;
+    ComponentStorage<Stats> stats_;
+    ComponentStorage<ThreatList> threatLists_;
+    AISystem ai_;
+};
+
+/// Args: agents, tick interval (ms), tree mode.
+void BM_AI_Tick(benchmark::State& state) {
+    Scenario scenario(static_cast<std::size_t>(state.range(0)), state.range(1), state.range(2));
+    int64_t updated = 0;
+    for (auto _ : state) {
+        scenario.tick();
+        updated += scenario.ai().GetLastTickUpdateCount();
+    }
+    cgs_bench::countAllocations(state, kCountedFrames, [&] { scenario.tick(); });
+    state.SetItemsProcessed(updated);
+    state.counters["updated"] =
+        benchmark::Counter(static_cast<double>(updated), benchmark::Counter::kAvgIterations);
+    state.counters["trees"] = static_cast<double>(scenario.ai().CompiledTreeCount());
+}
+BENCHMARK(BM_AI_Tick)
+    ->ArgNames({"agents", "intervalMs", "cloned"})
+    ->ArgsProduct({{10000, 100000}, {50, 200, 1000}, {kShared, kCloned}})
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace
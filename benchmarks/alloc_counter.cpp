@@ -0,0 +1,185 @@
+/// @file alloc_counter.cpp
+/// @brief Global operator new/delete with optional accounting, and the
+///        benchmark::MemoryManager that reports it.
+///
+/// Every block carries a small header with its size and whether it was
+/// counted, so frees of counted blocks can be subtracted from the live
+/// total.  The over-aligned forms keep the library versions and are not
+/// counted.
+
+#include "alloc_counter.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+struct BlockHeader {
+    std::size_t size;
+    bool counted;
+};
+
+constexpr std::size_t kHeader = alignof(std::max_align_t);
+static_assert(sizeof(BlockHeader) <= kHeader);
+
+std::atomic<int> gCounting{0};  // Open AllocScopes plus the MemoryManager run.
+std::atomic<int64_t> gAllocations{0};
+std::atomic<int64_t> gBytes{0};
+std::atomic<int64_t> gLive{0};
+std::atomic<int64_t> gPeak{0};
+
+void resetCounters() {
+    gAllocations.store(0, std::memory_order_relaxed);
+    gBytes.store(0, std::memory_order_relaxed);
+    gLive.store(0, std::memory_order_relaxed);
+    gPeak.store(0, std::memory_order_relaxed);
+}
+
+void* allocate(std::size_t size) noexcept {
+    auto* block = static_cast<unsigned char*>(std::malloc(size + kHeader));
+    if (block == nullptr) {
+        return nullptr;
+    }
+    auto* header = new (block) BlockHeader{size, gCounting.load(std::memory_order_relaxed) != 0};
+    if (header->counted) {
+        const auto bytes = static_cast<int64_t>(size);
+        gAllocations.fetch_add(1, std::memory_order_relaxed);
+        gBytes.fetch_add(bytes, std::memory_order_relaxed);
+        const int64_t live = gLive.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        int64_t peak = gPeak.load(std::memory_order_relaxed);
+        while (live > peak && !gPeak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+        }
+    }
+    return block + kHeader;
+}
+
+void* allocateOrThrow(std::size_t size) {
+    void* p = allocate(size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void release(void* p) noexcept {
+    if (p == nullptr) {
+        return;
+    }
+    auto* block = static_cast<unsigned char*>(p) - kHeader;
+    const auto* header = std::launder(static_cast<const BlockHeader*>(static_cast<void*>(block)));
+    if (header->counted && gCounting.load(std::memory_order_relaxed) != 0) {
+        gLive.fetch_sub(static_cast<int64_t>(header->size), std::memory_order_relaxed);
+    }
+    std::free(block);
+}
+
+/// Reports the instrumented run of each benchmark.
+class CountingMemoryManager final : public benchmark::MemoryManager {
+public:
+    void Start() override {
+        resetCounters();
+        gCounting.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    void Stop(Result& result) override {
+        gCounting.fetch_sub(1, std::memory_order_acq_rel);
+        result.num_allocs = gAllocations.load(std::memory_order_relaxed);
+        result.max_bytes_used = gPeak.load(std::memory_order_relaxed);
+        result.total_allocated_bytes = gBytes.load(std::memory_order_relaxed);
+        result.net_heap_growth = gLive.load(std::memory_order_relaxed);
+    }
+
+    // Google Benchmark before 1.8 calls the pointer form.
+    void Stop(Result* result) { Stop(*result); }
+};
+
+CountingMemoryManager gManager;
+
+[[maybe_unused]] const bool gRegistered = [] {
+    benchmark::RegisterMemoryManager(&gManager);
+    return true;
+}();
+
+}  // namespace
+
+namespace cgs_bench {
+
+namespace {
+
+AllocStats snapshot() {
+    AllocStats stats;
+    stats.allocations = gAllocations.load(std::memory_order_relaxed);
+    stats.bytes = gBytes.load(std::memory_order_relaxed);
+    stats.liveBytes = gLive.load(std::memory_order_relaxed);
+    return stats;
+}
+
+}  // namespace
+
+// Totals are never reset while counting, so a scope reports the
+// difference from the totals at its start.
+AllocScope::AllocScope() {
+    gCounting.fetch_add(1, std::memory_order_acq_rel);
+    start_ = snapshot();
+}
+
+AllocScope::~AllocScope() {
+    gCounting.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+AllocStats AllocScope::stats() const {
+    const AllocStats now = snapshot();
+    AllocStats stats;
+    stats.allocations = now.allocations - start_.allocations;
+    stats.bytes = now.bytes - start_.bytes;
+    stats.liveBytes = now.liveBytes - start_.liveBytes;
+    return stats;
+}
+
+}  // namespace cgs_bench
+
+// ── Replaced global allocation functions ────────────────────────────────
+
+void* operator new(std::size_t size) {
+    return allocateOrThrow(size);
+}
+
+void* operator new[](std::size_t size) {
+    return allocateOrThrow(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void operator delete(void* p) noexcept {
+    release(p);
+}
+
+void operator delete[](void* p) noexcept {
+    release(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    release(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    release(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+    release(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+    release(p);
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+/// @file alloc_counter.hpp
+/// @brief Heap accounting for the microbenchmarks.
+///
+/// alloc_counter.cpp replaces the global operator new/delete of the
+/// cgs_benchmarks binary and registers a benchmark::MemoryManager, so
+/// every benchmark's JSON entry carries allocs_per_iter, max_bytes_used
+/// and total_allocated_bytes from one extra instrumented run of the
+/// benchmark function (its setup included).  AllocScope measures a
+/// narrower region, e.g. a few untimed ticks after the timed loop.
+/// Counting is off outside those, so it does not slow timed iterations.
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+namespace cgs_bench {
+
+/// Heap activity between AllocScope construction and stats(), on all
+/// threads.
+struct AllocStats {
+    int64_t allocations = 0;  ///< Calls to operator new.
+    int64_t bytes = 0;        ///< Bytes requested by those calls.
+    int64_t liveBytes = 0;    ///< Bytes allocated minus bytes freed.
+};
+
+/// Counts heap activity while alive, e.g. to report the memory a
+/// structure holds after it is built.  Scopes may nest and may run
+/// inside the MemoryManager run.
+class AllocScope {
+public:
+    AllocScope();
+    ~AllocScope();
+
+    AllocScope(const AllocScope&) = delete;
+    AllocScope& operator=(const AllocScope&) = delete;
+
+    /// Activity so far.
+    [[nodiscard]] AllocStats stats() const;
+
+private:
+    AllocStats start_;
+};
+
+/// Run @p body @p runs times, untimed, and set the "allocs" and
+/// "allocBytes" counters of @p state to its heap activity per run.
+/// Call after the timed loop, so steady-state work is measured.
+template <typename Body>
+void countAllocations(benchmark::State& state, int runs, Body&& body) {
+    AllocScope scope;
+    for (int i = 0; i < runs; ++i) {
+        body();
+    }
+    const auto stats = scope.stats();
+    state.counters["allocs"] = static_cast<double>(stats.allocations) / runs;
+    state.counters["allocBytes"] = static_cast<double>(stats.bytes) / runs;
+}
+
+}  // namespace cgs_bench
@@ -0,0 +1,244 @@
+/// @file combat_benchmark.cpp
+/// @brief Stress benchmarks for CombatSystem in raid and PvP fights.
+///
+/// Three fights, each ticked at 20 Hz with damage published on an
+/// EventChannel as the game service does:
+///   - Boss: 40 raiders on one boss.  Every raider hits the boss each
+///     tick and keeps a DoT on it (40 auras on one holder, 40 threat
+///     entries); the boss cleaves five raiders, and each raider carries
+///     three raid buffs and the boss's DoT.
+///   - Siege: 200 players in two sides.  Each tick ten players cast an
+///     AoE that hits 20 players of the other side; everyone carries
+///     three auras.
+///   - AuraPvp: 200 players with twelve DoTs/HoTs each from other
+///     players, ticking every second, and 50 direct hits a tick.
+///
+/// Each tick re-applies a rotating twentieth of all auras, as recasts
+/// would, so auras refresh instead of expiring.  range(0) selects the
+/// per-tick aura scan (0) or the timer wheel (1).  Times are per tick;
+/// "hits" and "auras" are per tick and in total, and "allocs" /
+/// "allocBytes" the heap activity per tick after the timed loop.
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "alloc_counter.hpp"
+#include "cgs/ecs/component_storage.hpp"
+#include "cgs/ecs/entity.hpp"
+#include "cgs/ecs/event_channel.hpp"
+#include "cgs/game/combat_components.hpp"
+#include "cgs/game/combat_system.hpp"
+#include "cgs/game/components.hpp"
+
+using namespace cgs::ecs;
+using namespace cgs::game;
+
+namespace {
+
+constexpr float kTickSeconds = 0.05f;
+constexpr std::size_t kRefreshSlices = 20;
+constexpr int kCountedTicks = 8;
+
+/// A planned aura application.
+struct AuraCast {
+    Entity target;
+    AuraInstance aura;
+};
+
+/// A damage event sent every tick.
+struct Hit {
+    Entity attacker;
+    Entity victim;
+    DamageType type;
+};
+
+AuraInstance makeAura(uint32_t auraId, Entity caster, float tickInterval, int32_t tickDamage) {
+    AuraInstance aura;
+    aura.auraId = auraId;
+    aura.caster = caster;
+    aura.duration = 30.0f;
+    aura.remainingTime = aura.duration;
+    aura.tickInterval = tickInterval;
+    aura.tickTimer = tickInterval;
+    aura.tickDamage = tickDamage;
+    return aura;
+}
+
+/// Combatants, their planned auras and per-tick hits, and the
+/// CombatSystem that resolves them.
+class Fight {
+public:
+    explicit Fight(bool timerWheel)
+        : combat_(spellCasts_, auraHolders_, damageEvents_, stats_, threatLists_) {
+        combat_.SetDamageChannel(&damage_);
+        combat_.SetTimerWheel(timerWheel);
+    }
+
+    Entity spawn(int32_t health, bool threatList) {
+        const Entity e(next_++, 0);
+        Stats stats{health, health, 0, 0, {}};
+        stats.attributes[0] = 200;  // Armor.
+        stats_.Add(e, stats);
+        auraHolders_.Add(e, AuraHolder{});
+        spellCasts_.Add(e, SpellCast{});
+        if (threatList) {
+            threatLists_.Add(e, ThreatList{});
+        }
+        return e;
+    }
+
+    void aura(Entity target, const AuraInstance& aura) { auras_.push_back({target, aura}); }
+    void hit(Entity attacker, Entity victim, DamageType type) {
+        hits_.push_back({attacker, victim, type});
+    }
+
+    /// Apply every planned aura once.  Call after planning.
+    void start() {
+        for (const auto& cast : auras_) {
+            combat_.ApplyAura(cast.target, cast.aura);
+        }
+        tick();
+    }
+
+    void tick() {
+        for (std::size_t i = slice_; i < auras_.size(); i += kRefreshSlices) {
+            combat_.ApplyAura(auras_[i].target, auras_[i].aura);
+        }
+        slice_ = (slice_ + 1) % kRefreshSlices;
+
+        for (const auto& hit : hits_) {
+            damage_.Emplace(DamageEvent{hit.attacker, hit.victim, hit.type, 120, 0, false, false});
+        }
+        damage_.Swap();
+        combat_.Execute(kTickSeconds);
+    }
+
+    void report(benchmark::State& state) const {
+        state.counters["hits"] = static_cast<double>(hits_.size());
+        state.counters["auras"] = static_cast<double>(auras_.size());
+    }
+
+private:
+    ComponentStorage<SpellCast> spellCasts_;
+    ComponentStorage<AuraHolder> auraHolders_;
+    ComponentStorage<DamageEvent> damageEvents_;
+    ComponentStorage<Stats> stats_;
+    ComponentStorage<ThreatList> threatLists_;
+    EventChannel<DamageEvent> damage_;
+    CombatSystem combat_;
+
+    std::vector<AuraCast> auras_;
+    std::vector<Hit> hits_;
+    std::size_t slice_ = 0;
+    uint32_t next_ = 1;
+};
+
+void runFight(benchmark::State& state, Fight& fight) {
+    fight.start();
+    for (auto _ : state) {
+        fight.tick();
+    }
+    cgs_bench::countAllocations(state, kCountedTicks, [&] { fight.tick(); });
+    fight.report(state);
+}
+
+// ── Raid boss ───────────────────────────────────────────────────────────
+
+/// Args: timer wheel.
+void BM_Combat_Boss40v1(benchmark::State& state) {
+    constexpr uint32_t kRaiders = 40;
+    constexpr uint32_t kCleaveTargets = 5;
+
+    Fight fight(state.range(0) != 0);
+    const Entity boss = fight.spawn(50'000'000, true);
+    std::vector<Entity> raiders;
+    for (uint32_t r = 0; r < kRaiders; ++r) {
+        raiders.push_back(fight.spawn(30'000, false));
+    }
+
+    for (uint32_t r = 0; r < kRaiders; ++r) {
+        const Entity raider = raiders[r];
+        fight.aura(boss, makeAura(100 + r % 8, raider, 2.0f, 400));
+        for (uint32_t buff = 0; buff < 3; ++buff) {
+            fight.aura(raider, makeAura(200 + buff, raiders[buff], 1.0f, -50));
+        }
+        fight.aura(raider, makeAura(300, boss, 1.5f, 200));
+        fight.hit(raider, boss, r % 2 == 0 ? DamageType::Physical : DamageType::Fire);
+    }
+    for (uint32_t c = 0; c < kCleaveTargets; ++c) {
+        fight.hit(boss, raiders[c], DamageType::Physical);
+    }
+    runFight(state, fight);
+}
+BENCHMARK(BM_Combat_Boss40v1)->ArgName("timerWheel")->Arg(0)->Arg(1);
+
+// ── Siege ───────────────────────────────────────────────────────────────
+
+/// Args: timer wheel.
+void BM_Combat_Siege200(benchmark::State& state) {
+    constexpr uint32_t kPerSide = 100;
+    constexpr uint32_t kCasters = 10;
+    constexpr uint32_t kAoeTargets = 20;
+
+    Fight fight(state.range(0) != 0);
+    std::vector<Entity> sides[2];
+    for (uint32_t p = 0; p < 2 * kPerSide; ++p) {
+        sides[p % 2].push_back(fight.spawn(20'000, false));
+    }
+
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<uint32_t> pick(0, kPerSide - 1);
+    for (uint32_t side = 0; side < 2; ++side) {
+        const auto& own = sides[side];
+        const auto& enemy = sides[1 - side];
+        for (uint32_t p = 0; p < kPerSide; ++p) {
+            fight.aura(own[p], makeAura(400, own[pick(rng)], 0.0f, 0));
+            fight.aura(own[p], makeAura(401, own[pick(rng)], 1.0f, -40));
+            fight.aura(own[p], makeAura(402, enemy[pick(rng)], 2.0f, 150));
+        }
+        for (uint32_t c = 0; c < kCasters / 2; ++c) {
+            const Entity caster = own[pick(rng)];
+            const uint32_t first = pick(rng);
+            for (uint32_t t = 0; t < kAoeTargets; ++t) {
+                fight.hit(caster, enemy[(first + t) % kPerSide], DamageType::Fire);
+            }
+        }
+    }
+    runFight(state, fight);
+}
+BENCHMARK(BM_Combat_Siege200)->ArgName("timerWheel")->Arg(0)->Arg(1);
+
+// ── Aura-heavy PvP ──────────────────────────────────────────────────────
+
+/// Args: timer wheel.
+void BM_Combat_AuraPvp(benchmark::State& state) {
+    constexpr uint32_t kPlayers = 200;
+    constexpr uint32_t kAurasEach = 12;
+    constexpr uint32_t kHitsPerTick = 50;
+
+    Fight fight(state.range(0) != 0);
+    std::vector<Entity> players;
+    for (uint32_t p = 0; p < kPlayers; ++p) {
+        players.push_back(fight.spawn(25'000, false));
+    }
+
+    std::mt19937 rng(9);
+    std::uniform_int_distribution<uint32_t> pick(0, kPlayers - 1);
+    for (uint32_t p = 0; p < kPlayers; ++p) {
+        for (uint32_t a = 0; a < kAurasEach; ++a) {
+            const int32_t amount = a % 3 == 0 ? -60 : 90;  // One HoT per two DoTs.
+            fight.aura(players[p], makeAura(500 + a, players[pick(rng)], 1.0f, amount));
+        }
+    }
+    for (uint32_t h = 0; h < kHitsPerTick; ++h) {
+        fight.hit(players[pick(rng)], players[pick(rng)], DamageType::Shadow);
+    }
+    runFight(state, fight);
+}
+BENCHMARK(BM_Combat_AuraPvp)->ArgName("timerWheel")->Arg(0)->Arg(1);
+
+}  // namespace
@@ -0,0 +1,194 @@
+/// @file ecs_benchmark.cpp
+/// @brief Microbenchmarks for ComponentStorage<T> and Query<Includes...>.
+///
+/// Sizes are entity counts.  Query iteration is swept over one to five
+/// included storages; every entity has every component, so the numbers
+/// isolate the per-include cost of the join and the callback.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "cgs/ecs/component_storage.hpp"
+#include "cgs/ecs/entity.hpp"
+#include "cgs/ecs/entity_manager.hpp"
+#include "cgs/ecs/query.hpp"
+#include "cgs/game/components.hpp"
+
+using namespace cgs::ecs;
+using cgs::game::Transform;
+
+namespace {
+
+std::vector<Entity> makeEntities(EntityManager& manager, std::size_t count) {
+    std::vector<Entity> entities;
+    entities.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        entities.push_back(manager.Create());
+    }
+    return entities;
+}
+
+Transform makeTransform(std::size_t i) {
+    Transform t;
+    t.position = {static_cast<float>(i), 0.0f, static_cast<float>(i % 97)};
+    return t;
+}
+
+void setItems(benchmark::State& state, std::size_t perIteration) {
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(perIteration));
+}
+
+// ── ComponentStorage ────────────────────────────────────────────────────
+
+void BM_ComponentStorage_Add(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    EntityManager manager;
+    const auto entities = makeEntities(manager, count);
+
+    for (auto _ : state) {
+        ComponentStorage<Transform> storage;
+        for (std::size_t i = 0; i < count; ++i) {
+            storage.Add(entities[i], makeTransform(i));
+        }
+        benchmark::DoNotOptimize(storage.Size());
+    }
+    setItems(state, count);
+}
+BENCHMARK(BM_ComponentStorage_Add)->RangeMultiplier(10)->Range(1000, 100000);
+
+void BM_ComponentStorage_GetRandom(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    EntityManager manager;
+    auto entities = makeEntities(manager, count);
+    ComponentStorage<Transform> storage;
+    for (std::size_t i = 0; i < count; ++i) {
+        storage.Add(entities[i], makeTransform(i));
+    }
+    std::shuffle(entities.begin(), entities.end(), std::mt19937(42));
+
+    for (auto _ : state) {
+        float sum = 0.0f;
+        for (Entity e : entities) {
+            sum += storage.Get(e).position.x;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    setItems(state, count);
+}
+BENCHMARK(BM_ComponentStorage_GetRandom)->RangeMultiplier(10)->Range(1000, 100000);
+
+void BM_ComponentStorage_Iterate(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    EntityManager manager;
+    const auto entities = makeEntities(manager, count);
+    ComponentStorage<Transform> storage;
+    for (std::size_t i = 0; i < count; ++i) {
+        storage.Add(entities[i], makeTransform(i));
+    }
+
+    for (auto _ : state) {
+        for (auto& t : storage) {
+            t.position.x += 1.0f;
+        }
+        benchmark::ClobberMemory();
+    }
+    setItems(state, count);
+}
+BENCHMARK(BM_ComponentStorage_Iterate)->RangeMultiplier(10)->Range(1000, 100000);
+
+/// Add every entity, then remove them in random order (swap-and-pop).
+void BM_ComponentStorage_AddRemove(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    EntityManager manager;
+    const auto entities = makeEntities(manager, count);
+    auto order = entities;
+    std::shuffle(order.begin(), order.end(), std::mt19937(42));
+    ComponentStorage<Transform> storage;
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < count; ++i) {
+            storage.Add(entities[i], makeTransform(i));
+        }
+        for (Entity e : order) {
+            storage.Remove(e);
+        }
+        benchmark::DoNotOptimize(storage.Size());
+    }
+    setItems(state, count * 2);
+}
+BENCHMARK(BM_ComponentStorage_AddRemove)->RangeMultiplier(10)->Range(1000, 100000);
+
+// ── Query ───────────────────────────────────────────────────────────────
+
+/// Distinct component types for the include sweep.
+template <std::size_t N>
+struct Field {
+    float value = 1.0f;
+};
+
+template <std::size_t... I>
+void runQueryForEach(benchmark::State& state, std::index_sequence<I...>) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    EntityManager manager;
+    const auto entities = makeEntities(manager, count);
+    std::tuple<ComponentStorage<Field<I>>...> storages;
+    for (Entity e : entities) {
+        (std::get<I>(storages).Add(e), ...);
+    }
+    Query<Field<I>...> query(std::get<I>(storages)...);
+
+    for (auto _ : state) {
+        float sum = 0.0f;
+        query.ForEach([&sum](Entity, Field<I>&... fields) { sum += (fields.value + ...); });
+        benchmark::DoNotOptimize(sum);
+    }
+    setItems(state, count);
+}
+
+template <std::size_t Includes>
+void BM_Query_ForEach(benchmark::State& state) {
+    runQueryForEach(state, std::make_index_sequence<Includes>{});
+}
+BENCHMARK_TEMPLATE(BM_Query_ForEach, 1)->RangeMultiplier(10)->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_Query_ForEach, 2)->RangeMultiplier(10)->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_Query_ForEach, 3)->RangeMultiplier(10)->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_Query_ForEach, 4)->RangeMultiplier(10)->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_Query_ForEach, 5)->RangeMultiplier(10)->Range(1000, 100000);
+
+/// Query whose cached match list is dropped every pass by a structural
+/// change to one included storage, so each ForEach refreshes it.
+void BM_Query_ForEachAfterChange(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    EntityManager manager;
+    const auto entities = makeEntities(manager, count);
+    ComponentStorage<Field<0>> first;
+    ComponentStorage<Field<1>> second;
+    for (Entity e : entities) {
+        first.Add(e);
+        second.Add(e);
+    }
+    Query<Field<0>, Field<1>> query(first, second);
+    std::size_t next = 0;
+
+    for (auto _ : state) {
+        const Entity churn = entities[next];
+        next = (next + 1) % count;
+        second.Remove(churn);
+        second.Add(churn);
+
+        float sum = 0.0f;
+        query.ForEach([&sum](Entity, Field<0>& a, Field<1>& b) { sum += a.value + b.value; });
+        benchmark::DoNotOptimize(sum);
+    }
+    setItems(state, count);
+}
+BENCHMARK(BM_Query_ForEachAfterChange)->RangeMultiplier(10)->Range(1000, 100000);
+
+}  // namespace
@@ -0,0 +1,155 @@
+/// @file entity_handle_benchmark.cpp
+/// @brief Compact (24+8 bit) vs. wide (32+32 bit) entity handle costs.
+///
+/// The layout of cgs::ecs::Entity is fixed per build (CGS_WIDE_ENTITY), so
+/// the handle-level benchmarks use a local copy of its packing templated on
+/// the layout and run both in one binary.  BM_EntityManager_Churn uses the
+/// real EntityManager and labels itself with the layout it was built with;
+/// compare it across two builds with compare.py.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "cgs/ecs/entity.hpp"
+#include "cgs/ecs/entity_manager.hpp"
+
+using namespace cgs::ecs;
+
+namespace {
+
+/// Same packing as Entity, for one layout.
+template <typename RawT, typename VersionT, uint32_t IdBits>
+struct Handle {
+    using Raw = RawT;
+    using Version = VersionT;
+    static constexpr Raw kIdMask = (Raw{1} << IdBits) - 1;
+
+    Raw raw;
+
+    Handle(uint32_t id, Version version)
+        : raw((static_cast<Raw>(version) << IdBits) | (id & kIdMask)) {}
+
+    [[nodiscard]] uint32_t id() const noexcept { return static_cast<uint32_t>(raw & kIdMask); }
+    [[nodiscard]] Version version() const noexcept { return static_cast<Version>(raw >> IdBits); }
+};
+
+using CompactHandle = Handle<uint32_t, uint8_t, 24>;
+using WideHandle = Handle<uint64_t, uint32_t, 32>;
+
+/// Handles for ids [0, count) with mixed versions, in random order, and
+/// the matching version table.  Every fourth handle is stale.
+template <typename H>
+void makeHandles(std::size_t count,
+                 std::vector<H>& handles,
+                 std::vector<typename H::Version>& versions) {
+    std::mt19937 rng(42);
+    versions.resize(count);
+    handles.clear();
+    handles.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto v = static_cast<typename H::Version>(rng() & 0x7F);
+        versions[i] = v;
+        const auto held = (i % 4 == 0) ? static_cast<typename H::Version>(v + 1) : v;
+        handles.emplace_back(static_cast<uint32_t>(i), held);
+    }
+    std::shuffle(handles.begin(), handles.end(), rng);
+}
+
+void setItems(benchmark::State& state, std::size_t perIteration) {
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(perIteration));
+}
+
+// ── Handle layout ───────────────────────────────────────────────────────
+
+/// EntityManager::IsAlive() over a handle array: unpack, index the
+/// version table, compare.  Measures handle and version-table bandwidth.
+template <typename H>
+void BM_EntityHandle_IsAlive(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    std::vector<H> handles;
+    std::vector<typename H::Version> versions;
+    makeHandles(count, handles, versions);
+
+    for (auto _ : state) {
+        std::size_t alive = 0;
+        for (const H h : handles) {
+            alive += versions[h.id()] == h.version() ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(alive);
+    }
+    setItems(state, count);
+    state.counters["handleBytes"] = static_cast<double>(sizeof(H));
+}
+BENCHMARK_TEMPLATE(BM_EntityHandle_IsAlive, CompactHandle)
+    ->RangeMultiplier(10)
+    ->Range(10000, 1000000);
+BENCHMARK_TEMPLATE(BM_EntityHandle_IsAlive, WideHandle)
+    ->RangeMultiplier(10)
+    ->Range(10000, 1000000);
+
+/// Lookup in a map keyed by the raw handle, as threat tables and other
+/// per-source indexes do.
+template <typename H>
+void BM_EntityHandle_HashLookup(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    std::vector<H> handles;
+    std::vector<typename H::Version> versions;
+    makeHandles(count, handles, versions);
+    std::unordered_map<typename H::Raw, uint32_t> index;
+    index.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        index.emplace(handles[i].raw, static_cast<uint32_t>(i));
+    }
+    std::shuffle(handles.begin(), handles.end(), std::mt19937(7));
+
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        for (const H h : handles) {
+            sum += index.find(h.raw)->second;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    setItems(state, count);
+}
+BENCHMARK_TEMPLATE(BM_EntityHandle_HashLookup, CompactHandle)
+    ->RangeMultiplier(10)
+    ->Range(10000, 1000000);
+BENCHMARK_TEMPLATE(BM_EntityHandle_HashLookup, WideHandle)
+    ->RangeMultiplier(10)
+    ->Range(10000, 1000000);
+
+// ── EntityManager (this build's layout) ─────────────────────────────────
+
+/// Spawn-point churn: destroy and recreate a tenth of a live population
+/// per iteration, then validate every held handle.
+void BM_EntityManager_Churn(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const std::size_t churn = count / 10;
+    EntityManager manager;
+    std::vector<Entity> entities;
+    manager.CreateMany(count, entities);
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < churn; ++i) {
+            manager.Destroy(entities[i]);
+            entities[i] = manager.Create();
+        }
+        std::size_t alive = 0;
+        for (const Entity e : entities) {
+            alive += manager.IsAlive(e) ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(alive);
+    }
+    setItems(state, count);
+    state.SetLabel(CGS_WIDE_ENTITY ? "wide" : "compact");
+    state.counters["handleBytes"] = static_cast<double>(sizeof(Entity));
+}
+BENCHMARK(BM_EntityManager_Churn)->RangeMultiplier(10)->Range(10000, 1000000);
+
+}  // namespace
@@ -0,0 +1,346 @@
+/// @file persistence_benchmark.cpp
+/// @brief Microbenchmarks for WAL replay and truncation, snapshot save
+///        and load, and crash-restart recovery.
+///
+/// Append throughput with and without syncOnWrite is in
+/// wal_benchmark.cpp.  Here:
+///
+/// - BM_Wal_Replay: open() plus replay() of a log of range(0) MiB with
+///   range(1) replay threads (0 = default); `sPerGB` is the time to
+///   replay one GB.
+/// - BM_Wal_TruncateBefore: truncateBefore() dropping range(0) 1 MiB
+///   segments.
+/// - BM_Snapshot_{Save,LoadLatest}: range(0) players of 512 bytes each,
+///   range(1) = compression on/off; saves are synced.
+/// - BM_Persistence_Recovery: time to ready after a crash, i.e.
+///   PersistenceManager::start() over a snapshot of range(0) players and
+///   range(1) WAL entries written after it.
+///
+/// Files go to a fresh directory under the system temp directory (set
+/// TMPDIR to benchmark another disk) and are removed afterwards.  Replay
+/// and recovery read files the page cache holds from setup; drop caches
+/// between runs to measure a cold start.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "cgs/foundation/types.hpp"
+#include "cgs/service/persistence_manager.hpp"
+#include "cgs/service/snapshot_manager.hpp"
+#include "cgs/service/write_ahead_log.hpp"
+
+#include <unistd.h>
+
+using cgs::foundation::PlayerId;
+using cgs::service::PersistenceConfig;
+using cgs::service::PersistenceManager;
+using cgs::service::PlayerSnapshot;
+using cgs::service::Snapshot;
+using cgs::service::SnapshotConfig;
+using cgs::service::SnapshotManager;
+using cgs::service::WalConfig;
+using cgs::service::WalEntry;
+using cgs::service::WalOperation;
+using cgs::service::WriteAheadLog;
+
+namespace {
+
+constexpr std::size_t kEntryPayload = 256;
+constexpr std::size_t kPlayerStateBytes = 512;
+constexpr std::size_t kSegmentBytes = 1024 * 1024;
+
+std::filesystem::path benchDirectory(const std::string& name) {
+    auto dir = std::filesystem::temp_directory_path() /
+               ("cgs_bench_" + name + "_" + std::to_string(::getpid()));
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+    std::filesystem::create_directories(dir, ec);
+    return dir;
+}
+
+void removeDirectory(const std::filesystem::path& dir) {
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+}
+
+WalConfig walConfig(const std::filesystem::path& dir) {
+    WalConfig config;
+    config.directory = dir;
+    config.syncOnWrite = false;
+    return config;
+}
+
+/// Append @p count entries of kEntryPayload bytes, cycling over
+/// @p players players; returns the last sequence (0 on failure).
+uint64_t writeEntries(WriteAheadLog& wal, std::size_t count, std::size_t players) {
+    constexpr std::size_t kBatch = 256;
+    std::vector<WalEntry> batch(kBatch);
+    uint64_t last = 0;
+    for (std::size_t written = 0; written < count;) {
+        const std::size_t n = std::min(kBatch, count - written);
+        for (std::size_t i = 0; i < n; ++i) {
+            batch[i].playerId = PlayerId((written + i) % players + 1);
+            batch[i].operation = WalOperation::StateUpdate;
+            batch[i].data.assign(kEntryPayload, static_cast<uint8_t>(written + i));
+        }
+        auto result = wal.appendBatch(std::span<WalEntry>(batch.data(), n));
+        if (result.hasError()) {
+            return 0;
+        }
+        last = result.value();
+        written += n;
+    }
+    return wal.flush().hasError() ? 0 : last;
+}
+
+Snapshot makeSnapshot(std::size_t players, uint64_t walSequence) {
+    Snapshot snapshot;
+    snapshot.walSequence = walSequence;
+    snapshot.players.resize(players);
+    for (std::size_t i = 0; i < players; ++i) {
+        auto& player = snapshot.players[i];
+        player.playerId = PlayerId(i + 1);
+        player.instanceId = static_cast<uint32_t>(i % 64);
+        // Mostly repetitive, like serialized stats and inventories.
+        player.data.assign(kPlayerStateBytes, static_cast<uint8_t>(i % 7));
+        for (std::size_t b = 0; b < kPlayerStateBytes; b += 32) {
+            player.data[b] = static_cast<uint8_t>((i * 31 + b) & 0xFF);
+        }
+    }
+    return snapshot;
+}
+
+// -- WAL replay ---------------------------------------------------------------
+
+void BM_Wal_Replay(benchmark::State& state) {
+    const auto megabytes = static_cast<std::size_t>(state.range(0));
+    const auto entries = megabytes * 1024 * 1024 / kEntryPayload;
+    const auto dir = benchDirectory("wal_replay");
+    {
+        WriteAheadLog wal(walConfig(dir));
+        if (wal.open().hasError() || writeEntries(wal, entries, 10'000) == 0) {
+            state.SkipWithError("cannot write WAL");
+            removeDirectory(dir);
+            return;
+        }
+        wal.close();
+    }
+
+    auto config = walConfig(dir);
+    config.replayThreads = static_cast<std::size_t>(state.range(1));
+    uint64_t bytes = 0;
+    for (auto _ : state) {
+        WriteAheadLog wal(config);
+        if (wal.open().hasError()) {
+            state.SkipWithError("cannot open WAL");
+            break;
+        }
+        uint64_t replayed = 0;
+        auto result = wal.replay(0, [&](const WalEntry& entry) {
+            replayed += entry.data.size();
+            benchmark::DoNotOptimize(entry.sequence);
+        });
+        if (result.hasError()) {
+            state.SkipWithError("replay failed");
+            break;
+        }
+        bytes += replayed;
+        wal.close();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(entries));
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+    state.counters["sPerGB"] = benchmark::Counter(static_cast<double>(bytes) / 1e9,
+                                                  benchmark::Counter::kIsRate |
+                                                      benchmark::Counter::kInvert);
+    removeDirectory(dir);
+}
+BENCHMARK(BM_Wal_Replay)
+    ->ArgsProduct({{16, 64, 256}, {1, 0}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// -- WAL truncation -----------------------------------------------------------
+
+void BM_Wal_TruncateBefore(benchmark::State& state) {
+    const auto segments = static_cast<std::size_t>(state.range(0));
+    const auto dir = benchDirectory("wal_truncate");
+    auto config = walConfig(dir);
+    config.maxFileSize = kSegmentBytes;
+    const std::size_t entriesPerSegment = kSegmentBytes / (kEntryPayload + 64);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        removeDirectory(dir);
+        WriteAheadLog wal(config);
+        // One more segment than is truncated, so the cut is mid-log.
+        const uint64_t last = wal.open().hasError()
+                                  ? 0
+                                  : writeEntries(wal, (segments + 1) * entriesPerSegment, 1000);
+        if (last == 0) {
+            state.SkipWithError("cannot write WAL");
+            break;
+        }
+        const uint64_t cut = last - entriesPerSegment;
+        state.ResumeTiming();
+
+        if (wal.truncateBefore(cut).hasError()) {
+            state.SkipWithError("truncateBefore failed");
+            break;
+        }
+
+        state.PauseTiming();
+        wal.close();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(segments));
+    removeDirectory(dir);
+}
+BENCHMARK(BM_Wal_TruncateBefore)->Arg(1)->Arg(16)->Arg(64)->Unit(benchmark::kMicrosecond);
+
+// -- Snapshots ----------------------------------------------------------------
+
+SnapshotConfig snapshotConfig(const std::filesystem::path& dir, bool compress) {
+    SnapshotConfig config;
+    config.directory = dir;
+    config.compress = compress;
+    config.maxRetained = 2;
+    return config;
+}
+
+void BM_Snapshot_Save(benchmark::State& state) {
+    const auto players = static_cast<std::size_t>(state.range(0));
+    const auto dir = benchDirectory("snapshot_save");
+    SnapshotManager snapshots(snapshotConfig(dir, state.range(1) != 0));
+    if (snapshots.open().hasError()) {
+        state.SkipWithError("cannot open snapshot directory");
+        removeDirectory(dir);
+        return;
+    }
+    auto snapshot = makeSnapshot(players, 0);
+    for (auto _ : state) {
+        ++snapshot.walSequence;
+        if (snapshots.save(snapshot).hasError()) {
+            state.SkipWithError("save failed");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(players));
+    state.SetBytesProcessed(state.iterations() *
+                            static_cast<int64_t>(players * kPlayerStateBytes));
+    snapshots.close();
+    removeDirectory(dir);
+}
+BENCHMARK(BM_Snapshot_Save)
+    ->ArgsProduct({{1000, 10'000}, {0, 1}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+void BM_Snapshot_LoadLatest(benchmark::State& state) {
+    const auto players = static_cast<std::size_t>(state.range(0));
+    const auto dir = benchDirectory("snapshot_load");
+    SnapshotManager snapshots(snapshotConfig(dir, state.range(1) != 0));
+    if (snapshots.open().hasError() || snapshots.save(makeSnapshot(players, 1)).hasError()) {
+        state.SkipWithError("cannot write snapshot");
+        removeDirectory(dir);
+        return;
+    }
+    for (auto _ : state) {
+        auto loaded = snapshots.loadLatest();
+        if (loaded.hasError()) {
+            state.SkipWithError("loadLatest failed");
+            break;
+        }
+        benchmark::DoNotOptimize(loaded.value().players.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(players));
+    state.SetBytesProcessed(state.iterations() *
+                            static_cast<int64_t>(players * kPlayerStateBytes));
+    snapshots.close();
+    removeDirectory(dir);
+}
+BENCHMARK(BM_Snapshot_LoadLatest)
+    ->ArgsProduct({{1000, 10'000}, {0, 1}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// -- Crash-restart recovery ---------------------------------------------------
+
+void BM_Persistence_Recovery(benchmark::State& state) {
+    const auto players = static_cast<std::size_t>(state.range(0));
+    const auto walEntries = static_cast<std::size_t>(state.range(1));
+    const auto pristine = benchDirectory("recovery_pristine");
+    const auto work = benchDirectory("recovery_work");
+
+    // State left by a crash: a snapshot, then WAL entries it does not
+    // cover (no final snapshot, no truncation).
+    {
+        WriteAheadLog wal(walConfig(pristine / "wal"));
+        SnapshotManager snapshots(snapshotConfig(pristine / "snapshots", true));
+        const bool ok = wal.open().hasValue() && snapshots.open().hasValue() &&
+                        writeEntries(wal, 1, players) != 0 &&
+                        snapshots.save(makeSnapshot(players, wal.currentSequence())).hasValue() &&
+                        (walEntries == 0 || writeEntries(wal, walEntries, players) != 0);
+        wal.close();
+        snapshots.close();
+        if (!ok) {
+            state.SkipWithError("cannot write crash state");
+            removeDirectory(pristine);
+            removeDirectory(work);
+            return;
+        }
+    }
+
+    PersistenceConfig config;
+    config.wal = walConfig(work / "wal");
+    config.snapshot = snapshotConfig(work / "snapshots", true);
+    config.snapshotInterval = std::chrono::seconds(0);
+
+    std::size_t restored = 0;
+    std::size_t applied = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        removeDirectory(work);
+        std::error_code ec;
+        std::filesystem::copy(pristine, work, std::filesystem::copy_options::recursive, ec);
+        restored = 0;
+        applied = 0;
+        state.ResumeTiming();
+
+        // Ready once start() returns: snapshot restored, WAL replayed.
+        auto persistence = std::make_unique<PersistenceManager>(config);
+        auto started = persistence->start(
+            [] { return std::vector<PlayerSnapshot>{}; },
+            [&](const Snapshot& snapshot) { restored = snapshot.players.size(); },
+            [&](const WalEntry&) { ++applied; });
+
+        state.PauseTiming();
+        if (started.hasError()) {
+            state.SkipWithError("recovery failed");
+            break;
+        }
+        persistence->stop();
+        persistence.reset();
+        state.ResumeTiming();
+    }
+    state.counters["restoredPlayers"] = static_cast<double>(restored);
+    state.counters["appliedEntries"] = static_cast<double>(applied);
+    removeDirectory(pristine);
+    removeDirectory(work);
+}
+BENCHMARK(BM_Persistence_Recovery)
+    ->ArgsProduct({{1000, 10'000}, {0, 100'000, 1'000'000}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+}  // namespace
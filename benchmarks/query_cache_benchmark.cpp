@@ -0,0 +1,139 @@
+/// @file query_cache_benchmark.cpp
+/// @brief Microbenchmarks for QueryCache get/put under contention.
+///
+/// One cache is shared by every benchmark thread.  range(0) is the number
+/// of distinct queries; threads pick keys from a per-thread fixed-seed
+/// sequence, so runs are repeatable and threads collide on shards the way
+/// DBProxy workers do.
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "cgs/foundation/game_database.hpp"
+#include "cgs/service/dbproxy_types.hpp"
+#include "cgs/service/query_cache.hpp"
+
+using cgs::foundation::DbRow;
+using cgs::foundation::QueryResult;
+using cgs::service::CacheConfig;
+using cgs::service::QueryCache;
+
+namespace {
+
+std::unique_ptr<QueryCache> gCache;
+std::vector<std::string> gKeys;
+QueryResult gResult;
+
+QueryResult makeResult(int rows) {
+    QueryResult result;
+    result.reserve(static_cast<std::size_t>(rows));
+    for (int i = 0; i < rows; ++i) {
+        DbRow row;
+        row["id"] = static_cast<std::int64_t>(i);
+        row["name"] = std::string("item_template_") + std::to_string(i);
+        row["level"] = static_cast<std::int64_t>(i % 100);
+        row["price"] = static_cast<double>(i) * 1.5;
+        result.push_back(row);
+    }
+    return result;
+}
+
+/// Builds the shared cache with every key cached (admission off, so the
+/// warm-up is not filtered).
+void setUpCache(const benchmark::State& state) {
+    const auto keys = static_cast<std::size_t>(state.range(0));
+    CacheConfig config;
+    config.maxEntries = keys;
+    config.admissionFilter = false;
+    gCache = std::make_unique<QueryCache>(config);
+    gResult = makeResult(5);
+
+    gKeys.clear();
+    gKeys.reserve(keys);
+    for (std::size_t i = 0; i < keys; ++i) {
+        gKeys.push_back("SELECT * FROM items WHERE id = " + std::to_string(i));
+        gCache->put(gKeys.back(), gResult);
+    }
+}
+
+void tearDownCache(const benchmark::State&) {
+    gCache.reset();
+    gKeys.clear();
+}
+
+/// Hits only.
+void BM_QueryCache_Get(benchmark::State& state) {
+    std::mt19937 rng(static_cast<uint32_t>(state.thread_index()) + 1);
+    std::uniform_int_distribution<std::size_t> pick(0, gKeys.size() - 1);
+
+    for (auto _ : state) {
+        auto hit = gCache->get(gKeys[pick(rng)]);
+        benchmark::DoNotOptimize(hit);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_QueryCache_Get)
+    ->Setup(setUpCache)
+    ->Teardown(tearDownCache)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+/// Nine gets to one put, the put replacing a cached entry.
+void BM_QueryCache_Mixed(benchmark::State& state) {
+    std::mt19937 rng(static_cast<uint32_t>(state.thread_index()) + 1);
+    std::uniform_int_distribution<std::size_t> pick(0, gKeys.size() - 1);
+    std::size_t op = 0;
+
+    for (auto _ : state) {
+        const auto& key = gKeys[pick(rng)];
+        if (++op % 10 == 0) {
+            gCache->put(key, gResult);
+        } else {
+            auto hit = gCache->get(key);
+            benchmark::DoNotOptimize(hit);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_QueryCache_Mixed)
+    ->Setup(setUpCache)
+    ->Teardown(tearDownCache)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+/// Puts of new queries into a full cache, so every put evicts.
+void BM_QueryCache_PutEvict(benchmark::State& state) {
+    const std::string prefix =
+        "SELECT * FROM items WHERE owner = " + std::to_string(state.thread_index()) + " AND id = ";
+    std::vector<std::string> keys;
+    keys.reserve(gKeys.size());
+    for (std::size_t i = 0; i < gKeys.size(); ++i) {
+        keys.push_back(prefix + std::to_string(i));
+    }
+    std::size_t next = 0;
+
+    for (auto _ : state) {
+        gCache->put(keys[next], gResult);
+        next = (next + 1) % keys.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_QueryCache_PutEvict)
+    ->Setup(setUpCache)
+    ->Teardown(tearDownCache)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+}  // namespace
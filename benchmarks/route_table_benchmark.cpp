@@ -0,0 +1,72 @@
+/// @file route_table_benchmark.cpp
+/// @brief Microbenchmarks for RouteTable::resolve().
+///
+/// range(0) is the number of configured routes.  resolve() is a table
+/// load whatever the route count, so the sweep checks that it stays flat;
+/// the threaded runs show the cost of readers sharing the table.
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "cgs/service/route_table.hpp"
+
+using cgs::service::RouteTable;
+
+namespace {
+
+constexpr std::size_t kOpcodes = 4096;
+
+std::unique_ptr<RouteTable> gRoutes;
+
+/// range(0) routes of equal width over the client opcode space
+/// (0x0100-0xFFFF), spread over eight services.
+void setUpRoutes(const benchmark::State& state) {
+    const auto count = static_cast<uint32_t>(state.range(0));
+    gRoutes = std::make_unique<RouteTable>();
+    const uint32_t width = (0x10000 - 0x0100) / count;
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint32_t low = 0x0100 + i * width;
+        gRoutes->addRoute(static_cast<uint16_t>(low), static_cast<uint16_t>(low + width - 1),
+                          "service-" + std::to_string(i % 8), i % 4 != 0);
+    }
+}
+
+void tearDownRoutes(const benchmark::State&) {
+    gRoutes.reset();
+}
+
+void BM_RouteTable_Resolve(benchmark::State& state) {
+    std::mt19937 rng(static_cast<uint32_t>(state.thread_index()) + 1);
+    std::uniform_int_distribution<uint32_t> pick(0x0000, 0xFFFF);
+    std::vector<uint16_t> opcodes(kOpcodes);
+    for (auto& opcode : opcodes) {
+        opcode = static_cast<uint16_t>(pick(rng));
+    }
+    std::size_t next = 0;
+
+    for (auto _ : state) {
+        auto match = gRoutes->resolve(opcodes[next]);
+        benchmark::DoNotOptimize(match);
+        next = (next + 1) % kOpcodes;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RouteTable_Resolve)
+    ->Setup(setUpRoutes)
+    ->Teardown(tearDownRoutes)
+    ->RangeMultiplier(8)
+    ->Range(8, 4096);
+BENCHMARK(BM_RouteTable_Resolve)
+    ->Setup(setUpRoutes)
+    ->Teardown(tearDownRoutes)
+    ->Arg(64)
+    ->ThreadRange(2, 16)
+    ->UseRealTime();
+
+}  // namespace
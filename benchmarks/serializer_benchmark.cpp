@@ -0,0 +1,134 @@
+/// @file serializer_benchmark.cpp
+/// @brief Microbenchmarks for GameSerializer round trips.
+///
+/// Each benchmark encodes and decodes in the same iteration, in the
+/// binary, compact and JSON forms, for a fixed-layout component
+/// (Transform) and a player record with strings.  The array benchmarks
+/// are swept over element counts.
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "cgs/foundation/game_serializer.hpp"
+#include "cgs/game/components.hpp"
+
+using cgs::foundation::GameSerializer;
+using cgs::game::Transform;
+
+namespace cgs_bench {
+
+/// Persisted player summary: variable length, nested fixed fields.
+struct PlayerRecord {
+    uint64_t id = 0;
+    std::string name;
+    int32_t level = 0;
+    int64_t gold = 0;
+    cgs::game::Transform transform;
+    std::string guild;
+};
+
+}  // namespace cgs_bench
+
+CGS_SERIALIZABLE(cgs_bench::PlayerRecord, 1,
+                 field("id", &cgs_bench::PlayerRecord::id),
+                 field("name", &cgs_bench::PlayerRecord::name),
+                 field("level", &cgs_bench::PlayerRecord::level),
+                 field("gold", &cgs_bench::PlayerRecord::gold),
+                 field("transform", &cgs_bench::PlayerRecord::transform),
+                 field("guild", &cgs_bench::PlayerRecord::guild));
+
+namespace {
+
+using cgs_bench::PlayerRecord;
+
+Transform makeTransform(std::size_t i) {
+    Transform t;
+    t.position = {static_cast<float>(i) * 0.5f, 12.0f, static_cast<float>(i % 97)};
+    t.rotation = {0.7071f, 0.0f, 0.7071f, 0.0f};
+    return t;
+}
+
+PlayerRecord makePlayer() {
+    PlayerRecord p;
+    p.id = 1234567;
+    p.name = "Aldric_the_Bold";
+    p.level = 57;
+    p.gold = 98765;
+    p.transform = makeTransform(3);
+    p.guild = "Knights of the Silver Dawn";
+    return p;
+}
+
+template <typename T>
+void BM_Serializer_BinaryRoundTrip(benchmark::State& state, const T& value) {
+    GameSerializer serializer;
+    std::vector<uint8_t> buf;
+    for (auto _ : state) {
+        buf.clear();
+        serializer.serializeAppend(value, buf);
+        auto decoded = serializer.deserializeBinary<T>(buf);
+        benchmark::DoNotOptimize(decoded);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(buf.size()));
+}
+BENCHMARK_CAPTURE(BM_Serializer_BinaryRoundTrip, Transform, makeTransform(1));
+BENCHMARK_CAPTURE(BM_Serializer_BinaryRoundTrip, PlayerRecord, makePlayer());
+
+template <typename T>
+void BM_Serializer_CompactRoundTrip(benchmark::State& state, const T& value) {
+    GameSerializer serializer;
+    std::size_t size = 0;
+    for (auto _ : state) {
+        auto wire = serializer.serializeCompact(value);
+        auto decoded = serializer.deserializeCompact<T>(wire);
+        size = wire.size();
+        benchmark::DoNotOptimize(decoded);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+BENCHMARK_CAPTURE(BM_Serializer_CompactRoundTrip, Transform, makeTransform(1));
+BENCHMARK_CAPTURE(BM_Serializer_CompactRoundTrip, PlayerRecord, makePlayer());
+
+template <typename T>
+void BM_Serializer_JsonRoundTrip(benchmark::State& state, const T& value) {
+    GameSerializer serializer;
+    std::string json;
+    for (auto _ : state) {
+        json.clear();
+        serializer.serializeJsonAppend(value, json);
+        auto decoded = serializer.deserializeJson<T>(json);
+        benchmark::DoNotOptimize(decoded);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(json.size()));
+}
+BENCHMARK_CAPTURE(BM_Serializer_JsonRoundTrip, Transform, makeTransform(1));
+BENCHMARK_CAPTURE(BM_Serializer_JsonRoundTrip, PlayerRecord, makePlayer());
+
+/// One array block of range(0) transforms (e.g. a snapshot of a zone).
+void BM_Serializer_ArrayRoundTrip(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    std::vector<Transform> transforms;
+    transforms.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        transforms.push_back(makeTransform(i));
+    }
+
+    GameSerializer serializer;
+    std::vector<uint8_t> buf;
+    for (auto _ : state) {
+        buf.clear();
+        serializer.serializeArrayAppend(std::span<const Transform>(transforms), buf);
+        auto decoded = serializer.deserializeArray<Transform>(buf);
+        benchmark::DoNotOptimize(decoded);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(buf.size()));
+}
+BENCHMARK(BM_Serializer_ArrayRoundTrip)->RangeMultiplier(10)->Range(10, 10000);
+
+}  // namespace
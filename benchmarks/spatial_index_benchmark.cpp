@@ -0,0 +1,166 @@
+/// @file spatial_index_benchmark.cpp
+/// @brief Microbenchmarks for SpatialIndex insert, update and queries.
+///
+/// Sizes are entity counts.  The world grows with the count so density
+/// stays at one entity per 100 square units, and queries land at random
+/// points (fixed seeds), so a radius query sees a similar number of
+/// matches at every size.
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "cgs/ecs/entity.hpp"
+#include "cgs/game/math_types.hpp"
+#include "cgs/game/spatial_index.hpp"
+#include "cgs/game/world_types.hpp"
+
+using cgs::ecs::Entity;
+using cgs::game::SpatialIndex;
+using cgs::game::Vector3;
+
+namespace {
+
+constexpr float kAreaPerEntity = 100.0f;
+constexpr std::size_t kQueryPoints = 1024;
+
+float worldSize(std::size_t count) {
+    return std::sqrt(static_cast<float>(count) * kAreaPerEntity);
+}
+
+std::vector<Vector3> randomPoints(std::size_t count, float size, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> coord(0.0f, size);
+    std::vector<Vector3> points;
+    points.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        points.emplace_back(coord(rng), 0.0f, coord(rng));
+    }
+    return points;
+}
+
+Entity entityAt(std::size_t i) {
+    return Entity(static_cast<uint32_t>(i), 0);
+}
+
+/// An index over range(0) entities and a set of query points.
+struct World {
+    explicit World(const benchmark::State& state, uint32_t coarseFactor = 0)
+        : count(static_cast<std::size_t>(state.range(0))),
+          index(cgs::game::kDefaultCellSize, coarseFactor),
+          queries(randomPoints(kQueryPoints, worldSize(count), 7)) {
+        const auto positions = randomPoints(count, worldSize(count), 42);
+        for (std::size_t i = 0; i < count; ++i) {
+            index.Insert(entityAt(i), positions[i]);
+        }
+    }
+
+    const Vector3& nextQuery() {
+        const Vector3& point = queries[next];
+        next = (next + 1) % queries.size();
+        return point;
+    }
+
+    std::size_t count;
+    SpatialIndex index;
+    std::vector<Vector3> queries;
+    std::size_t next = 0;
+};
+
+void BM_SpatialIndex_Insert(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto positions = randomPoints(count, worldSize(count), 42);
+
+    for (auto _ : state) {
+        SpatialIndex index;
+        for (std::size_t i = 0; i < count; ++i) {
+            index.Insert(entityAt(i), positions[i]);
+        }
+        benchmark::DoNotOptimize(index);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+BENCHMARK(BM_SpatialIndex_Insert)->RangeMultiplier(10)->Range(1000, 100000);
+
+/// Moves to random points, so almost every update changes cell.
+void BM_SpatialIndex_Update(benchmark::State& state) {
+    World world(state);
+    const auto targets = randomPoints(world.count, worldSize(world.count), 99);
+    std::size_t i = 0;
+
+    for (auto _ : state) {
+        world.index.Update(entityAt(i), targets[i]);
+        i = (i + 1) % world.count;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SpatialIndex_Update)->RangeMultiplier(10)->Range(1000, 100000);
+
+/// range(1) is the radius: melee-sized (8) and visibility-sized (64).
+void BM_SpatialIndex_QueryRadius(benchmark::State& state) {
+    World world(state);
+    const auto radius = static_cast<float>(state.range(1));
+    std::vector<Entity> out;
+    int64_t matches = 0;
+
+    for (auto _ : state) {
+        out.clear();
+        world.index.QueryRadius(world.nextQuery(), radius, out);
+        matches += static_cast<int64_t>(out.size());
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["matches"] =
+        benchmark::Counter(static_cast<double>(matches), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_SpatialIndex_QueryRadius)
+    ->ArgsProduct({benchmark::CreateRange(1000, 100000, 10), {8, 64}});
+
+/// Same sweep over a two-level grid (8 x 8 fine cells per coarse cell).
+void BM_SpatialIndex_QueryRadiusTwoLevel(benchmark::State& state) {
+    World world(state, 8);
+    const auto radius = static_cast<float>(state.range(1));
+    int64_t matches = 0;
+
+    for (auto _ : state) {
+        world.index.ForEachInRadius(world.nextQuery(), radius, [&matches](Entity) { ++matches; });
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["matches"] =
+        benchmark::Counter(static_cast<double>(matches), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_SpatialIndex_QueryRadiusTwoLevel)
+    ->ArgsProduct({benchmark::CreateRange(1000, 100000, 10), {8, 64}});
+
+/// range(1) is k.
+void BM_SpatialIndex_QueryNearest(benchmark::State& state) {
+    World world(state);
+    const auto k = static_cast<std::size_t>(state.range(1));
+
+    for (auto _ : state) {
+        auto nearest = world.index.QueryNearest(world.nextQuery(), k);
+        benchmark::DoNotOptimize(nearest.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SpatialIndex_QueryNearest)
+    ->ArgsProduct({benchmark::CreateRange(1000, 100000, 10), {1, 8}});
+
+void BM_SpatialIndex_QueryBox(benchmark::State& state) {
+    World world(state);
+    const Vector3 half(16.0f, 0.0f, 16.0f);
+
+    for (auto _ : state) {
+        const Vector3& center = world.nextQuery();
+        auto found = world.index.QueryBox(center - half, center + half);
+        benchmark::DoNotOptimize(found.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SpatialIndex_QueryBox)->RangeMultiplier(10)->Range(1000, 100000);
+
+}  // namespace
@@ -0,0 +1,115 @@
+/// @file wal_benchmark.cpp
+/// @brief Microbenchmarks for WriteAheadLog::append().
+///
+/// range(0) is the payload size in bytes.  The buffered benchmark shows
+/// the encode and copy cost; the synced one the cost of durability,
+/// with threads sharing group commits.  Logs go to a fresh directory
+/// under the system temp directory (set TMPDIR to benchmark another
+/// disk) and are removed afterwards.
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "cgs/foundation/types.hpp"
+#include "cgs/service/write_ahead_log.hpp"
+
+#include <unistd.h>
+
+using cgs::foundation::PlayerId;
+using cgs::service::WalConfig;
+using cgs::service::WalEntry;
+using cgs::service::WalOperation;
+using cgs::service::WriteAheadLog;
+
+namespace {
+
+std::unique_ptr<WriteAheadLog> gWal;
+std::filesystem::path gDirectory;
+
+void openWal(bool syncOnWrite) {
+    gDirectory = std::filesystem::temp_directory_path() /
+                 ("cgs_bench_wal_" + std::to_string(::getpid()));
+    std::error_code ec;
+    std::filesystem::remove_all(gDirectory, ec);
+
+    WalConfig config;
+    config.directory = gDirectory;
+    config.syncOnWrite = syncOnWrite;
+    gWal = std::make_unique<WriteAheadLog>(config);
+    if (gWal->open().hasError()) {
+        gWal.reset();
+    }
+}
+
+void setUpBuffered(const benchmark::State&) {
+    openWal(false);
+}
+
+void setUpSynced(const benchmark::State&) {
+    openWal(true);
+}
+
+void tearDown(const benchmark::State&) {
+    if (gWal) {
+        gWal->close();
+        gWal.reset();
+    }
+    std::error_code ec;
+    std::filesystem::remove_all(gDirectory, ec);
+}
+
+void runAppend(benchmark::State& state) {
+    if (!gWal) {
+        state.SkipWithError("cannot open WAL directory");
+        return;
+    }
+    const auto size = static_cast<std::size_t>(state.range(0));
+    const std::vector<uint8_t> payload(size, 0xAB);
+    const PlayerId player(static_cast<uint64_t>(state.thread_index()) + 1);
+
+    for (auto _ : state) {
+        WalEntry entry;
+        entry.playerId = player;
+        entry.operation = WalOperation::StateUpdate;
+        entry.data = payload;
+        if (gWal->append(std::move(entry)).hasError()) {
+            state.SkipWithError("append failed");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+void BM_Wal_AppendBuffered(benchmark::State& state) {
+    runAppend(state);
+}
+BENCHMARK(BM_Wal_AppendBuffered)
+    ->Setup(setUpBuffered)
+    ->Teardown(tearDown)
+    ->RangeMultiplier(4)
+    ->Range(64, 4096);
+
+void BM_Wal_AppendSynced(benchmark::State& state) {
+    runAppend(state);
+    if (gWal && state.thread_index() == 0) {
+        state.counters["syncsPerAppend"] = benchmark::Counter(
+            static_cast<double>(gWal->syncCount()), benchmark::Counter::kAvgIterations);
+    }
+}
+BENCHMARK(BM_Wal_AppendSynced)
+    ->Setup(setUpSynced)
+    ->Teardown(tearDown)
+    ->Arg(256)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+}  // namespace
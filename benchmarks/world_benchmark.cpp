@@ -0,0 +1,280 @@
+/// @file world_benchmark.cpp
+/// @brief Scaling benchmarks for WorldSystem ticks and visibility.
+///
+/// Scenarios place entities on one open-world map either uniformly (one
+/// per 100 square units) or clustered: 70% around four city hubs, the
+/// rest uniform.  Each tick a rotating slice of the entities takes a
+/// one-unit step and is marked changed, as a movement system would, and
+/// the scheduler runs the WorldSystem.  Times are per tick (or per
+/// visibility query).  After the timed loop a few more iterations run
+/// with heap accounting for "allocs" and "allocBytes" per iteration;
+/// "worldBytes" is the heap the world held after its first tick.
+///
+/// Use the cell size sweeps to pick MapInstance::cellSize for a map:
+/// they fix the population and vary only the grid.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "alloc_counter.hpp"
+#include "cgs/ecs/component_storage.hpp"
+#include "cgs/ecs/entity.hpp"
+#include "cgs/ecs/system_scheduler.hpp"
+#include "cgs/game/components.hpp"
+#include "cgs/game/math_types.hpp"
+#include "cgs/game/world_components.hpp"
+#include "cgs/game/world_system.hpp"
+#include "cgs/game/world_types.hpp"
+
+using namespace cgs::ecs;
+using namespace cgs::game;
+
+namespace {
+
+constexpr float kAreaPerEntity = 100.0f;
+constexpr float kHubRadius = 40.0f;
+constexpr double kClusteredShare = 0.7;
+constexpr float kTickSeconds = 0.05f;
+constexpr int kCountedIterations = 8;
+
+/// Entity placement.
+enum Distribution : int64_t { kUniform = 0, kClustered = 1 };
+
+float worldSize(std::size_t count) {
+    return std::sqrt(static_cast<float>(count) * kAreaPerEntity);
+}
+
+std::vector<Vector3> place(std::size_t count, int64_t distribution, uint32_t seed) {
+    const float size = worldSize(count);
+    const Vector3 hubs[] = {{0.25f * size, 0.0f, 0.25f * size},
+                            {0.75f * size, 0.0f, 0.25f * size},
+                            {0.25f * size, 0.0f, 0.75f * size},
+                            {0.5f * size, 0.0f, 0.5f * size}};
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> coord(0.0f, size);
+    std::normal_distribution<float> spread(0.0f, kHubRadius);
+    std::bernoulli_distribution inHub(distribution == kClustered ? kClusteredShare : 0.0);
+    std::uniform_int_distribution<std::size_t> hub(0, std::size(hubs) - 1);
+
+    std::vector<Vector3> points;
+    points.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        if (inHub(rng)) {
+            const Vector3& center = hubs[hub(rng)];
+            points.emplace_back(std::clamp(center.x + spread(rng), 0.0f, size), 0.0f,
+                                std::clamp(center.z + spread(rng), 0.0f, size));
+        } else {
+            points.emplace_back(coord(rng), 0.0f, coord(rng));
+        }
+    }
+    return points;
+}
+
+/// One map with @p count entities, @p viewerPercent of which carry a
+/// VisibilityRange, ticked by a SystemScheduler.
+class Scenario {
+public:
+    Scenario(std::size_t count,
+             int64_t distribution,
+             float cellSize = kDefaultCellSize,
+             double viewerPercent = 0.0,
+             bool interest = false) {
+        mapInstances_.Add(kMap, MapInstance{1, 1, MapType::OpenWorld, cellSize});
+
+        const auto positions = place(count, distribution, 42);
+        const auto viewerEvery =
+            viewerPercent > 0.0 ? static_cast<std::size_t>(100.0 / viewerPercent) : 0;
+        entities_.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            Entity e(static_cast<uint32_t>(i + 1), 0);
+            transforms_.Add(e, Transform{positions[i], {}, {1.0f, 1.0f, 1.0f}});
+            memberships_.Add(e, MapMembership{kMap, 0});
+            if (viewerEvery != 0 && i % viewerEvery == 0) {
+                visibilityRanges_.Add(e, VisibilityRange{});
+                viewers_.push_back(e);
+            }
+            entities_.push_back(e);
+        }
+
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+        steps_.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            const float a = angle(rng);
+            steps_.emplace_back(std::cos(a), 0.0f, std::sin(a));
+        }
+
+        world_ = &scheduler_.Register<WorldSystem>(transforms_, memberships_, mapInstances_,
+                                                   visibilityRanges_, zones_);
+        world_->SetInterestManagement(interest);
+        built_ = scheduler_.Build();
+        if (!built_) {
+            return;
+        }
+
+        cgs_bench::AllocScope scope;
+        scheduler_.Execute(kTickSeconds);
+        worldBytes_ = scope.stats().liveBytes;
+    }
+
+    /// Step @p moves entities (continuing from the last call) and tick.
+    void tick(std::size_t moves) {
+        const std::size_t count = entities_.size();
+        for (std::size_t m = 0; m < moves; ++m) {
+            const Entity e = entities_[cursor_];
+            auto& step = steps_[cursor_];
+            auto& position = transforms_.Get(e).position;
+            position = position + step;
+            step = Vector3(-step.x, 0.0f, -step.z);  // Walk back and forth.
+            transforms_.MarkChanged(e);
+            cursor_ = (cursor_ + 1) % count;
+        }
+        scheduler_.Execute(kTickSeconds);
+    }
+
+    /// False if the scheduler could not be built (nothing to measure).
+    [[nodiscard]] bool ready() const { return built_; }
+    [[nodiscard]] std::size_t count() const { return entities_.size(); }
+    [[nodiscard]] const std::vector<Entity>& viewers() const { return viewers_; }
+    [[nodiscard]] const WorldSystem& world() const { return *world_; }
+
+    void report(benchmark::State& state) const {
+        const auto* index = world_->GetSpatialIndex(kMap);
+        state.counters["cells"] = static_cast<double>(index != nullptr ? index->CellCount() : 0);
+        state.counters["worldBytes"] = benchmark::Counter(static_cast<double>(worldBytes_),
+                                                          benchmark::Counter::kDefaults,
+                                                          benchmark::Counter::kIs1024);
+    }
+
+private:
+    static constexpr Entity kMap{0, 0};
+
+    ComponentStorage<Transform> transforms_;
+    ComponentStorage<MapMembership> memberships_;
+    ComponentStorage<MapInstance> mapInstances_;
+    ComponentStorage<VisibilityRange> visibilityRanges_;
+    ComponentStorage<Zone> zones_;
+    SystemScheduler scheduler_;
+    WorldSystem* world_ = nullptr;
+
+    std::vector<Entity> entities_;
+    std::vector<Entity> viewers_;
+    std::vector<Vector3> steps_;
+    std::size_t cursor_ = 0;
+    int64_t worldBytes_ = 0;
+    bool built_ = false;
+};
+
+std::size_t movesPerTick(std::size_t count, int64_t percent) {
+    return std::max<std::size_t>(1, count * static_cast<std::size_t>(percent) / 100);
+}
+
+void runTicks(benchmark::State& state, Scenario& scenario, std::size_t moves) {
+    if (!scenario.ready()) {
+        state.SkipWithError("scheduler build failed");
+        return;
+    }
+    for (auto _ : state) {
+        scenario.tick(moves);
+    }
+    cgs_bench::countAllocations(state, kCountedIterations, [&] { scenario.tick(moves); });
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(moves));
+    state.counters["moved"] = static_cast<double>(moves);
+    scenario.report(state);
+}
+
+void runVisibility(benchmark::State& state, const Scenario& scenario) {
+    if (!scenario.ready()) {
+        state.SkipWithError("scheduler build failed");
+        return;
+    }
+    const auto& viewers = scenario.viewers();
+    std::vector<Entity> visible;
+    std::size_t next = 0;
+    int64_t seen = 0;
+
+    for (auto _ : state) {
+        visible.clear();
+        scenario.world().GetVisibleEntities(viewers[next], visible);
+        seen += static_cast<int64_t>(visible.size());
+        next = (next + 1) % viewers.size();
+    }
+    cgs_bench::countAllocations(state, kCountedIterations, [&] {
+        visible.clear();
+        scenario.world().GetVisibleEntities(viewers[next], visible);
+        next = (next + 1) % viewers.size();
+    });
+    state.SetItemsProcessed(state.iterations());
+    state.counters["visible"] =
+        benchmark::Counter(static_cast<double>(seen), benchmark::Counter::kAvgIterations);
+    scenario.report(state);
+}
+
+const std::vector<int64_t> kEntityCounts = {1000, 10000, 100000, 500000};
+
+// ── Tick scaling ────────────────────────────────────────────────────────
+
+/// Args: entities, percent moved per tick, distribution.
+void BM_World_Tick(benchmark::State& state) {
+    Scenario scenario(static_cast<std::size_t>(state.range(0)), state.range(2));
+    runTicks(state, scenario, movesPerTick(scenario.count(), state.range(1)));
+}
+BENCHMARK(BM_World_Tick)
+    ->ArgNames({"entities", "movePct", "clustered"})
+    ->ArgsProduct({kEntityCounts, {1, 10, 100}, {kUniform, kClustered}})
+    ->Unit(benchmark::kMicrosecond);
+
+/// Tick with incremental interest management for 1% viewers.
+/// Args: entities, percent moved per tick, distribution.
+void BM_World_TickInterest(benchmark::State& state) {
+    Scenario scenario(static_cast<std::size_t>(state.range(0)), state.range(2), kDefaultCellSize,
+                      1.0, true);
+    runTicks(state, scenario, movesPerTick(scenario.count(), state.range(1)));
+}
+BENCHMARK(BM_World_TickInterest)
+    ->ArgNames({"entities", "movePct", "clustered"})
+    ->ArgsProduct({{1000, 10000, 100000}, {1, 10}, {kUniform, kClustered}})
+    ->Unit(benchmark::kMicrosecond);
+
+// ── Visibility ──────────────────────────────────────────────────────────
+
+/// One GetVisibleEntities() per iteration, cycling over 1% viewers.
+/// Args: entities, distribution.
+void BM_World_Visibility(benchmark::State& state) {
+    Scenario scenario(static_cast<std::size_t>(state.range(0)), state.range(1), kDefaultCellSize,
+                      1.0);
+    runVisibility(state, scenario);
+}
+BENCHMARK(BM_World_Visibility)
+    ->ArgNames({"entities", "clustered"})
+    ->ArgsProduct({kEntityCounts, {kUniform, kClustered}});
+
+// ── Cell size sweeps (100K clustered entities) ──────────────────────────
+
+const std::vector<int64_t> kCellSizes = {8, 16, 32, 64, 128};
+
+/// Args: cell size, percent moved per tick.
+void BM_World_CellSizeTick(benchmark::State& state) {
+    Scenario scenario(100000, kClustered, static_cast<float>(state.range(0)));
+    runTicks(state, scenario, movesPerTick(scenario.count(), state.range(1)));
+}
+BENCHMARK(BM_World_CellSizeTick)
+    ->ArgNames({"cellSize", "movePct"})
+    ->ArgsProduct({kCellSizes, {10, 100}})
+    ->Unit(benchmark::kMicrosecond);
+
+/// Args: cell size.
+void BM_World_CellSizeVisibility(benchmark::State& state) {
+    Scenario scenario(100000, kClustered, static_cast<float>(state.range(0)), 1.0);
+    runVisibility(state, scenario);
+}
+BENCHMARK(BM_World_CellSizeVisibility)->ArgName("cellSize")->ArgsProduct({kCellSizes});
+
+}  // namespace
@@ -114,7 +114,7 @@ int main() {
     auto swordSlotIdx = inv.FindItem(sword.id);
     if (swordSlotIdx.has_value()) {
         InventorySlot toEquip = inv.slots[*swordSlotIdx];
-        inv.slots[*swordSlotIdx].Clear();
+        inv.RemoveItem(*swordSlotIdx, toEquip.count);
 
         InventorySlot previous = equipment.Get(player).Equip(EquipSlot::MainHand, toEquip);
         if (!previous.IsEmpty()) {
@@ -145,6 +145,7 @@ int main() {
                     break;
                 }
             }
+            inv.Reindex();  // slots was written directly
             std::cout << "unequipped sword\n";
         }
     }
@@ -0,0 +1,374 @@
+#pragma once
+
+/// @file archetype_storage.hpp
+/// @brief Chunked archetype storage for entities that share a component set.
+///
+/// ArchetypeStorage<Ts...> keeps every entity that owns the component set
+/// Ts... in fixed-size chunks (16 KB by default).  Each chunk holds one
+/// tightly packed column per component type plus a column of entity ids,
+/// so a Query over the archetype walks memory linearly instead of probing
+/// one sparse array per joined pool.
+///
+/// The storage implements IComponentStorage, so it can be registered with
+/// EntityManager::RegisterStorage() for automatic cleanup on destroy, and
+/// Query<Includes...> accepts it in place of per-type ComponentStorages.
+///
+/// @see docs/advanced/ECS_DEEP_DIVE.md
+
+#include "cgs/ecs/component_storage.hpp"
+#include "cgs/ecs/component_type_id.hpp"
+#include "cgs/ecs/entity.hpp"
+#include "cgs/ecs/sparse_page_table.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace cgs::ecs {
+
+/// Type-erased chunk access used by Query to iterate archetype columns
+/// without knowing the archetype's full component list.
+class IArchetypeStorage : public IComponentStorage {
+public:
+    /// Number of allocated chunks that currently hold at least one entity.
+    [[nodiscard]] virtual std::size_t ChunkCount() const noexcept = 0;
+
+    /// Number of live rows in @p chunk.
+    [[nodiscard]] virtual std::size_t ChunkSize(std::size_t chunk) const noexcept = 0;
+
+    /// Entity id column of @p chunk (ChunkSize(chunk) entries).
+    [[nodiscard]] virtual const uint32_t* ChunkEntities(std::size_t chunk) const noexcept = 0;
+
+    /// Base pointer of the column for component @p type in @p chunk,
+    /// or nullptr when the archetype does not contain that type.
+    [[nodiscard]] virtual void* ChunkColumn(std::size_t chunk, ComponentTypeId type) noexcept = 0;
+};
+
+namespace detail {
+
+/// True when every type in the pack is distinct.
+template <typename... Ts>
+struct AllDistinct : std::true_type {};
+
+template <typename T, typename... Rest>
+struct AllDistinct<T, Rest...>
+    : std::bool_constant<(!std::is_same_v<T, Rest> && ...) && AllDistinct<Rest...>::value> {};
+
+/// Index of @p T within the pack @p Ts (sizeof...(Ts) when absent).
+template <typename T, typename... Ts>
+constexpr std::size_t kIndexOf = [] {
+    constexpr std::array<bool, sizeof...(Ts)> matches{std::is_same_v<T, Ts>...};
+    for (std::size_t i = 0; i < matches.size(); ++i) {
+        if (matches[i]) {
+            return i;
+        }
+    }
+    return sizeof...(Ts);
+}();
+
+}  // namespace detail
+
+/// Chunked structure-of-arrays storage for a fixed component set.
+///
+/// Memory layout of one chunk (capacity = kChunkCapacity rows):
+/// @code
+///   [ entity ids (uint32_t) | column<T0> | column<T1> | ... ]
+/// @endcode
+///
+/// Rows are kept dense across chunks: removing an entity moves the very
+/// last row into the hole, so only the final chunk is ever partially
+/// filled.  A paged entity-id -> row table provides O(1) Has / Get.
+///
+/// @tparam Ts  The component types every entity in the archetype owns.
+template <typename... Ts>
+class ArchetypeStorage final : public IArchetypeStorage {
+    static_assert(sizeof...(Ts) > 0, "Archetype must contain at least one component type");
+    static_assert(detail::AllDistinct<Ts...>::value, "Archetype component types must be distinct");
+    static_assert((std::is_move_constructible_v<Ts> && ...),
+                  "Component types must be move-constructible");
+
+public:
+    /// Target byte size of a single chunk.
+    static constexpr std::size_t kChunkBytes = 16 * 1024;
+
+    /// True when @p T is one of the archetype's component types.
+    template <typename T>
+    static constexpr bool kContains = detail::kIndexOf<T, Ts...> < sizeof...(Ts);
+
+private:
+    static constexpr std::size_t kColumnCount = sizeof...(Ts) + 1;
+    static constexpr std::size_t kRowBytes = sizeof(uint32_t) + (sizeof(Ts) + ...);
+    static constexpr std::size_t kAlignSlack = (alignof(Ts) + ...);
+
+public:
+    /// Number of rows stored per chunk.
+    static constexpr std::size_t kChunkCapacity =
+        kChunkBytes > kRowBytes + kAlignSlack ? (kChunkBytes - kAlignSlack) / kRowBytes : 1;
+
+private:
+    static constexpr std::size_t kChunkAlignment =
+        std::max({std::size_t{64}, alignof(uint32_t), alignof(Ts)...});
+
+    /// Byte offset of each column inside a chunk (entity ids first).
+    static constexpr std::array<std::size_t, kColumnCount + 1> kOffsets = [] {
+        constexpr std::array<std::size_t, kColumnCount> sizes{sizeof(uint32_t), sizeof(Ts)...};
+        constexpr std::array<std::size_t, kColumnCount> aligns{alignof(uint32_t), alignof(Ts)...};
+        std::array<std::size_t, kColumnCount + 1> offsets{};
+        std::size_t cursor = 0;
+        for (std::size_t i = 0; i < kColumnCount; ++i) {
+            cursor = (cursor + aligns[i] - 1) / aligns[i] * aligns[i];
+            offsets[i] = cursor;
+            cursor += sizes[i] * kChunkCapacity;
+        }
+        offsets[kColumnCount] = cursor;
+        return offsets;
+    }();
+
+    static constexpr std::size_t kChunkAllocBytes = kOffsets[kColumnCount];
+
+public:
+    ArchetypeStorage() = default;
+    ~ArchetypeStorage() override { destroyAll(); }
+
+    // Non-copyable, movable.
+    ArchetypeStorage(const ArchetypeStorage&) = delete;
+    ArchetypeStorage& operator=(const ArchetypeStorage&) = delete;
+    ArchetypeStorage(ArchetypeStorage&& other) noexcept
+        : chunks_(std::move(other.chunks_)),
+          spare_(std::move(other.spare_)),
+          sparse_(std::move(other.sparse_)),
+          size_(std::exchange(other.size_, 0)),
+          globalVersion_(other.globalVersion_) {}
+    ArchetypeStorage& operator=(ArchetypeStorage&& other) noexcept {
+        if (this != &other) {
+            destroyAll();
+            chunks_ = std::move(other.chunks_);
+            spare_ = std::move(other.spare_);
+            sparse_ = std::move(other.sparse_);
+            size_ = std::exchange(other.size_, 0);
+            globalVersion_ = other.globalVersion_;
+        }
+        return *this;
+    }
+
+    // ── Capacity ────────────────────────────────────────────────────────
+
+    /// Number of stored entities.
+    [[nodiscard]] std::size_t Size() const override { return size_; }
+
+    /// True when no entities are stored.
+    [[nodiscard]] bool Empty() const noexcept { return size_ == 0; }
+
+    // ── CRUD ────────────────────────────────────────────────────────────
+
+    /// Add @p entity with default-constructed components.
+    /// @pre `!Has(entity)`.
+    void Add(Entity entity) { emplaceRow(entity, Ts{}...); }
+
+    /// Add @p entity with the given component values (one per type, in
+    /// archetype order).
+    /// @pre `!Has(entity)`.
+    void Add(Entity entity, Ts... components) { emplaceRow(entity, std::move(components)...); }
+
+    /// Get a mutable reference to component @p T of @p entity.
+    /// @pre `Has(entity)`.
+    template <typename T>
+    [[nodiscard]] T& Get(Entity entity) {
+        static_assert(kContains<T>, "Component type is not part of this archetype");
+        assert(Has(entity) && "Entity is not stored in this archetype");
+        const uint32_t row = sparse_.Get(entity.id());
+        return column<T>(*chunks_[row / kChunkCapacity])[row % kChunkCapacity];
+    }
+
+    /// Get a const reference to component @p T of @p entity.
+    template <typename T>
+    [[nodiscard]] const T& Get(Entity entity) const {
+        static_assert(kContains<T>, "Component type is not part of this archetype");
+        assert(Has(entity) && "Entity is not stored in this archetype");
+        const uint32_t row = sparse_.Get(entity.id());
+        return column<T>(*chunks_[row / kChunkCapacity])[row % kChunkCapacity];
+    }
+
+    /// Check whether @p entity is stored in this archetype.
+    [[nodiscard]] bool Has(Entity entity) const override {
+        return sparse_.Contains(entity.id());
+    }
+
+    /// Remove @p entity and all its components (no-op when absent).
+    void Remove(Entity entity) override {
+        if (!Has(entity)) {
+            return;
+        }
+
+        const uint32_t row = sparse_.Get(entity.id());
+        const auto lastRow = static_cast<uint32_t>(size_ - 1);
+        Chunk& lastChunk = *chunks_[lastRow / kChunkCapacity];
+        const std::size_t lastIdx = lastRow % kChunkCapacity;
+
+        if (row != lastRow) {
+            // Move the final row into the hole to keep chunks dense.
+            Chunk& chunk = *chunks_[row / kChunkCapacity];
+            const std::size_t idx = row % kChunkCapacity;
+            ((column<Ts>(chunk)[idx] = std::move(column<Ts>(lastChunk)[lastIdx])), ...);
+            const uint32_t movedId = ids(lastChunk)[lastIdx];
+            ids(chunk)[idx] = movedId;
+            sparse_.Update(movedId, row);
+        }
+
+        (std::destroy_at(&column<Ts>(lastChunk)[lastIdx]), ...);
+        --lastChunk.count;
+        --size_;
+        sparse_.Reset(entity.id());
+
+        if (lastChunk.count == 0) {
+            // Keep one empty chunk around so add/remove at a chunk
+            // boundary does not thrash the allocator.
+            spare_ = std::move(chunks_.back());
+            chunks_.pop_back();
+        }
+
+        ++globalVersion_;
+    }
+
+    /// Remove all entities.
+    void Clear() override {
+        destroyAll();
+        ++globalVersion_;
+    }
+
+    // ── Iteration ───────────────────────────────────────────────────────
+
+    /// Return the entity id stored at dense row @p index.
+    [[nodiscard]] uint32_t EntityAt(std::size_t index) const override {
+        assert(index < size_);
+        return ids(*chunks_[index / kChunkCapacity])[index % kChunkCapacity];
+    }
+
+    [[nodiscard]] std::size_t ChunkCount() const noexcept override { return chunks_.size(); }
+
+    [[nodiscard]] std::size_t ChunkSize(std::size_t chunk) const noexcept override {
+        assert(chunk < chunks_.size());
+        return chunks_[chunk]->count;
+    }
+
+    [[nodiscard]] const uint32_t* ChunkEntities(std::size_t chunk) const noexcept override {
+        assert(chunk < chunks_.size());
+        return ids(*chunks_[chunk]);
+    }
+
+    [[nodiscard]] void* ChunkColumn(std::size_t chunk, ComponentTypeId type) noexcept override {
+        assert(chunk < chunks_.size());
+        void* result = nullptr;
+        Chunk& c = *chunks_[chunk];
+        ((type == ComponentType<Ts>::Id() ? (result = column<Ts>(c), true) : false) || ...);
+        return result;
+    }
+
+    /// Typed column access for @p chunk (ChunkSize(chunk) entries).
+    template <typename T>
+    [[nodiscard]] T* Column(std::size_t chunk) noexcept {
+        static_assert(kContains<T>, "Component type is not part of this archetype");
+        assert(chunk < chunks_.size());
+        return column<T>(*chunks_[chunk]);
+    }
+
+    // ── Version / change detection ──────────────────────────────────────
+
+    /// Return the storage's global modification version counter.
+    [[nodiscard]] uint32_t Version() const noexcept override { return globalVersion_; }
+
+    /// Explicitly mark the archetype as changed (e.g. after bulk writes
+    /// through Column()).
+    void MarkChanged() noexcept { ++globalVersion_; }
+
+    /// The current global version counter.
+    [[nodiscard]] uint32_t GlobalVersion() const noexcept { return globalVersion_; }
+
+private:
+    /// Aligned raw chunk buffer plus its live row count.
+    struct Chunk {
+        struct Deleter {
+            void operator()(std::byte* p) const noexcept {
+                ::operator delete(p, std::align_val_t{kChunkAlignment});
+            }
+        };
+
+        Chunk()
+            : data(static_cast<std::byte*>(
+                  ::operator new(kChunkAllocBytes, std::align_val_t{kChunkAlignment}))) {}
+
+        std::unique_ptr<std::byte[], Deleter> data;
+        std::size_t count = 0;
+    };
+
+    template <typename T>
+    [[nodiscard]] static T* column(Chunk& chunk) noexcept {
+        constexpr std::size_t offset = kOffsets[detail::kIndexOf<T, Ts...> + 1];
+        return std::launder(static_cast<T*>(static_cast<void*>(chunk.data.get() + offset)));
+    }
+
+    template <typename T>
+    [[nodiscard]] static const T* column(const Chunk& chunk) noexcept {
+        constexpr std::size_t offset = kOffsets[detail::kIndexOf<T, Ts...> + 1];
+        return std::launder(
+            static_cast<const T*>(static_cast<const void*>(chunk.data.get() + offset)));
+    }
+
+    [[nodiscard]] static uint32_t* ids(Chunk& chunk) noexcept {
+        return static_cast<uint32_t*>(static_cast<void*>(chunk.data.get() + kOffsets[0]));
+    }
+
+    [[nodiscard]] static const uint32_t* ids(const Chunk& chunk) noexcept {
+        return static_cast<const uint32_t*>(
+            static_cast<const void*>(chunk.data.get() + kOffsets[0]));
+    }
+
+    template <typename... Args>
+    void emplaceRow(Entity entity, Args&&... components) {
+        assert(entity.isValid() && "Cannot add invalid entity to archetype");
+        assert(!Has(entity) && "Entity is already stored in this archetype");
+
+        if (chunks_.empty() || chunks_.back()->count == kChunkCapacity) {
+            chunks_.push_back(spare_ ? std::move(spare_) : std::make_unique<Chunk>());
+        }
+
+        Chunk& chunk = *chunks_.back();
+        const std::size_t idx = chunk.count;
+        (::new (static_cast<void*>(&column<Ts>(chunk)[idx])) Ts(std::forward<Args>(components)),
+         ...);
+        ids(chunk)[idx] = entity.id();
+        ++chunk.count;
+
+        sparse_.Set(entity.id(), static_cast<uint32_t>(size_));
+        ++size_;
+        ++globalVersion_;
+    }
+
+    void destroyAll() noexcept {
+        for (auto& chunk : chunks_) {
+            for (std::size_t i = 0; i < chunk->count; ++i) {
+                (std::destroy_at(&column<Ts>(*chunk)[i]), ...);
+            }
+            chunk->count = 0;
+        }
+        chunks_.clear();
+        sparse_.Clear();
+        size_ = 0;
+    }
+
+    std::vector<std::unique_ptr<Chunk>> chunks_;  ///< Dense chunk list.
+    std::unique_ptr<Chunk> spare_;                ///< Recycled empty chunk.
+    SparsePageTable sparse_;                      ///< entity id -> dense row.
+    std::size_t size_ = 0;                        ///< Total live rows.
+    uint32_t globalVersion_ = 0;                  ///< Monotonically increasing version.
+};
+
+}  // namespace cgs::ecs
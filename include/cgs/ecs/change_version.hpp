@@ -0,0 +1,60 @@
+#pragma once
+
+/// @file change_version.hpp
+/// @brief Shared change clock for component version stamps.
+///
+/// Every component storage stamps additions and modifications with a
+/// version drawn from one process-wide counter, so versions taken from
+/// different storages are directly comparable.  SystemScheduler records
+/// the clock when a system starts; on its next run the system can ask a
+/// Query for only the entities whose components changed since then.
+///
+/// The counter is 32 bits and wraps.  Comparisons use serial-number
+/// arithmetic (IsNewerVersion), which is correct as long as the two
+/// versions being compared are less than 2^31 changes apart.  Components
+/// that have not changed for longer than that may be reported as changed
+/// once more; a change is never missed.
+///
+/// @see docs/advanced/ECS_DEEP_DIVE.md  Section 6.7
+
+#include <atomic>
+#include <cstdint>
+
+namespace cgs::ecs {
+
+/// "Since" value that matches every stamped version (e.g. a system that
+/// has never run).  The clock never hands this value out.
+inline constexpr uint32_t kAnyVersion = 0;
+
+namespace detail {
+
+inline std::atomic<uint32_t>& changeClock() noexcept {
+    static std::atomic<uint32_t> clock{kAnyVersion};
+    return clock;
+}
+
+}  // namespace detail
+
+/// Draw the next version stamp from the shared change clock.
+inline uint32_t NextChangeVersion() noexcept {
+    uint32_t version = detail::changeClock().fetch_add(1, std::memory_order_relaxed) + 1;
+    if (version == kAnyVersion) {
+        // Skip the sentinel when the counter wraps.
+        version = detail::changeClock().fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+    return version;
+}
+
+/// Latest version handed out by NextChangeVersion().
+///
+/// Anything stamped after this call compares as newer than the result.
+[[nodiscard]] inline uint32_t CurrentChangeVersion() noexcept {
+    return detail::changeClock().load(std::memory_order_relaxed);
+}
+
+/// True when @p version was stamped after @p sinceVersion.
+[[nodiscard]] constexpr bool IsNewerVersion(uint32_t version, uint32_t sinceVersion) noexcept {
+    return sinceVersion == kAnyVersion || static_cast<int32_t>(version - sinceVersion) > 0;
+}
+
+}  // namespace cgs::ecs
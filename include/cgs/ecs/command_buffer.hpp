@@ -0,0 +1,263 @@
+#pragma once
+
+/// @file command_buffer.hpp
+/// @brief Deferred structural changes recorded per thread and applied at
+///        scheduler sync points.
+///
+/// Systems running in a parallel batch must not create entities or add
+/// and remove components directly: those calls reorder dense arrays that
+/// other systems in the batch may be iterating.  Instead each thread
+/// records into its own CommandBuffer (obtained from
+/// CommandBufferSet::Local()), and SystemScheduler plays every buffer back
+/// once the batch has finished.
+///
+/// Playback order:
+///   1. Entity creations, so recorded commands can target new entities.
+///   2. Component adds/removes, grouped by storage.  Commands on the same
+///      storage keep their recording order; order between threads is
+///      unspecified.
+///   3. Entity destructions, through EntityManager::DestroyMany().
+///
+/// Commands that target an entity which is no longer alive at playback
+/// are dropped.
+///
+/// @see docs/advanced/ECS_DEEP_DIVE.md  Section 6.10
+
+#include "cgs/ecs/component_storage.hpp"
+#include "cgs/ecs/entity.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace cgs::ecs {
+
+class EntityManager;
+
+/// Entity created through a CommandBuffer but not yet played back.
+///
+/// Only meaningful to the buffer that returned it.
+struct PendingEntity {
+    uint32_t index = 0;
+};
+
+namespace detail {
+
+/// Type-erased per-storage column of recorded component values.
+class CommandPayloads {
+public:
+    explicit CommandPayloads(ComponentTypeId type) noexcept : type_(type) {}
+    virtual ~CommandPayloads() = default;
+
+    /// Component type of the values this column holds.
+    [[nodiscard]] ComponentTypeId Type() const noexcept { return type_; }
+
+    /// Add (or replace) the value in @p slot on @p target.
+    virtual void Apply(uint32_t slot, Entity target) = 0;
+
+    virtual void Clear() noexcept = 0;
+
+private:
+    ComponentTypeId type_;
+};
+
+template <typename T>
+class TypedCommandPayloads final : public CommandPayloads {
+public:
+    explicit TypedCommandPayloads(ComponentStorage<T>& storage)
+        : CommandPayloads(ComponentStorage<T>::TypeId()), storage_(&storage) {}
+
+    uint32_t Push(T value) {
+        values_.push_back(std::move(value));
+        return static_cast<uint32_t>(values_.size() - 1);
+    }
+
+    void Apply(uint32_t slot, Entity target) override {
+        auto& value = values_[slot];
+        if (storage_->Has(target)) {
+            storage_->Replace(target, std::move(value));
+        } else {
+            storage_->Add(target, std::move(value));
+        }
+    }
+
+    void Clear() noexcept override { values_.clear(); }
+
+private:
+    ComponentStorage<T>* storage_;
+    std::vector<T> values_;
+};
+
+}  // namespace detail
+
+/// Single-threaded recording of deferred entity and component commands.
+///
+/// Component values are stored in one typed column per target storage,
+/// so recording an Add does not allocate per command once the buffer has
+/// warmed up.  Buffers are reused across frames and keep their capacity.
+class CommandBuffer {
+public:
+    CommandBuffer() = default;
+
+    // Non-copyable, movable.
+    CommandBuffer(const CommandBuffer&) = delete;
+    CommandBuffer& operator=(const CommandBuffer&) = delete;
+    CommandBuffer(CommandBuffer&&) noexcept = default;
+    CommandBuffer& operator=(CommandBuffer&&) noexcept = default;
+
+    // ── Recording ───────────────────────────────────────────────────────
+
+    /// Record the creation of an entity.
+    [[nodiscard]] PendingEntity Create() { return PendingEntity{creates_++}; }
+
+    /// Record adding @p component to @p entity in @p storage.
+    ///
+    /// If the entity already has the component at playback, it is
+    /// replaced instead.
+    template <typename T>
+    void Add(ComponentStorage<T>& storage, Entity entity, T component = T{}) {
+        record(storage, entity, kNotPending, std::move(component));
+    }
+
+    /// Record adding @p component to an entity created by this buffer.
+    template <typename T>
+    void Add(ComponentStorage<T>& storage, PendingEntity entity, T component = T{}) {
+        record(storage, Entity{}, entity.index, std::move(component));
+    }
+
+    /// Record removing @p entity's component from @p storage.
+    void Remove(IComponentStorage& storage, Entity entity) {
+        commands_.push_back(Command{&storage, nullptr, entity, kNotPending, 0, Op::Remove});
+    }
+
+    /// Record the destruction of @p entity and all its components.
+    void Destroy(Entity entity) { destroys_.push_back(entity); }
+
+    // ── State ───────────────────────────────────────────────────────────
+
+    /// True when nothing has been recorded since the last playback.
+    [[nodiscard]] bool Empty() const noexcept {
+        return creates_ == 0 && commands_.empty() && destroys_.empty();
+    }
+
+    /// Number of recorded commands (creations included).
+    [[nodiscard]] std::size_t CommandCount() const noexcept {
+        return creates_ + commands_.size() + destroys_.size();
+    }
+
+    /// Discard every recorded command, keeping allocated capacity.
+    void Clear() noexcept {
+        creates_ = 0;
+        commands_.clear();
+        destroys_.clear();
+        for (auto& [storage, payloads] : payloads_) {
+            payloads->Clear();
+        }
+    }
+
+private:
+    friend class CommandBufferSet;
+
+    static constexpr uint32_t kNotPending = static_cast<uint32_t>(-1);
+
+    enum class Op : uint8_t { Add, Remove };
+
+    struct Command {
+        IComponentStorage* storage = nullptr;
+        detail::CommandPayloads* payloads = nullptr;  ///< Add only.
+        Entity entity;                                ///< Used when pending == kNotPending.
+        uint32_t pending = kNotPending;               ///< PendingEntity index.
+        uint32_t slot = 0;                            ///< Payload slot (Add only).
+        Op op = Op::Add;
+    };
+
+    template <typename T>
+    void record(ComponentStorage<T>& storage, Entity entity, uint32_t pending, T&& component) {
+        auto& slot = payloads_[&storage];
+        // Pooled buffers outlive playbacks, so a storage freed since then
+        // may have left its address to a storage of another type.
+        if (!slot || slot->Type() != ComponentStorage<T>::TypeId()) {
+            slot = std::make_unique<detail::TypedCommandPayloads<T>>(storage);
+        }
+        auto& typed = static_cast<detail::TypedCommandPayloads<T>&>(*slot);
+        const uint32_t index = typed.Push(std::move(component));
+        commands_.push_back(Command{&storage, slot.get(), entity, pending, index, Op::Add});
+    }
+
+    uint32_t creates_ = 0;
+    std::vector<Command> commands_;
+    std::vector<Entity> destroys_;
+    std::unordered_map<const IComponentStorage*, std::unique_ptr<detail::CommandPayloads>>
+        payloads_;
+};
+
+/// One CommandBuffer per recording thread, played back together.
+///
+/// Local() is safe to call concurrently; Playback() must not overlap
+/// with recording.  SystemScheduler calls Playback() after each parallel
+/// batch (and hence at every AddSyncPoint boundary) when the set is
+/// attached with SetCommandBuffers().
+///
+/// @code
+///   void Execute(float) override {
+///       auto& cmd = commands_.Local();
+///       query_.ForEach([&](Entity e, const Health& h) {
+///           if (h.current <= 0) cmd.Destroy(e);
+///       });
+///   }
+/// @endcode
+class CommandBufferSet {
+public:
+    /// @param entities  Manager used to create and destroy entities.
+    explicit CommandBufferSet(EntityManager& entities) : entities_(&entities) {}
+
+    // Non-copyable, non-movable (threads hold references to buffers).
+    CommandBufferSet(const CommandBufferSet&) = delete;
+    CommandBufferSet& operator=(const CommandBufferSet&) = delete;
+    CommandBufferSet(CommandBufferSet&&) = delete;
+    CommandBufferSet& operator=(CommandBufferSet&&) = delete;
+
+    /// Buffer owned by the calling thread until the next Playback().
+    [[nodiscard]] CommandBuffer& Local();
+
+    /// Apply and clear every buffer recorded since the last playback.
+    void Playback();
+
+    /// True when no buffer holds recorded commands.
+    [[nodiscard]] bool Empty() const;
+
+private:
+    struct ThreadBuffer {
+        std::thread::id thread;
+        std::unique_ptr<CommandBuffer> buffer;
+    };
+
+    /// Component command with its target resolved to a live entity.
+    struct ResolvedCommand {
+        const CommandBuffer::Command* command = nullptr;
+        Entity entity;
+    };
+
+    EntityManager* entities_;
+
+    mutable std::mutex mutex_;
+
+    /// Buffers handed out since the last playback, in first-use order.
+    std::vector<ThreadBuffer> active_;
+
+    /// Cleared buffers kept for reuse by whichever thread records next.
+    std::vector<std::unique_ptr<CommandBuffer>> idle_;
+
+    // Playback scratch, reused across calls.
+    std::vector<Entity> created_;
+    std::vector<std::size_t> bases_;
+    std::vector<ResolvedCommand> resolved_;
+    std::vector<Entity> destroyed_;
+};
+
+}  // namespace cgs::ecs
@@ -0,0 +1,111 @@
+#pragma once
+
+/// @file component_mask.hpp
+/// @brief Fixed-width bitmask over ComponentTypeId values.
+///
+/// Used by SystemAccessInfo so that access-conflict checks are a handful
+/// of word-wise AND operations instead of hash-set intersections.
+///
+/// The width is CGS_ECS_COMPONENT_MASK_BITS (default 256, a multiple of
+/// 64).  Ids at or beyond the width share a bit with `id % width`: two
+/// such components may be reported as overlapping when they are not,
+/// which only costs parallelism, never safety.
+///
+/// @see docs/advanced/ECS_DEEP_DIVE.md  Section 6.3
+
+#include "cgs/ecs/component_type_id.hpp"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#ifndef CGS_ECS_COMPONENT_MASK_BITS
+#define CGS_ECS_COMPONENT_MASK_BITS 256
+#endif
+
+namespace cgs::ecs {
+
+/// Set of component types, one bit per ComponentTypeId.
+///
+/// Offers the subset of the std::unordered_set interface that access
+/// declarations use (insert/count/contains/empty/size), plus bitwise
+/// union and intersection tests.
+class ComponentMask {
+public:
+    /// Number of distinct bits.
+    static constexpr std::size_t kBits = CGS_ECS_COMPONENT_MASK_BITS;
+
+    static_assert(kBits > 0 && kBits % 64 == 0,
+                  "CGS_ECS_COMPONENT_MASK_BITS must be a positive multiple of 64");
+
+    constexpr ComponentMask() noexcept = default;
+
+    /// Add @p id to the set.
+    constexpr void insert(ComponentTypeId id) noexcept {
+        const auto bit = static_cast<std::size_t>(id) % kBits;
+        words_[bit / 64] |= uint64_t{1} << (bit % 64);
+    }
+
+    /// True when @p id (or an id sharing its bit) is in the set.
+    [[nodiscard]] constexpr bool contains(ComponentTypeId id) const noexcept {
+        const auto bit = static_cast<std::size_t>(id) % kBits;
+        return (words_[bit / 64] >> (bit % 64) & 1u) != 0;
+    }
+
+    /// 1 if contains(@p id), else 0.
+    [[nodiscard]] constexpr std::size_t count(ComponentTypeId id) const noexcept {
+        return contains(id) ? 1 : 0;
+    }
+
+    [[nodiscard]] constexpr bool empty() const noexcept {
+        for (auto word : words_) {
+            if (word != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Number of set bits.
+    [[nodiscard]] constexpr std::size_t size() const noexcept {
+        std::size_t total = 0;
+        for (auto word : words_) {
+            total += static_cast<std::size_t>(std::popcount(word));
+        }
+        return total;
+    }
+
+    /// True when the two sets share at least one bit.
+    [[nodiscard]] constexpr bool Intersects(const ComponentMask& other) const noexcept {
+        uint64_t overlap = 0;
+        for (std::size_t w = 0; w < kWords; ++w) {
+            overlap |= words_[w] & other.words_[w];
+        }
+        return overlap != 0;
+    }
+
+    /// Union with @p other.
+    constexpr ComponentMask& operator|=(const ComponentMask& other) noexcept {
+        for (std::size_t w = 0; w < kWords; ++w) {
+            words_[w] |= other.words_[w];
+        }
+        return *this;
+    }
+
+    [[nodiscard]] friend constexpr ComponentMask operator|(ComponentMask lhs,
+                                                           const ComponentMask& rhs) noexcept {
+        lhs |= rhs;
+        return lhs;
+    }
+
+    [[nodiscard]] friend constexpr bool operator==(const ComponentMask&,
+                                                   const ComponentMask&) noexcept = default;
+
+private:
+    static constexpr std::size_t kWords = kBits / 64;
+
+    std::array<uint64_t, kWords> words_{};
+};
+
+}  // namespace cgs::ecs
@@ -7,20 +7,42 @@
 /// cache-friendly dense iteration over all components of type T.
 /// A per-component version counter supports change detection.
 ///
+/// Empty component types (tags) select a membership-only specialization:
+/// a dense id list plus a PagedBitset, with no component data or
+/// per-component versions.
+///
+/// Pools of trivially copyable components can be checkpointed as a byte
+/// image with SerializeDense() / DeserializeDense() (dense_image.hpp).
+///
 /// @see docs/reference/ECS_DESIGN.md  Section 2.3
 
+#include "cgs/ecs/change_version.hpp"
 #include "cgs/ecs/component_type_id.hpp"
+#include "cgs/ecs/dense_array.hpp"
+#include "cgs/ecs/dense_image.hpp"
 #include "cgs/ecs/entity.hpp"
+#include "cgs/ecs/paged_bitset.hpp"
+#include "cgs/ecs/prefetch.hpp"
+#include "cgs/ecs/sparse_page_table.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <iterator>
 #include <limits>
+#include <mutex>
+#include <span>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
 namespace cgs::ecs {
 
+class IStorageListener;
+
 /// Type-erased base for component pools, allowing EntityManager to
 /// call Remove / Has / Clear without knowing the component type.
 class IComponentStorage {
@@ -28,6 +50,15 @@ public:
     virtual ~IComponentStorage() = default;
 
     virtual void Remove(Entity entity) = 0;
+
+    /// Remove the components of every entity in @p entities (absent ones
+    /// are skipped).  Storages override this to batch the work.
+    virtual void RemoveMany(std::span<const Entity> entities) {
+        for (const Entity entity : entities) {
+            Remove(entity);
+        }
+    }
+
     [[nodiscard]] virtual bool Has(Entity entity) const = 0;
     virtual void Clear() = 0;
     [[nodiscard]] virtual std::size_t Size() const = 0;
@@ -37,29 +68,126 @@ public:
 
     /// Return the storage's global modification version counter.
     [[nodiscard]] virtual uint32_t Version() const noexcept = 0;
+
+    /// Subscribe @p listener to add/remove notifications.
+    ///
+    /// Listeners observe the pool without changing it, so subscribing
+    /// works through a const reference.
+    /// @return false when this kind of storage does not emit them.
+    virtual bool AddListener(IStorageListener* /*listener*/) const { return false; }
+
+    /// Unsubscribe @p listener (no-op if it is not subscribed).
+    virtual void RemoveListener(IStorageListener* /*listener*/) const noexcept {}
+};
+
+/// Observer of a pool's membership changes (see Query).
+///
+/// Unlike IStorageOwner, a pool may have any number of listeners and they
+/// never reorder it.  Callbacks run on the thread modifying the pool.
+class IStorageListener {
+public:
+    virtual ~IStorageListener() = default;
+
+    /// A component was added for @p entity.
+    virtual void OnComponentAdded(Entity entity) = 0;
+
+    /// The component of @p entity is about to be removed.
+    virtual void OnComponentRemoved(Entity entity) = 0;
+
+    /// Every component was removed.
+    virtual void OnStorageCleared() noexcept = 0;
+};
+
+/// Structural observer of a component pool (see OwningGroup).
+///
+/// A pool has at most one owner.  OnAdded() runs after a component is
+/// inserted, OnRemoving() before one is erased, OnCleared() after Clear().
+class IStorageOwner {
+public:
+    virtual ~IStorageOwner() = default;
+
+    virtual void OnAdded(Entity entity) = 0;
+    virtual void OnRemoving(Entity entity) = 0;
+    virtual void OnCleared() noexcept = 0;
+};
+
+/// Membership observers of one pool (see IStorageListener).
+///
+/// Subscribing is const: Query caches subscribe lazily when they
+/// rebuild, which read-only systems sharing a parallel stage can do on
+/// the same pool at once, so Add() and Remove() are locked.  Callbacks
+/// run on the thread modifying the pool, which the scheduler never runs
+/// alongside a reader, so iterating takes no lock.
+class StorageListeners {
+public:
+    StorageListeners() = default;
+
+    StorageListeners(const StorageListeners& other) : listeners_(other.snapshot()) {}
+
+    StorageListeners& operator=(const StorageListeners& other) {
+        if (this != &other) {
+            auto copy = other.snapshot();
+            std::lock_guard lock(mutex_);
+            listeners_ = std::move(copy);
+        }
+        return *this;
+    }
+
+    void Add(IStorageListener* listener) {
+        std::lock_guard lock(mutex_);
+        listeners_.push_back(listener);
+    }
+
+    void Remove(IStorageListener* listener) noexcept {
+        std::lock_guard lock(mutex_);
+        std::erase(listeners_, listener);
+    }
+
+    [[nodiscard]] std::size_t Size() const noexcept {
+        std::lock_guard lock(mutex_);
+        return listeners_.size();
+    }
+
+    [[nodiscard]] auto begin() const noexcept { return listeners_.begin(); }
+    [[nodiscard]] auto end() const noexcept { return listeners_.end(); }
+
+private:
+    [[nodiscard]] std::vector<IStorageListener*> snapshot() const {
+        std::lock_guard lock(mutex_);
+        return listeners_;
+    }
+
+    mutable std::mutex mutex_;
+    std::vector<IStorageListener*> listeners_;
 };
 
 /// Sparse-set component storage.
 ///
 /// Memory layout:
 /// @code
-///   sparse_  [entity.id] -> dense index  (or kInvalidIndex)
+///   sparse_  [entity.id] -> dense index  (paged, or kInvalidIndex)
 ///   dense_   [index]     -> component data
 ///   entities_[index]     -> entity.id that owns dense_[index]
 ///   versions_[index]     -> change counter for dense_[index]
+///   added_   [index]     -> version at which dense_[index] was added
 /// @endcode
 ///
-/// All mutating operations bump a global version counter; the per-component
-/// version is set to globalVersion_ at the point of modification so that
-/// systems can efficiently detect stale data.
+/// The sparse side is a SparsePageTable, so its memory tracks the number
+/// of pages holding live components rather than the highest entity id.
+///
+/// All mutating operations draw a new version from the shared change clock
+/// (change_version.hpp) and record it as globalVersion_; the per-component
+/// version is set to that value at the point of modification so that
+/// systems can efficiently detect stale data.  Because the clock is shared,
+/// versions from different storages are comparable.
 template <typename T>
 class ComponentStorage final : public IComponentStorage {
 public:
     static_assert(std::is_move_constructible_v<T>, "Component type must be move-constructible");
 
     using value_type = T;
-    using iterator = typename std::vector<T>::iterator;
-    using const_iterator = typename std::vector<T>::const_iterator;
+    using iterator = typename DenseArray<T>::iterator;
+    using const_iterator = typename DenseArray<T>::const_iterator;
 
     // ── Capacity ────────────────────────────────────────────────────────
 
@@ -81,13 +209,22 @@ public:
 
         const auto idx = static_cast<uint32_t>(dense_.size());
 
-        ensureSparseSize(entity.id());
-        sparse_[entity.id()] = idx;
+        sparse_.Set(entity.id(), idx);
 
         dense_.emplace_back(std::forward<Args>(args)...);
         entities_.push_back(entity.id());
-        versions_.push_back(++globalVersion_);
+        globalVersion_ = NextChangeVersion();
+        versions_.push_back(globalVersion_);
+        added_.push_back(globalVersion_);
 
+        for (auto* listener : listeners_) {
+            listener->OnComponentAdded(entity);
+        }
+        if (owner_ != nullptr) {
+            // The owner may move the new component to another dense slot.
+            owner_->OnAdded(entity);
+            return dense_[sparse_.Get(entity.id())];
+        }
         return dense_.back();
     }
 
@@ -95,28 +232,41 @@ public:
     /// @pre `Has(entity)` — accessing a missing component is undefined.
     [[nodiscard]] T& Get(Entity entity) {
         assert(Has(entity) && "Entity does not have this component");
-        return dense_[sparse_[entity.id()]];
+        return dense_[sparse_.Get(entity.id())];
     }
 
     /// Get a const reference to the component owned by @p entity.
     [[nodiscard]] const T& Get(Entity entity) const {
         assert(Has(entity) && "Entity does not have this component");
-        return dense_[sparse_[entity.id()]];
+        return dense_[sparse_.Get(entity.id())];
     }
 
     /// Replace the component for @p entity and bump its version.
     /// @pre `Has(entity)`.
     void Replace(Entity entity, T&& component) {
         assert(Has(entity) && "Entity does not have this component");
-        auto idx = sparse_[entity.id()];
+        auto idx = sparse_.Get(entity.id());
         dense_[idx] = std::move(component);
-        versions_[idx] = ++globalVersion_;
+        globalVersion_ = NextChangeVersion();
+        versions_[idx] = globalVersion_;
     }
 
     /// Check whether @p entity has a component in this storage.
     [[nodiscard]] bool Has(Entity entity) const override {
-        auto eid = entity.id();
-        return eid < sparse_.size() && sparse_[eid] != kInvalidIndex;
+        return sparse_.Contains(entity.id());
+    }
+
+    /// Start loading @p entity's sparse slot into cache.  Query lookahead
+    /// loops issue this a few entities ahead of PrefetchComponent().
+    void PrefetchIndex(Entity entity) const noexcept { sparse_.Prefetch(entity.id()); }
+
+    /// Start loading @p entity's component into cache.  Reads the sparse
+    /// slot, so it pays off once PrefetchIndex() has brought that in.
+    void PrefetchComponent(Entity entity) const noexcept {
+        const uint32_t idx = sparse_.Get(entity.id());
+        if (idx < dense_.size()) {
+            PrefetchForRead(dense_.data() + idx);
+        }
     }
 
     /// Remove the component owned by @p entity.
@@ -126,7 +276,14 @@ public:
             return;
         }
 
-        auto idx = sparse_[entity.id()];
+        if (owner_ != nullptr) {
+            owner_->OnRemoving(entity);
+        }
+        for (auto* listener : listeners_) {
+            listener->OnComponentRemoved(entity);
+        }
+
+        auto idx = sparse_.Get(entity.id());
         auto lastIdx = static_cast<uint32_t>(dense_.size() - 1);
 
         if (idx != lastIdx) {
@@ -134,17 +291,19 @@ public:
             dense_[idx] = std::move(dense_[lastIdx]);
             entities_[idx] = entities_[lastIdx];
             versions_[idx] = versions_[lastIdx];
+            added_[idx] = added_[lastIdx];
 
             // Update the sparse entry for the moved entity.
-            sparse_[entities_[idx]] = idx;
+            sparse_.Update(entities_[idx], idx);
         }
 
         dense_.pop_back();
         entities_.pop_back();
         versions_.pop_back();
-        sparse_[entity.id()] = kInvalidIndex;
+        added_.pop_back();
+        sparse_.Reset(entity.id());
 
-        ++globalVersion_;
+        globalVersion_ = NextChangeVersion();
     }
 
     /// Get or add: return the existing component or default-construct one.
@@ -155,13 +314,68 @@ public:
         return Add(entity);
     }
 
+    /// Remove the components of every entity in @p entities.
+    ///
+    /// Rows are erased in descending dense order so each swap-and-pop
+    /// only ever moves a surviving component, and the global version is
+    /// bumped once for the whole batch.  Absent entities are skipped.
+    void RemoveMany(std::span<const Entity> entities) override {
+        if (owner_ != nullptr) {
+            // Groups must see every removal individually to keep order.
+            IComponentStorage::RemoveMany(entities);
+            return;
+        }
+
+        std::vector<uint32_t> rows;
+        rows.reserve(entities.size());
+        for (const Entity entity : entities) {
+            if (Has(entity)) {
+                rows.push_back(sparse_.Get(entity.id()));
+            }
+        }
+        if (rows.empty()) {
+            return;
+        }
+        std::sort(rows.begin(), rows.end(), std::greater<>());
+        rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+        for (const uint32_t idx : rows) {
+            const uint32_t removed = entities_[idx];
+            for (auto* listener : listeners_) {
+                listener->OnComponentRemoved(Entity(removed, 0));
+            }
+            const auto lastIdx = static_cast<uint32_t>(dense_.size() - 1);
+            if (idx != lastIdx) {
+                dense_[idx] = std::move(dense_[lastIdx]);
+                entities_[idx] = entities_[lastIdx];
+                versions_[idx] = versions_[lastIdx];
+                added_[idx] = added_[lastIdx];
+                sparse_.Update(entities_[idx], idx);
+            }
+            dense_.pop_back();
+            entities_.pop_back();
+            versions_.pop_back();
+            added_.pop_back();
+            sparse_.Reset(removed);
+        }
+
+        globalVersion_ = NextChangeVersion();
+    }
+
     /// Remove all components and reset version tracking.
     void Clear() override {
         dense_.clear();
         entities_.clear();
         versions_.clear();
-        std::fill(sparse_.begin(), sparse_.end(), kInvalidIndex);
-        ++globalVersion_;
+        added_.clear();
+        sparse_.Clear();
+        globalVersion_ = NextChangeVersion();
+        for (auto* listener : listeners_) {
+            listener->OnStorageCleared();
+        }
+        if (owner_ != nullptr) {
+            owner_->OnCleared();
+        }
     }
 
     // ── Iteration ───────────────────────────────────────────────────────
@@ -182,48 +396,623 @@ public:
     /// Return the storage's global modification version counter.
     [[nodiscard]] uint32_t Version() const noexcept override { return globalVersion_; }
 
+    // ── Dense ordering ──────────────────────────────────────────────────
+
+    /// Dense index of the component owned by @p entity.
+    /// @pre `Has(entity)`.
+    [[nodiscard]] uint32_t IndexOf(Entity entity) const {
+        assert(Has(entity) && "Entity does not have this component");
+        return sparse_.Get(entity.id());
+    }
+
+    /// Exchange the dense slots @p lhs and @p rhs.
+    ///
+    /// Membership and versions are unchanged, so the global version is not
+    /// bumped and Query caches (which hold entity ids) stay valid.
+    void SwapDense(uint32_t lhs, uint32_t rhs) {
+        assert(lhs < dense_.size() && rhs < dense_.size());
+        if (lhs == rhs) {
+            return;
+        }
+        using std::swap;
+        swap(dense_[lhs], dense_[rhs]);
+        std::swap(entities_[lhs], entities_[rhs]);
+        std::swap(versions_[lhs], versions_[rhs]);
+        std::swap(added_[lhs], added_[rhs]);
+        sparse_.Update(entities_[lhs], lhs);
+        sparse_.Update(entities_[rhs], rhs);
+    }
+
+    /// Reorder the dense arrays so that @p comp(lhs, rhs) holds for every
+    /// adjacent pair of components.
+    ///
+    /// Entity ids, versions and sparse entries move with their components
+    /// (see SwapDense()), so lookups and change detection are unaffected.
+    /// @pre The pool has no owner; a group decides the order of its pools.
+    template <typename Compare>
+    void SortBy(Compare comp) {
+        assert(owner_ == nullptr && "Owned pools are ordered by their group");
+        const auto count = static_cast<uint32_t>(dense_.size());
+        std::vector<uint32_t> order(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(),
+                  [&](uint32_t lhs, uint32_t rhs) { return comp(dense_[lhs], dense_[rhs]); });
+        applyOrder(order);
+    }
+
+    /// Reorder so that entities present in @p other come first, in
+    /// @p other's dense order; the remaining components follow.
+    /// @pre The pool has no owner.
+    void SortAs(const IComponentStorage& other) {
+        assert(owner_ == nullptr && "Owned pools are ordered by their group");
+        uint32_t next = 0;
+        for (std::size_t i = 0; i < other.Size(); ++i) {
+            const uint32_t id = other.EntityAt(i);
+            if (sparse_.Contains(id)) {
+                SwapDense(next++, sparse_.Get(id));
+            }
+        }
+    }
+
+    /// Install the structural observer of this pool (nullptr to release).
+    void SetOwner(IStorageOwner* owner) noexcept {
+        assert((owner == nullptr || owner_ == nullptr) && "Pool already has an owner");
+        owner_ = owner;
+    }
+
+    /// Current structural observer, or nullptr.
+    [[nodiscard]] IStorageOwner* Owner() const noexcept { return owner_; }
+
+    bool AddListener(IStorageListener* listener) const override {
+        listeners_.Add(listener);
+        return true;
+    }
+
+    void RemoveListener(IStorageListener* listener) const noexcept override {
+        listeners_.Remove(listener);
+    }
+
+    /// Number of subscribed listeners.
+    [[nodiscard]] std::size_t ListenerCount() const noexcept { return listeners_.Size(); }
+
     // ── Version / change detection ──────────────────────────────────────
 
     /// Explicitly mark the component for @p entity as changed.
     void MarkChanged(Entity entity) {
         assert(Has(entity) && "Entity does not have this component");
-        versions_[sparse_[entity.id()]] = ++globalVersion_;
+        globalVersion_ = NextChangeVersion();
+        versions_[sparse_.Get(entity.id())] = globalVersion_;
+    }
+
+    /// Mark the components at dense @p indices changed, all with one new
+    /// version: the bulk form of MarkChanged() for systems that walk the
+    /// dense array (e.g. through an OwningGroup).
+    void MarkChangedAt(std::span<const uint32_t> indices) {
+        if (indices.empty()) {
+            return;
+        }
+        globalVersion_ = NextChangeVersion();
+        for (const uint32_t idx : indices) {
+            assert(idx < versions_.size() && "Dense index out of range");
+            versions_[idx] = globalVersion_;
+        }
     }
 
     /// Return the version counter for the component owned by @p entity.
     [[nodiscard]] uint32_t GetVersion(Entity entity) const {
         assert(Has(entity) && "Entity does not have this component");
-        return versions_[sparse_[entity.id()]];
+        return versions_[sparse_.Get(entity.id())];
     }
 
     /// True when the component's version is newer than @p sinceVersion.
     [[nodiscard]] bool HasChanged(Entity entity, uint32_t sinceVersion) const {
         assert(Has(entity) && "Entity does not have this component");
-        return versions_[sparse_[entity.id()]] > sinceVersion;
+        return IsNewerVersion(versions_[sparse_.Get(entity.id())], sinceVersion);
+    }
+
+    /// Return the version at which @p entity's component was added.
+    [[nodiscard]] uint32_t GetAddedVersion(Entity entity) const {
+        assert(Has(entity) && "Entity does not have this component");
+        return added_[sparse_.Get(entity.id())];
+    }
+
+    /// True when the component was added after @p sinceVersion.
+    [[nodiscard]] bool WasAdded(Entity entity, uint32_t sinceVersion) const {
+        assert(Has(entity) && "Entity does not have this component");
+        return IsNewerVersion(added_[sparse_.Get(entity.id())], sinceVersion);
     }
 
     /// The current global version counter.
     [[nodiscard]] uint32_t GlobalVersion() const noexcept { return globalVersion_; }
 
+    // ── Dense images ────────────────────────────────────────────────────
+
+    /// Append an image of the pool to @p out: a header, the dense entity
+    /// ids and the raw component bytes, each written with one memcpy.
+    ///
+    /// Versions are not saved; they are stamps of this process's change
+    /// clock (see DeserializeDense()).
+    void SerializeDense(std::vector<uint8_t>& out) const
+        requires std::is_trivially_copyable_v<T>
+    {
+        out.reserve(out.size() + sizeof(detail::DenseImageHeader) +
+                    entities_.size() * (sizeof(uint32_t) + sizeof(T)));
+        detail::AppendImageValue(out, detail::DenseImageHeader{
+                                          detail::kDenseImageMagic,
+                                          static_cast<uint32_t>(sizeof(T)),
+                                          static_cast<uint32_t>(entities_.size()), 0});
+        detail::AppendImageBytes(out, std::span<const uint32_t>(entities_));
+        detail::AppendImageBytes(out, std::span<const T>(dense_));
+    }
+
+    /// Replace the pool's contents with an image from SerializeDense().
+    ///
+    /// Every restored component is stamped with one new version, so it
+    /// reads as added and changed for every system; listeners see
+    /// OnStorageCleared().  Dense order is preserved.
+    /// @return false, leaving the pool unchanged, when @p image is not a
+    ///         pool image of this component size or is truncated, or when
+    ///         it lists an entity id twice.
+    /// @pre The pool has no owner (groups are rebuilt from their pools).
+    [[nodiscard]] bool DeserializeDense(std::span<const uint8_t> image)
+        requires std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>
+    {
+        assert(owner_ == nullptr && "Owned pools are ordered by their group");
+        detail::ImageReader reader(image);
+        detail::DenseImageHeader header;
+        if (!reader.Read(header) || header.magic != detail::kDenseImageMagic ||
+            header.elementSize != sizeof(T) ||
+            reader.Remaining() !=
+                static_cast<std::size_t>(header.count) * (sizeof(uint32_t) + sizeof(T))) {
+            return false;
+        }
+
+        std::vector<uint32_t> entities(header.count);
+        std::vector<T> dense(header.count);
+        SparsePageTable sparse;
+        if (!reader.Read(std::span<uint32_t>(entities)) || !reader.Read(std::span<T>(dense))) {
+            return false;
+        }
+        for (uint32_t idx = 0; idx < header.count; ++idx) {
+            const uint32_t id = entities[idx];
+            if (id > Entity::kMaxId || sparse.Contains(id)) {
+                return false;
+            }
+            sparse.Set(id, idx);
+        }
+
+        dense_.assign(dense.begin(), dense.end());  // Keeps a reservation.
+        entities_ = std::move(entities);
+        sparse_ = std::move(sparse);
+        globalVersion_ = NextChangeVersion();
+        versions_.assign(header.count, globalVersion_);
+        added_.assign(header.count, globalVersion_);
+        for (auto* listener : listeners_) {
+            listener->OnStorageCleared();
+        }
+        return true;
+    }
+
+    // ── Memory accounting ───────────────────────────────────────────────
+
+    /// Approximate heap bytes held by the paged sparse table.
+    [[nodiscard]] std::size_t SparseMemoryUsage() const noexcept { return sparse_.MemoryUsage(); }
+
+    /// Move the component data into address space reserved for
+    /// @p maxComponents and backed by @p backing (2 MB pages by default),
+    /// so iteration takes fewer TLB misses and growth up to that count
+    /// commits pages in place instead of copying the dense array.
+    /// @return false when no address space could be reserved; the pool
+    ///         keeps its heap array and works as before.
+    /// @see DenseArray, VirtualRegion
+    bool ReserveAddressSpace(std::size_t maxComponents,
+                             PageBacking backing = PageBacking::Transparent) {
+        return dense_.ReserveAddressSpace(maxComponents, backing);
+    }
+
+    /// True while the component data lives in reserved address space.
+    [[nodiscard]] bool IsRegionBacked() const noexcept { return dense_.IsRegionBacked(); }
+
     // ── Type ID ─────────────────────────────────────────────────────────
 
     /// The compile-time-generated type ID for this component type.
     [[nodiscard]] static ComponentTypeId TypeId() noexcept { return ComponentType<T>::Id(); }
 
 private:
-    static constexpr uint32_t kInvalidIndex = std::numeric_limits<uint32_t>::max();
-
-    void ensureSparseSize(uint32_t entityId) {
-        if (entityId >= sparse_.size()) {
-            sparse_.resize(static_cast<std::size_t>(entityId) + 1, kInvalidIndex);
+    /// Permute the dense arrays so that slot i receives old slot
+    /// @p order[i], following each cycle with SwapDense().
+    void applyOrder(std::vector<uint32_t>& order) {
+        for (uint32_t start = 0; start < order.size(); ++start) {
+            uint32_t slot = start;
+            while (order[slot] != start) {
+                const uint32_t source = order[slot];
+                SwapDense(slot, source);
+                order[slot] = slot;
+                slot = source;
+            }
+            order[slot] = slot;
         }
     }
 
-    std::vector<T> dense_;            ///< Packed component data.
+    DenseArray<T> dense_;             ///< Packed component data.
     std::vector<uint32_t> entities_;  ///< dense index -> entity id.
-    std::vector<uint32_t> sparse_;    ///< entity id  -> dense index.
+    SparsePageTable sparse_;          ///< entity id  -> dense index.
     std::vector<uint32_t> versions_;  ///< dense index -> change version.
-    uint32_t globalVersion_ = 0;      ///< Monotonically increasing version.
+    std::vector<uint32_t> added_;     ///< dense index -> add version.
+    uint32_t globalVersion_ = 0;      ///< Last version drawn by this storage.
+    IStorageOwner* owner_ = nullptr;  ///< Group keeping this pool ordered.
+
+    /// Membership observers (Query caches); not part of the pool's state.
+    mutable StorageListeners listeners_;
+};
+
+/// Membership-only storage for tag components (empty types).
+///
+/// Memory layout:
+/// @code
+///   members_ [entity.id] -> 1 bit        (paged)
+///   sparse_  [entity.id] -> dense index  (paged, only read on removal)
+///   entities_[index]     -> entity.id
+/// @endcode
+///
+/// Has() is a single bit test, so include and Exclude checks on tags stay
+/// in cache over large populations.  There is no component data to
+/// version: the global version still advances on every structural change
+/// (Query relies on it), but tags have no per-component versions, so
+/// Changed<T>/Added<T> filters do not apply.
+///
+/// Get() and iteration hand out references to one shared, stateless @p T.
+template <typename T>
+    requires std::is_empty_v<T>
+class ComponentStorage<T> final : public IComponentStorage {
+    template <bool kConst>
+    class TagIterator;
+
+public:
+    static_assert(std::is_default_constructible_v<T>, "Tag type must be default-constructible");
+
+    using value_type = T;
+    using iterator = TagIterator<false>;
+    using const_iterator = TagIterator<true>;
+
+    // ── Capacity ────────────────────────────────────────────────────────
+
+    /// Number of tagged entities.
+    [[nodiscard]] std::size_t Size() const override { return entities_.size(); }
+
+    /// True when no entity is tagged.
+    [[nodiscard]] bool Empty() const noexcept { return entities_.empty(); }
+
+    // ── CRUD ────────────────────────────────────────────────────────────
+
+    /// Tag @p entity.  @p args are accepted for parity with the general
+    /// storage and discarded.
+    /// @pre `!Has(entity)`.
+    template <typename... Args>
+    T& Add(Entity entity, Args&&... /*args*/) {
+        assert(entity.isValid() && "Cannot add component to invalid entity");
+        assert(!Has(entity) && "Entity already has this component");
+
+        sparse_.Set(entity.id(), static_cast<uint32_t>(entities_.size()));
+        members_.Set(entity.id());
+        entities_.push_back(entity.id());
+        globalVersion_ = NextChangeVersion();
+
+        for (auto* listener : listeners_) {
+            listener->OnComponentAdded(entity);
+        }
+        if (owner_ != nullptr) {
+            owner_->OnAdded(entity);
+        }
+        return tag_;
+    }
+
+    /// The shared tag instance.
+    /// @pre `Has(entity)`.
+    [[nodiscard]] T& Get(Entity entity) {
+        assert(Has(entity) && "Entity does not have this component");
+        static_cast<void>(entity);
+        return tag_;
+    }
+
+    [[nodiscard]] const T& Get(Entity entity) const {
+        assert(Has(entity) && "Entity does not have this component");
+        static_cast<void>(entity);
+        return tag_;
+    }
+
+    /// No-op: a tag carries no value to replace.
+    void Replace(Entity entity, T&& /*component*/) {
+        assert(Has(entity) && "Entity does not have this component");
+        static_cast<void>(entity);
+    }
+
+    /// Check whether @p entity is tagged (one bit test).
+    [[nodiscard]] bool Has(Entity entity) const override { return members_.Test(entity.id()); }
+
+    /// No-op: Has() is one bit test and Get() returns the shared tag.
+    void PrefetchIndex(Entity entity) const noexcept { static_cast<void>(entity); }
+
+    /// No-op, see PrefetchIndex().
+    void PrefetchComponent(Entity entity) const noexcept { static_cast<void>(entity); }
+
+    /// Untag @p entity.  Safe to call even if it is not tagged.
+    void Remove(Entity entity) override {
+        if (!Has(entity)) {
+            return;
+        }
+        if (owner_ != nullptr) {
+            owner_->OnRemoving(entity);
+        }
+        for (auto* listener : listeners_) {
+            listener->OnComponentRemoved(entity);
+        }
+        eraseRow(sparse_.Get(entity.id()));
+        globalVersion_ = NextChangeVersion();
+    }
+
+    /// Return the existing tag or add one.
+    T& GetOrAdd(Entity entity) {
+        if (Has(entity)) {
+            return tag_;
+        }
+        return Add(entity);
+    }
+
+    /// Untag every entity in @p entities, bumping the version once.
+    void RemoveMany(std::span<const Entity> entities) override {
+        if (owner_ != nullptr) {
+            IComponentStorage::RemoveMany(entities);
+            return;
+        }
+        bool removed = false;
+        for (const Entity entity : entities) {
+            if (!Has(entity)) {
+                continue;
+            }
+            for (auto* listener : listeners_) {
+                listener->OnComponentRemoved(Entity(entity.id(), 0));
+            }
+            eraseRow(sparse_.Get(entity.id()));
+            removed = true;
+        }
+        if (removed) {
+            globalVersion_ = NextChangeVersion();
+        }
+    }
+
+    /// Untag every entity.
+    void Clear() override {
+        entities_.clear();
+        sparse_.Clear();
+        members_.Clear();
+        globalVersion_ = NextChangeVersion();
+        for (auto* listener : listeners_) {
+            listener->OnStorageCleared();
+        }
+        if (owner_ != nullptr) {
+            owner_->OnCleared();
+        }
+    }
+
+    // ── Iteration ───────────────────────────────────────────────────────
+
+    iterator begin() noexcept { return iterator(&tag_, 0); }
+    iterator end() noexcept { return iterator(&tag_, static_cast<std::ptrdiff_t>(Size())); }
+    [[nodiscard]] const_iterator begin() const noexcept { return const_iterator(&tag_, 0); }
+    [[nodiscard]] const_iterator end() const noexcept {
+        return const_iterator(&tag_, static_cast<std::ptrdiff_t>(Size()));
+    }
+    [[nodiscard]] const_iterator cbegin() const noexcept { return begin(); }
+    [[nodiscard]] const_iterator cend() const noexcept { return end(); }
+
+    /// Return the entity id at dense @p index.
+    [[nodiscard]] uint32_t EntityAt(std::size_t index) const override {
+        assert(index < entities_.size());
+        return entities_[index];
+    }
+
+    /// Return the storage's global modification version counter.
+    [[nodiscard]] uint32_t Version() const noexcept override { return globalVersion_; }
+
+    /// The current global version counter.
+    [[nodiscard]] uint32_t GlobalVersion() const noexcept { return globalVersion_; }
+
+    // ── Dense ordering ──────────────────────────────────────────────────
+
+    /// Dense index of @p entity.
+    /// @pre `Has(entity)`.
+    [[nodiscard]] uint32_t IndexOf(Entity entity) const {
+        assert(Has(entity) && "Entity does not have this component");
+        return sparse_.Get(entity.id());
+    }
+
+    /// Exchange the dense slots @p lhs and @p rhs.
+    void SwapDense(uint32_t lhs, uint32_t rhs) {
+        assert(lhs < entities_.size() && rhs < entities_.size());
+        if (lhs == rhs) {
+            return;
+        }
+        std::swap(entities_[lhs], entities_[rhs]);
+        sparse_.Update(entities_[lhs], lhs);
+        sparse_.Update(entities_[rhs], rhs);
+    }
+
+    /// Reorder so that entities present in @p other come first, in
+    /// @p other's dense order.
+    /// @pre The pool has no owner.
+    void SortAs(const IComponentStorage& other) {
+        assert(owner_ == nullptr && "Owned pools are ordered by their group");
+        uint32_t next = 0;
+        for (std::size_t i = 0; i < other.Size(); ++i) {
+            const uint32_t id = other.EntityAt(i);
+            if (members_.Test(id)) {
+                SwapDense(next++, sparse_.Get(id));
+            }
+        }
+    }
+
+    /// Install the structural observer of this pool (nullptr to release).
+    void SetOwner(IStorageOwner* owner) noexcept {
+        assert((owner == nullptr || owner_ == nullptr) && "Pool already has an owner");
+        owner_ = owner;
+    }
+
+    /// Current structural observer, or nullptr.
+    [[nodiscard]] IStorageOwner* Owner() const noexcept { return owner_; }
+
+    bool AddListener(IStorageListener* listener) const override {
+        listeners_.Add(listener);
+        return true;
+    }
+
+    void RemoveListener(IStorageListener* listener) const noexcept override {
+        listeners_.Remove(listener);
+    }
+
+    /// Number of subscribed listeners.
+    [[nodiscard]] std::size_t ListenerCount() const noexcept { return listeners_.Size(); }
+
+    // ── Dense images ────────────────────────────────────────────────────
+
+    /// Append an image of the tagged ids to @p out (no component bytes).
+    void SerializeDense(std::vector<uint8_t>& out) const {
+        detail::AppendImageValue(
+            out, detail::DenseImageHeader{detail::kDenseImageMagic, 0,
+                                          static_cast<uint32_t>(entities_.size()), 0});
+        detail::AppendImageBytes(out, std::span<const uint32_t>(entities_));
+    }
+
+    /// Replace the tagged set with an image from SerializeDense().
+    /// @return false, leaving the pool unchanged, on a malformed image.
+    /// @pre The pool has no owner.
+    [[nodiscard]] bool DeserializeDense(std::span<const uint8_t> image) {
+        assert(owner_ == nullptr && "Owned pools are ordered by their group");
+        detail::ImageReader reader(image);
+        detail::DenseImageHeader header;
+        if (!reader.Read(header) || header.magic != detail::kDenseImageMagic ||
+            header.elementSize != 0 ||
+            reader.Remaining() != static_cast<std::size_t>(header.count) * sizeof(uint32_t)) {
+            return false;
+        }
+
+        std::vector<uint32_t> entities(header.count);
+        PagedBitset members;
+        SparsePageTable sparse;
+        if (!reader.Read(std::span<uint32_t>(entities))) {
+            return false;
+        }
+        for (uint32_t idx = 0; idx < header.count; ++idx) {
+            const uint32_t id = entities[idx];
+            if (id > Entity::kMaxId || members.Test(id)) {
+                return false;
+            }
+            members.Set(id);
+            sparse.Set(id, idx);
+        }
+
+        entities_ = std::move(entities);
+        members_ = std::move(members);
+        sparse_ = std::move(sparse);
+        globalVersion_ = NextChangeVersion();
+        for (auto* listener : listeners_) {
+            listener->OnStorageCleared();
+        }
+        return true;
+    }
+
+    // ── Memory accounting ───────────────────────────────────────────────
+
+    /// Approximate heap bytes held by the paged sparse table.
+    [[nodiscard]] std::size_t SparseMemoryUsage() const noexcept { return sparse_.MemoryUsage(); }
+
+    /// Approximate heap bytes held by the membership bitset.
+    [[nodiscard]] std::size_t MembershipMemoryUsage() const noexcept {
+        return members_.MemoryUsage();
+    }
+
+    // ── Type ID ─────────────────────────────────────────────────────────
+
+    [[nodiscard]] static ComponentTypeId TypeId() noexcept { return ComponentType<T>::Id(); }
+
+private:
+    /// Random-access iterator yielding the shared tag Size() times.
+    template <bool kConst>
+    class TagIterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<kConst, const T*, T*>;
+        using reference = std::conditional_t<kConst, const T&, T&>;
+
+        TagIterator() = default;
+        TagIterator(pointer tag, difference_type index) : tag_(tag), index_(index) {}
+
+        reference operator*() const noexcept { return *tag_; }
+        pointer operator->() const noexcept { return tag_; }
+        reference operator[](difference_type /*offset*/) const noexcept { return *tag_; }
+
+        TagIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+        TagIterator operator++(int) noexcept { return TagIterator(tag_, index_++); }
+        TagIterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+        TagIterator operator--(int) noexcept { return TagIterator(tag_, index_--); }
+        TagIterator& operator+=(difference_type n) noexcept {
+            index_ += n;
+            return *this;
+        }
+        TagIterator& operator-=(difference_type n) noexcept {
+            index_ -= n;
+            return *this;
+        }
+        friend TagIterator operator+(TagIterator it, difference_type n) noexcept { return it += n; }
+        friend TagIterator operator+(difference_type n, TagIterator it) noexcept { return it += n; }
+        friend TagIterator operator-(TagIterator it, difference_type n) noexcept { return it -= n; }
+        friend difference_type operator-(const TagIterator& lhs, const TagIterator& rhs) noexcept {
+            return lhs.index_ - rhs.index_;
+        }
+        friend bool operator==(const TagIterator& lhs, const TagIterator& rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+        friend auto operator<=>(const TagIterator& lhs, const TagIterator& rhs) noexcept {
+            return lhs.index_ <=> rhs.index_;
+        }
+
+    private:
+        pointer tag_ = nullptr;
+        difference_type index_ = 0;
+    };
+
+    /// Swap-and-pop dense row @p idx and forget its entity.
+    void eraseRow(uint32_t idx) {
+        const uint32_t removed = entities_[idx];
+        const auto lastIdx = static_cast<uint32_t>(entities_.size() - 1);
+        if (idx != lastIdx) {
+            entities_[idx] = entities_[lastIdx];
+            sparse_.Update(entities_[idx], idx);
+        }
+        entities_.pop_back();
+        sparse_.Reset(removed);
+        members_.Reset(removed);
+    }
+
+    std::vector<uint32_t> entities_;  ///< dense index -> entity id.
+    SparsePageTable sparse_;          ///< entity id  -> dense index.
+    PagedBitset members_;             ///< entity id  -> tagged bit.
+    uint32_t globalVersion_ = 0;      ///< Last version drawn by this storage.
+    IStorageOwner* owner_ = nullptr;  ///< Group keeping this pool ordered.
+    [[no_unique_address]] T tag_{};   ///< Shared stateless instance.
+
+    /// Membership observers (Query caches); not part of the pool's state.
+    mutable StorageListeners listeners_;
 };
 
 }  // namespace cgs::ecs
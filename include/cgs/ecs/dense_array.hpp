@@ -0,0 +1,246 @@
+#pragma once
+
+/// @file dense_array.hpp
+/// @brief Growable contiguous array that can move into a reserved,
+///        huge-page backed address range and then grow in place.
+///
+/// DenseArray<T> is ComponentStorage's dense component array.  By default
+/// it behaves like std::vector: a heap block that doubles, moving every
+/// element on each growth.  After ReserveAddressSpace() the elements live
+/// in a VirtualRegion sized for the largest expected population; growth
+/// then commits further pages behind the last element, so elements never
+/// move again and a pool of millions of components is never copied
+/// wholesale mid-tick.  Outgrowing the reservation falls back to heap
+/// doubling rather than failing.
+///
+/// The interface is the subset of std::vector that the storages use;
+/// iterators are raw pointers.
+///
+/// @see docs/advanced/ECS_DEEP_DIVE.md  Section 6.26
+
+#include "cgs/ecs/virtual_region.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace cgs::ecs {
+
+/// Contiguous sequence of @p T, heap- or region-backed.  Not thread-safe.
+template <typename T>
+class DenseArray {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    DenseArray() noexcept = default;
+
+    DenseArray(const DenseArray& other) { assign(other.begin(), other.end()); }
+
+    /// Steals the block or the region; @p other is left empty.
+    DenseArray(DenseArray&& other) noexcept { takeFrom(other); }
+
+    ~DenseArray() {
+        clear();
+        releaseStorage();
+    }
+
+    DenseArray& operator=(const DenseArray& other) {
+        if (this != &other) {
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    DenseArray& operator=(DenseArray&& other) noexcept {
+        if (this != &other) {
+            clear();
+            releaseStorage();
+            takeFrom(other);
+        }
+        return *this;
+    }
+
+    /// Replace the contents with [first, last).  Keeps a reservation.
+    template <std::forward_iterator It>
+    void assign(It first, It last) {
+        clear();
+        reserve(static_cast<size_type>(std::distance(first, last)));
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+
+    // ── Element access ──────────────────────────────────────────────────
+
+    [[nodiscard]] T& operator[](size_type index) noexcept { return data_[index]; }
+    [[nodiscard]] const T& operator[](size_type index) const noexcept { return data_[index]; }
+
+    [[nodiscard]] T& back() noexcept { return data_[size_ - 1]; }
+    [[nodiscard]] const T& back() const noexcept { return data_[size_ - 1]; }
+
+    [[nodiscard]] T* data() noexcept { return data_; }
+    [[nodiscard]] const T* data() const noexcept { return data_; }
+
+    // ── Iterators ───────────────────────────────────────────────────────
+
+    [[nodiscard]] iterator begin() noexcept { return data_; }
+    [[nodiscard]] const_iterator begin() const noexcept { return data_; }
+    [[nodiscard]] const_iterator cbegin() const noexcept { return data_; }
+
+    [[nodiscard]] iterator end() noexcept { return data_ + size_; }
+    [[nodiscard]] const_iterator end() const noexcept { return data_ + size_; }
+    [[nodiscard]] const_iterator cend() const noexcept { return data_ + size_; }
+
+    // ── Capacity ────────────────────────────────────────────────────────
+
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+    [[nodiscard]] size_type size() const noexcept { return size_; }
+    [[nodiscard]] size_type capacity() const noexcept { return capacity_; }
+
+    /// Ensure room for @p count elements.  Region-backed arrays commit
+    /// in place; heap-backed ones reallocate.
+    void reserve(size_type count) {
+        if (count > capacity_ && !commitInPlace(count)) {
+            reallocate(count);
+        }
+    }
+
+    /// Move the elements into a fresh address range reserved for
+    /// @p maxElements, backed as @p backing.  From then on growth up to
+    /// @p maxElements never moves an element.
+    /// @return false, leaving the array as it was, when @p maxElements is
+    ///         below size() or no address range could be reserved.
+    bool ReserveAddressSpace(size_type maxElements, PageBacking backing) {
+        if (maxElements == 0 || maxElements < size_ ||
+            maxElements > std::numeric_limits<size_type>::max() / sizeof(T)) {
+            return false;
+        }
+        VirtualRegion region;
+        if (!region.Reserve(maxElements * sizeof(T), backing) ||
+            !region.Commit(std::max<size_type>(size_, 1) * sizeof(T))) {
+            return false;
+        }
+        T* block = reinterpret_cast<T*>(region.Data());
+        std::uninitialized_move(begin(), end(), block);
+        std::destroy(begin(), end());
+        releaseStorage();
+        region_ = std::move(region);
+        data_ = block;
+        capacity_ = region_.Committed() / sizeof(T);
+        return true;
+    }
+
+    /// True while the elements live in a reserved address range.
+    [[nodiscard]] bool IsRegionBacked() const noexcept { return region_.IsReserved(); }
+
+    /// The reservation (empty while heap-backed).
+    [[nodiscard]] const VirtualRegion& Region() const noexcept { return region_; }
+
+    // ── Modifiers ───────────────────────────────────────────────────────
+
+    /// Destroy every element; the capacity is kept.
+    void clear() noexcept {
+        std::destroy(begin(), end());
+        size_ = 0;
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (size_ == capacity_) {
+            return growAndEmplace(std::forward<Args>(args)...);
+        }
+        T* slot = std::construct_at(data_ + size_, std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    void pop_back() noexcept {
+        --size_;
+        std::destroy_at(data_ + size_);
+    }
+
+private:
+    void takeFrom(DenseArray& other) noexcept {
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        capacity_ = std::exchange(other.capacity_, 0);
+        region_ = std::move(other.region_);
+    }
+
+    void releaseStorage() noexcept {
+        if (region_.IsReserved()) {
+            region_.Release();
+        } else if (data_ != nullptr) {
+            std::allocator<T>{}.deallocate(data_, capacity_);
+        }
+        data_ = nullptr;
+        capacity_ = 0;
+    }
+
+    /// Commit region pages for @p count elements; false when heap-backed
+    /// or the reservation is exhausted.
+    bool commitInPlace(size_type count) {
+        if (!region_.IsReserved() || count > region_.Reserved() / sizeof(T) ||
+            !region_.Commit(count * sizeof(T))) {
+            return false;
+        }
+        capacity_ = region_.Committed() / sizeof(T);
+        return true;
+    }
+
+    /// Move to a heap block of @p newCapacity, leaving any region.
+    void reallocate(size_type newCapacity) {
+        T* block = std::allocator<T>{}.allocate(newCapacity);
+        std::uninitialized_move(begin(), end(), block);
+        replaceStorage(block, newCapacity);
+    }
+
+    template <typename... Args>
+    T& growAndEmplace(Args&&... args) {
+        // Region pages after the last element: nothing moves, so @p args
+        // may safely refer to an element.
+        if (commitInPlace(size_ + 1)) {
+            T* slot = std::construct_at(data_ + size_, std::forward<Args>(args)...);
+            ++size_;
+            return *slot;
+        }
+        const size_type newCapacity = std::max<size_type>(capacity_ * 2, 4);
+        T* block = std::allocator<T>{}.allocate(newCapacity);
+        // Construct first: @p args may refer to an element being moved.
+        T* slot = std::construct_at(block + size_, std::forward<Args>(args)...);
+        std::uninitialized_move(begin(), end(), block);
+        replaceStorage(block, newCapacity);
+        ++size_;
+        return *slot;
+    }
+
+    /// Destroy the current elements and adopt @p block (already filled).
+    void replaceStorage(T* block, size_type newCapacity) noexcept {
+        std::destroy(begin(), end());
+        releaseStorage();
+        data_ = block;
+        capacity_ = newCapacity;
+    }
+
+    T* data_ = nullptr;
+    size_type size_ = 0;
+    size_type capacity_ = 0;
+    VirtualRegion region_;
+};
+
+}  // namespace cgs::ecs
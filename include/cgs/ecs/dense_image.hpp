@@ -0,0 +1,86 @@
+#pragma once
+
+/// @file dense_image.hpp
+/// @brief Byte-image helpers for ECS checkpoints.
+///
+/// ComponentStorage::SerializeDense() and EntityManager::SerializeImage()
+/// write their arrays as a small header followed by raw element bytes, so
+/// a pool of trivially copyable components is saved and restored with one
+/// memcpy per array.  Images use native byte order and layout: they are
+/// meant for crash recovery and instance migration between builds of the
+/// same binary, not as a portable save format.
+///
+/// @see docs/advanced/ECS_DEEP_DIVE.md  Section 6.18
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace cgs::ecs::detail {
+
+/// Leading words of every image, checked before anything is restored.
+struct DenseImageHeader {
+    uint32_t magic = 0;        ///< Kind of image (see kDenseImageMagic).
+    uint32_t elementSize = 0;  ///< sizeof the stored element type.
+    uint32_t count = 0;        ///< Number of rows / slots.
+    uint32_t extra = 0;        ///< Kind-specific (e.g. free-list length).
+};
+
+inline constexpr uint32_t kDenseImageMagic = 0x43475344;   ///< "CGSD": component pool.
+inline constexpr uint32_t kEntityImageMagic = 0x43475345;  ///< "CGSE": entity manager.
+
+/// Append the bytes of @p values to @p out.
+template <typename T>
+void AppendImageBytes(std::vector<uint8_t>& out, std::span<const T> values) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    if (values.empty()) {
+        return;
+    }
+    const std::size_t offset = out.size();
+    out.resize(offset + values.size_bytes());
+    std::memcpy(out.data() + offset, values.data(), values.size_bytes());
+}
+
+/// Append one trivially copyable value to @p out.
+template <typename T>
+void AppendImageValue(std::vector<uint8_t>& out, const T& value) {
+    AppendImageBytes(out, std::span<const T>(&value, 1));
+}
+
+/// Bounds-checked cursor over an image.
+class ImageReader {
+public:
+    explicit ImageReader(std::span<const uint8_t> image) noexcept : image_(image) {}
+
+    /// Copy the next @p values.size() elements; false if the image is short.
+    template <typename T>
+    [[nodiscard]] bool Read(std::span<T> values) noexcept {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (image_.size() - offset_ < values.size_bytes()) {
+            return false;
+        }
+        if (!values.empty()) {
+            std::memcpy(values.data(), image_.data() + offset_, values.size_bytes());
+        }
+        offset_ += values.size_bytes();
+        return true;
+    }
+
+    /// Read one value; false if the image is short.
+    template <typename T>
+    [[nodiscard]] bool Read(T& value) noexcept {
+        return Read(std::span<T>(&value, 1));
+    }
+
+    /// Bytes not consumed yet.
+    [[nodiscard]] std::size_t Remaining() const noexcept { return image_.size() - offset_; }
+
+private:
+    std::span<const uint8_t> image_;
+    std::size_t offset_ = 0;
+};
+
+}  // namespace cgs::ecs::detail
@@ -3,46 +3,73 @@
 /// @file entity.hpp
 /// @brief Entity type for the ECS layer.
 ///
-/// An entity is a lightweight 32-bit handle that combines a unique index
-/// (24 bits, supporting up to ~16 million entities) with a version counter
-/// (8 bits) for safe recycling.  The compact representation fits in a
-/// single register and keeps sparse-set indexing cache-friendly.
+/// An entity is a lightweight handle that combines a unique index with a
+/// version counter for safe recycling.  Two layouts are available at
+/// compile time:
+///
+/// - compact (default): 32 bits, 24-bit index (~16 million slots per
+///   world) + 8-bit version (wraps after 256 recycles of a slot).
+/// - wide (`-DCGS_WIDE_ENTITY=ON`): 64 bits, 32-bit index (~4 billion
+///   slots) + 32-bit version, for processes that consolidate many
+///   instances into one world or recycle hot spawn points fast enough
+///   for 8-bit versions to wrap while stale handles are still held.
+///
+/// Either way the index is a uint32_t, so sparse sets and dense id arrays
+/// keep the same element type; only handles and EntityManager's version
+/// table grow.  Images and handles are not portable between the layouts.
 
 #include <cstdint>
 #include <functional>
 #include <limits>
 
+#ifndef CGS_WIDE_ENTITY
+#define CGS_WIDE_ENTITY 0
+#endif
+
 namespace cgs::ecs {
 
-/// Compact entity handle: 24-bit index + 8-bit version packed into 32 bits.
+/// Entity handle: index + version packed into one integer.
 ///
 /// The version field prevents the ABA problem when entity IDs are recycled.
 /// EntityManager (Issue #10) will manage creation / destruction; this header
 /// only defines the value type so that ComponentStorage can use it.
 struct Entity {
-    uint32_t raw = kInvalidRaw;
-
-    // Bit layout constants.
+#if CGS_WIDE_ENTITY
+    using Raw = uint64_t;
+    using Version = uint32_t;
+    static constexpr uint32_t kIdBits = 32;
+    static constexpr uint32_t kVersionBits = 32;
+#else
+    using Raw = uint32_t;
+    using Version = uint8_t;
     static constexpr uint32_t kIdBits = 24;
     static constexpr uint32_t kVersionBits = 8;
-    static constexpr uint32_t kIdMask = (1u << kIdBits) - 1;  // 0x00FFFFFF
+#endif
+
+    // Bit layout constants.
+    static constexpr Raw kIdMask = (Raw{1} << kIdBits) - 1;  // 0x00FFFFFF (compact)
     static constexpr uint32_t kVersionShift = kIdBits;
-    static constexpr uint32_t kInvalidRaw = std::numeric_limits<uint32_t>::max();
-    static constexpr uint32_t kMaxId = kIdMask - 1;  // 0x00FFFFFE (reserve 0x00FFFFFF for invalid)
+    static constexpr Raw kInvalidRaw = std::numeric_limits<Raw>::max();
+    /// Highest usable index (kIdMask is reserved for the invalid sentinel).
+    static constexpr uint32_t kMaxId = static_cast<uint32_t>(kIdMask - 1);
+
+    Raw raw = kInvalidRaw;
 
     /// Default-construct to the invalid sentinel.
     constexpr Entity() = default;
 
     /// Construct from an index and a version.
-    constexpr Entity(uint32_t id, uint8_t version)
-        : raw((static_cast<uint32_t>(version) << kVersionShift) | (id & kIdMask)) {}
+    constexpr Entity(uint32_t id, Version version)
+        : raw((static_cast<Raw>(version) << kVersionShift) | (id & kIdMask)) {}
 
-    /// Extract the index portion (0 .. 16'777'214).
-    [[nodiscard]] constexpr uint32_t id() const noexcept { return raw & kIdMask; }
+    /// Extract the index portion (0 .. kMaxId).
+    [[nodiscard]] constexpr uint32_t id() const noexcept {
+        return static_cast<uint32_t>(raw & kIdMask);
+    }
 
-    /// Extract the version portion (0 .. 255).
-    [[nodiscard]] constexpr uint8_t version() const noexcept {
-        return static_cast<uint8_t>(raw >> kVersionShift);
+    /// Extract the version portion.
+    [[nodiscard]] constexpr Version version() const noexcept {
+        return static_cast<Version>(raw >> kVersionShift);
     }
 
     /// True when this handle refers to a potentially live entity.
@@ -54,7 +81,8 @@ struct Entity {
     constexpr auto operator<=>(const Entity&) const = default;
 };
 
-static_assert(sizeof(Entity) == 4, "Entity must be exactly 32 bits");
+static_assert(sizeof(Entity) == sizeof(Entity::Raw), "Entity must be exactly one Raw word");
+static_assert(Entity::kIdBits + Entity::kVersionBits == 8 * sizeof(Entity::Raw));
 
 }  // namespace cgs::ecs
 
@@ -62,6 +90,6 @@ static_assert(sizeof(Entity) == 4, "Entity must be exactly 32 bits");
 template <>
 struct std::hash<cgs::ecs::Entity> {
     std::size_t operator()(const cgs::ecs::Entity& e) const noexcept {
-        return std::hash<uint32_t>{}(e.raw);
+        return std::hash<cgs::ecs::Entity::Raw>{}(e.raw);
     }
 };
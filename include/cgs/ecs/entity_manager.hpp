@@ -17,16 +17,18 @@
 #include <cassert>
 #include <cstdint>
 #include <memory>
+#include <span>
 #include <vector>
 
 namespace cgs::ecs {
 
 /// Manages the full lifecycle of entities.
 ///
-/// Entities are identified by a compact 32-bit handle (24-bit index +
-/// 8-bit version).  When an entity is destroyed its index is pushed
-/// onto a free list for recycling; the version counter is incremented
-/// to invalidate any stale handles that still refer to the old entity.
+/// Entities are identified by an Entity handle (24-bit index + 8-bit
+/// version, or 32 + 32 bits with CGS_WIDE_ENTITY).  When an entity is
+/// destroyed its index is pushed onto a free list for recycling; the
+/// version counter is incremented to invalidate any stale handles that
+/// still refer to the old entity.
 ///
 /// Component storages may be registered with the manager so that
 /// `Destroy()` and `FlushDeferred()` automatically remove all
@@ -52,6 +54,12 @@ public:
     /// @return A valid Entity handle.
     [[nodiscard]] Entity Create();
 
+    /// Create @p count entities and append their handles to @p out.
+    ///
+    /// Recycled indices are taken from the free list in one block (oldest
+    /// first) before fresh indices are allocated; @p out is reserved once.
+    void CreateMany(std::size_t count, std::vector<Entity>& out);
+
     /// Immediately destroy @p entity and remove all its components.
     ///
     /// The entity's index is recycled (version incremented) and pushed
@@ -61,6 +69,14 @@ public:
     /// @pre `IsAlive(entity)` — destroying a dead entity is a no-op.
     void Destroy(Entity entity);
 
+    /// Destroy every alive entity in @p entities and remove their
+    /// components.
+    ///
+    /// Each registered storage receives one `RemoveMany()` call for the
+    /// whole batch instead of one `Remove()` per entity.  Dead and
+    /// duplicate handles are skipped.
+    void DestroyMany(std::span<const Entity> entities);
+
     /// Queue @p entity for destruction at the next `FlushDeferred()`.
     ///
     /// This is useful when destroying entities during system iteration
@@ -86,6 +102,10 @@ public:
     /// stored version.
     [[nodiscard]] bool IsAlive(Entity entity) const noexcept;
 
+    /// Live handle of the entity at index @p id (e.g. from
+    /// IComponentStorage::EntityAt()), or Entity::invalid() if none.
+    [[nodiscard]] Entity Resolve(uint32_t id) const noexcept;
+
     /// Return the number of currently alive entities.
     [[nodiscard]] std::size_t Count() const noexcept;
 
@@ -93,6 +113,27 @@ public:
     /// (including destroyed ones sitting on the free list).
     [[nodiscard]] std::size_t Capacity() const noexcept;
 
+    // ── Images ───────────────────────────────────────────────────────
+
+    /// Append an image of the entity table to @p out: versions, alive
+    /// bits and the free list, each written with one memcpy.  The header
+    /// records sizeof(Entity::Version), so a compact build rejects a wide
+    /// image and vice versa.
+    ///
+    /// Together with ComponentStorage::SerializeDense() of every pool this
+    /// checkpoints a whole world.  Pending deferred destructions are not
+    /// part of the image.
+    void SerializeImage(std::vector<uint8_t>& out) const;
+
+    /// Replace the entity table with an image from SerializeImage().
+    ///
+    /// Registered storages are not touched; restore them from their own
+    /// images.  Pending deferred destructions are dropped.
+    /// @return false, leaving the manager unchanged, when @p image is not
+    ///         an entity image, is truncated, or has an inconsistent free
+    ///         list.
+    [[nodiscard]] bool DeserializeImage(std::span<const uint8_t> image);
+
     // ── Component storage registration ───────────────────────────────
 
     /// Register a component storage so that entity destruction
@@ -110,7 +151,7 @@ private:
     /// current version for that slot.  An entity handle is alive iff
     /// `entity.version() == versions_[entity.id()]` and the slot is
     /// not on the free list.
-    std::vector<uint8_t> versions_;
+    std::vector<Entity::Version> versions_;
 
     /// Alive flag per index.  True when the slot holds a live entity.
     /// This disambiguates a freshly-allocated slot (version 0, alive)
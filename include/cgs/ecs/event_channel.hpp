@@ -0,0 +1,172 @@
+#pragma once
+
+/// @file event_channel.hpp
+/// @brief Double-buffered, typed per-tick event channels.
+///
+/// Modelling one-shot events (damage, quest progress, durability loss) as
+/// components churns their sparse sets, invalidates query caches every
+/// tick and limits each entity to one pending event of a type.  An
+/// EventChannel<E> instead collects events in per-thread append buffers
+/// and publishes them as one contiguous batch:
+///
+/// @code
+///   EventChannel<DamageEvent> damage;
+///   scheduler.AddEventChannel(damage);
+///
+///   // Producer system (any thread, any number of events per entity):
+///   damage.Send({attacker, victim, DamageType::Fire, 40});
+///
+///   // Consumer system in a later stage (or the next tick):
+///   for (const DamageEvent& event : damage.Read()) { ... }
+/// @endcode
+///
+/// Systems declare their use with EventRead<E>/EventWrite<E> in
+/// GetAccessInfo().  The scheduler calls Swap() at the boundary before
+/// every stage that reads the channel, so readers see the events sent
+/// since the previous swap and writers fill the other side: neither
+/// conflicts with anything and both run in parallel freely.
+///
+/// @see docs/advanced/ECS_DEEP_DIVE.md  Section 6.17
+
+#include "cgs/ecs/component_type_id.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace cgs::ecs {
+
+namespace detail {
+
+/// One thread's pending events for one channel.
+class EventBuffer {
+public:
+    virtual ~EventBuffer() = default;
+};
+
+}  // namespace detail
+
+/// Type-erased base of EventChannel<E>, as registered with the scheduler.
+///
+/// Owns the per-thread buffer registry.  A thread finds its buffer
+/// through a small thread-local cache keyed by the channel's instance id,
+/// so after its first event a producer takes no lock.
+class IEventChannel {
+public:
+    IEventChannel();
+    virtual ~IEventChannel();
+
+    // Non-copyable, non-movable (threads cache pointers to their buffers).
+    IEventChannel(const IEventChannel&) = delete;
+    IEventChannel& operator=(const IEventChannel&) = delete;
+    IEventChannel(IEventChannel&&) = delete;
+    IEventChannel& operator=(IEventChannel&&) = delete;
+
+    /// Id matched against SystemAccessInfo::eventReads.
+    [[nodiscard]] virtual ComponentTypeId EventTypeId() const noexcept = 0;
+
+    /// Replace the published batch with every event sent since the last
+    /// call.  @pre No thread is sending to the channel.
+    virtual void Swap() = 0;
+
+    /// Number of threads that have sent to the channel.
+    [[nodiscard]] std::size_t BufferCount() const;
+
+protected:
+    /// The calling thread's buffer, created with makeBuffer() on first use.
+    [[nodiscard]] detail::EventBuffer& localBuffer();
+
+    /// Allocate an empty buffer of the concrete event type.
+    [[nodiscard]] virtual std::unique_ptr<detail::EventBuffer> makeBuffer() const = 0;
+
+    /// Invoke @p func on every thread's buffer under the registry lock.
+    template <typename Func>
+    void forEachBuffer(Func&& func) {
+        std::lock_guard lock(mutex_);
+        for (const auto& entry : buffers_) {
+            func(*entry.buffer);
+        }
+    }
+
+private:
+    struct ThreadBuffer {
+        std::thread::id thread;
+        std::unique_ptr<detail::EventBuffer> buffer;
+    };
+
+    const uint64_t instanceId_;
+    mutable std::mutex mutex_;
+    std::vector<ThreadBuffer> buffers_;
+};
+
+/// Typed event channel; see file comment.
+///
+/// Send() and Emplace() may be called from any thread while no Swap() is
+/// running; Read() is safe from any number of threads between swaps.
+template <typename E>
+class EventChannel final : public IEventChannel {
+public:
+    using value_type = E;
+
+    /// Queue @p event for publication at the next Swap().
+    void Send(const E& event) { local().push_back(event); }
+    void Send(E&& event) { local().push_back(std::move(event)); }
+
+    /// Construct an event in place.
+    template <typename... Args>
+    E& Emplace(Args&&... args) {
+        return local().emplace_back(std::forward<Args>(args)...);
+    }
+
+    /// Events published by the last Swap(), in per-thread send order.
+    [[nodiscard]] std::span<const E> Read() const noexcept { return published_; }
+
+    [[nodiscard]] ComponentTypeId EventTypeId() const noexcept override {
+        return ComponentType<E>::Id();
+    }
+
+    void Swap() override {
+        published_.clear();
+        std::vector<E>* single = nullptr;
+        std::size_t sources = 0;
+        forEachBuffer([&](detail::EventBuffer& buffer) {
+            auto& events = static_cast<Buffer&>(buffer).events;
+            if (!events.empty()) {
+                single = &events;
+                ++sources;
+            }
+        });
+        if (sources == 1) {
+            // The common single-producer case: exchange the two sides.
+            published_.swap(*single);
+            return;
+        }
+        forEachBuffer([&](detail::EventBuffer& buffer) {
+            auto& events = static_cast<Buffer&>(buffer).events;
+            published_.insert(published_.end(), std::make_move_iterator(events.begin()),
+                              std::make_move_iterator(events.end()));
+            events.clear();
+        });
+    }
+
+private:
+    struct Buffer final : detail::EventBuffer {
+        std::vector<E> events;
+    };
+
+    [[nodiscard]] std::vector<E>& local() { return static_cast<Buffer&>(localBuffer()).events; }
+
+    [[nodiscard]] std::unique_ptr<detail::EventBuffer> makeBuffer() const override {
+        return std::make_unique<Buffer>();
+    }
+
+    std::vector<E> published_;
+};
+
+}  // namespace cgs::ecs
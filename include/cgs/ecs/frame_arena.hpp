@@ -0,0 +1,171 @@
+#pragma once
+
+/// @file frame_arena.hpp
+/// @brief Growable per-tick arena exposed as a std::pmr::memory_resource.
+///
+/// FrameArena hands out memory from a chain of blocks and frees nothing
+/// until Reset().  When a tick needed more than one block, Reset()
+/// replaces the chain with a single block sized to the high-water mark,
+/// so steady-state ticks bump-allocate from one block and never touch the
+/// global heap.
+///
+/// An arena can instead bump-allocate from reserved address space backed
+/// by 2 MB pages (FrameArenaSet::SetReservation()): it then commits pages
+/// as a tick grows and never needs to regrow, and heap blocks are only
+/// used by a tick that outgrows the whole reservation.
+///
+/// FrameArenaSet gives every thread its own arena.  SystemScheduler owns
+/// one, activates it for the duration of Execute() and resets every arena
+/// when the tick ends; systems reach it through ISystem::FrameMemory().
+///
+/// @see ScratchAllocator for the fixed thread-local buffer used inside
+///      Query::ParallelForEach tasks.
+/// @see docs/advanced/ECS_DEEP_DIVE.md  Section 6.12
+
+#include "cgs/ecs/virtual_region.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cgs::ecs {
+
+/// Chained-block monotonic arena, reset once per tick.
+///
+/// Not thread-safe; use one per thread (see FrameArenaSet).
+class FrameArena final : public std::pmr::memory_resource {
+public:
+    /// Size of the first block.
+    static constexpr std::size_t kDefaultBlockSize = 64 * 1024;  // 64 KB
+
+    explicit FrameArena(std::size_t initialBlockSize = kDefaultBlockSize);
+
+    /// Allocate from @p reserveBytes of address space backed by
+    /// @p backing, with heap blocks of @p initialBlockSize and up only
+    /// past that.  Where nothing can be reserved this is the heap arena.
+    FrameArena(std::size_t initialBlockSize, std::size_t reserveBytes, PageBacking backing);
+
+    // Non-copyable, non-movable (containers hold pointers to the arena).
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+    FrameArena(FrameArena&&) = delete;
+    FrameArena& operator=(FrameArena&&) = delete;
+
+    /// Release every allocation.
+    ///
+    /// Keeps a single block; if the tick spilled into further blocks,
+    /// that block is regrown to cover the high-water mark.  A
+    /// region-backed arena keeps its committed pages and drops any
+    /// overflow blocks.
+    void Reset();
+
+    /// Bytes handed out since the last Reset() (alignment padding included).
+    [[nodiscard]] std::size_t BytesUsed() const noexcept { return used_; }
+
+    /// Largest BytesUsed() observed before any Reset().
+    [[nodiscard]] std::size_t HighWaterMark() const noexcept { return highWater_; }
+
+    /// Total size of the retained blocks and committed region pages.
+    [[nodiscard]] std::size_t Capacity() const noexcept;
+
+    /// Number of retained blocks.
+    [[nodiscard]] std::size_t BlockCount() const noexcept { return blocks_.size(); }
+
+    /// True when the arena allocates from reserved address space.
+    [[nodiscard]] bool IsRegionBacked() const noexcept { return region_.IsReserved(); }
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        std::size_t size = 0;
+    };
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+    /// Individual deallocation is a no-op; memory returns on Reset().
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    void addBlock(std::size_t minimumSize);
+
+    /// Bump-allocate from the region, or nullptr when it is full.
+    void* allocateFromRegion(std::size_t bytes, std::size_t alignment);
+
+    VirtualRegion region_;
+    std::size_t regionOffset_ = 0;  ///< Next free byte in region_.
+    std::vector<Block> blocks_;
+    std::size_t current_ = 0;  ///< Block being bumped.
+    std::size_t offset_ = 0;   ///< Next free byte in blocks_[current_].
+    std::size_t used_ = 0;
+    std::size_t highWater_ = 0;
+    std::size_t nextBlockSize_;
+};
+
+/// One FrameArena per thread, reset together.
+///
+/// Resource() is safe to call concurrently; ResetAll() must not overlap
+/// with allocation.  While inactive, Resource() returns the default pmr
+/// resource, so code calling it outside a tick (tests, tools, service
+/// threads) gets ordinary heap memory that it may keep.
+class FrameArenaSet {
+public:
+    FrameArenaSet();
+
+    // Non-copyable, non-movable (threads cache pointers to their arenas).
+    FrameArenaSet(const FrameArenaSet&) = delete;
+    FrameArenaSet& operator=(const FrameArenaSet&) = delete;
+    FrameArenaSet(FrameArenaSet&&) = delete;
+    FrameArenaSet& operator=(FrameArenaSet&&) = delete;
+
+    /// Route Resource() to the per-thread arenas (true) or the heap.
+    void SetActive(bool active) noexcept { active_.store(active, std::memory_order_release); }
+
+    [[nodiscard]] bool IsActive() const noexcept {
+        return active_.load(std::memory_order_acquire);
+    }
+
+    /// The calling thread's arena while active, else the default resource.
+    [[nodiscard]] std::pmr::memory_resource* Resource();
+
+    /// The calling thread's arena, created on first use.
+    [[nodiscard]] FrameArena& Local();
+
+    /// Back arenas created from now on (threads allocating for the first
+    /// time) with @p bytesPerThread of reserved address space, backed by
+    /// @p backing; 0 restores heap arenas.  Call before the first tick.
+    void SetReservation(std::size_t bytesPerThread,
+                        PageBacking backing = PageBacking::Transparent);
+
+    /// Reset every thread's arena.
+    void ResetAll();
+
+    /// Sum of HighWaterMark() over all arenas.
+    [[nodiscard]] std::size_t HighWaterMark() const;
+
+    /// Number of threads that have allocated from the set.
+    [[nodiscard]] std::size_t ArenaCount() const;
+
+private:
+    struct ThreadArena {
+        std::thread::id thread;
+        std::unique_ptr<FrameArena> arena;
+    };
+
+    const uint64_t instanceId_;
+    std::atomic<bool> active_{false};
+
+    mutable std::mutex mutex_;
+    std::vector<ThreadArena> arenas_;
+    std::size_t reservation_ = 0;
+    PageBacking backing_ = PageBacking::Transparent;
+};
+
+}  // namespace cgs::ecs
@@ -0,0 +1,162 @@
+#pragma once
+
+/// @file owning_group.hpp
+/// @brief Owning groups: co-used sparse-set pools kept sorted in lockstep.
+///
+/// An OwningGroup<Ts...> takes ownership of the dense ordering of each
+/// ComponentStorage<Ts>.  Entities that have every Ts are kept in the
+/// first Size() slots of all owned pools, in the same order, so the join
+/// becomes a plain index loop over parallel arrays: no Has() probes and
+/// no cached entity vector.
+///
+/// The invariant is maintained from the pools' Add/Remove hooks: when an
+/// entity gains its last missing component it is swapped to slot Size()
+/// in every pool and the group grows; before an entity loses one it is
+/// swapped to the last group slot and the group shrinks, after which the
+/// pool's ordinary swap-and-pop only touches slots outside the group.
+///
+/// @see docs/advanced/ECS_DEEP_DIVE.md  Section 6.8
+
+#include "cgs/ecs/component_storage.hpp"
+#include "cgs/ecs/entity.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+
+namespace cgs::ecs {
+
+/// Group that owns the dense ordering of the pools for @p Ts.
+///
+/// Each pool can be owned by at most one group at a time.  The group must
+/// outlive any structural change to its pools, and the pools must not be
+/// moved while owned.
+///
+/// Interaction with Query: reordering never changes which entities a pool
+/// holds and does not bump storage versions, so a Query over owned pools
+/// keeps its cache across group swaps and still sees a version change on
+/// every Add/Remove.  Query iteration order over owned pools may change.
+///
+/// @code
+///   OwningGroup<Transform, Movement> movers(transforms, movements);
+///   movers.ForEach([dt](Entity e, Transform& t, Movement& m) {
+///       t.position += m.direction * m.speed * dt;
+///   });
+/// @endcode
+template <typename... Ts>
+class OwningGroup final : public IStorageOwner {
+    static_assert(sizeof...(Ts) >= 2, "An owning group needs at least two pools");
+
+public:
+    /// Take ownership of @p pools and sort existing matches to the front.
+    explicit OwningGroup(ComponentStorage<Ts>&... pools) : pools_{&pools...} {
+        (pools.SetOwner(this), ...);
+
+        auto& lead = leadPool();
+        for (std::size_t i = 0; i < lead.Size(); ++i) {
+            const Entity entity(lead.EntityAt(i), 0);
+            if (hasAll(entity)) {
+                pullIn(entity);
+            }
+        }
+    }
+
+    ~OwningGroup() override {
+        std::apply([](auto*... pools) { (pools->SetOwner(nullptr), ...); }, pools_);
+    }
+
+    // Non-copyable, non-movable (pools hold a pointer to the group).
+    OwningGroup(const OwningGroup&) = delete;
+    OwningGroup& operator=(const OwningGroup&) = delete;
+    OwningGroup(OwningGroup&&) = delete;
+    OwningGroup& operator=(OwningGroup&&) = delete;
+
+    // ── Membership ──────────────────────────────────────────────────────
+
+    /// Number of entities that own every component of the group.
+    [[nodiscard]] std::size_t Size() const noexcept { return size_; }
+
+    /// True when the group is empty.
+    [[nodiscard]] bool Empty() const noexcept { return size_ == 0; }
+
+    /// True when @p entity is a member of the group.
+    [[nodiscard]] bool Contains(Entity entity) const {
+        // Every lead slot below size_ is a member, so one probe suffices.
+        const auto& lead = leadPool();
+        return lead.Has(entity) && lead.IndexOf(entity) < size_;
+    }
+
+    /// Entity id stored at group slot @p index (< Size()).
+    [[nodiscard]] uint32_t EntityAt(std::size_t index) const {
+        assert(index < size_);
+        return leadPool().EntityAt(index);
+    }
+
+    // ── Iteration ───────────────────────────────────────────────────────
+
+    /// Invoke @p func(Entity, Ts&...) for every member, in group order.
+    ///
+    /// Same mutation rules as Query::ForEach: components may be written,
+    /// but adding or removing components of the owned types is undefined.
+    template <typename Func>
+    void ForEach(Func&& func) {
+        auto& lead = leadPool();
+        std::tuple<typename ComponentStorage<Ts>::iterator...> columns{
+            std::get<ComponentStorage<Ts>*>(pools_)->begin()...};
+        for (std::size_t i = 0; i < size_; ++i) {
+            const auto offset = static_cast<std::ptrdiff_t>(i);
+            func(Entity(lead.EntityAt(i), 0),
+                 std::get<typename ComponentStorage<Ts>::iterator>(columns)[offset]...);
+        }
+    }
+
+    // ── IStorageOwner ───────────────────────────────────────────────────
+
+    void OnAdded(Entity entity) override {
+        if (hasAll(entity) && leadPool().IndexOf(entity) >= size_) {
+            pullIn(entity);
+        }
+    }
+
+    void OnRemoving(Entity entity) override {
+        if (!Contains(entity)) {
+            return;
+        }
+        --size_;
+        const auto last = static_cast<uint32_t>(size_);
+        std::apply([&](auto*... pools) { (pools->SwapDense(pools->IndexOf(entity), last), ...); },
+                   pools_);
+    }
+
+    void OnCleared() noexcept override { size_ = 0; }
+
+private:
+    using Lead = std::tuple_element_t<0, std::tuple<Ts...>>;
+
+    [[nodiscard]] ComponentStorage<Lead>& leadPool() noexcept {
+        return *std::get<ComponentStorage<Lead>*>(pools_);
+    }
+    [[nodiscard]] const ComponentStorage<Lead>& leadPool() const noexcept {
+        return *std::get<ComponentStorage<Lead>*>(pools_);
+    }
+
+    [[nodiscard]] bool hasAll(Entity entity) const {
+        return std::apply([&](const auto*... pools) { return (pools->Has(entity) && ...); },
+                          pools_);
+    }
+
+    /// Append @p entity (a non-member owning every type) to the group.
+    void pullIn(Entity entity) {
+        const auto slot = static_cast<uint32_t>(size_);
+        std::apply([&](auto*... pools) { (pools->SwapDense(pools->IndexOf(entity), slot), ...); },
+                   pools_);
+        ++size_;
+    }
+
+    std::tuple<ComponentStorage<Ts>*...> pools_;
+    std::size_t size_ = 0;
+};
+
+}  // namespace cgs::ecs
@@ -0,0 +1,151 @@
+#pragma once
+
+/// @file paged_bitset.hpp
+/// @brief Lazily paged entity-id membership bitset for tag storages.
+///
+/// One bit per entity id, split into fixed pages that are allocated when
+/// their first bit is set and released when their last bit is cleared.
+/// Like SparsePageTable, unallocated pages all point at one shared,
+/// read-only zero page, so a test is two loads and a mask.  A page covers
+/// 32x more ids than a SparsePageTable page of the same size, so
+/// membership tests over large populations stay in cache.
+///
+/// @see docs/advanced/ECS_DEEP_DIVE.md  Section 6.16
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace cgs::ecs {
+
+/// Lazily paged set of 32-bit entity ids.
+class PagedBitset {
+public:
+    /// log2 of ids per page (32768 ids = 4 KB pages).
+    static constexpr uint32_t kPageBits = 15;
+    static constexpr uint32_t kPageSize = 1u << kPageBits;
+    static constexpr uint32_t kPageMask = kPageSize - 1;
+    static constexpr uint32_t kWordsPerPage = kPageSize / 64;
+
+    PagedBitset() = default;
+    ~PagedBitset() { releaseAll(); }
+
+    // Non-copyable, movable.
+    PagedBitset(const PagedBitset&) = delete;
+    PagedBitset& operator=(const PagedBitset&) = delete;
+    PagedBitset(PagedBitset&& other) noexcept
+        : pages_(std::move(other.pages_)),
+          liveCounts_(std::move(other.liveCounts_)),
+          allocatedPages_(std::exchange(other.allocatedPages_, 0)) {}
+    PagedBitset& operator=(PagedBitset&& other) noexcept {
+        if (this != &other) {
+            releaseAll();
+            pages_ = std::move(other.pages_);
+            liveCounts_ = std::move(other.liveCounts_);
+            allocatedPages_ = std::exchange(other.allocatedPages_, 0);
+        }
+        return *this;
+    }
+
+    /// True when @p id is in the set.
+    [[nodiscard]] bool Test(uint32_t id) const noexcept {
+        const uint32_t page = id >> kPageBits;
+        if (page >= pages_.size()) {
+            return false;
+        }
+        return ((pages_[page][(id & kPageMask) >> 6] >> (id & 63u)) & 1u) != 0;
+    }
+
+    /// Insert @p id, allocating its page on first use.
+    void Set(uint32_t id) {
+        const uint32_t page = id >> kPageBits;
+        uint64_t& word = ownPage(page)[(id & kPageMask) >> 6];
+        const uint64_t bit = uint64_t{1} << (id & 63u);
+        if ((word & bit) == 0) {
+            word |= bit;
+            ++liveCounts_[page];
+        }
+    }
+
+    /// Erase @p id, releasing its page if it becomes empty.
+    void Reset(uint32_t id) noexcept {
+        if (!Test(id)) {
+            return;
+        }
+        const uint32_t page = id >> kPageBits;
+        mutablePage(page)[(id & kPageMask) >> 6] &= ~(uint64_t{1} << (id & 63u));
+        if (--liveCounts_[page] == 0) {
+            releasePage(page);
+        }
+    }
+
+    /// Erase every id and release all pages.
+    void Clear() noexcept {
+        releaseAll();
+        pages_.clear();
+        liveCounts_.clear();
+    }
+
+    // ── Memory accounting ───────────────────────────────────────────────
+
+    /// Number of pages currently backed by their own allocation.
+    [[nodiscard]] std::size_t AllocatedPages() const noexcept { return allocatedPages_; }
+
+    /// Approximate heap bytes held by the set (pages + page directory).
+    [[nodiscard]] std::size_t MemoryUsage() const noexcept {
+        return allocatedPages_ * kWordsPerPage * sizeof(uint64_t) +
+               pages_.capacity() * sizeof(const uint64_t*) +
+               liveCounts_.capacity() * sizeof(uint32_t);
+    }
+
+private:
+    /// The shared all-zero page every unallocated slot points at.
+    [[nodiscard]] static const uint64_t* zeroPage() noexcept {
+        static constexpr std::array<uint64_t, kWordsPerPage> page{};
+        return page.data();
+    }
+
+    /// Writable words of an owned page.
+    [[nodiscard]] uint64_t* mutablePage(uint32_t page) noexcept {
+        assert(pages_[page] != zeroPage() && "Page is not allocated");
+        // Owned pages were allocated non-const in ownPage().
+        return const_cast<uint64_t*>(pages_[page]);
+    }
+
+    /// Ensure @p page has its own allocation and return its words.
+    uint64_t* ownPage(uint32_t page) {
+        if (page >= pages_.size()) {
+            pages_.resize(static_cast<std::size_t>(page) + 1, zeroPage());
+            liveCounts_.resize(static_cast<std::size_t>(page) + 1, 0);
+        }
+        if (pages_[page] == zeroPage()) {
+            pages_[page] = new uint64_t[kWordsPerPage]{};
+            ++allocatedPages_;
+        }
+        return mutablePage(page);
+    }
+
+    void releasePage(uint32_t page) noexcept {
+        delete[] mutablePage(page);
+        pages_[page] = zeroPage();
+        --allocatedPages_;
+    }
+
+    void releaseAll() noexcept {
+        for (std::size_t p = 0; p < pages_.size(); ++p) {
+            if (pages_[p] != zeroPage()) {
+                releasePage(static_cast<uint32_t>(p));
+            }
+            liveCounts_[p] = 0;
+        }
+    }
+
+    std::vector<const uint64_t*> pages_;  ///< Page directory.
+    std::vector<uint32_t> liveCounts_;    ///< Set bits per page.
+    std::size_t allocatedPages_ = 0;      ///< Pages with their own storage.
+};
+
+}  // namespace cgs::ecs
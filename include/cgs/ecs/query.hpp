@@ -7,23 +7,164 @@
 /// possess all specified component types, with support for exclude
 /// filters, optional component access, and cached results.
 ///
+/// A query can also be built over an ArchetypeStorage whose component
+/// set contains every Include type; ForEach then walks the archetype's
+/// chunks linearly instead of probing one sparse array per pool.
+///
+/// Wrapping an include in SoA<T> selects a SoAComponentStorage<T> for
+/// that slot; ForEach then passes a SoAComponentStorage<T>::Ref proxy
+/// instead of a T&.
+///
+/// The match list is cached.  When every pool of the query emits
+/// membership notifications (IStorageListener), the cache is patched with
+/// the entities added or removed since the last use; otherwise it is
+/// rebuilt whenever a pool's version changes.
+///
+/// Sparse-set joins read the non-driving pools at random.  ForEach hides
+/// most of that latency by prefetching each pool's sparse slot and
+/// component a few entities ahead; OrderById() additionally walks the
+/// matches in ascending id order, which turns those reads into forward
+/// scans when the pools are (mostly) sorted by entity id.
+///
 /// @see SDS-MOD-013
 /// @see docs/reference/ECS_DESIGN.md  Section 2.5
 
+#include "cgs/ecs/archetype_storage.hpp"
+#include "cgs/ecs/change_version.hpp"
 #include "cgs/ecs/component_storage.hpp"
 #include "cgs/ecs/component_type_id.hpp"
 #include "cgs/ecs/entity.hpp"
+#include "cgs/ecs/scratch_allocator.hpp"
+#include "cgs/ecs/sparse_page_table.hpp"
 
 #include <cassert>
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <limits>
+#include <memory>
 #include <tuple>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 namespace cgs::ecs {
 
+template <typename T>
+class SoAComponentStorage;
+
+template <typename T>
+struct SoA;
+
+namespace detail {
+
+/// Storage type that backs a Query include: ComponentStorage<T> for plain
+/// types, SoAComponentStorage<T> for SoA<T> (see soa_component_storage.hpp).
+template <typename T>
+struct QueryStorage {
+    using type = ComponentStorage<T>;
+};
+
+template <typename T>
+struct QueryStorage<SoA<T>> {
+    using type = SoAComponentStorage<T>;
+};
+
+template <typename T>
+using QueryStorageT = typename QueryStorage<T>::type;
+
+/// True for SoA<T> includes, which never come from an archetype.
+template <typename T>
+inline constexpr bool kIsSoA = false;
+
+template <typename T>
+inline constexpr bool kIsSoA<SoA<T>> = true;
+
+/// Membership changes of one pool, queued for a Query cache.
+///
+/// Filled on the thread that modifies the pool and drained by the query
+/// when it is next used, so each pool's queue has a single writer.
+class CacheSubscription final : public IStorageListener {
+public:
+    explicit CacheSubscription(const IComponentStorage& storage) : storage_(&storage) {}
+
+    void OnComponentAdded(Entity entity) override { queue(entity); }
+    void OnComponentRemoved(Entity entity) override { queue(entity); }
+    void OnStorageCleared() noexcept override {
+        stale_ = true;
+        pending_.clear();
+    }
+
+    [[nodiscard]] const IComponentStorage& Storage() const noexcept { return *storage_; }
+
+    /// Ids of entities whose membership may have changed.
+    [[nodiscard]] const std::vector<uint32_t>& Pending() const noexcept { return pending_; }
+
+    /// True when patching cannot catch up (pool cleared, or more changes
+    /// queued than the pool holds) and the cache must be rebuilt.
+    [[nodiscard]] bool Stale() const noexcept { return stale_; }
+
+    /// Forget queued changes after the cache has absorbed them.
+    void Drain() noexcept {
+        pending_.clear();
+        stale_ = false;
+    }
+
+private:
+    void queue(Entity entity);
+
+    const IComponentStorage* storage_;
+    std::vector<uint32_t> pending_;
+    bool stale_ = false;
+};
+
+/// The subscriptions of one Query.  Unsubscribes from every pool when
+/// destroyed, cleared or assigned over, so a moved Query stays wired.
+class CacheSubscriptions {
+public:
+    CacheSubscriptions() = default;
+    CacheSubscriptions(const CacheSubscriptions&) = delete;
+    CacheSubscriptions& operator=(const CacheSubscriptions&) = delete;
+    CacheSubscriptions(CacheSubscriptions&& other) noexcept;
+    CacheSubscriptions& operator=(CacheSubscriptions&& other) noexcept;
+    ~CacheSubscriptions();
+
+    /// Subscribe to @p storage.  @return false if it emits no notifications.
+    bool Subscribe(const IComponentStorage& storage);
+
+    /// Unsubscribe from every pool.
+    void Clear() noexcept;
+
+    /// Drain every subscription.
+    void DrainAll() noexcept;
+
+    [[nodiscard]] std::size_t Size() const noexcept { return subscriptions_.size(); }
+    [[nodiscard]] bool Empty() const noexcept { return subscriptions_.empty(); }
+
+    [[nodiscard]] auto begin() const noexcept { return subscriptions_.begin(); }
+    [[nodiscard]] auto end() const noexcept { return subscriptions_.end(); }
+
+private:
+    std::vector<std::unique_ptr<CacheSubscription>> subscriptions_;
+};
+
+/// Count one full cache rebuild / one incremental patch process-wide.
+void RecordQueryRebuild() noexcept;
+void RecordQueryPatch() noexcept;
+
+}  // namespace detail
+
+/// Process-wide Query cache maintenance counters (see GetQueryCacheStats()).
+struct QueryCacheStats {
+    uint64_t rebuilds = 0;  ///< Match lists rebuilt from the pools.
+    uint64_t patches = 0;   ///< Refreshes served by applying notifications.
+};
+
+/// Totals over every Query since process start.
+[[nodiscard]] QueryCacheStats GetQueryCacheStats() noexcept;
+
 /// Multi-component query with include/exclude filters and caching.
 ///
 /// A Query iterates all entities that possess every component type in
@@ -39,6 +180,16 @@ namespace cgs::ecs {
 ///       undefined behavior.  Schedule mutations via deferred operations
 ///       or separate passes.
 ///
+/// @note ParallelForEach splits the match list into ranges that run
+///       concurrently.  The callback may write the components it is
+///       handed (each entity is visited by exactly one worker) and read
+///       any storage that no other task writes.  It must not add or
+///       remove components in any storage, touch another entity's
+///       components through the included storages, or call methods on
+///       this Query.  Structural changes go through
+///       EntityManager::DestroyDeferred() or a per-range buffer in the
+///       worker's ScratchAllocator, applied after the call returns.
+///
 /// Usage:
 /// @code
 ///   ComponentStorage<Position> posStore;
@@ -59,8 +210,31 @@ public:
     using iterator = typename std::vector<Entity>::iterator;
     using const_iterator = typename std::vector<Entity>::const_iterator;
 
+    /// Function that executes a vector of tasks in parallel and blocks
+    /// until all of them complete.  Same contract as
+    /// SystemScheduler::ParallelExecutor, so one executor (e.g. a wrapper
+    /// around GameJobScheduler) can drive both.
+    using ParallelExecutor = std::function<void(const std::vector<std::function<void()>>&)>;
+
+    /// Entities per task when ParallelForEach is given a grain size of 0.
+    static constexpr std::size_t kDefaultGrainSize = 1024;
+
+    /// How many entities ahead ForEach loads components; sparse slots are
+    /// loaded twice as far ahead, since the component load reads them.
+    static constexpr std::size_t kPrefetchDistance = 8;
+
     /// Construct a query from the storages for each included component type.
-    explicit Query(ComponentStorage<Includes>&... storages) : storages_{&storages...} {}
+    explicit Query(detail::QueryStorageT<Includes>&... storages) : storages_{&storages...} {}
+
+    /// Construct a query that iterates the chunks of @p archetype.
+    ///
+    /// Every Include type must be part of the archetype's component set;
+    /// the archetype may contain additional types that the query ignores.
+    template <typename... Ts>
+    explicit Query(ArchetypeStorage<Ts...>& archetype) : archetype_{&archetype} {
+        static_assert((ArchetypeStorage<Ts...>::template kContains<Includes> && ...),
+                      "Archetype does not contain every queried component type");
+    }
 
     // Non-copyable, movable.
     Query(const Query&) = delete;
@@ -80,6 +254,32 @@ public:
         return *this;
     }
 
+    /// Keep only entities whose @p T component changed after
+    /// @p sinceVersion (see change_version.hpp).
+    ///
+    /// @p T must be one of the Includes.  Calling again for the same type
+    /// replaces the previous threshold, so a long-lived query can be
+    /// re-armed every run.  Multiple filters must all pass.
+    ///
+    /// @code
+    ///   Query<Transform, MapMembership> moved(transforms, memberships);
+    ///   moved.Changed<Transform>(LastRunVersion()).ForEach(...);
+    /// @endcode
+    ///
+    /// @pre The query is not archetype-backed (archetypes keep no
+    ///      per-row versions).
+    template <typename T>
+    Query& Changed(uint32_t sinceVersion) {
+        return setVersionFilter<T, false>(sinceVersion);
+    }
+
+    /// Keep only entities whose @p T component was added after
+    /// @p sinceVersion.  Same rules as Changed().
+    template <typename T>
+    Query& Added(uint32_t sinceVersion) {
+        return setVersionFilter<T, true>(sinceVersion);
+    }
+
     /// Register an optional component storage for @p T.
     ///
     /// Optional components do not affect entity matching but can be
@@ -90,6 +290,21 @@ public:
         return *this;
     }
 
+    /// Visit matches in ascending entity-id order instead of the driving
+    /// pool's dense order.
+    ///
+    /// Pays off when the pools are mostly co-sorted by id (entities
+    /// created together and rarely removed, or pools sorted with SortBy()
+    /// on id): component reads then advance through every dense array.
+    /// Costs a sort per rebuild and, after a patch, a check that is
+    /// followed by a re-sort only when the order broke.  Archetype
+    /// queries walk chunks regardless; only their iterators are ordered.
+    Query& OrderById(bool enabled = true) {
+        orderById_ = enabled;
+        cacheValid_ = false;
+        return *this;
+    }
+
     // ── Iteration ────────────────────────────────────────────────────────
 
     /// Invoke @p func for every matching entity.
@@ -104,10 +319,74 @@ public:
     /// @endcode
     template <typename Func>
     void ForEach(Func&& func) {
+        if constexpr (!(detail::kIsSoA<Includes> || ...)) {
+            if (archetype_ != nullptr) {
+                forEachChunkRow(func);
+                return;
+            }
+        }
+        RefreshCache();
+        const std::size_t count = cachedEntities_.size();
+        for (std::size_t i = 0; i < count; ++i) {
+            prefetchAhead(i, count);
+            const Entity e = cachedEntities_[i];
+            func(e, std::get<detail::QueryStorageT<Includes>*>(storages_)->Get(e)...);
+        }
+    }
+
+    /// Invoke @p func for every matching entity, split into ranges of at
+    /// most @p grainSize entities that run as tasks on @p executor.
+    ///
+    /// The callback has the same signature as for ForEach.  Each task
+    /// may use ScratchAllocator::GetThreadLocal() for temporaries; the
+    /// allocator is rewound to its prior offset when the task's range
+    /// ends.  Runs inline when @p executor is empty or only one range
+    /// results.  See the class notes for the write-safety rules.
+    ///
+    /// @code
+    ///   query.ParallelForEach(executor, 512, [dt](Entity, Transform& t, Movement& m) {
+    ///       t.position.x += m.direction.x * m.speed * dt;
+    ///   });
+    /// @endcode
+    template <typename Func>
+    void ParallelForEach(const ParallelExecutor& executor, std::size_t grainSize, Func&& func) {
+        if (grainSize == 0) {
+            grainSize = kDefaultGrainSize;
+        }
+
+        std::vector<std::function<void()>> tasks;
+        if constexpr (!(detail::kIsSoA<Includes> || ...)) {
+            if (archetype_ != nullptr) {
+                for (std::size_t c = 0; c < archetype_->ChunkCount(); ++c) {
+                    const std::size_t rows = archetype_->ChunkSize(c);
+                    for (std::size_t b = 0; b < rows; b += grainSize) {
+                        const std::size_t e = std::min(rows, b + grainSize);
+                        tasks.emplace_back([this, &func, c, b, e] {
+                            withScratchScope([&] { forEachChunkRows(func, c, b, e); });
+                        });
+                    }
+                }
+                dispatch(executor, tasks);
+                return;
+            }
+        }
+
         RefreshCache();
-        for (Entity e : cachedEntities_) {
-            func(e, std::get<ComponentStorage<Includes>*>(storages_)->Get(e)...);
+        const std::size_t count = cachedEntities_.size();
+        for (std::size_t b = 0; b < count; b += grainSize) {
+            const std::size_t e = std::min(count, b + grainSize);
+            tasks.emplace_back([this, &func, b, e] {
+                withScratchScope([&] {
+                    for (std::size_t i = b; i < e; ++i) {
+                        prefetchAhead(i, e);
+                        const Entity entity = cachedEntities_[i];
+                        func(entity,
+                             std::get<detail::QueryStorageT<Includes>*>(storages_)->Get(entity)...);
+                    }
+                });
+            });
         }
+        dispatch(executor, tasks);
     }
 
     /// Return the number of matching entities.
@@ -116,6 +395,12 @@ public:
         return cachedEntities_.size();
     }
 
+    /// Number of times this query rebuilt its match list from the pools.
+    [[nodiscard]] uint64_t RebuildCount() const noexcept { return rebuilds_; }
+
+    /// Number of times this query patched its match list incrementally.
+    [[nodiscard]] uint64_t PatchCount() const noexcept { return patches_; }
+
     // ── Optional access ──────────────────────────────────────────────────
 
     /// Get an optional component for @p entity, or nullptr if absent.
@@ -185,22 +470,197 @@ private:
     /// and are excluded from the fingerprint.
     [[nodiscard]] uint64_t computeVersionFingerprint() const noexcept {
         uint64_t fp = 0;
-        std::apply([&](auto*... ptrs) { ((fp += ptrs->GlobalVersion()), ...); }, storages_);
+        if (archetype_ != nullptr) {
+            fp += archetype_->Version();
+        } else {
+            std::apply([&](auto*... ptrs) { ((fp += ptrs->GlobalVersion()), ...); }, storages_);
+        }
         for (const auto* ex : excludes_) {
             fp += ex->Version();
         }
         return fp;
     }
 
-    /// Rebuild the cached entity list if stale.
+    /// Bring the cached entity list up to date: patch it from queued
+    /// notifications when subscribed, else rebuild on version mismatch.
     void RefreshCache() const {
+        if (cacheValid_) {
+            if (!subscriptions_.Empty()) {
+                if (patchCache()) {
+                    return;
+                }
+            } else if (cacheVersion_ == computeVersionFingerprint()) {
+                return;
+            }
+        }
+        rebuildCache();
+    }
+
+    /// Apply every queued membership change.
+    ///
+    /// @return false when a rebuild is needed instead (a pool was
+    ///         cleared, or more entities changed than a rebuild would
+    ///         visit, so rebuilding is no more expensive).
+    bool patchCache() const {
+        std::size_t pending = 0;
+        for (const auto& subscription : subscriptions_) {
+            if (subscription->Stale()) {
+                return false;
+            }
+            pending += subscription->Pending().size();
+        }
+        if (pending == 0) {
+            return true;
+        }
+        if (pending > smallestIncludeSize() + cachedEntities_.size()) {
+            return false;
+        }
+
+        for (const auto& subscription : subscriptions_) {
+            for (const uint32_t id : subscription->Pending()) {
+                patchEntity(Entity(id, 0));
+            }
+        }
+        subscriptions_.DrainAll();
+        if (restoreIdOrder()) {
+            reslot();
+        }
+        ++patches_;
+        detail::RecordQueryPatch();
+        return true;
+    }
+
+    /// Insert or erase @p entity so the cache reflects its current state.
+    void patchEntity(Entity entity) const {
+        const bool matches = hasAllIncludes(entity) && !isExcluded(entity);
+        const bool cached = cacheSlots_.Contains(entity.id());
+        if (matches && !cached) {
+            cacheSlots_.Set(entity.id(), static_cast<uint32_t>(cachedEntities_.size()));
+            cachedEntities_.push_back(entity);
+        } else if (!matches && cached) {
+            const uint32_t slot = cacheSlots_.Get(entity.id());
+            const Entity last = cachedEntities_.back();
+            cachedEntities_[slot] = last;
+            cacheSlots_.Update(last.id(), slot);
+            cachedEntities_.pop_back();
+            cacheSlots_.Reset(entity.id());
+        }
+    }
+
+    /// Subscribe to every Include and Exclude pool unless the query
+    /// relies on versions (archetype, Changed/Added filters) or a pool
+    /// emits no notifications.
+    ///
+    /// @return true when the cache will be maintained by patching.
+    bool trackMembership() const {
+        if (archetype_ != nullptr || !versionFilters_.empty() || membershipUntracked_) {
+            subscriptions_.Clear();
+            return false;
+        }
+        if (subscriptions_.Size() != sizeof...(Includes) + excludes_.size()) {
+            subscriptions_.Clear();
+            bool subscribed = true;
+            std::apply(
+                [&](auto*... ptrs) {
+                    ((subscribed = subscribed && subscriptions_.Subscribe(*ptrs)), ...);
+                },
+                storages_);
+            for (const auto* ex : excludes_) {
+                subscribed = subscribed && subscriptions_.Subscribe(*ex);
+            }
+            if (!subscribed) {
+                subscriptions_.Clear();
+                membershipUntracked_ = true;
+                return false;
+            }
+        }
+        subscriptions_.DrainAll();
+        return true;
+    }
+
+    /// Rebuild the cached entity list from the pools.
+    void rebuildCache() const {
+        ++rebuilds_;
+        detail::RecordQueryRebuild();
         const uint64_t fp = computeVersionFingerprint();
-        if (cacheValid_ && cacheVersion_ == fp) {
-            return;
+        const bool tracked = trackMembership();
+
+        rebuildEntities(fp);
+        (void)restoreIdOrder();
+
+        cacheSlots_.Clear();
+        if (tracked) {
+            reslot();
+        }
+    }
+
+    /// Point cacheSlots_ at every cached entity's current position.
+    void reslot() const {
+        for (std::size_t i = 0; i < cachedEntities_.size(); ++i) {
+            cacheSlots_.Set(cachedEntities_[i].id(), static_cast<uint32_t>(i));
+        }
+    }
+
+    /// Sort cachedEntities_ by id if OrderById() is on and the order broke.
+    ///
+    /// @return true when entities moved.
+    bool restoreIdOrder() const {
+        auto byId = [](Entity lhs, Entity rhs) { return lhs.id() < rhs.id(); };
+        if (!orderById_ || std::is_sorted(cachedEntities_.begin(), cachedEntities_.end(), byId)) {
+            return false;
+        }
+        std::sort(cachedEntities_.begin(), cachedEntities_.end(), byId);
+        return true;
+    }
+
+    /// Lookahead for the match-list loops: while entity @p i is visited,
+    /// load the component of entity i + kPrefetchDistance and the sparse
+    /// slot of entity i + 2 * kPrefetchDistance in every Include pool.
+    /// @p end bounds the range being walked.
+    void prefetchAhead(std::size_t i, std::size_t end) const noexcept {
+        if (i + kPrefetchDistance < end) {
+            const Entity next = cachedEntities_[i + kPrefetchDistance];
+            std::apply([&](auto*... ptrs) { (ptrs->PrefetchComponent(next), ...); }, storages_);
+        }
+        if (i + 2 * kPrefetchDistance < end) {
+            const Entity later = cachedEntities_[i + 2 * kPrefetchDistance];
+            std::apply([&](auto*... ptrs) { (ptrs->PrefetchIndex(later), ...); }, storages_);
         }
+    }
+
+    /// True when every Include pool holds @p entity.
+    [[nodiscard]] bool hasAllIncludes(Entity entity) const {
+        return std::apply([&](auto*... ptrs) { return (ptrs->Has(entity) && ...); }, storages_);
+    }
 
+    /// Size of the smallest Include pool.
+    [[nodiscard]] std::size_t smallestIncludeSize() const {
+        std::size_t smallest = std::numeric_limits<std::size_t>::max();
+        std::apply([&](auto*... ptrs) { ((smallest = std::min(smallest, ptrs->Size())), ...); },
+                   storages_);
+        return smallest;
+    }
+
+    /// Recompute cachedEntities_ and stamp the cache with @p fp.
+    void rebuildEntities(uint64_t fp) const {
         cachedEntities_.clear();
 
+        if (archetype_ != nullptr) {
+            for (std::size_t c = 0; c < archetype_->ChunkCount(); ++c) {
+                const uint32_t* ids = archetype_->ChunkEntities(c);
+                const std::size_t rows = archetype_->ChunkSize(c);
+                for (std::size_t i = 0; i < rows; ++i) {
+                    const Entity entity(ids[i], 0);
+                    if (!isExcluded(entity)) {
+                        cachedEntities_.push_back(entity);
+                    }
+                }
+            }
+            cacheVersion_ = fp;
+            cacheValid_ = true;
+            return;
+        }
+
         // Find the smallest Include storage for optimal iteration.
         const IComponentStorage* smallest = nullptr;
         std::size_t smallestSize = std::numeric_limits<std::size_t>::max();
@@ -222,8 +682,13 @@ private:
             return;
         }
 
-        // Iterate entities in the smallest storage and test membership.
+        // Iterate entities in the smallest storage and test membership,
+        // loading the other pools' sparse slots a few entities ahead.
         for (std::size_t i = 0; i < smallestSize; ++i) {
+            if (i + kPrefetchDistance < smallestSize) {
+                const Entity ahead(smallest->EntityAt(i + kPrefetchDistance), 0);
+                std::apply([&](auto*... ptrs) { (ptrs->PrefetchIndex(ahead), ...); }, storages_);
+            }
             const uint32_t eid = smallest->EntityAt(i);
             const Entity entity(eid, 0);
 
@@ -251,14 +716,11 @@ private:
             }
 
             // None of the Exclude storages may contain this entity.
-            bool excluded = false;
-            for (const auto* ex : excludes_) {
-                if (ex->Has(entity)) {
-                    excluded = true;
-                    break;
-                }
+            if (isExcluded(entity)) {
+                continue;
             }
-            if (excluded) {
+
+            if (!passesVersionFilters(entity)) {
                 continue;
             }
 
@@ -269,18 +731,143 @@ private:
         cacheValid_ = true;
     }
 
-    /// Pointers to the Include component storages.
-    std::tuple<ComponentStorage<Includes>*...> storages_;
+    /// A Changed/Added threshold on one Include storage.
+    struct VersionFilter {
+        const void* storage = nullptr;
+        bool added = false;
+        uint32_t sinceVersion = kAnyVersion;
+        bool (*passes)(const void* storage, Entity entity, uint32_t sinceVersion) = nullptr;
+    };
+
+    template <typename T, bool kAdded>
+    Query& setVersionFilter(uint32_t sinceVersion) {
+        static_assert((std::is_same_v<T, Includes> || ...),
+                      "Changed/Added filters apply to included component types only");
+        static_assert(!std::is_empty_v<T> || detail::kIsSoA<T>,
+                      "Tag components keep no per-component versions");
+        assert(archetype_ == nullptr && "Archetype-backed queries have no per-row versions");
+
+        using Storage = detail::QueryStorageT<T>;
+        const void* storage = std::get<Storage*>(storages_);
+        cacheValid_ = false;
+        for (auto& filter : versionFilters_) {
+            if (filter.storage == storage && filter.added == kAdded) {
+                filter.sinceVersion = sinceVersion;
+                return *this;
+            }
+        }
+        versionFilters_.push_back(
+            {storage, kAdded, sinceVersion, [](const void* p, Entity e, uint32_t since) {
+                 const auto* typed = static_cast<const Storage*>(p);
+                 if constexpr (kAdded) {
+                     return typed->WasAdded(e, since);
+                 } else {
+                     return typed->HasChanged(e, since);
+                 }
+             }});
+        return *this;
+    }
+
+    /// True when @p entity passes every Changed/Added filter.
+    [[nodiscard]] bool passesVersionFilters(Entity entity) const {
+        for (const auto& filter : versionFilters_) {
+            if (!filter.passes(filter.storage, entity, filter.sinceVersion)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// True when any Exclude storage contains @p entity.
+    [[nodiscard]] bool isExcluded(Entity entity) const {
+        for (const auto* ex : excludes_) {
+            if (ex->Has(entity)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Archetype path of ForEach: resolve each Include column once per
+    /// chunk, then walk the rows linearly.
+    template <typename Func>
+    void forEachChunkRow(Func& func) {
+        for (std::size_t c = 0; c < archetype_->ChunkCount(); ++c) {
+            forEachChunkRows(func, c, 0, archetype_->ChunkSize(c));
+        }
+    }
+
+    /// Visit rows [@p begin, @p end) of archetype chunk @p chunk.
+    template <typename Func>
+    void forEachChunkRows(Func& func, std::size_t chunk, std::size_t begin, std::size_t end) {
+        const uint32_t* ids = archetype_->ChunkEntities(chunk);
+        std::tuple<Includes*...> columns{static_cast<Includes*>(
+            archetype_->ChunkColumn(chunk, ComponentType<Includes>::Id()))...};
+
+        for (std::size_t i = begin; i < end; ++i) {
+            const Entity entity(ids[i], 0);
+            if (!excludes_.empty() && isExcluded(entity)) {
+                continue;
+            }
+            func(entity, std::get<Includes*>(columns)[i]...);
+        }
+    }
+
+    /// Run @p body with the calling thread's scratch allocator rewound
+    /// to its current offset afterwards.
+    template <typename Body>
+    static void withScratchScope(Body&& body) {
+        auto& scratch = ScratchAllocator::GetThreadLocal();
+        const std::size_t mark = scratch.BytesUsed();
+        body();
+        scratch.Rewind(mark);
+    }
+
+    /// Run @p tasks on @p executor, or inline when parallelism buys nothing.
+    static void dispatch(const ParallelExecutor& executor,
+                         const std::vector<std::function<void()>>& tasks) {
+        if (!executor || tasks.size() <= 1) {
+            for (const auto& task : tasks) {
+                task();
+            }
+            return;
+        }
+        executor(tasks);
+    }
+
+    /// Pointers to the Include component storages (null in archetype mode).
+    std::tuple<detail::QueryStorageT<Includes>*...> storages_{};
+
+    /// Archetype iterated by this query, or nullptr for sparse-set pools.
+    IArchetypeStorage* archetype_ = nullptr;
 
     /// Pointers to storages whose presence excludes an entity.
     std::vector<const IComponentStorage*> excludes_;
 
+    /// Changed/Added thresholds applied when the cache is rebuilt.
+    std::vector<VersionFilter> versionFilters_;
+
     /// Optional component storages keyed by ComponentTypeId.
     std::unordered_map<ComponentTypeId, void*> optionals_;
 
-    /// Cached matching entities (rebuilt on version mismatch).
+    /// Cached matching entities.
     mutable std::vector<Entity> cachedEntities_;
 
+    /// Entity id -> index in cachedEntities_ (only while subscribed).
+    mutable SparsePageTable cacheSlots_;
+
+    /// Notification queues of the Include and Exclude pools.
+    mutable detail::CacheSubscriptions subscriptions_;
+
+    /// Set once a pool turned out not to emit notifications.
+    mutable bool membershipUntracked_ = false;
+
+    /// Keep cachedEntities_ in ascending id order (see OrderById()).
+    bool orderById_ = false;
+
+    mutable uint64_t rebuilds_ = 0;
+    mutable uint64_t patches_ = 0;
+
     /// Version fingerprint at the time the cache was built.
     mutable uint64_t cacheVersion_ = 0;
 
@@ -8,8 +8,16 @@
 /// via thread_local storage.  Call Reset() to reclaim all memory
 /// (typically once per frame or per batch).
 ///
+/// An allocator given an address space reservation bump-allocates from a
+/// VirtualRegion instead, committing (huge) pages as it grows, so earlier
+/// allocations never move.
+///
 /// @see SDS-MOD-012 (Parallel Execution)
 
+#include "cgs/ecs/virtual_region.hpp"
+
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -43,24 +51,56 @@ public:
 
     explicit ScratchAllocator(std::size_t capacity = kDefaultCapacity) : buffer_(capacity) {}
 
+    /// Allocate from @p reserveBytes of reserved address space backed by
+    /// @p backing, committing @p capacity up front.  Falls back to a heap
+    /// buffer of @p capacity where no address space can be reserved.
+    ScratchAllocator(std::size_t capacity, std::size_t reserveBytes, PageBacking backing) {
+        if (reserveBytes == 0 || !region_.Reserve(std::max(reserveBytes, capacity), backing) ||
+            !region_.Commit(capacity)) {
+            region_.Release();
+            buffer_.resize(capacity);
+        }
+    }
+
     // Non-copyable, non-movable (thread-local singleton).
     ScratchAllocator(const ScratchAllocator&) = delete;
     ScratchAllocator& operator=(const ScratchAllocator&) = delete;
 
     /// Get the thread-local scratch allocator instance.
     static ScratchAllocator& GetThreadLocal() {
-        thread_local ScratchAllocator instance;
+        thread_local ScratchAllocator instance(
+            kDefaultCapacity, threadLocalReservation().load(std::memory_order_relaxed),
+            threadLocalBacking().load(std::memory_order_relaxed));
         return instance;
     }
 
+    /// Reserve @p maxBytes of address space, backed by @p backing, for
+    /// each thread-local allocator created after this call (0 = heap
+    /// buffers).  Call at startup, before worker threads first allocate.
+    static void SetThreadLocalReservation(std::size_t maxBytes,
+                                          PageBacking backing = PageBacking::Transparent) noexcept {
+        threadLocalBacking().store(backing, std::memory_order_relaxed);
+        threadLocalReservation().store(maxBytes, std::memory_order_relaxed);
+    }
+
     /// Allocate @p bytes of raw memory (16-byte aligned).
     ///
     /// @return Pointer to the allocated memory, or nullptr if the
-    ///         buffer is exhausted.
+    ///         address space reservation is exhausted.
     void* Allocate(std::size_t bytes) {
         // Align up to kAlignment.
         const std::size_t aligned = (bytes + kAlignment - 1) & ~(kAlignment - 1);
 
+        if (region_.IsReserved()) {
+            // Commit in place: earlier allocations stay where they are.
+            if (!region_.Commit(offset_ + aligned)) {
+                return nullptr;
+            }
+            void* ptr = region_.Data() + offset_;
+            offset_ += aligned;
+            return ptr;
+        }
+
         if (offset_ + aligned > buffer_.size()) {
             // Grow the buffer to accommodate the request.
             buffer_.resize((offset_ + aligned) * 2);
@@ -92,14 +132,37 @@ public:
     /// Reset all allocations without freeing the underlying buffer.
     void Reset() noexcept { offset_ = 0; }
 
+    /// Release everything allocated after @p mark (a prior BytesUsed()).
+    void Rewind(std::size_t mark) noexcept {
+        assert(mark <= offset_ && "Rewind mark is ahead of the current offset");
+        offset_ = mark;
+    }
+
     /// Current number of bytes in use.
     [[nodiscard]] std::size_t BytesUsed() const noexcept { return offset_; }
 
-    /// Total capacity of the underlying buffer.
-    [[nodiscard]] std::size_t Capacity() const noexcept { return buffer_.size(); }
+    /// Total capacity of the underlying buffer (committed bytes when
+    /// region-backed).
+    [[nodiscard]] std::size_t Capacity() const noexcept {
+        return region_.IsReserved() ? region_.Committed() : buffer_.size();
+    }
+
+    /// True when allocations come from reserved address space.
+    [[nodiscard]] bool IsRegionBacked() const noexcept { return region_.IsReserved(); }
 
 private:
+    static std::atomic<std::size_t>& threadLocalReservation() noexcept {
+        static std::atomic<std::size_t> bytes{0};
+        return bytes;
+    }
+
+    static std::atomic<PageBacking>& threadLocalBacking() noexcept {
+        static std::atomic<PageBacking> backing{PageBacking::Transparent};
+        return backing;
+    }
+
     std::vector<uint8_t> buffer_;
+    VirtualRegion region_;
     std::size_t offset_ = 0;
 };
 
@@ -0,0 +1,302 @@
+#pragma once
+
+/// @file small_vector.hpp
+/// @brief Vector with inline capacity for variable-length component fields.
+///
+/// SmallVector<T, N> keeps up to N elements inside the object and only
+/// moves to the heap once it grows past that.  Components that usually
+/// hold a handful of entries (auras, threat sources, enchants) then live
+/// entirely in ComponentStorage's dense array, so an entity costs no
+/// extra heap block and spawning or respawning it allocates nothing.
+///
+/// The interface is the subset of std::vector that components use;
+/// iterators are raw pointers, so <algorithm> works unchanged.  Use the
+/// erase_if() overload below in place of std::erase_if.
+///
+/// @see docs/advanced/ECS_DEEP_DIVE.md  Section 6.13
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace cgs::ecs {
+
+/// Contiguous sequence storing up to @p N elements inline.
+///
+/// Moving a SmallVector whose elements are inline moves them one by one;
+/// moving one that spilled to the heap steals the block.  Not
+/// thread-safe.
+template <typename T, std::size_t N>
+class SmallVector {
+    static_assert(N > 0, "SmallVector needs at least one inline element");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    /// Number of elements held without a heap allocation.
+    static constexpr std::size_t kInlineCapacity = N;
+
+    SmallVector() noexcept = default;
+
+    explicit SmallVector(size_type count) { resize(count); }
+
+    SmallVector(size_type count, const T& value) { resize(count, value); }
+
+    SmallVector(std::initializer_list<T> init) { assign(init.begin(), init.end()); }
+
+    template <std::input_iterator It>
+    SmallVector(It first, It last) {
+        assign(first, last);
+    }
+
+    SmallVector(const SmallVector& other) { assign(other.begin(), other.end()); }
+
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        takeFrom(other);
+    }
+
+    ~SmallVector() {
+        clear();
+        releaseHeap();
+    }
+
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept(
+        std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            clear();
+            releaseHeap();
+            takeFrom(other);
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(std::initializer_list<T> init) {
+        assign(init.begin(), init.end());
+        return *this;
+    }
+
+    /// Replace the contents with [first, last).
+    template <std::input_iterator It>
+    void assign(It first, It last) {
+        clear();
+        if constexpr (std::forward_iterator<It>) {
+            reserve(static_cast<size_type>(std::distance(first, last)));
+        }
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+
+    // ── Element access ──────────────────────────────────────────────────
+
+    [[nodiscard]] T& operator[](size_type index) noexcept { return data_[index]; }
+    [[nodiscard]] const T& operator[](size_type index) const noexcept { return data_[index]; }
+
+    [[nodiscard]] T& front() noexcept { return data_[0]; }
+    [[nodiscard]] const T& front() const noexcept { return data_[0]; }
+
+    [[nodiscard]] T& back() noexcept { return data_[size_ - 1]; }
+    [[nodiscard]] const T& back() const noexcept { return data_[size_ - 1]; }
+
+    [[nodiscard]] T* data() noexcept { return data_; }
+    [[nodiscard]] const T* data() const noexcept { return data_; }
+
+    // ── Iterators ───────────────────────────────────────────────────────
+
+    [[nodiscard]] iterator begin() noexcept { return data_; }
+    [[nodiscard]] const_iterator begin() const noexcept { return data_; }
+    [[nodiscard]] const_iterator cbegin() const noexcept { return data_; }
+
+    [[nodiscard]] iterator end() noexcept { return data_ + size_; }
+    [[nodiscard]] const_iterator end() const noexcept { return data_ + size_; }
+    [[nodiscard]] const_iterator cend() const noexcept { return data_ + size_; }
+
+    // ── Capacity ────────────────────────────────────────────────────────
+
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+    [[nodiscard]] size_type size() const noexcept { return size_; }
+    [[nodiscard]] size_type capacity() const noexcept { return capacity_; }
+
+    /// True while the elements live in the inline buffer.
+    [[nodiscard]] bool IsInline() const noexcept { return data_ == inlineData(); }
+
+    /// Ensure room for @p count elements without further reallocation.
+    void reserve(size_type count) {
+        if (count > capacity_) {
+            reallocate(count);
+        }
+    }
+
+    // ── Modifiers ───────────────────────────────────────────────────────
+
+    /// Destroy every element; the capacity is kept.
+    void clear() noexcept {
+        std::destroy(begin(), end());
+        size_ = 0;
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (size_ == capacity_) {
+            return growAndEmplace(std::forward<Args>(args)...);
+        }
+        T* slot = std::construct_at(data_ + size_, std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    void pop_back() noexcept {
+        --size_;
+        std::destroy_at(data_ + size_);
+    }
+
+    /// Erase the element at @p pos; later elements shift down.
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+    /// Erase [first, last); later elements shift down.
+    iterator erase(const_iterator first, const_iterator last) {
+        T* target = data_ + (first - data_);
+        T* tail = data_ + (last - data_);
+        if (target != tail) {
+            T* newEnd = std::move(tail, end(), target);
+            std::destroy(newEnd, end());
+            size_ = static_cast<size_type>(newEnd - data_);
+        }
+        return target;
+    }
+
+    void resize(size_type count) {
+        if (count < size_) {
+            std::destroy(data_ + count, end());
+        } else {
+            reserve(count);
+            std::uninitialized_value_construct(end(), data_ + count);
+        }
+        size_ = count;
+    }
+
+    void resize(size_type count, const T& value) {
+        if (count < size_) {
+            std::destroy(data_ + count, end());
+            size_ = count;
+            return;
+        }
+        if (count > capacity_) {
+            // @p value may be one of our elements; copy it before moving.
+            T copy(value);
+            reserve(count);
+            std::uninitialized_fill(end(), data_ + count, copy);
+        } else {
+            std::uninitialized_fill(end(), data_ + count, value);
+        }
+        size_ = count;
+    }
+
+    [[nodiscard]] friend bool operator==(const SmallVector& lhs, const SmallVector& rhs) {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+private:
+    [[nodiscard]] T* inlineData() noexcept { return reinterpret_cast<T*>(inline_); }
+    [[nodiscard]] const T* inlineData() const noexcept {
+        return reinterpret_cast<const T*>(inline_);
+    }
+
+    /// Move @p other's elements (or heap block) into this empty, inline vector.
+    void takeFrom(SmallVector& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (!other.IsInline()) {
+            data_ = other.data_;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            other.data_ = other.inlineData();
+            other.size_ = 0;
+            other.capacity_ = N;
+            return;
+        }
+        std::uninitialized_move(other.begin(), other.end(), data_);
+        size_ = other.size_;
+        other.clear();
+    }
+
+    void releaseHeap() noexcept {
+        if (!IsInline()) {
+            std::allocator<T>{}.deallocate(data_, capacity_);
+            data_ = inlineData();
+            capacity_ = N;
+        }
+    }
+
+    void reallocate(size_type newCapacity) {
+        T* block = std::allocator<T>{}.allocate(newCapacity);
+        std::uninitialized_move(begin(), end(), block);
+        replaceStorage(block, newCapacity);
+    }
+
+    template <typename... Args>
+    T& growAndEmplace(Args&&... args) {
+        const size_type newCapacity = capacity_ * 2;
+        T* block = std::allocator<T>{}.allocate(newCapacity);
+        // Construct first: @p args may refer to an element being moved.
+        T* slot = std::construct_at(block + size_, std::forward<Args>(args)...);
+        std::uninitialized_move(begin(), end(), block);
+        replaceStorage(block, newCapacity);
+        ++size_;
+        return *slot;
+    }
+
+    /// Destroy the current elements and adopt @p block (already filled).
+    void replaceStorage(T* block, size_type newCapacity) noexcept {
+        std::destroy(begin(), end());
+        releaseHeap();
+        data_ = block;
+        capacity_ = newCapacity;
+    }
+
+    T* data_ = inlineData();
+    size_type size_ = 0;
+    size_type capacity_ = N;
+    alignas(T) std::byte inline_[sizeof(T) * N];
+};
+
+/// Erase every element equal to @p value; returns the number removed.
+template <typename T, std::size_t N, typename U>
+std::size_t erase(SmallVector<T, N>& vec, const U& value) {
+    auto* newEnd = std::remove(vec.begin(), vec.end(), value);
+    const auto removed = static_cast<std::size_t>(vec.end() - newEnd);
+    vec.erase(newEnd, vec.end());
+    return removed;
+}
+
+/// Erase every element satisfying @p pred; returns the number removed.
+template <typename T, std::size_t N, typename Pred>
+std::size_t erase_if(SmallVector<T, N>& vec, Pred pred) {
+    auto* newEnd = std::remove_if(vec.begin(), vec.end(), pred);
+    const auto removed = static_cast<std::size_t>(vec.end() - newEnd);
+    vec.erase(newEnd, vec.end());
+    return removed;
+}
+
+}  // namespace cgs::ecs
@@ -0,0 +1,395 @@
+#pragma once
+
+/// @file soa_component_storage.hpp
+/// @brief Structure-of-arrays component storage driven by SerializableTraits.
+///
+/// SoAComponentStorage<T> stores each field that T registers through
+/// CGS_SERIALIZABLE in its own packed column.  Systems that only touch a
+/// few fields of a hot component (e.g. position and velocity) then stream
+/// exactly those columns instead of pulling whole structs through the
+/// cache, and loops over a single column are trivially auto-vectorizable.
+///
+/// Element access goes through SoAComponentStorage<T>::Ref, a lightweight
+/// proxy (storage pointer + row) that exposes each field by reference.
+/// Wrapping an include type in SoA<T> makes Query hand out these proxies:
+///
+/// @code
+///   CGS_SERIALIZABLE(Particle, 1,
+///       field("position", &Particle::position),
+///       field("velocity", &Particle::velocity));
+///
+///   SoAComponentStorage<Particle> particles;
+///   Query<SoA<Particle>> query(particles);
+///   query.ForEach([dt](Entity, SoAComponentStorage<Particle>::Ref p) {
+///       p[&Particle::position] += p[&Particle::velocity] * dt;
+///   });
+/// @endcode
+///
+/// Members that T does not register are not stored; Load() leaves them
+/// value-initialized.
+///
+/// @see docs/advanced/ECS_DEEP_DIVE.md  Section 6.6
+
+#include "cgs/ecs/change_version.hpp"
+#include "cgs/ecs/component_storage.hpp"
+#include "cgs/ecs/component_type_id.hpp"
+#include "cgs/ecs/entity.hpp"
+#include "cgs/ecs/prefetch.hpp"
+#include "cgs/ecs/sparse_page_table.hpp"
+#include "cgs/foundation/game_serializer.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace cgs::ecs {
+
+/// Query include wrapper selecting the structure-of-arrays layout of @p T.
+///
+/// `Query<SoA<Transform>, Stats>` expects a `SoAComponentStorage<Transform>`
+/// for the first include and yields a `SoAComponentStorage<Transform>::Ref`.
+template <typename T>
+struct SoA {};
+
+namespace detail {
+
+/// Map a FieldDescriptor tuple to the matching tuple of column vectors.
+template <typename Tuple>
+struct SoAColumns;
+
+template <typename T, typename... Ms>
+struct SoAColumns<std::tuple<cgs::foundation::FieldDescriptor<T, Ms>...>> {
+    static_assert((!std::is_same_v<Ms, bool> && ...),
+                  "bool fields cannot be stored column-wise (std::vector<bool> is not "
+                  "addressable); use uint8_t instead");
+    using type = std::tuple<std::vector<Ms>...>;
+};
+
+}  // namespace detail
+
+/// Sparse-set storage whose dense side is split into one column per field.
+///
+/// Memory layout:
+/// @code
+///   sparse_   [entity.id] -> dense index  (paged)
+///   columns_  <field i>[index] -> value of field i
+///   entities_ [index]     -> entity.id that owns the row
+///   versions_ [index]     -> change counter for the row
+///   added_    [index]     -> version at which the row was added
+/// @endcode
+///
+/// Semantics (swap-with-last removal, version counters) match
+/// ComponentStorage<T> so the two are interchangeable behind a Query.
+///
+/// @tparam T  Component type registered with CGS_SERIALIZABLE.
+template <typename T>
+class SoAComponentStorage final : public IComponentStorage {
+    static_assert(cgs::foundation::detail::is_serializable_v<T>,
+                  "SoAComponentStorage requires a type registered with CGS_SERIALIZABLE");
+    static_assert(std::is_default_constructible_v<T>,
+                  "SoAComponentStorage requires a default-constructible component type");
+
+    using Traits = cgs::foundation::SerializableTraits<T>;
+    using Fields = decltype(Traits::fields());
+    using Columns = typename detail::SoAColumns<Fields>::type;
+
+    static constexpr std::size_t kFieldCount = std::tuple_size_v<Fields>;
+    static constexpr std::size_t kNoField = kFieldCount;
+
+    /// True when field @p I of T's descriptor tuple points at @p Member.
+    template <std::size_t I, auto Member>
+    static constexpr bool fieldMatches() {
+        constexpr auto descriptor = std::get<I>(Traits::fields());
+        if constexpr (std::is_same_v<decltype(descriptor.pointer), decltype(Member)>) {
+            return descriptor.pointer == Member;
+        } else {
+            return false;
+        }
+    }
+
+    /// Column index of the field registered for @p Member.
+    template <auto Member>
+    static constexpr std::size_t kFieldIndex = []<std::size_t... Is>(std::index_sequence<Is...>) {
+        std::size_t result = kNoField;
+        ((fieldMatches<Is, Member>() ? (result = Is, true) : false) || ...);
+        return result;
+    }(std::make_index_sequence<kFieldCount>{});
+
+    template <auto Member>
+    using FieldType = typename std::tuple_element_t<kFieldIndex<Member>, Columns>::value_type;
+
+public:
+    using value_type = T;
+
+    /// Proxy reference to one row of the storage.
+    ///
+    /// Cheap to copy; valid until the storage is structurally modified
+    /// (Add / Remove / Clear).
+    class Ref {
+    public:
+        Ref(SoAComponentStorage* storage, uint32_t row) noexcept : storage_(storage), row_(row) {}
+
+        /// Access the field registered for @p Member (resolved at compile time).
+        template <auto Member>
+        [[nodiscard]] FieldType<Member>& Get() const noexcept {
+            static_assert(kFieldIndex<Member> != kNoField,
+                          "Member is not registered in SerializableTraits");
+            return std::get<kFieldIndex<Member>>(storage_->columns_)[row_];
+        }
+
+        /// Access a field by pointer-to-member, e.g. `ref[&T::position]`.
+        template <typename M>
+        [[nodiscard]] M& operator[](M T::* member) const noexcept {
+            M* result = nullptr;
+            [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                constexpr Fields fields = Traits::fields();
+                (visitField<Is>(fields, member, result), ...);
+            }(std::make_index_sequence<kFieldCount>{});
+            assert(result != nullptr && "Member is not registered in SerializableTraits");
+            return *result;
+        }
+
+        /// Materialize the row as a value of @p T.
+        [[nodiscard]] T Load() const { return storage_->loadRow(row_); }
+
+        /// Scatter @p value into the row's columns.
+        void Store(const T& value) const { storage_->storeRow(row_, value); }
+
+        /// Dense row index of this element.
+        [[nodiscard]] uint32_t Row() const noexcept { return row_; }
+
+    private:
+        template <std::size_t I, typename M>
+        void visitField(const Fields& fields, M T::* member, M*& result) const noexcept {
+            using Column = std::tuple_element_t<I, Columns>;
+            if constexpr (std::is_same_v<typename Column::value_type, M>) {
+                if (result == nullptr && std::get<I>(fields).pointer == member) {
+                    result = &std::get<I>(storage_->columns_)[row_];
+                }
+            }
+        }
+
+        SoAComponentStorage* storage_;
+        uint32_t row_;
+    };
+
+    // ── Capacity ────────────────────────────────────────────────────────
+
+    /// Number of stored components.
+    [[nodiscard]] std::size_t Size() const override { return entities_.size(); }
+
+    /// True when no components are stored.
+    [[nodiscard]] bool Empty() const noexcept { return entities_.empty(); }
+
+    /// Number of columns (registered fields).
+    [[nodiscard]] static constexpr std::size_t FieldCount() noexcept { return kFieldCount; }
+
+    // ── CRUD ────────────────────────────────────────────────────────────
+
+    /// Add a component for @p entity, scattering @p value into the columns.
+    /// @pre `!Has(entity)`.
+    Ref Add(Entity entity, const T& value = T{}) {
+        assert(entity.isValid() && "Cannot add component to invalid entity");
+        assert(!Has(entity) && "Entity already has this component");
+
+        const auto idx = static_cast<uint32_t>(entities_.size());
+        sparse_.Set(entity.id(), idx);
+
+        forEachColumn([&](auto& column, const auto& descriptor) {
+            column.push_back(value.*(descriptor.pointer));
+        });
+        entities_.push_back(entity.id());
+        globalVersion_ = NextChangeVersion();
+        versions_.push_back(globalVersion_);
+        added_.push_back(globalVersion_);
+
+        return Ref(this, idx);
+    }
+
+    /// Proxy to the component owned by @p entity.
+    /// @pre `Has(entity)`.
+    [[nodiscard]] Ref Get(Entity entity) {
+        assert(Has(entity) && "Entity does not have this component");
+        return Ref(this, sparse_.Get(entity.id()));
+    }
+
+    /// Materialize the component owned by @p entity as a value.
+    /// @pre `Has(entity)`.
+    [[nodiscard]] T Load(Entity entity) const {
+        assert(Has(entity) && "Entity does not have this component");
+        return loadRow(sparse_.Get(entity.id()));
+    }
+
+    /// Replace the component for @p entity and bump its version.
+    /// @pre `Has(entity)`.
+    void Replace(Entity entity, const T& component) {
+        assert(Has(entity) && "Entity does not have this component");
+        const auto idx = sparse_.Get(entity.id());
+        storeRow(idx, component);
+        globalVersion_ = NextChangeVersion();
+        versions_[idx] = globalVersion_;
+    }
+
+    /// Check whether @p entity has a component in this storage.
+    [[nodiscard]] bool Has(Entity entity) const override { return sparse_.Contains(entity.id()); }
+
+    /// Start loading @p entity's sparse slot into cache (see
+    /// ComponentStorage::PrefetchIndex()).
+    void PrefetchIndex(Entity entity) const noexcept { sparse_.Prefetch(entity.id()); }
+
+    /// Start loading @p entity's row of every column into cache.
+    void PrefetchComponent(Entity entity) const noexcept {
+        const uint32_t idx = sparse_.Get(entity.id());
+        if (idx < entities_.size()) {
+            std::apply([&](const auto&... column) { (PrefetchForRead(column.data() + idx), ...); },
+                       columns_);
+        }
+    }
+
+    /// Remove the component owned by @p entity (no-op when absent).
+    void Remove(Entity entity) override {
+        if (!Has(entity)) {
+            return;
+        }
+
+        const auto idx = sparse_.Get(entity.id());
+        const auto lastIdx = static_cast<uint32_t>(entities_.size() - 1);
+
+        if (idx != lastIdx) {
+            forEachColumn(
+                [&](auto& column, const auto&) { column[idx] = std::move(column[lastIdx]); });
+            entities_[idx] = entities_[lastIdx];
+            versions_[idx] = versions_[lastIdx];
+            added_[idx] = added_[lastIdx];
+            sparse_.Update(entities_[idx], idx);
+        }
+
+        forEachColumn([](auto& column, const auto&) { column.pop_back(); });
+        entities_.pop_back();
+        versions_.pop_back();
+        added_.pop_back();
+        sparse_.Reset(entity.id());
+
+        globalVersion_ = NextChangeVersion();
+    }
+
+    /// Remove all components.
+    void Clear() override {
+        forEachColumn([](auto& column, const auto&) { column.clear(); });
+        entities_.clear();
+        versions_.clear();
+        added_.clear();
+        sparse_.Clear();
+        globalVersion_ = NextChangeVersion();
+    }
+
+    // ── Column access ───────────────────────────────────────────────────
+
+    /// Packed column for the field registered for @p Member.
+    ///
+    /// Writing through the span does not bump versions; call MarkChanged()
+    /// or MarkAllChanged() afterwards if change detection matters.
+    template <auto Member>
+    [[nodiscard]] std::span<FieldType<Member>> Column() noexcept {
+        static_assert(kFieldIndex<Member> != kNoField,
+                      "Member is not registered in SerializableTraits");
+        return std::get<kFieldIndex<Member>>(columns_);
+    }
+
+    /// Read-only packed column for the field registered for @p Member.
+    template <auto Member>
+    [[nodiscard]] std::span<const FieldType<Member>> Column() const noexcept {
+        static_assert(kFieldIndex<Member> != kNoField,
+                      "Member is not registered in SerializableTraits");
+        return std::get<kFieldIndex<Member>>(columns_);
+    }
+
+    /// Return the entity id that owns the row at @p index.
+    [[nodiscard]] uint32_t EntityAt(std::size_t index) const override {
+        assert(index < entities_.size());
+        return entities_[index];
+    }
+
+    // ── Version / change detection ──────────────────────────────────────
+
+    /// Return the storage's global modification version counter.
+    [[nodiscard]] uint32_t Version() const noexcept override { return globalVersion_; }
+
+    /// Explicitly mark the component for @p entity as changed.
+    void MarkChanged(Entity entity) {
+        assert(Has(entity) && "Entity does not have this component");
+        globalVersion_ = NextChangeVersion();
+        versions_[sparse_.Get(entity.id())] = globalVersion_;
+    }
+
+    /// Mark every row as changed (after bulk writes through Column()).
+    void MarkAllChanged() {
+        globalVersion_ = NextChangeVersion();
+        std::fill(versions_.begin(), versions_.end(), globalVersion_);
+    }
+
+    /// Return the version counter for the component owned by @p entity.
+    [[nodiscard]] uint32_t GetVersion(Entity entity) const {
+        assert(Has(entity) && "Entity does not have this component");
+        return versions_[sparse_.Get(entity.id())];
+    }
+
+    /// True when the component's version is newer than @p sinceVersion.
+    [[nodiscard]] bool HasChanged(Entity entity, uint32_t sinceVersion) const {
+        return IsNewerVersion(GetVersion(entity), sinceVersion);
+    }
+
+    /// True when the component was added after @p sinceVersion.
+    [[nodiscard]] bool WasAdded(Entity entity, uint32_t sinceVersion) const {
+        assert(Has(entity) && "Entity does not have this component");
+        return IsNewerVersion(added_[sparse_.Get(entity.id())], sinceVersion);
+    }
+
+    /// The current global version counter.
+    [[nodiscard]] uint32_t GlobalVersion() const noexcept { return globalVersion_; }
+
+    // ── Type ID ─────────────────────────────────────────────────────────
+
+    /// The type ID of the stored component type.
+    [[nodiscard]] static ComponentTypeId TypeId() noexcept { return ComponentType<T>::Id(); }
+
+private:
+    /// Invoke @p func(column, descriptor) for every registered field.
+    template <typename Func>
+    void forEachColumn(Func&& func) {
+        [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            constexpr Fields fields = Traits::fields();
+            (func(std::get<Is>(columns_), std::get<Is>(fields)), ...);
+        }(std::make_index_sequence<kFieldCount>{});
+    }
+
+    [[nodiscard]] T loadRow(uint32_t row) const {
+        T value{};
+        [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            constexpr Fields fields = Traits::fields();
+            ((value.*(std::get<Is>(fields).pointer) = std::get<Is>(columns_)[row]), ...);
+        }(std::make_index_sequence<kFieldCount>{});
+        return value;
+    }
+
+    void storeRow(uint32_t row, const T& value) {
+        forEachColumn([&](auto& column, const auto& descriptor) {
+            column[row] = value.*(descriptor.pointer);
+        });
+    }
+
+    Columns columns_;                 ///< One packed column per field.
+    std::vector<uint32_t> entities_;  ///< dense index -> entity id.
+    SparsePageTable sparse_;          ///< entity id  -> dense index.
+    std::vector<uint32_t> versions_;  ///< dense index -> change version.
+    std::vector<uint32_t> added_;     ///< dense index -> add version.
+    uint32_t globalVersion_ = 0;      ///< Last version drawn by this storage.
+};
+
+}  // namespace cgs::ecs
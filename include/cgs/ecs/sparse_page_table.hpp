@@ -0,0 +1,188 @@
+#pragma once
+
+/// @file sparse_page_table.hpp
+/// @brief Paged entity-id -> dense-index table for sparse-set storages.
+///
+/// A flat sparse array costs one slot per entity id up to the highest id
+/// ever seen, so a rare component attached to a single late entity still
+/// pays for ~16M slots.  SparsePageTable splits the id space into fixed
+/// pages that are allocated only when a slot in them is written and
+/// released again when their last slot is cleared.  Unallocated pages all
+/// point at one shared, read-only page filled with kInvalidIndex, so a
+/// lookup is two loads and no branch on page presence.
+///
+/// The page directory itself is flat: 12 bytes per 1024 ids up to the
+/// highest id seen (~200 KB for the compact 24-bit id space).  With
+/// CGS_WIDE_ENTITY it grows past that only as EntityManager hands out
+/// higher ids, i.e. at about 1% of the entity table's own size.
+///
+/// @see docs/advanced/ECS_DEEP_DIVE.md  Section 6.5
+
+#include "cgs/ecs/prefetch.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace cgs::ecs {
+
+/// Lazily paged mapping from entity id to a 32-bit dense index.
+class SparsePageTable {
+public:
+    /// Value stored for ids that have no mapping.
+    static constexpr uint32_t kInvalidIndex = std::numeric_limits<uint32_t>::max();
+
+    /// log2 of entries per page (1024 entries = 4 KB pages).
+    static constexpr uint32_t kPageBits = 10;
+    static constexpr uint32_t kPageSize = 1u << kPageBits;
+    static constexpr uint32_t kPageMask = kPageSize - 1;
+
+    SparsePageTable() = default;
+    ~SparsePageTable() { releaseAll(); }
+
+    // Non-copyable, movable.
+    SparsePageTable(const SparsePageTable&) = delete;
+    SparsePageTable& operator=(const SparsePageTable&) = delete;
+    SparsePageTable(SparsePageTable&& other) noexcept
+        : pages_(std::move(other.pages_)),
+          liveCounts_(std::move(other.liveCounts_)),
+          allocatedPages_(std::exchange(other.allocatedPages_, 0)) {}
+    SparsePageTable& operator=(SparsePageTable&& other) noexcept {
+        if (this != &other) {
+            releaseAll();
+            pages_ = std::move(other.pages_);
+            liveCounts_ = std::move(other.liveCounts_);
+            allocatedPages_ = std::exchange(other.allocatedPages_, 0);
+        }
+        return *this;
+    }
+
+    /// Return the index mapped to @p id, or kInvalidIndex.
+    [[nodiscard]] uint32_t Get(uint32_t id) const noexcept {
+        const uint32_t page = id >> kPageBits;
+        if (page >= pages_.size()) {
+            return kInvalidIndex;
+        }
+        return pages_[page][id & kPageMask];
+    }
+
+    /// Start loading the slot of @p id into cache (see PrefetchForRead()).
+    void Prefetch(uint32_t id) const noexcept {
+        const uint32_t page = id >> kPageBits;
+        if (page < pages_.size()) {
+            PrefetchForRead(pages_[page] + (id & kPageMask));
+        }
+    }
+
+    /// True when @p id has a mapping.
+    [[nodiscard]] bool Contains(uint32_t id) const noexcept { return Get(id) != kInvalidIndex; }
+
+    /// Map @p id to @p index, allocating the page on first write.
+    void Set(uint32_t id, uint32_t index) {
+        assert(index != kInvalidIndex && "Use Reset() to clear a mapping");
+        uint32_t* slots = ownPage(id >> kPageBits);
+        uint32_t& slot = slots[id & kPageMask];
+        if (slot == kInvalidIndex) {
+            ++liveCounts_[id >> kPageBits];
+        }
+        slot = index;
+    }
+
+    /// Overwrite the mapping of an @p id that is already present.
+    ///
+    /// Cheaper than Set() because the page is known to be owned.
+    void Update(uint32_t id, uint32_t index) noexcept {
+        assert(Contains(id) && "Update() requires an existing mapping");
+        mutablePage(id >> kPageBits)[id & kPageMask] = index;
+    }
+
+    /// Clear the mapping for @p id, releasing its page if it becomes empty.
+    void Reset(uint32_t id) noexcept {
+        const uint32_t page = id >> kPageBits;
+        if (page >= pages_.size() || pages_[page][id & kPageMask] == kInvalidIndex) {
+            return;
+        }
+        mutablePage(page)[id & kPageMask] = kInvalidIndex;
+        if (--liveCounts_[page] == 0) {
+            releasePage(page);
+        }
+    }
+
+    /// Drop every mapping and release all pages.
+    void Clear() noexcept {
+        releaseAll();
+        pages_.clear();
+        liveCounts_.clear();
+    }
+
+    // ── Memory accounting ───────────────────────────────────────────────
+
+    /// Number of pages currently backed by their own allocation.
+    [[nodiscard]] std::size_t AllocatedPages() const noexcept { return allocatedPages_; }
+
+    /// Approximate heap bytes held by the table (pages + page directory).
+    [[nodiscard]] std::size_t MemoryUsage() const noexcept {
+        return allocatedPages_ * kPageSize * sizeof(uint32_t) +
+               pages_.capacity() * sizeof(const uint32_t*) +
+               liveCounts_.capacity() * sizeof(uint32_t);
+    }
+
+private:
+    /// The shared all-invalid page every unallocated slot points at.
+    [[nodiscard]] static const uint32_t* invalidPage() noexcept {
+        static const std::array<uint32_t, kPageSize> page = [] {
+            std::array<uint32_t, kPageSize> p{};
+            p.fill(kInvalidIndex);
+            return p;
+        }();
+        return page.data();
+    }
+
+    /// Writable slots of an owned page.
+    [[nodiscard]] uint32_t* mutablePage(uint32_t page) noexcept {
+        assert(pages_[page] != invalidPage() && "Page is not allocated");
+        // Owned pages were allocated non-const in ownPage().
+        return const_cast<uint32_t*>(pages_[page]);
+    }
+
+    /// Ensure @p page has its own allocation and return its slots.
+    uint32_t* ownPage(uint32_t page) {
+        if (page >= pages_.size()) {
+            pages_.resize(static_cast<std::size_t>(page) + 1, invalidPage());
+            liveCounts_.resize(static_cast<std::size_t>(page) + 1, 0);
+        }
+        if (pages_[page] == invalidPage()) {
+            auto* fresh = new uint32_t[kPageSize];
+            std::fill(fresh, fresh + kPageSize, kInvalidIndex);
+            pages_[page] = fresh;
+            ++allocatedPages_;
+        }
+        return mutablePage(page);
+    }
+
+    void releasePage(uint32_t page) noexcept {
+        delete[] mutablePage(page);
+        pages_[page] = invalidPage();
+        --allocatedPages_;
+    }
+
+    void releaseAll() noexcept {
+        for (std::size_t p = 0; p < pages_.size(); ++p) {
+            if (pages_[p] != invalidPage()) {
+                releasePage(static_cast<uint32_t>(p));
+            }
+            liveCounts_[p] = 0;
+        }
+    }
+
+    std::vector<const uint32_t*> pages_;  ///< Page directory.
+    std::vector<uint32_t> liveCounts_;    ///< Live slots per page.
+    std::size_t allocatedPages_ = 0;      ///< Pages with their own storage.
+};
+
+}  // namespace cgs::ecs
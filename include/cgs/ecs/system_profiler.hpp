@@ -0,0 +1,173 @@
+#pragma once
+
+/// @file system_profiler.hpp
+/// @brief Per-system tick timing recorded into per-thread ring buffers,
+///        with Chrome trace (Perfetto) export.
+///
+/// SystemScheduler records one event per tick, stage, parallel batch and
+/// system run when a SystemProfiler is attached.  Each recording thread
+/// owns a fixed-size ring: a record is two steady_clock reads plus one
+/// slot write and a release store, with no locks or allocation, so the
+/// profiler can stay attached in production.  Old events are overwritten
+/// once a ring wraps.
+///
+/// System events also carry the heap allocations the system made on its
+/// own thread, when the AllocTracker hooks are linked (zero otherwise).
+///
+/// Reading (Events(), ChromeTraceJson(), SystemStats()) is meant to run
+/// between ticks, e.g. from the GameLoop metrics callback.  A read that
+/// overlaps recording may see a partially overwritten oldest event.
+///
+/// @see docs/advanced/ECS_DEEP_DIVE.md  Section 6.11
+
+#include "cgs/ecs/system_scheduler.hpp"
+#include "cgs/foundation/alloc_tracker.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace cgs::ecs {
+
+/// What a ProfileEvent measures.
+enum class ProfileScope : uint8_t {
+    Tick,   ///< One SystemScheduler::Execute() call.
+    Stage,  ///< One stage (id = SystemStage value).
+    Batch,  ///< One parallel batch (id = batch index in its stage).
+    System  ///< One system run (id = SystemTypeId).
+};
+
+/// A timed span recorded by the scheduler.
+struct ProfileEvent {
+    ProfileScope scope = ProfileScope::System;
+    uint32_t id = 0;
+    uint64_t tick = 0;     ///< Tick number the span belongs to.
+    int64_t startNs = 0;   ///< Nanoseconds since the profiler was created.
+    int64_t endNs = 0;
+    uint32_t thread = 0;   ///< Profiler-local index of the recording thread.
+    uint32_t allocations = 0;     ///< Heap allocations in the span (System only).
+    uint64_t allocatedBytes = 0;  ///< Bytes those allocations requested.
+};
+
+/// Duration percentiles of one system over the inspected ticks.
+struct SystemTimingStats {
+    SystemTypeId system = kInvalidSystemTypeId;
+    std::string name;
+    std::size_t samples = 0;
+    double p50Ms = 0.0;
+    double p99Ms = 0.0;
+    double maxMs = 0.0;
+    uint64_t allocations = 0;     ///< Heap allocations over all samples.
+    uint64_t maxAllocations = 0;  ///< Most allocations in one run.
+};
+
+/// Lock-free per-thread recorder of scheduler timings.
+class SystemProfiler {
+public:
+    /// Default ring size per recording thread.
+    static constexpr std::size_t kDefaultEventsPerThread = 8192;
+
+    explicit SystemProfiler(std::size_t eventsPerThread = kDefaultEventsPerThread);
+
+    // Non-copyable, non-movable (threads cache pointers to their rings).
+    SystemProfiler(const SystemProfiler&) = delete;
+    SystemProfiler& operator=(const SystemProfiler&) = delete;
+    SystemProfiler(SystemProfiler&&) = delete;
+    SystemProfiler& operator=(SystemProfiler&&) = delete;
+
+    // ── Control ─────────────────────────────────────────────────────────
+
+    /// Pause or resume recording (enabled by default).
+    void SetEnabled(bool enabled) noexcept { enabled_.store(enabled, std::memory_order_relaxed); }
+
+    [[nodiscard]] bool IsEnabled() const noexcept {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    // ── Recording (called by SystemScheduler) ───────────────────────────
+
+    /// Start a new tick and return its number (first tick is 1).
+    ///
+    /// Events recorded afterwards belong to the new tick.
+    uint64_t BeginTick() noexcept { return tick_.fetch_add(1, std::memory_order_relaxed) + 1; }
+
+    /// Nanoseconds since the profiler was created.
+    [[nodiscard]] int64_t Now() const noexcept;
+
+    /// Record a span on the calling thread's ring, with the heap
+    /// allocations @p allocs made during it.
+    ///
+    /// The first call on a thread registers its ring (one allocation);
+    /// later calls neither lock nor allocate.
+    void Record(ProfileScope scope,
+                uint32_t id,
+                int64_t startNs,
+                int64_t endNs,
+                cgs::foundation::AllocCounts allocs = {});
+
+    /// Remember the display name of @p system for exports.
+    void SetSystemName(SystemTypeId system, std::string_view name);
+
+    // ── Reading (between ticks) ─────────────────────────────────────────
+
+    /// Number of the most recently started tick (0 before the first).
+    [[nodiscard]] uint64_t CurrentTick() const noexcept {
+        return tick_.load(std::memory_order_relaxed);
+    }
+
+    /// Events of the last @p lastTicks ticks still held in the rings,
+    /// ordered by start time.
+    [[nodiscard]] std::vector<ProfileEvent> Events(std::size_t lastTicks) const;
+
+    /// Chrome trace JSON ("Trace Event Format") for the last @p lastTicks
+    /// ticks; loads in chrome://tracing and ui.perfetto.dev.
+    [[nodiscard]] std::string ChromeTraceJson(std::size_t lastTicks) const;
+
+    /// Per-system p50/p99/max over the last @p lastTicks ticks, slowest
+    /// p99 first.
+    [[nodiscard]] std::vector<SystemTimingStats> SystemStats(std::size_t lastTicks) const;
+
+    /// Display name registered for @p system ("system <id>" if unknown).
+    [[nodiscard]] std::string SystemName(SystemTypeId system) const;
+
+private:
+    /// Single-producer ring owned by one recording thread.
+    struct Ring {
+        Ring(std::size_t capacity, uint32_t threadIndex, std::thread::id owner)
+            : events(std::make_unique<ProfileEvent[]>(capacity)),
+              capacity(capacity),
+              thread(threadIndex),
+              owner(owner) {}
+
+        std::unique_ptr<ProfileEvent[]> events;
+        std::size_t capacity;
+        uint32_t thread;
+        std::thread::id owner;
+        std::atomic<uint64_t> head{0};  ///< Total events ever written.
+    };
+
+    [[nodiscard]] Ring& localRing();
+
+    [[nodiscard]] std::string eventName(const ProfileEvent& event) const;
+
+    const uint64_t instanceId_;
+    const std::size_t eventsPerThread_;
+    const std::chrono::steady_clock::time_point origin_;
+
+    std::atomic<bool> enabled_{true};
+    std::atomic<uint64_t> tick_{0};
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<Ring>> rings_;
+    std::unordered_map<SystemTypeId, std::string> names_;
+};
+
+}  // namespace cgs::ecs
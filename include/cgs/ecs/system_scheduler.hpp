@@ -12,25 +12,65 @@
 /// Parallel execution: systems that declare non-conflicting component
 /// access patterns (via `Read<T>`/`Write<T>`) are automatically grouped
 /// into parallel batches.  A user-provided ParallelExecutor dispatches
-/// these batches to a thread pool.
+/// these batches to a thread pool; the built-in WorkStealingExecutor
+/// does so without per-batch allocation.
+///
+/// Graph mode (ParallelMode::Graph) replaces the batch barriers with a
+/// per-stage dependency graph: each system starts as soon as the systems
+/// it conflicts with or depends on have finished.
+///
+/// Structural changes: systems record entity creation/destruction and
+/// component adds/removes into a CommandBufferSet, which the scheduler
+/// plays back after every parallel batch (or after every system when
+/// running sequentially).
+///
+/// Events: systems exchange one-shot events through EventChannels
+/// declared with EventRead/EventWrite; the scheduler publishes each
+/// channel at the boundary before every stage that reads it.
+///
+/// Update rates: a system can run every N executions of its stage
+/// (SetUpdateInterval) or process 1/k of its entities per run
+/// (SetUpdateSlices).  Decimated systems get automatic phase offsets so
+/// their runs spread over ticks, and always receive the time accumulated
+/// since their previous run.
+///
+/// Frame memory: every system can allocate tick-scoped temporaries from
+/// ISystem::FrameMemory(), a per-thread arena the scheduler resets when
+/// Execute() returns.
+///
+/// Profiling: an attached SystemProfiler receives the duration of every
+/// tick, stage, batch and system run for Chrome trace export and
+/// per-system percentiles.
 ///
 /// @see docs/reference/ECS_DESIGN.md  Section 3
 /// @see SDS-MOD-012
 
+#include "cgs/ecs/change_version.hpp"
+#include "cgs/ecs/command_buffer.hpp"
+#include "cgs/ecs/component_mask.hpp"
 #include "cgs/ecs/component_type_id.hpp"
+#include "cgs/ecs/event_channel.hpp"
+#include "cgs/ecs/frame_arena.hpp"
+#include "cgs/ecs/work_stealing_executor.hpp"
+#include "cgs/foundation/alloc_tracker.hpp"
 
 #include <cassert>
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <memory_resource>
 #include <string>
 #include <string_view>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace cgs::ecs {
 
+class SystemProfiler;
+
 // ── System type identification ──────────────────────────────────────────
 
 /// Integer type used to identify system types at runtime.
@@ -74,6 +114,12 @@ enum class SystemStage : uint8_t {
     FixedUpdate  ///< Fixed-timestep update (physics, etc.)
 };
 
+/// How parallel execution orders the systems of a stage.
+enum class ParallelMode : uint8_t {
+    Batches,  ///< Barrier after every ParallelBatch (default).
+    Graph     ///< Each system starts once its graph predecessors finish.
+};
+
 // ── Component access patterns ──────────────────────────────────────────
 
 /// Describes which component types a system reads and writes.
@@ -81,20 +127,52 @@ enum class SystemStage : uint8_t {
 /// Used by the scheduler to determine which systems can safely execute
 /// in parallel.  If both `reads` and `writes` are empty the system is
 /// treated as having undeclared access and will never be parallelized.
+///
+/// Event channels are declared separately (`eventReads`/`eventWrites`).
+/// They never conflict, because readers and writers touch different
+/// sides of a double-buffered channel, but they tell the scheduler which
+/// stages need a channel published and count as declared access.
+///
+/// All sets are fixed-width ComponentMasks, so the struct is trivially
+/// copyable and ConflictsWith() is a few word-wise ANDs.
 struct SystemAccessInfo {
-    std::unordered_set<ComponentTypeId> reads;
-    std::unordered_set<ComponentTypeId> writes;
+    ComponentMask reads;
+    ComponentMask writes;
+    ComponentMask eventReads;   ///< EventChannel types consumed.
+    ComponentMask eventWrites;  ///< EventChannel types produced.
+
+    /// True when neither component nor event access is declared.
+    [[nodiscard]] constexpr bool IsUndeclared() const noexcept {
+        return reads.empty() && writes.empty() && eventReads.empty() && eventWrites.empty();
+    }
 
     /// Check whether this access pattern conflicts with @p other.
     ///
     /// Two systems conflict when they have write-write or read-write
     /// overlap on the same component type, or when either system has
     /// undeclared access (empty reads AND writes).
-    [[nodiscard]] bool ConflictsWith(const SystemAccessInfo& other) const;
+    [[nodiscard]] constexpr bool ConflictsWith(const SystemAccessInfo& other) const noexcept {
+        if (IsUndeclared() || other.IsUndeclared()) {
+            return true;
+        }
+        return writes.Intersects(other.writes | other.reads) || reads.Intersects(other.writes);
+    }
+
+    /// Union with @p other (e.g. the combined access of a batch).
+    constexpr SystemAccessInfo& operator|=(const SystemAccessInfo& other) noexcept {
+        reads |= other.reads;
+        writes |= other.writes;
+        eventReads |= other.eventReads;
+        eventWrites |= other.eventWrites;
+        return *this;
+    }
 };
 
 /// Compile-time helper to declare read access to component types.
 ///
+/// The mask for each `Read<...>` pack is built on first use and cached,
+/// so Apply() is a plain bitwise OR.
+///
 /// @code
 ///   SystemAccessInfo GetAccessInfo() const override {
 ///       SystemAccessInfo info;
@@ -104,16 +182,62 @@ struct SystemAccessInfo {
 /// @endcode
 template <typename... Ts>
 struct Read {
-    static void Apply(SystemAccessInfo& info) {
-        ((info.reads.insert(ComponentType<Ts>::Id())), ...);
+    /// Bits of every component type in the pack.
+    [[nodiscard]] static const ComponentMask& Mask() noexcept {
+        static const ComponentMask mask = [] {
+            ComponentMask bits;
+            (bits.insert(ComponentType<Ts>::Id()), ...);
+            return bits;
+        }();
+        return mask;
     }
+
+    static void Apply(SystemAccessInfo& info) noexcept { info.reads |= Mask(); }
 };
 
 /// Compile-time helper to declare write access to component types.
 template <typename... Ts>
 struct Write {
-    static void Apply(SystemAccessInfo& info) {
-        ((info.writes.insert(ComponentType<Ts>::Id())), ...);
+    /// Bits of every component type in the pack.
+    [[nodiscard]] static const ComponentMask& Mask() noexcept {
+        return Read<Ts...>::Mask();
+    }
+
+    static void Apply(SystemAccessInfo& info) noexcept { info.writes |= Mask(); }
+};
+
+/// Declare that a system reads EventChannel<Es>... (see event_channel.hpp).
+template <typename... Es>
+struct EventRead {
+    static void Apply(SystemAccessInfo& info) noexcept { info.eventReads |= Read<Es...>::Mask(); }
+};
+
+/// Declare that a system sends to EventChannel<Es>....
+template <typename... Es>
+struct EventWrite {
+    static void Apply(SystemAccessInfo& info) noexcept {
+        info.eventWrites |= Read<Es...>::Mask();
+    }
+};
+
+// ── Update slicing ──────────────────────────────────────────────────────
+
+/// The share of its entities a sliced system processes in one run (see
+/// SystemScheduler::SetUpdateSlices()).  Unsliced systems get {0, 1}.
+struct UpdateSlice {
+    uint32_t index = 0;  ///< Slice processed by this run.
+    uint32_t count = 1;  ///< Total number of slices.
+
+    /// True when @p entityId belongs to this slice (stable across
+    /// structural changes).
+    [[nodiscard]] constexpr bool Contains(uint32_t entityId) const noexcept {
+        return entityId % count == index;
+    }
+
+    /// Dense rows [first, last) of this slice in a pool of @p size rows.
+    [[nodiscard]] constexpr std::pair<std::size_t, std::size_t> Range(
+        std::size_t size) const noexcept {
+        return {size * index / count, size * (index + 1) / count};
     }
 };
 
@@ -150,6 +274,47 @@ public:
     ///
     /// Default: empty (undeclared — always runs sequentially).
     [[nodiscard]] virtual SystemAccessInfo GetAccessInfo() const { return {}; }
+
+    /// Change-clock value taken when the scheduler last started this
+    /// system, or kAnyVersion before its first scheduled run.
+    ///
+    /// Pass it to Query::Changed()/Added() to visit only entities touched
+    /// since the previous run.  Changes the system made itself during that
+    /// run are included once.  For a sliced system it is the start of the
+    /// current slice's previous run, so changes to entities of the other
+    /// slices are not lost.  Calling Execute() directly (outside a
+    /// SystemScheduler) does not advance it.
+    [[nodiscard]] uint32_t LastRunVersion() const noexcept { return lastRunVersion_; }
+
+    /// Slice of entities to process in the current run; {0, 1} unless
+    /// the scheduler slices this system.
+    [[nodiscard]] UpdateSlice CurrentSlice() const noexcept { return slice_; }
+
+protected:
+    /// Memory resource for temporaries that die with the current tick.
+    ///
+    /// Inside SystemScheduler::Execute() this is the calling thread's
+    /// FrameArena, reset when the tick ends; anything allocated from it
+    /// must not outlive the tick.  Outside a tick (or before the system
+    /// is registered) it is the default pmr resource.
+    ///
+    /// @code
+    ///   std::pmr::vector<Entity> targets(FrameMemory());
+    /// @endcode
+    [[nodiscard]] std::pmr::memory_resource* FrameMemory() const {
+        return frameArenas_ != nullptr ? frameArenas_->Resource()
+                                       : std::pmr::get_default_resource();
+    }
+
+private:
+    friend class SystemScheduler;
+
+    uint32_t lastRunVersion_ = kAnyVersion;
+
+    UpdateSlice slice_;
+
+    /// Owning scheduler's arenas (set on registration).
+    FrameArenaSet* frameArenas_ = nullptr;
 };
 
 // ── System scheduler ────────────────────────────────────────────────────
@@ -222,6 +387,38 @@ public:
     /// Check if a system is enabled.
     [[nodiscard]] bool IsEnabled(SystemTypeId system) const;
 
+    // ── Update rates ────────────────────────────────────────────────
+
+    /// Run @p system only on every @p ticks-th execution of its stage
+    /// (default 1: every tick).  Each run receives the delta time
+    /// accumulated since the previous one.
+    ///
+    /// Build() assigns each decimated system a phase so that systems of
+    /// a stage run on different ticks where possible.  Decimated event
+    /// readers only see the channel batches published on the ticks they
+    /// run.  Invalidates the execution plan.
+    void SetUpdateInterval(SystemTypeId system, uint32_t ticks);
+
+    /// Convenience: set the update interval using system type.
+    template <typename T>
+    void SetUpdateInterval(uint32_t ticks);
+
+    /// Split @p system's work into @p slices processed round-robin, one
+    /// per run (default 1).  The system reads ISystem::CurrentSlice() and
+    /// receives the time accumulated since that slice last ran.
+    void SetUpdateSlices(SystemTypeId system, uint32_t slices);
+
+    /// Convenience: set the slice count using system type.
+    template <typename T>
+    void SetUpdateSlices(uint32_t slices);
+
+    /// Update interval of @p system (1 if not registered).
+    [[nodiscard]] uint32_t GetUpdateInterval(SystemTypeId system) const;
+
+    /// Stage execution, modulo the interval, on which @p system runs
+    /// (assigned by Build(); 0 if not registered).
+    [[nodiscard]] uint32_t GetUpdatePhase(SystemTypeId system) const;
+
     // ── Execution ───────────────────────────────────────────────────
 
     /// Build the execution plan (topological sort per stage).
@@ -266,7 +463,8 @@ public:
     /// Set the executor for parallel system batches.
     ///
     /// If not set (or set to nullptr), systems always run sequentially
-    /// even when parallel execution is enabled.
+    /// even when parallel execution is enabled.  Replaces any executor
+    /// attached with EnableParallelExecution(WorkStealingExecutor&).
     void SetParallelExecutor(ParallelExecutor executor);
 
     /// Enable or disable parallel execution.
@@ -278,22 +476,118 @@ public:
     /// @pre A ParallelExecutor must be set for actual parallelism.
     void EnableParallelExecution(bool enable);
 
+    /// Enable parallel execution on the built-in @p executor.
+    ///
+    /// Batches are dispatched as pre-built task descriptors kept in
+    /// scheduler-owned buffers, so steady-state ticks do not allocate.
+    /// Replaces any std::function executor.  The executor must outlive
+    /// its attachment.
+    void EnableParallelExecution(WorkStealingExecutor& executor);
+
     /// Check whether parallel execution is enabled.
     [[nodiscard]] bool IsParallelExecutionEnabled() const noexcept;
 
+    /// Select batch or graph scheduling for parallel execution.
+    ///
+    /// Takes effect on the next Execute(); Build() always computes both
+    /// the batches and the graph.
+    void SetParallelMode(ParallelMode mode) noexcept;
+
+    /// Current parallel scheduling mode (default: ParallelMode::Batches).
+    [[nodiscard]] ParallelMode GetParallelMode() const noexcept;
+
+    // ── Execution graph ─────────────────────────────────────────────
+
+    /// One system in a stage's execution graph.
+    struct GraphNode {
+        SystemTypeId system = kInvalidSystemTypeId;
+        /// Indices (into the same segment) of nodes that wait for this one.
+        std::vector<std::size_t> successors;
+        /// Number of nodes this one waits for.
+        uint32_t predecessorCount = 0;
+    };
+
+    /// Part of a stage between two sync points.
+    ///
+    /// Nodes are in topological order.  An edge joins two systems when
+    /// one explicitly depends on the other or their access patterns
+    /// conflict; segments run one after another.
+    struct GraphSegment {
+        std::vector<GraphNode> nodes;
+    };
+
+    /// Longest chain of dependent systems measured on the last graph run.
+    struct CriticalPath {
+        std::vector<SystemTypeId> systems;
+        std::chrono::nanoseconds length{0};
+    };
+
+    /// Retrieve the execution graph for a stage (after Build).
+    [[nodiscard]] const std::vector<GraphSegment>& GetExecutionGraph(SystemStage stage) const;
+
+    /// Critical path of the most recent graph-mode run of @p stage.
+    ///
+    /// The length is the sum of the measured durations along the chain
+    /// (across all segments), i.e. the lower bound for the stage's wall
+    /// time regardless of worker count.  Empty until the stage has run
+    /// in graph mode.
+    [[nodiscard]] const CriticalPath& GetCriticalPath(SystemStage stage) const;
+
     // ── Sync points ─────────────────────────────────────────────────
 
     /// Register a sync point after system @p afterSystem.
     ///
     /// Forces a parallel-batch boundary: all systems up to and
     /// including @p afterSystem must complete before any later system
-    /// in the same stage may start.
+    /// in the same stage may start.  Attached command buffers are
+    /// played back at the boundary.
     void AddSyncPoint(SystemTypeId afterSystem);
 
     /// Convenience: register a sync point after system type T.
     template <typename T>
     void AddSyncPoint();
 
+    /// Attach command buffers to play back at batch boundaries.
+    ///
+    /// After each parallel batch completes (after each system when
+    /// running sequentially) the scheduler calls `buffers->Playback()`,
+    /// so commands recorded in one batch are visible to the next.
+    /// Pass nullptr to detach.  The set must outlive its attachment.
+    void SetCommandBuffers(CommandBufferSet* buffers) noexcept;
+
+    // ── Event channels ──────────────────────────────────────────────
+
+    /// Publish @p channel at stage boundaries.
+    ///
+    /// Before each stage runs, every registered channel that one of the
+    /// stage's systems reads (SystemAccessInfo::eventReads) is swapped.
+    /// Channels no registered system reads are swapped when Execute()
+    /// returns, for consumers outside the scheduler.  The channel must
+    /// outlive the scheduler or be removed first.
+    void AddEventChannel(IEventChannel& channel);
+
+    /// Stop publishing @p channel (no-op if it was not added).
+    void RemoveEventChannel(IEventChannel& channel) noexcept;
+
+    // ── Profiling ───────────────────────────────────────────────────
+
+    /// Attach a profiler that records every tick, stage, batch (or graph
+    /// segment) and system run.
+    ///
+    /// System names are registered with the profiler here and on every
+    /// Build().  While detached (nullptr, the default) or disabled with
+    /// SystemProfiler::SetEnabled(false), Execute() reads no clocks.
+    /// The profiler must outlive its attachment.
+    void SetProfiler(SystemProfiler* profiler);
+
+    // ── Frame memory ────────────────────────────────────────────────
+
+    /// Per-thread arenas behind ISystem::FrameMemory().
+    ///
+    /// Active only during Execute(); every arena is reset when Execute()
+    /// returns.
+    [[nodiscard]] FrameArenaSet& GetFrameArenas() noexcept { return *frameArenas_; }
+
     // ── Queries ─────────────────────────────────────────────────────
 
     /// Retrieve a registered system by type.
@@ -319,8 +613,30 @@ private:
         SystemTypeId typeId = kInvalidSystemTypeId;
         SystemStage stage = SystemStage::Update;
         bool enabled = true;
+
+        uint32_t interval = 1;        ///< Stage executions per run.
+        uint32_t phase = 0;           ///< Execution (mod interval) that runs.
+        uint64_t executions = 0;      ///< Stage executions seen so far.
+        uint64_t runs = 0;            ///< Runs so far (picks the slice).
+        std::vector<float> pending = std::vector<float>(1, 0.0f);  ///< Time per slice.
+        /// Start version of each slice's last run (its LastRunVersion()).
+        std::vector<uint32_t> sliceVersions = std::vector<uint32_t>(1, kAnyVersion);
+
+        bool due = false;             ///< Runs in the current stage execution.
+        float runDelta = 0.0f;        ///< Delta passed to the current run.
+        UpdateSlice slice;            ///< Slice of the current run.
+
+        /// AllocTracker tag ("system.<name>") set while the system runs.
+        cgs::foundation::AllocTag allocTag = cgs::foundation::AllocTracker::kUntagged;
     };
 
+    /// Advance every system of @p stage by one execution and decide which
+    /// of them run (SystemEntry::due) and with what delta.
+    void prepareStage(SystemStage stage, float deltaTime);
+
+    /// Assign phases to the decimated systems of @p order.
+    void assignPhases(const std::vector<SystemTypeId>& order);
+
     /// Perform topological sort on systems within a stage.
     ///
     /// @param ids  System type IDs belonging to the stage.
@@ -332,11 +648,56 @@ private:
     /// Execute all systems in a single stage (sequential or parallel).
     void executeStage(SystemStage stage, float deltaTime);
 
-    /// Execute a single parallel batch.
-    void executeBatch(const ParallelBatch& batch, float deltaTime);
+    /// Swap every event channel read during @p stage.
+    void publishEvents(SystemStage stage);
+
+    /// Execute a single parallel batch (@p index within its stage).
+    void executeBatch(const ParallelBatch& batch, std::size_t index);
+
+    /// Run @p entry's system with its prepared delta, slice and the slice's
+    /// LastRunVersion(), then record its start version for that slice,
+    /// timing it on @p profiler when non-null.
+    static void runSystem(SystemEntry& entry, SystemProfiler* profiler);
+
+    /// Context of one WorkStealingExecutor task.
+    struct SystemTask {
+        SystemEntry* entry = nullptr;
+        SystemProfiler* profiler = nullptr;
+    };
+
+    /// WorkStealingExecutor entry point for a SystemTask context.
+    static void runSystemTask(void* context);
+
+    /// Register every system name with profiler_.
+    void registerProfilerNames();
+
+    /// Register an AllocTracker tag for every system.
+    void registerAllocTags();
+
+    /// Play back attached command buffers, if any.
+    void playbackCommands();
+
+    /// Run the execution graph of @p stage segment by segment.
+    void executeGraph(SystemStage stage);
+
+    /// State shared by the workers of one graph segment run.
+    struct GraphRun;
+
+    /// Worker loop pulling ready nodes from @p run until it completes.
+    static void runGraphWorker(void* run);
+
+    /// Access patterns of every system in a stage, queried once per Build().
+    using AccessCache = std::unordered_map<SystemTypeId, SystemAccessInfo>;
 
     /// Compute parallel batches from the topological order.
-    void computeParallelBatches(SystemStage stage, const std::vector<SystemTypeId>& order);
+    void computeParallelBatches(SystemStage stage,
+                                const std::vector<SystemTypeId>& order,
+                                AccessCache& accessCache);
+
+    /// Compute the execution graph from the topological order.
+    void computeExecutionGraph(SystemStage stage,
+                               const std::vector<SystemTypeId>& order,
+                               AccessCache& accessCache);
 
     /// All registered systems, keyed by SystemTypeId.
     std::unordered_map<SystemTypeId, SystemEntry> systems_;
@@ -357,15 +718,53 @@ private:
     /// Parallel batches per stage (populated by Build()).
     std::unordered_map<SystemStage, std::vector<ParallelBatch>> parallelBatches_;
 
+    /// Execution graph per stage (populated by Build()).
+    std::unordered_map<SystemStage, std::vector<GraphSegment>> executionGraph_;
+
+    /// Critical path per stage from the last graph-mode run.
+    std::unordered_map<SystemStage, CriticalPath> criticalPaths_;
+
+    /// Batch or graph scheduling.
+    ParallelMode parallelMode_ = ParallelMode::Batches;
+
     /// Systems marked as sync-point boundaries.
     std::unordered_set<SystemTypeId> syncPoints_;
 
     /// User-provided parallel executor.
     ParallelExecutor parallelExecutor_;
 
+    /// Built-in executor; takes precedence over parallelExecutor_.
+    WorkStealingExecutor* workStealingExecutor_ = nullptr;
+
+    /// Reused per-batch task buffers for workStealingExecutor_.
+    std::vector<SystemTask> systemTasks_;
+    std::vector<WorkStealingExecutor::Task> executorTasks_;
+
     /// Whether parallel execution is enabled.
     bool parallelEnabled_ = false;
 
+    /// Command buffers played back at batch boundaries (not owned).
+    CommandBufferSet* commandBuffers_ = nullptr;
+
+    /// Event channels swapped at stage boundaries (not owned).
+    std::vector<IEventChannel*> eventChannels_;
+
+    /// Union of eventReads per stage (populated by Build()).
+    std::unordered_map<SystemStage, ComponentMask> stageEventReads_;
+
+    /// Union of eventReads over all stages.
+    ComponentMask eventReads_;
+
+    /// Tick-scoped arenas handed to systems (heap-allocated so the
+    /// pointers held by systems survive a scheduler move).
+    std::unique_ptr<FrameArenaSet> frameArenas_ = std::make_unique<FrameArenaSet>();
+
+    /// Attached profiler (not owned).
+    SystemProfiler* profiler_ = nullptr;
+
+    /// profiler_ if it is enabled for the running tick, else nullptr.
+    SystemProfiler* tickProfiler_ = nullptr;
+
     /// Whether Build() has been called successfully.
     bool built_ = false;
 
@@ -383,6 +782,12 @@ private:
 
     /// Empty vector returned for stages with no batches.
     static const std::vector<ParallelBatch> kEmptyBatches_;
+
+    /// Empty graph returned for stages with no systems.
+    static const std::vector<GraphSegment> kEmptyGraph_;
+
+    /// Empty path returned for stages that have not run in graph mode.
+    static const CriticalPath kEmptyCriticalPath_;
 };
 
 // ── Template implementations ────────────────────────────────────────────
@@ -401,6 +806,8 @@ T& SystemScheduler::Register(Args&&... args) {
     auto system = std::make_unique<T>(std::forward<Args>(args)...);
     T& ref = *system;
 
+    ref.frameArenas_ = frameArenas_.get();
+
     SystemEntry entry;
     entry.instance = std::move(system);
     entry.typeId = typeId;
@@ -426,6 +833,16 @@ void SystemScheduler::SetEnabled(bool enabled) {
     SetEnabled(SystemType<T>::Id(), enabled);
 }
 
+template <typename T>
+void SystemScheduler::SetUpdateInterval(uint32_t ticks) {
+    SetUpdateInterval(SystemType<T>::Id(), ticks);
+}
+
+template <typename T>
+void SystemScheduler::SetUpdateSlices(uint32_t slices) {
+    SetUpdateSlices(SystemType<T>::Id(), slices);
+}
+
 template <typename T>
 void SystemScheduler::AddSyncPoint() {
     AddSyncPoint(SystemType<T>::Id());
@@ -0,0 +1,91 @@
+#pragma once
+
+/// @file virtual_region.hpp
+/// @brief Reserved address range committed on demand, optionally backed
+///        by 2 MB huge pages.
+///
+/// Iterating millions of components touches one 4 KB page per few dozen
+/// entities, and the TLB covers only a few thousand pages.  Backing the
+/// big arrays with 2 MB pages cuts the number of translations by 512.
+/// VirtualRegion reserves address space up front and commits it as the
+/// owner grows, so the memory never moves: growth commits the next pages
+/// in place instead of copying into a larger block.
+///
+/// Users: ComponentStorage::ReserveAddressSpace() (dense component data),
+/// ScratchAllocator and FrameArena.  Where a reservation cannot be made
+/// (not a POSIX system, or mmap refuses) the owner keeps its ordinary
+/// heap storage; where huge pages cannot be had, the region uses normal
+/// pages.  Neither is an error.
+///
+/// @see docs/advanced/ECS_DEEP_DIVE.md  Section 6.26
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cgs::ecs {
+
+/// How committed memory of a VirtualRegion is backed.
+enum class PageBacking : uint8_t {
+    Default,      ///< Ordinary pages.
+    Transparent,  ///< Transparent huge pages, requested with madvise().
+    Explicit,     ///< Pre-allocated hugetlb pages; Transparent once they run out.
+};
+
+/// Address space reserved once and committed front to back.
+///
+/// Not thread-safe; owned by one container.
+class VirtualRegion {
+public:
+    /// Huge page size, and the commit granularity of huge-page regions.
+    static constexpr std::size_t kHugePageSize = std::size_t{2} << 20;
+
+    VirtualRegion() noexcept = default;
+    ~VirtualRegion();
+
+    VirtualRegion(const VirtualRegion&) = delete;
+    VirtualRegion& operator=(const VirtualRegion&) = delete;
+
+    VirtualRegion(VirtualRegion&& other) noexcept;
+    VirtualRegion& operator=(VirtualRegion&& other) noexcept;
+
+    /// Reserve @p bytes of address space (rounded up to kHugePageSize and
+    /// aligned to it), replacing any previous reservation.  Nothing is
+    /// committed yet.
+    /// @return false where address space cannot be reserved; the region
+    ///         is then empty and the caller keeps its heap storage.
+    bool Reserve(std::size_t bytes, PageBacking backing = PageBacking::Transparent);
+
+    /// Make at least the first @p bytes readable and writable.  Commits
+    /// in whole huge pages (or system pages for PageBacking::Default) and
+    /// never shrinks.  New memory reads as zero.
+    /// @return false when @p bytes exceeds the reservation or the system
+    ///         refuses; what was committed before stays usable.
+    bool Commit(std::size_t bytes);
+
+    /// Unmap everything.
+    void Release() noexcept;
+
+    [[nodiscard]] std::byte* Data() const noexcept { return base_; }
+    [[nodiscard]] bool IsReserved() const noexcept { return base_ != nullptr; }
+    [[nodiscard]] std::size_t Reserved() const noexcept { return reserved_; }
+    [[nodiscard]] std::size_t Committed() const noexcept { return committed_; }
+    [[nodiscard]] PageBacking Backing() const noexcept { return backing_; }
+
+    /// Committed bytes that are explicit hugetlb pages.  Below
+    /// Committed() once the system's huge page pool ran dry.
+    [[nodiscard]] std::size_t ExplicitHugeBytes() const noexcept { return explicitBytes_; }
+
+private:
+    std::byte* base_ = nullptr;
+    std::size_t reserved_ = 0;
+    std::size_t committed_ = 0;
+    std::size_t explicitBytes_ = 0;
+    PageBacking backing_ = PageBacking::Default;
+    bool explicitExhausted_ = false;  ///< A hugetlb commit failed; stop trying.
+};
+
+/// True when the kernel hands out transparent huge pages to regions that
+/// ask for them (Linux with THP set to "always" or "madvise").
+[[nodiscard]] bool TransparentHugePagesAvailable();
+
+}  // namespace cgs::ecs
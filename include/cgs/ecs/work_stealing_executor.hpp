@@ -0,0 +1,112 @@
+#pragma once
+
+/// @file work_stealing_executor.hpp
+/// @brief First-party parallel executor with persistent workers and
+///        per-worker work-stealing queues.
+///
+/// The generic SystemScheduler::ParallelExecutor receives a freshly built
+/// vector of std::function objects for every batch.  WorkStealingExecutor
+/// instead runs plain task descriptors (function pointer + context) that
+/// the scheduler keeps in reusable buffers, so dispatching a batch does not
+/// allocate once the schedule has warmed up.
+///
+/// Each Run() deals tasks round-robin into one queue per worker plus one
+/// for the calling thread, which participates in the work.  Owners pop
+/// from the back of their queue, idle threads steal from the front of the
+/// others.  Because dealing is deterministic, a system at the same batch
+/// position lands on the same worker tick after tick unless it is stolen.
+///
+/// @see docs/advanced/ECS_DEEP_DIVE.md  Section 6.3
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace cgs::ecs {
+
+/// Persistent thread pool that executes one batch of tasks at a time.
+///
+/// Run() blocks until every task has finished and must not be called
+/// concurrently or from inside a task.  Tasks must not throw.
+class WorkStealingExecutor {
+public:
+    /// Pre-built task descriptor: `fn(context)` is invoked once.
+    struct Task {
+        void (*fn)(void*) = nullptr;
+        void* context = nullptr;
+    };
+
+    /// Start @p workerCount background workers.
+    ///
+    /// The default leaves one hardware thread for the caller.  With zero
+    /// workers every batch runs inline on the calling thread.
+    explicit WorkStealingExecutor(std::size_t workerCount = DefaultWorkerCount());
+
+    /// Stop and join all workers.
+    ~WorkStealingExecutor();
+
+    // Non-copyable, non-movable (workers reference the executor).
+    WorkStealingExecutor(const WorkStealingExecutor&) = delete;
+    WorkStealingExecutor& operator=(const WorkStealingExecutor&) = delete;
+    WorkStealingExecutor(WorkStealingExecutor&&) = delete;
+    WorkStealingExecutor& operator=(WorkStealingExecutor&&) = delete;
+
+    /// Execute every task in @p tasks and wait for completion.
+    void Run(std::span<const Task> tasks);
+
+    /// ParallelExecutor-compatible entry point.
+    ///
+    /// Lets the executor be passed where a std::function executor is
+    /// expected (e.g. `scheduler.SetParallelExecutor(std::ref(pool))` or
+    /// Query::ParallelForEach).
+    void operator()(const std::vector<std::function<void()>>& tasks);
+
+    /// Number of background worker threads (the caller is not counted).
+    [[nodiscard]] std::size_t WorkerCount() const noexcept { return workers_.size(); }
+
+    /// availableCpuCount() - 1 (so the cgroup CPU quota counts), at least 1.
+    [[nodiscard]] static std::size_t DefaultWorkerCount() noexcept;
+
+private:
+    /// Task queue owned by one thread; other threads steal from its front.
+    struct alignas(64) Queue {
+        std::mutex mutex;
+        std::vector<Task> tasks;
+        std::size_t head = 0;  ///< Next task to steal.
+        std::size_t tail = 0;  ///< One past the next task to pop.
+    };
+
+    void workerLoop(std::size_t self);
+
+    /// Run tasks until none can be found, preferring queue @p self.
+    void drain(std::size_t self);
+
+    [[nodiscard]] bool tryPop(std::size_t self, Task& out);
+    [[nodiscard]] bool trySteal(std::size_t self, Task& out);
+
+    std::vector<std::thread> workers_;
+
+    /// workers_.size() + 1 queues; the last belongs to the Run() caller.
+    std::unique_ptr<Queue[]> queues_;
+    std::size_t queueCount_ = 0;
+
+    /// Tasks of the current Run() not yet finished.
+    std::atomic<std::size_t> remaining_{0};
+
+    std::mutex wakeMutex_;
+    std::condition_variable wake_;
+    uint64_t epoch_ = 0;
+    bool stop_ = false;
+
+    /// Descriptors built by operator() for std::function batches.
+    std::vector<Task> functionTasks_;
+};
+
+}  // namespace cgs::ecs
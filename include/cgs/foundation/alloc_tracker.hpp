@@ -0,0 +1,224 @@
+#pragma once
+
+/// @file alloc_tracker.hpp
+/// @brief Heap allocations attributed to the running system, plugin or
+///        network handler.
+///
+/// Code that runs on behalf of a named unit opens an AllocTagScope with
+/// that unit's tag: SystemScheduler around every ISystem::Execute(),
+/// PluginManager around OnUpdate(), and GameNetworkManager around each
+/// message handler.  The tag lives in a thread-local, so opening a scope
+/// is two plain stores.
+///
+/// Counting needs the instrumented allocator: link
+/// cgs::foundation_alloc_hooks (or configure with -DCGS_ALLOC_TRACKING=ON
+/// for the service executables), which replaces the global operator
+/// new/delete and calls AllocTracker::RecordAllocation().  Without it the
+/// tags are still set but every count stays zero and Installed() is
+/// false.  Recording is a few relaxed atomic adds into a fixed table, so
+/// the hooks can stay linked in production.
+///
+/// Work a unit hands to another thread (a job, a coroutine resumed
+/// elsewhere) is charged to that thread's tag, usually untagged.
+///
+/// For tests, SetStrictHandler() reports every allocation made under a
+/// tag, e.g. to assert that a steady-state tick allocates nothing:
+/// @code
+///   AllocTracker::SetStrictHandler([](AllocTag tag, std::size_t bytes) {
+///       ++gViolations;  // must not allocate
+///   });
+///   scheduler.Execute(dt);
+///   AllocTracker::SetStrictHandler(nullptr);
+///   EXPECT_EQ(gViolations, 0);
+/// @endcode
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cgs::foundation {
+
+/// Index of a registered allocation tag; 0 is untagged.
+using AllocTag = uint16_t;
+
+/// Allocation count and requested bytes.
+struct AllocCounts {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+};
+
+/// Totals of one tag (see AllocTracker::Snapshot()).
+struct AllocTagCounts {
+    AllocTag tag = 0;
+    std::string name;
+    AllocCounts counts;
+};
+
+namespace detail {
+
+struct AllocCell {
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> bytes{0};
+};
+
+using AllocStrictHandler = void (*)(AllocTag tag, std::size_t bytes);
+
+inline constexpr std::size_t kMaxAllocTags = 1024;
+
+inline std::array<AllocCell, kMaxAllocTags> gAllocCells{};
+inline std::atomic<uint32_t> gAllocTagCount{1};  // Tag 0 is untagged.
+inline std::atomic<bool> gAllocHooksInstalled{false};
+inline std::atomic<AllocStrictHandler> gAllocStrictHandler{nullptr};
+
+inline thread_local AllocTag tAllocTag = 0;
+inline thread_local AllocCounts tAllocCounts{};
+inline thread_local bool tAllocInStrictHandler = false;
+
+/// Tag names, touched only by registration and reads.
+struct AllocTagNames {
+    std::mutex mutex;
+    std::vector<std::string> names{std::string("untagged")};
+};
+
+inline AllocTagNames& allocTagNames() {
+    static AllocTagNames names;
+    return names;
+}
+
+}  // namespace detail
+
+/// Process-wide allocation accounting; see file comment.
+class AllocTracker {
+public:
+    static constexpr AllocTag kUntagged = 0;
+    static constexpr std::size_t kMaxTags = detail::kMaxAllocTags;
+
+    using StrictHandler = detail::AllocStrictHandler;
+
+    /// Tag for @p name, registering it on first use.  Registering the
+    /// same name again returns the same tag.  Locks and may allocate, so
+    /// call it at setup.  Returns kUntagged once kMaxTags are in use.
+    [[nodiscard]] static AllocTag Register(std::string_view name) {
+        auto& registry = detail::allocTagNames();
+        std::lock_guard lock(registry.mutex);
+        for (std::size_t i = 1; i < registry.names.size(); ++i) {
+            if (registry.names[i] == name) {
+                return static_cast<AllocTag>(i);
+            }
+        }
+        if (registry.names.size() >= kMaxTags) {
+            return kUntagged;
+        }
+        registry.names.emplace_back(name);
+        const auto tag = static_cast<AllocTag>(registry.names.size() - 1);
+        detail::gAllocTagCount.store(static_cast<uint32_t>(registry.names.size()),
+                                     std::memory_order_release);
+        return tag;
+    }
+
+    /// Name registered for @p tag ("untagged" for kUntagged or unknown).
+    [[nodiscard]] static std::string Name(AllocTag tag) {
+        auto& registry = detail::allocTagNames();
+        std::lock_guard lock(registry.mutex);
+        return tag < registry.names.size() ? registry.names[tag] : registry.names[0];
+    }
+
+    /// Number of tags in use, kUntagged included.
+    [[nodiscard]] static std::size_t TagCount() noexcept {
+        return detail::gAllocTagCount.load(std::memory_order_acquire);
+    }
+
+    /// True once the instrumented allocator is linked and counting.
+    [[nodiscard]] static bool Installed() noexcept {
+        return detail::gAllocHooksInstalled.load(std::memory_order_relaxed);
+    }
+
+    /// Tag of the calling thread.
+    [[nodiscard]] static AllocTag Current() noexcept { return detail::tAllocTag; }
+
+    /// Allocations made on the calling thread so far (all tags).  The
+    /// difference across a call charges it without touching shared state.
+    [[nodiscard]] static AllocCounts ThreadCounts() noexcept { return detail::tAllocCounts; }
+
+    /// Allocations charged to @p tag so far, on all threads.
+    [[nodiscard]] static AllocCounts Counts(AllocTag tag) noexcept {
+        if (tag >= kMaxTags) {
+            return {};
+        }
+        const auto& cell = detail::gAllocCells[tag];
+        return {cell.allocations.load(std::memory_order_relaxed),
+                cell.bytes.load(std::memory_order_relaxed)};
+    }
+
+    /// Totals of every tag in use, kUntagged first.
+    [[nodiscard]] static std::vector<AllocTagCounts> Snapshot() {
+        std::vector<AllocTagCounts> out;
+        auto& registry = detail::allocTagNames();
+        std::lock_guard lock(registry.mutex);
+        out.reserve(registry.names.size());
+        for (std::size_t i = 0; i < registry.names.size(); ++i) {
+            const auto tag = static_cast<AllocTag>(i);
+            out.push_back({tag, registry.names[i], Counts(tag)});
+        }
+        return out;
+    }
+
+    /// Call @p handler for every allocation made under a tag other than
+    /// kUntagged, on any thread (nullptr turns strict mode off).  The
+    /// handler runs inside operator new: allocations it makes itself are
+    /// not reported again, but it should stay trivial.
+    static void SetStrictHandler(StrictHandler handler) noexcept {
+        detail::gAllocStrictHandler.store(handler, std::memory_order_release);
+    }
+
+    // ── Called by the instrumented allocator ────────────────────────────
+
+    /// Mark the hooks as linked (from their static initialiser).
+    static void MarkInstalled() noexcept {
+        detail::gAllocHooksInstalled.store(true, std::memory_order_relaxed);
+    }
+
+    /// Charge one allocation of @p bytes to the calling thread and tag.
+    static void RecordAllocation(std::size_t bytes) noexcept {
+        const AllocTag tag = detail::tAllocTag;
+        auto& thread = detail::tAllocCounts;
+        ++thread.allocations;
+        thread.bytes += bytes;
+
+        auto& cell = detail::gAllocCells[tag];
+        cell.allocations.fetch_add(1, std::memory_order_relaxed);
+        cell.bytes.fetch_add(bytes, std::memory_order_relaxed);
+
+        if (tag != kUntagged && !detail::tAllocInStrictHandler) {
+            if (auto* handler = detail::gAllocStrictHandler.load(std::memory_order_acquire)) {
+                detail::tAllocInStrictHandler = true;
+                handler(tag, bytes);
+                detail::tAllocInStrictHandler = false;
+            }
+        }
+    }
+};
+
+/// Sets the calling thread's tag for its lifetime, restoring the
+/// previous tag on exit, so scopes nest.
+class AllocTagScope {
+public:
+    explicit AllocTagScope(AllocTag tag) noexcept : previous_(detail::tAllocTag) {
+        detail::tAllocTag = tag;
+    }
+
+    ~AllocTagScope() { detail::tAllocTag = previous_; }
+
+    AllocTagScope(const AllocTagScope&) = delete;
+    AllocTagScope& operator=(const AllocTagScope&) = delete;
+
+private:
+    AllocTag previous_;
+};
+
+}  // namespace cgs::foundation
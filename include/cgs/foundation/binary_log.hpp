@@ -0,0 +1,181 @@
+#pragma once
+
+/// @file binary_log.hpp
+/// @brief Compact binary log files for GameLogger, and their decoder.
+///
+/// Text and JSON lines repeat keys, level names and full timestamps on
+/// every line, and rendering them costs CPU on the logging path.
+/// BinaryLogWriter instead stores what the call already had: the logf()
+/// format once per segment as a numbered string, then per record the
+/// format id, a varint timestamp delta, level and category in one byte,
+/// and the raw argument values.  Records fill segments that are LZ4
+/// compressed when they are sealed.  BinaryLogReader and the
+/// cgs_log_decode tool turn a file back into text or JSON lines on demand.
+///
+/// File layout (host byte order):
+/// @code
+///   header   "CGSBLOG\0"  u32 version  u32 reserved
+///   segment  u32 magic  u32 rawSize  u32 storedSize  u32 records
+///            i64 baseNs (system clock)  [storedSize bytes]
+/// @endcode
+/// A segment is LZ4 compressed when storedSize < rawSize.  Each segment
+/// defines its own format ids, so it decodes without the ones before it,
+/// and a file cut short by a crash loses at most its unsealed segment.
+/// Part of the Logger System Adapter (SDS-MOD-003).
+
+#include "cgs/foundation/game_logger.hpp"
+#include "cgs/foundation/game_result.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace cgs::foundation {
+
+/// BinaryLogWriter settings.
+struct BinaryLogConfig {
+    /// Uncompressed bytes after which a segment is sealed and written.
+    std::size_t segmentBytes = 64 * 1024;
+
+    /// A segment is also sealed by the first record logged this long
+    /// after the segment's first record, bounding what a crash loses.
+    std::chrono::milliseconds maxSegmentAge{1000};
+
+    /// LZ4-compress segments (one that does not shrink is stored raw).
+    bool compress = true;
+};
+
+/// Counters of one BinaryLogWriter.
+struct BinaryLogStats {
+    uint64_t records = 0;      ///< Records appended.
+    uint64_t segments = 0;     ///< Segments written.
+    uint64_t rawBytes = 0;     ///< Encoded bytes of the written segments.
+    uint64_t storedBytes = 0;  ///< Bytes written for them, headers included.
+    uint64_t writeErrors = 0;  ///< Segments the file refused.
+};
+
+/// One log call as handed to BinaryLogWriter::append().
+struct BinaryLogRecord {
+    std::chrono::system_clock::time_point timestamp{};
+    LogLevel level = LogLevel::Info;
+    LogCategory category = LogCategory::Core;
+    const char* format = nullptr;     ///< logf() format literal, or nullptr.
+    std::string_view message{};       ///< Plain message when format is null.
+    std::span<const LogArg> args{};   ///< logf() arguments.
+    const LogContext* context = nullptr;
+    std::string_view correlationId{};
+};
+
+/// Appends records to a binary log file.  Thread-safe.
+///
+/// Format ids are assigned per format pointer, so @c format must be a
+/// string literal (as GameLogger::logf() already requires).
+class BinaryLogWriter {
+public:
+    /// Open @p path for appending, writing the file header if it is new.
+    /// @return LogFileOpenFailed if it cannot be opened, LogFileCorrupt
+    ///         if it exists but is not a binary log.
+    [[nodiscard]] static GameResult<std::shared_ptr<BinaryLogWriter>> open(
+        const std::filesystem::path& path, BinaryLogConfig config = {});
+
+    /// Seals and writes the open segment.
+    ~BinaryLogWriter();
+
+    BinaryLogWriter(const BinaryLogWriter&) = delete;
+    BinaryLogWriter& operator=(const BinaryLogWriter&) = delete;
+
+    void append(const BinaryLogRecord& record);
+
+    /// Seal the open segment and flush the file.
+    GameResult<void> flush();
+
+    [[nodiscard]] BinaryLogStats stats() const;
+
+    [[nodiscard]] const std::filesystem::path& path() const noexcept { return path_; }
+
+private:
+    BinaryLogWriter(std::FILE* file, std::filesystem::path path, BinaryLogConfig config);
+
+    /// Write the open segment, if any, and start a new one.
+    void sealLocked();
+
+    std::filesystem::path path_;
+    BinaryLogConfig config_;
+
+    mutable std::mutex mutex_;
+    std::FILE* file_;
+    std::vector<uint8_t> segment_;  ///< Encoded records of the open segment.
+    std::vector<uint8_t> packed_;   ///< Sealing scratch.
+    std::unordered_map<const char*, uint32_t> formatIds_;  ///< Of the open segment.
+    int64_t baseNs_ = 0;
+    int64_t lastNs_ = 0;
+    uint32_t segmentRecords_ = 0;
+    BinaryLogStats stats_;
+};
+
+/// A record decoded from a binary log, message already rendered.
+struct DecodedLogRecord {
+    std::chrono::system_clock::time_point timestamp;
+    LogLevel level = LogLevel::Info;
+    LogCategory category = LogCategory::Core;
+    std::string message;
+    std::optional<LogContext> context;
+    std::string correlationId;
+};
+
+/// Reads the records of a binary log in order, one segment at a time.
+class BinaryLogReader {
+public:
+    /// @return LogFileOpenFailed or LogFileCorrupt (see BinaryLogWriter::open()).
+    [[nodiscard]] static GameResult<BinaryLogReader> open(const std::filesystem::path& path);
+
+    /// Read a binary log from memory.
+    [[nodiscard]] static GameResult<BinaryLogReader> fromBytes(std::string bytes);
+
+    /// Decode the next record into @p out.
+    ///
+    /// A segment cut short at the end of the input (a crash mid-write)
+    /// ends the log like a clean end; truncated() then reports it.
+    /// @return false at the end, LogFileCorrupt for a damaged segment.
+    [[nodiscard]] GameResult<bool> next(DecodedLogRecord& out);
+
+    /// Whether the input ended inside a segment.
+    [[nodiscard]] bool truncated() const noexcept { return truncated_; }
+
+private:
+    explicit BinaryLogReader(std::unique_ptr<std::istream> in) : in_(std::move(in)) {}
+
+    [[nodiscard]] static GameResult<BinaryLogReader> start(std::unique_ptr<std::istream> in);
+
+    /// Load the next segment.  @return false at the end of the input.
+    [[nodiscard]] GameResult<bool> loadSegment();
+
+    std::unique_ptr<std::istream> in_;
+    std::vector<uint8_t> stored_;
+    std::vector<uint8_t> segment_;
+    std::size_t pos_ = 0;
+    uint32_t recordsLeft_ = 0;
+    int64_t lastNs_ = 0;
+    std::vector<std::string> formats_;  ///< Format ids of the current segment.
+    std::vector<LogArg> args_;
+    bool truncated_ = false;
+};
+
+/// `2026-02-14T12:00:00.000123Z INFO [Core] message {key=value}`.
+[[nodiscard]] std::string renderLogText(const DecodedLogRecord& record);
+
+/// The JsonLogFormatter line the record would have produced when logged.
+[[nodiscard]] std::string renderLogJson(const DecodedLogRecord& record);
+
+}  // namespace cgs::foundation
@@ -0,0 +1,93 @@
+#pragma once
+
+/// @file blocking_executor.hpp
+/// @brief Fixed thread pool for calls that block, such as database round trips.
+///
+/// The callback and coroutine query APIs of GameDatabase and DBProxyServer
+/// run on one of these instead of a thread per request: requests beyond
+/// the thread count queue here (there is no point running more queries at
+/// once than there are pooled connections).
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace cgs::foundation {
+
+class BlockingExecutor {
+public:
+    /// Start @p threads workers (at least one).
+    explicit BlockingExecutor(std::size_t threads) {
+        const std::size_t count = threads == 0 ? 1 : threads;
+        workers_.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            workers_.emplace_back([this] { run(); });
+        }
+    }
+
+    /// Run the queued work, then join the workers.
+    ~BlockingExecutor() {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    BlockingExecutor(const BlockingExecutor&) = delete;
+    BlockingExecutor& operator=(const BlockingExecutor&) = delete;
+
+    /// Queue @p work.  @return false once the executor is shutting down.
+    bool post(std::function<void()> work) {
+        {
+            std::lock_guard lock(mutex_);
+            if (stopping_) {
+                return false;
+            }
+            queue_.push_back(std::move(work));
+        }
+        cv_.notify_one();
+        return true;
+    }
+
+    /// Work queued but not yet started.
+    [[nodiscard]] std::size_t queued() const {
+        std::lock_guard lock(mutex_);
+        return queue_.size();
+    }
+
+    [[nodiscard]] std::size_t threadCount() const noexcept { return workers_.size(); }
+
+private:
+    void run() {
+        for (;;) {
+            std::function<void()> work;
+            {
+                std::unique_lock lock(mutex_);
+                cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+                if (queue_.empty()) {
+                    return;  // Stopping and drained
+                }
+                work = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            work();
+        }
+    }
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::function<void()>> queue_;
+    bool stopping_ = false;
+    std::vector<std::thread> workers_;  // Last: started after the members above exist
+};
+
+}  // namespace cgs::foundation
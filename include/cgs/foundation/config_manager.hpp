@@ -5,12 +5,18 @@
 
 #include "cgs/foundation/game_result.hpp"
 
+#include <atomic>
+#include <cstdint>
 #include <filesystem>
 #include <functional>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 #include <yaml-cpp/yaml.h>
 
@@ -19,16 +25,135 @@ namespace cgs::foundation {
 /// Callback invoked when a watched configuration key changes.
 using ConfigWatchCallback = std::function<void(std::string_view key)>;
 
+namespace detail {
+
+/// Typed value of one bound key, refreshed by ConfigManager on every
+/// published snapshot.
+class ConfigSlotBase {
+public:
+    virtual ~ConfigSlotBase() = default;
+
+    /// Convert @p node (nullptr if the key is absent) and publish it.
+    /// Called by the single writer holding ConfigManager's write lock.
+    virtual void refresh(const YAML::Node* node) = 0;
+};
+
+/// Values read with one lock-free atomic load; anything else is published
+/// as a shared immutable copy.
+template <typename T>
+constexpr bool isInlineConfigValue() {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        return std::atomic<T>::is_always_lock_free;
+    } else {
+        return false;
+    }
+}
+
+template <typename T>
+inline constexpr bool kInlineConfigValue = isInlineConfigValue<T>();
+
+template <typename T>
+class ConfigSlot final : public ConfigSlotBase {
+public:
+    explicit ConfigSlot(T fallback) : fallback_(std::move(fallback)) { store(fallback_); }
+
+    void refresh(const YAML::Node* node) override {
+        std::optional<T> value;
+        if (node != nullptr) {
+            try {
+                value = node->template as<T>();
+            } catch (const YAML::BadConversion&) {
+                // Leave it at the fallback
+            }
+        }
+        store(value ? *value : fallback_);
+        present_.store(value.has_value(), std::memory_order_release);
+    }
+
+    [[nodiscard]] T load() const {
+        if constexpr (kInlineConfigValue<T>) {
+            return value_.load(std::memory_order_acquire);
+        } else {
+            return *value_.load(std::memory_order_acquire);
+        }
+    }
+
+    [[nodiscard]] bool present() const noexcept {
+        return present_.load(std::memory_order_acquire);
+    }
+
+private:
+    void store(const T& value) {
+        if constexpr (kInlineConfigValue<T>) {
+            value_.store(value, std::memory_order_release);
+        } else {
+            value_.store(std::make_shared<const T>(value), std::memory_order_release);
+        }
+    }
+
+    using Storage = std::conditional_t<kInlineConfigValue<T>, std::atomic<T>,
+                                       std::atomic<std::shared_ptr<const T>>>;
+
+    T fallback_;
+    Storage value_;
+    std::atomic<bool> present_{false};
+};
+
+}  // namespace detail
+
+/// Handle to one configuration value, resolved once by ConfigManager::bind().
+///
+/// get() reads the value of the latest published snapshot without a lock,
+/// a string key or a YAML conversion: scalars such as `int`, `double` and
+/// `bool` are a single atomic load.  The handle is copyable and stays
+/// valid after its ConfigManager is gone (it then keeps its last value).
+template <typename T>
+class ConfigValue {
+public:
+    /// Unbound handle; get() returns T{}.
+    ConfigValue() = default;
+
+    /// The key's value, or the fallback given to bind() if the key is
+    /// absent or does not convert to T.
+    [[nodiscard]] T get() const { return slot_ ? slot_->load() : T{}; }
+
+    [[nodiscard]] T operator*() const { return get(); }
+
+    /// Whether the key is present and converts to T.
+    [[nodiscard]] bool present() const noexcept { return slot_ && slot_->present(); }
+
+    /// Whether this handle came from bind().
+    [[nodiscard]] bool bound() const noexcept { return slot_ != nullptr; }
+
+private:
+    friend class ConfigManager;
+    explicit ConfigValue(std::shared_ptr<const detail::ConfigSlot<T>> slot)
+        : slot_(std::move(slot)) {}
+
+    std::shared_ptr<const detail::ConfigSlot<T>> slot_;
+};
+
 /// YAML-based configuration manager providing typed access to config values.
 ///
 /// Supports loading from file, dotted-key access (e.g., "server.port"),
 /// setting values at runtime, and registering callbacks for change notification.
 ///
 /// Internally flattens the YAML tree into a key-value map to avoid
-/// yaml-cpp reference-semantic pitfalls.
+/// yaml-cpp reference-semantic pitfalls.  The map is an immutable snapshot:
+/// load() and set() build a new one and swap it in atomically, so readers
+/// never lock.  After the swap the typed values behind bind() handles are
+/// refreshed, and then watchers of the changed keys are called (outside
+/// the write lock, so they may read or bind but not set()).
+///
+/// Example:
+/// @code
+///   auto crit = config.bind<double>("combat.crit_multiplier", 1.5);
+///   // In a system, every tick:
+///   damage *= crit.get();
+/// @endcode
 class ConfigManager {
 public:
-    ConfigManager() = default;
+    ConfigManager();
 
     /// Load configuration from a YAML file.
     /// @param path Filesystem path to the YAML config file.
@@ -36,30 +161,65 @@ public:
     GameResult<void> load(const std::filesystem::path& path);
 
     /// Retrieve a typed value by dotted key (e.g., "server.port").
+    /// Looks the key up and converts it on every call; prefer bind() for
+    /// values read repeatedly.
     /// @return The value or ConfigKeyNotFound/ConfigTypeMismatch error.
     template <typename T>
     GameResult<T> get(std::string_view key) const;
 
+    /// Resolve @p key once into a handle that reads its current typed
+    /// value without a lookup.  @p fallback is used while the key is absent
+    /// or does not convert to T.
+    template <typename T>
+    ConfigValue<T> bind(std::string_view key, T fallback = T{});
+
     /// Set a value by dotted key (creates intermediate nodes as needed).
     /// Notifies any registered watchers for this key.
     template <typename T>
     void set(std::string_view key, const T& value);
 
-    /// Register a callback that fires when the given key changes via set().
+    /// Register a callback that fires when the given key changes via set()
+    /// or a load() that changes its value.
     void watch(std::string_view key, ConfigWatchCallback callback);
 
     /// Check if a key exists in the current configuration.
     [[nodiscard]] bool hasKey(std::string_view key) const;
 
+    /// Number of snapshots published so far (load() and set() calls).
+    [[nodiscard]] uint64_t version() const noexcept;
+
 private:
-    /// Flatten a YAML node recursively into the entries_ map.
-    void flatten(const std::string& prefix, const YAML::Node& node);
+    using Entries = std::unordered_map<std::string, YAML::Node>;
+
+    /// Immutable flattened configuration.
+    struct Snapshot {
+        Entries entries;
+        uint64_t version = 0;
+    };
+
+    /// Flatten a YAML node recursively into @p entries.
+    static void flatten(const std::string& prefix, const YAML::Node& node, Entries& entries);
+
+    /// Current snapshot (never null).
+    [[nodiscard]] std::shared_ptr<const Snapshot> current() const;
+
+    /// Publish @p entries as the new snapshot, refresh the bindings of
+    /// @p changed keys (all keys if null), then call their watchers.
+    /// Caller holds writeLock, which this releases before notifying.
+    void publish(std::unique_lock<std::mutex>& writeLock, Entries entries,
+                 const std::vector<std::string>* changed);
 
-    /// Notify watchers registered for the given key.
-    void notifyWatchers(std::string_view key);
+    /// Set one entry (the non-template part of set()).
+    void setEntry(std::string_view key, YAML::Node node);
 
+    /// Register @p slot for @p key and fill it from the current snapshot.
+    void attach(std::string_view key, const std::shared_ptr<detail::ConfigSlotBase>& slot);
+
+    std::atomic<std::shared_ptr<const Snapshot>> snapshot_;
+
+    // Serializes writers; guards bindings_ and watchers_.
     mutable std::mutex mutex_;
-    std::unordered_map<std::string, YAML::Node> entries_;
+    std::unordered_map<std::string, std::vector<std::weak_ptr<detail::ConfigSlotBase>>> bindings_;
     std::unordered_map<std::string, std::vector<ConfigWatchCallback>> watchers_;
 };
 
@@ -67,15 +227,15 @@ private:
 
 template <typename T>
 GameResult<T> ConfigManager::get(std::string_view key) const {
-    std::lock_guard lock(mutex_);
-    auto it = entries_.find(std::string(key));
-    if (it == entries_.end()) {
+    const auto snapshot = current();
+    auto it = snapshot->entries.find(std::string(key));
+    if (it == snapshot->entries.end()) {
         return GameResult<T>::err(
             GameError(ErrorCode::ConfigKeyNotFound,
                       std::string("config key not found: ") + std::string(key)));
     }
     try {
-        return GameResult<T>::ok(it->second.as<T>());
+        return GameResult<T>::ok(it->second.template as<T>());
     } catch (const YAML::BadConversion&) {
         return GameResult<T>::err(
             GameError(ErrorCode::ConfigTypeMismatch,
@@ -83,13 +243,16 @@ GameResult<T> ConfigManager::get(std::string_view key) const {
     }
 }
 
+template <typename T>
+ConfigValue<T> ConfigManager::bind(std::string_view key, T fallback) {
+    auto slot = std::make_shared<detail::ConfigSlot<T>>(std::move(fallback));
+    attach(key, slot);
+    return ConfigValue<T>(std::move(slot));
+}
+
 template <typename T>
 void ConfigManager::set(std::string_view key, const T& value) {
-    {
-        std::lock_guard lock(mutex_);
-        entries_[std::string(key)] = YAML::Node(value);
-    }
-    notifyWatchers(key);
+    setEntry(key, YAML::Node(value));
 }
 
 }  // namespace cgs::foundation
@@ -0,0 +1,356 @@
+#pragma once
+
+/// @file cpu_affinity.hpp
+/// @brief CPU sets, thread pinning, NUMA lookup and container-aware CPU counts.
+///
+/// Thread pools size themselves with availableCpuCount(), which honours
+/// the process affinity mask and the cgroup CPU quota (a pod limited to
+/// `cpu: "2"` on a 64-core host gets 2, not 64).  ThreadPlacement holds
+/// the core sets of the GameLoop thread, the job workers and the network
+/// reactors; each pins its threads on start, before they allocate, so
+/// per-thread memory (deques, scratch arenas) is first-touched on the
+/// thread's own NUMA node.
+///
+/// Pinning and NUMA lookup are Linux-only; elsewhere pinCurrentThread()
+/// returns NotImplemented and allowedCpus() is 0..hardware_concurrency-1.
+///
+/// Example:
+/// @code
+///   auto placement = ThreadPlacement::isolatedGameThread(allowedCpus());
+///   GameJobScheduler scheduler(placement.workers.size(), placement.workers);
+///   network.setReactors(2, 4096, placement.network);
+///   loop.setAffinity(placement.gameLoop);
+/// @endcode
+
+#include "cgs/foundation/error_code.hpp"
+#include "cgs/foundation/game_error.hpp"
+#include "cgs/foundation/game_result.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <initializer_list>
+#include <iterator>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace cgs::foundation {
+
+/// Sorted set of logical CPU ids.
+class CpuSet {
+public:
+    CpuSet() = default;
+
+    CpuSet(std::initializer_list<uint32_t> cpus) {
+        for (auto cpu : cpus) {
+            add(cpu);
+        }
+    }
+
+    /// Parse the kernel's cpulist format ("0-3,8,10-11"; blank = empty).
+    /// @return InvalidArgument on malformed input.
+    [[nodiscard]] static GameResult<CpuSet> parse(std::string_view list) {
+        CpuSet set;
+        while (!list.empty()) {
+            const auto comma = list.find(',');
+            auto item = trim(list.substr(0, comma));
+            list = comma == std::string_view::npos ? std::string_view{} : list.substr(comma + 1);
+            if (item.empty()) {
+                continue;
+            }
+            const auto dash = item.find('-');
+            auto first = toCpu(item.substr(0, dash));
+            auto last = dash == std::string_view::npos ? first : toCpu(item.substr(dash + 1));
+            if (!first || !last || *last < *first || *last - *first > kMaxRange) {
+                return GameResult<CpuSet>::err(GameError(
+                    ErrorCode::InvalidArgument, "invalid cpu list item: " + std::string(item)));
+            }
+            for (uint32_t cpu = *first; cpu <= *last; ++cpu) {
+                set.add(cpu);
+            }
+        }
+        return GameResult<CpuSet>::ok(std::move(set));
+    }
+
+    void add(uint32_t cpu) {
+        auto it = std::lower_bound(cpus_.begin(), cpus_.end(), cpu);
+        if (it == cpus_.end() || *it != cpu) {
+            cpus_.insert(it, cpu);
+        }
+    }
+
+    [[nodiscard]] bool contains(uint32_t cpu) const noexcept {
+        return std::binary_search(cpus_.begin(), cpus_.end(), cpu);
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return cpus_.empty(); }
+    [[nodiscard]] std::size_t size() const noexcept { return cpus_.size(); }
+
+    /// The @p i th CPU, in ascending order.
+    [[nodiscard]] uint32_t operator[](std::size_t i) const noexcept { return cpus_[i]; }
+
+    [[nodiscard]] const std::vector<uint32_t>& cpus() const noexcept { return cpus_; }
+
+    /// The CPUs of this set not in @p other.
+    [[nodiscard]] CpuSet without(const CpuSet& other) const {
+        CpuSet result;
+        std::set_difference(cpus_.begin(), cpus_.end(), other.cpus_.begin(), other.cpus_.end(),
+                            std::back_inserter(result.cpus_));
+        return result;
+    }
+
+    /// The CPUs in both this set and @p other.
+    [[nodiscard]] CpuSet intersect(const CpuSet& other) const {
+        CpuSet result;
+        std::set_intersection(cpus_.begin(), cpus_.end(), other.cpus_.begin(),
+                              other.cpus_.end(), std::back_inserter(result.cpus_));
+        return result;
+    }
+
+    /// cpulist form, e.g. "0-3,8".
+    [[nodiscard]] std::string toString() const {
+        std::string out;
+        for (std::size_t i = 0; i < cpus_.size();) {
+            std::size_t j = i;
+            while (j + 1 < cpus_.size() && cpus_[j + 1] == cpus_[j] + 1) {
+                ++j;
+            }
+            if (!out.empty()) {
+                out += ',';
+            }
+            out += std::to_string(cpus_[i]);
+            if (j > i) {
+                out += '-';
+                out += std::to_string(cpus_[j]);
+            }
+            i = j + 1;
+        }
+        return out;
+    }
+
+    bool operator==(const CpuSet&) const = default;
+
+private:
+    static constexpr uint32_t kMaxRange = 1u << 16;
+
+    static std::string_view trim(std::string_view text) noexcept {
+        while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+            text.remove_prefix(1);
+        }
+        while (!text.empty() && (text.back() == ' ' || text.back() == '\t' ||
+                                 text.back() == '\n' || text.back() == '\r')) {
+            text.remove_suffix(1);
+        }
+        return text;
+    }
+
+    static std::optional<uint32_t> toCpu(std::string_view text) noexcept {
+        text = trim(text);
+        uint32_t value = 0;
+        const auto* end = text.data() + text.size();
+        auto [ptr, ec] = std::from_chars(text.data(), end, value);
+        if (text.empty() || ec != std::errc{} || ptr != end) {
+            return std::nullopt;
+        }
+        return value;
+    }
+
+    std::vector<uint32_t> cpus_;
+};
+
+namespace detail {
+
+inline std::optional<std::string> readTextFile(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        return std::nullopt;
+    }
+    std::ostringstream text;
+    text << in.rdbuf();
+    return text.str();
+}
+
+}  // namespace detail
+
+/// CPUs the calling process may run on.
+[[nodiscard]] inline CpuSet allowedCpus() {
+    CpuSet set;
+#if defined(__linux__)
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+        for (std::size_t cpu = 0; cpu < static_cast<std::size_t>(CPU_SETSIZE); ++cpu) {
+            if (CPU_ISSET(cpu, &mask)) {
+                set.add(static_cast<uint32_t>(cpu));
+            }
+        }
+        return set;
+    }
+#endif
+    const unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+    for (uint32_t cpu = 0; cpu < hardware; ++cpu) {
+        set.add(cpu);
+    }
+    return set;
+}
+
+/// CPUs granted by a cgroup v2 `cpu.max` ("max 100000" or
+/// "<quota> <period>"), or nullopt if unlimited or malformed.
+[[nodiscard]] inline std::optional<double> parseCgroupCpuMax(std::string_view content) {
+    std::istringstream in{std::string(content)};
+    std::string quota;
+    double period = 0;
+    if (!(in >> quota >> period) || quota == "max" || period <= 0) {
+        return std::nullopt;
+    }
+    char* end = nullptr;
+    const double value = std::strtod(quota.c_str(), &end);
+    if (end == quota.c_str() || value <= 0) {
+        return std::nullopt;
+    }
+    return value / period;
+}
+
+/// CPUs granted by cgroup v1 `cpu.cfs_quota_us` / `cpu.cfs_period_us`
+/// (a quota of -1 means unlimited), or nullopt.
+[[nodiscard]] inline std::optional<double> parseCgroupCfsQuota(std::string_view quota,
+                                                               std::string_view period) {
+    return parseCgroupCpuMax(std::string(quota) + " " + std::string(period));
+}
+
+/// CPU limit of the calling process's cgroup, rounded up, read from the
+/// cgroup filesystem mounted at @p root (v2 `cpu.max`, then the v1 CFS
+/// quota).  @return nullopt when there is no limit.
+[[nodiscard]] inline std::optional<std::size_t> cgroupCpuLimit(
+    const std::string& root = "/sys/fs/cgroup") {
+    std::optional<double> limit;
+    if (auto v2 = detail::readTextFile(root + "/cpu.max")) {
+        limit = parseCgroupCpuMax(*v2);
+    } else {
+        for (const char* dir : {"/cpu", "/cpu,cpuacct"}) {
+            auto quota = detail::readTextFile(root + dir + "/cpu.cfs_quota_us");
+            auto period = detail::readTextFile(root + dir + "/cpu.cfs_period_us");
+            if (quota && period) {
+                limit = parseCgroupCfsQuota(*quota, *period);
+                break;
+            }
+        }
+    }
+    if (!limit) {
+        return std::nullopt;
+    }
+    return std::max<std::size_t>(1, static_cast<std::size_t>(std::ceil(*limit - 1e-9)));
+}
+
+/// Threads worth running: the allowed CPUs, capped by the cgroup quota,
+/// at least 1.  Used as the default size of the worker pools.
+[[nodiscard]] inline std::size_t availableCpuCount() {
+    std::size_t count = std::max<std::size_t>(1, allowedCpus().size());
+    if (auto limit = cgroupCpuLimit()) {
+        count = std::min(count, *limit);
+    }
+    return count;
+}
+
+/// Restrict the calling thread to @p cpus (empty = no-op).
+/// @return InvalidArgument if the kernel rejects the set (e.g. no CPU of
+///         it is allowed), NotImplemented off Linux.
+inline GameResult<void> pinCurrentThread(const CpuSet& cpus) {
+    if (cpus.empty()) {
+        return GameResult<void>::ok();
+    }
+#if defined(__linux__)
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    for (auto cpu : cpus.cpus()) {
+        if (cpu >= static_cast<uint32_t>(CPU_SETSIZE)) {
+            return GameResult<void>::err(
+                GameError(ErrorCode::InvalidArgument, "cpu id out of range"));
+        }
+        CPU_SET(cpu, &mask);
+    }
+    if (pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask) != 0) {
+        return GameResult<void>::err(GameError(ErrorCode::InvalidArgument,
+                                               "cannot pin thread to cpus " + cpus.toString()));
+    }
+    return GameResult<void>::ok();
+#else
+    return GameResult<void>::err(
+        GameError(ErrorCode::NotImplemented, "thread pinning is not supported here"));
+#endif
+}
+
+/// Pin the calling thread, the @p index th of a pool, to one CPU of
+/// @p cpus (round-robin), keeping it and its memory on one core.
+inline GameResult<void> pinPoolThread(const CpuSet& cpus, std::size_t index) {
+    if (cpus.empty()) {
+        return GameResult<void>::ok();
+    }
+    return pinCurrentThread(CpuSet{cpus[index % cpus.size()]});
+}
+
+/// CPUs of NUMA node @p node (empty if unknown).
+[[nodiscard]] inline CpuSet numaNodeCpus(uint32_t node) {
+    auto list =
+        detail::readTextFile("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    if (!list) {
+        return {};
+    }
+    auto parsed = CpuSet::parse(*list);
+    return parsed.hasValue() ? parsed.value() : CpuSet{};
+}
+
+/// NUMA nodes present, as a set of node ids ({0} without NUMA info).
+[[nodiscard]] inline CpuSet numaNodes() {
+    auto list = detail::readTextFile("/sys/devices/system/node/online");
+    if (list) {
+        auto parsed = CpuSet::parse(*list);
+        if (parsed.hasValue() && !parsed.value().empty()) {
+            return parsed.value();
+        }
+    }
+    return CpuSet{0};
+}
+
+/// Core sets of the server's threads; an empty set leaves those threads
+/// where the OS puts them.
+struct ThreadPlacement {
+    CpuSet gameLoop;  ///< GameLoop tick thread.
+    CpuSet workers;   ///< GameJobScheduler native workers.
+    CpuSet network;   ///< GameNetworkManager reactors.
+
+    /// Isolated game thread: the first CPU of @p allowed belongs to the
+    /// GameLoop alone, the rest are shared by workers and reactors.  With
+    /// a single CPU nothing is pinned.
+    [[nodiscard]] static ThreadPlacement isolatedGameThread(const CpuSet& allowed) {
+        ThreadPlacement placement;
+        if (allowed.size() < 2) {
+            return placement;
+        }
+        placement.gameLoop = CpuSet{allowed[0]};
+        placement.workers = allowed.without(placement.gameLoop);
+        placement.network = placement.workers;
+        return placement;
+    }
+
+    /// Keep every thread on the allowed CPUs of NUMA node @p node, with
+    /// the game thread isolated on the first of them.
+    [[nodiscard]] static ThreadPlacement onNumaNode(uint32_t node) {
+        return isolatedGameThread(numaNodeCpus(node).intersect(allowedCpus()));
+    }
+};
+
+}  // namespace cgs::foundation
@@ -33,6 +33,7 @@ enum class ErrorCode : uint32_t {
     TlsHandshakeFailed = 0x0108,
     TlsCertificateInvalid = 0x0109,
     TlsNotSupported = 0x010A,
+    SendQueueFull = 0x010B,
 
     // Database (0x0200 - 0x02FF)
     DatabaseError = 0x0200,
@@ -42,6 +43,7 @@ enum class ErrorCode : uint32_t {
     ConnectionPoolTimeout = 0x0204,
     NotConnected = 0x0205,
     PreparedStatementFailed = 0x0206,
+    QueryCancelled = 0x0207,
 
     // ECS (0x0300 - 0x03FF)
     EntityNotFound = 0x0300,
@@ -74,6 +76,7 @@ enum class ErrorCode : uint32_t {
     InvalidCredentials = 0x0509,
     RefreshTokenExpired = 0x050A,
     InvalidUsername = 0x050B,
+    AuthOverloaded = 0x050C,
 
     // Config (0x0600 - 0x06FF)
     ConfigLoadFailed = 0x0600,
@@ -92,6 +95,8 @@ enum class ErrorCode : uint32_t {
     LoggerError = 0x0800,
     LoggerNotInitialized = 0x0801,
     LoggerFlushFailed = 0x0802,
+    LogFileOpenFailed = 0x0803,
+    LogFileCorrupt = 0x0804,
 
     // Monitoring (0x0900 - 0x09FF)
     MonitoringError = 0x0900,
@@ -103,6 +108,7 @@ enum class ErrorCode : uint32_t {
     SerializationError = 0x0A00,
     InvalidBinaryData = 0x0A01,
     InvalidJsonData = 0x0A02,
+    SchemaMismatch = 0x0A03,
 
     // GameServer (0x0B00 - 0x0BFF)
     GameServerError = 0x0B00,
@@ -115,6 +121,7 @@ enum class ErrorCode : uint32_t {
     PlayerNotInWorld = 0x0B07,
     InstanceFull = 0x0B08,
     SystemSchedulerBuildFailed = 0x0B09,
+    PlayerInTransit = 0x0B0A,
 
     // Lobby (0x0C00 - 0x0CFF)
     LobbyError = 0x0C00,
@@ -163,6 +170,7 @@ enum class ErrorCode : uint32_t {
     RecoveryFailed = 0x0F08,
     PersistenceNotStarted = 0x0F09,
     PersistenceAlreadyStarted = 0x0F0A,
+    WalQueueFull = 0x0F0B,
 };
 
 /// Return the subsystem name for a given error code.
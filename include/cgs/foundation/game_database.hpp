@@ -9,9 +9,15 @@
 /// Part of the Database System Adapter (SDS-MOD-005).
 
 #include "cgs/foundation/game_result.hpp"
+#include "cgs/foundation/query_queue.hpp"
+#include "cgs/foundation/query_result.hpp"
+#include "cgs/foundation/task.hpp"
 
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <cstdint>
+#include <functional>
 #include <future>
 #include <memory>
 #include <string>
@@ -22,19 +28,16 @@
 
 namespace cgs::foundation {
 
-// ── Type aliases for database values ────────────────────────────────────────
+class GameMetrics;
 
-/// Sentinel type representing SQL NULL.
-struct DbNull {};
+// DbNull, DbValue, DbRow, RowView and QueryResult: see query_result.hpp.
 
-/// A single column value in a query result row.
-using DbValue = std::variant<DbNull, std::string, std::int64_t, double, bool>;
+/// Completion of an asynchronous query, called on a query worker thread.
+using QueryCallback = std::function<void(GameResult<QueryResult>)>;
 
-/// A single row: column name → value.
-using DbRow = std::unordered_map<std::string, DbValue>;
-
-/// Complete result set from a SELECT query.
-using QueryResult = std::vector<DbRow>;
+/// One batch of a streamed query (see GameDatabase::queryStream()), valid
+/// only during the call.  Return false to stop the stream.
+using RowBatchCallback = std::function<bool(const QueryResult& batch)>;
 
 // ── Database types ──────────────────────────────────────────────────────────
 
@@ -48,6 +51,45 @@ struct DatabaseConfig {
     uint32_t minConnections = 2;
     uint32_t maxConnections = 10;
     std::chrono::seconds connectionTimeout{30};
+
+    // Pool sizing.  connect() pre-warms minConnections in parallel; the
+    // pool grows toward maxConnections under load and maintainPool()
+    // shrinks it back and rotates old connections.
+
+    /// How long a checkout waits for a connection to be returned before it
+    /// opens a new one.  0 opens one at once; a few milliseconds lets
+    /// short bursts reuse connections instead of paying for handshakes.
+    std::chrono::milliseconds growAfterWait{0};
+
+    /// Idle time after which maintainPool() closes a connection above
+    /// minConnections (0 = never).
+    std::chrono::seconds idleTimeout{0};
+
+    /// Age after which a connection is closed when it is next idle, and
+    /// replaced by maintainPool() if the pool drops below minConnections
+    /// (0 = never).
+    std::chrono::seconds maxLifetime{0};
+
+    /// Each connection's idleTimeout and maxLifetime are scaled by a random
+    /// factor in [1 - poolJitter, 1 + poolJitter], so connections opened
+    /// in one burst are not all closed in one.
+    double poolJitter = 0.2;
+
+    /// Asynchronous queries waiting for a worker before queryAsync()
+    /// rejects new ones with ConnectionPoolExhausted (0 = unbounded).
+    std::size_t asyncQueueCapacity = 4096;
+
+    /// Queue deadline of asynchronous queries that give none; a query not
+    /// started by then fails with ConnectionPoolTimeout (0 = none).
+    std::chrono::milliseconds asyncQueueTimeout{0};
+
+    /// Queued queries a worker sends back to back on one connection.
+    std::size_t pipelineDepth = 8;
+
+    /// Server-side prepared statements kept per PostgreSQL connection; past
+    /// this the connection's statements are deallocated and prepared anew.
+    /// 0 sends PreparedStatement::resolve() text instead.
+    std::size_t statementCacheSize = 256;
 };
 
 // ── PreparedStatement ───────────────────────────────────────────────────────
@@ -55,8 +97,11 @@ struct DatabaseConfig {
 /// A parameterized SQL statement with named parameter binding.
 ///
 /// Parameters are specified as $name placeholders in the SQL string and bound
-/// via the bind() methods. Call resolve() to obtain the final SQL with
-/// parameters substituted.
+/// via the bind() methods.  The template is split into text and placeholders
+/// once, on construction.  GameDatabase::execute() sends positionalSql() to
+/// PostgreSQL as a server-side prepared statement, once per connection, and
+/// then only the bound values; resolve() gives the SQL with the values
+/// substituted as escaped literals (used for SQLite and as a cache key).
 ///
 /// Example:
 /// @code
@@ -91,12 +136,161 @@ public:
     /// Resolve the SQL template with all bound parameters substituted.
     [[nodiscard]] std::string resolve() const;
 
+    /// Distinct $name placeholders, in order of first appearance.
+    [[nodiscard]] const std::vector<std::string>& parameterNames() const noexcept;
+
+    /// The template with each $name replaced by $N, N being its 1-based
+    /// position in parameterNames() (the form PostgreSQL prepares).
+    [[nodiscard]] std::string positionalSql() const;
+
+    /// Value bound to @p name, or nullptr if unbound.
+    [[nodiscard]] const DbValue* binding(std::string_view name) const;
+
     /// Clear all bound parameters.
     void clearBindings();
 
 private:
     std::string sql_;
     std::unordered_map<std::string, DbValue> params_;
+
+    // sql_ = text_[0] $names_[slots_[0]] text_[1] ... text_[n]
+    std::vector<std::string> text_;
+    std::vector<std::size_t> slots_;
+    std::vector<std::string> names_;
+};
+
+/// Counters of GameDatabase's server-side prepared statements.
+struct PreparedStatementStats {
+    uint64_t prepared = 0;  ///< PREPAREs sent (first use on a connection).
+    uint64_t reused = 0;    ///< Executions that reused a prepared plan.
+    uint64_t evictions = 0; ///< Per-connection caches dropped for being full.
+};
+
+/// Counters and histograms of GameDatabase's connection pool.
+struct ConnectionPoolStats {
+    static constexpr std::size_t kWaitBuckets = 10;  ///< Nine bounds plus +Inf.
+
+    /// Upper bounds of the checkout wait buckets in microseconds.
+    static constexpr std::array<uint64_t, kWaitBuckets - 1> kWaitBoundsUs{
+        10, 100, 1'000, 5'000, 10'000, 50'000, 100'000, 500'000, 1'000'000};
+
+    /// Utilization buckets: connections in use (the new checkout included)
+    /// over maxConnections, in tenths; bucket 9 also holds 100%.
+    static constexpr std::size_t kUtilizationBuckets = 10;
+
+    std::array<uint64_t, kWaitBuckets> waitBuckets{};  ///< Checkout waits, non-cumulative.
+    std::array<uint64_t, kUtilizationBuckets> utilizationBuckets{};  ///< At each checkout.
+    uint64_t checkouts = 0;                  ///< Connections handed out.
+    uint64_t timeouts = 0;                   ///< Checkouts that gave up (pool exhausted).
+    std::chrono::microseconds totalWait{0};  ///< Wait summed over checkouts.
+    std::chrono::microseconds maxWait{0};    ///< Longest wait of a checkout.
+    uint64_t opened = 0;          ///< Connections opened, pre-warm included.
+    uint64_t grown = 0;           ///< Of those, opened by a waiting checkout.
+    uint64_t idleClosed = 0;      ///< Closed by maintainPool() for idleness.
+    uint64_t lifetimeClosed = 0;  ///< Closed for reaching maxLifetime.
+
+    /// Bucket of a checkout that waited @p wait.
+    [[nodiscard]] static std::size_t waitBucket(std::chrono::microseconds wait) noexcept {
+        const auto us = static_cast<uint64_t>(std::max<int64_t>(wait.count(), 0));
+        return static_cast<std::size_t>(
+            std::lower_bound(kWaitBoundsUs.begin(), kWaitBoundsUs.end(), us) -
+            kWaitBoundsUs.begin());
+    }
+
+    /// Bucket of a checkout that left @p inUse of @p maxConnections busy.
+    [[nodiscard]] static std::size_t utilizationBucket(std::size_t inUse,
+                                                       std::size_t maxConnections) noexcept {
+        if (maxConnections == 0) {
+            return kUtilizationBuckets - 1;
+        }
+        return std::min(inUse * kUtilizationBuckets / maxConnections, kUtilizationBuckets - 1);
+    }
+
+    /// Add @p other's counts (e.g. to total several replicas).
+    ConnectionPoolStats& operator+=(const ConnectionPoolStats& other) noexcept {
+        for (std::size_t i = 0; i < kWaitBuckets; ++i) {
+            waitBuckets[i] += other.waitBuckets[i];
+        }
+        for (std::size_t i = 0; i < kUtilizationBuckets; ++i) {
+            utilizationBuckets[i] += other.utilizationBuckets[i];
+        }
+        checkouts += other.checkouts;
+        timeouts += other.timeouts;
+        totalWait += other.totalWait;
+        maxWait = std::max(maxWait, other.maxWait);
+        opened += other.opened;
+        grown += other.grown;
+        idleClosed += other.idleClosed;
+        lifetimeClosed += other.lifetimeClosed;
+        return *this;
+    }
+};
+
+// ── BatchWriter ─────────────────────────────────────────────────────────────
+
+/// Rows bound for one table, written with a few multi-row statements.
+///
+/// Rows are buffered as values and turned into `INSERT ... VALUES (...),
+/// (...)` statements of up to `rowsPerStatement` rows.  With upsert() the
+/// statements end in `ON CONFLICT (keys) DO UPDATE SET col = EXCLUDED.col`
+/// (or DO NOTHING when there is nothing to update); a later row with the
+/// same key replaces an earlier one before the statements are built, since
+/// PostgreSQL refuses to update one row twice in a statement.
+///
+/// GameDatabase::write() sends all statements in one transaction on one
+/// connection.  On SQLite each row is its own INSERT, looped inside that
+/// transaction.
+///
+/// Example:
+/// @code
+///   BatchWriter slots("inventory_slots", {"player_id", "slot", "item_id", "count"});
+///   slots.upsert({"player_id", "slot"});
+///   for (const auto& s : inventory) {
+///       (void)slots.addRow({playerId, s.slot, s.itemId, s.count});
+///   }
+///   auto written = db.write(slots);
+/// @endcode
+class BatchWriter {
+public:
+    BatchWriter(std::string table, std::vector<std::string> columns);
+
+    /// Turn inserts into upserts on the unique key @p keyColumns, updating
+    /// @p updateColumns (empty = every column not in the key).
+    BatchWriter& upsert(std::vector<std::string> keyColumns,
+                        std::vector<std::string> updateColumns = {});
+
+    /// Keep the existing row on a conflict with @p keyColumns.
+    BatchWriter& ignoreConflicts(std::vector<std::string> keyColumns);
+
+    /// Rows per statement (at least 1; default 500).
+    BatchWriter& setRowsPerStatement(std::size_t rows);
+
+    /// Buffer one row, values in column order.
+    ///
+    /// @return InvalidArgument if the value count differs from the column count.
+    GameResult<void> addRow(std::vector<DbValue> values);
+
+    /// Drop all buffered rows, keeping table, columns and conflict handling.
+    void clear() noexcept;
+
+    [[nodiscard]] const std::string& table() const noexcept;
+    [[nodiscard]] const std::vector<std::string>& columns() const noexcept;
+    [[nodiscard]] std::size_t rowCount() const noexcept;
+    [[nodiscard]] bool empty() const noexcept;
+
+    /// The statements write() sends for @p dbType, in order.
+    [[nodiscard]] std::vector<std::string> statements(DatabaseType dbType) const;
+
+private:
+    enum class Conflict : uint8_t { Fail, Update, Ignore };
+
+    std::string table_;
+    std::vector<std::string> columns_;
+    std::vector<DbValue> values_;  // rowCount() x columns_.size(), row-major
+    std::vector<std::string> keys_;
+    std::vector<std::string> updates_;
+    Conflict conflict_ = Conflict::Fail;
+    std::size_t rowsPerStatement_ = 500;
 };
 
 // ── Transaction ─────────────────────────────────────────────────────────────
@@ -137,6 +331,11 @@ public:
     /// Execute a command (INSERT/UPDATE/DELETE) within this transaction.
     [[nodiscard]] GameResult<uint64_t> execute(std::string_view sql);
 
+    /// Send @p batch's statements within this transaction.
+    ///
+    /// @return the number of rows in @p batch.
+    [[nodiscard]] GameResult<uint64_t> write(const BatchWriter& batch);
+
     /// Check if the transaction is still active (not committed/rolled back).
     [[nodiscard]] bool isActive() const noexcept;
 
@@ -153,7 +352,9 @@ private:
 ///
 /// Manages a pool of database connections and provides synchronous and
 /// asynchronous query execution, prepared statements, and RAII transactions.
-/// Uses PIMPL to hide all kcenon implementation details.
+/// Uses PIMPL to hide all kcenon implementation details.  disconnect()
+/// waits for queued asynchronous queries, so it must not be called from a
+/// query callback.
 ///
 /// Example:
 /// @code
@@ -195,22 +396,72 @@ public:
     /// Execute a SELECT query and return the result set.
     [[nodiscard]] GameResult<QueryResult> query(std::string_view sql);
 
+    /// Run a SELECT and pass its rows to @p onBatch in batches of up to
+    /// @p batchRows, holding one batch in memory at a time.
+    ///
+    /// The query runs in a transaction on one connection, held until the
+    /// stream ends.  On PostgreSQL it is a server-side cursor (DECLARE /
+    /// FETCH FORWARD); on SQLite the query is paged with LIMIT / OFFSET,
+    /// which reads one snapshot but rescans skipped rows, so give it an
+    /// ORDER BY.  Anything the statement writes is rolled back.
+    ///
+    /// @return the number of rows passed to @p onBatch.  A failure after
+    ///         some batches were delivered is still an error.
+    [[nodiscard]] GameResult<uint64_t> queryStream(std::string_view sql,
+                                                   const RowBatchCallback& onBatch,
+                                                   std::size_t batchRows = 1000);
+
     /// Execute a command (INSERT/UPDATE/DELETE/DDL) and return affected rows.
     [[nodiscard]] GameResult<uint64_t> execute(std::string_view sql);
 
+    /// Write @p batch in one transaction on one connection; nothing is
+    /// written if any statement fails.
+    ///
+    /// @return the number of rows in @p batch.
+    [[nodiscard]] GameResult<uint64_t> write(const BatchWriter& batch);
+
     // ── Asynchronous queries ────────────────────────────────────────────
+    //
+    // Asynchronous queries run on maxConnections query workers started by
+    // connect(); further requests wait in a bounded AsyncQueryQueue rather
+    // than taking a thread each.  A worker sends up to pipelineDepth queued
+    // queries on one connection.
 
     /// Execute a SELECT query asynchronously and return a future.
     [[nodiscard]] std::future<GameResult<QueryResult>> queryAsync(std::string_view sql);
 
+    /// Execute a SELECT query asynchronously and pass the result to
+    /// @p onDone on a query worker.  The query must start within
+    /// @p queueTimeout (0 = DatabaseConfig::asyncQueueTimeout) or fails
+    /// with ConnectionPoolTimeout.  @p onDone runs inline with NotConnected
+    /// if the database is not connected, and with ConnectionPoolExhausted
+    /// if the queue is full.
+    ///
+    /// @return a handle whose cancel() withdraws the query while queued.
+    QueryHandle queryAsync(std::string_view sql, QueryCallback onDone,
+                           std::chrono::milliseconds queueTimeout = std::chrono::milliseconds{0});
+
+    /// Coroutine form of queryAsync(): `co_await db.queryTask(sql)`
+    /// resumes on the query worker that ran it.
+    [[nodiscard]] Task<GameResult<QueryResult>> queryTask(std::string sql);
+
     // ── Prepared statements ─────────────────────────────────────────────
 
     /// Create a prepared statement from an SQL template.
     [[nodiscard]] GameResult<PreparedStatement> prepare(std::string_view sql);
 
     /// Execute a prepared statement and return the result set.
+    ///
+    /// On PostgreSQL the statement's SQL is prepared on the connection the
+    /// first time that connection sees it (statements are cached per
+    /// connection by SQL text) and later calls send only EXECUTE with the
+    /// bound values, reusing the server's parsed plan.  Every placeholder
+    /// must be bound (PreparedStatementFailed otherwise).
     [[nodiscard]] GameResult<QueryResult> execute(const PreparedStatement& stmt);
 
+    /// Server-side prepared statement counters.
+    [[nodiscard]] PreparedStatementStats preparedStatementStats() const noexcept;
+
     // ── Transactions ────────────────────────────────────────────────────
 
     /// Begin a new transaction with a dedicated connection.
@@ -224,6 +475,24 @@ public:
     /// Total number of connections in the pool.
     [[nodiscard]] std::size_t poolSize() const noexcept;
 
+    /// Close idle connections past their idleTimeout (down to
+    /// minConnections) or maxLifetime, then reopen up to minConnections.
+    /// Call periodically; a no-op while disconnected.
+    void maintainPool();
+
+    /// Pool wait and utilization histograms and open/close counters since
+    /// connect().
+    [[nodiscard]] ConnectionPoolStats connectionPoolStats() const;
+
+    /// Asynchronous query counters (all zero while disconnected).
+    [[nodiscard]] AsyncQueryStats asyncQueryStats() const;
+
+    /// Add the asynchronous query counters accumulated since the last call
+    /// to @p metrics (cgs_db_async_*_total, including the summed queue wait
+    /// in microseconds) and set the cgs_db_async_queue_depth and
+    /// cgs_db_async_queue_max_wait_us gauges.  Call once per tick or scrape.
+    void publishAsyncQueryMetrics(GameMetrics& metrics);
+
 private:
     struct Impl;
     std::unique_ptr<Impl> impl_;
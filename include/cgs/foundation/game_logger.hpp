@@ -6,16 +6,28 @@
 /// Provides category-based filtering, structured logging with context,
 /// and per-category runtime log level control. Part of the Logger System
 /// Adapter (SDS-MOD-003).
+///
+/// In async mode (GameLogger::setAsyncMode) a log call only copies a
+/// compact record into the calling thread's lock-free ring; a background
+/// writer thread formats the records and hands them to kcenon.
+///
+/// With a binary sink (GameLogger::setBinarySink) records skip text and
+/// JSON rendering altogether and go to a compact binary log file, decoded
+/// offline (see binary_log.hpp).
 
 #include "cgs/foundation/game_result.hpp"
 #include "cgs/foundation/types.hpp"
 
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <unordered_map>
 
 namespace cgs::foundation {
@@ -103,6 +115,136 @@ struct LogContext {
     std::unordered_map<std::string, std::string> extra;
 };
 
+/// One argument of GameLogger::logf(), captured by value.  Strings are
+/// held by view only until the call copies them into the log record.
+class LogArg {
+public:
+    enum class Kind : uint8_t { Int, UInt, Double, Bool, Char, String };
+
+    LogArg(bool value) noexcept : kind_(Kind::Bool), uint_(value ? 1u : 0u) {}
+    LogArg(char value) noexcept : kind_(Kind::Char), uint_(static_cast<unsigned char>(value)) {}
+    LogArg(std::string_view value) noexcept
+        : kind_(Kind::String), uint_(0), string_(value) {}
+    LogArg(const char* value) noexcept
+        : kind_(Kind::String), uint_(0), string_(value != nullptr ? value : "(null)") {}
+    LogArg(const std::string& value) noexcept
+        : kind_(Kind::String), uint_(0), string_(value) {}
+
+    template <typename T>
+        requires std::is_integral_v<T> && std::is_signed_v<T>
+    LogArg(T value) noexcept : kind_(Kind::Int), int_(value) {}
+
+    template <typename T>
+        requires std::is_integral_v<T> && std::is_unsigned_v<T>
+    LogArg(T value) noexcept : kind_(Kind::UInt), uint_(value) {}
+
+    template <typename T>
+        requires std::is_floating_point_v<T>
+    LogArg(T value) noexcept : kind_(Kind::Double), double_(static_cast<double>(value)) {}
+
+    template <typename T>
+        requires std::is_enum_v<T>
+    LogArg(T value) noexcept : LogArg(static_cast<std::underlying_type_t<T>>(value)) {}
+
+    [[nodiscard]] Kind kind() const noexcept { return kind_; }
+    [[nodiscard]] int64_t asInt() const noexcept { return int_; }
+    [[nodiscard]] uint64_t asUInt() const noexcept { return uint_; }
+    [[nodiscard]] double asDouble() const noexcept { return double_; }
+    [[nodiscard]] std::string_view asString() const noexcept { return string_; }
+
+private:
+    Kind kind_;
+    union {
+        int64_t int_;
+        uint64_t uint_;
+        double double_;
+    };
+    std::string_view string_;
+};
+
+/// What an async log call does when its thread's ring is full.
+enum class LogOverflowPolicy : uint8_t {
+    Drop,   ///< Discard the record.
+    Block,  ///< Wait for the writer thread to make room.
+    Sample  ///< Past 3/4 full keep one record in sampleRate; drop when full.
+};
+
+/// Async mode settings (GameLogger::setAsyncMode).
+struct AsyncLogConfig {
+    /// Records each producer thread's ring holds (rounded up to a power
+    /// of two).
+    std::size_t ringCapacity = 4096;
+
+    LogOverflowPolicy overflow = LogOverflowPolicy::Drop;
+
+    /// LogOverflowPolicy::Sample: while a ring is over 3/4 full, one
+    /// record in this many is kept.
+    uint32_t sampleRate = 16;
+
+    /// How long the writer sleeps once every ring is empty.
+    std::chrono::milliseconds idleWait{2};
+};
+
+/// Counters of async mode, summed over every producer ring.
+struct AsyncLogStats {
+    uint64_t enqueued = 0;    ///< Records pushed into a ring.
+    uint64_t written = 0;     ///< Records formatted and handed to kcenon.
+    uint64_t dropped = 0;     ///< Lost to a full ring.
+    uint64_t sampledOut = 0;  ///< Skipped by LogOverflowPolicy::Sample.
+    uint64_t blocked = 0;     ///< Calls that waited for room (LogOverflowPolicy::Block).
+    uint64_t spilled = 0;     ///< Records too large for a ring slot (one allocation each).
+};
+
+/// Per-category flood control (GameLogger::setCategoryRateLimit).
+///
+/// Every call site (each CGS_LOG macro expansion, or the category as a
+/// whole for direct calls) first keeps one call in sampleEvery, then
+/// spends a token from a bucket of @c burst tokens refilled at
+/// @c perSecond.  Suppressed calls are counted and reported as one
+/// "suppressed N messages" line per site at most every summaryInterval.
+struct LogRateLimit {
+    /// Tokens a site may spend at once; 0 disables the token bucket.
+    uint32_t burst = 0;
+
+    /// Tokens added per second (with burst > 0).
+    uint32_t perSecond = 0;
+
+    /// Keep one call in this many (1 keeps every call).
+    uint32_t sampleEvery = 1;
+
+    /// Minimum time between two summaries of one site.
+    std::chrono::milliseconds summaryInterval{10000};
+
+    /// Whether this limit suppresses anything at all.
+    [[nodiscard]] bool active() const noexcept { return burst > 0 || sampleEvery > 1; }
+};
+
+/// Limiter state of one log call site.  The CGS_LOG macros keep a static
+/// instance per expansion; direct calls share their category's.
+class LogSite {
+public:
+    constexpr LogSite() noexcept = default;
+    constexpr LogSite(const char* file, int line) noexcept : file_(file), line_(line) {}
+
+    LogSite(const LogSite&) = delete;
+    LogSite& operator=(const LogSite&) = delete;
+
+    [[nodiscard]] const char* file() const noexcept { return file_; }
+    [[nodiscard]] int line() const noexcept { return line_; }
+
+private:
+    friend class GameLogger;
+
+    const char* file_ = nullptr;
+    int line_ = 0;
+    std::atomic<uint64_t> calls_{0};       ///< Calls seen while sampling.
+    std::atomic<int64_t> tat_{0};          ///< Token bucket as GCRA arrival time (ns).
+    std::atomic<uint64_t> suppressed_{0};  ///< Not yet reported in a summary.
+    std::atomic<int64_t> summaryAt_{0};    ///< Start of the summary window (ns).
+};
+
+class BinaryLogWriter;
+
 /// Game-specific logger wrapping kcenon's logging system.
 ///
 /// Provides category-based filtering, structured logging with context,
@@ -148,6 +290,9 @@ public:
     /// No-op if the level is below the category's minimum level.
     void log(LogLevel level, LogCategory cat, std::string_view msg);
 
+    /// log() rate-limited as call site @p site (see LogRateLimit).
+    void log(LogSite& site, LogLevel level, LogCategory cat, std::string_view msg);
+
     /// Log a message with structured context data.
     /// Context fields are appended as key-value pairs to the log message.
     void logWithContext(LogLevel level,
@@ -155,6 +300,35 @@ public:
                         std::string_view msg,
                         const LogContext& ctx);
 
+    /// Log @p format with each `{}` replaced by the next of @p args
+    /// (`{{` and `}}` are literal braces).
+    ///
+    /// In async mode only the format pointer and the raw arguments are
+    /// recorded; formatting happens on the writer thread, which is why
+    /// @p format has to be a string literal.
+    template <std::size_t N, typename... Args>
+    void logf(LogLevel level, LogCategory cat, const char (&format)[N], const Args&... args) {
+        if (!isEnabled(level, cat)) {
+            return;
+        }
+        const std::array<LogArg, sizeof...(Args)> packed{LogArg(args)...};
+        logArgs(nullptr, level, cat, format, packed);
+    }
+
+    /// logf() rate-limited as call site @p site (see LogRateLimit).
+    template <std::size_t N, typename... Args>
+    void logf(LogSite& site,
+              LogLevel level,
+              LogCategory cat,
+              const char (&format)[N],
+              const Args&... args) {
+        if (!isEnabled(level, cat)) {
+            return;
+        }
+        const std::array<LogArg, sizeof...(Args)> packed{LogArg(args)...};
+        logArgs(&site, level, cat, format, packed);
+    }
+
     /// Set the minimum log level for a category at runtime.
     void setCategoryLevel(LogCategory cat, LogLevel minLevel);
 
@@ -164,6 +338,16 @@ public:
     /// Check if logging is enabled for the given level and category.
     [[nodiscard]] bool isEnabled(LogLevel level, LogCategory cat) const;
 
+    /// Rate-limit and sample a category's log calls; a default
+    /// LogRateLimit turns limiting off.  Categories without a limit pay
+    /// one relaxed atomic load per call.
+    void setCategoryRateLimit(LogCategory cat, LogRateLimit limit);
+
+    [[nodiscard]] LogRateLimit getCategoryRateLimit(LogCategory cat) const;
+
+    /// Calls of @p cat suppressed by its rate limit so far.
+    [[nodiscard]] uint64_t suppressedCount(LogCategory cat) const;
+
     /// Enable or disable JSON output mode (SRS-NFR-019).
     ///
     /// When enabled, log messages are formatted as single-line JSON objects
@@ -175,17 +359,72 @@ public:
     /// Check if JSON output mode is enabled.
     [[nodiscard]] bool isJsonMode() const;
 
+    /// Enable or disable async mode.
+    ///
+    /// While enabled, log(), logWithContext() and logf() push a record
+    /// (level, category, timestamp, message bytes or format pointer plus
+    /// arguments, context, correlation ID in JSON mode) into a per-thread
+    /// single-producer ring and return; one writer thread formats and
+    /// writes the records.  Records of one thread keep their order; the
+    /// order across threads is the writer's drain order.  Disabling
+    /// drains every ring and stops the writer; switch modes while no
+    /// other thread is logging.
+    void setAsyncMode(bool enabled, AsyncLogConfig config = {});
+
+    /// Check if async mode is enabled.
+    [[nodiscard]] bool isAsyncMode() const;
+
+    [[nodiscard]] AsyncLogStats asyncStats() const;
+
+    /// Write every record to @p sink instead of the kcenon loggers, or
+    /// return to text/JSON output when null.
+    ///
+    /// A logf() call is stored as its format id and raw arguments, so the
+    /// message is never rendered while the game runs.  Works with and
+    /// without async mode; in async mode records already queued go to the
+    /// previous destination.  Switch sinks while no other thread is
+    /// logging.
+    void setBinarySink(std::shared_ptr<BinaryLogWriter> sink);
+
+    /// Check if a binary sink is set.
+    [[nodiscard]] bool hasBinarySink() const;
+
     /// Flush all buffered log messages.
+    ///
+    /// In async mode this first writes every record already queued; a
+    /// binary sink writes its open segment.
     GameResult<void> flush();
 
     /// Get the global GameLogger singleton instance.
     static GameLogger& instance();
 
 private:
+    /// Apply @p cat's rate limit to @p site (the category's own when
+    /// null), writing a due suppression summary.  @return false to drop
+    /// the call.
+    bool admit(LogSite* site, LogLevel level, LogCategory cat);
+
+    void write(LogLevel level, LogCategory cat, std::string_view msg);
+
+    void logArgs(LogSite* site,
+                 LogLevel level,
+                 LogCategory cat,
+                 const char* format,
+                 std::span<const LogArg> args);
+
     struct Impl;
     std::unique_ptr<Impl> impl_;
 };
 
+namespace detail {
+
+/// Swallows the operands of a log macro compiled out by
+/// CGS_MIN_LOG_LEVEL, so they still type-check and count as used.
+template <typename... Args>
+constexpr void discardLogArgs(const Args&... /*args*/) noexcept {}
+
+}  // namespace detail
+
 }  // namespace cgs::foundation
 
 // ---------------------------------------------------------------------------
@@ -195,8 +434,18 @@ private:
 /// @name CGS_LOG Macros
 /// @brief Zero-cost logging macros with compile-time and runtime level checks.
 ///
-/// CGS_MIN_LOG_LEVEL can be defined before including this header to
-/// eliminate logging calls below the threshold at compile time.
+/// The message (CGS_LOG) or the format arguments (CGS_LOGF) are only
+/// evaluated once the level is known to be enabled, so
+/// `CGS_LOGF_DEBUG(cat, "entity {} at {}", id, describe(pos))` costs one
+/// atomic load when Debug is off.
+///
+/// Each expansion is its own LogSite for GameLogger::setCategoryRateLimit.
+///
+/// CGS_MIN_LOG_LEVEL can be defined before including this header (or
+/// with the CGS_STRIP_DEBUG_LOGS CMake option, which sets it to 2) to
+/// eliminate logging calls below the threshold at compile time: the
+/// per-level macros below it expand to a discarded `if constexpr` branch,
+/// and no code or string literal is emitted for them.
 /// Values: 0=Trace, 1=Debug, 2=Info, 3=Warning, 4=Error, 5=Critical, 6=Off
 /// @{
 
@@ -206,23 +455,79 @@ private:
 
 #define CGS_LOG(level, cat, msg)                                                                  \
     do {                                                                                          \
+        static ::cgs::foundation::LogSite cgsLogSite_(__FILE__, __LINE__);                        \
         _Pragma("GCC diagnostic push") _Pragma(                                                   \
             "GCC diagnostic ignored \"-Wtype-limits\"") if (static_cast<int>(level) >=            \
                                                                 CGS_MIN_LOG_LEVEL &&              \
                                                             ::cgs::foundation::GameLogger::       \
                                                                 instance()                        \
                                                                     .isEnabled((level), (cat))) { \
-            ::cgs::foundation::GameLogger::instance().log((level), (cat), (msg));                 \
+            ::cgs::foundation::GameLogger::instance().log(cgsLogSite_, (level), (cat), (msg));    \
         }                                                                                         \
         _Pragma("GCC diagnostic pop")                                                             \
     } while (0)
 
+/// Like CGS_LOG with GameLogger::logf() formatting:
+/// `CGS_LOGF(level, cat, "format {}", args...)`.
+#define CGS_LOGF(level, cat, ...)                                                               \
+    do {                                                                                        \
+        static ::cgs::foundation::LogSite cgsLogSite_(__FILE__, __LINE__);                      \
+        _Pragma("GCC diagnostic push")                                                          \
+            _Pragma("GCC diagnostic ignored \"-Wtype-limits\"") if (                            \
+                static_cast<int>(level) >= CGS_MIN_LOG_LEVEL &&                                 \
+                ::cgs::foundation::GameLogger::instance().isEnabled((level), (cat))) {          \
+            ::cgs::foundation::GameLogger::instance().logf(                                     \
+                cgsLogSite_, (level), (cat), __VA_ARGS__);                                      \
+        }                                                                                       \
+        _Pragma("GCC diagnostic pop")                                                           \
+    } while (0)
+
+/// Expansion of a per-level macro below CGS_MIN_LOG_LEVEL.
+#define CGS_LOG_STRIPPED(...)                                         \
+    do {                                                              \
+        if constexpr (false) {                                        \
+            ::cgs::foundation::detail::discardLogArgs(__VA_ARGS__);   \
+        }                                                             \
+    } while (0)
+
+#if CGS_MIN_LOG_LEVEL <= 0
+#define CGS_LOG_TRACE(cat, msg) CGS_LOG(::cgs::foundation::LogLevel::Trace, (cat), (msg))
+#define CGS_LOGF_TRACE(cat, ...) CGS_LOGF(::cgs::foundation::LogLevel::Trace, (cat), __VA_ARGS__)
+#else
+#define CGS_LOG_TRACE(cat, msg) CGS_LOG_STRIPPED((cat), (msg))
+#define CGS_LOGF_TRACE(cat, ...) CGS_LOG_STRIPPED((cat), __VA_ARGS__)
+#endif
+
+#if CGS_MIN_LOG_LEVEL <= 1
 #define CGS_LOG_DEBUG(cat, msg) CGS_LOG(::cgs::foundation::LogLevel::Debug, (cat), (msg))
+#define CGS_LOGF_DEBUG(cat, ...) CGS_LOGF(::cgs::foundation::LogLevel::Debug, (cat), __VA_ARGS__)
+#else
+#define CGS_LOG_DEBUG(cat, msg) CGS_LOG_STRIPPED((cat), (msg))
+#define CGS_LOGF_DEBUG(cat, ...) CGS_LOG_STRIPPED((cat), __VA_ARGS__)
+#endif
 
+#if CGS_MIN_LOG_LEVEL <= 2
 #define CGS_LOG_INFO(cat, msg) CGS_LOG(::cgs::foundation::LogLevel::Info, (cat), (msg))
+#define CGS_LOGF_INFO(cat, ...) CGS_LOGF(::cgs::foundation::LogLevel::Info, (cat), __VA_ARGS__)
+#else
+#define CGS_LOG_INFO(cat, msg) CGS_LOG_STRIPPED((cat), (msg))
+#define CGS_LOGF_INFO(cat, ...) CGS_LOG_STRIPPED((cat), __VA_ARGS__)
+#endif
 
+#if CGS_MIN_LOG_LEVEL <= 3
 #define CGS_LOG_WARN(cat, msg) CGS_LOG(::cgs::foundation::LogLevel::Warning, (cat), (msg))
+#define CGS_LOGF_WARN(cat, ...) CGS_LOGF(::cgs::foundation::LogLevel::Warning, (cat), __VA_ARGS__)
+#else
+#define CGS_LOG_WARN(cat, msg) CGS_LOG_STRIPPED((cat), (msg))
+#define CGS_LOGF_WARN(cat, ...) CGS_LOG_STRIPPED((cat), __VA_ARGS__)
+#endif
 
+#if CGS_MIN_LOG_LEVEL <= 4
 #define CGS_LOG_ERROR(cat, msg) CGS_LOG(::cgs::foundation::LogLevel::Error, (cat), (msg))
+#define CGS_LOGF_ERROR(cat, ...) CGS_LOGF(::cgs::foundation::LogLevel::Error, (cat), __VA_ARGS__)
+#else
+#define CGS_LOG_ERROR(cat, msg) CGS_LOG_STRIPPED((cat), (msg))
+#define CGS_LOGF_ERROR(cat, ...) CGS_LOG_STRIPPED((cat), __VA_ARGS__)
+#endif
 
 /// @}
@@ -10,9 +10,15 @@
 /// CMakeLists.txt need to change.
 /// Part of the Monitoring System Adapter (SDS-MOD-006).
 
+#include "cgs/foundation/trace_context.hpp"
+
+#include <array>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <span>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -39,19 +45,237 @@ struct HistogramBuckets {
     std::vector<double> boundaries;
 };
 
+// ── Metric handles ──────────────────────────────────────────────────────────
+
+namespace detail {
+struct CounterCell;
+struct GaugeCell;
+struct HistogramCell;
+template <typename Cell>
+struct FamilyCell;
+}  // namespace detail
+
+template <typename Handle>
+class MetricFamily;
+
+/// Pre-registered counter (GameMetrics::registerCounter).
+///
+/// increment() is one relaxed atomic add to the calling thread's
+/// cache-line-padded shard of the counter: no name lookup, no lock, and
+/// no line shared with other threads.  Shards are summed on read.
+/// A default-constructed handle ignores increments.  Handles stay valid
+/// for the lifetime of the GameMetrics that issued them.
+class CounterHandle {
+public:
+    CounterHandle() = default;
+
+    void increment(uint64_t value = 1) const noexcept;
+
+    /// Sum over all shards.
+    [[nodiscard]] uint64_t value() const noexcept;
+
+    [[nodiscard]] bool valid() const noexcept { return cell_ != nullptr; }
+
+private:
+    friend class GameMetrics;
+    friend class MetricFamily<CounterHandle>;
+    using Cell = detail::CounterCell;
+    explicit CounterHandle(detail::CounterCell* cell) noexcept : cell_(cell) {}
+
+    detail::CounterCell* cell_ = nullptr;
+};
+
+/// Pre-registered gauge (GameMetrics::registerGauge): updates skip the
+/// name lookup and lock.  A gauge holds one atomic value because set()
+/// is absolute and cannot be split across shards.
+class GaugeHandle {
+public:
+    GaugeHandle() = default;
+
+    void set(double value) const noexcept;
+    void increment(double delta = 1.0) const noexcept;
+    void decrement(double delta = 1.0) const noexcept;
+
+    [[nodiscard]] double value() const noexcept;
+
+    [[nodiscard]] bool valid() const noexcept { return cell_ != nullptr; }
+
+private:
+    friend class GameMetrics;
+    friend class MetricFamily<GaugeHandle>;
+    using Cell = detail::GaugeCell;
+    explicit GaugeHandle(detail::GaugeCell* cell) noexcept : cell_(cell) {}
+
+    detail::GaugeCell* cell_ = nullptr;
+};
+
+/// Registered histogram (GameMetrics::histogramHandle).
+///
+/// record() is lock-free: it bumps the calling thread's shard of the
+/// fixed Prometheus buckets and of a log-linear (HDR-style) sketch, 16
+/// sub-buckets per power of two, so quantile() is within ~3% of the true
+/// value from 2^-16 to 2^48.  Shards are merged on read.
+class HistogramHandle {
+public:
+    HistogramHandle() = default;
+
+    void record(double value) const noexcept;
+
+    /// Approximate @p q quantile (0 <= q <= 1) of the recorded values;
+    /// 0 if there are none.
+    [[nodiscard]] double quantile(double q) const;
+
+    [[nodiscard]] uint64_t count() const noexcept;
+
+    [[nodiscard]] bool valid() const noexcept { return cell_ != nullptr; }
+
+private:
+    friend class GameMetrics;
+    friend class MetricFamily<HistogramHandle>;
+    using Cell = detail::HistogramCell;
+    explicit HistogramHandle(detail::HistogramCell* cell) noexcept : cell_(cell) {}
+
+    detail::HistogramCell* cell_ = nullptr;
+};
+
+// ── Labeled families ────────────────────────────────────────────────────────
+
+/// Label value of the shared child that label sets beyond a family's
+/// series limit are bound to.
+inline constexpr std::string_view kOverflowLabelValue = "__overflow__";
+
+/// A metric with declared label keys (GameMetrics::registerCounterFamily
+/// and friends), scraped as one Prometheus family.
+///
+/// bind() resolves a label set to its child metric once, under the
+/// family's own lock; the caller keeps the returned handle and updates
+/// it lock-free from then on.  Once a family holds its maxSeries label
+/// sets, new ones bind to a single overflow child whose every label is
+/// kOverflowLabelValue, so an unbounded label (a player id, a malformed
+/// opcode) cannot grow memory or scrape() output without limit.
+///
+/// Usage:
+/// @code
+///   auto messages = metrics.registerCounterFamily("cgs_messages_total", {"opcode"});
+///   auto login = messages.bind("0x0101");  // Once, e.g. at handler registration
+///   login.increment();                      // Per message
+/// @endcode
+template <typename Handle>
+class MetricFamily {
+public:
+    MetricFamily() = default;
+
+    /// Child for one value per label key, in declaration order.  An
+    /// invalid handle if the number of values does not match.
+    template <typename... Values>
+    [[nodiscard]] Handle bind(const Values&... values) const {
+        const std::array<std::string_view, sizeof...(Values)> list{std::string_view(values)...};
+        return bindValues(list);
+    }
+
+    /// bind() for a runtime list of values.
+    [[nodiscard]] Handle bindValues(std::span<const std::string_view> values) const;
+
+    /// Distinct label sets bound, not counting the overflow child.
+    [[nodiscard]] std::size_t size() const;
+
+    /// bind() calls diverted to the overflow child.
+    [[nodiscard]] uint64_t overflowed() const;
+
+    [[nodiscard]] bool valid() const noexcept { return cell_ != nullptr; }
+
+private:
+    friend class GameMetrics;
+    explicit MetricFamily(detail::FamilyCell<typename Handle::Cell>* cell) noexcept
+        : cell_(cell) {}
+
+    detail::FamilyCell<typename Handle::Cell>* cell_ = nullptr;
+};
+
+using CounterFamily = MetricFamily<CounterHandle>;
+using GaugeFamily = MetricFamily<GaugeHandle>;
+using HistogramFamily = MetricFamily<HistogramHandle>;
+
 // ── Tracing ─────────────────────────────────────────────────────────────────
 
 /// A lightweight trace span for distributed tracing.
 ///
 /// Call GameMetrics::startSpan() to begin a span and endSpan() to complete it.
 /// The span records wall-clock start time and a monotonic duration.
+/// Pass context() to downstream work (NetworkMessage::trace) so its spans
+/// join the same trace.
 struct TraceSpan {
-    uint64_t id{0};
+    uint64_t id{0};  ///< Span id, unique per process (and random).
     std::string name;
     std::chrono::steady_clock::time_point startTime{};
     bool ended{false};
+
+    uint64_t traceIdHigh{0};
+    uint64_t traceIdLow{0};
+    uint64_t parentId{0};  ///< 0 for the root span of a trace.
+    bool sampled{false};   ///< Head sampling decision, shared by the trace.
+    bool error{false};     ///< Set before endSpan(); errored spans are always kept.
+    std::chrono::system_clock::time_point wallStart{};
+
+    /// Trace context naming this span as the parent.
+    [[nodiscard]] TraceContext context() const noexcept {
+        return TraceContext{traceIdHigh, traceIdLow, id,
+                            sampled ? TraceContext::kSampledFlag : uint8_t{0}};
+    }
+};
+
+/// A finished span as handed to a SpanExporter.
+struct SpanRecord {
+    TraceContext context;  ///< Trace id, span id and sampled flag.
+    uint64_t parentId = 0;
+    std::string name;
+    std::chrono::system_clock::time_point start{};
+    std::chrono::nanoseconds duration{0};
+    bool error = false;
+};
+
+/// Receives batches of finished spans on the exporter thread.
+using SpanExporter = std::function<void(std::span<const SpanRecord>)>;
+
+/// Span sampling and export (GameMetrics::startTracing()).
+///
+/// Head sampling keeps a sampleRatio share of traces, decided once from
+/// the trace id so every service keeps the same traces.  Tail sampling
+/// additionally keeps any span slower than tailLatency or marked as an
+/// error, so the slow logins and failing queries are there even when
+/// their trace was not head-sampled.
+struct TracingConfig {
+    /// Share of new traces sampled at their root (0..1).
+    double sampleRatio = 0.01;
+
+    /// Keep any span at least this long (0 disables tail sampling).
+    std::chrono::microseconds tailLatency{0};
+
+    /// Finished spans buffered for the exporter; more are dropped.
+    std::size_t queueCapacity = 8192;
+
+    /// Spans per exporter call.
+    std::size_t batchSize = 512;
+
+    /// Longest a finished span waits for a batch to fill.
+    std::chrono::milliseconds flushInterval{1000};
 };
 
+/// Counters of span collection since startTracing().
+struct TracingStats {
+    uint64_t started = 0;     ///< Spans begun.
+    uint64_t sampledOut = 0;  ///< Ended without being kept.
+    uint64_t tailKept = 0;    ///< Kept only by tail sampling.
+    uint64_t dropped = 0;     ///< Kept, but the export queue was full.
+    uint64_t exported = 0;    ///< Handed to the exporter.
+    uint64_t batches = 0;     ///< Exporter calls.
+};
+
+/// Encode @p spans as an OTLP/JSON ExportTraceServiceRequest (the body
+/// of a POST to a collector's /v1/traces) for service @p serviceName.
+[[nodiscard]] std::string encodeOtlpJson(std::span<const SpanRecord> spans,
+                                         std::string_view serviceName);
+
 // ── Health checking ─────────────────────────────────────────────────────────
 
 /// Overall health status of a component or the service itself.
@@ -70,9 +294,11 @@ struct HealthCheckResult {
 /// Central metrics facade providing counters, gauges, histograms, trace spans,
 /// health status, and Prometheus text-format export.
 ///
-/// Thread-safe: counters and gauges use atomic operations; histograms and
-/// health maps are mutex-protected. The class is non-copyable but movable
-/// (PIMPL pattern).
+/// Thread-safe: counters, gauges and histograms use atomic operations;
+/// the name maps and health state are mutex-protected.  Name-based
+/// updates take a lock for the lookup; hot paths should hold a
+/// CounterHandle / GaugeHandle / HistogramHandle instead. The class is
+/// non-copyable but movable (PIMPL pattern).
 ///
 /// Example:
 /// @code
@@ -102,6 +328,10 @@ public:
     /// Read the current counter value. Returns 0 if the counter does not exist.
     [[nodiscard]] uint64_t counterValue(std::string_view name) const;
 
+    /// Create (or find) counter @p name and return a handle for hot-path
+    /// increments.  The name-based calls see the same counter.
+    [[nodiscard]] CounterHandle registerCounter(std::string_view name);
+
     // ── Gauges ──────────────────────────────────────────────────────────
 
     /// Set a gauge to an absolute value. Creates the gauge on first use.
@@ -116,6 +346,10 @@ public:
     /// Read the current gauge value. Returns 0.0 if the gauge does not exist.
     [[nodiscard]] double gaugeValue(std::string_view name) const;
 
+    /// Create (or find) gauge @p name and return a handle for hot-path
+    /// updates.  The name-based calls see the same gauge.
+    [[nodiscard]] GaugeHandle registerGauge(std::string_view name);
+
     // ── Histograms ──────────────────────────────────────────────────────
 
     /// Register a histogram with the given bucket boundaries.
@@ -126,14 +360,65 @@ public:
     /// No-op if the histogram has not been registered.
     void recordHistogram(std::string_view name, double value);
 
+    /// Handle for lock-free recording into histogram @p name, which
+    /// registerHistogram() must have created (otherwise the handle is
+    /// invalid).
+    [[nodiscard]] HistogramHandle histogramHandle(std::string_view name);
+
+    /// Approximate @p q quantile of histogram @p name; 0 if it does not
+    /// exist or is empty.
+    [[nodiscard]] double histogramQuantile(std::string_view name, double q) const;
+
+    // ── Labeled families ────────────────────────────────────────────────
+
+    /// Create (or find) counter family @p name with @p labelKeys, holding
+    /// at most @p maxSeries label sets plus the overflow child.  A family
+    /// found by name keeps the keys and limit it was created with.
+    [[nodiscard]] CounterFamily registerCounterFamily(std::string_view name,
+                                                      std::vector<std::string> labelKeys,
+                                                      std::size_t maxSeries = 1024);
+
+    /// registerCounterFamily() for gauges.
+    [[nodiscard]] GaugeFamily registerGaugeFamily(std::string_view name,
+                                                  std::vector<std::string> labelKeys,
+                                                  std::size_t maxSeries = 1024);
+
+    /// registerCounterFamily() for histograms sharing @p buckets.  The
+    /// default limit is lower: each child carries its own sketch shards.
+    [[nodiscard]] HistogramFamily registerHistogramFamily(std::string_view name,
+                                                          std::vector<std::string> labelKeys,
+                                                          HistogramBuckets buckets,
+                                                          std::size_t maxSeries = 64);
+
     // ── Tracing ─────────────────────────────────────────────────────────
 
     /// Begin a new trace span with a unique ID and the current timestamp.
+    /// It is the root of a new trace, head-sampled per TracingConfig.
     [[nodiscard]] TraceSpan startSpan(std::string_view name);
 
-    /// End a span, recording its completion.
+    /// Begin a child span of @p parent (a span of this or another
+    /// service), inheriting its trace and sampling decision.  Starts a
+    /// new trace if @p parent is invalid.
+    [[nodiscard]] TraceSpan startSpan(std::string_view name, const TraceContext& parent);
+
+    /// End a span, recording its completion.  While tracing, a kept span
+    /// is queued for export without blocking; the exporter thread does
+    /// the rest.
     void endSpan(TraceSpan& span);
 
+    /// Start collecting spans and handing them, in batches, to
+    /// @p exporter on a background thread.  Restarts tracing (flushing
+    /// the old exporter) if it is already running.
+    void startTracing(TracingConfig config, SpanExporter exporter);
+
+    /// Export the queued spans and stop the exporter thread.  Spans are
+    /// no longer collected afterwards.
+    void stopTracing();
+
+    [[nodiscard]] bool isTracing() const noexcept;
+
+    [[nodiscard]] TracingStats tracingStats() const noexcept;
+
     // ── Health ──────────────────────────────────────────────────────────
 
     /// Set the health status of a named component.
@@ -146,11 +431,27 @@ public:
     // ── Export ───────────────────────────────────────────────────────────
 
     /// Serialize all metrics in Prometheus text exposition format.
+    ///
+    /// Each histogram is followed by a `<name>_quantile` gauge family
+    /// with sketch-derived p50, p90, p99 and p99.9.
+    ///
+    /// The text is rendered into a reusable buffer from a snapshot of
+    /// the values; the name-map locks are held only while the series are
+    /// listed, never while formatting, so writers are not blocked.
+    /// Concurrent scrapes are serialized.
     [[nodiscard]] std::string scrape() const;
 
+    /// Serve scrape() from the last rendered body while it is younger
+    /// than @p ttl (0, the default, renders every call).  Lets several
+    /// Prometheus replicas share one rendering per interval.
+    void setScrapeCacheTtl(std::chrono::milliseconds ttl);
+
     // ── Utility ─────────────────────────────────────────────────────────
 
     /// Clear all metrics, histograms, and health state. Intended for tests.
+    /// Registered counters and gauges, histograms with a handle issued,
+    /// and every family child are zeroed instead, so their handles stay
+    /// valid (and they keep appearing in scrape()).
     void reset();
 
     // ── Singleton ───────────────────────────────────────────────────────
@@ -8,9 +8,15 @@
 /// tracking, and opcode-based dispatch. Part of the Network System Adapter
 /// (SDS-MOD-004).
 
+#include "cgs/foundation/cpu_affinity.hpp"
 #include "cgs/foundation/game_result.hpp"
+#include "cgs/foundation/outbound_queue.hpp"
+#include "cgs/foundation/payload_codec.hpp"
+#include "cgs/foundation/reliable_channel.hpp"
 #include "cgs/foundation/signal.hpp"
+#include "cgs/foundation/tls_ticket_keys.hpp"
 #include "cgs/foundation/types.hpp"
+#include "cgs/foundation/wire_buffer.hpp"
 
 #include <chrono>
 #include <cstdint>
@@ -18,10 +24,13 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace cgs::foundation {
 
+class GameMetrics;
+
 /// Supported network transport protocols.
 enum class Protocol : uint8_t { TCP, UDP, WebSocket };
 
@@ -56,6 +65,22 @@ struct TlsConfig {
     /// Whether to verify client certificates (mutual TLS).
     bool verifyPeer = false;
 
+    /// Session-ticket keys shared with the other gateway replicas, so a
+    /// client could resume its session on any of them.  Must stay null
+    /// for now: the network facade takes no ticket-key callback, so
+    /// listen() refuses a ring with ErrorCode::TlsNotSupported.
+    std::shared_ptr<TlsTicketKeyRing> ticketKeys;
+
+    /// How long an issued ticket stays valid.  Keep a retired key in the
+    /// ring at least this long.
+    std::chrono::seconds ticketLifetime{std::chrono::hours(2)};
+
+    /// Hand record encryption to kernel TLS after the handshake.  Must
+    /// stay false for now: the network facade does not expose its sockets
+    /// for TLS_TX/TLS_RX, so listen() refuses it with
+    /// ErrorCode::TlsNotSupported.
+    bool kernelOffload = false;
+
     /// Validate that required fields are present.
     [[nodiscard]] bool isValid() const { return !certPath.empty() && !keyPath.empty(); }
 };
@@ -63,16 +88,27 @@ struct TlsConfig {
 /// Application-level message with opcode and binary payload.
 ///
 /// Wire format (serialize/deserialize):
-///   [4 bytes: total length (network order)]
+///   [4 bytes: total length (network order); top bit: payload compressed;
+///    next bit: trace context present]
 ///   [2 bytes: opcode (network order)]
+///   [25 bytes: TraceContext, if present]
 ///   [N bytes: payload]
 struct NetworkMessage {
     uint16_t opcode = 0;
     std::vector<uint8_t> payload;
+    /// @p payload is a PayloadCompressor block.  GameNetworkManager
+    /// decodes such frames before dispatch, so handlers never see one.
+    bool compressed = false;
+    /// Span of the sender this message belongs to; sent only when valid.
+    /// Handlers continue the trace with GameMetrics::startSpan(name, trace).
+    TraceContext trace;
 
     /// Serialize to wire format: [4-byte length][2-byte opcode][payload].
     [[nodiscard]] std::vector<uint8_t> serialize() const;
 
+    /// Serialize into a pooled WireBuffer (the same bytes as serialize()).
+    [[nodiscard]] WireBuffer frame(WireBufferPool& pool) const;
+
     /// Deserialize from wire bytes. Returns nullopt on malformed input.
     [[nodiscard]] static std::optional<NetworkMessage> deserialize(const uint8_t* data,
                                                                    std::size_t size);
@@ -92,14 +128,37 @@ struct SessionInfo {
     std::string remoteAddress;
     std::chrono::steady_clock::time_point connectedAt;
     std::chrono::steady_clock::time_point lastActivity;
+    std::size_t outboundQueueDepth = 0;  ///< Coalesced messages awaiting flush().
+    std::size_t outboundBytes = 0;       ///< Bytes of those messages.
 };
 
+/// Counters of one reactor (see GameNetworkManager::setReactors()).
+struct ReactorStats {
+    uint64_t received = 0;     ///< Transport callbacks routed to the reactor.
+    uint64_t decoded = 0;      ///< Messages decoded from them.
+    uint64_t stalls = 0;       ///< Times the reactor waited for a full queue.
+    uint64_t fanouts = 0;      ///< sendToGroup() shares the reactor sent.
+    std::size_t pending = 0;   ///< Messages awaiting dispatchInbound().
+};
+
+struct SessionGroupIdTag {};
+
+/// Handle of a session group (see GameNetworkManager::createGroup()).
+using SessionGroupId = StrongId<SessionGroupIdTag>;
+
 /// Protocol-agnostic network manager wrapping kcenon's network_system.
 ///
 /// Manages TCP/UDP/WebSocket servers, tracks sessions, and dispatches incoming
 /// messages to registered opcode handlers. Uses PIMPL to hide all kcenon
 /// implementation details from the public API.
 ///
+/// Sessions are kept in 16 lock-sharded tables keyed by SessionId, so
+/// connects and disconnects only contend with sends to the same shard.
+/// broadcast(), flush() and inbound dispatch walk an immutable snapshot of
+/// all sessions that is republished on every connect and disconnect, and
+/// sessionCount() is a single atomic read.  Session groups keep member
+/// lists for sendToGroup() that follow connects and disconnects.
+///
 /// Signals are provided for connection lifecycle events:
 /// - onConnected:    SessionId of the newly connected client
 /// - onDisconnected: SessionId of the disconnected client
@@ -137,7 +196,8 @@ public:
     ///
     /// Enforces TLS 1.3 minimum and disables insecure cipher suites.
     /// Currently supported for TCP only; other protocols return
-    /// ErrorCode::TlsNotSupported.
+    /// ErrorCode::TlsNotSupported, as do TlsConfig::ticketKeys and
+    /// TlsConfig::kernelOffload, which the TLS stack cannot apply yet.
     [[nodiscard]] GameResult<void> listen(uint16_t port, Protocol protocol, const TlsConfig& tls);
 
     /// Stop the server for a specific protocol.
@@ -149,17 +209,226 @@ public:
     // ── Session I/O ─────────────────────────────────────────────────────────
 
     /// Send a framed NetworkMessage to a specific session.
-    [[nodiscard]] GameResult<void> send(SessionId session, const NetworkMessage& msg);
+    ///
+    /// @p lane and @p stateKey only matter while coalescing is enabled
+    /// (see setCoalescing()); a message refused by a full lane returns
+    /// ErrorCode::SendQueueFull.
+    [[nodiscard]] GameResult<void> send(SessionId session,
+                                        const NetworkMessage& msg,
+                                        SendLane lane = SendLane::Critical,
+                                        uint64_t stateKey = 0);
+
+    /// Send a NetworkMessage on a delivery channel.
+    ///
+    /// On UDP sessions running the reliability layer (see
+    /// setUdpReliability()) @p channel picks unreliable-sequenced,
+    /// reliable-ordered or reliable-unordered delivery; the lane overloads
+    /// use ReliableOrdered there.  Stream sessions are already reliable
+    /// and ordered, so they ignore @p channel.
+    [[nodiscard]] GameResult<void> send(SessionId session,
+                                        const NetworkMessage& msg,
+                                        DeliveryChannel channel);
 
     /// Broadcast a framed NetworkMessage to all connected sessions.
-    [[nodiscard]] GameResult<void> broadcast(const NetworkMessage& msg);
+    [[nodiscard]] GameResult<void> broadcast(const NetworkMessage& msg,
+                                             SendLane lane = SendLane::Critical,
+                                             uint64_t stateKey = 0);
 
-    /// Close a specific session.
+    /// Send an already framed buffer to a specific session.
+    ///
+    /// When @p frame is the only handle to its bytes (pass it with
+    /// std::move) they are handed to the transport without a copy.
+    [[nodiscard]] GameResult<void> send(SessionId session,
+                                        WireBuffer frame,
+                                        SendLane lane = SendLane::Critical,
+                                        uint64_t stateKey = 0);
+
+    /// Broadcast an already framed buffer to all connected sessions.
+    ///
+    /// The frame is built once and shared; kcenon sessions take ownership
+    /// of a byte vector, so each recipient still receives its own copy of
+    /// the finished frame.  Sessions whose lane is full skip the frame.
+    [[nodiscard]] GameResult<void> broadcast(const WireBuffer& frame,
+                                             SendLane lane = SendLane::Critical,
+                                             uint64_t stateKey = 0);
+
+    /// Pool used to frame NetworkMessages for send() and broadcast().
+    /// Callers may frame into it directly to share one frame.
+    [[nodiscard]] WireBufferPool& wirePool();
+
+    /// Close a specific session.  Queued outbound messages are flushed
+    /// first.
     void close(SessionId session);
 
+    // ── Session groups ──────────────────────────────────────────────────────
+
+    /// Create a set of sessions to multicast to (a party, guild, raid or
+    /// map cell), optionally under a unique @p name.
+    /// @return ErrorCode::AlreadyExists if @p name is taken.
+    [[nodiscard]] GameResult<SessionGroupId> createGroup(std::string_view name = {});
+
+    /// Handle of the group created under @p name, if any.
+    [[nodiscard]] std::optional<SessionGroupId> findGroup(std::string_view name) const;
+
+    /// Destroy @p group and its name.
+    [[nodiscard]] GameResult<void> destroyGroup(SessionGroupId group);
+
+    /// Add @p session to @p group (a no-op if already a member).  Sessions
+    /// leave every group when they disconnect.
+    /// @return ErrorCode::NotFound for an unknown group,
+    ///         ErrorCode::SessionNotFound for an unknown session.
+    [[nodiscard]] GameResult<void> addToGroup(SessionGroupId group, SessionId session);
+
+    /// Remove @p session from @p group (a no-op if not a member).
+    [[nodiscard]] GameResult<void> removeFromGroup(SessionGroupId group, SessionId session);
+
+    /// Number of sessions in @p group, or nullopt for an unknown group.
+    [[nodiscard]] std::optional<std::size_t> groupSize(SessionGroupId group) const;
+
+    /// Send a framed NetworkMessage to every session in @p group.
+    [[nodiscard]] GameResult<void> sendToGroup(SessionGroupId group,
+                                               const NetworkMessage& msg,
+                                               SendLane lane = SendLane::Critical,
+                                               uint64_t stateKey = 0);
+
+    /// Send an already framed buffer to every session in @p group.
+    ///
+    /// Membership changes are applied to the group's member list, which is
+    /// split by reactor on the first send after a change; sends then only
+    /// take a reference to it.  The frame is shared (and compressed at
+    /// most once) across members.  With setReactors() on, each reactor
+    /// sends the share pinned to it while the caller sends any share whose
+    /// reactor is busy decoding; the call returns once every member has
+    /// the frame, so it stays ordered with send() to the same session.
+    /// @return ErrorCode::NotFound for an unknown group.
+    [[nodiscard]] GameResult<void> sendToGroup(SessionGroupId group,
+                                               const WireBuffer& frame,
+                                               SendLane lane = SendLane::Critical,
+                                               uint64_t stateKey = 0);
+
+    // ── Outbound coalescing ─────────────────────────────────────────────────
+
+    /// Queue send() and broadcast() output per session instead of handing
+    /// each message to the transport.  A session's queue is written as one
+    /// batch by flush() -- call it at the end of every tick -- or as soon
+    /// as it holds @p flushThreshold bytes.  Queued messages are drained
+    /// by lane priority (Critical, State, Bulk), within the lane budgets
+    /// of setLaneBudgets().  Disabling flushes every queue.
+    void setCoalescing(bool enabled,
+                       std::size_t flushThreshold = OutboundQueue::kDefaultFlushThreshold);
+
+    [[nodiscard]] bool coalescingEnabled() const noexcept;
+
+    /// Byte budgets of every session's coalescing lanes, including the
+    /// per-flush limit that stands in for client bandwidth.  Applies to
+    /// existing and future sessions.
+    void setLaneBudgets(const LaneBudgets& budgets);
+
+    [[nodiscard]] LaneBudgets laneBudgets() const;
+
+    /// Hand every session's queued batch to the transport, then run
+    /// updateReliability().
+    void flush();
+
+    /// Hand @p session's queued batch (or due datagrams) to the transport.
+    [[nodiscard]] GameResult<void> flush(SessionId session);
+
+    /// Outbound queue depth, bytes in flight and batch counters of
+    /// @p session, or nullopt for an unknown session.
+    [[nodiscard]] std::optional<OutboundStats> outboundStats(SessionId session) const;
+
+    // ── Reactors ────────────────────────────────────────────────────────────
+
+    /// Decode inbound traffic on @p count reactor threads instead of the
+    /// transport's callback thread (0 restores callback dispatch).
+    ///
+    /// Each session is pinned to one reactor, which runs its reliability
+    /// layer and frame parsing and queues the decoded messages in a
+    /// per-reactor single-producer/single-consumer queue of
+    /// @p queueCapacity entries.  Handlers then run on the thread that
+    /// calls dispatchInbound(), so a session's messages keep their order
+    /// and no shared structure is touched per message.  Connection signals
+    /// still fire on the transport thread.  With a non-empty @p affinity,
+    /// reactor i is pinned to CPU affinity[i % size] (see
+    /// ThreadPlacement::network).
+    ///
+    /// @return ErrorCode::InvalidArgument once a server is listening.
+    [[nodiscard]] GameResult<void> setReactors(std::size_t count,
+                                               std::size_t queueCapacity = 4096,
+                                               CpuSet affinity = {});
+
+    [[nodiscard]] std::size_t reactorCount() const noexcept;
+
+    /// Run the handlers of up to @p maxMessages decoded messages, and
+    /// emit onError for malformed input.  Call from one thread (usually
+    /// the game thread, once per tick).
+    /// @return the number of messages dispatched.
+    std::size_t dispatchInbound(std::size_t maxMessages = SIZE_MAX);
+
+    /// Counters of every reactor, in reactor order.
+    [[nodiscard]] std::vector<ReactorStats> reactorStats() const;
+
+    // ── Payload compression ─────────────────────────────────────────────────
+
+    /// Compress large payloads for the sessions that accept it.
+    ///
+    /// Frames are compressed as they are handed to send(), broadcast() or
+    /// the coalescing queue -- a broadcast frame once for all its
+    /// recipients -- when @p config's size threshold and per-opcode
+    /// backoff allow.  Compressed frames set the top bit of the length
+    /// word and carry [original size][LZ4 block] primed with
+    /// @p dictionary, which the peer must hold too (compare
+    /// CompressionDictionary::id() when negotiating).  Received
+    /// compressed frames are decoded where frames are parsed: on the
+    /// reactor threads when setReactors() is on.
+    ///
+    /// @return ErrorCode::InvalidArgument once a server is listening.
+    [[nodiscard]] GameResult<void> setCompression(bool enabled,
+                                                  CompressionConfig config = {},
+                                                  CompressionDictionary dictionary = {});
+
+    [[nodiscard]] bool compressionEnabled() const noexcept;
+
+    /// Compress @p session's outbound frames or stop doing so, e.g. once
+    /// the peer has agreed to it (see CompressionConfig::enabledByDefault).
+    /// @return ErrorCode::InvalidArgument if compression is off.
+    [[nodiscard]] GameResult<void> setSessionCompression(SessionId session, bool enabled);
+
+    /// Compression counters, or nullopt while compression is off.
+    [[nodiscard]] std::optional<CompressionStats> compressionStats() const;
+
+    /// Add the compression counters accumulated since the last call to
+    /// @p metrics (cgs_net_compress*) and set the cgs_net_compression_ratio
+    /// gauge.  Call once per tick or scrape.
+    void publishCompressionMetrics(GameMetrics& metrics);
+
+    // ── UDP reliability ─────────────────────────────────────────────────────
+
+    /// Run UDP sessions that connect from now on over a ReliableEndpoint:
+    /// each datagram then carries selective acks, and messages are sent on
+    /// the channel chosen in send().  Both peers must agree; plain UDP
+    /// sessions keep sending raw frames.
+    void setUdpReliability(bool enabled);
+
+    [[nodiscard]] bool udpReliabilityEnabled() const noexcept;
+
+    /// Send every reliable UDP session's owed acks and timed-out
+    /// retransmissions, plus messages deferred by coalescing.  Call once
+    /// per tick (flush() does).
+    void updateReliability(
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+    /// RTT estimate and counters of a reliable UDP session, or nullopt for
+    /// an unknown or plain session.
+    [[nodiscard]] std::optional<ReliabilityStats> reliabilityStats(SessionId session) const;
+
     // ── Message handlers ────────────────────────────────────────────────────
 
-    /// Register a handler for a specific opcode.
+    /// Register a handler for a specific opcode, replacing any previous one.
+    ///
+    /// Handlers live in a 65536-slot table read by the receive path without
+    /// locks, so (un)registering is safe while messages are dispatched; a
+    /// replaced handler is freed once no receive callback can still run it.
     void registerHandler(uint16_t opcode, MessageHandler handler);
 
     /// Remove the handler for a specific opcode.
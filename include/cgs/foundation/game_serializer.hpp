@@ -4,6 +4,11 @@
 /// @brief GameSerializer providing binary/JSON serialization with schema
 ///        versioning and compile-time field registration via CGS_SERIALIZABLE.
 ///
+/// The self-describing binary and JSON forms are meant for persistence.
+/// The compact form is meant for network payloads: it bit-packs fields --
+/// varint integers, 1-bit bools, floats quantized to a FieldRange -- and
+/// replaces the per-object header with a 32-bit schema hash.
+///
 /// Template-heavy header: binary and JSON serialization logic must reside
 /// here because they operate on user-defined types through SerializableTraits.
 /// When container_system becomes available, only the implementation file and
@@ -11,13 +16,17 @@
 /// Part of the Container System Adapter (SDS-MOD-007).
 
 #include "cgs/foundation/game_result.hpp"
+#include "cgs/foundation/json_escape.hpp"
 
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cmath>
 #include <cstdint>
 #include <cstring>
 #include <memory>
 #include <span>
-#include <sstream>
 #include <string>
 #include <string_view>
 #include <tuple>
@@ -37,11 +46,28 @@ struct SerializableTraits {
 
 // ── Field descriptor ────────────────────────────────────────────────────────
 
-/// Describes a single serializable field: its name and pointer-to-member.
+/// Value range of a numeric field in the compact encoding.
+///
+/// A bounded integer is sent as its offset from @c min in just enough
+/// bits for the range; a bounded float is quantized to @c precision steps
+/// (e.g. {-5000, 5000, 0.01} sends positions at 1 cm in 20 bits).  Values
+/// outside the range are clamped.  On a nested serializable field the
+/// range applies to every numeric member without a range of its own.
+struct FieldRange {
+    double min = 0.0;
+    double max = 0.0;
+    double precision = 0.0;  ///< Float quantization step; ignored for integers.
+
+    [[nodiscard]] constexpr bool bounded() const noexcept { return max > min; }
+};
+
+/// Describes a single serializable field: its name, pointer-to-member and
+/// optional compact-encoding range.
 template <typename T, typename M>
 struct FieldDescriptor {
     const char* name;
     M T::* pointer;
+    FieldRange range{};
 };
 
 /// Create a FieldDescriptor from a name and pointer-to-member.
@@ -50,6 +76,12 @@ constexpr FieldDescriptor<T, M> field(const char* name, M T::* ptr) {
     return {name, ptr};
 }
 
+/// Create a FieldDescriptor with a compact-encoding range.
+template <typename T, typename M>
+constexpr FieldDescriptor<T, M> field(const char* name, M T::* ptr, FieldRange range) {
+    return {name, ptr, range};
+}
+
 // ── detail:: implementation helpers ─────────────────────────────────────────
 
 namespace detail {
@@ -80,31 +112,189 @@ void forEachField(const Tuple& t, Func&& f) {
 
 // ── Binary write helpers ────────────────────────────────────────────────
 
+/// Fixed-capacity output for GameSerializer::serializeInto(); the caller
+/// has checked that everything fits.
+struct SpanWriter {
+    std::span<uint8_t> out;
+    std::size_t pos = 0;
+};
+
 inline void writeBytes(std::vector<uint8_t>& buf, const void* data, std::size_t n) {
     const auto* p = static_cast<const uint8_t*>(data);
     buf.insert(buf.end(), p, p + n);
 }
 
-template <typename T>
-void writePrimitive(std::vector<uint8_t>& buf, const T& val) {
+inline void writeBytes(SpanWriter& buf, const void* data, std::size_t n) {
+    if (n > 0) {
+        std::memcpy(buf.out.data() + buf.pos, data, n);
+        buf.pos += n;
+    }
+}
+
+template <typename Buffer, typename T>
+void writePrimitive(Buffer& buf, const T& val) {
     writeBytes(buf, &val, sizeof(T));
 }
 
-inline void writeString(std::vector<uint8_t>& buf, const std::string& val) {
+template <typename Buffer>
+void writeString(Buffer& buf, std::string_view val) {
     auto len = static_cast<uint32_t>(val.size());
     writePrimitive(buf, len);
     writeBytes(buf, val.data(), val.size());
 }
 
+/// Field types whose decoded value points into the input buffer.
+template <typename T>
+inline constexpr bool is_view_field_v =
+    std::is_same_v<T, std::string_view> || std::is_same_v<T, std::span<const uint8_t>>;
+
+template <typename M>
+inline constexpr bool is_variable_field_v = std::is_same_v<M, std::string> || is_view_field_v<M>;
+
+/// Compile-time facts about type @p T's FieldDescriptor tuple.
+template <typename T, typename Tuple>
+struct BinaryLayout;
+
+template <typename T>
+using binary_layout_t = BinaryLayout<T, decltype(SerializableTraits<T>::fields())>;
+
+/// Encoded size of a field type with no length prefix, or 0.
+template <typename M>
+[[nodiscard]] constexpr std::size_t fixedFieldSize() noexcept {
+    if constexpr (std::is_same_v<M, bool>) {
+        return 1;
+    } else if constexpr (std::is_arithmetic_v<M> || std::is_enum_v<M>) {
+        return sizeof(M);
+    } else if constexpr (is_serializable_v<M>) {
+        return binary_layout_t<M>::fixedSize;
+    } else {
+        return 0;
+    }
+}
+
+template <typename M>
+[[nodiscard]] constexpr bool isFixedField() noexcept {
+    if constexpr (is_serializable_v<M>) {
+        return binary_layout_t<M>::fixed;
+    } else {
+        return !is_variable_field_v<M>;
+    }
+}
+
+template <typename M>
+[[nodiscard]] constexpr bool hasViewField() noexcept {
+    if constexpr (is_serializable_v<M>) {
+        return binary_layout_t<M>::hasViews;
+    } else {
+        return is_view_field_v<M>;
+    }
+}
+
+/// True if the binary encoding of a field is exactly its object bytes.
+template <typename M>
+[[nodiscard]] constexpr bool isRawField() noexcept {
+    if constexpr (is_serializable_v<M>) {
+        return binary_layout_t<M>::bulk;
+    } else {
+        return (std::is_arithmetic_v<M> && !std::is_same_v<M, bool>) || std::is_enum_v<M>;
+    }
+}
+
+template <typename T, typename... Ms>
+struct BinaryLayout<T, std::tuple<FieldDescriptor<T, Ms>...>> {
+    static constexpr bool fixed = (isFixedField<Ms>() && ...);
+    static constexpr bool hasViews = (hasViewField<Ms>() || ...);
+    static constexpr std::size_t fixedSize = (fixedFieldSize<Ms>() + ... + 0);
+    /// Candidate for one bulk copy: every field raw, no padding, and the
+    /// wire format (little-endian) matches memory.  Field order is checked
+    /// at first use by memoryLayoutMatches().
+    static constexpr bool bulk = sizeof...(Ms) > 0 && std::is_trivially_copyable_v<T> &&
+                                 (isRawField<Ms>() && ...) && fixedSize == sizeof(T) &&
+                                 std::endian::native == std::endian::little;
+};
+
+/// Check that @p T's registered fields follow each other in memory in
+/// registration order starting at @p expected bytes from @p base.
+template <typename T>
+bool fieldsAreContiguous(const T& obj, const unsigned char* base, std::size_t& expected) {
+    bool ok = true;
+    forEachField(SerializableTraits<T>::fields(), [&](const auto& fd, std::size_t) {
+        const auto& member = obj.*(fd.pointer);
+        using M = std::remove_cvref_t<decltype(member)>;
+        if constexpr (is_serializable_v<M>) {
+            ok = ok && fieldsAreContiguous(member, base, expected);
+        } else {
+            const auto* at = reinterpret_cast<const unsigned char*>(&member);
+            ok = ok && static_cast<std::size_t>(at - base) == expected;
+            expected += sizeof(M);
+        }
+    });
+    return ok;
+}
+
+/// True if @p T's binary fields can be copied as one block of memory.
+/// The type traits are checked at compile time; the field order once.
 template <typename T>
-void writeBinaryField(std::vector<uint8_t>& buf, const T& val) {
+[[nodiscard]] bool memoryLayoutMatches() {
+    if constexpr (binary_layout_t<T>::bulk) {
+        static const bool matches = [] {
+            const T probe{};
+            std::size_t expected = 0;
+            return fieldsAreContiguous(probe, reinterpret_cast<const unsigned char*>(&probe),
+                                       expected);
+        }();
+        return matches;
+    } else {
+        return false;
+    }
+}
+
+template <typename Buffer, typename T>
+void writeBinaryFields(Buffer& buf, const T& obj);
+
+template <typename Buffer, typename T>
+void writeBinaryField(Buffer& buf, const T& val) {
     if constexpr (std::is_same_v<T, bool>) {
         uint8_t b = val ? 1 : 0;
         writePrimitive(buf, b);
-    } else if constexpr (std::is_same_v<T, std::string>) {
+    } else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>) {
         writeString(buf, val);
-    } else if constexpr (std::is_arithmetic_v<T>) {
+    } else if constexpr (std::is_same_v<T, std::span<const uint8_t>>) {
+        auto len = static_cast<uint32_t>(val.size());
+        writePrimitive(buf, len);
+        writeBytes(buf, val.data(), val.size());
+    } else if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
         writePrimitive(buf, val);
+    } else if constexpr (is_serializable_v<T>) {
+        writeBinaryFields(buf, val);
+    }
+}
+
+/// Write every registered field of @p obj, in one copy when its layout
+/// allows.  Nested objects carry no header of their own.
+template <typename Buffer, typename T>
+void writeBinaryFields(Buffer& buf, const T& obj) {
+    if (memoryLayoutMatches<T>()) {
+        writeBytes(buf, &obj, sizeof(T));
+        return;
+    }
+    forEachField(SerializableTraits<T>::fields(),
+                 [&](const auto& fd, std::size_t) { writeBinaryField(buf, obj.*(fd.pointer)); });
+}
+
+/// Encoded size of one field (0 for types the binary form skips).
+template <typename T>
+[[nodiscard]] std::size_t binaryFieldSize(const T& val) noexcept {
+    if constexpr (isFixedField<T>()) {
+        return fixedFieldSize<T>();
+    } else if constexpr (is_serializable_v<T>) {
+        std::size_t size = 0;
+        forEachField(SerializableTraits<T>::fields(), [&](const auto& fd, std::size_t) {
+            size += binaryFieldSize(val.*(fd.pointer));
+        });
+        return size;
+    } else {
+        return sizeof(uint32_t) + val.size();
     }
 }
 
@@ -135,8 +325,23 @@ struct BinaryReader {
         pos += len;
         return true;
     }
+
+    /// Length-prefixed bytes as a view into @c data.
+    bool readSpan(std::span<const uint8_t>& val) {
+        uint32_t len = 0;
+        if (!readPrimitive(len))
+            return false;
+        if (!canRead(len))
+            return false;
+        val = data.subspan(pos, len);
+        pos += len;
+        return true;
+    }
 };
 
+template <typename T>
+bool readBinaryFields(BinaryReader& reader, T& obj);
+
 template <typename T>
 bool readBinaryField(BinaryReader& reader, T& val) {
     if constexpr (std::is_same_v<T, bool>) {
@@ -147,69 +352,409 @@ bool readBinaryField(BinaryReader& reader, T& val) {
         return true;
     } else if constexpr (std::is_same_v<T, std::string>) {
         return reader.readString(val);
-    } else if constexpr (std::is_arithmetic_v<T>) {
+    } else if constexpr (std::is_same_v<T, std::string_view>) {
+        std::span<const uint8_t> bytes;
+        if (!reader.readSpan(bytes))
+            return false;
+        val = std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+        return true;
+    } else if constexpr (std::is_same_v<T, std::span<const uint8_t>>) {
+        return reader.readSpan(val);
+    } else if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
         return reader.readPrimitive(val);
+    } else if constexpr (is_serializable_v<T>) {
+        return readBinaryFields(reader, val);
     }
     return false;
 }
 
-// ── JSON write helpers ──────────────────────────────────────────────────
+/// Read every registered field of @p obj (see writeBinaryFields()).
+template <typename T>
+bool readBinaryFields(BinaryReader& reader, T& obj) {
+    if constexpr (binary_layout_t<T>::bulk) {
+        if (memoryLayoutMatches<T>()) {
+            if (!reader.canRead(sizeof(T)))
+                return false;
+            std::memcpy(&obj, reader.data.data() + reader.pos, sizeof(T));
+            reader.pos += sizeof(T);
+            return true;
+        }
+    }
+    bool ok = true;
+    forEachField(SerializableTraits<T>::fields(), [&](const auto& fd, std::size_t) {
+        ok = ok && readBinaryField(reader, obj.*(fd.pointer));
+    });
+    return ok;
+}
 
-inline std::string escapeJson(std::string_view sv) {
-    std::string out;
-    out.reserve(sv.size());
-    for (char c : sv) {
-        switch (c) {
-            case '"':
-                out += "\\\"";
-                break;
-            case '\\':
-                out += "\\\\";
-                break;
-            case '\b':
-                out += "\\b";
-                break;
-            case '\f':
-                out += "\\f";
-                break;
-            case '\n':
-                out += "\\n";
-                break;
-            case '\r':
-                out += "\\r";
-                break;
-            case '\t':
-                out += "\\t";
-                break;
-            default:
-                out += c;
-                break;
+// ── Compact (bit-packed) helpers ────────────────────────────────────────
+
+/// Appends bit fields to a byte vector, least significant bit first.
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<uint8_t>& buf) : buf_(buf) {}
+
+    /// Append the low @p count (<= 64) bits of @p value.
+    void writeBits(uint64_t value, unsigned count) {
+        if (count > 32) {
+            writeBits(value & 0xFFFFFFFFu, 32);
+            value >>= 32;
+            count -= 32;
+        }
+        if (count < 64) {
+            value &= (uint64_t{1} << count) - 1;
+        }
+        acc_ |= value << bits_;
+        bits_ += count;
+        while (bits_ >= 8) {
+            buf_.push_back(static_cast<uint8_t>(acc_));
+            acc_ >>= 8;
+            bits_ -= 8;
+        }
+    }
+
+    void writeBytes(const void* data, std::size_t n) {
+        const auto* p = static_cast<const uint8_t*>(data);
+        for (std::size_t i = 0; i < n; ++i) {
+            writeBits(p[i], 8);
+        }
+    }
+
+    /// LEB128: 7 bits per group, high bit set while more groups follow.
+    void writeVarint(uint64_t value) {
+        while (value >= 0x80) {
+            writeBits((value & 0x7F) | 0x80, 8);
+            value >>= 7;
+        }
+        writeBits(value, 8);
+    }
+
+    /// Pad the last partial byte with zero bits.
+    void flush() {
+        if (bits_ > 0) {
+            buf_.push_back(static_cast<uint8_t>(acc_));
+            acc_ = 0;
+            bits_ = 0;
+        }
+    }
+
+private:
+    std::vector<uint8_t>& buf_;
+    uint64_t acc_ = 0;
+    unsigned bits_ = 0;
+};
+
+/// Reads BitWriter output; every read fails once the data runs out.
+struct BitReader {
+    std::span<const uint8_t> data;
+    std::size_t pos = 0;  ///< In bits.
+
+    bool readBits(unsigned count, uint64_t& value) {
+        if (count > 64 || pos + count > data.size() * 8) {
+            return false;
+        }
+        value = 0;
+        unsigned got = 0;
+        while (got < count) {
+            const auto shift = static_cast<unsigned>(pos & 7);
+            const unsigned take = std::min(8 - shift, count - got);
+            const uint64_t chunk = (uint64_t{data[pos >> 3]} >> shift) & ((1u << take) - 1);
+            value |= chunk << got;
+            got += take;
+            pos += take;
+        }
+        return true;
+    }
+
+    bool readBytes(void* out, std::size_t n) {
+        auto* p = static_cast<uint8_t*>(out);
+        for (std::size_t i = 0; i < n; ++i) {
+            uint64_t byte = 0;
+            if (!readBits(8, byte))
+                return false;
+            p[i] = static_cast<uint8_t>(byte);
+        }
+        return true;
+    }
+
+    bool readVarint(uint64_t& value) {
+        value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            uint64_t group = 0;
+            if (!readBits(8, group))
+                return false;
+            value |= (group & 0x7F) << shift;
+            if ((group & 0x80) == 0)
+                return true;
+        }
+        return false;
+    }
+};
+
+template <typename>
+inline constexpr bool kAlwaysFalse = false;
+
+/// Bits needed for a bounded field's offset from its minimum.
+template <typename M>
+[[nodiscard]] unsigned rangeBits(const FieldRange& range) noexcept {
+    double steps = range.max - range.min;
+    if constexpr (std::is_floating_point_v<M>) {
+        steps = range.precision > 0.0 ? std::ceil(steps / range.precision) : 0.0;
+    }
+    if (!(steps >= 1.0)) {
+        return 0;
+    }
+    if (steps >= 18446744073709551615.0) {
+        return 64;
+    }
+    return static_cast<unsigned>(std::bit_width(static_cast<uint64_t>(steps)));
+}
+
+template <typename M>
+void writeCompactField(BitWriter& w, const M& val, const FieldRange& range);
+
+template <typename M>
+bool readCompactField(BitReader& r, M& val, const FieldRange& range);
+
+/// Compact-encode every registered field of @p obj.  @p inherited is the
+/// range of the enclosing field, for members without a range of their own.
+template <typename T>
+void writeCompactObject(BitWriter& w, const T& obj, const FieldRange& inherited) {
+    forEachField(SerializableTraits<T>::fields(), [&](const auto& fd, std::size_t) {
+        writeCompactField(w, obj.*(fd.pointer), fd.range.bounded() ? fd.range : inherited);
+    });
+}
+
+template <typename T>
+bool readCompactObject(BitReader& r, T& obj, const FieldRange& inherited) {
+    bool ok = true;
+    forEachField(SerializableTraits<T>::fields(), [&](const auto& fd, std::size_t) {
+        if (ok) {
+            ok = readCompactField(r, obj.*(fd.pointer), fd.range.bounded() ? fd.range : inherited);
+        }
+    });
+    return ok;
+}
+
+template <typename M>
+void writeCompactField(BitWriter& w, const M& val, const FieldRange& range) {
+    if constexpr (std::is_same_v<M, bool>) {
+        w.writeBits(val ? 1 : 0, 1);
+    } else if constexpr (std::is_enum_v<M>) {
+        writeCompactField(w, static_cast<std::underlying_type_t<M>>(val), range);
+    } else if constexpr (std::is_integral_v<M>) {
+        if (range.bounded()) {
+            const double clamped =
+                std::clamp(static_cast<double>(val), range.min, range.max) - range.min;
+            w.writeBits(static_cast<uint64_t>(clamped), rangeBits<M>(range));
+        } else if constexpr (std::is_signed_v<M>) {
+            const auto v = static_cast<int64_t>(val);
+            w.writeVarint((static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63));
+        } else {
+            w.writeVarint(static_cast<uint64_t>(val));
+        }
+    } else if constexpr (std::is_floating_point_v<M>) {
+        if (range.bounded() && range.precision > 0.0) {
+            const double clamped = std::clamp(static_cast<double>(val), range.min, range.max);
+            const double steps = std::round((clamped - range.min) / range.precision);
+            w.writeBits(static_cast<uint64_t>(steps), rangeBits<M>(range));
+        } else {
+            w.writeBytes(&val, sizeof(M));
+        }
+    } else if constexpr (std::is_same_v<M, std::string>) {
+        w.writeVarint(val.size());
+        w.writeBytes(val.data(), val.size());
+    } else if constexpr (is_serializable_v<M>) {
+        writeCompactObject(w, val, range);
+    } else {
+        static_assert(kAlwaysFalse<M>, "Field type has no compact encoding");
+    }
+}
+
+template <typename M>
+bool readCompactField(BitReader& r, M& val, const FieldRange& range) {
+    if constexpr (std::is_same_v<M, bool>) {
+        uint64_t bit = 0;
+        if (!r.readBits(1, bit))
+            return false;
+        val = (bit != 0);
+        return true;
+    } else if constexpr (std::is_enum_v<M>) {
+        std::underlying_type_t<M> raw{};
+        if (!readCompactField(r, raw, range))
+            return false;
+        val = static_cast<M>(raw);
+        return true;
+    } else if constexpr (std::is_integral_v<M>) {
+        uint64_t raw = 0;
+        if (range.bounded()) {
+            if (!r.readBits(rangeBits<M>(range), raw))
+                return false;
+            const double v = std::min(range.min + static_cast<double>(raw), range.max);
+            val = static_cast<M>(v);
+        } else if constexpr (std::is_signed_v<M>) {
+            if (!r.readVarint(raw))
+                return false;
+            val = static_cast<M>(static_cast<int64_t>(raw >> 1) ^ -static_cast<int64_t>(raw & 1));
+        } else {
+            if (!r.readVarint(raw))
+                return false;
+            val = static_cast<M>(raw);
+        }
+        return true;
+    } else if constexpr (std::is_floating_point_v<M>) {
+        if (range.bounded() && range.precision > 0.0) {
+            uint64_t steps = 0;
+            if (!r.readBits(rangeBits<M>(range), steps))
+                return false;
+            const double v = range.min + static_cast<double>(steps) * range.precision;
+            val = static_cast<M>(std::min(v, range.max));
+            return true;
+        }
+        return r.readBytes(&val, sizeof(M));
+    } else if constexpr (std::is_same_v<M, std::string>) {
+        uint64_t len = 0;
+        if (!r.readVarint(len) || len > r.data.size() - r.pos / 8)
+            return false;
+        val.resize(static_cast<std::size_t>(len));
+        return r.readBytes(val.data(), val.size());
+    } else if constexpr (is_serializable_v<M>) {
+        return readCompactObject(r, val, range);
+    } else {
+        static_assert(kAlwaysFalse<M>, "Field type has no compact encoding");
+        return false;
+    }
+}
+
+// ── Schema hash ─────────────────────────────────────────────────────────
+
+inline constexpr uint32_t kFnvOffset = 2166136261u;
+inline constexpr uint32_t kFnvPrime = 16777619u;
+
+inline void hashBytes(uint32_t& h, const void* data, std::size_t n) {
+    const auto* p = static_cast<const uint8_t*>(data);
+    for (std::size_t i = 0; i < n; ++i) {
+        h = (h ^ p[i]) * kFnvPrime;
+    }
+}
+
+template <typename T>
+void hashSchema(uint32_t& h, const FieldRange& inherited);
+
+/// Fold one field's name, kind, width and effective range into @p h.
+template <typename M>
+void hashField(uint32_t& h, const char* name, const FieldRange& range) {
+    hashBytes(h, name, std::char_traits<char>::length(name) + 1);
+    uint8_t kind = 0;
+    if constexpr (std::is_same_v<M, bool>) {
+        kind = 1;
+    } else if constexpr (std::is_enum_v<M> || std::is_integral_v<M>) {
+        kind = std::is_signed_v<M> ? 2 : 3;
+    } else if constexpr (std::is_floating_point_v<M>) {
+        kind = 4;
+    } else if constexpr (std::is_same_v<M, std::string>) {
+        kind = 5;
+    } else {
+        kind = 6;
+    }
+    const auto size = static_cast<uint8_t>(sizeof(M));
+    hashBytes(h, &kind, 1);
+    hashBytes(h, &size, 1);
+    if constexpr (is_serializable_v<M>) {
+        hashSchema<M>(h, range);
+    } else if constexpr (!std::is_same_v<M, std::string>) {
+        if (range.bounded()) {
+            hashBytes(h, &range.min, sizeof(double));
+            hashBytes(h, &range.max, sizeof(double));
+            hashBytes(h, &range.precision, sizeof(double));
         }
     }
-    return out;
 }
 
 template <typename T>
-void writeJsonField(std::ostringstream& out, const char* name, const T& val) {
-    out << '"' << name << "\":";
+void hashSchema(uint32_t& h, const FieldRange& inherited) {
+    const uint32_t version = SerializableTraits<T>::schema_version;
+    hashBytes(h, &version, sizeof(version));
+    forEachField(SerializableTraits<T>::fields(), [&](const auto& fd, std::size_t) {
+        using M = std::remove_cvref_t<decltype(std::declval<T&>().*(fd.pointer))>;
+        hashField<M>(h, fd.name, fd.range.bounded() ? fd.range : inherited);
+    });
+}
+
+// ── JSON write helpers ──────────────────────────────────────────────────
+
+/// Append @p val's shortest round-trip text (std::to_chars).
+template <typename T>
+void appendJsonNumber(std::string& out, T val) {
+    char buf[32];
+    const auto result = std::to_chars(buf, buf + sizeof(buf), val);
+    out.append(buf, result.ptr);
+}
+
+template <typename T>
+void writeJsonObject(std::string& out, const T& obj);
+
+template <typename T>
+void writeJsonField(std::string& out, const char* name, const T& val) {
+    out += '"';
+    out += name;
+    out += "\":";
     if constexpr (std::is_same_v<T, bool>) {
-        out << (val ? "true" : "false");
-    } else if constexpr (std::is_same_v<T, std::string>) {
-        out << '"' << escapeJson(val) << '"';
-    } else if constexpr (std::is_floating_point_v<T>) {
-        out << val;
-    } else if constexpr (std::is_signed_v<T>) {
-        out << static_cast<int64_t>(val);
-    } else if constexpr (std::is_unsigned_v<T>) {
-        out << static_cast<uint64_t>(val);
+        out += val ? "true" : "false";
+    } else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>) {
+        out += '"';
+        appendJsonEscaped(out, val);
+        out += '"';
+    } else if constexpr (std::is_enum_v<T>) {
+        appendJsonNumber(out, static_cast<std::underlying_type_t<T>>(val));
+    } else if constexpr (std::is_arithmetic_v<T>) {
+        appendJsonNumber(out, val);
+    } else if constexpr (is_serializable_v<T>) {
+        writeJsonObject(out, val);
+    } else {
+        static_assert(kAlwaysFalse<T>, "Field type has no JSON encoding");
     }
 }
 
+/// Write @p obj as a JSON object.  Nested objects carry no "__v" of
+/// their own, like nested binary fields carry no header.
+template <typename T>
+void writeJsonObject(std::string& out, const T& obj) {
+    out += '{';
+    forEachField(SerializableTraits<T>::fields(), [&](const auto& fd, std::size_t i) {
+        if (i != 0) {
+            out += ',';
+        }
+        writeJsonField(out, fd.name, obj.*(fd.pointer));
+    });
+    out += '}';
+}
+
 // ── JSON read helpers ───────────────────────────────────────────────────
 
+/// Append code point @p cp to @p out as UTF-8.
+inline void appendUtf8(std::string& out, uint32_t cp) {
+    if (cp < 0x80) {
+        out += static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
 struct JsonReader {
     std::string_view data;
     std::size_t pos = 0;
+    const char* error = nullptr;  ///< Why readJsonObject() failed.
 
     void skipWhitespace() {
         while (pos < data.size() &&
@@ -227,90 +772,189 @@ struct JsonReader {
         return false;
     }
 
+    /// Read the four hex digits of a \\u escape at pos.
+    bool readHex4(uint32_t& cp) {
+        if (data.size() - pos < 4) {
+            return false;
+        }
+        const char* first = data.data() + pos;
+        const auto result = std::from_chars(first, first + 4, cp, 16);
+        if (result.ec != std::errc() || result.ptr != first + 4) {
+            return false;
+        }
+        pos += 4;
+        return true;
+    }
+
+    /// Decode the \\u escape whose 'u' is at pos (surrogate pairs joined;
+    /// unpaired surrogates become U+FFFD).
+    bool readUnicodeEscape(std::string& out) {
+        ++pos;
+        uint32_t cp = 0;
+        if (!readHex4(cp)) {
+            return false;
+        }
+        if (cp >= 0xD800 && cp < 0xDC00) {
+            uint32_t low = 0;
+            const std::size_t mark = pos;
+            if (data.substr(pos, 2) == "\\u" && (pos += 2, readHex4(low)) && low >= 0xDC00 &&
+                low < 0xE000) {
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+            } else {
+                pos = mark;
+                cp = 0xFFFD;
+            }
+        } else if (cp >= 0xDC00 && cp < 0xE000) {
+            cp = 0xFFFD;
+        }
+        appendUtf8(out, cp);
+        return true;
+    }
+
     bool readQuotedString(std::string& out) {
         skipWhitespace();
         if (pos >= data.size() || data[pos] != '"')
             return false;
         ++pos;
         out.clear();
-        while (pos < data.size() && data[pos] != '"') {
-            if (data[pos] == '\\') {
-                ++pos;
-                if (pos >= data.size())
-                    return false;
-                switch (data[pos]) {
-                    case '"':
-                        out += '"';
-                        break;
-                    case '\\':
-                        out += '\\';
-                        break;
-                    case 'b':
-                        out += '\b';
-                        break;
-                    case 'f':
-                        out += '\f';
-                        break;
-                    case 'n':
-                        out += '\n';
-                        break;
-                    case 'r':
-                        out += '\r';
-                        break;
-                    case 't':
-                        out += '\t';
-                        break;
-                    default:
-                        out += data[pos];
-                        break;
-                }
-            } else {
-                out += data[pos];
+        while (true) {
+            // Copy the run up to the next quote or escape in one append.
+            const std::size_t stop = data.find_first_of("\"\\", pos);
+            if (stop == std::string_view::npos)
+                return false;
+            out.append(data.data() + pos, stop - pos);
+            pos = stop;
+            if (data[pos] == '"')
+                break;
+            ++pos;
+            if (pos >= data.size())
+                return false;
+            switch (data[pos]) {
+                case 'b':
+                    out += '\b';
+                    break;
+                case 'f':
+                    out += '\f';
+                    break;
+                case 'n':
+                    out += '\n';
+                    break;
+                case 'r':
+                    out += '\r';
+                    break;
+                case 't':
+                    out += '\t';
+                    break;
+                case 'u':
+                    if (!readUnicodeEscape(out))
+                        return false;
+                    continue;
+                default:  // '"', '\\', '/' and anything else: literal
+                    out += data[pos];
+                    break;
             }
             ++pos;
         }
-        if (pos >= data.size())
-            return false;
         ++pos;  // skip closing quote
         return true;
     }
 
-    /// Read a JSON value token. For strings, returns the unescaped content.
-    /// For numbers/bools/null, returns the raw text.
-    bool readRawValue(std::string& out) {
+    /// Skip a quoted string at pos without decoding it.
+    /// @param content  Receives the raw text between the quotes.
+    bool scanQuotedString(std::string_view& content) {
+        const std::size_t start = ++pos;
+        while (true) {
+            const std::size_t stop = data.find_first_of("\"\\", pos);
+            if (stop == std::string_view::npos) {
+                pos = data.size();
+                return false;
+            }
+            if (data[stop] == '"') {
+                content = data.substr(start, stop - start);
+                pos = stop + 1;
+                return true;
+            }
+            pos = stop + 2;  // skip the escaped character
+            if (pos >= data.size()) {
+                pos = data.size();
+                return false;
+            }
+        }
+    }
+
+    /// Read an object key.  Keys without escapes are returned as a view of
+    /// the input; others are decoded into @p scratch.
+    bool readKey(std::string_view& key, std::string& scratch) {
+        skipWhitespace();
+        if (pos >= data.size() || data[pos] != '"')
+            return false;
+        const std::size_t start = pos;
+        if (!scanQuotedString(key))
+            return false;
+        if (key.find('\\') == std::string_view::npos)
+            return true;
+        pos = start;
+        if (!readQuotedString(scratch))
+            return false;
+        key = scratch;
+        return true;
+    }
+
+    /// Read a JSON value token without copying it: the raw text of a
+    /// number/bool/null, or the undecoded content of a string.
+    bool readToken(std::string_view& out) {
         skipWhitespace();
         if (pos >= data.size())
             return false;
         if (data[pos] == '"') {
-            return readQuotedString(out);
+            return scanQuotedString(out);
         }
         std::size_t start = pos;
         while (pos < data.size() && data[pos] != ',' && data[pos] != '}' && data[pos] != ' ' &&
                data[pos] != '\t' && data[pos] != '\n' && data[pos] != '\r') {
             ++pos;
         }
-        out = std::string(data.substr(start, pos - start));
+        out = data.substr(start, pos - start);
         return !out.empty();
     }
 
-    /// Skip a JSON value (for unrecognized fields).
+    /// Skip a JSON value (for unrecognized fields), nested objects and
+    /// arrays included.
     void skipValue() {
         skipWhitespace();
-        if (pos >= data.size())
-            return;
-        if (data[pos] == '"') {
-            std::string dummy;
-            readQuotedString(dummy);
-        } else {
-            while (pos < data.size() && data[pos] != ',' && data[pos] != '}') {
-                ++pos;
+        std::size_t depth = 0;
+        while (pos < data.size()) {
+            const char c = data[pos];
+            if (c == '"') {
+                std::string_view dummy;
+                scanQuotedString(dummy);
+                if (depth == 0) {
+                    return;
+                }
+                continue;
             }
+            if (c == '{' || c == '[') {
+                ++depth;
+            } else if (c == '}' || c == ']') {
+                if (depth == 0) {
+                    return;  // End of the enclosing object
+                }
+                if (--depth == 0) {
+                    ++pos;
+                    return;
+                }
+            } else if (c == ',' && depth == 0) {
+                return;
+            }
+            ++pos;
         }
     }
 };
 
+/// Parse a bool/number token with std::from_chars.  Integers reject
+/// out-of-range values; trailing text after the number is ignored.
 template <typename T>
-bool parseJsonValue(const std::string& raw, T& val) {
+bool parseJsonValue(std::string_view raw, T& val) {
     if constexpr (std::is_same_v<T, bool>) {
         if (raw == "true") {
             val = true;
@@ -321,33 +965,204 @@ bool parseJsonValue(const std::string& raw, T& val) {
             return true;
         }
         return false;
-    } else if constexpr (std::is_same_v<T, std::string>) {
-        val = raw;
+    } else if constexpr (std::is_enum_v<T>) {
+        std::underlying_type_t<T> underlying{};
+        if (!parseJsonValue(raw, underlying)) {
+            return false;
+        }
+        val = static_cast<T>(underlying);
         return true;
-    } else if constexpr (std::is_floating_point_v<T>) {
-        try {
-            if constexpr (std::is_same_v<T, float>) {
-                val = std::stof(raw);
-            } else {
-                val = std::stod(raw);
-            }
-            return true;
-        } catch (...) {
+    } else if constexpr (std::is_arithmetic_v<T>) {
+        const char* first = raw.data();
+        const char* last = first + raw.size();
+        if (first != last && *first == '+') {
+            ++first;  // from_chars rejects the '+' that stod accepted
+        }
+        const auto result = std::from_chars(first, last, val);
+        return result.ec == std::errc() && result.ptr != first;
+    }
+    return false;
+}
+
+// ── JSON field lookup ───────────────────────────────────────────────────
+
+/// FNV-1a of @p key, perturbed by @p seed.
+constexpr uint32_t fieldNameHash(std::string_view key, uint32_t seed) noexcept {
+    uint32_t h = 2166136261u ^ seed;
+    for (const char c : key) {
+        h ^= static_cast<uint8_t>(c);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+template <typename T>
+bool readJsonObject(JsonReader& reader, T& obj);
+
+/// Read the value at @p reader into field @p I of @p obj.  Returns false
+/// if no value token could be read (the caller skips it).  A value that
+/// does not parse as the field's type leaves the field unchanged.
+template <typename T, std::size_t I>
+bool readJsonField(JsonReader& reader, T& obj) {
+    constexpr auto fd = std::get<I>(SerializableTraits<T>::fields());
+    using FieldType = std::remove_reference_t<decltype(obj.*(fd.pointer))>;
+
+    reader.skipWhitespace();
+    std::string_view token;
+    if constexpr (std::is_same_v<FieldType, std::string>) {
+        // Decode straight into the member; a bare token is taken verbatim.
+        if (reader.pos < reader.data.size() && reader.data[reader.pos] == '"') {
+            return reader.readQuotedString(obj.*(fd.pointer));
+        }
+        if (!reader.readToken(token)) {
             return false;
         }
-    } else if constexpr (std::is_integral_v<T>) {
-        try {
-            if constexpr (std::is_signed_v<T>) {
-                val = static_cast<T>(std::stoll(raw));
-            } else {
-                val = static_cast<T>(std::stoull(raw));
+        (obj.*(fd.pointer)).assign(token);
+        return true;
+    } else if constexpr (is_serializable_v<FieldType>) {
+        if (reader.pos >= reader.data.size() || reader.data[reader.pos] != '{') {
+            return false;
+        }
+        // A malformed nested object fails the whole document.
+        if (!readJsonObject(reader, obj.*(fd.pointer))) {
+            reader.pos = reader.data.size();
+        }
+        return true;
+    } else {
+        if (!reader.readToken(token)) {
+            return false;
+        }
+        FieldType val{};
+        if (parseJsonValue(token, val)) {
+            obj.*(fd.pointer) = val;
+        }
+        return true;
+    }
+}
+
+/// Compile-time map from the JSON keys of T to its fields.
+///
+/// The names are placed in a power-of-two table by a seeded hash, the
+/// seed searched at compile time until no two names share a slot, so a
+/// key costs one hash and one string compare whatever the field count.
+/// Should no seed separate them (only with a repeated name), lookups fall
+/// back to comparing every name.
+template <typename T>
+struct JsonFieldIndex {
+    using Fields = decltype(SerializableTraits<T>::fields());
+    static constexpr std::size_t kCount = std::tuple_size_v<Fields>;
+
+    /// Four slots per name keeps a separating seed easy to find.
+    static constexpr std::size_t kSlots = std::bit_ceil(std::max<std::size_t>(kCount * 4, 1));
+    static constexpr uint32_t kMaxSeed = 4096;
+
+    static constexpr auto kNames = []<std::size_t... Is>(std::index_sequence<Is...>) {
+        [[maybe_unused]] constexpr auto fields = SerializableTraits<T>::fields();
+        return std::array<std::string_view, kCount>{std::string_view(std::get<Is>(fields).name)...};
+    }(std::make_index_sequence<kCount>{});
+
+    struct Table {
+        bool perfect = false;
+        uint32_t seed = 0;
+        std::array<uint16_t, kSlots> slots{};  ///< Field index + 1; 0 = empty.
+    };
+
+    static constexpr Table kTable = [] {
+        Table table;
+        for (uint32_t seed = 0; seed < kMaxSeed; ++seed) {
+            table.slots = {};
+            bool collided = false;
+            for (std::size_t i = 0; i < kCount && !collided; ++i) {
+                auto& slot = table.slots[fieldNameHash(kNames[i], seed) & (kSlots - 1)];
+                collided = slot != 0;
+                slot = static_cast<uint16_t>(i + 1);
+            }
+            if (!collided) {
+                table.perfect = true;
+                table.seed = seed;
+                return table;
+            }
+        }
+        return table;
+    }();
+
+    /// One reader per field, indexed like kNames.
+    static constexpr auto kReaders = []<std::size_t... Is>(std::index_sequence<Is...>) {
+        return std::array<bool (*)(JsonReader&, T&), kCount>{&readJsonField<T, Is>...};
+    }(std::make_index_sequence<kCount>{});
+
+    /// Index of the field named @p key, or kCount.
+    static constexpr std::size_t find(std::string_view key) noexcept {
+        if constexpr (kTable.perfect) {
+            const std::size_t slot = kTable.slots[fieldNameHash(key, kTable.seed) & (kSlots - 1)];
+            return slot != 0 && kNames[slot - 1] == key ? slot - 1 : kCount;
+        } else {
+            for (std::size_t i = 0; i < kCount; ++i) {
+                if (kNames[i] == key) {
+                    return i;
+                }
+            }
+            return kCount;
+        }
+    }
+};
+
+/// Read the JSON object at @p reader into @p obj, nested objects
+/// included.  Unrecognized keys are skipped; missing keys keep their
+/// values.  On malformed input returns false with reader.error set.
+template <typename T>
+bool readJsonObject(JsonReader& reader, T& obj) {
+    if (!reader.expect('{')) {
+        reader.error = "expected '{'";
+        return false;
+    }
+
+    std::string keyScratch;  // Only used for keys containing escapes.
+
+    bool first = true;
+    while (true) {
+        reader.skipWhitespace();
+        if (reader.pos >= reader.data.size()) {
+            if (reader.error == nullptr) {
+                reader.error = "unexpected end of JSON";
             }
+            return false;
+        }
+        if (reader.data[reader.pos] == '}') {
+            ++reader.pos;
             return true;
-        } catch (...) {
+        }
+
+        if (!first && !reader.expect(',')) {
+            reader.error = "expected ','";
+            return false;
+        }
+        first = false;
+
+        // Read key
+        std::string_view key;
+        if (!reader.readKey(key, keyScratch)) {
+            reader.error = "expected key string";
+            return false;
+        }
+        if (!reader.expect(':')) {
+            reader.error = "expected ':'";
             return false;
         }
+
+        // Skip version field
+        if (key == "__v") {
+            reader.skipValue();
+            continue;
+        }
+
+        // Match against known fields: one hash probe, no allocation.
+        using Index = JsonFieldIndex<T>;
+        const std::size_t index = Index::find(key);
+        if (index == Index::kCount || !Index::kReaders[index](reader, obj)) {
+            reader.skipValue();
+        }
     }
-    return false;
 }
 
 }  // namespace detail
@@ -357,12 +1172,16 @@ bool parseJsonValue(const std::string& raw, T& val) {
 /// Magic bytes identifying CGS binary serialization format.
 inline constexpr uint8_t kBinaryMagic[4] = {'C', 'G', 'S', 'B'};
 
+/// Magic bytes of a serializeArray() block.
+inline constexpr uint8_t kBinaryArrayMagic[4] = {'C', 'G', 'S', 'A'};
+
 // ── GameSerializer ──────────────────────────────────────────────────────────
 
 /// Serializer providing binary and JSON encoding with schema versioning.
 ///
 /// Types must be registered with CGS_SERIALIZABLE before use. Binary format
-/// is compact (no field names stored); JSON format uses human-readable keys.
+/// is compact (no field names stored); JSON format uses human-readable keys;
+/// the compact format bit-packs fields for network payloads.
 /// Schema versioning allows older data to be deserialized into newer structs
 /// with default values for added fields.
 ///
@@ -383,6 +1202,7 @@ inline constexpr uint8_t kBinaryMagic[4] = {'C', 'G', 'S', 'B'};
 ///   auto bin = s.serializeBinary(player);
 ///   auto json = s.serializeJson(player);
 ///   auto result = s.deserializeBinary<Player>(bin);
+///   auto wire = s.serializeCompact(player);  // e.g. level as a 1-byte varint
 /// @endcode
 class GameSerializer {
 public:
@@ -396,31 +1216,68 @@ public:
 
     // ── Binary serialization ────────────────────────────────────────────
 
-    /// Serialize an object to compact binary format.
+    /// Encoded binary size of a type with no string or view fields, known
+    /// at compile time so callers can size a stack buffer for
+    /// serializeInto().
     template <typename T>
-    [[nodiscard]] std::vector<uint8_t> serializeBinary(const T& obj) const {
+    [[nodiscard]] static constexpr std::size_t fixedBinarySize() noexcept {
         static_assert(detail::is_serializable_v<T>,
                       "Type must be registered with CGS_SERIALIZABLE");
+        static_assert(detail::binary_layout_t<T>::fixed,
+                      "Type has variable-length fields; use binarySize()");
+        return kBinaryHeaderSize + detail::binary_layout_t<T>::fixedSize;
+    }
 
-        std::vector<uint8_t> buf;
-        buf.reserve(128);
-
-        // Header: magic + version + field count
-        detail::writeBytes(buf, kBinaryMagic, 4);
-
-        uint32_t version = SerializableTraits<T>::schema_version;
-        detail::writePrimitive(buf, version);
+    /// Encoded binary size of @p obj.
+    template <typename T>
+    [[nodiscard]] static std::size_t binarySize(const T& obj) noexcept {
+        static_assert(detail::is_serializable_v<T>,
+                      "Type must be registered with CGS_SERIALIZABLE");
+        if constexpr (detail::binary_layout_t<T>::fixed) {
+            return fixedBinarySize<T>();
+        } else {
+            std::size_t size = kBinaryHeaderSize;
+            detail::forEachField(SerializableTraits<T>::fields(), [&](const auto& fd, std::size_t) {
+                size += detail::binaryFieldSize(obj.*(fd.pointer));
+            });
+            return size;
+        }
+    }
 
-        auto fields = SerializableTraits<T>::fields();
-        constexpr auto numFields = static_cast<uint32_t>(std::tuple_size_v<decltype(fields)>);
-        detail::writePrimitive(buf, numFields);
+    /// Serialize an object to compact binary format.
+    template <typename T>
+    [[nodiscard]] std::vector<uint8_t> serializeBinary(const T& obj) const {
+        std::vector<uint8_t> buf;
+        serializeAppend(obj, buf);
+        return buf;
+    }
 
-        // Fields in declaration order
-        detail::forEachField(fields, [&](const auto& fd, std::size_t) {
-            detail::writeBinaryField(buf, obj.*(fd.pointer));
-        });
+    /// Append @p obj's binary form to @p buf, growing it at most once.
+    template <typename T>
+    void serializeAppend(const T& obj, std::vector<uint8_t>& buf) const {
+        static_assert(detail::is_serializable_v<T>,
+                      "Type must be registered with CGS_SERIALIZABLE");
+        buf.reserve(buf.size() + binarySize(obj));
+        writeBinary(buf, obj);
+    }
 
-        return buf;
+    /// Write @p obj's binary form to the front of @p out without
+    /// allocating.
+    /// @return bytes written, or SerializationError if @p out is too small
+    ///         (nothing is written then).
+    template <typename T>
+    [[nodiscard]] GameResult<std::size_t> serializeInto(const T& obj,
+                                                        std::span<uint8_t> out) const {
+        static_assert(detail::is_serializable_v<T>,
+                      "Type must be registered with CGS_SERIALIZABLE");
+        const std::size_t size = binarySize(obj);
+        if (out.size() < size) {
+            return GameResult<std::size_t>::err(
+                GameError(ErrorCode::SerializationError, "output buffer too small"));
+        }
+        detail::SpanWriter writer{out};
+        writeBinary(writer, obj);
+        return GameResult<std::size_t>::ok(writer.pos);
     }
 
     /// Deserialize an object from binary format.
@@ -429,50 +1286,124 @@ public:
     [[nodiscard]] GameResult<T> deserializeBinary(std::span<const uint8_t> data) const {
         static_assert(detail::is_serializable_v<T>,
                       "Type must be registered with CGS_SERIALIZABLE");
+        static_assert(!detail::binary_layout_t<T>::hasViews,
+                      "Type has string_view/span fields; use deserializeView()");
+        return readBinary<T>(data);
+    }
 
-        detail::BinaryReader reader{data};
+    /// Deserialize without copying: std::string_view and
+    /// std::span<const uint8_t> fields point into @p data, which must
+    /// outlive the result.  View types encode like their owning
+    /// counterparts (string_view like std::string), so a view struct with
+    /// the same field order and version reads the owning type's output.
+    template <typename T>
+    [[nodiscard]] GameResult<T> deserializeView(std::span<const uint8_t> data) const {
+        return readBinary<T>(data);
+    }
 
-        // Verify magic bytes
-        uint8_t magic[4]{};
-        for (auto& m : magic) {
-            if (!reader.readPrimitive(m)) {
-                return GameResult<T>::err(
-                    GameError(ErrorCode::InvalidBinaryData, "truncated binary header"));
+    /// Append @p objs as one array block: a header, the element count and
+    /// each element's fields without per-element headers.  Types whose
+    /// layout matches the wire format are written with a single copy.
+    template <typename T>
+    void serializeArrayAppend(std::span<const T> objs, std::vector<uint8_t>& buf) const {
+        static_assert(detail::is_serializable_v<T>,
+                      "Type must be registered with CGS_SERIALIZABLE");
+        const bool bulk = detail::memoryLayoutMatches<T>();
+        std::size_t size = kBinaryHeaderSize + sizeof(uint32_t);
+        if (bulk) {
+            size += objs.size() * sizeof(T);
+        } else {
+            for (const auto& obj : objs) {
+                size += binarySize(obj) - kBinaryHeaderSize;
             }
         }
-        if (std::memcmp(magic, kBinaryMagic, 4) != 0) {
-            return GameResult<T>::err(
-                GameError(ErrorCode::InvalidBinaryData, "invalid magic bytes"));
+        buf.reserve(buf.size() + size);
+
+        writeHeader<std::vector<uint8_t>, T>(buf, kBinaryArrayMagic);
+        const auto count = static_cast<uint32_t>(objs.size());
+        detail::writePrimitive(buf, count);
+        if (bulk) {
+            detail::writeBytes(buf, objs.data(), objs.size() * sizeof(T));
+        } else {
+            for (const auto& obj : objs) {
+                detail::writeBinaryFields(buf, obj);
+            }
         }
+    }
+
+    /// Serialize @p objs as one array block (see serializeArrayAppend()).
+    template <typename T>
+    [[nodiscard]] std::vector<uint8_t> serializeArray(std::span<const T> objs) const {
+        std::vector<uint8_t> buf;
+        serializeArrayAppend(objs, buf);
+        return buf;
+    }
+
+    /// Deserialize an array block.  Elements written with an older schema
+    /// keep defaults for the added fields; unlike deserializeBinary(), a
+    /// truncated element is an error.
+    template <typename T>
+    [[nodiscard]] GameResult<std::vector<T>> deserializeArray(std::span<const uint8_t> data) const;
+
+    // ── Compact serialization ───────────────────────────────────────────
+
+    /// Hash of @p T's wire schema: version, field names, kinds, widths and
+    /// ranges, including nested types.  Both peers must agree on it.
+    template <typename T>
+    [[nodiscard]] static uint32_t compactSchemaHash() {
+        static_assert(detail::is_serializable_v<T>,
+                      "Type must be registered with CGS_SERIALIZABLE");
+        static const uint32_t hash = [] {
+            uint32_t h = detail::kFnvOffset;
+            detail::hashSchema<T>(h, FieldRange{});
+            return h;
+        }();
+        return hash;
+    }
+
+    /// Serialize an object to the bit-packed network form: the 4-byte
+    /// schema hash followed by every field in declaration order.
+    template <typename T>
+    [[nodiscard]] std::vector<uint8_t> serializeCompact(const T& obj) const {
+        static_assert(detail::is_serializable_v<T>,
+                      "Type must be registered with CGS_SERIALIZABLE");
+
+        std::vector<uint8_t> buf;
+        buf.reserve(32);
+        const uint32_t hash = compactSchemaHash<T>();
+        detail::writePrimitive(buf, hash);
+
+        detail::BitWriter writer(buf);
+        detail::writeCompactObject(writer, obj, FieldRange{});
+        writer.flush();
+        return buf;
+    }
+
+    /// Deserialize an object from the compact form.  Unlike the binary
+    /// form there is no cross-version tolerance: a different schema hash
+    /// is rejected with ErrorCode::SchemaMismatch.
+    template <typename T>
+    [[nodiscard]] GameResult<T> deserializeCompact(std::span<const uint8_t> data) const {
+        static_assert(detail::is_serializable_v<T>,
+                      "Type must be registered with CGS_SERIALIZABLE");
 
-        // Schema version (stored for forward compatibility)
-        uint32_t version = 0;
-        if (!reader.readPrimitive(version)) {
+        uint32_t hash = 0;
+        if (data.size() < sizeof(hash)) {
             return GameResult<T>::err(
-                GameError(ErrorCode::InvalidBinaryData, "truncated version field"));
+                GameError(ErrorCode::InvalidBinaryData, "truncated schema hash"));
         }
-
-        // Field count from the serialized data
-        uint32_t storedFieldCount = 0;
-        if (!reader.readPrimitive(storedFieldCount)) {
+        std::memcpy(&hash, data.data(), sizeof(hash));
+        if (hash != compactSchemaHash<T>()) {
             return GameResult<T>::err(
-                GameError(ErrorCode::InvalidBinaryData, "truncated field count"));
+                GameError(ErrorCode::SchemaMismatch, "compact schema hash mismatch"));
         }
 
         T obj{};
-        auto fields = SerializableTraits<T>::fields();
-        constexpr uint32_t currentFieldCount =
-            static_cast<uint32_t>(std::tuple_size_v<decltype(fields)>);
-
-        // Read min(stored, current) fields; extra fields keep defaults
-        uint32_t fieldsToRead = std::min(storedFieldCount, currentFieldCount);
-
-        detail::forEachField(fields, [&](const auto& fd, std::size_t idx) {
-            if (static_cast<uint32_t>(idx) < fieldsToRead) {
-                detail::readBinaryField(reader, obj.*(fd.pointer));
-            }
-        });
-
+        detail::BitReader reader{data.subspan(sizeof(hash))};
+        if (!detail::readCompactObject(reader, obj, FieldRange{})) {
+            return GameResult<T>::err(
+                GameError(ErrorCode::InvalidBinaryData, "truncated compact data"));
+        }
         return GameResult<T>::ok(std::move(obj));
     }
 
@@ -481,20 +1412,29 @@ public:
     /// Serialize an object to JSON string with schema version.
     template <typename T>
     [[nodiscard]] std::string serializeJson(const T& obj) const {
+        std::string out;
+        serializeJsonAppend(obj, out);
+        return out;
+    }
+
+    /// Append @p obj's JSON form to @p out.  Reusing @p out across calls
+    /// makes steady-state encoding allocation-free; numbers are written
+    /// with std::to_chars (shortest round-trip form for floats).
+    template <typename T>
+    void serializeJsonAppend(const T& obj, std::string& out) const {
         static_assert(detail::is_serializable_v<T>,
                       "Type must be registered with CGS_SERIALIZABLE");
 
-        std::ostringstream out;
-        out << "{\"__v\":" << SerializableTraits<T>::schema_version;
+        out += "{\"__v\":";
+        detail::appendJsonNumber(out, SerializableTraits<T>::schema_version);
 
         auto fields = SerializableTraits<T>::fields();
         detail::forEachField(fields, [&](const auto& fd, std::size_t) {
-            out << ',';
+            out += ',';
             detail::writeJsonField(out, fd.name, obj.*(fd.pointer));
         });
 
-        out << '}';
-        return out.str();
+        out += '}';
     }
 
     /// Deserialize an object from JSON string.
@@ -505,87 +1445,144 @@ public:
                       "Type must be registered with CGS_SERIALIZABLE");
 
         detail::JsonReader reader{json};
-
-        if (!reader.expect('{')) {
-            return GameResult<T>::err(GameError(ErrorCode::InvalidJsonData, "expected '{'"));
-        }
-
         T obj{};
-        auto fields = SerializableTraits<T>::fields();
+        if (!detail::readJsonObject(reader, obj)) {
+            return GameResult<T>::err(GameError(ErrorCode::InvalidJsonData, reader.error));
+        }
 
-        bool first = true;
-        while (true) {
-            reader.skipWhitespace();
-            if (reader.pos >= reader.data.size()) {
-                return GameResult<T>::err(
-                    GameError(ErrorCode::InvalidJsonData, "unexpected end of JSON"));
-            }
-            if (reader.data[reader.pos] == '}') {
-                ++reader.pos;
-                break;
-            }
+        return GameResult<T>::ok(std::move(obj));
+    }
 
-            if (!first) {
-                if (!reader.expect(',')) {
-                    return GameResult<T>::err(
-                        GameError(ErrorCode::InvalidJsonData, "expected ','"));
-                }
-            }
-            first = false;
+    // ── Singleton ───────────────────────────────────────────────────────
 
-            // Read key
-            std::string key;
-            if (!reader.readQuotedString(key)) {
-                return GameResult<T>::err(
-                    GameError(ErrorCode::InvalidJsonData, "expected key string"));
-            }
-            if (!reader.expect(':')) {
-                return GameResult<T>::err(GameError(ErrorCode::InvalidJsonData, "expected ':'"));
-            }
+    /// Access the global GameSerializer instance.
+    static GameSerializer& instance();
 
-            // Skip version field
-            if (key == "__v") {
-                reader.skipValue();
-                continue;
-            }
+private:
+    /// Header: magic + schema version + field count.
+    static constexpr std::size_t kBinaryHeaderSize = 4 + sizeof(uint32_t) + sizeof(uint32_t);
 
-            // Match against known fields
-            bool matched = false;
-            detail::forEachField(fields, [&](const auto& fd, std::size_t) {
-                if (matched)
-                    return;
-                if (key != fd.name)
-                    return;
+    template <typename Buffer, typename T>
+    static void writeHeader(Buffer& buf, const uint8_t (&magic)[4]) {
+        detail::writeBytes(buf, magic, 4);
 
-                using FieldType = std::remove_reference_t<decltype(obj.*(fd.pointer))>;
-                std::string rawVal;
-                if (reader.readRawValue(rawVal)) {
-                    FieldType val{};
-                    if (detail::parseJsonValue(rawVal, val)) {
-                        obj.*(fd.pointer) = std::move(val);
-                    }
-                    matched = true;
-                }
-            });
+        uint32_t version = SerializableTraits<T>::schema_version;
+        detail::writePrimitive(buf, version);
 
-            if (!matched) {
-                reader.skipValue();
-            }
-        }
+        constexpr auto numFields =
+            static_cast<uint32_t>(std::tuple_size_v<decltype(SerializableTraits<T>::fields())>);
+        detail::writePrimitive(buf, numFields);
+    }
 
-        return GameResult<T>::ok(std::move(obj));
+    template <typename Buffer, typename T>
+    static void writeBinary(Buffer& buf, const T& obj) {
+        writeHeader<Buffer, T>(buf, kBinaryMagic);
+        detail::writeBinaryFields(buf, obj);
     }
 
-    // ── Singleton ───────────────────────────────────────────────────────
+    /// Validate a header and return its stored field count.
+    [[nodiscard]] static GameResult<uint32_t> readHeader(detail::BinaryReader& reader,
+                                                         const uint8_t (&magic)[4]);
 
-    /// Access the global GameSerializer instance.
-    static GameSerializer& instance();
+    template <typename T>
+    [[nodiscard]] static GameResult<T> readBinary(std::span<const uint8_t> data);
 
-private:
     struct Impl;
     std::unique_ptr<Impl> impl_;
 };
 
+template <typename T>
+GameResult<T> GameSerializer::readBinary(std::span<const uint8_t> data) {
+    static_assert(detail::is_serializable_v<T>,
+                  "Type must be registered with CGS_SERIALIZABLE");
+
+    detail::BinaryReader reader{data};
+    auto header = readHeader(reader, kBinaryMagic);
+    if (header.hasError()) {
+        return GameResult<T>::err(header.error());
+    }
+    const uint32_t storedFieldCount = header.value();
+
+    T obj{};
+    auto fields = SerializableTraits<T>::fields();
+    constexpr uint32_t currentFieldCount =
+        static_cast<uint32_t>(std::tuple_size_v<decltype(fields)>);
+
+    if (storedFieldCount == currentFieldCount && detail::memoryLayoutMatches<T>() &&
+        reader.canRead(sizeof(T))) {
+        detail::readBinaryFields(reader, obj);
+        return GameResult<T>::ok(std::move(obj));
+    }
+
+    // Read min(stored, current) fields; extra fields keep defaults
+    uint32_t fieldsToRead = std::min(storedFieldCount, currentFieldCount);
+
+    detail::forEachField(fields, [&](const auto& fd, std::size_t idx) {
+        if (static_cast<uint32_t>(idx) < fieldsToRead) {
+            detail::readBinaryField(reader, obj.*(fd.pointer));
+        }
+    });
+
+    return GameResult<T>::ok(std::move(obj));
+}
+
+template <typename T>
+GameResult<std::vector<T>> GameSerializer::deserializeArray(std::span<const uint8_t> data) const {
+    static_assert(detail::is_serializable_v<T>,
+                  "Type must be registered with CGS_SERIALIZABLE");
+    using Result = GameResult<std::vector<T>>;
+
+    detail::BinaryReader reader{data};
+    auto header = readHeader(reader, kBinaryArrayMagic);
+    if (header.hasError()) {
+        return Result::err(header.error());
+    }
+    const uint32_t storedFieldCount = header.value();
+    uint32_t count = 0;
+    if (!reader.readPrimitive(count)) {
+        return Result::err(GameError(ErrorCode::InvalidBinaryData, "truncated element count"));
+    }
+
+    auto fields = SerializableTraits<T>::fields();
+    constexpr uint32_t currentFieldCount =
+        static_cast<uint32_t>(std::tuple_size_v<decltype(fields)>);
+    if (storedFieldCount > currentFieldCount) {
+        return Result::err(GameError(ErrorCode::InvalidBinaryData,
+                                     "array elements have fields unknown to this schema"));
+    }
+
+    std::vector<T> out;
+    if constexpr (detail::binary_layout_t<T>::bulk) {
+        if (storedFieldCount == currentFieldCount && detail::memoryLayoutMatches<T>()) {
+            const std::size_t bytes = std::size_t{count} * sizeof(T);
+            if (!reader.canRead(bytes)) {
+                return Result::err(GameError(ErrorCode::InvalidBinaryData, "truncated array"));
+            }
+            out.resize(count);
+            if (bytes > 0) {
+                std::memcpy(out.data(), reader.data.data() + reader.pos, bytes);
+            }
+            return Result::ok(std::move(out));
+        }
+    }
+
+    // Element-wise: every element must decode completely.
+    out.reserve(std::min<std::size_t>(count, data.size() - reader.pos));
+    for (uint32_t n = 0; n < count; ++n) {
+        T& obj = out.emplace_back();
+        bool ok = true;
+        detail::forEachField(fields, [&](const auto& fd, std::size_t idx) {
+            if (ok && static_cast<uint32_t>(idx) < storedFieldCount) {
+                ok = detail::readBinaryField(reader, obj.*(fd.pointer));
+            }
+        });
+        if (!ok) {
+            return Result::err(GameError(ErrorCode::InvalidBinaryData, "truncated array"));
+        }
+    }
+    return Result::ok(std::move(out));
+}
+
 }  // namespace cgs::foundation
 
 // ── CGS_SERIALIZABLE macro ──────────────────────────────────────────────────
@@ -593,14 +1590,16 @@ private:
 ///
 /// @param Type     The struct/class type to register.
 /// @param Version  Schema version number (uint32_t).
-/// @param ...      field("name", &Type::member) descriptors.
+/// @param ...      field("name", &Type::member) descriptors, optionally
+///                 with a FieldRange for the compact form.
 ///
 /// Example:
 /// @code
 ///   CGS_SERIALIZABLE(PlayerData, 1,
 ///       field("id", &PlayerData::id),
 ///       field("name", &PlayerData::name),
-///       field("level", &PlayerData::level)
+///       field("level", &PlayerData::level, FieldRange{1, 100}),
+///       field("x", &PlayerData::x, FieldRange{-5000, 5000, 0.01})
 ///   );
 /// @endcode
 // NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
@@ -611,6 +1610,7 @@ private:
         static constexpr uint32_t schema_version = Version; \
         static constexpr auto fields() {                    \
             using cgs::foundation::field;                   \
+            using cgs::foundation::FieldRange;              \
             return std::make_tuple(__VA_ARGS__);            \
         }                                                   \
     }
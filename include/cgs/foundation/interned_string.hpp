@@ -0,0 +1,242 @@
+#pragma once
+
+/// @file interned_string.hpp
+/// @brief Process-wide string interning with stable 32-bit ids.
+///
+/// Names that many objects repeat -- character, guild, item template and
+/// service names -- are stored once in StringInterner::instance() and
+/// referred to by an InternedString: a 32-bit id that copies, hashes and
+/// compares as an integer.  Interned text lives in an append-only arena,
+/// so a view of it stays valid for the life of the process, and ids are
+/// never reused.  Interning locks (shared on a hit, exclusive on a miss);
+/// reading an id's text takes no lock.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace cgs::foundation {
+
+/// Thread-safe table of interned strings.
+///
+/// Ids are dense and assigned in order of first use; id 0 is the empty
+/// string.  Text is copied into 64 KiB arena chunks, NUL-terminated.
+class StringInterner {
+public:
+    /// Id of the empty string.
+    static constexpr uint32_t kEmptyId = 0;
+
+    /// The process-wide table used by InternedString.
+    static StringInterner& instance() {
+        static StringInterner table;
+        return table;
+    }
+
+    StringInterner() = default;
+    StringInterner(const StringInterner&) = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+
+    ~StringInterner() {
+        for (std::size_t i = 0; i < kPageCount; ++i) {
+            delete[] pages_[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    /// Id of @p text, interning a copy of it on first use.
+    uint32_t intern(std::string_view text) {
+        if (text.empty()) {
+            return kEmptyId;
+        }
+        {
+            std::shared_lock lock(mutex_);
+            if (auto it = ids_.find(text); it != ids_.end()) {
+                return it->second;
+            }
+        }
+        std::unique_lock lock(mutex_);
+        if (auto it = ids_.find(text); it != ids_.end()) {
+            return it->second;
+        }
+        const std::string_view stored = store(text);
+        const auto id = static_cast<uint32_t>(count_.load(std::memory_order_relaxed));
+        auto& page = pages_[id >> kPageBits];
+        Entry* entries = page.load(std::memory_order_relaxed);
+        if (entries == nullptr) {
+            entries = new Entry[kPageSize];  // Left uninitialized until used
+            page.store(entries, std::memory_order_release);
+        }
+        entries[id & kPageMask] = Entry{stored.data(), stored.size()};
+        count_.store(std::size_t{id} + 1, std::memory_order_release);
+        ids_.emplace(stored, id);
+        return id;
+    }
+
+    /// Id of @p text if it was interned.
+    [[nodiscard]] std::optional<uint32_t> find(std::string_view text) const {
+        if (text.empty()) {
+            return kEmptyId;
+        }
+        std::shared_lock lock(mutex_);
+        auto it = ids_.find(text);
+        if (it == ids_.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    /// Text of @p id, NUL-terminated (empty for id 0 and unknown ids).
+    /// Lock-free.
+    [[nodiscard]] std::string_view view(uint32_t id) const noexcept {
+        if (id == kEmptyId || id >= count_.load(std::memory_order_acquire)) {
+            return {};
+        }
+        const Entry* page = pages_[id >> kPageBits].load(std::memory_order_acquire);
+        return {page[id & kPageMask].data, page[id & kPageMask].size};
+    }
+
+    /// Number of ids handed out, the empty string's included.
+    [[nodiscard]] std::size_t size() const noexcept {
+        return count_.load(std::memory_order_acquire);
+    }
+
+    /// Bytes of arena holding interned text.
+    [[nodiscard]] std::size_t arenaBytes() const {
+        std::shared_lock lock(mutex_);
+        return arenaBytes_;
+    }
+
+private:
+    static constexpr std::size_t kChunkSize = 64 * 1024;
+    static constexpr unsigned kPageBits = 16;
+    static constexpr std::size_t kPageSize = std::size_t{1} << kPageBits;
+    static constexpr uint32_t kPageMask = kPageSize - 1;
+    static constexpr std::size_t kPageCount = std::size_t{1} << (32 - kPageBits);
+
+    // Text of one id; trivial, so a page is not written until used
+    struct Entry {
+        const char* data;
+        std::size_t size;
+    };
+
+    // Copy @p text into the arena.  Caller holds mutex_ exclusively.
+    std::string_view store(std::string_view text) {
+        const std::size_t need = text.size() + 1;
+        char* out = nullptr;
+        if (need > kChunkSize / 4) {
+            // Long strings get a block of their own rather than waste a chunk
+            out = chunks_.emplace_back(std::make_unique_for_overwrite<char[]>(need)).get();
+            arenaBytes_ += need;
+        } else {
+            if (current_ == nullptr || chunkUsed_ + need > kChunkSize) {
+                chunks_.push_back(std::make_unique_for_overwrite<char[]>(kChunkSize));
+                current_ = chunks_.back().get();
+                chunkUsed_ = 0;
+                arenaBytes_ += kChunkSize;
+            }
+            out = current_ + chunkUsed_;
+            chunkUsed_ += need;
+        }
+        std::memcpy(out, text.data(), text.size());
+        out[text.size()] = '\0';
+        return {out, text.size()};
+    }
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string_view, uint32_t> ids_;  // keys point into the arena
+    std::vector<std::unique_ptr<char[]>> chunks_;
+    char* current_ = nullptr;  // chunk being filled
+    std::size_t chunkUsed_ = 0;
+    std::size_t arenaBytes_ = 0;
+
+    // Id -> text in pages of kPageSize, each published before count_
+    // covers its ids
+    std::unique_ptr<std::atomic<Entry*>[]> pages_ =
+        std::make_unique<std::atomic<Entry*>[]>(kPageCount);
+    std::atomic<std::size_t> count_{1};  // id 0 is the empty string
+};
+
+/// A string interned in StringInterner::instance().
+///
+/// Converts implicitly from and to string views, so it stands in for a
+/// std::string name field: assigning text interns it, and comparing with
+/// text compares characters.  Comparing two InternedStrings compares ids.
+/// Ids are per process: serialize the text, not id().
+///
+/// Usage:
+/// @code
+///   InternedString name = "Thrall";      // Interned once
+///   InternedString copy = name;          // Copies 4 bytes
+///   bool same = copy == name;            // One integer comparison
+///   std::string_view text = name;        // Valid until process exit
+/// @endcode
+class InternedString {
+public:
+    /// The empty string.
+    constexpr InternedString() noexcept = default;
+
+    InternedString(std::string_view text) : id_(StringInterner::instance().intern(text)) {}
+    InternedString(const std::string& text) : InternedString(std::string_view(text)) {}
+    InternedString(const char* text) : InternedString(std::string_view(text)) {}
+
+    /// The string with id @p id, as returned by id().
+    [[nodiscard]] static InternedString fromId(uint32_t id) noexcept {
+        InternedString out;
+        out.id_ = id;
+        return out;
+    }
+
+    [[nodiscard]] uint32_t id() const noexcept { return id_; }
+    [[nodiscard]] bool empty() const noexcept { return id_ == StringInterner::kEmptyId; }
+
+    [[nodiscard]] std::string_view view() const noexcept {
+        return StringInterner::instance().view(id_);
+    }
+
+    /// NUL-terminated text.
+    [[nodiscard]] const char* c_str() const noexcept {
+        return empty() ? "" : view().data();
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return view().size(); }
+
+    /// Copy of the text.
+    [[nodiscard]] std::string str() const { return std::string(view()); }
+
+    operator std::string_view() const noexcept { return view(); }
+
+    friend bool operator==(InternedString a, InternedString b) noexcept {
+        return a.id_ == b.id_;
+    }
+    friend bool operator==(InternedString a, std::string_view b) noexcept {
+        return a.view() == b;
+    }
+    friend bool operator==(InternedString a, const std::string& b) noexcept {
+        return a.view() == b;
+    }
+    friend bool operator==(InternedString a, const char* b) noexcept {
+        return a.view() == b;
+    }
+
+private:
+    uint32_t id_ = StringInterner::kEmptyId;
+};
+
+}  // namespace cgs::foundation
+
+// Hash support for use in unordered containers.
+template <>
+struct std::hash<cgs::foundation::InternedString> {
+    std::size_t operator()(cgs::foundation::InternedString s) const noexcept {
+        return std::hash<uint32_t>{}(s.id());
+    }
+};
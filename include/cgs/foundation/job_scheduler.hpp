@@ -3,13 +3,20 @@
 /// @file job_scheduler.hpp
 /// @brief GameJobScheduler wrapping kcenon thread_system for game-specific job scheduling.
 
+#include "cgs/foundation/cpu_affinity.hpp"
 #include "cgs/foundation/game_result.hpp"
 
 #include <chrono>
+#include <coroutine>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <new>
 #include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace cgs::foundation {
 
@@ -19,25 +26,234 @@ namespace cgs::foundation {
 ///   Critical -> highest, High -> high, Normal -> normal, Low -> low
 enum class JobPriority { Critical, High, Normal, Low };
 
+/// Move-only `void()` callable that stores captures of up to kInlineSize
+/// bytes in place, so wrapping a small lambda allocates nothing.  Larger
+/// (or throwing-move) callables fall back to one heap allocation.
+class InlineJob {
+public:
+    static constexpr std::size_t kInlineSize = 64;
+
+    InlineJob() noexcept = default;
+
+    template <typename F,
+              typename Fn = std::decay_t<F>,
+              typename = std::enable_if_t<!std::is_same_v<Fn, InlineJob> &&
+                                          std::is_invocable_r_v<void, Fn&>>>
+    InlineJob(F&& fn) {  // NOLINT(google-explicit-constructor)
+        if constexpr (fitsInline<Fn>()) {
+            ::new (static_cast<void*>(storage_)) Fn(std::forward<F>(fn));
+            ops_ = &kInlineOps<Fn>;
+        } else {
+            ::new (static_cast<void*>(storage_)) Fn*(new Fn(std::forward<F>(fn)));
+            ops_ = &kHeapOps<Fn>;
+        }
+    }
+
+    InlineJob(InlineJob&& other) noexcept : ops_(other.ops_) {
+        if (ops_ != nullptr) {
+            ops_->relocate(storage_, other.storage_);
+            other.ops_ = nullptr;
+        }
+    }
+
+    InlineJob& operator=(InlineJob&& other) noexcept {
+        if (this != &other) {
+            reset();
+            ops_ = other.ops_;
+            if (ops_ != nullptr) {
+                ops_->relocate(storage_, other.storage_);
+                other.ops_ = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    InlineJob(const InlineJob&) = delete;
+    InlineJob& operator=(const InlineJob&) = delete;
+
+    ~InlineJob() { reset(); }
+
+    void operator()() { ops_->invoke(storage_); }
+
+    explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+    /// Whether the callable lives in place (no heap allocation).
+    [[nodiscard]] bool isInline() const noexcept { return ops_ != nullptr && !ops_->heap; }
+
+    void reset() noexcept {
+        if (ops_ != nullptr) {
+            ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+    }
+
+private:
+    struct Ops {
+        void (*invoke)(void*);
+        void (*relocate)(void* dst, void* src) noexcept;  // Move, then destroy src
+        void (*destroy)(void*) noexcept;
+        bool heap;
+    };
+
+    template <typename Fn>
+    static constexpr bool fitsInline() {
+        return sizeof(Fn) <= kInlineSize && alignof(Fn) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible_v<Fn>;
+    }
+
+    template <typename Fn>
+    static Fn& as(void* p) noexcept {
+        return *std::launder(static_cast<Fn*>(p));
+    }
+
+    template <typename Fn>
+    static constexpr Ops kInlineOps{
+        [](void* p) { as<Fn>(p)(); },
+        [](void* dst, void* src) noexcept {
+            ::new (dst) Fn(std::move(as<Fn>(src)));
+            as<Fn>(src).~Fn();
+        },
+        [](void* p) noexcept { as<Fn>(p).~Fn(); },
+        false,
+    };
+
+    template <typename Fn>
+    static constexpr Ops kHeapOps{
+        [](void* p) { (*as<Fn*>(p))(); },
+        [](void* dst, void* src) noexcept { ::new (dst) Fn*(as<Fn*>(src)); },
+        [](void* p) noexcept { delete as<Fn*>(p); },
+        true,
+    };
+
+    alignas(std::max_align_t) unsigned char storage_[kInlineSize];
+    const Ops* ops_ = nullptr;
+};
+
+/// Counters of GameJobScheduler's native path (submit()).
+struct JobSchedulerStats {
+    uint64_t submitted = 0;  ///< Jobs accepted by submit().
+    uint64_t executed = 0;   ///< Jobs run to completion (or skipped once cancelled).
+    uint64_t stolen = 0;     ///< Jobs a worker took from another worker's deque.
+    uint64_t cancelled = 0;  ///< Jobs skipped because cancel() reached them first.
+    uint64_t failed = 0;     ///< Jobs that threw (the exception is discarded).
+    uint64_t heapJobs = 0;   ///< Jobs whose captures did not fit in place.
+};
+
+namespace detail {
+struct GraphRun;
+}  // namespace detail
+
+/// Jobs with N-to-M ordering edges, run as a unit by GameJobScheduler::run().
+///
+/// Each node keeps a count of unfinished predecessors; the node that drops
+/// a successor's count to zero submits it, so no thread waits on a single
+/// dependency.  A graph can be run again: run() restores the counts, and
+/// node jobs are invoked, not consumed.
+///
+/// Example:
+/// @code
+///   JobGraph frame;
+///   auto physics = frame.add([&] { stepPhysics(); });
+///   auto ai = frame.add([&] { thinkAI(); });
+///   auto sync = frame.add([&] { syncTransforms(); });
+///   frame.precede(physics, sync);
+///   frame.precede(ai, sync);
+///   scheduler.run(frame);  // physics and ai in parallel, then sync
+/// @endcode
+class JobGraph {
+public:
+    using NodeId = uint32_t;
+
+    JobGraph();
+    ~JobGraph();
+
+    JobGraph(JobGraph&&) noexcept;
+    JobGraph& operator=(JobGraph&&) noexcept;
+    JobGraph(const JobGraph&) = delete;
+    JobGraph& operator=(const JobGraph&) = delete;
+
+    /// Add a node running @p job.
+    NodeId add(InlineJob job);
+
+    /// Require @p before to finish before @p after starts.
+    /// @return JobNotFound if either node is not in this graph.
+    GameResult<void> precede(NodeId before, NodeId after);
+
+    [[nodiscard]] std::size_t size() const noexcept { return nodes_.size(); }
+
+    [[nodiscard]] bool empty() const noexcept { return nodes_.empty(); }
+
+    /// Remove every node and edge.
+    void clear();
+
+private:
+    friend class GameJobScheduler;
+    friend struct detail::GraphRun;
+
+    struct Node {
+        InlineJob job;
+        std::vector<NodeId> successors;
+        uint32_t predecessors = 0;
+    };
+
+    /// Whether the edges form a DAG (Kahn's algorithm), cached until the
+    /// next add()/precede().
+    [[nodiscard]] bool acyclic();
+
+    std::vector<Node> nodes_;
+    bool checked_ = false;
+    bool acyclic_ = true;
+    /// Counters of the last run, reused when no job still references them.
+    std::shared_ptr<detail::GraphRun> run_;
+};
+
 /// Game-specific job scheduler wrapping kcenon's thread_system.
 ///
 /// Provides priority-based scheduling, dependency chaining, and tick-based
 /// recurring jobs for the game loop. Uses PIMPL to hide thread_system details
 /// from the public API, preventing header dependency leakage.
 ///
+/// submit() is a native fast path beside the kcenon pool: jobs are stored
+/// in a generation-indexed slot array (no map, no lock, no allocation for
+/// small captures) and run by the scheduler's own workers, each with a
+/// Chase-Lev deque that idle workers steal from.  Jobs submitted from a
+/// worker go to its own deque; others go through a shared injection
+/// queue.  The native workers start on the first submit().
+///
+/// run(), parallelFor(), parallelReduce() and runBatch() build on that
+/// path, and every wait on it helps: the waiting thread runs queued jobs
+/// until the one it waits for is done, so nested parallelism from inside
+/// a job cannot starve the pool.  runBatch() matches the ECS
+/// ParallelExecutor signature.
+///
 /// Example:
 /// @code
 ///   GameJobScheduler scheduler(4);
 ///   auto id = scheduler.schedule([] { computeAI(); }, JobPriority::High);
 ///   scheduler.wait(id.value());
+///
+///   auto fast = scheduler.submit([&chunk] { integrate(chunk); });
+///   scheduler.wait(fast.value());
+///
+///   scheduler.parallelFor(0, particles.size(), 256, [&](std::size_t first, std::size_t last) {
+///       for (auto i = first; i < last; ++i) particles[i].integrate(dt);
+///   });
+///   systems.SetParallelExecutor([&](const auto& tasks) { scheduler.runBatch(tasks); });
 /// @endcode
 class GameJobScheduler {
 public:
     using JobId = uint64_t;
     using JobFunc = std::function<void()>;
 
-    /// Construct a scheduler backed by a thread pool with @p numThreads workers.
-    explicit GameJobScheduler(std::size_t numThreads = std::thread::hardware_concurrency());
+    /// Construct a scheduler backed by a thread pool with @p numThreads
+    /// workers (by default one per CPU the process may use, within its
+    /// cgroup quota; see availableCpuCount()).
+    explicit GameJobScheduler(std::size_t numThreads = availableCpuCount());
+
+    /// As above, pinning native worker i to CPU @p affinity[i % size]
+    /// (see ThreadPlacement::workers).  Jobs run through schedule() use
+    /// the kcenon pool, which is not pinned.
+    GameJobScheduler(std::size_t numThreads, CpuSet affinity);
 
     ~GameJobScheduler();
 
@@ -51,16 +267,114 @@ public:
     /// @return The assigned JobId on success, or a GameError on failure.
     GameResult<JobId> schedule(JobFunc job, JobPriority priority = JobPriority::Normal);
 
+    /// Run @p job on the native work-stealing workers, without priority.
+    /// wait() and cancel() accept the returned id; a job that throws
+    /// counts as failed and its wait() still succeeds.
+    /// @return The assigned JobId, or JobScheduleFailed if the scheduler
+    ///         has no workers or the slot array is exhausted.
+    GameResult<JobId> submit(InlineJob job);
+
+    /// Counters of the native path.
+    [[nodiscard]] JobSchedulerStats stats() const;
+
+    /// Run every node of @p graph once its predecessors finished, and
+    /// return when all are done; the calling thread helps.  A node that
+    /// throws counts as failed and still releases its successors.
+    /// @return JobDependencyFailed if the edges contain a cycle.
+    GameResult<void> run(JobGraph& graph);
+
+    /// Call @p fn(first, last) over consecutive chunks of [begin, end) of
+    /// @p grain elements (the last may be shorter), in parallel, and
+    /// return when all are done.  The first exception thrown by @p fn is
+    /// rethrown once every chunk has finished or been skipped.
+    void parallelFor(std::size_t begin,
+                     std::size_t end,
+                     std::size_t grain,
+                     const std::function<void(std::size_t, std::size_t)>& fn);
+
+    /// Reduce [begin, end) in chunks of @p grain: `map(first, last)` gives
+    /// each chunk's value, which are folded left to right (deterministic
+    /// for any worker count) with `combine(accumulated, value)`, starting
+    /// from @p identity.
+    template <typename T, typename Map, typename Combine>
+    T parallelReduce(std::size_t begin,
+                     std::size_t end,
+                     std::size_t grain,
+                     T identity,
+                     Map&& map,
+                     Combine&& combine) {
+        if (begin >= end) {
+            return identity;
+        }
+        if (grain == 0) {
+            grain = 1;
+        }
+        const std::size_t chunks = (end - begin + grain - 1) / grain;
+        std::vector<T> partials(chunks, identity);
+        parallelFor(0, chunks, 1, [&](std::size_t first, std::size_t last) {
+            for (std::size_t chunk = first; chunk < last; ++chunk) {
+                const std::size_t from = begin + chunk * grain;
+                partials[chunk] = map(from, from + grain < end ? from + grain : end);
+            }
+        });
+        T result = std::move(identity);
+        for (auto& partial : partials) {
+            result = combine(std::move(result), std::move(partial));
+        }
+        return result;
+    }
+
+    /// Run every task of @p tasks in parallel and return when all are
+    /// done.  Usable as SystemScheduler / Query ParallelExecutor.
+    void runBatch(const std::vector<std::function<void()>>& tasks);
+
+    /// Awaitable: `co_await scheduler.resumeOnWorker()` continues the
+    /// coroutine on a native worker (inline if none can take it).
+    [[nodiscard]] auto resumeOnWorker() noexcept {
+        struct Awaiter {
+            GameJobScheduler* scheduler;
+
+            bool await_ready() const noexcept { return false; }
+
+            bool await_suspend(std::coroutine_handle<> handle) {
+                return scheduler->submit([handle] { handle.resume(); }).hasValue();
+            }
+
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{this};
+    }
+
     /// Schedule a job to execute after the given dependency completes.
     /// @return The assigned JobId, or JobNotFound if the dependency is unknown.
     GameResult<JobId> scheduleAfter(JobId dependency, JobFunc job);
 
-    /// Register a recurring tick job that fires every @p interval.
-    /// The job is dispatched into the thread pool each time it fires.
+    /// Register a recurring tick job that fires every @p interval of tick
+    /// time, first at tickTime() + @p interval.  Deadlines advance at a
+    /// fixed rate, so a processTick() spanning several intervals fires
+    /// the job once per elapsed interval; a zero interval fires once per
+    /// processTick().  The job is stored once and dispatched onto the
+    /// native workers each time it fires.
     /// @return The assigned JobId for the tick entry.
     GameResult<JobId> scheduleTick(std::chrono::milliseconds interval, JobFunc job);
 
-    /// Advance tick timers by @p deltaTime and dispatch due tick jobs.
+    /// Run @p job once, in the first processTick() that reaches tick time
+    /// @p when (the next one if @p when has passed).  Captures of up to
+    /// InlineJob::kInlineSize bytes are stored without allocating.
+    /// @return The assigned JobId; cancel() accepts it until it fires.
+    GameResult<JobId> scheduleAt(std::chrono::milliseconds when, InlineJob job);
+
+    /// Run @p job once, @p delay of tick time from now.
+    /// @see scheduleAt()
+    GameResult<JobId> scheduleDelay(std::chrono::milliseconds delay, InlineJob job);
+
+    /// Tick time: the sum of every processTick() delta so far.
+    [[nodiscard]] std::chrono::milliseconds tickTime() const;
+
+    /// Advance tick time by @p deltaTime and dispatch the timed jobs that
+    /// became due, in deadline order.  Timers live on a hierarchical
+    /// timing wheel: scheduling and cancelling are O(1), and the cost of
+    /// a call depends on the timers that expire, not on how many exist.
     /// Call this once per game-loop iteration from the main thread.
     void processTick(std::chrono::milliseconds deltaTime);
 
@@ -68,8 +382,9 @@ public:
     /// @return Success, or JobNotFound / JobTimeout on failure.
     GameResult<void> wait(JobId id);
 
-    /// Request cancellation of a pending job.
-    /// Already-completed jobs return JobCancelled as a no-op error.
+    /// Request cancellation of a pending job, or remove a timed job.
+    /// Already-completed jobs return JobCancelled as a no-op error; a
+    /// timed job that already fired (or was cancelled) is JobNotFound.
     GameResult<void> cancel(JobId id);
 
 private:
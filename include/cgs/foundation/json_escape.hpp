@@ -0,0 +1,111 @@
+#pragma once
+
+/// @file json_escape.hpp
+/// @brief Allocation-free JSON string escaping shared by GameSerializer
+///        and JsonLogFormatter.
+///
+/// appendJsonEscaped() scans eight bytes at a time (SWAR: one 64-bit load
+/// and a few integer ops per word) and copies runs that need no escaping
+/// with a single append, so plain text costs one memchr-like pass.  Only
+/// words that contain a quote, a backslash or a control character fall
+/// back to the per-byte switch.  Bytes >= 0x80 pass through unchanged, so
+/// UTF-8 input stays UTF-8.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace cgs::foundation {
+
+namespace detail {
+
+inline constexpr uint64_t kJsonByteOnes = 0x0101010101010101ULL;
+inline constexpr uint64_t kJsonByteHighs = 0x8080808080808080ULL;
+
+/// Whether any byte of @p word is '"', '\\' or below 0x20.
+[[nodiscard]] constexpr bool jsonWordNeedsEscape(uint64_t word) noexcept {
+    // (x - n) & ~x & 0x80 flags bytes below n (n <= 0x80); a zero test
+    // of x ^ c flags bytes equal to c.  Borrows can only add false flags
+    // above a true one, so the "any" answer is exact.
+    const uint64_t quote = word ^ (kJsonByteOnes * '"');
+    const uint64_t slash = word ^ (kJsonByteOnes * '\\');
+    const uint64_t flags = ((word - kJsonByteOnes * 0x20) & ~word) |
+                           ((quote - kJsonByteOnes) & ~quote) |
+                           ((slash - kJsonByteOnes) & ~slash);
+    return (flags & kJsonByteHighs) != 0;
+}
+
+inline void appendJsonEscapedChar(std::string& out, char c) {
+    switch (c) {
+        case '"':
+            out += "\\\"";
+            break;
+        case '\\':
+            out += "\\\\";
+            break;
+        case '\b':
+            out += "\\b";
+            break;
+        case '\f':
+            out += "\\f";
+            break;
+        case '\n':
+            out += "\\n";
+            break;
+        case '\r':
+            out += "\\r";
+            break;
+        case '\t':
+            out += "\\t";
+            break;
+        default: {
+            const auto byte = static_cast<unsigned char>(c);
+            if (byte < 0x20) {
+                constexpr char kHex[] = "0123456789abcdef";
+                const char escaped[6] = {'\\', 'u', '0', '0', kHex[byte >> 4], kHex[byte & 0xF]};
+                out.append(escaped, sizeof(escaped));
+            } else {
+                out += c;
+            }
+            break;
+        }
+    }
+}
+
+}  // namespace detail
+
+/// Append @p value to @p out with JSON string escaping (no surrounding
+/// quotes).  Control characters without a short form become \\u00XX.
+inline void appendJsonEscaped(std::string& out, std::string_view value) {
+    const char* const data = value.data();
+    const std::size_t size = value.size();
+    std::size_t clean = 0;  // Start of the pending unescaped run.
+    std::size_t i = 0;
+
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t word = 0;
+        std::memcpy(&word, data + i, sizeof(word));
+        if (!detail::jsonWordNeedsEscape(word)) {
+            continue;
+        }
+        out.append(data + clean, i - clean);
+        for (std::size_t k = 0; k < sizeof(uint64_t); ++k) {
+            detail::appendJsonEscapedChar(out, data[i + k]);
+        }
+        clean = i + sizeof(uint64_t);
+    }
+    for (; i < size; ++i) {
+        const auto byte = static_cast<unsigned char>(data[i]);
+        if (byte >= 0x20 && byte != '"' && byte != '\\') {
+            continue;
+        }
+        out.append(data + clean, i - clean);
+        detail::appendJsonEscapedChar(out, data[i]);
+        clean = i + 1;
+    }
+    out.append(data + clean, size - clean);
+}
+
+}  // namespace cgs::foundation
@@ -8,6 +8,7 @@
 
 #include "cgs/foundation/game_logger.hpp"
 
+#include <chrono>
 #include <string>
 #include <string_view>
 
@@ -67,6 +68,14 @@ public:
                                             LogCategory category,
                                             std::string_view message,
                                             const LogContext& ctx = {});
+
+    /// Same, stamped with @p timestamp instead of the current time (the
+    /// async writer formats records after the fact).
+    [[nodiscard]] static std::string format(LogLevel level,
+                                            LogCategory category,
+                                            std::string_view message,
+                                            const LogContext& ctx,
+                                            std::chrono::system_clock::time_point timestamp);
 };
 
 }  // namespace cgs::foundation
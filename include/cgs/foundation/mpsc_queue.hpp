@@ -0,0 +1,113 @@
+#pragma once
+
+/// @file mpsc_queue.hpp
+/// @brief Bounded multi-producer/single-consumer ring queue.
+///
+/// MpscQueue<T> hands values from any number of producer threads to one
+/// consumer thread without locks.  Producers claim a position with a CAS
+/// on the tail; each slot carries a sequence number that says whether it
+/// is free for the claiming lap or holds a value the consumer may take,
+/// so a push or pop touches one slot plus one shared index.  Positions
+/// are handed out in claim order, which is also the order the consumer
+/// sees values in: tryPush() can report the position as a ticket.
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace cgs::foundation {
+
+template <typename T>
+class MpscQueue {
+public:
+    /// A queue holding at least @p capacity values (rounded up to a power
+    /// of two).
+    explicit MpscQueue(std::size_t capacity)
+        : capacity_(std::bit_ceil(capacity < 2 ? std::size_t{2} : capacity)),
+          mask_(capacity_ - 1),
+          slots_(std::make_unique<Slot[]>(capacity_)) {
+        for (std::size_t i = 0; i < capacity_; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /// Producer: append @p value.  @return false (value untouched) if full.
+    bool tryPush(T&& value) {
+        uint64_t position = 0;
+        return tryPush(std::move(value), position);
+    }
+
+    /// Producer: append @p value and store its position (0 for the first
+    /// value ever pushed) in @p position.  @return false if full.
+    bool tryPush(T&& value, uint64_t& position) {
+        uint64_t tail = tail_.load(std::memory_order_relaxed);
+        while (true) {
+            auto& slot = slots_[tail & mask_];
+            const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence == tail) {
+                if (tail_.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed)) {
+                    slot.value.emplace(std::move(value));
+                    slot.sequence.store(tail + 1, std::memory_order_release);
+                    position = tail;
+                    return true;
+                }
+            } else if (sequence < tail) {
+                return false;  // The slot still holds last lap's value.
+            } else {
+                tail = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// Consumer: remove the oldest value into @p out.  @return false if
+    /// empty, or if the oldest claimed slot is still being written.
+    bool tryPop(T& out) {
+        const uint64_t head = head_.load(std::memory_order_relaxed);
+        auto& slot = slots_[head & mask_];
+        if (slot.sequence.load(std::memory_order_acquire) != head + 1) {
+            return false;
+        }
+        out = std::move(*slot.value);
+        slot.value.reset();
+        slot.sequence.store(head + capacity_, std::memory_order_release);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Values claimed and not yet popped; exact only when no side is running.
+    [[nodiscard]] std::size_t size() const noexcept {
+        return static_cast<std::size_t>(tail_.load(std::memory_order_acquire) -
+                                        head_.load(std::memory_order_acquire));
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+
+    /// Positions claimed so far: the position the next push will get.
+    [[nodiscard]] uint64_t claimed() const noexcept {
+        return tail_.load(std::memory_order_acquire);
+    }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> sequence{0};
+        std::optional<T> value;
+    };
+
+    const std::size_t capacity_;
+    const std::size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+
+    alignas(64) std::atomic<uint64_t> head_{0};  ///< Written by the consumer.
+    alignas(64) std::atomic<uint64_t> tail_{0};  ///< Claimed by producers.
+};
+
+}  // namespace cgs::foundation
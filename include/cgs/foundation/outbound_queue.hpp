@@ -0,0 +1,136 @@
+#pragma once
+
+/// @file outbound_queue.hpp
+/// @brief Per-session batch of outbound frames, flushed once per tick.
+///
+/// OutboundQueue holds a session's frames in three priority lanes and
+/// concatenates them into one byte batch so a tick's worth of small
+/// updates reaches the transport as a single write.  The receive path
+/// already parses several frames per callback, so a batch is
+/// indistinguishable on the wire from back-to-back sends.
+///
+/// Each lane has a byte budget, and a per-flush byte limit plays the part
+/// of the client's bandwidth: frames that do not fit stay queued for the
+/// next flush, so a client that falls behind accumulates backlog here,
+/// where it is bounded, instead of in the transport.  Part of the Network
+/// System Adapter (SDS-MOD-004).
+
+#include "cgs/foundation/wire_buffer.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace cgs::foundation {
+
+/// Outbound priority lane.  Flushes drain Critical, then State, then Bulk;
+/// order is kept within a lane only.
+enum class SendLane : uint8_t {
+    Critical,  ///< Combat, login, acks: never dropped; rejected past budget.
+    State,     ///< Entity state: a newer update for the same key replaces
+               ///< the queued one; the oldest are dropped past budget.
+    Bulk,      ///< Chat, mail, downloads: rejected past budget.
+};
+
+inline constexpr std::size_t kSendLaneCount = 3;
+
+/// Byte limits of one session's outbound queue.
+struct LaneBudgets {
+    std::size_t critical = 1024 * 1024;
+    std::size_t state = 64 * 1024;
+    std::size_t bulk = 256 * 1024;
+    /// Most bytes one flush hands to the transport (0 = no limit).  A
+    /// single frame larger than this is still sent, alone.
+    std::size_t bytesPerFlush = 0;
+
+    [[nodiscard]] std::size_t of(SendLane lane) const noexcept {
+        switch (lane) {
+            case SendLane::Critical:
+                return critical;
+            case SendLane::State:
+                return state;
+            case SendLane::Bulk:
+                return bulk;
+        }
+        return 0;
+    }
+};
+
+/// Outbound counters of one session.
+struct OutboundStats {
+    std::size_t queueDepth = 0;     ///< Messages waiting for the next flush.
+    std::size_t bytesInFlight = 0;  ///< Queued bytes not yet handed to the transport.
+    std::array<std::size_t, kSendLaneCount> laneBytes{};  ///< bytesInFlight per lane.
+    uint64_t batchesSent = 0;    ///< Flushes that handed a batch to the transport.
+    uint64_t messagesSent = 0;   ///< Messages carried by those batches.
+    uint64_t stateReplaced = 0;  ///< State frames superseded by a newer one.
+    uint64_t stateDropped = 0;   ///< State frames dropped past the lane budget.
+    uint64_t rejected = 0;       ///< Critical/Bulk frames refused past budget.
+};
+
+/// Outcome of OutboundQueue::push().
+enum class EnqueueResult : uint8_t {
+    Queued,    ///< Queued (or replaced a stale state frame).
+    FlushNow,  ///< Queued, and the queue reached its flush threshold.
+    Rejected,  ///< Not queued: the lane is over budget.
+};
+
+/// Lanes of frames for one session.  Not thread-safe.
+class OutboundQueue {
+public:
+    /// Default batch size that triggers a flush before the end of the tick.
+    static constexpr std::size_t kDefaultFlushThreshold = 16 * 1024;
+
+    explicit OutboundQueue(std::size_t flushThreshold = kDefaultFlushThreshold,
+                           LaneBudgets budgets = {})
+        : flushThreshold_(flushThreshold), budgets_(budgets) {}
+
+    /// Queue @p frame on @p lane.  On the State lane a nonzero
+    /// @p stateKey (usually the entity id) replaces the frame still queued
+    /// under the same key.
+    EnqueueResult push(WireBuffer frame, SendLane lane = SendLane::Critical, uint64_t stateKey = 0);
+
+    /// Take the next batch in lane priority order, at most
+    /// LaneBudgets::bytesPerFlush bytes (empty when nothing is queued),
+    /// and count it as sent.
+    [[nodiscard]] std::vector<uint8_t> take();
+
+    [[nodiscard]] bool empty() const noexcept { return depth_ == 0; }
+
+    void setFlushThreshold(std::size_t bytes) noexcept { flushThreshold_ = bytes; }
+    [[nodiscard]] std::size_t flushThreshold() const noexcept { return flushThreshold_; }
+
+    void setBudgets(const LaneBudgets& budgets) noexcept { budgets_ = budgets; }
+    [[nodiscard]] const LaneBudgets& budgets() const noexcept { return budgets_; }
+
+    [[nodiscard]] OutboundStats stats() const noexcept;
+
+private:
+    struct Pending {
+        WireBuffer frame;  ///< Empty once dropped or replaced.
+        uint64_t stateKey = 0;
+    };
+
+    /// FIFO of one lane; entries before head are consumed.
+    struct Lane {
+        std::vector<Pending> frames;
+        std::size_t head = 0;
+        std::size_t bytes = 0;
+    };
+
+    [[nodiscard]] Lane& lane(SendLane l) noexcept { return lanes_[static_cast<std::size_t>(l)]; }
+
+    /// Drop the oldest State frames until @p incoming more bytes fit.
+    void dropStaleState(std::size_t incoming);
+
+    std::array<Lane, kSendLaneCount> lanes_;
+    std::unordered_map<uint64_t, std::size_t> stateSlots_;  ///< key -> State frame index.
+    std::size_t depth_ = 0;
+    std::size_t flushThreshold_;
+    LaneBudgets budgets_;
+    OutboundStats stats_;
+};
+
+}  // namespace cgs::foundation
@@ -0,0 +1,163 @@
+#pragma once
+
+/// @file payload_codec.hpp
+/// @brief LZ4 block compression for large NetworkMessage payloads.
+///
+/// compressLz4Block()/decompressLz4Block() implement the LZ4 block format
+/// (greedy single-probe matcher, 64 KiB window), optionally primed with a
+/// CompressionDictionary that both peers hold: matches may then reach
+/// back into the dictionary, which is what makes small, repetitive game
+/// messages compress at all.  CompressionDictionary::train() builds one
+/// from sample payloads of the live opcode mix.
+///
+/// PayloadCompressor is the policy GameNetworkManager applies per frame:
+/// payloads below a size threshold are sent as-is, and an opcode whose
+/// payloads stop compressing well is sent raw for a while before it is
+/// tried again.  Part of the Network System Adapter (SDS-MOD-004).
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace cgs::foundation {
+
+/// Shared history that primes compression of every payload.  Immutable.
+class CompressionDictionary {
+public:
+    /// Largest useful dictionary: the LZ4 match window.
+    static constexpr std::size_t kMaxSize = 64 * 1024 - 1;
+
+    /// Slots of the precomputed match table (4-byte hashes).
+    static constexpr std::size_t kHashLog = 12;
+
+    /// An empty dictionary (plain LZ4).
+    CompressionDictionary() = default;
+
+    /// Use @p bytes (truncated to their last kMaxSize bytes).
+    explicit CompressionDictionary(std::vector<uint8_t> bytes);
+
+    /// Build a dictionary of up to @p maxSize bytes from @p samples:
+    /// the segments whose 8-byte sequences recur in the most samples.
+    [[nodiscard]] static CompressionDictionary train(std::span<const std::vector<uint8_t>> samples,
+                                                     std::size_t maxSize = 4096);
+
+    [[nodiscard]] std::span<const uint8_t> bytes() const noexcept { return bytes_; }
+
+    [[nodiscard]] bool empty() const noexcept { return bytes_.empty(); }
+
+    /// FNV-1a hash of the bytes, for peers to confirm they share one.
+    [[nodiscard]] uint32_t id() const noexcept { return id_; }
+
+    /// Match table over bytes(): 1 + the last position of each hash, 0
+    /// for none.  Empty for an empty dictionary.
+    [[nodiscard]] std::span<const uint32_t> table() const noexcept { return table_; }
+
+private:
+    std::vector<uint8_t> bytes_;
+    std::vector<uint32_t> table_;
+    uint32_t id_ = 0;
+};
+
+/// Largest LZ4 block compressLz4Block() can produce for @p size bytes.
+[[nodiscard]] constexpr std::size_t lz4CompressBound(std::size_t size) noexcept {
+    return size + size / 255 + 16;
+}
+
+/// Append the LZ4 block encoding of @p input to @p out.
+void compressLz4Block(std::span<const uint8_t> input,
+                      std::vector<uint8_t>& out,
+                      const CompressionDictionary* dictionary = nullptr);
+
+/// Decode an LZ4 block that expands to exactly @p originalSize bytes,
+/// replacing the contents of @p out.
+/// @return false if the block is malformed or decodes to another size.
+[[nodiscard]] bool decompressLz4Block(std::span<const uint8_t> input,
+                                      std::size_t originalSize,
+                                      std::vector<uint8_t>& out,
+                                      std::span<const uint8_t> dictionary = {});
+
+/// When PayloadCompressor compresses a payload.
+struct CompressionConfig {
+    /// Payloads smaller than this are always sent raw.
+    std::size_t minPayloadSize = 256;
+
+    /// A result larger than this fraction of the payload is sent raw.
+    double maxRatio = 0.9;
+
+    /// Payloads of an opcode sent raw, without trying, after one missed
+    /// maxRatio.
+    uint32_t backoff = 32;
+
+    /// Compress for sessions as they connect; otherwise only once
+    /// enabled per session (after the peer agreed to it).
+    bool enabledByDefault = false;
+};
+
+/// Counters of one PayloadCompressor.
+struct CompressionStats {
+    uint64_t attempted = 0;     ///< Payloads run through the compressor.
+    uint64_t compressed = 0;    ///< Of those, sent compressed.
+    uint64_t skipped = 0;       ///< Sent raw: below the threshold or backing off.
+    uint64_t bytesIn = 0;       ///< Payload bytes of attempted payloads.
+    uint64_t bytesOut = 0;      ///< Bytes sent for them (compressed or raw).
+    uint64_t decompressed = 0;  ///< Payloads decoded.
+    uint64_t rejected = 0;      ///< Compressed payloads that failed to decode.
+    std::chrono::nanoseconds compressTime{0};
+    std::chrono::nanoseconds decompressTime{0};
+
+    /// bytesOut / bytesIn (1 before any attempt).
+    [[nodiscard]] double ratio() const noexcept {
+        return bytesIn == 0 ? 1.0 : static_cast<double>(bytesOut) / static_cast<double>(bytesIn);
+    }
+};
+
+/// Compression policy and codec shared by every session.  Thread-safe.
+///
+/// Compressed payload layout: [4 bytes: original size (network order)]
+/// [LZ4 block].
+class PayloadCompressor {
+public:
+    /// Largest payload decompress() expands to.
+    static constexpr std::size_t kMaxDecompressedSize = 16 * 1024 * 1024;
+
+    explicit PayloadCompressor(CompressionConfig config = {},
+                               CompressionDictionary dictionary = {});
+
+    /// Append @p payload's compressed form to @p out if it is worth it.
+    /// @return false (nothing appended) to send @p payload raw.
+    bool compress(uint16_t opcode, std::span<const uint8_t> payload, std::vector<uint8_t>& out);
+
+    /// Decode a compressed payload into @p out.
+    /// @return false if it is malformed.
+    [[nodiscard]] bool decompress(std::span<const uint8_t> payload, std::vector<uint8_t>& out);
+
+    [[nodiscard]] const CompressionConfig& config() const noexcept { return config_; }
+
+    [[nodiscard]] const CompressionDictionary& dictionary() const noexcept { return dictionary_; }
+
+    [[nodiscard]] CompressionStats stats() const noexcept;
+
+private:
+    static constexpr std::size_t kOpcodeCount = 65536;
+
+    CompressionConfig config_;
+    CompressionDictionary dictionary_;
+    /// Raw sends left before each opcode is tried again.
+    std::unique_ptr<std::atomic<uint32_t>[]> backoff_;
+
+    std::atomic<uint64_t> attempted_{0};
+    std::atomic<uint64_t> compressed_{0};
+    std::atomic<uint64_t> skipped_{0};
+    std::atomic<uint64_t> bytesIn_{0};
+    std::atomic<uint64_t> bytesOut_{0};
+    std::atomic<uint64_t> decompressed_{0};
+    std::atomic<uint64_t> rejected_{0};
+    std::atomic<int64_t> compressNs_{0};
+    std::atomic<int64_t> decompressNs_{0};
+};
+
+}  // namespace cgs::foundation
@@ -0,0 +1,390 @@
+#pragma once
+
+/// @file profiled_mutex.hpp
+/// @brief Drop-in std::mutex / std::shared_mutex replacements that sample
+///        lock wait and hold times per named lock site.
+///
+/// Each ProfiledMutex carries the name of its lock site ("gateway.session",
+/// "dbproxy.query_cache", ...); every instance with the same name, e.g.
+/// the shards of one map, feeds the same site.  While LockProfiler is
+/// disabled (the default) lock() is one relaxed load and a branch in
+/// front of the plain mutex.  Enabled, every acquisition first tries the
+/// lock: a failure counts as contention, and one acquisition in
+/// `sampleEvery` per thread has its wait and exclusive hold time timed
+/// into the site's fixed histograms.  Shared acquisitions record wait
+/// time only.
+///
+/// GameMetrics::scrape() publishes every site with data as
+/// `cgs_lock_<name>_wait_us` / `cgs_lock_<name>_hold_us` histograms and a
+/// `cgs_lock_<name>_contended_total` counter.
+///
+/// Example:
+/// @code
+///   struct Shard {
+///       ProfiledMutex mutex{"auth.rate_limiter"};
+///       ...
+///   };
+///   LockProfiler::Enable(64);  // at startup, e.g. from a config flag
+///   std::lock_guard lock(shard.mutex);
+/// @endcode
+///
+/// ProfiledMutex is not a std::mutex: pair it with
+/// std::condition_variable_any, not std::condition_variable.
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cgs::foundation {
+
+/// Index of a registered lock site; 0 is the unnamed site.
+using LockSiteId = uint16_t;
+
+/// Fixed microsecond histogram of one site (see LockProfiler::kBucketBoundsUs).
+struct LockHistogram {
+    static constexpr std::size_t kBuckets = 10;  ///< Nine bounds plus +Inf.
+
+    std::array<uint64_t, kBuckets> buckets{};  ///< Non-cumulative counts.
+    uint64_t count = 0;
+    uint64_t sumNs = 0;
+};
+
+/// Totals of one lock site (see LockProfiler::Snapshot()).
+struct LockSiteStats {
+    LockSiteId site = 0;
+    std::string name;
+    uint64_t contended = 0;  ///< Acquisitions that found the lock taken.
+    LockHistogram wait;      ///< Sampled acquisitions, shared ones included.
+    LockHistogram hold;      ///< Sampled exclusive holds.
+};
+
+namespace detail {
+
+struct LockHistogramCell {
+    std::array<std::atomic<uint64_t>, LockHistogram::kBuckets> buckets{};
+    std::atomic<uint64_t> sumNs{0};
+
+    void record(uint64_t ns, std::size_t bucket) noexcept {
+        buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+        sumNs.fetch_add(ns, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] LockHistogram load() const noexcept {
+        LockHistogram out;
+        for (std::size_t i = 0; i < out.buckets.size(); ++i) {
+            out.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+            out.count += out.buckets[i];
+        }
+        out.sumNs = sumNs.load(std::memory_order_relaxed);
+        return out;
+    }
+
+    void clear() noexcept {
+        for (auto& bucket : buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        sumNs.store(0, std::memory_order_relaxed);
+    }
+};
+
+struct alignas(64) LockSiteCell {
+    std::atomic<uint64_t> contended{0};
+    LockHistogramCell wait;
+    LockHistogramCell hold;
+};
+
+inline constexpr std::size_t kMaxLockSites = 256;
+
+inline std::array<LockSiteCell, kMaxLockSites> gLockSites{};
+inline std::atomic<uint32_t> gLockSiteCount{1};  // Site 0 is unnamed.
+inline std::atomic<uint32_t> gLockSampleEvery{0};  // 0: profiling off.
+
+inline thread_local uint32_t tLockSampleCountdown = 1;
+
+/// Site names, touched only by registration and reads.
+struct LockSiteNames {
+    std::mutex mutex;
+    std::vector<std::string> names{std::string("unnamed")};
+};
+
+inline LockSiteNames& lockSiteNames() {
+    static LockSiteNames names;
+    return names;
+}
+
+inline int64_t lockClockNs() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+}  // namespace detail
+
+/// Process-wide lock contention sampling; see file comment.
+class LockProfiler {
+public:
+    static constexpr LockSiteId kUnnamed = 0;
+    static constexpr std::size_t kMaxSites = detail::kMaxLockSites;
+
+    /// Upper bucket bounds in microseconds; the last bucket is +Inf.
+    static constexpr std::array<uint64_t, LockHistogram::kBuckets - 1> kBucketBoundsUs{
+        1, 4, 16, 64, 256, 1024, 4096, 16384, 65536};
+
+    /// Site for @p name, registering it on first use.  Registering the
+    /// same name again returns the same site.  Locks and may allocate, so
+    /// ProfiledMutex calls it on construction only.  Returns kUnnamed
+    /// once kMaxSites are in use.
+    [[nodiscard]] static LockSiteId Register(std::string_view name) {
+        auto& registry = detail::lockSiteNames();
+        std::lock_guard lock(registry.mutex);
+        for (std::size_t i = 1; i < registry.names.size(); ++i) {
+            if (registry.names[i] == name) {
+                return static_cast<LockSiteId>(i);
+            }
+        }
+        if (registry.names.size() >= kMaxSites) {
+            return kUnnamed;
+        }
+        registry.names.emplace_back(name);
+        detail::gLockSiteCount.store(static_cast<uint32_t>(registry.names.size()),
+                                     std::memory_order_release);
+        return static_cast<LockSiteId>(registry.names.size() - 1);
+    }
+
+    /// Name registered for @p site ("unnamed" for kUnnamed or unknown).
+    [[nodiscard]] static std::string Name(LockSiteId site) {
+        auto& registry = detail::lockSiteNames();
+        std::lock_guard lock(registry.mutex);
+        return site < registry.names.size() ? registry.names[site] : registry.names[0];
+    }
+
+    /// Number of sites in use, kUnnamed included.
+    [[nodiscard]] static std::size_t SiteCount() noexcept {
+        return detail::gLockSiteCount.load(std::memory_order_acquire);
+    }
+
+    /// Start counting contention and timing one acquisition in
+    /// @p sampleEvery per thread (at least 1).
+    static void Enable(uint32_t sampleEvery = 64) noexcept {
+        detail::gLockSampleEvery.store(sampleEvery == 0 ? 1 : sampleEvery,
+                                       std::memory_order_relaxed);
+    }
+
+    /// Stop sampling.  Collected totals are kept.
+    static void Disable() noexcept { detail::gLockSampleEvery.store(0, std::memory_order_relaxed); }
+
+    [[nodiscard]] static bool Enabled() noexcept {
+        return detail::gLockSampleEvery.load(std::memory_order_relaxed) != 0;
+    }
+
+    /// Totals of @p site.
+    [[nodiscard]] static LockSiteStats Stats(LockSiteId site) {
+        LockSiteStats out;
+        out.site = site;
+        out.name = Name(site);
+        if (site < kMaxSites) {
+            const auto& cell = detail::gLockSites[site];
+            out.contended = cell.contended.load(std::memory_order_relaxed);
+            out.wait = cell.wait.load();
+            out.hold = cell.hold.load();
+        }
+        return out;
+    }
+
+    /// Totals of every site in use, kUnnamed first.
+    [[nodiscard]] static std::vector<LockSiteStats> Snapshot() {
+        std::vector<LockSiteStats> out;
+        const std::size_t count = SiteCount();
+        out.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            out.push_back(Stats(static_cast<LockSiteId>(i)));
+        }
+        return out;
+    }
+
+    /// Zero every site's totals.  Intended for tests.
+    static void Reset() noexcept {
+        for (auto& cell : detail::gLockSites) {
+            cell.contended.store(0, std::memory_order_relaxed);
+            cell.wait.clear();
+            cell.hold.clear();
+        }
+    }
+
+    // ── Called by the profiled mutexes ──────────────────────────────────
+
+    /// True when the calling thread's next acquisition is to be timed.
+    [[nodiscard]] static bool SampleNext() noexcept {
+        if (--detail::tLockSampleCountdown != 0) {
+            return false;
+        }
+        const uint32_t every = detail::gLockSampleEvery.load(std::memory_order_relaxed);
+        detail::tLockSampleCountdown = every == 0 ? 1 : every;
+        return true;
+    }
+
+    static void RecordContended(LockSiteId site) noexcept {
+        detail::gLockSites[site].contended.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void RecordWait(LockSiteId site, int64_t ns) noexcept {
+        record(detail::gLockSites[site].wait, ns);
+    }
+
+    static void RecordHold(LockSiteId site, int64_t ns) noexcept {
+        record(detail::gLockSites[site].hold, ns);
+    }
+
+private:
+    static void record(detail::LockHistogramCell& cell, int64_t ns) noexcept {
+        const uint64_t value = ns > 0 ? static_cast<uint64_t>(ns) : 0;
+        const uint64_t us = value / 1000;
+        std::size_t bucket = 0;
+        while (bucket < kBucketBoundsUs.size() && us >= kBucketBoundsUs[bucket]) {
+            ++bucket;
+        }
+        cell.record(value, bucket);
+    }
+};
+
+/// std::mutex that samples its wait and hold times into a lock site.
+/// Meets Lockable, so std::lock_guard, std::unique_lock and
+/// std::scoped_lock work unchanged.
+class ProfiledMutex {
+public:
+    ProfiledMutex() noexcept = default;
+    explicit ProfiledMutex(std::string_view name) : site_(LockProfiler::Register(name)) {}
+    explicit ProfiledMutex(LockSiteId site) noexcept : site_(site) {}
+
+    ProfiledMutex(const ProfiledMutex&) = delete;
+    ProfiledMutex& operator=(const ProfiledMutex&) = delete;
+
+    void lock() {
+        if (!LockProfiler::Enabled()) [[likely]] {
+            mutex_.lock();
+            return;
+        }
+        lockProfiled();
+    }
+
+    [[nodiscard]] bool try_lock() { return mutex_.try_lock(); }
+
+    void unlock() {
+        if (holdStartNs_ == 0) [[likely]] {
+            mutex_.unlock();
+            return;
+        }
+        const int64_t held = detail::lockClockNs() - holdStartNs_;
+        holdStartNs_ = 0;
+        mutex_.unlock();
+        LockProfiler::RecordHold(site_, held);
+    }
+
+    [[nodiscard]] LockSiteId site() const noexcept { return site_; }
+
+private:
+    void lockProfiled() {
+        const bool sampled = LockProfiler::SampleNext();
+        const int64_t start = sampled ? detail::lockClockNs() : 0;
+        if (!mutex_.try_lock()) {
+            LockProfiler::RecordContended(site_);
+            mutex_.lock();
+        }
+        if (sampled) {
+            const int64_t acquired = detail::lockClockNs();
+            LockProfiler::RecordWait(site_, acquired - start);
+            holdStartNs_ = acquired;  // Owner-only; read back in unlock().
+        }
+    }
+
+    std::mutex mutex_;
+    LockSiteId site_ = LockProfiler::kUnnamed;
+    int64_t holdStartNs_ = 0;
+};
+
+/// std::shared_mutex counterpart of ProfiledMutex.  Exclusive
+/// acquisitions record wait and hold time; shared ones wait time only.
+class ProfiledSharedMutex {
+public:
+    ProfiledSharedMutex() noexcept = default;
+    explicit ProfiledSharedMutex(std::string_view name) : site_(LockProfiler::Register(name)) {}
+    explicit ProfiledSharedMutex(LockSiteId site) noexcept : site_(site) {}
+
+    ProfiledSharedMutex(const ProfiledSharedMutex&) = delete;
+    ProfiledSharedMutex& operator=(const ProfiledSharedMutex&) = delete;
+
+    void lock() {
+        if (!LockProfiler::Enabled()) [[likely]] {
+            mutex_.lock();
+            return;
+        }
+        lockProfiled();
+    }
+
+    [[nodiscard]] bool try_lock() { return mutex_.try_lock(); }
+
+    void unlock() {
+        if (holdStartNs_ == 0) [[likely]] {
+            mutex_.unlock();
+            return;
+        }
+        const int64_t held = detail::lockClockNs() - holdStartNs_;
+        holdStartNs_ = 0;
+        mutex_.unlock();
+        LockProfiler::RecordHold(site_, held);
+    }
+
+    void lock_shared() {
+        if (!LockProfiler::Enabled()) [[likely]] {
+            mutex_.lock_shared();
+            return;
+        }
+        lockSharedProfiled();
+    }
+
+    [[nodiscard]] bool try_lock_shared() { return mutex_.try_lock_shared(); }
+
+    void unlock_shared() { mutex_.unlock_shared(); }
+
+    [[nodiscard]] LockSiteId site() const noexcept { return site_; }
+
+private:
+    void lockProfiled() {
+        const bool sampled = LockProfiler::SampleNext();
+        const int64_t start = sampled ? detail::lockClockNs() : 0;
+        if (!mutex_.try_lock()) {
+            LockProfiler::RecordContended(site_);
+            mutex_.lock();
+        }
+        if (sampled) {
+            const int64_t acquired = detail::lockClockNs();
+            LockProfiler::RecordWait(site_, acquired - start);
+            holdStartNs_ = acquired;
+        }
+    }
+
+    void lockSharedProfiled() {
+        const bool sampled = LockProfiler::SampleNext();
+        const int64_t start = sampled ? detail::lockClockNs() : 0;
+        if (!mutex_.try_lock_shared()) {
+            LockProfiler::RecordContended(site_);
+            mutex_.lock_shared();
+        }
+        if (sampled) {
+            LockProfiler::RecordWait(site_, detail::lockClockNs() - start);
+        }
+    }
+
+    std::shared_mutex mutex_;
+    LockSiteId site_ = LockProfiler::kUnnamed;
+    int64_t holdStartNs_ = 0;
+};
+
+}  // namespace cgs::foundation
@@ -0,0 +1,282 @@
+#pragma once
+
+/// @file query_queue.hpp
+/// @brief Bounded asynchronous query queue with deadlines, cancellation
+///        and per-connection batching.
+///
+/// GameDatabase runs its asynchronous queries on one of these: a fixed
+/// set of workers (one per pooled connection) takes queued queries in
+/// order.  A worker takes up to `pipelineDepth` queries at once and hands
+/// them to the batch runner, which sends them back to back on a single
+/// checked-out connection instead of checking one out per query.
+///
+/// Each submit() returns a QueryHandle whose cancel() withdraws the query
+/// while it is still queued.  A query still queued past its deadline is
+/// failed with ConnectionPoolTimeout without being sent, and a full queue
+/// rejects new queries with ConnectionPoolExhausted, so overload turns
+/// into fast errors rather than unbounded memory and latency.
+
+#include "cgs/foundation/error_code.hpp"
+#include "cgs/foundation/game_error.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace cgs::foundation {
+
+/// Counters of an AsyncQueryQueue (totals since it started).
+struct AsyncQueryStats {
+    std::size_t queued = 0;       ///< Queries waiting for a worker now.
+    std::size_t peakQueued = 0;   ///< Highest queue depth seen.
+    uint64_t submitted = 0;       ///< Queries accepted into the queue.
+    uint64_t rejected = 0;        ///< Queries refused (queue full or shut down).
+    uint64_t expired = 0;         ///< Queries failed for waiting past their deadline.
+    uint64_t cancelled = 0;       ///< Queries withdrawn through QueryHandle::cancel().
+    uint64_t executed = 0;        ///< Queries handed to the batch runner.
+    uint64_t batches = 0;         ///< Runner calls (connection checkouts).
+    std::chrono::microseconds totalWait{0};  ///< Queue wait summed over taken queries.
+    std::chrono::microseconds maxWait{0};    ///< Longest queue wait of a taken query.
+};
+
+namespace detail {
+
+/// What a QueryHandle cancels through, whatever the queue's result type.
+class QueryCanceller {
+public:
+    virtual ~QueryCanceller() = default;
+    virtual bool cancel(uint64_t id) = 0;
+};
+
+}  // namespace detail
+
+/// Handle to one queued asynchronous query.
+///
+/// Copyable; a default-constructed handle (or the handle of a rejected
+/// query) refers to nothing.  The handle does not keep the queue alive.
+class QueryHandle {
+public:
+    QueryHandle() = default;
+    QueryHandle(std::weak_ptr<detail::QueryCanceller> queue, uint64_t id)
+        : queue_(std::move(queue)), id_(id) {}
+
+    /// Withdraw the query if no worker has taken it yet.  Its callback
+    /// then runs on this thread with ErrorCode::QueryCancelled.
+    ///
+    /// @return false if the query already started, finished, or was never
+    ///         queued (its callback runs, or ran, as usual).
+    bool cancel() {
+        auto queue = queue_.lock();
+        return queue && queue->cancel(id_);
+    }
+
+    /// Whether this handle refers to an accepted query.
+    [[nodiscard]] bool valid() const noexcept { return id_ != 0; }
+
+    [[nodiscard]] uint64_t id() const noexcept { return id_; }
+
+private:
+    std::weak_ptr<detail::QueryCanceller> queue_;
+    uint64_t id_ = 0;
+};
+
+/// Sizing of an AsyncQueryQueue.
+struct AsyncQueryOptions {
+    std::size_t workers = 1;        ///< Worker threads (one per connection).
+    std::size_t capacity = 4096;    ///< Queued queries before rejection (0 = unbounded).
+    std::size_t pipelineDepth = 8;  ///< Queries a worker takes per runner call.
+
+    /// Queue deadline of queries submitted without one (0 = none).
+    std::chrono::milliseconds defaultTimeout{0};
+};
+
+/// Bounded queue of SQL queries completed through `void(Result)`
+/// callbacks, where Result is a GameResult (see GameDatabase).
+template <typename Result>
+class AsyncQueryQueue {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Callback = std::function<void(Result)>;
+
+    /// One query taken by a worker.
+    struct Entry {
+        uint64_t id = 0;
+        std::string sql;
+        Callback onDone;
+        Clock::time_point enqueued;
+        Clock::time_point deadline;
+    };
+
+    /// Runs a batch of queries in order and completes each one's callback.
+    using BatchRunner = std::function<void(std::vector<Entry>& batch)>;
+
+    /// Start the workers.
+    AsyncQueryQueue(AsyncQueryOptions options, BatchRunner runner)
+        : core_(std::make_shared<Core>(options)), runner_(std::move(runner)) {
+        const std::size_t count = std::max<std::size_t>(1, options.workers);
+        workers_.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            workers_.emplace_back([this] { run(); });
+        }
+    }
+
+    ~AsyncQueryQueue() { shutdown(); }
+
+    AsyncQueryQueue(const AsyncQueryQueue&) = delete;
+    AsyncQueryQueue& operator=(const AsyncQueryQueue&) = delete;
+
+    /// Queue @p sql, to be taken within @p timeout (0 = the default
+    /// timeout).  If the queue is full (ConnectionPoolExhausted) or shut
+    /// down (NotConnected), @p onDone runs inline with that error and the
+    /// returned handle is invalid.
+    QueryHandle submit(std::string sql, Callback onDone,
+                       std::chrono::milliseconds timeout = std::chrono::milliseconds{0}) {
+        const auto now = Clock::now();
+        if (timeout.count() <= 0) {
+            timeout = core_->options.defaultTimeout;
+        }
+        uint64_t id = 0;
+        bool stopping = false;
+        {
+            std::lock_guard lock(core_->mutex);
+            const auto capacity = core_->options.capacity;
+            stopping = core_->stopping;
+            if (!stopping && (capacity == 0 || core_->queue.size() < capacity)) {
+                id = ++core_->nextId;
+                core_->queue.push_back(Entry{
+                    id, std::move(sql), std::move(onDone), now,
+                    timeout.count() > 0 ? now + timeout : Clock::time_point::max()});
+                ++core_->stats.submitted;
+                core_->stats.peakQueued = std::max(core_->stats.peakQueued, core_->queue.size());
+            } else {
+                ++core_->stats.rejected;
+            }
+        }
+        if (id == 0) {
+            onDone(Result::err(stopping ? GameError(ErrorCode::NotConnected,
+                                                    "async query queue is shut down")
+                                        : GameError(ErrorCode::ConnectionPoolExhausted,
+                                                    "async query queue is full")));
+            return {};
+        }
+        core_->cv.notify_one();
+        return QueryHandle(std::weak_ptr<detail::QueryCanceller>(core_), id);
+    }
+
+    /// Refuse new queries, run the ones still queued, then join the
+    /// workers.  Idempotent; must not be called from a query callback.
+    void shutdown() {
+        {
+            std::lock_guard lock(core_->mutex);
+            core_->stopping = true;
+        }
+        core_->cv.notify_all();
+        std::lock_guard lock(joinMutex_);
+        for (auto& worker : workers_) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+    }
+
+    [[nodiscard]] AsyncQueryStats stats() const {
+        std::lock_guard lock(core_->mutex);
+        auto stats = core_->stats;
+        stats.queued = core_->queue.size();
+        return stats;
+    }
+
+    [[nodiscard]] std::size_t workerCount() const noexcept { return workers_.size(); }
+
+private:
+    struct Core final : detail::QueryCanceller {
+        explicit Core(AsyncQueryOptions opts) : options(opts) {
+            options.pipelineDepth = std::max<std::size_t>(1, options.pipelineDepth);
+        }
+
+        bool cancel(uint64_t id) override {
+            Entry entry;
+            {
+                std::lock_guard lock(mutex);
+                auto it = std::find_if(queue.begin(), queue.end(),
+                                       [id](const Entry& e) { return e.id == id; });
+                if (it == queue.end()) {
+                    return false;
+                }
+                entry = std::move(*it);
+                queue.erase(it);
+                ++stats.cancelled;
+            }
+            entry.onDone(Result::err(GameError(ErrorCode::QueryCancelled, "query cancelled")));
+            return true;
+        }
+
+        AsyncQueryOptions options;
+        mutable std::mutex mutex;
+        std::condition_variable cv;
+        std::deque<Entry> queue;
+        AsyncQueryStats stats;
+        uint64_t nextId = 0;
+        bool stopping = false;
+    };
+
+    void run() {
+        std::vector<Entry> batch;
+        std::vector<Entry> expired;
+        for (;;) {
+            {
+                std::unique_lock lock(core_->mutex);
+                core_->cv.wait(lock, [this] { return core_->stopping || !core_->queue.empty(); });
+                if (core_->queue.empty()) {
+                    return;  // Stopping and drained
+                }
+                const auto now = Clock::now();
+                auto& stats = core_->stats;
+                while (!core_->queue.empty() && batch.size() < core_->options.pipelineDepth) {
+                    Entry entry = std::move(core_->queue.front());
+                    core_->queue.pop_front();
+                    const auto wait =
+                        std::chrono::duration_cast<std::chrono::microseconds>(now - entry.enqueued);
+                    stats.totalWait += wait;
+                    stats.maxWait = std::max(stats.maxWait, wait);
+                    if (now > entry.deadline) {
+                        ++stats.expired;
+                        expired.push_back(std::move(entry));
+                    } else {
+                        batch.push_back(std::move(entry));
+                    }
+                }
+                if (!batch.empty()) {
+                    stats.executed += batch.size();
+                    ++stats.batches;
+                }
+            }
+            for (auto& entry : expired) {
+                entry.onDone(Result::err(GameError(ErrorCode::ConnectionPoolTimeout,
+                                                   "query waited past its deadline")));
+            }
+            expired.clear();
+            if (!batch.empty()) {
+                runner_(batch);
+                batch.clear();
+            }
+        }
+    }
+
+    std::shared_ptr<Core> core_;
+    BatchRunner runner_;
+    std::mutex joinMutex_;
+    std::vector<std::thread> workers_;  // Last: started after the members above exist
+};
+
+}  // namespace cgs::foundation
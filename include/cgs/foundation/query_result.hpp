@@ -0,0 +1,469 @@
+#pragma once
+
+/// @file query_result.hpp
+/// @brief Columnar query result set with a shared schema and a string arena.
+///
+/// A QueryResult stores one vector of cells per column and the column
+/// names once per result, instead of a hash map with its own copy of every
+/// column name per row.  String cells point into one character arena, so
+/// loading N rows costs a handful of vector growths rather than several
+/// allocations per cell.  Copies share storage until one of them is
+/// modified, which makes QueryCache hits O(1).
+///
+/// Rows are read through RowView, which offers the by-name access of the
+/// old row maps (at(), operator[], contains()) plus typed getters that do
+/// not copy strings.
+///
+/// Example:
+/// @code
+///   for (auto row : result) {
+///       auto id = row.getInt("id");            // std::optional<int64_t>
+///       auto name = row.getString("name");     // std::optional<string_view>
+///   }
+/// @endcode
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+namespace cgs::foundation {
+
+// ── Type aliases for database values ────────────────────────────────────────
+
+/// Sentinel type representing SQL NULL.
+struct DbNull {};
+
+/// A single column value in a query result row.
+using DbValue = std::variant<DbNull, std::string, std::int64_t, double, bool>;
+
+/// A single row: column name → value (the materialized form of a RowView).
+using DbRow = std::unordered_map<std::string, DbValue>;
+
+class QueryResult;
+
+/// Read-only view of one row of a QueryResult.
+///
+/// Valid while the result it came from is alive and unmodified.
+class RowView {
+public:
+    RowView(const QueryResult& result, std::size_t row) noexcept : result_(&result), row_(row) {}
+
+    /// Index of this row in its result.
+    [[nodiscard]] std::size_t index() const noexcept { return row_; }
+
+    /// Number of columns.
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    [[nodiscard]] bool contains(std::string_view column) const noexcept;
+
+    /// Value of @p column.  @throws std::out_of_range if there is no such
+    /// column (like DbRow::at()).
+    [[nodiscard]] DbValue at(std::string_view column) const;
+
+    /// Value of @p column, or DbNull if there is no such column.
+    [[nodiscard]] DbValue operator[](std::string_view column) const;
+
+    /// Whether @p column is NULL or missing.
+    [[nodiscard]] bool isNull(std::string_view column) const noexcept;
+
+    // Typed getters: nullopt if the column is missing, NULL or of another type.
+    [[nodiscard]] std::optional<std::int64_t> getInt(std::string_view column) const noexcept;
+    [[nodiscard]] std::optional<double> getDouble(std::string_view column) const noexcept;
+    [[nodiscard]] std::optional<bool> getBool(std::string_view column) const noexcept;
+
+    /// The string, viewing the result's arena (no copy).
+    [[nodiscard]] std::optional<std::string_view> getString(std::string_view column) const noexcept;
+
+    /// Copy this row into a column-name map.
+    [[nodiscard]] DbRow toRow() const;
+
+private:
+    const QueryResult* result_;
+    std::size_t row_;
+};
+
+/// Complete result set from a SELECT query, stored by column.
+class QueryResult {
+public:
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    QueryResult() = default;
+
+    /// Empty result with the given columns.
+    explicit QueryResult(std::vector<std::string> columns) {
+        auto& data = mutableData();
+        data.columns.resize(columns.size());
+        data.names = std::move(columns);
+    }
+
+    // ── Shape ───────────────────────────────────────────────────────────
+
+    /// Number of rows.
+    [[nodiscard]] std::size_t size() const noexcept { return data_ ? data_->rows : 0; }
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    /// Heap bytes held by the storage (shared with copies): cells, string
+    /// arena and column names, counted at their reserved capacity.
+    [[nodiscard]] std::size_t memoryBytes() const noexcept {
+        if (!data_) {
+            return 0;
+        }
+        std::size_t bytes = sizeof(Data) + data_->arena.capacity() +
+                            data_->names.capacity() * sizeof(std::string) +
+                            data_->columns.capacity() * sizeof(std::vector<Cell>);
+        for (const auto& name : data_->names) {
+            bytes += name.size();
+        }
+        for (const auto& column : data_->columns) {
+            bytes += column.capacity() * sizeof(Cell);
+        }
+        return bytes;
+    }
+
+    [[nodiscard]] std::size_t columnCount() const noexcept {
+        return data_ ? data_->names.size() : 0;
+    }
+
+    [[nodiscard]] const std::vector<std::string>& columnNames() const noexcept {
+        static const std::vector<std::string> kNone;
+        return data_ ? data_->names : kNone;
+    }
+
+    /// Index of @p name, or npos.
+    [[nodiscard]] std::size_t columnIndex(std::string_view name) const noexcept {
+        if (!data_) {
+            return npos;
+        }
+        for (std::size_t i = 0; i < data_->names.size(); ++i) {
+            if (data_->names[i] == name) {
+                return i;
+            }
+        }
+        return npos;
+    }
+
+    // ── Rows ────────────────────────────────────────────────────────────
+
+    [[nodiscard]] RowView operator[](std::size_t row) const noexcept { return RowView(*this, row); }
+
+    [[nodiscard]] RowView front() const noexcept { return RowView(*this, 0); }
+
+    /// Random-access iterator over RowViews.
+    class const_iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = RowView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = RowView;
+
+        const_iterator() = default;
+        const_iterator(const QueryResult* result, std::size_t row) : result_(result), row_(row) {}
+
+        RowView operator*() const noexcept { return RowView(*result_, row_); }
+        RowView operator[](difference_type n) const noexcept {
+            return RowView(*result_, row_ + static_cast<std::size_t>(n));
+        }
+
+        const_iterator& operator++() noexcept {
+            ++row_;
+            return *this;
+        }
+        const_iterator operator++(int) noexcept {
+            auto copy = *this;
+            ++row_;
+            return copy;
+        }
+        const_iterator& operator--() noexcept {
+            --row_;
+            return *this;
+        }
+        const_iterator operator--(int) noexcept {
+            auto copy = *this;
+            --row_;
+            return copy;
+        }
+        const_iterator& operator+=(difference_type n) noexcept {
+            row_ = static_cast<std::size_t>(static_cast<difference_type>(row_) + n);
+            return *this;
+        }
+        const_iterator& operator-=(difference_type n) noexcept { return *this += -n; }
+        friend const_iterator operator+(const_iterator it, difference_type n) { return it += n; }
+        friend const_iterator operator+(difference_type n, const_iterator it) { return it += n; }
+        friend const_iterator operator-(const_iterator it, difference_type n) { return it -= n; }
+        friend difference_type operator-(const const_iterator& a, const const_iterator& b) {
+            return static_cast<difference_type>(a.row_) - static_cast<difference_type>(b.row_);
+        }
+        friend bool operator==(const const_iterator& a, const const_iterator& b) {
+            return a.row_ == b.row_;
+        }
+        friend auto operator<=>(const const_iterator& a, const const_iterator& b) {
+            return a.row_ <=> b.row_;
+        }
+
+    private:
+        const QueryResult* result_ = nullptr;
+        std::size_t row_ = 0;
+    };
+
+    [[nodiscard]] const_iterator begin() const noexcept { return {this, 0}; }
+    [[nodiscard]] const_iterator end() const noexcept { return {this, size()}; }
+
+    // ── Cells ───────────────────────────────────────────────────────────
+
+    /// Value at (@p row, @p column) as a DbValue (strings are copied).
+    [[nodiscard]] DbValue value(std::size_t row, std::size_t column) const {
+        const Cell& c = cell(row, column);
+        switch (c.kind) {
+            case Kind::String:
+                return std::string(text(c));
+            case Kind::Int:
+                return c.i;
+            case Kind::Double:
+                return c.d;
+            case Kind::Bool:
+                return c.b;
+            case Kind::Null:
+                break;
+        }
+        return DbNull{};
+    }
+
+    [[nodiscard]] bool isNull(std::size_t row, std::size_t column) const noexcept {
+        return cell(row, column).kind == Kind::Null;
+    }
+
+    [[nodiscard]] std::optional<std::int64_t> getInt(std::size_t row,
+                                                     std::size_t column) const noexcept {
+        const Cell& c = cell(row, column);
+        return c.kind == Kind::Int ? std::optional(c.i) : std::nullopt;
+    }
+
+    [[nodiscard]] std::optional<double> getDouble(std::size_t row,
+                                                  std::size_t column) const noexcept {
+        const Cell& c = cell(row, column);
+        return c.kind == Kind::Double ? std::optional(c.d) : std::nullopt;
+    }
+
+    [[nodiscard]] std::optional<bool> getBool(std::size_t row, std::size_t column) const noexcept {
+        const Cell& c = cell(row, column);
+        return c.kind == Kind::Bool ? std::optional(c.b) : std::nullopt;
+    }
+
+    [[nodiscard]] std::optional<std::string_view> getString(std::size_t row,
+                                                            std::size_t column) const noexcept {
+        const Cell& c = cell(row, column);
+        return c.kind == Kind::String ? std::optional(text(c)) : std::nullopt;
+    }
+
+    // ── Building ────────────────────────────────────────────────────────
+
+    /// Reserve room for @p rows rows in every column.
+    void reserve(std::size_t rows) {
+        auto& data = mutableData();
+        data.reservedRows = rows;
+        for (auto& column : data.columns) {
+            column.reserve(rows);
+        }
+    }
+
+    /// Add a column (NULL in existing rows).  @return its index.
+    std::size_t addColumn(std::string name) {
+        auto& data = mutableData();
+        data.names.push_back(std::move(name));
+        auto& column = data.columns.emplace_back();
+        column.reserve(std::max(data.rows, data.reservedRows));
+        column.resize(data.rows);
+        return data.columns.size() - 1;
+    }
+
+    /// Index of @p name, adding the column if missing.
+    std::size_t columnFor(std::string_view name) {
+        const auto index = columnIndex(name);
+        return index != npos ? index : addColumn(std::string(name));
+    }
+
+    /// Append a row of NULLs.  @return its index.
+    std::size_t addRow() {
+        auto& data = mutableData();
+        for (auto& column : data.columns) {
+            column.emplace_back();
+        }
+        return data.rows++;
+    }
+
+    void set(std::size_t row, std::size_t column, DbNull) { mutableCell(row, column) = Cell{}; }
+
+    void set(std::size_t row, std::size_t column, std::int64_t value) {
+        Cell& c = mutableCell(row, column);
+        c.kind = Kind::Int;
+        c.i = value;
+    }
+
+    void set(std::size_t row, std::size_t column, double value) {
+        Cell& c = mutableCell(row, column);
+        c.kind = Kind::Double;
+        c.d = value;
+    }
+
+    void set(std::size_t row, std::size_t column, bool value) {
+        Cell& c = mutableCell(row, column);
+        c.kind = Kind::Bool;
+        c.b = value;
+    }
+
+    /// Copy @p value into the arena.  @throws std::length_error past 4 GiB
+    /// of string data in one result.
+    void set(std::size_t row, std::size_t column, std::string_view value) {
+        auto& data = mutableData();
+        if (data.arena.size() + value.size() > std::numeric_limits<uint32_t>::max()) {
+            throw std::length_error("QueryResult string arena exceeds 4 GiB");
+        }
+        Cell& c = data.columns[column][row];
+        c.kind = Kind::String;
+        c.s = {static_cast<uint32_t>(data.arena.size()), static_cast<uint32_t>(value.size())};
+        data.arena.append(value);
+    }
+
+    void set(std::size_t row, std::size_t column, const std::string& value) {
+        set(row, column, std::string_view(value));
+    }
+
+    void set(std::size_t row, std::size_t column, const char* value) {
+        set(row, column, std::string_view(value));
+    }
+
+    void set(std::size_t row, std::size_t column, const DbValue& value) {
+        std::visit([&](const auto& v) { set(row, column, v); }, value);
+    }
+
+    /// Append a row given as a column-name map; unknown columns are added.
+    void push_back(const DbRow& row) {
+        const std::size_t r = addRow();
+        for (const auto& [name, value] : row) {
+            set(r, columnFor(name), value);
+        }
+    }
+
+private:
+    friend class RowView;
+
+    enum class Kind : uint8_t { Null, String, Int, Double, Bool };
+
+    struct Cell {
+        Kind kind = Kind::Null;
+        union {
+            std::int64_t i = 0;
+            double d;
+            bool b;
+            struct {
+                uint32_t offset;
+                uint32_t length;
+            } s;
+        };
+    };
+
+    struct Data {
+        std::vector<std::string> names;          // Shared by every row
+        std::vector<std::vector<Cell>> columns;  // columns[c][row]
+        std::string arena;                       // Bytes of every string cell
+        std::size_t rows = 0;
+        std::size_t reservedRows = 0;
+    };
+
+    [[nodiscard]] const Cell& cell(std::size_t row, std::size_t column) const noexcept {
+        return data_->columns[column][row];
+    }
+
+    [[nodiscard]] std::string_view text(const Cell& c) const noexcept {
+        return std::string_view(data_->arena).substr(c.s.offset, c.s.length);
+    }
+
+    Cell& mutableCell(std::size_t row, std::size_t column) {
+        return mutableData().columns[column][row];
+    }
+
+    /// Storage of this result, copied first if other results share it.
+    Data& mutableData() {
+        if (!data_) {
+            data_ = std::make_shared<Data>();
+        } else if (data_.use_count() > 1) {
+            data_ = std::make_shared<Data>(*data_);
+        }
+        return *data_;
+    }
+
+    std::shared_ptr<Data> data_;
+};
+
+// ── RowView ─────────────────────────────────────────────────────────────────
+
+inline std::size_t RowView::size() const noexcept {
+    return result_->columnCount();
+}
+
+inline bool RowView::contains(std::string_view column) const noexcept {
+    return result_->columnIndex(column) != QueryResult::npos;
+}
+
+inline DbValue RowView::at(std::string_view column) const {
+    const auto index = result_->columnIndex(column);
+    if (index == QueryResult::npos) {
+        throw std::out_of_range("no column " + std::string(column));
+    }
+    return result_->value(row_, index);
+}
+
+inline DbValue RowView::operator[](std::string_view column) const {
+    const auto index = result_->columnIndex(column);
+    return index == QueryResult::npos ? DbValue{DbNull{}} : result_->value(row_, index);
+}
+
+inline bool RowView::isNull(std::string_view column) const noexcept {
+    const auto index = result_->columnIndex(column);
+    return index == QueryResult::npos || result_->isNull(row_, index);
+}
+
+inline std::optional<std::int64_t> RowView::getInt(std::string_view column) const noexcept {
+    const auto index = result_->columnIndex(column);
+    return index == QueryResult::npos ? std::nullopt : result_->getInt(row_, index);
+}
+
+inline std::optional<double> RowView::getDouble(std::string_view column) const noexcept {
+    const auto index = result_->columnIndex(column);
+    return index == QueryResult::npos ? std::nullopt : result_->getDouble(row_, index);
+}
+
+inline std::optional<bool> RowView::getBool(std::string_view column) const noexcept {
+    const auto index = result_->columnIndex(column);
+    return index == QueryResult::npos ? std::nullopt : result_->getBool(row_, index);
+}
+
+inline std::optional<std::string_view> RowView::getString(std::string_view column) const noexcept {
+    const auto index = result_->columnIndex(column);
+    return index == QueryResult::npos ? std::nullopt : result_->getString(row_, index);
+}
+
+inline DbRow RowView::toRow() const {
+    DbRow row;
+    const auto& names = result_->columnNames();
+    row.reserve(names.size());
+    for (std::size_t c = 0; c < names.size(); ++c) {
+        row.emplace(names[c], result_->value(row_, c));
+    }
+    return row;
+}
+
+}  // namespace cgs::foundation
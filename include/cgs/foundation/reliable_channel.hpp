@@ -0,0 +1,175 @@
+#pragma once
+
+/// @file reliable_channel.hpp
+/// @brief Lightweight reliability layer for the UDP protocol path.
+///
+/// ReliableEndpoint turns one side of a UDP association into three
+/// delivery channels: unreliable-sequenced for movement, reliable-ordered
+/// for inventory and quests, and reliable-unordered for everything that
+/// must arrive but may overtake.  Every datagram carries a packet sequence
+/// number and a selective ack (the newest received sequence plus a 32-bit
+/// history), so one lost datagram never stalls acknowledgement of the
+/// ones around it.  Acked packets feed an RFC 6298 RTT estimator whose
+/// retransmission timeout drives resends of unacknowledged reliable data;
+/// resends always go out under a new packet sequence, so every RTT sample
+/// is unambiguous.  Messages larger than one datagram are fragmented and
+/// reassembled.  Part of the Network System Adapter (SDS-MOD-004).
+///
+/// The endpoint owns no socket and reads no clock: callers feed it
+/// received datagrams and the current time and send what poll() returns.
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <span>
+#include <vector>
+
+namespace cgs::foundation {
+
+/// Delivery guarantee of one message sent through a ReliableEndpoint.
+enum class DeliveryChannel : uint8_t {
+    UnreliableSequenced,  ///< May be lost; older than the newest delivered is dropped.
+    ReliableOrdered,      ///< Retransmitted until acked; delivered in send order.
+    ReliableUnordered,    ///< Retransmitted until acked; delivered once, on arrival.
+};
+
+inline constexpr std::size_t kDeliveryChannelCount = 3;
+
+/// Counters and RTT estimate of one ReliableEndpoint.
+struct ReliabilityStats {
+    std::chrono::microseconds rtt{0};  ///< Smoothed round-trip time (0 before a sample).
+    std::chrono::microseconds rto{0};  ///< Current retransmission timeout.
+    uint64_t packetsSent = 0;
+    uint64_t packetsReceived = 0;
+    uint64_t packetsAcked = 0;
+    uint64_t retransmits = 0;         ///< Reliable fragments sent again after a timeout.
+    uint64_t messagesDelivered = 0;
+    uint64_t dropped = 0;             ///< Malformed, stale or duplicate data discarded.
+    std::size_t unackedFragments = 0; ///< Reliable fragments awaiting an ack.
+};
+
+/// One side of a reliable UDP association.  Not thread-safe.
+class ReliableEndpoint {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Largest datagram poll() produces; fits the common 1280-byte IPv6 MTU.
+    static constexpr std::size_t kMaxPacketSize = 1200;
+    /// [2 sequence][1 flags][2 ack][4 ack bits]
+    static constexpr std::size_t kPacketHeaderSize = 9;
+    /// [1 channel][4 message id][2 fragment index][2 fragment count][2 length]
+    static constexpr std::size_t kChunkHeaderSize = 11;
+    /// Payload bytes carried by one fragment.
+    static constexpr std::size_t kFragmentSize =
+        kMaxPacketSize - kPacketHeaderSize - kChunkHeaderSize;
+    /// Largest message send() accepts.
+    static constexpr std::size_t kMaxMessageSize = 256 * 1024;
+
+    static constexpr std::chrono::milliseconds kInitialRto{200};
+    static constexpr std::chrono::milliseconds kMinRto{50};
+    static constexpr std::chrono::milliseconds kMaxRto{2000};
+
+    /// Queue @p message on @p channel for the next poll().
+    /// @return false if the message exceeds kMaxMessageSize.
+    bool send(DeliveryChannel channel, std::span<const uint8_t> message);
+
+    /// Build the datagrams due at @p now -- new data, timed-out reliable
+    /// fragments and, if owed, a bare ack -- and append them to @p packets.
+    void poll(Clock::time_point now, std::vector<std::vector<uint8_t>>& packets);
+
+    /// Process one received datagram, appending the messages it completes
+    /// to @p messages in delivery order.
+    /// @return false if the datagram was malformed (it is ignored).
+    bool receive(std::span<const uint8_t> packet,
+                 Clock::time_point now,
+                 std::vector<std::vector<uint8_t>>& messages);
+
+    /// True while reliable data awaits an ack or anything awaits poll().
+    [[nodiscard]] bool busy() const noexcept {
+        return !unacked_.empty() || !unreliable_.empty() || ackPending_;
+    }
+
+    [[nodiscard]] ReliabilityStats stats() const noexcept;
+
+private:
+    /// One fragment of a queued message.
+    struct Fragment {
+        DeliveryChannel channel{};
+        uint32_t messageId = 0;
+        uint16_t index = 0;
+        uint16_t count = 1;
+        std::vector<uint8_t> bytes;
+        Clock::time_point lastSent{};  ///< Epoch until first sent.
+        uint32_t sends = 0;
+    };
+
+    /// Ring entry recording which reliable fragments a packet carried.
+    struct SentPacket {
+        uint16_t sequence = 0;
+        bool live = false;
+        Clock::time_point sentAt{};
+        std::vector<uint64_t> fragments;  ///< Keys into unacked_.
+    };
+
+    /// A message whose fragments are still arriving.
+    struct Reassembly {
+        std::vector<std::vector<uint8_t>> parts;
+        std::size_t received = 0;
+    };
+
+    /// Receive state of one channel.
+    struct Inbound {
+        uint32_t next = 0;  ///< Ordered: next id to deliver.  Others: ids below are done.
+        std::set<uint32_t> done;                     ///< Unordered: delivered ids >= next.
+        std::map<uint32_t, Reassembly> partial;      ///< By message id.
+        std::map<uint32_t, std::vector<uint8_t>> ready;  ///< Ordered: complete, blocked.
+        bool any = false;  ///< Unreliable: something was delivered.
+    };
+
+    static constexpr std::size_t kSentRing = 1024;
+    /// Reliable messages in flight per channel.  The sender holds back
+    /// messages beyond it and the receiver refuses them.
+    static constexpr uint32_t kReceiveWindow = 4096;
+    /// Fragmented messages reassembled at once per channel.
+    static constexpr std::size_t kMaxPartial = 256;
+
+    void enqueue(DeliveryChannel channel, uint32_t id, std::span<const uint8_t> message);
+    void processAck(uint16_t ack, uint32_t ackBits, Clock::time_point now);
+    void onAcked(SentPacket& sent, Clock::time_point now);
+    void markReceived(uint16_t sequence);
+    /// False if the chunk was refused for lack of room; the packet then
+    /// goes unacked so the sender retransmits it.
+    bool receiveChunk(DeliveryChannel channel,
+                      uint32_t id,
+                      uint16_t index,
+                      uint16_t count,
+                      std::span<const uint8_t> data,
+                      std::vector<std::vector<uint8_t>>& messages);
+    void deliver(std::vector<uint8_t> message, std::vector<std::vector<uint8_t>>& messages);
+    [[nodiscard]] Clock::duration rto() const noexcept;
+
+    std::array<uint32_t, kDeliveryChannelCount> nextMessageId_{};
+    std::array<Inbound, kDeliveryChannelCount> inbound_;
+
+    std::vector<Fragment> unreliable_;      ///< Sent once by the next poll().
+    std::map<uint64_t, Fragment> unacked_;  ///< Reliable, by queue order.
+    uint64_t nextFragmentKey_ = 0;
+    std::array<SentPacket, kSentRing> sent_;
+    uint16_t nextSequence_ = 0;
+
+    uint16_t remoteSequence_ = 0;  ///< Newest packet received.
+    uint32_t receivedBits_ = 0;    ///< Bit i: remoteSequence_ - 1 - i received.
+    bool receivedAny_ = false;
+    bool ackPending_ = false;
+
+    Clock::duration srtt_{0};
+    Clock::duration rttvar_{0};
+    bool rttSampled_ = false;
+
+    ReliabilityStats stats_;
+};
+
+}  // namespace cgs::foundation
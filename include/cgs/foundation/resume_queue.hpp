@@ -0,0 +1,130 @@
+#pragma once
+
+/// @file resume_queue.hpp
+/// @brief Coroutines parked until the owning thread drains them.
+///
+/// A ResumeQueue belongs to one thread, typically the game thread, which
+/// calls drain() once per tick.  Coroutines on any thread hop onto it with
+/// `co_await queue.nextTick()` and resume inside the next drain(); timers
+/// (`co_await queue.sleepFor(500ms)`) resume in the first drain() at or
+/// after their deadline, so their resolution is one tick.  Both are
+/// thread-safe to await; drain() must only be called by the owner.
+///
+/// @see task.hpp
+
+#include <algorithm>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace cgs::foundation {
+
+class ResumeQueue {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    ResumeQueue() = default;
+
+    ResumeQueue(const ResumeQueue&) = delete;
+    ResumeQueue& operator=(const ResumeQueue&) = delete;
+
+    /// Awaitable: resume in the next drain().
+    [[nodiscard]] auto nextTick() noexcept {
+        struct Awaiter {
+            ResumeQueue* queue;
+
+            bool await_ready() const noexcept { return false; }
+
+            void await_suspend(std::coroutine_handle<> handle) { queue->post(handle); }
+
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{this};
+    }
+
+    /// Awaitable: resume in the first drain() at or after @p deadline.
+    [[nodiscard]] auto sleepUntil(Clock::time_point deadline) noexcept {
+        struct Awaiter {
+            ResumeQueue* queue;
+            Clock::time_point deadline;
+
+            bool await_ready() const noexcept { return false; }
+
+            void await_suspend(std::coroutine_handle<> handle) {
+                queue->postAt(deadline, handle);
+            }
+
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{this, deadline};
+    }
+
+    /// Awaitable: resume in the first drain() @p delay from now.
+    template <typename Rep, typename Period>
+    [[nodiscard]] auto sleepFor(std::chrono::duration<Rep, Period> delay) noexcept {
+        return sleepUntil(Clock::now() + std::chrono::duration_cast<Clock::duration>(delay));
+    }
+
+    /// Queue @p handle for the next drain().
+    void post(std::coroutine_handle<> handle) {
+        std::lock_guard lock(mutex_);
+        ready_.push_back(handle);
+    }
+
+    /// Queue @p handle for the first drain() at or after @p deadline.
+    void postAt(Clock::time_point deadline, std::coroutine_handle<> handle) {
+        std::lock_guard lock(mutex_);
+        timers_.push_back(Timer{deadline, nextSequence_++, handle});
+        std::push_heap(timers_.begin(), timers_.end(), Timer::later);
+    }
+
+    /// Resume every coroutine posted before this call and every timer due
+    /// at @p now (in deadline order).  Coroutines that re-enter the queue
+    /// while resuming wait for the next drain().
+    /// @return The number of coroutines resumed.
+    std::size_t drain(Clock::time_point now = Clock::now()) {
+        {
+            std::lock_guard lock(mutex_);
+            draining_.swap(ready_);
+            while (!timers_.empty() && timers_.front().deadline <= now) {
+                std::pop_heap(timers_.begin(), timers_.end(), Timer::later);
+                draining_.push_back(timers_.back().handle);
+                timers_.pop_back();
+            }
+        }
+        const std::size_t resumed = draining_.size();
+        for (auto handle : draining_) {
+            handle.resume();
+        }
+        draining_.clear();  // Keeps its capacity for the next tick
+        return resumed;
+    }
+
+    /// Coroutines waiting (posted or sleeping).
+    [[nodiscard]] std::size_t pending() const {
+        std::lock_guard lock(mutex_);
+        return ready_.size() + timers_.size();
+    }
+
+private:
+    struct Timer {
+        Clock::time_point deadline;
+        uint64_t sequence;  // FIFO among equal deadlines
+        std::coroutine_handle<> handle;
+
+        static bool later(const Timer& a, const Timer& b) noexcept {
+            return a.deadline != b.deadline ? a.deadline > b.deadline : a.sequence > b.sequence;
+        }
+    };
+
+    mutable std::mutex mutex_;
+    std::vector<std::coroutine_handle<>> ready_;
+    std::vector<Timer> timers_;  // Min-heap on (deadline, sequence)
+    uint64_t nextSequence_ = 0;
+    std::vector<std::coroutine_handle<>> draining_;  // Owner only
+};
+
+}  // namespace cgs::foundation
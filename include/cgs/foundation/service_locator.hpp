@@ -2,19 +2,83 @@
 
 /// @file service_locator.hpp
 /// @brief Type-safe dependency injection container.
+///
+/// Each service type gets a dense integer id on first use (like
+/// cgs::ecs::ComponentType), and services sit in a slot array indexed by
+/// it, so get<T>() is an array load and a type check rather than a hash
+/// of std::type_index.  Code that reads a service repeatedly can resolve
+/// it once into a ServiceHandle.
 
-#include <any>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <typeindex>
+#include <typeinfo>
 #include <unordered_map>
+#include <vector>
 
 namespace cgs::foundation {
 
+/// Integer type used to identify service types at runtime.
+using ServiceTypeId = uint32_t;
+
+namespace detail {
+
+/// Global atomic counter for generating unique ServiceTypeId values.
+inline ServiceTypeId nextServiceTypeId() noexcept {
+    static std::atomic<ServiceTypeId> counter{0};
+    return counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+}  // namespace detail
+
+/// Obtain the unique ServiceTypeId for type `T`, assigned on first access.
+///
+/// Ids are per loaded module: a plugin built with its own copy of this
+/// counter may number types differently, which ServiceLocator detects
+/// (every slot records its type) and resolves through a type_index map.
+template <typename T>
+struct ServiceType {
+    static ServiceTypeId Id() noexcept {
+        static const ServiceTypeId value = detail::nextServiceTypeId();
+        return value;
+    }
+};
+
+class ServiceLocator;
+
+/// A service resolved once by ServiceLocator::handle<T>().
+///
+/// get() is a single slot load and follows later add<T>() / remove<T>()
+/// calls on the locator (nullptr while no T is registered).  The handle
+/// refers to its locator, which must outlive it and not be moved.
+template <typename T>
+class ServiceHandle {
+public:
+    ServiceHandle() = default;
+
+    [[nodiscard]] T* get() const noexcept;
+
+    T* operator->() const noexcept { return get(); }
+
+    explicit operator bool() const noexcept { return get() != nullptr; }
+
+private:
+    friend class ServiceLocator;
+    ServiceHandle(const ServiceLocator* locator, std::size_t slot)
+        : locator_(locator), slot_(slot) {}
+
+    const ServiceLocator* locator_ = nullptr;
+    std::size_t slot_ = 0;
+};
+
 /// Lightweight service locator for runtime dependency injection.
 ///
 /// Services are registered by their interface type and retrieved via
 /// type-safe get<T>() calls. This allows decoupling between modules
-/// while keeping runtime flexibility.
+/// while keeping runtime flexibility.  Not synchronized: register services
+/// before sharing the locator between threads.
 ///
 /// Example:
 /// @code
@@ -23,6 +87,10 @@ namespace cgs::foundation {
 ///
 ///   auto* logger = locator.get<ILogger>();
 ///   if (logger) logger->info("hello");
+///
+///   // Resolved once, e.g. in a system's constructor:
+///   auto metrics = locator.handle<GameMetrics>();
+///   if (metrics) metrics->incrementCounter("ticks");
 /// @endcode
 class ServiceLocator {
 public:
@@ -38,44 +106,114 @@ public:
     /// Replaces any previously registered service of the same type.
     template <typename T>
     void add(std::unique_ptr<T> service) {
-        auto key = std::type_index(typeid(T));
-        services_[key] = std::make_any<std::shared_ptr<T>>(std::move(service));
+        Slot& slot = slots_[slotFor<T>()];
+        if (!slot.owner) {
+            ++count_;
+        }
+        slot.service = service.get();
+        slot.owner = std::shared_ptr<void>(std::move(service));
+        if (!slot.owner) {
+            slot.service = nullptr;
+            --count_;
+        }
     }
 
     /// Retrieve a registered service (nullptr if not found).
     template <typename T>
-    [[nodiscard]] T* get() const {
-        auto key = std::type_index(typeid(T));
-        auto it = services_.find(key);
-        if (it == services_.end()) {
-            return nullptr;
+    [[nodiscard]] T* get() const noexcept {
+        const ServiceTypeId id = ServiceType<T>::Id();
+        if (id < slots_.size() && slots_[id].type == &typeid(T)) {
+            return static_cast<T*>(slots_[id].service);
         }
-        auto ptr = std::any_cast<std::shared_ptr<T>>(&it->second);
-        return ptr ? ptr->get() : nullptr;
+        const std::size_t slot = find(typeid(T));
+        return slot == kNoSlot ? nullptr : static_cast<T*>(slots_[slot].service);
+    }
+
+    /// Resolve the slot of T once; the handle sees T registered, replaced
+    /// or removed later.
+    template <typename T>
+    [[nodiscard]] ServiceHandle<T> handle() {
+        return ServiceHandle<T>(this, slotFor<T>());
     }
 
     /// Check if a service of type T is registered.
     template <typename T>
-    [[nodiscard]] bool has() const {
-        auto key = std::type_index(typeid(T));
-        return services_.count(key) > 0;
+    [[nodiscard]] bool has() const noexcept {
+        return get<T>() != nullptr;
     }
 
-    /// Remove a registered service of type T.
+    /// Remove a registered service of type T.  The type keeps its slot, so
+    /// handles to it stay valid and return nullptr.
     template <typename T>
     void remove() {
-        auto key = std::type_index(typeid(T));
-        services_.erase(key);
+        const std::size_t slot = find(typeid(T));
+        if (slot != kNoSlot && slots_[slot].owner) {
+            slots_[slot].service = nullptr;
+            slots_[slot].owner.reset();
+            --count_;
+        }
     }
 
     /// Remove all registered services.
-    void clear() { services_.clear(); }
+    void clear() {
+        for (auto& slot : slots_) {
+            slot.service = nullptr;
+            slot.owner.reset();
+        }
+        count_ = 0;
+    }
 
     /// Number of registered services.
-    [[nodiscard]] std::size_t size() const noexcept { return services_.size(); }
+    [[nodiscard]] std::size_t size() const noexcept { return count_; }
 
 private:
-    std::unordered_map<std::type_index, std::any> services_;
+    template <typename T>
+    friend class ServiceHandle;
+
+    struct Slot {
+        const std::type_info* type = nullptr;  // null: slot unused
+        void* service = nullptr;               // T* of the owner
+        std::shared_ptr<void> owner;
+    };
+
+    static constexpr std::size_t kNoSlot = static_cast<std::size_t>(-1);
+
+    // Slot of @p type, or kNoSlot.  Slow path for ids numbered by another
+    // module (and for types this locator has not seen).
+    [[nodiscard]] std::size_t find(const std::type_info& type) const {
+        auto it = byType_.find(std::type_index(type));
+        return it == byType_.end() ? kNoSlot : it->second;
+    }
+
+    // Slot of T, claimed on first use: slot ServiceType<T>::Id() if free,
+    // otherwise (ids from another module) one past the end.
+    template <typename T>
+    std::size_t slotFor() {
+        const std::size_t existing = find(typeid(T));
+        if (existing != kNoSlot) {
+            return existing;
+        }
+        std::size_t slot = ServiceType<T>::Id();
+        if (slot >= slots_.size()) {
+            slots_.resize(slot + 1);
+        } else if (slots_[slot].type != nullptr) {
+            slot = slots_.size();
+            slots_.emplace_back();
+        }
+        slots_[slot].type = &typeid(T);
+        byType_.emplace(std::type_index(typeid(T)), slot);
+        return slot;
+    }
+
+    std::vector<Slot> slots_;
+    std::unordered_map<std::type_index, std::size_t> byType_;
+    std::size_t count_ = 0;
 };
 
+template <typename T>
+T* ServiceHandle<T>::get() const noexcept {
+    return locator_ == nullptr ? nullptr
+                               : static_cast<T*>(locator_->slots_[slot_].service);
+}
+
 }  // namespace cgs::foundation
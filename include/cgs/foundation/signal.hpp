@@ -5,19 +5,138 @@
 ///
 /// Provides a lightweight, header-only publish/subscribe mechanism. Slots
 /// (callbacks) are registered via connect() and invoked when emit() is called.
-/// Uses std::shared_mutex so readers (emit) can run concurrently while writers
-/// (connect/disconnect) obtain exclusive access.
+/// The slot list is an immutable array swapped atomically by connect() and
+/// disconnect(), so emit() takes no lock and allocates nothing: it loads the
+/// current list and calls each slot.  Slot callables live in place in a
+/// SignalSlot (up to 48 bytes of captures) rather than behind std::function.
 
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
-#include <functional>
+#include <memory>
 #include <mutex>
-#include <shared_mutex>
-#include <unordered_map>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace cgs::foundation {
 
+/// Copyable `void(Args...)` callable that stores captures of up to
+/// kInlineSize bytes in place; larger (or throwing-move) callables fall
+/// back to one heap allocation.
+template <typename... Args>
+class SignalSlot {
+public:
+    static constexpr std::size_t kInlineSize = 48;
+
+    SignalSlot() noexcept = default;
+
+    template <typename F,
+              typename Fn = std::decay_t<F>,
+              typename = std::enable_if_t<!std::is_same_v<Fn, SignalSlot> &&
+                                          std::is_copy_constructible_v<Fn> &&
+                                          std::is_invocable_r_v<void, Fn&, Args...>>>
+    SignalSlot(F&& fn) {  // NOLINT(google-explicit-constructor)
+        if constexpr (fitsInline<Fn>()) {
+            ::new (static_cast<void*>(storage_)) Fn(std::forward<F>(fn));
+            ops_ = &kInlineOps<Fn>;
+        } else {
+            ::new (static_cast<void*>(storage_)) Fn*(new Fn(std::forward<F>(fn)));
+            ops_ = &kHeapOps<Fn>;
+        }
+    }
+
+    SignalSlot(const SignalSlot& other) : ops_(other.ops_) {
+        if (ops_ != nullptr) {
+            ops_->copy(storage_, other.storage_);
+        }
+    }
+
+    SignalSlot(SignalSlot&& other) noexcept : ops_(other.ops_) {
+        if (ops_ != nullptr) {
+            ops_->relocate(storage_, other.storage_);
+            other.ops_ = nullptr;
+        }
+    }
+
+    SignalSlot& operator=(SignalSlot other) noexcept {
+        reset();
+        ops_ = other.ops_;
+        if (ops_ != nullptr) {
+            ops_->relocate(storage_, other.storage_);
+            other.ops_ = nullptr;
+        }
+        return *this;
+    }
+
+    ~SignalSlot() { reset(); }
+
+    void operator()(Args... args) const { ops_->invoke(storage_, args...); }
+
+    explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+    /// Whether the callable lives in place (no heap allocation).
+    [[nodiscard]] bool isInline() const noexcept { return ops_ != nullptr && !ops_->heap; }
+
+    void reset() noexcept {
+        if (ops_ != nullptr) {
+            ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+    }
+
+private:
+    struct Ops {
+        void (*invoke)(void*, Args&...);
+        void (*copy)(void* dst, const void* src);
+        void (*relocate)(void* dst, void* src) noexcept;  // Move, then destroy src
+        void (*destroy)(void*) noexcept;
+        bool heap;
+    };
+
+    template <typename Fn>
+    static constexpr bool fitsInline() {
+        return sizeof(Fn) <= kInlineSize && alignof(Fn) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible_v<Fn>;
+    }
+
+    template <typename Fn>
+    static Fn& as(void* p) noexcept {
+        return *std::launder(static_cast<Fn*>(p));
+    }
+
+    template <typename Fn>
+    static const Fn& as(const void* p) noexcept {
+        return *std::launder(static_cast<const Fn*>(p));
+    }
+
+    template <typename Fn>
+    static constexpr Ops kInlineOps{
+        [](void* p, Args&... args) { as<Fn>(p)(args...); },
+        [](void* dst, const void* src) { ::new (dst) Fn(as<Fn>(src)); },
+        [](void* dst, void* src) noexcept {
+            ::new (dst) Fn(std::move(as<Fn>(src)));
+            as<Fn>(src).~Fn();
+        },
+        [](void* p) noexcept { as<Fn>(p).~Fn(); },
+        false,
+    };
+
+    template <typename Fn>
+    static constexpr Ops kHeapOps{
+        [](void* p, Args&... args) { (*as<Fn*>(p))(args...); },
+        [](void* dst, const void* src) { ::new (dst) Fn*(new Fn(*as<Fn*>(src))); },
+        [](void* dst, void* src) noexcept { ::new (dst) Fn*(as<Fn*>(src)); },
+        [](void* p) noexcept { delete as<Fn*>(p); },
+        true,
+    };
+
+    // Mutable: like std::function, a const slot may call a mutable lambda.
+    alignas(std::max_align_t) mutable unsigned char storage_[kInlineSize];
+    const Ops* ops_ = nullptr;
+};
+
 /// Thread-safe signal (observer pattern) that dispatches events to registered
 /// callbacks.
 ///
@@ -35,19 +154,21 @@ namespace cgs::foundation {
 template <typename... Args>
 class Signal {
 public:
-    using Slot = std::function<void(Args...)>;
+    using Slot = SignalSlot<Args...>;
     using SlotId = uint64_t;
 
     Signal() = default;
-    ~Signal() = default;
 
-    // Non-copyable. Movable with custom move (std::shared_mutex is not movable).
+    ~Signal() { delete list_.load(); }
+
+    // Non-copyable. Movable; moving a signal that is being emitted or
+    // connected to on another thread is not supported.
     Signal(const Signal&) = delete;
     Signal& operator=(const Signal&) = delete;
 
     Signal(Signal&& other) noexcept {
-        std::unique_lock lock(other.mutex_);
-        slots_ = std::move(other.slots_);
+        std::lock_guard lock(other.mutex_);
+        list_.store(other.list_.exchange(nullptr));
         nextId_.store(other.nextId_.load(std::memory_order_relaxed), std::memory_order_relaxed);
     }
 
@@ -56,9 +177,9 @@ public:
             // Lock both, always in address order to prevent deadlock
             auto* first = this < &other ? this : &other;
             auto* second = this < &other ? &other : this;
-            std::unique_lock lock1(first->mutex_);
-            std::unique_lock lock2(second->mutex_);
-            slots_ = std::move(other.slots_);
+            std::lock_guard lock1(first->mutex_);
+            std::lock_guard lock2(second->mutex_);
+            retireLocked(list_.exchange(other.list_.exchange(nullptr)));
             nextId_.store(other.nextId_.load(std::memory_order_relaxed), std::memory_order_relaxed);
         }
         return *this;
@@ -67,48 +188,98 @@ public:
     /// Register a callback. Returns a SlotId for later disconnect().
     SlotId connect(Slot slot) {
         auto id = nextId_.fetch_add(1, std::memory_order_relaxed);
-        std::unique_lock lock(mutex_);
-        slots_.emplace(id, std::move(slot));
+        std::lock_guard lock(mutex_);
+        auto next = std::make_unique<SlotList>();
+        if (const SlotList* current = list_.load()) {
+            next->reserve(current->size() + 1);
+            *next = *current;
+        }
+        next->push_back({id, std::move(slot)});
+        retireLocked(list_.exchange(next.release()));
         return id;
     }
 
     /// Remove a previously registered callback by its SlotId.
     void disconnect(SlotId id) {
-        std::unique_lock lock(mutex_);
-        slots_.erase(id);
+        std::lock_guard lock(mutex_);
+        const SlotList* current = list_.load();
+        if (current == nullptr) {
+            return;
+        }
+        auto next = std::make_unique<SlotList>();
+        next->reserve(current->size());
+        for (const auto& entry : *current) {
+            if (entry.id != id) {
+                next->push_back(entry);
+            }
+        }
+        if (next->size() == current->size()) {
+            return;  // Not connected
+        }
+        retireLocked(list_.exchange(next->empty() ? nullptr : next.release()));
     }
 
-    /// Fire the signal, invoking every registered slot with the given args.
-    /// Slots are invoked under a shared (reader) lock so emit() calls from
-    /// multiple threads can overlap.  However, each slot invocation itself
-    /// is not protected — slots must be internally thread-safe if shared
-    /// state is accessed.
+    /// Fire the signal, invoking every registered slot with the given args
+    /// in connection order.  emit() calls from multiple threads can overlap;
+    /// each slot invocation itself is not protected — slots must be
+    /// internally thread-safe if shared state is accessed.  A slot may
+    /// connect or disconnect; the change applies from the next emit().
     void emit(Args... args) const {
-        // Snapshot the slots under shared lock, then invoke outside the lock
-        // to avoid deadlock if a slot calls connect/disconnect.
-        std::vector<Slot> snapshot;
-        {
-            std::shared_lock lock(mutex_);
-            snapshot.reserve(slots_.size());
-            for (const auto& [id, slot] : slots_) {
-                snapshot.push_back(slot);
-            }
+        if (list_.load(std::memory_order_acquire) == nullptr) {
+            return;
         }
-        for (const auto& slot : snapshot) {
-            slot(args...);
+        ReadGuard guard(readers_);
+        if (const SlotList* list = list_.load()) {
+            for (const auto& entry : *list) {
+                entry.slot(args...);
+            }
         }
     }
 
     /// Return the number of currently connected slots.
     [[nodiscard]] std::size_t slotCount() const {
-        std::shared_lock lock(mutex_);
-        return slots_.size();
+        ReadGuard guard(readers_);
+        const SlotList* list = list_.load();
+        return list == nullptr ? 0 : list->size();
     }
 
 private:
-    std::unordered_map<SlotId, Slot> slots_;
+    struct Entry {
+        SlotId id;
+        Slot slot;
+    };
+    using SlotList = std::vector<Entry>;
+
+    // Open while a thread reads the published list; lists replaced by a
+    // writer are freed only once no guard is open.
+    struct ReadGuard {
+        explicit ReadGuard(std::atomic<uint32_t>& counter) : readers(counter) {
+            readers.fetch_add(1);
+        }
+        ~ReadGuard() { readers.fetch_sub(1); }
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+        std::atomic<uint32_t>& readers;
+    };
+
+    // Retire @p old and free the retired lists if no reader can hold them.
+    // Caller holds mutex_ and has published the replacement.
+    void retireLocked(const SlotList* old) {
+        if (old != nullptr) {
+            retired_.emplace_back(old);
+        }
+        if (readers_.load() == 0) {
+            retired_.clear();
+        }
+    }
+
+    std::atomic<const SlotList*> list_{nullptr};  // null when no slots
+    mutable std::atomic<uint32_t> readers_{0};
     std::atomic<SlotId> nextId_{1};
-    mutable std::shared_mutex mutex_;
+
+    // Serializes connect/disconnect; guards retired_.
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<const SlotList>> retired_;
 };
 
 }  // namespace cgs::foundation
@@ -0,0 +1,85 @@
+#pragma once
+
+/// @file spsc_queue.hpp
+/// @brief Bounded single-producer/single-consumer ring queue.
+///
+/// SpscQueue<T> hands values from exactly one producer thread to exactly
+/// one consumer thread without locks: each side owns one index and only
+/// reads the other's, so a push or pop is a slot move plus one release
+/// store.  The indices sit on separate cache lines, and each side caches
+/// the other's last seen index so it only touches the shared line when
+/// the queue looks full (producer) or empty (consumer).
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace cgs::foundation {
+
+template <typename T>
+class SpscQueue {
+public:
+    /// A queue holding at least @p capacity values (rounded up to a power
+    /// of two).
+    explicit SpscQueue(std::size_t capacity)
+        : capacity_(std::bit_ceil(capacity < 2 ? std::size_t{2} : capacity)),
+          mask_(capacity_ - 1),
+          slots_(std::make_unique<std::optional<T>[]>(capacity_)) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /// Producer: append @p value.  @return false (value untouched) if full.
+    bool tryPush(T&& value) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - headCache_ == capacity_) {
+            headCache_ = head_.load(std::memory_order_acquire);
+            if (tail - headCache_ == capacity_) {
+                return false;
+            }
+        }
+        slots_[tail & mask_].emplace(std::move(value));
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Consumer: remove the oldest value into @p out.  @return false if empty.
+    bool tryPop(T& out) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tailCache_) {
+            tailCache_ = tail_.load(std::memory_order_acquire);
+            if (head == tailCache_) {
+                return false;
+            }
+        }
+        auto& slot = slots_[head & mask_];
+        out = std::move(*slot);
+        slot.reset();
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Values queued; exact only when neither side is running.
+    [[nodiscard]] std::size_t size() const noexcept {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+
+private:
+    const std::size_t capacity_;
+    const std::size_t mask_;
+    std::unique_ptr<std::optional<T>[]> slots_;
+
+    alignas(64) std::atomic<std::size_t> head_{0};  ///< Written by the consumer.
+    std::size_t tailCache_ = 0;                     ///< Consumer's view of tail_.
+    alignas(64) std::atomic<std::size_t> tail_{0};  ///< Written by the producer.
+    std::size_t headCache_ = 0;                     ///< Producer's view of head_.
+};
+
+}  // namespace cgs::foundation
@@ -0,0 +1,305 @@
+#pragma once
+
+/// @file task.hpp
+/// @brief Task<T>: lazily started C++20 coroutine with continuation chaining.
+///
+/// A coroutine returning Task<T> runs when it is first co_await-ed (or
+/// handed to spawn()/syncWait()) and resumes its awaiter directly when it
+/// finishes (symmetric transfer; with optimizations on, no stack grows
+/// along an await chain).  Suspended tasks hold no thread: thousands of
+/// requests waiting on the database cost one coroutine frame each.
+///
+/// Where a task resumes is decided by what it awaits:
+///   - awaitCallback() resumes on the thread that invokes the callback
+///     (e.g. a GameDatabase query worker);
+///   - ResumeQueue::nextTick() / sleepFor() resume on the thread that
+///     drains the queue (the game thread, once per tick);
+///   - GameJobScheduler::resumeOnWorker() resumes on a native worker.
+///
+/// Example:
+/// @code
+///   Task<GameResult<Character>> loadCharacter(GameDatabase& db, ResumeQueue& game,
+///                                             uint64_t id) {
+///       auto rows = co_await db.queryTask("SELECT * FROM characters WHERE id = " +
+///                                         std::to_string(id));
+///       co_await game.nextTick();  // Back on the game thread
+///       if (rows.hasError()) {
+///           co_return GameResult<Character>::err(rows.error());
+///       }
+///       co_return GameResult<Character>::ok(spawnCharacter(rows.value()));
+///   }
+///
+///   spawn(zoneIn(db, game, playerId));  // Fire and forget
+/// @endcode
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace cgs::foundation {
+
+template <typename T = void>
+class Task;
+
+namespace detail {
+
+/// State shared by every Task promise: who to resume when done, and
+/// whether the frame owns itself (spawn()).
+class TaskPromiseBase {
+public:
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> self) noexcept {
+            auto& promise = self.promise();
+            if (promise.detached_) {
+                if (promise.error_) {
+                    std::terminate();  // Nobody can observe a detached task's exception
+                }
+                self.destroy();
+                return std::noop_coroutine();
+            }
+            return promise.continuation_ ? promise.continuation_ : std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+
+    void unhandled_exception() noexcept { error_ = std::current_exception(); }
+
+    void setContinuation(std::coroutine_handle<> continuation) noexcept {
+        continuation_ = continuation;
+    }
+
+    void detach() noexcept { detached_ = true; }
+
+protected:
+    void rethrowIfFailed() const {
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+    }
+
+private:
+    std::coroutine_handle<> continuation_;
+    std::exception_ptr error_;
+    bool detached_ = false;
+};
+
+template <typename T>
+class TaskPromise : public TaskPromiseBase {
+public:
+    Task<T> get_return_object() noexcept;
+
+    template <typename U>
+    void return_value(U&& value) {
+        value_.emplace(std::forward<U>(value));
+    }
+
+    T take() {
+        rethrowIfFailed();
+        return std::move(*value_);
+    }
+
+private:
+    std::optional<T> value_;
+};
+
+template <>
+class TaskPromise<void> : public TaskPromiseBase {
+public:
+    Task<void> get_return_object() noexcept;
+
+    void return_void() const noexcept {}
+
+    void take() const { rethrowIfFailed(); }
+};
+
+}  // namespace detail
+
+/// Move-only handle to a lazily started coroutine producing a T.
+///
+/// Destroying a Task that was never started destroys its frame; a Task
+/// must not be destroyed while the coroutine is suspended mid-body
+/// (await it, or give it to spawn()).  An exception escaping the body is
+/// rethrown from co_await.
+template <typename T>
+class [[nodiscard]] Task {
+public:
+    using promise_type = detail::TaskPromise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Task() noexcept = default;
+
+    explicit Task(Handle handle) noexcept : handle_(handle) {}
+
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle_) {
+                handle_.destroy();
+            }
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    [[nodiscard]] bool valid() const noexcept { return static_cast<bool>(handle_); }
+
+    /// Whether the coroutine has run to completion.
+    [[nodiscard]] bool done() const noexcept { return handle_ && handle_.done(); }
+
+    auto operator co_await() && noexcept {
+        struct Awaiter {
+            Handle handle;
+
+            bool await_ready() const noexcept { return !handle || handle.done(); }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                handle.promise().setContinuation(awaiting);
+                return handle;
+            }
+
+            T await_resume() { return handle.promise().take(); }
+        };
+        return Awaiter{handle_};
+    }
+
+    /// Give up ownership of the frame (used by spawn()).
+    Handle release() noexcept { return std::exchange(handle_, {}); }
+
+private:
+    Handle handle_;
+};
+
+namespace detail {
+
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept {
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+}  // namespace detail
+
+/// Start @p task on the calling thread and let it run to completion on
+/// its own; the frame frees itself when done.  An exception escaping a
+/// spawned task terminates the process, so catch inside.
+inline void spawn(Task<void> task) {
+    auto handle = task.release();
+    if (handle) {
+        handle.promise().detach();
+        handle.resume();
+    }
+}
+
+namespace detail {
+
+template <typename T>
+struct SyncWaitState {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool done = false;
+    std::optional<std::conditional_t<std::is_void_v<T>, bool, T>> value;
+    std::exception_ptr error;
+};
+
+template <typename T>
+Task<void> syncWaitRunner(Task<T> task, SyncWaitState<T>* state) {
+    try {
+        if constexpr (std::is_void_v<T>) {
+            co_await std::move(task);
+            state->value.emplace(true);
+        } else {
+            state->value.emplace(co_await std::move(task));
+        }
+    } catch (...) {
+        state->error = std::current_exception();
+    }
+    std::lock_guard lock(state->mutex);
+    state->done = true;
+    state->cv.notify_one();  // Under the lock: the waiter owns the state
+}
+
+}  // namespace detail
+
+/// Run @p task and block the calling thread until it finishes, for
+/// tools and tests.  Never call it on a thread the task needs in order
+/// to finish (e.g. the game thread while the task awaits nextTick()).
+template <typename T>
+T syncWait(Task<T> task) {
+    detail::SyncWaitState<T> state;
+    spawn(detail::syncWaitRunner(std::move(task), &state));
+    std::unique_lock lock(state.mutex);
+    state.cv.wait(lock, [&] { return state.done; });
+    if (state.error) {
+        std::rethrow_exception(state.error);
+    }
+    if constexpr (!std::is_void_v<T>) {
+        return std::move(*state.value);
+    }
+}
+
+/// Awaitable adapting a callback-based asynchronous API.
+///
+/// `co_await awaitCallback<R>(start)` calls `start(complete)`; the
+/// coroutine resumes, with the value passed to `complete(R)`, on
+/// whichever thread calls it (inline if called before start returns).
+/// `complete` must be called exactly once.
+template <typename R, typename Start>
+auto awaitCallback(Start start) {
+    struct Awaiter {
+        Start start;
+        std::optional<R> result;
+        std::coroutine_handle<> handle;
+        std::atomic<bool> ready{false};  // Set by whichever of suspend/complete runs second
+
+        struct Complete {
+            Awaiter* self;
+
+            void operator()(R value) const {
+                self->result.emplace(std::move(value));
+                if (self->ready.exchange(true, std::memory_order_acq_rel)) {
+                    self->handle.resume();
+                }
+            }
+        };
+
+        bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(std::coroutine_handle<> awaiting) {
+            handle = awaiting;
+            start(Complete{this});
+            // Completed inline: resume without suspending.
+            return !ready.exchange(true, std::memory_order_acq_rel);
+        }
+
+        R await_resume() { return std::move(*result); }
+    };
+    return Awaiter{std::move(start), std::nullopt, {}, {}};
+}
+
+}  // namespace cgs::foundation
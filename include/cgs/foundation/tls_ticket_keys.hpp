@@ -0,0 +1,120 @@
+#pragma once
+
+/// @file tls_ticket_keys.hpp
+/// @brief Session-ticket keys shared by every gateway replica, and the
+///        kernel TLS availability probe.
+///
+/// A full TLS 1.3 handshake costs an asymmetric key exchange and a
+/// certificate signature; a resumed one costs neither.  After a gateway
+/// failover every client reconnects at once, so most of them have to be
+/// able to resume on whichever replica they land on.  That only works if
+/// all replicas encrypt and decrypt session tickets with the same keys:
+/// TlsTicketKeyRing holds that key set.
+///
+/// Keys are provisioned, not negotiated.  Every replica loads the same
+/// key file (concatenated 80-byte records in the layout nginx and HAProxy
+/// use for ssl_session_ticket_key), so the fleet agrees without talking.
+/// To rotate without invalidating tickets in flight:
+///   1. Append the new key as the second record and reload everywhere;
+///      replicas now accept tickets issued under it.
+///   2. Move it to the front and reload everywhere; it now encrypts.
+///   3. Drop the oldest record once the ticket lifetime has passed.
+/// Part of the Network System Adapter (SDS-MOD-004).
+
+#include "cgs/foundation/game_result.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace cgs::foundation {
+
+/// One session-ticket key: a public name carried in each ticket plus the
+/// secrets that protect it.
+struct TlsTicketKey {
+    static constexpr std::size_t kNameSize = 16;
+    static constexpr std::size_t kSecretSize = 32;
+    /// Bytes of one key-file record: name, HMAC secret, AES key.
+    static constexpr std::size_t kRecordSize = kNameSize + 2 * kSecretSize;
+
+    std::array<uint8_t, kNameSize> name{};
+    std::array<uint8_t, kSecretSize> hmacSecret{};
+    std::array<uint8_t, kSecretSize> aesKey{};
+
+    /// Parse one key-file record.  Returns nullopt unless @p record holds
+    /// exactly kRecordSize bytes.
+    [[nodiscard]] static std::optional<TlsTicketKey> fromRecord(std::span<const uint8_t> record);
+
+    [[nodiscard]] bool operator==(const TlsTicketKey&) const = default;
+};
+
+/// The ticket keys of one listener, newest first.
+///
+/// The first key encrypts new tickets; every key decrypts.  Safe to use
+/// from handshake threads while another thread reloads or rotates.
+///
+/// Usage:
+/// @code
+///   auto keys = std::make_shared<TlsTicketKeyRing>();
+///   if (auto loaded = keys->loadFile("/etc/cgs/ticket.keys"); loaded.hasError()) { ... }
+///   TlsConfig tls{.certPath = ..., .keyPath = ..., .ticketKeys = keys};
+///   (void)net.listen(7000, Protocol::TCP, tls);
+///   // On the rotation schedule:
+///   (void)keys->loadFile("/etc/cgs/ticket.keys");
+/// @endcode
+class TlsTicketKeyRing {
+public:
+    /// Most keys kept; rotate() drops the oldest beyond this.
+    static constexpr std::size_t kMaxKeys = 4;
+
+    TlsTicketKeyRing() = default;
+
+    TlsTicketKeyRing(const TlsTicketKeyRing&) = delete;
+    TlsTicketKeyRing& operator=(const TlsTicketKeyRing&) = delete;
+
+    /// Replace every key; @p keys[0] encrypts.
+    /// @return ErrorCode::InvalidArgument for an empty list, more than
+    ///         kMaxKeys keys or a repeated name.  The ring is unchanged.
+    [[nodiscard]] GameResult<void> setKeys(std::vector<TlsTicketKey> keys);
+
+    /// Replace every key with the records of @p path (see the file
+    /// comment for the layout and rotation procedure).
+    /// @return ErrorCode::ConfigLoadFailed if the file cannot be read or
+    ///         is not a whole number of records, else as setKeys().
+    [[nodiscard]] GameResult<void> loadFile(const std::filesystem::path& path);
+
+    /// Make @p key the encryption key, keeping the previous keys for
+    /// decryption.  For a single replica, or keys derived elsewhere on a
+    /// schedule every replica shares; a fleet normally uses loadFile().
+    void rotate(const TlsTicketKey& key);
+
+    /// Key for new tickets, or nullopt while the ring is empty.
+    [[nodiscard]] std::optional<TlsTicketKey> encryptionKey() const;
+
+    /// Key named by a presented ticket, or nullopt (full handshake).
+    [[nodiscard]] std::optional<TlsTicketKey> find(
+        std::span<const uint8_t, TlsTicketKey::kNameSize> name) const;
+
+    [[nodiscard]] std::size_t size() const;
+    [[nodiscard]] bool empty() const;
+
+    /// Bumped by every successful change, so a transport can tell when
+    /// to refresh keys it copied into its TLS library.
+    [[nodiscard]] uint64_t generation() const;
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<TlsTicketKey> keys_;
+    uint64_t generation_ = 0;
+};
+
+/// True when the kernel can take over TLS record encryption (Linux with
+/// the "tls" upper-layer protocol available).  Always false elsewhere.
+[[nodiscard]] bool kernelTlsAvailable();
+
+}  // namespace cgs::foundation
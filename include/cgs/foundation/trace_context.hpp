@@ -0,0 +1,138 @@
+#pragma once
+
+/// @file trace_context.hpp
+/// @brief W3C-style trace context carried between services.
+///
+/// A TraceContext names the span a piece of work belongs to: a 128-bit
+/// trace id shared by every span of one request, the 64-bit id of the
+/// sending span, and the sampled flag, so a downstream service makes the
+/// same sampling decision as the service that started the trace.  It
+/// travels in NetworkMessage frames (encode()/decode(), 25 bytes) and in
+/// HTTP headers (traceparent()/parseTraceparent()).  Shared by the
+/// Monitoring (SDS-MOD-006) and Network (SDS-MOD-004) adapters.
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace cgs::foundation {
+
+struct TraceContext {
+    /// Bytes of encode() output: trace id, span id, flags.
+    static constexpr std::size_t kEncodedSize = 16 + 8 + 1;
+
+    /// Flag bit: the trace is sampled (recorded and exported).
+    static constexpr uint8_t kSampledFlag = 0x01;
+
+    uint64_t traceIdHigh = 0;
+    uint64_t traceIdLow = 0;
+    uint64_t spanId = 0;
+    uint8_t flags = 0;
+
+    /// Whether this names a trace (an all-zero trace id is "none").
+    [[nodiscard]] constexpr bool valid() const noexcept {
+        return (traceIdHigh | traceIdLow) != 0 && spanId != 0;
+    }
+
+    [[nodiscard]] constexpr bool sampled() const noexcept {
+        return (flags & kSampledFlag) != 0;
+    }
+
+    /// Write kEncodedSize bytes (network order) to @p out.
+    void encode(uint8_t* out) const noexcept {
+        putU64(out, traceIdHigh);
+        putU64(out + 8, traceIdLow);
+        putU64(out + 16, spanId);
+        out[24] = flags;
+    }
+
+    /// Read kEncodedSize bytes written by encode().
+    [[nodiscard]] static TraceContext decode(const uint8_t* in) noexcept {
+        TraceContext context;
+        context.traceIdHigh = getU64(in);
+        context.traceIdLow = getU64(in + 8);
+        context.spanId = getU64(in + 16);
+        context.flags = in[24];
+        return context;
+    }
+
+    /// The W3C `traceparent` header value: "00-<trace>-<span>-<flags>".
+    [[nodiscard]] std::string traceparent() const {
+        std::string out = "00-";
+        appendHex(out, traceIdHigh, 16);
+        appendHex(out, traceIdLow, 16);
+        out += '-';
+        appendHex(out, spanId, 16);
+        out += '-';
+        appendHex(out, flags, 2);
+        return out;
+    }
+
+    /// Parse a version-00 `traceparent` value; nullopt if malformed or
+    /// naming no trace.
+    [[nodiscard]] static std::optional<TraceContext> parseTraceparent(std::string_view text) {
+        constexpr std::size_t kLength = 2 + 1 + 32 + 1 + 16 + 1 + 2;
+        if (text.size() != kLength || text.substr(0, 3) != "00-" || text[35] != '-' ||
+            text[52] != '-') {
+            return std::nullopt;
+        }
+        TraceContext context;
+        uint64_t flags = 0;
+        if (!parseHex(text.substr(3, 16), context.traceIdHigh) ||
+            !parseHex(text.substr(19, 16), context.traceIdLow) ||
+            !parseHex(text.substr(36, 16), context.spanId) ||
+            !parseHex(text.substr(53, 2), flags)) {
+            return std::nullopt;
+        }
+        context.flags = static_cast<uint8_t>(flags);
+        if (!context.valid()) {
+            return std::nullopt;
+        }
+        return context;
+    }
+
+    /// Append @p value as @p digits lowercase hex digits to @p out.
+    static void appendHex(std::string& out, uint64_t value, int digits) {
+        constexpr char kHex[] = "0123456789abcdef";
+        for (int shift = (digits - 1) * 4; shift >= 0; shift -= 4) {
+            out += kHex[(value >> shift) & 0xF];
+        }
+    }
+
+    friend constexpr bool operator==(const TraceContext&, const TraceContext&) = default;
+
+private:
+    static void putU64(uint8_t* out, uint64_t value) noexcept {
+        for (int i = 0; i < 8; ++i) {
+            out[i] = static_cast<uint8_t>(value >> (56 - 8 * i));
+        }
+    }
+
+    static uint64_t getU64(const uint8_t* in) noexcept {
+        uint64_t value = 0;
+        for (int i = 0; i < 8; ++i) {
+            value = (value << 8) | in[i];
+        }
+        return value;
+    }
+
+    static bool parseHex(std::string_view digits, uint64_t& out) noexcept {
+        out = 0;
+        for (const char c : digits) {
+            uint64_t nibble = 0;
+            if (c >= '0' && c <= '9') {
+                nibble = static_cast<uint64_t>(c - '0');
+            } else if (c >= 'a' && c <= 'f') {
+                nibble = static_cast<uint64_t>(c - 'a' + 10);
+            } else {
+                return false;
+            }
+            out = (out << 4) | nibble;
+        }
+        return true;
+    }
+};
+
+}  // namespace cgs::foundation
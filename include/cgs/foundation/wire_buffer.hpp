@@ -0,0 +1,235 @@
+#pragma once
+
+/// @file wire_buffer.hpp
+/// @brief Pooled, reference-counted frames in the NetworkMessage wire format.
+///
+/// A WireBuffer reserves the 6-byte frame header in front of its payload,
+/// so a message is written once -- straight into pooled storage -- and
+/// seal() fills the header in place.  Copies of a WireBuffer share the
+/// same bytes, which lets one frame be handed to every recipient of a
+/// broadcast.  The storage returns to its WireBufferPool when the last
+/// copy is destroyed.  Part of the Network System Adapter (SDS-MOD-004).
+
+#include "cgs/foundation/trace_context.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace cgs::foundation {
+
+class WireBufferPool;
+
+/// Handle to one framed message: [4-byte length][2-byte opcode][payload].
+/// A traced frame carries a TraceContext (kTracedFlag, encoded in the
+/// first TraceContext::kEncodedSize bytes after the header) ahead of its
+/// payload.
+///
+/// Write the payload with append()/extend(), then seal() it; after that
+/// the frame is read-only and may be copied freely (copies are cheap and
+/// share the bytes).  Writing to a buffer that has been copied is a
+/// logic error.  A default-constructed WireBuffer is empty.
+class WireBuffer {
+public:
+    /// Bytes reserved in front of the payload for the frame header.
+    static constexpr std::size_t kHeaderSize = 6;
+
+    /// Bit of the length word marking a PayloadCompressor payload.
+    static constexpr uint32_t kCompressedFlag = 0x80000000u;
+
+    /// Bit of the length word marking a TraceContext ahead of the payload.
+    static constexpr uint32_t kTracedFlag = 0x40000000u;
+
+    /// Bits of the length word holding the frame length.
+    static constexpr uint32_t kLengthMask = ~(kCompressedFlag | kTracedFlag);
+
+    WireBuffer() = default;
+    ~WireBuffer() { release(); }
+
+    WireBuffer(const WireBuffer& other) noexcept : storage_(other.storage_) {
+        if (storage_ != nullptr) {
+            storage_->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    WireBuffer& operator=(const WireBuffer& other) noexcept {
+        if (this != &other) {
+            WireBuffer copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    WireBuffer(WireBuffer&& other) noexcept : storage_(other.storage_) {
+        other.storage_ = nullptr;
+    }
+
+    WireBuffer& operator=(WireBuffer&& other) noexcept {
+        if (this != &other) {
+            release();
+            storage_ = other.storage_;
+            other.storage_ = nullptr;
+        }
+        return *this;
+    }
+
+    void swap(WireBuffer& other) noexcept { std::swap(storage_, other.storage_); }
+
+    [[nodiscard]] bool empty() const noexcept { return storage_ == nullptr; }
+    explicit operator bool() const noexcept { return storage_ != nullptr; }
+
+    // ── Writing ─────────────────────────────────────────────────────────────
+
+    /// Grow the payload by @p size bytes and return the new region.
+    [[nodiscard]] std::span<uint8_t> extend(std::size_t size) {
+        auto& bytes = storage_->bytes;
+        const std::size_t offset = bytes.size();
+        bytes.resize(offset + size);
+        return {bytes.data() + offset, size};
+    }
+
+    /// Append @p size bytes from @p data to the payload.
+    void append(const void* data, std::size_t size) {
+        if (size > 0) {
+            std::memcpy(extend(size).data(), data, size);
+        }
+    }
+
+    void append(std::span<const uint8_t> data) { append(data.data(), data.size()); }
+
+    /// Write the header for @p opcode in front of the payload, marking it
+    /// compressed if @p compressed and traced if @p traced (the payload
+    /// then begins with an encoded TraceContext).
+    void seal(uint16_t opcode, bool compressed = false, bool traced = false) noexcept {
+        auto& bytes = storage_->bytes;
+        const auto totalLen = static_cast<uint32_t>(bytes.size()) |
+                              (compressed ? kCompressedFlag : 0u) | (traced ? kTracedFlag : 0u);
+        // Network byte order (big-endian)
+        bytes[0] = static_cast<uint8_t>((totalLen >> 24) & 0xFF);
+        bytes[1] = static_cast<uint8_t>((totalLen >> 16) & 0xFF);
+        bytes[2] = static_cast<uint8_t>((totalLen >> 8) & 0xFF);
+        bytes[3] = static_cast<uint8_t>(totalLen & 0xFF);
+        bytes[4] = static_cast<uint8_t>((opcode >> 8) & 0xFF);
+        bytes[5] = static_cast<uint8_t>(opcode & 0xFF);
+    }
+
+    // ── Reading ─────────────────────────────────────────────────────────────
+
+    /// The whole frame, header included.
+    [[nodiscard]] std::span<const uint8_t> bytes() const noexcept {
+        if (storage_ == nullptr) {
+            return {};
+        }
+        return {storage_->bytes.data(), storage_->bytes.size()};
+    }
+
+    /// The payload after the header (and trace context).
+    [[nodiscard]] std::span<const uint8_t> payload() const noexcept {
+        if (storage_ == nullptr) {
+            return {};
+        }
+        return bytes().subspan(kHeaderSize + (traced() ? TraceContext::kEncodedSize : 0));
+    }
+
+    /// The opcode written by seal().
+    [[nodiscard]] uint16_t opcode() const noexcept {
+        const auto frame = bytes();
+        return frame.empty() ? 0 : static_cast<uint16_t>((frame[4] << 8) | frame[5]);
+    }
+
+    /// Whether seal() marked the payload compressed.
+    [[nodiscard]] bool compressed() const noexcept {
+        const auto frame = bytes();
+        return !frame.empty() && (frame[0] & 0x80) != 0;
+    }
+
+    /// Whether seal() marked the frame traced.
+    [[nodiscard]] bool traced() const noexcept {
+        const auto frame = bytes();
+        return !frame.empty() && (frame[0] & 0x40) != 0;
+    }
+
+    /// The frame's trace context; invalid when it is not traced.
+    [[nodiscard]] TraceContext traceContext() const noexcept {
+        return traced() ? TraceContext::decode(bytes().data() + kHeaderSize) : TraceContext{};
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return bytes().size(); }
+
+    /// Number of WireBuffer handles sharing these bytes (0 when empty).
+    [[nodiscard]] uint32_t useCount() const noexcept {
+        return storage_ == nullptr ? 0 : storage_->refs.load(std::memory_order_relaxed);
+    }
+
+    /// Move the frame bytes out when this is the only handle; otherwise
+    /// copy them.  Leaves this buffer empty.  For transports that take
+    /// ownership of a byte vector.
+    [[nodiscard]] std::vector<uint8_t> take();
+
+private:
+    friend class WireBufferPool;
+
+    struct PoolState;
+
+    struct Storage {
+        std::atomic<uint32_t> refs{1};
+        std::vector<uint8_t> bytes;
+        std::shared_ptr<PoolState> pool;  ///< Null for unpooled storage.
+    };
+
+    explicit WireBuffer(Storage* storage) noexcept : storage_(storage) {}
+
+    void release() noexcept {
+        if (storage_ != nullptr && storage_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            recycle(storage_);
+        }
+        storage_ = nullptr;
+    }
+
+    /// Return @p storage to its pool, or free it.
+    static void recycle(Storage* storage) noexcept;
+
+    Storage* storage_ = nullptr;
+};
+
+/// Free list of WireBuffer storage.  Thread-safe; buffers may outlive the
+/// pool (their storage is then freed instead of recycled).
+class WireBufferPool {
+public:
+    /// Default number of idle buffers kept for reuse.
+    static constexpr std::size_t kDefaultMaxIdle = 1024;
+
+    /// Idle buffers whose capacity exceeds this are freed, not kept.
+    static constexpr std::size_t kMaxRetainedCapacity = 64 * 1024;
+
+    explicit WireBufferPool(std::size_t maxIdle = kDefaultMaxIdle);
+    ~WireBufferPool();
+
+    WireBufferPool(const WireBufferPool&) = delete;
+    WireBufferPool& operator=(const WireBufferPool&) = delete;
+
+    /// An unsealed buffer with room for @p payloadCapacity payload bytes.
+    [[nodiscard]] WireBuffer acquire(std::size_t payloadCapacity = 0);
+
+    /// A sealed frame of @p opcode and @p payload, traced with @p trace
+    /// when that is valid.
+    [[nodiscard]] WireBuffer frame(uint16_t opcode,
+                                   std::span<const uint8_t> payload,
+                                   bool compressed = false,
+                                   const TraceContext& trace = {});
+
+    /// Buffers currently idle in the pool.
+    [[nodiscard]] std::size_t idleCount() const;
+
+    /// Storage allocations made because the pool was empty.
+    [[nodiscard]] uint64_t allocationCount() const;
+
+private:
+    std::shared_ptr<WireBuffer::PoolState> state_;
+};
+
+}  // namespace cgs::foundation
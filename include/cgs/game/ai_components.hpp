@@ -10,10 +10,13 @@
 /// @see SDS-MOD-023
 
 #include "cgs/ecs/entity.hpp"
+#include "cgs/ecs/small_vector.hpp"
 #include "cgs/game/ai_types.hpp"
 #include "cgs/game/behavior_tree.hpp"
+#include "cgs/game/compiled_behavior_tree.hpp"
 #include "cgs/game/math_types.hpp"
 
+#include <cstdint>
 #include <memory>
 
 namespace cgs::game {
@@ -23,12 +26,27 @@ namespace cgs::game {
 /// AI brain component holding behavior tree reference and per-entity state.
 ///
 /// Each AI entity has its own AIBrain with a shared_ptr to a behavior
-/// tree root (trees can be shared across multiple entities of the same
-/// type) and a private Blackboard for instance-specific data.
+/// tree (trees are shared across entities of the same type) and a
+/// private Blackboard for instance-specific data.  The tree is only a
+/// definition: AISystem runs it through a CompiledBehaviorTree and keeps
+/// this entity's composite cursors and repeat counts in treeState, so
+/// one tree instance serves a whole mob pack.
 struct AIBrain {
     /// Root of the behavior tree (shared across same-type entities).
     std::shared_ptr<BTNode> behaviorTree;
 
+    /// Pre-compiled tree, preferred over behaviorTree when set.  When
+    /// only behaviorTree is set, AISystem compiles it once per root.
+    std::shared_ptr<const CompiledBehaviorTree> compiledTree;
+
+    /// This entity's tree state slots, inline for trees with up to eight
+    /// stateful nodes.  Sized and zeroed by AISystem whenever the tree
+    /// it belongs to changes.
+    cgs::ecs::SmallVector<uint32_t, 8> treeState;
+
+    /// Tree treeState was laid out for (identity only, not owned).
+    const CompiledBehaviorTree* treeStateOwner = nullptr;
+
     /// Per-entity data store for BT node communication.
     Blackboard blackboard;
 
@@ -46,6 +64,11 @@ struct AIBrain {
 
     /// Current target entity for combat/chase behavior.
     cgs::ecs::Entity target;
+
+    /// AISystem LOD bookkeeping: the last frame an observer found this
+    /// entity, and its squared XZ distance to the nearest one.
+    uint32_t lodFrame = 0;
+    float lodDistanceSq = 0.0f;
 };
 
 }  // namespace cgs::game
@@ -14,13 +14,39 @@
 #include "cgs/game/ai_components.hpp"
 #include "cgs/game/combat_components.hpp"
 #include "cgs/game/components.hpp"
+#include "cgs/game/pathfinding.hpp"
+#include "cgs/game/spatial_index.hpp"
 
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <span>
 #include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace cgs::game {
 
+/// One distance band of an AILodPolicy.
+struct AILodBand {
+    float maxDistance = 0.0f;   ///< XZ distance to the nearest observer.
+    float tickInterval = 0.0f;  ///< Interval for agents inside the band.
+};
+
+/// Distance-based AI level of detail: agents tick at the interval of the
+/// first band (ascending maxDistance) that contains their nearest
+/// observer; agents beyond the last band are dormant and not visited.
+struct AILodPolicy {
+    std::vector<AILodBand> bands;
+};
+
+/// A point that keeps nearby AI awake (usually a player), with the
+/// spatial index of its map, which must contain the AI entities.
+struct AILodObserver {
+    Vector3 position;
+    const SpatialIndex* index = nullptr;
+};
+
 /// System that executes AI behavior trees with frame-distributed throttling.
 ///
 /// Each tick:
@@ -28,8 +54,25 @@ namespace cgs::game {
 ///   2. For brains whose timer exceeds their tick interval, execute the BT.
 ///   3. Reset the timer after execution.
 ///
+/// Trees are ticked through CompiledBehaviorTree: a brain's
+/// behaviorTree is compiled once per distinct root and cached while any
+/// brain still holds it.  Due brains are gathered and ticked in one
+/// TickBatch() per tree, each with its own AIBrain::treeState.
+///
 /// This ensures AI updates are spread across multiple frames rather than
 /// all running simultaneously, reducing per-frame CPU spikes.
+///
+/// Sliced by SystemScheduler::SetUpdateSlices(), each run visits only the
+/// brains whose entity id falls in CurrentSlice(), so k slices spread the
+/// brains over k ticks.  LOD gathering (below) ignores slicing.
+///
+/// With SetLodPolicy(), only agents near an observer are visited: each
+/// observer queries its spatial index out to the last band, each agent
+/// found takes the band of its nearest observer as its default interval,
+/// and every other brain is left untouched, so per-tick cost follows the
+/// number of observers rather than spawned NPCs.  An agent waking from
+/// dormancy starts at an evenly spread phase of its interval, so agents
+/// sharing a band do not all fire on the same frame.
 class AISystem final : public cgs::ecs::ISystem {
 public:
     AISystem(cgs::ecs::ComponentStorage<AIBrain>& brains,
@@ -53,7 +96,11 @@ public:
 
     /// Create a MoveTo action node.
     /// Reads "move_target" (Vector3) from the blackboard and drives
-    /// the entity's Movement toward it.
+    /// the entity's Movement toward it.  When a pathfinding resolver
+    /// returns a service for the entity, it requests a path and follows
+    /// its waypoints, steering straight at the target until the path
+    /// arrives; it fails if the service finds no route.  The request
+    /// state lives under "path_request", "path_goal" and "path".
     [[nodiscard]] std::unique_ptr<BTNode> CreateMoveToTask();
 
     /// Create an Attack action node.
@@ -82,10 +129,52 @@ public:
     /// Get the current default tick interval.
     [[nodiscard]] float GetDefaultTickInterval() const noexcept { return defaultTickInterval_; }
 
+    /// Map an entity to the PathfindingService of its map (nullptr for
+    /// straight-line movement).  Used by CreateMoveToTask() nodes.
+    using PathfindingResolver = std::function<PathfindingService*(cgs::ecs::Entity)>;
+    void SetPathfindingResolver(PathfindingResolver resolver) {
+        pathResolver_ = std::move(resolver);
+    }
+
     /// Get the number of AI entities updated on the last Execute call.
     [[nodiscard]] uint32_t GetLastTickUpdateCount() const noexcept { return lastTickUpdateCount_; }
 
+    // ── Level of detail ──────────────────────────────────────────────
+
+    /// Enable distance-based LOD with @p policy (empty bands disable it).
+    /// A brain's own tickInterval, when set, still overrides the band.
+    void SetLodPolicy(AILodPolicy policy);
+
+    [[nodiscard]] bool LodEnabled() const noexcept { return !lodPolicy_.bands.empty(); }
+
+    /// Observers for the next Execute() calls (copied).  Refresh them
+    /// each tick as players move.
+    void SetLodObservers(std::span<const AILodObserver> observers);
+
+    /// Agents within range of an observer on the last Execute (every
+    /// brain when LOD is disabled).
+    [[nodiscard]] uint32_t GetLastAwakeCount() const noexcept { return lastAwakeCount_; }
+
+    /// Number of behaviorTree roots currently compiled and cached.
+    [[nodiscard]] std::size_t CompiledTreeCount() const noexcept { return compiled_.size(); }
+
 private:
+    /// Accumulate @p deltaTime on @p brain and queue it when due.
+    /// @return true if queued.
+    bool enqueueIfDue(cgs::ecs::Entity entity,
+                      AIBrain& brain,
+                      float deltaTime,
+                      float defaultInterval);
+
+    /// Queue the due brains near LOD observers; returns how many.
+    uint32_t gatherLod(float deltaTime);
+
+    /// Tick pending_ in one TickBatch() per tree.
+    void tickPending();
+
+    /// Compiled form of @p root, compiling it on first use.
+    const CompiledBehaviorTree* compiledFor(const std::shared_ptr<BTNode>& root);
+
     cgs::ecs::ComponentStorage<AIBrain>& brains_;
     cgs::ecs::ComponentStorage<Transform>& transforms_;
     cgs::ecs::ComponentStorage<Movement>& movements_;
@@ -94,6 +183,29 @@ private:
 
     float defaultTickInterval_;
     uint32_t lastTickUpdateCount_ = 0;
+    PathfindingResolver pathResolver_;
+
+    /// Due brains, grouped by tree before ticking.
+    struct PendingAgent {
+        const CompiledBehaviorTree* tree;
+        cgs::ecs::Entity entity;
+        float deltaTime;
+    };
+    std::vector<PendingAgent> pending_;
+    std::vector<BTAgent> agents_;
+
+    AILodPolicy lodPolicy_;
+    std::vector<AILodObserver> lodObservers_;
+    struct AwakeAgent {
+        cgs::ecs::Entity entity;
+        bool woke;  ///< Dormant on the previous Execute.
+    };
+    std::vector<AwakeAgent> awake_;  ///< Agents found this tick.
+    uint32_t lodFrame_ = 1;          ///< Stamp for AIBrain::lodFrame.
+    uint32_t lastAwakeCount_ = 0;
+
+    /// behaviorTree root -> compiled tree (which keeps the root alive).
+    std::unordered_map<const BTNode*, std::shared_ptr<const CompiledBehaviorTree>> compiled_;
 };
 
 }  // namespace cgs::game
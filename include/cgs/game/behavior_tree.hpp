@@ -8,18 +8,31 @@
 /// (Inverter, Repeater), and leaf nodes (Condition, Action) form a tree
 /// that is ticked each AI update to drive entity behavior.
 ///
+/// Nodes describe their shape through Kind() / ChildCount() / Child(),
+/// which CompiledBehaviorTree uses to flatten a tree into a node array.
+/// Blackboard entries are addressed by interned BlackboardKey ids; the
+/// string-keyed API remains for setup and tooling.
+///
 /// @see SRS-GML-004.2, SRS-GML-004.3
 /// @see SDS-MOD-023
 
 #include "cgs/ecs/entity.hpp"
+#include "cgs/ecs/small_vector.hpp"
 #include "cgs/game/ai_types.hpp"
 
 #include <any>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <new>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace cgs::game {
@@ -27,54 +40,270 @@ namespace cgs::game {
 // Forward declaration.
 struct BTContext;
 
+/// Concrete node type reported by BTNode::Kind().
+enum class BTNodeKind : uint8_t {
+    Custom,  ///< Node type defined outside this header.
+    Sequence,
+    Selector,
+    Parallel,
+    Inverter,
+    Repeater,
+    Condition,
+    Action
+};
+
 // ═══════════════════════════════════════════════════════════════════════════
 // Blackboard
 // ═══════════════════════════════════════════════════════════════════════════
 
+/// Interned blackboard key name.
+using BlackboardKeyId = uint32_t;
+
+/// Sentinel value meaning "no key".
+constexpr BlackboardKeyId kInvalidBlackboardKey = static_cast<BlackboardKeyId>(-1);
+
+namespace detail {
+
+/// Process-wide table mapping blackboard key names to dense ids.
+///
+/// Interning takes a lock and hashes the name, so it belongs in key
+/// construction (typically a namespace-scope `static const`), not in
+/// per-tick code.
+class BlackboardKeyRegistry {
+public:
+    static BlackboardKeyRegistry& Instance() {
+        static BlackboardKeyRegistry registry;
+        return registry;
+    }
+
+    /// Id for @p name, assigning the next one on first use.
+    BlackboardKeyId Intern(const std::string& name) {
+        std::lock_guard lock(mutex_);
+        auto [it, inserted] = ids_.try_emplace(name, static_cast<BlackboardKeyId>(names_.size()));
+        if (inserted) {
+            names_.push_back(&it->first);
+        }
+        return it->second;
+    }
+
+    /// Id for @p name, or kInvalidBlackboardKey if it was never interned.
+    [[nodiscard]] BlackboardKeyId Find(const std::string& name) const {
+        std::lock_guard lock(mutex_);
+        auto it = ids_.find(name);
+        return it == ids_.end() ? kInvalidBlackboardKey : it->second;
+    }
+
+    /// Name of @p id (empty for unknown ids).
+    [[nodiscard]] std::string Name(BlackboardKeyId id) const {
+        std::lock_guard lock(mutex_);
+        return id < names_.size() ? *names_[id] : std::string();
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, BlackboardKeyId> ids_;
+    std::vector<const std::string*> names_;  ///< Node keys of ids_, by id.
+};
+
+/// Small dense id per value type stored on a Blackboard.
+inline uint32_t nextBlackboardTypeId() noexcept {
+    static std::atomic<uint32_t> counter{0};
+    return counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <typename T>
+uint32_t blackboardTypeId() noexcept {
+    static const uint32_t value = nextBlackboardTypeId();
+    return value;
+}
+
+}  // namespace detail
+
+/// Interned, typed blackboard key.
+///
+/// Construct once and reuse; lookups through it compare ids only:
+/// @code
+///   static const BlackboardKey<cgs::ecs::Entity> kTarget("target");
+///   auto* target = ctx.blackboard->Get(kTarget);
+/// @endcode
+/// A key and the string API address the same entry.
+template <typename T>
+struct BlackboardKey {
+    explicit BlackboardKey(const std::string& name)
+        : id(detail::BlackboardKeyRegistry::Instance().Intern(name)) {}
+
+    BlackboardKeyId id;
+};
+
 /// Key-value store for sharing data between BT nodes.
 ///
 /// Each AIBrain holds its own Blackboard instance.  Common keys:
 /// "target" (Entity), "move_target" (Vector3), "waypoints" (vector<Vector3>).
+///
+/// Entries are a small array of typed slots searched by interned key id.
+/// Trivially copyable values of up to 16 bytes (Entity, Vector3, scalars)
+/// live in the slot itself, and the first kInlineSlots entries live in
+/// the Blackboard, so the common case allocates nothing.  Other types are
+/// held in a std::any.  The std::string overloads intern or look up the
+/// name on every call and are meant for setup and tooling; BT leaves
+/// should use BlackboardKey.
+///
+/// Pointers returned by Get() remain valid until an entry is added,
+/// erased or re-typed.
 class Blackboard {
 public:
+    /// Entries stored without a heap allocation.
+    static constexpr std::size_t kInlineSlots = 6;
+
+    // -- Interned keys ------------------------------------------------------
+
+    /// Store a value under the given key (overwrites any existing value).
+    template <typename T>
+    void Set(const BlackboardKey<T>& key, std::type_identity_t<T> value) {
+        store<T>(key.id, std::move(value));
+    }
+
+    /// Mutable pointer to the stored value, or nullptr if the key is
+    /// absent or holds another type.
+    template <typename T>
+    T* Get(const BlackboardKey<T>& key) {
+        return load<T>(key.id);
+    }
+
+    template <typename T>
+    const T* Get(const BlackboardKey<T>& key) const {
+        return const_cast<Blackboard*>(this)->load<T>(key.id);
+    }
+
+    template <typename T>
+    [[nodiscard]] bool Has(const BlackboardKey<T>& key) const {
+        return find(key.id) != nullptr;
+    }
+
+    template <typename T>
+    void Erase(const BlackboardKey<T>& key) {
+        erase(key.id);
+    }
+
+    // -- String keys (slow path) --------------------------------------------
+
     /// Store a value under the given key (overwrites any existing value).
     template <typename T>
     void Set(const std::string& key, T value) {
-        data_[key] = std::move(value);
+        store<T>(detail::BlackboardKeyRegistry::Instance().Intern(key), std::move(value));
     }
 
     /// Retrieve a mutable pointer to the stored value, or nullptr if
     /// the key is absent or the type does not match.
     template <typename T>
     T* Get(const std::string& key) {
-        auto it = data_.find(key);
-        if (it == data_.end()) {
-            return nullptr;
-        }
-        return std::any_cast<T>(&it->second);
+        return load<T>(detail::BlackboardKeyRegistry::Instance().Find(key));
     }
 
     /// Retrieve a const pointer to the stored value.
     template <typename T>
     const T* Get(const std::string& key) const {
-        auto it = data_.find(key);
-        if (it == data_.end()) {
-            return nullptr;
-        }
-        return std::any_cast<T>(&it->second);
+        return const_cast<Blackboard*>(this)->load<T>(
+            detail::BlackboardKeyRegistry::Instance().Find(key));
     }
 
     /// Check whether a key exists in the blackboard.
-    [[nodiscard]] bool Has(const std::string& key) const { return data_.contains(key); }
+    [[nodiscard]] bool Has(const std::string& key) const {
+        return find(detail::BlackboardKeyRegistry::Instance().Find(key)) != nullptr;
+    }
 
     /// Remove a single entry.
-    void Erase(const std::string& key) { data_.erase(key); }
+    void Erase(const std::string& key) { erase(detail::BlackboardKeyRegistry::Instance().Find(key)); }
+
+    /// Names of every stored key (for debugging and tooling).
+    [[nodiscard]] std::vector<std::string> Keys() const {
+        std::vector<std::string> names;
+        names.reserve(slots_.size());
+        for (const auto& slot : slots_) {
+            names.push_back(detail::BlackboardKeyRegistry::Instance().Name(slot.key));
+        }
+        return names;
+    }
+
+    // -- Whole board --------------------------------------------------------
 
     /// Remove all entries.
-    void Clear() { data_.clear(); }
+    void Clear() { slots_.clear(); }
+
+    /// Number of stored entries.
+    [[nodiscard]] std::size_t Size() const noexcept { return slots_.size(); }
+
+    /// True while every entry is stored in the Blackboard itself.
+    [[nodiscard]] bool IsInline() const noexcept { return slots_.IsInline(); }
 
 private:
-    std::unordered_map<std::string, std::any> data_;
+    static constexpr std::size_t kInlineBytes = 16;
+
+    struct Slot {
+        BlackboardKeyId key = kInvalidBlackboardKey;
+        uint32_t type = 0;
+        alignas(8) std::byte bytes[kInlineBytes] = {};
+        std::any boxed;  ///< Set only for types that do not fit bytes.
+    };
+
+    template <typename T>
+    static constexpr bool kFitsInline = std::is_trivially_copyable_v<T> &&
+                                        sizeof(T) <= kInlineBytes && alignof(T) <= 8;
+
+    [[nodiscard]] const Slot* find(BlackboardKeyId key) const noexcept {
+        for (const auto& slot : slots_) {
+            if (slot.key == key) {
+                return &slot;
+            }
+        }
+        return nullptr;
+    }
+
+    [[nodiscard]] Slot* find(BlackboardKeyId key) noexcept {
+        return const_cast<Slot*>(std::as_const(*this).find(key));
+    }
+
+    template <typename T>
+    void store(BlackboardKeyId key, T value) {
+        Slot* slot = find(key);
+        if (!slot) {
+            slot = &slots_.emplace_back();
+            slot->key = key;
+        }
+        slot->type = detail::blackboardTypeId<T>();
+        if constexpr (kFitsInline<T>) {
+            slot->boxed.reset();
+            std::memcpy(slot->bytes, &value, sizeof(T));
+        } else {
+            slot->boxed = std::move(value);
+        }
+    }
+
+    template <typename T>
+    T* load(BlackboardKeyId key) noexcept {
+        Slot* slot = find(key);
+        if (!slot || slot->type != detail::blackboardTypeId<T>()) {
+            return nullptr;
+        }
+        if constexpr (kFitsInline<T>) {
+            return std::launder(reinterpret_cast<T*>(slot->bytes));
+        } else {
+            return std::any_cast<T>(&slot->boxed);
+        }
+    }
+
+    void erase(BlackboardKeyId key) {
+        Slot* slot = find(key);
+        if (!slot) {
+            return;
+        }
+        if (slot != &slots_.back()) {
+            *slot = std::move(slots_.back());
+        }
+        slots_.pop_back();
+    }
+
+    cgs::ecs::SmallVector<Slot, kInlineSlots> slots_;
 };
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -102,6 +331,17 @@ public:
 
     /// Reset node state (called when parent interrupts/restarts).
     virtual void Reset() {}
+
+    // -- Introspection ------------------------------------------------------
+
+    /// Node type (Custom for node classes defined outside this header).
+    [[nodiscard]] virtual BTNodeKind Kind() const { return BTNodeKind::Custom; }
+
+    /// Number of child nodes.
+    [[nodiscard]] virtual std::size_t ChildCount() const { return 0; }
+
+    /// Child node at @p index, or nullptr when out of range.
+    [[nodiscard]] virtual BTNode* Child(std::size_t /*index*/) const { return nullptr; }
 };
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -139,7 +379,11 @@ public:
         }
     }
 
-    [[nodiscard]] std::size_t ChildCount() const { return children_.size(); }
+    [[nodiscard]] BTNodeKind Kind() const override { return BTNodeKind::Sequence; }
+    [[nodiscard]] std::size_t ChildCount() const override { return children_.size(); }
+    [[nodiscard]] BTNode* Child(std::size_t index) const override {
+        return index < children_.size() ? children_[index].get() : nullptr;
+    }
 
 private:
     std::vector<std::unique_ptr<BTNode>> children_;
@@ -177,7 +421,11 @@ public:
         }
     }
 
-    [[nodiscard]] std::size_t ChildCount() const { return children_.size(); }
+    [[nodiscard]] BTNodeKind Kind() const override { return BTNodeKind::Selector; }
+    [[nodiscard]] std::size_t ChildCount() const override { return children_.size(); }
+    [[nodiscard]] BTNode* Child(std::size_t index) const override {
+        return index < children_.size() ? children_[index].get() : nullptr;
+    }
 
 private:
     std::vector<std::unique_ptr<BTNode>> children_;
@@ -233,7 +481,11 @@ public:
         }
     }
 
-    [[nodiscard]] std::size_t ChildCount() const { return children_.size(); }
+    [[nodiscard]] BTNodeKind Kind() const override { return BTNodeKind::Parallel; }
+    [[nodiscard]] std::size_t ChildCount() const override { return children_.size(); }
+    [[nodiscard]] BTNode* Child(std::size_t index) const override {
+        return index < children_.size() ? children_[index].get() : nullptr;
+    }
     [[nodiscard]] BTParallelPolicy GetPolicy() const { return policy_; }
 
 private:
@@ -264,6 +516,12 @@ public:
 
     void Reset() override { child_->Reset(); }
 
+    [[nodiscard]] BTNodeKind Kind() const override { return BTNodeKind::Inverter; }
+    [[nodiscard]] std::size_t ChildCount() const override { return 1; }
+    [[nodiscard]] BTNode* Child(std::size_t index) const override {
+        return index == 0 ? child_.get() : nullptr;
+    }
+
 private:
     std::unique_ptr<BTNode> child_;
 };
@@ -302,6 +560,12 @@ public:
 
     [[nodiscard]] uint32_t MaxRepeats() const { return maxRepeats_; }
 
+    [[nodiscard]] BTNodeKind Kind() const override { return BTNodeKind::Repeater; }
+    [[nodiscard]] std::size_t ChildCount() const override { return 1; }
+    [[nodiscard]] BTNode* Child(std::size_t index) const override {
+        return index == 0 ? child_.get() : nullptr;
+    }
+
 private:
     std::unique_ptr<BTNode> child_;
     uint32_t maxRepeats_ = 0;
@@ -325,6 +589,9 @@ public:
         return predicate_(context) ? BTStatus::Success : BTStatus::Failure;
     }
 
+    [[nodiscard]] BTNodeKind Kind() const override { return BTNodeKind::Condition; }
+    [[nodiscard]] const Predicate& GetPredicate() const noexcept { return predicate_; }
+
 private:
     Predicate predicate_;
 };
@@ -340,6 +607,9 @@ public:
 
     BTStatus Tick(BTContext& context) override { return action_(context); }
 
+    [[nodiscard]] BTNodeKind Kind() const override { return BTNodeKind::Action; }
+    [[nodiscard]] const ActionFunc& GetAction() const noexcept { return action_; }
+
 private:
     ActionFunc action_;
 };
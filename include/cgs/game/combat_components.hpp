@@ -1,7 +1,8 @@
 #pragma once
 
 /// @file combat_components.hpp
-/// @brief Combat ECS components: SpellCast, AuraHolder, DamageEvent, ThreatList.
+/// @brief Combat ECS components: SpellCast, AbilityCooldowns, AuraHolder,
+///        DamageEvent, ThreatList.
 ///
 /// Each struct is a plain data component for sparse-set storage via
 /// ComponentStorage<T>.  The CombatSystem operates on these components
@@ -11,11 +12,14 @@
 /// @see SDS-MOD-021
 
 #include "cgs/ecs/entity.hpp"
+#include "cgs/ecs/small_vector.hpp"
 #include "cgs/game/combat_types.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
-#include <vector>
+#include <unordered_map>
 
 namespace cgs::game {
 
@@ -59,6 +63,65 @@ struct SpellCast {
     }
 };
 
+// ── AbilityCooldowns ────────────────────────────────────────────────────
+
+/// Cooldowns of one entity's ability slots, plus its global cooldown.
+///
+/// Slot timers are kept as parallel arrays indexed by slot, so the
+/// CombatSystem steps all of an entity's slots with a few SIMD ops, and
+/// coolingSlots answers "is this slot ready" with one bit test.  An
+/// ability press checks the global cooldown first: during a rotation it
+/// is running most of the time and rejects the press without touching
+/// the slot arrays.  Entities with nothing cooling down are skipped.
+struct AbilityCooldowns {
+    static_assert(kAbilitySlots % 4 == 0 && kAbilitySlots <= 32);
+
+    alignas(16) std::array<float, kAbilitySlots> remaining{};  ///< Seconds left (0 = ready).
+    std::array<float, kAbilitySlots> duration{};  ///< Length of each slot's last cooldown.
+    float globalRemaining = 0.0f;                 ///< Global cooldown left (seconds).
+    uint32_t coolingSlots = 0;                    ///< Bit per slot with remaining > 0.
+
+    /// Whether @p slot can be used now, global cooldown included.
+    [[nodiscard]] bool IsReady(std::size_t slot) const noexcept {
+        return globalRemaining <= 0.0f && IsSlotReady(slot);
+    }
+
+    /// Whether @p slot's own cooldown has run out (off-GCD abilities).
+    [[nodiscard]] bool IsSlotReady(std::size_t slot) const noexcept {
+        return ((coolingSlots >> slot) & 1u) == 0;
+    }
+
+    /// True while nothing is cooling down.
+    [[nodiscard]] bool IsIdle() const noexcept {
+        return coolingSlots == 0 && globalRemaining <= 0.0f;
+    }
+
+    [[nodiscard]] float Remaining(std::size_t slot) const noexcept { return remaining[slot]; }
+
+    /// Put @p slot on cooldown for @p seconds (clears it when <= 0).
+    void Start(std::size_t slot, float seconds) noexcept {
+        remaining[slot] = std::max(seconds, 0.0f);
+        duration[slot] = remaining[slot];
+        const uint32_t bit = uint32_t{1} << slot;
+        coolingSlots = seconds > 0.0f ? coolingSlots | bit : coolingSlots & ~bit;
+    }
+
+    /// Start the global cooldown; a longer one already running is kept.
+    void StartGlobal(float seconds) noexcept {
+        globalRemaining = std::max(globalRemaining, seconds);
+    }
+
+    /// Make @p slot ready immediately (e.g. a cooldown reset proc).
+    void Clear(std::size_t slot) noexcept { Start(slot, 0.0f); }
+
+    /// Make every slot and the global cooldown ready.
+    void ClearAll() noexcept {
+        remaining.fill(0.0f);
+        globalRemaining = 0.0f;
+        coolingSlots = 0;
+    }
+};
+
 // ── AuraHolder (SRS-GML-002.2) ──────────────────────────────────────────
 
 /// A single active aura (buff or debuff) on an entity.
@@ -76,9 +139,12 @@ struct AuraInstance {
 
 /// Collection of active auras on an entity.
 ///
-/// Provides helpers for adding, removing, and stacking auras.
+/// Provides helpers for adding, removing, and stacking auras.  The first
+/// kInlineAuras auras are stored inside the component itself.
 struct AuraHolder {
-    std::vector<AuraInstance> auras;
+    static constexpr std::size_t kInlineAuras = 4;
+
+    cgs::ecs::SmallVector<AuraInstance, kInlineAuras> auras;
 
     /// Add a new aura or stack onto an existing one (same auraId + caster).
     ///
@@ -99,12 +165,12 @@ struct AuraHolder {
 
     /// Remove all auras with the given ID.
     void RemoveById(uint32_t auraId) {
-        std::erase_if(auras, [auraId](const AuraInstance& a) { return a.auraId == auraId; });
+        cgs::ecs::erase_if(auras, [auraId](const AuraInstance& a) { return a.auraId == auraId; });
     }
 
     /// Remove expired auras (remainingTime <= 0).
     void RemoveExpired() {
-        std::erase_if(auras, [](const AuraInstance& a) { return a.remainingTime <= 0.0f; });
+        cgs::ecs::erase_if(auras, [](const AuraInstance& a) { return a.remainingTime <= 0.0f; });
     }
 
     /// Check if the entity has an aura with the given ID.
@@ -151,28 +217,81 @@ struct ThreatEntry {
     float threat = 0.0f;
 };
 
-/// Ordered list of threat sources for AI targeting.
+/// Threat sources for AI targeting, kept as an indexed max-heap.
 ///
-/// The entity with the highest threat is the current target.
+/// The entity with the highest threat is the current target and sits at
+/// entries.front(); the remaining entries are in heap order, not sorted.
+/// AddThreat() and Remove() are O(log n).  Sources are located by linear
+/// scan while the list fits in the kInlineEntries inline slots, and
+/// through a source -> heap position index once it grows past them.
 struct ThreatList {
-    std::vector<ThreatEntry> entries;
+    static constexpr std::size_t kInlineEntries = 8;
 
-    /// Add or increase threat from a source.
+    cgs::ecs::SmallVector<ThreatEntry, kInlineEntries> entries;
+
+    /// Add or increase threat from a source (negative @p amount lowers it).
     void AddThreat(cgs::ecs::Entity source, float amount) {
-        for (auto& e : entries) {
-            if (e.source == source) {
-                e.threat += amount;
-                sortDescending();
-                return;
+        const std::size_t pos = find(source);
+        if (pos == kNotFound) {
+            entries.push_back({source, amount});
+            if (!index_.empty()) {
+                index_[source.raw] = static_cast<uint32_t>(entries.size() - 1);
+            } else if (entries.size() > kInlineEntries) {
+                buildIndex();
             }
+            siftUp(entries.size() - 1);
+            return;
+        }
+        entries[pos].threat += amount;
+        if (amount >= 0.0f) {
+            siftUp(pos);
+        } else {
+            siftDown(pos);
         }
-        entries.push_back({source, amount});
-        sortDescending();
     }
 
     /// Remove a source from the threat list.
     void Remove(cgs::ecs::Entity source) {
-        std::erase_if(entries, [source](const ThreatEntry& e) { return e.source == source; });
+        const std::size_t pos = find(source);
+        if (pos == kNotFound) {
+            return;
+        }
+        const std::size_t last = entries.size() - 1;
+        if (pos != last) {
+            moveEntry(last, pos);
+        }
+        entries.pop_back();
+        if (!index_.empty()) {
+            index_.erase(source.raw);
+        }
+        if (pos < entries.size()) {
+            siftUp(pos);
+            siftDown(pos);
+        }
+    }
+
+    /// Multiply every source's threat by @p factor (0 < factor, e.g.
+    /// 0.9 per second out of combat) and drop sources left at or below
+    /// @p dropAtOrBelow.  Order is kept, so no reheap is needed unless
+    /// sources are dropped.
+    void Decay(float factor, float dropAtOrBelow = 0.0f) {
+        for (auto& e : entries) {
+            e.threat *= factor;
+        }
+        const auto dropped = cgs::ecs::erase_if(entries, [dropAtOrBelow](const ThreatEntry& e) {
+            return e.threat <= dropAtOrBelow;
+        });
+        if (dropped != 0) {
+            rebuild();
+        }
+    }
+
+    /// Reset every source's threat to zero, keeping the sources listed
+    /// (a boss "threat wipe").
+    void Wipe() {
+        for (auto& e : entries) {
+            e.threat = 0.0f;
+        }
     }
 
     /// Get the entity with the highest threat (top aggro).
@@ -185,23 +304,105 @@ struct ThreatList {
 
     /// Get total threat from a specific source.
     [[nodiscard]] float GetThreat(cgs::ecs::Entity source) const {
-        for (const auto& e : entries) {
-            if (e.source == source) {
-                return e.threat;
-            }
-        }
-        return 0.0f;
+        const std::size_t pos = find(source);
+        return pos == kNotFound ? 0.0f : entries[pos].threat;
     }
 
+    /// Number of threat sources.
+    [[nodiscard]] std::size_t Size() const noexcept { return entries.size(); }
+
     /// Clear all threat entries.
-    void Clear() { entries.clear(); }
+    void Clear() {
+        entries.clear();
+        index_.clear();
+    }
 
 private:
-    void sortDescending() {
-        std::sort(entries.begin(), entries.end(), [](const ThreatEntry& a, const ThreatEntry& b) {
-            return a.threat > b.threat;
+    static constexpr std::size_t kNotFound = SIZE_MAX;
+
+    [[nodiscard]] std::size_t find(cgs::ecs::Entity source) const {
+        if (!index_.empty()) {
+            const auto it = index_.find(source.raw);
+            return it == index_.end() ? kNotFound : it->second;
+        }
+        for (std::size_t i = 0; i < entries.size(); ++i) {
+            if (entries[i].source == source) {
+                return i;
+            }
+        }
+        return kNotFound;
+    }
+
+    /// Move entries[from] to entries[to], keeping the index in step.
+    void moveEntry(std::size_t from, std::size_t to) {
+        entries[to] = entries[from];
+        if (!index_.empty()) {
+            index_[entries[to].source.raw] = static_cast<uint32_t>(to);
+        }
+    }
+
+    void siftUp(std::size_t pos) {
+        const ThreatEntry entry = entries[pos];
+        while (pos > 0) {
+            const std::size_t parent = (pos - 1) / 2;
+            if (!(entries[parent].threat < entry.threat)) {
+                break;
+            }
+            moveEntry(parent, pos);
+            pos = parent;
+        }
+        place(entry, pos);
+    }
+
+    void siftDown(std::size_t pos) {
+        const ThreatEntry entry = entries[pos];
+        const std::size_t size = entries.size();
+        while (true) {
+            std::size_t child = 2 * pos + 1;
+            if (child >= size) {
+                break;
+            }
+            if (child + 1 < size && entries[child].threat < entries[child + 1].threat) {
+                ++child;
+            }
+            if (!(entry.threat < entries[child].threat)) {
+                break;
+            }
+            moveEntry(child, pos);
+            pos = child;
+        }
+        place(entry, pos);
+    }
+
+    void place(const ThreatEntry& entry, std::size_t pos) {
+        entries[pos] = entry;
+        if (!index_.empty()) {
+            index_[entry.source.raw] = static_cast<uint32_t>(pos);
+        }
+    }
+
+    /// Re-establish heap order and the index after bulk edits.
+    void rebuild() {
+        std::make_heap(entries.begin(), entries.end(), [](const ThreatEntry& a,
+                                                           const ThreatEntry& b) {
+            return a.threat < b.threat;
         });
+        index_.clear();
+        if (entries.size() > kInlineEntries) {
+            buildIndex();
+        }
     }
+
+    void buildIndex() {
+        index_.reserve(entries.size() * 2);
+        for (std::size_t i = 0; i < entries.size(); ++i) {
+            index_[entries[i].source.raw] = static_cast<uint32_t>(i);
+        }
+    }
+
+    /// Source Entity::raw -> position in entries; empty while the list
+    /// fits inline.
+    std::unordered_map<cgs::ecs::Entity::Raw, uint32_t> index_;
 };
 
 }  // namespace cgs::game
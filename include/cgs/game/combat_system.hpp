@@ -10,11 +10,18 @@
 /// @see SDS-MOD-021
 
 #include "cgs/ecs/component_storage.hpp"
+#include "cgs/ecs/event_channel.hpp"
 #include "cgs/ecs/system_scheduler.hpp"
 #include "cgs/game/combat_components.hpp"
+#include "cgs/game/inventory_components.hpp"
 #include "cgs/game/components.hpp"
+#include "cgs/game/timer_wheel.hpp"
 
+#include <cstdint>
+#include <span>
 #include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace cgs::game {
 
@@ -39,12 +46,62 @@ struct DamageCalcParams {
     static constexpr float kCritMultiplier = 2.0f;
 };
 
+/// Damage events in structure-of-arrays form for
+/// CombatSystem::CalculateDamageBatch().  Row @c i of every array belongs
+/// to the same hit.
+struct DamageBatch {
+    std::vector<int32_t> baseDamage;
+    std::vector<float> critMultiplier;      ///< kCritMultiplier or 1.
+    std::vector<int32_t> mitigationStat;    ///< Armor (Physical) or the type's resistance.
+    std::vector<float> mitigationConstant;  ///< kArmorConstant or kResistanceConstant.
+    std::vector<int32_t> finalDamage;       ///< Output, one per row.
+
+    /// Append a hit, resolving its mitigation stat from @p params.
+    void Add(int32_t base, DamageType type, bool isCritical, const DamageCalcParams& params);
+
+    void Clear() noexcept;
+
+    [[nodiscard]] std::size_t Size() const noexcept { return baseDamage.size(); }
+};
+
+/// A cast that completed this tick, for damage resolution.
+struct CastCompletion {
+    cgs::ecs::Entity caster;
+    cgs::ecs::Entity target;
+    uint32_t spellId = 0;
+};
+
+/// One ability press for CombatSystem::UseAbility().
+struct AbilityUse {
+    uint32_t slot = 0;  ///< AbilityCooldowns slot of the ability.
+    uint32_t spellId = 0;
+    cgs::ecs::Entity target;
+    float castTime = 0.0f;
+    float cooldown = 0.0f;        ///< Slot cooldown, started with the cast.
+    float globalCooldown = 0.0f;  ///< 0 for abilities off the global cooldown.
+};
+
 /// System that processes combat logic each tick.
 ///
 /// Execution order within a single tick:
-///   1. Update spell cast timers (Casting → Complete)
+///   1. Update spell cast timers (Casting → Complete) and ability cooldowns
 ///   2. Tick auras (duration, periodic effects)
 ///   3. Process damage events (mitigation pipeline → Stats update → Threat)
+///
+/// Damage events arrive as DamageEvent components and, once a channel is
+/// attached with SetDamageChannel(), as a batch read from that channel.
+/// Both are resolved together as one batch per tick: hits are ordered by
+/// victim, each victim's mitigation stats are read once, the mitigation
+/// math runs over a DamageBatch with SIMD (SSE2/NEON), and each victim's
+/// health is updated once.  Threat is added per hit in arrival order.
+///
+/// Step 1 gathers the remaining times of the active casts into one array,
+/// decrements them four at a time (SSE2/NEON) and reports the casts that
+/// finished as a CastCompletion batch (CastCompletions()).
+///
+/// With SetTimerWheel(true), steps 1 and 2 instead advance a TimerWheel
+/// and handle only the casts and auras whose timers come due; cooldowns
+/// are still stepped every tick.
 class CombatSystem final : public cgs::ecs::ISystem {
 public:
     CombatSystem(cgs::ecs::ComponentStorage<SpellCast>& spellCasts,
@@ -63,6 +120,68 @@ public:
 
     [[nodiscard]] cgs::ecs::SystemAccessInfo GetAccessInfo() const override;
 
+    /// Also consume the damage events published on @p channel each tick
+    /// (nullptr to detach).  Attach before SystemScheduler::Build() so
+    /// the read is declared.  The channel must outlive its attachment.
+    void SetDamageChannel(cgs::ecs::EventChannel<DamageEvent>* channel) noexcept {
+        damageChannel_ = channel;
+    }
+
+    /// Add each victim's cached EquipmentStats to its mitigation stats
+    /// (nullptr to detach): attribute i of the bonuses adds to Stats
+    /// attribute i, and StatBonuses::armor adds to armor as well.
+    /// Attach before SystemScheduler::Build() so the read is declared.
+    void SetEquipmentStats(const cgs::ecs::ComponentStorage<EquipmentStats>* stats) noexcept {
+        equipmentStats_ = stats;
+    }
+
+    // -- Cooldowns ---------------------------------------------------------
+
+    /// Step the AbilityCooldowns in @p cooldowns each tick and check them
+    /// in UseAbility() (nullptr to detach).  Attach before
+    /// SystemScheduler::Build() so the write is declared.
+    void SetCooldowns(cgs::ecs::ComponentStorage<AbilityCooldowns>* cooldowns) noexcept {
+        cooldowns_ = cooldowns;
+    }
+
+    /// Start an ability: check its cooldowns (the global one first),
+    /// BeginCast() it and start its slot and global cooldowns.  A caster
+    /// without AbilityCooldowns is never on cooldown.
+    AbilityUseResult UseAbility(cgs::ecs::Entity caster, const AbilityUse& use);
+
+    /// Casts completed by the last Execute(), in completion order.
+    [[nodiscard]] std::span<const CastCompletion> CastCompletions() const noexcept {
+        return castCompletions_;
+    }
+
+    // -- Timer wheel -------------------------------------------------------
+
+    /// Drive cast completion, aura expiry and periodic aura ticks from a
+    /// TimerWheel instead of stepping every SpellCast and AuraInstance
+    /// each tick, so Execute() only visits the effects that come due.
+    ///
+    /// While enabled, casts and auras must be started through BeginCast()
+    /// and ApplyAura(); ones written straight into the components are
+    /// not seen.  SpellCast::remainingTime and AuraInstance::remainingTime
+    /// / tickTimer are brought up to date only when the effect's timer
+    /// fires.  Toggling drops every scheduled timer.
+    void SetTimerWheel(bool enabled);
+
+    [[nodiscard]] bool TimerWheelEnabled() const noexcept { return useTimerWheel_; }
+
+    /// SpellCast::Begin() on @p caster, scheduling its completion when
+    /// the timer wheel is enabled.
+    /// @return false if @p caster has no SpellCast.
+    bool BeginCast(cgs::ecs::Entity caster,
+                   uint32_t spellId,
+                   cgs::ecs::Entity target,
+                   float castTime);
+
+    /// AuraHolder::AddOrStack() on @p target, (re)scheduling the aura's
+    /// expiry and next periodic tick when the timer wheel is enabled.
+    /// @return false if @p target has no AuraHolder.
+    bool ApplyAura(cgs::ecs::Entity target, const AuraInstance& aura);
+
     /// Calculate final damage after mitigation.
     ///
     /// This is a pure function exposed for testability.
@@ -71,21 +190,104 @@ public:
                                                  bool isCritical,
                                                  const DamageCalcParams& params);
 
+    /// CalculateDamage() for every row of @p batch, written to
+    /// batch.finalDamage.  Four rows at a time on SSE2/NEON targets;
+    /// results match CalculateDamage() exactly.
+    static void CalculateDamageBatch(DamageBatch& batch);
+
 private:
     /// Update spell cast timers.
     void updateSpellCasts(float deltaTime);
 
+    /// Step every AbilityCooldowns that has something cooling down.
+    void updateCooldowns(float deltaTime);
+
+    /// Flip @p cast to Complete and report it.
+    void completeCast(uint32_t casterId, SpellCast& cast);
+
     /// Tick aura durations and periodic effects.
     void updateAuras(float deltaTime);
 
     /// Process pending damage events.
     void processDamageEvents();
 
+    /// Queue @p event for this tick's batch; @p eventEntity is its
+    /// DamageEvent component's entity id, or kNoEventEntity.
+    void queueHit(const DamageEvent& event, uint32_t eventEntity);
+
+    static constexpr uint32_t kNoEventEntity = UINT32_MAX;
+
+    /// Identity of one aura instance: AuraHolder::AddOrStack() stacks
+    /// per (auraId, caster).
+    struct AuraKey {
+        uint32_t target = 0;
+        uint32_t auraId = 0;
+        uint32_t caster = 0;
+
+        bool operator==(const AuraKey&) const = default;
+    };
+
+    struct AuraKeyHash {
+        std::size_t operator()(const AuraKey& key) const noexcept {
+            const uint64_t bits = (static_cast<uint64_t>(key.target) << 32) ^
+                                  (static_cast<uint64_t>(key.auraId) << 16) ^ key.caster;
+            return static_cast<std::size_t>(bits * 0x9E37'79B9'7F4A'7C15ull);
+        }
+    };
+
+    /// Wheel-side state of one aura, in absolute wheel ticks.
+    struct AuraTimer {
+        AuraKey key;
+        uint64_t expiresAt = 0;
+        uint64_t nextTickAt = kNoTick;
+        TimerId timer;
+    };
+
+    static constexpr uint64_t kNoTick = UINT64_MAX;
+
+    /// Timer payloads with this bit set complete the caster's SpellCast;
+    /// the others index auraTimers_.
+    static constexpr uint64_t kCastTimerBit = uint64_t{1} << 63;
+
+    /// Dispatch one fired wheel timer.
+    void onTimer(uint64_t payload);
+
+    /// Fire due periodic ticks and the expiry of auraTimers_[index].
+    void onAuraTimer(uint32_t index);
+
+    /// Schedule auraTimers_[index] for its next tick or expiry.
+    void scheduleAura(uint32_t index);
+
+    void releaseAuraTimer(uint32_t index);
+
     cgs::ecs::ComponentStorage<SpellCast>& spellCasts_;
     cgs::ecs::ComponentStorage<AuraHolder>& auraHolders_;
     cgs::ecs::ComponentStorage<DamageEvent>& damageEvents_;
     cgs::ecs::ComponentStorage<Stats>& stats_;
     cgs::ecs::ComponentStorage<ThreatList>& threatLists_;
+    const cgs::ecs::ComponentStorage<EquipmentStats>* equipmentStats_ = nullptr;
+    cgs::ecs::ComponentStorage<AbilityCooldowns>* cooldowns_ = nullptr;
+    cgs::ecs::EventChannel<DamageEvent>* damageChannel_ = nullptr;
+
+    // processDamageEvents() scratch, reused across ticks.
+    std::vector<const DamageEvent*> hits_;
+    std::vector<uint32_t> hitEventEntities_;  ///< Parallel to hits_.
+    std::vector<uint64_t> hitOrder_;          ///< (victim id << 32) | hit index.
+    DamageBatch batch_;                       ///< Rows in hitOrder_ order.
+
+    // updateSpellCasts() scratch: dense rows of the active casts and
+    // their remaining times, stepped as one array.
+    std::vector<uint32_t> castRows_;
+    std::vector<float> castTimes_;
+    std::vector<CastCompletion> castCompletions_;
+
+    // Timer wheel mode state.
+    bool useTimerWheel_ = false;
+    TimerWheel timers_;
+    std::unordered_map<uint32_t, TimerId> castTimers_;  ///< Caster id -> completion.
+    std::vector<AuraTimer> auraTimers_;
+    std::vector<uint32_t> freeAuraTimers_;
+    std::unordered_map<AuraKey, uint32_t, AuraKeyHash> auraTimerIndex_;
 };
 
 }  // namespace cgs::game
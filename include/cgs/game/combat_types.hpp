@@ -16,6 +16,9 @@ constexpr std::size_t kMaxAuras = 32;
 /// Maximum stacks for a single aura instance.
 constexpr int32_t kMaxAuraStacks = 99;
 
+/// Ability slots per entity in AbilityCooldowns (action bar size).
+constexpr std::size_t kAbilitySlots = 16;
+
 /// Spell-casting state machine.
 enum class CastState : uint8_t {
     Idle,        ///< Not casting anything.
@@ -39,4 +42,14 @@ enum class DamageType : uint8_t {
 /// Number of distinct damage types (for array sizing).
 constexpr std::size_t kDamageTypeCount = 7;
 
+/// Outcome of CombatSystem::UseAbility().
+enum class AbilityUseResult : uint8_t {
+    Started,           ///< Cast begun, cooldowns started.
+    OnGlobalCooldown,  ///< The global cooldown is still running.
+    OnCooldown,        ///< The ability's own slot is still cooling down.
+    Busy,              ///< The caster is already casting or channeling.
+    InvalidSlot,       ///< Slot is not below kAbilitySlots.
+    NoCaster           ///< The caster has no SpellCast component.
+};
+
 }  // namespace cgs::game
@@ -0,0 +1,119 @@
+#pragma once
+
+/// @file compiled_behavior_tree.hpp
+/// @brief Flattened, data-oriented behavior tree runtime.
+///
+/// CompiledBehaviorTree turns a BTNode tree into one contiguous array of
+/// BTFlatNode records in pre-order: a node's first child follows it
+/// directly and each child's `end` is the index of its next sibling.
+/// Composites dispatch on a per-node opcode instead of a virtual call.
+/// Condition and Action callables are copied into handler tables once
+/// at compile time and invoked by index.
+///
+/// Running state (Sequence/Selector cursors, Repeater counts) is kept
+/// per agent in a caller-owned slot array rather than inside the nodes.
+/// One compiled tree can therefore drive any number of agents, each with
+/// its own progress, and TickBatch() runs every agent that shares a tree
+/// back to back while its nodes stay in cache.
+///
+/// @see SRS-GML-004.2, SRS-GML-004.3
+/// @see SDS-MOD-023
+
+#include "cgs/game/ai_types.hpp"
+#include "cgs/game/behavior_tree.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace cgs::game {
+
+/// Operation of one flattened node.
+enum class BTOpcode : uint8_t {
+    Sequence,
+    Selector,
+    ParallelAll,  ///< BTParallel with RequireAll.
+    ParallelOne,  ///< BTParallel with RequireOne.
+    Inverter,
+    Repeater,
+    Condition,  ///< Calls predicate `param`.
+    Action,     ///< Calls action `param`.
+    Custom,     ///< Ticks custom node `param` (a BTNodeKind::Custom node) in place.
+};
+
+/// One node of a CompiledBehaviorTree.
+struct BTFlatNode {
+    BTOpcode op = BTOpcode::Action;
+    uint32_t end = 0;         ///< One past the last node of this subtree.
+    uint32_t stateBegin = 0;  ///< First state slot of this subtree (own slot, if any).
+    uint32_t stateEnd = 0;    ///< One past the last state slot of this subtree.
+    /// Condition/Action/Custom: table index.  Repeater: maxRepeats.
+    /// Composites: child count.
+    uint32_t param = 0;
+};
+
+/// One agent for CompiledBehaviorTree::TickBatch().
+struct BTAgent {
+    BTContext context;
+    std::span<uint32_t> state;  ///< CompiledBehaviorTree::StateSize() slots.
+    BTStatus status = BTStatus::Failure;  ///< Output.
+};
+
+/// Immutable, flattened behavior tree shared by every agent running it.
+///
+/// Ticks with the same results as the BTNode tree it was compiled from,
+/// except that each agent's running state is its own.  Nodes of types
+/// defined outside behavior_tree.hpp are ticked in place and keep their
+/// internal state shared, as before.
+class CompiledBehaviorTree {
+public:
+    /// Flatten the tree rooted at @p root.  The tree is kept alive for
+    /// its custom nodes; the built-in nodes are no longer consulted.
+    [[nodiscard]] static std::shared_ptr<const CompiledBehaviorTree> Compile(
+        std::shared_ptr<BTNode> root);
+
+    /// Tick the tree for one agent.  @p state must hold StateSize() slots,
+    /// zero-initialized before the agent's first tick.
+    BTStatus Tick(BTContext& context, std::span<uint32_t> state) const;
+
+    /// Tick every agent in @p agents, storing each result in its status.
+    void TickBatch(std::span<BTAgent> agents) const;
+
+    /// Reset an agent's progress, like BTNode::Reset() on the root.
+    void Reset(std::span<uint32_t> state) const;
+
+    /// State slots each agent needs.
+    [[nodiscard]] std::size_t StateSize() const noexcept { return stateSize_; }
+
+    [[nodiscard]] std::span<const BTFlatNode> Nodes() const noexcept { return nodes_; }
+
+    /// The tree this was compiled from.
+    [[nodiscard]] const std::shared_ptr<BTNode>& Source() const noexcept { return root_; }
+
+    /// Conditions plus actions in the handler tables.
+    [[nodiscard]] std::size_t HandlerCount() const noexcept {
+        return predicates_.size() + actions_.size();
+    }
+
+private:
+    CompiledBehaviorTree() = default;
+
+    /// Append @p node's subtree in pre-order.
+    void flatten(BTNode& node);
+
+    BTStatus tick(uint32_t index, BTContext& context, std::span<uint32_t> state) const;
+
+    /// Reset the subtree rooted at node @p index.
+    void resetSubtree(uint32_t index, std::span<uint32_t> state) const;
+
+    std::vector<BTFlatNode> nodes_;
+    std::vector<BTCondition::Predicate> predicates_;
+    std::vector<BTAction::ActionFunc> actions_;
+    std::vector<BTNode*> customNodes_;
+    std::size_t stateSize_ = 0;
+    std::shared_ptr<BTNode> root_;  ///< Owns customNodes_.
+};
+
+}  // namespace cgs::game
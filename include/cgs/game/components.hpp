@@ -7,9 +7,15 @@
 /// via ComponentStorage<T>.  Components are kept small and focused on a
 /// single concern to maximize cache utilization during system iteration.
 ///
+/// Transform and Movement are also registered with CGS_SERIALIZABLE so
+/// they can opt into the column-wise SoAComponentStorage<T> layout; Vector3
+/// and Quaternion are registered so those fields nest in the compact form.
+///
 /// @see SRS-GML-001.1 .. SRS-GML-001.4
 /// @see SDS-MOD-020
 
+#include "cgs/foundation/game_serializer.hpp"
+#include "cgs/foundation/interned_string.hpp"
 #include "cgs/game/math_types.hpp"
 #include "cgs/game/object_types.hpp"
 
@@ -48,10 +54,11 @@ inline GUID GenerateGUID() noexcept {
 constexpr GUID kInvalidGUID = 0;
 
 /// Object identity: globally unique ID, display name, classification,
-/// and template entry ID.
+/// and template entry ID.  The name is interned, so the component stays
+/// small and copies of it share the text.
 struct Identity {
     GUID guid = kInvalidGUID;
-    std::string name;
+    cgs::foundation::InternedString name;
     ObjectType type = ObjectType::GameObject;
     uint32_t entry = 0;  ///< Template / prototype ID.
 };
@@ -99,3 +106,27 @@ struct Movement {
 };
 
 }  // namespace cgs::game
+
+// ── Field registration (SoA layout / serialization) ─────────────────────
+
+CGS_SERIALIZABLE(cgs::game::Vector3, 1,
+                 field("x", &cgs::game::Vector3::x),
+                 field("y", &cgs::game::Vector3::y),
+                 field("z", &cgs::game::Vector3::z));
+
+CGS_SERIALIZABLE(cgs::game::Quaternion, 1,
+                 field("w", &cgs::game::Quaternion::w),
+                 field("x", &cgs::game::Quaternion::x),
+                 field("y", &cgs::game::Quaternion::y),
+                 field("z", &cgs::game::Quaternion::z));
+
+CGS_SERIALIZABLE(cgs::game::Transform, 1,
+                 field("position", &cgs::game::Transform::position),
+                 field("rotation", &cgs::game::Transform::rotation),
+                 field("scale", &cgs::game::Transform::scale));
+
+CGS_SERIALIZABLE(cgs::game::Movement, 1,
+                 field("speed", &cgs::game::Movement::speed),
+                 field("baseSpeed", &cgs::game::Movement::baseSpeed),
+                 field("direction", &cgs::game::Movement::direction),
+                 field("state", &cgs::game::Movement::state));
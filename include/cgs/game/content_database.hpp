@@ -0,0 +1,126 @@
+#pragma once
+
+/// @file content_database.hpp
+/// @brief Immutable, validated snapshot of item and quest templates.
+///
+/// A ContentDatabase bundles one version of every template database the
+/// game systems read.  It is built and validated off the tick thread and
+/// never changes afterwards; a reload builds a new one and the systems
+/// are pointed at it between ticks (see cgs::plugin::ContentReloader).
+/// Items() and Quests() hand out pointers that share ownership of the
+/// whole database, so a version stays alive exactly as long as some
+/// system still holds one of them, and a template pointer obtained
+/// during a tick stays valid until the tick ends even if a newer version
+/// is published meanwhile.
+///
+/// @see SRS-GML-006.1, SRS-GML-005.1
+
+#include "cgs/foundation/error_code.hpp"
+#include "cgs/foundation/game_result.hpp"
+#include "cgs/game/inventory_components.hpp"
+#include "cgs/game/quest_components.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cgs::game {
+
+/// One version of the static game content.
+///
+/// Usage:
+/// @code
+///   auto built = ContentDatabase::Build(version, std::move(items), std::move(quests));
+///   if (built.hasError()) { /* keep the running version */ }
+///   inventory.SetTemplates(built.value()->Items());
+///   quests.SetTemplates(built.value()->Quests());
+/// @endcode
+class ContentDatabase : public std::enable_shared_from_this<ContentDatabase> {
+public:
+    /// Build and validate a database from @p items and @p quests.
+    ///
+    /// Fails with InvalidArgument, naming the first offending template,
+    /// if a template has id 0, an item has a zero stack size, a quest has
+    /// an objective requiring less than one, or a quest refers to a
+    /// prerequisite, chain successor or reward item that is not defined.
+    /// Duplicate ids resolve as in TemplateDatabase::Build().
+    [[nodiscard]] static cgs::foundation::GameResult<std::shared_ptr<const ContentDatabase>> Build(
+        uint64_t version, std::vector<ItemTemplate> items, std::vector<QuestTemplate> quests) {
+        using cgs::foundation::ErrorCode;
+        using cgs::foundation::GameError;
+        using Result = cgs::foundation::GameResult<std::shared_ptr<const ContentDatabase>>;
+
+        auto itemDb = ItemTemplateDatabase::Build(std::move(items));
+        auto questDb = QuestTemplateDatabase::Build(std::move(quests));
+        auto fail = [](const char* kind, uint32_t id, const std::string& reason) {
+            return Result::err(GameError(ErrorCode::InvalidArgument,
+                                         std::string(kind) + " " + std::to_string(id) + ": " +
+                                             reason));
+        };
+
+        for (const auto& item : *itemDb) {
+            if (item.id == 0) {
+                return fail("item", item.id, "id 0 is reserved");
+            }
+            if (item.maxStackSize == 0) {
+                return fail("item", item.id, "maxStackSize must be at least 1");
+            }
+        }
+        for (const auto& quest : *questDb) {
+            if (quest.id == 0) {
+                return fail("quest", quest.id, "id 0 is reserved");
+            }
+            for (uint32_t prerequisite : quest.prerequisites) {
+                if (!questDb->Contains(prerequisite)) {
+                    return fail("quest", quest.id,
+                                "unknown prerequisite " + std::to_string(prerequisite));
+                }
+            }
+            if (quest.chainNext && !questDb->Contains(*quest.chainNext)) {
+                return fail("quest", quest.id,
+                            "unknown chain successor " + std::to_string(*quest.chainNext));
+            }
+            for (const auto& objective : quest.objectives) {
+                if (objective.required < 1) {
+                    return fail("quest", quest.id, "objective requires less than one");
+                }
+            }
+            for (const auto& [itemId, count] : quest.rewards.items) {
+                if (!itemDb->Contains(itemId) || count == 0) {
+                    return fail("quest", quest.id,
+                                "invalid reward item " + std::to_string(itemId));
+                }
+            }
+        }
+
+        return Result::ok(std::shared_ptr<const ContentDatabase>(
+            new ContentDatabase(version, std::move(itemDb), std::move(questDb))));
+    }
+
+    /// Version this database was built as; the reloader numbers builds
+    /// from 1.
+    [[nodiscard]] uint64_t Version() const noexcept { return version_; }
+
+    /// Item templates (never null), keeping this database alive.
+    [[nodiscard]] std::shared_ptr<const ItemTemplateDatabase> Items() const {
+        return {shared_from_this(), items_.get()};
+    }
+
+    /// Quest templates (never null), keeping this database alive.
+    [[nodiscard]] std::shared_ptr<const QuestTemplateDatabase> Quests() const {
+        return {shared_from_this(), quests_.get()};
+    }
+
+private:
+    ContentDatabase(uint64_t version,
+                    std::shared_ptr<const ItemTemplateDatabase> items,
+                    std::shared_ptr<const QuestTemplateDatabase> quests)
+        : version_(version), items_(std::move(items)), quests_(std::move(quests)) {}
+
+    uint64_t version_;
+    std::shared_ptr<const ItemTemplateDatabase> items_;
+    std::shared_ptr<const QuestTemplateDatabase> quests_;
+};
+
+}  // namespace cgs::game
@@ -11,14 +11,21 @@
 /// @see SDS-MOD-035
 
 #include "cgs/ecs/entity.hpp"
+#include "cgs/foundation/interned_string.hpp"
+#include "cgs/ecs/small_vector.hpp"
 #include "cgs/game/inventory_types.hpp"
 #include "cgs/game/object_types.hpp"
+#include "cgs/game/template_database.hpp"
 
 #include <algorithm>
 #include <array>
+#include <bit>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
+#include <span>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace cgs::game {
@@ -58,6 +65,19 @@ struct StatBonuses {
         maxDamage += other.maxDamage;
         return *this;
     }
+
+    StatBonuses& operator-=(const StatBonuses& other) {
+        for (std::size_t i = 0; i < kMaxAttributes; ++i) {
+            attributes[i] -= other.attributes[i];
+        }
+        armor -= other.armor;
+        attackSpeed -= other.attackSpeed;
+        minDamage -= other.minDamage;
+        maxDamage -= other.maxDamage;
+        return *this;
+    }
+
+    bool operator==(const StatBonuses&) const = default;
 };
 
 // -- Enchant ------------------------------------------------------------------
@@ -67,17 +87,22 @@ struct Enchant {
     uint32_t enchantId = 0;
     StatBonuses bonuses;
     std::optional<float> durationRemaining;  ///< nullopt = permanent.
+    uint32_t timerTag = 0;                   ///< InventorySystem timer wheel tag (0 = none).
 };
 
 // -- InventorySlot ------------------------------------------------------------
 
 /// A single slot in inventory or equipment.
+///
+/// The first kInlineEnchants enchantment is stored inside the slot.
 struct InventorySlot {
+    static constexpr std::size_t kInlineEnchants = 1;
+
     uint32_t itemId = 0;  ///< 0 = empty slot.
     uint32_t count = 0;
     int32_t durability = kIndestructible;
     int32_t maxDurability = kIndestructible;
-    std::vector<Enchant> enchants;
+    cgs::ecs::SmallVector<Enchant, kInlineEnchants> enchants;
 
     /// Check if this slot is empty.
     [[nodiscard]] bool IsEmpty() const noexcept { return itemId == 0; }
@@ -116,7 +141,7 @@ struct InventorySlot {
 
     /// Remove expired enchantments.
     void RemoveExpiredEnchants() {
-        std::erase_if(enchants, [](const Enchant& e) {
+        cgs::ecs::erase_if(enchants, [](const Enchant& e) {
             return e.durationRemaining.has_value() && *e.durationRemaining <= 0.0f;
         });
     }
@@ -127,7 +152,7 @@ struct InventorySlot {
 /// Static item definition data (shared, not per-entity).
 struct ItemTemplate {
     uint32_t id = 0;
-    std::string name;
+    cgs::foundation::InternedString name;
     ItemType type = ItemType::Miscellaneous;
     ItemQuality quality = ItemQuality::Common;
     uint32_t maxStackSize = 1;  ///< 1 = non-stackable.
@@ -144,19 +169,51 @@ struct ItemTemplate {
     [[nodiscard]] bool IsEquippable() const noexcept { return equipSlot != EquipSlot::COUNT; }
 };
 
+/// Id-indexed item templates, built once from content at load time.
+using ItemTemplateDatabase = TemplateDatabase<ItemTemplate>;
+
+/// Bonuses @p slot contributes when equipped: its template's plus its
+/// enchants', or nothing when the slot is empty or broken.
+[[nodiscard]] inline StatBonuses EquippedBonuses(const InventorySlot& slot,
+                                                 const ItemTemplateDatabase& templates) {
+    StatBonuses total;
+    if (slot.IsEmpty() || slot.IsBroken()) {
+        return total;
+    }
+    if (const ItemTemplate* tmpl = templates.Find(slot.itemId)) {
+        total += tmpl->statBonuses;
+    }
+    total += slot.GetEnchantBonuses();
+    return total;
+}
+
 // -- Inventory (SRS-GML-006.1) ------------------------------------------------
 
 /// Per-entity item storage component.
 ///
 /// Provides bag-style inventory with configurable capacity, stacking,
-/// splitting, and item management operations.
+/// splitting, and item management operations.  An inventory of up to the
+/// default capacity keeps its slots inside the component.
+///
+/// AddItem() and SplitStack() do not scan the slots.  A small index keeps
+/// the slots that may have stack space per item id (a flat, sorted
+/// {itemId, slot} list) and a bitmap of empty slots; both preserve the
+/// lowest-slot-first placement of a scan.  The member functions keep the
+/// index in step; after writing `slots` directly, call Reindex().
 struct Inventory {
-    std::vector<InventorySlot> slots;
+    cgs::ecs::SmallVector<InventorySlot, kDefaultInventoryCapacity> slots;
     uint32_t capacity = kDefaultInventoryCapacity;
     int64_t currency = 0;
 
     /// Initialize slots to match capacity.
-    void Initialize() { slots.resize(capacity); }
+    void Initialize() {
+        slots.resize(capacity);
+        Reindex();
+    }
+
+    /// Drop the slot index; it is rebuilt on next use.  Call after
+    /// modifying `slots` other than through these member functions.
+    void Reindex() noexcept { indexed_ = false; }
 
     /// Add an item to the inventory using stacking rules.
     ///
@@ -170,41 +227,64 @@ struct Inventory {
         if (slots.empty()) {
             Initialize();
         }
+        ensureIndex();
         uint32_t remaining = addCount;
 
-        // First pass: stack onto existing slots.
-        if (tmpl.IsStackable()) {
-            for (auto& slot : slots) {
-                if (remaining == 0) {
-                    break;
-                }
-                if (slot.itemId == tmpl.id && slot.count < tmpl.maxStackSize) {
-                    uint32_t space = tmpl.maxStackSize - slot.count;
-                    uint32_t toAdd = std::min(remaining, space);
-                    slot.count += toAdd;
-                    remaining -= toAdd;
-                }
-            }
-        }
+        // First pass: stack onto existing slots.  For a non-stackable item
+        // this only drops its slots from the stack list.
+        remaining = fillStacks(tmpl, remaining);
 
         // Second pass: fill empty slots.
-        for (auto& slot : slots) {
-            if (remaining == 0) {
+        while (remaining != 0) {
+            const uint32_t i = takeEmptySlot();
+            if (i == kNoSlot) {
                 break;
             }
-            if (slot.IsEmpty()) {
-                uint32_t toAdd = tmpl.IsStackable() ? std::min(remaining, tmpl.maxStackSize) : 1;
-                slot.itemId = tmpl.id;
-                slot.count = toAdd;
-                slot.durability = tmpl.maxDurability;
-                slot.maxDurability = tmpl.maxDurability;
-                remaining -= toAdd;
+            auto& slot = slots[i];
+            uint32_t toAdd = tmpl.IsStackable() ? std::min(remaining, tmpl.maxStackSize) : 1;
+            slot.itemId = tmpl.id;
+            slot.count = toAdd;
+            slot.durability = tmpl.maxDurability;
+            slot.maxDurability = tmpl.maxDurability;
+            remaining -= toAdd;
+            if (tmpl.IsStackable() && toAdd < tmpl.maxStackSize) {
+                addStack(tmpl.id, i);
             }
         }
 
         return addCount - remaining;
     }
 
+    /// Add @p addCount of item @p itemId, looking its template up in
+    /// @p templates.
+    /// @return Number of items actually added (0 for an unknown item).
+    uint32_t AddItem(const ItemTemplateDatabase& templates, uint32_t itemId, uint32_t addCount) {
+        const ItemTemplate* tmpl = templates.Find(itemId);
+        return tmpl ? AddItem(*tmpl, addCount) : 0;
+    }
+
+    /// Add a batch of {itemId, count} pairs in order, e.g. one loot roll
+    /// or QuestReward::items.  Entries that do not fit are skipped; later
+    /// ones may still top up existing stacks.
+    ///
+    /// @param added  When not empty, receives the count added per entry;
+    ///               must be as long as @p items.
+    /// @return Total number of items added.
+    uint32_t AddItems(const ItemTemplateDatabase& templates,
+                      std::span<const std::pair<uint32_t, uint32_t>> items,
+                      std::span<uint32_t> added = {}) {
+        uint32_t total = 0;
+        for (std::size_t k = 0; k < items.size(); ++k) {
+            const auto [itemId, count] = items[k];
+            const uint32_t n = AddItem(templates, itemId, count);
+            if (!added.empty()) {
+                added[k] = n;
+            }
+            total += n;
+        }
+        return total;
+    }
+
     /// Remove items from a specific slot.
     ///
     /// @return true if the removal was successful.
@@ -216,11 +296,33 @@ struct Inventory {
         if (slot.IsEmpty() || slot.count < removeCount) {
             return false;
         }
+        if (removeCount == 0) {
+            return true;
+        }
 
+        ensureIndex();
+        unlinkSlot(slotIndex);
         slot.count -= removeCount;
         if (slot.count == 0) {
             slot.Clear();
         }
+        linkSlot(slotIndex);
+        return true;
+    }
+
+    /// Exchange the contents of two slots.
+    ///
+    /// @return true if both indices are valid and distinct.
+    bool SwapSlots(uint32_t a, uint32_t b) {
+        if (a >= slots.size() || b >= slots.size() || a == b) {
+            return false;
+        }
+        ensureIndex();
+        unlinkSlot(a);
+        unlinkSlot(b);
+        std::swap(slots[a], slots[b]);
+        linkSlot(a);
+        linkSlot(b);
         return true;
     }
 
@@ -237,24 +339,13 @@ struct Inventory {
         if (fromSlot == toSlot) {
             return false;
         }
-
-        auto& src = slots[fromSlot];
-        auto& dst = slots[toSlot];
-
-        if (src.IsEmpty()) {
+        if (slots[fromSlot].IsEmpty()) {
             return false;
         }
 
-        // Stack merge if same item type.
-        if (dst.itemId == src.itemId && !dst.IsEmpty()) {
-            // Caller must know max stack size externally for proper merge.
-            // For now, swap if they can't trivially merge.
-            std::swap(src, dst);
-            return true;
-        }
-
-        std::swap(src, dst);
-        return true;
+        // Caller must know max stack size externally for a proper merge of
+        // the same item type, so both cases swap for now.
+        return SwapSlots(fromSlot, toSlot);
     }
 
     /// Split a stack into a new slot.
@@ -266,23 +357,26 @@ struct Inventory {
         if (slotIndex >= slots.size()) {
             return std::nullopt;
         }
-        auto& src = slots[slotIndex];
-        if (src.IsEmpty() || src.count <= splitCount || splitCount == 0) {
+        if (slots[slotIndex].IsEmpty() || slots[slotIndex].count <= splitCount ||
+            splitCount == 0) {
             return std::nullopt;
         }
 
-        // Find an empty slot.
-        for (uint32_t i = 0; i < static_cast<uint32_t>(slots.size()); ++i) {
-            if (slots[i].IsEmpty()) {
-                slots[i].itemId = src.itemId;
-                slots[i].count = splitCount;
-                slots[i].durability = src.durability;
-                slots[i].maxDurability = src.maxDurability;
-                src.count -= splitCount;
-                return i;
-            }
+        ensureIndex();
+        const uint32_t i = takeEmptySlot();
+        if (i == kNoSlot) {
+            return std::nullopt;
         }
-        return std::nullopt;
+        auto& src = slots[slotIndex];
+        slots[i].itemId = src.itemId;
+        slots[i].count = splitCount;
+        slots[i].durability = src.durability;
+        slots[i].maxDurability = src.maxDurability;
+        src.count -= splitCount;
+        // Both halves now have room (the source may have been full).
+        addStack(src.itemId, slotIndex);
+        addStack(src.itemId, i);
+        return i;
     }
 
     /// Get a pointer to the slot at the given index.
@@ -324,6 +418,110 @@ struct Inventory {
         }
         return total;
     }
+
+private:
+    static constexpr uint32_t kNoSlot = UINT32_MAX;
+    static constexpr std::size_t kInlineStacks = 8;
+
+    /// A slot that may have stack space left for its item.
+    struct StackRef {
+        uint32_t itemId;
+        uint32_t slot;
+
+        auto operator<=>(const StackRef&) const = default;
+    };
+
+    void ensureIndex() {
+        if (indexed_ && indexedSlots_ == slots.size()) {
+            return;
+        }
+        stacks_.clear();
+        emptyBits_.clear();
+        emptyBits_.resize((slots.size() + 63) / 64, 0);
+        for (uint32_t i = 0; i < static_cast<uint32_t>(slots.size()); ++i) {
+            linkSlot(i);
+        }
+        indexedSlots_ = slots.size();
+        indexed_ = true;
+    }
+
+    /// Record slot @p i in the index as it currently is.  Occupied slots
+    /// are listed as stack candidates; AddItem() drops the full ones.
+    void linkSlot(uint32_t i) {
+        if (slots[i].IsEmpty()) {
+            emptyBits_[i / 64] |= uint64_t{1} << (i % 64);
+        } else {
+            addStack(slots[i].itemId, i);
+        }
+    }
+
+    /// Remove slot @p i from the index before it changes.
+    void unlinkSlot(uint32_t i) {
+        emptyBits_[i / 64] &= ~(uint64_t{1} << (i % 64));
+        const StackRef ref{slots[i].itemId, i};
+        const auto it = std::lower_bound(stacks_.begin(), stacks_.end(), ref);
+        if (it != stacks_.end() && *it == ref) {
+            stacks_.erase(it);
+        }
+    }
+
+    void addStack(uint32_t itemId, uint32_t i) {
+        const StackRef ref{itemId, i};
+        const auto it = std::lower_bound(stacks_.begin(), stacks_.end(), ref);
+        if (it != stacks_.end() && *it == ref) {
+            return;
+        }
+        const auto pos = it - stacks_.begin();
+        stacks_.push_back(ref);
+        std::rotate(stacks_.begin() + pos, stacks_.end() - 1, stacks_.end());
+    }
+
+    /// Top up the listed stacks of @p tmpl in slot order, dropping the
+    /// ones that are (or become) full.
+    /// @return Items still to place.
+    uint32_t fillStacks(const ItemTemplate& tmpl, uint32_t remaining) {
+        auto first = std::lower_bound(stacks_.begin(), stacks_.end(), StackRef{tmpl.id, 0});
+        auto out = first;
+        auto it = first;
+        for (; it != stacks_.end() && it->itemId == tmpl.id; ++it) {
+            auto& slot = slots[it->slot];
+            if (slot.itemId != tmpl.id) {
+                continue;  // written directly since indexed
+            }
+            if (remaining != 0 && slot.count < tmpl.maxStackSize) {
+                const uint32_t toAdd = std::min(remaining, tmpl.maxStackSize - slot.count);
+                slot.count += toAdd;
+                remaining -= toAdd;
+            }
+            if (slot.count < tmpl.maxStackSize) {
+                *out++ = *it;
+            }
+        }
+        stacks_.erase(out, it);
+        return remaining;
+    }
+
+    /// Claim the lowest empty slot, or kNoSlot when the bag is full.
+    uint32_t takeEmptySlot() {
+        for (std::size_t w = 0; w < emptyBits_.size(); ++w) {
+            while (emptyBits_[w] != 0) {
+                const auto bit = static_cast<uint32_t>(std::countr_zero(emptyBits_[w]));
+                emptyBits_[w] &= emptyBits_[w] - 1;
+                const auto i = static_cast<uint32_t>(w * 64) + bit;
+                if (slots[i].IsEmpty()) {
+                    return i;
+                }
+            }
+        }
+        return kNoSlot;
+    }
+
+    /// Stack candidates sorted by {itemId, slot}.
+    cgs::ecs::SmallVector<StackRef, kInlineStacks> stacks_;
+    /// One bit per slot, set while the slot is empty.
+    cgs::ecs::SmallVector<uint64_t, (kDefaultInventoryCapacity + 63) / 64> emptyBits_;
+    std::size_t indexedSlots_ = 0;
+    bool indexed_ = false;
 };
 
 // -- Equipment (SRS-GML-006.3) ------------------------------------------------
@@ -400,6 +598,29 @@ struct Equipment {
         }
         return total;
     }
+
+    /// Same as above with O(1) template lookups.
+    [[nodiscard]] StatBonuses CalculateStatBonuses(const ItemTemplateDatabase& templates) const {
+        StatBonuses total;
+        for (const auto& slot : slots) {
+            total += EquippedBonuses(slot, templates);
+        }
+        return total;
+    }
+};
+
+// -- EquipmentStats -----------------------------------------------------------
+
+/// Cached Equipment::CalculateStatBonuses() of an entity, kept by
+/// InventorySystem::SetEquipmentStats() and read by CombatSystem.
+///
+/// Changes made through InventorySystem (Equip(), Unequip(),
+/// ApplyEnchant(), enchant expiry, items breaking) are applied to
+/// `bonuses` as deltas at once; anything else marks the entity dirty
+/// and it is recomputed once at the end of the system's next tick.
+struct EquipmentStats {
+    StatBonuses bonuses;
+    bool dirty = true;  ///< Awaiting a full recompute.
 };
 
 // -- DurabilityEvent ----------------------------------------------------------
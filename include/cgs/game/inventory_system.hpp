@@ -9,9 +9,12 @@
 /// @see SDS-MOD-035
 
 #include "cgs/ecs/component_storage.hpp"
+#include "cgs/ecs/event_channel.hpp"
 #include "cgs/ecs/system_scheduler.hpp"
 #include "cgs/game/inventory_components.hpp"
+#include "cgs/game/timer_wheel.hpp"
 
+#include <memory>
 #include <string_view>
 #include <vector>
 
@@ -25,11 +28,21 @@ namespace cgs::game {
 ///
 /// Runs in PostUpdate stage so that combat damage events from the
 /// Update stage are available as DurabilityEvents.
+///
+/// With SetTimerWheel(true), step 2 instead advances a TimerWheel and
+/// removes only the enchants whose timers come due.
+///
+/// With SetEquipmentStats(), a final step 3 recomputes the EquipmentStats
+/// of the entities marked dirty since the last tick, and only those.
 class InventorySystem final : public cgs::ecs::ISystem {
 public:
     InventorySystem(cgs::ecs::ComponentStorage<Inventory>& inventories,
                     cgs::ecs::ComponentStorage<Equipment>& equipment,
                     cgs::ecs::ComponentStorage<DurabilityEvent>& durabilityEvents);
+    ~InventorySystem() override;
+
+    InventorySystem(const InventorySystem&) = delete;
+    InventorySystem& operator=(const InventorySystem&) = delete;
 
     void Execute(float deltaTime) override;
 
@@ -41,26 +54,147 @@ public:
 
     [[nodiscard]] cgs::ecs::SystemAccessInfo GetAccessInfo() const override;
 
-    /// Register an item template for lookup.
+    /// Also consume the durability events published on @p channel each
+    /// tick (nullptr to detach).  Attach before SystemScheduler::Build().
+    void SetDurabilityChannel(cgs::ecs::EventChannel<DurabilityEvent>* channel) noexcept {
+        durabilityChannel_ = channel;
+    }
+
+    // -- Timer wheel -------------------------------------------------------
+
+    /// Expire timed enchants from a TimerWheel instead of stepping every
+    /// enchant of every Inventory and Equipment slot each tick.
+    ///
+    /// While enabled, timed enchants must be added through ApplyEnchant();
+    /// ones written straight into a slot are not seen, and
+    /// Enchant::durationRemaining keeps its initial value until the
+    /// enchant is removed.  An enchant's timer follows its item between
+    /// the owner's Inventory and Equipment slots; an item handed to
+    /// another entity needs its enchant applied again.  Toggling drops
+    /// every scheduled timer.
+    void SetTimerWheel(bool enabled);
+
+    [[nodiscard]] bool TimerWheelEnabled() const noexcept { return useTimerWheel_; }
+
+    /// Add @p enchant to the item equipped in @p slot of @p entity,
+    /// scheduling its expiry when the timer wheel is enabled.
+    /// @return false if @p entity has no Equipment or the slot is empty.
+    bool ApplyEnchant(cgs::ecs::Entity entity, EquipSlot slot, Enchant enchant);
+
+    /// Add @p enchant to the item in inventory slot @p slotIndex of
+    /// @p entity, scheduling its expiry when the timer wheel is enabled.
+    /// @return false if @p entity has no Inventory or the slot is empty.
+    bool ApplyEnchant(cgs::ecs::Entity entity, uint32_t slotIndex, Enchant enchant);
+
+    // -- Equipment stats ---------------------------------------------------
+
+    /// Keep an EquipmentStats component in @p stats for every entity with
+    /// Equipment (nullptr to detach).  Attaching marks every Equipment
+    /// dirty, so the next Execute() fills the cache; Equipment added or
+    /// removed later is picked up through a storage listener.
+    void SetEquipmentStats(cgs::ecs::ComponentStorage<EquipmentStats>* stats);
+
+    /// Equipment::Equip() on @p entity, applying the stat delta.
+    /// @return The previously equipped item (empty if none or no Equipment).
+    InventorySlot Equip(cgs::ecs::Entity entity, EquipSlot slot, InventorySlot item);
+
+    /// Equipment::Unequip() on @p entity, applying the stat delta.
+    InventorySlot Unequip(cgs::ecs::Entity entity, EquipSlot slot);
+
+    /// Recompute @p entity's EquipmentStats at the end of the next tick.
+    /// Call after changing its Equipment directly.
+    void MarkStatsDirty(cgs::ecs::Entity entity);
+
+    /// Entities recomputed on the last Execute().
+    [[nodiscard]] std::size_t LastStatsRecomputeCount() const noexcept {
+        return lastStatsRecomputes_;
+    }
+
+    /// Share @p templates, the item template database built at load
+    /// time (nullptr clears it).  Lookups are O(1).
+    void SetTemplates(std::shared_ptr<const ItemTemplateDatabase> templates);
+
+    /// The template database in use (never null).
+    [[nodiscard]] const std::shared_ptr<const ItemTemplateDatabase>& GetTemplateDatabase() const
+        noexcept {
+        return templates_;
+    }
+
+    /// Register one item template, replacing any with the same id.
+    /// Copies the database (O(n)); load content through SetTemplates().
     void RegisterTemplate(ItemTemplate tmpl);
 
     /// Get a registered item template by ID.
-    [[nodiscard]] const ItemTemplate* GetTemplate(uint32_t templateId) const;
+    [[nodiscard]] const ItemTemplate* GetTemplate(uint32_t templateId) const {
+        return templates_->Find(templateId);
+    }
 
     /// Get all registered templates (for stat bonus calculation).
-    [[nodiscard]] const std::vector<ItemTemplate>& GetTemplates() const { return templates_; }
+    [[nodiscard]] const std::vector<ItemTemplate>& GetTemplates() const {
+        return templates_->All();
+    }
 
 private:
     /// Process pending durability events.
     void processDurabilityEvents();
 
+    /// Wear the equipment slot named by @p event.
+    void applyDurability(const DurabilityEvent& event);
+
     /// Tick enchant durations on equipped items and inventory items.
     void updateEnchants(float deltaTime);
 
+    /// Add @p enchant to @p slot, tagging and scheduling it in timer
+    /// wheel mode.
+    void attachEnchant(cgs::ecs::Entity entity, InventorySlot& slot, Enchant enchant);
+
+    /// Remove the enchant named by a fired timer's payload
+    /// ((entity id << 32) | timer tag).
+    void expireEnchant(uint64_t payload);
+
+    /// Add @p added minus @p removed to @p entity's cached bonuses, or
+    /// mark it dirty if it has no up-to-date cache.
+    void applyStatDelta(cgs::ecs::Entity entity,
+                        const StatBonuses& added,
+                        const StatBonuses& removed);
+
+    /// Mark every Equipment dirty (templates changed, cache attached).
+    void markAllStatsDirty();
+
+    /// Recompute the EquipmentStats of dirtyStats_.
+    void refreshEquipmentStats();
+
     cgs::ecs::ComponentStorage<Inventory>& inventories_;
     cgs::ecs::ComponentStorage<Equipment>& equipment_;
     cgs::ecs::ComponentStorage<DurabilityEvent>& durabilityEvents_;
-    std::vector<ItemTemplate> templates_;
+    cgs::ecs::EventChannel<DurabilityEvent>* durabilityChannel_ = nullptr;
+    std::shared_ptr<const ItemTemplateDatabase> templates_ = ItemTemplateDatabase::Build({});
+
+    // Equipment stats cache state.
+    /// Queues Equipment added or removed while the cache is attached.
+    class EquipmentListener final : public cgs::ecs::IStorageListener {
+    public:
+        explicit EquipmentListener(InventorySystem& system) : system_(system) {}
+        void OnComponentAdded(cgs::ecs::Entity entity) override { system_.MarkStatsDirty(entity); }
+        void OnComponentRemoved(cgs::ecs::Entity entity) override {
+            system_.MarkStatsDirty(entity);
+        }
+        void OnStorageCleared() noexcept override { system_.equipmentCleared_ = true; }
+
+    private:
+        InventorySystem& system_;
+    };
+
+    cgs::ecs::ComponentStorage<EquipmentStats>* equipmentStats_ = nullptr;
+    EquipmentListener equipmentListener_{*this};
+    bool equipmentCleared_ = false;
+    std::vector<cgs::ecs::Entity> dirtyStats_;
+    std::size_t lastStatsRecomputes_ = 0;
+
+    // Timer wheel mode state.
+    bool useTimerWheel_ = false;
+    TimerWheel timers_;
+    uint32_t lastEnchantTag_ = 0;
 };
 
 }  // namespace cgs::game
@@ -0,0 +1,223 @@
+#pragma once
+
+/// @file pathfinding.hpp
+/// @brief Grid navigation and an asynchronous per-map path service.
+///
+/// NavGrid is a walkability grid over a map's X/Z plane.  FindGridPath()
+/// runs A* over it (8-connected, octile costs, no corner cutting).
+///
+/// PathfindingService owns one map's grid and answers path requests on a
+/// later tick: Request() queues, Update() (once per tick) hands the
+/// queued misses to a job submitter -- typically a wrapper around
+/// GameJobScheduler::schedule() -- and collects finished searches, and
+/// Poll() returns them.  Paths are cached by (start cell, goal cell);
+/// requests sharing a goal cell (a pack chasing one target) are
+/// coalesced into one backward search; long paths are planned over a
+/// cluster graph first and refined inside the resulting corridor.
+///
+/// @see SRS-GML-004.3
+/// @see SDS-MOD-023
+
+#include "cgs/game/math_types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <unordered_map>
+#include <vector>
+
+namespace cgs::game {
+
+/// Cell of a NavGrid.
+struct NavCell {
+    int32_t x = 0;
+    int32_t y = 0;
+
+    constexpr bool operator==(const NavCell&) const = default;
+};
+
+/// Walkability grid of one map.  Cells start walkable.
+class NavGrid {
+public:
+    /// @p origin is the world position of cell (0, 0)'s minimum corner.
+    NavGrid(uint32_t width, uint32_t height, float cellSize = 1.0f, Vector3 origin = {});
+
+    [[nodiscard]] uint32_t Width() const noexcept { return width_; }
+    [[nodiscard]] uint32_t Height() const noexcept { return height_; }
+    [[nodiscard]] float CellSize() const noexcept { return cellSize_; }
+
+    [[nodiscard]] bool Contains(NavCell cell) const noexcept {
+        return cell.x >= 0 && cell.y >= 0 && static_cast<uint32_t>(cell.x) < width_ &&
+               static_cast<uint32_t>(cell.y) < height_;
+    }
+
+    /// False outside the grid.
+    [[nodiscard]] bool IsWalkable(NavCell cell) const noexcept {
+        return Contains(cell) && walkable_[IndexOf(cell)] != 0;
+    }
+
+    void SetWalkable(NavCell cell, bool walkable);
+
+    /// Mark every cell of the inclusive rectangle [min, max].
+    void SetWalkable(NavCell min, NavCell max, bool walkable);
+
+    /// Cell containing @p position (may lie outside the grid).
+    [[nodiscard]] NavCell CellOf(const Vector3& position) const noexcept;
+
+    /// World-space center of @p cell (y = origin.y).
+    [[nodiscard]] Vector3 CenterOf(NavCell cell) const noexcept;
+
+    [[nodiscard]] uint32_t IndexOf(NavCell cell) const noexcept {
+        return static_cast<uint32_t>(cell.y) * width_ + static_cast<uint32_t>(cell.x);
+    }
+
+    [[nodiscard]] NavCell CellAt(uint32_t index) const noexcept {
+        return {static_cast<int32_t>(index % width_), static_cast<int32_t>(index / width_)};
+    }
+
+    [[nodiscard]] std::size_t CellCount() const noexcept { return walkable_.size(); }
+
+private:
+    uint32_t width_;
+    uint32_t height_;
+    float cellSize_;
+    Vector3 origin_;
+    std::vector<uint8_t> walkable_;
+};
+
+/// A* from @p start to @p goal.  On success replaces @p out with the
+/// cells after @p start up to and including @p goal (empty when equal).
+bool FindGridPath(const NavGrid& grid, NavCell start, NavCell goal, std::vector<NavCell>& out);
+
+/// Handle of a PathfindingService request.
+struct PathRequestId {
+    uint64_t value = 0;
+
+    [[nodiscard]] constexpr bool IsValid() const noexcept { return value != 0; }
+    constexpr bool operator==(const PathRequestId&) const = default;
+};
+
+/// State of a path request.
+enum class PathStatus : uint8_t {
+    Unknown,   ///< Never issued, cancelled, or already consumed.
+    Pending,   ///< Queued or being searched.
+    Ready,     ///< Poll() copied the path out (request consumed).
+    NotFound,  ///< No walkable route (request consumed).
+};
+
+/// Asynchronous pathfinding for one map.  Not thread-safe: call it from
+/// the game thread; only the searches run on workers.
+class PathfindingService {
+public:
+    /// Dispatches one job; must eventually run it (on any thread).
+    using JobSubmitter = std::function<void(std::function<void()>)>;
+
+    /// Cells per side of a cluster of the hierarchical graph.
+    static constexpr uint32_t kClusterSize = 16;
+
+    /// Octile distance (in cells) beyond which searches go hierarchical.
+    static constexpr uint32_t kHierarchicalDistance = 2 * kClusterSize;
+
+    /// Default number of cached paths.
+    static constexpr std::size_t kDefaultCacheCapacity = 4096;
+
+    explicit PathfindingService(NavGrid grid, std::size_t cacheCapacity = kDefaultCacheCapacity);
+    ~PathfindingService();
+
+    PathfindingService(const PathfindingService&) = delete;
+    PathfindingService& operator=(const PathfindingService&) = delete;
+
+    /// Run searches through @p submitter; an empty one (the default)
+    /// runs them inside Update().  Results arrive at a later Update()
+    /// either way.
+    void SetJobSubmitter(JobSubmitter submitter) { submitter_ = std::move(submitter); }
+
+    /// Replace the grid.  Clears the cache; requests already dispatched
+    /// are searched again on the new grid.
+    void SetGrid(NavGrid grid);
+
+    [[nodiscard]] const NavGrid& Grid() const noexcept;
+
+    /// Queue a path from @p from to @p to.
+    PathRequestId Request(const Vector3& from, const Vector3& to);
+
+    /// Drop a request; its result is discarded when it arrives.
+    void Cancel(PathRequestId id);
+
+    /// Collect finished searches, then dispatch the queued requests
+    /// (cache hits complete here without a search).  Call once per tick.
+    void Update();
+
+    /// Status of @p id.  On Ready, @p out receives the waypoints (cell
+    /// centers at each turn, ending at the requested destination) and
+    /// the request is consumed; NotFound consumes it too.
+    PathStatus Poll(PathRequestId id, std::vector<Vector3>& out);
+
+    // -- Statistics ---------------------------------------------------------
+
+    /// Requests issued and not yet consumed or cancelled.
+    [[nodiscard]] std::size_t RequestCount() const noexcept { return requests_.size(); }
+    [[nodiscard]] std::size_t CacheSize() const noexcept { return cache_.size(); }
+    [[nodiscard]] uint64_t CacheHits() const noexcept { return cacheHits_; }
+    /// Requests answered by another request's search in the same batch.
+    [[nodiscard]] uint64_t CoalescedRequests() const noexcept { return coalesced_; }
+    /// Searches run: one per goal cell per batch.
+    [[nodiscard]] uint64_t SearchCount() const noexcept { return searches_; }
+
+private:
+    struct Snapshot;
+    struct Batch;
+    struct Shared;
+
+    struct Entry {
+        Vector3 origin;
+        Vector3 destination;
+        PathStatus status = PathStatus::Pending;
+        std::vector<Vector3> path;
+    };
+
+    /// Search result for one (start, goal) pair.
+    struct CachedPath {
+        bool found = false;
+        std::vector<uint32_t> cells;  ///< After start, up to and including goal.
+    };
+
+    static uint64_t cacheKey(uint32_t start, uint32_t goal) noexcept {
+        return (uint64_t{start} << 32) | goal;
+    }
+
+    /// Fill @p entry from @p result; @p start is the start cell index.
+    void complete(Entry& entry, uint32_t start, const CachedPath& result) const;
+
+    void insertCache(uint64_t key, CachedPath result);
+
+    /// Collect batches finished since the last Update().
+    void collect();
+
+    /// Dispatch the queued requests.
+    void dispatch();
+
+    std::shared_ptr<const Snapshot> snapshot_;
+    std::shared_ptr<Shared> shared_;  ///< Mailbox shared with running jobs.
+    JobSubmitter submitter_;
+
+    std::unordered_map<uint64_t, Entry> requests_;
+    std::vector<uint64_t> queued_;
+    /// (start, goal) key -> requests waiting on its search.
+    std::unordered_map<uint64_t, std::vector<uint64_t>> waiting_;
+    uint64_t nextId_ = 1;
+
+    /// (start, goal) key -> result; FIFO eviction past cacheCapacity_.
+    std::unordered_map<uint64_t, CachedPath> cache_;
+    std::vector<uint64_t> cacheOrder_;
+    std::size_t cacheHead_ = 0;
+    std::size_t cacheCapacity_;
+
+    uint64_t cacheHits_ = 0;
+    uint64_t coalesced_ = 0;
+    uint64_t searches_ = 0;
+};
+
+}  // namespace cgs::game
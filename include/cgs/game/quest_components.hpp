@@ -11,12 +11,16 @@
 /// @see SDS-MOD-034
 
 #include "cgs/ecs/entity.hpp"
+#include "cgs/ecs/small_vector.hpp"
 #include "cgs/game/quest_types.hpp"
+#include "cgs/game/template_database.hpp"
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -72,6 +76,9 @@ struct QuestTemplate {
     float timeLimitSeconds = 0.0f;  ///< Time limit (0 = no limit).
 };
 
+/// Id-indexed quest templates, built once from content at load time.
+using QuestTemplateDatabase = TemplateDatabase<QuestTemplate>;
+
 // -- QuestEntry ---------------------------------------------------------------
 
 /// A single active quest instance on a player.
@@ -116,9 +123,15 @@ struct QuestEntry {
 /// Per-player quest tracking component.
 ///
 /// Maintains active quests and a set of completed quest IDs for
-/// prerequisite checking and chain unlocking.
+/// prerequisite checking and chain unlocking.  The first kInlineQuests
+/// active quests are stored inside the component itself.  Quests are
+/// located by linear scan while they fit inline, and through a questId ->
+/// position index once the log grows past them; add and remove quests
+/// through the member functions so the index stays in step.
 struct QuestLog {
-    std::vector<QuestEntry> activeQuests;
+    static constexpr std::size_t kInlineQuests = 8;
+
+    cgs::ecs::SmallVector<QuestEntry, kInlineQuests> activeQuests;
     std::unordered_set<uint32_t> completedQuestIds;
     uint32_t maxActiveQuests = kMaxActiveQuests;
 
@@ -143,6 +156,11 @@ struct QuestLog {
         entry.objectives = tmpl.objectives;
         entry.timeLimit = tmpl.timeLimitSeconds;
         activeQuests.push_back(std::move(entry));
+        if (!index_.empty()) {
+            index_[tmpl.id] = static_cast<uint32_t>(activeQuests.size() - 1);
+        } else if (activeQuests.size() > kInlineQuests) {
+            rebuildIndex();
+        }
         return true;
     }
 
@@ -150,13 +168,17 @@ struct QuestLog {
     ///
     /// @return true if the quest was found and removed.
     bool Abandon(uint32_t questId) {
-        auto it = std::find_if(activeQuests.begin(),
-                               activeQuests.end(),
-                               [questId](const QuestEntry& e) { return e.questId == questId; });
-        if (it == activeQuests.end()) {
+        const std::size_t pos = find(questId);
+        if (pos == kNotFound) {
             return false;
         }
-        activeQuests.erase(it);
+        activeQuests.erase(activeQuests.begin() + static_cast<std::ptrdiff_t>(pos));
+        if (!index_.empty()) {
+            index_.erase(questId);
+            for (std::size_t i = pos; i < activeQuests.size(); ++i) {
+                index_[activeQuests[i].questId] = static_cast<uint32_t>(i);
+            }
+        }
         return true;
     }
 
@@ -175,30 +197,18 @@ struct QuestLog {
 
     /// Get an active quest entry by ID.
     [[nodiscard]] QuestEntry* GetQuest(uint32_t questId) {
-        for (auto& entry : activeQuests) {
-            if (entry.questId == questId) {
-                return &entry;
-            }
-        }
-        return nullptr;
+        const std::size_t pos = find(questId);
+        return pos == kNotFound ? nullptr : &activeQuests[pos];
     }
 
     /// Get an active quest entry by ID (const).
     [[nodiscard]] const QuestEntry* GetQuest(uint32_t questId) const {
-        for (const auto& entry : activeQuests) {
-            if (entry.questId == questId) {
-                return &entry;
-            }
-        }
-        return nullptr;
+        const std::size_t pos = find(questId);
+        return pos == kNotFound ? nullptr : &activeQuests[pos];
     }
 
     /// Check if a quest is currently active.
-    [[nodiscard]] bool HasQuest(uint32_t questId) const {
-        return std::any_of(activeQuests.begin(),
-                           activeQuests.end(),
-                           [questId](const QuestEntry& e) { return e.questId == questId; });
-    }
+    [[nodiscard]] bool HasQuest(uint32_t questId) const { return find(questId) != kNotFound; }
 
     /// Check if a quest has been completed (turned in) before.
     [[nodiscard]] bool IsCompleted(uint32_t questId) const {
@@ -220,10 +230,45 @@ struct QuestLog {
 
     /// Remove turned-in and failed quests from active list.
     void CleanupFinished() {
-        std::erase_if(activeQuests, [](const QuestEntry& e) {
+        const auto removed = cgs::ecs::erase_if(activeQuests, [](const QuestEntry& e) {
             return e.state == QuestState::TurnedIn || e.state == QuestState::Failed;
         });
+        if (removed != 0) {
+            rebuildIndex();
+        }
     }
+
+private:
+    static constexpr std::size_t kNotFound = SIZE_MAX;
+
+    [[nodiscard]] std::size_t find(uint32_t questId) const {
+        if (!index_.empty()) {
+            const auto it = index_.find(questId);
+            return it == index_.end() ? kNotFound : it->second;
+        }
+        for (std::size_t i = 0; i < activeQuests.size(); ++i) {
+            if (activeQuests[i].questId == questId) {
+                return i;
+            }
+        }
+        return kNotFound;
+    }
+
+    /// Index every active quest, or drop the index if they fit inline.
+    void rebuildIndex() {
+        index_.clear();
+        if (activeQuests.size() <= kInlineQuests) {
+            return;
+        }
+        index_.reserve(activeQuests.size() * 2);
+        for (std::size_t i = 0; i < activeQuests.size(); ++i) {
+            index_[activeQuests[i].questId] = static_cast<uint32_t>(i);
+        }
+    }
+
+    /// questId -> position in activeQuests; empty while the log fits
+    /// inline.
+    std::unordered_map<uint32_t, uint32_t> index_;
 };
 
 // -- QuestEvent ---------------------------------------------------------------
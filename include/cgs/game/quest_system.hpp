@@ -5,16 +5,23 @@
 ///
 /// Processes quest timers and incoming quest events each frame.
 /// Integrates with Kill/Collect/Explore/Interact events from other systems
-/// through the QuestEvent component (same pattern as DamageEvent).
+/// through the QuestEvent component (same pattern as DamageEvent) or an
+/// attached EventChannel<QuestEvent>.
 ///
 /// @see SRS-GML-005.4
 /// @see SDS-MOD-034
 
 #include "cgs/ecs/component_storage.hpp"
+#include "cgs/ecs/event_channel.hpp"
 #include "cgs/ecs/system_scheduler.hpp"
 #include "cgs/game/quest_components.hpp"
+#include "cgs/game/timer_wheel.hpp"
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace cgs::game {
@@ -28,6 +35,13 @@ namespace cgs::game {
 ///
 /// Runs in PostUpdate stage so that combat kills, zone entries, and
 /// other game events from the Update stage are available as QuestEvents.
+///
+/// With SetTimerWheel(true), step 1 instead advances a TimerWheel and
+/// fails only the quests whose time limits come due.
+///
+/// With SetObjectiveIndex(true), step 2 looks each event up in a reverse
+/// index from (player, objective type, target id) to the objectives it
+/// can advance, so events that match no objective cost one hash lookup.
 class QuestSystem final : public cgs::ecs::ISystem {
 public:
     QuestSystem(cgs::ecs::ComponentStorage<QuestLog>& questLogs,
@@ -43,22 +57,150 @@ public:
 
     [[nodiscard]] cgs::ecs::SystemAccessInfo GetAccessInfo() const override;
 
-    /// Register a quest template for lookup during acceptance and validation.
+    /// Also consume the quest events published on @p channel each tick
+    /// (nullptr to detach).  Attach before SystemScheduler::Build().
+    void SetEventChannel(cgs::ecs::EventChannel<QuestEvent>* channel) noexcept {
+        eventChannel_ = channel;
+    }
+
+    // -- Timer wheel -------------------------------------------------------
+
+    /// Fail timed quests from a TimerWheel instead of stepping every
+    /// accepted quest of every QuestLog each tick.
+    ///
+    /// While enabled, timed quests must be accepted through AcceptQuest();
+    /// ones accepted straight on the QuestLog are not seen, and
+    /// QuestEntry::elapsedTime is only written when the time limit
+    /// expires.  Toggling drops every scheduled timer.
+    void SetTimerWheel(bool enabled);
+
+    [[nodiscard]] bool TimerWheelEnabled() const noexcept { return useTimerWheel_; }
+
+    /// QuestLog::Accept() the registered template @p templateId for
+    /// @p player, scheduling its time limit when the timer wheel is
+    /// enabled.
+    /// @return false if the template or QuestLog is missing, or the log
+    ///         refuses the quest.
+    bool AcceptQuest(cgs::ecs::Entity player, uint32_t templateId);
+
+    /// QuestLog::Abandon() quest @p questId of @p player, dropping its
+    /// timer and objective index entries.
+    /// @return false if the QuestLog or quest is missing.
+    bool AbandonQuest(cgs::ecs::Entity player, uint32_t questId);
+
+    // -- Objective index ---------------------------------------------------
+
+    /// Route quest events through the objective index instead of
+    /// scanning the player's quest log for each one.  Events are batched
+    /// per tick: the counts of events sharing a key are summed and then
+    /// applied once per objective, so a burst of kills of one creature
+    /// costs one update, and events no objective listens for cost one
+    /// lookup.
+    ///
+    /// While enabled, quests must be accepted and abandoned through
+    /// AcceptQuest() / AbandonQuest(); ones changed straight on the
+    /// QuestLog are not seen.  Enabling indexes every accepted quest
+    /// already in the logs; disabling drops the index.
+    void SetObjectiveIndex(bool enabled);
+
+    [[nodiscard]] bool ObjectiveIndexEnabled() const noexcept { return useObjectiveIndex_; }
+
+    /// Unfinished objectives currently indexed.  Completed objectives and
+    /// finished quests leave the index.
+    [[nodiscard]] std::size_t IndexedObjectiveCount() const noexcept;
+
+    /// Share @p templates, the quest template database built at load
+    /// time (nullptr clears it).  Lookups are O(1).
+    void SetTemplates(std::shared_ptr<const QuestTemplateDatabase> templates);
+
+    /// The template database in use (never null).
+    [[nodiscard]] const std::shared_ptr<const QuestTemplateDatabase>& GetTemplateDatabase() const
+        noexcept {
+        return templates_;
+    }
+
+    /// Register one quest template, replacing any with the same id.
+    /// Copies the database (O(n)); load content through SetTemplates().
     void RegisterTemplate(QuestTemplate tmpl);
 
     /// Get a registered quest template by ID.
-    [[nodiscard]] const QuestTemplate* GetTemplate(uint32_t templateId) const;
+    [[nodiscard]] const QuestTemplate* GetTemplate(uint32_t templateId) const {
+        return templates_->Find(templateId);
+    }
 
 private:
     /// Update timers on timed quests and fail expired ones.
     void updateTimers(float deltaTime);
 
+    /// Fail the quest named by a fired timer's payload
+    /// ((player id << 32) | quest id) if it is still in progress.
+    void expireQuest(uint64_t payload);
+
     /// Process pending quest events from other systems.
     void processEvents();
 
+    /// Apply one event to the player's active quests.
+    /// @return false for event types that map to no objective.
+    bool applyEvent(const QuestEvent& event);
+
+    /// Objective index entry key: what an event must name to match.
+    struct ObjectiveKey {
+        uint32_t player = 0;
+        uint32_t targetId = 0;
+        ObjectiveType type = ObjectiveType::Kill;
+
+        bool operator==(const ObjectiveKey&) const = default;
+    };
+
+    struct ObjectiveKeyHash {
+        std::size_t operator()(const ObjectiveKey& key) const noexcept {
+            const uint64_t bits = (static_cast<uint64_t>(key.player) << 32) ^
+                                  (static_cast<uint64_t>(key.type) << 24) ^ key.targetId;
+            return static_cast<std::size_t>(bits * 0x9E37'79B9'7F4A'7C15ull);
+        }
+    };
+
+    /// One indexed objective: objectives[objective] of quest questId.
+    struct ObjectiveRef {
+        uint32_t questId = 0;
+        uint32_t objective = 0;
+    };
+
+    /// The objectives one key advances, and the count the current tick's
+    /// events have queued for them.
+    struct ObjectiveBucket {
+        std::vector<ObjectiveRef> refs;
+        int32_t pending = 0;
+        bool queued = false;
+    };
+
+    using ObjectiveIndex = std::unordered_map<ObjectiveKey, ObjectiveBucket, ObjectiveKeyHash>;
+
+    /// Index (remove) the unfinished objectives of @p quest.
+    void indexQuest(uint32_t player, const QuestEntry& quest);
+    void unindexQuest(uint32_t player, const QuestEntry& quest);
+
+    /// Add @p event's count to its bucket, if any objective listens.
+    /// @return false for event types that map to no objective.
+    bool queueEvent(const QuestEvent& event);
+
+    /// Apply and reset the pending counts of the buckets queued this tick.
+    void applyQueuedEvents();
+
     cgs::ecs::ComponentStorage<QuestLog>& questLogs_;
     cgs::ecs::ComponentStorage<QuestEvent>& questEvents_;
-    std::vector<QuestTemplate> templates_;
+    cgs::ecs::EventChannel<QuestEvent>* eventChannel_ = nullptr;
+    std::shared_ptr<const QuestTemplateDatabase> templates_ = QuestTemplateDatabase::Build({});
+
+    // Timer wheel mode state.
+    bool useTimerWheel_ = false;
+    TimerWheel timers_;
+    std::unordered_map<uint64_t, TimerId> questTimers_;  ///< Keyed like the payload.
+
+    // Objective index mode state.
+    bool useObjectiveIndex_ = false;
+    ObjectiveIndex objectiveIndex_;
+    std::vector<ObjectiveIndex::iterator> queued_;  ///< Buckets with pending counts.
 };
 
 }  // namespace cgs::game
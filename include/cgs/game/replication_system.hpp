@@ -0,0 +1,265 @@
+#pragma once
+
+/// @file replication_system.hpp
+/// @brief Entity state replication with per-client delta snapshots.
+///
+/// ReplicationSystem captures the replicated components of every entity
+/// into a ring of recent world snapshots once per tick.  For each client
+/// it then writes one bit-packed packet that carries only what changed
+/// since the last snapshot the client acknowledged: new entities in full,
+/// changed fields of known entities, and removals.  A client that has not
+/// acknowledged anything recent gets a full snapshot.  Entities are
+/// filtered through the viewer's WorldSystem interest set.
+///
+/// Components opt in with CGS_SERIALIZABLE; every registered field is
+/// sent as its raw bytes, so fields must be trivially copyable.
+/// ReplicaState is the receiving side: it applies packets against its
+/// own copies of past snapshots and answers component reads.
+///
+/// The system is transport-agnostic: the caller sends WriteSnapshot()
+/// output (e.g. through GameNetworkManager on an unreliable-sequenced
+/// channel) and feeds the client's acks back through Acknowledge().
+///
+/// @see SDS-MOD-022
+
+#include "cgs/ecs/component_storage.hpp"
+#include "cgs/ecs/component_type_id.hpp"
+#include "cgs/ecs/entity.hpp"
+#include "cgs/ecs/system_scheduler.hpp"
+#include "cgs/foundation/game_serializer.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace cgs::game {
+
+class WorldSystem;
+
+/// Wire layout of one replicated component type: its fields' byte sizes,
+/// in SerializableTraits order.
+struct ReplicatedLayout {
+    cgs::ecs::ComponentTypeId type = cgs::ecs::kInvalidComponentTypeId;
+    std::vector<uint16_t> fieldSizes;
+    std::vector<uint16_t> fieldOffsets;  ///< Within the component's blob.
+    std::size_t blobSize = 0;
+};
+
+namespace detail {
+
+template <typename T>
+ReplicatedLayout replicatedLayout() {
+    static_assert(cgs::foundation::detail::is_serializable_v<T>,
+                  "Replicated components must be registered with CGS_SERIALIZABLE");
+    ReplicatedLayout layout;
+    layout.type = cgs::ecs::ComponentType<T>::Id();
+    cgs::foundation::detail::forEachField(
+        cgs::foundation::SerializableTraits<T>::fields(), [&](const auto& fd, std::size_t) {
+            using M = std::remove_cvref_t<decltype(std::declval<T&>().*(fd.pointer))>;
+            static_assert(std::is_trivially_copyable_v<M>,
+                          "Replicated fields must be trivially copyable");
+            layout.fieldOffsets.push_back(static_cast<uint16_t>(layout.blobSize));
+            layout.fieldSizes.push_back(static_cast<uint16_t>(sizeof(M)));
+            layout.blobSize += sizeof(M);
+        });
+    return layout;
+}
+
+/// Copy @p value's registered fields into the blob at @p out.
+template <typename T>
+void captureFields(const T& value, uint8_t* out) {
+    cgs::foundation::detail::forEachField(
+        cgs::foundation::SerializableTraits<T>::fields(), [&](const auto& fd, std::size_t) {
+            const auto& member = value.*(fd.pointer);
+            std::memcpy(out, &member, sizeof(member));
+            out += sizeof(member);
+        });
+}
+
+/// Copy the blob at @p in into @p value's registered fields.
+template <typename T>
+void restoreFields(const uint8_t* in, T& value) {
+    cgs::foundation::detail::forEachField(
+        cgs::foundation::SerializableTraits<T>::fields(), [&](const auto& fd, std::size_t) {
+            auto& member = value.*(fd.pointer);
+            std::memcpy(&member, in, sizeof(member));
+            in += sizeof(member);
+        });
+}
+
+}  // namespace detail
+
+/// Replicated state of every entity at one tick: sorted entity ids, a
+/// component presence mask per entity and fixed-stride field blobs.
+struct ReplicationSnapshot {
+    uint32_t sequence = 0;  ///< 0 marks an unused ring slot.
+    std::vector<uint32_t> ids;
+    std::vector<uint32_t> masks;
+    std::vector<uint8_t> data;
+
+    /// Index of entity @p id, or ids.size().
+    [[nodiscard]] std::size_t Find(uint32_t id) const noexcept;
+};
+
+/// System that snapshots replicated components and writes per-client
+/// delta packets.
+///
+/// Register it after the systems that write the replicated components
+/// (it runs in PostUpdate) and call WriteSnapshot() for each client
+/// after the scheduler tick.
+class ReplicationSystem final : public cgs::ecs::ISystem {
+public:
+    /// Snapshots kept for delta baselines (1.6 s at 20 ticks per second).
+    static constexpr std::size_t kHistory = 32;
+
+    /// Most component types one system can replicate.
+    static constexpr std::size_t kMaxComponents = 32;
+
+    /// @param world  Interest source; each client sees its viewer
+    ///               entity's InterestSet() plus the viewer itself.  Null
+    ///               replicates every entity to every client.
+    explicit ReplicationSystem(const WorldSystem* world = nullptr) : world_(world) {}
+
+    /// Replicate the components in @p storage.  Clients must register
+    /// the same types in the same order (ReplicaState::Register()).
+    /// Call before the first Execute().
+    template <typename T>
+    void Replicate(const cgs::ecs::ComponentStorage<T>& storage) {
+        assert(replicators_.size() < kMaxComponents && "Too many replicated components");
+        replicators_.push_back(Replicator{
+            detail::replicatedLayout<T>(), &storage, stride_,
+            [](const cgs::ecs::IComponentStorage& base, std::size_t index, uint8_t* out) {
+                const auto& typed = static_cast<const cgs::ecs::ComponentStorage<T>&>(base);
+                detail::captureFields(typed.begin()[static_cast<std::ptrdiff_t>(index)], out);
+            }});
+        stride_ += replicators_.back().layout.blobSize;
+        cgs::ecs::Read<T>::Apply(access_);
+    }
+
+    /// Start replicating to the client controlling @p viewer.
+    void AddClient(cgs::ecs::Entity viewer);
+
+    void RemoveClient(cgs::ecs::Entity viewer);
+
+    [[nodiscard]] std::size_t ClientCount() const noexcept { return clients_.size(); }
+
+    /// Record that @p viewer's client has applied snapshot @p sequence;
+    /// later packets are deltas against it.  Older acks are ignored.
+    void Acknowledge(cgs::ecs::Entity viewer, uint32_t sequence);
+
+    /// Capture this tick's snapshot.
+    void Execute(float deltaTime) override;
+
+    [[nodiscard]] cgs::ecs::SystemStage GetStage() const override {
+        return cgs::ecs::SystemStage::PostUpdate;
+    }
+
+    [[nodiscard]] std::string_view GetName() const override { return "ReplicationSystem"; }
+
+    [[nodiscard]] cgs::ecs::SystemAccessInfo GetAccessInfo() const override { return access_; }
+
+    /// Append @p viewer's packet for the latest snapshot to @p out.
+    /// @return false if @p viewer is not a client or nothing was captured.
+    bool WriteSnapshot(cgs::ecs::Entity viewer, std::vector<uint8_t>& out);
+
+    /// Sequence of the latest snapshot (0 before the first Execute()).
+    [[nodiscard]] uint32_t Sequence() const noexcept { return sequence_; }
+
+private:
+    struct Replicator {
+        ReplicatedLayout layout;
+        const cgs::ecs::IComponentStorage* storage;
+        std::size_t offset;  ///< Of this component's blob in an entity's stride.
+        void (*capture)(const cgs::ecs::IComponentStorage&, std::size_t, uint8_t*);
+    };
+
+    /// Entities written to a client with one snapshot.
+    struct SentView {
+        uint32_t sequence = 0;
+        std::vector<uint32_t> ids;
+    };
+
+    struct Client {
+        uint32_t acked = 0;
+        std::array<SentView, kHistory> sent;
+    };
+
+    /// Snapshot @p client acknowledged, if still held for both sides.
+    [[nodiscard]] const ReplicationSnapshot* baseline(const Client& client) const noexcept;
+
+    const WorldSystem* world_;
+    std::vector<Replicator> replicators_;
+    std::size_t stride_ = 0;
+    cgs::ecs::SystemAccessInfo access_;
+
+    std::array<ReplicationSnapshot, kHistory> history_;
+    uint32_t sequence_ = 0;
+    std::unordered_map<cgs::ecs::Entity, Client> clients_;
+    std::vector<uint32_t> view_;  ///< Scratch for WriteSnapshot().
+};
+
+/// Client-side mirror of the replicated world.  Not thread-safe.
+class ReplicaState {
+public:
+    /// Register a replicated component type, in the server's order.
+    template <typename T>
+    void Register() {
+        layouts_.push_back(detail::replicatedLayout<T>());
+        offsets_.push_back(stride_);
+        stride_ += layouts_.back().blobSize;
+    }
+
+    /// Apply one ReplicationSystem packet.
+    /// @return the sequence to acknowledge, or nullopt if the packet is
+    ///         malformed or its baseline is no longer held.
+    std::optional<uint32_t> Apply(std::span<const uint8_t> packet);
+
+    /// Sequence of the newest applied snapshot (0 before any).
+    [[nodiscard]] uint32_t Sequence() const noexcept { return latest_; }
+
+    /// Entity ids in the newest snapshot, ascending.
+    [[nodiscard]] std::span<const uint32_t> Entities() const noexcept;
+
+    /// Read component @p T of entity @p id from the newest snapshot.
+    /// @return false if the entity does not have it (or T is unregistered).
+    template <typename T>
+    bool Get(uint32_t id, T& out) const {
+        const ReplicationSnapshot* state = current();
+        if (state == nullptr) {
+            return false;
+        }
+        const std::size_t row = state->Find(id);
+        for (std::size_t c = 0; c < layouts_.size(); ++c) {
+            if (layouts_[c].type != cgs::ecs::ComponentType<T>::Id()) {
+                continue;
+            }
+            if (row == state->ids.size() || (state->masks[row] & (1u << c)) == 0) {
+                return false;
+            }
+            detail::restoreFields(state->data.data() + row * stride_ + offsets_[c], out);
+            return true;
+        }
+        return false;
+    }
+
+private:
+    [[nodiscard]] const ReplicationSnapshot* current() const noexcept;
+
+    ReplicationSnapshot scratch_;  ///< Snapshot being decoded.
+
+    std::vector<ReplicatedLayout> layouts_;
+    std::vector<std::size_t> offsets_;
+    std::size_t stride_ = 0;
+    std::array<ReplicationSnapshot, ReplicationSystem::kHistory> history_;
+    uint32_t latest_ = 0;
+};
+
+}  // namespace cgs::game
@@ -0,0 +1,260 @@
+#pragma once
+
+/// @file spatial_filter.hpp
+/// @brief Packed X/Z shape tests used by SpatialIndex queries.
+///
+/// SpatialIndex keeps each cell's positions as two float arrays (SoA).
+/// ForEachMatch() tests them against a circle, cone, box or capsule
+/// eight rows at a time and visits the matching rows in order.  The eight-row
+/// kernel runs as two 4-lane vectors: SSE2 on x86-64 and NEON on
+/// AArch64, both baseline on those targets.  Other targets use the
+/// scalar Contains() test.
+///
+/// @see docs/advanced/ECS_DEEP_DIVE.md  Section 6.21
+
+#include "cgs/game/math_types.hpp"
+
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define CGS_SPATIAL_FILTER_SSE2 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define CGS_SPATIAL_FILTER_NEON 1
+#endif
+
+namespace cgs::game {
+
+/// Disc on the X/Z plane.
+struct CircleXZ {
+    float x = 0.0f;
+    float z = 0.0f;
+    float radiusSq = 0.0f;
+
+    [[nodiscard]] static CircleXZ Make(const Vector3& center, float radius) noexcept {
+        return {center.x, center.z, radius * radius};
+    }
+
+    [[nodiscard]] bool Contains(float px, float pz) const noexcept {
+        const float dx = px - x;
+        const float dz = pz - z;
+        return dx * dx + dz * dz <= radiusSq;
+    }
+};
+
+/// Circular sector on the X/Z plane: points within the radius whose
+/// direction from the apex is at most the half angle off @c dir.
+struct ConeXZ {
+    float x = 0.0f;
+    float z = 0.0f;
+    float radiusSq = 0.0f;
+    float dirX = 0.0f;  ///< Unit facing, X.
+    float dirZ = 1.0f;  ///< Unit facing, Z.
+    float cosHalfAngle = 1.0f;
+
+    /// Cone at @p apex facing @p direction (Y ignored, need not be
+    /// normalized; a zero direction faces +Z).  @p halfAngle in radians.
+    [[nodiscard]] static ConeXZ Make(const Vector3& apex,
+                                     const Vector3& direction,
+                                     float radius,
+                                     float halfAngle) noexcept {
+        ConeXZ cone{apex.x, apex.z, radius * radius, 0.0f, 1.0f, std::cos(halfAngle)};
+        const float length = std::sqrt(direction.x * direction.x + direction.z * direction.z);
+        if (length > 0.0f) {
+            cone.dirX = direction.x / length;
+            cone.dirZ = direction.z / length;
+        }
+        return cone;
+    }
+
+    [[nodiscard]] bool Contains(float px, float pz) const noexcept {
+        const float dx = px - x;
+        const float dz = pz - z;
+        const float distSq = dx * dx + dz * dz;
+        return distSq <= radiusSq && dx * dirX + dz * dirZ >= cosHalfAngle * std::sqrt(distSq);
+    }
+};
+
+/// Axis-aligned rectangle on the X/Z plane (bounds inclusive).
+struct BoxXZ {
+    float minX = 0.0f;
+    float minZ = 0.0f;
+    float maxX = 0.0f;
+    float maxZ = 0.0f;
+
+    [[nodiscard]] bool Contains(float px, float pz) const noexcept {
+        return px >= minX && px <= maxX && pz >= minZ && pz <= maxZ;
+    }
+};
+
+/// Capsule on the X/Z plane: points within @c radius of the segment from
+/// (x, z) along the unit direction for @c length units.
+struct SegmentXZ {
+    float x = 0.0f;
+    float z = 0.0f;
+    float dirX = 0.0f;  ///< Unit direction, X (zero for a point).
+    float dirZ = 0.0f;  ///< Unit direction, Z.
+    float length = 0.0f;
+    float radiusSq = 0.0f;
+
+    /// Segment from @p from to @p to (Y ignored) inflated by @p radius.
+    [[nodiscard]] static SegmentXZ Make(const Vector3& from, const Vector3& to,
+                                        float radius) noexcept {
+        SegmentXZ segment{from.x, from.z, 0.0f, 0.0f, 0.0f, radius * radius};
+        const float dx = to.x - from.x;
+        const float dz = to.z - from.z;
+        segment.length = std::sqrt(dx * dx + dz * dz);
+        if (segment.length > 0.0f) {
+            segment.dirX = dx / segment.length;
+            segment.dirZ = dz / segment.length;
+        }
+        return segment;
+    }
+
+    /// Distance from the start to the projection of (px, pz), clamped to
+    /// the segment.
+    [[nodiscard]] float Along(float px, float pz) const noexcept {
+        const float t = (px - x) * dirX + (pz - z) * dirZ;
+        return t < 0.0f ? 0.0f : (t > length ? length : t);
+    }
+
+    [[nodiscard]] bool Contains(float px, float pz) const noexcept {
+        const float t = Along(px, pz);
+        const float ex = px - x - t * dirX;
+        const float ez = pz - z - t * dirZ;
+        return ex * ex + ez * ez <= radiusSq;
+    }
+};
+
+namespace detail {
+
+#if defined(CGS_SPATIAL_FILTER_SSE2)
+
+using Lanes = __m128;
+
+[[nodiscard]] inline Lanes LoadLanes(const float* p) noexcept { return _mm_loadu_ps(p); }
+[[nodiscard]] inline Lanes Splat(float v) noexcept { return _mm_set1_ps(v); }
+[[nodiscard]] inline Lanes Sub(Lanes a, Lanes b) noexcept { return _mm_sub_ps(a, b); }
+[[nodiscard]] inline Lanes Mul(Lanes a, Lanes b) noexcept { return _mm_mul_ps(a, b); }
+[[nodiscard]] inline Lanes Add(Lanes a, Lanes b) noexcept { return _mm_add_ps(a, b); }
+[[nodiscard]] inline Lanes Sqrt(Lanes a) noexcept { return _mm_sqrt_ps(a); }
+[[nodiscard]] inline Lanes LessEqual(Lanes a, Lanes b) noexcept { return _mm_cmple_ps(a, b); }
+[[nodiscard]] inline Lanes And(Lanes a, Lanes b) noexcept { return _mm_and_ps(a, b); }
+[[nodiscard]] inline Lanes Min(Lanes a, Lanes b) noexcept { return _mm_min_ps(a, b); }
+[[nodiscard]] inline Lanes Max(Lanes a, Lanes b) noexcept { return _mm_max_ps(a, b); }
+
+/// One bit per lane, lane 0 in bit 0.
+[[nodiscard]] inline uint32_t LaneBits(Lanes mask) noexcept {
+    return static_cast<uint32_t>(_mm_movemask_ps(mask));
+}
+
+#elif defined(CGS_SPATIAL_FILTER_NEON)
+
+using Lanes = float32x4_t;
+
+[[nodiscard]] inline Lanes LoadLanes(const float* p) noexcept { return vld1q_f32(p); }
+[[nodiscard]] inline Lanes Splat(float v) noexcept { return vdupq_n_f32(v); }
+[[nodiscard]] inline Lanes Sub(Lanes a, Lanes b) noexcept { return vsubq_f32(a, b); }
+[[nodiscard]] inline Lanes Mul(Lanes a, Lanes b) noexcept { return vmulq_f32(a, b); }
+[[nodiscard]] inline Lanes Add(Lanes a, Lanes b) noexcept { return vaddq_f32(a, b); }
+[[nodiscard]] inline Lanes Sqrt(Lanes a) noexcept { return vsqrtq_f32(a); }
+[[nodiscard]] inline Lanes LessEqual(Lanes a, Lanes b) noexcept {
+    return vreinterpretq_f32_u32(vcleq_f32(a, b));
+}
+[[nodiscard]] inline Lanes And(Lanes a, Lanes b) noexcept {
+    return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)));
+}
+[[nodiscard]] inline Lanes Min(Lanes a, Lanes b) noexcept { return vminq_f32(a, b); }
+[[nodiscard]] inline Lanes Max(Lanes a, Lanes b) noexcept { return vmaxq_f32(a, b); }
+
+/// One bit per lane, lane 0 in bit 0.
+[[nodiscard]] inline uint32_t LaneBits(Lanes mask) noexcept {
+    static constexpr uint32_t kWeights[4] = {1, 2, 4, 8};
+    return vaddvq_u32(vandq_u32(vreinterpretq_u32_f32(mask), vld1q_u32(kWeights)));
+}
+
+#endif
+
+#if defined(CGS_SPATIAL_FILTER_SSE2) || defined(CGS_SPATIAL_FILTER_NEON)
+
+[[nodiscard]] inline uint32_t MatchMask4(const float* xs, const float* zs, const CircleXZ& s) noexcept {
+    const Lanes dx = Sub(LoadLanes(xs), Splat(s.x));
+    const Lanes dz = Sub(LoadLanes(zs), Splat(s.z));
+    return LaneBits(LessEqual(Add(Mul(dx, dx), Mul(dz, dz)), Splat(s.radiusSq)));
+}
+
+[[nodiscard]] inline uint32_t MatchMask4(const float* xs, const float* zs, const ConeXZ& s) noexcept {
+    const Lanes dx = Sub(LoadLanes(xs), Splat(s.x));
+    const Lanes dz = Sub(LoadLanes(zs), Splat(s.z));
+    const Lanes distSq = Add(Mul(dx, dx), Mul(dz, dz));
+    const Lanes dot = Add(Mul(dx, Splat(s.dirX)), Mul(dz, Splat(s.dirZ)));
+    const Lanes inRadius = LessEqual(distSq, Splat(s.radiusSq));
+    const Lanes inAngle = LessEqual(Mul(Splat(s.cosHalfAngle), Sqrt(distSq)), dot);
+    return LaneBits(And(inRadius, inAngle));
+}
+
+[[nodiscard]] inline uint32_t MatchMask4(const float* xs, const float* zs, const BoxXZ& s) noexcept {
+    const Lanes x = LoadLanes(xs);
+    const Lanes z = LoadLanes(zs);
+    const Lanes inX = And(LessEqual(Splat(s.minX), x), LessEqual(x, Splat(s.maxX)));
+    const Lanes inZ = And(LessEqual(Splat(s.minZ), z), LessEqual(z, Splat(s.maxZ)));
+    return LaneBits(And(inX, inZ));
+}
+
+[[nodiscard]] inline uint32_t MatchMask4(const float* xs, const float* zs, const SegmentXZ& s) noexcept {
+    const Lanes dx = Sub(LoadLanes(xs), Splat(s.x));
+    const Lanes dz = Sub(LoadLanes(zs), Splat(s.z));
+    const Lanes dirX = Splat(s.dirX);
+    const Lanes dirZ = Splat(s.dirZ);
+    const Lanes along =
+        Min(Max(Add(Mul(dx, dirX), Mul(dz, dirZ)), Splat(0.0f)), Splat(s.length));
+    const Lanes ex = Sub(dx, Mul(along, dirX));
+    const Lanes ez = Sub(dz, Mul(along, dirZ));
+    return LaneBits(LessEqual(Add(Mul(ex, ex), Mul(ez, ez)), Splat(s.radiusSq)));
+}
+
+#else
+
+template <typename Shape>
+[[nodiscard]] uint32_t MatchMask4(const float* xs, const float* zs, const Shape& s) noexcept {
+    uint32_t bits = 0;
+    for (uint32_t lane = 0; lane < 4; ++lane) {
+        bits |= s.Contains(xs[lane], zs[lane]) ? (1u << lane) : 0u;
+    }
+    return bits;
+}
+
+#endif
+
+}  // namespace detail
+
+/// Bit @c i set when row @c i of the eight rows at @p xs / @p zs lies
+/// inside @p shape.
+template <typename Shape>
+[[nodiscard]] uint32_t MatchMask8(const float* xs, const float* zs, const Shape& shape) noexcept {
+    return detail::MatchMask4(xs, zs, shape) | (detail::MatchMask4(xs + 4, zs + 4, shape) << 4);
+}
+
+/// Invoke @p visit(row) for every row in [0, @p count) whose position
+/// lies inside @p shape, in ascending order.
+template <typename Shape, typename Visitor>
+void ForEachMatch(const float* xs, const float* zs, std::size_t count, const Shape& shape,
+                  Visitor&& visit) {
+    std::size_t base = 0;
+    for (; base + 8 <= count; base += 8) {
+        for (uint32_t bits = MatchMask8(xs + base, zs + base, shape); bits != 0; bits &= bits - 1) {
+            visit(base + static_cast<std::size_t>(std::countr_zero(bits)));
+        }
+    }
+    for (; base < count; ++base) {
+        if (shape.Contains(xs[base], zs[base])) {
+            visit(base);
+        }
+    }
+}
+
+}  // namespace cgs::game
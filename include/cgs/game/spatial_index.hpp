@@ -5,17 +5,27 @@
 ///
 /// SpatialIndex divides 2D world space into uniform cells and provides
 /// efficient O(1) insert/update/remove and radius-based nearest-neighbor
-/// queries.  Only the X and Z coordinates are used (Y is "up").
+/// queries.  Only the X and Z coordinates are used (Y is "up").  Cells
+/// live in a flat open-addressing table and store their entities'
+/// positions, so queries filter without consulting component storage.
 ///
 /// @see SRS-GML-003.3
 /// @see SDS-MOD-022
 
 #include "cgs/ecs/entity.hpp"
+#include "cgs/ecs/sparse_page_table.hpp"
 #include "cgs/game/math_types.hpp"
+#include "cgs/game/spatial_filter.hpp"
 #include "cgs/game/world_types.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory_resource>
+#include <optional>
+#include <span>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -30,33 +40,188 @@ struct CellCoord {
     constexpr auto operator<=>(const CellCoord&) const = default;
 };
 
+/// Z-order (Morton) code of @p cell: the bits of x and y interleaved, so
+/// that cells close on the grid are mostly close in key order.
+[[nodiscard]] constexpr uint64_t MortonCode(CellCoord cell) noexcept {
+    // Bias to unsigned so negative coordinates order before positive ones.
+    const auto spread = [](int32_t v) {
+        uint64_t bits = static_cast<uint32_t>(v) ^ 0x8000'0000u;
+        bits = (bits | (bits << 16)) & 0x0000'FFFF'0000'FFFFull;
+        bits = (bits | (bits << 8)) & 0x00FF'00FF'00FF'00FFull;
+        bits = (bits | (bits << 4)) & 0x0F0F'0F0F'0F0F'0F0Full;
+        bits = (bits | (bits << 2)) & 0x3333'3333'3333'3333ull;
+        bits = (bits | (bits << 1)) & 0x5555'5555'5555'5555ull;
+        return bits;
+    };
+    return spread(cell.x) | (spread(cell.y) << 1);
+}
+
 }  // namespace cgs::game
 
-/// Hash support for CellCoord.
+/// Hash support for CellCoord: Fibonacci-multiplied Morton code, so both
+/// coordinates reach the high bits.
 template <>
 struct std::hash<cgs::game::CellCoord> {
     std::size_t operator()(const cgs::game::CellCoord& c) const noexcept {
-        // Combine x and y hashes using a simple mixing function.
-        auto h1 = std::hash<int32_t>{}(c.x);
-        auto h2 = std::hash<int32_t>{}(c.y);
-        return h1 ^ (h2 * 2654435761u);
+        return static_cast<std::size_t>((cgs::game::MortonCode(c) * 0x9E37'79B9'7F4A'7C15ull) >> 16);
     }
 };
 
 namespace cgs::game {
 
+/// X/Z positions of one cell's entities, matching CellEntities() row
+/// for row.
+struct CellPositionView {
+    std::span<const float> x;
+    std::span<const float> z;
+};
+
+/// One entity position for SpatialIndex::UpdateBatch().
+struct SpatialUpdate {
+    cgs::ecs::Entity entity;
+    Vector3 position;
+};
+
+/// An entity entering or leaving a cell, as recorded by the change log.
+struct CellChange {
+    cgs::ecs::Entity entity;
+    CellCoord cell;
+    bool entered = false;  ///< false: left @c cell.
+};
+
+/// First entity hit by SpatialIndex::Raycast().
+struct SegmentHit {
+    cgs::ecs::Entity entity;
+    float distance = 0.0f;  ///< From the segment start to the entity's projection.
+};
+
+namespace detail {
+
+/// Open-addressing map from a cell coordinate to an index into a vector
+/// of records that carry a @c coord member.  Power-of-two slots, linear
+/// probing, Fibonacci-hashed Morton keys; grows before it is half full.
+/// Records are never erased, only cleared all at once.
+class CellTable {
+public:
+    static constexpr uint32_t kNone = cgs::ecs::SparsePageTable::kInvalidIndex;
+
+    /// Index of the record at @p coord, or kNone.
+    template <typename Records>
+    [[nodiscard]] uint32_t Find(CellCoord coord, const Records& records) const noexcept {
+        if (slots_.empty()) {
+            return kNone;
+        }
+        const std::size_t mask = slots_.size() - 1;
+        for (std::size_t slot = home(coord);; slot = (slot + 1) & mask) {
+            const uint32_t index = slots_[slot];
+            if (index == kNone || records[index].coord == coord) {
+                return index;
+            }
+        }
+    }
+
+    /// Index of the record at @p coord, appending a new one to @p records
+    /// if needed; @c second is true when it was appended.
+    template <typename Records>
+    std::pair<uint32_t, bool> FindOrAdd(CellCoord coord, Records& records) {
+        if ((records.size() + 1) * 2 > slots_.size()) {
+            grow(records);
+        }
+        const std::size_t mask = slots_.size() - 1;
+        for (std::size_t slot = home(coord);; slot = (slot + 1) & mask) {
+            const uint32_t index = slots_[slot];
+            if (index == kNone) {
+                slots_[slot] = static_cast<uint32_t>(records.size());
+                records.emplace_back().coord = coord;
+                return {slots_[slot], true};
+            }
+            if (records[index].coord == coord) {
+                return {index, false};
+            }
+        }
+    }
+
+    void Clear() noexcept {
+        slots_.clear();
+        bits_ = 0;
+    }
+
+private:
+    [[nodiscard]] std::size_t home(CellCoord coord) const noexcept {
+        return static_cast<std::size_t>((MortonCode(coord) * 0x9E37'79B9'7F4A'7C15ull) >>
+                                        (64 - bits_));
+    }
+
+    /// Double the slots (16 at first) and re-insert every record.
+    template <typename Records>
+    void grow(const Records& records) {
+        bits_ = bits_ < 4 ? 4 : bits_ + 1;
+        slots_.assign(std::size_t{1} << bits_, kNone);
+        const std::size_t mask = slots_.size() - 1;
+        for (std::size_t i = 0; i < records.size(); ++i) {
+            std::size_t slot = home(records[i].coord);
+            while (slots_[slot] != kNone) {
+                slot = (slot + 1) & mask;
+            }
+            slots_[slot] = static_cast<uint32_t>(i);
+        }
+    }
+
+    std::vector<uint32_t> slots_;
+    uint32_t bits_ = 0;  ///< log2(slots_.size()).
+};
+
+}  // namespace detail
+
 /// Grid-based spatial index for efficient entity queries.
 ///
 /// Entities are placed into cells based on their X/Z world position.
 /// The grid is sparse (only occupied cells are stored), making it
 /// memory-efficient for large, mostly-empty worlds.
 ///
+/// Layout:
+/// @code
+///   table_        cell        -> cell index   (detail::CellTable)
+///   cells_        [cell index] -> {coord, entities[], xs[], zs[], areas[]}
+///   cellOf_       [entity.id]  -> cell index   (paged)
+///   slotOf_       [entity.id]  -> row in cell  (paged)
+///   coarseTable_  coarse cell  -> coarse index (two-level grids only)
+///   coarseCells_  [coarse index] -> {coord, cell indices[]}
+/// @endcode
+///
+/// With a coarse factor F > 1 the index is a two-level grid: each coarse
+/// cell lists the occupied fine cells in its F x F block.  Queries whose
+/// bounds span at least kCoarseSpan coarse cells on an axis walk those
+/// lists instead of probing every fine cell, so a 200 m visibility range
+/// over 16 m cells costs a few dozen probes rather than hundreds, while
+/// melee-sized queries keep the fine path.
+///
+/// Cells keep their X/Z positions next to their ids as two float arrays,
+/// so shape queries filter them with the packed kernels of
+/// spatial_filter.hpp without touching ComponentStorage<Transform>, and
+/// moving or removing an entity is a swap-and-pop within its cell.
+/// Emptied cells stay in the table for reuse until Clear(), which suits
+/// bounded maps.  An id is tracked at most once: inserting a handle with
+/// a new version replaces the stale one.
+///
+/// Every query has an allocating form and forms that append to a caller
+/// buffer, invoke a visitor or (for single cells) return a span, so hot
+/// paths can query without touching the heap.  QueryNearest() and
+/// Raycast() walk cells outward from the query point (rings of cells,
+/// or a DDA along the segment) and stop as soon as no farther cell can
+/// improve the result.
+///
 /// Thread safety: None.  External synchronization is required if
 /// accessed from multiple threads.
 class SpatialIndex {
 public:
-    /// Construct with a given cell size (world units per cell edge).
-    explicit SpatialIndex(float cellSize = kDefaultCellSize);
+    /// Coarse cells a query must span on one axis to use the coarse level.
+    static constexpr int32_t kCoarseSpan = 3;
+
+    /// Construct with a given cell size (world units per cell edge) and
+    /// coarse factor (fine cells per coarse cell edge, at most 1024; 0 or
+    /// 1 keeps a single-level grid).
+    explicit SpatialIndex(float cellSize = kDefaultCellSize, uint32_t coarseFactor = 0);
 
     // -- Mutation -------------------------------------------------------
 
@@ -67,37 +232,165 @@ public:
 
     /// Update an entity's position in the index.
     ///
-    /// If the entity has moved to a different cell, it is re-assigned.
-    /// If the entity is not tracked, this is equivalent to Insert().
+    /// If the entity has moved to a different cell, it is re-assigned;
+    /// otherwise only its stored position changes.  If the entity is not
+    /// tracked, this is equivalent to Insert().
     void Update(cgs::ecs::Entity entity, const Vector3& newPosition);
 
+    /// Apply Update() for every entry of @p updates in one pass.
+    ///
+    /// Same-cell moves are stored in place.  Cell-crossers and new
+    /// entities are sorted by destination cell, removed from their old
+    /// cells, then appended one destination at a time, so each target
+    /// cell is probed and grown once per batch.  Each entity should
+    /// appear at most once; for duplicates, which entry wins is
+    /// unspecified.
+    void UpdateBatch(std::span<const SpatialUpdate> updates);
+
     /// Remove an entity from the index.
     ///
     /// No-op if the entity is not currently tracked.
     void Remove(cgs::ecs::Entity entity);
 
-    /// Remove all tracked entities.
+    /// Remove all tracked entities and cells.
     void Clear();
 
     // -- Queries --------------------------------------------------------
 
-    /// Return all entities within @p radius world units of @p center.
-    ///
-    /// Uses the grid to limit the search to cells that overlap the
-    /// query circle, then applies exact distance filtering.
+    /// Return all entities within @p radius world units (XZ distance) of
+    /// @p center, using their last inserted or updated positions.
     [[nodiscard]] std::vector<cgs::ecs::Entity> QueryRadius(const Vector3& center,
                                                             float radius) const;
 
+    /// Append the QueryRadius() result to @p out instead of returning
+    /// a new vector (e.g. one backed by ISystem::FrameMemory()).
+    void QueryRadius(const Vector3& center, float radius,
+                     std::pmr::vector<cgs::ecs::Entity>& out) const;
+
+    /// Append the QueryRadius() result to a reused @p out.
+    void QueryRadius(const Vector3& center, float radius,
+                     std::vector<cgs::ecs::Entity>& out) const;
+
+    /// Invoke @p visit(Entity) for every QueryRadius() match without
+    /// materializing the list.  @p visit must not modify the index.
+    template <typename Visitor>
+    void ForEachInRadius(const Vector3& center, float radius, Visitor&& visit) const;
+
+    /// Return all entities in the XZ cone at @p apex facing @p direction
+    /// with the given radius and half angle (radians).
+    [[nodiscard]] std::vector<cgs::ecs::Entity> QueryCone(const Vector3& apex,
+                                                          const Vector3& direction,
+                                                          float radius,
+                                                          float halfAngle) const;
+
+    /// Visitor form of QueryCone().
+    template <typename Visitor>
+    void ForEachInCone(const Vector3& apex, const Vector3& direction, float radius,
+                       float halfAngle, Visitor&& visit) const;
+
+    /// Return all entities whose X/Z lies in the box spanned by @p min
+    /// and @p max (inclusive).
+    [[nodiscard]] std::vector<cgs::ecs::Entity> QueryBox(const Vector3& min,
+                                                         const Vector3& max) const;
+
+    /// Visitor form of QueryBox().
+    template <typename Visitor>
+    void ForEachInBox(const Vector3& min, const Vector3& max, Visitor&& visit) const;
+
+    /// Append to @p out the (at most) @p k entities nearest to @p center
+    /// (XZ distance, at most @p maxRadius) for which @p filter(Entity)
+    /// returns true, nearest first.  @p out is a std::vector or
+    /// std::pmr::vector of Entity; entries already in it are kept.
+    ///
+    /// Rings of cells are searched outward from the center cell and the
+    /// search stops once the k-th candidate is closer than any unsearched
+    /// ring, so a small k over a dense map probes only a few cells.
+    template <typename Out, typename Filter>
+    void QueryNearest(const Vector3& center, std::size_t k, Out& out, Filter&& filter,
+                      float maxRadius = std::numeric_limits<float>::infinity()) const;
+
+    /// Return the (at most) @p k entities nearest to @p center, nearest
+    /// first.
+    [[nodiscard]] std::vector<cgs::ecs::Entity> QueryNearest(
+        const Vector3& center,
+        std::size_t k,
+        float maxRadius = std::numeric_limits<float>::infinity()) const;
+
+    /// First entity (by distance along the segment, then lowest id)
+    /// within @p radius of the XZ segment from @p from to @p to for which
+    /// @p filter(Entity) returns true, or nullopt when the segment is
+    /// clear.
+    ///
+    /// Cells are visited along the segment by a grid DDA, widened by
+    /// ceil(radius / CellSize()) cells on each side, and the walk stops
+    /// once no later cell can hold a nearer hit.  Typical use is a line
+    /// of sight check that ignores the shooter and the target.
+    template <typename Filter>
+    [[nodiscard]] std::optional<SegmentHit> Raycast(const Vector3& from, const Vector3& to,
+                                                    float radius, Filter&& filter) const;
+
+    /// Append to @p out every entity within @p radius of the XZ segment
+    /// from @p from to @p to, ordered by distance along it.  @p out is a
+    /// std::vector or std::pmr::vector of Entity; entries already in it
+    /// are kept.
+    template <typename Out>
+    void QuerySegment(const Vector3& from, const Vector3& to, float radius, Out& out) const;
+
     /// Return all entities in the cell that contains world position @p pos.
     [[nodiscard]] std::vector<cgs::ecs::Entity> QueryPosition(const Vector3& pos) const;
 
     /// Return all entities in the cell at grid coordinate (x, y).
     [[nodiscard]] std::vector<cgs::ecs::Entity> QueryCell(int32_t x, int32_t y) const;
 
+    /// View of the entities in @p cell (empty if unoccupied), valid until
+    /// the index is next modified.
+    [[nodiscard]] std::span<const cgs::ecs::Entity> CellEntities(CellCoord cell) const noexcept {
+        const Cell* found = findCell(cell);
+        return found != nullptr ? std::span<const cgs::ecs::Entity>(found->entities)
+                                : std::span<const cgs::ecs::Entity>();
+    }
+
+    /// Positions matching CellEntities(@p cell) row for row.
+    [[nodiscard]] CellPositionView CellPositions(CellCoord cell) const noexcept {
+        const Cell* found = findCell(cell);
+        return found != nullptr ? CellPositionView{found->xs, found->zs} : CellPositionView{};
+    }
+
+    // -- Area volumes ---------------------------------------------------
+
+    /// Register area @p area, the XZ circle of @p radius around @p center,
+    /// in every cell it overlaps, replacing an earlier registration of the
+    /// same id.  A moved entity then finds the areas around it with
+    /// ForEachAreaAt() on its own cell, instead of every area querying
+    /// for its occupants.  Clear() drops every area.
+    void InsertArea(uint32_t area, const Vector3& center, float radius);
+
+    /// Unregister @p area.  No-op if it is not registered.
+    void RemoveArea(uint32_t area);
+
+    /// Invoke @p visit(uint32_t area) for every area whose circle contains
+    /// @p position (boundary included, as in QueryRadius()).
+    template <typename Visitor>
+    void ForEachAreaAt(const Vector3& position, Visitor&& visit) const;
+
+    /// Number of registered areas.
+    [[nodiscard]] std::size_t AreaCount() const noexcept { return areas_.size(); }
+
     // -- Accessors ------------------------------------------------------
 
     /// Number of tracked entities.
-    [[nodiscard]] std::size_t Size() const noexcept { return entityCells_.size(); }
+    [[nodiscard]] std::size_t Size() const noexcept { return size_; }
+
+    /// Number of cells in the table (occupied or retained empty).
+    [[nodiscard]] std::size_t CellCount() const noexcept { return cells_.size(); }
+
+    /// Fine cells per coarse cell edge (0 for a single-level grid).
+    [[nodiscard]] uint32_t CoarseFactor() const noexcept {
+        return static_cast<uint32_t>(coarseFactor_);
+    }
+
+    /// Number of coarse cells holding at least one fine cell.
+    [[nodiscard]] std::size_t CoarseCellCount() const noexcept { return coarseCells_.size(); }
 
     /// Current cell size.
     [[nodiscard]] float CellSize() const noexcept { return cellSize_; }
@@ -105,6 +398,31 @@ public:
     /// Check whether an entity is tracked.
     [[nodiscard]] bool Contains(cgs::ecs::Entity entity) const;
 
+    /// Cell of a tracked entity, or nullopt.
+    [[nodiscard]] std::optional<CellCoord> CellOf(cgs::ecs::Entity entity) const {
+        if (!Contains(entity)) {
+            return std::nullopt;
+        }
+        return cells_[cellOf_.Get(entity.id())].coord;
+    }
+
+    // -- Change log -----------------------------------------------------
+
+    /// Record every cell an entity enters or leaves (moves within a cell
+    /// are not recorded) until ClearChanges().  Used by incremental
+    /// consumers such as WorldSystem interest management.
+    void SetChangeLog(bool enabled) {
+        logChanges_ = enabled;
+        changes_.clear();
+    }
+
+    [[nodiscard]] bool ChangeLogEnabled() const noexcept { return logChanges_; }
+
+    /// Changes recorded since the last ClearChanges(), in order.
+    [[nodiscard]] std::span<const CellChange> Changes() const noexcept { return changes_; }
+
+    void ClearChanges() noexcept { changes_.clear(); }
+
     /// Get the cell coordinate for a world position.
     [[nodiscard]] CellCoord WorldToCell(const Vector3& pos) const noexcept {
         return {static_cast<int32_t>(std::floor(pos.x / cellSize_)),
@@ -112,19 +430,409 @@ public:
     }
 
 private:
-    /// Remove entity from its current cell (internal helper).
-    void removeFromCell(cgs::ecs::Entity entity, CellCoord cell);
+    /// An area registered in a cell, with its circle for the exact test.
+    struct CellArea {
+        uint32_t id = 0;
+        CircleXZ circle;
+    };
+
+    struct Cell {
+        CellCoord coord;
+        std::vector<cgs::ecs::Entity> entities;
+        std::vector<float> xs;
+        std::vector<float> zs;
+        std::vector<CellArea> areas;
+    };
+
+    /// A cell-crosser (or new entity) pending in UpdateBatch().
+    struct CellMove {
+        uint64_t key;  ///< MortonCode(cell), the sort key.
+        CellCoord cell;
+        cgs::ecs::Entity entity;
+        Vector3 position;
+    };
 
-    /// Add entity to a cell (internal helper).
-    void addToCell(cgs::ecs::Entity entity, CellCoord cell);
+    struct CoarseCell {
+        CellCoord coord;
+        std::vector<uint32_t> cells;  ///< cells_ indices inside this block.
+    };
+
+    /// Visit the entities inside @p shape among the cells from @p min to
+    /// @p max (inclusive).
+    template <typename Shape, typename Visitor>
+    void forEachInShape(CellCoord min, CellCoord max, const Shape& shape, Visitor&& visit) const;
+
+    /// Visit every non-empty cell at Chebyshev distance @p ring from
+    /// @p home.
+    template <typename Visitor>
+    void forEachRingCell(CellCoord home, int32_t ring, Visitor&& visit) const;
+
+    /// Visit the cells the XZ segment from @p from to @p to passes through,
+    /// in order, as @p visit(CellCoord, float enter) where @c enter is the
+    /// distance along the segment at which the cell is entered.  Stops
+    /// when @p visit returns false.
+    template <typename Visitor>
+    void traverseSegment(const Vector3& from, const Vector3& to, Visitor&& visit) const;
+
+    /// Visit the @p segment capsule matches in the cells along it, widened
+    /// to cover its radius, as @p visit(Entity, float along); an entity may
+    /// be visited more than once.  Before each cell along the segment,
+    /// @p proceed(float enter) may end the walk by returning false.
+    template <typename Proceed, typename Visitor>
+    void forEachOnSegment(const Vector3& from, const Vector3& to, const SegmentXZ& segment,
+                          Proceed&& proceed, Visitor&& visit) const;
+
+    /// Stored X/Z of the tracked entity with id @p id.
+    [[nodiscard]] std::pair<float, float> storedXZ(uint32_t id) const {
+        const Cell& cell = cells_[cellOf_.Get(id)];
+        const uint32_t row = slotOf_.Get(id);
+        return {cell.xs[row], cell.zs[row]};
+    }
+
+    /// The cell at @p coord, or nullptr if it was never occupied.
+    [[nodiscard]] const Cell* findCell(CellCoord coord) const noexcept {
+        const uint32_t index = table_.Find(coord, cells_);
+        return index != detail::CellTable::kNone ? &cells_[index] : nullptr;
+    }
+
+    /// Coarse cell containing fine cell @p cell.
+    [[nodiscard]] CellCoord toCoarse(CellCoord cell) const noexcept {
+        const auto floorDiv = [this](int32_t v) {
+            const int32_t q = v / coarseFactor_;
+            return (v % coarseFactor_ != 0 && v < 0) ? q - 1 : q;
+        };
+        return {floorDiv(cell.x), floorDiv(cell.y)};
+    }
+
+    /// Index of the cell at @p coord, creating it (and registering it with
+    /// its coarse cell) if needed.
+    uint32_t findOrAddCell(CellCoord coord);
+
+    /// Append @p entity to cell @p cellIndex and record its location.
+    void addToCell(cgs::ecs::Entity entity, uint32_t cellIndex, const Vector3& position);
+
+    /// Swap-and-pop the entity with id @p id out of its cell.
+    void removeFromCell(uint32_t id);
 
     float cellSize_;
+    int32_t coarseFactor_ = 0;  ///< 0 for a single-level grid.
+
+    detail::CellTable table_;
+    std::vector<Cell> cells_;  ///< Every cell ever occupied.
+    CellCoord cellMin_;        ///< Bounds of cells_ (valid when non-empty).
+    CellCoord cellMax_;
+
+    detail::CellTable coarseTable_;
+    std::vector<CoarseCell> coarseCells_;
+
+    cgs::ecs::SparsePageTable cellOf_;  ///< entity id -> cells_ index.
+    cgs::ecs::SparsePageTable slotOf_;  ///< entity id -> row in its cell.
+    std::size_t size_ = 0;              ///< Tracked entities.
 
-    /// cell coord -> list of entities in that cell.
-    std::unordered_map<CellCoord, std::vector<cgs::ecs::Entity>> cells_;
+    std::vector<CellMove> moves_;  ///< UpdateBatch() scratch, reused.
 
-    /// entity -> current cell coord (for fast lookup on Update/Remove).
-    std::unordered_map<cgs::ecs::Entity, CellCoord> entityCells_;
+    bool logChanges_ = false;
+    std::vector<CellChange> changes_;
+
+    /// Registered areas -> the cell range their circle was inserted into.
+    std::unordered_map<uint32_t, std::pair<CellCoord, CellCoord>> areas_;
 };
 
+template <typename Shape, typename Visitor>
+void SpatialIndex::forEachInShape(CellCoord min, CellCoord max, const Shape& shape,
+                                  Visitor&& visit) const {
+    const auto filter = [&](const Cell& cell) {
+        ForEachMatch(cell.xs.data(), cell.zs.data(), cell.entities.size(), shape,
+                     [&](std::size_t row) { visit(cell.entities[row]); });
+    };
+
+    if (coarseFactor_ > 1) {
+        const CellCoord coarseMin = toCoarse(min);
+        const CellCoord coarseMax = toCoarse(max);
+        if (coarseMax.x - coarseMin.x + 1 >= kCoarseSpan ||
+            coarseMax.y - coarseMin.y + 1 >= kCoarseSpan) {
+            for (int32_t cx = coarseMin.x; cx <= coarseMax.x; ++cx) {
+                for (int32_t cy = coarseMin.y; cy <= coarseMax.y; ++cy) {
+                    const uint32_t coarse = coarseTable_.Find(CellCoord{cx, cy}, coarseCells_);
+                    if (coarse == detail::CellTable::kNone) {
+                        continue;
+                    }
+                    for (const uint32_t index : coarseCells_[coarse].cells) {
+                        const Cell& cell = cells_[index];
+                        // Edge blocks also hold cells outside the query bounds.
+                        if (cell.coord.x >= min.x && cell.coord.x <= max.x &&
+                            cell.coord.y >= min.y && cell.coord.y <= max.y) {
+                            filter(cell);
+                        }
+                    }
+                }
+            }
+            return;
+        }
+    }
+
+    for (int32_t cx = min.x; cx <= max.x; ++cx) {
+        for (int32_t cy = min.y; cy <= max.y; ++cy) {
+            const Cell* cell = findCell(CellCoord{cx, cy});
+            if (cell == nullptr) {
+                continue;
+            }
+            filter(*cell);
+        }
+    }
+}
+
+template <typename Visitor>
+void SpatialIndex::ForEachInRadius(const Vector3& center, float radius, Visitor&& visit) const {
+    if (radius <= 0.0f) {
+        return;
+    }
+    forEachInShape(WorldToCell(Vector3{center.x - radius, 0.0f, center.z - radius}),
+                   WorldToCell(Vector3{center.x + radius, 0.0f, center.z + radius}),
+                   CircleXZ::Make(center, radius), visit);
+}
+
+template <typename Visitor>
+void SpatialIndex::ForEachAreaAt(const Vector3& position, Visitor&& visit) const {
+    const Cell* cell = findCell(WorldToCell(position));
+    if (cell == nullptr) {
+        return;
+    }
+    for (const auto& area : cell->areas) {
+        if (area.circle.Contains(position.x, position.z)) {
+            visit(area.id);
+        }
+    }
+}
+
+template <typename Visitor>
+void SpatialIndex::ForEachInCone(const Vector3& apex, const Vector3& direction, float radius,
+                                 float halfAngle, Visitor&& visit) const {
+    if (radius <= 0.0f || halfAngle < 0.0f) {
+        return;
+    }
+    forEachInShape(WorldToCell(Vector3{apex.x - radius, 0.0f, apex.z - radius}),
+                   WorldToCell(Vector3{apex.x + radius, 0.0f, apex.z + radius}),
+                   ConeXZ::Make(apex, direction, radius, halfAngle), visit);
+}
+
+template <typename Visitor>
+void SpatialIndex::ForEachInBox(const Vector3& min, const Vector3& max, Visitor&& visit) const {
+    if (min.x > max.x || min.z > max.z) {
+        return;
+    }
+    forEachInShape(WorldToCell(min), WorldToCell(max), BoxXZ{min.x, min.z, max.x, max.z}, visit);
+}
+
+template <typename Visitor>
+void SpatialIndex::forEachRingCell(CellCoord home, int32_t ring, Visitor&& visit) const {
+    const auto probe = [&](int32_t x, int32_t y) {
+        const Cell* cell = findCell(CellCoord{x, y});
+        if (cell != nullptr && !cell->entities.empty()) {
+            visit(*cell);
+        }
+    };
+    if (ring == 0) {
+        probe(home.x, home.y);
+        return;
+    }
+    for (int32_t x = home.x - ring; x <= home.x + ring; ++x) {
+        probe(x, home.y - ring);
+        probe(x, home.y + ring);
+    }
+    for (int32_t y = home.y - ring + 1; y < home.y + ring; ++y) {
+        probe(home.x - ring, y);
+        probe(home.x + ring, y);
+    }
+}
+
+template <typename Out, typename Filter>
+void SpatialIndex::QueryNearest(const Vector3& center, std::size_t k, Out& out, Filter&& filter,
+                                float maxRadius) const {
+    if (k == 0 || size_ == 0 || !(maxRadius > 0.0f)) {
+        return;
+    }
+    const auto distSq = [&center](float x, float z) {
+        const float dx = x - center.x;
+        const float dz = z - center.z;
+        return dx * dx + dz * dz;
+    };
+    const auto distSqOf = [&](cgs::ecs::Entity entity) {
+        const auto [x, z] = storedXZ(entity.id());
+        return distSq(x, z);
+    };
+
+    // Rings past the occupied bounds are empty; points in ring r + 1 are
+    // at least r cells away, so rings past maxRadius / cellSize + 1 are
+    // out of range.
+    const CellCoord home = WorldToCell(center);
+    int32_t lastRing = std::max({home.x - cellMin_.x, cellMax_.x - home.x, home.y - cellMin_.y,
+                                 cellMax_.y - home.y});
+    const float ringLimit = maxRadius / cellSize_ + 1.0f;
+    if (ringLimit < static_cast<float>(lastRing)) {
+        lastRing = static_cast<int32_t>(ringLimit);
+    }
+
+    // out[first, end) holds the best candidates so far, nearest first.
+    const auto first = static_cast<std::ptrdiff_t>(out.size());
+    std::size_t found = 0;
+    float worstSq = maxRadius * maxRadius;
+    for (int32_t ring = 0; ring <= lastRing; ++ring) {
+        forEachRingCell(home, ring, [&](const Cell& cell) {
+            for (std::size_t row = 0; row < cell.entities.size(); ++row) {
+                const float d = distSq(cell.xs[row], cell.zs[row]);
+                if (found == k ? d >= worstSq : d > worstSq) {
+                    continue;
+                }
+                const cgs::ecs::Entity entity = cell.entities[row];
+                if (!filter(entity)) {
+                    continue;
+                }
+                if (found == k) {
+                    out.pop_back();
+                } else {
+                    ++found;
+                }
+                out.insert(std::upper_bound(out.begin() + first, out.end(), d,
+                                            [&](float value, cgs::ecs::Entity other) {
+                                                return value < distSqOf(other);
+                                            }),
+                           entity);
+                if (found == k) {
+                    worstSq = distSqOf(out.back());
+                }
+            }
+        });
+        const float reach = static_cast<float>(ring) * cellSize_;
+        if (found == k && worstSq <= reach * reach) {
+            break;
+        }
+    }
+}
+
+template <typename Visitor>
+void SpatialIndex::traverseSegment(const Vector3& from, const Vector3& to, Visitor&& visit) const {
+    constexpr float kNever = std::numeric_limits<float>::infinity();
+    const float dx = to.x - from.x;
+    const float dz = to.z - from.z;
+    const float length = std::sqrt(dx * dx + dz * dz);
+
+    // Distance along the segment to the first boundary crossed on an
+    // axis, and between successive boundaries on it.
+    const auto firstCrossing = [&](int32_t cell, int32_t step, float origin, float delta) {
+        if (step == 0) {
+            return kNever;
+        }
+        const float boundary = static_cast<float>(step > 0 ? cell + 1 : cell) * cellSize_;
+        return (boundary - origin) / delta * length;
+    };
+    const auto spacing = [&](float delta) {
+        return delta != 0.0f ? cellSize_ / std::abs(delta) * length : kNever;
+    };
+
+    CellCoord cell = WorldToCell(from);
+    const CellCoord last = WorldToCell(to);
+    const int32_t stepX = dx > 0.0f ? 1 : (dx < 0.0f ? -1 : 0);
+    const int32_t stepY = dz > 0.0f ? 1 : (dz < 0.0f ? -1 : 0);
+    float nextX = firstCrossing(cell.x, stepX, from.x, dx);
+    float nextY = firstCrossing(cell.y, stepY, from.z, dz);
+    const float spacingX = spacing(dx);
+    const float spacingY = spacing(dz);
+
+    float enter = 0.0f;
+    for (;;) {
+        if (!visit(cell, enter) || cell == last) {
+            return;
+        }
+        // Never step past the last cell on an axis, whatever rounding says.
+        if (cell.y == last.y || (cell.x != last.x && nextX < nextY)) {
+            cell.x += stepX;
+            enter = nextX;
+            nextX += spacingX;
+        } else {
+            cell.y += stepY;
+            enter = nextY;
+            nextY += spacingY;
+        }
+    }
+}
+
+template <typename Proceed, typename Visitor>
+void SpatialIndex::forEachOnSegment(const Vector3& from, const Vector3& to,
+                                    const SegmentXZ& segment, Proceed&& proceed,
+                                    Visitor&& visit) const {
+    const int32_t pad = static_cast<int32_t>(std::ceil(std::sqrt(segment.radiusSq) / cellSize_));
+    traverseSegment(from, to, [&](CellCoord center, float enter) {
+        if (!proceed(enter)) {
+            return false;
+        }
+        for (int32_t cx = center.x - pad; cx <= center.x + pad; ++cx) {
+            for (int32_t cy = center.y - pad; cy <= center.y + pad; ++cy) {
+                const Cell* cell = findCell(CellCoord{cx, cy});
+                if (cell == nullptr) {
+                    continue;
+                }
+                ForEachMatch(cell->xs.data(), cell->zs.data(), cell->entities.size(), segment,
+                             [&](std::size_t row) {
+                                 visit(cell->entities[row],
+                                       segment.Along(cell->xs[row], cell->zs[row]));
+                             });
+            }
+        }
+        return true;
+    });
+}
+
+template <typename Filter>
+std::optional<SegmentHit> SpatialIndex::Raycast(const Vector3& from, const Vector3& to,
+                                                float radius, Filter&& filter) const {
+    std::optional<SegmentHit> best;
+    if (radius < 0.0f || size_ == 0) {
+        return best;
+    }
+    const SegmentXZ segment = SegmentXZ::Make(from, to, radius);
+
+    // An entity near a cell entered at distance e projects no earlier than
+    // e minus the diagonal of the (pad + 1)-cell block around it.
+    const float pad = std::ceil(radius / cellSize_);
+    const float slack = (pad + 1.0f) * cellSize_ * 1.5f;
+    forEachOnSegment(
+        from, to, segment, [&](float enter) { return !best || enter - slack <= best->distance; },
+        [&](cgs::ecs::Entity entity, float along) {
+            // Ties (e.g. several entities beside the start) go to the lower id.
+            const bool nearer = !best || along < best->distance ||
+                                (along == best->distance && entity.id() < best->entity.id());
+            if (nearer && filter(entity)) {
+                best = SegmentHit{entity, along};
+            }
+        });
+    return best;
+}
+
+template <typename Out>
+void SpatialIndex::QuerySegment(const Vector3& from, const Vector3& to, float radius,
+                                Out& out) const {
+    if (radius < 0.0f || size_ == 0) {
+        return;
+    }
+    const SegmentXZ segment = SegmentXZ::Make(from, to, radius);
+    const auto first = static_cast<std::ptrdiff_t>(out.size());
+    forEachOnSegment(
+        from, to, segment, [](float) { return true; },
+        [&out](cgs::ecs::Entity entity, float) { out.push_back(entity); });
+
+    // Widened cells overlap, so an entity can be appended more than once;
+    // copies sort next to each other.
+    const auto alongOf = [&](cgs::ecs::Entity entity) {
+        const auto [x, z] = storedXZ(entity.id());
+        return segment.Along(x, z);
+    };
+    std::sort(out.begin() + first, out.end(), [&](cgs::ecs::Entity lhs, cgs::ecs::Entity rhs) {
+        const float a = alongOf(lhs);
+        const float b = alongOf(rhs);
+        return a != b ? a < b : lhs.id() < rhs.id();
+    });
+    out.erase(std::unique(out.begin() + first, out.end()), out.end());
+}
+
 }  // namespace cgs::game
@@ -0,0 +1,142 @@
+#pragma once
+
+/// @file template_database.hpp
+/// @brief Immutable, id-indexed store of static game templates.
+///
+/// TemplateDatabase<T> holds the templates loaded at startup (items,
+/// quests, ...) sorted by id in one contiguous array and answers Find()
+/// in O(1): through a dense index when the ids are compact, otherwise
+/// through an open-addressing table sized at build time.  It never
+/// changes after Build(), so one instance can be shared by every system
+/// and read from any thread.
+///
+/// T must expose a `uint32_t id` member.
+///
+/// @see SRS-GML-006.1, SRS-GML-005.1
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace cgs::game {
+
+template <typename T>
+class TemplateDatabase {
+public:
+    /// Dense indexing is used while the id range spans at most this many
+    /// slots per template (plus a small allowance for tiny sets).
+    static constexpr std::size_t kMaxDenseSpread = 4;
+
+    /// Build a database from @p templates.  Later duplicates of an id
+    /// replace earlier ones, as repeated RegisterTemplate() calls do.
+    [[nodiscard]] static std::shared_ptr<const TemplateDatabase> Build(std::vector<T> templates) {
+        std::stable_sort(templates.begin(), templates.end(), [](const T& a, const T& b) {
+            return a.id < b.id;
+        });
+        // Keep the last of each run of equal ids.
+        std::vector<T> unique;
+        unique.reserve(templates.size());
+        for (std::size_t i = 0; i < templates.size(); ++i) {
+            if (i + 1 < templates.size() && templates[i + 1].id == templates[i].id) {
+                continue;
+            }
+            unique.push_back(std::move(templates[i]));
+        }
+        return std::shared_ptr<const TemplateDatabase>(new TemplateDatabase(std::move(unique)));
+    }
+
+    /// A copy of @p base with @p tmpl added (or replacing the same id).
+    /// O(n): meant for tools and tests, not for loading content.
+    [[nodiscard]] static std::shared_ptr<const TemplateDatabase> With(const TemplateDatabase* base,
+                                                                      T tmpl) {
+        std::vector<T> templates;
+        if (base != nullptr) {
+            templates.reserve(base->Size() + 1);
+            templates.assign(base->templates_.begin(), base->templates_.end());
+        }
+        templates.push_back(std::move(tmpl));
+        return Build(std::move(templates));
+    }
+
+    /// Template with @p id, or nullptr.
+    [[nodiscard]] const T* Find(uint32_t id) const noexcept {
+        if (!dense_.empty() || templates_.empty()) {
+            const uint32_t offset = id - minId_;
+            if (id < minId_ || offset >= dense_.size()) {
+                return nullptr;
+            }
+            const uint32_t index = dense_[offset];
+            return index == kEmpty ? nullptr : &templates_[index];
+        }
+        for (std::size_t slot = hash(id);; slot = (slot + 1) & mask_) {
+            const uint32_t index = table_[slot];
+            if (index == kEmpty) {
+                return nullptr;
+            }
+            if (templates_[index].id == id) {
+                return &templates_[index];
+            }
+        }
+    }
+
+    [[nodiscard]] bool Contains(uint32_t id) const noexcept { return Find(id) != nullptr; }
+
+    [[nodiscard]] std::size_t Size() const noexcept { return templates_.size(); }
+    [[nodiscard]] bool Empty() const noexcept { return templates_.empty(); }
+
+    /// Every template, ascending by id.
+    [[nodiscard]] const std::vector<T>& All() const noexcept { return templates_; }
+
+    [[nodiscard]] auto begin() const noexcept { return templates_.begin(); }
+    [[nodiscard]] auto end() const noexcept { return templates_.end(); }
+
+    /// True when Find() goes through the dense index.
+    [[nodiscard]] bool IsDense() const noexcept { return !dense_.empty(); }
+
+private:
+    static constexpr uint32_t kEmpty = UINT32_MAX;
+
+    explicit TemplateDatabase(std::vector<T> sorted) : templates_(std::move(sorted)) {
+        if (templates_.empty()) {
+            return;
+        }
+        minId_ = templates_.front().id;
+        const std::size_t span = std::size_t{templates_.back().id} - minId_ + 1;
+        if (span <= kMaxDenseSpread * templates_.size() + 64) {
+            dense_.assign(span, kEmpty);
+            for (std::size_t i = 0; i < templates_.size(); ++i) {
+                dense_[templates_[i].id - minId_] = static_cast<uint32_t>(i);
+            }
+            return;
+        }
+        // Load factor at most 1/2 keeps probe runs short.
+        const std::size_t capacity = std::bit_ceil(templates_.size() * 2);
+        mask_ = capacity - 1;
+        shift_ = 64 - std::countr_zero(capacity);
+        table_.assign(capacity, kEmpty);
+        for (std::size_t i = 0; i < templates_.size(); ++i) {
+            std::size_t slot = hash(templates_[i].id);
+            while (table_[slot] != kEmpty) {
+                slot = (slot + 1) & mask_;
+            }
+            table_[slot] = static_cast<uint32_t>(i);
+        }
+    }
+
+    /// Fibonacci hashing: the top bits of id * 2^64/phi.
+    [[nodiscard]] std::size_t hash(uint32_t id) const noexcept {
+        return static_cast<std::size_t>((uint64_t{id} * 0x9E3779B97F4A7C15ull) >> shift_) & mask_;
+    }
+
+    std::vector<T> templates_;  ///< Sorted by id.
+    uint32_t minId_ = 0;
+    std::vector<uint32_t> dense_;  ///< id - minId_ -> index, or kEmpty.
+    std::vector<uint32_t> table_;  ///< Open addressing: slot -> index, or kEmpty.
+    std::size_t mask_ = 0;
+    int shift_ = 63;
+};
+
+}  // namespace cgs::game
@@ -0,0 +1,363 @@
+#pragma once
+
+/// @file timer_wheel.hpp
+/// @brief Hierarchical timer wheel for timed game effects.
+///
+/// TimerWheel keeps pending timers in four levels of 256 slots each,
+/// indexed by successive byte ranges of the deadline tick, plus an
+/// overflow list for deadlines more than 2^32 ticks ahead.  Schedule()
+/// and Cancel() are O(1); Advance() touches only the slots it steps
+/// over and the timers due in them, so systems driven by the wheel pay
+/// for what expires rather than for every active effect.
+///
+/// Per-level occupancy bitmaps let Advance() jump straight to the next
+/// tick that fires or cascades, so long gaps between deadlines cost a
+/// few bit scans rather than one step per tick.
+///
+/// Timers carry a 64-bit payload that the owner decodes when they fire.
+/// The wheel allocates only when its node pool grows.
+///
+/// @see SRS-GML-002.2
+/// @see SDS-MOD-021
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cgs::game {
+
+/// Handle to a scheduled timer.  Stale once the timer fires or is
+/// cancelled; slots are generation-checked, so a stale handle never
+/// matches a newer timer.
+struct TimerId {
+    static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+    uint32_t index = kInvalidIndex;
+    uint32_t generation = 0;
+
+    [[nodiscard]] constexpr bool IsValid() const noexcept { return index != kInvalidIndex; }
+
+    constexpr bool operator==(const TimerId&) const = default;
+};
+
+/// Hierarchical timer wheel with a fixed tick resolution.
+///
+/// Time is counted in integer ticks (1 ms by default).  Delays round up
+/// to the next tick and every timer fires on the first Advance() that
+/// reaches its deadline, never from inside Schedule().  Timers due in
+/// the same Advance() fire in deadline order; timers sharing a tick fire
+/// in unspecified order.  The visitor may schedule and cancel timers,
+/// including timers due later in the same Advance().
+///
+/// Not thread-safe: each system owns the wheel for its own effects.
+class TimerWheel {
+public:
+    static constexpr uint32_t kDefaultTicksPerSecond = 1000;
+
+    explicit TimerWheel(uint32_t ticksPerSecond = kDefaultTicksPerSecond)
+        : ticksPerSecond_(static_cast<double>(std::max(ticksPerSecond, 1u))) {
+        heads_.fill(kNil);
+    }
+
+    /// Schedule @p payload to fire @p delay seconds from now (at least
+    /// one tick ahead).
+    TimerId Schedule(float delay, uint64_t payload) {
+        return ScheduleAt(now_ + std::max<uint64_t>(ToTicks(delay), 1), payload);
+    }
+
+    /// Schedule @p payload to fire at absolute tick @p deadline; past
+    /// deadlines fire on the next tick.
+    TimerId ScheduleAt(uint64_t deadline, uint64_t payload) {
+        uint32_t index;
+        if (!free_.empty()) {
+            index = free_.back();
+            free_.pop_back();
+        } else {
+            index = static_cast<uint32_t>(nodes_.size());
+            nodes_.emplace_back();
+        }
+        Node& node = nodes_[index];
+        node.deadline = std::max(deadline, now_ + 1);
+        node.payload = payload;
+        place(index);
+        ++size_;
+        return TimerId{index, node.generation};
+    }
+
+    /// Cancel a pending timer.
+    /// @return false if @p id already fired, was cancelled, or is invalid.
+    bool Cancel(TimerId id) {
+        if (!IsPending(id)) {
+            return false;
+        }
+        unlink(id.index);
+        release(id.index);
+        return true;
+    }
+
+    /// Check whether @p id is still waiting to fire.
+    [[nodiscard]] bool IsPending(TimerId id) const noexcept {
+        return id.index < nodes_.size() && nodes_[id.index].generation == id.generation &&
+               nodes_[id.index].bucket != kFreeBucket;
+    }
+
+    /// Deadline tick of a pending timer (0 if @p id is not pending).
+    [[nodiscard]] uint64_t DeadlineOf(TimerId id) const noexcept {
+        return IsPending(id) ? nodes_[id.index].deadline : 0;
+    }
+
+    /// Advance the clock by @p deltaTime seconds, calling
+    /// `visit(payload)` for every timer that comes due.
+    /// @return Number of timers fired.
+    template <typename Visit>
+    std::size_t Advance(float deltaTime, Visit&& visit) {
+        elapsed_ += std::max(static_cast<double>(deltaTime), 0.0);
+        const auto target =
+            static_cast<uint64_t>(std::floor(elapsed_ * ticksPerSecond_ + kEpsilon));
+        return AdvanceTo(std::max(target, now_), visit);
+    }
+
+    /// Advance the clock to absolute tick @p tick.
+    /// @return Number of timers fired.
+    template <typename Visit>
+    std::size_t AdvanceTo(uint64_t tick, Visit&& visit) {
+        std::size_t fired = 0;
+        while (now_ < tick) {
+            // Ticks before the next event neither fire nor cascade.
+            now_ = size_ == 0 ? tick : std::min(nextEventTick(), tick);
+            cascade();
+            fired += fire(visit);
+        }
+        if (elapsed_ * ticksPerSecond_ + kEpsilon < static_cast<double>(now_)) {
+            elapsed_ = static_cast<double>(now_) / ticksPerSecond_;
+        }
+        return fired;
+    }
+
+    /// Cancel every pending timer.  The clock keeps its value.
+    void Clear() {
+        for (uint32_t i = 0; i < nodes_.size(); ++i) {
+            if (nodes_[i].bucket != kFreeBucket) {
+                release(i);
+            }
+        }
+        heads_.fill(kNil);
+        occupied_.fill(0);
+    }
+
+    /// Seconds converted to whole ticks, rounded up.
+    [[nodiscard]] uint64_t ToTicks(float seconds) const noexcept {
+        const double ticks = static_cast<double>(seconds) * ticksPerSecond_ - kEpsilon;
+        return ticks > 0.0 ? static_cast<uint64_t>(std::ceil(ticks)) : 0;
+    }
+
+    /// Ticks converted to seconds.
+    [[nodiscard]] float ToSeconds(uint64_t ticks) const noexcept {
+        return static_cast<float>(static_cast<double>(ticks) / ticksPerSecond_);
+    }
+
+    /// Current tick.
+    [[nodiscard]] uint64_t Now() const noexcept { return now_; }
+
+    /// Number of pending timers.
+    [[nodiscard]] std::size_t Size() const noexcept { return size_; }
+
+    [[nodiscard]] bool Empty() const noexcept { return size_ == 0; }
+
+private:
+    static constexpr uint32_t kSlotBits = 8;
+    static constexpr uint32_t kSlots = 1u << kSlotBits;
+    static constexpr uint64_t kSlotMask = kSlots - 1;
+    static constexpr uint32_t kLevels = 4;
+    static constexpr uint32_t kOverflowBucket = kLevels * kSlots;
+    static constexpr uint32_t kFiringBucket = kOverflowBucket + 1;
+    static constexpr uint32_t kBucketCount = kFiringBucket + 1;
+    static constexpr uint32_t kFreeBucket = UINT32_MAX;
+    static constexpr uint32_t kNil = UINT32_MAX;
+    static constexpr uint32_t kWordsPerLevel = kSlots / 64;
+
+    /// Absorbs float noise when converting seconds to ticks.
+    static constexpr double kEpsilon = 1e-3;
+
+    struct Node {
+        uint64_t deadline = 0;
+        uint64_t payload = 0;
+        uint32_t prev = kNil;
+        uint32_t next = kNil;
+        uint32_t bucket = kFreeBucket;
+        uint32_t generation = 0;
+    };
+
+    /// Link @p index into the slot its deadline falls in.
+    void place(uint32_t index) {
+        const uint64_t deadline = std::max(nodes_[index].deadline, now_);
+        const uint64_t delta = deadline - now_;
+        for (uint32_t level = 0; level < kLevels; ++level) {
+            if (delta < (uint64_t{1} << (kSlotBits * (level + 1)))) {
+                link(index,
+                     level * kSlots +
+                         static_cast<uint32_t>((deadline >> (kSlotBits * level)) & kSlotMask));
+                return;
+            }
+        }
+        link(index, kOverflowBucket);
+    }
+
+    /// Earliest tick after now_ whose level-0 slot is occupied or whose
+    /// cascade moves timers.  Lower levels always come due first, so the
+    /// first level with an occupied slot ahead of its cursor decides;
+    /// a level holding only slots of its next revolution waits for the
+    /// level above to wrap.
+    [[nodiscard]] uint64_t nextEventTick() const noexcept {
+        for (uint32_t level = 0; level < kLevels; ++level) {
+            const uint32_t shift = kSlotBits * level;
+            const auto cursor = static_cast<uint32_t>((now_ >> shift) & kSlotMask);
+            const uint32_t slot = nextOccupied(level, cursor + 1);
+            if (slot < kSlots) {
+                return ((now_ >> shift) + (slot - cursor)) << shift;
+            }
+            if (nextOccupied(level, 0) < kSlots) {
+                return ((now_ >> (shift + kSlotBits)) + 1) << (shift + kSlotBits);
+            }
+        }
+        // Only the overflow list is left: it is re-placed when level 3 wraps.
+        return ((now_ >> (kSlotBits * kLevels)) + 1) << (kSlotBits * kLevels);
+    }
+
+    /// First occupied slot of @p level at or after @p from (kSlots if none).
+    [[nodiscard]] uint32_t nextOccupied(uint32_t level, uint32_t from) const noexcept {
+        for (uint32_t word = from / 64; word < kWordsPerLevel; ++word) {
+            uint64_t bits = occupied_[level * kWordsPerLevel + word];
+            if (word == from / 64) {
+                bits &= ~uint64_t{0} << (from % 64);
+            }
+            if (bits != 0) {
+                return word * 64 + static_cast<uint32_t>(std::countr_zero(bits));
+            }
+        }
+        return kSlots;
+    }
+
+    void setOccupied(uint32_t bucket, bool occupied) noexcept {
+        if (bucket >= kOverflowBucket) {
+            return;
+        }
+        const uint64_t bit = uint64_t{1} << (bucket % 64);
+        if (occupied) {
+            occupied_[bucket / 64] |= bit;
+        } else {
+            occupied_[bucket / 64] &= ~bit;
+        }
+    }
+
+    /// Re-place every timer of @p bucket relative to the current tick.
+    void redistribute(uint32_t bucket) {
+        uint32_t index = heads_[bucket];
+        heads_[bucket] = kNil;
+        setOccupied(bucket, false);
+        while (index != kNil) {
+            const uint32_t next = nodes_[index].next;
+            place(index);
+            index = next;
+        }
+    }
+
+    /// Pull timers down from the levels whose slot index wrapped at now_.
+    void cascade() {
+        if ((now_ & kSlotMask) != 0) {
+            return;
+        }
+        uint32_t wrapped = 1;
+        while (wrapped < kLevels && ((now_ >> (kSlotBits * wrapped)) & kSlotMask) == 0) {
+            ++wrapped;
+        }
+        if (wrapped == kLevels) {
+            redistribute(kOverflowBucket);
+        }
+        for (uint32_t level = std::min(wrapped, kLevels - 1); level >= 1; --level) {
+            redistribute(level * kSlots +
+                         static_cast<uint32_t>((now_ >> (kSlotBits * level)) & kSlotMask));
+        }
+    }
+
+    /// Fire the level-0 slot of now_.
+    template <typename Visit>
+    std::size_t fire(Visit& visit) {
+        const auto slot = static_cast<uint32_t>(now_ & kSlotMask);
+        if (heads_[slot] == kNil) {
+            return 0;
+        }
+        // Move the slot to the firing list so the visitor can cancel
+        // timers of this tick that have not fired yet.
+        for (uint32_t i = heads_[slot]; i != kNil; i = nodes_[i].next) {
+            nodes_[i].bucket = kFiringBucket;
+        }
+        heads_[kFiringBucket] = heads_[slot];
+        heads_[slot] = kNil;
+        setOccupied(slot, false);
+
+        std::size_t fired = 0;
+        while (heads_[kFiringBucket] != kNil) {
+            const uint32_t index = heads_[kFiringBucket];
+            const uint64_t payload = nodes_[index].payload;
+            unlink(index);
+            release(index);
+            ++fired;
+            visit(payload);
+        }
+        return fired;
+    }
+
+    void link(uint32_t index, uint32_t bucket) {
+        Node& node = nodes_[index];
+        node.bucket = bucket;
+        node.prev = kNil;
+        node.next = heads_[bucket];
+        if (node.next != kNil) {
+            nodes_[node.next].prev = index;
+        }
+        heads_[bucket] = index;
+        setOccupied(bucket, true);
+    }
+
+    void unlink(uint32_t index) {
+        Node& node = nodes_[index];
+        if (node.prev != kNil) {
+            nodes_[node.prev].next = node.next;
+        } else {
+            heads_[node.bucket] = node.next;
+            if (node.next == kNil) {
+                setOccupied(node.bucket, false);
+            }
+        }
+        if (node.next != kNil) {
+            nodes_[node.next].prev = node.prev;
+        }
+        node.prev = kNil;
+        node.next = kNil;
+    }
+
+    /// Return an unlinked node to the pool, invalidating its handles.
+    void release(uint32_t index) {
+        Node& node = nodes_[index];
+        node.bucket = kFreeBucket;
+        ++node.generation;
+        free_.push_back(index);
+        --size_;
+    }
+
+    double ticksPerSecond_;
+    double elapsed_ = 0.0;  ///< Seconds advanced, for sub-tick carry.
+    uint64_t now_ = 0;
+    std::size_t size_ = 0;
+    std::vector<Node> nodes_;
+    std::vector<uint32_t> free_;
+    std::array<uint32_t, kBucketCount> heads_{};
+    std::array<uint64_t, kLevels * kWordsPerLevel> occupied_{};  ///< Non-empty level slots.
+};
+
+}  // namespace cgs::game
@@ -28,6 +28,15 @@ struct MapInstance {
     uint32_t mapId = 0;
     uint32_t instanceId = 0;
     MapType type = MapType::OpenWorld;
+
+    /// Spatial grid cell edge in world units; 0 uses the WorldSystem's
+    /// cell size.
+    float cellSize = 0.0f;
+
+    /// Fine cells per coarse cell edge of the map's two-level grid; 0 or
+    /// 1 keeps a single-level grid.  Worth enabling on maps queried with
+    /// long visibility ranges (see SpatialIndex).
+    uint32_t coarseFactor = 0;
 };
 
 // -- Zone (SRS-GML-003.2) ---------------------------------------------------
@@ -18,18 +18,87 @@
 #include "cgs/game/world_components.hpp"
 
 #include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory_resource>
+#include <optional>
+#include <span>
 #include <string_view>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace cgs::game {
 
+/// Kind of InterestEvent.
+enum class InterestChange : uint8_t {
+    Enter,  ///< Subject became visible to the viewer (send full state).
+    Leave,  ///< Subject is no longer visible (despawn it for the viewer).
+    Update  ///< Visible subject's Transform changed this tick.
+};
+
+/// One entry of a viewer's per-tick interest diff.
+struct InterestEvent {
+    cgs::ecs::Entity viewer;
+    cgs::ecs::Entity subject;
+    InterestChange change = InterestChange::Update;
+
+    constexpr bool operator==(const InterestEvent&) const = default;
+};
+
+/// Identifier of a WorldSystem area effect; 0 is never issued.
+using AreaEffectId = uint32_t;
+
+/// AreaEffectId that names no area effect.
+inline constexpr AreaEffectId kInvalidAreaEffect = 0;
+
+/// A persistent ground-targeted area, e.g. a fire patch, healing circle
+/// or trap.
+struct AreaEffectDesc {
+    cgs::ecs::Entity mapEntity;
+    Vector3 center;
+    float radius = 0.0f;    ///< XZ radius, world units.
+    float period = 0.0f;    ///< Seconds between pulses; 0 for enter/exit only.
+    float duration = 0.0f;  ///< Seconds until removed; 0 until RemoveAreaEffect().
+};
+
+/// Kind of AreaEffectEvent.
+enum class AreaEffectChange : uint8_t {
+    Enter,  ///< Entity is now inside the area.
+    Exit    ///< Entity left, changed maps, was destroyed, or the area ended.
+};
+
+/// An entity entering or leaving an area effect.
+struct AreaEffectEvent {
+    AreaEffectId area = kInvalidAreaEffect;
+    cgs::ecs::Entity entity;
+    AreaEffectChange change = AreaEffectChange::Enter;
+
+    constexpr bool operator==(const AreaEffectEvent&) const = default;
+};
+
+/// An area effect whose period elapsed during the last Execute().
+struct AreaEffectPulse {
+    AreaEffectId area = kInvalidAreaEffect;
+    uint32_t count = 0;  ///< Periods elapsed (above 1 only on long ticks).
+
+    constexpr bool operator==(const AreaEffectPulse&) const = default;
+};
+
+/// One entry of WorldSystem::TransferEntities().
+struct TransferRequest {
+    cgs::ecs::Entity entity;
+    cgs::ecs::Entity targetMapEntity;
+    Vector3 destination;
+};
+
 /// System that manages world spatial indexing, interest management,
 /// and map transitions.
 ///
 /// Execution each tick:
 ///   1. Synchronize entity positions into per-map spatial indices.
-///   2. (Interest management queries are available via GetVisibleEntities.)
+///   2. Update area effect occupancy for the entities that moved.
+///   3. (Interest management queries are available via GetVisibleEntities.)
 ///
 /// Map transitions are performed on-demand via TransferEntity().
 class WorldSystem final : public cgs::ecs::ISystem {
@@ -60,12 +129,74 @@ public:
     /// MapMembership.
     [[nodiscard]] std::vector<cgs::ecs::Entity> GetVisibleEntities(cgs::ecs::Entity viewer) const;
 
+    /// Append the entities visible to @p viewer to @p out.
+    ///
+    /// Lets callers inside a tick keep the result in frame memory.
+    void GetVisibleEntities(cgs::ecs::Entity viewer, std::pmr::vector<cgs::ecs::Entity>& out) const;
+
+    /// Append the entities visible to @p viewer to a reused @p out.
+    void GetVisibleEntities(cgs::ecs::Entity viewer, std::vector<cgs::ecs::Entity>& out) const;
+
+    /// Invoke @p visit(Entity) for every entity visible to @p viewer.
+    template <typename Visitor>
+    void ForEachVisible(cgs::ecs::Entity viewer, Visitor&& visit) const;
+
     /// Return all entities in a given radius from a world position
     /// within a specific map instance entity.
     [[nodiscard]] std::vector<cgs::ecs::Entity> QueryRadius(cgs::ecs::Entity mapEntity,
                                                             const Vector3& center,
                                                             float radius) const;
 
+    /// Append the entities within @p radius of @p center to @p out.
+    ///
+    /// Grid candidates are filtered as they are visited, so only @p out
+    /// may allocate.
+    void QueryRadius(cgs::ecs::Entity mapEntity, const Vector3& center, float radius,
+                     std::pmr::vector<cgs::ecs::Entity>& out) const;
+
+    /// Append the entities within @p radius of @p center to a reused @p out.
+    void QueryRadius(cgs::ecs::Entity mapEntity, const Vector3& center, float radius,
+                     std::vector<cgs::ecs::Entity>& out) const;
+
+    /// Invoke @p visit(Entity) for every entity within @p radius (XZ
+    /// distance) of @p center, without building a list.  Distances use
+    /// the positions synced at the last Execute() or TransferEntity().
+    /// @p visit must not move entities or add or remove Transforms.
+    template <typename Visitor>
+    void ForEachInRadius(cgs::ecs::Entity mapEntity, const Vector3& center, float radius,
+                         Visitor&& visit) const;
+
+    /// Return the entities in the XZ cone at @p apex facing @p direction
+    /// with the given radius and half angle (radians), e.g. for frontal
+    /// area-of-effect abilities.
+    [[nodiscard]] std::vector<cgs::ecs::Entity> QueryCone(cgs::ecs::Entity mapEntity,
+                                                          const Vector3& apex,
+                                                          const Vector3& direction,
+                                                          float radius,
+                                                          float halfAngle) const;
+
+    /// Visitor form of QueryCone(), with the ForEachInRadius() rules.
+    template <typename Visitor>
+    void ForEachInCone(cgs::ecs::Entity mapEntity, const Vector3& apex, const Vector3& direction,
+                       float radius, float halfAngle, Visitor&& visit) const;
+
+    /// Append to @p out the (at most) @p k entities nearest to @p center
+    /// on @p mapEntity that pass @p filter(Entity), nearest first, e.g.
+    /// for AI target selection.  See SpatialIndex::QueryNearest().
+    template <typename Out, typename Filter>
+    void QueryNearest(cgs::ecs::Entity mapEntity, const Vector3& center, std::size_t k, Out& out,
+                      Filter&& filter,
+                      float maxRadius = std::numeric_limits<float>::infinity()) const;
+
+    /// First entity on @p mapEntity within @p radius of the XZ segment
+    /// from @p from to @p to that passes @p filter(Entity), or nullopt.
+    /// A line of sight check filters out the shooter and the target.
+    /// See SpatialIndex::Raycast().
+    template <typename Filter>
+    [[nodiscard]] std::optional<SegmentHit> Raycast(cgs::ecs::Entity mapEntity,
+                                                    const Vector3& from, const Vector3& to,
+                                                    float radius, Filter&& filter) const;
+
     // -- Map transitions (SRS-GML-003.5) --------------------------------
 
     /// Transfer an entity from its current map to a new map instance
@@ -79,8 +210,90 @@ public:
                                                   cgs::ecs::Entity targetMapEntity,
                                                   const Vector3& destination);
 
+    /// TransferEntity() for a group, e.g. a raid entering a dungeon.
+    ///
+    /// Requests are validated and applied to Transform and MapMembership
+    /// in order.  Spatial index entries are then moved in bulk: each
+    /// source index drops its entities, and each destination map gets one
+    /// SpatialIndex::UpdateBatch().  Interest sets see the whole group in
+    /// the next Execute(), as one set of events.  If an entity appears
+    /// more than once, its last request wins.
+    ///
+    /// @param results  Per-request outcome; ignored when empty, otherwise
+    ///                 must be at least as long as @p requests.
+    /// @return Number of successful requests.
+    std::size_t TransferEntities(std::span<const TransferRequest> requests,
+                                 std::span<TransitionResult> results = {});
+
+    // -- Area effects ---------------------------------------------------
+
+    /// Create a persistent area effect.
+    ///
+    /// The area is registered in the cells of its map's SpatialIndex.
+    /// Each Execute() checks only the entities that moved or changed maps
+    /// against the areas in their new cell, and publishes who entered or
+    /// left.  A siege with hundreds of overlapping patches costs nothing
+    /// for entities standing still, and no area queries the grid per
+    /// pulse.  Occupants are seeded at the next Execute(), where their
+    /// Enter events appear.
+    ///
+    /// @return The new id, or kInvalidAreaEffect if the radius is not
+    ///         positive or the period or duration is negative.
+    AreaEffectId CreateAreaEffect(const AreaEffectDesc& desc);
+
+    /// End an area effect.  It is dropped, with an Exit event per
+    /// occupant, at the next Execute().
+    /// @return false if @p area is not live.
+    bool RemoveAreaEffect(AreaEffectId area);
+
+    /// True from CreateAreaEffect() until the Execute() that ends it.
+    [[nodiscard]] bool HasAreaEffect(AreaEffectId area) const;
+
+    /// Entities inside @p area as of the last Execute(), sorted.  A pulse
+    /// handler applies its effect to exactly these.
+    [[nodiscard]] std::span<const cgs::ecs::Entity> AreaEffectOccupants(AreaEffectId area) const;
+
+    /// Enter/Exit events of the last Execute(), sorted by area, then
+    /// entity.
+    [[nodiscard]] std::span<const AreaEffectEvent> AreaEffectEvents() const noexcept {
+        return areaEvents_;
+    }
+
+    /// Areas whose period elapsed during the last Execute(), by id.
+    [[nodiscard]] std::span<const AreaEffectPulse> AreaEffectPulses() const noexcept {
+        return areaPulses_;
+    }
+
+    /// Number of live area effects.
+    [[nodiscard]] std::size_t AreaEffectCount() const noexcept { return areaEffects_.size(); }
+
     // -- Accessors ------------------------------------------------------
 
+    // -- Incremental interest management ------------------------------
+
+    /// Maintain a persistent interest set for every viewer (an entity with
+    /// VisibilityRange, MapMembership and Transform) and publish its
+    /// enter/leave/update diff each Execute().
+    ///
+    /// Sets are cell-granular.  A subject enters when its cell is within
+    /// ceil(range / cellSize) cells (Chebyshev) of the viewer's cell.  It
+    /// leaves only once it is more than @p hysteresisCells further out,
+    /// so entities on a border do not flicker.  Sets change only when a
+    /// viewer or subject crosses a cell; viewers never see themselves.
+    /// Disabling drops every set.
+    void SetInterestManagement(bool enabled, uint32_t hysteresisCells = 1);
+
+    [[nodiscard]] bool InterestManagementEnabled() const noexcept { return interestEnabled_; }
+
+    /// Events of the last Execute(), sorted by viewer, then subject.  An
+    /// Enter is never accompanied by an Update for the same pair.
+    [[nodiscard]] std::span<const InterestEvent> InterestEvents() const noexcept {
+        return interestEvents_;
+    }
+
+    /// Current interest set of @p viewer, sorted (empty if not a viewer).
+    [[nodiscard]] std::span<const cgs::ecs::Entity> InterestSet(cgs::ecs::Entity viewer) const;
+
     /// Get the spatial index for a given map instance entity.
     ///
     /// @return Pointer to the index, or nullptr if the map has no index.
@@ -89,20 +302,117 @@ public:
     /// Number of tracked map spatial indices.
     [[nodiscard]] std::size_t MapCount() const noexcept { return spatialIndices_.size(); }
 
+    // -- Storage layout -------------------------------------------------
+
+    /// Keep the Transform pool in Morton order of the entities' cells,
+    /// moving at most @p entitiesPerTick components per tick (0 = off).
+    ///
+    /// Each pass snapshots the order once and applies it over as many
+    /// ticks as the budget requires, so neighbours in the world end up
+    /// neighbours in memory without one frame paying for a full sort.
+    /// While enabled the system writes Transform; call this before
+    /// SystemScheduler::Build() so the scheduler sees the access.
+    void SetSpatialReorder(uint32_t entitiesPerTick) noexcept { reorderBudget_ = entitiesPerTick; }
+
+    /// Executor for the per-map index updates of each tick.
+    ///
+    /// Moved entities are grouped per map and every map's batch is one
+    /// task, so the sync scales with cores and with the number of moved
+    /// entities.  Without an executor, or with a single busy map, the
+    /// batches run inline.  The executor must accept a batch from inside
+    /// Execute(): the scheduler's own WorkStealingExecutor cannot be used
+    /// while it is running the system's batch.
+    void SetParallelExecutor(cgs::ecs::SystemScheduler::ParallelExecutor executor) {
+        parallelExecutor_ = std::move(executor);
+    }
+
+    /// Components moved per tick by the reorder pass (0 = off).
+    [[nodiscard]] uint32_t SpatialReorderBudget() const noexcept { return reorderBudget_; }
+
+    /// Number of completed reorder passes.
+    [[nodiscard]] uint64_t SpatialReorderPasses() const noexcept { return reorderPasses_; }
+
     // -- Zone queries ---------------------------------------------------
 
     /// Get the zone flags for an entity's current zone.
     ///
     /// Looks up the entity's MapMembership to find its zoneId,
-    /// then searches for a matching Zone component.
+    /// then the matching Zone component of the same map.
     /// Returns ZoneFlags::None if no zone is found.
+    ///
+    /// Execute() rebuilds a per-map zoneId -> flags index whenever the
+    /// Zone storage has changed, so lookups are O(1).  Until then (zones
+    /// added, removed or Replace()d since the last run) this falls back
+    /// to scanning the Zone storage, so results are never stale.  Zones
+    /// edited in place through a mutable Get() must be marked changed.
     [[nodiscard]] ZoneFlags GetEntityZoneFlags(cgs::ecs::Entity entity) const;
 
 private:
-    /// Synchronize all entities with MapMembership into their
-    /// respective spatial indices.
+    /// Synchronize entities with MapMembership into their respective
+    /// spatial indices, skipping those whose Transform and MapMembership
+    /// are unchanged since LastRunVersion().
     void synchronizePositions();
 
+    /// Apply up to reorderBudget_ steps of the current reorder pass,
+    /// starting a new pass when the previous one is complete.
+    void reorderTransforms();
+
+    /// Snapshot the (map, Morton cell) order of the Transform pool.
+    void planReorder();
+
+    /// A viewer's persistent interest state.
+    struct ViewerInterest {
+        cgs::ecs::Entity map;
+        CellCoord cell;
+        int32_t enterRing = 0;                  ///< Cells (Chebyshev) to enter.
+        std::vector<cgs::ecs::Entity> visible;  ///< Sorted.
+    };
+
+    /// Refresh viewers, apply cell crossings and emit this tick's events.
+    void updateInterest();
+
+    /// Rebuild @p interest around its (new) cell and emit the diff.
+    void recomputeInterest(cgs::ecs::Entity viewer, ViewerInterest& interest,
+                           const SpatialIndex& index);
+
+    /// Apply the cell changes logged by @p index to nearby viewers that
+    /// were not recomputed this tick.
+    void applySubjectChanges(cgs::ecs::Entity mapEntity, const SpatialIndex& index);
+
+    /// Emit a Leave for everything @p interest holds and empty it.
+    void dropInterest(cgs::ecs::Entity viewer, ViewerInterest& interest);
+
+    /// A live area effect.
+    struct AreaEffect {
+        AreaEffectDesc desc;
+        float sincePulse = 0.0f;
+        float age = 0.0f;
+        bool seeded = false;   ///< Registered and occupants collected.
+        bool ending = false;   ///< RemoveAreaEffect() or duration reached.
+        std::vector<cgs::ecs::Entity> occupants;  ///< Sorted.
+    };
+
+    /// End expired areas, drop stale occupants, seed new areas, check the
+    /// entities that moved this tick and collect pulses.
+    void updateAreaEffects(float deltaTime);
+
+    /// Re-evaluate the areas containing @p entity at its current position.
+    void refreshAreaMembership(cgs::ecs::Entity entity);
+
+    /// Record @p entity entering or leaving @p id.
+    void enterArea(AreaEffectId id, AreaEffect& area, cgs::ecs::Entity entity);
+    void exitArea(AreaEffectId id, AreaEffect& area, cgs::ecs::Entity entity);
+
+    /// Rebuild zoneFlags_ if the Zone storage changed since it was built.
+    void refreshZoneIndex();
+
+    /// GetEntityZoneFlags() by scanning the Zone storage.
+    [[nodiscard]] ZoneFlags scanZoneFlags(const MapMembership& membership) const;
+
+    /// The spatial index of @p mapEntity, created on first use with the
+    /// map's MapInstance grid settings (or cellSize_ if it has none).
+    SpatialIndex& indexFor(cgs::ecs::Entity mapEntity);
+
     cgs::ecs::ComponentStorage<Transform>& transforms_;
     cgs::ecs::ComponentStorage<MapMembership>& memberships_;
     cgs::ecs::ComponentStorage<MapInstance>& mapInstances_;
@@ -112,7 +422,129 @@ private:
     /// Per-map-entity spatial index.
     std::unordered_map<cgs::ecs::Entity, SpatialIndex> spatialIndices_;
 
+    /// Per-map zoneId -> flags, valid while zones_.GlobalVersion() equals
+    /// zoneIndexVersion_.
+    std::unordered_map<cgs::ecs::Entity, std::unordered_map<uint32_t, ZoneFlags>> zoneFlags_;
+    uint32_t zoneIndexVersion_ = 0;
+    bool zoneIndexBuilt_ = false;
+
+    /// One map's pending position updates for the current tick.
+    struct MapSync {
+        SpatialIndex* index = nullptr;
+        std::vector<SpatialUpdate> updates;
+    };
+
+    /// Per-map update batches, kept across ticks for their capacity.
+    std::unordered_map<cgs::ecs::Entity, MapSync> syncBatches_;
+    std::vector<std::function<void()>> syncTasks_;
+    cgs::ecs::SystemScheduler::ParallelExecutor parallelExecutor_;
+
+    // Incremental interest management (see SetInterestManagement()).
+    bool interestEnabled_ = false;
+    int32_t interestHysteresis_ = 1;
+    int32_t maxInterestRing_ = 0;  ///< Largest enterRing + hysteresis.
+    std::unordered_map<cgs::ecs::Entity, ViewerInterest> interest_;
+    std::unordered_map<cgs::ecs::Entity, SpatialIndex> viewerIndices_;  ///< Viewers per map.
+    std::vector<InterestEvent> interestEvents_;
+    std::vector<cgs::ecs::Entity> interestScratch_;
+    std::vector<cgs::ecs::Entity> recomputedViewers_;  ///< Sorted, this tick.
+    std::vector<cgs::ecs::Entity> candidateViewers_;
+    std::vector<CellChange> changeScratch_;
+
+    // Area effects (see CreateAreaEffect()).
+    std::unordered_map<AreaEffectId, AreaEffect> areaEffects_;
+    std::unordered_map<cgs::ecs::Entity, std::vector<AreaEffectId>> areaMemberships_;  ///< Sorted.
+    std::vector<cgs::ecs::Entity> areaRechecks_;  ///< Transferred since the last Execute().
+    std::vector<AreaEffectEvent> areaEvents_;
+    std::vector<AreaEffectPulse> areaPulses_;
+    std::vector<AreaEffectId> areaScratch_;    ///< Areas at a moved entity.
+    std::vector<AreaEffectId> areaPrevious_;   ///< Its memberships before the move.
+    AreaEffectId nextAreaEffect_ = 1;
+
     float cellSize_;
+
+    // Incremental Transform reordering (see SetSpatialReorder()).
+    uint32_t reorderBudget_ = 0;
+    std::vector<uint32_t> reorderPlan_;  ///< Entity ids in target order.
+    std::size_t reorderCursor_ = 0;      ///< Next plan entry to place.
+    uint32_t reorderPlaced_ = 0;         ///< Dense slots already in order.
+    uint64_t reorderPasses_ = 0;
 };
 
+template <typename Visitor>
+void WorldSystem::ForEachVisible(cgs::ecs::Entity viewer, Visitor&& visit) const {
+    if (!memberships_.Has(viewer) || !transforms_.Has(viewer)) {
+        return;
+    }
+
+    float range = kDefaultVisibilityRange;
+    if (visibilityRanges_.Has(viewer)) {
+        range = visibilityRanges_.Get(viewer).range;
+    }
+
+    ForEachInRadius(memberships_.Get(viewer).mapEntity, transforms_.Get(viewer).position, range,
+                    std::forward<Visitor>(visit));
+}
+
+template <typename Visitor>
+void WorldSystem::ForEachInRadius(cgs::ecs::Entity mapEntity, const Vector3& center, float radius,
+                                  Visitor&& visit) const {
+    auto it = spatialIndices_.find(mapEntity);
+    if (it == spatialIndices_.end()) {
+        return;
+    }
+
+    // The index filters on the positions synced by the last Execute() or
+    // TransferEntity(); only skip entities whose Transform is gone.
+    it->second.ForEachInRadius(center, radius, [&](cgs::ecs::Entity entity) {
+        if (transforms_.Has(entity)) {
+            visit(entity);
+        }
+    });
+}
+
+template <typename Visitor>
+void WorldSystem::ForEachInCone(cgs::ecs::Entity mapEntity, const Vector3& apex,
+                                const Vector3& direction, float radius, float halfAngle,
+                                Visitor&& visit) const {
+    auto it = spatialIndices_.find(mapEntity);
+    if (it == spatialIndices_.end()) {
+        return;
+    }
+
+    it->second.ForEachInCone(apex, direction, radius, halfAngle, [&](cgs::ecs::Entity entity) {
+        if (transforms_.Has(entity)) {
+            visit(entity);
+        }
+    });
+}
+
+template <typename Out, typename Filter>
+void WorldSystem::QueryNearest(cgs::ecs::Entity mapEntity, const Vector3& center, std::size_t k,
+                               Out& out, Filter&& filter, float maxRadius) const {
+    auto it = spatialIndices_.find(mapEntity);
+    if (it == spatialIndices_.end()) {
+        return;
+    }
+
+    it->second.QueryNearest(
+        center, k, out,
+        [&](cgs::ecs::Entity entity) { return transforms_.Has(entity) && filter(entity); },
+        maxRadius);
+}
+
+template <typename Filter>
+std::optional<SegmentHit> WorldSystem::Raycast(cgs::ecs::Entity mapEntity, const Vector3& from,
+                                               const Vector3& to, float radius,
+                                               Filter&& filter) const {
+    auto it = spatialIndices_.find(mapEntity);
+    if (it == spatialIndices_.end()) {
+        return std::nullopt;
+    }
+
+    return it->second.Raycast(from, to, radius, [&](cgs::ecs::Entity entity) {
+        return transforms_.Has(entity) && filter(entity);
+    });
+}
+
 }  // namespace cgs::game
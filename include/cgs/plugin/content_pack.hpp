@@ -0,0 +1,378 @@
+#pragma once
+
+/// @file content_pack.hpp
+/// @brief Compiled binary content packs: item, quest and class templates
+///        read in place from a read-only memory mapping.
+///
+/// Parsing tens of thousands of templates from text at every start costs
+/// seconds, and each server process ends up with its own copy.  A content
+/// pack is compiled once, offline, from already validated templates
+/// (CompileContentPack(), WriteContentPack()).  At run time
+/// ContentPack::Open() maps the file read-only: nothing is parsed, the
+/// templates are read straight from the mapped records, and every
+/// process on the host shares the same page-cache pages.
+///
+/// The pack holds no pointers.  Records refer to strings and arrays by
+/// offset into sections of the same file, so the image works at any
+/// address.  Items and quests are sorted by id and each has an
+/// open-addressing id index stored in the pack, so lookups need no
+/// table built at load time.  Open() checks every offset before handing
+/// out views, so a truncated or corrupt pack is rejected rather than
+/// read out of bounds.
+///
+/// Systems that own their templates (InventorySystem, QuestSystem) get
+/// them from ToFragment(), or from ContentReloader with
+/// ContentPackParser(), which turns records into templates without any
+/// text parsing.
+///
+/// Packs are little-endian; other hosts refuse to open or compile them.
+///
+/// @see SDS-MOD-023
+
+#include "cgs/foundation/game_result.hpp"
+#include "cgs/game/inventory_components.hpp"
+#include "cgs/game/quest_components.hpp"
+#include "cgs/plugin/content_reloader.hpp"
+#include "cgs/plugin/mmorpg_types.hpp"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace cgs::plugin {
+
+/// On-disk layout of a content pack.  All records are fixed-size and
+/// naturally aligned; sections start on 8-byte boundaries.
+namespace pack {
+
+inline constexpr std::array<char, 8> kMagic = {'C', 'G', 'S', 'P', 'A', 'C', 'K', '\0'};
+
+/// Bumped on every layout change; Open() rejects other versions.
+inline constexpr uint32_t kFormatVersion = 1;
+
+/// Id index slot that holds no record.
+inline constexpr uint32_t kEmptySlot = ~uint32_t{0};
+
+/// Bytes [offset, offset + size) of the string section; no terminator.
+struct StringRef {
+    uint32_t offset = 0;
+    uint32_t size = 0;
+};
+
+/// Elements [first, first + count) of an array section.
+struct RangeRef {
+    uint32_t first = 0;
+    uint32_t count = 0;
+};
+
+/// A section: byte offset from the start of the pack, element count.
+struct Section {
+    uint64_t offset = 0;
+    uint64_t count = 0;
+};
+
+struct Header {
+    std::array<char, 8> magic{};
+    uint32_t formatVersion = 0;
+    uint32_t headerSize = 0;
+    uint64_t fileSize = 0;
+    Section items;       ///< ItemRecord, ascending id.
+    Section quests;      ///< QuestRecord, ascending id.
+    Section classes;     ///< ClassRecord, ascending class.
+    Section itemIndex;   ///< uint32_t record index per slot; power-of-two count.
+    Section questIndex;  ///< As itemIndex.
+    Section objectives;  ///< ObjectiveRecord.
+    Section rewards;     ///< RewardRecord.
+    Section ids;         ///< uint32_t quest prerequisites.
+    Section strings;     ///< Bytes.
+};
+
+struct ItemRecord {
+    uint32_t id = 0;
+    StringRef name;
+    uint8_t type = 0;
+    uint8_t quality = 0;
+    uint8_t equipSlot = 0;
+    uint8_t reserved = 0;
+    uint32_t maxStackSize = 0;
+    int32_t maxDurability = 0;
+    uint32_t requiredLevel = 0;
+    uint32_t vendorPrice = 0;
+    std::array<int32_t, cgs::game::kMaxAttributes> attributes{};
+    int32_t armor = 0;
+    float attackSpeed = 0.0f;
+    int32_t minDamage = 0;
+    int32_t maxDamage = 0;
+};
+
+struct QuestRecord {
+    uint32_t id = 0;
+    StringRef name;
+    StringRef description;
+    uint32_t level = 0;
+    uint32_t chainNext = 0;  ///< 0 = none (id 0 is reserved).
+    uint16_t flags = 0;
+    uint16_t reserved = 0;
+    float timeLimitSeconds = 0.0f;
+    RangeRef prerequisites;  ///< Into ids.
+    RangeRef objectives;
+    RangeRef rewardItems;  ///< Into rewards.
+    uint32_t reserved2 = 0;
+    int64_t experience = 0;
+    int64_t currency = 0;
+};
+
+struct ObjectiveRecord {
+    uint32_t targetId = 0;
+    int32_t required = 0;
+    uint8_t type = 0;
+    std::array<uint8_t, 3> reserved{};
+};
+
+struct RewardRecord {
+    uint32_t itemId = 0;
+    uint32_t count = 0;
+};
+
+struct ClassRecord {
+    uint8_t characterClass = 0;
+    std::array<uint8_t, 3> reserved{};
+    int32_t baseHealth = 0;
+    int32_t baseMana = 0;
+    float baseSpeed = 0.0f;
+};
+
+static_assert(sizeof(Header) == 168);
+static_assert(sizeof(ItemRecord) == 48 + 4 * cgs::game::kMaxAttributes);
+static_assert(sizeof(QuestRecord) == 80);
+static_assert(sizeof(ObjectiveRecord) == 12);
+static_assert(sizeof(RewardRecord) == 8);
+static_assert(sizeof(ClassRecord) == 16);
+
+/// Home slot of @p id in an index of 2^@p bits slots.
+[[nodiscard]] constexpr std::size_t IndexSlot(uint32_t id, unsigned bits) noexcept {
+    return static_cast<std::size_t>((uint64_t{id} * 0x9E3779B97F4A7C15ull) >> (64 - bits));
+}
+
+}  // namespace pack
+
+/// Templates compiled into one pack.
+struct ContentPackSource {
+    std::vector<cgs::game::ItemTemplate> items;
+    std::vector<cgs::game::QuestTemplate> quests;
+    std::vector<ClassTemplate> classes;
+};
+
+/// Compile @p source into a pack image.
+///
+/// Items and quests are validated as by ContentDatabase::Build(), and
+/// duplicate ids resolve the same way; a later class template replaces
+/// an earlier one for the same class.
+///
+/// @return InvalidArgument for content ContentDatabase would reject, a
+///         class out of range, or strings and arrays too large for
+///         32-bit offsets.
+[[nodiscard]] cgs::foundation::GameResult<std::vector<uint8_t>> CompileContentPack(
+    ContentPackSource source);
+
+/// Compile @p source and write it to @p path.
+///
+/// The pack is written beside @p path and renamed over it, so processes
+/// that still map the previous pack keep reading it intact.
+///
+/// @return As CompileContentPack(), or ConfigLoadFailed if the file
+///         cannot be written.
+[[nodiscard]] cgs::foundation::GameResult<void> WriteContentPack(
+    ContentPackSource source, const std::filesystem::path& path);
+
+class ContentPack;
+
+/// An item record in a pack.  Valid while the pack is.
+class PackedItem {
+public:
+    PackedItem(const ContentPack& owner, const pack::ItemRecord& record) noexcept
+        : pack_(&owner), record_(&record) {}
+
+    [[nodiscard]] uint32_t Id() const noexcept { return record_->id; }
+    [[nodiscard]] std::string_view Name() const noexcept;
+    [[nodiscard]] const pack::ItemRecord& Record() const noexcept { return *record_; }
+
+    /// An owned template (the name is interned).
+    [[nodiscard]] cgs::game::ItemTemplate ToTemplate() const;
+
+private:
+    const ContentPack* pack_;
+    const pack::ItemRecord* record_;
+};
+
+/// A quest record in a pack.  Valid while the pack is.
+class PackedQuest {
+public:
+    PackedQuest(const ContentPack& owner, const pack::QuestRecord& record) noexcept
+        : pack_(&owner), record_(&record) {}
+
+    [[nodiscard]] uint32_t Id() const noexcept { return record_->id; }
+    [[nodiscard]] std::string_view Name() const noexcept;
+    [[nodiscard]] std::string_view Description() const noexcept;
+    [[nodiscard]] std::span<const uint32_t> Prerequisites() const noexcept;
+    [[nodiscard]] std::span<const pack::ObjectiveRecord> Objectives() const noexcept;
+    [[nodiscard]] std::span<const pack::RewardRecord> RewardItems() const noexcept;
+    [[nodiscard]] const pack::QuestRecord& Record() const noexcept { return *record_; }
+
+    /// An owned template with fresh objective progress.
+    [[nodiscard]] cgs::game::QuestTemplate ToTemplate() const;
+
+private:
+    const ContentPack* pack_;
+    const pack::QuestRecord* record_;
+};
+
+/// A content pack mapped read-only.
+///
+/// Immutable once opened, so any number of threads may read it.  Views
+/// and spans point into the mapping: keep the pack alive while using
+/// them.
+///
+/// Usage:
+/// @code
+///   // Offline:
+///   (void)WriteContentPack({items, quests, classes}, "content/content.pack");
+///   // At startup:
+///   auto opened = ContentPack::Open("content/content.pack");
+///   if (opened.hasError()) { ... }
+///   auto pack = opened.value();
+///   if (auto sword = pack->FindItem(1001)) { log(sword->Name()); }
+///   auto fragment = pack->ToFragment();  // For ContentDatabase::Build()
+/// @endcode
+class ContentPack {
+public:
+    /// Map the pack at @p path.  Where memory mapping is unavailable the
+    /// file is read into memory instead.
+    ///
+    /// @return ConfigLoadFailed if the file cannot be read, is not a pack
+    ///         of kFormatVersion, or any record is out of bounds or out of
+    ///         range.
+    [[nodiscard]] static cgs::foundation::GameResult<std::shared_ptr<const ContentPack>> Open(
+        const std::filesystem::path& path);
+
+    /// Adopt an image from CompileContentPack(), validated as by Open().
+    [[nodiscard]] static cgs::foundation::GameResult<std::shared_ptr<const ContentPack>>
+    FromBytes(std::vector<uint8_t> image);
+
+    ~ContentPack();
+
+    ContentPack(const ContentPack&) = delete;
+    ContentPack& operator=(const ContentPack&) = delete;
+
+    [[nodiscard]] std::size_t ItemCount() const noexcept { return items_.size(); }
+    [[nodiscard]] std::size_t QuestCount() const noexcept { return quests_.size(); }
+
+    /// The @p index-th item in ascending id order; @p index < ItemCount().
+    [[nodiscard]] PackedItem ItemAt(std::size_t index) const noexcept {
+        return {*this, items_[index]};
+    }
+
+    /// The @p index-th quest in ascending id order.
+    [[nodiscard]] PackedQuest QuestAt(std::size_t index) const noexcept {
+        return {*this, quests_[index]};
+    }
+
+    [[nodiscard]] std::optional<PackedItem> FindItem(uint32_t id) const noexcept;
+    [[nodiscard]] std::optional<PackedQuest> FindQuest(uint32_t id) const noexcept;
+
+    [[nodiscard]] std::optional<ClassTemplate> FindClass(CharacterClass characterClass) const;
+    [[nodiscard]] std::vector<ClassTemplate> Classes() const;
+
+    /// Every item and quest as owned templates.
+    [[nodiscard]] ContentFragment ToFragment() const;
+
+    /// True when the pack is a file mapping rather than a heap copy.
+    [[nodiscard]] bool IsMapped() const noexcept { return mapping_ != nullptr; }
+
+    [[nodiscard]] std::size_t SizeBytes() const noexcept { return size_; }
+
+private:
+    friend class PackedItem;
+    friend class PackedQuest;
+
+    ContentPack() = default;
+
+    /// Check the image at base_ and set up the section views.
+    [[nodiscard]] cgs::foundation::GameResult<void> attach();
+
+    [[nodiscard]] std::string_view string(pack::StringRef ref) const noexcept {
+        return {strings_.data() + ref.offset, ref.size};
+    }
+
+    template <typename Record>
+    [[nodiscard]] static std::optional<std::size_t> findIndex(std::span<const Record> records,
+                                                              std::span<const uint32_t> index,
+                                                              uint32_t id) noexcept {
+        if (records.empty()) {
+            return std::nullopt;
+        }
+        auto bits = static_cast<unsigned>(std::countr_zero(index.size()));
+        std::size_t mask = index.size() - 1;
+        for (std::size_t slot = pack::IndexSlot(id, bits);; slot = (slot + 1) & mask) {
+            uint32_t entry = index[slot];
+            if (entry == pack::kEmptySlot) {
+                return std::nullopt;
+            }
+            if (records[entry].id == id) {
+                return entry;
+            }
+        }
+    }
+
+    std::vector<uint8_t> owned_;
+    void* mapping_ = nullptr;
+    const uint8_t* base_ = nullptr;
+    std::size_t size_ = 0;
+
+    std::span<const pack::ItemRecord> items_;
+    std::span<const pack::QuestRecord> quests_;
+    std::span<const pack::ClassRecord> classes_;
+    std::span<const uint32_t> itemIndex_;
+    std::span<const uint32_t> questIndex_;
+    std::span<const pack::ObjectiveRecord> objectives_;
+    std::span<const pack::RewardRecord> rewards_;
+    std::span<const uint32_t> ids_;
+    std::string_view strings_;
+};
+
+inline std::string_view PackedItem::Name() const noexcept {
+    return pack_->string(record_->name);
+}
+
+inline std::string_view PackedQuest::Name() const noexcept {
+    return pack_->string(record_->name);
+}
+
+inline std::string_view PackedQuest::Description() const noexcept {
+    return pack_->string(record_->description);
+}
+
+inline std::span<const uint32_t> PackedQuest::Prerequisites() const noexcept {
+    return pack_->ids_.subspan(record_->prerequisites.first, record_->prerequisites.count);
+}
+
+inline std::span<const pack::ObjectiveRecord> PackedQuest::Objectives() const noexcept {
+    return pack_->objectives_.subspan(record_->objectives.first, record_->objectives.count);
+}
+
+inline std::span<const pack::RewardRecord> PackedQuest::RewardItems() const noexcept {
+    return pack_->rewards_.subspan(record_->rewardItems.first, record_->rewardItems.count);
+}
+
+/// A ContentReloader parser for compiled packs: each reload maps the
+/// pack and converts its records, with no text parsing.
+[[nodiscard]] ContentParser ContentPackParser();
+
+}  // namespace cgs::plugin
@@ -0,0 +1,198 @@
+#pragma once
+
+/// @file content_reloader.hpp
+/// @brief ContentReloader: rebuilds game content off the tick thread and
+///        swaps it in between ticks.
+///
+/// Unlike HotReloadManager this is available in production builds: a
+/// content reload never pauses a tick.  Changed files are re-parsed and
+/// a new cgs::game::ContentDatabase is built and validated on a
+/// background thread; the running version is untouched until Poll()
+/// publishes the new one between ticks.
+///
+/// @see SRS-PLG-005
+/// @see SDS-MOD-023
+
+#include "cgs/foundation/game_result.hpp"
+#include "cgs/game/content_database.hpp"
+#include "cgs/plugin/file_watcher.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace cgs::plugin {
+
+/// Templates defined by one content file.
+struct ContentFragment {
+    std::vector<cgs::game::ItemTemplate> items;
+    std::vector<cgs::game::QuestTemplate> quests;
+};
+
+/// Parses one content file.  Runs on a background thread: it must not
+/// touch game state.
+using ContentParser =
+    std::function<cgs::foundation::GameResult<ContentFragment>(const std::filesystem::path&)>;
+
+/// Invoked on the tick thread with each newly published version.
+using ContentPublishCallback =
+    std::function<void(const std::shared_ptr<const cgs::game::ContentDatabase>&)>;
+
+/// Keeps a ContentDatabase in step with a set of content files.
+///
+/// Each watched file has a parser and contributes a ContentFragment; the
+/// database is built from every file's latest fragment, in path order
+/// (a later file's template replaces an earlier one with the same id).
+/// Only files that changed since the last build are re-parsed.
+///
+/// Publishing calls every publish callback, which typically hands the new
+/// templates to the systems (InventorySystem::SetTemplates(),
+/// QuestSystem::SetTemplates()).  The systems' pointers share ownership
+/// of their version, so a superseded version is freed once the last
+/// system has moved on; RetiredVersionCount() counts those.
+///
+/// A build that fails to parse or validate is dropped: the running
+/// version stays published and LastError() reports why.  Its files are
+/// parsed again by the next build, which starts when any watched file
+/// changes, so a fix split across several files is picked up whole.
+///
+/// Not thread-safe: call every member from the tick thread.
+///
+/// Usage:
+/// @code
+///   ContentReloader content;
+///   content.OnPublish([&](const auto& db) {
+///       inventory.SetTemplates(db->Items());
+///       quests.SetTemplates(db->Quests());
+///   });
+///   (void)content.Watch("content/items.json", parseItems);
+///   (void)content.Reload();  // Initial load, inline
+///   // Between ticks:
+///   content.Poll();
+/// @endcode
+class ContentReloader {
+public:
+    explicit ContentReloader(FileWatchBackend backend = FileWatchBackend::Native);
+
+    /// Waits for a background build in progress.
+    ~ContentReloader();
+
+    ContentReloader(const ContentReloader&) = delete;
+    ContentReloader& operator=(const ContentReloader&) = delete;
+    ContentReloader(ContentReloader&&) = delete;
+    ContentReloader& operator=(ContentReloader&&) = delete;
+
+    /// Register a callback run for every version published from now on.
+    void OnPublish(ContentPublishCallback callback);
+
+    /// Start watching @p path, parsed by @p parser.  The file is parsed
+    /// by the next build.
+    ///
+    /// @return ConfigLoadFailed if the file does not exist or cannot be
+    ///         watched.
+    [[nodiscard]] cgs::foundation::GameResult<void> Watch(const std::filesystem::path& path,
+                                                          ContentParser parser);
+
+    /// Stop watching @p path; the next build drops its templates.
+    void Unwatch(const std::filesystem::path& path);
+
+    /// Build from the changed files now and publish the result, waiting
+    /// for any background build first.  Meant for the initial load.
+    ///
+    /// @return The parse or validation error if the build failed.
+    [[nodiscard]] cgs::foundation::GameResult<void> Reload();
+
+    /// Collect file changes, publish a finished background build and
+    /// start a new one if files changed meanwhile.
+    ///
+    /// Call between ticks, e.g. once per frame.
+    void Poll();
+
+    /// The published version (null until the first successful build).
+    [[nodiscard]] const std::shared_ptr<const cgs::game::ContentDatabase>& Current() const noexcept;
+
+    /// Version number of Current(), or 0.
+    [[nodiscard]] uint64_t CurrentVersion() const noexcept;
+
+    /// Whether a background build is in progress.
+    [[nodiscard]] bool IsBuilding() const noexcept;
+
+    /// Published versions still referenced, Current() included.
+    [[nodiscard]] std::size_t LiveVersionCount() const;
+
+    /// Superseded versions freed so far (counted by Poll()).
+    [[nodiscard]] uint64_t RetiredVersionCount() const noexcept;
+
+    /// Builds published so far.
+    [[nodiscard]] uint64_t PublishCount() const noexcept;
+
+    /// Error of the most recent failed build, cleared by a successful one.
+    [[nodiscard]] const std::optional<cgs::foundation::GameError>& LastError() const noexcept;
+
+    /// Set the debounce duration for file change detection.
+    void SetDebounceMs(uint32_t ms);
+
+    /// Number of watched files.
+    [[nodiscard]] std::size_t WatchedFileCount() const noexcept;
+
+private:
+    /// Fragment per file, shared between builds so unchanged files are
+    /// not copied.
+    using FragmentMap = std::map<std::string, std::shared_ptr<const ContentFragment>>;
+
+    /// Output of a successful build.
+    struct Staged {
+        std::shared_ptr<const cgs::game::ContentDatabase> database;
+        FragmentMap fragments;
+    };
+
+    /// A file to re-parse, captured for the build thread.
+    struct ParseJob {
+        std::string path;
+        ContentParser parser;
+    };
+
+    /// Parse @p jobs, merge with @p fragments and build version @p version
+    /// (any thread).
+    [[nodiscard]] static cgs::foundation::GameResult<Staged> build(uint64_t version,
+                                                                   FragmentMap fragments,
+                                                                   std::vector<ParseJob> jobs);
+
+    /// Capture the changed files and clear them (tick thread).
+    [[nodiscard]] std::vector<ParseJob> takeChanged();
+
+    /// Publish @p staged or record its error (tick thread).
+    [[nodiscard]] cgs::foundation::GameResult<void> finish(
+        cgs::foundation::GameResult<Staged> staged);
+
+    /// Count published versions that have been freed.
+    void reapRetired();
+
+    FileWatcher fileWatcher_;
+    std::map<std::string, ContentParser> parsers_;
+    std::set<std::string> changed_;
+    std::set<std::string> stale_;     ///< Parsed by a failed build; redo next time.
+    std::vector<std::string> building_;  ///< Files parsed by pending_.
+    FragmentMap fragments_;  ///< Fragments of Current().
+    bool structureChanged_ = false;  ///< A file was unwatched since the last build.
+
+    std::vector<ContentPublishCallback> callbacks_;
+    std::shared_ptr<const cgs::game::ContentDatabase> current_;
+    std::vector<std::weak_ptr<const cgs::game::ContentDatabase>> superseded_;
+    std::future<cgs::foundation::GameResult<Staged>> pending_;
+    std::optional<cgs::foundation::GameError> lastError_;
+
+    uint64_t nextVersion_ = 1;
+    uint64_t publishCount_ = 0;
+    uint64_t retiredCount_ = 0;
+};
+
+}  // namespace cgs::plugin
@@ -9,13 +9,19 @@
 /// @see SRS-PLG-003
 /// @see SDS-MOD-017
 
+#include "cgs/foundation/signal.hpp"
+
 #include <algorithm>
-#include <any>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
-#include <functional>
+#include <memory>
 #include <mutex>
+#include <span>
 #include <typeindex>
+#include <typeinfo>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace cgs::plugin {
@@ -23,6 +29,39 @@ namespace cgs::plugin {
 /// Unique identifier for an event subscription.
 using SubscriptionId = uint64_t;
 
+/// Integer type used to identify event types at runtime.
+using EventTypeId = uint32_t;
+
+namespace detail {
+
+/// Global atomic counter for generating unique EventTypeId values.
+inline EventTypeId nextEventTypeId() noexcept {
+    static std::atomic<EventTypeId> counter{0};
+    return counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+}  // namespace detail
+
+/// Obtain the unique EventTypeId for event type `E`, assigned on first
+/// access.  A plugin with its own copy of the counter may number types
+/// differently; EventBus checks each channel's type and falls back to a
+/// type_index lookup when the ids disagree.
+template <typename E>
+struct EventType {
+    static EventTypeId Id() noexcept {
+        static const EventTypeId value = detail::nextEventTypeId();
+        return value;
+    }
+};
+
+/// Handler of events of type E (captures up to 48 bytes stored in place).
+template <typename E>
+using EventHandler = cgs::foundation::SignalSlot<const E&>;
+
+/// Handler taking a run of events of type E at once (see SubscribeBatch).
+template <typename E>
+using BatchHandler = cgs::foundation::SignalSlot<std::span<const E>>;
+
 /// Type-safe event bus supporting synchronous and deferred delivery.
 ///
 /// Events are dispatched to handlers registered for the concrete event
@@ -30,6 +69,19 @@ using SubscriptionId = uint64_t;
 /// priority). Within the same priority, handlers are called in
 /// subscription order.
 ///
+/// Each event type has a channel, found through EventType<E>::Id() in a
+/// fixed table, holding an immutable handler array that Subscribe() and
+/// Unsubscribe() replace atomically.  Publish() therefore takes no lock,
+/// copies nothing and passes the event to each handler by const
+/// reference.  A handler may subscribe, unsubscribe or publish; changes
+/// apply from the next Publish().
+///
+/// Deferred events are stored by value in a contiguous queue per event
+/// type.  ProcessDeferred() delivers them type by type (types in the
+/// order their first event was queued, events in FIFO order within a
+/// type), and each handler sees the whole run before the next handler
+/// runs, so a handler registered with SubscribeBatch() receives it as a
+/// single std::span.
 /// Usage:
 /// @code
 ///   EventBus bus;
@@ -46,32 +98,36 @@ using SubscriptionId = uint64_t;
 ///   bus.PublishDeferred(MyEvent{99});
 ///   bus.ProcessDeferred();  // Flush the queue.
 ///
+///   // Batch handler — one call per ProcessDeferred() for all queued
+///   // MyEvents (and a one-element span per Publish()).
+///   bus.SubscribeBatch<MyEvent>([](std::span<const MyEvent> events) {
+///       // handle events
+///   });
+///
 ///   // Unsubscribe when done.
 ///   bus.Unsubscribe(id);
 /// @endcode
 class EventBus {
 public:
+    /// Event types whose id is below this are found without a lock.
+    static constexpr std::size_t kFastChannels = 256;
+
     EventBus() = default;
     ~EventBus() = default;
 
     EventBus(const EventBus&) = delete;
     EventBus& operator=(const EventBus&) = delete;
 
+    // Moving a bus that another thread is using is not supported.
     EventBus(EventBus&& other) noexcept {
         std::lock_guard lock(other.mutex_);
-        handlers_ = std::move(other.handlers_);
-        subscriptionTypes_ = std::move(other.subscriptionTypes_);
-        deferredQueue_ = std::move(other.deferredQueue_);
-        nextId_ = other.nextId_;
+        moveFrom(other);
     }
 
     EventBus& operator=(EventBus&& other) noexcept {
         if (this != &other) {
             std::scoped_lock lock(mutex_, other.mutex_);
-            handlers_ = std::move(other.handlers_);
-            subscriptionTypes_ = std::move(other.subscriptionTypes_);
-            deferredQueue_ = std::move(other.deferredQueue_);
-            nextId_ = other.nextId_;
+            moveFrom(other);
         }
         return *this;
     }
@@ -85,27 +141,21 @@ public:
     /// @param priority  Handler priority (lower = called first, default 0).
     /// @return A unique subscription ID for later unsubscription.
     template <typename E>
-    SubscriptionId Subscribe(std::function<void(const E&)> handler, int32_t priority = 0) {
+    SubscriptionId Subscribe(EventHandler<E> handler, int32_t priority = 0) {
         std::lock_guard lock(mutex_);
 
-        auto id = nextId_++;
-        auto typeIdx = std::type_index(typeid(E));
-
-        HandlerEntry entry;
-        entry.id = id;
-        entry.priority = priority;
-        entry.handler = [fn = std::move(handler)](const std::any& event) {
-            fn(std::any_cast<const E&>(event));
-        };
-
-        auto& handlers = handlers_[typeIdx];
-        handlers.push_back(std::move(entry));
-        sortHandlers(handlers);
-
-        // Track type for type-erased unsubscribe.
-        subscriptionTypes_.insert_or_assign(id, typeIdx);
+        return addEntry(Entry<E>{0, priority, std::move(handler), {}});
+    }
 
-        return id;
+    /// Subscribe a handler that takes events of type E as a span.
+    ///
+    /// ProcessDeferred() passes every queued E in one call; Publish()
+    /// passes a span of one.  Ordered with the per-event handlers of E
+    /// by priority, and removed with Unsubscribe() like them.
+    template <typename E>
+    SubscriptionId SubscribeBatch(BatchHandler<E> handler, int32_t priority = 0) {
+        std::lock_guard lock(mutex_);
+        return addEntry(Entry<E>{0, priority, {}, std::move(handler)});
     }
 
     // -- Unsubscribe ----------------------------------------------------------
@@ -115,13 +165,20 @@ public:
     /// Safe to call with an already-removed or invalid ID (no-op).
     void Unsubscribe(SubscriptionId id) {
         std::lock_guard lock(mutex_);
-        unsubscribeInternal(id);
+        auto it = subscriptionTypes_.find(id);
+        if (it == subscriptionTypes_.end()) {
+            return;
+        }
+        it->second->remove(id, *this);
+        subscriptionTypes_.erase(it);
     }
 
     /// Remove all subscriptions, clearing the handler table entirely.
     void UnsubscribeAll() {
         std::lock_guard lock(mutex_);
-        handlers_.clear();
+        for (auto& channel : channels_) {
+            channel->clear(*this);
+        }
         subscriptionTypes_.clear();
     }
 
@@ -133,47 +190,52 @@ public:
     /// in priority order, on the calling thread.
     template <typename E>
     void Publish(const E& event) {
-        std::vector<HandlerEntry> snapshot;
-        {
-            std::lock_guard lock(mutex_);
-            auto it = handlers_.find(std::type_index(typeid(E)));
-            if (it == handlers_.end()) {
-                return;
-            }
-            snapshot = it->second;
-        }
-
-        std::any wrapped = event;
-        for (const auto& entry : snapshot) {
-            entry.handler(wrapped);
+        ReadGuard guard(readers_);
+        const auto* channel = findChannel<E>();
+        if (channel == nullptr) {
+            return;
         }
+        channel->dispatch(std::span<const E>(&event, 1));
     }
 
     // -- Deferred publish -----------------------------------------------------
 
     /// Queue an event for deferred processing.
     ///
-    /// The event is copied and stored. Call ProcessDeferred() to
-    /// dispatch all queued events (typically at frame boundaries).
+    /// The event is moved into the queue of its type. Call
+    /// ProcessDeferred() to dispatch all queued events (typically at
+    /// frame boundaries).
     template <typename E>
     void PublishDeferred(E event) {
         std::lock_guard lock(mutex_);
-        deferredQueue_.push_back([this, evt = std::move(event)]() { Publish(evt); });
+        auto& channel = channelFor<E>();
+        if (channel.deferred.empty()) {
+            pending_.push_back(&channel);
+        }
+        channel.deferred.push_back(std::move(event));
+        ++deferredCount_;
     }
 
-    /// Flush the deferred event queue.
+    /// Flush the deferred event queues.
     ///
-    /// Dispatches all queued events in FIFO order. New events published
-    /// during processing are NOT included in this cycle.
+    /// Dispatches queued events grouped by type, in FIFO order within a
+    /// type. New events published during processing are NOT included in
+    /// this cycle.
     void ProcessDeferred() {
-        std::vector<std::function<void()>> queue;
+        std::vector<std::pair<ChannelBase*, std::shared_ptr<void>>> batches;
         {
             std::lock_guard lock(mutex_);
-            queue.swap(deferredQueue_);
+            batches.reserve(pending_.size());
+            for (auto* channel : pending_) {
+                batches.emplace_back(channel, channel->takeDeferred());
+            }
+            pending_.clear();
+            deferredCount_ = 0;
         }
 
-        for (auto& fn : queue) {
-            fn();
+        ReadGuard guard(readers_);
+        for (auto& [channel, events] : batches) {
+            channel->dispatchDeferred(events.get());
         }
     }
 
@@ -182,83 +244,230 @@ public:
     /// Get the total number of active subscriptions across all event types.
     [[nodiscard]] std::size_t HandlerCount() const {
         std::lock_guard lock(mutex_);
-        std::size_t count = 0;
-        for (const auto& [_, handlers] : handlers_) {
-            count += handlers.size();
-        }
-        return count;
+        return subscriptionTypes_.size();
     }
 
     /// Get the number of handlers for a specific event type.
     template <typename E>
     [[nodiscard]] std::size_t HandlerCountFor() const {
-        std::lock_guard lock(mutex_);
-        auto it = handlers_.find(std::type_index(typeid(E)));
-        if (it == handlers_.end()) {
+        ReadGuard guard(readers_);
+        const auto* channel = findChannel<E>();
+        if (channel == nullptr) {
             return 0;
         }
-        return it->second.size();
+        const auto* handlers = channel->handlers.load();
+        return handlers == nullptr ? 0 : handlers->size();
     }
 
     /// Get the number of events waiting in the deferred queue.
     [[nodiscard]] std::size_t DeferredCount() const {
         std::lock_guard lock(mutex_);
-        return deferredQueue_.size();
+        return deferredCount_;
     }
 
 private:
-    /// A type-erased handler with priority and ID.
-    struct HandlerEntry {
+    /// A handler with priority and ID; exactly one of handler / batch is set.
+    template <typename E>
+    struct Entry {
         SubscriptionId id = 0;
         int32_t priority = 0;
-        std::function<void(const std::any&)> handler;
+        EventHandler<E> handler;
+        BatchHandler<E> batch;
     };
 
-    /// Sort handlers by priority (ascending), stable to preserve
-    /// insertion order within the same priority level.
-    static void sortHandlers(std::vector<HandlerEntry>& handlers) {
-        std::stable_sort(
-            handlers.begin(), handlers.end(), [](const HandlerEntry& a, const HandlerEntry& b) {
-                return a.priority < b.priority;
-            });
-    }
+    template <typename E>
+    using HandlerList = std::vector<Entry<E>>;
+
+    /// Handlers and deferred events of one event type; lists are
+    /// replaced and the queue filled under mutex_.
+    struct ChannelBase {
+        explicit ChannelBase(const std::type_info& t) : type(&t) {}
+        virtual ~ChannelBase() = default;
+        virtual void remove(SubscriptionId id, EventBus& bus) = 0;
+        virtual void clear(EventBus& bus) = 0;
+        /// Move the queued events out (caller holds mutex_).
+        virtual std::shared_ptr<void> takeDeferred() = 0;
+        /// Dispatch events returned by takeDeferred() (reader guard open).
+        virtual void dispatchDeferred(void* events) const = 0;
+
+        const std::type_info* type;
+    };
 
-    /// Internal unsubscribe without locking (caller must hold mutex_).
-    void unsubscribeInternal(SubscriptionId id) {
-        auto typeIt = subscriptionTypes_.find(id);
-        if (typeIt == subscriptionTypes_.end()) {
-            return;
+    template <typename E>
+    struct Channel final : ChannelBase {
+        Channel() : ChannelBase(typeid(E)) {}
+        ~Channel() override { delete handlers.load(); }
+
+        // Insert after every entry of equal or higher priority, keeping
+        // subscription order within a priority level.
+        void add(Entry<E> entry, EventBus& bus) {
+            auto next = std::make_unique<HandlerList<E>>();
+            if (const auto* current = handlers.load()) {
+                next->reserve(current->size() + 1);
+                *next = *current;
+            }
+            auto pos = std::upper_bound(next->begin(), next->end(), entry.priority,
+                                        [](int32_t priority, const Entry<E>& e) {
+                                            return priority < e.priority;
+                                        });
+            next->insert(pos, std::move(entry));
+            bus.retireLocked(handlers.exchange(next.release()));
+        }
+
+        void remove(SubscriptionId id, EventBus& bus) override {
+            const auto* current = handlers.load();
+            if (current == nullptr) {
+                return;
+            }
+            auto next = std::make_unique<HandlerList<E>>();
+            next->reserve(current->size());
+            for (const auto& entry : *current) {
+                if (entry.id != id) {
+                    next->push_back(entry);
+                }
+            }
+            bus.retireLocked(handlers.exchange(next->empty() ? nullptr : next.release()));
+        }
+
+        void clear(EventBus& bus) override { bus.retireLocked(handlers.exchange(nullptr)); }
+
+        std::shared_ptr<void> takeDeferred() override {
+            auto events = std::make_shared<std::vector<E>>(std::move(deferred));
+            deferred.clear();
+            deferred.reserve(events->size());
+            return events;
+        }
+
+        void dispatchDeferred(void* events) const override {
+            dispatch(*static_cast<const std::vector<E>*>(events));
+        }
+
+        // Each handler takes the whole run before the next handler runs.
+        void dispatch(std::span<const E> events) const {
+            const auto* list = handlers.load();
+            if (list == nullptr) {
+                return;
+            }
+            for (const auto& entry : *list) {
+                if (entry.batch) {
+                    entry.batch(events);
+                } else {
+                    for (const E& event : events) {
+                        entry.handler(event);
+                    }
+                }
+            }
+        }
+
+        std::atomic<const HandlerList<E>*> handlers{nullptr};  // null when none
+        std::vector<E> deferred;  // queued by PublishDeferred(), under mutex_
+    };
+
+    // Open while a thread reads a published handler list; lists replaced
+    // under mutex_ are freed only once no guard is open.
+    struct ReadGuard {
+        explicit ReadGuard(std::atomic<uint32_t>& counter) : readers(counter) {
+            readers.fetch_add(1);
+        }
+        ~ReadGuard() { readers.fetch_sub(1); }
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+        std::atomic<uint32_t>& readers;
+    };
+
+    /// Retire @p old and free the retired lists if no reader can hold
+    /// them.  Caller holds mutex_ and has published the replacement.
+    template <typename List>
+    void retireLocked(const List* old) {
+        if (old != nullptr) {
+            retired_.emplace_back(std::unique_ptr<const List>(old));
+        }
+        if (readers_.load() == 0) {
+            retired_.clear();
         }
+    }
+
+    /// Insert @p entry into its channel and assign its ID (caller holds mutex_).
+    template <typename E>
+    SubscriptionId addEntry(Entry<E> entry) {
+        entry.id = nextId_++;
+        const SubscriptionId id = entry.id;
+        auto& channel = channelFor<E>();
+        channel.add(std::move(entry), *this);
+
+        // Track type for type-erased unsubscribe.
+        subscriptionTypes_.insert_or_assign(id, &channel);
+
+        return id;
+    }
 
-        auto handlersIt = handlers_.find(typeIt->second);
-        if (handlersIt != handlers_.end()) {
-            auto& vec = handlersIt->second;
-            vec.erase(
-                std::remove_if(
-                    vec.begin(), vec.end(), [id](const HandlerEntry& e) { return e.id == id; }),
-                vec.end());
+    /// Channel of E, or nullptr if nothing subscribed to (or queued) E yet.
+    template <typename E>
+    [[nodiscard]] const Channel<E>* findChannel() const {
+        const EventTypeId id = EventType<E>::Id();
+        if (id < kFastChannels) {
+            const ChannelBase* channel = fast_[id].load(std::memory_order_acquire);
+            if (channel != nullptr && channel->type == &typeid(E)) {
+                return static_cast<const Channel<E>*>(channel);
+            }
+        }
+        // Slow path: ids past the table or numbered by another module.
+        std::lock_guard lock(mutex_);
+        auto it = byType_.find(std::type_index(typeid(E)));
+        return it == byType_.end() ? nullptr : static_cast<const Channel<E>*>(it->second);
+    }
 
-            if (vec.empty()) {
-                handlers_.erase(handlersIt);
+    /// Channel of E, created on first use (caller holds mutex_).
+    template <typename E>
+    Channel<E>& channelFor() {
+        auto [it, inserted] = byType_.try_emplace(std::type_index(typeid(E)), nullptr);
+        if (inserted) {
+            auto channel = std::make_unique<Channel<E>>();
+            it->second = channel.get();
+            const EventTypeId id = EventType<E>::Id();
+            if (id < kFastChannels && fast_[id].load() == nullptr) {
+                fast_[id].store(channel.get(), std::memory_order_release);
             }
+            channels_.push_back(std::move(channel));
         }
+        return *static_cast<Channel<E>*>(it->second);
+    }
 
-        subscriptionTypes_.erase(typeIt);
+    /// Take over @p other's state (both locked by the caller).
+    void moveFrom(EventBus& other) {
+        channels_ = std::move(other.channels_);
+        byType_ = std::move(other.byType_);
+        fast_ = std::move(other.fast_);
+        other.fast_ = std::make_unique<std::atomic<const ChannelBase*>[]>(kFastChannels);
+        subscriptionTypes_ = std::move(other.subscriptionTypes_);
+        pending_ = std::move(other.pending_);
+        deferredCount_ = std::exchange(other.deferredCount_, 0);
+        nextId_ = other.nextId_;
     }
 
-    /// Handler table: type_index → sorted handler list.
-    std::unordered_map<std::type_index, std::vector<HandlerEntry>> handlers_;
+    /// Channels by event type id (first module to subscribe wins a slot).
+    std::unique_ptr<std::atomic<const ChannelBase*>[]> fast_ =
+        std::make_unique<std::atomic<const ChannelBase*>[]>(kFastChannels);
+
+    /// Every channel, owned; and by type for the slow path.
+    std::vector<std::unique_ptr<ChannelBase>> channels_;
+    std::unordered_map<std::type_index, ChannelBase*> byType_;
+
+    /// Reverse lookup: subscription ID → channel.
+    std::unordered_map<SubscriptionId, ChannelBase*> subscriptionTypes_;
 
-    /// Reverse lookup: subscription ID → type_index.
-    std::unordered_map<SubscriptionId, std::type_index> subscriptionTypes_;
+    /// Handler lists replaced while a reader may still hold them.
+    std::vector<std::shared_ptr<const void>> retired_;
+    mutable std::atomic<uint32_t> readers_{0};
 
-    /// Queue of deferred event dispatches.
-    std::vector<std::function<void()>> deferredQueue_;
+    /// Channels with queued events, in order of their first queued event.
+    std::vector<ChannelBase*> pending_;
+    std::size_t deferredCount_ = 0;
 
     /// Next subscription ID.
     SubscriptionId nextId_ = 1;
 
-    /// Mutex for thread safety.
+    /// Serializes writers; guards everything but the published lists.
     mutable std::mutex mutex_;
 };
 
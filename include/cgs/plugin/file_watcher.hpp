@@ -1,18 +1,25 @@
 #pragma once
 
 /// @file file_watcher.hpp
-/// @brief Polling-based file change detector for plugin hot reload.
+/// @brief File change detector for plugin hot reload.
 ///
 /// Monitors plugin shared library files (.so/.dll/.dylib) for
-/// modifications by comparing filesystem timestamps.
+/// modifications.  The parent directory of each file is watched with the
+/// OS notification API (inotify on Linux, kqueue on macOS/BSD, change
+/// notifications on Windows), so an idle Poll() costs one non-blocking
+/// check instead of a stat per file.  Files on network filesystems, or
+/// when notifications are unavailable, fall back to comparing
+/// filesystem timestamps.
 ///
 /// @see SRS-PLG-005.1
 /// @see SDS-MOD-023
 
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <filesystem>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
@@ -23,11 +30,19 @@ namespace cgs::plugin {
 /// @param path  The path of the modified file.
 using FileChangeCallback = std::function<void(const std::filesystem::path& path)>;
 
-/// Polling-based file change detector.
+/// How FileWatcher learns about changes.
+enum class FileWatchBackend : uint8_t {
+    Native,  ///< OS notifications where available, polling otherwise.
+    Polling  ///< Always compare last-write timestamps.
+};
+
+/// File change detector.
 ///
-/// Watches shared library files by periodically checking their
-/// last-write timestamps.  Changes within a configurable debounce
-/// window are coalesced into a single callback invocation.
+/// Watches shared library files through OS notifications on their
+/// directories (so files replaced by rename are seen too), or by
+/// checking their last-write timestamps on each Poll().  Changes within
+/// a configurable debounce window are coalesced into a single callback
+/// invocation.
 ///
 /// Usage:
 /// @code
@@ -40,8 +55,8 @@ using FileChangeCallback = std::function<void(const std::filesystem::path& path)
 /// @endcode
 class FileWatcher {
 public:
-    FileWatcher();
-    ~FileWatcher() = default;
+    explicit FileWatcher(FileWatchBackend backend = FileWatchBackend::Native);
+    ~FileWatcher();
 
     FileWatcher(const FileWatcher&) = delete;
     FileWatcher& operator=(const FileWatcher&) = delete;
@@ -53,7 +68,9 @@ public:
 
     /// Start watching a file for modifications.
     ///
-    /// Records the current last-write time as baseline.
+    /// Records the current last-write time as baseline and subscribes to
+    /// notifications for its directory unless it is on a network
+    /// filesystem.
     /// @return true if the file exists and watching started.
     bool Watch(const std::filesystem::path& path);
 
@@ -63,11 +80,11 @@ public:
     /// Stop watching all files and clear state.
     void UnwatchAll();
 
-    /// Poll all watched files for modifications.
+    /// Collect pending notifications and poll fallback files.
     ///
-    /// Compares current timestamps against stored baselines.
-    /// If a change is detected and the debounce window has elapsed,
-    /// the callback is invoked.
+    /// Notified files and polled files whose timestamp moved are marked
+    /// changed; once the debounce window after a file's last change has
+    /// elapsed, the callback is invoked for it.
     void Poll();
 
     /// Set the debounce duration in milliseconds.
@@ -82,15 +99,28 @@ public:
     /// Check whether a specific path is being watched.
     [[nodiscard]] bool IsWatching(const std::filesystem::path& path) const;
 
+    /// Whether a watched path is tracked by OS notifications (false if it
+    /// is polled or not watched).
+    [[nodiscard]] bool IsEventDriven(const std::filesystem::path& path) const;
+
 private:
+    /// Platform notification queue (defined in file_watcher.cpp).
+    class NativeBackend;
+
     struct WatchEntry {
         std::filesystem::file_time_type lastWriteTime;
         std::chrono::steady_clock::time_point lastChangeDetected;
         bool pendingCallback = false;
+        bool native = false;  ///< Changes arrive through native_.
     };
 
+    /// Compare @p entry's timestamp with the file's (caller holds mutex_).
+    static void checkTimestamp(const std::string& path, WatchEntry& entry,
+                               std::chrono::steady_clock::time_point now);
+
     mutable std::mutex mutex_;
     std::unordered_map<std::string, WatchEntry> entries_;
+    std::unique_ptr<NativeBackend> native_;  ///< Null when polling only.
     FileChangeCallback callback_;
     std::chrono::milliseconds debounceMs_{200};
 };
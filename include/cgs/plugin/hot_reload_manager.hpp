@@ -11,25 +11,31 @@
 #include "cgs/foundation/game_result.hpp"
 #include "cgs/plugin/file_watcher.hpp"
 #include "cgs/plugin/hot_reloadable.hpp"
+#include "cgs/plugin/plugin_manager.hpp"
 
 #include <chrono>
 #include <filesystem>
+#include <future>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 namespace cgs::plugin {
 
-class PluginManager;
-
 /// Manages plugin hot reload during development.
 ///
-/// Orchestrates the safe reload cycle:
+/// Orchestrates the staged reload cycle:
 ///   1. Detect file change (via FileWatcher)
-///   2. Capture state (if IHotReloadable)
-///   3. Shutdown → Unload
-///   4. Load → Init → Activate (new binary)
-///   5. Restore state (if version matches)
+///   2. Copy the library and Load → Init the copy on a background thread
+///      (PluginManager::StagePlugin) while the old version keeps running
+///   3. Next Poll() after staging finishes, between ticks:
+///      capture state (if IHotReloadable) and restore it into the staged
+///      instance (if the state version matches)
+///   4. Swap the staged instance in (PluginManager::SwapPlugin); the old
+///      one is shut down and unloaded
+///
+/// If staging or state restoration fails, the staged instance is
+/// discarded and the running one is left untouched (rolled back).
 ///
 /// This entire class is a no-op shell when CGS_HOT_RELOAD is not defined,
 /// ensuring zero overhead in production builds.
@@ -66,17 +72,34 @@ public:
     /// Stop monitoring a plugin.
     void UnwatchPlugin(const std::string& pluginName);
 
-    /// Poll for file changes and trigger reloads as needed.
+    /// Poll for file changes, start background reloads for changed
+    /// libraries and swap in those whose staging has finished.
     ///
-    /// Call this periodically (e.g., once per frame in development).
+    /// Call this periodically from the tick thread, between ticks (e.g.,
+    /// once per frame in development).  A failed background reload is
+    /// reported as a PluginErrorEvent.
     void Poll();
 
-    /// Manually trigger a hot reload for a specific plugin.
+    /// Manually trigger a hot reload for a specific plugin and wait for it.
+    ///
+    /// Runs the staged cycle inline, so the caller blocks while the new
+    /// library loads; prefer BeginReload() on a live server.
     ///
     /// @param pluginName The plugin to reload.
-    /// @return Error if the plugin is not found, not dynamic, or reload fails.
+    /// @return Error if the plugin is not found, not dynamic, or reload
+    ///         fails (the running instance is then kept).
     [[nodiscard]] cgs::foundation::GameResult<void> ReloadPlugin(const std::string& pluginName);
 
+    /// Start reloading a watched plugin on a background thread; a later
+    /// Poll() completes it.
+    ///
+    /// @return Error if hot reload is disabled, the plugin is not
+    ///         watched, or a reload of it is already in progress.
+    [[nodiscard]] cgs::foundation::GameResult<void> BeginReload(const std::string& pluginName);
+
+    /// Return the number of background reloads not yet swapped in.
+    [[nodiscard]] std::size_t PendingReloadCount() const;
+
     /// Set debounce duration for file change detection.
     void SetDebounceMs(uint32_t ms);
 
@@ -91,17 +114,27 @@ public:
 
 private:
 #ifdef CGS_HOT_RELOAD
-    /// Perform the full reload cycle for a single plugin.
+    using StagedPlugin = PluginManager::StagedPlugin;
+
+    /// Perform the full reload cycle for a single plugin inline.
     [[nodiscard]] cgs::foundation::GameResult<void> doReload(
         const std::string& pluginName, const std::filesystem::path& libraryPath);
 
+    /// Copy @p libraryPath aside and stage the copy (any thread).
+    [[nodiscard]] cgs::foundation::GameResult<StagedPlugin> stage(
+        const std::filesystem::path& libraryPath);
+
+    /// Transfer state into @p staged and swap it in (tick thread).
+    [[nodiscard]] cgs::foundation::GameResult<void> finishReload(
+        const std::string& pluginName, cgs::foundation::GameResult<StagedPlugin> staged);
+
     /// Capture state from an IHotReloadable plugin.
     [[nodiscard]] cgs::foundation::GameResult<PluginStateSnapshot> captureState(
         const std::string& pluginName);
 
-    /// Restore state to an IHotReloadable plugin.
-    [[nodiscard]] cgs::foundation::GameResult<void> restoreState(
-        const std::string& pluginName, const PluginStateSnapshot& snapshot);
+    /// Restore state to a staged IHotReloadable plugin.
+    [[nodiscard]] static cgs::foundation::GameResult<void> restoreState(
+        IPlugin& plugin, const PluginStateSnapshot& snapshot);
 
     PluginManager& pluginManager_;
     FileWatcher fileWatcher_;
@@ -113,6 +146,10 @@ private:
     std::unordered_map<std::string, PluginStateSnapshot> snapshots_;
 
     uint64_t reloadCount_ = 0;
+
+    /// Plugin name → background staging in progress.
+    std::unordered_map<std::string, std::future<cgs::foundation::GameResult<StagedPlugin>>>
+        pending_;
 #else
     // Reference kept for API compatibility even when hot reload is disabled.
     [[maybe_unused]] PluginManager& pluginManager_;
@@ -43,6 +43,12 @@ public:
     /// @param deltaTime  Frame delta time in seconds.
     virtual void OnUpdate(float deltaTime) = 0;
 
+    /// How OnUpdate() may be scheduled (thread safety, ordering, budget).
+    ///
+    /// Read by PluginManager after initialization; the default is a
+    /// serial, unbudgeted update.
+    [[nodiscard]] virtual PluginUpdatePolicy GetUpdatePolicy() const { return {}; }
+
     /// Called when the plugin is being shut down.
     ///
     /// Release resources acquired during OnInit() and OnLoad().
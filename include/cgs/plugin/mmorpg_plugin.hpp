@@ -35,8 +35,11 @@
 #include "cgs/plugin/iplugin.hpp"
 #include "cgs/plugin/mmorpg_types.hpp"
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <cstdint>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -90,6 +93,11 @@ public:
     /// Number of active player characters.
     [[nodiscard]] std::size_t PlayerCount() const noexcept;
 
+    /// Mark a character logged in or out.  Offline characters keep their
+    /// guild membership but leave its online roster.  O(1).
+    /// @return false if @p entity is not a character.
+    bool SetCharacterOnline(cgs::ecs::Entity entity, bool online);
+
     // ── NPC / Creature spawning ────────────────────────────────────────
 
     /// Spawn an AI-controlled creature.
@@ -129,18 +137,39 @@ public:
     /// Look up guild data by ID (nullptr if not found).
     [[nodiscard]] const GuildData* GetGuild(uint32_t guildId) const;
 
+    /// Online members of a guild, in one contiguous run (empty if the
+    /// guild does not exist): the recipients of a guild-wide broadcast.
+    [[nodiscard]] std::span<const GuildMember> GetOnlineGuildMembers(uint32_t guildId) const;
+
     /// Number of active guilds.
     [[nodiscard]] std::size_t GuildCount() const noexcept;
 
     // ── Chat system ────────────────────────────────────────────────────
 
     /// Send a chat message to the specified channel.
+    ///
+    /// The message is built once; the channel history and every
+    /// subscriber of the channel share that one immutable copy.
     void SendChat(cgs::ecs::Entity sender, ChatChannel channel, const std::string& message);
 
-    /// Retrieve the most recent messages from a channel.
+    /// Retrieve the most recent messages from a channel (copied).
     [[nodiscard]] std::vector<ChatMessage> GetChatHistory(ChatChannel channel,
                                                           std::size_t count) const;
 
+    /// The most recent messages from a channel, oldest first, without
+    /// copying them.
+    [[nodiscard]] std::vector<SharedChatMessage> GetSharedChatHistory(ChatChannel channel,
+                                                                      std::size_t count) const;
+
+    /// Deliver every later message on @p channel to @p subscriber (e.g. a
+    /// session's send queue).  Subscribers must not subscribe or
+    /// unsubscribe from inside the callback.
+    /// @return The subscription handle, or 0 for an invalid channel.
+    ChatSubscriptionId SubscribeChat(ChatChannel channel, ChatSubscriber subscriber);
+
+    /// Drop a subscription; unknown handles are ignored.
+    void UnsubscribeChat(ChatSubscriptionId id);
+
     // ── Map management ─────────────────────────────────────────────────
 
     /// Create a new map instance entity.
@@ -161,6 +190,44 @@ private:
     /// Get class template for the given character class.
     [[nodiscard]] const ClassTemplate& getClassTemplate(CharacterClass cls) const;
 
+    /// Exchange two roster slots, keeping CharacterData::guildSlot in step.
+    void swapGuildMembers(GuildData& guild, std::size_t a, std::size_t b);
+
+    /// Append @p member to @p guild's roster (online prefix if online).
+    void addGuildMember(GuildData& guild, GuildMember member, CharacterData& data);
+
+    /// Swap-remove the member at @p slot.
+    void removeGuildMember(GuildData& guild, std::size_t slot);
+
+    /// Fixed-capacity ring of one channel's latest messages.
+    struct ChatRing {
+        std::array<SharedChatMessage, kMaxChatHistoryPerChannel> slots;
+        std::size_t next = 0;  ///< Slot the next message goes to.
+        std::size_t size = 0;
+
+        void Push(SharedChatMessage message) {
+            slots[next] = std::move(message);
+            next = (next + 1) % slots.size();
+            size = std::min(size + 1, slots.size());
+        }
+
+        /// The @p age-th newest message (0 = newest); @pre age < size.
+        [[nodiscard]] const SharedChatMessage& Newest(std::size_t age) const {
+            return slots[(next + slots.size() - 1 - age) % slots.size()];
+        }
+
+        void Clear() {
+            slots.fill(nullptr);
+            next = 0;
+            size = 0;
+        }
+    };
+
+    struct ChatSubscription {
+        ChatSubscriptionId id;
+        ChatSubscriber subscriber;
+    };
+
     PluginInfo info_;
     PluginContext* ctx_ = nullptr;
 
@@ -205,7 +272,9 @@ private:
 
     std::unordered_map<cgs::ecs::Entity, CharacterData> characters_;
     std::unordered_map<uint32_t, GuildData> guilds_;
-    std::array<std::vector<ChatMessage>, kChatChannelCount> chatHistory_;
+    std::array<ChatRing, kChatChannelCount> chatHistory_;
+    std::array<std::vector<ChatSubscription>, kChatChannelCount> chatSubscribers_;
+    ChatSubscriptionId nextChatSubscriptionId_ = 1;
     std::array<ClassTemplate, kCharacterClassCount> classTemplates_;
     uint32_t nextGuildId_ = 1;
     uint32_t nextInstanceId_ = 1;
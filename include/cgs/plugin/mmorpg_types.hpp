@@ -11,10 +11,14 @@
 /// @see Issue #29
 
 #include "cgs/ecs/entity.hpp"
+#include "cgs/foundation/interned_string.hpp"
 
 #include <array>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -49,8 +53,10 @@ struct CharacterData {
     CharacterClass characterClass = CharacterClass::Warrior;
     uint32_t level = 1;
     uint64_t experience = 0;
-    uint32_t guildId = 0;  ///< 0 = not in a guild.
-    std::string name;
+    uint32_t guildId = 0;    ///< 0 = not in a guild.
+    uint32_t guildSlot = 0;  ///< Index in the guild's members while guildId != 0.
+    bool online = true;      ///< Logged in (see MMORPGPlugin::SetCharacterOnline()).
+    cgs::foundation::InternedString name;
 };
 
 // ============================================================================
@@ -63,7 +69,7 @@ enum class GuildRank : uint8_t { Leader, Officer, Member };
 /// A single member entry within a guild.
 struct GuildMember {
     cgs::ecs::Entity entity;
-    std::string name;
+    cgs::foundation::InternedString name;
     GuildRank rank = GuildRank::Member;
 };
 
@@ -71,11 +77,16 @@ struct GuildMember {
 constexpr uint32_t kDefaultMaxGuildMembers = 50;
 
 /// Complete guild data including roster.
+///
+/// members is unordered: leaving swap-removes, and online members are
+/// kept in the first onlineCount slots so that guild-wide broadcasts
+/// walk only them.
 struct GuildData {
     uint32_t id = 0;
-    std::string name;
+    cgs::foundation::InternedString name;
     cgs::ecs::Entity leader;
     std::vector<GuildMember> members;
+    std::size_t onlineCount = 0;  ///< members[0, onlineCount) are online.
     uint32_t maxMembers = kDefaultMaxGuildMembers;
 };
 
@@ -96,9 +107,19 @@ constexpr std::size_t kMaxChatHistoryPerChannel = 100;
 struct ChatMessage {
     cgs::ecs::Entity sender;
     ChatChannel channel = ChatChannel::Global;
-    std::string senderName;
+    cgs::foundation::InternedString senderName;
     std::string content;
     std::chrono::steady_clock::time_point timestamp;
 };
 
+/// A sent chat message, built once and shared read-only by the channel
+/// history and every subscriber it is delivered to.
+using SharedChatMessage = std::shared_ptr<const ChatMessage>;
+
+/// Receives each message sent on a subscribed channel.
+using ChatSubscriber = std::function<void(const SharedChatMessage&)>;
+
+/// Handle returned by MMORPGPlugin::SubscribeChat() (never 0).
+using ChatSubscriptionId = uint64_t;
+
 }  // namespace cgs::plugin
@@ -41,6 +41,15 @@ struct PluginShutdownEvent {
     std::chrono::steady_clock::time_point timestamp = std::chrono::steady_clock::now();
 };
 
+/// Emitted after an OnUpdate() that took longer than the plugin's
+/// PluginUpdatePolicy::budget.
+struct PluginBudgetExceededEvent {
+    std::string pluginName;
+    std::chrono::microseconds updateTime{0};
+    std::chrono::microseconds budget{0};
+    std::chrono::steady_clock::time_point timestamp = std::chrono::steady_clock::now();
+};
+
 /// Emitted when a plugin encounters an error during a lifecycle transition.
 struct PluginErrorEvent {
     std::string pluginName;
@@ -6,6 +6,7 @@
 ///
 /// @see SDS-MOD-021 (Plugin Manager Design)
 
+#include "cgs/foundation/alloc_tracker.hpp"
 #include "cgs/foundation/game_result.hpp"
 #include "cgs/plugin/event_bus.hpp"
 #include "cgs/plugin/iplugin.hpp"
@@ -13,15 +14,32 @@
 #include "cgs/plugin/version_constraint.hpp"
 
 #include <chrono>
+#include <cstdint>
 #include <filesystem>
+#include <functional>
 #include <memory>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace cgs::plugin {
 
+/// Update timing of one plugin, kept by PluginManager::UpdateAll().
+struct PluginUpdateStats {
+    std::chrono::microseconds lastTime{0};  ///< Duration of the last OnUpdate().
+    std::chrono::microseconds maxTime{0};   ///< Longest OnUpdate() so far.
+    std::chrono::microseconds totalTime{0};
+    uint64_t updates = 0;
+    uint64_t overruns = 0;   ///< Updates over PluginUpdatePolicy::budget.
+    uint64_t deferrals = 0;  ///< Ticks skipped because the update budget was spent.
+    /// Heap allocations made by OnUpdate() so far (0 unless the
+    /// AllocTracker hooks are linked).
+    uint64_t allocations = 0;
+    uint64_t allocatedBytes = 0;
+};
+
 /// Manages the full plugin lifecycle: Load → Init → Active → Shutdown → Unload.
 ///
 /// Supports two loading modes:
@@ -81,8 +99,16 @@ public:
     /// Initialize all loaded plugins in dependency order.
     ///
     /// Resolves dependency ordering via topological sort, then calls
-    /// OnInit() on each plugin.  On failure, already-initialized plugins
-    /// are not rolled back (caller should ShutdownAll + UnloadAll).
+    /// OnInit() level by level (DependencyReport::loadLevels).  With a
+    /// parallel executor set, the PluginInfo::threadSafeInit plugins of
+    /// a level initialize in parallel, then the others in order; events
+    /// are published from the calling thread.  Plugins needed only for
+    /// map types not acquired (PluginInfo::mapTypes) are left Loaded.
+    ///
+    /// On failure the level that failed is completed (its parallel
+    /// inits having already run) and no later level starts;
+    /// already-initialized plugins are not rolled back (caller should
+    /// ShutdownAll + UnloadAll).
     [[nodiscard]] cgs::foundation::GameResult<void> InitializeAll();
 
     /// Activate a single initialized plugin (Initialized → Active).
@@ -91,15 +117,61 @@ public:
     /// Activate all initialized plugins.
     [[nodiscard]] cgs::foundation::GameResult<void> ActivateAll();
 
+    /// Take a reference on @p mapType (one per live map instance of that
+    /// type).  The first reference initializes and activates the plugins
+    /// listing it in PluginInfo::mapTypes, and their dependencies, level
+    /// by level as InitializeAll() does.
+    ///
+    /// @return PluginInvalidState before InitializeAll(), or the first
+    ///         init error (no reference is taken then).
+    [[nodiscard]] cgs::foundation::GameResult<void> AcquireMapType(std::string_view mapType);
+
+    /// Drop a reference on @p mapType.  The last one shuts down, in
+    /// reverse dependency order, the lazily activated plugins no other
+    /// acquired map type needs.
+    void ReleaseMapType(std::string_view mapType);
+
+    /// References held on @p mapType.
+    [[nodiscard]] std::size_t MapTypeRefCount(std::string_view mapType) const;
+
     /// Update all active plugins.
     ///
+    /// Without a parallel executor plugins update one by one in
+    /// dependency order.  With one, plugins are grouped into waves (a
+    /// plugin's wave follows those of its dependencies and
+    /// PluginUpdatePolicy::updateAfter entries); within a wave the
+    /// thread-safe plugins run in parallel, then the others in order.
+    ///
+    /// Each OnUpdate() is timed into GetUpdateStats().  A plugin over its
+    /// budget is reported with a PluginBudgetExceededEvent once its wave
+    /// has finished.  When SetUpdateBudget() is set and already spent,
+    /// deferrable plugins skip this tick (never two in a row) and receive
+    /// the skipped time in their next deltaTime.
+    ///
     /// @param deltaTime  Frame delta time in seconds.
     void UpdateAll(float deltaTime);
 
+    /// Function that executes a vector of tasks in parallel and blocks
+    /// until all complete (same shape as SystemScheduler::ParallelExecutor,
+    /// so `std::ref(workStealingExecutor)` fits).
+    using ParallelExecutor = std::function<void(const std::vector<std::function<void()>>&)>;
+
+    /// Set the executor for thread-safe plugin updates (nullptr: serial).
+    void SetParallelExecutor(ParallelExecutor executor);
+
+    /// Soft budget for a whole UpdateAll(); zero (the default) never
+    /// defers plugins.
+    void SetUpdateBudget(std::chrono::microseconds budget) noexcept;
+
+    /// Update timing of a loaded plugin.
+    [[nodiscard]] cgs::foundation::GameResult<PluginUpdateStats> GetUpdateStats(
+        std::string_view name) const;
+
     /// Shut down a single plugin (Active/Initialized → Loaded).
     [[nodiscard]] cgs::foundation::GameResult<void> ShutdownPlugin(std::string_view name);
 
-    /// Shut down all active/initialized plugins in reverse dependency order.
+    /// Shut down all active/initialized plugins in reverse dependency
+    /// order and release every map type.
     void ShutdownAll();
 
     /// Unload a single plugin (Loaded → Unloaded, removed from manager).
@@ -108,6 +180,64 @@ public:
     /// Unload all plugins.
     void UnloadAll();
 
+    // ── Staged replacement (hot reload) ────────────────────────────────
+
+    /// A plugin instance loaded and initialized outside the manager,
+    /// waiting to replace the running plugin of the same name.
+    ///
+    /// Destroying it without SwapPlugin() shuts the instance down, unloads
+    /// it and closes its library, leaving the running plugin untouched.
+    class StagedPlugin {
+    public:
+        StagedPlugin() = default;
+        ~StagedPlugin();
+
+        StagedPlugin(const StagedPlugin&) = delete;
+        StagedPlugin& operator=(const StagedPlugin&) = delete;
+        StagedPlugin(StagedPlugin&& other) noexcept;
+        StagedPlugin& operator=(StagedPlugin&& other) noexcept;
+
+        /// The staged instance (nullptr once swapped in or discarded).
+        [[nodiscard]] IPlugin* Get() const noexcept { return plugin_.get(); }
+
+        explicit operator bool() const noexcept { return plugin_ != nullptr; }
+
+    private:
+        friend class PluginManager;
+
+        void reset() noexcept;
+
+        std::unique_ptr<IPlugin> plugin_;
+        void* libraryHandle_ = nullptr;
+        PluginState state_ = PluginState::Unloaded;  ///< Loaded/Initialized once prepared.
+    };
+
+    /// Load a plugin library and run OnLoad() and OnInit() without
+    /// registering it.
+    ///
+    /// Touches only the library and the plugin context, so it may run on
+    /// a background thread while the manager keeps ticking (but not
+    /// concurrently with SetContext()).  The library path must differ
+    /// from the running plugin's: the platform loader returns the already
+    /// open library for a path it has loaded.
+    [[nodiscard]] cgs::foundation::GameResult<StagedPlugin> StagePlugin(
+        const std::filesystem::path& path);
+
+    /// Stage a pre-created plugin instance (static plugins, tests).
+    [[nodiscard]] cgs::foundation::GameResult<StagedPlugin> StagePlugin(
+        std::unique_ptr<IPlugin> plugin);
+
+    /// Replace the running plugin of the same name with @p staged.
+    ///
+    /// Call between ticks.  The old instance is shut down and unloaded,
+    /// the staged one takes over its slot and state (Active stays
+    /// Active), and lifecycle events are published for both.
+    ///
+    /// @return PluginNotFound if no plugin of that name is loaded, or
+    ///         PluginInvalidState if it is not Active or Initialized; the
+    ///         staged instance is discarded in both cases.
+    [[nodiscard]] cgs::foundation::GameResult<void> SwapPlugin(StagedPlugin staged);
+
     // ── Queries ────────────────────────────────────────────────────────
 
     /// Retrieve a loaded plugin by name (nullptr if not found).
@@ -147,6 +277,9 @@ public:
         bool success = true;
         std::vector<DependencyIssue> issues;
         std::vector<std::string> loadOrder;
+        /// loadOrder grouped by depth: each plugin's loaded dependencies
+        /// are all in earlier levels, so a level's plugins are independent.
+        std::vector<std::vector<std::string>> loadLevels;
         std::vector<std::string> cyclePath;  ///< Non-empty if circular dep found.
     };
 
@@ -163,14 +296,54 @@ private:
         void* libraryHandle = nullptr;  ///< dlopen handle (nullptr for static).
         PluginState state = PluginState::Unloaded;
         std::chrono::steady_clock::time_point loadedAt;
+
+        PluginUpdatePolicy policy;    ///< From GetUpdatePolicy() at plan build.
+        PluginUpdateStats stats;
+        float pendingDelta = 0.0f;    ///< Time skipped by deferral.
+        bool deferredLastTick = false;
+        bool overran = false;         ///< Last update exceeded the budget.
+        /// AllocTracker tag ("plugin.<name>") set during OnUpdate().
+        cgs::foundation::AllocTag allocTag = cgs::foundation::AllocTracker::kUntagged;
     };
 
+    /// One wave of UpdateAll(): parallel entries first, then serial ones.
+    struct UpdateWave {
+        std::vector<PluginEntry*> parallel;
+        std::vector<PluginEntry*> serial;
+    };
+
+    /// Open a plugin library and create its instance.
+    [[nodiscard]] static cgs::foundation::GameResult<StagedPlugin> openLibrary(
+        const std::filesystem::path& path);
+
+    /// Check the API version and run OnLoad() / OnInit() on @p staged.
+    [[nodiscard]] cgs::foundation::GameResult<StagedPlugin> prepareStaged(StagedPlugin staged);
+
     /// Load a pre-created plugin instance into the manager.
     [[nodiscard]] cgs::foundation::GameResult<void> loadPluginInstance(
         std::unique_ptr<IPlugin> plugin, void* libraryHandle);
 
     /// Resolve dependency ordering via topological sort.
-    [[nodiscard]] cgs::foundation::GameResult<std::vector<std::string>> resolveDependencies() const;
+    [[nodiscard]] cgs::foundation::GameResult<DependencyReport> resolveDependencies() const;
+
+    /// Record OnInit()'s outcome @p ok for @p entry and publish the event.
+    [[nodiscard]] cgs::foundation::GameResult<void> finishInit(const std::string& name,
+                                                               PluginEntry& entry, bool ok);
+
+    /// Initialize the Loaded plugins in @p wanted, level by level.
+    [[nodiscard]] cgs::foundation::GameResult<void> initLevels(
+        const std::unordered_set<std::string>& wanted);
+
+    /// @p roots plus every loaded plugin they depend on, transitively.
+    [[nodiscard]] std::unordered_set<std::string> withDependencies(
+        const std::vector<std::string>& roots) const;
+
+    /// Plugins that list @p mapType in PluginInfo::mapTypes.
+    [[nodiscard]] std::vector<std::string> pluginsForMapType(std::string_view mapType) const;
+
+    /// Plugins needed now: the always-needed ones, those of acquired map
+    /// types, and their dependencies.
+    [[nodiscard]] std::unordered_set<std::string> neededPlugins() const;
 
     /// Validate version constraints for all loaded plugins.
     void validateVersionConstraints(DependencyReport& report) const;
@@ -179,6 +352,16 @@ private:
     [[nodiscard]] std::vector<std::string> detectCycle(
         const std::unordered_map<std::string, std::vector<std::string>>& graph) const;
 
+    /// Group plugins into update waves (see UpdateAll()).
+    void buildUpdatePlan();
+
+    /// Run one plugin's OnUpdate() if it is active, timing it.
+    static void updatePlugin(PluginEntry& entry, float deltaTime);
+
+    /// Whether @p entry skips this tick; records the deferral.
+    [[nodiscard]] bool deferUpdate(PluginEntry& entry, float deltaTime,
+                                   std::chrono::steady_clock::time_point tickStart) const;
+
     /// Close a dynamic library handle.
     static void closeLibrary(void* handle);
 
@@ -188,11 +371,27 @@ private:
     /// Dependency-resolved load order (populated by InitializeAll).
     std::vector<std::string> loadOrder_;
 
+    /// loadOrder_ grouped into independent levels (see DependencyReport).
+    std::vector<std::vector<std::string>> loadLevels_;
+
+    /// Map type -> references taken by AcquireMapType().
+    std::unordered_map<std::string, std::size_t> mapTypeRefs_;
+
     /// Plugin context shared with all plugins.
     PluginContext context_;
 
     /// Event bus for inter-plugin communication and lifecycle events.
     EventBus eventBus_;
+
+    /// Update waves; rebuilt when the plugin set or executor changes.
+    std::vector<UpdateWave> updatePlan_;
+    bool updatePlanDirty_ = true;
+
+    ParallelExecutor parallelExecutor_;
+    std::chrono::microseconds updateBudget_{0};
+
+    /// Tasks handed to parallelExecutor_, reused across ticks.
+    std::vector<std::function<void()>> updateTasks_;
 };
 
 }  // namespace cgs::plugin
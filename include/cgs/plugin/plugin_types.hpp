@@ -8,6 +8,7 @@
 
 #include "cgs/foundation/service_locator.hpp"
 
+#include <chrono>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -36,6 +37,25 @@ struct Version {
     auto operator<=>(const Version&) const = default;
 };
 
+/// How PluginManager::UpdateAll() may schedule a plugin's OnUpdate().
+struct PluginUpdatePolicy {
+    /// OnUpdate() may run on a worker thread concurrently with other
+    /// thread-safe plugins (only with a parallel executor set).
+    bool threadSafe = false;
+
+    /// Plugins whose OnUpdate() must finish first, in addition to the
+    /// plugins listed in PluginInfo::dependencies.
+    std::vector<std::string> updateAfter;
+
+    /// Soft per-update budget; exceeding it is counted and reported with
+    /// a PluginBudgetExceededEvent.  Zero disables the check.
+    std::chrono::microseconds budget{0};
+
+    /// Non-critical: once the tick's update budget is spent, the update
+    /// may be skipped and run next tick with the accumulated delta time.
+    bool deferrable = false;
+};
+
 /// Metadata describing a plugin.
 struct PluginInfo {
     std::string name;
@@ -43,6 +63,18 @@ struct PluginInfo {
     Version version;
     std::vector<std::string> dependencies;
     uint32_t apiVersion = kPluginApiVersion;
+
+    /// OnInit() may run on a worker thread concurrently with the other
+    /// plugins of its dependency level (only with a parallel executor
+    /// set).  It must then touch nothing but the plugin's own state and
+    /// thread-safe services.
+    bool threadSafeInit = false;
+
+    /// Map types (e.g. "dungeon", "battleground") this plugin is needed
+    /// for.  Empty: always needed.  Otherwise the plugin is initialized
+    /// and activated lazily, by PluginManager::AcquireMapType(), unless
+    /// an always-needed plugin depends on it.
+    std::vector<std::string> mapTypes{};
 };
 
 /// Runtime context passed to plugins during their Load phase.
@@ -50,9 +82,18 @@ struct PluginInfo {
 /// Provides access to foundation services (logger, config, etc.)
 /// via the ServiceLocator, and to the shared EventBus for
 /// inter-plugin communication.
+///
+/// Plugins that use a service on every update should resolve it once in
+/// OnLoad() with GetService<T>() and keep the handle.
 struct PluginContext {
     cgs::foundation::ServiceLocator* services = nullptr;
     EventBus* eventBus = nullptr;
+
+    /// Handle to service T (an empty handle if there is no locator).
+    template <typename T>
+    [[nodiscard]] cgs::foundation::ServiceHandle<T> GetService() const {
+        return services != nullptr ? services->handle<T>() : cgs::foundation::ServiceHandle<T>{};
+    }
 };
 
 /// Plugin lifecycle states.
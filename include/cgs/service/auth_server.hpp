@@ -12,10 +12,18 @@
 #include "cgs/foundation/game_result.hpp"
 #include "cgs/service/auth_types.hpp"
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <string_view>
 
+namespace cgs::foundation {
+class BlockingExecutor;
+}  // namespace cgs::foundation
+
 namespace cgs::service {
 
 class IUserRepository;
@@ -24,6 +32,25 @@ class TokenProvider;
 class PasswordHasher;
 class RateLimiter;
 class TokenBlacklist;
+class VerifiedTokenCache;
+
+/// Receives the result of AuthServer::validateTokenAsync().
+using TokenValidationCallback = std::function<void(cgs::foundation::GameResult<TokenClaims>)>;
+
+/// Receives the result of AuthServer::loginAsync().
+using LoginCallback = std::function<void(cgs::foundation::GameResult<TokenPair>)>;
+
+/// Counters of the password hashing pool behind AuthServer::loginAsync().
+struct LoginPoolStats {
+    std::size_t pending = 0;       ///< Logins queued or hashing now.
+    uint64_t completed = 0;        ///< Logins that ran (either outcome).
+    uint64_t shed = 0;             ///< Rejected with the queue full.
+    uint64_t expired = 0;          ///< Dropped past the queue deadline.
+    std::chrono::microseconds totalQueueWait{};
+    std::chrono::microseconds maxQueueWait{};
+    std::chrono::microseconds totalHashTime{};  ///< In PasswordHasher::verify().
+    std::chrono::microseconds maxHashTime{};
+};
 
 /// Authentication server implementing user registration, login/logout,
 /// JWT token issuance, refresh token management, access token revocation,
@@ -61,6 +88,23 @@ public:
                                                                std::string_view password,
                                                                const std::string& clientIp);
 
+    /// Authenticate on the password hashing pool and pass the result to
+    /// @p onDone.
+    ///
+    /// Rate limiting runs inline.  The password check then runs on one of
+    /// AuthConfig::passwordHashThreads workers, where @p onDone is called,
+    /// keeping the hash off the caller's (e.g. an I/O) thread.  With
+    /// AuthConfig::passwordHashQueueLimit logins pending, or once a login
+    /// has waited past AuthConfig::passwordHashQueueDeadline, it fails with
+    /// ErrorCode::AuthOverloaded without hashing.
+    void loginAsync(std::string_view username,
+                    std::string_view password,
+                    const std::string& clientIp,
+                    LoginCallback onDone);
+
+    /// Snapshot of the password hashing pool counters.
+    [[nodiscard]] LoginPoolStats loginPoolStats() const;
+
     /// Refresh an access token using a refresh token (SRS-SVC-001.4).
     [[nodiscard]] cgs::foundation::GameResult<TokenPair> refreshToken(
         std::string_view refreshToken);
@@ -73,9 +117,24 @@ public:
 
     /// Validate an access token and return decoded claims.
     /// Checks the token blacklist after signature verification.
+    ///
+    /// Verified tokens are cached (AuthConfig::tokenCacheCapacity) until
+    /// their expiry or revocation, so validating the same token again
+    /// skips parsing and signature checks.
     [[nodiscard]] cgs::foundation::GameResult<TokenClaims> validateToken(
         std::string_view accessToken) const;
 
+    /// Validate an access token and pass the result to @p onDone.
+    ///
+    /// Cached tokens complete inline.  With an RSA public key configured,
+    /// other tokens are verified on one of AuthConfig::tokenVerifyThreads
+    /// workers and @p onDone runs there, keeping RS256 off the caller's
+    /// (e.g. an I/O) thread; otherwise verification runs inline.
+    void validateTokenAsync(std::string_view accessToken, TokenValidationCallback onDone) const;
+
+    /// Number of verified tokens currently cached.
+    [[nodiscard]] std::size_t cachedTokenCount() const;
+
     /// Revoke an access token by adding it to the blacklist (SRS-NFR-014).
     ///
     /// The token is decoded to extract the jti (JWT ID) and expiry,
@@ -86,7 +145,16 @@ public:
     /// Returns the number of entries removed.
     std::size_t cleanupBlacklist();
 
+    /// The access token blacklist, e.g. to replicate revocations between
+    /// nodes (TokenBlacklist::onReplicate / merge()).
+    [[nodiscard]] TokenBlacklist& blacklist() noexcept;
+
 private:
+    struct LoginPipeline;
+
+    // True (and the entry dropped) if a cached token was revoked since.
+    [[nodiscard]] bool revokedSinceCached(const TokenClaims& claims) const;
+
     [[nodiscard]] bool isValidEmail(std::string_view email) const;
     [[nodiscard]] bool isValidUsername(std::string_view username) const;
     [[nodiscard]] bool isStrongPassword(std::string_view password) const;
@@ -98,6 +166,10 @@ private:
     std::unique_ptr<PasswordHasher> passwordHasher_;
     std::unique_ptr<RateLimiter> rateLimiter_;
     std::unique_ptr<TokenBlacklist> blacklist_;
+    std::unique_ptr<VerifiedTokenCache> tokenCache_;
+    // Last: joined first
+    std::unique_ptr<LoginPipeline> logins_;
+    std::unique_ptr<cgs::foundation::BlockingExecutor> verifier_;
 };
 
 }  // namespace cgs::service
@@ -10,6 +10,7 @@
 /// @see SDS-MOD-040
 
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -96,14 +97,37 @@ struct AuthConfig {
     /// Interval between blacklist cleanup passes.
     std::chrono::seconds blacklistCleanupInterval{300};  // 5 minutes
 
+    /// Verified access tokens remembered by validateToken() (0 disables).
+    std::size_t tokenCacheCapacity = 65536;
+
+    /// Worker threads for RS256 verification in validateTokenAsync().
+    uint32_t tokenVerifyThreads = 2;
+
     /// Minimum password length.
     uint32_t minPasswordLength = 8;
 
     /// Maximum login attempts per key within the rate window.
     uint32_t rateLimitMaxAttempts = 5;
 
-    /// Sliding window duration for rate limiting.
+    /// Window over which rateLimitMaxAttempts applies.
     std::chrono::seconds rateLimitWindow{60};  // 1 minute
+
+    /// Client keys the login rate limiter tracks before evicting the
+    /// least recently seen.
+    std::size_t rateLimitMaxKeys = 65536;
+
+    /// Password hashing cost: 0 for salted SHA-256, N for scrypt with 2^N
+    /// iterations (see PasswordHasher; 14 or more in production).
+    uint32_t passwordHashCost = 0;
+
+    /// Worker threads hashing passwords for loginAsync() (0 runs inline).
+    uint32_t passwordHashThreads = 2;
+
+    /// Async logins queued or hashing before new ones are shed.
+    std::size_t passwordHashQueueLimit = 256;
+
+    /// Async logins still queued after this long fail without hashing.
+    std::chrono::milliseconds passwordHashQueueDeadline{2000};
 };
 
 // -- Credential input ---------------------------------------------------------
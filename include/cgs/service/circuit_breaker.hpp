@@ -9,13 +9,20 @@
 
 #include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
-#include <mutex>
+#include <memory>
 #include <string>
 #include <string_view>
 
 namespace cgs::service {
 
+/// What opens a closed ServiceCircuitBreaker.
+enum class CircuitBreakerMode : uint8_t {
+    ConsecutiveFailures,  ///< failureThreshold failures in a row.
+    FailureRate,          ///< failureRateThreshold of the calls in a sliding window.
+};
+
 /// Configuration for a ServiceCircuitBreaker instance.
 struct CircuitBreakerConfig {
     /// Number of consecutive failures before the circuit opens.
@@ -27,6 +34,22 @@ struct CircuitBreakerConfig {
     /// Number of consecutive successes in half-open to close the circuit.
     uint32_t successThreshold = 2;
 
+    /// Open on consecutive failures (default) or on the failure rate.
+    CircuitBreakerMode mode = CircuitBreakerMode::ConsecutiveFailures;
+
+    /// FailureRate mode: fraction of failed calls in the window that opens
+    /// the circuit.
+    double failureRateThreshold = 0.5;
+
+    /// FailureRate mode: calls the window must hold before the rate counts.
+    uint32_t minimumRequests = 20;
+
+    /// FailureRate mode: length of the sliding window.
+    std::chrono::milliseconds window{10000};
+
+    /// FailureRate mode: buckets the window slides by.
+    uint32_t windowBuckets = 10;
+
     /// Human-readable name for logging and metrics.
     std::string name = "default";
 };
@@ -48,7 +71,10 @@ struct CircuitBreakerConfig {
 ///   }
 /// @endcode
 ///
-/// Thread-safe: all state transitions use a mutex.
+/// Thread-safe and lock-free: the state and its counters share one atomic
+/// word that transitions update with a CAS, so a call through a healthy
+/// circuit costs a load.  FailureRate mode counts calls in per-thread
+/// striped buckets and sums them only when a failure is recorded.
 class ServiceCircuitBreaker {
 public:
     /// Circuit breaker states.
@@ -85,9 +111,14 @@ public:
     /// Current circuit state.
     [[nodiscard]] State state() const;
 
-    /// Number of consecutive failures in the current state.
+    /// Number of consecutive failures in the current state (FailureRate
+    /// mode: failures in the window).
     [[nodiscard]] uint32_t failureCount() const;
 
+    /// Failed fraction of the calls in the window (FailureRate mode; 0
+    /// when the window is empty or in ConsecutiveFailures mode).
+    [[nodiscard]] double failureRate() const;
+
     /// Number of consecutive successes in HalfOpen state.
     [[nodiscard]] uint32_t halfOpenSuccessCount() const;
 
@@ -98,15 +129,34 @@ public:
     [[nodiscard]] std::string_view name() const;
 
 private:
-    void transitionTo(State newState);
+    struct WindowTotals {
+        uint64_t calls = 0;
+        uint64_t failures = 0;
+    };
+
+    /// CAS the state word from @p expected (reloaded on failure) to
+    /// @p desired, with the side effects of entering its state.
+    bool transition(uint64_t& expected, uint64_t desired);
+    void clearWindow();
+    int64_t nowTicks() const;
+    uint64_t bucketIndex(int64_t ticks) const;
+    void recordInWindow(bool failed);
+    WindowTotals windowTotals() const;
 
     CircuitBreakerConfig config_;
-    mutable std::mutex mutex_;
-    State state_{State::Closed};
-    uint32_t consecutiveFailures_{0};
-    uint32_t halfOpenSuccesses_{0};
-    uint64_t totalRejected_{0};
-    std::chrono::steady_clock::time_point lastFailureTime_{};
+    const std::chrono::steady_clock::time_point origin_;
+
+    /// [state:2][consecutive failures:31][half-open successes:31].
+    std::atomic<uint64_t> word_{0};
+    std::atomic<uint64_t> totalRejected_{0};
+    /// Steady-clock ticks since origin_ of the last failure or opening.
+    std::atomic<int64_t> lastFailureTicks_{0};
+
+    /// FailureRate mode: stripes of windowBuckets slots, each
+    /// [bucket index:24][successes:20][failures:20].
+    std::unique_ptr<std::atomic<uint64_t>[]> window_;
+    std::size_t stripeStride_ = 0;
+    int64_t bucketTicks_ = 1;
 };
 
 /// Convert circuit breaker state to string.
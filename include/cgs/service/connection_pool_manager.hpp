@@ -4,8 +4,23 @@
 /// @brief Manages primary and read-replica database connection pools.
 ///
 /// Provides query routing: write operations go to the primary,
-/// SELECT queries are distributed across read replicas using
-/// round-robin. Falls back to primary if no replicas are available.
+/// SELECT queries are distributed across read replicas by
+/// ReplicaBalancer (latency and outstanding reads). Falls back to primary
+/// if no replicas are available.
+///
+/// Optionally (DBProxyConfig::trackReplicationLag) replica lag is probed
+/// and replicas behind DBProxyConfig::maxReplicaLag get no reads.  A
+/// caller passing a session id (any non-zero key, e.g. a player id) reads
+/// its own writes: after it writes, its reads go to the primary for
+/// DBProxyConfig::readYourWritesWindow or the probed lag, if longer.
+///
+/// Each endpoint's pool is pre-warmed to minConnections by start(), grows
+/// toward maxConnections when checkouts wait longer than growAfterWait,
+/// and is shrunk and rotated by maintainPools().
+///
+/// With DBProxyConfig::writeBatch enabled, single INSERT/UPDATE/DELETE
+/// statements from concurrent callers share transactions (WriteCombiner)
+/// unless sent with WriteMode::Immediate.
 ///
 /// @see SRS-SVC-005.1, SRS-SVC-005.4
 /// @see SDS-MOD-034
@@ -13,6 +28,7 @@
 #include "cgs/foundation/game_result.hpp"
 #include "cgs/service/dbproxy_types.hpp"
 
+#include <cstdint>
 #include <memory>
 #include <string_view>
 
@@ -54,25 +70,59 @@ public:
     /// Check if the primary connection is alive.
     [[nodiscard]] bool isConnected() const noexcept;
 
-    /// Execute a SELECT query, routing to a replica if available.
+    /// Execute a SELECT query, routing to a replica if available and
+    /// @p session is not pinned to the primary.
     [[nodiscard]] cgs::foundation::GameResult<cgs::foundation::QueryResult> query(
-        std::string_view sql);
-
-    /// Execute a write command (INSERT/UPDATE/DELETE) on the primary.
-    [[nodiscard]] cgs::foundation::GameResult<uint64_t> execute(std::string_view sql);
+        std::string_view sql, uint64_t session = 0);
+
+    /// Stream a SELECT in batches (see GameDatabase::queryStream()), routed
+    /// like query().  A replica failing before its first batch falls back
+    /// to the primary; one failing later fails the stream.
+    [[nodiscard]] cgs::foundation::GameResult<uint64_t> queryStream(
+        std::string_view sql,
+        const cgs::foundation::RowBatchCallback& onBatch,
+        std::size_t batchRows = 1000,
+        uint64_t session = 0);
+
+    /// Execute a write command (INSERT/UPDATE/DELETE) on the primary,
+    /// possibly in a transaction shared with concurrent writes.
+    [[nodiscard]] cgs::foundation::GameResult<uint64_t> execute(
+        std::string_view sql, uint64_t session = 0, WriteMode mode = WriteMode::Combined);
 
     /// Execute a parameterized SELECT query, routing to a replica if available.
     ///
     /// Uses PreparedStatement for SQL injection prevention (SRS-NFR-016).
-    /// The statement is resolved to safe SQL before execution.
+    /// On PostgreSQL the statement is prepared server-side and cached per
+    /// connection (see GameDatabase::execute(const PreparedStatement&)).
     [[nodiscard]] cgs::foundation::GameResult<cgs::foundation::QueryResult> query(
-        const cgs::foundation::PreparedStatement& stmt);
+        const cgs::foundation::PreparedStatement& stmt, uint64_t session = 0);
 
     /// Execute a parameterized write command on the primary.
     ///
     /// Uses PreparedStatement for SQL injection prevention (SRS-NFR-016).
+    /// A combined write is sent as resolved SQL and reports its affected
+    /// rows; otherwise the statement is prepared server-side and reports 0.
     [[nodiscard]] cgs::foundation::GameResult<uint64_t> execute(
-        const cgs::foundation::PreparedStatement& stmt);
+        const cgs::foundation::PreparedStatement& stmt,
+        uint64_t session = 0,
+        WriteMode mode = WriteMode::Combined);
+
+    /// Write a batch of rows on the primary in one transaction
+    /// (see GameDatabase::write()).
+    [[nodiscard]] cgs::foundation::GameResult<uint64_t> write(
+        const cgs::foundation::BatchWriter& batch, uint64_t session = 0);
+
+    /// Whether @p session's reads go to the primary (it wrote recently).
+    [[nodiscard]] bool pinnedToPrimary(uint64_t session) const;
+
+    /// Probe the replication lag of each connected PostgreSQL replica.
+    /// DBProxyServer calls this every DBProxyConfig::lagProbeInterval.
+    void refreshReplicationLag();
+
+    /// Shrink idle pools toward DBEndpointConfig::minConnections, rotate
+    /// connections past maxLifetime and refill to the minimum.  DBProxyServer
+    /// calls this every DBProxyConfig::poolMaintenanceInterval.
+    void maintainPools();
 
     /// Get the number of available replicas.
     [[nodiscard]] std::size_t replicaCount() const;
@@ -0,0 +1,31 @@
+#pragma once
+
+/// @file crc32c.hpp
+/// @brief CRC-32C (Castagnoli) checksums for WAL and snapshot files.
+///
+/// Uses the CPU's CRC32 instruction where available (SSE4.2 on x86-64,
+/// detected at run time; the CRC extension on ARMv8 builds that enable
+/// it) and a slice-by-8 table walk otherwise.
+///
+/// Part of SRS-NFR-013 (zero data loss on crash).
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cgs::service {
+
+/// CRC-32C of @p size bytes at @p data.
+///
+/// Pass a previous result as @p crc to continue over more bytes:
+/// crc32c(b, nb, crc32c(a, na)) equals the checksum of a followed by b.
+[[nodiscard]] uint32_t crc32c(const void* data, std::size_t size, uint32_t crc = 0) noexcept;
+
+/// crc32c() without CPU instructions (slice-by-8); same results.
+[[nodiscard]] uint32_t crc32cPortable(const void* data,
+                                      std::size_t size,
+                                      uint32_t crc = 0) noexcept;
+
+/// Whether crc32c() runs on the CPU's CRC32 instruction.
+[[nodiscard]] bool crc32cHardwareAccelerated() noexcept;
+
+}  // namespace cgs::service
@@ -8,8 +8,11 @@
 /// database queries. It provides:
 /// - Connection pooling with configurable pool sizes.
 /// - LRU query cache with TTL for read-heavy data (templates, configs).
+/// - Optional second-level cache shared by all dbproxy instances.
+/// - Coalescing of concurrent identical reads into one database query.
 /// - Cache invalidation on write operations.
 /// - Read replica routing for SELECT query load distribution.
+/// - Streaming of large result sets in batches, past the cache.
 /// - Connection metrics: pool utilization, query latency histogram.
 ///
 /// @see SRS-SVC-005
@@ -17,14 +20,18 @@
 
 #include "cgs/foundation/game_database.hpp"
 #include "cgs/foundation/game_result.hpp"
+#include "cgs/foundation/task.hpp"
 #include "cgs/service/dbproxy_types.hpp"
 
 #include <future>
 #include <memory>
 #include <string_view>
+#include <vector>
 
 namespace cgs::service {
 
+class ISharedResultStore;
+
 /// Database Proxy Server.
 ///
 /// Usage:
@@ -46,7 +53,12 @@ namespace cgs::service {
 /// @endcode
 class DBProxyServer {
 public:
-    explicit DBProxyServer(DBProxyConfig config);
+    /// Construct with @p config.  With a @p sharedStore (and the cache
+    /// enabled), local cache misses consult a SharedResultCache in it
+    /// before the database, fill it in the background, and writes retire
+    /// its entries for every instance (DBProxyConfig::sharedCache).
+    explicit DBProxyServer(DBProxyConfig config,
+                           std::shared_ptr<ISharedResultStore> sharedStore = nullptr);
     ~DBProxyServer();
 
     DBProxyServer(const DBProxyServer&) = delete;
@@ -69,22 +81,66 @@ public:
 
     /// Execute a SELECT query.
     ///
-    /// The query is first checked against the cache. On cache miss,
-    /// it is routed to a read replica (if available) or the primary.
-    /// Results are cached for future reads.
+    /// The query is first checked against the cache. On cache miss, it
+    /// joins an identical read already in flight (DBProxyConfig::
+    /// coalesceReads) or is routed to a read replica (if available) or the
+    /// primary. Results are cached for future reads.
+    ///
+    /// With DBProxyConfig::normalizeQueries, cache and in-flight reads are
+    /// keyed on the normalized text (see normalizeSql()), so spacing,
+    /// comments and keyword case do not split entries; with
+    /// DBProxyConfig::prepareQueries a SELECT whose literals are all value
+    /// operands runs as a server-side prepared statement of its shape.
+    ///
+    /// With DBProxyConfig::readYourWritesWindow set, a @p session that wrote
+    /// recently reads from the primary, bypassing the cache.
     [[nodiscard]] cgs::foundation::GameResult<cgs::foundation::QueryResult> query(
-        std::string_view sql);
+        std::string_view sql, uint64_t session = 0);
+
+    /// Stream a large SELECT (exports, leaderboard rebuilds, migrations)
+    /// to @p onBatch in batches of up to @p batchRows rows, without
+    /// holding the whole result (see GameDatabase::queryStream()).
+    ///
+    /// Streams bypass the cache and read coalescing and are routed like
+    /// query(), holding one connection until the stream ends.
+    ///
+    /// @return the number of rows passed to @p onBatch.
+    [[nodiscard]] cgs::foundation::GameResult<uint64_t> queryStream(
+        std::string_view sql,
+        const cgs::foundation::RowBatchCallback& onBatch,
+        std::size_t batchRows = 1000,
+        uint64_t session = 0);
 
     /// Execute a write command (INSERT/UPDATE/DELETE/DDL).
     ///
     /// Always routed to the primary. Automatically invalidates cache
-    /// entries that reference tables mentioned in the SQL.
-    [[nodiscard]] cgs::foundation::GameResult<uint64_t> execute(std::string_view sql);
+    /// entries that reference tables mentioned in the SQL.  A nonzero
+    /// @p session is pinned to the primary for its next reads.
+    ///
+    /// With DBProxyConfig::writeBatch enabled, the write may wait up to
+    /// the batching window to share a transaction with concurrent writes;
+    /// WriteMode::Immediate sends it on its own at once.
+    [[nodiscard]] cgs::foundation::GameResult<uint64_t> execute(
+        std::string_view sql, uint64_t session = 0, WriteMode mode = WriteMode::Combined);
 
     /// Execute a SELECT query asynchronously.
+    ///
+    /// Asynchronous queries run on query workers started by start(), one
+    /// per configured connection; further requests queue.  A SELECT that
+    /// joins an identical read in flight takes no worker until it
+    /// completes.
     [[nodiscard]] std::future<cgs::foundation::GameResult<cgs::foundation::QueryResult>> queryAsync(
         std::string_view sql);
 
+    /// Execute a SELECT query asynchronously and pass the result to
+    /// @p onDone on a query worker (inline with DBProxyNotStarted if the
+    /// proxy is not running).
+    void queryAsync(std::string_view sql, cgs::foundation::QueryCallback onDone);
+
+    /// Coroutine form of queryAsync(); resumes on the query worker.
+    [[nodiscard]] cgs::foundation::Task<cgs::foundation::GameResult<cgs::foundation::QueryResult>>
+    queryTask(std::string sql);
+
     // ── Parameterized query execution (SRS-NFR-016) ──────────────────────
 
     /// Execute a parameterized SELECT query using PreparedStatement.
@@ -92,25 +148,41 @@ public:
     /// Prevents SQL injection by resolving bound parameters with proper
     /// escaping. Cache lookup uses the resolved SQL string.
     [[nodiscard]] cgs::foundation::GameResult<cgs::foundation::QueryResult> query(
-        const cgs::foundation::PreparedStatement& stmt);
+        const cgs::foundation::PreparedStatement& stmt, uint64_t session = 0);
 
     /// Execute a parameterized write command using PreparedStatement.
     ///
     /// Prevents SQL injection by resolving bound parameters with proper
     /// escaping. Cache invalidation uses the resolved SQL.
     [[nodiscard]] cgs::foundation::GameResult<uint64_t> execute(
-        const cgs::foundation::PreparedStatement& stmt);
+        const cgs::foundation::PreparedStatement& stmt,
+        uint64_t session = 0,
+        WriteMode mode = WriteMode::Combined);
+
+    /// Write a batch of rows on the primary in one transaction and
+    /// invalidate the cache entries of its table.
+    [[nodiscard]] cgs::foundation::GameResult<uint64_t> write(
+        const cgs::foundation::BatchWriter& batch, uint64_t session = 0);
 
     /// Execute a parameterized SELECT query asynchronously.
     [[nodiscard]] std::future<cgs::foundation::GameResult<cgs::foundation::QueryResult>> queryAsync(
         const cgs::foundation::PreparedStatement& stmt);
 
+    /// Callback form of the parameterized queryAsync().
+    void queryAsync(const cgs::foundation::PreparedStatement& stmt,
+                    cgs::foundation::QueryCallback onDone);
+
+    /// Coroutine form of the parameterized queryAsync().
+    [[nodiscard]] cgs::foundation::Task<cgs::foundation::GameResult<cgs::foundation::QueryResult>>
+    queryTask(cgs::foundation::PreparedStatement stmt);
+
     // ── Cache management ────────────────────────────────────────────────
 
-    /// Manually invalidate all cache entries for a specific table.
+    /// Manually invalidate all cache entries for a specific table, in the
+    /// shared cache as well.
     std::size_t invalidateCache(std::string_view tableName);
 
-    /// Clear the entire cache.
+    /// Clear the entire local cache (the shared cache is left as is).
     void clearCache();
 
     /// Get current cache entry count.
@@ -124,6 +196,10 @@ public:
     /// Get pool and cache statistics.
     [[nodiscard]] PoolStats poolStats() const;
 
+    /// Count and latency per query shape (DBProxyConfig::normalizeQueries),
+    /// costliest first.
+    [[nodiscard]] std::vector<QueryShapeStats> queryShapes() const;
+
     /// Get total number of queries executed.
     [[nodiscard]] uint64_t totalQueries() const;
 
@@ -14,6 +14,7 @@
 #include <chrono>
 #include <cstdint>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace cgs::service {
@@ -22,9 +23,15 @@ namespace cgs::service {
 struct DBEndpointConfig {
     std::string connectionString;
     cgs::foundation::DatabaseType dbType = cgs::foundation::DatabaseType::PostgreSQL;
-    uint32_t minConnections = 2;
+    uint32_t minConnections = 2;  ///< Pre-warmed at start(); idle shrink stops here.
     uint32_t maxConnections = 10;
     std::chrono::seconds connectionTimeout{30};
+
+    // Adaptive sizing (see cgs::foundation::DatabaseConfig).
+    std::chrono::milliseconds growAfterWait{0};  ///< Queue wait before opening a connection.
+    std::chrono::seconds idleTimeout{0};         ///< Close idle connections above min (0 = never).
+    std::chrono::seconds maxLifetime{0};         ///< Rotate connections this old (0 = never).
+    double poolJitter = 0.2;                     ///< +/- share applied to both per connection.
 };
 
 /// Configuration for the LRU query cache.
@@ -33,6 +40,34 @@ struct CacheConfig {
     std::size_t maxEntries = 10000;           ///< Maximum cached queries.
     std::chrono::seconds defaultTtl{300};     ///< Default TTL (5 minutes).
     std::size_t maxValueSizeBytes = 1048576;  ///< Max size per entry (1 MB).
+    std::size_t shards = 16;                  ///< Lock shards (fewer for small caches).
+    std::size_t maxTotalBytes = 268435456;    ///< Byte budget for all results (256 MB, 0 = none).
+    bool admissionFilter = true;              ///< TinyLFU: new entries must outrank the victim.
+
+    /// Byte cap per table (normalized name, e.g. "items").  A query counts
+    /// against the quota of every table it reads.
+    std::unordered_map<std::string, std::size_t> tableQuotaBytes;
+};
+
+/// Second-level cache shared by dbproxy instances (see SharedResultCache).
+/// Used when a store is passed to DBProxyServer and the cache is enabled.
+struct SharedCacheConfig {
+    std::string keyPrefix = "cgs:dbproxy:";   ///< Namespace of keys in the store.
+    std::chrono::seconds ttl{300};            ///< Lifetime of a stored result.
+    std::size_t maxValueSizeBytes = 1048576;  ///< Larger encoded results are not stored.
+};
+
+/// Group commit of small writes (see WriteCombiner).
+struct WriteBatchConfig {
+    bool enabled = false;                 ///< Let concurrent writes share transactions.
+    std::chrono::milliseconds window{2};  ///< How long a group's first write waits.
+    std::size_t maxStatements = 64;       ///< Statements that commit a group early.
+};
+
+/// How a write is sent when DBProxyConfig::writeBatch is enabled.
+enum class WriteMode : uint8_t {
+    Combined,   ///< May share a transaction with concurrent writes.
+    Immediate,  ///< Sent on its own at once (latency-critical writes).
 };
 
 /// Configuration for the DBProxy service.
@@ -40,7 +75,22 @@ struct DBProxyConfig {
     DBEndpointConfig primary;                      ///< Primary (read-write) database.
     std::vector<DBEndpointConfig> replicas;        ///< Read replicas (optional).
     CacheConfig cache;                             ///< Query cache settings.
+    SharedCacheConfig sharedCache;                 ///< Shared L2 cache settings.
     std::chrono::seconds healthCheckInterval{30};  ///< Health check period.
+    std::chrono::milliseconds poolMaintenanceInterval{1000};  ///< Idle shrink/rotation period.
+    bool coalesceReads = true;                     ///< Share one fetch among identical reads.
+    WriteBatchConfig writeBatch;                   ///< Group commit of writes (off by default).
+
+    // SQL normalization (see normalizeSql()).
+    bool normalizeQueries = true;       ///< Key cache/reads on normalized SQL; stats per shape.
+    bool prepareQueries = false;        ///< Run parameterizable SELECTs as prepared statements.
+    std::size_t maxQueryShapes = 1024;  ///< Shapes tracked; later ones are counted as "(other)".
+
+    // Replication lag (PostgreSQL replicas) and read-your-writes.
+    bool trackReplicationLag = false;                   ///< Probe replica lag periodically.
+    std::chrono::milliseconds lagProbeInterval{1000};   ///< Lag probe period.
+    std::chrono::milliseconds maxReplicaLag{5000};      ///< Replicas lagging more get no reads.
+    std::chrono::milliseconds readYourWritesWindow{0};  ///< Session pin to primary (0 = off).
 };
 
 /// Statistics for a single query execution.
@@ -50,6 +100,26 @@ struct QueryStats {
     bool routed_to_replica = false;  ///< Whether routed to a read replica.
 };
 
+/// Count and latency of one query shape (see normalizeSql()).
+struct QueryShapeStats {
+    uint64_t fingerprint = 0;  ///< NormalizedSql::fingerprint (0 for "(other)").
+    std::string shape;         ///< Normalized SQL with literals as placeholders.
+    uint64_t count = 0;        ///< Statements run.
+    double totalMs = 0.0;      ///< Summed latency, cache hits included.
+    double maxMs = 0.0;        ///< Slowest statement.
+};
+
+/// Routing state of one read replica.
+struct ReplicaStats {
+    bool connected = false;  ///< Whether the replica pool is connected.
+    double latencyMs = 0.0;  ///< Peak-EWMA read latency (decays while idle).
+    uint32_t inFlight = 0;   ///< Reads outstanding.
+    double score = 0.0;      ///< Routing cost; the lower of two sampled wins.
+    double lagMs = 0.0;      ///< Last probed replication lag.
+    uint64_t reads = 0;      ///< Reads routed to the replica.
+    uint64_t failures = 0;   ///< Reads that failed (retried on the primary).
+};
+
 /// Snapshot of DBProxy pool utilization.
 struct PoolStats {
     std::size_t primaryActive = 0;  ///< Active connections on primary.
@@ -59,6 +129,27 @@ struct PoolStats {
     std::size_t replicaCount = 0;   ///< Number of replica endpoints.
     std::size_t cacheEntries = 0;   ///< Current cache entry count.
     double cacheHitRate = 0.0;      ///< Cache hit rate (0.0 - 1.0).
+    std::size_t cacheBytes = 0;     ///< Bytes held by cached results.
+    uint64_t cacheRejected = 0;     ///< Puts refused by size, quota or admission.
+    uint64_t coalescedReads = 0;    ///< Reads served by a concurrent identical read.
+    uint64_t sharedCacheHits = 0;   ///< L1 misses served by the shared cache.
+    uint64_t sharedCacheMisses = 0; ///< Shared cache lookups that went to the database.
+    uint64_t sharedCacheStale = 0;  ///< Of those, entries outdated by a table write.
+    uint64_t pinnedReads = 0;       ///< Reads kept on the primary by read-your-writes.
+    uint64_t streams = 0;           ///< Completed queryStream() calls (never cached).
+    uint64_t streamedRows = 0;      ///< Rows those streams delivered.
+    uint64_t writeGroups = 0;       ///< Transactions that committed several writes.
+    uint64_t combinedWrites = 0;    ///< Writes committed in those transactions.
+
+    /// Checkout wait and utilization histograms, open/close counters.
+    cgs::foundation::ConnectionPoolStats primaryPool;
+    cgs::foundation::ConnectionPoolStats replicaPool;  ///< Summed over replicas.
+
+    /// Per-replica routing state, in DBProxyConfig::replicas order.
+    std::vector<ReplicaStats> replicas;
+
+    /// Cached bytes per table with a quota in CacheConfig::tableQuotaBytes.
+    std::unordered_map<std::string, std::size_t> cacheTableBytes;
 };
 
 }  // namespace cgs::service
@@ -4,12 +4,15 @@
 /// @brief ELO/MMR rating calculations for skill-based matchmaking.
 ///
 /// Provides the standard Elo expected-score formula, rating updates
-/// with configurable K-factor, and match quality assessment.
+/// with configurable K-factor, match quality assessment, and team
+/// balancing for NvM matches.
 ///
 /// @see SRS-SVC-004.2
 /// @see SDS-MOD-033
 
+#include <chrono>
 #include <cstdint>
+#include <span>
 #include <vector>
 
 namespace cgs::service {
@@ -35,6 +38,13 @@ public:
     /// @return Expected score in [0.0, 1.0].
     [[nodiscard]] static float expectedScore(int32_t ratingA, int32_t ratingB);
 
+    /// Expected scores of many pairs at once:
+    /// out[i] = expectedScore(ratingsA[i], ratingsB[i]) for every i below
+    /// the smallest of the three sizes.
+    static void expectedScores(std::span<const int32_t> ratingsA,
+                               std::span<const int32_t> ratingsB,
+                               std::span<float> out);
+
     /// Calculate the new rating after a game.
     ///
     /// @param currentRating  Player's rating before the game.
@@ -57,6 +67,30 @@ public:
     /// @return Quality score.
     [[nodiscard]] static float matchQuality(const std::vector<int32_t>& ratings);
 
+    /// Split players into @p teamCount teams with team average ratings as
+    /// close as possible.  Team sizes differ by at most one (earlier teams
+    /// take the extra players).
+    ///
+    /// Players are placed strongest first onto the weakest team with room,
+    /// then pairs are swapped between teams while a swap narrows the gap
+    /// between the strongest and weakest team and @p budget lasts.
+    ///
+    /// @return Team index (0 .. teamCount-1) of each rating, or empty if
+    ///         there are fewer ratings than teams or fewer than two teams.
+    [[nodiscard]] static std::vector<uint32_t> balanceTeams(
+        std::span<const int32_t> ratings,
+        uint32_t teamCount,
+        std::chrono::microseconds budget = std::chrono::microseconds{500});
+
+    /// Predicted balance of a team assignment, in [0.0, 1.0]: 1.0 when the
+    /// strongest and weakest team averages are equal, falling toward 0.0
+    /// as the strongest team's expected score against the weakest nears 1.
+    ///
+    /// @param teams  Team index per rating, as from balanceTeams().
+    [[nodiscard]] static float teamBalance(std::span<const int32_t> ratings,
+                                           std::span<const uint32_t> teams,
+                                           uint32_t teamCount);
+
     /// Check whether two ratings are within the given tolerance.
     [[nodiscard]] static bool isWithinTolerance(int32_t ratingA,
                                                 int32_t ratingB,
@@ -0,0 +1,238 @@
+#pragma once
+
+/// @file flight_recorder.hpp
+/// @brief Bounded ring of recent per-tick data, dumped to disk around
+///        badly overrunning ticks.
+///
+/// GameServer records one FlightTick per game-loop tick: loop timing,
+/// per-system durations and allocations, entity/player/instance counts
+/// and the network traffic reported through addNetworkTraffic().  Rare,
+/// heavy events (instance creation, migration, hot reload, snapshot) are
+/// added with note() from any thread.
+///
+/// When a tick uses more than overrunFactor times its budget, the
+/// recorder keeps recording ticksAfter more ticks and then writes the
+/// window around it (ticksBefore + ticksAfter) to dumpDirectory as a
+/// Chrome trace, on a background thread.  traceJson() renders the last
+/// N seconds the same way for HealthServer's /debug/ticks endpoint.
+///
+/// Example:
+/// @code
+///   FlightRecorderConfig config;
+///   config.dumpDirectory = "/var/log/cgs/flight";
+///   FlightRecorder recorder(config);
+///   // per tick, on the game thread:
+///   recorder.record(tick);
+///   // when an operator asks:
+///   std::string trace = recorder.traceJson(std::chrono::seconds(60));
+/// @endcode
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace cgs::service {
+
+/// FlightRecorder settings.
+struct FlightRecorderConfig {
+    /// Ticks kept (default: 60 s at 20 Hz).
+    std::size_t capacity = 1200;
+
+    /// System timings kept per tick; later systems are dropped.
+    std::size_t maxSystemsPerTick = 64;
+
+    /// Noted events kept.
+    std::size_t eventCapacity = 256;
+
+    /// A tick whose update time exceeds this many budgets triggers a
+    /// dump (0 = never).
+    float overrunFactor = 3.0f;
+
+    /// Ticks before and after the triggering tick in a dump.
+    std::size_t ticksBefore = 100;
+    std::size_t ticksAfter = 20;
+
+    /// Directory for dumps (empty = no automatic dumps).
+    std::filesystem::path dumpDirectory;
+
+    /// Shortest time between two dumps.
+    std::chrono::seconds dumpCooldown{60};
+};
+
+/// One system run within a recorded tick.
+struct FlightSystemTiming {
+    uint16_t system = 0;         ///< FlightRecorder::registerSystem() id.
+    uint16_t world = 0;          ///< World (shard) the system ran in.
+    uint32_t startOffsetUs = 0;  ///< From the start of the tick.
+    uint32_t durationUs = 0;
+    uint32_t allocations = 0;    ///< Heap allocations (with AllocTracker hooks).
+};
+
+/// One recorded tick.
+struct FlightTick {
+    uint64_t tickNumber = 0;
+    int64_t startUs = 0;  ///< steady_clock time of the tick start.
+    uint32_t updateUs = 0;
+    uint32_t frameUs = 0;
+    uint32_t jitterUs = 0;
+    float budgetUtilization = 0.0f;
+    bool overrun = false;
+
+    uint32_t entities = 0;
+    uint32_t players = 0;
+    uint32_t instances = 0;
+
+    /// Network traffic reported since the previous tick.
+    uint64_t messagesIn = 0;
+    uint64_t bytesIn = 0;
+    uint64_t messagesOut = 0;
+    uint64_t bytesOut = 0;
+
+    /// Heap allocations of the tick's systems.
+    uint64_t allocations = 0;
+
+    std::vector<FlightSystemTiming> systems;
+};
+
+/// Kind of a noted event.
+enum class FlightEventKind : uint8_t {
+    InstanceCreated,
+    InstanceDestroyed,
+    InstanceMigrated,
+    InstanceHibernated,
+    InstanceWoken,
+    HotReload,
+    Snapshot,
+    Custom,
+};
+
+/// A rare, heavy event noted between ticks.
+struct FlightEvent {
+    FlightEventKind kind = FlightEventKind::Custom;
+    uint64_t tickNumber = 0;  ///< Tick being recorded when it was noted.
+    int64_t timeUs = 0;       ///< steady_clock time.
+    std::string detail;
+};
+
+/// Name of @p kind ("instance_created", ...).
+[[nodiscard]] std::string_view flightEventKindName(FlightEventKind kind) noexcept;
+
+/// Counters of automatic dumps.
+struct FlightDumpStats {
+    uint64_t triggers = 0;  ///< Ticks over overrunFactor budgets.
+    uint64_t written = 0;
+    uint64_t failed = 0;
+    std::optional<std::filesystem::path> lastPath;
+};
+
+/// Tick flight recorder; see file comment.
+///
+/// Thread-safe: record() is meant for the game thread, note(),
+/// addNetworkTraffic() and the queries for any thread.  The ring is
+/// allocated up front; record() does not allocate while a tick's
+/// systems fit in maxSystemsPerTick.
+class FlightRecorder {
+public:
+    explicit FlightRecorder(FlightRecorderConfig config = {});
+    ~FlightRecorder();
+
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+    /// Id of system @p name, registering it on first use.
+    [[nodiscard]] uint16_t registerSystem(std::string_view name);
+
+    /// Name of system @p id ("?" if unknown).
+    [[nodiscard]] std::string systemName(uint16_t id) const;
+
+    /// Append @p tick, evicting the oldest; may trigger or finish a dump.
+    void record(const FlightTick& tick);
+
+    /// Add traffic to the next recorded tick.
+    void addNetworkTraffic(uint64_t messagesIn,
+                           uint64_t bytesIn,
+                           uint64_t messagesOut,
+                           uint64_t bytesOut) noexcept;
+
+    /// Note an event of @p kind against the tick being recorded.
+    void note(FlightEventKind kind, std::string_view detail = {});
+
+    /// The last @p count ticks, oldest first.
+    [[nodiscard]] std::vector<FlightTick> ticks(std::size_t count) const;
+
+    /// Noted events still in the ring, oldest first.
+    [[nodiscard]] std::vector<FlightEvent> events() const;
+
+    /// Chrome trace JSON of the ticks started within @p window of the
+    /// newest one, with the events noted meanwhile.
+    [[nodiscard]] std::string traceJson(std::chrono::seconds window) const;
+
+    /// Wait until queued dumps are written (for tests and shutdown).
+    void flushDumps();
+
+    [[nodiscard]] FlightDumpStats dumpStats() const;
+
+    [[nodiscard]] const FlightRecorderConfig& config() const noexcept { return config_; }
+
+private:
+    struct Dump {
+        uint64_t triggerTick = 0;
+        std::vector<FlightTick> ticks;
+        std::vector<FlightEvent> events;
+        std::vector<std::string> names;  // system names at capture time
+    };
+
+    /// Ticks in the ring starting at or after @p fromTick / @p fromUs.
+    /// Caller holds mutex_.
+    std::vector<FlightTick> collectTicksLocked(uint64_t fromTick, int64_t fromUs) const;
+    std::vector<FlightEvent> collectEventsLocked(int64_t fromUs) const;
+
+    static std::string render(const std::vector<FlightTick>& ticks,
+                              const std::vector<FlightEvent>& events,
+                              const std::vector<std::string>& names,
+                              std::optional<uint64_t> triggerTick);
+
+    void writerLoop();
+
+    FlightRecorderConfig config_;
+
+    mutable std::mutex mutex_;
+    std::vector<FlightTick> ring_;  // capacity slots, systems reserved
+    std::size_t next_ = 0;
+    std::size_t size_ = 0;
+    std::deque<FlightEvent> events_;
+    std::vector<std::string> systemNames_;
+    uint64_t currentTick_ = 0;
+
+    // Dump state (mutex_)
+    std::optional<uint64_t> pendingTrigger_;
+    std::chrono::steady_clock::time_point lastDump_{};
+    bool dumpedOnce_ = false;
+    FlightDumpStats dumpStats_;
+
+    std::atomic<uint64_t> messagesIn_{0};
+    std::atomic<uint64_t> bytesIn_{0};
+    std::atomic<uint64_t> messagesOut_{0};
+    std::atomic<uint64_t> bytesOut_{0};
+
+    // Writer thread, started with the first dump.
+    std::mutex writerMutex_;
+    std::condition_variable writerWake_;
+    std::condition_variable writerIdle_;
+    std::deque<Dump> dumps_;
+    bool writing_ = false;
+    bool writerStop_ = false;
+    std::thread writer_;
+};
+
+}  // namespace cgs::service
@@ -8,9 +8,18 @@
 /// measures frame time, reports budget utilization, and detects
 /// overruns (ticks that exceed the target frame time).
 ///
+/// By default the loop waits for each tick with sleep_until(), whose
+/// wake-up can be late by the OS timer slack (often 1-4 ms on VMs).
+/// TickTimingMode::Precise sleeps until a calibrated slack before the
+/// deadline and yields for the rest, trading some CPU for sub-100 us
+/// jitter.
+///
 /// @see SRS-SVC-003.1, SRS-NFR-002
 /// @see SDS-MOD-032
 
+#include "cgs/foundation/cpu_affinity.hpp"
+#include "cgs/foundation/game_result.hpp"
+
 #include <atomic>
 #include <chrono>
 #include <cstdint>
@@ -20,12 +29,36 @@
 
 namespace cgs::service {
 
+/// How the loop waits for the next tick.
+enum class TickTimingMode : uint8_t {
+    Sleep,    ///< sleep_until() the deadline.
+    Precise,  ///< Sleep until timerSlack() early, then yield until the deadline.
+};
+
+/// What the loop does after falling behind by one or more ticks.
+enum class OverrunPolicy : uint8_t {
+    Skip,     ///< Drop the missed ticks and restart the schedule from now.
+    CatchUp,  ///< Run missed ticks back to back, up to maxCatchUpTicks in a row.
+};
+
+/// Tick timing settings (GameLoop::setTiming).
+struct TickTiming {
+    TickTimingMode mode = TickTimingMode::Sleep;
+    OverrunPolicy overrun = OverrunPolicy::Skip;
+
+    /// CatchUp only: consecutive late ticks run before the rest are
+    /// dropped, so a long stall cannot snowball.
+    uint32_t maxCatchUpTicks = 3;
+};
+
 /// Per-tick performance metrics.
 struct TickMetrics {
     /// Actual time spent in the tick callback.
     std::chrono::microseconds updateTime{0};
 
-    /// Total frame time including sleep.
+    /// Total frame time including sleep: start of the previous tick to
+    /// the start of this one on the loop thread (updateTime for manual
+    /// ticks and the first threaded tick).
     std::chrono::microseconds frameTime{0};
 
     /// Ratio of updateTime to target frame time (1.0 = full budget).
@@ -36,6 +69,13 @@ struct TickMetrics {
 
     /// True when updateTime exceeded the target frame time.
     bool overrun = false;
+
+    /// How late the tick started after waiting for its deadline; zero
+    /// for manual ticks and ticks run immediately after an overrun.
+    std::chrono::microseconds jitter{0};
+
+    /// Ticks dropped by OverrunPolicy just before this one.
+    uint32_t droppedTicks = 0;
 };
 
 /// Fixed-rate game loop with dedicated thread.
@@ -74,6 +114,32 @@ public:
     /// Set an optional callback invoked after each tick with metrics.
     void setMetricsCallback(MetricsCallback callback);
 
+    /// Pin the loop thread to @p cpus from the next start() (empty = no
+    /// pinning).  A single CPU kept free of other pinned threads gives the
+    /// isolated game-thread mode; see ThreadPlacement::isolatedGameThread().
+    ///
+    /// @return InvalidArgument while the loop is running.
+    [[nodiscard]] cgs::foundation::GameResult<void> setAffinity(cgs::foundation::CpuSet cpus);
+
+    /// The CPUs set by setAffinity().
+    [[nodiscard]] const cgs::foundation::CpuSet& affinity() const noexcept;
+
+    /// Set the wait mode and overrun policy from the next start().
+    ///
+    /// @return InvalidArgument while the loop is running.
+    [[nodiscard]] cgs::foundation::GameResult<void> setTiming(TickTiming timing);
+
+    /// The settings set by setTiming().
+    [[nodiscard]] const TickTiming& timing() const noexcept;
+
+    /// How early Precise mode stops sleeping: the worst sleep overshoot
+    /// measured when the loop thread started, plus a margin.  Zero before
+    /// the first Precise start().
+    [[nodiscard]] std::chrono::microseconds timerSlack() const noexcept;
+
+    /// Whether the running loop thread was pinned to affinity().
+    [[nodiscard]] bool isPinned() const noexcept;
+
     /// Start the game loop on a dedicated thread.
     ///
     /// @return true on success, false if already running.
@@ -110,12 +176,24 @@ private:
     /// Execute one tick and return its metrics.
     TickMetrics executeTick();
 
+    /// Measure sleep overshoot on the calling thread.
+    std::chrono::microseconds calibrateTimerSlack() const;
+
+    /// Wait for @p deadline according to timing_.mode.
+    void waitUntil(std::chrono::steady_clock::time_point deadline) const;
+
     uint32_t tickRate_;
     std::chrono::microseconds targetFrameTime_;
 
     TickCallback tickCallback_;
     MetricsCallback metricsCallback_;
 
+    cgs::foundation::CpuSet affinity_;
+    std::atomic<bool> pinned_{false};
+
+    TickTiming timing_;
+    std::atomic<int64_t> timerSlackMicros_{0};
+
     std::atomic<bool> running_{false};
     std::atomic<uint64_t> tickCount_{0};
     std::thread thread_;
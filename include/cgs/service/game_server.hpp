@@ -13,18 +13,41 @@
 /// @see SDS-MOD-032
 
 #include "cgs/ecs/entity.hpp"
+#include "cgs/foundation/cpu_affinity.hpp"
+#include "cgs/foundation/error_code.hpp"
 #include "cgs/foundation/game_result.hpp"
+#include "cgs/foundation/resume_queue.hpp"
+#include "cgs/foundation/signal.hpp"
 #include "cgs/foundation/types.hpp"
-
+#include "cgs/game/ai_components.hpp"
+#include "cgs/game/combat_system.hpp"
+#include "cgs/game/components.hpp"
+#include "cgs/game/world_components.hpp"
+#include "cgs/service/flight_recorder.hpp"
+#include "cgs/service/game_loop.hpp"
+#include "cgs/service/instance_migration.hpp"
+
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace cgs::service {
 
 // -- Configuration -----------------------------------------------------------
 
+/// Damage dealt to the target when a cast of a spell completes.
+struct SpellDamage {
+    cgs::game::DamageType type = cgs::game::DamageType::Physical;
+    int32_t baseDamage = 0;
+};
+
 /// Configuration for the Game Server.
 struct GameServerConfig {
     /// Tick rate in ticks per second (default: 20 Hz).
@@ -36,8 +59,110 @@ struct GameServerConfig {
     /// World spatial cell size for spatial indexing.
     float spatialCellSize = 32.0f;
 
+    /// Transform components WorldSystem moves per tick to keep them in
+    /// spatial (Morton) order (0 = off).
+    uint32_t spatialReorderPerTick = 0;
+
     /// Default AI tick interval in seconds.
     float aiTickInterval = 0.1f;
+
+    /// CPUs the game loop thread is pinned to (empty = unpinned).
+    cgs::foundation::CpuSet gameThreadCpus;
+
+    /// Tick wait mode and overrun policy (Precise suits 60 Hz arenas).
+    TickTiming tickTiming;
+
+    /// Independent ECS worlds, each with its own storages and system
+    /// scheduler.  New instances go to the world with the fewest, and
+    /// worlds tick in parallel on a worker pool, so one busy instance
+    /// does not delay the others (1 = a single shared world).
+    uint32_t worldShards = 1;
+
+    /// Queued joins (joinPlayer) materialized at the start of each tick;
+    /// the rest wait for later ticks (0 = no limit).
+    uint32_t joinsPerTick = 64;
+
+    /// Queued leaves (leavePlayer) processed per tick (0 = no limit).
+    uint32_t leavesPerTick = 256;
+
+    /// Hibernate Active instances left without players for this long, so
+    /// idle maps stop costing ticks (0 = never; see hibernateInstance()).
+    std::chrono::milliseconds hibernateAfter{0};
+
+    /// Per-tick flight recorder; set dumpDirectory to write the ticks
+    /// around a badly overrunning one to disk.
+    FlightRecorderConfig flightRecorder;
+
+    /// Spell ID → damage of a completed cast (see useAbility()).  Casts
+    /// of spells not listed complete without effect.
+    std::unordered_map<uint32_t, SpellDamage> spellDamage;
+};
+
+// -- Instance templates ------------------------------------------------------
+
+/// One NPC cloned into every instance built from an InstanceTemplate.
+struct InstanceNpc {
+    cgs::game::Transform transform;
+    cgs::game::Identity identity;  ///< Each clone gets a fresh guid.
+    cgs::game::Stats stats;
+    cgs::game::Movement movement;
+    std::optional<cgs::game::AIBrain> brain;
+};
+
+/// Contents of a map, cloned into each of its pooled instances.
+struct InstanceTemplate {
+    cgs::game::MapType type = cgs::game::MapType::Dungeon;
+    uint32_t maxPlayers = 40;
+
+    /// Zones of the map; mapEntity is set per clone.
+    std::vector<cgs::game::Zone> zones;
+    std::vector<InstanceNpc> npcs;
+
+    /// Pre-built instances kept ready for acquireInstance().
+    uint32_t warmCount = 2;
+};
+
+// -- Join pipeline -----------------------------------------------------------
+
+/// A player's character, as loaded for joinPlayer().
+struct CharacterData {
+    std::string name;
+    cgs::game::Transform transform;
+    cgs::game::Stats stats = defaultStats();
+    float speed = 7.0f;
+
+    /// Stats of a new character (also used by addPlayer).
+    static cgs::game::Stats defaultStats() {
+        cgs::game::Stats s;
+        s.health = 100;
+        s.maxHealth = 100;
+        s.mana = 100;
+        s.maxMana = 100;
+        return s;
+    }
+};
+
+/// Loads a player's character, e.g. through DBProxyServer::queryAsync(),
+/// and passes it to the callback from any thread.
+using CharacterLoader =
+    std::function<void(cgs::foundation::PlayerId,
+                       std::function<void(cgs::foundation::GameResult<CharacterData>)>)>;
+
+/// Where a queued join is.
+enum class JoinStage : uint8_t {
+    Loading,  ///< Waiting for the CharacterLoader.
+    Queued    ///< Loaded, waiting for a tick with join budget left.
+};
+
+/// Progress of a queued join.
+struct JoinStatus {
+    JoinStage stage = JoinStage::Loading;
+
+    /// Loaded joins ahead of this one (Queued only).
+    std::size_t position = 0;
+
+    /// Ticks until it is materialized at the current budget (Queued only).
+    uint64_t ticksRemaining = 0;
 };
 
 // -- Player session ----------------------------------------------------------
@@ -47,6 +172,10 @@ struct PlayerSession {
     cgs::foundation::PlayerId playerId;
     cgs::ecs::Entity entity;
     uint32_t instanceId = 0;
+
+    /// The player is moving to another world (transferPlayer); `entity`
+    /// refers to the old world until it arrives.
+    bool inTransit = false;
 };
 
 // -- Statistics ---------------------------------------------------------------
@@ -63,10 +192,21 @@ struct GameServerStats {
     std::size_t playerCount = 0;
     uint32_t activeInstances = 0;
     uint32_t drainingInstances = 0;
+    uint32_t pooledInstances = 0;
+    uint32_t migratingInstances = 0;
+    uint32_t hibernatingInstances = 0;
+    uint32_t worldCount = 1;
 
     /// System-level counters.
     uint64_t playersJoined = 0;
     uint64_t playersLeft = 0;
+    uint64_t crossWorldTransfers = 0;
+    uint64_t spellHits = 0;  ///< Completed casts sent as damage events.
+
+    /// Join pipeline depth.
+    std::size_t joinsLoading = 0;
+    std::size_t joinsQueued = 0;
+    std::size_t leavesQueued = 0;
 };
 
 // -- Game Server -------------------------------------------------------------
@@ -128,15 +268,129 @@ public:
     /// Destroy a map instance (must have zero players).
     [[nodiscard]] cgs::foundation::GameResult<void> destroyInstance(uint32_t instanceId);
 
-    /// Get instance IDs that can accept new players for a given map.
+    /// Get instance IDs that can accept new players for a given map,
+    /// fullest first.
     [[nodiscard]] std::vector<uint32_t> availableInstances(uint32_t mapId) const;
 
+    /// The fullest instance of @p mapId with room for another player.  If
+    /// no running instance has room, a hibernating one (the join wakes it)
+    /// is preferred over opening another.
+    [[nodiscard]] std::optional<uint32_t> bestAvailableInstance(uint32_t mapId) const;
+
+    // -- Hibernation ----------------------------------------------------------
+
+    /// Suspend an empty Active instance: its zones and NPCs are paged out
+    /// in the migration snapshot format (AIBrains alongside) and removed
+    /// from its world, so the systems no longer iterate them.  Combat
+    /// state (casts, auras, threat) is dropped.  Only the map entity
+    /// stays.
+    ///
+    /// The instance wakes when a player is added, joins or transfers in,
+    /// or through wakeInstance().  Done automatically once an instance has
+    /// been empty for GameServerConfig::hibernateAfter.
+    /// @return MapInstanceInvalidState unless the instance is Active and
+    ///         empty.
+    [[nodiscard]] cgs::foundation::GameResult<void> hibernateInstance(uint32_t instanceId);
+
+    /// Restore a hibernating instance and make it Active again.
+    ///
+    /// The restore fast-forwards over the time asleep in one step rather
+    /// than replaying ticks: nothing could have fought an NPC in an empty
+    /// instance, so each living one is back at its AI home position, at
+    /// full health and mana, idle, with its AI tick timer restarted.
+    /// @return MapInstanceInvalidState if the instance is not hibernating.
+    [[nodiscard]] cgs::foundation::GameResult<void> wakeInstance(uint32_t instanceId);
+
+    // -- Instance pools -------------------------------------------------------
+
+    /// Keep `warmCount` instances of @p mapId pre-built from @p tmpl.
+    ///
+    /// Pooled instances are built in the background on the worlds' ticks,
+    /// one per map per tick, and count towards maxInstances.
+    [[nodiscard]] cgs::foundation::GameResult<void> registerInstanceTemplate(
+        uint32_t mapId, InstanceTemplate tmpl);
+
+    /// Take an empty, Active instance of @p mapId from its pool.  If none
+    /// is ready, one is cloned from the template on the spot.  Either way
+    /// the pool is refilled in the background.
+    [[nodiscard]] cgs::foundation::GameResult<uint32_t> acquireInstance(uint32_t mapId);
+
+    /// Return an empty instance taken with acquireInstance().
+    ///
+    /// Its NPCs are reset to the template on the owning world's next tick
+    /// (killed ones respawn), after which it is ready again.  Instances
+    /// beyond the pool's warmCount are destroyed instead.
+    [[nodiscard]] cgs::foundation::GameResult<void> releaseInstance(uint32_t instanceId);
+
+    /// Instances of @p mapId ready to be acquired.
+    [[nodiscard]] std::size_t pooledInstances(uint32_t mapId) const;
+
+    // -- Live migration -------------------------------------------------------
+
+    /// Players in @p instanceId (e.g. to find their gateway sessions).
+    [[nodiscard]] std::vector<cgs::foundation::PlayerId> instancePlayers(
+        uint32_t instanceId) const;
+
+    /// Start moving @p instanceId to another server.
+    ///
+    /// The instance goes Migrating (no new players) but keeps running.
+    /// Returns the snapshot chunk for the target's importInstance(); send
+    /// exportInstanceDelta() chunks while the target catches up, then hand
+    /// off with finishInstanceExport():
+    /// @code
+    ///   auto snapshot = source.beginInstanceExport(id);
+    ///   auto newId = target.importInstance(snapshot.value());
+    ///   target.applyInstanceChunk(newId.value(), source.exportInstanceDelta(id).value());
+    ///
+    ///   // Freeze: the gateway holds the players' traffic from here ...
+    ///   for (auto player : source.instancePlayers(id)) {
+    ///       gateway.beginMigration(sessionOf(player), "game-2");
+    ///   }
+    ///   target.applyInstanceChunk(newId.value(), source.finishInstanceExport(id).value());
+    ///   for (auto player : target.instancePlayers(newId.value())) {
+    ///       gateway.completeMigration(sessionOf(player));  // ... to here.
+    ///   }
+    /// @endcode
+    [[nodiscard]] cgs::foundation::GameResult<std::vector<uint8_t>> beginInstanceExport(
+        uint32_t instanceId);
+
+    /// Entities of a migrating instance created, changed or destroyed since
+    /// its previous chunk.
+    [[nodiscard]] cgs::foundation::GameResult<std::vector<uint8_t>> exportInstanceDelta(
+        uint32_t instanceId);
+
+    /// Hand a migrating instance off: returns its final delta, then drops
+    /// its players' sessions and destroys the instance here.
+    ///
+    /// @return PlayerInTransit while a player is still moving between
+    ///         worlds (retry on a later tick).
+    [[nodiscard]] cgs::foundation::GameResult<std::vector<uint8_t>> finishInstanceExport(
+        uint32_t instanceId);
+
+    /// Abandon a migration; the instance goes back to Active.
+    [[nodiscard]] cgs::foundation::GameResult<void> cancelInstanceExport(uint32_t instanceId);
+
+    /// Create a Migrating instance from a snapshot chunk.  An NPC's AIBrain
+    /// is rebuilt from this server's template for the map (matched by
+    /// Identity::entry).
+    /// @return The new instance ID.
+    [[nodiscard]] cgs::foundation::GameResult<uint32_t> importInstance(
+        std::span<const uint8_t> snapshot);
+
+    /// Apply the next chunk of an imported instance.  The final chunk
+    /// creates its players' sessions and makes the instance Active.
+    ///
+    /// @return MapInstanceInvalidState for a chunk out of sequence.
+    [[nodiscard]] cgs::foundation::GameResult<void> applyInstanceChunk(
+        uint32_t instanceId, std::span<const uint8_t> chunk);
+
     // -- Player lifecycle -----------------------------------------------------
 
     /// Add a player to a map instance.
     ///
     /// Creates an ECS entity with default components (Transform, Identity,
-    /// Stats, Movement, MapMembership, QuestLog, Inventory, Equipment).
+    /// Stats, Movement, MapMembership, QuestLog, Inventory, Equipment,
+    /// SpellCast, AbilityCooldowns).
     [[nodiscard]] cgs::foundation::GameResult<cgs::ecs::Entity> addPlayer(
         cgs::foundation::PlayerId playerId, uint32_t instanceId);
 
@@ -150,18 +404,89 @@ public:
     [[nodiscard]] std::optional<PlayerSession> getPlayerSession(
         cgs::foundation::PlayerId playerId) const;
 
+    /// Queue a player to join a map instance.
+    ///
+    /// The character loads through the CharacterLoader (a default
+    /// character without one); loaded players are then created in batches
+    /// at the start of a tick, at most joinsPerTick per tick.  joinStatus()
+    /// reports progress and joinFinished() fires when the join completes
+    /// or fails.
+    [[nodiscard]] cgs::foundation::GameResult<void> joinPlayer(cgs::foundation::PlayerId playerId,
+                                                               uint32_t instanceId);
+
+    /// Queue a player's removal, processed at the start of a tick at most
+    /// leavesPerTick per tick.  A join still in progress is cancelled.
+    [[nodiscard]] cgs::foundation::GameResult<void> leavePlayer(
+        cgs::foundation::PlayerId playerId);
+
+    /// Progress of a queued join, or nullopt if none is in progress.
+    [[nodiscard]] std::optional<JoinStatus> joinStatus(cgs::foundation::PlayerId playerId) const;
+
+    /// Set the loader used by joinPlayer().
+    void setCharacterLoader(CharacterLoader loader);
+
+    /// Emitted on the game thread when a queued join ends: Success once
+    /// the player is in the world, otherwise the error that stopped it.
+    [[nodiscard]] cgs::foundation::Signal<cgs::foundation::PlayerId, cgs::foundation::ErrorCode>&
+    joinFinished() noexcept;
+
+    /// Entities within @p radius of @p center on @p instanceId's map, as
+    /// indexed at the last tick (the area-of-interest query).  Empty for
+    /// an unknown instance or before the first tick.  Call only while
+    /// the game loop is stopped, e.g. between manual tick()s.
+    [[nodiscard]] std::vector<cgs::ecs::Entity> entitiesNear(uint32_t instanceId,
+                                                             const cgs::game::Vector3& center,
+                                                             float radius) const;
+
     /// Transfer a player to a different map instance.
+    ///
+    /// Within one world the move is immediate.  Between worlds the source
+    /// world hands the player's components to the target world through
+    /// their message queues over the next tick or two; until then the
+    /// session is inTransit and further transfers fail with
+    /// PlayerInTransit.
     [[nodiscard]] cgs::foundation::GameResult<void> transferPlayer(
         cgs::foundation::PlayerId playerId, uint32_t targetInstanceId);
 
+    /// Start an ability of the player's character (CombatSystem::UseAbility()).
+    ///
+    /// When the cast completes, a spell listed in spellDamage deals its
+    /// damage to the target on the following tick.  Fails with
+    /// GameLoopNotRunning before the systems are built (start() or the
+    /// first tick()).
+    [[nodiscard]] cgs::foundation::GameResult<cgs::game::AbilityUseResult> useAbility(
+        cgs::foundation::PlayerId playerId, const cgs::game::AbilityUse& use);
+
     // -- Statistics -----------------------------------------------------------
 
     /// Get a snapshot of current game server statistics.
     [[nodiscard]] GameServerStats stats() const;
 
+    /// Chrome trace JSON of the last @p lastTicks ticks (per tick, stage
+    /// and system timings) of the first world; open in chrome://tracing
+    /// or ui.perfetto.dev.
+    ///
+    /// Per-system durations of every world are also published every tick
+    /// as the `cgs_system_<name>_ms` histograms, and an overrunning tick
+    /// bumps `cgs_system_<name>_overruns_total` for its slowest system.
+    [[nodiscard]] std::string systemTrace(std::size_t lastTicks) const;
+
+    /// Recorder of the last ticks across all worlds (timings, counts,
+    /// allocations, instance events).  Network layers report traffic
+    /// with addNetworkTraffic(); traceJson() serves /debug/ticks.
+    [[nodiscard]] FlightRecorder& flightRecorder() noexcept;
+
     /// Get the configuration.
     [[nodiscard]] const GameServerConfig& config() const noexcept;
 
+    // -- Coroutines -----------------------------------------------------------
+
+    /// Queue drained on the game thread at the start of every tick, before
+    /// the systems run: `co_await server.resumeQueue().nextTick()` brings a
+    /// task (e.g. a character load awaiting the database) back to the game
+    /// thread, and `sleepFor()` gives it tick-resolution timers.
+    [[nodiscard]] cgs::foundation::ResumeQueue& resumeQueue() noexcept;
+
 private:
     struct Impl;
     std::unique_ptr<Impl> impl_;
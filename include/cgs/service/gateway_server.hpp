@@ -13,10 +13,15 @@
 
 #include "cgs/foundation/game_result.hpp"
 #include "cgs/foundation/types.hpp"
+#include "cgs/service/gateway_session_manager.hpp"
 #include "cgs/service/gateway_types.hpp"
+#include "cgs/service/route_table.hpp"
+#include "cgs/service/service_link.hpp"
+#include "cgs/service/service_placement.hpp"
 
 #include <cstdint>
 #include <memory>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -41,8 +46,12 @@ enum class GatewayActionType : uint8_t {
 struct GatewayAction {
     GatewayActionType type = GatewayActionType::Drop;
 
-    /// Target downstream service (for Forward).
-    std::string targetService;
+    /// Target downstream service (for Forward).  Views the gateway's
+    /// interned route name, valid for the lifetime of the gateway.
+    std::string_view targetService;
+
+    /// Interned id of targetService (for Forward).
+    RouteServiceId targetServiceId = 0;
 
     /// Reply opcode (for Reply).
     uint16_t replyOpcode = 0;
@@ -89,6 +98,15 @@ struct GatewayStats {
 ///   auto action = gateway.handleMessage(sessionId, opcode, payload);
 ///   // action tells the network layer what to do (forward, reply, drop).
 ///
+///   // Or resolve the session once per connection and skip the lookups:
+///   auto session = gateway.sessionHandle(sessionId);
+///   auto action = gateway.handleMessage(session, opcode, payload);
+///
+///   // With backend links, forward without copying the payload:
+///   auto& game = gateway.addServiceLink("game", writeToGameSocket);  // before start()
+///   auto action = gateway.routeMessage(session, opcode, receiveBufferView);
+///   gateway.flushServiceLinks();  // before the receive buffer is reused
+///
 ///   // On server transfer:
 ///   gateway.initiateServerTransfer(sessionId, "game-server-2");
 /// @endcode
@@ -122,6 +140,19 @@ public:
                   std::string service,
                   bool requiresAuth = true);
 
+    /// Attach a multiplexed connection to a downstream service.  A service
+    /// with several links places each session on one by weighted
+    /// rendezvous hash, so adding a link moves only its share of sessions.
+    /// Call before start(); the link lives as long as the gateway.
+    ServiceLink& addServiceLink(std::string_view service,
+                                ServiceLink::Writer writer,
+                                double weight = 1.0);
+
+    /// Placement of sessions over a service's links, for reweighting or
+    /// draining them at runtime (node ids follow addServiceLink() order).
+    /// nullptr if the service has no links.
+    [[nodiscard]] ServicePlacement* serviceLinkPlacement(std::string_view service);
+
     // -- Connection handling --------------------------------------------------
 
     /// Handle a new client connection.
@@ -135,11 +166,31 @@ public:
     [[nodiscard]] cgs::foundation::GameResult<GatewayAction> handleMessage(
         cgs::foundation::SessionId sessionId, uint16_t opcode, std::vector<uint8_t> payload);
 
+    /// Process an incoming message for a session resolved by sessionHandle().
+    /// Apart from gateway-level opcodes, this takes no lock.
+    [[nodiscard]] cgs::foundation::GameResult<GatewayAction> handleMessage(
+        const GatewaySessionHandle& session, uint16_t opcode, std::vector<uint8_t> payload);
+
+    /// Make the same decision as handleMessage() on a view of the receive
+    /// buffer, and queue Forward messages onto the target service's link
+    /// (if it has one) by reference.  The payload must stay valid until
+    /// flushServiceLinks().
+    [[nodiscard]] cgs::foundation::GameResult<GatewayAction> routeMessage(
+        const GatewaySessionHandle& session, uint16_t opcode, std::span<const uint8_t> payload);
+
+    /// Write every frame queued by routeMessage() to its link.
+    /// Returns the number of frames written.
+    std::size_t flushServiceLinks();
+
+    /// Resolve a connected session once, for the per-message overload of
+    /// handleMessage() (empty if not connected).
+    [[nodiscard]] GatewaySessionHandle sessionHandle(cgs::foundation::SessionId sessionId) const;
+
     // -- Migration ------------------------------------------------------------
 
     /// Initiate a server transfer for an authenticated client.
     [[nodiscard]] cgs::foundation::GameResult<void> initiateServerTransfer(
-        cgs::foundation::SessionId sessionId, std::string targetService);
+        cgs::foundation::SessionId sessionId, cgs::foundation::InternedString targetService);
 
     // -- Maintenance ----------------------------------------------------------
 
@@ -6,15 +6,27 @@
 /// Tracks connected clients through their lifecycle:
 /// Unauthenticated → Authenticated → (optionally Migrating) → Disconnecting.
 ///
+/// The per-message path goes through a GatewaySessionHandle, fetched once
+/// per connection: it reads the session state and records activity with
+/// atomics, without the manager's lock.  Sessions are spread over sharded
+/// maps, and idle / auth expiry sweeps walk coarse time buckets instead
+/// of every session.
+///
 /// @see SRS-SVC-002.1
 /// @see SRS-SVC-002.4
 
 #include "cgs/foundation/game_result.hpp"
+#include "cgs/foundation/profiled_mutex.hpp"
 #include "cgs/foundation/types.hpp"
 #include "cgs/service/gateway_types.hpp"
+#include "cgs/service/token_bucket.hpp"
 
+#include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <array>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
@@ -24,11 +36,85 @@
 
 namespace cgs::service {
 
+class GatewaySessionManager;
+
+/// Direct access to one live gateway session.
+///
+/// Obtained once per connection from GatewaySessionManager::handle(); every
+/// accessor is lock-free.  The handle stays valid after the session is
+/// removed (open() turns false), so a connection holding it never dangles.
+class GatewaySessionHandle {
+public:
+    GatewaySessionHandle() = default;
+
+    /// Whether the handle refers to a session.
+    explicit operator bool() const noexcept { return record_ != nullptr; }
+
+    /// Whether the session is still registered with its manager.
+    [[nodiscard]] bool open() const noexcept {
+        return record_ != nullptr && !record_->removed.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] cgs::foundation::SessionId sessionId() const noexcept {
+        return record_->session.sessionId;
+    }
+
+    /// Client address, fixed when the session was created.
+    [[nodiscard]] const std::string& remoteAddress() const noexcept {
+        return record_->session.remoteAddress;
+    }
+
+    [[nodiscard]] ClientState state() const noexcept {
+        return record_->state.load(std::memory_order_acquire);
+    }
+
+    /// Record activity now.
+    void touch() const noexcept {
+        record_->lastActivity.store(std::chrono::steady_clock::now().time_since_epoch().count(),
+                                    std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] std::chrono::steady_clock::time_point lastActivity() const noexcept {
+        return std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(
+            record_->lastActivity.load(std::memory_order_relaxed)));
+    }
+
+    /// Consume from the session's rate-limit bucket (always allowed when
+    /// the session was created without one).
+    [[nodiscard]] bool consume(uint32_t tokens = 1) const noexcept {
+        return !record_->rateLimit || record_->rateLimit->consume(tokens);
+    }
+
+private:
+    friend class GatewaySessionManager;
+
+    struct Record {
+        // Written under the shard's lock; sessionId, remoteAddress and
+        // connectedAt never change.  state and lastActivity live in the atomics below.
+        ClientSession session;
+        std::atomic<ClientState> state{ClientState::Unauthenticated};
+        std::atomic<std::chrono::steady_clock::rep> lastActivity{0};
+        std::atomic<bool> removed{false};
+        std::shared_ptr<AtomicTokenBucket> rateLimit;
+    };
+
+    explicit GatewaySessionHandle(std::shared_ptr<Record> record) : record_(std::move(record)) {}
+
+    std::shared_ptr<Record> record_;
+};
+
 /// Thread-safe manager for gateway client sessions.
 ///
 /// Provides creation, authentication, migration, and removal of client
 /// sessions. Used by GatewayServer to track all connected clients.
 ///
+/// Sessions live in kShards maps, each behind its own mutex, and the
+/// per-state counts are kept as counters.  Every session is filed in a
+/// one-second time bucket when created; a sweep only opens the buckets
+/// older than its cutoff and moves sessions touched since then to their
+/// current bucket, so it costs O(expired + touched since the last sweep)
+/// rather than O(sessions), and touch() itself never reorders anything.
+///
 /// Example:
 /// @code
 ///   GatewaySessionManager mgr(10000);
@@ -36,16 +122,26 @@ namespace cgs::service {
 ///   mgr.createSession(sid, "192.168.1.1");
 ///   mgr.authenticateSession(sid, claims, userId);
 ///   auto session = mgr.getSession(sid);
+///
+///   // Per-message path of a connection:
+///   auto handle = mgr.handle(sid);
+///   if (handle.open() && handle.consume()) handle.touch();
 /// @endcode
 class GatewaySessionManager {
 public:
     /// Construct with maximum session capacity.
     explicit GatewaySessionManager(uint32_t maxSessions);
+    ~GatewaySessionManager();
+
+    GatewaySessionManager(const GatewaySessionManager&) = delete;
+    GatewaySessionManager& operator=(const GatewaySessionManager&) = delete;
 
-    /// Create a new unauthenticated session.
+    /// Create a new unauthenticated session, optionally rate limited by
+    /// @p rateLimit (which may be shared with other sessions).
     /// Returns false if the max capacity is reached.
     [[nodiscard]] bool createSession(cgs::foundation::SessionId sessionId,
-                                     std::string remoteAddress);
+                                     std::string remoteAddress,
+                                     std::shared_ptr<AtomicTokenBucket> rateLimit = nullptr);
 
     /// Promote a session to authenticated state.
     [[nodiscard]] bool authenticateSession(cgs::foundation::SessionId sessionId,
@@ -54,7 +150,7 @@ public:
 
     /// Transition a session to migrating state.
     [[nodiscard]] bool beginMigration(cgs::foundation::SessionId sessionId,
-                                      std::string targetService);
+                                      cgs::foundation::InternedString targetService);
 
     /// Complete migration: update the session's current service.
     [[nodiscard]] bool completeMigration(cgs::foundation::SessionId sessionId);
@@ -66,11 +162,15 @@ public:
     [[nodiscard]] std::optional<ClientSession> getSession(
         cgs::foundation::SessionId sessionId) const;
 
+    /// Handle to a live session (empty if not found).
+    [[nodiscard]] GatewaySessionHandle handle(cgs::foundation::SessionId sessionId) const;
+
     /// Update the last activity timestamp for a session.
     void touchSession(cgs::foundation::SessionId sessionId);
 
     /// Update the current service for a session.
-    [[nodiscard]] bool setCurrentService(cgs::foundation::SessionId sessionId, std::string service);
+    [[nodiscard]] bool setCurrentService(cgs::foundation::SessionId sessionId,
+                                         cgs::foundation::InternedString service);
 
     /// Get sessions in a specific state.
     [[nodiscard]] std::vector<ClientSession> getSessionsByState(ClientState state) const;
@@ -81,7 +181,8 @@ public:
     /// Get session count by state.
     [[nodiscard]] std::size_t sessionCount(ClientState state) const;
 
-    /// Find sessions that have been idle longer than the given duration.
+    /// Find authenticated sessions idle longer than the given duration.
+    /// Sessions are reported by every sweep until removed or touched.
     [[nodiscard]] std::vector<cgs::foundation::SessionId> findIdleSessions(
         std::chrono::seconds idleTimeout) const;
 
@@ -89,10 +190,34 @@ public:
     [[nodiscard]] std::vector<cgs::foundation::SessionId> findExpiredAuthSessions(
         std::chrono::seconds authTimeout) const;
 
+    /// Number of session map shards.
+    static constexpr std::size_t kShards = 16;
+
 private:
+    using Record = GatewaySessionHandle::Record;
+    class ExpiryWheel;
+
+    struct Shard {
+        mutable cgs::foundation::ProfiledMutex mutex{"gateway.sessions"};
+        std::unordered_map<cgs::foundation::SessionId, std::shared_ptr<Record>> sessions;
+    };
+
+    // Copy of a record with its atomics folded in.  Caller holds its shard's lock.
+    static ClientSession snapshot(const Record& record);
+
+    Shard& shardFor(cgs::foundation::SessionId sessionId) const noexcept;
+
+    // Move a record between per-state counters.  Caller holds its shard's lock.
+    void setState(Record& record, ClientState state);
+
     uint32_t maxSessions_;
-    mutable std::mutex mutex_;
-    std::unordered_map<cgs::foundation::SessionId, ClientSession> sessions_;
+    mutable std::array<Shard, kShards> shards_;
+    std::atomic<std::size_t> total_{0};
+    std::array<std::atomic<std::size_t>, 4> stateCounts_{};  // by ClientState
+
+    // Keyed by last activity (idle expiry) and by connect time (auth expiry)
+    std::unique_ptr<ExpiryWheel> idleWheel_;
+    std::unique_ptr<ExpiryWheel> authWheel_;
 };
 
 }  // namespace cgs::service
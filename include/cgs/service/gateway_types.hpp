@@ -9,6 +9,7 @@
 /// @see SRS-SVC-002
 /// @see SDS-MOD-041
 
+#include "cgs/foundation/interned_string.hpp"
 #include "cgs/foundation/types.hpp"
 #include "cgs/service/auth_types.hpp"
 
@@ -68,7 +69,7 @@ struct ClientSession {
     std::string remoteAddress;
 
     /// Identifier of the downstream service currently handling this client.
-    std::string currentService;
+    cgs::foundation::InternedString currentService;
 
     /// When the connection was established.
     std::chrono::steady_clock::time_point connectedAt{};
@@ -88,7 +89,7 @@ struct RouteEntry {
     uint16_t opcodeMax = 0;
 
     /// Downstream service identifier (e.g., "game", "lobby", "chat").
-    std::string service;
+    cgs::foundation::InternedString service;
 
     /// Whether this route requires authentication.
     bool requiresAuth = true;
@@ -13,8 +13,10 @@
 #include <atomic>
 #include <chrono>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
+#include <string_view>
 
 namespace cgs::foundation {
 class GameMetrics;
@@ -31,12 +33,17 @@ struct HealthServerConfig {
     std::string serviceName = "cgs";
 };
 
+/// Handler of an extra HealthServer endpoint: receives the query string
+/// (after '?', empty if none) and returns the response body.
+using HealthEndpointHandler = std::function<std::string(std::string_view query)>;
+
 /// Minimal HTTP server providing health check and Prometheus metrics endpoints.
 ///
 /// Endpoints:
 ///   - GET /healthz → 200 OK (liveness probe)
 ///   - GET /readyz  → 200 OK if ready, 503 if not (readiness probe)
 ///   - GET /metrics → Prometheus text exposition format
+///   - GET paths added with addEndpoint() (e.g. /debug/ticks)
 ///
 /// Example:
 /// @code
@@ -62,6 +69,12 @@ public:
     /// Stop the server and close the listening socket.
     void stop();
 
+    /// Serve GET @p path with @p handler, as @p contentType.  Call before
+    /// start(); handlers run on the server thread.
+    void addEndpoint(std::string path,
+                     HealthEndpointHandler handler,
+                     std::string contentType = "application/json");
+
     /// Set the readiness state. When false, /readyz returns 503.
     void setReady(bool ready);
 
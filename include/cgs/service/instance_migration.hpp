@@ -0,0 +1,90 @@
+#pragma once
+
+/// @file instance_migration.hpp
+/// @brief Wire format for live migration of a map instance between game
+///        servers.
+///
+/// A migrating instance is streamed as a sequence of chunks: a snapshot
+/// of every entity, deltas of the entities created, changed or destroyed
+/// since the previous chunk, and a final delta taken as the source hands
+/// the instance off.  GameServer produces and applies the chunks (see
+/// GameServer::beginInstanceExport()); this header only defines them.
+///
+/// @see SRS-SVC-003.2
+/// @see SDS-MOD-032
+
+#include "cgs/foundation/game_result.hpp"
+#include "cgs/game/components.hpp"
+#include "cgs/game/world_types.hpp"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace cgs::service {
+
+/// What a migrated entity is on its map.
+enum class MigratedKind : uint8_t {
+    Zone,
+    Npc,
+    Player
+};
+
+/// One entity of a migrating instance, keyed by its source entity id.
+struct MigratedEntity {
+    uint32_t key = 0;
+    MigratedKind kind = MigratedKind::Npc;
+
+    // Zone entities.
+    uint32_t zoneId = 0;
+    cgs::game::ZoneType zoneType = cgs::game::ZoneType::Normal;
+    cgs::game::ZoneFlags zoneFlags = cgs::game::ZoneFlags::None;
+
+    // NPC and player entities.
+    uint64_t playerId = 0;  ///< Players only.
+    cgs::game::Identity identity;
+    cgs::game::Transform transform;
+    cgs::game::Stats stats;
+    cgs::game::Movement movement;
+    uint32_t memberZoneId = 0;  ///< Zone the entity is in (MapMembership).
+
+    /// The NPC had an AIBrain.  Behavior trees do not travel: the target
+    /// rebuilds the brain from its instance template (matched by
+    /// Identity::entry).
+    bool hasBrain = false;
+};
+
+/// One chunk of an instance migration stream.
+struct InstanceMigrationChunk {
+    /// Position in the stream; the snapshot is 0.
+    uint64_t sequence = 0;
+
+    /// Last chunk: the source has handed the instance off.
+    bool final = false;
+
+    uint32_t mapId = 0;
+    cgs::game::MapType type = cgs::game::MapType::OpenWorld;
+    uint32_t maxPlayers = 0;
+
+    /// Entities created or changed since the previous chunk (all of them
+    /// in the snapshot).
+    std::vector<MigratedEntity> upserts;
+
+    /// Keys of entities destroyed since the previous chunk.
+    std::vector<uint32_t> removed;
+};
+
+/// Encode @p chunk for transport.
+[[nodiscard]] std::vector<uint8_t> encodeMigrationChunk(const InstanceMigrationChunk& chunk);
+
+/// Append the encoding of @p entity alone to @p out (the unit deltas are
+/// computed over).
+void encodeMigratedEntity(const MigratedEntity& entity, std::vector<uint8_t>& out);
+
+/// Decode a chunk.
+///
+/// @return SerializationError if @p bytes is truncated or not a chunk.
+[[nodiscard]] cgs::foundation::GameResult<InstanceMigrationChunk> decodeMigrationChunk(
+    std::span<const uint8_t> bytes);
+
+}  // namespace cgs::service
@@ -13,6 +13,8 @@
 
 #include "cgs/foundation/game_result.hpp"
 #include "cgs/service/lobby_types.hpp"
+#include "cgs/service/matchmaking_engine.hpp"
+#include "cgs/service/service_placement.hpp"
 
 #include <cstdint>
 #include <memory>
@@ -38,8 +40,11 @@ namespace cgs::service {
 ///   lobby.addPartyMember(pid.value(), memberId, "Member", rating);
 ///   lobby.enqueueParty(pid.value());
 ///
+///   // Game servers that host matches
+///   lobby.gameServers().addNode("game-1");
+///
 ///   // Periodic match processing
-///   auto matches = lobby.processMatchmaking();
+///   auto matches = lobby.processMatchmaking();  // matches[i].gameServer set
 ///
 ///   lobby.stop();
 /// @endcode
@@ -104,9 +109,17 @@ public:
                                                                        uint64_t requesterId,
                                                                        uint64_t newLeaderId);
 
-    /// Get party info.
+    /// Mark a party member ready or not ready.
+    [[nodiscard]] cgs::foundation::GameResult<void> setPartyMemberReady(PartyId partyId,
+                                                                        uint64_t playerId,
+                                                                        bool ready);
+
+    /// Get party info (copies the member list).
     [[nodiscard]] std::optional<Party> getParty(PartyId partyId) const;
 
+    /// Get a party's cached aggregates without copying its members.
+    [[nodiscard]] std::optional<PartySummary> partySummary(PartyId partyId) const;
+
     /// Get the party a player belongs to.
     [[nodiscard]] std::optional<PartyId> getPlayerParty(uint64_t playerId) const;
 
@@ -115,7 +128,9 @@ public:
     /// Enqueue an entire party for matchmaking.
     ///
     /// All party members are enqueued using the party's average rating.
-    /// The party is marked as in-queue.
+    /// The party is marked as in-queue.  While it is queued, members who
+    /// join are queued at the updated average, members who leave are
+    /// dequeued, and disbanding dequeues everyone.
     [[nodiscard]] cgs::foundation::GameResult<void> enqueueParty(PartyId partyId);
 
     /// Remove a party from the matchmaking queue.
@@ -125,10 +140,25 @@ public:
 
     /// Run one matchmaking cycle.
     ///
-    /// Attempts to form as many matches as possible from the current queue.
+    /// Attempts to form as many matches as possible from the current queue,
+    /// one MatchmakingEngine shard per (mode, region).
     /// @return The list of matches formed in this cycle.
     [[nodiscard]] std::vector<MatchResult> processMatchmaking();
 
+    /// Run the matchmaking shards of each cycle through @p executor
+    /// (e.g. GameJobScheduler::runBatch) instead of one after another.
+    void setMatchmakingExecutor(MatchmakingEngine::ParallelExecutor executor);
+
+    /// Per-shard matchmaking counters (matches per second, queue depth).
+    [[nodiscard]] std::vector<MatchmakingShardStats> matchmakingStats() const;
+
+    // -- Game server placement ------------------------------------------------
+
+    /// Game servers that matches are placed on, by rendezvous hash of the
+    /// match id.  Weight or drain nodes here; the same placement can pick
+    /// a server for a player or map key.
+    [[nodiscard]] ServicePlacement& gameServers() noexcept;
+
     // -- ELO updates ----------------------------------------------------------
 
     /// Update player ratings after a match result.
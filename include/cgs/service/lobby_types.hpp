@@ -58,6 +58,15 @@ struct MatchResult {
     std::vector<MatchmakingTicket> players;
     float averageRating = 0.0f;
     float matchQuality = 0.0f;  ///< 0.0 = worst, 1.0 = perfect.
+
+    /// Team index of each entry in players (empty without teams).
+    std::vector<uint32_t> teams;
+
+    /// Predicted team balance (EloCalculator::teamBalance()), 1.0 = even.
+    float teamBalance = 1.0f;
+
+    /// Game server placed to host the match (empty if none registered).
+    std::string gameServer;
 };
 
 /// Configuration for a matchmaking queue.
@@ -73,6 +82,12 @@ struct QueueConfig {
     std::chrono::seconds expansionInterval{10};
 
     uint32_t maxQueueSize = 10000;  ///< Maximum players in the queue.
+
+    /// Teams a match is split into (0 or 1 for free-for-all).
+    uint32_t teamCount = 2;
+
+    /// Time the team balancer may spend improving one match.
+    std::chrono::microseconds teamBalanceBudget{500};
 };
 
 // -- Party types (SRS-SVC-004.3) ---------------------------------------------
@@ -96,6 +111,23 @@ struct Party {
     uint32_t maxSize = 5;
     bool inQueue = false;
     GameMode preferredMode = GameMode::Dungeon;
+
+    /// Average member MMR, kept up to date by PartyManager.
+    int32_t averageRating = 0;
+    /// Members with isReady set, kept up to date by PartyManager.
+    uint32_t readyCount = 0;
+};
+
+/// A party without its member list: what matchmaking needs, cheap to copy.
+struct PartySummary {
+    PartyId id = 0;
+    uint64_t leaderId = 0;
+    uint32_t memberCount = 0;
+    uint32_t readyCount = 0;
+    int32_t averageRating = 0;
+    uint32_t maxSize = 5;
+    bool inQueue = false;
+    GameMode preferredMode = GameMode::Dungeon;
 };
 
 /// Configuration for the lobby server.
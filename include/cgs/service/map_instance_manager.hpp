@@ -14,21 +14,28 @@
 #include "cgs/foundation/game_result.hpp"
 #include "cgs/game/world_types.hpp"
 
+#include <array>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <mutex>
 #include <optional>
+#include <set>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace cgs::service {
 
 /// Lifecycle state of a map instance.
 enum class InstanceState : uint8_t {
-    Active,       ///< Running normally, accepting new players.
-    Draining,     ///< No new players, waiting for existing to leave.
-    ShuttingDown  ///< About to be destroyed.
+    Active,        ///< Running normally, accepting new players.
+    Draining,      ///< No new players, waiting for existing to leave.
+    ShuttingDown,  ///< About to be destroyed.
+    Pooled,        ///< Pre-built and empty, waiting in an instance pool.
+    Migrating,     ///< Moving to or from another server; no new players.
+    Hibernating    ///< Empty and suspended; woken when a player enters.
 };
 
 /// Metadata for a single map instance.
@@ -40,10 +47,17 @@ struct MapInstanceInfo {
     uint32_t playerCount = 0;
     uint32_t maxPlayers = 100;
     std::chrono::steady_clock::time_point createdAt;
+
+    /// When playerCount last dropped to zero (createdAt if it never had
+    /// players).  Meaningless while the instance has players.
+    std::chrono::steady_clock::time_point emptySince;
 };
 
 /// Manages map instance creation, state transitions, and player tracking.
 ///
+/// Instances are indexed by map, by state, by emptiness and, per map, by
+/// free capacity, so lookups do not scan every instance.
+///
 /// Thread-safe: all public methods are guarded by an internal mutex.
 class MapInstanceManager {
 public:
@@ -55,11 +69,14 @@ public:
     /// @param mapId       Logical map identifier.
     /// @param type        Map type classification.
     /// @param maxPlayers  Maximum players for this instance.
+    /// @param state       Active, Pooled for a pre-built instance, or
+    ///                    Migrating for one arriving from another server.
     /// @return The new instance ID, or error if limit reached.
     [[nodiscard]] cgs::foundation::GameResult<uint32_t> createInstance(
         uint32_t mapId,
         cgs::game::MapType type = cgs::game::MapType::OpenWorld,
-        uint32_t maxPlayers = 100);
+        uint32_t maxPlayers = 100,
+        InstanceState state = InstanceState::Active);
 
     /// Destroy an instance immediately.
     ///
@@ -68,7 +85,10 @@ public:
 
     /// Transition an instance to a new state.
     ///
-    /// Valid transitions: Active → Draining → ShuttingDown.
+    /// Valid transitions: Active → Draining → ShuttingDown, Pooled →
+    /// Active, Active or Draining → Pooled once the instance is empty,
+    /// Active ↔ Migrating, and Active ↔ Hibernating (into Hibernating only
+    /// while empty).
     [[nodiscard]] bool setInstanceState(uint32_t instanceId, InstanceState state);
 
     /// Get metadata for a specific instance.
@@ -99,13 +119,40 @@ public:
     /// Find all instances with zero players.
     [[nodiscard]] std::vector<uint32_t> findEmptyInstances() const;
 
-    /// Find instances that can accept more players.
+    /// Active instances that have had no players for at least @p idleFor
+    /// as of @p now: candidates for hibernation.
+    [[nodiscard]] std::vector<uint32_t> findIdleInstances(
+        std::chrono::steady_clock::duration idleFor,
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now()) const;
+
+    /// Find instances that can accept more players, fullest first.
     [[nodiscard]] std::vector<uint32_t> findAvailableInstances(uint32_t mapId) const;
 
+    /// The fullest Active instance of @p mapId that still has room, or
+    /// nullopt.  Filling instances in turn leaves the others free to drain.
+    [[nodiscard]] std::optional<uint32_t> bestAvailableInstance(uint32_t mapId) const;
+
 private:
+    static constexpr std::size_t kStateCount =
+        static_cast<std::size_t>(InstanceState::Hibernating) + 1;
+
+    /// Add @p info to, or drop it from, the secondary indices.  Caller
+    /// holds mutex_.
+    void index(const MapInstanceInfo& info);
+    void unindex(const MapInstanceInfo& info);
+
     uint32_t maxInstances_;
     uint32_t nextInstanceId_ = 1;
     std::unordered_map<uint32_t, MapInstanceInfo> instances_;
+
+    // Secondary indices over instances_ (instance IDs).
+    std::unordered_map<uint32_t, std::set<uint32_t>> byMap_;
+    std::array<std::set<uint32_t>, kStateCount> byState_;
+    std::set<uint32_t> empty_;
+
+    // Active instances with room, per map, as (free slots, instance ID).
+    std::unordered_map<uint32_t, std::set<std::pair<uint32_t, uint32_t>>> available_;
+
     mutable std::mutex mutex_;
 };
 
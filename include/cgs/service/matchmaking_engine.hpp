@@ -0,0 +1,162 @@
+#pragma once
+
+/// @file matchmaking_engine.hpp
+/// @brief Matchmaking sharded by game mode and region, run in parallel.
+///
+/// MatchmakingEngine keeps one MatchmakingQueue per (GameMode, Region)
+/// shard and matches every shard in the same cycle through a
+/// ParallelExecutor (e.g. GameJobScheduler::runBatch).  Each shard writes
+/// its matches to its own lock-free SpscQueue, drained by one consumer.
+///
+/// @see SRS-SVC-004.1, SRS-SVC-004.2
+/// @see SDS-MOD-033
+
+#include "cgs/foundation/game_result.hpp"
+#include "cgs/foundation/spsc_queue.hpp"
+#include "cgs/service/lobby_types.hpp"
+#include "cgs/service/matchmaking_queue.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace cgs::service {
+
+/// Counters of one MatchmakingEngine shard.
+struct MatchmakingShardStats {
+    GameMode mode = GameMode::Duel;
+    Region region = Region::NAEast;
+    std::size_t queuedPlayers = 0;  ///< Tickets in the shard, Region::Any ones included.
+    uint64_t matchesFormed = 0;
+    double matchesPerSecond = 0.0;  ///< Over the interval between the last two cycles.
+    std::chrono::microseconds lastCycleTime{};  ///< Duration of the shard's last pass.
+};
+
+/// Matchmaking queues sharded by (GameMode, Region).
+///
+/// A ticket for a specific region lives in that region's shard.  Shards
+/// never share tickets, so they match in parallel without coordination.
+///
+/// Region::Any tickets follow a claim protocol: in each cycle, one region
+/// shard per mode owns all of that mode's Any tickets, and only that
+/// shard can match them.  Ownership rotates through the regions once per
+/// cycle.  The rotation runs on the thread calling runCycle(), before any
+/// shard job starts, so an Any ticket is in exactly one shard at any
+/// time.  It can never be matched twice.  Any tickets always meet each
+/// other, and within five cycles they have been offered to every region.
+///
+/// Example:
+/// @code
+///   MatchmakingEngine engine(queueConfig);
+///   engine.setParallelExecutor([&](const auto& jobs) { scheduler.runBatch(jobs); });
+///
+///   engine.enqueue(ticket);
+///   engine.runCycle();                        // shards in parallel
+///   std::vector<MatchResult> matches;
+///   engine.drainMatches(matches);
+/// @endcode
+///
+/// enqueue(), dequeue() and the queries are thread-safe.  runCycle() and
+/// drainMatches() each need a single caller at a time; they may be
+/// different threads.
+class MatchmakingEngine {
+public:
+    /// Runs a batch of jobs and returns when all are done.
+    using ParallelExecutor = std::function<void(const std::vector<std::function<void()>>&)>;
+
+    /// Region shards per mode (every Region except Any).
+    static constexpr std::size_t kRegions = 5;
+    static constexpr std::size_t kModes = 5;
+    static constexpr std::size_t kShards = kModes * kRegions;
+
+    /// Construct with the queue rules, applied to every shard
+    /// (maxQueueSize bounds the whole engine).  Each shard buffers at
+    /// most @p outputCapacity undrained matches.  When the buffer is full,
+    /// the shard stops matching until drainMatches() makes room.
+    explicit MatchmakingEngine(QueueConfig config, std::size_t outputCapacity = 1024);
+
+    ~MatchmakingEngine();
+
+    MatchmakingEngine(const MatchmakingEngine&) = delete;
+    MatchmakingEngine& operator=(const MatchmakingEngine&) = delete;
+
+    /// Set the executor for shard jobs.  Without one, shards run one after
+    /// another on the runCycle() caller.
+    void setParallelExecutor(ParallelExecutor executor);
+
+    /// Add a player to their shard.
+    ///
+    /// @return Error if the engine is full or the player is already queued.
+    [[nodiscard]] cgs::foundation::GameResult<void> enqueue(MatchmakingTicket ticket);
+
+    /// Remove a player from whichever shard holds them.
+    [[nodiscard]] bool dequeue(uint64_t playerId);
+
+    [[nodiscard]] bool isQueued(uint64_t playerId) const;
+
+    /// Players queued across all shards.
+    [[nodiscard]] std::size_t queueSize() const;
+
+    /// Run one matching pass over every shard.  Returns the number of
+    /// matches formed; they are waiting for drainMatches().
+    std::size_t runCycle();
+
+    /// Move every buffered match into @p out.  Returns the number moved.
+    std::size_t drainMatches(std::vector<MatchResult>& out);
+
+    /// Per-shard counters, in (mode, region) order.
+    [[nodiscard]] std::vector<MatchmakingShardStats> shardStats() const;
+
+    /// Get the queue configuration.
+    [[nodiscard]] const QueueConfig& config() const noexcept;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Shard {
+        Shard(GameMode m, Region r, const QueueConfig& config, std::size_t outputCapacity)
+            : mode(m), region(r), queue(config), output(outputCapacity) {}
+
+        GameMode mode;
+        Region region;
+        MatchmakingQueue queue;
+        cgs::foundation::SpscQueue<MatchResult> output;
+
+        std::atomic<uint64_t> matchesFormed{0};
+        std::atomic<uint64_t> lastCycleMatches{0};
+        std::atomic<int64_t> lastCycleMicros{0};
+    };
+
+    /// Shard of a region ticket, or the mode's current Any owner.
+    /// Caller holds mutex_.
+    Shard& shardForLocked(GameMode mode, Region region);
+
+    /// Hand each mode's Any tickets to the next region shard.
+    /// Caller holds mutex_.
+    void rotateAnyOwnersLocked();
+
+    /// Match one shard into its output queue.
+    void runShard(Shard& shard);
+
+    QueueConfig config_;
+    std::vector<std::unique_ptr<Shard>> shards_;  // by mode * kRegions + region
+    ParallelExecutor executor_;
+
+    mutable std::mutex mutex_;  // enqueue / dequeue / ownership
+    std::array<std::size_t, kModes> anyOwner_{};  // region index per mode
+    std::array<std::unordered_set<uint64_t>, kModes> anyPlayers_;
+    std::atomic<std::size_t> queued_{0};
+
+    std::atomic<uint64_t> nextMatchId_{1};
+    Clock::time_point lastCycleAt_{};
+    std::atomic<int64_t> cycleIntervalMicros_{0};
+};
+
+}  // namespace cgs::service
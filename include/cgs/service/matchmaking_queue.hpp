@@ -8,6 +8,10 @@
 /// longer get progressively wider rating tolerance, ensuring
 /// everyone eventually finds a match.
 ///
+/// Tickets are indexed by (mode, region) and kept ordered by MMR, so an
+/// anchor only looks at the players inside its rating window instead of
+/// the whole queue.
+///
 /// @see SRS-SVC-004.1, SRS-SVC-004.2
 /// @see SDS-MOD-033
 
@@ -15,10 +19,17 @@
 #include "cgs/service/lobby_types.hpp"
 
 #include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <limits>
+#include <map>
 #include <mutex>
 #include <optional>
+#include <set>
+#include <tuple>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace cgs::service {
@@ -29,8 +40,9 @@ namespace cgs::service {
 /// @code
 ///   MatchmakingQueue queue(config);
 ///   queue.enqueue(ticket);
-///   auto match = queue.tryMatch(); // Called periodically
-///   if (match) { /* start game with match->players */ }
+///   for (auto& match : queue.matchAll()) {  // Called periodically
+///       /* start game with match.players */
+///   }
 /// @endcode
 class MatchmakingQueue {
 public:
@@ -49,12 +61,19 @@ public:
 
     /// Attempt to form a match from currently queued players.
     ///
-    /// Scans the queue for a group of players within rating tolerance.
-    /// Players who have waited longer get expanded tolerance windows.
+    /// Anchors are tried longest-waiting first; each takes the closest
+    /// rated compatible players within tolerance.  Players who have waited
+    /// longer get expanded tolerance windows.
     ///
     /// @return A MatchResult if a valid match was found, nullopt otherwise.
     [[nodiscard]] std::optional<MatchResult> tryMatch();
 
+    /// Form every match currently possible in one pass over the queue
+    /// (same rules as tryMatch(), without rescanning per match), stopping
+    /// after @p maxMatches.
+    [[nodiscard]] std::vector<MatchResult> matchAll(
+        std::size_t maxMatches = std::numeric_limits<std::size_t>::max());
+
     /// Check if a player is currently in the queue.
     [[nodiscard]] bool isQueued(uint64_t playerId) const;
 
@@ -68,16 +87,41 @@ public:
     [[nodiscard]] const QueueConfig& config() const noexcept;
 
 private:
+    using Clock = std::chrono::steady_clock;
+
+    /// Tickets of one (mode, region), ordered by (MMR, player).
+    using RatingIndex = std::set<std::pair<int32_t, uint64_t>>;
+    using PartitionKey = std::pair<GameMode, Region>;
+
+    /// A queued ticket and its position in the wait order.
+    struct Entry {
+        MatchmakingTicket ticket;
+        uint64_t seq = 0;  ///< Enqueue order, breaking enqueuedAt ties.
+    };
+
+    /// (enqueuedAt, seq, playerId): longest waiting first.
+    using WaitKey = std::tuple<Clock::time_point, uint64_t, uint64_t>;
+
+    /// Form up to @p limit matches.  Caller holds mutex_.
+    std::vector<MatchResult> matchLocked(std::size_t limit);
+
+    /// Remove a queued player from every index.  Caller holds mutex_.
+    void eraseLocked(std::unordered_map<uint64_t, Entry>::iterator it);
+
     /// Calculate the effective rating tolerance for a ticket
     /// based on how long it has been waiting.
-    [[nodiscard]] int32_t effectiveTolerance(const MatchmakingTicket& ticket) const;
+    [[nodiscard]] int32_t effectiveTolerance(const MatchmakingTicket& ticket,
+                                             Clock::time_point now) const;
 
     /// Generate a unique match ID.
     [[nodiscard]] uint64_t nextMatchId();
 
     QueueConfig config_;
-    std::vector<MatchmakingTicket> tickets_;
-    std::unordered_map<uint64_t, std::size_t> playerIndex_;
+    std::unordered_map<uint64_t, Entry> tickets_;  // by player
+    std::map<PartitionKey, RatingIndex> partitions_;
+    std::set<WaitKey> byWait_;
+    uint64_t nextSeq_ = 0;
+    std::vector<std::pair<int32_t, uint64_t>> scratch_;  // (distance, player)
     std::atomic<uint64_t> nextMatchId_{1};
     mutable std::mutex mutex_;
 };
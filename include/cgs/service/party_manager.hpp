@@ -5,7 +5,8 @@
 ///
 /// PartyManager provides create, invite, join, leave, kick, promote,
 /// and disband operations for player parties. Parties can queue for
-/// matchmaking as a unit.
+/// matchmaking as a unit.  Each party's average rating and ready count
+/// are updated as members change, so reading them is O(1).
 ///
 /// @see SRS-SVC-004.3
 /// @see SDS-MOD-033
@@ -17,6 +18,7 @@
 #include <mutex>
 #include <optional>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace cgs::service {
@@ -67,6 +69,11 @@ public:
                                                                   uint64_t requesterId,
                                                                   uint64_t newLeaderId);
 
+    /// Set a member's ready flag.
+    [[nodiscard]] cgs::foundation::GameResult<void> setReady(PartyId partyId,
+                                                             uint64_t playerId,
+                                                             bool ready);
+
     // -- Queue integration ----------------------------------------------------
 
     /// Mark a party as in-queue.
@@ -74,9 +81,27 @@ public:
 
     // -- Queries --------------------------------------------------------------
 
-    /// Get party info.
+    /// Get party info (a full copy, member names included).
     [[nodiscard]] std::optional<Party> getParty(PartyId partyId) const;
 
+    /// Get a party's aggregates without copying its members.
+    [[nodiscard]] std::optional<PartySummary> partySummary(PartyId partyId) const;
+
+    /// Call @p fn with the party under the manager's lock, without
+    /// copying it.  @p fn must not call back into the manager.
+    ///
+    /// @return false if the party does not exist (fn is not called).
+    template <typename Fn>
+    bool visitParty(PartyId partyId, Fn&& fn) const {
+        std::lock_guard lock(mutex_);
+        auto it = parties_.find(partyId);
+        if (it == parties_.end()) {
+            return false;
+        }
+        std::forward<Fn>(fn)(static_cast<const Party&>(it->second.party));
+        return true;
+    }
+
     /// Get the party a player belongs to.
     [[nodiscard]] std::optional<PartyId> getPlayerParty(uint64_t playerId) const;
 
@@ -86,10 +111,19 @@ public:
     /// Get the number of active parties.
     [[nodiscard]] std::size_t partyCount() const;
 
-    /// Calculate the average MMR across all party members.
+    /// Average MMR across all party members (cached).
     [[nodiscard]] std::optional<int32_t> averagePartyRating(PartyId partyId) const;
 
 private:
+    /// A party and the running sum behind its average rating.
+    struct Entry {
+        Party party;
+        int64_t ratingSum = 0;
+    };
+
+    /// Add @p mmr (negative to remove) to the sum and refresh the average.
+    static void adjustRating(Entry& entry, int64_t mmr);
+
     /// Generate a unique party ID.
     [[nodiscard]] PartyId nextPartyId();
 
@@ -97,7 +131,7 @@ private:
     void removePartyInternal(PartyId partyId);
 
     uint32_t maxPartySize_;
-    std::unordered_map<PartyId, Party> parties_;
+    std::unordered_map<PartyId, Entry> parties_;
     std::unordered_map<uint64_t, PartyId> playerParty_;
     uint64_t nextPartyId_ = 1;
     mutable std::mutex mutex_;
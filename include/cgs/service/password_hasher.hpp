@@ -1,15 +1,16 @@
 #pragma once
 
 /// @file password_hasher.hpp
-/// @brief Password hashing and verification using SHA-256 with salt.
+/// @brief Password hashing and verification using scrypt or salted SHA-256.
 ///
 /// Provides secure password storage by generating a random salt per user
-/// and computing SHA-256(salt + password).  The interface is designed to be
-/// swappable with bcrypt or argon2id implementations via a foundation
-/// crypto adapter in production deployments.
+/// and deriving the stored hash with scrypt (memory-hard, cost tunable) or,
+/// at cost 0, SHA-256(salt + password).  Hashes record their scheme, so a
+/// deployment can raise the cost without invalidating stored passwords.
 ///
 /// @see SRS-SVC-001.6
 
+#include <cstdint>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -22,16 +23,29 @@ struct HashedPassword {
     std::string salt;
 };
 
-/// Password hashing utility using SHA-256 + random salt.
+/// Password hashing utility with a random salt per password.
+///
+/// Cost 0 stores hex SHA-256(salt + password).  Cost N stores
+/// "scrypt$N$<hex>" from scrypt with 2^N iterations (r = 8, p = 1), using
+/// 2^N KiB of memory per hash: 14 takes ~16 MiB and tens of milliseconds.
+/// verify() reads the scheme from the stored hash, whatever the cost the
+/// hasher was built with.
 ///
 /// Example:
 /// @code
-///   PasswordHasher hasher;
+///   PasswordHasher hasher(14);
 ///   auto hashed = hasher.hash("my_password");
 ///   bool ok = hasher.verify("my_password", hashed.hash, hashed.salt);
 /// @endcode
 class PasswordHasher {
 public:
+    /// Highest accepted cost (2^20 iterations, 1 GiB).
+    static constexpr uint32_t kMaxCost = 20;
+
+    /// Construct hashing at @p cost (0 for salted SHA-256; clamped to
+    /// kMaxCost).
+    explicit PasswordHasher(uint32_t cost = 0);
+
     /// Hash a plaintext password with a newly generated random salt.
     [[nodiscard]] HashedPassword hash(std::string_view password) const;
 
@@ -45,6 +59,12 @@ public:
 
     /// Generate a cryptographically random salt (hex-encoded).
     [[nodiscard]] static std::string generateSalt();
+
+    /// Cost new hashes are computed at.
+    [[nodiscard]] uint32_t cost() const noexcept { return cost_; }
+
+private:
+    uint32_t cost_;
 };
 
 }  // namespace cgs::service
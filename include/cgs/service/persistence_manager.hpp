@@ -4,8 +4,10 @@
 /// @brief Coordinates WAL and snapshots for crash-safe player data persistence.
 ///
 /// PersistenceManager is the high-level interface that service entry points
-/// use. It runs a background snapshot timer, coordinates WAL truncation
-/// after successful snapshots, and provides a unified recovery API.
+/// use. It runs a background snapshot timer, captures snapshots on the
+/// caller's thread and writes them on a background one, coordinates WAL
+/// truncation after successful snapshots, and provides a unified recovery
+/// API.
 ///
 /// Part of SRS-NFR-013 (zero data loss on crash).
 
@@ -14,13 +16,21 @@
 #include "cgs/service/write_ahead_log.hpp"
 
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <functional>
 #include <memory>
+#include <vector>
 
 namespace cgs::service {
 
+/// What PersistenceManager::submitChange() does when its ring is full.
+enum class SubmitBackpressure : uint8_t {
+    Block,   ///< Wait for the writer thread to free a slot.
+    Reject,  ///< Fail with ErrorCode::WalQueueFull.
+};
+
 /// Configuration for the PersistenceManager.
 struct PersistenceConfig {
     /// WAL configuration.
@@ -30,12 +40,42 @@ struct PersistenceConfig {
     SnapshotConfig snapshot;
 
     /// Interval between periodic snapshots. Default: 60 seconds.
+    ///
+    /// Periodic snapshots run the collector on the timer thread. Set 0 to
+    /// disable the timer and call captureSnapshot() from the game loop at
+    /// a tick boundary instead.
     std::chrono::seconds snapshotInterval{60};
+
+    /// Captured snapshots that may wait for the writer thread; a capture
+    /// beyond this fails instead of queueing. Default: 2.
+    std::size_t maxPendingSnapshotWrites = 2;
+
+    /// WAL operations whose entries carry a player's full state: recovery
+    /// applies only the last one per player (WriteAheadLog::replayCompacted).
+    std::vector<WalOperation> compactOnRecovery;
+
+    /// Every Nth snapshot is full; the ones in between are incremental and
+    /// hold only the players recorded via recordChange() since the last
+    /// full one. Default: 1 (every snapshot is full).
+    uint32_t fullSnapshotEvery = 1;
+
+    /// Entries the submission ring behind submitChange() holds. A writer
+    /// thread drains it into WAL group commits. 0 (default) disables the
+    /// ring: changes are appended on the caller's thread.
+    std::size_t submitQueueCapacity = 0;
+
+    /// What submitChange() does when the ring is full.
+    SubmitBackpressure submitBackpressure = SubmitBackpressure::Block;
 };
 
 /// Callback invoked to collect current player states for a snapshot.
 using StateCollector = std::function<std::vector<PlayerSnapshot>()>;
 
+/// Callback invoked to collect the states of the given players for an
+/// incremental snapshot. Players that no longer exist are left out.
+using DirtyStateCollector =
+    std::function<std::vector<PlayerSnapshot>(const std::vector<cgs::foundation::PlayerId>&)>;
+
 /// Callback invoked to restore player states from a snapshot during recovery.
 using StateRestorer = std::function<void(const Snapshot&)>;
 
@@ -89,17 +129,63 @@ public:
                                                           StateRestorer restorer,
                                                           WalApplier applier);
 
+    /// Start with a collector for incremental snapshots.
+    ///
+    /// Without @p dirtyCollector, incremental snapshots filter the output
+    /// of @p collector down to the changed players.
+    [[nodiscard]] cgs::foundation::GameResult<void> start(StateCollector collector,
+                                                          DirtyStateCollector dirtyCollector,
+                                                          StateRestorer restorer,
+                                                          WalApplier applier);
+
     /// Stop the persistence subsystem.
     ///
     /// Takes a final snapshot, flushes the WAL, and stops the timer.
     void stop();
 
     /// Record a player state change in the WAL.
+    ///
+    /// Returns once the entry is in the WAL (synced, with syncOnWrite).
+    /// @return The entry's WAL sequence, or an error.
     [[nodiscard]] cgs::foundation::GameResult<uint64_t> recordChange(WalEntry entry);
 
+    /// Queue a player state change for the WAL without waiting for it.
+    ///
+    /// With PersistenceConfig::submitQueueCapacity set, the entry goes into
+    /// a lock-free ring and this returns at once with the WAL sequence the
+    /// entry will get; pass it to waitDurable() where durability matters.
+    /// Without the ring this is recordChange().
+    ///
+    /// @return The entry's WAL sequence (ticket), or WalQueueFull when the
+    ///         ring is full under SubmitBackpressure::Reject.
+    [[nodiscard]] cgs::foundation::GameResult<uint64_t> submitChange(WalEntry entry);
+
+    /// Wait until the entry with WAL sequence @p ticket is in the WAL.
+    ///
+    /// @return An error if its append failed or the manager stopped first.
+    [[nodiscard]] cgs::foundation::GameResult<void> waitDurable(uint64_t ticket);
+
     /// Trigger an immediate snapshot (outside the periodic schedule).
+    ///
+    /// Returns once the snapshot, and any captured before it, is on disk.
     [[nodiscard]] cgs::foundation::GameResult<void> takeSnapshot();
 
+    /// Capture a snapshot without waiting for it to be written.
+    ///
+    /// Runs the collector on the calling thread, so a game loop that calls
+    /// this between ticks pauses only for the capture. Serializing,
+    /// writing and syncing the file, then truncating the WAL, happen on
+    /// the writer thread.
+    ///
+    /// @return An error if no collector is registered or
+    ///         maxPendingSnapshotWrites captures are already queued.
+    [[nodiscard]] cgs::foundation::GameResult<void> captureSnapshot();
+
+    /// Wait until captured snapshots are written.
+    ///
+    /// @return The first write failure since the last wait, if any.
+    [[nodiscard]] cgs::foundation::GameResult<void> waitForSnapshots();
+
     /// Check if the persistence subsystem is running.
     [[nodiscard]] bool isRunning() const;
 
@@ -109,6 +195,9 @@ public:
     /// Get the current WAL sequence number.
     [[nodiscard]] uint64_t currentWalSequence() const;
 
+    /// Entries waiting in the submission ring.
+    [[nodiscard]] std::size_t submitQueueDepth() const;
+
 private:
     struct Impl;
     std::unique_ptr<Impl> impl_;
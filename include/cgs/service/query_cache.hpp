@@ -1,11 +1,15 @@
 #pragma once
 
 /// @file query_cache.hpp
-/// @brief Thread-safe LRU query cache with TTL expiration.
+/// @brief Thread-safe sharded query cache with CLOCK eviction and TTL
+///        expiration.
 ///
-/// Caches SELECT query results keyed by the SQL string.
-/// Supports configurable TTL, size limits, and table-based
-/// invalidation for write-through consistency.
+/// Caches SELECT query results keyed by a 64-bit hash of the SQL string.
+/// Supports configurable TTL, entry and byte budgets, per-table byte
+/// quotas, and table-based invalidation for write-through consistency,
+/// indexed by the tables each query reads.  Entries are columnar
+/// QueryResults whose storage is shared with the results handed out, so
+/// put() and a hit in get() copy no rows.
 ///
 /// @see SRS-SVC-005.3
 /// @see SDS-MOD-034
@@ -19,10 +23,26 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 
 namespace cgs::service {
 
-/// Thread-safe LRU query cache with TTL-based expiration.
+/// Thread-safe query cache with TTL-based expiration.
+///
+/// Entries are spread over CacheConfig::shards shards, each behind its own
+/// std::shared_mutex.  A hit takes the shard's shared lock and only sets
+/// the entry's reference bit; when a shard is full, put() evicts with
+/// CLOCK (second chance): the hand clears set bits and takes the first
+/// entry that is unreferenced or expired.
+///
+/// Entries are charged their result's memoryBytes() plus the SQL text
+/// against CacheConfig::maxTotalBytes and the quota of every table they
+/// read; results over maxValueSizeBytes are not cached.  With
+/// CacheConfig::admissionFilter, a count-min sketch of recent lookups
+/// (TinyLFU) guards eviction: a new query may only displace a live entry
+/// looked up no more often than itself, so a one-off scan cannot flush
+/// hot lookups.  The byte budget and the sketch are per shard; quotas are
+/// cache-wide, and a put over one evicts the table's entries in its shard.
 ///
 /// Usage:
 /// @code
@@ -49,7 +69,8 @@ public:
 
     /// Look up a cached query result.
     ///
-    /// @return The cached result if found and not expired, nullopt otherwise.
+    /// @return The cached result if found and not expired, nullopt
+    ///         otherwise.  The result shares the cached storage.
     [[nodiscard]] std::optional<cgs::foundation::QueryResult> get(std::string_view sql);
 
     /// Store a query result in the cache.
@@ -67,9 +88,9 @@ public:
 
     /// Invalidate all cached queries that reference the given table name.
     ///
-    /// Uses a simple substring match on the SQL key to detect table
-    /// references. This is a conservative approach that may invalidate
-    /// more entries than strictly necessary, ensuring correctness.
+    /// put() records the tables each query reads (every name after FROM
+    /// or JOIN, matched case-insensitively and without schema or quotes),
+    /// so this touches only the affected entries.
     ///
     /// @return Number of entries invalidated.
     std::size_t invalidateByTable(std::string_view tableName);
@@ -80,12 +101,21 @@ public:
     /// Get the current number of cached entries.
     [[nodiscard]] std::size_t size() const;
 
+    /// Bytes charged for the cached entries.
+    [[nodiscard]] std::size_t bytes() const;
+
+    /// Bytes charged per table with a quota in CacheConfig::tableQuotaBytes.
+    [[nodiscard]] std::unordered_map<std::string, std::size_t> tableBytes() const;
+
     /// Get cumulative hit count.
     [[nodiscard]] uint64_t hitCount() const;
 
     /// Get cumulative miss count.
     [[nodiscard]] uint64_t missCount() const;
 
+    /// Puts not cached because of the value size, a quota or admission.
+    [[nodiscard]] uint64_t rejectedCount() const;
+
     /// Get cache hit rate (0.0 to 1.0).
     [[nodiscard]] double hitRate() const;
 
@@ -0,0 +1,63 @@
+#pragma once
+
+/// @file query_shape_registry.hpp
+/// @brief Per-shape query counts and latency for DBProxy.
+///
+/// Grouping statements by normalized shape shows which queries cost the
+/// most in total, even when no single execution is slow.
+///
+/// @see SRS-SVC-005.2
+/// @see SDS-MOD-034
+
+#include "cgs/service/dbproxy_types.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace cgs::service {
+
+/// Count and latency per query shape, bounded in the number of shapes.
+///
+/// The first @p maxShapes shapes recorded get their own entry; later
+/// ones share an "(other)" entry, so literal-heavy SQL the normalizer
+/// leaves opaque cannot grow the registry without bound.  record() takes
+/// a shared lock and updates atomics except on a shape's first use.
+///
+/// Usage:
+/// @code
+///   QueryShapeRegistry shapes(1024);
+///   auto n = normalizeSql(sql);
+///   shapes.record(n.fingerprint, n.shape, elapsed);
+///   for (const auto& s : shapes.snapshot()) { ... }  // Costliest first.
+/// @endcode
+class QueryShapeRegistry {
+public:
+    explicit QueryShapeRegistry(std::size_t maxShapes);
+    ~QueryShapeRegistry();
+
+    QueryShapeRegistry(const QueryShapeRegistry&) = delete;
+    QueryShapeRegistry& operator=(const QueryShapeRegistry&) = delete;
+    QueryShapeRegistry(QueryShapeRegistry&&) noexcept;
+    QueryShapeRegistry& operator=(QueryShapeRegistry&&) noexcept;
+
+    /// Count one statement of @p shape that took @p latency.
+    void record(uint64_t fingerprint, std::string_view shape, std::chrono::nanoseconds latency);
+
+    /// All shapes, by total latency, highest first.
+    [[nodiscard]] std::vector<QueryShapeStats> snapshot() const;
+
+    /// Shapes with their own entry.
+    [[nodiscard]] std::size_t size() const;
+
+    /// Forget all shapes.
+    void clear();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace cgs::service
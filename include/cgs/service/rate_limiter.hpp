@@ -1,23 +1,58 @@
 #pragma once
 
 /// @file rate_limiter.hpp
-/// @brief Sliding-window rate limiter for login attempt throttling.
+/// @brief Fixed-memory rate limiter for login attempt throttling.
 ///
-/// Tracks timestamps of recent attempts per key (typically client IP)
-/// within a configurable time window.
+/// Limits attempts per key (typically client IP) to a configured number
+/// per time window using GCRA: each key keeps a single timestamp, so a
+/// burst of attempts from many addresses costs a bounded table rather
+/// than a growing history per key.
 ///
 /// @see SRS-SVC-001 (rate limiting on login attempts)
 
+#include "cgs/foundation/profiled_mutex.hpp"
+
+#include <array>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
-#include <deque>
 #include <mutex>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 namespace cgs::service {
 
-/// Sliding-window rate limiter.
+/// 128-bit rate-limit key.  IPv4 addresses map to their IPv4-mapped IPv6
+/// form, so "10.0.0.1" and "::ffff:10.0.0.1" share a key.
+struct RateLimitKey {
+    uint64_t high = 0;
+    uint64_t low = 0;
+
+    /// Key for an IPv4 or IPv6 address; other strings are hashed.
+    [[nodiscard]] static RateLimitKey from(std::string_view key) noexcept;
+
+    friend bool operator==(const RateLimitKey&, const RateLimitKey&) = default;
+};
+
+/// Hash of a RateLimitKey, mixing both halves (IPv4 keys have high == 0).
+struct RateLimitKeyHash {
+    std::size_t operator()(const RateLimitKey& key) const noexcept {
+        const uint64_t h = (key.low ^ (key.high * 0x9E3779B97F4A7C15ULL)) * 0xBF58476D1CE4E5B9ULL;
+        return static_cast<std::size_t>(h ^ (h >> 32));
+    }
+};
+
+/// Rate limiter allowing @c maxAttempts per @c window for each key.
+///
+/// Implemented as GCRA: a key's state is the time its budget is next
+/// full, attempts are admitted while that lies at most one window ahead,
+/// and budget returns continuously (one attempt per window / maxAttempts)
+/// instead of all at once when an old attempt leaves the window.
+///
+/// Keys live in a sharded table bounded at @c maxKeys; when a shard is
+/// full its least recently used key is evicted.
 ///
 /// Example:
 /// @code
@@ -28,28 +63,61 @@ namespace cgs::service {
 /// @endcode
 class RateLimiter {
 public:
-    /// Construct with max attempts allowed per window duration.
-    RateLimiter(uint32_t maxAttempts, std::chrono::seconds window);
+    /// Construct with max attempts allowed per window duration, tracking
+    /// at most @p maxKeys keys.
+    RateLimiter(uint32_t maxAttempts, std::chrono::seconds window, std::size_t maxKeys = 65536);
 
     /// Record an attempt for the given key.
     /// Returns true if the attempt is allowed, false if rate limit exceeded.
     [[nodiscard]] bool allow(const std::string& key);
 
+    /// Record an attempt for a pre-computed key.
+    [[nodiscard]] bool allow(RateLimitKey key);
+
     /// Get remaining attempts for the given key within the current window.
     [[nodiscard]] uint32_t remaining(const std::string& key) const;
 
     /// Reset all tracked attempts for the given key.
     void reset(const std::string& key);
 
+    /// Number of keys currently tracked.
+    [[nodiscard]] std::size_t trackedKeys() const;
+
 private:
-    using TimePoint = std::chrono::steady_clock::time_point;
+    using Clock = std::chrono::steady_clock;
+    using Rep = Clock::rep;
+
+    static constexpr std::size_t kShards = 16;
+    static constexpr uint32_t kNone = static_cast<uint32_t>(-1);
+
+    // A tracked key: its GCRA timestamp and LRU links (slot indices).
+    struct Slot {
+        RateLimitKey key;
+        Rep fullAt = 0;  // when the key's budget is full again
+        uint32_t prev = kNone;
+        uint32_t next = kNone;
+    };
+
+    // Slots grow up to the shard capacity, then are recycled LRU-first.
+    struct Shard {
+        cgs::foundation::ProfiledMutex mutex{"auth.rate_limiter"};
+        std::vector<Slot> slots;
+        std::unordered_map<RateLimitKey, uint32_t, RateLimitKeyHash> index;
+        uint32_t head = kNone;  // most recently used
+        uint32_t tail = kNone;  // least recently used
+    };
+
+    Shard& shardFor(const RateLimitKey& key) const;
 
-    void purgeExpired(std::deque<TimePoint>& timestamps) const;
+    // Caller holds the shard mutex.
+    static void unlink(Shard& shard, uint32_t slot);
+    static void pushFront(Shard& shard, uint32_t slot);
 
     uint32_t maxAttempts_;
-    std::chrono::seconds window_;
-    mutable std::mutex mutex_;
-    std::unordered_map<std::string, std::deque<TimePoint>> attempts_;
+    Rep windowTicks_;
+    Rep interval_;  // one attempt's worth of window
+    std::size_t shardCapacity_;
+    mutable std::array<Shard, kShards> shards_;
 };
 
 }  // namespace cgs::service
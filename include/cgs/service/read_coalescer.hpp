@@ -0,0 +1,86 @@
+#pragma once
+
+/// @file read_coalescer.hpp
+/// @brief Single-flight coalescing of concurrent identical reads.
+///
+/// When many callers miss the cache for the same SELECT at once (a raid
+/// zoning in loads the same guild, instance and template rows), only the
+/// first goes to the database; the others wait for its result.
+///
+/// @see SRS-SVC-005.3
+/// @see SDS-MOD-034
+
+#include "cgs/foundation/game_database.hpp"
+#include "cgs/foundation/game_result.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace cgs::service {
+
+/// Coalesces concurrent reads of the same normalized SQL into one fetch.
+///
+/// The first read of a statement leads: it runs its fetch and completes
+/// every read that joined meanwhile with the same result (QueryResult
+/// copies share storage).  A write must call invalidateTable() before it
+/// invalidates the cache, so reads already in flight are detached: later
+/// reads start a fresh fetch, and the detached result is not stored.
+///
+/// Usage:
+/// @code
+///   ReadCoalescer flights(
+///       [&](auto job) { return executor.post(std::move(job)); },
+///       [&](std::string_view sql, const QueryResult& r) { cache.put(sql, r); });
+///
+///   auto result = flights.read(sql, [&] { return pool.query(sql); });
+/// @endcode
+class ReadCoalescer {
+public:
+    using Result = cgs::foundation::GameResult<cgs::foundation::QueryResult>;
+    using Fetch = std::function<Result()>;
+    using Post = std::function<bool(std::function<void()>)>;
+    using Store = std::function<void(std::string_view, const cgs::foundation::QueryResult&)>;
+
+    /// @param post  Runs asynchronous work; false if it cannot (the work
+    ///              then runs inline).
+    /// @param store Receives each successful leader result still valid.
+    ReadCoalescer(Post post, Store store);
+    ~ReadCoalescer();
+
+    ReadCoalescer(const ReadCoalescer&) = delete;
+    ReadCoalescer& operator=(const ReadCoalescer&) = delete;
+    ReadCoalescer(ReadCoalescer&&) noexcept;
+    ReadCoalescer& operator=(ReadCoalescer&&) noexcept;
+
+    /// Run @p fetch for @p sql, or wait for the identical read in flight.
+    [[nodiscard]] Result read(std::string_view sql, const Fetch& fetch);
+
+    /// Asynchronous read.  Joining a read in flight posts nothing: @p onDone
+    /// is completed with the leader's result.  Otherwise @p fetch is posted
+    /// and completes @p onDone with every read that joins it.
+    void readAsync(std::string_view sql, Fetch fetch, cgs::foundation::QueryCallback onDone);
+
+    /// Detach the reads in flight that read @p table.
+    ///
+    /// @return Number of reads detached.
+    std::size_t invalidateTable(std::string_view table);
+
+    /// Reads served by another read's fetch.
+    [[nodiscard]] uint64_t coalescedCount() const;
+
+    /// Reads currently in flight (leaders).
+    [[nodiscard]] std::size_t inFlight() const;
+
+    /// Coalescing key of @p sql: whitespace runs outside string literals
+    /// collapsed to one space, ends trimmed.
+    [[nodiscard]] static std::string normalize(std::string_view sql);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace cgs::service
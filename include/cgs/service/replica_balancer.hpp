@@ -0,0 +1,87 @@
+#pragma once
+
+/// @file replica_balancer.hpp
+/// @brief Latency- and load-aware read replica selection.
+///
+/// ConnectionPoolManager asks the balancer which replica should serve a
+/// read.  Each replica's cost is a peak EWMA of its read latency times
+/// its outstanding reads, so a slow or overloaded replica gets less
+/// traffic instead of an equal round-robin share.
+///
+/// @see SRS-SVC-005.4
+/// @see SDS-MOD-034
+
+#include "cgs/service/dbproxy_types.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace cgs::service {
+
+/// Picks read replicas by power-of-two-choices over a peak-EWMA cost.
+///
+/// pick() samples two distinct usable replicas and returns the one with
+/// the lower score, `(latency + 1 us) * (inFlight + 1)`.  Latency is a
+/// peak EWMA: a slower read raises it at once, faster reads pull it down
+/// with time constant @p decay, and it decays towards zero while idle so
+/// a replica that was avoided is probed again.  A failed read counts as
+/// a one-second read.  All members are thread-safe.
+///
+/// Usage:
+/// @code
+///   ReplicaBalancer balancer(replicas.size());
+///   auto i = balancer.pick([&](std::size_t r) { return replicas[r].isConnected(); });
+///   if (i != ReplicaBalancer::npos) {
+///       balancer.begin(i);
+///       auto start = std::chrono::steady_clock::now();
+///       auto result = replicas[i].query(sql);
+///       balancer.finish(i, std::chrono::steady_clock::now() - start, result.hasValue());
+///   }
+/// @endcode
+class ReplicaBalancer {
+public:
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    explicit ReplicaBalancer(std::size_t replicas,
+                             std::chrono::milliseconds decay = std::chrono::seconds(10));
+    ~ReplicaBalancer();
+
+    ReplicaBalancer(const ReplicaBalancer&) = delete;
+    ReplicaBalancer& operator=(const ReplicaBalancer&) = delete;
+    ReplicaBalancer(ReplicaBalancer&&) noexcept;
+    ReplicaBalancer& operator=(ReplicaBalancer&&) noexcept;
+
+    /// Replica to read from among those @p usable accepts, or npos.
+    [[nodiscard]] std::size_t pick(const std::function<bool(std::size_t)>& usable) const;
+
+    /// A read was sent to @p replica.
+    void begin(std::size_t replica);
+
+    /// The read sent to @p replica completed after @p latency.
+    void finish(std::size_t replica, std::chrono::nanoseconds latency, bool ok);
+
+    /// Record a probed replication lag.
+    void setLag(std::size_t replica, std::chrono::milliseconds lag);
+
+    /// Last probed replication lag (zero if never probed).
+    [[nodiscard]] std::chrono::milliseconds lag(std::size_t replica) const;
+
+    /// Routing cost of @p replica now; lower is preferred.
+    [[nodiscard]] double score(std::size_t replica) const;
+
+    /// Latency, load, score, lag and counters per replica (connected is
+    /// left for the caller).
+    [[nodiscard]] std::vector<ReplicaStats> stats() const;
+
+    [[nodiscard]] std::size_t size() const noexcept;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace cgs::service
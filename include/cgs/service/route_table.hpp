@@ -6,11 +6,19 @@
 /// Maps incoming message opcodes to downstream service identifiers
 /// so the gateway can forward traffic to the correct backend.
 ///
+/// Routes are compiled into a 65536-slot table indexed by opcode and
+/// published by pointer swap, so resolve() is one array load with no lock.
+/// Service names are interned to small ids when first added, and their
+/// text in the process-wide StringInterner.
+///
 /// @see SRS-SVC-002.3
 
 #include "cgs/service/gateway_types.hpp"
 
+#include <array>
+#include <atomic>
 #include <cstdint>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
@@ -19,10 +27,18 @@
 
 namespace cgs::service {
 
+/// Interned service name id, assigned by a RouteTable in order of first use
+/// (a table holds up to 32767 distinct services).
+using RouteServiceId = uint16_t;
+
 /// Lookup result from a route table query.
 struct RouteMatch {
-    /// Downstream service identifier.
-    std::string service;
+    /// Interned id of the downstream service.
+    RouteServiceId serviceId = 0;
+
+    /// Downstream service identifier.  Interned: valid for the lifetime of
+    /// the process, even after its routes are removed.
+    std::string_view service;
 
     /// Whether this route requires the client to be authenticated.
     bool requiresAuth = true;
@@ -39,8 +55,18 @@ struct RouteMatch {
 ///   auto match = routes.resolve(0x0150);
 ///   // match->service == "game"
 /// @endcode
+///
+/// Mutations rebuild and republish the table, so they cost a pass over
+/// the opcode space; they are meant for configuration and deploys, not
+/// per-message work.  Where ranges overlap, the route added first wins.
 class RouteTable {
 public:
+    RouteTable();
+    ~RouteTable();
+
+    RouteTable(const RouteTable&) = delete;
+    RouteTable& operator=(const RouteTable&) = delete;
+
     /// Add a route mapping an opcode range to a service.
     void addRoute(uint16_t opcodeMin,
                   uint16_t opcodeMax,
@@ -50,13 +76,23 @@ public:
     /// Add a route from a RouteEntry.
     void addRoute(RouteEntry entry);
 
-    /// Resolve an opcode to the matching route, if any.
+    /// Resolve an opcode to the matching route, if any.  Lock-free.
     [[nodiscard]] std::optional<RouteMatch> resolve(uint16_t opcode) const;
 
+    /// Interned id of @p service, if it was ever added.
+    [[nodiscard]] std::optional<RouteServiceId> serviceId(std::string_view service) const;
+
+    /// Intern @p service without routing to it, e.g. to attach a backend
+    /// link before its routes exist.  Ids and names are never reused.
+    RouteServiceId internService(std::string_view service);
+
+    /// Name of an interned service id (empty if unknown).
+    [[nodiscard]] std::string_view serviceName(RouteServiceId id) const;
+
     /// Check whether an opcode is a reserved gateway-level opcode (0x0000-0x00FF).
     [[nodiscard]] static bool isGatewayOpcode(uint16_t opcode);
 
-    /// Get all registered routes.
+    /// Get all registered routes.  Not synchronized with mutations.
     [[nodiscard]] const std::vector<RouteEntry>& routes() const;
 
     /// Remove all routes for a specific service.
@@ -66,8 +102,39 @@ public:
     void clear();
 
 private:
+    // Published routing table.  A slot is 0 for no route, otherwise
+    // (serviceId + 1) << 1 | requiresAuth.
+    struct Compiled {
+        std::array<uint16_t, 65536> slots{};
+        std::vector<cgs::foundation::InternedString> services;  // by RouteServiceId
+    };
+
+    // Open while resolve() reads the published table; tables replaced by
+    // a writer are freed only once no guard is open.
+    struct ReadGuard {
+        explicit ReadGuard(std::atomic<uint32_t>& counter) : readers(counter) {
+            readers.fetch_add(1);
+        }
+        ~ReadGuard() { readers.fetch_sub(1); }
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+        std::atomic<uint32_t>& readers;
+    };
+
+    // Intern @p service.  Caller holds mutex_.
+    RouteServiceId internLocked(cgs::foundation::InternedString service);
+
+    // Compile routes_ and publish the result.  Caller holds mutex_.
+    void rebuildLocked();
+
+    std::atomic<const Compiled*> table_{nullptr};
+    mutable std::atomic<uint32_t> readers_{0};
+
+    // Serializes mutations; guards everything below.
     mutable std::mutex mutex_;
     std::vector<RouteEntry> routes_;
+    std::vector<cgs::foundation::InternedString> names_;  // by RouteServiceId
+    std::vector<std::unique_ptr<const Compiled>> retired_;
 };
 
 }  // namespace cgs::service
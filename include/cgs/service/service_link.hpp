@@ -0,0 +1,106 @@
+#pragma once
+
+/// @file service_link.hpp
+/// @brief Multiplexed gateway-to-backend connection.
+///
+/// A ServiceLink carries the traffic of many client sessions over one
+/// backend connection, each frame tagged with its session id.  Forwarded
+/// payloads are referenced, not copied: forward() records a header and a
+/// view of the caller's receive buffer, and flush() hands the transport
+/// one gather list (header, payload, header, payload, ...) suitable for
+/// writev().
+///
+/// @see SRS-SVC-002.3
+
+#include "cgs/foundation/types.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace cgs::service {
+
+/// One multiplexed connection from the gateway to a backend service.
+///
+/// Frame: [4-byte length][8-byte session id][2-byte opcode][payload], in
+/// network byte order, where the length covers the whole frame.
+///
+/// Example:
+/// @code
+///   ServiceLink link([&](std::span<const std::span<const uint8_t>> chunks) {
+///       socket.writev(chunks);
+///   });
+///   link.forward(sessionId, opcode, receivedPayload);  // no copy
+///   link.flush();  // before the receive buffer is reused
+///
+///   link.receive(bytesFromBackend, [&](SessionId sid, uint16_t op, auto payload) {
+///       sendToClient(sid, op, payload);
+///   });
+/// @endcode
+class ServiceLink {
+public:
+    /// Bytes of frame header ahead of each payload.
+    static constexpr std::size_t kHeaderSize = 14;
+
+    /// Largest frame receive() accepts.
+    static constexpr std::size_t kMaxFrameSize = 16u * 1024u * 1024u;
+
+    /// Writes one batch of chunks to the backend connection, in order.
+    using Writer = std::function<void(std::span<const std::span<const uint8_t>> chunks)>;
+
+    /// Receives one frame from the backend.  The payload view is valid
+    /// only during the call.
+    using Receiver = std::function<void(
+        cgs::foundation::SessionId sessionId, uint16_t opcode, std::span<const uint8_t> payload)>;
+
+    explicit ServiceLink(Writer writer);
+
+    ServiceLink(const ServiceLink&) = delete;
+    ServiceLink& operator=(const ServiceLink&) = delete;
+
+    /// Queue a frame for @p sessionId.  @p payload is referenced and must
+    /// stay valid until the next flush().
+    void forward(cgs::foundation::SessionId sessionId,
+                 uint16_t opcode,
+                 std::span<const uint8_t> payload);
+
+    /// Hand the queued frames to the writer as one gather list.
+    /// Returns the number of frames written.
+    std::size_t flush();
+
+    /// Parse @p bytes read from the backend and pass each complete frame
+    /// to @p onFrame; a partial frame is kept for the next call.  Returns
+    /// false, discarding buffered input, on a malformed frame.
+    bool receive(std::span<const uint8_t> bytes, const Receiver& onFrame);
+
+    /// Frames queued but not yet flushed.
+    [[nodiscard]] std::size_t pendingFrames() const;
+
+    /// Frames handed to the writer so far.
+    [[nodiscard]] uint64_t framesForwarded() const;
+
+private:
+    using Header = std::array<uint8_t, kHeaderSize>;
+
+    // Parse whole frames at the front of @p bytes; returns bytes consumed,
+    // or kMalformed.
+    static std::size_t parse(std::span<const uint8_t> bytes, const Receiver& onFrame);
+    static constexpr std::size_t kMalformed = static_cast<std::size_t>(-1);
+
+    Writer writer_;
+
+    mutable std::mutex sendMutex_;
+    std::vector<Header> headers_;
+    std::vector<std::span<const uint8_t>> payloads_;
+    std::vector<std::span<const uint8_t>> chunks_;  // reused by flush()
+    uint64_t framesForwarded_ = 0;
+
+    std::mutex receiveMutex_;
+    std::vector<uint8_t> partial_;  // start of a frame split across receives
+};
+
+}  // namespace cgs::service
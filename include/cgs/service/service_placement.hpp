@@ -0,0 +1,119 @@
+#pragma once
+
+/// @file service_placement.hpp
+/// @brief Weighted rendezvous-hash placement of keys onto backend nodes.
+///
+/// Gateways and the lobby use ServicePlacement to pick a backend for a
+/// player, session or map so that the same key keeps landing on the same
+/// node (warm caches) and a node joining or leaving moves only about 1/N
+/// of the keys.  Every replica configured with the same nodes places a
+/// key identically, so independent gateways agree without coordination.
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cgs::service {
+
+/// Dense id of a node, assigned by ServicePlacement::addNode() in order.
+using PlacementNodeId = uint32_t;
+
+/// Whether a node accepts new keys.
+enum class PlacementNodeState : uint8_t {
+    /// Receives its weighted share of keys.
+    Active,
+    /// Receives no keys; existing owners move off it (see place()).
+    Draining
+};
+
+/// A node as configured on a ServicePlacement.
+struct PlacementNode {
+    PlacementNodeId id = 0;
+    std::string name;
+    double weight = 1.0;
+    PlacementNodeState state = PlacementNodeState::Active;
+};
+
+/// Weighted rendezvous (highest random weight) hashing.
+///
+/// Each node scores a key as weight / -ln(u), where u is a uniform hash of
+/// the key and the node's name; the highest score wins.  A node's share of
+/// keys is proportional to its weight, and changing one node only moves
+/// keys to or from that node.  Draining a node hands its keys to the nodes
+/// that would own them without it, so a later removal moves nothing.
+///
+/// Example:
+/// @code
+///   ServicePlacement shards;
+///   auto a = shards.addNode("game-1");
+///   shards.addNode("game-2", 2.0);           // twice the share
+///
+///   auto node = shards.place(playerId);      // stable for playerId
+///   shards.setState(a, PlacementNodeState::Draining);
+///   // Keys on game-1 now place on game-2; nothing else moves.
+/// @endcode
+///
+/// Thread-safe; place() takes a shared lock and scores every node, so it
+/// suits the tens of nodes a service tier has, not thousands.
+class ServicePlacement {
+public:
+    ServicePlacement() = default;
+
+    ServicePlacement(const ServicePlacement&) = delete;
+    ServicePlacement& operator=(const ServicePlacement&) = delete;
+
+    /// Add a node.  Returns its id, or std::nullopt if the name is taken
+    /// or the weight is not positive.
+    std::optional<PlacementNodeId> addNode(std::string name, double weight = 1.0);
+
+    /// Remove a node.  Its id is not reused.  Returns false if unknown.
+    bool removeNode(PlacementNodeId id);
+
+    /// Change a node's weight (must be positive).  Returns false if the
+    /// node is unknown or the weight invalid.
+    bool setWeight(PlacementNodeId id, double weight);
+
+    /// Mark a node active or draining.  Returns false if unknown.
+    bool setState(PlacementNodeId id, PlacementNodeState state);
+
+    /// Node owning @p key, or std::nullopt if no node is active.
+    [[nodiscard]] std::optional<PlacementNodeId> place(uint64_t key) const;
+
+    /// Node owning a string key (e.g. a map name).
+    [[nodiscard]] std::optional<PlacementNodeId> place(std::string_view key) const;
+
+    /// Id of the node named @p name, if present.
+    [[nodiscard]] std::optional<PlacementNodeId> find(std::string_view name) const;
+
+    /// Snapshot of a node, if present.
+    [[nodiscard]] std::optional<PlacementNode> node(PlacementNodeId id) const;
+
+    /// Snapshot of all nodes, in id order.
+    [[nodiscard]] std::vector<PlacementNode> nodes() const;
+
+    /// Number of nodes, active or draining.
+    [[nodiscard]] std::size_t size() const;
+
+    /// Stable 64-bit hash of a string key, identical on every replica.
+    [[nodiscard]] static uint64_t hashKey(std::string_view key) noexcept;
+
+private:
+    struct Entry {
+        PlacementNode node;
+        uint64_t seed = 0;  // hashKey(name): scores do not depend on ids
+        bool removed = false;
+    };
+
+    // Caller holds mutex_.
+    Entry* findLocked(PlacementNodeId id);
+
+    mutable std::shared_mutex mutex_;
+    std::vector<Entry> entries_;  // by PlacementNodeId
+    std::size_t live_ = 0;
+};
+
+}  // namespace cgs::service
@@ -3,21 +3,26 @@
 /// @file service_runner.hpp
 /// @brief Shared utilities for service entry points.
 ///
-/// Provides signal handling, configuration loading, graceful shutdown
-/// coordination, and CLI argument parsing for all CGS service executables.
+/// Provides signal handling, configuration loading, startup and graceful
+/// shutdown coordination, and CLI argument parsing for all CGS service
+/// executables.
 
 #include "cgs/foundation/config_manager.hpp"
 #include "cgs/foundation/game_result.hpp"
 
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <filesystem>
 #include <functional>
+#include <string>
 #include <string_view>
 #include <vector>
 
 namespace cgs::service {
 
+class HealthServer;
+
 /// Installs SIGINT and SIGTERM handlers and exposes a shutdown flag.
 ///
 /// Only one SignalHandler instance should exist per process.
@@ -45,6 +50,84 @@ private:
     static void handler(int signal);
 };
 
+/// Startup stage callback type.
+using StartupTask = std::function<cgs::foundation::GameResult<void>()>;
+
+/// What a StartupGraph stage does.
+enum class StartupStageKind : uint8_t {
+    /// Brings up a subsystem the service cannot run without; a failure
+    /// aborts startup and skips the stages that depend on it.
+    Subsystem,
+    /// Warms a subsystem up (cache preload, pool pre-fill); a failure is
+    /// logged and its dependents still run.
+    Warmup,
+};
+
+/// Outcome of one StartupGraph stage.
+struct StartupStageResult {
+    enum class Status : uint8_t { NotRun, Succeeded, Failed, Skipped };
+
+    std::string name;
+    StartupStageKind kind = StartupStageKind::Subsystem;
+    Status status = Status::NotRun;
+    std::chrono::steady_clock::duration duration{};
+};
+
+/// Brings a service up as a dependency graph of stages.
+///
+/// Each stage starts on its own thread as soon as the stages it depends
+/// on are done, so independent subsystems (DB pool, cache, listeners)
+/// come up concurrently.  Readiness is reported only after every stage,
+/// warm-up included, has finished.
+///
+/// Usage:
+/// @code
+///   StartupGraph startup;
+///   startup.addStage("health", [&] { return health.start(); });
+///   startup.addStage("db_pool", [&] { return pool.connect(); });
+///   startup.addStage("cache", [&] { return cache.start(); });
+///   startup.addWarmup("templates", [&] { return loadTemplates(); }, {"db_pool"});
+///   startup.addStage("listeners", [&] { return server.listen(); }, {"db_pool", "cache"});
+///   auto result = startup.run(&health);  // setReady(true) on success
+/// @endcode
+class StartupGraph {
+public:
+    /// Add a subsystem stage that runs after @p dependsOn.
+    void addStage(std::string name, StartupTask task, std::vector<std::string> dependsOn = {});
+
+    /// Add a warm-up stage that runs after @p dependsOn.
+    void addWarmup(std::string name, StartupTask task, std::vector<std::string> dependsOn = {});
+
+    /// Run all stages and wait for them.
+    ///
+    /// On success, calls `health->setReady(true)` if @p health is given.
+    ///
+    /// @return InvalidArgument for a duplicate name, an unknown dependency
+    ///         or a cycle (nothing runs); otherwise the error of the first
+    ///         subsystem stage that failed.
+    [[nodiscard]] cgs::foundation::GameResult<void> run(HealthServer* health = nullptr);
+
+    /// Per-stage outcomes of the last run(), in registration order.
+    [[nodiscard]] const std::vector<StartupStageResult>& results() const;
+
+    /// Get the number of registered stages.
+    [[nodiscard]] std::size_t stageCount() const;
+
+private:
+    struct Stage {
+        std::string name;
+        StartupStageKind kind;
+        StartupTask task;
+        std::vector<std::string> dependsOn;
+    };
+
+    /// Dependency indices per stage, or an error for an invalid graph.
+    cgs::foundation::GameResult<std::vector<std::vector<std::size_t>>> resolve() const;
+
+    std::vector<Stage> stages_;
+    std::vector<StartupStageResult> results_;
+};
+
 /// Shutdown hook callback type.
 ///
 /// Each hook receives a name for logging and a callable.
@@ -71,6 +154,9 @@ using ShutdownHook = std::function<void()>;
 ///   // On signal:
 ///   shutdown.execute();
 /// @endcode
+///
+/// Hooks added with addConcurrentHook() next to each other form a group
+/// that drains in parallel, e.g. independent listeners and backend links.
 class GracefulShutdown {
 public:
     /// Add a named shutdown hook.
@@ -78,9 +164,14 @@ public:
     /// Hooks execute in registration order during shutdown.
     void addHook(std::string name, ShutdownHook hook);
 
+    /// Add a named hook that runs in parallel with the concurrent hooks
+    /// registered right before or after it.
+    void addConcurrentHook(std::string name, ShutdownHook hook);
+
     /// Execute all registered hooks in order.
     ///
-    /// Each hook is given up to the configured timeout.
+    /// Each hook or concurrent group is started only while the drain
+    /// timeout has not passed; a group waits for all of its hooks.
     /// Errors in one hook do not prevent subsequent hooks from running.
     void execute();
 
@@ -94,6 +185,7 @@ private:
     struct Hook {
         std::string name;
         ShutdownHook callback;
+        bool concurrent = false;
     };
     std::vector<Hook> hooks_;
     std::chrono::seconds drainTimeout_{30};
@@ -0,0 +1,159 @@
+#pragma once
+
+/// @file shared_result_cache.hpp
+/// @brief Second-level query result cache shared by all dbproxy instances.
+///
+/// Each DBProxyServer keeps its own QueryCache (L1).  A SharedResultCache
+/// (L2) sits behind it in a key-value store every instance reaches
+/// (Redis, memcached), so a result fetched by one instance serves the
+/// others' L1 misses, after a deploy as well.  Results are stored in a
+/// compact binary encoding (encodeQueryResult()).
+///
+/// Writes do not delete L2 entries.  Each table has a version counter in
+/// the store, bumped by invalidateTable(); an entry records the versions
+/// of the tables it read and is served only while they are all current.
+/// Reading the versions and the entry is one getMany() round trip.
+///
+/// @see SRS-SVC-005.3
+/// @see SDS-MOD-034
+
+#include "cgs/foundation/game_database.hpp"
+#include "cgs/service/dbproxy_types.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace cgs::service {
+
+/// Key-value store behind the shared cache: the subset of Redis and
+/// memcached commands it needs.
+///
+/// Implementations must be thread-safe.  A store that cannot reach its
+/// server reports keys as missing and increments as 0; the cache then
+/// only misses.
+class ISharedResultStore {
+public:
+    virtual ~ISharedResultStore() = default;
+
+    /// Values of @p keys, in order; nullopt for a missing or expired key
+    /// (MGET).
+    [[nodiscard]] virtual std::vector<std::optional<std::string>> getMany(
+        const std::vector<std::string>& keys) = 0;
+
+    /// Store @p value under @p key for @p ttl (SET key value EX ttl).
+    virtual void set(const std::string& key, std::string value, std::chrono::seconds ttl) = 0;
+
+    /// Increment the counter @p key, created at 0, and return its new
+    /// value (INCR).  Counters do not expire.
+    virtual uint64_t increment(const std::string& key) = 0;
+};
+
+/// Thread-safe in-process store for testing and single-host development.
+///
+/// Production deployments share a networked store between instances.
+class InMemorySharedResultStore : public ISharedResultStore {
+public:
+    [[nodiscard]] std::vector<std::optional<std::string>> getMany(
+        const std::vector<std::string>& keys) override;
+
+    void set(const std::string& key, std::string value, std::chrono::seconds ttl) override;
+
+    uint64_t increment(const std::string& key) override;
+
+    /// Number of stored keys, expired values included until looked up.
+    [[nodiscard]] std::size_t size() const;
+
+private:
+    /// A value or, like Redis, a counter stored as its decimal text.
+    struct Value {
+        std::string data;
+        std::chrono::steady_clock::time_point expiresAt;
+    };
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Value> values_;
+};
+
+/// Encode @p result compactly: column names once, then each column's
+/// cells as a type byte and a varint (zigzag for integers), 8-byte
+/// double, 1-byte bool or length-prefixed string.
+[[nodiscard]] std::string encodeQueryResult(const cgs::foundation::QueryResult& result);
+
+/// Decode encodeQueryResult() output; nullopt if @p bytes is malformed.
+[[nodiscard]] std::optional<cgs::foundation::QueryResult> decodeQueryResult(
+    std::string_view bytes);
+
+/// L2 query result cache over an ISharedResultStore.
+///
+/// Usage:
+/// @code
+///   SharedResultCache l2(config.sharedCache, store);
+///   auto lookup = l2.lookup(sql);
+///   if (!lookup.result) {
+///       auto fetched = db.query(sql);
+///       l2.put(sql, lookup.stamp, fetched.value());  // May run later
+///   }
+///   l2.invalidateTable("items");  // On write to items, on any instance
+/// @endcode
+class SharedResultCache {
+public:
+    /// Result of lookup().
+    struct Lookup {
+        std::optional<cgs::foundation::QueryResult> result;  ///< Set on a hit.
+
+        /// Table versions seen by the lookup; a put() after a miss passes
+        /// them back, so a result read before a concurrent write is
+        /// stamped as stale.
+        std::string stamp;
+    };
+
+    SharedResultCache(SharedCacheConfig config, std::shared_ptr<ISharedResultStore> store);
+
+    /// Look up @p sql (a SELECT), current with the versions of the tables
+    /// it reads.
+    [[nodiscard]] Lookup lookup(std::string_view sql);
+
+    /// Store @p result for @p sql under the @p stamp of its lookup().
+    /// Results over SharedCacheConfig::maxValueSizeBytes are skipped.
+    void put(std::string_view sql, std::string_view stamp,
+             const cgs::foundation::QueryResult& result);
+
+    /// Bump @p table's version, retiring every entry that read it on all
+    /// instances.
+    void invalidateTable(std::string_view table);
+
+    [[nodiscard]] uint64_t hitCount() const noexcept;
+    [[nodiscard]] uint64_t missCount() const noexcept;
+
+    /// Entries found but stamped with outdated table versions (also
+    /// counted as misses).
+    [[nodiscard]] uint64_t staleCount() const noexcept;
+
+    /// Results written to the store.
+    [[nodiscard]] uint64_t putCount() const noexcept;
+
+    [[nodiscard]] const SharedCacheConfig& config() const noexcept;
+
+private:
+    [[nodiscard]] std::string entryKey(std::string_view sql) const;
+    [[nodiscard]] std::string versionKey(std::string_view table) const;
+
+    SharedCacheConfig config_;
+    std::shared_ptr<ISharedResultStore> store_;
+
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> stale_{0};
+    std::atomic<uint64_t> puts_{0};
+};
+
+}  // namespace cgs::service
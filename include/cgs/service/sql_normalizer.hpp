@@ -0,0 +1,58 @@
+#pragma once
+
+/// @file sql_normalizer.hpp
+/// @brief SQL normalization into a query shape, fingerprint and literals.
+///
+/// Queries that differ only in literal values share a shape: DBProxyServer
+/// keys its cache on the canonical text, keeps count and latency per
+/// shape, and can run parameterizable reads as server-side prepared
+/// statements reused across values.
+///
+/// @see SRS-SVC-005.2, SRS-SVC-005.3
+/// @see SDS-MOD-034
+
+#include "cgs/foundation/game_database.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cgs::service {
+
+/// A statement split into its shape and literal values.
+///
+/// Tokens are separated canonically: comments are dropped, whitespace
+/// runs become one space (none around `(`, `)`, `,`, `.` and `::`), and
+/// unquoted words are lowercased.  String and numeric literals (with a
+/// folded unary minus) become `$_1`, `$_2`, ... in shape and parameters;
+/// text keeps them, so equal text means an equal query.
+///
+/// SQL the normalizer does not model (E'' and other prefixed strings,
+/// dollar quoting, non-ASCII outside quotes, malformed literals) is left
+/// opaque: shape and text are the input, without parameters.
+struct NormalizedSql {
+    std::string shape;             ///< Canonical SQL, literals as $_N placeholders.
+    std::string text;              ///< Canonical SQL, literals kept (cache key).
+    uint64_t fingerprint = 0;      ///< Hash of shape.
+    bool read = false;             ///< A SELECT.
+    bool parameterizable = false;  ///< Every literal is a value operand.
+    bool opaque = false;           ///< Not normalized (see above).
+
+    /// Literal values in order of appearance: strings, int64 or double.
+    std::vector<cgs::foundation::DbValue> parameters;
+
+    /// shape as a PreparedStatement with parameters bound.
+    [[nodiscard]] cgs::foundation::PreparedStatement statement() const;
+};
+
+/// Normalize @p sql.
+///
+/// A literal is a value operand when it follows a comparison operator,
+/// LIKE/ILIKE, LIMIT or OFFSET, or is an element of an IN list.  Anywhere
+/// else (select lists, ORDER BY positions, typed literals like DATE '...')
+/// binding it could change the query, so parameterizable is false.  SQL
+/// that already contains $ placeholders is never parameterizable.
+[[nodiscard]] NormalizedSql normalizeSql(std::string_view sql);
+
+}  // namespace cgs::service
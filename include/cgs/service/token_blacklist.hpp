@@ -5,35 +5,66 @@
 ///
 /// Maintains a set of revoked JWT IDs (jti) to prevent use of
 /// compromised or logged-out access tokens before their natural expiry.
-/// Thread-safe with std::shared_mutex for read-heavy workloads.
+/// A lock-free Bloom filter answers the common "not revoked" case; only
+/// filter hits take the shared lock.  Revocations replicate between auth
+/// and gateway nodes as fixed-size records.
 ///
 /// @see SRS-NFR-014
 
+#include "cgs/foundation/signal.hpp"
+
+#include <atomic>
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <shared_mutex>
-#include <string>
+#include <span>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 namespace cgs::service {
 
 /// In-memory access token blacklist keyed by JWT ID (jti).
 ///
 /// Tokens are automatically removed after their expiry time,
-/// preventing unbounded memory growth.
+/// preventing unbounded memory growth.  Entries are grouped by expiry
+/// second, so cleanup drops whole groups instead of scanning every entry.
+///
+/// A jti is stored as a 128-bit digest with its expiry, which is also its
+/// replication record (kRecordSize bytes): forward onReplicate payloads
+/// to peers and apply them there with merge(); a node joining late loads
+/// exportRecords() from a peer.
 ///
 /// Example:
 /// @code
 ///   TokenBlacklist blacklist(std::chrono::seconds{300});
 ///   blacklist.revoke("token-jti-123", expiresAt);
 ///   assert(blacklist.isRevoked("token-jti-123"));
+///
+///   blacklist.onReplicate.connect([&](std::span<const uint8_t> record) {
+///       peers.broadcast(record);
+///   });
+///   // On a peer:
+///   peerBlacklist.merge(receivedRecords);
 /// @endcode
 class TokenBlacklist {
 public:
-    /// Construct with the interval between automatic cleanup passes.
-    explicit TokenBlacklist(std::chrono::seconds cleanupInterval);
+    /// Bytes per replication record: 16-byte digest, 8-byte expiry.
+    static constexpr std::size_t kRecordSize = 24;
+
+    /// Construct with the interval between automatic cleanup passes and
+    /// the Bloom filter size in bits (rounded up to a power of two).
+    explicit TokenBlacklist(std::chrono::seconds cleanupInterval,
+                            std::size_t filterBits = std::size_t{1} << 20);
+
+    ~TokenBlacklist();
+
+    TokenBlacklist(const TokenBlacklist&) = delete;
+    TokenBlacklist& operator=(const TokenBlacklist&) = delete;
 
     /// Add a token to the blacklist.
     ///
@@ -41,7 +72,8 @@ public:
     /// @param expiresAt When the token naturally expires (for auto-cleanup).
     void revoke(std::string_view jti, std::chrono::system_clock::time_point expiresAt);
 
-    /// Check if a token is blacklisted.
+    /// Check if a token is blacklisted.  Lock-free unless the filter
+    /// reports a possible match.
     [[nodiscard]] bool isRevoked(std::string_view jti) const;
 
     /// Remove entries whose expiry has passed. Returns number removed.
@@ -50,9 +82,76 @@ public:
     /// Number of entries currently in the blacklist.
     [[nodiscard]] std::size_t size() const;
 
+    /// Records of every unexpired entry, concatenated.
+    [[nodiscard]] std::vector<uint8_t> exportRecords() const;
+
+    /// Add the entries in @p records (from onReplicate or exportRecords()
+    /// on another node), skipping expired and known ones and any trailing
+    /// partial record.  Returns the number added.
+    std::size_t merge(std::span<const uint8_t> records);
+
+    /// Emitted with the jti after revoke() adds it, outside the lock
+    /// (e.g. to drop cached verifications of the token).
+    cgs::foundation::Signal<std::string_view> onRevoked;
+
+    /// Emitted with the record of each entry revoke() adds, outside the
+    /// lock, for replication.  merge() does not emit it.
+    cgs::foundation::Signal<std::span<const uint8_t>> onReplicate;
+
 private:
+    struct Digest {
+        uint64_t high = 0;
+        uint64_t low = 0;
+        friend bool operator==(const Digest&, const Digest&) = default;
+    };
+
+    struct DigestHash {
+        std::size_t operator()(const Digest& d) const noexcept {
+            return static_cast<std::size_t>(d.high ^ (d.low >> 7));
+        }
+    };
+
+    // Bloom filter over digests; bits are only ever set while published.
+    struct Filter {
+        explicit Filter(std::size_t bits);
+        void add(const Digest& d) noexcept;
+        [[nodiscard]] bool mayContain(const Digest& d) const noexcept;
+
+        std::unique_ptr<std::atomic<uint64_t>[]> words;
+        uint64_t mask;  // bit count - 1
+    };
+
+    // Open while isRevoked() reads the published filter; filters replaced
+    // by cleanup are freed only once no guard is open.
+    struct ReadGuard {
+        explicit ReadGuard(std::atomic<uint32_t>& counter) : readers(counter) {
+            readers.fetch_add(1);
+        }
+        ~ReadGuard() { readers.fetch_sub(1); }
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+        std::atomic<uint32_t>& readers;
+    };
+
+    [[nodiscard]] static Digest digestOf(std::string_view jti) noexcept;
+
+    // Add an entry expiring at @p expiry (unix seconds, rounded up).
+    // Returns false if already present.  Caller holds mutex_ exclusively.
+    bool insertLocked(const Digest& digest, int64_t expiry);
+
+    // Drop groups expired by @p now; republish a rebuilt filter if any
+    // entry went.  Caller holds mutex_ exclusively.
+    std::size_t cleanupLocked(std::chrono::system_clock::time_point now);
+
     mutable std::shared_mutex mutex_;
-    std::unordered_map<std::string, std::chrono::system_clock::time_point> entries_;
+    std::unordered_map<Digest, int64_t, DigestHash> entries_;  // -> expiry
+    std::map<int64_t, std::vector<Digest>> byExpiry_;
+
+    std::size_t filterBits_;
+    std::atomic<Filter*> filter_{nullptr};
+    mutable std::atomic<uint32_t> readers_{0};
+    std::vector<std::unique_ptr<Filter>> retired_;
+
     std::chrono::seconds cleanupInterval_;
     std::chrono::system_clock::time_point lastCleanup_;
 };
@@ -3,24 +3,67 @@
 /// @file token_bucket.hpp
 /// @brief Token bucket rate limiter for per-client message throttling.
 ///
-/// Unlike the sliding-window RateLimiter used in AuthServer (which counts
-/// discrete attempts), this token bucket implementation controls sustained
+/// Unlike the RateLimiter used in AuthServer (which limits discrete
+/// login attempts), this token bucket implementation controls sustained
 /// throughput with configurable burst capacity.
 ///
 /// @see SRS-SVC-002.5
 
+#include "cgs/foundation/profiled_mutex.hpp"
+#include "cgs/foundation/types.hpp"
+#include "cgs/service/rate_limiter.hpp"
+
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <cstdint>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
 
 namespace cgs::service {
 
+/// A single lock-free token bucket.
+///
+/// The bucket state is one atomic timestamp, the time at which it will
+/// be full again (the GCRA formulation of a token bucket), so consume()
+/// is a compare-and-swap and never blocks.
+class AtomicTokenBucket {
+public:
+    /// Construct full, with capacity (max burst) and refill rate
+    /// (tokens/second; 0 never refills).
+    AtomicTokenBucket(uint32_t capacity, uint32_t refillRate);
+
+    /// Try to consume @p tokens.  Returns false, consuming nothing, if
+    /// fewer are available.
+    [[nodiscard]] bool consume(uint32_t tokens = 1) noexcept;
+
+    /// Tokens currently available.
+    [[nodiscard]] uint32_t available() const noexcept;
+
+    /// Refill to full capacity.
+    void reset() noexcept;
+
+private:
+    // Current time in bucket units (always 0 when the bucket never refills).
+    [[nodiscard]] int64_t now() const noexcept;
+
+    int64_t interval_;  // time per token, in steady_clock ticks
+    int64_t limit_;     // capacity * interval_
+    bool refills_;
+    std::atomic<int64_t> fullAt_{0};
+};
+
 /// Token bucket rate limiter for per-key message throttling.
 ///
 /// Each key (typically a session or IP) maintains a bucket that fills
-/// at a constant rate and can burst up to a configured capacity.
+/// at a constant rate and can burst up to a configured capacity.  Keys
+/// are 128-bit RateLimitKey values in a lock-sharded table: string keys
+/// are converted once per call (IP literals to their address), and
+/// callers holding a SessionId or a precomputed key skip that.  Callers
+/// on a hot path can fetch a key's bucket once with bucket() and consume
+/// from it directly, without any lock.
 ///
 /// Example:
 /// @code
@@ -28,6 +71,9 @@ namespace cgs::service {
 ///   if (bucket.consume("session-1")) {
 ///       // Message allowed
 ///   }
+///   if (bucket.consume(sessionId)) {
+///       // Same, keyed by integer
+///   }
 /// @endcode
 class TokenBucket {
 public:
@@ -41,27 +87,52 @@ public:
     /// Try to consume N tokens for the given key.
     [[nodiscard]] bool consume(const std::string& key, uint32_t tokens);
 
+    /// Try to consume N tokens for a precomputed key.
+    [[nodiscard]] bool consume(RateLimitKey key, uint32_t tokens = 1);
+
+    /// Try to consume N tokens for a session.
+    [[nodiscard]] bool consume(cgs::foundation::SessionId sessionId, uint32_t tokens = 1);
+
     /// Get current available tokens for the given key.
     [[nodiscard]] uint32_t available(const std::string& key) const;
 
+    /// Get current available tokens for a precomputed key.
+    [[nodiscard]] uint32_t available(RateLimitKey key) const;
+
+    /// The bucket of @p key, created full if the key is new.  It stays
+    /// shared with consume(key) until the key is removed.
+    [[nodiscard]] std::shared_ptr<AtomicTokenBucket> bucket(const std::string& key);
+
+    /// The bucket of a precomputed key.
+    [[nodiscard]] std::shared_ptr<AtomicTokenBucket> bucket(RateLimitKey key);
+
     /// Remove tracking for the given key (e.g., on disconnect).
     void remove(const std::string& key);
 
+    /// Remove tracking for a precomputed key.
+    void remove(RateLimitKey key);
+
     /// Reset a key's bucket to full capacity.
     void reset(const std::string& key);
 
+    /// Key of a session.  Session keys lie outside the IPv6 unicast
+    /// range, so they never share a bucket with an address key.
+    [[nodiscard]] static RateLimitKey sessionKey(cgs::foundation::SessionId sessionId) noexcept;
+
 private:
-    struct Bucket {
-        double tokens;
-        std::chrono::steady_clock::time_point lastRefill;
+    static constexpr std::size_t kShards = 16;
+
+    struct Shard {
+        cgs::foundation::ProfiledMutex mutex{"gateway.token_buckets"};
+        std::unordered_map<RateLimitKey, std::shared_ptr<AtomicTokenBucket>, RateLimitKeyHash>
+            buckets;
     };
 
-    void refill(Bucket& bucket) const;
+    Shard& shardFor(const RateLimitKey& key) const;
 
     uint32_t capacity_;
     uint32_t refillRate_;
-    mutable std::mutex mutex_;
-    mutable std::unordered_map<std::string, Bucket> buckets_;
+    mutable std::array<Shard, kShards> shards_;
 };
 
 }  // namespace cgs::service
@@ -0,0 +1,79 @@
+#pragma once
+
+/// @file token_cache.hpp
+/// @brief Cache of verified access-token claims.
+///
+/// Lets AuthServer skip JWT parsing and signature verification for a token
+/// it has already verified, e.g. when clients reconnect after a gateway
+/// restart.  Entries expire with the token's `exp` and are invalidated by
+/// jti when the token is revoked.
+///
+/// @see SRS-NFR-014
+
+#include "cgs/service/auth_types.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace cgs::service {
+
+/// Verified claims keyed by the SHA-256 digest of the token.
+///
+/// Thread-safe with std::shared_mutex for read-heavy workloads.  When full,
+/// insert() first drops expired entries and then arbitrary ones.
+///
+/// Example:
+/// @code
+///   VerifiedTokenCache cache(65536);
+///   cache.insert(token, claims);             // after verifying token
+///   if (auto hit = cache.find(token)) { ... }
+///   cache.invalidate(claims.jti);            // on revocation
+/// @endcode
+class VerifiedTokenCache {
+public:
+    /// Construct holding at most @p capacity tokens.
+    explicit VerifiedTokenCache(std::size_t capacity);
+
+    /// Claims of a cached, unexpired token.
+    [[nodiscard]] std::optional<TokenClaims> find(std::string_view token) const;
+
+    /// Cache the claims of a verified token until its expiry.
+    void insert(std::string_view token, const TokenClaims& claims);
+
+    /// Drop the token with JWT ID @p jti, if cached.
+    void invalidate(std::string_view jti);
+
+    /// Drop every entry.
+    void clear();
+
+    /// Number of cached tokens.
+    [[nodiscard]] std::size_t size() const;
+
+private:
+    using Digest = std::array<uint8_t, 32>;
+
+    struct DigestHash {
+        std::size_t operator()(const Digest& digest) const noexcept {
+            std::size_t value = 0;
+            std::memcpy(&value, digest.data(), sizeof(value));
+            return value;
+        }
+    };
+
+    // Drop expired entries.  Caller holds the unique lock.
+    void purgeExpiredLocked();
+
+    std::size_t capacity_;
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<Digest, TokenClaims, DigestHash> entries_;
+    std::unordered_map<std::string, Digest> byJti_;
+};
+
+}  // namespace cgs::service
@@ -14,6 +14,7 @@
 #include "cgs/foundation/game_result.hpp"
 #include "cgs/service/auth_types.hpp"
 
+#include <memory>
 #include <string>
 #include <string_view>
 
@@ -26,6 +27,10 @@ class TokenBlacklist;
 /// Access tokens are signed JWTs containing user claims.
 /// Refresh tokens are opaque secure-random hex strings.
 ///
+/// Keys are prepared at construction (HMAC pads hashed, RSA PEMs parsed),
+/// and validation works on views of the token with stack buffers, so a
+/// typical validation allocates only the returned claims.
+///
 /// Example (HS256, backward-compatible):
 /// @code
 ///   AuthConfig config;
@@ -70,9 +75,10 @@ public:
     [[nodiscard]] static std::string generateRefreshToken();
 
 private:
-    std::string signingKey_;
-    std::string rsaPrivateKeyPem_;
-    std::string rsaPublicKeyPem_;
+    /// HMAC key schedule and parsed RSA keys, prepared once.
+    struct Keys;
+
+    std::shared_ptr<const Keys> keys_;
     JwtAlgorithm algorithm_;
     TokenBlacklist* blacklist_ = nullptr;
 };
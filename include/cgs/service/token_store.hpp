@@ -11,12 +11,20 @@
 
 #include "cgs/service/auth_types.hpp"
 
+#include <array>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <optional>
+#include <queue>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 namespace cgs::service {
 
@@ -45,9 +53,20 @@ public:
 
 /// Thread-safe in-memory refresh token store for testing and development.
 ///
+/// Tokens are keyed by their SHA-256 digest, so the store holds no token
+/// strings; find() returns the record with the token it was asked for.
+/// The store is split into shards, each with its own lock, chosen by the
+/// digest, so concurrent auth workers rarely contend.  Each shard also
+/// indexes its tokens by user and keeps them in a min-heap by expiry:
+/// revokeAllForUser() touches only that user's tokens, and
+/// removeExpired() only the expired and revoked ones.
+///
 /// Production deployments should use a persistent store (Redis, database).
 class InMemoryTokenStore : public ITokenStore {
 public:
+    /// Construct with @p shards independently locked shards (at least 1).
+    explicit InMemoryTokenStore(std::size_t shards = 16);
+
     void store(RefreshTokenRecord record) override;
 
     [[nodiscard]] std::optional<RefreshTokenRecord> find(std::string_view token) const override;
@@ -58,9 +77,52 @@ public:
 
     void removeExpired() override;
 
+    /// Number of stored tokens, revoked ones included until removed.
+    [[nodiscard]] std::size_t size() const;
+
 private:
-    mutable std::mutex mutex_;
-    std::unordered_map<std::string, RefreshTokenRecord> tokens_;
+    using Clock = std::chrono::system_clock;
+    using Digest = std::array<uint8_t, 32>;
+
+    struct DigestHash {
+        std::size_t operator()(const Digest& digest) const noexcept {
+            std::size_t value = 0;
+            std::memcpy(&value, digest.data(), sizeof(value));
+            return value;
+        }
+    };
+
+    struct Entry {
+        uint64_t userId = 0;
+        Clock::time_point expiresAt{};
+        bool revoked = false;
+    };
+
+    /// Expiry-heap node; stale once its token is gone or re-stored.
+    struct Expiry {
+        Clock::time_point expiresAt;
+        Digest digest;
+
+        bool operator>(const Expiry& other) const noexcept {
+            return expiresAt > other.expiresAt;
+        }
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<Digest, Entry, DigestHash> tokens;
+        std::unordered_map<uint64_t, std::vector<Digest>> byUser;
+        std::priority_queue<Expiry, std::vector<Expiry>, std::greater<>> byExpiry;
+        std::vector<Digest> revoked;  ///< Revoked since the last removeExpired().
+    };
+
+    [[nodiscard]] Shard& shardFor(const Digest& digest) const;
+
+    // Caller holds the shard lock.
+    static void eraseLocked(Shard& shard, const Digest& digest);
+
+    std::unique_ptr<Shard[]> shards_;
+    std::size_t shardCount_;
 };
 
 }  // namespace cgs::service
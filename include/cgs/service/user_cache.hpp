@@ -0,0 +1,179 @@
+#pragma once
+
+/// @file user_cache.hpp
+/// @brief Read-through user cache in front of an IUserRepository.
+///
+/// Keeps recently read users in process, indexed by id, username and
+/// email, so logins and token refreshes are served without a database
+/// round trip.  Misses on username and email are cached too, for a
+/// shorter time, so availability checks during registration stay cheap.
+/// Writes go through to the backing repository and invalidate the cache
+/// here and, via onInvalidate, on the other auth nodes.
+///
+/// @see SRS-SVC-001.1
+/// @see SRS-SVC-001.2
+
+#include "cgs/foundation/signal.hpp"
+#include "cgs/service/user_repository.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace cgs::service {
+
+/// Configuration for a CachedUserRepository.
+struct UserCacheConfig {
+    /// Users held at most.
+    std::size_t capacity = 100000;
+
+    /// How long a cached user is served without reading it again.
+    std::chrono::seconds ttl{300};
+
+    /// Usernames and emails known to be free, held at most (each).
+    std::size_t negativeCapacity = 100000;
+
+    /// How long "no such username/email" is served.
+    std::chrono::seconds negativeTtl{30};
+};
+
+/// IUserRepository decorator that caches reads of another repository.
+///
+/// Thread-safe with std::shared_mutex; hits take the shared lock and copy
+/// the record out of a shared immutable one.  When full, a fill first
+/// drops expired entries and then arbitrary ones.  A read that races a
+/// write is not cached, so a fill never brings back a value the write
+/// replaced.
+///
+/// Invalidation records (user id, username and email) are emitted by
+/// create() and update() for replication; apply them on peers with
+/// applyInvalidation().
+///
+/// Example:
+/// @code
+///   auto users = std::make_shared<CachedUserRepository>(
+///       std::make_shared<SqlUserRepository>(backend));
+///   users->onInvalidate.connect([&](std::span<const uint8_t> record) {
+///       peers.broadcast(record);
+///   });
+///   // On a peer:
+///   peerUsers->applyInvalidation(receivedRecord);
+/// @endcode
+class CachedUserRepository : public IUserRepository {
+public:
+    explicit CachedUserRepository(std::shared_ptr<IUserRepository> backing,
+                                  UserCacheConfig config = {});
+
+    [[nodiscard]] std::optional<UserRecord> findById(uint64_t id) const override;
+
+    [[nodiscard]] std::optional<UserRecord> findByUsername(
+        std::string_view username) const override;
+
+    [[nodiscard]] std::optional<UserRecord> findByEmail(std::string_view email) const override;
+
+    uint64_t create(UserRecord record) override;
+
+    bool update(const UserRecord& record) override;
+
+    [[nodiscard]] cgs::foundation::GameResult<std::optional<UserRecord>> lookupByUsername(
+        std::string_view username) const override;
+
+    [[nodiscard]] cgs::foundation::GameResult<std::optional<UserRecord>> lookupByEmail(
+        std::string_view email) const override;
+
+    /// Drop user @p id and any negative entry for @p username / @p email.
+    void invalidate(uint64_t id, std::string_view username = {}, std::string_view email = {});
+
+    /// Apply an onInvalidate record from another node.  Returns false if
+    /// the record is malformed.
+    bool applyInvalidation(std::span<const uint8_t> record);
+
+    /// Drop every entry.
+    void clear();
+
+    /// Emitted after create() or update() with an invalidation record
+    /// for the other nodes, outside the lock.
+    cgs::foundation::Signal<std::span<const uint8_t>> onInvalidate;
+
+    // ── Statistics ───────────────────────────────────────────────────────
+
+    /// Cached users.
+    [[nodiscard]] std::size_t size() const;
+
+    /// Reads answered from the cache (including negative entries).
+    [[nodiscard]] uint64_t hitCount() const;
+
+    /// Reads passed to the backing repository.
+    [[nodiscard]] uint64_t missCount() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct StringHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view s) const noexcept {
+            return std::hash<std::string_view>{}(s);
+        }
+    };
+
+    template <typename V>
+    using StringMap = std::unordered_map<std::string, V, StringHash, std::equal_to<>>;
+
+    struct Entry {
+        std::shared_ptr<const UserRecord> user;
+        Clock::time_point expires;
+    };
+
+    /// Which secondary index a lookup uses.
+    enum class Key : uint8_t { Username, Email };
+
+    /// Cached answer for @p value: a user, "none" (negative), or nullopt
+    /// if not cached.
+    std::optional<std::shared_ptr<const UserRecord>> findCached(Key key,
+                                                                std::string_view value) const;
+
+    cgs::foundation::GameResult<std::optional<UserRecord>> lookup(Key key,
+                                                                  std::string_view value) const;
+
+    /// Cache @p user (or a negative entry for @p value if null) unless a
+    /// write happened since @p generation.
+    void fill(std::shared_ptr<const UserRecord> user,
+              Key key,
+              std::string_view value,
+              uint64_t generation) const;
+
+    // Caller holds the unique lock.
+    void eraseLocked(uint64_t id) const;
+    void makeRoomLocked(Clock::time_point now) const;
+    void dropNegativeLocked(StringMap<Clock::time_point>& negative,
+                            Clock::time_point now) const;
+
+    void publish(uint64_t id, std::string_view username, std::string_view email);
+
+    std::shared_ptr<IUserRepository> backing_;
+    UserCacheConfig config_;
+
+    mutable std::shared_mutex mutex_;
+    mutable std::unordered_map<uint64_t, Entry> byId_;
+    mutable StringMap<uint64_t> byUsername_;
+    mutable StringMap<uint64_t> byEmail_;
+    mutable StringMap<Clock::time_point> freeUsernames_;  // -> expiry
+    mutable StringMap<Clock::time_point> freeEmails_;
+
+    /// Bumped by every invalidation; fills started before it are dropped.
+    std::atomic<uint64_t> generation_{0};
+    mutable std::atomic<uint64_t> hits_{0};
+    mutable std::atomic<uint64_t> misses_{0};
+};
+
+}  // namespace cgs::service
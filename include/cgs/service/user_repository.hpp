@@ -4,16 +4,21 @@
 /// @brief User persistence interface and in-memory implementation.
 ///
 /// Abstracts user storage so the AuthServer can work with any backend
-/// (in-memory, SQL database via DatabaseAdapter, etc.).
+/// (in-memory, SQL database via DBProxyServer or GameDatabase, etc.).
 ///
 /// @see SRS-SVC-001.1
 /// @see SRS-SVC-001.2
 
+#include "cgs/foundation/game_database.hpp"
+#include "cgs/foundation/game_result.hpp"
+#include "cgs/foundation/query_result.hpp"
 #include "cgs/service/auth_types.hpp"
 
 #include <cstdint>
+#include <functional>
 #include <mutex>
 #include <optional>
+#include <string>
 #include <string_view>
 #include <unordered_map>
 
@@ -41,6 +46,15 @@ public:
 
     /// Update an existing user record. Returns false if user not found.
     virtual bool update(const UserRecord& record) = 0;
+
+    /// findByUsername() that tells a missing user (nullopt) from a failed
+    /// read (error).  The default wraps findByUsername().
+    [[nodiscard]] virtual cgs::foundation::GameResult<std::optional<UserRecord>>
+    lookupByUsername(std::string_view username) const;
+
+    /// findByEmail() that tells a missing user from a failed read.
+    [[nodiscard]] virtual cgs::foundation::GameResult<std::optional<UserRecord>> lookupByEmail(
+        std::string_view email) const;
 };
 
 /// Thread-safe in-memory user repository for testing and development.
@@ -65,4 +79,68 @@ private:
     uint64_t nextId_ = 1;
 };
 
+/// Runs the statements of a SqlUserRepository.
+///
+/// Bind these to a DBProxyServer (query/execute with one session id, so
+/// that a read after a write goes to the primary) or a GameDatabase.
+struct UserStoreBackend {
+    /// Run a SELECT.
+    std::function<cgs::foundation::GameResult<cgs::foundation::QueryResult>(
+        const cgs::foundation::PreparedStatement&)>
+        query;
+
+    /// Run an INSERT/UPDATE; returns the affected row count.
+    std::function<cgs::foundation::GameResult<uint64_t>(const cgs::foundation::PreparedStatement&)>
+        execute;
+};
+
+/// User repository backed by a SQL `users` table.
+///
+/// Expected schema:
+/// @code
+///   CREATE TABLE users (
+///       id BIGSERIAL PRIMARY KEY,
+///       username TEXT NOT NULL UNIQUE,
+///       email TEXT NOT NULL UNIQUE,
+///       password_hash TEXT NOT NULL,
+///       salt TEXT NOT NULL,
+///       status INTEGER NOT NULL,
+///       roles TEXT NOT NULL,        -- comma-separated
+///       created_at BIGINT NOT NULL, -- ms since the Unix epoch
+///       updated_at BIGINT NOT NULL
+///   );
+/// @endcode
+///
+/// Every call is a round trip; wrap it in a CachedUserRepository.  The
+/// find*() methods return nullopt when the read fails; create() returns
+/// 0 when the insert fails (e.g. a duplicate username).
+class SqlUserRepository : public IUserRepository {
+public:
+    explicit SqlUserRepository(UserStoreBackend backend);
+
+    [[nodiscard]] std::optional<UserRecord> findById(uint64_t id) const override;
+
+    [[nodiscard]] std::optional<UserRecord> findByUsername(
+        std::string_view username) const override;
+
+    [[nodiscard]] std::optional<UserRecord> findByEmail(std::string_view email) const override;
+
+    uint64_t create(UserRecord record) override;
+
+    bool update(const UserRecord& record) override;
+
+    [[nodiscard]] cgs::foundation::GameResult<std::optional<UserRecord>> lookupByUsername(
+        std::string_view username) const override;
+
+    [[nodiscard]] cgs::foundation::GameResult<std::optional<UserRecord>> lookupByEmail(
+        std::string_view email) const override;
+
+private:
+    /// Run @p stmt and decode its first row, if any.
+    cgs::foundation::GameResult<std::optional<UserRecord>> fetchOne(
+        const cgs::foundation::PreparedStatement& stmt) const;
+
+    UserStoreBackend backend_;
+};
+
 }  // namespace cgs::service
@@ -0,0 +1,78 @@
+#pragma once
+
+/// @file write_combiner.hpp
+/// @brief Group commit of concurrent small writes.
+///
+/// Persistence sends many small, independent upserts per second, each in
+/// its own implicit transaction.  WriteCombiner lets writes that arrive
+/// within a short window share one transaction on one connection, while
+/// every caller still gets its own result.
+///
+/// @see SRS-SVC-005.2
+/// @see SDS-MOD-034
+
+#include "cgs/foundation/game_result.hpp"
+#include "cgs/service/dbproxy_types.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cgs::service {
+
+/// Combines concurrent writes into groups committed together.
+///
+/// The first write of a group leads: it waits up to
+/// WriteBatchConfig::window for others to join (or until the group holds
+/// WriteBatchConfig::maxStatements), closes the group and hands all its
+/// statements to the commit function, which returns one result per
+/// statement.  Writes arriving meanwhile start the next group.  No thread
+/// is added: leaders commit on their own thread, and the others block
+/// until their group is committed.
+///
+/// Usage:
+/// @code
+///   WriteCombiner writes(config.writeBatch, [&](const auto& statements) {
+///       return commitInOneTransaction(statements);
+///   });
+///
+///   auto affected = writes.execute("UPDATE players SET gold = 10 WHERE id = 7");
+/// @endcode
+class WriteCombiner {
+public:
+    using Result = cgs::foundation::GameResult<uint64_t>;
+    using Commit = std::function<std::vector<Result>(const std::vector<std::string>&)>;
+
+    /// @param commit Runs a group's statements and returns their results
+    ///               in order; called with a single statement for a write
+    ///               that found no company.
+    WriteCombiner(WriteBatchConfig config, Commit commit);
+    ~WriteCombiner();
+
+    WriteCombiner(const WriteCombiner&) = delete;
+    WriteCombiner& operator=(const WriteCombiner&) = delete;
+    WriteCombiner(WriteCombiner&&) noexcept;
+    WriteCombiner& operator=(WriteCombiner&&) noexcept;
+
+    /// Run @p sql as part of a group; returns once the group is committed.
+    [[nodiscard]] Result execute(std::string_view sql);
+
+    /// Groups committed with more than one statement.
+    [[nodiscard]] uint64_t groupCount() const;
+
+    /// Statements committed in those groups.
+    [[nodiscard]] uint64_t combinedCount() const;
+
+    /// Whether @p sql may share a transaction: a single INSERT, UPDATE or
+    /// DELETE (no ';' but a trailing one).
+    [[nodiscard]] static bool combinable(std::string_view sql);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace cgs::service
@@ -0,0 +1,97 @@
+/// @file command_buffer.cpp
+/// @brief Per-thread command buffer bookkeeping and playback.
+
+#include "cgs/ecs/command_buffer.hpp"
+
+#include "cgs/ecs/entity_manager.hpp"
+
+#include <algorithm>
+#include <functional>
+
+namespace cgs::ecs {
+
+CommandBuffer& CommandBufferSet::Local() {
+    const auto self = std::this_thread::get_id();
+    std::lock_guard lock(mutex_);
+
+    for (const auto& entry : active_) {
+        if (entry.thread == self) {
+            return *entry.buffer;
+        }
+    }
+
+    std::unique_ptr<CommandBuffer> buffer;
+    if (!idle_.empty()) {
+        buffer = std::move(idle_.back());
+        idle_.pop_back();
+    } else {
+        buffer = std::make_unique<CommandBuffer>();
+    }
+    auto& ref = *buffer;
+    active_.push_back(ThreadBuffer{self, std::move(buffer)});
+    return ref;
+}
+
+void CommandBufferSet::Playback() {
+    std::lock_guard lock(mutex_);
+    if (active_.empty()) {
+        return;
+    }
+
+    // 1. Creations: one block per buffer so pending indices resolve to
+    //    created_[base + index].
+    created_.clear();
+    bases_.clear();
+    for (const auto& entry : active_) {
+        bases_.push_back(created_.size());
+        entities_->CreateMany(entry.buffer->creates_, created_);
+    }
+
+    // 2. Component commands, grouped by storage.  The stable sort keeps
+    //    recording order among commands on the same storage.
+    resolved_.clear();
+    for (std::size_t b = 0; b < active_.size(); ++b) {
+        for (const auto& command : active_[b].buffer->commands_) {
+            const Entity target = command.pending == CommandBuffer::kNotPending
+                                      ? command.entity
+                                      : created_[bases_[b] + command.pending];
+            if (entities_->IsAlive(target)) {
+                resolved_.push_back(ResolvedCommand{&command, target});
+            }
+        }
+    }
+    std::stable_sort(resolved_.begin(), resolved_.end(),
+                     [](const ResolvedCommand& lhs, const ResolvedCommand& rhs) {
+                         return std::less<>()(lhs.command->storage, rhs.command->storage);
+                     });
+    for (const auto& [command, target] : resolved_) {
+        if (command->op == CommandBuffer::Op::Add) {
+            command->payloads->Apply(command->slot, target);
+        } else {
+            command->storage->Remove(target);
+        }
+    }
+
+    // 3. Destructions, batched across all buffers.
+    destroyed_.clear();
+    for (const auto& entry : active_) {
+        destroyed_.insert(destroyed_.end(), entry.buffer->destroys_.begin(),
+                          entry.buffer->destroys_.end());
+    }
+    entities_->DestroyMany(destroyed_);
+
+    for (auto& entry : active_) {
+        entry.buffer->Clear();
+        idle_.push_back(std::move(entry.buffer));
+    }
+    active_.clear();
+    resolved_.clear();
+}
+
+bool CommandBufferSet::Empty() const {
+    std::lock_guard lock(mutex_);
+    return std::all_of(active_.begin(), active_.end(),
+                       [](const ThreadBuffer& entry) { return entry.buffer->Empty(); });
+}
+
+}  // namespace cgs::ecs
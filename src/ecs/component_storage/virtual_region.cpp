@@ -0,0 +1,174 @@
+/// @file virtual_region.cpp
+/// @brief VirtualRegion over mmap/mprotect (POSIX), and an always-empty
+///        region elsewhere.
+
+#include "cgs/ecs/virtual_region.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CGS_HAS_VIRTUAL_REGION 1
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace cgs::ecs {
+
+namespace {
+
+std::size_t roundUp(std::size_t value, std::size_t granularity) {
+    return (value + granularity - 1) / granularity * granularity;
+}
+
+}  // namespace
+
+VirtualRegion::~VirtualRegion() {
+    Release();
+}
+
+VirtualRegion::VirtualRegion(VirtualRegion&& other) noexcept
+    : base_(std::exchange(other.base_, nullptr)),
+      reserved_(std::exchange(other.reserved_, 0)),
+      committed_(std::exchange(other.committed_, 0)),
+      explicitBytes_(std::exchange(other.explicitBytes_, 0)),
+      backing_(other.backing_),
+      explicitExhausted_(other.explicitExhausted_) {}
+
+VirtualRegion& VirtualRegion::operator=(VirtualRegion&& other) noexcept {
+    if (this != &other) {
+        Release();
+        base_ = std::exchange(other.base_, nullptr);
+        reserved_ = std::exchange(other.reserved_, 0);
+        committed_ = std::exchange(other.committed_, 0);
+        explicitBytes_ = std::exchange(other.explicitBytes_, 0);
+        backing_ = other.backing_;
+        explicitExhausted_ = other.explicitExhausted_;
+    }
+    return *this;
+}
+
+#if defined(CGS_HAS_VIRTUAL_REGION)
+
+bool VirtualRegion::Reserve(std::size_t bytes, PageBacking backing) {
+    Release();
+    if (bytes == 0) {
+        return false;
+    }
+    const std::size_t size = roundUp(bytes, kHugePageSize);
+    // Over-reserve by one huge page and trim, so the region starts on a
+    // huge page boundary; otherwise no page of it could be a huge one.
+    const std::size_t span = size + kHugePageSize;
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#if defined(MAP_NORESERVE)
+    flags |= MAP_NORESERVE;
+#endif
+    void* mapping = ::mmap(nullptr, span, PROT_NONE, flags, -1, 0);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    auto* raw = static_cast<std::byte*>(mapping);
+    const auto address = reinterpret_cast<std::uintptr_t>(raw);
+    const std::size_t head = roundUp(address, kHugePageSize) - address;
+    if (head > 0) {
+        ::munmap(raw, head);
+    }
+    ::munmap(raw + head + size, kHugePageSize - head);
+    base_ = raw + head;
+    reserved_ = size;
+    backing_ = backing;
+    return true;
+}
+
+bool VirtualRegion::Commit(std::size_t bytes) {
+    if (bytes <= committed_) {
+        return true;
+    }
+    if (base_ == nullptr || bytes > reserved_) {
+        return false;
+    }
+    const std::size_t granularity = backing_ == PageBacking::Default
+                                        ? static_cast<std::size_t>(::sysconf(_SC_PAGESIZE))
+                                        : kHugePageSize;
+    const std::size_t target = std::min(roundUp(bytes, granularity), reserved_);
+    std::byte* start = base_ + committed_;
+    const std::size_t length = target - committed_;
+
+#if defined(MAP_HUGETLB)
+    if (backing_ == PageBacking::Explicit && !explicitExhausted_) {
+        void* mapping = ::mmap(start, length, PROT_READ | PROT_WRITE,
+                               MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED | MAP_HUGETLB, -1, 0);
+        if (mapping != MAP_FAILED) {
+            committed_ = target;
+            explicitBytes_ += length;
+            return true;
+        }
+        // The hugetlb pool is empty (or absent): use transparent pages
+        // from here on.  A failed MAP_FIXED may have dropped the
+        // reservation, so remap the range instead of changing protection.
+        explicitExhausted_ = true;
+        mapping = ::mmap(start, length, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0);
+        if (mapping == MAP_FAILED) {
+            return false;
+        }
+    } else
+#endif
+    {
+        if (::mprotect(start, length, PROT_READ | PROT_WRITE) != 0) {
+            return false;
+        }
+    }
+#if defined(MADV_HUGEPAGE)
+    if (backing_ != PageBacking::Default) {
+        (void)::madvise(start, length, MADV_HUGEPAGE);
+    }
+#endif
+    committed_ = target;
+    return true;
+}
+
+void VirtualRegion::Release() noexcept {
+    if (base_ != nullptr) {
+        ::munmap(base_, reserved_);
+    }
+    base_ = nullptr;
+    reserved_ = 0;
+    committed_ = 0;
+    explicitBytes_ = 0;
+    explicitExhausted_ = false;
+}
+
+#else  // !CGS_HAS_VIRTUAL_REGION
+
+bool VirtualRegion::Reserve(std::size_t bytes, PageBacking backing) {
+    (void)bytes;
+    (void)backing;
+    return false;
+}
+
+bool VirtualRegion::Commit(std::size_t bytes) {
+    return bytes <= committed_;
+}
+
+void VirtualRegion::Release() noexcept {}
+
+#endif
+
+bool TransparentHugePagesAvailable() {
+#if defined(__linux__)
+    // The active mode is bracketed: "always [madvise] never".
+    std::ifstream mode("/sys/kernel/mm/transparent_hugepage/enabled");
+    std::string word;
+    while (mode >> word) {
+        if (word == "[always]" || word == "[madvise]") {
+            return true;
+        }
+    }
+#endif
+    return false;
+}
+
+}  // namespace cgs::ecs
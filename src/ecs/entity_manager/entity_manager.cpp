@@ -11,7 +11,7 @@ namespace cgs::ecs {
 
 Entity EntityManager::Create() {
     uint32_t index = 0;
-    uint8_t version = 0;
+    Entity::Version version = 0;
 
     if (!freeList_.empty()) {
         // Recycle the oldest destroyed index (FIFO).
@@ -32,6 +32,33 @@ Entity EntityManager::Create() {
     return Entity(index, version);
 }
 
+void EntityManager::CreateMany(std::size_t count, std::vector<Entity>& out) {
+    out.reserve(out.size() + count);
+
+    // Recycle a block from the head of the FIFO free list.
+    const std::size_t recycled = std::min(count, freeList_.size());
+    for (std::size_t i = 0; i < recycled; ++i) {
+        const uint32_t index = freeList_[i];
+        alive_[index] = true;
+        out.emplace_back(index, versions_[index]);
+    }
+    freeList_.erase(freeList_.begin(),
+                    freeList_.begin() + static_cast<std::ptrdiff_t>(recycled));
+
+    // Allocate the remainder as fresh indices.
+    const std::size_t first = versions_.size();
+    const std::size_t fresh = count - recycled;
+    assert(first + fresh <= static_cast<std::size_t>(Entity::kMaxId) + 1 &&
+           "Entity index space exhausted");
+    versions_.resize(first + fresh, 0);
+    alive_.resize(first + fresh, true);
+    for (std::size_t i = 0; i < fresh; ++i) {
+        out.emplace_back(static_cast<uint32_t>(first + i), Entity::Version{0});
+    }
+
+    count_ += count;
+}
+
 void EntityManager::Destroy(Entity entity) {
     if (!IsAlive(entity)) {
         return;
@@ -39,6 +66,33 @@ void EntityManager::Destroy(Entity entity) {
     destroyInternal(entity);
 }
 
+void EntityManager::DestroyMany(std::span<const Entity> entities) {
+    std::vector<Entity> batch;
+    batch.reserve(entities.size());
+    for (const Entity entity : entities) {
+        if (IsAlive(entity)) {
+            // Mark dead now so duplicates in the input are skipped.
+            alive_[entity.id()] = false;
+            batch.push_back(entity);
+        }
+    }
+    if (batch.empty()) {
+        return;
+    }
+
+    for (auto* storage : storages_) {
+        storage->RemoveMany(batch);
+    }
+
+    freeList_.reserve(freeList_.size() + batch.size());
+    for (const Entity entity : batch) {
+        const auto idx = entity.id();
+        versions_[idx] = static_cast<Entity::Version>(versions_[idx] + 1);
+        freeList_.push_back(idx);
+    }
+    count_ -= batch.size();
+}
+
 void EntityManager::DestroyDeferred(Entity entity) {
     if (!IsAlive(entity)) {
         return;
@@ -48,15 +102,11 @@ void EntityManager::DestroyDeferred(Entity entity) {
 
 void EntityManager::FlushDeferred() {
     // Process a copy so that entities destroyed between queueing and
-    // flushing are silently skipped (IsAlive check in destroyInternal).
+    // flushing are silently skipped (IsAlive check in DestroyMany).
     auto pending = std::move(pendingDestroy_);
     pendingDestroy_.clear();
 
-    for (const auto& entity : pending) {
-        if (IsAlive(entity)) {
-            destroyInternal(entity);
-        }
-    }
+    DestroyMany(pending);
 }
 
 // ── Queries ──────────────────────────────────────────────────────────
@@ -74,6 +124,13 @@ bool EntityManager::IsAlive(Entity entity) const noexcept {
     return alive_[idx] && versions_[idx] == entity.version();
 }
 
+Entity EntityManager::Resolve(uint32_t id) const noexcept {
+    if (id >= versions_.size() || !alive_[id]) {
+        return Entity::invalid();
+    }
+    return Entity(id, versions_[id]);
+}
+
 std::size_t EntityManager::Count() const noexcept {
     return count_;
 }
@@ -82,6 +139,76 @@ std::size_t EntityManager::Capacity() const noexcept {
     return versions_.size();
 }
 
+// ── Images ───────────────────────────────────────────────────────────
+
+void EntityManager::SerializeImage(std::vector<uint8_t>& out) const {
+    const std::size_t slots = versions_.size();
+    std::vector<uint64_t> aliveWords((slots + 63) / 64, 0);
+    for (std::size_t i = 0; i < slots; ++i) {
+        if (alive_[i]) {
+            aliveWords[i / 64] |= uint64_t{1} << (i % 64);
+        }
+    }
+
+    out.reserve(out.size() + sizeof(detail::DenseImageHeader) + slots * sizeof(Entity::Version) +
+                aliveWords.size() * sizeof(uint64_t) + freeList_.size() * sizeof(uint32_t));
+    detail::AppendImageValue(out, detail::DenseImageHeader{
+                                      detail::kEntityImageMagic,
+                                      static_cast<uint32_t>(sizeof(Entity::Version)),
+                                      static_cast<uint32_t>(slots),
+                                      static_cast<uint32_t>(freeList_.size())});
+    detail::AppendImageBytes(out, std::span<const Entity::Version>(versions_));
+    detail::AppendImageBytes(out, std::span<const uint64_t>(aliveWords));
+    detail::AppendImageBytes(out, std::span<const uint32_t>(freeList_));
+}
+
+bool EntityManager::DeserializeImage(std::span<const uint8_t> image) {
+    detail::ImageReader reader(image);
+    detail::DenseImageHeader header;
+    if (!reader.Read(header) || header.magic != detail::kEntityImageMagic ||
+        header.elementSize != sizeof(Entity::Version) ||
+        header.count > static_cast<std::size_t>(Entity::kMaxId) + 1 ||
+        header.extra > header.count) {
+        return false;
+    }
+
+    const std::size_t slots = header.count;
+    std::vector<Entity::Version> versions(slots);
+    std::vector<uint64_t> aliveWords((slots + 63) / 64);
+    std::vector<uint32_t> freeList(header.extra);
+    if (!reader.Read(std::span<Entity::Version>(versions)) ||
+        !reader.Read(std::span<uint64_t>(aliveWords)) ||
+        !reader.Read(std::span<uint32_t>(freeList)) || reader.Remaining() != 0) {
+        return false;
+    }
+
+    std::vector<bool> alive(slots);
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < slots; ++i) {
+        alive[i] = ((aliveWords[i / 64] >> (i % 64)) & 1u) != 0;
+        count += alive[i] ? 1u : 0u;
+    }
+
+    // Every dead slot is on the free list exactly once.
+    if (freeList.size() != slots - count) {
+        return false;
+    }
+    std::vector<bool> listed(slots);
+    for (const uint32_t index : freeList) {
+        if (index >= slots || alive[index] || listed[index]) {
+            return false;
+        }
+        listed[index] = true;
+    }
+
+    versions_ = std::move(versions);
+    alive_ = std::move(alive);
+    freeList_ = std::move(freeList);
+    pendingDestroy_.clear();
+    count_ = count;
+    return true;
+}
+
 // ── Component storage registration ───────────────────────────────────
 
 void EntityManager::RegisterStorage(IComponentStorage* storage) {
@@ -102,16 +229,11 @@ void EntityManager::destroyInternal(Entity entity) {
     // Mark the slot as dead and increment version for recycling.
     alive_[idx] = false;
 
-    // Increment version, wrapping at 255 → 0.
-    // Version 0xFF is reserved as part of the invalid sentinel
-    // (kInvalidRaw = 0xFFFFFFFF), so we wrap 0xFF → 0.
-    auto nextVersion = static_cast<uint8_t>(versions_[idx] + 1);
-    // If the version wraps to 0xFF (which combined with kMaxId+1
-    // would equal kInvalidRaw), skip to 0.  In practice, index
-    // values never equal kIdMask (0x00FFFFFF) because kMaxId is
-    // kIdMask - 1, so 0xFF is safe for normal indices.  However,
-    // being defensive about the sentinel costs nothing.
-    versions_[idx] = nextVersion;
+    // Increment version, wrapping at the top of Entity::Version → 0
+    // (after 256 recycles in the compact layout, 2^32 in the wide one).
+    // The all-ones version is only part of the invalid sentinel together
+    // with index kIdMask, which kMaxId excludes, so it is safe to hand out.
+    versions_[idx] = static_cast<Entity::Version>(versions_[idx] + 1);
 
     freeList_.push_back(idx);
     --count_;
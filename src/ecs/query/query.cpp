@@ -1,12 +1,97 @@
 /// @file query.cpp
-/// @brief Anchor translation unit for the Query module (SDS-MOD-013).
+/// @brief Query cache subscriptions and process-wide cache counters
+///        (SDS-MOD-013).
 ///
-/// Query<...> is fully template-based and implemented in the header.
-/// This file exists to provide a library target for the build system
-/// and to anchor the module in the linker.
+/// Query<...> itself is template-based and implemented in the header.
 
 #include "cgs/ecs/query.hpp"
 
+#include <atomic>
+
 namespace cgs::ecs {
-// Intentionally empty — all Query logic is in the header template.
+
+namespace {
+
+/// Changes a subscription may queue beyond the pool's size before the
+/// cache is rebuilt instead of patched.
+constexpr std::size_t kPendingSlack = 64;
+
+std::atomic<uint64_t> gQueryRebuilds{0};
+std::atomic<uint64_t> gQueryPatches{0};
+
+}  // namespace
+
+namespace detail {
+
+// ── CacheSubscription ───────────────────────────────────────────────────
+
+void CacheSubscription::queue(Entity entity) {
+    if (stale_) {
+        return;
+    }
+    if (pending_.size() > storage_->Size() + kPendingSlack) {
+        stale_ = true;
+        pending_.clear();
+        return;
+    }
+    pending_.push_back(entity.id());
+}
+
+// ── CacheSubscriptions ──────────────────────────────────────────────────
+
+CacheSubscriptions::CacheSubscriptions(CacheSubscriptions&& other) noexcept
+    : subscriptions_(std::move(other.subscriptions_)) {
+    other.subscriptions_.clear();
+}
+
+CacheSubscriptions& CacheSubscriptions::operator=(CacheSubscriptions&& other) noexcept {
+    if (this != &other) {
+        Clear();
+        subscriptions_ = std::move(other.subscriptions_);
+        other.subscriptions_.clear();
+    }
+    return *this;
+}
+
+CacheSubscriptions::~CacheSubscriptions() {
+    Clear();
+}
+
+bool CacheSubscriptions::Subscribe(const IComponentStorage& storage) {
+    auto subscription = std::make_unique<CacheSubscription>(storage);
+    if (!storage.AddListener(subscription.get())) {
+        return false;
+    }
+    subscriptions_.push_back(std::move(subscription));
+    return true;
+}
+
+void CacheSubscriptions::Clear() noexcept {
+    for (const auto& subscription : subscriptions_) {
+        subscription->Storage().RemoveListener(subscription.get());
+    }
+    subscriptions_.clear();
+}
+
+void CacheSubscriptions::DrainAll() noexcept {
+    for (const auto& subscription : subscriptions_) {
+        subscription->Drain();
+    }
+}
+
+void RecordQueryRebuild() noexcept {
+    gQueryRebuilds.fetch_add(1, std::memory_order_relaxed);
+}
+
+void RecordQueryPatch() noexcept {
+    gQueryPatches.fetch_add(1, std::memory_order_relaxed);
+}
+
+}  // namespace detail
+
+QueryCacheStats GetQueryCacheStats() noexcept {
+    return QueryCacheStats{gQueryRebuilds.load(std::memory_order_relaxed),
+                           gQueryPatches.load(std::memory_order_relaxed)};
+}
+
 }  // namespace cgs::ecs
@@ -0,0 +1,66 @@
+/// @file event_channel.cpp
+/// @brief Per-thread buffer registry of event channels.
+
+#include "cgs/ecs/event_channel.hpp"
+
+#include <array>
+#include <atomic>
+
+namespace cgs::ecs {
+
+namespace {
+
+/// Source of channel instance ids (never reused, see LocalChannelCache).
+std::atomic<uint64_t> gNextChannelId{1};
+
+/// Direct-mapped cache of this thread's buffers, indexed by channel id,
+/// so a system sending to a few channels does not thrash a single slot.
+struct LocalChannelCache {
+    static constexpr std::size_t kSlots = 16;
+
+    struct Slot {
+        uint64_t channel = 0;
+        detail::EventBuffer* buffer = nullptr;
+    };
+
+    std::array<Slot, kSlots> slots{};
+};
+
+thread_local LocalChannelCache tLocalChannels;
+
+}  // namespace
+
+IEventChannel::IEventChannel()
+    : instanceId_(gNextChannelId.fetch_add(1, std::memory_order_relaxed)) {}
+
+IEventChannel::~IEventChannel() = default;
+
+std::size_t IEventChannel::BufferCount() const {
+    std::lock_guard lock(mutex_);
+    return buffers_.size();
+}
+
+detail::EventBuffer& IEventChannel::localBuffer() {
+    auto& slot = tLocalChannels.slots[instanceId_ % LocalChannelCache::kSlots];
+    if (slot.channel == instanceId_) {
+        return *slot.buffer;
+    }
+
+    const auto self = std::this_thread::get_id();
+    std::lock_guard lock(mutex_);
+    detail::EventBuffer* buffer = nullptr;
+    for (const auto& entry : buffers_) {
+        if (entry.thread == self) {
+            buffer = entry.buffer.get();
+            break;
+        }
+    }
+    if (buffer == nullptr) {
+        buffers_.push_back(ThreadBuffer{self, makeBuffer()});
+        buffer = buffers_.back().buffer.get();
+    }
+    slot = LocalChannelCache::Slot{instanceId_, buffer};
+    return *buffer;
+}
+
+}  // namespace cgs::ecs
@@ -0,0 +1,169 @@
+/// @file frame_arena.cpp
+/// @brief Chained-block frame arena and per-thread arena set.
+
+#include "cgs/ecs/frame_arena.hpp"
+
+#include <algorithm>
+
+namespace cgs::ecs {
+
+namespace {
+
+/// Source of FrameArenaSet instance ids (never reused, see LocalArenaCache).
+std::atomic<uint64_t> gNextArenaSetId{1};
+
+/// Arena of the most recently used set on this thread.
+struct LocalArenaCache {
+    uint64_t set = 0;
+    FrameArena* arena = nullptr;
+};
+
+thread_local LocalArenaCache tLocalArena;
+
+}  // namespace
+
+// ── FrameArena ──────────────────────────────────────────────────────────
+
+FrameArena::FrameArena(std::size_t initialBlockSize)
+    : nextBlockSize_(std::max<std::size_t>(initialBlockSize, 64)) {}
+
+FrameArena::FrameArena(std::size_t initialBlockSize, std::size_t reserveBytes,
+                       PageBacking backing)
+    : FrameArena(initialBlockSize) {
+    if (reserveBytes > 0) {
+        (void)region_.Reserve(reserveBytes, backing);
+    }
+}
+
+std::size_t FrameArena::Capacity() const noexcept {
+    std::size_t total = region_.Committed();
+    for (const auto& block : blocks_) {
+        total += block.size;
+    }
+    return total;
+}
+
+void FrameArena::addBlock(std::size_t minimumSize) {
+    const std::size_t size = std::max(nextBlockSize_, minimumSize);
+    blocks_.push_back(Block{std::make_unique<std::byte[]>(size), size});
+    nextBlockSize_ = size * 2;
+}
+
+void* FrameArena::allocateFromRegion(std::size_t bytes, std::size_t alignment) {
+    const auto base = reinterpret_cast<std::uintptr_t>(region_.Data());
+    const auto aligned = ((base + regionOffset_ + alignment - 1) & ~(alignment - 1)) - base;
+    if (aligned + bytes > region_.Reserved() || !region_.Commit(aligned + bytes)) {
+        return nullptr;
+    }
+    used_ += aligned + bytes - regionOffset_;
+    regionOffset_ = aligned + bytes;
+    return region_.Data() + aligned;
+}
+
+void* FrameArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    if (region_.IsReserved()) {
+        if (void* ptr = allocateFromRegion(bytes, alignment)) {
+            return ptr;
+        }
+    }
+    for (;;) {
+        if (current_ < blocks_.size()) {
+            auto& block = blocks_[current_];
+            const auto base = reinterpret_cast<std::uintptr_t>(block.data.get());
+            const auto aligned = ((base + offset_ + alignment - 1) & ~(alignment - 1)) - base;
+            if (aligned + bytes <= block.size) {
+                used_ += aligned + bytes - offset_;
+                offset_ = aligned + bytes;
+                return block.data.get() + aligned;
+            }
+            // Spill into the next retained block, or grow the chain.
+            used_ += block.size - offset_;
+            ++current_;
+            offset_ = 0;
+            continue;
+        }
+        addBlock(bytes + alignment);
+    }
+}
+
+void FrameArena::Reset() {
+    highWater_ = std::max(highWater_, used_);
+    regionOffset_ = 0;
+    if (region_.IsReserved()) {
+        // Blocks only hold what a tick put past the reservation.
+        blocks_.clear();
+    } else if (blocks_.size() > 1) {
+        // The tick outgrew the first block: keep one block that fits it.
+        blocks_.clear();
+        nextBlockSize_ = highWater_;
+        addBlock(highWater_);
+    }
+    current_ = 0;
+    offset_ = 0;
+    used_ = 0;
+}
+
+// ── FrameArenaSet ───────────────────────────────────────────────────────
+
+FrameArenaSet::FrameArenaSet()
+    : instanceId_(gNextArenaSetId.fetch_add(1, std::memory_order_relaxed)) {}
+
+std::pmr::memory_resource* FrameArenaSet::Resource() {
+    if (!IsActive()) {
+        return std::pmr::get_default_resource();
+    }
+    return &Local();
+}
+
+FrameArena& FrameArenaSet::Local() {
+    if (tLocalArena.set == instanceId_) {
+        return *tLocalArena.arena;
+    }
+
+    const auto self = std::this_thread::get_id();
+    std::lock_guard lock(mutex_);
+    FrameArena* arena = nullptr;
+    for (const auto& entry : arenas_) {
+        if (entry.thread == self) {
+            arena = entry.arena.get();
+            break;
+        }
+    }
+    if (arena == nullptr) {
+        arenas_.push_back(ThreadArena{
+            self, std::make_unique<FrameArena>(FrameArena::kDefaultBlockSize, reservation_,
+                                               backing_)});
+        arena = arenas_.back().arena.get();
+    }
+    tLocalArena = LocalArenaCache{instanceId_, arena};
+    return *arena;
+}
+
+void FrameArenaSet::SetReservation(std::size_t bytesPerThread, PageBacking backing) {
+    std::lock_guard lock(mutex_);
+    reservation_ = bytesPerThread;
+    backing_ = backing;
+}
+
+void FrameArenaSet::ResetAll() {
+    std::lock_guard lock(mutex_);
+    for (auto& entry : arenas_) {
+        entry.arena->Reset();
+    }
+}
+
+std::size_t FrameArenaSet::HighWaterMark() const {
+    std::lock_guard lock(mutex_);
+    std::size_t total = 0;
+    for (const auto& entry : arenas_) {
+        total += entry.arena->HighWaterMark();
+    }
+    return total;
+}
+
+std::size_t FrameArenaSet::ArenaCount() const {
+    std::lock_guard lock(mutex_);
+    return arenas_.size();
+}
+
+}  // namespace cgs::ecs
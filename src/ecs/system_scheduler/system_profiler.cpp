@@ -0,0 +1,310 @@
+/// @file system_profiler.cpp
+/// @brief Per-thread timing rings, Chrome trace export and percentiles.
+
+#include "cgs/ecs/system_profiler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <utility>
+
+namespace cgs::ecs {
+
+namespace {
+
+/// Source of SystemProfiler instance ids.  Ids are never reused, so a
+/// thread's cached ring cannot be mistaken for one of a newer profiler
+/// allocated at the same address.
+std::atomic<uint64_t> gNextProfilerId{1};
+
+/// Ring of the most recently used profiler on this thread.
+struct LocalRingCache {
+    uint64_t profiler = 0;
+    void* ring = nullptr;
+};
+
+thread_local LocalRingCache tLocalRing;
+
+/// Escape a string for JSON output.
+std::string jsonEscape(std::string_view s) {
+    std::string out;
+    out.reserve(s.size() + 2);
+    out.push_back('"');
+    for (char c : s) {
+        switch (c) {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\r':
+                out += "\\r";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default:
+                out.push_back(c);
+                break;
+        }
+    }
+    out.push_back('"');
+    return out;
+}
+
+/// Nanoseconds as microseconds with three decimals (trace "ts"/"dur").
+void appendMicros(std::string& out, int64_t ns) {
+    char buffer[32];
+    const int written = std::snprintf(buffer, sizeof(buffer), "%.3f",
+                                      static_cast<double>(ns) / 1000.0);
+    out.append(buffer, static_cast<std::size_t>(std::max(written, 0)));
+}
+
+const char* stageName(uint32_t stage) {
+    switch (static_cast<SystemStage>(stage)) {
+        case SystemStage::PreUpdate:
+            return "PreUpdate";
+        case SystemStage::Update:
+            return "Update";
+        case SystemStage::PostUpdate:
+            return "PostUpdate";
+        case SystemStage::FixedUpdate:
+            return "FixedUpdate";
+    }
+    return "Stage";
+}
+
+const char* scopeCategory(ProfileScope scope) {
+    switch (scope) {
+        case ProfileScope::Tick:
+            return "tick";
+        case ProfileScope::Stage:
+            return "stage";
+        case ProfileScope::Batch:
+            return "batch";
+        case ProfileScope::System:
+            return "system";
+    }
+    return "system";
+}
+
+/// Nearest-rank percentile of an ascending sample vector.
+int64_t percentile(const std::vector<int64_t>& sorted, double p) {
+    const auto rank = static_cast<std::size_t>(std::ceil(p * static_cast<double>(sorted.size())));
+    return sorted[std::min(std::max<std::size_t>(rank, 1), sorted.size()) - 1];
+}
+
+double toMs(int64_t ns) {
+    return static_cast<double>(ns) / 1'000'000.0;
+}
+
+}  // namespace
+
+SystemProfiler::SystemProfiler(std::size_t eventsPerThread)
+    : instanceId_(gNextProfilerId.fetch_add(1, std::memory_order_relaxed)),
+      eventsPerThread_(std::max<std::size_t>(eventsPerThread, 1)),
+      origin_(std::chrono::steady_clock::now()) {}
+
+int64_t SystemProfiler::Now() const noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                                origin_)
+        .count();
+}
+
+SystemProfiler::Ring& SystemProfiler::localRing() {
+    if (tLocalRing.profiler == instanceId_) {
+        return *static_cast<Ring*>(tLocalRing.ring);
+    }
+
+    const auto self = std::this_thread::get_id();
+    std::lock_guard lock(mutex_);
+    Ring* ring = nullptr;
+    for (const auto& candidate : rings_) {
+        if (candidate->owner == self) {
+            ring = candidate.get();
+            break;
+        }
+    }
+    if (ring == nullptr) {
+        rings_.push_back(std::make_unique<Ring>(eventsPerThread_,
+                                                static_cast<uint32_t>(rings_.size()), self));
+        ring = rings_.back().get();
+    }
+    tLocalRing = LocalRingCache{instanceId_, ring};
+    return *ring;
+}
+
+void SystemProfiler::Record(ProfileScope scope,
+                            uint32_t id,
+                            int64_t startNs,
+                            int64_t endNs,
+                            cgs::foundation::AllocCounts allocs) {
+    auto& ring = localRing();
+    const uint64_t head = ring.head.load(std::memory_order_relaxed);
+    auto& slot = ring.events[static_cast<std::size_t>(head % ring.capacity)];
+    slot.scope = scope;
+    slot.id = id;
+    slot.tick = tick_.load(std::memory_order_relaxed);
+    slot.startNs = startNs;
+    slot.endNs = endNs;
+    slot.thread = ring.thread;
+    slot.allocations = static_cast<uint32_t>(allocs.allocations);
+    slot.allocatedBytes = allocs.bytes;
+    // Publish the slot to readers.
+    ring.head.store(head + 1, std::memory_order_release);
+}
+
+void SystemProfiler::SetSystemName(SystemTypeId system, std::string_view name) {
+    std::lock_guard lock(mutex_);
+    names_[system] = std::string(name);
+}
+
+std::string SystemProfiler::SystemName(SystemTypeId system) const {
+    std::lock_guard lock(mutex_);
+    if (auto it = names_.find(system); it != names_.end()) {
+        return it->second;
+    }
+    return "system " + std::to_string(system);
+}
+
+std::vector<ProfileEvent> SystemProfiler::Events(std::size_t lastTicks) const {
+    std::vector<ProfileEvent> events;
+    const uint64_t current = CurrentTick();
+    if (lastTicks == 0 || current == 0) {
+        return events;
+    }
+    const uint64_t firstTick = lastTicks >= current ? 1 : current - lastTicks + 1;
+
+    {
+        std::lock_guard lock(mutex_);
+        for (const auto& ring : rings_) {
+            const uint64_t head = ring->head.load(std::memory_order_acquire);
+            const uint64_t held = std::min<uint64_t>(head, ring->capacity);
+            for (uint64_t i = head - held; i < head; ++i) {
+                const auto& event = ring->events[static_cast<std::size_t>(i % ring->capacity)];
+                if (event.tick >= firstTick) {
+                    events.push_back(event);
+                }
+            }
+        }
+    }
+
+    // Start order; enclosing spans (lower scope) first on ties.
+    std::sort(events.begin(), events.end(), [](const ProfileEvent& lhs, const ProfileEvent& rhs) {
+        if (lhs.startNs != rhs.startNs) {
+            return lhs.startNs < rhs.startNs;
+        }
+        return lhs.scope < rhs.scope;
+    });
+    return events;
+}
+
+std::string SystemProfiler::eventName(const ProfileEvent& event) const {
+    switch (event.scope) {
+        case ProfileScope::Tick:
+            return "Tick";
+        case ProfileScope::Stage:
+            return stageName(event.id);
+        case ProfileScope::Batch:
+            return "Batch " + std::to_string(event.id);
+        case ProfileScope::System:
+            return SystemName(event.id);
+    }
+    return {};
+}
+
+std::string SystemProfiler::ChromeTraceJson(std::size_t lastTicks) const {
+    const auto events = Events(lastTicks);
+    const bool tracked = cgs::foundation::AllocTracker::Installed();
+
+    std::string out = "{\"traceEvents\":[";
+    bool first = true;
+    const auto separator = [&] {
+        if (!first) {
+            out.push_back(',');
+        }
+        first = false;
+    };
+
+    // Thread name metadata so Perfetto labels the tracks.
+    uint32_t threads = 0;
+    {
+        std::lock_guard lock(mutex_);
+        threads = static_cast<uint32_t>(rings_.size());
+    }
+    for (uint32_t t = 0; t < threads; ++t) {
+        separator();
+        out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":";
+        out += std::to_string(t);
+        out += ",\"args\":{\"name\":\"ecs worker ";
+        out += std::to_string(t);
+        out += "\"}}";
+    }
+
+    for (const auto& event : events) {
+        separator();
+        out += "{\"name\":";
+        out += jsonEscape(eventName(event));
+        out += ",\"cat\":\"";
+        out += scopeCategory(event.scope);
+        out += "\",\"ph\":\"X\",\"ts\":";
+        appendMicros(out, event.startNs);
+        out += ",\"dur\":";
+        appendMicros(out, event.endNs - event.startNs);
+        out += ",\"pid\":1,\"tid\":";
+        out += std::to_string(event.thread);
+        out += ",\"args\":{\"tick\":";
+        out += std::to_string(event.tick);
+        if (tracked && event.scope == ProfileScope::System) {
+            out += ",\"allocs\":";
+            out += std::to_string(event.allocations);
+            out += ",\"allocBytes\":";
+            out += std::to_string(event.allocatedBytes);
+        }
+        out += "}}";
+    }
+
+    out += "],\"displayTimeUnit\":\"ms\"}";
+    return out;
+}
+
+std::vector<SystemTimingStats> SystemProfiler::SystemStats(std::size_t lastTicks) const {
+    std::unordered_map<SystemTypeId, std::vector<int64_t>> durations;
+    std::unordered_map<SystemTypeId, std::pair<uint64_t, uint64_t>> allocations;  // total, max
+    for (const auto& event : Events(lastTicks)) {
+        if (event.scope == ProfileScope::System) {
+            durations[event.id].push_back(event.endNs - event.startNs);
+            auto& [total, most] = allocations[event.id];
+            total += event.allocations;
+            most = std::max<uint64_t>(most, event.allocations);
+        }
+    }
+
+    std::vector<SystemTimingStats> stats;
+    stats.reserve(durations.size());
+    for (auto& [system, samples] : durations) {
+        std::sort(samples.begin(), samples.end());
+        SystemTimingStats entry;
+        entry.system = system;
+        entry.name = SystemName(system);
+        entry.samples = samples.size();
+        entry.p50Ms = toMs(percentile(samples, 0.50));
+        entry.p99Ms = toMs(percentile(samples, 0.99));
+        entry.maxMs = toMs(samples.back());
+        entry.allocations = allocations[system].first;
+        entry.maxAllocations = allocations[system].second;
+        stats.push_back(std::move(entry));
+    }
+
+    std::sort(stats.begin(), stats.end(), [](const SystemTimingStats& lhs,
+                                             const SystemTimingStats& rhs) {
+        return lhs.p99Ms != rhs.p99Ms ? lhs.p99Ms > rhs.p99Ms : lhs.system < rhs.system;
+    });
+    return stats;
+}
+
+}  // namespace cgs::ecs
@@ -6,15 +6,23 @@
 /// detected and reported with the names of the involved systems.
 ///
 /// Parallel execution groups non-conflicting systems into batches
-/// that are dispatched to a user-provided ParallelExecutor.
+/// that are dispatched to a user-provided ParallelExecutor.  Graph mode
+/// instead releases each system as soon as its predecessors finish.
 ///
 /// @see SDS-MOD-012
 
 #include "cgs/ecs/system_scheduler.hpp"
 
+#include "cgs/ecs/system_profiler.hpp"
+
 #include <algorithm>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <numeric>
 #include <queue>
 #include <sstream>
+#include <utility>
 
 namespace cgs::ecs {
 
@@ -22,38 +30,8 @@ namespace cgs::ecs {
 
 const std::vector<SystemTypeId> SystemScheduler::kEmptyOrder_;
 const std::vector<SystemScheduler::ParallelBatch> SystemScheduler::kEmptyBatches_;
-
-// ── SystemAccessInfo ────────────────────────────────────────────────────
-
-bool SystemAccessInfo::ConflictsWith(const SystemAccessInfo& other) const {
-    // Undeclared access (empty reads AND writes) conflicts with everything.
-    if ((reads.empty() && writes.empty()) || (other.reads.empty() && other.writes.empty())) {
-        return true;
-    }
-
-    // Write-write conflict.
-    for (auto w : writes) {
-        if (other.writes.count(w)) {
-            return true;
-        }
-    }
-
-    // My write conflicts with other's read.
-    for (auto w : writes) {
-        if (other.reads.count(w)) {
-            return true;
-        }
-    }
-
-    // My read conflicts with other's write.
-    for (auto r : reads) {
-        if (other.writes.count(r)) {
-            return true;
-        }
-    }
-
-    return false;
-}
+const std::vector<SystemScheduler::GraphSegment> SystemScheduler::kEmptyGraph_;
+const SystemScheduler::CriticalPath SystemScheduler::kEmptyCriticalPath_;
 
 // ── Registration ────────────────────────────────────────────────────────
 
@@ -102,12 +80,126 @@ bool SystemScheduler::IsEnabled(SystemTypeId system) const {
     return false;
 }
 
+// ── Update rates ────────────────────────────────────────────────────────
+
+void SystemScheduler::SetUpdateInterval(SystemTypeId system, uint32_t ticks) {
+    assert(ticks > 0 && "Update interval must be at least one tick");
+    if (auto it = systems_.find(system); it != systems_.end()) {
+        it->second.interval = std::max(ticks, 1u);
+        built_ = false;
+    }
+}
+
+void SystemScheduler::SetUpdateSlices(SystemTypeId system, uint32_t slices) {
+    assert(slices > 0 && "Slice count must be at least one");
+    if (auto it = systems_.find(system); it != systems_.end()) {
+        it->second.pending.assign(std::max(slices, 1u), 0.0f);
+        it->second.sliceVersions.assign(std::max(slices, 1u), kAnyVersion);
+        it->second.runs = 0;
+    }
+}
+
+uint32_t SystemScheduler::GetUpdateInterval(SystemTypeId system) const {
+    if (auto it = systems_.find(system); it != systems_.end()) {
+        return it->second.interval;
+    }
+    return 1;
+}
+
+uint32_t SystemScheduler::GetUpdatePhase(SystemTypeId system) const {
+    if (auto it = systems_.find(system); it != systems_.end()) {
+        return it->second.phase;
+    }
+    return 0;
+}
+
+void SystemScheduler::assignPhases(const std::vector<SystemTypeId>& order) {
+    // Longest cycle over which the per-execution load is balanced.
+    static constexpr uint64_t kMaxHorizon = 4096;
+
+    std::vector<SystemEntry*> decimated;
+    uint64_t horizon = 1;
+    for (auto sysId : order) {
+        auto& entry = systems_.at(sysId);
+        entry.phase = 0;
+        entry.executions = 0;
+        if (entry.interval > 1) {
+            decimated.push_back(&entry);
+            horizon = std::min(std::lcm(horizon, uint64_t{entry.interval}), kMaxHorizon);
+        }
+    }
+    if (decimated.empty()) {
+        return;
+    }
+
+    // Greedy: place the most frequent systems first, each on the phase
+    // whose executions carry the least load so far (then the least total).
+    std::stable_sort(decimated.begin(), decimated.end(),
+                     [](const SystemEntry* lhs, const SystemEntry* rhs) {
+                         return lhs->interval < rhs->interval;
+                     });
+    std::vector<uint32_t> load(static_cast<std::size_t>(horizon), 0);
+    for (auto* entry : decimated) {
+        const uint64_t interval = entry->interval;
+        uint32_t bestPhase = 0;
+        uint32_t bestPeak = std::numeric_limits<uint32_t>::max();
+        uint64_t bestTotal = std::numeric_limits<uint64_t>::max();
+        for (uint64_t phase = 0; phase < interval; ++phase) {
+            uint32_t peak = 0;
+            uint64_t total = 0;
+            for (uint64_t t = phase; t < horizon; t += interval) {
+                peak = std::max(peak, load[t]);
+                total += load[t];
+            }
+            if (peak < bestPeak || (peak == bestPeak && total < bestTotal)) {
+                bestPhase = static_cast<uint32_t>(phase);
+                bestPeak = peak;
+                bestTotal = total;
+            }
+        }
+        entry->phase = bestPhase;
+        for (uint64_t t = bestPhase; t < horizon; t += interval) {
+            ++load[t];
+        }
+    }
+}
+
+void SystemScheduler::prepareStage(SystemStage stage, float deltaTime) {
+    auto it = executionOrder_.find(stage);
+    if (it == executionOrder_.end()) {
+        return;
+    }
+    for (auto sysId : it->second) {
+        auto& entry = systems_.at(sysId);
+        const uint64_t execution = entry.executions++;
+        entry.due = false;
+        if (!entry.enabled) {
+            continue;
+        }
+        for (auto& pending : entry.pending) {
+            pending += deltaTime;
+        }
+        if (execution % entry.interval != entry.phase) {
+            continue;
+        }
+        const auto slices = static_cast<uint32_t>(entry.pending.size());
+        const auto slice = static_cast<uint32_t>(entry.runs++ % slices);
+        entry.due = true;
+        entry.slice = UpdateSlice{slice, slices};
+        entry.runDelta = std::exchange(entry.pending[slice], 0.0f);
+    }
+}
+
 // ── Build ───────────────────────────────────────────────────────────────
 
 bool SystemScheduler::Build() {
     lastError_.clear();
     executionOrder_.clear();
     parallelBatches_.clear();
+    executionGraph_.clear();
+    criticalPaths_.clear();
+    stageEventReads_.clear();
+    eventReads_ = ComponentMask{};
 
     // Process each stage independently.
     for (const auto& [stage, ids] : stageGroups_) {
@@ -117,11 +209,26 @@ bool SystemScheduler::Build() {
             return false;
         }
         executionOrder_[stage] = sorted;
+        assignPhases(sorted);
+
+        // Cache access info per system to avoid repeated virtual calls.
+        AccessCache accessCache;
+        ComponentMask stageEvents;
+        for (auto sysId : sorted) {
+            accessCache[sysId] = systems_.at(sysId).instance->GetAccessInfo();
+            stageEvents |= accessCache[sysId].eventReads;
+        }
+        stageEventReads_[stage] = stageEvents;
+        eventReads_ |= stageEvents;
 
-        // Compute parallel batches from the sorted order.
-        computeParallelBatches(stage, sorted);
+        // Compute parallel batches and the graph from the sorted order.
+        computeParallelBatches(stage, sorted, accessCache);
+        computeExecutionGraph(stage, sorted, accessCache);
     }
 
+    registerProfilerNames();
+    registerAllocTags();
+
     built_ = true;
     return true;
 }
@@ -203,7 +310,8 @@ bool SystemScheduler::topologicalSort(const std::vector<SystemTypeId>& ids,
 // ── Parallel batch computation ──────────────────────────────────────────
 
 void SystemScheduler::computeParallelBatches(SystemStage stage,
-                                             const std::vector<SystemTypeId>& order) {
+                                             const std::vector<SystemTypeId>& order,
+                                             AccessCache& accessCache) {
     auto& batches = parallelBatches_[stage];
     batches.clear();
 
@@ -216,11 +324,10 @@ void SystemScheduler::computeParallelBatches(SystemStage stage,
     // are respected.
     std::unordered_map<SystemTypeId, std::size_t> systemBatch;
 
-    // Cache access info per system to avoid repeated virtual calls.
-    std::unordered_map<SystemTypeId, SystemAccessInfo> accessCache;
-    for (auto sysId : order) {
-        accessCache[sysId] = systems_.at(sysId).instance->GetAccessInfo();
-    }
+    // Combined access of each batch.  A batch is joinable iff the new
+    // system does not conflict with the union, since an undeclared
+    // member always sits alone and leaves the union undeclared.
+    std::vector<SystemAccessInfo> batchAccess;
 
     // Minimum batch index forced by sync points.
     std::size_t minimumBatch = 0;
@@ -242,15 +349,9 @@ void SystemScheduler::computeParallelBatches(SystemStage stage,
         // Try to fit into an existing batch starting from minBatch.
         bool placed = false;
         for (std::size_t b = minBatch; b < batches.size(); ++b) {
-            bool conflicts = false;
-            for (auto otherId : batches[b].systems) {
-                if (myAccess.ConflictsWith(accessCache[otherId])) {
-                    conflicts = true;
-                    break;
-                }
-            }
-            if (!conflicts) {
+            if (batches[b].systems.empty() || !myAccess.ConflictsWith(batchAccess[b])) {
                 batches[b].systems.push_back(sysId);
+                batchAccess[b] |= myAccess;
                 systemBatch[sysId] = b;
                 placed = true;
                 break;
@@ -261,9 +362,11 @@ void SystemScheduler::computeParallelBatches(SystemStage stage,
             // Ensure we don't create a batch before minBatch.
             while (batches.size() < minBatch) {
                 batches.emplace_back();
+                batchAccess.emplace_back();
             }
             batches.emplace_back();
             batches.back().systems.push_back(sysId);
+            batchAccess.push_back(myAccess);
             systemBatch[sysId] = batches.size() - 1;
         }
 
@@ -275,20 +378,79 @@ void SystemScheduler::computeParallelBatches(SystemStage stage,
     }
 }
 
+// ── Execution graph computation ─────────────────────────────────────────
+
+void SystemScheduler::computeExecutionGraph(SystemStage stage,
+                                            const std::vector<SystemTypeId>& order,
+                                            AccessCache& accessCache) {
+    auto& segments = executionGraph_[stage];
+    segments.clear();
+
+    if (order.empty()) {
+        return;
+    }
+
+    segments.emplace_back();
+    for (auto sysId : order) {
+        auto& nodes = segments.back().nodes;
+        const auto& myAccess = accessCache[sysId];
+        const auto preds = reverseDeps_.find(sysId);
+
+        // Every earlier node in the segment that this system depends on
+        // or conflicts with must finish first.
+        GraphNode node;
+        node.system = sysId;
+        const std::size_t index = nodes.size();
+        for (std::size_t i = 0; i < index; ++i) {
+            const auto otherId = nodes[i].system;
+            const bool depends = preds != reverseDeps_.end() && preds->second.contains(otherId);
+            if (depends || myAccess.ConflictsWith(accessCache[otherId])) {
+                nodes[i].successors.push_back(index);
+                ++node.predecessorCount;
+            }
+        }
+        nodes.push_back(std::move(node));
+
+        // A sync point closes the segment.
+        if (syncPoints_.count(sysId)) {
+            segments.emplace_back();
+        }
+    }
+
+    if (segments.back().nodes.empty()) {
+        segments.pop_back();
+    }
+}
+
 // ── Parallel execution control ──────────────────────────────────────────
 
 void SystemScheduler::SetParallelExecutor(ParallelExecutor executor) {
     parallelExecutor_ = std::move(executor);
+    workStealingExecutor_ = nullptr;
 }
 
 void SystemScheduler::EnableParallelExecution(bool enable) {
     parallelEnabled_ = enable;
 }
 
+void SystemScheduler::EnableParallelExecution(WorkStealingExecutor& executor) {
+    parallelExecutor_ = nullptr;
+    workStealingExecutor_ = &executor;
+    parallelEnabled_ = true;
+}
+
 bool SystemScheduler::IsParallelExecutionEnabled() const noexcept {
     return parallelEnabled_;
 }
 
+void SystemScheduler::SetParallelMode(ParallelMode mode) noexcept {
+    parallelMode_ = mode;
+}
+
+ParallelMode SystemScheduler::GetParallelMode() const noexcept {
+    return parallelMode_;
+}
+
 // ── Sync points ─────────────────────────────────────────────────────────
 
 void SystemScheduler::AddSyncPoint(SystemTypeId afterSystem) {
@@ -296,11 +458,84 @@ void SystemScheduler::AddSyncPoint(SystemTypeId afterSystem) {
     built_ = false;
 }
 
+// ── Command buffers ─────────────────────────────────────────────────────
+
+void SystemScheduler::SetCommandBuffers(CommandBufferSet* buffers) noexcept {
+    commandBuffers_ = buffers;
+}
+
+// ── Event channels ──────────────────────────────────────────────────────
+
+void SystemScheduler::AddEventChannel(IEventChannel& channel) {
+    if (std::find(eventChannels_.begin(), eventChannels_.end(), &channel) ==
+        eventChannels_.end()) {
+        eventChannels_.push_back(&channel);
+    }
+}
+
+void SystemScheduler::RemoveEventChannel(IEventChannel& channel) noexcept {
+    std::erase(eventChannels_, &channel);
+}
+
+void SystemScheduler::publishEvents(SystemStage stage) {
+    if (eventChannels_.empty()) {
+        return;
+    }
+    auto it = stageEventReads_.find(stage);
+    if (it == stageEventReads_.end() || it->second.empty()) {
+        return;
+    }
+    for (auto* channel : eventChannels_) {
+        if (it->second.contains(channel->EventTypeId())) {
+            channel->Swap();
+        }
+    }
+}
+
+void SystemScheduler::playbackCommands() {
+    if (commandBuffers_ != nullptr) {
+        commandBuffers_->Playback();
+    }
+}
+
+// ── Profiling ───────────────────────────────────────────────────────────
+
+void SystemScheduler::SetProfiler(SystemProfiler* profiler) {
+    profiler_ = profiler;
+    registerProfilerNames();
+}
+
+void SystemScheduler::registerProfilerNames() {
+    if (profiler_ == nullptr) {
+        return;
+    }
+    for (const auto& [typeId, entry] : systems_) {
+        profiler_->SetSystemName(typeId, entry.instance->GetName());
+    }
+}
+
+void SystemScheduler::registerAllocTags() {
+    for (auto& [typeId, entry] : systems_) {
+        entry.allocTag = cgs::foundation::AllocTracker::Register(
+            "system." + std::string(entry.instance->GetName()));
+    }
+}
+
 // ── Execution ───────────────────────────────────────────────────────────
 
 void SystemScheduler::Execute(float deltaTime) {
     assert(built_ && "SystemScheduler::Build() must be called before Execute()");
 
+    frameArenas_->SetActive(true);
+
+    // Sample the enable flag once so a tick is recorded whole or not at all.
+    tickProfiler_ = profiler_ != nullptr && profiler_->IsEnabled() ? profiler_ : nullptr;
+    int64_t tickStart = 0;
+    if (tickProfiler_ != nullptr) {
+        tickProfiler_->BeginTick();
+        tickStart = tickProfiler_->Now();
+    }
+
     // Stage execution order: PreUpdate -> Update -> PostUpdate.
     static constexpr SystemStage kVariableStages[] = {
         SystemStage::PreUpdate,
@@ -322,41 +557,126 @@ void SystemScheduler::Execute(float deltaTime) {
             executeStage(SystemStage::FixedUpdate, fixedTimeStep_);
         }
     }
+
+    if (tickProfiler_ != nullptr) {
+        tickProfiler_->Record(ProfileScope::Tick, 0, tickStart, tickProfiler_->Now());
+    }
+
+    // Channels without an in-scheduler reader are published per tick.
+    for (auto* channel : eventChannels_) {
+        if (!eventReads_.contains(channel->EventTypeId())) {
+            channel->Swap();
+        }
+    }
+
+    // Tick boundary: nothing allocated from frame memory survives it.
+    frameArenas_->SetActive(false);
+    frameArenas_->ResetAll();
 }
 
 void SystemScheduler::executeStage(SystemStage stage, float deltaTime) {
-    if (parallelEnabled_ && parallelExecutor_) {
-        auto it = parallelBatches_.find(stage);
-        if (it == parallelBatches_.end()) {
-            return;
-        }
-        for (const auto& batch : it->second) {
-            executeBatch(batch, deltaTime);
-        }
-    } else {
-        auto it = executionOrder_.find(stage);
-        if (it == executionOrder_.end()) {
-            return;
+    const int64_t stageStart = tickProfiler_ != nullptr ? tickProfiler_->Now() : 0;
+
+    // Stage boundary: events sent since the last swap become readable.
+    publishEvents(stage);
+    prepareStage(stage, deltaTime);
+
+    if (parallelEnabled_ && (parallelExecutor_ || workStealingExecutor_ != nullptr)) {
+        if (parallelMode_ == ParallelMode::Graph) {
+            executeGraph(stage);
+        } else if (auto it = parallelBatches_.find(stage); it != parallelBatches_.end()) {
+            for (std::size_t b = 0; b < it->second.size(); ++b) {
+                executeBatch(it->second[b], b);
+            }
         }
+    } else if (auto it = executionOrder_.find(stage); it != executionOrder_.end()) {
         for (auto typeId : it->second) {
             auto& entry = systems_.at(typeId);
-            if (entry.enabled) {
-                entry.instance->Execute(deltaTime);
+            if (entry.due) {
+                runSystem(entry, tickProfiler_);
+                playbackCommands();
             }
         }
     }
+
+    if (tickProfiler_ != nullptr) {
+        tickProfiler_->Record(ProfileScope::Stage, static_cast<uint32_t>(stage), stageStart,
+                              tickProfiler_->Now());
+    }
+}
+
+void SystemScheduler::runSystem(SystemEntry& entry, SystemProfiler* profiler) {
+    auto& system = *entry.instance;
+    const int64_t start = profiler != nullptr ? profiler->Now() : 0;
+
+    // Snapshot before running so changes made concurrently by other
+    // systems in the same batch are still visible next time.
+    const uint32_t startVersion = CurrentChangeVersion();
+    system.slice_ = entry.slice;
+    // A sliced run covers only its slice, so it sees the changes made
+    // since that slice last ran, not since the previous run.
+    auto& sliceVersion = entry.sliceVersions[entry.slice.index];
+    system.lastRunVersion_ = sliceVersion;
+    const auto allocsBefore = cgs::foundation::AllocTracker::ThreadCounts();
+    {
+        cgs::foundation::AllocTagScope allocScope(entry.allocTag);
+        system.Execute(entry.runDelta);
+    }
+    system.lastRunVersion_ = startVersion;
+    sliceVersion = startVersion;
+
+    if (profiler != nullptr) {
+        const auto allocsAfter = cgs::foundation::AllocTracker::ThreadCounts();
+        profiler->Record(ProfileScope::System, entry.typeId, start, profiler->Now(),
+                         {allocsAfter.allocations - allocsBefore.allocations,
+                          allocsAfter.bytes - allocsBefore.bytes});
+    }
+}
+
+void SystemScheduler::runSystemTask(void* context) {
+    const auto& task = *static_cast<const SystemTask*>(context);
+    runSystem(*task.entry, task.profiler);
 }
 
-void SystemScheduler::executeBatch(const ParallelBatch& batch, float deltaTime) {
-    // Collect enabled systems.
+void SystemScheduler::executeBatch(const ParallelBatch& batch, std::size_t index) {
+    SystemProfiler* profiler = tickProfiler_;
+    const int64_t batchStart = profiler != nullptr ? profiler->Now() : 0;
+    const auto recordBatch = [&] {
+        if (profiler != nullptr) {
+            profiler->Record(ProfileScope::Batch, static_cast<uint32_t>(index), batchStart,
+                             profiler->Now());
+        }
+    };
+
+    if (workStealingExecutor_ != nullptr) {
+        // Fill the reusable descriptor buffers; no allocation once they
+        // have grown to the largest batch.
+        systemTasks_.clear();
+        for (auto sysId : batch.systems) {
+            auto& entry = systems_.at(sysId);
+            if (entry.due) {
+                systemTasks_.push_back(SystemTask{&entry, profiler});
+            }
+        }
+        executorTasks_.clear();
+        for (auto& task : systemTasks_) {
+            executorTasks_.push_back(WorkStealingExecutor::Task{&runSystemTask, &task});
+        }
+        workStealingExecutor_->Run(executorTasks_);
+        recordBatch();
+        playbackCommands();
+        return;
+    }
+
+    // Collect the systems due this execution.
     std::vector<std::function<void()>> tasks;
     tasks.reserve(batch.systems.size());
 
     for (auto sysId : batch.systems) {
         auto& entry = systems_.at(sysId);
-        if (entry.enabled) {
-            ISystem* sys = entry.instance.get();
-            tasks.emplace_back([sys, deltaTime] { sys->Execute(deltaTime); });
+        if (entry.due) {
+            SystemEntry* sys = &entry;
+            tasks.emplace_back([sys, profiler] { runSystem(*sys, profiler); });
         }
     }
 
@@ -371,6 +691,144 @@ void SystemScheduler::executeBatch(const ParallelBatch& batch, float deltaTime)
         // Multiple tasks — dispatch via parallel executor.
         parallelExecutor_(tasks);
     }
+    recordBatch();
+
+    // Batch boundary: every task has finished recording.
+    playbackCommands();
+}
+
+// ── Graph execution ─────────────────────────────────────────────────────
+
+struct SystemScheduler::GraphRun {
+    SystemScheduler* scheduler = nullptr;
+    const GraphSegment* segment = nullptr;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::vector<uint32_t> waiting;      ///< Unfinished predecessors per node.
+    std::vector<std::size_t> ready;     ///< Nodes whose predecessors are done.
+    std::vector<std::chrono::nanoseconds> durations;
+    std::size_t completed = 0;
+};
+
+void SystemScheduler::runGraphWorker(void* context) {
+    auto& run = *static_cast<GraphRun*>(context);
+    const auto& nodes = run.segment->nodes;
+
+    std::unique_lock lock(run.mutex);
+    for (;;) {
+        run.wake.wait(lock, [&] { return !run.ready.empty() || run.completed == nodes.size(); });
+        if (run.ready.empty()) {
+            return;
+        }
+        const std::size_t index = run.ready.back();
+        run.ready.pop_back();
+        lock.unlock();
+
+        auto& entry = run.scheduler->systems_.at(nodes[index].system);
+        const auto start = std::chrono::steady_clock::now();
+        if (entry.due) {
+            runSystem(entry, run.scheduler->tickProfiler_);
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+
+        lock.lock();
+        run.durations[index] = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed);
+        ++run.completed;
+        bool notify = run.completed == nodes.size();
+        for (auto successor : nodes[index].successors) {
+            if (--run.waiting[successor] == 0) {
+                run.ready.push_back(successor);
+                notify = true;
+            }
+        }
+        if (notify) {
+            run.wake.notify_all();
+        }
+    }
+}
+
+void SystemScheduler::executeGraph(SystemStage stage) {
+    auto it = executionGraph_.find(stage);
+    if (it == executionGraph_.end()) {
+        return;
+    }
+
+    auto& path = criticalPaths_[stage];
+    path.systems.clear();
+    path.length = std::chrono::nanoseconds{0};
+
+    // Widest batch bounds how many systems can usefully run at once.
+    std::size_t width = 1;
+    for (const auto& batch : parallelBatches_[stage]) {
+        width = std::max(width, batch.systems.size());
+    }
+    if (workStealingExecutor_ != nullptr) {
+        width = std::min(width, workStealingExecutor_->WorkerCount() + 1);
+    }
+
+    for (std::size_t s = 0; s < it->second.size(); ++s) {
+        const auto& segment = it->second[s];
+        const auto& nodes = segment.nodes;
+        const int64_t segmentStart = tickProfiler_ != nullptr ? tickProfiler_->Now() : 0;
+
+        GraphRun run;
+        run.scheduler = this;
+        run.segment = &segment;
+        run.waiting.resize(nodes.size());
+        run.durations.resize(nodes.size());
+        for (std::size_t i = 0; i < nodes.size(); ++i) {
+            run.waiting[i] = nodes[i].predecessorCount;
+            if (nodes[i].predecessorCount == 0) {
+                run.ready.push_back(i);
+            }
+        }
+        // Pop sources in topological order.
+        std::reverse(run.ready.begin(), run.ready.end());
+
+        const std::size_t workers = std::min(width, nodes.size());
+        if (workers <= 1) {
+            runGraphWorker(&run);
+        } else if (workStealingExecutor_ != nullptr) {
+            executorTasks_.assign(workers, WorkStealingExecutor::Task{&runGraphWorker, &run});
+            workStealingExecutor_->Run(executorTasks_);
+        } else {
+            std::vector<std::function<void()>> tasks(workers, [&run] { runGraphWorker(&run); });
+            parallelExecutor_(tasks);
+        }
+
+        // Longest measured chain through this segment (nodes are in
+        // topological order, so one forward pass suffices).
+        std::vector<std::chrono::nanoseconds> finish(run.durations);
+        std::vector<std::size_t> previous(nodes.size(), nodes.size());
+        std::size_t last = 0;
+        for (std::size_t i = 0; i < nodes.size(); ++i) {
+            for (auto successor : nodes[i].successors) {
+                if (finish[i] + run.durations[successor] > finish[successor]) {
+                    finish[successor] = finish[i] + run.durations[successor];
+                    previous[successor] = i;
+                }
+            }
+            if (finish[i] > finish[last]) {
+                last = i;
+            }
+        }
+        const std::size_t firstNew = path.systems.size();
+        for (std::size_t i = last; i < nodes.size(); i = previous[i]) {
+            path.systems.push_back(nodes[i].system);
+        }
+        std::reverse(path.systems.begin() + static_cast<std::ptrdiff_t>(firstNew),
+                     path.systems.end());
+        path.length += finish[last];
+
+        if (tickProfiler_ != nullptr) {
+            tickProfiler_->Record(ProfileScope::Batch, static_cast<uint32_t>(s), segmentStart,
+                                  tickProfiler_->Now());
+        }
+
+        // Segment boundary (sync point): apply recorded commands.
+        playbackCommands();
+    }
 }
 
 // ── Error reporting ─────────────────────────────────────────────────────
@@ -409,4 +867,21 @@ const std::vector<SystemScheduler::ParallelBatch>& SystemScheduler::GetParallelB
     return kEmptyBatches_;
 }
 
+const std::vector<SystemScheduler::GraphSegment>& SystemScheduler::GetExecutionGraph(
+    SystemStage stage) const {
+    auto it = executionGraph_.find(stage);
+    if (it != executionGraph_.end()) {
+        return it->second;
+    }
+    return kEmptyGraph_;
+}
+
+const SystemScheduler::CriticalPath& SystemScheduler::GetCriticalPath(SystemStage stage) const {
+    auto it = criticalPaths_.find(stage);
+    if (it != criticalPaths_.end()) {
+        return it->second;
+    }
+    return kEmptyCriticalPath_;
+}
+
 }  // namespace cgs::ecs
@@ -0,0 +1,137 @@
+/// @file work_stealing_executor.cpp
+/// @brief Persistent work-stealing thread pool for system batches.
+
+#include "cgs/ecs/work_stealing_executor.hpp"
+
+#include "cgs/foundation/cpu_affinity.hpp"
+
+namespace cgs::ecs {
+
+std::size_t WorkStealingExecutor::DefaultWorkerCount() noexcept {
+    std::size_t cpus = 1;
+    try {
+        cpus = cgs::foundation::availableCpuCount();
+    } catch (...) {
+        // Reading the cgroup files failed to allocate: assume one CPU
+    }
+    return cpus > 1 ? cpus - 1 : 1;
+}
+
+WorkStealingExecutor::WorkStealingExecutor(std::size_t workerCount)
+    : queues_(std::make_unique<Queue[]>(workerCount + 1)), queueCount_(workerCount + 1) {
+    workers_.reserve(workerCount);
+    for (std::size_t i = 0; i < workerCount; ++i) {
+        workers_.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+WorkStealingExecutor::~WorkStealingExecutor() {
+    {
+        std::lock_guard lock(wakeMutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void WorkStealingExecutor::Run(std::span<const Task> tasks) {
+    if (tasks.empty()) {
+        return;
+    }
+    if (tasks.size() == 1 || workers_.empty()) {
+        for (const auto& task : tasks) {
+            task.fn(task.context);
+        }
+        return;
+    }
+
+    // Publish the count before any task becomes visible: a worker still
+    // draining the previous batch may pick up a new task immediately.
+    remaining_.store(tasks.size(), std::memory_order_release);
+
+    for (std::size_t q = 0; q < queueCount_; ++q) {
+        auto& queue = queues_[q];
+        std::lock_guard lock(queue.mutex);
+        queue.tasks.clear();
+        for (std::size_t i = q; i < tasks.size(); i += queueCount_) {
+            queue.tasks.push_back(tasks[i]);
+        }
+        queue.head = 0;
+        queue.tail = queue.tasks.size();
+    }
+
+    {
+        std::lock_guard lock(wakeMutex_);
+        ++epoch_;
+    }
+    wake_.notify_all();
+
+    // The caller works on its own queue, then helps the others.
+    drain(queueCount_ - 1);
+    while (remaining_.load(std::memory_order_acquire) != 0) {
+        std::this_thread::yield();
+    }
+}
+
+void WorkStealingExecutor::operator()(const std::vector<std::function<void()>>& tasks) {
+    functionTasks_.clear();
+    for (const auto& task : tasks) {
+        functionTasks_.push_back(
+            Task{[](void* context) { (*static_cast<const std::function<void()>*>(context))(); },
+                 const_cast<std::function<void()>*>(&task)});
+    }
+    Run(functionTasks_);
+}
+
+void WorkStealingExecutor::workerLoop(std::size_t self) {
+    uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock lock(wakeMutex_);
+            wake_.wait(lock, [&] { return stop_ || epoch_ != seen; });
+            if (stop_) {
+                return;
+            }
+            seen = epoch_;
+        }
+        drain(self);
+    }
+}
+
+void WorkStealingExecutor::drain(std::size_t self) {
+    Task task;
+    while (remaining_.load(std::memory_order_acquire) != 0) {
+        if (!tryPop(self, task) && !trySteal(self, task)) {
+            // Every queue is empty; the remaining tasks are in flight.
+            return;
+        }
+        task.fn(task.context);
+        remaining_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+bool WorkStealingExecutor::tryPop(std::size_t self, Task& out) {
+    auto& queue = queues_[self];
+    std::lock_guard lock(queue.mutex);
+    if (queue.head == queue.tail) {
+        return false;
+    }
+    out = queue.tasks[--queue.tail];
+    return true;
+}
+
+bool WorkStealingExecutor::trySteal(std::size_t self, Task& out) {
+    for (std::size_t offset = 1; offset < queueCount_; ++offset) {
+        auto& queue = queues_[(self + offset) % queueCount_];
+        std::lock_guard lock(queue.mutex);
+        if (queue.head != queue.tail) {
+            out = queue.tasks[queue.head++];
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace cgs::ecs
@@ -1,16 +1,16 @@
 #include "cgs/foundation/config_manager.hpp"
 
+#include <algorithm>
 #include <fstream>
 
 namespace cgs::foundation {
 
+ConfigManager::ConfigManager() : snapshot_(std::make_shared<const Snapshot>()) {}
+
 GameResult<void> ConfigManager::load(const std::filesystem::path& path) {
-    std::lock_guard lock(mutex_);
+    Entries entries;
     try {
-        auto root = YAML::LoadFile(path.string());
-        entries_.clear();
-        flatten("", root);
-        return GameResult<void>::ok();
+        flatten("", YAML::LoadFile(path.string()), entries);
     } catch (const YAML::BadFile&) {
         return GameResult<void>::err(
             GameError(ErrorCode::ConfigLoadFailed, "failed to open config file: " + path.string()));
@@ -18,6 +18,10 @@ GameResult<void> ConfigManager::load(const std::filesystem::path& path) {
         return GameResult<void>::err(
             GameError(ErrorCode::ConfigLoadFailed, std::string("YAML parse error: ") + e.what()));
     }
+
+    std::unique_lock lock(mutex_);
+    publish(lock, std::move(entries), nullptr);
+    return GameResult<void>::ok();
 }
 
 void ConfigManager::watch(std::string_view key, ConfigWatchCallback callback) {
@@ -26,31 +30,115 @@ void ConfigManager::watch(std::string_view key, ConfigWatchCallback callback) {
 }
 
 bool ConfigManager::hasKey(std::string_view key) const {
-    std::lock_guard lock(mutex_);
-    return entries_.count(std::string(key)) > 0;
+    return current()->entries.count(std::string(key)) > 0;
+}
+
+uint64_t ConfigManager::version() const noexcept {
+    return current()->version;
 }
 
-void ConfigManager::flatten(const std::string& prefix, const YAML::Node& node) {
+std::shared_ptr<const ConfigManager::Snapshot> ConfigManager::current() const {
+    return snapshot_.load(std::memory_order_acquire);
+}
+
+void ConfigManager::flatten(const std::string& prefix, const YAML::Node& node, Entries& entries) {
     if (node.IsMap()) {
         for (auto it = node.begin(); it != node.end(); ++it) {
             auto childKey = it->first.as<std::string>();
             auto fullKey = prefix.empty() ? childKey : prefix + "." + childKey;
-            flatten(fullKey, it->second);
+            flatten(fullKey, it->second, entries);
         }
     } else {
         // Leaf node (scalar, sequence, null) — store with its dotted key.
-        entries_[prefix] = YAML::Clone(node);
+        entries[prefix] = YAML::Clone(node);
     }
 }
 
-void ConfigManager::notifyWatchers(std::string_view key) {
-    std::lock_guard lock(mutex_);
-    auto it = watchers_.find(std::string(key));
-    if (it != watchers_.end()) {
-        for (auto& cb : it->second) {
-            cb(key);
+void ConfigManager::setEntry(std::string_view key, YAML::Node node) {
+    std::unique_lock lock(mutex_);
+    // Nodes are never modified once published, so the copy shares them.
+    Entries entries = current()->entries;
+    std::string name(key);
+    // Erase first: assigning over a YAML::Node writes through to the node
+    // the previous snapshot still shares.
+    entries.erase(name);
+    entries.emplace(name, std::move(node));
+    const std::vector<std::string> changed{std::move(name)};
+    publish(lock, std::move(entries), &changed);
+}
+
+void ConfigManager::publish(std::unique_lock<std::mutex>& writeLock, Entries entries,
+                            const std::vector<std::string>* changed) {
+    const auto previous = current();
+    auto next = std::make_shared<Snapshot>();
+    next->entries = std::move(entries);
+    next->version = previous->version + 1;
+    snapshot_.store(next, std::memory_order_release);
+
+    auto lookup = [&next](const std::string& key) -> const YAML::Node* {
+        auto it = next->entries.find(key);
+        return it == next->entries.end() ? nullptr : &it->second;
+    };
+
+    // Refresh bound values, dropping handles that no longer exist.
+    auto refresh = [&](const std::string& key,
+                       std::vector<std::weak_ptr<detail::ConfigSlotBase>>& slots) {
+        const YAML::Node* node = lookup(key);
+        std::erase_if(slots, [node](const std::weak_ptr<detail::ConfigSlotBase>& weak) {
+            auto slot = weak.lock();
+            if (!slot) {
+                return true;
+            }
+            slot->refresh(node);
+            return false;
+        });
+    };
+    if (changed == nullptr) {
+        for (auto& [key, slots] : bindings_) {
+            refresh(key, slots);
+        }
+    } else {
+        for (const auto& key : *changed) {
+            if (auto it = bindings_.find(key); it != bindings_.end()) {
+                refresh(key, it->second);
+            }
+        }
+    }
+
+    // Watchers of changed keys; a reload compares each watched key's text.
+    std::vector<std::pair<std::string, ConfigWatchCallback>> notify;
+    for (const auto& [key, callbacks] : watchers_) {
+        bool keyChanged = false;
+        if (changed != nullptr) {
+            keyChanged = std::find(changed->begin(), changed->end(), key) != changed->end();
+        } else {
+            auto before = previous->entries.find(key);
+            const YAML::Node* after = lookup(key);
+            const bool had = before != previous->entries.end();
+            keyChanged = had != (after != nullptr) ||
+                         (had && YAML::Dump(before->second) != YAML::Dump(*after));
         }
+        if (keyChanged) {
+            for (const auto& callback : callbacks) {
+                notify.emplace_back(key, callback);
+            }
+        }
+    }
+    writeLock.unlock();
+
+    for (const auto& [key, callback] : notify) {
+        callback(key);
     }
 }
 
+void ConfigManager::attach(std::string_view key,
+                           const std::shared_ptr<detail::ConfigSlotBase>& slot) {
+    std::lock_guard lock(mutex_);
+    std::string name(key);
+    const auto snapshot = current();
+    auto it = snapshot->entries.find(name);
+    slot->refresh(it == snapshot->entries.end() ? nullptr : &it->second);
+    bindings_[std::move(name)].push_back(slot);
+}
+
 }  // namespace cgs::foundation
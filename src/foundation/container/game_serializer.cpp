@@ -1,7 +1,8 @@
 /// @file game_serializer.cpp
 /// @brief Non-template parts of GameSerializer (SDS-MOD-007).
 ///
-/// Contains constructor, destructor, move operations, and singleton.
+/// Contains constructor, destructor, move operations, singleton and
+/// binary header validation.
 /// Template methods are defined in the header. When container_system
 /// becomes available, this file gains the backend integration.
 
@@ -23,6 +24,39 @@ GameSerializer::GameSerializer(GameSerializer&&) noexcept = default;
 
 GameSerializer& GameSerializer::operator=(GameSerializer&&) noexcept = default;
 
+// ── Binary header ───────────────────────────────────────────────────────────
+
+GameResult<uint32_t> GameSerializer::readHeader(detail::BinaryReader& reader,
+                                                const uint8_t (&magic)[4]) {
+    // Verify magic bytes
+    uint8_t stored[4]{};
+    for (auto& m : stored) {
+        if (!reader.readPrimitive(m)) {
+            return GameResult<uint32_t>::err(
+                GameError(ErrorCode::InvalidBinaryData, "truncated binary header"));
+        }
+    }
+    if (std::memcmp(stored, magic, 4) != 0) {
+        return GameResult<uint32_t>::err(
+            GameError(ErrorCode::InvalidBinaryData, "invalid magic bytes"));
+    }
+
+    // Schema version (stored for forward compatibility)
+    uint32_t version = 0;
+    if (!reader.readPrimitive(version)) {
+        return GameResult<uint32_t>::err(
+            GameError(ErrorCode::InvalidBinaryData, "truncated version field"));
+    }
+
+    // Field count from the serialized data
+    uint32_t storedFieldCount = 0;
+    if (!reader.readPrimitive(storedFieldCount)) {
+        return GameResult<uint32_t>::err(
+            GameError(ErrorCode::InvalidBinaryData, "truncated field count"));
+    }
+    return GameResult<uint32_t>::ok(storedFieldCount);
+}
+
 // ── Singleton ───────────────────────────────────────────────────────────────
 
 GameSerializer& GameSerializer::instance() {
@@ -3,14 +3,21 @@
 
 #include "cgs/foundation/game_database.hpp"
 
+#include "cgs/foundation/game_metrics.hpp"
+
 // kcenon database_system headers (hidden behind PIMPL)
 #include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
 #include <condition_variable>
 #include <core/database_backend.h>
 #include <core/database_context.h>
 #include <database_manager.h>
 #include <database_types.h>
 #include <mutex>
+#include <optional>
+#include <random>
 
 namespace cgs::foundation {
 
@@ -37,29 +44,21 @@ static QueryResult convertResult(const ::database::core::database_result& kcResu
     result.reserve(kcResult.size());
 
     for (const auto& kcRow : kcResult) {
-        DbRow row;
+        const std::size_t row = result.addRow();
         for (const auto& [col, val] : kcRow) {
-            const auto& key = col;
+            const std::size_t column = result.columnFor(col);
             std::visit(
-                [&row, &key](auto&& arg) {
+                [&result, row, column](auto&& arg) {
                     using T = std::decay_t<decltype(arg)>;
-                    if constexpr (std::is_same_v<T, std::nullptr_t>) {
-                        row[key] = DbNull{};
-                    } else if constexpr (std::is_same_v<T, std::string>) {
-                        row[key] = arg;
-                    } else if constexpr (std::is_same_v<T, std::int64_t>) {
-                        row[key] = arg;
-                    } else if constexpr (std::is_same_v<T, double>) {
-                        row[key] = arg;
-                    } else if constexpr (std::is_same_v<T, bool>) {
-                        row[key] = arg;
-                    } else {
-                        row[key] = DbNull{};
+                    if constexpr (std::is_same_v<T, std::string> ||
+                                  std::is_same_v<T, std::int64_t> || std::is_same_v<T, double> ||
+                                  std::is_same_v<T, bool>) {
+                        result.set(row, column, arg);
                     }
+                    // nullptr and other types stay NULL
                 },
                 val);
         }
-        result.push_back(std::move(row));
     }
     return result;
 }
@@ -68,7 +67,72 @@ static QueryResult convertResult(const ::database::core::database_result& kcResu
 // PreparedStatement
 // ---------------------------------------------------------------------------
 
-PreparedStatement::PreparedStatement(std::string sql) : sql_(std::move(sql)) {}
+static bool isParamStart(char c) {
+    return std::isalpha(static_cast<unsigned char>(c)) || c == '_';
+}
+
+static bool isParamChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+// SQL literal of a bound value: strings quoted with ' doubled.
+static std::string toLiteral(const DbValue& value) {
+    return std::visit(
+        [](auto&& arg) -> std::string {
+            using T = std::decay_t<decltype(arg)>;
+            if constexpr (std::is_same_v<T, DbNull>) {
+                return "NULL";
+            } else if constexpr (std::is_same_v<T, std::string>) {
+                std::string escaped;
+                escaped.reserve(arg.size() + 2);
+                escaped += '\'';
+                for (char c : arg) {
+                    if (c == '\'') {
+                        escaped += "''";
+                    } else {
+                        escaped += c;
+                    }
+                }
+                escaped += '\'';
+                return escaped;
+            } else if constexpr (std::is_same_v<T, std::int64_t>) {
+                return std::to_string(arg);
+            } else if constexpr (std::is_same_v<T, double>) {
+                // Shortest form that reads back as the same double
+                std::array<char, 32> buffer{};
+                auto [end, ec] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), arg);
+                return ec == std::errc{} ? std::string(buffer.data(), end) : std::to_string(arg);
+            } else {
+                return arg ? "TRUE" : "FALSE";
+            }
+        },
+        value);
+}
+
+PreparedStatement::PreparedStatement(std::string sql) : sql_(std::move(sql)) {
+    // Split once into text and $name placeholders.
+    std::string text;
+    for (std::size_t i = 0; i < sql_.size();) {
+        if (sql_[i] != '$' || i + 1 >= sql_.size() || !isParamStart(sql_[i + 1])) {
+            text += sql_[i++];
+            continue;
+        }
+        std::size_t end = i + 2;
+        while (end < sql_.size() && isParamChar(sql_[end])) {
+            ++end;
+        }
+        std::string name = sql_.substr(i + 1, end - i - 1);
+        auto it = std::find(names_.begin(), names_.end(), name);
+        slots_.push_back(static_cast<std::size_t>(it - names_.begin()));
+        if (it == names_.end()) {
+            names_.push_back(std::move(name));
+        }
+        text_.push_back(std::move(text));
+        text.clear();
+        i = end;
+    }
+    text_.push_back(std::move(text));
+}
 
 PreparedStatement& PreparedStatement::bindString(std::string_view name, std::string value) {
     params_[std::string(name)] = std::move(value);
@@ -100,71 +164,246 @@ std::string_view PreparedStatement::sql() const noexcept {
 }
 
 std::string PreparedStatement::resolve() const {
-    std::string resolved = sql_;
-
-    for (const auto& [name, val] : params_) {
-        std::string placeholder = "$" + name;
-        std::string replacement;
-
-        std::visit(
-            [&](auto&& arg) {
-                using T = std::decay_t<decltype(arg)>;
-                if constexpr (std::is_same_v<T, DbNull>) {
-                    replacement = "NULL";
-                } else if constexpr (std::is_same_v<T, std::string>) {
-                    // Escape single quotes for SQL safety
-                    std::string escaped;
-                    escaped.reserve(arg.size() + 2);
-                    escaped += '\'';
-                    for (char c : arg) {
-                        if (c == '\'') {
-                            escaped += "''";
-                        } else {
-                            escaped += c;
-                        }
-                    }
-                    escaped += '\'';
-                    replacement = std::move(escaped);
-                } else if constexpr (std::is_same_v<T, std::int64_t>) {
-                    replacement = std::to_string(arg);
-                } else if constexpr (std::is_same_v<T, double>) {
-                    replacement = std::to_string(arg);
-                } else if constexpr (std::is_same_v<T, bool>) {
-                    replacement = arg ? "TRUE" : "FALSE";
-                }
-            },
-            val);
-
-        // Replace all occurrences of $name in the SQL string
-        std::size_t pos = 0;
-        while ((pos = resolved.find(placeholder, pos)) != std::string::npos) {
-            // Ensure we match the full parameter name (not a prefix)
-            auto endPos = pos + placeholder.size();
-            if (endPos < resolved.size() &&
-                (std::isalnum(resolved[endPos]) || resolved[endPos] == '_')) {
-                pos = endPos;
-                continue;
-            }
-            resolved.replace(pos, placeholder.size(), replacement);
-            pos += replacement.size();
+    std::string resolved = text_[0];
+    for (std::size_t i = 0; i < slots_.size(); ++i) {
+        const auto& name = names_[slots_[i]];
+        auto it = params_.find(name);
+        if (it != params_.end()) {
+            resolved += toLiteral(it->second);
+        } else {
+            resolved += '$';  // Unbound: left as written
+            resolved += name;
         }
+        resolved += text_[i + 1];
     }
-
     return resolved;
 }
 
+const std::vector<std::string>& PreparedStatement::parameterNames() const noexcept {
+    return names_;
+}
+
+std::string PreparedStatement::positionalSql() const {
+    std::string positional = text_[0];
+    for (std::size_t i = 0; i < slots_.size(); ++i) {
+        positional += '$';
+        positional += std::to_string(slots_[i] + 1);
+        positional += text_[i + 1];
+    }
+    return positional;
+}
+
+const DbValue* PreparedStatement::binding(std::string_view name) const {
+    auto it = params_.find(std::string(name));
+    return it == params_.end() ? nullptr : &it->second;
+}
+
 void PreparedStatement::clearBindings() {
     params_.clear();
 }
 
+// ---------------------------------------------------------------------------
+// BatchWriter
+// ---------------------------------------------------------------------------
+
+BatchWriter::BatchWriter(std::string table, std::vector<std::string> columns)
+    : table_(std::move(table)), columns_(std::move(columns)) {}
+
+BatchWriter& BatchWriter::upsert(std::vector<std::string> keyColumns,
+                                 std::vector<std::string> updateColumns) {
+    keys_ = std::move(keyColumns);
+    updates_ = std::move(updateColumns);
+    if (updates_.empty()) {
+        for (const auto& column : columns_) {
+            if (std::find(keys_.begin(), keys_.end(), column) == keys_.end()) {
+                updates_.push_back(column);
+            }
+        }
+    }
+    conflict_ = updates_.empty() ? Conflict::Ignore : Conflict::Update;
+    return *this;
+}
+
+BatchWriter& BatchWriter::ignoreConflicts(std::vector<std::string> keyColumns) {
+    keys_ = std::move(keyColumns);
+    updates_.clear();
+    conflict_ = Conflict::Ignore;
+    return *this;
+}
+
+BatchWriter& BatchWriter::setRowsPerStatement(std::size_t rows) {
+    rowsPerStatement_ = std::max<std::size_t>(1, rows);
+    return *this;
+}
+
+GameResult<void> BatchWriter::addRow(std::vector<DbValue> values) {
+    if (values.size() != columns_.size()) {
+        return GameResult<void>::err(GameError(
+            ErrorCode::InvalidArgument, "row has " + std::to_string(values.size()) +
+                                            " values for " + std::to_string(columns_.size()) +
+                                            " columns of " + table_));
+    }
+    for (auto& value : values) {
+        values_.push_back(std::move(value));
+    }
+    return GameResult<void>::ok();
+}
+
+void BatchWriter::clear() noexcept {
+    values_.clear();
+}
+
+const std::string& BatchWriter::table() const noexcept {
+    return table_;
+}
+
+const std::vector<std::string>& BatchWriter::columns() const noexcept {
+    return columns_;
+}
+
+std::size_t BatchWriter::rowCount() const noexcept {
+    return columns_.empty() ? 0 : values_.size() / columns_.size();
+}
+
+bool BatchWriter::empty() const noexcept {
+    return values_.empty();
+}
+
+std::vector<std::string> BatchWriter::statements(DatabaseType dbType) const {
+    const std::size_t width = columns_.size();
+    const std::size_t rows = rowCount();
+
+    // Rows to send, in order.  With a conflict key only the last row of
+    // each key is kept: one statement may not update a row twice.
+    std::vector<std::size_t> order;
+    order.reserve(rows);
+    if (conflict_ == Conflict::Fail || keys_.empty()) {
+        for (std::size_t r = 0; r < rows; ++r) {
+            order.push_back(r);
+        }
+    } else {
+        std::vector<std::size_t> keyIndex;
+        for (const auto& key : keys_) {
+            auto it = std::find(columns_.begin(), columns_.end(), key);
+            if (it != columns_.end()) {
+                keyIndex.push_back(static_cast<std::size_t>(it - columns_.begin()));
+            }
+        }
+        std::unordered_map<std::string, std::size_t> lastOfKey;
+        lastOfKey.reserve(rows);
+        for (std::size_t r = 0; r < rows; ++r) {
+            std::string key;
+            for (auto c : keyIndex) {
+                key += toLiteral(values_[r * width + c]);
+                key += '\x1f';
+            }
+            auto [it, inserted] = lastOfKey.try_emplace(std::move(key), order.size());
+            if (inserted) {
+                order.push_back(r);
+            } else {
+                order[it->second] = r;  // Keep the first row's position
+            }
+        }
+    }
+
+    std::string head = "INSERT INTO " + table_ + " (";
+    for (std::size_t c = 0; c < width; ++c) {
+        if (c != 0) {
+            head += ", ";
+        }
+        head += columns_[c];
+    }
+    head += ") VALUES ";
+
+    std::string tail;
+    if (conflict_ != Conflict::Fail) {
+        tail = " ON CONFLICT";
+        if (!keys_.empty()) {
+            tail += " (";
+            for (std::size_t k = 0; k < keys_.size(); ++k) {
+                if (k != 0) {
+                    tail += ", ";
+                }
+                tail += keys_[k];
+            }
+            tail += ')';
+        }
+        if (conflict_ == Conflict::Update) {
+            tail += " DO UPDATE SET ";
+            for (std::size_t u = 0; u < updates_.size(); ++u) {
+                if (u != 0) {
+                    tail += ", ";
+                }
+                tail += updates_[u] + " = EXCLUDED." + updates_[u];
+            }
+        } else {
+            tail += " DO NOTHING";
+        }
+    }
+
+    // SQLite: one row per INSERT, sent in a loop inside write()'s transaction.
+    const std::size_t perStatement = dbType == DatabaseType::SQLite ? 1 : rowsPerStatement_;
+
+    std::vector<std::string> statements;
+    statements.reserve((order.size() + perStatement - 1) / perStatement);
+    for (std::size_t first = 0; first < order.size(); first += perStatement) {
+        const std::size_t last = std::min(order.size(), first + perStatement);
+        std::string sql = head;
+        for (std::size_t i = first; i < last; ++i) {
+            sql += i == first ? "(" : ", (";
+            const std::size_t row = order[i];
+            for (std::size_t c = 0; c < width; ++c) {
+                if (c != 0) {
+                    sql += ", ";
+                }
+                sql += toLiteral(values_[row * width + c]);
+            }
+            sql += ')';
+        }
+        sql += tail;
+        statements.push_back(std::move(sql));
+    }
+    return statements;
+}
+
+// Send a batch's statements in order on one connection.
+static GameResult<uint64_t> sendBatch(::database::database_manager& manager,
+                                      const BatchWriter& batch, DatabaseType dbType) {
+    for (const auto& sql : batch.statements(dbType)) {
+        auto result = manager.execute_query_result(sql);
+        if (!result.is_ok()) {
+            return GameResult<uint64_t>::err(
+                GameError(ErrorCode::QueryFailed, result.error().message));
+        }
+    }
+    return GameResult<uint64_t>::ok(batch.rowCount());
+}
+
 // ---------------------------------------------------------------------------
 // Connection pool entry
 // ---------------------------------------------------------------------------
 
 struct PooledConnection {
+    using Clock = std::chrono::steady_clock;
+
     std::shared_ptr<::database::database_context> context;
     std::shared_ptr<::database::database_manager> manager;
     bool inUse = false;
+    Clock::time_point openedAt;
+    Clock::time_point idleSince;
+    double jitter = 1.0;  ///< Scales idleTimeout and maxLifetime.
+
+    [[nodiscard]] bool expired(const DatabaseConfig& config, Clock::time_point now) const {
+        return config.maxLifetime.count() > 0 &&
+               now - openedAt >=
+                   std::chrono::duration_cast<Clock::duration>(config.maxLifetime * jitter);
+    }
+
+    [[nodiscard]] bool idleTooLong(const DatabaseConfig& config, Clock::time_point now) const {
+        return config.idleTimeout.count() > 0 &&
+               now - idleSince >=
+                   std::chrono::duration_cast<Clock::duration>(config.idleTimeout * jitter);
+    }
 };
 
 // ---------------------------------------------------------------------------
@@ -175,6 +414,7 @@ struct Transaction::Impl {
     std::shared_ptr<::database::database_manager> manager;
     // Callback to return the connection when the transaction ends
     std::function<void(::database::database_manager*)> returnConnection;
+    DatabaseType dbType = DatabaseType::PostgreSQL;
     bool active = true;
     bool ownsConnection = true;
 };
@@ -269,6 +509,14 @@ GameResult<uint64_t> Transaction::execute(std::string_view sql) {
     return GameResult<uint64_t>::ok(0);
 }
 
+GameResult<uint64_t> Transaction::write(const BatchWriter& batch) {
+    if (!impl_ || !impl_->active) {
+        return GameResult<uint64_t>::err(
+            GameError(ErrorCode::TransactionFailed, "transaction not active"));
+    }
+    return sendBatch(*impl_->manager, batch, impl_->dbType);
+}
+
 bool Transaction::isActive() const noexcept {
     return impl_ && impl_->active;
 }
@@ -285,47 +533,169 @@ struct GameDatabase::Impl {
     std::condition_variable poolCv;
     std::atomic<bool> connected{false};
 
-    // Checkout a connection from the pool (blocking with timeout)
+    // Under poolMutex: connections checked out, connections being opened
+    // outside the lock (they count against maxConnections), counters.
+    std::size_t busy = 0;
+    std::size_t opening = 0;
+    ConnectionPoolStats poolStats;
+    std::minstd_rand jitterRng{std::random_device{}()};
+
+    using AsyncQueries = AsyncQueryQueue<GameResult<QueryResult>>;
+
+    // Query workers for the asynchronous API; present while connected.
+    // Shared so queryAsync() can submit outside ioMutex (a rejected query
+    // completes inline); disconnect() shuts it down explicitly.
+    std::shared_ptr<AsyncQueries> io;
+    mutable std::mutex ioMutex;
+
+    // Server-side prepared statements of one connection: SQL text -> name.
+    struct StatementCache {
+        std::unordered_map<std::string, std::string> names;
+        uint64_t nextId = 0;
+    };
+
+    // One cache per pooled connection, created under poolMutex; a cache is
+    // then only touched by the thread that has its connection checked out.
+    std::unordered_map<const ::database::database_manager*, StatementCache> statements;
+    std::atomic<uint64_t> statementsPrepared{0};
+    std::atomic<uint64_t> statementsReused{0};
+    std::atomic<uint64_t> statementEvictions{0};
+
+    // Counters already added by publishAsyncQueryMetrics().
+    AsyncQueryStats published;
+    std::mutex publishedMutex;
+
+    // Checkout a connection from the pool (blocking with timeout).  A new
+    // connection is opened, outside the lock, only when none is returned
+    // within growAfterWait.
     std::shared_ptr<::database::database_manager> checkout() {
+        const auto start = std::chrono::steady_clock::now();
+        const auto deadline = start + config.connectionTimeout;
+        const auto growAt = start + config.growAfterWait;
+        bool growFailed = false;
         std::unique_lock lock(poolMutex);
-        auto deadline = std::chrono::steady_clock::now() + config.connectionTimeout;
 
         while (true) {
             for (auto& conn : pool) {
                 if (!conn.inUse) {
                     conn.inUse = true;
+                    noteCheckout(start);
                     return conn.manager;
                 }
             }
 
-            // Try to grow pool if under max
-            if (pool.size() < config.maxConnections) {
+            const auto now = std::chrono::steady_clock::now();
+            const bool canGrow = !growFailed && pool.size() + opening < config.maxConnections;
+            if (canGrow && now >= growAt) {
+                ++opening;
+                lock.unlock();
                 auto conn = createConnection();
-                if (conn.manager) {
+                lock.lock();
+                --opening;
+                if (conn.manager && connected.load()) {
                     conn.inUse = true;
                     auto mgr = conn.manager;
-                    pool.push_back(std::move(conn));
+                    adopt(std::move(conn));
+                    ++poolStats.grown;
+                    noteCheckout(start);
                     return mgr;
                 }
+                if (conn.manager) {
+                    (void)conn.manager->disconnect_result();  // disconnect() ran meanwhile
+                    return nullptr;
+                }
+                growFailed = true;  // Wait for a returned connection instead
+                continue;
             }
 
-            // Wait for a connection to be returned
-            if (poolCv.wait_until(lock, deadline) == std::cv_status::timeout) {
+            // Wait for a connection to be returned (or until growing is due).
+            const auto wakeAt = canGrow ? std::min(deadline, growAt) : deadline;
+            if (poolCv.wait_until(lock, wakeAt) == std::cv_status::timeout &&
+                std::chrono::steady_clock::now() >= deadline) {
+                ++poolStats.timeouts;
                 return nullptr;  // Pool exhausted
             }
         }
     }
 
-    // Return a connection to the pool
+    // Return a connection to the pool; one past its maxLifetime is closed.
     void checkin(::database::database_manager* mgr) {
-        std::lock_guard lock(poolMutex);
-        for (auto& conn : pool) {
-            if (conn.manager.get() == mgr) {
-                conn.inUse = false;
-                poolCv.notify_one();
+        PooledConnection retired;
+        {
+            std::lock_guard lock(poolMutex);
+            const auto now = std::chrono::steady_clock::now();
+            auto it = std::find_if(pool.begin(), pool.end(), [mgr](const PooledConnection& c) {
+                return c.manager.get() == mgr;
+            });
+            if (it == pool.end()) {
                 return;
             }
+            --busy;
+            if (it->expired(config, now)) {
+                retired = retire(it);
+                ++poolStats.lifetimeClosed;
+            } else {
+                it->inUse = false;
+                it->idleSince = now;
+            }
+            poolCv.notify_one();
         }
+        if (retired.manager) {
+            (void)retired.manager->disconnect_result();
+        }
+    }
+
+    // Under poolMutex: record a checkout that started at @p start.
+    void noteCheckout(std::chrono::steady_clock::time_point start) {
+        ++busy;
+        const auto wait = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start);
+        ++poolStats.checkouts;
+        ++poolStats.waitBuckets[ConnectionPoolStats::waitBucket(wait)];
+        ++poolStats.utilizationBuckets[ConnectionPoolStats::utilizationBucket(
+            busy, config.maxConnections)];
+        poolStats.totalWait += wait;
+        poolStats.maxWait = std::max(poolStats.maxWait, wait);
+    }
+
+    // Under poolMutex: add a freshly opened connection to the pool.
+    void adopt(PooledConnection conn) {
+        const double jitter = std::clamp(config.poolJitter, 0.0, 1.0);
+        conn.jitter = std::uniform_real_distribution<double>(1.0 - jitter, 1.0 + jitter)(jitterRng);
+        conn.openedAt = std::chrono::steady_clock::now();
+        conn.idleSince = conn.openedAt;
+        pool.push_back(std::move(conn));
+        ++poolStats.opened;
+    }
+
+    // Under poolMutex: take @p it out of the pool, to be disconnected
+    // after the lock is released, and advance @p it past it.
+    PooledConnection retire(std::vector<PooledConnection>::iterator& it) {
+        PooledConnection conn = std::move(*it);
+        it = pool.erase(it);
+        statements.erase(conn.manager.get());
+        return conn;
+    }
+
+    // Open @p count connections concurrently, so pre-warming pays for one
+    // handshake rather than @p count in a row.  Failed ones are dropped.
+    std::vector<PooledConnection> openConnections(std::size_t count) {
+        std::vector<PooledConnection> opened;
+        if (count == 1) {
+            opened.push_back(createConnection());
+        } else if (count > 1) {
+            std::vector<std::future<PooledConnection>> pending;
+            pending.reserve(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                pending.push_back(
+                    std::async(std::launch::async, [this] { return createConnection(); }));
+            }
+            for (auto& f : pending) {
+                opened.push_back(f.get());
+            }
+        }
+        std::erase_if(opened, [](const PooledConnection& c) { return !c.manager; });
+        return opened;
     }
 
     // Create a new pooled connection
@@ -349,10 +719,140 @@ struct GameDatabase::Impl {
         return conn;
     }
 
+    // Run one SELECT on a checked-out connection.
+    static GameResult<QueryResult> runQuery(::database::database_manager& mgr,
+                                            const std::string& sql) {
+        auto result = mgr.select_query_result(sql);
+        if (!result.is_ok()) {
+            return GameResult<QueryResult>::err(
+                GameError(ErrorCode::QueryFailed, result.error().message));
+        }
+        return GameResult<QueryResult>::ok(convertResult(result.value()));
+    }
+
+    // Stream @p sql on a checked-out connection in batches of
+    // @p batchRows (see GameDatabase::queryStream()).
+    GameResult<uint64_t> runStream(::database::database_manager& mgr, const std::string& sql,
+                                   const RowBatchCallback& onBatch, std::size_t batchRows) {
+        auto begun = mgr.begin_transaction();
+        if (!begun.is_ok()) {
+            return GameResult<uint64_t>::err(
+                GameError(ErrorCode::TransactionFailed,
+                          "failed to begin transaction: " + begun.error().message));
+        }
+
+        // A cursor lives until the transaction ends, so one name suffices.
+        const bool cursor = config.dbType == DatabaseType::PostgreSQL;
+        const std::string limit = std::to_string(batchRows);
+        if (cursor) {
+            auto declared =
+                mgr.execute_query_result("DECLARE cgs_stream NO SCROLL CURSOR FOR " + sql);
+            if (!declared.is_ok()) {
+                (void)mgr.rollback_transaction();
+                return GameResult<uint64_t>::err(
+                    GameError(ErrorCode::QueryFailed, declared.error().message));
+            }
+        }
+
+        uint64_t delivered = 0;
+        std::optional<GameError> failure;
+        while (true) {
+            auto batch = runQuery(mgr, cursor ? "FETCH FORWARD " + limit + " FROM cgs_stream"
+                                              : "SELECT * FROM (" + sql + ") LIMIT " + limit +
+                                                    " OFFSET " + std::to_string(delivered));
+            if (batch.hasError()) {
+                failure = batch.error();
+                break;
+            }
+            const std::size_t rows = batch.value().size();
+            if (rows == 0) {
+                break;
+            }
+            delivered += rows;
+            if (!onBatch(batch.value()) || rows < batchRows) {
+                break;
+            }
+        }
+
+        // Ends the cursor and the snapshot; a stream only reads.
+        (void)mgr.rollback_transaction();
+        if (failure) {
+            return GameResult<uint64_t>::err(std::move(*failure));
+        }
+        return GameResult<uint64_t>::ok(delivered);
+    }
+
+    StatementCache& statementsFor(const ::database::database_manager* mgr) {
+        std::lock_guard lock(poolMutex);
+        return statements[mgr];  // References survive rehashing
+    }
+
+    // EXECUTE @p stmt on a checked-out PostgreSQL connection, preparing it
+    // there first if this connection has not seen its SQL yet.
+    GameResult<QueryResult> executePrepared(::database::database_manager& mgr,
+                                            const PreparedStatement& stmt,
+                                            const std::string& args) {
+        auto& cache = statementsFor(&mgr);
+        auto it = cache.names.find(std::string(stmt.sql()));
+        if (it == cache.names.end()) {
+            if (cache.names.size() >= config.statementCacheSize) {
+                (void)mgr.execute_query_result("DEALLOCATE ALL");
+                cache.names.clear();
+                statementEvictions.fetch_add(1, std::memory_order_relaxed);
+            }
+            std::string name = "cgs_stmt_" + std::to_string(++cache.nextId);
+            auto prepared = mgr.execute_query_result("PREPARE " + name + " AS " +
+                                                     stmt.positionalSql());
+            if (!prepared.is_ok()) {
+                return GameResult<QueryResult>::err(
+                    GameError(ErrorCode::PreparedStatementFailed,
+                              "prepare failed: " + prepared.error().message));
+            }
+            statementsPrepared.fetch_add(1, std::memory_order_relaxed);
+            it = cache.names.emplace(std::string(stmt.sql()), std::move(name)).first;
+        } else {
+            statementsReused.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        auto result = runQuery(mgr, args.empty() ? "EXECUTE " + it->second
+                                                 : "EXECUTE " + it->second + "(" + args + ")");
+        if (result.hasError()) {
+            // Prepared again on next use, in case the server lost it.
+            (void)mgr.execute_query_result("DEALLOCATE " + it->second);
+            cache.names.erase(it);
+        }
+        return result;
+    }
+
+    // Batch runner of the async queue: send the whole batch on one
+    // connection, return it, then complete the callbacks in order.
+    void runBatch(std::vector<AsyncQueries::Entry>& batch) {
+        std::vector<GameResult<QueryResult>> results;
+        results.reserve(batch.size());
+        if (!connected.load()) {
+            for (std::size_t i = 0; i < batch.size(); ++i) {
+                results.push_back(GameResult<QueryResult>::err(
+                    GameError(ErrorCode::NotConnected, "not connected to database")));
+            }
+        } else if (auto mgr = checkout()) {
+            for (const auto& entry : batch) {
+                results.push_back(runQuery(*mgr, entry.sql));
+            }
+            checkin(mgr.get());
+        } else {
+            for (std::size_t i = 0; i < batch.size(); ++i) {
+                results.push_back(GameResult<QueryResult>::err(GameError(
+                    ErrorCode::ConnectionPoolExhausted, "no available connections in pool")));
+            }
+        }
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            batch[i].onDone(std::move(results[i]));
+        }
+    }
+
     std::size_t countActive() const {
         std::lock_guard lock(poolMutex);
-        return static_cast<std::size_t>(std::count_if(
-            pool.begin(), pool.end(), [](const PooledConnection& c) { return c.inUse; }));
+        return busy;
     }
 };
 
@@ -390,19 +890,45 @@ GameResult<void> GameDatabase::connect(const DatabaseConfig& config) {
     }
 
     impl_->config = config;
+    {
+        std::lock_guard lock(impl_->poolMutex);
+        impl_->poolStats = {};
+    }
 
-    // Create minimum number of connections
-    for (uint32_t i = 0; i < config.minConnections; ++i) {
-        auto conn = impl_->createConnection();
-        if (!conn.manager) {
-            // Disconnect any connections we already made
-            disconnect();
-            return GameResult<void>::err(GameError(ErrorCode::DatabaseError,
-                                                   "failed to create connection " +
-                                                       std::to_string(i + 1) + "/" +
-                                                       std::to_string(config.minConnections)));
+    // Pre-warm the minimum number of connections.
+    auto warmed = impl_->openConnections(config.minConnections);
+    if (warmed.size() < config.minConnections) {
+        for (auto& conn : warmed) {
+            (void)conn.manager->disconnect_result();
+        }
+        return GameResult<void>::err(GameError(
+            ErrorCode::DatabaseError, "failed to create connections: opened " +
+                                          std::to_string(warmed.size()) + "/" +
+                                          std::to_string(config.minConnections)));
+    }
+    {
+        std::lock_guard lock(impl_->poolMutex);
+        for (auto& conn : warmed) {
+            impl_->adopt(std::move(conn));
         }
-        impl_->pool.push_back(std::move(conn));
+    }
+
+    {
+        AsyncQueryOptions options;
+        options.workers = config.maxConnections;
+        options.capacity = config.asyncQueueCapacity;
+        options.pipelineDepth = config.pipelineDepth;
+        options.defaultTimeout = config.asyncQueueTimeout;
+        auto* impl = impl_.get();
+        std::lock_guard lock(impl_->ioMutex);
+        impl_->io = std::make_shared<Impl::AsyncQueries>(
+            options, [impl](std::vector<Impl::AsyncQueries::Entry>& batch) {
+                impl->runBatch(batch);
+            });
+    }
+    {
+        std::lock_guard lock(impl_->publishedMutex);
+        impl_->published = {};  // The new queue counts from zero
     }
 
     impl_->connected.store(true);
@@ -416,6 +942,16 @@ GameResult<void> GameDatabase::connect(const DatabaseConfig& config) {
 void GameDatabase::disconnect() {
     impl_->connected.store(false);
 
+    // Queued queries finish (with NotConnected) before the pool goes away.
+    std::shared_ptr<Impl::AsyncQueries> io;
+    {
+        std::lock_guard lock(impl_->ioMutex);
+        io = std::move(impl_->io);
+    }
+    if (io) {
+        io->shutdown();
+    }
+
     std::lock_guard lock(impl_->poolMutex);
     for (auto& conn : impl_->pool) {
         if (conn.manager) {
@@ -423,6 +959,8 @@ void GameDatabase::disconnect() {
         }
     }
     impl_->pool.clear();
+    impl_->statements.clear();
+    impl_->busy = 0;
 }
 
 // ---------------------------------------------------------------------------
@@ -449,15 +987,39 @@ GameResult<QueryResult> GameDatabase::query(std::string_view sql) {
             GameError(ErrorCode::ConnectionPoolExhausted, "no available connections in pool"));
     }
 
-    auto result = mgr->select_query_result(std::string(sql));
+    auto result = Impl::runQuery(*mgr, std::string(sql));
     impl_->checkin(mgr.get());
+    return result;
+}
 
-    if (!result.is_ok()) {
-        return GameResult<QueryResult>::err(
-            GameError(ErrorCode::QueryFailed, result.error().message));
+// ---------------------------------------------------------------------------
+// queryStream()
+// ---------------------------------------------------------------------------
+
+GameResult<uint64_t> GameDatabase::queryStream(std::string_view sql,
+                                               const RowBatchCallback& onBatch,
+                                               std::size_t batchRows) {
+    if (!impl_->connected.load()) {
+        return GameResult<uint64_t>::err(
+            GameError(ErrorCode::NotConnected, "not connected to database"));
     }
 
-    return GameResult<QueryResult>::ok(convertResult(result.value()));
+    // The statement is wrapped, so it may not end in a terminator.
+    while (!sql.empty() &&
+           (sql.back() == ';' || std::isspace(static_cast<unsigned char>(sql.back())))) {
+        sql.remove_suffix(1);
+    }
+
+    auto mgr = impl_->checkout();
+    if (!mgr) {
+        return GameResult<uint64_t>::err(
+            GameError(ErrorCode::ConnectionPoolExhausted, "no available connections in pool"));
+    }
+
+    auto result =
+        impl_->runStream(*mgr, std::string(sql), onBatch, std::max<std::size_t>(batchRows, 1));
+    impl_->checkin(mgr.get());
+    return result;
 }
 
 // ---------------------------------------------------------------------------
@@ -487,14 +1049,75 @@ GameResult<uint64_t> GameDatabase::execute(std::string_view sql) {
 }
 
 // ---------------------------------------------------------------------------
-// queryAsync()
+// write()
+// ---------------------------------------------------------------------------
+
+GameResult<uint64_t> GameDatabase::write(const BatchWriter& batch) {
+    if (!impl_->connected.load()) {
+        return GameResult<uint64_t>::err(
+            GameError(ErrorCode::NotConnected, "not connected to database"));
+    }
+    if (batch.empty()) {
+        return GameResult<uint64_t>::ok(0);
+    }
+
+    auto mgr = impl_->checkout();
+    if (!mgr) {
+        return GameResult<uint64_t>::err(
+            GameError(ErrorCode::ConnectionPoolExhausted, "no available connections in pool"));
+    }
+
+    auto begun = mgr->begin_transaction();
+    if (!begun.is_ok()) {
+        impl_->checkin(mgr.get());
+        return GameResult<uint64_t>::err(
+            GameError(ErrorCode::TransactionFailed,
+                      "failed to begin transaction: " + begun.error().message));
+    }
+
+    auto result = sendBatch(*mgr, batch, impl_->config.dbType);
+    if (result.hasError()) {
+        (void)mgr->rollback_transaction();
+    } else if (auto committed = mgr->commit_transaction(); !committed.is_ok()) {
+        result = GameResult<uint64_t>::err(GameError(
+            ErrorCode::TransactionFailed, "commit failed: " + committed.error().message));
+    }
+    impl_->checkin(mgr.get());
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// queryAsync() / queryTask()
 // ---------------------------------------------------------------------------
 
 std::future<GameResult<QueryResult>> GameDatabase::queryAsync(std::string_view sql) {
-    auto sqlStr = std::string(sql);
-    return std::async(
-        std::launch::async,
-        [this, sqlStr = std::move(sqlStr)]() -> GameResult<QueryResult> { return query(sqlStr); });
+    auto promise = std::make_shared<std::promise<GameResult<QueryResult>>>();
+    auto future = promise->get_future();
+    queryAsync(sql, [promise](GameResult<QueryResult> result) {
+        promise->set_value(std::move(result));
+    });
+    return future;
+}
+
+QueryHandle GameDatabase::queryAsync(std::string_view sql, QueryCallback onDone,
+                                     std::chrono::milliseconds queueTimeout) {
+    std::shared_ptr<Impl::AsyncQueries> io;
+    {
+        std::lock_guard lock(impl_->ioMutex);
+        io = impl_->io;
+    }
+    if (io) {
+        // Rejected with NotConnected if disconnect() shut it down meanwhile.
+        return io->submit(std::string(sql), std::move(onDone), queueTimeout);
+    }
+    onDone(GameResult<QueryResult>::err(
+        GameError(ErrorCode::NotConnected, "not connected to database")));
+    return {};
+}
+
+Task<GameResult<QueryResult>> GameDatabase::queryTask(std::string sql) {
+    co_return co_await awaitCallback<GameResult<QueryResult>>(
+        [this, &sql](auto complete) { queryAsync(sql, std::move(complete)); });
 }
 
 // ---------------------------------------------------------------------------
@@ -515,8 +1138,38 @@ GameResult<PreparedStatement> GameDatabase::prepare(std::string_view sql) {
 // ---------------------------------------------------------------------------
 
 GameResult<QueryResult> GameDatabase::execute(const PreparedStatement& stmt) {
-    auto resolved = stmt.resolve();
-    return query(resolved);
+    if (impl_->config.dbType != DatabaseType::PostgreSQL || impl_->config.statementCacheSize == 0) {
+        return query(stmt.resolve());
+    }
+
+    if (!impl_->connected.load()) {
+        return GameResult<QueryResult>::err(
+            GameError(ErrorCode::NotConnected, "not connected to database"));
+    }
+
+    // Bound values in $N order, as EXECUTE arguments.
+    std::string args;
+    for (const auto& name : stmt.parameterNames()) {
+        const auto* value = stmt.binding(name);
+        if (value == nullptr) {
+            return GameResult<QueryResult>::err(
+                GameError(ErrorCode::PreparedStatementFailed, "unbound parameter $" + name));
+        }
+        if (!args.empty()) {
+            args += ", ";
+        }
+        args += toLiteral(*value);
+    }
+
+    auto mgr = impl_->checkout();
+    if (!mgr) {
+        return GameResult<QueryResult>::err(
+            GameError(ErrorCode::ConnectionPoolExhausted, "no available connections in pool"));
+    }
+
+    auto result = impl_->executePrepared(*mgr, stmt, args);
+    impl_->checkin(mgr.get());
+    return result;
 }
 
 // ---------------------------------------------------------------------------
@@ -545,6 +1198,7 @@ GameResult<Transaction> GameDatabase::beginTransaction() {
 
     auto txnImpl = std::make_unique<Transaction::Impl>();
     txnImpl->manager = mgr;
+    txnImpl->dbType = impl_->config.dbType;
     txnImpl->active = true;
     txnImpl->ownsConnection = true;
     // Capture raw Impl pointer for the return-to-pool callback
@@ -567,4 +1221,102 @@ std::size_t GameDatabase::poolSize() const noexcept {
     return impl_->pool.size();
 }
 
+void GameDatabase::maintainPool() {
+    if (!impl_->connected.load()) {
+        return;
+    }
+
+    std::vector<PooledConnection> retired;
+    std::size_t missing = 0;
+    {
+        std::lock_guard lock(impl_->poolMutex);
+        const auto& config = impl_->config;
+        const auto now = std::chrono::steady_clock::now();
+        for (auto it = impl_->pool.begin(); it != impl_->pool.end();) {
+            if (it->inUse) {
+                ++it;
+            } else if (it->expired(config, now)) {
+                retired.push_back(impl_->retire(it));
+                ++impl_->poolStats.lifetimeClosed;
+            } else if (impl_->pool.size() > config.minConnections &&
+                       it->idleTooLong(config, now)) {
+                retired.push_back(impl_->retire(it));
+                ++impl_->poolStats.idleClosed;
+            } else {
+                ++it;
+            }
+        }
+        const std::size_t present = impl_->pool.size() + impl_->opening;
+        missing = present < config.minConnections ? config.minConnections - present : 0;
+        impl_->opening += missing;
+    }
+
+    for (auto& conn : retired) {
+        (void)conn.manager->disconnect_result();
+    }
+    if (missing == 0) {
+        return;
+    }
+
+    auto opened = impl_->openConnections(missing);
+    std::lock_guard lock(impl_->poolMutex);
+    impl_->opening -= missing;
+    for (auto& conn : opened) {
+        if (impl_->connected.load()) {
+            impl_->adopt(std::move(conn));
+        } else {
+            (void)conn.manager->disconnect_result();  // disconnect() ran meanwhile
+        }
+    }
+    impl_->poolCv.notify_all();
+}
+
+ConnectionPoolStats GameDatabase::connectionPoolStats() const {
+    std::lock_guard lock(impl_->poolMutex);
+    return impl_->poolStats;
+}
+
+PreparedStatementStats GameDatabase::preparedStatementStats() const noexcept {
+    PreparedStatementStats stats;
+    stats.prepared = impl_->statementsPrepared.load(std::memory_order_relaxed);
+    stats.reused = impl_->statementsReused.load(std::memory_order_relaxed);
+    stats.evictions = impl_->statementEvictions.load(std::memory_order_relaxed);
+    return stats;
+}
+
+// ---------------------------------------------------------------------------
+// Asynchronous query metrics
+// ---------------------------------------------------------------------------
+
+AsyncQueryStats GameDatabase::asyncQueryStats() const {
+    std::lock_guard lock(impl_->ioMutex);
+    return impl_->io ? impl_->io->stats() : AsyncQueryStats{};
+}
+
+void GameDatabase::publishAsyncQueryMetrics(GameMetrics& metrics) {
+    AsyncQueryStats stats;
+    {
+        std::lock_guard lock(impl_->ioMutex);
+        if (!impl_->io) {
+            metrics.setGauge("cgs_db_async_queue_depth", 0.0);
+            return;  // Nothing new; connect() restarts the counters
+        }
+        stats = impl_->io->stats();
+    }
+    std::lock_guard lock(impl_->publishedMutex);
+    const auto& last = impl_->published;
+    metrics.incrementCounter("cgs_db_async_submitted_total", stats.submitted - last.submitted);
+    metrics.incrementCounter("cgs_db_async_rejected_total", stats.rejected - last.rejected);
+    metrics.incrementCounter("cgs_db_async_expired_total", stats.expired - last.expired);
+    metrics.incrementCounter("cgs_db_async_cancelled_total", stats.cancelled - last.cancelled);
+    metrics.incrementCounter("cgs_db_async_executed_total", stats.executed - last.executed);
+    metrics.incrementCounter("cgs_db_async_batches_total", stats.batches - last.batches);
+    metrics.incrementCounter(
+        "cgs_db_async_queue_wait_us_total",
+        static_cast<uint64_t>(stats.totalWait.count() - last.totalWait.count()));
+    metrics.setGauge("cgs_db_async_queue_depth", static_cast<double>(stats.queued));
+    metrics.setGauge("cgs_db_async_queue_max_wait_us", static_cast<double>(stats.maxWait.count()));
+    impl_->published = stats;
+}
+
 }  // namespace cgs::foundation
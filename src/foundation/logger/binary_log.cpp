@@ -0,0 +1,608 @@
+/// @file binary_log.cpp
+/// @brief BinaryLogWriter / BinaryLogReader and record rendering.
+
+#include "cgs/foundation/binary_log.hpp"
+
+#include "cgs/foundation/json_log_formatter.hpp"
+#include "cgs/foundation/payload_codec.hpp"
+#include "log_render.hpp"
+
+#include <array>
+#include <bit>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+
+namespace cgs::foundation {
+
+namespace {
+
+constexpr std::array<char, 8> kFileMagic = {'C', 'G', 'S', 'B', 'L', 'O', 'G', '\0'};
+constexpr uint32_t kFormatVersion = 1;
+constexpr std::size_t kFileHeaderBytes = 16;
+
+constexpr uint32_t kSegmentMagic = 0x47455342;  // "BSEG"
+constexpr std::size_t kSegmentHeaderBytes = 24;
+
+/// Larger segments are taken for damage rather than allocated.
+constexpr uint32_t kMaxSegmentBytes = 64u << 20;
+
+enum EntryTag : uint8_t {
+    kTagFormat = 0,  ///< varint id, string: defines a format id.
+    kTagRecord = 1
+};
+
+enum BinaryRecordFlags : uint8_t {
+    kBinaryFormat = 1,       ///< Format id and arguments instead of a message.
+    kBinaryContext = 2,      ///< A LogContext follows.
+    kBinaryCorrelation = 4,  ///< A correlation ID follows.
+};
+
+enum BinaryContextFields : uint8_t {
+    kBinaryEntity = 1,
+    kBinaryPlayer = 2,
+    kBinarySession = 4,
+    kBinaryTrace = 8
+};
+
+int64_t toNs(std::chrono::system_clock::time_point tp) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(tp.time_since_epoch()).count();
+}
+
+std::chrono::system_clock::time_point fromNs(int64_t ns) {
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            std::chrono::nanoseconds(ns)));
+}
+
+uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+void putU8(std::vector<uint8_t>& out, uint8_t value) {
+    out.push_back(value);
+}
+
+void putVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+void putString(std::vector<uint8_t>& out, std::string_view value) {
+    putVarint(out, value.size());
+    out.insert(out.end(), value.begin(), value.end());
+}
+
+template <typename T>
+void putRaw(uint8_t* out, T value) {
+    std::memcpy(out, &value, sizeof(value));
+}
+
+template <typename T>
+T getRaw(const uint8_t* in) {
+    T value;
+    std::memcpy(&value, in, sizeof(value));
+    return value;
+}
+
+void putArg(std::vector<uint8_t>& out, const LogArg& arg) {
+    putU8(out, static_cast<uint8_t>(arg.kind()));
+    switch (arg.kind()) {
+        case LogArg::Kind::Int:
+            putVarint(out, zigzag(arg.asInt()));
+            break;
+        case LogArg::Kind::Double: {
+            const auto bits = std::bit_cast<uint64_t>(arg.asDouble());
+            out.resize(out.size() + sizeof(bits));
+            putRaw(out.data() + out.size() - sizeof(bits), bits);
+            break;
+        }
+        case LogArg::Kind::String:
+            putString(out, arg.asString());
+            break;
+        default:
+            putVarint(out, arg.asUInt());
+            break;
+    }
+}
+
+void putContext(std::vector<uint8_t>& out, const LogContext& ctx) {
+    const bool hasEntity = ctx.entityId && ctx.entityId->isValid();
+    const bool hasPlayer = ctx.playerId && ctx.playerId->isValid();
+    const bool hasSession = ctx.sessionId && ctx.sessionId->isValid();
+    const bool hasTrace = ctx.traceId && !ctx.traceId->empty();
+    putU8(out, static_cast<uint8_t>((hasEntity ? kBinaryEntity : 0) |
+                                    (hasPlayer ? kBinaryPlayer : 0) |
+                                    (hasSession ? kBinarySession : 0) |
+                                    (hasTrace ? kBinaryTrace : 0)));
+    if (hasEntity) {
+        putVarint(out, ctx.entityId->value());
+    }
+    if (hasPlayer) {
+        putVarint(out, ctx.playerId->value());
+    }
+    if (hasSession) {
+        putVarint(out, ctx.sessionId->value());
+    }
+    if (hasTrace) {
+        putString(out, *ctx.traceId);
+    }
+    putVarint(out, ctx.extra.size());
+    for (const auto& [key, val] : ctx.extra) {
+        putString(out, key);
+        putString(out, val);
+    }
+}
+
+/// Bounds-checked reads over a decoded segment.  A read past the end
+/// sets failed() and yields zeros.
+class SegmentCursor {
+public:
+    SegmentCursor(std::span<const uint8_t> data, std::size_t pos) noexcept
+        : data_(data), pos_(pos) {}
+
+    uint8_t u8() noexcept {
+        if (pos_ >= data_.size()) {
+            failed_ = true;
+            return 0;
+        }
+        return data_[pos_++];
+    }
+
+    uint64_t varint() noexcept {
+        uint64_t value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            const uint8_t byte = u8();
+            value |= uint64_t{byte & 0x7Fu} << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        failed_ = true;
+        return 0;
+    }
+
+    std::string_view bytes(uint64_t size) noexcept {
+        if (size > data_.size() - pos_) {
+            failed_ = true;
+            pos_ = data_.size();
+            return {};
+        }
+        std::string_view value(reinterpret_cast<const char*>(data_.data() + pos_),
+                               static_cast<std::size_t>(size));
+        pos_ += static_cast<std::size_t>(size);
+        return value;
+    }
+
+    std::string_view str() noexcept { return bytes(varint()); }
+
+    [[nodiscard]] std::size_t pos() const noexcept { return pos_; }
+    [[nodiscard]] bool failed() const noexcept { return failed_; }
+
+private:
+    std::span<const uint8_t> data_;
+    std::size_t pos_;
+    bool failed_ = false;
+};
+
+bool getArg(SegmentCursor& in, std::vector<LogArg>& out) {
+    const uint8_t kind = in.u8();
+    switch (static_cast<LogArg::Kind>(kind)) {
+        case LogArg::Kind::Int:
+            out.emplace_back(unzigzag(in.varint()));
+            return true;
+        case LogArg::Kind::UInt:
+            out.emplace_back(in.varint());
+            return true;
+        case LogArg::Kind::Double: {
+            const auto raw = in.bytes(sizeof(uint64_t));
+            uint64_t bits = 0;
+            std::memcpy(&bits, raw.data(), raw.size());
+            out.emplace_back(std::bit_cast<double>(bits));
+            return true;
+        }
+        case LogArg::Kind::Bool:
+            out.emplace_back(in.varint() != 0);
+            return true;
+        case LogArg::Kind::Char:
+            out.emplace_back(static_cast<char>(in.varint()));
+            return true;
+        case LogArg::Kind::String:
+            out.emplace_back(in.str());
+            return true;
+    }
+    return false;
+}
+
+void getContext(SegmentCursor& in, LogContext& ctx) {
+    const uint8_t fields = in.u8();
+    if ((fields & kBinaryEntity) != 0) {
+        ctx.entityId = EntityId(in.varint());
+    }
+    if ((fields & kBinaryPlayer) != 0) {
+        ctx.playerId = PlayerId(in.varint());
+    }
+    if ((fields & kBinarySession) != 0) {
+        ctx.sessionId = SessionId(in.varint());
+    }
+    if ((fields & kBinaryTrace) != 0) {
+        ctx.traceId = std::string(in.str());
+    }
+    for (uint64_t n = in.varint(); n > 0 && !in.failed(); --n) {
+        auto key = in.str();
+        ctx.extra.emplace(key, in.str());
+    }
+}
+
+GameError corrupt(std::string message) {
+    return GameError(ErrorCode::LogFileCorrupt, std::move(message));
+}
+
+/// @return Whether @p header is a file header this version can read.
+bool validFileHeader(const char* header) {
+    return std::memcmp(header, kFileMagic.data(), kFileMagic.size()) == 0 &&
+           getRaw<uint32_t>(reinterpret_cast<const uint8_t*>(header) + 8) == kFormatVersion;
+}
+
+/// The record's context, with the correlation ID as trace ID when the
+/// context has none (as the live JSON output does).
+LogContext effectiveContext(const DecodedLogRecord& record) {
+    LogContext ctx = record.context.value_or(LogContext{});
+    if (!record.correlationId.empty() && !(ctx.traceId && !ctx.traceId->empty())) {
+        ctx.traceId = record.correlationId;
+    }
+    return ctx;
+}
+
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// BinaryLogWriter
+// ---------------------------------------------------------------------------
+GameResult<std::shared_ptr<BinaryLogWriter>> BinaryLogWriter::open(
+    const std::filesystem::path& path, BinaryLogConfig config) {
+    using Result = GameResult<std::shared_ptr<BinaryLogWriter>>;
+
+    std::error_code ec;
+    const auto existing = std::filesystem::file_size(path, ec);
+    if (!ec && existing > 0) {
+        std::ifstream in(path, std::ios::binary);
+        std::array<char, kFileHeaderBytes> header{};
+        if (!in.read(header.data(), header.size()) || !validFileHeader(header.data())) {
+            return Result::err(corrupt("not a binary log: " + path.string()));
+        }
+    }
+
+    std::FILE* file = std::fopen(path.string().c_str(), "ab");
+    if (file == nullptr) {
+        return Result::err(GameError(ErrorCode::LogFileOpenFailed,
+                                     "cannot open binary log: " + path.string()));
+    }
+    if (ec || existing == 0) {
+        std::array<uint8_t, kFileHeaderBytes> header{};
+        std::memcpy(header.data(), kFileMagic.data(), kFileMagic.size());
+        putRaw(header.data() + 8, kFormatVersion);
+        if (std::fwrite(header.data(), 1, header.size(), file) != header.size()) {
+            std::fclose(file);
+            return Result::err(GameError(ErrorCode::LogFileOpenFailed,
+                                         "cannot write binary log: " + path.string()));
+        }
+    }
+    return Result::ok(std::shared_ptr<BinaryLogWriter>(new BinaryLogWriter(file, path, config)));
+}
+
+BinaryLogWriter::BinaryLogWriter(std::FILE* file,
+                                 std::filesystem::path path,
+                                 BinaryLogConfig config)
+    : path_(std::move(path)), config_(config), file_(file) {
+    segment_.reserve(config_.segmentBytes + 256);
+}
+
+BinaryLogWriter::~BinaryLogWriter() {
+    std::lock_guard lock(mutex_);
+    sealLocked();
+    std::fclose(file_);
+}
+
+void BinaryLogWriter::append(const BinaryLogRecord& record) {
+    const int64_t ns = toNs(record.timestamp);
+    std::lock_guard lock(mutex_);
+
+    const int64_t maxAgeNs =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(config_.maxSegmentAge).count();
+    if (segmentRecords_ != 0 && ns - baseNs_ >= maxAgeNs) {
+        sealLocked();
+    }
+    if (segmentRecords_ == 0) {
+        baseNs_ = ns;
+        lastNs_ = ns;
+    }
+
+    uint32_t formatId = 0;
+    if (record.format != nullptr) {
+        auto [it, added] =
+            formatIds_.try_emplace(record.format, static_cast<uint32_t>(formatIds_.size()));
+        formatId = it->second;
+        if (added) {
+            putU8(segment_, kTagFormat);
+            putVarint(segment_, formatId);
+            putString(segment_, record.format);
+        }
+    }
+
+    const bool hasCorrelation = !record.correlationId.empty();
+    putU8(segment_, kTagRecord);
+    putU8(segment_,
+          static_cast<uint8_t>((static_cast<unsigned>(record.level) << 4) |
+                               static_cast<unsigned>(record.category)));
+    putU8(segment_,
+          static_cast<uint8_t>((record.format != nullptr ? kBinaryFormat : 0) |
+                               (record.context != nullptr ? kBinaryContext : 0) |
+                               (hasCorrelation ? kBinaryCorrelation : 0)));
+    putVarint(segment_, zigzag(ns - lastNs_));
+    lastNs_ = ns;
+
+    if (record.format != nullptr) {
+        putVarint(segment_, formatId);
+        putVarint(segment_, record.args.size());
+        for (const auto& arg : record.args) {
+            putArg(segment_, arg);
+        }
+    } else {
+        putString(segment_, record.message);
+    }
+    if (hasCorrelation) {
+        putString(segment_, record.correlationId);
+    }
+    if (record.context != nullptr) {
+        putContext(segment_, *record.context);
+    }
+
+    ++segmentRecords_;
+    ++stats_.records;
+    if (segment_.size() >= config_.segmentBytes) {
+        sealLocked();
+    }
+}
+
+void BinaryLogWriter::sealLocked() {
+    if (segmentRecords_ == 0) {
+        return;
+    }
+
+    packed_.assign(kSegmentHeaderBytes, 0);
+    if (config_.compress) {
+        packed_.reserve(kSegmentHeaderBytes + lz4CompressBound(segment_.size()));
+        compressLz4Block(segment_, packed_);
+    }
+    if (packed_.size() - kSegmentHeaderBytes >= segment_.size()) {
+        packed_.resize(kSegmentHeaderBytes);
+        packed_.insert(packed_.end(), segment_.begin(), segment_.end());
+    }
+
+    uint8_t* header = packed_.data();
+    putRaw(header, kSegmentMagic);
+    putRaw(header + 4, static_cast<uint32_t>(segment_.size()));
+    putRaw(header + 8, static_cast<uint32_t>(packed_.size() - kSegmentHeaderBytes));
+    putRaw(header + 12, segmentRecords_);
+    putRaw(header + 16, baseNs_);
+
+    if (std::fwrite(packed_.data(), 1, packed_.size(), file_) == packed_.size()) {
+        ++stats_.segments;
+        stats_.rawBytes += segment_.size();
+        stats_.storedBytes += packed_.size();
+    } else {
+        ++stats_.writeErrors;
+    }
+
+    segment_.clear();
+    formatIds_.clear();
+    segmentRecords_ = 0;
+}
+
+GameResult<void> BinaryLogWriter::flush() {
+    std::lock_guard lock(mutex_);
+    sealLocked();
+    if (std::fflush(file_) != 0) {
+        return GameResult<void>::err(
+            GameError(ErrorCode::LoggerFlushFailed, "failed to flush binary log"));
+    }
+    return GameResult<void>::ok();
+}
+
+BinaryLogStats BinaryLogWriter::stats() const {
+    std::lock_guard lock(mutex_);
+    return stats_;
+}
+
+// ---------------------------------------------------------------------------
+// BinaryLogReader
+// ---------------------------------------------------------------------------
+GameResult<BinaryLogReader> BinaryLogReader::open(const std::filesystem::path& path) {
+    auto in = std::make_unique<std::ifstream>(path, std::ios::binary);
+    if (!*in) {
+        return GameResult<BinaryLogReader>::err(
+            GameError(ErrorCode::LogFileOpenFailed, "cannot open binary log: " + path.string()));
+    }
+    return start(std::move(in));
+}
+
+GameResult<BinaryLogReader> BinaryLogReader::fromBytes(std::string bytes) {
+    return start(std::make_unique<std::istringstream>(std::move(bytes)));
+}
+
+GameResult<BinaryLogReader> BinaryLogReader::start(std::unique_ptr<std::istream> in) {
+    std::array<char, kFileHeaderBytes> header{};
+    if (!in->read(header.data(), header.size()) || !validFileHeader(header.data())) {
+        return GameResult<BinaryLogReader>::err(corrupt("not a binary log"));
+    }
+    return GameResult<BinaryLogReader>::ok(BinaryLogReader(std::move(in)));
+}
+
+GameResult<bool> BinaryLogReader::loadSegment() {
+    std::array<uint8_t, kSegmentHeaderBytes> header{};
+    in_->read(reinterpret_cast<char*>(header.data()), header.size());
+    if (in_->gcount() == 0) {
+        return GameResult<bool>::ok(false);
+    }
+    if (static_cast<std::size_t>(in_->gcount()) < header.size()) {
+        truncated_ = true;
+        return GameResult<bool>::ok(false);
+    }
+
+    const auto rawSize = getRaw<uint32_t>(header.data() + 4);
+    const auto storedSize = getRaw<uint32_t>(header.data() + 8);
+    if (getRaw<uint32_t>(header.data()) != kSegmentMagic || rawSize > kMaxSegmentBytes ||
+        storedSize > rawSize) {
+        return GameResult<bool>::err(corrupt("bad segment header"));
+    }
+
+    stored_.resize(storedSize);
+    in_->read(reinterpret_cast<char*>(stored_.data()), storedSize);
+    if (static_cast<std::size_t>(in_->gcount()) < storedSize) {
+        truncated_ = true;
+        return GameResult<bool>::ok(false);
+    }
+    if (storedSize < rawSize) {
+        if (!decompressLz4Block(stored_, rawSize, segment_)) {
+            return GameResult<bool>::err(corrupt("segment does not decompress"));
+        }
+    } else {
+        segment_.swap(stored_);
+    }
+
+    pos_ = 0;
+    recordsLeft_ = getRaw<uint32_t>(header.data() + 12);
+    lastNs_ = getRaw<int64_t>(header.data() + 16);
+    formats_.clear();
+    return GameResult<bool>::ok(true);
+}
+
+GameResult<bool> BinaryLogReader::next(DecodedLogRecord& out) {
+    while (recordsLeft_ == 0) {
+        auto loaded = loadSegment();
+        if (!loaded.hasValue() || !loaded.value()) {
+            return loaded;
+        }
+    }
+
+    SegmentCursor in(segment_, pos_);
+    uint8_t tag = in.u8();
+    while (tag == kTagFormat && !in.failed()) {
+        if (in.varint() != formats_.size()) {
+            return GameResult<bool>::err(corrupt("format ids out of order"));
+        }
+        formats_.emplace_back(in.str());
+        tag = in.u8();
+    }
+    if (in.failed() || tag != kTagRecord) {
+        return GameResult<bool>::err(corrupt("bad record tag"));
+    }
+
+    const uint8_t levelCategory = in.u8();
+    const uint8_t flags = in.u8();
+    if ((levelCategory >> 4) > static_cast<unsigned>(LogLevel::Off) ||
+        (levelCategory & 0x0Fu) >= kLogCategoryCount) {
+        return GameResult<bool>::err(corrupt("bad record level or category"));
+    }
+    lastNs_ += unzigzag(in.varint());
+    out.timestamp = fromNs(lastNs_);
+    out.level = static_cast<LogLevel>(levelCategory >> 4);
+    out.category = static_cast<LogCategory>(levelCategory & 0x0Fu);
+
+    out.message.clear();
+    if ((flags & kBinaryFormat) != 0) {
+        const uint64_t formatId = in.varint();
+        const uint64_t argCount = in.varint();
+        if (formatId >= formats_.size() || argCount > segment_.size()) {
+            return GameResult<bool>::err(corrupt("bad record format"));
+        }
+        args_.clear();
+        for (uint64_t i = 0; i < argCount; ++i) {
+            if (!getArg(in, args_)) {
+                return GameResult<bool>::err(corrupt("bad record argument"));
+            }
+        }
+        if (in.failed()) {
+            return GameResult<bool>::err(corrupt("record runs past its segment"));
+        }
+        detail::renderFormat(out.message, formats_[formatId].c_str(), args_);
+    } else {
+        out.message = in.str();
+    }
+
+    out.correlationId.clear();
+    if ((flags & kBinaryCorrelation) != 0) {
+        out.correlationId = in.str();
+    }
+    out.context.reset();
+    if ((flags & kBinaryContext) != 0) {
+        getContext(in, out.context.emplace());
+    }
+    if (in.failed()) {
+        return GameResult<bool>::err(corrupt("record runs past its segment"));
+    }
+
+    pos_ = in.pos();
+    --recordsLeft_;
+    return GameResult<bool>::ok(true);
+}
+
+// ---------------------------------------------------------------------------
+// Rendering
+// ---------------------------------------------------------------------------
+std::string renderLogText(const DecodedLogRecord& record) {
+    const auto epoch = record.timestamp.time_since_epoch();
+    const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(epoch);
+    const auto micros = std::chrono::duration_cast<std::chrono::microseconds>(epoch - seconds);
+
+    const std::time_t tt = std::chrono::system_clock::to_time_t(record.timestamp);
+    std::tm utc{};
+#if defined(_WIN32)
+    gmtime_s(&utc, &tt);
+#else
+    gmtime_r(&tt, &utc);
+#endif
+
+    char stamp[96];  // Oversized to satisfy GCC -Wformat-truncation (int range analysis)
+    std::snprintf(stamp,
+                  sizeof(stamp),
+                  "%04d-%02d-%02dT%02d:%02d:%02d.%06dZ",
+                  utc.tm_year + 1900,
+                  utc.tm_mon + 1,
+                  utc.tm_mday,
+                  utc.tm_hour,
+                  utc.tm_min,
+                  utc.tm_sec,
+                  static_cast<int>(micros.count()));
+
+    std::string line = stamp;
+    line += ' ';
+    line += logLevelName(record.level);
+    line += " [";
+    line += logCategoryName(record.category);
+    line += "] ";
+    line += record.message;
+    const std::string ctxStr = detail::formatContext(effectiveContext(record));
+    if (!ctxStr.empty()) {
+        line += " {";
+        line += ctxStr;
+        line += '}';
+    }
+    return line;
+}
+
+std::string renderLogJson(const DecodedLogRecord& record) {
+    return JsonLogFormatter::format(
+        record.level, record.category, record.message, effectiveContext(record), record.timestamp);
+}
+
+}  // namespace cgs::foundation
@@ -3,16 +3,26 @@
 
 #include "cgs/foundation/game_logger.hpp"
 
+#include "cgs/foundation/binary_log.hpp"
 #include "cgs/foundation/json_log_formatter.hpp"
+#include "cgs/foundation/spsc_queue.hpp"
+#include "log_render.hpp"
 
 // kcenon logger headers (hidden behind PIMPL)
+#include <algorithm>
 #include <array>
 #include <atomic>
+#include <bit>
+#include <charconv>
+#include <condition_variable>
+#include <cstring>
 #include <kcenon/common/interfaces/global_logger_registry.h>
 #include <kcenon/common/interfaces/logger_interface.h>
 #include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace cgs::foundation {
 
@@ -56,7 +66,7 @@ static constexpr std::array<LogLevel, kLogCategoryCount> kDefaultCategoryLevels
 // ---------------------------------------------------------------------------
 // Context serialization
 // ---------------------------------------------------------------------------
-static std::string formatContext(const LogContext& ctx) {
+std::string detail::formatContext(const LogContext& ctx) {
     std::ostringstream oss;
     bool first = true;
 
@@ -87,6 +97,280 @@ static std::string formatContext(const LogContext& ctx) {
     return oss.str();
 }
 
+// ---------------------------------------------------------------------------
+// logf() formatting
+// ---------------------------------------------------------------------------
+static void appendLogArg(std::string& out, const LogArg& arg) {
+    char buf[32];
+    std::to_chars_result result{buf, std::errc{}};
+    switch (arg.kind()) {
+        case LogArg::Kind::Int:
+            result = std::to_chars(buf, buf + sizeof(buf), arg.asInt());
+            break;
+        case LogArg::Kind::UInt:
+            result = std::to_chars(buf, buf + sizeof(buf), arg.asUInt());
+            break;
+        case LogArg::Kind::Double:
+            result = std::to_chars(buf, buf + sizeof(buf), arg.asDouble());
+            break;
+        case LogArg::Kind::Bool:
+            out += arg.asUInt() != 0 ? "true" : "false";
+            return;
+        case LogArg::Kind::Char:
+            out += static_cast<char>(arg.asUInt());
+            return;
+        case LogArg::Kind::String:
+            out += arg.asString();
+            return;
+    }
+    out.append(buf, result.ptr);
+}
+
+void detail::renderFormat(std::string& out, const char* format, std::span<const LogArg> args) {
+    std::size_t next = 0;
+    for (const char* p = format; *p != '\0'; ++p) {
+        if ((p[0] == '{' && p[1] == '{') || (p[0] == '}' && p[1] == '}')) {
+            out += *p++;
+        } else if (p[0] == '{' && p[1] == '}' && next < args.size()) {
+            appendLogArg(out, args[next++]);
+            ++p;
+        } else {
+            out += *p;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Async records
+// ---------------------------------------------------------------------------
+namespace {
+
+/// Source of async session ids.  Ids are never reused, so a thread's
+/// cached ring cannot be mistaken for one of a later session.
+std::atomic<uint64_t> gNextAsyncId{1};
+
+enum RecordFlags : uint8_t {
+    kRecordJson = 1,         ///< Format as JsonLogFormatter output.
+    kRecordCorrelation = 2,  ///< Encoding carries the caller's correlation ID.
+    kRecordContext = 4       ///< Encoding carries a LogContext.
+};
+
+enum ContextFields : uint8_t {
+    kContextEntity = 1,
+    kContextPlayer = 2,
+    kContextSession = 4,
+    kContextTrace = 8
+};
+
+/// One queued log call.  Its encoding (message text or logf() arguments,
+/// then correlation ID and context when flagged) lives inline unless it
+/// exceeds kInlineBytes.
+struct AsyncRecord {
+    static constexpr std::size_t kInlineBytes = 192;
+
+    std::chrono::system_clock::time_point timestamp;
+    const char* format = nullptr;  ///< logf() format; nullptr for a plain message.
+    std::unique_ptr<char[]> spill;
+    uint32_t size = 0;
+    LogLevel level = LogLevel::Info;
+    LogCategory category = LogCategory::Core;
+    uint8_t argCount = 0;
+    uint8_t flags = 0;
+    std::array<char, kInlineBytes> inlineBytes;
+
+    [[nodiscard]] const char* data() const noexcept {
+        return spill ? spill.get() : inlineBytes.data();
+    }
+};
+
+/// Writes a record encoding into @p out, or only measures it when null.
+class RecordWriter {
+public:
+    explicit RecordWriter(char* out = nullptr) noexcept : out_(out) {}
+
+    void bytes(const void* data, std::size_t size) noexcept {
+        if (out_ != nullptr && size != 0) {
+            std::memcpy(out_ + pos_, data, size);
+        }
+        pos_ += size;
+    }
+
+    void u8(uint8_t value) noexcept { bytes(&value, sizeof(value)); }
+
+    void u64(uint64_t value) noexcept { bytes(&value, sizeof(value)); }
+
+    void str(std::string_view value) noexcept {
+        const auto size = static_cast<uint32_t>(value.size());
+        bytes(&size, sizeof(size));
+        bytes(value.data(), value.size());
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return pos_; }
+
+private:
+    char* out_;
+    std::size_t pos_ = 0;
+};
+
+/// Reads back what RecordWriter wrote.
+class RecordReader {
+public:
+    explicit RecordReader(const char* data) noexcept : data_(data) {}
+
+    uint8_t u8() noexcept {
+        uint8_t value = 0;
+        take(&value, sizeof(value));
+        return value;
+    }
+
+    uint64_t u64() noexcept {
+        uint64_t value = 0;
+        take(&value, sizeof(value));
+        return value;
+    }
+
+    std::string_view str() noexcept {
+        uint32_t size = 0;
+        take(&size, sizeof(size));
+        std::string_view value(data_ + pos_, size);
+        pos_ += size;
+        return value;
+    }
+
+private:
+    void take(void* out, std::size_t size) noexcept {
+        std::memcpy(out, data_ + pos_, size);
+        pos_ += size;
+    }
+
+    const char* data_;
+    std::size_t pos_ = 0;
+};
+
+void encodeArgs(RecordWriter& writer, std::span<const LogArg> args) {
+    for (const auto& arg : args) {
+        writer.u8(static_cast<uint8_t>(arg.kind()));
+        switch (arg.kind()) {
+            case LogArg::Kind::Int:
+                writer.u64(static_cast<uint64_t>(arg.asInt()));
+                break;
+            case LogArg::Kind::Double:
+                writer.u64(std::bit_cast<uint64_t>(arg.asDouble()));
+                break;
+            case LogArg::Kind::String:
+                writer.str(arg.asString());
+                break;
+            default:
+                writer.u64(arg.asUInt());
+                break;
+        }
+    }
+}
+
+void decodeArgs(RecordReader& reader, std::size_t count, std::vector<LogArg>& out) {
+    out.clear();
+    for (std::size_t i = 0; i < count; ++i) {
+        switch (static_cast<LogArg::Kind>(reader.u8())) {
+            case LogArg::Kind::Int:
+                out.emplace_back(static_cast<int64_t>(reader.u64()));
+                break;
+            case LogArg::Kind::UInt:
+                out.emplace_back(reader.u64());
+                break;
+            case LogArg::Kind::Double:
+                out.emplace_back(std::bit_cast<double>(reader.u64()));
+                break;
+            case LogArg::Kind::Bool:
+                out.emplace_back(reader.u64() != 0);
+                break;
+            case LogArg::Kind::Char:
+                out.emplace_back(static_cast<char>(reader.u64()));
+                break;
+            case LogArg::Kind::String:
+                out.emplace_back(reader.str());
+                break;
+        }
+    }
+}
+
+void encodeContext(RecordWriter& writer, const LogContext& ctx) {
+    const bool hasEntity = ctx.entityId && ctx.entityId->isValid();
+    const bool hasPlayer = ctx.playerId && ctx.playerId->isValid();
+    const bool hasSession = ctx.sessionId && ctx.sessionId->isValid();
+    const bool hasTrace = ctx.traceId && !ctx.traceId->empty();
+    writer.u8(static_cast<uint8_t>((hasEntity ? kContextEntity : 0) |
+                                   (hasPlayer ? kContextPlayer : 0) |
+                                   (hasSession ? kContextSession : 0) |
+                                   (hasTrace ? kContextTrace : 0)));
+    if (hasEntity) {
+        writer.u64(ctx.entityId->value());
+    }
+    if (hasPlayer) {
+        writer.u64(ctx.playerId->value());
+    }
+    if (hasSession) {
+        writer.u64(ctx.sessionId->value());
+    }
+    if (hasTrace) {
+        writer.str(*ctx.traceId);
+    }
+    writer.u64(ctx.extra.size());
+    for (const auto& [key, val] : ctx.extra) {
+        writer.str(key);
+        writer.str(val);
+    }
+}
+
+void decodeContext(RecordReader& reader, LogContext& ctx) {
+    const uint8_t fields = reader.u8();
+    ctx.entityId = (fields & kContextEntity) != 0 ? std::optional(EntityId(reader.u64()))
+                                                  : std::nullopt;
+    ctx.playerId = (fields & kContextPlayer) != 0 ? std::optional(PlayerId(reader.u64()))
+                                                  : std::nullopt;
+    ctx.sessionId = (fields & kContextSession) != 0 ? std::optional(SessionId(reader.u64()))
+                                                    : std::nullopt;
+    if ((fields & kContextTrace) != 0) {
+        ctx.traceId = std::string(reader.str());
+    } else {
+        ctx.traceId.reset();
+    }
+    ctx.extra.clear();
+    for (uint64_t n = reader.u64(); n > 0; --n) {
+        auto key = reader.str();
+        ctx.extra.emplace(key, reader.str());
+    }
+}
+
+/// Ring of one thread's pending records.  Counters are written only by
+/// the owning thread.
+struct AsyncRing {
+    AsyncRing(std::size_t capacity, std::thread::id owner) : queue(capacity), owner(owner) {}
+
+    SpscQueue<AsyncRecord> queue;
+    std::thread::id owner;
+    uint32_t sampleCounter = 0;
+    std::atomic<uint64_t> enqueued{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> sampledOut{0};
+    std::atomic<uint64_t> blocked{0};
+    std::atomic<uint64_t> spilled{0};
+};
+
+/// Single-writer increment (no locked read-modify-write).
+void bump(std::atomic<uint64_t>& counter) {
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+/// Ring of the most recently used async session on this thread.
+struct LocalRingCache {
+    uint64_t session = 0;
+    AsyncRing* ring = nullptr;
+};
+
+thread_local LocalRingCache tLocalRing;
+
+}  // namespace
+
 // ---------------------------------------------------------------------------
 // Impl
 // ---------------------------------------------------------------------------
@@ -100,6 +384,46 @@ struct GameLogger::Impl {
     // JSON output mode (SRS-NFR-019)
     std::atomic<bool> jsonMode{false};
 
+    // Rate limiting: one lock-free state and one fallback site per category
+    struct RateLimitState {
+        std::atomic<bool> active{false};
+        std::atomic<uint32_t> sampleEvery{1};
+        std::atomic<int64_t> emissionNs{0};   // Token refill interval, 0 for none
+        std::atomic<int64_t> toleranceNs{0};  // (burst - 1) * emissionNs
+        std::atomic<int64_t> summaryNs{0};
+        std::atomic<uint64_t> suppressed{0};
+    };
+    std::array<RateLimitState, kLogCategoryCount> rateLimits;
+    std::array<LogSite, kLogCategoryCount> categorySites;
+    std::array<LogRateLimit, kLogCategoryCount> rateLimitConfigs;  // Guarded by rateLimitMutex
+    std::mutex rateLimitMutex;
+
+    // Async mode: per-thread rings drained by one writer thread
+    std::atomic<bool> asyncMode{false};
+    std::atomic<uint64_t> asyncId{0};
+    AsyncLogConfig asyncConfig;
+    std::mutex modeMutex;
+
+    std::mutex ringsMutex;  // Guards rings and retired
+    std::vector<std::unique_ptr<AsyncRing>> rings;
+    AsyncLogStats retired;  // Producer counters of earlier async sessions
+
+    // Binary sink: owned under modeMutex, read lock-free on the hot path
+    std::shared_ptr<BinaryLogWriter> binarySinkOwner;
+    std::atomic<BinaryLogWriter*> binarySink{nullptr};
+
+    std::mutex drainMutex;  // The rings' single consumer
+    std::atomic<uint64_t> written{0};
+    std::string line;
+    std::string message;
+    std::vector<LogArg> args;
+    LogContext context;
+
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    bool stopWriter = false;
+    std::thread writer;
+
     Impl() {
         for (std::size_t i = 0; i < kLogCategoryCount; ++i) {
             categoryLevels[i].store(kDefaultCategoryLevels[i], std::memory_order_relaxed);
@@ -108,6 +432,270 @@ struct GameLogger::Impl {
         }
     }
 
+    ~Impl() { stopAsync(); }
+
+    AsyncRing& localRing() {
+        const uint64_t id = asyncId.load(std::memory_order_acquire);
+        if (tLocalRing.session == id) {
+            return *tLocalRing.ring;
+        }
+
+        const auto self = std::this_thread::get_id();
+        std::lock_guard lock(ringsMutex);
+        AsyncRing* ring = nullptr;
+        for (const auto& candidate : rings) {
+            if (candidate->owner == self) {
+                ring = candidate.get();
+                break;
+            }
+        }
+        if (ring == nullptr) {
+            rings.push_back(std::make_unique<AsyncRing>(asyncConfig.ringCapacity, self));
+            ring = rings.back().get();
+        }
+        tLocalRing = LocalRingCache{id, ring};
+        return *ring;
+    }
+
+    /// Producer side of async mode: record one call on this thread's ring.
+    void enqueue(LogLevel level,
+                 LogCategory cat,
+                 const char* format,
+                 std::string_view msg,
+                 std::span<const LogArg> fmtArgs,
+                 const LogContext* ctx) {
+        auto& ring = localRing();
+        if (asyncConfig.overflow == LogOverflowPolicy::Sample &&
+            ring.queue.size() >= ring.queue.capacity() / 4 * 3 &&
+            ring.sampleCounter++ % asyncConfig.sampleRate != 0) {
+            bump(ring.sampledOut);
+            return;
+        }
+
+        AsyncRecord record;
+        record.timestamp = std::chrono::system_clock::now();
+        record.format = format;
+        record.level = level;
+        record.category = cat;
+        record.argCount = static_cast<uint8_t>(fmtArgs.size());
+
+        std::string_view correlation;
+        const bool json = jsonMode.load(std::memory_order_acquire);
+        if (json) {
+            record.flags |= kRecordJson;
+        }
+        if (json || binarySink.load(std::memory_order_acquire) != nullptr) {
+            correlation = CorrelationScope::current();
+            if (!correlation.empty()) {
+                record.flags |= kRecordCorrelation;
+            }
+        }
+        if (ctx != nullptr) {
+            record.flags |= kRecordContext;
+        }
+
+        auto encode = [&](RecordWriter& writer) {
+            if (format == nullptr) {
+                writer.str(msg);
+            } else {
+                encodeArgs(writer, fmtArgs);
+            }
+            if ((record.flags & kRecordCorrelation) != 0) {
+                writer.str(correlation);
+            }
+            if (ctx != nullptr) {
+                encodeContext(writer, *ctx);
+            }
+        };
+        RecordWriter measure;
+        encode(measure);
+        record.size = static_cast<uint32_t>(measure.size());
+        char* out = record.inlineBytes.data();
+        if (measure.size() > AsyncRecord::kInlineBytes) {
+            record.spill = std::make_unique_for_overwrite<char[]>(measure.size());
+            out = record.spill.get();
+            bump(ring.spilled);
+        }
+        RecordWriter writer(out);
+        encode(writer);
+
+        if (!ring.queue.tryPush(std::move(record))) {
+            if (asyncConfig.overflow != LogOverflowPolicy::Block) {
+                bump(ring.dropped);
+                return;
+            }
+            bump(ring.blocked);
+            do {
+                wake.notify_one();
+                std::this_thread::yield();
+            } while (!ring.queue.tryPush(std::move(record)));
+        }
+        bump(ring.enqueued);
+    }
+
+    /// Consumer side: format and write every queued record.
+    /// @return Records written.
+    std::size_t drain() {
+        std::lock_guard lock(drainMutex);
+        std::size_t count = 0;
+        AsyncRecord record;
+        for (std::size_t i = 0;; ++i) {
+            AsyncRing* ring = nullptr;
+            {
+                std::lock_guard ringsLock(ringsMutex);
+                if (i >= rings.size()) {
+                    break;
+                }
+                ring = rings[i].get();
+            }
+            while (ring->queue.tryPop(record)) {
+                write(record);
+                record.spill.reset();
+                ++count;
+            }
+        }
+        written.fetch_add(count, std::memory_order_relaxed);
+        return count;
+    }
+
+    void write(const AsyncRecord& record) {
+        RecordReader reader(record.data());
+        std::string_view text;
+        if (record.format == nullptr) {
+            text = reader.str();
+        } else {
+            decodeArgs(reader, record.argCount, args);
+        }
+        std::string_view correlation;
+        if ((record.flags & kRecordCorrelation) != 0) {
+            correlation = reader.str();
+        }
+        const bool hasContext = (record.flags & kRecordContext) != 0;
+        if (hasContext) {
+            decodeContext(reader, context);
+        }
+
+        if (auto* sink = binarySink.load(std::memory_order_acquire)) {
+            BinaryLogRecord out;
+            out.timestamp = record.timestamp;
+            out.level = record.level;
+            out.category = record.category;
+            out.format = record.format;
+            out.message = text;
+            if (record.format != nullptr) {
+                out.args = args;
+            }
+            out.context = hasContext ? &context : nullptr;
+            out.correlationId = correlation;
+            sink->append(out);
+            return;
+        }
+
+        message.clear();
+        if (record.format == nullptr) {
+            message += text;
+        } else {
+            detail::renderFormat(message, record.format, args);
+        }
+
+        auto logger = getLogger(record.category);
+        auto kcLevel = mapLevel(record.level);
+
+        if ((record.flags & kRecordJson) != 0) {
+            if (!hasContext) {
+                context = LogContext{};
+            }
+            if (!correlation.empty() && !(context.traceId && !context.traceId->empty())) {
+                context.traceId = std::string(correlation);
+            }
+            logger->log(kcLevel,
+                        JsonLogFormatter::format(
+                            record.level, record.category, message, context, record.timestamp));
+            return;
+        }
+
+        // Same layout as log() / logWithContext()
+        line.clear();
+        line += '[';
+        line += logCategoryName(record.category);
+        line += "] ";
+        line += message;
+        if (hasContext) {
+            std::string ctxStr = detail::formatContext(context);
+            if (!ctxStr.empty()) {
+                line += " {";
+                line += ctxStr;
+                line += '}';
+            }
+        }
+        logger->log(kcLevel, line);
+    }
+
+    void writerLoop() {
+        while (true) {
+            const std::size_t count = drain();
+            std::unique_lock lock(wakeMutex);
+            if (stopWriter) {
+                return;
+            }
+            if (count == 0) {
+                wake.wait_for(lock, asyncConfig.idleWait);
+            }
+        }
+    }
+
+    void stopAsync() {
+        if (!writer.joinable()) {
+            return;
+        }
+        asyncMode.store(false, std::memory_order_release);
+        {
+            std::lock_guard lock(wakeMutex);
+            stopWriter = true;
+        }
+        wake.notify_one();
+        writer.join();
+        drain();
+        std::lock_guard lock(ringsMutex);
+        addRingStats(retired);
+        rings.clear();
+    }
+
+    /// Add the producer counters of the current rings to @p stats.
+    void addRingStats(AsyncLogStats& stats) const {
+        for (const auto& ring : rings) {
+            stats.enqueued += ring->enqueued.load(std::memory_order_relaxed);
+            stats.dropped += ring->dropped.load(std::memory_order_relaxed);
+            stats.sampledOut += ring->sampledOut.load(std::memory_order_relaxed);
+            stats.blocked += ring->blocked.load(std::memory_order_relaxed);
+            stats.spilled += ring->spilled.load(std::memory_order_relaxed);
+        }
+    }
+
+    /// Synchronous binary sink path.  @return false without a sink.
+    bool writeBinary(LogLevel level,
+                     LogCategory cat,
+                     const char* format,
+                     std::string_view msg,
+                     std::span<const LogArg> fmtArgs,
+                     const LogContext* ctx) {
+        auto* sink = binarySink.load(std::memory_order_acquire);
+        if (sink == nullptr) {
+            return false;
+        }
+        BinaryLogRecord record;
+        record.timestamp = std::chrono::system_clock::now();
+        record.level = level;
+        record.category = cat;
+        record.format = format;
+        record.message = msg;
+        record.args = fmtArgs;
+        record.context = ctx;
+        record.correlationId = CorrelationScope::current();
+        sink->append(record);
+        return true;
+    }
+
     std::shared_ptr<kcenon::common::interfaces::ILogger> getLogger(LogCategory cat) const {
         auto idx = static_cast<std::size_t>(cat);
         if (idx >= kLogCategoryCount) {
@@ -142,7 +730,25 @@ GameLogger& GameLogger::operator=(GameLogger&&) noexcept = default;
 // log()
 // ---------------------------------------------------------------------------
 void GameLogger::log(LogLevel level, LogCategory cat, std::string_view msg) {
-    if (!isEnabled(level, cat)) {
+    if (!isEnabled(level, cat) || !admit(nullptr, level, cat)) {
+        return;
+    }
+    write(level, cat, msg);
+}
+
+void GameLogger::log(LogSite& site, LogLevel level, LogCategory cat, std::string_view msg) {
+    if (!isEnabled(level, cat) || !admit(&site, level, cat)) {
+        return;
+    }
+    write(level, cat, msg);
+}
+
+void GameLogger::write(LogLevel level, LogCategory cat, std::string_view msg) {
+    if (impl_->asyncMode.load(std::memory_order_acquire)) {
+        impl_->enqueue(level, cat, nullptr, msg, {}, nullptr);
+        return;
+    }
+    if (impl_->writeBinary(level, cat, nullptr, msg, {}, nullptr)) {
         return;
     }
 
@@ -172,7 +778,15 @@ void GameLogger::logWithContext(LogLevel level,
                                 LogCategory cat,
                                 std::string_view msg,
                                 const LogContext& ctx) {
-    if (!isEnabled(level, cat)) {
+    if (!isEnabled(level, cat) || !admit(nullptr, level, cat)) {
+        return;
+    }
+
+    if (impl_->asyncMode.load(std::memory_order_acquire)) {
+        impl_->enqueue(level, cat, nullptr, msg, {}, &ctx);
+        return;
+    }
+    if (impl_->writeBinary(level, cat, nullptr, msg, {}, &ctx)) {
         return;
     }
 
@@ -184,7 +798,7 @@ void GameLogger::logWithContext(LogLevel level,
         return;
     }
 
-    std::string ctxStr = formatContext(ctx);
+    std::string ctxStr = detail::formatContext(ctx);
 
     // Format: [Category] message {key=val, ...}
     std::string formatted;
@@ -202,6 +816,198 @@ void GameLogger::logWithContext(LogLevel level,
     logger->log(kcLevel, formatted);
 }
 
+// ---------------------------------------------------------------------------
+// logf()
+// ---------------------------------------------------------------------------
+void GameLogger::logArgs(LogSite* site,
+                         LogLevel level,
+                         LogCategory cat,
+                         const char* format,
+                         std::span<const LogArg> args) {
+    if (!admit(site, level, cat)) {
+        return;
+    }
+
+    if (impl_->asyncMode.load(std::memory_order_acquire)) {
+        impl_->enqueue(level, cat, format, {}, args, nullptr);
+        return;
+    }
+    if (impl_->writeBinary(level, cat, format, {}, args, nullptr)) {
+        return;
+    }
+
+    std::string msg;
+    detail::renderFormat(msg, format, args);
+    write(level, cat, msg);
+}
+
+// ---------------------------------------------------------------------------
+// Rate limiting
+// ---------------------------------------------------------------------------
+static int64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+bool GameLogger::admit(LogSite* site, LogLevel level, LogCategory cat) {
+    const auto idx = static_cast<std::size_t>(cat);
+    if (idx >= kLogCategoryCount) {
+        return false;
+    }
+    auto& limit = impl_->rateLimits[idx];
+    if (!limit.active.load(std::memory_order_relaxed)) {
+        return true;
+    }
+    LogSite& at = site != nullptr ? *site : impl_->categorySites[idx];
+    const int64_t now = steadyNowNs();
+
+    bool pass = true;
+    const uint32_t every = limit.sampleEvery.load(std::memory_order_relaxed);
+    if (every > 1 && at.calls_.fetch_add(1, std::memory_order_relaxed) % every != 0) {
+        pass = false;
+    }
+
+    // Token bucket as GCRA: one arrival-time word, no separate refill.
+    const int64_t emission = limit.emissionNs.load(std::memory_order_relaxed);
+    if (pass && emission > 0) {
+        const int64_t tolerance = limit.toleranceNs.load(std::memory_order_relaxed);
+        int64_t tat = at.tat_.load(std::memory_order_relaxed);
+        while (true) {
+            const int64_t base = std::max(tat, now);
+            if (base - now > tolerance) {
+                pass = false;
+                break;
+            }
+            if (at.tat_.compare_exchange_weak(tat, base + emission, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+    }
+
+    if (!pass) {
+        at.suppressed_.fetch_add(1, std::memory_order_relaxed);
+        limit.suppressed.fetch_add(1, std::memory_order_relaxed);
+        int64_t unset = 0;
+        at.summaryAt_.compare_exchange_strong(unset, now, std::memory_order_relaxed);
+    }
+
+    // At most one summary per site and interval, written by whichever
+    // call first finds it due.
+    if (at.suppressed_.load(std::memory_order_relaxed) != 0) {
+        int64_t windowStart = at.summaryAt_.load(std::memory_order_relaxed);
+        if (now - windowStart >= limit.summaryNs.load(std::memory_order_relaxed) &&
+            at.summaryAt_.compare_exchange_strong(windowStart, now, std::memory_order_relaxed)) {
+            const uint64_t count = at.suppressed_.exchange(0, std::memory_order_relaxed);
+            if (count != 0) {
+                std::string summary = "suppressed " + std::to_string(count) + " messages";
+                if (at.file_ != nullptr) {
+                    const char* slash = std::strrchr(at.file_, '/');
+                    summary += " from ";
+                    summary += slash != nullptr ? slash + 1 : at.file_;
+                    summary += ':';
+                    summary += std::to_string(at.line_);
+                }
+                write(level, cat, summary);
+            }
+        }
+    }
+    return pass;
+}
+
+void GameLogger::setCategoryRateLimit(LogCategory cat, LogRateLimit limit) {
+    const auto idx = static_cast<std::size_t>(cat);
+    if (idx >= kLogCategoryCount) {
+        return;
+    }
+    if (limit.sampleEvery == 0) {
+        limit.sampleEvery = 1;
+    }
+    if (limit.burst > 0 && limit.perSecond == 0) {
+        limit.perSecond = 1;
+    }
+
+    std::lock_guard lock(impl_->rateLimitMutex);
+    impl_->rateLimitConfigs[idx] = limit;
+    auto& state = impl_->rateLimits[idx];
+    const int64_t emission = limit.burst > 0 ? 1'000'000'000 / int64_t{limit.perSecond} : 0;
+    state.sampleEvery.store(limit.sampleEvery, std::memory_order_relaxed);
+    state.emissionNs.store(emission, std::memory_order_relaxed);
+    state.toleranceNs.store(emission * (int64_t{limit.burst} - 1), std::memory_order_relaxed);
+    state.summaryNs.store(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(limit.summaryInterval).count(),
+        std::memory_order_relaxed);
+    state.active.store(limit.active(), std::memory_order_relaxed);
+}
+
+LogRateLimit GameLogger::getCategoryRateLimit(LogCategory cat) const {
+    const auto idx = static_cast<std::size_t>(cat);
+    if (idx >= kLogCategoryCount) {
+        return {};
+    }
+    std::lock_guard lock(impl_->rateLimitMutex);
+    return impl_->rateLimitConfigs[idx];
+}
+
+uint64_t GameLogger::suppressedCount(LogCategory cat) const {
+    const auto idx = static_cast<std::size_t>(cat);
+    if (idx >= kLogCategoryCount) {
+        return 0;
+    }
+    return impl_->rateLimits[idx].suppressed.load(std::memory_order_relaxed);
+}
+
+// ---------------------------------------------------------------------------
+// Async mode
+// ---------------------------------------------------------------------------
+void GameLogger::setAsyncMode(bool enabled, AsyncLogConfig config) {
+    std::lock_guard lock(impl_->modeMutex);
+    impl_->stopAsync();
+    if (!enabled) {
+        return;
+    }
+
+    if (config.sampleRate == 0) {
+        config.sampleRate = 1;
+    }
+    impl_->asyncConfig = config;
+    impl_->asyncId.store(gNextAsyncId.fetch_add(1, std::memory_order_relaxed),
+                         std::memory_order_release);
+    impl_->stopWriter = false;
+    impl_->writer = std::thread([impl = impl_.get()] { impl->writerLoop(); });
+    impl_->asyncMode.store(true, std::memory_order_release);
+}
+
+bool GameLogger::isAsyncMode() const {
+    return impl_->asyncMode.load(std::memory_order_acquire);
+}
+
+AsyncLogStats GameLogger::asyncStats() const {
+    std::lock_guard lock(impl_->ringsMutex);
+    AsyncLogStats stats = impl_->retired;
+    impl_->addRingStats(stats);
+    stats.written = impl_->written.load(std::memory_order_relaxed);
+    return stats;
+}
+
+// ---------------------------------------------------------------------------
+// Binary sink
+// ---------------------------------------------------------------------------
+void GameLogger::setBinarySink(std::shared_ptr<BinaryLogWriter> sink) {
+    std::lock_guard lock(impl_->modeMutex);
+    if (impl_->asyncMode.load(std::memory_order_acquire)) {
+        impl_->drain();
+    }
+    // The writer thread appends only while holding drainMutex.
+    std::lock_guard drainLock(impl_->drainMutex);
+    impl_->binarySink.store(sink.get(), std::memory_order_release);
+    impl_->binarySinkOwner = std::move(sink);
+}
+
+bool GameLogger::hasBinarySink() const {
+    return impl_->binarySink.load(std::memory_order_acquire) != nullptr;
+}
+
 // ---------------------------------------------------------------------------
 // JSON mode (SRS-NFR-019)
 // ---------------------------------------------------------------------------
@@ -244,6 +1050,22 @@ bool GameLogger::isEnabled(LogLevel level, LogCategory cat) const {
 // flush()
 // ---------------------------------------------------------------------------
 GameResult<void> GameLogger::flush() {
+    if (impl_->asyncMode.load(std::memory_order_acquire)) {
+        impl_->drain();
+    }
+
+    std::shared_ptr<BinaryLogWriter> sink;
+    {
+        std::lock_guard lock(impl_->modeMutex);
+        sink = impl_->binarySinkOwner;
+    }
+    if (sink) {
+        auto flushed = sink->flush();
+        if (!flushed) {
+            return flushed;
+        }
+    }
+
     auto& registry = kcenon::common::interfaces::GlobalLoggerRegistry::instance();
     auto logger = registry.get_default_logger();
     auto result = logger->flush();
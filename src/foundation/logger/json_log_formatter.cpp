@@ -3,6 +3,8 @@
 
 #include "cgs/foundation/json_log_formatter.hpp"
 
+#include "cgs/foundation/json_escape.hpp"
+
 #include <chrono>
 #include <cstdint>
 #include <random>
@@ -17,53 +19,15 @@ namespace cgs::foundation {
 // ---------------------------------------------------------------------------
 static void appendJsonString(std::string& out, std::string_view value) {
     out += '"';
-    for (char c : value) {
-        switch (c) {
-            case '"':
-                out += "\\\"";
-                break;
-            case '\\':
-                out += "\\\\";
-                break;
-            case '\b':
-                out += "\\b";
-                break;
-            case '\f':
-                out += "\\f";
-                break;
-            case '\n':
-                out += "\\n";
-                break;
-            case '\r':
-                out += "\\r";
-                break;
-            case '\t':
-                out += "\\t";
-                break;
-            default:
-                if (static_cast<unsigned char>(c) < 0x20) {
-                    // Control characters: \u00XX
-                    char buf[8];
-                    std::snprintf(buf,
-                                  sizeof(buf),
-                                  "\\u%04x",
-                                  static_cast<unsigned>(static_cast<unsigned char>(c)));
-                    out += buf;
-                } else {
-                    out += c;
-                }
-                break;
-        }
-    }
+    appendJsonEscaped(out, value);
     out += '"';
 }
 
 // ---------------------------------------------------------------------------
 // ISO 8601 timestamp with millisecond precision (UTC)
 // ---------------------------------------------------------------------------
-static std::string formatTimestamp() {
+static std::string formatTimestamp(std::chrono::system_clock::time_point now) {
     using Clock = std::chrono::system_clock;
-    auto now = Clock::now();
     auto epoch = now.time_since_epoch();
     auto seconds = std::chrono::duration_cast<std::chrono::seconds>(epoch);
     auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(epoch) -
@@ -143,6 +107,14 @@ std::string JsonLogFormatter::format(LogLevel level,
                                      LogCategory category,
                                      std::string_view message,
                                      const LogContext& ctx) {
+    return format(level, category, message, ctx, std::chrono::system_clock::now());
+}
+
+std::string JsonLogFormatter::format(LogLevel level,
+                                     LogCategory category,
+                                     std::string_view message,
+                                     const LogContext& ctx,
+                                     std::chrono::system_clock::time_point timestamp) {
     std::string out;
     out.reserve(256);
 
@@ -150,7 +122,7 @@ std::string JsonLogFormatter::format(LogLevel level,
 
     // timestamp
     out += "\"timestamp\":";
-    appendJsonString(out, formatTimestamp());
+    appendJsonString(out, formatTimestamp(timestamp));
 
     // level
     out += ",\"level\":";
@@ -0,0 +1,24 @@
+#pragma once
+
+/// @file log_render.hpp
+/// @brief Text rendering shared by GameLogger and the binary log decoder.
+///
+/// Internal header for the logger adapter.  The decoder renders records
+/// long after they were logged, with the same placeholder and context
+/// rules as the live text output.
+
+#include "cgs/foundation/game_logger.hpp"
+
+#include <span>
+#include <string>
+
+namespace cgs::foundation::detail {
+
+/// `key=value, ...` of the set fields of @p ctx (empty if none).
+[[nodiscard]] std::string formatContext(const LogContext& ctx);
+
+/// Append @p format with each `{}` replaced by the next argument.
+/// Placeholders past the last argument are kept as written.
+void renderFormat(std::string& out, const char* format, std::span<const LogArg> args);
+
+}  // namespace cgs::foundation::detail
@@ -0,0 +1,147 @@
+/// @file alloc_hooks.cpp
+/// @brief Instrumented global operator new/delete for AllocTracker.
+///
+/// Linked only into binaries that opt in (cgs::foundation_alloc_hooks).
+/// Every allocation is charged to the calling thread's AllocTagScope
+/// before being served by malloc; frees go straight to free.
+
+#include "cgs/foundation/alloc_tracker.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+namespace {
+
+using cgs::foundation::AllocTracker;
+
+[[maybe_unused]] const bool gInstalled = [] {
+    AllocTracker::MarkInstalled();
+    return true;
+}();
+
+void* allocate(std::size_t size) noexcept {
+    AllocTracker::RecordAllocation(size);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void* allocateAligned(std::size_t size, std::align_val_t alignment) noexcept {
+    AllocTracker::RecordAllocation(size);
+    const auto align = static_cast<std::size_t>(alignment);
+#if defined(_WIN32)
+    return _aligned_malloc(size == 0 ? 1 : size, align);
+#else
+    // aligned_alloc() wants a multiple of the alignment.
+    const std::size_t rounded = (size + align - 1) / align * align;
+    return std::aligned_alloc(align, rounded == 0 ? align : rounded);
+#endif
+}
+
+void releaseAligned(void* p) noexcept {
+#if defined(_WIN32)
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+/// operator new semantics: retry through the new_handler, then throw.
+template <typename Allocate>
+void* allocateOrThrow(Allocate&& allocateOnce) {
+    for (;;) {
+        if (void* p = allocateOnce()) {
+            return p;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+    return allocateOrThrow([size] { return allocate(size); });
+}
+
+void* operator new[](std::size_t size) {
+    return allocateOrThrow([size] { return allocate(size); });
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return allocateOrThrow([=] { return allocateAligned(size, alignment); });
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return allocateOrThrow([=] { return allocateAligned(size, alignment); });
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+    releaseAligned(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept {
+    releaseAligned(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept {
+    releaseAligned(p);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept {
+    releaseAligned(p);
+}
+
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept {
+    releaseAligned(p);
+}
+
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept {
+    releaseAligned(p);
+}
@@ -1,19 +1,38 @@
 /// @file game_metrics.cpp
 /// @brief In-memory implementation of GameMetrics (SDS-MOD-006).
 ///
-/// Uses atomic operations for counters/gauges and a mutex for histograms
-/// and health state. When monitoring_system becomes available as a kcenon
-/// dependency, this file and CMakeLists.txt are the only files that change.
+/// Counters and histograms are sharded per thread and updated with relaxed
+/// atomics; gauges are single atomics.  Mutexes guard only the name maps
+/// and health state.  When monitoring_system becomes available as a
+/// kcenon dependency, this file and CMakeLists.txt are the only files
+/// that change.
 
 #include "cgs/foundation/game_metrics.hpp"
 
+#include "cgs/foundation/json_escape.hpp"
+#include "cgs/foundation/profiled_mutex.hpp"
+
 #include <algorithm>
+#include <array>
 #include <atomic>
+#include <bit>
+#include <charconv>
+#include <chrono>
 #include <cmath>
+#include <condition_variable>
+#include <iterator>
 #include <limits>
+#include <memory>
 #include <mutex>
-#include <sstream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <span>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace cgs::foundation {
 
@@ -27,32 +46,8 @@ HistogramBuckets HistogramBuckets::defaultDuration() {
     return HistogramBuckets{{0.1, 0.5, 1, 2.5, 5, 10, 25, 50}};
 }
 
-// ── Histogram data ──────────────────────────────────────────────────────────
-
 namespace {
 
-struct HistogramData {
-    std::vector<double> boundaries;
-    std::vector<uint64_t> bucketCounts;  // one per boundary + 1 for +Inf
-    uint64_t totalCount{0};
-    double totalSum{0.0};
-
-    explicit HistogramData(std::vector<double> bounds)
-        : boundaries(std::move(bounds)), bucketCounts(boundaries.size() + 1, 0) {}
-
-    void record(double value) {
-        for (std::size_t i = 0; i < boundaries.size(); ++i) {
-            if (value <= boundaries[i]) {
-                ++bucketCounts[i];
-            }
-        }
-        // +Inf bucket always incremented
-        ++bucketCounts.back();
-        ++totalCount;
-        totalSum += value;
-    }
-};
-
 // Atomic double helper using CAS loop.
 // std::atomic<double> does not support fetch_add in C++20.
 void atomicAdd(std::atomic<double>& target, double delta) {
@@ -71,43 +66,823 @@ double atomicLoad(const std::atomic<double>& target) {
     return target.load(std::memory_order_acquire);
 }
 
-// Format a double for Prometheus output, removing unnecessary trailing zeros.
-std::string formatDouble(double value) {
+// Append a double in Prometheus form: the shortest text that round-trips,
+// with +Inf/-Inf/NaN spelled the way the exposition format wants them.
+void appendDouble(std::string& out, double value) {
     if (std::isinf(value)) {
-        return value > 0 ? "+Inf" : "-Inf";
+        out += value > 0 ? "+Inf" : "-Inf";
+        return;
     }
     if (std::isnan(value)) {
-        return "NaN";
+        out += "NaN";
+        return;
+    }
+    char buffer[32];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+void appendUint(std::string& out, uint64_t value) {
+    char buffer[24];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+// Append @p value with the escapes Prometheus label values need.
+void appendLabelValue(std::string& out, std::string_view value) {
+    for (const char c : value) {
+        switch (c) {
+            case '\\':
+                out += "\\\\";
+                break;
+            case '"':
+                out += "\\\"";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            default:
+                out += c;
+        }
+    }
+}
+
+// Append "cgs_lock_<site>_<suffix>", with the characters Prometheus does
+// not allow in names ('.', '-', ...) replaced by '_'.
+void appendLockMetricName(std::string& out, std::string_view site, std::string_view suffix) {
+    out += "cgs_lock_";
+    for (const char c : site) {
+        const bool valid = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                           (c >= '0' && c <= '9') || c == '_';
+        out += valid ? c : '_';
+    }
+    out += '_';
+    out += suffix;
+}
+
+void appendLockHistogram(std::string& out,
+                         std::string_view site,
+                         std::string_view suffix,
+                         const LockHistogram& histogram) {
+    out += "# TYPE ";
+    appendLockMetricName(out, site, suffix);
+    out += " histogram\n";
+    uint64_t cumulative = 0;
+    for (std::size_t i = 0; i < histogram.buckets.size(); ++i) {
+        cumulative += histogram.buckets[i];
+        appendLockMetricName(out, site, suffix);
+        out += "_bucket{le=\"";
+        if (i < LockProfiler::kBucketBoundsUs.size()) {
+            appendUint(out, LockProfiler::kBucketBoundsUs[i]);
+        } else {
+            out += "+Inf";
+        }
+        out += "\"} ";
+        appendUint(out, cumulative);
+        out += '\n';
+    }
+    appendLockMetricName(out, site, suffix);
+    out += "_sum ";
+    appendDouble(out, static_cast<double>(histogram.sumNs) / 1000.0);
+    out += '\n';
+    appendLockMetricName(out, site, suffix);
+    out += "_count ";
+    appendUint(out, histogram.count);
+    out += '\n';
+}
+
+// ProfiledMutex sites that have recorded anything (process-wide, so
+// every GameMetrics instance lists them).
+void appendLockSites(std::string& out) {
+    for (const auto& site : LockProfiler::Snapshot()) {
+        if (site.contended == 0 && site.wait.count == 0) {
+            continue;
+        }
+        appendLockHistogram(out, site.name, "wait_us", site.wait);
+        appendLockHistogram(out, site.name, "hold_us", site.hold);
+        out += "# TYPE ";
+        appendLockMetricName(out, site.name, "contended_total");
+        out += " counter\n";
+        appendLockMetricName(out, site.name, "contended_total");
+        out += ' ';
+        appendUint(out, site.contended);
+        out += '\n';
+    }
+}
+
+// Threads take counter shards round-robin on their first increment.
+std::atomic<std::size_t> gNextShard{0};
+
+}  // anonymous namespace
+
+// ── Counter and gauge cells ─────────────────────────────────────────────────
+
+namespace detail {
+
+inline constexpr std::size_t kCounterShards = 16;
+
+/// The calling thread's shard, in [0, kCounterShards).
+std::size_t threadShard() noexcept {
+    thread_local const std::size_t index =
+        gNextShard.fetch_add(1, std::memory_order_relaxed) % kCounterShards;
+    return index;
+}
+
+/// A counter split into cache-line-sized shards, one per thread (modulo
+/// kCounterShards).
+struct CounterCell {
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> value{0};
+    };
+
+    std::array<Shard, kCounterShards> shards;
+    bool registered = false;  // Survives reset()
+
+    void add(uint64_t value) noexcept {
+        shards[threadShard()].value.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] uint64_t sum() const noexcept {
+        uint64_t total = 0;
+        for (const auto& shard : shards) {
+            total += shard.value.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    void clear() noexcept {
+        for (auto& shard : shards) {
+            shard.value.store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+struct GaugeCell {
+    std::atomic<double> value{0.0};
+    bool registered = false;  // Survives reset()
+};
+
+/// Fixed Prometheus buckets plus a log-linear sketch, sharded like
+/// CounterCell (fewer shards: a shard is ~8 KB).
+///
+/// Sketch bucket of a positive double = its exponent and top four
+/// mantissa bits, i.e. bits 48..62 of the IEEE-754 encoding, offset so
+/// that 2^kMinExponent maps to 0.  Smaller and non-positive values land
+/// in bucket 0, larger ones in the last bucket.
+struct HistogramCell {
+    static constexpr std::size_t kShards = 8;
+    static constexpr int kSubBucketBits = 4;
+    static constexpr int kMinExponent = -16;
+    static constexpr int kOctaves = 64;
+    static constexpr std::size_t kSketchBuckets = std::size_t{kOctaves} << kSubBucketBits;
+    static constexpr uint64_t kSketchBase =
+        static_cast<uint64_t>(1023 + kMinExponent) << kSubBucketBits;
+
+    struct alignas(64) Shard {
+        std::array<std::atomic<uint64_t>, kSketchBuckets> sketch{};
+        std::unique_ptr<std::atomic<uint64_t>[]> buckets;  // Per boundary + +Inf, not cumulative
+        std::atomic<uint64_t> count{0};
+        std::atomic<double> sum{0.0};
+        std::atomic<double> min{std::numeric_limits<double>::infinity()};
+        std::atomic<double> max{-std::numeric_limits<double>::infinity()};
+    };
+
+    explicit HistogramCell(std::vector<double> bounds)
+        : boundaries(std::move(bounds)), shards(std::make_unique<Shard[]>(kShards)) {
+        std::sort(boundaries.begin(), boundaries.end());
+        for (std::size_t i = 0; i < kShards; ++i) {
+            shards[i].buckets = std::make_unique<std::atomic<uint64_t>[]>(boundaries.size() + 1);
+        }
+    }
+
+    std::vector<double> boundaries;
+    std::unique_ptr<Shard[]> shards;
+    bool pinned = false;  // A handle was issued: survives reset()
+
+    static std::size_t sketchIndex(double value) noexcept {
+        if (!(value > 0.0)) {
+            return 0;
+        }
+        const uint64_t key = std::bit_cast<uint64_t>(value) >> (52 - kSubBucketBits);
+        if (key < kSketchBase) {
+            return 0;
+        }
+        return std::min<std::size_t>(static_cast<std::size_t>(key - kSketchBase),
+                                     kSketchBuckets - 1);
+    }
+
+    /// Midpoint of sketch bucket @p index.
+    static double sketchValue(std::size_t index) noexcept {
+        const auto lower = std::bit_cast<double>((kSketchBase + index) << (52 - kSubBucketBits));
+        const auto upper =
+            std::bit_cast<double>((kSketchBase + index + 1) << (52 - kSubBucketBits));
+        return (lower + upper) / 2.0;
+    }
+
+    static void atomicMin(std::atomic<double>& target, double value) noexcept {
+        double current = target.load(std::memory_order_relaxed);
+        while (value < current &&
+               !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    static void atomicMax(std::atomic<double>& target, double value) noexcept {
+        double current = target.load(std::memory_order_relaxed);
+        while (value > current &&
+               !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    void record(double value) noexcept {
+        if (std::isnan(value)) {
+            return;
+        }
+        auto& shard = shards[threadShard() % kShards];
+        const auto bucket = static_cast<std::size_t>(
+            std::lower_bound(boundaries.begin(), boundaries.end(), value) - boundaries.begin());
+        shard.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+        shard.sketch[sketchIndex(value)].fetch_add(1, std::memory_order_relaxed);
+        // Shard-local: only threads sharing this shard contend.
+        double sum = shard.sum.load(std::memory_order_relaxed);
+        while (!shard.sum.compare_exchange_weak(sum, sum + value, std::memory_order_relaxed)) {
+        }
+        atomicMin(shard.min, value);
+        atomicMax(shard.max, value);
+        shard.count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] uint64_t count() const noexcept {
+        uint64_t total = 0;
+        for (std::size_t i = 0; i < kShards; ++i) {
+            total += shards[i].count.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    [[nodiscard]] double sum() const noexcept {
+        double total = 0.0;
+        for (std::size_t i = 0; i < kShards; ++i) {
+            total += shards[i].sum.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    /// Cumulative count of the fixed buckets (boundaries, then +Inf).
+    void cumulativeBuckets(std::vector<uint64_t>& counts) const {
+        counts.assign(boundaries.size() + 1, 0);
+        for (std::size_t s = 0; s < kShards; ++s) {
+            for (std::size_t i = 0; i < counts.size(); ++i) {
+                counts[i] += shards[s].buckets[i].load(std::memory_order_relaxed);
+            }
+        }
+        for (std::size_t i = 1; i < counts.size(); ++i) {
+            counts[i] += counts[i - 1];
+        }
+    }
+
+    /// Sketch quantiles for the ascending @p qs, written to @p out.
+    void quantiles(std::span<const double> qs, std::span<double> out) const {
+        std::array<uint64_t, kSketchBuckets> merged{};
+        uint64_t total = 0;
+        double lo = std::numeric_limits<double>::infinity();
+        double hi = -std::numeric_limits<double>::infinity();
+        for (std::size_t s = 0; s < kShards; ++s) {
+            for (std::size_t i = 0; i < kSketchBuckets; ++i) {
+                merged[i] += shards[s].sketch[i].load(std::memory_order_relaxed);
+            }
+            lo = std::min(lo, shards[s].min.load(std::memory_order_relaxed));
+            hi = std::max(hi, shards[s].max.load(std::memory_order_relaxed));
+        }
+        for (const auto n : merged) {
+            total += n;
+        }
+
+        std::size_t bucket = 0;
+        uint64_t seen = 0;
+        for (std::size_t k = 0; k < qs.size(); ++k) {
+            if (total == 0) {
+                out[k] = 0.0;
+                continue;
+            }
+            const double q = std::clamp(qs[k], 0.0, 1.0);
+            const auto rank = std::max<uint64_t>(
+                1, static_cast<uint64_t>(std::ceil(q * static_cast<double>(total))));
+            while (bucket < kSketchBuckets && seen + merged[bucket] < rank) {
+                seen += merged[bucket++];
+            }
+            out[k] = std::clamp(sketchValue(std::min(bucket, kSketchBuckets - 1)), lo, hi);
+        }
+    }
+
+    [[nodiscard]] double quantile(double q) const {
+        double value = 0.0;
+        quantiles(std::span(&q, 1), std::span(&value, 1));
+        return value;
+    }
+
+    void clear() noexcept {
+        for (std::size_t s = 0; s < kShards; ++s) {
+            auto& shard = shards[s];
+            for (auto& n : shard.sketch) {
+                n.store(0, std::memory_order_relaxed);
+            }
+            for (std::size_t i = 0; i <= boundaries.size(); ++i) {
+                shard.buckets[i].store(0, std::memory_order_relaxed);
+            }
+            shard.count.store(0, std::memory_order_relaxed);
+            shard.sum.store(0.0, std::memory_order_relaxed);
+            shard.min.store(std::numeric_limits<double>::infinity(), std::memory_order_relaxed);
+            shard.max.store(-std::numeric_limits<double>::infinity(), std::memory_order_relaxed);
+        }
+    }
+};
+
+/// The children of one labeled family, keyed by their rendered label
+/// pairs (k1="v1",k2="v2").  Children are never erased, so handles and
+/// the scrape's series pointers stay valid.
+template <typename Cell>
+struct FamilyCell {
+    FamilyCell(std::vector<std::string> labelKeys,
+               std::size_t limit,
+               std::vector<double> bounds = {})
+        : keys(std::move(labelKeys)), maxSeries(limit), boundaries(std::move(bounds)) {}
+
+    std::vector<std::string> keys;
+    std::size_t maxSeries;
+    std::vector<double> boundaries;  // Histogram families only
+
+    mutable ProfiledMutex mutex{"metrics.family"};
+    std::unordered_map<std::string, Cell> children;
+    Cell* overflow = nullptr;  // In children, not counted against maxSeries
+    std::atomic<uint64_t> overflowed{0};
+
+    [[nodiscard]] std::string render(std::span<const std::string_view> values) const {
+        std::string labels;
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            if (i > 0) {
+                labels += ',';
+            }
+            labels += keys[i];
+            labels += "=\"";
+            appendLabelValue(labels, values[i]);
+            labels += '"';
+        }
+        return labels;
+    }
+
+    Cell& emplace(std::string labels) {
+        if constexpr (std::is_same_v<Cell, HistogramCell>) {
+            return children.try_emplace(std::move(labels), boundaries).first->second;
+        } else {
+            return children.try_emplace(std::move(labels)).first->second;
+        }
+    }
+
+    /// Child for @p values, or nullptr if their count is wrong.
+    Cell* bind(std::span<const std::string_view> values) {
+        if (values.size() != keys.size()) {
+            return nullptr;
+        }
+        auto labels = render(values);
+        std::lock_guard lock(mutex);
+        if (auto it = children.find(labels); it != children.end()) {
+            return &it->second;
+        }
+        if (children.size() - (overflow != nullptr ? 1 : 0) < maxSeries) {
+            return &emplace(std::move(labels));
+        }
+        overflowed.fetch_add(1, std::memory_order_relaxed);
+        if (overflow == nullptr) {
+            const std::vector<std::string_view> others(keys.size(), kOverflowLabelValue);
+            overflow = &emplace(render(others));
+        }
+        return overflow;
+    }
+
+    [[nodiscard]] std::size_t size() const {
+        std::lock_guard lock(mutex);
+        return children.size() - (overflow != nullptr ? 1 : 0);
+    }
+};
+
+}  // namespace detail
+
+// ── Handles ─────────────────────────────────────────────────────────────────
+
+void CounterHandle::increment(uint64_t value) const noexcept {
+    if (cell_ != nullptr) {
+        cell_->add(value);
+    }
+}
+
+uint64_t CounterHandle::value() const noexcept {
+    return cell_ != nullptr ? cell_->sum() : 0;
+}
+
+void GaugeHandle::set(double value) const noexcept {
+    if (cell_ != nullptr) {
+        atomicStore(cell_->value, value);
+    }
+}
+
+void GaugeHandle::increment(double delta) const noexcept {
+    if (cell_ != nullptr) {
+        atomicAdd(cell_->value, delta);
+    }
+}
+
+void GaugeHandle::decrement(double delta) const noexcept {
+    if (cell_ != nullptr) {
+        atomicAdd(cell_->value, -delta);
+    }
+}
+
+double GaugeHandle::value() const noexcept {
+    return cell_ != nullptr ? atomicLoad(cell_->value) : 0.0;
+}
+
+void HistogramHandle::record(double value) const noexcept {
+    if (cell_ != nullptr) {
+        cell_->record(value);
+    }
+}
+
+double HistogramHandle::quantile(double q) const {
+    return cell_ != nullptr ? cell_->quantile(q) : 0.0;
+}
+
+uint64_t HistogramHandle::count() const noexcept {
+    return cell_ != nullptr ? cell_->count() : 0;
+}
+
+template <typename Handle>
+Handle MetricFamily<Handle>::bindValues(std::span<const std::string_view> values) const {
+    auto* cell = cell_ != nullptr ? cell_->bind(values) : nullptr;
+    return cell != nullptr ? Handle(cell) : Handle();
+}
+
+template <typename Handle>
+std::size_t MetricFamily<Handle>::size() const {
+    return cell_ != nullptr ? cell_->size() : 0;
+}
+
+template <typename Handle>
+uint64_t MetricFamily<Handle>::overflowed() const {
+    return cell_ != nullptr ? cell_->overflowed.load(std::memory_order_relaxed) : 0;
+}
+
+template class MetricFamily<CounterHandle>;
+template class MetricFamily<GaugeHandle>;
+template class MetricFamily<HistogramHandle>;
+
+// ── Span collection ─────────────────────────────────────────────────────────
+
+namespace detail {
+
+/// Bounded multi-producer queue of finished spans (Vyukov's ring: each
+/// slot's sequence number says whose turn it is, so a push is one CAS on
+/// the tail and no lock).
+class SpanQueue {
+public:
+    explicit SpanQueue(std::size_t capacity)
+        : mask_(std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1),
+          slots_(std::make_unique<Slot[]>(mask_ + 1)) {
+        for (std::size_t i = 0; i <= mask_; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
     }
-    std::ostringstream oss;
-    oss << value;
-    return oss.str();
+
+    /// @return false (record untouched) if the queue is full.
+    bool tryPush(SpanRecord&& record) {
+        std::size_t pos = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[pos & mask_];
+            const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence == pos) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.record = std::move(record);
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (sequence < pos) {
+                return false;  // The consumer has not freed this slot yet
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// Single consumer: @return false if the queue is empty.
+    bool tryPop(SpanRecord& out) {
+        const std::size_t pos = head_.load(std::memory_order_relaxed);
+        Slot& slot = slots_[pos & mask_];
+        if (slot.sequence.load(std::memory_order_acquire) != pos + 1) {
+            return false;
+        }
+        out = std::move(slot.record);
+        head_.store(pos + 1, std::memory_order_relaxed);
+        slot.sequence.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Approximate number of queued records.
+    [[nodiscard]] std::size_t size() const noexcept {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<std::size_t> sequence{0};
+        SpanRecord record;
+    };
+
+    std::size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+    alignas(64) std::atomic<std::size_t> tail_{0};
+    alignas(64) std::atomic<std::size_t> head_{0};
+};
+
+/// One startTracing()..stopTracing() session.  Never freed before its
+/// GameMetrics, so span code may keep using a pointer that a concurrent
+/// stopTracing() has just unpublished.
+struct Tracer {
+    Tracer(TracingConfig cfg, SpanExporter exp)
+        : config(cfg),
+          exporter(std::move(exp)),
+          queue(config.queueCapacity),
+          batchSize(std::max<std::size_t>(config.batchSize, 1)) {
+        const double ratio = std::clamp(config.sampleRatio, 0.0, 1.0);
+        sampleAll = ratio >= 1.0;
+        sampleThreshold = static_cast<uint64_t>(ratio * 18446744073709551616.0);
+    }
+
+    TracingConfig config;
+    SpanExporter exporter;
+    SpanQueue queue;
+    std::size_t batchSize;
+    bool sampleAll = false;
+    uint64_t sampleThreshold = 0;  // Trace ids below this are sampled
+
+    std::atomic<bool> accepting{true};
+    std::atomic<uint32_t> writers{0};  // endSpan() calls inside tryPush()
+
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+
+    std::atomic<uint64_t> started{0};
+    std::atomic<uint64_t> sampledOut{0};
+    std::atomic<uint64_t> tailKept{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> exported{0};
+    std::atomic<uint64_t> batches{0};
+
+    [[nodiscard]] bool headSampled(uint64_t traceIdLow) const noexcept {
+        return sampleAll || traceIdLow < sampleThreshold;
+    }
+
+    // Hand every queued span to the exporter, batchSize at a time.
+    void drain(std::vector<SpanRecord>& batch) {
+        for (;;) {
+            batch.clear();
+            SpanRecord record;
+            while (batch.size() < batchSize && queue.tryPop(record)) {
+                batch.push_back(std::move(record));
+            }
+            if (batch.empty()) {
+                return;
+            }
+            if (exporter) {
+                exporter(batch);
+            }
+            exported.fetch_add(batch.size(), std::memory_order_relaxed);
+            batches.fetch_add(1, std::memory_order_relaxed);
+            if (batch.size() < batchSize) {
+                return;
+            }
+        }
+    }
+
+    void run() {
+        std::vector<SpanRecord> batch;
+        batch.reserve(batchSize);
+        for (;;) {
+            bool stop = false;
+            {
+                std::unique_lock lock(mutex);
+                wake.wait_for(lock, config.flushInterval,
+                              [&] { return stopping || queue.size() >= batchSize; });
+                stop = stopping;
+            }
+            drain(batch);
+            if (stop) {
+                return;
+            }
+        }
+    }
+
+    void stop() {
+        accepting.store(false);
+        while (writers.load() != 0) {
+            std::this_thread::yield();
+        }
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+};
+
+}  // namespace detail
+
+namespace {
+
+// Random, nonzero 64-bit ids from a per-thread splitmix64 stream.
+uint64_t randomId() noexcept {
+    thread_local uint64_t state = [] {
+        std::random_device device;
+        return (static_cast<uint64_t>(device()) << 32) ^ device() ^
+               static_cast<uint64_t>(
+                   std::chrono::steady_clock::now().time_since_epoch().count());
+    }();
+    for (;;) {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        z ^= z >> 31;
+        if (z != 0) {
+            return z;
+        }
+    }
+}
+
+void appendUnixNanos(std::string& out, std::chrono::system_clock::time_point time) {
+    const auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        time.time_since_epoch());
+    appendUint(out, static_cast<uint64_t>(std::max<int64_t>(nanos.count(), 0)));
 }
 
 }  // anonymous namespace
 
+std::string encodeOtlpJson(std::span<const SpanRecord> spans, std::string_view serviceName) {
+    std::string out;
+    out.reserve(128 + spans.size() * 192);
+    out += R"({"resourceSpans":[{"resource":{"attributes":[{"key":"service.name",)";
+    out += R"("value":{"stringValue":")";
+    appendJsonEscaped(out, serviceName);
+    out += R"("}}]},"scopeSpans":[{"scope":{"name":"cgs"},"spans":[)";
+    for (std::size_t i = 0; i < spans.size(); ++i) {
+        const auto& span = spans[i];
+        if (i > 0) {
+            out += ',';
+        }
+        out += R"({"traceId":")";
+        TraceContext::appendHex(out, span.context.traceIdHigh, 16);
+        TraceContext::appendHex(out, span.context.traceIdLow, 16);
+        out += R"(","spanId":")";
+        TraceContext::appendHex(out, span.context.spanId, 16);
+        if (span.parentId != 0) {
+            out += R"(","parentSpanId":")";
+            TraceContext::appendHex(out, span.parentId, 16);
+        }
+        out += R"(","name":")";
+        appendJsonEscaped(out, span.name);
+        out += R"(","kind":1,"startTimeUnixNano":")";
+        appendUnixNanos(out, span.start);
+        out += R"(","endTimeUnixNano":")";
+        appendUnixNanos(out, span.start + std::chrono::duration_cast<
+                                             std::chrono::system_clock::duration>(span.duration));
+        out += R"(","status":{"code":)";
+        out += span.error ? '2' : '0';
+        out += "}}";
+    }
+    out += "]}]}]}";
+    return out;
+}
+
 // ── Impl ────────────────────────────────────────────────────────────────────
 
+namespace {
+
+/// One child of a labeled family, listed for a scrape.
+template <typename Cell>
+struct LabeledSeries {
+    const std::string* family;
+    const std::string* labels;
+    const Cell* cell;
+};
+
+/// List the children of @p families (caller holds the map's mutex);
+/// each family's children end up contiguous.
+template <typename Cell>
+void listFamilies(const std::unordered_map<std::string, detail::FamilyCell<Cell>>& families,
+                  std::vector<LabeledSeries<Cell>>& out) {
+    for (const auto& [name, family] : families) {
+        std::lock_guard lock(family.mutex);
+        for (const auto& [labels, cell] : family.children) {
+            out.push_back({&name, &labels, &cell});
+        }
+    }
+}
+
+/// Apply @p clear to every child of @p families (caller holds the map's
+/// mutex).
+template <typename Cell, typename Clear>
+void clearFamilies(std::unordered_map<std::string, detail::FamilyCell<Cell>>& families,
+                   Clear clear) {
+    for (auto& [name, family] : families) {
+        std::lock_guard lock(family.mutex);
+        for (auto& [labels, cell] : family.children) {
+            clear(cell);
+        }
+    }
+}
+
+// Append "<name><suffix>", then the labels (and @p extra, a rendered
+// label pair such as le="5") in braces if there are any.
+void appendSeries(std::string& out,
+                  std::string_view name,
+                  std::string_view suffix,
+                  std::string_view labels,
+                  std::string_view extra = {}) {
+    out += name;
+    out += suffix;
+    if (labels.empty() && extra.empty()) {
+        return;
+    }
+    out += '{';
+    out += labels;
+    if (!labels.empty() && !extra.empty()) {
+        out += ',';
+    }
+    out += extra;
+    out += '}';
+}
+
+}  // anonymous namespace
+
+
 struct GameMetrics::Impl {
-    // Counters: lock-free via atomic<uint64_t>.
-    // We use a mutex for map insertion but reads/increments on existing
-    // counters are lock-free after creation.
-    mutable std::mutex counterMutex;
-    std::unordered_map<std::string, std::atomic<uint64_t>> counters;
+    // Counters: sharded atomics.  The mutex guards the map; handles
+    // point at the (node-stable) cells and update them lock-free.
+    mutable ProfiledMutex counterMutex{"metrics.counters"};
+    std::unordered_map<std::string, detail::CounterCell> counters;
+    std::unordered_map<std::string, detail::FamilyCell<detail::CounterCell>> counterFamilies;
 
     // Gauges: similar pattern with atomic<double>.
-    mutable std::mutex gaugeMutex;
-    std::unordered_map<std::string, std::atomic<double>> gauges;
+    mutable ProfiledMutex gaugeMutex{"metrics.gauges"};
+    std::unordered_map<std::string, detail::GaugeCell> gauges;
+    std::unordered_map<std::string, detail::FamilyCell<detail::GaugeCell>> gaugeFamilies;
 
-    // Histograms: fully mutex-protected (recording mutates vectors).
-    mutable std::mutex histogramMutex;
-    std::unordered_map<std::string, HistogramData> histograms;
+    // Histograms: the mutex guards the map; recording is lock-free.
+    mutable ProfiledMutex histogramMutex{"metrics.histograms"};
+    std::unordered_map<std::string, detail::HistogramCell> histograms;
+    std::unordered_map<std::string, detail::FamilyCell<detail::HistogramCell>> histogramFamilies;
 
-    // Trace span ID generator.
-    std::atomic<uint64_t> nextSpanId{1};
+    // Tracing.  tracerMutex serializes start/stopTracing(); spans read
+    // the published tracer lock-free.  Stopped tracers are retired, not
+    // freed (see detail::Tracer).
+    std::mutex tracerMutex;
+    std::atomic<detail::Tracer*> tracer{nullptr};
+    std::atomic<detail::Tracer*> lastTracer{nullptr};  // For tracingStats()
+    std::vector<std::unique_ptr<detail::Tracer>> tracers;
+
+    ~Impl() { stopTracer(); }
+
+    void stopTracer() {
+        std::lock_guard lock(tracerMutex);
+        detail::Tracer* current = tracer.exchange(nullptr);
+        if (current != nullptr) {
+            current->stop();
+        }
+    }
+
+    // Scrape state.  scrapeMutex serializes scrape() and reset(): the
+    // series listed under the map locks stay alive while they are
+    // formatted because only reset() erases them.  The vectors and the
+    // body are reused across scrapes.
+    std::mutex scrapeMutex;
+    std::vector<std::pair<const std::string*, const detail::CounterCell*>> counterSeries;
+    std::vector<std::pair<const std::string*, const detail::GaugeCell*>> gaugeSeries;
+    std::vector<std::pair<const std::string*, const detail::HistogramCell*>> histogramSeries;
+    std::vector<LabeledSeries<detail::CounterCell>> counterFamilySeries;
+    std::vector<LabeledSeries<detail::GaugeCell>> gaugeFamilySeries;
+    std::vector<LabeledSeries<detail::HistogramCell>> histogramFamilySeries;
+    std::vector<uint64_t> bucketScratch;
+    std::string body;
+    std::chrono::steady_clock::time_point renderedAt;
+    bool bodyValid = false;
+    std::atomic<int64_t> cacheTtlMs{0};
 
     // Health state.
-    mutable std::mutex healthMutex;
+    mutable ProfiledMutex healthMutex{"metrics.health"};
     std::string serviceName{"cgs"};
     std::unordered_map<std::string, HealthStatus> componentHealth;
 };
@@ -126,7 +901,7 @@ GameMetrics& GameMetrics::operator=(GameMetrics&&) noexcept = default;
 
 void GameMetrics::incrementCounter(std::string_view name, uint64_t value) {
     std::lock_guard lock(impl_->counterMutex);
-    impl_->counters[std::string(name)].fetch_add(value, std::memory_order_relaxed);
+    impl_->counters[std::string(name)].add(value);
 }
 
 uint64_t GameMetrics::counterValue(std::string_view name) const {
@@ -135,24 +910,31 @@ uint64_t GameMetrics::counterValue(std::string_view name) const {
     if (it == impl_->counters.end()) {
         return 0;
     }
-    return it->second.load(std::memory_order_relaxed);
+    return it->second.sum();
+}
+
+CounterHandle GameMetrics::registerCounter(std::string_view name) {
+    std::lock_guard lock(impl_->counterMutex);
+    auto& cell = impl_->counters[std::string(name)];
+    cell.registered = true;
+    return CounterHandle(&cell);
 }
 
 // ── Gauges ──────────────────────────────────────────────────────────────────
 
 void GameMetrics::setGauge(std::string_view name, double value) {
     std::lock_guard lock(impl_->gaugeMutex);
-    atomicStore(impl_->gauges[std::string(name)], value);
+    atomicStore(impl_->gauges[std::string(name)].value, value);
 }
 
 void GameMetrics::incrementGauge(std::string_view name, double delta) {
     std::lock_guard lock(impl_->gaugeMutex);
-    atomicAdd(impl_->gauges[std::string(name)], delta);
+    atomicAdd(impl_->gauges[std::string(name)].value, delta);
 }
 
 void GameMetrics::decrementGauge(std::string_view name, double delta) {
     std::lock_guard lock(impl_->gaugeMutex);
-    atomicAdd(impl_->gauges[std::string(name)], -delta);
+    atomicAdd(impl_->gauges[std::string(name)].value, -delta);
 }
 
 double GameMetrics::gaugeValue(std::string_view name) const {
@@ -161,7 +943,14 @@ double GameMetrics::gaugeValue(std::string_view name) const {
     if (it == impl_->gauges.end()) {
         return 0.0;
     }
-    return atomicLoad(it->second);
+    return atomicLoad(it->second.value);
+}
+
+GaugeHandle GameMetrics::registerGauge(std::string_view name) {
+    std::lock_guard lock(impl_->gaugeMutex);
+    auto& cell = impl_->gauges[std::string(name)];
+    cell.registered = true;
+    return GaugeHandle(&cell);
 }
 
 // ── Histograms ──────────────────────────────────────────────────────────────
@@ -170,31 +959,174 @@ void GameMetrics::registerHistogram(std::string_view name, HistogramBuckets buck
     std::lock_guard lock(impl_->histogramMutex);
     auto key = std::string(name);
     if (impl_->histograms.find(key) == impl_->histograms.end()) {
-        impl_->histograms.emplace(std::move(key), HistogramData(std::move(buckets.boundaries)));
+        impl_->histograms.try_emplace(std::move(key), std::move(buckets.boundaries));
     }
 }
 
 void GameMetrics::recordHistogram(std::string_view name, double value) {
+    detail::HistogramCell* cell = nullptr;
+    {
+        std::lock_guard lock(impl_->histogramMutex);
+        auto it = impl_->histograms.find(std::string(name));
+        if (it == impl_->histograms.end()) {
+            return;
+        }
+        cell = &it->second;
+    }
+    cell->record(value);
+}
+
+HistogramHandle GameMetrics::histogramHandle(std::string_view name) {
     std::lock_guard lock(impl_->histogramMutex);
     auto it = impl_->histograms.find(std::string(name));
-    if (it != impl_->histograms.end()) {
-        it->second.record(value);
+    if (it == impl_->histograms.end()) {
+        return HistogramHandle();
     }
+    it->second.pinned = true;
+    return HistogramHandle(&it->second);
+}
+
+double GameMetrics::histogramQuantile(std::string_view name, double q) const {
+    std::lock_guard lock(impl_->histogramMutex);
+    auto it = impl_->histograms.find(std::string(name));
+    return it == impl_->histograms.end() ? 0.0 : it->second.quantile(q);
+}
+
+// ── Labeled families ────────────────────────────────────────────────────────
+
+CounterFamily GameMetrics::registerCounterFamily(std::string_view name,
+                                                 std::vector<std::string> labelKeys,
+                                                 std::size_t maxSeries) {
+    std::lock_guard lock(impl_->counterMutex);
+    auto [it, inserted] =
+        impl_->counterFamilies.try_emplace(std::string(name), std::move(labelKeys), maxSeries);
+    return CounterFamily(&it->second);
+}
+
+GaugeFamily GameMetrics::registerGaugeFamily(std::string_view name,
+                                             std::vector<std::string> labelKeys,
+                                             std::size_t maxSeries) {
+    std::lock_guard lock(impl_->gaugeMutex);
+    auto [it, inserted] =
+        impl_->gaugeFamilies.try_emplace(std::string(name), std::move(labelKeys), maxSeries);
+    return GaugeFamily(&it->second);
+}
+
+HistogramFamily GameMetrics::registerHistogramFamily(std::string_view name,
+                                                     std::vector<std::string> labelKeys,
+                                                     HistogramBuckets buckets,
+                                                     std::size_t maxSeries) {
+    std::lock_guard lock(impl_->histogramMutex);
+    auto [it, inserted] = impl_->histogramFamilies.try_emplace(
+        std::string(name), std::move(labelKeys), maxSeries, std::move(buckets.boundaries));
+    return HistogramFamily(&it->second);
 }
 
 // ── Tracing ─────────────────────────────────────────────────────────────────
 
 TraceSpan GameMetrics::startSpan(std::string_view name) {
+    return startSpan(name, TraceContext{});
+}
+
+TraceSpan GameMetrics::startSpan(std::string_view name, const TraceContext& parent) {
     TraceSpan span;
-    span.id = impl_->nextSpanId.fetch_add(1, std::memory_order_relaxed);
+    span.id = randomId();
     span.name = std::string(name);
     span.startTime = std::chrono::steady_clock::now();
     span.ended = false;
+
+    detail::Tracer* tracer = impl_->tracer.load(std::memory_order_acquire);
+    if (parent.valid()) {
+        span.traceIdHigh = parent.traceIdHigh;
+        span.traceIdLow = parent.traceIdLow;
+        span.parentId = parent.spanId;
+        span.sampled = parent.sampled();
+    } else {
+        span.traceIdHigh = randomId();
+        span.traceIdLow = randomId();
+        span.sampled = tracer != nullptr && tracer->headSampled(span.traceIdLow);
+    }
+    if (tracer != nullptr) {
+        tracer->started.fetch_add(1, std::memory_order_relaxed);
+        span.wallStart = std::chrono::system_clock::now();
+    }
     return span;
 }
 
 void GameMetrics::endSpan(TraceSpan& span) {
+    if (span.ended) {
+        return;
+    }
     span.ended = true;
+
+    detail::Tracer* tracer = impl_->tracer.load(std::memory_order_acquire);
+    if (tracer == nullptr) {
+        return;
+    }
+    const auto duration = std::chrono::steady_clock::now() - span.startTime;
+    const bool slow = tracer->config.tailLatency.count() > 0 &&
+                      duration >= tracer->config.tailLatency;
+    if (!span.sampled && !span.error && !slow) {
+        tracer->sampledOut.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    if (!span.sampled) {
+        tracer->tailKept.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    SpanRecord record;
+    record.context = span.context();
+    record.parentId = span.parentId;
+    record.name = span.name;
+    record.start = span.wallStart;
+    record.duration = std::chrono::duration_cast<std::chrono::nanoseconds>(duration);
+    record.error = span.error;
+
+    // stop() waits for writers to leave before its final drain.
+    tracer->writers.fetch_add(1);
+    if (!tracer->accepting.load()) {
+        tracer->writers.fetch_sub(1);
+        return;
+    }
+    if (!tracer->queue.tryPush(std::move(record))) {
+        tracer->dropped.fetch_add(1, std::memory_order_relaxed);
+    } else if (tracer->queue.size() >= tracer->batchSize) {
+        tracer->wake.notify_one();
+    }
+    tracer->writers.fetch_sub(1, std::memory_order_release);
+}
+
+void GameMetrics::startTracing(TracingConfig config, SpanExporter exporter) {
+    impl_->stopTracer();
+    std::lock_guard lock(impl_->tracerMutex);
+    auto tracer = std::make_unique<detail::Tracer>(config, std::move(exporter));
+    tracer->thread = std::thread([raw = tracer.get()] { raw->run(); });
+    impl_->lastTracer.store(tracer.get(), std::memory_order_release);
+    impl_->tracer.store(tracer.get(), std::memory_order_release);
+    impl_->tracers.push_back(std::move(tracer));
+}
+
+void GameMetrics::stopTracing() {
+    impl_->stopTracer();
+}
+
+bool GameMetrics::isTracing() const noexcept {
+    return impl_->tracer.load(std::memory_order_acquire) != nullptr;
+}
+
+TracingStats GameMetrics::tracingStats() const noexcept {
+    TracingStats stats;
+    const detail::Tracer* tracer = impl_->lastTracer.load(std::memory_order_acquire);
+    if (tracer == nullptr) {
+        return stats;
+    }
+    stats.started = tracer->started.load(std::memory_order_relaxed);
+    stats.sampledOut = tracer->sampledOut.load(std::memory_order_relaxed);
+    stats.tailKept = tracer->tailKept.load(std::memory_order_relaxed);
+    stats.dropped = tracer->dropped.load(std::memory_order_relaxed);
+    stats.exported = tracer->exported.load(std::memory_order_relaxed);
+    stats.batches = tracer->batches.load(std::memory_order_relaxed);
+    return stats;
 }
 
 // ── Health ───────────────────────────────────────────────────────────────────
@@ -229,61 +1161,207 @@ HealthCheckResult GameMetrics::healthCheck() const {
 // ── Prometheus scrape ───────────────────────────────────────────────────────
 
 std::string GameMetrics::scrape() const {
-    std::ostringstream out;
+    auto& impl = *impl_;
+    std::lock_guard scrapeLock(impl.scrapeMutex);
 
-    // Counters
+    const auto now = std::chrono::steady_clock::now();
+    const auto ttl = std::chrono::milliseconds(impl.cacheTtlMs.load(std::memory_order_relaxed));
+    if (impl.bodyValid && ttl.count() > 0 && now - impl.renderedAt < ttl) {
+        return impl.body;
+    }
+
+    // List the series; map nodes are stable, so the pointers survive
+    // concurrent registration.
+    impl.counterSeries.clear();
+    impl.gaugeSeries.clear();
+    impl.histogramSeries.clear();
+    impl.counterFamilySeries.clear();
+    impl.gaugeFamilySeries.clear();
+    impl.histogramFamilySeries.clear();
     {
-        std::lock_guard lock(impl_->counterMutex);
-        for (const auto& [name, value] : impl_->counters) {
-            out << "# TYPE " << name << " counter\n";
-            out << name << " " << value.load(std::memory_order_relaxed) << "\n";
+        std::lock_guard lock(impl.counterMutex);
+        for (const auto& [name, cell] : impl.counters) {
+            impl.counterSeries.emplace_back(&name, &cell);
         }
+        listFamilies(impl.counterFamilies, impl.counterFamilySeries);
     }
-
-    // Gauges
     {
-        std::lock_guard lock(impl_->gaugeMutex);
-        for (const auto& [name, value] : impl_->gauges) {
-            out << "# TYPE " << name << " gauge\n";
-            out << name << " " << formatDouble(atomicLoad(value)) << "\n";
+        std::lock_guard lock(impl.gaugeMutex);
+        for (const auto& [name, cell] : impl.gauges) {
+            impl.gaugeSeries.emplace_back(&name, &cell);
         }
+        listFamilies(impl.gaugeFamilies, impl.gaugeFamilySeries);
     }
-
-    // Histograms
     {
-        std::lock_guard lock(impl_->histogramMutex);
-        for (const auto& [name, data] : impl_->histograms) {
-            out << "# TYPE " << name << " histogram\n";
+        std::lock_guard lock(impl.histogramMutex);
+        for (const auto& [name, cell] : impl.histograms) {
+            impl.histogramSeries.emplace_back(&name, &cell);
+        }
+        listFamilies(impl.histogramFamilies, impl.histogramFamilySeries);
+    }
+
+    auto& out = impl.body;
+    out.clear();
 
-            // Cumulative bucket counts
-            for (std::size_t i = 0; i < data.boundaries.size(); ++i) {
-                out << name << "_bucket{le=\"" << formatDouble(data.boundaries[i]) << "\"} "
-                    << data.bucketCounts[i] << "\n";
+    // Counters
+    for (const auto& [name, cell] : impl.counterSeries) {
+        out += "# TYPE ";
+        out += *name;
+        out += " counter\n";
+        out += *name;
+        out += ' ';
+        appendUint(out, cell->sum());
+        out += '\n';
+    }
+    for (std::size_t i = 0; i < impl.counterFamilySeries.size(); ++i) {
+        const auto& series = impl.counterFamilySeries[i];
+        if (i == 0 || impl.counterFamilySeries[i - 1].family != series.family) {
+            out += "# TYPE ";
+            out += *series.family;
+            out += " counter\n";
+        }
+        appendSeries(out, *series.family, "", *series.labels);
+        out += ' ';
+        appendUint(out, series.cell->sum());
+        out += '\n';
+    }
+
+    // Gauges
+    for (const auto& [name, cell] : impl.gaugeSeries) {
+        out += "# TYPE ";
+        out += *name;
+        out += " gauge\n";
+        out += *name;
+        out += ' ';
+        appendDouble(out, atomicLoad(cell->value));
+        out += '\n';
+    }
+    for (std::size_t i = 0; i < impl.gaugeFamilySeries.size(); ++i) {
+        const auto& series = impl.gaugeFamilySeries[i];
+        if (i == 0 || impl.gaugeFamilySeries[i - 1].family != series.family) {
+            out += "# TYPE ";
+            out += *series.family;
+            out += " gauge\n";
+        }
+        appendSeries(out, *series.family, "", *series.labels);
+        out += ' ';
+        appendDouble(out, atomicLoad(series.cell->value));
+        out += '\n';
+    }
+
+    // Histograms: bucket, sum and count lines, then the sketch
+    // quantiles as a separate gauge family.
+    auto& buckets = impl.bucketScratch;
+    std::string le;
+    auto appendHistogram = [&](std::string_view name, std::string_view labels,
+                               const detail::HistogramCell& cell) {
+        cell.cumulativeBuckets(buckets);
+        for (std::size_t i = 0; i <= cell.boundaries.size(); ++i) {
+            le = "le=\"";
+            if (i < cell.boundaries.size()) {
+                appendDouble(le, cell.boundaries[i]);
+            } else {
+                le += "+Inf";
             }
-            out << name << "_bucket{le=\"+Inf\"} " << data.bucketCounts.back() << "\n";
+            le += '"';
+            appendSeries(out, name, "_bucket", labels, le);
+            out += ' ';
+            appendUint(out, buckets[i]);
+            out += '\n';
+        }
+        appendSeries(out, name, "_sum", labels);
+        out += ' ';
+        appendDouble(out, cell.sum());
+        out += '\n';
+        appendSeries(out, name, "_count", labels);
+        out += ' ';
+        appendUint(out, cell.count());
+        out += '\n';
+    };
+    static constexpr std::array<double, 4> kQuantiles{0.5, 0.9, 0.99, 0.999};
+    static constexpr std::array<std::string_view, kQuantiles.size()> kQuantileLabels{
+        "quantile=\"0.5\"", "quantile=\"0.9\"", "quantile=\"0.99\"", "quantile=\"0.999\""};
+    auto appendQuantiles = [&](std::string_view name, std::string_view labels,
+                               const detail::HistogramCell& cell) {
+        std::array<double, kQuantiles.size()> values{};
+        cell.quantiles(kQuantiles, values);
+        for (std::size_t i = 0; i < kQuantiles.size(); ++i) {
+            appendSeries(out, name, "_quantile", labels, kQuantileLabels[i]);
+            out += ' ';
+            appendDouble(out, values[i]);
+            out += '\n';
+        }
+    };
+    auto appendTypes = [&](std::string_view name, std::string_view suffix, std::string_view type) {
+        out += "# TYPE ";
+        out += name;
+        out += suffix;
+        out += type;
+    };
 
-            out << name << "_sum " << formatDouble(data.totalSum) << "\n";
-            out << name << "_count " << data.totalCount << "\n";
+    for (const auto& [name, cell] : impl.histogramSeries) {
+        appendTypes(*name, "", " histogram\n");
+        appendHistogram(*name, {}, *cell);
+        appendTypes(*name, "_quantile", " gauge\n");
+        appendQuantiles(*name, {}, *cell);
+    }
+    const auto& labeled = impl.histogramFamilySeries;
+    for (std::size_t begin = 0, end = 0; begin < labeled.size(); begin = end) {
+        const std::string& name = *labeled[begin].family;
+        while (end < labeled.size() && labeled[end].family == labeled[begin].family) {
+            ++end;
+        }
+        appendTypes(name, "", " histogram\n");
+        for (std::size_t i = begin; i < end; ++i) {
+            appendHistogram(name, *labeled[i].labels, *labeled[i].cell);
+        }
+        appendTypes(name, "_quantile", " gauge\n");
+        for (std::size_t i = begin; i < end; ++i) {
+            appendQuantiles(name, *labeled[i].labels, *labeled[i].cell);
         }
     }
 
-    return out.str();
+    // Lock contention (ProfiledMutex)
+    appendLockSites(out);
+
+    impl.renderedAt = now;
+    impl.bodyValid = true;
+    return out;
+}
+
+void GameMetrics::setScrapeCacheTtl(std::chrono::milliseconds ttl) {
+    impl_->cacheTtlMs.store(ttl.count(), std::memory_order_relaxed);
 }
 
 // ── Reset ───────────────────────────────────────────────────────────────────
 
 void GameMetrics::reset() {
+    std::lock_guard scrapeLock(impl_->scrapeMutex);
+    impl_->bodyValid = false;
     {
         std::lock_guard lock(impl_->counterMutex);
-        impl_->counters.clear();
+        for (auto it = impl_->counters.begin(); it != impl_->counters.end();) {
+            it->second.clear();
+            it = it->second.registered ? std::next(it) : impl_->counters.erase(it);
+        }
+        clearFamilies(impl_->counterFamilies, [](detail::CounterCell& cell) { cell.clear(); });
     }
     {
         std::lock_guard lock(impl_->gaugeMutex);
-        impl_->gauges.clear();
+        for (auto it = impl_->gauges.begin(); it != impl_->gauges.end();) {
+            atomicStore(it->second.value, 0.0);
+            it = it->second.registered ? std::next(it) : impl_->gauges.erase(it);
+        }
+        clearFamilies(impl_->gaugeFamilies,
+                      [](detail::GaugeCell& cell) { atomicStore(cell.value, 0.0); });
     }
     {
         std::lock_guard lock(impl_->histogramMutex);
-        impl_->histograms.clear();
+        for (auto it = impl_->histograms.begin(); it != impl_->histograms.end();) {
+            it->second.clear();
+            it = it->second.pinned ? std::next(it) : impl_->histograms.erase(it);
+        }
+        clearFamilies(impl_->histogramFamilies, [](detail::HistogramCell& cell) { cell.clear(); });
     }
     {
         std::lock_guard lock(impl_->healthMutex);
@@ -2,18 +2,29 @@
 /// @brief GameNetworkManager implementation wrapping kcenon network_system.
 
 #include "cgs/foundation/game_network_manager.hpp"
+#include "cgs/foundation/alloc_tracker.hpp"
+#include "cgs/foundation/game_metrics.hpp"
+#include "cgs/foundation/profiled_mutex.hpp"
+#include "cgs/foundation/spsc_queue.hpp"
 
 // kcenon facade headers (hidden behind PIMPL)
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
 #include <chrono>
+#include <condition_variable>
+#include <cstdio>
 #include <cstring>
 #include <kcenon/network/facade/tcp_facade.h>
 #include <kcenon/network/facade/udp_facade.h>
 #include <kcenon/network/facade/websocket_facade.h>
 #include <kcenon/network/interfaces/i_protocol_server.h>
 #include <kcenon/network/interfaces/i_session.h>
+#include <latch>
 #include <mutex>
 #include <shared_mutex>
+#include <thread>
 #include <unordered_map>
 
 namespace cgs::foundation {
@@ -23,29 +34,40 @@ namespace cgs::foundation {
 // ---------------------------------------------------------------------------
 
 std::vector<uint8_t> NetworkMessage::serialize() const {
-    // Wire format: [4-byte total length][2-byte opcode][payload]
+    // Wire format: [4-byte total length][2-byte opcode][trace context][payload]
+    const bool traced = trace.valid();
+    const std::size_t traceSize = traced ? TraceContext::kEncodedSize : 0;
     const uint32_t totalLen =
-        static_cast<uint32_t>(sizeof(uint32_t) + sizeof(uint16_t) + payload.size());
+        static_cast<uint32_t>(sizeof(uint32_t) + sizeof(uint16_t) + traceSize + payload.size());
+    const uint32_t lengthWord = totalLen | (compressed ? WireBuffer::kCompressedFlag : 0u) |
+                                (traced ? WireBuffer::kTracedFlag : 0u);
 
     std::vector<uint8_t> buf;
     buf.resize(totalLen);
 
     // Network byte order (big-endian)
-    buf[0] = static_cast<uint8_t>((totalLen >> 24) & 0xFF);
-    buf[1] = static_cast<uint8_t>((totalLen >> 16) & 0xFF);
-    buf[2] = static_cast<uint8_t>((totalLen >> 8) & 0xFF);
-    buf[3] = static_cast<uint8_t>(totalLen & 0xFF);
+    buf[0] = static_cast<uint8_t>((lengthWord >> 24) & 0xFF);
+    buf[1] = static_cast<uint8_t>((lengthWord >> 16) & 0xFF);
+    buf[2] = static_cast<uint8_t>((lengthWord >> 8) & 0xFF);
+    buf[3] = static_cast<uint8_t>(lengthWord & 0xFF);
 
     buf[4] = static_cast<uint8_t>((opcode >> 8) & 0xFF);
     buf[5] = static_cast<uint8_t>(opcode & 0xFF);
 
+    if (traced) {
+        trace.encode(buf.data() + 6);
+    }
     if (!payload.empty()) {
-        std::memcpy(buf.data() + 6, payload.data(), payload.size());
+        std::memcpy(buf.data() + 6 + traceSize, payload.data(), payload.size());
     }
 
     return buf;
 }
 
+WireBuffer NetworkMessage::frame(WireBufferPool& pool) const {
+    return pool.frame(opcode, payload, compressed, trace);
+}
+
 std::optional<NetworkMessage> NetworkMessage::deserialize(const uint8_t* data, std::size_t size) {
     // Minimum: 4 (length) + 2 (opcode) = 6 bytes
     constexpr std::size_t kHeaderSize = 6;
@@ -54,20 +76,27 @@ std::optional<NetworkMessage> NetworkMessage::deserialize(const uint8_t* data, s
     }
 
     // Read total length (network order)
-    const uint32_t totalLen =
+    const uint32_t lengthWord =
         (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) |
         (static_cast<uint32_t>(data[2]) << 8) | static_cast<uint32_t>(data[3]);
+    const uint32_t totalLen = lengthWord & WireBuffer::kLengthMask;
+    const bool traced = (lengthWord & WireBuffer::kTracedFlag) != 0;
+    const std::size_t prefixSize = kHeaderSize + (traced ? TraceContext::kEncodedSize : 0);
 
-    if (totalLen < kHeaderSize || totalLen > size) {
+    if (totalLen < prefixSize || totalLen > size) {
         return std::nullopt;
     }
 
     NetworkMessage msg;
+    msg.compressed = (lengthWord & WireBuffer::kCompressedFlag) != 0;
     msg.opcode = static_cast<uint16_t>((static_cast<uint16_t>(data[4]) << 8) | data[5]);
+    if (traced) {
+        msg.trace = TraceContext::decode(data + kHeaderSize);
+    }
 
-    const auto payloadSize = totalLen - kHeaderSize;
+    const auto payloadSize = totalLen - prefixSize;
     if (payloadSize > 0) {
-        msg.payload.assign(data + kHeaderSize, data + kHeaderSize + payloadSize);
+        msg.payload.assign(data + prefixSize, data + prefixSize + payloadSize);
     }
 
     return msg;
@@ -86,33 +115,756 @@ struct GameNetworkManager::Impl {
     std::unordered_map<Protocol, std::shared_ptr<kcenon::network::interfaces::i_protocol_server>>
         servers;
 
+    // Per-session state shared with the lock-free receive path
+    struct SessionState {
+        // Keeps coalesced batches in order
+        ProfiledMutex outboundMutex{"network.session_outbound"};
+        OutboundQueue outbound;
+        std::atomic<std::chrono::steady_clock::rep> lastActivity{0};
+        // Set at connect for UDP sessions while setUdpReliability() is on
+        std::unique_ptr<ReliableEndpoint> reliable;
+        ProfiledMutex reliableMutex{"network.session_reliable"};
+        // Outbound frames go through the compressor (setSessionCompression)
+        std::atomic<bool> compress{false};
+    };
+
     // Internal session data: maps our SessionId → kcenon session + metadata
     struct InternalSession {
         Protocol protocol;
         std::string kcSessionId;  // kcenon's string session ID
         std::shared_ptr<kcenon::network::interfaces::i_session> kcSession;
+        std::shared_ptr<SessionState> state;
         SessionInfo info;
     };
 
-    std::unordered_map<SessionId, InternalSession> sessions;
-    // Reverse lookup: kcenon string ID → our SessionId
-    std::unordered_map<std::string, SessionId> reverseMap;
+    // Session table shard; padded so neighbouring shard locks never share
+    // a cache line.
+    struct alignas(64) SessionShard {
+        mutable ProfiledSharedMutex mutex{"network.sessions"};
+        std::unordered_map<SessionId, InternalSession> sessions;
+    };
+
+    static constexpr std::size_t kSessionShards = 16;
 
-    // Opcode → handler
-    std::unordered_map<uint16_t, MessageHandler> handlers;
+    // What the lock-free paths (receive, broadcast, flush) see of a session
+    struct SessionEntry {
+        SessionId sid;
+        std::string kcSessionId;
+        std::shared_ptr<kcenon::network::interfaces::i_session> kcSession;
+        std::shared_ptr<SessionState> state;
+    };
+
+    // Immutable snapshot of every session: a dense list for broadcast and
+    // an open-addressing table keyed by the kcenon string ID's hash for the
+    // receive path.  Rebuilt under indexMutex whenever a session is added
+    // or removed.
+    struct SessionIndex {
+        struct Slot {
+            std::size_t hash = 0;
+            const SessionEntry* entry = nullptr;  // null marks an empty slot
+        };
+        std::vector<std::shared_ptr<const SessionEntry>> entries;
+        std::vector<Slot> slots;
+        std::size_t mask = 0;
+
+        const SessionEntry* find(std::string_view kcId) const noexcept {
+            if (slots.empty()) {
+                return nullptr;
+            }
+            const std::size_t hash = std::hash<std::string_view>{}(kcId);
+            for (std::size_t i = hash & mask;; i = (i + 1) & mask) {
+                const Slot& slot = slots[i];
+                if (slot.entry == nullptr) {
+                    return nullptr;
+                }
+                if (slot.hash == hash && slot.entry->kcSessionId == kcId) {
+                    return slot.entry;
+                }
+            }
+        }
+    };
+
+    std::array<SessionShard, kSessionShards> shards;
+    std::atomic<std::size_t> sessionTotal{0};
+
+    // Source of the published SessionIndex
+    ProfiledMutex indexMutex{"network.session_index"};
+    std::unordered_map<SessionId, std::shared_ptr<const SessionEntry>> indexEntries;
+
+    // Opcode → handler, one slot per opcode.  Registration swaps a slot's
+    // pointer; the receive path loads it without a lock.
+    static constexpr std::size_t kOpcodeCount = 65536;
+    std::unique_ptr<std::atomic<const MessageHandler*>[]> handlers =
+        std::make_unique<std::atomic<const MessageHandler*>[]>(kOpcodeCount);
+    // AllocTracker tag ("handler.0x<opcode>") per opcode with a handler
+    std::unique_ptr<std::atomic<AllocTag>[]> handlerTags =
+        std::make_unique<std::atomic<AllocTag>[]>(kOpcodeCount);
+    std::atomic<const SessionIndex*> sessionIndex{nullptr};
+
+    // Lock-free readers (receive callbacks, broadcast, flush) run inside a
+    // ReadGuard.  Handlers and indexes
+    // unpublished by a writer are retired and freed once no guard is open,
+    // so a reader never sees them destroyed.
+    std::atomic<uint32_t> activeReaders{0};
+    std::mutex retireMutex;
+    std::vector<std::unique_ptr<const MessageHandler>> retiredHandlers;
+    std::vector<std::unique_ptr<const SessionIndex>> retiredIndexes;
+
+    struct ReadGuard {
+        explicit ReadGuard(std::atomic<uint32_t>& counter) : readers(counter) {
+            readers.fetch_add(1);
+        }
+        ~ReadGuard() { readers.fetch_sub(1); }
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+        std::atomic<uint32_t>& readers;
+    };
 
     std::atomic<uint64_t> nextSessionId{1};
-    mutable std::shared_mutex sessionMutex;
-    mutable std::shared_mutex handlerMutex;
+
+    // Frames built by send()/broadcast() of a NetworkMessage
+    WireBufferPool wirePool;
+
+    // Outbound coalescing (setCoalescing)
+    std::atomic<bool> coalesce{false};
+    std::atomic<std::size_t> flushThreshold{OutboundQueue::kDefaultFlushThreshold};
+    mutable ProfiledMutex budgetMutex{"network.lane_budgets"};
+    LaneBudgets laneBudgets;
+
+    // UDP reliability layer for sessions connected while enabled
+    std::atomic<bool> udpReliability{false};
+
+    // Resumption and offload requests of the TLS listener (recorded only)
+
+    // Payload compression (setCompression); changed only while no server
+    // is listening
+    std::unique_ptr<PayloadCompressor> compressor;
+    std::mutex publishedMutex;
+    CompressionStats published;  // as of the last publishCompressionMetrics()
+
+    // Reactor mode (setReactors): session sid is pinned to reactor
+    // sid % reactors.size(), which decodes its input on its own thread
+    // and hands the messages to dispatchInbound() through an SPSC queue.
+    struct Inbound {
+        SessionId sid;
+        NetworkMessage msg;
+        ErrorCode error = ErrorCode::Success;  // set for a malformed input
+    };
+
+    struct Ingress {
+        SessionId sid;
+        std::shared_ptr<SessionState> state;
+        std::vector<uint8_t> bytes;
+        PayloadCompressor* codec = nullptr;
+    };
+
+    // Session groups (createGroup): a member map edited in place by
+    // membership changes, and an immutable send list split by reactor
+    // that the first sendToGroup() after a change rebuilds.
+    struct GroupShare {
+        std::size_t reactor = 0;  // reactors.size() or more: the caller sends
+        std::vector<std::shared_ptr<const SessionEntry>> members;
+    };
+
+    struct GroupSendList {
+        std::vector<GroupShare> shares;  // non-empty ones only
+    };
+
+    struct Group {
+        std::string name;
+        std::unordered_map<SessionId, std::shared_ptr<const SessionEntry>> members;
+        std::shared_ptr<const GroupSendList> sendList;  // null after a change
+    };
+
+    mutable ProfiledSharedMutex groupMutex{"network.session_groups"};
+    std::unordered_map<SessionGroupId, Group> groups;
+    std::unordered_map<std::string, SessionGroupId> groupNames;
+    std::unordered_map<SessionId, std::vector<SessionGroupId>> memberships;
+    uint64_t nextGroupId = 1;
+
+    // One share of a sendToGroup() call, owned by the caller until every
+    // share has counted down @p done
+    struct Fanout {
+        const GroupShare* share = nullptr;
+        const WireBuffer* frame = nullptr;
+        const WireBuffer* packed = nullptr;  // compressed frame, if compressing
+        SendLane lane = SendLane::Critical;
+        uint64_t stateKey = 0;
+        bool coalesce = false;
+        std::latch* done = nullptr;
+    };
+
+    struct alignas(64) Reactor {
+        explicit Reactor(std::size_t queueCapacity) : outbox(queueCapacity) {}
+
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::vector<Ingress> ingress;  // from transport threads
+        std::vector<Fanout*> egress;   // from sendToGroup() callers
+        bool stop = false;
+        std::atomic<bool> stopping{false};
+
+        SpscQueue<Inbound> outbox;  // reactor thread -> dispatchInbound()
+        std::atomic<uint64_t> received{0};
+        std::atomic<uint64_t> decoded{0};
+        std::atomic<uint64_t> stalls{0};
+        std::atomic<uint64_t> fanouts{0};
+        std::thread thread;
+    };
+
+    // Changed only while no server is listening
+    std::vector<std::unique_ptr<Reactor>> reactors;
 
     // Back-pointer for signal emission (non-owning, always valid during Impl lifetime)
     GameNetworkManager* owner = nullptr;
 
+    ~Impl() {
+        stopReactors();
+        delete sessionIndex.load();
+        for (std::size_t op = 0; op < kOpcodeCount; ++op) {
+            delete handlers[op].load();
+        }
+    }
+
+    // Free retired objects if no receive callback can still hold them.
+    // Caller holds retireMutex and has published their replacements.
+    void reclaimLocked() {
+        if (activeReaders.load() == 0) {
+            retiredHandlers.clear();
+            retiredIndexes.clear();
+        }
+    }
+
+    // Publish @p handler for @p opcode (null or empty removes it)
+    void publishHandler(uint16_t opcode, const MessageHandler* handler) {
+        const MessageHandler* old = handlers[opcode].exchange(handler);
+        std::lock_guard lock(retireMutex);
+        retiredHandlers.emplace_back(old);
+        reclaimLocked();
+    }
+
+    SessionShard& shardFor(SessionId sid) noexcept {
+        return shards[std::hash<SessionId>{}(sid) & (kSessionShards - 1)];
+    }
+
+    // Rebuild and publish sessionIndex (caller holds indexMutex)
+    void publishIndexLocked() {
+        auto index = std::make_unique<SessionIndex>();
+        const std::size_t capacity =
+            std::bit_ceil(std::max<std::size_t>(indexEntries.size() * 2, 8));
+        index->entries.reserve(indexEntries.size());
+        index->slots.resize(capacity);
+        index->mask = capacity - 1;
+        for (const auto& [sid, entry] : indexEntries) {
+            const std::size_t hash = std::hash<std::string_view>{}(entry->kcSessionId);
+            std::size_t i = hash & index->mask;
+            while (index->slots[i].entry != nullptr) {
+                i = (i + 1) & index->mask;
+            }
+            index->slots[i] = {hash, entry.get()};
+            index->entries.push_back(entry);
+        }
+        const SessionIndex* old = sessionIndex.exchange(index.release());
+        std::lock_guard lock(retireMutex);
+        retiredIndexes.emplace_back(old);
+        reclaimLocked();
+    }
+
+    // Add @p internal to its shard and the published index
+    void addSession(SessionId sid, InternalSession internal) {
+        auto entry = std::make_shared<const SessionEntry>(
+            SessionEntry{sid, internal.kcSessionId, internal.kcSession, internal.state});
+        {
+            auto& shard = shardFor(sid);
+            std::unique_lock lock(shard.mutex);
+            shard.sessions.emplace(sid, std::move(internal));
+        }
+        sessionTotal.fetch_add(1, std::memory_order_relaxed);
+
+        std::lock_guard lock(indexMutex);
+        indexEntries.emplace(sid, std::move(entry));
+        publishIndexLocked();
+    }
+
+    // Remove the sessions matching @p pred from every shard and the index.
+    // @return the number removed.
+    template <typename Pred>
+    std::size_t removeSessions(Pred pred) {
+        std::vector<SessionId> removed;
+        for (auto& shard : shards) {
+            std::unique_lock lock(shard.mutex);
+            for (auto it = shard.sessions.begin(); it != shard.sessions.end();) {
+                if (pred(it->second)) {
+                    removed.push_back(it->first);
+                    it = shard.sessions.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+        if (removed.empty()) {
+            return 0;
+        }
+        sessionTotal.fetch_sub(removed.size(), std::memory_order_relaxed);
+
+        {
+            std::lock_guard lock(indexMutex);
+            for (auto sid : removed) {
+                indexEntries.erase(sid);
+            }
+            publishIndexLocked();
+        }
+        leaveGroups(removed);
+        return removed.size();
+    }
+
+    // Remove @p sid; false if it was already gone.
+    bool removeSession(SessionId sid) {
+        {
+            auto& shard = shardFor(sid);
+            std::unique_lock lock(shard.mutex);
+            if (shard.sessions.erase(sid) == 0) {
+                return false;
+            }
+        }
+        sessionTotal.fetch_sub(1, std::memory_order_relaxed);
+
+        {
+            std::lock_guard lock(indexMutex);
+            indexEntries.erase(sid);
+            publishIndexLocked();
+        }
+        leaveGroups({sid});
+        return true;
+    }
+
+    // Drop @p removed sessions from their groups.  Runs after they left
+    // the index, so addToGroup() can no longer find them.
+    void leaveGroups(const std::vector<SessionId>& removed) {
+        std::unique_lock lock(groupMutex);
+        for (auto sid : removed) {
+            auto it = memberships.find(sid);
+            if (it == memberships.end()) {
+                continue;
+            }
+            for (auto id : it->second) {
+                auto group = groups.find(id);
+                if (group != groups.end() && group->second.members.erase(sid) != 0) {
+                    group->second.sendList.reset();
+                }
+            }
+            memberships.erase(it);
+        }
+    }
+
+    // @p group's send list, rebuilt if members changed since the last
+    // send; null for an unknown group
+    std::shared_ptr<const GroupSendList> groupSendList(SessionGroupId group) {
+        {
+            std::shared_lock lock(groupMutex);
+            auto it = groups.find(group);
+            if (it == groups.end()) {
+                return nullptr;
+            }
+            if (it->second.sendList) {
+                return it->second.sendList;
+            }
+        }
+        std::unique_lock lock(groupMutex);
+        auto it = groups.find(group);
+        if (it == groups.end()) {
+            return nullptr;
+        }
+        if (!it->second.sendList) {
+            // Split by the reactor each session is pinned to
+            const std::size_t count = std::max<std::size_t>(reactors.size(), 1);
+            auto list = std::make_shared<GroupSendList>();
+            list->shares.resize(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                list->shares[i].reactor = i;
+            }
+            for (const auto& [sid, entry] : it->second.members) {
+                list->shares[sid.value() % count].members.push_back(entry);
+            }
+            std::erase_if(list->shares,
+                          [](const GroupShare& share) { return share.members.empty(); });
+            it->second.sendList = std::move(list);
+        }
+        return it->second.sendList;
+    }
+
+    // Copy @p sid's transport session and state out of its shard
+    bool lookup(SessionId sid,
+                std::shared_ptr<kcenon::network::interfaces::i_session>& kcSession,
+                std::shared_ptr<SessionState>& state) {
+        auto& shard = shardFor(sid);
+        std::shared_lock lock(shard.mutex);
+        auto it = shard.sessions.find(sid);
+        if (it == shard.sessions.end()) {
+            return false;
+        }
+        kcSession = it->second.kcSession;
+        state = it->second.state;
+        return true;
+    }
+
     // Allocate a new SessionId
     SessionId allocateSessionId() {
         return SessionId(nextSessionId.fetch_add(1, std::memory_order_relaxed));
     }
 
+    // Hand @p state's queued batch to @p kcSession (caller holds its mutex)
+    static GameResult<void> sendBatch(SessionId sid,
+                                      kcenon::network::interfaces::i_session& kcSession,
+                                      SessionState& state) {
+        if (state.outbound.empty()) {
+            return GameResult<void>::ok();
+        }
+        auto result = kcSession.send(state.outbound.take());
+        if (result.is_err()) {
+            return GameResult<void>::err(GameError(
+                ErrorCode::SendFailed, "send failed for session " + std::to_string(sid.value())));
+        }
+        return GameResult<void>::ok();
+    }
+
+    // Hand all of @p state's queue to @p kcSession, ignoring the per-flush
+    // limit (caller holds its mutex)
+    static void drain(SessionId sid,
+                      kcenon::network::interfaces::i_session& kcSession,
+                      SessionState& state) {
+        while (!state.outbound.empty()) {
+            if (!sendBatch(sid, kcSession, state)) {
+                return;
+            }
+        }
+    }
+
+    // Queue @p frame for @p state's session, sending a batch when the
+    // queue reaches its threshold (caller holds state.outboundMutex)
+    static GameResult<void> enqueue(SessionId sid,
+                                    kcenon::network::interfaces::i_session& kcSession,
+                                    SessionState& state,
+                                    WireBuffer frame,
+                                    SendLane lane,
+                                    uint64_t stateKey) {
+        switch (state.outbound.push(std::move(frame), lane, stateKey)) {
+            case EnqueueResult::Queued:
+                return GameResult<void>::ok();
+            case EnqueueResult::FlushNow:
+                return sendBatch(sid, kcSession, state);
+            case EnqueueResult::Rejected:
+                break;
+        }
+        return GameResult<void>::err(
+            GameError(ErrorCode::SendQueueFull,
+                      "outbound lane full for session " + std::to_string(sid.value())));
+    }
+
+    // Queue @p bytes on @p state's ReliableEndpoint, and send the
+    // resulting datagrams unless coalescing defers them to the next
+    // updateReliability()
+    static GameResult<void> sendReliable(SessionId sid,
+                                         kcenon::network::interfaces::i_session& kcSession,
+                                         SessionState& state,
+                                         DeliveryChannel channel,
+                                         std::span<const uint8_t> bytes,
+                                         bool deferred) {
+        std::lock_guard lock(state.reliableMutex);
+        if (!state.reliable->send(channel, bytes)) {
+            return GameResult<void>::err(
+                GameError(ErrorCode::InvalidMessage,
+                          "message too large for reliable UDP on session " +
+                              std::to_string(sid.value())));
+        }
+        if (!deferred) {
+            pumpLocked(sid, kcSession, state, std::chrono::steady_clock::now());
+        }
+        return GameResult<void>::ok();
+    }
+
+    // Send @p state's due datagrams (caller holds reliableMutex)
+    static GameResult<void> pumpLocked(SessionId sid,
+                                       kcenon::network::interfaces::i_session& kcSession,
+                                       SessionState& state,
+                                       std::chrono::steady_clock::time_point now) {
+        std::vector<std::vector<uint8_t>> packets;
+        state.reliable->poll(now, packets);
+        for (auto& packet : packets) {
+            if (kcSession.send(std::move(packet)).is_err()) {
+                return GameResult<void>::err(
+                    GameError(ErrorCode::SendFailed,
+                              "send failed for session " + std::to_string(sid.value())));
+            }
+        }
+        return GameResult<void>::ok();
+    }
+
+    // @p frame with its payload compressed, or @p frame itself when that
+    // does not pay off (compressor must be set)
+    WireBuffer compressFrame(WireBuffer frame) {
+        if (frame.compressed()) {
+            return frame;
+        }
+        thread_local std::vector<uint8_t> packed;
+        packed.clear();
+        if (!compressor->compress(frame.opcode(), frame.payload(), packed)) {
+            return frame;
+        }
+        const bool traced = frame.traced();
+        WireBuffer out =
+            wirePool.acquire((traced ? TraceContext::kEncodedSize : 0) + packed.size());
+        if (traced) {
+            frame.traceContext().encode(out.extend(TraceContext::kEncodedSize).data());
+        }
+        out.append(packed.data(), packed.size());
+        out.seal(frame.opcode(), true, traced);
+        return out;
+    }
+
+    // Send or queue the shared @p out for @p entry's session: the fan-out
+    // step of broadcast() and sendToGroup()
+    static void deliver(const SessionEntry& entry,
+                        const WireBuffer& out,
+                        SendLane lane,
+                        uint64_t stateKey,
+                        bool coalesce) {
+        const auto bytes = out.bytes();
+        if (entry.state->reliable) {
+            (void)sendReliable(entry.sid, *entry.kcSession, *entry.state,
+                               DeliveryChannel::ReliableOrdered, bytes, coalesce);
+            return;
+        }
+        if (coalesce) {
+            // Every queue shares the one frame until it is flushed
+            std::lock_guard queueLock(entry.state->outboundMutex);
+            (void)enqueue(entry.sid, *entry.kcSession, *entry.state, out, lane, stateKey);
+            return;
+        }
+        // kcenon takes ownership of a vector: copy the shared frame
+        (void)entry.kcSession->send(std::vector<uint8_t>(bytes.begin(), bytes.end()));
+    }
+
+    // Send @p fanout's frame to its share of a group, then count it done
+    static void sendShare(const Fanout& fanout) {
+        for (const auto& entry : fanout.share->members) {
+            if (entry->kcSession && entry->kcSession->is_connected()) {
+                const bool compressed = fanout.packed != nullptr &&
+                                        entry->state->compress.load(std::memory_order_relaxed);
+                deliver(*entry, compressed ? *fanout.packed : *fanout.frame, fanout.lane,
+                        fanout.stateKey, fanout.coalesce);
+            }
+        }
+        fanout.done->count_down();
+    }
+
+    // Send or queue @p frame for one session: through its ReliableEndpoint
+    // on reliable UDP, else through the coalescing queue or straight to
+    // the transport
+    GameResult<void> sendFrame(SessionId sid,
+                               kcenon::network::interfaces::i_session& kcSession,
+                               SessionState& state,
+                               WireBuffer frame,
+                               SendLane lane,
+                               uint64_t stateKey,
+                               DeliveryChannel channel) {
+        if (compressor && state.compress.load(std::memory_order_relaxed)) {
+            frame = compressFrame(std::move(frame));
+        }
+        const bool coalesced = coalesce.load(std::memory_order_relaxed);
+        if (state.reliable) {
+            return sendReliable(sid, kcSession, state, channel, frame.bytes(), coalesced);
+        }
+
+        if (coalesced) {
+            std::lock_guard queueLock(state.outboundMutex);
+            return enqueue(sid, kcSession, state, std::move(frame), lane, stateKey);
+        }
+
+        auto result = kcSession.send(frame.take());
+        if (result.is_err()) {
+            return GameResult<void>::err(GameError(
+                ErrorCode::SendFailed, "send failed for session " + std::to_string(sid.value())));
+        }
+        return GameResult<void>::ok();
+    }
+
+    // Call @p fn with every NetworkMessage frame in @p data, decoding
+    // compressed payloads with @p codec.
+    // @return false if a frame is malformed (the rest is skipped).
+    template <typename Fn>
+    static bool forEachFrame(const uint8_t* data,
+                             std::size_t size,
+                             PayloadCompressor* codec,
+                             Fn&& fn) {
+        // TCP streams may deliver multiple serialized messages in a single
+        // callback.
+        constexpr std::size_t kMinFrameSize = 6;  // 4 length + 2 opcode
+        std::size_t offset = 0;
+
+        while (offset + kMinFrameSize <= size) {
+            auto remaining = size - offset;
+            auto msg = NetworkMessage::deserialize(data + offset, remaining);
+            if (!msg) {
+                return false;
+            }
+
+            if (msg->compressed) {
+                std::vector<uint8_t> inflated;
+                if (codec == nullptr || !codec->decompress(msg->payload, inflated)) {
+                    return false;
+                }
+                msg->payload = std::move(inflated);
+                msg->compressed = false;
+            }
+
+            // Read total length from header to advance the offset
+            uint32_t totalLen = ((static_cast<uint32_t>(data[offset]) << 24) |
+                                 (static_cast<uint32_t>(data[offset + 1]) << 16) |
+                                 (static_cast<uint32_t>(data[offset + 2]) << 8) |
+                                 static_cast<uint32_t>(data[offset + 3])) &
+                                WireBuffer::kLengthMask;
+            offset += totalLen;
+
+            fn(std::move(*msg));
+        }
+        return true;
+    }
+
+    // Run @p msg's handler (caller holds a ReadGuard)
+    void dispatch(SessionId sid, const NetworkMessage& msg) {
+        const MessageHandler* handler = handlers[msg.opcode].load();
+        if (handler != nullptr && *handler) {
+            AllocTagScope allocScope(handlerTags[msg.opcode].load(std::memory_order_relaxed));
+            (*handler)(sid, msg);
+        }
+    }
+
+    // Dispatch every NetworkMessage frame in @p data to its handler
+    void dispatchFrames(SessionId sid, const uint8_t* data, std::size_t size) {
+        if (!forEachFrame(data, size, compressor.get(),
+                          [&](NetworkMessage msg) { dispatch(sid, msg); })) {
+            owner->onError.emit(sid, ErrorCode::InvalidMessage);
+        }
+    }
+
+    // Hand @p inbound to the game thread through @p reactor's outbox
+    static void publish(Reactor& reactor, Inbound inbound) {
+        if (reactor.outbox.tryPush(std::move(inbound))) {
+            return;
+        }
+        // The game thread is behind: wait for room rather than drop
+        // input; the reactor's ingress grows meanwhile.
+        reactor.stalls.fetch_add(1, std::memory_order_relaxed);
+        while (!reactor.outbox.tryPush(std::move(inbound))) {
+            if (reactor.stopping.load(std::memory_order_relaxed)) {
+                return;
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    // Run the reliability layer and frame decoding for @p input on its
+    // reactor thread
+    static void decode(Reactor& reactor, Ingress& input) {
+        reactor.received.fetch_add(1, std::memory_order_relaxed);
+        auto emit = [&](NetworkMessage msg) {
+            reactor.decoded.fetch_add(1, std::memory_order_relaxed);
+            publish(reactor, Inbound{input.sid, std::move(msg)});
+        };
+        auto malformed = [&] {
+            publish(reactor, Inbound{input.sid, NetworkMessage{}, ErrorCode::InvalidMessage});
+        };
+
+        if (!input.state->reliable) {
+            if (!forEachFrame(input.bytes.data(), input.bytes.size(), input.codec, emit)) {
+                malformed();
+            }
+            return;
+        }
+
+        std::vector<std::vector<uint8_t>> messages;
+        bool valid = false;
+        {
+            std::lock_guard lock(input.state->reliableMutex);
+            valid = input.state->reliable->receive(
+                input.bytes, std::chrono::steady_clock::now(), messages);
+        }
+        if (!valid) {
+            malformed();
+        }
+        for (const auto& message : messages) {
+            if (!forEachFrame(message.data(), message.size(), input.codec, emit)) {
+                malformed();
+            }
+        }
+    }
+
+    static void reactorLoop(Reactor& reactor) {
+        std::vector<Ingress> batch;
+        std::vector<Fanout*> fanouts;
+        for (;;) {
+            {
+                std::unique_lock lock(reactor.mutex);
+                reactor.wake.wait(lock, [&] {
+                    return reactor.stop || !reactor.ingress.empty() || !reactor.egress.empty();
+                });
+                if (reactor.stop) {
+                    return;  // Callers send the shares left in egress
+                }
+                batch.swap(reactor.ingress);
+                fanouts.swap(reactor.egress);
+            }
+            // Group sends first: their callers are waiting
+            for (Fanout* fanout : fanouts) {
+                sendShare(*fanout);
+                reactor.fanouts.fetch_add(1, std::memory_order_relaxed);
+            }
+            fanouts.clear();
+            for (auto& input : batch) {
+                decode(reactor, input);
+            }
+            batch.clear();
+        }
+    }
+
+    // Hand @p data from @p entry's session to its reactor
+    void route(const SessionEntry& entry, const std::vector<uint8_t>& data) {
+        Reactor& reactor = *reactors[entry.sid.value() % reactors.size()];
+        {
+            std::lock_guard lock(reactor.mutex);
+            reactor.ingress.push_back(Ingress{entry.sid, entry.state, data, compressor.get()});
+        }
+        reactor.wake.notify_one();
+    }
+
+    void startReactors(std::size_t count, std::size_t queueCapacity, const CpuSet& affinity) {
+        reactors.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            auto reactor = std::make_unique<Reactor>(queueCapacity);
+            Reactor& self = *reactor;
+            reactor->thread = std::thread([&self, i, affinity] {
+                (void)pinPoolThread(affinity, i);  // Best effort
+                reactorLoop(self);
+            });
+            reactors.push_back(std::move(reactor));
+        }
+    }
+
+    // Join every reactor, discarding input not yet dispatched
+    void stopReactors() {
+        for (auto& reactor : reactors) {
+            {
+                std::lock_guard lock(reactor->mutex);
+                reactor->stop = true;
+            }
+            reactor->stopping.store(true, std::memory_order_relaxed);
+            reactor->wake.notify_one();
+            reactor->thread.join();
+        }
+        reactors.clear();
+    }
+
     // Create a protocol server with the given port and optional TLS config.
     // Note: UDP facade auto-starts the server during creation, so the
     // caller must skip the explicit start() call for UDP.
@@ -161,103 +913,103 @@ struct GameNetworkManager::Impl {
                 internal.protocol = protocol;
                 internal.kcSessionId = kcId;
                 internal.kcSession = kcSession;
+                internal.state = std::make_shared<SessionState>();
+                internal.state->outbound.setFlushThreshold(
+                    flushThreshold.load(std::memory_order_relaxed));
+                {
+                    std::lock_guard budgetLock(budgetMutex);
+                    internal.state->outbound.setBudgets(laneBudgets);
+                }
+                if (compressor && compressor->config().enabledByDefault) {
+                    internal.state->compress.store(true, std::memory_order_relaxed);
+                }
+                if (protocol == Protocol::UDP && udpReliability.load(std::memory_order_relaxed)) {
+                    internal.state->reliable = std::make_unique<ReliableEndpoint>();
+                }
                 internal.info.id = sid;
                 internal.info.protocol = protocol;
                 internal.info.remoteAddress = kcId;
                 internal.info.connectedAt = now;
                 internal.info.lastActivity = now;
+                internal.state->lastActivity.store(now.time_since_epoch().count(),
+                                                   std::memory_order_relaxed);
 
-                {
-                    std::unique_lock lock(sessionMutex);
-                    sessions.emplace(sid, std::move(internal));
-                    reverseMap.emplace(kcId, sid);
-                }
+                addSession(sid, std::move(internal));
 
                 owner->onConnected.emit(sid);
             });
 
         server->set_receive_callback(
             [this](std::string_view kcId, const std::vector<uint8_t>& data) {
-                SessionId sid;
-                {
-                    std::shared_lock lock(sessionMutex);
-                    auto it = reverseMap.find(std::string(kcId));
-                    if (it == reverseMap.end()) {
-                        return;
-                    }
-                    sid = it->second;
-                    // Update last activity
-                    auto sit = sessions.find(sid);
-                    if (sit != sessions.end()) {
-                        sit->second.info.lastActivity = std::chrono::steady_clock::now();
-                    }
+                // No locks or allocations outside the reliable UDP path:
+                // the session index and handler slots are read through
+                // ReadGuard-protected pointers.
+                ReadGuard guard(activeReaders);
+                const SessionIndex* index = sessionIndex.load();
+                const SessionEntry* entry = index != nullptr ? index->find(kcId) : nullptr;
+                if (entry == nullptr) {
+                    return;
                 }
+                const SessionId sid = entry->sid;
+                const auto now = std::chrono::steady_clock::now();
+                entry->state->lastActivity.store(now.time_since_epoch().count(),
+                                                 std::memory_order_relaxed);
 
-                // Parse all messages from the buffer. TCP streams may
-                // deliver multiple serialized messages in a single callback.
-                constexpr std::size_t kMinFrameSize = 6;  // 4 length + 2 opcode
-                std::size_t offset = 0;
-
-                while (offset + kMinFrameSize <= data.size()) {
-                    auto remaining = data.size() - offset;
-                    auto msg = NetworkMessage::deserialize(data.data() + offset, remaining);
-                    if (!msg) {
-                        owner->onError.emit(sid, ErrorCode::InvalidMessage);
-                        break;
-                    }
-
-                    // Read total length from header to advance the offset
-                    uint32_t totalLen = (static_cast<uint32_t>(data[offset]) << 24) |
-                                        (static_cast<uint32_t>(data[offset + 1]) << 16) |
-                                        (static_cast<uint32_t>(data[offset + 2]) << 8) |
-                                        static_cast<uint32_t>(data[offset + 3]);
-                    offset += totalLen;
-
-                    MessageHandler handler;
-                    {
-                        std::shared_lock lock(handlerMutex);
-                        auto it = handlers.find(msg->opcode);
-                        if (it != handlers.end()) {
-                            handler = it->second;
-                        }
-                    }
-                    if (handler) {
-                        handler(sid, *msg);
-                    }
+                if (!reactors.empty()) {
+                    route(*entry, data);
+                    return;
+                }
+                if (!entry->state->reliable) {
+                    dispatchFrames(sid, data.data(), data.size());
+                    return;
+                }
+
+                // Handlers run after the endpoint lock is released, so they
+                // may send to this session.
+                std::vector<std::vector<uint8_t>> messages;
+                bool valid = false;
+                {
+                    std::lock_guard lock(entry->state->reliableMutex);
+                    valid = entry->state->reliable->receive(data, now, messages);
+                }
+                if (!valid) {
+                    owner->onError.emit(sid, ErrorCode::InvalidMessage);
+                }
+                for (const auto& message : messages) {
+                    dispatchFrames(sid, message.data(), message.size());
                 }
             });
 
         server->set_disconnection_callback([this](std::string_view kcId) {
-            SessionId sid;
-            {
-                std::unique_lock lock(sessionMutex);
-                auto it = reverseMap.find(std::string(kcId));
-                if (it == reverseMap.end()) {
-                    return;
-                }
-                sid = it->second;
-                sessions.erase(sid);
-                reverseMap.erase(it);
+            auto sid = findSession(kcId);
+            if (!sid || !removeSession(*sid)) {
+                return;
             }
 
-            owner->onDisconnected.emit(sid);
+            owner->onDisconnected.emit(*sid);
         });
 
         server->set_error_callback([this](std::string_view kcId, std::error_code ec) {
-            SessionId sid;
-            {
-                std::shared_lock lock(sessionMutex);
-                auto it = reverseMap.find(std::string(kcId));
-                if (it == reverseMap.end()) {
-                    return;
-                }
-                sid = it->second;
+            auto sid = findSession(kcId);
+            if (!sid) {
+                return;
             }
             // Map system error to our ErrorCode
             auto code = ec ? ErrorCode::NetworkError : ErrorCode::Success;
-            owner->onError.emit(sid, code);
+            owner->onError.emit(*sid, code);
         });
     }
+
+    // SessionId of the kcenon session @p kcId
+    std::optional<SessionId> findSession(std::string_view kcId) {
+        ReadGuard guard(activeReaders);
+        const SessionIndex* index = sessionIndex.load();
+        const SessionEntry* entry = index != nullptr ? index->find(kcId) : nullptr;
+        if (entry == nullptr) {
+            return std::nullopt;
+        }
+        return entry->sid;
+    }
 };
 
 // ---------------------------------------------------------------------------
@@ -344,6 +1096,16 @@ GameResult<void> GameNetworkManager::listen(uint16_t port,
         return GameResult<void>::err(GameError(ErrorCode::TlsCertificateInvalid,
                                                "TLS config requires both certPath and keyPath"));
     }
+    // The facade takes no ticket-key callback or socket options, so
+    // neither shared ticket keys nor kernel offload can be applied.
+    if (tls.ticketKeys) {
+        return GameResult<void>::err(GameError(
+            ErrorCode::TlsNotSupported, "TLS session ticket keys cannot be installed yet"));
+    }
+    if (tls.kernelOffload) {
+        return GameResult<void>::err(
+            GameError(ErrorCode::TlsNotSupported, "kernel TLS offload is not supported yet"));
+    }
 
     // Check if already listening on this protocol
     if (impl_->servers.count(protocol) > 0) {
@@ -386,17 +1148,9 @@ GameResult<void> GameNetworkManager::stop(Protocol protocol) {
     (void)it->second->stop();
 
     // Clean up sessions for this protocol
-    {
-        std::unique_lock lock(impl_->sessionMutex);
-        for (auto sit = impl_->sessions.begin(); sit != impl_->sessions.end();) {
-            if (sit->second.protocol == protocol) {
-                impl_->reverseMap.erase(sit->second.kcSessionId);
-                sit = impl_->sessions.erase(sit);
-            } else {
-                ++sit;
-            }
-        }
-    }
+    (void)impl_->removeSessions([protocol](const Impl::InternalSession& internal) {
+        return internal.protocol == protocol;
+    });
 
     impl_->servers.erase(it);
     return GameResult<void>::ok();
@@ -412,72 +1166,536 @@ void GameNetworkManager::stopAll() {
     }
     impl_->servers.clear();
 
-    std::unique_lock lock(impl_->sessionMutex);
-    impl_->sessions.clear();
-    impl_->reverseMap.clear();
+    (void)impl_->removeSessions([](const Impl::InternalSession&) { return true; });
 }
 
 // ---------------------------------------------------------------------------
 // send()
 // ---------------------------------------------------------------------------
 
-GameResult<void> GameNetworkManager::send(SessionId session, const NetworkMessage& msg) {
+GameResult<void> GameNetworkManager::send(SessionId session,
+                                          const NetworkMessage& msg,
+                                          SendLane lane,
+                                          uint64_t stateKey) {
+    return send(session, msg.frame(impl_->wirePool), lane, stateKey);
+}
+
+GameResult<void> GameNetworkManager::send(SessionId session,
+                                          WireBuffer frame,
+                                          SendLane lane,
+                                          uint64_t stateKey) {
+    std::shared_ptr<kcenon::network::interfaces::i_session> kcSession;
+    std::shared_ptr<Impl::SessionState> state;
+    if (!impl_->lookup(session, kcSession, state)) {
+        return GameResult<void>::err(
+            GameError(ErrorCode::SessionNotFound,
+                      "session " + std::to_string(session.value()) + " not found"));
+    }
+
+    return impl_->sendFrame(session, *kcSession, *state, std::move(frame), lane, stateKey,
+                            DeliveryChannel::ReliableOrdered);
+}
+
+GameResult<void> GameNetworkManager::send(SessionId session,
+                                          const NetworkMessage& msg,
+                                          DeliveryChannel channel) {
     std::shared_ptr<kcenon::network::interfaces::i_session> kcSession;
+    std::shared_ptr<Impl::SessionState> state;
+    if (!impl_->lookup(session, kcSession, state)) {
+        return GameResult<void>::err(
+            GameError(ErrorCode::SessionNotFound,
+                      "session " + std::to_string(session.value()) + " not found"));
+    }
+
+    return impl_->sendFrame(session, *kcSession, *state, msg.frame(impl_->wirePool),
+                            SendLane::Critical, 0, channel);
+}
+
+// ---------------------------------------------------------------------------
+// broadcast()
+// ---------------------------------------------------------------------------
+
+GameResult<void> GameNetworkManager::broadcast(const NetworkMessage& msg,
+                                               SendLane lane,
+                                               uint64_t stateKey) {
+    return broadcast(msg.frame(impl_->wirePool), lane, stateKey);
+}
+
+GameResult<void> GameNetworkManager::broadcast(const WireBuffer& frame,
+                                               SendLane lane,
+                                               uint64_t stateKey) {
+    const bool coalesce = impl_->coalesce.load(std::memory_order_relaxed);
+    WireBuffer packed;  // compressed once, for every session that takes it
+
+    // Walk the published snapshot: no session lock is held while sending.
+    Impl::ReadGuard guard(impl_->activeReaders);
+    const Impl::SessionIndex* index = impl_->sessionIndex.load();
+    if (index == nullptr) {
+        return GameResult<void>::ok();
+    }
+    for (const auto& entry : index->entries) {
+        if (entry->kcSession && entry->kcSession->is_connected()) {
+            const bool compressed =
+                impl_->compressor && entry->state->compress.load(std::memory_order_relaxed);
+            if (compressed && !packed) {
+                packed = impl_->compressFrame(frame);
+            }
+            Impl::deliver(*entry, compressed ? packed : frame, lane, stateKey, coalesce);
+        }
+    }
+    return GameResult<void>::ok();
+}
+
+WireBufferPool& GameNetworkManager::wirePool() {
+    return impl_->wirePool;
+}
+
+// ---------------------------------------------------------------------------
+// Session groups
+// ---------------------------------------------------------------------------
+
+GameResult<SessionGroupId> GameNetworkManager::createGroup(std::string_view name) {
+    std::unique_lock lock(impl_->groupMutex);
+    const SessionGroupId id(impl_->nextGroupId);
+    if (!name.empty() && !impl_->groupNames.emplace(std::string(name), id).second) {
+        return GameResult<SessionGroupId>::err(GameError(
+            ErrorCode::AlreadyExists, "session group '" + std::string(name) + "' already exists"));
+    }
+    ++impl_->nextGroupId;
+    impl_->groups[id].name = std::string(name);
+    return GameResult<SessionGroupId>::ok(id);
+}
+
+std::optional<SessionGroupId> GameNetworkManager::findGroup(std::string_view name) const {
+    std::shared_lock lock(impl_->groupMutex);
+    auto it = impl_->groupNames.find(std::string(name));
+    if (it == impl_->groupNames.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+GameResult<void> GameNetworkManager::destroyGroup(SessionGroupId group) {
+    std::unique_lock lock(impl_->groupMutex);
+    auto it = impl_->groups.find(group);
+    if (it == impl_->groups.end()) {
+        return GameResult<void>::err(GameError(
+            ErrorCode::NotFound, "session group " + std::to_string(group.value()) + " not found"));
+    }
+    for (const auto& [sid, entry] : it->second.members) {
+        auto membership = impl_->memberships.find(sid);
+        std::erase(membership->second, group);
+        if (membership->second.empty()) {
+            impl_->memberships.erase(membership);
+        }
+    }
+    if (!it->second.name.empty()) {
+        impl_->groupNames.erase(it->second.name);
+    }
+    impl_->groups.erase(it);
+    return GameResult<void>::ok();
+}
+
+GameResult<void> GameNetworkManager::addToGroup(SessionGroupId group, SessionId session) {
+    std::unique_lock lock(impl_->groupMutex);
+    auto it = impl_->groups.find(group);
+    if (it == impl_->groups.end()) {
+        return GameResult<void>::err(GameError(
+            ErrorCode::NotFound, "session group " + std::to_string(group.value()) + " not found"));
+    }
+    if (it->second.members.contains(session)) {
+        return GameResult<void>::ok();
+    }
+
+    std::shared_ptr<const Impl::SessionEntry> entry;
     {
-        std::shared_lock lock(impl_->sessionMutex);
-        auto it = impl_->sessions.find(session);
-        if (it == impl_->sessions.end()) {
-            return GameResult<void>::err(
-                GameError(ErrorCode::SessionNotFound,
-                          "session " + std::to_string(session.value()) + " not found"));
+        std::lock_guard indexLock(impl_->indexMutex);
+        auto found = impl_->indexEntries.find(session);
+        if (found != impl_->indexEntries.end()) {
+            entry = found->second;
         }
-        kcSession = it->second.kcSession;
     }
+    if (!entry) {
+        return GameResult<void>::err(
+            GameError(ErrorCode::SessionNotFound,
+                      "session " + std::to_string(session.value()) + " not found"));
+    }
+    it->second.members.emplace(session, std::move(entry));
+    it->second.sendList.reset();
+    impl_->memberships[session].push_back(group);
+    return GameResult<void>::ok();
+}
 
-    auto wireData = msg.serialize();
-    auto result = kcSession->send(std::move(wireData));
-    if (result.is_err()) {
+GameResult<void> GameNetworkManager::removeFromGroup(SessionGroupId group, SessionId session) {
+    std::unique_lock lock(impl_->groupMutex);
+    auto it = impl_->groups.find(group);
+    if (it == impl_->groups.end()) {
+        return GameResult<void>::err(GameError(
+            ErrorCode::NotFound, "session group " + std::to_string(group.value()) + " not found"));
+    }
+    if (it->second.members.erase(session) == 0) {
+        return GameResult<void>::ok();
+    }
+    it->second.sendList.reset();
+    auto membership = impl_->memberships.find(session);
+    std::erase(membership->second, group);
+    if (membership->second.empty()) {
+        impl_->memberships.erase(membership);
+    }
+    return GameResult<void>::ok();
+}
+
+std::optional<std::size_t> GameNetworkManager::groupSize(SessionGroupId group) const {
+    std::shared_lock lock(impl_->groupMutex);
+    auto it = impl_->groups.find(group);
+    if (it == impl_->groups.end()) {
+        return std::nullopt;
+    }
+    return it->second.members.size();
+}
+
+GameResult<void> GameNetworkManager::sendToGroup(SessionGroupId group,
+                                                 const NetworkMessage& msg,
+                                                 SendLane lane,
+                                                 uint64_t stateKey) {
+    return sendToGroup(group, msg.frame(impl_->wirePool), lane, stateKey);
+}
+
+GameResult<void> GameNetworkManager::sendToGroup(SessionGroupId group,
+                                                 const WireBuffer& frame,
+                                                 SendLane lane,
+                                                 uint64_t stateKey) {
+    const auto sendList = impl_->groupSendList(group);
+    if (!sendList) {
         return GameResult<void>::err(GameError(
-            ErrorCode::SendFailed, "send failed for session " + std::to_string(session.value())));
+            ErrorCode::NotFound, "session group " + std::to_string(group.value()) + " not found"));
+    }
+    const auto& shares = sendList->shares;
+    if (shares.empty()) {
+        return GameResult<void>::ok();
+    }
+
+    // Compressed once up front: the shares may be sent on several threads
+    WireBuffer packed;
+    if (impl_->compressor) {
+        packed = impl_->compressFrame(frame);
+    }
+    std::latch done(static_cast<std::ptrdiff_t>(shares.size()));
+    std::vector<Impl::Fanout> fanouts(shares.size());
+    for (std::size_t i = 0; i < shares.size(); ++i) {
+        fanouts[i] = Impl::Fanout{&shares[i],
+                                  &frame,
+                                  impl_->compressor ? &packed : nullptr,
+                                  lane,
+                                  stateKey,
+                                  impl_->coalesce.load(std::memory_order_relaxed),
+                                  &done};
+    }
+
+    // A lone share is cheaper to send here than to hand off
+    auto& reactors = impl_->reactors;
+    const bool handOff = shares.size() > 1;
+    for (auto& fanout : fanouts) {
+        if (handOff && fanout.share->reactor < reactors.size()) {
+            Impl::Reactor& reactor = *reactors[fanout.share->reactor];
+            {
+                std::lock_guard lock(reactor.mutex);
+                reactor.egress.push_back(&fanout);
+            }
+            reactor.wake.notify_one();
+        }
     }
 
+    // Send the shares no reactor has taken yet, last first: a reactor
+    // may be stuck handing input to the thread that called us.
+    for (auto it = fanouts.rbegin(); it != fanouts.rend(); ++it) {
+        bool mine = true;
+        if (handOff && it->share->reactor < reactors.size()) {
+            Impl::Reactor& reactor = *reactors[it->share->reactor];
+            std::lock_guard lock(reactor.mutex);
+            mine = std::erase(reactor.egress, &*it) != 0;
+        }
+        if (mine) {
+            Impl::sendShare(*it);
+        }
+    }
+    done.wait();
     return GameResult<void>::ok();
 }
 
 // ---------------------------------------------------------------------------
-// broadcast()
+// Outbound coalescing
 // ---------------------------------------------------------------------------
 
-GameResult<void> GameNetworkManager::broadcast(const NetworkMessage& msg) {
-    auto wireData = msg.serialize();
+void GameNetworkManager::setCoalescing(bool enabled, std::size_t flushThreshold) {
+    impl_->flushThreshold.store(flushThreshold, std::memory_order_relaxed);
+    impl_->coalesce.store(enabled, std::memory_order_relaxed);
 
-    std::shared_lock lock(impl_->sessionMutex);
-    for (auto& [sid, internal] : impl_->sessions) {
-        if (internal.kcSession && internal.kcSession->is_connected()) {
-            // Copy for each send (kcenon takes by rvalue)
-            auto copy = wireData;
-            (void)internal.kcSession->send(std::move(copy));
+    Impl::ReadGuard guard(impl_->activeReaders);
+    const Impl::SessionIndex* index = impl_->sessionIndex.load();
+    if (index == nullptr) {
+        return;
+    }
+    for (const auto& entry : index->entries) {
+        std::lock_guard queueLock(entry->state->outboundMutex);
+        entry->state->outbound.setFlushThreshold(flushThreshold);
+        if (!enabled && entry->kcSession) {
+            Impl::drain(entry->sid, *entry->kcSession, *entry->state);
         }
     }
+}
+
+bool GameNetworkManager::coalescingEnabled() const noexcept {
+    return impl_->coalesce.load(std::memory_order_relaxed);
+}
+
+void GameNetworkManager::setLaneBudgets(const LaneBudgets& budgets) {
+    {
+        std::lock_guard budgetLock(impl_->budgetMutex);
+        impl_->laneBudgets = budgets;
+    }
+
+    Impl::ReadGuard guard(impl_->activeReaders);
+    const Impl::SessionIndex* index = impl_->sessionIndex.load();
+    if (index == nullptr) {
+        return;
+    }
+    for (const auto& entry : index->entries) {
+        std::lock_guard queueLock(entry->state->outboundMutex);
+        entry->state->outbound.setBudgets(budgets);
+    }
+}
+
+LaneBudgets GameNetworkManager::laneBudgets() const {
+    std::lock_guard budgetLock(impl_->budgetMutex);
+    return impl_->laneBudgets;
+}
+
+void GameNetworkManager::flush() {
+    Impl::ReadGuard guard(impl_->activeReaders);
+    const Impl::SessionIndex* index = impl_->sessionIndex.load();
+    if (index == nullptr) {
+        return;
+    }
+    for (const auto& entry : index->entries) {
+        if (entry->kcSession) {
+            std::lock_guard queueLock(entry->state->outboundMutex);
+            (void)Impl::sendBatch(entry->sid, *entry->kcSession, *entry->state);
+        }
+    }
+    updateReliability();
+}
+
+GameResult<void> GameNetworkManager::flush(SessionId session) {
+    std::shared_ptr<kcenon::network::interfaces::i_session> kcSession;
+    std::shared_ptr<Impl::SessionState> state;
+    if (!impl_->lookup(session, kcSession, state)) {
+        return GameResult<void>::err(
+            GameError(ErrorCode::SessionNotFound,
+                      "session " + std::to_string(session.value()) + " not found"));
+    }
+
+    if (state->reliable) {
+        std::lock_guard lock(state->reliableMutex);
+        return Impl::pumpLocked(session, *kcSession, *state, std::chrono::steady_clock::now());
+    }
+    std::lock_guard queueLock(state->outboundMutex);
+    return Impl::sendBatch(session, *kcSession, *state);
+}
+
+std::optional<OutboundStats> GameNetworkManager::outboundStats(SessionId session) const {
+    auto& shard = impl_->shardFor(session);
+    std::shared_lock lock(shard.mutex);
+    auto it = shard.sessions.find(session);
+    if (it == shard.sessions.end()) {
+        return std::nullopt;
+    }
+    std::lock_guard queueLock(it->second.state->outboundMutex);
+    return it->second.state->outbound.stats();
+}
+
+// ---------------------------------------------------------------------------
+// Reactors
+// ---------------------------------------------------------------------------
+
+GameResult<void> GameNetworkManager::setReactors(std::size_t count,
+                                                 std::size_t queueCapacity,
+                                                 CpuSet affinity) {
+    if (!impl_->servers.empty()) {
+        return GameResult<void>::err(
+            GameError(ErrorCode::InvalidArgument, "reactors must be set before listen()"));
+    }
+    impl_->stopReactors();
+    impl_->startReactors(count, queueCapacity, affinity);
+    return GameResult<void>::ok();
+}
+
+std::size_t GameNetworkManager::reactorCount() const noexcept {
+    return impl_->reactors.size();
+}
+
+std::size_t GameNetworkManager::dispatchInbound(std::size_t maxMessages) {
+    std::size_t dispatched = 0;
+    Impl::ReadGuard guard(impl_->activeReaders);
+    Impl::Inbound inbound;
+    for (auto& reactor : impl_->reactors) {
+        while (dispatched < maxMessages && reactor->outbox.tryPop(inbound)) {
+            if (inbound.error != ErrorCode::Success) {
+                onError.emit(inbound.sid, inbound.error);
+                continue;
+            }
+            impl_->dispatch(inbound.sid, inbound.msg);
+            ++dispatched;
+        }
+    }
+    return dispatched;
+}
+
+std::vector<ReactorStats> GameNetworkManager::reactorStats() const {
+    std::vector<ReactorStats> stats;
+    stats.reserve(impl_->reactors.size());
+    for (const auto& reactor : impl_->reactors) {
+        ReactorStats entry;
+        entry.received = reactor->received.load(std::memory_order_relaxed);
+        entry.decoded = reactor->decoded.load(std::memory_order_relaxed);
+        entry.stalls = reactor->stalls.load(std::memory_order_relaxed);
+        entry.fanouts = reactor->fanouts.load(std::memory_order_relaxed);
+        entry.pending = reactor->outbox.size();
+        stats.push_back(entry);
+    }
+    return stats;
+}
+
+// ---------------------------------------------------------------------------
+// Payload compression
+// ---------------------------------------------------------------------------
+
+GameResult<void> GameNetworkManager::setCompression(bool enabled,
+                                                    CompressionConfig config,
+                                                    CompressionDictionary dictionary) {
+    if (!impl_->servers.empty()) {
+        return GameResult<void>::err(
+            GameError(ErrorCode::InvalidArgument, "compression must be set before listen()"));
+    }
+    impl_->compressor.reset();
+    if (enabled) {
+        impl_->compressor = std::make_unique<PayloadCompressor>(config, std::move(dictionary));
+    }
+    std::lock_guard lock(impl_->publishedMutex);
+    impl_->published = CompressionStats{};
     return GameResult<void>::ok();
 }
 
+bool GameNetworkManager::compressionEnabled() const noexcept {
+    return impl_->compressor != nullptr;
+}
+
+GameResult<void> GameNetworkManager::setSessionCompression(SessionId session, bool enabled) {
+    if (!impl_->compressor) {
+        return GameResult<void>::err(
+            GameError(ErrorCode::InvalidArgument, "compression is not enabled"));
+    }
+    std::shared_ptr<kcenon::network::interfaces::i_session> kcSession;
+    std::shared_ptr<Impl::SessionState> state;
+    if (!impl_->lookup(session, kcSession, state)) {
+        return GameResult<void>::err(
+            GameError(ErrorCode::SessionNotFound,
+                      "session " + std::to_string(session.value()) + " not found"));
+    }
+    state->compress.store(enabled, std::memory_order_relaxed);
+    return GameResult<void>::ok();
+}
+
+std::optional<CompressionStats> GameNetworkManager::compressionStats() const {
+    if (!impl_->compressor) {
+        return std::nullopt;
+    }
+    return impl_->compressor->stats();
+}
+
+void GameNetworkManager::publishCompressionMetrics(GameMetrics& metrics) {
+    if (!impl_->compressor) {
+        return;
+    }
+    const auto stats = impl_->compressor->stats();
+    std::lock_guard lock(impl_->publishedMutex);
+    const auto& last = impl_->published;
+    metrics.incrementCounter("cgs_net_compress_attempts_total", stats.attempted - last.attempted);
+    metrics.incrementCounter("cgs_net_compressed_total", stats.compressed - last.compressed);
+    metrics.incrementCounter("cgs_net_compress_bytes_in_total", stats.bytesIn - last.bytesIn);
+    metrics.incrementCounter("cgs_net_compress_bytes_out_total", stats.bytesOut - last.bytesOut);
+    metrics.incrementCounter("cgs_net_decompressed_total", stats.decompressed - last.decompressed);
+    metrics.incrementCounter("cgs_net_decompress_rejected_total", stats.rejected - last.rejected);
+    const auto us = [](std::chrono::nanoseconds ns) {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(ns).count());
+    };
+    metrics.incrementCounter("cgs_net_compress_cpu_us_total",
+                             us(stats.compressTime) - us(last.compressTime));
+    metrics.incrementCounter("cgs_net_decompress_cpu_us_total",
+                             us(stats.decompressTime) - us(last.decompressTime));
+    metrics.setGauge("cgs_net_compression_ratio", stats.ratio());
+    impl_->published = stats;
+}
+
+// ---------------------------------------------------------------------------
+// UDP reliability
+// ---------------------------------------------------------------------------
+
+void GameNetworkManager::setUdpReliability(bool enabled) {
+    impl_->udpReliability.store(enabled, std::memory_order_relaxed);
+}
+
+bool GameNetworkManager::udpReliabilityEnabled() const noexcept {
+    return impl_->udpReliability.load(std::memory_order_relaxed);
+}
+
+void GameNetworkManager::updateReliability(std::chrono::steady_clock::time_point now) {
+    Impl::ReadGuard guard(impl_->activeReaders);
+    const Impl::SessionIndex* index = impl_->sessionIndex.load();
+    if (index == nullptr) {
+        return;
+    }
+    for (const auto& entry : index->entries) {
+        if (entry->kcSession && entry->state->reliable) {
+            std::lock_guard lock(entry->state->reliableMutex);
+            (void)Impl::pumpLocked(entry->sid, *entry->kcSession, *entry->state, now);
+        }
+    }
+}
+
+std::optional<ReliabilityStats> GameNetworkManager::reliabilityStats(SessionId session) const {
+    auto& shard = impl_->shardFor(session);
+    std::shared_lock lock(shard.mutex);
+    auto it = shard.sessions.find(session);
+    if (it == shard.sessions.end() || !it->second.state->reliable) {
+        return std::nullopt;
+    }
+    std::lock_guard reliableLock(it->second.state->reliableMutex);
+    return it->second.state->reliable->stats();
+}
+
 // ---------------------------------------------------------------------------
 // close()
 // ---------------------------------------------------------------------------
 
 void GameNetworkManager::close(SessionId session) {
     std::shared_ptr<kcenon::network::interfaces::i_session> kcSession;
-    {
-        std::shared_lock lock(impl_->sessionMutex);
-        auto it = impl_->sessions.find(session);
-        if (it == impl_->sessions.end()) {
-            return;
-        }
-        kcSession = it->second.kcSession;
+    std::shared_ptr<Impl::SessionState> state;
+    if (!impl_->lookup(session, kcSession, state)) {
+        return;
     }
 
     if (kcSession) {
+        {
+            std::lock_guard queueLock(state->outboundMutex);
+            Impl::drain(session, *kcSession, *state);
+        }
+        if (state->reliable) {
+            // Datagrams still unacked are abandoned with the session
+            std::lock_guard lock(state->reliableMutex);
+            (void)Impl::pumpLocked(session, *kcSession, *state, std::chrono::steady_clock::now());
+        }
         kcSession->close();
     }
     // Session removal happens in the disconnection callback
@@ -488,13 +1706,14 @@ void GameNetworkManager::close(SessionId session) {
 // ---------------------------------------------------------------------------
 
 void GameNetworkManager::registerHandler(uint16_t opcode, MessageHandler handler) {
-    std::unique_lock lock(impl_->handlerMutex);
-    impl_->handlers[opcode] = std::move(handler);
+    char tagName[24];
+    std::snprintf(tagName, sizeof(tagName), "handler.0x%04x", static_cast<unsigned>(opcode));
+    impl_->handlerTags[opcode].store(AllocTracker::Register(tagName), std::memory_order_relaxed);
+    impl_->publishHandler(opcode, new MessageHandler(std::move(handler)));
 }
 
 void GameNetworkManager::unregisterHandler(uint16_t opcode) {
-    std::unique_lock lock(impl_->handlerMutex);
-    impl_->handlers.erase(opcode);
+    impl_->publishHandler(opcode, nullptr);
 }
 
 // ---------------------------------------------------------------------------
@@ -502,12 +1721,20 @@ void GameNetworkManager::unregisterHandler(uint16_t opcode) {
 // ---------------------------------------------------------------------------
 
 std::optional<SessionInfo> GameNetworkManager::sessionInfo(SessionId id) const {
-    std::shared_lock lock(impl_->sessionMutex);
-    auto it = impl_->sessions.find(id);
-    if (it == impl_->sessions.end()) {
+    auto& shard = impl_->shardFor(id);
+    std::shared_lock lock(shard.mutex);
+    auto it = shard.sessions.find(id);
+    if (it == shard.sessions.end()) {
         return std::nullopt;
     }
-    return it->second.info;
+    SessionInfo info = it->second.info;
+    info.lastActivity = std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(
+        it->second.state->lastActivity.load(std::memory_order_relaxed)));
+    std::lock_guard queueLock(it->second.state->outboundMutex);
+    const auto stats = it->second.state->outbound.stats();
+    info.outboundQueueDepth = stats.queueDepth;
+    info.outboundBytes = stats.bytesInFlight;
+    return info;
 }
 
 // ---------------------------------------------------------------------------
@@ -515,8 +1742,7 @@ std::optional<SessionInfo> GameNetworkManager::sessionInfo(SessionId id) const {
 // ---------------------------------------------------------------------------
 
 std::size_t GameNetworkManager::sessionCount() const {
-    std::shared_lock lock(impl_->sessionMutex);
-    return impl_->sessions.size();
+    return impl_->sessionTotal.load(std::memory_order_relaxed);
 }
 
 }  // namespace cgs::foundation
@@ -0,0 +1,129 @@
+/// @file outbound_queue.cpp
+/// @brief OutboundQueue lane budgets, state coalescing and batch assembly.
+
+#include "cgs/foundation/outbound_queue.hpp"
+
+namespace cgs::foundation {
+
+EnqueueResult OutboundQueue::push(WireBuffer frame, SendLane laneId, uint64_t stateKey) {
+    Lane& queue = lane(laneId);
+    const std::size_t size = frame.size();
+
+    if (laneId == SendLane::State) {
+        if (stateKey != 0) {
+            auto it = stateSlots_.find(stateKey);
+            if (it != stateSlots_.end()) {
+                Pending& stale = queue.frames[it->second];
+                queue.bytes = queue.bytes - stale.frame.size() + size;
+                stale.frame = std::move(frame);
+                ++stats_.stateReplaced;
+                dropStaleState(0);
+                return EnqueueResult::Queued;
+            }
+        }
+        dropStaleState(size);
+    } else if (queue.bytes + size > budgets_.of(laneId)) {
+        ++stats_.rejected;
+        return EnqueueResult::Rejected;
+    }
+
+    if (laneId == SendLane::State && stateKey != 0) {
+        stateSlots_.emplace(stateKey, queue.frames.size());
+    }
+    queue.frames.push_back({std::move(frame), stateKey});
+    queue.bytes += size;
+    ++depth_;
+
+    std::size_t total = 0;
+    for (const auto& l : lanes_) {
+        total += l.bytes;
+    }
+    return total >= flushThreshold_ ? EnqueueResult::FlushNow : EnqueueResult::Queued;
+}
+
+void OutboundQueue::dropStaleState(std::size_t incoming) {
+    Lane& queue = lane(SendLane::State);
+    while (queue.bytes + incoming > budgets_.state && queue.head < queue.frames.size()) {
+        Pending& oldest = queue.frames[queue.head++];
+        if (oldest.frame.empty()) {
+            continue;
+        }
+        if (oldest.stateKey != 0) {
+            stateSlots_.erase(oldest.stateKey);
+        }
+        queue.bytes -= oldest.frame.size();
+        oldest.frame = WireBuffer();
+        --depth_;
+        ++stats_.stateDropped;
+    }
+}
+
+std::vector<uint8_t> OutboundQueue::take() {
+    std::vector<uint8_t> out;
+    if (depth_ == 0) {
+        return out;
+    }
+    const std::size_t limit = budgets_.bytesPerFlush;
+    std::size_t messages = 0;
+    bool full = false;
+    for (std::size_t l = 0; l < kSendLaneCount && !full; ++l) {
+        Lane& queue = lanes_[l];
+        while (queue.head < queue.frames.size()) {
+            Pending& next = queue.frames[queue.head];
+            const auto bytes = next.frame.bytes();
+            if (limit != 0 && !out.empty() && out.size() + bytes.size() > limit) {
+                full = true;
+                break;
+            }
+            if (next.stateKey != 0 && !next.frame.empty()) {
+                stateSlots_.erase(next.stateKey);
+            }
+            if (!next.frame.empty()) {
+                out.insert(out.end(), bytes.begin(), bytes.end());
+                queue.bytes -= bytes.size();
+                ++messages;
+            }
+            next.frame = WireBuffer();
+            ++queue.head;
+        }
+    }
+
+    // Drop consumed entries of partly taken lanes and re-base the
+    // surviving State slots.
+    for (std::size_t l = 0; l < kSendLaneCount; ++l) {
+        Lane& queue = lanes_[l];
+        if (queue.head == 0) {
+            continue;
+        }
+        queue.frames.erase(queue.frames.begin(),
+                           queue.frames.begin() + static_cast<std::ptrdiff_t>(queue.head));
+        queue.head = 0;
+        if (static_cast<SendLane>(l) == SendLane::State) {
+            stateSlots_.clear();
+            for (std::size_t i = 0; i < queue.frames.size(); ++i) {
+                if (queue.frames[i].stateKey != 0) {
+                    stateSlots_.emplace(queue.frames[i].stateKey, i);
+                }
+            }
+        }
+    }
+
+    depth_ -= messages;
+    if (messages > 0) {
+        ++stats_.batchesSent;
+        stats_.messagesSent += messages;
+    }
+    return out;
+}
+
+OutboundStats OutboundQueue::stats() const noexcept {
+    OutboundStats stats = stats_;
+    stats.queueDepth = depth_;
+    for (std::size_t l = 0; l < kSendLaneCount; ++l) {
+        stats.laneBytes[l] = lanes_[l].bytes;
+        stats.bytesInFlight += lanes_[l].bytes;
+    }
+    return stats;
+}
+
+}  // namespace cgs::foundation
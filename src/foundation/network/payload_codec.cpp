@@ -0,0 +1,426 @@
+/// @file payload_codec.cpp
+/// @brief LZ4 block codec, dictionary training and PayloadCompressor policy.
+
+#include "cgs/foundation/payload_codec.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <queue>
+#include <unordered_map>
+
+namespace cgs::foundation {
+
+namespace {
+
+// LZ4 block format limits
+constexpr std::size_t kMinMatch = 4;
+constexpr std::size_t kLastLiterals = 5;  // the block always ends in literals
+constexpr std::size_t kMfLimit = 12;      // no match starts in the last 12 bytes
+constexpr std::size_t kMaxOffset = 65535;
+constexpr std::size_t kHashSlots = std::size_t{1} << CompressionDictionary::kHashLog;
+
+// Dictionary training: score kSegment-byte windows by their kGram-byte
+// sequences, every kStride bytes.
+constexpr std::size_t kGram = 8;
+constexpr std::size_t kSegment = 32;
+constexpr std::size_t kStride = 8;
+
+uint32_t read32(const uint8_t* p) noexcept {
+    uint32_t v = 0;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+uint64_t read64(const uint8_t* p) noexcept {
+    uint64_t v = 0;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+std::size_t hash4(uint32_t v) noexcept {
+    return static_cast<std::size_t>((v * 2654435761u) >> (32 - CompressionDictionary::kHashLog));
+}
+
+// Network byte order (big-endian), as in the frame header
+void put32(std::vector<uint8_t>& out, uint32_t v) {
+    out.push_back(static_cast<uint8_t>((v >> 24) & 0xFF));
+    out.push_back(static_cast<uint8_t>((v >> 16) & 0xFF));
+    out.push_back(static_cast<uint8_t>((v >> 8) & 0xFF));
+    out.push_back(static_cast<uint8_t>(v & 0xFF));
+}
+
+uint32_t get32(const uint8_t* p) noexcept {
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+// Extension bytes of a length >= 15 (token nibble already 15)
+void putLength(std::vector<uint8_t>& out, std::size_t length) {
+    while (length >= 255) {
+        out.push_back(255);
+        length -= 255;
+    }
+    out.push_back(static_cast<uint8_t>(length));
+}
+
+bool getLength(std::span<const uint8_t> in, std::size_t& pos, std::size_t& length) {
+    for (;;) {
+        if (pos >= in.size()) {
+            return false;
+        }
+        const uint8_t byte = in[pos++];
+        length += byte;
+        if (byte != 255) {
+            return true;
+        }
+    }
+}
+
+// One sequence: literals, then (unless @p matchLength is 0) a match
+void putSequence(std::vector<uint8_t>& out,
+                 const uint8_t* literals,
+                 std::size_t literalLength,
+                 std::size_t offset,
+                 std::size_t matchLength) {
+    const std::size_t matchCode = matchLength == 0 ? 0 : matchLength - kMinMatch;
+    const auto token = static_cast<uint8_t>((std::min<std::size_t>(literalLength, 15) << 4) |
+                                            std::min<std::size_t>(matchCode, 15));
+    out.push_back(token);
+    if (literalLength >= 15) {
+        putLength(out, literalLength - 15);
+    }
+    out.insert(out.end(), literals, literals + literalLength);
+    if (matchLength == 0) {
+        return;
+    }
+    out.push_back(static_cast<uint8_t>(offset & 0xFF));
+    out.push_back(static_cast<uint8_t>(offset >> 8));
+    if (matchCode >= 15) {
+        putLength(out, matchCode - 15);
+    }
+}
+
+uint32_t fnv1a(std::span<const uint8_t> bytes) noexcept {
+    uint32_t h = 2166136261u;
+    for (uint8_t b : bytes) {
+        h = (h ^ b) * 16777619u;
+    }
+    return h;
+}
+
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// CompressionDictionary
+// ---------------------------------------------------------------------------
+
+CompressionDictionary::CompressionDictionary(std::vector<uint8_t> bytes)
+    : bytes_(std::move(bytes)) {
+    if (bytes_.size() > kMaxSize) {
+        bytes_.erase(bytes_.begin(),
+                     bytes_.begin() + static_cast<std::ptrdiff_t>(bytes_.size() - kMaxSize));
+    }
+    id_ = fnv1a(bytes_);
+    if (bytes_.empty()) {
+        return;
+    }
+    table_.assign(kHashSlots, 0);
+    for (std::size_t pos = 0; pos + sizeof(uint32_t) <= bytes_.size(); ++pos) {
+        table_[hash4(read32(bytes_.data() + pos))] = static_cast<uint32_t>(pos + 1);
+    }
+}
+
+CompressionDictionary CompressionDictionary::train(std::span<const std::vector<uint8_t>> samples,
+                                                   std::size_t maxSize) {
+    maxSize = std::min(maxSize, kMaxSize);
+
+    // Samples containing each 8-byte sequence (counted once per sample)
+    struct GramCount {
+        uint32_t samples = 0;
+        std::size_t last = SIZE_MAX;
+    };
+    std::unordered_map<uint64_t, GramCount> grams;
+    for (std::size_t s = 0; s < samples.size(); ++s) {
+        const auto& sample = samples[s];
+        for (std::size_t pos = 0; pos + kGram <= sample.size(); ++pos) {
+            auto& count = grams[read64(sample.data() + pos)];
+            if (count.last != s) {
+                count.last = s;
+                ++count.samples;
+            }
+        }
+    }
+
+    // Value of a window: sequences it shares with other samples that no
+    // chosen segment covers yet
+    auto score = [&](const uint8_t* window) {
+        uint64_t total = 0;
+        for (std::size_t i = 0; i + kGram <= kSegment; ++i) {
+            const auto it = grams.find(read64(window + i));
+            if (it != grams.end() && it->second.samples > 1) {
+                total += it->second.samples;
+            }
+        }
+        return total;
+    };
+
+    // Lazy greedy selection: a candidate's score only drops as segments
+    // are chosen, so one popped with a current score still on top wins.
+    struct Candidate {
+        uint64_t score;
+        const uint8_t* window;
+        bool operator<(const Candidate& other) const noexcept { return score < other.score; }
+    };
+    std::priority_queue<Candidate> candidates;
+    for (const auto& sample : samples) {
+        for (std::size_t pos = 0; pos + kSegment <= sample.size(); pos += kStride) {
+            const uint64_t value = score(sample.data() + pos);
+            if (value > 0) {
+                candidates.push({value, sample.data() + pos});
+            }
+        }
+    }
+
+    std::vector<const uint8_t*> chosen;
+    while (!candidates.empty() && (chosen.size() + 1) * kSegment <= maxSize) {
+        Candidate top = candidates.top();
+        candidates.pop();
+        top.score = score(top.window);
+        if (top.score == 0) {
+            continue;
+        }
+        if (!candidates.empty() && top.score < candidates.top().score) {
+            candidates.push(top);
+            continue;
+        }
+        chosen.push_back(top.window);
+        for (std::size_t i = 0; i + kGram <= kSegment; ++i) {
+            grams[read64(top.window + i)].samples = 0;
+        }
+    }
+
+    // Best segments last: closest to the data, so they get the shortest
+    // offsets.
+    std::vector<uint8_t> bytes;
+    bytes.reserve(chosen.size() * kSegment);
+    for (auto it = chosen.rbegin(); it != chosen.rend(); ++it) {
+        bytes.insert(bytes.end(), *it, *it + kSegment);
+    }
+    return CompressionDictionary(std::move(bytes));
+}
+
+// ---------------------------------------------------------------------------
+// LZ4 block codec
+// ---------------------------------------------------------------------------
+
+void compressLz4Block(std::span<const uint8_t> input,
+                      std::vector<uint8_t>& out,
+                      const CompressionDictionary* dictionary) {
+    // Matches index one buffer: the dictionary followed by the input.
+    thread_local std::vector<uint8_t> history;
+    thread_local std::vector<uint32_t> table;
+    const uint8_t* base = input.data();
+    std::size_t start = 0;
+    if (dictionary != nullptr && !dictionary->empty()) {
+        const auto dict = dictionary->bytes();
+        history.assign(dict.begin(), dict.end());
+        history.insert(history.end(), input.begin(), input.end());
+        base = history.data();
+        start = dict.size();
+        table.assign(dictionary->table().begin(), dictionary->table().end());
+    } else {
+        table.assign(kHashSlots, 0);
+    }
+    const std::size_t end = start + input.size();
+    out.reserve(out.size() + lz4CompressBound(input.size()));
+
+    std::size_t anchor = start;
+    if (input.size() > kMfLimit) {
+        const std::size_t matchStartLimit = end - kMfLimit;
+        const std::size_t matchEndLimit = end - kLastLiterals;
+        std::size_t ip = start;
+        while (ip <= matchStartLimit) {
+            const uint32_t sequence = read32(base + ip);
+            uint32_t& slot = table[hash4(sequence)];
+            const std::size_t candidate = slot;
+            slot = static_cast<uint32_t>(ip + 1);
+            if (candidate == 0 || ip - (candidate - 1) > kMaxOffset ||
+                read32(base + candidate - 1) != sequence) {
+                // Skip faster through data that keeps missing.
+                ip += 1 + ((ip - anchor) >> 6);
+                continue;
+            }
+
+            std::size_t ref = candidate - 1;
+            while (ip > anchor && ref > 0 && base[ip - 1] == base[ref - 1]) {
+                --ip;
+                --ref;
+            }
+            std::size_t length = kMinMatch;
+            while (ip + length < matchEndLimit && base[ref + length] == base[ip + length]) {
+                ++length;
+            }
+            putSequence(out, base + anchor, ip - anchor, ip - ref, length);
+            ip += length;
+            anchor = ip;
+            if (ip <= matchStartLimit) {
+                // Index inside the match so the next one can chain from it.
+                table[hash4(read32(base + ip - 2))] = static_cast<uint32_t>(ip - 1);
+            }
+        }
+    }
+    putSequence(out, base + anchor, end - anchor, 0, 0);
+}
+
+bool decompressLz4Block(std::span<const uint8_t> input,
+                        std::size_t originalSize,
+                        std::vector<uint8_t>& out,
+                        std::span<const uint8_t> dictionary) {
+    out.clear();
+    out.resize(originalSize);
+    uint8_t* const dst = out.data();
+    std::size_t ip = 0;
+    std::size_t op = 0;
+    for (;;) {
+        if (ip >= input.size()) {
+            return false;
+        }
+        const uint8_t token = input[ip++];
+
+        std::size_t literals = token >> 4;
+        if (literals == 15 && !getLength(input, ip, literals)) {
+            return false;
+        }
+        if (literals > input.size() - ip || literals > originalSize - op) {
+            return false;
+        }
+        if (literals > 0) {
+            std::memcpy(dst + op, input.data() + ip, literals);
+        }
+        ip += literals;
+        op += literals;
+        if (ip == input.size()) {
+            break;  // the last sequence has no match
+        }
+
+        if (input.size() - ip < 2) {
+            return false;
+        }
+        const std::size_t offset =
+            static_cast<std::size_t>(input[ip]) | (static_cast<std::size_t>(input[ip + 1]) << 8);
+        ip += 2;
+        std::size_t length = token & 0x0F;
+        if (length == 15 && !getLength(input, ip, length)) {
+            return false;
+        }
+        length += kMinMatch;
+        if (offset == 0 || offset > op + dictionary.size() || length > originalSize - op) {
+            return false;
+        }
+
+        if (offset > op) {
+            // The match starts in the dictionary.
+            const std::size_t back = offset - op;
+            const std::size_t fromDict = std::min(back, length);
+            std::memcpy(dst + op, dictionary.data() + dictionary.size() - back, fromDict);
+            op += fromDict;
+            length -= fromDict;
+            if (length == 0) {
+                continue;
+            }
+        }
+        const uint8_t* src = dst + op - offset;
+        if (offset >= length) {
+            std::memcpy(dst + op, src, length);
+            op += length;
+        } else {
+            // Overlapping copy repeats the last offset bytes.
+            for (std::size_t i = 0; i < length; ++i) {
+                dst[op++] = src[i];
+            }
+        }
+    }
+    return op == originalSize;
+}
+
+// ---------------------------------------------------------------------------
+// PayloadCompressor
+// ---------------------------------------------------------------------------
+
+PayloadCompressor::PayloadCompressor(CompressionConfig config, CompressionDictionary dictionary)
+    : config_(config),
+      dictionary_(std::move(dictionary)),
+      backoff_(std::make_unique<std::atomic<uint32_t>[]>(kOpcodeCount)) {}
+
+bool PayloadCompressor::compress(uint16_t opcode,
+                                 std::span<const uint8_t> payload,
+                                 std::vector<uint8_t>& out) {
+    if (payload.size() < config_.minPayloadSize || payload.size() > kMaxDecompressedSize) {
+        skipped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    // Racing senders may both try or both skip; either is harmless.
+    auto& backoff = backoff_[opcode];
+    const uint32_t left = backoff.load(std::memory_order_relaxed);
+    if (left > 0) {
+        backoff.store(left - 1, std::memory_order_relaxed);
+        skipped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    const auto started = std::chrono::steady_clock::now();
+    const std::size_t mark = out.size();
+    put32(out, static_cast<uint32_t>(payload.size()));
+    compressLz4Block(payload, out, dictionary_.empty() ? nullptr : &dictionary_);
+    compressNs_.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now() - started)
+                              .count(),
+                          std::memory_order_relaxed);
+    attempted_.fetch_add(1, std::memory_order_relaxed);
+    bytesIn_.fetch_add(payload.size(), std::memory_order_relaxed);
+
+    const std::size_t produced = out.size() - mark;
+    if (static_cast<double>(produced) >
+        static_cast<double>(payload.size()) * config_.maxRatio) {
+        out.resize(mark);
+        backoff.store(config_.backoff, std::memory_order_relaxed);
+        bytesOut_.fetch_add(payload.size(), std::memory_order_relaxed);
+        return false;
+    }
+    compressed_.fetch_add(1, std::memory_order_relaxed);
+    bytesOut_.fetch_add(produced, std::memory_order_relaxed);
+    return true;
+}
+
+bool PayloadCompressor::decompress(std::span<const uint8_t> payload, std::vector<uint8_t>& out) {
+    const auto started = std::chrono::steady_clock::now();
+    bool valid = false;
+    if (payload.size() >= sizeof(uint32_t)) {
+        const uint32_t originalSize = get32(payload.data());
+        valid = originalSize <= kMaxDecompressedSize &&
+                decompressLz4Block(payload.subspan(sizeof(uint32_t)), originalSize, out,
+                                   dictionary_.bytes());
+    }
+    decompressNs_.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                std::chrono::steady_clock::now() - started)
+                                .count(),
+                            std::memory_order_relaxed);
+    (valid ? decompressed_ : rejected_).fetch_add(1, std::memory_order_relaxed);
+    return valid;
+}
+
+CompressionStats PayloadCompressor::stats() const noexcept {
+    CompressionStats stats;
+    stats.attempted = attempted_.load(std::memory_order_relaxed);
+    stats.compressed = compressed_.load(std::memory_order_relaxed);
+    stats.skipped = skipped_.load(std::memory_order_relaxed);
+    stats.bytesIn = bytesIn_.load(std::memory_order_relaxed);
+    stats.bytesOut = bytesOut_.load(std::memory_order_relaxed);
+    stats.decompressed = decompressed_.load(std::memory_order_relaxed);
+    stats.rejected = rejected_.load(std::memory_order_relaxed);
+    stats.compressTime = std::chrono::nanoseconds(compressNs_.load(std::memory_order_relaxed));
+    stats.decompressTime = std::chrono::nanoseconds(decompressNs_.load(std::memory_order_relaxed));
+    return stats;
+}
+
+}  // namespace cgs::foundation
@@ -0,0 +1,410 @@
+/// @file reliable_channel.cpp
+/// @brief ReliableEndpoint packet assembly, selective acks and reassembly.
+
+#include "cgs/foundation/reliable_channel.hpp"
+
+#include <algorithm>
+
+namespace cgs::foundation {
+
+namespace {
+
+constexpr uint8_t kFlagAckValid = 0x01;
+
+// Fragments per message at kMaxMessageSize
+constexpr std::size_t kMaxFragments =
+    (ReliableEndpoint::kMaxMessageSize + ReliableEndpoint::kFragmentSize - 1) /
+    ReliableEndpoint::kFragmentSize;
+
+// Network byte order (big-endian)
+void put16(std::vector<uint8_t>& out, uint16_t v) {
+    out.push_back(static_cast<uint8_t>((v >> 8) & 0xFF));
+    out.push_back(static_cast<uint8_t>(v & 0xFF));
+}
+
+void put32(std::vector<uint8_t>& out, uint32_t v) {
+    put16(out, static_cast<uint16_t>(v >> 16));
+    put16(out, static_cast<uint16_t>(v & 0xFFFF));
+}
+
+uint16_t get16(const uint8_t* p) {
+    return static_cast<uint16_t>((static_cast<uint16_t>(p[0]) << 8) | p[1]);
+}
+
+uint32_t get32(const uint8_t* p) {
+    return (static_cast<uint32_t>(get16(p)) << 16) | get16(p + 2);
+}
+
+// True if packet sequence @p a is newer than @p b, across wrap-around
+bool sequenceGreater(uint16_t a, uint16_t b) {
+    return a != b && static_cast<uint16_t>(a - b) < 0x8000;
+}
+
+// True if message id @p a precedes @p b, across wrap-around
+bool idBefore(uint32_t a, uint32_t b) {
+    return static_cast<int32_t>(a - b) < 0;
+}
+
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// Sending
+// ---------------------------------------------------------------------------
+
+bool ReliableEndpoint::send(DeliveryChannel channel, std::span<const uint8_t> message) {
+    if (message.size() > kMaxMessageSize) {
+        return false;
+    }
+    const uint32_t id = nextMessageId_[static_cast<std::size_t>(channel)]++;
+    enqueue(channel, id, message);
+    return true;
+}
+
+void ReliableEndpoint::enqueue(DeliveryChannel channel,
+                               uint32_t id,
+                               std::span<const uint8_t> message) {
+    const std::size_t count = std::max<std::size_t>(
+        1, (message.size() + kFragmentSize - 1) / kFragmentSize);
+    for (std::size_t i = 0; i < count; ++i) {
+        Fragment fragment;
+        fragment.channel = channel;
+        fragment.messageId = id;
+        fragment.index = static_cast<uint16_t>(i);
+        fragment.count = static_cast<uint16_t>(count);
+        const auto part = message.subspan(
+            i * kFragmentSize, std::min(kFragmentSize, message.size() - i * kFragmentSize));
+        fragment.bytes.assign(part.begin(), part.end());
+        if (channel == DeliveryChannel::UnreliableSequenced) {
+            unreliable_.push_back(std::move(fragment));
+        } else {
+            unacked_.emplace(nextFragmentKey_++, std::move(fragment));
+        }
+    }
+}
+
+void ReliableEndpoint::poll(Clock::time_point now, std::vector<std::vector<uint8_t>>& packets) {
+    std::vector<uint8_t> packet;
+    std::vector<uint64_t> carried;
+
+    auto finish = [&](bool bareAck) {
+        const uint16_t sequence = nextSequence_++;
+        std::vector<uint8_t> header;
+        header.reserve(kPacketHeaderSize);
+        put16(header, sequence);
+        header.push_back(receivedAny_ ? kFlagAckValid : uint8_t{0});
+        put16(header, remoteSequence_);
+        put32(header, receivedBits_);
+        std::copy(header.begin(), header.end(), packet.begin());
+
+        // Bare acks are never acked back, so they are not tracked
+        SentPacket& record = sent_[sequence % kSentRing];
+        record.sequence = sequence;
+        record.live = !bareAck;
+        record.sentAt = now;
+        record.fragments = std::move(carried);
+        carried.clear();
+
+        ++stats_.packetsSent;
+        ackPending_ = false;
+        packets.push_back(std::move(packet));
+        packet.clear();
+    };
+
+    auto add = [&](const Fragment& fragment) {
+        if (!packet.empty() &&
+            packet.size() + kChunkHeaderSize + fragment.bytes.size() > kMaxPacketSize) {
+            finish(false);
+        }
+        if (packet.empty()) {
+            packet.reserve(kMaxPacketSize);
+            packet.resize(kPacketHeaderSize);
+        }
+        packet.push_back(static_cast<uint8_t>(fragment.channel));
+        put32(packet, fragment.messageId);
+        put16(packet, fragment.index);
+        put16(packet, fragment.count);
+        put16(packet, static_cast<uint16_t>(fragment.bytes.size()));
+        packet.insert(packet.end(), fragment.bytes.begin(), fragment.bytes.end());
+    };
+
+    // Movement first: it is only worth sending while fresh.
+    for (const auto& fragment : unreliable_) {
+        add(fragment);
+    }
+    unreliable_.clear();
+
+    // unacked_ is in queue order, so the first fragment seen per channel
+    // belongs to its oldest unacked message.
+    std::array<bool, kDeliveryChannelCount> seen{};
+    std::array<uint32_t, kDeliveryChannelCount> oldest{};
+    const auto timeout = rto();
+    for (auto& [key, fragment] : unacked_) {
+        const auto ch = static_cast<std::size_t>(fragment.channel);
+        if (!seen[ch]) {
+            seen[ch] = true;
+            oldest[ch] = fragment.messageId;
+        }
+        if (!idBefore(fragment.messageId, oldest[ch] + kReceiveWindow)) {
+            continue;  // beyond the receiver's window
+        }
+        if (fragment.sends > 0) {
+            const auto backoff = timeout * (1 << std::min<uint32_t>(fragment.sends - 1, 3));
+            if (now - fragment.lastSent < backoff) {
+                continue;
+            }
+            ++stats_.retransmits;
+        }
+        add(fragment);
+        carried.push_back(key);
+        fragment.lastSent = now;
+        ++fragment.sends;
+    }
+
+    if (!packet.empty()) {
+        finish(false);
+    } else if (ackPending_) {
+        packet.resize(kPacketHeaderSize);
+        finish(true);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Receiving
+// ---------------------------------------------------------------------------
+
+bool ReliableEndpoint::receive(std::span<const uint8_t> packet,
+                               Clock::time_point now,
+                               std::vector<std::vector<uint8_t>>& messages) {
+    struct Chunk {
+        DeliveryChannel channel;
+        uint32_t id;
+        uint16_t index;
+        uint16_t count;
+        std::span<const uint8_t> data;
+    };
+
+    if (packet.size() < kPacketHeaderSize) {
+        ++stats_.dropped;
+        return false;
+    }
+    const uint16_t sequence = get16(packet.data());
+    const uint8_t flags = packet[2];
+    const uint16_t ack = get16(packet.data() + 3);
+    const uint32_t ackBits = get32(packet.data() + 5);
+
+    // Validate every chunk before acting on any of them
+    std::vector<Chunk> chunks;
+    std::size_t offset = kPacketHeaderSize;
+    while (offset < packet.size()) {
+        if (packet.size() - offset < kChunkHeaderSize) {
+            ++stats_.dropped;
+            return false;
+        }
+        const uint8_t* p = packet.data() + offset;
+        Chunk chunk{static_cast<DeliveryChannel>(p[0]), get32(p + 1), get16(p + 5),
+                    get16(p + 7), {}};
+        const uint16_t length = get16(p + 9);
+        offset += kChunkHeaderSize;
+        if (p[0] >= kDeliveryChannelCount || chunk.count == 0 || chunk.count > kMaxFragments ||
+            chunk.index >= chunk.count || length > kFragmentSize ||
+            length > packet.size() - offset || (chunk.count > 1 && length == 0)) {
+            ++stats_.dropped;
+            return false;
+        }
+        chunk.data = packet.subspan(offset, length);
+        offset += length;
+        chunks.push_back(chunk);
+    }
+
+    ++stats_.packetsReceived;
+    if ((flags & kFlagAckValid) != 0) {
+        processAck(ack, ackBits, now);
+    }
+
+    bool accepted = true;
+    for (const auto& chunk : chunks) {
+        accepted &= receiveChunk(chunk.channel, chunk.id, chunk.index, chunk.count, chunk.data,
+                                 messages);
+    }
+    // A bare ack needs no ack; a refused chunk must be sent again.
+    if (!chunks.empty() && accepted) {
+        markReceived(sequence);
+        ackPending_ = true;
+    }
+    return true;
+}
+
+void ReliableEndpoint::markReceived(uint16_t sequence) {
+    if (!receivedAny_) {
+        receivedAny_ = true;
+        remoteSequence_ = sequence;
+        receivedBits_ = 0;
+        return;
+    }
+    if (sequenceGreater(sequence, remoteSequence_)) {
+        const auto shift = static_cast<uint16_t>(sequence - remoteSequence_);
+        receivedBits_ = shift < 32 ? receivedBits_ << shift : 0;
+        if (shift <= 32) {
+            receivedBits_ |= 1u << (shift - 1);
+        }
+        remoteSequence_ = sequence;
+    } else if (sequence != remoteSequence_) {
+        const auto age = static_cast<uint16_t>(remoteSequence_ - sequence);
+        if (age <= 32) {
+            receivedBits_ |= 1u << (age - 1);
+        }
+    }
+}
+
+void ReliableEndpoint::processAck(uint16_t ack, uint32_t ackBits, Clock::time_point now) {
+    for (int i = -1; i < 32; ++i) {
+        if (i >= 0 && (ackBits & (1u << i)) == 0) {
+            continue;
+        }
+        const auto sequence = static_cast<uint16_t>(ack - 1 - i);
+        SentPacket& sent = sent_[sequence % kSentRing];
+        if (sent.live && sent.sequence == sequence) {
+            onAcked(sent, now);
+        }
+    }
+}
+
+void ReliableEndpoint::onAcked(SentPacket& sent, Clock::time_point now) {
+    sent.live = false;
+    ++stats_.packetsAcked;
+    for (auto key : sent.fragments) {
+        unacked_.erase(key);
+    }
+    sent.fragments.clear();
+
+    // RFC 6298 smoothing
+    const Clock::duration sample = now - sent.sentAt;
+    if (!rttSampled_) {
+        rttSampled_ = true;
+        srtt_ = sample;
+        rttvar_ = sample / 2;
+    } else {
+        rttvar_ = (3 * rttvar_ + std::chrono::abs(srtt_ - sample)) / 4;
+        srtt_ = (7 * srtt_ + sample) / 8;
+    }
+}
+
+bool ReliableEndpoint::receiveChunk(DeliveryChannel channel,
+                                    uint32_t id,
+                                    uint16_t index,
+                                    uint16_t count,
+                                    std::span<const uint8_t> data,
+                                    std::vector<std::vector<uint8_t>>& messages) {
+    Inbound& in = inbound_[static_cast<std::size_t>(channel)];
+    const bool sequenced = channel == DeliveryChannel::UnreliableSequenced;
+
+    // Stale or duplicate
+    if ((!sequenced || in.any) && idBefore(id, in.next)) {
+        ++stats_.dropped;
+        return true;
+    }
+    if (!sequenced) {
+        if (!idBefore(id, in.next + kReceiveWindow)) {
+            ++stats_.dropped;
+            return false;
+        }
+        if (in.ready.count(id) != 0 || in.done.count(id) != 0) {
+            ++stats_.dropped;
+            return true;
+        }
+    }
+
+    std::vector<uint8_t> message;
+    if (count == 1) {
+        message.assign(data.begin(), data.end());
+    } else {
+        auto it = in.partial.find(id);
+        if (it == in.partial.end()) {
+            if (in.partial.size() >= kMaxPartial) {
+                if (!sequenced) {
+                    return false;
+                }
+                in.partial.erase(in.partial.begin());
+            }
+            it = in.partial.emplace(id, Reassembly{}).first;
+            it->second.parts.resize(count);
+        }
+        Reassembly& partial = it->second;
+        if (partial.parts.size() != count || !partial.parts[index].empty()) {
+            ++stats_.dropped;
+            return true;
+        }
+        partial.parts[index].assign(data.begin(), data.end());
+        if (++partial.received < count) {
+            return true;
+        }
+        for (const auto& part : partial.parts) {
+            message.insert(message.end(), part.begin(), part.end());
+        }
+        in.partial.erase(it);
+    }
+
+    switch (channel) {
+        case DeliveryChannel::UnreliableSequenced:
+            deliver(std::move(message), messages);
+            in.any = true;
+            in.next = id + 1;
+            // Older partial messages can no longer be delivered
+            std::erase_if(in.partial, [&](const auto& p) { return idBefore(p.first, in.next); });
+            break;
+        case DeliveryChannel::ReliableOrdered:
+            if (id != in.next) {
+                in.ready.emplace(id, std::move(message));
+                break;
+            }
+            deliver(std::move(message), messages);
+            ++in.next;
+            for (auto it = in.ready.find(in.next); it != in.ready.end();
+                 it = in.ready.find(in.next)) {
+                deliver(std::move(it->second), messages);
+                in.ready.erase(it);
+                ++in.next;
+            }
+            break;
+        case DeliveryChannel::ReliableUnordered:
+            deliver(std::move(message), messages);
+            if (id != in.next) {
+                in.done.insert(id);
+                break;
+            }
+            ++in.next;
+            while (in.done.erase(in.next) != 0) {
+                ++in.next;
+            }
+            break;
+    }
+    return true;
+}
+
+void ReliableEndpoint::deliver(std::vector<uint8_t> message,
+                               std::vector<std::vector<uint8_t>>& messages) {
+    ++stats_.messagesDelivered;
+    messages.push_back(std::move(message));
+}
+
+// ---------------------------------------------------------------------------
+// RTT / stats
+// ---------------------------------------------------------------------------
+
+ReliableEndpoint::Clock::duration ReliableEndpoint::rto() const noexcept {
+    if (!rttSampled_) {
+        return kInitialRto;
+    }
+    const Clock::duration rto = srtt_ + 4 * rttvar_;
+    return std::clamp<Clock::duration>(rto, kMinRto, kMaxRto);
+}
+
+ReliabilityStats ReliableEndpoint::stats() const noexcept {
+    ReliabilityStats stats = stats_;
+    stats.rtt = std::chrono::duration_cast<std::chrono::microseconds>(srtt_);
+    stats.rto = std::chrono::duration_cast<std::chrono::microseconds>(rto());
+    stats.unackedFragments = unacked_.size();
+    return stats;
+}
+
+}  // namespace cgs::foundation
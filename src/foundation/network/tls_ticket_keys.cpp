@@ -0,0 +1,134 @@
+/// @file tls_ticket_keys.cpp
+/// @brief TlsTicketKeyRing key management and the kernel TLS probe.
+
+#include "cgs/foundation/tls_ticket_keys.hpp"
+
+#include "cgs/foundation/error_code.hpp"
+#include "cgs/foundation/game_error.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+
+namespace cgs::foundation {
+
+std::optional<TlsTicketKey> TlsTicketKey::fromRecord(std::span<const uint8_t> record) {
+    if (record.size() != kRecordSize) {
+        return std::nullopt;
+    }
+    TlsTicketKey key;
+    auto it = record.begin();
+    std::copy_n(it, kNameSize, key.name.begin());
+    it += kNameSize;
+    std::copy_n(it, kSecretSize, key.hmacSecret.begin());
+    it += kSecretSize;
+    std::copy_n(it, kSecretSize, key.aesKey.begin());
+    return key;
+}
+
+GameResult<void> TlsTicketKeyRing::setKeys(std::vector<TlsTicketKey> keys) {
+    if (keys.empty() || keys.size() > kMaxKeys) {
+        return GameResult<void>::err(
+            GameError(ErrorCode::InvalidArgument,
+                      "ticket key ring needs 1 to " + std::to_string(kMaxKeys) + " keys, got " +
+                          std::to_string(keys.size())));
+    }
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        for (std::size_t j = i + 1; j < keys.size(); ++j) {
+            if (keys[i].name == keys[j].name) {
+                return GameResult<void>::err(GameError(
+                    ErrorCode::InvalidArgument, "ticket keys " + std::to_string(i) + " and " +
+                                                    std::to_string(j) + " share a name"));
+            }
+        }
+    }
+
+    std::lock_guard lock(mutex_);
+    keys_ = std::move(keys);
+    ++generation_;
+    return GameResult<void>::ok();
+}
+
+GameResult<void> TlsTicketKeyRing::loadFile(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return GameResult<void>::err(
+            GameError(ErrorCode::ConfigLoadFailed, "cannot read ticket keys: " + path.string()));
+    }
+    const std::vector<uint8_t> bytes{std::istreambuf_iterator<char>(file),
+                                     std::istreambuf_iterator<char>()};
+    if (bytes.empty() || bytes.size() % TlsTicketKey::kRecordSize != 0) {
+        return GameResult<void>::err(GameError(
+            ErrorCode::ConfigLoadFailed,
+            path.string() + ": expected whole " + std::to_string(TlsTicketKey::kRecordSize) +
+                "-byte ticket key records, got " + std::to_string(bytes.size()) + " bytes"));
+    }
+
+    std::vector<TlsTicketKey> keys;
+    const std::span<const uint8_t> all(bytes);
+    for (std::size_t offset = 0; offset < all.size(); offset += TlsTicketKey::kRecordSize) {
+        keys.push_back(*TlsTicketKey::fromRecord(all.subspan(offset, TlsTicketKey::kRecordSize)));
+    }
+    return setKeys(std::move(keys));
+}
+
+void TlsTicketKeyRing::rotate(const TlsTicketKey& key) {
+    std::lock_guard lock(mutex_);
+    std::erase(keys_, key);
+    keys_.insert(keys_.begin(), key);
+    if (keys_.size() > kMaxKeys) {
+        keys_.resize(kMaxKeys);
+    }
+    ++generation_;
+}
+
+std::optional<TlsTicketKey> TlsTicketKeyRing::encryptionKey() const {
+    std::lock_guard lock(mutex_);
+    if (keys_.empty()) {
+        return std::nullopt;
+    }
+    return keys_.front();
+}
+
+std::optional<TlsTicketKey> TlsTicketKeyRing::find(
+    std::span<const uint8_t, TlsTicketKey::kNameSize> name) const {
+    std::lock_guard lock(mutex_);
+    for (const auto& key : keys_) {
+        if (std::equal(name.begin(), name.end(), key.name.begin())) {
+            return key;
+        }
+    }
+    return std::nullopt;
+}
+
+std::size_t TlsTicketKeyRing::size() const {
+    std::lock_guard lock(mutex_);
+    return keys_.size();
+}
+
+bool TlsTicketKeyRing::empty() const {
+    return size() == 0;
+}
+
+uint64_t TlsTicketKeyRing::generation() const {
+    std::lock_guard lock(mutex_);
+    return generation_;
+}
+
+bool kernelTlsAvailable() {
+#if defined(__linux__)
+    // The tls module registers itself as an upper-layer protocol once loaded.
+    std::ifstream ulps("/proc/sys/net/ipv4/tcp_available_ulp");
+    std::string ulp;
+    while (ulps >> ulp) {
+        if (ulp == "tls") {
+            return true;
+        }
+    }
+#endif
+    return false;
+}
+
+}  // namespace cgs::foundation
@@ -0,0 +1,106 @@
+/// @file wire_buffer.cpp
+/// @brief WireBuffer recycling and WireBufferPool free list.
+
+#include "cgs/foundation/wire_buffer.hpp"
+
+#include <mutex>
+
+namespace cgs::foundation {
+
+struct WireBuffer::PoolState {
+    std::mutex mutex;
+    std::vector<Storage*> idle;  ///< Idle storage holds no pool reference.
+    std::size_t maxIdle = 0;
+    uint64_t allocations = 0;
+    bool alive = true;  ///< False once the owning pool is destroyed.
+};
+
+std::vector<uint8_t> WireBuffer::take() {
+    std::vector<uint8_t> out;
+    if (storage_ == nullptr) {
+        return out;
+    }
+    if (storage_->refs.load(std::memory_order_acquire) == 1) {
+        out = std::move(storage_->bytes);
+    } else {
+        out.assign(storage_->bytes.begin(), storage_->bytes.end());
+    }
+    release();
+    return out;
+}
+
+void WireBuffer::recycle(Storage* storage) noexcept {
+    auto pool = std::move(storage->pool);
+    if (pool != nullptr) {
+        std::lock_guard lock(pool->mutex);
+        if (pool->alive && pool->idle.size() < pool->maxIdle &&
+            storage->bytes.capacity() <= WireBufferPool::kMaxRetainedCapacity) {
+            storage->bytes.clear();
+            storage->refs.store(1, std::memory_order_relaxed);
+            pool->idle.push_back(storage);
+            return;
+        }
+    }
+    delete storage;
+}
+
+WireBufferPool::WireBufferPool(std::size_t maxIdle)
+    : state_(std::make_shared<WireBuffer::PoolState>()) {
+    state_->maxIdle = maxIdle;
+    state_->idle.reserve(maxIdle);
+}
+
+WireBufferPool::~WireBufferPool() {
+    std::lock_guard lock(state_->mutex);
+    state_->alive = false;
+    for (auto* storage : state_->idle) {
+        delete storage;
+    }
+    state_->idle.clear();
+}
+
+WireBuffer WireBufferPool::acquire(std::size_t payloadCapacity) {
+    WireBuffer::Storage* storage = nullptr;
+    {
+        std::lock_guard lock(state_->mutex);
+        if (!state_->idle.empty()) {
+            storage = state_->idle.back();
+            state_->idle.pop_back();
+        } else {
+            ++state_->allocations;
+        }
+    }
+    if (storage == nullptr) {
+        storage = new WireBuffer::Storage();
+    }
+    storage->pool = state_;
+    storage->bytes.reserve(WireBuffer::kHeaderSize + payloadCapacity);
+    storage->bytes.resize(WireBuffer::kHeaderSize);
+    return WireBuffer(storage);
+}
+
+WireBuffer WireBufferPool::frame(uint16_t opcode,
+                                 std::span<const uint8_t> payload,
+                                 bool compressed,
+                                 const TraceContext& trace) {
+    const bool traced = trace.valid();
+    auto buffer = acquire((traced ? TraceContext::kEncodedSize : 0) + payload.size());
+    if (traced) {
+        trace.encode(buffer.extend(TraceContext::kEncodedSize).data());
+    }
+    buffer.append(payload);
+    buffer.seal(opcode, compressed, traced);
+    return buffer;
+}
+
+std::size_t WireBufferPool::idleCount() const {
+    std::lock_guard lock(state_->mutex);
+    return state_->idle.size();
+}
+
+uint64_t WireBufferPool::allocationCount() const {
+    std::lock_guard lock(state_->mutex);
+    return state_->allocations;
+}
+
+}  // namespace cgs::foundation
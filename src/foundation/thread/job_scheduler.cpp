@@ -3,13 +3,20 @@
 
 #include "cgs/foundation/job_scheduler.hpp"
 
+#include "timer_wheel.hpp"
+#include "work_stealing_pool.hpp"
+
 // kcenon thread_system headers (hidden behind PIMPL)
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <exception>
 #include <future>
 #include <kcenon/thread/core/job_builder.h>
 #include <kcenon/thread/core/thread_pool.h>
 #include <kcenon/thread/core/thread_worker.h>
 #include <mutex>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
@@ -32,35 +39,156 @@ static kcenon::thread::job_priority mapPriority(JobPriority p) {
     return kcenon::thread::job_priority::normal;
 }
 
+// ---------------------------------------------------------------------------
+// JobGraph
+// ---------------------------------------------------------------------------
+namespace detail {
+
+/// State of one JobGraph::run(), shared by the graph and every node job
+/// in flight (a node still notifies `remaining` after run() returned).
+struct GraphRun {
+    JobGraph* graph = nullptr;
+    WorkStealingPool* pool = nullptr;
+    std::unique_ptr<std::atomic<uint32_t>[]> pending;  // Unfinished predecessors per node
+    std::size_t capacity = 0;
+    std::atomic<std::size_t> remaining{0};  // Nodes not yet finished
+
+    static void spawn(const std::shared_ptr<GraphRun>& self, JobGraph::NodeId node) {
+        if (!self->pool->submit([self, node] { execute(self, node); })) {
+            execute(self, node);  // Out of slots: run it here
+        }
+    }
+
+    static void execute(const std::shared_ptr<GraphRun>& self, JobGraph::NodeId node) {
+        auto& entry = self->graph->nodes_[node];
+        try {
+            if (entry.job) {
+                entry.job();
+            }
+        } catch (...) {
+            // Discarded like a throwing submit() job; successors still run.
+        }
+        for (const auto successor : entry.successors) {
+            if (self->pending[successor].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                spawn(self, successor);
+            }
+        }
+        if (self->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            self->remaining.notify_all();
+        }
+    }
+};
+
+}  // namespace detail
+
+JobGraph::JobGraph() = default;
+JobGraph::~JobGraph() = default;
+JobGraph::JobGraph(JobGraph&&) noexcept = default;
+JobGraph& JobGraph::operator=(JobGraph&&) noexcept = default;
+
+JobGraph::NodeId JobGraph::add(InlineJob job) {
+    nodes_.push_back(Node{std::move(job), {}, 0});
+    checked_ = false;
+    return static_cast<NodeId>(nodes_.size() - 1);
+}
+
+GameResult<void> JobGraph::precede(NodeId before, NodeId after) {
+    if (before >= nodes_.size() || after >= nodes_.size()) {
+        return GameResult<void>::err(GameError(ErrorCode::JobNotFound, "graph node not found"));
+    }
+    nodes_[before].successors.push_back(after);
+    ++nodes_[after].predecessors;
+    checked_ = false;
+    return GameResult<void>::ok();
+}
+
+void JobGraph::clear() {
+    nodes_.clear();
+    checked_ = false;
+}
+
+bool JobGraph::acyclic() {
+    if (checked_) {
+        return acyclic_;
+    }
+    std::vector<uint32_t> indegree(nodes_.size());
+    std::vector<NodeId> ready;
+    for (std::size_t i = 0; i < nodes_.size(); ++i) {
+        indegree[i] = nodes_[i].predecessors;
+        if (indegree[i] == 0) {
+            ready.push_back(static_cast<NodeId>(i));
+        }
+    }
+    std::size_t visited = 0;
+    while (!ready.empty()) {
+        const NodeId node = ready.back();
+        ready.pop_back();
+        ++visited;
+        for (const auto successor : nodes_[node].successors) {
+            if (--indegree[successor] == 0) {
+                ready.push_back(successor);
+            }
+        }
+    }
+    checked_ = true;
+    acyclic_ = visited == nodes_.size();
+    return acyclic_;
+}
+
 // ---------------------------------------------------------------------------
 // Impl
 // ---------------------------------------------------------------------------
 struct GameJobScheduler::Impl {
-    struct TickEntry {
-        JobId id;
-        std::chrono::milliseconds interval;
-        std::chrono::milliseconds elapsed{0};
-        JobFunc func;
-        bool enabled{true};
-    };
-
     std::shared_ptr<kcenon::thread::thread_pool> pool;
     std::atomic<uint64_t> nextJobId{1};
 
+    // Native path (submit()), started on first use.  ids carry
+    // WorkStealingPool::kIdTag, so they never collide with nextJobId.
+    std::size_t numThreads = 0;
+    CpuSet affinity;
+    std::once_flag nativeOnce;
+    std::unique_ptr<detail::WorkStealingPool> nativeStorage;
+    std::atomic<detail::WorkStealingPool*> native{nullptr};
+
+    detail::WorkStealingPool& nativePool() {
+        std::call_once(nativeOnce, [this] {
+            nativeStorage = std::make_unique<detail::WorkStealingPool>(numThreads, affinity);
+            native.store(nativeStorage.get(), std::memory_order_release);
+        });
+        return *nativeStorage;
+    }
+
     // Tracking: JobId -> shared_future for wait()/cancel() support
     std::unordered_map<JobId, std::shared_future<void>> futures;
     std::unordered_map<JobId, std::shared_ptr<std::atomic<bool>>> cancelFlags;
 
-    // Tick scheduling
-    std::vector<TickEntry> tickJobs;
-
     std::mutex mutex;
+
+    // Timed jobs (scheduleTick/At/Delay).  ids carry TimerWheel::kIdTag;
+    // expired jobs run on the native workers.
+    std::mutex timerMutex;
+    detail::TimerWheel timers;
+    std::vector<InlineJob> expired;  // processTick() scratch, kept for its capacity
 };
 
+namespace {
+
+uint64_t toTicks(std::chrono::milliseconds duration) noexcept {
+    return duration.count() > 0 ? static_cast<uint64_t>(duration.count()) : 0;
+}
+
+}  // namespace
+
 // ---------------------------------------------------------------------------
 // Construction / Destruction / Move
 // ---------------------------------------------------------------------------
-GameJobScheduler::GameJobScheduler(std::size_t numThreads) : impl_(std::make_unique<Impl>()) {
+GameJobScheduler::GameJobScheduler(std::size_t numThreads)
+    : GameJobScheduler(numThreads, CpuSet{}) {}
+
+GameJobScheduler::GameJobScheduler(std::size_t numThreads, CpuSet affinity)
+    : impl_(std::make_unique<Impl>()) {
+    impl_->numThreads = numThreads;
+    impl_->affinity = std::move(affinity);
     impl_->pool = std::make_shared<kcenon::thread::thread_pool>("GameJobScheduler");
 
     // Create workers using the default thread_worker constructor and batch
@@ -84,6 +212,12 @@ GameJobScheduler::~GameJobScheduler() {
     if (impl_ && impl_->pool) {
         impl_->pool->stop(false);  // graceful: wait for running jobs
     }
+    // scheduleAfter() jobs may wait on native ids, so the native pool
+    // drains and joins only after the kcenon pool stopped.
+    if (impl_) {
+        impl_->native.store(nullptr, std::memory_order_relaxed);
+        impl_->nativeStorage.reset();
+    }
 }
 
 GameJobScheduler::GameJobScheduler(GameJobScheduler&&) noexcept = default;
@@ -135,10 +269,156 @@ GameResult<GameJobScheduler::JobId> GameJobScheduler::schedule(JobFunc job, JobP
     return GameResult<JobId>::ok(id);
 }
 
+// ---------------------------------------------------------------------------
+// submit() / stats()
+// ---------------------------------------------------------------------------
+GameResult<GameJobScheduler::JobId> GameJobScheduler::submit(InlineJob job) {
+    auto id = impl_->nativePool().submit(std::move(job));
+    if (!id) {
+        return GameResult<JobId>::err(
+            GameError(ErrorCode::JobScheduleFailed, "no worker or job slot available"));
+    }
+    return GameResult<JobId>::ok(*id);
+}
+
+JobSchedulerStats GameJobScheduler::stats() const {
+    auto* native = impl_->native.load(std::memory_order_acquire);
+    return native != nullptr ? native->stats() : JobSchedulerStats{};
+}
+
+// ---------------------------------------------------------------------------
+// run() / parallelFor() / runBatch()
+// ---------------------------------------------------------------------------
+GameResult<void> GameJobScheduler::run(JobGraph& graph) {
+    if (!graph.acyclic()) {
+        return GameResult<void>::err(
+            GameError(ErrorCode::JobDependencyFailed, "job graph contains a cycle"));
+    }
+    const std::size_t count = graph.nodes_.size();
+    if (count == 0) {
+        return GameResult<void>::ok();
+    }
+
+    // Reuse the previous run's counters unless a finished node job has not
+    // released them yet.
+    auto& state = graph.run_;
+    if (!state || state.use_count() != 1) {
+        state = std::make_shared<detail::GraphRun>();
+    }
+    if (state->capacity < count) {
+        state->pending = std::make_unique<std::atomic<uint32_t>[]>(count);
+        state->capacity = count;
+    }
+    state->graph = &graph;
+    state->pool = &impl_->nativePool();
+    for (std::size_t i = 0; i < count; ++i) {
+        state->pending[i].store(graph.nodes_[i].predecessors, std::memory_order_relaxed);
+    }
+    state->remaining.store(count, std::memory_order_release);
+
+    if (state->pool->workerCount() == 0) {
+        // No workers: run roots inline; execute() recurses into successors.
+        for (JobGraph::NodeId node = 0; node < count; ++node) {
+            if (graph.nodes_[node].predecessors == 0) {
+                detail::GraphRun::execute(state, node);
+            }
+        }
+        return GameResult<void>::ok();
+    }
+
+    for (JobGraph::NodeId node = 0; node < count; ++node) {
+        if (graph.nodes_[node].predecessors == 0) {
+            detail::GraphRun::spawn(state, node);
+        }
+    }
+    state->pool->waitFor(state->remaining);
+    return GameResult<void>::ok();
+}
+
+void GameJobScheduler::parallelFor(std::size_t begin,
+                                   std::size_t end,
+                                   std::size_t grain,
+                                   const std::function<void(std::size_t, std::size_t)>& fn) {
+    if (begin >= end) {
+        return;
+    }
+    grain = std::max<std::size_t>(grain, 1);
+    const std::size_t chunks = (end - begin + grain - 1) / grain;
+    auto& pool = impl_->nativePool();
+    if (chunks == 1 || pool.workerCount() == 0) {
+        fn(begin, end);
+        return;
+    }
+
+    // Helpers and the caller claim chunks from one counter; the caller
+    // then waits on the helpers' ids (running other work meanwhile), so
+    // nothing outlives this frame.
+    constexpr std::size_t kMaxHelpers = 64;
+    std::atomic<std::size_t> nextChunk{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    auto drain = [&] {
+        for (;;) {
+            const std::size_t chunk = nextChunk.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= chunks || failed.load(std::memory_order_relaxed)) {
+                return;
+            }
+            const std::size_t first = begin + chunk * grain;
+            try {
+                fn(first, std::min(first + grain, end));
+            } catch (...) {
+                if (!failed.exchange(true, std::memory_order_acq_rel)) {
+                    error = std::current_exception();
+                }
+                return;
+            }
+        }
+    };
+
+    std::array<uint64_t, kMaxHelpers> helpers{};
+    std::size_t helperCount = 0;
+    const std::size_t wanted = std::min({chunks - 1, pool.workerCount(), kMaxHelpers});
+    for (std::size_t i = 0; i < wanted; ++i) {
+        if (auto id = pool.submit([&drain] { drain(); })) {
+            helpers[helperCount++] = *id;
+        }
+    }
+    drain();
+    for (std::size_t i = 0; i < helperCount; ++i) {
+        pool.wait(helpers[i]);
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void GameJobScheduler::runBatch(const std::vector<std::function<void()>>& tasks) {
+    parallelFor(0, tasks.size(), 1, [&tasks](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            tasks[i]();
+        }
+    });
+}
+
 // ---------------------------------------------------------------------------
 // scheduleAfter()
 // ---------------------------------------------------------------------------
 GameResult<GameJobScheduler::JobId> GameJobScheduler::scheduleAfter(JobId dependency, JobFunc job) {
+    if (detail::WorkStealingPool::ownsId(dependency)) {
+        auto* native = impl_->native.load(std::memory_order_acquire);
+        if (native == nullptr ||
+            native->status(dependency) == detail::WorkStealingPool::Status::Unknown) {
+            return GameResult<JobId>::err(
+                GameError(ErrorCode::JobNotFound, "dependency job not found"));
+        }
+        return schedule(
+            [native, dependency, fn = std::move(job)]() {
+                native->wait(dependency);
+                fn();
+            },
+            JobPriority::Normal);
+    }
+
     std::shared_future<void> depFuture;
     {
         std::lock_guard lock(impl_->mutex);
@@ -160,50 +440,74 @@ GameResult<GameJobScheduler::JobId> GameJobScheduler::scheduleAfter(JobId depend
 }
 
 // ---------------------------------------------------------------------------
-// scheduleTick()
+// scheduleTick() / scheduleAt() / scheduleDelay()
 // ---------------------------------------------------------------------------
 GameResult<GameJobScheduler::JobId> GameJobScheduler::scheduleTick(
     std::chrono::milliseconds interval, JobFunc job) {
-    auto id = impl_->nextJobId.fetch_add(1, std::memory_order_relaxed);
+    const uint64_t ticks = toTicks(interval);
+    std::lock_guard lock(impl_->timerMutex);
+    return GameResult<JobId>::ok(
+        impl_->timers.schedulePeriodic(impl_->timers.now() + ticks, ticks, std::move(job)));
+}
 
-    std::lock_guard lock(impl_->mutex);
-    impl_->tickJobs.push_back(
-        Impl::TickEntry{id, interval, std::chrono::milliseconds{0}, std::move(job), true});
+GameResult<GameJobScheduler::JobId> GameJobScheduler::scheduleAt(std::chrono::milliseconds when,
+                                                                 InlineJob job) {
+    std::lock_guard lock(impl_->timerMutex);
+    return GameResult<JobId>::ok(impl_->timers.scheduleOnce(toTicks(when), std::move(job)));
+}
 
-    return GameResult<JobId>::ok(id);
+GameResult<GameJobScheduler::JobId> GameJobScheduler::scheduleDelay(
+    std::chrono::milliseconds delay, InlineJob job) {
+    std::lock_guard lock(impl_->timerMutex);
+    return GameResult<JobId>::ok(
+        impl_->timers.scheduleOnce(impl_->timers.now() + toTicks(delay), std::move(job)));
+}
+
+std::chrono::milliseconds GameJobScheduler::tickTime() const {
+    std::lock_guard lock(impl_->timerMutex);
+    return std::chrono::milliseconds{static_cast<int64_t>(impl_->timers.now())};
 }
 
 // ---------------------------------------------------------------------------
 // processTick()
 // ---------------------------------------------------------------------------
 void GameJobScheduler::processTick(std::chrono::milliseconds deltaTime) {
-    std::lock_guard lock(impl_->mutex);
-
-    for (auto& tick : impl_->tickJobs) {
-        if (!tick.enabled) {
-            continue;
-        }
-        tick.elapsed += deltaTime;
-        if (tick.elapsed >= tick.interval) {
-            tick.elapsed = std::chrono::milliseconds{0};
-            // Copy the function and dispatch into the pool (no lock held during enqueue)
-            auto fn = tick.func;
-            auto threadJob = kcenon::thread::job_builder()
-                                 .name("cgs_tick_" + std::to_string(tick.id))
-                                 .work([fn]() -> kcenon::common::VoidResult {
-                                     fn();
-                                     return kcenon::common::VoidResult::ok(std::monostate{});
-                                 })
-                                 .build();
-            impl_->pool->enqueue(std::move(threadJob));
+    std::vector<InlineJob> due;
+    {
+        std::lock_guard lock(impl_->timerMutex);
+        due.swap(impl_->expired);
+        impl_->timers.advance(toTicks(deltaTime), due);
+    }
+    if (!due.empty()) {
+        // Dispatch outside the lock: timer jobs may schedule more timers.
+        auto& pool = impl_->nativePool();
+        for (auto& job : due) {
+            if (!pool.submit(std::move(job))) {
+                try {
+                    job();  // No workers, or out of slots: run it here
+                } catch (...) {
+                    // Discarded, as on a worker
+                }
+            }
         }
+        due.clear();
     }
+    std::lock_guard lock(impl_->timerMutex);
+    impl_->expired.swap(due);
 }
 
 // ---------------------------------------------------------------------------
 // wait()
 // ---------------------------------------------------------------------------
 GameResult<void> GameJobScheduler::wait(JobId id) {
+    if (detail::WorkStealingPool::ownsId(id)) {
+        auto* native = impl_->native.load(std::memory_order_acquire);
+        if (native == nullptr || !native->wait(id)) {
+            return GameResult<void>::err(GameError(ErrorCode::JobNotFound, "job not found"));
+        }
+        return GameResult<void>::ok();
+    }
+
     std::shared_future<void> future;
     {
         std::lock_guard lock(impl_->mutex);
@@ -227,17 +531,33 @@ GameResult<void> GameJobScheduler::wait(JobId id) {
 // cancel()
 // ---------------------------------------------------------------------------
 GameResult<void> GameJobScheduler::cancel(JobId id) {
+    if (detail::TimerWheel::ownsId(id)) {
+        std::lock_guard lock(impl_->timerMutex);
+        if (!impl_->timers.cancel(id)) {
+            return GameResult<void>::err(GameError(ErrorCode::JobNotFound, "job not found"));
+        }
+        return GameResult<void>::ok();
+    }
+    if (detail::WorkStealingPool::ownsId(id)) {
+        auto* native = impl_->native.load(std::memory_order_acquire);
+        const auto status =
+            native != nullptr ? native->cancel(id) : detail::WorkStealingPool::Status::Unknown;
+        switch (status) {
+            case detail::WorkStealingPool::Status::Pending:
+                return GameResult<void>::ok();
+            case detail::WorkStealingPool::Status::Done:
+                return GameResult<void>::err(
+                    GameError(ErrorCode::JobCancelled, "job already completed"));
+            case detail::WorkStealingPool::Status::Unknown:
+                break;
+        }
+        return GameResult<void>::err(GameError(ErrorCode::JobNotFound, "job not found"));
+    }
+
     std::lock_guard lock(impl_->mutex);
 
     auto flagIt = impl_->cancelFlags.find(id);
     if (flagIt == impl_->cancelFlags.end()) {
-        // Might be a tick job — disable it
-        for (auto& tick : impl_->tickJobs) {
-            if (tick.id == id) {
-                tick.enabled = false;
-                return GameResult<void>::ok();
-            }
-        }
         return GameResult<void>::err(GameError(ErrorCode::JobNotFound, "job not found"));
     }
 
@@ -0,0 +1,271 @@
+/// @file timer_wheel.cpp
+/// @brief TimerWheel implementation.
+
+#include "timer_wheel.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+namespace cgs::foundation::detail {
+
+namespace {
+
+constexpr uint64_t kSlotMask = TimerWheel::kSlots - 1;
+constexpr uint64_t kSpan = uint64_t{1} << (TimerWheel::kSlotBits * TimerWheel::kLevels);
+constexpr uint32_t kGenerationMask = 0x3FFFFFFFu;  // Bits 32..61 of an id
+
+}  // namespace
+
+TimerWheel::TimerWheel() noexcept {
+    heads_.fill(kNil);
+}
+
+TimerWheel::~TimerWheel() {
+    for (auto& node : nodes_) {
+        if (node.periodic != nullptr) {
+            node.periodic->release();  // Firings still in flight keep it alive
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Node pool
+// ---------------------------------------------------------------------------
+uint32_t TimerWheel::allocate() {
+    uint32_t index = freeHead_;
+    if (index != kNil) {
+        freeHead_ = nodes_[index].next;
+    } else {
+        index = static_cast<uint32_t>(nodes_.size());
+        nodes_.emplace_back();
+    }
+    ++nodes_[index].generation;  // Odd: live
+    ++live_;
+    return index;
+}
+
+void TimerWheel::release(uint32_t index) {
+    Node& node = nodes_[index];
+    node.once.reset();
+    if (node.periodic != nullptr) {
+        node.periodic->release();
+        node.periodic = nullptr;
+    }
+    ++node.generation;  // Even: free, and any old id goes stale
+    node.list = kNoList;
+    node.prev = kNil;
+    node.next = freeHead_;
+    freeHead_ = index;
+    --live_;
+}
+
+uint64_t TimerWheel::makeId(uint32_t index) const noexcept {
+    return kIdTag | (uint64_t{nodes_[index].generation & kGenerationMask} << 32) | index;
+}
+
+// ---------------------------------------------------------------------------
+// Slot lists
+// ---------------------------------------------------------------------------
+void TimerWheel::link(uint16_t list, uint32_t index) noexcept {
+    Node& node = nodes_[index];
+    node.list = list;
+    node.prev = kNil;
+    node.next = heads_[list];
+    if (node.next != kNil) {
+        nodes_[node.next].prev = index;
+    }
+    heads_[list] = index;
+    if (list < kSlots) {
+        occupied_[list / 64] |= uint64_t{1} << (list % 64);
+    }
+}
+
+void TimerWheel::unlink(uint32_t index) noexcept {
+    Node& node = nodes_[index];
+    if (node.prev != kNil) {
+        nodes_[node.prev].next = node.next;
+    } else {
+        heads_[node.list] = node.next;
+    }
+    if (node.next != kNil) {
+        nodes_[node.next].prev = node.prev;
+    }
+    if (node.list < kSlots && heads_[node.list] == kNil) {
+        occupied_[node.list / 64] &= ~(uint64_t{1} << (node.list % 64));
+    }
+    node.list = kNoList;
+}
+
+uint32_t TimerWheel::detach(uint16_t list) noexcept {
+    const uint32_t head = std::exchange(heads_[list], kNil);
+    if (list < kSlots) {
+        occupied_[list / 64] &= ~(uint64_t{1} << (list % 64));
+    }
+    return head;
+}
+
+void TimerWheel::file(uint32_t index) {
+    Node& node = nodes_[index];
+    // Beyond the wheel's span: park in the top level; it is re-filed,
+    // closer to its deadline, when that slot cascades.
+    const uint64_t deadline = std::min(node.deadline, now_ + kSpan - 1);
+    const uint64_t delta = deadline - now_;
+    int level = 0;
+    while (level < kLevels - 1 && delta >= (uint64_t{1} << (kSlotBits * (level + 1)))) {
+        ++level;
+    }
+    const uint64_t slot = (deadline >> (kSlotBits * level)) & kSlotMask;
+    link(static_cast<uint16_t>(static_cast<uint64_t>(level) * kSlots + slot), index);
+}
+
+// ---------------------------------------------------------------------------
+// Scheduling
+// ---------------------------------------------------------------------------
+uint64_t TimerWheel::scheduleOnce(uint64_t deadline, InlineJob job) {
+    const uint32_t index = allocate();
+    Node& node = nodes_[index];
+    node.deadline = deadline;
+    node.interval = 0;
+    node.once = std::move(job);
+    if (deadline <= now_) {
+        link(kDueList, index);
+    } else {
+        file(index);
+    }
+    return makeId(index);
+}
+
+uint64_t TimerWheel::schedulePeriodic(uint64_t firstDeadline,
+                                      uint64_t interval,
+                                      GameJobScheduler::JobFunc job) {
+    auto* periodic = new Periodic{std::move(job)};
+    const uint32_t index = allocate();
+    Node& node = nodes_[index];
+    node.deadline = firstDeadline;
+    node.interval = interval;
+    node.periodic = periodic;
+    if (firstDeadline <= now_) {
+        link(kDueList, index);
+    } else {
+        file(index);
+    }
+    return makeId(index);
+}
+
+bool TimerWheel::cancel(uint64_t id) {
+    if (!ownsId(id)) {
+        return false;
+    }
+    const auto index = static_cast<uint32_t>(id);
+    const auto generation = static_cast<uint32_t>(id >> 32) & kGenerationMask;
+    if (index >= nodes_.size()) {
+        return false;
+    }
+    Node& node = nodes_[index];
+    if ((node.generation & 1u) == 0 || (node.generation & kGenerationMask) != generation) {
+        return false;
+    }
+    if (node.list != kNoList) {
+        unlink(index);
+    }
+    release(index);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// advance()
+// ---------------------------------------------------------------------------
+void TimerWheel::expire(uint32_t index, std::vector<InlineJob>& out) {
+    Node& node = nodes_[index];
+    if (node.periodic == nullptr) {
+        out.push_back(std::move(node.once));
+        release(index);
+        return;
+    }
+
+    // The firing shares the callback; it stays valid if the timer is
+    // cancelled (or the wheel destroyed) while the job is queued.
+    Periodic* periodic = node.periodic;
+    periodic->refs.fetch_add(1, std::memory_order_relaxed);
+    out.emplace_back([periodic] {
+        struct Release {
+            Periodic* periodic;
+            ~Release() { periodic->release(); }
+        } guard{periodic};
+        periodic->fn();
+    });
+
+    // Fixed rate: the next deadline follows the previous one, not now.
+    node.deadline += node.interval;
+    if (node.deadline <= now_) {
+        link(kDueList, index);  // Zero interval: once per advance()
+    } else {
+        file(index);
+    }
+}
+
+uint64_t TimerWheel::nextStop() const noexcept {
+    // Next occupied level-0 slot in this rotation, else the rotation's end.
+    const uint64_t base = now_ & ~kSlotMask;
+    for (auto slot = static_cast<std::size_t>((now_ & kSlotMask) + 1); slot < kSlots;) {
+        const uint64_t bits = occupied_[slot / 64] >> (slot % 64);
+        if (bits != 0) {
+            return base + slot + static_cast<std::size_t>(std::countr_zero(bits));
+        }
+        slot = (slot / 64 + 1) * 64;
+    }
+    return base + kSlots;
+}
+
+void TimerWheel::advance(uint64_t delta, std::vector<InlineJob>& out) {
+    // Timers that were already due when scheduled or re-armed.
+    for (uint32_t index = detach(kDueList); index != kNil;) {
+        const uint32_t next = nodes_[index].next;
+        nodes_[index].list = kNoList;
+        expire(index, out);
+        index = next;
+    }
+
+    const uint64_t target = now_ + delta;
+    while (now_ < target) {
+        if (live_ == 0) {
+            now_ = target;
+            break;
+        }
+        const uint64_t stop = nextStop();
+        if (stop > target) {
+            now_ = target;
+            break;
+        }
+        now_ = stop;
+
+        if ((now_ & kSlotMask) == 0) {
+            // Rotation boundary: move the higher-level slots that start
+            // now down the wheel, outermost first.
+            int top = 1;
+            while (top < kLevels - 1 && ((now_ >> (kSlotBits * top)) & kSlotMask) == 0) {
+                ++top;
+            }
+            for (int level = top; level >= 1; --level) {
+                const uint64_t slot = (now_ >> (kSlotBits * level)) & kSlotMask;
+                const auto list =
+                    static_cast<uint16_t>(static_cast<uint64_t>(level) * kSlots + slot);
+                for (uint32_t index = detach(list); index != kNil;) {
+                    const uint32_t next = nodes_[index].next;
+                    file(index);
+                    index = next;
+                }
+            }
+        }
+
+        for (uint32_t index = detach(static_cast<uint16_t>(now_ & kSlotMask)); index != kNil;) {
+            const uint32_t next = nodes_[index].next;
+            nodes_[index].list = kNoList;
+            expire(index, out);
+            index = next;
+        }
+    }
+}
+
+}  // namespace cgs::foundation::detail
@@ -0,0 +1,118 @@
+#pragma once
+
+/// @file timer_wheel.hpp
+/// @brief Hierarchical timing wheel behind GameJobScheduler's timed jobs.
+///
+/// Four levels of 256 slots at 1 ms, 256 ms, ~65 s and ~4.7 h resolution
+/// (~49.7 days in all; later deadlines park in the top level and are
+/// re-filed as it turns).  Timers are pooled nodes on intrusive,
+/// index-linked slot lists, so scheduling and cancelling are O(1) and
+/// advancing touches only the slots that expire or cascade; runs of
+/// empty level-0 slots are skipped with an occupancy bitmap.  Internal
+/// to the Thread Adapter (SDS-MOD-002); not thread-safe.
+
+#include "cgs/foundation/job_scheduler.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cgs::foundation::detail {
+
+class TimerWheel {
+public:
+    /// Bit marking timer ids (native-pool ids use bit 63, kcenon-path
+    /// ids are small counters).
+    static constexpr uint64_t kIdTag = uint64_t{1} << 62;
+
+    static constexpr int kLevels = 4;
+    static constexpr int kSlotBits = 8;
+    static constexpr std::size_t kSlots = std::size_t{1} << kSlotBits;
+
+    TimerWheel() noexcept;
+    ~TimerWheel();
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    [[nodiscard]] static bool ownsId(uint64_t id) noexcept {
+        return (id & (kIdTag | (uint64_t{1} << 63))) == kIdTag;
+    }
+
+    /// Current wheel time in milliseconds.
+    [[nodiscard]] uint64_t now() const noexcept { return now_; }
+
+    /// Live timers.
+    [[nodiscard]] std::size_t size() const noexcept { return live_; }
+
+    /// Run @p job once at @p deadline (ms).  @return The timer id.
+    uint64_t scheduleOnce(uint64_t deadline, InlineJob job);
+
+    /// Run @p job at @p firstDeadline, then every @p interval ms after
+    /// the previous deadline.  @return The timer id.
+    uint64_t schedulePeriodic(uint64_t firstDeadline,
+                              uint64_t interval,
+                              GameJobScheduler::JobFunc job);
+
+    /// Remove timer @p id.  @return false if it is not live.
+    bool cancel(uint64_t id);
+
+    /// Move time forward by @p delta ms and append a runnable job for
+    /// each expiry (in deadline order) to @p out.  Timers due at or
+    /// before the current time when scheduled or re-armed fire on the
+    /// next advance(), not within this one.
+    void advance(uint64_t delta, std::vector<InlineJob>& out);
+
+private:
+    static constexpr uint32_t kNil = 0xFFFFFFFFu;
+    static constexpr uint16_t kDueList = kLevels * kSlots;
+    static constexpr uint16_t kNoList = kDueList + 1;
+
+    /// Callback of a periodic timer, shared by its in-flight firings.
+    struct Periodic {
+        GameJobScheduler::JobFunc fn;
+        std::atomic<uint32_t> refs{1};
+
+        void release() noexcept {
+            if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                delete this;
+            }
+        }
+    };
+
+    struct Node {
+        uint64_t deadline = 0;
+        uint64_t interval = 0;
+        InlineJob once;                // One-shot job, or empty
+        Periodic* periodic = nullptr;  // Periodic callback, or null
+        uint32_t prev = kNil;
+        uint32_t next = kNil;          // Also the free-list link
+        uint32_t generation = 0;       // Odd while live
+        uint16_t list = kNoList;
+    };
+
+    [[nodiscard]] uint32_t allocate();
+    void release(uint32_t index);
+
+    void file(uint32_t index);  // Link into the slot for its deadline
+    void link(uint16_t list, uint32_t index) noexcept;
+    void unlink(uint32_t index) noexcept;
+
+    uint32_t detach(uint16_t list) noexcept;  // Empty @p list, return its old head
+    void expire(uint32_t index, std::vector<InlineJob>& out);
+    [[nodiscard]] uint64_t nextStop() const noexcept;
+
+    [[nodiscard]] uint64_t makeId(uint32_t index) const noexcept;
+
+    std::vector<Node> nodes_;
+    uint32_t freeHead_ = kNil;
+    std::size_t live_ = 0;
+    uint64_t now_ = 0;
+
+    std::array<uint32_t, kLevels * kSlots + 1> heads_;  // Slot lists, then the due list
+    std::array<uint64_t, kSlots / 64> occupied_{};      // Level-0 slots in use
+};
+
+}  // namespace cgs::foundation::detail
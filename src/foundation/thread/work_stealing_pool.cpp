@@ -0,0 +1,394 @@
+/// @file work_stealing_pool.cpp
+/// @brief WorkStealingPool: slot array, Chase-Lev deques and workers.
+
+#include "work_stealing_pool.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace cgs::foundation::detail {
+
+namespace {
+
+constexpr uint32_t kGenerationMask = 0x7FFFFFFFu;  // Generation bits of a job id
+constexpr int kSpinsBeforePark = 64;
+
+// The pool and worker index of the calling thread, if it is a worker.
+thread_local const WorkStealingPool* tlsPool = nullptr;
+thread_local std::size_t tlsWorker = 0;
+
+}  // anonymous namespace
+
+// ── WorkDeque ───────────────────────────────────────────────────────────────
+
+WorkDeque::WorkDeque(std::size_t capacity)
+    : mask_(static_cast<int64_t>(std::bit_ceil(std::max<std::size_t>(capacity, 2))) - 1),
+      buffer_(std::make_unique<std::atomic<uint32_t>[]>(static_cast<std::size_t>(mask_) + 1)) {}
+
+bool WorkDeque::push(uint32_t value) noexcept {
+    const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    const int64_t top = top_.load(std::memory_order_acquire);
+    if (bottom - top > mask_) {
+        return false;
+    }
+    buffer_[static_cast<std::size_t>(bottom & mask_)].store(value, std::memory_order_relaxed);
+    bottom_.store(bottom + 1, std::memory_order_release);
+    return true;
+}
+
+bool WorkDeque::pop(uint32_t& out) noexcept {
+    const int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    bottom_.store(bottom, std::memory_order_seq_cst);
+    int64_t top = top_.load(std::memory_order_seq_cst);
+    if (top > bottom) {
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+        return false;
+    }
+    out = buffer_[static_cast<std::size_t>(bottom & mask_)].load(std::memory_order_relaxed);
+    if (top == bottom) {
+        // Last element: race the stealers for it.
+        const bool won = top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                      std::memory_order_relaxed);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+        return won;
+    }
+    return true;
+}
+
+bool WorkDeque::steal(uint32_t& out) noexcept {
+    int64_t top = top_.load(std::memory_order_seq_cst);
+    const int64_t bottom = bottom_.load(std::memory_order_seq_cst);
+    if (top >= bottom) {
+        return false;
+    }
+    const uint32_t value =
+        buffer_[static_cast<std::size_t>(top & mask_)].load(std::memory_order_relaxed);
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+        return false;
+    }
+    out = value;
+    return true;
+}
+
+// ── InjectionQueue ──────────────────────────────────────────────────────────
+
+InjectionQueue::InjectionQueue(std::size_t capacity)
+    : mask_(std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1),
+      cells_(std::make_unique<Cell[]>(mask_ + 1)) {
+    for (std::size_t i = 0; i <= mask_; ++i) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool InjectionQueue::push(uint32_t value) noexcept {
+    std::size_t pos = tail_.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell& cell = cells_[pos & mask_];
+        const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (sequence == pos) {
+            if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                cell.value = value;
+                cell.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (sequence < pos) {
+            return false;
+        } else {
+            pos = tail_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool InjectionQueue::pop(uint32_t& out) noexcept {
+    std::size_t pos = head_.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell& cell = cells_[pos & mask_];
+        const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (sequence == pos + 1) {
+            if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                out = cell.value;
+                cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (sequence < pos + 1) {
+            return false;
+        } else {
+            pos = head_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+// ── WorkStealingPool ────────────────────────────────────────────────────────
+
+WorkStealingPool::WorkStealingPool(std::size_t workers, const CpuSet& affinity)
+    : workers_(workers), started_(static_cast<std::ptrdiff_t>(workers)), injection_(64 * 1024) {
+    threads_.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i) {
+        threads_.emplace_back([this, i, affinity] {
+            // Pin first: the deque is first touched, and so placed, here.
+            (void)pinPoolThread(affinity, i);
+            workers_[i] = std::make_unique<Worker>(kDequeCapacity);
+            started_.arrive_and_wait();  // Nobody steals from a missing deque
+            run(i);
+        });
+    }
+    started_.wait();
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    stopping_.store(true);
+    epoch_.fetch_add(1);
+    epoch_.notify_all();
+    for (auto& thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+WorkStealingPool::Slot* WorkStealingPool::slot(uint32_t index) const noexcept {
+    Slot* chunk = chunks_[index / kChunkSize].load(std::memory_order_acquire);
+    return chunk == nullptr ? nullptr : chunk + index % kChunkSize;
+}
+
+std::optional<uint32_t> WorkStealingPool::allocateSlot() {
+    uint64_t head = freeHead_.load(std::memory_order_acquire);
+    while (static_cast<uint32_t>(head) != 0) {
+        const uint32_t index = static_cast<uint32_t>(head) - 1;
+        const uint64_t next = slot(index)->nextFree.load(std::memory_order_relaxed);
+        const uint64_t desired = (((head >> 32) + 1) << 32) | next;
+        if (freeHead_.compare_exchange_weak(head, desired, std::memory_order_acquire,
+                                            std::memory_order_acquire)) {
+            return index;
+        }
+    }
+
+    // Free list empty: take a fresh slot, adding a chunk if needed.
+    const uint32_t index = slotCount_.fetch_add(1, std::memory_order_relaxed);
+    if (index >= kChunkSize * kMaxChunks) {
+        slotCount_.fetch_sub(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+    auto& chunk = chunks_[index / kChunkSize];
+    if (chunk.load(std::memory_order_acquire) == nullptr) {
+        std::lock_guard lock(growMutex_);
+        if (chunk.load(std::memory_order_relaxed) == nullptr) {
+            chunkStorage_.push_back(std::make_unique<Slot[]>(kChunkSize));
+            chunk.store(chunkStorage_.back().get(), std::memory_order_release);
+        }
+    }
+    return index;
+}
+
+void WorkStealingPool::freeSlot(uint32_t index) noexcept {
+    Slot* freed = slot(index);
+    uint64_t head = freeHead_.load(std::memory_order_relaxed);
+    uint64_t desired = 0;
+    do {
+        freed->nextFree.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+        desired = (((head >> 32) + 1) << 32) | (uint64_t{index} + 1);
+    } while (!freeHead_.compare_exchange_weak(head, desired, std::memory_order_release,
+                                              std::memory_order_relaxed));
+}
+
+std::optional<uint64_t> WorkStealingPool::submit(InlineJob&& job) {
+    if (workers_.empty()) {
+        return std::nullopt;
+    }
+    const bool heap = !job.isInline();
+    const auto index = allocateSlot();
+    if (!index) {
+        return std::nullopt;
+    }
+    Slot& target = *slot(*index);
+    target.job = std::move(job);
+    target.cancelled.store(false, std::memory_order_relaxed);
+    const uint32_t generation = target.generation.load(std::memory_order_relaxed) + 1;  // Odd
+    target.generation.store(generation, std::memory_order_release);
+
+    submitted_.fetch_add(1, std::memory_order_relaxed);
+    if (heap) {
+        heapJobs_.fetch_add(1, std::memory_order_relaxed);
+    }
+    const uint64_t id = kIdTag | (uint64_t{generation & kGenerationMask} << 32) | *index;
+    enqueue(*index);
+    return id;
+}
+
+void WorkStealingPool::enqueue(uint32_t index) {
+    if (tlsPool != this || !workers_[tlsWorker]->deque.push(index)) {
+        while (!injection_.push(index)) {
+            std::this_thread::yield();  // Workers are far behind; wait for room
+        }
+    }
+    epoch_.fetch_add(1);
+    if (sleepers_.load() != 0) {
+        epoch_.notify_one();
+    }
+}
+
+WorkStealingPool::Status WorkStealingPool::status(uint64_t id) const noexcept {
+    const auto index = static_cast<uint32_t>(id);
+    const auto generation = static_cast<uint32_t>(id >> 32) & kGenerationMask;
+    if (!ownsId(id) || (generation & 1u) == 0 ||
+        index >= slotCount_.load(std::memory_order_acquire)) {
+        return Status::Unknown;
+    }
+    const Slot* target = slot(index);
+    if (target == nullptr) {
+        return Status::Unknown;
+    }
+    const uint32_t current = target->generation.load(std::memory_order_acquire) & kGenerationMask;
+    if (current == generation) {
+        return Status::Pending;
+    }
+    return current > generation ? Status::Done : Status::Unknown;
+}
+
+bool WorkStealingPool::wait(uint64_t id) {
+    const Status initial = status(id);
+    if (initial != Status::Pending) {
+        return initial == Status::Done;
+    }
+    Slot& target = *slot(static_cast<uint32_t>(id));
+    const auto generation = static_cast<uint32_t>(id >> 32) & kGenerationMask;
+
+    helpUntil(
+        [&] {
+            return (target.generation.load(std::memory_order_acquire) & kGenerationMask) !=
+                   generation;
+        },
+        [&] {
+            const uint32_t current = target.generation.load(std::memory_order_acquire);
+            if ((current & kGenerationMask) == generation) {
+                target.generation.wait(current, std::memory_order_acquire);
+            }
+        });
+    return true;
+}
+
+void WorkStealingPool::waitFor(const std::atomic<std::size_t>& remaining) {
+    helpUntil([&] { return remaining.load(std::memory_order_acquire) == 0; },
+              [&] {
+                  const std::size_t current = remaining.load(std::memory_order_acquire);
+                  if (current != 0) {
+                      remaining.wait(current, std::memory_order_acquire);
+                  }
+              });
+}
+
+template <typename Done, typename Park>
+void WorkStealingPool::helpUntil(Done done, Park park) {
+    const bool worker = tlsPool == this;
+    int idle = 0;
+    while (!done()) {
+        uint32_t index = 0;
+        if (findWork(worker ? tlsWorker : 0, index)) {
+            execute(index);
+            idle = 0;
+        } else if (worker || ++idle < kSpinsBeforePark) {
+            std::this_thread::yield();
+        } else {
+            park();
+            idle = 0;
+        }
+    }
+}
+
+WorkStealingPool::Status WorkStealingPool::cancel(uint64_t id) noexcept {
+    const Status current = status(id);
+    if (current == Status::Pending) {
+        slot(static_cast<uint32_t>(id))->cancelled.store(true, std::memory_order_release);
+    }
+    return current;
+}
+
+bool WorkStealingPool::findWork(std::size_t self, uint32_t& out) {
+    if (tlsPool == this && workers_[self]->deque.pop(out)) {
+        return true;
+    }
+    if (injection_.pop(out)) {
+        return true;
+    }
+    const std::size_t count = workers_.size();
+    for (std::size_t i = 1; i <= count; ++i) {
+        const std::size_t victim = (self + i) % count;
+        if (workers_[victim]->deque.steal(out)) {
+            if (victim != self) {
+                stolen_.fetch_add(1, std::memory_order_relaxed);
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::execute(uint32_t index) {
+    Slot& target = *slot(index);
+    if (target.cancelled.load(std::memory_order_acquire)) {
+        cancelled_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        try {
+            target.job();
+        } catch (...) {
+            failed_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    target.job.reset();
+    executed_.fetch_add(1, std::memory_order_relaxed);
+
+    target.generation.fetch_add(1, std::memory_order_release);  // Even: finished
+    target.generation.notify_all();
+    freeSlot(index);
+}
+
+void WorkStealingPool::run(std::size_t self) {
+    tlsPool = this;
+    tlsWorker = self;
+    int idle = 0;
+    for (;;) {
+        uint32_t index = 0;
+        if (findWork(self, index)) {
+            execute(index);
+            idle = 0;
+            continue;
+        }
+        if (stopping_.load()) {
+            return;  // Queues drained
+        }
+        if (++idle < kSpinsBeforePark) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // Park until the next enqueue; recheck after announcing ourselves
+        // so an enqueue racing with this cannot be missed.
+        sleepers_.fetch_add(1);
+        const uint32_t seen = epoch_.load();
+        if (findWork(self, index)) {
+            sleepers_.fetch_sub(1);
+            execute(index);
+            idle = 0;
+            continue;
+        }
+        if (!stopping_.load()) {
+            epoch_.wait(seen);
+        }
+        sleepers_.fetch_sub(1);
+        idle = 0;
+    }
+}
+
+JobSchedulerStats WorkStealingPool::stats() const noexcept {
+    JobSchedulerStats stats;
+    stats.submitted = submitted_.load(std::memory_order_relaxed);
+    stats.executed = executed_.load(std::memory_order_relaxed);
+    stats.stolen = stolen_.load(std::memory_order_relaxed);
+    stats.cancelled = cancelled_.load(std::memory_order_relaxed);
+    stats.failed = failed_.load(std::memory_order_relaxed);
+    stats.heapJobs = heapJobs_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+}  // namespace cgs::foundation::detail
@@ -0,0 +1,170 @@
+#pragma once
+
+/// @file work_stealing_pool.hpp
+/// @brief Native worker pool behind GameJobScheduler::submit().
+///
+/// Jobs live in a generation-indexed slot array; queues carry 32-bit slot
+/// indices only.  Each worker owns a Chase-Lev deque (push/pop at the
+/// bottom, steals at the top); submissions from other threads go through
+/// a bounded multi-producer injection ring.  Idle workers park on a
+/// futex-backed epoch counter.  Internal to the Thread Adapter
+/// (SDS-MOD-002).
+
+#include "cgs/foundation/cpu_affinity.hpp"
+#include "cgs/foundation/job_scheduler.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace cgs::foundation::detail {
+
+/// Chase-Lev work-stealing deque of slot indices (fixed capacity).
+class WorkDeque {
+public:
+    explicit WorkDeque(std::size_t capacity);
+
+    /// Owner: push at the bottom.  @return false if full.
+    bool push(uint32_t value) noexcept;
+
+    /// Owner: pop the newest value.
+    bool pop(uint32_t& out) noexcept;
+
+    /// Any thread: take the oldest value.
+    bool steal(uint32_t& out) noexcept;
+
+private:
+    alignas(64) std::atomic<int64_t> top_{0};
+    alignas(64) std::atomic<int64_t> bottom_{0};
+    int64_t mask_;
+    std::unique_ptr<std::atomic<uint32_t>[]> buffer_;
+};
+
+/// Bounded multi-producer/multi-consumer ring of slot indices.
+class InjectionQueue {
+public:
+    explicit InjectionQueue(std::size_t capacity);
+
+    bool push(uint32_t value) noexcept;
+    bool pop(uint32_t& out) noexcept;
+
+private:
+    struct alignas(64) Cell {
+        std::atomic<std::size_t> sequence{0};
+        uint32_t value = 0;
+    };
+
+    std::size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+    alignas(64) std::atomic<std::size_t> tail_{0};
+    alignas(64) std::atomic<std::size_t> head_{0};
+};
+
+/// The pool.  Job ids are (generation << 32 | slot index) with bit 63
+/// set; a slot's generation is odd while a job occupies it and even once
+/// it finished, so an id is pending exactly while its generation is
+/// current.
+class WorkStealingPool {
+public:
+    /// Bit marking ids issued by this pool (kcenon-path ids are counters).
+    static constexpr uint64_t kIdTag = uint64_t{1} << 63;
+
+    static constexpr std::size_t kChunkSize = 1024;
+    static constexpr std::size_t kMaxChunks = 1024;  // ~1M concurrent jobs
+    static constexpr std::size_t kDequeCapacity = 4096;
+
+    enum class Status { Pending, Done, Unknown };
+
+    /// Start @p workers threads.  With a non-empty @p affinity, worker i
+    /// is pinned to CPU affinity[i % size] before it allocates its deque,
+    /// so the deque is local to that CPU's NUMA node.
+    explicit WorkStealingPool(std::size_t workers, const CpuSet& affinity = {});
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    [[nodiscard]] static bool ownsId(uint64_t id) noexcept { return (id & kIdTag) != 0; }
+
+    /// Queue @p job.  @return its id, or nullopt if no slot is free (in
+    /// which case @p job is left untouched).
+    std::optional<uint64_t> submit(InlineJob&& job);
+
+    [[nodiscard]] Status status(uint64_t id) const noexcept;
+
+    /// Block until @p id finishes, running queued jobs meanwhile.
+    /// @return false if @p id is unknown.
+    bool wait(uint64_t id);
+
+    /// Run queued jobs on the calling thread until @p remaining is zero.
+    /// Whoever drops it to zero must notify_all() it.
+    void waitFor(const std::atomic<std::size_t>& remaining);
+
+    [[nodiscard]] std::size_t workerCount() const noexcept { return workers_.size(); }
+
+    /// Mark pending job @p id to be skipped.
+    [[nodiscard]] Status cancel(uint64_t id) noexcept;
+
+    [[nodiscard]] JobSchedulerStats stats() const noexcept;
+
+private:
+    struct alignas(64) Slot {
+        InlineJob job;
+        std::atomic<uint32_t> generation{0};
+        std::atomic<bool> cancelled{false};
+        std::atomic<uint32_t> nextFree{0};  // Free-list link (index + 1)
+    };
+
+    struct Worker {
+        explicit Worker(std::size_t capacity) : deque(capacity) {}
+        WorkDeque deque;
+    };
+
+    [[nodiscard]] Slot* slot(uint32_t index) const noexcept;
+    std::optional<uint32_t> allocateSlot();
+    void freeSlot(uint32_t index) noexcept;
+
+    void enqueue(uint32_t index);
+
+    /// Execute queued jobs until done(); park() blocks a non-worker
+    /// caller when there is nothing to run (workers keep polling so the
+    /// pool cannot deadlock on its own waits).
+    template <typename Done, typename Park>
+    void helpUntil(Done done, Park park);
+    bool findWork(std::size_t self, uint32_t& out);
+    void execute(uint32_t index);
+    void run(std::size_t self);
+
+    std::vector<std::unique_ptr<Worker>> workers_;  // Each allocated by its own thread
+    std::vector<std::thread> threads_;
+    std::latch started_;  // Every worker allocated; counted down once per thread
+    InjectionQueue injection_;
+
+    std::array<std::atomic<Slot*>, kMaxChunks> chunks_{};
+    std::vector<std::unique_ptr<Slot[]>> chunkStorage_;  // Guarded by growMutex_
+    std::mutex growMutex_;
+    std::atomic<uint32_t> slotCount_{0};
+    // Free-list head: slot index + 1 (0 = empty) in the low 32 bits, an
+    // ABA tag in the high 32.
+    std::atomic<uint64_t> freeHead_{0};
+
+    std::atomic<uint32_t> epoch_{0};  // Bumped on each enqueue; idle workers wait on it
+    std::atomic<uint32_t> sleepers_{0};
+    std::atomic<bool> stopping_{false};
+
+    std::atomic<uint64_t> submitted_{0};
+    std::atomic<uint64_t> executed_{0};
+    std::atomic<uint64_t> stolen_{0};
+    std::atomic<uint64_t> cancelled_{0};
+    std::atomic<uint64_t> failed_{0};
+    std::atomic<uint64_t> heapJobs_{0};
+};
+
+}  // namespace cgs::foundation::detail
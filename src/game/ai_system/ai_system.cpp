@@ -10,10 +10,47 @@
 
 #include "cgs/game/ai_system.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <span>
+#include <utility>
 #include <vector>
 
 namespace cgs::game {
 
+namespace {
+
+/// Golden-ratio step: consecutive ids get evenly spread LOD phases.
+constexpr double kLodPhaseStep = 0.6180339887498949;
+
+// Blackboard keys read by the built-in tasks, interned once.
+const BlackboardKey<Vector3> kMoveTargetKey("move_target");
+const BlackboardKey<cgs::ecs::Entity> kTargetKey("target");
+const BlackboardKey<std::vector<Vector3>> kWaypointsKey("waypoints");
+const BlackboardKey<std::size_t> kPatrolIndexKey("patrol_index");
+const BlackboardKey<uint64_t> kPathRequestKey("path_request");
+const BlackboardKey<Vector3> kPathGoalKey("path_goal");
+const BlackboardKey<std::vector<Vector3>> kPathKey("path");
+
+/// Run @p movement from @p from toward @p to.
+void steerToward(Movement& movement, const Vector3& from, const Vector3& to) {
+    movement.direction = (to - from).Normalized();
+    movement.state = MovementState::Running;
+}
+
+/// Drop the path state of a MoveTo task, cancelling its request.
+void clearPath(Blackboard& bb, PathfindingService* service) {
+    if (auto* request = bb.Get(kPathRequestKey); request && service) {
+        service->Cancel(PathRequestId{*request});
+    }
+    bb.Erase(kPathRequestKey);
+    bb.Erase(kPathGoalKey);
+    bb.Erase(kPathKey);
+}
+
+}  // namespace
+
 AISystem::AISystem(cgs::ecs::ComponentStorage<AIBrain>& brains,
                    cgs::ecs::ComponentStorage<Transform>& transforms,
                    cgs::ecs::ComponentStorage<Movement>& movements,
@@ -29,45 +66,169 @@ AISystem::AISystem(cgs::ecs::ComponentStorage<AIBrain>& brains,
 
 void AISystem::Execute(float deltaTime) {
     uint32_t updateCount = 0;
+    pending_.clear();
+
+    if (LodEnabled()) {
+        updateCount = gatherLod(deltaTime);
+    } else {
+        // Under SetUpdateSlices() only this run's share of the brains is
+        // visited; deltaTime is the time since that share last ran.
+        const auto slice = CurrentSlice();
+        for (std::size_t i = 0; i < brains_.Size(); ++i) {
+            auto entityId = brains_.EntityAt(i);
+            if (!slice.Contains(entityId)) {
+                continue;
+            }
+            cgs::ecs::Entity entity(entityId, 0);
+            if (enqueueIfDue(entity, brains_.Get(entity), deltaTime, defaultTickInterval_)) {
+                ++updateCount;
+            }
+        }
+        lastAwakeCount_ = static_cast<uint32_t>(brains_.Size());
+    }
 
-    for (std::size_t i = 0; i < brains_.Size(); ++i) {
-        auto entityId = brains_.EntityAt(i);
-        cgs::ecs::Entity entity(entityId, 0);
-        auto& brain = brains_.Get(entity);
+    // Drop compiled trees no brain refers to any more.
+    std::erase_if(compiled_, [](const auto& entry) {
+        return entry.second->Source().use_count() == 1;
+    });
 
-        // Skip dead AI entities.
-        if (brain.state == AIState::Dead) {
-            continue;
-        }
+    lastTickUpdateCount_ = updateCount;
+    tickPending();
+}
 
-        // Skip entities without a behavior tree.
-        if (!brain.behaviorTree) {
+bool AISystem::enqueueIfDue(cgs::ecs::Entity entity,
+                            AIBrain& brain,
+                            float deltaTime,
+                            float defaultInterval) {
+    // Skip dead AI entities.
+    if (brain.state == AIState::Dead) {
+        return false;
+    }
+
+    // Skip entities without a behavior tree.
+    if (!brain.compiledTree && !brain.behaviorTree) {
+        return false;
+    }
+
+    // Accumulate time.
+    brain.timeSinceLastTick += deltaTime;
+
+    // Determine effective tick interval.
+    float interval = brain.tickInterval > 0.0f ? brain.tickInterval : defaultInterval;
+
+    // Only tick when the interval has elapsed.
+    if (brain.timeSinceLastTick < interval) {
+        return false;
+    }
+
+    const CompiledBehaviorTree* tree =
+        brain.compiledTree ? brain.compiledTree.get() : compiledFor(brain.behaviorTree);
+    pending_.push_back({tree, entity, brain.timeSinceLastTick});
+    brain.timeSinceLastTick = 0.0f;
+    return true;
+}
+
+uint32_t AISystem::gatherLod(float deltaTime) {
+    const float maxDistance = lodPolicy_.bands.back().maxDistance;
+    const uint32_t previousFrame = lodFrame_;
+    ++lodFrame_;
+    awake_.clear();
+
+    // Nearest observer per agent, visiting only agents in range.
+    for (const auto& observer : lodObservers_) {
+        if (!observer.index) {
             continue;
         }
+        observer.index->ForEachInRadius(
+            observer.position, maxDistance, [&](cgs::ecs::Entity entity) {
+                if (!brains_.Has(entity) || !transforms_.Has(entity)) {
+                    return;
+                }
+                const auto diff = transforms_.Get(entity).position - observer.position;
+                const float distSq = diff.x * diff.x + diff.z * diff.z;
+                auto& brain = brains_.Get(entity);
+                if (brain.lodFrame == lodFrame_) {
+                    brain.lodDistanceSq = std::min(brain.lodDistanceSq, distSq);
+                    return;
+                }
+                awake_.push_back({entity, brain.lodFrame != previousFrame});
+                brain.lodFrame = lodFrame_;
+                brain.lodDistanceSq = distSq;
+            });
+    }
 
-        // Accumulate time.
-        brain.timeSinceLastTick += deltaTime;
+    uint32_t updateCount = 0;
+    for (const auto& [entity, woke] : awake_) {
+        auto& brain = brains_.Get(entity);
+        float interval = lodPolicy_.bands.back().tickInterval;
+        for (const auto& band : lodPolicy_.bands) {
+            if (brain.lodDistanceSq <= band.maxDistance * band.maxDistance) {
+                interval = band.tickInterval;
+                break;
+            }
+        }
+        if (woke) {
+            // Start at this agent's phase of its interval so agents
+            // entering a band together spread over its frames.
+            const float effective = brain.tickInterval > 0.0f ? brain.tickInterval : interval;
+            const double phase = static_cast<double>(entity.id()) * kLodPhaseStep;
+            brain.timeSinceLastTick = static_cast<float>(phase - std::floor(phase)) * effective;
+        }
+        if (enqueueIfDue(entity, brain, deltaTime, interval)) {
+            ++updateCount;
+        }
+    }
+    lastAwakeCount_ = static_cast<uint32_t>(awake_.size());
+    return updateCount;
+}
 
-        // Determine effective tick interval.
-        float interval = brain.tickInterval > 0.0f ? brain.tickInterval : defaultTickInterval_;
+void AISystem::tickPending() {
+    if (pending_.empty()) {
+        return;
+    }
 
-        // Only tick when the interval has elapsed.
-        if (brain.timeSinceLastTick < interval) {
-            continue;
+    // Group by tree; stable so each group keeps storage order.
+    std::stable_sort(pending_.begin(),
+                     pending_.end(),
+                     [](const PendingAgent& a, const PendingAgent& b) {
+                         return std::less<const CompiledBehaviorTree*>{}(a.tree, b.tree);
+                     });
+
+    agents_.clear();
+    agents_.reserve(pending_.size());
+    for (const auto& entry : pending_) {
+        auto& brain = brains_.Get(entry.entity);
+        if (brain.treeStateOwner != entry.tree ||
+            brain.treeState.size() != entry.tree->StateSize()) {
+            brain.treeState.clear();
+            brain.treeState.resize(entry.tree->StateSize());
+            brain.treeStateOwner = entry.tree;
         }
 
-        // Execute the behavior tree.
-        BTContext context;
-        context.entity = entity;
-        context.deltaTime = brain.timeSinceLastTick;
-        context.blackboard = &brain.blackboard;
+        BTAgent& agent = agents_.emplace_back();
+        agent.context.entity = entry.entity;
+        agent.context.deltaTime = entry.deltaTime;
+        agent.context.blackboard = &brain.blackboard;
+        agent.state = std::span<uint32_t>(brain.treeState.data(), brain.treeState.size());
+    }
 
-        brain.behaviorTree->Tick(context);
-        brain.timeSinceLastTick = 0.0f;
-        ++updateCount;
+    std::size_t begin = 0;
+    while (begin < pending_.size()) {
+        std::size_t end = begin + 1;
+        while (end < pending_.size() && pending_[end].tree == pending_[begin].tree) {
+            ++end;
+        }
+        pending_[begin].tree->TickBatch(std::span<BTAgent>(agents_).subspan(begin, end - begin));
+        begin = end;
     }
+}
 
-    lastTickUpdateCount_ = updateCount;
+const CompiledBehaviorTree* AISystem::compiledFor(const std::shared_ptr<BTNode>& root) {
+    auto& compiled = compiled_[root.get()];
+    if (!compiled) {
+        compiled = CompiledBehaviorTree::Compile(root);
+    }
+    return compiled.get();
 }
 
 cgs::ecs::SystemAccessInfo AISystem::GetAccessInfo() const {
@@ -82,33 +243,84 @@ cgs::ecs::SystemAccessInfo AISystem::GetAccessInfo() const {
 std::unique_ptr<BTNode> AISystem::CreateMoveToTask() {
     auto& transforms = transforms_;
     auto& movements = movements_;
+    auto& resolver = pathResolver_;
 
-    return std::make_unique<BTAction>([&transforms, &movements](BTContext& ctx) -> BTStatus {
-        auto* target = ctx.blackboard->Get<Vector3>("move_target");
-        if (!target) {
-            return BTStatus::Failure;
-        }
+    return std::make_unique<BTAction>(
+        [&transforms, &movements, &resolver](BTContext& ctx) -> BTStatus {
+            auto& bb = *ctx.blackboard;
+            auto* target = bb.Get(kMoveTargetKey);
+            if (!target) {
+                return BTStatus::Failure;
+            }
 
-        if (!transforms.Has(ctx.entity) || !movements.Has(ctx.entity)) {
-            return BTStatus::Failure;
-        }
+            if (!transforms.Has(ctx.entity) || !movements.Has(ctx.entity)) {
+                return BTStatus::Failure;
+            }
 
-        auto& transform = transforms.Get(ctx.entity);
-        auto& movement = movements.Get(ctx.entity);
+            auto& transform = transforms.Get(ctx.entity);
+            auto& movement = movements.Get(ctx.entity);
+            PathfindingService* service = resolver ? resolver(ctx.entity) : nullptr;
+            constexpr float kArrivalSq = kMoveToArrivalDistance * kMoveToArrivalDistance;
 
-        auto diff = *target - transform.position;
-        float distSq = diff.x * diff.x + diff.z * diff.z;
+            auto diff = *target - transform.position;
+            float distSq = diff.x * diff.x + diff.z * diff.z;
 
-        if (distSq <= kMoveToArrivalDistance * kMoveToArrivalDistance) {
-            movement.state = MovementState::Idle;
-            movement.direction = Vector3::Zero();
-            return BTStatus::Success;
-        }
+            if (distSq <= kArrivalSq) {
+                clearPath(bb, service);
+                movement.state = MovementState::Idle;
+                movement.direction = Vector3::Zero();
+                return BTStatus::Success;
+            }
 
-        movement.direction = diff.Normalized();
-        movement.state = MovementState::Running;
-        return BTStatus::Running;
-    });
+            if (!service) {
+                steerToward(movement, transform.position, *target);
+                return BTStatus::Running;
+            }
+
+            // Ask again when the target has moved away from the planned goal.
+            auto* goal = bb.Get(kPathGoalKey);
+            if (!goal || (*goal - *target).LengthSquared() > kArrivalSq) {
+                clearPath(bb, service);
+                bb.Set(kPathRequestKey, service->Request(transform.position, *target).value);
+                bb.Set(kPathGoalKey, *target);
+            }
+
+            if (auto* request = bb.Get(kPathRequestKey)) {
+                std::vector<Vector3> path;
+                switch (service->Poll(PathRequestId{*request}, path)) {
+                    case PathStatus::Pending:
+                        steerToward(movement, transform.position, *target);
+                        return BTStatus::Running;
+                    case PathStatus::Ready:
+                        bb.Erase(kPathRequestKey);
+                        bb.Set(kPathKey, std::move(path));
+                        break;
+                    case PathStatus::NotFound:
+                        clearPath(bb, service);
+                        movement.state = MovementState::Idle;
+                        movement.direction = Vector3::Zero();
+                        return BTStatus::Failure;
+                    case PathStatus::Unknown:
+                        // Lost (e.g. cancelled elsewhere): request again next tick.
+                        clearPath(bb, service);
+                        steerToward(movement, transform.position, *target);
+                        return BTStatus::Running;
+                }
+            }
+
+            // Follow the path, dropping waypoints as they are reached.
+            auto* path = bb.Get(kPathKey);
+            while (path && path->size() > 1) {
+                auto toWaypoint = path->front() - transform.position;
+                if (toWaypoint.x * toWaypoint.x + toWaypoint.z * toWaypoint.z > kArrivalSq) {
+                    break;
+                }
+                path->erase(path->begin());
+            }
+            const Vector3& next = (path && !path->empty()) ? path->front() : *target;
+            steerToward(movement, transform.position, next);
+            return BTStatus::Running;
+        });
 }
 
 std::unique_ptr<BTNode> AISystem::CreateAttackTask() {
@@ -116,7 +328,7 @@ std::unique_ptr<BTNode> AISystem::CreateAttackTask() {
     auto& stats = stats_;
 
     return std::make_unique<BTAction>([&transforms, &stats](BTContext& ctx) -> BTStatus {
-        auto* targetPtr = ctx.blackboard->Get<cgs::ecs::Entity>("target");
+        auto* targetPtr = ctx.blackboard->Get(kTargetKey);
         if (!targetPtr || !targetPtr->isValid()) {
             return BTStatus::Failure;
         }
@@ -153,12 +365,12 @@ std::unique_ptr<BTNode> AISystem::CreatePatrolTask() {
     auto& movements = movements_;
 
     return std::make_unique<BTAction>([&transforms, &movements](BTContext& ctx) -> BTStatus {
-        auto* waypoints = ctx.blackboard->Get<std::vector<Vector3>>("waypoints");
+        auto* waypoints = ctx.blackboard->Get(kWaypointsKey);
         if (!waypoints || waypoints->empty()) {
             return BTStatus::Failure;
         }
 
-        auto* indexPtr = ctx.blackboard->Get<std::size_t>("patrol_index");
+        auto* indexPtr = ctx.blackboard->Get(kPatrolIndexKey);
         std::size_t waypointIndex = indexPtr ? *indexPtr : 0;
 
         if (waypointIndex >= waypoints->size()) {
@@ -179,7 +391,7 @@ std::unique_ptr<BTNode> AISystem::CreatePatrolTask() {
         if (distSq <= kMoveToArrivalDistance * kMoveToArrivalDistance) {
             // Arrived at current waypoint, advance to next.
             waypointIndex = (waypointIndex + 1) % waypoints->size();
-            ctx.blackboard->Set<std::size_t>("patrol_index", waypointIndex);
+            ctx.blackboard->Set(kPatrolIndexKey, waypointIndex);
             return BTStatus::Running;
         }
 
@@ -246,6 +458,17 @@ std::unique_ptr<BTNode> AISystem::CreateIdleTask() {
     });
 }
 
+void AISystem::SetLodPolicy(AILodPolicy policy) {
+    std::sort(policy.bands.begin(), policy.bands.end(), [](const AILodBand& a, const AILodBand& b) {
+        return a.maxDistance < b.maxDistance;
+    });
+    lodPolicy_ = std::move(policy);
+}
+
+void AISystem::SetLodObservers(std::span<const AILodObserver> observers) {
+    lodObservers_.assign(observers.begin(), observers.end());
+}
+
 void AISystem::SetDefaultTickInterval(float interval) {
     if (interval > 0.0f) {
         defaultTickInterval_ = interval;
@@ -0,0 +1,207 @@
+/// @file compiled_behavior_tree.cpp
+/// @brief CompiledBehaviorTree flattening and tick loop.
+///
+/// Cursor slots hold the running child's node offset from the composite
+/// (0 = not started, which also means "first child"), so a zero-filled
+/// state range is a fully reset subtree.
+///
+/// @see SRS-GML-004.2, SRS-GML-004.3
+/// @see SDS-MOD-023
+
+#include "cgs/game/compiled_behavior_tree.hpp"
+
+#include <algorithm>
+
+namespace cgs::game {
+
+std::shared_ptr<const CompiledBehaviorTree> CompiledBehaviorTree::Compile(
+    std::shared_ptr<BTNode> root) {
+    if (!root) {
+        return nullptr;
+    }
+    std::shared_ptr<CompiledBehaviorTree> tree(new CompiledBehaviorTree());
+    tree->flatten(*root);
+    tree->root_ = std::move(root);
+    return tree;
+}
+
+void CompiledBehaviorTree::flatten(BTNode& node) {
+    const auto index = static_cast<uint32_t>(nodes_.size());
+    nodes_.emplace_back();
+
+    BTFlatNode flat;
+    flat.stateBegin = static_cast<uint32_t>(stateSize_);
+    const std::size_t childCount = node.ChildCount();
+    flat.param = static_cast<uint32_t>(childCount);
+
+    switch (node.Kind()) {
+        case BTNodeKind::Sequence:
+            flat.op = BTOpcode::Sequence;
+            ++stateSize_;
+            break;
+        case BTNodeKind::Selector:
+            flat.op = BTOpcode::Selector;
+            ++stateSize_;
+            break;
+        case BTNodeKind::Parallel:
+            flat.op = static_cast<BTParallel&>(node).GetPolicy() == BTParallelPolicy::RequireAll
+                          ? BTOpcode::ParallelAll
+                          : BTOpcode::ParallelOne;
+            break;
+        case BTNodeKind::Inverter:
+            flat.op = BTOpcode::Inverter;
+            break;
+        case BTNodeKind::Repeater:
+            flat.op = BTOpcode::Repeater;
+            flat.param = static_cast<BTRepeater&>(node).MaxRepeats();
+            ++stateSize_;
+            break;
+        case BTNodeKind::Condition:
+            flat.op = BTOpcode::Condition;
+            flat.param = static_cast<uint32_t>(predicates_.size());
+            predicates_.push_back(static_cast<BTCondition&>(node).GetPredicate());
+            break;
+        case BTNodeKind::Action:
+            flat.op = BTOpcode::Action;
+            flat.param = static_cast<uint32_t>(actions_.size());
+            actions_.push_back(static_cast<BTAction&>(node).GetAction());
+            break;
+        case BTNodeKind::Custom:
+            // Opaque: its children (if any) are its own business.
+            flat.op = BTOpcode::Custom;
+            flat.param = static_cast<uint32_t>(customNodes_.size());
+            customNodes_.push_back(&node);
+            break;
+    }
+
+    if (node.Kind() != BTNodeKind::Custom) {
+        for (std::size_t c = 0; c < childCount; ++c) {
+            flatten(*node.Child(c));
+        }
+    }
+
+    flat.end = static_cast<uint32_t>(nodes_.size());
+    flat.stateEnd = static_cast<uint32_t>(stateSize_);
+    nodes_[index] = flat;
+}
+
+BTStatus CompiledBehaviorTree::Tick(BTContext& context, std::span<uint32_t> state) const {
+    return tick(0, context, state);
+}
+
+void CompiledBehaviorTree::TickBatch(std::span<BTAgent> agents) const {
+    for (auto& agent : agents) {
+        agent.status = tick(0, agent.context, agent.state);
+    }
+}
+
+void CompiledBehaviorTree::Reset(std::span<uint32_t> state) const {
+    resetSubtree(0, state);
+}
+
+void CompiledBehaviorTree::resetSubtree(uint32_t index, std::span<uint32_t> state) const {
+    const BTFlatNode& node = nodes_[index];
+    std::fill(state.begin() + node.stateBegin, state.begin() + node.stateEnd, 0u);
+    for (uint32_t i = index; i < node.end; ++i) {
+        if (nodes_[i].op == BTOpcode::Custom) {
+            customNodes_[nodes_[i].param]->Reset();
+        }
+    }
+}
+
+BTStatus CompiledBehaviorTree::tick(uint32_t index,
+                                    BTContext& context,
+                                    std::span<uint32_t> state) const {
+    const BTFlatNode& node = nodes_[index];
+    switch (node.op) {
+        case BTOpcode::Condition:
+            return predicates_[node.param](context) ? BTStatus::Success : BTStatus::Failure;
+
+        case BTOpcode::Action:
+            return actions_[node.param](context);
+
+        case BTOpcode::Custom:
+            return customNodes_[node.param]->Tick(context);
+
+        case BTOpcode::Sequence:
+        case BTOpcode::Selector: {
+            // Sequence stops on Failure, Selector on Success.
+            const BTStatus stopOn =
+                node.op == BTOpcode::Sequence ? BTStatus::Failure : BTStatus::Success;
+            uint32_t& cursor = state[node.stateBegin];
+            uint32_t child = index + 1 + cursor;
+            while (child < node.end) {
+                const BTStatus status = tick(child, context, state);
+                if (status == BTStatus::Running) {
+                    cursor = child - index - 1;
+                    return BTStatus::Running;
+                }
+                if (status == stopOn) {
+                    cursor = 0;
+                    return stopOn;
+                }
+                child = nodes_[child].end;
+            }
+            cursor = 0;
+            return stopOn == BTStatus::Failure ? BTStatus::Success : BTStatus::Failure;
+        }
+
+        case BTOpcode::ParallelAll:
+        case BTOpcode::ParallelOne: {
+            uint32_t successCount = 0;
+            uint32_t failureCount = 0;
+            for (uint32_t child = index + 1; child < node.end; child = nodes_[child].end) {
+                const BTStatus status = tick(child, context, state);
+                if (status == BTStatus::Success) {
+                    ++successCount;
+                } else if (status == BTStatus::Failure) {
+                    ++failureCount;
+                }
+            }
+            if (node.op == BTOpcode::ParallelAll) {
+                if (successCount == node.param) {
+                    return BTStatus::Success;
+                }
+                if (failureCount > 0) {
+                    return BTStatus::Failure;
+                }
+            } else {
+                if (successCount > 0) {
+                    return BTStatus::Success;
+                }
+                if (failureCount == node.param) {
+                    return BTStatus::Failure;
+                }
+            }
+            return BTStatus::Running;
+        }
+
+        case BTOpcode::Inverter: {
+            const BTStatus status = tick(index + 1, context, state);
+            if (status == BTStatus::Success) {
+                return BTStatus::Failure;
+            }
+            if (status == BTStatus::Failure) {
+                return BTStatus::Success;
+            }
+            return BTStatus::Running;
+        }
+
+        case BTOpcode::Repeater: {
+            if (tick(index + 1, context, state) == BTStatus::Running) {
+                return BTStatus::Running;
+            }
+            resetSubtree(index + 1, state);
+            uint32_t& count = state[node.stateBegin];
+            ++count;
+            if (node.param > 0 && count >= node.param) {
+                count = 0;
+                return BTStatus::Success;
+            }
+            return BTStatus::Running;
+        }
+    }
+    return BTStatus::Failure;
+}
+
+}  // namespace cgs::game
@@ -0,0 +1,638 @@
+/// @file pathfinding.cpp
+/// @brief NavGrid, grid A* and PathfindingService.
+///
+/// One search routine serves every case: best-first over the grid with
+/// a pluggable heuristic (octile for A*, zero for the backward Dijkstra
+/// that answers a goal group) and an optional cluster corridor.  The
+/// cluster graph links two clusters when some legal step crosses from
+/// one into the other, so a route that exists on the grid always exists
+/// on the graph; a corridor search that still fails falls back to the
+/// full grid.
+///
+/// @see SRS-GML-004.3
+/// @see SDS-MOD-023
+
+#include "cgs/game/pathfinding.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <mutex>
+
+namespace cgs::game {
+
+namespace {
+
+constexpr uint32_t kStraightCost = 10;
+constexpr uint32_t kDiagonalCost = 14;
+constexpr uint32_t kNone = std::numeric_limits<uint32_t>::max();
+
+constexpr int32_t kStepX[8] = {1, -1, 0, 0, 1, 1, -1, -1};
+constexpr int32_t kStepY[8] = {0, 0, 1, -1, 1, -1, 1, -1};
+
+uint32_t octile(NavCell a, NavCell b) noexcept {
+    const auto dx = static_cast<uint32_t>(std::abs(a.x - b.x));
+    const auto dy = static_cast<uint32_t>(std::abs(a.y - b.y));
+    return kStraightCost * std::max(dx, dy) +
+           (kDiagonalCost - kStraightCost) * std::min(dx, dy);
+}
+
+/// True if a unit can step from @p from by direction @p dir: the target
+/// is walkable and a diagonal does not cut a blocked corner.
+bool canStep(const NavGrid& grid, NavCell from, int dir) noexcept {
+    const NavCell to{from.x + kStepX[dir], from.y + kStepY[dir]};
+    if (!grid.IsWalkable(to)) {
+        return false;
+    }
+    if (dir < 4) {
+        return true;
+    }
+    return grid.IsWalkable({to.x, from.y}) && grid.IsWalkable({from.x, to.y});
+}
+
+/// Cluster connectivity of a NavGrid: bit d of links[c] is set when a
+/// legal step leads from cluster c into its neighbor in direction d.
+struct ClusterGraph {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<uint8_t> links;
+
+    [[nodiscard]] uint32_t ClusterOf(NavCell cell) const noexcept {
+        return static_cast<uint32_t>(cell.y) / PathfindingService::kClusterSize * width +
+               static_cast<uint32_t>(cell.x) / PathfindingService::kClusterSize;
+    }
+};
+
+ClusterGraph buildClusters(const NavGrid& grid) {
+    constexpr uint32_t kSize = PathfindingService::kClusterSize;
+    ClusterGraph graph;
+    graph.width = (grid.Width() + kSize - 1) / kSize;
+    graph.height = (grid.Height() + kSize - 1) / kSize;
+    graph.links.assign(std::size_t{graph.width} * graph.height, 0);
+
+    for (uint32_t index = 0; index < grid.CellCount(); ++index) {
+        const NavCell cell = grid.CellAt(index);
+        if (!grid.IsWalkable(cell)) {
+            continue;
+        }
+        const uint32_t cluster = graph.ClusterOf(cell);
+        // Only border cells can step into another cluster.
+        const auto lx = static_cast<uint32_t>(cell.x) % kSize;
+        const auto ly = static_cast<uint32_t>(cell.y) % kSize;
+        if (lx != 0 && lx != kSize - 1 && ly != 0 && ly != kSize - 1) {
+            continue;
+        }
+        for (int dir = 0; dir < 8; ++dir) {
+            if (!canStep(grid, cell, dir)) {
+                continue;
+            }
+            const uint32_t other = graph.ClusterOf({cell.x + kStepX[dir], cell.y + kStepY[dir]});
+            if (other == cluster) {
+                continue;
+            }
+            const auto cx = static_cast<int32_t>(other % graph.width) -
+                            static_cast<int32_t>(cluster % graph.width);
+            const auto cy = static_cast<int32_t>(other / graph.width) -
+                            static_cast<int32_t>(cluster / graph.width);
+            for (int d = 0; d < 8; ++d) {
+                if (kStepX[d] == cx && kStepY[d] == cy) {
+                    graph.links[cluster] = static_cast<uint8_t>(graph.links[cluster] | (1u << d));
+                }
+            }
+        }
+    }
+    return graph;
+}
+
+/// Reusable best-first search state, reset in O(1) by stamping.
+struct SearchSpace {
+    std::vector<uint32_t> g;
+    std::vector<uint32_t> parent;
+    std::vector<uint32_t> stamp;
+    std::vector<uint8_t> closed;
+    std::vector<std::pair<uint32_t, uint32_t>> heap;  ///< (f, index) min-heap.
+    uint32_t current = 0;
+
+    void Begin(std::size_t cells) {
+        if (stamp.size() != cells) {
+            g.assign(cells, 0);
+            parent.assign(cells, kNone);
+            stamp.assign(cells, 0);
+            closed.assign(cells, 0);
+            current = 0;
+        }
+        if (++current == 0) {
+            std::fill(stamp.begin(), stamp.end(), 0u);
+            current = 1;
+        }
+        heap.clear();
+    }
+
+    [[nodiscard]] bool Seen(uint32_t index) const noexcept { return stamp[index] == current; }
+
+    void Push(uint32_t f, uint32_t index) {
+        heap.emplace_back(f, index);
+        std::push_heap(heap.begin(), heap.end(), std::greater<>{});
+    }
+
+    std::pair<uint32_t, uint32_t> Pop() {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<>{});
+        const auto top = heap.back();
+        heap.pop_back();
+        return top;
+    }
+};
+
+/// Best-first search from @p source.  @p heuristic(cell) must be
+/// consistent; @p allowed(cell) restricts expansion; @p settle(index)
+/// is called as each cell is closed and returns true to stop.
+template <typename Heuristic, typename Allowed, typename Settle>
+void bestFirst(const NavGrid& grid,
+               SearchSpace& space,
+               uint32_t source,
+               Heuristic&& heuristic,
+               Allowed&& allowed,
+               Settle&& settle) {
+    space.Begin(grid.CellCount());
+    space.stamp[source] = space.current;
+    space.g[source] = 0;
+    space.parent[source] = kNone;
+    space.closed[source] = 0;
+    space.Push(heuristic(grid.CellAt(source)), source);
+
+    while (!space.heap.empty()) {
+        const auto [f, index] = space.Pop();
+        if (space.closed[index] != 0) {
+            continue;
+        }
+        space.closed[index] = 1;
+        if (settle(index)) {
+            return;
+        }
+        const NavCell cell = grid.CellAt(index);
+        for (int dir = 0; dir < 8; ++dir) {
+            if (!canStep(grid, cell, dir)) {
+                continue;
+            }
+            const NavCell next{cell.x + kStepX[dir], cell.y + kStepY[dir]};
+            if (!allowed(next)) {
+                continue;
+            }
+            const uint32_t nextIndex = grid.IndexOf(next);
+            const uint32_t g = space.g[index] + (dir < 4 ? kStraightCost : kDiagonalCost);
+            if (space.Seen(nextIndex)) {
+                if (space.closed[nextIndex] != 0 || g >= space.g[nextIndex]) {
+                    continue;
+                }
+            } else {
+                space.stamp[nextIndex] = space.current;
+                space.closed[nextIndex] = 0;
+            }
+            space.g[nextIndex] = g;
+            space.parent[nextIndex] = index;
+            space.Push(g + heuristic(next), nextIndex);
+        }
+    }
+}
+
+/// Forward A* from @p start to @p goal, optionally restricted to the
+/// clusters flagged in @p corridor.  Fills @p out (after start, up to
+/// goal) and returns true on success.
+bool aStar(const NavGrid& grid,
+           SearchSpace& space,
+           uint32_t start,
+           uint32_t goal,
+           const ClusterGraph* clusters,
+           const std::vector<uint8_t>* corridor,
+           std::vector<uint32_t>& out) {
+    const NavCell goalCell = grid.CellAt(goal);
+    bool found = false;
+    bestFirst(
+        grid, space, start, [goalCell](NavCell c) { return octile(c, goalCell); },
+        [&](NavCell c) { return !corridor || (*corridor)[clusters->ClusterOf(c)] != 0; },
+        [&](uint32_t index) { return found = (index == goal); });
+    if (!found) {
+        return false;
+    }
+    out.clear();
+    for (uint32_t at = goal; at != start; at = space.parent[at]) {
+        out.push_back(at);
+    }
+    std::reverse(out.begin(), out.end());
+    return true;
+}
+
+/// A* over the cluster graph, then the corridor of its clusters plus
+/// one ring around them.  Returns false when the clusters do not connect.
+bool clusterCorridor(const ClusterGraph& graph,
+                     uint32_t startCluster,
+                     uint32_t goalCluster,
+                     std::vector<uint8_t>& corridor) {
+    const auto cellOf = [&graph](uint32_t c) {
+        return NavCell{static_cast<int32_t>(c % graph.width), static_cast<int32_t>(c / graph.width)};
+    };
+    const std::size_t count = graph.links.size();
+    std::vector<uint32_t> g(count, kNone);
+    std::vector<uint32_t> parent(count, kNone);
+    std::vector<std::pair<uint32_t, uint32_t>> heap;
+    const NavCell goal = cellOf(goalCluster);
+    g[startCluster] = 0;
+    heap.emplace_back(octile(cellOf(startCluster), goal), startCluster);
+    bool found = false;
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<>{});
+        const auto [f, cluster] = heap.back();
+        heap.pop_back();
+        const NavCell at = cellOf(cluster);
+        if (f != g[cluster] + octile(at, goal)) {
+            continue;  // stale entry
+        }
+        if (cluster == goalCluster) {
+            found = true;
+            break;
+        }
+        for (int dir = 0; dir < 8; ++dir) {
+            if ((graph.links[cluster] & (1u << dir)) == 0) {
+                continue;
+            }
+            const NavCell next{at.x + kStepX[dir], at.y + kStepY[dir]};
+            const uint32_t nextIndex = static_cast<uint32_t>(next.y) * graph.width +
+                                       static_cast<uint32_t>(next.x);
+            const uint32_t cost = g[cluster] + (dir < 4 ? kStraightCost : kDiagonalCost);
+            if (cost < g[nextIndex]) {
+                g[nextIndex] = cost;
+                parent[nextIndex] = cluster;
+                heap.emplace_back(cost + octile(next, goal), nextIndex);
+                std::push_heap(heap.begin(), heap.end(), std::greater<>{});
+            }
+        }
+    }
+    if (!found) {
+        return false;
+    }
+
+    corridor.assign(count, 0);
+    for (uint32_t c = goalCluster; c != kNone; c = parent[c]) {
+        const NavCell at = cellOf(c);
+        for (int32_t dy = -1; dy <= 1; ++dy) {
+            for (int32_t dx = -1; dx <= 1; ++dx) {
+                const NavCell n{at.x + dx, at.y + dy};
+                if (n.x >= 0 && n.y >= 0 && static_cast<uint32_t>(n.x) < graph.width &&
+                    static_cast<uint32_t>(n.y) < graph.height) {
+                    corridor[static_cast<uint32_t>(n.y) * graph.width +
+                             static_cast<uint32_t>(n.x)] = 1;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+// ── NavGrid ─────────────────────────────────────────────────────────────────
+
+NavGrid::NavGrid(uint32_t width, uint32_t height, float cellSize, Vector3 origin)
+    : width_(std::max(width, 1u)),
+      height_(std::max(height, 1u)),
+      cellSize_(cellSize > 0.0f ? cellSize : 1.0f),
+      origin_(origin),
+      walkable_(std::size_t{width_} * height_, 1) {}
+
+void NavGrid::SetWalkable(NavCell cell, bool walkable) {
+    if (Contains(cell)) {
+        walkable_[IndexOf(cell)] = walkable ? 1 : 0;
+    }
+}
+
+void NavGrid::SetWalkable(NavCell min, NavCell max, bool walkable) {
+    for (int32_t y = std::max(min.y, 0); y <= max.y && static_cast<uint32_t>(y) < height_; ++y) {
+        for (int32_t x = std::max(min.x, 0); x <= max.x && static_cast<uint32_t>(x) < width_;
+             ++x) {
+            walkable_[IndexOf({x, y})] = walkable ? 1 : 0;
+        }
+    }
+}
+
+NavCell NavGrid::CellOf(const Vector3& position) const noexcept {
+    return {static_cast<int32_t>(std::floor((position.x - origin_.x) / cellSize_)),
+            static_cast<int32_t>(std::floor((position.z - origin_.z) / cellSize_))};
+}
+
+Vector3 NavGrid::CenterOf(NavCell cell) const noexcept {
+    return {origin_.x + (static_cast<float>(cell.x) + 0.5f) * cellSize_,
+            origin_.y,
+            origin_.z + (static_cast<float>(cell.y) + 0.5f) * cellSize_};
+}
+
+bool FindGridPath(const NavGrid& grid, NavCell start, NavCell goal, std::vector<NavCell>& out) {
+    if (!grid.IsWalkable(start) || !grid.IsWalkable(goal)) {
+        return false;
+    }
+    SearchSpace space;
+    std::vector<uint32_t> cells;
+    if (!aStar(grid, space, grid.IndexOf(start), grid.IndexOf(goal), nullptr, nullptr, cells)) {
+        return false;
+    }
+    out.clear();
+    for (const uint32_t index : cells) {
+        out.push_back(grid.CellAt(index));
+    }
+    return true;
+}
+
+// ── PathfindingService ──────────────────────────────────────────────────────
+
+struct PathfindingService::Snapshot {
+    explicit Snapshot(NavGrid g) : grid(std::move(g)), clusters(buildClusters(grid)) {}
+
+    NavGrid grid;
+    ClusterGraph clusters;
+};
+
+struct PathfindingService::Batch {
+    /// Requests sharing a goal cell; starts are distinct.
+    struct Group {
+        uint32_t goal = 0;
+        std::vector<uint32_t> starts;
+    };
+
+    struct Result {
+        uint64_t key = 0;
+        CachedPath path;
+    };
+
+    std::shared_ptr<const Snapshot> snapshot;
+    std::vector<Group> groups;
+    std::vector<Result> results;
+
+    void Run(SearchSpace& space) {
+        for (const auto& group : groups) {
+            if (group.starts.size() == 1) {
+                runSingle(space, group.starts.front(), group.goal);
+            } else {
+                runGroup(space, group);
+            }
+        }
+    }
+
+private:
+    void runSingle(SearchSpace& space, uint32_t start, uint32_t goal) {
+        const NavGrid& grid = snapshot->grid;
+        Result& result = results.emplace_back();
+        result.key = cacheKey(start, goal);
+
+        const ClusterGraph& clusters = snapshot->clusters;
+        if (octile(grid.CellAt(start), grid.CellAt(goal)) >
+            kHierarchicalDistance * kStraightCost) {
+            std::vector<uint8_t> corridor;
+            if (!clusterCorridor(clusters, clusters.ClusterOf(grid.CellAt(start)),
+                                 clusters.ClusterOf(grid.CellAt(goal)), corridor)) {
+                return;  // the clusters do not even connect
+            }
+            if (aStar(grid, space, start, goal, &clusters, &corridor, result.path.cells)) {
+                result.path.found = true;
+                return;
+            }
+        }
+        result.path.found = aStar(grid, space, start, goal, nullptr, nullptr, result.path.cells);
+    }
+
+    /// Backward Dijkstra from the goal until every start is settled;
+    /// parents then point along each start's path to the goal.
+    void runGroup(SearchSpace& space, const Group& group) {
+        const NavGrid& grid = snapshot->grid;
+        std::size_t remaining = group.starts.size();
+        std::vector<uint32_t> sorted = group.starts;
+        std::sort(sorted.begin(), sorted.end());
+        bestFirst(
+            grid, space, group.goal, [](NavCell) { return 0u; }, [](NavCell) { return true; },
+            [&](uint32_t index) {
+                if (std::binary_search(sorted.begin(), sorted.end(), index)) {
+                    --remaining;
+                }
+                return remaining == 0;
+            });
+        for (const uint32_t start : group.starts) {
+            Result& result = results.emplace_back();
+            result.key = cacheKey(start, group.goal);
+            if (!space.Seen(start) || space.closed[start] == 0) {
+                continue;
+            }
+            result.path.found = true;
+            for (uint32_t at = space.parent[start]; at != kNone; at = space.parent[at]) {
+                result.path.cells.push_back(at);
+            }
+        }
+    }
+};
+
+struct PathfindingService::Shared {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<Batch>> done;
+    std::vector<std::unique_ptr<SearchSpace>> spaces;
+
+    void Run(const std::shared_ptr<Batch>& batch) {
+        std::unique_ptr<SearchSpace> space;
+        {
+            std::lock_guard lock(mutex);
+            if (!spaces.empty()) {
+                space = std::move(spaces.back());
+                spaces.pop_back();
+            }
+        }
+        if (!space) {
+            space = std::make_unique<SearchSpace>();
+        }
+        batch->Run(*space);
+        std::lock_guard lock(mutex);
+        spaces.push_back(std::move(space));
+        done.push_back(batch);
+    }
+};
+
+PathfindingService::PathfindingService(NavGrid grid, std::size_t cacheCapacity)
+    : snapshot_(std::make_shared<const Snapshot>(std::move(grid))),
+      shared_(std::make_shared<Shared>()),
+      cacheCapacity_(cacheCapacity) {}
+
+PathfindingService::~PathfindingService() = default;
+
+void PathfindingService::SetGrid(NavGrid grid) {
+    snapshot_ = std::make_shared<const Snapshot>(std::move(grid));
+    cache_.clear();
+    cacheOrder_.clear();
+    cacheHead_ = 0;
+    // Searches in flight use the old grid; ask again.
+    for (auto& [key, ids] : waiting_) {
+        queued_.insert(queued_.end(), ids.begin(), ids.end());
+    }
+    waiting_.clear();
+}
+
+const NavGrid& PathfindingService::Grid() const noexcept {
+    return snapshot_->grid;
+}
+
+PathRequestId PathfindingService::Request(const Vector3& from, const Vector3& to) {
+    const uint64_t id = nextId_++;
+    Entry& entry = requests_[id];
+    entry.origin = from;
+    entry.destination = to;
+    queued_.push_back(id);
+    return PathRequestId{id};
+}
+
+void PathfindingService::Cancel(PathRequestId id) {
+    requests_.erase(id.value);
+}
+
+void PathfindingService::Update() {
+    collect();
+    dispatch();
+}
+
+PathStatus PathfindingService::Poll(PathRequestId id, std::vector<Vector3>& out) {
+    auto it = requests_.find(id.value);
+    if (it == requests_.end()) {
+        return PathStatus::Unknown;
+    }
+    const PathStatus status = it->second.status;
+    if (status == PathStatus::Ready) {
+        out = std::move(it->second.path);
+    }
+    if (status != PathStatus::Pending) {
+        requests_.erase(it);
+    }
+    return status;
+}
+
+void PathfindingService::complete(Entry& entry, uint32_t start, const CachedPath& result) const {
+    if (!result.found) {
+        entry.status = PathStatus::NotFound;
+        return;
+    }
+    // Keep the cells where the direction changes, then the destination.
+    const NavGrid& grid = snapshot_->grid;
+    entry.path.clear();
+    NavCell previous = grid.CellAt(start);
+    for (std::size_t i = 0; i + 1 < result.cells.size(); ++i) {
+        const NavCell cell = grid.CellAt(result.cells[i]);
+        const NavCell next = grid.CellAt(result.cells[i + 1]);
+        if (next.x - cell.x != cell.x - previous.x || next.y - cell.y != cell.y - previous.y) {
+            entry.path.push_back(grid.CenterOf(cell));
+        }
+        previous = cell;
+    }
+    entry.path.push_back(entry.destination);
+    entry.status = PathStatus::Ready;
+}
+
+void PathfindingService::insertCache(uint64_t key, CachedPath result) {
+    if (cacheCapacity_ == 0) {
+        return;
+    }
+    auto [it, inserted] = cache_.try_emplace(key, std::move(result));
+    if (!inserted) {
+        return;
+    }
+    if (cacheOrder_.size() < cacheCapacity_) {
+        cacheOrder_.push_back(key);
+        return;
+    }
+    // Full: evict the oldest entry in its ring slot.
+    cache_.erase(cacheOrder_[cacheHead_]);
+    cacheOrder_[cacheHead_] = key;
+    cacheHead_ = (cacheHead_ + 1) % cacheCapacity_;
+}
+
+void PathfindingService::collect() {
+    std::vector<std::shared_ptr<Batch>> done;
+    {
+        std::lock_guard lock(shared_->mutex);
+        done.swap(shared_->done);
+    }
+    for (const auto& batch : done) {
+        if (batch->snapshot != snapshot_) {
+            continue;  // searched on a replaced grid
+        }
+        for (auto& result : batch->results) {
+            auto waiting = waiting_.find(result.key);
+            if (waiting != waiting_.end()) {
+                const auto start = static_cast<uint32_t>(result.key >> 32);
+                for (const uint64_t id : waiting->second) {
+                    auto it = requests_.find(id);
+                    if (it != requests_.end()) {
+                        complete(it->second, start, result.path);
+                    }
+                }
+                waiting_.erase(waiting);
+            }
+            insertCache(result.key, std::move(result.path));
+        }
+    }
+}
+
+void PathfindingService::dispatch() {
+    if (queued_.empty()) {
+        return;
+    }
+    const NavGrid& grid = snapshot_->grid;
+    auto batch = std::make_shared<Batch>();
+    batch->snapshot = snapshot_;
+    std::unordered_map<uint32_t, std::size_t> groupOf;  // goal -> group
+
+    for (const uint64_t id : queued_) {
+        auto it = requests_.find(id);
+        if (it == requests_.end()) {
+            continue;  // cancelled
+        }
+        Entry& entry = it->second;
+        const NavCell startCell = grid.CellOf(entry.origin);
+        const NavCell goalCell = grid.CellOf(entry.destination);
+        if (!grid.IsWalkable(startCell) || !grid.IsWalkable(goalCell)) {
+            entry.status = PathStatus::NotFound;
+            continue;
+        }
+        const uint32_t start = grid.IndexOf(startCell);
+        const uint32_t goal = grid.IndexOf(goalCell);
+        if (start == goal) {
+            complete(entry, start, CachedPath{true, {}});
+            continue;
+        }
+
+        const uint64_t key = cacheKey(start, goal);
+        if (auto cached = cache_.find(key); cached != cache_.end()) {
+            ++cacheHits_;
+            complete(entry, start, cached->second);
+            continue;
+        }
+        auto [waiting, first] = waiting_.try_emplace(key);
+        waiting->second.push_back(id);
+        if (!first) {
+            ++coalesced_;  // same start and goal already being searched
+            continue;
+        }
+        auto [group, newGroup] = groupOf.try_emplace(goal, batch->groups.size());
+        if (newGroup) {
+            batch->groups.push_back({goal, {}});
+            ++searches_;
+        } else {
+            ++coalesced_;  // shares the goal group's backward search
+        }
+        batch->groups[group->second].starts.push_back(start);
+    }
+    queued_.clear();
+
+    if (batch->groups.empty()) {
+        return;
+    }
+    if (submitter_) {
+        submitter_([shared = shared_, batch] { shared->Run(batch); });
+    } else {
+        shared_->Run(batch);
+    }
+}
+
+}  // namespace cgs::game
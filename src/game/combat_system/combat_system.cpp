@@ -2,10 +2,13 @@
 /// @brief CombatSystem implementation.
 ///
 /// Implements the three-phase combat tick:
-///   1. Spell cast timer updates
+///   1. Spell cast timer and ability cooldown updates
 ///   2. Aura duration/periodic tick processing
 ///   3. Damage event pipeline (base → crit → mitigation → final)
 ///
+/// Phases 1 and 2 either step every component or, in timer wheel mode,
+/// fire only the casts and auras due this tick.
+///
 /// @see SRS-GML-002.4
 /// @see SDS-MOD-021
 
@@ -13,9 +16,118 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define CGS_DAMAGE_BATCH_SSE2 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define CGS_DAMAGE_BATCH_NEON 1
+#endif
 
 namespace cgs::game {
 
+namespace {
+
+/// CalculateDamage() for row @p i of @p batch, term by term.
+[[nodiscard]] int32_t MitigateRow(const DamageBatch& batch, std::size_t i) noexcept {
+    if (batch.baseDamage[i] <= 0) {
+        return 0;
+    }
+    const float damage = static_cast<float>(batch.baseDamage[i]) * batch.critMultiplier[i];
+    const auto stat = static_cast<float>(std::max(batch.mitigationStat[i], 0));
+    const float mitigation = stat / (stat + batch.mitigationConstant[i]);
+    return std::max(static_cast<int32_t>(std::floor(damage * (1.0f - mitigation))), 1);
+}
+
+#if defined(CGS_DAMAGE_BATCH_SSE2)
+
+/// Rows [i, i + 4) of @p batch.  Damage is never negative, so truncation
+/// is the floor and max(d, 1) before it is max(floor(d), 1) after it.
+void MitigateRows4(DamageBatch& batch, std::size_t i) noexcept {
+    const __m128i base =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(batch.baseDamage.data() + i));
+    const __m128i rawStat =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(batch.mitigationStat.data() + i));
+    const __m128 damage = _mm_mul_ps(_mm_cvtepi32_ps(base), _mm_loadu_ps(&batch.critMultiplier[i]));
+    const __m128 stat = _mm_max_ps(_mm_cvtepi32_ps(rawStat), _mm_setzero_ps());
+    const __m128 mitigation =
+        _mm_div_ps(stat, _mm_add_ps(stat, _mm_loadu_ps(&batch.mitigationConstant[i])));
+    const __m128 mitigated = _mm_mul_ps(damage, _mm_sub_ps(_mm_set1_ps(1.0f), mitigation));
+    const __m128i result = _mm_cvttps_epi32(_mm_max_ps(mitigated, _mm_set1_ps(1.0f)));
+    const __m128i positive = _mm_cmpgt_epi32(base, _mm_setzero_si128());
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(batch.finalDamage.data() + i),
+                     _mm_and_si128(result, positive));
+}
+
+#elif defined(CGS_DAMAGE_BATCH_NEON)
+
+/// Rows [i, i + 4) of @p batch; see the SSE2 version.
+void MitigateRows4(DamageBatch& batch, std::size_t i) noexcept {
+    const int32x4_t base = vld1q_s32(batch.baseDamage.data() + i);
+    const float32x4_t damage = vmulq_f32(vcvtq_f32_s32(base), vld1q_f32(&batch.critMultiplier[i]));
+    const float32x4_t stat =
+        vmaxq_f32(vcvtq_f32_s32(vld1q_s32(batch.mitigationStat.data() + i)), vdupq_n_f32(0.0f));
+    const float32x4_t mitigation =
+        vdivq_f32(stat, vaddq_f32(stat, vld1q_f32(&batch.mitigationConstant[i])));
+    const float32x4_t mitigated = vmulq_f32(damage, vsubq_f32(vdupq_n_f32(1.0f), mitigation));
+    const int32x4_t result = vcvtq_s32_f32(vmaxq_f32(mitigated, vdupq_n_f32(1.0f)));
+    const uint32x4_t positive = vcgtq_s32(base, vdupq_n_s32(0));
+    vst1q_s32(batch.finalDamage.data() + i, vandq_s32(result, vreinterpretq_s32_u32(positive)));
+}
+
+#endif
+
+/// timers[i] = max(timers[i] - dt, 0) for the @p count timers, four at a
+/// time on SSE2/NEON targets.
+void DecrementTimers(float* timers, std::size_t count, float dt) noexcept {
+    std::size_t i = 0;
+#if defined(CGS_DAMAGE_BATCH_SSE2)
+    const __m128 step = _mm_set1_ps(dt);
+    for (; i < count / 4 * 4; i += 4) {
+        const __m128 left = _mm_sub_ps(_mm_loadu_ps(timers + i), step);
+        _mm_storeu_ps(timers + i, _mm_max_ps(left, _mm_setzero_ps()));
+    }
+#elif defined(CGS_DAMAGE_BATCH_NEON)
+    const float32x4_t step = vdupq_n_f32(dt);
+    for (; i < count / 4 * 4; i += 4) {
+        const float32x4_t left = vsubq_f32(vld1q_f32(timers + i), step);
+        vst1q_f32(timers + i, vmaxq_f32(left, vdupq_n_f32(0.0f)));
+    }
+#endif
+    for (; i < count; ++i) {
+        timers[i] = std::max(timers[i] - dt, 0.0f);
+    }
+}
+
+}  // namespace
+
+// ── DamageBatch ─────────────────────────────────────────────────────────
+
+void DamageBatch::Add(int32_t base, DamageType type, bool isCritical,
+                      const DamageCalcParams& params) {
+    int32_t stat = params.armor;
+    float constant = DamageCalcParams::kArmorConstant;
+    if (type != DamageType::Physical) {
+        const auto typeIndex = static_cast<std::size_t>(type);
+        stat = typeIndex < params.resistances.size() ? params.resistances[typeIndex] : 0;
+        constant = DamageCalcParams::kResistanceConstant;
+    }
+    baseDamage.push_back(base);
+    critMultiplier.push_back(isCritical ? DamageCalcParams::kCritMultiplier : 1.0f);
+    mitigationStat.push_back(stat);
+    mitigationConstant.push_back(constant);
+}
+
+void DamageBatch::Clear() noexcept {
+    baseDamage.clear();
+    critMultiplier.clear();
+    mitigationStat.clear();
+    mitigationConstant.clear();
+    finalDamage.clear();
+}
+
 CombatSystem::CombatSystem(cgs::ecs::ComponentStorage<SpellCast>& spellCasts,
                            cgs::ecs::ComponentStorage<AuraHolder>& auraHolders,
                            cgs::ecs::ComponentStorage<DamageEvent>& damageEvents,
@@ -28,14 +140,29 @@ CombatSystem::CombatSystem(cgs::ecs::ComponentStorage<SpellCast>& spellCasts,
       threatLists_(threatLists) {}
 
 void CombatSystem::Execute(float deltaTime) {
-    updateSpellCasts(deltaTime);
-    updateAuras(deltaTime);
+    castCompletions_.clear();
+    updateCooldowns(deltaTime);
+    if (useTimerWheel_) {
+        timers_.Advance(deltaTime, [this](uint64_t payload) { onTimer(payload); });
+    } else {
+        updateSpellCasts(deltaTime);
+        updateAuras(deltaTime);
+    }
     processDamageEvents();
 }
 
 cgs::ecs::SystemAccessInfo CombatSystem::GetAccessInfo() const {
     cgs::ecs::SystemAccessInfo info;
     cgs::ecs::Write<SpellCast, AuraHolder, DamageEvent, Stats, ThreatList>::Apply(info);
+    if (damageChannel_ != nullptr) {
+        cgs::ecs::EventRead<DamageEvent>::Apply(info);
+    }
+    if (equipmentStats_ != nullptr) {
+        cgs::ecs::Read<EquipmentStats>::Apply(info);
+    }
+    if (cooldowns_ != nullptr) {
+        cgs::ecs::Write<AbilityCooldowns>::Apply(info);
+    }
     return info;
 }
 
@@ -79,24 +206,109 @@ int32_t CombatSystem::CalculateDamage(int32_t baseDamage,
     return std::max(static_cast<int32_t>(std::floor(damage)), 1);
 }
 
+void CombatSystem::CalculateDamageBatch(DamageBatch& batch) {
+    const std::size_t count = batch.Size();
+    batch.finalDamage.resize(count);
+    std::size_t i = 0;
+#if defined(CGS_DAMAGE_BATCH_SSE2) || defined(CGS_DAMAGE_BATCH_NEON)
+    for (; i + 4 <= count; i += 4) {
+        MitigateRows4(batch, i);
+    }
+#endif
+    for (; i < count; ++i) {
+        batch.finalDamage[i] = MitigateRow(batch, i);
+    }
+}
+
 // ── Spell cast updates ──────────────────────────────────────────────────
 
 void CombatSystem::updateSpellCasts(float deltaTime) {
-    for (std::size_t i = 0; i < spellCasts_.Size(); ++i) {
-        auto entityId = spellCasts_.EntityAt(i);
-        cgs::ecs::Entity entity(entityId, 0);
-        auto& cast = spellCasts_.Get(entity);
+    // Gather the active casts' timers from the dense array, step them as
+    // one batch, then write them back and report the finished casts.
+    castRows_.clear();
+    castTimes_.clear();
+    const auto casts = spellCasts_.begin();
+    const auto count = static_cast<uint32_t>(spellCasts_.Size());
+    for (uint32_t row = 0; row < count; ++row) {
+        const CastState state = casts[row].state;
+        if (state == CastState::Casting || state == CastState::Channeling) {
+            castRows_.push_back(row);
+            castTimes_.push_back(casts[row].remainingTime);
+        }
+    }
 
-        if (cast.state == CastState::Casting || cast.state == CastState::Channeling) {
-            cast.remainingTime -= deltaTime;
-            if (cast.remainingTime <= 0.0f) {
-                cast.remainingTime = 0.0f;
-                cast.state = CastState::Complete;
-            }
+    DecrementTimers(castTimes_.data(), castTimes_.size(), deltaTime);
+
+    for (std::size_t i = 0; i < castRows_.size(); ++i) {
+        SpellCast& cast = casts[castRows_[i]];
+        cast.remainingTime = castTimes_[i];
+        if (castTimes_[i] <= 0.0f) {
+            completeCast(spellCasts_.EntityAt(castRows_[i]), cast);
+        }
+    }
+}
+
+void CombatSystem::completeCast(uint32_t casterId, SpellCast& cast) {
+    cast.remainingTime = 0.0f;
+    cast.state = CastState::Complete;
+    castCompletions_.push_back({cgs::ecs::Entity(casterId, 0), cast.target, cast.spellId});
+}
+
+// ── Ability cooldowns ───────────────────────────────────────────────────
+
+void CombatSystem::updateCooldowns(float deltaTime) {
+    if (cooldowns_ == nullptr) {
+        return;
+    }
+    for (AbilityCooldowns& cooldowns : *cooldowns_) {
+        if (cooldowns.IsIdle()) {
+            continue;
         }
+        cooldowns.globalRemaining = std::max(cooldowns.globalRemaining - deltaTime, 0.0f);
+        if (cooldowns.coolingSlots == 0) {
+            continue;
+        }
+        DecrementTimers(cooldowns.remaining.data(), kAbilitySlots, deltaTime);
+        uint32_t cooling = 0;
+        for (std::size_t slot = 0; slot < kAbilitySlots; ++slot) {
+            cooling |= static_cast<uint32_t>(cooldowns.remaining[slot] > 0.0f) << slot;
+        }
+        cooldowns.coolingSlots = cooling;
     }
 }
 
+AbilityUseResult CombatSystem::UseAbility(cgs::ecs::Entity caster, const AbilityUse& use) {
+    if (use.slot >= kAbilitySlots) {
+        return AbilityUseResult::InvalidSlot;
+    }
+    if (!spellCasts_.Has(caster)) {
+        return AbilityUseResult::NoCaster;
+    }
+    AbilityCooldowns* cooldowns =
+        cooldowns_ != nullptr && cooldowns_->Has(caster) ? &cooldowns_->Get(caster) : nullptr;
+    if (cooldowns != nullptr) {
+        // Global cooldown first: it rejects most presses mid-rotation.
+        if (use.globalCooldown > 0.0f && cooldowns->globalRemaining > 0.0f) {
+            return AbilityUseResult::OnGlobalCooldown;
+        }
+        if (!cooldowns->IsSlotReady(use.slot)) {
+            return AbilityUseResult::OnCooldown;
+        }
+    }
+    const CastState state = spellCasts_.Get(caster).state;
+    if (state == CastState::Casting || state == CastState::Channeling) {
+        return AbilityUseResult::Busy;
+    }
+
+    BeginCast(caster, use.spellId, use.target, use.castTime);
+    if (cooldowns != nullptr) {
+        cooldowns->Start(use.slot, use.cooldown);
+        cooldowns->StartGlobal(use.globalCooldown);
+        cooldowns_->MarkChanged(caster);
+    }
+    return AbilityUseResult::Started;
+}
+
 // ── Aura tick processing ────────────────────────────────────────────────
 
 void CombatSystem::updateAuras(float deltaTime) {
@@ -128,47 +340,237 @@ void CombatSystem::updateAuras(float deltaTime) {
     }
 }
 
+// ── Timer wheel ─────────────────────────────────────────────────────────
+
+void CombatSystem::SetTimerWheel(bool enabled) {
+    useTimerWheel_ = enabled;
+    timers_.Clear();
+    castTimers_.clear();
+    auraTimers_.clear();
+    freeAuraTimers_.clear();
+    auraTimerIndex_.clear();
+}
+
+bool CombatSystem::BeginCast(cgs::ecs::Entity caster,
+                             uint32_t spellId,
+                             cgs::ecs::Entity target,
+                             float castTime) {
+    if (!spellCasts_.Has(caster)) {
+        return false;
+    }
+    spellCasts_.Get(caster).Begin(spellId, target, castTime);
+    spellCasts_.MarkChanged(caster);
+
+    if (useTimerWheel_) {
+        TimerId& timer = castTimers_[caster.id()];
+        timers_.Cancel(timer);
+        timer = timers_.Schedule(castTime, kCastTimerBit | caster.id());
+    }
+    return true;
+}
+
+bool CombatSystem::ApplyAura(cgs::ecs::Entity target, const AuraInstance& aura) {
+    if (!auraHolders_.Has(target)) {
+        return false;
+    }
+    const AuraInstance& applied = auraHolders_.Get(target).AddOrStack(aura);
+    auraHolders_.MarkChanged(target);
+    if (!useTimerWheel_) {
+        return true;
+    }
+
+    const AuraKey key{target.id(), applied.auraId, applied.caster.id()};
+    auto [it, inserted] = auraTimerIndex_.try_emplace(key, 0u);
+    if (inserted) {
+        if (!freeAuraTimers_.empty()) {
+            it->second = freeAuraTimers_.back();
+            freeAuraTimers_.pop_back();
+        } else {
+            it->second = static_cast<uint32_t>(auraTimers_.size());
+            auraTimers_.emplace_back();
+        }
+    }
+    AuraTimer& state = auraTimers_[it->second];
+    const uint64_t now = timers_.Now();
+    state.key = key;
+    state.expiresAt = now + timers_.ToTicks(applied.remainingTime);
+    if (inserted) {
+        // A stack refresh keeps the running tick phase, like AddOrStack().
+        state.nextTickAt =
+            applied.tickInterval > 0.0f ? now + timers_.ToTicks(applied.tickTimer) : kNoTick;
+    } else {
+        timers_.Cancel(state.timer);
+    }
+    scheduleAura(it->second);
+    return true;
+}
+
+void CombatSystem::onTimer(uint64_t payload) {
+    if ((payload & kCastTimerBit) == 0) {
+        onAuraTimer(static_cast<uint32_t>(payload));
+        return;
+    }
+
+    const auto casterId = static_cast<uint32_t>(payload);
+    castTimers_.erase(casterId);
+    cgs::ecs::Entity caster(casterId, 0);
+    if (!spellCasts_.Has(caster)) {
+        return;
+    }
+    // Interrupted or reset casts simply stay as they are.
+    auto& cast = spellCasts_.Get(caster);
+    if (cast.state == CastState::Casting || cast.state == CastState::Channeling) {
+        completeCast(casterId, cast);
+    }
+}
+
+void CombatSystem::onAuraTimer(uint32_t index) {
+    AuraTimer& state = auraTimers_[index];
+    cgs::ecs::Entity entity(state.key.target, 0);
+    if (!auraHolders_.Has(entity)) {
+        releaseAuraTimer(index);
+        return;
+    }
+    auto& holder = auraHolders_.Get(entity);
+    const auto matches = [&key = state.key](const AuraInstance& a) {
+        return a.auraId == key.auraId && a.caster.id() == key.caster;
+    };
+    auto it = std::find_if(holder.auras.begin(), holder.auras.end(), matches);
+    if (it == holder.auras.end()) {
+        // Removed by game code since it was applied.
+        releaseAuraTimer(index);
+        return;
+    }
+
+    // Periodic ticks due by now, including one landing on the expiry.
+    const uint64_t now = timers_.Now();
+    const uint64_t interval = std::max<uint64_t>(timers_.ToTicks(it->tickInterval), 1);
+    while (state.nextTickAt <= now && state.nextTickAt <= state.expiresAt) {
+        if (stats_.Has(entity) && it->tickDamage != 0) {
+            auto& entityStats = stats_.Get(entity);
+            entityStats.SetHealth(entityStats.health - it->tickDamage * it->stacks);
+        }
+        state.nextTickAt += interval;
+    }
+
+    if (state.expiresAt <= now) {
+        cgs::ecs::erase_if(holder.auras, matches);
+        releaseAuraTimer(index);
+        return;
+    }
+    it->remainingTime = timers_.ToSeconds(state.expiresAt - now);
+    if (state.nextTickAt != kNoTick) {
+        it->tickTimer = timers_.ToSeconds(state.nextTickAt - now);
+    }
+    scheduleAura(index);
+}
+
+void CombatSystem::scheduleAura(uint32_t index) {
+    AuraTimer& state = auraTimers_[index];
+    state.timer = timers_.ScheduleAt(std::min(state.nextTickAt, state.expiresAt), index);
+}
+
+void CombatSystem::releaseAuraTimer(uint32_t index) {
+    auraTimerIndex_.erase(auraTimers_[index].key);
+    freeAuraTimers_.push_back(index);
+}
+
 // ── Damage event processing ─────────────────────────────────────────────
 
 void CombatSystem::processDamageEvents() {
+    // 1. Gather every pending hit.
+    hits_.clear();
+    hitEventEntities_.clear();
     for (std::size_t i = 0; i < damageEvents_.Size(); ++i) {
         auto entityId = damageEvents_.EntityAt(i);
-        cgs::ecs::Entity entity(entityId, 0);
-        auto& event = damageEvents_.Get(entity);
-
-        if (event.isProcessed) {
-            continue;
+        const auto& event = damageEvents_.Get(cgs::ecs::Entity(entityId, 0));
+        if (!event.isProcessed) {
+            queueHit(event, entityId);
         }
+    }
+    if (damageChannel_ != nullptr) {
+        for (const auto& event : damageChannel_->Read()) {
+            queueHit(event, kNoEventEntity);
+        }
+    }
+    if (hits_.empty()) {
+        return;
+    }
+
+    // 2. Order hits by victim, keeping arrival order within a victim.
+    hitOrder_.clear();
+    for (std::size_t i = 0; i < hits_.size(); ++i) {
+        hitOrder_.push_back((static_cast<uint64_t>(hits_[i]->victim.id()) << 32) | i);
+    }
+    std::sort(hitOrder_.begin(), hitOrder_.end());
 
-        // Build mitigation parameters from victim's stats.
-        DamageCalcParams params;
-        if (stats_.Has(event.victim)) {
-            // Use attribute indices for armor/resistances:
-            // attribute[0] = armor, attribute[1..6] = resistances by DamageType.
-            auto& victimStats = stats_.Get(event.victim);
-            params.armor = victimStats.attributes[0];
-            for (std::size_t r = 0; r < kDamageTypeCount && (r + 1) < kMaxAttributes; ++r) {
-                params.resistances[r] = victimStats.attributes[r + 1];
+    // 3. Read each victim's mitigation stats once and fill the batch.
+    // Use attribute indices for armor/resistances:
+    // attribute[0] = armor, attribute[1..6] = resistances by DamageType.
+    batch_.Clear();
+    DamageCalcParams params;
+    for (std::size_t row = 0; row < hitOrder_.size(); ++row) {
+        const DamageEvent& hit = *hits_[static_cast<uint32_t>(hitOrder_[row])];
+        if (row == 0 || hit.victim != hits_[static_cast<uint32_t>(hitOrder_[row - 1])]->victim) {
+            params = DamageCalcParams{};
+            if (stats_.Has(hit.victim)) {
+                const auto& victimStats = stats_.Get(hit.victim);
+                params.armor = victimStats.attributes[0];
+                for (std::size_t r = 0; r < kDamageTypeCount && (r + 1) < kMaxAttributes; ++r) {
+                    params.resistances[r] = victimStats.attributes[r + 1];
+                }
+            }
+            if (equipmentStats_ != nullptr && equipmentStats_->Has(hit.victim)) {
+                const StatBonuses& gear = equipmentStats_->Get(hit.victim).bonuses;
+                params.armor += gear.attributes[0] + gear.armor;
+                for (std::size_t r = 0; r < kDamageTypeCount && (r + 1) < kMaxAttributes; ++r) {
+                    params.resistances[r] += gear.attributes[r + 1];
+                }
             }
         }
+        batch_.Add(hit.baseDamage, hit.type, hit.isCritical, params);
+    }
 
-        // Calculate final damage.
-        event.finalDamage = CalculateDamage(event.baseDamage, event.type, event.isCritical, params);
+    // 4. Mitigation math across the whole batch.
+    CalculateDamageBatch(batch_);
 
-        // Apply damage to victim's health.
-        if (stats_.Has(event.victim)) {
-            auto& victimStats = stats_.Get(event.victim);
-            victimStats.SetHealth(victimStats.health - event.finalDamage);
+    // 5. Apply each victim's run: one health update, threat per hit.
+    for (std::size_t begin = 0; begin < hitOrder_.size();) {
+        const cgs::ecs::Entity victim = hits_[static_cast<uint32_t>(hitOrder_[begin])]->victim;
+        auto* threats = threatLists_.Has(victim) ? &threatLists_.Get(victim) : nullptr;
+        int64_t total = 0;
+        std::size_t end = begin;
+        for (; end < hitOrder_.size(); ++end) {
+            const auto index = static_cast<uint32_t>(hitOrder_[end]);
+            const DamageEvent& hit = *hits_[index];
+            if (hit.victim != victim) {
+                break;
+            }
+            const int32_t finalDamage = batch_.finalDamage[end];
+            total += finalDamage;
+            if (threats != nullptr) {
+                threats->AddThreat(hit.attacker, static_cast<float>(finalDamage));
+            }
+            if (hitEventEntities_[index] != kNoEventEntity) {
+                auto& event = damageEvents_.Get(cgs::ecs::Entity(hitEventEntities_[index], 0));
+                event.finalDamage = finalDamage;
+                event.isProcessed = true;
+            }
         }
-
-        // Add threat to victim's threat list.
-        if (threatLists_.Has(event.victim)) {
-            auto& threats = threatLists_.Get(event.victim);
-            threats.AddThreat(event.attacker, static_cast<float>(event.finalDamage));
+        if (stats_.Has(victim)) {
+            // Hits are never negative, so one clamped update equals
+            // applying them one at a time.
+            auto& victimStats = stats_.Get(victim);
+            victimStats.SetHealth(static_cast<int32_t>(
+                std::max<int64_t>(victimStats.health - total, std::numeric_limits<int32_t>::min())));
         }
-
-        event.isProcessed = true;
+        begin = end;
     }
 }
 
+void CombatSystem::queueHit(const DamageEvent& event, uint32_t eventEntity) {
+    hits_.push_back(&event);
+    hitEventEntities_.push_back(eventEntity);
+}
+
 }  // namespace cgs::game
@@ -1,9 +1,13 @@
 /// @file inventory_system.cpp
 /// @brief InventorySystem implementation.
 ///
-/// Implements the two-phase inventory tick:
+/// Implements the inventory tick:
 ///   1. Durability event processing (reduce equipment durability)
-///   2. Enchant timer updates (remove expired timed enchantments)
+///   2. Enchant timer updates (remove expired timed enchantments), by
+///      stepping every enchant or, in timer wheel mode, firing only the
+///      timers due this tick
+///   3. EquipmentStats recompute for the entities marked dirty, when a
+///      cache is attached
 ///
 /// @see SRS-GML-006.4
 /// @see SDS-MOD-035
@@ -11,6 +15,7 @@
 #include "cgs/game/inventory_system.hpp"
 
 #include <algorithm>
+#include <utility>
 
 namespace cgs::game {
 
@@ -19,33 +24,44 @@ InventorySystem::InventorySystem(cgs::ecs::ComponentStorage<Inventory>& inventor
                                  cgs::ecs::ComponentStorage<DurabilityEvent>& durabilityEvents)
     : inventories_(inventories), equipment_(equipment), durabilityEvents_(durabilityEvents) {}
 
+InventorySystem::~InventorySystem() {
+    if (equipmentStats_ != nullptr) {
+        equipment_.RemoveListener(&equipmentListener_);
+    }
+}
+
 void InventorySystem::Execute(float deltaTime) {
     processDurabilityEvents();
-    updateEnchants(deltaTime);
+    if (useTimerWheel_) {
+        timers_.Advance(deltaTime, [this](uint64_t payload) { expireEnchant(payload); });
+    } else {
+        updateEnchants(deltaTime);
+    }
+    if (equipmentStats_ != nullptr) {
+        refreshEquipmentStats();
+    }
 }
 
 cgs::ecs::SystemAccessInfo InventorySystem::GetAccessInfo() const {
     cgs::ecs::SystemAccessInfo info;
     cgs::ecs::Write<Inventory, Equipment, DurabilityEvent>::Apply(info);
+    if (durabilityChannel_ != nullptr) {
+        cgs::ecs::EventRead<DurabilityEvent>::Apply(info);
+    }
+    if (equipmentStats_ != nullptr) {
+        cgs::ecs::Write<EquipmentStats>::Apply(info);
+    }
     return info;
 }
 
-void InventorySystem::RegisterTemplate(ItemTemplate tmpl) {
-    auto it = std::find_if(templates_.begin(), templates_.end(), [&tmpl](const ItemTemplate& t) {
-        return t.id == tmpl.id;
-    });
-    if (it != templates_.end()) {
-        *it = std::move(tmpl);
-    } else {
-        templates_.push_back(std::move(tmpl));
-    }
+void InventorySystem::SetTemplates(std::shared_ptr<const ItemTemplateDatabase> templates) {
+    templates_ = templates ? std::move(templates) : ItemTemplateDatabase::Build({});
+    markAllStatsDirty();
 }
 
-const ItemTemplate* InventorySystem::GetTemplate(uint32_t templateId) const {
-    auto it = std::find_if(templates_.begin(),
-                           templates_.end(),
-                           [templateId](const ItemTemplate& t) { return t.id == templateId; });
-    return (it != templates_.end()) ? &(*it) : nullptr;
+void InventorySystem::RegisterTemplate(ItemTemplate tmpl) {
+    templates_ = ItemTemplateDatabase::With(templates_.get(), std::move(tmpl));
+    markAllStatsDirty();
 }
 
 // -- Durability event processing ----------------------------------------------
@@ -59,16 +75,28 @@ void InventorySystem::processDurabilityEvents() {
         if (event.processed) {
             continue;
         }
+        applyDurability(event);
+        event.processed = true;
+    }
 
-        if (equipment_.Has(event.player)) {
-            auto& equip = equipment_.Get(event.player);
-            auto slotIdx = static_cast<std::size_t>(event.slot);
-            if (slotIdx < kEquipSlotCount) {
-                equip.slots[slotIdx].ReduceDurability(event.amount);
-            }
+    if (durabilityChannel_ != nullptr) {
+        for (const auto& event : durabilityChannel_->Read()) {
+            applyDurability(event);
         }
+    }
+}
 
-        event.processed = true;
+void InventorySystem::applyDurability(const DurabilityEvent& event) {
+    if (equipment_.Has(event.player)) {
+        auto& equip = equipment_.Get(event.player);
+        auto slotIdx = static_cast<std::size_t>(event.slot);
+        if (slotIdx < kEquipSlotCount) {
+            auto& slot = equip.slots[slotIdx];
+            const StatBonuses before = EquippedBonuses(slot, *templates_);
+            if (slot.ReduceDurability(event.amount)) {
+                applyStatDelta(event.player, {}, before);  // broken items give nothing
+            }
+        }
     }
 }
 
@@ -90,7 +118,14 @@ void InventorySystem::updateEnchants(float deltaTime) {
                     *enc.durationRemaining -= deltaTime;
                 }
             }
+            const std::size_t before = slot.enchants.size();
+            const StatBonuses bonusesBefore = slot.GetEnchantBonuses();
             slot.RemoveExpiredEnchants();
+            if (slot.enchants.size() != before && !slot.IsBroken()) {
+                StatBonuses expired = bonusesBefore;
+                expired -= slot.GetEnchantBonuses();
+                applyStatDelta(entity, {}, expired);
+            }
         }
     }
 
@@ -114,4 +149,187 @@ void InventorySystem::updateEnchants(float deltaTime) {
     }
 }
 
+// -- Timer wheel --------------------------------------------------------------
+
+void InventorySystem::SetTimerWheel(bool enabled) {
+    useTimerWheel_ = enabled;
+    timers_.Clear();
+}
+
+bool InventorySystem::ApplyEnchant(cgs::ecs::Entity entity, EquipSlot slot, Enchant enchant) {
+    const auto idx = static_cast<std::size_t>(slot);
+    if (!equipment_.Has(entity) || idx >= kEquipSlotCount) {
+        return false;
+    }
+    auto& item = equipment_.Get(entity).slots[idx];
+    if (item.IsEmpty()) {
+        return false;
+    }
+    const StatBonuses added = item.IsBroken() ? StatBonuses{} : enchant.bonuses;
+    attachEnchant(entity, item, std::move(enchant));
+    equipment_.MarkChanged(entity);
+    applyStatDelta(entity, added, {});
+    return true;
+}
+
+bool InventorySystem::ApplyEnchant(cgs::ecs::Entity entity, uint32_t slotIndex, Enchant enchant) {
+    if (!inventories_.Has(entity)) {
+        return false;
+    }
+    auto& inv = inventories_.Get(entity);
+    if (slotIndex >= inv.slots.size() || inv.slots[slotIndex].IsEmpty()) {
+        return false;
+    }
+    attachEnchant(entity, inv.slots[slotIndex], std::move(enchant));
+    inventories_.MarkChanged(entity);
+    return true;
+}
+
+void InventorySystem::attachEnchant(cgs::ecs::Entity entity,
+                                    InventorySlot& slot,
+                                    Enchant enchant) {
+    enchant.timerTag = 0;
+    if (useTimerWheel_ && enchant.durationRemaining.has_value()) {
+        if (++lastEnchantTag_ == 0) {
+            lastEnchantTag_ = 1;
+        }
+        enchant.timerTag = lastEnchantTag_;
+        timers_.Schedule(*enchant.durationRemaining,
+                         (static_cast<uint64_t>(entity.id()) << 32) | enchant.timerTag);
+    }
+    slot.enchants.push_back(std::move(enchant));
+}
+
+void InventorySystem::expireEnchant(uint64_t payload) {
+    const cgs::ecs::Entity entity(static_cast<uint32_t>(payload >> 32), 0);
+    const auto tag = static_cast<uint32_t>(payload);
+    const auto expire = [tag](InventorySlot& slot) {
+        cgs::ecs::erase_if(slot.enchants, [tag](const Enchant& e) { return e.timerTag == tag; });
+    };
+
+    // The item may have moved between the owner's containers since.
+    if (equipment_.Has(entity)) {
+        for (auto& slot : equipment_.Get(entity).slots) {
+            for (const auto& enc : slot.enchants) {
+                if (enc.timerTag == tag && !slot.IsBroken()) {
+                    applyStatDelta(entity, {}, enc.bonuses);
+                }
+            }
+            expire(slot);
+        }
+    }
+    if (inventories_.Has(entity)) {
+        for (auto& slot : inventories_.Get(entity).slots) {
+            expire(slot);
+        }
+    }
+}
+
+// -- Equipment stats ----------------------------------------------------------
+
+void InventorySystem::SetEquipmentStats(cgs::ecs::ComponentStorage<EquipmentStats>* stats) {
+    if (equipmentStats_ != nullptr) {
+        equipment_.RemoveListener(&equipmentListener_);
+    }
+    equipmentStats_ = stats;
+    dirtyStats_.clear();
+    equipmentCleared_ = false;
+    if (equipmentStats_ != nullptr) {
+        equipment_.AddListener(&equipmentListener_);
+    }
+    markAllStatsDirty();
+}
+
+InventorySlot InventorySystem::Equip(cgs::ecs::Entity entity, EquipSlot slot, InventorySlot item) {
+    const auto idx = static_cast<std::size_t>(slot);
+    if (!equipment_.Has(entity) || idx >= kEquipSlotCount) {
+        return {};
+    }
+    auto& equip = equipment_.Get(entity);
+    const StatBonuses removed = EquippedBonuses(equip.slots[idx], *templates_);
+    InventorySlot previous = equip.Equip(slot, std::move(item));
+    equipment_.MarkChanged(entity);
+    applyStatDelta(entity, EquippedBonuses(equip.slots[idx], *templates_), removed);
+    return previous;
+}
+
+InventorySlot InventorySystem::Unequip(cgs::ecs::Entity entity, EquipSlot slot) {
+    const auto idx = static_cast<std::size_t>(slot);
+    if (!equipment_.Has(entity) || idx >= kEquipSlotCount) {
+        return {};
+    }
+    auto& equip = equipment_.Get(entity);
+    InventorySlot removed = equip.Unequip(slot);
+    equipment_.MarkChanged(entity);
+    applyStatDelta(entity, {}, EquippedBonuses(removed, *templates_));
+    return removed;
+}
+
+void InventorySystem::MarkStatsDirty(cgs::ecs::Entity entity) {
+    if (equipmentStats_ == nullptr) {
+        return;
+    }
+    if (equipmentStats_->Has(entity)) {
+        equipmentStats_->Get(entity).dirty = true;
+    }
+    dirtyStats_.push_back(entity);  // duplicates are dropped on refresh
+}
+
+void InventorySystem::applyStatDelta(cgs::ecs::Entity entity,
+                                     const StatBonuses& added,
+                                     const StatBonuses& removed) {
+    if (equipmentStats_ == nullptr) {
+        return;
+    }
+    if (!equipmentStats_->Has(entity) || equipmentStats_->Get(entity).dirty) {
+        MarkStatsDirty(entity);
+        return;
+    }
+    auto& cached = equipmentStats_->Get(entity);
+    cached.bonuses += added;
+    cached.bonuses -= removed;
+    equipmentStats_->MarkChanged(entity);
+}
+
+void InventorySystem::markAllStatsDirty() {
+    if (equipmentStats_ == nullptr) {
+        return;
+    }
+    for (std::size_t i = 0; i < equipment_.Size(); ++i) {
+        MarkStatsDirty(cgs::ecs::Entity(equipment_.EntityAt(i), 0));
+    }
+}
+
+void InventorySystem::refreshEquipmentStats() {
+    if (equipmentCleared_) {
+        equipmentStats_->Clear();
+        equipmentCleared_ = false;
+    }
+    // An entity is queued once per change that found it dirty.
+    std::sort(dirtyStats_.begin(), dirtyStats_.end(), [](auto a, auto b) {
+        return a.id() < b.id();
+    });
+    dirtyStats_.erase(std::unique(dirtyStats_.begin(), dirtyStats_.end(),
+                                  [](auto a, auto b) { return a.id() == b.id(); }),
+                      dirtyStats_.end());
+
+    for (const auto entity : dirtyStats_) {
+        if (!equipment_.Has(entity)) {
+            if (equipmentStats_->Has(entity)) {
+                equipmentStats_->Remove(entity);
+            }
+            continue;
+        }
+        EquipmentStats fresh{equipment_.Get(entity).CalculateStatBonuses(*templates_), false};
+        if (equipmentStats_->Has(entity)) {
+            equipmentStats_->Get(entity) = fresh;
+            equipmentStats_->MarkChanged(entity);
+        } else {
+            equipmentStats_->Add(entity, fresh);
+        }
+    }
+    lastStatsRecomputes_ = dirtyStats_.size();
+    dirtyStats_.clear();
+}
+
 }  // namespace cgs::game
@@ -2,35 +2,204 @@
 /// @brief ObjectUpdateSystem implementation.
 ///
 /// Updates entity positions by integrating movement direction and speed
-/// over the frame delta time.  Uses Query<Transform, Movement> to
-/// iterate only entities that possess both components.
+/// over the frame delta time.  A persistent Query<Transform, Movement>
+/// iterates only entities that possess both components; its match list
+/// is patched as entities spawn and despawn rather than rebuilt per tick.
+///
+/// The Float step is (direction * speed) * deltaTime added to position,
+/// in that order in every path, so the SIMD columns kernel, the group
+/// loop and the query loop agree bit for bit.
 ///
 /// @see SRS-GML-001.5
 /// @see SDS-MOD-020
 
 #include "cgs/game/object_system.hpp"
 
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define CGS_MOVEMENT_KERNEL_SSE2 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define CGS_MOVEMENT_KERNEL_NEON 1
+#endif
+
 namespace cgs::game {
 
+namespace {
+
+static_assert(sizeof(Vector3) == 3 * sizeof(float), "Vector3 columns are read as packed floats");
+
+/// Fixed-point scales of MovementPrecision::Quantized.
+constexpr float kPositionScale = 1.0f / kMovementQuantum;
+constexpr float kStepScale = 65536.0f;
+constexpr int kStepShift = 24;  ///< (Q16 * Q16) >> 24 = position quanta.
+
+/// Round half away from zero with one IEEE add and a truncation, which
+/// do not depend on the rounding mode (and, unlike llround(), inline).
+[[nodiscard]] int64_t RoundToInt(float value) noexcept {
+    return static_cast<int64_t>(value < 0.0f ? value - 0.5f : value + 0.5f);
+}
+
+/// One axis of a quantized step; right shifts of negative values are
+/// arithmetic.
+[[nodiscard]] float QuantizedAxis(float position, float direction, int64_t stepQ16) noexcept {
+    const int64_t pos = RoundToInt(position * kPositionScale);
+    const int64_t dir = RoundToInt(direction * kStepScale);
+    const int64_t step = (dir * stepQ16 + (int64_t{1} << (kStepShift - 1))) >> kStepShift;
+    return static_cast<float>(pos + step) * kMovementQuantum;
+}
+
+#if defined(CGS_MOVEMENT_KERNEL_SSE2)
+
+/// Rows [i, i + 4): twelve packed position floats and twelve direction
+/// floats, with each row's speed and idle mask spread across its three
+/// lanes.  Idle rows keep their exact bits.
+void IntegrateRows4(float* position,
+                    const float* direction,
+                    const float* speed,
+                    const MovementState* state,
+                    __m128 deltaTime) noexcept {
+    const __m128 sp = _mm_loadu_ps(speed);
+    const __m128 speeds[3] = {_mm_shuffle_ps(sp, sp, _MM_SHUFFLE(1, 0, 0, 0)),
+                              _mm_shuffle_ps(sp, sp, _MM_SHUFFLE(2, 2, 1, 1)),
+                              _mm_shuffle_ps(sp, sp, _MM_SHUFFLE(3, 3, 3, 2))};
+    const int m0 = state[0] != MovementState::Idle ? -1 : 0;
+    const int m1 = state[1] != MovementState::Idle ? -1 : 0;
+    const int m2 = state[2] != MovementState::Idle ? -1 : 0;
+    const int m3 = state[3] != MovementState::Idle ? -1 : 0;
+    const __m128 masks[3] = {_mm_castsi128_ps(_mm_setr_epi32(m0, m0, m0, m1)),
+                             _mm_castsi128_ps(_mm_setr_epi32(m1, m1, m2, m2)),
+                             _mm_castsi128_ps(_mm_setr_epi32(m2, m3, m3, m3))};
+    for (int j = 0; j < 3; ++j) {
+        const __m128 pos = _mm_loadu_ps(position + 4 * j);
+        const __m128 step =
+            _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(direction + 4 * j), speeds[j]), deltaTime);
+        const __m128 moved = _mm_add_ps(pos, step);
+        _mm_storeu_ps(position + 4 * j,
+                      _mm_or_ps(_mm_and_ps(masks[j], moved), _mm_andnot_ps(masks[j], pos)));
+    }
+}
+
+#elif defined(CGS_MOVEMENT_KERNEL_NEON)
+
+/// Rows [i, i + 4); see the SSE2 version.
+void IntegrateRows4(float* position,
+                    const float* direction,
+                    const float* speed,
+                    const MovementState* state,
+                    float32x4_t deltaTime) noexcept {
+    const float32x4_t speeds[3] = {{speed[0], speed[0], speed[0], speed[1]},
+                                   {speed[1], speed[1], speed[2], speed[2]},
+                                   {speed[2], speed[3], speed[3], speed[3]}};
+    const uint32_t m0 = state[0] != MovementState::Idle ? UINT32_MAX : 0;
+    const uint32_t m1 = state[1] != MovementState::Idle ? UINT32_MAX : 0;
+    const uint32_t m2 = state[2] != MovementState::Idle ? UINT32_MAX : 0;
+    const uint32_t m3 = state[3] != MovementState::Idle ? UINT32_MAX : 0;
+    const uint32x4_t masks[3] = {{m0, m0, m0, m1}, {m1, m1, m2, m2}, {m2, m3, m3, m3}};
+    for (int j = 0; j < 3; ++j) {
+        const float32x4_t pos = vld1q_f32(position + 4 * j);
+        const float32x4_t step =
+            vmulq_f32(vmulq_f32(vld1q_f32(direction + 4 * j), speeds[j]), deltaTime);
+        vst1q_f32(position + 4 * j, vbslq_f32(masks[j], vaddq_f32(pos, step), pos));
+    }
+}
+
+#endif
+
+}  // namespace
+
 ObjectUpdateSystem::ObjectUpdateSystem(cgs::ecs::ComponentStorage<Transform>& transforms,
                                        cgs::ecs::ComponentStorage<Movement>& movements)
-    : transforms_(transforms), movements_(movements) {}
+    : transforms_(transforms), movements_(movements), query_(transforms, movements) {}
 
 void ObjectUpdateSystem::Execute(float deltaTime) {
-    cgs::ecs::Query<Transform, Movement> query(transforms_, movements_);
-
-    query.ForEach(
-        [deltaTime](cgs::ecs::Entity /*entity*/, Transform& transform, Movement& movement) {
+    if (group_ != nullptr) {
+        executeGroup(deltaTime);
+        return;
+    }
+    query_.ForEach(
+        [this, deltaTime](cgs::ecs::Entity entity, Transform& transform, Movement& movement) {
             // Skip idle entities — no position change needed.
             if (movement.state == MovementState::Idle) {
                 return;
             }
 
             // Integrate: position += direction * speed * dt.
-            transform.position += movement.direction * movement.speed * deltaTime;
+            transform.position =
+                IntegratePosition(transform.position, movement, deltaTime, precision_);
+
+            // Stamp the move so change-filtered readers (WorldSystem) see it.
+            transforms_.MarkChanged(entity);
         });
 }
 
+void ObjectUpdateSystem::executeGroup(float deltaTime) {
+    const std::size_t count = group_->Size();
+    if (count == 0) {
+        return;
+    }
+    // Group slot i of both pools belongs to the same entity.
+    Transform* transforms = &*transforms_.begin();
+    const Movement* movements = &*movements_.begin();
+    moved_.clear();
+    for (std::size_t i = 0; i < count; ++i) {
+        if (movements[i].state == MovementState::Idle) {
+            continue;
+        }
+        transforms[i].position =
+            IntegratePosition(transforms[i].position, movements[i], deltaTime, precision_);
+        moved_.push_back(static_cast<uint32_t>(i));
+    }
+    transforms_.MarkChangedAt(moved_);
+}
+
+Vector3 ObjectUpdateSystem::IntegratePosition(const Vector3& position,
+                                              const Movement& movement,
+                                              float deltaTime,
+                                              MovementPrecision precision) noexcept {
+    if (precision == MovementPrecision::Float) {
+        return position + movement.direction * movement.speed * deltaTime;
+    }
+    const int64_t step = RoundToInt(movement.speed * deltaTime * kStepScale);
+    return {QuantizedAxis(position.x, movement.direction.x, step),
+            QuantizedAxis(position.y, movement.direction.y, step),
+            QuantizedAxis(position.z, movement.direction.z, step)};
+}
+
+void ObjectUpdateSystem::IntegrateColumns(const MovementColumns& columns,
+                                          float deltaTime,
+                                          MovementPrecision precision) noexcept {
+    const std::size_t count = columns.positions.size();
+    std::size_t i = 0;
+#if defined(CGS_MOVEMENT_KERNEL_SSE2) || defined(CGS_MOVEMENT_KERNEL_NEON)
+    if (precision == MovementPrecision::Float) {
+        float* position = &columns.positions.data()->x;
+        const float* direction = &columns.directions.data()->x;
+#if defined(CGS_MOVEMENT_KERNEL_SSE2)
+        const __m128 dt = _mm_set1_ps(deltaTime);
+#else
+        const float32x4_t dt = vdupq_n_f32(deltaTime);
+#endif
+        for (; i + 4 <= count; i += 4) {
+            IntegrateRows4(position + 3 * i, direction + 3 * i, columns.speeds.data() + i,
+                           columns.states.data() + i, dt);
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        if (columns.states[i] == MovementState::Idle) {
+            continue;
+        }
+        Movement movement;
+        movement.speed = columns.speeds[i];
+        movement.direction = columns.directions[i];
+        columns.positions[i] =
+            IntegratePosition(columns.positions[i], movement, deltaTime, precision);
+    }
+}
+
 cgs::ecs::SystemAccessInfo ObjectUpdateSystem::GetAccessInfo() const {
     cgs::ecs::SystemAccessInfo info;
     cgs::ecs::Write<Transform>::Apply(info);
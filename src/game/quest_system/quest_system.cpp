@@ -2,8 +2,12 @@
 /// @brief QuestSystem implementation.
 ///
 /// Implements the two-phase quest tick:
-///   1. Timer updates for timed quests (fail expired)
-///   2. Event processing (map QuestEvents to objective progress)
+///   1. Timer updates for timed quests (fail expired), by stepping every
+///      accepted quest or, in timer wheel mode, firing only the timers
+///      due this tick
+///   2. Event processing (map QuestEvents to objective progress), by
+///      scanning the player's quest log or, in objective index mode,
+///      summing them per (player, type, target) index bucket first
 ///
 /// @see SRS-GML-005.4
 /// @see SDS-MOD-034
@@ -11,40 +15,62 @@
 #include "cgs/game/quest_system.hpp"
 
 #include <algorithm>
+#include <utility>
 
 namespace cgs::game {
 
+namespace {
+
+/// Objective type advanced by @p eventType; false if none.
+bool objectiveTypeFor(QuestEventType eventType, ObjectiveType& out) noexcept {
+    switch (eventType) {
+        case QuestEventType::Kill:
+            out = ObjectiveType::Kill;
+            return true;
+        case QuestEventType::Collect:
+            out = ObjectiveType::Collect;
+            return true;
+        case QuestEventType::Explore:
+            out = ObjectiveType::Explore;
+            return true;
+        case QuestEventType::Interact:
+            out = ObjectiveType::Interact;
+            return true;
+        default:
+            return false;
+    }
+}
+
+}  // namespace
+
 QuestSystem::QuestSystem(cgs::ecs::ComponentStorage<QuestLog>& questLogs,
                          cgs::ecs::ComponentStorage<QuestEvent>& questEvents)
     : questLogs_(questLogs), questEvents_(questEvents) {}
 
 void QuestSystem::Execute(float deltaTime) {
-    updateTimers(deltaTime);
+    if (useTimerWheel_) {
+        timers_.Advance(deltaTime, [this](uint64_t payload) { expireQuest(payload); });
+    } else {
+        updateTimers(deltaTime);
+    }
     processEvents();
 }
 
 cgs::ecs::SystemAccessInfo QuestSystem::GetAccessInfo() const {
     cgs::ecs::SystemAccessInfo info;
     cgs::ecs::Write<QuestLog, QuestEvent>::Apply(info);
+    if (eventChannel_ != nullptr) {
+        cgs::ecs::EventRead<QuestEvent>::Apply(info);
+    }
     return info;
 }
 
-void QuestSystem::RegisterTemplate(QuestTemplate tmpl) {
-    auto it = std::find_if(templates_.begin(), templates_.end(), [&tmpl](const QuestTemplate& t) {
-        return t.id == tmpl.id;
-    });
-    if (it != templates_.end()) {
-        *it = std::move(tmpl);
-    } else {
-        templates_.push_back(std::move(tmpl));
-    }
+void QuestSystem::SetTemplates(std::shared_ptr<const QuestTemplateDatabase> templates) {
+    templates_ = templates ? std::move(templates) : QuestTemplateDatabase::Build({});
 }
 
-const QuestTemplate* QuestSystem::GetTemplate(uint32_t templateId) const {
-    auto it = std::find_if(templates_.begin(),
-                           templates_.end(),
-                           [templateId](const QuestTemplate& t) { return t.id == templateId; });
-    return (it != templates_.end()) ? &(*it) : nullptr;
+void QuestSystem::RegisterTemplate(QuestTemplate tmpl) {
+    templates_ = QuestTemplateDatabase::With(templates_.get(), std::move(tmpl));
 }
 
 // -- Timer updates ------------------------------------------------------------
@@ -66,11 +92,192 @@ void QuestSystem::updateTimers(float deltaTime) {
             quest.elapsedTime += deltaTime;
             if (quest.elapsedTime >= quest.timeLimit) {
                 quest.state = QuestState::Failed;
+                if (useObjectiveIndex_) {
+                    unindexQuest(entityId, quest);
+                }
+            }
+        }
+    }
+}
+
+// -- Timer wheel --------------------------------------------------------------
+
+void QuestSystem::SetTimerWheel(bool enabled) {
+    useTimerWheel_ = enabled;
+    timers_.Clear();
+    questTimers_.clear();
+}
+
+bool QuestSystem::AcceptQuest(cgs::ecs::Entity player, uint32_t templateId) {
+    const QuestTemplate* tmpl = GetTemplate(templateId);
+    if (tmpl == nullptr || !questLogs_.Has(player)) {
+        return false;
+    }
+    QuestLog& log = questLogs_.Get(player);
+    if (!log.Accept(*tmpl)) {
+        return false;
+    }
+    questLogs_.MarkChanged(player);
+    if (useObjectiveIndex_) {
+        indexQuest(player.id(), log.activeQuests.back());
+    }
+
+    if (useTimerWheel_ && tmpl->timeLimitSeconds > 0.0f) {
+        const uint64_t key = (static_cast<uint64_t>(player.id()) << 32) | tmpl->id;
+        // A quest abandoned and accepted again restarts its limit.
+        TimerId& timer = questTimers_[key];
+        timers_.Cancel(timer);
+        timer = timers_.Schedule(tmpl->timeLimitSeconds, key);
+    }
+    return true;
+}
+
+bool QuestSystem::AbandonQuest(cgs::ecs::Entity player, uint32_t questId) {
+    if (!questLogs_.Has(player)) {
+        return false;
+    }
+    QuestLog& log = questLogs_.Get(player);
+    const QuestEntry* quest = log.GetQuest(questId);
+    if (quest == nullptr) {
+        return false;
+    }
+    if (useObjectiveIndex_) {
+        unindexQuest(player.id(), *quest);
+    }
+    const uint64_t key = (static_cast<uint64_t>(player.id()) << 32) | questId;
+    if (auto it = questTimers_.find(key); it != questTimers_.end()) {
+        timers_.Cancel(it->second);
+        questTimers_.erase(it);
+    }
+    log.Abandon(questId);
+    questLogs_.MarkChanged(player);
+    return true;
+}
+
+void QuestSystem::expireQuest(uint64_t payload) {
+    questTimers_.erase(payload);
+    const cgs::ecs::Entity player(static_cast<uint32_t>(payload >> 32), 0);
+    if (!questLogs_.Has(player)) {
+        return;
+    }
+    QuestEntry* quest = questLogs_.Get(player).GetQuest(static_cast<uint32_t>(payload));
+    if (quest != nullptr && quest->state == QuestState::Accepted && quest->timeLimit > 0.0f) {
+        quest->elapsedTime = quest->timeLimit;
+        quest->state = QuestState::Failed;
+        if (useObjectiveIndex_) {
+            unindexQuest(player.id(), *quest);
+        }
+    }
+}
+
+// -- Objective index ----------------------------------------------------------
+
+void QuestSystem::SetObjectiveIndex(bool enabled) {
+    useObjectiveIndex_ = enabled;
+    objectiveIndex_.clear();
+    queued_.clear();
+    if (!enabled) {
+        return;
+    }
+    for (std::size_t i = 0; i < questLogs_.Size(); ++i) {
+        const uint32_t entityId = questLogs_.EntityAt(i);
+        const auto& log = questLogs_.Get(cgs::ecs::Entity(entityId, 0));
+        for (const auto& quest : log.activeQuests) {
+            if (quest.state == QuestState::Accepted) {
+                indexQuest(entityId, quest);
             }
         }
     }
 }
 
+std::size_t QuestSystem::IndexedObjectiveCount() const noexcept {
+    std::size_t count = 0;
+    for (const auto& [key, bucket] : objectiveIndex_) {
+        count += bucket.refs.size();
+    }
+    return count;
+}
+
+void QuestSystem::indexQuest(uint32_t player, const QuestEntry& quest) {
+    for (std::size_t i = 0; i < quest.objectives.size(); ++i) {
+        const QuestObjective& obj = quest.objectives[i];
+        if (obj.completed) {
+            continue;
+        }
+        objectiveIndex_[{player, obj.targetId, obj.type}].refs.push_back(
+            {quest.questId, static_cast<uint32_t>(i)});
+    }
+}
+
+void QuestSystem::unindexQuest(uint32_t player, const QuestEntry& quest) {
+    for (const QuestObjective& obj : quest.objectives) {
+        auto it = objectiveIndex_.find({player, obj.targetId, obj.type});
+        if (it == objectiveIndex_.end()) {
+            continue;
+        }
+        std::erase_if(it->second.refs,
+                      [&quest](const ObjectiveRef& ref) { return ref.questId == quest.questId; });
+        if (it->second.refs.empty()) {
+            objectiveIndex_.erase(it);
+        }
+    }
+}
+
+bool QuestSystem::queueEvent(const QuestEvent& event) {
+    ObjectiveType objType{};
+    if (!objectiveTypeFor(event.type, objType)) {
+        return false;
+    }
+    auto it = objectiveIndex_.find({event.player.id(), event.targetId, objType});
+    if (it == objectiveIndex_.end()) {
+        return true;
+    }
+    if (!it->second.queued) {
+        it->second.queued = true;
+        queued_.push_back(it);
+    }
+    it->second.pending += event.count;
+    return true;
+}
+
+void QuestSystem::applyQueuedEvents() {
+    for (const auto it : queued_) {
+        const cgs::ecs::Entity player(it->first.player, 0);
+        ObjectiveBucket& bucket = it->second;
+        const int32_t count = std::exchange(bucket.pending, 0);
+        bucket.queued = false;
+        if (!questLogs_.Has(player)) {
+            objectiveIndex_.erase(it);
+            continue;
+        }
+        auto& log = questLogs_.Get(player);
+
+        // Keep only the refs still unfinished; stale ones (a quest changed
+        // behind the system's back) drop out here too.
+        std::size_t kept = 0;
+        for (const ObjectiveRef ref : bucket.refs) {
+            QuestEntry* quest = log.GetQuest(ref.questId);
+            if (quest == nullptr || quest->state != QuestState::Accepted ||
+                ref.objective >= quest->objectives.size()) {
+                continue;
+            }
+            QuestObjective& obj = quest->objectives[ref.objective];
+            obj.AddProgress(count);
+            if (quest->AllObjectivesComplete()) {
+                quest->state = QuestState::ObjectivesComplete;
+            }
+            if (!obj.completed) {
+                bucket.refs[kept++] = ref;
+            }
+        }
+        bucket.refs.resize(kept);
+        if (bucket.refs.empty()) {
+            objectiveIndex_.erase(it);
+        }
+    }
+    queued_.clear();
+}
+
 // -- Event processing ---------------------------------------------------------
 
 void QuestSystem::processEvents() {
@@ -82,36 +289,40 @@ void QuestSystem::processEvents() {
         if (event.processed) {
             continue;
         }
-
-        // Map QuestEventType to ObjectiveType.
-        ObjectiveType objType{};
-        switch (event.type) {
-            case QuestEventType::Kill:
-                objType = ObjectiveType::Kill;
-                break;
-            case QuestEventType::Collect:
-                objType = ObjectiveType::Collect;
-                break;
-            case QuestEventType::Explore:
-                objType = ObjectiveType::Explore;
-                break;
-            case QuestEventType::Interact:
-                objType = ObjectiveType::Interact;
-                break;
-            default:
-                continue;
+        if (useObjectiveIndex_ ? queueEvent(event) : applyEvent(event)) {
+            event.processed = true;
         }
+    }
 
-        // Update matching objectives in the player's quest log.
-        if (questLogs_.Has(event.player)) {
-            auto& log = questLogs_.Get(event.player);
-            for (auto& quest : log.activeQuests) {
-                quest.UpdateObjective(objType, event.targetId, event.count);
+    if (eventChannel_ != nullptr) {
+        for (const auto& event : eventChannel_->Read()) {
+            if (useObjectiveIndex_) {
+                queueEvent(event);
+            } else {
+                applyEvent(event);
             }
         }
+    }
+
+    if (useObjectiveIndex_) {
+        applyQueuedEvents();
+    }
+}
+
+bool QuestSystem::applyEvent(const QuestEvent& event) {
+    ObjectiveType objType{};
+    if (!objectiveTypeFor(event.type, objType)) {
+        return false;
+    }
 
-        event.processed = true;
+    // Update matching objectives in the player's quest log.
+    if (questLogs_.Has(event.player)) {
+        auto& log = questLogs_.Get(event.player);
+        for (auto& quest : log.activeQuests) {
+            quest.UpdateObjective(objType, event.targetId, event.count);
+        }
     }
+    return true;
 }
 
 }  // namespace cgs::game
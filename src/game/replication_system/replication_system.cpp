@@ -0,0 +1,416 @@
+/// @file replication_system.cpp
+/// @brief ReplicationSystem snapshot capture, delta encoding and
+///        ReplicaState decoding.
+///
+/// Packet layout (bit-packed, least significant bit first):
+///
+///     [32 sequence][32 baseline sequence, 0 = full snapshot]
+///     { [1 more = 1][compact id delta][2 op] payload } ... [1 more = 0]
+///
+/// Records are sorted by entity id; each id is sent as the distance from
+/// the previous record's id + 1, in the compact form [6 bit width][bits].
+/// Create carries every present component in full; Update carries, per
+/// component, whether it is still present and which fields changed since
+/// the baseline; Remove carries nothing.
+///
+/// @see SDS-MOD-022
+
+#include "cgs/game/replication_system.hpp"
+
+#include "cgs/game/world_system.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace cgs::game {
+
+namespace {
+
+enum class RecordOp : uint32_t { Update = 0, Create = 1, Remove = 2 };
+
+/// Replication's view of the serializer's bit stream: 32-bit fields plus
+/// the compact [6 bit width][value] form used for entity id deltas.
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<uint8_t>& out) : bits_(out) {}
+
+    void Bits(uint32_t value, uint32_t count) { bits_.writeBits(value, count); }
+
+    void Bytes(const uint8_t* data, std::size_t size) { bits_.writeBytes(data, size); }
+
+    /// Small values cost few bits.
+    void Compact(uint32_t value) {
+        const auto width = static_cast<uint32_t>(std::bit_width(value));
+        Bits(width, 6);
+        Bits(value, width);
+    }
+
+    void Flush() { bits_.flush(); }
+
+private:
+    cgs::foundation::detail::BitWriter bits_;
+};
+
+/// Reads BitWriter output; every read fails once the data runs out.
+class BitReader {
+public:
+    explicit BitReader(std::span<const uint8_t> data) : bits_{data} {}
+
+    bool Read(uint32_t count, uint32_t& value) {
+        uint64_t raw = 0;
+        if (!bits_.readBits(count, raw)) {
+            return false;
+        }
+        value = static_cast<uint32_t>(raw);
+        return true;
+    }
+
+    bool ReadCompact(uint32_t& value) {
+        uint32_t width = 0;
+        return Read(6, width) && width <= 32 && Read(width, value);
+    }
+
+    bool ReadBytes(uint8_t* out, std::size_t size) { return bits_.readBytes(out, size); }
+
+private:
+    cgs::foundation::detail::BitReader bits_;
+};
+
+[[nodiscard]] bool HasComponent(uint32_t mask, std::size_t c) noexcept {
+    return (mask & (1u << c)) != 0;
+}
+
+}  // namespace
+
+// ── ReplicationSnapshot ─────────────────────────────────────────────────
+
+std::size_t ReplicationSnapshot::Find(uint32_t id) const noexcept {
+    const auto it = std::lower_bound(ids.begin(), ids.end(), id);
+    if (it == ids.end() || *it != id) {
+        return ids.size();
+    }
+    return static_cast<std::size_t>(it - ids.begin());
+}
+
+// ── ReplicationSystem ───────────────────────────────────────────────────
+
+void ReplicationSystem::AddClient(cgs::ecs::Entity viewer) {
+    clients_.try_emplace(viewer);
+}
+
+void ReplicationSystem::RemoveClient(cgs::ecs::Entity viewer) {
+    clients_.erase(viewer);
+}
+
+void ReplicationSystem::Acknowledge(cgs::ecs::Entity viewer, uint32_t sequence) {
+    auto it = clients_.find(viewer);
+    if (it == clients_.end()) {
+        return;
+    }
+    if (sequence > it->second.acked && sequence <= sequence_) {
+        it->second.acked = sequence;
+    }
+}
+
+void ReplicationSystem::Execute(float /*deltaTime*/) {
+    ++sequence_;
+    ReplicationSnapshot& snap = history_[sequence_ % kHistory];
+    snap.sequence = sequence_;
+    snap.ids.clear();
+
+    for (const auto& rep : replicators_) {
+        const std::size_t count = rep.storage->Size();
+        for (std::size_t i = 0; i < count; ++i) {
+            snap.ids.push_back(rep.storage->EntityAt(i));
+        }
+    }
+    std::sort(snap.ids.begin(), snap.ids.end());
+    snap.ids.erase(std::unique(snap.ids.begin(), snap.ids.end()), snap.ids.end());
+
+    snap.masks.assign(snap.ids.size(), 0);
+    snap.data.assign(snap.ids.size() * stride_, 0);
+    for (std::size_t c = 0; c < replicators_.size(); ++c) {
+        const auto& rep = replicators_[c];
+        const std::size_t count = rep.storage->Size();
+        for (std::size_t i = 0; i < count; ++i) {
+            const std::size_t row = snap.Find(rep.storage->EntityAt(i));
+            rep.capture(*rep.storage, i, snap.data.data() + row * stride_ + rep.offset);
+            snap.masks[row] |= 1u << c;
+        }
+    }
+}
+
+const ReplicationSnapshot* ReplicationSystem::baseline(const Client& client) const noexcept {
+    const uint32_t acked = client.acked;
+    if (acked == 0 || sequence_ - acked >= kHistory) {
+        return nullptr;
+    }
+    const ReplicationSnapshot& snap = history_[acked % kHistory];
+    if (snap.sequence != acked || client.sent[acked % kHistory].sequence != acked) {
+        return nullptr;
+    }
+    return &snap;
+}
+
+bool ReplicationSystem::WriteSnapshot(cgs::ecs::Entity viewer, std::vector<uint8_t>& out) {
+    auto it = clients_.find(viewer);
+    if (it == clients_.end() || sequence_ == 0) {
+        return false;
+    }
+    Client& client = it->second;
+    const ReplicationSnapshot& snap = history_[sequence_ % kHistory];
+
+    view_.clear();
+    if (world_ != nullptr) {
+        for (const auto subject : world_->InterestSet(viewer)) {
+            view_.push_back(subject.id());
+        }
+        view_.push_back(viewer.id());
+        std::erase_if(view_, [&](uint32_t id) { return snap.Find(id) == snap.ids.size(); });
+        std::sort(view_.begin(), view_.end());
+        view_.erase(std::unique(view_.begin(), view_.end()), view_.end());
+    } else {
+        view_.assign(snap.ids.begin(), snap.ids.end());
+    }
+
+    const ReplicationSnapshot* base = baseline(client);
+    static const std::vector<uint32_t> kNoEntities;
+    const std::vector<uint32_t>& baseView =
+        base != nullptr ? client.sent[base->sequence % kHistory].ids : kNoEntities;
+
+    BitWriter writer(out);
+    writer.Bits(sequence_, 32);
+    writer.Bits(base != nullptr ? base->sequence : 0, 32);
+
+    uint32_t next = 0;
+    auto record = [&](uint32_t id, RecordOp op) {
+        writer.Bits(1, 1);
+        writer.Compact(id - next);
+        writer.Bits(static_cast<uint32_t>(op), 2);
+        next = id + 1;
+    };
+    auto fullBlob = [&](const uint8_t* row, std::size_t c) {
+        writer.Bytes(row + replicators_[c].offset, replicators_[c].layout.blobSize);
+    };
+
+    std::size_t v = 0;
+    std::size_t b = 0;
+    while (v < view_.size() || b < baseView.size()) {
+        if (b == baseView.size() || (v < view_.size() && view_[v] < baseView[b])) {
+            const uint32_t id = view_[v++];
+            const std::size_t row = snap.Find(id);
+            const uint32_t mask = snap.masks[row];
+            const uint8_t* data = snap.data.data() + row * stride_;
+            record(id, RecordOp::Create);
+            for (std::size_t c = 0; c < replicators_.size(); ++c) {
+                writer.Bits(HasComponent(mask, c) ? 1 : 0, 1);
+                if (HasComponent(mask, c)) {
+                    fullBlob(data, c);
+                }
+            }
+            continue;
+        }
+        if (v == view_.size() || baseView[b] < view_[v]) {
+            record(baseView[b++], RecordOp::Remove);
+            continue;
+        }
+
+        const uint32_t id = view_[v++];
+        ++b;
+        const std::size_t row = snap.Find(id);
+        const std::size_t oldRow = base->Find(id);
+        const uint32_t mask = snap.masks[row];
+        const uint32_t oldMask = base->masks[oldRow];
+        const uint8_t* data = snap.data.data() + row * stride_;
+        const uint8_t* old = base->data.data() + oldRow * stride_;
+        if (mask == oldMask && std::memcmp(data, old, stride_) == 0) {
+            continue;
+        }
+
+        record(id, RecordOp::Update);
+        for (std::size_t c = 0; c < replicators_.size(); ++c) {
+            const bool present = HasComponent(mask, c);
+            writer.Bits(present ? 1 : 0, 1);
+            if (!present) {
+                continue;
+            }
+            if (!HasComponent(oldMask, c)) {
+                fullBlob(data, c);
+                continue;
+            }
+            const ReplicatedLayout& layout = replicators_[c].layout;
+            const uint8_t* now = data + replicators_[c].offset;
+            const uint8_t* then = old + replicators_[c].offset;
+            const bool changed = std::memcmp(now, then, layout.blobSize) != 0;
+            writer.Bits(changed ? 1 : 0, 1);
+            if (!changed) {
+                continue;
+            }
+            for (std::size_t f = 0; f < layout.fieldSizes.size(); ++f) {
+                const std::size_t at = layout.fieldOffsets[f];
+                const bool fieldChanged =
+                    std::memcmp(now + at, then + at, layout.fieldSizes[f]) != 0;
+                writer.Bits(fieldChanged ? 1 : 0, 1);
+                if (fieldChanged) {
+                    writer.Bytes(now + at, layout.fieldSizes[f]);
+                }
+            }
+        }
+    }
+    writer.Bits(0, 1);
+    writer.Flush();
+
+    SentView& sent = client.sent[sequence_ % kHistory];
+    sent.sequence = sequence_;
+    sent.ids.assign(view_.begin(), view_.end());
+    return true;
+}
+
+// ── ReplicaState ────────────────────────────────────────────────────────
+
+std::optional<uint32_t> ReplicaState::Apply(std::span<const uint8_t> packet) {
+    BitReader reader(packet);
+    uint32_t sequence = 0;
+    uint32_t baseSequence = 0;
+    if (!reader.Read(32, sequence) || !reader.Read(32, baseSequence) || sequence == 0 ||
+        (baseSequence != 0 && baseSequence >= sequence)) {
+        return std::nullopt;
+    }
+    if (history_[sequence % ReplicationSystem::kHistory].sequence > sequence) {
+        return std::nullopt;  // Older than what its ring slot now holds.
+    }
+
+    static const ReplicationSnapshot kEmpty;
+    const ReplicationSnapshot* base = &kEmpty;
+    if (baseSequence != 0) {
+        base = &history_[baseSequence % ReplicationSystem::kHistory];
+        if (base->sequence != baseSequence) {
+            return std::nullopt;
+        }
+    }
+
+    ReplicationSnapshot& snap = scratch_;
+    snap.sequence = sequence;
+    snap.ids.clear();
+    snap.masks.clear();
+    snap.data.clear();
+
+    std::size_t b = 0;
+    auto copyBaseRow = [&](std::size_t row) {
+        snap.ids.push_back(base->ids[row]);
+        snap.masks.push_back(base->masks[row]);
+        const auto first = base->data.begin() + static_cast<std::ptrdiff_t>(row * stride_);
+        snap.data.insert(snap.data.end(), first, first + static_cast<std::ptrdiff_t>(stride_));
+    };
+
+    uint64_t next = 0;
+    for (;;) {
+        uint32_t more = 0;
+        if (!reader.Read(1, more)) {
+            return std::nullopt;
+        }
+        if (more == 0) {
+            break;
+        }
+        uint32_t delta = 0;
+        uint32_t opBits = 0;
+        if (!reader.ReadCompact(delta) || !reader.Read(2, opBits) ||
+            next + delta > UINT32_MAX) {
+            return std::nullopt;
+        }
+        const auto id = static_cast<uint32_t>(next + delta);
+        next = uint64_t{id} + 1;
+
+        while (b < base->ids.size() && base->ids[b] < id) {
+            copyBaseRow(b++);
+        }
+        const bool known = b < base->ids.size() && base->ids[b] == id;
+        const auto op = static_cast<RecordOp>(opBits);
+
+        if (op == RecordOp::Remove) {
+            if (!known) {
+                return std::nullopt;
+            }
+            ++b;
+            continue;
+        }
+        if (op == RecordOp::Create) {
+            if (known) {
+                return std::nullopt;
+            }
+            snap.ids.push_back(id);
+            snap.masks.push_back(0);
+            snap.data.resize(snap.data.size() + stride_, 0);
+        } else if (op == RecordOp::Update) {
+            if (!known) {
+                return std::nullopt;
+            }
+            copyBaseRow(b++);
+        } else {
+            return std::nullopt;
+        }
+
+        uint32_t& mask = snap.masks.back();
+        uint8_t* row = snap.data.data() + snap.data.size() - stride_;
+        const uint32_t oldMask = mask;
+        for (std::size_t c = 0; c < layouts_.size(); ++c) {
+            const ReplicatedLayout& layout = layouts_[c];
+            uint8_t* blob = row + offsets_[c];
+            uint32_t present = 0;
+            if (!reader.Read(1, present)) {
+                return std::nullopt;
+            }
+            if (present == 0) {
+                mask &= ~(1u << c);
+                std::memset(blob, 0, layout.blobSize);
+                continue;
+            }
+            mask |= 1u << c;
+            if (op == RecordOp::Create || !HasComponent(oldMask, c)) {
+                if (!reader.ReadBytes(blob, layout.blobSize)) {
+                    return std::nullopt;
+                }
+                continue;
+            }
+            uint32_t changed = 0;
+            if (!reader.Read(1, changed)) {
+                return std::nullopt;
+            }
+            if (changed == 0) {
+                continue;
+            }
+            for (std::size_t f = 0; f < layout.fieldSizes.size(); ++f) {
+                uint32_t fieldChanged = 0;
+                if (!reader.Read(1, fieldChanged)) {
+                    return std::nullopt;
+                }
+                if (fieldChanged != 0 &&
+                    !reader.ReadBytes(blob + layout.fieldOffsets[f], layout.fieldSizes[f])) {
+                    return std::nullopt;
+                }
+            }
+        }
+    }
+    while (b < base->ids.size()) {
+        copyBaseRow(b++);
+    }
+
+    std::swap(history_[sequence % ReplicationSystem::kHistory], scratch_);
+    latest_ = std::max(latest_, sequence);
+    return sequence;
+}
+
+const ReplicationSnapshot* ReplicaState::current() const noexcept {
+    const ReplicationSnapshot& snap = history_[latest_ % ReplicationSystem::kHistory];
+    return latest_ != 0 && snap.sequence == latest_ ? &snap : nullptr;
+}
+
+std::span<const uint32_t> ReplicaState::Entities() const noexcept {
+    const ReplicationSnapshot* snap = current();
+    if (snap == nullptr) {
+        return {};
+    }
+    return snap->ids;
+}
+
+}  // namespace cgs::game
@@ -11,14 +11,33 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <optional>
 
 namespace cgs::game {
 
+namespace {
+
+/// Chebyshev distance between two cells.
+[[nodiscard]] int32_t CellDistance(CellCoord a, CellCoord b) noexcept {
+    return std::max(std::abs(a.x - b.x), std::abs(a.y - b.y));
+}
+
+/// Cells (Chebyshev) within which a viewer with @p range sees subjects.
+[[nodiscard]] int32_t EnterRing(float range, float cellSize) noexcept {
+    return static_cast<int32_t>(std::ceil(std::max(range, 0.0f) / cellSize));
+}
+
+}  // namespace
+
 // ═══════════════════════════════════════════════════════════════════════════
 // SpatialIndex implementation
 // ═══════════════════════════════════════════════════════════════════════════
 
-SpatialIndex::SpatialIndex(float cellSize) : cellSize_(cellSize) {
+SpatialIndex::SpatialIndex(float cellSize, uint32_t coarseFactor)
+    : cellSize_(cellSize),
+      coarseFactor_(coarseFactor > 1 ? static_cast<int32_t>(std::min(coarseFactor, 1024u)) : 0) {
     if (cellSize_ <= 0.0f) {
         cellSize_ = kDefaultCellSize;
     }
@@ -30,112 +49,259 @@ void SpatialIndex::Insert(cgs::ecs::Entity entity, const Vector3& position) {
         Update(entity, position);
         return;
     }
-    auto cell = WorldToCell(position);
-    addToCell(entity, cell);
-    entityCells_[entity] = cell;
+    // A stale handle with the same id is replaced.
+    removeFromCell(entity.id());
+    addToCell(entity, findOrAddCell(WorldToCell(position)), position);
 }
 
 void SpatialIndex::Update(cgs::ecs::Entity entity, const Vector3& newPosition) {
-    auto it = entityCells_.find(entity);
-    if (it == entityCells_.end()) {
+    if (!Contains(entity)) {
         Insert(entity, newPosition);
         return;
     }
 
-    auto newCell = WorldToCell(newPosition);
-    if (it->second == newCell) {
-        return;  // Still in the same cell.
+    const uint32_t cellIndex = cellOf_.Get(entity.id());
+    const CellCoord newCell = WorldToCell(newPosition);
+    if (cells_[cellIndex].coord == newCell) {
+        // Still in the same cell: only the stored position changes.
+        const uint32_t slot = slotOf_.Get(entity.id());
+        cells_[cellIndex].xs[slot] = newPosition.x;
+        cells_[cellIndex].zs[slot] = newPosition.z;
+        return;
     }
 
-    removeFromCell(entity, it->second);
-    addToCell(entity, newCell);
-    it->second = newCell;
+    removeFromCell(entity.id());
+    addToCell(entity, findOrAddCell(newCell), newPosition);
 }
 
-void SpatialIndex::Remove(cgs::ecs::Entity entity) {
-    auto it = entityCells_.find(entity);
-    if (it == entityCells_.end()) {
+void SpatialIndex::UpdateBatch(std::span<const SpatialUpdate> updates) {
+    moves_.clear();
+    for (const auto& update : updates) {
+        const CellCoord cell = WorldToCell(update.position);
+        if (Contains(update.entity)) {
+            const uint32_t id = update.entity.id();
+            Cell& current = cells_[cellOf_.Get(id)];
+            if (current.coord == cell) {
+                const uint32_t slot = slotOf_.Get(id);
+                current.xs[slot] = update.position.x;
+                current.zs[slot] = update.position.z;
+                continue;
+            }
+        }
+        moves_.push_back(CellMove{MortonCode(cell), cell, update.entity, update.position});
+    }
+    if (moves_.empty()) {
         return;
     }
-    removeFromCell(entity, it->second);
-    entityCells_.erase(it);
+
+    std::sort(moves_.begin(), moves_.end(),
+              [](const CellMove& lhs, const CellMove& rhs) { return lhs.key < rhs.key; });
+
+    // Vacate every source row first (this also drops stale handles of a
+    // reused id), then fill each destination cell in one run.
+    for (const auto& move : moves_) {
+        removeFromCell(move.entity.id());
+    }
+    for (std::size_t begin = 0; begin < moves_.size();) {
+        std::size_t end = begin + 1;
+        while (end < moves_.size() && moves_[end].key == moves_[begin].key) {
+            ++end;
+        }
+
+        const uint32_t cellIndex = findOrAddCell(moves_[begin].cell);
+        Cell& cell = cells_[cellIndex];
+        const std::size_t rows = cell.entities.size() + (end - begin);
+        cell.entities.reserve(rows);
+        cell.xs.reserve(rows);
+        cell.zs.reserve(rows);
+        for (std::size_t i = begin; i < end; ++i) {
+            // Only a duplicate entry can still be tracked here.
+            removeFromCell(moves_[i].entity.id());
+            addToCell(moves_[i].entity, cellIndex, moves_[i].position);
+        }
+        begin = end;
+    }
+}
+
+void SpatialIndex::Remove(cgs::ecs::Entity entity) {
+    if (Contains(entity)) {
+        removeFromCell(entity.id());
+    }
 }
 
 void SpatialIndex::Clear() {
+    if (logChanges_) {
+        for (const Cell& cell : cells_) {
+            for (const auto entity : cell.entities) {
+                changes_.push_back(CellChange{entity, cell.coord, false});
+            }
+        }
+    }
+    table_.Clear();
     cells_.clear();
-    entityCells_.clear();
+    coarseTable_.Clear();
+    coarseCells_.clear();
+    cellOf_.Clear();
+    slotOf_.Clear();
+    size_ = 0;
+    areas_.clear();
 }
 
-std::vector<cgs::ecs::Entity> SpatialIndex::QueryRadius(const Vector3& center, float radius) const {
-    std::vector<cgs::ecs::Entity> result;
-
-    if (radius <= 0.0f) {
-        return result;
+void SpatialIndex::InsertArea(uint32_t area, const Vector3& center, float radius) {
+    RemoveArea(area);
+    if (!(radius > 0.0f)) {
+        return;
     }
-
-    // Determine the range of cells overlapping the query circle.
-    int32_t minCellX = static_cast<int32_t>(std::floor((center.x - radius) / cellSize_));
-    int32_t maxCellX = static_cast<int32_t>(std::floor((center.x + radius) / cellSize_));
-    int32_t minCellY = static_cast<int32_t>(std::floor((center.z - radius) / cellSize_));
-    int32_t maxCellY = static_cast<int32_t>(std::floor((center.z + radius) / cellSize_));
-
-    for (int32_t cx = minCellX; cx <= maxCellX; ++cx) {
-        for (int32_t cy = minCellY; cy <= maxCellY; ++cy) {
-            auto it = cells_.find(CellCoord{cx, cy});
-            if (it == cells_.end()) {
-                continue;
+    const CellCoord min = WorldToCell(Vector3{center.x - radius, 0.0f, center.z - radius});
+    const CellCoord max = WorldToCell(Vector3{center.x + radius, 0.0f, center.z + radius});
+    const CircleXZ circle = CircleXZ::Make(center, radius);
+    for (int32_t x = min.x; x <= max.x; ++x) {
+        for (int32_t y = min.y; y <= max.y; ++y) {
+            // Skip box corners the circle does not reach.
+            const float left = static_cast<float>(x) * cellSize_;
+            const float top = static_cast<float>(y) * cellSize_;
+            const float dx = center.x - std::clamp(center.x, left, left + cellSize_);
+            const float dz = center.z - std::clamp(center.z, top, top + cellSize_);
+            if (dx * dx + dz * dz <= circle.radiusSq) {
+                cells_[findOrAddCell(CellCoord{x, y})].areas.push_back(CellArea{area, circle});
             }
-            for (auto entity : it->second) {
-                // We need the entity's actual position for exact distance check.
-                // Since SpatialIndex doesn't store positions, we use the cell center
-                // as a conservative check.  For exact filtering, the caller should
-                // do a final distance check using the entity's Transform.
-                //
-                // However, to keep the API self-contained, we use a cell-overlap
-                // approach: all entities in overlapping cells are returned, and the
-                // caller is expected to do fine-grained filtering.
-                //
-                // For strict filtering, we would need to store positions.
-                // We store positions for exact filtering.
-                result.push_back(entity);
+        }
+    }
+    areas_.emplace(area, std::make_pair(min, max));
+}
+
+void SpatialIndex::RemoveArea(uint32_t area) {
+    auto it = areas_.find(area);
+    if (it == areas_.end()) {
+        return;
+    }
+    const auto [min, max] = it->second;
+    for (int32_t x = min.x; x <= max.x; ++x) {
+        for (int32_t y = min.y; y <= max.y; ++y) {
+            const uint32_t index = table_.Find(CellCoord{x, y}, cells_);
+            if (index != detail::CellTable::kNone) {
+                std::erase_if(cells_[index].areas,
+                              [area](const CellArea& entry) { return entry.id == area; });
             }
         }
     }
+    areas_.erase(it);
+}
 
+std::vector<cgs::ecs::Entity> SpatialIndex::QueryRadius(const Vector3& center, float radius) const {
+    std::vector<cgs::ecs::Entity> result;
+    QueryRadius(center, radius, result);
+    return result;
+}
+
+void SpatialIndex::QueryRadius(const Vector3& center,
+                               float radius,
+                               std::pmr::vector<cgs::ecs::Entity>& out) const {
+    ForEachInRadius(center, radius, [&out](cgs::ecs::Entity entity) { out.push_back(entity); });
+}
+
+void SpatialIndex::QueryRadius(const Vector3& center,
+                               float radius,
+                               std::vector<cgs::ecs::Entity>& out) const {
+    ForEachInRadius(center, radius, [&out](cgs::ecs::Entity entity) { out.push_back(entity); });
+}
+
+std::vector<cgs::ecs::Entity> SpatialIndex::QueryCone(const Vector3& apex,
+                                                     const Vector3& direction,
+                                                     float radius,
+                                                     float halfAngle) const {
+    std::vector<cgs::ecs::Entity> result;
+    ForEachInCone(apex, direction, radius, halfAngle,
+                  [&result](cgs::ecs::Entity entity) { result.push_back(entity); });
+    return result;
+}
+
+std::vector<cgs::ecs::Entity> SpatialIndex::QueryBox(const Vector3& min, const Vector3& max) const {
+    std::vector<cgs::ecs::Entity> result;
+    ForEachInBox(min, max, [&result](cgs::ecs::Entity entity) { result.push_back(entity); });
+    return result;
+}
+
+std::vector<cgs::ecs::Entity> SpatialIndex::QueryNearest(const Vector3& center,
+                                                        std::size_t k,
+                                                        float maxRadius) const {
+    std::vector<cgs::ecs::Entity> result;
+    QueryNearest(center, k, result, [](cgs::ecs::Entity) { return true; }, maxRadius);
     return result;
 }
 
 std::vector<cgs::ecs::Entity> SpatialIndex::QueryPosition(const Vector3& pos) const {
-    auto cell = WorldToCell(pos);
-    return QueryCell(cell.x, cell.y);
+    auto cells = CellEntities(WorldToCell(pos));
+    return {cells.begin(), cells.end()};
 }
 
 std::vector<cgs::ecs::Entity> SpatialIndex::QueryCell(int32_t x, int32_t y) const {
-    auto it = cells_.find(CellCoord{x, y});
-    if (it == cells_.end()) {
-        return {};
-    }
-    return it->second;
+    auto cells = CellEntities(CellCoord{x, y});
+    return {cells.begin(), cells.end()};
 }
 
 bool SpatialIndex::Contains(cgs::ecs::Entity entity) const {
-    return entityCells_.contains(entity);
+    const uint32_t cellIndex = cellOf_.Get(entity.id());
+    if (cellIndex == cgs::ecs::SparsePageTable::kInvalidIndex) {
+        return false;
+    }
+    return cells_[cellIndex].entities[slotOf_.Get(entity.id())] == entity;
 }
 
-void SpatialIndex::removeFromCell(cgs::ecs::Entity entity, CellCoord cell) {
-    auto it = cells_.find(cell);
-    if (it == cells_.end()) {
-        return;
+uint32_t SpatialIndex::findOrAddCell(CellCoord coord) {
+    const auto [index, added] = table_.FindOrAdd(coord, cells_);
+    if (added) {
+        if (cells_.size() == 1) {
+            cellMin_ = coord;
+            cellMax_ = coord;
+        } else {
+            cellMin_ = {std::min(cellMin_.x, coord.x), std::min(cellMin_.y, coord.y)};
+            cellMax_ = {std::max(cellMax_.x, coord.x), std::max(cellMax_.y, coord.y)};
+        }
+    }
+    if (added && coarseFactor_ > 1) {
+        const uint32_t coarse = coarseTable_.FindOrAdd(toCoarse(coord), coarseCells_).first;
+        coarseCells_[coarse].cells.push_back(index);
     }
-    auto& vec = it->second;
-    std::erase(vec, entity);
-    if (vec.empty()) {
-        cells_.erase(it);
+    return index;
+}
+
+void SpatialIndex::addToCell(cgs::ecs::Entity entity, uint32_t cellIndex, const Vector3& position) {
+    Cell& cell = cells_[cellIndex];
+    cellOf_.Set(entity.id(), cellIndex);
+    slotOf_.Set(entity.id(), static_cast<uint32_t>(cell.entities.size()));
+    cell.entities.push_back(entity);
+    cell.xs.push_back(position.x);
+    cell.zs.push_back(position.z);
+    ++size_;
+    if (logChanges_) {
+        changes_.push_back(CellChange{entity, cell.coord, true});
     }
 }
 
-void SpatialIndex::addToCell(cgs::ecs::Entity entity, CellCoord cell) {
-    cells_[cell].push_back(entity);
+void SpatialIndex::removeFromCell(uint32_t id) {
+    const uint32_t cellIndex = cellOf_.Get(id);
+    if (cellIndex == cgs::ecs::SparsePageTable::kInvalidIndex) {
+        return;
+    }
+    Cell& cell = cells_[cellIndex];
+    const uint32_t slot = slotOf_.Get(id);
+    if (logChanges_) {
+        changes_.push_back(CellChange{cell.entities[slot], cell.coord, false});
+    }
+    const uint32_t last = static_cast<uint32_t>(cell.entities.size() - 1);
+    if (slot != last) {
+        cell.entities[slot] = cell.entities[last];
+        cell.xs[slot] = cell.xs[last];
+        cell.zs[slot] = cell.zs[last];
+        slotOf_.Update(cell.entities[slot].id(), slot);
+    }
+    cell.entities.pop_back();
+    cell.xs.pop_back();
+    cell.zs.pop_back();
+    cellOf_.Reset(id);
+    slotOf_.Reset(id);
+    --size_;
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -155,84 +321,428 @@ WorldSystem::WorldSystem(cgs::ecs::ComponentStorage<Transform>& transforms,
       zones_(zones),
       cellSize_(cellSize) {}
 
-void WorldSystem::Execute(float /*deltaTime*/) {
+void WorldSystem::Execute(float deltaTime) {
     synchronizePositions();
+    updateAreaEffects(deltaTime);
+    updateInterest();
+    reorderTransforms();
+    refreshZoneIndex();
 }
 
 cgs::ecs::SystemAccessInfo WorldSystem::GetAccessInfo() const {
     cgs::ecs::SystemAccessInfo info;
     cgs::ecs::Read<Transform, MapMembership, MapInstance, VisibilityRange, Zone>::Apply(info);
+    if (reorderBudget_ > 0) {
+        // Reordering moves Transform components between dense slots.
+        cgs::ecs::Write<Transform>::Apply(info);
+    }
     return info;
 }
 
 void WorldSystem::synchronizePositions() {
+    // Only entities whose position or map changed since the previous
+    // scheduled run need re-indexing; idle NPCs are skipped.
+    const uint32_t since = LastRunVersion();
+
+    for (auto& [map, sync] : syncBatches_) {
+        sync.updates.clear();
+    }
+
+    cgs::ecs::Entity lastMap;
+    MapSync* batch = nullptr;
     for (std::size_t i = 0; i < memberships_.Size(); ++i) {
         auto entityId = memberships_.EntityAt(i);
         cgs::ecs::Entity entity(entityId, 0);
-        const auto& membership = memberships_.Get(entity);
 
         if (!transforms_.Has(entity)) {
             continue;
         }
 
-        const auto& transform = transforms_.Get(entity);
+        if (!transforms_.HasChanged(entity, since) && !memberships_.HasChanged(entity, since)) {
+            continue;
+        }
 
-        // Ensure a spatial index exists for this map.
-        auto& index = spatialIndices_.try_emplace(membership.mapEntity, cellSize_).first->second;
+        const auto& membership = memberships_.Get(entity);
+        if (batch == nullptr || membership.mapEntity != lastMap) {
+            // Ensure a spatial index exists for this map.
+            lastMap = membership.mapEntity;
+            batch = &syncBatches_[lastMap];
+            batch->index = &indexFor(lastMap);
+        }
+        batch->updates.push_back(SpatialUpdate{entity, transforms_.Get(entity).position});
+    }
 
-        // Insert or update the entity position.
-        index.Update(entity, transform.position);
+    // Maps are independent: apply each map's batch as its own task.
+    syncTasks_.clear();
+    for (auto& [map, sync] : syncBatches_) {
+        if (!sync.updates.empty()) {
+            syncTasks_.emplace_back([&sync] { sync.index->UpdateBatch(sync.updates); });
+        }
+    }
+    if (syncTasks_.size() > 1 && parallelExecutor_) {
+        parallelExecutor_(syncTasks_);
+    } else {
+        for (const auto& task : syncTasks_) {
+            task();
+        }
     }
 
     // Stale entries are cleaned up when entities are transferred
     // (via TransferEntity) or destroyed by the EntityManager.
 }
 
-std::vector<cgs::ecs::Entity> WorldSystem::GetVisibleEntities(cgs::ecs::Entity viewer) const {
-    if (!memberships_.Has(viewer) || !transforms_.Has(viewer)) {
-        return {};
+void WorldSystem::reorderTransforms() {
+    if (reorderBudget_ == 0 || transforms_.Owner() != nullptr) {
+        return;
+    }
+    if (reorderCursor_ >= reorderPlan_.size()) {
+        planReorder();
+        if (reorderPlan_.empty()) {
+            return;
+        }
     }
 
-    const auto& membership = memberships_.Get(viewer);
-    const auto& transform = transforms_.Get(viewer);
+    // Entities destroyed since the snapshot are skipped; ones spawned since
+    // stay behind the ordered prefix until the next pass.
+    uint32_t moved = 0;
+    while (moved < reorderBudget_ && reorderCursor_ < reorderPlan_.size()) {
+        const cgs::ecs::Entity entity(reorderPlan_[reorderCursor_++], 0);
+        if (!transforms_.Has(entity) || reorderPlaced_ >= transforms_.Size()) {
+            continue;
+        }
+        transforms_.SwapDense(reorderPlaced_++, transforms_.IndexOf(entity));
+        ++moved;
+    }
 
-    float range = kDefaultVisibilityRange;
-    if (visibilityRanges_.Has(viewer)) {
-        range = visibilityRanges_.Get(viewer).range;
+    if (reorderCursor_ >= reorderPlan_.size()) {
+        ++reorderPasses_;
     }
+}
 
-    return QueryRadius(membership.mapEntity, transform.position, range);
+void WorldSystem::planReorder() {
+    struct Key {
+        uint32_t map;
+        uint64_t cell;
+        uint32_t entity;
+    };
+
+    const float cellSize = cellSize_ > 0.0f ? cellSize_ : kDefaultCellSize;
+    std::pmr::vector<Key> keys(FrameMemory());
+    keys.reserve(transforms_.Size());
+    for (std::size_t i = 0; i < transforms_.Size(); ++i) {
+        const uint32_t id = transforms_.EntityAt(i);
+        const cgs::ecs::Entity entity(id, 0);
+        const auto& position = transforms_.Get(entity).position;
+        // Entities without a map sort after every map.
+        const uint32_t map = memberships_.Has(entity) ? memberships_.Get(entity).mapEntity.id()
+                                                      : std::numeric_limits<uint32_t>::max();
+        const CellCoord cell{static_cast<int32_t>(std::floor(position.x / cellSize)),
+                             static_cast<int32_t>(std::floor(position.z / cellSize))};
+        keys.push_back(Key{map, MortonCode(cell), id});
+    }
+    std::sort(keys.begin(), keys.end(), [](const Key& lhs, const Key& rhs) {
+        return lhs.map != rhs.map ? lhs.map < rhs.map : lhs.cell < rhs.cell;
+    });
+
+    reorderPlan_.clear();
+    reorderPlan_.reserve(keys.size());
+    for (const auto& key : keys) {
+        reorderPlan_.push_back(key.entity);
+    }
+    reorderCursor_ = 0;
+    reorderPlaced_ = 0;
 }
 
-std::vector<cgs::ecs::Entity> WorldSystem::QueryRadius(cgs::ecs::Entity mapEntity,
-                                                       const Vector3& center,
-                                                       float radius) const {
+SpatialIndex& WorldSystem::indexFor(cgs::ecs::Entity mapEntity) {
     auto it = spatialIndices_.find(mapEntity);
-    if (it == spatialIndices_.end()) {
+    if (it != spatialIndices_.end()) {
+        return it->second;
+    }
+
+    float cellSize = cellSize_;
+    uint32_t coarseFactor = 0;
+    if (mapInstances_.Has(mapEntity)) {
+        const auto& map = mapInstances_.Get(mapEntity);
+        if (map.cellSize > 0.0f) {
+            cellSize = map.cellSize;
+        }
+        coarseFactor = map.coarseFactor;
+    }
+    auto& index = spatialIndices_.try_emplace(mapEntity, cellSize, coarseFactor).first->second;
+    index.SetChangeLog(interestEnabled_);
+    return index;
+}
+
+void WorldSystem::SetInterestManagement(bool enabled, uint32_t hysteresisCells) {
+    interestEnabled_ = enabled;
+    interestHysteresis_ = static_cast<int32_t>(std::min(hysteresisCells, 64u));
+    interest_.clear();
+    viewerIndices_.clear();
+    interestEvents_.clear();
+    for (auto& [map, index] : spatialIndices_) {
+        index.SetChangeLog(enabled);
+    }
+}
+
+std::span<const cgs::ecs::Entity> WorldSystem::InterestSet(cgs::ecs::Entity viewer) const {
+    auto it = interest_.find(viewer);
+    if (it == interest_.end()) {
         return {};
     }
+    return it->second.visible;
+}
 
-    // Get candidate entities from the spatial grid.
-    auto candidates = it->second.QueryRadius(center, radius);
+void WorldSystem::updateInterest() {
+    interestEvents_.clear();
+    if (!interestEnabled_) {
+        return;
+    }
 
-    // Exact distance filtering using entity transforms.
-    float radiusSq = radius * radius;
-    std::vector<cgs::ecs::Entity> result;
-    result.reserve(candidates.size());
+    // Viewers that lost a required component or changed maps start over.
+    for (auto it = interest_.begin(); it != interest_.end();) {
+        const cgs::ecs::Entity viewer = it->first;
+        if (visibilityRanges_.Has(viewer) && memberships_.Has(viewer) && transforms_.Has(viewer) &&
+            memberships_.Get(viewer).mapEntity == it->second.map) {
+            ++it;
+            continue;
+        }
+        dropInterest(viewer, it->second);
+        if (auto viewers = viewerIndices_.find(it->second.map); viewers != viewerIndices_.end()) {
+            viewers->second.Remove(viewer);
+        }
+        it = interest_.erase(it);
+    }
 
-    for (auto entity : candidates) {
-        if (!transforms_.Has(entity)) {
+    // New viewers and viewers that crossed a cell are rebuilt in full.
+    recomputedViewers_.clear();
+    maxInterestRing_ = 0;
+    for (std::size_t i = 0; i < visibilityRanges_.Size(); ++i) {
+        const cgs::ecs::Entity viewer(visibilityRanges_.EntityAt(i), 0);
+        if (!memberships_.Has(viewer) || !transforms_.Has(viewer)) {
             continue;
         }
-        const auto& pos = transforms_.Get(entity).position;
-        auto diff = pos - center;
-        // Use XZ distance (2D, Y is up).
-        float distSq = diff.x * diff.x + diff.z * diff.z;
-        if (distSq <= radiusSq) {
-            result.push_back(entity);
+        const cgs::ecs::Entity map = memberships_.Get(viewer).mapEntity;
+        const Vector3& position = transforms_.Get(viewer).position;
+        const SpatialIndex& index = indexFor(map);
+        const CellCoord cell = index.WorldToCell(position);
+        const int32_t ring = EnterRing(visibilityRanges_.Get(viewer).range, index.CellSize());
+        maxInterestRing_ = std::max(maxInterestRing_, ring + interestHysteresis_);
+
+        auto [it, added] = interest_.try_emplace(viewer);
+        ViewerInterest& interest = it->second;
+        if (added || interest.cell != cell || interest.enterRing != ring) {
+            interest.map = map;
+            interest.cell = cell;
+            interest.enterRing = ring;
+            recomputeInterest(viewer, interest, index);
+            recomputedViewers_.push_back(viewer);
+        }
+        viewerIndices_.try_emplace(map, index.CellSize()).first->second.Update(viewer, position);
+    }
+    std::sort(recomputedViewers_.begin(), recomputedViewers_.end());
+
+    // Subjects that crossed cells near the remaining viewers.
+    for (auto& [map, index] : spatialIndices_) {
+        if (!index.Changes().empty()) {
+            applySubjectChanges(map, index);
+            index.ClearChanges();
+        }
+    }
+
+    // Visible subjects that moved; ones destroyed in place are dropped.
+    const uint32_t since = LastRunVersion();
+    for (auto& [viewer, interest] : interest_) {
+        std::erase_if(interest.visible, [&, viewer = viewer](cgs::ecs::Entity subject) {
+            if (!transforms_.Has(subject)) {
+                interestEvents_.push_back(InterestEvent{viewer, subject, InterestChange::Leave});
+                return true;
+            }
+            if (transforms_.HasChanged(subject, since)) {
+                interestEvents_.push_back(InterestEvent{viewer, subject, InterestChange::Update});
+            }
+            return false;
+        });
+    }
+
+    // Enter sorts before Update, so an Update right after an Enter of the
+    // same pair is redundant.
+    std::sort(interestEvents_.begin(), interestEvents_.end(),
+              [](const InterestEvent& lhs, const InterestEvent& rhs) {
+                  if (lhs.viewer != rhs.viewer) {
+                      return lhs.viewer < rhs.viewer;
+                  }
+                  if (lhs.subject != rhs.subject) {
+                      return lhs.subject < rhs.subject;
+                  }
+                  return lhs.change < rhs.change;
+              });
+    const auto last = std::unique(interestEvents_.begin(), interestEvents_.end(),
+                                  [](const InterestEvent& kept, const InterestEvent& next) {
+                                      return kept.viewer == next.viewer &&
+                                             kept.subject == next.subject &&
+                                             kept.change == InterestChange::Enter &&
+                                             next.change == InterestChange::Update;
+                                  });
+    interestEvents_.erase(last, interestEvents_.end());
+}
+
+void WorldSystem::recomputeInterest(cgs::ecs::Entity viewer, ViewerInterest& interest,
+                                    const SpatialIndex& index) {
+    // Subjects inside the enter ring are in; between it and the keep ring
+    // only those already visible stay (hysteresis).
+    const int32_t keep = interest.enterRing + interestHysteresis_;
+    interestScratch_.clear();
+    for (int32_t dx = -keep; dx <= keep; ++dx) {
+        for (int32_t dy = -keep; dy <= keep; ++dy) {
+            const bool entering = std::max(std::abs(dx), std::abs(dy)) <= interest.enterRing;
+            const CellCoord cell{interest.cell.x + dx, interest.cell.y + dy};
+            for (const auto subject : index.CellEntities(cell)) {
+                // Index entries of destroyed entities linger until removed.
+                if (subject != viewer && transforms_.Has(subject) &&
+                    (entering || std::binary_search(interest.visible.begin(),
+                                                    interest.visible.end(), subject))) {
+                    interestScratch_.push_back(subject);
+                }
+            }
+        }
+    }
+    std::sort(interestScratch_.begin(), interestScratch_.end());
+
+    // Merge the sorted old and new sets into Enter / Leave events.
+    auto before = interest.visible.begin();
+    auto after = interestScratch_.begin();
+    while (before != interest.visible.end() || after != interestScratch_.end()) {
+        if (after == interestScratch_.end() ||
+            (before != interest.visible.end() && *before < *after)) {
+            interestEvents_.push_back(InterestEvent{viewer, *before++, InterestChange::Leave});
+        } else if (before == interest.visible.end() || *after < *before) {
+            interestEvents_.push_back(InterestEvent{viewer, *after++, InterestChange::Enter});
+        } else {
+            ++before;
+            ++after;
+        }
+    }
+    interest.visible.assign(interestScratch_.begin(), interestScratch_.end());
+}
+
+void WorldSystem::applySubjectChanges(cgs::ecs::Entity mapEntity, const SpatialIndex& index) {
+    auto viewers = viewerIndices_.find(mapEntity);
+    if (viewers == viewerIndices_.end() || viewers->second.Size() == 0) {
+        return;
+    }
+    const SpatialIndex& viewerIndex = viewers->second;
+    const float cellSize = index.CellSize();
+
+    changeScratch_.assign(index.Changes().begin(), index.Changes().end());
+    std::stable_sort(changeScratch_.begin(), changeScratch_.end(),
+                     [](const CellChange& lhs, const CellChange& rhs) {
+                         return lhs.entity < rhs.entity;
+                     });
+
+    for (std::size_t begin = 0; begin < changeScratch_.size();) {
+        const cgs::ecs::Entity subject = changeScratch_[begin].entity;
+        std::size_t end = begin;
+
+        // Any viewer that sees, or could now see, the subject is within
+        // maxInterestRing_ cells of a cell it left or entered.
+        candidateViewers_.clear();
+        for (; end < changeScratch_.size() && changeScratch_[end].entity == subject; ++end) {
+            const CellCoord cell = changeScratch_[end].cell;
+            const Vector3 min(static_cast<float>(cell.x - maxInterestRing_) * cellSize, 0.0f,
+                              static_cast<float>(cell.y - maxInterestRing_) * cellSize);
+            const Vector3 max(static_cast<float>(cell.x + maxInterestRing_ + 1) * cellSize, 0.0f,
+                              static_cast<float>(cell.y + maxInterestRing_ + 1) * cellSize);
+            viewerIndex.ForEachInBox(min, max, [this](cgs::ecs::Entity viewer) {
+                candidateViewers_.push_back(viewer);
+            });
+        }
+        begin = end;
+        std::sort(candidateViewers_.begin(), candidateViewers_.end());
+        candidateViewers_.erase(std::unique(candidateViewers_.begin(), candidateViewers_.end()),
+                                candidateViewers_.end());
+
+        const std::optional<CellCoord> now = index.CellOf(subject);
+        for (const auto viewer : candidateViewers_) {
+            if (viewer == subject || std::binary_search(recomputedViewers_.begin(),
+                                                        recomputedViewers_.end(), viewer)) {
+                continue;
+            }
+            auto it = interest_.find(viewer);
+            if (it == interest_.end()) {
+                continue;
+            }
+            ViewerInterest& interest = it->second;
+            auto pos = std::lower_bound(interest.visible.begin(), interest.visible.end(), subject);
+            const bool visible = pos != interest.visible.end() && *pos == subject;
+            const int32_t distance = now ? CellDistance(*now, interest.cell) : -1;
+
+            if (visible && (!now || distance > interest.enterRing + interestHysteresis_)) {
+                interest.visible.erase(pos);
+                interestEvents_.push_back(InterestEvent{viewer, subject, InterestChange::Leave});
+            } else if (!visible && now && distance <= interest.enterRing &&
+                       transforms_.Has(subject)) {
+                interest.visible.insert(pos, subject);
+                interestEvents_.push_back(InterestEvent{viewer, subject, InterestChange::Enter});
+            }
         }
     }
+}
 
+void WorldSystem::dropInterest(cgs::ecs::Entity viewer, ViewerInterest& interest) {
+    for (const auto subject : interest.visible) {
+        interestEvents_.push_back(InterestEvent{viewer, subject, InterestChange::Leave});
+    }
+    interest.visible.clear();
+}
+
+std::vector<cgs::ecs::Entity> WorldSystem::GetVisibleEntities(cgs::ecs::Entity viewer) const {
+    std::vector<cgs::ecs::Entity> result;
+    GetVisibleEntities(viewer, result);
+    return result;
+}
+
+void WorldSystem::GetVisibleEntities(cgs::ecs::Entity viewer,
+                                     std::pmr::vector<cgs::ecs::Entity>& out) const {
+    ForEachVisible(viewer, [&out](cgs::ecs::Entity entity) { out.push_back(entity); });
+}
+
+void WorldSystem::GetVisibleEntities(cgs::ecs::Entity viewer,
+                                     std::vector<cgs::ecs::Entity>& out) const {
+    ForEachVisible(viewer, [&out](cgs::ecs::Entity entity) { out.push_back(entity); });
+}
+
+std::vector<cgs::ecs::Entity> WorldSystem::QueryRadius(cgs::ecs::Entity mapEntity,
+                                                       const Vector3& center,
+                                                       float radius) const {
+    std::vector<cgs::ecs::Entity> result;
+    QueryRadius(mapEntity, center, radius, result);
+    return result;
+}
+
+void WorldSystem::QueryRadius(cgs::ecs::Entity mapEntity,
+                              const Vector3& center,
+                              float radius,
+                              std::pmr::vector<cgs::ecs::Entity>& out) const {
+    ForEachInRadius(mapEntity, center, radius,
+                    [&out](cgs::ecs::Entity entity) { out.push_back(entity); });
+}
+
+void WorldSystem::QueryRadius(cgs::ecs::Entity mapEntity,
+                              const Vector3& center,
+                              float radius,
+                              std::vector<cgs::ecs::Entity>& out) const {
+    ForEachInRadius(mapEntity, center, radius,
+                    [&out](cgs::ecs::Entity entity) { out.push_back(entity); });
+}
+
+std::vector<cgs::ecs::Entity> WorldSystem::QueryCone(cgs::ecs::Entity mapEntity,
+                                                     const Vector3& apex,
+                                                     const Vector3& direction,
+                                                     float radius,
+                                                     float halfAngle) const {
+    std::vector<cgs::ecs::Entity> result;
+    ForEachInCone(mapEntity, apex, direction, radius, halfAngle,
+                  [&result](cgs::ecs::Entity entity) { result.push_back(entity); });
     return result;
 }
 
@@ -264,27 +774,278 @@ TransitionResult WorldSystem::TransferEntity(cgs::ecs::Entity entity,
     membership.zoneId = 0;  // Reset zone; will be updated by zone logic.
 
     // Insert into new map's spatial index.
-    auto& newIndex = spatialIndices_.try_emplace(targetMapEntity, cellSize_).first->second;
-    newIndex.Insert(entity, destination);
+    indexFor(targetMapEntity).Insert(entity, destination);
+    if (!areaEffects_.empty()) {
+        areaRechecks_.push_back(entity);
+    }
 
     return TransitionResult::Success;
 }
 
+std::size_t WorldSystem::TransferEntities(std::span<const TransferRequest> requests,
+                                          std::span<TransitionResult> results) {
+    // Reuses the position sync batches, which only live within Execute().
+    for (auto& [map, sync] : syncBatches_) {
+        sync.updates.clear();
+    }
+
+    std::size_t transferred = 0;
+    for (std::size_t i = 0; i < requests.size(); ++i) {
+        const TransferRequest& request = requests[i];
+        TransitionResult result = TransitionResult::Success;
+        if (!mapInstances_.Has(request.targetMapEntity)) {
+            result = TransitionResult::InvalidMap;
+        } else if (!memberships_.Has(request.entity) || !transforms_.Has(request.entity)) {
+            result = TransitionResult::EntityNotFound;
+        }
+        if (!results.empty()) {
+            results[i] = result;
+        }
+        if (result != TransitionResult::Success) {
+            continue;
+        }
+
+        auto& membership = memberships_.Get(request.entity);
+        auto currentIt = spatialIndices_.find(membership.mapEntity);
+        if (currentIt != spatialIndices_.end()) {
+            currentIt->second.Remove(request.entity);
+        }
+
+        transforms_.Get(request.entity).position = request.destination;
+        membership.mapEntity = request.targetMapEntity;
+        membership.zoneId = 0;  // Reset zone; will be updated by zone logic.
+
+        MapSync& batch = syncBatches_[request.targetMapEntity];
+        batch.index = &indexFor(request.targetMapEntity);
+        batch.updates.push_back(SpatialUpdate{request.entity, request.destination});
+        if (!areaEffects_.empty()) {
+            areaRechecks_.push_back(request.entity);
+        }
+        ++transferred;
+    }
+
+    for (auto& [map, sync] : syncBatches_) {
+        // Drop requests superseded by a later one for the same entity.
+        std::erase_if(sync.updates, [&, &map = map](const SpatialUpdate& update) {
+            return memberships_.Get(update.entity).mapEntity != map ||
+                   transforms_.Get(update.entity).position != update.position;
+        });
+        if (!sync.updates.empty()) {
+            sync.index->UpdateBatch(sync.updates);
+            sync.updates.clear();
+        }
+    }
+    return transferred;
+}
+
+AreaEffectId WorldSystem::CreateAreaEffect(const AreaEffectDesc& desc) {
+    if (!(desc.radius > 0.0f) || desc.period < 0.0f || desc.duration < 0.0f) {
+        return kInvalidAreaEffect;
+    }
+    const AreaEffectId id = nextAreaEffect_++;
+    areaEffects_[id].desc = desc;
+    return id;
+}
+
+bool WorldSystem::RemoveAreaEffect(AreaEffectId area) {
+    auto it = areaEffects_.find(area);
+    if (it == areaEffects_.end() || it->second.ending) {
+        return false;
+    }
+    it->second.ending = true;
+    return true;
+}
+
+bool WorldSystem::HasAreaEffect(AreaEffectId area) const {
+    auto it = areaEffects_.find(area);
+    return it != areaEffects_.end() && !it->second.ending;
+}
+
+std::span<const cgs::ecs::Entity> WorldSystem::AreaEffectOccupants(AreaEffectId area) const {
+    auto it = areaEffects_.find(area);
+    if (it == areaEffects_.end()) {
+        return {};
+    }
+    return it->second.occupants;
+}
+
+void WorldSystem::updateAreaEffects(float deltaTime) {
+    areaEvents_.clear();
+    areaPulses_.clear();
+    if (areaEffects_.empty()) {
+        areaRechecks_.clear();
+        return;
+    }
+
+    // Ended areas leave the grid and their occupants exit.  The duration
+    // is checked before aging, so a pulse due on the last tick is kept.
+    for (auto it = areaEffects_.begin(); it != areaEffects_.end();) {
+        const AreaEffectId id = it->first;
+        AreaEffect& area = it->second;
+        if (area.seeded && area.desc.duration > 0.0f && area.age >= area.desc.duration) {
+            area.ending = true;
+        }
+        if (!area.ending) {
+            if (area.seeded) {
+                area.age += deltaTime;
+                area.sincePulse += deltaTime;
+                uint32_t count = 0;
+                while (area.desc.period > 0.0f && area.sincePulse >= area.desc.period) {
+                    area.sincePulse -= area.desc.period;
+                    ++count;
+                }
+                if (count > 0) {
+                    areaPulses_.push_back(AreaEffectPulse{id, count});
+                }
+            }
+            ++it;
+            continue;
+        }
+        while (!area.occupants.empty()) {
+            exitArea(id, area, area.occupants.back());
+        }
+        if (auto index = spatialIndices_.find(area.desc.mapEntity);
+            index != spatialIndices_.end()) {
+            index->second.RemoveArea(id);
+        }
+        it = areaEffects_.erase(it);
+    }
+
+    // Occupants that were destroyed or changed maps.
+    for (auto& [id, area] : areaEffects_) {
+        for (std::size_t i = area.occupants.size(); i-- > 0;) {
+            const cgs::ecs::Entity entity = area.occupants[i];
+            if (!transforms_.Has(entity) || !memberships_.Has(entity) ||
+                memberships_.Get(entity).mapEntity != area.desc.mapEntity) {
+                exitArea(id, area, entity);
+            }
+        }
+    }
+
+    // New areas enter the grid and collect their occupants once.
+    for (auto& [id, area] : areaEffects_) {
+        if (area.seeded) {
+            continue;
+        }
+        SpatialIndex& index = indexFor(area.desc.mapEntity);
+        index.InsertArea(id, area.desc.center, area.desc.radius);
+        index.ForEachInRadius(area.desc.center, area.desc.radius,
+                              [&, id = id](cgs::ecs::Entity entity) {
+                                  if (transforms_.Has(entity)) {
+                                      enterArea(id, area, entity);
+                                  }
+                              });
+        area.seeded = true;
+    }
+
+    // Only entities that moved or changed maps can enter or leave.
+    for (const auto& [map, sync] : syncBatches_) {
+        for (const auto& update : sync.updates) {
+            refreshAreaMembership(update.entity);
+        }
+    }
+    for (const auto entity : areaRechecks_) {
+        refreshAreaMembership(entity);
+    }
+    areaRechecks_.clear();
+
+    std::sort(areaEvents_.begin(), areaEvents_.end(),
+              [](const AreaEffectEvent& lhs, const AreaEffectEvent& rhs) {
+                  return lhs.area != rhs.area ? lhs.area < rhs.area : lhs.entity < rhs.entity;
+              });
+    std::sort(areaPulses_.begin(), areaPulses_.end(),
+              [](const AreaEffectPulse& lhs, const AreaEffectPulse& rhs) {
+                  return lhs.area < rhs.area;
+              });
+}
+
+void WorldSystem::refreshAreaMembership(cgs::ecs::Entity entity) {
+    if (!transforms_.Has(entity) || !memberships_.Has(entity)) {
+        return;
+    }
+
+    areaScratch_.clear();
+    auto index = spatialIndices_.find(memberships_.Get(entity).mapEntity);
+    if (index != spatialIndices_.end()) {
+        index->second.ForEachAreaAt(transforms_.Get(entity).position,
+                                    [this](uint32_t area) { areaScratch_.push_back(area); });
+    }
+    std::sort(areaScratch_.begin(), areaScratch_.end());
+
+    areaPrevious_.clear();
+    if (auto it = areaMemberships_.find(entity); it != areaMemberships_.end()) {
+        areaPrevious_.assign(it->second.begin(), it->second.end());
+    }
+
+    // Merge the sorted old and new sets into Exit / Enter events.
+    auto before = areaPrevious_.begin();
+    auto after = areaScratch_.begin();
+    while (before != areaPrevious_.end() || after != areaScratch_.end()) {
+        if (after == areaScratch_.end() || (before != areaPrevious_.end() && *before < *after)) {
+            exitArea(*before, areaEffects_.find(*before)->second, entity);
+            ++before;
+        } else if (before == areaPrevious_.end() || *after < *before) {
+            enterArea(*after, areaEffects_.find(*after)->second, entity);
+            ++after;
+        } else {
+            ++before;
+            ++after;
+        }
+    }
+}
+
+void WorldSystem::enterArea(AreaEffectId id, AreaEffect& area, cgs::ecs::Entity entity) {
+    auto pos = std::lower_bound(area.occupants.begin(), area.occupants.end(), entity);
+    if (pos != area.occupants.end() && *pos == entity) {
+        return;
+    }
+    area.occupants.insert(pos, entity);
+    auto& areas = areaMemberships_[entity];
+    areas.insert(std::lower_bound(areas.begin(), areas.end(), id), id);
+    areaEvents_.push_back(AreaEffectEvent{id, entity, AreaEffectChange::Enter});
+}
+
+void WorldSystem::exitArea(AreaEffectId id, AreaEffect& area, cgs::ecs::Entity entity) {
+    auto pos = std::lower_bound(area.occupants.begin(), area.occupants.end(), entity);
+    if (pos == area.occupants.end() || *pos != entity) {
+        return;
+    }
+    area.occupants.erase(pos);
+    if (auto it = areaMemberships_.find(entity); it != areaMemberships_.end()) {
+        std::erase(it->second, id);
+        if (it->second.empty()) {
+            areaMemberships_.erase(it);
+        }
+    }
+    areaEvents_.push_back(AreaEffectEvent{id, entity, AreaEffectChange::Exit});
+}
+
 ZoneFlags WorldSystem::GetEntityZoneFlags(cgs::ecs::Entity entity) const {
     if (!memberships_.Has(entity)) {
         return ZoneFlags::None;
     }
 
     const auto& membership = memberships_.Get(entity);
-    uint32_t targetZoneId = membership.zoneId;
+    if (!zoneIndexBuilt_ || zones_.GlobalVersion() != zoneIndexVersion_) {
+        return scanZoneFlags(membership);
+    }
+
+    auto map = zoneFlags_.find(membership.mapEntity);
+    if (map == zoneFlags_.end()) {
+        return ZoneFlags::None;
+    }
+    auto zone = map->second.find(membership.zoneId);
+    return zone != map->second.end() ? zone->second : ZoneFlags::None;
+}
 
+ZoneFlags WorldSystem::scanZoneFlags(const MapMembership& membership) const {
     // Search zone storage for a matching zone in the same map.
     for (std::size_t i = 0; i < zones_.Size(); ++i) {
         auto zoneEntityId = zones_.EntityAt(i);
         cgs::ecs::Entity zoneEntity(zoneEntityId, 0);
         const auto& zone = zones_.Get(zoneEntity);
 
-        if (zone.zoneId == targetZoneId && zone.mapEntity == membership.mapEntity) {
+        if (zone.zoneId == membership.zoneId && zone.mapEntity == membership.mapEntity) {
             return zone.flags;
         }
     }
@@ -292,6 +1053,26 @@ ZoneFlags WorldSystem::GetEntityZoneFlags(cgs::ecs::Entity entity) const {
     return ZoneFlags::None;
 }
 
+void WorldSystem::refreshZoneIndex() {
+    if (zoneIndexBuilt_ && zones_.GlobalVersion() == zoneIndexVersion_) {
+        return;
+    }
+
+    // Keep per-map tables (and their buckets) for maps that still have
+    // zones; the first zone in storage order wins, as in the scan.
+    for (auto& [map, flags] : zoneFlags_) {
+        flags.clear();
+    }
+    for (std::size_t i = 0; i < zones_.Size(); ++i) {
+        const auto& zone = zones_.Get(cgs::ecs::Entity(zones_.EntityAt(i), 0));
+        zoneFlags_[zone.mapEntity].emplace(zone.zoneId, zone.flags);
+    }
+    std::erase_if(zoneFlags_, [](const auto& entry) { return entry.second.empty(); });
+
+    zoneIndexVersion_ = zones_.GlobalVersion();
+    zoneIndexBuilt_ = true;
+}
+
 const SpatialIndex* WorldSystem::GetSpatialIndex(cgs::ecs::Entity mapEntity) const {
     auto it = spatialIndices_.find(mapEntity);
     if (it == spatialIndices_.end()) {
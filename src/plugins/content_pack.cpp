@@ -0,0 +1,571 @@
+/// @file content_pack.cpp
+/// @brief Content pack compiler and the read-only mapped loader.
+///
+/// @see SDS-MOD-023
+
+#include "cgs/plugin/content_pack.hpp"
+
+#include "cgs/foundation/error_code.hpp"
+#include "cgs/game/content_database.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CGS_CONTENT_PACK_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using cgs::foundation::ErrorCode;
+using cgs::foundation::GameError;
+using cgs::foundation::GameResult;
+using cgs::game::ContentDatabase;
+using cgs::game::ItemTemplate;
+using cgs::game::QuestTemplate;
+
+namespace cgs::plugin {
+
+namespace {
+
+constexpr bool kLittleEndian = std::endian::native == std::endian::little;
+
+/// Sections start on this boundary, enough for every record type.
+constexpr std::size_t kSectionAlign = 8;
+
+constexpr std::size_t kMaxOffset = std::numeric_limits<uint32_t>::max();
+
+/// Id index slots for @p count records: a power of two, at most half full.
+std::size_t indexCapacity(std::size_t count) {
+    return std::bit_ceil(std::max<std::size_t>(8, count * 2));
+}
+
+template <typename Record>
+std::vector<uint32_t> buildIndex(const std::vector<Record>& records) {
+    std::size_t capacity = indexCapacity(records.size());
+    auto bits = static_cast<unsigned>(std::countr_zero(capacity));
+    std::vector<uint32_t> index(capacity, pack::kEmptySlot);
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        std::size_t slot = pack::IndexSlot(records[i].id, bits);
+        while (index[slot] != pack::kEmptySlot) {
+            slot = (slot + 1) & (capacity - 1);
+        }
+        index[slot] = static_cast<uint32_t>(i);
+    }
+    return index;
+}
+
+/// The shared string and array sections, filled while records are made.
+struct Pools {
+    std::string strings;
+    std::vector<uint32_t> ids;
+    std::vector<pack::ObjectiveRecord> objectives;
+    std::vector<pack::RewardRecord> rewards;
+    bool overflow = false;
+
+    pack::StringRef addString(std::string_view text) {
+        if (text.size() > kMaxOffset - strings.size()) {
+            overflow = true;
+            return {};
+        }
+        pack::StringRef ref{static_cast<uint32_t>(strings.size()),
+                            static_cast<uint32_t>(text.size())};
+        strings.append(text);
+        return ref;
+    }
+
+    template <typename T>
+    pack::RangeRef startRange(const std::vector<T>& pool, std::size_t count) {
+        if (count > kMaxOffset - pool.size()) {
+            overflow = true;
+            return {};
+        }
+        return {static_cast<uint32_t>(pool.size()), static_cast<uint32_t>(count)};
+    }
+};
+
+pack::ItemRecord makeRecord(const ItemTemplate& item, Pools& pools) {
+    pack::ItemRecord record;
+    record.id = item.id;
+    record.name = pools.addString(item.name.view());
+    record.type = static_cast<uint8_t>(item.type);
+    record.quality = static_cast<uint8_t>(item.quality);
+    record.equipSlot = static_cast<uint8_t>(item.equipSlot);
+    record.maxStackSize = item.maxStackSize;
+    record.maxDurability = item.maxDurability;
+    record.requiredLevel = item.requiredLevel;
+    record.vendorPrice = item.vendorPrice;
+    record.attributes = item.statBonuses.attributes;
+    record.armor = item.statBonuses.armor;
+    record.attackSpeed = item.statBonuses.attackSpeed;
+    record.minDamage = item.statBonuses.minDamage;
+    record.maxDamage = item.statBonuses.maxDamage;
+    return record;
+}
+
+pack::QuestRecord makeRecord(const QuestTemplate& quest, Pools& pools) {
+    pack::QuestRecord record;
+    record.id = quest.id;
+    record.name = pools.addString(quest.name);
+    record.description = pools.addString(quest.description);
+    record.level = quest.level;
+    record.chainNext = quest.chainNext.value_or(0);
+    record.flags = static_cast<uint16_t>(quest.flags);
+    record.timeLimitSeconds = quest.timeLimitSeconds;
+    record.experience = quest.rewards.experience;
+    record.currency = quest.rewards.currency;
+
+    record.prerequisites = pools.startRange(pools.ids, quest.prerequisites.size());
+    pools.ids.insert(pools.ids.end(), quest.prerequisites.begin(), quest.prerequisites.end());
+
+    record.objectives = pools.startRange(pools.objectives, quest.objectives.size());
+    for (const auto& objective : quest.objectives) {
+        pack::ObjectiveRecord out;
+        out.targetId = objective.targetId;
+        out.required = objective.required;
+        out.type = static_cast<uint8_t>(objective.type);
+        pools.objectives.push_back(out);
+    }
+
+    record.rewardItems = pools.startRange(pools.rewards, quest.rewards.items.size());
+    for (const auto& [itemId, count] : quest.rewards.items) {
+        pools.rewards.push_back({itemId, count});
+    }
+    return record;
+}
+
+/// Lays sections out after the header and copies them into the image.
+class ImageWriter {
+public:
+    template <typename T>
+    void add(pack::Section& section, const T* data, std::size_t count) {
+        cursor_ = (cursor_ + kSectionAlign - 1) & ~(kSectionAlign - 1);
+        section = {cursor_, count};
+        pieces_.push_back({cursor_, data, count * sizeof(T)});
+        cursor_ += count * sizeof(T);
+    }
+
+    template <typename T>
+    void add(pack::Section& section, const std::vector<T>& elements) {
+        add(section, elements.data(), elements.size());
+    }
+
+    std::vector<uint8_t> finish(pack::Header& header) {
+        header.fileSize = cursor_;
+        std::vector<uint8_t> image(cursor_);
+        std::memcpy(image.data(), &header, sizeof(header));
+        for (const auto& piece : pieces_) {
+            if (piece.size > 0) {
+                std::memcpy(image.data() + piece.offset, piece.data, piece.size);
+            }
+        }
+        return image;
+    }
+
+private:
+    struct Piece {
+        std::size_t offset;
+        const void* data;
+        std::size_t size;
+    };
+
+    std::size_t cursor_ = sizeof(pack::Header);
+    std::vector<Piece> pieces_;
+};
+
+GameResult<void> loadError(const std::string& reason) {
+    return GameResult<void>::err(GameError(ErrorCode::ConfigLoadFailed, "content pack: " + reason));
+}
+
+bool stringInBounds(pack::StringRef ref, std::size_t size) {
+    return ref.offset <= size && ref.size <= size - ref.offset;
+}
+
+bool rangeInBounds(pack::RangeRef ref, std::size_t size) {
+    return ref.first <= size && ref.count <= size - ref.first;
+}
+
+/// True when @p index is a valid id index over @p records.
+template <typename Record>
+bool indexValid(std::span<const uint32_t> index, std::span<const Record> records) {
+    if (!std::has_single_bit(index.size()) || index.size() <= records.size()) {
+        return false;
+    }
+    // Exactly one slot per record, so probing always meets an empty slot.
+    std::size_t used = 0;
+    for (uint32_t entry : index) {
+        if (entry != pack::kEmptySlot) {
+            if (entry >= records.size()) {
+                return false;
+            }
+            ++used;
+        }
+    }
+    return used == records.size();
+}
+
+template <typename Record>
+bool ascendingIds(std::span<const Record> records) {
+    return std::adjacent_find(records.begin(), records.end(), [](const auto& a, const auto& b) {
+               return a.id >= b.id;
+           }) == records.end();
+}
+
+}  // namespace
+
+// ── Compiler ────────────────────────────────────────────────────────────
+
+GameResult<std::vector<uint8_t>> CompileContentPack(ContentPackSource source) {
+    using Result = GameResult<std::vector<uint8_t>>;
+    if constexpr (!kLittleEndian) {
+        return Result::err(
+            GameError(ErrorCode::InvalidArgument, "content packs are little-endian only"));
+    }
+
+    auto database = ContentDatabase::Build(0, std::move(source.items), std::move(source.quests));
+    if (database.hasError()) {
+        return Result::err(database.error());
+    }
+
+    std::array<std::optional<ClassTemplate>, kCharacterClassCount> classSlots;
+    for (const auto& tmpl : source.classes) {
+        auto slot = static_cast<std::size_t>(tmpl.characterClass);
+        if (slot >= kCharacterClassCount) {
+            return Result::err(GameError(ErrorCode::InvalidArgument,
+                                         "class " + std::to_string(slot) + ": unknown class"));
+        }
+        classSlots[slot] = tmpl;
+    }
+
+    Pools pools;
+    std::vector<pack::ItemRecord> items;
+    std::vector<pack::QuestRecord> quests;
+    std::vector<pack::ClassRecord> classes;
+    for (const auto& item : database.value()->Items()->All()) {
+        items.push_back(makeRecord(item, pools));
+    }
+    for (const auto& quest : database.value()->Quests()->All()) {
+        quests.push_back(makeRecord(quest, pools));
+    }
+    for (const auto& slot : classSlots) {
+        if (slot) {
+            pack::ClassRecord record;
+            record.characterClass = static_cast<uint8_t>(slot->characterClass);
+            record.baseHealth = slot->baseHealth;
+            record.baseMana = slot->baseMana;
+            record.baseSpeed = slot->baseSpeed;
+            classes.push_back(record);
+        }
+    }
+    if (pools.overflow || items.size() >= kMaxOffset || quests.size() >= kMaxOffset) {
+        return Result::err(
+            GameError(ErrorCode::InvalidArgument, "content too large for 32-bit pack offsets"));
+    }
+    auto itemIndex = buildIndex(items);
+    auto questIndex = buildIndex(quests);
+
+    pack::Header header;
+    header.magic = pack::kMagic;
+    header.formatVersion = pack::kFormatVersion;
+    header.headerSize = sizeof(pack::Header);
+
+    ImageWriter writer;
+    writer.add(header.items, items);
+    writer.add(header.quests, quests);
+    writer.add(header.classes, classes);
+    writer.add(header.itemIndex, itemIndex);
+    writer.add(header.questIndex, questIndex);
+    writer.add(header.objectives, pools.objectives);
+    writer.add(header.rewards, pools.rewards);
+    writer.add(header.ids, pools.ids);
+    writer.add(header.strings, pools.strings.data(), pools.strings.size());
+    return Result::ok(writer.finish(header));
+}
+
+GameResult<void> WriteContentPack(ContentPackSource source, const std::filesystem::path& path) {
+    auto image = CompileContentPack(std::move(source));
+    if (image.hasError()) {
+        return GameResult<void>::err(image.error());
+    }
+    const auto& bytes = image.value();
+
+    auto temporary = path;
+    temporary += ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(bytes.data()),
+                  static_cast<std::streamsize>(bytes.size()));
+        if (!out.flush()) {
+            return GameResult<void>::err(GameError(ErrorCode::ConfigLoadFailed,
+                                                   "cannot write content pack: " +
+                                                       temporary.string()));
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(temporary, path, ec);
+    if (ec) {
+        std::filesystem::remove(temporary, ec);
+        return GameResult<void>::err(GameError(
+            ErrorCode::ConfigLoadFailed, "cannot replace content pack: " + path.string()));
+    }
+    return GameResult<void>::ok();
+}
+
+// ── Loader ──────────────────────────────────────────────────────────────
+
+GameResult<std::shared_ptr<const ContentPack>> ContentPack::Open(
+    const std::filesystem::path& path) {
+    using Result = GameResult<std::shared_ptr<const ContentPack>>;
+    auto cannotRead = [&path] {
+        return Result::err(
+            GameError(ErrorCode::ConfigLoadFailed, "cannot read content pack: " + path.string()));
+    };
+    std::shared_ptr<ContentPack> pack(new ContentPack());
+
+#if defined(CGS_CONTENT_PACK_MMAP)
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return cannotRead();
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        return cannotRead();
+    }
+    auto size = static_cast<std::size_t>(info.st_size);
+    // Shared, so every process mapping the pack reads the same page-cache
+    // pages; the mapping outlives the descriptor.
+    void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return cannotRead();
+    }
+    pack->mapping_ = mapping;
+    pack->base_ = static_cast<const uint8_t*>(mapping);
+    pack->size_ = size;
+#else
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return cannotRead();
+    }
+    pack->owned_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    pack->base_ = pack->owned_.data();
+    pack->size_ = pack->owned_.size();
+#endif
+
+    if (auto attached = pack->attach(); attached.hasError()) {
+        return Result::err(GameError(
+            attached.error().code(), path.string() + ": " + std::string(attached.error().message())));
+    }
+    return Result::ok(std::move(pack));
+}
+
+GameResult<std::shared_ptr<const ContentPack>> ContentPack::FromBytes(std::vector<uint8_t> image) {
+    using Result = GameResult<std::shared_ptr<const ContentPack>>;
+    std::shared_ptr<ContentPack> pack(new ContentPack());
+    pack->owned_ = std::move(image);
+    pack->base_ = pack->owned_.data();
+    pack->size_ = pack->owned_.size();
+    if (auto attached = pack->attach(); attached.hasError()) {
+        return Result::err(attached.error());
+    }
+    return Result::ok(std::move(pack));
+}
+
+ContentPack::~ContentPack() {
+#if defined(CGS_CONTENT_PACK_MMAP)
+    if (mapping_ != nullptr) {
+        ::munmap(mapping_, size_);
+    }
+#endif
+}
+
+GameResult<void> ContentPack::attach() {
+    if constexpr (!kLittleEndian) {
+        return loadError("packs are little-endian only");
+    }
+    if (size_ < sizeof(pack::Header)) {
+        return loadError("truncated header");
+    }
+    pack::Header header;
+    std::memcpy(&header, base_, sizeof(header));
+    if (header.magic != pack::kMagic) {
+        return loadError("not a content pack");
+    }
+    if (header.formatVersion != pack::kFormatVersion) {
+        return loadError("format version " + std::to_string(header.formatVersion) +
+                         ", expected " + std::to_string(pack::kFormatVersion));
+    }
+    if (header.headerSize != sizeof(pack::Header) || header.fileSize != size_) {
+        return loadError("size mismatch (truncated or corrupt)");
+    }
+
+    auto section = [this]<typename T>(const pack::Section& s, std::span<const T>& out) {
+        if (s.offset % alignof(T) != 0 || s.offset > size_ ||
+            s.count > (size_ - s.offset) / sizeof(T)) {
+            return false;
+        }
+        out = {static_cast<const T*>(static_cast<const void*>(base_ + s.offset)),
+               static_cast<std::size_t>(s.count)};
+        return true;
+    };
+    std::span<const char> strings;
+    if (!section(header.items, items_) || !section(header.quests, quests_) ||
+        !section(header.classes, classes_) || !section(header.itemIndex, itemIndex_) ||
+        !section(header.questIndex, questIndex_) || !section(header.objectives, objectives_) ||
+        !section(header.rewards, rewards_) || !section(header.ids, ids_) ||
+        !section(header.strings, strings)) {
+        return loadError("section out of bounds");
+    }
+    strings_ = {strings.data(), strings.size()};
+
+    if (!ascendingIds(items_) || !ascendingIds(quests_) || !indexValid(itemIndex_, items_) ||
+        !indexValid(questIndex_, quests_)) {
+        return loadError("corrupt id index");
+    }
+    for (const auto& item : items_) {
+        if (!stringInBounds(item.name, strings_.size()) ||
+            item.type > static_cast<uint8_t>(cgs::game::ItemType::Miscellaneous) ||
+            item.quality > static_cast<uint8_t>(cgs::game::ItemQuality::Legendary) ||
+            item.equipSlot > static_cast<uint8_t>(cgs::game::EquipSlot::COUNT)) {
+            return loadError("corrupt item " + std::to_string(item.id));
+        }
+    }
+    for (const auto& quest : quests_) {
+        if (!stringInBounds(quest.name, strings_.size()) ||
+            !stringInBounds(quest.description, strings_.size()) ||
+            !rangeInBounds(quest.prerequisites, ids_.size()) ||
+            !rangeInBounds(quest.objectives, objectives_.size()) ||
+            !rangeInBounds(quest.rewardItems, rewards_.size())) {
+            return loadError("corrupt quest " + std::to_string(quest.id));
+        }
+    }
+    for (const auto& objective : objectives_) {
+        if (objective.type > static_cast<uint8_t>(cgs::game::ObjectiveType::Custom)) {
+            return loadError("corrupt quest objective");
+        }
+    }
+    for (const auto& record : classes_) {
+        if (record.characterClass >= kCharacterClassCount) {
+            return loadError("corrupt class template");
+        }
+    }
+    return GameResult<void>::ok();
+}
+
+std::optional<PackedItem> ContentPack::FindItem(uint32_t id) const noexcept {
+    if (auto found = findIndex(items_, itemIndex_, id)) {
+        return PackedItem(*this, items_[*found]);
+    }
+    return std::nullopt;
+}
+
+std::optional<PackedQuest> ContentPack::FindQuest(uint32_t id) const noexcept {
+    if (auto found = findIndex(quests_, questIndex_, id)) {
+        return PackedQuest(*this, quests_[*found]);
+    }
+    return std::nullopt;
+}
+
+std::optional<ClassTemplate> ContentPack::FindClass(CharacterClass characterClass) const {
+    for (const auto& tmpl : Classes()) {
+        if (tmpl.characterClass == characterClass) {
+            return tmpl;
+        }
+    }
+    return std::nullopt;
+}
+
+std::vector<ClassTemplate> ContentPack::Classes() const {
+    std::vector<ClassTemplate> out;
+    out.reserve(classes_.size());
+    for (const auto& record : classes_) {
+        out.push_back({static_cast<CharacterClass>(record.characterClass), record.baseHealth,
+                       record.baseMana, record.baseSpeed});
+    }
+    return out;
+}
+
+ContentFragment ContentPack::ToFragment() const {
+    ContentFragment fragment;
+    fragment.items.reserve(items_.size());
+    for (std::size_t i = 0; i < items_.size(); ++i) {
+        fragment.items.push_back(ItemAt(i).ToTemplate());
+    }
+    fragment.quests.reserve(quests_.size());
+    for (std::size_t i = 0; i < quests_.size(); ++i) {
+        fragment.quests.push_back(QuestAt(i).ToTemplate());
+    }
+    return fragment;
+}
+
+// ── Views ───────────────────────────────────────────────────────────────
+
+ItemTemplate PackedItem::ToTemplate() const {
+    const auto& record = *record_;
+    ItemTemplate item;
+    item.id = record.id;
+    item.name = Name();
+    item.type = static_cast<cgs::game::ItemType>(record.type);
+    item.quality = static_cast<cgs::game::ItemQuality>(record.quality);
+    item.maxStackSize = record.maxStackSize;
+    item.maxDurability = record.maxDurability;
+    item.equipSlot = static_cast<cgs::game::EquipSlot>(record.equipSlot);
+    item.statBonuses.attributes = record.attributes;
+    item.statBonuses.armor = record.armor;
+    item.statBonuses.attackSpeed = record.attackSpeed;
+    item.statBonuses.minDamage = record.minDamage;
+    item.statBonuses.maxDamage = record.maxDamage;
+    item.requiredLevel = record.requiredLevel;
+    item.vendorPrice = record.vendorPrice;
+    return item;
+}
+
+QuestTemplate PackedQuest::ToTemplate() const {
+    const auto& record = *record_;
+    QuestTemplate quest;
+    quest.id = record.id;
+    quest.name = Name();
+    quest.description = Description();
+    quest.level = record.level;
+    auto prerequisites = Prerequisites();
+    quest.prerequisites.assign(prerequisites.begin(), prerequisites.end());
+    if (record.chainNext != 0) {
+        quest.chainNext = record.chainNext;
+    }
+    for (const auto& objective : Objectives()) {
+        cgs::game::QuestObjective out;
+        out.type = static_cast<cgs::game::ObjectiveType>(objective.type);
+        out.targetId = objective.targetId;
+        out.required = objective.required;
+        quest.objectives.push_back(out);
+    }
+    quest.rewards.experience = record.experience;
+    quest.rewards.currency = record.currency;
+    for (const auto& reward : RewardItems()) {
+        quest.rewards.items.emplace_back(reward.itemId, reward.count);
+    }
+    quest.flags = static_cast<cgs::game::QuestFlags>(record.flags);
+    quest.timeLimitSeconds = record.timeLimitSeconds;
+    return quest;
+}
+
+ContentParser ContentPackParser() {
+    return [](const std::filesystem::path& path) -> GameResult<ContentFragment> {
+        auto pack = ContentPack::Open(path);
+        if (pack.hasError()) {
+            return GameResult<ContentFragment>::err(pack.error());
+        }
+        return GameResult<ContentFragment>::ok(pack.value()->ToFragment());
+    };
+}
+
+}  // namespace cgs::plugin
@@ -0,0 +1,237 @@
+/// @file content_reloader.cpp
+/// @brief ContentReloader implementation: incremental background builds
+///        of the content database, published between ticks.
+///
+/// @see SDS-MOD-023
+
+#include "cgs/plugin/content_reloader.hpp"
+
+#include "cgs/foundation/error_code.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <utility>
+
+using cgs::foundation::ErrorCode;
+using cgs::foundation::GameError;
+using cgs::foundation::GameResult;
+using cgs::game::ContentDatabase;
+
+namespace cgs::plugin {
+
+// ── Construction / destruction ──────────────────────────────────────────
+
+ContentReloader::ContentReloader(FileWatchBackend backend) : fileWatcher_(backend) {
+    fileWatcher_.SetCallback([this](const std::filesystem::path& path) {
+        if (parsers_.count(path.string()) > 0) {
+            changed_.insert(path.string());
+        }
+    });
+}
+
+ContentReloader::~ContentReloader() {
+    if (pending_.valid()) {
+        pending_.wait();
+    }
+}
+
+// ── Public API ──────────────────────────────────────────────────────────
+
+void ContentReloader::OnPublish(ContentPublishCallback callback) {
+    callbacks_.push_back(std::move(callback));
+}
+
+GameResult<void> ContentReloader::Watch(const std::filesystem::path& path, ContentParser parser) {
+    if (!std::filesystem::exists(path)) {
+        return GameResult<void>::err(
+            GameError(ErrorCode::ConfigLoadFailed, "Content file not found: " + path.string()));
+    }
+    if (!fileWatcher_.Watch(path)) {
+        return GameResult<void>::err(
+            GameError(ErrorCode::ConfigLoadFailed, "Failed to watch: " + path.string()));
+    }
+    parsers_[path.string()] = std::move(parser);
+    changed_.insert(path.string());
+    return GameResult<void>::ok();
+}
+
+void ContentReloader::Unwatch(const std::filesystem::path& path) {
+    auto it = parsers_.find(path.string());
+    if (it == parsers_.end()) {
+        return;
+    }
+    fileWatcher_.Unwatch(path);
+    parsers_.erase(it);
+    changed_.erase(path.string());
+    stale_.erase(path.string());
+    if (fragments_.erase(path.string()) > 0) {
+        structureChanged_ = true;
+    }
+}
+
+GameResult<void> ContentReloader::Reload() {
+    if (pending_.valid()) {
+        (void)finish(pending_.get());
+    }
+    if (current_ && changed_.empty() && stale_.empty() && !structureChanged_) {
+        return GameResult<void>::ok();
+    }
+    structureChanged_ = false;
+    auto jobs = takeChanged();
+    return finish(build(nextVersion_++, fragments_, std::move(jobs)));
+}
+
+void ContentReloader::Poll() {
+    fileWatcher_.Poll();
+
+    if (pending_.valid() &&
+        pending_.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        (void)finish(pending_.get());
+    }
+    reapRetired();
+
+    if (!pending_.valid() && (!changed_.empty() || structureChanged_)) {
+        structureChanged_ = false;
+        pending_ = std::async(std::launch::async,
+                              [version = nextVersion_++, fragments = fragments_,
+                               jobs = takeChanged()]() mutable {
+                                  return build(version, std::move(fragments), std::move(jobs));
+                              });
+    }
+}
+
+const std::shared_ptr<const ContentDatabase>& ContentReloader::Current() const noexcept {
+    return current_;
+}
+
+uint64_t ContentReloader::CurrentVersion() const noexcept {
+    return current_ ? current_->Version() : 0;
+}
+
+bool ContentReloader::IsBuilding() const noexcept {
+    return pending_.valid();
+}
+
+std::size_t ContentReloader::LiveVersionCount() const {
+    const auto live = std::count_if(superseded_.begin(), superseded_.end(),
+                                    [](const auto& version) { return !version.expired(); });
+    return static_cast<std::size_t>(live) + (current_ ? 1 : 0);
+}
+
+uint64_t ContentReloader::RetiredVersionCount() const noexcept {
+    return retiredCount_;
+}
+
+uint64_t ContentReloader::PublishCount() const noexcept {
+    return publishCount_;
+}
+
+const std::optional<GameError>& ContentReloader::LastError() const noexcept {
+    return lastError_;
+}
+
+void ContentReloader::SetDebounceMs(uint32_t ms) {
+    fileWatcher_.SetDebounceMs(ms);
+}
+
+std::size_t ContentReloader::WatchedFileCount() const noexcept {
+    return parsers_.size();
+}
+
+// ── Internal ────────────────────────────────────────────────────────────
+
+GameResult<ContentReloader::Staged> ContentReloader::build(uint64_t version,
+                                                           FragmentMap fragments,
+                                                           std::vector<ParseJob> jobs) {
+    for (auto& job : jobs) {
+        GameResult<ContentFragment> parsed = [&] {
+            try {
+                return job.parser(job.path);
+            } catch (const std::exception& e) {
+                return GameResult<ContentFragment>::err(
+                    GameError(ErrorCode::ConfigLoadFailed, e.what()));
+            }
+        }();
+        if (parsed.hasError()) {
+            return GameResult<Staged>::err(
+                GameError(parsed.error().code(),
+                          job.path + ": " + std::string(parsed.error().message())));
+        }
+        fragments[job.path] = std::make_shared<const ContentFragment>(std::move(parsed).value());
+    }
+
+    // Path order, so a later file's template wins a duplicate id.
+    std::vector<cgs::game::ItemTemplate> items;
+    std::vector<cgs::game::QuestTemplate> quests;
+    for (const auto& [path, fragment] : fragments) {
+        items.insert(items.end(), fragment->items.begin(), fragment->items.end());
+        quests.insert(quests.end(), fragment->quests.begin(), fragment->quests.end());
+    }
+    auto database = ContentDatabase::Build(version, std::move(items), std::move(quests));
+    if (database.hasError()) {
+        return GameResult<Staged>::err(database.error());
+    }
+    return GameResult<Staged>::ok(Staged{std::move(database).value(), std::move(fragments)});
+}
+
+std::vector<ContentReloader::ParseJob> ContentReloader::takeChanged() {
+    changed_.merge(stale_);
+    stale_.clear();
+
+    std::vector<ParseJob> jobs;
+    jobs.reserve(changed_.size());
+    building_.clear();
+    for (const auto& path : changed_) {
+        jobs.push_back(ParseJob{path, parsers_.at(path)});
+        building_.push_back(path);
+    }
+    changed_.clear();
+    return jobs;
+}
+
+GameResult<void> ContentReloader::finish(GameResult<Staged> staged) {
+    if (staged.hasError()) {
+        for (auto& path : building_) {
+            if (parsers_.count(path) > 0) {
+                stale_.insert(std::move(path));
+            }
+        }
+        building_.clear();
+        lastError_ = staged.error();
+        return GameResult<void>::err(staged.error());
+    }
+    building_.clear();
+
+    auto result = std::move(staged).value();
+    // Files unwatched while the build ran.
+    for (auto it = result.fragments.begin(); it != result.fragments.end();) {
+        if (parsers_.count(it->first) == 0) {
+            it = result.fragments.erase(it);
+            structureChanged_ = true;
+        } else {
+            ++it;
+        }
+    }
+
+    if (current_) {
+        superseded_.push_back(current_);
+    }
+    current_ = std::move(result.database);
+    fragments_ = std::move(result.fragments);
+    lastError_.reset();
+    ++publishCount_;
+    for (const auto& callback : callbacks_) {
+        callback(current_);
+    }
+    reapRetired();
+    return GameResult<void>::ok();
+}
+
+void ContentReloader::reapRetired() {
+    const auto freed = std::erase_if(superseded_,
+                                     [](const auto& version) { return version.expired(); });
+    retiredCount_ += freed;
+}
+
+}  // namespace cgs::plugin
@@ -1,17 +1,377 @@
 /// @file file_watcher.cpp
-/// @brief Polling-based file change detection implementation.
+/// @brief File change detection: OS notification backends with a
+///        timestamp-polling fallback.
 ///
 /// @see SDS-MOD-023
 
 #include "cgs/plugin/file_watcher.hpp"
 
 #include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <sys/vfs.h>
+#include <unistd.h>
+
+#include <cstddef>
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__)
+#include <fcntl.h>
+#include <sys/event.h>
+#include <sys/mount.h>
+#include <sys/param.h>
+#include <unistd.h>
+
+#define CGS_FILE_WATCHER_KQUEUE
+#elif defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
 
 namespace fs = std::filesystem;
 
 namespace cgs::plugin {
 
-FileWatcher::FileWatcher() = default;
+namespace {
+
+/// A reported change: a file in @c dir, or anything in @c dir when @c name
+/// is empty (backends that only report directories).
+struct DirChange {
+    fs::path dir;
+    std::string name;
+};
+
+/// Parent directory of @p path as the backends watch it.
+fs::path directoryOf(const fs::path& path) {
+    auto dir = path.parent_path();
+    return dir.empty() ? fs::path(".") : dir;
+}
+
+/// Whether @p dir is on a filesystem whose change notifications cannot be
+/// trusted (writes from other hosts are not reported).
+bool isRemoteFilesystem(const fs::path& dir) {
+#if defined(__linux__)
+    struct statfs info {};
+    if (statfs(dir.c_str(), &info) != 0) {
+        return true;
+    }
+    switch (static_cast<unsigned long>(info.f_type)) {
+        case 0x6969UL:      // NFS
+        case 0x517BUL:      // SMB
+        case 0xFF534D42UL:  // CIFS
+        case 0xFE534D42UL:  // SMB2
+        case 0x73757245UL:  // Coda
+        case 0x5346414FUL:  // AFS
+        case 0x01021997UL:  // 9P
+        case 0x65735546UL:  // FUSE (sshfs and friends)
+            return true;
+        default:
+            return false;
+    }
+#elif defined(CGS_FILE_WATCHER_KQUEUE)
+    struct statfs info {};
+    if (statfs(dir.c_str(), &info) != 0) {
+        return true;
+    }
+    return (info.f_flags & MNT_LOCAL) == 0;
+#elif defined(_WIN32)
+    auto root = fs::absolute(dir).root_path().wstring();
+    return GetDriveTypeW(root.c_str()) == DRIVE_REMOTE;
+#else
+    (void)dir;
+    return true;
+#endif
+}
+
+}  // namespace
+
+// ── Native backends ─────────────────────────────────────────────────────
+//
+// Each backend watches directories (reference counted per file) and
+// drains its queue without blocking.
+
+#if defined(__linux__)
+
+/// inotify: one watch per directory; events carry the file name, and
+/// IN_MOVED_TO catches libraries replaced by rename.
+class FileWatcher::NativeBackend {
+public:
+    static std::unique_ptr<NativeBackend> Create() {
+        int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        return fd < 0 ? nullptr : std::unique_ptr<NativeBackend>(new NativeBackend(fd));
+    }
+
+    ~NativeBackend() { close(fd_); }
+
+    NativeBackend(const NativeBackend&) = delete;
+    NativeBackend& operator=(const NativeBackend&) = delete;
+
+    bool watch(const fs::path& file) {
+        auto dir = directoryOf(file);
+        auto it = byDir_.find(dir.string());
+        if (it != byDir_.end()) {
+            ++it->second.users;
+            return true;
+        }
+        int wd = inotify_add_watch(
+            fd_, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_MODIFY | IN_ATTRIB);
+        if (wd < 0) {
+            return false;
+        }
+        byDir_.emplace(dir.string(), Watch{wd, 1});
+        byWd_.emplace(wd, dir);
+        return true;
+    }
+
+    void unwatch(const fs::path& file) {
+        auto it = byDir_.find(directoryOf(file).string());
+        if (it == byDir_.end() || --it->second.users > 0) {
+            return;
+        }
+        inotify_rm_watch(fd_, it->second.wd);
+        byWd_.erase(it->second.wd);
+        byDir_.erase(it);
+    }
+
+    void drain(std::vector<DirChange>& out) {
+        alignas(inotify_event) char buffer[4096];
+        for (;;) {
+            ssize_t length = read(fd_, buffer, sizeof(buffer));
+            if (length <= 0) {
+                return;  // EAGAIN: queue empty
+            }
+            for (std::size_t offset = 0; offset < static_cast<std::size_t>(length);) {
+                const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                offset += sizeof(inotify_event) + event->len;
+
+                if ((event->mask & IN_Q_OVERFLOW) != 0) {
+                    // Events were lost: have every directory re-checked.
+                    for (const auto& [wd, dir] : byWd_) {
+                        out.push_back({dir, {}});
+                    }
+                    continue;
+                }
+                auto it = byWd_.find(event->wd);
+                if (it != byWd_.end() && event->len > 0) {
+                    out.push_back({it->second, std::string(event->name)});
+                }
+            }
+        }
+    }
+
+private:
+    explicit NativeBackend(int fd) : fd_(fd) {}
+
+    struct Watch {
+        int wd;
+        std::size_t users;
+    };
+
+    int fd_;
+    std::unordered_map<std::string, Watch> byDir_;
+    std::unordered_map<int, fs::path> byWd_;
+};
+
+#elif defined(CGS_FILE_WATCHER_KQUEUE)
+
+/// kqueue: vnode events on each directory (entries created or renamed)
+/// and on each file (written in place).  The file descriptor follows the
+/// inode, so it is reopened after the file is replaced.
+class FileWatcher::NativeBackend {
+public:
+    static std::unique_ptr<NativeBackend> Create() {
+        int kq = kqueue();
+        return kq < 0 ? nullptr : std::unique_ptr<NativeBackend>(new NativeBackend(kq));
+    }
+
+    ~NativeBackend() {
+        for (const auto& [fd, target] : targets_) {
+            close(fd);
+        }
+        close(kq_);
+    }
+
+    NativeBackend(const NativeBackend&) = delete;
+    NativeBackend& operator=(const NativeBackend&) = delete;
+
+    bool watch(const fs::path& file) {
+        auto dir = directoryOf(file);
+        auto it = dirUsers_.find(dir.string());
+        if (it == dirUsers_.end()) {
+            if (!add(dir, {})) {
+                return false;
+            }
+            it = dirUsers_.emplace(dir.string(), 0).first;
+        }
+        ++it->second;
+        add(dir, file.filename().string());  // Directory events still cover the file.
+        return true;
+    }
+
+    void unwatch(const fs::path& file) {
+        auto dir = directoryOf(file);
+        remove(dir, file.filename().string());
+        auto it = dirUsers_.find(dir.string());
+        if (it != dirUsers_.end() && --it->second == 0) {
+            remove(dir, {});
+            dirUsers_.erase(it);
+        }
+    }
+
+    void drain(std::vector<DirChange>& out) {
+        struct kevent events[64];
+        const struct timespec zero {};
+        for (;;) {
+            int count = kevent(kq_, nullptr, 0, events, 64, &zero);
+            if (count <= 0) {
+                return;
+            }
+            for (int i = 0; i < count; ++i) {
+                int fd = static_cast<int>(events[i].ident);
+                auto it = targets_.find(fd);
+                if (it == targets_.end()) {
+                    continue;
+                }
+                auto target = it->second;
+                out.push_back(target);
+                if (!target.name.empty() && (events[i].fflags & (NOTE_DELETE | NOTE_RENAME)) != 0) {
+                    remove(target.dir, target.name);
+                    add(target.dir, target.name);
+                }
+            }
+            if (count < 64) {
+                return;
+            }
+        }
+    }
+
+private:
+    explicit NativeBackend(int kq) : kq_(kq) {}
+
+    // Watch @p dir itself (empty @p name) or the file @p name in it.
+    bool add(const fs::path& dir, const std::string& name) {
+        auto path = name.empty() ? dir : dir / name;
+#if defined(O_EVTONLY)
+        int fd = open(path.c_str(), O_EVTONLY);
+#else
+        int fd = open(path.c_str(), O_RDONLY);
+#endif
+        if (fd < 0) {
+            return false;
+        }
+        struct kevent change;
+        EV_SET(&change, static_cast<uintptr_t>(fd), EVFILT_VNODE, EV_ADD | EV_CLEAR,
+               NOTE_WRITE | NOTE_EXTEND | NOTE_ATTRIB | NOTE_DELETE | NOTE_RENAME, 0, nullptr);
+        if (kevent(kq_, &change, 1, nullptr, 0, nullptr) < 0) {
+            close(fd);
+            return false;
+        }
+        targets_.emplace(fd, DirChange{dir, name});
+        return true;
+    }
+
+    void remove(const fs::path& dir, const std::string& name) {
+        for (auto it = targets_.begin(); it != targets_.end(); ++it) {
+            if (it->second.dir == dir && it->second.name == name) {
+                close(it->first);  // Closing drops the kevent registration.
+                targets_.erase(it);
+                return;
+            }
+        }
+    }
+
+    int kq_;
+    std::unordered_map<int, DirChange> targets_;
+    std::unordered_map<std::string, std::size_t> dirUsers_;
+};
+
+#elif defined(_WIN32)
+
+/// Windows change notifications: one handle per directory, signalled for
+/// writes and renames in it; the caller re-checks that directory's files.
+class FileWatcher::NativeBackend {
+public:
+    static std::unique_ptr<NativeBackend> Create() {
+        return std::unique_ptr<NativeBackend>(new NativeBackend());
+    }
+
+    ~NativeBackend() {
+        for (const auto& [dir, watch] : byDir_) {
+            FindCloseChangeNotification(watch.handle);
+        }
+    }
+
+    NativeBackend(const NativeBackend&) = delete;
+    NativeBackend& operator=(const NativeBackend&) = delete;
+
+    bool watch(const fs::path& file) {
+        auto dir = directoryOf(file);
+        auto it = byDir_.find(dir.string());
+        if (it != byDir_.end()) {
+            ++it->second.users;
+            return true;
+        }
+        HANDLE handle = FindFirstChangeNotificationW(
+            dir.c_str(), FALSE, FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME);
+        if (handle == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        byDir_.emplace(dir.string(), Watch{handle, dir, 1});
+        return true;
+    }
+
+    void unwatch(const fs::path& file) {
+        auto it = byDir_.find(directoryOf(file).string());
+        if (it == byDir_.end() || --it->second.users > 0) {
+            return;
+        }
+        FindCloseChangeNotification(it->second.handle);
+        byDir_.erase(it);
+    }
+
+    void drain(std::vector<DirChange>& out) {
+        for (auto& [key, watch] : byDir_) {
+            if (WaitForSingleObject(watch.handle, 0) == WAIT_OBJECT_0) {
+                out.push_back({watch.dir, {}});
+                FindNextChangeNotification(watch.handle);
+            }
+        }
+    }
+
+private:
+    NativeBackend() = default;
+
+    struct Watch {
+        HANDLE handle;
+        fs::path dir;
+        std::size_t users;
+    };
+
+    std::unordered_map<std::string, Watch> byDir_;
+};
+
+#else
+
+/// No notification API: every file is polled.
+class FileWatcher::NativeBackend {
+public:
+    static std::unique_ptr<NativeBackend> Create() { return nullptr; }
+    bool watch(const fs::path&) { return false; }
+    void unwatch(const fs::path&) {}
+    void drain(std::vector<DirChange>&) {}
+};
+
+#endif
+
+// ── FileWatcher ─────────────────────────────────────────────────────────
+
+FileWatcher::FileWatcher(FileWatchBackend backend) {
+    if (backend == FileWatchBackend::Native) {
+        native_ = NativeBackend::Create();
+    }
+}
+
+FileWatcher::~FileWatcher() = default;
 
 void FileWatcher::SetCallback(FileChangeCallback callback) {
     std::lock_guard lock(mutex_);
@@ -27,20 +387,55 @@ bool FileWatcher::Watch(const fs::path& path) {
 
     std::lock_guard lock(mutex_);
     auto key = path.string();
-    entries_[key] = WatchEntry{writeTime, std::chrono::steady_clock::time_point{}, false};
+    auto it = entries_.find(key);
+    if (it != entries_.end() && it->second.native) {
+        native_->unwatch(path);
+    }
+
+    WatchEntry entry{writeTime, std::chrono::steady_clock::time_point{}, false, false};
+    if (native_ && !isRemoteFilesystem(directoryOf(path))) {
+        entry.native = native_->watch(path);
+    }
+    entries_[key] = entry;
     return true;
 }
 
 void FileWatcher::Unwatch(const fs::path& path) {
     std::lock_guard lock(mutex_);
-    entries_.erase(path.string());
+    auto it = entries_.find(path.string());
+    if (it == entries_.end()) {
+        return;
+    }
+    if (it->second.native) {
+        native_->unwatch(path);
+    }
+    entries_.erase(it);
 }
 
 void FileWatcher::UnwatchAll() {
     std::lock_guard lock(mutex_);
+    for (const auto& [pathStr, entry] : entries_) {
+        if (entry.native) {
+            native_->unwatch(fs::path(pathStr));
+        }
+    }
     entries_.clear();
 }
 
+void FileWatcher::checkTimestamp(const std::string& path, WatchEntry& entry,
+                                 std::chrono::steady_clock::time_point now) {
+    std::error_code ec;
+    auto currentTime = fs::last_write_time(fs::path(path), ec);
+    if (ec) {
+        return;
+    }
+    if (currentTime != entry.lastWriteTime) {
+        entry.lastWriteTime = currentTime;
+        entry.lastChangeDetected = now;
+        entry.pendingCallback = true;
+    }
+}
+
 void FileWatcher::Poll() {
     // Collect changes under the lock, invoke callbacks outside.
     std::vector<fs::path> changed;
@@ -48,17 +443,36 @@ void FileWatcher::Poll() {
 
     {
         std::lock_guard lock(mutex_);
-        for (auto& [pathStr, entry] : entries_) {
-            std::error_code ec;
-            auto currentTime = fs::last_write_time(fs::path(pathStr), ec);
-            if (ec) {
-                continue;
+
+        // Notified files restart their debounce window; a burst of writes
+        // keeps pushing it out and yields one callback.
+        std::vector<DirChange> notified;
+        if (native_) {
+            native_->drain(notified);
+        }
+        for (const auto& change : notified) {
+            for (auto& [pathStr, entry] : entries_) {
+                fs::path path(pathStr);
+                if (!entry.native || directoryOf(path) != change.dir) {
+                    continue;
+                }
+                if (change.name.empty()) {
+                    checkTimestamp(pathStr, entry, now);
+                } else if (path.filename() == change.name) {
+                    std::error_code ec;
+                    auto writeTime = fs::last_write_time(path, ec);
+                    if (!ec) {
+                        entry.lastWriteTime = writeTime;
+                    }
+                    entry.lastChangeDetected = now;
+                    entry.pendingCallback = true;
+                }
             }
+        }
 
-            if (currentTime != entry.lastWriteTime) {
-                entry.lastWriteTime = currentTime;
-                entry.lastChangeDetected = now;
-                entry.pendingCallback = true;
+        for (auto& [pathStr, entry] : entries_) {
+            if (!entry.native) {
+                checkTimestamp(pathStr, entry, now);
             }
 
             if (entry.pendingCallback) {
@@ -94,4 +508,10 @@ bool FileWatcher::IsWatching(const fs::path& path) const {
     return entries_.count(path.string()) > 0;
 }
 
+bool FileWatcher::IsEventDriven(const fs::path& path) const {
+    std::lock_guard lock(mutex_);
+    auto it = entries_.find(path.string());
+    return it != entries_.end() && it->second.native;
+}
+
 }  // namespace cgs::plugin
@@ -1,5 +1,6 @@
 /// @file hot_reload_manager.cpp
-/// @brief HotReloadManager implementation: safe reload cycle with state preservation.
+/// @brief HotReloadManager implementation: staged reload cycle with state
+///        preservation and rollback.
 ///
 /// @see SDS-MOD-023
 
@@ -9,12 +10,49 @@
 #include "cgs/plugin/plugin_events.hpp"
 #include "cgs/plugin/plugin_manager.hpp"
 
+#include <atomic>
+#include <system_error>
+#include <utility>
+
 using cgs::foundation::ErrorCode;
 using cgs::foundation::GameError;
 using cgs::foundation::GameResult;
 
 namespace cgs::plugin {
 
+#ifdef CGS_HOT_RELOAD
+namespace {
+
+/// Copy @p libraryPath to a fresh file name, so the platform loader opens
+/// the new build instead of returning the library it already has open.
+GameResult<std::filesystem::path> shadowCopy(const std::filesystem::path& libraryPath) {
+    static std::atomic<uint64_t> counter{0};
+    std::error_code ec;
+    auto dir = std::filesystem::temp_directory_path(ec) / "cgs_hot_reload";
+    if (!ec) {
+        std::filesystem::create_directories(dir, ec);
+    }
+    if (ec) {
+        return GameResult<std::filesystem::path>::err(GameError(
+            ErrorCode::HotReloadFailed, "Cannot create reload directory: " + ec.message()));
+    }
+
+    auto copy = dir / (libraryPath.stem().string() + ".reload" +
+                       std::to_string(counter.fetch_add(1) + 1) +
+                       libraryPath.extension().string());
+    std::filesystem::copy_file(libraryPath, copy,
+                               std::filesystem::copy_options::overwrite_existing, ec);
+    if (ec) {
+        return GameResult<std::filesystem::path>::err(
+            GameError(ErrorCode::HotReloadFailed,
+                      "Cannot copy " + libraryPath.string() + ": " + ec.message()));
+    }
+    return GameResult<std::filesystem::path>::ok(std::move(copy));
+}
+
+}  // namespace
+#endif
+
 // ── Construction / destruction ──────────────────────────────────────────
 
 HotReloadManager::HotReloadManager(PluginManager& pluginManager) : pluginManager_(pluginManager) {
@@ -23,7 +61,7 @@ HotReloadManager::HotReloadManager(PluginManager& pluginManager) : pluginManager
         // Find which plugin corresponds to this file.
         for (const auto& [name, watchedPath] : watchedPlugins_) {
             if (std::filesystem::equivalent(path, watchedPath)) {
-                (void)doReload(name, watchedPath);
+                (void)BeginReload(name);
                 break;
             }
         }
@@ -73,6 +111,22 @@ void HotReloadManager::UnwatchPlugin(const std::string& pluginName) {
 void HotReloadManager::Poll() {
 #ifdef CGS_HOT_RELOAD
     fileWatcher_.Poll();
+
+    for (auto it = pending_.begin(); it != pending_.end();) {
+        if (it->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            ++it;
+            continue;
+        }
+        auto name = it->first;
+        auto staged = it->second.get();
+        it = pending_.erase(it);
+
+        auto result = finishReload(name, std::move(staged));
+        if (result.hasError()) {
+            pluginManager_.GetEventBus().Publish(
+                PluginErrorEvent{name, std::string(result.error().message())});
+        }
+    }
 #endif
 }
 
@@ -91,6 +145,36 @@ GameResult<void> HotReloadManager::ReloadPlugin(const std::string& pluginName) {
 #endif
 }
 
+GameResult<void> HotReloadManager::BeginReload(const std::string& pluginName) {
+#ifdef CGS_HOT_RELOAD
+    auto it = watchedPlugins_.find(pluginName);
+    if (it == watchedPlugins_.end()) {
+        return GameResult<void>::err(
+            GameError(ErrorCode::PluginNotFound, "Plugin not watched: " + pluginName));
+    }
+    if (pending_.count(pluginName) > 0) {
+        return GameResult<void>::err(
+            GameError(ErrorCode::HotReloadFailed, "Reload already in progress: " + pluginName));
+    }
+
+    pending_.emplace(pluginName, std::async(std::launch::async,
+                                            [this, path = it->second] { return stage(path); }));
+    return GameResult<void>::ok();
+#else
+    (void)pluginName;
+    return GameResult<void>::err(
+        GameError(ErrorCode::HotReloadDisabled, "Hot reload is not available in this build"));
+#endif
+}
+
+std::size_t HotReloadManager::PendingReloadCount() const {
+#ifdef CGS_HOT_RELOAD
+    return pending_.size();
+#else
+    return 0;
+#endif
+}
+
 void HotReloadManager::SetDebounceMs(uint32_t ms) {
 #ifdef CGS_HOT_RELOAD
     fileWatcher_.SetDebounceMs(ms);
@@ -134,56 +218,61 @@ const PluginStateSnapshot* HotReloadManager::GetSnapshot(const std::string& plug
 
 GameResult<void> HotReloadManager::doReload(const std::string& pluginName,
                                             const std::filesystem::path& libraryPath) {
-    // 1. Capture state (if the plugin supports IHotReloadable).
-    auto stateResult = captureState(pluginName);
-    bool hasState = stateResult.hasValue();
-    if (hasState) {
-        snapshots_.insert_or_assign(pluginName, std::move(stateResult).value());
-    }
+    return finishReload(pluginName, stage(libraryPath));
+}
 
-    // 2. Shutdown the plugin (Active/Initialized → Loaded).
-    auto stateCheck = pluginManager_.GetPluginState(pluginName);
-    if (stateCheck.hasValue()) {
-        auto state = stateCheck.value();
-        if (state == PluginState::Active || state == PluginState::Initialized) {
-            auto shutResult = pluginManager_.ShutdownPlugin(pluginName);
-            if (shutResult.hasError()) {
-                return shutResult;
-            }
-        }
+GameResult<HotReloadManager::StagedPlugin> HotReloadManager::stage(
+    const std::filesystem::path& libraryPath) {
+    auto copy = shadowCopy(libraryPath);
+    if (copy.hasError()) {
+        return GameResult<StagedPlugin>::err(copy.error());
     }
 
-    // 3. Unload the old binary.
-    auto unloadResult = pluginManager_.UnloadPlugin(pluginName);
-    if (unloadResult.hasError()) {
-        return unloadResult;
-    }
+    auto staged = pluginManager_.StagePlugin(copy.value());
 
-    // 4. Load the new binary.
-    auto loadResult = pluginManager_.LoadPlugin(libraryPath);
-    if (loadResult.hasError()) {
-        return GameResult<void>::err(GameError(
-            ErrorCode::HotReloadFailed,
-            "Failed to reload plugin '" + pluginName + "': " + loadResult.error().message()));
-    }
+    // The loader keeps its own mapping; the copy is not needed once open
+    // (removal fails harmlessly where open libraries are locked).
+    std::error_code ec;
+    std::filesystem::remove(copy.value(), ec);
+    return staged;
+}
 
-    // 5. Initialize the reloaded plugin.
-    auto initResult = pluginManager_.InitPlugin(pluginName);
-    if (initResult.hasError()) {
-        return initResult;
+GameResult<void> HotReloadManager::finishReload(const std::string& pluginName,
+                                                GameResult<StagedPlugin> staged) {
+    // 1. Staging failed: the running instance was never touched.
+    if (staged.hasError()) {
+        return GameResult<void>::err(GameError(ErrorCode::HotReloadFailed,
+                                               "Failed to reload plugin '" + pluginName +
+                                                   "': " + std::string(staged.error().message())));
     }
-
-    // 6. Activate the reloaded plugin.
-    auto activateResult = pluginManager_.ActivatePlugin(pluginName);
-    if (activateResult.hasError()) {
-        return activateResult;
+    auto next = std::move(staged).value();
+    if (next.Get()->GetInfo().name != pluginName) {
+        return GameResult<void>::err(
+            GameError(ErrorCode::HotReloadFailed, "Reloaded library for '" + pluginName +
+                                                      "' provides plugin '" +
+                                                      next.Get()->GetInfo().name + "'"));
     }
 
-    // 7. Restore state (if captured and version matches).
+    // 2. Capture state from the running instance (if IHotReloadable).
+    auto stateResult = captureState(pluginName);
+    bool hasState = stateResult.hasValue();
     if (hasState) {
-        auto restoreResult = restoreState(pluginName, snapshots_.at(pluginName));
-        // State restoration failure is non-fatal; the plugin runs fresh.
-        (void)restoreResult;
+        snapshots_.insert_or_assign(pluginName, std::move(stateResult).value());
+
+        // 3. Restore into the staged instance; on failure it is discarded.
+        auto restoreResult = restoreState(*next.Get(), snapshots_.at(pluginName));
+        if (restoreResult.hasError()) {
+            return GameResult<void>::err(
+                GameError(ErrorCode::HotReloadFailed,
+                          "State restore failed for plugin '" + pluginName +
+                              "': " + std::string(restoreResult.error().message())));
+        }
+    }
+
+    // 4. Swap between ticks; the old instance is shut down and unloaded.
+    auto swapResult = pluginManager_.SwapPlugin(std::move(next));
+    if (swapResult.hasError()) {
+        return swapResult;
     }
 
     ++reloadCount_;
@@ -219,19 +308,13 @@ GameResult<PluginStateSnapshot> HotReloadManager::captureState(const std::string
     return GameResult<PluginStateSnapshot>::ok(std::move(snapshot));
 }
 
-GameResult<void> HotReloadManager::restoreState(const std::string& pluginName,
+GameResult<void> HotReloadManager::restoreState(IPlugin& plugin,
                                                 const PluginStateSnapshot& snapshot) {
-    auto* plugin = pluginManager_.GetPlugin(pluginName);
-    if (plugin == nullptr) {
-        return GameResult<void>::err(
-            GameError(ErrorCode::PluginNotFound, "Plugin not found after reload: " + pluginName));
-    }
-
-    auto* reloadable = dynamic_cast<IHotReloadable*>(plugin);
+    auto* reloadable = dynamic_cast<IHotReloadable*>(&plugin);
     if (reloadable == nullptr) {
         return GameResult<void>::err(
             GameError(ErrorCode::StateDeserializationFailed,
-                      "Reloaded plugin lost IHotReloadable: " + pluginName));
+                      "Reloaded plugin lost IHotReloadable: " + snapshot.pluginName));
     }
 
     // Version mismatch: skip restoration silently.
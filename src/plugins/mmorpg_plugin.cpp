@@ -85,7 +85,10 @@ void MMORPGPlugin::OnShutdown() {
     characters_.clear();
     guilds_.clear();
     for (auto& history : chatHistory_) {
-        history.clear();
+        history.Clear();
+    }
+    for (auto& subscribers : chatSubscribers_) {
+        subscribers.clear();
     }
 }
 
@@ -103,11 +106,12 @@ cgs::ecs::Entity MMORPGPlugin::CreateCharacter(const std::string& name,
                                                cgs::ecs::Entity mapEntity) {
     auto entity = entityManager_.Create();
     const auto& tmpl = getClassTemplate(cls);
+    const cgs::foundation::InternedString interned(name);
 
     // Identity
     identities_.Add(
         entity,
-        cgs::game::Identity{cgs::game::GenerateGUID(), name, cgs::game::ObjectType::Player, 0});
+        cgs::game::Identity{cgs::game::GenerateGUID(), interned, cgs::game::ObjectType::Player, 0});
 
     // Transform
     transforms_.Add(entity, cgs::game::Transform{position, {}, {}});
@@ -150,7 +154,7 @@ cgs::ecs::Entity MMORPGPlugin::CreateCharacter(const std::string& name,
     data.level = 1;
     data.experience = 0;
     data.guildId = 0;
-    data.name = name;
+    data.name = interned;
     characters_.insert_or_assign(entity, std::move(data));
 
     return entity;
@@ -169,6 +173,34 @@ void MMORPGPlugin::RemoveCharacter(cgs::ecs::Entity entity) {
     entityManager_.Destroy(entity);
 }
 
+bool MMORPGPlugin::SetCharacterOnline(cgs::ecs::Entity entity, bool online) {
+    auto it = characters_.find(entity);
+    if (it == characters_.end()) {
+        return false;
+    }
+    CharacterData& data = it->second;
+    if (data.online == online) {
+        return true;
+    }
+    data.online = online;
+    if (data.guildId == 0) {
+        return true;
+    }
+    auto guildIt = guilds_.find(data.guildId);
+    if (guildIt == guilds_.end()) {
+        return true;
+    }
+    GuildData& guild = guildIt->second;
+    if (online) {
+        swapGuildMembers(guild, data.guildSlot, guild.onlineCount);
+        ++guild.onlineCount;
+    } else {
+        --guild.onlineCount;
+        swapGuildMembers(guild, data.guildSlot, guild.onlineCount);
+    }
+    return true;
+}
+
 const CharacterData* MMORPGPlugin::GetCharacterData(cgs::ecs::Entity entity) const {
     auto it = characters_.find(entity);
     if (it == characters_.end()) {
@@ -256,12 +288,11 @@ uint32_t MMORPGPlugin::CreateGuild(const std::string& name, cgs::ecs::Entity lea
     guild.id = guildId;
     guild.name = name;
     guild.leader = leader;
-    guild.members.push_back(GuildMember{leader, charData->name, GuildRank::Leader});
 
-    guilds_.insert_or_assign(guildId, std::move(guild));
-
-    // Update character data.
-    characters_[leader].guildId = guildId;
+    auto& stored = guilds_.insert_or_assign(guildId, std::move(guild)).first->second;
+    CharacterData& data = characters_[leader];
+    addGuildMember(stored, GuildMember{leader, data.name, GuildRank::Leader}, data);
+    data.guildId = guildId;
 
     return guildId;
 }
@@ -300,8 +331,9 @@ bool MMORPGPlugin::JoinGuild(cgs::ecs::Entity entity, uint32_t guildId) {
         return false;
     }
 
-    guild.members.push_back(GuildMember{entity, charData->name, GuildRank::Member});
-    characters_[entity].guildId = guildId;
+    CharacterData& data = characters_[entity];
+    addGuildMember(guild, GuildMember{entity, data.name, GuildRank::Member}, data);
+    data.guildId = guildId;
 
     return true;
 }
@@ -315,16 +347,16 @@ bool MMORPGPlugin::LeaveGuild(cgs::ecs::Entity entity) {
     uint32_t guildId = charIt->second.guildId;
     auto guildIt = guilds_.find(guildId);
     if (guildIt != guilds_.end()) {
-        auto& members = guildIt->second.members;
-        std::erase_if(members, [entity](const GuildMember& m) { return m.entity == entity; });
+        removeGuildMember(guildIt->second, charIt->second.guildSlot);
 
         // If the guild is now empty, disband it.
-        if (members.empty()) {
+        if (guildIt->second.members.empty()) {
             guilds_.erase(guildIt);
         }
     }
 
     charIt->second.guildId = 0;
+    charIt->second.guildSlot = 0;
     return true;
 }
 
@@ -340,6 +372,43 @@ std::size_t MMORPGPlugin::GuildCount() const noexcept {
     return guilds_.size();
 }
 
+std::span<const GuildMember> MMORPGPlugin::GetOnlineGuildMembers(uint32_t guildId) const {
+    const GuildData* guild = GetGuild(guildId);
+    if (guild == nullptr) {
+        return {};
+    }
+    return {guild->members.data(), guild->onlineCount};
+}
+
+void MMORPGPlugin::swapGuildMembers(GuildData& guild, std::size_t a, std::size_t b) {
+    if (a == b) {
+        return;
+    }
+    std::swap(guild.members[a], guild.members[b]);
+    characters_[guild.members[a].entity].guildSlot = static_cast<uint32_t>(a);
+    characters_[guild.members[b].entity].guildSlot = static_cast<uint32_t>(b);
+}
+
+void MMORPGPlugin::addGuildMember(GuildData& guild, GuildMember member, CharacterData& data) {
+    data.guildSlot = static_cast<uint32_t>(guild.members.size());
+    guild.members.push_back(std::move(member));
+    if (data.online) {
+        swapGuildMembers(guild, data.guildSlot, guild.onlineCount);
+        ++guild.onlineCount;
+    }
+}
+
+void MMORPGPlugin::removeGuildMember(GuildData& guild, std::size_t slot) {
+    // Close the gap inside the online prefix first, then the whole roster.
+    if (slot < guild.onlineCount) {
+        --guild.onlineCount;
+        swapGuildMembers(guild, slot, guild.onlineCount);
+        slot = guild.onlineCount;
+    }
+    swapGuildMembers(guild, slot, guild.members.size() - 1);
+    guild.members.pop_back();
+}
+
 // ============================================================================
 // Chat System
 // ============================================================================
@@ -352,37 +421,61 @@ void MMORPGPlugin::SendChat(cgs::ecs::Entity sender,
         return;
     }
 
-    std::string senderName;
+    cgs::foundation::InternedString senderName;
     auto* charData = GetCharacterData(sender);
     if (charData != nullptr) {
         senderName = charData->name;
     }
 
-    auto& history = chatHistory_[idx];
-    history.push_back(ChatMessage{
-        sender, channel, std::move(senderName), message, std::chrono::steady_clock::now()});
-
-    // Trim to max history size.
-    if (history.size() > kMaxChatHistoryPerChannel) {
-        history.erase(history.begin(),
-                      history.begin() +
-                          static_cast<std::ptrdiff_t>(history.size() - kMaxChatHistoryPerChannel));
+    // Built once: history and subscribers share this copy.
+    SharedChatMessage shared = std::make_shared<const ChatMessage>(
+        ChatMessage{sender, channel, senderName, message, std::chrono::steady_clock::now()});
+    for (const auto& subscription : chatSubscribers_[idx]) {
+        subscription.subscriber(shared);
     }
+    chatHistory_[idx].Push(std::move(shared));
 }
 
 std::vector<ChatMessage> MMORPGPlugin::GetChatHistory(ChatChannel channel,
                                                       std::size_t count) const {
+    std::vector<ChatMessage> history;
+    for (const auto& message : GetSharedChatHistory(channel, count)) {
+        history.push_back(*message);
+    }
+    return history;
+}
+
+std::vector<SharedChatMessage> MMORPGPlugin::GetSharedChatHistory(ChatChannel channel,
+                                                                  std::size_t count) const {
     auto idx = static_cast<std::size_t>(channel);
     if (idx >= kChatChannelCount) {
         return {};
     }
 
-    const auto& history = chatHistory_[idx];
-    if (count >= history.size()) {
-        return history;
+    const auto& ring = chatHistory_[idx];
+    count = std::min(count, ring.size);
+    std::vector<SharedChatMessage> history;
+    history.reserve(count);
+    for (std::size_t age = count; age-- > 0;) {
+        history.push_back(ring.Newest(age));
     }
+    return history;
+}
 
-    return {history.end() - static_cast<std::ptrdiff_t>(count), history.end()};
+ChatSubscriptionId MMORPGPlugin::SubscribeChat(ChatChannel channel, ChatSubscriber subscriber) {
+    auto idx = static_cast<std::size_t>(channel);
+    if (idx >= kChatChannelCount || !subscriber) {
+        return 0;
+    }
+    const ChatSubscriptionId id = nextChatSubscriptionId_++;
+    chatSubscribers_[idx].push_back({id, std::move(subscriber)});
+    return id;
+}
+
+void MMORPGPlugin::UnsubscribeChat(ChatSubscriptionId id) {
+    for (auto& subscribers : chatSubscribers_) {
+        std::erase_if(subscribers, [id](const ChatSubscription& s) { return s.id == id; });
+    }
 }
 
 // ============================================================================
@@ -15,6 +15,7 @@
 #include <queue>
 #include <stack>
 #include <unordered_set>
+#include <utility>
 
 // Platform-specific dynamic library loading.
 #if defined(_WIN32)
@@ -30,6 +31,20 @@ using cgs::foundation::GameResult;
 
 namespace cgs::plugin {
 
+namespace {
+
+/// Plugin name of a dependency string such as "core>=1.2".
+std::string dependencyName(const std::string& dep) {
+    auto specResult = DependencySpec::Parse(dep);
+    if (specResult.hasValue()) {
+        return specResult.value().name;
+    }
+    auto opPos = dep.find_first_of("><=~");
+    return (opPos != std::string::npos) ? dep.substr(0, opPos) : dep;
+}
+
+}  // namespace
+
 // ── Construction / destruction ──────────────────────────────────────────
 
 PluginManager::PluginManager() {
@@ -44,8 +59,12 @@ PluginManager::~PluginManager() {
 PluginManager::PluginManager(PluginManager&& other) noexcept
     : plugins_(std::move(other.plugins_)),
       loadOrder_(std::move(other.loadOrder_)),
+      loadLevels_(std::move(other.loadLevels_)),
+      mapTypeRefs_(std::move(other.mapTypeRefs_)),
       context_(other.context_),
-      eventBus_(std::move(other.eventBus_)) {
+      eventBus_(std::move(other.eventBus_)),
+      parallelExecutor_(std::move(other.parallelExecutor_)),
+      updateBudget_(other.updateBudget_) {
     context_.eventBus = &eventBus_;
 }
 
@@ -55,9 +74,15 @@ PluginManager& PluginManager::operator=(PluginManager&& other) noexcept {
         UnloadAll();
         plugins_ = std::move(other.plugins_);
         loadOrder_ = std::move(other.loadOrder_);
+        loadLevels_ = std::move(other.loadLevels_);
+        mapTypeRefs_ = std::move(other.mapTypeRefs_);
         context_ = other.context_;
         eventBus_ = std::move(other.eventBus_);
         context_.eventBus = &eventBus_;
+        parallelExecutor_ = std::move(other.parallelExecutor_);
+        updateBudget_ = other.updateBudget_;
+        updatePlan_.clear();
+        updatePlanDirty_ = true;
     }
     return *this;
 }
@@ -77,8 +102,19 @@ PluginContext& PluginManager::GetContext() noexcept {
 // ── Dynamic loading ─────────────────────────────────────────────────────
 
 GameResult<void> PluginManager::LoadPlugin(const std::filesystem::path& path) {
+    auto opened = openLibrary(path);
+    if (opened.hasError()) {
+        return GameResult<void>::err(opened.error());
+    }
+    auto staged = std::move(opened).value();
+    return loadPluginInstance(std::move(staged.plugin_),
+                              std::exchange(staged.libraryHandle_, nullptr));
+}
+
+GameResult<PluginManager::StagedPlugin> PluginManager::openLibrary(
+    const std::filesystem::path& path) {
     if (!std::filesystem::exists(path)) {
-        return GameResult<void>::err(
+        return GameResult<StagedPlugin>::err(
             GameError(ErrorCode::PluginLoadFailed, "Plugin file not found: " + path.string()));
     }
 
@@ -95,7 +131,8 @@ GameResult<void> PluginManager::LoadPlugin(const std::filesystem::path& path) {
 #else
         auto errorMsg = std::string(dlerror());
 #endif
-        return GameResult<void>::err(GameError(ErrorCode::PluginLoadFailed, std::move(errorMsg)));
+        return GameResult<StagedPlugin>::err(
+            GameError(ErrorCode::PluginLoadFailed, std::move(errorMsg)));
     }
 
     // Look up the factory function.
@@ -109,7 +146,7 @@ GameResult<void> PluginManager::LoadPlugin(const std::filesystem::path& path) {
 
     if (createFn == nullptr) {
         closeLibrary(handle);
-        return GameResult<void>::err(
+        return GameResult<StagedPlugin>::err(
             GameError(ErrorCode::PluginLoadFailed,
                       "Symbol 'CgsCreatePlugin' not found in: " + path.string()));
     }
@@ -118,11 +155,14 @@ GameResult<void> PluginManager::LoadPlugin(const std::filesystem::path& path) {
     std::unique_ptr<IPlugin> plugin(createFn());
     if (!plugin) {
         closeLibrary(handle);
-        return GameResult<void>::err(GameError(
+        return GameResult<StagedPlugin>::err(GameError(
             ErrorCode::PluginLoadFailed, "CgsCreatePlugin returned null for: " + path.string()));
     }
 
-    return loadPluginInstance(std::move(plugin), handle);
+    StagedPlugin opened;
+    opened.plugin_ = std::move(plugin);
+    opened.libraryHandle_ = handle;
+    return GameResult<StagedPlugin>::ok(std::move(opened));
 }
 
 // ── Static loading ──────────────────────────────────────────────────────
@@ -159,34 +199,90 @@ GameResult<void> PluginManager::InitPlugin(std::string_view name) {
                           std::to_string(static_cast<int>(entry.state)) + ")"));
     }
 
-    if (!entry.plugin->OnInit()) {
+    return finishInit(it->first, entry, entry.plugin->OnInit());
+}
+
+GameResult<void> PluginManager::finishInit(const std::string& name, PluginEntry& entry, bool ok) {
+    if (!ok) {
         entry.state = PluginState::Error;
-        eventBus_.Publish(PluginErrorEvent{std::string(name), "OnInit() failed"});
-        return GameResult<void>::err(GameError(ErrorCode::PluginInitFailed,
-                                               "OnInit() failed for plugin: " + std::string(name)));
+        eventBus_.Publish(PluginErrorEvent{name, "OnInit() failed"});
+        return GameResult<void>::err(
+            GameError(ErrorCode::PluginInitFailed, "OnInit() failed for plugin: " + name));
     }
 
     entry.state = PluginState::Initialized;
-    eventBus_.Publish(PluginInitializedEvent{std::string(name)});
+    eventBus_.Publish(PluginInitializedEvent{name});
     return GameResult<void>::ok();
 }
 
 GameResult<void> PluginManager::InitializeAll() {
-    auto orderResult = resolveDependencies();
-    if (orderResult.hasError()) {
-        return GameResult<void>::err(orderResult.error());
+    auto resolved = resolveDependencies();
+    if (resolved.hasError()) {
+        return GameResult<void>::err(resolved.error());
     }
 
-    loadOrder_ = std::move(orderResult).value();
+    auto report = std::move(resolved).value();
+    loadOrder_ = std::move(report.loadOrder);
+    loadLevels_ = std::move(report.loadLevels);
+    updatePlanDirty_ = true;
 
-    for (const auto& name : loadOrder_) {
-        auto it = plugins_.find(name);
-        if (it == plugins_.end() || it->second.state != PluginState::Loaded) {
-            continue;
+    return initLevels(neededPlugins());
+}
+
+GameResult<void> PluginManager::initLevels(const std::unordered_set<std::string>& wanted) {
+    std::vector<PluginEntry*> parallel;
+    std::vector<const std::string*> parallelNames;
+    std::vector<const std::string*> serial;
+    std::vector<std::function<void()>> tasks;
+
+    for (const auto& level : loadLevels_) {
+        parallel.clear();
+        parallelNames.clear();
+        serial.clear();
+        for (const auto& name : level) {
+            auto it = plugins_.find(name);
+            if (it == plugins_.end() || it->second.state != PluginState::Loaded ||
+                wanted.count(name) == 0) {
+                continue;
+            }
+            if (parallelExecutor_ && it->second.plugin->GetInfo().threadSafeInit) {
+                parallel.push_back(&it->second);
+                parallelNames.push_back(&it->first);
+            } else {
+                serial.push_back(&it->first);
+            }
         }
-        auto result = InitPlugin(name);
-        if (result.hasError()) {
-            return result;
+        if (parallel.size() == 1) {
+            serial.insert(serial.begin(), parallelNames.front());
+            parallel.clear();
+        }
+
+        // Plugins of one level never depend on each other.
+        GameResult<void> failed = GameResult<void>::ok();
+        if (!parallel.empty()) {
+            std::vector<char> ok(parallel.size(), 0);
+            tasks.clear();
+            for (std::size_t i = 0; i < parallel.size(); ++i) {
+                tasks.emplace_back([entry = parallel[i], done = &ok[i]] {
+                    *done = entry->plugin->OnInit() ? 1 : 0;
+                });
+            }
+            parallelExecutor_(tasks);
+            for (std::size_t i = 0; i < parallel.size(); ++i) {
+                auto result = finishInit(*parallelNames[i], *parallel[i], ok[i] != 0);
+                if (result.hasError() && !failed.hasError()) {
+                    failed = std::move(result);
+                }
+            }
+        }
+        for (const auto* name : serial) {
+            if (failed.hasError()) {
+                break;
+            }
+            failed = InitPlugin(*name);
+        }
+        if (failed.hasError()) {
+            return failed;
         }
     }
 
@@ -210,6 +306,7 @@ GameResult<void> PluginManager::ActivatePlugin(std::string_view name) {
     }
 
     entry.state = PluginState::Active;
+    updatePlanDirty_ = true;
     eventBus_.Publish(PluginActivatedEvent{std::string(name)});
     return GameResult<void>::ok();
 }
@@ -230,19 +327,127 @@ GameResult<void> PluginManager::ActivateAll() {
     return GameResult<void>::ok();
 }
 
+// ── Lifecycle: Map types ────────────────────────────────────────────────
+
+GameResult<void> PluginManager::AcquireMapType(std::string_view mapType) {
+    if (loadLevels_.empty() && !plugins_.empty()) {
+        return GameResult<void>::err(GameError(
+            ErrorCode::PluginInvalidState, "AcquireMapType() called before InitializeAll()"));
+    }
+
+    if (auto it = mapTypeRefs_.find(std::string(mapType)); it != mapTypeRefs_.end()) {
+        ++it->second;
+        return GameResult<void>::ok();
+    }
+
+    const auto before = neededPlugins();
+    const auto needed = withDependencies(pluginsForMapType(mapType));
+    auto result = initLevels(needed);
+    if (result.hasError()) {
+        return result;
+    }
+
+    // Activate what this map type brought up; always-needed plugins are
+    // left to ActivateAll().
+    for (const auto& name : loadOrder_) {
+        auto it = plugins_.find(name);
+        if (needed.count(name) > 0 && before.count(name) == 0 && it != plugins_.end() &&
+            it->second.state == PluginState::Initialized) {
+            result = ActivatePlugin(name);
+            if (result.hasError()) {
+                return result;
+            }
+        }
+    }
+    mapTypeRefs_.emplace(std::string(mapType), 1);
+    return GameResult<void>::ok();
+}
+
+void PluginManager::ReleaseMapType(std::string_view mapType) {
+    auto it = mapTypeRefs_.find(std::string(mapType));
+    if (it == mapTypeRefs_.end()) {
+        return;
+    }
+    if (--it->second > 0) {
+        return;
+    }
+    mapTypeRefs_.erase(it);
+
+    const auto released = withDependencies(pluginsForMapType(mapType));
+    const auto stillNeeded = neededPlugins();
+    for (auto name = loadOrder_.rbegin(); name != loadOrder_.rend(); ++name) {
+        if (released.count(*name) > 0 && stillNeeded.count(*name) == 0) {
+            (void)ShutdownPlugin(*name);
+        }
+    }
+}
+
+std::size_t PluginManager::MapTypeRefCount(std::string_view mapType) const {
+    auto it = mapTypeRefs_.find(std::string(mapType));
+    return it == mapTypeRefs_.end() ? 0 : it->second;
+}
+
 // ── Lifecycle: Update ───────────────────────────────────────────────────
 
 void PluginManager::UpdateAll(float deltaTime) {
-    const auto& order = loadOrder_.empty() ? GetAllPluginNames() : loadOrder_;
+    if (updatePlanDirty_) {
+        buildUpdatePlan();
+    }
+    const auto tickStart = std::chrono::steady_clock::now();
 
-    for (const auto& name : order) {
-        auto it = plugins_.find(name);
-        if (it != plugins_.end() && it->second.state == PluginState::Active) {
-            it->second.plugin->OnUpdate(deltaTime);
+    for (const auto& wave : updatePlan_) {
+        updateTasks_.clear();
+        for (auto* entry : wave.parallel) {
+            if (entry->state == PluginState::Active && !deferUpdate(*entry, deltaTime, tickStart)) {
+                updateTasks_.emplace_back([entry, deltaTime] { updatePlugin(*entry, deltaTime); });
+            }
+        }
+        if (updateTasks_.size() > 1 && parallelExecutor_) {
+            parallelExecutor_(updateTasks_);
+        } else {
+            for (auto& task : updateTasks_) {
+                task();
+            }
+        }
+
+        for (auto* entry : wave.serial) {
+            if (!deferUpdate(*entry, deltaTime, tickStart)) {
+                updatePlugin(*entry, deltaTime);
+            }
+        }
+
+        // Report overruns from the calling thread once the wave is done.
+        for (const auto* entries : {&wave.parallel, &wave.serial}) {
+            for (auto* entry : *entries) {
+                if (entry->overran) {
+                    entry->overran = false;
+                    const auto& info = entry->plugin->GetInfo();
+                    eventBus_.Publish(PluginBudgetExceededEvent{
+                        info.name, entry->stats.lastTime, entry->policy.budget});
+                }
+            }
         }
     }
 }
 
+void PluginManager::SetParallelExecutor(ParallelExecutor executor) {
+    parallelExecutor_ = std::move(executor);
+    updatePlanDirty_ = true;
+}
+
+void PluginManager::SetUpdateBudget(std::chrono::microseconds budget) noexcept {
+    updateBudget_ = budget;
+}
+
+GameResult<PluginUpdateStats> PluginManager::GetUpdateStats(std::string_view name) const {
+    auto it = plugins_.find(std::string(name));
+    if (it == plugins_.end()) {
+        return GameResult<PluginUpdateStats>::err(
+            GameError(ErrorCode::PluginNotFound, "Plugin not found: " + std::string(name)));
+    }
+    return GameResult<PluginUpdateStats>::ok(it->second.stats);
+}
+
 // ── Lifecycle: Shutdown ─────────────────────────────────────────────────
 
 GameResult<void> PluginManager::ShutdownPlugin(std::string_view name) {
@@ -281,6 +486,135 @@ void PluginManager::ShutdownAll() {
             it->second.state = PluginState::Loaded;
         }
     }
+    mapTypeRefs_.clear();
+}
+
+// ── Staged replacement ──────────────────────────────────────────────────
+
+PluginManager::StagedPlugin::~StagedPlugin() {
+    reset();
+}
+
+PluginManager::StagedPlugin::StagedPlugin(StagedPlugin&& other) noexcept
+    : plugin_(std::move(other.plugin_)),
+      libraryHandle_(std::exchange(other.libraryHandle_, nullptr)),
+      state_(std::exchange(other.state_, PluginState::Unloaded)) {}
+
+PluginManager::StagedPlugin& PluginManager::StagedPlugin::operator=(StagedPlugin&& other) noexcept {
+    if (this != &other) {
+        reset();
+        plugin_ = std::move(other.plugin_);
+        libraryHandle_ = std::exchange(other.libraryHandle_, nullptr);
+        state_ = std::exchange(other.state_, PluginState::Unloaded);
+    }
+    return *this;
+}
+
+void PluginManager::StagedPlugin::reset() noexcept {
+    if (plugin_) {
+        if (state_ == PluginState::Initialized) {
+            plugin_->OnShutdown();
+        }
+        if (state_ != PluginState::Unloaded) {
+            plugin_->OnUnload();
+        }
+        plugin_.reset();
+    }
+    closeLibrary(std::exchange(libraryHandle_, nullptr));
+    state_ = PluginState::Unloaded;
+}
+
+GameResult<PluginManager::StagedPlugin> PluginManager::StagePlugin(
+    const std::filesystem::path& path) {
+    auto opened = openLibrary(path);
+    if (opened.hasError()) {
+        return opened;
+    }
+    return prepareStaged(std::move(opened).value());
+}
+
+GameResult<PluginManager::StagedPlugin> PluginManager::StagePlugin(
+    std::unique_ptr<IPlugin> plugin) {
+    if (!plugin) {
+        return GameResult<StagedPlugin>::err(
+            GameError(ErrorCode::PluginLoadFailed, "Cannot stage a null plugin"));
+    }
+    StagedPlugin staged;
+    staged.plugin_ = std::move(plugin);
+    return prepareStaged(std::move(staged));
+}
+
+GameResult<PluginManager::StagedPlugin> PluginManager::prepareStaged(StagedPlugin staged) {
+    const auto& info = staged.plugin_->GetInfo();
+    if (info.apiVersion != kPluginApiVersion) {
+        return GameResult<StagedPlugin>::err(GameError(
+            ErrorCode::PluginVersionMismatch,
+            "API version mismatch for '" + info.name + "': expected " +
+                std::to_string(kPluginApiVersion) + ", got " + std::to_string(info.apiVersion)));
+    }
+
+    if (!staged.plugin_->OnLoad(context_)) {
+        return GameResult<StagedPlugin>::err(
+            GameError(ErrorCode::PluginLoadFailed, "OnLoad() failed for plugin: " + info.name));
+    }
+    staged.state_ = PluginState::Loaded;
+
+    if (!staged.plugin_->OnInit()) {
+        return GameResult<StagedPlugin>::err(
+            GameError(ErrorCode::PluginInitFailed, "OnInit() failed for plugin: " + info.name));
+    }
+    staged.state_ = PluginState::Initialized;
+    return GameResult<StagedPlugin>::ok(std::move(staged));
+}
+
+GameResult<void> PluginManager::SwapPlugin(StagedPlugin staged) {
+    if (!staged || staged.state_ != PluginState::Initialized) {
+        return GameResult<void>::err(
+            GameError(ErrorCode::PluginInvalidState, "Staged plugin is not initialized"));
+    }
+
+    const auto name = staged.plugin_->GetInfo().name;
+    auto it = plugins_.find(name);
+    if (it == plugins_.end()) {
+        return GameResult<void>::err(
+            GameError(ErrorCode::PluginNotFound, "Plugin not found: " + name));
+    }
+
+    auto& entry = it->second;
+    if (entry.state != PluginState::Active && entry.state != PluginState::Initialized) {
+        return GameResult<void>::err(GameError(
+            ErrorCode::PluginInvalidState,
+            "Plugin '" + name + "' is not in Active or Initialized state"));
+    }
+
+    // Retire the running instance.
+    eventBus_.Publish(PluginShutdownEvent{name});
+    const auto runningState = entry.state;
+    entry.state = PluginState::ShuttingDown;
+    entry.plugin->OnShutdown();
+    entry.plugin->OnUnload();
+
+    // Flip: the staged instance takes the slot; the old one leaves with
+    // the staged holder, already shut down.
+    std::swap(entry.plugin, staged.plugin_);
+    std::swap(entry.libraryHandle, staged.libraryHandle_);
+    staged.state_ = PluginState::Unloaded;
+    staged.reset();
+
+    entry.state = runningState;
+    entry.loadedAt = std::chrono::steady_clock::now();
+    entry.stats = PluginUpdateStats{};
+    entry.pendingDelta = 0.0f;
+    entry.deferredLastTick = false;
+    entry.overran = false;
+    updatePlanDirty_ = true;
+
+    eventBus_.Publish(PluginLoadedEvent{name, entry.plugin->GetInfo().version});
+    eventBus_.Publish(PluginInitializedEvent{name});
+    if (runningState == PluginState::Active) {
+        eventBus_.Publish(PluginActivatedEvent{name});
+    }
+    return GameResult<void>::ok();
 }
 
 // ── Lifecycle: Unload ───────────────────────────────────────────────────
@@ -309,12 +643,16 @@ GameResult<void> PluginManager::UnloadPlugin(std::string_view name) {
     }
 
     plugins_.erase(it);
+    updatePlanDirty_ = true;
 
     // Remove from load order.
     auto orderIt = std::find(loadOrder_.begin(), loadOrder_.end(), std::string(name));
     if (orderIt != loadOrder_.end()) {
         loadOrder_.erase(orderIt);
     }
+    for (auto& level : loadLevels_) {
+        std::erase(level, name);
+    }
 
     return GameResult<void>::ok();
 }
@@ -337,6 +675,9 @@ void PluginManager::UnloadAll() {
 
     plugins_.clear();
     loadOrder_.clear();
+    loadLevels_.clear();
+    updatePlan_.clear();
+    updatePlanDirty_ = true;
 }
 
 // ── Queries ─────────────────────────────────────────────────────────────
@@ -415,17 +756,19 @@ GameResult<void> PluginManager::loadPluginInstance(std::unique_ptr<IPlugin> plug
     entry.libraryHandle = libraryHandle;
     entry.state = PluginState::Loaded;
     entry.loadedAt = std::chrono::steady_clock::now();
+    entry.allocTag = cgs::foundation::AllocTracker::Register("plugin." + info.name);
 
     auto pluginName = info.name;
     auto pluginVersion = info.version;
     plugins_.emplace(pluginName, std::move(entry));
+    updatePlanDirty_ = true;
 
     eventBus_.Publish(PluginLoadedEvent{pluginName, pluginVersion});
 
     return GameResult<void>::ok();
 }
 
-GameResult<std::vector<std::string>> PluginManager::resolveDependencies() const {
+GameResult<PluginManager::DependencyReport> PluginManager::resolveDependencies() const {
     auto report = ValidateDependencies();
     if (!report.success) {
         // Build a detailed error message from all issues.
@@ -446,11 +789,54 @@ GameResult<std::vector<std::string>> PluginManager::resolveDependencies() const
             }
             msg += "]";
         }
-        return GameResult<std::vector<std::string>>::err(
+        return GameResult<DependencyReport>::err(
             GameError(ErrorCode::DependencyError, std::move(msg)));
     }
 
-    return GameResult<std::vector<std::string>>::ok(std::move(report.loadOrder));
+    return GameResult<DependencyReport>::ok(std::move(report));
+}
+
+std::unordered_set<std::string> PluginManager::withDependencies(
+    const std::vector<std::string>& roots) const {
+    std::unordered_set<std::string> closure;
+    std::vector<std::string> stack(roots.begin(), roots.end());
+    while (!stack.empty()) {
+        auto name = std::move(stack.back());
+        stack.pop_back();
+        auto it = plugins_.find(name);
+        if (it == plugins_.end() || !closure.insert(name).second) {
+            continue;
+        }
+        for (const auto& dep : it->second.plugin->GetInfo().dependencies) {
+            stack.push_back(dependencyName(dep));
+        }
+    }
+    return closure;
+}
+
+std::vector<std::string> PluginManager::pluginsForMapType(std::string_view mapType) const {
+    std::vector<std::string> names;
+    for (const auto& [name, entry] : plugins_) {
+        const auto& types = entry.plugin->GetInfo().mapTypes;
+        if (std::find(types.begin(), types.end(), mapType) != types.end()) {
+            names.push_back(name);
+        }
+    }
+    return names;
+}
+
+std::unordered_set<std::string> PluginManager::neededPlugins() const {
+    std::vector<std::string> roots;
+    for (const auto& [name, entry] : plugins_) {
+        const auto& types = entry.plugin->GetInfo().mapTypes;
+        const bool acquired = std::any_of(types.begin(), types.end(), [&](const auto& type) {
+            return mapTypeRefs_.count(type) > 0;
+        });
+        if (types.empty() || acquired) {
+            roots.push_back(name);
+        }
+    }
+    return withDependencies(roots);
 }
 
 // ── Dependency validation ───────────────────────────────────────────────
@@ -471,14 +857,7 @@ PluginManager::DependencyReport PluginManager::ValidateDependencies() const {
             inDegree[name] = 0;
         }
         for (const auto& dep : entry.plugin->GetInfo().dependencies) {
-            auto specResult = DependencySpec::Parse(dep);
-            std::string depName;
-            if (specResult.hasValue()) {
-                depName = specResult.value().name;
-            } else {
-                auto opPos = dep.find_first_of("><=~");
-                depName = (opPos != std::string::npos) ? dep.substr(0, opPos) : dep;
-            }
+            auto depName = dependencyName(dep);
 
             // Only add edges for loaded plugins (skip missing deps).
             if (plugins_.count(depName) > 0) {
@@ -523,22 +902,30 @@ PluginManager::DependencyReport PluginManager::ValidateDependencies() const {
     std::vector<std::string> sorted;
     sorted.reserve(plugins_.size());
 
+    // One round per level: everything ready now has no pending dependency.
     while (!readyQueue.empty()) {
-        auto current = readyQueue.front();
-        readyQueue.pop();
-
-        if (plugins_.count(current) > 0) {
-            sorted.push_back(current);
-        }
+        std::vector<std::string> level;
+        for (std::size_t n = readyQueue.size(); n > 0; --n) {
+            auto current = readyQueue.front();
+            readyQueue.pop();
+
+            if (plugins_.count(current) > 0) {
+                sorted.push_back(current);
+                level.push_back(current);
+            }
 
-        if (graph.count(current) > 0) {
-            for (const auto& dependent : graph.at(current)) {
-                inDegree[dependent]--;
-                if (inDegree[dependent] == 0) {
-                    readyQueue.push(dependent);
+            if (graph.count(current) > 0) {
+                for (const auto& dependent : graph.at(current)) {
+                    inDegree[dependent]--;
+                    if (inDegree[dependent] == 0) {
+                        readyQueue.push(dependent);
+                    }
                 }
             }
         }
+        if (!level.empty()) {
+            report.loadLevels.push_back(std::move(level));
+        }
     }
 
     report.loadOrder = std::move(sorted);
@@ -664,6 +1051,120 @@ std::vector<std::string> PluginManager::detectCycle(
     return cycle;
 }
 
+void PluginManager::buildUpdatePlan() {
+    updatePlan_.clear();
+    updatePlanDirty_ = false;
+    const auto order = loadOrder_.empty() ? GetAllPluginNames() : loadOrder_;
+    for (auto& [name, entry] : plugins_) {
+        entry.policy = entry.plugin->GetUpdatePolicy();
+    }
+
+    if (!parallelExecutor_) {
+        UpdateWave wave;
+        for (const auto& name : order) {
+            auto it = plugins_.find(name);
+            if (it != plugins_.end()) {
+                wave.serial.push_back(&it->second);
+            }
+        }
+        updatePlan_.push_back(std::move(wave));
+        return;
+    }
+
+    // A plugin's wave is one past the latest wave among the plugins it
+    // updates after; edges closing a cycle are ignored.
+    std::unordered_map<std::string, std::size_t> waveOf;
+    std::unordered_set<std::string> visiting;
+    std::function<std::size_t(const std::string&)> waveFor =
+        [&](const std::string& name) -> std::size_t {
+        if (auto it = waveOf.find(name); it != waveOf.end()) {
+            return it->second;
+        }
+        if (!visiting.insert(name).second) {
+            return 0;
+        }
+        const auto& info = plugins_.at(name).plugin->GetInfo();
+        std::size_t wave = 0;
+        auto after = [&](const std::string& dep) {
+            if (plugins_.count(dep) > 0) {
+                wave = std::max(wave, waveFor(dep) + 1);
+            }
+        };
+        for (const auto& dep : info.dependencies) {
+            after(dependencyName(dep));
+        }
+        for (const auto& dep : plugins_.at(name).policy.updateAfter) {
+            after(dep);
+        }
+        visiting.erase(name);
+        waveOf.emplace(name, wave);
+        return wave;
+    };
+
+    for (const auto& name : order) {
+        auto it = plugins_.find(name);
+        if (it == plugins_.end()) {
+            continue;
+        }
+        const std::size_t wave = waveFor(name);
+        if (wave >= updatePlan_.size()) {
+            updatePlan_.resize(wave + 1);
+        }
+        auto& entry = it->second;
+        (entry.policy.threadSafe ? updatePlan_[wave].parallel
+                                                   : updatePlan_[wave].serial)
+            .push_back(&entry);
+    }
+}
+
+void PluginManager::updatePlugin(PluginEntry& entry, float deltaTime) {
+    if (entry.state != PluginState::Active) {
+        return;
+    }
+    const float delta = deltaTime + entry.pendingDelta;
+    entry.pendingDelta = 0.0f;
+    entry.deferredLastTick = false;
+
+    const auto allocsBefore = cgs::foundation::AllocTracker::ThreadCounts();
+    const auto start = std::chrono::steady_clock::now();
+    {
+        cgs::foundation::AllocTagScope allocScope(entry.allocTag);
+        entry.plugin->OnUpdate(delta);
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    const auto allocsAfter = cgs::foundation::AllocTracker::ThreadCounts();
+
+    auto& stats = entry.stats;
+    stats.allocations += allocsAfter.allocations - allocsBefore.allocations;
+    stats.allocatedBytes += allocsAfter.bytes - allocsBefore.bytes;
+    stats.lastTime = elapsed;
+    stats.maxTime = std::max(stats.maxTime, elapsed);
+    stats.totalTime += elapsed;
+    ++stats.updates;
+
+    const auto budget = entry.policy.budget;
+    entry.overran = budget.count() > 0 && elapsed > budget;
+    if (entry.overran) {
+        ++stats.overruns;
+    }
+}
+
+bool PluginManager::deferUpdate(PluginEntry& entry, float deltaTime,
+                                std::chrono::steady_clock::time_point tickStart) const {
+    if (updateBudget_.count() <= 0 || entry.deferredLastTick ||
+        entry.state != PluginState::Active || !entry.policy.deferrable) {
+        return false;
+    }
+    if (std::chrono::steady_clock::now() - tickStart < updateBudget_) {
+        return false;
+    }
+    entry.pendingDelta += deltaTime;
+    entry.deferredLastTick = true;
+    ++entry.stats.deferrals;
+    return true;
+}
+
 void PluginManager::closeLibrary(void* handle) {
     if (handle == nullptr) {
         return;
@@ -6,17 +6,20 @@
 
 #include "cgs/service/auth_server.hpp"
 
+#include "cgs/foundation/blocking_executor.hpp"
 #include "cgs/foundation/error_code.hpp"
 #include "cgs/foundation/game_error.hpp"
 #include "cgs/service/input_validator.hpp"
 #include "cgs/service/password_hasher.hpp"
 #include "cgs/service/rate_limiter.hpp"
 #include "cgs/service/token_blacklist.hpp"
+#include "cgs/service/token_cache.hpp"
 #include "cgs/service/token_provider.hpp"
 #include "cgs/service/token_store.hpp"
 #include "cgs/service/user_repository.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <string>
 
@@ -25,6 +28,184 @@ namespace cgs::service {
 using cgs::foundation::ErrorCode;
 using cgs::foundation::GameError;
 
+namespace {
+
+/// Verify @p token and cache the claims on success.
+cgs::foundation::GameResult<TokenClaims> verifyAndCache(const TokenProvider& provider,
+                                                        VerifiedTokenCache& cache,
+                                                        const TokenBlacklist& blacklist,
+                                                        std::string_view token) {
+    auto result = provider.validateAccessToken(token);
+    if (result.hasValue()) {
+        const auto& claims = result.value();
+        cache.insert(token, claims);
+        // A revocation that landed between the provider's blacklist check
+        // and the insert has already fired its invalidation.
+        if (!claims.jti.empty() && blacklist.isRevoked(claims.jti)) {
+            cache.invalidate(claims.jti);
+        }
+    }
+    return result;
+}
+
+using Clock = std::chrono::steady_clock;
+
+/// AuthOverloaded result for a login the hashing pool turned away.
+cgs::foundation::GameResult<TokenPair> overloaded(const char* message) {
+    return cgs::foundation::GameResult<TokenPair>::err(
+        GameError(ErrorCode::AuthOverloaded, message));
+}
+
+/// Add @p elapsed to @p total and raise @p max to it (microseconds).
+void record(std::atomic<uint64_t>& total,
+            std::atomic<uint64_t>& max,
+            std::chrono::steady_clock::duration elapsed) {
+    const auto us = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+    total.fetch_add(us);
+    uint64_t seen = max.load();
+    while (us > seen && !max.compare_exchange_weak(seen, us)) {
+    }
+}
+
+}  // anonymous namespace
+
+// -- Login pipeline -----------------------------------------------------------
+
+/// The login steps after rate limiting, plus the hashing pool running them
+/// for loginAsync().  Holds the components by reference; the server owns
+/// it behind a pointer so queued work survives the server being moved.
+struct AuthServer::LoginPipeline {
+    LoginPipeline(const AuthConfig& config,
+                  IUserRepository& userRepo,
+                  ITokenStore& tokenStore,
+                  TokenProvider& tokenProvider,
+                  PasswordHasher& passwordHasher,
+                  RateLimiter& rateLimiter)
+        : users(userRepo),
+          tokens(tokenStore),
+          provider(tokenProvider),
+          hasher(passwordHasher),
+          limiter(rateLimiter),
+          accessTokenExpiry(config.accessTokenExpiry),
+          refreshTokenExpiry(config.refreshTokenExpiry),
+          queueLimit(config.passwordHashQueueLimit),
+          queueDeadline(config.passwordHashQueueDeadline) {
+        if (config.passwordHashThreads > 0) {
+            workers =
+                std::make_unique<cgs::foundation::BlockingExecutor>(config.passwordHashThreads);
+        }
+    }
+
+    /// Check the password and issue tokens.
+    cgs::foundation::GameResult<TokenPair> complete(std::string_view username,
+                                                    std::string_view password,
+                                                    const std::string& clientIp);
+
+    /// Worker body of a queued loginAsync().
+    void run(Clock::time_point enqueuedAt,
+             const std::string& username,
+             const std::string& password,
+             const std::string& clientIp,
+             const LoginCallback& onDone);
+
+    IUserRepository& users;
+    ITokenStore& tokens;
+    TokenProvider& provider;
+    PasswordHasher& hasher;
+    RateLimiter& limiter;
+    std::chrono::seconds accessTokenExpiry;
+    std::chrono::seconds refreshTokenExpiry;
+    std::size_t queueLimit;
+    std::chrono::milliseconds queueDeadline;
+
+    std::atomic<std::size_t> pending{0};
+    std::atomic<uint64_t> completed{0};
+    std::atomic<uint64_t> shed{0};
+    std::atomic<uint64_t> expired{0};
+    std::atomic<uint64_t> totalQueueWaitUs{0};
+    std::atomic<uint64_t> maxQueueWaitUs{0};
+    std::atomic<uint64_t> totalHashUs{0};
+    std::atomic<uint64_t> maxHashUs{0};
+
+    std::unique_ptr<cgs::foundation::BlockingExecutor> workers;  // Last: joined first
+};
+
+cgs::foundation::GameResult<TokenPair> AuthServer::LoginPipeline::complete(
+    std::string_view username, std::string_view password, const std::string& clientIp) {
+    // Find user.
+    auto userOpt = users.findByUsername(username);
+    if (!userOpt.has_value()) {
+        return cgs::foundation::GameResult<TokenPair>::err(
+            GameError(ErrorCode::InvalidCredentials, "invalid username or password"));
+    }
+
+    auto& user = *userOpt;
+
+    // Check account status.
+    if (user.status != UserStatus::Active) {
+        return cgs::foundation::GameResult<TokenPair>::err(
+            GameError(ErrorCode::AuthenticationFailed, "account is not active"));
+    }
+
+    // Verify password.
+    const auto hashStart = Clock::now();
+    const bool verified = hasher.verify(password, user.passwordHash, user.salt);
+    record(totalHashUs, maxHashUs, Clock::now() - hashStart);
+    if (!verified) {
+        return cgs::foundation::GameResult<TokenPair>::err(
+            GameError(ErrorCode::InvalidCredentials, "invalid username or password"));
+    }
+
+    // Build claims.
+    TokenClaims claims;
+    claims.subject = std::to_string(user.id);
+    claims.username = user.username;
+    claims.roles = user.roles;
+
+    // Generate access token.
+    auto accessToken = provider.generateAccessToken(claims, accessTokenExpiry);
+
+    // Generate and store refresh token.
+    auto refreshTokenStr = TokenProvider::generateRefreshToken();
+    RefreshTokenRecord refreshRecord;
+    refreshRecord.token = refreshTokenStr;
+    refreshRecord.userId = user.id;
+    refreshRecord.expiresAt = std::chrono::system_clock::now() + refreshTokenExpiry;
+    refreshRecord.revoked = false;
+    tokens.store(std::move(refreshRecord));
+
+    // Reset rate limiter on successful login.
+    limiter.reset(clientIp);
+
+    TokenPair pair;
+    pair.accessToken = std::move(accessToken);
+    pair.refreshToken = std::move(refreshTokenStr);
+    pair.accessExpiresIn = accessTokenExpiry;
+    pair.refreshExpiresIn = refreshTokenExpiry;
+    return cgs::foundation::GameResult<TokenPair>::ok(std::move(pair));
+}
+
+void AuthServer::LoginPipeline::run(Clock::time_point enqueuedAt,
+                                    const std::string& username,
+                                    const std::string& password,
+                                    const std::string& clientIp,
+                                    const LoginCallback& onDone) {
+    const auto waited = Clock::now() - enqueuedAt;
+    record(totalQueueWaitUs, maxQueueWaitUs, waited);
+    if (waited > queueDeadline) {
+        // The client has likely given up; don't spend a hash on it.
+        expired.fetch_add(1);
+        pending.fetch_sub(1);
+        onDone(overloaded("login timed out waiting for a hash worker"));
+        return;
+    }
+    auto result = complete(username, password, clientIp);
+    completed.fetch_add(1);
+    pending.fetch_sub(1);
+    onDone(std::move(result));
+}
+
 // -- Construction / destruction -----------------------------------------------
 
 AuthServer::AuthServer(AuthConfig config,
@@ -34,12 +215,23 @@ AuthServer::AuthServer(AuthConfig config,
       userRepo_(std::move(userRepo)),
       tokenStore_(std::move(tokenStore)),
       tokenProvider_(std::make_unique<TokenProvider>(config_)),
-      passwordHasher_(std::make_unique<PasswordHasher>()),
-      rateLimiter_(
-          std::make_unique<RateLimiter>(config_.rateLimitMaxAttempts, config_.rateLimitWindow)),
-      blacklist_(std::make_unique<TokenBlacklist>(config_.blacklistCleanupInterval)) {
+      passwordHasher_(std::make_unique<PasswordHasher>(config_.passwordHashCost)),
+      rateLimiter_(std::make_unique<RateLimiter>(
+          config_.rateLimitMaxAttempts, config_.rateLimitWindow, config_.rateLimitMaxKeys)),
+      blacklist_(std::make_unique<TokenBlacklist>(config_.blacklistCleanupInterval)),
+      tokenCache_(std::make_unique<VerifiedTokenCache>(config_.tokenCacheCapacity)),
+      logins_(std::make_unique<LoginPipeline>(
+          config_, *userRepo_, *tokenStore_, *tokenProvider_, *passwordHasher_, *rateLimiter_)) {
     // Wire the blacklist into the token provider for validation checks.
     tokenProvider_->setBlacklist(blacklist_.get());
+
+    // Revoked tokens leave the verification cache.
+    blacklist_->onRevoked.connect(
+        [cache = tokenCache_.get()](std::string_view jti) { cache->invalidate(jti); });
+
+    if (!config_.rsaPublicKeyPem.empty() && config_.tokenVerifyThreads > 0) {
+        verifier_ = std::make_unique<cgs::foundation::BlockingExecutor>(config_.tokenVerifyThreads);
+    }
 }
 
 AuthServer::~AuthServer() = default;
@@ -98,7 +290,12 @@ cgs::foundation::GameResult<UserRecord> AuthServer::registerUser(
 
     // Persist and return.
     auto id = userRepo_->create(std::move(record));
-    auto stored = userRepo_->findById(id);
+    auto stored = id != 0 ? userRepo_->findById(id) : std::nullopt;
+    if (!stored) {
+        // E.g. a concurrent registration took the username on another node.
+        return cgs::foundation::GameResult<UserRecord>::err(
+            GameError(ErrorCode::DatabaseError, "failed to store user"));
+    }
     return cgs::foundation::GameResult<UserRecord>::ok(std::move(*stored));
 }
 
@@ -112,55 +309,58 @@ cgs::foundation::GameResult<TokenPair> AuthServer::login(std::string_view userna
         return cgs::foundation::GameResult<TokenPair>::err(
             GameError(ErrorCode::RateLimitExceeded, "too many login attempts, try again later"));
     }
+    return logins_->complete(username, password, clientIp);
+}
 
-    // Find user.
-    auto userOpt = userRepo_->findByUsername(username);
-    if (!userOpt.has_value()) {
-        return cgs::foundation::GameResult<TokenPair>::err(
-            GameError(ErrorCode::InvalidCredentials, "invalid username or password"));
+void AuthServer::loginAsync(std::string_view username,
+                            std::string_view password,
+                            const std::string& clientIp,
+                            LoginCallback onDone) {
+    if (!rateLimiter_->allow(clientIp)) {
+        onDone(cgs::foundation::GameResult<TokenPair>::err(
+            GameError(ErrorCode::RateLimitExceeded, "too many login attempts, try again later")));
+        return;
     }
-
-    auto& user = *userOpt;
-
-    // Check account status.
-    if (user.status != UserStatus::Active) {
-        return cgs::foundation::GameResult<TokenPair>::err(
-            GameError(ErrorCode::AuthenticationFailed, "account is not active"));
+    if (!logins_->workers) {
+        onDone(logins_->complete(username, password, clientIp));
+        return;
     }
 
-    // Verify password.
-    if (!passwordHasher_->verify(password, user.passwordHash, user.salt)) {
-        return cgs::foundation::GameResult<TokenPair>::err(
-            GameError(ErrorCode::InvalidCredentials, "invalid username or password"));
+    // Count the login as pending before queueing it: the limit holds
+    // even while many callers submit at once.
+    if (logins_->pending.fetch_add(1) >= logins_->queueLimit) {
+        logins_->pending.fetch_sub(1);
+        logins_->shed.fetch_add(1);
+        onDone(overloaded("login queue is full, try again later"));
+        return;
     }
 
-    // Build claims.
-    TokenClaims claims;
-    claims.subject = std::to_string(user.id);
-    claims.username = user.username;
-    claims.roles = user.roles;
-
-    // Generate access token.
-    auto accessToken = tokenProvider_->generateAccessToken(claims, config_.accessTokenExpiry);
-
-    // Generate and store refresh token.
-    auto refreshTokenStr = TokenProvider::generateRefreshToken();
-    RefreshTokenRecord refreshRecord;
-    refreshRecord.token = refreshTokenStr;
-    refreshRecord.userId = user.id;
-    refreshRecord.expiresAt = std::chrono::system_clock::now() + config_.refreshTokenExpiry;
-    refreshRecord.revoked = false;
-    tokenStore_->store(std::move(refreshRecord));
-
-    // Reset rate limiter on successful login.
-    rateLimiter_->reset(clientIp);
+    // Capture the pipeline, not this: it stays put if the server moves.
+    const bool queued = logins_->workers->post([pipeline = logins_.get(),
+                                                enqueuedAt = Clock::now(),
+                                                username = std::string(username),
+                                                password = std::string(password),
+                                                clientIp,
+                                                onDone] {
+        pipeline->run(enqueuedAt, username, password, clientIp, onDone);
+    });
+    if (!queued) {
+        logins_->pending.fetch_sub(1);
+        onDone(overloaded("auth server is shutting down"));
+    }
+}
 
-    TokenPair pair;
-    pair.accessToken = std::move(accessToken);
-    pair.refreshToken = std::move(refreshTokenStr);
-    pair.accessExpiresIn = config_.accessTokenExpiry;
-    pair.refreshExpiresIn = config_.refreshTokenExpiry;
-    return cgs::foundation::GameResult<TokenPair>::ok(std::move(pair));
+LoginPoolStats AuthServer::loginPoolStats() const {
+    LoginPoolStats stats;
+    stats.pending = logins_->pending.load();
+    stats.completed = logins_->completed.load();
+    stats.shed = logins_->shed.load();
+    stats.expired = logins_->expired.load();
+    stats.totalQueueWait = std::chrono::microseconds{logins_->totalQueueWaitUs.load()};
+    stats.maxQueueWait = std::chrono::microseconds{logins_->maxQueueWaitUs.load()};
+    stats.totalHashTime = std::chrono::microseconds{logins_->totalHashUs.load()};
+    stats.maxHashTime = std::chrono::microseconds{logins_->maxHashUs.load()};
+    return stats;
 }
 
 // -- Token refresh (SRS-SVC-001.4) --------------------------------------------
@@ -243,8 +443,56 @@ cgs::foundation::GameResult<void> AuthServer::logout(std::string_view refreshTok
 
 cgs::foundation::GameResult<TokenClaims> AuthServer::validateToken(
     std::string_view accessToken) const {
+    if (auto cached = tokenCache_->find(accessToken)) {
+        if (!revokedSinceCached(*cached)) {
+            return cgs::foundation::GameResult<TokenClaims>::ok(std::move(*cached));
+        }
+        return cgs::foundation::GameResult<TokenClaims>::err(
+            GameError(ErrorCode::TokenRevoked, "token has been revoked"));
+    }
     // TokenProvider::validateAccessToken already checks the blacklist.
-    return tokenProvider_->validateAccessToken(accessToken);
+    return verifyAndCache(*tokenProvider_, *tokenCache_, *blacklist_, accessToken);
+}
+
+void AuthServer::validateTokenAsync(std::string_view accessToken,
+                                    TokenValidationCallback onDone) const {
+    if (auto cached = tokenCache_->find(accessToken)) {
+        if (!revokedSinceCached(*cached)) {
+            onDone(cgs::foundation::GameResult<TokenClaims>::ok(std::move(*cached)));
+        } else {
+            onDone(cgs::foundation::GameResult<TokenClaims>::err(
+                GameError(ErrorCode::TokenRevoked, "token has been revoked")));
+        }
+        return;
+    }
+    if (!verifier_) {
+        onDone(verifyAndCache(*tokenProvider_, *tokenCache_, *blacklist_, accessToken));
+        return;
+    }
+
+    // Capture the components, not this: they stay put if the server moves.
+    (void)verifier_->post([provider = tokenProvider_.get(),
+                           cache = tokenCache_.get(),
+                           blacklist = blacklist_.get(),
+                           token = std::string(accessToken),
+                           onDone = std::move(onDone)] {
+        onDone(verifyAndCache(*provider, *cache, *blacklist, token));
+    });
+}
+
+std::size_t AuthServer::cachedTokenCount() const {
+    return tokenCache_->size();
+}
+
+bool AuthServer::revokedSinceCached(const TokenClaims& claims) const {
+    // Local revocations invalidate the cache directly; ones merged from
+    // other nodes carry no jti, so cache hits consult the blacklist (a
+    // lock-free filter probe when the token is not revoked).
+    if (claims.jti.empty() || !blacklist_->isRevoked(claims.jti)) {
+        return false;
+    }
+    tokenCache_->invalidate(claims.jti);
+    return true;
 }
 
 // -- Access token revocation (SRS-NFR-014) ------------------------------------
@@ -297,6 +545,10 @@ std::size_t AuthServer::cleanupBlacklist() {
     return blacklist_->cleanup();
 }
 
+TokenBlacklist& AuthServer::blacklist() noexcept {
+    return *blacklist_;
+}
+
 // -- Validation helpers -------------------------------------------------------
 
 bool AuthServer::isValidEmail(std::string_view email) const {
@@ -6,9 +6,12 @@
 /// Portable C++ implementation with no external dependencies.
 /// Used internally by PasswordHasher and TokenProvider.
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <optional>
 #include <random>
 #include <string>
 #include <string_view>
@@ -20,61 +23,100 @@ namespace cgs::service::detail {
 // SHA-256 (FIPS 180-4)
 // =============================================================================
 
-/// Compute SHA-256 digest of the input data.
-/// Returns 32-byte raw digest.
-[[nodiscard]] inline std::array<uint8_t, 32> sha256(const uint8_t* data, std::size_t length) {
-    // Initial hash values (first 32 bits of fractional parts of square roots
-    // of the first 8 primes).
-    uint32_t h0 = 0x6a09e667, h1 = 0xbb67ae85, h2 = 0x3c6ef372, h3 = 0xa54ff53a, h4 = 0x510e527f,
-             h5 = 0x9b05688c, h6 = 0x1f83d9ab, h7 = 0x5be0cd19;
-
-    // Round constants (first 32 bits of fractional parts of cube roots
-    // of the first 64 primes).
-    static constexpr uint32_t k[64] = {
-        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4,
-        0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe,
-        0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f,
-        0x4a7484aa, 0x5cb0a9dc, 0x76f988da, 0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
-        0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc,
-        0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
-        0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116,
-        0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
-        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7,
-        0xc67178f2};
-
-    auto rotr = [](uint32_t x, unsigned n) -> uint32_t { return (x >> n) | (x << (32 - n)); };
-
-    // Pre-processing: pad the message.
-    const uint64_t bitLen = static_cast<uint64_t>(length) * 8;
-    std::vector<uint8_t> msg(data, data + length);
-    msg.push_back(0x80);
-    while ((msg.size() % 64) != 56) {
-        msg.push_back(0x00);
+/// Incremental SHA-256.  Hashes input as it arrives, without copying it,
+/// and can be copied to resume from a common prefix (see HmacSha256Key).
+class Sha256 {
+public:
+    Sha256& update(const uint8_t* data, std::size_t length) {
+        totalLength_ += length;
+        if (buffered_ > 0) {
+            const std::size_t take = std::min(length, buffer_.size() - buffered_);
+            std::memcpy(buffer_.data() + buffered_, data, take);
+            buffered_ += take;
+            data += take;
+            length -= take;
+            if (buffered_ < buffer_.size()) {
+                return *this;
+            }
+            compress(buffer_.data());
+            buffered_ = 0;
+        }
+        while (length >= 64) {
+            compress(data);
+            data += 64;
+            length -= 64;
+        }
+        if (length > 0) {
+            std::memcpy(buffer_.data(), data, length);
+            buffered_ = length;
+        }
+        return *this;
     }
-    for (int i = 7; i >= 0; --i) {
-        msg.push_back(static_cast<uint8_t>((bitLen >> (i * 8)) & 0xFF));
+
+    Sha256& update(std::string_view input) {
+        return update(reinterpret_cast<const uint8_t*>(input.data()), input.size());
     }
 
-    // Process each 512-bit (64-byte) block.
-    for (std::size_t offset = 0; offset < msg.size(); offset += 64) {
-        uint32_t w[64]{};
-        for (int i = 0; i < 16; ++i) {
-            auto base = offset + static_cast<std::size_t>(i) * 4;
-            w[i] = (static_cast<uint32_t>(msg[base]) << 24) |
-                   (static_cast<uint32_t>(msg[base + 1]) << 16) |
-                   (static_cast<uint32_t>(msg[base + 2]) << 8) |
-                   static_cast<uint32_t>(msg[base + 3]);
+    /// Pad, and return the digest.  The object is spent afterwards.
+    [[nodiscard]] std::array<uint8_t, 32> finish() {
+        const uint64_t bitLen = totalLength_ * 8;
+        buffer_[buffered_++] = 0x80;
+        if (buffered_ > 56) {
+            std::memset(buffer_.data() + buffered_, 0, buffer_.size() - buffered_);
+            compress(buffer_.data());
+            buffered_ = 0;
         }
-        for (int i = 16; i < 64; ++i) {
+        std::memset(buffer_.data() + buffered_, 0, 56 - buffered_);
+        for (std::size_t i = 0; i < 8; ++i) {
+            buffer_[56 + i] = static_cast<uint8_t>(bitLen >> (56 - 8 * i));
+        }
+        compress(buffer_.data());
+
+        std::array<uint8_t, 32> digest{};
+        for (std::size_t i = 0; i < 8; ++i) {
+            digest[i * 4] = static_cast<uint8_t>(state_[i] >> 24);
+            digest[i * 4 + 1] = static_cast<uint8_t>(state_[i] >> 16);
+            digest[i * 4 + 2] = static_cast<uint8_t>(state_[i] >> 8);
+            digest[i * 4 + 3] = static_cast<uint8_t>(state_[i]);
+        }
+        return digest;
+    }
+
+private:
+    void compress(const uint8_t* block) {
+        // Round constants (first 32 bits of fractional parts of cube roots
+        // of the first 64 primes).
+        static constexpr uint32_t k[64] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4,
+            0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe,
+            0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f,
+            0x4a7484aa, 0x5cb0a9dc, 0x76f988da, 0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+            0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc,
+            0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+            0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116,
+            0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7,
+            0xc67178f2};
+
+        auto rotr = [](uint32_t x, unsigned n) -> uint32_t { return (x >> n) | (x << (32 - n)); };
+
+        uint32_t w[64];
+        for (std::size_t i = 0; i < 16; ++i) {
+            w[i] = (static_cast<uint32_t>(block[i * 4]) << 24) |
+                   (static_cast<uint32_t>(block[i * 4 + 1]) << 16) |
+                   (static_cast<uint32_t>(block[i * 4 + 2]) << 8) |
+                   static_cast<uint32_t>(block[i * 4 + 3]);
+        }
+        for (std::size_t i = 16; i < 64; ++i) {
             uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
             uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
             w[i] = w[i - 16] + s0 + w[i - 7] + s1;
         }
 
-        uint32_t a = h0, b = h1, c = h2, d = h3;
-        uint32_t e = h4, f = h5, g = h6, hh = h7;
+        uint32_t a = state_[0], b = state_[1], c = state_[2], d = state_[3];
+        uint32_t e = state_[4], f = state_[5], g = state_[6], hh = state_[7];
 
-        for (int i = 0; i < 64; ++i) {
+        for (std::size_t i = 0; i < 64; ++i) {
             uint32_t S1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
             uint32_t ch = (e & f) ^ (~e & g);
             uint32_t temp1 = hh + S1 + ch + k[i] + w[i];
@@ -92,32 +134,29 @@ namespace cgs::service::detail {
             a = temp1 + temp2;
         }
 
-        h0 += a;
-        h1 += b;
-        h2 += c;
-        h3 += d;
-        h4 += e;
-        h5 += f;
-        h6 += g;
-        h7 += hh;
+        state_[0] += a;
+        state_[1] += b;
+        state_[2] += c;
+        state_[3] += d;
+        state_[4] += e;
+        state_[5] += f;
+        state_[6] += g;
+        state_[7] += hh;
     }
 
-    std::array<uint8_t, 32> digest{};
-    auto store = [&](int idx, uint32_t val) {
-        digest[static_cast<std::size_t>(idx * 4)] = static_cast<uint8_t>((val >> 24) & 0xFF);
-        digest[static_cast<std::size_t>(idx * 4 + 1)] = static_cast<uint8_t>((val >> 16) & 0xFF);
-        digest[static_cast<std::size_t>(idx * 4 + 2)] = static_cast<uint8_t>((val >> 8) & 0xFF);
-        digest[static_cast<std::size_t>(idx * 4 + 3)] = static_cast<uint8_t>(val & 0xFF);
-    };
-    store(0, h0);
-    store(1, h1);
-    store(2, h2);
-    store(3, h3);
-    store(4, h4);
-    store(5, h5);
-    store(6, h6);
-    store(7, h7);
-    return digest;
+    // Initial hash values (first 32 bits of fractional parts of square roots
+    // of the first 8 primes).
+    std::array<uint32_t, 8> state_{0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                   0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+    std::array<uint8_t, 64> buffer_{};
+    std::size_t buffered_ = 0;
+    uint64_t totalLength_ = 0;
+};
+
+/// Compute SHA-256 digest of the input data.
+/// Returns 32-byte raw digest.
+[[nodiscard]] inline std::array<uint8_t, 32> sha256(const uint8_t* data, std::size_t length) {
+    return Sha256().update(data, length).finish();
 }
 
 /// SHA-256 overload for string_view input.
@@ -129,81 +168,102 @@ namespace cgs::service::detail {
 // HMAC-SHA256 (RFC 2104)
 // =============================================================================
 
-/// Compute HMAC-SHA256(key, message).
-/// Returns 32-byte raw MAC.
-[[nodiscard]] inline std::array<uint8_t, 32> hmacSha256(std::string_view key,
-                                                        std::string_view message) {
-    constexpr std::size_t blockSize = 64;
-
-    // If key is longer than block size, hash it first.
-    std::array<uint8_t, 32> keyHash{};
-    const uint8_t* keyPtr = nullptr;
-    std::size_t keyLen = 0;
-
-    if (key.size() > blockSize) {
-        keyHash = sha256(key);
-        keyPtr = keyHash.data();
-        keyLen = keyHash.size();
-    } else {
-        keyPtr = reinterpret_cast<const uint8_t*>(key.data());
-        keyLen = key.size();
-    }
+/// HMAC-SHA256 key schedule: the hash states after the inner and outer
+/// padded key blocks, computed once per key.  mac() then only hashes the
+/// message and the inner digest.
+class HmacSha256Key {
+public:
+    explicit HmacSha256Key(std::string_view key) {
+        constexpr std::size_t blockSize = 64;
+
+        // If key is longer than block size, hash it first.
+        std::array<uint8_t, blockSize> paddedKey{};
+        if (key.size() > blockSize) {
+            auto keyHash = sha256(key);
+            std::memcpy(paddedKey.data(), keyHash.data(), keyHash.size());
+        } else if (!key.empty()) {
+            std::memcpy(paddedKey.data(), key.data(), key.size());
+        }
 
-    // Zero-pad the key to block size.
-    std::array<uint8_t, blockSize> paddedKey{};
-    std::memcpy(paddedKey.data(), keyPtr, keyLen);
+        std::array<uint8_t, blockSize> pad{};
+        for (std::size_t i = 0; i < blockSize; ++i) {
+            pad[i] = paddedKey[i] ^ 0x36;
+        }
+        inner_.update(pad.data(), pad.size());
+        for (std::size_t i = 0; i < blockSize; ++i) {
+            pad[i] = paddedKey[i] ^ 0x5C;
+        }
+        outer_.update(pad.data(), pad.size());
+    }
 
-    // Inner and outer padded keys.
-    std::array<uint8_t, blockSize> ipad{};
-    std::array<uint8_t, blockSize> opad{};
-    for (std::size_t i = 0; i < blockSize; ++i) {
-        ipad[i] = paddedKey[i] ^ 0x36;
-        opad[i] = paddedKey[i] ^ 0x5C;
+    /// HMAC-SHA256(key, message) as a 32-byte raw MAC.
+    [[nodiscard]] std::array<uint8_t, 32> mac(std::string_view message) const {
+        auto innerHash = Sha256(inner_).update(message).finish();
+        return Sha256(outer_).update(innerHash.data(), innerHash.size()).finish();
     }
 
-    // Inner hash: SHA-256(ipad || message)
-    std::vector<uint8_t> innerMsg(ipad.begin(), ipad.end());
-    innerMsg.insert(innerMsg.end(),
-                    reinterpret_cast<const uint8_t*>(message.data()),
-                    reinterpret_cast<const uint8_t*>(message.data()) + message.size());
-    auto innerHash = sha256(innerMsg.data(), innerMsg.size());
-
-    // Outer hash: SHA-256(opad || innerHash)
-    std::vector<uint8_t> outerMsg(opad.begin(), opad.end());
-    outerMsg.insert(outerMsg.end(), innerHash.begin(), innerHash.end());
-    return sha256(outerMsg.data(), outerMsg.size());
+private:
+    Sha256 inner_;
+    Sha256 outer_;
+};
+
+/// Compute HMAC-SHA256(key, message).
+/// Returns 32-byte raw MAC.
+[[nodiscard]] inline std::array<uint8_t, 32> hmacSha256(std::string_view key,
+                                                        std::string_view message) {
+    return HmacSha256Key(key).mac(message);
 }
 
 // =============================================================================
 // Base64URL encoding/decoding (RFC 4648 §5)
 // =============================================================================
 
-/// Encode bytes to base64url (no padding).
-[[nodiscard]] inline std::string base64urlEncode(const uint8_t* data, std::size_t length) {
+/// Length of the base64url encoding (no padding) of @p length bytes.
+[[nodiscard]] constexpr std::size_t base64urlEncodedSize(std::size_t length) {
+    return (length * 4 + 2) / 3;
+}
+
+/// Write the base64url encoding (no padding) of @p data to @p out, which
+/// holds base64urlEncodedSize(length) characters.  Returns the end of the
+/// written characters.
+inline char* base64urlEncodeTo(char* out, const uint8_t* data, std::size_t length) {
     static constexpr char table[] =
         "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
 
-    std::string result;
-    result.reserve((length * 4 + 2) / 3);
-
-    for (std::size_t i = 0; i < length; i += 3) {
+    std::size_t i = 0;
+    for (; i + 3 <= length; i += 3) {
+        const uint32_t n = (static_cast<uint32_t>(data[i]) << 16) |
+                           (static_cast<uint32_t>(data[i + 1]) << 8) | data[i + 2];
+        *out++ = table[(n >> 18) & 0x3F];
+        *out++ = table[(n >> 12) & 0x3F];
+        *out++ = table[(n >> 6) & 0x3F];
+        *out++ = table[n & 0x3F];
+    }
+    if (i < length) {
         uint32_t n = static_cast<uint32_t>(data[i]) << 16;
         if (i + 1 < length) {
             n |= static_cast<uint32_t>(data[i + 1]) << 8;
         }
-        if (i + 2 < length) {
-            n |= static_cast<uint32_t>(data[i + 2]);
-        }
-
-        result.push_back(table[(n >> 18) & 0x3F]);
-        result.push_back(table[(n >> 12) & 0x3F]);
+        *out++ = table[(n >> 18) & 0x3F];
+        *out++ = table[(n >> 12) & 0x3F];
         if (i + 1 < length) {
-            result.push_back(table[(n >> 6) & 0x3F]);
-        }
-        if (i + 2 < length) {
-            result.push_back(table[n & 0x3F]);
+            *out++ = table[(n >> 6) & 0x3F];
         }
     }
+    return out;
+}
+
+/// Append the base64url encoding (no padding) of @p data to @p out.
+inline void base64urlEncodeTo(std::string& out, const uint8_t* data, std::size_t length) {
+    const std::size_t start = out.size();
+    out.resize(start + base64urlEncodedSize(length));
+    base64urlEncodeTo(out.data() + start, data, length);
+}
+
+/// Encode bytes to base64url (no padding).
+[[nodiscard]] inline std::string base64urlEncode(const uint8_t* data, std::size_t length) {
+    std::string result;
+    base64urlEncodeTo(result, data, length);
     return result;
 }
 
@@ -212,47 +272,78 @@ namespace cgs::service::detail {
     return base64urlEncode(reinterpret_cast<const uint8_t*>(input.data()), input.size());
 }
 
-/// Decode base64url to bytes. Returns empty vector on invalid input.
-[[nodiscard]] inline std::vector<uint8_t> base64urlDecode(std::string_view input) {
-    auto decodeChar = [](char c) -> int {
-        if (c >= 'A' && c <= 'Z') {
-            return c - 'A';
-        }
-        if (c >= 'a' && c <= 'z') {
-            return c - 'a' + 26;
-        }
-        if (c >= '0' && c <= '9') {
-            return c - '0' + 52;
-        }
-        if (c == '-') {
-            return 62;
+/// Upper bound of the decoded size of @p encodedLength base64url characters.
+[[nodiscard]] constexpr std::size_t base64urlDecodedSize(std::size_t encodedLength) {
+    return encodedLength * 3 / 4;
+}
+
+/// Decode base64url into @p out, which holds base64urlDecodedSize(input.size())
+/// bytes.  Decoding stops at the first '='.  Returns the decoded size, or
+/// std::nullopt on an invalid character.
+[[nodiscard]] inline std::optional<std::size_t> base64urlDecodeTo(std::string_view input,
+                                                                  uint8_t* out) {
+    // Sextet per character; 0xFF marks characters outside the alphabet.
+    static constexpr auto table = [] {
+        std::array<uint8_t, 256> t{};
+        t.fill(0xFF);
+        for (uint8_t i = 0; i < 26; ++i) {
+            t[static_cast<uint8_t>('A' + i)] = i;
+            t[static_cast<uint8_t>('a' + i)] = static_cast<uint8_t>(26 + i);
         }
-        if (c == '_') {
-            return 63;
+        for (uint8_t i = 0; i < 10; ++i) {
+            t[static_cast<uint8_t>('0' + i)] = static_cast<uint8_t>(52 + i);
         }
-        return -1;
-    };
+        t[static_cast<uint8_t>('-')] = 62;
+        t[static_cast<uint8_t>('_')] = 63;
+        return t;
+    }();
 
-    std::vector<uint8_t> result;
-    result.reserve((input.size() * 3) / 4);
+    if (auto pad = input.find('='); pad != std::string_view::npos) {
+        input = input.substr(0, pad);
+    }
+    const auto* in = reinterpret_cast<const uint8_t*>(input.data());
+    uint8_t* p = out;
+
+    // Four characters to three bytes; an invalid character sets the top
+    // bits of the OR of the sextets, checked once per group.
+    std::size_t i = 0;
+    for (; i + 4 <= input.size(); i += 4) {
+        const uint32_t a = table[in[i]], b = table[in[i + 1]];
+        const uint32_t c = table[in[i + 2]], d = table[in[i + 3]];
+        if (((a | b | c | d) & 0xC0) != 0) {
+            return std::nullopt;
+        }
+        const uint32_t n = (a << 18) | (b << 12) | (c << 6) | d;
+        *p++ = static_cast<uint8_t>(n >> 16);
+        *p++ = static_cast<uint8_t>(n >> 8);
+        *p++ = static_cast<uint8_t>(n);
+    }
 
     uint32_t buf = 0;
     int bits = 0;
-    for (char c : input) {
-        if (c == '=') {
-            break;
+    for (; i < input.size(); ++i) {
+        const uint32_t v = table[in[i]];
+        if (v > 63) {
+            return std::nullopt;
         }
-        int val = decodeChar(c);
-        if (val < 0) {
-            return {};
-        }
-        buf = (buf << 6) | static_cast<uint32_t>(val);
+        buf = (buf << 6) | v;
         bits += 6;
         if (bits >= 8) {
             bits -= 8;
-            result.push_back(static_cast<uint8_t>((buf >> bits) & 0xFF));
+            *p++ = static_cast<uint8_t>((buf >> bits) & 0xFF);
         }
     }
+    return static_cast<std::size_t>(p - out);
+}
+
+/// Decode base64url to bytes. Returns empty vector on invalid input.
+[[nodiscard]] inline std::vector<uint8_t> base64urlDecode(std::string_view input) {
+    std::vector<uint8_t> result(base64urlDecodedSize(input.size()));
+    auto size = base64urlDecodeTo(input, result.data());
+    if (!size) {
+        return {};
+    }
+    result.resize(*size);
     return result;
 }
 
@@ -1,8 +1,5 @@
 /// @file password_hasher.cpp
-/// @brief PasswordHasher implementation using SHA-256 + random salt.
-///
-/// Production deployments should replace this with bcrypt (cost >= 12)
-/// or argon2id via a foundation CryptoAdapter.
+/// @brief PasswordHasher implementation using scrypt or SHA-256 + random salt.
 ///
 /// @see SRS-SVC-001.6
 
@@ -10,16 +7,22 @@
 
 #include "crypto_utils.hpp"
 
+#include <openssl/evp.h>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+
 namespace cgs::service {
 
-HashedPassword PasswordHasher::hash(std::string_view password) const {
-    auto salt = generateSalt();
-    auto digest = hashWithSalt(password, salt);
-    return {std::move(digest), std::move(salt)};
-}
+namespace {
 
-std::string PasswordHasher::hashWithSalt(std::string_view password, std::string_view salt) const {
-    // SHA-256(salt + password)
+constexpr std::string_view kScryptPrefix = "scrypt$";
+constexpr uint64_t kScryptR = 8;
+constexpr uint64_t kScryptP = 1;
+
+// SHA-256(salt + password), hex-encoded.
+std::string sha256Hash(std::string_view password, std::string_view salt) {
     std::string combined;
     combined.reserve(salt.size() + password.size());
     combined.append(salt);
@@ -28,11 +31,66 @@ std::string PasswordHasher::hashWithSalt(std::string_view password, std::string_
     return detail::toHex(digest);
 }
 
+// "scrypt$<cost>$<hex>", or empty if OpenSSL rejects the parameters.
+std::string scryptHash(std::string_view password, std::string_view salt, uint32_t cost) {
+    const uint64_t n = uint64_t{1} << cost;
+    // scrypt needs 128 * r * (N + p) bytes; leave room for bookkeeping.
+    const uint64_t maxMemory = 128 * kScryptR * (n + kScryptP) + (uint64_t{1} << 20);
+
+    std::array<uint8_t, 32> key{};
+    if (EVP_PBE_scrypt(password.data(),
+                       password.size(),
+                       reinterpret_cast<const unsigned char*>(salt.data()),
+                       salt.size(),
+                       n,
+                       kScryptR,
+                       kScryptP,
+                       maxMemory,
+                       key.data(),
+                       key.size()) != 1) {
+        return {};
+    }
+    std::string result(kScryptPrefix);
+    result += std::to_string(cost);
+    result += '$';
+    result += detail::toHex(key);
+    return result;
+}
+
+}  // anonymous namespace
+
+PasswordHasher::PasswordHasher(uint32_t cost) : cost_(std::min(cost, kMaxCost)) {}
+
+HashedPassword PasswordHasher::hash(std::string_view password) const {
+    auto salt = generateSalt();
+    auto digest = hashWithSalt(password, salt);
+    return {std::move(digest), std::move(salt)};
+}
+
+std::string PasswordHasher::hashWithSalt(std::string_view password, std::string_view salt) const {
+    if (cost_ == 0) {
+        return sha256Hash(password, salt);
+    }
+    return scryptHash(password, salt, cost_);
+}
+
 bool PasswordHasher::verify(std::string_view password,
                             std::string_view storedHash,
                             std::string_view salt) const {
-    auto computed = hashWithSalt(password, salt);
-    return detail::constantTimeEqual(computed, storedHash);
+    if (!storedHash.starts_with(kScryptPrefix)) {
+        return detail::constantTimeEqual(sha256Hash(password, salt), storedHash);
+    }
+
+    // Recompute at the cost recorded in the hash.
+    const std::string_view params = storedHash.substr(kScryptPrefix.size());
+    uint32_t cost = 0;
+    const auto [end, ec] = std::from_chars(params.data(), params.data() + params.size(), cost);
+    if (ec != std::errc() || cost == 0 || cost > kMaxCost || end == params.data() + params.size() ||
+        *end != '$') {
+        return false;
+    }
+    const std::string computed = scryptHash(password, salt, cost);
+    return !computed.empty() && detail::constantTimeEqual(computed, storedHash);
 }
 
 std::string PasswordHasher::generateSalt() {
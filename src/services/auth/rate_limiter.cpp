@@ -1,49 +1,285 @@
 /// @file rate_limiter.cpp
-/// @brief Sliding-window RateLimiter implementation.
+/// @brief GCRA RateLimiter implementation.
 
 #include "cgs/service/rate_limiter.hpp"
 
+#include <algorithm>
+#include <optional>
+
 namespace cgs::service {
 
-RateLimiter::RateLimiter(uint32_t maxAttempts, std::chrono::seconds window)
-    : maxAttempts_(maxAttempts), window_(window) {}
+namespace {
+
+int hexDigit(char c) noexcept {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+// Dotted-quad IPv4 address.
+std::optional<uint32_t> parseIpv4(std::string_view text) noexcept {
+    uint32_t address = 0;
+    int octets = 0;
+    std::size_t i = 0;
+    while (octets < 4) {
+        uint32_t value = 0;
+        std::size_t digits = 0;
+        while (i < text.size() && text[i] >= '0' && text[i] <= '9' && digits < 3) {
+            value = value * 10 + static_cast<uint32_t>(text[i] - '0');
+            ++i;
+            ++digits;
+        }
+        if (digits == 0 || value > 255) {
+            return std::nullopt;
+        }
+        address = (address << 8) | value;
+        if (++octets < 4) {
+            if (i >= text.size() || text[i] != '.') {
+                return std::nullopt;
+            }
+            ++i;
+        }
+    }
+    if (i != text.size()) {
+        return std::nullopt;
+    }
+    return address;
+}
+
+// IPv6 address, with "::" compression and an optional trailing IPv4 part.
+std::optional<std::array<uint16_t, 8>> parseIpv6(std::string_view text) noexcept {
+    std::array<uint16_t, 8> groups{};
+    std::size_t count = 0;
+    std::optional<std::size_t> gap;  // group index of "::"
+
+    std::size_t i = 0;
+    if (text.substr(0, 2) == "::") {
+        gap = 0;
+        i = 2;
+    }
+    while (i < text.size()) {
+        // Trailing dotted IPv4 fills two groups.
+        const std::size_t end = text.find(':', i);
+        const std::string_view part = text.substr(i, end == std::string_view::npos ? end : end - i);
+        if (end == std::string_view::npos && part.find('.') != std::string_view::npos) {
+            auto v4 = parseIpv4(part);
+            if (!v4 || count > 6) {
+                return std::nullopt;
+            }
+            groups[count++] = static_cast<uint16_t>(*v4 >> 16);
+            groups[count++] = static_cast<uint16_t>(*v4 & 0xFFFF);
+            i = text.size();
+            break;
+        }
+
+        if (part.empty() || part.size() > 4 || count == 8) {
+            return std::nullopt;
+        }
+        uint32_t value = 0;
+        for (char c : part) {
+            const int digit = hexDigit(c);
+            if (digit < 0) {
+                return std::nullopt;
+            }
+            value = (value << 4) | static_cast<uint32_t>(digit);
+        }
+        groups[count++] = static_cast<uint16_t>(value);
+
+        if (end == std::string_view::npos) {
+            i = text.size();
+        } else if (text.substr(end, 2) == "::") {
+            if (gap) {
+                return std::nullopt;
+            }
+            gap = count;
+            i = end + 2;
+        } else {
+            i = end + 1;
+            if (i == text.size()) {
+                return std::nullopt;  // trailing single ':'
+            }
+        }
+    }
+
+    if (gap) {
+        if (count == 8) {
+            return std::nullopt;
+        }
+        // Shift the groups after "::" to the end, zero-filling the gap.
+        const std::size_t tail = count - *gap;
+        std::copy_backward(groups.begin() + static_cast<std::ptrdiff_t>(*gap),
+                           groups.begin() + static_cast<std::ptrdiff_t>(count),
+                           groups.end());
+        std::fill(groups.begin() + static_cast<std::ptrdiff_t>(*gap),
+                  groups.end() - static_cast<std::ptrdiff_t>(tail),
+                  uint16_t{0});
+    } else if (count != 8) {
+        return std::nullopt;
+    }
+    return groups;
+}
+
+uint64_t mix(uint64_t x) noexcept {
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+}  // anonymous namespace
+
+// -- RateLimitKey -------------------------------------------------------------
+
+RateLimitKey RateLimitKey::from(std::string_view key) noexcept {
+    if (auto v4 = parseIpv4(key)) {
+        return {0, 0x0000FFFF00000000ULL | *v4};
+    }
+    if (key.find(':') != std::string_view::npos) {
+        if (auto v6 = parseIpv6(key)) {
+            RateLimitKey result;
+            for (std::size_t g = 0; g < 4; ++g) {
+                result.high = (result.high << 16) | (*v6)[g];
+                result.low = (result.low << 16) | (*v6)[g + 4];
+            }
+            return result;
+        }
+    }
+
+    // Not an address: two independent 64-bit FNV-1a hashes.
+    uint64_t a = 0xCBF29CE484222325ULL;
+    uint64_t b = 0x84222325CBF29CE4ULL;
+    for (char c : key) {
+        a = (a ^ static_cast<uint8_t>(c)) * 0x100000001B3ULL;
+        b = (b ^ static_cast<uint8_t>(c)) * 0x100000001B3ULL;
+    }
+    return {mix(a), mix(b ^ a)};
+}
+
+// -- RateLimiter --------------------------------------------------------------
+
+RateLimiter::RateLimiter(uint32_t maxAttempts, std::chrono::seconds window, std::size_t maxKeys)
+    : maxAttempts_(maxAttempts),
+      windowTicks_(std::chrono::duration_cast<Clock::duration>(window).count()),
+      interval_(std::max<Rep>(1, windowTicks_ / std::max<Rep>(1, static_cast<Rep>(maxAttempts)))),
+      shardCapacity_(std::max<std::size_t>(1, (maxKeys + kShards - 1) / kShards)) {}
 
 bool RateLimiter::allow(const std::string& key) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto& timestamps = attempts_[key];
-    purgeExpired(timestamps);
+    return allow(RateLimitKey::from(key));
+}
 
-    if (timestamps.size() >= static_cast<std::size_t>(maxAttempts_)) {
+bool RateLimiter::allow(RateLimitKey key) {
+    if (maxAttempts_ == 0) {
         return false;
     }
+    const Rep now = Clock::now().time_since_epoch().count();
 
-    timestamps.push_back(std::chrono::steady_clock::now());
+    Shard& shard = shardFor(key);
+    std::lock_guard lock(shard.mutex);
+
+    uint32_t slot = kNone;
+    auto it = shard.index.find(key);
+    if (it != shard.index.end()) {
+        slot = it->second;
+        unlink(shard, slot);
+    } else if (shard.index.size() < shardCapacity_) {
+        slot = static_cast<uint32_t>(shard.slots.size());
+        shard.slots.emplace_back();
+        shard.index.emplace(key, slot);
+    } else {
+        // Full: recycle the least recently used key's slot.
+        slot = shard.tail;
+        unlink(shard, slot);
+        shard.index.erase(shard.slots[slot].key);
+        shard.index.emplace(key, slot);
+        shard.slots[slot].fullAt = 0;
+    }
+    Slot& entry = shard.slots[slot];
+    entry.key = key;
+    pushFront(shard, slot);
+
+    // Admit while the budget, once this attempt is charged, reaches at
+    // most one window into the future.
+    const Rep charged = std::max(entry.fullAt, now) + interval_;
+    if (charged - now > windowTicks_) {
+        return false;
+    }
+    entry.fullAt = charged;
     return true;
 }
 
 uint32_t RateLimiter::remaining(const std::string& key) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = attempts_.find(key);
-    if (it == attempts_.end()) {
+    if (maxAttempts_ == 0) {
+        return 0;
+    }
+    const RateLimitKey k = RateLimitKey::from(key);
+    const Rep now = Clock::now().time_since_epoch().count();
+
+    Shard& shard = shardFor(k);
+    std::lock_guard lock(shard.mutex);
+    auto it = shard.index.find(k);
+    if (it == shard.index.end()) {
         return maxAttempts_;
     }
+    const Rep used = std::max<Rep>(shard.slots[it->second].fullAt - now, 0);
+    const Rep left = (windowTicks_ - used) / interval_;
+    return static_cast<uint32_t>(std::clamp<Rep>(left, 0, static_cast<Rep>(maxAttempts_)));
+}
+
+void RateLimiter::reset(const std::string& key) {
+    const RateLimitKey k = RateLimitKey::from(key);
+    Shard& shard = shardFor(k);
+    std::lock_guard lock(shard.mutex);
+    auto it = shard.index.find(k);
+    if (it != shard.index.end()) {
+        shard.slots[it->second].fullAt = 0;
+    }
+}
 
-    auto timestamps = it->second;  // copy to purge
-    purgeExpired(timestamps);
+std::size_t RateLimiter::trackedKeys() const {
+    std::size_t total = 0;
+    for (auto& shard : shards_) {
+        std::lock_guard lock(shard.mutex);
+        total += shard.index.size();
+    }
+    return total;
+}
 
-    auto used = static_cast<uint32_t>(timestamps.size());
-    return (used >= maxAttempts_) ? 0u : (maxAttempts_ - used);
+RateLimiter::Shard& RateLimiter::shardFor(const RateLimitKey& key) const {
+    return shards_[RateLimitKeyHash{}(key) & (kShards - 1)];
 }
 
-void RateLimiter::reset(const std::string& key) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    attempts_.erase(key);
+void RateLimiter::unlink(Shard& shard, uint32_t slot) {
+    Slot& entry = shard.slots[slot];
+    if (entry.prev != kNone) {
+        shard.slots[entry.prev].next = entry.next;
+    } else {
+        shard.head = entry.next;
+    }
+    if (entry.next != kNone) {
+        shard.slots[entry.next].prev = entry.prev;
+    } else {
+        shard.tail = entry.prev;
+    }
+    entry.prev = kNone;
+    entry.next = kNone;
 }
 
-void RateLimiter::purgeExpired(std::deque<TimePoint>& timestamps) const {
-    auto cutoff = std::chrono::steady_clock::now() - window_;
-    while (!timestamps.empty() && timestamps.front() < cutoff) {
-        timestamps.pop_front();
+void RateLimiter::pushFront(Shard& shard, uint32_t slot) {
+    Slot& entry = shard.slots[slot];
+    entry.prev = kNone;
+    entry.next = shard.head;
+    if (shard.head != kNone) {
+        shard.slots[shard.head].prev = slot;
+    }
+    shard.head = slot;
+    if (shard.tail == kNone) {
+        shard.tail = slot;
     }
 }
 
@@ -4,11 +4,15 @@
 /// @brief RSA-SHA256 signing and verification using OpenSSL 3.x EVP API.
 ///
 /// Internal header for the auth service. Uses BIO_new_mem_buf for PEM key
-/// loading from strings (no file I/O) to support testability.
+/// loading from strings (no file I/O) to support testability.  Callers on
+/// a hot path parse a key once with loadPrivateKey()/loadPublicKey() and
+/// pass the EVP_PKEY to every call.
 ///
 /// @see SRS-NFR-014
 
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <openssl/bio.h>
 #include <openssl/err.h>
 #include <openssl/evp.h>
@@ -19,21 +23,40 @@
 
 namespace cgs::service::detail {
 
-/// Sign a message with RSA-SHA256 using a PEM-encoded private key.
-///
-/// @param privateKeyPem PEM-encoded RSA private key string.
-/// @param message       The data to sign.
-/// @return Raw signature bytes, or empty vector on failure.
-[[nodiscard]] inline std::vector<uint8_t> rsaSha256Sign(std::string_view privateKeyPem,
-                                                        std::string_view message) {
-    // Load private key from PEM string via BIO.
+/// Owning EVP_PKEY handle.
+struct PkeyDeleter {
+    void operator()(EVP_PKEY* pkey) const noexcept { EVP_PKEY_free(pkey); }
+};
+using PkeyPtr = std::unique_ptr<EVP_PKEY, PkeyDeleter>;
+
+/// Parse a PEM-encoded private key.  Returns null on failure.
+[[nodiscard]] inline PkeyPtr loadPrivateKey(std::string_view privateKeyPem) {
     auto* bio = BIO_new_mem_buf(privateKeyPem.data(), static_cast<int>(privateKeyPem.size()));
     if (!bio) {
-        return {};
+        return nullptr;
     }
+    PkeyPtr pkey(PEM_read_bio_PrivateKey(bio, nullptr, nullptr, nullptr));
+    BIO_free(bio);
+    return pkey;
+}
 
-    auto* pkey = PEM_read_bio_PrivateKey(bio, nullptr, nullptr, nullptr);
+/// Parse a PEM-encoded public key.  Returns null on failure.
+[[nodiscard]] inline PkeyPtr loadPublicKey(std::string_view publicKeyPem) {
+    auto* bio = BIO_new_mem_buf(publicKeyPem.data(), static_cast<int>(publicKeyPem.size()));
+    if (!bio) {
+        return nullptr;
+    }
+    PkeyPtr pkey(PEM_read_bio_PUBKEY(bio, nullptr, nullptr, nullptr));
     BIO_free(bio);
+    return pkey;
+}
+
+/// Sign a message with RSA-SHA256 using a parsed private key.
+///
+/// @p pkey is only read, so one key may sign on several threads at once.
+///
+/// @return Raw signature bytes, or empty vector on failure.
+[[nodiscard]] inline std::vector<uint8_t> rsaSha256Sign(EVP_PKEY* pkey, std::string_view message) {
     if (!pkey) {
         return {};
     }
@@ -41,63 +64,50 @@ namespace cgs::service::detail {
     // Create signing context.
     auto* mdCtx = EVP_MD_CTX_new();
     if (!mdCtx) {
-        EVP_PKEY_free(pkey);
         return {};
     }
 
     std::vector<uint8_t> signature;
-
-    if (EVP_DigestSignInit(mdCtx, nullptr, EVP_sha256(), nullptr, pkey) != 1) {
-        EVP_MD_CTX_free(mdCtx);
-        EVP_PKEY_free(pkey);
-        return {};
-    }
-
-    if (EVP_DigestSignUpdate(
-            mdCtx, reinterpret_cast<const unsigned char*>(message.data()), message.size()) != 1) {
-        EVP_MD_CTX_free(mdCtx);
-        EVP_PKEY_free(pkey);
-        return {};
-    }
-
-    // Determine signature length.
     std::size_t sigLen = 0;
-    if (EVP_DigestSignFinal(mdCtx, nullptr, &sigLen) != 1) {
+    if (EVP_DigestSignInit(mdCtx, nullptr, EVP_sha256(), nullptr, pkey) != 1 ||
+        EVP_DigestSignUpdate(
+            mdCtx, reinterpret_cast<const unsigned char*>(message.data()), message.size()) != 1 ||
+        EVP_DigestSignFinal(mdCtx, nullptr, &sigLen) != 1) {
         EVP_MD_CTX_free(mdCtx);
-        EVP_PKEY_free(pkey);
         return {};
     }
 
     signature.resize(sigLen);
     if (EVP_DigestSignFinal(mdCtx, signature.data(), &sigLen) != 1) {
         EVP_MD_CTX_free(mdCtx);
-        EVP_PKEY_free(pkey);
         return {};
     }
 
     signature.resize(sigLen);
     EVP_MD_CTX_free(mdCtx);
-    EVP_PKEY_free(pkey);
     return signature;
 }
 
-/// Verify an RSA-SHA256 signature using a PEM-encoded public key.
+/// Sign a message with RSA-SHA256 using a PEM-encoded private key.
+///
+/// @param privateKeyPem PEM-encoded RSA private key string.
+/// @param message       The data to sign.
+/// @return Raw signature bytes, or empty vector on failure.
+[[nodiscard]] inline std::vector<uint8_t> rsaSha256Sign(std::string_view privateKeyPem,
+                                                        std::string_view message) {
+    auto pkey = loadPrivateKey(privateKeyPem);
+    return rsaSha256Sign(pkey.get(), message);
+}
+
+/// Verify an RSA-SHA256 signature using a parsed public key.
+///
+/// @p pkey is only read, so one key may verify on several threads at once.
 ///
-/// @param publicKeyPem PEM-encoded RSA public key string.
-/// @param message      The original signed data.
-/// @param signature    The signature bytes to verify.
 /// @return True if the signature is valid.
-[[nodiscard]] inline bool rsaSha256Verify(std::string_view publicKeyPem,
+[[nodiscard]] inline bool rsaSha256Verify(EVP_PKEY* pkey,
                                           std::string_view message,
-                                          const std::vector<uint8_t>& signature) {
-    // Load public key from PEM string via BIO.
-    auto* bio = BIO_new_mem_buf(publicKeyPem.data(), static_cast<int>(publicKeyPem.size()));
-    if (!bio) {
-        return false;
-    }
-
-    auto* pkey = PEM_read_bio_PUBKEY(bio, nullptr, nullptr, nullptr);
-    BIO_free(bio);
+                                          const uint8_t* signature,
+                                          std::size_t signatureLength) {
     if (!pkey) {
         return false;
     }
@@ -105,28 +115,33 @@ namespace cgs::service::detail {
     // Create verification context.
     auto* mdCtx = EVP_MD_CTX_new();
     if (!mdCtx) {
-        EVP_PKEY_free(pkey);
-        return false;
-    }
-
-    if (EVP_DigestVerifyInit(mdCtx, nullptr, EVP_sha256(), nullptr, pkey) != 1) {
-        EVP_MD_CTX_free(mdCtx);
-        EVP_PKEY_free(pkey);
         return false;
     }
 
-    if (EVP_DigestVerifyUpdate(
+    if (EVP_DigestVerifyInit(mdCtx, nullptr, EVP_sha256(), nullptr, pkey) != 1 ||
+        EVP_DigestVerifyUpdate(
             mdCtx, reinterpret_cast<const unsigned char*>(message.data()), message.size()) != 1) {
         EVP_MD_CTX_free(mdCtx);
-        EVP_PKEY_free(pkey);
         return false;
     }
 
-    int result = EVP_DigestVerifyFinal(mdCtx, signature.data(), signature.size());
+    int result = EVP_DigestVerifyFinal(mdCtx, signature, signatureLength);
 
     EVP_MD_CTX_free(mdCtx);
-    EVP_PKEY_free(pkey);
     return result == 1;
 }
 
+/// Verify an RSA-SHA256 signature using a PEM-encoded public key.
+///
+/// @param publicKeyPem PEM-encoded RSA public key string.
+/// @param message      The original signed data.
+/// @param signature    The signature bytes to verify.
+/// @return True if the signature is valid.
+[[nodiscard]] inline bool rsaSha256Verify(std::string_view publicKeyPem,
+                                          std::string_view message,
+                                          const std::vector<uint8_t>& signature) {
+    auto pkey = loadPublicKey(publicKeyPem);
+    return rsaSha256Verify(pkey.get(), message, signature.data(), signature.size());
+}
+
 }  // namespace cgs::service::detail
@@ -5,49 +5,140 @@
 
 #include "cgs/service/token_blacklist.hpp"
 
+#include <algorithm>
+#include <array>
+#include <bit>
+
 namespace cgs::service {
 
-TokenBlacklist::TokenBlacklist(std::chrono::seconds cleanupInterval)
-    : cleanupInterval_(cleanupInterval), lastCleanup_(std::chrono::system_clock::now()) {}
+using Clock = std::chrono::system_clock;
 
-void TokenBlacklist::revoke(std::string_view jti, std::chrono::system_clock::time_point expiresAt) {
-    std::unique_lock lock(mutex_);
-    entries_.emplace(std::string(jti), expiresAt);
-
-    // Periodic auto-cleanup: remove expired entries when interval has elapsed.
-    auto now = std::chrono::system_clock::now();
-    if (now - lastCleanup_ >= cleanupInterval_) {
-        lastCleanup_ = now;
-        for (auto it = entries_.begin(); it != entries_.end();) {
-            if (it->second <= now) {
-                it = entries_.erase(it);
-            } else {
-                ++it;
-            }
+namespace {
+
+constexpr int kFilterHashes = 4;
+
+uint64_t mix(uint64_t x) noexcept {
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Expiry in whole unix seconds, rounded up: an entry is dropped only
+// once its token has certainly expired.
+int64_t expirySeconds(Clock::time_point expiresAt) {
+    const auto since = expiresAt.time_since_epoch();
+    auto seconds = std::chrono::duration_cast<std::chrono::seconds>(since);
+    if (seconds < since) {
+        ++seconds;
+    }
+    return static_cast<int64_t>(seconds.count());
+}
+
+// Filter size in bits: a power of two, at least one word.
+std::size_t filterSize(std::size_t bits) {
+    return std::bit_ceil(std::max<std::size_t>(bits, 64));
+}
+
+int64_t nowSeconds(Clock::time_point now) {
+    return static_cast<int64_t>(
+        std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count());
+}
+
+void writeU64(uint8_t* out, uint64_t value) {
+    for (int i = 7; i >= 0; --i) {
+        *out++ = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+uint64_t readU64(const uint8_t* in) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) {
+        value = (value << 8) | in[i];
+    }
+    return value;
+}
+
+}  // anonymous namespace
+
+// -- Filter -------------------------------------------------------------------
+
+TokenBlacklist::Filter::Filter(std::size_t bits)
+    : words(std::make_unique<std::atomic<uint64_t>[]>(filterSize(bits) / 64)),
+      mask(static_cast<uint64_t>(filterSize(bits)) - 1) {}
+
+void TokenBlacklist::Filter::add(const Digest& d) noexcept {
+    const uint64_t step = d.low | 1;
+    for (int i = 0; i < kFilterHashes; ++i) {
+        const uint64_t bit = (d.high + static_cast<uint64_t>(i) * step) & mask;
+        words[bit >> 6].fetch_or(uint64_t{1} << (bit & 63));
+    }
+}
+
+bool TokenBlacklist::Filter::mayContain(const Digest& d) const noexcept {
+    const uint64_t step = d.low | 1;
+    for (int i = 0; i < kFilterHashes; ++i) {
+        const uint64_t bit = (d.high + static_cast<uint64_t>(i) * step) & mask;
+        if ((words[bit >> 6].load() & (uint64_t{1} << (bit & 63))) == 0) {
+            return false;
         }
     }
+    return true;
+}
+
+// -- TokenBlacklist -----------------------------------------------------------
+
+TokenBlacklist::TokenBlacklist(std::chrono::seconds cleanupInterval, std::size_t filterBits)
+    : filterBits_(filterBits),
+      filter_(new Filter(filterBits)),
+      cleanupInterval_(cleanupInterval),
+      lastCleanup_(Clock::now()) {}
+
+TokenBlacklist::~TokenBlacklist() {
+    delete filter_.load();
+}
+
+void TokenBlacklist::revoke(std::string_view jti, Clock::time_point expiresAt) {
+    const Digest digest = digestOf(jti);
+    const int64_t expiry = expirySeconds(expiresAt);
+    bool added = false;
+    {
+        std::unique_lock lock(mutex_);
+        added = insertLocked(digest, expiry);
+
+        // Periodic auto-cleanup when the interval has elapsed.
+        auto now = Clock::now();
+        if (now - lastCleanup_ >= cleanupInterval_) {
+            lastCleanup_ = now;
+            cleanupLocked(now);
+        }
+    }
+    onRevoked.emit(jti);
+    if (added) {
+        std::array<uint8_t, kRecordSize> record{};
+        writeU64(record.data(), digest.high);
+        writeU64(record.data() + 8, digest.low);
+        writeU64(record.data() + 16, static_cast<uint64_t>(expiry));
+        onReplicate.emit(record);
+    }
 }
 
 bool TokenBlacklist::isRevoked(std::string_view jti) const {
+    const Digest digest = digestOf(jti);
+    {
+        ReadGuard guard(readers_);
+        if (!filter_.load()->mayContain(digest)) {
+            return false;
+        }
+    }
     std::shared_lock lock(mutex_);
-    return entries_.find(std::string(jti)) != entries_.end();
+    return entries_.find(digest) != entries_.end();
 }
 
 std::size_t TokenBlacklist::cleanup() {
     std::unique_lock lock(mutex_);
-    auto now = std::chrono::system_clock::now();
+    auto now = Clock::now();
     lastCleanup_ = now;
-
-    std::size_t removed = 0;
-    for (auto it = entries_.begin(); it != entries_.end();) {
-        if (it->second <= now) {
-            it = entries_.erase(it);
-            ++removed;
-        } else {
-            ++it;
-        }
-    }
-    return removed;
+    return cleanupLocked(now);
 }
 
 std::size_t TokenBlacklist::size() const {
@@ -55,4 +146,87 @@ std::size_t TokenBlacklist::size() const {
     return entries_.size();
 }
 
+std::vector<uint8_t> TokenBlacklist::exportRecords() const {
+    const int64_t now = nowSeconds(Clock::now());
+    std::shared_lock lock(mutex_);
+    std::vector<uint8_t> records;
+    records.reserve(entries_.size() * kRecordSize);
+    for (const auto& [digest, expiry] : entries_) {
+        if (expiry <= now) {
+            continue;
+        }
+        const std::size_t offset = records.size();
+        records.resize(offset + kRecordSize);
+        writeU64(records.data() + offset, digest.high);
+        writeU64(records.data() + offset + 8, digest.low);
+        writeU64(records.data() + offset + 16, static_cast<uint64_t>(expiry));
+    }
+    return records;
+}
+
+std::size_t TokenBlacklist::merge(std::span<const uint8_t> records) {
+    const int64_t now = nowSeconds(Clock::now());
+    std::size_t added = 0;
+    std::unique_lock lock(mutex_);
+    for (std::size_t offset = 0; offset + kRecordSize <= records.size(); offset += kRecordSize) {
+        const uint8_t* record = records.data() + offset;
+        const auto expiry = static_cast<int64_t>(readU64(record + 16));
+        if (expiry <= now) {
+            continue;
+        }
+        if (insertLocked({readU64(record), readU64(record + 8)}, expiry)) {
+            ++added;
+        }
+    }
+    return added;
+}
+
+TokenBlacklist::Digest TokenBlacklist::digestOf(std::string_view jti) noexcept {
+    // Two FNV-1a lanes, finalized: stable across nodes and processes.
+    uint64_t a = 0xCBF29CE484222325ULL;
+    uint64_t b = 0x6C62272E07BB0142ULL;
+    for (char c : jti) {
+        a = (a ^ static_cast<uint8_t>(c)) * 0x100000001B3ULL;
+        b = (b ^ static_cast<uint8_t>(c)) * 0x100000001B3ULL;
+    }
+    return {mix(a), mix(b + a)};
+}
+
+bool TokenBlacklist::insertLocked(const Digest& digest, int64_t expiry) {
+    // Filter bits first: a reader that finds the entry also passes the filter.
+    filter_.load()->add(digest);
+    if (!entries_.emplace(digest, expiry).second) {
+        return false;
+    }
+    byExpiry_[expiry].push_back(digest);
+    return true;
+}
+
+std::size_t TokenBlacklist::cleanupLocked(Clock::time_point now) {
+    const int64_t cutoff = nowSeconds(now);
+    std::size_t removed = 0;
+    auto end = byExpiry_.upper_bound(cutoff);
+    for (auto it = byExpiry_.begin(); it != end; ++it) {
+        for (const auto& digest : it->second) {
+            removed += entries_.erase(digest);
+        }
+    }
+    byExpiry_.erase(byExpiry_.begin(), end);
+    if (removed == 0) {
+        return 0;
+    }
+
+    // Bloom filters cannot unset bits: publish one rebuilt from survivors.
+    auto next = std::make_unique<Filter>(filterBits_);
+    for (const auto& entry : entries_) {
+        next->add(entry.first);
+    }
+    Filter* old = filter_.exchange(next.release());
+    retired_.emplace_back(old);
+    if (readers_.load() == 0) {
+        retired_.clear();
+    }
+    return removed;
+}
+
 }  // namespace cgs::service
@@ -0,0 +1,80 @@
+/// @file token_cache.cpp
+/// @brief VerifiedTokenCache implementation.
+///
+/// @see SRS-NFR-014
+
+#include "cgs/service/token_cache.hpp"
+
+#include "crypto_utils.hpp"
+
+#include <chrono>
+#include <mutex>
+
+namespace cgs::service {
+
+VerifiedTokenCache::VerifiedTokenCache(std::size_t capacity) : capacity_(capacity) {}
+
+std::optional<TokenClaims> VerifiedTokenCache::find(std::string_view token) const {
+    const Digest digest = detail::sha256(token);
+
+    std::shared_lock lock(mutex_);
+    auto it = entries_.find(digest);
+    if (it == entries_.end() || std::chrono::system_clock::now() > it->second.expiresAt) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+void VerifiedTokenCache::insert(std::string_view token, const TokenClaims& claims) {
+    if (capacity_ == 0) {
+        return;
+    }
+    const Digest digest = detail::sha256(token);
+
+    std::unique_lock lock(mutex_);
+    if (entries_.size() >= capacity_) {
+        purgeExpiredLocked();
+    }
+    while (entries_.size() >= capacity_) {
+        byJti_.erase(entries_.begin()->second.jti);
+        entries_.erase(entries_.begin());
+    }
+    entries_.insert_or_assign(digest, claims);
+    if (!claims.jti.empty()) {
+        byJti_.insert_or_assign(claims.jti, digest);
+    }
+}
+
+void VerifiedTokenCache::invalidate(std::string_view jti) {
+    std::unique_lock lock(mutex_);
+    auto it = byJti_.find(std::string(jti));
+    if (it != byJti_.end()) {
+        entries_.erase(it->second);
+        byJti_.erase(it);
+    }
+}
+
+void VerifiedTokenCache::clear() {
+    std::unique_lock lock(mutex_);
+    entries_.clear();
+    byJti_.clear();
+}
+
+std::size_t VerifiedTokenCache::size() const {
+    std::shared_lock lock(mutex_);
+    return entries_.size();
+}
+
+void VerifiedTokenCache::purgeExpiredLocked() {
+    const auto now = std::chrono::system_clock::now();
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        if (now > it->second.expiresAt) {
+            byJti_.erase(it->second.jti);
+            it = entries_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+}  // namespace cgs::service
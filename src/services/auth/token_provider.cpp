@@ -21,9 +21,12 @@
 #include "crypto_utils.hpp"
 #include "rsa_utils.hpp"
 
+#include <array>
 #include <charconv>
-#include <sstream>
+#include <optional>
+#include <span>
 #include <string>
+#include <vector>
 
 namespace cgs::service {
 
@@ -35,10 +38,10 @@ using cgs::foundation::GameError;
 // ---------------------------------------------------------------------------
 namespace {
 
-/// Escape a string for JSON output.
-std::string jsonEscape(std::string_view s) {
-    std::string out;
-    out.reserve(s.size() + 2);
+using ClaimsResult = cgs::foundation::GameResult<TokenClaims>;
+
+/// Append @p s to @p out as a JSON string.
+void appendJsonString(std::string& out, std::string_view s) {
     out.push_back('"');
     for (char c : s) {
         switch (c) {
@@ -63,7 +66,13 @@ std::string jsonEscape(std::string_view s) {
         }
     }
     out.push_back('"');
-    return out;
+}
+
+/// Append @p value to @p out in decimal.
+void appendInt(std::string& out, int64_t value) {
+    char buf[24];
+    auto [end, ec] = std::to_chars(buf, buf + sizeof(buf), value);
+    out.append(buf, end);
 }
 
 /// Convert time_point to seconds since epoch.
@@ -76,90 +85,291 @@ std::chrono::system_clock::time_point fromEpoch(int64_t epoch) {
     return std::chrono::system_clock::time_point(std::chrono::seconds(epoch));
 }
 
-/// Split a string by delimiter, returning up to maxParts parts.
-std::vector<std::string> split(std::string_view s, char delim, std::size_t maxParts = 0) {
-    std::vector<std::string> parts;
-    std::size_t start = 0;
-    while (start < s.size()) {
-        if (maxParts > 0 && parts.size() + 1 >= maxParts) {
-            parts.emplace_back(s.substr(start));
-            return parts;
+/// Single-pass reader over a flat JSON object, as found in JWT headers
+/// and payloads.  Strings without escapes are read as views of the input.
+class JsonReader {
+public:
+    explicit JsonReader(std::string_view json) : json_(json) {}
+
+    /// Call @p onMember(key) for each member; it reads the value with
+    /// readString()/readInt()/readStringArray() or returns false to have
+    /// it skipped.  Returns false if the object is malformed.
+    template <typename OnMember>
+    bool forEachMember(OnMember&& onMember) {
+        if (!consume('{')) {
+            return false;
         }
-        auto pos = s.find(delim, start);
-        if (pos == std::string_view::npos) {
-            parts.emplace_back(s.substr(start));
-            break;
+        if (consume('}')) {
+            return atEnd();
         }
-        parts.emplace_back(s.substr(start, pos - start));
-        start = pos + 1;
+        do {
+            std::string_view key;
+            if (!readView(key) || !consume(':')) {
+                return false;
+            }
+            if (!onMember(key) && (failed_ || !skipValue())) {
+                return false;
+            }
+        } while (consume(','));
+        return consume('}') && atEnd();
     }
-    return parts;
-}
 
-/// Extract a JSON string value by key (simple parser for flat objects).
-std::string extractJsonString(std::string_view json, std::string_view key) {
-    std::string needle = "\"" + std::string(key) + "\":\"";
-    auto pos = json.find(needle);
-    if (pos == std::string_view::npos) {
-        return {};
+    /// Read a string value into @p out.
+    bool readString(std::string& out) {
+        skipSpace();
+        if (pos_ >= json_.size() || json_[pos_] != '"') {
+            return fail();
+        }
+        auto end = json_.find_first_of("\"\\", pos_ + 1);
+        if (end == std::string_view::npos) {
+            return fail();
+        }
+        if (json_[end] == '"') {
+            out.assign(json_.substr(pos_ + 1, end - pos_ - 1));
+            pos_ = end + 1;
+            return true;
+        }
+        return readEscaped(out);
     }
-    pos += needle.size();
-    auto end = json.find('"', pos);
-    if (end == std::string_view::npos) {
-        return {};
+
+    /// Read an integer value into @p out.
+    bool readInt(int64_t& out) {
+        skipSpace();
+        auto [ptr, ec] = std::from_chars(json_.data() + pos_, json_.data() + json_.size(), out);
+        if (ec != std::errc{}) {
+            return fail();
+        }
+        pos_ = static_cast<std::size_t>(ptr - json_.data());
+        return true;
+    }
+
+    /// Read an array of strings into @p out.
+    bool readStringArray(std::vector<std::string>& out) {
+        out.clear();
+        if (!consume('[')) {
+            return fail();
+        }
+        if (consume(']')) {
+            return true;
+        }
+        do {
+            if (!readString(out.emplace_back())) {
+                return false;
+            }
+        } while (consume(','));
+        return consume(']') || fail();
     }
-    return std::string(json.substr(pos, end - pos));
-}
 
-/// Extract a JSON integer value by key.
-int64_t extractJsonInt(std::string_view json, std::string_view key) {
-    std::string needle = "\"" + std::string(key) + "\":";
-    auto pos = json.find(needle);
-    if (pos == std::string_view::npos) {
-        return 0;
+private:
+    bool fail() {
+        failed_ = true;
+        return false;
     }
-    pos += needle.size();
-    // Skip whitespace
-    while (pos < json.size() && (json[pos] == ' ' || json[pos] == '\t')) {
-        ++pos;
+
+    void skipSpace() {
+        while (pos_ < json_.size() &&
+               (json_[pos_] == ' ' || json_[pos_] == '\t' || json_[pos_] == '\n' ||
+                json_[pos_] == '\r')) {
+            ++pos_;
+        }
     }
-    int64_t result = 0;
-    auto [ptr, ec] = std::from_chars(json.data() + pos, json.data() + json.size(), result);
-    if (ec != std::errc{}) {
-        return 0;
+
+    bool consume(char c) {
+        skipSpace();
+        if (pos_ < json_.size() && json_[pos_] == c) {
+            ++pos_;
+            return true;
+        }
+        return false;
     }
-    return result;
-}
 
-/// Extract a JSON string array by key (simple parser).
-std::vector<std::string> extractJsonStringArray(std::string_view json, std::string_view key) {
-    std::vector<std::string> result;
-    std::string needle = "\"" + std::string(key) + "\":[";
-    auto pos = json.find(needle);
-    if (pos == std::string_view::npos) {
-        return result;
+    bool atEnd() {
+        skipSpace();
+        return pos_ == json_.size();
+    }
+
+    /// Read a string without escapes as a view (keys).
+    bool readView(std::string_view& out) {
+        skipSpace();
+        if (pos_ >= json_.size() || json_[pos_] != '"') {
+            return false;
+        }
+        auto end = json_.find_first_of("\"\\", pos_ + 1);
+        if (end == std::string_view::npos || json_[end] != '"') {
+            return false;
+        }
+        out = json_.substr(pos_ + 1, end - pos_ - 1);
+        pos_ = end + 1;
+        return true;
+    }
+
+    bool readEscaped(std::string& out) {
+        out.clear();
+        for (++pos_; pos_ < json_.size(); ++pos_) {
+            char c = json_[pos_];
+            if (c == '"') {
+                ++pos_;
+                return true;
+            }
+            if (c != '\\') {
+                out.push_back(c);
+                continue;
+            }
+            if (++pos_ >= json_.size()) {
+                break;
+            }
+            switch (json_[pos_]) {
+                case '"':
+                case '\\':
+                case '/':
+                    out.push_back(json_[pos_]);
+                    break;
+                case 'n':
+                    out.push_back('\n');
+                    break;
+                case 'r':
+                    out.push_back('\r');
+                    break;
+                case 't':
+                    out.push_back('\t');
+                    break;
+                case 'b':
+                    out.push_back('\b');
+                    break;
+                case 'f':
+                    out.push_back('\f');
+                    break;
+                default:
+                    return fail();  // \\u escapes are never issued.
+            }
+        }
+        return fail();
     }
-    pos += needle.size();
-    auto end = json.find(']', pos);
-    if (end == std::string_view::npos) {
-        return result;
+
+    /// Skip a string, number, literal, array or object.
+    bool skipValue() {
+        skipSpace();
+        int depth = 0;
+        while (pos_ < json_.size()) {
+            const char c = json_[pos_];
+            if (c == '"') {
+                std::string ignored;
+                if (!readString(ignored)) {
+                    return false;
+                }
+            } else if (c == '[' || c == '{') {
+                ++depth;
+                ++pos_;
+            } else if (c == ']' || c == '}') {
+                if (depth == 0) {
+                    return true;  // End of the enclosing object.
+                }
+                --depth;
+                ++pos_;
+            } else if (c == ',' && depth == 0) {
+                return true;
+            } else {
+                ++pos_;
+            }
+            if (depth == 0 && (c == '"' || c == ']' || c == '}')) {
+                return true;
+            }
+        }
+        return false;
     }
-    auto arrayContent = json.substr(pos, end - pos);
 
-    std::size_t cur = 0;
-    while (cur < arrayContent.size()) {
-        auto qStart = arrayContent.find('"', cur);
-        if (qStart == std::string_view::npos) {
-            break;
+    std::string_view json_;
+    std::size_t pos_ = 0;
+    bool failed_ = false;
+};
+
+/// Bytes decoded on the stack; longer input goes to the heap.
+class DecodeBuffer {
+public:
+    /// Decode @p encoded; returns the bytes, or std::nullopt if invalid.
+    std::optional<std::span<const uint8_t>> decode(std::string_view encoded) {
+        auto capacity = detail::base64urlDecodedSize(encoded.size());
+        uint8_t* out = stack_.data();
+        if (capacity > stack_.size()) {
+            heap_.resize(capacity);
+            out = heap_.data();
         }
-        auto qEnd = arrayContent.find('"', qStart + 1);
-        if (qEnd == std::string_view::npos) {
-            break;
+        auto size = detail::base64urlDecodeTo(encoded, out);
+        if (!size) {
+            return std::nullopt;
+        }
+        return std::span<const uint8_t>(out, *size);
+    }
+
+    /// Decode @p encoded as text; empty if invalid.
+    std::string_view decodeText(std::string_view encoded) {
+        auto bytes = decode(encoded);
+        if (!bytes) {
+            return {};
         }
-        result.emplace_back(arrayContent.substr(qStart + 1, qEnd - qStart - 1));
-        cur = qEnd + 1;
+        return {reinterpret_cast<const char*>(bytes->data()), bytes->size()};
+    }
+
+private:
+    std::array<uint8_t, 1024> stack_;
+    std::vector<uint8_t> heap_;
+};
+
+/// Encoded headers this provider issues, recognized without decoding.
+const std::string& encodedHeader(JwtAlgorithm algorithm) {
+    static const std::string hs256 = detail::base64urlEncode(R"({"alg":"HS256","typ":"JWT"})");
+    static const std::string rs256 = detail::base64urlEncode(R"({"alg":"RS256","typ":"JWT"})");
+    return algorithm == JwtAlgorithm::RS256 ? rs256 : hs256;
+}
+
+/// Algorithm named by the token's encoded header ("" if unreadable).
+std::string headerAlgorithm(std::string_view header) {
+    if (header == encodedHeader(JwtAlgorithm::HS256)) {
+        return "HS256";
+    }
+    if (header == encodedHeader(JwtAlgorithm::RS256)) {
+        return "RS256";
+    }
+    DecodeBuffer buffer;
+    JsonReader reader(buffer.decodeText(header));
+    std::string alg;
+    if (!reader.forEachMember([&](std::string_view key) {
+            return key == "alg" && reader.readString(alg);
+        })) {
+        return {};
     }
-    return result;
+    return alg;
+}
+
+/// Decode payload JSON straight into @p claims.
+bool parseClaims(std::string_view json, TokenClaims& claims) {
+    JsonReader reader(json);
+    return reader.forEachMember([&](std::string_view key) {
+        int64_t seconds = 0;
+        if (key == "sub") {
+            return reader.readString(claims.subject);
+        }
+        if (key == "usr") {
+            return reader.readString(claims.username);
+        }
+        if (key == "roles") {
+            return reader.readStringArray(claims.roles);
+        }
+        if (key == "jti") {
+            return reader.readString(claims.jti);
+        }
+        if (key == "iat") {
+            bool ok = reader.readInt(seconds);
+            claims.issuedAt = fromEpoch(seconds);
+            return ok;
+        }
+        if (key == "exp") {
+            bool ok = reader.readInt(seconds);
+            claims.expiresAt = fromEpoch(seconds);
+            return ok;
+        }
+        return false;
+    });
 }
 
 }  // anonymous namespace
@@ -168,19 +378,29 @@ std::vector<std::string> extractJsonStringArray(std::string_view json, std::stri
 // TokenProvider
 // ---------------------------------------------------------------------------
 
+struct TokenProvider::Keys {
+    explicit Keys(const AuthConfig& config)
+        : hmac(config.signingKey),
+          rsaPrivate(config.rsaPrivateKeyPem.empty()
+                         ? nullptr
+                         : detail::loadPrivateKey(config.rsaPrivateKeyPem)),
+          rsaPublic(config.rsaPublicKeyPem.empty()
+                        ? nullptr
+                        : detail::loadPublicKey(config.rsaPublicKeyPem)),
+          rsaPublicConfigured(!config.rsaPublicKeyPem.empty()) {}
+
+    detail::HmacSha256Key hmac;
+    detail::PkeyPtr rsaPrivate;
+    detail::PkeyPtr rsaPublic;
+    bool rsaPublicConfigured;
+};
+
 TokenProvider::TokenProvider(const AuthConfig& config)
-    : signingKey_(config.signingKey),
-      rsaPrivateKeyPem_(config.rsaPrivateKeyPem),
-      rsaPublicKeyPem_(config.rsaPublicKeyPem),
-      algorithm_(config.jwtAlgorithm) {}
+    : keys_(std::make_shared<const Keys>(config)), algorithm_(config.jwtAlgorithm) {}
 
 std::string TokenProvider::generateAccessToken(const TokenClaims& claims,
                                                std::chrono::seconds expiry) const {
-    // Select header based on algorithm.
     const bool useRs256 = (algorithm_ == JwtAlgorithm::RS256);
-    const std::string header =
-        useRs256 ? R"({"alg":"RS256","typ":"JWT"})" : R"({"alg":"HS256","typ":"JWT"})";
-    auto encodedHeader = detail::base64urlEncode(header);
 
     // Compute timestamps.
     auto now = std::chrono::system_clock::now();
@@ -191,104 +411,122 @@ std::string TokenProvider::generateAccessToken(const TokenClaims& claims,
     auto jti = detail::secureRandomHex(16);  // 16 bytes -> 32 hex chars
 
     // Build payload JSON.
-    std::ostringstream payload;
-    payload << "{\"sub\":" << jsonEscape(claims.subject)
-            << ",\"usr\":" << jsonEscape(claims.username) << ",\"roles\":[";
+    std::string payload;
+    payload.reserve(128 + claims.subject.size() + claims.username.size() +
+                    claims.roles.size() * 16);
+    payload += "{\"sub\":";
+    appendJsonString(payload, claims.subject);
+    payload += ",\"usr\":";
+    appendJsonString(payload, claims.username);
+    payload += ",\"roles\":[";
     for (std::size_t i = 0; i < claims.roles.size(); ++i) {
         if (i > 0) {
-            payload << ",";
+            payload.push_back(',');
         }
-        payload << jsonEscape(claims.roles[i]);
+        appendJsonString(payload, claims.roles[i]);
     }
-    payload << "],\"jti\":" << jsonEscape(jti) << ",\"iat\":" << iat << ",\"exp\":" << exp << "}";
-
-    auto encodedPayload = detail::base64urlEncode(payload.str());
-
-    // Sign: algorithm-specific.
-    std::string signingInput = encodedHeader + "." + encodedPayload;
+    payload += "],\"jti\":";
+    appendJsonString(payload, jti);
+    payload += ",\"iat\":";
+    appendInt(payload, iat);
+    payload += ",\"exp\":";
+    appendInt(payload, exp);
+    payload.push_back('}');
+
+    // header.payload, then sign it in place.
+    const auto& header = encodedHeader(algorithm_);
+    std::string token;
+    token.reserve(header.size() + detail::base64urlEncodedSize(payload.size()) + 2 +
+                  (useRs256 ? 700 : 43));
+    token += header;
+    token.push_back('.');
+    detail::base64urlEncodeTo(token,
+                              reinterpret_cast<const uint8_t*>(payload.data()),
+                              payload.size());
 
     if (useRs256) {
-        auto sig = detail::rsaSha256Sign(rsaPrivateKeyPem_, signingInput);
-        auto encodedSignature = detail::base64urlEncode(sig.data(), sig.size());
-        return signingInput + "." + encodedSignature;
+        auto sig = detail::rsaSha256Sign(keys_->rsaPrivate.get(), token);
+        token.push_back('.');
+        detail::base64urlEncodeTo(token, sig.data(), sig.size());
+        return token;
     }
 
     // HS256 (default).
-    auto mac = detail::hmacSha256(signingKey_, signingInput);
-    auto encodedSignature = detail::base64urlEncode(mac.data(), mac.size());
-    return signingInput + "." + encodedSignature;
+    auto mac = keys_->hmac.mac(token);
+    token.push_back('.');
+    detail::base64urlEncodeTo(token, mac.data(), mac.size());
+    return token;
 }
 
 cgs::foundation::GameResult<TokenClaims> TokenProvider::validateAccessToken(
     std::string_view token) const {
-    // Split into 3 parts: header.payload.signature
-    auto parts = split(token, '.', 3);
-    if (parts.size() != 3) {
-        return cgs::foundation::GameResult<TokenClaims>::err(
+    // header.payload.signature, as views of the token.
+    const auto firstDot = token.find('.');
+    const auto secondDot =
+        firstDot == std::string_view::npos ? firstDot : token.find('.', firstDot + 1);
+    if (secondDot == std::string_view::npos || firstDot == 0 || secondDot + 1 == token.size()) {
+        return ClaimsResult::err(
             GameError(ErrorCode::InvalidToken, "malformed JWT: expected 3 parts"));
     }
-
-    // Decode header to determine algorithm.
-    auto headerJson = detail::base64urlDecodeString(parts[0]);
-    auto alg = extractJsonString(headerJson, "alg");
+    const auto header = token.substr(0, firstDot);
+    const auto payload = token.substr(firstDot + 1, secondDot - firstDot - 1);
+    const auto signature = token.substr(secondDot + 1);
+    const auto signingInput = token.substr(0, secondDot);
 
     // Verify signature based on claimed algorithm.
-    std::string signingInput = parts[0] + "." + parts[1];
+    const auto alg = headerAlgorithm(header);
 
     if (alg == "RS256") {
         // RS256 verification requires public key.
-        if (rsaPublicKeyPem_.empty()) {
-            return cgs::foundation::GameResult<TokenClaims>::err(GameError(
+        if (!keys_->rsaPublicConfigured) {
+            return ClaimsResult::err(GameError(
                 ErrorCode::InvalidToken, "RS256 token received but no public key configured"));
         }
-        auto sigBytes = detail::base64urlDecode(parts[2]);
-        if (!detail::rsaSha256Verify(rsaPublicKeyPem_, signingInput, sigBytes)) {
-            return cgs::foundation::GameResult<TokenClaims>::err(
-                GameError(ErrorCode::InvalidToken, "invalid RS256 signature"));
+        DecodeBuffer sigBuffer;
+        auto sigBytes = sigBuffer.decode(signature);
+        if (!sigBytes || !detail::rsaSha256Verify(keys_->rsaPublic.get(), signingInput,
+                                                  sigBytes->data(), sigBytes->size())) {
+            return ClaimsResult::err(GameError(ErrorCode::InvalidToken, "invalid RS256 signature"));
         }
     } else if (alg == "HS256") {
-        // HS256 verification.
-        auto expectedMac = detail::hmacSha256(signingKey_, signingInput);
-        auto expectedSig = detail::base64urlEncode(expectedMac.data(), expectedMac.size());
-        if (!detail::constantTimeEqual(expectedSig, parts[2])) {
-            return cgs::foundation::GameResult<TokenClaims>::err(
-                GameError(ErrorCode::InvalidToken, "invalid HS256 signature"));
+        // Compare encodings, so only the canonical one is accepted.
+        auto expectedMac = keys_->hmac.mac(signingInput);
+        std::array<char, detail::base64urlEncodedSize(32)> expectedSig;
+        detail::base64urlEncodeTo(expectedSig.data(), expectedMac.data(), expectedMac.size());
+        if (!detail::constantTimeEqual(std::string_view(expectedSig.data(), expectedSig.size()),
+                                       signature)) {
+            return ClaimsResult::err(GameError(ErrorCode::InvalidToken, "invalid HS256 signature"));
         }
     } else {
-        return cgs::foundation::GameResult<TokenClaims>::err(
+        return ClaimsResult::err(
             GameError(ErrorCode::InvalidToken, "unsupported JWT algorithm: " + alg));
     }
 
-    // Decode payload.
-    auto payloadJson = detail::base64urlDecodeString(parts[1]);
+    // Decode payload straight into the claims.
+    DecodeBuffer payloadBuffer;
+    auto payloadJson = payloadBuffer.decodeText(payload);
     if (payloadJson.empty()) {
-        return cgs::foundation::GameResult<TokenClaims>::err(
-            GameError(ErrorCode::InvalidToken, "failed to decode payload"));
+        return ClaimsResult::err(GameError(ErrorCode::InvalidToken, "failed to decode payload"));
     }
 
-    // Parse claims.
     TokenClaims claims;
-    claims.subject = extractJsonString(payloadJson, "sub");
-    claims.username = extractJsonString(payloadJson, "usr");
-    claims.roles = extractJsonStringArray(payloadJson, "roles");
-    claims.jti = extractJsonString(payloadJson, "jti");
-    claims.issuedAt = fromEpoch(extractJsonInt(payloadJson, "iat"));
-    claims.expiresAt = fromEpoch(extractJsonInt(payloadJson, "exp"));
+    if (!parseClaims(payloadJson, claims)) {
+        return ClaimsResult::err(GameError(ErrorCode::InvalidToken, "malformed JWT payload"));
+    }
 
     // Check expiry.
     auto now = std::chrono::system_clock::now();
     if (now > claims.expiresAt) {
-        return cgs::foundation::GameResult<TokenClaims>::err(
-            GameError(ErrorCode::TokenExpired, "access token has expired"));
+        return ClaimsResult::err(GameError(ErrorCode::TokenExpired, "access token has expired"));
     }
 
     // Check blacklist.
     if (blacklist_ && !claims.jti.empty() && blacklist_->isRevoked(claims.jti)) {
-        return cgs::foundation::GameResult<TokenClaims>::err(
+        return ClaimsResult::err(
             GameError(ErrorCode::TokenRevoked, "access token has been revoked"));
     }
 
-    return cgs::foundation::GameResult<TokenClaims>::ok(std::move(claims));
+    return ClaimsResult::ok(std::move(claims));
 }
 
 void TokenProvider::setBlacklist(TokenBlacklist* blacklist) {
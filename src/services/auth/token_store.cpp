@@ -3,54 +3,141 @@
 
 #include "cgs/service/token_store.hpp"
 
-#include <chrono>
+#include "crypto_utils.hpp"
+
+#include <algorithm>
 
 namespace cgs::service {
 
+InMemoryTokenStore::InMemoryTokenStore(std::size_t shards)
+    : shards_(std::make_unique<Shard[]>(std::max<std::size_t>(shards, 1))),
+      shardCount_(std::max<std::size_t>(shards, 1)) {}
+
+InMemoryTokenStore::Shard& InMemoryTokenStore::shardFor(const Digest& digest) const {
+    // Bytes the map hash does not use, so shards and buckets stay independent.
+    uint64_t value = 0;
+    std::memcpy(&value, digest.data() + 8, sizeof(value));
+    return shards_[value % shardCount_];
+}
+
 void InMemoryTokenStore::store(RefreshTokenRecord record) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto key = record.token;
-    tokens_.emplace(std::move(key), std::move(record));
+    const Digest digest = detail::sha256(record.token);
+    auto& shard = shardFor(digest);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto [it, inserted] =
+        shard.tokens.try_emplace(digest, Entry{record.userId, record.expiresAt, record.revoked});
+    if (!inserted) {
+        return;
+    }
+    shard.byUser[record.userId].push_back(digest);
+    shard.byExpiry.push(Expiry{record.expiresAt, digest});
+    if (record.revoked) {
+        shard.revoked.push_back(digest);
+    }
 }
 
 std::optional<RefreshTokenRecord> InMemoryTokenStore::find(std::string_view token) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = tokens_.find(std::string(token));
-    if (it == tokens_.end()) {
+    const Digest digest = detail::sha256(token);
+    auto& shard = shardFor(digest);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.tokens.find(digest);
+    if (it == shard.tokens.end()) {
         return std::nullopt;
     }
-    return it->second;
+    RefreshTokenRecord record;
+    record.token = std::string(token);
+    record.userId = it->second.userId;
+    record.expiresAt = it->second.expiresAt;
+    record.revoked = it->second.revoked;
+    return record;
 }
 
 bool InMemoryTokenStore::revoke(std::string_view token) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = tokens_.find(std::string(token));
-    if (it == tokens_.end()) {
+    const Digest digest = detail::sha256(token);
+    auto& shard = shardFor(digest);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.tokens.find(digest);
+    if (it == shard.tokens.end()) {
         return false;
     }
-    it->second.revoked = true;
+    if (!it->second.revoked) {
+        it->second.revoked = true;
+        shard.revoked.push_back(digest);
+    }
     return true;
 }
 
 void InMemoryTokenStore::revokeAllForUser(uint64_t userId) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    for (auto& [key, record] : tokens_) {
-        if (record.userId == userId) {
-            record.revoked = true;
+    for (std::size_t i = 0; i < shardCount_; ++i) {
+        auto& shard = shards_[i];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto user = shard.byUser.find(userId);
+        if (user == shard.byUser.end()) {
+            continue;
+        }
+        for (const auto& digest : user->second) {
+            auto& entry = shard.tokens.at(digest);
+            if (!entry.revoked) {
+                entry.revoked = true;
+                shard.revoked.push_back(digest);
+            }
         }
     }
 }
 
 void InMemoryTokenStore::removeExpired() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto now = std::chrono::system_clock::now();
-    for (auto it = tokens_.begin(); it != tokens_.end();) {
-        if (it->second.expiresAt <= now || it->second.revoked) {
-            it = tokens_.erase(it);
-        } else {
-            ++it;
+    auto now = Clock::now();
+    for (std::size_t i = 0; i < shardCount_; ++i) {
+        auto& shard = shards_[i];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        for (const auto& digest : shard.revoked) {
+            eraseLocked(shard, digest);
         }
+        shard.revoked.clear();
+
+        while (!shard.byExpiry.empty() && shard.byExpiry.top().expiresAt <= now) {
+            const auto& top = shard.byExpiry.top();
+            auto it = shard.tokens.find(top.digest);
+            // Skip nodes whose token was removed (or removed and stored again).
+            if (it != shard.tokens.end() && it->second.expiresAt == top.expiresAt) {
+                eraseLocked(shard, top.digest);
+            }
+            shard.byExpiry.pop();
+        }
+    }
+}
+
+void InMemoryTokenStore::eraseLocked(Shard& shard, const Digest& digest) {
+    auto it = shard.tokens.find(digest);
+    if (it == shard.tokens.end()) {
+        return;
+    }
+    auto user = shard.byUser.find(it->second.userId);
+    if (user != shard.byUser.end()) {
+        auto& digests = user->second;
+        auto pos = std::find(digests.begin(), digests.end(), digest);
+        if (pos != digests.end()) {
+            *pos = digests.back();
+            digests.pop_back();
+        }
+        if (digests.empty()) {
+            shard.byUser.erase(user);
+        }
+    }
+    shard.tokens.erase(it);
+}
+
+std::size_t InMemoryTokenStore::size() const {
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < shardCount_; ++i) {
+        std::lock_guard<std::mutex> lock(shards_[i].mutex);
+        total += shards_[i].tokens.size();
     }
+    return total;
 }
 
 }  // namespace cgs::service
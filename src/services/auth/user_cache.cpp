@@ -0,0 +1,305 @@
+/// @file user_cache.cpp
+/// @brief CachedUserRepository implementation.
+
+#include "cgs/service/user_cache.hpp"
+
+#include <algorithm>
+#include <mutex>
+
+namespace cgs::service {
+
+using cgs::foundation::GameResult;
+
+namespace {
+
+// Invalidation record: [8 id][2 username length][username][2 email length][email],
+// little-endian.
+void appendU64(std::vector<uint8_t>& out, uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void appendString(std::vector<uint8_t>& out, std::string_view value) {
+    auto size = static_cast<uint16_t>(std::min<std::size_t>(value.size(), UINT16_MAX));
+    out.push_back(static_cast<uint8_t>(size));
+    out.push_back(static_cast<uint8_t>(size >> 8));
+    out.insert(out.end(), value.begin(), value.begin() + size);
+}
+
+bool readString(std::span<const uint8_t>& in, std::string_view& value) {
+    if (in.size() < 2) {
+        return false;
+    }
+    auto size = static_cast<std::size_t>(in[0] | (in[1] << 8));
+    if (in.size() < 2 + size) {
+        return false;
+    }
+    value = std::string_view(reinterpret_cast<const char*>(in.data() + 2), size);
+    in = in.subspan(2 + size);
+    return true;
+}
+
+}  // namespace
+
+CachedUserRepository::CachedUserRepository(std::shared_ptr<IUserRepository> backing,
+                                           UserCacheConfig config)
+    : backing_(std::move(backing)), config_(config) {}
+
+// -- Reads -----------------------------------------------------------------------
+
+std::optional<UserRecord> CachedUserRepository::findById(uint64_t id) const {
+    {
+        std::shared_lock lock(mutex_);
+        auto it = byId_.find(id);
+        if (it != byId_.end() && it->second.expires > Clock::now()) {
+            auto user = it->second.user;
+            lock.unlock();
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            return *user;
+        }
+    }
+
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    auto generation = generation_.load(std::memory_order_acquire);
+    auto user = backing_->findById(id);
+    if (user) {
+        fill(std::make_shared<const UserRecord>(*user), Key::Username, user->username,
+             generation);
+    }
+    return user;
+}
+
+std::optional<UserRecord> CachedUserRepository::findByUsername(std::string_view username) const {
+    auto user = lookup(Key::Username, username);
+    return user.hasValue() ? user.value() : std::nullopt;
+}
+
+std::optional<UserRecord> CachedUserRepository::findByEmail(std::string_view email) const {
+    auto user = lookup(Key::Email, email);
+    return user.hasValue() ? user.value() : std::nullopt;
+}
+
+GameResult<std::optional<UserRecord>> CachedUserRepository::lookupByUsername(
+    std::string_view username) const {
+    return lookup(Key::Username, username);
+}
+
+GameResult<std::optional<UserRecord>> CachedUserRepository::lookupByEmail(
+    std::string_view email) const {
+    return lookup(Key::Email, email);
+}
+
+std::optional<std::shared_ptr<const UserRecord>> CachedUserRepository::findCached(
+    Key key, std::string_view value) const {
+    auto now = Clock::now();
+    std::shared_lock lock(mutex_);
+
+    const auto& index = key == Key::Username ? byUsername_ : byEmail_;
+    if (auto it = index.find(value); it != index.end()) {
+        auto entry = byId_.find(it->second);
+        if (entry != byId_.end() && entry->second.expires > now) {
+            return entry->second.user;
+        }
+        return std::nullopt;
+    }
+
+    const auto& negative = key == Key::Username ? freeUsernames_ : freeEmails_;
+    if (auto it = negative.find(value); it != negative.end() && it->second > now) {
+        return std::shared_ptr<const UserRecord>{};
+    }
+    return std::nullopt;
+}
+
+GameResult<std::optional<UserRecord>> CachedUserRepository::lookup(Key key,
+                                                                   std::string_view value) const {
+    if (auto cached = findCached(key, value)) {
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return GameResult<std::optional<UserRecord>>::ok(
+            *cached ? std::optional<UserRecord>(**cached) : std::nullopt);
+    }
+
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    auto generation = generation_.load(std::memory_order_acquire);
+    auto user = key == Key::Username ? backing_->lookupByUsername(value)
+                                     : backing_->lookupByEmail(value);
+    if (user.hasError()) {
+        return user;  // Not cached: a failed read says nothing about the name.
+    }
+    fill(user.value() ? std::make_shared<const UserRecord>(*user.value()) : nullptr, key, value,
+         generation);
+    return user;
+}
+
+void CachedUserRepository::fill(std::shared_ptr<const UserRecord> user,
+                                Key key,
+                                std::string_view value,
+                                uint64_t generation) const {
+    auto now = Clock::now();
+    std::unique_lock lock(mutex_);
+    if (generation_.load(std::memory_order_acquire) != generation) {
+        return;  // A write may have changed what the read returned.
+    }
+
+    if (!user) {
+        auto& negative = key == Key::Username ? freeUsernames_ : freeEmails_;
+        if (negative.size() >= config_.negativeCapacity) {
+            dropNegativeLocked(negative, now);
+        }
+        negative.insert_or_assign(std::string(value), now + config_.negativeTtl);
+        return;
+    }
+
+    eraseLocked(user->id);
+    if (byId_.size() >= config_.capacity) {
+        makeRoomLocked(now);
+    }
+    byUsername_.insert_or_assign(user->username, user->id);
+    byEmail_.insert_or_assign(user->email, user->id);
+    freeUsernames_.erase(user->username);
+    freeEmails_.erase(user->email);
+    auto id = user->id;
+    byId_.insert_or_assign(id, Entry{std::move(user), now + config_.ttl});
+}
+
+// -- Writes ----------------------------------------------------------------------
+
+uint64_t CachedUserRepository::create(UserRecord record) {
+    std::string username = record.username;
+    std::string email = record.email;
+    auto id = backing_->create(std::move(record));
+    if (id != 0) {
+        invalidate(id, username, email);
+        publish(id, username, email);
+    }
+    return id;
+}
+
+bool CachedUserRepository::update(const UserRecord& record) {
+    if (!backing_->update(record)) {
+        return false;
+    }
+    invalidate(record.id, record.username, record.email);
+    publish(record.id, record.username, record.email);
+    return true;
+}
+
+void CachedUserRepository::invalidate(uint64_t id,
+                                      std::string_view username,
+                                      std::string_view email) {
+    std::unique_lock lock(mutex_);
+    generation_.fetch_add(1, std::memory_order_acq_rel);
+    eraseLocked(id);
+    if (!username.empty()) {
+        if (auto it = freeUsernames_.find(username); it != freeUsernames_.end()) {
+            freeUsernames_.erase(it);
+        }
+    }
+    if (!email.empty()) {
+        if (auto it = freeEmails_.find(email); it != freeEmails_.end()) {
+            freeEmails_.erase(it);
+        }
+    }
+}
+
+bool CachedUserRepository::applyInvalidation(std::span<const uint8_t> record) {
+    if (record.size() < 8) {
+        return false;
+    }
+    uint64_t id = 0;
+    for (int i = 0; i < 8; ++i) {
+        id |= static_cast<uint64_t>(record[static_cast<std::size_t>(i)]) << (8 * i);
+    }
+    record = record.subspan(8);
+
+    std::string_view username;
+    std::string_view email;
+    if (!readString(record, username) || !readString(record, email)) {
+        return false;
+    }
+    invalidate(id, username, email);
+    return true;
+}
+
+void CachedUserRepository::clear() {
+    std::unique_lock lock(mutex_);
+    generation_.fetch_add(1, std::memory_order_acq_rel);
+    byId_.clear();
+    byUsername_.clear();
+    byEmail_.clear();
+    freeUsernames_.clear();
+    freeEmails_.clear();
+}
+
+void CachedUserRepository::publish(uint64_t id,
+                                   std::string_view username,
+                                   std::string_view email) {
+    std::vector<uint8_t> record;
+    record.reserve(12 + username.size() + email.size());
+    appendU64(record, id);
+    appendString(record, username);
+    appendString(record, email);
+    onInvalidate.emit(std::span<const uint8_t>(record));
+}
+
+// -- Housekeeping ----------------------------------------------------------------
+
+void CachedUserRepository::eraseLocked(uint64_t id) const {
+    auto it = byId_.find(id);
+    if (it == byId_.end()) {
+        return;
+    }
+    const auto& user = *it->second.user;
+    if (auto name = byUsername_.find(user.username); name != byUsername_.end() &&
+                                                     name->second == id) {
+        byUsername_.erase(name);
+    }
+    if (auto mail = byEmail_.find(user.email); mail != byEmail_.end() && mail->second == id) {
+        byEmail_.erase(mail);
+    }
+    byId_.erase(it);
+}
+
+void CachedUserRepository::makeRoomLocked(Clock::time_point now) const {
+    // Look at a few entries only, so a full cache does not cost a scan
+    // per fill: drop the expired ones among them, else the first.
+    constexpr std::size_t kSample = 32;
+    std::vector<uint64_t> victims;
+    std::size_t seen = 0;
+    for (auto it = byId_.begin(); it != byId_.end() && seen < kSample; ++it, ++seen) {
+        if (it->second.expires <= now) {
+            victims.push_back(it->first);
+        }
+    }
+    if (victims.empty() && !byId_.empty()) {
+        victims.push_back(byId_.begin()->first);
+    }
+    for (auto id : victims) {
+        eraseLocked(id);
+    }
+}
+
+void CachedUserRepository::dropNegativeLocked(StringMap<Clock::time_point>& negative,
+                                              Clock::time_point now) const {
+    std::erase_if(negative, [now](const auto& item) { return item.second <= now; });
+    if (negative.size() >= config_.negativeCapacity) {
+        negative.erase(negative.begin());
+    }
+}
+
+// -- Statistics ------------------------------------------------------------------
+
+std::size_t CachedUserRepository::size() const {
+    std::shared_lock lock(mutex_);
+    return byId_.size();
+}
+
+uint64_t CachedUserRepository::hitCount() const {
+    return hits_.load(std::memory_order_relaxed);
+}
+
+uint64_t CachedUserRepository::missCount() const {
+    return misses_.load(std::memory_order_relaxed);
+}
+
+}  // namespace cgs::service
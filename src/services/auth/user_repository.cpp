@@ -1,12 +1,35 @@
 /// @file user_repository.cpp
-/// @brief InMemoryUserRepository implementation.
+/// @brief InMemoryUserRepository and SqlUserRepository implementations.
 
 #include "cgs/service/user_repository.hpp"
 
+#include "cgs/foundation/error_code.hpp"
+#include "cgs/foundation/game_error.hpp"
+
 #include <chrono>
 
 namespace cgs::service {
 
+using cgs::foundation::ErrorCode;
+using cgs::foundation::GameError;
+using cgs::foundation::GameResult;
+using cgs::foundation::PreparedStatement;
+using cgs::foundation::QueryResult;
+
+// -- IUserRepository ----------------------------------------------------------
+
+GameResult<std::optional<UserRecord>> IUserRepository::lookupByUsername(
+    std::string_view username) const {
+    return GameResult<std::optional<UserRecord>>::ok(findByUsername(username));
+}
+
+GameResult<std::optional<UserRecord>> IUserRepository::lookupByEmail(
+    std::string_view email) const {
+    return GameResult<std::optional<UserRecord>>::ok(findByEmail(email));
+}
+
+// -- InMemoryUserRepository ---------------------------------------------------
+
 std::optional<UserRecord> InMemoryUserRepository::findById(uint64_t id) const {
     std::lock_guard<std::mutex> lock(mutex_);
     auto it = users_.find(id);
@@ -58,4 +81,152 @@ bool InMemoryUserRepository::update(const UserRecord& record) {
     return true;
 }
 
+// -- SqlUserRepository --------------------------------------------------------
+
+namespace {
+
+constexpr std::string_view kSelectUser =
+    "SELECT id, username, email, password_hash, salt, status, roles, created_at, updated_at "
+    "FROM users WHERE ";
+
+int64_t toMillis(std::chrono::system_clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
+}
+
+std::chrono::system_clock::time_point fromMillis(int64_t ms) {
+    return std::chrono::system_clock::time_point(std::chrono::milliseconds(ms));
+}
+
+std::string joinRoles(const std::vector<std::string>& roles) {
+    std::string joined;
+    for (const auto& role : roles) {
+        if (!joined.empty()) {
+            joined += ',';
+        }
+        joined += role;
+    }
+    return joined;
+}
+
+std::vector<std::string> splitRoles(std::string_view joined) {
+    std::vector<std::string> roles;
+    while (!joined.empty()) {
+        auto comma = joined.find(',');
+        roles.emplace_back(joined.substr(0, comma));
+        joined = comma == std::string_view::npos ? std::string_view{} : joined.substr(comma + 1);
+    }
+    return roles;
+}
+
+/// Bind every column but id.
+void bindColumns(PreparedStatement& stmt, const UserRecord& record) {
+    stmt.bindString("username", record.username)
+        .bindString("email", record.email)
+        .bindString("password_hash", record.passwordHash)
+        .bindString("salt", record.salt)
+        .bindInt("status", static_cast<int64_t>(record.status))
+        .bindString("roles", joinRoles(record.roles))
+        .bindInt("created_at", toMillis(record.createdAt))
+        .bindInt("updated_at", toMillis(record.updatedAt));
+}
+
+std::optional<UserRecord> decodeUser(const QueryResult& result) {
+    if (result.empty()) {
+        return std::nullopt;
+    }
+    auto row = result.front();
+    UserRecord user;
+    user.id = static_cast<uint64_t>(row.getInt("id").value_or(0));
+    user.username = std::string(row.getString("username").value_or(""));
+    user.email = std::string(row.getString("email").value_or(""));
+    user.passwordHash = std::string(row.getString("password_hash").value_or(""));
+    user.salt = std::string(row.getString("salt").value_or(""));
+    user.status = static_cast<UserStatus>(row.getInt("status").value_or(0));
+    user.roles = splitRoles(row.getString("roles").value_or(""));
+    user.createdAt = fromMillis(row.getInt("created_at").value_or(0));
+    user.updatedAt = fromMillis(row.getInt("updated_at").value_or(0));
+    return user;
+}
+
+}  // namespace
+
+SqlUserRepository::SqlUserRepository(UserStoreBackend backend) : backend_(std::move(backend)) {}
+
+GameResult<std::optional<UserRecord>> SqlUserRepository::fetchOne(
+    const PreparedStatement& stmt) const {
+    auto result = backend_.query(stmt);
+    if (result.hasError()) {
+        return GameResult<std::optional<UserRecord>>::err(result.error());
+    }
+    return GameResult<std::optional<UserRecord>>::ok(decodeUser(result.value()));
+}
+
+std::optional<UserRecord> SqlUserRepository::findById(uint64_t id) const {
+    PreparedStatement stmt(std::string(kSelectUser) + "id = $id");
+    stmt.bindInt("id", static_cast<int64_t>(id));
+    auto user = fetchOne(stmt);
+    return user.hasValue() ? user.value() : std::nullopt;
+}
+
+std::optional<UserRecord> SqlUserRepository::findByUsername(std::string_view username) const {
+    auto user = lookupByUsername(username);
+    return user.hasValue() ? user.value() : std::nullopt;
+}
+
+std::optional<UserRecord> SqlUserRepository::findByEmail(std::string_view email) const {
+    auto user = lookupByEmail(email);
+    return user.hasValue() ? user.value() : std::nullopt;
+}
+
+GameResult<std::optional<UserRecord>> SqlUserRepository::lookupByUsername(
+    std::string_view username) const {
+    PreparedStatement stmt(std::string(kSelectUser) + "username = $username");
+    stmt.bindString("username", std::string(username));
+    return fetchOne(stmt);
+}
+
+GameResult<std::optional<UserRecord>> SqlUserRepository::lookupByEmail(
+    std::string_view email) const {
+    PreparedStatement stmt(std::string(kSelectUser) + "email = $email");
+    stmt.bindString("email", std::string(email));
+    return fetchOne(stmt);
+}
+
+uint64_t SqlUserRepository::create(UserRecord record) {
+    auto now = std::chrono::system_clock::now();
+    record.createdAt = now;
+    record.updatedAt = now;
+
+    PreparedStatement insert(
+        "INSERT INTO users (username, email, password_hash, salt, status, roles, created_at, "
+        "updated_at) VALUES ($username, $email, $password_hash, $salt, $status, $roles, "
+        "$created_at, $updated_at)");
+    bindColumns(insert, record);
+    auto inserted = backend_.execute(insert);
+    if (inserted.hasError() || inserted.value() == 0) {
+        return 0;
+    }
+
+    // The id comes from the database; read it back by the unique username.
+    auto stored = lookupByUsername(record.username);
+    if (stored.hasError() || !stored.value()) {
+        return 0;
+    }
+    return stored.value()->id;
+}
+
+bool SqlUserRepository::update(const UserRecord& record) {
+    auto updated = record;
+    updated.updatedAt = std::chrono::system_clock::now();
+
+    PreparedStatement stmt(
+        "UPDATE users SET username = $username, email = $email, password_hash = $password_hash, "
+        "salt = $salt, status = $status, roles = $roles, created_at = $created_at, "
+        "updated_at = $updated_at WHERE id = $id");
+    bindColumns(stmt, updated);
+    stmt.bindInt("id", static_cast<int64_t>(record.id));
+    auto result = backend_.execute(stmt);
+    return result.hasValue() && result.value() > 0;
+}
+
 }  // namespace cgs::service
@@ -1,18 +1,28 @@
 /// @file connection_pool_manager.cpp
-/// @brief ConnectionPoolManager implementation with round-robin replica routing.
+/// @brief ConnectionPoolManager implementation with latency-aware replica
+///        routing, lag probing, read-your-writes session pinning and
+///        group commit of writes.
 
 #include "cgs/service/connection_pool_manager.hpp"
 
 #include "cgs/foundation/error_code.hpp"
 #include "cgs/foundation/game_database.hpp"
 #include "cgs/foundation/game_error.hpp"
+#include "cgs/service/replica_balancer.hpp"
+#include "cgs/service/write_combiner.hpp"
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <cmath>
 #include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace cgs::service {
 
+using cgs::foundation::BatchWriter;
 using cgs::foundation::DatabaseConfig;
 using cgs::foundation::ErrorCode;
 using cgs::foundation::GameDatabase;
@@ -20,6 +30,7 @@ using cgs::foundation::GameError;
 using cgs::foundation::GameResult;
 using cgs::foundation::PreparedStatement;
 using cgs::foundation::QueryResult;
+using cgs::foundation::RowBatchCallback;
 
 // ── Helpers ─────────────────────────────────────────────────────────────────
 
@@ -33,9 +44,23 @@ DatabaseConfig toFoundationConfig(const DBEndpointConfig& ep) {
     cfg.minConnections = ep.minConnections;
     cfg.maxConnections = ep.maxConnections;
     cfg.connectionTimeout = ep.connectionTimeout;
+    cfg.growAfterWait = ep.growAfterWait;
+    cfg.idleTimeout = ep.idleTimeout;
+    cfg.maxLifetime = ep.maxLifetime;
+    cfg.poolJitter = ep.poolJitter;
     return cfg;
 }
 
+// Replication lag of a PostgreSQL standby in milliseconds: zero when it
+// has replayed everything it received, NULL on a primary.
+constexpr std::string_view kLagProbe =
+    "SELECT (CASE WHEN pg_last_wal_receive_lsn() = pg_last_wal_replay_lsn() THEN 0 "
+    "ELSE EXTRACT(EPOCH FROM now() - pg_last_xact_replay_timestamp()) * 1000 END)::float8 "
+    "AS lag_ms";
+
+// Session pins are swept for expiry once per this many writes.
+constexpr uint64_t kPinSweepInterval = 1024;
+
 }  // anonymous namespace
 
 // ── Impl ────────────────────────────────────────────────────────────────────
@@ -46,40 +71,141 @@ struct ConnectionPoolManager::Impl {
     GameDatabase primaryDb;
     std::vector<GameDatabase> replicaDbs;
 
-    // Round-robin counter for replica selection.
-    std::atomic<uint64_t> replicaRoundRobin{0};
+    // Replica choice by latency and load; sized by config.replicas.
+    ReplicaBalancer balancer;
 
     mutable std::mutex mutex;
     bool started = false;
 
-    /// Select the next healthy replica via round-robin.
-    /// Returns nullptr if no replicas are connected.
-    GameDatabase* selectReplica() {
+    // Sessions whose reads stay on the primary until the time given.
+    mutable std::mutex sessionMutex;
+    mutable std::unordered_map<uint64_t, std::chrono::steady_clock::time_point> pinnedUntil;
+    uint64_t writesSinceSweep = 0;
+    std::atomic<uint64_t> pinnedReads{0};
+
+    // Group commit of combinable writes (DBProxyConfig::writeBatch).
+    WriteCombiner writes;
+
+    explicit Impl(DBProxyConfig cfg)
+        : config(std::move(cfg)),
+          balancer(config.replicas.size()),
+          writes(config.writeBatch,
+                 [this](const std::vector<std::string>& statements) {
+                     return commitGroup(statements);
+                 }) {}
+
+    [[nodiscard]] bool combines(WriteMode mode, std::string_view sql) const {
+        return mode == WriteMode::Combined && config.writeBatch.enabled &&
+               WriteCombiner::combinable(sql);
+    }
+
+    /// Run @p statements in one transaction on the primary.  If one fails
+    /// nothing was applied, so after the rollback each runs on its own and
+    /// a bad write fails only its caller.  A failed COMMIT is reported to
+    /// all, since whether it applied is unknown.
+    std::vector<GameResult<uint64_t>> commitGroup(const std::vector<std::string>& statements) {
+        std::vector<GameResult<uint64_t>> results;
+        results.reserve(statements.size());
+        if (statements.size() > 1) {
+            auto txn = primaryDb.beginTransaction();
+            if (txn.hasValue()) {
+                for (const auto& sql : statements) {
+                    auto result = txn.value().execute(sql);
+                    if (result.hasError()) {
+                        break;
+                    }
+                    results.push_back(std::move(result));
+                }
+                if (results.size() == statements.size()) {
+                    auto committed = txn.value().commit();
+                    if (committed.hasError()) {
+                        results.assign(statements.size(),
+                                       GameResult<uint64_t>::err(committed.error()));
+                    }
+                    return results;
+                }
+                (void)txn.value().rollback();
+                results.clear();
+            }
+        }
+        for (const auto& sql : statements) {
+            results.push_back(primaryDb.execute(sql));
+        }
+        return results;
+    }
+
+    /// Select a connected (and, with lag tracking, caught-up) replica.
+    /// Returns ReplicaBalancer::npos if there is none.
+    std::size_t selectReplica() const {
         if (replicaDbs.empty()) {
-            return nullptr;
+            return ReplicaBalancer::npos;
         }
+        return balancer.pick([this](std::size_t i) {
+            return replicaDbs[i].isConnected() &&
+                   (!config.trackReplicationLag || balancer.lag(i) <= config.maxReplicaLag);
+        });
+    }
 
-        auto count = replicaDbs.size();
-        auto startIdx = replicaRoundRobin.fetch_add(1, std::memory_order_relaxed);
+    /// Run @p read on replica @p i, feeding its latency to the balancer.
+    template <typename Read>
+    GameResult<QueryResult> onReplica(std::size_t i, const Read& read) {
+        balancer.begin(i);
+        const auto start = std::chrono::steady_clock::now();
+        auto result = read(replicaDbs[i]);
+        balancer.finish(i, std::chrono::steady_clock::now() - start, result.hasValue());
+        return result;
+    }
+
+    [[nodiscard]] bool readsOwnWrites() const {
+        return config.readYourWritesWindow.count() > 0 || config.trackReplicationLag;
+    }
 
-        // Try each replica starting from the round-robin position.
-        for (std::size_t i = 0; i < count; ++i) {
-            auto idx = (startIdx + i) % count;
-            if (replicaDbs[idx].isConnected()) {
-                return &replicaDbs[idx];
+    /// Pin @p session to the primary after it wrote: for the configured
+    /// window, or the worst probed lag if longer.
+    void noteWrite(uint64_t session) {
+        if (session == 0 || !readsOwnWrites()) {
+            return;
+        }
+        auto pin = config.readYourWritesWindow;
+        if (config.trackReplicationLag) {
+            for (std::size_t i = 0; i < balancer.size(); ++i) {
+                pin = std::max(pin, balancer.lag(i));
             }
         }
+        if (pin.count() <= 0) {
+            return;
+        }
 
-        return nullptr;
+        const auto now = std::chrono::steady_clock::now();
+        std::lock_guard lock(sessionMutex);
+        pinnedUntil[session] = now + pin;
+        if (++writesSinceSweep >= kPinSweepInterval) {
+            writesSinceSweep = 0;
+            std::erase_if(pinnedUntil, [now](const auto& entry) { return entry.second <= now; });
+        }
+    }
+
+    [[nodiscard]] bool pinned(uint64_t session) const {
+        if (session == 0 || !readsOwnWrites()) {
+            return false;
+        }
+        std::lock_guard lock(sessionMutex);
+        auto it = pinnedUntil.find(session);
+        if (it == pinnedUntil.end()) {
+            return false;
+        }
+        if (it->second <= std::chrono::steady_clock::now()) {
+            pinnedUntil.erase(it);
+            return false;
+        }
+        return true;
     }
 };
 
 // ── Construction / destruction / move ───────────────────────────────────────
 
 ConnectionPoolManager::ConnectionPoolManager(DBProxyConfig config)
-    : impl_(std::make_unique<Impl>()) {
-    impl_->config = std::move(config);
-}
+    : impl_(std::make_unique<Impl>(std::move(config))) {}
 
 ConnectionPoolManager::~ConnectionPoolManager() {
     if (impl_) {
@@ -143,16 +269,17 @@ bool ConnectionPoolManager::isConnected() const noexcept {
 
 // ── query() ─────────────────────────────────────────────────────────────────
 
-GameResult<QueryResult> ConnectionPoolManager::query(std::string_view sql) {
+GameResult<QueryResult> ConnectionPoolManager::query(std::string_view sql, uint64_t session) {
     if (!impl_->started) {
         return GameResult<QueryResult>::err(
             GameError(ErrorCode::DBProxyNotStarted, "connection pool manager not started"));
     }
 
-    // Try a replica first.
-    auto* replica = impl_->selectReplica();
-    if (replica) {
-        auto result = replica->query(sql);
+    // Try a replica first, unless the session must see its own writes.
+    if (impl_->pinned(session)) {
+        impl_->pinnedReads.fetch_add(1, std::memory_order_relaxed);
+    } else if (auto i = impl_->selectReplica(); i != ReplicaBalancer::npos) {
+        auto result = impl_->onReplica(i, [&](GameDatabase& db) { return db.query(sql); });
         if (result.hasValue()) {
             return result;
         }
@@ -163,30 +290,148 @@ GameResult<QueryResult> ConnectionPoolManager::query(std::string_view sql) {
     return impl_->primaryDb.query(sql);
 }
 
+// ── queryStream() ───────────────────────────────────────────────────────────
+
+GameResult<uint64_t> ConnectionPoolManager::queryStream(std::string_view sql,
+                                                        const RowBatchCallback& onBatch,
+                                                        std::size_t batchRows,
+                                                        uint64_t session) {
+    if (!impl_->started) {
+        return GameResult<uint64_t>::err(
+            GameError(ErrorCode::DBProxyNotStarted, "connection pool manager not started"));
+    }
+
+    // Not timed by the balancer: a stream's length is not a read latency.
+    if (impl_->pinned(session)) {
+        impl_->pinnedReads.fetch_add(1, std::memory_order_relaxed);
+    } else if (auto i = impl_->selectReplica(); i != ReplicaBalancer::npos) {
+        bool delivered = false;
+        auto result = impl_->replicaDbs[i].queryStream(
+            sql,
+            [&](const QueryResult& batch) {
+                delivered = true;
+                return onBatch(batch);
+            },
+            batchRows);
+        if (result.hasValue() || delivered) {
+            return result;  // Rows already handed out cannot be taken back
+        }
+    }
+    return impl_->primaryDb.queryStream(sql, onBatch, batchRows);
+}
+
 // ── execute() ───────────────────────────────────────────────────────────────
 
-GameResult<uint64_t> ConnectionPoolManager::execute(std::string_view sql) {
+GameResult<uint64_t> ConnectionPoolManager::execute(std::string_view sql,
+                                                    uint64_t session,
+                                                    WriteMode mode) {
     if (!impl_->started) {
         return GameResult<uint64_t>::err(
             GameError(ErrorCode::DBProxyNotStarted, "connection pool manager not started"));
     }
 
+    impl_->noteWrite(session);
+    if (impl_->combines(mode, sql)) {
+        return impl_->writes.execute(sql);
+    }
     return impl_->primaryDb.execute(sql);
 }
 
 // ── query(PreparedStatement) ────────────────────────────────────────────────
 
-GameResult<QueryResult> ConnectionPoolManager::query(const PreparedStatement& stmt) {
-    // Resolve to safe SQL with escaped parameters.
-    auto resolved = stmt.resolve();
-    return query(resolved);
+GameResult<QueryResult> ConnectionPoolManager::query(const PreparedStatement& stmt,
+                                                     uint64_t session) {
+    if (!impl_->started) {
+        return GameResult<QueryResult>::err(
+            GameError(ErrorCode::DBProxyNotStarted, "connection pool manager not started"));
+    }
+
+    // Server-side prepared on whichever pool runs it; replica first.
+    if (impl_->pinned(session)) {
+        impl_->pinnedReads.fetch_add(1, std::memory_order_relaxed);
+    } else if (auto i = impl_->selectReplica(); i != ReplicaBalancer::npos) {
+        auto result = impl_->onReplica(i, [&](GameDatabase& db) { return db.execute(stmt); });
+        if (result.hasValue()) {
+            return result;
+        }
+    }
+    return impl_->primaryDb.execute(stmt);
 }
 
 // ── execute(PreparedStatement) ──────────────────────────────────────────────
 
-GameResult<uint64_t> ConnectionPoolManager::execute(const PreparedStatement& stmt) {
-    auto resolved = stmt.resolve();
-    return execute(resolved);
+GameResult<uint64_t> ConnectionPoolManager::execute(const PreparedStatement& stmt,
+                                                    uint64_t session,
+                                                    WriteMode mode) {
+    if (!impl_->started) {
+        return GameResult<uint64_t>::err(
+            GameError(ErrorCode::DBProxyNotStarted, "connection pool manager not started"));
+    }
+
+    impl_->noteWrite(session);
+
+    // A combined statement joins its group as resolved (escaped) SQL.
+    if (impl_->combines(mode, stmt.sql())) {
+        return impl_->writes.execute(stmt.resolve());
+    }
+
+    auto result = impl_->primaryDb.execute(stmt);
+    if (result.hasError()) {
+        return GameResult<uint64_t>::err(result.error());
+    }
+    return GameResult<uint64_t>::ok(0);  // Affected rows are not reported
+}
+
+// ── write(BatchWriter) ──────────────────────────────────────────────────────
+
+GameResult<uint64_t> ConnectionPoolManager::write(const BatchWriter& batch, uint64_t session) {
+    if (!impl_->started) {
+        return GameResult<uint64_t>::err(
+            GameError(ErrorCode::DBProxyNotStarted, "connection pool manager not started"));
+    }
+
+    impl_->noteWrite(session);
+    return impl_->primaryDb.write(batch);
+}
+
+// ── Read-your-writes and replication lag ────────────────────────────────────
+
+bool ConnectionPoolManager::pinnedToPrimary(uint64_t session) const {
+    return impl_->pinned(session);
+}
+
+void ConnectionPoolManager::refreshReplicationLag() {
+    if (!impl_->started) {
+        return;
+    }
+    for (std::size_t i = 0; i < impl_->replicaDbs.size(); ++i) {
+        if (impl_->config.replicas[i].dbType != cgs::foundation::DatabaseType::PostgreSQL ||
+            !impl_->replicaDbs[i].isConnected()) {
+            continue;
+        }
+        // A failed probe keeps the last value; failing reads already
+        // steer traffic away.
+        auto result = impl_->replicaDbs[i].query(kLagProbe);
+        if (result.hasError() || result.value().empty()) {
+            continue;
+        }
+        if (auto lagMs = result.value()[0].getDouble("lag_ms")) {
+            impl_->balancer.setLag(
+                i, std::chrono::milliseconds(std::llround(std::max(*lagMs, 0.0))));
+        }
+    }
+}
+
+// ── maintainPools() ─────────────────────────────────────────────────────────
+
+void ConnectionPoolManager::maintainPools() {
+    if (!impl_->started) {
+        return;
+    }
+    impl_->primaryDb.maintainPool();
+    for (auto& replica : impl_->replicaDbs) {
+        replica.maintainPool();
+    }
 }
 
 // ── replicaCount() ──────────────────────────────────────────────────────────
@@ -203,10 +448,21 @@ PoolStats ConnectionPoolManager::stats() const {
     s.primaryTotal = impl_->primaryDb.poolSize();
     s.replicaCount = impl_->replicaDbs.size();
 
+    s.primaryPool = impl_->primaryDb.connectionPoolStats();
+
     for (const auto& replica : impl_->replicaDbs) {
         s.replicaActive += replica.activeConnections();
         s.replicaTotal += replica.poolSize();
+        s.replicaPool += replica.connectionPoolStats();
+    }
+
+    s.replicas = impl_->balancer.stats();
+    for (std::size_t i = 0; i < s.replicas.size() && i < impl_->replicaDbs.size(); ++i) {
+        s.replicas[i].connected = impl_->replicaDbs[i].isConnected();
     }
+    s.pinnedReads = impl_->pinnedReads.load(std::memory_order_relaxed);
+    s.writeGroups = impl_->writes.groupCount();
+    s.combinedWrites = impl_->writes.combinedCount();
 
     return s;
 }
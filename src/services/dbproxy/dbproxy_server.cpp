@@ -3,25 +3,41 @@
 
 #include "cgs/service/dbproxy_server.hpp"
 
+#include "cgs/foundation/blocking_executor.hpp"
 #include "cgs/foundation/error_code.hpp"
 #include "cgs/foundation/game_error.hpp"
 #include "cgs/service/connection_pool_manager.hpp"
 #include "cgs/service/query_cache.hpp"
+#include "cgs/service/query_shape_registry.hpp"
+#include "cgs/service/read_coalescer.hpp"
+#include "cgs/service/shared_result_cache.hpp"
+#include "cgs/service/sql_normalizer.hpp"
+
+#include "sql_tables.hpp"
 
 #include <algorithm>
 #include <atomic>
 #include <cctype>
+#include <chrono>
+#include <functional>
 #include <future>
+#include <memory>
 #include <mutex>
 #include <string>
 
 namespace cgs::service {
 
+using cgs::foundation::BatchWriter;
+using cgs::foundation::BlockingExecutor;
 using cgs::foundation::ErrorCode;
 using cgs::foundation::GameError;
 using cgs::foundation::GameResult;
 using cgs::foundation::PreparedStatement;
+using cgs::foundation::QueryCallback;
 using cgs::foundation::QueryResult;
+using cgs::foundation::RowBatchCallback;
+using cgs::foundation::Task;
+using detail::extractTableName;
 
 // ── Helpers ─────────────────────────────────────────────────────────────────
 
@@ -52,86 +68,256 @@ bool isReadQuery(std::string_view sql) {
     return true;
 }
 
-/// Extract table names from a write SQL statement for cache invalidation.
-/// Recognizes INSERT INTO <table>, UPDATE <table>, DELETE FROM <table>,
-/// and ALTER/DROP/TRUNCATE TABLE <table>.
-///
-/// Returns the first table name found (sufficient for invalidation).
-std::string extractTableName(std::string_view sql) {
-    // Normalize to uppercase for keyword matching.
-    auto upper = std::string(sql);
-    std::transform(
-        upper.begin(), upper.end(), upper.begin(), [](unsigned char c) { return std::toupper(c); });
-
-    // Patterns to search for.
-    struct Pattern {
-        std::string_view keyword;
-        std::size_t skipWords;  // Words to skip after keyword.
-    };
+GameResult<QueryResult> notStarted() {
+    return GameResult<QueryResult>::err(
+        GameError(ErrorCode::DBProxyNotStarted, "DBProxy not started"));
+}
 
-    static const Pattern patterns[] = {
-        {"INSERT INTO ", 0},
-        {"UPDATE ", 0},
-        {"DELETE FROM ", 0},
-        {"ALTER TABLE ", 0},
-        {"DROP TABLE ", 0},
-        {"TRUNCATE TABLE ", 0},
-        {"TRUNCATE ", 0},
-    };
+}  // anonymous namespace
+
+// ── Impl ────────────────────────────────────────────────────────────────────
+
+struct DBProxyServer::Impl {
+    DBProxyConfig config;
+
+    ConnectionPoolManager poolManager;
+    QueryCache cache;
+
+    // Second-level cache shared with other instances; null without a store.
+    std::unique_ptr<SharedResultCache> shared;
+
+    std::atomic<uint64_t> totalQueryCount{0};
+    std::atomic<uint64_t> streamCount{0};
+    std::atomic<uint64_t> streamedRowCount{0};
+    std::atomic<bool> running{false};
+
+    // Query workers for the asynchronous API; present while running.
+    std::unique_ptr<BlockingExecutor> io;
+    std::mutex ioMutex;
+
+    // Concurrent cache misses for the same SELECT share one fetch.
+    ReadCoalescer flights;
+
+    // Steady-clock time of the last replication lag probe, in ms.
+    std::atomic<int64_t> lastLagProbe{0};
+
+    // Steady-clock time of the last pool maintenance, in ms.
+    std::atomic<int64_t> lastPoolMaintenance{0};
+
+    // Count and latency per normalized query shape.
+    QueryShapeRegistry shapes;
+
+    Impl(DBProxyConfig cfg, std::shared_ptr<ISharedResultStore> sharedStore)
+        : config(std::move(cfg)),
+          poolManager(config),
+          cache(config.cache),
+          shared(sharedStore && config.cache.enabled
+                     ? std::make_unique<SharedResultCache>(config.sharedCache,
+                                                           std::move(sharedStore))
+                     : nullptr),
+          flights([this](std::function<void()> work) { return post(std::move(work)); },
+                  [this](std::string_view sql, const QueryResult& result) {
+                      if (config.cache.enabled) {
+                          cache.put(sql, result);
+                      }
+                  }),
+          shapes(config.maxQueryShapes) {}
+
+    /// Queue @p work on the query workers.  @return false if not running.
+    bool post(std::function<void()> work) {
+        std::lock_guard lock(ioMutex);
+        // io only stops after stop() took it, so post() cannot fail here.
+        return io && io->post(std::move(work));
+    }
 
-    for (const auto& pattern : patterns) {
-        auto pos = upper.find(pattern.keyword);
-        if (pos == std::string::npos) {
-            continue;
+    /// Hand @p result to @p onDone on a query worker (inline if stopped).
+    void complete(QueryCallback onDone, GameResult<QueryResult> result) {
+        if (!post([onDone, result] { onDone(result); })) {
+            onDone(std::move(result));
         }
+    }
 
-        // Move past the keyword.
-        auto nameStart = pos + pattern.keyword.size();
+    /// @p sql normalized, or (DBProxyConfig::normalizeQueries off) taken
+    /// as is.
+    [[nodiscard]] NormalizedSql normalize(std::string_view sql) const {
+        if (config.normalizeQueries) {
+            return normalizeSql(sql);
+        }
+        NormalizedSql n;
+        n.text = std::string(sql);
+        n.read = isReadQuery(sql);
+        n.opaque = true;
+        return n;
+    }
 
-        // Skip optional whitespace.
-        while (nameStart < sql.size() && std::isspace(static_cast<unsigned char>(sql[nameStart]))) {
-            ++nameStart;
+    /// Run the read @p sql (normalized as @p n) on the pools: as a prepared
+    /// statement of its shape when DBProxyConfig::prepareQueries allows.
+    GameResult<QueryResult> fetch(const NormalizedSql& n, std::string_view sql, uint64_t session) {
+        if (config.prepareQueries && n.read && n.parameterizable && !n.parameters.empty()) {
+            return poolManager.query(n.statement(), session);
         }
+        return poolManager.query(sql, session);
+    }
 
-        // Extract the table name (until whitespace, parenthesis, or semicolon).
-        auto nameEnd = nameStart;
-        while (nameEnd < sql.size()) {
-            char c = sql[nameEnd];
-            if (std::isspace(static_cast<unsigned char>(c)) || c == '(' || c == ';' || c == ',') {
-                break;
-            }
-            ++nameEnd;
+    /// Count a statement of shape @p n that started at @p start.
+    void record(const NormalizedSql& n, std::chrono::steady_clock::time_point start) {
+        if (config.normalizeQueries) {
+            shapes.record(n.fingerprint, n.shape, std::chrono::steady_clock::now() - start);
         }
+    }
 
-        if (nameEnd > nameStart) {
-            return std::string(sql.substr(nameStart, nameEnd - nameStart));
+    /// @p onDone, first counting the statement of shape @p n started at
+    /// @p start.
+    QueryCallback recording(const NormalizedSql& n,
+                            std::chrono::steady_clock::time_point start,
+                            QueryCallback onDone) {
+        if (!config.normalizeQueries) {
+            return onDone;
         }
+        return [this, fingerprint = n.fingerprint, shape = n.shape, start, onDone](
+                   GameResult<QueryResult> result) {
+            shapes.record(fingerprint, shape, std::chrono::steady_clock::now() - start);
+            onDone(std::move(result));
+        };
     }
 
-    return {};
-}
+    /// @p fetch behind the shared cache: a hit there skips the database,
+    /// and a fetched result is written to it on a query worker.
+    ReadCoalescer::Fetch throughShared(std::string_view sql, ReadCoalescer::Fetch fetch) {
+        return [this, key = std::string(sql), fetch = std::move(fetch)] {
+            auto lookup = shared->lookup(key);
+            if (lookup.result) {
+                return GameResult<QueryResult>::ok(std::move(*lookup.result));
+            }
+            auto result = fetch();
+            if (result.hasValue()) {
+                post([this, key, stamp = std::move(lookup.stamp), fetched = result.value()] {
+                    shared->put(key, stamp, fetched);
+                });
+            }
+            return result;
+        };
+    }
 
-}  // anonymous namespace
+    /// Read @p sql, served by the cache (then the shared cache) or an
+    /// identical read in flight when possible; @p fetch runs the query on
+    /// a miss.  Only a @p select is cached or coalesced.
+    template <typename Fetch>
+    GameResult<QueryResult> read(std::string_view sql, bool select, const Fetch& fetch) {
+        if (config.cache.enabled && select) {
+            auto cached = cache.get(sql);
+            if (cached) {
+                return GameResult<QueryResult>::ok(std::move(*cached));
+            }
+        }
+        if (shared && select) {
+            // The shared lookup is made once per flight, by its leader.
+            return readMiss(sql, select, throughShared(sql, fetch));
+        }
+        return readMiss(sql, select, fetch);
+    }
 
-// ── Impl ────────────────────────────────────────────────────────────────────
+    /// read() after the local cache missed.
+    template <typename Fetch>
+    GameResult<QueryResult> readMiss(std::string_view sql, bool select, const Fetch& fetch) {
+        if (config.coalesceReads && select) {
+            return flights.read(sql, fetch);
+        }
 
-struct DBProxyServer::Impl {
-    DBProxyConfig config;
+        auto result = fetch();
+        if (result.hasValue() && config.cache.enabled && select) {
+            cache.put(sql, result.value());
+        }
+        return result;
+    }
 
-    ConnectionPoolManager poolManager;
-    QueryCache cache;
+    /// Asynchronous read(): joins an identical read in flight without
+    /// taking a query worker.  @return false if not handled (not a
+    /// coalesced SELECT, or not running).
+    template <typename Fetch>
+    bool readAsync(std::string_view sql, bool select, Fetch fetch, QueryCallback& onDone) {
+        if (!config.coalesceReads || !select || !running.load()) {
+            return false;
+        }
+        totalQueryCount.fetch_add(1, std::memory_order_relaxed);
+        if (config.cache.enabled) {
+            auto cached = cache.get(sql);
+            if (cached) {
+                complete(std::move(onDone), GameResult<QueryResult>::ok(std::move(*cached)));
+                return true;
+            }
+        }
+        // A read queued while stop() runs still completes its waiters.
+        ReadCoalescer::Fetch load = [this, fetch = std::move(fetch)] {
+            return running.load() ? fetch() : notStarted();
+        };
+        if (shared) {
+            load = throughShared(sql, std::move(load));
+        }
+        flights.readAsync(sql, std::move(load), std::move(onDone));
+        return true;
+    }
 
-    std::atomic<uint64_t> totalQueryCount{0};
-    std::atomic<bool> running{false};
+    /// Queue a replication lag probe if one is due (at most one per
+    /// DBProxyConfig::lagProbeInterval).
+    void maybeProbeLag() {
+        if (!config.trackReplicationLag || config.replicas.empty()) {
+            return;
+        }
+        const auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                             std::chrono::steady_clock::now().time_since_epoch())
+                             .count();
+        auto last = lastLagProbe.load(std::memory_order_relaxed);
+        if (now - last < config.lagProbeInterval.count() ||
+            !lastLagProbe.compare_exchange_strong(last, now, std::memory_order_relaxed)) {
+            return;
+        }
+        post([this] { poolManager.refreshReplicationLag(); });
+    }
+
+    /// Queue pool maintenance if it is due (at most one per
+    /// DBProxyConfig::poolMaintenanceInterval).
+    void maybeMaintainPools() {
+        if (config.poolMaintenanceInterval.count() <= 0) {
+            return;
+        }
+        const auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                             std::chrono::steady_clock::now().time_since_epoch())
+                             .count();
+        auto last = lastPoolMaintenance.load(std::memory_order_relaxed);
+        if (now - last < config.poolMaintenanceInterval.count() ||
+            !lastPoolMaintenance.compare_exchange_strong(last, now, std::memory_order_relaxed)) {
+            return;
+        }
+        post([this] { poolManager.maintainPools(); });
+    }
+
+    /// Drop what a write to @p table made stale: reads in flight first,
+    /// then cached entries (see ReadCoalescer), here and, through the
+    /// table's shared version, on every instance.
+    void invalidate(std::string_view table) {
+        flights.invalidateTable(table);
+        if (config.cache.enabled) {
+            cache.invalidateByTable(table);
+        }
+        if (shared) {
+            shared->invalidateTable(table);
+        }
+    }
 
-    explicit Impl(DBProxyConfig cfg)
-        : config(std::move(cfg)), poolManager(config), cache(config.cache) {}
+    [[nodiscard]] std::size_t connectionCount() const {
+        std::size_t count = config.primary.maxConnections;
+        for (const auto& replica : config.replicas) {
+            count += replica.maxConnections;
+        }
+        return count;
+    }
 };
 
 // ── Construction / destruction / move ───────────────────────────────────────
 
-DBProxyServer::DBProxyServer(DBProxyConfig config)
-    : impl_(std::make_unique<Impl>(std::move(config))) {}
+DBProxyServer::DBProxyServer(DBProxyConfig config, std::shared_ptr<ISharedResultStore> sharedStore)
+    : impl_(std::make_unique<Impl>(std::move(config), std::move(sharedStore))) {}
 
 DBProxyServer::~DBProxyServer() {
     if (impl_ && impl_->running.load()) {
@@ -155,6 +341,11 @@ GameResult<void> DBProxyServer::start() {
         return result;
     }
 
+    {
+        std::lock_guard lock(impl_->ioMutex);
+        impl_->io = std::make_unique<BlockingExecutor>(impl_->connectionCount());
+    }
+
     impl_->running.store(true);
     return GameResult<void>::ok();
 }
@@ -163,6 +354,15 @@ GameResult<void> DBProxyServer::start() {
 
 void DBProxyServer::stop() {
     impl_->running.store(false);
+
+    // Queued queries finish (with DBProxyNotStarted) before the pools close.
+    std::unique_ptr<BlockingExecutor> io;
+    {
+        std::lock_guard lock(impl_->ioMutex);
+        io = std::move(impl_->io);
+    }
+    io.reset();
+
     impl_->poolManager.stop();
     impl_->cache.clear();
 }
@@ -175,39 +375,64 @@ bool DBProxyServer::isRunning() const noexcept {
 
 // ── query() ─────────────────────────────────────────────────────────────────
 
-GameResult<QueryResult> DBProxyServer::query(std::string_view sql) {
+GameResult<QueryResult> DBProxyServer::query(std::string_view sql, uint64_t session) {
     if (!impl_->running.load()) {
         return GameResult<QueryResult>::err(
             GameError(ErrorCode::DBProxyNotStarted, "DBProxy not started"));
     }
 
     impl_->totalQueryCount.fetch_add(1, std::memory_order_relaxed);
+    impl_->maybeProbeLag();
+    impl_->maybeMaintainPools();
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto normalized = impl_->normalize(sql);
+
+    // A session reading its own recent write skips cache and flights,
+    // which may hold what a replica returned before the write.  Others
+    // go to the cache, then a read in flight (both keyed on the canonical
+    // text), then the pool manager (which handles replica routing).
+    auto result = impl_->poolManager.pinnedToPrimary(session)
+                      ? impl_->fetch(normalized, sql, session)
+                      : impl_->read(normalized.text, normalized.read, [&] {
+                            return impl_->fetch(normalized, sql, 0);
+                        });
+    impl_->record(normalized, start);
+    return result;
+}
 
-    // Check cache first (only for read queries).
-    if (impl_->config.cache.enabled && isReadQuery(sql)) {
-        auto cached = impl_->cache.get(sql);
-        if (cached) {
-            return GameResult<QueryResult>::ok(std::move(*cached));
-        }
-    }
+// ── queryStream() ───────────────────────────────────────────────────────────
 
-    // Execute via pool manager (handles replica routing for SELECTs).
-    auto result = impl_->poolManager.query(sql);
-    if (result.hasError()) {
-        return result;
+GameResult<uint64_t> DBProxyServer::queryStream(std::string_view sql,
+                                                const RowBatchCallback& onBatch,
+                                                std::size_t batchRows,
+                                                uint64_t session) {
+    if (!impl_->running.load()) {
+        return GameResult<uint64_t>::err(
+            GameError(ErrorCode::DBProxyNotStarted, "DBProxy not started"));
     }
 
-    // Cache the result.
-    if (impl_->config.cache.enabled && isReadQuery(sql)) {
-        impl_->cache.put(sql, result.value());
+    impl_->totalQueryCount.fetch_add(1, std::memory_order_relaxed);
+    impl_->maybeProbeLag();
+    impl_->maybeMaintainPools();
+
+    // Straight to the pools: a result too large to hold is not cached,
+    // and one stream cannot feed another's callback.
+    const auto start = std::chrono::steady_clock::now();
+    auto result = impl_->poolManager.queryStream(sql, onBatch, batchRows, session);
+    impl_->record(impl_->normalize(sql), start);
+    if (result.hasValue()) {
+        impl_->streamCount.fetch_add(1, std::memory_order_relaxed);
+        impl_->streamedRowCount.fetch_add(result.value(), std::memory_order_relaxed);
     }
-
     return result;
 }
 
 // ── execute() ───────────────────────────────────────────────────────────────
 
-GameResult<uint64_t> DBProxyServer::execute(std::string_view sql) {
+GameResult<uint64_t> DBProxyServer::execute(std::string_view sql,
+                                            uint64_t session,
+                                            WriteMode mode) {
     if (!impl_->running.load()) {
         return GameResult<uint64_t>::err(
             GameError(ErrorCode::DBProxyNotStarted, "DBProxy not started"));
@@ -215,18 +440,18 @@ GameResult<uint64_t> DBProxyServer::execute(std::string_view sql) {
 
     impl_->totalQueryCount.fetch_add(1, std::memory_order_relaxed);
 
-    // Execute on primary.
-    auto result = impl_->poolManager.execute(sql);
+    // Execute on primary (possibly group-committed).
+    const auto start = std::chrono::steady_clock::now();
+    auto result = impl_->poolManager.execute(sql, session, mode);
+    impl_->record(impl_->normalize(sql), start);
     if (result.hasError()) {
         return result;
     }
 
-    // Invalidate cache entries for the affected table.
-    if (impl_->config.cache.enabled) {
-        auto tableName = extractTableName(sql);
-        if (!tableName.empty()) {
-            impl_->cache.invalidateByTable(tableName);
-        }
+    // Invalidate reads and cache entries for the affected table.
+    auto tableName = extractTableName(sql);
+    if (!tableName.empty()) {
+        impl_->invalidate(tableName);
     }
 
     return result;
@@ -235,50 +460,103 @@ GameResult<uint64_t> DBProxyServer::execute(std::string_view sql) {
 // ── queryAsync() ────────────────────────────────────────────────────────────
 
 std::future<GameResult<QueryResult>> DBProxyServer::queryAsync(std::string_view sql) {
-    auto sqlStr = std::string(sql);
-    return std::async(
-        std::launch::async,
-        [this, sqlStr = std::move(sqlStr)]() -> GameResult<QueryResult> { return query(sqlStr); });
+    auto promise = std::make_shared<std::promise<GameResult<QueryResult>>>();
+    auto future = promise->get_future();
+    queryAsync(sql, [promise](GameResult<QueryResult> result) {
+        promise->set_value(std::move(result));
+    });
+    return future;
+}
+
+void DBProxyServer::queryAsync(std::string_view sql, QueryCallback onDone) {
+    const auto start = std::chrono::steady_clock::now();
+    auto normalized = impl_->normalize(sql);
+    auto timed = impl_->recording(normalized, start, onDone);
+    const auto key = normalized.text;
+    const bool select = normalized.read;
+    auto fetch = [impl = impl_.get(), sqlStr = std::string(sql), n = std::move(normalized)] {
+        return impl->fetch(n, sqlStr, 0);
+    };
+    impl_->maybeProbeLag();
+    impl_->maybeMaintainPools();
+    if (impl_->readAsync(key, select, std::move(fetch), timed)) {
+        return;
+    }
+
+    auto work = [this, sqlStr = std::string(sql), onDone] { onDone(query(sqlStr)); };
+    if (!impl_->post(std::move(work))) {
+        onDone(GameResult<QueryResult>::err(
+            GameError(ErrorCode::DBProxyNotStarted, "DBProxy not started")));
+    }
+}
+
+Task<GameResult<QueryResult>> DBProxyServer::queryTask(std::string sql) {
+    co_return co_await cgs::foundation::awaitCallback<GameResult<QueryResult>>(
+        [this, &sql](auto complete) { queryAsync(sql, std::move(complete)); });
 }
 
 // ── query(PreparedStatement) ────────────────────────────────────────────────
 
-GameResult<QueryResult> DBProxyServer::query(const PreparedStatement& stmt) {
+GameResult<QueryResult> DBProxyServer::query(const PreparedStatement& stmt, uint64_t session) {
     if (!impl_->running.load()) {
         return GameResult<QueryResult>::err(
             GameError(ErrorCode::DBProxyNotStarted, "DBProxy not started"));
     }
 
     impl_->totalQueryCount.fetch_add(1, std::memory_order_relaxed);
+    impl_->maybeProbeLag();
+    impl_->maybeMaintainPools();
+
+    // The template gives the shape; its placeholders stay as written.
+    const auto start = std::chrono::steady_clock::now();
+    const auto normalized = impl_->normalize(stmt.sql());
+    if (impl_->poolManager.pinnedToPrimary(session)) {
+        auto result = impl_->poolManager.query(stmt, session);
+        impl_->record(normalized, start);
+        return result;
+    }
 
-    // Resolve to safe SQL with escaped parameters.
+    // Resolve to safe SQL with escaped parameters; it keys the cache and
+    // reads in flight.
     auto resolved = stmt.resolve();
+    auto result =
+        impl_->read(resolved, normalized.read, [&] { return impl_->poolManager.query(stmt); });
+    impl_->record(normalized, start);
+    return result;
+}
 
-    // Check cache using the resolved SQL.
-    if (impl_->config.cache.enabled && isReadQuery(resolved)) {
-        auto cached = impl_->cache.get(resolved);
-        if (cached) {
-            return GameResult<QueryResult>::ok(std::move(*cached));
-        }
+// ── execute(PreparedStatement) ──────────────────────────────────────────────
+
+GameResult<uint64_t> DBProxyServer::execute(const PreparedStatement& stmt,
+                                            uint64_t session,
+                                            WriteMode mode) {
+    if (!impl_->running.load()) {
+        return GameResult<uint64_t>::err(
+            GameError(ErrorCode::DBProxyNotStarted, "DBProxy not started"));
     }
 
-    // Execute via pool manager.
-    auto result = impl_->poolManager.query(stmt);
+    impl_->totalQueryCount.fetch_add(1, std::memory_order_relaxed);
+
+    // Execute on primary via pool manager.
+    const auto start = std::chrono::steady_clock::now();
+    auto result = impl_->poolManager.execute(stmt, session, mode);
+    impl_->record(impl_->normalize(stmt.sql()), start);
     if (result.hasError()) {
         return result;
     }
 
-    // Cache the result using the resolved SQL as key.
-    if (impl_->config.cache.enabled && isReadQuery(resolved)) {
-        impl_->cache.put(resolved, result.value());
+    // Invalidate reads and cache entries for the affected table.
+    auto tableName = extractTableName(stmt.resolve());
+    if (!tableName.empty()) {
+        impl_->invalidate(tableName);
     }
 
     return result;
 }
 
-// ── execute(PreparedStatement) ──────────────────────────────────────────────
+// ── write(BatchWriter) ──────────────────────────────────────────────────────
 
-GameResult<uint64_t> DBProxyServer::execute(const PreparedStatement& stmt) {
+GameResult<uint64_t> DBProxyServer::write(const BatchWriter& batch, uint64_t session) {
     if (!impl_->running.load()) {
         return GameResult<uint64_t>::err(
             GameError(ErrorCode::DBProxyNotStarted, "DBProxy not started"));
@@ -286,20 +564,12 @@ GameResult<uint64_t> DBProxyServer::execute(const PreparedStatement& stmt) {
 
     impl_->totalQueryCount.fetch_add(1, std::memory_order_relaxed);
 
-    // Execute on primary via pool manager.
-    auto result = impl_->poolManager.execute(stmt);
+    auto result = impl_->poolManager.write(batch, session);
     if (result.hasError()) {
         return result;
     }
 
-    // Invalidate cache entries for the affected table.
-    if (impl_->config.cache.enabled) {
-        auto resolved = stmt.resolve();
-        auto tableName = extractTableName(resolved);
-        if (!tableName.empty()) {
-            impl_->cache.invalidateByTable(tableName);
-        }
-    }
+    impl_->invalidate(batch.table());
 
     return result;
 }
@@ -307,17 +577,46 @@ GameResult<uint64_t> DBProxyServer::execute(const PreparedStatement& stmt) {
 // ── queryAsync(PreparedStatement) ───────────────────────────────────────────
 
 std::future<GameResult<QueryResult>> DBProxyServer::queryAsync(const PreparedStatement& stmt) {
-    // Copy the statement for the async lambda.
-    auto stmtCopy = stmt;
-    return std::async(std::launch::async,
-                      [this, stmtCopy = std::move(stmtCopy)]() -> GameResult<QueryResult> {
-                          return query(stmtCopy);
-                      });
+    auto promise = std::make_shared<std::promise<GameResult<QueryResult>>>();
+    auto future = promise->get_future();
+    queryAsync(stmt, [promise](GameResult<QueryResult> result) {
+        promise->set_value(std::move(result));
+    });
+    return future;
+}
+
+void DBProxyServer::queryAsync(const PreparedStatement& stmt, QueryCallback onDone) {
+    const auto start = std::chrono::steady_clock::now();
+    const auto normalized = impl_->normalize(stmt.sql());
+    auto timed = impl_->recording(normalized, start, onDone);
+    auto fetch = [impl = impl_.get(), stmtCopy = stmt] {
+        return impl->poolManager.query(stmtCopy);
+    };
+    impl_->maybeProbeLag();
+    impl_->maybeMaintainPools();
+    if (impl_->readAsync(stmt.resolve(), normalized.read, std::move(fetch), timed)) {
+        return;
+    }
+
+    // Copy the statement for the worker.
+    auto work = [this, stmtCopy = stmt, onDone] { onDone(query(stmtCopy)); };
+    if (!impl_->post(std::move(work))) {
+        onDone(GameResult<QueryResult>::err(
+            GameError(ErrorCode::DBProxyNotStarted, "DBProxy not started")));
+    }
+}
+
+Task<GameResult<QueryResult>> DBProxyServer::queryTask(PreparedStatement stmt) {
+    co_return co_await cgs::foundation::awaitCallback<GameResult<QueryResult>>(
+        [this, &stmt](auto complete) { queryAsync(stmt, std::move(complete)); });
 }
 
 // ── Cache management ────────────────────────────────────────────────────────
 
 std::size_t DBProxyServer::invalidateCache(std::string_view tableName) {
+    if (impl_->shared) {
+        impl_->shared->invalidateTable(tableName);
+    }
     return impl_->cache.invalidateByTable(tableName);
 }
 
@@ -339,9 +638,24 @@ PoolStats DBProxyServer::poolStats() const {
     auto stats = impl_->poolManager.stats();
     stats.cacheEntries = impl_->cache.size();
     stats.cacheHitRate = impl_->cache.hitRate();
+    stats.cacheBytes = impl_->cache.bytes();
+    stats.cacheRejected = impl_->cache.rejectedCount();
+    stats.cacheTableBytes = impl_->cache.tableBytes();
+    stats.coalescedReads = impl_->flights.coalescedCount();
+    if (impl_->shared) {
+        stats.sharedCacheHits = impl_->shared->hitCount();
+        stats.sharedCacheMisses = impl_->shared->missCount();
+        stats.sharedCacheStale = impl_->shared->staleCount();
+    }
+    stats.streams = impl_->streamCount.load(std::memory_order_relaxed);
+    stats.streamedRows = impl_->streamedRowCount.load(std::memory_order_relaxed);
     return stats;
 }
 
+std::vector<QueryShapeStats> DBProxyServer::queryShapes() const {
+    return impl_->shapes.snapshot();
+}
+
 uint64_t DBProxyServer::totalQueries() const {
     return impl_->totalQueryCount.load(std::memory_order_relaxed);
 }
@@ -42,6 +42,26 @@ cgs::service::DBEndpointConfig buildEndpointConfig(const cgs::foundation::Config
         ep.connectionTimeout = std::chrono::seconds(timeout.value());
     }
 
+    auto growAfter = config.get<int>(prefix + ".grow_after_wait_ms");
+    if (growAfter) {
+        ep.growAfterWait = std::chrono::milliseconds(growAfter.value());
+    }
+
+    auto idle = config.get<int>(prefix + ".idle_timeout_seconds");
+    if (idle) {
+        ep.idleTimeout = std::chrono::seconds(idle.value());
+    }
+
+    auto lifetime = config.get<int>(prefix + ".max_lifetime_seconds");
+    if (lifetime) {
+        ep.maxLifetime = std::chrono::seconds(lifetime.value());
+    }
+
+    auto jitter = config.get<double>(prefix + ".pool_jitter");
+    if (jitter) {
+        ep.poolJitter = jitter.value();
+    }
+
     return ep;
 }
 
@@ -71,11 +91,86 @@ cgs::service::DBProxyConfig buildDBProxyConfig(const cgs::foundation::ConfigMana
         cfg.cache.maxEntries = static_cast<std::size_t>(maxEntries.value());
     }
 
+    auto shards = config.get<unsigned int>("dbproxy.cache.shards");
+    if (shards) {
+        cfg.cache.shards = static_cast<std::size_t>(shards.value());
+    }
+
+    auto maxTotalMb = config.get<unsigned int>("dbproxy.cache.max_total_mb");
+    if (maxTotalMb) {
+        cfg.cache.maxTotalBytes = static_cast<std::size_t>(maxTotalMb.value()) << 20;
+    }
+
+    auto admission = config.get<bool>("dbproxy.cache.admission_filter");
+    if (admission) {
+        cfg.cache.admissionFilter = admission.value();
+    }
+
     auto ttl = config.get<int>("dbproxy.cache.default_ttl_seconds");
     if (ttl) {
         cfg.cache.defaultTtl = std::chrono::seconds(ttl.value());
     }
 
+    auto coalesce = config.get<bool>("dbproxy.coalesce_reads");
+    if (coalesce) {
+        cfg.coalesceReads = coalesce.value();
+    }
+
+    auto writeBatch = config.get<bool>("dbproxy.write_batch.enabled");
+    if (writeBatch) {
+        cfg.writeBatch.enabled = writeBatch.value();
+    }
+
+    auto writeWindow = config.get<int>("dbproxy.write_batch.window_ms");
+    if (writeWindow) {
+        cfg.writeBatch.window = std::chrono::milliseconds(writeWindow.value());
+    }
+
+    auto writeStatements = config.get<unsigned int>("dbproxy.write_batch.max_statements");
+    if (writeStatements) {
+        cfg.writeBatch.maxStatements = static_cast<std::size_t>(writeStatements.value());
+    }
+
+    auto normalize = config.get<bool>("dbproxy.normalize_queries");
+    if (normalize) {
+        cfg.normalizeQueries = normalize.value();
+    }
+
+    auto prepare = config.get<bool>("dbproxy.prepare_queries");
+    if (prepare) {
+        cfg.prepareQueries = prepare.value();
+    }
+
+    auto maxShapes = config.get<unsigned int>("dbproxy.max_query_shapes");
+    if (maxShapes) {
+        cfg.maxQueryShapes = static_cast<std::size_t>(maxShapes.value());
+    }
+
+    auto trackLag = config.get<bool>("dbproxy.track_replication_lag");
+    if (trackLag) {
+        cfg.trackReplicationLag = trackLag.value();
+    }
+
+    auto lagProbe = config.get<int>("dbproxy.lag_probe_interval_ms");
+    if (lagProbe) {
+        cfg.lagProbeInterval = std::chrono::milliseconds(lagProbe.value());
+    }
+
+    auto maxLag = config.get<int>("dbproxy.max_replica_lag_ms");
+    if (maxLag) {
+        cfg.maxReplicaLag = std::chrono::milliseconds(maxLag.value());
+    }
+
+    auto rywWindow = config.get<int>("dbproxy.read_your_writes_window_ms");
+    if (rywWindow) {
+        cfg.readYourWritesWindow = std::chrono::milliseconds(rywWindow.value());
+    }
+
+    auto maintenance = config.get<int>("dbproxy.pool_maintenance_interval_ms");
+    if (maintenance) {
+        cfg.poolMaintenanceInterval = std::chrono::milliseconds(maintenance.value());
+    }
+
     auto healthCheck = config.get<int>("dbproxy.health_check_interval_seconds");
     if (healthCheck) {
         cfg.healthCheckInterval = std::chrono::seconds(healthCheck.value());
@@ -1,81 +1,325 @@
 /// @file query_cache.cpp
-/// @brief QueryCache implementation using a doubly-linked list + hash map
-///        for O(1) LRU eviction and lookup.
+/// @brief QueryCache implementation: hash-keyed shards, each a fixed ring of
+///        slots swept by a CLOCK hand under an entry and byte budget, with
+///        a TinyLFU frequency sketch for admission, a table -> slots
+///        index for invalidation, and cache-wide table quotas.
 
 #include "cgs/service/query_cache.hpp"
 
+#include "cgs/foundation/profiled_mutex.hpp"
+
+#include "sql_tables.hpp"
+
 #include <algorithm>
 #include <atomic>
-#include <list>
+#include <bit>
+#include <limits>
 #include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace cgs::service {
 
-// ── Cache entry stored in the LRU list ──────────────────────────────────────
+namespace {
+
+// Small caches keep at least this many entries per shard, so capacity is
+// not split into shards too small to absorb an uneven hash spread.
+constexpr std::size_t kMinShardEntries = 64;
+
+// Entries of a table over its quota compared to pick one to evict.
+constexpr std::size_t kQuotaSample = 8;
+
+// 64-bit hash of the SQL text: picks the shard (high bits) and keys the
+// shard's index (all bits).  FNV-1a, then a MurmurHash3 finalizer, since
+// queries differing only in their last characters (`... WHERE id = 42`)
+// barely change FNV's high bits.
+uint64_t sqlHash(std::string_view sql) noexcept {
+    uint64_t h = 14695981039346656037ull;
+    for (const char c : sql) {
+        h = (h ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+    }
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+// Split @p total over @p count shards, rounding up (no limit stays none).
+std::size_t perShard(std::size_t total, std::size_t count) noexcept {
+    if (total == std::numeric_limits<std::size_t>::max()) {
+        return total;
+    }
+    return total / count + (total % count != 0 ? 1 : 0);
+}
+
+// ── Frequency sketch ────────────────────────────────────────────────────────
+
+// Count-min sketch of how often each query was looked up recently
+// (TinyLFU): four rows of counters saturating at 15, all halved once
+// ten lookups per entry have been recorded, so past popularity fades.
+// Lookups record under the shard's shared lock, so counters are relaxed
+// atomics; a lost race only drops one count.
+class FrequencySketch {
+public:
+    explicit FrequencySketch(std::size_t capacity)
+        : width_(std::bit_ceil(std::max<std::size_t>(capacity, 16))),
+          counters_(std::make_unique<std::atomic<uint8_t>[]>(kDepth * width_)),
+          sampleSize_(10 * std::max<std::size_t>(capacity, 1)) {}
+
+    void increment(uint64_t hash) noexcept {
+        for (std::size_t row = 0; row < kDepth; ++row) {
+            auto& counter = counters_[index(hash, row)];
+            auto value = counter.load(std::memory_order_relaxed);
+            while (value < kMaxCount &&
+                   !counter.compare_exchange_weak(value,
+                                                  static_cast<uint8_t>(value + 1),
+                                                  std::memory_order_relaxed)) {
+            }
+        }
+        additions_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] uint8_t estimate(uint64_t hash) const noexcept {
+        uint8_t count = kMaxCount;
+        for (std::size_t row = 0; row < kDepth; ++row) {
+            count = std::min(count, counters_[index(hash, row)].load(std::memory_order_relaxed));
+        }
+        return count;
+    }
+
+    // Halve every counter once the sample is full.  Caller holds the
+    // unique lock.
+    void ageIfDue() noexcept {
+        if (additions_.load(std::memory_order_relaxed) < sampleSize_) {
+            return;
+        }
+        for (std::size_t i = 0; i < kDepth * width_; ++i) {
+            const auto value = counters_[i].load(std::memory_order_relaxed);
+            counters_[i].store(static_cast<uint8_t>(value / 2), std::memory_order_relaxed);
+        }
+        additions_.store(sampleSize_ / 2, std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr std::size_t kDepth = 4;
+    static constexpr uint8_t kMaxCount = 15;
+    static constexpr uint64_t kSeeds[kDepth] = {
+        0xc3a5c85c97cb3127ull, 0xb492b66fbe98f273ull, 0x9ae16a3b2f90404full, 0xcbf29ce484222325ull};
+
+    [[nodiscard]] std::size_t index(uint64_t hash, std::size_t row) const noexcept {
+        const auto h = static_cast<std::size_t>((hash * kSeeds[row]) >> 32);
+        return row * width_ + (h & (width_ - 1));
+    }
+
+    std::size_t width_;
+    std::unique_ptr<std::atomic<uint8_t>[]> counters_;
+    std::size_t sampleSize_;
+    std::atomic<std::size_t> additions_{0};
+};
+
+// ── Table quota ─────────────────────────────────────────────────────────────
+
+// Cache-wide byte quota of one table.  Shards charge it before storing an
+// entry that reads the table and refund it on release.
+struct TableQuota {
+    std::size_t limit = 0;
+    std::atomic<std::size_t> used{0};
 
-struct CacheEntry {
+    // Reserve @p bytes if they fit under the limit.
+    bool tryCharge(std::size_t bytes) noexcept {
+        auto current = used.load(std::memory_order_relaxed);
+        while (current + bytes <= limit) {
+            if (used.compare_exchange_weak(current, current + bytes, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void refund(std::size_t bytes) noexcept { used.fetch_sub(bytes, std::memory_order_relaxed); }
+};
+
+// Normalized table name -> quota.  Built once; only the counters change.
+using TableQuotas = std::unordered_map<std::string, TableQuota>;
+
+// ── Cache slot ──────────────────────────────────────────────────────────────
+
+struct Slot {
+    uint64_t hash = 0;
     std::string sql;
     cgs::foundation::QueryResult result;
     std::chrono::steady_clock::time_point expiresAt;
+    std::vector<std::string> tables;  // Normalized tables the query reads.
+    std::size_t bytes = 0;            // Result plus SQL text.
+    bool used = false;
+
+    // Set by hits under the shared lock; cleared by the CLOCK hand.
+    std::atomic<bool> referenced{false};
 };
 
+// ── Shard ───────────────────────────────────────────────────────────────────
+
+struct Shard {
+    Shard(std::size_t capacity, std::size_t byteBudget, TableQuotas& quotas)
+        : slots(std::make_unique<Slot[]>(capacity)),
+          capacity(capacity),
+          byteBudget(byteBudget),
+          quotas(quotas),
+          sketch(capacity) {
+        // Hand out slots in ring order: 0 first.
+        freeSlots.reserve(capacity);
+        for (std::size_t i = capacity; i > 0; --i) {
+            freeSlots.push_back(static_cast<uint32_t>(i - 1));
+        }
+    }
+
+    mutable cgs::foundation::ProfiledSharedMutex mutex{"dbproxy.query_cache"};
+
+    std::unique_ptr<Slot[]> slots;
+    std::size_t capacity;
+    std::size_t hand = 0;
+    std::vector<uint32_t> freeSlots;
+
+    std::size_t bytes = 0;
+    std::size_t byteBudget;
+    TableQuotas& quotas;
+
+    FrequencySketch sketch;
+
+    // SQL hash -> slot.  A colliding query replaces the cached one.
+    std::unordered_map<uint64_t, uint32_t> index;
+
+    // Table name -> slots depending on it.
+    std::unordered_map<std::string, std::unordered_set<uint32_t>> byTable;
+
+    // Slot caching @p sql, or nullptr.  Caller holds either lock.
+    Slot* find(uint64_t hash, std::string_view sql) const {
+        auto it = index.find(hash);
+        if (it == index.end() || slots[it->second].sql != sql) {
+            return nullptr;
+        }
+        return &slots[it->second];
+    }
+
+    // Empty slot @p i and return it to the free list.  Caller holds the
+    // unique lock.
+    void release(uint32_t i) {
+        auto& slot = slots[i];
+        for (const auto& table : slot.tables) {
+            auto deps = byTable.find(table);
+            deps->second.erase(i);
+            if (deps->second.empty()) {
+                byTable.erase(deps);
+            }
+            if (auto quota = quotas.find(table); quota != quotas.end()) {
+                quota->second.refund(slot.bytes);
+            }
+        }
+        index.erase(slot.hash);
+        bytes -= slot.bytes;
+        slot.sql.clear();
+        slot.result = {};
+        slot.tables.clear();
+        slot.bytes = 0;
+        slot.used = false;
+        freeSlots.push_back(i);
+    }
+
+    // Next CLOCK victim: the first used slot that is expired or was not
+    // referenced since the hand last passed.  Caller holds the unique
+    // lock; at least one slot is used, so the sweep ends within two turns.
+    uint32_t clockVictim(std::chrono::steady_clock::time_point now) {
+        for (;;) {
+            const auto i = static_cast<uint32_t>(hand);
+            hand = (hand + 1) % capacity;
+            auto& slot = slots[i];
+            if (!slot.used || (slot.expiresAt > now &&
+                               slot.referenced.exchange(false, std::memory_order_relaxed))) {
+                continue;  // Free, or given a second chance.
+            }
+            return i;
+        }
+    }
+
+    // Coldest of a few entries reading @p table: an expired one, else the
+    // least frequently looked up.  Caller holds the unique lock; the table
+    // has entries.
+    uint32_t tableVictim(const std::string& table, std::chrono::steady_clock::time_point now) const {
+        const auto& deps = byTable.at(table);
+        uint32_t victim = *deps.begin();
+        int coldest = std::numeric_limits<int>::max();
+        std::size_t sampled = 0;
+        for (const uint32_t i : deps) {
+            const int heat = slots[i].expiresAt <= now ? -1 : sketch.estimate(slots[i].hash);
+            if (heat < coldest) {
+                coldest = heat;
+                victim = i;
+            }
+            if (++sampled == kQuotaSample) {
+                break;
+            }
+        }
+        return victim;
+    }
+
+    // TinyLFU admission: a candidate looked up @p frequency times may only
+    // displace a live entry that is no more popular.
+    bool mayEvict(uint32_t victim,
+                  uint8_t frequency,
+                  bool filter,
+                  std::chrono::steady_clock::time_point now) const {
+        const auto& slot = slots[victim];
+        return !filter || slot.expiresAt <= now || sketch.estimate(slot.hash) <= frequency;
+    }
+};
+
+}  // anonymous namespace
+
 // ── Impl ────────────────────────────────────────────────────────────────────
 
 struct QueryCache::Impl {
     CacheConfig config;
 
-    // LRU list: front = most recently used, back = least recently used.
-    std::list<CacheEntry> lruList;
-
-    // Map from SQL key to iterator into the LRU list for O(1) lookup.
-    std::unordered_map<std::string, std::list<CacheEntry>::iterator> index;
-
-    mutable std::mutex mutex;
+    // Declared before shards, which refer to it, so it outlives them.
+    TableQuotas quotas;
+    std::vector<std::unique_ptr<Shard>> shards;
 
     std::atomic<uint64_t> hits{0};
     std::atomic<uint64_t> misses{0};
+    std::atomic<uint64_t> rejected{0};
 
-    // Move an entry to the front of the LRU list.
-    void touch(std::list<CacheEntry>::iterator it) { lruList.splice(lruList.begin(), lruList, it); }
-
-    // Evict the least recently used entry.
-    void evictLru() {
-        if (lruList.empty()) {
-            return;
+    explicit Impl(CacheConfig cfg) : config(std::move(cfg)) {
+        const std::size_t count = std::clamp<std::size_t>(
+            config.shards, 1, std::max<std::size_t>(config.maxEntries / kMinShardEntries, 1));
+        for (const auto& [table, limit] : config.tableQuotaBytes) {
+            quotas[detail::normalizeTableName(table)].limit = limit;
         }
-        auto& back = lruList.back();
-        index.erase(back.sql);
-        lruList.pop_back();
-    }
-
-    // Remove expired entries from the back of the list.
-    void evictExpired() {
-        auto now = std::chrono::steady_clock::now();
-
-        // Walk from the back (least recently used) and remove expired.
-        auto it = lruList.end();
-        while (it != lruList.begin()) {
-            --it;
-            if (it->expiresAt <= now) {
-                auto toRemove = it;
-                it = std::next(it) == lruList.end() ? lruList.begin() : std::next(it);
-                index.erase(toRemove->sql);
-                lruList.erase(toRemove);
-                if (it == lruList.begin()) {
-                    break;
-                }
-            }
+
+        // The byte budget is split evenly across shards.
+        const std::size_t totalBytes = config.maxTotalBytes == 0
+                                           ? std::numeric_limits<std::size_t>::max()
+                                           : config.maxTotalBytes;
+
+        // Split maxEntries exactly: the first shards take the remainder.
+        for (std::size_t i = 0; i < count; ++i) {
+            const std::size_t capacity =
+                config.maxEntries / count + (i < config.maxEntries % count ? 1 : 0);
+            shards.push_back(
+                std::make_unique<Shard>(capacity, perShard(totalBytes, count), quotas));
         }
     }
+
+    Shard& shardOf(uint64_t hash) const { return *shards[(hash >> 32) % shards.size()]; }
 };
 
 // ── Construction / destruction / move ───────────────────────────────────────
 
-QueryCache::QueryCache(CacheConfig config) : impl_(std::make_unique<Impl>()) {
-    impl_->config = std::move(config);
-}
+QueryCache::QueryCache(CacheConfig config) : impl_(std::make_unique<Impl>(std::move(config))) {}
 
 QueryCache::~QueryCache() = default;
 
@@ -85,28 +329,23 @@ QueryCache& QueryCache::operator=(QueryCache&&) noexcept = default;
 // ── get() ───────────────────────────────────────────────────────────────────
 
 std::optional<cgs::foundation::QueryResult> QueryCache::get(std::string_view sql) {
-    std::lock_guard lock(impl_->mutex);
-
-    auto it = impl_->index.find(std::string(sql));
-    if (it == impl_->index.end()) {
-        impl_->misses.fetch_add(1, std::memory_order_relaxed);
-        return std::nullopt;
-    }
+    const auto hash = sqlHash(sql);
+    auto& shard = impl_->shardOf(hash);
+    std::shared_lock lock(shard.mutex);
 
-    auto listIt = it->second;
+    // Hits and misses both count towards the query's admission frequency.
+    shard.sketch.increment(hash);
 
-    // Check TTL expiration.
-    if (listIt->expiresAt <= std::chrono::steady_clock::now()) {
-        impl_->lruList.erase(listIt);
-        impl_->index.erase(it);
+    // An expired entry is left for the CLOCK hand to reclaim.
+    auto* slot = shard.find(hash, sql);
+    if (slot == nullptr || slot->expiresAt <= std::chrono::steady_clock::now()) {
         impl_->misses.fetch_add(1, std::memory_order_relaxed);
         return std::nullopt;
     }
 
-    // Move to front (most recently used).
-    impl_->touch(listIt);
+    slot->referenced.store(true, std::memory_order_relaxed);
     impl_->hits.fetch_add(1, std::memory_order_relaxed);
-    return listIt->result;
+    return slot->result;
 }
 
 // ── put() ───────────────────────────────────────────────────────────────────
@@ -118,105 +357,170 @@ void QueryCache::put(std::string_view sql, const cgs::foundation::QueryResult& r
 void QueryCache::put(std::string_view sql,
                      const cgs::foundation::QueryResult& result,
                      std::chrono::seconds ttl) {
-    std::lock_guard lock(impl_->mutex);
-
-    auto key = std::string(sql);
-
-    // If key already exists, update in place.
-    auto it = impl_->index.find(key);
-    if (it != impl_->index.end()) {
-        auto listIt = it->second;
-        listIt->result = result;
-        listIt->expiresAt = std::chrono::steady_clock::now() + ttl;
-        impl_->touch(listIt);
+    const auto hash = sqlHash(sql);
+    auto& shard = impl_->shardOf(hash);
+    if (shard.capacity == 0) {
         return;
     }
-
-    // Evict if at capacity.
-    if (impl_->lruList.size() >= impl_->config.maxEntries) {
-        impl_->evictLru();
+    const std::size_t bytes = result.memoryBytes() + sql.size();
+    if (bytes > impl_->config.maxValueSizeBytes || bytes > shard.byteBudget) {
+        impl_->rejected.fetch_add(1, std::memory_order_relaxed);
+        return;
     }
+    auto tables = detail::extractQueryTables(sql);
+    const auto now = std::chrono::steady_clock::now();
+
+    std::unique_lock lock(shard.mutex);
+    shard.sketch.ageIfDue();
+
+    // A cached query being refreshed (or a different query with the same
+    // hash) gives up its slot first.  A refresh skips admission: the entry
+    // already earned its place.
+    bool refresh = false;
+    if (auto it = shard.index.find(hash); it != shard.index.end()) {
+        refresh = shard.slots[it->second].sql == sql;
+        shard.release(it->second);
+    }
+    const bool filter = impl_->config.admissionFilter && !refresh;
+    const auto frequency = shard.sketch.estimate(hash);
 
-    // Insert at front.
-    CacheEntry entry;
-    entry.sql = key;
-    entry.result = result;
-    entry.expiresAt = std::chrono::steady_clock::now() + ttl;
+    std::vector<TableQuota*> charged;
+    auto refuse = [&] {
+        for (auto* quota : charged) {
+            quota->refund(bytes);
+        }
+        impl_->rejected.fetch_add(1, std::memory_order_relaxed);
+    };
+
+    // Charge each quota the query counts against, evicting this shard's
+    // entries of the table while it is over...
+    for (const auto& table : tables) {
+        auto quota = impl_->quotas.find(table);
+        if (quota == impl_->quotas.end()) {
+            continue;
+        }
+        if (bytes > quota->second.limit) {
+            refuse();
+            return;
+        }
+        while (!quota->second.tryCharge(bytes)) {
+            if (!shard.byTable.contains(table)) {
+                refuse();  // The table's bytes are cached by other shards.
+                return;
+            }
+            const uint32_t victim = shard.tableVictim(table, now);
+            if (!shard.mayEvict(victim, frequency, filter, now)) {
+                refuse();
+                return;
+            }
+            shard.release(victim);
+        }
+        charged.push_back(&quota->second);
+    }
+    // ...then make room under the shard's entry and byte budgets.
+    while (shard.freeSlots.empty() || shard.bytes + bytes > shard.byteBudget) {
+        const uint32_t victim = shard.clockVictim(now);
+        if (!shard.mayEvict(victim, frequency, filter, now)) {
+            refuse();
+            return;
+        }
+        shard.release(victim);
+    }
 
-    impl_->lruList.push_front(std::move(entry));
-    impl_->index[key] = impl_->lruList.begin();
+    const uint32_t i = shard.freeSlots.back();
+    shard.freeSlots.pop_back();
+    auto& slot = shard.slots[i];
+    slot.hash = hash;
+    slot.sql = std::string(sql);
+    slot.result = result;
+    slot.expiresAt = now + ttl;
+    slot.tables = std::move(tables);
+    slot.bytes = bytes;
+    slot.used = true;
+    slot.referenced.store(refresh, std::memory_order_relaxed);
+
+    shard.index.emplace(hash, i);
+    shard.bytes += bytes;
+    for (const auto& table : slot.tables) {
+        shard.byTable[table].insert(i);
+    }
 }
 
 // ── invalidate() ────────────────────────────────────────────────────────────
 
 bool QueryCache::invalidate(std::string_view sql) {
-    std::lock_guard lock(impl_->mutex);
+    const auto hash = sqlHash(sql);
+    auto& shard = impl_->shardOf(hash);
+    std::unique_lock lock(shard.mutex);
 
-    auto it = impl_->index.find(std::string(sql));
-    if (it == impl_->index.end()) {
+    if (shard.find(hash, sql) == nullptr) {
         return false;
     }
-
-    impl_->lruList.erase(it->second);
-    impl_->index.erase(it);
+    shard.release(shard.index.at(hash));
     return true;
 }
 
 // ── invalidateByTable() ─────────────────────────────────────────────────────
 
 std::size_t QueryCache::invalidateByTable(std::string_view tableName) {
-    std::lock_guard lock(impl_->mutex);
+    const auto table = detail::normalizeTableName(tableName);
 
     std::size_t count = 0;
+    for (auto& shard : impl_->shards) {
+        std::unique_lock lock(shard->mutex);
 
-    for (auto it = impl_->lruList.begin(); it != impl_->lruList.end();) {
-        // Case-insensitive substring search for the table name in the SQL.
-        // This is conservative: may invalidate queries that merely mention
-        // the table name in comments or string literals, but guarantees
-        // we never serve stale data.
-        bool found = false;
-        const auto& sql = it->sql;
-
-        // Simple case-insensitive search.
-        auto sqlLower = sql;
-        auto tableLower = std::string(tableName);
-        std::transform(sqlLower.begin(), sqlLower.end(), sqlLower.begin(), [](unsigned char c) {
-            return std::tolower(c);
-        });
-        std::transform(
-            tableLower.begin(), tableLower.end(), tableLower.begin(), [](unsigned char c) {
-                return std::tolower(c);
-            });
-
-        if (sqlLower.find(tableLower) != std::string::npos) {
-            found = true;
+        auto deps = shard->byTable.find(table);
+        if (deps == shard->byTable.end()) {
+            continue;
         }
 
-        if (found) {
-            impl_->index.erase(it->sql);
-            it = impl_->lruList.erase(it);
-            ++count;
-        } else {
-            ++it;
+        // release() edits the set being walked, so copy it first.
+        const std::vector<uint32_t> slots(deps->second.begin(), deps->second.end());
+        for (const uint32_t i : slots) {
+            shard->release(i);
         }
+        count += slots.size();
     }
-
     return count;
 }
 
 // ── clear() ─────────────────────────────────────────────────────────────────
 
 void QueryCache::clear() {
-    std::lock_guard lock(impl_->mutex);
-    impl_->lruList.clear();
-    impl_->index.clear();
+    for (auto& shard : impl_->shards) {
+        std::unique_lock lock(shard->mutex);
+        while (!shard->index.empty()) {
+            shard->release(shard->index.begin()->second);
+        }
+    }
 }
 
 // ── Accessors ───────────────────────────────────────────────────────────────
 
 std::size_t QueryCache::size() const {
-    std::lock_guard lock(impl_->mutex);
-    return impl_->lruList.size();
+    std::size_t total = 0;
+    for (const auto& shard : impl_->shards) {
+        std::shared_lock lock(shard->mutex);
+        total += shard->index.size();
+    }
+    return total;
+}
+
+std::size_t QueryCache::bytes() const {
+    std::size_t total = 0;
+    for (const auto& shard : impl_->shards) {
+        std::shared_lock lock(shard->mutex);
+        total += shard->bytes;
+    }
+    return total;
+}
+
+std::unordered_map<std::string, std::size_t> QueryCache::tableBytes() const {
+    std::unordered_map<std::string, std::size_t> usage;
+    for (const auto& [table, quota] : impl_->quotas) {
+        usage.emplace(table, quota.used.load(std::memory_order_relaxed));
+    }
+    return usage;
 }
 
 uint64_t QueryCache::hitCount() const {
@@ -227,6 +531,10 @@ uint64_t QueryCache::missCount() const {
     return impl_->misses.load(std::memory_order_relaxed);
 }
 
+uint64_t QueryCache::rejectedCount() const {
+    return impl_->rejected.load(std::memory_order_relaxed);
+}
+
 double QueryCache::hitRate() const {
     auto h = impl_->hits.load(std::memory_order_relaxed);
     auto m = impl_->misses.load(std::memory_order_relaxed);
@@ -0,0 +1,144 @@
+/// @file query_shape_registry.cpp
+/// @brief QueryShapeRegistry implementation: fingerprint-keyed entries of
+///        atomic counters behind a shared mutex.
+
+#include "cgs/service/query_shape_registry.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace cgs::service {
+
+namespace {
+
+constexpr std::string_view kOtherShape = "(other)";
+
+struct Entry {
+    std::string shape;
+    std::atomic<uint64_t> count{0};
+    std::atomic<int64_t> totalNs{0};
+    std::atomic<int64_t> maxNs{0};
+
+    void add(int64_t ns) {
+        count.fetch_add(1, std::memory_order_relaxed);
+        totalNs.fetch_add(ns, std::memory_order_relaxed);
+        auto seen = maxNs.load(std::memory_order_relaxed);
+        while (ns > seen && !maxNs.compare_exchange_weak(seen, ns, std::memory_order_relaxed)) {
+        }
+    }
+};
+
+double toMs(int64_t ns) {
+    return static_cast<double>(ns) / 1e6;
+}
+
+}  // anonymous namespace
+
+// ── Impl ────────────────────────────────────────────────────────────────────
+
+struct QueryShapeRegistry::Impl {
+    std::size_t maxShapes;
+
+    mutable std::shared_mutex mutex;
+    std::unordered_map<uint64_t, std::unique_ptr<Entry>> shapes;
+    Entry other;  // Shapes past maxShapes.
+
+    explicit Impl(std::size_t max) : maxShapes(max) { other.shape = kOtherShape; }
+
+    // Count @p ns for @p fingerprint under the lock, so clear() cannot
+    // free the entry meanwhile.  A new shape takes the unique lock once.
+    void record(uint64_t fingerprint, std::string_view shape, int64_t ns) {
+        {
+            std::shared_lock lock(mutex);
+            if (auto it = shapes.find(fingerprint); it != shapes.end()) {
+                it->second->add(ns);
+                return;
+            }
+            if (shapes.size() >= maxShapes) {
+                other.add(ns);
+                return;
+            }
+        }
+        std::unique_lock lock(mutex);
+        auto [it, inserted] = shapes.try_emplace(fingerprint);
+        if (inserted) {
+            if (shapes.size() > maxShapes) {
+                shapes.erase(it);
+                other.add(ns);
+                return;
+            }
+            it->second = std::make_unique<Entry>();
+            it->second->shape = std::string(shape);
+        }
+        it->second->add(ns);
+    }
+};
+
+// ── Construction / destruction / move ───────────────────────────────────────
+
+QueryShapeRegistry::QueryShapeRegistry(std::size_t maxShapes)
+    : impl_(std::make_unique<Impl>(maxShapes)) {}
+
+QueryShapeRegistry::~QueryShapeRegistry() = default;
+
+QueryShapeRegistry::QueryShapeRegistry(QueryShapeRegistry&&) noexcept = default;
+QueryShapeRegistry& QueryShapeRegistry::operator=(QueryShapeRegistry&&) noexcept = default;
+
+// ── record() ────────────────────────────────────────────────────────────────
+
+void QueryShapeRegistry::record(uint64_t fingerprint,
+                                std::string_view shape,
+                                std::chrono::nanoseconds latency) {
+    impl_->record(fingerprint, shape, std::max<int64_t>(latency.count(), 0));
+}
+
+// ── snapshot() ──────────────────────────────────────────────────────────────
+
+std::vector<QueryShapeStats> QueryShapeRegistry::snapshot() const {
+    std::vector<QueryShapeStats> out;
+    auto add = [&out](uint64_t fingerprint, const Entry& entry) {
+        QueryShapeStats stats;
+        stats.fingerprint = fingerprint;
+        stats.shape = entry.shape;
+        stats.count = entry.count.load(std::memory_order_relaxed);
+        stats.totalMs = toMs(entry.totalNs.load(std::memory_order_relaxed));
+        stats.maxMs = toMs(entry.maxNs.load(std::memory_order_relaxed));
+        out.push_back(std::move(stats));
+    };
+    {
+        std::shared_lock lock(impl_->mutex);
+        out.reserve(impl_->shapes.size() + 1);
+        for (const auto& [fingerprint, entry] : impl_->shapes) {
+            add(fingerprint, *entry);
+        }
+        if (impl_->other.count.load(std::memory_order_relaxed) > 0) {
+            add(0, impl_->other);
+        }
+    }
+
+    std::sort(out.begin(), out.end(), [](const QueryShapeStats& a, const QueryShapeStats& b) {
+        return a.totalMs > b.totalMs;
+    });
+    return out;
+}
+
+// ── Accessors ───────────────────────────────────────────────────────────────
+
+std::size_t QueryShapeRegistry::size() const {
+    std::shared_lock lock(impl_->mutex);
+    return impl_->shapes.size();
+}
+
+void QueryShapeRegistry::clear() {
+    std::unique_lock lock(impl_->mutex);
+    impl_->shapes.clear();
+    impl_->other.count.store(0, std::memory_order_relaxed);
+    impl_->other.totalNs.store(0, std::memory_order_relaxed);
+    impl_->other.maxNs.store(0, std::memory_order_relaxed);
+}
+
+}  // namespace cgs::service
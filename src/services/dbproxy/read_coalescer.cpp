@@ -0,0 +1,214 @@
+/// @file read_coalescer.cpp
+/// @brief ReadCoalescer implementation: a map of in-flight reads keyed by
+///        normalized SQL, each completed once for all its waiters.
+
+#include "cgs/service/read_coalescer.hpp"
+
+#include "cgs/foundation/error_code.hpp"
+#include "cgs/foundation/game_error.hpp"
+
+#include "sql_tables.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace cgs::service {
+
+using cgs::foundation::ErrorCode;
+using cgs::foundation::GameError;
+using cgs::foundation::QueryCallback;
+
+namespace {
+
+// One fetch and the reads waiting for it.
+struct Flight {
+    std::string sql;                  // Leader's statement, handed to store.
+    std::vector<std::string> tables;  // Normalized tables it reads.
+
+    std::promise<ReadCoalescer::Result> done;
+    std::shared_future<ReadCoalescer::Result> result = done.get_future().share();
+
+    // Guarded by ReadCoalescer::Impl::mutex.
+    std::vector<QueryCallback> callbacks;  // Asynchronous waiters.
+    bool detached = false;                 // A write invalidated the read.
+};
+
+}  // anonymous namespace
+
+// ── Impl ────────────────────────────────────────────────────────────────────
+
+struct ReadCoalescer::Impl {
+    Post post;
+    Store store;
+
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, std::shared_ptr<Flight>> flights;
+
+    std::atomic<uint64_t> coalesced{0};
+
+    Impl(Post p, Store s) : post(std::move(p)), store(std::move(s)) {}
+
+    std::shared_ptr<Flight> makeFlight(std::string_view sql) {
+        auto flight = std::make_shared<Flight>();
+        flight->sql = std::string(sql);
+        flight->tables = detail::extractQueryTables(sql);
+        return flight;
+    }
+
+    // Run the leader's fetch; a throwing fetch still completes the waiters.
+    static Result fetchOnce(const Fetch& fetch) {
+        try {
+            return fetch();
+        } catch (const std::exception& e) {
+            return Result::err(GameError(ErrorCode::DBProxyError, e.what()));
+        }
+    }
+
+    // Complete @p flight with @p result.  Asynchronous waiters run inline
+    // when the leader is itself posted work (@p posted), else are posted.
+    void land(const std::string& key,
+              const std::shared_ptr<Flight>& flight,
+              const Result& result,
+              bool posted) {
+        std::vector<QueryCallback> callbacks;
+        {
+            // Stored under the lock, so a write's invalidateTable() either
+            // detaches the flight first or runs after the store and is
+            // followed by the write's cache invalidation.
+            std::lock_guard lock(mutex);
+            if (!flight->detached) {
+                if (result.hasValue() && store) {
+                    store(flight->sql, result.value());
+                }
+                flights.erase(key);
+            }
+            callbacks.swap(flight->callbacks);
+        }
+        flight->done.set_value(result);
+
+        for (auto& onDone : callbacks) {
+            if (posted || !post || !post([onDone, result] { onDone(result); })) {
+                onDone(result);
+            }
+        }
+    }
+};
+
+// ── Construction / destruction / move ───────────────────────────────────────
+
+ReadCoalescer::ReadCoalescer(Post post, Store store)
+    : impl_(std::make_unique<Impl>(std::move(post), std::move(store))) {}
+
+ReadCoalescer::~ReadCoalescer() = default;
+
+ReadCoalescer::ReadCoalescer(ReadCoalescer&&) noexcept = default;
+ReadCoalescer& ReadCoalescer::operator=(ReadCoalescer&&) noexcept = default;
+
+// ── read() ──────────────────────────────────────────────────────────────────
+
+ReadCoalescer::Result ReadCoalescer::read(std::string_view sql, const Fetch& fetch) {
+    auto key = normalize(sql);
+    auto flight = impl_->makeFlight(sql);
+    {
+        std::unique_lock lock(impl_->mutex);
+        if (auto it = impl_->flights.find(key); it != impl_->flights.end()) {
+            auto result = it->second->result;
+            lock.unlock();
+            impl_->coalesced.fetch_add(1, std::memory_order_relaxed);
+            return result.get();
+        }
+        impl_->flights.emplace(key, flight);
+    }
+
+    auto result = Impl::fetchOnce(fetch);
+    impl_->land(key, flight, result, false);
+    return result;
+}
+
+// ── readAsync() ─────────────────────────────────────────────────────────────
+
+void ReadCoalescer::readAsync(std::string_view sql, Fetch fetch, QueryCallback onDone) {
+    auto key = normalize(sql);
+    auto flight = impl_->makeFlight(sql);
+    {
+        std::lock_guard lock(impl_->mutex);
+        if (auto it = impl_->flights.find(key); it != impl_->flights.end()) {
+            it->second->callbacks.push_back(std::move(onDone));
+            impl_->coalesced.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        flight->callbacks.push_back(std::move(onDone));
+        impl_->flights.emplace(key, flight);
+    }
+
+    std::function<void()> job = [impl = impl_.get(), key, flight, fetch = std::move(fetch)] {
+        impl->land(key, flight, Impl::fetchOnce(fetch), true);
+    };
+    if (!impl_->post || !impl_->post(job)) {
+        job();
+    }
+}
+
+// ── invalidateTable() ───────────────────────────────────────────────────────
+
+std::size_t ReadCoalescer::invalidateTable(std::string_view table) {
+    const auto name = detail::normalizeTableName(table);
+
+    std::lock_guard lock(impl_->mutex);
+    std::size_t count = 0;
+    for (auto it = impl_->flights.begin(); it != impl_->flights.end();) {
+        const auto& tables = it->second->tables;
+        if (std::find(tables.begin(), tables.end(), name) == tables.end()) {
+            ++it;
+            continue;
+        }
+        it->second->detached = true;
+        it = impl_->flights.erase(it);
+        ++count;
+    }
+    return count;
+}
+
+// ── Accessors ───────────────────────────────────────────────────────────────
+
+uint64_t ReadCoalescer::coalescedCount() const {
+    return impl_->coalesced.load(std::memory_order_relaxed);
+}
+
+std::size_t ReadCoalescer::inFlight() const {
+    std::lock_guard lock(impl_->mutex);
+    return impl_->flights.size();
+}
+
+std::string ReadCoalescer::normalize(std::string_view sql) {
+    std::string out;
+    out.reserve(sql.size());
+    bool quoted = false;
+    bool space = false;
+    for (const char c : sql) {
+        if (quoted) {
+            out.push_back(c);
+            quoted = c != '\'';  // A doubled quote reopens on the next char.
+            continue;
+        }
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            space = true;
+            continue;
+        }
+        if (space && !out.empty()) {
+            out.push_back(' ');
+        }
+        space = false;
+        out.push_back(c);
+        quoted = c == '\'';
+    }
+    return out;
+}
+
+}  // namespace cgs::service
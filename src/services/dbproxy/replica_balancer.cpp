@@ -0,0 +1,184 @@
+/// @file replica_balancer.cpp
+/// @brief ReplicaBalancer implementation: per-replica atomic peak-EWMA
+///        cost and load counters, sampled two at a time.
+
+#include "cgs/service/replica_balancer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <random>
+
+namespace cgs::service {
+
+namespace {
+
+// Cost added per read that failed, in milliseconds.
+constexpr double kFailureCostMs = 1000.0;
+
+// Floor added to the latency so unmeasured replicas rank by load.
+constexpr double kLatencyFloorMs = 0.001;
+
+struct Replica {
+    std::atomic<double> costMs{0.0};
+    std::atomic<int64_t> stampNs{0};  // Last cost update, steady clock.
+    std::atomic<uint32_t> inFlight{0};
+    std::atomic<int64_t> lagMs{0};
+    std::atomic<uint64_t> reads{0};
+    std::atomic<uint64_t> failures{0};
+};
+
+int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+}  // anonymous namespace
+
+// ── Impl ────────────────────────────────────────────────────────────────────
+
+struct ReplicaBalancer::Impl {
+    std::unique_ptr<Replica[]> replicas;
+    std::size_t count;
+    double decayNs;
+
+    Impl(std::size_t n, std::chrono::milliseconds decay)
+        : replicas(std::make_unique<Replica[]>(n)),
+          count(n),
+          decayNs(static_cast<double>(
+              std::max<int64_t>(std::chrono::nanoseconds(decay).count(), 1))) {}
+
+    // Weight left to a cost last updated at @p stamp.
+    [[nodiscard]] double weight(int64_t stamp, int64_t now) const {
+        return std::exp(-static_cast<double>(std::max<int64_t>(now - stamp, 0)) / decayNs);
+    }
+
+    [[nodiscard]] double latencyMs(const Replica& r, int64_t now) const {
+        return r.costMs.load(std::memory_order_relaxed) *
+               weight(r.stampNs.load(std::memory_order_relaxed), now);
+    }
+
+    [[nodiscard]] double score(const Replica& r, int64_t now) const {
+        const auto load = r.inFlight.load(std::memory_order_relaxed);
+        return (latencyMs(r, now) + kLatencyFloorMs) * static_cast<double>(load + 1);
+    }
+};
+
+// ── Construction / destruction / move ───────────────────────────────────────
+
+ReplicaBalancer::ReplicaBalancer(std::size_t replicas, std::chrono::milliseconds decay)
+    : impl_(std::make_unique<Impl>(replicas, decay)) {}
+
+ReplicaBalancer::~ReplicaBalancer() = default;
+
+ReplicaBalancer::ReplicaBalancer(ReplicaBalancer&&) noexcept = default;
+ReplicaBalancer& ReplicaBalancer::operator=(ReplicaBalancer&&) noexcept = default;
+
+// ── pick() ──────────────────────────────────────────────────────────────────
+
+std::size_t ReplicaBalancer::pick(const std::function<bool(std::size_t)>& usable) const {
+    std::size_t candidates = 0;
+    for (std::size_t i = 0; i < impl_->count; ++i) {
+        if (usable(i)) {
+            ++candidates;
+        }
+    }
+    if (candidates == 0) {
+        return npos;
+    }
+
+    // Two distinct ranks among the usable replicas (one if only one is).
+    thread_local std::minstd_rand rng{std::random_device{}()};
+    std::size_t first = 0;
+    std::size_t second = 0;
+    if (candidates > 1) {
+        first = static_cast<std::size_t>(rng()) % candidates;
+        second = static_cast<std::size_t>(rng()) % (candidates - 1);
+        if (second >= first) {
+            ++second;
+        }
+    }
+
+    std::size_t a = npos;
+    std::size_t b = npos;
+    for (std::size_t i = 0, rank = 0; i < impl_->count && (a == npos || b == npos); ++i) {
+        if (!usable(i)) {
+            continue;
+        }
+        a = rank == first ? i : a;
+        b = rank == second ? i : b;
+        ++rank;
+    }
+    // A replica may have dropped out between the passes.
+    if (a == npos || b == npos) {
+        return a == npos ? b : a;
+    }
+
+    const auto now = nowNs();
+    return impl_->score(impl_->replicas[b], now) < impl_->score(impl_->replicas[a], now) ? b : a;
+}
+
+// ── Read accounting ─────────────────────────────────────────────────────────
+
+void ReplicaBalancer::begin(std::size_t replica) {
+    auto& r = impl_->replicas[replica];
+    r.inFlight.fetch_add(1, std::memory_order_relaxed);
+    r.reads.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ReplicaBalancer::finish(std::size_t replica, std::chrono::nanoseconds latency, bool ok) {
+    auto& r = impl_->replicas[replica];
+    r.inFlight.fetch_sub(1, std::memory_order_relaxed);
+
+    double sample = std::chrono::duration<double, std::milli>(latency).count();
+    if (!ok) {
+        r.failures.fetch_add(1, std::memory_order_relaxed);
+        sample = std::max(sample, kFailureCostMs);
+    }
+
+    // Peak EWMA.  Concurrent completions may drop a sample, which only
+    // delays convergence.
+    const auto now = nowNs();
+    const double w = impl_->weight(r.stampNs.load(std::memory_order_relaxed), now);
+    const double cost = r.costMs.load(std::memory_order_relaxed);
+    r.costMs.store(sample > cost ? sample : cost * w + sample * (1.0 - w),
+                   std::memory_order_relaxed);
+    r.stampNs.store(now, std::memory_order_relaxed);
+}
+
+void ReplicaBalancer::setLag(std::size_t replica, std::chrono::milliseconds lag) {
+    impl_->replicas[replica].lagMs.store(lag.count(), std::memory_order_relaxed);
+}
+
+std::chrono::milliseconds ReplicaBalancer::lag(std::size_t replica) const {
+    const auto lagMs = impl_->replicas[replica].lagMs.load(std::memory_order_relaxed);
+    return std::chrono::milliseconds(lagMs);
+}
+
+// ── Accessors ───────────────────────────────────────────────────────────────
+
+double ReplicaBalancer::score(std::size_t replica) const {
+    return impl_->score(impl_->replicas[replica], nowNs());
+}
+
+std::vector<ReplicaStats> ReplicaBalancer::stats() const {
+    const auto now = nowNs();
+    std::vector<ReplicaStats> out(impl_->count);
+    for (std::size_t i = 0; i < impl_->count; ++i) {
+        const auto& r = impl_->replicas[i];
+        out[i].latencyMs = impl_->latencyMs(r, now);
+        out[i].inFlight = r.inFlight.load(std::memory_order_relaxed);
+        out[i].score = impl_->score(r, now);
+        out[i].lagMs = static_cast<double>(r.lagMs.load(std::memory_order_relaxed));
+        out[i].reads = r.reads.load(std::memory_order_relaxed);
+        out[i].failures = r.failures.load(std::memory_order_relaxed);
+    }
+    return out;
+}
+
+std::size_t ReplicaBalancer::size() const noexcept {
+    return impl_->count;
+}
+
+}  // namespace cgs::service
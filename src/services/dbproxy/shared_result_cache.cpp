@@ -0,0 +1,345 @@
+/// @file shared_result_cache.cpp
+/// @brief SharedResultCache implementation: binary result encoding,
+///        table-version stamped entries and the in-memory store.
+
+#include "cgs/service/shared_result_cache.hpp"
+
+#include "sql_tables.hpp"
+
+#include <array>
+#include <charconv>
+#include <cstring>
+
+namespace cgs::service {
+
+using cgs::foundation::QueryResult;
+
+namespace {
+
+// Cell type bytes of the encoding.
+enum class CellType : uint8_t { Null = 0, String = 1, Int = 2, Double = 3, Bool = 4 };
+
+// Leading byte of an encoded result, bumped if the layout changes so
+// instances running different builds never misread each other.
+constexpr uint8_t kFormatVersion = 1;
+
+// Same FNV-1a + MurmurHash3 finalizer as QueryCache's keys.
+uint64_t sqlHash(std::string_view sql) noexcept {
+    uint64_t h = 14695981039346656037ull;
+    for (const char c : sql) {
+        h = (h ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+    }
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+void putVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+void putBytes(std::string& out, std::string_view bytes) {
+    putVarint(out, bytes.size());
+    out.append(bytes);
+}
+
+/// Bounds-checked reader over encoded bytes; any overrun sets failed.
+struct Reader {
+    std::string_view in;
+    bool failed = false;
+
+    uint64_t varint() {
+        uint64_t value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            if (in.empty()) {
+                break;
+            }
+            const auto byte = static_cast<uint8_t>(in.front());
+            in.remove_prefix(1);
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        failed = true;
+        return 0;
+    }
+
+    std::string_view bytes(std::size_t count) {
+        if (count > in.size()) {
+            failed = true;
+            return {};
+        }
+        auto out = in.substr(0, count);
+        in.remove_prefix(count);
+        return out;
+    }
+
+    std::string_view prefixed() { return bytes(static_cast<std::size_t>(varint())); }
+};
+
+}  // anonymous namespace
+
+// ── Encoding ────────────────────────────────────────────────────────────────
+
+std::string encodeQueryResult(const QueryResult& result) {
+    const std::size_t rows = result.size();
+    const std::size_t columns = result.columnCount();
+
+    std::string out;
+    out.reserve(8 + rows * columns * 4);
+    out.push_back(static_cast<char>(kFormatVersion));
+    putVarint(out, columns);
+    putVarint(out, rows);
+    for (const auto& name : result.columnNames()) {
+        putBytes(out, name);
+    }
+
+    // Column by column, as QueryResult stores them.
+    for (std::size_t c = 0; c < columns; ++c) {
+        for (std::size_t r = 0; r < rows; ++r) {
+            if (auto i = result.getInt(r, c)) {
+                out.push_back(static_cast<char>(CellType::Int));
+                const auto u = static_cast<uint64_t>(*i);
+                putVarint(out, (u << 1) ^ (*i < 0 ? ~uint64_t{0} : 0));  // Zigzag
+            } else if (auto s = result.getString(r, c)) {
+                out.push_back(static_cast<char>(CellType::String));
+                putBytes(out, *s);
+            } else if (auto d = result.getDouble(r, c)) {
+                out.push_back(static_cast<char>(CellType::Double));
+                char raw[sizeof(double)];
+                std::memcpy(raw, &*d, sizeof(raw));
+                out.append(raw, sizeof(raw));
+            } else if (auto b = result.getBool(r, c)) {
+                out.push_back(static_cast<char>(CellType::Bool));
+                out.push_back(*b ? 1 : 0);
+            } else {
+                out.push_back(static_cast<char>(CellType::Null));
+            }
+        }
+    }
+    return out;
+}
+
+std::optional<QueryResult> decodeQueryResult(std::string_view bytes) {
+    Reader in{bytes};
+    if (in.bytes(1) != std::string_view("\x01", 1)) {
+        return std::nullopt;
+    }
+    const auto columns = in.varint();
+    const auto rows = in.varint();
+    // Every name and cell takes at least one byte.
+    if (in.failed || columns > in.in.size() || (columns != 0 && rows > in.in.size() / columns)) {
+        return std::nullopt;
+    }
+
+    std::vector<std::string> names;
+    names.reserve(columns);
+    for (uint64_t c = 0; c < columns; ++c) {
+        names.emplace_back(in.prefixed());
+    }
+    if (in.failed) {
+        return std::nullopt;
+    }
+
+    QueryResult result(std::move(names));
+    result.reserve(rows);
+    for (uint64_t r = 0; r < rows; ++r) {
+        (void)result.addRow();
+    }
+    for (std::size_t c = 0; c < columns; ++c) {
+        for (std::size_t r = 0; r < rows; ++r) {
+            const auto type = in.bytes(1);
+            if (in.failed) {
+                return std::nullopt;
+            }
+            switch (static_cast<CellType>(type[0])) {
+                case CellType::Null:
+                    break;
+                case CellType::String:
+                    result.set(r, c, in.prefixed());
+                    break;
+                case CellType::Int: {
+                    const auto u = in.varint();
+                    result.set(r, c, static_cast<std::int64_t>((u >> 1) ^ (~(u & 1) + 1)));
+                    break;
+                }
+                case CellType::Double: {
+                    const auto raw = in.bytes(sizeof(double));
+                    if (in.failed) {
+                        return std::nullopt;
+                    }
+                    double d = 0.0;
+                    std::memcpy(&d, raw.data(), sizeof(d));
+                    result.set(r, c, d);
+                    break;
+                }
+                case CellType::Bool: {
+                    const auto raw = in.bytes(1);
+                    if (in.failed) {
+                        return std::nullopt;
+                    }
+                    result.set(r, c, raw[0] != 0);
+                    break;
+                }
+                default:
+                    return std::nullopt;
+            }
+            if (in.failed) {
+                return std::nullopt;
+            }
+        }
+    }
+    if (!in.in.empty()) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+// ── InMemorySharedResultStore ───────────────────────────────────────────────
+
+std::vector<std::optional<std::string>> InMemorySharedResultStore::getMany(
+    const std::vector<std::string>& keys) {
+    std::vector<std::optional<std::string>> values;
+    values.reserve(keys.size());
+    const auto now = std::chrono::steady_clock::now();
+    std::lock_guard lock(mutex_);
+    for (const auto& key : keys) {
+        auto it = values_.find(key);
+        if (it == values_.end()) {
+            values.emplace_back();
+        } else if (it->second.expiresAt <= now) {
+            values_.erase(it);
+            values.emplace_back();
+        } else {
+            values.emplace_back(it->second.data);
+        }
+    }
+    return values;
+}
+
+void InMemorySharedResultStore::set(const std::string& key,
+                                    std::string value,
+                                    std::chrono::seconds ttl) {
+    const auto expiresAt = std::chrono::steady_clock::now() + ttl;
+    std::lock_guard lock(mutex_);
+    values_[key] = Value{std::move(value), expiresAt};
+}
+
+uint64_t InMemorySharedResultStore::increment(const std::string& key) {
+    std::lock_guard lock(mutex_);
+    auto& value = values_[key];
+    uint64_t counter = 0;
+    std::from_chars(value.data.data(), value.data.data() + value.data.size(), counter);
+    value.data = std::to_string(++counter);
+    value.expiresAt = std::chrono::steady_clock::time_point::max();
+    return counter;
+}
+
+std::size_t InMemorySharedResultStore::size() const {
+    std::lock_guard lock(mutex_);
+    return values_.size();
+}
+
+// ── SharedResultCache ───────────────────────────────────────────────────────
+
+SharedResultCache::SharedResultCache(SharedCacheConfig config,
+                                     std::shared_ptr<ISharedResultStore> store)
+    : config_(std::move(config)), store_(std::move(store)) {}
+
+std::string SharedResultCache::entryKey(std::string_view sql) const {
+    std::array<char, 16> hex{};
+    auto [end, ec] = std::to_chars(hex.data(), hex.data() + hex.size(), sqlHash(sql), 16);
+    return config_.keyPrefix + "q:" + std::string(hex.data(), end);
+}
+
+std::string SharedResultCache::versionKey(std::string_view table) const {
+    return config_.keyPrefix + "v:" + std::string(table);
+}
+
+SharedResultCache::Lookup SharedResultCache::lookup(std::string_view sql) {
+    // Versions of the tables read, then the entry: one round trip.
+    const auto tables = detail::extractQueryTables(sql);
+    std::vector<std::string> keys;
+    keys.reserve(tables.size() + 1);
+    for (const auto& table : tables) {
+        keys.push_back(versionKey(table));
+    }
+    keys.push_back(entryKey(sql));
+    auto values = store_->getMany(keys);
+    values.resize(keys.size());
+
+    // The stamp lists each version as text, "0" for a table never written.
+    Lookup lookup;
+    for (std::size_t i = 0; i < tables.size(); ++i) {
+        lookup.stamp += values[i] ? *values[i] : "0";
+        lookup.stamp += ';';
+    }
+
+    // Entry: SQL text (guards against hash collisions), stamp, result.
+    if (const auto& entry = values.back()) {
+        Reader in{*entry};
+        const auto storedSql = in.prefixed();
+        const auto storedStamp = in.prefixed();
+        if (!in.failed && storedSql == sql) {
+            if (storedStamp != lookup.stamp) {
+                stale_.fetch_add(1, std::memory_order_relaxed);
+            } else if ((lookup.result = decodeQueryResult(in.in))) {
+                hits_.fetch_add(1, std::memory_order_relaxed);
+                return lookup;
+            }
+        }
+    }
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return lookup;
+}
+
+void SharedResultCache::put(std::string_view sql,
+                            std::string_view stamp,
+                            const QueryResult& result) {
+    std::string entry;
+    putBytes(entry, sql);
+    putBytes(entry, stamp);
+    entry += encodeQueryResult(result);
+    if (entry.size() > config_.maxValueSizeBytes) {
+        return;
+    }
+    store_->set(entryKey(sql), std::move(entry), config_.ttl);
+    puts_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SharedResultCache::invalidateTable(std::string_view table) {
+    const auto normalized = detail::normalizeTableName(table);
+    if (!normalized.empty()) {
+        (void)store_->increment(versionKey(normalized));
+    }
+}
+
+uint64_t SharedResultCache::hitCount() const noexcept {
+    return hits_.load(std::memory_order_relaxed);
+}
+
+uint64_t SharedResultCache::missCount() const noexcept {
+    return misses_.load(std::memory_order_relaxed);
+}
+
+uint64_t SharedResultCache::staleCount() const noexcept {
+    return stale_.load(std::memory_order_relaxed);
+}
+
+uint64_t SharedResultCache::putCount() const noexcept {
+    return puts_.load(std::memory_order_relaxed);
+}
+
+const SharedCacheConfig& SharedResultCache::config() const noexcept {
+    return config_;
+}
+
+}  // namespace cgs::service
@@ -0,0 +1,400 @@
+/// @file sql_normalizer.cpp
+/// @brief normalizeSql(): one pass of a small SQL lexer writing shape and
+///        canonical text side by side.
+
+#include "cgs/service/sql_normalizer.hpp"
+
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace cgs::service {
+
+using cgs::foundation::DbValue;
+using cgs::foundation::PreparedStatement;
+
+namespace {
+
+enum class Token : uint8_t { None, Word, Literal, Param, Operator, Punct };
+
+bool isWordStart(char c) {
+    return std::isalpha(static_cast<unsigned char>(c)) || c == '_';
+}
+
+bool isWordChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '$';
+}
+
+bool isDigit(char c) {
+    return std::isdigit(static_cast<unsigned char>(c)) != 0;
+}
+
+bool isOperatorChar(char c) {
+    static constexpr std::string_view kChars = "+-*/<>=~!@#%^&|`?";
+    return kChars.find(c) != std::string_view::npos;
+}
+
+// Tokens a literal may follow and still be a bindable value.
+bool isValueContext(std::string_view previous) {
+    static constexpr std::array<std::string_view, 11> kContexts = {
+        "=", "<>", "!=", "<", ">", "<=", ">=", "like", "ilike", "limit", "offset"};
+    for (const auto context : kContexts) {
+        if (previous == context) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Whether @p sql begins with the word SELECT.
+bool startsWithSelect(std::string_view sql) {
+    std::size_t i = 0;
+    while (i < sql.size() && std::isspace(static_cast<unsigned char>(sql[i]))) {
+        ++i;
+    }
+    constexpr std::string_view kSelect = "select";
+    if (sql.size() - i < kSelect.size()) {
+        return false;
+    }
+    for (std::size_t k = 0; k < kSelect.size(); ++k) {
+        if (std::tolower(static_cast<unsigned char>(sql[i + k])) != kSelect[k]) {
+            return false;
+        }
+    }
+    return i + kSelect.size() == sql.size() || !isWordChar(sql[i + kSelect.size()]);
+}
+
+class Normalizer {
+public:
+    explicit Normalizer(std::string_view sql) : sql_(sql) {
+        out_.shape.reserve(sql.size());
+        out_.text.reserve(sql.size());
+        out_.parameterizable = true;
+    }
+
+    NormalizedSql run() {
+        bool sawParam = false;
+        while (pos_ < sql_.size()) {
+            const char c = sql_[pos_];
+            if (std::isspace(static_cast<unsigned char>(c))) {
+                ++pos_;
+            } else if (c == '-' && peek(1) == '-') {
+                skipLineComment();
+            } else if (c == '/' && peek(1) == '*') {
+                skipBlockComment();
+            } else if (c == '\'') {
+                if (pos_ > 0 && isWordChar(sql_[pos_ - 1])) {
+                    return opaque();  // E'', B'', X'', U&'' ...
+                }
+                if (!stringLiteral()) {
+                    return opaque();
+                }
+            } else if (c == '"') {
+                if (!quotedIdentifier()) {
+                    return opaque();
+                }
+            } else if (isDigit(c) || (c == '.' && isDigit(peek(1)))) {
+                if (!numberLiteral(false)) {
+                    return opaque();
+                }
+            } else if (c == '-' && (isDigit(peek(1)) || (peek(1) == '.' && isDigit(peek(2)))) &&
+                       unaryMinusAllowed()) {
+                ++pos_;
+                if (!numberLiteral(true)) {
+                    return opaque();
+                }
+            } else if (isWordStart(c)) {
+                word();
+            } else if (c == '$') {
+                if (!isWordStart(peek(1)) && !isDigit(peek(1))) {
+                    return opaque();  // Dollar quoting.
+                }
+                param();
+                sawParam = true;
+            } else if (c == ':' && peek(1) == ':') {
+                emit("::", Token::Operator);
+                pos_ += 2;
+            } else if (isOperatorChar(c) || c == ':') {
+                std::size_t end = pos_ + 1;
+                while (end < sql_.size() && isOperatorChar(sql_[end]) &&
+                       !(sql_[end] == '-' && end + 1 < sql_.size() && sql_[end + 1] == '-') &&
+                       !(sql_[end] == '/' && end + 1 < sql_.size() && sql_[end + 1] == '*')) {
+                    ++end;
+                }
+                emit(sql_.substr(pos_, end - pos_), Token::Operator);
+                pos_ = end;
+            } else if (c == '(' || c == ')' || c == ',' || c == ';' || c == '.' || c == '[' ||
+                       c == ']') {
+                punct(c);
+                ++pos_;
+            } else {
+                return opaque();  // Non-ASCII or a character SQL does not use.
+            }
+        }
+
+        if (sawParam) {
+            out_.parameterizable = false;  // Our $_N could clash.
+        }
+        out_.fingerprint = std::hash<std::string>{}(out_.shape);
+        return std::move(out_);
+    }
+
+private:
+    [[nodiscard]] char peek(std::size_t ahead) const {
+        return pos_ + ahead < sql_.size() ? sql_[pos_ + ahead] : '\0';
+    }
+
+    // Separator before a token, by the canonical spacing rules.
+    void space(std::string_view token) {
+        if (previousKind_ == Token::None) {
+            return;
+        }
+        const bool tightAfter = previous_ == "(" || previous_ == "." || previous_ == "::" ||
+                                previous_ == "[";
+        const bool tightBefore = token == ")" || token == "," || token == "." || token == ";" ||
+                                 token == "(" || token == "::" || token == "[" || token == "]";
+        if (!tightAfter && !tightBefore) {
+            out_.shape += ' ';
+            out_.text += ' ';
+        }
+    }
+
+    void emit(std::string_view token, Token kind) {
+        space(token);
+        out_.shape += token;
+        out_.text += token;
+        remember(token, kind);
+    }
+
+    void remember(std::string_view token, Token kind) {
+        previous_.assign(token);
+        previousKind_ = kind;
+    }
+
+    void punct(char c) {
+        const std::string_view token(&sql_[pos_], 1);
+        if (c == '(') {
+            inLists_.push_back(previous_ == "in");
+        } else if (c == ')' && !inLists_.empty()) {
+            inLists_.pop_back();
+        }
+        emit(token, Token::Punct);
+    }
+
+    [[nodiscard]] bool unaryMinusAllowed() const {
+        return previousKind_ == Token::None || previousKind_ == Token::Operator ||
+               previous_ == "(" || previous_ == ",";
+    }
+
+    void word() {
+        std::size_t end = pos_;
+        std::string lower;
+        while (end < sql_.size() && isWordChar(sql_[end])) {
+            lower += static_cast<char>(std::tolower(static_cast<unsigned char>(sql_[end])));
+            ++end;
+        }
+        if (previousKind_ == Token::None) {
+            out_.read = lower == "select";
+        }
+        if (previous_ == "(" && !inLists_.empty() && (lower == "select" || lower == "with")) {
+            inLists_.back() = false;  // IN (subquery), not a value list.
+        }
+        emit(lower, Token::Word);
+        pos_ = end;
+    }
+
+    void param() {
+        std::size_t end = pos_ + 1;
+        while (end < sql_.size() && isWordChar(sql_[end]) && sql_[end] != '$') {
+            ++end;
+        }
+        emit(sql_.substr(pos_, end - pos_), Token::Param);
+        pos_ = end;
+    }
+
+    void skipLineComment() {
+        while (pos_ < sql_.size() && sql_[pos_] != '\n') {
+            ++pos_;
+        }
+    }
+
+    void skipBlockComment() {
+        const auto end = sql_.find("*/", pos_ + 2);
+        pos_ = end == std::string_view::npos ? sql_.size() : end + 2;
+    }
+
+    bool quotedIdentifier() {
+        std::size_t end = pos_ + 1;
+        for (;; ++end) {
+            if (end >= sql_.size()) {
+                return false;
+            }
+            if (sql_[end] == '"') {
+                if (end + 1 < sql_.size() && sql_[end + 1] == '"') {
+                    ++end;
+                    continue;
+                }
+                break;
+            }
+        }
+        emit(sql_.substr(pos_, end + 1 - pos_), Token::Word);
+        pos_ = end + 1;
+        return true;
+    }
+
+    bool stringLiteral() {
+        std::string value;
+        std::size_t end = pos_ + 1;
+        for (;; ++end) {
+            if (end >= sql_.size()) {
+                return false;
+            }
+            if (sql_[end] == '\'') {
+                if (end + 1 < sql_.size() && sql_[end + 1] == '\'') {
+                    value += '\'';
+                    ++end;
+                    continue;
+                }
+                break;
+            }
+            value += sql_[end];
+        }
+        literal(sql_.substr(pos_, end + 1 - pos_), std::move(value));
+        pos_ = end + 1;
+        return true;
+    }
+
+    // A number at pos_; @p negative if a unary minus was consumed.
+    bool numberLiteral(bool negative) {
+        const auto start = negative ? pos_ - 1 : pos_;
+        std::size_t end = pos_;
+        bool integral = true;
+        while (end < sql_.size() && isDigit(sql_[end])) {
+            ++end;
+        }
+        if (end < sql_.size() && sql_[end] == '.') {
+            integral = false;
+            ++end;
+            while (end < sql_.size() && isDigit(sql_[end])) {
+                ++end;
+            }
+        }
+        if (end < sql_.size() && (sql_[end] == 'e' || sql_[end] == 'E')) {
+            integral = false;
+            ++end;
+            if (end < sql_.size() && (sql_[end] == '+' || sql_[end] == '-')) {
+                ++end;
+            }
+            if (end >= sql_.size() || !isDigit(sql_[end])) {
+                return false;
+            }
+            while (end < sql_.size() && isDigit(sql_[end])) {
+                ++end;
+            }
+        }
+        if (end < sql_.size() && isWordChar(sql_[end])) {
+            return false;  // 0x1F, 12abc ...
+        }
+
+        const auto spelled = sql_.substr(start, end - start);
+        const char* const first = spelled.data();
+        const char* const last = first + spelled.size();
+        DbValue value;
+        if (integral) {
+            std::int64_t number = 0;
+            auto [ptr, ec] = std::from_chars(first, last, number);
+            if (ec == std::errc{} && ptr == last) {
+                value = number;
+            } else {
+                integral = false;  // Out of range: keep as a double.
+            }
+        }
+        if (!integral) {
+            double number = 0.0;
+            auto [ptr, ec] = std::from_chars(first, last, number);
+            if (ec != std::errc{} || ptr != last) {
+                return false;
+            }
+            value = number;
+        }
+        literal(spelled, std::move(value));
+        pos_ = end;
+        return true;
+    }
+
+    void literal(std::string_view spelled, DbValue value) {
+        const bool bindable = isValueContext(previous_) ||
+                              ((previous_ == "(" || previous_ == ",") && !inLists_.empty() &&
+                               inLists_.back());
+        if (!bindable) {
+            out_.parameterizable = false;
+        }
+
+        out_.parameters.push_back(std::move(value));
+        const auto placeholder = "$_" + std::to_string(out_.parameters.size());
+        space(placeholder);
+        out_.shape += placeholder;
+        out_.text += spelled;
+        remember(placeholder, Token::Literal);
+    }
+
+    NormalizedSql opaque() {
+        NormalizedSql result;
+        result.shape = std::string(sql_);
+        result.text = result.shape;
+        result.fingerprint = std::hash<std::string>{}(result.shape);
+        result.read = startsWithSelect(sql_);
+        result.opaque = true;
+        return result;
+    }
+
+    std::string_view sql_;
+    std::size_t pos_ = 0;
+    NormalizedSql out_;
+
+    std::string previous_;  // Last token as emitted to shape.
+    Token previousKind_ = Token::None;
+    std::vector<bool> inLists_;  // Per open parenthesis: opened after IN.
+};
+
+}  // anonymous namespace
+
+// ── NormalizedSql ───────────────────────────────────────────────────────────
+
+PreparedStatement NormalizedSql::statement() const {
+    PreparedStatement stmt(shape);
+    for (std::size_t i = 0; i < parameters.size(); ++i) {
+        const auto name = "_" + std::to_string(i + 1);
+        std::visit(
+            [&](const auto& value) {
+                using T = std::decay_t<decltype(value)>;
+                if constexpr (std::is_same_v<T, std::string>) {
+                    stmt.bindString(name, value);
+                } else if constexpr (std::is_same_v<T, std::int64_t>) {
+                    stmt.bindInt(name, value);
+                } else if constexpr (std::is_same_v<T, double>) {
+                    stmt.bindDouble(name, value);
+                } else if constexpr (std::is_same_v<T, bool>) {
+                    stmt.bindBool(name, value);
+                } else {
+                    stmt.bindNull(name);
+                }
+            },
+            parameters[i]);
+    }
+    return stmt;
+}
+
+// ── normalizeSql() ──────────────────────────────────────────────────────────
+
+NormalizedSql normalizeSql(std::string_view sql) {
+    return Normalizer(sql).run();
+}
+
+}  // namespace cgs::service
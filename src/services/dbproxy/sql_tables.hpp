@@ -0,0 +1,169 @@
+#pragma once
+
+/// @file sql_tables.hpp
+/// @brief Table name extraction from SQL text for cache invalidation.
+///
+/// Internal header for the dbproxy service.  DBProxyServer uses it to
+/// find the table a write touches, and QueryCache to record the tables a
+/// cached query reads, so a write invalidates only the queries that
+/// depend on its table.
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cgs::service::detail {
+
+/// Extract the table name from a write SQL statement.
+/// Recognizes INSERT INTO <table>, UPDATE <table>, DELETE FROM <table>,
+/// and ALTER/DROP/TRUNCATE TABLE <table>.
+///
+/// Returns the first table name found (sufficient for invalidation).
+[[nodiscard]] inline std::string extractTableName(std::string_view sql) {
+    // Normalize to uppercase for keyword matching.
+    auto upper = std::string(sql);
+    std::transform(
+        upper.begin(), upper.end(), upper.begin(), [](unsigned char c) { return std::toupper(c); });
+
+    static constexpr std::string_view kPatterns[] = {
+        "INSERT INTO ",
+        "UPDATE ",
+        "DELETE FROM ",
+        "ALTER TABLE ",
+        "DROP TABLE ",
+        "TRUNCATE TABLE ",
+        "TRUNCATE ",
+    };
+
+    for (const auto keyword : kPatterns) {
+        auto pos = upper.find(keyword);
+        if (pos == std::string::npos) {
+            continue;
+        }
+
+        // Move past the keyword.
+        auto nameStart = pos + keyword.size();
+
+        // Skip optional whitespace.
+        while (nameStart < sql.size() && std::isspace(static_cast<unsigned char>(sql[nameStart]))) {
+            ++nameStart;
+        }
+
+        // Extract the table name (until whitespace, parenthesis, or semicolon).
+        auto nameEnd = nameStart;
+        while (nameEnd < sql.size()) {
+            char c = sql[nameEnd];
+            if (std::isspace(static_cast<unsigned char>(c)) || c == '(' || c == ';' || c == ',') {
+                break;
+            }
+            ++nameEnd;
+        }
+
+        if (nameEnd > nameStart) {
+            return std::string(sql.substr(nameStart, nameEnd - nameStart));
+        }
+    }
+
+    return {};
+}
+
+/// Canonical form of a table name for matching: unquoted, without its
+/// schema qualifier, lowercase ("`Game`.`Items`" -> "items").
+[[nodiscard]] inline std::string normalizeTableName(std::string_view name) {
+    std::string out;
+    out.reserve(name.size());
+    for (const char c : name) {
+        if (c == '.') {
+            out.clear();  // Keep the part after the last qualifier.
+        } else if (c != '`' && c != '"' && c != '[' && c != ']') {
+            out.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+        }
+    }
+    return out;
+}
+
+/// Tables a statement depends on, normalized: every name after FROM or
+/// JOIN (including comma-separated FROM lists and subqueries) plus the
+/// target of a write.  Unrecognized constructs may add a spurious name,
+/// which only costs an extra invalidation.
+[[nodiscard]] inline std::vector<std::string> extractQueryTables(std::string_view sql) {
+    // Split into words and single-character punctuation, skipping string
+    // literals so their contents are never taken for names.
+    std::vector<std::string_view> tokens;
+    for (std::size_t i = 0; i < sql.size();) {
+        const char c = sql[i];
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            ++i;
+        } else if (c == '\'') {
+            auto end = sql.find('\'', i + 1);
+            i = end == std::string_view::npos ? sql.size() : end + 1;
+        } else if (c == ',' || c == '(' || c == ')' || c == ';') {
+            tokens.push_back(sql.substr(i, 1));
+            ++i;
+        } else {
+            auto start = i;
+            while (i < sql.size() && !std::isspace(static_cast<unsigned char>(sql[i])) &&
+                   sql[i] != ',' && sql[i] != '(' && sql[i] != ')' && sql[i] != ';' &&
+                   sql[i] != '\'') {
+                ++i;
+            }
+            tokens.push_back(sql.substr(start, i - start));
+        }
+    }
+
+    auto is = [](std::string_view token, std::string_view keyword) {
+        return token.size() == keyword.size() &&
+               std::equal(token.begin(), token.end(), keyword.begin(), [](char a, char b) {
+                   return std::toupper(static_cast<unsigned char>(a)) == b;
+               });
+    };
+    // Words that end a FROM list.
+    auto endsFromList = [&is](std::string_view token) {
+        static constexpr std::string_view kClauses[] = {
+            "WHERE", "JOIN",  "ON",   "GROUP",   "ORDER", "LIMIT", "HAVING", "UNION",
+            "INNER", "LEFT",  "RIGHT", "FULL",   "CROSS", "NATURAL", "OFFSET", "FOR",
+            "WINDOW", "USING", ")",    ";"};
+        return std::any_of(std::begin(kClauses), std::end(kClauses), [&](std::string_view clause) {
+            return is(token, clause);
+        });
+    };
+
+    std::vector<std::string> tables;
+    auto add = [&tables](std::string_view name) {
+        auto normalized = normalizeTableName(name);
+        if (!normalized.empty() &&
+            std::find(tables.begin(), tables.end(), normalized) == tables.end()) {
+            tables.push_back(std::move(normalized));
+        }
+    };
+
+    for (std::size_t i = 0; i < tokens.size(); ++i) {
+        const bool from = is(tokens[i], "FROM");
+        if (!from && !is(tokens[i], "JOIN")) {
+            continue;
+        }
+        // "FROM (" opens a subquery, whose own FROM is found later.
+        if (i + 1 < tokens.size() && tokens[i + 1] != "(") {
+            add(tokens[i + 1]);
+        }
+        if (!from) {
+            continue;
+        }
+        // FROM a x, b y, ...: the name after each top-level comma.
+        for (std::size_t j = i + 2; j < tokens.size() && !endsFromList(tokens[j]); ++j) {
+            if (tokens[j] == "(") {
+                break;  // A function or subquery; its FROM is found later.
+            }
+            if (tokens[j] == "," && j + 1 < tokens.size() && tokens[j + 1] != "(") {
+                add(tokens[j + 1]);
+            }
+        }
+    }
+
+    add(extractTableName(sql));
+    return tables;
+}
+
+}  // namespace cgs::service::detail
@@ -0,0 +1,168 @@
+/// @file write_combiner.cpp
+/// @brief WriteCombiner implementation: an open group per combiner, led
+///        and committed by the first write that joined it.
+
+#include "cgs/service/write_combiner.hpp"
+
+#include "cgs/foundation/error_code.hpp"
+#include "cgs/foundation/game_error.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+
+namespace cgs::service {
+
+using cgs::foundation::ErrorCode;
+using cgs::foundation::GameError;
+
+namespace {
+
+// Writes collected for one transaction.
+struct Group {
+    std::vector<std::string> statements;
+    std::vector<WriteCombiner::Result> results;  // Set by the leader.
+    bool done = false;                           // Guarded by Impl::mutex.
+};
+
+// Whether @p sql starts with @p keyword (case-insensitive) and a separator.
+bool startsWithKeyword(std::string_view sql, std::string_view keyword) {
+    if (sql.size() <= keyword.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < keyword.size(); ++i) {
+        if (std::toupper(static_cast<unsigned char>(sql[i])) != keyword[i]) {
+            return false;
+        }
+    }
+    return !std::isalnum(static_cast<unsigned char>(sql[keyword.size()])) &&
+           sql[keyword.size()] != '_';
+}
+
+}  // anonymous namespace
+
+// ── Impl ────────────────────────────────────────────────────────────────────
+
+struct WriteCombiner::Impl {
+    WriteBatchConfig config;
+    Commit commit;
+
+    std::mutex mutex;
+    std::condition_variable changed;  // A group closed or was committed.
+    std::shared_ptr<Group> open;      // Group new writes join, if any.
+
+    std::atomic<uint64_t> groups{0};
+    std::atomic<uint64_t> combined{0};
+
+    Impl(WriteBatchConfig cfg, Commit c) : config(cfg), commit(std::move(c)) {}
+
+    // Commit @p statements; a throwing or short commit fails them all.
+    std::vector<Result> commitOnce(const std::vector<std::string>& statements) {
+        std::vector<Result> results;
+        try {
+            results = commit(statements);
+        } catch (const std::exception& e) {
+            return std::vector<Result>(statements.size(),
+                                       Result::err(GameError(ErrorCode::DBProxyError, e.what())));
+        }
+        if (results.size() != statements.size()) {
+            return std::vector<Result>(
+                statements.size(),
+                Result::err(GameError(ErrorCode::DBProxyError, "write group result mismatch")));
+        }
+        return results;
+    }
+};
+
+// ── Construction / destruction / move ───────────────────────────────────────
+
+WriteCombiner::WriteCombiner(WriteBatchConfig config, Commit commit)
+    : impl_(std::make_unique<Impl>(config, std::move(commit))) {}
+
+WriteCombiner::~WriteCombiner() = default;
+
+WriteCombiner::WriteCombiner(WriteCombiner&&) noexcept = default;
+WriteCombiner& WriteCombiner::operator=(WriteCombiner&&) noexcept = default;
+
+// ── execute() ───────────────────────────────────────────────────────────────
+
+WriteCombiner::Result WriteCombiner::execute(std::string_view sql) {
+    auto& impl = *impl_;
+    const auto maxStatements = std::max<std::size_t>(impl.config.maxStatements, 1);
+
+    std::unique_lock lock(impl.mutex);
+    const bool leader = !impl.open;
+    if (leader) {
+        impl.open = std::make_shared<Group>();
+        impl.open->statements.reserve(maxStatements);
+    }
+    auto group = impl.open;
+    const auto index = group->statements.size();
+    group->statements.emplace_back(sql);
+
+    if (group->statements.size() >= maxStatements) {
+        impl.open.reset();  // Full: the leader commits now.
+        impl.changed.notify_all();
+    }
+
+    if (!leader) {
+        impl.changed.wait(lock, [&] { return group->done; });
+        return group->results[index];
+    }
+
+    // Leader: collect until the window ends or the group fills.
+    impl.changed.wait_for(lock, impl.config.window, [&] { return impl.open != group; });
+    if (impl.open == group) {
+        impl.open.reset();
+    }
+    lock.unlock();
+
+    auto results = impl.commitOnce(group->statements);
+    if (results.size() > 1) {
+        impl.groups.fetch_add(1, std::memory_order_relaxed);
+        impl.combined.fetch_add(results.size(), std::memory_order_relaxed);
+    }
+
+    lock.lock();
+    group->results = std::move(results);
+    group->done = true;
+    impl.changed.notify_all();
+    return group->results[index];
+}
+
+// ── Accessors ───────────────────────────────────────────────────────────────
+
+uint64_t WriteCombiner::groupCount() const {
+    return impl_->groups.load(std::memory_order_relaxed);
+}
+
+uint64_t WriteCombiner::combinedCount() const {
+    return impl_->combined.load(std::memory_order_relaxed);
+}
+
+bool WriteCombiner::combinable(std::string_view sql) {
+    while (!sql.empty() && std::isspace(static_cast<unsigned char>(sql.front()))) {
+        sql.remove_prefix(1);
+    }
+    while (!sql.empty() &&
+           (sql.back() == ';' || std::isspace(static_cast<unsigned char>(sql.back())))) {
+        sql.remove_suffix(1);
+    }
+    if (sql.find(';') != std::string_view::npos) {
+        return false;  // Several statements; may include transaction control.
+    }
+
+    static constexpr std::array<std::string_view, 3> kWrites = {"INSERT", "UPDATE", "DELETE"};
+    for (const auto keyword : kWrites) {
+        if (startsWithKeyword(sql, keyword)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace cgs::service
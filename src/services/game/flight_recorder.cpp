@@ -0,0 +1,430 @@
+/// @file flight_recorder.cpp
+/// @brief FlightRecorder: tick ring, event ring, Chrome trace rendering
+///        and the background dump writer.
+
+#include "cgs/service/flight_recorder.hpp"
+
+#include "cgs/foundation/json_escape.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <system_error>
+#include <utility>
+
+namespace cgs::service {
+
+namespace {
+
+int64_t nowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+template <typename T>
+void appendNumber(std::string& out, T value) {
+    char buffer[32];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+void appendQuoted(std::string& out, std::string_view value) {
+    out.push_back('"');
+    cgs::foundation::appendJsonEscaped(out, value);
+    out.push_back('"');
+}
+
+/// Copy @p tick into ring slot @p slot, reusing the slot's system buffer.
+void copyTick(FlightTick& slot, const FlightTick& tick, std::size_t maxSystems) {
+    slot.tickNumber = tick.tickNumber;
+    slot.startUs = tick.startUs;
+    slot.updateUs = tick.updateUs;
+    slot.frameUs = tick.frameUs;
+    slot.jitterUs = tick.jitterUs;
+    slot.budgetUtilization = tick.budgetUtilization;
+    slot.overrun = tick.overrun;
+    slot.entities = tick.entities;
+    slot.players = tick.players;
+    slot.instances = tick.instances;
+    slot.messagesIn = tick.messagesIn;
+    slot.bytesIn = tick.bytesIn;
+    slot.messagesOut = tick.messagesOut;
+    slot.bytesOut = tick.bytesOut;
+    slot.allocations = tick.allocations;
+    const std::size_t systems = std::min(tick.systems.size(), maxSystems);
+    slot.systems.assign(tick.systems.begin(),
+                        tick.systems.begin() + static_cast<std::ptrdiff_t>(systems));
+}
+
+}  // namespace
+
+std::string_view flightEventKindName(FlightEventKind kind) noexcept {
+    switch (kind) {
+        case FlightEventKind::InstanceCreated:
+            return "instance_created";
+        case FlightEventKind::InstanceDestroyed:
+            return "instance_destroyed";
+        case FlightEventKind::InstanceMigrated:
+            return "instance_migrated";
+        case FlightEventKind::InstanceHibernated:
+            return "instance_hibernated";
+        case FlightEventKind::InstanceWoken:
+            return "instance_woken";
+        case FlightEventKind::HotReload:
+            return "hot_reload";
+        case FlightEventKind::Snapshot:
+            return "snapshot";
+        case FlightEventKind::Custom:
+            break;
+    }
+    return "custom";
+}
+
+// -- Construction -------------------------------------------------------------
+
+FlightRecorder::FlightRecorder(FlightRecorderConfig config) : config_(std::move(config)) {
+    config_.capacity = std::max<std::size_t>(config_.capacity, 1);
+    ring_.resize(config_.capacity);
+    for (auto& slot : ring_) {
+        slot.systems.reserve(config_.maxSystemsPerTick);
+    }
+}
+
+FlightRecorder::~FlightRecorder() {
+    {
+        std::lock_guard lock(writerMutex_);
+        writerStop_ = true;
+    }
+    writerWake_.notify_all();
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+}
+
+// -- Recording ----------------------------------------------------------------
+
+uint16_t FlightRecorder::registerSystem(std::string_view name) {
+    std::lock_guard lock(mutex_);
+    for (std::size_t i = 0; i < systemNames_.size(); ++i) {
+        if (systemNames_[i] == name) {
+            return static_cast<uint16_t>(i);
+        }
+    }
+    systemNames_.emplace_back(name);
+    return static_cast<uint16_t>(systemNames_.size() - 1);
+}
+
+std::string FlightRecorder::systemName(uint16_t id) const {
+    std::lock_guard lock(mutex_);
+    return id < systemNames_.size() ? systemNames_[id] : std::string("?");
+}
+
+void FlightRecorder::record(const FlightTick& tick) {
+    std::optional<Dump> dump;
+    {
+        std::lock_guard lock(mutex_);
+        FlightTick& slot = ring_[next_];
+        copyTick(slot, tick, config_.maxSystemsPerTick);
+        slot.messagesIn += messagesIn_.exchange(0, std::memory_order_relaxed);
+        slot.bytesIn += bytesIn_.exchange(0, std::memory_order_relaxed);
+        slot.messagesOut += messagesOut_.exchange(0, std::memory_order_relaxed);
+        slot.bytesOut += bytesOut_.exchange(0, std::memory_order_relaxed);
+        next_ = (next_ + 1) % ring_.size();
+        size_ = std::min(size_ + 1, ring_.size());
+        currentTick_ = tick.tickNumber + 1;
+
+        if (config_.overrunFactor > 0.0f && tick.budgetUtilization >= config_.overrunFactor) {
+            ++dumpStats_.triggers;
+            const auto now = std::chrono::steady_clock::now();
+            if (!pendingTrigger_ && !config_.dumpDirectory.empty() &&
+                (!dumpedOnce_ || now - lastDump_ >= config_.dumpCooldown)) {
+                pendingTrigger_ = tick.tickNumber;
+                lastDump_ = now;
+                dumpedOnce_ = true;
+            }
+        }
+
+        if (pendingTrigger_ && tick.tickNumber >= *pendingTrigger_ + config_.ticksAfter) {
+            const uint64_t trigger = *pendingTrigger_;
+            const uint64_t from = trigger > config_.ticksBefore ? trigger - config_.ticksBefore : 0;
+            dump.emplace();
+            dump->triggerTick = trigger;
+            dump->ticks = collectTicksLocked(from, std::numeric_limits<int64_t>::min());
+            dump->events = collectEventsLocked(
+                dump->ticks.empty() ? 0 : dump->ticks.front().startUs);
+            dump->names = systemNames_;
+            pendingTrigger_.reset();
+        }
+    }
+
+    if (dump) {
+        std::lock_guard lock(writerMutex_);
+        if (!writer_.joinable()) {
+            writer_ = std::thread([this] { writerLoop(); });
+        }
+        dumps_.push_back(std::move(*dump));
+        writerWake_.notify_one();
+    }
+}
+
+void FlightRecorder::addNetworkTraffic(uint64_t messagesIn,
+                                       uint64_t bytesIn,
+                                       uint64_t messagesOut,
+                                       uint64_t bytesOut) noexcept {
+    messagesIn_.fetch_add(messagesIn, std::memory_order_relaxed);
+    bytesIn_.fetch_add(bytesIn, std::memory_order_relaxed);
+    messagesOut_.fetch_add(messagesOut, std::memory_order_relaxed);
+    bytesOut_.fetch_add(bytesOut, std::memory_order_relaxed);
+}
+
+void FlightRecorder::note(FlightEventKind kind, std::string_view detail) {
+    std::lock_guard lock(mutex_);
+    events_.push_back({kind, currentTick_, nowUs(), std::string(detail)});
+    while (events_.size() > std::max<std::size_t>(config_.eventCapacity, 1)) {
+        events_.pop_front();
+    }
+}
+
+// -- Queries ------------------------------------------------------------------
+
+std::vector<FlightTick> FlightRecorder::collectTicksLocked(uint64_t fromTick,
+                                                           int64_t fromUs) const {
+    std::vector<FlightTick> out;
+    const std::size_t oldest = (next_ + ring_.size() - size_) % ring_.size();
+    for (std::size_t i = 0; i < size_; ++i) {
+        const FlightTick& tick = ring_[(oldest + i) % ring_.size()];
+        if (tick.tickNumber >= fromTick && tick.startUs >= fromUs) {
+            out.push_back(tick);
+        }
+    }
+    return out;
+}
+
+std::vector<FlightEvent> FlightRecorder::collectEventsLocked(int64_t fromUs) const {
+    std::vector<FlightEvent> out;
+    for (const auto& event : events_) {
+        if (event.timeUs >= fromUs) {
+            out.push_back(event);
+        }
+    }
+    return out;
+}
+
+std::vector<FlightTick> FlightRecorder::ticks(std::size_t count) const {
+    std::lock_guard lock(mutex_);
+    auto all = collectTicksLocked(0, std::numeric_limits<int64_t>::min());
+    if (all.size() > count) {
+        all.erase(all.begin(), all.end() - static_cast<std::ptrdiff_t>(count));
+    }
+    return all;
+}
+
+std::vector<FlightEvent> FlightRecorder::events() const {
+    std::lock_guard lock(mutex_);
+    return {events_.begin(), events_.end()};
+}
+
+std::string FlightRecorder::traceJson(std::chrono::seconds window) const {
+    std::vector<FlightTick> ticks;
+    std::vector<FlightEvent> events;
+    std::vector<std::string> names;
+    {
+        std::lock_guard lock(mutex_);
+        if (size_ > 0) {
+            const FlightTick& newest = ring_[(next_ + ring_.size() - 1) % ring_.size()];
+            const int64_t from =
+                newest.startUs - std::chrono::duration_cast<std::chrono::microseconds>(window)
+                                     .count();
+            ticks = collectTicksLocked(0, from);
+            events = collectEventsLocked(from);
+        }
+        names = systemNames_;
+    }
+    return render(ticks, events, names, std::nullopt);
+}
+
+FlightDumpStats FlightRecorder::dumpStats() const {
+    std::lock_guard lock(mutex_);
+    return dumpStats_;
+}
+
+// -- Trace rendering ----------------------------------------------------------
+
+std::string FlightRecorder::render(const std::vector<FlightTick>& ticks,
+                                   const std::vector<FlightEvent>& events,
+                                   const std::vector<std::string>& names,
+                                   std::optional<uint64_t> triggerTick) {
+    std::string out = "{\"traceEvents\":[";
+    bool first = true;
+    const auto separator = [&] {
+        if (!first) {
+            out.push_back(',');
+        }
+        first = false;
+    };
+
+    // Track 0 is the game loop; track 1 + w shows world w's systems.
+    uint16_t worlds = 0;
+    for (const auto& tick : ticks) {
+        for (const auto& system : tick.systems) {
+            worlds = std::max<uint16_t>(worlds, static_cast<uint16_t>(system.world + 1));
+        }
+    }
+    separator();
+    out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,"
+           "\"args\":{\"name\":\"game loop\"}}";
+    for (uint16_t w = 0; w < worlds; ++w) {
+        separator();
+        out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":";
+        appendNumber(out, w + 1);
+        out += ",\"args\":{\"name\":\"world ";
+        appendNumber(out, w);
+        out += "\"}}";
+    }
+
+    for (const auto& tick : ticks) {
+        separator();
+        out += "{\"name\":\"tick\",\"cat\":\"tick\",\"ph\":\"X\",\"ts\":";
+        appendNumber(out, tick.startUs);
+        out += ",\"dur\":";
+        appendNumber(out, tick.updateUs);
+        out += ",\"pid\":1,\"tid\":0,\"args\":{\"tick\":";
+        appendNumber(out, tick.tickNumber);
+        out += ",\"frameUs\":";
+        appendNumber(out, tick.frameUs);
+        out += ",\"jitterUs\":";
+        appendNumber(out, tick.jitterUs);
+        out += ",\"budget\":";
+        appendNumber(out, tick.budgetUtilization);
+        out += ",\"overrun\":";
+        out += tick.overrun ? "true" : "false";
+        out += "}}";
+
+        for (const auto& system : tick.systems) {
+            separator();
+            out += "{\"name\":";
+            appendQuoted(out, system.system < names.size() ? names[system.system] : "?");
+            out += ",\"cat\":\"system\",\"ph\":\"X\",\"ts\":";
+            appendNumber(out, tick.startUs + system.startOffsetUs);
+            out += ",\"dur\":";
+            appendNumber(out, system.durationUs);
+            out += ",\"pid\":1,\"tid\":";
+            appendNumber(out, system.world + 1);
+            out += ",\"args\":{\"tick\":";
+            appendNumber(out, tick.tickNumber);
+            out += ",\"allocs\":";
+            appendNumber(out, system.allocations);
+            out += "}}";
+        }
+
+        separator();
+        out += "{\"name\":\"population\",\"ph\":\"C\",\"ts\":";
+        appendNumber(out, tick.startUs);
+        out += ",\"pid\":1,\"args\":{\"entities\":";
+        appendNumber(out, tick.entities);
+        out += ",\"players\":";
+        appendNumber(out, tick.players);
+        out += ",\"instances\":";
+        appendNumber(out, tick.instances);
+        out += "}}";
+
+        separator();
+        out += "{\"name\":\"network\",\"ph\":\"C\",\"ts\":";
+        appendNumber(out, tick.startUs);
+        out += ",\"pid\":1,\"args\":{\"messagesIn\":";
+        appendNumber(out, tick.messagesIn);
+        out += ",\"bytesIn\":";
+        appendNumber(out, tick.bytesIn);
+        out += ",\"messagesOut\":";
+        appendNumber(out, tick.messagesOut);
+        out += ",\"bytesOut\":";
+        appendNumber(out, tick.bytesOut);
+        out += "}}";
+
+        separator();
+        out += "{\"name\":\"allocations\",\"ph\":\"C\",\"ts\":";
+        appendNumber(out, tick.startUs);
+        out += ",\"pid\":1,\"args\":{\"allocs\":";
+        appendNumber(out, tick.allocations);
+        out += "}}";
+    }
+
+    for (const auto& event : events) {
+        separator();
+        out += "{\"name\":";
+        appendQuoted(out, flightEventKindName(event.kind));
+        out += ",\"cat\":\"event\",\"ph\":\"i\",\"s\":\"g\",\"ts\":";
+        appendNumber(out, event.timeUs);
+        out += ",\"pid\":1,\"tid\":0,\"args\":{\"tick\":";
+        appendNumber(out, event.tickNumber);
+        out += ",\"detail\":";
+        appendQuoted(out, event.detail);
+        out += "}}";
+    }
+
+    out += "],\"displayTimeUnit\":\"ms\"";
+    if (triggerTick) {
+        out += ",\"otherData\":{\"triggerTick\":";
+        appendNumber(out, *triggerTick);
+        out += '}';
+    }
+    out += '}';
+    return out;
+}
+
+// -- Dump writer --------------------------------------------------------------
+
+void FlightRecorder::flushDumps() {
+    std::unique_lock lock(writerMutex_);
+    writerIdle_.wait(lock, [this] { return dumps_.empty() && !writing_; });
+}
+
+void FlightRecorder::writerLoop() {
+    std::unique_lock lock(writerMutex_);
+    for (;;) {
+        writerWake_.wait(lock, [this] { return writerStop_ || !dumps_.empty(); });
+        if (dumps_.empty()) {
+            return;  // Stopping with nothing queued.
+        }
+        Dump dump = std::move(dumps_.front());
+        dumps_.pop_front();
+        writing_ = true;
+        lock.unlock();
+
+        const std::string body = render(dump.ticks, dump.events, dump.names, dump.triggerTick);
+        const auto wallMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                std::chrono::system_clock::now().time_since_epoch())
+                                .count();
+        char fileName[64];
+        std::snprintf(fileName, sizeof(fileName), "flight-%lld-tick%llu.json",
+                      static_cast<long long>(wallMs),
+                      static_cast<unsigned long long>(dump.triggerTick));
+        const auto path = config_.dumpDirectory / fileName;
+
+        std::error_code ec;
+        std::filesystem::create_directories(config_.dumpDirectory, ec);
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(body.data(), static_cast<std::streamsize>(body.size()));
+        const bool ok = !ec && file.good();
+        file.close();
+
+        {
+            std::lock_guard statsLock(mutex_);
+            if (ok) {
+                ++dumpStats_.written;
+                dumpStats_.lastPath = path;
+            } else {
+                ++dumpStats_.failed;
+            }
+        }
+
+        lock.lock();
+        writing_ = false;
+        writerIdle_.notify_all();
+    }
+}
+
+}  // namespace cgs::service
@@ -3,8 +3,20 @@
 
 #include "cgs/service/game_loop.hpp"
 
+#include <algorithm>
+
 namespace cgs::service {
 
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int kSlackSamples = 8;
+constexpr std::chrono::microseconds kSlackProbe{500};
+constexpr std::chrono::microseconds kSlackMargin{100};
+
+}  // anonymous namespace
+
 GameLoop::GameLoop(uint32_t tickRate)
     : tickRate_(tickRate > 0 ? tickRate : 20),
       targetFrameTime_(std::chrono::microseconds(1'000'000 / (tickRate > 0 ? tickRate : 20))) {}
@@ -23,6 +35,40 @@ void GameLoop::setMetricsCallback(MetricsCallback callback) {
     metricsCallback_ = std::move(callback);
 }
 
+cgs::foundation::GameResult<void> GameLoop::setAffinity(cgs::foundation::CpuSet cpus) {
+    if (running_.load()) {
+        return cgs::foundation::GameResult<void>::err(cgs::foundation::GameError(
+            cgs::foundation::ErrorCode::InvalidArgument, "cannot change affinity while running"));
+    }
+    affinity_ = std::move(cpus);
+    return cgs::foundation::GameResult<void>::ok();
+}
+
+const cgs::foundation::CpuSet& GameLoop::affinity() const noexcept {
+    return affinity_;
+}
+
+bool GameLoop::isPinned() const noexcept {
+    return pinned_.load();
+}
+
+cgs::foundation::GameResult<void> GameLoop::setTiming(TickTiming timing) {
+    if (running_.load()) {
+        return cgs::foundation::GameResult<void>::err(cgs::foundation::GameError(
+            cgs::foundation::ErrorCode::InvalidArgument, "cannot change timing while running"));
+    }
+    timing_ = timing;
+    return cgs::foundation::GameResult<void>::ok();
+}
+
+const TickTiming& GameLoop::timing() const noexcept {
+    return timing_;
+}
+
+std::chrono::microseconds GameLoop::timerSlack() const noexcept {
+    return std::chrono::microseconds{timerSlackMicros_.load()};
+}
+
 bool GameLoop::start() {
     bool expected = false;
     if (!running_.compare_exchange_strong(expected, true)) {
@@ -38,6 +84,7 @@ void GameLoop::stop() {
     if (thread_.joinable()) {
         thread_.join();
     }
+    pinned_.store(false);
 }
 
 TickMetrics GameLoop::tick() {
@@ -66,12 +113,37 @@ TickMetrics GameLoop::lastMetrics() const {
 }
 
 void GameLoop::run() {
-    auto nextTick = std::chrono::steady_clock::now();
+    // Best effort: an unusable set leaves the thread where the OS put it.
+    pinned_.store(!affinity_.empty() && cgs::foundation::pinCurrentThread(affinity_).hasValue());
+
+    // Calibrate after pinning: slack depends on the CPU the thread runs on.
+    if (timing_.mode == TickTimingMode::Precise) {
+        timerSlackMicros_.store(calibrateTimerSlack().count());
+    }
+
+    auto deadline = Clock::now();
+    auto lastStart = deadline;
+    bool first = true;
+    bool waited = false;
+    uint32_t dropped = 0;
+    uint32_t caughtUp = 0;
 
     while (running_.load()) {
-        nextTick += targetFrameTime_;
+        const auto start = Clock::now();
 
         auto metrics = executeTick();
+        if (!first) {
+            metrics.frameTime =
+                std::chrono::duration_cast<std::chrono::microseconds>(start - lastStart);
+        }
+        if (waited && start > deadline) {
+            metrics.jitter =
+                std::chrono::duration_cast<std::chrono::microseconds>(start - deadline);
+        }
+        metrics.droppedTicks = dropped;
+        lastStart = start;
+        first = false;
+        dropped = 0;
 
         // Store metrics for external queries.
         {
@@ -87,17 +159,54 @@ void GameLoop::run() {
             }
         }
 
-        // Sleep until next tick, but skip if we already overran.
-        auto now = std::chrono::steady_clock::now();
-        if (now < nextTick) {
-            std::this_thread::sleep_until(nextTick);
+        deadline += targetFrameTime_;
+        const auto now = Clock::now();
+        waited = now < deadline;
+        if (waited) {
+            caughtUp = 0;
+            waitUntil(deadline);
+        } else if (timing_.overrun == OverrunPolicy::CatchUp &&
+                   caughtUp < timing_.maxCatchUpTicks) {
+            // Run the missed tick now, keeping the original schedule.
+            ++caughtUp;
         } else {
-            // Overrun: reset the target to avoid cascading catch-up.
-            nextTick = now;
+            // Drop the missed ticks to avoid cascading catch-up.
+            dropped = static_cast<uint32_t>((now - deadline) / targetFrameTime_);
+            caughtUp = 0;
+            deadline = now;
         }
     }
 }
 
+std::chrono::microseconds GameLoop::calibrateTimerSlack() const {
+    // The worst overshoot of short sleeps approximates how late a wake-up
+    // can be; capped at half a frame so Precise mode always sleeps.
+    std::chrono::microseconds worst{0};
+    for (int i = 0; i < kSlackSamples; ++i) {
+        const auto before = Clock::now();
+        std::this_thread::sleep_for(kSlackProbe);
+        const auto overshoot =
+            std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - before) -
+            kSlackProbe;
+        worst = std::max(worst, overshoot);
+    }
+    return std::min(worst + kSlackMargin, targetFrameTime_ / 2);
+}
+
+void GameLoop::waitUntil(Clock::time_point deadline) const {
+    if (timing_.mode == TickTimingMode::Sleep) {
+        std::this_thread::sleep_until(deadline);
+        return;
+    }
+    const auto wakeAt = deadline - std::chrono::microseconds{timerSlackMicros_.load()};
+    if (Clock::now() < wakeAt) {
+        std::this_thread::sleep_until(wakeAt);
+    }
+    while (Clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+}
+
 TickMetrics GameLoop::executeTick() {
     auto frameStart = std::chrono::steady_clock::now();
 
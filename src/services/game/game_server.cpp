@@ -7,7 +7,11 @@
 #include "cgs/ecs/component_storage.hpp"
 #include "cgs/ecs/entity.hpp"
 #include "cgs/ecs/entity_manager.hpp"
+#include "cgs/ecs/query.hpp"
+#include "cgs/ecs/system_profiler.hpp"
 #include "cgs/ecs/system_scheduler.hpp"
+#include "cgs/ecs/work_stealing_executor.hpp"
+#include "cgs/foundation/alloc_tracker.hpp"
 #include "cgs/foundation/error_code.hpp"
 #include "cgs/foundation/game_error.hpp"
 #include "cgs/foundation/game_metrics.hpp"
@@ -26,9 +30,19 @@
 #include "cgs/service/game_loop.hpp"
 #include "cgs/service/map_instance_manager.hpp"
 
+#include <algorithm>
 #include <atomic>
+#include <cctype>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace cgs::service {
 
@@ -37,14 +51,33 @@ using cgs::foundation::GameError;
 using cgs::foundation::GameResult;
 using cgs::foundation::PlayerId;
 
-// -- Impl --------------------------------------------------------------------
+// -- World -------------------------------------------------------------------
 
-struct GameServer::Impl {
-    GameServerConfig config;
+namespace {
+
+/// Components carried by a player moving between worlds.
+struct PlayerState {
+    std::optional<cgs::game::Transform> transform;
+    std::optional<cgs::game::Identity> identity;
+    std::optional<cgs::game::Stats> stats;
+    std::optional<cgs::game::Movement> movement;
+    std::optional<cgs::game::QuestLog> questLog;
+    std::optional<cgs::game::Inventory> inventory;
+    std::optional<cgs::game::Equipment> equipment;
+};
+
+/// One ECS world: entities, component storages and the six game systems
+/// for the instances assigned to it.  Only one thread touches a world at
+/// a time; other worlds reach it through post().
+struct GameWorld {
+    // Storages are registered up front so entities destroyed before the
+    // first tick still release their components.
+    explicit GameWorld(const GameServerConfig& cfg) : config(cfg) { registerStorages(); }
+
+    const GameServerConfig& config;
 
     // ECS core
     cgs::ecs::EntityManager entities;
-    cgs::ecs::SystemScheduler scheduler;
 
     // Component storages (core)
     cgs::ecs::ComponentStorage<cgs::game::Transform> transforms;
@@ -63,6 +96,7 @@ struct GameServer::Impl {
     cgs::ecs::ComponentStorage<cgs::game::AuraHolder> auraHolders;
     cgs::ecs::ComponentStorage<cgs::game::DamageEvent> damageEvents;
     cgs::ecs::ComponentStorage<cgs::game::ThreatList> threatLists;
+    cgs::ecs::ComponentStorage<cgs::game::AbilityCooldowns> abilityCooldowns;
 
     // Component storages (AI)
     cgs::ecs::ComponentStorage<cgs::game::AIBrain> aiBrains;
@@ -76,23 +110,33 @@ struct GameServer::Impl {
     cgs::ecs::ComponentStorage<cgs::game::Equipment> equipment;
     cgs::ecs::ComponentStorage<cgs::game::DurabilityEvent> durabilityEvents;
 
-    // Service-level components
-    GameLoop gameLoop;
-    MapInstanceManager instanceManager;
+    // Event channels, published by the scheduler at stage boundaries.
+    // Damage from completed casts (resolveCasts()); quest and durability
+    // events still arrive as components until something publishes them.
+    cgs::ecs::EventChannel<cgs::game::DamageEvent> damageChannel;
 
-    // Player session tracking
-    mutable std::mutex playerMutex;
-    std::unordered_map<PlayerId, PlayerSession> playerSessions;
+    // Declared after the storages and channels its systems listen to, so
+    // it is destroyed first.
+    cgs::ecs::SystemProfiler profiler;
+    cgs::ecs::SystemScheduler scheduler;
+
+    // Owned by the scheduler; set by registerSystems().
+    cgs::game::WorldSystem* worldSystem = nullptr;
+    cgs::game::CombatSystem* combatSystem = nullptr;
+
+    // Completed casts sent as damage events (GameServerStats::spellHits).
+    std::atomic<uint64_t> spellHits{0};
 
     // Instance ID → map entity mapping (avoids scanning component storage).
     std::unordered_map<uint32_t, cgs::ecs::Entity> instanceEntities;
 
-    // Counters
-    std::atomic<uint64_t> playersJoined{0};
-    std::atomic<uint64_t> playersLeft{0};
+    // Messages from other threads, run at the start of this world's tick.
+    std::mutex inboxMutex;
+    std::vector<std::function<void(GameWorld&)>> inbox;
+    std::vector<std::function<void(GameWorld&)>> running;
 
-    explicit Impl(GameServerConfig cfg)
-        : config(std::move(cfg)), gameLoop(config.tickRate), instanceManager(config.maxInstances) {}
+    // Delta time of the tick in progress (read by the pool task).
+    float tickDt = 0.0f;
 
     /// Register all component storages with the EntityManager for
     /// automatic cleanup on entity destruction.
@@ -109,6 +153,7 @@ struct GameServer::Impl {
         entities.RegisterStorage(&auraHolders);
         entities.RegisterStorage(&damageEvents);
         entities.RegisterStorage(&threatLists);
+        entities.RegisterStorage(&abilityCooldowns);
         entities.RegisterStorage(&aiBrains);
         entities.RegisterStorage(&questLogs);
         entities.RegisterStorage(&questEvents);
@@ -120,14 +165,19 @@ struct GameServer::Impl {
     /// Register all 6 game systems with the scheduler.
     [[nodiscard]] bool registerSystems() {
         // PreUpdate stage
-        scheduler.Register<cgs::game::WorldSystem>(
+        auto& world = scheduler.Register<cgs::game::WorldSystem>(
             transforms, memberships, mapInstances, visibilityRanges, zones, config.spatialCellSize);
+        world.SetSpatialReorder(config.spatialReorderPerTick);
+        worldSystem = &world;
 
         // Update stage
         scheduler.Register<cgs::game::ObjectUpdateSystem>(transforms, movements);
 
-        scheduler.Register<cgs::game::CombatSystem>(
+        auto& combat = scheduler.Register<cgs::game::CombatSystem>(
             spellCasts, auraHolders, damageEvents, stats, threatLists);
+        combat.SetDamageChannel(&damageChannel);
+        combat.SetCooldowns(&abilityCooldowns);
+        combatSystem = &combat;
 
         scheduler.Register<cgs::game::AISystem>(
             aiBrains, transforms, movements, stats, threatLists, config.aiTickInterval);
@@ -137,9 +187,62 @@ struct GameServer::Impl {
 
         scheduler.Register<cgs::game::InventorySystem>(inventories, equipment, durabilityEvents);
 
+        scheduler.AddEventChannel(damageChannel);
+
+        scheduler.SetProfiler(&profiler);
         return scheduler.Build();
     }
 
+    /// Queue @p message to run on this world's thread at its next tick.
+    void post(std::function<void(GameWorld&)> message) {
+        std::lock_guard lock(inboxMutex);
+        inbox.push_back(std::move(message));
+    }
+
+    /// Run queued messages, then the systems.
+    void tick(float dt) {
+        {
+            std::lock_guard lock(inboxMutex);
+            running.swap(inbox);
+        }
+        for (auto& message : running) {
+            message(*this);
+        }
+        running.clear();
+
+        scheduler.Execute(dt);
+        resolveCasts();
+        entities.FlushDeferred();
+    }
+
+    /// Send a damage event for each cast completed this tick whose spell
+    /// is in config.spellDamage; CombatSystem resolves them next tick.
+    void resolveCasts() {
+        if (combatSystem == nullptr || config.spellDamage.empty()) {
+            return;
+        }
+        for (const auto& completion : combatSystem->CastCompletions()) {
+            auto spell = config.spellDamage.find(completion.spellId);
+            if (spell == config.spellDamage.end() || !entities.IsAlive(completion.target) ||
+                !stats.Has(completion.target)) {
+                continue;
+            }
+            cgs::game::DamageEvent hit;
+            hit.attacker = completion.caster;
+            hit.victim = completion.target;
+            hit.type = spell->second.type;
+            hit.baseDamage = spell->second.baseDamage;
+            damageChannel.Send(hit);
+            spellHits.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /// WorkStealingExecutor entry point.
+    static void tickTask(void* context) {
+        auto* self = static_cast<GameWorld*>(context);
+        self->tick(self->tickDt);
+    }
+
     /// Find the map entity for a given instanceId.
     std::optional<cgs::ecs::Entity> findMapEntity(uint32_t instanceId) const {
         auto it = instanceEntities.find(instanceId);
@@ -148,6 +251,1225 @@ struct GameServer::Impl {
         }
         return it->second;
     }
+
+    /// Move @p entity to the map @p mapEntity of this world, keeping its
+    /// position.  Goes through WorldSystem::TransferEntity() so the old
+    /// map's spatial index drops the entity at once.
+    void moveToMap(cgs::ecs::Entity entity, cgs::ecs::Entity mapEntity) {
+        if (!memberships.Has(entity)) {
+            return;
+        }
+        if (worldSystem != nullptr && transforms.Has(entity)) {
+            (void)worldSystem->TransferEntity(entity, mapEntity, transforms.Get(entity).position);
+        } else {
+            auto& membership = memberships.Get(entity);
+            membership.mapEntity = mapEntity;
+            membership.zoneId = 0;
+        }
+        memberships.MarkChanged(entity);
+    }
+
+    /// Copy a player's components out and destroy the entity.
+    PlayerState extractPlayer(cgs::ecs::Entity entity) {
+        PlayerState state;
+        if (!entities.IsAlive(entity)) {
+            return state;
+        }
+        auto take = [entity](auto& storage, auto& slot) {
+            if (storage.Has(entity)) {
+                slot = std::move(storage.Get(entity));
+            }
+        };
+        take(transforms, state.transform);
+        take(identities, state.identity);
+        take(stats, state.stats);
+        take(movements, state.movement);
+        take(questLogs, state.questLog);
+        take(inventories, state.inventory);
+        take(equipment, state.equipment);
+        entities.Destroy(entity);
+        return state;
+    }
+
+    /// Create a player entity from @p state on the map @p mapEntity.
+    cgs::ecs::Entity insertPlayer(PlayerState&& state, cgs::ecs::Entity mapEntity) {
+        auto entity = entities.Create();
+        auto put = [entity](auto& storage, auto& slot) {
+            if (slot.has_value()) {
+                storage.Add(entity, std::move(*slot));
+            }
+        };
+        put(transforms, state.transform);
+        put(identities, state.identity);
+        put(stats, state.stats);
+        put(movements, state.movement);
+        put(questLogs, state.questLog);
+        put(inventories, state.inventory);
+        put(equipment, state.equipment);
+        addCaster(entity);
+
+        cgs::game::MapMembership membership;
+        membership.mapEntity = mapEntity;
+        memberships.Add(entity, membership);
+        return entity;
+    }
+
+    /// Let the player entity @p entity cast abilities (useAbility()).
+    /// Casts and cooldowns in progress do not survive a move between
+    /// worlds.
+    void addCaster(cgs::ecs::Entity entity) {
+        spellCasts.Add(entity);
+        abilityCooldowns.Add(entity);
+    }
+
+    /// Give the new player entity @p entity the components of
+    /// @p character on the map @p mapEntity.
+    void spawnPlayer(cgs::ecs::Entity entity,
+                     const CharacterData& character,
+                     cgs::ecs::Entity mapEntity) {
+        transforms.Add(entity, character.transform);
+
+        cgs::game::Identity identity;
+        identity.guid = cgs::game::GenerateGUID();
+        identity.name = character.name;
+        identity.type = cgs::game::ObjectType::Player;
+        identities.Add(entity, std::move(identity));
+
+        stats.Add(entity, character.stats);
+
+        cgs::game::Movement movement;
+        movement.baseSpeed = character.speed;
+        movement.speed = character.speed;
+        movements.Add(entity, movement);
+
+        cgs::game::MapMembership membership;
+        membership.mapEntity = mapEntity;
+        memberships.Add(entity, membership);
+
+        questLogs.Add(entity);
+
+        cgs::game::Inventory inventory;
+        inventory.Initialize();
+        inventories.Add(entity, std::move(inventory));
+
+        equipment.Add(entity);
+        addCaster(entity);
+    }
+
+    /// Store @p value as @p entity's component, adding it or replacing
+    /// the current one.  Either way the component version is bumped, so
+    /// change-filtered systems (WorldSystem's position sync) see it.
+    template <typename T>
+    static void assign(cgs::ecs::ComponentStorage<T>& storage, cgs::ecs::Entity entity, T&& value) {
+        if (storage.Has(entity)) {
+            storage.Replace(entity, std::move(value));
+        } else {
+            storage.Add(entity, std::move(value));
+        }
+    }
+
+    /// Make @p entity a fresh copy of @p npc on the map @p mapEntity,
+    /// dropping any combat state it picked up.
+    void applyNpc(cgs::ecs::Entity entity, const InstanceNpc& npc, cgs::ecs::Entity mapEntity) {
+        assign(transforms, entity, cgs::game::Transform(npc.transform));
+        cgs::game::Identity identity = npc.identity;
+        identity.guid = cgs::game::GenerateGUID();
+        assign(identities, entity, std::move(identity));
+        assign(stats, entity, cgs::game::Stats(npc.stats));
+        assign(movements, entity, cgs::game::Movement(npc.movement));
+
+        cgs::game::MapMembership membership;
+        membership.mapEntity = mapEntity;
+        assign(memberships, entity, std::move(membership));
+
+        if (npc.brain.has_value()) {
+            assign(aiBrains, entity, cgs::game::AIBrain(*npc.brain));
+        } else if (aiBrains.Has(entity)) {
+            aiBrains.Remove(entity);
+        }
+        auto drop = [entity](auto& storage) {
+            if (storage.Has(entity)) {
+                storage.Remove(entity);
+            }
+        };
+        drop(spellCasts);
+        drop(auraHolders);
+        drop(threatLists);
+    }
+};
+
+/// Join and leave queues.  Shared with CharacterLoader callbacks, which
+/// may outlive the server.
+struct JoinPipeline {
+    struct Loaded {
+        PlayerId playerId;
+        uint32_t instanceId = 0;
+        CharacterData character;
+    };
+
+    mutable std::mutex mutex;
+    CharacterLoader loader;
+    std::unordered_map<PlayerId, uint32_t> loading;  // -> instanceId
+    std::deque<Loaded> queued;
+    std::unordered_set<PlayerId> queuedIds;
+    std::vector<std::pair<PlayerId, ErrorCode>> failed;  // reported next tick
+    std::deque<PlayerId> leaves;
+
+    /// Caller holds mutex.
+    [[nodiscard]] bool pendingLocked(PlayerId playerId) const {
+        return loading.contains(playerId) || queuedIds.contains(playerId);
+    }
+
+    /// Drop a join in progress.  Caller holds mutex.
+    bool cancelLocked(PlayerId playerId) {
+        if (loading.erase(playerId) > 0) {
+            return true;  // The load's result is ignored when it arrives.
+        }
+        if (queuedIds.erase(playerId) == 0) {
+            return false;
+        }
+        std::erase_if(queued, [playerId](const Loaded& join) { return join.playerId == playerId; });
+        return true;
+    }
+
+    /// CharacterLoader callback, on any thread.
+    void loaded(PlayerId playerId, GameResult<CharacterData> result) {
+        std::lock_guard lock(mutex);
+        auto it = loading.find(playerId);
+        if (it == loading.end()) {
+            return;  // Cancelled.
+        }
+        const uint32_t instanceId = it->second;
+        loading.erase(it);
+        if (result.hasError()) {
+            failed.emplace_back(playerId, result.error().code());
+            return;
+        }
+        queued.push_back({playerId, instanceId, std::move(result.value())});
+        queuedIds.insert(playerId);
+    }
+};
+
+/// An instance cloned from an InstanceTemplate and the entities it owns.
+struct TemplatedInstance {
+    uint32_t mapId = 0;
+    GameWorld* world = nullptr;
+    cgs::ecs::Entity mapEntity;
+    std::vector<cgs::ecs::Entity> zones;
+    std::vector<cgs::ecs::Entity> npcs;
+
+    /// Create the map entity, zones and NPCs of @p tmpl in @p world, all
+    /// template entities in one CreateMany block.
+    void clone(const InstanceTemplate& tmpl, uint32_t instanceId) {
+        mapEntity = world->entities.Create();
+        cgs::game::MapInstance comp;
+        comp.mapId = mapId;
+        comp.instanceId = instanceId;
+        comp.type = tmpl.type;
+        world->mapInstances.Add(mapEntity, comp);
+
+        std::vector<cgs::ecs::Entity> created;
+        world->entities.CreateMany(tmpl.zones.size() + tmpl.npcs.size(), created);
+        const auto split = created.begin() + static_cast<std::ptrdiff_t>(tmpl.zones.size());
+        zones.assign(created.begin(), split);
+        npcs.assign(split, created.end());
+
+        for (std::size_t i = 0; i < zones.size(); ++i) {
+            cgs::game::Zone zone = tmpl.zones[i];
+            zone.mapEntity = mapEntity;
+            world->zones.Add(zones[i], zone);
+        }
+        for (std::size_t i = 0; i < npcs.size(); ++i) {
+            world->applyNpc(npcs[i], tmpl.npcs[i], mapEntity);
+        }
+    }
+
+    /// Put every NPC back to its template state, respawning killed ones.
+    void reset(const InstanceTemplate& tmpl) {
+        for (std::size_t i = 0; i < npcs.size(); ++i) {
+            if (!world->entities.IsAlive(npcs[i])) {
+                npcs[i] = world->entities.Create();
+            }
+            world->applyNpc(npcs[i], tmpl.npcs[i], mapEntity);
+        }
+    }
+
+    /// Destroy the zones and NPCs (the map entity goes with the instance).
+    void destroyContents() {
+        world->entities.DestroyMany(zones);
+        world->entities.DestroyMany(npcs);
+    }
+};
+
+}  // anonymous namespace
+
+// -- Impl --------------------------------------------------------------------
+
+struct GameServer::Impl {
+    GameServerConfig config;
+
+    // One world per shard; instances are spread across them.
+    std::vector<std::unique_ptr<GameWorld>> worlds;
+
+    // Ticks the worlds in parallel when there is more than one.
+    std::unique_ptr<cgs::ecs::WorkStealingExecutor> worldPool;
+    std::vector<cgs::ecs::WorkStealingExecutor::Task> worldTasks;
+
+    bool built = false;
+
+    // Per-system duration histogram names, keyed by system type.
+    std::unordered_map<cgs::ecs::SystemTypeId, std::string> systemHistograms;
+
+    // Flight recorder ids, keyed by system type, and the tick being
+    // filled (reused so recording does not allocate).
+    std::unordered_map<cgs::ecs::SystemTypeId, uint16_t> flightSystems;
+    FlightTick flightTick;
+
+    // Query cache totals already published (see publishQueryCacheStats).
+    cgs::ecs::QueryCacheStats publishedQueryStats;
+
+    // Allocation counter names and totals already published, by tag
+    // (see publishAllocations).
+    struct AllocMetric {
+        std::string allocations;
+        std::string bytes;
+        cgs::foundation::AllocCounts published;
+    };
+    std::vector<AllocMetric> allocMetrics;
+
+    // Coroutines waiting for the game thread (drained each tick).
+    cgs::foundation::ResumeQueue resumeQueue;
+
+    // Service-level components
+    GameLoop gameLoop;
+    MapInstanceManager instanceManager;
+    FlightRecorder flightRecorder;
+
+    // Player session tracking
+    mutable std::mutex playerMutex;
+    std::unordered_map<PlayerId, PlayerSession> playerSessions;
+
+    // Instance ID → owning world.
+    std::unordered_map<uint32_t, GameWorld*> instanceWorlds;
+
+    // Pre-built instances of one map.  Refills and resets run as world
+    // messages, so pools and templated are shared with the world threads.
+    struct InstancePool {
+        std::shared_ptr<const InstanceTemplate> tmpl;
+        std::vector<uint32_t> ready;  // Pooled, ready to acquire
+        uint32_t resetting = 0;       // released, reset queued
+        bool refilling = false;       // a build is queued
+    };
+
+    mutable std::mutex poolMutex;
+    std::unordered_map<uint32_t, InstancePool> pools;             // by mapId
+    std::unordered_map<uint32_t, TemplatedInstance> templated;  // by instanceId
+    std::atomic<std::size_t> nextPoolWorld{0};
+
+    // Queued joins and leaves, drained at the start of each tick.
+    std::shared_ptr<JoinPipeline> joins = std::make_shared<JoinPipeline>();
+    cgs::foundation::Signal<PlayerId, ErrorCode> joinFinished;
+
+    // Instances streaming to another server: the encoding of each entity
+    // as last sent, so deltas carry only what changed.
+    struct MigrationExport {
+        uint64_t sequence = 0;  // of the next chunk
+        std::unordered_map<uint32_t, std::vector<uint8_t>> sent;
+    };
+
+    // Instances streaming in: source entity key -> local entity.
+    struct MigrationImport {
+        struct Local {
+            cgs::ecs::Entity entity;
+            MigratedKind kind = MigratedKind::Npc;
+            PlayerId playerId;
+        };
+        uint64_t sequence = 0;  // expected next chunk
+        std::unordered_map<uint32_t, Local> entities;
+    };
+
+    std::mutex migrationMutex;
+    std::unordered_map<uint32_t, MigrationExport> exports;  // by instanceId
+    std::unordered_map<uint32_t, MigrationImport> imports;  // by instanceId
+
+    // Contents of a hibernating instance, paged out of its world.
+    struct HibernatedInstance {
+        std::vector<uint8_t> snapshot;                            // encodeMigrationChunk()
+        std::unordered_map<uint32_t, cgs::game::AIBrain> brains;  // by snapshot key
+        std::chrono::steady_clock::time_point since;
+    };
+
+    // By instanceId.  Guarded by playerMutex, which every path that wakes
+    // an instance (a player entering it) already holds.
+    std::unordered_map<uint32_t, HibernatedInstance> hibernated;
+
+    // Counters
+    std::atomic<uint64_t> playersJoined{0};
+    std::atomic<uint64_t> playersLeft{0};
+    std::atomic<uint64_t> crossWorldTransfers{0};
+
+    explicit Impl(GameServerConfig cfg)
+        : config(std::move(cfg)),
+          gameLoop(config.tickRate),
+          instanceManager(config.maxInstances),
+          flightRecorder(config.flightRecorder) {
+        flightTick.systems.reserve(config.flightRecorder.maxSystemsPerTick);
+        (void)gameLoop.setAffinity(config.gameThreadCpus);  // Not running yet: cannot fail
+        (void)gameLoop.setTiming(config.tickTiming);
+
+        const uint32_t count = std::max<uint32_t>(config.worldShards, 1);
+        worlds.reserve(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            worlds.push_back(std::make_unique<GameWorld>(config));
+        }
+        if (count > 1) {
+            // The tick thread runs worlds too, so one fewer worker.
+            worldPool = std::make_unique<cgs::ecs::WorkStealingExecutor>(std::min<std::size_t>(
+                count - 1, cgs::ecs::WorkStealingExecutor::DefaultWorkerCount()));
+            for (auto& world : worlds) {
+                worldTasks.push_back({&GameWorld::tickTask, world.get()});
+            }
+        }
+    }
+
+    /// Wire storages and systems in every world (once).
+    [[nodiscard]] bool build() {
+        if (built) {
+            return true;
+        }
+        for (auto& world : worlds) {
+            if (!world->registerSystems()) {
+                return false;
+            }
+        }
+
+        // Every world registers the same systems: name them from the first.
+        static constexpr cgs::ecs::SystemStage kStages[] = {
+            cgs::ecs::SystemStage::PreUpdate,
+            cgs::ecs::SystemStage::Update,
+            cgs::ecs::SystemStage::PostUpdate,
+            cgs::ecs::SystemStage::FixedUpdate,
+        };
+        const auto& first = *worlds.front();
+        for (auto stage : kStages) {
+            for (auto id : first.scheduler.GetExecutionOrder(stage)) {
+                systemHistograms[id] =
+                    "cgs_system_" + metricName(first.profiler.SystemName(id)) + "_ms";
+                flightSystems[id] = flightRecorder.registerSystem(first.profiler.SystemName(id));
+            }
+        }
+        built = true;
+        return true;
+    }
+
+    /// Error for a failed build(), naming the first failing scheduler.
+    GameError buildError() const {
+        std::string reason;
+        for (const auto& world : worlds) {
+            if (!world->scheduler.GetLastError().empty()) {
+                reason = world->scheduler.GetLastError();
+                break;
+            }
+        }
+        return GameError(ErrorCode::SystemSchedulerBuildFailed,
+                         "failed to build system scheduler: " + reason);
+    }
+
+    /// One game tick: resume coroutines, process queued leaves and joins,
+    /// then every world.
+    void tickWorlds(float dt) {
+        resumeQueue.drain();
+        drainPlayerQueues();
+        hibernateIdle();
+        if (!worldPool) {
+            worlds.front()->tick(dt);
+            return;
+        }
+        for (auto& world : worlds) {
+            world->tickDt = dt;
+        }
+        worldPool->Run(worldTasks);
+    }
+
+    /// Create a player entity for @p character in @p instanceId.  Caller
+    /// holds playerMutex.
+    GameResult<cgs::ecs::Entity> addPlayerLocked(PlayerId playerId,
+                                                 uint32_t instanceId,
+                                                 const CharacterData& character) {
+        auto mapEntity = reservePlayerSlotLocked(playerId, instanceId);
+        if (mapEntity.hasError()) {
+            return GameResult<cgs::ecs::Entity>::err(mapEntity.error());
+        }
+        auto* world = worldOf(instanceId);
+        auto entity = world->entities.Create();
+        world->spawnPlayer(entity, character, mapEntity.value());
+        recordSessionLocked(playerId, instanceId, entity);
+        return GameResult<cgs::ecs::Entity>::ok(entity);
+    }
+
+    /// Check @p playerId can join @p instanceId and take a slot in it.
+    /// Returns the instance's map entity.  Caller holds playerMutex.
+    GameResult<cgs::ecs::Entity> reservePlayerSlotLocked(PlayerId playerId, uint32_t instanceId) {
+        // Check for duplicate player.
+        if (playerSessions.contains(playerId)) {
+            return GameResult<cgs::ecs::Entity>::err(
+                GameError(ErrorCode::PlayerAlreadyInWorld, "player is already in the world"));
+        }
+
+        // Verify instance exists and can accept players.
+        if (!instanceManager.getInstance(instanceId).has_value()) {
+            return GameResult<cgs::ecs::Entity>::err(
+                GameError(ErrorCode::MapInstanceNotFound, "map instance not found"));
+        }
+        (void)wakeLocked(instanceId);  // No-op unless hibernating.
+
+        if (!instanceManager.addPlayer(instanceId)) {
+            return GameResult<cgs::ecs::Entity>::err(
+                GameError(ErrorCode::InstanceFull, "map instance is full or not active"));
+        }
+
+        // Find the map entity for this instance.
+        auto* world = worldOf(instanceId);
+        auto mapEntity = world != nullptr ? world->findMapEntity(instanceId) : std::nullopt;
+        if (!mapEntity.has_value()) {
+            // Rollback the addPlayer counter.
+            (void)instanceManager.removePlayer(instanceId);
+            return GameResult<cgs::ecs::Entity>::err(
+                GameError(ErrorCode::MapInstanceNotFound, "map entity not found in ECS"));
+        }
+        return GameResult<cgs::ecs::Entity>::ok(*mapEntity);
+    }
+
+    /// Record the session of a player who just joined.  Caller holds
+    /// playerMutex.
+    void recordSessionLocked(PlayerId playerId, uint32_t instanceId, cgs::ecs::Entity entity) {
+        PlayerSession session;
+        session.playerId = playerId;
+        session.entity = entity;
+        session.instanceId = instanceId;
+        playerSessions.emplace(playerId, session);
+        playersJoined.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// Entities to destroy, grouped by world.
+    using EntitiesByWorld = std::unordered_map<GameWorld*, std::vector<cgs::ecs::Entity>>;
+
+    /// Remove a player from the world.  The entity is destroyed at once,
+    /// or appended to @p released for the caller to destroy in a batch.
+    /// Caller holds playerMutex.
+    GameResult<void> removePlayerLocked(PlayerId playerId, EntitiesByWorld* released = nullptr) {
+        auto it = playerSessions.find(playerId);
+        if (it == playerSessions.end()) {
+            return GameResult<void>::err(
+                GameError(ErrorCode::PlayerNotInWorld, "player is not in the world"));
+        }
+
+        auto session = it->second;
+        playerSessions.erase(it);
+
+        // Release the instance slot.
+        (void)instanceManager.removePlayer(session.instanceId);
+
+        // Destroy the entity (storages auto-cleanup components).  An entity in
+        // transit is dropped by the target world when it arrives.
+        if (!session.inTransit) {
+            if (auto* world = worldOf(session.instanceId)) {
+                if (released != nullptr) {
+                    (*released)[world].push_back(session.entity);
+                } else {
+                    world->entities.Destroy(session.entity);
+                }
+            }
+        }
+
+        playersLeft.fetch_add(1, std::memory_order_relaxed);
+        return GameResult<void>::ok();
+    }
+
+    /// Start of a tick: run queued leaves, then queued joins, each up to
+    /// its per-tick budget, and report the joins that ended.
+    void drainPlayerQueues() {
+        std::vector<PlayerId> leaves;
+        std::vector<JoinPipeline::Loaded> loaded;
+        std::vector<std::pair<PlayerId, ErrorCode>> finished;
+        std::size_t waiting = 0;
+        {
+            std::lock_guard lock(joins->mutex);
+            const std::size_t leaveBudget =
+                config.leavesPerTick == 0 ? joins->leaves.size() : config.leavesPerTick;
+            while (!joins->leaves.empty() && leaves.size() < leaveBudget) {
+                leaves.push_back(joins->leaves.front());
+                joins->leaves.pop_front();
+            }
+            const std::size_t joinBudget =
+                config.joinsPerTick == 0 ? joins->queued.size() : config.joinsPerTick;
+            while (!joins->queued.empty() && loaded.size() < joinBudget) {
+                joins->queuedIds.erase(joins->queued.front().playerId);
+                loaded.push_back(std::move(joins->queued.front()));
+                joins->queued.pop_front();
+            }
+            finished.swap(joins->failed);
+            waiting = joins->loading.size() + joins->queued.size();
+        }
+
+        if (!leaves.empty() || !loaded.empty()) {
+            std::lock_guard lock(playerMutex);
+            EntitiesByWorld released;
+            for (const auto playerId : leaves) {
+                // Fails only if already gone.
+                (void)removePlayerLocked(playerId, &released);
+            }
+            // One DestroyMany per world, mirroring materializeLocked()'s
+            // CreateMany, before the joins can reuse the indices.
+            for (const auto& [world, entities] : released) {
+                world->entities.DestroyMany(entities);
+            }
+            materializeLocked(loaded, finished);
+            cgs::foundation::GameMetrics::instance().setGauge(
+                "cgs_ccu", static_cast<double>(playerSessions.size()));
+        }
+        cgs::foundation::GameMetrics::instance().setGauge("cgs_join_queue_depth",
+                                                          static_cast<double>(waiting));
+
+        for (const auto& [playerId, code] : finished) {
+            joinFinished.emit(playerId, code);
+        }
+    }
+
+    /// Create the players of @p loaded, one CreateMany block per world,
+    /// appending each outcome to @p finished.  Caller holds playerMutex.
+    void materializeLocked(std::vector<JoinPipeline::Loaded>& loaded,
+                           std::vector<std::pair<PlayerId, ErrorCode>>& finished) {
+        struct Spawn {
+            JoinPipeline::Loaded* join;
+            cgs::ecs::Entity mapEntity;
+        };
+        std::unordered_map<GameWorld*, std::vector<Spawn>> byWorld;
+        for (auto& join : loaded) {
+            auto mapEntity = reservePlayerSlotLocked(join.playerId, join.instanceId);
+            if (mapEntity.hasError()) {
+                finished.emplace_back(join.playerId, mapEntity.error().code());
+                continue;
+            }
+            byWorld[worldOf(join.instanceId)].push_back({&join, mapEntity.value()});
+        }
+
+        std::vector<cgs::ecs::Entity> created;
+        for (auto& [world, spawns] : byWorld) {
+            created.clear();
+            world->entities.CreateMany(spawns.size(), created);
+            for (std::size_t i = 0; i < spawns.size(); ++i) {
+                const auto& join = *spawns[i].join;
+                world->spawnPlayer(created[i], join.character, spawns[i].mapEntity);
+                recordSessionLocked(join.playerId, join.instanceId, created[i]);
+                finished.emplace_back(join.playerId, ErrorCode::Success);
+            }
+        }
+    }
+
+    /// World owning @p instanceId, or nullptr.
+    GameWorld* worldOf(uint32_t instanceId) const {
+        auto it = instanceWorlds.find(instanceId);
+        return it == instanceWorlds.end() ? nullptr : it->second;
+    }
+
+    /// World with the fewest instances (the first on ties).
+    GameWorld& leastLoadedWorld() const {
+        GameWorld* best = worlds.front().get();
+        for (const auto& world : worlds) {
+            if (world->instanceEntities.size() < best->instanceEntities.size()) {
+                best = world.get();
+            }
+        }
+        return *best;
+    }
+
+    /// Clone @p tmpl into @p world as a new Pooled instance of @p mapId.
+    GameResult<uint32_t> buildTemplated(GameWorld& world,
+                                        uint32_t mapId,
+                                        const InstanceTemplate& tmpl) {
+        auto result = instanceManager.createInstance(
+            mapId, tmpl.type, tmpl.maxPlayers, InstanceState::Pooled);
+        if (result.hasError()) {
+            return result;
+        }
+        TemplatedInstance instance;
+        instance.mapId = mapId;
+        instance.world = &world;
+        instance.clone(tmpl, result.value());
+
+        std::lock_guard lock(poolMutex);
+        templated.emplace(result.value(), std::move(instance));
+        return result;
+    }
+
+    /// Queue a build for @p pool if it is short and none is queued.
+    /// Caller holds poolMutex.
+    void refillLocked(uint32_t mapId, InstancePool& pool) {
+        if (pool.refilling || pool.ready.size() + pool.resetting >= pool.tmpl->warmCount) {
+            return;
+        }
+        pool.refilling = true;
+        // Spread pooled instances over the worlds.
+        auto& world = *worlds[nextPoolWorld.fetch_add(1) % worlds.size()];
+        world.post([this, mapId](GameWorld& w) { refillStep(w, mapId); });
+    }
+
+    /// Runs on a world: build one instance for the pool of @p mapId and,
+    /// while it is still short, queue the next for a later tick.
+    void refillStep(GameWorld& world, uint32_t mapId) {
+        std::shared_ptr<const InstanceTemplate> tmpl;
+        {
+            std::lock_guard lock(poolMutex);
+            auto& pool = pools.at(mapId);
+            // Releases since this was queued may have filled the pool.
+            if (pool.ready.size() + pool.resetting >= pool.tmpl->warmCount) {
+                pool.refilling = false;
+                return;
+            }
+            tmpl = pool.tmpl;
+        }
+        auto built = buildTemplated(world, mapId, *tmpl);
+
+        std::lock_guard lock(poolMutex);
+        auto& pool = pools.at(mapId);
+        pool.refilling = false;
+        if (built.hasError()) {
+            return;  // Instance limit: the next acquire or release retries.
+        }
+        pool.ready.push_back(built.value());
+        refillLocked(mapId, pool);
+    }
+
+    /// Runs on the instance's world: restore a released instance and put
+    /// it back in its pool.
+    void resetStep(uint32_t instanceId) {
+        // Nothing else touches a resetting instance, and map nodes are
+        // stable, so the reset itself runs unlocked.
+        TemplatedInstance* instance = nullptr;
+        std::shared_ptr<const InstanceTemplate> tmpl;
+        {
+            std::lock_guard lock(poolMutex);
+            instance = &templated.at(instanceId);
+            tmpl = pools.at(instance->mapId).tmpl;
+        }
+        instance->reset(*tmpl);
+
+        std::lock_guard lock(poolMutex);
+        auto& pool = pools.at(instance->mapId);
+        --pool.resetting;
+        pool.ready.push_back(instanceId);
+    }
+
+    /// Runs on the target world: hand the arrived entity to the session,
+    /// or drop it if the player left or moved on meanwhile.
+    void completeTransfer(GameWorld& world,
+                          PlayerId playerId,
+                          uint32_t instanceId,
+                          cgs::ecs::Entity entity) {
+        std::lock_guard lock(playerMutex);
+        auto it = playerSessions.find(playerId);
+        if (it == playerSessions.end() || it->second.instanceId != instanceId) {
+            world.entities.Destroy(entity);
+            return;
+        }
+        it->second.entity = entity;
+        it->second.inTransit = false;
+    }
+
+    /// Zones and map members of @p instanceId in @p world, keyed by entity
+    /// id.  Players in transit are skipped.
+    std::vector<MigratedEntity> collectInstance(GameWorld& world, uint32_t instanceId) {
+        std::unordered_map<uint32_t, PlayerId> players;  // entity id -> player
+        {
+            std::lock_guard lock(playerMutex);
+            for (const auto& [playerId, session] : playerSessions) {
+                if (session.instanceId == instanceId && !session.inTransit) {
+                    players.emplace(session.entity.id(), playerId);
+                }
+            }
+        }
+        return collectEntities(world, instanceId, players);
+    }
+
+    /// collectInstance() with the instance's players, by entity id, given.
+    std::vector<MigratedEntity> collectEntities(
+        GameWorld& world,
+        uint32_t instanceId,
+        const std::unordered_map<uint32_t, PlayerId>& players) {
+        const auto mapEntity = world.findMapEntity(instanceId).value_or(cgs::ecs::Entity{});
+        std::vector<MigratedEntity> records;
+        auto zone = world.zones.begin();
+        for (std::size_t i = 0; i < world.zones.Size(); ++i, ++zone) {
+            if (zone->mapEntity != mapEntity) {
+                continue;
+            }
+            MigratedEntity record;
+            record.key = world.zones.EntityAt(i);
+            record.kind = MigratedKind::Zone;
+            record.zoneId = zone->zoneId;
+            record.zoneType = zone->type;
+            record.zoneFlags = zone->flags;
+            records.push_back(std::move(record));
+        }
+
+        auto membership = world.memberships.begin();
+        for (std::size_t i = 0; i < world.memberships.Size(); ++i, ++membership) {
+            if (membership->mapEntity != mapEntity) {
+                continue;
+            }
+            // Storages index by id alone, so the version does not matter.
+            const cgs::ecs::Entity entity(world.memberships.EntityAt(i), 0);
+            MigratedEntity record;
+            record.key = entity.id();
+            record.memberZoneId = membership->zoneId;
+            if (auto it = players.find(record.key); it != players.end()) {
+                record.kind = MigratedKind::Player;
+                record.playerId = it->second.value();
+            }
+            auto copy = [entity](auto& storage, auto& field) {
+                if (storage.Has(entity)) {
+                    field = storage.Get(entity);
+                }
+            };
+            copy(world.transforms, record.transform);
+            copy(world.identities, record.identity);
+            copy(world.stats, record.stats);
+            copy(world.movements, record.movement);
+            record.hasBrain = world.aiBrains.Has(entity);
+            records.push_back(std::move(record));
+        }
+        return records;
+    }
+
+    /// Next chunk of an exporting instance: every entity whose encoding
+    /// differs from the one last sent, and those gone since.
+    InstanceMigrationChunk exportChunk(uint32_t instanceId, MigrationExport& state, bool final) {
+        const auto info = instanceManager.getInstance(instanceId);
+        InstanceMigrationChunk chunk;
+        chunk.sequence = state.sequence++;
+        chunk.final = final;
+        chunk.mapId = info->mapId;
+        chunk.type = info->type;
+        chunk.maxPlayers = info->maxPlayers;
+
+        std::unordered_map<uint32_t, std::vector<uint8_t>> current;
+        for (auto& record : collectInstance(*worldOf(instanceId), instanceId)) {
+            const uint32_t key = record.key;
+            std::vector<uint8_t> bytes;
+            encodeMigratedEntity(record, bytes);
+            auto it = state.sent.find(key);
+            if (it == state.sent.end() || it->second != bytes) {
+                chunk.upserts.push_back(std::move(record));
+            }
+            current.emplace(key, std::move(bytes));
+        }
+        for (const auto& [key, bytes] : state.sent) {
+            if (!current.contains(key)) {
+                chunk.removed.push_back(key);
+            }
+        }
+        std::sort(chunk.removed.begin(), chunk.removed.end());
+        state.sent = std::move(current);
+        return chunk;
+    }
+
+    /// Apply @p chunk to the importing instance @p instanceId.
+    void applyChunk(uint32_t instanceId, MigrationImport& state, InstanceMigrationChunk& chunk) {
+        auto& world = *worldOf(instanceId);
+        const auto mapEntity = *world.findMapEntity(instanceId);
+
+        for (const uint32_t key : chunk.removed) {
+            if (auto it = state.entities.find(key); it != state.entities.end()) {
+                world.entities.Destroy(it->second.entity);
+                state.entities.erase(it);
+            }
+        }
+
+        std::shared_ptr<const InstanceTemplate> tmpl;
+        {
+            std::lock_guard lock(poolMutex);
+            if (auto it = pools.find(chunk.mapId); it != pools.end()) {
+                tmpl = it->second.tmpl;
+            }
+        }
+
+        for (auto& record : chunk.upserts) {
+            auto& local = state.entities[record.key];
+            // A source id reused for another kind of entity starts over.
+            if (world.entities.IsAlive(local.entity) && local.kind != record.kind) {
+                world.entities.Destroy(local.entity);
+            }
+            const bool created = !world.entities.IsAlive(local.entity);
+            if (created) {
+                local.entity = world.entities.Create();
+            }
+            local.kind = record.kind;
+            local.playerId = PlayerId(record.playerId);
+            const auto entity = local.entity;
+
+            if (record.kind == MigratedKind::Zone) {
+                cgs::game::Zone zone;
+                zone.zoneId = record.zoneId;
+                zone.type = record.zoneType;
+                zone.flags = record.zoneFlags;
+                zone.mapEntity = mapEntity;
+                GameWorld::assign(world.zones, entity, std::move(zone));
+                continue;
+            }
+
+            // Assigned rather than written in place: an entity upserted by
+            // an earlier chunk must get new versions to be re-indexed.
+            GameWorld::assign(world.transforms, entity, std::move(record.transform));
+            GameWorld::assign(world.identities, entity, std::move(record.identity));
+            GameWorld::assign(world.stats, entity, std::move(record.stats));
+            GameWorld::assign(world.movements, entity, std::move(record.movement));
+            cgs::game::MapMembership membership;
+            membership.mapEntity = mapEntity;
+            membership.zoneId = record.memberZoneId;
+            GameWorld::assign(world.memberships, entity, std::move(membership));
+
+            if (record.kind == MigratedKind::Player) {
+                // Quests and items follow the player through persistence.
+                if (created) {
+                    world.questLogs.Add(entity);
+                    cgs::game::Inventory inventory;
+                    inventory.Initialize();
+                    world.inventories.Add(entity, std::move(inventory));
+                    world.equipment.Add(entity);
+                    world.addCaster(entity);
+                }
+                continue;
+            }
+
+            const InstanceNpc* source = nullptr;
+            if (record.hasBrain && tmpl) {
+                const auto entry = world.identities.Get(entity).entry;
+                for (const auto& npc : tmpl->npcs) {
+                    if (npc.brain.has_value() && npc.identity.entry == entry) {
+                        source = &npc;
+                        break;
+                    }
+                }
+            }
+            if (source != nullptr) {
+                if (!world.aiBrains.Has(entity)) {
+                    world.aiBrains.Add(entity, *source->brain);
+                }
+            } else if (world.aiBrains.Has(entity)) {
+                world.aiBrains.Remove(entity);
+            }
+        }
+        ++state.sequence;
+    }
+
+    /// Final chunk applied: seat the migrated players and open the
+    /// instance.  Caller holds playerMutex.
+    void completeImportLocked(uint32_t instanceId, MigrationImport& state) {
+        (void)instanceManager.setInstanceState(instanceId, InstanceState::Active);
+        auto& world = *worldOf(instanceId);
+        for (const auto& [key, local] : state.entities) {
+            if (local.kind != MigratedKind::Player) {
+                continue;
+            }
+            // A player who reconnected here meanwhile keeps that session.
+            if (playerSessions.contains(local.playerId) ||
+                !instanceManager.addPlayer(instanceId)) {
+                world.entities.Destroy(local.entity);
+                continue;
+            }
+            recordSessionLocked(local.playerId, instanceId, local.entity);
+        }
+        cgs::foundation::GameMetrics::instance().setGauge(
+            "cgs_ccu", static_cast<double>(playerSessions.size()));
+    }
+
+    /// Page the contents of the empty Active instance @p instanceId out of
+    /// its world.  Caller holds playerMutex.
+    GameResult<void> hibernateLocked(uint32_t instanceId) {
+        auto* world = worldOf(instanceId);
+        if (world == nullptr) {
+            return GameResult<void>::err(
+                GameError(ErrorCode::MapInstanceNotFound, "map instance not found"));
+        }
+        // A player leaving for another world is still a member here until
+        // the source world hands it over.
+        for (const auto& [playerId, session] : playerSessions) {
+            if (session.inTransit) {
+                return GameResult<void>::err(GameError(
+                    ErrorCode::PlayerInTransit, "a player is still moving between worlds"));
+            }
+        }
+        if (!instanceManager.setInstanceState(instanceId, InstanceState::Hibernating)) {
+            return GameResult<void>::err(GameError(
+                ErrorCode::MapInstanceInvalidState, "only an empty active instance can hibernate"));
+        }
+
+        const auto info = instanceManager.getInstance(instanceId);
+        InstanceMigrationChunk chunk;
+        chunk.final = true;
+        chunk.mapId = info->mapId;
+        chunk.type = info->type;
+        chunk.maxPlayers = info->maxPlayers;
+        chunk.upserts = collectEntities(*world, instanceId, {});
+
+        HibernatedInstance parked;
+        parked.since = std::chrono::steady_clock::now();
+        std::vector<cgs::ecs::Entity> contents;
+        contents.reserve(chunk.upserts.size());
+        for (const auto& record : chunk.upserts) {
+            const auto entity = world->entities.Resolve(record.key);
+            if (record.hasBrain) {
+                parked.brains.emplace(record.key, std::move(world->aiBrains.Get(entity)));
+            }
+            contents.push_back(entity);
+        }
+        parked.snapshot = encodeMigrationChunk(chunk);
+
+        // Dead template handles would otherwise be mistaken for restored
+        // entities that reuse their ids; cleared, reset() respawns them.
+        {
+            std::lock_guard lock(poolMutex);
+            if (auto it = templated.find(instanceId); it != templated.end()) {
+                for (auto* handles : {&it->second.zones, &it->second.npcs}) {
+                    for (auto& entity : *handles) {
+                        if (!world->entities.IsAlive(entity)) {
+                            entity = cgs::ecs::Entity{};
+                        }
+                    }
+                }
+            }
+        }
+        world->entities.DestroyMany(contents);
+        hibernated.insert_or_assign(instanceId, std::move(parked));
+
+        flightRecorder.note(FlightEventKind::InstanceHibernated,
+                            "instance=" + std::to_string(instanceId) +
+                                " entities=" + std::to_string(contents.size()));
+        return GameResult<void>::ok();
+    }
+
+    /// Restore a hibernating instance and make it Active.  Returns false
+    /// if @p instanceId is not hibernating.  Caller holds playerMutex.
+    bool wakeLocked(uint32_t instanceId) {
+        auto node = hibernated.extract(instanceId);
+        if (!node) {
+            return false;
+        }
+        auto& parked = node.mapped();
+        auto decoded = decodeMigrationChunk(parked.snapshot);  // Our own encoding.
+        MigrationImport restored;
+        applyChunk(instanceId, restored, decoded.value());
+
+        // Fast-forward over the time asleep: with nobody to fight, every
+        // living NPC has walked home, healed and calmed down.
+        auto& world = *worldOf(instanceId);
+        for (const auto& [key, local] : restored.entities) {
+            if (local.kind != MigratedKind::Npc) {
+                continue;
+            }
+            if (auto brain = parked.brains.find(key); brain != parked.brains.end()) {
+                world.aiBrains.GetOrAdd(local.entity) = std::move(brain->second);
+            }
+            auto& stats = world.stats.Get(local.entity);
+            if (stats.health == 0) {
+                continue;
+            }
+            stats.health = stats.maxHealth;
+            stats.mana = stats.maxMana;
+            auto& movement = world.movements.Get(local.entity);
+            movement.ResetSpeed();
+            movement.direction = {};
+            movement.state = cgs::game::MovementState::Idle;
+            if (world.aiBrains.Has(local.entity)) {
+                auto& brain = world.aiBrains.Get(local.entity);
+                brain.state = cgs::game::AIState::Idle;
+                brain.target = {};
+                brain.timeSinceLastTick = 0.0f;
+                world.transforms.Get(local.entity).position = brain.homePosition;
+            }
+        }
+
+        {
+            std::lock_guard lock(poolMutex);
+            if (auto it = templated.find(instanceId); it != templated.end()) {
+                for (auto* handles : {&it->second.zones, &it->second.npcs}) {
+                    for (auto& entity : *handles) {
+                        if (auto found = restored.entities.find(entity.id());
+                            entity.isValid() && found != restored.entities.end()) {
+                            entity = found->second.entity;
+                        }
+                    }
+                }
+            }
+        }
+
+        (void)instanceManager.setInstanceState(instanceId, InstanceState::Active);
+        const auto asleep = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - parked.since);
+        flightRecorder.note(FlightEventKind::InstanceWoken,
+                            "instance=" + std::to_string(instanceId) +
+                                " asleep_ms=" + std::to_string(asleep.count()));
+        return true;
+    }
+
+    /// Hibernate the instances empty for at least config.hibernateAfter.
+    void hibernateIdle() {
+        if (config.hibernateAfter.count() <= 0) {
+            return;
+        }
+        const auto idle = instanceManager.findIdleInstances(config.hibernateAfter);
+        if (idle.empty()) {
+            return;
+        }
+        std::lock_guard lock(playerMutex);
+        for (const uint32_t instanceId : idle) {
+            // Fails if a player arrived meanwhile or one is between
+            // worlds; retried next tick.
+            (void)hibernateLocked(instanceId);
+        }
+    }
+
+    /// "ObjectUpdateSystem" -> "object_update_system".
+    static std::string metricName(std::string_view systemName) {
+        std::string out;
+        out.reserve(systemName.size() + 4);
+        for (char c : systemName) {
+            const auto ch = static_cast<unsigned char>(c);
+            if (std::isupper(ch) != 0) {
+                if (!out.empty()) {
+                    out.push_back('_');
+                }
+                out.push_back(static_cast<char>(std::tolower(ch)));
+            } else if (std::isalnum(ch) != 0) {
+                out.push_back(c);
+            } else {
+                out.push_back('_');
+            }
+        }
+        return out;
+    }
+
+    /// Start flightTick from @p tm and the current counts; systems are
+    /// added by publishSystemTimings().
+    void beginFlightTick(const TickMetrics& tm) {
+        const auto nowUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                               std::chrono::steady_clock::now().time_since_epoch())
+                               .count();
+        flightTick.tickNumber = tm.tickNumber;
+        flightTick.startUs = nowUs - tm.updateTime.count();
+        flightTick.updateUs = static_cast<uint32_t>(tm.updateTime.count());
+        flightTick.frameUs = static_cast<uint32_t>(tm.frameTime.count());
+        flightTick.jitterUs = static_cast<uint32_t>(tm.jitter.count());
+        flightTick.budgetUtilization = tm.budgetUtilization;
+        flightTick.overrun = tm.overrun;
+        std::size_t entities = 0;
+        for (const auto& world : worlds) {
+            entities += world->entities.Count();
+        }
+        flightTick.entities = static_cast<uint32_t>(entities);
+        {
+            std::lock_guard lock(playerMutex);
+            flightTick.players = static_cast<uint32_t>(playerSessions.size());
+        }
+        flightTick.instances = instanceManager.instanceCount();
+        flightTick.allocations = 0;
+        flightTick.systems.clear();
+    }
+
+    /// Publish the last tick's per-system durations across all worlds
+    /// and, on an overrun, charge it to the slowest system.  Also adds
+    /// them to flightTick.
+    void publishSystemTimings(cgs::foundation::GameMetrics& metrics, bool overrun) {
+        std::optional<cgs::ecs::ProfileEvent> slowest;
+        const GameWorld* slowestWorld = nullptr;
+        const auto nowUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                               std::chrono::steady_clock::now().time_since_epoch())
+                               .count();
+        for (std::size_t w = 0; w < worlds.size(); ++w) {
+            const auto& world = worlds[w];
+            // Profiler times count from its creation; rebase them on the tick.
+            const int64_t originUs = nowUs - world->profiler.Now() / 1000;
+            const auto events = world->profiler.Events(1);
+            for (const auto& event : events) {
+                if (event.scope != cgs::ecs::ProfileScope::System) {
+                    continue;
+                }
+                if (auto it = systemHistograms.find(event.id); it != systemHistograms.end()) {
+                    metrics.recordHistogram(
+                        it->second, static_cast<double>(event.endNs - event.startNs) / 1'000'000.0);
+                }
+                if (auto it = flightSystems.find(event.id);
+                    it != flightSystems.end() &&
+                    flightTick.systems.size() < config.flightRecorder.maxSystemsPerTick) {
+                    const int64_t offsetUs = originUs + event.startNs / 1000 - flightTick.startUs;
+                    flightTick.systems.push_back(
+                        {it->second,
+                         static_cast<uint16_t>(w),
+                         static_cast<uint32_t>(std::max<int64_t>(offsetUs, 0)),
+                         static_cast<uint32_t>((event.endNs - event.startNs) / 1000),
+                         event.allocations});
+                    flightTick.allocations += event.allocations;
+                }
+                if (!slowest.has_value() ||
+                    event.endNs - event.startNs > slowest->endNs - slowest->startNs) {
+                    slowest = event;
+                    slowestWorld = world.get();
+                }
+            }
+        }
+        if (overrun && slowest.has_value()) {
+            metrics.incrementCounter("cgs_system_" +
+                                     metricName(slowestWorld->profiler.SystemName(slowest->id)) +
+                                     "_overruns_total");
+        }
+    }
+
+    /// Publish Query cache rebuilds and patches since the last tick.
+    void publishQueryCacheStats(cgs::foundation::GameMetrics& metrics) {
+        const auto stats = cgs::ecs::GetQueryCacheStats();
+        metrics.incrementCounter("cgs_ecs_query_cache_rebuilds_total",
+                                 stats.rebuilds - publishedQueryStats.rebuilds);
+        metrics.incrementCounter("cgs_ecs_query_cache_patches_total",
+                                 stats.patches - publishedQueryStats.patches);
+        publishedQueryStats = stats;
+    }
+
+    /// Publish the heap allocations charged to each system, plugin and
+    /// network handler since the last tick, as
+    /// cgs_alloc_<kind>_<name>_total and ..._bytes_total.  No-op unless
+    /// the AllocTracker hooks are linked (CGS_ALLOC_TRACKING).
+    void publishAllocations(cgs::foundation::GameMetrics& metrics) {
+        using cgs::foundation::AllocTracker;
+        if (!AllocTracker::Installed()) {
+            return;
+        }
+        const std::size_t tags = AllocTracker::TagCount();
+        while (allocMetrics.size() < tags) {
+            // Tag names are "<kind>.<name>", e.g. "system.MovementSystem".
+            const auto tag = static_cast<cgs::foundation::AllocTag>(allocMetrics.size());
+            const std::string name = AllocTracker::Name(tag);
+            const auto dot = name.find('.');
+            std::string base = "cgs_alloc_";
+            if (dot == std::string::npos) {
+                base += metricName(name);
+            } else {
+                base += name.substr(0, dot) + "_" + metricName(name.substr(dot + 1));
+            }
+            allocMetrics.push_back({base + "_total", base + "_bytes_total", {}});
+        }
+        for (std::size_t i = 0; i < tags; ++i) {
+            auto& metric = allocMetrics[i];
+            const auto counts = AllocTracker::Counts(static_cast<cgs::foundation::AllocTag>(i));
+            if (counts.allocations == metric.published.allocations) {
+                continue;
+            }
+            metrics.incrementCounter(metric.allocations,
+                                     counts.allocations - metric.published.allocations);
+            metrics.incrementCounter(metric.bytes, counts.bytes - metric.published.bytes);
+            metric.published = counts;
+        }
+    }
 };
 
 // -- Construction / destruction / move ----------------------------------------
@@ -172,27 +1494,41 @@ GameResult<void> GameServer::start() {
             GameError(ErrorCode::GameLoopAlreadyRunning, "game server is already running"));
     }
 
-    impl_->registerStorages();
-
-    if (!impl_->registerSystems()) {
-        return GameResult<void>::err(
-            GameError(ErrorCode::SystemSchedulerBuildFailed,
-                      "failed to build system scheduler: " + impl_->scheduler.GetLastError()));
+    if (!impl_->build()) {
+        return GameResult<void>::err(impl_->buildError());
     }
 
-    impl_->gameLoop.setTickCallback([this](float dt) {
-        impl_->scheduler.Execute(dt);
-        impl_->entities.FlushDeferred();
-    });
+    impl_->gameLoop.setTickCallback([impl = impl_.get()](float dt) { impl->tickWorlds(dt); });
 
     // Register tick metrics with Prometheus-compatible histogram.
     auto& metrics = cgs::foundation::GameMetrics::instance();
     metrics.registerHistogram("cgs_tick_ms", cgs::foundation::HistogramBuckets::defaultLatency());
+    for (const auto& [id, name] : impl_->systemHistograms) {
+        metrics.registerHistogram(name, cgs::foundation::HistogramBuckets::defaultLatency());
+    }
 
-    impl_->gameLoop.setMetricsCallback([&metrics](const cgs::service::TickMetrics& tm) {
+    // Wake-up jitter is sub-millisecond when Precise timing works.
+    metrics.registerHistogram(
+        "cgs_tick_jitter_ms",
+        cgs::foundation::HistogramBuckets{{0.05, 0.1, 0.25, 0.5, 1, 2, 5, 10}});
+
+    const auto tickMs = metrics.histogramHandle("cgs_tick_ms");
+    const auto jitterMs = metrics.histogramHandle("cgs_tick_jitter_ms");
+
+    impl_->gameLoop.setMetricsCallback([impl = impl_.get(), &metrics, tickMs, jitterMs](
+                                           const cgs::service::TickMetrics& tm) {
         auto ms = static_cast<double>(tm.updateTime.count()) / 1000.0;
-        metrics.recordHistogram("cgs_tick_ms", ms);
+        tickMs.record(ms);
+        jitterMs.record(static_cast<double>(tm.jitter.count()) / 1000.0);
+        if (tm.droppedTicks > 0) {
+            metrics.incrementCounter("cgs_tick_dropped_total", tm.droppedTicks);
+        }
         metrics.setGauge("cgs_tick_budget_utilization", static_cast<double>(tm.budgetUtilization));
+        impl->beginFlightTick(tm);
+        impl->publishSystemTimings(metrics, tm.overrun);
+        impl->publishQueryCacheStats(metrics);
+        impl->publishAllocations(metrics);
+        impl->flightRecorder.record(impl->flightTick);
     });
 
     if (!impl_->gameLoop.start()) {
@@ -220,18 +1556,12 @@ GameResult<void> GameServer::tick() {
     }
 
     // Ensure systems are wired on first manual tick.
-    if (impl_->scheduler.SystemCount() == 0) {
-        impl_->registerStorages();
-        if (!impl_->registerSystems()) {
-            return GameResult<void>::err(
-                GameError(ErrorCode::SystemSchedulerBuildFailed,
-                          "failed to build system scheduler: " + impl_->scheduler.GetLastError()));
+    if (!impl_->built) {
+        if (!impl_->build()) {
+            return GameResult<void>::err(impl_->buildError());
         }
 
-        impl_->gameLoop.setTickCallback([this](float dt) {
-            impl_->scheduler.Execute(dt);
-            impl_->entities.FlushDeferred();
-        });
+        impl_->gameLoop.setTickCallback([impl = impl_.get()](float dt) { impl->tickWorlds(dt); });
     }
 
     (void)impl_->gameLoop.tick();
@@ -248,32 +1578,75 @@ GameResult<uint32_t> GameServer::createInstance(uint32_t mapId, uint32_t maxPlay
         return result;
     }
 
-    // Create a map entity in the ECS world for spatial indexing.
-    auto mapEntity = impl_->entities.Create();
+    // Create a map entity in the least loaded ECS world for spatial indexing.
+    auto& world = impl_->leastLoadedWorld();
+    auto mapEntity = world.entities.Create();
     cgs::game::MapInstance comp;
     comp.mapId = mapId;
     comp.instanceId = result.value();
-    impl_->mapInstances.Add(mapEntity, comp);
+    world.mapInstances.Add(mapEntity, comp);
 
     // Track the mapping for O(1) lookup.
-    impl_->instanceEntities.emplace(result.value(), mapEntity);
+    world.instanceEntities.emplace(result.value(), mapEntity);
+    impl_->instanceWorlds.emplace(result.value(), &world);
 
+    impl_->flightRecorder.note(FlightEventKind::InstanceCreated,
+                               "instance=" + std::to_string(result.value()) +
+                                   " map=" + std::to_string(mapId));
     return result;
 }
 
 GameResult<void> GameServer::destroyInstance(uint32_t instanceId) {
+    auto info = impl_->instanceManager.getInstance(instanceId);
+    if (info.has_value() && info->state == InstanceState::Pooled) {
+        return GameResult<void>::err(GameError(ErrorCode::MapInstanceInvalidState,
+                                               "pooled instances belong to their pool"));
+    }
+
     auto destroyResult = impl_->instanceManager.destroyInstance(instanceId);
     if (destroyResult.hasError()) {
         return destroyResult;
     }
 
+    // A migration in progress is abandoned; a half-imported instance
+    // also owns the entities that have arrived.
+    {
+        std::lock_guard lock(impl_->migrationMutex);
+        impl_->exports.erase(instanceId);
+        if (auto node = impl_->imports.extract(instanceId)) {
+            if (auto* world = impl_->worldOf(instanceId)) {
+                for (const auto& [key, local] : node.mapped().entities) {
+                    world->entities.Destroy(local.entity);
+                }
+            }
+        }
+    }
+
+    // A hibernating instance's contents are already out of the world.
+    {
+        std::lock_guard lock(impl_->playerMutex);
+        impl_->hibernated.erase(instanceId);
+    }
+
+    // A templated instance also owns its zones and NPCs.
+    {
+        std::lock_guard lock(impl_->poolMutex);
+        if (auto node = impl_->templated.extract(instanceId)) {
+            node.mapped().destroyContents();
+        }
+    }
+
     // Remove the corresponding map entity from ECS.
-    auto mapEntity = impl_->findMapEntity(instanceId);
-    if (mapEntity.has_value()) {
-        impl_->entities.Destroy(*mapEntity);
+    if (auto* world = impl_->worldOf(instanceId)) {
+        if (auto mapEntity = world->findMapEntity(instanceId)) {
+            world->entities.Destroy(*mapEntity);
+        }
+        world->instanceEntities.erase(instanceId);
     }
-    impl_->instanceEntities.erase(instanceId);
+    impl_->instanceWorlds.erase(instanceId);
 
+    impl_->flightRecorder.note(FlightEventKind::InstanceDestroyed,
+                               "instance=" + std::to_string(instanceId));
     return GameResult<void>::ok();
 }
 
@@ -281,114 +1654,431 @@ std::vector<uint32_t> GameServer::availableInstances(uint32_t mapId) const {
     return impl_->instanceManager.findAvailableInstances(mapId);
 }
 
-// -- Player lifecycle ---------------------------------------------------------
+std::optional<uint32_t> GameServer::bestAvailableInstance(uint32_t mapId) const {
+    if (auto best = impl_->instanceManager.bestAvailableInstance(mapId)) {
+        return best;
+    }
+    // Waking an instance is cheaper than building one.
+    for (const auto& info : impl_->instanceManager.getInstancesByMap(mapId)) {
+        if (info.state == InstanceState::Hibernating) {
+            return info.instanceId;
+        }
+    }
+    return std::nullopt;
+}
 
-GameResult<cgs::ecs::Entity> GameServer::addPlayer(PlayerId playerId, uint32_t instanceId) {
+// -- Hibernation --------------------------------------------------------------
+
+GameResult<void> GameServer::hibernateInstance(uint32_t instanceId) {
     std::lock_guard lock(impl_->playerMutex);
+    return impl_->hibernateLocked(instanceId);
+}
+
+GameResult<void> GameServer::wakeInstance(uint32_t instanceId) {
+    std::lock_guard lock(impl_->playerMutex);
+    if (!impl_->wakeLocked(instanceId)) {
+        return GameResult<void>::err(
+            GameError(ErrorCode::MapInstanceInvalidState, "instance is not hibernating"));
+    }
+    return GameResult<void>::ok();
+}
+
+// -- Instance pools -----------------------------------------------------------
 
-    // Check for duplicate player.
-    if (impl_->playerSessions.contains(playerId)) {
-        return GameResult<cgs::ecs::Entity>::err(
-            GameError(ErrorCode::PlayerAlreadyInWorld, "player is already in the world"));
+GameResult<void> GameServer::registerInstanceTemplate(uint32_t mapId, InstanceTemplate tmpl) {
+    std::lock_guard lock(impl_->poolMutex);
+    auto [it, inserted] = impl_->pools.try_emplace(mapId);
+    if (!inserted) {
+        return GameResult<void>::err(GameError(
+            ErrorCode::AlreadyExists, "an instance template is already registered for this map"));
     }
+    it->second.tmpl = std::make_shared<const InstanceTemplate>(std::move(tmpl));
+    impl_->refillLocked(mapId, it->second);
+    return GameResult<void>::ok();
+}
 
-    // Verify instance exists and can accept players.
-    auto instanceInfo = impl_->instanceManager.getInstance(instanceId);
-    if (!instanceInfo.has_value()) {
-        return GameResult<cgs::ecs::Entity>::err(
-            GameError(ErrorCode::MapInstanceNotFound, "map instance not found"));
+GameResult<uint32_t> GameServer::acquireInstance(uint32_t mapId) {
+    std::shared_ptr<const InstanceTemplate> tmpl;
+    std::optional<uint32_t> instanceId;
+    {
+        std::lock_guard lock(impl_->poolMutex);
+        auto it = impl_->pools.find(mapId);
+        if (it == impl_->pools.end()) {
+            return GameResult<uint32_t>::err(GameError(
+                ErrorCode::MapInstanceNotFound, "no instance template registered for this map"));
+        }
+        tmpl = it->second.tmpl;
+        if (!it->second.ready.empty()) {
+            instanceId = it->second.ready.back();
+            it->second.ready.pop_back();
+        }
     }
 
-    if (!impl_->instanceManager.addPlayer(instanceId)) {
-        return GameResult<cgs::ecs::Entity>::err(
-            GameError(ErrorCode::InstanceFull, "map instance is full or not active"));
+    // Pool drained: clone one now rather than fail the caller.
+    if (!instanceId.has_value()) {
+        auto built = impl_->buildTemplated(impl_->leastLoadedWorld(), mapId, *tmpl);
+        if (built.hasError()) {
+            return built;
+        }
+        instanceId = built.value();
+        impl_->flightRecorder.note(FlightEventKind::InstanceCreated,
+                                   "instance=" + std::to_string(*instanceId) +
+                                       " map=" + std::to_string(mapId) + " pool=drained");
     }
+    (void)impl_->instanceManager.setInstanceState(*instanceId, InstanceState::Active);
 
-    // Find the map entity for this instance.
-    auto mapEntity = impl_->findMapEntity(instanceId);
-    if (!mapEntity.has_value()) {
-        // Rollback the addPlayer counter.
-        (void)impl_->instanceManager.removePlayer(instanceId);
-        return GameResult<cgs::ecs::Entity>::err(
-            GameError(ErrorCode::MapInstanceNotFound, "map entity not found in ECS"));
+    GameWorld* world = nullptr;
+    cgs::ecs::Entity mapEntity;
+    {
+        std::lock_guard lock(impl_->poolMutex);
+        const auto& instance = impl_->templated.at(*instanceId);
+        world = instance.world;
+        mapEntity = instance.mapEntity;
+        impl_->refillLocked(mapId, impl_->pools.at(mapId));
+    }
+    world->instanceEntities.emplace(*instanceId, mapEntity);
+    impl_->instanceWorlds.emplace(*instanceId, world);
+
+    return GameResult<uint32_t>::ok(*instanceId);
+}
+
+GameResult<void> GameServer::releaseInstance(uint32_t instanceId) {
+    {
+        std::lock_guard lock(impl_->poolMutex);
+        if (!impl_->templated.contains(instanceId)) {
+            return GameResult<void>::err(GameError(ErrorCode::MapInstanceNotFound,
+                                                   "instance was not built from a template"));
+        }
     }
+    {
+        // The reset works on the live contents.
+        std::lock_guard lock(impl_->playerMutex);
+        (void)impl_->wakeLocked(instanceId);
+    }
+    if (!impl_->instanceManager.setInstanceState(instanceId, InstanceState::Pooled)) {
+        return GameResult<void>::err(GameError(ErrorCode::MapInstanceInvalidState,
+                                               "instance still has players or is pooled"));
+    }
+
+    if (auto* world = impl_->worldOf(instanceId)) {
+        world->instanceEntities.erase(instanceId);
+    }
+    impl_->instanceWorlds.erase(instanceId);
+
+    std::lock_guard lock(impl_->poolMutex);
+    auto& instance = impl_->templated.at(instanceId);
+    auto& pool = impl_->pools.at(instance.mapId);
+    if (pool.ready.size() + pool.resetting >= pool.tmpl->warmCount) {
+        // Pool already full: destroy instead of keeping a surplus.
+        (void)impl_->instanceManager.destroyInstance(instanceId);
+        instance.destroyContents();
+        instance.world->entities.Destroy(instance.mapEntity);
+        impl_->templated.erase(instanceId);
+        return GameResult<void>::ok();
+    }
+    ++pool.resetting;
+    instance.world->post(
+        [impl = impl_.get(), instanceId](GameWorld&) { impl->resetStep(instanceId); });
+    return GameResult<void>::ok();
+}
+
+std::size_t GameServer::pooledInstances(uint32_t mapId) const {
+    std::lock_guard lock(impl_->poolMutex);
+    auto it = impl_->pools.find(mapId);
+    return it == impl_->pools.end() ? 0 : it->second.ready.size();
+}
+
+// -- Live migration -----------------------------------------------------------
+
+std::vector<PlayerId> GameServer::instancePlayers(uint32_t instanceId) const {
+    std::lock_guard lock(impl_->playerMutex);
+    std::vector<PlayerId> players;
+    for (const auto& [playerId, session] : impl_->playerSessions) {
+        if (session.instanceId == instanceId) {
+            players.push_back(playerId);
+        }
+    }
+    return players;
+}
+
+GameResult<std::vector<uint8_t>> GameServer::beginInstanceExport(uint32_t instanceId) {
+    if (impl_->worldOf(instanceId) == nullptr) {
+        return GameResult<std::vector<uint8_t>>::err(
+            GameError(ErrorCode::MapInstanceNotFound, "map instance not found"));
+    }
+    {
+        std::lock_guard lock(impl_->playerMutex);
+        (void)impl_->wakeLocked(instanceId);
+    }
+    if (!impl_->instanceManager.setInstanceState(instanceId, InstanceState::Migrating)) {
+        return GameResult<std::vector<uint8_t>>::err(GameError(
+            ErrorCode::MapInstanceInvalidState, "only an active instance can be migrated"));
+    }
+
+    std::lock_guard lock(impl_->migrationMutex);
+    auto& state = impl_->exports[instanceId];
+    state = {};
+    return GameResult<std::vector<uint8_t>>::ok(
+        encodeMigrationChunk(impl_->exportChunk(instanceId, state, false)));
+}
+
+GameResult<std::vector<uint8_t>> GameServer::exportInstanceDelta(uint32_t instanceId) {
+    std::lock_guard lock(impl_->migrationMutex);
+    auto it = impl_->exports.find(instanceId);
+    if (it == impl_->exports.end()) {
+        return GameResult<std::vector<uint8_t>>::err(
+            GameError(ErrorCode::MapInstanceInvalidState, "instance is not being exported"));
+    }
+    return GameResult<std::vector<uint8_t>>::ok(
+        encodeMigrationChunk(impl_->exportChunk(instanceId, it->second, false)));
+}
 
-    // Create the player entity with default components.
-    auto entity = impl_->entities.Create();
+GameResult<std::vector<uint8_t>> GameServer::finishInstanceExport(uint32_t instanceId) {
+    std::vector<uint8_t> bytes;
+    std::vector<uint32_t> keys;
+    {
+        std::lock_guard lock(impl_->migrationMutex);
+        auto it = impl_->exports.find(instanceId);
+        if (it == impl_->exports.end()) {
+            return GameResult<std::vector<uint8_t>>::err(
+                GameError(ErrorCode::MapInstanceInvalidState, "instance is not being exported"));
+        }
+        {
+            std::lock_guard playerLock(impl_->playerMutex);
+            for (const auto& [playerId, session] : impl_->playerSessions) {
+                if (session.instanceId == instanceId && session.inTransit) {
+                    return GameResult<std::vector<uint8_t>>::err(GameError(
+                        ErrorCode::PlayerInTransit, "a player is still moving between worlds"));
+                }
+            }
+        }
+        bytes = encodeMigrationChunk(impl_->exportChunk(instanceId, it->second, true));
+        for (const auto& [key, sent] : it->second.sent) {
+            keys.push_back(key);
+        }
+        impl_->exports.erase(it);
+    }
 
-    cgs::game::Transform transform;
-    impl_->transforms.Add(entity, transform);
+    // The players now belong to the target server.
+    {
+        std::lock_guard lock(impl_->playerMutex);
+        for (auto it = impl_->playerSessions.begin(); it != impl_->playerSessions.end();) {
+            if (it->second.instanceId != instanceId) {
+                ++it;
+                continue;
+            }
+            (void)impl_->instanceManager.removePlayer(instanceId);
+            impl_->playersLeft.fetch_add(1, std::memory_order_relaxed);
+            it = impl_->playerSessions.erase(it);
+        }
+        cgs::foundation::GameMetrics::instance().setGauge(
+            "cgs_ccu", static_cast<double>(impl_->playerSessions.size()));
+    }
 
-    cgs::game::Identity identity;
-    identity.guid = cgs::game::GenerateGUID();
-    identity.type = cgs::game::ObjectType::Player;
-    impl_->identities.Add(entity, std::move(identity));
+    auto* world = impl_->worldOf(instanceId);
+    for (const uint32_t key : keys) {
+        world->entities.Destroy(world->entities.Resolve(key));
+    }
+    (void)destroyInstance(instanceId);  // Empty now: cannot fail.
+    impl_->flightRecorder.note(FlightEventKind::InstanceMigrated,
+                               "instance=" + std::to_string(instanceId) + " direction=out");
 
-    cgs::game::Stats playerStats;
-    playerStats.health = 100;
-    playerStats.maxHealth = 100;
-    playerStats.mana = 100;
-    playerStats.maxMana = 100;
-    impl_->stats.Add(entity, playerStats);
+    return GameResult<std::vector<uint8_t>>::ok(std::move(bytes));
+}
 
-    cgs::game::Movement movement;
-    movement.baseSpeed = 7.0f;
-    movement.speed = 7.0f;
-    impl_->movements.Add(entity, movement);
+GameResult<void> GameServer::cancelInstanceExport(uint32_t instanceId) {
+    std::lock_guard lock(impl_->migrationMutex);
+    if (impl_->exports.erase(instanceId) == 0) {
+        return GameResult<void>::err(
+            GameError(ErrorCode::MapInstanceInvalidState, "instance is not being exported"));
+    }
+    (void)impl_->instanceManager.setInstanceState(instanceId, InstanceState::Active);
+    return GameResult<void>::ok();
+}
 
-    cgs::game::MapMembership membership;
-    membership.mapEntity = *mapEntity;
-    impl_->memberships.Add(entity, membership);
+GameResult<uint32_t> GameServer::importInstance(std::span<const uint8_t> snapshot) {
+    auto decoded = decodeMigrationChunk(snapshot);
+    if (decoded.hasError()) {
+        return GameResult<uint32_t>::err(decoded.error());
+    }
+    auto& chunk = decoded.value();
+    if (chunk.sequence != 0) {
+        return GameResult<uint32_t>::err(
+            GameError(ErrorCode::MapInstanceInvalidState, "expected a snapshot chunk"));
+    }
 
-    cgs::game::QuestLog questLog;
-    impl_->questLogs.Add(entity, std::move(questLog));
+    auto result = impl_->instanceManager.createInstance(
+        chunk.mapId, chunk.type, chunk.maxPlayers, InstanceState::Migrating);
+    if (result.hasError()) {
+        return result;
+    }
+    const uint32_t instanceId = result.value();
 
-    cgs::game::Inventory inventory;
-    inventory.Initialize();
-    impl_->inventories.Add(entity, std::move(inventory));
+    auto& world = impl_->leastLoadedWorld();
+    auto mapEntity = world.entities.Create();
+    cgs::game::MapInstance comp;
+    comp.mapId = chunk.mapId;
+    comp.instanceId = instanceId;
+    comp.type = chunk.type;
+    world.mapInstances.Add(mapEntity, comp);
+    world.instanceEntities.emplace(instanceId, mapEntity);
+    impl_->instanceWorlds.emplace(instanceId, &world);
+    impl_->flightRecorder.note(FlightEventKind::InstanceMigrated,
+                               "instance=" + std::to_string(instanceId) + " direction=in");
+
+    std::lock_guard lock(impl_->migrationMutex);
+    auto& state = impl_->imports[instanceId];
+    impl_->applyChunk(instanceId, state, chunk);
+    if (chunk.final) {
+        std::lock_guard playerLock(impl_->playerMutex);
+        impl_->completeImportLocked(instanceId, state);
+        impl_->imports.erase(instanceId);
+    }
+    return result;
+}
 
-    cgs::game::Equipment equip;
-    impl_->equipment.Add(entity, std::move(equip));
+GameResult<void> GameServer::applyInstanceChunk(uint32_t instanceId,
+                                                std::span<const uint8_t> chunk) {
+    auto decoded = decodeMigrationChunk(chunk);
+    if (decoded.hasError()) {
+        return GameResult<void>::err(decoded.error());
+    }
 
-    // Record player session.
-    PlayerSession session;
-    session.playerId = playerId;
-    session.entity = entity;
-    session.instanceId = instanceId;
-    impl_->playerSessions.emplace(playerId, session);
+    std::lock_guard lock(impl_->migrationMutex);
+    auto it = impl_->imports.find(instanceId);
+    if (it == impl_->imports.end()) {
+        return GameResult<void>::err(
+            GameError(ErrorCode::MapInstanceInvalidState, "instance is not being imported"));
+    }
+    if (decoded.value().sequence != it->second.sequence) {
+        return GameResult<void>::err(
+            GameError(ErrorCode::MapInstanceInvalidState, "migration chunk out of sequence"));
+    }
+    impl_->applyChunk(instanceId, it->second, decoded.value());
+    if (decoded.value().final) {
+        std::lock_guard playerLock(impl_->playerMutex);
+        impl_->completeImportLocked(instanceId, it->second);
+        impl_->imports.erase(it);
+    }
+    return GameResult<void>::ok();
+}
 
-    impl_->playersJoined.fetch_add(1, std::memory_order_relaxed);
+// -- Player lifecycle ---------------------------------------------------------
 
-    cgs::foundation::GameMetrics::instance().setGauge(
-        "cgs_ccu", static_cast<double>(impl_->playerSessions.size()));
+GameResult<cgs::ecs::Entity> GameServer::addPlayer(PlayerId playerId, uint32_t instanceId) {
+    std::lock_guard lock(impl_->playerMutex);
 
-    return GameResult<cgs::ecs::Entity>::ok(entity);
+    auto result = impl_->addPlayerLocked(playerId, instanceId, CharacterData{});
+    if (result.hasValue()) {
+        cgs::foundation::GameMetrics::instance().setGauge(
+            "cgs_ccu", static_cast<double>(impl_->playerSessions.size()));
+    }
+    return result;
 }
 
 GameResult<void> GameServer::removePlayer(PlayerId playerId) {
     std::lock_guard lock(impl_->playerMutex);
 
-    auto it = impl_->playerSessions.find(playerId);
-    if (it == impl_->playerSessions.end()) {
+    auto result = impl_->removePlayerLocked(playerId);
+    if (result.hasValue()) {
+        cgs::foundation::GameMetrics::instance().setGauge(
+            "cgs_ccu", static_cast<double>(impl_->playerSessions.size()));
+    }
+    return result;
+}
+
+GameResult<void> GameServer::joinPlayer(PlayerId playerId, uint32_t instanceId) {
+    {
+        std::lock_guard lock(impl_->playerMutex);
+        if (impl_->playerSessions.contains(playerId)) {
+            return GameResult<void>::err(
+                GameError(ErrorCode::PlayerAlreadyInWorld, "player is already in the world"));
+        }
+    }
+    if (!impl_->instanceManager.getInstance(instanceId).has_value()) {
         return GameResult<void>::err(
-            GameError(ErrorCode::PlayerNotInWorld, "player is not in the world"));
+            GameError(ErrorCode::MapInstanceNotFound, "map instance not found"));
     }
 
-    auto session = it->second;
-    impl_->playerSessions.erase(it);
+    auto& pipeline = *impl_->joins;
+    CharacterLoader loader;
+    {
+        std::lock_guard lock(pipeline.mutex);
+        if (pipeline.pendingLocked(playerId)) {
+            return GameResult<void>::err(
+                GameError(ErrorCode::PlayerAlreadyInWorld, "player is already joining"));
+        }
+        if (!pipeline.loader) {
+            pipeline.queued.push_back({playerId, instanceId, CharacterData{}});
+            pipeline.queuedIds.insert(playerId);
+            return GameResult<void>::ok();
+        }
+        pipeline.loading.emplace(playerId, instanceId);
+        loader = pipeline.loader;
+    }
 
-    // Release the instance slot.
-    (void)impl_->instanceManager.removePlayer(session.instanceId);
+    // The loader may answer inline or on its own thread.
+    loader(playerId,
+           [weak = std::weak_ptr<JoinPipeline>(impl_->joins),
+            playerId](GameResult<CharacterData> result) {
+               if (auto joins = weak.lock()) {
+                   joins->loaded(playerId, std::move(result));
+               }
+           });
+    return GameResult<void>::ok();
+}
 
-    // Destroy the entity (storages auto-cleanup components).
-    impl_->entities.Destroy(session.entity);
+GameResult<void> GameServer::leavePlayer(PlayerId playerId) {
+    auto& pipeline = *impl_->joins;
+    {
+        std::lock_guard lock(pipeline.mutex);
+        if (pipeline.cancelLocked(playerId)) {
+            return GameResult<void>::ok();
+        }
+    }
+    {
+        std::lock_guard lock(impl_->playerMutex);
+        if (!impl_->playerSessions.contains(playerId)) {
+            return GameResult<void>::err(
+                GameError(ErrorCode::PlayerNotInWorld, "player is not in the world"));
+        }
+    }
 
-    impl_->playersLeft.fetch_add(1, std::memory_order_relaxed);
+    std::lock_guard lock(pipeline.mutex);
+    if (std::find(pipeline.leaves.begin(), pipeline.leaves.end(), playerId) ==
+        pipeline.leaves.end()) {
+        pipeline.leaves.push_back(playerId);
+    }
+    return GameResult<void>::ok();
+}
 
-    cgs::foundation::GameMetrics::instance().setGauge(
-        "cgs_ccu", static_cast<double>(impl_->playerSessions.size()));
+std::optional<JoinStatus> GameServer::joinStatus(PlayerId playerId) const {
+    const auto& pipeline = *impl_->joins;
+    std::lock_guard lock(pipeline.mutex);
 
-    return GameResult<void>::ok();
+    if (pipeline.loading.contains(playerId)) {
+        return JoinStatus{};
+    }
+    for (std::size_t i = 0; i < pipeline.queued.size(); ++i) {
+        if (pipeline.queued[i].playerId == playerId) {
+            JoinStatus status;
+            status.stage = JoinStage::Queued;
+            status.position = i;
+            const uint32_t budget = impl_->config.joinsPerTick;
+            status.ticksRemaining = budget == 0 ? 1 : i / budget + 1;
+            return status;
+        }
+    }
+    return std::nullopt;
+}
+
+void GameServer::setCharacterLoader(CharacterLoader loader) {
+    std::lock_guard lock(impl_->joins->mutex);
+    impl_->joins->loader = std::move(loader);
+}
+
+cgs::foundation::Signal<PlayerId, ErrorCode>& GameServer::joinFinished() noexcept {
+    return impl_->joinFinished;
 }
 
 std::optional<PlayerSession> GameServer::getPlayerSession(PlayerId playerId) const {
@@ -401,6 +2091,20 @@ std::optional<PlayerSession> GameServer::getPlayerSession(PlayerId playerId) con
     return it->second;
 }
 
+std::vector<cgs::ecs::Entity> GameServer::entitiesNear(uint32_t instanceId,
+                                                       const cgs::game::Vector3& center,
+                                                       float radius) const {
+    const auto* world = impl_->worldOf(instanceId);
+    if (world == nullptr || world->worldSystem == nullptr) {
+        return {};
+    }
+    const auto mapEntity = world->findMapEntity(instanceId);
+    if (!mapEntity.has_value()) {
+        return {};
+    }
+    return world->worldSystem->QueryRadius(*mapEntity, center, radius);
+}
+
 GameResult<void> GameServer::transferPlayer(PlayerId playerId, uint32_t targetInstanceId) {
     std::lock_guard lock(impl_->playerMutex);
 
@@ -416,14 +2120,23 @@ GameResult<void> GameServer::transferPlayer(PlayerId playerId, uint32_t targetIn
         return GameResult<void>::ok();  // Already in the target instance.
     }
 
+    if (session.inTransit) {
+        return GameResult<void>::err(
+            GameError(ErrorCode::PlayerInTransit, "player is still moving between worlds"));
+    }
+
     // Verify the target instance exists and can accept players.
+    (void)impl_->wakeLocked(targetInstanceId);
     if (!impl_->instanceManager.addPlayer(targetInstanceId)) {
         return GameResult<void>::err(
             GameError(ErrorCode::InstanceFull, "target instance is full or not active"));
     }
 
-    auto targetMapEntity = impl_->findMapEntity(targetInstanceId);
-    if (!targetMapEntity.has_value()) {
+    auto* source = impl_->worldOf(session.instanceId);
+    auto* target = impl_->worldOf(targetInstanceId);
+    auto targetMapEntity =
+        target != nullptr ? target->findMapEntity(targetInstanceId) : std::nullopt;
+    if (source == nullptr || !targetMapEntity.has_value()) {
         (void)impl_->instanceManager.removePlayer(targetInstanceId);
         return GameResult<void>::err(
             GameError(ErrorCode::MapInstanceNotFound, "target map entity not found in ECS"));
@@ -431,19 +2144,57 @@ GameResult<void> GameServer::transferPlayer(PlayerId playerId, uint32_t targetIn
 
     // Release the old instance slot.
     (void)impl_->instanceManager.removePlayer(session.instanceId);
+    session.instanceId = targetInstanceId;
 
-    // Update the entity's map membership.
-    if (impl_->memberships.Has(session.entity)) {
-        auto& membership = impl_->memberships.Get(session.entity);
-        membership.mapEntity = *targetMapEntity;
-        membership.zoneId = 0;
+    if (source == target) {
+        source->moveToMap(session.entity, *targetMapEntity);
+        return GameResult<void>::ok();
     }
 
-    session.instanceId = targetInstanceId;
+    // Another world: the source world hands the player's components to
+    // the target world through their inboxes, each on its own tick.
+    session.inTransit = true;
+    impl_->crossWorldTransfers.fetch_add(1, std::memory_order_relaxed);
+    source->post([impl = impl_.get(),
+                  target,
+                  playerId,
+                  targetInstanceId,
+                  entity = session.entity,
+                  mapEntity = *targetMapEntity](GameWorld& from) {
+        auto state = std::make_shared<PlayerState>(from.extractPlayer(entity));
+        target->post([impl, playerId, targetInstanceId, mapEntity, state](GameWorld& to) {
+            auto arrived = to.insertPlayer(std::move(*state), mapEntity);
+            impl->completeTransfer(to, playerId, targetInstanceId, arrived);
+        });
+    });
 
     return GameResult<void>::ok();
 }
 
+GameResult<cgs::game::AbilityUseResult> GameServer::useAbility(PlayerId playerId,
+                                                               const cgs::game::AbilityUse& use) {
+    std::lock_guard lock(impl_->playerMutex);
+
+    auto it = impl_->playerSessions.find(playerId);
+    if (it == impl_->playerSessions.end()) {
+        return GameResult<cgs::game::AbilityUseResult>::err(
+            GameError(ErrorCode::PlayerNotInWorld, "player is not in the world"));
+    }
+    const auto& session = it->second;
+    if (session.inTransit) {
+        return GameResult<cgs::game::AbilityUseResult>::err(
+            GameError(ErrorCode::PlayerInTransit, "player is still moving between worlds"));
+    }
+
+    auto* world = impl_->worldOf(session.instanceId);
+    if (world == nullptr || world->combatSystem == nullptr) {
+        return GameResult<cgs::game::AbilityUseResult>::err(
+            GameError(ErrorCode::GameLoopNotRunning, "game systems are not built yet"));
+    }
+    return GameResult<cgs::game::AbilityUseResult>::ok(
+        world->combatSystem->UseAbility(session.entity, use));
+}
+
 // -- Statistics ---------------------------------------------------------------
 
 GameServerStats GameServer::stats() const {
@@ -457,7 +2208,14 @@ GameServerStats GameServer::stats() const {
         1000.0f;
     s.lastBudgetUtilization = loopMetrics.budgetUtilization;
 
-    s.entityCount = impl_->entities.Count();
+    for (const auto& world : impl_->worlds) {
+        s.entityCount += world->entities.Count();
+    }
+    s.worldCount = static_cast<uint32_t>(impl_->worlds.size());
+    s.crossWorldTransfers = impl_->crossWorldTransfers.load(std::memory_order_relaxed);
+    for (const auto& world : impl_->worlds) {
+        s.spellHits += world->spellHits.load(std::memory_order_relaxed);
+    }
 
     {
         std::lock_guard lock(impl_->playerMutex);
@@ -466,15 +2224,37 @@ GameServerStats GameServer::stats() const {
 
     s.activeInstances = impl_->instanceManager.instanceCount(InstanceState::Active);
     s.drainingInstances = impl_->instanceManager.instanceCount(InstanceState::Draining);
+    s.pooledInstances = impl_->instanceManager.instanceCount(InstanceState::Pooled);
+    s.migratingInstances = impl_->instanceManager.instanceCount(InstanceState::Migrating);
+    s.hibernatingInstances = impl_->instanceManager.instanceCount(InstanceState::Hibernating);
 
     s.playersJoined = impl_->playersJoined.load(std::memory_order_relaxed);
     s.playersLeft = impl_->playersLeft.load(std::memory_order_relaxed);
 
+    {
+        std::lock_guard lock(impl_->joins->mutex);
+        s.joinsLoading = impl_->joins->loading.size();
+        s.joinsQueued = impl_->joins->queued.size();
+        s.leavesQueued = impl_->joins->leaves.size();
+    }
+
     return s;
 }
 
+std::string GameServer::systemTrace(std::size_t lastTicks) const {
+    return impl_->worlds.front()->profiler.ChromeTraceJson(lastTicks);
+}
+
+FlightRecorder& GameServer::flightRecorder() noexcept {
+    return impl_->flightRecorder;
+}
+
 const GameServerConfig& GameServer::config() const noexcept {
     return impl_->config;
 }
 
+cgs::foundation::ResumeQueue& GameServer::resumeQueue() noexcept {
+    return impl_->resumeQueue;
+}
+
 }  // namespace cgs::service
@@ -0,0 +1,250 @@
+/// @file instance_migration.cpp
+/// @brief Instance migration chunk encoding.
+
+#include "cgs/service/instance_migration.hpp"
+
+#include "cgs/foundation/error_code.hpp"
+#include "cgs/foundation/game_error.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <string>
+#include <string_view>
+
+namespace cgs::service {
+
+using cgs::foundation::ErrorCode;
+using cgs::foundation::GameError;
+using cgs::foundation::GameResult;
+
+namespace {
+
+constexpr uint32_t kMagic = 0x4D494743;  // "CGIM"
+constexpr uint8_t kVersion = 1;
+constexpr uint8_t kFlagFinal = 0x01;
+
+// Little-endian field writer.
+struct Writer {
+    std::vector<uint8_t>& out;
+
+    template <typename T>
+    void uint(T value) {
+        for (std::size_t i = 0; i < sizeof(T); ++i) {
+            out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+        }
+    }
+    void i32(int32_t value) { uint(static_cast<uint32_t>(value)); }
+    void f32(float value) { uint(std::bit_cast<uint32_t>(value)); }
+    void vec(const cgs::game::Vector3& v) {
+        f32(v.x);
+        f32(v.y);
+        f32(v.z);
+    }
+    void str(std::string_view s) {
+        const auto size = static_cast<uint16_t>(std::min<std::size_t>(s.size(), UINT16_MAX));
+        uint(size);
+        out.insert(out.end(), s.begin(), s.begin() + size);
+    }
+};
+
+// Little-endian field reader; good turns false on the first overrun.
+struct Reader {
+    std::span<const uint8_t> in;
+    std::size_t pos = 0;
+    bool good = true;
+
+    template <typename T>
+    T uint() {
+        if (!good || in.size() - pos < sizeof(T)) {
+            good = false;
+            return T{};
+        }
+        T value{};
+        for (std::size_t i = 0; i < sizeof(T); ++i) {
+            value = static_cast<T>(value | static_cast<T>(static_cast<T>(in[pos + i]) << (8 * i)));
+        }
+        pos += sizeof(T);
+        return value;
+    }
+    int32_t i32() { return static_cast<int32_t>(uint<uint32_t>()); }
+    float f32() { return std::bit_cast<float>(uint<uint32_t>()); }
+    cgs::game::Vector3 vec() {
+        cgs::game::Vector3 v;
+        v.x = f32();
+        v.y = f32();
+        v.z = f32();
+        return v;
+    }
+    std::string str() {
+        const auto size = uint<uint16_t>();
+        if (!good || in.size() - pos < size) {
+            good = false;
+            return {};
+        }
+        std::string s(reinterpret_cast<const char*>(in.data() + pos), size);
+        pos += size;
+        return s;
+    }
+};
+
+void writeEntity(Writer& w, const MigratedEntity& e) {
+    w.uint(e.key);
+    w.uint(static_cast<uint8_t>(e.kind));
+    if (e.kind == MigratedKind::Zone) {
+        w.uint(e.zoneId);
+        w.uint(static_cast<uint8_t>(e.zoneType));
+        w.uint(static_cast<uint32_t>(e.zoneFlags));
+        return;
+    }
+    if (e.kind == MigratedKind::Player) {
+        w.uint(e.playerId);
+    }
+    w.uint(e.identity.guid);
+    w.str(e.identity.name);
+    w.uint(static_cast<uint8_t>(e.identity.type));
+    w.uint(e.identity.entry);
+
+    w.vec(e.transform.position);
+    w.f32(e.transform.rotation.w);
+    w.f32(e.transform.rotation.x);
+    w.f32(e.transform.rotation.y);
+    w.f32(e.transform.rotation.z);
+    w.vec(e.transform.scale);
+
+    w.i32(e.stats.health);
+    w.i32(e.stats.maxHealth);
+    w.i32(e.stats.mana);
+    w.i32(e.stats.maxMana);
+    for (const int32_t attribute : e.stats.attributes) {
+        w.i32(attribute);
+    }
+
+    w.f32(e.movement.speed);
+    w.f32(e.movement.baseSpeed);
+    w.vec(e.movement.direction);
+    w.uint(static_cast<uint8_t>(e.movement.state));
+
+    w.uint(e.memberZoneId);
+    w.uint(static_cast<uint8_t>(e.hasBrain ? 1 : 0));
+}
+
+MigratedEntity readEntity(Reader& r) {
+    MigratedEntity e;
+    e.key = r.uint<uint32_t>();
+    const auto kind = r.uint<uint8_t>();
+    if (kind > static_cast<uint8_t>(MigratedKind::Player)) {
+        r.good = false;
+        return e;
+    }
+    e.kind = static_cast<MigratedKind>(kind);
+    if (e.kind == MigratedKind::Zone) {
+        e.zoneId = r.uint<uint32_t>();
+        e.zoneType = static_cast<cgs::game::ZoneType>(r.uint<uint8_t>());
+        e.zoneFlags = static_cast<cgs::game::ZoneFlags>(r.uint<uint32_t>());
+        return e;
+    }
+    if (e.kind == MigratedKind::Player) {
+        e.playerId = r.uint<uint64_t>();
+    }
+    e.identity.guid = r.uint<uint64_t>();
+    e.identity.name = r.str();
+    e.identity.type = static_cast<cgs::game::ObjectType>(r.uint<uint8_t>());
+    e.identity.entry = r.uint<uint32_t>();
+
+    e.transform.position = r.vec();
+    e.transform.rotation.w = r.f32();
+    e.transform.rotation.x = r.f32();
+    e.transform.rotation.y = r.f32();
+    e.transform.rotation.z = r.f32();
+    e.transform.scale = r.vec();
+
+    e.stats.health = r.i32();
+    e.stats.maxHealth = r.i32();
+    e.stats.mana = r.i32();
+    e.stats.maxMana = r.i32();
+    for (int32_t& attribute : e.stats.attributes) {
+        attribute = r.i32();
+    }
+
+    e.movement.speed = r.f32();
+    e.movement.baseSpeed = r.f32();
+    e.movement.direction = r.vec();
+    e.movement.state = static_cast<cgs::game::MovementState>(r.uint<uint8_t>());
+
+    e.memberZoneId = r.uint<uint32_t>();
+    e.hasBrain = r.uint<uint8_t>() != 0;
+    return e;
+}
+
+}  // anonymous namespace
+
+std::vector<uint8_t> encodeMigrationChunk(const InstanceMigrationChunk& chunk) {
+    std::vector<uint8_t> out;
+    Writer w{out};
+    w.uint(kMagic);
+    w.uint(kVersion);
+    w.uint(static_cast<uint8_t>(chunk.final ? kFlagFinal : 0));
+    w.uint(chunk.sequence);
+    w.uint(chunk.mapId);
+    w.uint(static_cast<uint8_t>(chunk.type));
+    w.uint(chunk.maxPlayers);
+
+    w.uint(static_cast<uint32_t>(chunk.upserts.size()));
+    for (const auto& entity : chunk.upserts) {
+        writeEntity(w, entity);
+    }
+    w.uint(static_cast<uint32_t>(chunk.removed.size()));
+    for (const uint32_t key : chunk.removed) {
+        w.uint(key);
+    }
+    return out;
+}
+
+void encodeMigratedEntity(const MigratedEntity& entity, std::vector<uint8_t>& out) {
+    Writer w{out};
+    writeEntity(w, entity);
+}
+
+GameResult<InstanceMigrationChunk> decodeMigrationChunk(std::span<const uint8_t> bytes) {
+    auto fail = [](const char* what) {
+        return GameResult<InstanceMigrationChunk>::err(
+            GameError(ErrorCode::SerializationError, what));
+    };
+
+    Reader r{bytes};
+    if (r.uint<uint32_t>() != kMagic || r.uint<uint8_t>() != kVersion) {
+        return fail("not an instance migration chunk");
+    }
+
+    InstanceMigrationChunk chunk;
+    chunk.final = (r.uint<uint8_t>() & kFlagFinal) != 0;
+    chunk.sequence = r.uint<uint64_t>();
+    chunk.mapId = r.uint<uint32_t>();
+    chunk.type = static_cast<cgs::game::MapType>(r.uint<uint8_t>());
+    chunk.maxPlayers = r.uint<uint32_t>();
+
+    // Counts are checked against the bytes left, so a corrupt count
+    // cannot trigger a huge reservation.
+    const auto upserts = r.uint<uint32_t>();
+    if (upserts > bytes.size() - r.pos) {
+        return fail("truncated instance migration chunk");
+    }
+    chunk.upserts.reserve(upserts);
+    for (uint32_t i = 0; i < upserts && r.good; ++i) {
+        chunk.upserts.push_back(readEntity(r));
+    }
+    const auto removed = r.uint<uint32_t>();
+    if (!r.good || removed > (bytes.size() - r.pos) / sizeof(uint32_t)) {
+        return fail("truncated instance migration chunk");
+    }
+    chunk.removed.reserve(removed);
+    for (uint32_t i = 0; i < removed; ++i) {
+        chunk.removed.push_back(r.uint<uint32_t>());
+    }
+    if (!r.good || r.pos != bytes.size()) {
+        return fail("malformed instance migration chunk");
+    }
+    return GameResult<InstanceMigrationChunk>::ok(std::move(chunk));
+}
+
+}  // namespace cgs::service
@@ -5,13 +5,19 @@
 /// Runs the ECS-based world simulation with a fixed-rate game loop.
 
 #include "cgs/foundation/config_manager.hpp"
+#include "cgs/foundation/cpu_affinity.hpp"
 #include "cgs/foundation/game_metrics.hpp"
 #include "cgs/service/game_server.hpp"
 #include "cgs/service/health_server.hpp"
 #include "cgs/service/service_runner.hpp"
 
+#include <algorithm>
+#include <charconv>
+#include <chrono>
 #include <cstdlib>
 #include <iostream>
+#include <string>
+#include <string_view>
 
 namespace {
 
@@ -38,9 +44,76 @@ cgs::service::GameServerConfig buildGameConfig(const cgs::foundation::ConfigMana
         cfg.aiTickInterval = aiTick.value();
     }
 
+    auto gameThreadCpus = config.get<std::string>("game.game_thread_cpus");
+    if (gameThreadCpus) {
+        auto cpus = cgs::foundation::CpuSet::parse(gameThreadCpus.value());
+        if (cpus) {
+            cfg.gameThreadCpus = cpus.value();
+        } else {
+            std::cerr << "Ignoring game.game_thread_cpus: " << cpus.error().message() << "\n";
+        }
+    }
+
+    auto isolate = config.get<bool>("game.isolate_game_thread");
+    if (isolate && isolate.value() && cfg.gameThreadCpus.empty()) {
+        cfg.gameThreadCpus =
+            cgs::foundation::ThreadPlacement::isolatedGameThread(cgs::foundation::allowedCpus())
+                .gameLoop;
+    }
+
+    auto worldShards = config.get<unsigned int>("game.world_shards");
+    if (worldShards) {
+        cfg.worldShards = worldShards.value();
+    }
+
+    auto joinsPerTick = config.get<unsigned int>("game.joins_per_tick");
+    if (joinsPerTick) {
+        cfg.joinsPerTick = joinsPerTick.value();
+    }
+
+    auto leavesPerTick = config.get<unsigned int>("game.leaves_per_tick");
+    if (leavesPerTick) {
+        cfg.leavesPerTick = leavesPerTick.value();
+    }
+
+    auto preciseTiming = config.get<bool>("game.precise_tick_timing");
+    if (preciseTiming && preciseTiming.value()) {
+        cfg.tickTiming.mode = cgs::service::TickTimingMode::Precise;
+    }
+
+    auto catchUpTicks = config.get<unsigned int>("game.max_catch_up_ticks");
+    if (catchUpTicks && catchUpTicks.value() > 0) {
+        cfg.tickTiming.overrun = cgs::service::OverrunPolicy::CatchUp;
+        cfg.tickTiming.maxCatchUpTicks = catchUpTicks.value();
+    }
+
+    auto flightDir = config.get<std::string>("game.flight_recorder_dir");
+    if (flightDir) {
+        cfg.flightRecorder.dumpDirectory = flightDir.value();
+    }
+
+    auto overrunFactor = config.get<float>("game.flight_recorder_overrun_factor");
+    if (overrunFactor) {
+        cfg.flightRecorder.overrunFactor = overrunFactor.value();
+    }
+
+    // Keep about a minute of ticks whatever the tick rate.
+    cfg.flightRecorder.capacity = std::max<std::size_t>(cfg.tickRate, 1) * 60;
+
     return cfg;
 }
 
+/// Seconds requested by a "seconds=N" query (default 60).
+std::chrono::seconds requestedWindow(std::string_view query) {
+    constexpr std::string_view key = "seconds=";
+    unsigned int seconds = 60;
+    if (auto pos = query.find(key); pos != std::string_view::npos) {
+        const auto* begin = query.data() + pos + key.size();
+        (void)std::from_chars(begin, query.data() + query.size(), seconds);
+    }
+    return std::chrono::seconds(seconds);
+}
+
 }  // namespace
 
 int main(int argc, char* argv[]) {
@@ -62,23 +135,26 @@ int main(int argc, char* argv[]) {
     auto& metrics = cgs::foundation::GameMetrics::instance();
     cgs::service::HealthServer health({.port = 9110, .serviceName = "game"}, metrics);
 
-    auto healthResult = health.start();
-    if (!healthResult) {
-        std::cerr << "Failed to start health server: " << healthResult.error().message() << "\n";
-        return EXIT_FAILURE;
-    }
-
     auto gameCfg = buildGameConfig(config);
     cgs::service::GameServer server(gameCfg);
 
-    auto startResult = server.start();
+    // Recent ticks as a Chrome trace: /debug/ticks?seconds=N.
+    health.addEndpoint("/debug/ticks", [&server](std::string_view query) {
+        return server.flightRecorder().traceJson(requestedWindow(query));
+    });
+
+    // The health endpoint and the game server come up concurrently;
+    // readiness is reported once both are up.
+    cgs::service::StartupGraph startup;
+    startup.addStage("health_server", [&] { return health.start(); });
+    startup.addStage("game_server", [&] { return server.start(); });
+
+    auto startResult = startup.run(&health);
     if (!startResult) {
-        std::cerr << "Failed to start game server: " << startResult.error().message() << "\n";
+        std::cerr << "Failed to start game service: " << startResult.error().message() << "\n";
         return EXIT_FAILURE;
     }
 
-    health.setReady(true);
-
     std::cout << "Game server started (tick_rate: " << gameCfg.tickRate
               << " Hz, max_instances: " << gameCfg.maxInstances << ", health_port: 9110)\n";
 
@@ -10,9 +10,38 @@ namespace cgs::service {
 
 MapInstanceManager::MapInstanceManager(uint32_t maxInstances) : maxInstances_(maxInstances) {}
 
+void MapInstanceManager::index(const MapInstanceInfo& info) {
+    byMap_[info.mapId].insert(info.instanceId);
+    byState_[static_cast<std::size_t>(info.state)].insert(info.instanceId);
+    if (info.playerCount == 0) {
+        empty_.insert(info.instanceId);
+    }
+    if (info.state == InstanceState::Active && info.playerCount < info.maxPlayers) {
+        available_[info.mapId].emplace(info.maxPlayers - info.playerCount, info.instanceId);
+    }
+}
+
+void MapInstanceManager::unindex(const MapInstanceInfo& info) {
+    if (auto it = byMap_.find(info.mapId); it != byMap_.end()) {
+        it->second.erase(info.instanceId);
+        if (it->second.empty()) {
+            byMap_.erase(it);
+        }
+    }
+    byState_[static_cast<std::size_t>(info.state)].erase(info.instanceId);
+    empty_.erase(info.instanceId);
+    if (auto it = available_.find(info.mapId); it != available_.end()) {
+        it->second.erase({info.maxPlayers - info.playerCount, info.instanceId});
+        if (it->second.empty()) {
+            available_.erase(it);
+        }
+    }
+}
+
 cgs::foundation::GameResult<uint32_t> MapInstanceManager::createInstance(uint32_t mapId,
                                                                          cgs::game::MapType type,
-                                                                         uint32_t maxPlayers) {
+                                                                         uint32_t maxPlayers,
+                                                                         InstanceState state) {
     std::lock_guard<std::mutex> lock(mutex_);
 
     if (instances_.size() >= static_cast<std::size_t>(maxInstances_)) {
@@ -25,12 +54,14 @@ cgs::foundation::GameResult<uint32_t> MapInstanceManager::createInstance(uint32_
     info.instanceId = nextInstanceId_++;
     info.mapId = mapId;
     info.type = type;
-    info.state = InstanceState::Active;
+    info.state = state;
     info.playerCount = 0;
     info.maxPlayers = maxPlayers;
     info.createdAt = std::chrono::steady_clock::now();
+    info.emptySince = info.createdAt;
 
     uint32_t id = info.instanceId;
+    index(info);
     instances_.emplace(id, std::move(info));
 
     return cgs::Result<uint32_t, cgs::foundation::GameError>::ok(id);
@@ -51,6 +82,7 @@ cgs::foundation::GameResult<void> MapInstanceManager::destroyInstance(uint32_t i
                                        "Cannot destroy instance with active players"));
     }
 
+    unindex(it->second);
     instances_.erase(it);
     return cgs::Result<void, cgs::foundation::GameError>::ok();
 }
@@ -65,19 +97,35 @@ bool MapInstanceManager::setInstanceState(uint32_t instanceId, InstanceState sta
 
     auto current = it->second.state;
 
-    // Enforce valid transitions: Active → Draining → ShuttingDown.
+    // Enforce valid transitions: Active → Draining → ShuttingDown, with
+    // pooled instances going Pooled → Active and back once empty, and
+    // migrating and hibernating ones leaving and re-entering Active.
     if (state == InstanceState::Draining && current != InstanceState::Active) {
         return false;
     }
     if (state == InstanceState::ShuttingDown && current != InstanceState::Draining) {
         return false;
     }
-    if (state == InstanceState::Active) {
-        // Cannot transition back to Active.
+    if (state == InstanceState::Active && current != InstanceState::Pooled &&
+        current != InstanceState::Migrating && current != InstanceState::Hibernating) {
+        return false;
+    }
+    if (state == InstanceState::Migrating && current != InstanceState::Active) {
+        return false;
+    }
+    if (state == InstanceState::Hibernating &&
+        (current != InstanceState::Active || it->second.playerCount > 0)) {
+        return false;
+    }
+    if (state == InstanceState::Pooled &&
+        ((current != InstanceState::Active && current != InstanceState::Draining) ||
+         it->second.playerCount > 0)) {
         return false;
     }
 
+    unindex(it->second);
     it->second.state = state;
+    index(it->second);
     return true;
 }
 
@@ -95,9 +143,10 @@ std::vector<MapInstanceInfo> MapInstanceManager::getInstancesByMap(uint32_t mapI
     std::lock_guard<std::mutex> lock(mutex_);
 
     std::vector<MapInstanceInfo> result;
-    for (const auto& [id, info] : instances_) {
-        if (info.mapId == mapId) {
-            result.push_back(info);
+    if (auto it = byMap_.find(mapId); it != byMap_.end()) {
+        result.reserve(it->second.size());
+        for (const uint32_t id : it->second) {
+            result.push_back(instances_.at(id));
         }
     }
     return result;
@@ -106,11 +155,11 @@ std::vector<MapInstanceInfo> MapInstanceManager::getInstancesByMap(uint32_t mapI
 std::vector<MapInstanceInfo> MapInstanceManager::getInstancesByState(InstanceState state) const {
     std::lock_guard<std::mutex> lock(mutex_);
 
+    const auto& ids = byState_[static_cast<std::size_t>(state)];
     std::vector<MapInstanceInfo> result;
-    for (const auto& [id, info] : instances_) {
-        if (info.state == state) {
-            result.push_back(info);
-        }
+    result.reserve(ids.size());
+    for (const uint32_t id : ids) {
+        result.push_back(instances_.at(id));
     }
     return result;
 }
@@ -131,7 +180,9 @@ bool MapInstanceManager::addPlayer(uint32_t instanceId) {
         return false;
     }
 
+    unindex(it->second);
     ++it->second.playerCount;
+    index(it->second);
     return true;
 }
 
@@ -147,7 +198,11 @@ bool MapInstanceManager::removePlayer(uint32_t instanceId) {
         return false;
     }
 
-    --it->second.playerCount;
+    unindex(it->second);
+    if (--it->second.playerCount == 0) {
+        it->second.emptySince = std::chrono::steady_clock::now();
+    }
+    index(it->second);
     return true;
 }
 
@@ -159,21 +214,23 @@ uint32_t MapInstanceManager::instanceCount() const {
 uint32_t MapInstanceManager::instanceCount(InstanceState state) const {
     std::lock_guard<std::mutex> lock(mutex_);
 
-    uint32_t count = 0;
-    for (const auto& [id, info] : instances_) {
-        if (info.state == state) {
-            ++count;
-        }
-    }
-    return count;
+    return static_cast<uint32_t>(byState_[static_cast<std::size_t>(state)].size());
 }
 
 std::vector<uint32_t> MapInstanceManager::findEmptyInstances() const {
     std::lock_guard<std::mutex> lock(mutex_);
 
+    return {empty_.begin(), empty_.end()};
+}
+
+std::vector<uint32_t> MapInstanceManager::findIdleInstances(
+    std::chrono::steady_clock::duration idleFor, std::chrono::steady_clock::time_point now) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
     std::vector<uint32_t> result;
-    for (const auto& [id, info] : instances_) {
-        if (info.playerCount == 0) {
+    for (const uint32_t id : empty_) {
+        const auto& info = instances_.at(id);
+        if (info.state == InstanceState::Active && now - info.emptySince >= idleFor) {
             result.push_back(id);
         }
     }
@@ -184,13 +241,23 @@ std::vector<uint32_t> MapInstanceManager::findAvailableInstances(uint32_t mapId)
     std::lock_guard<std::mutex> lock(mutex_);
 
     std::vector<uint32_t> result;
-    for (const auto& [id, info] : instances_) {
-        if (info.mapId == mapId && info.state == InstanceState::Active &&
-            info.playerCount < info.maxPlayers) {
+    if (auto it = available_.find(mapId); it != available_.end()) {
+        result.reserve(it->second.size());
+        for (const auto& [free, id] : it->second) {
             result.push_back(id);
         }
     }
     return result;
 }
 
+std::optional<uint32_t> MapInstanceManager::bestAvailableInstance(uint32_t mapId) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = available_.find(mapId);
+    if (it == available_.end()) {
+        return std::nullopt;
+    }
+    return it->second.begin()->second;
+}
+
 }  // namespace cgs::service
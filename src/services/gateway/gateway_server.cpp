@@ -9,6 +9,8 @@
 #include "cgs/service/auth_server.hpp"
 #include "cgs/service/gateway_session_manager.hpp"
 #include "cgs/service/route_table.hpp"
+#include "cgs/service/service_link.hpp"
+#include "cgs/service/service_placement.hpp"
 #include "cgs/service/token_bucket.hpp"
 
 #include <atomic>
@@ -19,6 +21,7 @@ namespace cgs::service {
 using cgs::foundation::ErrorCode;
 using cgs::foundation::GameError;
 using cgs::foundation::GameResult;
+using cgs::foundation::InternedString;
 using cgs::foundation::SessionId;
 
 // -- Helpers ------------------------------------------------------------------
@@ -33,10 +36,11 @@ GatewayAction makeReply(uint16_t opcode, std::vector<uint8_t> payload = {}) {
     return action;
 }
 
-GatewayAction makeForward(std::string service) {
+GatewayAction makeForward(const RouteMatch& match) {
     GatewayAction action;
     action.type = GatewayActionType::Forward;
-    action.targetService = std::move(service);
+    action.targetService = match.service;
+    action.targetServiceId = match.serviceId;
     return action;
 }
 
@@ -63,6 +67,15 @@ struct GatewayServer::Impl {
     RouteTable routes;
     TokenBucket rateLimiter;
 
+    // A service's backend links and the placement of sessions over them.
+    struct ServiceLinks {
+        std::vector<std::unique_ptr<ServiceLink>> links;  // by PlacementNodeId
+        ServicePlacement placement;
+    };
+
+    // By RouteServiceId; fixed once the gateway starts.
+    std::vector<std::unique_ptr<ServiceLinks>> links;
+
     std::atomic<bool> running{false};
     std::atomic<uint64_t> messagesRouted{0};
     std::atomic<uint64_t> messagesDropped{0};
@@ -76,14 +89,72 @@ struct GatewayServer::Impl {
           sessions(config.maxConnections),
           rateLimiter(config.rateLimitCapacity, config.rateLimitRefillRate) {}
 
+    /// Routing decision shared by handleMessage() and routeMessage().
+    GameResult<GatewayAction> decide(const GatewaySessionHandle& session,
+                                     uint16_t opcode,
+                                     std::span<const uint8_t> payload) {
+        if (!running.load()) {
+            return GameResult<GatewayAction>::err(
+                GameError(ErrorCode::GatewayNotStarted, "gateway server is not running"));
+        }
+
+        if (!session.open()) {
+            return GameResult<GatewayAction>::err(
+                GameError(ErrorCode::SessionNotFound, "session not found"));
+        }
+
+        // Rate limit check against the client IP's bucket.
+        if (!session.consume()) {
+            rateLimitHits.fetch_add(1, std::memory_order_relaxed);
+            messagesDropped.fetch_add(1, std::memory_order_relaxed);
+            return GameResult<GatewayAction>::err(
+                GameError(ErrorCode::GatewayRateLimited, "rate limit exceeded"));
+        }
+
+        // Update activity timestamp.
+        session.touch();
+
+        // Handle gateway-level opcodes (0x0000-0x00FF).
+        const ClientState state = session.state();
+        if (RouteTable::isGatewayOpcode(opcode)) {
+            return handleGatewayOpcode(session.sessionId(), opcode, payload, state);
+        }
+
+        // Resolve the route for non-gateway opcodes.
+        auto match = routes.resolve(opcode);
+        if (!match.has_value()) {
+            messagesDropped.fetch_add(1, std::memory_order_relaxed);
+            return GameResult<GatewayAction>::ok(makeDrop("no route for opcode"));
+        }
+
+        // Check authentication requirement.
+        if (match->requiresAuth && state != ClientState::Authenticated) {
+            messagesDropped.fetch_add(1, std::memory_order_relaxed);
+            return GameResult<GatewayAction>::err(GameError(
+                ErrorCode::ClientNotAuthenticated, "authentication required for this route"));
+        }
+
+        messagesRouted.fetch_add(1, std::memory_order_relaxed);
+        return GameResult<GatewayAction>::ok(makeForward(*match));
+    }
+
+    /// Link carrying @p sessionId to service @p id, or nullptr.
+    ServiceLink* linkFor(RouteServiceId id, SessionId sessionId) const {
+        if (id >= links.size() || !links[id]) {
+            return nullptr;
+        }
+        const auto node = links[id]->placement.place(sessionId.value());
+        return node ? links[id]->links[*node].get() : nullptr;
+    }
+
     /// Handle gateway-level opcodes (0x0000-0x00FF) internally.
     GameResult<GatewayAction> handleGatewayOpcode(SessionId sessionId,
                                                   uint16_t opcode,
-                                                  std::vector<uint8_t> payload,
-                                                  const ClientSession& session) {
+                                                  std::span<const uint8_t> payload,
+                                                  ClientState state) {
         switch (opcode) {
             case GatewayOpcode::Authenticate: {
-                if (session.state != ClientState::Unauthenticated) {
+                if (state != ClientState::Unauthenticated) {
                     messagesDropped.fetch_add(1, std::memory_order_relaxed);
                     return GameResult<GatewayAction>::ok(makeDrop("already authenticated"));
                 }
@@ -116,7 +187,7 @@ struct GatewayServer::Impl {
             }
 
             case GatewayOpcode::MigrationAck: {
-                if (session.state != ClientState::Migrating) {
+                if (state != ClientState::Migrating) {
                     messagesDropped.fetch_add(1, std::memory_order_relaxed);
                     return GameResult<GatewayAction>::ok(makeDrop("not in migration state"));
                 }
@@ -181,6 +252,36 @@ void GatewayServer::addRoute(uint16_t opcodeMin,
     impl_->routes.addRoute(opcodeMin, opcodeMax, std::move(service), requiresAuth);
 }
 
+ServiceLink& GatewayServer::addServiceLink(std::string_view service,
+                                           ServiceLink::Writer writer,
+                                           double weight) {
+    const RouteServiceId id = impl_->routes.internService(service);
+    if (id >= impl_->links.size()) {
+        impl_->links.resize(static_cast<std::size_t>(id) + 1);
+    }
+    auto& serviceLinks = impl_->links[id];
+    if (!serviceLinks) {
+        serviceLinks = std::make_unique<Impl::ServiceLinks>();
+    }
+
+    // Named by position, so gateways configured alike place alike.  A
+    // weight the placement rejects counts as the default.
+    const auto name = std::to_string(serviceLinks->links.size());
+    if (!serviceLinks->placement.addNode(name, weight)) {
+        (void)serviceLinks->placement.addNode(name);
+    }
+    serviceLinks->links.push_back(std::make_unique<ServiceLink>(std::move(writer)));
+    return *serviceLinks->links.back();
+}
+
+ServicePlacement* GatewayServer::serviceLinkPlacement(std::string_view service) {
+    const auto id = impl_->routes.serviceId(service);
+    if (!id || *id >= impl_->links.size() || !impl_->links[*id]) {
+        return nullptr;
+    }
+    return &impl_->links[*id]->placement;
+}
+
 // -- Connection handling ------------------------------------------------------
 
 GameResult<void> GatewayServer::handleConnect(SessionId sessionId, std::string remoteAddress) {
@@ -189,7 +290,8 @@ GameResult<void> GatewayServer::handleConnect(SessionId sessionId, std::string r
             GameError(ErrorCode::GatewayNotStarted, "gateway server is not running"));
     }
 
-    if (!impl_->sessions.createSession(sessionId, std::move(remoteAddress))) {
+    auto rateLimit = impl_->rateLimiter.bucket(remoteAddress);
+    if (!impl_->sessions.createSession(sessionId, std::move(remoteAddress), std::move(rateLimit))) {
         return GameResult<void>::err(GameError(ErrorCode::ConnectionLimitReached,
                                                "connection limit reached or duplicate session"));
     }
@@ -198,9 +300,9 @@ GameResult<void> GatewayServer::handleConnect(SessionId sessionId, std::string r
 }
 
 void GatewayServer::handleDisconnect(SessionId sessionId) {
-    auto session = impl_->sessions.getSession(sessionId);
-    if (session.has_value()) {
-        impl_->rateLimiter.remove(session->remoteAddress);
+    auto session = impl_->sessions.handle(sessionId);
+    if (session) {
+        impl_->rateLimiter.remove(session.remoteAddress());
     }
     impl_->sessions.removeSession(sessionId);
 }
@@ -208,61 +310,55 @@ void GatewayServer::handleDisconnect(SessionId sessionId) {
 GameResult<GatewayAction> GatewayServer::handleMessage(SessionId sessionId,
                                                        uint16_t opcode,
                                                        std::vector<uint8_t> payload) {
-    if (!impl_->running.load()) {
-        return GameResult<GatewayAction>::err(
-            GameError(ErrorCode::GatewayNotStarted, "gateway server is not running"));
-    }
-
-    auto session = impl_->sessions.getSession(sessionId);
-    if (!session.has_value()) {
-        return GameResult<GatewayAction>::err(
-            GameError(ErrorCode::SessionNotFound, "session not found"));
-    }
-
-    // Rate limit check using the client's IP address.
-    if (!impl_->rateLimiter.consume(session->remoteAddress)) {
-        impl_->rateLimitHits.fetch_add(1, std::memory_order_relaxed);
-        impl_->messagesDropped.fetch_add(1, std::memory_order_relaxed);
-        return GameResult<GatewayAction>::err(
-            GameError(ErrorCode::GatewayRateLimited, "rate limit exceeded"));
-    }
-
-    // Update activity timestamp.
-    impl_->sessions.touchSession(sessionId);
+    return handleMessage(impl_->sessions.handle(sessionId), opcode, std::move(payload));
+}
 
-    // Handle gateway-level opcodes (0x0000-0x00FF).
-    if (RouteTable::isGatewayOpcode(opcode)) {
-        return impl_->handleGatewayOpcode(sessionId, opcode, std::move(payload), *session);
-    }
+GameResult<GatewayAction> GatewayServer::handleMessage(const GatewaySessionHandle& session,
+                                                       uint16_t opcode,
+                                                       std::vector<uint8_t> payload) {
+    return impl_->decide(session, opcode, payload);
+}
 
-    // Resolve the route for non-gateway opcodes.
-    auto match = impl_->routes.resolve(opcode);
-    if (!match.has_value()) {
-        impl_->messagesDropped.fetch_add(1, std::memory_order_relaxed);
-        return GameResult<GatewayAction>::ok(makeDrop("no route for opcode"));
+GameResult<GatewayAction> GatewayServer::routeMessage(const GatewaySessionHandle& session,
+                                                      uint16_t opcode,
+                                                      std::span<const uint8_t> payload) {
+    auto result = impl_->decide(session, opcode, payload);
+    if (result.hasValue() && result.value().type == GatewayActionType::Forward) {
+        ServiceLink* link = impl_->linkFor(result.value().targetServiceId, session.sessionId());
+        if (link != nullptr) {
+            link->forward(session.sessionId(), opcode, payload);
+        }
     }
+    return result;
+}
 
-    // Check authentication requirement.
-    if (match->requiresAuth && session->state != ClientState::Authenticated) {
-        impl_->messagesDropped.fetch_add(1, std::memory_order_relaxed);
-        return GameResult<GatewayAction>::err(
-            GameError(ErrorCode::ClientNotAuthenticated, "authentication required for this route"));
+std::size_t GatewayServer::flushServiceLinks() {
+    std::size_t frames = 0;
+    for (auto& serviceLinks : impl_->links) {
+        if (!serviceLinks) {
+            continue;
+        }
+        for (auto& link : serviceLinks->links) {
+            frames += link->flush();
+        }
     }
+    return frames;
+}
 
-    impl_->messagesRouted.fetch_add(1, std::memory_order_relaxed);
-    return GameResult<GatewayAction>::ok(makeForward(match->service));
+GatewaySessionHandle GatewayServer::sessionHandle(SessionId sessionId) const {
+    return impl_->sessions.handle(sessionId);
 }
 
 // -- Migration ----------------------------------------------------------------
 
 GameResult<void> GatewayServer::initiateServerTransfer(SessionId sessionId,
-                                                       std::string targetService) {
+                                                       InternedString targetService) {
     if (!impl_->running.load()) {
         return GameResult<void>::err(
             GameError(ErrorCode::GatewayNotStarted, "gateway server is not running"));
     }
 
-    if (!impl_->sessions.beginMigration(sessionId, std::move(targetService))) {
+    if (!impl_->sessions.beginMigration(sessionId, targetService)) {
         return GameResult<void>::err(GameError(ErrorCode::MigrationFailed,
                                                "cannot begin migration (session not authenticated "
                                                "or not found)"));
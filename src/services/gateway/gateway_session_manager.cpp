@@ -4,184 +4,323 @@
 #include "cgs/service/gateway_session_manager.hpp"
 
 #include <chrono>
+#include <map>
 
 namespace cgs::service {
 
-GatewaySessionManager::GatewaySessionManager(uint32_t maxSessions) : maxSessions_(maxSessions) {}
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+Clock::rep nowTicks() {
+    return Clock::now().time_since_epoch().count();
+}
+
+Clock::time_point fromTicks(Clock::rep ticks) {
+    return Clock::time_point(Clock::duration(ticks));
+}
+
+}  // anonymous namespace
+
+// -- ExpiryWheel --------------------------------------------------------------
+
+/// Sessions filed by a timestamp in one-second buckets.
+///
+/// Every session has exactly one entry, armed at creation.  A sweep takes
+/// the buckets that can hold timestamps older than its cutoff: entries
+/// whose timestamp moved past the cutoff (a touch) are refiled in their
+/// current bucket, and the rest are kept on a stale list that the next
+/// sweep re-checks.  Removed sessions are released at the next sweep that
+/// reaches them.
+class GatewaySessionManager::ExpiryWheel {
+public:
+    enum class Verdict : uint8_t {
+        Drop,     // no longer tracked by this wheel
+        Keep,     // tracked, but not expired
+        Expired,  // reported once its timestamp is past the cutoff
+    };
+
+    using Key = Clock::rep (*)(const Record&);
+
+    explicit ExpiryWheel(Key key) : key_(key) {}
+
+    void arm(std::shared_ptr<Record> record) {
+        std::lock_guard lock(mutex_);
+        buckets_[bucketOf(key_(*record))].push_back(std::move(record));
+    }
+
+    template <typename Classify>
+    std::vector<cgs::foundation::SessionId> sweep(Clock::rep cutoff, Classify classify) {
+        std::lock_guard lock(mutex_);
+
+        std::vector<std::shared_ptr<Record>> due = std::move(stale_);
+        stale_.clear();
+        const auto end = buckets_.upper_bound(bucketOf(cutoff));
+        for (auto it = buckets_.begin(); it != end; ++it) {
+            due.insert(due.end(),
+                       std::make_move_iterator(it->second.begin()),
+                       std::make_move_iterator(it->second.end()));
+        }
+        buckets_.erase(buckets_.begin(), end);
+
+        std::vector<cgs::foundation::SessionId> expired;
+        for (auto& record : due) {
+            const Verdict verdict = classify(*record);
+            if (verdict == Verdict::Drop) {
+                continue;
+            }
+            const Clock::rep key = key_(*record);
+            if (key >= cutoff) {
+                buckets_[bucketOf(key)].push_back(std::move(record));
+                continue;
+            }
+            if (verdict == Verdict::Expired) {
+                expired.push_back(record->session.sessionId);
+            }
+            stale_.push_back(std::move(record));
+        }
+        return expired;
+    }
+
+private:
+    static Clock::rep bucketOf(Clock::rep ticks) {
+        static const Clock::rep kBucketTicks =
+            std::chrono::duration_cast<Clock::duration>(std::chrono::seconds(1)).count();
+        return ticks / kBucketTicks;
+    }
+
+    Key key_;
+    cgs::foundation::ProfiledMutex mutex_{"gateway.session_expiry"};
+    std::map<Clock::rep, std::vector<std::shared_ptr<Record>>> buckets_;
+    std::vector<std::shared_ptr<Record>> stale_;
+};
+
+// -- GatewaySessionManager ----------------------------------------------------
+
+GatewaySessionManager::GatewaySessionManager(uint32_t maxSessions)
+    : maxSessions_(maxSessions),
+      idleWheel_(std::make_unique<ExpiryWheel>(
+          [](const Record& record) { return record.lastActivity.load(); })),
+      authWheel_(std::make_unique<ExpiryWheel>([](const Record& record) {
+          return record.session.connectedAt.time_since_epoch().count();
+      })) {}
+
+GatewaySessionManager::~GatewaySessionManager() = default;
 
 bool GatewaySessionManager::createSession(cgs::foundation::SessionId sessionId,
-                                          std::string remoteAddress) {
-    std::lock_guard<std::mutex> lock(mutex_);
+                                          std::string remoteAddress,
+                                          std::shared_ptr<AtomicTokenBucket> rateLimit) {
+    Shard& shard = shardFor(sessionId);
+    std::lock_guard lock(shard.mutex);
 
-    if (sessions_.size() >= static_cast<std::size_t>(maxSessions_)) {
+    if (shard.sessions.count(sessionId) > 0) {
         return false;
     }
 
-    if (sessions_.count(sessionId) > 0) {
+    if (total_.fetch_add(1) >= static_cast<std::size_t>(maxSessions_)) {
+        total_.fetch_sub(1);
         return false;
     }
 
-    ClientSession session;
-    session.sessionId = sessionId;
-    session.state = ClientState::Unauthenticated;
-    session.remoteAddress = std::move(remoteAddress);
-    session.connectedAt = std::chrono::steady_clock::now();
-    session.lastActivity = session.connectedAt;
-
-    sessions_.emplace(sessionId, std::move(session));
+    auto record = std::make_shared<Record>();
+    record->session.sessionId = sessionId;
+    record->session.remoteAddress = std::move(remoteAddress);
+    record->session.connectedAt = Clock::now();
+    record->lastActivity.store(record->session.connectedAt.time_since_epoch().count());
+    record->rateLimit = std::move(rateLimit);
+    stateCounts_[static_cast<std::size_t>(ClientState::Unauthenticated)].fetch_add(1);
+
+    idleWheel_->arm(record);
+    authWheel_->arm(record);
+    shard.sessions.emplace(sessionId, std::move(record));
     return true;
 }
 
 bool GatewaySessionManager::authenticateSession(cgs::foundation::SessionId sessionId,
                                                 TokenClaims claims,
                                                 uint64_t userId) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    Shard& shard = shardFor(sessionId);
+    std::lock_guard lock(shard.mutex);
 
-    auto it = sessions_.find(sessionId);
-    if (it == sessions_.end()) {
+    auto it = shard.sessions.find(sessionId);
+    if (it == shard.sessions.end()) {
         return false;
     }
 
-    if (it->second.state != ClientState::Unauthenticated) {
+    Record& record = *it->second;
+    if (record.state.load() != ClientState::Unauthenticated) {
         return false;
     }
 
-    it->second.state = ClientState::Authenticated;
-    it->second.claims = std::move(claims);
-    it->second.userId = userId;
-    it->second.lastActivity = std::chrono::steady_clock::now();
+    record.session.claims = std::move(claims);
+    record.session.userId = userId;
+    record.lastActivity.store(nowTicks());
+    setState(record, ClientState::Authenticated);
     return true;
 }
 
 bool GatewaySessionManager::beginMigration(cgs::foundation::SessionId sessionId,
-                                           std::string targetService) {
-    std::lock_guard<std::mutex> lock(mutex_);
+                                           cgs::foundation::InternedString targetService) {
+    Shard& shard = shardFor(sessionId);
+    std::lock_guard lock(shard.mutex);
 
-    auto it = sessions_.find(sessionId);
-    if (it == sessions_.end()) {
+    auto it = shard.sessions.find(sessionId);
+    if (it == shard.sessions.end()) {
         return false;
     }
 
-    if (it->second.state != ClientState::Authenticated) {
+    Record& record = *it->second;
+    if (record.state.load() != ClientState::Authenticated) {
         return false;
     }
 
-    it->second.state = ClientState::Migrating;
-    it->second.currentService = std::move(targetService);
-    it->second.lastActivity = std::chrono::steady_clock::now();
+    record.session.currentService = targetService;
+    record.lastActivity.store(nowTicks());
+    setState(record, ClientState::Migrating);
     return true;
 }
 
 bool GatewaySessionManager::completeMigration(cgs::foundation::SessionId sessionId) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    Shard& shard = shardFor(sessionId);
+    std::lock_guard lock(shard.mutex);
 
-    auto it = sessions_.find(sessionId);
-    if (it == sessions_.end()) {
+    auto it = shard.sessions.find(sessionId);
+    if (it == shard.sessions.end()) {
         return false;
     }
 
-    if (it->second.state != ClientState::Migrating) {
+    Record& record = *it->second;
+    if (record.state.load() != ClientState::Migrating) {
         return false;
     }
 
-    it->second.state = ClientState::Authenticated;
-    it->second.lastActivity = std::chrono::steady_clock::now();
+    record.lastActivity.store(nowTicks());
+    setState(record, ClientState::Authenticated);
     return true;
 }
 
 void GatewaySessionManager::removeSession(cgs::foundation::SessionId sessionId) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    sessions_.erase(sessionId);
+    Shard& shard = shardFor(sessionId);
+    std::lock_guard lock(shard.mutex);
+
+    auto it = shard.sessions.find(sessionId);
+    if (it != shard.sessions.end()) {
+        Record& record = *it->second;
+        stateCounts_[static_cast<std::size_t>(record.state.load())].fetch_sub(1);
+        record.removed.store(true, std::memory_order_release);
+        shard.sessions.erase(it);
+        total_.fetch_sub(1);
+    }
 }
 
 std::optional<ClientSession> GatewaySessionManager::getSession(
     cgs::foundation::SessionId sessionId) const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    Shard& shard = shardFor(sessionId);
+    std::lock_guard lock(shard.mutex);
 
-    auto it = sessions_.find(sessionId);
-    if (it == sessions_.end()) {
+    auto it = shard.sessions.find(sessionId);
+    if (it == shard.sessions.end()) {
         return std::nullopt;
     }
-    return it->second;
+    return snapshot(*it->second);
+}
+
+GatewaySessionHandle GatewaySessionManager::handle(cgs::foundation::SessionId sessionId) const {
+    Shard& shard = shardFor(sessionId);
+    std::lock_guard lock(shard.mutex);
+
+    auto it = shard.sessions.find(sessionId);
+    if (it == shard.sessions.end()) {
+        return {};
+    }
+    return GatewaySessionHandle(it->second);
 }
 
 void GatewaySessionManager::touchSession(cgs::foundation::SessionId sessionId) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    Shard& shard = shardFor(sessionId);
+    std::lock_guard lock(shard.mutex);
 
-    auto it = sessions_.find(sessionId);
-    if (it != sessions_.end()) {
-        it->second.lastActivity = std::chrono::steady_clock::now();
+    auto it = shard.sessions.find(sessionId);
+    if (it != shard.sessions.end()) {
+        it->second->lastActivity.store(nowTicks());
     }
 }
 
 bool GatewaySessionManager::setCurrentService(cgs::foundation::SessionId sessionId,
-                                              std::string service) {
-    std::lock_guard<std::mutex> lock(mutex_);
+                                              cgs::foundation::InternedString service) {
+    Shard& shard = shardFor(sessionId);
+    std::lock_guard lock(shard.mutex);
 
-    auto it = sessions_.find(sessionId);
-    if (it == sessions_.end()) {
+    auto it = shard.sessions.find(sessionId);
+    if (it == shard.sessions.end()) {
         return false;
     }
 
-    it->second.currentService = std::move(service);
+    it->second->session.currentService = service;
     return true;
 }
 
 std::vector<ClientSession> GatewaySessionManager::getSessionsByState(ClientState state) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-
     std::vector<ClientSession> result;
-    for (const auto& [id, session] : sessions_) {
-        if (session.state == state) {
-            result.push_back(session);
+    for (const Shard& shard : shards_) {
+        std::lock_guard lock(shard.mutex);
+        for (const auto& [id, record] : shard.sessions) {
+            if (record->state.load() == state) {
+                result.push_back(snapshot(*record));
+            }
         }
     }
     return result;
 }
 
 std::size_t GatewaySessionManager::sessionCount() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return sessions_.size();
+    return total_.load();
 }
 
 std::size_t GatewaySessionManager::sessionCount(ClientState state) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    std::size_t count = 0;
-    for (const auto& [id, session] : sessions_) {
-        if (session.state == state) {
-            ++count;
-        }
-    }
-    return count;
+    return stateCounts_[static_cast<std::size_t>(state)].load();
 }
 
 std::vector<cgs::foundation::SessionId> GatewaySessionManager::findIdleSessions(
     std::chrono::seconds idleTimeout) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    auto cutoff = std::chrono::steady_clock::now() - idleTimeout;
-    std::vector<cgs::foundation::SessionId> result;
-    for (const auto& [id, session] : sessions_) {
-        if (session.state == ClientState::Authenticated && session.lastActivity < cutoff) {
-            result.push_back(id);
+    const auto cutoff = (Clock::now() - idleTimeout).time_since_epoch().count();
+    return idleWheel_->sweep(cutoff, [](const Record& record) {
+        if (record.removed.load()) {
+            return ExpiryWheel::Verdict::Drop;
         }
-    }
-    return result;
+        return record.state.load() == ClientState::Authenticated ? ExpiryWheel::Verdict::Expired
+                                                                 : ExpiryWheel::Verdict::Keep;
+    });
 }
 
 std::vector<cgs::foundation::SessionId> GatewaySessionManager::findExpiredAuthSessions(
     std::chrono::seconds authTimeout) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    auto cutoff = std::chrono::steady_clock::now() - authTimeout;
-    std::vector<cgs::foundation::SessionId> result;
-    for (const auto& [id, session] : sessions_) {
-        if (session.state == ClientState::Unauthenticated && session.connectedAt < cutoff) {
-            result.push_back(id);
+    // Sessions never return to Unauthenticated, so others leave this wheel.
+    const auto cutoff = (Clock::now() - authTimeout).time_since_epoch().count();
+    return authWheel_->sweep(cutoff, [](const Record& record) {
+        if (record.removed.load() || record.state.load() != ClientState::Unauthenticated) {
+            return ExpiryWheel::Verdict::Drop;
         }
-    }
-    return result;
+        return ExpiryWheel::Verdict::Expired;
+    });
+}
+
+ClientSession GatewaySessionManager::snapshot(const Record& record) {
+    ClientSession session = record.session;
+    session.state = record.state.load();
+    session.lastActivity = fromTicks(record.lastActivity.load());
+    return session;
+}
+
+GatewaySessionManager::Shard& GatewaySessionManager::shardFor(
+    cgs::foundation::SessionId sessionId) const noexcept {
+    return shards_[std::hash<cgs::foundation::SessionId>{}(sessionId) & (kShards - 1)];
+}
+
+void GatewaySessionManager::setState(Record& record, ClientState state) {
+    stateCounts_[static_cast<std::size_t>(record.state.load())].fetch_sub(1);
+    stateCounts_[static_cast<std::size_t>(state)].fetch_add(1);
+    record.state.store(state);
 }
 
 }  // namespace cgs::service
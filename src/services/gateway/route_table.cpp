@@ -7,6 +7,15 @@
 
 namespace cgs::service {
 
+RouteTable::RouteTable() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    rebuildLocked();
+}
+
+RouteTable::~RouteTable() {
+    delete table_.load();
+}
+
 void RouteTable::addRoute(uint16_t opcodeMin,
                           uint16_t opcodeMax,
                           std::string service,
@@ -21,18 +30,46 @@ void RouteTable::addRoute(uint16_t opcodeMin,
 
 void RouteTable::addRoute(RouteEntry entry) {
     std::lock_guard<std::mutex> lock(mutex_);
+    internLocked(entry.service);
     routes_.push_back(std::move(entry));
+    rebuildLocked();
 }
 
 std::optional<RouteMatch> RouteTable::resolve(uint16_t opcode) const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    ReadGuard guard(readers_);
+    const Compiled* table = table_.load();
+    const uint16_t slot = table->slots[opcode];
+    if (slot == 0) {
+        return std::nullopt;
+    }
+    const auto id = static_cast<RouteServiceId>((slot >> 1) - 1);
+    return RouteMatch{id, table->services[id].view(), (slot & 1) != 0};
+}
 
-    for (const auto& route : routes_) {
-        if (opcode >= route.opcodeMin && opcode <= route.opcodeMax) {
-            return RouteMatch{route.service, route.requiresAuth};
-        }
+std::optional<RouteServiceId> RouteTable::serviceId(std::string_view service) const {
+    // A name never interned was never added either
+    const auto interned = cgs::foundation::StringInterner::instance().find(service);
+    if (!interned) {
+        return std::nullopt;
+    }
+    const auto name = cgs::foundation::InternedString::fromId(*interned);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = std::find(names_.begin(), names_.end(), name);
+    if (it == names_.end()) {
+        return std::nullopt;
     }
-    return std::nullopt;
+    return static_cast<RouteServiceId>(it - names_.begin());
+}
+
+RouteServiceId RouteTable::internService(std::string_view service) {
+    const cgs::foundation::InternedString name(service);
+    std::lock_guard<std::mutex> lock(mutex_);
+    return internLocked(name);
+}
+
+std::string_view RouteTable::serviceName(RouteServiceId id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return id < names_.size() ? names_[id].view() : std::string_view();
 }
 
 bool RouteTable::isGatewayOpcode(uint16_t opcode) {
@@ -49,11 +86,47 @@ void RouteTable::removeRoutesForService(std::string_view service) {
                                  routes_.end(),
                                  [&](const RouteEntry& e) { return e.service == service; }),
                   routes_.end());
+    rebuildLocked();
 }
 
 void RouteTable::clear() {
     std::lock_guard<std::mutex> lock(mutex_);
     routes_.clear();
+    rebuildLocked();
+}
+
+RouteServiceId RouteTable::internLocked(cgs::foundation::InternedString service) {
+    auto it = std::find(names_.begin(), names_.end(), service);
+    if (it != names_.end()) {
+        return static_cast<RouteServiceId>(it - names_.begin());
+    }
+    names_.push_back(service);
+    return static_cast<RouteServiceId>(names_.size() - 1);
+}
+
+void RouteTable::rebuildLocked() {
+    auto next = std::make_unique<Compiled>();
+    next->services = names_;
+
+    // Earlier routes win, as with the first-match scan this replaces.
+    for (const auto& route : routes_) {
+        const RouteServiceId id = internLocked(route.service);
+        const auto slot = static_cast<uint16_t>(((id + 1) << 1) | (route.requiresAuth ? 1 : 0));
+        for (uint32_t op = route.opcodeMin; op <= route.opcodeMax; ++op) {
+            uint16_t& target = next->slots[op];
+            if (target == 0) {
+                target = slot;
+            }
+        }
+    }
+
+    const Compiled* old = table_.exchange(next.release());
+    if (old != nullptr) {
+        retired_.emplace_back(old);
+    }
+    if (readers_.load() == 0) {
+        retired_.clear();
+    }
 }
 
 }  // namespace cgs::service
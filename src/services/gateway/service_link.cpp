@@ -0,0 +1,141 @@
+/// @file service_link.cpp
+/// @brief ServiceLink implementation.
+
+#include "cgs/service/service_link.hpp"
+
+#include <algorithm>
+
+namespace cgs::service {
+
+using cgs::foundation::SessionId;
+
+namespace {
+
+uint32_t readU32(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+uint64_t readU64(const uint8_t* p) {
+    return (static_cast<uint64_t>(readU32(p)) << 32) | readU32(p + 4);
+}
+
+uint16_t readU16(const uint8_t* p) {
+    return static_cast<uint16_t>((p[0] << 8) | p[1]);
+}
+
+}  // anonymous namespace
+
+ServiceLink::ServiceLink(Writer writer) : writer_(std::move(writer)) {}
+
+void ServiceLink::forward(SessionId sessionId, uint16_t opcode, std::span<const uint8_t> payload) {
+    const auto length = static_cast<uint32_t>(kHeaderSize + payload.size());
+    const uint64_t sid = sessionId.value();
+
+    Header header{};
+    for (std::size_t i = 0; i < 4; ++i) {
+        header[i] = static_cast<uint8_t>(length >> (24 - 8 * i));
+    }
+    for (std::size_t i = 0; i < 8; ++i) {
+        header[4 + i] = static_cast<uint8_t>(sid >> (56 - 8 * i));
+    }
+    header[12] = static_cast<uint8_t>(opcode >> 8);
+    header[13] = static_cast<uint8_t>(opcode & 0xFF);
+
+    std::lock_guard<std::mutex> lock(sendMutex_);
+    headers_.push_back(header);
+    payloads_.push_back(payload);
+}
+
+std::size_t ServiceLink::flush() {
+    std::lock_guard<std::mutex> lock(sendMutex_);
+    const std::size_t frames = headers_.size();
+    if (frames == 0) {
+        return 0;
+    }
+
+    // Built only now: headers_ may have reallocated while frames queued.
+    chunks_.clear();
+    for (std::size_t i = 0; i < frames; ++i) {
+        chunks_.emplace_back(headers_[i]);
+        if (!payloads_[i].empty()) {
+            chunks_.push_back(payloads_[i]);
+        }
+    }
+    writer_(chunks_);
+
+    headers_.clear();
+    payloads_.clear();
+    framesForwarded_ += frames;
+    return frames;
+}
+
+bool ServiceLink::receive(std::span<const uint8_t> bytes, const Receiver& onFrame) {
+    std::lock_guard<std::mutex> lock(receiveMutex_);
+
+    // Complete a frame split across reads first; the rest parses in place.
+    if (!partial_.empty()) {
+        if (partial_.size() < 4) {
+            const std::size_t take = std::min(4 - partial_.size(), bytes.size());
+            partial_.insert(partial_.end(), bytes.begin(), bytes.begin() + static_cast<std::ptrdiff_t>(take));
+            bytes = bytes.subspan(take);
+            if (partial_.size() < 4) {
+                return true;
+            }
+        }
+        const uint32_t length = readU32(partial_.data());
+        if (length < kHeaderSize || length > kMaxFrameSize) {
+            partial_.clear();
+            return false;
+        }
+        const std::size_t take = std::min<std::size_t>(length - partial_.size(), bytes.size());
+        partial_.insert(partial_.end(), bytes.begin(), bytes.begin() + static_cast<std::ptrdiff_t>(take));
+        bytes = bytes.subspan(take);
+        if (partial_.size() < length) {
+            return true;
+        }
+        if (parse(partial_, onFrame) == kMalformed) {
+            partial_.clear();
+            return false;
+        }
+        partial_.clear();
+    }
+
+    const std::size_t consumed = parse(bytes, onFrame);
+    if (consumed == kMalformed) {
+        return false;
+    }
+    partial_.assign(bytes.begin() + static_cast<std::ptrdiff_t>(consumed), bytes.end());
+    return true;
+}
+
+std::size_t ServiceLink::pendingFrames() const {
+    std::lock_guard<std::mutex> lock(sendMutex_);
+    return headers_.size();
+}
+
+uint64_t ServiceLink::framesForwarded() const {
+    std::lock_guard<std::mutex> lock(sendMutex_);
+    return framesForwarded_;
+}
+
+std::size_t ServiceLink::parse(std::span<const uint8_t> bytes, const Receiver& onFrame) {
+    std::size_t offset = 0;
+    while (bytes.size() - offset >= 4) {
+        const uint8_t* frame = bytes.data() + offset;
+        const uint32_t length = readU32(frame);
+        if (length < kHeaderSize || length > kMaxFrameSize) {
+            return kMalformed;
+        }
+        if (bytes.size() - offset < length) {
+            break;
+        }
+        onFrame(SessionId(readU64(frame + 4)),
+                readU16(frame + 12),
+                bytes.subspan(offset + kHeaderSize, length - kHeaderSize));
+        offset += length;
+    }
+    return offset;
+}
+
+}  // namespace cgs::service
@@ -7,63 +7,121 @@
 
 namespace cgs::service {
 
+// -- AtomicTokenBucket --------------------------------------------------------
+
+AtomicTokenBucket::AtomicTokenBucket(uint32_t capacity, uint32_t refillRate)
+    : interval_(1), refills_(refillRate > 0) {
+    using Clock = std::chrono::steady_clock;
+    if (refills_) {
+        const auto perSecond = std::chrono::duration_cast<Clock::duration>(std::chrono::seconds(1));
+        interval_ = std::max<int64_t>(1, static_cast<int64_t>(perSecond.count()) / refillRate);
+    }
+    limit_ = static_cast<int64_t>(capacity) * interval_;
+}
+
+bool AtomicTokenBucket::consume(uint32_t tokens) noexcept {
+    const int64_t t = now();
+    const int64_t cost = static_cast<int64_t>(tokens) * interval_;
+    int64_t fullAt = fullAt_.load(std::memory_order_relaxed);
+    int64_t next = 0;
+    do {
+        next = std::max(fullAt, t) + cost;
+        if (next - t > limit_) {
+            return false;
+        }
+    } while (!fullAt_.compare_exchange_weak(fullAt, next, std::memory_order_relaxed));
+    return true;
+}
+
+uint32_t AtomicTokenBucket::available() const noexcept {
+    const int64_t t = now();
+    const int64_t used = std::max(fullAt_.load(std::memory_order_relaxed), t) - t;
+    return static_cast<uint32_t>((limit_ - used) / interval_);
+}
+
+void AtomicTokenBucket::reset() noexcept {
+    fullAt_.store(0, std::memory_order_relaxed);
+}
+
+int64_t AtomicTokenBucket::now() const noexcept {
+    if (!refills_) {
+        return 0;
+    }
+    return static_cast<int64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+}
+
+// -- TokenBucket --------------------------------------------------------------
+
 TokenBucket::TokenBucket(uint32_t capacity, uint32_t refillRate)
     : capacity_(capacity), refillRate_(refillRate) {}
 
 bool TokenBucket::consume(const std::string& key) {
-    return consume(key, 1);
+    return consume(RateLimitKey::from(key), 1);
 }
 
 bool TokenBucket::consume(const std::string& key, uint32_t tokens) {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    auto it = buckets_.find(key);
-    if (it == buckets_.end()) {
-        auto cap = static_cast<double>(capacity_);
-        auto [inserted, _] = buckets_.emplace(key, Bucket{cap, std::chrono::steady_clock::now()});
-        it = inserted;
-    }
-
-    refill(it->second);
+    return consume(RateLimitKey::from(key), tokens);
+}
 
-    auto required = static_cast<double>(tokens);
-    if (it->second.tokens < required) {
-        return false;
-    }
+bool TokenBucket::consume(RateLimitKey key, uint32_t tokens) {
+    return bucket(key)->consume(tokens);
+}
 
-    it->second.tokens -= required;
-    return true;
+bool TokenBucket::consume(cgs::foundation::SessionId sessionId, uint32_t tokens) {
+    return consume(sessionKey(sessionId), tokens);
 }
 
 uint32_t TokenBucket::available(const std::string& key) const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    return available(RateLimitKey::from(key));
+}
 
-    auto it = buckets_.find(key);
-    if (it == buckets_.end()) {
+uint32_t TokenBucket::available(RateLimitKey key) const {
+    Shard& shard = shardFor(key);
+    std::lock_guard lock(shard.mutex);
+
+    auto it = shard.buckets.find(key);
+    if (it == shard.buckets.end()) {
         return capacity_;
     }
+    return it->second->available();
+}
 
-    refill(it->second);
-    return static_cast<uint32_t>(it->second.tokens);
+std::shared_ptr<AtomicTokenBucket> TokenBucket::bucket(const std::string& key) {
+    return bucket(RateLimitKey::from(key));
+}
+
+std::shared_ptr<AtomicTokenBucket> TokenBucket::bucket(RateLimitKey key) {
+    Shard& shard = shardFor(key);
+    std::lock_guard lock(shard.mutex);
+
+    auto& slot = shard.buckets[key];
+    if (!slot) {
+        slot = std::make_shared<AtomicTokenBucket>(capacity_, refillRate_);
+    }
+    return slot;
 }
 
 void TokenBucket::remove(const std::string& key) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    buckets_.erase(key);
+    remove(RateLimitKey::from(key));
+}
+
+void TokenBucket::remove(RateLimitKey key) {
+    Shard& shard = shardFor(key);
+    std::lock_guard lock(shard.mutex);
+    shard.buckets.erase(key);
 }
 
 void TokenBucket::reset(const std::string& key) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    buckets_[key] = Bucket{static_cast<double>(capacity_), std::chrono::steady_clock::now()};
+    bucket(RateLimitKey::from(key))->reset();
 }
 
-void TokenBucket::refill(Bucket& bucket) const {
-    auto now = std::chrono::steady_clock::now();
-    auto elapsed = std::chrono::duration<double>(now - bucket.lastRefill).count();
+RateLimitKey TokenBucket::sessionKey(cgs::foundation::SessionId sessionId) noexcept {
+    // 0x5345:: ("SE") is unassigned IPv6 space.
+    return {0x5345534E00000000ULL, sessionId.value()};
+}
 
-    auto added = elapsed * static_cast<double>(refillRate_);
-    bucket.tokens = std::min(bucket.tokens + added, static_cast<double>(capacity_));
-    bucket.lastRefill = now;
+TokenBucket::Shard& TokenBucket::shardFor(const RateLimitKey& key) const {
+    return shards_[RateLimitKeyHash{}(key) & (kShards - 1)];
 }
 
 }  // namespace cgs::service
@@ -14,6 +14,19 @@ float EloCalculator::expectedScore(int32_t ratingA, int32_t ratingB) {
     return 1.0f / (1.0f + std::pow(10.0f, exponent));
 }
 
+void EloCalculator::expectedScores(std::span<const int32_t> ratingsA,
+                                   std::span<const int32_t> ratingsB,
+                                   std::span<float> out) {
+    const std::size_t n = std::min({ratingsA.size(), ratingsB.size(), out.size()});
+    // 10^(d/400) as exp(d * ln(10)/400): a branch-free loop the compiler
+    // can vectorize.
+    constexpr float kScale = 2.302585093f / 400.0f;
+    for (std::size_t i = 0; i < n; ++i) {
+        const float diff = static_cast<float>(ratingsB[i] - ratingsA[i]);
+        out[i] = 1.0f / (1.0f + std::exp(diff * kScale));
+    }
+}
+
 int32_t EloCalculator::newRating(int32_t currentRating,
                                  float actualScore,
                                  float expected,
@@ -45,6 +58,134 @@ float EloCalculator::matchQuality(const std::vector<int32_t>& ratings) {
     return std::clamp(quality, 0.0f, 1.0f);
 }
 
+namespace {
+
+/// Team averages and the gap between the strongest and weakest team.
+struct TeamSums {
+    std::vector<double> sums;
+    std::vector<double> sizes;
+
+    [[nodiscard]] double spread() const {
+        double lo = sums[0] / sizes[0];
+        double hi = lo;
+        for (std::size_t t = 1; t < sums.size(); ++t) {
+            const double avg = sums[t] / sizes[t];
+            lo = std::min(lo, avg);
+            hi = std::max(hi, avg);
+        }
+        return hi - lo;
+    }
+};
+
+}  // anonymous namespace
+
+std::vector<uint32_t> EloCalculator::balanceTeams(std::span<const int32_t> ratings,
+                                                  uint32_t teamCount,
+                                                  std::chrono::microseconds budget) {
+    const std::size_t n = ratings.size();
+    if (teamCount < 2 || n < teamCount) {
+        return {};
+    }
+    const auto deadline = std::chrono::steady_clock::now() + budget;
+
+    // Capacity: equal split, earlier teams take the remainder.
+    std::vector<std::size_t> capacity(teamCount, n / teamCount);
+    for (std::size_t t = 0; t < n % teamCount; ++t) {
+        ++capacity[t];
+    }
+
+    // Greedy: strongest first onto the team with the lowest sum per slot.
+    std::vector<std::size_t> order(n);
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return ratings[a] > ratings[b];
+    });
+
+    std::vector<uint32_t> teams(n, 0);
+    std::vector<std::size_t> filled(teamCount, 0);
+    TeamSums state{std::vector<double>(teamCount, 0.0), std::vector<double>(teamCount, 0.0)};
+    for (std::size_t t = 0; t < teamCount; ++t) {
+        state.sizes[t] = static_cast<double>(capacity[t]);
+    }
+    for (std::size_t i : order) {
+        std::size_t best = teamCount;
+        for (std::size_t t = 0; t < teamCount; ++t) {
+            if (filled[t] < capacity[t] &&
+                (best == teamCount || state.sums[t] / state.sizes[t] <
+                                          state.sums[best] / state.sizes[best])) {
+                best = t;
+            }
+        }
+        teams[i] = static_cast<uint32_t>(best);
+        ++filled[best];
+        state.sums[best] += ratings[i];
+    }
+
+    // Local search: apply the best narrowing swap until none is left or
+    // the budget runs out.
+    double spread = state.spread();
+    while (spread > 0.0 && std::chrono::steady_clock::now() < deadline) {
+        double bestSpread = spread;
+        std::size_t bestI = n;
+        std::size_t bestJ = n;
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t j = i + 1; j < n; ++j) {
+                const uint32_t a = teams[i];
+                const uint32_t b = teams[j];
+                if (a == b || ratings[i] == ratings[j]) {
+                    continue;
+                }
+                const double delta = static_cast<double>(ratings[j]) - ratings[i];
+                state.sums[a] += delta;
+                state.sums[b] -= delta;
+                const double candidate = state.spread();
+                state.sums[a] -= delta;
+                state.sums[b] += delta;
+                if (candidate < bestSpread) {
+                    bestSpread = candidate;
+                    bestI = i;
+                    bestJ = j;
+                }
+            }
+        }
+        if (bestI == n) {
+            break;
+        }
+        const double delta = static_cast<double>(ratings[bestJ]) - ratings[bestI];
+        state.sums[teams[bestI]] += delta;
+        state.sums[teams[bestJ]] -= delta;
+        std::swap(teams[bestI], teams[bestJ]);
+        spread = bestSpread;
+    }
+    return teams;
+}
+
+float EloCalculator::teamBalance(std::span<const int32_t> ratings,
+                                 std::span<const uint32_t> teams,
+                                 uint32_t teamCount) {
+    if (teamCount < 2 || teams.size() != ratings.size()) {
+        return 1.0f;
+    }
+    TeamSums state{std::vector<double>(teamCount, 0.0), std::vector<double>(teamCount, 0.0)};
+    for (std::size_t i = 0; i < ratings.size(); ++i) {
+        if (teams[i] >= teamCount) {
+            return 0.0f;
+        }
+        state.sums[teams[i]] += ratings[i];
+        state.sizes[teams[i]] += 1.0;
+    }
+    for (double size : state.sizes) {
+        if (size == 0.0) {
+            return 0.0f;
+        }
+    }
+
+    // Expected score of the strongest team against the weakest, mapped
+    // from [0.5, 1.0] onto [1.0, 0.0].
+    const double expected = 1.0 / (1.0 + std::pow(10.0, -state.spread() / 400.0));
+    return std::clamp(static_cast<float>(2.0 * (1.0 - expected)), 0.0f, 1.0f);
+}
+
 bool EloCalculator::isWithinTolerance(int32_t ratingA, int32_t ratingB, int32_t tolerance) {
     return std::abs(ratingA - ratingB) <= tolerance;
 }
@@ -7,10 +7,13 @@
 #include "cgs/foundation/error_code.hpp"
 #include "cgs/foundation/game_error.hpp"
 #include "cgs/service/elo_calculator.hpp"
-#include "cgs/service/matchmaking_queue.hpp"
+#include "cgs/service/matchmaking_engine.hpp"
 #include "cgs/service/party_manager.hpp"
 
 #include <atomic>
+#include <chrono>
+#include <optional>
+#include <vector>
 
 namespace cgs::service {
 
@@ -23,8 +26,9 @@ using cgs::foundation::GameResult;
 struct LobbyServer::Impl {
     LobbyConfig config;
 
-    MatchmakingQueue queue;
+    MatchmakingEngine matchmaking;
     PartyManager parties;
+    ServicePlacement gameServers;
 
     std::atomic<bool> running{false};
     std::atomic<uint64_t> matchesFormed{0};
@@ -32,7 +36,35 @@ struct LobbyServer::Impl {
     std::atomic<uint64_t> partiesDisbanded{0};
 
     explicit Impl(LobbyConfig cfg)
-        : config(std::move(cfg)), queue(config.queueConfig), parties(config.maxPartySize) {}
+        : config(std::move(cfg)),
+          matchmaking(config.queueConfig),
+          parties(config.maxPartySize) {}
+
+    /// Ticket for a member of @p party at the party's cached rating.
+    static MatchmakingTicket partyTicket(const Party& party, uint64_t playerId) {
+        MatchmakingTicket ticket;
+        ticket.playerId = playerId;
+        ticket.rating.mmr = party.averageRating;
+        ticket.mode = party.preferredMode;
+        ticket.region = Region::Any;
+        ticket.enqueuedAt = std::chrono::steady_clock::now();
+        return ticket;
+    }
+
+    /// Members of @p partyId if it is queued, else empty.
+    std::vector<uint64_t> queuedPartyMembers(PartyId partyId) const {
+        std::vector<uint64_t> members;
+        parties.visitParty(partyId, [&](const Party& party) {
+            if (!party.inQueue) {
+                return;
+            }
+            members.reserve(party.members.size());
+            for (const auto& member : party.members) {
+                members.push_back(member.playerId);
+            }
+        });
+        return members;
+    }
 };
 
 // -- Construction / destruction / move ----------------------------------------
@@ -86,15 +118,15 @@ GameResult<void> LobbyServer::enqueuePlayer(uint64_t playerId,
     ticket.region = region;
     ticket.enqueuedAt = std::chrono::steady_clock::now();
 
-    return impl_->queue.enqueue(std::move(ticket));
+    return impl_->matchmaking.enqueue(std::move(ticket));
 }
 
 bool LobbyServer::dequeuePlayer(uint64_t playerId) {
-    return impl_->queue.dequeue(playerId);
+    return impl_->matchmaking.dequeue(playerId);
 }
 
 bool LobbyServer::isPlayerQueued(uint64_t playerId) const {
-    return impl_->queue.isQueued(playerId);
+    return impl_->matchmaking.isQueued(playerId);
 }
 
 // -- Party management ---------------------------------------------------------
@@ -117,9 +149,13 @@ GameResult<PartyId> LobbyServer::createParty(uint64_t leaderId,
 }
 
 GameResult<void> LobbyServer::disbandParty(PartyId partyId, uint64_t requesterId) {
+    const auto members = impl_->queuedPartyMembers(partyId);
     auto result = impl_->parties.disbandParty(partyId, requesterId);
 
     if (result.hasValue()) {
+        for (uint64_t playerId : members) {
+            (void)impl_->matchmaking.dequeue(playerId);
+        }
         impl_->partiesDisbanded.fetch_add(1, std::memory_order_relaxed);
     }
 
@@ -130,11 +166,42 @@ GameResult<void> LobbyServer::addPartyMember(PartyId partyId,
                                              uint64_t playerId,
                                              const std::string& name,
                                              PlayerRating rating) {
-    return impl_->parties.addMember(partyId, playerId, name, rating);
+    auto result = impl_->parties.addMember(partyId, playerId, name, rating);
+    if (result.hasError()) {
+        return result;
+    }
+
+    // A queued party takes the new member into the queue at the updated
+    // party rating; members already queued keep their tickets.
+    std::optional<MatchmakingTicket> ticket;
+    impl_->parties.visitParty(partyId, [&](const Party& party) {
+        if (party.inQueue) {
+            ticket = impl_->partyTicket(party, playerId);
+        }
+    });
+    if (ticket.has_value()) {
+        (void)impl_->matchmaking.enqueue(std::move(*ticket));
+    }
+    return result;
 }
 
 GameResult<void> LobbyServer::removePartyMember(PartyId partyId, uint64_t playerId) {
-    return impl_->parties.removeMember(partyId, playerId);
+    const auto queued = impl_->queuedPartyMembers(partyId);
+    auto result = impl_->parties.removeMember(partyId, playerId);
+    if (result.hasError() || queued.empty()) {
+        return result;
+    }
+
+    // The leader leaving disbands the party, taking every member out of
+    // the queue; otherwise only the leaving member goes.
+    if (impl_->parties.visitParty(partyId, [](const Party&) {})) {
+        (void)impl_->matchmaking.dequeue(playerId);
+    } else {
+        for (uint64_t id : queued) {
+            (void)impl_->matchmaking.dequeue(id);
+        }
+    }
+    return result;
 }
 
 GameResult<void> LobbyServer::promotePartyLeader(PartyId partyId,
@@ -143,10 +210,20 @@ GameResult<void> LobbyServer::promotePartyLeader(PartyId partyId,
     return impl_->parties.promoteLeader(partyId, requesterId, newLeaderId);
 }
 
+GameResult<void> LobbyServer::setPartyMemberReady(PartyId partyId,
+                                                  uint64_t playerId,
+                                                  bool ready) {
+    return impl_->parties.setReady(partyId, playerId, ready);
+}
+
 std::optional<Party> LobbyServer::getParty(PartyId partyId) const {
     return impl_->parties.getParty(partyId);
 }
 
+std::optional<PartySummary> LobbyServer::partySummary(PartyId partyId) const {
+    return impl_->parties.partySummary(partyId);
+}
+
 std::optional<PartyId> LobbyServer::getPlayerParty(uint64_t playerId) const {
     return impl_->parties.getPlayerParty(playerId);
 }
@@ -159,37 +236,27 @@ GameResult<void> LobbyServer::enqueueParty(PartyId partyId) {
             GameError(ErrorCode::LobbyNotStarted, "lobby server is not running"));
     }
 
-    auto party = impl_->parties.getParty(partyId);
-    if (!party.has_value()) {
+    // One pass under the party lock: tickets at the cached average rating.
+    std::vector<MatchmakingTicket> tickets;
+    const bool found = impl_->parties.visitParty(partyId, [&](const Party& party) {
+        tickets.reserve(party.members.size());
+        for (const auto& member : party.members) {
+            tickets.push_back(impl_->partyTicket(party, member.playerId));
+        }
+    });
+    if (!found) {
         return GameResult<void>::err(GameError(ErrorCode::PartyNotFound, "party not found"));
     }
-
-    // Calculate average rating for the party.
-    auto avgRating = impl_->parties.averagePartyRating(partyId);
-    if (!avgRating.has_value()) {
+    if (tickets.empty()) {
         return GameResult<void>::err(GameError(ErrorCode::PartyNotFound, "party has no members"));
     }
 
-    // Enqueue each member with the party's average rating.
-    PlayerRating partyRating;
-    partyRating.mmr = *avgRating;
-
-    for (const auto& member : party->members) {
-        MatchmakingTicket ticket;
-        ticket.playerId = member.playerId;
-        ticket.rating = partyRating;
-        ticket.mode = party->preferredMode;
-        ticket.region = Region::Any;
-        ticket.enqueuedAt = std::chrono::steady_clock::now();
-
-        auto enqueueResult = impl_->queue.enqueue(std::move(ticket));
+    for (std::size_t i = 0; i < tickets.size(); ++i) {
+        auto enqueueResult = impl_->matchmaking.enqueue(tickets[i]);
         if (enqueueResult.hasError()) {
             // Rollback: remove already-enqueued members.
-            for (const auto& m : party->members) {
-                if (m.playerId == member.playerId) {
-                    break;
-                }
-                (void)impl_->queue.dequeue(m.playerId);
+            for (std::size_t j = 0; j < i; ++j) {
+                (void)impl_->matchmaking.dequeue(tickets[j].playerId);
             }
             return enqueueResult;
         }
@@ -202,13 +269,19 @@ GameResult<void> LobbyServer::enqueueParty(PartyId partyId) {
 }
 
 GameResult<void> LobbyServer::dequeueParty(PartyId partyId) {
-    auto party = impl_->parties.getParty(partyId);
-    if (!party.has_value()) {
+    std::vector<uint64_t> members;
+    const bool found = impl_->parties.visitParty(partyId, [&](const Party& party) {
+        members.reserve(party.members.size());
+        for (const auto& member : party.members) {
+            members.push_back(member.playerId);
+        }
+    });
+    if (!found) {
         return GameResult<void>::err(GameError(ErrorCode::PartyNotFound, "party not found"));
     }
 
-    for (const auto& member : party->members) {
-        (void)impl_->queue.dequeue(member.playerId);
+    for (uint64_t playerId : members) {
+        (void)impl_->matchmaking.dequeue(playerId);
     }
 
     (void)impl_->parties.setInQueue(partyId, false);
@@ -219,17 +292,36 @@ GameResult<void> LobbyServer::dequeueParty(PartyId partyId) {
 // -- Match processing ---------------------------------------------------------
 
 std::vector<MatchResult> LobbyServer::processMatchmaking() {
+    // Match every shard, then collect what they formed.
     std::vector<MatchResult> matches;
-
-    // Drain all possible matches from the queue.
-    while (auto match = impl_->queue.tryMatch()) {
-        impl_->matchesFormed.fetch_add(1, std::memory_order_relaxed);
-        matches.push_back(std::move(*match));
+    (void)impl_->matchmaking.runCycle();
+    impl_->matchmaking.drainMatches(matches);
+    impl_->matchesFormed.fetch_add(matches.size(), std::memory_order_relaxed);
+    for (auto& match : matches) {
+        if (auto server = impl_->gameServers.place(match.matchId)) {
+            if (auto node = impl_->gameServers.node(*server)) {
+                match.gameServer = std::move(node->name);
+            }
+        }
     }
 
     return matches;
 }
 
+void LobbyServer::setMatchmakingExecutor(MatchmakingEngine::ParallelExecutor executor) {
+    impl_->matchmaking.setParallelExecutor(std::move(executor));
+}
+
+std::vector<MatchmakingShardStats> LobbyServer::matchmakingStats() const {
+    return impl_->matchmaking.shardStats();
+}
+
+// -- Game server placement ----------------------------------------------------
+
+ServicePlacement& LobbyServer::gameServers() noexcept {
+    return impl_->gameServers;
+}
+
 // -- ELO updates --------------------------------------------------------------
 
 void LobbyServer::updateRatings(PlayerRating& winnerRating, PlayerRating& loserRating) {
@@ -250,7 +342,7 @@ void LobbyServer::updateRatings(PlayerRating& winnerRating, PlayerRating& loserR
 
 LobbyStats LobbyServer::stats() const {
     LobbyStats s;
-    s.queuedPlayers = impl_->queue.queueSize();
+    s.queuedPlayers = impl_->matchmaking.queueSize();
     s.matchesFormed = impl_->matchesFormed.load(std::memory_order_relaxed);
     s.activeParties = impl_->parties.partyCount();
     s.partiesCreated = impl_->partiesCreated.load(std::memory_order_relaxed);
@@ -0,0 +1,219 @@
+/// @file matchmaking_engine.cpp
+/// @brief MatchmakingEngine implementation.
+
+#include "cgs/service/matchmaking_engine.hpp"
+
+#include "cgs/foundation/error_code.hpp"
+#include "cgs/foundation/game_error.hpp"
+
+#include <utility>
+
+namespace cgs::service {
+
+namespace {
+
+std::size_t modeIndex(GameMode mode) noexcept {
+    return static_cast<std::size_t>(mode);
+}
+
+// Region::Any is 0; shards hold the five concrete regions.
+std::size_t regionIndex(Region region) noexcept {
+    return static_cast<std::size_t>(region) - 1;
+}
+
+}  // anonymous namespace
+
+MatchmakingEngine::MatchmakingEngine(QueueConfig config, std::size_t outputCapacity)
+    : config_(std::move(config)), lastCycleAt_(Clock::now()) {
+    shards_.reserve(kShards);
+    for (std::size_t m = 0; m < kModes; ++m) {
+        for (std::size_t r = 0; r < kRegions; ++r) {
+            shards_.push_back(std::make_unique<Shard>(static_cast<GameMode>(m),
+                                                      static_cast<Region>(r + 1),
+                                                      config_,
+                                                      outputCapacity));
+        }
+    }
+}
+
+MatchmakingEngine::~MatchmakingEngine() = default;
+
+void MatchmakingEngine::setParallelExecutor(ParallelExecutor executor) {
+    executor_ = std::move(executor);
+}
+
+cgs::foundation::GameResult<void> MatchmakingEngine::enqueue(MatchmakingTicket ticket) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (queued_.load() >= static_cast<std::size_t>(config_.maxQueueSize)) {
+        return cgs::Result<void, cgs::foundation::GameError>::err(cgs::foundation::GameError(
+            cgs::foundation::ErrorCode::QueueFull, "Matchmaking queue is full"));
+    }
+    for (const auto& shard : shards_) {
+        if (shard->queue.isQueued(ticket.playerId)) {
+            return cgs::Result<void, cgs::foundation::GameError>::err(
+                cgs::foundation::GameError(cgs::foundation::ErrorCode::AlreadyInQueue,
+                                           "Player is already in the matchmaking queue"));
+        }
+    }
+
+    const uint64_t playerId = ticket.playerId;
+    const GameMode mode = ticket.mode;
+    const Region region = ticket.region;
+    auto result = shardForLocked(mode, region).queue.enqueue(std::move(ticket));
+    if (result.hasValue()) {
+        queued_.fetch_add(1);
+        if (region == Region::Any) {
+            anyPlayers_[modeIndex(mode)].insert(playerId);
+        }
+    }
+    return result;
+}
+
+bool MatchmakingEngine::dequeue(uint64_t playerId) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& shard : shards_) {
+        if (shard->queue.dequeue(playerId)) {
+            queued_.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool MatchmakingEngine::isQueued(uint64_t playerId) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& shard : shards_) {
+        if (shard->queue.isQueued(playerId)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::size_t MatchmakingEngine::queueSize() const {
+    return queued_.load();
+}
+
+std::size_t MatchmakingEngine::runCycle() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        rotateAnyOwnersLocked();
+    }
+
+    const auto now = Clock::now();
+    cycleIntervalMicros_.store(
+        std::chrono::duration_cast<std::chrono::microseconds>(now - lastCycleAt_).count());
+    lastCycleAt_ = now;
+
+    if (executor_) {
+        std::vector<std::function<void()>> jobs;
+        jobs.reserve(shards_.size());
+        for (const auto& shard : shards_) {
+            jobs.emplace_back([this, s = shard.get()] { runShard(*s); });
+        }
+        executor_(jobs);
+    } else {
+        for (const auto& shard : shards_) {
+            runShard(*shard);
+        }
+    }
+
+    std::size_t formed = 0;
+    for (const auto& shard : shards_) {
+        formed += static_cast<std::size_t>(shard->lastCycleMatches.load());
+    }
+    return formed;
+}
+
+std::size_t MatchmakingEngine::drainMatches(std::vector<MatchResult>& out) {
+    std::size_t drained = 0;
+    MatchResult match;
+    for (const auto& shard : shards_) {
+        while (shard->output.tryPop(match)) {
+            out.push_back(std::move(match));
+            ++drained;
+        }
+    }
+    return drained;
+}
+
+std::vector<MatchmakingShardStats> MatchmakingEngine::shardStats() const {
+    const auto interval = cycleIntervalMicros_.load();
+    std::vector<MatchmakingShardStats> stats;
+    stats.reserve(shards_.size());
+    for (const auto& shard : shards_) {
+        MatchmakingShardStats s;
+        s.mode = shard->mode;
+        s.region = shard->region;
+        s.queuedPlayers = shard->queue.queueSize();
+        s.matchesFormed = shard->matchesFormed.load();
+        if (interval > 0) {
+            s.matchesPerSecond = static_cast<double>(shard->lastCycleMatches.load()) * 1e6 /
+                                 static_cast<double>(interval);
+        }
+        s.lastCycleTime = std::chrono::microseconds{shard->lastCycleMicros.load()};
+        stats.push_back(s);
+    }
+    return stats;
+}
+
+const QueueConfig& MatchmakingEngine::config() const noexcept {
+    return config_;
+}
+
+MatchmakingEngine::Shard& MatchmakingEngine::shardForLocked(GameMode mode, Region region) {
+    const std::size_t m = modeIndex(mode);
+    const std::size_t r = region == Region::Any ? anyOwner_[m] : regionIndex(region);
+    return *shards_[m * kRegions + r];
+}
+
+void MatchmakingEngine::rotateAnyOwnersLocked() {
+    for (std::size_t m = 0; m < kModes; ++m) {
+        auto& players = anyPlayers_[m];
+        Shard& from = *shards_[m * kRegions + anyOwner_[m]];
+        anyOwner_[m] = (anyOwner_[m] + 1) % kRegions;
+        Shard& to = *shards_[m * kRegions + anyOwner_[m]];
+
+        for (auto it = players.begin(); it != players.end();) {
+            // Matched (or dequeued, or re-queued for a region) since the
+            // last rotation: no longer an Any ticket of this shard.
+            auto ticket = from.queue.getTicket(*it);
+            if (!ticket || ticket->region != Region::Any || !from.queue.dequeue(*it)) {
+                it = players.erase(it);
+                continue;
+            }
+            if (to.queue.enqueue(std::move(*ticket)).hasError()) {
+                queued_.fetch_sub(1);
+                it = players.erase(it);
+                continue;
+            }
+            ++it;
+        }
+    }
+}
+
+void MatchmakingEngine::runShard(Shard& shard) {
+    const auto start = Clock::now();
+
+    // Form no more matches than the output can take: the consumer only
+    // frees space, so this never overflows.
+    const std::size_t room = shard.output.capacity() - shard.output.size();
+    auto matches = shard.queue.matchAll(room);
+
+    std::size_t players = 0;
+    for (auto& match : matches) {
+        // Shard queues number matches independently; renumber engine-wide.
+        match.matchId = nextMatchId_.fetch_add(1);
+        players += match.players.size();
+        (void)shard.output.tryPush(std::move(match));
+    }
+    queued_.fetch_sub(players);
+
+    shard.matchesFormed.fetch_add(matches.size());
+    shard.lastCycleMatches.store(matches.size());
+    shard.lastCycleMicros.store(
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count());
+}
+
+}  // namespace cgs::service
@@ -8,12 +8,29 @@
 #include "cgs/service/elo_calculator.hpp"
 
 #include <algorithm>
-#include <numeric>
+#include <cstddef>
+#include <limits>
 
 namespace cgs::service {
 
 MatchmakingQueue::MatchmakingQueue(QueueConfig config) : config_(std::move(config)) {}
 
+namespace {
+
+/// Whether tickets in regions @p a and @p b may play together.
+bool regionsCompatible(Region a, Region b) noexcept {
+    return a == Region::Any || b == Region::Any || a == b;
+}
+
+/// @p mmr shifted by @p delta, saturated to the int32_t range.
+int32_t offsetRating(int32_t mmr, int64_t delta) noexcept {
+    const int64_t shifted = static_cast<int64_t>(mmr) + delta;
+    return static_cast<int32_t>(std::clamp<int64_t>(
+        shifted, std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max()));
+}
+
+}  // anonymous namespace
+
 cgs::foundation::GameResult<void> MatchmakingQueue::enqueue(MatchmakingTicket ticket) {
     std::lock_guard<std::mutex> lock(mutex_);
 
@@ -22,14 +39,17 @@ cgs::foundation::GameResult<void> MatchmakingQueue::enqueue(MatchmakingTicket ti
             cgs::foundation::ErrorCode::QueueFull, "Matchmaking queue is full"));
     }
 
-    if (playerIndex_.count(ticket.playerId) > 0) {
+    if (tickets_.count(ticket.playerId) > 0) {
         return cgs::Result<void, cgs::foundation::GameError>::err(
             cgs::foundation::GameError(cgs::foundation::ErrorCode::AlreadyInQueue,
                                        "Player is already in the matchmaking queue"));
     }
 
-    playerIndex_[ticket.playerId] = tickets_.size();
-    tickets_.push_back(std::move(ticket));
+    const uint64_t playerId = ticket.playerId;
+    const uint64_t seq = nextSeq_++;
+    partitions_[{ticket.mode, ticket.region}].emplace(ticket.rating.mmr, playerId);
+    byWait_.emplace(ticket.enqueuedAt, seq, playerId);
+    tickets_.emplace(playerId, Entry{std::move(ticket), seq});
 
     return cgs::Result<void, cgs::foundation::GameError>::ok();
 }
@@ -37,133 +57,166 @@ cgs::foundation::GameResult<void> MatchmakingQueue::enqueue(MatchmakingTicket ti
 bool MatchmakingQueue::dequeue(uint64_t playerId) {
     std::lock_guard<std::mutex> lock(mutex_);
 
-    auto it = playerIndex_.find(playerId);
-    if (it == playerIndex_.end()) {
+    auto it = tickets_.find(playerId);
+    if (it == tickets_.end()) {
         return false;
     }
-
-    auto idx = it->second;
-    auto lastIdx = tickets_.size() - 1;
-
-    // Swap with last element for O(1) removal.
-    if (idx != lastIdx) {
-        std::swap(tickets_[idx], tickets_[lastIdx]);
-        playerIndex_[tickets_[idx].playerId] = idx;
-    }
-
-    tickets_.pop_back();
-    playerIndex_.erase(it);
+    eraseLocked(it);
     return true;
 }
 
 std::optional<MatchResult> MatchmakingQueue::tryMatch() {
     std::lock_guard<std::mutex> lock(mutex_);
 
-    if (tickets_.size() < static_cast<std::size_t>(config_.minPlayersPerMatch)) {
+    auto matches = matchLocked(1);
+    if (matches.empty()) {
         return std::nullopt;
     }
+    return std::move(matches.front());
+}
 
-    // Try to build a match starting from each ticket as the anchor.
-    // Prioritize tickets that have waited longest (front of the vector).
-    for (std::size_t anchorIdx = 0; anchorIdx < tickets_.size(); ++anchorIdx) {
-        const auto& anchor = tickets_[anchorIdx];
-        int32_t anchorTolerance = effectiveTolerance(anchor);
-
-        // Collect compatible tickets.
-        std::vector<std::size_t> candidates;
-        candidates.push_back(anchorIdx);
-
-        for (std::size_t i = 0; i < tickets_.size(); ++i) {
-            if (i == anchorIdx) {
-                continue;
-            }
+std::vector<MatchResult> MatchmakingQueue::matchAll(std::size_t maxMatches) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return matchLocked(maxMatches);
+}
 
-            const auto& candidate = tickets_[i];
+std::vector<MatchResult> MatchmakingQueue::matchLocked(std::size_t limit) {
+    std::vector<MatchResult> matches;
+    const auto minPlayers = static_cast<std::size_t>(config_.minPlayersPerMatch);
+    const auto maxPlayers = static_cast<std::size_t>(config_.maxPlayersPerMatch);
+    if (limit == 0 || tickets_.size() < minPlayers || maxPlayers == 0) {
+        return matches;
+    }
 
-            // Must share the same game mode.
-            if (candidate.mode != anchor.mode) {
-                continue;
-            }
+    const auto now = Clock::now();
 
-            // Region must be compatible (Any matches everything).
-            if (anchor.region != Region::Any && candidate.region != Region::Any &&
-                anchor.region != candidate.region) {
-                continue;
-            }
+    // Tolerance only grows with waiting, so the longest-waiting ticket
+    // bounds every candidate's tolerance in this pass.
+    const auto& oldest = tickets_.at(std::get<2>(*byWait_.begin())).ticket;
+    const int32_t queueTolerance = effectiveTolerance(oldest, now);
 
-            // Check rating tolerance from both perspectives.
-            int32_t candidateTolerance = effectiveTolerance(candidate);
-            int32_t tolerance = std::max(anchorTolerance, candidateTolerance);
+    // Anchors in wait order; ones matched earlier in the pass are skipped.
+    std::vector<uint64_t> anchors;
+    anchors.reserve(byWait_.size());
+    for (const auto& key : byWait_) {
+        anchors.push_back(std::get<2>(key));
+    }
 
-            if (!EloCalculator::isWithinTolerance(
-                    anchor.rating.mmr, candidate.rating.mmr, tolerance)) {
+    for (uint64_t anchorId : anchors) {
+        if (matches.size() >= limit || tickets_.size() < minPlayers) {
+            break;
+        }
+        auto anchorIt = tickets_.find(anchorId);
+        if (anchorIt == tickets_.end()) {
+            continue;
+        }
+        const auto& anchor = anchorIt->second.ticket;
+        const int32_t anchorTolerance = effectiveTolerance(anchor, now);
+        const int32_t window = std::max(anchorTolerance, queueTolerance);
+        const int32_t low = offsetRating(anchor.rating.mmr, -static_cast<int64_t>(window));
+        const int32_t high = offsetRating(anchor.rating.mmr, window);
+
+        // Collect compatible tickets inside the anchor's rating window.
+        scratch_.clear();
+        auto first = partitions_.lower_bound({anchor.mode, Region::Any});
+        for (auto part = first; part != partitions_.end() && part->first.first == anchor.mode;
+             ++part) {
+            if (!regionsCompatible(anchor.region, part->first.second)) {
                 continue;
             }
-
-            candidates.push_back(i);
-
-            if (candidates.size() >= static_cast<std::size_t>(config_.maxPlayersPerMatch)) {
-                break;
+            const auto& index = part->second;
+            for (auto it = index.lower_bound({low, 0}); it != index.end() && it->first <= high;
+                 ++it) {
+                if (it->second == anchorId) {
+                    continue;
+                }
+                // Check rating tolerance from both perspectives.
+                const auto& candidate = tickets_.at(it->second).ticket;
+                const int32_t tolerance =
+                    std::max(anchorTolerance, effectiveTolerance(candidate, now));
+                if (!EloCalculator::isWithinTolerance(
+                        anchor.rating.mmr, candidate.rating.mmr, tolerance)) {
+                    continue;
+                }
+                const int64_t distance = static_cast<int64_t>(candidate.rating.mmr) -
+                                         static_cast<int64_t>(anchor.rating.mmr);
+                scratch_.emplace_back(static_cast<int32_t>(std::min<int64_t>(
+                                          distance < 0 ? -distance : distance,
+                                          std::numeric_limits<int32_t>::max())),
+                                      it->second);
             }
         }
 
         // Check if we have enough players.
-        if (candidates.size() < static_cast<std::size_t>(config_.minPlayersPerMatch)) {
+        if (scratch_.size() + 1 < minPlayers) {
             continue;
         }
 
+        // Take the closest-rated candidates.
+        const std::size_t take = std::min(scratch_.size(), maxPlayers - 1);
+        std::partial_sort(scratch_.begin(),
+                          scratch_.begin() + static_cast<std::ptrdiff_t>(take),
+                          scratch_.end());
+
         // Build the match result.
         MatchResult result;
         result.matchId = nextMatchId();
-
-        std::vector<int32_t> ratings;
-        for (auto idx : candidates) {
-            result.players.push_back(tickets_[idx]);
-            ratings.push_back(tickets_[idx].rating.mmr);
+        result.players.reserve(take + 1);
+        result.players.push_back(anchor);
+        for (std::size_t i = 0; i < take; ++i) {
+            result.players.push_back(tickets_.at(scratch_[i].second).ticket);
         }
 
+        std::vector<int32_t> ratings;
+        ratings.reserve(result.players.size());
         float sum = 0.0f;
-        for (auto r : ratings) {
-            sum += static_cast<float>(r);
+        for (const auto& player : result.players) {
+            ratings.push_back(player.rating.mmr);
+            sum += static_cast<float>(player.rating.mmr);
         }
         result.averageRating = sum / static_cast<float>(ratings.size());
         result.matchQuality = EloCalculator::matchQuality(ratings);
-
-        // Remove matched players from the queue (reverse order to
-        // preserve indices during removal).
-        std::sort(candidates.begin(), candidates.end(), std::greater<>());
-        for (auto idx : candidates) {
-            auto lastIdx = tickets_.size() - 1;
-            auto pid = tickets_[idx].playerId;
-
-            if (idx != lastIdx) {
-                std::swap(tickets_[idx], tickets_[lastIdx]);
-                playerIndex_[tickets_[idx].playerId] = idx;
-            }
-
-            tickets_.pop_back();
-            playerIndex_.erase(pid);
+        result.teams =
+            EloCalculator::balanceTeams(ratings, config_.teamCount, config_.teamBalanceBudget);
+        if (!result.teams.empty()) {
+            result.teamBalance =
+                EloCalculator::teamBalance(ratings, result.teams, config_.teamCount);
         }
 
-        return result;
+        // Remove matched players from the queue.
+        for (const auto& player : result.players) {
+            eraseLocked(tickets_.find(player.playerId));
+        }
+        matches.push_back(std::move(result));
     }
 
-    return std::nullopt;
+    return matches;
+}
+
+void MatchmakingQueue::eraseLocked(std::unordered_map<uint64_t, Entry>::iterator it) {
+    const auto& ticket = it->second.ticket;
+    auto part = partitions_.find({ticket.mode, ticket.region});
+    part->second.erase({ticket.rating.mmr, ticket.playerId});
+    if (part->second.empty()) {
+        partitions_.erase(part);
+    }
+    byWait_.erase({ticket.enqueuedAt, it->second.seq, ticket.playerId});
+    tickets_.erase(it);
 }
 
 bool MatchmakingQueue::isQueued(uint64_t playerId) const {
     std::lock_guard<std::mutex> lock(mutex_);
-    return playerIndex_.count(playerId) > 0;
+    return tickets_.count(playerId) > 0;
 }
 
 std::optional<MatchmakingTicket> MatchmakingQueue::getTicket(uint64_t playerId) const {
     std::lock_guard<std::mutex> lock(mutex_);
 
-    auto it = playerIndex_.find(playerId);
-    if (it == playerIndex_.end()) {
+    auto it = tickets_.find(playerId);
+    if (it == tickets_.end()) {
         return std::nullopt;
     }
-    return tickets_[it->second];
+    return it->second.ticket;
 }
 
 std::size_t MatchmakingQueue::queueSize() const {
@@ -175,8 +228,8 @@ const QueueConfig& MatchmakingQueue::config() const noexcept {
     return config_;
 }
 
-int32_t MatchmakingQueue::effectiveTolerance(const MatchmakingTicket& ticket) const {
-    auto now = std::chrono::steady_clock::now();
+int32_t MatchmakingQueue::effectiveTolerance(const MatchmakingTicket& ticket,
+                                             Clock::time_point now) const {
     auto waited = std::chrono::duration_cast<std::chrono::seconds>(now - ticket.enqueuedAt);
 
     if (config_.expansionInterval.count() <= 0) {
@@ -7,7 +7,6 @@
 #include "cgs/foundation/game_error.hpp"
 
 #include <algorithm>
-#include <numeric>
 
 namespace cgs::service {
 
@@ -42,8 +41,11 @@ GameResult<PartyId> PartyManager::createParty(uint64_t leaderId,
     leader.rating = leaderRating;
     leader.isReady = true;
     party.members.push_back(std::move(leader));
+    party.readyCount = 1;
 
-    parties_.emplace(partyId, std::move(party));
+    Entry entry{std::move(party)};
+    adjustRating(entry, leaderRating.mmr);
+    parties_.emplace(partyId, std::move(entry));
     playerParty_.emplace(leaderId, partyId);
 
     return GameResult<PartyId>::ok(partyId);
@@ -57,7 +59,7 @@ GameResult<void> PartyManager::disbandParty(PartyId partyId, uint64_t requesterI
         return GameResult<void>::err(GameError(ErrorCode::PartyNotFound, "party not found"));
     }
 
-    if (it->second.leaderId != requesterId) {
+    if (it->second.party.leaderId != requesterId) {
         return GameResult<void>::err(
             GameError(ErrorCode::NotPartyLeader, "only the party leader can disband the party"));
     }
@@ -84,7 +86,7 @@ GameResult<void> PartyManager::addMember(PartyId partyId,
         return GameResult<void>::err(GameError(ErrorCode::PartyNotFound, "party not found"));
     }
 
-    auto& party = it->second;
+    auto& party = it->second.party;
 
     if (party.members.size() >= static_cast<std::size_t>(party.maxSize)) {
         return GameResult<void>::err(GameError(ErrorCode::PartyFull, "party is full"));
@@ -95,6 +97,7 @@ GameResult<void> PartyManager::addMember(PartyId partyId,
     member.name = name;
     member.rating = rating;
     party.members.push_back(std::move(member));
+    adjustRating(it->second, rating.mmr);
 
     playerParty_.emplace(playerId, partyId);
 
@@ -109,7 +112,7 @@ GameResult<void> PartyManager::removeMember(PartyId partyId, uint64_t playerId)
         return GameResult<void>::err(GameError(ErrorCode::PartyNotFound, "party not found"));
     }
 
-    auto& party = partyIt->second;
+    auto& party = partyIt->second.party;
 
     // Find the member.
     auto memberIt =
@@ -129,7 +132,12 @@ GameResult<void> PartyManager::removeMember(PartyId partyId, uint64_t playerId)
     }
 
     // Remove non-leader member.
+    if (memberIt->isReady) {
+        --party.readyCount;
+    }
+    const int32_t mmr = memberIt->rating.mmr;
     party.members.erase(memberIt);
+    adjustRating(partyIt->second, -static_cast<int64_t>(mmr));
     playerParty_.erase(playerId);
 
     return GameResult<void>::ok();
@@ -145,7 +153,7 @@ GameResult<void> PartyManager::promoteLeader(PartyId partyId,
         return GameResult<void>::err(GameError(ErrorCode::PartyNotFound, "party not found"));
     }
 
-    auto& party = it->second;
+    auto& party = it->second.party;
 
     if (party.leaderId != requesterId) {
         return GameResult<void>::err(
@@ -168,6 +176,35 @@ GameResult<void> PartyManager::promoteLeader(PartyId partyId,
     return GameResult<void>::ok();
 }
 
+GameResult<void> PartyManager::setReady(PartyId partyId, uint64_t playerId, bool ready) {
+    std::lock_guard lock(mutex_);
+
+    auto it = parties_.find(partyId);
+    if (it == parties_.end()) {
+        return GameResult<void>::err(GameError(ErrorCode::PartyNotFound, "party not found"));
+    }
+
+    auto& party = it->second.party;
+    auto memberIt =
+        std::find_if(party.members.begin(), party.members.end(), [playerId](const PartyMember& m) {
+            return m.playerId == playerId;
+        });
+    if (memberIt == party.members.end()) {
+        return GameResult<void>::err(
+            GameError(ErrorCode::PlayerNotInParty, "player is not in the party"));
+    }
+
+    if (memberIt->isReady != ready) {
+        memberIt->isReady = ready;
+        if (ready) {
+            ++party.readyCount;
+        } else {
+            --party.readyCount;
+        }
+    }
+    return GameResult<void>::ok();
+}
+
 // -- Queue integration --------------------------------------------------------
 
 GameResult<void> PartyManager::setInQueue(PartyId partyId, bool inQueue) {
@@ -178,7 +215,7 @@ GameResult<void> PartyManager::setInQueue(PartyId partyId, bool inQueue) {
         return GameResult<void>::err(GameError(ErrorCode::PartyNotFound, "party not found"));
     }
 
-    it->second.inQueue = inQueue;
+    it->second.party.inQueue = inQueue;
     return GameResult<void>::ok();
 }
 
@@ -191,7 +228,28 @@ std::optional<Party> PartyManager::getParty(PartyId partyId) const {
     if (it == parties_.end()) {
         return std::nullopt;
     }
-    return it->second;
+    return it->second.party;
+}
+
+std::optional<PartySummary> PartyManager::partySummary(PartyId partyId) const {
+    std::lock_guard lock(mutex_);
+
+    auto it = parties_.find(partyId);
+    if (it == parties_.end()) {
+        return std::nullopt;
+    }
+
+    const auto& party = it->second.party;
+    PartySummary summary;
+    summary.id = party.id;
+    summary.leaderId = party.leaderId;
+    summary.memberCount = static_cast<uint32_t>(party.members.size());
+    summary.readyCount = party.readyCount;
+    summary.averageRating = party.averageRating;
+    summary.maxSize = party.maxSize;
+    summary.inQueue = party.inQueue;
+    summary.preferredMode = party.preferredMode;
+    return summary;
 }
 
 std::optional<PartyId> PartyManager::getPlayerParty(uint64_t playerId) const {
@@ -218,21 +276,10 @@ std::optional<int32_t> PartyManager::averagePartyRating(PartyId partyId) const {
     std::lock_guard lock(mutex_);
 
     auto it = parties_.find(partyId);
-    if (it == parties_.end()) {
-        return std::nullopt;
-    }
-
-    const auto& members = it->second.members;
-    if (members.empty()) {
+    if (it == parties_.end() || it->second.party.members.empty()) {
         return std::nullopt;
     }
-
-    int64_t sum = 0;
-    for (const auto& m : members) {
-        sum += static_cast<int64_t>(m.rating.mmr);
-    }
-
-    return static_cast<int32_t>(sum / static_cast<int64_t>(members.size()));
+    return it->second.party.averageRating;
 }
 
 // -- Private helpers ----------------------------------------------------------
@@ -241,6 +288,12 @@ PartyId PartyManager::nextPartyId() {
     return nextPartyId_++;
 }
 
+void PartyManager::adjustRating(Entry& entry, int64_t mmr) {
+    entry.ratingSum += mmr;
+    const auto count = static_cast<int64_t>(entry.party.members.size());
+    entry.party.averageRating = count > 0 ? static_cast<int32_t>(entry.ratingSum / count) : 0;
+}
+
 void PartyManager::removePartyInternal(PartyId partyId) {
     auto it = parties_.find(partyId);
     if (it == parties_.end()) {
@@ -248,7 +301,7 @@ void PartyManager::removePartyInternal(PartyId partyId) {
     }
 
     // Remove all player→party mappings.
-    for (const auto& member : it->second.members) {
+    for (const auto& member : it->second.party.members) {
         playerParty_.erase(member.playerId);
     }
 
@@ -3,127 +3,310 @@
 
 #include "cgs/service/circuit_breaker.hpp"
 
+#include <algorithm>
+
 namespace cgs::service {
 
-ServiceCircuitBreaker::ServiceCircuitBreaker(CircuitBreakerConfig config)
-    : config_(std::move(config)) {}
+namespace {
 
-bool ServiceCircuitBreaker::allowRequest() {
-    std::lock_guard lock(mutex_);
+using State = ServiceCircuitBreaker::State;
+
+// State word: [state:2][consecutive failures:31][half-open successes:31].
+constexpr uint64_t kStateMask = 0x3;
+constexpr uint64_t kCountMax = 0x7FFF'FFFF;
+constexpr int kFailureShift = 2;
+constexpr int kSuccessShift = 33;
+
+State stateOf(uint64_t word) {
+    return static_cast<State>(word & kStateMask);
+}
+
+uint32_t failuresOf(uint64_t word) {
+    return static_cast<uint32_t>((word >> kFailureShift) & kCountMax);
+}
+
+uint32_t successesOf(uint64_t word) {
+    return static_cast<uint32_t>((word >> kSuccessShift) & kCountMax);
+}
+
+uint64_t makeWord(State state, uint64_t failures, uint64_t successes) {
+    return static_cast<uint64_t>(state) | (std::min(failures, kCountMax) << kFailureShift) |
+           (std::min(successes, kCountMax) << kSuccessShift);
+}
+
+// Window slot: [bucket index:24][successes:20][failures:20].  A slot is
+// live while its bucket index is among the last windowBuckets ones; the
+// index wraps after 2^24 buckets.
+constexpr uint64_t kTagMask = 0xFF'FFFF;
+constexpr uint64_t kSlotCountMax = 0xF'FFFF;
+constexpr int kTagShift = 40;
+constexpr int kSlotSuccessShift = 20;
+
+/// Stripes the window is split into; a thread always uses the same one.
+constexpr std::size_t kStripes = 16;
 
-    switch (state_) {
-        case State::Closed:
-            return true;
+std::atomic<std::size_t> nextStripe{0};
 
-        case State::Open: {
-            auto elapsed = std::chrono::steady_clock::now() - lastFailureTime_;
-            if (elapsed >= config_.recoveryTimeout) {
-                transitionTo(State::HalfOpen);
+std::size_t threadStripe() {
+    thread_local const std::size_t stripe =
+        nextStripe.fetch_add(1, std::memory_order_relaxed) % kStripes;
+    return stripe;
+}
+
+}  // namespace
+
+ServiceCircuitBreaker::ServiceCircuitBreaker(CircuitBreakerConfig config)
+    : config_(std::move(config)), origin_(std::chrono::steady_clock::now()) {
+    if (config_.mode == CircuitBreakerMode::FailureRate) {
+        config_.windowBuckets = std::max(config_.windowBuckets, 1u);
+        // Whole cache lines per stripe so threads do not share them.
+        stripeStride_ = (config_.windowBuckets + 7) / 8 * 8;
+        window_ = std::make_unique<std::atomic<uint64_t>[]>(stripeStride_ * kStripes);
+        auto window = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            config_.window);
+        bucketTicks_ = std::max<int64_t>(window.count() / config_.windowBuckets, 1);
+    }
+}
+
+bool ServiceCircuitBreaker::allowRequest() {
+    auto word = word_.load(std::memory_order_acquire);
+    while (true) {
+        switch (stateOf(word)) {
+            case State::Closed:
+            case State::HalfOpen:
                 return true;
+
+            case State::Open: {
+                auto timeout = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    config_.recoveryTimeout);
+                auto elapsed = nowTicks() - lastFailureTicks_.load(std::memory_order_relaxed);
+                if (elapsed < timeout.count()) {
+                    totalRejected_.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                if (transition(word, makeWord(State::HalfOpen, failuresOf(word), 0))) {
+                    return true;
+                }
+                break;  // Another thread moved first; look again.
             }
-            ++totalRejected_;
-            return false;
         }
-
-        case State::HalfOpen:
-            return true;
     }
-    return false;
 }
 
 void ServiceCircuitBreaker::recordSuccess() {
-    std::lock_guard lock(mutex_);
-
-    switch (state_) {
-        case State::Closed:
-            consecutiveFailures_ = 0;
-            break;
+    auto word = word_.load(std::memory_order_acquire);
+    while (true) {
+        switch (stateOf(word)) {
+            case State::Closed:
+                if (window_) {
+                    recordInWindow(false);
+                    return;
+                }
+                if (failuresOf(word) == 0) {
+                    return;  // Nothing to reset; leave the word unwritten.
+                }
+                if (transition(word, makeWord(State::Closed, 0, successesOf(word)))) {
+                    return;
+                }
+                break;
 
-        case State::HalfOpen:
-            ++halfOpenSuccesses_;
-            if (halfOpenSuccesses_ >= config_.successThreshold) {
-                transitionTo(State::Closed);
+            case State::HalfOpen: {
+                auto successes = successesOf(word) + 1u;
+                auto next = successes >= config_.successThreshold
+                                ? makeWord(State::Closed, 0, 0)
+                                : makeWord(State::HalfOpen, failuresOf(word), successes);
+                if (transition(word, next)) {
+                    return;
+                }
+                break;
             }
-            break;
 
-        case State::Open:
-            // Success in Open state should not happen (allowRequest returns false),
-            // but handle gracefully.
-            break;
+            case State::Open:
+                // Success in Open state should not happen (allowRequest returns false),
+                // but handle gracefully.
+                return;
+        }
     }
 }
 
 void ServiceCircuitBreaker::recordFailure() {
-    std::lock_guard lock(mutex_);
-
-    lastFailureTime_ = std::chrono::steady_clock::now();
+    lastFailureTicks_.store(nowTicks(), std::memory_order_relaxed);
 
-    switch (state_) {
-        case State::Closed:
-            ++consecutiveFailures_;
-            if (consecutiveFailures_ >= config_.failureThreshold) {
-                transitionTo(State::Open);
+    auto word = word_.load(std::memory_order_acquire);
+    bool counted = false;
+    while (true) {
+        switch (stateOf(word)) {
+            case State::Closed: {
+                if (window_) {
+                    if (!counted) {
+                        recordInWindow(true);
+                        counted = true;
+                    }
+                    auto totals = windowTotals();
+                    if (totals.calls < config_.minimumRequests ||
+                        static_cast<double>(totals.failures) <
+                            config_.failureRateThreshold * static_cast<double>(totals.calls)) {
+                        return;
+                    }
+                    if (transition(word, makeWord(State::Open, failuresOf(word), 0))) {
+                        return;
+                    }
+                    break;
+                }
+                auto failures = failuresOf(word) + 1ull;
+                auto next = failures >= config_.failureThreshold
+                                ? makeWord(State::Open, failures, successesOf(word))
+                                : makeWord(State::Closed, failures, successesOf(word));
+                if (transition(word, next)) {
+                    return;
+                }
+                break;
             }
-            break;
 
-        case State::HalfOpen:
-            // Any failure in half-open immediately re-opens.
-            transitionTo(State::Open);
-            break;
+            case State::HalfOpen:
+                // Any failure in half-open immediately re-opens.
+                if (transition(word, makeWord(State::Open, failuresOf(word), successesOf(word)))) {
+                    return;
+                }
+                break;
 
-        case State::Open:
-            break;
+            case State::Open:
+                return;
+        }
     }
 }
 
 void ServiceCircuitBreaker::forceState(State newState) {
-    std::lock_guard lock(mutex_);
-    transitionTo(newState);
+    auto word = word_.load(std::memory_order_acquire);
+    while (true) {
+        uint64_t next = 0;
+        switch (newState) {
+            case State::Closed:
+                next = makeWord(State::Closed, 0, 0);
+                break;
+            case State::Open:
+                next = makeWord(State::Open, failuresOf(word), successesOf(word));
+                break;
+            case State::HalfOpen:
+                next = makeWord(State::HalfOpen, failuresOf(word), 0);
+                break;
+        }
+        if (transition(word, next)) {
+            return;
+        }
+    }
 }
 
 void ServiceCircuitBreaker::reset() {
-    std::lock_guard lock(mutex_);
-    state_ = State::Closed;
-    consecutiveFailures_ = 0;
-    halfOpenSuccesses_ = 0;
-    totalRejected_ = 0;
-    lastFailureTime_ = {};
+    word_.store(makeWord(State::Closed, 0, 0), std::memory_order_release);
+    totalRejected_.store(0, std::memory_order_relaxed);
+    lastFailureTicks_.store(0, std::memory_order_relaxed);
+    clearWindow();
 }
 
 ServiceCircuitBreaker::State ServiceCircuitBreaker::state() const {
-    std::lock_guard lock(mutex_);
-    return state_;
+    return stateOf(word_.load(std::memory_order_acquire));
 }
 
 uint32_t ServiceCircuitBreaker::failureCount() const {
-    std::lock_guard lock(mutex_);
-    return consecutiveFailures_;
+    if (window_) {
+        return static_cast<uint32_t>(std::min<uint64_t>(windowTotals().failures, kCountMax));
+    }
+    return failuresOf(word_.load(std::memory_order_acquire));
+}
+
+double ServiceCircuitBreaker::failureRate() const {
+    if (!window_) {
+        return 0.0;
+    }
+    auto totals = windowTotals();
+    return totals.calls == 0
+               ? 0.0
+               : static_cast<double>(totals.failures) / static_cast<double>(totals.calls);
 }
 
 uint32_t ServiceCircuitBreaker::halfOpenSuccessCount() const {
-    std::lock_guard lock(mutex_);
-    return halfOpenSuccesses_;
+    return successesOf(word_.load(std::memory_order_acquire));
 }
 
 uint64_t ServiceCircuitBreaker::rejectedCount() const {
-    std::lock_guard lock(mutex_);
-    return totalRejected_;
+    return totalRejected_.load(std::memory_order_relaxed);
 }
 
 std::string_view ServiceCircuitBreaker::name() const {
     return config_.name;
 }
 
-void ServiceCircuitBreaker::transitionTo(State newState) {
-    state_ = newState;
-    if (newState == State::Closed) {
-        consecutiveFailures_ = 0;
-        halfOpenSuccesses_ = 0;
-    } else if (newState == State::Open) {
+bool ServiceCircuitBreaker::transition(uint64_t& expected, uint64_t desired) {
+    if (stateOf(desired) == State::Open && stateOf(expected) != State::Open) {
         // Ensure recovery timeout starts from now when entering Open state.
-        lastFailureTime_ = std::chrono::steady_clock::now();
-    } else if (newState == State::HalfOpen) {
-        halfOpenSuccesses_ = 0;
+        lastFailureTicks_.store(nowTicks(), std::memory_order_relaxed);
+    }
+    if (!word_.compare_exchange_strong(
+            expected, desired, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        return false;
+    }
+    if (stateOf(desired) == State::Closed && stateOf(expected) != State::Closed) {
+        clearWindow();  // Judge the recovered service on new calls only.
+    }
+    return true;
+}
+
+int64_t ServiceCircuitBreaker::nowTicks() const {
+    return (std::chrono::steady_clock::now() - origin_).count();
+}
+
+uint64_t ServiceCircuitBreaker::bucketIndex(int64_t ticks) const {
+    return static_cast<uint64_t>(ticks / bucketTicks_);
+}
+
+void ServiceCircuitBreaker::recordInWindow(bool failed) {
+    auto index = bucketIndex(nowTicks());
+    auto tag = index & kTagMask;
+    auto& slot = window_[threadStripe() * stripeStride_ + index % config_.windowBuckets];
+
+    auto value = slot.load(std::memory_order_relaxed);
+    uint64_t next = 0;
+    do {
+        uint64_t successes = 0;
+        uint64_t failures = 0;
+        if ((value >> kTagShift) == tag) {
+            successes = (value >> kSlotSuccessShift) & kSlotCountMax;
+            failures = value & kSlotCountMax;
+        }
+        if (successes == kSlotCountMax || failures == kSlotCountMax) {
+            successes /= 2;  // Halve both to keep the rate.
+            failures /= 2;
+        }
+        (failed ? failures : successes) += 1;
+        next = (tag << kTagShift) | (successes << kSlotSuccessShift) | failures;
+    } while (!slot.compare_exchange_weak(value, next, std::memory_order_relaxed));
+}
+
+ServiceCircuitBreaker::WindowTotals ServiceCircuitBreaker::windowTotals() const {
+    auto current = bucketIndex(nowTicks()) & kTagMask;
+    WindowTotals totals;
+    for (std::size_t stripe = 0; stripe < kStripes; ++stripe) {
+        for (std::size_t i = 0; i < config_.windowBuckets; ++i) {
+            auto value = window_[stripe * stripeStride_ + i].load(std::memory_order_relaxed);
+            auto age = (current - (value >> kTagShift)) & kTagMask;
+            if (age >= config_.windowBuckets) {
+                continue;
+            }
+            auto failures = value & kSlotCountMax;
+            totals.failures += failures;
+            totals.calls += failures + ((value >> kSlotSuccessShift) & kSlotCountMax);
+        }
+    }
+    return totals;
+}
+
+void ServiceCircuitBreaker::clearWindow() {
+    if (!window_) {
+        return;
+    }
+    for (std::size_t i = 0; i < stripeStride_ * kStripes; ++i) {
+        window_[i].store(0, std::memory_order_relaxed);
     }
 }
 
@@ -0,0 +1,163 @@
+/// @file crc32c.cpp
+/// @brief CRC-32C with SSE4.2 / ARMv8 CRC instructions and a slice-by-8
+///        fallback.
+
+#include "cgs/service/crc32c.hpp"
+
+#include <array>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <nmmintrin.h>
+#define CGS_CRC32C_SSE42_TARGET
+#elif defined(_M_X64)
+#include <intrin.h>
+#include <nmmintrin.h>
+#define CGS_CRC32C_SSE42_MSVC
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define CGS_CRC32C_ARMV8
+#endif
+
+namespace cgs::service {
+
+namespace {
+
+/// Reflected Castagnoli polynomial.
+constexpr uint32_t kPolynomial = 0x82F63B78;
+
+/// tables[k][b]: CRC of byte b followed by k zero bytes.
+constexpr auto kTables = [] {
+    std::array<std::array<uint32_t, 256>, 8> tables{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t crc = i;
+        for (int j = 0; j < 8; ++j) {
+            crc = (crc >> 1) ^ ((crc & 1) ? kPolynomial : 0);
+        }
+        tables[0][i] = crc;
+    }
+    for (std::size_t k = 1; k < 8; ++k) {
+        for (std::size_t i = 0; i < 256; ++i) {
+            auto prev = tables[k - 1][i];
+            tables[k][i] = (prev >> 8) ^ tables[0][prev & 0xFF];
+        }
+    }
+    return tables;
+}();
+
+uint32_t load32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+/// Slice-by-8 over the inverted CRC state.
+uint32_t updatePortable(uint32_t crc, const uint8_t* p, std::size_t size) {
+    while (size >= 8) {
+        crc ^= load32(p);
+        crc = kTables[7][crc & 0xFF] ^ kTables[6][(crc >> 8) & 0xFF] ^
+              kTables[5][(crc >> 16) & 0xFF] ^ kTables[4][crc >> 24] ^ kTables[3][p[4]] ^
+              kTables[2][p[5]] ^ kTables[1][p[6]] ^ kTables[0][p[7]];
+        p += 8;
+        size -= 8;
+    }
+    while (size-- > 0) {
+        crc = (crc >> 8) ^ kTables[0][(crc ^ *p++) & 0xFF];
+    }
+    return crc;
+}
+
+#if defined(CGS_CRC32C_SSE42_TARGET) || defined(CGS_CRC32C_SSE42_MSVC)
+
+#if defined(CGS_CRC32C_SSE42_TARGET)
+__attribute__((target("sse4.2")))
+#endif
+uint32_t updateHardware(uint32_t crc, const uint8_t* p, std::size_t size) {
+#if defined(__x86_64__) || defined(_M_X64)
+    uint64_t wide = crc;
+    while (size >= 8) {
+        uint64_t word;
+        std::memcpy(&word, p, 8);
+        wide = _mm_crc32_u64(wide, word);
+        p += 8;
+        size -= 8;
+    }
+    crc = static_cast<uint32_t>(wide);
+#endif
+    while (size >= 4) {
+        uint32_t word;
+        std::memcpy(&word, p, 4);
+        crc = _mm_crc32_u32(crc, word);
+        p += 4;
+        size -= 4;
+    }
+    while (size-- > 0) {
+        crc = _mm_crc32_u8(crc, *p++);
+    }
+    return crc;
+}
+
+bool detectHardware() {
+#if defined(CGS_CRC32C_SSE42_TARGET)
+    __builtin_cpu_init();  // May run before the CPU model is initialized.
+    return __builtin_cpu_supports("sse4.2");
+#else
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 20)) != 0;  // ECX bit 20: SSE4.2.
+#endif
+}
+
+#elif defined(CGS_CRC32C_ARMV8)
+
+uint32_t updateHardware(uint32_t crc, const uint8_t* p, std::size_t size) {
+    while (size >= 8) {
+        uint64_t word;
+        std::memcpy(&word, p, 8);
+        crc = __crc32cd(crc, word);
+        p += 8;
+        size -= 8;
+    }
+    while (size-- > 0) {
+        crc = __crc32cb(crc, *p++);
+    }
+    return crc;
+}
+
+bool detectHardware() {
+    return true;  // Compiled for a CPU with the CRC extension.
+}
+
+#else
+
+uint32_t updateHardware(uint32_t crc, const uint8_t* p, std::size_t size) {
+    return updatePortable(crc, p, size);
+}
+
+bool detectHardware() {
+    return false;
+}
+
+#endif
+
+/// Detected once, on first use.
+bool hardware() {
+    static const bool supported = detectHardware();
+    return supported;
+}
+
+}  // namespace
+
+uint32_t crc32c(const void* data, std::size_t size, uint32_t crc) noexcept {
+    const auto* p = static_cast<const uint8_t*>(data);
+    return ~(hardware() ? updateHardware(~crc, p, size) : updatePortable(~crc, p, size));
+}
+
+uint32_t crc32cPortable(const void* data, std::size_t size, uint32_t crc) noexcept {
+    return ~updatePortable(~crc, static_cast<const uint8_t*>(data), size);
+}
+
+bool crc32cHardwareAccelerated() noexcept {
+    return hardware();
+}
+
+}  // namespace cgs::service
@@ -2,7 +2,8 @@
 /// @brief Minimal HTTP health/metrics server implementation.
 ///
 /// Uses POSIX sockets for a single-threaded, poll-based HTTP responder.
-/// Supports GET /healthz, /readyz, and /metrics with graceful shutdown.
+/// Supports GET /healthz, /readyz, /metrics and endpoints added with
+/// addEndpoint(), with graceful shutdown.
 
 #include "cgs/service/health_server.hpp"
 
@@ -17,6 +18,8 @@
 #include <string>
 #include <string_view>
 #include <thread>
+#include <utility>
+#include <vector>
 
 // POSIX socket headers
 #include <cerrno>
@@ -124,8 +127,15 @@ std::string_view extractPath(std::string_view request) {
 // ── Impl ────────────────────────────────────────────────────────────────────
 
 struct HealthServer::Impl {
+    struct Endpoint {
+        std::string path;
+        HealthEndpointHandler handler;
+        std::string contentType;
+    };
+
     HealthServerConfig config;
     cgs::foundation::GameMetrics& metrics;
+    std::vector<Endpoint> endpoints;  // fixed once started
     std::atomic<bool> running{false};
     std::atomic<bool> ready{false};
     std::thread serverThread;
@@ -171,8 +181,15 @@ struct HealthServer::Impl {
 
         std::string_view request(buf.data(), static_cast<std::size_t>(bytesRead));
         auto path = extractPath(request);
+        std::string_view query;
+        if (auto mark = path.find('?'); mark != std::string_view::npos) {
+            query = path.substr(mark + 1);
+            path = path.substr(0, mark);
+        }
 
         std::string response;
+        const auto endpoint = std::find_if(endpoints.begin(), endpoints.end(),
+                                           [&](const Endpoint& e) { return e.path == path; });
 
         if (path == "/healthz") {
             auto health = metrics.healthCheck();
@@ -198,6 +215,8 @@ struct HealthServer::Impl {
         } else if (path == "/metrics") {
             auto body = metrics.scrape();
             response = httpResponse(200, "text/plain; version=0.0.4; charset=utf-8", body);
+        } else if (endpoint != endpoints.end()) {
+            response = httpResponse(200, endpoint->contentType, endpoint->handler(query));
         } else {
             response = httpResponse(404, "text/plain", "Not Found");
         }
@@ -283,6 +302,12 @@ void HealthServer::stop() {
     }
 }
 
+void HealthServer::addEndpoint(std::string path,
+                               HealthEndpointHandler handler,
+                               std::string contentType) {
+    impl_->endpoints.push_back({std::move(path), std::move(handler), std::move(contentType)});
+}
+
 void HealthServer::setReady(bool ready) {
     impl_->ready.store(ready, std::memory_order_relaxed);
     impl_->metrics.setGauge("cgs_health_ready", ready ? 1.0 : 0.0);
@@ -0,0 +1,391 @@
+/// @file io_ring.cpp
+/// @brief IoRing implementation over the raw io_uring system calls (Linux),
+///        and an always-inactive ring elsewhere.
+
+#include "io_ring.hpp"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define CGS_HAS_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <vector>
+#endif
+
+namespace cgs::service::detail {
+
+#if defined(CGS_HAS_IO_URING)
+
+namespace {
+
+/// Largest single write request; the kernel caps rw lengths anyway.
+constexpr std::size_t kMaxChunk = std::size_t{1} << 30;
+
+int ringSetup(unsigned entries, io_uring_params& params) {
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+}
+
+int ringEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+    return static_cast<int>(
+        ::syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+/// Ring indices shared with the kernel.
+unsigned loadAcquire(unsigned* index) {
+    return std::atomic_ref<unsigned>(*index).load(std::memory_order_acquire);
+}
+
+void storeRelease(unsigned* index, unsigned value) {
+    std::atomic_ref<unsigned>(*index).store(value, std::memory_order_release);
+}
+
+}  // namespace
+
+struct IoRing::State {
+    int fd = -1;
+    void* ring = MAP_FAILED;
+    std::size_t ringSize = 0;
+    io_uring_sqe* sqes = nullptr;
+    std::size_t sqesSize = 0;
+
+    unsigned* sqHead = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned sqMask = 0;
+    unsigned* sqArray = nullptr;
+    unsigned entries = 0;
+
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    unsigned cqMask = 0;
+    io_uring_cqe* cqes = nullptr;
+
+    /// A request the kernel has not completed, indexed by user_data.
+    struct Op {
+        int fd = -1;
+        const uint8_t* data = nullptr;
+        std::size_t size = 0;
+        uint64_t offset = 0;
+        bool isSync = false;
+    };
+    std::vector<Op> ops;
+    std::vector<uint32_t> freeSlots;
+
+    unsigned queued = 0;    // Prepared, not yet submitted.
+    unsigned inFlight = 0;  // Submitted, not yet reaped.
+    bool failed = false;    // Some request since the last complete() failed.
+
+    ~State() {
+        if (sqes != nullptr) {
+            ::munmap(sqes, sqesSize);
+        }
+        if (ring != MAP_FAILED) {
+            ::munmap(ring, ringSize);
+        }
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+
+    bool setup(unsigned requested) {
+        io_uring_params params{};
+        fd = ringSetup(requested, params);
+        if (fd < 0) {
+            return false;
+        }
+        // One mapping for both rings (5.4), reads and writes at the file
+        // position (5.6): older kernels use the fallback path.
+        constexpr unsigned kNeeded = IORING_FEAT_SINGLE_MMAP | IORING_FEAT_RW_CUR_POS;
+        if ((params.features & kNeeded) != kNeeded) {
+            return false;
+        }
+
+        ringSize = std::max(params.sq_off.array + params.sq_entries * sizeof(unsigned),
+                            params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+        ring = ::mmap(nullptr, ringSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                      static_cast<off_t>(IORING_OFF_SQ_RING));
+        if (ring == MAP_FAILED) {
+            return false;
+        }
+        sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqeMemory = ::mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE,
+                                 MAP_SHARED | MAP_POPULATE, fd,
+                                 static_cast<off_t>(IORING_OFF_SQES));
+        if (sqeMemory == MAP_FAILED) {
+            return false;
+        }
+        sqes = static_cast<io_uring_sqe*>(sqeMemory);
+
+        auto* base = static_cast<uint8_t*>(ring);
+        auto field = [base](uint32_t offset) {
+            return static_cast<unsigned*>(static_cast<void*>(base + offset));
+        };
+        sqHead = field(params.sq_off.head);
+        sqTail = field(params.sq_off.tail);
+        sqMask = *field(params.sq_off.ring_mask);
+        sqArray = field(params.sq_off.array);
+        cqHead = field(params.cq_off.head);
+        cqTail = field(params.cq_off.tail);
+        cqMask = *field(params.cq_off.ring_mask);
+        cqes = static_cast<io_uring_cqe*>(static_cast<void*>(base + params.cq_off.cqes));
+        entries = params.sq_entries;
+
+        // At most `entries` requests are outstanding, and the completion
+        // ring is at least that large, so completions are never dropped.
+        ops.resize(entries);
+        freeSlots.resize(entries);
+        for (uint32_t i = 0; i < entries; ++i) {
+            freeSlots[i] = entries - 1 - i;
+        }
+        return true;
+    }
+
+    /// Hand queued requests to the kernel without waiting.
+    bool submitQueued() {
+        while (queued > 0) {
+            int result = ringEnter(fd, queued, 0, 0);
+            if (result < 0 && errno == EINTR) {
+                continue;
+            }
+            if (result <= 0) {
+                failed = true;
+                return false;
+            }
+            queued -= static_cast<unsigned>(result);
+            inFlight += static_cast<unsigned>(result);
+        }
+        return true;
+    }
+
+    /// Wait for every submitted request and, if @p withQueued, submit
+    /// the queued ones in the same system call and wait for them too.
+    bool wait(bool withQueued) {
+        for (;;) {
+            reap();
+            unsigned toSubmit = withQueued ? queued : 0;
+            if (inFlight + toSubmit == 0) {
+                return true;
+            }
+            int result = ringEnter(fd, toSubmit, inFlight + toSubmit, IORING_ENTER_GETEVENTS);
+            if (result < 0 && errno == EINTR) {
+                continue;
+            }
+            if (result < 0 || (toSubmit > 0 && result == 0 && inFlight == 0)) {
+                failed = true;
+                return false;
+            }
+            if (toSubmit > 0) {
+                queued -= static_cast<unsigned>(result);
+                inFlight += static_cast<unsigned>(result);
+            }
+        }
+    }
+
+    /// Handle every posted completion.
+    void reap() {
+        unsigned head = *cqHead;
+        unsigned tail = loadAcquire(cqTail);
+        for (; head != tail; ++head) {
+            const auto& cqe = cqes[head & cqMask];
+            auto slot = static_cast<uint32_t>(cqe.user_data);
+            finish(ops[slot], cqe.res);
+            freeSlots.push_back(slot);
+            --inFlight;
+        }
+        storeRelease(cqHead, head);
+    }
+
+    void finish(const Op& op, int32_t result) {
+        if (result < 0) {
+            failed = true;  // Includes -ECANCELED for links after a failure.
+            return;
+        }
+        if (op.isSync) {
+            return;
+        }
+        auto written = static_cast<std::size_t>(result);
+        if (written == op.size) {
+            return;
+        }
+        if (op.offset == kAtPosition) {
+            // The kernel cancelled the rest of the chain; the caller
+            // discards the partial append.
+            failed = true;
+            return;
+        }
+        while (written < op.size) {
+            auto more = ::pwrite(op.fd, op.data + written, op.size - written,
+                                 static_cast<off_t>(op.offset + written));
+            if (more < 0 && errno == EINTR) {
+                continue;
+            }
+            if (more <= 0) {
+                failed = true;
+                return;
+            }
+            written += static_cast<std::size_t>(more);
+        }
+    }
+
+    /// A zeroed submission entry for @p op, or nullptr if the ring is
+    /// full and cannot be flushed.  Flushing waits for every request, so
+    /// ordering between separately queued writes is kept.
+    io_uring_sqe* prepare(const Op& op) {
+        if (freeSlots.empty() || queued == entries) {
+            if (!wait(true)) {
+                return nullptr;
+            }
+        }
+        uint32_t slot = freeSlots.back();
+        freeSlots.pop_back();
+        ops[slot] = op;
+
+        unsigned tail = *sqTail;
+        unsigned index = tail & sqMask;
+        auto* sqe = &sqes[index];
+        *sqe = io_uring_sqe{};
+        sqe->fd = op.fd;
+        sqe->user_data = slot;
+        sqArray[index] = index;
+        storeRelease(sqTail, tail + 1);
+        ++queued;
+        return sqe;
+    }
+
+    /// The newest queued entry, to be linked to the next one.
+    io_uring_sqe* lastQueued() {
+        return queued > 0 ? &sqes[(*sqTail - 1) & sqMask] : nullptr;
+    }
+};
+
+IoRing::IoRing() = default;
+
+IoRing::~IoRing() {
+    shutdown();
+}
+
+bool IoRing::init(unsigned entries) {
+    shutdown();
+    auto state = std::make_unique<State>();
+    if (!state->setup(entries)) {
+        return false;
+    }
+    state_ = std::move(state);
+    return true;
+}
+
+void IoRing::shutdown() {
+    if (state_) {
+        (void)state_->wait(true);
+        state_.reset();
+    }
+}
+
+bool IoRing::active() const {
+    return state_ != nullptr;
+}
+
+bool IoRing::write(int fd, const uint8_t* data, std::size_t size, uint64_t offset) {
+    if (!state_) {
+        return false;
+    }
+    while (size > 0) {
+        auto chunk = std::min(size, kMaxChunk);
+        auto* previous = offset == kAtPosition ? state_->lastQueued() : nullptr;
+        auto* sqe = state_->prepare({fd, data, chunk, offset, false});
+        if (sqe == nullptr) {
+            return false;
+        }
+        if (previous != nullptr && state_->queued > 1) {
+            previous->flags |= IOSQE_IO_LINK;
+        }
+        sqe->opcode = IORING_OP_WRITE;
+        sqe->addr = reinterpret_cast<uint64_t>(data);
+        sqe->len = static_cast<uint32_t>(chunk);
+        sqe->off = offset;
+        data += chunk;
+        size -= chunk;
+        if (offset != kAtPosition) {
+            offset += chunk;
+        }
+    }
+    return true;
+}
+
+bool IoRing::submit() {
+    return state_ && state_->submitQueued();
+}
+
+bool IoRing::complete(int fd, Sync sync) {
+    if (!state_) {
+        return false;
+    }
+    auto& state = *state_;
+    if (sync != Sync::None) {
+        // Writes already with the kernel must finish before the sync
+        // starts; queued ones are linked ahead of it instead.
+        (void)state.wait(false);
+        auto* previous = state.lastQueued();
+        auto* sqe = state.prepare({fd, nullptr, 0, 0, true});
+        if (sqe != nullptr) {
+            if (previous != nullptr && state.queued > 1) {
+                previous->flags |= IOSQE_IO_LINK;
+            }
+            sqe->opcode = IORING_OP_FSYNC;
+            sqe->fsync_flags = sync == Sync::Data ? IORING_FSYNC_DATASYNC : 0;
+        } else {
+            state.failed = true;
+        }
+    }
+    bool drained = state.wait(true);
+    bool ok = drained && !state.failed;
+    state.failed = false;
+    if (!drained) {
+        state_.reset();  // The ring is unusable; the owner falls back.
+    }
+    return ok;
+}
+
+#else  // !CGS_HAS_IO_URING
+
+struct IoRing::State {};
+
+IoRing::IoRing() = default;
+IoRing::~IoRing() = default;
+
+bool IoRing::init(unsigned entries) {
+    (void)entries;
+    return false;
+}
+
+void IoRing::shutdown() {}
+
+bool IoRing::active() const {
+    return false;
+}
+
+bool IoRing::write(int fd, const uint8_t* data, std::size_t size, uint64_t offset) {
+    (void)fd;
+    (void)data;
+    (void)size;
+    (void)offset;
+    return false;
+}
+
+bool IoRing::submit() {
+    return false;
+}
+
+bool IoRing::complete(int fd, Sync sync) {
+    (void)fd;
+    (void)sync;
+    return false;
+}
+
+#endif
+
+}  // namespace cgs::service::detail
@@ -0,0 +1,76 @@
+#pragma once
+
+/// @file io_ring.hpp
+/// @brief Minimal io_uring submission ring for file writes and syncs.
+///
+/// Internal header for the service runner.  WriteAheadLog hands each
+/// group commit's write and fdatasync to the kernel as one linked
+/// submission, and SnapshotManager submits blocks as they are encoded so
+/// the disk writes overlap compression of the rest.  Talks to the kernel
+/// through the raw system calls, so there is no liburing dependency; on
+/// other platforms, or kernels without io_uring, init() fails and callers
+/// keep their write()/fdatasync() path.
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace cgs::service::detail {
+
+/// A single-threaded io_uring instance used for ordered file writes.
+///
+/// Writes are queued with write() and go to the kernel on submit() or
+/// complete(); the caller keeps the bytes alive until complete() returns.
+/// Not thread-safe: each owner drives its ring from one thread at a time.
+class IoRing {
+public:
+    /// write() offset meaning "at the file position": with O_APPEND, the
+    /// end of the file.  Such writes are linked so they land in order.
+    static constexpr uint64_t kAtPosition = ~uint64_t{0};
+
+    /// Sync issued by complete() after the writes.
+    enum class Sync : uint8_t {
+        None,  ///< Only wait for the writes.
+        Data,  ///< fdatasync: file data and the metadata to read it back.
+        Full,  ///< fsync.
+    };
+
+    IoRing();
+    ~IoRing();
+
+    IoRing(const IoRing&) = delete;
+    IoRing& operator=(const IoRing&) = delete;
+
+    /// Set up a ring of @p entries submission slots.
+    /// @return false where io_uring is unavailable (not Linux, disabled,
+    ///         or a kernel older than 5.6); the ring stays inactive.
+    bool init(unsigned entries = 32);
+
+    /// Tear the ring down, waiting for writes in flight.
+    void shutdown();
+
+    [[nodiscard]] bool active() const;
+
+    /// Queue a write of @p size bytes at @p offset (or kAtPosition) to
+    /// @p fd.  Large writes are split; a full ring is flushed first.
+    /// @return false if the ring is inactive or could not be flushed.
+    bool write(int fd, const uint8_t* data, std::size_t size, uint64_t offset);
+
+    /// Hand queued writes to the kernel without waiting for them, so they
+    /// proceed while the caller prepares more.
+    bool submit();
+
+    /// Submit what is queued plus, per @p sync, a sync of @p fd linked
+    /// after it, and wait for everything in flight.  Writes submitted
+    /// earlier finish before the sync starts.
+    /// @return false if any write since the last complete() failed or
+    ///         came up short (positioned writes are finished with pwrite),
+    ///         or the sync failed.
+    bool complete(int fd, Sync sync);
+
+private:
+    struct State;
+    std::unique_ptr<State> state_;
+};
+
+}  // namespace cgs::service::detail
@@ -0,0 +1,68 @@
+/// @file mapped_file.cpp
+/// @brief MappedFile implementation (mmap on POSIX, a buffer on Windows).
+
+#include "mapped_file.hpp"
+
+#if defined(_WIN32)
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cgs::service::detail {
+
+bool MappedFile::map(const std::filesystem::path& path, Access access) {
+    unmap();
+#if defined(_WIN32)
+    (void)access;
+    std::ifstream reader(path, std::ios::binary);
+    if (!reader) {
+        return false;
+    }
+    buffer_.assign(std::istreambuf_iterator<char>(reader), std::istreambuf_iterator<char>());
+    data_ = reinterpret_cast<const uint8_t*>(buffer_.data());
+    size_ = buffer_.size();
+    return true;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+    size_ = static_cast<std::size_t>(info.st_size);
+    if (size_ > 0) {
+        void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            ::close(fd);
+            size_ = 0;
+            return false;
+        }
+        ::madvise(mapped, size_, access == Access::Sequential ? MADV_WILLNEED : MADV_RANDOM);
+        data_ = static_cast<const uint8_t*>(mapped);
+    }
+    ::close(fd);  // The mapping stays valid.
+    return true;
+#endif
+}
+
+void MappedFile::unmap() {
+#if defined(_WIN32)
+    buffer_.clear();
+#else
+    if (data_ != nullptr) {
+        ::munmap(const_cast<uint8_t*>(data_), size_);
+    }
+#endif
+    data_ = nullptr;
+    size_ = 0;
+}
+
+}  // namespace cgs::service::detail
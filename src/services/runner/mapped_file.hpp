@@ -0,0 +1,50 @@
+#pragma once
+
+/// @file mapped_file.hpp
+/// @brief Read-only memory mapping of a file.
+///
+/// Internal header for the service runner.  WriteAheadLog maps its
+/// segments to scan them on open(), and SnapshotManager maps snapshot
+/// files so a SnapshotReader decodes only the blocks it is asked for.
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace cgs::service::detail {
+
+/// A file mapped read-only into memory (read into a buffer where mmap
+/// is unavailable).
+class MappedFile {
+public:
+    /// How the mapping will be read, passed to the kernel as a hint.
+    enum class Access : uint8_t {
+        Sequential,  ///< Read front to back soon: prefetch all of it.
+        Random,      ///< Read a few scattered ranges: no read-ahead.
+    };
+
+    MappedFile() = default;
+    ~MappedFile() { unmap(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /// Map @p path, replacing any previous mapping.
+    /// @return false if the file cannot be opened or mapped.
+    bool map(const std::filesystem::path& path, Access access = Access::Sequential);
+
+    void unmap();
+
+    [[nodiscard]] const uint8_t* data() const { return data_; }
+    [[nodiscard]] std::size_t size() const { return size_; }
+
+private:
+    const uint8_t* data_ = nullptr;
+    std::size_t size_ = 0;
+#if defined(_WIN32)
+    std::vector<char> buffer_;
+#endif
+};
+
+}  // namespace cgs::service::detail
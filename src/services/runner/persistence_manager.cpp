@@ -6,17 +6,24 @@
 #include "cgs/foundation/error_code.hpp"
 #include "cgs/foundation/game_error.hpp"
 #include "cgs/foundation/game_metrics.hpp"
+#include "cgs/foundation/mpsc_queue.hpp"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <mutex>
+#include <optional>
 #include <thread>
+#include <unordered_set>
 
 namespace cgs::service {
 
 using cgs::foundation::ErrorCode;
 using cgs::foundation::GameError;
 using cgs::foundation::GameResult;
+using cgs::foundation::PlayerId;
 
 // -- Impl -------------------------------------------------------------------
 
@@ -27,12 +34,64 @@ struct PersistenceManager::Impl {
     SnapshotManager snapshots;
 
     StateCollector collector;
+    DirtyStateCollector dirtyCollector;
     uint64_t lastSnapshotSequence = 0;
 
+    // Incremental snapshot state (guarded by snapshotMutex).
+    bool haveBase = false;           // A full snapshot was taken since start.
+    uint64_t baseSequence = 0;       // walSequence of that full snapshot.
+    uint32_t snapshotsSinceBase = 0;
+
+    std::mutex dirtyMutex;
+    std::unordered_set<PlayerId> dirty;  // Players changed since the base.
+
     // Snapshot timer thread
     std::thread timerThread;
     std::atomic<bool> running{false};
-    std::mutex snapshotMutex;  // Protects snapshot operations.
+    std::mutex snapshotMutex;  // Protects snapshot capture.
+    std::mutex timerMutex;
+    std::condition_variable timerWake;  // Signalled by stop().
+
+    // Submission ring (submitQueueCapacity > 0) and its writer thread.
+    // Ring position p becomes WAL sequence firstTicket + p: only the
+    // writer appends while the ring is in use.
+    std::unique_ptr<cgs::foundation::MpscQueue<WalEntry>> ring;
+    uint64_t firstTicket = 0;
+    std::thread submitThread;
+    std::atomic<bool> submitStop{false};
+    std::atomic<bool> submitStopped{false};
+    std::atomic<uint64_t> pushed{0};          // Bumped per push; the writer waits on it.
+    std::atomic<uint64_t> drained{0};         // Bumped per drain; blocked producers wait on it.
+    std::atomic<uint64_t> appendedThrough{0}; // Highest ticket the writer has handled.
+    cgs::foundation::GaugeHandle queueDepth;
+    cgs::foundation::CounterHandle rejected;
+
+    /// Tickets whose append failed (newest last, bounded).
+    struct FailedRange {
+        uint64_t first = 0;
+        uint64_t last = 0;
+        GameError error;
+    };
+    std::mutex failureMutex;
+    std::deque<FailedRange> failures;
+    static constexpr std::size_t kMaxFailedRanges = 64;
+
+    /// A captured snapshot waiting for the writer thread.
+    struct PendingSnapshot {
+        Snapshot snapshot;
+        std::vector<PlayerId> changed;  // Dirty players taken by the capture.
+    };
+
+    // Snapshot writer thread (queue guarded by writeMutex).
+    std::thread writerThread;
+    std::mutex writeMutex;
+    std::condition_variable writeReady;
+    std::condition_variable writeIdle;
+    std::deque<PendingSnapshot> writeQueue;
+    bool writing = false;
+    bool writerStop = false;
+    std::optional<GameError> writeError;
+    std::optional<uint64_t> failedBase;  // Writer thread only.
 
     explicit Impl(PersistenceConfig cfg)
         : config(std::move(cfg)), wal(config.wal), snapshots(config.snapshot) {}
@@ -49,7 +108,10 @@ struct PersistenceManager::Impl {
         // If no snapshot exists, that's fine — start from scratch.
 
         // Replay WAL entries after the snapshot.
-        auto replayResult = wal.replay(lastSnapshotSequence, applier);
+        auto replayResult =
+            config.compactOnRecovery.empty()
+                ? wal.replay(lastSnapshotSequence, applier)
+                : wal.replayCompacted(lastSnapshotSequence, config.compactOnRecovery, applier);
         if (replayResult.hasError()) {
             return GameResult<void>::err(
                 GameError(ErrorCode::RecoveryFailed,
@@ -59,28 +121,95 @@ struct PersistenceManager::Impl {
         return GameResult<void>::ok();
     }
 
-    /// Take a snapshot using the current state collector.
-    GameResult<void> doSnapshot() {
+    /// Capture the current state (phase 1) and queue it for the writer.
+    GameResult<void> capture() {
         std::lock_guard lock(snapshotMutex);
 
         if (!collector) {
             return GameResult<void>::err(
                 GameError(ErrorCode::PersistenceError, "no state collector registered"));
         }
+        {
+            std::lock_guard writeLock(writeMutex);
+            if (writeQueue.size() >= std::max<std::size_t>(config.maxPendingSnapshotWrites, 1)) {
+                return GameResult<void>::err(GameError(
+                    ErrorCode::PersistenceError, "previous snapshots are still being written"));
+            }
+        }
 
-        auto players = collector();
+        auto captureStart = std::chrono::steady_clock::now();
+
+        // The first snapshot after start is full: recovery does not tell
+        // which base the restored state came from.
+        bool full = !haveBase || config.fullSnapshotEvery <= 1 ||
+                    snapshotsSinceBase + 1 >= config.fullSnapshotEvery;
+
+        // A full snapshot starts a new dirty set before collecting, so
+        // changes racing with the collector land in the next increment.
+        PendingSnapshot pending;
+        {
+            std::lock_guard dirtyLock(dirtyMutex);
+            pending.changed.assign(dirty.begin(), dirty.end());
+            if (full) {
+                dirty.clear();
+            }
+        }
+
+        auto& snap = pending.snapshot;
+        if (full) {
+            snap.players = collector();
+        } else {
+            snap.incremental = true;
+            snap.baseSequence = baseSequence;
+            snap.players = collectChanged(pending.changed);
+            snap.removedPlayers = removedAmong(pending.changed, snap.players);
+        }
 
         auto now = std::chrono::system_clock::now();
-        auto timestampUs = static_cast<uint64_t>(
+        snap.timestampUs = static_cast<uint64_t>(
             std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count());
-
-        Snapshot snap;
         snap.walSequence = wal.currentSequence();
-        snap.timestampUs = timestampUs;
-        snap.players = std::move(players);
+
+        if (full) {
+            haveBase = true;
+            baseSequence = snap.walSequence;
+            snapshotsSinceBase = 0;
+        } else {
+            ++snapshotsSinceBase;
+        }
+
+        std::chrono::duration<double> captureTime = std::chrono::steady_clock::now() - captureStart;
+        cgs::foundation::GameMetrics::instance().setGauge("cgs_snapshot_capture_seconds",
+                                                          captureTime.count());
+
+        {
+            std::lock_guard writeLock(writeMutex);
+            writeQueue.push_back(std::move(pending));
+        }
+        writeReady.notify_one();
+        return GameResult<void>::ok();
+    }
+
+    /// Serialize and store a captured snapshot (phase 2, writer thread).
+    GameResult<void> write(const PendingSnapshot& pending) {
+        const auto& snap = pending.snapshot;
+
+        // Without its base on disk, an increment would be ignored on
+        // recovery, so the WAL it covers must stay.
+        if (snap.incremental && failedBase == snap.baseSequence) {
+            return GameResult<void>::err(
+                GameError(ErrorCode::SnapshotWriteFailed, "base snapshot was not written"));
+        }
 
         auto saveResult = snapshots.save(snap);
         if (saveResult.hasError()) {
+            if (!snap.incremental) {
+                failedBase = snap.walSequence;
+                std::lock_guard lock(snapshotMutex);
+                haveBase = false;
+                std::lock_guard dirtyLock(dirtyMutex);
+                dirty.insert(pending.changed.begin(), pending.changed.end());
+            }
             return saveResult;
         }
 
@@ -91,8 +220,6 @@ struct PersistenceManager::Impl {
             // They will be truncated on the next snapshot.
         }
 
-        lastSnapshotSequence = snap.walSequence;
-
         // Update Prometheus gauges.
         auto& m = cgs::foundation::GameMetrics::instance();
         m.setGauge("cgs_last_snapshot_timestamp", static_cast<double>(snap.timestampUs) / 1e6);
@@ -101,22 +228,152 @@ struct PersistenceManager::Impl {
         return GameResult<void>::ok();
     }
 
+    /// Writer thread: store captured snapshots in capture order.
+    void writerLoop() {
+        std::unique_lock lock(writeMutex);
+        while (true) {
+            writeReady.wait(lock, [&] { return !writeQueue.empty() || writerStop; });
+            if (writeQueue.empty()) {
+                return;
+            }
+
+            writing = true;
+            auto pending = std::move(writeQueue.front());
+            writeQueue.pop_front();
+            lock.unlock();
+            auto result = write(pending);
+            lock.lock();
+            writing = false;
+
+            if (result.hasError() && !writeError) {
+                writeError = result.error();
+            }
+            writeIdle.notify_all();
+        }
+    }
+
+    /// Block until queued snapshots are written; report the first failure
+    /// since the last wait.
+    GameResult<void> waitForWrites() {
+        std::unique_lock lock(writeMutex);
+        writeIdle.wait(lock, [&] { return writeQueue.empty() && !writing; });
+        if (writeError) {
+            auto error = std::move(*writeError);
+            writeError.reset();
+            return GameResult<void>::err(std::move(error));
+        }
+        return GameResult<void>::ok();
+    }
+
+    /// Capture a snapshot and wait until it is written.
+    GameResult<void> doSnapshot() {
+        auto captureResult = capture();
+        auto writeResult = waitForWrites();
+        return captureResult.hasError() ? captureResult : writeResult;
+    }
+
+    /// States of the @p changed players that still exist.
+    std::vector<PlayerSnapshot> collectChanged(const std::vector<PlayerId>& changed) {
+        if (dirtyCollector) {
+            return dirtyCollector(changed);
+        }
+        std::unordered_set<PlayerId> wanted(changed.begin(), changed.end());
+        auto players = collector();
+        std::erase_if(players,
+                      [&](const PlayerSnapshot& p) { return !wanted.contains(p.playerId); });
+        return players;
+    }
+
+    /// The @p changed players missing from @p players.
+    static std::vector<PlayerId> removedAmong(const std::vector<PlayerId>& changed,
+                                              const std::vector<PlayerSnapshot>& players) {
+        std::unordered_set<PlayerId> present;
+        for (const auto& p : players) {
+            present.insert(p.playerId);
+        }
+        std::vector<PlayerId> removed;
+        for (const auto& id : changed) {
+            if (!present.contains(id)) {
+                removed.push_back(id);
+            }
+        }
+        return removed;
+    }
+
     /// Background timer loop for periodic snapshots.
     void timerLoop() {
         using Clock = std::chrono::steady_clock;
-        auto nextSnapshot = Clock::now() + config.snapshotInterval;
-
+        std::unique_lock lock(timerMutex);
         while (running.load(std::memory_order_relaxed)) {
-            auto now = Clock::now();
-            if (now >= nextSnapshot) {
-                (void)doSnapshot();
-                nextSnapshot = Clock::now() + config.snapshotInterval;
+            auto nextSnapshot = Clock::now() + config.snapshotInterval;
+            if (timerWake.wait_until(lock, nextSnapshot, [&] {
+                    return !running.load(std::memory_order_relaxed);
+                })) {
+                return;
+            }
+            lock.unlock();
+            (void)capture();
+            lock.lock();
+        }
+    }
+
+    /// Submission writer: drain the ring into WAL group commits.
+    void submitLoop() {
+        std::vector<WalEntry> batch;
+        batch.reserve(ring->capacity());
+        uint64_t nextTicket = firstTicket;
+
+        while (true) {
+            auto seen = pushed.load(std::memory_order_acquire);
+            WalEntry entry;
+            while (batch.size() < ring->capacity() && ring->tryPop(entry)) {
+                batch.push_back(std::move(entry));
+            }
+            if (batch.empty()) {
+                if (submitStop.load(std::memory_order_acquire) && ring->empty()) {
+                    return;
+                }
+                pushed.wait(seen, std::memory_order_acquire);
+                continue;
+            }
+
+            drained.fetch_add(1, std::memory_order_release);
+            drained.notify_all();
+            queueDepth.set(static_cast<double>(ring->size()));
+
+            auto first = nextTicket;
+            nextTicket += batch.size();
+            auto result = wal.appendBatch(batch);
+            if (result.hasError()) {
+                std::lock_guard lock(failureMutex);
+                failures.push_back({first, nextTicket - 1, result.error()});
+                if (failures.size() > kMaxFailedRanges) {
+                    failures.pop_front();
+                }
             }
+            batch.clear();
 
-            // Sleep in small increments to allow prompt shutdown.
-            std::this_thread::sleep_for(std::chrono::milliseconds(500));
+            appendedThrough.store(nextTicket - 1, std::memory_order_release);
+            appendedThrough.notify_all();
+            cgs::foundation::GameMetrics::instance().setGauge(
+                "cgs_wal_pending_entries", static_cast<double>(wal.entryCount()));
         }
     }
+
+    /// Stop the submission writer once the ring is empty.
+    void stopSubmitWriter() {
+        if (!submitThread.joinable()) {
+            return;
+        }
+        submitStop.store(true, std::memory_order_release);
+        pushed.fetch_add(1, std::memory_order_release);
+        pushed.notify_one();
+        submitThread.join();
+        submitStopped.store(true, std::memory_order_release);
+        appendedThrough.notify_all();
+        drained.fetch_add(1, std::memory_order_release);
+        drained.notify_all();
+    }
 };
 
 // -- Construction / destruction ----------------------------------------------
@@ -135,6 +392,13 @@ PersistenceManager::~PersistenceManager() {
 GameResult<void> PersistenceManager::start(StateCollector collector,
                                            StateRestorer restorer,
                                            WalApplier applier) {
+    return start(std::move(collector), nullptr, std::move(restorer), std::move(applier));
+}
+
+GameResult<void> PersistenceManager::start(StateCollector collector,
+                                           DirtyStateCollector dirtyCollector,
+                                           StateRestorer restorer,
+                                           WalApplier applier) {
     if (impl_->running.load(std::memory_order_relaxed)) {
         return GameResult<void>::err(GameError(ErrorCode::PersistenceAlreadyStarted,
                                                "persistence manager is already running"));
@@ -152,8 +416,10 @@ GameResult<void> PersistenceManager::start(StateCollector collector,
         return snapResult;
     }
 
-    // Register the collector.
+    // Register the collectors.
     impl_->collector = std::move(collector);
+    impl_->dirtyCollector = std::move(dirtyCollector);
+    impl_->haveBase = false;
 
     // Perform recovery.
     auto recoverResult = impl_->recover(restorer, applier);
@@ -163,9 +429,26 @@ GameResult<void> PersistenceManager::start(StateCollector collector,
         return GameResult<void>::err(recoverResult.error());
     }
 
-    // Start the periodic snapshot timer.
+    // Start the submission writer, the snapshot writer and the periodic
+    // snapshot timer.
+    if (impl_->config.submitQueueCapacity > 0) {
+        auto& m = cgs::foundation::GameMetrics::instance();
+        impl_->queueDepth = m.registerGauge("cgs_wal_submit_queue_depth");
+        impl_->rejected = m.registerCounter("cgs_wal_submit_rejected_total");
+        impl_->ring = std::make_unique<cgs::foundation::MpscQueue<WalEntry>>(
+            impl_->config.submitQueueCapacity);
+        impl_->firstTicket = impl_->wal.currentSequence() + 1;
+        impl_->appendedThrough.store(impl_->firstTicket - 1, std::memory_order_relaxed);
+        impl_->submitStop.store(false, std::memory_order_relaxed);
+        impl_->submitStopped.store(false, std::memory_order_relaxed);
+        impl_->submitThread = std::thread([this]() { impl_->submitLoop(); });
+    }
+    impl_->writerStop = false;
+    impl_->writerThread = std::thread([this]() { impl_->writerLoop(); });
     impl_->running.store(true, std::memory_order_relaxed);
-    impl_->timerThread = std::thread([this]() { impl_->timerLoop(); });
+    if (impl_->config.snapshotInterval.count() > 0) {
+        impl_->timerThread = std::thread([this]() { impl_->timerLoop(); });
+    }
 
     return GameResult<void>::ok();
 }
@@ -176,15 +459,29 @@ void PersistenceManager::stop() {
     }
 
     // Signal the timer to stop.
-    impl_->running.store(false, std::memory_order_relaxed);
+    {
+        std::lock_guard lock(impl_->timerMutex);
+        impl_->running.store(false, std::memory_order_relaxed);
+    }
+    impl_->timerWake.notify_all();
 
     if (impl_->timerThread.joinable()) {
         impl_->timerThread.join();
     }
 
+    // Append everything submitted before the final snapshot.
+    impl_->stopSubmitWriter();
+
     // Take a final snapshot before closing.
     (void)impl_->doSnapshot();
 
+    {
+        std::lock_guard lock(impl_->writeMutex);
+        impl_->writerStop = true;
+    }
+    impl_->writeReady.notify_one();
+    impl_->writerThread.join();
+
     // Flush and close.
     (void)impl_->wal.flush();
     impl_->wal.close();
@@ -194,14 +491,92 @@ void PersistenceManager::stop() {
 // -- Operations --------------------------------------------------------------
 
 GameResult<uint64_t> PersistenceManager::recordChange(WalEntry entry) {
+    if (impl_->ring) {
+        // Appending here would take sequences the ring has handed out.
+        auto ticket = submitChange(std::move(entry));
+        if (ticket.hasError()) {
+            return ticket;
+        }
+        auto durable = waitDurable(ticket.value());
+        if (durable.hasError()) {
+            return GameResult<uint64_t>::err(durable.error());
+        }
+        return ticket;
+    }
+
+    auto player = entry.playerId;
     auto result = impl_->wal.append(std::move(entry));
     if (result.hasValue()) {
+        if (impl_->config.fullSnapshotEvery > 1) {
+            std::lock_guard lock(impl_->dirtyMutex);
+            impl_->dirty.insert(player);
+        }
         cgs::foundation::GameMetrics::instance().setGauge(
             "cgs_wal_pending_entries", static_cast<double>(impl_->wal.entryCount()));
     }
     return result;
 }
 
+GameResult<uint64_t> PersistenceManager::submitChange(WalEntry entry) {
+    if (!impl_->ring) {
+        return recordChange(std::move(entry));
+    }
+    if (!impl_->running.load(std::memory_order_relaxed)) {
+        return GameResult<uint64_t>::err(
+            GameError(ErrorCode::PersistenceNotStarted, "persistence manager is not running"));
+    }
+
+    if (impl_->config.fullSnapshotEvery > 1) {
+        std::lock_guard lock(impl_->dirtyMutex);
+        impl_->dirty.insert(entry.playerId);
+    }
+
+    uint64_t position = 0;
+    while (!impl_->ring->tryPush(std::move(entry), position)) {
+        if (impl_->config.submitBackpressure == SubmitBackpressure::Reject) {
+            impl_->rejected.increment();
+            return GameResult<uint64_t>::err(
+                GameError(ErrorCode::WalQueueFull, "WAL submission queue is full"));
+        }
+        auto seen = impl_->drained.load(std::memory_order_acquire);
+        if (impl_->submitStopped.load(std::memory_order_acquire)) {
+            return GameResult<uint64_t>::err(
+                GameError(ErrorCode::PersistenceNotStarted, "persistence manager is not running"));
+        }
+        if (impl_->ring->size() >= impl_->ring->capacity()) {
+            impl_->drained.wait(seen, std::memory_order_acquire);
+        }
+    }
+
+    impl_->pushed.fetch_add(1, std::memory_order_release);
+    impl_->pushed.notify_one();
+    return GameResult<uint64_t>::ok(impl_->firstTicket + position);
+}
+
+GameResult<void> PersistenceManager::waitDurable(uint64_t ticket) {
+    if (!impl_->ring) {
+        return GameResult<void>::ok();  // recordChange() appended it already.
+    }
+
+    auto through = impl_->appendedThrough.load(std::memory_order_acquire);
+    while (through < ticket) {
+        if (impl_->submitStopped.load(std::memory_order_acquire)) {
+            return GameResult<void>::err(GameError(ErrorCode::PersistenceNotStarted,
+                                                   "persistence manager stopped first"));
+        }
+        impl_->appendedThrough.wait(through, std::memory_order_acquire);
+        through = impl_->appendedThrough.load(std::memory_order_acquire);
+    }
+
+    std::lock_guard lock(impl_->failureMutex);
+    for (const auto& failed : impl_->failures) {
+        if (ticket >= failed.first && ticket <= failed.last) {
+            return GameResult<void>::err(failed.error);
+        }
+    }
+    return GameResult<void>::ok();
+}
+
 GameResult<void> PersistenceManager::takeSnapshot() {
     if (!impl_->running.load(std::memory_order_relaxed)) {
         return GameResult<void>::err(
@@ -211,6 +586,19 @@ GameResult<void> PersistenceManager::takeSnapshot() {
     return impl_->doSnapshot();
 }
 
+GameResult<void> PersistenceManager::captureSnapshot() {
+    if (!impl_->running.load(std::memory_order_relaxed)) {
+        return GameResult<void>::err(
+            GameError(ErrorCode::PersistenceNotStarted, "persistence manager is not running"));
+    }
+
+    return impl_->capture();
+}
+
+GameResult<void> PersistenceManager::waitForSnapshots() {
+    return impl_->waitForWrites();
+}
+
 // -- Queries -----------------------------------------------------------------
 
 bool PersistenceManager::isRunning() const {
@@ -225,4 +613,8 @@ uint64_t PersistenceManager::currentWalSequence() const {
     return impl_->wal.currentSequence();
 }
 
+std::size_t PersistenceManager::submitQueueDepth() const {
+    return impl_->ring ? impl_->ring->size() : 0;
+}
+
 }  // namespace cgs::service
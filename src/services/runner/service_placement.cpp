@@ -0,0 +1,159 @@
+/// @file service_placement.cpp
+/// @brief ServicePlacement weighted rendezvous hashing.
+
+#include "cgs/service/service_placement.hpp"
+
+#include <cmath>
+#include <mutex>
+
+namespace cgs::service {
+
+namespace {
+
+// splitmix64 finalizer: a well-mixed 64-bit permutation.
+uint64_t mix(uint64_t x) noexcept {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// weight / -ln(u) for u uniform in (0, 1) drawn from (key, seed).
+double score(uint64_t key, uint64_t seed, double weight) noexcept {
+    const uint64_t h = mix(key ^ mix(seed));
+    const double u = (static_cast<double>(h >> 11) + 0.5) * 0x1.0p-53;
+    return weight / -std::log(u);
+}
+
+}  // anonymous namespace
+
+std::optional<PlacementNodeId> ServicePlacement::addNode(std::string name, double weight) {
+    if (!(weight > 0.0) || !std::isfinite(weight)) {
+        return std::nullopt;
+    }
+    std::unique_lock lock(mutex_);
+    for (const auto& entry : entries_) {
+        if (!entry.removed && entry.node.name == name) {
+            return std::nullopt;
+        }
+    }
+
+    Entry entry;
+    entry.node.id = static_cast<PlacementNodeId>(entries_.size());
+    entry.seed = hashKey(name);
+    entry.node.name = std::move(name);
+    entry.node.weight = weight;
+    entries_.push_back(std::move(entry));
+    ++live_;
+    return entries_.back().node.id;
+}
+
+bool ServicePlacement::removeNode(PlacementNodeId id) {
+    std::unique_lock lock(mutex_);
+    Entry* entry = findLocked(id);
+    if (entry == nullptr) {
+        return false;
+    }
+    entry->removed = true;
+    entry->node.name.clear();
+    --live_;
+    return true;
+}
+
+bool ServicePlacement::setWeight(PlacementNodeId id, double weight) {
+    if (!(weight > 0.0) || !std::isfinite(weight)) {
+        return false;
+    }
+    std::unique_lock lock(mutex_);
+    Entry* entry = findLocked(id);
+    if (entry == nullptr) {
+        return false;
+    }
+    entry->node.weight = weight;
+    return true;
+}
+
+bool ServicePlacement::setState(PlacementNodeId id, PlacementNodeState state) {
+    std::unique_lock lock(mutex_);
+    Entry* entry = findLocked(id);
+    if (entry == nullptr) {
+        return false;
+    }
+    entry->node.state = state;
+    return true;
+}
+
+std::optional<PlacementNodeId> ServicePlacement::place(uint64_t key) const {
+    std::shared_lock lock(mutex_);
+    std::optional<PlacementNodeId> best;
+    double bestScore = 0.0;
+    for (const auto& entry : entries_) {
+        if (entry.removed || entry.node.state != PlacementNodeState::Active) {
+            continue;
+        }
+        const double s = score(key, entry.seed, entry.node.weight);
+        if (!best || s > bestScore) {
+            best = entry.node.id;
+            bestScore = s;
+        }
+    }
+    return best;
+}
+
+std::optional<PlacementNodeId> ServicePlacement::place(std::string_view key) const {
+    return place(hashKey(key));
+}
+
+std::optional<PlacementNodeId> ServicePlacement::find(std::string_view name) const {
+    std::shared_lock lock(mutex_);
+    for (const auto& entry : entries_) {
+        if (!entry.removed && entry.node.name == name) {
+            return entry.node.id;
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<PlacementNode> ServicePlacement::node(PlacementNodeId id) const {
+    std::shared_lock lock(mutex_);
+    if (id >= entries_.size() || entries_[id].removed) {
+        return std::nullopt;
+    }
+    return entries_[id].node;
+}
+
+std::vector<PlacementNode> ServicePlacement::nodes() const {
+    std::shared_lock lock(mutex_);
+    std::vector<PlacementNode> result;
+    result.reserve(live_);
+    for (const auto& entry : entries_) {
+        if (!entry.removed) {
+            result.push_back(entry.node);
+        }
+    }
+    return result;
+}
+
+std::size_t ServicePlacement::size() const {
+    std::shared_lock lock(mutex_);
+    return live_;
+}
+
+uint64_t ServicePlacement::hashKey(std::string_view key) noexcept {
+    // FNV-1a, then mixed: stable across processes, unlike std::hash.
+    uint64_t h = 0xCBF29CE484222325ULL;
+    for (char c : key) {
+        h ^= static_cast<uint8_t>(c);
+        h *= 0x100000001B3ULL;
+    }
+    return mix(h);
+}
+
+ServicePlacement::Entry* ServicePlacement::findLocked(PlacementNodeId id) {
+    if (id >= entries_.size() || entries_[id].removed) {
+        return nullptr;
+    }
+    return &entries_[id];
+}
+
+}  // namespace cgs::service
@@ -3,12 +3,21 @@
 
 #include "cgs/service/service_runner.hpp"
 
+#include "cgs/foundation/error_code.hpp"
+#include "cgs/foundation/game_error.hpp"
+#include "cgs/service/health_server.hpp"
+
 #include <chrono>
+#include <condition_variable>
 #include <csignal>
 #include <cstdlib>
+#include <exception>
 #include <iostream>
+#include <mutex>
+#include <optional>
 #include <string_view>
 #include <thread>
+#include <unordered_map>
 
 namespace cgs::service {
 
@@ -78,28 +87,246 @@ std::filesystem::path parseConfigArg(int argc, char* argv[]) {
     return {};
 }
 
+// -- StartupGraph ------------------------------------------------------------
+
+using cgs::foundation::ErrorCode;
+using cgs::foundation::GameError;
+using cgs::foundation::GameResult;
+
+void StartupGraph::addStage(std::string name,
+                            StartupTask task,
+                            std::vector<std::string> dependsOn) {
+    stages_.push_back(
+        {std::move(name), StartupStageKind::Subsystem, std::move(task), std::move(dependsOn)});
+}
+
+void StartupGraph::addWarmup(std::string name,
+                             StartupTask task,
+                             std::vector<std::string> dependsOn) {
+    stages_.push_back(
+        {std::move(name), StartupStageKind::Warmup, std::move(task), std::move(dependsOn)});
+}
+
+GameResult<std::vector<std::vector<std::size_t>>> StartupGraph::resolve() const {
+    using Result = GameResult<std::vector<std::vector<std::size_t>>>;
+
+    std::unordered_map<std::string_view, std::size_t> byName;
+    for (std::size_t i = 0; i < stages_.size(); ++i) {
+        if (!byName.emplace(stages_[i].name, i).second) {
+            return Result::err(GameError(ErrorCode::InvalidArgument,
+                                         "duplicate startup stage: " + stages_[i].name));
+        }
+    }
+
+    std::vector<std::vector<std::size_t>> deps(stages_.size());
+    for (std::size_t i = 0; i < stages_.size(); ++i) {
+        for (const auto& dep : stages_[i].dependsOn) {
+            auto it = byName.find(dep);
+            if (it == byName.end()) {
+                return Result::err(GameError(
+                    ErrorCode::InvalidArgument,
+                    "startup stage " + stages_[i].name + " depends on unknown stage " + dep));
+            }
+            deps[i].push_back(it->second);
+        }
+    }
+
+    // Kahn's algorithm: every stage must become runnable.
+    std::vector<std::size_t> missing(stages_.size());
+    std::vector<std::vector<std::size_t>> dependents(stages_.size());
+    std::vector<std::size_t> ready;
+    for (std::size_t i = 0; i < stages_.size(); ++i) {
+        missing[i] = deps[i].size();
+        for (auto dep : deps[i]) {
+            dependents[dep].push_back(i);
+        }
+        if (missing[i] == 0) {
+            ready.push_back(i);
+        }
+    }
+    std::size_t ordered = 0;
+    while (!ready.empty()) {
+        auto stage = ready.back();
+        ready.pop_back();
+        ++ordered;
+        for (auto next : dependents[stage]) {
+            if (--missing[next] == 0) {
+                ready.push_back(next);
+            }
+        }
+    }
+    if (ordered != stages_.size()) {
+        return Result::err(
+            GameError(ErrorCode::InvalidArgument, "startup stages form a dependency cycle"));
+    }
+    return Result::ok(std::move(deps));
+}
+
+GameResult<void> StartupGraph::run(HealthServer* health) {
+    using Status = StartupStageResult::Status;
+
+    results_.clear();
+    for (const auto& stage : stages_) {
+        results_.push_back({stage.name, stage.kind, Status::NotRun, {}});
+    }
+
+    auto resolved = resolve();
+    if (resolved.hasError()) {
+        return GameResult<void>::err(resolved.error());
+    }
+    const auto& deps = resolved.value();
+
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::size_t running = 0;
+    std::optional<GameError> firstError;
+    std::vector<bool> started(stages_.size(), false);
+    std::vector<std::thread> threads;
+    threads.reserve(stages_.size());
+
+    std::unique_lock lock(mutex);
+    while (true) {
+        // Start every stage whose dependencies are done; skip those behind
+        // a failed subsystem.
+        bool progressed = true;
+        while (progressed) {
+            progressed = false;
+            for (std::size_t i = 0; i < stages_.size(); ++i) {
+                if (started[i] || results_[i].status != Status::NotRun) {
+                    continue;
+                }
+                bool blocked = false;
+                bool waiting = false;
+                for (auto dep : deps[i]) {
+                    auto status = results_[dep].status;
+                    if (status == Status::Skipped ||
+                        (status == Status::Failed &&
+                         results_[dep].kind == StartupStageKind::Subsystem)) {
+                        blocked = true;
+                    } else if (status == Status::NotRun) {
+                        waiting = true;  // Not started or still running.
+                    }
+                }
+                if (blocked) {
+                    results_[i].status = Status::Skipped;
+                    progressed = true;
+                } else if (!waiting) {
+                    started[i] = true;
+                    ++running;
+                    threads.emplace_back([&, i] {
+                        auto started = std::chrono::steady_clock::now();
+                        GameResult<void> result = GameResult<void>::ok();
+                        try {
+                            result = stages_[i].task();
+                        } catch (const std::exception& e) {
+                            result = GameResult<void>::err(
+                                GameError(ErrorCode::Unknown, e.what()));
+                        } catch (...) {
+                            result = GameResult<void>::err(
+                                GameError(ErrorCode::Unknown, "unknown exception"));
+                        }
+                        auto elapsed = std::chrono::steady_clock::now() - started;
+
+                        std::lock_guard guard(mutex);
+                        results_[i].duration = elapsed;
+                        results_[i].status =
+                            result.hasError() ? Status::Failed : Status::Succeeded;
+                        if (result.hasError()) {
+                            std::cerr << "Startup stage '" << stages_[i].name
+                                      << "' failed: " << result.error().message() << "\n";
+                            if (stages_[i].kind == StartupStageKind::Subsystem && !firstError) {
+                                firstError = result.error();
+                            }
+                        }
+                        --running;
+                        finished.notify_one();
+                    });
+                }
+            }
+        }
+        if (running == 0) {
+            break;
+        }
+        finished.wait(lock);
+    }
+    lock.unlock();
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    if (firstError) {
+        return GameResult<void>::err(*firstError);
+    }
+    if (health != nullptr) {
+        health->setReady(true);
+    }
+    return GameResult<void>::ok();
+}
+
+const std::vector<StartupStageResult>& StartupGraph::results() const {
+    return results_;
+}
+
+std::size_t StartupGraph::stageCount() const {
+    return stages_.size();
+}
+
 // -- GracefulShutdown --------------------------------------------------------
 
+namespace {
+
+void runHook(const std::string& name, const ShutdownHook& callback) {
+    try {
+        callback();
+    } catch (const std::exception& e) {
+        std::cerr << "Shutdown hook '" << name << "' failed: " << e.what() << "\n";
+    } catch (...) {
+        std::cerr << "Shutdown hook '" << name << "' failed with unknown error\n";
+    }
+}
+
+}  // namespace
+
 void GracefulShutdown::addHook(std::string name, ShutdownHook hook) {
-    hooks_.push_back({std::move(name), std::move(hook)});
+    hooks_.push_back({std::move(name), std::move(hook), false});
+}
+
+void GracefulShutdown::addConcurrentHook(std::string name, ShutdownHook hook) {
+    hooks_.push_back({std::move(name), std::move(hook), true});
 }
 
 void GracefulShutdown::execute() {
     auto deadline = std::chrono::steady_clock::now() + drainTimeout_;
 
-    for (const auto& hook : hooks_) {
+    for (std::size_t i = 0; i < hooks_.size();) {
         if (std::chrono::steady_clock::now() >= deadline) {
-            std::cerr << "Graceful shutdown timeout reached, skipping: " << hook.name << "\n";
+            std::cerr << "Graceful shutdown timeout reached, skipping: " << hooks_[i].name
+                      << "\n";
             break;
         }
 
-        try {
-            hook.callback();
-        } catch (const std::exception& e) {
-            std::cerr << "Shutdown hook '" << hook.name << "' failed: " << e.what() << "\n";
-        } catch (...) {
-            std::cerr << "Shutdown hook '" << hook.name << "' failed with unknown error\n";
+        if (!hooks_[i].concurrent) {
+            runHook(hooks_[i].name, hooks_[i].callback);
+            ++i;
+            continue;
+        }
+
+        // Drain the group of adjacent concurrent hooks in parallel; the
+        // first one runs on this thread.
+        auto end = i + 1;
+        while (end < hooks_.size() && hooks_[end].concurrent) {
+            ++end;
+        }
+        std::vector<std::thread> threads;
+        for (auto j = i + 1; j < end; ++j) {
+            threads.emplace_back([this, j] { runHook(hooks_[j].name, hooks_[j].callback); });
+        }
+        runHook(hooks_[i].name, hooks_[i].callback);
+        for (auto& thread : threads) {
+            thread.join();
         }
+        i = end;
     }
 }
 
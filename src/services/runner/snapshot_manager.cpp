@@ -5,74 +5,229 @@
 
 #include "cgs/foundation/error_code.hpp"
 #include "cgs/foundation/game_error.hpp"
+#include "cgs/foundation/payload_codec.hpp"
+#include "cgs/service/crc32c.hpp"
+
+#include "io_ring.hpp"
+#include "mapped_file.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cstring>
-#include <fstream>
+#include <functional>
+#include <iterator>
 #include <mutex>
+#include <optional>
 #include <regex>
+#include <span>
+#include <string_view>
+#include <unordered_set>
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#endif
 
 namespace cgs::service {
 
 using cgs::foundation::ErrorCode;
 using cgs::foundation::GameError;
 using cgs::foundation::GameResult;
+using cgs::foundation::PlayerId;
 
 // -- Binary format helpers ---------------------------------------------------
 
 namespace {
 
-/// Snapshot file binary layout:
-///   [8: walSequence] [8: timestampUs] [4: playerCount]
-///   For each player:
+/// Snapshot file binary layout (format version 4):
+///   [4: "CSNP"] [4: format version 4]
+///   Blocks, each the LZ4 block encoding (or raw bytes) of records
 ///     [8: playerId] [4: instanceId] [4: dataSize] [N: data]
+///   Index:
+///     [1: incremental] [8: baseSequence] [8: walSequence] [8: timestampUs]
+///     [4: removedCount] [8 each: removed playerId]
+///     [4: blockCount] per block:
+///       [8: offset] [4: storedSize] [4: rawSize] [4: crc32c of stored bytes] [1: codec]
+///     [4: playerCount] per player, ascending by id: [8: playerId] [4: block]
+///   [8: index offset] [4: crc32c of the index]
+///
+/// Readers map the file, verify the index and decode only the blocks
+/// they need. Versions 1 to 3 (below) are one checksummed body and are
+/// still read, in full.
+constexpr std::array<char, 4> kSnapshotMagic = {'C', 'S', 'N', 'P'};
+constexpr uint32_t kSnapshotVersion = 4;
+constexpr std::size_t kSnapshotHeaderSize = 8;
+constexpr std::size_t kTrailerSize = 8 + 4;
+constexpr std::size_t kBlockEntrySize = 8 + 4 + 4 + 4 + 1;
+constexpr std::size_t kPlayerEntrySize = 8 + 4;
+constexpr std::size_t kRecordHeaderSize = 8 + 4 + 4;
+
+/// Block codecs.
+constexpr uint8_t kCodecRaw = 0;
+constexpr uint8_t kCodecLz4 = 1;
+
+template <typename T>
+void put(std::vector<uint8_t>& out, const T& value) {
+    const auto offset = out.size();
+    out.resize(offset + sizeof(T));
+    std::memcpy(out.data() + offset, &value, sizeof(T));
+}
 
-std::vector<uint8_t> serializeSnapshot(const Snapshot& snap) {
-    // Calculate total size.
-    std::size_t totalSize = 8 + 8 + 4;
+template <typename T>
+T get(const uint8_t* ptr) {
+    T value;
+    std::memcpy(&value, ptr, sizeof(T));
+    return value;
+}
+
+/// Largest file serializeSnapshot() can produce for @p snap: every
+/// block stored raw, one block per player.
+std::size_t serializedSizeBound(const Snapshot& snap) {
+    std::size_t records = 0;
     for (const auto& p : snap.players) {
-        totalSize += 8 + 4 + 4 + p.data.size();
+        records += kRecordHeaderSize + p.data.size();
     }
+    return kSnapshotHeaderSize + records + (1 + 8 + 8 + 8 + 4) + 8 * snap.removedPlayers.size() +
+           4 + kBlockEntrySize * snap.players.size() + 4 + kPlayerEntrySize * snap.players.size() +
+           kTrailerSize;
+}
 
-    std::vector<uint8_t> buf(totalSize);
-    auto* ptr = buf.data();
-
-    std::memcpy(ptr, &snap.walSequence, 8);
-    ptr += 8;
-    std::memcpy(ptr, &snap.timestampUs, 8);
-    ptr += 8;
-    auto count = static_cast<uint32_t>(snap.players.size());
-    std::memcpy(ptr, &count, 4);
-    ptr += 4;
+/// Receives the bytes serialized since the previous call and their file
+/// offset: the header with the first block, each later block, then the
+/// index.  The bytes stay valid until serializeSnapshot()'s result dies.
+using SerializedBytesSink = std::function<void(std::span<const uint8_t>, uint64_t)>;
+
+std::vector<uint8_t> serializeSnapshot(const Snapshot& snap,
+                                       const SnapshotConfig& config,
+                                       const SerializedBytesSink& sink = {}) {
+    struct BlockEntry {
+        uint64_t offset = 0;
+        uint32_t storedSize = 0;
+        uint32_t rawSize = 0;
+        uint32_t crc = 0;
+        uint8_t codec = kCodecRaw;
+    };
+
+    std::vector<uint8_t> out;
+    std::size_t streamed = 0;
+    auto stream = [&] {
+        if (sink && out.size() > streamed) {
+            sink(std::span<const uint8_t>(out).subspan(streamed), streamed);
+            streamed = out.size();
+        }
+    };
+    if (sink) {
+        out.reserve(serializedSizeBound(snap));  // Streamed bytes never move.
+    }
+    out.insert(out.end(), kSnapshotMagic.begin(), kSnapshotMagic.end());
+    put(out, kSnapshotVersion);
+
+    std::vector<BlockEntry> blocks;
+    std::vector<std::pair<uint64_t, uint32_t>> players;  // (playerId, block)
+    players.reserve(snap.players.size());
+
+    std::vector<uint8_t> raw;
+    std::vector<uint8_t> packed;
+    auto flushBlock = [&] {
+        if (raw.empty()) {
+            return;
+        }
+        packed.clear();
+        if (config.compress) {
+            cgs::foundation::compressLz4Block(raw, packed);
+        }
+        const bool compressed = config.compress && packed.size() < raw.size();
+        const auto& stored = compressed ? packed : raw;
+
+        BlockEntry entry;
+        entry.offset = out.size();
+        entry.storedSize = static_cast<uint32_t>(stored.size());
+        entry.rawSize = static_cast<uint32_t>(raw.size());
+        entry.crc = crc32c(stored.data(), stored.size());
+        entry.codec = compressed ? kCodecLz4 : kCodecRaw;
+        blocks.push_back(entry);
+
+        out.insert(out.end(), stored.begin(), stored.end());
+        raw.clear();
+        stream();
+    };
 
     for (const auto& p : snap.players) {
-        auto pid = p.playerId.value();
-        std::memcpy(ptr, &pid, 8);
-        ptr += 8;
-        std::memcpy(ptr, &p.instanceId, 4);
-        ptr += 4;
-        auto dataSize = static_cast<uint32_t>(p.data.size());
-        std::memcpy(ptr, &dataSize, 4);
-        ptr += 4;
-        if (!p.data.empty()) {
-            std::memcpy(ptr, p.data.data(), p.data.size());
-            ptr += p.data.size();
+        if (!raw.empty() && raw.size() + kRecordHeaderSize + p.data.size() > config.blockSize) {
+            flushBlock();
         }
+        players.emplace_back(p.playerId.value(), static_cast<uint32_t>(blocks.size()));
+
+        put(raw, p.playerId.value());
+        put(raw, p.instanceId);
+        put(raw, static_cast<uint32_t>(p.data.size()));
+        raw.insert(raw.end(), p.data.begin(), p.data.end());
+    }
+    flushBlock();
+
+    const uint64_t indexOffset = out.size();
+    out.push_back(snap.incremental ? 1 : 0);
+    put(out, snap.baseSequence);
+    put(out, snap.walSequence);
+    put(out, snap.timestampUs);
+    put(out, static_cast<uint32_t>(snap.removedPlayers.size()));
+    for (const auto& id : snap.removedPlayers) {
+        put(out, id.value());
+    }
+    put(out, static_cast<uint32_t>(blocks.size()));
+    for (const auto& b : blocks) {
+        put(out, b.offset);
+        put(out, b.storedSize);
+        put(out, b.rawSize);
+        put(out, b.crc);
+        out.push_back(b.codec);
+    }
+    std::stable_sort(players.begin(), players.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+    put(out, static_cast<uint32_t>(players.size()));
+    for (const auto& [pid, block] : players) {
+        put(out, pid);
+        put(out, block);
     }
 
-    return buf;
+    auto indexCrc = crc32c(out.data() + indexOffset, out.size() - indexOffset);
+    put(out, indexOffset);
+    put(out, indexCrc);
+    stream();
+    return out;
 }
 
-GameResult<Snapshot> deserializeSnapshot(const std::vector<uint8_t>& buf) {
-    constexpr std::size_t kHeaderSize = 8 + 8 + 4;
-    if (buf.size() < kHeaderSize) {
+/// Version 3 and earlier: a single body
+///   [1: incremental] [8: baseSequence]                       (version 3)
+///   [8: walSequence] [8: timestampUs] [4: playerCount]
+///   For each player:
+///     [8: playerId] [4: instanceId] [4: dataSize] [N: data]
+///   [4: removedCount] [8 each: removed playerId]             (version 3)
+/// behind the header and followed by a crc32c of the body. Version 1
+/// files are the version 2 body alone, without header or checksum.
+
+/// Parse the body of a format @p version snapshot in [@p begin, @p end).
+GameResult<Snapshot> deserializeBody(const uint8_t* begin, const uint8_t* end, uint32_t version) {
+    const std::size_t headerSize = (version >= 3 ? 1 + 8 : 0) + 8 + 8 + 4;
+    if (static_cast<std::size_t>(end - begin) < headerSize) {
         return GameResult<Snapshot>::err(
             GameError(ErrorCode::SnapshotCorrupted, "snapshot too small for header"));
     }
 
     Snapshot snap;
-    const auto* ptr = buf.data();
+    const auto* ptr = begin;
 
+    if (version >= 3) {
+        snap.incremental = *ptr++ != 0;
+        std::memcpy(&snap.baseSequence, ptr, 8);
+        ptr += 8;
+    }
     std::memcpy(&snap.walSequence, ptr, 8);
     ptr += 8;
     std::memcpy(&snap.timestampUs, ptr, 8);
@@ -81,8 +236,6 @@ GameResult<Snapshot> deserializeSnapshot(const std::vector<uint8_t>& buf) {
     std::memcpy(&count, ptr, 4);
     ptr += 4;
 
-    const auto* end = buf.data() + buf.size();
-
     for (uint32_t i = 0; i < count; ++i) {
         if (ptr + 16 > end) {
             return GameResult<Snapshot>::err(GameError(
@@ -111,9 +264,450 @@ GameResult<Snapshot> deserializeSnapshot(const std::vector<uint8_t>& buf) {
         snap.players.push_back(std::move(player));
     }
 
+    if (version >= 3) {
+        uint32_t removed = 0;
+        if (ptr + 4 <= end) {
+            std::memcpy(&removed, ptr, 4);
+            ptr += 4;
+        }
+        if (static_cast<std::size_t>(end - ptr) < std::size_t{8} * removed) {
+            return GameResult<Snapshot>::err(
+                GameError(ErrorCode::SnapshotCorrupted, "removed player list truncated"));
+        }
+        for (uint32_t i = 0; i < removed; ++i) {
+            uint64_t pid = 0;
+            std::memcpy(&pid, ptr, 8);
+            ptr += 8;
+            snap.removedPlayers.emplace_back(pid);
+        }
+    }
+
     return GameResult<Snapshot>::ok(std::move(snap));
 }
 
+/// Verify and parse a snapshot file of format version 1 to 3.
+GameResult<Snapshot> deserializeLegacy(const uint8_t* data, std::size_t size) {
+    if (size < kSnapshotHeaderSize || std::memcmp(data, kSnapshotMagic.data(), 4) != 0) {
+        return deserializeBody(data, data + size, 1);
+    }
+
+    auto version = get<uint32_t>(data + 4);
+    if (version < 2) {
+        return GameResult<Snapshot>::err(
+            GameError(ErrorCode::SnapshotCorrupted,
+                      "unsupported snapshot version " + std::to_string(version)));
+    }
+    if (size < kSnapshotHeaderSize + 4) {
+        return GameResult<Snapshot>::err(
+            GameError(ErrorCode::SnapshotCorrupted, "snapshot too small for checksum"));
+    }
+
+    const auto* body = data + kSnapshotHeaderSize;
+    const auto* end = data + size - 4;
+    if (crc32c(body, static_cast<std::size_t>(end - body)) != get<uint32_t>(end)) {
+        return GameResult<Snapshot>::err(
+            GameError(ErrorCode::SnapshotCorrupted, "snapshot checksum mismatch"));
+    }
+    return deserializeBody(body, end, version);
+}
+
+GameResult<void> corrupted(const std::string& message) {
+    return GameResult<void>::err(GameError(ErrorCode::SnapshotCorrupted, message));
+}
+
+/// One snapshot file opened for reading.
+///
+/// A version 4 file stays mapped and only its index is parsed on open();
+/// players are decoded block by block on request. Older files are
+/// decoded in full on open().
+class SnapshotFile {
+public:
+    GameResult<void> open(const std::filesystem::path& path) {
+        if (!map_.map(path, detail::MappedFile::Access::Random)) {
+            return GameResult<void>::err(
+                GameError(ErrorCode::SnapshotReadFailed, "cannot open snapshot file"));
+        }
+
+        const auto* data = map_.data();
+        const auto size = map_.size();
+        if (size < kSnapshotHeaderSize || std::memcmp(data, kSnapshotMagic.data(), 4) != 0 ||
+            get<uint32_t>(data + 4) < kSnapshotVersion) {
+            auto legacy = deserializeLegacy(data, size);
+            map_.unmap();
+            if (legacy.hasError()) {
+                return GameResult<void>::err(legacy.error());
+            }
+            legacy_ = std::move(legacy.value());
+            incremental_ = legacy_->incremental;
+            baseSequence_ = legacy_->baseSequence;
+            walSequence_ = legacy_->walSequence;
+            timestampUs_ = legacy_->timestampUs;
+            removed_ = legacy_->removedPlayers;
+            return GameResult<void>::ok();
+        }
+
+        auto version = get<uint32_t>(data + 4);
+        if (version != kSnapshotVersion) {
+            return corrupted("unsupported snapshot version " + std::to_string(version));
+        }
+        return parseIndex();
+    }
+
+    [[nodiscard]] bool incremental() const { return incremental_; }
+    [[nodiscard]] uint64_t baseSequence() const { return baseSequence_; }
+    [[nodiscard]] uint64_t walSequence() const { return walSequence_; }
+    [[nodiscard]] uint64_t timestampUs() const { return timestampUs_; }
+    [[nodiscard]] const std::vector<PlayerId>& removed() const { return removed_; }
+
+    [[nodiscard]] bool contains(PlayerId id) const {
+        if (legacy_) {
+            return std::any_of(legacy_->players.begin(), legacy_->players.end(),
+                               [&](const PlayerSnapshot& p) { return p.playerId == id; });
+        }
+        return findPlayer(id) != nullptr;
+    }
+
+    /// Player ids in ascending order.
+    [[nodiscard]] std::vector<PlayerId> playerIds() const {
+        std::vector<PlayerId> ids;
+        if (legacy_) {
+            for (const auto& p : legacy_->players) {
+                ids.push_back(p.playerId);
+            }
+            std::sort(ids.begin(), ids.end());
+            return ids;
+        }
+        ids.reserve(playerCount_);
+        for (uint32_t i = 0; i < playerCount_; ++i) {
+            ids.emplace_back(get<uint64_t>(playerTable_ + i * kPlayerEntrySize));
+        }
+        return ids;
+    }
+
+    /// Decode @p id's record; nullopt if the file does not hold it.
+    [[nodiscard]] GameResult<std::optional<PlayerSnapshot>> load(PlayerId id) const {
+        using Result = GameResult<std::optional<PlayerSnapshot>>;
+        if (legacy_) {
+            for (const auto& p : legacy_->players) {
+                if (p.playerId == id) {
+                    return Result::ok(p);
+                }
+            }
+            return Result::ok(std::nullopt);
+        }
+
+        const auto* entry = findPlayer(id);
+        if (entry == nullptr) {
+            return Result::ok(std::nullopt);
+        }
+        std::vector<PlayerSnapshot> players;
+        auto decoded = decodeBlock(get<uint32_t>(entry + 8), players);
+        if (decoded.hasError()) {
+            return Result::err(decoded.error());
+        }
+        for (auto& p : players) {
+            if (p.playerId == id) {
+                return Result::ok(std::move(p));
+            }
+        }
+        return Result::err(
+            GameError(ErrorCode::SnapshotCorrupted, "player missing from its snapshot block"));
+    }
+
+    /// Decode every player, in the order they were saved.
+    [[nodiscard]] GameResult<Snapshot> loadAll() const {
+        if (legacy_) {
+            return GameResult<Snapshot>::ok(*legacy_);
+        }
+
+        Snapshot snap;
+        snap.incremental = incremental_;
+        snap.baseSequence = baseSequence_;
+        snap.walSequence = walSequence_;
+        snap.timestampUs = timestampUs_;
+        snap.removedPlayers = removed_;
+        snap.players.reserve(playerCount_);
+        for (uint32_t block = 0; block < blockCount_; ++block) {
+            auto decoded = decodeBlock(block, snap.players);
+            if (decoded.hasError()) {
+                return GameResult<Snapshot>::err(decoded.error());
+            }
+        }
+        return GameResult<Snapshot>::ok(std::move(snap));
+    }
+
+private:
+    /// Verify the trailer and index of a version 4 file.
+    GameResult<void> parseIndex() {
+        const auto* data = map_.data();
+        const auto size = map_.size();
+        if (size < kSnapshotHeaderSize + kTrailerSize) {
+            return corrupted("snapshot too small for index");
+        }
+
+        const auto* trailer = data + size - kTrailerSize;
+        auto indexOffset = get<uint64_t>(trailer);
+        if (indexOffset < kSnapshotHeaderSize || indexOffset > size - kTrailerSize) {
+            return corrupted("snapshot index offset out of range");
+        }
+        const auto* ptr = data + indexOffset;
+        const auto* end = trailer;
+        if (crc32c(ptr, static_cast<std::size_t>(end - ptr)) != get<uint32_t>(trailer + 8)) {
+            return corrupted("snapshot index checksum mismatch");
+        }
+
+        auto left = [&] { return static_cast<std::size_t>(end - ptr); };
+        if (left() < 1 + 8 + 8 + 8 + 4) {
+            return corrupted("snapshot index truncated");
+        }
+        incremental_ = *ptr++ != 0;
+        baseSequence_ = get<uint64_t>(ptr);
+        walSequence_ = get<uint64_t>(ptr + 8);
+        timestampUs_ = get<uint64_t>(ptr + 16);
+        auto removedCount = get<uint32_t>(ptr + 24);
+        ptr += 28;
+
+        if (left() < std::size_t{8} * removedCount + 4) {
+            return corrupted("snapshot index truncated");
+        }
+        for (uint32_t i = 0; i < removedCount; ++i, ptr += 8) {
+            removed_.emplace_back(get<uint64_t>(ptr));
+        }
+        blockCount_ = get<uint32_t>(ptr);
+        ptr += 4;
+
+        if (left() < kBlockEntrySize * blockCount_ + 4) {
+            return corrupted("snapshot index truncated");
+        }
+        blockTable_ = ptr;
+        for (uint32_t i = 0; i < blockCount_; ++i, ptr += kBlockEntrySize) {
+            auto offset = get<uint64_t>(ptr);
+            auto stored = get<uint32_t>(ptr + 8);
+            if (offset < kSnapshotHeaderSize || offset > indexOffset ||
+                stored > indexOffset - offset) {
+                return corrupted("snapshot block out of range");
+            }
+        }
+        playerCount_ = get<uint32_t>(ptr);
+        ptr += 4;
+
+        if (left() != kPlayerEntrySize * playerCount_) {
+            return corrupted("snapshot player index size mismatch");
+        }
+        playerTable_ = ptr;
+        return GameResult<void>::ok();
+    }
+
+    /// Index entry of @p id (binary search), or nullptr.
+    [[nodiscard]] const uint8_t* findPlayer(PlayerId id) const {
+        std::size_t lo = 0;
+        std::size_t hi = playerCount_;
+        while (lo < hi) {
+            auto mid = lo + (hi - lo) / 2;
+            const auto* entry = playerTable_ + mid * kPlayerEntrySize;
+            auto pid = get<uint64_t>(entry);
+            if (pid == id.value()) {
+                return entry;
+            }
+            if (pid < id.value()) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return nullptr;
+    }
+
+    /// Verify, decompress and parse @p block, appending to @p players.
+    GameResult<void> decodeBlock(uint32_t block, std::vector<PlayerSnapshot>& players) const {
+        if (block >= blockCount_) {
+            return corrupted("snapshot player index names a missing block");
+        }
+        const auto* entry = blockTable_ + block * kBlockEntrySize;
+        const auto* stored = map_.data() + get<uint64_t>(entry);
+        auto storedSize = get<uint32_t>(entry + 8);
+        auto rawSize = get<uint32_t>(entry + 12);
+        if (crc32c(stored, storedSize) != get<uint32_t>(entry + 16)) {
+            return corrupted("snapshot block checksum mismatch");
+        }
+
+        std::vector<uint8_t> scratch;
+        std::span<const uint8_t> raw(stored, storedSize);
+        if (entry[20] == kCodecLz4) {
+            if (!cgs::foundation::decompressLz4Block(raw, rawSize, scratch)) {
+                return corrupted("snapshot block does not decompress");
+            }
+            raw = scratch;
+        } else if (entry[20] != kCodecRaw || storedSize != rawSize) {
+            return corrupted("snapshot block has an unknown codec");
+        }
+
+        const auto* ptr = raw.data();
+        const auto* end = ptr + raw.size();
+        while (ptr != end) {
+            if (static_cast<std::size_t>(end - ptr) < kRecordHeaderSize) {
+                return corrupted("snapshot record truncated");
+            }
+            PlayerSnapshot player;
+            player.playerId = PlayerId(get<uint64_t>(ptr));
+            player.instanceId = get<uint32_t>(ptr + 8);
+            auto dataSize = get<uint32_t>(ptr + 12);
+            ptr += kRecordHeaderSize;
+            if (static_cast<std::size_t>(end - ptr) < dataSize) {
+                return corrupted("player data truncated");
+            }
+            player.data.assign(ptr, ptr + dataSize);
+            ptr += dataSize;
+            players.push_back(std::move(player));
+        }
+        return GameResult<void>::ok();
+    }
+
+    detail::MappedFile map_;
+    std::optional<Snapshot> legacy_;  // Versions 1 to 3, decoded on open().
+
+    bool incremental_ = false;
+    uint64_t baseSequence_ = 0;
+    uint64_t walSequence_ = 0;
+    uint64_t timestampUs_ = 0;
+    std::vector<PlayerId> removed_;
+
+    uint32_t blockCount_ = 0;
+    uint32_t playerCount_ = 0;
+    const uint8_t* blockTable_ = nullptr;
+    const uint8_t* playerTable_ = nullptr;  // Sorted by player id.
+};
+
+/// Apply incremental snapshot @p delta on top of its full @p base.
+Snapshot mergeSnapshots(Snapshot base, Snapshot delta) {
+    std::unordered_set<cgs::foundation::PlayerId> replaced(delta.removedPlayers.begin(),
+                                                           delta.removedPlayers.end());
+    for (const auto& p : delta.players) {
+        replaced.insert(p.playerId);
+    }
+    std::erase_if(base.players,
+                  [&](const PlayerSnapshot& p) { return replaced.contains(p.playerId); });
+    for (auto& p : delta.players) {
+        base.players.push_back(std::move(p));
+    }
+
+    base.walSequence = delta.walSequence;
+    base.timestampUs = delta.timestampUs;
+    return base;
+}
+
+/// Create (or truncate) the temporary file a snapshot is written to
+/// before it is renamed over its final path.
+int openTemporary(const std::filesystem::path& tmpPath) {
+#if defined(_WIN32)
+    return _wopen(tmpPath.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY,
+                  _S_IREAD | _S_IWRITE);
+#else
+    return ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+#endif
+}
+
+/// Close @p fd and, if @p ok, rename @p tmpPath to @p path (syncing the
+/// directory if @p sync); otherwise remove the temporary file.
+bool publishTemporary(int fd,
+                      bool ok,
+                      const std::filesystem::path& tmpPath,
+                      const std::filesystem::path& path,
+                      bool sync) {
+#if defined(_WIN32)
+    ok = _close(fd) == 0 && ok;
+#else
+    ok = ::close(fd) == 0 && ok;
+#endif
+
+    std::error_code ec;
+    if (ok) {
+        std::filesystem::rename(tmpPath, path, ec);
+        ok = !ec;
+    }
+    if (!ok) {
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+
+#if !defined(_WIN32)
+    if (sync) {
+        int dirFd = ::open(path.parent_path().c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (dirFd >= 0) {
+            (void)::fsync(dirFd);
+            ::close(dirFd);
+        }
+    }
+#endif
+    return true;
+}
+
+/// Write @p data to a temporary file, sync it if @p sync, and rename it
+/// to @p path, so a crash never leaves a partial snapshot under a name
+/// loadLatest() reads.
+bool writeFileAtomically(const std::filesystem::path& path,
+                         const std::vector<uint8_t>& data,
+                         bool sync) {
+    auto tmpPath = path;
+    tmpPath += ".tmp";
+    int fd = openTemporary(tmpPath);
+    if (fd < 0) {
+        return false;
+    }
+
+    bool ok = true;
+    const auto* ptr = data.data();
+    std::size_t left = data.size();
+    while (ok && left > 0) {
+#if defined(_WIN32)
+        auto chunk = static_cast<unsigned int>(std::min<std::size_t>(left, 1u << 30));
+        auto written = _write(fd, ptr, chunk);
+#else
+        auto written = ::write(fd, ptr, left);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+#endif
+        ok = written > 0;
+        if (ok) {
+            ptr += written;
+            left -= static_cast<std::size_t>(written);
+        }
+    }
+
+#if defined(_WIN32)
+    ok = ok && (!sync || _commit(fd) == 0);
+#else
+    ok = ok && (!sync || ::fsync(fd) == 0);
+#endif
+    return publishTemporary(fd, ok, tmpPath, path, sync);
+}
+
+/// writeFileAtomically() for @p snap through @p ring: each block is
+/// submitted as soon as it is encoded, so the disk writes overlap the
+/// compression of later blocks, and the fsync is linked behind the last.
+bool writeSnapshotThroughRing(const std::filesystem::path& path,
+                              const Snapshot& snap,
+                              const SnapshotConfig& config,
+                              detail::IoRing& ring) {
+    auto tmpPath = path;
+    tmpPath += ".tmp";
+    int fd = openTemporary(tmpPath);
+    if (fd < 0) {
+        return false;
+    }
+
+    bool ok = true;
+    auto data = serializeSnapshot(
+        snap, config, [&](std::span<const uint8_t> bytes, uint64_t offset) {
+            ok = ok && ring.write(fd, bytes.data(), bytes.size(), offset) && ring.submit();
+        });
+    // Always reap, even after a failure: writes in flight still use data.
+    auto sync = config.syncOnSave ? detail::IoRing::Sync::Full : detail::IoRing::Sync::None;
+    ok = ring.complete(fd, sync) && ok;
+    return publishTemporary(fd, ok, tmpPath, path, config.syncOnSave);
+}
+
 uint64_t nowMicros() {
     auto now = std::chrono::system_clock::now();
     return static_cast<uint64_t>(
@@ -122,22 +716,111 @@ uint64_t nowMicros() {
 
 }  // namespace
 
+// -- SnapshotReader ----------------------------------------------------------
+
+struct SnapshotReader::Impl {
+    SnapshotFile base;
+    std::unique_ptr<SnapshotFile> delta;  // Newest increment on top of base.
+
+    /// The file that decides whether @p id is present, or nullptr when
+    /// the increment removed it.
+    [[nodiscard]] const SnapshotFile* owner(PlayerId id) const {
+        if (delta) {
+            const auto& removed = delta->removed();
+            if (std::find(removed.begin(), removed.end(), id) != removed.end()) {
+                return nullptr;
+            }
+            if (delta->contains(id)) {
+                return delta.get();
+            }
+        }
+        return &base;
+    }
+};
+
+SnapshotReader::SnapshotReader(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {}
+SnapshotReader::SnapshotReader(SnapshotReader&&) noexcept = default;
+SnapshotReader& SnapshotReader::operator=(SnapshotReader&&) noexcept = default;
+SnapshotReader::~SnapshotReader() = default;
+
+uint64_t SnapshotReader::walSequence() const {
+    return impl_->delta ? impl_->delta->walSequence() : impl_->base.walSequence();
+}
+
+uint64_t SnapshotReader::timestampUs() const {
+    return impl_->delta ? impl_->delta->timestampUs() : impl_->base.timestampUs();
+}
+
+bool SnapshotReader::contains(PlayerId playerId) const {
+    const auto* file = impl_->owner(playerId);
+    return file != nullptr && file->contains(playerId);
+}
+
+std::vector<PlayerId> SnapshotReader::playerIds() const {
+    auto ids = impl_->base.playerIds();
+    if (!impl_->delta) {
+        return ids;
+    }
+    const auto& removed = impl_->delta->removed();
+    std::erase_if(ids, [&](PlayerId id) {
+        return std::find(removed.begin(), removed.end(), id) != removed.end();
+    });
+    auto added = impl_->delta->playerIds();
+    std::vector<PlayerId> merged;
+    merged.reserve(ids.size() + added.size());
+    std::set_union(ids.begin(), ids.end(), added.begin(), added.end(),
+                   std::back_inserter(merged));
+    return merged;
+}
+
+GameResult<PlayerSnapshot> SnapshotReader::loadPlayer(PlayerId playerId) const {
+    const auto* file = impl_->owner(playerId);
+    if (file != nullptr) {
+        auto loaded = file->load(playerId);
+        if (loaded.hasError()) {
+            return GameResult<PlayerSnapshot>::err(loaded.error());
+        }
+        if (loaded.value()) {
+            return GameResult<PlayerSnapshot>::ok(std::move(*loaded.value()));
+        }
+    }
+    return GameResult<PlayerSnapshot>::err(
+        GameError(ErrorCode::NotFound,
+                  "player " + std::to_string(playerId.value()) + " is not in the snapshot"));
+}
+
+GameResult<Snapshot> SnapshotReader::loadAll() const {
+    auto base = impl_->base.loadAll();
+    if (base.hasError() || !impl_->delta) {
+        return base;
+    }
+    auto delta = impl_->delta->loadAll();
+    if (delta.hasError()) {
+        return delta;
+    }
+    return GameResult<Snapshot>::ok(
+        mergeSnapshots(std::move(base.value()), std::move(delta.value())));
+}
+
 // -- Impl -------------------------------------------------------------------
 
 struct SnapshotManager::Impl {
     SnapshotConfig config;
     mutable std::mutex mutex;
     bool open = false;
+    detail::IoRing ring;  // Active with useIoUring where supported.
 
     explicit Impl(SnapshotConfig cfg) : config(std::move(cfg)) {}
 
-    /// Generate a snapshot filename with timestamp for ordering.
-    std::filesystem::path snapshotPath(uint64_t timestampUs) const {
-        return config.directory / ("snapshot_" + std::to_string(timestampUs) + ".bin");
+    /// Generate a snapshot filename with timestamp for ordering. Full
+    /// snapshots start with "snapshot_", incremental ones with "delta_".
+    std::filesystem::path snapshotPath(uint64_t timestampUs, bool incremental) const {
+        return config.directory / ((incremental ? "delta_" : "snapshot_") +
+                                   std::to_string(timestampUs) + ".bin");
     }
 
-    /// List all snapshot files sorted by timestamp (oldest first).
-    std::vector<std::filesystem::path> listSnapshots() const {
+    /// List snapshot files with @p prefix sorted by timestamp (oldest first).
+    std::vector<std::filesystem::path> listFiles(std::string_view prefix) const {
         std::vector<std::filesystem::path> files;
 
         if (!std::filesystem::exists(config.directory)) {
@@ -146,7 +829,7 @@ struct SnapshotManager::Impl {
 
         for (const auto& entry : std::filesystem::directory_iterator(config.directory)) {
             if (entry.is_regular_file() &&
-                entry.path().filename().string().starts_with("snapshot_") &&
+                entry.path().filename().string().starts_with(prefix) &&
                 entry.path().extension() == ".bin") {
                 files.push_back(entry.path());
             }
@@ -156,14 +839,30 @@ struct SnapshotManager::Impl {
         return files;
     }
 
-    /// Prune old snapshots to keep only maxRetained.
-    void pruneOldSnapshots() {
+    /// List all full snapshot files sorted by timestamp (oldest first).
+    std::vector<std::filesystem::path> listSnapshots() const { return listFiles("snapshot_"); }
+
+    /// List all incremental snapshot files sorted by timestamp (oldest first).
+    std::vector<std::filesystem::path> listDeltas() const { return listFiles("delta_"); }
+
+    /// Prune old snapshots to keep only maxRetained full snapshots, and
+    /// incremental snapshots other than the just-written @p keep.
+    void pruneOldSnapshots(const std::filesystem::path& keep) {
         auto files = listSnapshots();
         while (files.size() > config.maxRetained) {
             std::error_code ec;
             std::filesystem::remove(files.front(), ec);
             files.erase(files.begin());
         }
+
+        // Incremental snapshots are cumulative since their base, so the
+        // newest one supersedes the rest; a new base supersedes them all.
+        for (const auto& delta : listDeltas()) {
+            if (delta != keep) {
+                std::error_code ec;
+                std::filesystem::remove(delta, ec);
+            }
+        }
     }
 };
 
@@ -193,6 +892,9 @@ GameResult<void> SnapshotManager::open() {
         return GameResult<void>::err(GameError(
             ErrorCode::PersistenceError, "failed to create snapshot directory: " + ec.message()));
     }
+    if (impl_->config.useIoUring) {
+        (void)impl_->ring.init();
+    }
 
     impl_->open = true;
     return GameResult<void>::ok();
@@ -200,9 +902,15 @@ GameResult<void> SnapshotManager::open() {
 
 void SnapshotManager::close() {
     std::lock_guard lock(impl_->mutex);
+    impl_->ring.shutdown();
     impl_->open = false;
 }
 
+bool SnapshotManager::ioUringActive() const {
+    std::lock_guard lock(impl_->mutex);
+    return impl_->ring.active();
+}
+
 // -- Save / Load -------------------------------------------------------------
 
 GameResult<void> SnapshotManager::save(const Snapshot& snapshot) {
@@ -215,60 +923,63 @@ GameResult<void> SnapshotManager::save(const Snapshot& snapshot) {
 
     auto timestampUs = snapshot.timestampUs > 0 ? snapshot.timestampUs : nowMicros();
 
-    auto path = impl_->snapshotPath(timestampUs);
-    auto data = serializeSnapshot(snapshot);
+    auto path = impl_->snapshotPath(timestampUs, snapshot.incremental);
+    bool written =
+        impl_->ring.active()
+            ? writeSnapshotThroughRing(path, snapshot, impl_->config, impl_->ring)
+            : writeFileAtomically(path, serializeSnapshot(snapshot, impl_->config),
+                                  impl_->config.syncOnSave);
 
-    std::ofstream file(path, std::ios::binary);
-    if (!file) {
+    if (!written) {
         return GameResult<void>::err(
-            GameError(ErrorCode::SnapshotWriteFailed, "cannot open snapshot file for writing"));
+            GameError(ErrorCode::SnapshotWriteFailed, "failed to write snapshot file"));
     }
 
-    file.write(reinterpret_cast<const char*>(data.data()),
-               static_cast<std::streamsize>(data.size()));
-    file.flush();
-
-    if (!file) {
-        return GameResult<void>::err(
-            GameError(ErrorCode::SnapshotWriteFailed, "failed to write snapshot data"));
-    }
-
-    file.close();
-
     // Prune old snapshots.
-    impl_->pruneOldSnapshots();
+    impl_->pruneOldSnapshots(path);
 
     return GameResult<void>::ok();
 }
 
 GameResult<Snapshot> SnapshotManager::loadLatest() const {
+    auto reader = openLatest();
+    if (reader.hasError()) {
+        return GameResult<Snapshot>::err(reader.error());
+    }
+    return reader.value().loadAll();
+}
+
+GameResult<SnapshotReader> SnapshotManager::openLatest() const {
     std::lock_guard lock(impl_->mutex);
 
     auto files = impl_->listSnapshots();
     if (files.empty()) {
-        return GameResult<Snapshot>::err(
+        return GameResult<SnapshotReader>::err(
             GameError(ErrorCode::SnapshotReadFailed, "no snapshots found"));
     }
 
-    // Load the newest (last sorted) snapshot.
-    const auto& latestPath = files.back();
-
-    std::ifstream file(latestPath, std::ios::binary);
-    if (!file) {
-        return GameResult<Snapshot>::err(
-            GameError(ErrorCode::SnapshotReadFailed, "cannot open snapshot file"));
+    // Open the newest (last sorted) snapshot.
+    auto reader = std::make_unique<SnapshotReader::Impl>();
+    auto opened = reader->base.open(files.back());
+    if (opened.hasError()) {
+        return GameResult<SnapshotReader>::err(opened.error());
     }
 
-    auto fileSize = std::filesystem::file_size(latestPath);
-    std::vector<uint8_t> data(static_cast<std::size_t>(fileSize));
-    file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(fileSize));
-
-    if (static_cast<std::size_t>(file.gcount()) < fileSize) {
-        return GameResult<Snapshot>::err(
-            GameError(ErrorCode::SnapshotCorrupted, "snapshot file read incomplete"));
+    // Add the newest incremental snapshot taken on top of it, if any.
+    auto deltas = impl_->listDeltas();
+    for (auto it = deltas.rbegin(); it != deltas.rend(); ++it) {
+        auto delta = std::make_unique<SnapshotFile>();
+        opened = delta->open(*it);
+        if (opened.hasError()) {
+            return GameResult<SnapshotReader>::err(opened.error());
+        }
+        if (delta->incremental() && delta->baseSequence() == reader->base.walSequence()) {
+            reader->delta = std::move(delta);
+            break;
+        }
     }
 
-    return deserializeSnapshot(data);
+    return GameResult<SnapshotReader>::ok(SnapshotReader(std::move(reader)));
 }
 
 // -- Queries -----------------------------------------------------------------
@@ -278,6 +989,11 @@ std::size_t SnapshotManager::snapshotCount() const {
     return impl_->listSnapshots().size();
 }
 
+std::size_t SnapshotManager::incrementalCount() const {
+    std::lock_guard lock(impl_->mutex);
+    return impl_->listDeltas().size();
+}
+
 bool SnapshotManager::isOpen() const {
     std::lock_guard lock(impl_->mutex);
     return impl_->open;
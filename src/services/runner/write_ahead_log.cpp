@@ -1,16 +1,47 @@
 /// @file write_ahead_log.cpp
-/// @brief WriteAheadLog implementation with CRC32 integrity and sequential I/O.
+/// @brief WriteAheadLog implementation with CRC32 integrity and sequential I/O
+///        into fixed-size segment files.
 
 #include "cgs/service/write_ahead_log.hpp"
 
+#include "cgs/foundation/cpu_affinity.hpp"
 #include "cgs/foundation/error_code.hpp"
 #include "cgs/foundation/game_error.hpp"
+#include "cgs/foundation/profiled_mutex.hpp"
+#include "cgs/service/crc32c.hpp"
+
+#include "io_ring.hpp"
+#include "mapped_file.hpp"
 
 #include <algorithm>
+#include <array>
+#include <charconv>
+#include <condition_variable>
 #include <cstring>
+#include <deque>
 #include <fstream>
+#include <iterator>
 #include <mutex>
 #include <numeric>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#endif
 
 namespace cgs::service {
 
@@ -18,11 +49,12 @@ using cgs::foundation::ErrorCode;
 using cgs::foundation::GameError;
 using cgs::foundation::GameResult;
 
-// -- CRC32 (ISO 3309 polynomial) --------------------------------------------
+// -- Checksums --------------------------------------------------------------
 
 namespace {
 
-/// Compute CRC32 over a byte range.
+/// Compute CRC32 (ISO 3309 polynomial) over a byte range: the frame
+/// checksum of version 1 segments, which had no header.
 uint32_t crc32(const uint8_t* data, std::size_t length) {
     static constexpr uint32_t kPolynomial = 0xEDB88320;
     static const auto table = [] {
@@ -109,21 +141,327 @@ uint64_t nowMicros() {
         std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count());
 }
 
+/// Append the on-disk frame of @p entry to @p out.
+///
+/// Frame: [4: totalSize] [body] [4: crc], totalSize covering body + crc.
+std::size_t appendFrame(std::vector<uint8_t>& out, const WalEntry& entry) {
+    auto body = serializeEntry(entry);
+    uint32_t checksum = crc32c(body.data(), body.size());
+    uint32_t totalSize = static_cast<uint32_t>(body.size() + 4);
+
+    auto offset = out.size();
+    out.resize(offset + 4 + body.size() + 4);
+    auto* p = out.data() + offset;
+    std::memcpy(p, &totalSize, 4);
+    std::memcpy(p + 4, body.data(), body.size());
+    std::memcpy(p + 4 + body.size(), &checksum, 4);
+    return 4 + body.size() + 4;
+}
+
+/// Append-only file descriptor with an explicit data sync.
+///
+/// std::ofstream cannot sync to disk, so WAL writes go through the
+/// platform's unbuffered file API.
+class WalFile {
+public:
+    WalFile() = default;
+    ~WalFile() { close(); }
+
+    WalFile(const WalFile&) = delete;
+    WalFile& operator=(const WalFile&) = delete;
+
+    bool open(const std::filesystem::path& path, bool truncate = false) {
+        close();
+#if defined(_WIN32)
+        int flags = _O_WRONLY | _O_APPEND | _O_CREAT | _O_BINARY | (truncate ? _O_TRUNC : 0);
+        fd_ = _wopen(path.c_str(), flags, _S_IREAD | _S_IWRITE);
+#else
+        int flags = O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC | (truncate ? O_TRUNC : 0);
+        fd_ = ::open(path.c_str(), flags, 0644);
+#endif
+        return fd_ >= 0;
+    }
+
+    [[nodiscard]] bool isOpen() const { return fd_ >= 0; }
+    [[nodiscard]] int fd() const { return fd_; }
+
+    bool write(const uint8_t* data, std::size_t size) {
+        while (size > 0) {
+#if defined(_WIN32)
+            auto chunk = static_cast<unsigned int>(std::min<std::size_t>(size, 1u << 30));
+            auto written = _write(fd_, data, chunk);
+#else
+            auto written = ::write(fd_, data, size);
+            if (written < 0 && errno == EINTR) {
+                continue;
+            }
+#endif
+            if (written <= 0) {
+                return false;
+            }
+            data += written;
+            size -= static_cast<std::size_t>(written);
+        }
+        return true;
+    }
+
+    /// Force written data to stable storage.
+    bool sync() {
+#if defined(_WIN32)
+        return _commit(fd_) == 0;
+#elif defined(__linux__)
+        return ::fdatasync(fd_) == 0;
+#else
+        return ::fsync(fd_) == 0;
+#endif
+    }
+
+    /// Reserve @p size bytes of disk without changing the file size, so
+    /// appends up to it allocate no blocks (Linux only; a hint elsewhere).
+    void preallocate(std::size_t size) {
+#if defined(__linux__)
+        (void)::fallocate(fd_, FALLOC_FL_KEEP_SIZE, 0, static_cast<off_t>(size));
+#else
+        (void)size;
+#endif
+    }
+
+    /// Cut the file back to @p size (drops a partially written batch).
+    void truncate(std::size_t size) {
+#if defined(_WIN32)
+        (void)_chsize_s(fd_, static_cast<__int64>(size));
+#else
+        (void)::ftruncate(fd_, static_cast<off_t>(size));
+#endif
+    }
+
+    void close() {
+        if (fd_ >= 0) {
+#if defined(_WIN32)
+            _close(fd_);
+#else
+            ::close(fd_);
+#endif
+            fd_ = -1;
+        }
+    }
+
+private:
+    int fd_ = -1;
+};
+
+/// Unsynced frames written per chunk when syncOnWrite is off.
+constexpr std::size_t kWriteBufferBytes = 64 * 1024;
+
+/// On-disk size of an entry's frame: total size, header, data and CRC.
+std::size_t frameSize(const WalEntry& entry) {
+    return 4 + (8 + 8 + 8 + 1 + 4) + entry.data.size() + 4;
+}
+
+/// Segment file header: magic and format version.  Version 1 files
+/// (no header) carry CRC32 frames; version 2 carries CRC-32C.
+constexpr std::array<char, 4> kSegmentMagic = {'C', 'W', 'A', 'L'};
+constexpr uint32_t kSegmentVersion = 2;
+constexpr std::size_t kSegmentHeaderSize = 8;
+
+/// Single-file log written before segmentation; adopted on open().
+constexpr std::string_view kLegacyFileName = "wal.bin";
+
+/// Segment file name: "wal-<first sequence, 20 digits>.bin", so names
+/// sort by sequence.
+std::string segmentFileName(uint64_t firstSequence) {
+    auto digits = std::to_string(firstSequence);
+    return "wal-" + std::string(20 - digits.size(), '0') + digits + ".bin";
+}
+
+/// First sequence of a segment file name, if @p name is one.
+std::optional<uint64_t> parseSegmentFileName(const std::string& name) {
+    constexpr std::size_t kLength = 4 + 20 + 4;
+    if (name.size() != kLength || name.compare(0, 4, "wal-") != 0 ||
+        name.compare(kLength - 4, 4, ".bin") != 0) {
+        return std::nullopt;
+    }
+    uint64_t sequence = 0;
+    const char* first = name.data() + 4;
+    auto [ptr, ec] = std::from_chars(first, first + 20, sequence);
+    if (ec != std::errc{} || ptr != first + 20) {
+        return std::nullopt;
+    }
+    return sequence;
+}
+
+/// Make a new or removed directory entry durable.
+void syncDirectory(const std::filesystem::path& directory) {
+#if !defined(_WIN32)
+    int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd >= 0) {
+        (void)::fsync(fd);
+        ::close(fd);
+    }
+#else
+    (void)directory;
+#endif
+}
+
+using detail::MappedFile;
+
+/// Valid contents of one segment file, as found by scanSegments().
+struct ScannedSegment {
+    std::filesystem::path path;
+    uint32_t version = 1;
+    std::size_t validBytes = 0;  ///< Header and valid frames.
+    std::vector<WalEntry> entries;
+};
+
+/// Frames each scan worker takes at least; smaller logs scan inline.
+constexpr std::size_t kFramesPerScanWorker = 4096;
+
+/// Map @p paths and decode their entries.
+///
+/// Frame boundaries are walked sequentially (only the 4-byte sizes are
+/// read); checksums are then verified and entries decoded in parallel
+/// chunks on up to @p threads threads (0: one per available CPU).  Each
+/// file keeps the frames before its first truncated or corrupt one and
+/// is trimmed there, or entries appended after it would be unreachable
+/// on the next open.
+GameResult<std::vector<ScannedSegment>> scanSegments(
+    const std::vector<std::filesystem::path>& paths, std::size_t threads) {
+    using ScanResult = GameResult<std::vector<ScannedSegment>>;
+
+    struct Frame {
+        std::size_t file;
+        const uint8_t* body;  // After the size field.
+        uint32_t totalSize;   // Body and CRC.
+    };
+
+    std::vector<MappedFile> maps(paths.size());
+    std::vector<ScannedSegment> results(paths.size());
+    std::vector<Frame> frames;
+
+    for (std::size_t f = 0; f < paths.size(); ++f) {
+        auto& result = results[f];
+        result.path = paths[f];
+        if (!maps[f].map(paths[f])) {
+            return ScanResult::err(
+                GameError(ErrorCode::WalReadFailed, "cannot open WAL file for reading"));
+        }
+
+        const uint8_t* data = maps[f].data();
+        std::size_t size = maps[f].size();
+        std::size_t offset = 0;
+        if (size >= kSegmentHeaderSize && std::memcmp(data, kSegmentMagic.data(), 4) == 0) {
+            std::memcpy(&result.version, data + 4, 4);
+            if (result.version != kSegmentVersion) {
+                return ScanResult::err(GameError(
+                    ErrorCode::WalCorrupted,
+                    "unsupported WAL segment version " + std::to_string(result.version)));
+            }
+            offset = kSegmentHeaderSize;
+        }
+        result.validBytes = offset;
+
+        while (size - offset >= 4) {
+            uint32_t totalSize = 0;
+            std::memcpy(&totalSize, data + offset, 4);
+            if (totalSize < 4 || totalSize > size - offset - 4) {
+                break;  // Corrupted size or truncated entry.
+            }
+            frames.push_back({f, data + offset + 4, totalSize});
+            offset += 4 + totalSize;
+        }
+    }
+
+    // Verify and decode.  ok[i] is a byte, not a vector<bool> bit, so
+    // workers never share a written word.
+    std::vector<WalEntry> decoded(frames.size());
+    std::vector<uint8_t> ok(frames.size(), 0);
+    auto decode = [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            const auto& frame = frames[i];
+            auto bodySize = frame.totalSize - 4u;
+            uint32_t storedCrc = 0;
+            std::memcpy(&storedCrc, frame.body + bodySize, 4);
+            uint32_t computedCrc = results[frame.file].version == 1
+                                       ? crc32(frame.body, bodySize)
+                                       : crc32c(frame.body, bodySize);
+            ok[i] = storedCrc == computedCrc && deserializeEntry(frame.body, bodySize, decoded[i]);
+        }
+    };
+
+    if (threads == 0) {
+        threads = cgs::foundation::availableCpuCount();
+    }
+    auto workers = std::min(threads, frames.size() / kFramesPerScanWorker);
+    if (workers <= 1) {
+        decode(0, frames.size());
+    } else {
+        std::vector<std::thread> pool;
+        pool.reserve(workers - 1);
+        auto chunk = (frames.size() + workers - 1) / workers;
+        for (std::size_t w = 1; w < workers; ++w) {
+            pool.emplace_back(decode, w * chunk, std::min(frames.size(), (w + 1) * chunk));
+        }
+        decode(0, std::min(frames.size(), chunk));
+        for (auto& worker : pool) {
+            worker.join();
+        }
+    }
+
+    // Keep each file's valid prefix, in order.
+    std::vector<bool> broken(paths.size(), false);
+    for (std::size_t i = 0; i < frames.size(); ++i) {
+        const auto f = frames[i].file;
+        if (broken[f] || !ok[i]) {
+            broken[f] = true;
+            continue;
+        }
+        results[f].validBytes += 4 + frames[i].totalSize;
+        results[f].entries.push_back(std::move(decoded[i]));
+    }
+
+    for (std::size_t f = 0; f < paths.size(); ++f) {
+        auto fileSize = maps[f].size();
+        maps[f].unmap();
+        if (fileSize > results[f].validBytes) {
+            std::error_code ec;
+            std::filesystem::resize_file(paths[f], results[f].validBytes, ec);
+            if (ec) {
+                return ScanResult::err(GameError(
+                    ErrorCode::WalCorrupted, "cannot trim corrupt WAL tail: " + ec.message()));
+            }
+        }
+    }
+    return ScanResult::ok(std::move(results));
+}
+
 }  // namespace
 
 // -- Impl -------------------------------------------------------------------
 
 struct WriteAheadLog::Impl {
     WalConfig config;
-    mutable std::mutex mutex;
-    std::ofstream writer;
+    mutable cgs::foundation::ProfiledMutex mutex{"wal.log"};
+    WalFile writer;  // Open on segments.back(), if any.
+    detail::IoRing ring;  // Active with useIoUring where supported; leader-only.
     bool open = false;
     uint64_t nextSequence = 1;
-    std::size_t currentFileSize = 0;
     std::size_t totalEntries = 0;
 
-    // In-memory index of entries for replay/truncation.
-    // Each entry: (sequence, file offset within the active WAL file)
+    /// One log file holding entries [firstSequence, lastSequence].  The
+    /// range ends where the next segment's begins; an empty segment has
+    /// lastSequence == firstSequence - 1.  size includes the header.
+    struct Segment {
+        uint64_t firstSequence;
+        uint64_t lastSequence;
+        std::size_t size;
+        std::filesystem::path path;
+        uint32_t version = kSegmentVersion;
+
+        [[nodiscard]] bool empty() const { return lastSequence < firstSequence; }
+    };
+    std::deque<Segment> segments;  // Oldest first; appends go to back().
+
+    // In-memory index of entries for replay/truncation, in sequence order.
     // For simplicity, we keep entries in memory. Production would use
     // a file-based index, but for the game server's WAL this is practical
     // since entries are truncated after each snapshot (every ~60s).
@@ -131,11 +469,27 @@ struct WriteAheadLog::Impl {
         uint64_t sequence;
         WalEntry entry;
     };
-    std::vector<IndexEntry> entries;
+    std::deque<IndexEntry> entries;
+
+    /// Entries appended since the last group commit.  Appenders keep the
+    /// batch alive and wait for @c done; entries reach the index only
+    /// once synced.
+    struct Batch {
+        std::vector<uint8_t> frames;
+        std::vector<IndexEntry> entries;
+        bool done = false;
+        std::optional<GameError> error;
+    };
+    std::shared_ptr<Batch> pending;
+    bool syncing = false;            // A leader owns the file (gathering or syncing).
+    std::condition_variable_any filled;  // Pending batch reached groupCommitMaxBytes.
+    std::condition_variable_any synced;  // A group commit finished.
+    uint64_t syncs = 0;
 
-    explicit Impl(WalConfig cfg) : config(std::move(cfg)) {}
+    // Frames not yet written when syncOnWrite is off (already indexed).
+    std::vector<uint8_t> buffered;
 
-    std::filesystem::path walFilePath() const { return config.directory / "wal.bin"; }
+    explicit Impl(WalConfig cfg) : config(std::move(cfg)) {}
 
     GameResult<void> ensureDirectory() {
         std::error_code ec;
@@ -147,67 +501,196 @@ struct WriteAheadLog::Impl {
         return GameResult<void>::ok();
     }
 
-    /// Re-read existing WAL file to rebuild in-memory index.
-    GameResult<void> rebuildIndex() {
-        auto path = walFilePath();
-        if (!std::filesystem::exists(path)) {
-            return GameResult<void>::ok();
-        }
-
-        std::ifstream reader(path, std::ios::binary);
-        if (!reader) {
+    /// Create the segment starting at @p firstSequence and append to it.
+    GameResult<void> startSegment(uint64_t firstSequence) {
+        writer.close();
+        auto path = config.directory / segmentFileName(firstSequence);
+        std::array<uint8_t, kSegmentHeaderSize> header{};
+        std::memcpy(header.data(), kSegmentMagic.data(), 4);
+        std::memcpy(header.data() + 4, &kSegmentVersion, 4);
+        if (!writer.open(path, /*truncate=*/true) || !writer.write(header.data(), header.size())) {
             return GameResult<void>::err(
-                GameError(ErrorCode::WalReadFailed, "cannot open WAL file for reading"));
+                GameError(ErrorCode::WalWriteFailed, "cannot create WAL segment"));
+        }
+        if (config.preallocateSegments) {
+            writer.preallocate(config.maxFileSize);
+        }
+        if (config.syncOnWrite) {
+            syncDirectory(config.directory);
         }
+        segments.push_back({firstSequence, firstSequence - 1, header.size(), std::move(path)});
+        return GameResult<void>::ok();
+    }
 
-        entries.clear();
-        totalEntries = 0;
-        uint64_t maxSeq = 0;
+    /// Roll over to a new segment if @p bytes starting at @p firstSequence
+    /// do not fit in the current one (see fits()).
+    GameResult<void> reserve(uint64_t firstSequence, std::size_t bytes) {
+        return fits(bytes) ? GameResult<void>::ok() : startSegment(firstSequence);
+    }
 
-        while (reader.good() && !reader.eof()) {
-            // Read total_size
-            uint32_t totalSize = 0;
-            reader.read(reinterpret_cast<char*>(&totalSize), 4);
-            if (reader.gcount() < 4) {
-                break;  // EOF or partial read
-            }
+    /// Whether @p bytes go in the current segment.  A segment always
+    /// takes its first write, however large.
+    [[nodiscard]] bool fits(std::size_t bytes) const {
+        return !segments.empty() &&
+               (segments.back().empty() || segments.back().size + bytes <= config.maxFileSize);
+    }
 
-            if (totalSize < 4) {
-                break;  // Corrupted: size too small for CRC
-            }
+    /// Write and sync the pending batch as group-commit leader.
+    ///
+    /// Called with @p lock held and no sync in progress; the write and
+    /// sync run unlocked so later appends can queue the next batch.
+    void commitPending(std::unique_lock<cgs::foundation::ProfiledMutex>& lock) {
+        syncing = true;
+        auto batch = std::move(pending);
+        pending.reset();
+
+        auto reserved = reserve(batch->entries.front().sequence, batch->frames.size());
+        bool ok = reserved.hasValue();
+        if (ok) {
+            lock.unlock();
+            ok = writeSynced(batch->frames.data(), batch->frames.size());
+            lock.lock();
+            ++syncs;
+        }
 
-            // Read payload + CRC
-            std::vector<uint8_t> buf(totalSize);
-            reader.read(reinterpret_cast<char*>(buf.data()),
-                        static_cast<std::streamsize>(totalSize));
-            if (static_cast<std::size_t>(reader.gcount()) < totalSize) {
-                break;  // Truncated entry
+        if (ok) {
+            auto& segment = segments.back();
+            segment.size += batch->frames.size();
+            segment.lastSequence = batch->entries.back().sequence;
+            totalEntries += batch->entries.size();
+            std::move(batch->entries.begin(), batch->entries.end(), std::back_inserter(entries));
+        } else {
+            if (reserved.hasValue()) {
+                writer.truncate(segments.back().size);
             }
+            batch->error = GameError(ErrorCode::WalWriteFailed, "failed to write WAL entries");
+        }
+        batch->done = true;
+        syncing = false;
+        synced.notify_all();
+    }
 
-            // Verify CRC (last 4 bytes)
-            uint32_t storedCrc = 0;
-            std::memcpy(&storedCrc, buf.data() + totalSize - 4, 4);
-            uint32_t computedCrc = crc32(buf.data(), totalSize - 4);
+    /// Append @p size bytes and fdatasync them.  Through the ring, the
+    /// write and the sync linked behind it go to the kernel in one call.
+    bool writeSynced(const uint8_t* data, std::size_t size) {
+        if (ring.active()) {
+            return ring.write(writer.fd(), data, size, detail::IoRing::kAtPosition) &&
+                   ring.complete(writer.fd(), detail::IoRing::Sync::Data);
+        }
+        return writer.write(data, size) && writer.sync();
+    }
 
-            if (storedCrc != computedCrc) {
-                // Corrupted entry — stop replaying here.
+    /// Wait out a running group commit, then commit anything still
+    /// queued and write out buffered frames, so the segments hold every
+    /// appended entry.
+    GameResult<void> drain(std::unique_lock<cgs::foundation::ProfiledMutex>& lock) {
+        auto result = GameResult<void>::ok();
+        for (;;) {
+            synced.wait(lock, [this] { return !syncing; });
+            if (!pending) {
                 break;
             }
+            auto batch = pending;
+            commitPending(lock);
+            if (batch->error) {
+                result = GameResult<void>::err(*batch->error);
+            }
+        }
+        auto written = writeBuffered();
+        return result.hasError() ? result : written;
+    }
 
-            // Deserialize entry
-            WalEntry entry;
-            if (!deserializeEntry(buf.data(), totalSize - 4, entry)) {
-                break;
+    GameResult<void> writeBuffered() {
+        if (buffered.empty()) {
+            return GameResult<void>::ok();
+        }
+        bool ok = writer.write(buffered.data(), buffered.size());
+        buffered.clear();
+        if (!ok) {
+            return GameResult<void>::err(
+                GameError(ErrorCode::WalWriteFailed, "failed to write WAL entry"));
+        }
+        return GameResult<void>::ok();
+    }
+
+    /// Rename a single-file log from before segmentation to a segment.
+    GameResult<void> adoptLegacyFile() {
+        auto legacy = config.directory / kLegacyFileName;
+        std::error_code ec;
+        if (!std::filesystem::exists(legacy, ec)) {
+            return GameResult<void>::ok();
+        }
+
+        auto scanned = scanSegments({legacy}, config.replayThreads);
+        if (scanned.hasError()) {
+            return GameResult<void>::err(scanned.error());
+        }
+        const auto& frames = scanned.value().front().entries;
+        if (frames.empty()) {
+            std::filesystem::remove(legacy, ec);
+        } else {
+            std::filesystem::rename(
+                legacy, config.directory / segmentFileName(frames.front().sequence), ec);
+        }
+        if (ec) {
+            return GameResult<void>::err(
+                GameError(ErrorCode::WalReadFailed, "cannot adopt WAL file: " + ec.message()));
+        }
+        return GameResult<void>::ok();
+    }
+
+    /// Re-read existing segments to rebuild the in-memory index.
+    GameResult<void> rebuildIndex() {
+        entries.clear();
+        segments.clear();
+        totalEntries = 0;
+
+        auto adopted = adoptLegacyFile();
+        if (adopted.hasError()) {
+            return adopted;
+        }
+
+        std::vector<std::pair<uint64_t, std::filesystem::path>> files;
+        std::error_code ec;
+        for (const auto& item : std::filesystem::directory_iterator(config.directory, ec)) {
+            if (auto first = parseSegmentFileName(item.path().filename().string())) {
+                files.emplace_back(*first, item.path());
             }
+        }
+        if (ec) {
+            return GameResult<void>::err(
+                GameError(ErrorCode::WalReadFailed, "cannot list WAL segments: " + ec.message()));
+        }
+        std::sort(files.begin(), files.end());
 
-            maxSeq = std::max(maxSeq, entry.sequence);
-            entries.push_back({entry.sequence, std::move(entry)});
-            ++totalEntries;
+        std::vector<std::filesystem::path> paths;
+        paths.reserve(files.size());
+        for (const auto& file : files) {
+            paths.push_back(file.second);
+        }
+        auto scanned = scanSegments(paths, config.replayThreads);
+        if (scanned.hasError()) {
+            return GameResult<void>::err(scanned.error());
         }
 
-        nextSequence = maxSeq + 1;
-        currentFileSize = static_cast<std::size_t>(std::filesystem::file_size(path));
+        auto& results = scanned.value();
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            auto& result = results[i];
+            const auto first = files[i].first;
+            if (result.entries.empty() && i + 1 < results.size()) {
+                std::filesystem::remove(result.path, ec);  // Empty and no longer active.
+                continue;
+            }
+            auto last = result.entries.empty() ? first - 1 : result.entries.back().sequence;
+            segments.push_back({first, last, result.validBytes, result.path, result.version});
+            totalEntries += result.entries.size();
+            for (auto& entry : result.entries) {
+                auto seq = entry.sequence;
+                entries.push_back({seq, std::move(entry)});
+            }
+        }
 
+        nextSequence = segments.empty() ? 1 : segments.back().lastSequence + 1;
         return GameResult<void>::ok();
     }
 };
@@ -235,16 +718,29 @@ GameResult<void> WriteAheadLog::open() {
     if (dirResult.hasError()) {
         return dirResult;
     }
+    if (impl_->config.useIoUring && !impl_->ring.active()) {
+        (void)impl_->ring.init();
+    }
 
-    // Rebuild index from existing WAL file.
+    // Rebuild index from existing segments.
     auto indexResult = impl_->rebuildIndex();
     if (indexResult.hasError()) {
         return indexResult;
     }
 
-    // Open file for appending.
-    impl_->writer.open(impl_->walFilePath(), std::ios::binary | std::ios::app);
-    if (!impl_->writer) {
+    // Append to the newest segment, or start one: there is none, or the
+    // newest has an older format (replaced if empty).
+    auto& segments = impl_->segments;
+    if (!segments.empty() && segments.back().version != kSegmentVersion &&
+        segments.back().empty()) {
+        std::error_code ec;
+        std::filesystem::remove(segments.back().path, ec);
+        segments.pop_back();
+    }
+    bool opened = segments.empty() || segments.back().version != kSegmentVersion
+                      ? impl_->startSegment(impl_->nextSequence).hasValue()
+                      : impl_->writer.open(segments.back().path);
+    if (!opened) {
         return GameResult<void>::err(
             GameError(ErrorCode::WalWriteFailed, "cannot open WAL file for writing"));
     }
@@ -254,63 +750,105 @@ GameResult<void> WriteAheadLog::open() {
 }
 
 void WriteAheadLog::close() {
-    std::lock_guard lock(impl_->mutex);
+    std::unique_lock lock(impl_->mutex);
 
     if (!impl_->open) {
         return;
     }
 
-    if (impl_->writer.is_open()) {
-        impl_->writer.flush();
-        impl_->writer.close();
-    }
-
+    (void)impl_->drain(lock);
+    impl_->ring.shutdown();
+    impl_->writer.close();
     impl_->open = false;
 }
 
 // -- Write operations --------------------------------------------------------
 
 GameResult<uint64_t> WriteAheadLog::append(WalEntry entry) {
-    std::lock_guard lock(impl_->mutex);
+    return appendBatch(std::span<WalEntry>(&entry, 1));
+}
+
+GameResult<uint64_t> WriteAheadLog::appendBatch(std::span<WalEntry> entries) {
+    std::unique_lock lock(impl_->mutex);
 
     if (!impl_->open) {
         return GameResult<uint64_t>::err(
             GameError(ErrorCode::PersistenceNotStarted, "WAL is not open"));
     }
+    if (entries.empty()) {
+        return GameResult<uint64_t>::ok(impl_->nextSequence);
+    }
 
-    // Assign sequence and timestamp.
-    entry.sequence = impl_->nextSequence++;
-    entry.timestampUs = nowMicros();
-
-    // Serialize entry body.
-    auto body = serializeEntry(entry);
-
-    // Compute CRC over body.
-    uint32_t checksum = crc32(body.data(), body.size());
-
-    // Total frame: [4: totalSize] [body] [4: crc]
-    uint32_t totalSize = static_cast<uint32_t>(body.size() + 4);
+    // Assign sequences and timestamps.
+    const uint64_t first = impl_->nextSequence;
+    const uint64_t timestampUs = nowMicros();
+    for (auto& entry : entries) {
+        entry.sequence = impl_->nextSequence++;
+        entry.timestampUs = timestampUs;
+    }
 
-    impl_->writer.write(reinterpret_cast<const char*>(&totalSize), 4);
-    impl_->writer.write(reinterpret_cast<const char*>(body.data()),
-                        static_cast<std::streamsize>(body.size()));
-    impl_->writer.write(reinterpret_cast<const char*>(&checksum), 4);
+    if (!impl_->config.syncOnWrite) {
+        for (auto& entry : entries) {
+            uint64_t seq = entry.sequence;
+            auto bytes = frameSize(entry);
+            if (!impl_->fits(bytes)) {
+                auto written = impl_->writeBuffered();
+                auto started = written.hasValue() ? impl_->startSegment(seq) : written;
+                if (started.hasError()) {
+                    return GameResult<uint64_t>::err(started.error());
+                }
+            }
 
-    if (!impl_->writer) {
-        return GameResult<uint64_t>::err(
-            GameError(ErrorCode::WalWriteFailed, "failed to write WAL entry"));
+            auto& segment = impl_->segments.back();
+            segment.size += appendFrame(impl_->buffered, entry);
+            segment.lastSequence = seq;
+            impl_->entries.push_back({seq, std::move(entry)});
+            ++impl_->totalEntries;
+
+            if (impl_->buffered.size() >= kWriteBufferBytes) {
+                auto written = impl_->writeBuffered();
+                if (written.hasError()) {
+                    return GameResult<uint64_t>::err(written.error());
+                }
+            }
+        }
+        return GameResult<uint64_t>::ok(first);
     }
 
-    if (impl_->config.syncOnWrite) {
-        impl_->writer.flush();
+    // Join the pending group commit.
+    if (!impl_->pending) {
+        impl_->pending = std::make_shared<Impl::Batch>();
+    }
+    auto batch = impl_->pending;
+    for (auto& entry : entries) {
+        uint64_t seq = entry.sequence;
+        appendFrame(batch->frames, entry);
+        batch->entries.push_back({seq, std::move(entry)});
+    }
+    if (impl_->syncing && batch->frames.size() >= impl_->config.groupCommitMaxBytes) {
+        impl_->filled.notify_one();
     }
 
-    uint64_t seq = entry.sequence;
-    impl_->currentFileSize += 4 + body.size() + 4;
-    impl_->entries.push_back({seq, std::move(entry)});
-    ++impl_->totalEntries;
+    // The first appender to find no sync running leads: it optionally
+    // waits for more entries, then commits the whole batch.
+    while (!batch->done) {
+        if (impl_->syncing) {
+            impl_->synced.wait(lock);
+            continue;
+        }
+        if (impl_->config.groupCommitDelay.count() > 0) {
+            impl_->syncing = true;
+            impl_->filled.wait_for(lock, impl_->config.groupCommitDelay, [&] {
+                return batch->frames.size() >= impl_->config.groupCommitMaxBytes;
+            });
+        }
+        impl_->commitPending(lock);
+    }
 
-    return GameResult<uint64_t>::ok(seq);
+    if (batch->error) {
+        return GameResult<uint64_t>::err(*batch->error);
+    }
+    return GameResult<uint64_t>::ok(first);
 }
 
 // -- Read operations ---------------------------------------------------------
@@ -330,75 +868,111 @@ GameResult<uint64_t> WriteAheadLog::replay(uint64_t afterSequence,
     return GameResult<uint64_t>::ok(count);
 }
 
+GameResult<uint64_t> WriteAheadLog::replayCompacted(
+    uint64_t afterSequence,
+    const std::vector<WalOperation>& latestOnly,
+    std::function<void(const WalEntry&)> callback) const {
+    std::lock_guard lock(impl_->mutex);
+
+    // Newest first: mark every compacted entry a later one supersedes.
+    // seen[k] holds the players already written by operation latestOnly[k].
+    std::vector<bool> superseded(impl_->entries.size(), false);
+    std::vector<std::unordered_set<uint64_t>> seen(latestOnly.size());
+    for (std::size_t i = impl_->entries.size(); i-- > 0;) {
+        const auto& idx = impl_->entries[i];
+        if (idx.sequence <= afterSequence) {
+            break;
+        }
+        auto op = std::find(latestOnly.begin(), latestOnly.end(), idx.entry.operation);
+        if (op == latestOnly.end()) {
+            continue;
+        }
+        auto& players = seen[static_cast<std::size_t>(op - latestOnly.begin())];
+        if (!players.insert(idx.entry.playerId.value()).second) {
+            superseded[i] = true;
+        }
+    }
+
+    uint64_t count = 0;
+    for (std::size_t i = 0; i < impl_->entries.size(); ++i) {
+        const auto& idx = impl_->entries[i];
+        if (idx.sequence > afterSequence && !superseded[i]) {
+            callback(idx.entry);
+            ++count;
+        }
+    }
+
+    return GameResult<uint64_t>::ok(count);
+}
+
 // -- Maintenance -------------------------------------------------------------
 
 GameResult<void> WriteAheadLog::truncateBefore(uint64_t beforeSequence) {
-    std::lock_guard lock(impl_->mutex);
+    std::unique_lock lock(impl_->mutex);
 
     if (!impl_->open) {
         return GameResult<void>::err(
             GameError(ErrorCode::PersistenceNotStarted, "WAL is not open"));
     }
 
-    // Remove entries from in-memory index.
-    auto it = std::remove_if(
-        impl_->entries.begin(), impl_->entries.end(), [beforeSequence](const Impl::IndexEntry& e) {
-            return e.sequence <= beforeSequence;
-        });
-    auto removed = static_cast<std::size_t>(std::distance(it, impl_->entries.end()));
-    impl_->entries.erase(it, impl_->entries.end());
-    impl_->totalEntries -= removed;
-
-    // Rewrite the WAL file with remaining entries.
-    impl_->writer.close();
+    // Queued entries may fall in the range; get them into their segment.
+    (void)impl_->drain(lock);
 
-    auto path = impl_->walFilePath();
-    std::ofstream rewriter(path, std::ios::binary | std::ios::trunc);
-    if (!rewriter) {
-        // Re-open in append mode even on failure.
-        impl_->writer.open(path, std::ios::binary | std::ios::app);
-        return GameResult<void>::err(
-            GameError(ErrorCode::WalTruncateFailed, "failed to rewrite WAL after truncation"));
+    // Remove entries from in-memory index.
+    while (!impl_->entries.empty() && impl_->entries.front().sequence <= beforeSequence) {
+        impl_->entries.pop_front();
+        --impl_->totalEntries;
     }
 
-    std::size_t newFileSize = 0;
-    for (const auto& idx : impl_->entries) {
-        auto body = serializeEntry(idx.entry);
-        uint32_t checksum = crc32(body.data(), body.size());
-        uint32_t totalSize = static_cast<uint32_t>(body.size() + 4);
-
-        rewriter.write(reinterpret_cast<const char*>(&totalSize), 4);
-        rewriter.write(reinterpret_cast<const char*>(body.data()),
-                       static_cast<std::streamsize>(body.size()));
-        rewriter.write(reinterpret_cast<const char*>(&checksum), 4);
-        newFileSize += 4 + body.size() + 4;
+    // Unlink segments whose whole range is covered.  Entries before
+    // beforeSequence in a partly covered segment stay on disk until the
+    // segment is; replay after a snapshot skips them by sequence.
+    bool removedActive = false;
+    while (!impl_->segments.empty() && impl_->segments.front().lastSequence <= beforeSequence) {
+        if (impl_->segments.size() == 1) {
+            if (impl_->segments.front().empty()) {
+                break;  // Already an empty active segment.
+            }
+            impl_->writer.close();
+            removedActive = true;
+        }
+        std::error_code ec;
+        std::filesystem::remove(impl_->segments.front().path, ec);
+        if (ec) {
+            if (removedActive) {
+                (void)impl_->writer.open(impl_->segments.front().path);
+            }
+            return GameResult<void>::err(GameError(
+                ErrorCode::WalTruncateFailed, "failed to remove WAL segment: " + ec.message()));
+        }
+        impl_->segments.pop_front();
     }
 
-    rewriter.flush();
-    rewriter.close();
-
-    impl_->currentFileSize = newFileSize;
-
-    // Re-open in append mode.
-    impl_->writer.open(path, std::ios::binary | std::ios::app);
-    if (!impl_->writer) {
-        return GameResult<void>::err(
-            GameError(ErrorCode::WalWriteFailed, "failed to re-open WAL after truncation"));
+    // Keep an (empty) active segment: its name carries the next sequence
+    // across a restart.
+    if (removedActive) {
+        auto started = impl_->startSegment(impl_->nextSequence);
+        if (started.hasError()) {
+            return started;
+        }
     }
 
     return GameResult<void>::ok();
 }
 
 GameResult<void> WriteAheadLog::flush() {
-    std::lock_guard lock(impl_->mutex);
+    std::unique_lock lock(impl_->mutex);
 
     if (!impl_->open) {
         return GameResult<void>::err(
             GameError(ErrorCode::PersistenceNotStarted, "WAL is not open"));
     }
 
-    impl_->writer.flush();
-    if (!impl_->writer) {
+    auto drained = impl_->drain(lock);
+    if (drained.hasError()) {
+        return drained;
+    }
+    if (!impl_->writer.sync()) {
         return GameResult<void>::err(GameError(ErrorCode::WalWriteFailed, "WAL flush failed"));
     }
 
@@ -417,9 +991,24 @@ std::size_t WriteAheadLog::entryCount() const {
     return impl_->totalEntries;
 }
 
+std::size_t WriteAheadLog::segmentCount() const {
+    std::lock_guard lock(impl_->mutex);
+    return impl_->segments.size();
+}
+
 bool WriteAheadLog::isOpen() const {
     std::lock_guard lock(impl_->mutex);
     return impl_->open;
 }
 
+bool WriteAheadLog::ioUringActive() const {
+    std::lock_guard lock(impl_->mutex);
+    return impl_->ring.active();
+}
+
+uint64_t WriteAheadLog::syncCount() const {
+    std::lock_guard lock(impl_->mutex);
+    return impl_->syncs;
+}
+
 }  // namespace cgs::service
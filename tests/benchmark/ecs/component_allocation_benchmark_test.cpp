@@ -0,0 +1,215 @@
+/// @file component_allocation_benchmark_test.cpp
+/// @brief Heap allocations per combat tick for variable-length components.
+///
+/// NPCs in combat continuously gain and lose auras and threat sources, and
+/// a share of them dies and respawns every tick, which recreates their
+/// components.  With std::vector fields every respawned NPC pays fresh heap
+/// blocks; with SmallVector fields the common case stays inside the
+/// component.
+///
+/// Allocations are counted by replacing the global operator new in this
+/// test binary.
+///
+/// Acceptance criteria:
+///   - Steady-state CombatSystem ticks perform no heap allocations.
+///   - The SmallVector workload allocates less than the std::vector one.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <vector>
+
+#include "cgs/ecs/component_storage.hpp"
+#include "cgs/ecs/small_vector.hpp"
+#include "cgs/game/combat_components.hpp"
+#include "cgs/game/combat_system.hpp"
+#include "cgs/game/components.hpp"
+
+using namespace cgs::ecs;
+using namespace cgs::game;
+
+namespace {
+
+std::atomic<std::size_t> gAllocations{0};
+
+}  // anonymous namespace
+
+// Counting replacements of the global allocation functions.
+void* operator new(std::size_t size) {
+    gAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+// Benchmark parameters
+constexpr uint32_t kNpcCount = 1000;
+constexpr uint32_t kAttackersPerNpc = 3;
+constexpr uint32_t kRespawnPeriod = 20;  // every NPC respawns once per 20 ticks
+constexpr int kTickIterations = 200;
+constexpr int kWarmupTicks = 20;
+constexpr float kDeltaTime = 0.05f;
+
+/// Periodic aura refreshed by each attacker every tick.
+AuraInstance makeDot(uint32_t attacker) {
+    AuraInstance aura;
+    aura.auraId = 100 + attacker;
+    aura.caster = Entity(kNpcCount + attacker, 0);
+    aura.duration = 3 * kDeltaTime;
+    aura.remainingTime = aura.duration;
+    aura.tickInterval = kDeltaTime;
+    aura.tickTimer = kDeltaTime;
+    aura.tickDamage = 1;
+    return aura;
+}
+
+/// Minimal NPC combat state parameterized on the container type.
+template <typename Auras, typename Threats>
+struct NpcCombatState {
+    Auras auras;
+    Threats threats;
+};
+
+/// Run the same aura/threat/respawn pattern on both container types.
+///
+/// @return Allocations per tick after warm-up.
+template <typename State>
+double runSyntheticTicks() {
+    ComponentStorage<State> npcs;
+    for (uint32_t i = 0; i < kNpcCount; ++i) {
+        npcs.Add(Entity(i, 0));
+    }
+
+    std::size_t measured = 0;
+    for (int tick = 0; tick < kTickIterations; ++tick) {
+        const std::size_t before = gAllocations.load(std::memory_order_relaxed);
+        const auto phase = static_cast<uint32_t>(tick) % kRespawnPeriod;
+
+        for (uint32_t i = 0; i < kNpcCount; ++i) {
+            const Entity npc(i, 0);
+            if (i % kRespawnPeriod == phase) {
+                npcs.Remove(npc);
+                npcs.Add(npc);
+            }
+            auto& state = npcs.Get(npc);
+            for (auto& aura : state.auras) {
+                aura.remainingTime -= kDeltaTime;
+            }
+            state.auras.erase(std::remove_if(state.auras.begin(), state.auras.end(),
+                                             [](const AuraInstance& a) {
+                                                 return a.remainingTime <= 0.0f;
+                                             }),
+                              state.auras.end());
+            state.auras.push_back(makeDot(static_cast<uint32_t>(tick) % kAttackersPerNpc));
+            if (state.threats.size() < kAttackersPerNpc) {
+                state.threats.push_back({Entity(kNpcCount + i, 0), 1.0f});
+            }
+            std::sort(state.threats.begin(), state.threats.end(),
+                      [](const ThreatEntry& a, const ThreatEntry& b) {
+                          return a.threat > b.threat;
+                      });
+        }
+
+        if (tick >= kWarmupTicks) {
+            measured += gAllocations.load(std::memory_order_relaxed) - before;
+        }
+    }
+    return static_cast<double>(measured) / (kTickIterations - kWarmupTicks);
+}
+
+}  // anonymous namespace
+
+// ===========================================================================
+// CombatSystem tick with the shipped components
+// ===========================================================================
+
+TEST(ComponentAllocationBenchmark, CombatTickAllocatesNothingInSteadyState) {
+    ComponentStorage<SpellCast> casts;
+    ComponentStorage<AuraHolder> auras;
+    ComponentStorage<DamageEvent> damages;
+    ComponentStorage<Stats> stats;
+    ComponentStorage<ThreatList> threats;
+    CombatSystem system(casts, auras, damages, stats, threats);
+
+    const auto spawn = [&](Entity npc) {
+        auto& s = stats.Add(npc);
+        s.maxHealth = 1'000'000;
+        s.health = s.maxHealth;
+        auras.Add(npc);
+        threats.Add(npc);
+    };
+    for (uint32_t i = 0; i < kNpcCount; ++i) {
+        spawn(Entity(i, 0));
+    }
+
+    std::size_t measured = 0;
+    for (int tick = 0; tick < kTickIterations; ++tick) {
+        const std::size_t before = gAllocations.load(std::memory_order_relaxed);
+        const auto phase = static_cast<uint32_t>(tick) % kRespawnPeriod;
+
+        for (uint32_t i = 0; i < kNpcCount; ++i) {
+            const Entity npc(i, 0);
+            if (i % kRespawnPeriod == phase) {
+                stats.Remove(npc);
+                auras.Remove(npc);
+                threats.Remove(npc);
+                spawn(npc);
+            }
+            for (uint32_t a = 0; a < kAttackersPerNpc; ++a) {
+                auras.Get(npc).AddOrStack(makeDot(a));
+                threats.Get(npc).AddThreat(Entity(kNpcCount + a, 0), 1.0f);
+            }
+        }
+        system.Execute(kDeltaTime);
+
+        if (tick >= kWarmupTicks) {
+            measured += gAllocations.load(std::memory_order_relaxed) - before;
+        }
+    }
+
+    const double perTick = static_cast<double>(measured) / (kTickIterations - kWarmupTicks);
+    std::cout << "\n=== Combat Tick Allocations (" << kNpcCount << " NPCs) ===\n"
+              << "  AuraHolder inline capacity: " << AuraHolder::kInlineAuras << "\n"
+              << "  ThreatList inline capacity: " << ThreatList::kInlineEntries << "\n"
+              << "  Allocations per tick:       " << perTick << "\n";
+
+    EXPECT_EQ(measured, 0u) << "Steady-state combat ticks should not touch the heap";
+}
+
+// ===========================================================================
+// SmallVector vs std::vector on the same workload
+// ===========================================================================
+
+TEST(ComponentAllocationBenchmark, InlineStorageAllocatesLessThanStdVector) {
+    using VectorState = NpcCombatState<std::vector<AuraInstance>, std::vector<ThreatEntry>>;
+    using InlineState = NpcCombatState<SmallVector<AuraInstance, AuraHolder::kInlineAuras>,
+                                       SmallVector<ThreatEntry, ThreatList::kInlineEntries>>;
+
+    const double vectorPerTick = runSyntheticTicks<VectorState>();
+    const double inlinePerTick = runSyntheticTicks<InlineState>();
+
+    std::cout << std::fixed << std::setprecision(1) << "\n=== Allocations per Tick ("
+              << kNpcCount << " NPCs, 1/" << kRespawnPeriod << " respawning) ===\n"
+              << "  std::vector:  " << vectorPerTick << "\n"
+              << "  SmallVector:  " << inlinePerTick << "\n";
+
+    EXPECT_LT(inlinePerTick, vectorPerTick);
+    EXPECT_EQ(inlinePerTick, 0.0);
+}
@@ -15,12 +15,19 @@
 #include <iomanip>
 #include <iostream>
 #include <numeric>
+#include <random>
 #include <string>
+#include <tuple>
+#include <utility>
 #include <vector>
 
+#include "cgs/ecs/archetype_storage.hpp"
 #include "cgs/ecs/component_storage.hpp"
 #include "cgs/ecs/entity.hpp"
 #include "cgs/ecs/entity_manager.hpp"
+#include "cgs/ecs/owning_group.hpp"
+#include "cgs/ecs/query.hpp"
+#include "cgs/ecs/soa_component_storage.hpp"
 #include "cgs/game/components.hpp"
 
 using namespace cgs::ecs;
@@ -33,6 +40,77 @@ constexpr int kEntityCount = 10000;
 constexpr int kIterations = 100;
 constexpr double kMaxIterationMs = 5.0; // SRS-NFR-003: ≤5ms for 10K entities
 
+/// One cache line of component data; distinct per @p N so a query
+/// can join several pools of it.
+template <std::size_t N>
+struct alignas(64) Payload {
+    float value[16] = {};
+};
+
+/// Median time of one pass (ms).
+template <typename Pass>
+double medianPassMs(Pass&& pass) {
+    std::vector<double> latencies;
+    latencies.reserve(static_cast<std::size_t>(kIterations));
+    for (int iter = 0; iter < kIterations; ++iter) {
+        auto start = std::chrono::high_resolution_clock::now();
+        pass();
+        auto end = std::chrono::high_resolution_clock::now();
+        latencies.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    std::sort(latencies.begin(), latencies.end());
+    return latencies[latencies.size() / 2];
+}
+
+struct LookaheadMedians {
+    double manual = 0.0;     ///< Get() per pool, no prefetch.
+    double lookahead = 0.0;  ///< Query::ForEach.
+    double byId = 0.0;       ///< Query::ForEach with OrderById().
+};
+
+/// Join one Payload pool per index in @p Is.  Pool 0 drives the join: it
+/// holds 90% of @p entities in shuffled order.  The other pools hold
+/// every entity in id order, i.e. they are co-sorted with each other
+/// but not with pool 0.
+template <std::size_t... Is>
+LookaheadMedians measureLookahead(const std::vector<Entity>& entities,
+                                  std::index_sequence<Is...>) {
+    std::tuple<ComponentStorage<Payload<Is>>...> pools;
+
+    std::vector<Entity> driving(entities.begin(),
+                                entities.end() - static_cast<std::ptrdiff_t>(entities.size() / 10));
+    std::mt19937 rng(42);
+    std::shuffle(driving.begin(), driving.end(), rng);
+    for (Entity e : driving) {
+        std::get<0>(pools).Add(e);
+    }
+    std::apply(
+        [&](auto& /*driver*/, auto&... rest) {
+            for (Entity e : entities) {
+                (rest.Add(e), ...);
+            }
+        },
+        pools);
+
+    auto touch = [](Entity, Payload<Is>&... payloads) { ((payloads.value[0] += 1.0f), ...); };
+
+    Query<Payload<Is>...> query(std::get<Is>(pools)...);
+    Query<Payload<Is>...> ordered(std::get<Is>(pools)...);
+    ordered.OrderById();
+    (void)query.Count();  // Build the match list before taking iterators.
+    const std::vector<Entity> matches(query.begin(), query.end());
+
+    LookaheadMedians medians;
+    medians.manual = medianPassMs([&] {
+        for (Entity e : matches) {
+            touch(e, std::get<Is>(pools).Get(e)...);
+        }
+    });
+    medians.lookahead = medianPassMs([&] { query.ForEach(touch); });
+    medians.byId = medianPassMs([&] { ordered.ForEach(touch); });
+    return medians;
+}
+
 } // anonymous namespace
 
 // ===========================================================================
@@ -211,6 +289,247 @@ TEST_F(ComponentStorageBenchmark, IterationThroughput10K) {
         << kEntityCount << " entities";
 }
 
+// ===========================================================================
+// Query Join: Sparse Set vs Archetype Chunks
+// ===========================================================================
+
+TEST_F(ComponentStorageBenchmark, QueryJoinSparseSetVsArchetype) {
+    ComponentStorage<Transform> transforms;
+    ComponentStorage<Movement> movements;
+    ArchetypeStorage<Transform, Movement> archetype;
+
+    // Insert in reverse order into the movement pool so the sparse-set join
+    // cannot rely on both dense arrays happening to share the same order.
+    for (int i = 0; i < kEntityCount; ++i) {
+        auto e = entities_[static_cast<std::size_t>(i)];
+        transforms.Add(e, Transform{{static_cast<float>(i), 0.0f, 0.0f}, {}, {}});
+        Movement mov;
+        mov.speed = 5.0f;
+        mov.direction = {1.0f, 0.0f, 0.0f};
+        archetype.Add(e, Transform{{static_cast<float>(i), 0.0f, 0.0f}, {}, {}}, mov);
+    }
+    for (int i = kEntityCount - 1; i >= 0; --i) {
+        Movement mov;
+        mov.speed = 5.0f;
+        mov.direction = {1.0f, 0.0f, 0.0f};
+        movements.Add(entities_[static_cast<std::size_t>(i)], std::move(mov));
+    }
+
+    Query<Transform, Movement> sparseQuery(transforms, movements);
+    Query<Transform, Movement> archetypeQuery(archetype);
+
+    auto integrate = [](Entity, Transform& t, Movement& m) {
+        constexpr float dt = 0.016f;
+        t.position.x += m.direction.x * m.speed * dt;
+        t.position.y += m.direction.y * m.speed * dt;
+        t.position.z += m.direction.z * m.speed * dt;
+    };
+
+    auto measure = [&](auto& query) {
+        std::vector<double> latencies;
+        latencies.reserve(static_cast<std::size_t>(kIterations));
+        for (int iter = 0; iter < kIterations; ++iter) {
+            auto start = std::chrono::high_resolution_clock::now();
+            query.ForEach(integrate);
+            auto end = std::chrono::high_resolution_clock::now();
+            latencies.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        }
+        std::sort(latencies.begin(), latencies.end());
+        return latencies;
+    };
+
+    auto sparse = measure(sparseQuery);
+    auto chunked = measure(archetypeQuery);
+
+    double sparseMedian = sparse[sparse.size() / 2];
+    double chunkedMedian = chunked[chunked.size() / 2];
+    double chunkedP99 =
+        chunked[static_cast<std::size_t>(static_cast<double>(chunked.size()) * 0.99)];
+
+    std::cout << "\n"
+              << "+-------------------------------------------------+\n"
+              << "|  Query<Transform, Movement> Join Benchmark       |\n"
+              << "+-------------------------------------------------+\n"
+              << "|  Entities:      " << std::setw(10) << kEntityCount
+              << "                    |\n"
+              << "|  Sparse set:    " << std::setw(10) << std::fixed
+              << std::setprecision(4) << sparseMedian << " ms (median)      |\n"
+              << "|  Archetype:     " << std::setw(10) << chunkedMedian
+              << " ms (median)      |\n"
+              << "|  Chunk rows:    " << std::setw(10)
+              << ArchetypeStorage<Transform, Movement>::kChunkCapacity
+              << "                    |\n"
+              << "+-------------------------------------------------+\n"
+              << std::endl;
+
+    EXPECT_LE(chunkedP99, kMaxIterationMs)
+        << "p99 archetype query time " << chunkedP99 << " ms exceeds " << kMaxIterationMs
+        << " ms for " << kEntityCount << " entities";
+}
+
+// ===========================================================================
+// Query Join vs Owning Group
+// ===========================================================================
+
+TEST_F(ComponentStorageBenchmark, QueryJoinVsOwningGroup) {
+    ComponentStorage<Transform> transforms;
+    ComponentStorage<Movement> movements;
+
+    // Every other entity moves, and the pools are filled in opposite orders.
+    for (int i = 0; i < kEntityCount; ++i) {
+        transforms.Add(entities_[static_cast<std::size_t>(i)]);
+    }
+    for (int i = kEntityCount - 1; i >= 0; i -= 2) {
+        Movement mov;
+        mov.speed = 5.0f;
+        mov.direction = {1.0f, 0.0f, 0.0f};
+        movements.Add(entities_[static_cast<std::size_t>(i)], std::move(mov));
+    }
+
+    auto integrate = [](Entity, Transform& t, Movement& m) {
+        t.position.x += m.direction.x * m.speed * 0.016f;
+    };
+
+    auto measure = [&](auto&& pass) {
+        std::vector<double> latencies;
+        latencies.reserve(static_cast<std::size_t>(kIterations));
+        for (int iter = 0; iter < kIterations; ++iter) {
+            auto start = std::chrono::high_resolution_clock::now();
+            pass();
+            auto end = std::chrono::high_resolution_clock::now();
+            latencies.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        }
+        std::sort(latencies.begin(), latencies.end());
+        return latencies;
+    };
+
+    Query<Transform, Movement> query(transforms, movements);
+    auto joined = measure([&] { query.ForEach(integrate); });
+
+    OwningGroup<Transform, Movement> group(transforms, movements);
+    auto grouped = measure([&] { group.ForEach(integrate); });
+
+    double joinedMedian = joined[joined.size() / 2];
+    double groupedMedian = grouped[grouped.size() / 2];
+    double groupedP99 =
+        grouped[static_cast<std::size_t>(static_cast<double>(grouped.size()) * 0.99)];
+
+    std::cout << "\n"
+              << "+-------------------------------------------------+\n"
+              << "|  Query Join vs Owning Group Benchmark            |\n"
+              << "+-------------------------------------------------+\n"
+              << "|  Members:       " << std::setw(10) << group.Size()
+              << "                    |\n"
+              << "|  Query join:    " << std::setw(10) << std::fixed
+              << std::setprecision(4) << joinedMedian << " ms (median)      |\n"
+              << "|  Owning group:  " << std::setw(10) << groupedMedian
+              << " ms (median)      |\n"
+              << "+-------------------------------------------------+\n"
+              << std::endl;
+
+    EXPECT_EQ(group.Size(), static_cast<std::size_t>(kEntityCount / 2));
+    EXPECT_LE(groupedP99, kMaxIterationMs)
+        << "p99 owning group pass " << groupedP99 << " ms exceeds " << kMaxIterationMs
+        << " ms for " << kEntityCount << " entities";
+}
+
+// ===========================================================================
+// Query Lookahead: Prefetching and Id Order, 3-5 Includes
+// ===========================================================================
+
+TEST_F(ComponentStorageBenchmark, QueryLookaheadThroughput10K) {
+    const LookaheadMedians three = measureLookahead(entities_, std::make_index_sequence<3>{});
+    const LookaheadMedians four = measureLookahead(entities_, std::make_index_sequence<4>{});
+    const LookaheadMedians five = measureLookahead(entities_, std::make_index_sequence<5>{});
+
+    auto row = [](const char* label, const LookaheadMedians& m) {
+        std::cout << "|  " << label << std::setw(9) << std::fixed << std::setprecision(4)
+                  << m.manual << std::setw(10) << m.lookahead << std::setw(10) << m.byId
+                  << " ms     |\n";
+    };
+
+    std::cout << "\n"
+              << "+-------------------------------------------------+\n"
+              << "|  Query Lookahead Benchmark (median)              |\n"
+              << "|  Entities: " << std::setw(6) << kEntityCount
+              << ", 64-byte components             |\n"
+              << "+-------------------------------------------------+\n"
+              << "|  Includes   Manual  Prefetch     ById           |\n";
+    row("3 pools:", three);
+    row("4 pools:", four);
+    row("5 pools:", five);
+    std::cout << "+-------------------------------------------------+\n" << std::endl;
+
+    EXPECT_LE(five.lookahead, kMaxIterationMs)
+        << "Median 5-include query time " << five.lookahead << " ms exceeds " << kMaxIterationMs
+        << " ms for " << kEntityCount << " entities";
+}
+
+// ===========================================================================
+// Column Streaming: AoS vs SoA Transform
+// ===========================================================================
+
+TEST_F(ComponentStorageBenchmark, PositionStreamAoSVsSoA) {
+    ComponentStorage<Transform> aos;
+    SoAComponentStorage<Transform> soa;
+    for (int i = 0; i < kEntityCount; ++i) {
+        auto e = entities_[static_cast<std::size_t>(i)];
+        Transform t{{static_cast<float>(i), 0.0f, 0.0f}, {}, {}};
+        aos.Add(e, t);
+        soa.Add(e, t);
+    }
+
+    // A pass that only touches position: AoS drags rotation and scale
+    // through the cache, SoA streams a packed Vector3 column.
+    auto measure = [&](auto&& pass) {
+        std::vector<double> latencies;
+        latencies.reserve(static_cast<std::size_t>(kIterations));
+        for (int iter = 0; iter < kIterations; ++iter) {
+            auto start = std::chrono::high_resolution_clock::now();
+            pass();
+            auto end = std::chrono::high_resolution_clock::now();
+            latencies.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        }
+        std::sort(latencies.begin(), latencies.end());
+        return latencies;
+    };
+
+    auto aosTimes = measure([&] {
+        for (auto& t : aos) {
+            t.position.x += 0.016f;
+        }
+    });
+    auto soaTimes = measure([&] {
+        for (auto& p : soa.Column<&Transform::position>()) {
+            p.x += 0.016f;
+        }
+    });
+    soa.MarkAllChanged();
+
+    double aosMedian = aosTimes[aosTimes.size() / 2];
+    double soaMedian = soaTimes[soaTimes.size() / 2];
+    double soaP99 =
+        soaTimes[static_cast<std::size_t>(static_cast<double>(soaTimes.size()) * 0.99)];
+
+    std::cout << "\n"
+              << "+-------------------------------------------------+\n"
+              << "|  Transform.position Stream Benchmark             |\n"
+              << "+-------------------------------------------------+\n"
+              << "|  Entities:      " << std::setw(10) << kEntityCount
+              << "                    |\n"
+              << "|  AoS:           " << std::setw(10) << std::fixed
+              << std::setprecision(4) << aosMedian << " ms (median)      |\n"
+              << "|  SoA column:    " << std::setw(10) << soaMedian
+              << " ms (median)      |\n"
+              << "+-------------------------------------------------+\n"
+              << std::endl;
+
+    EXPECT_FLOAT_EQ(soa.Load(entities_[0]).position.x, aos.Get(entities_[0]).position.x);
+    EXPECT_LE(soaP99, kMaxIterationMs)
+        << "p99 SoA column pass " << soaP99 << " ms exceeds " << kMaxIterationMs << " ms for "
+        << kEntityCount << " entities";
+}
+
 // ===========================================================================
 // Random Access (Get) Throughput
 // ===========================================================================
@@ -26,6 +26,8 @@
 #include <mach/mach.h>
 #endif
 
+#include "cgs/ecs/component_storage.hpp"
+#include "cgs/game/combat_components.hpp"
 #include "cgs/plugin/mmorpg_plugin.hpp"
 
 using namespace cgs::plugin;
@@ -393,3 +395,54 @@ TEST_F(MemoryProfilingBenchmark, DestructionMemoryReclamation) {
     plugin.OnShutdown();
     plugin.OnUnload();
 }
+
+// ===========================================================================
+// Sparse Array Overhead For Rare Components
+// ===========================================================================
+
+TEST_F(MemoryProfilingBenchmark, SparseOverheadForRareComponents) {
+    // A rare component (e.g. DamageEvent) attached to a handful of entities
+    // spread across the full 24-bit id range.  With a flat sparse array this
+    // would cost 4 bytes per id up to the highest one (~64 MB per pool).
+    constexpr uint32_t kRareCount = 16;
+    constexpr uint32_t kStride = cgs::ecs::Entity::kMaxId / kRareCount;
+
+    cgs::ecs::ComponentStorage<DamageEvent> rare;
+    for (uint32_t i = 0; i < kRareCount; ++i) {
+        rare.Add(cgs::ecs::Entity(i * kStride, 0), DamageEvent{});
+    }
+
+    // A dense pool over the first kPlayerCount ids, for comparison.
+    cgs::ecs::ComponentStorage<Transform> dense;
+    for (int i = 0; i < kPlayerCount; ++i) {
+        dense.Add(cgs::ecs::Entity(static_cast<uint32_t>(i), 0), Transform{});
+    }
+
+    const std::size_t flatBytes =
+        static_cast<std::size_t>(cgs::ecs::Entity::kMaxId) * sizeof(uint32_t);
+    const std::size_t rareBytes = rare.SparseMemoryUsage();
+    const std::size_t denseBytes = dense.SparseMemoryUsage();
+
+    std::cout << "\n"
+              << "+---------------------------------------------------+\n"
+              << "|  Sparse Array Overhead (Paged)                     |\n"
+              << "+---------------------------------------------------+\n"
+              << "|  Rare pool (" << std::setw(2) << kRareCount << " ids):   " << std::setw(12)
+              << formatBytes(rareBytes) << "                |\n"
+              << "|  Dense pool (1K ids): " << std::setw(12) << formatBytes(denseBytes)
+              << "                |\n"
+              << "|  Flat array (max id): " << std::setw(12) << formatBytes(flatBytes)
+              << "                |\n"
+              << "+---------------------------------------------------+\n"
+              << std::endl;
+
+    // Each live id costs at most one page plus its directory slot.
+    EXPECT_LT(rareBytes, flatBytes / 100);
+    EXPECT_LT(denseBytes, 64u * 1024u);
+
+    for (uint32_t i = 0; i < kRareCount; ++i) {
+        rare.Remove(cgs::ecs::Entity(i * kStride, 0));
+    }
+    EXPECT_LT(rare.SparseMemoryUsage(), rareBytes)
+        << "Pages must be released once their last component is removed";
+}
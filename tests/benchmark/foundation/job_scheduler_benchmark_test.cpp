@@ -0,0 +1,198 @@
+/// @file job_scheduler_benchmark_test.cpp
+/// @brief Small-job throughput of GameJobScheduler: schedule() vs submit().
+///
+/// schedule() allocates a std::function, a promise/future pair and a
+/// kcenon job per call and tracks it in a mutex-guarded map.  submit()
+/// stores the callable inline in a pooled slot and queues a 32-bit index
+/// on a work-stealing deque.  Both are driven with the same tiny job
+/// (one atomic increment) so the numbers measure scheduling overhead.
+///
+/// Focus areas:
+///   - External submission (from a non-worker thread)
+///   - Fan-out from inside a worker (own-deque pushes, stealing)
+///   - processTick() with tens of thousands of registered timers
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "cgs/foundation/job_scheduler.hpp"
+
+using namespace cgs::foundation;
+
+namespace {
+
+constexpr int kJobCount = 100000;
+constexpr int kIterations = 5;
+constexpr std::size_t kWorkers = 4;
+constexpr double kMinSubmitThroughput = 100000.0;  // jobs/sec, conservative floor
+
+constexpr int kTimerCount = 50000;
+constexpr int kFrames = 600;                    // 10 s of 60 Hz frames
+constexpr double kMaxProcessTickMicros = 2000;  // Per frame, conservative ceiling
+
+double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+template <typename Enqueue>
+double runBatch(GameJobScheduler& scheduler, Enqueue enqueue) {
+    std::atomic<int> counter{0};
+    std::vector<GameJobScheduler::JobId> ids;
+    ids.reserve(static_cast<std::size_t>(kJobCount));
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kJobCount; ++i) {
+        auto result = enqueue([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+        if (result.hasValue()) {
+            ids.push_back(result.value());
+        }
+    }
+    for (auto id : ids) {
+        (void)scheduler.wait(id);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    EXPECT_EQ(counter.load(), kJobCount);
+    return static_cast<double>(kJobCount) / std::chrono::duration<double>(end - start).count();
+}
+
+void printRow(const char* label, double jobsPerSec) {
+    std::cout << "|  " << std::left << std::setw(22) << label << std::right << std::setw(12)
+              << std::fixed << std::setprecision(0) << jobsPerSec << " jobs/sec  |\n";
+}
+
+}  // namespace
+
+// ===========================================================================
+// Benchmark Fixture
+// ===========================================================================
+
+class JobSchedulerBenchmark : public ::testing::Test {};
+
+// ===========================================================================
+// External submission
+// ===========================================================================
+
+TEST_F(JobSchedulerBenchmark, ScheduleVsSubmitThroughput) {
+    GameJobScheduler scheduler(kWorkers);
+
+    std::vector<double> scheduleTp;
+    std::vector<double> submitTp;
+    for (int iter = 0; iter < kIterations; ++iter) {
+        scheduleTp.push_back(
+            runBatch(scheduler, [&](auto fn) { return scheduler.schedule(std::move(fn)); }));
+        submitTp.push_back(
+            runBatch(scheduler, [&](auto fn) { return scheduler.submit(std::move(fn)); }));
+    }
+
+    const double scheduleMedian = median(scheduleTp);
+    const double submitMedian = median(submitTp);
+
+    std::cout << "\n"
+              << "+-------------------------------------------------+\n"
+              << "|  Small-job throughput (" << kWorkers << " workers)                |\n"
+              << "+-------------------------------------------------+\n";
+    printRow("schedule()", scheduleMedian);
+    printRow("submit()", submitMedian);
+    std::cout << "|  Speedup:        " << std::setw(10) << std::setprecision(2)
+              << submitMedian / scheduleMedian << "x                    |\n"
+              << "+-------------------------------------------------+\n"
+              << std::endl;
+
+    EXPECT_EQ(scheduler.stats().heapJobs, 0u);
+    EXPECT_GE(submitMedian, kMinSubmitThroughput);
+}
+
+// ===========================================================================
+// Fan-out from a worker
+// ===========================================================================
+
+TEST_F(JobSchedulerBenchmark, NestedSubmitFanOut) {
+    GameJobScheduler scheduler(kWorkers);
+    std::atomic<int> counter{0};
+
+    auto start = std::chrono::steady_clock::now();
+    auto root = scheduler.submit([&] {
+        std::vector<GameJobScheduler::JobId> ids;
+        ids.reserve(static_cast<std::size_t>(kJobCount));
+        for (int i = 0; i < kJobCount; ++i) {
+            auto result = scheduler.submit(
+                [&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+            if (result.hasValue()) {
+                ids.push_back(result.value());
+            }
+        }
+        for (auto id : ids) {
+            (void)scheduler.wait(id);
+        }
+    });
+    ASSERT_TRUE(root.hasValue());
+    ASSERT_TRUE(scheduler.wait(root.value()).hasValue());
+    auto end = std::chrono::steady_clock::now();
+
+    const double tp =
+        static_cast<double>(kJobCount) / std::chrono::duration<double>(end - start).count();
+    const auto stats = scheduler.stats();
+
+    std::cout << "\n"
+              << "+-------------------------------------------------+\n"
+              << "|  Nested fan-out (" << kWorkers << " workers)                    |\n"
+              << "+-------------------------------------------------+\n";
+    printRow("submit() from worker", tp);
+    std::cout << "|  Stolen:         " << std::setw(10) << stats.stolen
+              << "                     |\n"
+              << "+-------------------------------------------------+\n"
+              << std::endl;
+
+    EXPECT_EQ(counter.load(), kJobCount);
+    EXPECT_GE(tp, kMinSubmitThroughput);
+}
+
+// ===========================================================================
+// Timers
+// ===========================================================================
+
+TEST_F(JobSchedulerBenchmark, ProcessTickWithManyTimers) {
+    using namespace std::chrono_literals;
+    GameJobScheduler scheduler(kWorkers);
+    std::atomic<int> fired{0};
+
+    for (int i = 0; i < kTimerCount; ++i) {
+        // Regen / buff style: 1-11 s periods, spread so few expire per frame.
+        scheduler.scheduleTick(std::chrono::milliseconds{1000 + (i * 37) % 10000},
+                               [&fired] { fired.fetch_add(1, std::memory_order_relaxed); });
+    }
+
+    std::vector<double> frameMicros;
+    frameMicros.reserve(static_cast<std::size_t>(kFrames));
+    for (int frame = 0; frame < kFrames; ++frame) {
+        auto start = std::chrono::steady_clock::now();
+        scheduler.processTick(16ms);
+        auto end = std::chrono::steady_clock::now();
+        frameMicros.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+    }
+    const double medianMicros = median(frameMicros);
+
+    std::cout << "\n"
+              << "+-------------------------------------------------+\n"
+              << "|  processTick() with " << kTimerCount << " timers                |\n"
+              << "+-------------------------------------------------+\n"
+              << "|  Median frame:   " << std::setw(10) << std::fixed << std::setprecision(1)
+              << medianMicros << " us                   |\n"
+              << "|  Fired:          " << std::setw(10) << fired.load()
+              << "                     |\n"
+              << "+-------------------------------------------------+\n"
+              << std::endl;
+
+    EXPECT_GT(fired.load(), 0);
+    EXPECT_EQ(scheduler.stats().heapJobs, 0u);
+    EXPECT_LE(medianMicros, kMaxProcessTickMicros);
+}
@@ -21,7 +21,9 @@
 #include <iomanip>
 #include <iostream>
 #include <numeric>
+#include <span>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "cgs/foundation/game_network_manager.hpp"
@@ -319,3 +321,160 @@ TEST_F(MessageSerializationBenchmark, PayloadSizeImpact) {
         }
     }
 }
+
+// ===========================================================================
+// Pooled Frames: broadcast fan-out
+// ===========================================================================
+
+TEST_F(MessageSerializationBenchmark, PooledFrameFanOut) {
+    // One zone broadcast: every recipient holds the frame until its send
+    // completes.  Copying vectors per recipient vs sharing one WireBuffer.
+    constexpr int kRecipients = 2000;
+    constexpr int kBroadcasts = 200;
+    auto msg = makeGameMessage(0x10, 58);
+    WireBufferPool pool;
+
+    std::vector<std::vector<uint8_t>> copies;
+    copies.reserve(kRecipients);
+    auto copyStart = std::chrono::high_resolution_clock::now();
+    for (int b = 0; b < kBroadcasts; ++b) {
+        copies.clear();
+        auto wire = msg.serialize();
+        for (int r = 0; r < kRecipients; ++r) {
+            copies.push_back(wire);
+        }
+    }
+    auto copyEnd = std::chrono::high_resolution_clock::now();
+
+    std::vector<WireBuffer> shared;
+    shared.reserve(kRecipients);
+    auto shareStart = std::chrono::high_resolution_clock::now();
+    for (int b = 0; b < kBroadcasts; ++b) {
+        shared.clear();
+        auto frame = msg.frame(pool);
+        for (int r = 0; r < kRecipients; ++r) {
+            shared.push_back(frame);
+        }
+    }
+    auto shareEnd = std::chrono::high_resolution_clock::now();
+    shared.clear();
+
+    double copyMs = std::chrono::duration<double, std::milli>(copyEnd - copyStart).count();
+    double shareMs = std::chrono::duration<double, std::milli>(shareEnd - shareStart).count();
+
+    std::cout << "\n"
+              << "+-------------------------------------------------+\n"
+              << "|  Broadcast Fan-Out (" << kRecipients << " recipients, 64 B)   |\n"
+              << "+-------------------------------------------------+\n"
+              << "|  Vector copies: " << std::setw(10) << std::fixed
+              << std::setprecision(2) << copyMs / kBroadcasts << " ms/message       |\n"
+              << "|  Shared frame:  " << std::setw(10) << shareMs / kBroadcasts
+              << " ms/message       |\n"
+              << "|  Pool allocs:   " << std::setw(10) << pool.allocationCount()
+              << "                    |\n"
+              << "+-------------------------------------------------+\n"
+              << std::endl;
+
+    // Every broadcast after the first reuses the recycled frame.
+    EXPECT_EQ(pool.allocationCount(), 1u);
+    EXPECT_EQ(pool.idleCount(), 1u);
+}
+
+// ===========================================================================
+// GameSerializer: bulk copy vs per-field snapshot encoding
+// ===========================================================================
+
+namespace {
+
+/// Transform-sized snapshot record (position, rotation, scale).
+struct SnapshotTransform {
+    float px = 0.0f, py = 0.0f, pz = 0.0f;
+    float qw = 1.0f, qx = 0.0f, qy = 0.0f, qz = 0.0f;
+    float sx = 1.0f, sy = 1.0f, sz = 1.0f;
+};
+
+/// The same record registered out of memory order, which forces the
+/// per-field path: the encoding before the bulk fast path.
+struct FieldwiseTransform {
+    float px = 0.0f, py = 0.0f, pz = 0.0f;
+    float qw = 1.0f, qx = 0.0f, qy = 0.0f, qz = 0.0f;
+    float sx = 1.0f, sy = 1.0f, sz = 1.0f;
+};
+
+} // anonymous namespace
+
+CGS_SERIALIZABLE(SnapshotTransform, 1,
+    field("px", &SnapshotTransform::px), field("py", &SnapshotTransform::py),
+    field("pz", &SnapshotTransform::pz), field("qw", &SnapshotTransform::qw),
+    field("qx", &SnapshotTransform::qx), field("qy", &SnapshotTransform::qy),
+    field("qz", &SnapshotTransform::qz), field("sx", &SnapshotTransform::sx),
+    field("sy", &SnapshotTransform::sy), field("sz", &SnapshotTransform::sz));
+
+CGS_SERIALIZABLE(FieldwiseTransform, 1,
+    field("sx", &FieldwiseTransform::sx), field("sy", &FieldwiseTransform::sy),
+    field("sz", &FieldwiseTransform::sz), field("px", &FieldwiseTransform::px),
+    field("py", &FieldwiseTransform::py), field("pz", &FieldwiseTransform::pz),
+    field("qw", &FieldwiseTransform::qw), field("qx", &FieldwiseTransform::qx),
+    field("qy", &FieldwiseTransform::qy), field("qz", &FieldwiseTransform::qz));
+
+namespace {
+
+/// Median milliseconds to encode and decode @p records as one array.
+template <typename T>
+std::pair<double, double> snapshotMs(const std::vector<T>& records) {
+    GameSerializer s;
+    std::vector<double> encode;
+    std::vector<double> decode;
+    for (int iter = 0; iter < kIterations; ++iter) {
+        auto t0 = std::chrono::high_resolution_clock::now();
+        auto bin = s.serializeArray(std::span<const T>(records));
+        auto t1 = std::chrono::high_resolution_clock::now();
+        auto back = s.deserializeArray<T>(bin);
+        auto t2 = std::chrono::high_resolution_clock::now();
+        EXPECT_TRUE(back.hasValue());
+        EXPECT_EQ(back.value().size(), records.size());
+        encode.push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
+        decode.push_back(std::chrono::duration<double, std::milli>(t2 - t1).count());
+    }
+    std::sort(encode.begin(), encode.end());
+    std::sort(decode.begin(), decode.end());
+    return {encode[encode.size() / 2], decode[decode.size() / 2]};
+}
+
+} // anonymous namespace
+
+TEST_F(MessageSerializationBenchmark, BulkTransformSnapshot) {
+    constexpr std::size_t kTransforms = 100000;
+    std::vector<SnapshotTransform> bulk(kTransforms);
+    std::vector<FieldwiseTransform> fieldwise(kTransforms);
+    for (std::size_t i = 0; i < kTransforms; ++i) {
+        bulk[i].px = fieldwise[i].px = static_cast<float>(i);
+        bulk[i].qz = fieldwise[i].qz = 0.5f;
+    }
+    ASSERT_TRUE(detail::memoryLayoutMatches<SnapshotTransform>());
+    ASSERT_FALSE(detail::memoryLayoutMatches<FieldwiseTransform>());
+
+    const auto [fieldEncode, fieldDecode] = snapshotMs(fieldwise);
+    const auto [bulkEncode, bulkDecode] = snapshotMs(bulk);
+    const double mb = static_cast<double>(kTransforms * sizeof(SnapshotTransform)) / 1e6;
+
+    std::cout << "\n"
+              << "+-------------------------------------------------+\n"
+              << "|  Snapshot of " << kTransforms << " Transforms (" << std::fixed
+              << std::setprecision(1) << mb << " MB)        |\n"
+              << "+-------------------------------------------------+\n"
+              << std::setprecision(2)
+              << "|  Per-field encode: " << std::setw(8) << fieldEncode << " ms"
+              << "                |\n"
+              << "|  Bulk encode:      " << std::setw(8) << bulkEncode << " ms ("
+              << std::setw(6) << mb / (bulkEncode / 1000.0) << " MB/s)  |\n"
+              << "|  Per-field decode: " << std::setw(8) << fieldDecode << " ms"
+              << "                |\n"
+              << "|  Bulk decode:      " << std::setw(8) << bulkDecode << " ms ("
+              << std::setw(6) << mb / (bulkDecode / 1000.0) << " MB/s)  |\n"
+              << "+-------------------------------------------------+\n"
+              << std::endl;
+
+    EXPECT_LT(bulkEncode, fieldEncode);
+    EXPECT_LT(bulkDecode, fieldDecode);
+}
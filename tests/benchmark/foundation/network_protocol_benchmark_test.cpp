@@ -0,0 +1,837 @@
+/// @file network_protocol_benchmark_test.cpp
+/// @brief Per-protocol latency/throughput, session scale, broadcast
+///        fan-out and TLS overhead benchmarks for GameNetworkManager
+///        (SDS-MOD-004).
+///
+/// network_throughput_test.cpp measures one-way TCP dispatch only.  This
+/// suite reports, for every scenario, p50/p99 latency next to throughput:
+///
+///   - Message sizes over TCP, UDP and WebSocket: echo round trips (one
+///     message in flight) for latency, a one-way stream counted by the
+///     server for throughput.  UDP may drop datagrams under the stream;
+///     delivered messages and loss are reported rather than asserted.
+///   - Many sessions: 10k idle plus 1k active TCP sessions in one
+///     process, every active session running echo round trips.
+///   - Broadcast fan-out to 1k and 5k sessions: time from broadcast() to
+///     each session receiving the frame, and to the last one.
+///   - TLS overhead: the same echo and stream runs over plain TCP and
+///     TCP + TLS 1.3, with a throwaway self-signed certificate.
+///
+/// The session-scale and broadcast clients are plain non-blocking
+/// sockets multiplexed with poll() on the test thread (as in
+/// tests/load/bot_swarm.cpp), so 10k sessions cost 10k sockets rather
+/// than 10k client threads.  Both ends live in this process, so the
+/// session counts are lowered to fit RLIMIT_NOFILE when it is too small.
+
+#include <gtest/gtest.h>
+
+#include "cgs/foundation/game_network_manager.hpp"
+#include "cgs/foundation/network_adapter.hpp"
+
+// kcenon client facades
+#include <kcenon/network/facade/tcp_facade.h>
+#include <kcenon/network/facade/udp_facade.h>
+#include <kcenon/network/facade/websocket_facade.h>
+#include <kcenon/network/interfaces/connection_observer.h>
+#include <kcenon/network/interfaces/i_protocol_client.h>
+
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/x509.h>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace cgs::foundation;
+using namespace kcenon::network;
+
+namespace {
+
+constexpr uint16_t kTCPPort = 19020;
+constexpr uint16_t kUDPPort = 19021;
+constexpr uint16_t kWSPort = 19022;
+constexpr uint16_t kScalePort = 19023;
+constexpr uint16_t kPlainPort = 19024;
+constexpr uint16_t kTLSPort = 19025;
+constexpr uint16_t kBroadcastPortBase = 19030;  // + sessions / 1000
+
+constexpr uint16_t kEchoOpcode = 0x10;
+constexpr uint16_t kStreamOpcode = 0x11;
+constexpr uint16_t kBroadcastOpcode = 0x12;
+
+constexpr auto kConnectTimeout = std::chrono::seconds(10);
+constexpr auto kReplyTimeout = std::chrono::milliseconds(500);
+constexpr auto kStreamTimeout = std::chrono::seconds(30);
+constexpr auto kDeliveryTimeout = std::chrono::seconds(10);
+constexpr auto kStartupDelay = std::chrono::milliseconds(200);
+
+/// Wire sizes (header included) of the per-protocol sweep.
+constexpr std::size_t kMessageSizes[] = {64, 256, 1024, 4096};
+
+constexpr std::size_t kRoundTrips = 2000;
+constexpr std::size_t kStreamCount = 50000;
+
+constexpr std::size_t kIdleSessions = 10000;
+constexpr std::size_t kActiveSessions = 1000;
+constexpr auto kActiveDuration = std::chrono::seconds(3);
+
+constexpr std::size_t kBroadcastRounds = 50;
+
+using Clock = std::chrono::steady_clock;
+
+int64_t nowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               Clock::now().time_since_epoch())
+        .count();
+}
+
+// ---------------------------------------------------------------------------
+// Reporting
+// ---------------------------------------------------------------------------
+
+struct LatencySummary {
+    std::size_t samples = 0;
+    double p50Us = 0.0;
+    double p99Us = 0.0;
+    double maxUs = 0.0;
+};
+
+LatencySummary summarize(std::vector<double> samplesUs) {
+    LatencySummary out;
+    out.samples = samplesUs.size();
+    if (samplesUs.empty()) {
+        return out;
+    }
+    std::sort(samplesUs.begin(), samplesUs.end());
+    const auto at = [&](double q) {
+        const auto index = static_cast<std::size_t>(static_cast<double>(samplesUs.size()) * q);
+        return samplesUs[std::min(index, samplesUs.size() - 1)];
+    };
+    out.p50Us = at(0.50);
+    out.p99Us = at(0.99);
+    out.maxUs = samplesUs.back();
+    return out;
+}
+
+void printHeader(const std::string& title) {
+    std::cout << "\n"
+              << "+----------------------------------------------------------------------+\n"
+              << "|  " << std::left << std::setw(68) << title << "|\n"
+              << "+----------------------------------------------------------------------+\n"
+              << std::right;
+}
+
+void printLatency(const std::string& label, const LatencySummary& latency) {
+    std::cout << "|  " << std::left << std::setw(22) << label << std::right
+              << " p50 " << std::setw(9) << std::fixed << std::setprecision(1) << latency.p50Us
+              << " us  p99 " << std::setw(9) << latency.p99Us << " us  (n=" << latency.samples
+              << ")\n";
+}
+
+void printRate(const std::string& label, double perSec, const std::string& unit) {
+    std::cout << "|  " << std::left << std::setw(22) << label << std::right << " "
+              << std::setw(12) << std::fixed << std::setprecision(0) << perSec << " " << unit
+              << "\n";
+}
+
+void printFooter() {
+    std::cout << "+----------------------------------------------------------------------+\n"
+              << std::endl;
+}
+
+/// A message of @p wireSize bytes on the wire, carrying a send timestamp.
+NetworkMessage makeMessage(uint16_t opcode, std::size_t wireSize) {
+    NetworkMessage msg;
+    msg.opcode = opcode;
+    msg.payload.resize(std::max<std::size_t>(wireSize, 6 + sizeof(int64_t)) - 6, 0xAB);
+    return msg;
+}
+
+void stampPayload(std::vector<uint8_t>& wire) {
+    const int64_t stamp = nowUs();
+    std::memcpy(wire.data() + 6, &stamp, sizeof(stamp));
+}
+
+int64_t payloadStamp(const uint8_t* frame) {
+    int64_t stamp = 0;
+    std::memcpy(&stamp, frame + 6, sizeof(stamp));
+    return stamp;
+}
+
+/// Split complete frames off the front of @p buffer, calling
+/// @p onFrame(frame, size) for each.
+template <typename OnFrame>
+void splitFrames(std::vector<uint8_t>& buffer, OnFrame&& onFrame) {
+    std::size_t offset = 0;
+    while (buffer.size() - offset >= 6) {
+        const uint8_t* head = buffer.data() + offset;
+        const uint32_t length = ((static_cast<uint32_t>(head[0]) << 24) |
+                                 (static_cast<uint32_t>(head[1]) << 16) |
+                                 (static_cast<uint32_t>(head[2]) << 8) | head[3]) &
+                                WireBuffer::kLengthMask;
+        if (length < 6 || buffer.size() - offset < length) {
+            break;
+        }
+        onFrame(head, static_cast<std::size_t>(length));
+        offset += length;
+    }
+    buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(offset));
+}
+
+// ---------------------------------------------------------------------------
+// BenchClient: one kcenon client that counts and timestamps echoed frames
+// ---------------------------------------------------------------------------
+
+class BenchClient {
+public:
+    ~BenchClient() {
+        if (client_) {
+            (void)client_->stop();
+        }
+    }
+
+    bool connect(Protocol protocol, uint16_t port, bool tls = false) {
+        switch (protocol) {
+            case Protocol::TCP: {
+                facade::tcp_facade tcp;
+                facade::tcp_facade::client_config cfg{};
+                cfg.host = "127.0.0.1";
+                cfg.port = port;
+                cfg.client_id = "bench-tcp";
+                if (tls) {
+                    cfg.use_ssl = true;
+                    cfg.verify_certificate = false;  // self-signed
+                }
+                client_ = tcp.create_client(cfg);
+                break;
+            }
+            case Protocol::UDP: {
+                facade::udp_facade udp;
+                client_ = udp.create_client(
+                    {.host = "127.0.0.1", .port = port, .client_id = "bench-udp"});
+                break;
+            }
+            case Protocol::WebSocket: {
+                facade::websocket_facade ws;
+                client_ = ws.create_client({.client_id = "bench-ws"});
+                break;
+            }
+        }
+        if (!client_) {
+            return false;
+        }
+        attachObserver();
+        if (protocol == Protocol::WebSocket && client_->start("127.0.0.1", port).is_err()) {
+            return false;
+        }
+        if (client_->is_connected()) {
+            return true;
+        }
+        return connected_.wait_for(kConnectTimeout) == std::future_status::ready;
+    }
+
+    bool send(std::vector<uint8_t> wire) { return client_->send(std::move(wire)).is_ok(); }
+
+    /// Wait until @p count frames have arrived in total.
+    bool waitReceived(std::size_t count, std::chrono::milliseconds timeout) {
+        std::unique_lock lock(mutex_);
+        return cv_.wait_for(lock, timeout, [&] { return received_ >= count; });
+    }
+
+    [[nodiscard]] std::size_t received() const {
+        std::lock_guard lock(mutex_);
+        return received_;
+    }
+
+    /// Round-trip times of the frames received so far.
+    [[nodiscard]] std::vector<double> roundTripsUs() const {
+        std::lock_guard lock(mutex_);
+        return roundTripsUs_;
+    }
+
+private:
+    void attachObserver() {
+        auto adapter = std::make_shared<interfaces::callback_adapter>();
+        adapter
+            ->on_connected([this]() {
+                std::call_once(connectedOnce_, [this] { connectedPromise_.set_value(); });
+            })
+            .on_receive([this](std::span<const uint8_t> data) {
+                const int64_t arrivedUs = nowUs();
+                std::lock_guard lock(mutex_);
+                buffer_.insert(buffer_.end(), data.begin(), data.end());
+                splitFrames(buffer_, [&](const uint8_t* frame, std::size_t size) {
+                    if (size >= 6 + sizeof(int64_t)) {
+                        roundTripsUs_.push_back(
+                            static_cast<double>(arrivedUs - payloadStamp(frame)));
+                    }
+                    ++received_;
+                });
+                cv_.notify_all();
+            })
+            .on_disconnected([](std::optional<std::string_view> /*reason*/) {})
+            .on_error([](std::error_code /*ec*/) {});
+        client_->set_observer(adapter);
+    }
+
+    std::shared_ptr<interfaces::i_protocol_client> client_;
+
+    std::promise<void> connectedPromise_;
+    std::future<void> connected_{connectedPromise_.get_future()};
+    std::once_flag connectedOnce_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::vector<uint8_t> buffer_;
+    std::vector<double> roundTripsUs_;
+    std::size_t received_ = 0;
+};
+
+// ---------------------------------------------------------------------------
+// RawSessions: many plain TCP client sockets driven with poll()
+// ---------------------------------------------------------------------------
+
+/// Raise RLIMIT_NOFILE to its hard limit and return the usable count.
+std::size_t raiseFdLimit() {
+    rlimit limit{};
+    if (getrlimit(RLIMIT_NOFILE, &limit) != 0) {
+        return 1024;
+    }
+    limit.rlim_cur = limit.rlim_max;
+    (void)setrlimit(RLIMIT_NOFILE, &limit);
+    (void)getrlimit(RLIMIT_NOFILE, &limit);
+    return static_cast<std::size_t>(limit.rlim_cur);
+}
+
+/// Sessions that fit when both ends of each connection are in this
+/// process, keeping 512 descriptors spare.
+std::size_t sessionBudget() {
+    const std::size_t fds = raiseFdLimit();
+    return fds > 512 ? (fds - 512) / 2 : 0;
+}
+
+class RawSessions {
+public:
+    RawSessions() = default;
+    RawSessions(const RawSessions&) = delete;
+    RawSessions& operator=(const RawSessions&) = delete;
+
+    ~RawSessions() {
+        for (const int fd : fds_) {
+            ::close(fd);
+        }
+    }
+
+    /// Open @p count connections to @p port, in batches that wait for
+    /// @p mgr to register them (keeps the accept backlog from overflowing).
+    bool connect(uint16_t port, std::size_t count, const GameNetworkManager& mgr) {
+        constexpr std::size_t kBatch = 256;
+        const std::size_t base = mgr.sessionCount();
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = htons(port);
+
+        for (std::size_t opened = 0; opened < count;) {
+            const std::size_t batchEnd = std::min(count, opened + kBatch);
+            for (; opened < batchEnd; ++opened) {
+                const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+                if (fd < 0) {
+                    return false;
+                }
+                if (::connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) {
+                    ::close(fd);
+                    return false;
+                }
+                const int one = 1;
+                ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+                ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+                fds_.push_back(fd);
+                buffers_.emplace_back();
+            }
+            const auto deadline = Clock::now() + kConnectTimeout;
+            while (mgr.sessionCount() < base + opened) {
+                if (Clock::now() > deadline) {
+                    return false;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        return true;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return fds_.size(); }
+
+    /// Write all of @p wire to session @p index.
+    bool write(std::size_t index, const std::vector<uint8_t>& wire) {
+        std::size_t sent = 0;
+        while (sent < wire.size()) {
+            const auto n = ::send(fds_[index], wire.data() + sent, wire.size() - sent,
+                                  MSG_NOSIGNAL);
+            if (n > 0) {
+                sent += static_cast<std::size_t>(n);
+            } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                pollfd pfd{fds_[index], POLLOUT, 0};
+                ::poll(&pfd, 1, 100);
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Poll the sessions in [@p first, @p first + @p count) for up to
+    /// @p timeoutMs and call @p onFrame(index, frame, size) for every
+    /// complete frame read.
+    template <typename OnFrame>
+    void pump(std::size_t first, std::size_t count, int timeoutMs, OnFrame&& onFrame) {
+        pollFds_.resize(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            pollFds_[i] = {fds_[first + i], POLLIN, 0};
+        }
+        if (::poll(pollFds_.data(), static_cast<nfds_t>(count), timeoutMs) <= 0) {
+            return;
+        }
+        uint8_t chunk[16384];
+        for (std::size_t i = 0; i < count; ++i) {
+            if ((pollFds_[i].revents & POLLIN) == 0) {
+                continue;
+            }
+            const std::size_t index = first + i;
+            for (;;) {
+                const auto n = ::recv(fds_[index], chunk, sizeof(chunk), 0);
+                if (n <= 0) {
+                    break;
+                }
+                buffers_[index].insert(buffers_[index].end(), chunk, chunk + n);
+            }
+            splitFrames(buffers_[index], [&](const uint8_t* frame, std::size_t size) {
+                onFrame(index, frame, size);
+            });
+        }
+    }
+
+private:
+    std::vector<int> fds_;
+    std::vector<std::vector<uint8_t>> buffers_;
+    std::vector<pollfd> pollFds_;
+};
+
+// ---------------------------------------------------------------------------
+// Self-signed certificate for the TLS runs
+// ---------------------------------------------------------------------------
+
+/// Write a self-signed RSA certificate and key into @p dir; false if
+/// OpenSSL cannot produce them.
+bool writeSelfSignedCertificate(const std::filesystem::path& dir, TlsConfig& tls) {
+    EVP_PKEY* key = EVP_RSA_gen(2048);
+    X509* cert = X509_new();
+    bool ok = key != nullptr && cert != nullptr;
+    if (ok) {
+        ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+        X509_gmtime_adj(X509_getm_notBefore(cert), 0);
+        X509_gmtime_adj(X509_getm_notAfter(cert), 24L * 3600L);
+        X509_set_pubkey(cert, key);
+        X509_NAME* name = X509_get_subject_name(cert);
+        X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+                                   reinterpret_cast<const unsigned char*>("localhost"), -1, -1,
+                                   0);
+        X509_set_issuer_name(cert, name);
+        ok = X509_sign(cert, key, EVP_sha256()) > 0;
+    }
+
+    tls.certPath = (dir / "bench-cert.pem").string();
+    tls.keyPath = (dir / "bench-key.pem").string();
+    if (ok) {
+        FILE* certFile = std::fopen(tls.certPath.c_str(), "wb");
+        FILE* keyFile = std::fopen(tls.keyPath.c_str(), "wb");
+        ok = certFile != nullptr && keyFile != nullptr && PEM_write_X509(certFile, cert) == 1 &&
+             PEM_write_PrivateKey(keyFile, key, nullptr, nullptr, 0, nullptr, nullptr) == 1;
+        if (certFile != nullptr) {
+            std::fclose(certFile);
+        }
+        if (keyFile != nullptr) {
+            std::fclose(keyFile);
+        }
+    }
+    X509_free(cert);
+    EVP_PKEY_free(key);
+    return ok;
+}
+
+}  // anonymous namespace
+
+// ===========================================================================
+// Fixture
+// ===========================================================================
+
+class NetworkProtocolBenchmark : public ::testing::Test {
+protected:
+    void SetUp() override { mgr_ = std::make_unique<GameNetworkManager>(); }
+
+    void TearDown() override {
+        if (mgr_) {
+            mgr_->stopAll();
+        }
+    }
+
+    /// Echo kEchoOpcode back to its sender and count kStreamOpcode.
+    static void registerHandlers(GameNetworkManager& mgr, std::atomic<std::size_t>& streamed) {
+        mgr.registerHandler(kEchoOpcode, [&mgr](SessionId sid, const NetworkMessage& msg) {
+            (void)mgr.send(sid, msg);
+        });
+        mgr.registerHandler(kStreamOpcode,
+                            [&streamed](SessionId /*sid*/, const NetworkMessage& /*msg*/) {
+                                streamed.fetch_add(1, std::memory_order_relaxed);
+                            });
+    }
+
+    struct EchoResult {
+        LatencySummary latency;
+        std::size_t lost = 0;
+    };
+
+    /// kRoundTrips echo round trips of @p wireSize bytes, one in flight.
+    static EchoResult measureEcho(BenchClient& client, std::size_t wireSize) {
+        auto wire = makeMessage(kEchoOpcode, wireSize).serialize();
+        const std::size_t before = client.received();
+        const std::size_t rttBefore = client.roundTripsUs().size();
+        std::size_t expected = before;
+        std::size_t lost = 0;
+        for (std::size_t i = 0; i < kRoundTrips; ++i) {
+            stampPayload(wire);
+            if (!client.send(wire)) {
+                ++lost;
+                continue;
+            }
+            ++expected;
+            if (!client.waitReceived(expected, kReplyTimeout)) {
+                // Lost datagram: resynchronize on what has arrived.
+                ++lost;
+                expected = client.received();
+            }
+        }
+        auto samples = client.roundTripsUs();
+        samples.erase(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(rttBefore));
+        return {summarize(std::move(samples)), lost};
+    }
+
+    struct StreamResult {
+        std::size_t delivered = 0;
+        double messagesPerSec = 0.0;
+        double megabytesPerSec = 0.0;
+    };
+
+    /// kStreamCount one-way messages of @p wireSize bytes, counted by the
+    /// server; stops early when nothing arrives for kReplyTimeout (UDP).
+    static StreamResult measureStream(BenchClient& client,
+                                      std::atomic<std::size_t>& streamed,
+                                      std::size_t wireSize) {
+        const auto wire = makeMessage(kStreamOpcode, wireSize).serialize();
+        streamed.store(0, std::memory_order_relaxed);
+        const auto start = Clock::now();
+        for (std::size_t i = 0; i < kStreamCount; ++i) {
+            (void)client.send(wire);
+        }
+
+        const auto deadline = start + kStreamTimeout;
+        std::size_t lastCount = 0;
+        auto lastProgress = Clock::now();
+        auto lastArrival = lastProgress;
+        while (Clock::now() < deadline) {
+            const std::size_t count = streamed.load(std::memory_order_relaxed);
+            if (count >= kStreamCount) {
+                lastArrival = Clock::now();
+                break;
+            }
+            if (count != lastCount) {
+                lastCount = count;
+                lastProgress = Clock::now();
+                lastArrival = lastProgress;
+            } else if (Clock::now() - lastProgress > kReplyTimeout) {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+
+        StreamResult out;
+        out.delivered = streamed.load(std::memory_order_relaxed);
+        const double seconds = std::chrono::duration<double>(lastArrival - start).count();
+        if (seconds > 0.0) {
+            out.messagesPerSec = static_cast<double>(out.delivered) / seconds;
+            out.megabytesPerSec =
+                static_cast<double>(out.delivered * wire.size()) / seconds / 1'000'000.0;
+        }
+        return out;
+    }
+
+    /// Echo and stream runs at every size in kMessageSizes over @p protocol.
+    void runProtocolSweep(Protocol protocol, uint16_t port) {
+        std::atomic<std::size_t> streamed{0};
+        registerHandlers(*mgr_, streamed);
+        ASSERT_TRUE(mgr_->listen(port, protocol).hasValue())
+            << "Failed to listen on port " << port;
+        std::this_thread::sleep_for(kStartupDelay);
+
+        BenchClient client;
+        ASSERT_TRUE(client.connect(protocol, port)) << protocolName(protocol) << " connect";
+
+        printHeader(std::string(protocolName(protocol)) + " message sizes");
+        for (const std::size_t size : kMessageSizes) {
+            const auto echo = measureEcho(client, size);
+            const auto stream = measureStream(client, streamed, size);
+            const std::string label = std::to_string(size) + " B";
+            printLatency(label + " echo", echo.latency);
+            printRate(label + " stream", stream.messagesPerSec, "msg/sec");
+            printRate(label + " stream", stream.megabytesPerSec, "MB/sec");
+            if (protocol == Protocol::UDP) {
+                std::cout << "|  " << std::left << std::setw(22) << (label + " loss") << std::right
+                          << " echo " << echo.lost << "/" << kRoundTrips << ", stream "
+                          << (kStreamCount - stream.delivered) << "/" << kStreamCount << "\n";
+            } else {
+                EXPECT_EQ(echo.lost, 0u) << label;
+                EXPECT_EQ(stream.delivered, kStreamCount) << label;
+            }
+            EXPECT_GT(echo.latency.samples, 0u) << label;
+        }
+        printFooter();
+    }
+
+    std::unique_ptr<GameNetworkManager> mgr_;
+};
+
+// ===========================================================================
+// Per-protocol message sizes
+// ===========================================================================
+
+TEST_F(NetworkProtocolBenchmark, TCPMessageSizes) {
+    runProtocolSweep(Protocol::TCP, kTCPPort);
+}
+
+TEST_F(NetworkProtocolBenchmark, UDPMessageSizes) {
+    runProtocolSweep(Protocol::UDP, kUDPPort);
+}
+
+TEST_F(NetworkProtocolBenchmark, WebSocketMessageSizes) {
+    runProtocolSweep(Protocol::WebSocket, kWSPort);
+}
+
+// ===========================================================================
+// Many sessions per process: idle sessions plus active echo sessions
+// ===========================================================================
+
+TEST_F(NetworkProtocolBenchmark, TenThousandIdleThousandActiveSessions) {
+    std::atomic<std::size_t> streamed{0};
+    registerHandlers(*mgr_, streamed);
+    ASSERT_TRUE(mgr_->listen(kScalePort, Protocol::TCP).hasValue());
+    std::this_thread::sleep_for(kStartupDelay);
+
+    const std::size_t budget = sessionBudget();
+    const std::size_t active = std::min(kActiveSessions, budget / 2);
+    const std::size_t idle = std::min(kIdleSessions, budget - active);
+    if (active == 0) {
+        GTEST_SKIP() << "RLIMIT_NOFILE too low for the session benchmark";
+    }
+
+    // Active sessions first, so they are the first `active` indices.
+    RawSessions sessions;
+    const auto connectStart = Clock::now();
+    ASSERT_TRUE(sessions.connect(kScalePort, active + idle, *mgr_))
+        << "connected " << sessions.size() << "/" << (active + idle);
+    const double connectSeconds =
+        std::chrono::duration<double>(Clock::now() - connectStart).count();
+
+    // Every active session keeps one 64-byte echo in flight.
+    auto wire = makeMessage(kEchoOpcode, 64).serialize();
+    for (std::size_t i = 0; i < active; ++i) {
+        stampPayload(wire);
+        ASSERT_TRUE(sessions.write(i, wire));
+    }
+
+    std::vector<double> roundTripsUs;
+    roundTripsUs.reserve(active * 256);
+    const auto start = Clock::now();
+    const auto end = start + kActiveDuration;
+    while (Clock::now() < end) {
+        sessions.pump(0, active, 10, [&](std::size_t index, const uint8_t* frame, std::size_t) {
+            roundTripsUs.push_back(static_cast<double>(nowUs() - payloadStamp(frame)));
+            stampPayload(wire);
+            (void)sessions.write(index, wire);
+        });
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    const std::size_t roundTrips = roundTripsUs.size();
+
+    printHeader("TCP sessions: " + std::to_string(idle) + " idle + " + std::to_string(active) +
+                " active");
+    printRate("connect", static_cast<double>(active + idle) / connectSeconds, "sessions/sec");
+    printLatency("echo round trip", summarize(std::move(roundTripsUs)));
+    printRate("echo throughput", static_cast<double>(roundTrips) / seconds, "msg/sec");
+    printFooter();
+
+    EXPECT_EQ(mgr_->sessionCount(), active + idle);
+    EXPECT_GE(roundTrips, active);
+}
+
+// ===========================================================================
+// Broadcast fan-out
+// ===========================================================================
+
+class BroadcastFanOutBenchmark : public NetworkProtocolBenchmark,
+                                 public ::testing::WithParamInterface<std::size_t> {};
+
+TEST_P(BroadcastFanOutBenchmark, FanOut) {
+    const auto port = static_cast<uint16_t>(kBroadcastPortBase + GetParam() / 1000);
+    ASSERT_TRUE(mgr_->listen(port, Protocol::TCP).hasValue());
+    std::this_thread::sleep_for(kStartupDelay);
+
+    const std::size_t recipients = std::min(GetParam(), sessionBudget());
+    RawSessions sessions;
+    ASSERT_TRUE(sessions.connect(port, recipients, *mgr_))
+        << "connected " << sessions.size() << "/" << recipients;
+
+    auto msg = makeMessage(kBroadcastOpcode, 128);
+    std::vector<double> deliveryUs;       // per session and round
+    std::vector<double> completionUs;     // last delivery per round
+    std::vector<double> broadcastCallUs;  // time spent in broadcast()
+    deliveryUs.reserve(recipients * kBroadcastRounds);
+    std::vector<uint32_t> seenRound(recipients, 0);
+    std::size_t delivered = 0;
+
+    const auto start = Clock::now();
+    for (uint32_t round = 1; round <= kBroadcastRounds; ++round) {
+        const int64_t sentUs = nowUs();
+        std::memcpy(msg.payload.data(), &sentUs, sizeof(sentUs));
+        std::memcpy(msg.payload.data() + sizeof(sentUs), &round, sizeof(round));
+        ASSERT_TRUE(mgr_->broadcast(msg).hasValue());
+        broadcastCallUs.push_back(static_cast<double>(nowUs() - sentUs));
+
+        std::size_t pending = recipients;
+        int64_t lastUs = sentUs;
+        const auto deadline = Clock::now() + kDeliveryTimeout;
+        while (pending > 0 && Clock::now() < deadline) {
+            sessions.pump(0, recipients, 10,
+                          [&](std::size_t index, const uint8_t* frame, std::size_t size) {
+                              uint32_t frameRound = 0;
+                              if (size < 6 + sizeof(int64_t) + sizeof(frameRound)) {
+                                  return;
+                              }
+                              std::memcpy(&frameRound, frame + 6 + sizeof(int64_t),
+                                          sizeof(frameRound));
+                              if (frameRound != round || seenRound[index] == round) {
+                                  return;
+                              }
+                              seenRound[index] = round;
+                              lastUs = nowUs();
+                              deliveryUs.push_back(static_cast<double>(lastUs - sentUs));
+                              --pending;
+                              ++delivered;
+                          });
+        }
+        ASSERT_EQ(pending, 0u) << "round " << round << " did not reach every session";
+        completionUs.push_back(static_cast<double>(lastUs - sentUs));
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    printHeader("TCP broadcast fan-out to " + std::to_string(recipients) + " sessions");
+    printLatency("broadcast() call", summarize(std::move(broadcastCallUs)));
+    printLatency("per-session delivery", summarize(std::move(deliveryUs)));
+    printLatency("last session", summarize(std::move(completionUs)));
+    printRate("deliveries", static_cast<double>(delivered) / seconds, "msg/sec");
+    printFooter();
+}
+
+INSTANTIATE_TEST_SUITE_P(Sessions,
+                         BroadcastFanOutBenchmark,
+                         ::testing::Values(std::size_t{1000}, std::size_t{5000}),
+                         [](const auto& info) { return std::to_string(info.param); });
+
+// ===========================================================================
+// TLS overhead
+// ===========================================================================
+
+TEST_F(NetworkProtocolBenchmark, TLSOverhead) {
+    const auto dir = std::filesystem::temp_directory_path() / "cgs_network_tls_bench";
+    std::filesystem::create_directories(dir);
+    TlsConfig tls;
+    if (!writeSelfSignedCertificate(dir, tls)) {
+        std::filesystem::remove_all(dir);
+        GTEST_SKIP() << "could not create a self-signed certificate";
+    }
+
+    std::atomic<std::size_t> plainStreamed{0};
+    std::atomic<std::size_t> tlsStreamed{0};
+    GameNetworkManager plainMgr;
+    GameNetworkManager tlsMgr;
+    registerHandlers(plainMgr, plainStreamed);
+    registerHandlers(tlsMgr, tlsStreamed);
+    ASSERT_TRUE(plainMgr.listen(kPlainPort, Protocol::TCP).hasValue());
+    auto tlsListen = tlsMgr.listen(kTLSPort, Protocol::TCP, tls);
+    if (!tlsListen.hasValue()) {
+        plainMgr.stopAll();
+        std::filesystem::remove_all(dir);
+        GTEST_SKIP() << "TLS listen failed: " << tlsListen.error().message();
+    }
+    std::this_thread::sleep_for(kStartupDelay);
+
+    BenchClient plain;
+    BenchClient secure;
+    ASSERT_TRUE(plain.connect(Protocol::TCP, kPlainPort));
+    ASSERT_TRUE(secure.connect(Protocol::TCP, kTLSPort, true)) << "TLS handshake";
+
+    printHeader("TCP vs TCP + TLS 1.3");
+    for (const std::size_t size : {std::size_t{64}, std::size_t{1024}}) {
+        const auto plainEcho = measureEcho(plain, size);
+        const auto tlsEcho = measureEcho(secure, size);
+        const auto plainStream = measureStream(plain, plainStreamed, size);
+        const auto tlsStream = measureStream(secure, tlsStreamed, size);
+
+        const std::string label = std::to_string(size) + " B";
+        printLatency(label + " echo plain", plainEcho.latency);
+        printLatency(label + " echo TLS", tlsEcho.latency);
+        printRate(label + " stream plain", plainStream.messagesPerSec, "msg/sec");
+        printRate(label + " stream TLS", tlsStream.messagesPerSec, "msg/sec");
+        if (plainStream.messagesPerSec > 0.0) {
+            std::cout << "|  " << std::left << std::setw(22) << (label + " TLS cost") << std::right
+                      << " p50 +" << std::fixed << std::setprecision(1)
+                      << (tlsEcho.latency.p50Us - plainEcho.latency.p50Us) << " us, throughput "
+                      << std::setprecision(1)
+                      << (100.0 * tlsStream.messagesPerSec / plainStream.messagesPerSec)
+                      << "% of plain\n";
+        }
+
+        EXPECT_EQ(tlsEcho.lost, 0u) << label;
+        EXPECT_EQ(tlsStream.delivered, kStreamCount) << label;
+    }
+    printFooter();
+
+    plainMgr.stopAll();
+    tlsMgr.stopAll();
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,126 @@
+/// @file ai_lod_benchmark_test.cpp
+/// @brief AISystem tick cost with and without distance-based LOD.
+///
+/// 100k NPCs spread over a 4 km square map, each running a small shared
+/// tree.  Without LOD every NPC is visited each frame.  With LOD only the
+/// NPCs within range of a player are, at 10 Hz within 30 m and 2 Hz
+/// within 80 m.  Swept over 10 and 100 players.
+///
+/// Acceptance criterion: LOD cost grows with the player count and stays
+/// below the full pass, and no frame after warm-up ticks more than twice
+/// the average.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "cgs/ecs/component_storage.hpp"
+#include "cgs/game/ai_system.hpp"
+#include "cgs/game/spatial_index.hpp"
+
+using namespace cgs::ecs;
+using namespace cgs::game;
+
+namespace {
+
+constexpr uint32_t kNpcs = 100'000;
+constexpr float kMapSize = 4000.0f;
+constexpr int kFrames = 30;
+constexpr float kFrameTime = 0.05f;
+constexpr uint32_t kPlayerCounts[] = {10, 100};
+
+struct Scene {
+    ComponentStorage<AIBrain> brains;
+    ComponentStorage<Transform> transforms;
+    ComponentStorage<Movement> movements;
+    ComponentStorage<Stats> stats;
+    ComponentStorage<ThreatList> threatLists;
+    SpatialIndex index{64.0f};
+
+    Scene() {
+        std::mt19937 rng(36);
+        std::uniform_real_distribution<float> coord(0.0f, kMapSize);
+        auto tree = std::make_shared<BTSelector>();
+        tree->AddChild(std::make_unique<BTCondition>(
+            [](BTContext& ctx) { return ctx.entity.id() % 7 == 0; }));
+        tree->AddChild(std::make_unique<BTAction>([](BTContext&) { return BTStatus::Success; }));
+        for (uint32_t i = 0; i < kNpcs; ++i) {
+            Entity e(i, 0);
+            const Vector3 position(coord(rng), 0.0f, coord(rng));
+            transforms.Add(e, Transform{position, {}, {1.0f, 1.0f, 1.0f}});
+            AIBrain brain;
+            brain.behaviorTree = tree;
+            brains.Add(e, std::move(brain));
+            index.Insert(e, position);
+        }
+    }
+};
+
+}  // anonymous namespace
+
+TEST(AILodBenchmark, CostFollowsPlayersNotNpcs) {
+    std::cout << "\n"
+              << "+---------+------------+------------+------------+------------+\n"
+              << "| Players | full ms/f  | LOD ms/f   | LOD awake  | LOD peak/f |\n"
+              << "+---------+------------+------------+------------+------------+\n";
+
+    Scene full;
+    AISystem fullSystem(full.brains, full.transforms, full.movements, full.stats,
+                        full.threatLists, kFrameTime);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < kFrames; ++frame) {
+        fullSystem.Execute(kFrameTime);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    const double fullMs = std::chrono::duration<double, std::milli>(end - start).count();
+    EXPECT_EQ(fullSystem.GetLastTickUpdateCount(), kNpcs);
+
+    double previousLodMs = 0.0;
+    for (const uint32_t players : kPlayerCounts) {
+
+        Scene lod;
+        AISystem lodSystem(lod.brains, lod.transforms, lod.movements, lod.stats,
+                           lod.threatLists, kFrameTime);
+        lodSystem.SetLodPolicy({{{30.0f, 0.1f}, {80.0f, 0.5f}}});
+        std::mt19937 rng(players);
+        std::uniform_real_distribution<float> coord(0.0f, kMapSize);
+        std::vector<AILodObserver> observers;
+        for (uint32_t p = 0; p < players; ++p) {
+            observers.push_back({Vector3(coord(rng), 0.0f, coord(rng)), &lod.index});
+        }
+        lodSystem.SetLodObservers(observers);
+
+        uint32_t peak = 0;
+        uint64_t updates = 0;
+        start = std::chrono::high_resolution_clock::now();
+        for (int frame = 0; frame < kFrames; ++frame) {
+            lodSystem.Execute(kFrameTime);
+            if (frame >= 10) {  // after every band has cycled once
+                peak = std::max(peak, lodSystem.GetLastTickUpdateCount());
+                updates += lodSystem.GetLastTickUpdateCount();
+            }
+        }
+        end = std::chrono::high_resolution_clock::now();
+        const double lodMs = std::chrono::duration<double, std::milli>(end - start).count();
+
+        const double average = static_cast<double>(updates) / (kFrames - 10);
+        EXPECT_LE(static_cast<double>(peak), 2.0 * average + 8.0) << players << " players";
+        EXPECT_GT(lodMs, previousLodMs);  // more players, more work
+        EXPECT_LT(lodMs, fullMs);
+        previousLodMs = lodMs;
+
+        std::cout << "| " << std::setw(7) << players << " | " << std::setw(10) << std::fixed
+                  << std::setprecision(3) << fullMs / kFrames << " | " << std::setw(10)
+                  << lodMs / kFrames << " | " << std::setw(10) << lodSystem.GetLastAwakeCount()
+                  << " | " << std::setw(10) << peak << " |\n";
+    }
+    std::cout << "+---------+------------+------------+------------+------------+\n" << std::endl;
+}
@@ -0,0 +1,124 @@
+/// @file blackboard_benchmark_test.cpp
+/// @brief Blackboard lookups: string-keyed std::any map versus interned keys.
+///
+/// BT leaves read a few blackboard entries ("target", "home", "threat")
+/// on every tick.  The previous Blackboard hashed a std::string and did
+/// an std::any_cast per lookup; interned BlackboardKeys compare a
+/// uint32_t id over a handful of inline typed slots.  Three reads per
+/// agent over 10k agents, repeated.
+///
+/// Acceptance criterion: every runtime reads back the same values.
+
+#include <gtest/gtest.h>
+
+#include <any>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cgs/ecs/entity.hpp"
+#include "cgs/game/behavior_tree.hpp"
+#include "cgs/game/math_types.hpp"
+
+using namespace cgs::ecs;
+using namespace cgs::game;
+
+namespace {
+
+constexpr uint32_t kAgents = 10'000;
+constexpr int kPasses = 20;
+
+/// The string -> std::any board Blackboard replaced.
+struct AnyMapBoard {
+    std::unordered_map<std::string, std::any> data;
+
+    template <typename T>
+    T* Get(const std::string& key) {
+        auto it = data.find(key);
+        return it == data.end() ? nullptr : std::any_cast<T>(&it->second);
+    }
+};
+
+template <typename Read>
+double timeReads(Read&& read, double& checksum) {
+    const auto start = std::chrono::high_resolution_clock::now();
+    for (int pass = 0; pass < kPasses; ++pass) {
+        for (uint32_t i = 0; i < kAgents; ++i) {
+            checksum += read(i);
+        }
+    }
+    const auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+}  // anonymous namespace
+
+TEST(BlackboardBenchmark, InternedKeysVersusStringLookups) {
+    const BlackboardKey<Entity> kTarget("target");
+    const BlackboardKey<Vector3> kHome("home");
+    const BlackboardKey<float> kThreat("threat");
+
+    std::vector<AnyMapBoard> legacy(kAgents);
+    std::vector<Blackboard> boards(kAgents);
+    for (uint32_t i = 0; i < kAgents; ++i) {
+        const Entity target(i * 7, 0);
+        const Vector3 home(static_cast<float>(i), 0.0f, 1.0f);
+        const float threat = static_cast<float>(i % 97);
+        legacy[i].data["target"] = target;
+        legacy[i].data["home"] = home;
+        legacy[i].data["threat"] = threat;
+        boards[i].Set(kTarget, target);
+        boards[i].Set(kHome, home);
+        boards[i].Set(kThreat, threat);
+    }
+
+    double legacySum = 0.0;
+    const double legacyNs = timeReads(
+        [&](uint32_t i) {
+            auto& bb = legacy[i];
+            return static_cast<double>(bb.Get<Entity>("target")->id()) +
+                   bb.Get<Vector3>("home")->x + *bb.Get<float>("threat");
+        },
+        legacySum);
+
+    double stringSum = 0.0;
+    const double stringNs = timeReads(
+        [&](uint32_t i) {
+            auto& bb = boards[i];
+            return static_cast<double>(bb.Get<Entity>("target")->id()) +
+                   bb.Get<Vector3>("home")->x + *bb.Get<float>("threat");
+        },
+        stringSum);
+
+    double keySum = 0.0;
+    const double keyNs = timeReads(
+        [&](uint32_t i) {
+            auto& bb = boards[i];
+            return static_cast<double>(bb.Get(kTarget)->id()) + bb.Get(kHome)->x +
+                   *bb.Get(kThreat);
+        },
+        keySum);
+
+    EXPECT_EQ(legacySum, keySum);
+    EXPECT_EQ(stringSum, keySum);
+    EXPECT_TRUE(boards[0].IsInline());
+
+    const double reads = 3.0 * kAgents * kPasses;
+    std::cout << "\n"
+              << "+------------------------+-------------+---------+\n"
+              << "| Lookup                 | ns per read | speedup |\n"
+              << "+------------------------+-------------+---------+\n"
+              << std::fixed << std::setprecision(2) << "| string -> std::any map | "
+              << std::setw(11) << legacyNs / reads << " |   1.00x |\n"
+              << "| Blackboard, string key | " << std::setw(11) << stringNs / reads << " | "
+              << std::setw(6) << legacyNs / stringNs << "x |\n"
+              << "| Blackboard, interned   | " << std::setw(11) << keyNs / reads << " | "
+              << std::setw(6) << legacyNs / keyNs << "x |\n"
+              << "+------------------------+-------------+---------+\n"
+              << std::endl;
+}
@@ -0,0 +1,138 @@
+/// @file equipment_stats_benchmark_test.cpp
+/// @brief Cached EquipmentStats versus recomputing bonuses on every read.
+///
+/// 5k geared players (200 item templates), each read as a damage victim 4 times per tick,
+/// with 1% of them swapping an item per tick.  Baseline: the former
+/// CalculateStatBonuses(vector) on every read.  Cached: InventorySystem
+/// applies the swaps as deltas and reads hit EquipmentStats directly.
+///
+/// Acceptance criterion: cached bonuses equal a full recompute for every
+/// player after the run.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "cgs/ecs/component_storage.hpp"
+#include "cgs/game/inventory_system.hpp"
+
+using namespace cgs::ecs;
+using namespace cgs::game;
+
+namespace {
+
+constexpr uint32_t kPlayers = 5000;
+constexpr uint32_t kItemTemplates = 200;
+constexpr int kTicks = 5;
+constexpr uint32_t kReadsPerPlayer = 4;
+constexpr uint32_t kSwapsPerTick = kPlayers / 100;
+
+std::vector<ItemTemplate> makeTemplates() {
+    std::vector<ItemTemplate> templates(kItemTemplates);
+    for (uint32_t i = 0; i < kItemTemplates; ++i) {
+        templates[i].id = i + 1;
+        templates[i].equipSlot = static_cast<EquipSlot>(i % kEquipSlotCount);
+        templates[i].statBonuses.armor = static_cast<int32_t>(i % 50);
+        templates[i].statBonuses.attributes[1] = static_cast<int32_t>(i % 7);
+    }
+    return templates;
+}
+
+InventorySlot itemFor(uint32_t templateId) {
+    InventorySlot slot;
+    slot.itemId = templateId;
+    slot.count = 1;
+    return slot;
+}
+
+}  // anonymous namespace
+
+TEST(EquipmentStatsBenchmark, CachedVersusRecomputedOnRead) {
+    const auto templates = makeTemplates();
+    ComponentStorage<Inventory> inventories;
+    ComponentStorage<Equipment> equipment;
+    ComponentStorage<DurabilityEvent> events;
+    ComponentStorage<EquipmentStats> gear;
+    InventorySystem system(inventories, equipment, events);
+    system.SetTemplates(ItemTemplateDatabase::Build(templates));
+
+    std::mt19937 rng(39);
+    for (uint32_t p = 0; p < kPlayers; ++p) {
+        auto& equip = equipment.Add(Entity(p, 0));
+        for (std::size_t s = 0; s < kEquipSlotCount; ++s) {
+            equip.Equip(static_cast<EquipSlot>(s),
+                        itemFor(static_cast<uint32_t>(s + 1 + kEquipSlotCount * (rng() % 20))));
+        }
+    }
+    std::vector<std::pair<uint32_t, uint32_t>> swaps;  // (player, template)
+    for (uint32_t i = 0; i < kSwapsPerTick * kTicks; ++i) {
+        swaps.emplace_back(rng() % kPlayers, 1 + rng() % kItemTemplates);
+    }
+
+    // Baseline: plain Equipment writes, full recompute per read.
+    int64_t baselineSum = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int tick = 0; tick < kTicks; ++tick) {
+        for (uint32_t i = 0; i < kSwapsPerTick; ++i) {
+            const auto [player, tmpl] = swaps[static_cast<std::size_t>(tick) * kSwapsPerTick + i];
+            equipment.Get(Entity(player, 0))
+                .Equip(templates[tmpl - 1].equipSlot, itemFor(tmpl));
+        }
+        for (uint32_t p = 0; p < kPlayers; ++p) {
+            for (uint32_t r = 0; r < kReadsPerPlayer; ++r) {
+                baselineSum += equipment.Get(Entity(p, 0)).CalculateStatBonuses(templates).armor;
+            }
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    const double baselineMs = std::chrono::duration<double, std::milli>(end - start).count();
+
+    // Cached: attach once (one full fill), then deltas plus reads.
+    system.SetEquipmentStats(&gear);
+    system.Execute(0.0f);
+    int64_t cachedSum = 0;
+    start = std::chrono::high_resolution_clock::now();
+    for (int tick = 0; tick < kTicks; ++tick) {
+        for (uint32_t i = 0; i < kSwapsPerTick; ++i) {
+            const auto [player, tmpl] = swaps[static_cast<std::size_t>(tick) * kSwapsPerTick + i];
+            system.Equip(Entity(player, 0), templates[tmpl - 1].equipSlot, itemFor(tmpl));
+        }
+        system.Execute(0.05f);
+        for (uint32_t p = 0; p < kPlayers; ++p) {
+            for (uint32_t r = 0; r < kReadsPerPlayer; ++r) {
+                cachedSum += gear.Get(Entity(p, 0)).bonuses.armor;
+            }
+        }
+    }
+    end = std::chrono::high_resolution_clock::now();
+    const double cachedMs = std::chrono::duration<double, std::milli>(end - start).count();
+
+    std::size_t mismatches = 0;
+    for (uint32_t p = 0; p < kPlayers; ++p) {
+        const Entity e(p, 0);
+        if (!(gear.Get(e).bonuses ==
+              equipment.Get(e).CalculateStatBonuses(*system.GetTemplateDatabase()))) {
+            ++mismatches;
+        }
+    }
+    EXPECT_EQ(mismatches, 0u);
+    EXPECT_GT(cachedSum, 0);
+    EXPECT_GT(baselineSum, 0);
+
+    std::cout << "\n"
+              << "+----------+------------------+----------------+---------+\n"
+              << "| Players  | recompute (ms/t) | cached (ms/t)  | speedup |\n"
+              << "+----------+------------------+----------------+---------+\n"
+              << "| " << std::setw(8) << kPlayers << " | " << std::setw(16) << std::fixed
+              << std::setprecision(3) << baselineMs / kTicks << " | " << std::setw(14)
+              << cachedMs / kTicks << " | " << std::setw(6) << std::setprecision(1)
+              << baselineMs / cachedMs << "x |\n"
+              << "+----------+------------------+----------------+---------+\n"
+              << std::endl;
+}
@@ -0,0 +1,174 @@
+/// @file pathfinding_benchmark_test.cpp
+/// @brief PathfindingService coalescing and hierarchical search cost.
+///
+/// A 512x512 map with 20% random obstacles.  Two scenarios:
+///   - a pack of 32 mobs chasing one player: one FindGridPath() each
+///     versus one coalesced PathfindingService batch;
+///   - 50 long cross-map paths: FindGridPath() versus the service's
+///     cluster-corridor search (cache disabled).
+///
+/// Acceptance criterion: every service path is found where A* finds
+/// one, the pack runs one search, and hierarchical paths stay within
+/// 10% of optimal on average.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "cgs/game/pathfinding.hpp"
+
+using namespace cgs::game;
+
+namespace {
+
+constexpr uint32_t kMapCells = 512;
+constexpr int kPackSize = 32;
+constexpr int kLongPaths = 50;
+
+NavGrid makeMap() {
+    std::mt19937 rng(37);
+    NavGrid grid(kMapCells, kMapCells);
+    for (int32_t y = 0; y < static_cast<int32_t>(kMapCells); ++y) {
+        for (int32_t x = 0; x < static_cast<int32_t>(kMapCells); ++x) {
+            if (rng() % 5 == 0) {
+                grid.SetWalkable({x, y}, false);
+            }
+        }
+    }
+    return grid;
+}
+
+NavCell randomWalkable(const NavGrid& grid, std::mt19937& rng, int32_t minX, int32_t maxX) {
+    std::uniform_int_distribution<int32_t> xs(minX, maxX);
+    std::uniform_int_distribution<int32_t> ys(0, static_cast<int32_t>(kMapCells) - 1);
+    for (;;) {
+        const NavCell cell{xs(rng), ys(rng)};
+        if (grid.IsWalkable(cell)) {
+            return cell;
+        }
+    }
+}
+
+float cellPathLength(NavCell from, const std::vector<NavCell>& cells) {
+    float length = 0.0f;
+    for (const auto& cell : cells) {
+        length += (cell.x != from.x && cell.y != from.y) ? std::sqrt(2.0f) : 1.0f;
+        from = cell;
+    }
+    return length;
+}
+
+float polylineLength(Vector3 from, const std::vector<Vector3>& waypoints) {
+    float length = 0.0f;
+    for (const auto& point : waypoints) {
+        length += (point - from).Length();
+        from = point;
+    }
+    return length;
+}
+
+double msSince(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() -
+                                                     start)
+        .count();
+}
+
+void printRow(const char* name, double baselineMs, double serviceMs) {
+    std::cout << "| " << std::left << std::setw(20) << name << std::right << " | "
+              << std::setw(11) << std::fixed << std::setprecision(2) << baselineMs << " | "
+              << std::setw(11) << serviceMs << " | " << std::setw(6) << baselineMs / serviceMs
+              << "x |\n";
+}
+
+}  // anonymous namespace
+
+TEST(PathfindingBenchmark, PackCoalescingAndHierarchicalSearch) {
+    const NavGrid grid = makeMap();
+    std::mt19937 rng(5);
+
+    // -- Pack chasing one target ---------------------------------------------
+    const NavCell target = randomWalkable(grid, rng, 400, 480);
+    std::vector<NavCell> pack;
+    for (int i = 0; i < kPackSize; ++i) {
+        pack.push_back(randomWalkable(grid, rng, 20, 120));
+    }
+
+    std::vector<NavCell> cells;
+    std::vector<uint8_t> reachable;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (const auto& cell : pack) {
+        reachable.push_back(FindGridPath(grid, cell, target, cells) ? 1 : 0);
+    }
+    const double packAStarMs = msSince(start);
+
+    PathfindingService packService(grid);
+    std::vector<PathRequestId> ids;
+    start = std::chrono::high_resolution_clock::now();
+    for (const auto& cell : pack) {
+        ids.push_back(packService.Request(grid.CenterOf(cell), grid.CenterOf(target)));
+    }
+    packService.Update();
+    packService.Update();
+    const double packServiceMs = msSince(start);
+    EXPECT_EQ(packService.SearchCount(), 1u);
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        std::vector<Vector3> path;
+        EXPECT_EQ(packService.Poll(ids[i], path) == PathStatus::Ready, reachable[i] != 0) << i;
+    }
+
+    // -- Long cross-map paths ------------------------------------------------
+    std::vector<std::pair<NavCell, NavCell>> pairs;
+    for (int i = 0; i < kLongPaths; ++i) {
+        pairs.emplace_back(randomWalkable(grid, rng, 0, 60), randomWalkable(grid, rng, 450, 511));
+    }
+
+    std::vector<float> optimal;
+    start = std::chrono::high_resolution_clock::now();
+    for (const auto& [from, to] : pairs) {
+        optimal.push_back(FindGridPath(grid, from, to, cells) ? cellPathLength(from, cells)
+                                                              : -1.0f);
+    }
+    const double longAStarMs = msSince(start);
+
+    PathfindingService longService(grid, 0);
+    ids.clear();
+    start = std::chrono::high_resolution_clock::now();
+    for (const auto& [from, to] : pairs) {
+        ids.push_back(longService.Request(grid.CenterOf(from), grid.CenterOf(to)));
+    }
+    longService.Update();
+    longService.Update();
+    const double longServiceMs = msSince(start);
+
+    double ratioSum = 0.0;
+    int found = 0;
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        std::vector<Vector3> path;
+        const PathStatus status = longService.Poll(ids[i], path);
+        ASSERT_EQ(status == PathStatus::Ready, optimal[i] >= 0.0f) << i;
+        if (status == PathStatus::Ready) {
+            ratioSum += polylineLength(grid.CenterOf(pairs[i].first), path) / optimal[i];
+            ++found;
+        }
+    }
+    ASSERT_GT(found, 0);
+    const double meanRatio = ratioSum / found;
+    EXPECT_LE(meanRatio, 1.1);
+
+    std::cout << "\n"
+              << "+----------------------+-------------+-------------+---------+\n"
+              << "| Scenario             | A* (ms)     | service (ms)| speedup |\n"
+              << "+----------------------+-------------+-------------+---------+\n";
+    printRow("pack of 32, 1 target", packAStarMs, packServiceMs);
+    printRow("50 long paths", longAStarMs, longServiceMs);
+    std::cout << "+----------------------+-------------+-------------+---------+\n"
+              << "hierarchical length / optimal: " << std::setprecision(3) << meanRatio << "\n"
+              << std::endl;
+}
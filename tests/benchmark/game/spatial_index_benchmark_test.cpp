@@ -0,0 +1,199 @@
+/// @file spatial_index_benchmark_test.cpp
+/// @brief Radius query cost of single-level vs two-level SpatialIndex grids.
+///
+/// Sweeps entity density and query radius over three grid layouts so the
+/// MapInstance::cellSize / coarseFactor of a map can be picked from data:
+///
+///   - fine:      16-unit cells (kDefaultCellSize)
+///   - coarse:    64-unit cells
+///   - two-level: 16-unit cells, 8 x 8 per coarse cell
+///
+/// Melee-sized radii favour fine cells; visibility-sized radii over a
+/// fine grid probe hundreds of cells, which the two-level grid avoids.
+///
+/// A second sweep compares QueryNearest() against the QueryRadius() +
+/// sort it replaces for k-nearest target selection.
+///
+/// Acceptance criterion: every layout returns the same entities, and
+/// QueryNearest() returns the same k entities as the sorted radius query.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "cgs/ecs/entity.hpp"
+#include "cgs/game/math_types.hpp"
+#include "cgs/game/spatial_index.hpp"
+
+using namespace cgs::ecs;
+using namespace cgs::game;
+
+namespace {
+
+// Benchmark parameters
+constexpr float kWorldExtent = 2048.0f;  // square map, centred on the origin
+constexpr int kQueriesPerRun = 200;
+constexpr int kDensities[] = {2'000, 20'000, 100'000};
+constexpr float kRadii[] = {5.0f, 25.0f, 100.0f, 200.0f};
+
+struct Layout {
+    const char* name;
+    float cellSize;
+    uint32_t coarseFactor;
+};
+
+constexpr Layout kLayouts[] = {
+    {"fine", 16.0f, 0},
+    {"coarse", 64.0f, 0},
+    {"two-level", 16.0f, 8},
+};
+
+} // anonymous namespace
+
+// ===========================================================================
+// Density x Radius Sweep
+// ===========================================================================
+
+TEST(SpatialIndexBenchmark, RadiusQueryDensitySweep) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> coord(-kWorldExtent / 2.0f, kWorldExtent / 2.0f);
+
+    std::vector<Vector3> centers;
+    centers.reserve(static_cast<std::size_t>(kQueriesPerRun));
+    for (int i = 0; i < kQueriesPerRun; ++i) {
+        centers.emplace_back(coord(rng), 0.0f, coord(rng));
+    }
+
+    std::cout << "\n"
+              << "+-----------+-----------+--------+--------------+-----------+\n"
+              << "|  Entities |  Layout   | Radius |  us / query  |  Matches  |\n"
+              << "+-----------+-----------+--------+--------------+-----------+\n";
+
+    for (const int density : kDensities) {
+        std::vector<Vector3> positions;
+        positions.reserve(static_cast<std::size_t>(density));
+        for (int i = 0; i < density; ++i) {
+            positions.emplace_back(coord(rng), 0.0f, coord(rng));
+        }
+
+        for (const float radius : kRadii) {
+            std::size_t referenceMatches = 0;
+            for (std::size_t l = 0; l < std::size(kLayouts); ++l) {
+                const Layout& layout = kLayouts[l];
+                SpatialIndex index(layout.cellSize, layout.coarseFactor);
+                for (std::size_t i = 0; i < positions.size(); ++i) {
+                    index.Insert(Entity(static_cast<uint32_t>(i), 0), positions[i]);
+                }
+
+                std::vector<Entity> results;
+                std::size_t matches = 0;
+                const auto start = std::chrono::high_resolution_clock::now();
+                for (const Vector3& center : centers) {
+                    results.clear();
+                    index.QueryRadius(center, radius, results);
+                    matches += results.size();
+                }
+                const auto end = std::chrono::high_resolution_clock::now();
+                const double usPerQuery =
+                    std::chrono::duration<double, std::micro>(end - start).count() /
+                    static_cast<double>(kQueriesPerRun);
+
+                if (l == 0) {
+                    referenceMatches = matches;
+                }
+                EXPECT_EQ(matches, referenceMatches)
+                    << layout.name << " at density " << density << ", radius " << radius;
+
+                std::cout << "| " << std::setw(9) << density << " | " << std::setw(9)
+                          << layout.name << " | " << std::setw(6) << std::fixed
+                          << std::setprecision(0) << radius << " | " << std::setw(12)
+                          << std::setprecision(2) << usPerQuery << " | " << std::setw(9)
+                          << matches / static_cast<std::size_t>(kQueriesPerRun) << " |\n";
+            }
+        }
+        std::cout << "+-----------+-----------+--------+--------------+-----------+\n";
+    }
+    std::cout << std::endl;
+}
+
+// ===========================================================================
+// k-Nearest vs Radius + Sort
+// ===========================================================================
+
+TEST(SpatialIndexBenchmark, NearestVersusRadiusAndSort) {
+    constexpr float kSearchRadius = 200.0f;
+    constexpr std::size_t kNeighbours[] = {1, 8};
+
+    std::mt19937 rng(43);
+    std::uniform_real_distribution<float> coord(-kWorldExtent / 2.0f, kWorldExtent / 2.0f);
+
+    std::vector<Vector3> centers;
+    centers.reserve(static_cast<std::size_t>(kQueriesPerRun));
+    for (int i = 0; i < kQueriesPerRun; ++i) {
+        centers.emplace_back(coord(rng), 0.0f, coord(rng));
+    }
+
+    std::cout << "\n"
+              << "+-----------+-----+------------------+-------------------+\n"
+              << "|  Entities |  k  | radius+sort (us) | QueryNearest (us) |\n"
+              << "+-----------+-----+------------------+-------------------+\n";
+
+    for (const int density : kDensities) {
+        SpatialIndex index(16.0f);
+        std::vector<Vector3> positions;
+        positions.reserve(static_cast<std::size_t>(density));
+        for (int i = 0; i < density; ++i) {
+            positions.emplace_back(coord(rng), 0.0f, coord(rng));
+            index.Insert(Entity(static_cast<uint32_t>(i), 0), positions.back());
+        }
+        const auto distSq = [&](Entity entity, const Vector3& center) {
+            const Vector3& p = positions[entity.id()];
+            return (p.x - center.x) * (p.x - center.x) + (p.z - center.z) * (p.z - center.z);
+        };
+
+        for (const std::size_t k : kNeighbours) {
+            std::vector<Entity> sorted;
+            std::vector<Entity> nearest;
+            std::size_t mismatches = 0;
+            double sortUs = 0.0;
+            double nearestUs = 0.0;
+            for (const Vector3& center : centers) {
+                auto start = std::chrono::high_resolution_clock::now();
+                sorted.clear();
+                index.QueryRadius(center, kSearchRadius, sorted);
+                std::sort(sorted.begin(), sorted.end(), [&](Entity lhs, Entity rhs) {
+                    return distSq(lhs, center) < distSq(rhs, center);
+                });
+                sorted.resize(std::min(sorted.size(), k));
+                auto end = std::chrono::high_resolution_clock::now();
+                sortUs += std::chrono::duration<double, std::micro>(end - start).count();
+
+                start = std::chrono::high_resolution_clock::now();
+                nearest.clear();
+                index.QueryNearest(center, k, nearest, [](Entity) { return true; },
+                                   kSearchRadius);
+                end = std::chrono::high_resolution_clock::now();
+                nearestUs += std::chrono::duration<double, std::micro>(end - start).count();
+
+                if (nearest != sorted) {
+                    ++mismatches;
+                }
+            }
+            EXPECT_EQ(mismatches, 0u) << "density " << density << ", k " << k;
+
+            const auto queries = static_cast<double>(kQueriesPerRun);
+            std::cout << "| " << std::setw(9) << density << " | " << std::setw(3) << k << " | "
+                      << std::setw(16) << std::fixed << std::setprecision(2) << sortUs / queries
+                      << " | " << std::setw(17) << nearestUs / queries << " |\n";
+        }
+    }
+    std::cout << "+-----------+-----+------------------+-------------------+\n" << std::endl;
+}
@@ -0,0 +1,113 @@
+/// @file threat_list_benchmark_test.cpp
+/// @brief AddThreat + GetTopThreat cost of ThreatList versus re-sorting.
+///
+/// Every damage event adds threat on the victim and AI target selection
+/// reads its top threat.  The previous ThreatList searched its entries
+/// linearly and re-sorted them on every AddThreat(); the indexed
+/// max-heap sifts a single entry.  Swept over 5 (dungeon pull),
+/// 40 (raid) and 200 (world boss) attackers.
+///
+/// Acceptance criterion: both structures report the same top threat
+/// after every hit.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "cgs/ecs/entity.hpp"
+#include "cgs/game/combat_components.hpp"
+
+using namespace cgs::ecs;
+using namespace cgs::game;
+
+namespace {
+
+constexpr std::size_t kHitsPerRun = 50'000;
+constexpr uint32_t kAttackerCounts[] = {5, 40, 200};
+
+/// The sort-on-every-add list ThreatList replaced.
+struct SortedThreatList {
+    std::vector<ThreatEntry> entries;
+
+    void AddThreat(Entity source, float amount) {
+        auto it = std::find_if(entries.begin(), entries.end(), [source](const ThreatEntry& e) {
+            return e.source == source;
+        });
+        if (it != entries.end()) {
+            it->threat += amount;
+        } else {
+            entries.push_back({source, amount});
+        }
+        std::sort(entries.begin(), entries.end(), [](const ThreatEntry& a, const ThreatEntry& b) {
+            return a.threat > b.threat;
+        });
+    }
+
+    [[nodiscard]] float TopThreat() const { return entries.front().threat; }
+};
+
+} // anonymous namespace
+
+TEST(ThreatListBenchmark, HeapVersusSortPerHit) {
+    std::cout << "\n"
+              << "+-----------+---------------+---------------+---------+\n"
+              << "| Attackers | sorted (ns/h) |  heap (ns/h)  | speedup |\n"
+              << "+-----------+---------------+---------------+---------+\n";
+
+    for (const uint32_t attackers : kAttackerCounts) {
+        std::mt19937 rng(attackers);
+        std::uniform_int_distribution<uint32_t> pick(0, attackers - 1);
+        std::uniform_real_distribution<float> damage(50.0f, 500.0f);
+        std::vector<Entity> sources;
+        std::vector<float> amounts;
+        sources.reserve(kHitsPerRun);
+        amounts.reserve(kHitsPerRun);
+        for (std::size_t i = 0; i < kHitsPerRun; ++i) {
+            sources.emplace_back(pick(rng), 0);
+            amounts.push_back(damage(rng));
+        }
+
+        SortedThreatList sorted;
+        std::vector<float> sortedTops(kHitsPerRun);
+        auto start = std::chrono::high_resolution_clock::now();
+        for (std::size_t i = 0; i < kHitsPerRun; ++i) {
+            sorted.AddThreat(sources[i], amounts[i]);
+            sortedTops[i] = sorted.TopThreat();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        const double sortedNs = std::chrono::duration<double, std::nano>(end - start).count();
+
+        ThreatList heap;
+        std::vector<float> heapTops(kHitsPerRun);
+        start = std::chrono::high_resolution_clock::now();
+        for (std::size_t i = 0; i < kHitsPerRun; ++i) {
+            heap.AddThreat(sources[i], amounts[i]);
+            heapTops[i] = heap.GetThreat(heap.GetTopThreat());
+        }
+        end = std::chrono::high_resolution_clock::now();
+        const double heapNs = std::chrono::duration<double, std::nano>(end - start).count();
+
+        std::size_t mismatches = 0;
+        for (std::size_t i = 0; i < kHitsPerRun; ++i) {
+            if (sortedTops[i] != heapTops[i]) {
+                ++mismatches;
+            }
+        }
+        EXPECT_EQ(mismatches, 0u) << attackers << " attackers";
+        EXPECT_EQ(heap.Size(), sorted.entries.size());
+
+        const auto hits = static_cast<double>(kHitsPerRun);
+        std::cout << "| " << std::setw(9) << attackers << " | " << std::setw(13) << std::fixed
+                  << std::setprecision(1) << sortedNs / hits << " | " << std::setw(13)
+                  << heapNs / hits << " | " << std::setw(6) << std::setprecision(2)
+                  << sortedNs / heapNs << "x |\n";
+    }
+    std::cout << "+-----------+---------------+---------------+---------+\n" << std::endl;
+}
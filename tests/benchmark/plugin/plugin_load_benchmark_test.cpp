@@ -18,9 +18,12 @@
 #include <iostream>
 #include <numeric>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "cgs/plugin/mmorpg_plugin.hpp"
+#include "cgs/plugin/plugin_export.hpp"
+#include "cgs/plugin/plugin_manager.hpp"
 
 using namespace cgs::plugin;
 
@@ -259,3 +262,104 @@ TEST_F(PluginLoadBenchmark, LoadUnloadCycleStability) {
         << "p99 load/unload cycle " << p99Ms
         << " ms exceeds the " << kMaxLoadTimeMs << " ms requirement";
 }
+
+// ===========================================================================
+// Manager Startup with Content Plugins (level-parallel init, lazy map types)
+// ===========================================================================
+
+namespace {
+
+/// Content plugin whose OnInit() does a fixed amount of blocking work
+/// (loading data files, building tables).
+class ContentPlugin : public IPlugin {
+public:
+    explicit ContentPlugin(PluginInfo info) : info_(std::move(info)) {}
+
+    const PluginInfo& GetInfo() const override { return info_; }
+    bool OnLoad(PluginContext& /*ctx*/) override { return true; }
+    bool OnInit() override {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        return true;
+    }
+    void OnUpdate(float /*deltaTime*/) override {}
+    void OnShutdown() override {}
+    void OnUnload() override {}
+
+private:
+    PluginInfo info_;
+};
+
+constexpr int kContentPlugins = 8;
+
+/// Median InitializeAll() + ActivateAll() time of MMORPGPlugin plus
+/// kContentPlugins independent content plugins depending on it.
+double medianStartupMs(bool parallel, bool lazyDungeons) {
+    constexpr int kRuns = 15;
+    std::vector<double> latencies;
+    for (int run = 0; run < kRuns; ++run) {
+        PluginManager mgr;
+        auto& registry = StaticPluginRegistry();
+        auto saved = std::move(registry);
+        registry.clear();
+        registry.push_back({"MMORPGPlugin", [] { return std::make_unique<MMORPGPlugin>(); }});
+        for (int i = 0; i < kContentPlugins; ++i) {
+            PluginInfo info{"Content" + std::to_string(i), "", {1, 0, 0}, {"MMORPGPlugin"},
+                            kPluginApiVersion};
+            info.threadSafeInit = true;
+            if (lazyDungeons && i % 2 == 1) {
+                info.mapTypes = {"dungeon"};
+            }
+            registry.push_back(
+                {info.name, [info] { return std::make_unique<ContentPlugin>(info); }});
+        }
+        auto loaded = mgr.RegisterStaticPlugins();
+        registry = std::move(saved);
+        EXPECT_TRUE(loaded.hasValue());
+
+        if (parallel) {
+            mgr.SetParallelExecutor([](const std::vector<std::function<void()>>& tasks) {
+                std::vector<std::thread> threads;
+                threads.reserve(tasks.size());
+                for (const auto& task : tasks) {
+                    threads.emplace_back(task);
+                }
+                for (auto& thread : threads) {
+                    thread.join();
+                }
+            });
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+        EXPECT_TRUE(mgr.InitializeAll().hasValue());
+        EXPECT_TRUE(mgr.ActivateAll().hasValue());
+        auto end = std::chrono::high_resolution_clock::now();
+        latencies.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    std::sort(latencies.begin(), latencies.end());
+    return latencies[latencies.size() / 2];
+}
+
+} // anonymous namespace
+
+TEST_F(PluginLoadBenchmark, ManagerStartupWithContentPlugins) {
+    const double serialMs = medianStartupMs(false, false);
+    const double parallelMs = medianStartupMs(true, false);
+    const double lazyMs = medianStartupMs(true, true);
+
+    std::cout << "\n"
+              << "+-------------------------------------------------+\n"
+              << "|  Manager Startup: MMORPGPlugin + " << std::setw(2) << kContentPlugins
+              << " content     |\n"
+              << "+-------------------------------------------------+\n"
+              << "|  Serial init:   " << std::setw(10) << std::fixed
+              << std::setprecision(4) << serialMs << " ms               |\n"
+              << "|  By level:      " << std::setw(10) << parallelMs
+              << " ms               |\n"
+              << "|  + lazy maps:   " << std::setw(10) << lazyMs
+              << " ms               |\n"
+              << "+-------------------------------------------------+\n"
+              << std::endl;
+
+    // The content plugins form one level: their inits overlap.
+    EXPECT_LT(parallelMs, serialMs);
+}
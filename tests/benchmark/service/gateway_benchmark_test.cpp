@@ -0,0 +1,517 @@
+/// @file gateway_benchmark_test.cpp
+/// @brief End-to-end throughput benchmark for GatewayServer and AuthServer.
+///
+/// Drives the gateway's per-connection and per-packet paths in process,
+/// without sockets, to size gateway fleets (SRS-NFR-003: 300,000+ msg/sec
+/// per cluster) and catch regressions:
+///   1. Connect/disconnect rate (connects/sec)
+///   2. Authenticate at scale with HS256 and RS256 tokens, with the
+///      verified-token cache on and off (validations/sec)
+///   3. Authenticated message routing per core: sessionId lookups,
+///      resolved session handles and receive-buffer views, then 1-N
+///      threads (messages/sec/core)
+///   4. Rate limiting under a flood (decisions/sec)
+///   5. Login burst through AuthServer::login() (logins/sec, p50/p99)
+///
+/// Acceptance criteria are deliberately loose floors that only fail on
+/// an order-of-magnitude regression; the printed rates are the result.
+
+#include <gtest/gtest.h>
+
+#include <openssl/bio.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/rsa.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "cgs/foundation/error_code.hpp"
+#include "cgs/foundation/types.hpp"
+#include "cgs/service/auth_server.hpp"
+#include "cgs/service/gateway_server.hpp"
+#include "cgs/service/gateway_types.hpp"
+#include "cgs/service/token_store.hpp"
+#include "cgs/service/user_repository.hpp"
+
+using namespace cgs::service;
+using namespace cgs::foundation;
+using namespace std::chrono;
+
+namespace {
+
+constexpr uint32_t kSessions = 10000;
+constexpr uint32_t kUsers = 500;
+constexpr uint32_t kMessagesPerThread = 500000;
+constexpr uint16_t kGameOpcode = 0x0150;
+constexpr const char* kPassword = "BenchPass1!";
+
+// Floors (an order of magnitude under a 2020s server core).
+constexpr double kMinConnectsPerSec = 20000.0;
+constexpr double kMinHs256ValidationsPerSec = 10000.0;
+constexpr double kMinRs256ValidationsPerSec = 1000.0;
+constexpr double kMinMessagesPerSecPerCore = 100000.0;
+constexpr double kMinLoginsPerSec = 200.0;
+
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    auto idx = static_cast<std::size_t>(p / 100.0 * static_cast<double>(sorted.size() - 1));
+    return sorted[idx];
+}
+
+double secondsSince(steady_clock::time_point start) {
+    return static_cast<double>(duration_cast<microseconds>(steady_clock::now() - start).count()) /
+           1e6;
+}
+
+std::string remoteAddress(uint32_t i) {
+    return "10." + std::to_string((i >> 16) & 0xFF) + "." + std::to_string((i >> 8) & 0xFF) +
+           "." + std::to_string(i & 0xFF);
+}
+
+std::string evpPkeyToPem(EVP_PKEY* pkey, bool isPrivate) {
+    BIO* bio = BIO_new(BIO_s_mem());
+    if (isPrivate) {
+        PEM_write_bio_PrivateKey(bio, pkey, nullptr, nullptr, 0, nullptr, nullptr);
+    } else {
+        PEM_write_bio_PUBKEY(bio, pkey);
+    }
+    char* data = nullptr;
+    auto len = BIO_get_mem_data(bio, &data);
+    std::string pem(data, static_cast<std::size_t>(len));
+    BIO_free(bio);
+    return pem;
+}
+
+/// 2048-bit RSA keypair generated once per process: {private, public}.
+const std::pair<std::string, std::string>& rsaKeypair() {
+    static const auto kp = [] {
+        EVP_PKEY* pkey = EVP_RSA_gen(2048);
+        std::pair<std::string, std::string> pems{evpPkeyToPem(pkey, true),
+                                                 evpPkeyToPem(pkey, false)};
+        EVP_PKEY_free(pkey);
+        return pems;
+    }();
+    return kp;
+}
+
+AuthConfig authConfig(JwtAlgorithm algorithm, std::size_t tokenCacheCapacity) {
+    AuthConfig config;
+    config.signingKey = "gateway-benchmark-key-at-least-32-bytes!";
+    config.jwtAlgorithm = algorithm;
+    if (algorithm == JwtAlgorithm::RS256) {
+        config.rsaPrivateKeyPem = rsaKeypair().first;
+        config.rsaPublicKeyPem = rsaKeypair().second;
+    }
+    config.tokenCacheCapacity = tokenCacheCapacity;
+    config.rateLimitMaxAttempts = 1000;
+    return config;
+}
+
+GatewayConfig gatewayConfig(uint32_t rateLimitCapacity, uint32_t rateLimitRefillRate) {
+    GatewayConfig config;
+    config.maxConnections = kSessions * 2;
+    config.rateLimitCapacity = rateLimitCapacity;
+    config.rateLimitRefillRate = rateLimitRefillRate;
+    config.authTimeout = seconds{600};
+    config.idleTimeout = seconds{600};
+    return config;
+}
+
+/// Gateway without a per-client rate limit in practice.
+GatewayConfig unlimitedGatewayConfig() {
+    return gatewayConfig(1'000'000'000, 1'000'000'000);
+}
+
+/// AuthServer with @p users registered users ("bench0", ...).
+std::shared_ptr<AuthServer> makeAuthServer(JwtAlgorithm algorithm,
+                                           std::size_t tokenCacheCapacity,
+                                           uint32_t users) {
+    auto server = std::make_shared<AuthServer>(authConfig(algorithm, tokenCacheCapacity),
+                                               std::make_shared<InMemoryUserRepository>(),
+                                               std::make_shared<InMemoryTokenStore>());
+    for (uint32_t i = 0; i < users; ++i) {
+        const auto name = "bench" + std::to_string(i);
+        EXPECT_TRUE(server->registerUser({name, name + "@bench.test", kPassword}).hasValue());
+    }
+    return server;
+}
+
+/// One access token per registered user.
+std::vector<std::vector<uint8_t>> loginAll(AuthServer& server, uint32_t users) {
+    std::vector<std::vector<uint8_t>> tokens;
+    tokens.reserve(users);
+    for (uint32_t i = 0; i < users; ++i) {
+        auto login = server.login("bench" + std::to_string(i), kPassword, remoteAddress(i));
+        EXPECT_TRUE(login.hasValue());
+        if (login.hasValue()) {
+            const auto& token = login.value().accessToken;
+            tokens.emplace_back(token.begin(), token.end());
+        }
+    }
+    return tokens;
+}
+
+/// Connect and authenticate sessions 1..@p sessions, cycling over @p tokens.
+void connectAuthenticated(GatewayServer& gateway,
+                          const std::vector<std::vector<uint8_t>>& tokens,
+                          uint32_t sessions) {
+    for (uint32_t i = 0; i < sessions; ++i) {
+        const SessionId sid(i + 1);
+        ASSERT_TRUE(gateway.handleConnect(sid, remoteAddress(i)).hasValue());
+        auto auth = gateway.handleMessage(sid, GatewayOpcode::Authenticate,
+                                          tokens[i % tokens.size()]);
+        ASSERT_TRUE(auth.hasValue());
+        ASSERT_EQ(auth.value().replyPayload.at(0), 0x00);
+    }
+}
+
+}  // anonymous namespace
+
+// ===========================================================================
+// Connect / Disconnect
+// ===========================================================================
+
+TEST(GatewayBenchmark, ConnectDisconnectRate) {
+    std::cout << "\n=== Gateway Connect Rate (" << kSessions << " sessions) ===" << std::endl;
+
+    GatewayServer gateway(unlimitedGatewayConfig(),
+                          makeAuthServer(JwtAlgorithm::HS256, 65536, 0));
+    gateway.addRoute(0x0100, 0x01FF, "game");
+    ASSERT_TRUE(gateway.start().hasValue());
+
+    std::vector<std::string> addresses;
+    addresses.reserve(kSessions);
+    for (uint32_t i = 0; i < kSessions; ++i) {
+        addresses.push_back(remoteAddress(i));
+    }
+
+    auto start = steady_clock::now();
+    for (uint32_t i = 0; i < kSessions; ++i) {
+        ASSERT_TRUE(gateway.handleConnect(SessionId(i + 1), addresses[i]).hasValue());
+    }
+    const double connectSec = secondsSince(start);
+    EXPECT_EQ(gateway.stats().totalConnections, kSessions);
+
+    start = steady_clock::now();
+    for (uint32_t i = 0; i < kSessions; ++i) {
+        gateway.handleDisconnect(SessionId(i + 1));
+    }
+    const double disconnectSec = secondsSince(start);
+    EXPECT_EQ(gateway.stats().totalConnections, 0u);
+
+    const double connectsPerSec = kSessions / connectSec;
+    std::cout << std::fixed << std::setprecision(0);
+    std::cout << "  Connects:    " << connectsPerSec << " /sec\n";
+    std::cout << "  Disconnects: " << kSessions / disconnectSec << " /sec\n";
+    EXPECT_GT(connectsPerSec, kMinConnectsPerSec);
+    gateway.stop();
+}
+
+// ===========================================================================
+// Authentication at scale
+// ===========================================================================
+
+namespace {
+
+/// Validations per second authenticating kSessions sessions.
+double authenticateRate(JwtAlgorithm algorithm, std::size_t tokenCacheCapacity) {
+    auto auth = makeAuthServer(algorithm, tokenCacheCapacity, kUsers);
+    const auto tokens = loginAll(*auth, kUsers);
+
+    GatewayServer gateway(unlimitedGatewayConfig(), auth);
+    gateway.addRoute(0x0100, 0x01FF, "game");
+    EXPECT_TRUE(gateway.start().hasValue());
+
+    const auto start = steady_clock::now();
+    connectAuthenticated(gateway, tokens, kSessions);
+    const double elapsed = secondsSince(start);
+
+    const auto stats = gateway.stats();
+    EXPECT_EQ(stats.authenticatedConnections, kSessions);
+    EXPECT_EQ(stats.authFailureCount, 0u);
+    gateway.stop();
+    return kSessions / elapsed;
+}
+
+}  // anonymous namespace
+
+TEST(GatewayBenchmark, AuthenticateHs256AndRs256) {
+    std::cout << "\n=== Gateway Authenticate (" << kSessions << " sessions, " << kUsers
+              << " tokens) ===" << std::endl;
+
+    const double hs256Cached = authenticateRate(JwtAlgorithm::HS256, 65536);
+    const double hs256 = authenticateRate(JwtAlgorithm::HS256, 0);
+    const double rs256Cached = authenticateRate(JwtAlgorithm::RS256, 65536);
+    const double rs256 = authenticateRate(JwtAlgorithm::RS256, 0);
+
+    std::cout << std::fixed << std::setprecision(0);
+    std::cout << "  (connect + Authenticate per session)\n";
+    std::cout << "  HS256 cached:   " << hs256Cached << " /sec\n";
+    std::cout << "  HS256 uncached: " << hs256 << " /sec\n";
+    std::cout << "  RS256 cached:   " << rs256Cached << " /sec\n";
+    std::cout << "  RS256 uncached: " << rs256 << " /sec\n";
+
+    EXPECT_GT(hs256, kMinHs256ValidationsPerSec);
+    EXPECT_GT(rs256, kMinRs256ValidationsPerSec);
+}
+
+// ===========================================================================
+// Authenticated routing per core
+// ===========================================================================
+
+class GatewayRoutingBenchmark : public ::testing::Test {
+protected:
+    static constexpr uint32_t kRoutingSessions = 1024;
+
+    void SetUp() override {
+        auto auth = makeAuthServer(JwtAlgorithm::HS256, 65536, 16);
+        gateway_ = std::make_unique<GatewayServer>(unlimitedGatewayConfig(), auth);
+        gateway_->addRoute(0x0100, 0x01FF, "game");
+        gateway_->addRoute(0x0200, 0x02FF, "lobby");
+        gateway_->addRoute(0x0300, 0x03FF, "chat");
+        ASSERT_TRUE(gateway_->start().hasValue());
+        connectAuthenticated(*gateway_, loginAll(*auth, 16), kRoutingSessions);
+    }
+
+    void TearDown() override { gateway_->stop(); }
+
+    /// Route kMessagesPerThread messages on each of @p threads threads,
+    /// each over its own slice of sessions; returns messages/sec.
+    double routeOnThreads(uint32_t threads) {
+        const uint64_t routedBefore = gateway_->stats().messagesRouted;
+        std::atomic<uint32_t> ready{0};
+        std::atomic<bool> go{false};
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for (uint32_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                std::vector<GatewaySessionHandle> handles;
+                for (uint32_t s = t; s < kRoutingSessions; s += threads) {
+                    handles.push_back(gateway_->sessionHandle(SessionId(s + 1)));
+                }
+                const std::vector<uint8_t> payload(64, 0x5A);
+                ready.fetch_add(1);
+                while (!go.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                for (uint32_t i = 0; i < kMessagesPerThread; ++i) {
+                    const auto& session = handles[i % handles.size()];
+                    auto action = gateway_->routeMessage(session, kGameOpcode, payload);
+                    if (!action.hasValue() || action.value().type != GatewayActionType::Forward) {
+                        ADD_FAILURE() << "message " << i << " not forwarded";
+                        return;
+                    }
+                }
+            });
+        }
+        while (ready.load() < threads) {
+            std::this_thread::yield();
+        }
+        const auto start = steady_clock::now();
+        go.store(true, std::memory_order_release);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        const double elapsed = secondsSince(start);
+        EXPECT_EQ(gateway_->stats().messagesRouted - routedBefore,
+                  uint64_t{threads} * kMessagesPerThread);
+        return threads * static_cast<double>(kMessagesPerThread) / elapsed;
+    }
+
+    std::unique_ptr<GatewayServer> gateway_;
+};
+
+TEST_F(GatewayRoutingBenchmark, SingleThreadPaths) {
+    std::cout << "\n=== Gateway Routing Paths (1 thread, " << kMessagesPerThread
+              << " messages) ===" << std::endl;
+
+    const std::vector<uint8_t> payload(64, 0x5A);
+    const auto handle = gateway_->sessionHandle(SessionId(1));
+
+    auto start = steady_clock::now();
+    for (uint32_t i = 0; i < kMessagesPerThread; ++i) {
+        auto action = gateway_->handleMessage(SessionId(i % kRoutingSessions + 1), kGameOpcode,
+                                              payload);
+        ASSERT_TRUE(action.hasValue());
+    }
+    const double bySessionId = kMessagesPerThread / secondsSince(start);
+
+    start = steady_clock::now();
+    for (uint32_t i = 0; i < kMessagesPerThread; ++i) {
+        auto action = gateway_->handleMessage(handle, kGameOpcode, payload);
+        ASSERT_TRUE(action.hasValue());
+    }
+    const double byHandle = kMessagesPerThread / secondsSince(start);
+
+    start = steady_clock::now();
+    for (uint32_t i = 0; i < kMessagesPerThread; ++i) {
+        auto action = gateway_->routeMessage(handle, kGameOpcode, std::span(payload));
+        ASSERT_TRUE(action.hasValue());
+    }
+    const double byView = kMessagesPerThread / secondsSince(start);
+
+    std::cout << std::fixed << std::setprecision(0);
+    std::cout << "  handleMessage(sessionId): " << bySessionId << " msg/sec\n";
+    std::cout << "  handleMessage(handle):    " << byHandle << " msg/sec\n";
+    std::cout << "  routeMessage(view):       " << byView << " msg/sec\n";
+    EXPECT_GT(byView, kMinMessagesPerSecPerCore);
+}
+
+TEST_F(GatewayRoutingBenchmark, MessagesPerSecPerCore) {
+    const uint32_t cores = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<uint32_t> threadCounts{1};
+    for (uint32_t t = 2; t <= std::min(cores, 16u); t *= 2) {
+        threadCounts.push_back(t);
+    }
+
+    std::cout << "\n=== Gateway Routing Scaling (" << cores << " cores) ===" << std::endl;
+    std::cout << "  threads   msg/sec       msg/sec/core\n";
+    double singleThread = 0.0;
+    for (uint32_t threads : threadCounts) {
+        const double rate = routeOnThreads(threads);
+        if (threads == 1) {
+            singleThread = rate;
+        }
+        std::cout << std::fixed << std::setprecision(0) << "  " << std::setw(7) << threads
+                  << "   " << std::setw(11) << rate << "   " << std::setw(11) << rate / threads
+                  << "\n";
+    }
+    EXPECT_GT(singleThread, kMinMessagesPerSecPerCore);
+}
+
+// ===========================================================================
+// Rate limiting under a flood
+// ===========================================================================
+
+TEST(GatewayBenchmark, RateLimitedFlood) {
+    constexpr uint32_t kFloodSessions = 100;
+    constexpr uint32_t kFloodMessages = 1000;
+    constexpr uint32_t kCapacity = 100;
+
+    std::cout << "\n=== Gateway Rate Limiting (" << kFloodSessions << " sessions x "
+              << kFloodMessages << " messages, burst " << kCapacity << ") ===" << std::endl;
+
+    auto auth = makeAuthServer(JwtAlgorithm::HS256, 65536, 1);
+    GatewayServer gateway(gatewayConfig(kCapacity, 50), auth);
+    gateway.addRoute(0x0100, 0x01FF, "game");
+    ASSERT_TRUE(gateway.start().hasValue());
+    // The Authenticate message takes one token of each bucket.
+    connectAuthenticated(gateway, loginAll(*auth, 1), kFloodSessions);
+
+    std::vector<GatewaySessionHandle> handles;
+    for (uint32_t s = 0; s < kFloodSessions; ++s) {
+        handles.push_back(gateway.sessionHandle(SessionId(s + 1)));
+    }
+    const std::vector<uint8_t> payload(64, 0x5A);
+
+    uint64_t limited = 0;
+    const auto start = steady_clock::now();
+    for (uint32_t i = 0; i < kFloodMessages; ++i) {
+        for (const auto& handle : handles) {
+            auto action = gateway.routeMessage(handle, kGameOpcode, payload);
+            if (action.hasError()) {
+                ASSERT_EQ(action.error().code(), ErrorCode::GatewayRateLimited);
+                ++limited;
+            }
+        }
+    }
+    const double elapsed = secondsSince(start);
+
+    const auto stats = gateway.stats();
+    const double decisions = static_cast<double>(kFloodSessions) * kFloodMessages;
+    std::cout << std::fixed << std::setprecision(0);
+    std::cout << "  Decisions: " << decisions / elapsed << " /sec\n";
+    std::cout << "  Routed:    " << stats.messagesRouted << "\n";
+    std::cout << "  Limited:   " << stats.rateLimitHits << "\n";
+
+    // Each session gets its burst plus what refills during the flood.
+    EXPECT_GT(limited, 0u);
+    EXPECT_EQ(stats.rateLimitHits, limited);
+    EXPECT_LT(stats.messagesRouted, static_cast<uint64_t>(decisions));
+    EXPECT_GT(decisions / elapsed, kMinMessagesPerSecPerCore);
+    gateway.stop();
+}
+
+// ===========================================================================
+// Login burst
+// ===========================================================================
+
+namespace {
+
+struct LoginBurstResult {
+    double loginsPerSec = 0.0;
+    double p50Ms = 0.0;
+    double p99Ms = 0.0;
+    uint32_t failures = 0;
+};
+
+/// Log every user in once from @p threads threads, distinct client IPs.
+LoginBurstResult loginBurst(AuthServer& server, uint32_t users, uint32_t threads) {
+    std::vector<std::vector<double>> latencies(threads);
+    std::atomic<uint32_t> failures{0};
+    std::vector<std::thread> workers;
+
+    const auto start = steady_clock::now();
+    for (uint32_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            for (uint32_t i = t; i < users; i += threads) {
+                const auto begin = steady_clock::now();
+                auto login = server.login("bench" + std::to_string(i), kPassword,
+                                          remoteAddress(i));
+                latencies[t].push_back(
+                    static_cast<double>(
+                        duration_cast<microseconds>(steady_clock::now() - begin).count()) /
+                    1000.0);
+                if (!login.hasValue()) {
+                    failures.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    const double elapsed = secondsSince(start);
+
+    std::vector<double> all;
+    for (const auto& l : latencies) {
+        all.insert(all.end(), l.begin(), l.end());
+    }
+    std::sort(all.begin(), all.end());
+    return {users / elapsed, percentile(all, 50.0), percentile(all, 99.0), failures.load()};
+}
+
+}  // anonymous namespace
+
+TEST(GatewayBenchmark, LoginBurst) {
+    constexpr uint32_t kBurstUsers = 2000;
+    const uint32_t threads = std::clamp(std::thread::hardware_concurrency(), 1u, 8u);
+
+    std::cout << "\n=== AuthServer Login Burst (" << kBurstUsers << " users, " << threads
+              << " threads) ===" << std::endl;
+    std::cout << "  algorithm   logins/sec   p50 ms   p99 ms\n";
+    for (auto algorithm : {JwtAlgorithm::HS256, JwtAlgorithm::RS256}) {
+        auto server = makeAuthServer(algorithm, 65536, kBurstUsers);
+        const auto result = loginBurst(*server, kBurstUsers, threads);
+        std::cout << std::fixed << "  " << (algorithm == JwtAlgorithm::HS256 ? "HS256" : "RS256")
+                  << "       " << std::setprecision(0) << std::setw(10) << result.loginsPerSec
+                  << "   " << std::setprecision(3) << std::setw(6) << result.p50Ms << "   "
+                  << std::setw(6) << result.p99Ms << "\n";
+        EXPECT_EQ(result.failures, 0u);
+        EXPECT_GT(result.loginsPerSec, kMinLoginsPerSec);
+    }
+}
@@ -0,0 +1,874 @@
+// tests/load/bot_swarm.cpp
+//
+// Headless bot swarm: a load generator for a real gateway deployment.
+//
+// Where the k6 scripts next to this file exercise HTTP/WebSocket entry
+// points and game_ccu_benchmark_test drives GameServer in process, this
+// program opens thousands of plain TCP game connections and plays a
+// scripted session on each, speaking the same NetworkMessage framing as
+// examples/11_client.cpp:
+//
+//   connect -> Authenticate(token) -> AuthResult -> loop {
+//       one of move / chat / combat / zone change, chosen by --mix,
+//       every --interval (jittered); Ping from the gateway -> Pong
+//   }
+//
+// Bots are spread over a few driver threads, each multiplexing its
+// sockets with poll(), so 5k bots cost 5k sockets rather than 5k threads.
+// Each request is timed until the next non-heartbeat frame on the same
+// connection (the gateway keeps a connection's replies in order); the
+// report gives per-opcode RTT percentiles, connection, authentication and
+// timeout failures, and the server's tick metrics scraped from a
+// HealthServer's /metrics before and after the run.
+//
+// Usage:
+//   cgs_bot_swarm --host 10.0.0.5 --port 8080 --token-file tokens.txt
+//                 --bots 5000 --threads 4 --ramp 60 --duration 300
+//                 --mix move=70,chat=10,combat=15,zone=5
+//                 --metrics 10.0.0.6:9110
+//
+//   cgs_bot_swarm --loopback --bots 200 --duration 5   # self-contained smoke
+//
+// Access tokens are issued by the auth service out of band; --token-file
+// holds one per line and bots use them round-robin.  --loopback starts an
+// in-process GameNetworkManager that accepts any token and echoes every
+// request, so the binary can check itself in CI without a deployment.
+
+#include "cgs/foundation/game_network_manager.hpp"
+#include "cgs/foundation/wire_buffer.hpp"
+#include "cgs/service/gateway_types.hpp"
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using cgs::foundation::NetworkMessage;
+using cgs::foundation::WireBuffer;
+using Clock = std::chrono::steady_clock;
+
+// ─── Configuration ──────────────────────────────────────────────────────
+
+/// Scripted actions a bot chooses from.
+enum class Action : uint8_t { Move, Chat, Combat, Zone, Count };
+
+constexpr std::array<std::string_view, 4> kActionNames{"move", "chat", "combat", "zone"};
+
+struct Options {
+    std::string host = "127.0.0.1";
+    uint16_t port = 8080;
+    std::vector<std::string> tokens;
+    std::size_t bots = 1000;
+    std::size_t threads = 4;
+    std::chrono::seconds duration{60};
+    std::chrono::seconds ramp{10};
+    std::chrono::milliseconds interval{500};
+    std::chrono::milliseconds replyTimeout{5000};
+    std::array<unsigned, 4> mix{60, 20, 15, 5};
+    // Defaults fall in the game (0x01xx) and lobby (0x02xx) routes the
+    // gateway examples configure; override with --opcodes.
+    std::array<uint16_t, 4> opcodes{0x0110, 0x0210, 0x0120, 0x0130};
+    std::optional<std::pair<std::string, uint16_t>> metrics;
+    bool loopback = false;
+};
+
+void printUsage() {
+    std::cout
+        << "usage: cgs_bot_swarm [options]\n"
+           "  --host H             gateway host (127.0.0.1)\n"
+           "  --port P             gateway TCP port (8080)\n"
+           "  --token T            access token for every bot\n"
+           "  --token-file F       access tokens, one per line, used round-robin\n"
+           "  --bots N             bots (1000)\n"
+           "  --threads N          driver threads (4)\n"
+           "  --duration S         seconds of play after the ramp (60)\n"
+           "  --ramp S             seconds over which bots connect (10)\n"
+           "  --interval MS        mean time between a bot's actions (500)\n"
+           "  --reply-timeout MS   a request without a reply by then is a timeout (5000)\n"
+           "  --mix a=w,...        action weights: move, chat, combat, zone (60,20,15,5)\n"
+           "  --opcodes a=op,...   action opcodes (move=0x0110,chat=0x0210,combat=0x0120,"
+           "zone=0x0130)\n"
+           "  --metrics H:P        HealthServer to scrape tick metrics from\n"
+           "  --loopback           run against an in-process echo server\n";
+}
+
+std::optional<unsigned long> parseNumber(std::string_view text) {
+    int base = 10;
+    if (text.starts_with("0x") || text.starts_with("0X")) {
+        text.remove_prefix(2);
+        base = 16;
+    }
+    unsigned long value = 0;
+    auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value, base);
+    if (ec != std::errc{} || ptr != text.data() + text.size() || text.empty()) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+/// Parse "move=60,chat=20" into per-action values.
+template <typename T>
+bool parseActionList(std::string_view text, std::array<T, 4>& out) {
+    while (!text.empty()) {
+        auto comma = text.find(',');
+        auto item = text.substr(0, comma);
+        text = comma == std::string_view::npos ? std::string_view{} : text.substr(comma + 1);
+
+        auto eq = item.find('=');
+        if (eq == std::string_view::npos) {
+            return false;
+        }
+        auto name = item.substr(0, eq);
+        auto value = parseNumber(item.substr(eq + 1));
+        auto it = std::find(kActionNames.begin(), kActionNames.end(), name);
+        if (!value || it == kActionNames.end()) {
+            return false;
+        }
+        out[static_cast<std::size_t>(it - kActionNames.begin())] = static_cast<T>(*value);
+    }
+    return true;
+}
+
+std::optional<Options> parseOptions(int argc, char** argv) {
+    Options opts;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        auto next = [&]() -> std::optional<std::string_view> {
+            if (i + 1 >= argc) {
+                return std::nullopt;
+            }
+            return std::string_view(argv[++i]);
+        };
+        auto number = [&]() -> std::optional<unsigned long> {
+            auto value = next();
+            return value ? parseNumber(*value) : std::nullopt;
+        };
+
+        if (arg == "--loopback") {
+            opts.loopback = true;
+        } else if (arg == "--host") {
+            auto v = next();
+            if (!v) {
+                return std::nullopt;
+            }
+            opts.host = std::string(*v);
+        } else if (arg == "--port") {
+            auto v = number();
+            if (!v || *v == 0 || *v > 65535) {
+                return std::nullopt;
+            }
+            opts.port = static_cast<uint16_t>(*v);
+        } else if (arg == "--token") {
+            auto v = next();
+            if (!v) {
+                return std::nullopt;
+            }
+            opts.tokens.emplace_back(*v);
+        } else if (arg == "--token-file") {
+            auto v = next();
+            if (!v) {
+                return std::nullopt;
+            }
+            std::ifstream in{std::string(*v)};
+            for (std::string line; std::getline(in, line);) {
+                if (!line.empty()) {
+                    opts.tokens.push_back(std::move(line));
+                }
+            }
+        } else if (arg == "--bots") {
+            auto v = number();
+            if (!v || *v == 0) {
+                return std::nullopt;
+            }
+            opts.bots = *v;
+        } else if (arg == "--threads") {
+            auto v = number();
+            if (!v || *v == 0) {
+                return std::nullopt;
+            }
+            opts.threads = *v;
+        } else if (arg == "--duration") {
+            auto v = number();
+            if (!v) {
+                return std::nullopt;
+            }
+            opts.duration = std::chrono::seconds(*v);
+        } else if (arg == "--ramp") {
+            auto v = number();
+            if (!v) {
+                return std::nullopt;
+            }
+            opts.ramp = std::chrono::seconds(*v);
+        } else if (arg == "--interval") {
+            auto v = number();
+            if (!v || *v == 0) {
+                return std::nullopt;
+            }
+            opts.interval = std::chrono::milliseconds(*v);
+        } else if (arg == "--reply-timeout") {
+            auto v = number();
+            if (!v || *v == 0) {
+                return std::nullopt;
+            }
+            opts.replyTimeout = std::chrono::milliseconds(*v);
+        } else if (arg == "--mix") {
+            auto v = next();
+            if (!v || !parseActionList(*v, opts.mix)) {
+                return std::nullopt;
+            }
+        } else if (arg == "--opcodes") {
+            auto v = next();
+            if (!v || !parseActionList(*v, opts.opcodes)) {
+                return std::nullopt;
+            }
+        } else if (arg == "--metrics") {
+            auto v = next();
+            auto colon = v ? v->rfind(':') : std::string_view::npos;
+            auto port = colon == std::string_view::npos ? std::nullopt
+                                                        : parseNumber(v->substr(colon + 1));
+            if (!port || *port == 0 || *port > 65535) {
+                return std::nullopt;
+            }
+            opts.metrics.emplace(std::string(v->substr(0, colon)), static_cast<uint16_t>(*port));
+        } else {
+            return std::nullopt;
+        }
+    }
+    if (opts.loopback && opts.tokens.empty()) {
+        opts.tokens.emplace_back("loopback");
+    }
+    if (opts.tokens.empty() || opts.mix[0] + opts.mix[1] + opts.mix[2] + opts.mix[3] == 0) {
+        return std::nullopt;
+    }
+    opts.threads = std::min(opts.threads, opts.bots);
+    return opts;
+}
+
+// ─── Sockets ────────────────────────────────────────────────────────────
+
+/// Resolve host:port to an IPv4/IPv6 address.
+std::optional<sockaddr_storage> resolve(const std::string& host, uint16_t port, socklen_t& len) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* result = nullptr;
+    if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &result) != 0 ||
+        result == nullptr) {
+        return std::nullopt;
+    }
+    sockaddr_storage addr{};
+    std::memcpy(&addr, result->ai_addr, result->ai_addrlen);
+    len = result->ai_addrlen;
+    freeaddrinfo(result);
+    return addr;
+}
+
+/// Blocking HTTP GET; the response body, or nullopt.
+std::optional<std::string> httpGet(const std::string& host, uint16_t port, std::string_view path) {
+    socklen_t len = 0;
+    auto addr = resolve(host, port, len);
+    if (!addr) {
+        return std::nullopt;
+    }
+    int fd = ::socket(addr->ss_family, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return std::nullopt;
+    }
+    timeval timeout{5, 0};
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&*addr), len) != 0) {
+        ::close(fd);
+        return std::nullopt;
+    }
+    std::string request = "GET " + std::string(path) + " HTTP/1.1\r\nHost: " + host +
+                          "\r\nConnection: close\r\n\r\n";
+    (void)::send(fd, request.data(), request.size(), MSG_NOSIGNAL);
+
+    std::string response;
+    char buf[8192];
+    ssize_t n = 0;
+    while ((n = ::recv(fd, buf, sizeof(buf), 0)) > 0) {
+        response.append(buf, static_cast<std::size_t>(n));
+    }
+    ::close(fd);
+
+    auto body = response.find("\r\n\r\n");
+    if (!response.starts_with("HTTP/1.1 200") || body == std::string::npos) {
+        return std::nullopt;
+    }
+    return response.substr(body + 4);
+}
+
+/// Tick-related series ("cgs_tick*", without histogram buckets) from a
+/// Prometheus text body.
+std::map<std::string, double> tickMetrics(const std::string& body) {
+    std::map<std::string, double> out;
+    std::istringstream lines(body);
+    for (std::string line; std::getline(lines, line);) {
+        if (!line.starts_with("cgs_tick") || line.find("_bucket{") != std::string::npos) {
+            continue;
+        }
+        auto space = line.rfind(' ');
+        if (space == std::string::npos) {
+            continue;
+        }
+        out[line.substr(0, space)] = std::strtod(line.c_str() + space + 1, nullptr);
+    }
+    return out;
+}
+
+// ─── Bots ───────────────────────────────────────────────────────────────
+
+/// Counters and samples of one driver thread, merged at the end.
+struct Stats {
+    uint64_t connectFailures = 0;
+    uint64_t authFailures = 0;
+    uint64_t authenticated = 0;
+    uint64_t disconnects = 0;
+    std::array<uint64_t, 4> sent{};
+    std::array<uint64_t, 4> timeouts{};
+    std::array<std::vector<uint32_t>, 4> rttMicros;  ///< Per action.
+    std::vector<uint32_t> authMicros;
+};
+
+struct Pending {
+    Action action;
+    Clock::time_point sentAt;
+};
+
+struct Bot {
+    enum class State : uint8_t { Idle, Connecting, Authenticating, Playing, Dead };
+
+    int fd = -1;
+    State state = State::Idle;
+    std::string token;
+    Clock::time_point startAt;   ///< When to connect (ramp).
+    Clock::time_point nextAt;    ///< Next action, or auth deadline.
+    Clock::time_point authSentAt;
+    uint32_t sequence = 0;
+    uint32_t zone = 1;
+    float x = 0, y = 0;
+    std::deque<Pending> pending;
+    std::vector<uint8_t> inbound;
+    std::vector<uint8_t> outbound;
+};
+
+class Driver {
+public:
+    Driver(const Options& opts, std::vector<Bot> bots, const sockaddr_storage& addr,
+           socklen_t addrLen, unsigned seed)
+        : opts_(opts), bots_(std::move(bots)), addr_(addr), addrLen_(addrLen), rng_(seed) {}
+
+    void run(Clock::time_point playUntil) {
+        std::vector<pollfd> fds;
+        std::vector<Bot*> owners;
+        while (Clock::now() < playUntil) {
+            const auto now = Clock::now();
+            for (auto& bot : bots_) {
+                step(bot, now);
+            }
+
+            fds.clear();
+            owners.clear();
+            for (auto& bot : bots_) {
+                if (bot.fd < 0) {
+                    continue;
+                }
+                short events = POLLIN;
+                if (bot.state == Bot::State::Connecting || !bot.outbound.empty()) {
+                    events |= POLLOUT;
+                }
+                fds.push_back({bot.fd, events, 0});
+                owners.push_back(&bot);
+            }
+            if (::poll(fds.data(), fds.size(), 5) <= 0) {
+                continue;
+            }
+            for (std::size_t i = 0; i < fds.size(); ++i) {
+                if (fds[i].revents != 0) {
+                    service(*owners[i], fds[i].revents);
+                }
+            }
+        }
+        for (auto& bot : bots_) {
+            close(bot);
+        }
+    }
+
+    Stats& stats() { return stats_; }
+
+private:
+    /// Timers: connect on schedule, act when due, expire stale requests.
+    void step(Bot& bot, Clock::time_point now) {
+        switch (bot.state) {
+            case Bot::State::Idle:
+                if (now >= bot.startAt) {
+                    connect(bot);
+                }
+                break;
+            case Bot::State::Connecting:
+            case Bot::State::Authenticating:
+                if (now >= bot.nextAt) {
+                    ++(bot.state == Bot::State::Connecting ? stats_.connectFailures
+                                                           : stats_.authFailures);
+                    kill(bot);
+                }
+                break;
+            case Bot::State::Playing:
+                while (!bot.pending.empty() &&
+                       now - bot.pending.front().sentAt > opts_.replyTimeout) {
+                    ++stats_.timeouts[static_cast<std::size_t>(bot.pending.front().action)];
+                    bot.pending.pop_front();
+                }
+                if (now >= bot.nextAt) {
+                    act(bot, now);
+                }
+                break;
+            case Bot::State::Dead:
+                break;
+        }
+    }
+
+    void connect(Bot& bot) {
+        bot.fd = ::socket(addr_.ss_family, SOCK_STREAM | SOCK_NONBLOCK, 0);
+        if (bot.fd < 0) {
+            ++stats_.connectFailures;
+            bot.state = Bot::State::Dead;
+            return;
+        }
+        int one = 1;
+        ::setsockopt(bot.fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        if (::connect(bot.fd, reinterpret_cast<const sockaddr*>(&addr_), addrLen_) != 0 &&
+            errno != EINPROGRESS) {
+            ++stats_.connectFailures;
+            kill(bot);
+            return;
+        }
+        bot.state = Bot::State::Connecting;
+        bot.nextAt = Clock::now() + opts_.replyTimeout;
+    }
+
+    void service(Bot& bot, short revents) {
+        if (bot.state == Bot::State::Connecting) {
+            int error = 0;
+            socklen_t len = sizeof(error);
+            ::getsockopt(bot.fd, SOL_SOCKET, SO_ERROR, &error, &len);
+            if (error != 0 || (revents & (POLLERR | POLLHUP)) != 0) {
+                ++stats_.connectFailures;
+                kill(bot);
+                return;
+            }
+            bot.state = Bot::State::Authenticating;
+            bot.authSentAt = Clock::now();
+            bot.nextAt = bot.authSentAt + opts_.replyTimeout;
+            queue(bot, cgs::service::GatewayOpcode::Authenticate,
+                  std::vector<uint8_t>(bot.token.begin(), bot.token.end()));
+        } else if ((revents & POLLOUT) != 0) {
+            (void)flush(bot);
+        }
+        if (bot.fd < 0) {
+            return;
+        }
+        if ((revents & (POLLIN | POLLHUP | POLLERR)) != 0) {
+            receive(bot);
+        }
+    }
+
+    /// Send one scripted request.
+    void act(Bot& bot, Clock::time_point now) {
+        const auto action = pick();
+        std::vector<uint8_t> payload;
+        auto put32 = [&](uint32_t v) {
+            for (int i = 3; i >= 0; --i) {
+                payload.push_back(static_cast<uint8_t>(v >> (8 * i)));
+            }
+        };
+        put32(++bot.sequence);
+        switch (action) {
+            case Action::Move: {
+                std::uniform_real_distribution<float> step(-2.0f, 2.0f);
+                bot.x += step(rng_);
+                bot.y += step(rng_);
+                uint32_t bits = 0;
+                std::memcpy(&bits, &bot.x, sizeof(bits));
+                put32(bits);
+                std::memcpy(&bits, &bot.y, sizeof(bits));
+                put32(bits);
+                break;
+            }
+            case Action::Chat: {
+                static constexpr std::string_view kLine = "gg, anyone up for the raid?";
+                payload.insert(payload.end(), kLine.begin(), kLine.end());
+                break;
+            }
+            case Action::Combat:
+                put32(std::uniform_int_distribution<uint32_t>(1, 10000)(rng_));  // target
+                put32(std::uniform_int_distribution<uint32_t>(1, 32)(rng_));     // skill
+                break;
+            case Action::Zone:
+                bot.zone = bot.zone % 8 + 1;
+                put32(bot.zone);
+                break;
+            case Action::Count:
+                break;
+        }
+
+        const auto index = static_cast<std::size_t>(action);
+        ++stats_.sent[index];
+        bot.pending.push_back({action, now});
+        queue(bot, opts_.opcodes[index], std::move(payload));
+
+        // Exponential think time around the configured mean.
+        const auto mean = static_cast<double>(opts_.interval.count());
+        std::exponential_distribution<double> think(1.0 / mean);
+        bot.nextAt = now + std::chrono::microseconds(static_cast<int64_t>(think(rng_) * 1000.0));
+    }
+
+    Action pick() {
+        const auto total = opts_.mix[0] + opts_.mix[1] + opts_.mix[2] + opts_.mix[3];
+        auto roll = std::uniform_int_distribution<unsigned>(0, total - 1)(rng_);
+        for (std::size_t i = 0; i < opts_.mix.size(); ++i) {
+            if (roll < opts_.mix[i]) {
+                return static_cast<Action>(i);
+            }
+            roll -= opts_.mix[i];
+        }
+        return Action::Move;
+    }
+
+    void queue(Bot& bot, uint16_t opcode, std::vector<uint8_t> payload) {
+        NetworkMessage msg;
+        msg.opcode = opcode;
+        msg.payload = std::move(payload);
+        auto frame = msg.serialize();
+        bot.outbound.insert(bot.outbound.end(), frame.begin(), frame.end());
+        (void)flush(bot);
+    }
+
+    bool flush(Bot& bot) {
+        while (!bot.outbound.empty()) {
+            auto n = ::send(bot.fd, bot.outbound.data(), bot.outbound.size(), MSG_NOSIGNAL);
+            if (n < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    return true;
+                }
+                disconnect(bot);
+                return false;
+            }
+            bot.outbound.erase(bot.outbound.begin(), bot.outbound.begin() + n);
+        }
+        return true;
+    }
+
+    void receive(Bot& bot) {
+        std::array<uint8_t, 16384> buf;
+        while (true) {
+            auto n = ::recv(bot.fd, buf.data(), buf.size(), 0);
+            if (n > 0) {
+                bot.inbound.insert(bot.inbound.end(), buf.begin(), buf.begin() + n);
+                continue;
+            }
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                break;
+            }
+            disconnect(bot);
+            return;
+        }
+
+        std::size_t offset = 0;
+        while (bot.inbound.size() - offset >= 6) {
+            const uint8_t* p = bot.inbound.data() + offset;
+            const uint32_t word = (static_cast<uint32_t>(p[0]) << 24) |
+                                  (static_cast<uint32_t>(p[1]) << 16) |
+                                  (static_cast<uint32_t>(p[2]) << 8) | p[3];
+            const uint32_t length = word & WireBuffer::kLengthMask;
+            if (length < 6) {
+                disconnect(bot);  // Not our protocol.
+                return;
+            }
+            if (bot.inbound.size() - offset < length) {
+                break;
+            }
+            auto msg = NetworkMessage::deserialize(p, length);
+            offset += length;
+            if (msg) {
+                onMessage(bot, *msg);
+                if (bot.fd < 0) {
+                    return;
+                }
+            }
+        }
+        bot.inbound.erase(bot.inbound.begin(),
+                          bot.inbound.begin() + static_cast<std::ptrdiff_t>(offset));
+    }
+
+    void onMessage(Bot& bot, const NetworkMessage& msg) {
+        namespace op = cgs::service::GatewayOpcode;
+        const auto now = Clock::now();
+        if (msg.opcode == op::Ping) {
+            queue(bot, op::Pong, {});
+            return;
+        }
+        if (bot.state == Bot::State::Authenticating) {
+            if (msg.opcode != op::AuthResult || msg.payload.empty() || msg.payload[0] != 0) {
+                ++stats_.authFailures;
+                kill(bot);
+                return;
+            }
+            ++stats_.authenticated;
+            stats_.authMicros.push_back(micros(now - bot.authSentAt));
+            bot.state = Bot::State::Playing;
+            bot.nextAt = now;
+            return;
+        }
+        if (bot.state == Bot::State::Playing && !bot.pending.empty()) {
+            const auto& request = bot.pending.front();
+            stats_.rttMicros[static_cast<std::size_t>(request.action)].push_back(
+                micros(now - request.sentAt));
+            bot.pending.pop_front();
+        }
+    }
+
+    static uint32_t micros(Clock::duration d) {
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+        return static_cast<uint32_t>(std::clamp<int64_t>(us, 0, UINT32_MAX));
+    }
+
+    /// Connection lost while playing.
+    void disconnect(Bot& bot) {
+        if (bot.state == Bot::State::Playing) {
+            ++stats_.disconnects;
+        } else if (bot.state == Bot::State::Connecting) {
+            ++stats_.connectFailures;
+        } else if (bot.state == Bot::State::Authenticating) {
+            ++stats_.authFailures;
+        }
+        kill(bot);
+    }
+
+    void kill(Bot& bot) {
+        close(bot);
+        bot.state = Bot::State::Dead;
+    }
+
+    static void close(Bot& bot) {
+        if (bot.fd >= 0) {
+            ::close(bot.fd);
+            bot.fd = -1;
+        }
+        bot.pending.clear();
+    }
+
+    const Options& opts_;
+    std::vector<Bot> bots_;
+    sockaddr_storage addr_;
+    socklen_t addrLen_;
+    std::mt19937 rng_;
+    Stats stats_;
+};
+
+// ─── Report ─────────────────────────────────────────────────────────────
+
+double percentileMs(std::vector<uint32_t>& samples, double q) {
+    if (samples.empty()) {
+        return 0.0;
+    }
+    auto rank = static_cast<std::size_t>(q * static_cast<double>(samples.size() - 1));
+    std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(rank),
+                     samples.end());
+    return static_cast<double>(samples[rank]) / 1000.0;
+}
+
+void printLatencyRow(std::string_view name, uint16_t opcode, uint64_t sent, uint64_t timeouts,
+                     std::vector<uint32_t>& samples) {
+    std::cout << std::left << std::setw(8) << name << std::right << "  0x" << std::hex
+              << std::setw(4) << std::setfill('0') << opcode << std::dec << std::setfill(' ')
+              << std::setw(10) << sent << std::setw(10) << samples.size() << std::setw(10)
+              << timeouts << std::fixed << std::setprecision(2);
+    for (double q : {0.5, 0.9, 0.99, 1.0}) {
+        std::cout << std::setw(10) << percentileMs(samples, q);
+    }
+    std::cout << "\n";
+}
+
+// ─── Loopback server ────────────────────────────────────────────────────
+
+constexpr uint16_t kLoopbackPort = 19102;
+
+/// Accept any token and echo every other request (the gateway, lobby
+/// and game replaced by one in-process stand-in).
+bool startLoopback(cgs::foundation::GameNetworkManager& server, const Options& opts) {
+    namespace op = cgs::service::GatewayOpcode;
+    server.registerHandler(op::Authenticate, [&server](auto sid, const NetworkMessage&) {
+        NetworkMessage reply;
+        reply.opcode = op::AuthResult;
+        reply.payload = {0x00};
+        (void)server.send(sid, reply);
+    });
+    for (auto opcode : opts.opcodes) {
+        server.registerHandler(opcode, [&server](auto sid, const NetworkMessage& msg) {
+            (void)server.send(sid, msg);
+        });
+    }
+    auto listening = server.listen(kLoopbackPort, cgs::foundation::Protocol::TCP);
+    if (!listening) {
+        std::cerr << "loopback listen failed: " << listening.error().message() << "\n";
+        return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));  // See example 11.
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    auto parsed = parseOptions(argc, argv);
+    if (!parsed) {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+    Options opts = std::move(*parsed);
+
+    cgs::foundation::GameNetworkManager loopback;
+    if (opts.loopback) {
+        opts.host = "127.0.0.1";
+        opts.port = kLoopbackPort;
+        if (!startLoopback(loopback, opts)) {
+            return EXIT_FAILURE;
+        }
+    }
+
+    socklen_t addrLen = 0;
+    auto addr = resolve(opts.host, opts.port, addrLen);
+    if (!addr) {
+        std::cerr << "cannot resolve " << opts.host << "\n";
+        return EXIT_FAILURE;
+    }
+
+    std::map<std::string, double> ticksBefore;
+    if (opts.metrics) {
+        if (auto body = httpGet(opts.metrics->first, opts.metrics->second, "/metrics")) {
+            ticksBefore = tickMetrics(*body);
+        } else {
+            std::cerr << "warning: cannot scrape " << opts.metrics->first << ":"
+                      << opts.metrics->second << "/metrics\n";
+        }
+    }
+
+    // Deal bots to drivers, spreading connects evenly over the ramp.
+    const auto start = Clock::now();
+    const auto playUntil = start + opts.ramp + opts.duration;
+    std::vector<std::vector<Bot>> shares(opts.threads);
+    for (std::size_t i = 0; i < opts.bots; ++i) {
+        Bot bot;
+        bot.token = opts.tokens[i % opts.tokens.size()];
+        bot.startAt = start + std::chrono::duration_cast<Clock::duration>(opts.ramp) *
+                                  static_cast<int64_t>(i) / static_cast<int64_t>(opts.bots);
+        shares[i % opts.threads].push_back(std::move(bot));
+    }
+
+    std::cout << "bot swarm: " << opts.bots << " bots on " << opts.threads << " threads -> "
+              << opts.host << ":" << opts.port << ", ramp " << opts.ramp.count() << " s, play "
+              << opts.duration.count() << " s\n";
+
+    std::vector<std::unique_ptr<Driver>> drivers;
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < opts.threads; ++t) {
+        drivers.push_back(std::make_unique<Driver>(opts, std::move(shares[t]), *addr, addrLen,
+                                                   static_cast<unsigned>(t + 1)));
+    }
+    for (auto& driver : drivers) {
+        threads.emplace_back([&driver, playUntil] { driver->run(playUntil); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    const auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+    // Merge.
+    Stats total;
+    for (auto& driver : drivers) {
+        auto& s = driver->stats();
+        total.connectFailures += s.connectFailures;
+        total.authFailures += s.authFailures;
+        total.authenticated += s.authenticated;
+        total.disconnects += s.disconnects;
+        total.authMicros.insert(total.authMicros.end(), s.authMicros.begin(),
+                                s.authMicros.end());
+        for (std::size_t a = 0; a < kActionNames.size(); ++a) {
+            total.sent[a] += s.sent[a];
+            total.timeouts[a] += s.timeouts[a];
+            total.rttMicros[a].insert(total.rttMicros[a].end(), s.rttMicros[a].begin(),
+                                      s.rttMicros[a].end());
+        }
+    }
+
+    uint64_t sent = 0;
+    for (auto n : total.sent) {
+        sent += n;
+    }
+    std::cout << "\nconnections: " << total.authenticated << " authenticated, "
+              << total.connectFailures << " connect failures, " << total.authFailures
+              << " auth failures, " << total.disconnects << " disconnects while playing\n"
+              << "requests: " << sent << " in " << std::fixed << std::setprecision(1) << elapsed
+              << " s (" << static_cast<double>(sent) / elapsed << "/s)\n\n";
+
+    std::cout << "action    opcode      sent   replies  timeouts    p50 ms    p90 ms    p99 ms"
+                 "    max ms\n";
+    printLatencyRow("auth", cgs::service::GatewayOpcode::Authenticate, total.authenticated +
+                    total.authFailures, 0, total.authMicros);
+    for (std::size_t a = 0; a < kActionNames.size(); ++a) {
+        printLatencyRow(kActionNames[a], opts.opcodes[a], total.sent[a], total.timeouts[a],
+                        total.rttMicros[a]);
+    }
+
+    if (opts.metrics) {
+        auto body = httpGet(opts.metrics->first, opts.metrics->second, "/metrics");
+        auto ticksAfter = body ? tickMetrics(*body) : std::map<std::string, double>{};
+        std::cout << "\nserver tick metrics (" << opts.metrics->first << ":"
+                  << opts.metrics->second << "):\n";
+        if (ticksAfter.empty()) {
+            std::cout << "  none scraped\n";
+        }
+        for (const auto& [name, value] : ticksAfter) {
+            std::cout << "  " << std::left << std::setw(48) << name << std::right
+                      << std::setprecision(3) << value;
+            if (name.ends_with("_count") || name.ends_with("_total")) {
+                auto before = ticksBefore.find(name);
+                auto delta = value - (before == ticksBefore.end() ? 0.0 : before->second);
+                std::cout << "  (+" << std::setprecision(0) << delta << " during run)";
+            }
+            std::cout << "\n";
+        }
+    }
+
+    if (opts.loopback) {
+        loopback.stopAll();
+    }
+    return total.authenticated > 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
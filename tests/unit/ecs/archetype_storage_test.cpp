@@ -0,0 +1,279 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "cgs/ecs/archetype_storage.hpp"
+#include "cgs/ecs/entity_manager.hpp"
+#include "cgs/ecs/query.hpp"
+
+using namespace cgs::ecs;
+
+// ── Test component types ────────────────────────────────────────────────────
+
+struct Position {
+    float x = 0.0f;
+    float y = 0.0f;
+};
+
+struct Velocity {
+    float dx = 0.0f;
+    float dy = 0.0f;
+};
+
+struct Label {
+    std::string text;
+};
+
+struct Frozen {};
+
+// Component with a non-trivial destructor to verify lifetime handling.
+struct Tracked {
+    std::shared_ptr<int> token;
+};
+
+// ===========================================================================
+// ArchetypeStorage: CRUD
+// ===========================================================================
+
+TEST(ArchetypeStorageTest, AddAndGet) {
+    ArchetypeStorage<Position, Velocity> storage;
+    Entity e(3, 0);
+
+    storage.Add(e, Position{1.0f, 2.0f}, Velocity{3.0f, 4.0f});
+
+    ASSERT_TRUE(storage.Has(e));
+    EXPECT_EQ(storage.Size(), 1u);
+    EXPECT_FLOAT_EQ(storage.Get<Position>(e).x, 1.0f);
+    EXPECT_FLOAT_EQ(storage.Get<Velocity>(e).dy, 4.0f);
+}
+
+TEST(ArchetypeStorageTest, AddDefaultConstructed) {
+    ArchetypeStorage<Position, Label> storage;
+    Entity e(0, 0);
+
+    storage.Add(e);
+
+    EXPECT_FLOAT_EQ(storage.Get<Position>(e).x, 0.0f);
+    EXPECT_TRUE(storage.Get<Label>(e).text.empty());
+}
+
+TEST(ArchetypeStorageTest, HasReturnsFalseForAbsent) {
+    ArchetypeStorage<Position> storage;
+    EXPECT_FALSE(storage.Has(Entity(0, 0)));
+    EXPECT_FALSE(storage.Has(Entity(1000, 0)));
+}
+
+TEST(ArchetypeStorageTest, RemoveMovesLastRowIntoHole) {
+    ArchetypeStorage<Position, Label> storage;
+    Entity a(0, 0);
+    Entity b(1, 0);
+    Entity c(2, 0);
+    storage.Add(a, Position{1.0f, 0.0f}, Label{"a"});
+    storage.Add(b, Position{2.0f, 0.0f}, Label{"b"});
+    storage.Add(c, Position{3.0f, 0.0f}, Label{"c"});
+
+    storage.Remove(a);
+
+    EXPECT_FALSE(storage.Has(a));
+    EXPECT_EQ(storage.Size(), 2u);
+    EXPECT_EQ(storage.EntityAt(0), c.id());
+    EXPECT_EQ(storage.Get<Label>(c).text, "c");
+    EXPECT_EQ(storage.Get<Label>(b).text, "b");
+}
+
+TEST(ArchetypeStorageTest, RemoveNonexistentIsNoop) {
+    ArchetypeStorage<Position> storage;
+    storage.Add(Entity(0, 0));
+    const auto version = storage.Version();
+
+    storage.Remove(Entity(5, 0));
+
+    EXPECT_EQ(storage.Size(), 1u);
+    EXPECT_EQ(storage.Version(), version);
+}
+
+TEST(ArchetypeStorageTest, ClearDestroysComponents) {
+    auto token = std::make_shared<int>(7);
+    ArchetypeStorage<Tracked, Position> storage;
+    for (uint32_t i = 0; i < 10; ++i) {
+        storage.Add(Entity(i, 0), Tracked{token}, Position{});
+    }
+    EXPECT_EQ(token.use_count(), 11);
+
+    storage.Clear();
+
+    EXPECT_EQ(token.use_count(), 1);
+    EXPECT_TRUE(storage.Empty());
+    EXPECT_EQ(storage.ChunkCount(), 0u);
+}
+
+TEST(ArchetypeStorageTest, DestructorReleasesComponents) {
+    auto token = std::make_shared<int>(1);
+    {
+        ArchetypeStorage<Tracked> storage;
+        storage.Add(Entity(0, 0), Tracked{token});
+        storage.Add(Entity(1, 0), Tracked{token});
+        storage.Remove(Entity(0, 0));
+        EXPECT_EQ(token.use_count(), 2);
+    }
+    EXPECT_EQ(token.use_count(), 1);
+}
+
+// ===========================================================================
+// ArchetypeStorage: chunk layout
+// ===========================================================================
+
+TEST(ArchetypeStorageTest, ChunkCapacityFitsChunkBytes) {
+    using Storage = ArchetypeStorage<Position, Velocity>;
+    const std::size_t rowBytes = sizeof(uint32_t) + sizeof(Position) + sizeof(Velocity);
+
+    EXPECT_GT(Storage::kChunkCapacity, 1u);
+    EXPECT_LE(Storage::kChunkCapacity * rowBytes, Storage::kChunkBytes);
+}
+
+TEST(ArchetypeStorageTest, RowsSpillIntoNewChunks) {
+    using Storage = ArchetypeStorage<Position, Velocity>;
+    Storage storage;
+    const auto count = static_cast<uint32_t>(Storage::kChunkCapacity * 2 + 5);
+
+    for (uint32_t i = 0; i < count; ++i) {
+        storage.Add(Entity(i, 0), Position{static_cast<float>(i), 0.0f}, Velocity{});
+    }
+
+    ASSERT_EQ(storage.ChunkCount(), 3u);
+    EXPECT_EQ(storage.ChunkSize(0), Storage::kChunkCapacity);
+    EXPECT_EQ(storage.ChunkSize(2), 5u);
+
+    // Columns are packed: the n-th row of chunk 1 follows chunk 0's rows.
+    const Position* column = storage.Column<Position>(1);
+    EXPECT_FLOAT_EQ(column[0].x, static_cast<float>(Storage::kChunkCapacity));
+}
+
+TEST(ArchetypeStorageTest, EmptyTailChunkIsReleased) {
+    using Storage = ArchetypeStorage<Position>;
+    Storage storage;
+    const auto count = static_cast<uint32_t>(Storage::kChunkCapacity + 1);
+    for (uint32_t i = 0; i < count; ++i) {
+        storage.Add(Entity(i, 0));
+    }
+    ASSERT_EQ(storage.ChunkCount(), 2u);
+
+    storage.Remove(Entity(0, 0));
+
+    EXPECT_EQ(storage.ChunkCount(), 1u);
+    EXPECT_EQ(storage.Size(), Storage::kChunkCapacity);
+    for (uint32_t i = 1; i < count; ++i) {
+        EXPECT_TRUE(storage.Has(Entity(i, 0)));
+    }
+}
+
+TEST(ArchetypeStorageTest, ChunkColumnReturnsNullForForeignType) {
+    ArchetypeStorage<Position> storage;
+    storage.Add(Entity(0, 0));
+
+    EXPECT_NE(storage.ChunkColumn(0, ComponentType<Position>::Id()), nullptr);
+    EXPECT_EQ(storage.ChunkColumn(0, ComponentType<Velocity>::Id()), nullptr);
+}
+
+// ===========================================================================
+// ArchetypeStorage: EntityManager integration
+// ===========================================================================
+
+TEST(ArchetypeStorageTest, DestroyRemovesFromRegisteredArchetype) {
+    EntityManager manager;
+    ArchetypeStorage<Position, Velocity> storage;
+    manager.RegisterStorage(&storage);
+
+    auto a = manager.Create();
+    auto b = manager.Create();
+    storage.Add(a);
+    storage.Add(b);
+
+    manager.Destroy(a);
+
+    EXPECT_FALSE(storage.Has(a));
+    EXPECT_TRUE(storage.Has(b));
+    EXPECT_EQ(storage.Size(), 1u);
+}
+
+// ===========================================================================
+// Query over an ArchetypeStorage
+// ===========================================================================
+
+TEST(ArchetypeQueryTest, ForEachVisitsAllRows) {
+    using Storage = ArchetypeStorage<Position, Velocity>;
+    Storage storage;
+    const auto count = static_cast<uint32_t>(Storage::kChunkCapacity + 10);
+    for (uint32_t i = 0; i < count; ++i) {
+        storage.Add(Entity(i, 0), Position{}, Velocity{1.0f, 2.0f});
+    }
+
+    Query<Position, Velocity> query(storage);
+    std::unordered_set<uint32_t> seen;
+    query.ForEach([&](Entity e, Position& pos, Velocity& vel) {
+        pos.x += vel.dx;
+        pos.y += vel.dy;
+        seen.insert(e.id());
+    });
+
+    EXPECT_EQ(seen.size(), count);
+    EXPECT_EQ(query.Count(), count);
+    EXPECT_FLOAT_EQ(storage.Get<Position>(Entity(count - 1, 0)).y, 2.0f);
+}
+
+TEST(ArchetypeQueryTest, SubsetOfArchetypeTypes) {
+    ArchetypeStorage<Position, Velocity, Label> storage;
+    storage.Add(Entity(0, 0), Position{}, Velocity{}, Label{"x"});
+
+    Query<Label> query(storage);
+    int visited = 0;
+    query.ForEach([&](Entity, Label& label) {
+        EXPECT_EQ(label.text, "x");
+        ++visited;
+    });
+
+    EXPECT_EQ(visited, 1);
+}
+
+TEST(ArchetypeQueryTest, ExcludeFiltersRows) {
+    ArchetypeStorage<Position> storage;
+    ComponentStorage<Frozen> frozen;
+    for (uint32_t i = 0; i < 6; ++i) {
+        storage.Add(Entity(i, 0));
+    }
+    frozen.Add(Entity(1, 0));
+    frozen.Add(Entity(4, 0));
+
+    Query<Position> query(storage);
+    query.Exclude(frozen);
+
+    std::unordered_set<uint32_t> seen;
+    query.ForEach([&](Entity e, Position&) { seen.insert(e.id()); });
+
+    EXPECT_EQ(seen.size(), 4u);
+    EXPECT_EQ(seen.count(1), 0u);
+    EXPECT_EQ(seen.count(4), 0u);
+    EXPECT_EQ(query.Count(), 4u);
+}
+
+TEST(ArchetypeQueryTest, CacheInvalidatedByArchetypeChange) {
+    ArchetypeStorage<Position> storage;
+    storage.Add(Entity(0, 0));
+
+    Query<Position> query(storage);
+    EXPECT_EQ(query.Count(), 1u);
+
+    storage.Add(Entity(1, 0));
+    EXPECT_EQ(query.Count(), 2u);
+
+    storage.Remove(Entity(0, 0));
+    std::vector<Entity> entities;
+    for (Entity e : query) {
+        entities.push_back(e);
+    }
+    ASSERT_EQ(entities.size(), 1u);
+    EXPECT_EQ(entities[0].id(), 1u);
+}
@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "cgs/ecs/command_buffer.hpp"
+#include "cgs/ecs/component_storage.hpp"
+#include "cgs/ecs/entity_manager.hpp"
+
+using namespace cgs::ecs;
+
+// ── Test component types ────────────────────────────────────────────────────
+
+struct Position {
+    float x = 0.0f;
+    float y = 0.0f;
+};
+
+struct Health {
+    int32_t current = 100;
+};
+
+// ── Fixture ─────────────────────────────────────────────────────────────────
+
+class CommandBufferTest : public ::testing::Test {
+protected:
+    CommandBufferTest() {
+        entities.RegisterStorage(&positions);
+        entities.RegisterStorage(&health);
+    }
+
+    EntityManager entities;
+    ComponentStorage<Position> positions;
+    ComponentStorage<Health> health;
+    CommandBufferSet commands{entities};
+};
+
+// ===========================================================================
+// CommandBuffer: Recording
+// ===========================================================================
+
+TEST_F(CommandBufferTest, RecordingDoesNotTouchWorld) {
+    Entity e = entities.Create();
+    auto& cmd = commands.Local();
+
+    (void)cmd.Create();
+    cmd.Add(positions, e, Position{1.0f, 2.0f});
+    cmd.Destroy(e);
+
+    EXPECT_EQ(cmd.CommandCount(), 3u);
+    EXPECT_FALSE(commands.Empty());
+    EXPECT_EQ(entities.Count(), 1u);
+    EXPECT_FALSE(positions.Has(e));
+}
+
+TEST_F(CommandBufferTest, LocalReturnsSameBufferOnOneThread) {
+    EXPECT_EQ(&commands.Local(), &commands.Local());
+}
+
+TEST_F(CommandBufferTest, LocalReturnsDistinctBuffersPerThread) {
+    CommandBuffer* main = &commands.Local();
+    CommandBuffer* other = nullptr;
+    std::thread t([&] { other = &commands.Local(); });
+    t.join();
+
+    EXPECT_NE(main, other);
+}
+
+// ===========================================================================
+// CommandBufferSet: Playback
+// ===========================================================================
+
+TEST_F(CommandBufferTest, PlaybackCreatesAndAttachesComponents) {
+    auto& cmd = commands.Local();
+    PendingEntity spawned = cmd.Create();
+    cmd.Add(positions, spawned, Position{3.0f, 4.0f});
+    cmd.Add(health, spawned, Health{7});
+
+    commands.Playback();
+
+    ASSERT_EQ(entities.Count(), 1u);
+    ASSERT_EQ(positions.Size(), 1u);
+    Entity e(positions.EntityAt(0), 0);
+    EXPECT_TRUE(entities.IsAlive(e));
+    EXPECT_FLOAT_EQ(positions.Get(e).y, 4.0f);
+    EXPECT_EQ(health.Get(e).current, 7);
+    EXPECT_TRUE(commands.Empty());
+}
+
+TEST_F(CommandBufferTest, AddReplacesExistingComponent) {
+    Entity e = entities.Create();
+    health.Add(e, Health{1});
+
+    commands.Local().Add(health, e, Health{2});
+    commands.Playback();
+
+    EXPECT_EQ(health.Size(), 1u);
+    EXPECT_EQ(health.Get(e).current, 2);
+}
+
+TEST_F(CommandBufferTest, SameStorageCommandsKeepRecordingOrder) {
+    Entity a = entities.Create();
+    Entity b = entities.Create();
+    positions.Add(b);
+
+    auto& cmd = commands.Local();
+    cmd.Add(positions, a, Position{});
+    cmd.Add(health, a, Health{});
+    cmd.Remove(positions, a);
+    cmd.Remove(positions, b);
+    cmd.Add(positions, b, Position{5.0f, 0.0f});
+
+    commands.Playback();
+
+    EXPECT_FALSE(positions.Has(a));
+    EXPECT_TRUE(health.Has(a));
+    ASSERT_TRUE(positions.Has(b));
+    EXPECT_FLOAT_EQ(positions.Get(b).x, 5.0f);
+}
+
+TEST_F(CommandBufferTest, DestroysRunAfterComponentCommands) {
+    Entity e = entities.Create();
+
+    auto& cmd = commands.Local();
+    cmd.Destroy(e);
+    cmd.Add(positions, e, Position{});
+
+    commands.Playback();
+
+    EXPECT_FALSE(entities.IsAlive(e));
+    EXPECT_TRUE(positions.Empty());
+}
+
+TEST_F(CommandBufferTest, CommandsOnDeadEntitiesAreDropped) {
+    Entity e = entities.Create();
+    entities.Destroy(e);
+
+    auto& cmd = commands.Local();
+    cmd.Add(positions, e, Position{});
+    cmd.Destroy(e);
+
+    commands.Playback();
+
+    EXPECT_TRUE(positions.Empty());
+    EXPECT_EQ(entities.Count(), 0u);
+}
+
+TEST_F(CommandBufferTest, MergesBuffersFromSeveralThreads) {
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 50;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            auto& cmd = commands.Local();
+            for (int i = 0; i < kPerThread; ++i) {
+                cmd.Add(health, cmd.Create(), Health{t});
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    commands.Playback();
+
+    EXPECT_EQ(entities.Count(), static_cast<std::size_t>(kThreads * kPerThread));
+    EXPECT_EQ(health.Size(), static_cast<std::size_t>(kThreads * kPerThread));
+}
+
+TEST_F(CommandBufferTest, BuffersAreReusedAfterPlayback) {
+    CommandBuffer* first = &commands.Local();
+    first->Add(health, first->Create(), Health{});
+    commands.Playback();
+
+    // The cleared buffer goes back to the pool for the next thread.
+    CommandBuffer* other = nullptr;
+    std::thread t([&] { other = &commands.Local(); });
+    t.join();
+
+    EXPECT_EQ(first, other);
+    EXPECT_TRUE(other->Empty());
+}
+
+TEST_F(CommandBufferTest, ReusedBufferHandlesStorageAddressReusedByAnotherType) {
+    // One block of memory holds a Position storage, then a Health storage,
+    // so the pooled buffer sees the same storage address with a new type.
+    constexpr std::size_t kSize = std::max(sizeof(ComponentStorage<Position>),
+                                           sizeof(ComponentStorage<Health>));
+    alignas(ComponentStorage<Position>) alignas(ComponentStorage<Health>) unsigned char
+        raw[kSize];
+    Entity e = entities.Create();
+
+    auto* oldPositions = new (raw) ComponentStorage<Position>();
+    commands.Local().Add(*oldPositions, e, Position{1.0f, 2.0f});
+    commands.Playback();
+    EXPECT_FLOAT_EQ(oldPositions->Get(e).y, 2.0f);
+    oldPositions->~ComponentStorage<Position>();
+
+    auto* newHealth = new (raw) ComponentStorage<Health>();
+    commands.Local().Add(*newHealth, e, Health{42});
+    commands.Playback();
+    ASSERT_TRUE(newHealth->Has(e));
+    EXPECT_EQ(newHealth->Get(e).current, 42);
+    newHealth->~ComponentStorage<Health>();
+}
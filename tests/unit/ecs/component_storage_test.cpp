@@ -2,8 +2,11 @@
 
 #include <algorithm>
 #include <chrono>
+#include <iterator>
+#include <limits>
 #include <numeric>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
@@ -85,10 +88,28 @@ TEST(EntityTest, Comparison) {
     EXPECT_NE(a, d);
 }
 
-TEST(EntityTest, SizeIsFourBytes) {
-    static_assert(sizeof(Entity) == 4);
+TEST(EntityTest, SizeMatchesLayout) {
+    static_assert(sizeof(Entity) == (CGS_WIDE_ENTITY ? 8 : 4));
 }
 
+#if CGS_WIDE_ENTITY
+TEST(EntityTest, WideIdsAndVersionsRoundTrip) {
+    Entity e(0x12345678u, 0xDEADBEEFu);
+    EXPECT_TRUE(e.isValid());
+    EXPECT_EQ(e.id(), 0x12345678u);
+    EXPECT_EQ(e.version(), 0xDEADBEEFu);
+    EXPECT_EQ(Entity::kMaxId, 0xFFFFFFFEu);
+}
+
+TEST(EntityTest, StorageAcceptsIdsBeyondCompactRange) {
+    ComponentStorage<Position> storage;
+    Entity far(0x01000000u + 5, 0);
+    storage.Add(far, Position{1.0f, 2.0f, 3.0f});
+    EXPECT_TRUE(storage.Has(far));
+    EXPECT_EQ(storage.EntityAt(0), far.id());
+}
+#endif
+
 TEST(EntityTest, HashWorks) {
     std::unordered_map<Entity, int> map;
     Entity e(10, 0);
@@ -379,6 +400,28 @@ TEST(ComponentStorageTest, MarkChangedBumpsVersion) {
     EXPECT_GT(v2, v1);
 }
 
+TEST(ComponentStorageTest, MarkChangedAtStampsDenseSlots) {
+    ComponentStorage<Position> storage;
+    Entity a(1, 0);
+    Entity b(2, 0);
+    Entity c(3, 0);
+    storage.Add(a, Position{});
+    storage.Add(b, Position{});
+    storage.Add(c, Position{});
+    const auto snapshot = storage.GlobalVersion();
+
+    storage.MarkChangedAt({});
+    EXPECT_EQ(storage.GlobalVersion(), snapshot);
+
+    const uint32_t rows[] = {storage.IndexOf(a), storage.IndexOf(c)};
+    storage.MarkChangedAt(rows);
+    EXPECT_TRUE(storage.HasChanged(a, snapshot));
+    EXPECT_FALSE(storage.HasChanged(b, snapshot));
+    EXPECT_TRUE(storage.HasChanged(c, snapshot));
+    EXPECT_EQ(storage.GetVersion(a), storage.GetVersion(c));
+    EXPECT_EQ(storage.GetVersion(a), storage.GlobalVersion());
+}
+
 TEST(ComponentStorageTest, HasChangedDetectsModification) {
     ComponentStorage<Position> storage;
     Entity e(1, 0);
@@ -391,6 +434,23 @@ TEST(ComponentStorageTest, HasChangedDetectsModification) {
     EXPECT_TRUE(storage.HasChanged(e, snapshot));
 }
 
+TEST(ComponentStorageTest, AddedVersionSurvivesModificationAndSwap) {
+    ComponentStorage<Position> storage;
+    Entity a(1, 0);
+    Entity b(2, 0);
+    storage.Add(a, Position{});
+    storage.Add(b, Position{});
+    const auto addedB = storage.GetAddedVersion(b);
+
+    storage.MarkChanged(b);
+    storage.Remove(a);  // b is swapped into a's slot.
+
+    EXPECT_EQ(storage.GetAddedVersion(b), addedB);
+    EXPECT_GT(storage.GetVersion(b), addedB);
+    EXPECT_TRUE(storage.WasAdded(b, addedB - 1));
+    EXPECT_FALSE(storage.WasAdded(b, addedB));
+}
+
 TEST(ComponentStorageTest, GlobalVersionMonotonicallyIncreases) {
     ComponentStorage<Position> storage;
     auto v0 = storage.GlobalVersion();
@@ -449,6 +509,136 @@ TEST(ComponentStorageTest, TagComponent) {
     EXPECT_FALSE(storage.Has(e));
 }
 
+TEST(ComponentStorageTest, TagStorageKeepsMembershipOnly) {
+    ComponentStorage<DeadTag> storage;
+    static_assert(std::is_same_v<ComponentStorage<DeadTag>::iterator::value_type, DeadTag>);
+    constexpr uint32_t kCount = 100'000;
+    for (uint32_t i = 0; i < kCount; ++i) {
+        storage.Add(Entity(i * 3, 0));
+    }
+    EXPECT_EQ(storage.Size(), kCount);
+    EXPECT_EQ(static_cast<std::size_t>(std::distance(storage.begin(), storage.end())), kCount);
+    EXPECT_TRUE(storage.Has(Entity(3, 0)));
+    EXPECT_FALSE(storage.Has(Entity(4, 0)));
+    EXPECT_FALSE(storage.Has(Entity(std::numeric_limits<uint32_t>::max() >> 8, 0)));
+
+    // One bit per id in the touched range.
+    EXPECT_LE(storage.MembershipMemoryUsage(), kCount * 3 / 8 + 8 * 1024);
+
+    const uint32_t before = storage.Version();
+    storage.Remove(Entity(0, 0));
+    EXPECT_NE(storage.Version(), before);
+    EXPECT_FALSE(storage.Has(Entity(0, 0)));
+    EXPECT_EQ(storage.EntityAt(0), (kCount - 1) * 3);  // last row moved into the gap
+
+    std::vector<Entity> batch;
+    for (uint32_t i = 1; i < kCount; ++i) {
+        batch.emplace_back(i * 3, 0);
+    }
+    storage.RemoveMany(batch);
+    EXPECT_TRUE(storage.Empty());
+    // Emptied pages are released; only the page directory remains.
+    EXPECT_LT(storage.MembershipMemoryUsage(), PagedBitset::kPageSize / 8);
+}
+
+TEST(ComponentStorageTest, TagStorageSwapAndSortKeepLookups) {
+    ComponentStorage<DeadTag> tags;
+    ComponentStorage<Health> healths;
+    for (uint32_t i = 0; i < 5; ++i) {
+        tags.Add(Entity(i, 0));
+        healths.Add(Entity(4 - i, 0));
+    }
+    tags.SortAs(healths);
+    for (uint32_t i = 0; i < 5; ++i) {
+        EXPECT_EQ(tags.EntityAt(i), healths.EntityAt(i));
+        EXPECT_EQ(tags.IndexOf(Entity(tags.EntityAt(i), 0)), i);
+    }
+    tags.Remove(Entity(2, 0));
+    for (uint32_t i = 0; i < tags.Size(); ++i) {
+        EXPECT_EQ(tags.IndexOf(Entity(tags.EntityAt(i), 0)), i);
+    }
+}
+
+// ===========================================================================
+// ComponentStorage: Dense images
+// ===========================================================================
+
+TEST(ComponentStorageTest, DenseImageRoundTripsPoolAndOrder) {
+    ComponentStorage<Position> source;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        source.Add(Entity(i * 7, 0), Position{static_cast<float>(i), static_cast<float>(i) * 2.0f, 0.0f});
+    }
+    source.Remove(Entity(0, 0));  // perturb the dense order
+
+    std::vector<uint8_t> image;
+    source.SerializeDense(image);
+
+    ComponentStorage<Position> restored;
+    restored.Add(Entity(5, 0));  // replaced, not merged
+    ASSERT_TRUE(restored.DeserializeDense(image));
+
+    ASSERT_EQ(restored.Size(), source.Size());
+    EXPECT_FALSE(restored.Has(Entity(5, 0)));
+    for (uint32_t i = 0; i < source.Size(); ++i) {
+        const Entity e(source.EntityAt(i), 0);
+        EXPECT_EQ(restored.EntityAt(i), e.id());
+        EXPECT_EQ(restored.Get(e).y, source.Get(e).y);
+    }
+
+    // Restored rows read as freshly added.
+    const Entity first(restored.EntityAt(0), 0);
+    EXPECT_EQ(restored.GetVersion(first), restored.GlobalVersion());
+    EXPECT_EQ(restored.GetAddedVersion(first), restored.GlobalVersion());
+}
+
+TEST(ComponentStorageTest, DenseImageRejectsMalformedImages) {
+    ComponentStorage<Position> source;
+    source.Add(Entity(1, 0));
+    source.Add(Entity(2, 0));
+    std::vector<uint8_t> image;
+    source.SerializeDense(image);
+
+    ComponentStorage<Position> target;
+    target.Add(Entity(9, 0));
+
+    // Truncated.
+    std::vector<uint8_t> truncated(image.begin(), image.end() - 1);
+    EXPECT_FALSE(target.DeserializeDense(truncated));
+
+    // Component size mismatch.
+    ComponentStorage<Health> other;
+    EXPECT_FALSE(other.DeserializeDense(image));
+
+    // Duplicate entity id: overwrite the second id with the first.
+    std::vector<uint8_t> duplicate = image;
+    std::copy_n(duplicate.begin() + 16, sizeof(uint32_t), duplicate.begin() + 20);
+    EXPECT_FALSE(target.DeserializeDense(duplicate));
+
+    EXPECT_EQ(target.Size(), 1u);
+    EXPECT_TRUE(target.Has(Entity(9, 0)));
+}
+
+TEST(ComponentStorageTest, TagDenseImageRoundTrips) {
+    ComponentStorage<DeadTag> source;
+    for (uint32_t i = 0; i < 100; ++i) {
+        source.Add(Entity(i * 11, 0));
+    }
+    std::vector<uint8_t> image;
+    source.SerializeDense(image);
+
+    ComponentStorage<DeadTag> restored;
+    ASSERT_TRUE(restored.DeserializeDense(image));
+    EXPECT_EQ(restored.Size(), 100u);
+    EXPECT_TRUE(restored.Has(Entity(11, 0)));
+    EXPECT_FALSE(restored.Has(Entity(12, 0)));
+    restored.Remove(Entity(0, 0));
+    EXPECT_EQ(restored.EntityAt(0), 99u * 11u);
+
+    // A tag image is not a component image, and vice versa.
+    ComponentStorage<Position> positions;
+    EXPECT_FALSE(positions.DeserializeDense(image));
+}
+
 // ===========================================================================
 // ComponentStorage: String component
 // ===========================================================================
@@ -485,6 +675,89 @@ TEST(IComponentStorageTest, PolymorphicAccess) {
     EXPECT_EQ(base->Size(), 0u);
 }
 
+TEST(IComponentStorageTest, RemoveManyBatchesSwapAndPop) {
+    ComponentStorage<Health> storage;
+    for (uint32_t i = 0; i < 6; ++i) {
+        storage.Add(Entity(i, 0), Health{static_cast<int32_t>(i), 100});
+    }
+    const auto before = storage.GlobalVersion();
+    const auto survivorVersion = storage.GetVersion(Entity(2, 0));
+
+    IComponentStorage* base = &storage;
+    const std::vector<Entity> batch{Entity(0, 0), Entity(5, 0), Entity(3, 0),
+                                    Entity(3, 0), Entity(42, 0)};
+    base->RemoveMany(batch);
+
+    EXPECT_EQ(storage.Size(), 3u);
+    for (uint32_t id : {1u, 2u, 4u}) {
+        ASSERT_TRUE(storage.Has(Entity(id, 0)));
+        EXPECT_EQ(storage.Get(Entity(id, 0)).current, static_cast<int32_t>(id));
+    }
+    EXPECT_FALSE(storage.Has(Entity(0, 0)));
+    EXPECT_FALSE(storage.Has(Entity(3, 0)));
+    EXPECT_FALSE(storage.Has(Entity(5, 0)));
+
+    // One version bump for the batch; survivors keep their stamps.
+    EXPECT_NE(storage.GlobalVersion(), before);
+    EXPECT_EQ(storage.GetVersion(Entity(2, 0)), survivorVersion);
+}
+
+// ===========================================================================
+// ComponentStorage: Dense reordering
+// ===========================================================================
+
+TEST(ComponentStorageTest, SortByReordersDenseArraysConsistently) {
+    ComponentStorage<Health> storage;
+    const int32_t values[] = {5, 3, 9, 1, 7, 2};
+    for (uint32_t i = 0; i < 6; ++i) {
+        storage.Add(Entity(i + 10, 0), Health{values[i], 100});
+    }
+    storage.MarkChanged(Entity(12, 0));
+    const auto changedVersion = storage.GetVersion(Entity(12, 0));
+    const auto addedVersion = storage.GetAddedVersion(Entity(15, 0));
+    const auto before = storage.GlobalVersion();
+
+    storage.SortBy([](const Health& lhs, const Health& rhs) { return lhs.current < rhs.current; });
+
+    // Dense order follows the comparator.
+    int32_t previous = std::numeric_limits<int32_t>::min();
+    for (const auto& health : storage) {
+        EXPECT_LE(previous, health.current);
+        previous = health.current;
+    }
+    // Sparse, entity and version arrays moved with their components.
+    for (uint32_t i = 0; i < 6; ++i) {
+        const Entity e(i + 10, 0);
+        EXPECT_EQ(storage.Get(e).current, values[i]);
+        EXPECT_EQ(storage.EntityAt(storage.IndexOf(e)), e.id());
+    }
+    EXPECT_EQ(storage.GetVersion(Entity(12, 0)), changedVersion);
+    EXPECT_EQ(storage.GetAddedVersion(Entity(15, 0)), addedVersion);
+    EXPECT_EQ(storage.GlobalVersion(), before);
+}
+
+TEST(ComponentStorageTest, SortAsFollowsOtherPoolOrder) {
+    ComponentStorage<Position> positions;
+    ComponentStorage<Velocity> velocities;
+    for (uint32_t id : {1u, 2u, 3u, 4u, 5u}) {
+        positions.Add(Entity(id, 0), Position{static_cast<float>(id), 0.0f, 0.0f});
+    }
+    // Velocity pool in a different order, with one entity positions lacks.
+    for (uint32_t id : {4u, 9u, 2u, 5u}) {
+        velocities.Add(Entity(id, 0));
+    }
+
+    positions.SortAs(velocities);
+
+    ASSERT_EQ(positions.Size(), 5u);
+    EXPECT_EQ(positions.EntityAt(0), 4u);
+    EXPECT_EQ(positions.EntityAt(1), 2u);
+    EXPECT_EQ(positions.EntityAt(2), 5u);
+    for (uint32_t id : {1u, 2u, 3u, 4u, 5u}) {
+        EXPECT_FLOAT_EQ(positions.Get(Entity(id, 0)).x, static_cast<float>(id));
+    }
+}
+
 // ===========================================================================
 // ComponentStorage: Sparse array growth
 // ===========================================================================
@@ -514,6 +787,148 @@ TEST(ComponentStorageTest, NonContiguousEntityIds) {
     EXPECT_EQ(storage.Get(c).current, 30);
 }
 
+TEST(ComponentStorageTest, SparseMemoryTracksLiveComponentsNotMaxId) {
+    ComponentStorage<Position> storage;
+    Entity far(Entity::kMaxId, 0);
+    storage.Add(far, Position{});
+
+    // One page plus a page directory, not one slot per possible id.
+#if CGS_WIDE_ENTITY
+    // The flat directory costs a pointer and a count per 1024 ids.
+    EXPECT_LT(storage.SparseMemoryUsage(),
+              (Entity::kMaxId / SparsePageTable::kPageSize + 1) * 16u + 512u * 1024u);
+#else
+    EXPECT_LT(storage.SparseMemoryUsage(), 512u * 1024u);
+#endif
+
+    storage.Remove(far);
+    EXPECT_FALSE(storage.Has(far));
+}
+
+TEST(ComponentStorageTest, RegionBackedPoolGrowsInPlace) {
+    ComponentStorage<Name> storage;
+    for (uint32_t i = 0; i < 10; ++i) {
+        storage.Add(Entity(i, 0), Name{"n" + std::to_string(i)});
+    }
+    if (!storage.ReserveAddressSpace(200000)) {
+        GTEST_SKIP() << "address space reservation unavailable";
+    }
+    ASSERT_TRUE(storage.IsRegionBacked());
+    EXPECT_EQ(storage.Get(Entity(7, 0)).value, "n7");
+
+    // Growth commits pages behind the array: nothing moves.
+    const Name* first = &*storage.begin();
+    for (uint32_t i = 10; i < 200000; ++i) {
+        storage.Add(Entity(i, 0), Name{"n" + std::to_string(i)});
+    }
+    EXPECT_EQ(&*storage.begin(), first);
+    EXPECT_EQ(storage.Get(Entity(123456, 0)).value, "n123456");
+
+    storage.Remove(Entity(0, 0));
+    EXPECT_EQ(storage.Size(), 199999u);
+    EXPECT_EQ(storage.Get(Entity(199999, 0)).value, "n199999");
+
+    // Past the reservation (rounded up to 2 MB) the pool falls back to
+    // the heap.
+    for (uint32_t i = 200000; i < 300000; ++i) {
+        storage.Add(Entity(i, 0), Name{});
+    }
+    EXPECT_FALSE(storage.IsRegionBacked());
+    EXPECT_EQ(storage.Size(), 299999u);
+    EXPECT_EQ(storage.Get(Entity(42, 0)).value, "n42");
+}
+
+TEST(ComponentStorageTest, ReserveAddressSpaceRejectsSmallerThanSize) {
+    ComponentStorage<Position> storage;
+    for (uint32_t i = 0; i < 4; ++i) {
+        storage.Add(Entity(i, 0), Position{});
+    }
+    EXPECT_FALSE(storage.ReserveAddressSpace(3));
+    EXPECT_FALSE(storage.IsRegionBacked());
+    EXPECT_EQ(storage.Size(), 4u);
+}
+
+// ===========================================================================
+// SparsePageTable
+// ===========================================================================
+
+TEST(SparsePageTableTest, UnsetIdsAreInvalid) {
+    SparsePageTable table;
+    EXPECT_EQ(table.Get(0), SparsePageTable::kInvalidIndex);
+    EXPECT_EQ(table.Get(Entity::kMaxId), SparsePageTable::kInvalidIndex);
+    EXPECT_EQ(table.AllocatedPages(), 0u);
+}
+
+TEST(SparsePageTableTest, SetAllocatesOnlyTouchedPage) {
+    SparsePageTable table;
+    const uint32_t id = SparsePageTable::kPageSize * 7 + 3;
+
+    table.Set(id, 42);
+
+    EXPECT_EQ(table.Get(id), 42u);
+    EXPECT_TRUE(table.Contains(id));
+    EXPECT_FALSE(table.Contains(id + 1));
+    EXPECT_FALSE(table.Contains(3));
+    EXPECT_EQ(table.AllocatedPages(), 1u);
+}
+
+TEST(SparsePageTableTest, ResetReleasesEmptyPage) {
+    SparsePageTable table;
+    table.Set(1, 10);
+    table.Set(2, 20);
+    table.Set(SparsePageTable::kPageSize + 1, 30);
+    ASSERT_EQ(table.AllocatedPages(), 2u);
+
+    table.Reset(1);
+    EXPECT_EQ(table.AllocatedPages(), 2u);
+
+    table.Reset(2);
+    EXPECT_EQ(table.AllocatedPages(), 1u);
+    EXPECT_FALSE(table.Contains(2));
+    EXPECT_EQ(table.Get(SparsePageTable::kPageSize + 1), 30u);
+
+    // Resetting an absent id is a no-op.
+    table.Reset(5);
+    table.Reset(SparsePageTable::kPageSize * 100);
+    EXPECT_EQ(table.AllocatedPages(), 1u);
+}
+
+TEST(SparsePageTableTest, UpdateOverwritesExisting) {
+    SparsePageTable table;
+    table.Set(9, 1);
+    table.Update(9, 2);
+    EXPECT_EQ(table.Get(9), 2u);
+}
+
+TEST(SparsePageTableTest, ClearReleasesAllPages) {
+    SparsePageTable table;
+    for (uint32_t p = 0; p < 4; ++p) {
+        table.Set(p * SparsePageTable::kPageSize, p);
+    }
+    ASSERT_EQ(table.AllocatedPages(), 4u);
+
+    table.Clear();
+
+    EXPECT_EQ(table.AllocatedPages(), 0u);
+    EXPECT_FALSE(table.Contains(0));
+}
+
+TEST(SparsePageTableTest, MovePreservesMappings) {
+    SparsePageTable table;
+    table.Set(100, 7);
+
+    SparsePageTable moved(std::move(table));
+    EXPECT_EQ(moved.Get(100), 7u);
+    EXPECT_EQ(moved.AllocatedPages(), 1u);
+
+    SparsePageTable assigned;
+    assigned.Set(5, 5);
+    assigned = std::move(moved);
+    EXPECT_EQ(assigned.Get(100), 7u);
+    EXPECT_FALSE(assigned.Contains(5));
+    EXPECT_EQ(assigned.AllocatedPages(), 1u);
+}
+
 // ===========================================================================
 // ComponentStorage: TypeId
 // ===========================================================================
@@ -155,7 +155,7 @@ TEST(EntityManagerTest, RecycleMultipleTimes) {
 
         e = mgr.Create();
         EXPECT_EQ(e.id(), idx);
-        EXPECT_EQ(e.version(), static_cast<uint8_t>(v));
+        EXPECT_EQ(e.version(), static_cast<Entity::Version>(v));
         EXPECT_TRUE(mgr.IsAlive(e));
     }
 }
@@ -207,6 +207,18 @@ TEST(EntityManagerTest, IsAliveReturnsFalseForVersionMismatch) {
     EXPECT_FALSE(mgr.IsAlive(stale));
 }
 
+TEST(EntityManagerTest, ResolveReturnsCurrentHandle) {
+    EntityManager mgr;
+    Entity e = mgr.Create();
+    mgr.Destroy(e);
+    Entity reused = mgr.Create();  // same index, bumped version
+
+    EXPECT_EQ(mgr.Resolve(reused.id()), reused);
+    mgr.Destroy(reused);
+    EXPECT_FALSE(mgr.Resolve(reused.id()).isValid());
+    EXPECT_FALSE(mgr.Resolve(999).isValid());
+}
+
 // ===========================================================================
 // EntityManager: Deferred destruction
 // ===========================================================================
@@ -390,7 +402,7 @@ TEST(EntityManagerTest, CreateAndDestroyManyEntities) {
     EXPECT_EQ(mgr.Count(), N);
 
     // All entities should be unique.
-    std::unordered_set<uint32_t> rawSet;
+    std::unordered_set<Entity::Raw> rawSet;
     for (const auto& e : entities) {
         rawSet.insert(e.raw);
     }
@@ -496,9 +508,14 @@ TEST(EntityManagerTest, VersionWrapsAround) {
         EXPECT_EQ(e.id(), idx);
     }
 
+#if CGS_WIDE_ENTITY
+    // 32-bit versions keep counting.
+    EXPECT_EQ(e.version(), 256u);
+#else
     // After 256 destroy/create cycles starting from version 0,
     // the version should wrap back to 0.
     EXPECT_EQ(e.version(), 0);
+#endif
     EXPECT_TRUE(mgr.IsAlive(e));
 }
 
@@ -525,3 +542,150 @@ TEST(EntityManagerTest, MultipleStoragesAllCleaned) {
     EXPECT_FALSE(health.Has(e));
     EXPECT_FALSE(tags.Has(e));
 }
+
+// ===========================================================================
+// EntityManager: Bulk creation / destruction
+// ===========================================================================
+
+TEST(EntityManagerTest, CreateManyRecyclesThenAllocatesFresh) {
+    EntityManager mgr;
+    Entity a = mgr.Create();
+    Entity b = mgr.Create();
+    mgr.Destroy(a);
+    mgr.Destroy(b);
+
+    std::vector<Entity> out;
+    mgr.CreateMany(4, out);
+
+    ASSERT_EQ(out.size(), 4u);
+    EXPECT_EQ(out[0], Entity(a.id(), 1));
+    EXPECT_EQ(out[1], Entity(b.id(), 1));
+    EXPECT_EQ(out[2].id(), 2u);
+    EXPECT_EQ(out[3].id(), 3u);
+    for (const Entity e : out) {
+        EXPECT_TRUE(mgr.IsAlive(e));
+    }
+    EXPECT_EQ(mgr.Count(), 4u);
+    EXPECT_EQ(mgr.Capacity(), 4u);
+}
+
+TEST(EntityManagerTest, CreateManyAppendsToOutput) {
+    EntityManager mgr;
+    std::vector<Entity> out{mgr.Create()};
+
+    mgr.CreateMany(2, out);
+
+    ASSERT_EQ(out.size(), 3u);
+    EXPECT_EQ(std::unordered_set<uint32_t>({out[0].id(), out[1].id(), out[2].id()}).size(), 3u);
+}
+
+TEST(EntityManagerTest, DestroyManyRemovesComponentsAndRecycles) {
+    EntityManager mgr;
+    ComponentStorage<Position> positions;
+    ComponentStorage<Health> health;
+    mgr.RegisterStorage(&positions);
+    mgr.RegisterStorage(&health);
+
+    std::vector<Entity> entities;
+    mgr.CreateMany(6, entities);
+    for (const Entity e : entities) {
+        positions.Add(e, Position{static_cast<float>(e.id()), 0.0f, 0.0f});
+        health.Add(e);
+    }
+
+    const std::vector<Entity> doomed{entities[1], entities[4], entities[5]};
+    mgr.DestroyMany(doomed);
+
+    EXPECT_EQ(mgr.Count(), 3u);
+    EXPECT_EQ(positions.Size(), 3u);
+    EXPECT_EQ(health.Size(), 3u);
+    for (const Entity e : doomed) {
+        EXPECT_FALSE(mgr.IsAlive(e));
+        EXPECT_FALSE(positions.Has(e));
+        EXPECT_FALSE(health.Has(e));
+    }
+    for (const Entity e : {entities[0], entities[2], entities[3]}) {
+        EXPECT_FLOAT_EQ(positions.Get(e).x, static_cast<float>(e.id()));
+    }
+
+    Entity recycled = mgr.Create();
+    EXPECT_EQ(recycled, Entity(entities[1].id(), 1));
+}
+
+TEST(EntityManagerTest, DestroyManySkipsDeadAndDuplicateHandles) {
+    EntityManager mgr;
+    Entity a = mgr.Create();
+    Entity b = mgr.Create();
+    mgr.Destroy(b);
+
+    const std::vector<Entity> batch{a, a, b, Entity{}};
+    mgr.DestroyMany(batch);
+
+    EXPECT_EQ(mgr.Count(), 0u);
+    EXPECT_FALSE(mgr.IsAlive(a));
+
+    // Each index was freed exactly once and bumped by one version.
+    std::vector<Entity> out;
+    mgr.CreateMany(3, out);
+    EXPECT_EQ(out[0], Entity(b.id(), 1));
+    EXPECT_EQ(out[1], Entity(a.id(), 1));
+    EXPECT_EQ(out[2].id(), 2u);
+}
+
+// ===========================================================================
+// EntityManager: Images
+// ===========================================================================
+
+TEST(EntityManagerTest, ImageRestoresVersionsAliveAndFreeList) {
+    EntityManager source;
+    std::vector<Entity> entities;
+    source.CreateMany(10, entities);
+    source.Destroy(entities[3]);
+    source.Destroy(entities[7]);
+    source.DestroyDeferred(entities[1]);
+
+    std::vector<uint8_t> image;
+    source.SerializeImage(image);
+
+    EntityManager restored;
+    (void)restored.Create();
+    ASSERT_TRUE(restored.DeserializeImage(image));
+
+    EXPECT_EQ(restored.Count(), 8u);
+    EXPECT_EQ(restored.Capacity(), 10u);
+    EXPECT_TRUE(restored.IsAlive(entities[0]));
+    EXPECT_FALSE(restored.IsAlive(entities[3]));
+
+    // Pending destructions are not part of the image.
+    restored.FlushDeferred();
+    EXPECT_TRUE(restored.IsAlive(entities[1]));
+
+    // Recycling continues in the same FIFO order with bumped versions.
+    EXPECT_EQ(restored.Create(), Entity(3, 1));
+    EXPECT_EQ(restored.Create(), Entity(7, 1));
+    EXPECT_EQ(restored.Create().id(), 10u);
+}
+
+TEST(EntityManagerTest, ImageRejectsInconsistentFreeList) {
+    EntityManager source;
+    std::vector<Entity> entities;
+    source.CreateMany(4, entities);
+    source.Destroy(entities[2]);
+    std::vector<uint8_t> image;
+    source.SerializeImage(image);
+
+    EntityManager target;
+    Entity kept = target.Create();
+
+    // The free list entry is the last word; point it at a live slot.
+    std::vector<uint8_t> corrupt = image;
+    corrupt.back() = 0;
+    corrupt[corrupt.size() - 4] = 1;
+    EXPECT_FALSE(target.DeserializeImage(corrupt));
+
+    std::vector<uint8_t> truncated(image.begin(), image.end() - 1);
+    EXPECT_FALSE(target.DeserializeImage(truncated));
+
+    EXPECT_TRUE(target.IsAlive(kept));
+    EXPECT_EQ(target.Count(), 1u);
+}
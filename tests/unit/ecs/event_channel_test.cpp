@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <set>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "cgs/ecs/event_channel.hpp"
+#include "cgs/ecs/system_scheduler.hpp"
+
+using namespace cgs::ecs;
+
+namespace {
+
+struct HitEvent {
+    uint32_t target = 0;
+    int32_t amount = 0;
+};
+
+struct HealEvent {
+    uint32_t target = 0;
+};
+
+}  // namespace
+
+// ── EventChannel ────────────────────────────────────────────────────────────
+
+TEST(EventChannelTest, SwapPublishesSentEvents) {
+    EventChannel<HitEvent> channel;
+    channel.Send(HitEvent{1, 10});
+    channel.Emplace(HitEvent{2, 20});
+
+    // Nothing is visible before the swap.
+    EXPECT_TRUE(channel.Read().empty());
+
+    channel.Swap();
+    ASSERT_EQ(channel.Read().size(), 2u);
+    EXPECT_EQ(channel.Read()[0].target, 1u);
+    EXPECT_EQ(channel.Read()[1].amount, 20);
+
+    // Events sent now land on the other side until the next swap.
+    channel.Send(HitEvent{3, 30});
+    EXPECT_EQ(channel.Read().size(), 2u);
+
+    channel.Swap();
+    ASSERT_EQ(channel.Read().size(), 1u);
+    EXPECT_EQ(channel.Read()[0].target, 3u);
+
+    channel.Swap();
+    EXPECT_TRUE(channel.Read().empty());
+}
+
+TEST(EventChannelTest, MergesEventsFromEveryProducerThread) {
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 1000;
+
+    EventChannel<HitEvent> channel;
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kThreads; ++t) {
+        producers.emplace_back([&channel, t] {
+            for (int i = 0; i < kPerThread; ++i) {
+                channel.Send(HitEvent{static_cast<uint32_t>(t), i});
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    channel.Swap();
+    EXPECT_EQ(channel.BufferCount(), static_cast<std::size_t>(kThreads));
+    ASSERT_EQ(channel.Read().size(), static_cast<std::size_t>(kThreads * kPerThread));
+
+    // Per-thread order is preserved within the batch.
+    std::vector<int32_t> last(kThreads, -1);
+    for (const HitEvent& event : channel.Read()) {
+        EXPECT_GT(event.amount, last[event.target]);
+        last[event.target] = event.amount;
+    }
+}
+
+TEST(EventChannelTest, ChannelsOfOneThreadKeepSeparateBuffers) {
+    EventChannel<HitEvent> first;
+    EventChannel<HitEvent> second;
+    first.Send(HitEvent{1, 1});
+    second.Send(HitEvent{2, 2});
+    second.Send(HitEvent{3, 3});
+
+    first.Swap();
+    second.Swap();
+    EXPECT_EQ(first.Read().size(), 1u);
+    EXPECT_EQ(second.Read().size(), 2u);
+}
+
+// ── SystemScheduler integration ─────────────────────────────────────────────
+
+/// Sends one HitEvent per run.
+class HitProducer : public ISystem {
+public:
+    explicit HitProducer(EventChannel<HitEvent>& channel) : channel_(channel) {}
+
+    void Execute(float) override { channel_.Send(HitEvent{0, ++sent}); }
+    [[nodiscard]] std::string_view GetName() const override { return "HitProducer"; }
+    [[nodiscard]] SystemAccessInfo GetAccessInfo() const override {
+        SystemAccessInfo info;
+        EventWrite<HitEvent>::Apply(info);
+        return info;
+    }
+
+    int32_t sent = 0;
+
+private:
+    EventChannel<HitEvent>& channel_;
+};
+
+/// Records the amounts it reads each run.
+template <SystemStage Stage>
+class HitConsumer : public ISystem {
+public:
+    explicit HitConsumer(EventChannel<HitEvent>& channel) : channel_(channel) {}
+
+    void Execute(float) override {
+        seen.clear();
+        for (const HitEvent& event : channel_.Read()) {
+            seen.push_back(event.amount);
+        }
+    }
+    [[nodiscard]] SystemStage GetStage() const override { return Stage; }
+    [[nodiscard]] std::string_view GetName() const override { return "HitConsumer"; }
+    [[nodiscard]] SystemAccessInfo GetAccessInfo() const override {
+        SystemAccessInfo info;
+        EventRead<HitEvent>::Apply(info);
+        return info;
+    }
+
+    std::vector<int32_t> seen;
+
+private:
+    EventChannel<HitEvent>& channel_;
+};
+
+TEST(EventChannelSchedulerTest, LaterStageReadsEventsOfTheSameTick) {
+    EventChannel<HitEvent> channel;
+    SystemScheduler scheduler;
+    scheduler.AddEventChannel(channel);
+    scheduler.Register<HitProducer>(channel);
+    auto& consumer = scheduler.Register<HitConsumer<SystemStage::PostUpdate>>(channel);
+    ASSERT_TRUE(scheduler.Build());
+
+    scheduler.Execute(0.016f);
+    EXPECT_EQ(consumer.seen, std::vector<int32_t>{1});
+
+    scheduler.Execute(0.016f);
+    EXPECT_EQ(consumer.seen, std::vector<int32_t>{2});
+}
+
+TEST(EventChannelSchedulerTest, SameStageReadsEventsOfThePreviousTick) {
+    EventChannel<HitEvent> channel;
+    SystemScheduler scheduler;
+    scheduler.AddEventChannel(channel);
+    scheduler.Register<HitProducer>(channel);
+    auto& consumer = scheduler.Register<HitConsumer<SystemStage::Update>>(channel);
+    ASSERT_TRUE(scheduler.Build());
+
+    scheduler.Execute(0.016f);
+    EXPECT_TRUE(consumer.seen.empty());
+
+    scheduler.Execute(0.016f);
+    EXPECT_EQ(consumer.seen, std::vector<int32_t>{1});
+}
+
+TEST(EventChannelSchedulerTest, UnreadChannelIsPublishedAtTickEnd) {
+    EventChannel<HitEvent> channel;
+    SystemScheduler scheduler;
+    scheduler.AddEventChannel(channel);
+    scheduler.Register<HitProducer>(channel);
+    ASSERT_TRUE(scheduler.Build());
+
+    scheduler.Execute(0.016f);
+    ASSERT_EQ(channel.Read().size(), 1u);
+    EXPECT_EQ(channel.Read()[0].amount, 1);
+
+    scheduler.RemoveEventChannel(channel);
+    scheduler.Execute(0.016f);
+    EXPECT_EQ(channel.Read()[0].amount, 1);
+}
+
+TEST(EventChannelSchedulerTest, EventAccessCountsAsDeclaredAndNeverConflicts) {
+    SystemAccessInfo writer;
+    EventWrite<HitEvent>::Apply(writer);
+    SystemAccessInfo reader;
+    EventRead<HitEvent, HealEvent>::Apply(reader);
+
+    EXPECT_FALSE(writer.IsUndeclared());
+    EXPECT_FALSE(reader.IsUndeclared());
+    EXPECT_FALSE(writer.ConflictsWith(reader));
+    EXPECT_FALSE(writer.ConflictsWith(writer));
+    EXPECT_TRUE(reader.eventReads.contains(ComponentType<HealEvent>::Id()));
+}
@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <set>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "cgs/ecs/frame_arena.hpp"
+#include "cgs/ecs/scratch_allocator.hpp"
+#include "cgs/ecs/system_scheduler.hpp"
+
+using namespace cgs::ecs;
+
+// ── FrameArena ──────────────────────────────────────────────────────────────
+
+TEST(FrameArenaTest, AllocationsHonorAlignment) {
+    FrameArena arena;
+    for (std::size_t alignment : {1u, 8u, 16u, 64u, 256u}) {
+        void* p = arena.allocate(3, alignment);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % alignment, 0u);
+    }
+}
+
+TEST(FrameArenaTest, ChainsBlocksWhenExhausted) {
+    FrameArena arena(1024);
+    std::vector<void*> blocks;
+    for (int i = 0; i < 8; ++i) {
+        blocks.push_back(arena.allocate(512, 16));
+    }
+    EXPECT_GT(arena.BlockCount(), 1u);
+    EXPECT_GE(arena.BytesUsed(), 8u * 512u);
+
+    // Earlier allocations stay valid after the chain grows.
+    std::set<void*> unique(blocks.begin(), blocks.end());
+    EXPECT_EQ(unique.size(), blocks.size());
+}
+
+TEST(FrameArenaTest, ResetKeepsOneBlockCoveringHighWaterMark) {
+    FrameArena arena(1024);
+    for (int i = 0; i < 8; ++i) {
+        (void)arena.allocate(512, 16);
+    }
+    const std::size_t used = arena.BytesUsed();
+    arena.Reset();
+
+    EXPECT_EQ(arena.BytesUsed(), 0u);
+    EXPECT_EQ(arena.HighWaterMark(), used);
+    EXPECT_EQ(arena.BlockCount(), 1u);
+    EXPECT_GE(arena.Capacity(), used);
+
+    // The same workload now fits without chaining.
+    for (int i = 0; i < 8; ++i) {
+        (void)arena.allocate(512, 16);
+    }
+    EXPECT_EQ(arena.BlockCount(), 1u);
+}
+
+TEST(FrameArenaTest, BacksPmrContainers) {
+    FrameArena arena;
+    std::pmr::vector<int> values(&arena);
+    for (int i = 0; i < 1000; ++i) {
+        values.push_back(i);
+    }
+    EXPECT_EQ(values[999], 999);
+    EXPECT_GT(arena.BytesUsed(), 1000u * sizeof(int));
+}
+
+TEST(FrameArenaTest, RegionBackedArenaCommitsInPlace) {
+    FrameArena arena(1024, 8u << 20, PageBacking::Transparent);
+    if (!arena.IsRegionBacked()) {
+        GTEST_SKIP() << "address space reservation unavailable";
+    }
+    auto* first = static_cast<std::byte*>(arena.allocate(64, 16));
+    auto* second = static_cast<std::byte*>(arena.allocate(3u << 20, 64));
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(second) % 64, 0u);
+    EXPECT_LT(second - first, 256);  // Same region, no block chain.
+    EXPECT_EQ(arena.BlockCount(), 0u);
+    EXPECT_GE(arena.Capacity(), (3u << 20) + 64u);
+
+    // Past the reservation a tick spills into heap blocks.
+    EXPECT_NE(arena.allocate(6u << 20, 16), nullptr);
+    EXPECT_EQ(arena.BlockCount(), 1u);
+
+    arena.Reset();
+    EXPECT_EQ(arena.BlockCount(), 0u);
+    EXPECT_EQ(arena.allocate(64, 16), first);
+}
+
+TEST(ScratchAllocatorTest, RegionBackedAllocationsNeverMove) {
+    ScratchAllocator scratch(4096, 16u << 20, PageBacking::Transparent);
+    if (!scratch.IsRegionBacked()) {
+        GTEST_SKIP() << "address space reservation unavailable";
+    }
+    auto* head = scratch.AllocateArray<int>(4);
+    head[0] = 42;
+    auto* big = scratch.AllocateArray<std::byte>(5u << 20);
+    ASSERT_NE(big, nullptr);
+    EXPECT_EQ(head[0], 42);  // The heap buffer would have been reallocated.
+    EXPECT_EQ(scratch.Allocate(32u << 20), nullptr);
+
+    scratch.Reset();
+    EXPECT_EQ(scratch.AllocateArray<int>(4), head);
+}
+
+// ── FrameArenaSet ───────────────────────────────────────────────────────────
+
+TEST(FrameArenaSetTest, InactiveSetUsesDefaultResource) {
+    FrameArenaSet arenas;
+    EXPECT_EQ(arenas.Resource(), std::pmr::get_default_resource());
+
+    arenas.SetActive(true);
+    EXPECT_EQ(arenas.Resource(), &arenas.Local());
+}
+
+TEST(FrameArenaSetTest, EachThreadGetsItsOwnArena) {
+    FrameArenaSet arenas;
+    arenas.SetActive(true);
+
+    std::vector<std::pmr::memory_resource*> resources(4);
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < resources.size(); ++t) {
+        threads.emplace_back([&, t] {
+            resources[t] = arenas.Resource();
+            (void)resources[t]->allocate(128, 16);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(std::set<std::pmr::memory_resource*>(resources.begin(), resources.end()).size(),
+              resources.size());
+    EXPECT_EQ(arenas.ArenaCount(), resources.size());
+}
+
+// ── SystemScheduler integration ─────────────────────────────────────────────
+
+/// Allocates a temporary vector from frame memory on every run.
+class FrameMemorySystem : public ISystem {
+public:
+    void Execute(float) override {
+        resource = FrameMemory();
+        std::pmr::vector<uint64_t> scratch(resource);
+        scratch.resize(4096);
+    }
+    [[nodiscard]] std::string_view GetName() const override { return "FrameMemorySystem"; }
+
+    std::pmr::memory_resource* resource = nullptr;
+};
+
+TEST(FrameArenaSetTest, SchedulerExposesArenaDuringTickAndResetsAfter) {
+    SystemScheduler scheduler;
+    auto& system = scheduler.Register<FrameMemorySystem>();
+    ASSERT_TRUE(scheduler.Build());
+
+    scheduler.Execute(0.016f);
+
+    auto& arenas = scheduler.GetFrameArenas();
+    EXPECT_EQ(system.resource, &arenas.Local());
+    EXPECT_EQ(arenas.Local().BytesUsed(), 0u);
+    EXPECT_GE(arenas.HighWaterMark(), 4096u * sizeof(uint64_t));
+    EXPECT_FALSE(arenas.IsActive());
+
+    // Steady state: the retained block covers the tick.
+    scheduler.Execute(0.016f);
+    EXPECT_EQ(arenas.Local().BlockCount(), 1u);
+}
@@ -0,0 +1,269 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+#include "cgs/ecs/entity_manager.hpp"
+#include "cgs/ecs/owning_group.hpp"
+#include "cgs/ecs/query.hpp"
+
+using namespace cgs::ecs;
+
+// ── Test component types ────────────────────────────────────────────────────
+
+struct Position {
+    float x = 0.0f;
+    float y = 0.0f;
+};
+
+struct Velocity {
+    float dx = 0.0f;
+    float dy = 0.0f;
+};
+
+struct Frozen {};
+
+// ── Helpers ─────────────────────────────────────────────────────────────────
+
+/// Group members must occupy the same prefix, in the same order, of both pools.
+template <typename Group>
+void expectLockstep(const Group& group, const ComponentStorage<Position>& positions,
+                    const ComponentStorage<Velocity>& velocities) {
+    for (std::size_t i = 0; i < group.Size(); ++i) {
+        ASSERT_EQ(positions.EntityAt(i), velocities.EntityAt(i)) << "slot " << i;
+    }
+    for (std::size_t i = group.Size(); i < positions.Size(); ++i) {
+        EXPECT_FALSE(velocities.Has(Entity(positions.EntityAt(i), 0))) << "slot " << i;
+    }
+}
+
+// ===========================================================================
+// OwningGroup: membership
+// ===========================================================================
+
+TEST(OwningGroupTest, ConstructionSortsExistingMatches) {
+    ComponentStorage<Position> positions;
+    ComponentStorage<Velocity> velocities;
+    for (uint32_t i = 0; i < 10; ++i) {
+        positions.Add(Entity(i, 0));
+    }
+    for (uint32_t i = 9; i > 0; i -= 3) {
+        velocities.Add(Entity(i, 0));
+    }
+
+    OwningGroup<Position, Velocity> group(positions, velocities);
+
+    EXPECT_EQ(group.Size(), 3u);
+    EXPECT_TRUE(group.Contains(Entity(9, 0)));
+    EXPECT_FALSE(group.Contains(Entity(8, 0)));
+    expectLockstep(group, positions, velocities);
+}
+
+TEST(OwningGroupTest, AddCompletingSetJoinsGroup) {
+    ComponentStorage<Position> positions;
+    ComponentStorage<Velocity> velocities;
+    OwningGroup<Position, Velocity> group(positions, velocities);
+
+    positions.Add(Entity(0, 0));
+    positions.Add(Entity(1, 0));
+    EXPECT_TRUE(group.Empty());
+
+    auto& vel = velocities.Add(Entity(1, 0), Velocity{3.0f, 0.0f});
+
+    EXPECT_EQ(group.Size(), 1u);
+    EXPECT_EQ(group.EntityAt(0), 1u);
+    EXPECT_FLOAT_EQ(vel.dx, 3.0f);  // Reference follows the moved slot.
+    expectLockstep(group, positions, velocities);
+}
+
+TEST(OwningGroupTest, RemoveLeavesGroupAndKeepsInvariant) {
+    ComponentStorage<Position> positions;
+    ComponentStorage<Velocity> velocities;
+    OwningGroup<Position, Velocity> group(positions, velocities);
+    for (uint32_t i = 0; i < 5; ++i) {
+        positions.Add(Entity(i, 0), Position{static_cast<float>(i), 0.0f});
+        velocities.Add(Entity(i, 0));
+    }
+    positions.Add(Entity(5, 0));
+
+    velocities.Remove(Entity(1, 0));
+    positions.Remove(Entity(3, 0));
+
+    EXPECT_EQ(group.Size(), 3u);
+    EXPECT_FALSE(group.Contains(Entity(1, 0)));
+    EXPECT_FALSE(group.Contains(Entity(3, 0)));
+    EXPECT_FLOAT_EQ(positions.Get(Entity(4, 0)).x, 4.0f);
+    expectLockstep(group, positions, velocities);
+}
+
+TEST(OwningGroupTest, DestroyThroughEntityManager) {
+    EntityManager manager;
+    ComponentStorage<Position> positions;
+    ComponentStorage<Velocity> velocities;
+    manager.RegisterStorage(&positions);
+    manager.RegisterStorage(&velocities);
+    OwningGroup<Position, Velocity> group(positions, velocities);
+
+    auto a = manager.Create();
+    auto b = manager.Create();
+    positions.Add(a);
+    velocities.Add(a);
+    positions.Add(b);
+    velocities.Add(b);
+
+    manager.Destroy(a);
+
+    EXPECT_EQ(group.Size(), 1u);
+    EXPECT_TRUE(group.Contains(b));
+    expectLockstep(group, positions, velocities);
+}
+
+TEST(OwningGroupTest, DestroyManyKeepsOwnedPoolsInLockstep) {
+    EntityManager manager;
+    ComponentStorage<Position> positions;
+    ComponentStorage<Velocity> velocities;
+    manager.RegisterStorage(&positions);
+    manager.RegisterStorage(&velocities);
+    OwningGroup<Position, Velocity> group(positions, velocities);
+
+    std::vector<Entity> entities;
+    manager.CreateMany(8, entities);
+    for (const Entity e : entities) {
+        positions.Add(e);
+        if (e.id() % 2 == 0) {
+            velocities.Add(e);
+        }
+    }
+
+    const std::vector<Entity> doomed{entities[0], entities[3], entities[6]};
+    manager.DestroyMany(doomed);
+
+    EXPECT_EQ(group.Size(), 2u);
+    EXPECT_TRUE(group.Contains(entities[2]));
+    EXPECT_TRUE(group.Contains(entities[4]));
+    expectLockstep(group, positions, velocities);
+}
+
+TEST(OwningGroupTest, ClearResetsGroup) {
+    ComponentStorage<Position> positions;
+    ComponentStorage<Velocity> velocities;
+    OwningGroup<Position, Velocity> group(positions, velocities);
+    positions.Add(Entity(0, 0));
+    velocities.Add(Entity(0, 0));
+
+    velocities.Clear();
+
+    EXPECT_TRUE(group.Empty());
+    velocities.Add(Entity(0, 0));
+    EXPECT_EQ(group.Size(), 1u);
+}
+
+TEST(OwningGroupTest, DestructorReleasesPools) {
+    ComponentStorage<Position> positions;
+    ComponentStorage<Velocity> velocities;
+    {
+        OwningGroup<Position, Velocity> group(positions, velocities);
+        EXPECT_EQ(positions.Owner(), &group);
+    }
+    EXPECT_EQ(positions.Owner(), nullptr);
+    EXPECT_EQ(velocities.Owner(), nullptr);
+}
+
+TEST(OwningGroupTest, RandomChurnKeepsLockstep) {
+    ComponentStorage<Position> positions;
+    ComponentStorage<Velocity> velocities;
+    OwningGroup<Position, Velocity> group(positions, velocities);
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<uint32_t> pick(0, 199);
+    for (int step = 0; step < 5'000; ++step) {
+        const Entity e(pick(rng), 0);
+        switch (rng() % 4) {
+            case 0:
+                if (!positions.Has(e)) positions.Add(e);
+                break;
+            case 1:
+                if (!velocities.Has(e)) velocities.Add(e);
+                break;
+            case 2:
+                positions.Remove(e);
+                break;
+            default:
+                velocities.Remove(e);
+                break;
+        }
+    }
+
+    std::size_t expected = 0;
+    for (std::size_t i = 0; i < positions.Size(); ++i) {
+        expected += velocities.Has(Entity(positions.EntityAt(i), 0)) ? 1u : 0u;
+    }
+    EXPECT_EQ(group.Size(), expected);
+    expectLockstep(group, positions, velocities);
+}
+
+// ===========================================================================
+// OwningGroup: iteration and Query interaction
+// ===========================================================================
+
+TEST(OwningGroupTest, ForEachVisitsMembersOnly) {
+    ComponentStorage<Position> positions;
+    ComponentStorage<Velocity> velocities;
+    OwningGroup<Position, Velocity> group(positions, velocities);
+    for (uint32_t i = 0; i < 8; ++i) {
+        positions.Add(Entity(i, 0));
+        if (i % 2 == 0) {
+            velocities.Add(Entity(i, 0), Velocity{1.0f, 0.0f});
+        }
+    }
+
+    std::unordered_set<uint32_t> seen;
+    group.ForEach([&](Entity e, Position& pos, Velocity& vel) {
+        pos.x += vel.dx;
+        seen.insert(e.id());
+    });
+
+    EXPECT_EQ(seen, (std::unordered_set<uint32_t>{0, 2, 4, 6}));
+    EXPECT_FLOAT_EQ(positions.Get(Entity(4, 0)).x, 1.0f);
+    EXPECT_FLOAT_EQ(positions.Get(Entity(5, 0)).x, 0.0f);
+}
+
+TEST(OwningGroupTest, TagPoolJoinsGroup) {
+    ComponentStorage<Position> positions;
+    ComponentStorage<Frozen> frozen;
+    OwningGroup<Position, Frozen> group(positions, frozen);
+    for (uint32_t i = 0; i < 6; ++i) {
+        positions.Add(Entity(i, 0));
+        if (i % 3 == 0) {
+            frozen.Add(Entity(i, 0));
+        }
+    }
+    frozen.Remove(Entity(0, 0));
+
+    std::unordered_set<uint32_t> seen;
+    group.ForEach([&](Entity e, Position&, Frozen&) { seen.insert(e.id()); });
+    EXPECT_EQ(seen, (std::unordered_set<uint32_t>{3}));
+    EXPECT_EQ(positions.EntityAt(0), frozen.EntityAt(0));
+}
+
+TEST(OwningGroupTest, QueryCacheSurvivesGroupReordering) {
+    ComponentStorage<Position> positions;
+    ComponentStorage<Velocity> velocities;
+    for (uint32_t i = 0; i < 4; ++i) {
+        positions.Add(Entity(i, 0));
+    }
+    velocities.Add(Entity(3, 0));
+
+    Query<Position> query(positions);
+    EXPECT_EQ(query.Count(), 4u);
+    const auto version = positions.Version();
+
+    // Pulling entity 3 to the front reorders the pool but not its contents.
+    OwningGroup<Position, Velocity> group(positions, velocities);
+
+    EXPECT_EQ(positions.EntityAt(0), 3u);
+    EXPECT_EQ(positions.Version(), version);
+    EXPECT_EQ(query.Count(), 4u);
+}
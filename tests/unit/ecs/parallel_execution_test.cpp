@@ -2,6 +2,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <functional>
 #include <iomanip>
 #include <mutex>
 #include <string>
@@ -10,8 +11,12 @@
 #include <unordered_set>
 #include <vector>
 
+#include "cgs/ecs/command_buffer.hpp"
+#include "cgs/ecs/entity_manager.hpp"
+#include "cgs/ecs/query.hpp"
 #include "cgs/ecs/scratch_allocator.hpp"
 #include "cgs/ecs/system_scheduler.hpp"
+#include "cgs/ecs/work_stealing_executor.hpp"
 
 using namespace cgs::ecs;
 
@@ -188,6 +193,37 @@ TEST(AccessInfoTest, MultiComponentConflict) {
     EXPECT_TRUE(a.ConflictsWith(b));
 }
 
+TEST(AccessInfoTest, ReadAndWriteMasksMatchInsertedIds) {
+    SystemAccessInfo info;
+    Read<CompA, CompB>::Apply(info);
+    Write<CompC>::Apply(info);
+
+    EXPECT_EQ(info.reads.size(), 2u);
+    EXPECT_TRUE(info.reads.contains(ComponentType<CompA>::Id()));
+    EXPECT_TRUE(info.reads.contains(ComponentType<CompB>::Id()));
+    EXPECT_FALSE(info.reads.contains(ComponentType<CompC>::Id()));
+    EXPECT_EQ(info.writes, Write<CompC>::Mask());
+    using ReadAB = Read<CompA, CompB>;
+    EXPECT_EQ(&ReadAB::Mask(), &ReadAB::Mask());
+}
+
+TEST(AccessInfoTest, IdsBeyondMaskWidthConflictConservatively) {
+    // An id past the mask width aliases a low bit: the check may report
+    // a false conflict but never misses a real one.
+    const auto low = ComponentType<CompA>::Id();
+    const auto aliased = static_cast<ComponentTypeId>(low + ComponentMask::kBits);
+
+    SystemAccessInfo writer;
+    writer.writes.insert(aliased);
+    SystemAccessInfo sameId;
+    sameId.reads.insert(aliased);
+    SystemAccessInfo aliasedReader;
+    aliasedReader.reads.insert(low);
+
+    EXPECT_TRUE(writer.ConflictsWith(sameId));
+    EXPECT_TRUE(writer.ConflictsWith(aliasedReader));
+}
+
 // ── Parallel batch computation tests ────────────────────────────────────
 
 class ParallelBatchTest : public ::testing::Test {
@@ -642,3 +678,436 @@ TEST(ParallelPerformanceTest, SpeedupWithIndependentSystems) {
     // on a multi-core machine. Allow generous margin for CI variability.
     EXPECT_LT(parDuration, seqDuration);
 }
+
+/// Per-entity payload for the query scaling test.
+struct Particle {
+    float x = 0.0f;
+    float v = 1.0f;
+};
+
+TEST(ParallelPerformanceTest, QueryParallelForEachScaling) {
+    constexpr uint32_t kEntityCount = 100'000;
+    constexpr std::size_t kGrainSize = 2'048;
+
+    ComponentStorage<Particle> particles;
+    for (uint32_t i = 0; i < kEntityCount; ++i) {
+        particles.Add(Entity(i, 0));
+    }
+    Query<Particle> query(particles);
+
+    auto integrate = [](Entity, Particle& p) {
+        // Enough arithmetic per entity that dispatch cost is amortized.
+        for (int step = 0; step < 64; ++step) {
+            p.x += p.v * 0.001f;
+            p.v *= 0.9999f;
+        }
+    };
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    query.ForEach(integrate);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    query.ParallelForEach(makeThreadExecutor(), kGrainSize, integrate);
+    auto t2 = std::chrono::high_resolution_clock::now();
+
+    const auto seqUs = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+    const auto parUs = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count();
+    const unsigned cores = std::thread::hardware_concurrency();
+
+    std::cout << "[PERF] Query ForEach         (" << kEntityCount << "): " << seqUs << " us\n";
+    std::cout << "[PERF] Query ParallelForEach (" << kEntityCount << ", grain " << kGrainSize
+              << "): " << parUs << " us on " << cores << " cores\n";
+
+    // Both passes ran over every entity exactly once.
+    const Particle& first = particles.Get(Entity(0, 0));
+    const Particle& last = particles.Get(Entity(kEntityCount - 1, 0));
+    EXPECT_FLOAT_EQ(first.x, last.x);
+
+    // Speedup is only meaningful when there is more than one core.
+    if (cores >= 4) {
+        EXPECT_LT(parUs, seqUs);
+    }
+}
+
+// ── Command buffer playback tests ───────────────────────────────────────
+
+struct Spawned {
+    int source = 0;
+};
+
+/// Records one spawn per run into the calling thread's command buffer.
+template <typename ReadT, int Source>
+class SpawnSystem : public ISystem {
+public:
+    SpawnSystem(CommandBufferSet& commands, ComponentStorage<Spawned>& spawned)
+        : commands_(commands), spawned_(spawned) {}
+
+    void Execute(float) override {
+        auto& cmd = commands_.Local();
+        cmd.Add(spawned_, cmd.Create(), Spawned{Source});
+    }
+    [[nodiscard]] std::string_view GetName() const override { return "SpawnSystem"; }
+    SystemAccessInfo GetAccessInfo() const override {
+        SystemAccessInfo info;
+        Read<ReadT>::Apply(info);
+        return info;
+    }
+
+private:
+    CommandBufferSet& commands_;
+    ComponentStorage<Spawned>& spawned_;
+};
+
+/// Observes how many spawns are visible when it runs.
+template <typename AccessT, bool Writes>
+class SpawnObserver : public ISystem {
+public:
+    explicit SpawnObserver(const ComponentStorage<Spawned>& spawned) : spawned_(spawned) {}
+
+    void Execute(float) override { seen = spawned_.Size(); }
+    [[nodiscard]] std::string_view GetName() const override { return "SpawnObserver"; }
+    SystemAccessInfo GetAccessInfo() const override {
+        SystemAccessInfo info;
+        if constexpr (Writes) {
+            Write<AccessT>::Apply(info);
+        } else {
+            Read<AccessT>::Apply(info);
+        }
+        return info;
+    }
+
+    std::size_t seen = 0;
+
+private:
+    const ComponentStorage<Spawned>& spawned_;
+};
+
+class CommandPlaybackTest : public ::testing::Test {
+protected:
+    CommandPlaybackTest() { entities.RegisterStorage(&spawned); }
+
+    EntityManager entities;
+    ComponentStorage<Spawned> spawned;
+    CommandBufferSet commands{entities};
+    SystemScheduler scheduler;
+};
+
+TEST_F(CommandPlaybackTest, ParallelBatchCommandsVisibleToNextBatch) {
+    scheduler.Register<SpawnSystem<CompA, 1>>(commands, spawned);
+    scheduler.Register<SpawnSystem<CompC, 2>>(commands, spawned);
+    // Writes CompA, so it conflicts with the first spawner.
+    auto& observer = scheduler.Register<SpawnObserver<CompA, true>>(spawned);
+
+    scheduler.SetCommandBuffers(&commands);
+    scheduler.SetParallelExecutor(makeThreadExecutor());
+    scheduler.EnableParallelExecution(true);
+    ASSERT_TRUE(scheduler.Build());
+    ASSERT_EQ(scheduler.GetParallelBatches(SystemStage::Update).size(), 2u);
+
+    scheduler.Execute(1.0f / 60.0f);
+
+    EXPECT_EQ(observer.seen, 2u);
+    EXPECT_EQ(entities.Count(), 2u);
+    EXPECT_TRUE(commands.Empty());
+}
+
+TEST_F(CommandPlaybackTest, SyncPointPlaysBackBeforeLaterSystems) {
+    scheduler.Register<SpawnSystem<CompC, 1>>(commands, spawned);
+    // Read-only on CompD: would share the spawner's batch without the sync point.
+    auto& observer = scheduler.Register<SpawnObserver<CompD, false>>(spawned);
+    scheduler.AddSyncPoint<SpawnSystem<CompC, 1>>();
+
+    scheduler.SetCommandBuffers(&commands);
+    scheduler.SetParallelExecutor(makeThreadExecutor());
+    scheduler.EnableParallelExecution(true);
+    ASSERT_TRUE(scheduler.Build());
+
+    scheduler.Execute(1.0f / 60.0f);
+    EXPECT_EQ(observer.seen, 1u);
+
+    scheduler.Execute(1.0f / 60.0f);
+    EXPECT_EQ(observer.seen, 2u);
+}
+
+TEST_F(CommandPlaybackTest, SequentialModePlaysBackAfterEachSystem) {
+    scheduler.Register<SpawnSystem<CompA, 1>>(commands, spawned);
+    auto& observer = scheduler.Register<SpawnObserver<CompD, false>>(spawned);
+    scheduler.AddDependency<SpawnSystem<CompA, 1>, SpawnObserver<CompD, false>>();
+
+    scheduler.SetCommandBuffers(&commands);
+    ASSERT_TRUE(scheduler.Build());
+
+    scheduler.Execute(1.0f / 60.0f);
+
+    EXPECT_EQ(observer.seen, 1u);
+}
+
+// ── WorkStealingExecutor tests ──────────────────────────────────────────
+
+TEST(WorkStealingExecutorTest, RunsEveryTaskExactlyOnce) {
+    WorkStealingExecutor executor(3);
+    std::vector<std::atomic<int>> hits(100);
+    std::vector<WorkStealingExecutor::Task> tasks;
+    for (auto& hit : hits) {
+        tasks.push_back({[](void* c) { ++*static_cast<std::atomic<int>*>(c); }, &hit});
+    }
+
+    for (int tick = 0; tick < 50; ++tick) {
+        executor.Run(tasks);
+    }
+
+    for (const auto& hit : hits) {
+        EXPECT_EQ(hit.load(), 50);
+    }
+}
+
+TEST(WorkStealingExecutorTest, ZeroWorkersRunsInlineOnCaller) {
+    WorkStealingExecutor executor(0);
+    const auto caller = std::this_thread::get_id();
+    std::thread::id ran[2];
+    auto record = [](void* c) { *static_cast<std::thread::id*>(c) = std::this_thread::get_id(); };
+    const WorkStealingExecutor::Task tasks[] = {{record, &ran[0]}, {record, &ran[1]}};
+
+    executor.Run(tasks);
+
+    EXPECT_EQ(executor.WorkerCount(), 0u);
+    EXPECT_EQ(ran[0], caller);
+    EXPECT_EQ(ran[1], caller);
+}
+
+TEST(WorkStealingExecutorTest, TasksSpreadAcrossWorkers) {
+    WorkStealingExecutor executor(2);
+    std::mutex mutex;
+    std::unordered_set<std::thread::id> threads;
+    std::vector<std::function<void()>> tasks(3, [&] {
+        {
+            std::lock_guard lock(mutex);
+            threads.insert(std::this_thread::get_id());
+        }
+        // Hold the thread so the others must pick up their own task.
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    });
+
+    executor(tasks);
+
+    EXPECT_GE(threads.size(), 2u);
+}
+
+TEST(WorkStealingExecutorTest, DrivesQueryParallelForEach) {
+    WorkStealingExecutor executor(2);
+    ComponentStorage<CompA> storage;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        storage.Add(Entity(i, 0));
+    }
+    std::atomic<int> visited{0};
+
+    Query<CompA> query(storage);
+    query.ParallelForEach(std::ref(executor), 64, [&](Entity, CompA&) { ++visited; });
+
+    EXPECT_EQ(visited.load(), 1000);
+}
+
+TEST_F(ParallelExecutionTest, WorkStealingExecutorRunsAllSystems) {
+    auto& a = scheduler.Register<ReadAWriteB>();
+    auto& b = scheduler.Register<ReadC>();
+    auto& c = scheduler.Register<ReadD>();
+    auto& d = scheduler.Register<WriteA>();
+
+    WorkStealingExecutor executor(2);
+    scheduler.EnableParallelExecution(executor);
+    ASSERT_TRUE(scheduler.IsParallelExecutionEnabled());
+    ASSERT_TRUE(scheduler.Build());
+
+    for (int tick = 0; tick < 10; ++tick) {
+        scheduler.Execute(1.0f / 60.0f);
+    }
+
+    EXPECT_EQ(a.callCount.load(), 10);
+    EXPECT_EQ(b.callCount.load(), 10);
+    EXPECT_EQ(c.callCount.load(), 10);
+    EXPECT_EQ(d.callCount.load(), 10);
+}
+
+TEST_F(CommandPlaybackTest, WorkStealingExecutorPlaysBackAtBatchBoundary) {
+    scheduler.Register<SpawnSystem<CompA, 1>>(commands, spawned);
+    scheduler.Register<SpawnSystem<CompC, 2>>(commands, spawned);
+    auto& observer = scheduler.Register<SpawnObserver<CompA, true>>(spawned);
+
+    WorkStealingExecutor executor(2);
+    scheduler.SetCommandBuffers(&commands);
+    scheduler.EnableParallelExecution(executor);
+    ASSERT_TRUE(scheduler.Build());
+
+    scheduler.Execute(1.0f / 60.0f);
+
+    EXPECT_EQ(observer.seen, 2u);
+}
+
+// ── Graph execution tests ───────────────────────────────────────────────
+
+/// System with configurable access that runs an injected body.
+template <int Tag>
+class GraphSystem : public ISystem {
+public:
+    GraphSystem(SystemAccessInfo access, std::function<void()> body)
+        : access_(std::move(access)), body_(std::move(body)) {}
+
+    void Execute(float) override {
+        body_();
+        ++callCount;
+    }
+    [[nodiscard]] std::string_view GetName() const override { return "GraphSystem"; }
+    SystemAccessInfo GetAccessInfo() const override { return access_; }
+
+    std::atomic<int> callCount{0};
+
+private:
+    SystemAccessInfo access_;
+    std::function<void()> body_;
+};
+
+template <typename... Reads>
+static SystemAccessInfo reads() {
+    SystemAccessInfo info;
+    Read<Reads...>::Apply(info);
+    return info;
+}
+
+template <typename R, typename W>
+static SystemAccessInfo readWrite() {
+    SystemAccessInfo info;
+    Read<R>::Apply(info);
+    Write<W>::Apply(info);
+    return info;
+}
+
+class GraphExecutionTest : public ::testing::Test {
+protected:
+    SystemScheduler scheduler;
+};
+
+TEST_F(GraphExecutionTest, EdgesFollowConflictsAndDependencies) {
+    scheduler.Register<GraphSystem<0>>(readWrite<CompA, CompB>(), [] {});
+    scheduler.Register<GraphSystem<1>>(reads<CompC>(), [] {});
+    scheduler.Register<GraphSystem<2>>(readWrite<CompD, CompA>(), [] {});  // Conflicts with 0.
+    scheduler.Register<GraphSystem<3>>(reads<CompD>(), [] {});
+    scheduler.AddDependency<GraphSystem<1>, GraphSystem<3>>();
+    ASSERT_TRUE(scheduler.Build());
+
+    const auto& graph = scheduler.GetExecutionGraph(SystemStage::Update);
+    ASSERT_EQ(graph.size(), 1u);
+    const auto& nodes = graph[0].nodes;
+    ASSERT_EQ(nodes.size(), 4u);
+
+    auto indexOf = [&](SystemTypeId id) {
+        return static_cast<std::size_t>(
+            std::find_if(nodes.begin(), nodes.end(),
+                         [&](const auto& n) { return n.system == id; }) -
+            nodes.begin());
+    };
+    const auto n0 = indexOf(SystemType<GraphSystem<0>>::Id());
+    const auto n1 = indexOf(SystemType<GraphSystem<1>>::Id());
+    const auto n2 = indexOf(SystemType<GraphSystem<2>>::Id());
+    const auto n3 = indexOf(SystemType<GraphSystem<3>>::Id());
+
+    EXPECT_EQ(nodes[n0].successors, std::vector<std::size_t>{n2});
+    EXPECT_EQ(nodes[n1].successors, std::vector<std::size_t>{n3});
+    EXPECT_EQ(nodes[n2].predecessorCount, 1u);
+    EXPECT_EQ(nodes[n3].predecessorCount, 1u);
+}
+
+TEST_F(GraphExecutionTest, SyncPointSplitsSegments) {
+    scheduler.Register<GraphSystem<0>>(reads<CompA>(), [] {});
+    scheduler.Register<GraphSystem<1>>(reads<CompB>(), [] {});
+    scheduler.AddSyncPoint<GraphSystem<0>>();
+    ASSERT_TRUE(scheduler.Build());
+
+    const auto& graph = scheduler.GetExecutionGraph(SystemStage::Update);
+    ASSERT_EQ(graph.size(), 2u);
+    EXPECT_EQ(graph[0].nodes.size(), 1u);
+    EXPECT_EQ(graph[1].nodes.size(), 1u);
+}
+
+TEST_F(GraphExecutionTest, IndependentChainDoesNotWaitForSlowSystem) {
+    // Batches would be {slow, writerA} then {readerA}: readerA would wait
+    // for slow.  In graph mode it only waits for writerA.
+    std::atomic<bool> slowDone{false};
+    std::atomic<bool> readerRanBeforeSlowDone{false};
+
+    scheduler.Register<GraphSystem<0>>(reads<CompC>(), [&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        slowDone = true;
+    });
+    scheduler.Register<GraphSystem<1>>(readWrite<CompD, CompA>(), [] {});
+    scheduler.Register<GraphSystem<2>>(reads<CompA>(),
+                                       [&] { readerRanBeforeSlowDone = !slowDone.load(); });
+
+    scheduler.SetParallelExecutor(makeThreadExecutor());
+    scheduler.EnableParallelExecution(true);
+    scheduler.SetParallelMode(ParallelMode::Graph);
+    ASSERT_TRUE(scheduler.Build());
+    ASSERT_EQ(scheduler.GetParallelBatches(SystemStage::Update).size(), 2u);
+
+    scheduler.Execute(1.0f / 60.0f);
+
+    EXPECT_TRUE(slowDone.load());
+    EXPECT_TRUE(readerRanBeforeSlowDone.load());
+}
+
+TEST_F(GraphExecutionTest, CriticalPathReportsSlowestChain) {
+    auto& slow = scheduler.Register<GraphSystem<0>>(reads<CompC>(), [] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    });
+    scheduler.Register<GraphSystem<1>>(readWrite<CompD, CompA>(), [] {});
+    scheduler.Register<GraphSystem<2>>(reads<CompA>(), [] {});
+
+    WorkStealingExecutor executor(2);
+    scheduler.EnableParallelExecution(executor);
+    scheduler.SetParallelMode(ParallelMode::Graph);
+    ASSERT_TRUE(scheduler.Build());
+    EXPECT_TRUE(scheduler.GetCriticalPath(SystemStage::Update).systems.empty());
+
+    scheduler.Execute(1.0f / 60.0f);
+
+    const auto& path = scheduler.GetCriticalPath(SystemStage::Update);
+    ASSERT_EQ(path.systems.size(), 1u);
+    EXPECT_EQ(path.systems[0], SystemType<GraphSystem<0>>::Id());
+    EXPECT_GE(path.length, std::chrono::milliseconds(20));
+    EXPECT_EQ(slow.callCount.load(), 1);
+}
+
+TEST_F(GraphExecutionTest, CriticalPathSpansSegments) {
+    scheduler.Register<GraphSystem<0>>(reads<CompA>(), [] {});
+    scheduler.Register<GraphSystem<1>>(reads<CompB>(), [] {});
+    scheduler.AddSyncPoint<GraphSystem<0>>();
+
+    scheduler.SetParallelExecutor(makeThreadExecutor());
+    scheduler.EnableParallelExecution(true);
+    scheduler.SetParallelMode(ParallelMode::Graph);
+    ASSERT_TRUE(scheduler.Build());
+
+    scheduler.Execute(1.0f / 60.0f);
+
+    const auto& path = scheduler.GetCriticalPath(SystemStage::Update);
+    EXPECT_EQ(path.systems, (std::vector<SystemTypeId>{SystemType<GraphSystem<0>>::Id(),
+                                                       SystemType<GraphSystem<1>>::Id()}));
+}
+
+TEST_F(GraphExecutionTest, DisabledSystemsReleaseSuccessors) {
+    auto& writer = scheduler.Register<GraphSystem<0>>(readWrite<CompD, CompA>(), [] {});
+    auto& reader = scheduler.Register<GraphSystem<1>>(reads<CompA>(), [] {});
+    auto& other = scheduler.Register<GraphSystem<2>>(reads<CompC>(), [] {});
+    scheduler.SetEnabled<GraphSystem<0>>(false);
+
+    WorkStealingExecutor executor(2);
+    scheduler.EnableParallelExecution(executor);
+    scheduler.SetParallelMode(ParallelMode::Graph);
+    ASSERT_TRUE(scheduler.Build());
+
+    for (int tick = 0; tick < 5; ++tick) {
+        scheduler.Execute(1.0f / 60.0f);
+    }
+
+    EXPECT_EQ(writer.callCount.load(), 0);
+    EXPECT_EQ(reader.callCount.load(), 5);
+    EXPECT_EQ(other.callCount.load(), 5);
+}
@@ -1,12 +1,18 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <functional>
+#include <mutex>
+#include <thread>
 #include <unordered_set>
 #include <vector>
 
 #include "cgs/ecs/entity_manager.hpp"
+#include "cgs/ecs/archetype_storage.hpp"
 #include "cgs/ecs/query.hpp"
+#include "cgs/ecs/scratch_allocator.hpp"
 
 using namespace cgs::ecs;
 
@@ -528,3 +534,422 @@ TEST_F(QueryTest, PerformanceForEach10KEntities) {
 
     EXPECT_EQ(query.Count(), static_cast<std::size_t>(kEntityCount));
 }
+
+// ── ParallelForEach ─────────────────────────────────────────────────────────
+
+namespace {
+
+/// Executor that runs every task on its own std::thread.
+void threadExecutor(const std::vector<std::function<void()>>& tasks) {
+    std::vector<std::thread> threads;
+    threads.reserve(tasks.size());
+    for (const auto& task : tasks) {
+        threads.emplace_back(task);
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+}
+
+}  // namespace
+
+TEST_F(QueryTest, ParallelForEachVisitsEachEntityOnce) {
+    constexpr int kEntityCount = 5'000;
+    for (int i = 0; i < kEntityCount; ++i) {
+        auto e = em_.Create();
+        positions_.Add(e, Position{0.0f, 0.0f});
+        velocities_.Add(e, Velocity{1.0f, 0.0f});
+    }
+
+    Query<Position, Velocity> query(positions_, velocities_);
+    std::size_t batches = 0;
+    query.ParallelForEach(
+        [&](const std::vector<std::function<void()>>& tasks) {
+            batches = tasks.size();
+            threadExecutor(tasks);
+        },
+        256, [](Entity, Position& pos, Velocity& vel) { pos.x += vel.dx; });
+
+    EXPECT_EQ(batches, (kEntityCount + 255) / 256u);
+    query.ForEach([](Entity, Position& pos, Velocity&) { EXPECT_FLOAT_EQ(pos.x, 1.0f); });
+}
+
+TEST_F(QueryTest, ParallelForEachHonorsExcludes) {
+    for (int i = 0; i < 100; ++i) {
+        auto e = em_.Create();
+        positions_.Add(e);
+        if (i % 4 == 0) {
+            statics_.Add(e);
+        }
+    }
+
+    Query<Position> query(positions_);
+    query.Exclude(statics_);
+
+    std::atomic<int> visited{0};
+    query.ParallelForEach(threadExecutor, 16, [&](Entity, Position&) { ++visited; });
+
+    EXPECT_EQ(visited.load(), 75);
+}
+
+TEST_F(QueryTest, ParallelForEachWithoutExecutorRunsInline) {
+    for (int i = 0; i < 10; ++i) {
+        positions_.Add(em_.Create());
+    }
+
+    Query<Position> query(positions_);
+    const auto caller = std::this_thread::get_id();
+    bool allInline = true;
+    query.ParallelForEach(nullptr, 2, [&](Entity, Position&) {
+        allInline = allInline && std::this_thread::get_id() == caller;
+    });
+
+    EXPECT_TRUE(allInline);
+}
+
+TEST_F(QueryTest, ParallelForEachRewindsWorkerScratch) {
+    for (int i = 0; i < 64; ++i) {
+        positions_.Add(em_.Create());
+    }
+
+    auto& scratch = ScratchAllocator::GetThreadLocal();
+    scratch.Reset();
+    scratch.Allocate(32);
+    const std::size_t before = scratch.BytesUsed();
+
+    Query<Position> query(positions_);
+    query.ParallelForEach(nullptr, 8, [](Entity, Position& pos) {
+        auto* tmp = ScratchAllocator::GetThreadLocal().AllocateArray<float>(4);
+        tmp[0] = 1.0f;
+        pos.x += tmp[0];
+    });
+
+    EXPECT_EQ(scratch.BytesUsed(), before);
+}
+
+TEST(QueryParallelTest, ArchetypeRangesCoverAllRows) {
+    using Storage = ArchetypeStorage<Position, Velocity>;
+    Storage storage;
+    const auto count = static_cast<uint32_t>(Storage::kChunkCapacity * 2 + 7);
+    for (uint32_t i = 0; i < count; ++i) {
+        storage.Add(Entity(i, 0), Position{}, Velocity{1.0f, 1.0f});
+    }
+
+    Query<Position, Velocity> query(storage);
+    std::mutex mutex;
+    std::unordered_set<uint32_t> seen;
+    query.ParallelForEach(threadExecutor, 100, [&](Entity e, Position& pos, Velocity& vel) {
+        pos.y += vel.dy;
+        std::lock_guard lock(mutex);
+        seen.insert(e.id());
+    });
+
+    EXPECT_EQ(seen.size(), count);
+    EXPECT_FLOAT_EQ(storage.Get<Position>(Entity(count - 1, 0)).y, 1.0f);
+}
+
+// ── Change filters ──────────────────────────────────────────────────────────
+
+TEST_F(QueryTest, ChangedFilterSkipsUntouchedEntities) {
+    std::vector<Entity> all;
+    for (int i = 0; i < 10; ++i) {
+        auto e = em_.Create();
+        positions_.Add(e);
+        velocities_.Add(e);
+        all.push_back(e);
+    }
+    const uint32_t since = CurrentChangeVersion();
+    positions_.MarkChanged(all[2]);
+    positions_.Replace(all[7], Position{1.0f, 1.0f});
+    velocities_.MarkChanged(all[4]);  // Different component: not matched.
+
+    Query<Position, Velocity> query(positions_, velocities_);
+    query.Changed<Position>(since);
+
+    std::unordered_set<uint32_t> seen;
+    query.ForEach([&](Entity e, Position&, Velocity&) { seen.insert(e.id()); });
+
+    EXPECT_EQ(seen, (std::unordered_set<uint32_t>{all[2].id(), all[7].id()}));
+}
+
+TEST_F(QueryTest, ChangedFilterRearmReplacesThreshold) {
+    auto e = em_.Create();
+    positions_.Add(e);
+
+    Query<Position> query(positions_);
+    EXPECT_EQ(query.Changed<Position>(kAnyVersion).Count(), 1u);
+
+    const uint32_t since = CurrentChangeVersion();
+    EXPECT_EQ(query.Changed<Position>(since).Count(), 0u);
+
+    positions_.MarkChanged(e);
+    EXPECT_EQ(query.Count(), 1u);
+}
+
+TEST_F(QueryTest, AddedFilterIgnoresModifications) {
+    auto old = em_.Create();
+    positions_.Add(old);
+    const uint32_t since = CurrentChangeVersion();
+    positions_.MarkChanged(old);
+    auto fresh = em_.Create();
+    positions_.Add(fresh);
+
+    Query<Position> query(positions_);
+    query.Added<Position>(since);
+
+    std::vector<Entity> entities;
+    for (Entity entity : query) {
+        entities.push_back(entity);
+    }
+    ASSERT_EQ(entities.size(), 1u);
+    EXPECT_EQ(entities[0].id(), fresh.id());
+}
+
+TEST_F(QueryTest, VersionsComparableAcrossStorages) {
+    auto e = em_.Create();
+    positions_.Add(e);
+    healths_.Add(e);
+    const uint32_t since = CurrentChangeVersion();
+    healths_.MarkChanged(e);
+
+    EXPECT_FALSE(positions_.HasChanged(e, since));
+    EXPECT_TRUE(healths_.HasChanged(e, since));
+    EXPECT_GT(healths_.GetVersion(e), positions_.GetVersion(e));
+}
+
+// ── Incremental cache maintenance ───────────────────────────────────────────
+
+namespace {
+
+std::vector<uint32_t> sortedIds(Query<Position, Velocity>& query) {
+    std::vector<uint32_t> ids;
+    for (Entity entity : query) {
+        ids.push_back(entity.id());
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+}  // namespace
+
+TEST_F(QueryTest, CachePatchedOnAddAndRemove) {
+    std::vector<Entity> es;
+    for (int i = 0; i < 4; ++i) {
+        es.push_back(em_.Create());
+        positions_.Add(es.back());
+        velocities_.Add(es.back());
+    }
+    Query<Position, Velocity> query(positions_, velocities_);
+    query.Exclude(dead_);
+    EXPECT_EQ(query.Count(), 4u);
+    EXPECT_EQ(query.RebuildCount(), 1u);
+    EXPECT_EQ(positions_.ListenerCount(), 1u);
+    EXPECT_EQ(dead_.ListenerCount(), 1u);
+
+    auto fresh = em_.Create();
+    positions_.Add(fresh);
+    velocities_.Add(fresh);
+    velocities_.Remove(es[1]);
+    dead_.Add(es[2]);
+
+    EXPECT_EQ(sortedIds(query), (std::vector<uint32_t>{es[0].id(), es[3].id(), fresh.id()}));
+    EXPECT_EQ(query.RebuildCount(), 1u);
+    EXPECT_EQ(query.PatchCount(), 1u);
+
+    dead_.Remove(es[2]);
+    EXPECT_EQ(query.Count(), 4u);
+    EXPECT_EQ(query.RebuildCount(), 1u);
+    EXPECT_EQ(query.PatchCount(), 2u);
+}
+
+TEST_F(QueryTest, ComponentWritesDoNotInvalidateCache) {
+    auto e = em_.Create();
+    positions_.Add(e);
+    velocities_.Add(e);
+    Query<Position, Velocity> query(positions_, velocities_);
+    EXPECT_EQ(query.Count(), 1u);
+
+    positions_.MarkChanged(e);
+    positions_.Get(e).x = 5.0f;
+    EXPECT_EQ(query.Count(), 1u);
+    EXPECT_EQ(query.RebuildCount(), 1u);
+    EXPECT_EQ(query.PatchCount(), 0u);
+}
+
+TEST_F(QueryTest, ClearForcesRebuild) {
+    auto e = em_.Create();
+    positions_.Add(e);
+    velocities_.Add(e);
+    Query<Position, Velocity> query(positions_, velocities_);
+    EXPECT_EQ(query.Count(), 1u);
+
+    velocities_.Clear();
+    EXPECT_EQ(query.Count(), 0u);
+    EXPECT_EQ(query.RebuildCount(), 2u);
+}
+
+TEST_F(QueryTest, VersionFilteredQueryRebuildsWithoutSubscribing) {
+    auto e = em_.Create();
+    positions_.Add(e);
+    velocities_.Add(e);
+    Query<Position, Velocity> query(positions_, velocities_);
+    query.Changed<Position>(CurrentChangeVersion());
+    EXPECT_EQ(query.Count(), 0u);
+    EXPECT_EQ(positions_.ListenerCount(), 0u);
+
+    positions_.MarkChanged(e);
+    EXPECT_EQ(query.Count(), 1u);
+    EXPECT_EQ(query.PatchCount(), 0u);
+}
+
+TEST_F(QueryTest, MovedQueryKeepsSubscriptionsAndDestroyedQueryDropsThem) {
+    auto e = em_.Create();
+    positions_.Add(e);
+    velocities_.Add(e);
+    {
+        Query<Position, Velocity> original(positions_, velocities_);
+        EXPECT_EQ(original.Count(), 1u);
+
+        Query<Position, Velocity> moved(std::move(original));
+        velocities_.Remove(e);
+        EXPECT_EQ(moved.Count(), 0u);
+        EXPECT_EQ(moved.PatchCount(), 1u);
+        EXPECT_EQ(velocities_.ListenerCount(), 1u);
+    }
+    EXPECT_EQ(positions_.ListenerCount(), 0u);
+    EXPECT_EQ(velocities_.ListenerCount(), 0u);
+}
+
+TEST_F(QueryTest, ParallelReadersSubscribeToTheSamePool) {
+    for (int i = 0; i < 16; ++i) {
+        auto e = em_.Create();
+        positions_.Add(e);
+        velocities_.Add(e);
+    }
+
+    // Read-only systems of one stage building their caches concurrently.
+    std::vector<std::thread> readers;
+    std::atomic<int> counted{0};
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&] {
+            for (int round = 0; round < 200; ++round) {
+                Query<Position, Velocity> query(positions_, velocities_);
+                counted.fetch_add(static_cast<int>(query.Count()), std::memory_order_relaxed);
+            }
+        });
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(counted.load(), 4 * 200 * 16);
+    EXPECT_EQ(positions_.ListenerCount(), 0u);
+    EXPECT_EQ(velocities_.ListenerCount(), 0u);
+}
+
+TEST_F(QueryTest, CacheStatsCountRebuildsAndPatches) {
+    const auto before = GetQueryCacheStats();
+    auto e = em_.Create();
+    positions_.Add(e);
+    velocities_.Add(e);
+    Query<Position, Velocity> query(positions_, velocities_);
+    EXPECT_EQ(query.Count(), 1u);
+    positions_.Remove(e);
+    EXPECT_EQ(query.Count(), 0u);
+
+    const auto after = GetQueryCacheStats();
+    EXPECT_EQ(after.rebuilds - before.rebuilds, 1u);
+    EXPECT_EQ(after.patches - before.patches, 1u);
+}
+
+// ── Tag includes ────────────────────────────────────────────────────────────
+
+TEST_F(QueryTest, TagIncludeMatchesTaggedEntities) {
+    auto moving = em_.Create();
+    positions_.Add(moving);
+    auto parked = em_.Create();
+    positions_.Add(parked);
+    statics_.Add(parked);
+
+    Query<Position, Static> query(positions_, statics_);
+    std::vector<uint32_t> ids;
+    query.ForEach([&](Entity e, Position&, Static&) { ids.push_back(e.id()); });
+    EXPECT_EQ(ids, (std::vector<uint32_t>{parked.id()}));
+
+    statics_.Remove(parked);
+    EXPECT_EQ(query.Count(), 0u);
+    EXPECT_EQ(query.PatchCount(), 1u);
+}
+
+// ── Iteration order ─────────────────────────────────────────────────────────
+
+TEST_F(QueryTest, ForEachVisitsEveryMatchAcrossShuffledPools) {
+    // More matches than the prefetch lookahead, with each pool's dense
+    // order different from the driving pool's.
+    constexpr int kCount = 100;
+    std::vector<Entity> es;
+    for (int i = 0; i < kCount; ++i) {
+        es.push_back(em_.Create());
+        positions_.Add(es.back(), Position{static_cast<float>(i), 0.0f});
+    }
+    for (int i = kCount - 1; i >= 0; --i) {
+        velocities_.Add(es[static_cast<std::size_t>(i)], Velocity{1.0f, 0.0f});
+    }
+    for (int i = 0; i < kCount; i += 2) {
+        healths_.Add(es[static_cast<std::size_t>((i * 37) % kCount)]);
+    }
+
+    Query<Position, Velocity, Health> query(positions_, velocities_, healths_);
+    std::size_t visited = 0;
+    query.ForEach([&](Entity, Position& pos, Velocity& vel, Health&) {
+        pos.x += vel.dx;
+        ++visited;
+    });
+    EXPECT_EQ(visited, healths_.Size());
+    for (int i = 0; i < kCount; ++i) {
+        const auto e = es[static_cast<std::size_t>(i)];
+        const float expected = static_cast<float>(i) + (healths_.Has(e) ? 1.0f : 0.0f);
+        EXPECT_FLOAT_EQ(positions_.Get(e).x, expected);
+    }
+}
+
+TEST_F(QueryTest, OrderByIdVisitsAscendingIdsAfterRebuildAndPatch) {
+    std::vector<Entity> es;
+    for (int i = 0; i < 6; ++i) {
+        es.push_back(em_.Create());
+    }
+    // Driving pool in descending id order.
+    for (auto it = es.rbegin(); it != es.rend(); ++it) {
+        positions_.Add(*it);
+        velocities_.Add(*it);
+    }
+
+    Query<Position, Velocity> query(positions_, velocities_);
+    query.OrderById();
+    auto ids = [&] {
+        std::vector<uint32_t> out;
+        query.ForEach([&](Entity e, Position&, Velocity&) { out.push_back(e.id()); });
+        return out;
+    };
+    auto first = ids();
+    EXPECT_TRUE(std::is_sorted(first.begin(), first.end()));
+    EXPECT_EQ(first.size(), 6u);
+
+    // Removal swaps the last match into the hole; the order is restored.
+    velocities_.Remove(es[1]);
+    auto fresh = em_.Create();
+    positions_.Add(fresh);
+    velocities_.Add(fresh);
+    auto second = ids();
+    EXPECT_TRUE(std::is_sorted(second.begin(), second.end()));
+    EXPECT_EQ(second.size(), 6u);
+    EXPECT_EQ(query.RebuildCount(), 1u);
+    EXPECT_EQ(query.PatchCount(), 1u);
+
+    // The slots follow the sort, so later patches still find entities.
+    positions_.Remove(es[4]);
+    positions_.Remove(es[0]);
+    auto third = ids();
+    EXPECT_TRUE(std::is_sorted(third.begin(), third.end()));
+    EXPECT_EQ(third, (std::vector<uint32_t>{es[2].id(), es[3].id(), es[5].id(), fresh.id()}));
+}
@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cgs/ecs/component_storage.hpp"
+#include "cgs/ecs/small_vector.hpp"
+
+using namespace cgs::ecs;
+
+namespace {
+
+/// Element that tracks how many instances are alive.
+struct Tracked {
+    static inline int live = 0;
+
+    explicit Tracked(int v = 0) : value(v) { ++live; }
+    Tracked(const Tracked& other) : value(other.value) { ++live; }
+    Tracked(Tracked&& other) noexcept : value(other.value) { ++live; }
+    Tracked& operator=(const Tracked&) = default;
+    Tracked& operator=(Tracked&&) noexcept = default;
+    ~Tracked() { --live; }
+
+    bool operator==(const Tracked& other) const { return value == other.value; }
+
+    int value;
+};
+
+std::vector<int> values(const SmallVector<Tracked, 2>& vec) {
+    std::vector<int> out;
+    for (const auto& t : vec) {
+        out.push_back(t.value);
+    }
+    return out;
+}
+
+}  // namespace
+
+TEST(SmallVectorTest, StaysInlineUpToCapacity) {
+    SmallVector<int, 4> vec;
+    EXPECT_TRUE(vec.empty());
+    EXPECT_EQ(vec.capacity(), 4u);
+
+    for (int i = 0; i < 4; ++i) {
+        vec.push_back(i);
+    }
+    EXPECT_TRUE(vec.IsInline());
+    EXPECT_EQ(vec.size(), 4u);
+
+    vec.push_back(4);
+    EXPECT_FALSE(vec.IsInline());
+    EXPECT_GE(vec.capacity(), 5u);
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(vec[static_cast<std::size_t>(i)], i);
+    }
+    EXPECT_EQ(vec.front(), 0);
+    EXPECT_EQ(vec.back(), 4);
+}
+
+TEST(SmallVectorTest, GrowingKeepsAliasedArgumentValid) {
+    SmallVector<std::string, 1> vec;
+    vec.push_back("first element, long enough to own a heap buffer");
+    vec.push_back(vec.back());
+    ASSERT_EQ(vec.size(), 2u);
+    EXPECT_EQ(vec[0], vec[1]);
+}
+
+TEST(SmallVectorTest, EraseShiftsAndDestroys) {
+    {
+        SmallVector<Tracked, 2> vec;
+        for (int i = 0; i < 5; ++i) {
+            vec.emplace_back(i);
+        }
+        EXPECT_EQ(Tracked::live, 5);
+
+        vec.erase(vec.begin() + 1);
+        EXPECT_EQ(values(vec), (std::vector<int>{0, 2, 3, 4}));
+
+        const auto removed = erase_if(vec, [](const Tracked& t) { return t.value % 2 == 0; });
+        EXPECT_EQ(removed, 3u);
+        EXPECT_EQ(values(vec), (std::vector<int>{3}));
+        EXPECT_EQ(Tracked::live, 1);
+
+        vec.pop_back();
+        EXPECT_TRUE(vec.empty());
+        EXPECT_EQ(Tracked::live, 0);
+    }
+    EXPECT_EQ(Tracked::live, 0);
+}
+
+TEST(SmallVectorTest, CopyAndMovePreserveContents) {
+    {
+        SmallVector<Tracked, 2> inlineVec;
+        inlineVec.emplace_back(1);
+        SmallVector<Tracked, 2> heapVec;
+        for (int i = 0; i < 4; ++i) {
+            heapVec.emplace_back(i);
+        }
+
+        SmallVector<Tracked, 2> inlineCopy(inlineVec);
+        SmallVector<Tracked, 2> heapCopy = heapVec;
+        EXPECT_TRUE(inlineCopy == inlineVec);
+        EXPECT_TRUE(heapCopy == heapVec);
+
+        const auto* heapBlock = heapVec.data();
+        SmallVector<Tracked, 2> stolen(std::move(heapVec));
+        EXPECT_EQ(stolen.data(), heapBlock);  // block changes hands, no copy
+        EXPECT_TRUE(heapVec.empty());
+        EXPECT_TRUE(heapVec.IsInline());
+
+        SmallVector<Tracked, 2> moved;
+        moved.emplace_back(9);
+        moved = std::move(inlineVec);
+        EXPECT_TRUE(moved.IsInline());
+        EXPECT_EQ(values(moved), (std::vector<int>{1}));
+
+        moved = stolen;
+        EXPECT_EQ(values(moved), (std::vector<int>{0, 1, 2, 3}));
+        moved = {Tracked(7), Tracked(8)};
+        EXPECT_EQ(moved.size(), 2u);
+    }
+    EXPECT_EQ(Tracked::live, 0);
+}
+
+TEST(SmallVectorTest, ResizeValueInitializesAndTruncates) {
+    SmallVector<int, 2> vec;
+    vec.resize(3);
+    EXPECT_EQ(vec.size(), 3u);
+    EXPECT_TRUE(std::all_of(vec.begin(), vec.end(), [](int v) { return v == 0; }));
+
+    vec.resize(5, 7);
+    EXPECT_EQ(vec[4], 7);
+    vec.resize(1);
+    EXPECT_EQ(vec.size(), 1u);
+
+    vec.clear();
+    EXPECT_TRUE(vec.empty());
+    EXPECT_GE(vec.capacity(), 5u);  // clear keeps the block
+}
+
+TEST(SmallVectorTest, WorksWithStandardAlgorithms) {
+    SmallVector<int, 4> vec{5, 1, 4, 2, 3};
+    std::sort(vec.begin(), vec.end());
+    EXPECT_TRUE(std::is_sorted(vec.begin(), vec.end()));
+    EXPECT_EQ(erase(vec, 4), 1u);
+    EXPECT_EQ(vec.size(), 4u);
+    EXPECT_EQ(std::find(vec.begin(), vec.end(), 4), vec.end());
+}
+
+TEST(SmallVectorTest, SurvivesComponentStorageSwapRemove) {
+    struct Holder {
+        SmallVector<std::string, 2> names;
+    };
+    static_assert(std::is_nothrow_move_constructible_v<Holder>);
+
+    ComponentStorage<Holder> storage;
+    for (uint32_t i = 0; i < 8; ++i) {
+        auto& holder = storage.Add(Entity(i, 0));
+        for (uint32_t n = 0; n <= i % 4; ++n) {
+            holder.names.push_back("entity " + std::to_string(i));
+        }
+    }
+
+    storage.Remove(Entity(0, 0));
+    storage.Remove(Entity(3, 0));
+
+    for (uint32_t i : {1u, 2u, 4u, 5u, 6u, 7u}) {
+        const auto& holder = storage.Get(Entity(i, 0));
+        ASSERT_EQ(holder.names.size(), i % 4 + 1);
+        for (const auto& name : holder.names) {
+            EXPECT_EQ(name, "entity " + std::to_string(i));
+        }
+    }
+}
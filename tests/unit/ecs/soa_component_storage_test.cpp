@@ -0,0 +1,215 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "cgs/ecs/query.hpp"
+#include "cgs/ecs/soa_component_storage.hpp"
+
+using namespace cgs::ecs;
+
+// ── Test component types ────────────────────────────────────────────────────
+
+struct Particle {
+    float x = 0.0f;
+    float vx = 0.0f;
+    int32_t ttl = 0;
+    std::string tag;
+    int32_t unregistered = 0;  // Not part of the SoA layout.
+};
+
+CGS_SERIALIZABLE(Particle, 1,
+                 field("x", &Particle::x),
+                 field("vx", &Particle::vx),
+                 field("ttl", &Particle::ttl),
+                 field("tag", &Particle::tag));
+
+struct Weight {
+    float value = 1.0f;
+};
+
+struct Frozen {};
+
+// ===========================================================================
+// SoAComponentStorage: CRUD
+// ===========================================================================
+
+TEST(SoAComponentStorageTest, OneColumnPerRegisteredField) {
+    EXPECT_EQ(SoAComponentStorage<Particle>::FieldCount(), 4u);
+}
+
+TEST(SoAComponentStorageTest, AddScattersIntoColumns) {
+    SoAComponentStorage<Particle> storage;
+    storage.Add(Entity(0, 0), Particle{1.0f, 2.0f, 3, "a"});
+    storage.Add(Entity(5, 0), Particle{4.0f, 5.0f, 6, "b"});
+
+    auto xs = storage.Column<&Particle::x>();
+    auto tags = storage.Column<&Particle::tag>();
+    ASSERT_EQ(xs.size(), 2u);
+    EXPECT_FLOAT_EQ(xs[0], 1.0f);
+    EXPECT_FLOAT_EQ(xs[1], 4.0f);
+    EXPECT_EQ(tags[1], "b");
+}
+
+TEST(SoAComponentStorageTest, LoadMaterializesRegisteredFields) {
+    SoAComponentStorage<Particle> storage;
+    Entity e(2, 0);
+    storage.Add(e, Particle{1.0f, 2.0f, 3, "tag", 99});
+
+    Particle p = storage.Load(e);
+
+    EXPECT_FLOAT_EQ(p.x, 1.0f);
+    EXPECT_FLOAT_EQ(p.vx, 2.0f);
+    EXPECT_EQ(p.ttl, 3);
+    EXPECT_EQ(p.tag, "tag");
+    EXPECT_EQ(p.unregistered, 0);  // Unregistered members are not stored.
+}
+
+TEST(SoAComponentStorageTest, RefAccessByMemberPointer) {
+    SoAComponentStorage<Particle> storage;
+    Entity e(1, 0);
+    storage.Add(e, Particle{1.0f, 0.5f, 0, ""});
+
+    auto ref = storage.Get(e);
+    ref[&Particle::x] += ref[&Particle::vx];
+    ref.Get<&Particle::ttl>() = 7;
+
+    EXPECT_FLOAT_EQ(storage.Load(e).x, 1.5f);
+    EXPECT_EQ(storage.Load(e).ttl, 7);
+}
+
+TEST(SoAComponentStorageTest, RefStoreOverwritesRow) {
+    SoAComponentStorage<Particle> storage;
+    Entity e(1, 0);
+    storage.Add(e);
+
+    storage.Get(e).Store(Particle{9.0f, 8.0f, 7, "z"});
+
+    EXPECT_EQ(storage.Load(e).tag, "z");
+    EXPECT_FLOAT_EQ(storage.Load(e).vx, 8.0f);
+}
+
+TEST(SoAComponentStorageTest, RemoveSwapsWithLastAcrossColumns) {
+    SoAComponentStorage<Particle> storage;
+    Entity a(0, 0);
+    Entity b(1, 0);
+    Entity c(2, 0);
+    storage.Add(a, Particle{1.0f, 0.0f, 1, "a"});
+    storage.Add(b, Particle{2.0f, 0.0f, 2, "b"});
+    storage.Add(c, Particle{3.0f, 0.0f, 3, "c"});
+
+    storage.Remove(a);
+
+    EXPECT_FALSE(storage.Has(a));
+    EXPECT_EQ(storage.Size(), 2u);
+    EXPECT_EQ(storage.EntityAt(0), c.id());
+    EXPECT_EQ(storage.Load(c).tag, "c");
+    EXPECT_EQ(storage.Load(c).ttl, 3);
+    EXPECT_EQ(storage.Load(b).tag, "b");
+}
+
+TEST(SoAComponentStorageTest, ClearRemovesAll) {
+    SoAComponentStorage<Particle> storage;
+    storage.Add(Entity(0, 0));
+    storage.Add(Entity(1, 0));
+
+    storage.Clear();
+
+    EXPECT_TRUE(storage.Empty());
+    EXPECT_FALSE(storage.Has(Entity(0, 0)));
+    EXPECT_TRUE(storage.Column<&Particle::x>().empty());
+}
+
+// ===========================================================================
+// SoAComponentStorage: Version tracking
+// ===========================================================================
+
+TEST(SoAComponentStorageTest, ReplaceAndMarkChangedBumpVersion) {
+    SoAComponentStorage<Particle> storage;
+    Entity e(0, 0);
+    storage.Add(e);
+    const auto v0 = storage.GetVersion(e);
+
+    storage.Replace(e, Particle{1.0f, 0.0f, 0, ""});
+    const auto v1 = storage.GetVersion(e);
+    EXPECT_GT(v1, v0);
+
+    storage.MarkChanged(e);
+    EXPECT_TRUE(storage.HasChanged(e, v1));
+}
+
+TEST(SoAComponentStorageTest, MarkAllChangedAfterColumnWrites) {
+    SoAComponentStorage<Particle> storage;
+    storage.Add(Entity(0, 0));
+    storage.Add(Entity(1, 0));
+    const auto before = storage.GlobalVersion();
+
+    for (auto& x : storage.Column<&Particle::x>()) {
+        x += 1.0f;
+    }
+    storage.MarkAllChanged();
+
+    EXPECT_TRUE(storage.HasChanged(Entity(0, 0), before));
+    EXPECT_TRUE(storage.HasChanged(Entity(1, 0), before));
+}
+
+// ===========================================================================
+// Query<SoA<T>> integration
+// ===========================================================================
+
+TEST(SoAQueryTest, ForEachYieldsProxies) {
+    SoAComponentStorage<Particle> particles;
+    for (uint32_t i = 0; i < 10; ++i) {
+        particles.Add(Entity(i, 0), Particle{0.0f, static_cast<float>(i), 0, ""});
+    }
+
+    Query<SoA<Particle>> query(particles);
+    query.ForEach([](Entity, SoAComponentStorage<Particle>::Ref p) {
+        p[&Particle::x] += p[&Particle::vx];
+    });
+
+    EXPECT_EQ(query.Count(), 10u);
+    EXPECT_FLOAT_EQ(particles.Load(Entity(9, 0)).x, 9.0f);
+}
+
+TEST(SoAQueryTest, MixesWithSparseSetIncludesAndExcludes) {
+    SoAComponentStorage<Particle> particles;
+    ComponentStorage<Weight> weights;
+    ComponentStorage<Frozen> frozen;
+    for (uint32_t i = 0; i < 6; ++i) {
+        particles.Add(Entity(i, 0), Particle{1.0f, 0.0f, 0, ""});
+    }
+    weights.Add(Entity(1, 0), Weight{2.0f});
+    weights.Add(Entity(3, 0), Weight{3.0f});
+    weights.Add(Entity(4, 0), Weight{4.0f});
+    frozen.Add(Entity(4, 0));
+
+    Query<SoA<Particle>, Weight> query(particles, weights);
+    query.Exclude(frozen);
+
+    std::unordered_set<uint32_t> seen;
+    query.ForEach([&](Entity e, auto p, Weight& w) {
+        p[&Particle::x] *= w.value;
+        seen.insert(e.id());
+    });
+
+    EXPECT_EQ(seen, (std::unordered_set<uint32_t>{1, 3}));
+    EXPECT_FLOAT_EQ(particles.Load(Entity(3, 0)).x, 3.0f);
+    EXPECT_FLOAT_EQ(particles.Load(Entity(4, 0)).x, 1.0f);
+}
+
+TEST(SoAQueryTest, CacheInvalidatedBySoAStorageChange) {
+    SoAComponentStorage<Particle> particles;
+    particles.Add(Entity(0, 0));
+
+    Query<SoA<Particle>> query(particles);
+    EXPECT_EQ(query.Count(), 1u);
+
+    particles.Add(Entity(1, 0));
+    EXPECT_EQ(query.Count(), 2u);
+
+    particles.Remove(Entity(0, 0));
+    EXPECT_EQ(query.Count(), 1u);
+}
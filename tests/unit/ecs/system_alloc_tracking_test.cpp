@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "cgs/ecs/system_profiler.hpp"
+#include "cgs/ecs/system_scheduler.hpp"
+#include "cgs/foundation/alloc_tracker.hpp"
+
+using namespace cgs::ecs;
+using cgs::foundation::AllocTag;
+using cgs::foundation::AllocTracker;
+
+// Linked with cgs::foundation_alloc_hooks, so every operator new counts.
+
+// ── Test components and systems ─────────────────────────────────────────────
+
+struct AllocPosition {
+    float x = 0.0f;
+};
+struct AllocVelocity {
+    float dx = 0.0f;
+};
+
+/// Allocates kBlocks blocks every run, as a system building a fresh
+/// container each tick would.
+class AllocatingSystem : public ISystem {
+public:
+    static constexpr std::size_t kBlocks = 4;
+    static constexpr std::size_t kBlockBytes = 48;
+
+    void Execute(float) override {
+        for (std::size_t i = 0; i < kBlocks; ++i) {
+            ::operator delete(::operator new(kBlockBytes));
+        }
+    }
+
+    [[nodiscard]] std::string_view GetName() const override { return "AllocatingSystem"; }
+
+    [[nodiscard]] SystemAccessInfo GetAccessInfo() const override {
+        SystemAccessInfo info;
+        Write<AllocPosition>::Apply(info);
+        return info;
+    }
+};
+
+/// Reuses a buffer grown on its first run.
+class SteadySystem : public ISystem {
+public:
+    void Execute(float) override {
+        scratch_.clear();
+        for (int i = 0; i < 32; ++i) {
+            scratch_.push_back(i);
+        }
+    }
+
+    [[nodiscard]] std::string_view GetName() const override { return "SteadySystem"; }
+
+    [[nodiscard]] SystemAccessInfo GetAccessInfo() const override {
+        SystemAccessInfo info;
+        Write<AllocVelocity>::Apply(info);
+        return info;
+    }
+
+private:
+    std::vector<int> scratch_;
+};
+
+namespace {
+
+std::atomic<int> gViolations{0};
+std::atomic<AllocTag> gViolatingTag{0};
+
+void countViolation(AllocTag tag, std::size_t) {
+    gViolations.fetch_add(1);
+    gViolatingTag.store(tag);
+}
+
+}  // namespace
+
+class SystemAllocTrackingTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        scheduler.Register<AllocatingSystem>();
+        scheduler.Register<SteadySystem>();
+        scheduler.SetProfiler(&profiler);
+        ASSERT_TRUE(scheduler.Build());
+        scheduler.Execute(0.016f);  // Warm-up: grows SteadySystem's buffer.
+    }
+
+    SystemScheduler scheduler;
+    SystemProfiler profiler;
+};
+
+// ── Attribution ─────────────────────────────────────────────────────────────
+
+TEST_F(SystemAllocTrackingTest, ChargesAllocationsToTheRunningSystem) {
+    const AllocTag allocating = AllocTracker::Register("system.AllocatingSystem");
+    const AllocTag steady = AllocTracker::Register("system.SteadySystem");
+    const auto allocatingBefore = AllocTracker::Counts(allocating);
+    const auto steadyBefore = AllocTracker::Counts(steady);
+
+    for (int tick = 0; tick < 5; ++tick) {
+        scheduler.Execute(0.016f);
+    }
+
+    const auto allocatingAfter = AllocTracker::Counts(allocating);
+    EXPECT_EQ(allocatingAfter.allocations - allocatingBefore.allocations,
+              5 * AllocatingSystem::kBlocks);
+    EXPECT_EQ(allocatingAfter.bytes - allocatingBefore.bytes,
+              5 * AllocatingSystem::kBlocks * AllocatingSystem::kBlockBytes);
+    EXPECT_EQ(AllocTracker::Counts(steady).allocations, steadyBefore.allocations);
+}
+
+TEST_F(SystemAllocTrackingTest, ProfilerEventsCarryAllocations) {
+    scheduler.Execute(0.016f);
+
+    const auto allocatingId = SystemType<AllocatingSystem>::Id();
+    const auto steadyId = SystemType<SteadySystem>::Id();
+    std::size_t seen = 0;
+    for (const auto& event : profiler.Events(1)) {
+        if (event.scope != ProfileScope::System) {
+            continue;
+        }
+        ++seen;
+        if (event.id == allocatingId) {
+            EXPECT_EQ(event.allocations, AllocatingSystem::kBlocks);
+            EXPECT_EQ(event.allocatedBytes,
+                      AllocatingSystem::kBlocks * AllocatingSystem::kBlockBytes);
+        } else if (event.id == steadyId) {
+            EXPECT_EQ(event.allocations, 0u);
+        }
+    }
+    EXPECT_EQ(seen, 2u);
+
+    const auto stats = profiler.SystemStats(1);
+    ASSERT_EQ(stats.size(), 2u);
+    for (const auto& entry : stats) {
+        const uint64_t expected = entry.system == allocatingId ? AllocatingSystem::kBlocks : 0;
+        EXPECT_EQ(entry.allocations, expected) << entry.name;
+        EXPECT_EQ(entry.maxAllocations, expected) << entry.name;
+    }
+}
+
+TEST_F(SystemAllocTrackingTest, ChromeTraceIncludesAllocations) {
+    scheduler.Execute(0.016f);
+    const std::string json = profiler.ChromeTraceJson(1);
+    EXPECT_NE(json.find("\"allocs\":" + std::to_string(AllocatingSystem::kBlocks)),
+              std::string::npos);
+    EXPECT_NE(json.find("\"allocBytes\":"), std::string::npos);
+}
+
+// ── Steady-state assertions ─────────────────────────────────────────────────
+
+TEST_F(SystemAllocTrackingTest, StrictModeFlagsTheAllocatingSystem) {
+    gViolations = 0;
+    AllocTracker::SetStrictHandler(&countViolation);
+    scheduler.Execute(0.016f);
+    AllocTracker::SetStrictHandler(nullptr);
+
+    EXPECT_EQ(gViolations.load(), static_cast<int>(AllocatingSystem::kBlocks));
+    EXPECT_EQ(AllocTracker::Name(gViolatingTag.load()), "system.AllocatingSystem");
+}
+
+TEST(SystemAllocTrackingSteadyTest, SteadyTickAllocatesNothing) {
+    SystemScheduler scheduler;
+    scheduler.Register<SteadySystem>();
+    ASSERT_TRUE(scheduler.Build());
+    scheduler.Execute(0.016f);
+
+    gViolations = 0;
+    AllocTracker::SetStrictHandler(&countViolation);
+    for (int tick = 0; tick < 10; ++tick) {
+        scheduler.Execute(0.016f);
+    }
+    AllocTracker::SetStrictHandler(nullptr);
+    EXPECT_EQ(gViolations.load(), 0);
+}
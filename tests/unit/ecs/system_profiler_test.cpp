@@ -0,0 +1,229 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "cgs/ecs/system_profiler.hpp"
+#include "cgs/ecs/system_scheduler.hpp"
+#include "cgs/ecs/work_stealing_executor.hpp"
+
+using namespace cgs::ecs;
+
+// ── Test components and systems ─────────────────────────────────────────────
+
+struct ProfPosition {
+    float x = 0.0f;
+};
+struct ProfVelocity {
+    float dx = 0.0f;
+};
+
+/// System that sleeps for a configurable time and reads one component.
+template <typename Tag, typename Component>
+class TimedSystem : public ISystem {
+public:
+    explicit TimedSystem(std::string name, std::chrono::microseconds work = {})
+        : name_(std::move(name)), work_(work) {}
+
+    void Execute(float) override {
+        if (work_.count() > 0) {
+            std::this_thread::sleep_for(work_);
+        }
+    }
+
+    [[nodiscard]] std::string_view GetName() const override { return name_; }
+
+    [[nodiscard]] SystemAccessInfo GetAccessInfo() const override {
+        SystemAccessInfo info;
+        Read<Component>::Apply(info);
+        return info;
+    }
+
+private:
+    std::string name_;
+    std::chrono::microseconds work_;
+};
+
+struct FastTag {};
+struct SlowTag {};
+
+using FastSystem = TimedSystem<FastTag, ProfPosition>;
+using SlowSystem = TimedSystem<SlowTag, ProfVelocity>;
+
+static std::size_t countScope(const std::vector<ProfileEvent>& events, ProfileScope scope) {
+    return static_cast<std::size_t>(std::count_if(
+        events.begin(), events.end(), [scope](const ProfileEvent& e) { return e.scope == scope; }));
+}
+
+// ── SystemProfiler ──────────────────────────────────────────────────────────
+
+TEST(SystemProfilerTest, RecordsEventsOfRecentTicksOnly) {
+    SystemProfiler profiler;
+    for (uint32_t tick = 1; tick <= 3; ++tick) {
+        profiler.BeginTick();
+        profiler.Record(ProfileScope::System, tick, 10 * tick, 10 * tick + 5);
+    }
+
+    const auto last = profiler.Events(2);
+    ASSERT_EQ(last.size(), 2u);
+    EXPECT_EQ(last[0].tick, 2u);
+    EXPECT_EQ(last[1].tick, 3u);
+    EXPECT_EQ(last[1].id, 3u);
+    EXPECT_EQ(profiler.Events(10).size(), 3u);
+    EXPECT_TRUE(profiler.Events(0).empty());
+}
+
+TEST(SystemProfilerTest, RingOverwritesOldestEvents) {
+    SystemProfiler profiler(4);
+    profiler.BeginTick();
+    for (int64_t i = 0; i < 10; ++i) {
+        profiler.Record(ProfileScope::System, static_cast<uint32_t>(i), i, i + 1);
+    }
+
+    const auto events = profiler.Events(1);
+    ASSERT_EQ(events.size(), 4u);
+    EXPECT_EQ(events.front().id, 6u);
+    EXPECT_EQ(events.back().id, 9u);
+}
+
+TEST(SystemProfilerTest, EachThreadRecordsIntoItsOwnRing) {
+    SystemProfiler profiler;
+    profiler.BeginTick();
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&profiler, t] {
+            for (int64_t i = 0; i < 100; ++i) {
+                profiler.Record(ProfileScope::System, t, i, i + 1);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const auto events = profiler.Events(1);
+    ASSERT_EQ(events.size(), 400u);
+    std::set<uint32_t> threadIds;
+    for (const auto& event : events) {
+        threadIds.insert(event.thread);
+    }
+    EXPECT_EQ(threadIds.size(), 4u);
+}
+
+TEST(SystemProfilerTest, StatsComputePercentilesPerSystem) {
+    SystemProfiler profiler;
+    profiler.SetSystemName(7, "Movement");
+    for (int64_t i = 1; i <= 100; ++i) {
+        profiler.BeginTick();
+        // 1 ms .. 100 ms
+        profiler.Record(ProfileScope::System, 7, 0, i * 1'000'000);
+    }
+
+    const auto stats = profiler.SystemStats(100);
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_EQ(stats[0].system, 7u);
+    EXPECT_EQ(stats[0].name, "Movement");
+    EXPECT_EQ(stats[0].samples, 100u);
+    EXPECT_DOUBLE_EQ(stats[0].p50Ms, 50.0);
+    EXPECT_DOUBLE_EQ(stats[0].p99Ms, 99.0);
+    EXPECT_DOUBLE_EQ(stats[0].maxMs, 100.0);
+}
+
+TEST(SystemProfilerTest, ChromeTraceContainsCompleteEvents) {
+    SystemProfiler profiler;
+    profiler.SetSystemName(3, "Quote\"System");
+    profiler.BeginTick();
+    profiler.Record(ProfileScope::System, 3, 1'500, 4'000);
+
+    const auto json = profiler.ChromeTraceJson(1);
+    EXPECT_EQ(json.rfind("{\"traceEvents\":[", 0), 0u);
+    EXPECT_NE(json.find("\"name\":\"Quote\\\"System\""), std::string::npos);
+    EXPECT_NE(json.find("\"ph\":\"X\",\"ts\":1.500,\"dur\":2.500"), std::string::npos);
+    EXPECT_NE(json.find("\"thread_name\""), std::string::npos);
+    EXPECT_NE(json.find("\"displayTimeUnit\":\"ms\"}"), std::string::npos);
+}
+
+// ── SystemScheduler integration ─────────────────────────────────────────────
+
+TEST(SystemProfilerTest, SchedulerRecordsTickStageAndSystems) {
+    SystemScheduler scheduler;
+    scheduler.Register<FastSystem>("FastSystem");
+    scheduler.Register<SlowSystem>("SlowSystem", std::chrono::microseconds(2000));
+
+    SystemProfiler profiler;
+    scheduler.SetProfiler(&profiler);
+    ASSERT_TRUE(scheduler.Build());
+
+    for (int i = 0; i < 3; ++i) {
+        scheduler.Execute(0.016f);
+    }
+
+    const auto events = profiler.Events(1);
+    EXPECT_EQ(countScope(events, ProfileScope::Tick), 1u);
+    EXPECT_EQ(countScope(events, ProfileScope::Stage), 3u);  // Pre/Update/Post
+    EXPECT_EQ(countScope(events, ProfileScope::System), 2u);
+
+    // Systems nest inside their tick.
+    const auto tick = std::find_if(events.begin(), events.end(), [](const ProfileEvent& e) {
+        return e.scope == ProfileScope::Tick;
+    });
+    ASSERT_NE(tick, events.end());
+    for (const auto& event : events) {
+        EXPECT_GE(event.startNs, tick->startNs);
+        EXPECT_LE(event.endNs, tick->endNs);
+    }
+
+    const auto stats = profiler.SystemStats(3);
+    ASSERT_EQ(stats.size(), 2u);
+    EXPECT_EQ(stats[0].name, "SlowSystem");
+    EXPECT_EQ(stats[0].samples, 3u);
+    EXPECT_GE(stats[0].p50Ms, 2.0);
+}
+
+TEST(SystemProfilerTest, SchedulerRecordsBatchesOnWorkerThreads) {
+    SystemScheduler scheduler;
+    scheduler.Register<FastSystem>("FastSystem", std::chrono::microseconds(500));
+    scheduler.Register<SlowSystem>("SlowSystem", std::chrono::microseconds(500));
+
+    WorkStealingExecutor executor(2);
+    scheduler.EnableParallelExecution(executor);
+    SystemProfiler profiler;
+    scheduler.SetProfiler(&profiler);
+    ASSERT_TRUE(scheduler.Build());
+    ASSERT_EQ(scheduler.GetParallelBatches(SystemStage::Update).size(), 1u);
+
+    scheduler.Execute(0.016f);
+
+    const auto events = profiler.Events(1);
+    EXPECT_EQ(countScope(events, ProfileScope::Batch), 1u);
+    EXPECT_EQ(countScope(events, ProfileScope::System), 2u);
+    const auto json = profiler.ChromeTraceJson(1);
+    EXPECT_NE(json.find("\"name\":\"FastSystem\""), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"Batch 0\""), std::string::npos);
+}
+
+TEST(SystemProfilerTest, DisabledProfilerRecordsNothing) {
+    SystemScheduler scheduler;
+    scheduler.Register<FastSystem>("FastSystem");
+
+    SystemProfiler profiler;
+    profiler.SetEnabled(false);
+    scheduler.SetProfiler(&profiler);
+    ASSERT_TRUE(scheduler.Build());
+
+    scheduler.Execute(0.016f);
+    EXPECT_EQ(profiler.CurrentTick(), 0u);
+    EXPECT_TRUE(profiler.Events(1).empty());
+
+    profiler.SetEnabled(true);
+    scheduler.Execute(0.016f);
+    EXPECT_EQ(profiler.CurrentTick(), 1u);
+    EXPECT_EQ(countScope(profiler.Events(1), ProfileScope::System), 1u);
+}
@@ -4,8 +4,10 @@
 #include <cmath>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
+#include "cgs/ecs/component_storage.hpp"
 #include "cgs/ecs/system_scheduler.hpp"
 
 using namespace cgs::ecs;
@@ -617,3 +619,217 @@ TEST(SystemSchedulerTest, DeltaTimePassedCorrectly) {
     ASSERT_EQ(sys.CallCount(), 1u);
     EXPECT_FLOAT_EQ(sys.Calls()[0], 0.042f);
 }
+
+// ===========================================================================
+// SystemScheduler: Update rates
+// ===========================================================================
+
+TEST(SystemSchedulerTest, DecimatedSystemReceivesAccumulatedDelta) {
+    SystemScheduler scheduler;
+    auto& every = scheduler.Register<UpdateSystemA>();
+    auto& decimated = scheduler.Register<UpdateSystemB>();
+    scheduler.SetUpdateInterval<UpdateSystemB>(4);
+    ASSERT_TRUE(scheduler.Build());
+    EXPECT_EQ(scheduler.GetUpdateInterval(SystemType<UpdateSystemB>::Id()), 4u);
+
+    for (int i = 0; i < 12; ++i) {
+        scheduler.Execute(0.25f);
+    }
+
+    EXPECT_EQ(every.CallCount(), 12u);
+    ASSERT_EQ(decimated.CallCount(), 3u);
+    const uint32_t phase = scheduler.GetUpdatePhase(SystemType<UpdateSystemB>::Id());
+    // The first run carries the ticks up to its phase, later runs a full interval.
+    EXPECT_FLOAT_EQ(decimated.Calls()[0], 0.25f * static_cast<float>(phase + 1));
+    EXPECT_FLOAT_EQ(decimated.Calls()[1], 1.0f);
+    EXPECT_FLOAT_EQ(decimated.Calls()[2], 1.0f);
+}
+
+TEST(SystemSchedulerTest, DecimatedSystemsAreSpreadAcrossTicks) {
+    SystemScheduler scheduler;
+    scheduler.Register<UpdateSystemA>();
+    scheduler.Register<UpdateSystemB>();
+    scheduler.Register<UpdateSystemC>();
+    scheduler.SetUpdateInterval<UpdateSystemA>(2);
+    scheduler.SetUpdateInterval<UpdateSystemB>(4);
+    scheduler.SetUpdateInterval<UpdateSystemC>(4);
+    ASSERT_TRUE(scheduler.Build());
+
+    // A takes one parity; B and C share the other on alternate ticks.
+    const uint32_t a = scheduler.GetUpdatePhase(SystemType<UpdateSystemA>::Id());
+    const uint32_t b = scheduler.GetUpdatePhase(SystemType<UpdateSystemB>::Id());
+    const uint32_t c = scheduler.GetUpdatePhase(SystemType<UpdateSystemC>::Id());
+    EXPECT_NE(b % 2, a);
+    EXPECT_NE(c % 2, a);
+    EXPECT_NE(b, c);
+
+    for (int tick = 0; tick < 8; ++tick) {
+        RecordingSystem::clearLog();
+        scheduler.Execute(1.0f / 60.0f);
+        EXPECT_EQ(RecordingSystem::executionLog().size(), 1u) << "tick " << tick;
+    }
+}
+
+/// Records the slice and delta of every run.
+class SlicedSystem : public ISystem {
+public:
+    void Execute(float deltaTime) override {
+        slices.push_back(CurrentSlice());
+        deltas.push_back(deltaTime);
+    }
+    [[nodiscard]] std::string_view GetName() const override { return "SlicedSystem"; }
+
+    std::vector<UpdateSlice> slices;
+    std::vector<float> deltas;
+};
+
+TEST(SystemSchedulerTest, SlicedSystemRotatesSlicesEveryTick) {
+    SystemScheduler scheduler;
+    auto& sys = scheduler.Register<SlicedSystem>();
+    scheduler.SetUpdateSlices(SystemType<SlicedSystem>::Id(), 3);
+    ASSERT_TRUE(scheduler.Build());
+
+    for (int i = 0; i < 6; ++i) {
+        scheduler.Execute(0.5f);
+    }
+
+    ASSERT_EQ(sys.slices.size(), 6u);
+    for (uint32_t i = 0; i < 6; ++i) {
+        EXPECT_EQ(sys.slices[i].index, i % 3);
+        EXPECT_EQ(sys.slices[i].count, 3u);
+    }
+    // Each slice sees the time since it last ran: 1, 2, 3 ticks at first.
+    EXPECT_FLOAT_EQ(sys.deltas[0], 0.5f);
+    EXPECT_FLOAT_EQ(sys.deltas[2], 1.5f);
+    EXPECT_FLOAT_EQ(sys.deltas[5], 1.5f);
+
+    // Slices partition ids and dense rows.
+    const UpdateSlice middle{1, 3};
+    EXPECT_TRUE(middle.Contains(4));
+    EXPECT_FALSE(middle.Contains(5));
+    EXPECT_EQ(middle.Range(10), (std::pair<std::size_t, std::size_t>{3, 6}));
+    EXPECT_EQ((UpdateSlice{2, 3}.Range(10).second), 10u);
+}
+
+TEST(SystemSchedulerTest, DisabledDecimatedSystemDoesNotAccumulate) {
+    SystemScheduler scheduler;
+    auto& sys = scheduler.Register<UpdateSystemA>();
+    scheduler.SetUpdateInterval<UpdateSystemA>(2);
+    ASSERT_TRUE(scheduler.Build());
+    const uint32_t phase = scheduler.GetUpdatePhase(SystemType<UpdateSystemA>::Id());
+
+    scheduler.SetEnabled<UpdateSystemA>(false);
+    for (int i = 0; i < 4; ++i) {
+        scheduler.Execute(1.0f);
+    }
+    EXPECT_EQ(sys.CallCount(), 0u);
+
+    scheduler.SetEnabled<UpdateSystemA>(true);
+    scheduler.Execute(1.0f);
+    scheduler.Execute(1.0f);
+    ASSERT_EQ(sys.CallCount(), 1u);
+    EXPECT_FLOAT_EQ(sys.Calls()[0], phase == 0 ? 1.0f : 2.0f);
+}
+
+// ===========================================================================
+// SystemScheduler: Last-run change version
+// ===========================================================================
+
+/// Records LastRunVersion() on every run and stamps one change.
+class VersionProbeSystem : public ISystem {
+public:
+    void Execute(float) override {
+        seen.push_back(LastRunVersion());
+        (void)NextChangeVersion();
+    }
+    [[nodiscard]] std::string_view GetName() const override { return "VersionProbeSystem"; }
+
+    std::vector<uint32_t> seen;
+};
+
+TEST(SystemSchedulerTest, LastRunVersionTracksPreviousStart) {
+    SystemScheduler scheduler;
+    auto& sys = scheduler.Register<VersionProbeSystem>();
+    ASSERT_TRUE(scheduler.Build());
+
+    const uint32_t beforeFirst = CurrentChangeVersion();
+    scheduler.Execute(1.0f / 60.0f);
+    const uint32_t beforeSecond = CurrentChangeVersion();
+    scheduler.Execute(1.0f / 60.0f);
+
+    ASSERT_EQ(sys.seen.size(), 2u);
+    EXPECT_EQ(sys.seen[0], kAnyVersion);
+    EXPECT_EQ(sys.seen[1], beforeFirst);
+    EXPECT_EQ(sys.LastRunVersion(), beforeSecond);
+}
+
+TEST(SystemSchedulerTest, DirectExecuteDoesNotAdvanceLastRunVersion) {
+    VersionProbeSystem sys;
+    sys.Execute(0.0f);
+    sys.Execute(0.0f);
+
+    EXPECT_EQ(sys.LastRunVersion(), kAnyVersion);
+}
+
+struct SliceCounter {
+    int value = 0;
+};
+
+/// Sliced system recording the entities of its slice changed since the
+/// slice last ran.
+class SlicedChangeSystem : public ISystem {
+public:
+    explicit SlicedChangeSystem(ComponentStorage<SliceCounter>& counters) : counters_(counters) {}
+
+    void Execute(float) override {
+        std::vector<uint32_t> changed;
+        for (std::size_t i = 0; i < counters_.Size(); ++i) {
+            const Entity entity(counters_.EntityAt(i), 0);
+            if (CurrentSlice().Contains(entity.id()) &&
+                counters_.HasChanged(entity, LastRunVersion())) {
+                changed.push_back(entity.id());
+            }
+        }
+        runs.push_back(std::move(changed));
+    }
+    [[nodiscard]] std::string_view GetName() const override { return "SlicedChangeSystem"; }
+
+    std::vector<std::vector<uint32_t>> runs;
+
+private:
+    ComponentStorage<SliceCounter>& counters_;
+};
+
+TEST(SystemSchedulerTest, SlicedSystemSeesChangesSinceItsSliceLastRan) {
+    ComponentStorage<SliceCounter> counters;
+    counters.Add(Entity(0, 0));
+    counters.Add(Entity(1, 0));
+
+    SystemScheduler scheduler;
+    auto& sys = scheduler.Register<SlicedChangeSystem>(counters);
+    scheduler.SetUpdateSlices(SystemType<SlicedChangeSystem>::Id(), 2);
+    ASSERT_TRUE(scheduler.Build());
+
+    scheduler.Execute(1.0f);  // even slice: sees entity 0 as added
+    scheduler.Execute(1.0f);  // odd slice: sees entity 1 as added
+
+    // Change the odd entity while the even slice is due: the even run
+    // must not hide it from the odd slice.
+    counters.MarkChanged(Entity(1, 0));
+    scheduler.Execute(1.0f);
+    scheduler.Execute(1.0f);
+
+    ASSERT_EQ(sys.runs.size(), 4u);
+    EXPECT_EQ(sys.runs[0], (std::vector<uint32_t>{0}));
+    EXPECT_EQ(sys.runs[1], (std::vector<uint32_t>{1}));
+    EXPECT_TRUE(sys.runs[2].empty());
+    EXPECT_EQ(sys.runs[3], (std::vector<uint32_t>{1}));
+}
+
+TEST(ChangeVersionTest, NewerComparisonSurvivesWrap) {
+    EXPECT_TRUE(IsNewerVersion(2u, 1u));
+    EXPECT_FALSE(IsNewerVersion(1u, 1u));
+    EXPECT_FALSE(IsNewerVersion(1u, 2u));
+    EXPECT_TRUE(IsNewerVersion(5u, 0xFFFFFFF0u));  // Clock wrapped.
+    EXPECT_TRUE(IsNewerVersion(1u, kAnyVersion));
+}
@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cgs/foundation/alloc_tracker.hpp"
+
+using namespace cgs::foundation;
+
+// Linked with cgs::foundation_alloc_hooks, so every operator new counts.
+
+namespace {
+
+/// Allocate and free @p count blocks of @p bytes.  Direct operator new
+/// calls, unlike new-expressions, may not be elided.
+void allocateBlocks(std::size_t count, std::size_t bytes) {
+    for (std::size_t i = 0; i < count; ++i) {
+        ::operator delete(::operator new(bytes));
+    }
+}
+
+}  // namespace
+
+TEST(AllocTrackerTest, HooksAreInstalled) {
+    EXPECT_TRUE(AllocTracker::Installed());
+}
+
+TEST(AllocTrackerTest, RegisterReturnsStableTags) {
+    const AllocTag a = AllocTracker::Register("test.register_a");
+    const AllocTag b = AllocTracker::Register("test.register_b");
+    EXPECT_NE(a, AllocTracker::kUntagged);
+    EXPECT_NE(a, b);
+    EXPECT_EQ(AllocTracker::Register("test.register_a"), a);
+    EXPECT_EQ(AllocTracker::Name(a), "test.register_a");
+    EXPECT_EQ(AllocTracker::Name(AllocTracker::kUntagged), "untagged");
+    EXPECT_GT(AllocTracker::TagCount(), static_cast<std::size_t>(b));
+}
+
+TEST(AllocTrackerTest, ChargesAllocationsToTheCurrentTag) {
+    const AllocTag tag = AllocTracker::Register("test.charged");
+    const AllocCounts before = AllocTracker::Counts(tag);
+    {
+        AllocTagScope scope(tag);
+        EXPECT_EQ(AllocTracker::Current(), tag);
+        allocateBlocks(3, 100);
+    }
+    EXPECT_EQ(AllocTracker::Current(), AllocTracker::kUntagged);
+    allocateBlocks(2, 100);  // Untagged.
+
+    const AllocCounts after = AllocTracker::Counts(tag);
+    EXPECT_EQ(after.allocations - before.allocations, 3u);
+    EXPECT_EQ(after.bytes - before.bytes, 300u);
+}
+
+TEST(AllocTrackerTest, ScopesNest) {
+    const AllocTag outer = AllocTracker::Register("test.outer");
+    const AllocTag inner = AllocTracker::Register("test.inner");
+    const AllocCounts outerBefore = AllocTracker::Counts(outer);
+    const AllocCounts innerBefore = AllocTracker::Counts(inner);
+    {
+        AllocTagScope outerScope(outer);
+        allocateBlocks(1, 8);
+        {
+            AllocTagScope innerScope(inner);
+            allocateBlocks(2, 8);
+        }
+        EXPECT_EQ(AllocTracker::Current(), outer);
+        allocateBlocks(1, 8);
+    }
+    EXPECT_EQ(AllocTracker::Counts(outer).allocations - outerBefore.allocations, 2u);
+    EXPECT_EQ(AllocTracker::Counts(inner).allocations - innerBefore.allocations, 2u);
+}
+
+// std::thread allocates its state on the creating thread, so the other
+// thread is started before the measurement and released by a flag.
+
+TEST(AllocTrackerTest, ThreadCountsCoverOnlyTheCallingThread) {
+    std::atomic<bool> go{false};
+    std::thread other([&go] {
+        while (!go.load()) {
+            std::this_thread::yield();
+        }
+        allocateBlocks(10, 64);
+    });
+    const AllocCounts before = AllocTracker::ThreadCounts();
+    go = true;
+    other.join();
+    allocateBlocks(2, 64);
+    const AllocCounts after = AllocTracker::ThreadCounts();
+    EXPECT_EQ(after.allocations - before.allocations, 2u);
+    EXPECT_EQ(after.bytes - before.bytes, 128u);
+}
+
+TEST(AllocTrackerTest, TagsArePerThread) {
+    const AllocTag tag = AllocTracker::Register("test.per_thread");
+    std::atomic<bool> go{false};
+    std::thread other([&go] {
+        while (!go.load()) {
+            std::this_thread::yield();
+        }
+        EXPECT_EQ(AllocTracker::Current(), AllocTracker::kUntagged);
+        allocateBlocks(5, 16);
+    });
+    const AllocCounts before = AllocTracker::Counts(tag);
+    AllocTagScope scope(tag);
+    go = true;
+    other.join();
+    EXPECT_EQ(AllocTracker::Counts(tag).allocations, before.allocations);
+}
+
+TEST(AllocTrackerTest, SnapshotListsEveryTag) {
+    const AllocTag tag = AllocTracker::Register("test.snapshot");
+    {
+        AllocTagScope scope(tag);
+        allocateBlocks(1, 32);
+    }
+    const auto snapshot = AllocTracker::Snapshot();
+    ASSERT_EQ(snapshot.size(), AllocTracker::TagCount());
+    EXPECT_EQ(snapshot.front().tag, AllocTracker::kUntagged);
+    ASSERT_GT(snapshot.size(), static_cast<std::size_t>(tag));
+    EXPECT_EQ(snapshot[tag].name, "test.snapshot");
+    EXPECT_GE(snapshot[tag].counts.allocations, 1u);
+}
+
+// ── Strict mode ─────────────────────────────────────────────────────────────
+
+namespace {
+
+std::atomic<int> gViolations{0};
+std::atomic<AllocTag> gViolatingTag{0};
+
+void countViolation(AllocTag tag, std::size_t) {
+    gViolations.fetch_add(1);
+    gViolatingTag.store(tag);
+}
+
+}  // namespace
+
+TEST(AllocTrackerTest, StrictHandlerReportsTaggedAllocations) {
+    const AllocTag tag = AllocTracker::Register("test.strict");
+    gViolations = 0;
+    AllocTracker::SetStrictHandler(&countViolation);
+
+    allocateBlocks(3, 8);  // Untagged: not reported.
+    EXPECT_EQ(gViolations.load(), 0);
+    {
+        AllocTagScope scope(tag);
+        allocateBlocks(2, 8);
+    }
+    AllocTracker::SetStrictHandler(nullptr);
+
+    EXPECT_EQ(gViolations.load(), 2);
+    EXPECT_EQ(gViolatingTag.load(), tag);
+
+    AllocTagScope scope(tag);
+    allocateBlocks(1, 8);  // Strict mode off again.
+    EXPECT_EQ(gViolations.load(), 2);
+}
+
+TEST(AllocTrackerTest, StrictModePassesAllocationFreeCode) {
+    const AllocTag tag = AllocTracker::Register("test.steady");
+    std::vector<int> buffer;
+    buffer.reserve(64);  // Grown before the steady state.
+
+    gViolations = 0;
+    AllocTracker::SetStrictHandler(&countViolation);
+    {
+        AllocTagScope scope(tag);
+        for (int tick = 0; tick < 100; ++tick) {
+            buffer.clear();
+            for (int i = 0; i < 64; ++i) {
+                buffer.push_back(i);
+            }
+        }
+    }
+    AllocTracker::SetStrictHandler(nullptr);
+    EXPECT_EQ(gViolations.load(), 0);
+}
@@ -0,0 +1,315 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "cgs/foundation/binary_log.hpp"
+#include "cgs/foundation/error_code.hpp"
+#include "cgs/foundation/game_logger.hpp"
+#include "cgs/foundation/json_log_formatter.hpp"
+
+#include <kcenon/common/interfaces/global_logger_registry.h>
+
+using namespace cgs::foundation;
+namespace fs = std::filesystem;
+
+namespace {
+
+std::chrono::system_clock::time_point at(int64_t micros) {
+    // 2026-02-14T12:00:00Z
+    return std::chrono::system_clock::time_point(std::chrono::seconds(1771070400)) +
+           std::chrono::microseconds(micros);
+}
+
+std::string readFile(const fs::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+
+/// Decode every record of @p reader, failing the test on an error.
+std::vector<DecodedLogRecord> readAll(BinaryLogReader& reader) {
+    std::vector<DecodedLogRecord> records;
+    DecodedLogRecord record;
+    while (true) {
+        auto next = reader.next(record);
+        EXPECT_TRUE(next.hasValue());
+        if (!next.hasValue() || !next.value()) {
+            return records;
+        }
+        records.push_back(record);
+    }
+}
+
+class BinaryLogTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path_ = fs::temp_directory_path() /
+                ("cgs_binary_log_" +
+                 std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+        fs::remove(path_);
+    }
+
+    void TearDown() override { fs::remove(path_); }
+
+    std::shared_ptr<BinaryLogWriter> openWriter(BinaryLogConfig config = {}) {
+        auto writer = BinaryLogWriter::open(path_, config);
+        EXPECT_TRUE(writer.hasValue());
+        return writer.hasValue() ? writer.value() : nullptr;
+    }
+
+    std::vector<DecodedLogRecord> decodeFile() {
+        auto reader = BinaryLogReader::open(path_);
+        EXPECT_TRUE(reader.hasValue());
+        return reader.hasValue() ? readAll(reader.value()) : std::vector<DecodedLogRecord>{};
+    }
+
+    /// Append @p count logf()-style records, one microsecond apart.
+    static void appendNumbered(BinaryLogWriter& writer, int count) {
+        for (int i = 0; i < count; ++i) {
+            const std::array<LogArg, 2> args{LogArg(i), LogArg("orc")};
+            BinaryLogRecord record;
+            record.timestamp = at(i);
+            record.format = "spawned {} ({})";
+            record.args = args;
+            writer.append(record);
+        }
+    }
+
+    fs::path path_;
+};
+
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// Writer / reader
+// ---------------------------------------------------------------------------
+
+TEST_F(BinaryLogTest, RecordsRoundTripWithArgumentsAndContext) {
+    {
+        auto writer = openWriter();
+        ASSERT_NE(writer, nullptr);
+
+        const std::array<LogArg, 6> args{
+            LogArg(-42), LogArg(7u), LogArg(1.5), LogArg(true), LogArg('x'), LogArg("sword")};
+        BinaryLogRecord formatted;
+        formatted.timestamp = at(123456);
+        formatted.level = LogLevel::Debug;
+        formatted.category = LogCategory::Combat;
+        formatted.format = "{} {} {} {} {} {} {}";
+        formatted.args = args;
+        writer->append(formatted);
+
+        LogContext ctx;
+        ctx.playerId = PlayerId(42);
+        ctx.extra["zone"] = "3";
+        BinaryLogRecord plain;
+        plain.timestamp = at(100);  // Earlier than the previous record
+        plain.level = LogLevel::Warning;
+        plain.category = LogCategory::World;
+        plain.message = "zone full";
+        plain.context = &ctx;
+        plain.correlationId = "req-1";
+        writer->append(plain);
+
+        EXPECT_TRUE(writer->flush().hasValue());
+        EXPECT_EQ(writer->stats().records, 2u);
+        EXPECT_EQ(writer->stats().segments, 1u);
+    }
+
+    auto records = decodeFile();
+    ASSERT_EQ(records.size(), 2u);
+
+    EXPECT_EQ(records[0].timestamp, at(123456));
+    EXPECT_EQ(records[0].level, LogLevel::Debug);
+    EXPECT_EQ(records[0].category, LogCategory::Combat);
+    EXPECT_EQ(records[0].message, "-42 7 1.5 true x sword {}");
+    EXPECT_FALSE(records[0].context.has_value());
+    EXPECT_EQ(renderLogText(records[0]),
+              "2026-02-14T12:00:00.123456Z DEBUG [Combat] -42 7 1.5 true x sword {}");
+
+    EXPECT_EQ(records[1].timestamp, at(100));
+    EXPECT_EQ(records[1].message, "zone full");
+    ASSERT_TRUE(records[1].context.has_value());
+    EXPECT_EQ(records[1].context->playerId, PlayerId(42));
+    EXPECT_EQ(records[1].context->extra.at("zone"), "3");
+    EXPECT_EQ(records[1].correlationId, "req-1");
+
+    LogContext expected = *records[1].context;
+    expected.traceId = "req-1";
+    EXPECT_EQ(renderLogJson(records[1]),
+              JsonLogFormatter::format(
+                  LogLevel::Warning, LogCategory::World, "zone full", expected, at(100)));
+}
+
+TEST_F(BinaryLogTest, FullSegmentsAreSealedCompressedAndSelfContained) {
+    BinaryLogConfig config;
+    config.segmentBytes = 512;
+    {
+        auto writer = openWriter(config);
+        ASSERT_NE(writer, nullptr);
+        appendNumbered(*writer, 300);
+        writer->flush();
+
+        const auto stats = writer->stats();
+        EXPECT_EQ(stats.records, 300u);
+        EXPECT_GT(stats.segments, 1u);
+        EXPECT_LT(stats.storedBytes, stats.rawBytes);
+        EXPECT_EQ(stats.writeErrors, 0u);
+    }
+
+    auto records = decodeFile();
+    ASSERT_EQ(records.size(), 300u);
+    for (int i = 0; i < 300; ++i) {
+        EXPECT_EQ(records[static_cast<std::size_t>(i)].message,
+                  "spawned " + std::to_string(i) + " (orc)");
+        EXPECT_EQ(records[static_cast<std::size_t>(i)].timestamp, at(i));
+    }
+}
+
+TEST_F(BinaryLogTest, OldSegmentIsSealedByTheNextRecord) {
+    BinaryLogConfig config;
+    config.maxSegmentAge = std::chrono::milliseconds(10);
+    auto writer = openWriter(config);
+    ASSERT_NE(writer, nullptr);
+
+    BinaryLogRecord record;
+    record.message = "tick";
+    record.timestamp = at(0);
+    writer->append(record);
+    record.timestamp = at(5'000);
+    writer->append(record);
+    EXPECT_EQ(writer->stats().segments, 0u);
+
+    record.timestamp = at(20'000);
+    writer->append(record);
+    EXPECT_EQ(writer->stats().segments, 1u);
+}
+
+TEST_F(BinaryLogTest, ReopeningAppendsToTheFile) {
+    openWriter()->append({.timestamp = at(1), .message = "first run"});
+    openWriter()->append({.timestamp = at(2), .message = "second run"});
+
+    auto records = decodeFile();
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(records[0].message, "first run");
+    EXPECT_EQ(records[1].message, "second run");
+}
+
+TEST_F(BinaryLogTest, TruncatedTailEndsTheLogAfterTheLastWholeSegment) {
+    BinaryLogConfig config;
+    config.segmentBytes = 512;
+    std::size_t firstSegment = 0;
+    {
+        auto writer = openWriter(config);
+        ASSERT_NE(writer, nullptr);
+        appendNumbered(*writer, 40);
+        writer->flush();
+        firstSegment = static_cast<std::size_t>(writer->stats().records);
+        appendNumbered(*writer, 40);
+    }
+
+    std::string bytes = readFile(path_);
+    bytes.resize(bytes.size() - 10);
+    auto reader = BinaryLogReader::fromBytes(bytes);
+    ASSERT_TRUE(reader.hasValue());
+    auto records = readAll(reader.value());
+    EXPECT_GE(records.size(), firstSegment);
+    EXPECT_LT(records.size(), 80u);
+    EXPECT_TRUE(reader.value().truncated());
+}
+
+TEST_F(BinaryLogTest, DamageIsReportedAsCorrupt) {
+    {
+        auto writer = openWriter();
+        ASSERT_NE(writer, nullptr);
+        appendNumbered(*writer, 10);
+    }
+    std::string bytes = readFile(path_);
+
+    std::string badMagic = bytes;
+    badMagic[16] ^= 0x5A;  // First segment header
+    auto reader = BinaryLogReader::fromBytes(badMagic);
+    ASSERT_TRUE(reader.hasValue());
+    DecodedLogRecord record;
+    auto next = reader.value().next(record);
+    ASSERT_FALSE(next.hasValue());
+    EXPECT_EQ(next.error().code(), ErrorCode::LogFileCorrupt);
+
+    auto notALog = BinaryLogReader::fromBytes("plain text log line\n");
+    ASSERT_FALSE(notALog.hasValue());
+    EXPECT_EQ(notALog.error().code(), ErrorCode::LogFileCorrupt);
+
+    std::ofstream(path_, std::ios::trunc) << "plain text log line\n";
+    auto writer = BinaryLogWriter::open(path_);
+    ASSERT_FALSE(writer.hasValue());
+    EXPECT_EQ(writer.error().code(), ErrorCode::LogFileCorrupt);
+}
+
+TEST_F(BinaryLogTest, MissingFileCannotBeRead) {
+    auto reader = BinaryLogReader::open(path_);
+    ASSERT_FALSE(reader.hasValue());
+    EXPECT_EQ(reader.error().code(), ErrorCode::LogFileOpenFailed);
+}
+
+// ---------------------------------------------------------------------------
+// GameLogger with a binary sink
+// ---------------------------------------------------------------------------
+
+class GameLoggerBinarySinkTest : public BinaryLogTest {
+protected:
+    void SetUp() override {
+        BinaryLogTest::SetUp();
+        kcenon::common::interfaces::GlobalLoggerRegistry::instance().clear();
+    }
+
+    void logSample(GameLogger& logger) {
+        CorrelationScope scope("corr-7");
+        logger.log(LogLevel::Info, LogCategory::Core, "server up");
+        LogContext ctx;
+        ctx.entityId = EntityId(9);
+        logger.logWithContext(LogLevel::Error, LogCategory::Combat, "bad hit", ctx);
+        logger.logf(LogLevel::Warning, LogCategory::Network, "{} of {} sent", 3, 4);
+    }
+
+    void expectSample() {
+        auto records = decodeFile();
+        ASSERT_EQ(records.size(), 3u);
+        EXPECT_EQ(records[0].message, "server up");
+        EXPECT_EQ(records[0].correlationId, "corr-7");
+        EXPECT_EQ(records[1].level, LogLevel::Error);
+        EXPECT_EQ(records[1].category, LogCategory::Combat);
+        ASSERT_TRUE(records[1].context.has_value());
+        EXPECT_EQ(records[1].context->entityId, EntityId(9));
+        EXPECT_EQ(records[2].category, LogCategory::Network);
+        EXPECT_EQ(records[2].message, "3 of 4 sent");
+    }
+};
+
+TEST_F(GameLoggerBinarySinkTest, SynchronousCallsGoToTheSink) {
+    GameLogger logger;
+    logger.setBinarySink(openWriter());
+    EXPECT_TRUE(logger.hasBinarySink());
+
+    logSample(logger);
+    EXPECT_TRUE(logger.flush().hasValue());
+    expectSample();
+
+    logger.setBinarySink(nullptr);
+    EXPECT_FALSE(logger.hasBinarySink());
+}
+
+TEST_F(GameLoggerBinarySinkTest, AsyncWriterAppendsToTheSink) {
+    GameLogger logger;
+    logger.setBinarySink(openWriter());
+    logger.setAsyncMode(true);
+
+    logSample(logger);
+    EXPECT_TRUE(logger.flush().hasValue());
+    logger.setAsyncMode(false);
+    expectSample();
+}
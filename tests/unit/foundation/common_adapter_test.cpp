@@ -190,6 +190,38 @@ TEST(ServiceLocatorTest, Clear) {
     EXPECT_EQ(locator.get<ICounter>(), nullptr);
 }
 
+TEST(ServiceLocatorTest, HandleFollowsRegistration) {
+    ServiceLocator locator;
+    auto handle = locator.handle<ICounter>();
+    EXPECT_FALSE(handle);
+    EXPECT_EQ(locator.size(), 0u);
+
+    locator.add<ICounter>(std::make_unique<SimpleCounter>(3));
+    ASSERT_TRUE(handle);
+    EXPECT_EQ(handle->count(), 3);
+
+    locator.add<ICounter>(std::make_unique<SimpleCounter>(4));
+    EXPECT_EQ(handle.get()->count(), 4);
+
+    locator.remove<ICounter>();
+    EXPECT_EQ(handle.get(), nullptr);
+    EXPECT_FALSE(ServiceHandle<ICounter>{});
+}
+
+TEST(ServiceLocatorTest, TypeIdsAreDense) {
+    struct A {};
+    struct B {};
+    EXPECT_EQ(ServiceType<A>::Id(), ServiceType<A>::Id());
+    EXPECT_NE(ServiceType<A>::Id(), ServiceType<B>::Id());
+
+    ServiceLocator locator;
+    locator.add<A>(std::make_unique<A>());
+    locator.add<B>(std::make_unique<B>());
+    EXPECT_NE(locator.get<A>(), nullptr);
+    EXPECT_NE(locator.get<B>(), nullptr);
+    EXPECT_EQ(locator.size(), 2u);
+}
+
 // --- ConfigManager tests ---
 
 class ConfigManagerTest : public ::testing::Test {
@@ -297,3 +329,54 @@ TEST_F(ConfigManagerTest, WatchNotification) {
     EXPECT_TRUE(notified);
     EXPECT_EQ(notifiedKey, "server.port");
 }
+
+TEST_F(ConfigManagerTest, BindFollowsSetAndLoad) {
+    ConfigManager config;
+    auto crit = config.bind<double>("combat.crit_multiplier", 1.5);
+    auto name = config.bind<std::string>("server.name");
+    EXPECT_TRUE(crit.bound());
+    EXPECT_FALSE(crit.present());
+    EXPECT_DOUBLE_EQ(crit.get(), 1.5);
+    EXPECT_EQ(name.get(), "");
+
+    config.set<double>("combat.crit_multiplier", 2.0);
+    EXPECT_TRUE(crit.present());
+    EXPECT_DOUBLE_EQ(*crit, 2.0);
+
+    auto path = writeYaml("bind.yaml", R"(
+combat:
+  crit_multiplier: oops
+server:
+  name: "Realm"
+)");
+    ASSERT_TRUE(config.load(path).hasValue());
+    EXPECT_FALSE(crit.present());  // Does not convert: back to the fallback
+    EXPECT_DOUBLE_EQ(crit.get(), 1.5);
+    EXPECT_EQ(name.get(), "Realm");
+    EXPECT_EQ(config.version(), 2u);
+
+    EXPECT_FALSE(ConfigValue<int>{}.bound());
+    EXPECT_EQ(ConfigValue<int>{}.get(), 0);
+}
+
+TEST_F(ConfigManagerTest, WatchersRunAfterSwapAndOnlyForChangedKeys) {
+    auto first = writeYaml("first.yaml", "ai:\n  tick_interval: 100\nother: 1\n");
+    auto second = writeYaml("second.yaml", "ai:\n  tick_interval: 200\nother: 1\n");
+
+    ConfigManager config;
+    ASSERT_TRUE(config.load(first).hasValue());
+    auto tick = config.bind<int>("ai.tick_interval");
+
+    int seen = 0;
+    int otherCalls = 0;
+    config.watch("ai.tick_interval", [&](std::string_view) {
+        // Watchers see the new snapshot and may read without deadlocking.
+        seen = config.get<int>("ai.tick_interval").value();
+        EXPECT_EQ(tick.get(), seen);
+    });
+    config.watch("other", [&](std::string_view) { ++otherCalls; });
+
+    ASSERT_TRUE(config.load(second).hasValue());
+    EXPECT_EQ(seen, 200);
+    EXPECT_EQ(otherCalls, 0);
+}
@@ -1,7 +1,11 @@
 #include <gtest/gtest.h>
 
+#include <array>
 #include <cstdint>
+#include <span>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "cgs/foundation/container_adapter.hpp"
 #include "cgs/foundation/error_code.hpp"
@@ -67,6 +71,108 @@ CGS_SERIALIZABLE(AllTypes, 1,
 struct Empty {};
 CGS_SERIALIZABLE(Empty, 1);
 
+// Owning type and its zero-copy view, plus a byte payload view.
+struct ChatLine {
+    uint32_t channel = 0;
+    std::string text;
+};
+
+CGS_SERIALIZABLE(ChatLine, 1,
+    field("channel", &ChatLine::channel),
+    field("text", &ChatLine::text)
+);
+
+struct ChatLineView {
+    uint32_t channel = 0;
+    std::string_view text;
+};
+
+CGS_SERIALIZABLE(ChatLineView, 1,
+    field("channel", &ChatLineView::channel),
+    field("text", &ChatLineView::text)
+);
+
+struct BlobView {
+    uint16_t kind = 0;
+    std::span<const uint8_t> payload;
+};
+
+CGS_SERIALIZABLE(BlobView, 1,
+    field("kind", &BlobView::kind),
+    field("payload", &BlobView::payload)
+);
+
+// Fixed-layout type for compile-time sizing.
+struct Fixed {
+    int32_t a = 0;
+    double b = 0.0;
+    bool c = false;
+};
+
+CGS_SERIALIZABLE(Fixed, 1,
+    field("a", &Fixed::a),
+    field("b", &Fixed::b),
+    field("c", &Fixed::c)
+);
+
+// Padding-free all-float layout: eligible for the bulk-copy path.
+struct Pose {
+    float px = 0.0f, py = 0.0f, pz = 0.0f;
+    float qw = 1.0f, qx = 0.0f, qy = 0.0f, qz = 0.0f;
+};
+
+CGS_SERIALIZABLE(Pose, 1,
+    field("px", &Pose::px), field("py", &Pose::py), field("pz", &Pose::pz),
+    field("qw", &Pose::qw), field("qx", &Pose::qx), field("qy", &Pose::qy),
+    field("qz", &Pose::qz)
+);
+
+// Same fields registered out of memory order: falls back to per field.
+struct PoseReordered {
+    float px = 0.0f, py = 0.0f, pz = 0.0f;
+    float qw = 1.0f, qx = 0.0f, qy = 0.0f, qz = 0.0f;
+};
+
+CGS_SERIALIZABLE(PoseReordered, 1,
+    field("qw", &PoseReordered::qw), field("qx", &PoseReordered::qx),
+    field("qy", &PoseReordered::qy), field("qz", &PoseReordered::qz),
+    field("px", &PoseReordered::px), field("py", &PoseReordered::py),
+    field("pz", &PoseReordered::pz)
+);
+
+// Nested, ranged and enum fields for the compact form.
+struct Position {
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+};
+
+CGS_SERIALIZABLE(Position, 1,
+    field("x", &Position::x),
+    field("y", &Position::y),
+    field("z", &Position::z)
+);
+
+enum class Stance : uint8_t { Standing, Crouched, Prone };
+
+struct MoveUpdate {
+    uint32_t entity = 0;
+    Position position;
+    int16_t heading = 0;
+    Stance stance = Stance::Standing;
+    bool sprinting = false;
+    bool grounded = false;
+};
+
+CGS_SERIALIZABLE(MoveUpdate, 1,
+    field("entity", &MoveUpdate::entity),
+    field("position", &MoveUpdate::position, FieldRange{-5000.0, 5000.0, 0.01}),
+    field("heading", &MoveUpdate::heading, FieldRange{0, 359}),
+    field("stance", &MoveUpdate::stance),
+    field("sprinting", &MoveUpdate::sprinting),
+    field("grounded", &MoveUpdate::grounded)
+);
+
 // ===========================================================================
 // ErrorCode: Serialization subsystem
 // ===========================================================================
@@ -220,6 +326,211 @@ TEST(BinaryErrorTest, TruncatedHeader) {
     EXPECT_EQ(result.error().code(), ErrorCode::InvalidBinaryData);
 }
 
+// ===========================================================================
+// Binary: buffer reuse and zero-copy views
+// ===========================================================================
+
+TEST(BinaryBufferTest, FixedSizeIsCompileTime) {
+    static_assert(GameSerializer::fixedBinarySize<Fixed>() == 12 + 4 + 8 + 1);
+    GameSerializer s;
+    Fixed src{-7, 0.5, true};
+    EXPECT_EQ(s.serializeBinary(src).size(), GameSerializer::fixedBinarySize<Fixed>());
+    EXPECT_EQ(GameSerializer::binarySize(PlayerV1{1, "Alice", 2}),
+              s.serializeBinary(PlayerV1{1, "Alice", 2}).size());
+}
+
+TEST(BinaryBufferTest, SerializeIntoSpan) {
+    GameSerializer s;
+    Fixed src{-7, 0.5, true};
+    std::array<uint8_t, GameSerializer::fixedBinarySize<Fixed>()> buf{};
+    auto written = s.serializeInto(src, buf);
+    ASSERT_TRUE(written.hasValue());
+    EXPECT_EQ(written.value(), buf.size());
+
+    auto result = s.deserializeBinary<Fixed>(buf);
+    ASSERT_TRUE(result.hasValue());
+    EXPECT_EQ(result.value().a, -7);
+    EXPECT_DOUBLE_EQ(result.value().b, 0.5);
+    EXPECT_TRUE(result.value().c);
+
+    std::array<uint8_t, 8> small{};
+    auto tooSmall = s.serializeInto(src, small);
+    ASSERT_TRUE(tooSmall.hasError());
+    EXPECT_EQ(tooSmall.error().code(), ErrorCode::SerializationError);
+    EXPECT_EQ(small, (std::array<uint8_t, 8>{}));
+}
+
+TEST(BinaryBufferTest, SerializeAppendKeepsExistingBytes) {
+    GameSerializer s;
+    std::vector<uint8_t> buf{0xAA, 0xBB};
+    s.serializeAppend(PlayerV1{5, "Bob", 9}, buf);
+    const auto first = buf.size();
+    s.serializeAppend(PlayerV1{6, "Eve", 3}, buf);
+    EXPECT_EQ(buf[0], 0xAA);
+    EXPECT_EQ(buf[1], 0xBB);
+
+    std::span<const uint8_t> all(buf);
+    auto a = s.deserializeBinary<PlayerV1>(all.subspan(2, first - 2));
+    auto b = s.deserializeBinary<PlayerV1>(all.subspan(first));
+    ASSERT_TRUE(a.hasValue());
+    ASSERT_TRUE(b.hasValue());
+    EXPECT_EQ(a.value().name, "Bob");
+    EXPECT_EQ(b.value().name, "Eve");
+}
+
+TEST(BinaryBufferTest, ViewPointsIntoInput) {
+    GameSerializer s;
+    auto bin = s.serializeBinary(ChatLine{3, "hello there"});
+
+    auto result = s.deserializeView<ChatLineView>(bin);
+    ASSERT_TRUE(result.hasValue());
+    EXPECT_EQ(result.value().channel, 3u);
+    EXPECT_EQ(result.value().text, "hello there");
+    const auto* text = reinterpret_cast<const uint8_t*>(result.value().text.data());
+    EXPECT_GE(text, bin.data());
+    EXPECT_LT(text, bin.data() + bin.size());
+
+    // A view serializes like its owning type.
+    EXPECT_EQ(s.serializeBinary(result.value()), bin);
+    auto owned = s.deserializeBinary<ChatLine>(s.serializeBinary(result.value()));
+    ASSERT_TRUE(owned.hasValue());
+    EXPECT_EQ(owned.value().text, "hello there");
+}
+
+TEST(BinaryBufferTest, SpanFieldRoundTrip) {
+    GameSerializer s;
+    const std::array<uint8_t, 4> payload{1, 2, 3, 4};
+    auto bin = s.serializeBinary(BlobView{9, payload});
+    EXPECT_EQ(bin.size(), GameSerializer::binarySize(BlobView{9, payload}));
+
+    auto result = s.deserializeView<BlobView>(bin);
+    ASSERT_TRUE(result.hasValue());
+    EXPECT_EQ(result.value().kind, 9);
+    ASSERT_EQ(result.value().payload.size(), 4u);
+    EXPECT_EQ(result.value().payload[3], 4);
+    EXPECT_EQ(result.value().payload.data(), bin.data() + bin.size() - 4);
+}
+
+TEST(BinaryBufferTest, TruncatedViewKeepsDefaults) {
+    GameSerializer s;
+    auto bin = s.serializeBinary(ChatLine{3, "hello"});
+    bin.pop_back();
+    auto result = s.deserializeView<ChatLineView>(bin);
+    ASSERT_TRUE(result.hasValue());
+    EXPECT_EQ(result.value().channel, 3u);
+    EXPECT_TRUE(result.value().text.empty());
+}
+
+// ===========================================================================
+// Binary: bulk copy and arrays
+// ===========================================================================
+
+TEST(BinaryBulkTest, DetectsBulkCopyableLayouts) {
+    static_assert(detail::binary_layout_t<Pose>::bulk);
+    static_assert(detail::binary_layout_t<Position>::bulk);
+    static_assert(!detail::binary_layout_t<Fixed>::bulk);     // bool + padding
+    static_assert(!detail::binary_layout_t<PlayerV1>::bulk);  // string
+    static_assert(!detail::binary_layout_t<MoveUpdate>::bulk);
+    EXPECT_TRUE(detail::memoryLayoutMatches<Pose>());
+    EXPECT_FALSE(detail::memoryLayoutMatches<PoseReordered>());
+    EXPECT_FALSE(detail::memoryLayoutMatches<Fixed>());
+}
+
+TEST(BinaryBulkTest, BulkAndFieldwisePathsRoundtrip) {
+    GameSerializer s;
+    Pose pose{1.0f, 2.0f, 3.0f, 0.5f, 0.5f, 0.5f, 0.5f};
+    auto bin = s.serializeBinary(pose);
+    EXPECT_EQ(bin.size(), GameSerializer::fixedBinarySize<Pose>());
+    auto result = s.deserializeBinary<Pose>(bin);
+    ASSERT_TRUE(result.hasValue());
+    EXPECT_FLOAT_EQ(result.value().pz, 3.0f);
+    EXPECT_FLOAT_EQ(result.value().qz, 0.5f);
+
+    PoseReordered reordered;
+    reordered.px = 4.0f;
+    reordered.qw = 0.25f;
+    auto wire = s.serializeBinary(reordered);
+    auto back = s.deserializeBinary<PoseReordered>(wire);
+    ASSERT_TRUE(back.hasValue());
+    EXPECT_FLOAT_EQ(back.value().px, 4.0f);
+    EXPECT_FLOAT_EQ(back.value().qw, 0.25f);
+}
+
+TEST(BinaryBulkTest, NestedAndEnumFieldsRoundtrip) {
+    GameSerializer s;
+    MoveUpdate src;
+    src.entity = 11;
+    src.position = {1.5f, -2.5f, 3.5f};
+    src.heading = 90;
+    src.stance = Stance::Crouched;
+    src.grounded = true;
+
+    auto bin = s.serializeBinary(src);
+    EXPECT_EQ(bin.size(), 12u + 4u + 12u + 2u + 1u + 1u + 1u);
+    auto result = s.deserializeBinary<MoveUpdate>(bin);
+    ASSERT_TRUE(result.hasValue());
+    EXPECT_FLOAT_EQ(result.value().position.y, -2.5f);
+    EXPECT_EQ(result.value().stance, Stance::Crouched);
+    EXPECT_TRUE(result.value().grounded);
+}
+
+TEST(BinaryArrayTest, BulkArrayRoundtrip) {
+    GameSerializer s;
+    std::vector<Pose> poses(1000);
+    for (std::size_t i = 0; i < poses.size(); ++i) {
+        poses[i].px = static_cast<float>(i);
+    }
+    auto bin = s.serializeArray(std::span<const Pose>(poses));
+    EXPECT_EQ(bin.size(), 12u + 4u + poses.size() * sizeof(Pose));
+
+    auto result = s.deserializeArray<Pose>(bin);
+    ASSERT_TRUE(result.hasValue());
+    ASSERT_EQ(result.value().size(), poses.size());
+    EXPECT_FLOAT_EQ(result.value()[999].px, 999.0f);
+    EXPECT_FLOAT_EQ(result.value()[999].qw, 1.0f);
+
+    bin.pop_back();
+    auto truncated = s.deserializeArray<Pose>(bin);
+    ASSERT_TRUE(truncated.hasError());
+    EXPECT_EQ(truncated.error().code(), ErrorCode::InvalidBinaryData);
+}
+
+TEST(BinaryArrayTest, FieldwiseArrayAndSchemaEvolution) {
+    GameSerializer s;
+    std::vector<PlayerV1> players{{1, "Alice", 10}, {2, "", 3}, {3, "Carol", 40}};
+    auto bin = s.serializeArray(std::span<const PlayerV1>(players));
+
+    auto same = s.deserializeArray<PlayerV1>(bin);
+    ASSERT_TRUE(same.hasValue());
+    ASSERT_EQ(same.value().size(), 3u);
+    EXPECT_EQ(same.value()[2].name, "Carol");
+
+    // Older elements into a newer schema keep defaults for added fields.
+    auto newer = s.deserializeArray<PlayerV2>(bin);
+    ASSERT_TRUE(newer.hasValue());
+    ASSERT_EQ(newer.value().size(), 3u);
+    EXPECT_EQ(newer.value()[1].id, 2);
+    EXPECT_EQ(newer.value()[2].level, 40);
+    EXPECT_TRUE(newer.value()[2].active);
+
+    // Newer elements cannot be split without knowing the added fields.
+    std::vector<PlayerV2> v2(2);
+    auto older = s.deserializeArray<PlayerV1>(s.serializeArray(std::span<const PlayerV2>(v2)));
+    ASSERT_TRUE(older.hasError());
+
+    std::vector<uint8_t> truncated(bin.begin(), bin.end() - 3);
+    EXPECT_TRUE(s.deserializeArray<PlayerV1>(truncated).hasError());
+    EXPECT_TRUE(s.deserializeArray<PlayerV1>(s.serializeBinary(players[0])).hasError());
+}
+
+TEST(BinaryArrayTest, EmptyArray) {
+    GameSerializer s;
+    auto bin = s.serializeArray(std::span<const Pose>());
+    auto result = s.deserializeArray<Pose>(bin);
+    ASSERT_TRUE(result.hasValue());
+    EXPECT_TRUE(result.value().empty());
+}
+
 // ===========================================================================
 // JSON: roundtrip
 // ===========================================================================
@@ -287,6 +598,84 @@ TEST(JsonSerializationTest, ContainsVersionFieldV2) {
     EXPECT_TRUE(json.find("\"__v\":2") != std::string::npos);
 }
 
+TEST(JsonSerializationTest, FloatsRoundTripExactly) {
+    GameSerializer s;
+    AllTypes src;
+    src.floatVal = 0.1f;
+    src.doubleVal = 1.0 / 3.0;
+    src.int64Val = INT64_MIN;
+    src.uint64Val = UINT64_MAX;
+
+    auto json = s.serializeJson(src);
+    EXPECT_NE(json.find("\"floatVal\":0.1,"), std::string::npos);  // shortest form
+    auto result = s.deserializeJson<AllTypes>(json);
+    ASSERT_TRUE(result.hasValue());
+    EXPECT_EQ(result.value().floatVal, 0.1f);
+    EXPECT_EQ(result.value().doubleVal, 1.0 / 3.0);
+    EXPECT_EQ(result.value().int64Val, INT64_MIN);
+    EXPECT_EQ(result.value().uint64Val, UINT64_MAX);
+}
+
+TEST(JsonSerializationTest, AppendReusesBuffer) {
+    GameSerializer s;
+    std::string out = "[";
+    s.serializeJsonAppend(PlayerV1{1, "a", 2}, out);
+    out += ',';
+    s.serializeJsonAppend(PlayerV1{3, "b", 4}, out);
+    out += ']';
+    EXPECT_EQ(out,
+              R"([{"__v":1,"id":1,"name":"a","level":2},)"
+              R"({"__v":1,"id":3,"name":"b","level":4}])");
+}
+
+TEST(JsonSerializationTest, NestedObjectsRoundtrip) {
+    GameSerializer s;
+    MoveUpdate src;
+    src.entity = 11;
+    src.position = {1.5f, -2.5f, 3.5f};
+    src.stance = Stance::Prone;
+    src.grounded = true;
+
+    auto json = s.serializeJson(src);
+    EXPECT_NE(json.find(R"("position":{"x":1.5,"y":-2.5,"z":3.5},)"), std::string::npos);
+    auto result = s.deserializeJson<MoveUpdate>(json);
+    ASSERT_TRUE(result.hasValue());
+    EXPECT_EQ(result.value().entity, 11u);
+    EXPECT_FLOAT_EQ(result.value().position.x, 1.5f);
+    EXPECT_FLOAT_EQ(result.value().position.y, -2.5f);
+    EXPECT_FLOAT_EQ(result.value().position.z, 3.5f);
+    EXPECT_EQ(result.value().stance, Stance::Prone);
+    EXPECT_TRUE(result.value().grounded);
+
+    // Unknown nested values are skipped whole; a broken nested object
+    // fails the document.
+    auto skipped = s.deserializeJson<MoveUpdate>(
+        R"({"extra":{"a":[1,{"b":"}"}]},"position":{"w":{},"y":4},"entity":2})");
+    ASSERT_TRUE(skipped.hasValue());
+    EXPECT_FLOAT_EQ(skipped.value().position.y, 4.0f);
+    EXPECT_EQ(skipped.value().entity, 2u);
+
+    auto broken = s.deserializeJson<MoveUpdate>(R"({"position":{"x" 1},"entity":2})");
+    ASSERT_TRUE(broken.hasError());
+    EXPECT_EQ(broken.error().code(), ErrorCode::InvalidJsonData);
+}
+
+TEST(JsonSerializationTest, BadNumbersKeepDefaults) {
+    GameSerializer s;
+    // Out of range for int32, not a number, and a quoted number.
+    auto result = s.deserializeJson<PlayerV1>(
+        R"({"id":99999999999,"level":"7","name":12,"x":"\"}"})");
+    ASSERT_TRUE(result.hasValue());
+    EXPECT_EQ(result.value().id, 0);
+    EXPECT_EQ(result.value().level, 7);
+    EXPECT_EQ(result.value().name, "12");
+
+    auto garbage = s.deserializeJson<PlayerV1>(R"({"id":abc,"level":+3})");
+    ASSERT_TRUE(garbage.hasValue());
+    EXPECT_EQ(garbage.value().id, 0);
+    EXPECT_EQ(garbage.value().level, 3);
+}
+
 // ===========================================================================
 // JSON: special characters
 // ===========================================================================
@@ -310,6 +699,45 @@ TEST(JsonEscapingTest, EmptyString) {
     EXPECT_TRUE(result.value().name.empty());
 }
 
+TEST(JsonEscapingTest, ControlCharactersAndUnicodeEscapes) {
+    GameSerializer s;
+    // Long enough to cross several 8-byte scan words; UTF-8 passes through.
+    const std::string name = std::string("plain text run \x01 then ") + '\0' +
+                             "\x1f and caf\xc3\xa9 \"end\"";
+    auto json = s.serializeJson(PlayerV1{1, name, 1});
+    EXPECT_NE(json.find("\\u0001"), std::string::npos);
+    EXPECT_NE(json.find("\\u0000"), std::string::npos);
+    EXPECT_NE(json.find("\\u001f"), std::string::npos);
+    EXPECT_NE(json.find("caf\xc3\xa9"), std::string::npos);
+
+    auto result = s.deserializeJson<PlayerV1>(json);
+    ASSERT_TRUE(result.hasValue());
+    EXPECT_EQ(result.value().name, name);
+
+    // \u escapes decode to UTF-8, including surrogate pairs.
+    auto decoded =
+        s.deserializeJson<PlayerV1>(R"({"name":"\u00e9\u20AC\ud83d\ude00\/","id":2})");
+    ASSERT_TRUE(decoded.hasValue());
+    EXPECT_EQ(decoded.value().name, "\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80/");
+    EXPECT_EQ(decoded.value().id, 2);
+}
+
+TEST(JsonEscapingTest, EscapeMatchesPerByteReference) {
+    for (std::size_t len = 0; len < 40; ++len) {
+        for (std::size_t at = 0; at < len; ++at) {
+            std::string input(len, 'a');
+            input[at] = at % 3 == 0 ? '"' : (at % 3 == 1 ? '\\' : '\n');
+            std::string expected;
+            for (char c : input) {
+                detail::appendJsonEscapedChar(expected, c);
+            }
+            std::string out = "prefix";
+            appendJsonEscaped(out, input);
+            EXPECT_EQ(out, "prefix" + expected) << "len " << len << " at " << at;
+        }
+    }
+}
+
 // ===========================================================================
 // JSON: schema versioning
 // ===========================================================================
@@ -337,6 +765,35 @@ TEST(JsonSchemaTest, MissingKeysKeepDefaults) {
     EXPECT_EQ(result.value().level, 1);        // default
 }
 
+TEST(JsonSchemaTest, FieldIndexFindsEveryName) {
+    using Index = cgs::foundation::detail::JsonFieldIndex<AllTypes>;
+    static_assert(Index::kTable.perfect);
+    static_assert(Index::find("doubleVal") == 6);
+    static_assert(Index::find("double") == Index::kCount);
+    static_assert(cgs::foundation::detail::JsonFieldIndex<Empty>::find("x") == 0);
+
+    for (std::size_t i = 0; i < Index::kCount; ++i) {
+        EXPECT_EQ(Index::find(Index::kNames[i]), i);
+    }
+    EXPECT_EQ(Index::find(""), Index::kCount);
+    EXPECT_EQ(Index::find("stringVa"), Index::kCount);
+    EXPECT_EQ(Index::find("stringValX"), Index::kCount);
+}
+
+TEST(JsonSchemaTest, KeysMatchInAnyOrderAndEscaped) {
+    GameSerializer s;
+    std::string_view json =
+        R"({"stringVal":"s","extra":null,"uint64Val":9,"__v":1,"bool\u0056al":true,)"
+        R"("int32Val":-3,"floatval":2.5})";
+    auto result = s.deserializeJson<AllTypes>(json);
+    ASSERT_TRUE(result.hasValue());
+    EXPECT_EQ(result.value().stringVal, "s");
+    EXPECT_EQ(result.value().uint64Val, 9u);
+    EXPECT_TRUE(result.value().boolVal);
+    EXPECT_EQ(result.value().int32Val, -3);
+    EXPECT_EQ(result.value().floatVal, 0.0f);  // Keys are case-sensitive.
+}
+
 // ===========================================================================
 // JSON: error cases
 // ===========================================================================
@@ -369,6 +826,116 @@ TEST(JsonErrorTest, PlainTextNotJson) {
     EXPECT_EQ(result.error().code(), ErrorCode::InvalidJsonData);
 }
 
+// ===========================================================================
+// Compact: bit-packed network form
+// ===========================================================================
+
+TEST(CompactSerializationTest, AllTypesRoundtrip) {
+    GameSerializer s;
+    AllTypes src;
+    src.boolVal = true;
+    src.int32Val = -12345;
+    src.int64Val = -9876543210LL;
+    src.uint32Val = 4000000000u;
+    src.uint64Val = 18000000000000000000ULL;
+    src.floatVal = 3.14f;
+    src.doubleVal = 2.718281828;
+    src.stringVal = "hello world";
+
+    auto wire = s.serializeCompact(src);
+    EXPECT_LT(wire.size(), s.serializeBinary(src).size());
+    auto result = s.deserializeCompact<AllTypes>(wire);
+    ASSERT_TRUE(result.hasValue());
+
+    const auto& v = result.value();
+    EXPECT_EQ(v.boolVal, true);
+    EXPECT_EQ(v.int32Val, -12345);
+    EXPECT_EQ(v.int64Val, -9876543210LL);
+    EXPECT_EQ(v.uint32Val, 4000000000u);
+    EXPECT_EQ(v.uint64Val, 18000000000000000000ULL);
+    EXPECT_FLOAT_EQ(v.floatVal, 3.14f);
+    EXPECT_DOUBLE_EQ(v.doubleVal, 2.718281828);
+    EXPECT_EQ(v.stringVal, "hello world");
+}
+
+TEST(CompactSerializationTest, SmallIntegersUseOneByteVarints) {
+    GameSerializer s;
+    PlayerV1 src{42, "", -3};
+    // hash + id varint + length varint + zigzag level varint
+    auto wire = s.serializeCompact(src);
+    EXPECT_EQ(wire.size(), 4u + 3u);
+    auto result = s.deserializeCompact<PlayerV1>(wire);
+    ASSERT_TRUE(result.hasValue());
+    EXPECT_EQ(result.value().id, 42);
+    EXPECT_EQ(result.value().level, -3);
+}
+
+TEST(CompactSerializationTest, QuantizesRangedAndNestedFields) {
+    GameSerializer s;
+    MoveUpdate src;
+    src.entity = 7;
+    src.position = {1234.567f, -0.004f, -4999.99f};
+    src.heading = 271;
+    src.stance = Stance::Prone;
+    src.sprinting = true;
+
+    // 8 (entity) + 3 x 20 (position at 1 cm) + 9 (heading) + 8 (stance)
+    // + 2 (bools) = 87 bits after the hash.
+    auto wire = s.serializeCompact(src);
+    EXPECT_EQ(wire.size(), 4u + 11u);
+
+    auto result = s.deserializeCompact<MoveUpdate>(wire);
+    ASSERT_TRUE(result.hasValue());
+    const auto& v = result.value();
+    EXPECT_EQ(v.entity, 7u);
+    EXPECT_NEAR(v.position.x, 1234.567f, 0.005f);
+    EXPECT_NEAR(v.position.y, -0.004f, 0.005f);
+    EXPECT_NEAR(v.position.z, -4999.99f, 0.005f);
+    EXPECT_EQ(v.heading, 271);
+    EXPECT_EQ(v.stance, Stance::Prone);
+    EXPECT_TRUE(v.sprinting);
+    EXPECT_FALSE(v.grounded);
+}
+
+TEST(CompactSerializationTest, OutOfRangeValuesClamp) {
+    GameSerializer s;
+    MoveUpdate src;
+    src.position = {9000.0f, -9000.0f, 0.0f};
+    src.heading = 500;
+    auto result = s.deserializeCompact<MoveUpdate>(s.serializeCompact(src));
+    ASSERT_TRUE(result.hasValue());
+    EXPECT_FLOAT_EQ(result.value().position.x, 5000.0f);
+    EXPECT_FLOAT_EQ(result.value().position.y, -5000.0f);
+    EXPECT_EQ(result.value().heading, 359);
+}
+
+TEST(CompactSerializationTest, SchemaHashIdentifiesType) {
+    const auto v1 = GameSerializer::compactSchemaHash<PlayerV1>();
+    EXPECT_EQ(v1, GameSerializer::compactSchemaHash<PlayerV1>());
+    EXPECT_NE(v1, GameSerializer::compactSchemaHash<PlayerV2>());
+    EXPECT_NE(GameSerializer::compactSchemaHash<Position>(),
+              GameSerializer::compactSchemaHash<MoveUpdate>());
+
+    GameSerializer s;
+    auto wire = s.serializeCompact(PlayerV1{1, "x", 2});
+    auto result = s.deserializeCompact<PlayerV2>(wire);
+    ASSERT_TRUE(result.hasError());
+    EXPECT_EQ(result.error().code(), ErrorCode::SchemaMismatch);
+}
+
+TEST(CompactSerializationTest, TruncatedDataFails) {
+    GameSerializer s;
+    auto wire = s.serializeCompact(PlayerV1{1, "Alice", 2});
+    std::vector<uint8_t> truncated(wire.begin(), wire.end() - 2);
+    auto result = s.deserializeCompact<PlayerV1>(truncated);
+    ASSERT_TRUE(result.hasError());
+    EXPECT_EQ(result.error().code(), ErrorCode::InvalidBinaryData);
+
+    auto empty = s.deserializeCompact<PlayerV1>({});
+    ASSERT_TRUE(empty.hasError());
+    EXPECT_EQ(empty.error().code(), ErrorCode::InvalidBinaryData);
+}
+
 // ===========================================================================
 // Construction and move semantics
 // ===========================================================================
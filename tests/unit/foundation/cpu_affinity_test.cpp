@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include "cgs/foundation/cpu_affinity.hpp"
+
+using namespace cgs::foundation;
+
+namespace {
+
+/// Scratch cgroup tree for cgroupCpuLimit().
+class FakeCgroup {
+public:
+    FakeCgroup()
+        : root_(std::filesystem::temp_directory_path() /
+                ("cgs_cgroup_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) +
+                 "_" + ::testing::UnitTest::GetInstance()->current_test_info()->name())) {
+        std::filesystem::create_directories(root_);
+    }
+
+    ~FakeCgroup() { std::filesystem::remove_all(root_); }
+
+    void write(const std::string& relative, const std::string& content) {
+        std::filesystem::create_directories((root_ / relative).parent_path());
+        std::ofstream(root_ / relative) << content;
+    }
+
+    [[nodiscard]] std::string root() const { return root_.string(); }
+
+private:
+    std::filesystem::path root_;
+};
+
+}  // namespace
+
+// ===========================================================================
+// CpuSet
+// ===========================================================================
+
+TEST(CpuSetTest, ParsesKernelCpuLists) {
+    auto set = CpuSet::parse("0-3, 8,10-11\n");
+    ASSERT_TRUE(set.hasValue());
+    EXPECT_EQ(set.value().size(), 7u);
+    EXPECT_TRUE(set.value().contains(8));
+    EXPECT_FALSE(set.value().contains(9));
+    EXPECT_EQ(set.value().toString(), "0-3,8,10-11");
+
+    auto blank = CpuSet::parse("");
+    ASSERT_TRUE(blank.hasValue());
+    EXPECT_TRUE(blank.value().empty());
+}
+
+TEST(CpuSetTest, RejectsMalformedLists) {
+    for (const char* bad : {"a", "3-1", "1-", "-2", "1,,x", "0-99999999"}) {
+        auto set = CpuSet::parse(bad);
+        ASSERT_TRUE(set.hasError()) << bad;
+        EXPECT_EQ(set.error().code(), ErrorCode::InvalidArgument);
+    }
+}
+
+TEST(CpuSetTest, SetOperations) {
+    const CpuSet all{0, 1, 2, 3};
+    const CpuSet odd{1, 3, 5};
+    EXPECT_EQ(all.without(odd), (CpuSet{0, 2}));
+    EXPECT_EQ(all.intersect(odd), (CpuSet{1, 3}));
+    EXPECT_EQ(odd[2], 5u);
+}
+
+// ===========================================================================
+// CPU counts
+// ===========================================================================
+
+TEST(CpuAffinityTest, ParsesCgroupQuotas) {
+    EXPECT_FALSE(parseCgroupCpuMax("max 100000\n").has_value());
+    EXPECT_DOUBLE_EQ(parseCgroupCpuMax("150000 100000\n").value(), 1.5);
+    EXPECT_FALSE(parseCgroupCpuMax("garbage").has_value());
+    EXPECT_FALSE(parseCgroupCfsQuota("-1\n", "100000\n").has_value());
+    EXPECT_DOUBLE_EQ(parseCgroupCfsQuota("200000\n", "100000\n").value(), 2.0);
+}
+
+TEST(CpuAffinityTest, CgroupV2LimitRoundsUp) {
+    FakeCgroup cgroup;
+    cgroup.write("cpu.max", "250000 100000\n");
+    EXPECT_EQ(cgroupCpuLimit(cgroup.root()), 3u);
+
+    cgroup.write("cpu.max", "max 100000\n");
+    EXPECT_FALSE(cgroupCpuLimit(cgroup.root()).has_value());
+}
+
+TEST(CpuAffinityTest, CgroupV1Limit) {
+    FakeCgroup cgroup;
+    cgroup.write("cpu,cpuacct/cpu.cfs_quota_us", "50000\n");
+    cgroup.write("cpu,cpuacct/cpu.cfs_period_us", "100000\n");
+    EXPECT_EQ(cgroupCpuLimit(cgroup.root()), 1u);
+}
+
+TEST(CpuAffinityTest, NoCgroupMeansNoLimit) {
+    FakeCgroup cgroup;
+    EXPECT_FALSE(cgroupCpuLimit(cgroup.root()).has_value());
+}
+
+TEST(CpuAffinityTest, AvailableCpuCountIsWithinAllowedCpus) {
+    const auto count = availableCpuCount();
+    EXPECT_GE(count, 1u);
+    EXPECT_LE(count, allowedCpus().size());
+}
+
+// ===========================================================================
+// Pinning and placement
+// ===========================================================================
+
+#if defined(__linux__)
+TEST(CpuAffinityTest, PinsTheCallingThread) {
+    const CpuSet allowed = allowedCpus();
+    const CpuSet target{allowed[allowed.size() - 1]};
+    CpuSet seen;
+    std::thread([&] {
+        ASSERT_TRUE(pinCurrentThread(target).hasValue());
+        seen = allowedCpus();
+    }).join();
+    EXPECT_EQ(seen, target);
+    EXPECT_EQ(allowedCpus(), allowed);  // Other threads are unaffected
+}
+
+TEST(CpuAffinityTest, RejectsCpusOutsideTheMachine) {
+    std::thread([] {
+        auto result = pinCurrentThread(CpuSet{CPU_SETSIZE + 1});
+        ASSERT_TRUE(result.hasError());
+        EXPECT_EQ(result.error().code(), ErrorCode::InvalidArgument);
+    }).join();
+}
+#endif
+
+TEST(ThreadPlacementTest, IsolatedGameThreadOwnsItsCpu) {
+    const auto placement = ThreadPlacement::isolatedGameThread(CpuSet{0, 1, 2, 3});
+    EXPECT_EQ(placement.gameLoop, (CpuSet{0}));
+    EXPECT_EQ(placement.workers, (CpuSet{1, 2, 3}));
+    EXPECT_EQ(placement.network, placement.workers);
+
+    const auto single = ThreadPlacement::isolatedGameThread(CpuSet{5});
+    EXPECT_TRUE(single.gameLoop.empty());
+    EXPECT_TRUE(single.workers.empty());
+}
+
+TEST(ThreadPlacementTest, NumaNodeZeroIsAllowed) {
+    const auto placement = ThreadPlacement::onNumaNode(0);
+    for (auto cpu : placement.workers.cpus()) {
+        EXPECT_TRUE(allowedCpus().contains(cpu));
+    }
+    EXPECT_TRUE(numaNodes().contains(0));
+}
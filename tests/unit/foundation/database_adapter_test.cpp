@@ -1,5 +1,11 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
 #include <string>
 #include <thread>
 #include <vector>
@@ -41,6 +47,10 @@ TEST(DatabaseConfigTest, DefaultValues) {
     EXPECT_EQ(config.minConnections, 2u);
     EXPECT_EQ(config.maxConnections, 10u);
     EXPECT_EQ(config.connectionTimeout, std::chrono::seconds(30));
+    EXPECT_EQ(config.growAfterWait.count(), 0);
+    EXPECT_EQ(config.idleTimeout.count(), 0);
+    EXPECT_EQ(config.maxLifetime.count(), 0);
+    EXPECT_DOUBLE_EQ(config.poolJitter, 0.2);
 }
 
 TEST(DatabaseConfigTest, CustomValues) {
@@ -154,6 +164,33 @@ TEST(PreparedStatementTest, PrefixSafeParameterMatching) {
     EXPECT_TRUE(resolved.find("exp > 100") != std::string::npos);
 }
 
+TEST(PreparedStatementTest, PositionalSqlNumbersDistinctNames) {
+    PreparedStatement stmt(
+        "SELECT * FROM p WHERE level > $min AND exp > $min_level AND rank < $min");
+    EXPECT_EQ(stmt.parameterNames(), (std::vector<std::string>{"min", "min_level"}));
+    EXPECT_EQ(stmt.positionalSql(), "SELECT * FROM p WHERE level > $1 AND exp > $2 AND rank < $1");
+}
+
+TEST(PreparedStatementTest, PositionalSqlKeepsNonPlaceholderDollars) {
+    PreparedStatement stmt("SELECT '$' || $name, $1");
+    EXPECT_EQ(stmt.parameterNames(), (std::vector<std::string>{"name"}));
+    EXPECT_EQ(stmt.positionalSql(), "SELECT '$' || $1, $1");
+}
+
+TEST(PreparedStatementTest, BindingLookup) {
+    PreparedStatement stmt("SELECT * FROM players WHERE id = $id");
+    EXPECT_EQ(stmt.binding("id"), nullptr);
+    stmt.bindInt("id", 7);
+    ASSERT_NE(stmt.binding("id"), nullptr);
+    EXPECT_EQ(std::get<std::int64_t>(*stmt.binding("id")), 7);
+}
+
+TEST(PreparedStatementTest, DoubleBindingRoundTrips) {
+    PreparedStatement stmt("SELECT $r");
+    stmt.bindDouble("r", 0.1);
+    EXPECT_EQ(stmt.resolve(), "SELECT 0.1");
+}
+
 // ===========================================================================
 // GameDatabase: construction and move
 // ===========================================================================
@@ -189,6 +226,18 @@ TEST(GameDatabaseTest, QueryWhenNotConnected) {
     EXPECT_EQ(result.error().code(), ErrorCode::NotConnected);
 }
 
+TEST(GameDatabaseTest, QueryStreamWhenNotConnected) {
+    GameDatabase db;
+    bool called = false;
+    auto result = db.queryStream("SELECT * FROM players", [&](const QueryResult&) {
+        called = true;
+        return true;
+    });
+    EXPECT_TRUE(result.hasError());
+    EXPECT_EQ(result.error().code(), ErrorCode::NotConnected);
+    EXPECT_FALSE(called);
+}
+
 TEST(GameDatabaseTest, ExecuteWhenNotConnected) {
     GameDatabase db;
     auto result = db.execute("INSERT INTO t VALUES (1)");
@@ -203,6 +252,16 @@ TEST(GameDatabaseTest, PrepareWhenNotConnected) {
     EXPECT_EQ(result.error().code(), ErrorCode::NotConnected);
 }
 
+TEST(GameDatabaseTest, ExecutePreparedWhenNotConnected) {
+    GameDatabase db;
+    PreparedStatement stmt("SELECT * FROM players WHERE id = $id");
+    stmt.bindInt("id", 1);
+    auto result = db.execute(stmt);
+    ASSERT_TRUE(result.hasError());
+    EXPECT_EQ(result.error().code(), ErrorCode::NotConnected);
+    EXPECT_EQ(db.preparedStatementStats().prepared, 0u);
+}
+
 TEST(GameDatabaseTest, BeginTransactionWhenNotConnected) {
     GameDatabase db;
     auto result = db.beginTransaction();
@@ -210,6 +269,26 @@ TEST(GameDatabaseTest, BeginTransactionWhenNotConnected) {
     EXPECT_EQ(result.error().code(), ErrorCode::NotConnected);
 }
 
+TEST(GameDatabaseTest, AsyncQueryWhenNotConnected) {
+    GameDatabase db;
+
+    auto future = db.queryAsync("SELECT 1");
+    auto fromFuture = future.get();
+    ASSERT_TRUE(fromFuture.hasError());
+    EXPECT_EQ(fromFuture.error().code(), ErrorCode::NotConnected);
+
+    bool called = false;
+    db.queryAsync("SELECT 1", [&called](GameResult<QueryResult> result) {
+        called = true;
+        EXPECT_EQ(result.error().code(), ErrorCode::NotConnected);
+    });
+    EXPECT_TRUE(called);  // Inline: no worker without a connection
+
+    auto fromTask = syncWait(db.queryTask("SELECT 1"));
+    ASSERT_TRUE(fromTask.hasError());
+    EXPECT_EQ(fromTask.error().code(), ErrorCode::NotConnected);
+}
+
 // ===========================================================================
 // GameDatabase: disconnect when not connected (no-op)
 // ===========================================================================
@@ -220,6 +299,262 @@ TEST(GameDatabaseTest, DisconnectWhenNotConnected) {
     EXPECT_FALSE(db.isConnected());
 }
 
+TEST(GameDatabaseTest, MaintainPoolWhenNotConnected) {
+    GameDatabase db;
+    db.maintainPool();  // No-op
+    EXPECT_EQ(db.poolSize(), 0u);
+    const auto stats = db.connectionPoolStats();
+    EXPECT_EQ(stats.checkouts, 0u);
+    EXPECT_EQ(stats.opened, 0u);
+}
+
+// ===========================================================================
+// ConnectionPoolStats: histogram buckets
+// ===========================================================================
+
+TEST(ConnectionPoolStatsTest, WaitBuckets) {
+    using std::chrono::microseconds;
+    EXPECT_EQ(ConnectionPoolStats::waitBucket(microseconds(0)), 0u);
+    EXPECT_EQ(ConnectionPoolStats::waitBucket(microseconds(10)), 0u);
+    EXPECT_EQ(ConnectionPoolStats::waitBucket(microseconds(11)), 1u);
+    EXPECT_EQ(ConnectionPoolStats::waitBucket(microseconds(4'000)), 3u);
+    EXPECT_EQ(ConnectionPoolStats::waitBucket(microseconds(2'000'000)),
+              ConnectionPoolStats::kWaitBuckets - 1);
+}
+
+TEST(ConnectionPoolStatsTest, UtilizationBuckets) {
+    EXPECT_EQ(ConnectionPoolStats::utilizationBucket(1, 10), 1u);
+    EXPECT_EQ(ConnectionPoolStats::utilizationBucket(5, 20), 2u);
+    EXPECT_EQ(ConnectionPoolStats::utilizationBucket(10, 10), 9u);
+    EXPECT_EQ(ConnectionPoolStats::utilizationBucket(0, 8), 0u);
+    EXPECT_EQ(ConnectionPoolStats::utilizationBucket(1, 0), 9u);
+}
+
+TEST(ConnectionPoolStatsTest, SumAddsCountsAndKeepsMaxWait) {
+    ConnectionPoolStats a;
+    a.checkouts = 3;
+    a.waitBuckets[1] = 3;
+    a.maxWait = std::chrono::microseconds(50);
+    a.opened = 2;
+    ConnectionPoolStats b;
+    b.checkouts = 1;
+    b.waitBuckets[1] = 1;
+    b.maxWait = std::chrono::microseconds(20);
+    b.idleClosed = 1;
+
+    a += b;
+    EXPECT_EQ(a.checkouts, 4u);
+    EXPECT_EQ(a.waitBuckets[1], 4u);
+    EXPECT_EQ(a.maxWait.count(), 50);
+    EXPECT_EQ(a.opened, 2u);
+    EXPECT_EQ(a.idleClosed, 1u);
+}
+
+// ===========================================================================
+// AsyncQueryQueue: bounded, deadline-aware, cancellable, batched
+// ===========================================================================
+
+namespace {
+
+using TestQueue = AsyncQueryQueue<GameResult<QueryResult>>;
+
+/// Batch runner that blocks until released, recording batch sizes.
+struct GatedRunner {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool open = false;
+    std::vector<std::size_t> batchSizes;
+
+    void run(std::vector<TestQueue::Entry>& batch) {
+        std::unique_lock lock(mutex);
+        cv.wait(lock, [this] { return open; });
+        batchSizes.push_back(batch.size());
+        lock.unlock();
+        for (auto& entry : batch) {
+            entry.onDone(GameResult<QueryResult>::ok(QueryResult{}));
+        }
+    }
+
+    void release() {
+        {
+            std::lock_guard lock(mutex);
+            open = true;
+        }
+        cv.notify_all();
+    }
+};
+
+AsyncQueryOptions oneWorker(std::size_t capacity, std::size_t depth) {
+    AsyncQueryOptions options;
+    options.workers = 1;
+    options.capacity = capacity;
+    options.pipelineDepth = depth;
+    return options;
+}
+
+/// Occupy the single worker with one query, returning once it is taken.
+void occupyWorker(TestQueue& queue) {
+    (void)queue.submit("SELECT 0", [](GameResult<QueryResult>) {});
+    while (queue.stats().executed == 0) {
+        std::this_thread::yield();
+    }
+}
+
+}  // namespace
+
+TEST(AsyncQueryQueueTest, RejectsBeyondCapacity) {
+    GatedRunner runner;
+    {
+        TestQueue queue(oneWorker(2, 8), [&](auto& batch) { runner.run(batch); });
+        occupyWorker(queue);
+
+        EXPECT_TRUE(queue.submit("SELECT 1", [](GameResult<QueryResult>) {}).valid());
+        EXPECT_TRUE(queue.submit("SELECT 2", [](GameResult<QueryResult>) {}).valid());
+
+        std::optional<ErrorCode> code;
+        auto handle = queue.submit("SELECT 3", [&](GameResult<QueryResult> result) {
+            code = result.error().code();
+        });
+        EXPECT_FALSE(handle.valid());
+        EXPECT_EQ(code, ErrorCode::ConnectionPoolExhausted);  // Inline
+
+        auto stats = queue.stats();
+        EXPECT_EQ(stats.queued, 2u);
+        EXPECT_EQ(stats.rejected, 1u);
+        runner.release();
+    }
+    EXPECT_EQ(runner.batchSizes, (std::vector<std::size_t>{1, 2}));
+}
+
+TEST(AsyncQueryQueueTest, BatchesUpToPipelineDepth) {
+    GatedRunner runner;
+    std::atomic<int> done{0};
+    {
+        TestQueue queue(oneWorker(0, 3), [&](auto& batch) { runner.run(batch); });
+        occupyWorker(queue);
+        for (int i = 0; i < 5; ++i) {
+            (void)queue.submit("SELECT 1", [&](GameResult<QueryResult> result) {
+                EXPECT_TRUE(result.hasValue());
+                ++done;
+            });
+        }
+        runner.release();
+    }
+    EXPECT_EQ(done.load(), 5);
+    EXPECT_EQ(runner.batchSizes, (std::vector<std::size_t>{1, 3, 2}));
+}
+
+TEST(AsyncQueryQueueTest, ExpiresQueriesPastTheirDeadline) {
+    GatedRunner runner;
+    std::optional<ErrorCode> code;
+    AsyncQueryStats stats;
+    {
+        TestQueue queue(oneWorker(0, 8), [&](auto& batch) { runner.run(batch); });
+        occupyWorker(queue);
+        (void)queue.submit(
+            "SELECT 1", [&](GameResult<QueryResult> result) { code = result.error().code(); },
+            std::chrono::milliseconds(1));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        runner.release();
+        while (queue.stats().expired == 0) {
+            std::this_thread::yield();
+        }
+        stats = queue.stats();
+    }
+    EXPECT_EQ(code, ErrorCode::ConnectionPoolTimeout);
+    EXPECT_EQ(stats.expired, 1u);
+    EXPECT_EQ(stats.executed, 1u);  // Only the query that held the worker
+    EXPECT_GE(stats.maxWait, std::chrono::milliseconds(1));
+}
+
+TEST(AsyncQueryQueueTest, CancelWithdrawsQueuedQuery) {
+    GatedRunner runner;
+    std::optional<ErrorCode> code;
+    {
+        TestQueue queue(oneWorker(0, 8), [&](auto& batch) { runner.run(batch); });
+        occupyWorker(queue);
+        auto handle = queue.submit("SELECT 1", [&](GameResult<QueryResult> result) {
+            code = result.hasError() ? std::optional(result.error().code()) : std::nullopt;
+        });
+        ASSERT_TRUE(handle.valid());
+        EXPECT_TRUE(handle.cancel());
+        EXPECT_EQ(code, ErrorCode::QueryCancelled);  // On the cancelling thread
+        EXPECT_FALSE(handle.cancel());               // Already gone
+
+        auto stats = queue.stats();
+        EXPECT_EQ(stats.cancelled, 1u);
+        EXPECT_EQ(stats.queued, 0u);
+        runner.release();
+    }
+    EXPECT_EQ(runner.batchSizes, (std::vector<std::size_t>{1}));
+    EXPECT_FALSE(QueryHandle{}.cancel());
+}
+
+TEST(GameDatabaseTest, AsyncQueryStatsWhenNotConnected) {
+    GameDatabase db;
+    auto handle = db.queryAsync("SELECT 1", [](GameResult<QueryResult>) {});
+    EXPECT_FALSE(handle.valid());
+    EXPECT_EQ(db.asyncQueryStats().submitted, 0u);
+}
+
+// ===========================================================================
+// BatchWriter: statement generation
+// ===========================================================================
+
+TEST(BatchWriterTest, MultiRowInsertChunkedByRowsPerStatement) {
+    BatchWriter batch("quest_entries", {"player_id", "quest_id", "note"});
+    batch.setRowsPerStatement(2);
+    EXPECT_TRUE(batch.addRow({std::int64_t{1}, std::int64_t{10}, std::string("it's")}).hasValue());
+    EXPECT_TRUE(batch.addRow({std::int64_t{1}, std::int64_t{11}, DbNull{}}).hasValue());
+    EXPECT_TRUE(batch.addRow({std::int64_t{2}, std::int64_t{10}, 1.5}).hasValue());
+    EXPECT_TRUE(batch.addRow({std::int64_t{2}}).hasError());
+    EXPECT_EQ(batch.rowCount(), 3u);
+
+    auto statements = batch.statements(DatabaseType::PostgreSQL);
+    ASSERT_EQ(statements.size(), 2u);
+    EXPECT_EQ(statements[0],
+              "INSERT INTO quest_entries (player_id, quest_id, note) VALUES "
+              "(1, 10, 'it''s'), (1, 11, NULL)");
+    EXPECT_EQ(statements[1],
+              "INSERT INTO quest_entries (player_id, quest_id, note) VALUES (2, 10, 1.5)");
+
+    // SQLite loops one row per statement.
+    EXPECT_EQ(batch.statements(DatabaseType::SQLite).size(), 3u);
+
+    batch.clear();
+    EXPECT_TRUE(batch.empty());
+    EXPECT_TRUE(batch.statements(DatabaseType::PostgreSQL).empty());
+}
+
+TEST(BatchWriterTest, UpsertKeepsLastRowPerKey) {
+    BatchWriter batch("inventory_slots", {"player_id", "slot", "item_id", "count"});
+    batch.upsert({"player_id", "slot"});
+    (void)batch.addRow({std::int64_t{7}, std::int64_t{0}, std::int64_t{100}, std::int64_t{1}});
+    (void)batch.addRow({std::int64_t{7}, std::int64_t{1}, std::int64_t{200}, std::int64_t{5}});
+    (void)batch.addRow({std::int64_t{7}, std::int64_t{0}, std::int64_t{300}, std::int64_t{2}});
+
+    auto statements = batch.statements(DatabaseType::PostgreSQL);
+    ASSERT_EQ(statements.size(), 1u);
+    EXPECT_EQ(statements[0],
+              "INSERT INTO inventory_slots (player_id, slot, item_id, count) VALUES "
+              "(7, 0, 300, 2), (7, 1, 200, 5) ON CONFLICT (player_id, slot) "
+              "DO UPDATE SET item_id = EXCLUDED.item_id, count = EXCLUDED.count");
+
+    batch.ignoreConflicts({"player_id", "slot"});
+    EXPECT_EQ(batch.statements(DatabaseType::SQLite).back(),
+              "INSERT INTO inventory_slots (player_id, slot, item_id, count) VALUES "
+              "(7, 1, 200, 5) ON CONFLICT (player_id, slot) DO NOTHING");
+}
+
+TEST(GameDatabaseTest, WriteWhenNotConnected) {
+    GameDatabase db;
+    BatchWriter batch("players", {"id"});
+    (void)batch.addRow({std::int64_t{1}});
+    auto result = db.write(batch);
+    ASSERT_TRUE(result.hasError());
+    EXPECT_EQ(result.error().code(), ErrorCode::NotConnected);
+}
+
 // ===========================================================================
 // Transaction: inactive operations
 // ===========================================================================
@@ -263,6 +598,99 @@ TEST(DbValueTest, BoolType) {
     EXPECT_TRUE(std::get<bool>(val));
 }
 
+// ===========================================================================
+// QueryResult: columnar storage and row views
+// ===========================================================================
+
+TEST(QueryResultTest, TypedColumnsAndRowViews) {
+    QueryResult result({"id", "name", "score", "active"});
+    for (std::int64_t i = 0; i < 3; ++i) {
+        const auto row = result.addRow();
+        result.set(row, 0, i);
+        result.set(row, 1, "player_" + std::to_string(i));
+        result.set(row, 2, 1.5 * static_cast<double>(i));
+        result.set(row, 3, i % 2 == 0);
+    }
+
+    ASSERT_EQ(result.size(), 3u);
+    EXPECT_EQ(result.columnCount(), 4u);
+    EXPECT_EQ(result.columnIndex("score"), 2u);
+    EXPECT_EQ(result.columnIndex("missing"), QueryResult::npos);
+
+    auto row = result[2];
+    EXPECT_EQ(row.getInt("id"), 2);
+    EXPECT_EQ(row.getString("name"), "player_2");
+    EXPECT_EQ(row.getDouble("score"), 3.0);
+    EXPECT_EQ(row.getBool("active"), true);
+    EXPECT_EQ(row.getInt("name"), std::nullopt);  // Wrong type
+    EXPECT_EQ(std::get<std::string>(row.at("name")), "player_2");
+    EXPECT_THROW((void)row.at("missing"), std::out_of_range);
+    EXPECT_TRUE(std::holds_alternative<DbNull>(row["missing"]));
+
+    std::int64_t sum = 0;
+    for (auto view : result) {
+        sum += view.getInt("id").value_or(0);
+    }
+    EXPECT_EQ(sum, 3);
+}
+
+TEST(QueryResultTest, PushBackRowAddsColumnsAndNulls) {
+    QueryResult result;
+    DbRow first;
+    first["id"] = std::int64_t{1};
+    result.push_back(first);
+    DbRow second;
+    second["guild"] = std::string("Knights");
+    result.push_back(second);
+
+    ASSERT_EQ(result.size(), 2u);
+    EXPECT_EQ(result.columnCount(), 2u);
+    EXPECT_TRUE(result[0].isNull("guild"));
+    EXPECT_TRUE(result[1].isNull("id"));
+    EXPECT_EQ(result[1].getString("guild"), "Knights");
+
+    auto materialized = result[0].toRow();
+    EXPECT_EQ(materialized.size(), 2u);
+    EXPECT_EQ(std::get<std::int64_t>(materialized.at("id")), 1);
+    EXPECT_TRUE(std::holds_alternative<DbNull>(materialized.at("guild")));
+}
+
+TEST(QueryResultTest, CopiesShareUntilModified) {
+    QueryResult original({"name"});
+    original.set(original.addRow(), 0, "Alice");
+
+    QueryResult copy = original;
+    EXPECT_EQ(copy[0].getString("name")->data(), original[0].getString("name")->data());
+
+    copy.set(0, 0, "Bob");
+    EXPECT_EQ(original[0].getString("name"), "Alice");
+    EXPECT_EQ(copy[0].getString("name"), "Bob");
+}
+
+TEST(QueryResultTest, MemoryBytesTracksCellsAndArena) {
+    QueryResult result({"id", "name"});
+    const auto empty = result.memoryBytes();
+    EXPECT_GT(empty, 0u);
+
+    for (std::int64_t i = 0; i < 100; ++i) {
+        const auto row = result.addRow();
+        result.set(row, 0, i);
+        result.set(row, 1, std::string(64, 'x'));
+    }
+    // Two 16-byte cells per row plus the long strings in the arena.
+    EXPECT_GE(result.memoryBytes(), empty + 100 * (2 * 16 + 64));
+
+    QueryResult copy = result;
+    EXPECT_EQ(copy.memoryBytes(), result.memoryBytes());
+}
+
+TEST(QueryResultTest, EmptyResult) {
+    QueryResult result;
+    EXPECT_TRUE(result.empty());
+    EXPECT_EQ(result.columnCount(), 0u);
+    EXPECT_EQ(result.begin(), result.end());
+}
+
 // ===========================================================================
 // Aggregate header test
 // ===========================================================================
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "cgs/foundation/interned_string.hpp"
+
+using namespace cgs::foundation;
+
+// ===========================================================================
+// StringInterner
+// ===========================================================================
+
+TEST(StringInternerTest, EqualTextSharesOneId) {
+    StringInterner table;
+    EXPECT_EQ(table.intern(""), StringInterner::kEmptyId);
+    const uint32_t a = table.intern("Stormwind");
+    const uint32_t b = table.intern(std::string("Storm") + "wind");
+    const uint32_t c = table.intern("Orgrimmar");
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a, c);
+    EXPECT_EQ(table.size(), 3u);  // Empty string, Stormwind, Orgrimmar
+
+    EXPECT_EQ(table.view(a), "Stormwind");
+    EXPECT_EQ(table.view(a).data()[9], '\0');
+    EXPECT_EQ(table.find("Orgrimmar"), c);
+    EXPECT_FALSE(table.find("Ironforge").has_value());
+    EXPECT_TRUE(table.view(999).empty());
+}
+
+TEST(StringInternerTest, ViewsStayValidAsTheArenaGrows) {
+    StringInterner table;
+    const uint32_t first = table.intern("first");
+    const char* text = table.view(first).data();
+    for (int i = 0; i < 20000; ++i) {
+        (void)table.intern("name-" + std::to_string(i));
+    }
+    const std::string longName(100000, 'x');  // Own block, not a chunk
+    EXPECT_EQ(table.view(table.intern(longName)), longName);
+
+    EXPECT_EQ(table.view(first).data(), text);
+    EXPECT_EQ(table.view(first), "first");
+    EXPECT_EQ(table.view(table.intern("name-12345")), "name-12345");
+    EXPECT_GE(table.arenaBytes(), longName.size());
+}
+
+TEST(StringInternerTest, ConcurrentInterningAgreesOnIds) {
+    StringInterner table;
+    constexpr int kThreads = 4;
+    constexpr int kNames = 2000;
+    std::vector<std::vector<uint32_t>> ids(kThreads, std::vector<uint32_t>(kNames));
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < kNames; ++i) {
+                const int n = (i + t * 7) % kNames;  // Different orders
+                ids[static_cast<std::size_t>(t)][static_cast<std::size_t>(n)] =
+                    table.intern("player-" + std::to_string(n));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (int t = 1; t < kThreads; ++t) {
+        EXPECT_EQ(ids[static_cast<std::size_t>(t)], ids[0]);
+    }
+    EXPECT_EQ(table.size(), std::size_t{kNames} + 1);
+    EXPECT_EQ(table.view(ids[0][42]), "player-42");
+}
+
+// ===========================================================================
+// InternedString
+// ===========================================================================
+
+TEST(InternedStringTest, StandsInForAStringField) {
+    InternedString empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.id(), StringInterner::kEmptyId);
+    EXPECT_STREQ(empty.c_str(), "");
+    EXPECT_EQ(empty, "");
+
+    InternedString name = "Thrall";
+    const std::string text = "Thrall";
+    EXPECT_EQ(name, text);
+    EXPECT_EQ(name, std::string_view("Thrall"));
+    EXPECT_NE(name, "Jaina");
+    EXPECT_EQ(name, InternedString(text));  // Same id
+    EXPECT_EQ(name.size(), 6u);
+    EXPECT_STREQ(name.c_str(), "Thrall");
+    EXPECT_EQ(name.str(), text);
+
+    std::string_view view = name;
+    EXPECT_EQ(view, "Thrall");
+    EXPECT_EQ(InternedString::fromId(name.id()), name);
+    EXPECT_EQ(sizeof(InternedString), sizeof(uint32_t));
+}
+
+TEST(InternedStringTest, HashesById) {
+    std::unordered_set<InternedString> names;
+    names.insert("game");
+    names.insert("lobby");
+    names.insert(std::string("game"));
+    EXPECT_EQ(names.size(), 2u);
+    EXPECT_TRUE(names.contains("lobby"));
+}
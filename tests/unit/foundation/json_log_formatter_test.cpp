@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <regex>
 #include <set>
 #include <string>
@@ -139,6 +140,13 @@ TEST(JsonLogFormatterTest, TimestampIsIso8601) {
         << "Timestamp not in ISO 8601 format: " << json;
 }
 
+TEST(JsonLogFormatterTest, ExplicitTimestampIsUsed) {
+    const std::chrono::system_clock::time_point at{std::chrono::milliseconds(1500)};
+    auto json = JsonLogFormatter::format(LogLevel::Info, LogCategory::Core, "late", {}, at);
+    EXPECT_NE(json.find("\"timestamp\":\"1970-01-01T00:00:01.500Z\""), std::string::npos)
+        << json;
+}
+
 TEST(JsonLogFormatterTest, IncludesContextFields) {
     LogContext ctx;
     ctx.entityId = EntityId(100);
@@ -435,6 +443,25 @@ TEST_F(GameLoggerJsonTest, JsonModeWithCorrelationScope) {
         << "Auto correlation ID missing: " << msg;
 }
 
+TEST_F(GameLoggerJsonTest, AsyncModeKeepsCallerCorrelationId) {
+    GameLogger logger;
+    logger.setCategoryLevel(LogCategory::Core, LogLevel::Info);
+    logger.setJsonMode(true);
+    logger.setAsyncMode(true);
+
+    {
+        CorrelationScope scope("corr-async");
+        logger.log(LogLevel::Info, LogCategory::Core, "Deferred log");
+    }
+    ASSERT_TRUE(logger.flush().hasValue());
+
+    auto records = mockLogger_->records();
+    ASSERT_EQ(records.size(), 1u);
+    const auto& msg = records[0].message;
+    EXPECT_NE(msg.find("\"correlation_id\":\"corr-async\""), std::string::npos) << msg;
+    EXPECT_NE(msg.find("\"message\":\"Deferred log\""), std::string::npos) << msg;
+}
+
 TEST_F(GameLoggerJsonTest, TextModeUnchangedWhenJsonOff) {
     GameLogger logger;
     logger.setCategoryLevel(LogCategory::Core, LogLevel::Info);
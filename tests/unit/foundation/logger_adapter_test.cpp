@@ -2,6 +2,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <cstdio>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -414,6 +415,25 @@ TEST_F(GameLoggerTest, MacroSkipsWhenDisabled) {
     EXPECT_TRUE(mockLogger_->records().empty());
 }
 
+TEST_F(GameLoggerTest, FormatMacroEvaluatesArgumentsOnlyWhenEnabled) {
+    GameLogger::instance().setCategoryLevel(LogCategory::Core, LogLevel::Info);
+    mockLogger_->reset();
+    int evaluations = 0;
+    auto describe = [&evaluations] {
+        ++evaluations;
+        return std::string("costly");
+    };
+
+    CGS_LOGF_DEBUG(LogCategory::Core, "skip {}", describe());
+    EXPECT_EQ(evaluations, 0);
+
+    CGS_LOGF_INFO(LogCategory::Core, "entity {} is {}", 42, describe());
+    EXPECT_EQ(evaluations, 1);
+    auto records = mockLogger_->records();
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_EQ(records[0].message, "[Core] entity 42 is costly");
+}
+
 // ---------------------------------------------------------------------------
 // Thread safety: concurrent logging from multiple threads
 // ---------------------------------------------------------------------------
@@ -445,6 +465,235 @@ TEST_F(GameLoggerTest, ConcurrentLoggingIsSafe) {
     EXPECT_EQ(mockLogger_->logCount(), kThreads * kMessagesPerThread);
 }
 
+// ---------------------------------------------------------------------------
+// logf() formatting
+// ---------------------------------------------------------------------------
+
+TEST_F(GameLoggerTest, LogfReplacesPlaceholdersInOrder) {
+    GameLogger logger;
+    logger.setCategoryLevel(LogCategory::Combat, LogLevel::Debug);
+    const std::string target = "tank";
+    logger.logf(LogLevel::Info, LogCategory::Combat, "hit {} for {} ({}x) {{crit}} {} {}", target,
+                -40, 1.5, true, 'A');
+    logger.logf(LogLevel::Info, LogCategory::Combat, "{} of {}", 3u);
+    logger.logf(LogLevel::Trace, LogCategory::Combat, "filtered {}", 1);
+
+    auto records = mockLogger_->records();
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(records[0].message, "[Combat] hit tank for -40 (1.5x) {crit} true A");
+    EXPECT_EQ(records[1].message, "[Combat] 3 of {}");
+}
+
+// ---------------------------------------------------------------------------
+// Rate limiting and sampling
+// ---------------------------------------------------------------------------
+
+TEST_F(GameLoggerTest, RateLimitIsOffByDefault) {
+    GameLogger logger;
+    for (std::size_t i = 0; i < kLogCategoryCount; ++i) {
+        EXPECT_FALSE(logger.getCategoryRateLimit(static_cast<LogCategory>(i)).active());
+    }
+
+    LogRateLimit limit;
+    limit.burst = 3;
+    limit.perSecond = 10;
+    logger.setCategoryRateLimit(LogCategory::Network, limit);
+    const auto stored = logger.getCategoryRateLimit(LogCategory::Network);
+    EXPECT_EQ(stored.burst, 3u);
+    EXPECT_EQ(stored.perSecond, 10u);
+    EXPECT_TRUE(stored.active());
+}
+
+TEST_F(GameLoggerTest, TokenBucketSuppressesFloodAndSummarizes) {
+    GameLogger logger;
+    LogRateLimit limit;
+    limit.burst = 5;
+    limit.perSecond = 1;
+    limit.summaryInterval = std::chrono::milliseconds(50);
+    logger.setCategoryRateLimit(LogCategory::Network, limit);
+
+    for (int i = 0; i < 100; ++i) {
+        logger.log(LogLevel::Warning, LogCategory::Network, "bad packet");
+    }
+    EXPECT_EQ(mockLogger_->logCount(), 5u);
+    EXPECT_EQ(logger.suppressedCount(LogCategory::Network), 95u);
+
+    // Other categories are not limited.
+    logger.log(LogLevel::Warning, LogCategory::Core, "unrelated");
+    EXPECT_EQ(mockLogger_->logCount(), 6u);
+
+    // The next call past the interval reports the suppressed calls.
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    logger.log(LogLevel::Warning, LogCategory::Network, "bad packet");
+    auto records = mockLogger_->records();
+    ASSERT_EQ(records.size(), 7u);
+    EXPECT_EQ(records[6].message, "[Network] suppressed 96 messages");
+
+    logger.setCategoryRateLimit(LogCategory::Network, {});
+    logger.log(LogLevel::Warning, LogCategory::Network, "bad packet");
+    EXPECT_EQ(mockLogger_->logCount(), 8u);
+}
+
+TEST_F(GameLoggerTest, SamplingKeepsOneCallInN) {
+    GameLogger logger;
+    LogRateLimit limit;
+    limit.sampleEvery = 10;
+    logger.setCategoryRateLimit(LogCategory::Combat, limit);
+
+    for (int i = 0; i < 100; ++i) {
+        logger.logf(LogLevel::Info, LogCategory::Combat, "hit {}", i);
+    }
+    auto records = mockLogger_->records();
+    ASSERT_EQ(records.size(), 10u);
+    EXPECT_EQ(records[0].message, "[Combat] hit 0");
+    EXPECT_EQ(records[1].message, "[Combat] hit 10");
+    EXPECT_EQ(logger.suppressedCount(LogCategory::Combat), 90u);
+}
+
+TEST_F(GameLoggerTest, MacroCallSitesAreLimitedSeparately) {
+    auto& logger = GameLogger::instance();
+    logger.setCategoryLevel(LogCategory::Network, LogLevel::Info);
+    LogRateLimit limit;
+    limit.burst = 2;
+    limit.perSecond = 1;
+    limit.summaryInterval = std::chrono::milliseconds(0);
+    logger.setCategoryRateLimit(LogCategory::Network, limit);
+    mockLogger_->reset();
+
+    for (int i = 0; i < 10; ++i) {
+        CGS_LOG_WARN(LogCategory::Network, "first site");
+        CGS_LOGF_WARN(LogCategory::Network, "second site {}", i);
+    }
+    logger.setCategoryRateLimit(LogCategory::Network, {});
+
+    std::size_t first = 0;
+    std::size_t second = 0;
+    std::size_t summaries = 0;
+    for (const auto& r : mockLogger_->records()) {
+        first += r.message == "[Network] first site" ? 1u : 0u;
+        second += r.message.rfind("[Network] second site", 0) == 0 ? 1u : 0u;
+        if (r.message.rfind("[Network] suppressed ", 0) == 0) {
+            ++summaries;
+            EXPECT_NE(r.message.find("logger_adapter_test.cpp:"), std::string::npos) << r.message;
+        }
+    }
+    EXPECT_EQ(first, 2u);
+    EXPECT_EQ(second, 2u);
+    EXPECT_GT(summaries, 0u);
+}
+
+// ---------------------------------------------------------------------------
+// Async mode
+// ---------------------------------------------------------------------------
+
+TEST_F(GameLoggerTest, AsyncModeWritesOnTheWriterThread) {
+    GameLogger logger;
+    logger.setCategoryLevel(LogCategory::Core, LogLevel::Info);
+    EXPECT_FALSE(logger.isAsyncMode());
+    logger.setAsyncMode(true);
+    EXPECT_TRUE(logger.isAsyncMode());
+
+    LogContext ctx;
+    ctx.playerId = PlayerId(7);
+    ctx.extra["zone"] = "north";
+    const std::string longMessage(500, 'x');
+
+    logger.log(LogLevel::Info, LogCategory::Core, "plain");
+    logger.logf(LogLevel::Warning, LogCategory::Core, "tick {} took {}ms", 12u, 3.25);
+    logger.logWithContext(LogLevel::Error, LogCategory::Core, "ctx", ctx);
+    logger.log(LogLevel::Info, LogCategory::Core, longMessage);
+    logger.log(LogLevel::Debug, LogCategory::Core, "filtered");
+    ASSERT_TRUE(logger.flush().hasValue());
+    EXPECT_TRUE(mockLogger_->wasFlushed());
+
+    auto records = mockLogger_->records();
+    ASSERT_EQ(records.size(), 4u);
+    EXPECT_EQ(records[0].message, "[Core] plain");
+    EXPECT_EQ(records[1].level, log_level::warning);
+    EXPECT_EQ(records[1].message, "[Core] tick 12 took 3.25ms");
+    EXPECT_EQ(records[2].message, "[Core] ctx {player_id=7, zone=north}");
+    EXPECT_EQ(records[3].message, "[Core] " + longMessage);
+
+    const auto stats = logger.asyncStats();
+    EXPECT_EQ(stats.enqueued, 4u);
+    EXPECT_EQ(stats.written, 4u);
+    EXPECT_EQ(stats.spilled, 1u);
+    EXPECT_EQ(stats.dropped, 0u);
+
+    logger.setAsyncMode(false);
+    EXPECT_FALSE(logger.isAsyncMode());
+    logger.log(LogLevel::Info, LogCategory::Core, "sync again");
+    EXPECT_EQ(mockLogger_->logCount(), 5u);
+    EXPECT_EQ(logger.asyncStats().enqueued, 4u);
+}
+
+TEST_F(GameLoggerTest, AsyncBlockPolicyLosesNothingAndKeepsThreadOrder) {
+    GameLogger logger;
+    logger.setCategoryLevel(LogCategory::Core, LogLevel::Info);
+    AsyncLogConfig config;
+    config.ringCapacity = 16;
+    config.overflow = LogOverflowPolicy::Block;
+    logger.setAsyncMode(true, config);
+
+    constexpr int kThreads = 4;
+    constexpr int kMessagesPerThread = 2000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&logger, t] {
+            for (int i = 0; i < kMessagesPerThread; ++i) {
+                logger.logf(LogLevel::Info, LogCategory::Core, "{} {}", t, i);
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    ASSERT_TRUE(logger.flush().hasValue());
+
+    auto records = mockLogger_->records();
+    ASSERT_EQ(records.size(), static_cast<std::size_t>(kThreads * kMessagesPerThread));
+    std::vector<int> next(kThreads, 0);
+    for (const auto& record : records) {
+        int t = 0;
+        int i = 0;
+        ASSERT_EQ(std::sscanf(record.message.c_str(), "[Core] %d %d", &t, &i), 2);
+        EXPECT_EQ(i, next[static_cast<std::size_t>(t)]++);
+    }
+    EXPECT_EQ(logger.asyncStats().dropped, 0u);
+}
+
+TEST_F(GameLoggerTest, AsyncDropAndSamplePoliciesCountLostRecords) {
+    constexpr uint64_t kOffered = 200;
+    for (auto policy : {LogOverflowPolicy::Drop, LogOverflowPolicy::Sample}) {
+        mockLogger_->reset();
+        GameLogger logger;
+        logger.setCategoryLevel(LogCategory::Core, LogLevel::Info);
+        AsyncLogConfig config;
+        config.ringCapacity = 16;
+        config.overflow = policy;
+        config.sampleRate = 4;
+        config.idleWait = std::chrono::seconds(10);  // The writer stays asleep
+        logger.setAsyncMode(true, config);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+        for (uint64_t i = 0; i < kOffered; ++i) {
+            logger.log(LogLevel::Info, LogCategory::Core, "burst");
+        }
+        const auto stats = logger.asyncStats();
+        EXPECT_EQ(stats.enqueued + stats.dropped + stats.sampledOut, kOffered);
+        EXPECT_LE(stats.enqueued, 16u);
+        if (policy == LogOverflowPolicy::Drop) {
+            EXPECT_GT(stats.dropped, 0u);
+            EXPECT_EQ(stats.sampledOut, 0u);
+        } else {
+            EXPECT_GT(stats.sampledOut, 0u);
+        }
+
+        ASSERT_TRUE(logger.flush().hasValue());
+        EXPECT_EQ(mockLogger_->logCount(), stats.enqueued);
+    }
+}
+
 // ---------------------------------------------------------------------------
 // Throughput benchmark (informational, not a strict pass/fail)
 // ---------------------------------------------------------------------------
@@ -0,0 +1,35 @@
+#include <gtest/gtest.h>
+
+// Compile this file as a release build with CGS_STRIP_DEBUG_LOGS would.
+#undef CGS_MIN_LOG_LEVEL
+#define CGS_MIN_LOG_LEVEL 2
+
+#include "cgs/foundation/game_logger.hpp"
+
+using namespace cgs::foundation;
+
+// ---------------------------------------------------------------------------
+// Compile-time stripping (CGS_MIN_LOG_LEVEL)
+// ---------------------------------------------------------------------------
+
+TEST(GameLoggerStripTest, MacrosBelowMinLevelAreCompiledOut) {
+    GameLogger::instance().setCategoryLevel(LogCategory::AI, LogLevel::Trace);
+    int evaluations = 0;
+    auto touch = [&evaluations] {
+        ++evaluations;
+        return evaluations;
+    };
+
+    // Enabled at runtime, but stripped at compile time.
+    CGS_LOG_TRACE(LogCategory::AI, std::to_string(touch()));
+    CGS_LOG_DEBUG(LogCategory::AI, std::to_string(touch()));
+    CGS_LOGF_TRACE(LogCategory::AI, "{}", touch());
+    CGS_LOGF_DEBUG(LogCategory::AI, "{}", touch());
+    EXPECT_EQ(evaluations, 0);
+
+    CGS_LOG_INFO(LogCategory::AI, std::to_string(touch()));
+    CGS_LOGF_WARN(LogCategory::AI, "{}", touch());
+    EXPECT_EQ(evaluations, 2);
+
+    GameLogger::instance().setCategoryLevel(LogCategory::AI, LogLevel::Debug);
+}
@@ -1,5 +1,11 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <span>
 #include <string>
 #include <thread>
 #include <vector>
@@ -66,6 +72,143 @@ TEST_F(GameMetricsTest, CounterMultipleNames) {
     EXPECT_EQ(metrics_.counterValue("counter_b"), 2u);
 }
 
+// ===========================================================================
+// Metric handles: pre-registered counters and gauges
+// ===========================================================================
+
+TEST_F(GameMetricsTest, CounterHandleSharesTheNamedCounter) {
+    metrics_.incrementCounter("cgs_messages_total", 2);
+    auto handle = metrics_.registerCounter("cgs_messages_total");
+    ASSERT_TRUE(handle.valid());
+    handle.increment();
+    handle.increment(4);
+    EXPECT_EQ(handle.value(), 7u);
+    EXPECT_EQ(metrics_.counterValue("cgs_messages_total"), 7u);
+    EXPECT_NE(metrics_.scrape().find("cgs_messages_total 7"), std::string::npos);
+
+    CounterHandle none;
+    EXPECT_FALSE(none.valid());
+    none.increment();
+    EXPECT_EQ(none.value(), 0u);
+}
+
+TEST_F(GameMetricsTest, CounterHandleSumsConcurrentShards) {
+    auto handle = metrics_.registerCounter("cgs_damage_events_total");
+    constexpr int kThreads = 8;
+    constexpr int kIncrements = 20000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([handle] {
+            for (int i = 0; i < kIncrements; ++i) {
+                handle.increment();
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    EXPECT_EQ(metrics_.counterValue("cgs_damage_events_total"),
+              static_cast<uint64_t>(kThreads) * kIncrements);
+}
+
+TEST_F(GameMetricsTest, GaugeHandleUpdatesTheNamedGauge) {
+    auto handle = metrics_.registerGauge("cgs_ccu");
+    handle.set(10.0);
+    handle.increment(2.5);
+    handle.decrement();
+    EXPECT_DOUBLE_EQ(handle.value(), 11.5);
+    EXPECT_DOUBLE_EQ(metrics_.gaugeValue("cgs_ccu"), 11.5);
+    metrics_.setGauge("cgs_ccu", 3.0);
+    EXPECT_DOUBLE_EQ(handle.value(), 3.0);
+}
+
+TEST_F(GameMetricsTest, ResetZeroesRegisteredMetricsAndKeepsHandles) {
+    auto counter = metrics_.registerCounter("cgs_registered_total");
+    auto gauge = metrics_.registerGauge("cgs_registered_gauge");
+    counter.increment(5);
+    gauge.set(4.0);
+    metrics_.incrementCounter("cgs_adhoc_total");
+
+    metrics_.reset();
+    EXPECT_EQ(counter.value(), 0u);
+    EXPECT_DOUBLE_EQ(gauge.value(), 0.0);
+    const auto output = metrics_.scrape();
+    EXPECT_NE(output.find("cgs_registered_total 0"), std::string::npos);
+    EXPECT_EQ(output.find("cgs_adhoc_total"), std::string::npos);
+
+    counter.increment();
+    EXPECT_EQ(metrics_.counterValue("cgs_registered_total"), 1u);
+}
+
+// ===========================================================================
+// Labeled families: bound children and the series limit
+// ===========================================================================
+
+TEST_F(GameMetricsTest, CounterFamilyBindsEachLabelSetOnce) {
+    auto messages = metrics_.registerCounterFamily("cgs_messages_total", {"opcode"});
+    ASSERT_TRUE(messages.valid());
+    auto login = messages.bind("0x0101");
+    auto move = messages.bind(std::string("0x0202"));
+    login.increment(2);
+    messages.bind("0x0101").increment();
+    move.increment();
+    EXPECT_EQ(login.value(), 3u);
+    EXPECT_EQ(messages.size(), 2u);
+
+    const auto output = metrics_.scrape();
+    const std::string type = "# TYPE cgs_messages_total counter\n";
+    ASSERT_NE(output.find(type), std::string::npos);
+    EXPECT_EQ(output.find(type, output.find(type) + 1), std::string::npos);
+    EXPECT_NE(output.find("cgs_messages_total{opcode=\"0x0101\"} 3\n"), std::string::npos);
+    EXPECT_NE(output.find("cgs_messages_total{opcode=\"0x0202\"} 1\n"), std::string::npos);
+
+    // Registering again finds the same family; the wrong arity binds nothing.
+    auto again = metrics_.registerCounterFamily("cgs_messages_total", {"ignored", "keys"});
+    EXPECT_EQ(again.bind("0x0101").value(), 3u);
+    EXPECT_FALSE(again.bind("0x0101", "extra").valid());
+}
+
+TEST_F(GameMetricsTest, FamilyBeyondItsLimitSharesTheOverflowChild) {
+    auto sessions = metrics_.registerGaugeFamily("cgs_session_bytes", {"player"}, 2);
+    for (int player = 1; player <= 5; ++player) {
+        sessions.bind(std::to_string(player)).increment(10.0);
+    }
+    EXPECT_EQ(sessions.size(), 2u);
+    EXPECT_EQ(sessions.overflowed(), 3u);
+    EXPECT_DOUBLE_EQ(sessions.bind("9").value(), 30.0);  // Still overflowing
+    EXPECT_DOUBLE_EQ(sessions.bind("1").value(), 10.0);  // Bound before the limit
+
+    const auto output = metrics_.scrape();
+    EXPECT_NE(output.find("cgs_session_bytes{player=\"__overflow__\"} 30"), std::string::npos);
+    EXPECT_EQ(output.find("player=\"5\""), std::string::npos);
+}
+
+TEST_F(GameMetricsTest, HistogramFamilyScrapesLabeledSeries) {
+    auto latency = metrics_.registerHistogramFamily("cgs_handler_ms", {"handler", "zone"},
+                                                    HistogramBuckets{{10, 50}});
+    auto quoted = latency.bind("say \"hi\"", "1");
+    quoted.record(5.0);
+    latency.bind("move", "2").record(20.0);
+
+    const auto output = metrics_.scrape();
+    EXPECT_NE(
+        output.find(R"(cgs_handler_ms_bucket{handler="say \"hi\"",zone="1",le="10"} 1)"),
+        std::string::npos);
+    EXPECT_NE(output.find("cgs_handler_ms_bucket{handler=\"move\",zone=\"2\",le=\"10\"} 0"),
+              std::string::npos);
+    EXPECT_NE(output.find("cgs_handler_ms_count{handler=\"move\",zone=\"2\"} 1"),
+              std::string::npos);
+    EXPECT_NE(output.find(R"(cgs_handler_ms_quantile{handler="move",zone="2",quantile="0.5"})"),
+              std::string::npos);
+    EXPECT_EQ(output.find("# TYPE cgs_handler_ms histogram"),
+              output.rfind("# TYPE cgs_handler_ms histogram"));
+
+    metrics_.reset();
+    EXPECT_EQ(quoted.count(), 0u);
+    quoted.record(1.0);
+    EXPECT_EQ(latency.bind("say \"hi\"", "1").count(), 1u);
+}
+
 // ===========================================================================
 // Gauge: basic operations
 // ===========================================================================
@@ -203,6 +346,180 @@ TEST_F(GameMetricsTest, TraceSpanDurationMeasurable) {
               10);
 }
 
+// ===========================================================================
+// Tracing: sampling, propagation and export
+// ===========================================================================
+
+/// Collects exported batches for inspection.
+struct SpanSink {
+    std::mutex mutex;
+    std::vector<SpanRecord> spans;
+    std::size_t batches = 0;
+
+    SpanExporter exporter() {
+        return [this](std::span<const SpanRecord> batch) {
+            std::lock_guard lock(mutex);
+            spans.insert(spans.end(), batch.begin(), batch.end());
+            ++batches;
+        };
+    }
+};
+
+TEST_F(GameMetricsTest, TracingExportsSampledSpansWithParents) {
+    SpanSink sink;
+    metrics_.startTracing(TracingConfig{.sampleRatio = 1.0}, sink.exporter());
+    EXPECT_TRUE(metrics_.isTracing());
+
+    auto login = metrics_.startSpan("login");
+    EXPECT_TRUE(login.sampled);
+    EXPECT_EQ(login.parentId, 0u);
+
+    // The context crosses a service boundary as a traceparent header.
+    const auto header = login.context().traceparent();
+    const auto parsed = TraceContext::parseTraceparent(header);
+    ASSERT_TRUE(parsed.has_value());
+    EXPECT_EQ(*parsed, login.context());
+
+    auto query = metrics_.startSpan("db_query", *parsed);
+    EXPECT_EQ(query.traceIdLow, login.traceIdLow);
+    EXPECT_EQ(query.parentId, login.id);
+    query.error = true;
+    metrics_.endSpan(query);
+    metrics_.endSpan(login);
+    metrics_.endSpan(login);  // ending twice is a no-op
+    metrics_.stopTracing();
+    EXPECT_FALSE(metrics_.isTracing());
+
+    ASSERT_EQ(sink.spans.size(), 2u);
+    EXPECT_EQ(sink.spans[0].name, "db_query");
+    EXPECT_EQ(sink.spans[0].parentId, login.id);
+    EXPECT_TRUE(sink.spans[0].error);
+    EXPECT_EQ(sink.spans[1].context.spanId, login.id);
+    EXPECT_GT(sink.spans[1].duration.count(), 0);
+
+    const auto stats = metrics_.tracingStats();
+    EXPECT_EQ(stats.started, 2u);
+    EXPECT_EQ(stats.exported, 2u);
+    EXPECT_EQ(stats.dropped, 0u);
+
+    // Spans ended after stopTracing() are not collected.
+    auto late = metrics_.startSpan("late");
+    metrics_.endSpan(late);
+    EXPECT_EQ(sink.spans.size(), 2u);
+}
+
+TEST_F(GameMetricsTest, TailSamplingKeepsSlowAndFailedSpans) {
+    SpanSink sink;
+    metrics_.startTracing(
+        TracingConfig{.sampleRatio = 0.0, .tailLatency = std::chrono::milliseconds(20)},
+        sink.exporter());
+
+    auto fast = metrics_.startSpan("fast");
+    EXPECT_FALSE(fast.sampled);
+    metrics_.endSpan(fast);
+
+    auto slow = metrics_.startSpan("slow");
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    metrics_.endSpan(slow);
+
+    auto failed = metrics_.startSpan("failed");
+    failed.error = true;
+    metrics_.endSpan(failed);
+    metrics_.stopTracing();
+
+    ASSERT_EQ(sink.spans.size(), 2u);
+    EXPECT_EQ(sink.spans[0].name, "slow");
+    EXPECT_EQ(sink.spans[1].name, "failed");
+    const auto stats = metrics_.tracingStats();
+    EXPECT_EQ(stats.sampledOut, 1u);
+    EXPECT_EQ(stats.tailKept, 2u);
+}
+
+TEST_F(GameMetricsTest, TracingBatchesConcurrentSpans) {
+    SpanSink sink;
+    metrics_.startTracing(TracingConfig{.sampleRatio = 1.0, .queueCapacity = 1 << 16,
+                                        .batchSize = 64},
+                          sink.exporter());
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([this] {
+            for (int i = 0; i < 1000; ++i) {
+                auto span = metrics_.startSpan("work");
+                metrics_.endSpan(span);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    metrics_.stopTracing();
+
+    EXPECT_EQ(sink.spans.size(), 4000u);
+    EXPECT_GE(sink.batches, 4000u / 64);
+    EXPECT_EQ(metrics_.tracingStats().batches, sink.batches);
+}
+
+TEST_F(GameMetricsTest, HeadSamplingFollowsTheRatio) {
+    metrics_.startTracing(TracingConfig{.sampleRatio = 0.25}, nullptr);
+    int sampled = 0;
+    for (int i = 0; i < 4000; ++i) {
+        sampled += metrics_.startSpan("x").sampled ? 1 : 0;
+    }
+    metrics_.stopTracing();
+    EXPECT_NEAR(sampled, 1000, 150);
+
+    // Children follow their parent's decision, whatever the ratio.
+    TraceContext parent{1, 2, 3, 0};
+    metrics_.startTracing(TracingConfig{.sampleRatio = 1.0}, nullptr);
+    EXPECT_FALSE(metrics_.startSpan("child", parent).sampled);
+    parent.flags = TraceContext::kSampledFlag;
+    EXPECT_TRUE(metrics_.startSpan("child", parent).sampled);
+    metrics_.stopTracing();
+}
+
+TEST(TraceContextTest, EncodingsRoundTrip) {
+    const TraceContext context{0x0af7651916cd43ddULL, 0x8448eb211c80319cULL,
+                               0xb7ad6b7169203331ULL, TraceContext::kSampledFlag};
+    EXPECT_EQ(context.traceparent(), "00-0af7651916cd43dd8448eb211c80319c-b7ad6b7169203331-01");
+    EXPECT_EQ(TraceContext::parseTraceparent(context.traceparent()), context);
+
+    uint8_t bytes[TraceContext::kEncodedSize];
+    context.encode(bytes);
+    EXPECT_EQ(bytes[0], 0x0a);
+    EXPECT_EQ(TraceContext::decode(bytes), context);
+
+    EXPECT_FALSE(TraceContext{}.valid());
+    EXPECT_FALSE(TraceContext::parseTraceparent("").has_value());
+    EXPECT_FALSE(TraceContext::parseTraceparent(
+                     "00-00000000000000000000000000000000-b7ad6b7169203331-01")
+                     .has_value());
+    EXPECT_FALSE(TraceContext::parseTraceparent(
+                     "00-0af7651916cd43dd8448eb211c80319c-b7ad6b71692033XX-01")
+                     .has_value());
+}
+
+TEST(OtlpJsonTest, EncodesSpansForTheCollector) {
+    SpanRecord span;
+    span.context = TraceContext{1, 2, 3, TraceContext::kSampledFlag};
+    span.parentId = 4;
+    span.name = "login \"fast\"";
+    span.start = std::chrono::system_clock::time_point(std::chrono::seconds(1));
+    span.duration = std::chrono::milliseconds(2);
+    span.error = true;
+
+    const auto json = encodeOtlpJson(std::span(&span, 1), "auth");
+    EXPECT_NE(json.find(R"("key":"service.name","value":{"stringValue":"auth"})"),
+              std::string::npos);
+    EXPECT_NE(json.find(R"("traceId":"00000000000000010000000000000002")"), std::string::npos);
+    EXPECT_NE(json.find(R"("spanId":"0000000000000003")"), std::string::npos);
+    EXPECT_NE(json.find(R"("parentSpanId":"0000000000000004")"), std::string::npos);
+    EXPECT_NE(json.find(R"("name":"login \"fast\"")"), std::string::npos);
+    EXPECT_NE(json.find(R"("startTimeUnixNano":"1000000000")"), std::string::npos);
+    EXPECT_NE(json.find(R"("endTimeUnixNano":"1002000000")"), std::string::npos);
+    EXPECT_NE(json.find(R"("status":{"code":2})"), std::string::npos);
+    EXPECT_NE(encodeOtlpJson({}, "auth").find(R"("spans":[]}]}]})"), std::string::npos);
+}
+
 // ===========================================================================
 // HealthCheck: component status aggregation
 // ===========================================================================
@@ -286,6 +603,128 @@ TEST_F(GameMetricsTest, ScrapeHistogramFormat) {
     EXPECT_TRUE(output.find("cgs_latency_count 1") != std::string::npos);
 }
 
+TEST_F(GameMetricsTest, HistogramHandleQuantilesTrackTheDistribution) {
+    metrics_.registerHistogram("cgs_tick", HistogramBuckets::defaultDuration());
+    auto tick = metrics_.histogramHandle("cgs_tick");
+    ASSERT_TRUE(tick.valid());
+    EXPECT_DOUBLE_EQ(tick.quantile(0.5), 0.0);  // empty
+
+    // 1..1000: p50 = 500, p99 = 990, within the sketch's ~3%.
+    for (int i = 1; i <= 1000; ++i) {
+        tick.record(static_cast<double>(i));
+    }
+    EXPECT_EQ(tick.count(), 1000u);
+    EXPECT_NEAR(tick.quantile(0.5), 500.0, 15.0);
+    EXPECT_NEAR(tick.quantile(0.99), 990.0, 30.0);
+    EXPECT_NEAR(tick.quantile(0.0), 1.0, 0.05);
+    EXPECT_DOUBLE_EQ(tick.quantile(1.0), 1000.0);
+    EXPECT_DOUBLE_EQ(metrics_.histogramQuantile("cgs_tick", 0.5), tick.quantile(0.5));
+    EXPECT_DOUBLE_EQ(metrics_.histogramQuantile("cgs_missing", 0.5), 0.0);
+
+    // Handle and name-based recording feed the same histogram.
+    metrics_.recordHistogram("cgs_tick", std::nan(""));  // ignored
+    metrics_.recordHistogram("cgs_tick", 1.0);
+    EXPECT_EQ(tick.count(), 1001u);
+
+    auto output = metrics_.scrape();
+    EXPECT_TRUE(output.find("cgs_tick_bucket{le=\"50\"} 51") != std::string::npos);
+    EXPECT_TRUE(output.find("cgs_tick_count 1001") != std::string::npos);
+    EXPECT_TRUE(output.find("# TYPE cgs_tick_quantile gauge") != std::string::npos);
+    EXPECT_TRUE(output.find("cgs_tick_quantile{quantile=\"0.999\"}") != std::string::npos);
+
+    EXPECT_FALSE(metrics_.histogramHandle("cgs_missing").valid());
+    HistogramHandle none;
+    none.record(1.0);
+    EXPECT_EQ(none.count(), 0u);
+}
+
+TEST_F(GameMetricsTest, HistogramHandleMergesConcurrentShards) {
+    metrics_.registerHistogram("cgs_rtt", HistogramBuckets::defaultLatency());
+    auto rtt = metrics_.histogramHandle("cgs_rtt");
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([rtt, t] {
+            for (int i = 0; i < 10000; ++i) {
+                rtt.record(static_cast<double>(t + 1));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(rtt.count(), 80000u);
+    EXPECT_NEAR(rtt.quantile(0.5), 4.5, 0.5);
+    EXPECT_TRUE(metrics_.scrape().find("cgs_rtt_sum 360000") != std::string::npos);
+}
+
+TEST_F(GameMetricsTest, ResetKeepsHistogramsWithHandles) {
+    metrics_.registerHistogram("cgs_pinned", HistogramBuckets{{10}});
+    metrics_.registerHistogram("cgs_loose", HistogramBuckets{{10}});
+    auto pinned = metrics_.histogramHandle("cgs_pinned");
+    pinned.record(5.0);
+    metrics_.recordHistogram("cgs_loose", 5.0);
+
+    metrics_.reset();
+    EXPECT_EQ(pinned.count(), 0u);
+    pinned.record(20.0);
+    auto output = metrics_.scrape();
+    EXPECT_TRUE(output.find("cgs_pinned_bucket{le=\"10\"} 0") != std::string::npos);
+    EXPECT_TRUE(output.find("cgs_pinned_count 1") != std::string::npos);
+    EXPECT_EQ(output.find("cgs_loose"), std::string::npos);
+}
+
+TEST_F(GameMetricsTest, ScrapeFormatsShortestRoundTripValues) {
+    metrics_.setGauge("cgs_ratio", 0.1);
+    metrics_.setGauge("cgs_precise", 1234567.25);
+    metrics_.setGauge("cgs_inf", std::numeric_limits<double>::infinity());
+    metrics_.incrementCounter("cgs_big", 12345678901ULL);
+    auto output = metrics_.scrape();
+    EXPECT_TRUE(output.find("cgs_ratio 0.1\n") != std::string::npos);
+    EXPECT_TRUE(output.find("cgs_precise 1234567.25\n") != std::string::npos);
+    EXPECT_TRUE(output.find("cgs_inf +Inf\n") != std::string::npos);
+    EXPECT_TRUE(output.find("cgs_big 12345678901\n") != std::string::npos);
+}
+
+TEST_F(GameMetricsTest, ScrapeCacheServesBodyWithinTtl) {
+    metrics_.setGauge("cgs_ccu", 1.0);
+    metrics_.setScrapeCacheTtl(std::chrono::hours(1));
+    EXPECT_TRUE(metrics_.scrape().find("cgs_ccu 1\n") != std::string::npos);
+
+    metrics_.setGauge("cgs_ccu", 2.0);
+    EXPECT_TRUE(metrics_.scrape().find("cgs_ccu 1\n") != std::string::npos);  // cached
+
+    metrics_.setScrapeCacheTtl(std::chrono::milliseconds(0));
+    EXPECT_TRUE(metrics_.scrape().find("cgs_ccu 2\n") != std::string::npos);
+
+    metrics_.setScrapeCacheTtl(std::chrono::hours(1));
+    EXPECT_FALSE(metrics_.scrape().empty());
+    metrics_.reset();  // drops the cached body
+    EXPECT_TRUE(metrics_.scrape().empty());
+}
+
+TEST_F(GameMetricsTest, ScrapeDoesNotRaceWithWriters) {
+    metrics_.registerHistogram("cgs_lat", HistogramBuckets::defaultLatency());
+    std::atomic<bool> stop{false};
+    std::atomic<bool> writing{false};
+    std::thread writer([&] {
+        for (int i = 0; !stop.load(); ++i) {
+            metrics_.incrementCounter("cgs_ops");
+            metrics_.setGauge("cgs_g" + std::to_string(i % 64), 1.0);
+            metrics_.recordHistogram("cgs_lat", static_cast<double>(i % 100));
+            writing = true;
+        }
+    });
+    while (!writing.load()) {
+        std::this_thread::yield();
+    }
+    for (int i = 0; i < 50; ++i) {
+        EXPECT_FALSE(metrics_.scrape().empty());
+    }
+    stop = true;
+    writer.join();
+    EXPECT_TRUE(metrics_.scrape().find("# TYPE cgs_ops counter") != std::string::npos);
+}
+
 // ===========================================================================
 // Construction and move semantics
 // ===========================================================================
@@ -1,17 +1,32 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
 #include <mutex>
+#include <set>
+#include <span>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "cgs/foundation/error_code.hpp"
 #include "cgs/foundation/game_error.hpp"
 #include "cgs/foundation/game_network_manager.hpp"
+#include "cgs/foundation/mpsc_queue.hpp"
 #include "cgs/foundation/network_adapter.hpp"
 #include "cgs/foundation/signal.hpp"
+#include "cgs/foundation/spsc_queue.hpp"
+
+// kcenon client facade (used only to open loopback sessions)
+#include <kcenon/network/facade/tcp_facade.h>
+#include <kcenon/network/interfaces/connection_observer.h>
+#include <kcenon/network/interfaces/i_protocol_client.h>
 
 using namespace cgs::foundation;
 
@@ -186,6 +201,45 @@ TEST(SignalTest, ConcurrentConnectDisconnect) {
     EXPECT_GE(emitCount.load(), 0);
 }
 
+TEST(SignalTest, SlotsConnectedDuringEmitRunFromNextEmit) {
+    Signal<int> sig;
+    int first = 0;
+    int added = 0;
+    Signal<int>::SlotId self = 0;
+    self = sig.connect([&](int v) {
+        first += v;
+        sig.disconnect(self);
+        sig.connect([&](int w) { added += w; });
+    });
+
+    sig.emit(1);
+    EXPECT_EQ(first, 1);
+    EXPECT_EQ(added, 0);
+
+    sig.emit(2);
+    EXPECT_EQ(first, 1);
+    EXPECT_EQ(added, 2);
+    EXPECT_EQ(sig.slotCount(), 1u);
+}
+
+TEST(SignalTest, SmallCapturesStayInline) {
+    int counter = 0;
+    SignalSlot<int> small([&counter, calls = 0](int v) mutable { counter += v + ++calls; });
+    EXPECT_TRUE(small.isInline());
+    small(1);
+    SignalSlot<int> copy = small;  // Copies the captured state
+    copy(1);
+    small(1);
+    EXPECT_EQ(counter, 2 + 3 + 3);
+
+    std::array<char, 128> big{};
+    SignalSlot<int> heap([big, &counter](int v) { counter += v + big[0]; });
+    EXPECT_FALSE(heap.isInline());
+    SignalSlot<int> heapCopy = heap;
+    heapCopy(5);
+    EXPECT_EQ(counter, 13);
+}
+
 // ===========================================================================
 // NetworkMessage: serialization roundtrip
 // ===========================================================================
@@ -292,6 +346,807 @@ TEST(NetworkMessageTest, NetworkByteOrder) {
     EXPECT_EQ(wire[6], 0xAA);
 }
 
+// ===========================================================================
+// WireBuffer: pooled frames
+// ===========================================================================
+
+TEST(WireBufferTest, FrameMatchesSerialize) {
+    NetworkMessage msg;
+    msg.opcode = 0x0102;
+    msg.payload = {1, 2, 3, 4, 5};
+
+    WireBufferPool pool;
+    auto frame = msg.frame(pool);
+    auto wire = msg.serialize();
+    ASSERT_EQ(frame.size(), wire.size());
+    EXPECT_TRUE(std::equal(wire.begin(), wire.end(), frame.bytes().begin()));
+    EXPECT_EQ(frame.opcode(), 0x0102);
+    EXPECT_EQ(frame.payload().size(), 5u);
+
+    auto parsed = NetworkMessage::deserialize(frame.bytes().data(), frame.size());
+    ASSERT_TRUE(parsed.has_value());
+    EXPECT_EQ(parsed->payload, msg.payload);
+}
+
+TEST(WireBufferTest, TraceContextTravelsAheadOfThePayload) {
+    NetworkMessage msg;
+    msg.opcode = 0x0201;
+    msg.payload = {1, 2, 3};
+    msg.trace = TraceContext{0x11, 0x22, 0x33, TraceContext::kSampledFlag};
+
+    WireBufferPool pool;
+    auto frame = msg.frame(pool);
+    auto wire = msg.serialize();
+    ASSERT_EQ(wire.size(), WireBuffer::kHeaderSize + TraceContext::kEncodedSize + 3);
+    ASSERT_EQ(frame.size(), wire.size());
+    EXPECT_TRUE(std::equal(wire.begin(), wire.end(), frame.bytes().begin()));
+    EXPECT_TRUE(frame.traced());
+    EXPECT_FALSE(frame.compressed());
+    EXPECT_EQ(frame.traceContext(), msg.trace);
+    ASSERT_EQ(frame.payload().size(), 3u);
+    EXPECT_EQ(frame.payload()[0], 1);
+
+    auto parsed = NetworkMessage::deserialize(wire);
+    ASSERT_TRUE(parsed.has_value());
+    EXPECT_EQ(parsed->trace, msg.trace);
+    EXPECT_EQ(parsed->payload, msg.payload);
+    EXPECT_FALSE(parsed->compressed);
+
+    // Untraced frames are unchanged, and a traced frame too short for its
+    // context is rejected.
+    msg.trace = {};
+    EXPECT_FALSE(msg.frame(pool).traced());
+    EXPECT_EQ(msg.serialize().size(), WireBuffer::kHeaderSize + 3);
+    std::vector<uint8_t> truncated = {0x40, 0, 0, 8, 0, 1, 0, 0};
+    EXPECT_FALSE(NetworkMessage::deserialize(truncated).has_value());
+}
+
+TEST(WireBufferTest, PayloadWrittenInPlaceBehindHeader) {
+    WireBufferPool pool;
+    auto frame = pool.acquire(8);
+    auto region = frame.extend(4);
+    region[0] = 0xAA;
+    region[3] = 0xBB;
+    const uint8_t tail[] = {0xCC, 0xDD};
+    frame.append(tail, sizeof(tail));
+    frame.seal(0x0007);
+
+    ASSERT_EQ(frame.size(), WireBuffer::kHeaderSize + 6);
+    EXPECT_EQ(frame.bytes()[3], WireBuffer::kHeaderSize + 6);
+    EXPECT_EQ(frame.bytes()[5], 0x07);
+    EXPECT_EQ(frame.payload()[0], 0xAA);
+    EXPECT_EQ(frame.payload()[3], 0xBB);
+    EXPECT_EQ(frame.payload()[5], 0xDD);
+}
+
+TEST(WireBufferTest, CopiesShareBytesAndRecycleOnce) {
+    WireBufferPool pool;
+    const uint8_t payload[] = {9, 8, 7};
+    {
+        auto frame = pool.frame(0x10, payload);
+        auto copy = frame;
+        EXPECT_EQ(frame.useCount(), 2u);
+        EXPECT_EQ(copy.bytes().data(), frame.bytes().data());
+        EXPECT_EQ(pool.idleCount(), 0u);
+    }
+    EXPECT_EQ(pool.idleCount(), 1u);
+
+    // The next frame reuses the recycled storage.
+    auto again = pool.frame(0x11, payload);
+    EXPECT_EQ(pool.idleCount(), 0u);
+    EXPECT_EQ(pool.allocationCount(), 1u);
+    EXPECT_EQ(again.opcode(), 0x11);
+}
+
+TEST(WireBufferTest, TakeMovesOnlyWhenUnique) {
+    WireBufferPool pool;
+    const uint8_t payload[] = {1, 2};
+    auto frame = pool.frame(0x01, payload);
+    auto shared = frame;
+
+    auto copied = frame.take();
+    EXPECT_TRUE(frame.empty());
+    EXPECT_EQ(shared.useCount(), 1u);
+    EXPECT_EQ(copied.size(), shared.size());
+
+    const auto* data = shared.bytes().data();
+    auto moved = shared.take();
+    EXPECT_EQ(moved.data(), data);
+    EXPECT_EQ(moved, copied);
+}
+
+TEST(WireBufferTest, BuffersMayOutliveTheirPool) {
+    WireBuffer frame;
+    {
+        WireBufferPool pool;
+        const uint8_t payload[] = {4};
+        frame = pool.frame(0x02, payload);
+    }
+    EXPECT_EQ(frame.payload()[0], 4);
+}
+
+TEST(GameNetworkManagerTest, SendFrameToInvalidSessionFails) {
+    GameNetworkManager mgr;
+    const uint8_t payload[] = {1};
+    auto result = mgr.send(SessionId(999), mgr.wirePool().frame(0x01, payload));
+    EXPECT_TRUE(result.hasError());
+    EXPECT_EQ(result.error().code(), ErrorCode::SessionNotFound);
+}
+
+// ===========================================================================
+// OutboundQueue: per-session batching
+// ===========================================================================
+
+TEST(OutboundQueueTest, BatchParsesAsBackToBackFrames) {
+    WireBufferPool pool;
+    OutboundQueue queue;
+    const uint8_t a[] = {1, 2, 3};
+    const uint8_t b[] = {4};
+    EXPECT_EQ(queue.push(pool.frame(0x10, a)), EnqueueResult::Queued);
+    EXPECT_EQ(queue.push(pool.frame(0x11, b)), EnqueueResult::Queued);
+
+    auto stats = queue.stats();
+    EXPECT_EQ(stats.queueDepth, 2u);
+    EXPECT_EQ(stats.bytesInFlight, 2 * WireBuffer::kHeaderSize + 4);
+
+    auto batch = queue.take();
+    EXPECT_TRUE(queue.empty());
+    auto first = NetworkMessage::deserialize(batch.data(), batch.size());
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(first->opcode, 0x10);
+    const std::size_t second = WireBuffer::kHeaderSize + 3;
+    auto next = NetworkMessage::deserialize(batch.data() + second, batch.size() - second);
+    ASSERT_TRUE(next.has_value());
+    EXPECT_EQ(next->opcode, 0x11);
+    EXPECT_EQ(next->payload, std::vector<uint8_t>{4});
+
+    stats = queue.stats();
+    EXPECT_EQ(stats.queueDepth, 0u);
+    EXPECT_EQ(stats.bytesInFlight, 0u);
+    EXPECT_EQ(stats.batchesSent, 1u);
+    EXPECT_EQ(stats.messagesSent, 2u);
+}
+
+TEST(OutboundQueueTest, ThresholdRequestsEarlyFlush) {
+    WireBufferPool pool;
+    OutboundQueue queue(16);
+    const uint8_t payload[] = {0, 0, 0, 0};
+    EXPECT_EQ(queue.push(pool.frame(0x01, payload)), EnqueueResult::Queued);    // 10 bytes
+    EXPECT_EQ(queue.push(pool.frame(0x01, payload)), EnqueueResult::FlushNow);  // 20 bytes
+
+    // An empty queue yields no batch and counts nothing.
+    (void)queue.take();
+    EXPECT_TRUE(queue.take().empty());
+    EXPECT_EQ(queue.stats().batchesSent, 1u);
+}
+
+TEST(OutboundQueueTest, LanesDrainByPriority) {
+    WireBufferPool pool;
+    OutboundQueue queue;
+    const uint8_t payload[] = {0};
+    (void)queue.push(pool.frame(0x30, payload), SendLane::Bulk);
+    (void)queue.push(pool.frame(0x20, payload), SendLane::State);
+    (void)queue.push(pool.frame(0x10, payload), SendLane::Critical);
+
+    auto batch = queue.take();
+    ASSERT_EQ(batch.size(), 3 * (WireBuffer::kHeaderSize + 1));
+    const std::size_t frame = WireBuffer::kHeaderSize + 1;
+    EXPECT_EQ(batch[5], 0x10);
+    EXPECT_EQ(batch[frame + 5], 0x20);
+    EXPECT_EQ(batch[2 * frame + 5], 0x30);
+}
+
+TEST(OutboundQueueTest, StateUpdatesForOneKeyCoalesce) {
+    WireBufferPool pool;
+    OutboundQueue queue;
+    const uint8_t older[] = {1};
+    const uint8_t newer[] = {2};
+    (void)queue.push(pool.frame(0x20, older), SendLane::State, 42);
+    (void)queue.push(pool.frame(0x20, older), SendLane::State, 7);
+    (void)queue.push(pool.frame(0x20, newer), SendLane::State, 42);
+
+    auto stats = queue.stats();
+    EXPECT_EQ(stats.queueDepth, 2u);
+    EXPECT_EQ(stats.stateReplaced, 1u);
+
+    // The replacement keeps entity 42's place ahead of entity 7.
+    auto batch = queue.take();
+    ASSERT_EQ(batch.size(), 2 * (WireBuffer::kHeaderSize + 1));
+    EXPECT_EQ(batch[WireBuffer::kHeaderSize], 2);
+    EXPECT_EQ(batch[2 * WireBuffer::kHeaderSize + 1], 1);
+}
+
+TEST(OutboundQueueTest, BudgetsDropStaleStateAndRejectBulk) {
+    WireBufferPool pool;
+    LaneBudgets budgets;
+    budgets.state = 3 * 8;  // three 8-byte frames
+    budgets.bulk = 8;
+    OutboundQueue queue(OutboundQueue::kDefaultFlushThreshold, budgets);
+    const uint8_t payload[] = {0, 0};
+
+    for (uint64_t entity = 1; entity <= 5; ++entity) {
+        EXPECT_EQ(queue.push(pool.frame(0x20, payload), SendLane::State, entity),
+                  EnqueueResult::Queued);
+    }
+    EXPECT_EQ(queue.push(pool.frame(0x30, payload), SendLane::Bulk), EnqueueResult::Queued);
+    EXPECT_EQ(queue.push(pool.frame(0x30, payload), SendLane::Bulk), EnqueueResult::Rejected);
+
+    auto stats = queue.stats();
+    EXPECT_EQ(stats.stateDropped, 2u);
+    EXPECT_EQ(stats.rejected, 1u);
+    EXPECT_EQ(stats.laneBytes[static_cast<std::size_t>(SendLane::State)], 24u);
+    EXPECT_EQ(stats.queueDepth, 4u);
+
+    // A dropped entity can be queued again without touching the others.
+    (void)queue.push(pool.frame(0x20, payload), SendLane::State, 1);
+    EXPECT_EQ(queue.stats().stateDropped, 3u);
+}
+
+TEST(OutboundQueueTest, BytesPerFlushLeavesBacklogQueued) {
+    WireBufferPool pool;
+    LaneBudgets budgets;
+    budgets.bytesPerFlush = 20;  // two 8-byte frames per flush
+    OutboundQueue queue(OutboundQueue::kDefaultFlushThreshold, budgets);
+    const uint8_t payload[] = {0, 0};
+    for (uint64_t entity = 1; entity <= 3; ++entity) {
+        (void)queue.push(pool.frame(0x20, payload), SendLane::State, entity);
+    }
+
+    EXPECT_EQ(queue.take().size(), 16u);
+    EXPECT_EQ(queue.stats().queueDepth, 1u);
+
+    // The client is behind: a fresh update for entity 3 replaces the
+    // backlogged one instead of queueing behind it.
+    const uint8_t fresh[] = {9, 9};
+    (void)queue.push(pool.frame(0x20, fresh), SendLane::State, 3);
+    EXPECT_EQ(queue.stats().stateReplaced, 1u);
+    auto batch = queue.take();
+    ASSERT_EQ(batch.size(), 8u);
+    EXPECT_EQ(batch[WireBuffer::kHeaderSize], 9);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(GameNetworkManagerTest, CoalescingToggleAndUnknownSessions) {
+    GameNetworkManager mgr;
+    EXPECT_FALSE(mgr.coalescingEnabled());
+    mgr.setCoalescing(true, 4096);
+    EXPECT_TRUE(mgr.coalescingEnabled());
+
+    EXPECT_FALSE(mgr.outboundStats(SessionId(999)).has_value());
+    auto result = mgr.flush(SessionId(999));
+    EXPECT_TRUE(result.hasError());
+    EXPECT_EQ(result.error().code(), ErrorCode::SessionNotFound);
+    mgr.flush();
+
+    LaneBudgets budgets;
+    budgets.bulk = 1024;
+    mgr.setLaneBudgets(budgets);
+    EXPECT_EQ(mgr.laneBudgets().bulk, 1024u);
+    auto lane = mgr.send(SessionId(999), NetworkMessage{}, SendLane::Bulk);
+    EXPECT_EQ(lane.error().code(), ErrorCode::SessionNotFound);
+
+    mgr.setCoalescing(false);
+    EXPECT_FALSE(mgr.coalescingEnabled());
+}
+
+// ===========================================================================
+// ReliableEndpoint: UDP delivery channels
+// ===========================================================================
+
+namespace {
+
+using Packets = std::vector<std::vector<uint8_t>>;
+using ReliableClock = ReliableEndpoint::Clock;
+
+std::vector<uint8_t> bytesOf(uint8_t value, std::size_t size = 1) {
+    return std::vector<uint8_t>(size, value);
+}
+
+// Send one message on @p channel and return the datagram carrying it
+std::vector<uint8_t> sendOne(ReliableEndpoint& endpoint,
+                             DeliveryChannel channel,
+                             uint8_t value,
+                             ReliableClock::time_point now) {
+    EXPECT_TRUE(endpoint.send(channel, bytesOf(value)));
+    Packets packets;
+    endpoint.poll(now, packets);
+    EXPECT_EQ(packets.size(), 1u);
+    return packets.empty() ? std::vector<uint8_t>{} : packets.front();
+}
+
+// Hand every datagram @p from has due to @p to
+Packets exchange(ReliableEndpoint& from,
+                 ReliableEndpoint& to,
+                 ReliableClock::time_point now) {
+    Packets packets;
+    Packets delivered;
+    from.poll(now, packets);
+    for (const auto& packet : packets) {
+        EXPECT_TRUE(to.receive(packet, now, delivered));
+    }
+    return delivered;
+}
+
+}  // namespace
+
+TEST(ReliableEndpointTest, ReliableOrderedRecoversLossInOrder) {
+    ReliableEndpoint server;
+    ReliableEndpoint client;
+    const auto t0 = ReliableClock::time_point{} + std::chrono::seconds(1);
+    auto p0 = sendOne(server, DeliveryChannel::ReliableOrdered, 0, t0);
+    (void)sendOne(server, DeliveryChannel::ReliableOrdered, 1, t0);  // lost
+    auto p2 = sendOne(server, DeliveryChannel::ReliableOrdered, 2, t0);
+
+    Packets delivered;
+    ASSERT_TRUE(client.receive(p2, t0, delivered));
+    EXPECT_TRUE(delivered.empty());  // held until 0 and 1 arrive
+    ASSERT_TRUE(client.receive(p0, t0, delivered));
+    ASSERT_EQ(delivered.size(), 1u);
+    EXPECT_EQ(delivered[0], bytesOf(0));
+
+    // The selective ack covers 0 and 2; only 1 is resent after the RTO.
+    auto t1 = t0 + std::chrono::milliseconds(10);
+    EXPECT_TRUE(exchange(client, server, t1).empty());
+    EXPECT_EQ(server.stats().unackedFragments, 1u);
+    EXPECT_TRUE(exchange(server, client, t1).empty());
+
+    auto t2 = t1 + ReliableEndpoint::kMaxRto;
+    delivered = exchange(server, client, t2);
+    ASSERT_EQ(delivered.size(), 2u);
+    EXPECT_EQ(delivered[0], bytesOf(1));
+    EXPECT_EQ(delivered[1], bytesOf(2));
+    EXPECT_EQ(server.stats().retransmits, 1u);
+
+    (void)exchange(client, server, t2);
+    EXPECT_EQ(server.stats().unackedFragments, 0u);
+    EXPECT_FALSE(server.busy());
+}
+
+TEST(ReliableEndpointTest, UnreliableSequencedDropsStaleAndNeverResends) {
+    ReliableEndpoint server;
+    ReliableEndpoint client;
+    const auto t0 = ReliableClock::time_point{} + std::chrono::seconds(1);
+    auto older = sendOne(server, DeliveryChannel::UnreliableSequenced, 1, t0);
+    auto newer = sendOne(server, DeliveryChannel::UnreliableSequenced, 2, t0);
+
+    Packets delivered;
+    ASSERT_TRUE(client.receive(newer, t0, delivered));
+    ASSERT_TRUE(client.receive(older, t0, delivered));
+    ASSERT_EQ(delivered.size(), 1u);
+    EXPECT_EQ(delivered[0], bytesOf(2));
+
+    Packets later;
+    server.poll(t0 + std::chrono::seconds(5), later);
+    EXPECT_TRUE(later.empty());
+}
+
+TEST(ReliableEndpointTest, ReliableUnorderedDeliversEachMessageOnce) {
+    ReliableEndpoint server;
+    ReliableEndpoint client;
+    const auto t0 = ReliableClock::time_point{} + std::chrono::seconds(1);
+    auto p0 = sendOne(server, DeliveryChannel::ReliableUnordered, 0, t0);
+    auto p1 = sendOne(server, DeliveryChannel::ReliableUnordered, 1, t0);
+
+    Packets delivered;
+    ASSERT_TRUE(client.receive(p1, t0, delivered));
+    ASSERT_TRUE(client.receive(p0, t0, delivered));
+    ASSERT_TRUE(client.receive(p1, t0, delivered));  // duplicate datagram
+    ASSERT_EQ(delivered.size(), 2u);
+    EXPECT_EQ(delivered[0], bytesOf(1));
+    EXPECT_EQ(delivered[1], bytesOf(0));
+    EXPECT_EQ(client.stats().dropped, 1u);
+}
+
+TEST(ReliableEndpointTest, LargeMessagesAreFragmented) {
+    ReliableEndpoint server;
+    ReliableEndpoint client;
+    std::vector<uint8_t> message(5000);
+    for (std::size_t i = 0; i < message.size(); ++i) {
+        message[i] = static_cast<uint8_t>(i * 7);
+    }
+    ASSERT_TRUE(server.send(DeliveryChannel::ReliableOrdered, message));
+
+    Packets packets;
+    const auto t0 = ReliableClock::time_point{} + std::chrono::seconds(1);
+    server.poll(t0, packets);
+    ASSERT_EQ(packets.size(), 5u);
+    for (const auto& packet : packets) {
+        EXPECT_LE(packet.size(), ReliableEndpoint::kMaxPacketSize);
+    }
+
+    Packets delivered;
+    std::reverse(packets.begin(), packets.end());
+    for (const auto& packet : packets) {
+        ASSERT_TRUE(client.receive(packet, t0, delivered));
+    }
+    ASSERT_EQ(delivered.size(), 1u);
+    EXPECT_EQ(delivered[0], message);
+
+    std::vector<uint8_t> tooLarge(ReliableEndpoint::kMaxMessageSize + 1);
+    EXPECT_FALSE(server.send(DeliveryChannel::ReliableOrdered, tooLarge));
+}
+
+TEST(ReliableEndpointTest, AckedPacketsUpdateRttEstimate) {
+    ReliableEndpoint server;
+    ReliableEndpoint client;
+    const auto t0 = ReliableClock::time_point{} + std::chrono::seconds(1);
+    EXPECT_EQ(server.stats().rto, ReliableEndpoint::kInitialRto);
+
+    auto packet = sendOne(server, DeliveryChannel::ReliableOrdered, 0, t0);
+    Packets delivered;
+    ASSERT_TRUE(client.receive(packet, t0 + std::chrono::milliseconds(40), delivered));
+    (void)exchange(client, server, t0 + std::chrono::milliseconds(80));
+
+    const auto stats = server.stats();
+    EXPECT_EQ(stats.packetsAcked, 1u);
+    EXPECT_EQ(stats.rtt, std::chrono::milliseconds(80));
+    EXPECT_EQ(stats.rto, std::chrono::milliseconds(80 + 4 * 40));  // RFC 6298
+    EXPECT_EQ(stats.unackedFragments, 0u);
+}
+
+TEST(ReliableEndpointTest, MalformedDatagramsAreIgnored) {
+    ReliableEndpoint endpoint;
+    Packets delivered;
+    const auto now = ReliableClock::now();
+    const std::vector<uint8_t> shortHeader = {0, 1, 0};
+    EXPECT_FALSE(endpoint.receive(shortHeader, now, delivered));
+
+    std::vector<uint8_t> badChannel(ReliableEndpoint::kPacketHeaderSize, 0);
+    const uint8_t chunk[] = {7, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0};
+    badChannel.insert(badChannel.end(), std::begin(chunk), std::end(chunk));
+    EXPECT_FALSE(endpoint.receive(badChannel, now, delivered));
+
+    EXPECT_TRUE(delivered.empty());
+    EXPECT_EQ(endpoint.stats().dropped, 2u);
+    EXPECT_FALSE(endpoint.busy());  // nothing acked back
+}
+
+TEST(GameNetworkManagerTest, UdpReliabilityToggleAndUnknownSessions) {
+    GameNetworkManager mgr;
+    EXPECT_FALSE(mgr.udpReliabilityEnabled());
+    mgr.setUdpReliability(true);
+    EXPECT_TRUE(mgr.udpReliabilityEnabled());
+
+    EXPECT_FALSE(mgr.reliabilityStats(SessionId(999)).has_value());
+    auto result = mgr.send(SessionId(999), NetworkMessage{}, DeliveryChannel::UnreliableSequenced);
+    EXPECT_EQ(result.error().code(), ErrorCode::SessionNotFound);
+    mgr.updateReliability();
+}
+
+// ===========================================================================
+// SpscQueue / reactors
+// ===========================================================================
+
+TEST(SpscQueueTest, FifoWithinCapacity) {
+    SpscQueue<int> queue(3);
+    EXPECT_EQ(queue.capacity(), 4u);
+    for (int i = 0; i < 4; ++i) {
+        int value = i;
+        EXPECT_TRUE(queue.tryPush(std::move(value)));
+    }
+    int extra = 99;
+    EXPECT_FALSE(queue.tryPush(std::move(extra)));
+    EXPECT_EQ(queue.size(), 4u);
+
+    int out = -1;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(queue.tryPop(out));
+        EXPECT_EQ(out, i);
+    }
+    EXPECT_FALSE(queue.tryPop(out));
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(SpscQueueTest, HandsValuesAcrossThreadsInOrder) {
+    constexpr int kCount = 100000;
+    SpscQueue<std::vector<int>> queue(64);
+    std::thread producer([&] {
+        for (int i = 0; i < kCount; ++i) {
+            std::vector<int> value{i};
+            while (!queue.tryPush(std::move(value))) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int expected = 0;
+    std::vector<int> out;
+    while (expected < kCount) {
+        if (!queue.tryPop(out)) {
+            std::this_thread::yield();
+            continue;
+        }
+        ASSERT_EQ(out.size(), 1u);
+        ASSERT_EQ(out[0], expected);
+        ++expected;
+    }
+    producer.join();
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(MpscQueueTest, FifoWithPositions) {
+    MpscQueue<int> queue(3);
+    EXPECT_EQ(queue.capacity(), 4u);
+    for (int i = 0; i < 4; ++i) {
+        int value = i;
+        uint64_t position = 99;
+        EXPECT_TRUE(queue.tryPush(std::move(value), position));
+        EXPECT_EQ(position, static_cast<uint64_t>(i));
+    }
+    int extra = 99;
+    EXPECT_FALSE(queue.tryPush(std::move(extra)));
+    EXPECT_EQ(queue.size(), 4u);
+
+    int out = -1;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(queue.tryPop(out));
+        EXPECT_EQ(out, i);
+    }
+    EXPECT_FALSE(queue.tryPop(out));
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.claimed(), 4u);
+}
+
+TEST(MpscQueueTest, PositionsMatchConsumerOrder) {
+    constexpr int kProducers = 4;
+    constexpr int kPerProducer = 20000;
+    MpscQueue<std::vector<int>> queue(64);
+
+    // positions[p][i]: position producer p got for its i-th value.
+    std::vector<std::vector<uint64_t>> positions(kProducers);
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&, p] {
+            for (int i = 0; i < kPerProducer; ++i) {
+                std::vector<int> value{p, i};
+                uint64_t position = 0;
+                while (!queue.tryPush(std::move(value), position)) {
+                    std::this_thread::yield();
+                }
+                positions[static_cast<std::size_t>(p)].push_back(position);
+            }
+        });
+    }
+
+    std::vector<std::array<int, 2>> popped;
+    popped.reserve(kProducers * kPerProducer);
+    std::vector<int> out;
+    while (popped.size() < static_cast<std::size_t>(kProducers * kPerProducer)) {
+        if (!queue.tryPop(out)) {
+            std::this_thread::yield();
+            continue;
+        }
+        popped.push_back({out[0], out[1]});
+    }
+    for (auto& th : producers) {
+        th.join();
+    }
+
+    std::vector<int> next(kProducers, 0);
+    for (std::size_t pos = 0; pos < popped.size(); ++pos) {
+        auto [p, i] = popped[pos];
+        ASSERT_EQ(i, next[static_cast<std::size_t>(p)]++);  // Per-producer FIFO.
+        ASSERT_EQ(positions[static_cast<std::size_t>(p)][static_cast<std::size_t>(i)], pos);
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(GameNetworkManagerTest, ReactorsConfiguredBeforeListen) {
+    GameNetworkManager mgr;
+    EXPECT_EQ(mgr.reactorCount(), 0u);
+    ASSERT_TRUE(mgr.setReactors(4, 128).hasValue());
+    EXPECT_EQ(mgr.reactorCount(), 4u);
+    EXPECT_EQ(mgr.dispatchInbound(), 0u);
+
+    auto stats = mgr.reactorStats();
+    ASSERT_EQ(stats.size(), 4u);
+    EXPECT_EQ(stats[0].received, 0u);
+    EXPECT_EQ(stats[0].pending, 0u);
+
+    ASSERT_TRUE(mgr.setReactors(0).hasValue());
+    EXPECT_EQ(mgr.reactorCount(), 0u);
+}
+
+TEST(GameNetworkManagerTest, SessionGroupsByNameAndHandle) {
+    GameNetworkManager mgr;
+    auto party = mgr.createGroup("party:7");
+    ASSERT_TRUE(party.hasValue());
+    EXPECT_EQ(mgr.findGroup("party:7"), party.value());
+    EXPECT_EQ(mgr.createGroup("party:7").error().code(), ErrorCode::AlreadyExists);
+
+    auto cell = mgr.createGroup();  // Unnamed: handle only
+    ASSERT_TRUE(cell.hasValue());
+    EXPECT_NE(cell.value(), party.value());
+    EXPECT_EQ(mgr.groupSize(cell.value()), 0u);
+
+    // Only connected sessions can join
+    auto join = mgr.addToGroup(party.value(), SessionId(999));
+    EXPECT_EQ(join.error().code(), ErrorCode::SessionNotFound);
+    EXPECT_TRUE(mgr.removeFromGroup(party.value(), SessionId(999)).hasValue());
+    EXPECT_EQ(mgr.groupSize(party.value()), 0u);
+    EXPECT_TRUE(mgr.sendToGroup(party.value(), NetworkMessage{}).hasValue());
+
+    ASSERT_TRUE(mgr.destroyGroup(party.value()).hasValue());
+    EXPECT_FALSE(mgr.findGroup("party:7").has_value());
+    EXPECT_FALSE(mgr.groupSize(party.value()).has_value());
+    EXPECT_EQ(mgr.destroyGroup(party.value()).error().code(), ErrorCode::NotFound);
+    EXPECT_EQ(mgr.addToGroup(party.value(), SessionId(1)).error().code(), ErrorCode::NotFound);
+    EXPECT_TRUE(mgr.createGroup("party:7").hasValue());  // Name is free again
+}
+
+TEST(GameNetworkManagerTest, SendToUnknownGroupFails) {
+    GameNetworkManager mgr;
+    ASSERT_TRUE(mgr.setReactors(2, 64).hasValue());
+    const uint8_t payload[] = {1};
+    auto result = mgr.sendToGroup(SessionGroupId(42), mgr.wirePool().frame(0x01, payload));
+    EXPECT_EQ(result.error().code(), ErrorCode::NotFound);
+
+    auto group = mgr.createGroup();
+    ASSERT_TRUE(group.hasValue());
+    EXPECT_TRUE(mgr.sendToGroup(group.value(), mgr.wirePool().frame(0x01, payload)).hasValue());
+    EXPECT_EQ(mgr.reactorStats()[0].fanouts, 0u);  // Nobody to send to
+}
+
+// ===========================================================================
+// Payload compression
+// ===========================================================================
+
+namespace {
+
+// An inventory-like payload: repeated records with a few varying bytes.
+std::vector<uint8_t> inventoryPayload(uint32_t seed, std::size_t items) {
+    std::vector<uint8_t> out;
+    for (std::size_t i = 0; i < items; ++i) {
+        const auto id = static_cast<uint8_t>((seed * 31 + i * 7) & 0xFF);
+        const uint8_t record[] = {'i', 't', 'e', 'm', 0x01, id, 0x00, 0x10,
+                                  's', 'l', 'o', 't', 0x02, static_cast<uint8_t>(i), 0x7F, 0x00};
+        out.insert(out.end(), std::begin(record), std::end(record));
+    }
+    return out;
+}
+
+std::vector<uint8_t> noisePayload(std::size_t size, uint32_t seed) {
+    std::vector<uint8_t> out(size);
+    for (auto& byte : out) {
+        seed = seed * 1664525u + 1013904223u;
+        byte = static_cast<uint8_t>(seed >> 24);
+    }
+    return out;
+}
+
+}  // namespace
+
+TEST(PayloadCodecTest, Lz4BlocksRoundTrip) {
+    std::vector<std::vector<uint8_t>> inputs = {{}, {1, 2, 3}, noisePayload(5000, 7),
+                                                inventoryPayload(1, 400),
+                                                std::vector<uint8_t>(70000, 0xAB)};
+    for (std::size_t n = 1; n < 64; ++n) {
+        inputs.push_back(inventoryPayload(static_cast<uint32_t>(n), n));
+    }
+    for (const auto& input : inputs) {
+        std::vector<uint8_t> block;
+        compressLz4Block(input, block);
+        EXPECT_LE(block.size(), lz4CompressBound(input.size()));
+        std::vector<uint8_t> output;
+        ASSERT_TRUE(decompressLz4Block(block, input.size(), output)) << input.size();
+        EXPECT_EQ(output, input);
+    }
+
+    std::vector<uint8_t> block;
+    compressLz4Block(inventoryPayload(3, 400), block);
+    EXPECT_LT(block.size(), 6400u / 2);
+}
+
+TEST(PayloadCodecTest, TrainedDictionaryShrinksSmallMessages) {
+    std::vector<std::vector<uint8_t>> samples;
+    for (uint32_t i = 0; i < 64; ++i) {
+        samples.push_back(inventoryPayload(i, 6));
+    }
+    const auto dictionary = CompressionDictionary::train(samples, 1024);
+    ASSERT_FALSE(dictionary.empty());
+    EXPECT_LE(dictionary.bytes().size(), 1024u);
+    EXPECT_EQ(CompressionDictionary(std::vector<uint8_t>(dictionary.bytes().begin(),
+                                                         dictionary.bytes().end()))
+                  .id(),
+              dictionary.id());
+
+    const auto message = inventoryPayload(99, 6);
+    std::vector<uint8_t> plain;
+    std::vector<uint8_t> primed;
+    compressLz4Block(message, plain);
+    compressLz4Block(message, primed, &dictionary);
+    EXPECT_LT(primed.size(), plain.size());
+
+    std::vector<uint8_t> output;
+    ASSERT_TRUE(decompressLz4Block(primed, message.size(), output, dictionary.bytes()));
+    EXPECT_EQ(output, message);
+    EXPECT_FALSE(decompressLz4Block(primed, message.size(), output));  // dictionary missing
+}
+
+TEST(PayloadCodecTest, MalformedBlocksAreRejected) {
+    const auto input = inventoryPayload(5, 64);
+    std::vector<uint8_t> block;
+    compressLz4Block(input, block);
+
+    std::vector<uint8_t> output;
+    EXPECT_FALSE(decompressLz4Block({}, 0, output));
+    EXPECT_FALSE(decompressLz4Block(block, input.size() - 1, output));
+    EXPECT_FALSE(decompressLz4Block(block, input.size() + 1, output));
+    const std::vector<uint8_t> truncated(block.begin(), block.end() - 3);
+    EXPECT_FALSE(decompressLz4Block(truncated, input.size(), output));
+    // A match reaching back before the start of the output.
+    const std::vector<uint8_t> badOffset = {0x10, 'a', 0x09, 0x00, 0x00};
+    EXPECT_FALSE(decompressLz4Block(badOffset, 5, output));
+}
+
+TEST(PayloadCompressorTest, ThresholdsAndBackoff) {
+    CompressionConfig config;
+    config.minPayloadSize = 64;
+    config.backoff = 2;
+    PayloadCompressor compressor(config);
+    std::vector<uint8_t> out;
+
+    EXPECT_FALSE(compressor.compress(1, inventoryPayload(1, 2), out));  // below threshold
+    const auto noise = noisePayload(1024, 3);
+    EXPECT_FALSE(compressor.compress(2, noise, out));  // does not shrink: backs off
+    EXPECT_FALSE(compressor.compress(2, inventoryPayload(2, 64), out));
+    EXPECT_FALSE(compressor.compress(2, inventoryPayload(2, 64), out));
+    EXPECT_TRUE(out.empty());
+
+    const auto payload = inventoryPayload(2, 64);
+    ASSERT_TRUE(compressor.compress(2, payload, out));  // backoff spent
+    EXPECT_LT(out.size(), payload.size() * 3 / 4);
+    std::vector<uint8_t> inflated;
+    ASSERT_TRUE(compressor.decompress(out, inflated));
+    EXPECT_EQ(inflated, payload);
+    EXPECT_FALSE(compressor.decompress(std::vector<uint8_t>{0xFF, 0xFF, 0xFF, 0xFF}, inflated));
+
+    const auto stats = compressor.stats();
+    EXPECT_EQ(stats.attempted, 2u);
+    EXPECT_EQ(stats.compressed, 1u);
+    EXPECT_EQ(stats.skipped, 3u);
+    EXPECT_EQ(stats.bytesIn, noise.size() + payload.size());
+    EXPECT_EQ(stats.bytesOut, noise.size() + out.size());
+    EXPECT_LT(stats.ratio(), 1.0);
+    EXPECT_EQ(stats.decompressed, 1u);
+    EXPECT_EQ(stats.rejected, 1u);
+}
+
+TEST(PayloadCompressorTest, CompressedFlagTravelsInTheFrame) {
+    NetworkMessage msg{0x0321, {1, 2, 3}, true, {}};
+    auto wire = msg.serialize();
+    EXPECT_EQ(wire[0] & 0x80, 0x80);
+    auto parsed = NetworkMessage::deserialize(wire);
+    ASSERT_TRUE(parsed.has_value());
+    EXPECT_TRUE(parsed->compressed);
+    EXPECT_EQ(parsed->opcode, 0x0321);
+    EXPECT_EQ(parsed->payload, msg.payload);
+
+    WireBufferPool pool;
+    auto frame = msg.frame(pool);
+    EXPECT_TRUE(frame.compressed());
+    EXPECT_TRUE(std::equal(wire.begin(), wire.end(), frame.bytes().begin(), frame.bytes().end()));
+    EXPECT_FALSE(pool.frame(1, msg.payload).compressed());
+}
+
+TEST(GameNetworkManagerTest, CompressionConfiguredBeforeListen) {
+    GameNetworkManager mgr;
+    EXPECT_FALSE(mgr.compressionEnabled());
+    EXPECT_FALSE(mgr.compressionStats().has_value());
+    EXPECT_EQ(mgr.setSessionCompression(SessionId(1), true).error().code(),
+              ErrorCode::InvalidArgument);
+
+    ASSERT_TRUE(mgr.setCompression(true).hasValue());
+    EXPECT_TRUE(mgr.compressionEnabled());
+    ASSERT_TRUE(mgr.compressionStats().has_value());
+    EXPECT_EQ(mgr.compressionStats()->attempted, 0u);
+    EXPECT_EQ(mgr.setSessionCompression(SessionId(999), true).error().code(),
+              ErrorCode::SessionNotFound);
+
+    ASSERT_TRUE(mgr.setCompression(false).hasValue());
+    EXPECT_FALSE(mgr.compressionEnabled());
+}
+
 // ===========================================================================
 // Protocol helpers
 // ===========================================================================
@@ -338,6 +1193,19 @@ TEST(GameNetworkManagerTest, RegisterUnregisterHandler) {
     // No crash
 }
 
+TEST(GameNetworkManagerTest, ReplaceHandlersAcrossOpcodeRange) {
+    GameNetworkManager mgr;
+    for (uint32_t op = 0; op <= 0xFFFF; op += 0x0FFF) {
+        const auto opcode = static_cast<uint16_t>(op);
+        mgr.registerHandler(opcode, [](SessionId, const NetworkMessage&) {});
+        mgr.registerHandler(opcode, [](SessionId, const NetworkMessage&) {});
+        mgr.registerHandler(opcode, MessageHandler{});
+    }
+    mgr.registerHandler(0xFFFF, [](SessionId, const NetworkMessage&) {});
+    mgr.unregisterHandler(0xFFFF);
+    mgr.unregisterHandler(0x1234);  // never registered
+}
+
 // ===========================================================================
 // GameNetworkManager: send to invalid session
 // ===========================================================================
@@ -410,6 +1278,371 @@ TEST(GameNetworkManagerTest, StopAllNoServers) {
 // without actually starting a server (the first listen may fail due to
 // missing ASIO context, but the AlreadyExists path is still exercised).
 
+// ===========================================================================
+// GameNetworkManager: concurrent dispatch over loopback sessions
+// ===========================================================================
+// These tests drive real TCP sessions through kcenon's client facade, so
+// handler swaps and session churn race the receive path for real.
+
+namespace {
+
+constexpr auto kLoopbackTimeout = std::chrono::seconds(10);
+
+// TCP client on 127.0.0.1 that counts the bytes the server sends it.
+class LoopbackClient {
+public:
+    explicit LoopbackClient(uint16_t port) {
+        kcenon::network::facade::tcp_facade tcp;
+        kcenon::network::facade::tcp_facade::client_config cfg{};
+        cfg.host = "127.0.0.1";
+        cfg.port = port;
+        cfg.client_id = "unit-loopback-client";
+        client_ = tcp.create_client(cfg);
+        if (!client_) {
+            return;
+        }
+        auto observer = std::make_shared<kcenon::network::interfaces::callback_adapter>();
+        observer->on_receive([received = received_](std::span<const uint8_t> data) {
+            received->fetch_add(data.size());
+        });
+        client_->set_observer(observer);
+    }
+
+    ~LoopbackClient() { close(); }
+
+    LoopbackClient(const LoopbackClient&) = delete;
+    LoopbackClient& operator=(const LoopbackClient&) = delete;
+
+    bool send(const NetworkMessage& msg) {
+        return client_ && client_->send(msg.serialize()).is_ok();
+    }
+
+    void close() {
+        if (client_) {
+            (void)client_->stop();
+            client_.reset();
+        }
+    }
+
+    std::size_t receivedBytes() const { return received_->load(); }
+
+private:
+    std::shared_ptr<kcenon::network::interfaces::i_protocol_client> client_;
+    std::shared_ptr<std::atomic<std::size_t>> received_ =
+        std::make_shared<std::atomic<std::size_t>>(0);
+};
+
+// Poll @p done until it holds or kLoopbackTimeout passes.
+template <typename Predicate>
+bool waitUntil(Predicate done) {
+    const auto deadline = std::chrono::steady_clock::now() + kLoopbackTimeout;
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+NetworkMessage tagged(uint16_t opcode, uint32_t tag) {
+    NetworkMessage msg;
+    msg.opcode = opcode;
+    msg.payload = {static_cast<uint8_t>(tag >> 24), static_cast<uint8_t>(tag >> 16),
+                   static_cast<uint8_t>(tag >> 8), static_cast<uint8_t>(tag)};
+    return msg;
+}
+
+uint32_t tagOf(const NetworkMessage& msg) {
+    if (msg.payload.size() < 4) {
+        return 0;
+    }
+    return (uint32_t{msg.payload[0]} << 24) | (uint32_t{msg.payload[1]} << 16) |
+           (uint32_t{msg.payload[2]} << 8) | uint32_t{msg.payload[3]};
+}
+
+}  // namespace
+
+TEST(GameNetworkManagerConcurrencyTest, ReplacedHandlersAreNotCalledForLaterMessages) {
+    constexpr uint16_t kPort = 19101;
+    constexpr std::array<uint16_t, 4> kOpcodes = {0x0001, 0x4000, 0x8001, 0xFFFF};
+    constexpr std::size_t kSenders = 4;
+    constexpr uint32_t kGenerations = 200;
+
+    GameNetworkManager mgr;
+    std::array<std::atomic<uint32_t>, kOpcodes.size()> installed{};
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> staleCalls{0};
+
+    // Generation @p gen of the handler for kOpcodes[slot].  A message
+    // carries the generation installed when it was sent, so an older
+    // handler receiving it was called after its replacement returned.
+    auto handlerFor = [&](uint32_t gen) {
+        return [&, gen](SessionId, const NetworkMessage& msg) {
+            calls.fetch_add(1);
+            if (tagOf(msg) > gen) {
+                staleCalls.fetch_add(1);
+            }
+        };
+    };
+    for (const uint16_t opcode : kOpcodes) {
+        mgr.registerHandler(opcode, handlerFor(0));
+    }
+    ASSERT_TRUE(mgr.listen(kPort, Protocol::TCP).hasValue());
+
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> senders;
+    for (std::size_t i = 0; i < kSenders; ++i) {
+        senders.emplace_back([&] {
+            LoopbackClient client(kPort);
+            while (!stop.load()) {
+                for (std::size_t slot = 0; slot < kOpcodes.size(); ++slot) {
+                    (void)client.send(tagged(kOpcodes[slot], installed[slot].load()));
+                }
+            }
+        });
+    }
+    ASSERT_TRUE(waitUntil([&] { return mgr.sessionCount() == kSenders; }));
+
+    for (uint32_t gen = 1; gen <= kGenerations; ++gen) {
+        for (std::size_t slot = 0; slot < kOpcodes.size(); ++slot) {
+            mgr.registerHandler(kOpcodes[slot], handlerFor(gen));
+            installed[slot].store(gen);
+        }
+        // Churn slots no message uses while the table is being read.
+        const auto spare = static_cast<uint16_t>(0x1000 + gen);
+        mgr.registerHandler(spare, [](SessionId, const NetworkMessage&) {});
+        mgr.unregisterHandler(spare);
+    }
+    const uint64_t before = calls.load();
+    EXPECT_TRUE(waitUntil([&] { return calls.load() > before; }));
+
+    stop.store(true);
+    for (auto& sender : senders) {
+        sender.join();
+    }
+    mgr.stopAll();
+
+    EXPECT_GT(calls.load(), 0u);
+    EXPECT_EQ(staleCalls.load(), 0u);
+}
+
+TEST(GameNetworkManagerConcurrencyTest, SessionIndexResolvesWhileSessionsComeAndGo) {
+    constexpr uint16_t kPort = 19102;
+    constexpr uint16_t kOpcode = 0x0042;
+    constexpr uint32_t kSteady = 4;
+    constexpr uint32_t kMessages = 500;
+    constexpr uint32_t kChurn = 200;
+
+    GameNetworkManager mgr;
+    std::mutex mutex;
+    std::unordered_map<uint32_t, std::set<SessionId>> sessionsByTag;
+    std::array<std::atomic<uint32_t>, kSteady> delivered{};
+    mgr.registerHandler(kOpcode, [&](SessionId sid, const NetworkMessage& msg) {
+        const uint32_t tag = tagOf(msg);
+        if (tag < kSteady) {
+            delivered[tag].fetch_add(1);
+        }
+        std::lock_guard lock(mutex);
+        sessionsByTag[tag].insert(sid);
+    });
+    ASSERT_TRUE(mgr.listen(kPort, Protocol::TCP).hasValue());
+
+    std::vector<std::unique_ptr<LoopbackClient>> steady;
+    for (uint32_t i = 0; i < kSteady; ++i) {
+        steady.push_back(std::make_unique<LoopbackClient>(kPort));
+    }
+    ASSERT_TRUE(waitUntil([&] { return mgr.sessionCount() == kSteady; }));
+
+    // Sessions connect and disconnect, republishing the index, while the
+    // steady clients' messages are resolved through it.
+    std::thread churn([&] {
+        for (uint32_t i = 0; i < kChurn; ++i) {
+            LoopbackClient client(kPort);
+            (void)client.send(tagged(kOpcode, kSteady + i));
+        }
+    });
+    std::vector<std::thread> senders;
+    for (uint32_t tag = 0; tag < kSteady; ++tag) {
+        senders.emplace_back([&, tag] {
+            for (uint32_t i = 0; i < kMessages; ++i) {
+                ASSERT_TRUE(steady[tag]->send(tagged(kOpcode, tag)));
+            }
+        });
+    }
+    churn.join();
+    for (auto& sender : senders) {
+        sender.join();
+    }
+
+    for (uint32_t tag = 0; tag < kSteady; ++tag) {
+        EXPECT_TRUE(waitUntil([&] { return delivered[tag].load() == kMessages; }));
+    }
+    EXPECT_TRUE(waitUntil([&] { return mgr.sessionCount() == kSteady; }));
+
+    steady.clear();
+    mgr.stopAll();
+
+    // Every client resolved to one session, and no two clients to the same.
+    std::set<SessionId> seen;
+    for (const auto& [tag, sessions] : sessionsByTag) {
+        EXPECT_EQ(sessions.size(), 1u) << "tag " << tag;
+        for (const SessionId sid : sessions) {
+            EXPECT_TRUE(seen.insert(sid).second) << "session " << sid.value();
+        }
+    }
+}
+
+TEST(GameNetworkManagerConcurrencyTest, ConnectDisconnectRaceSendBroadcastAndCount) {
+    constexpr uint16_t kPort = 19103;
+    constexpr std::size_t kSteady = 4;
+    constexpr uint32_t kChurn = 200;
+
+    GameNetworkManager mgr;
+    mgr.setCoalescing(true);
+    std::mutex mutex;
+    std::set<SessionId> live;
+    mgr.onConnected.connect([&](SessionId sid) {
+        std::lock_guard lock(mutex);
+        live.insert(sid);
+    });
+    mgr.onDisconnected.connect([&](SessionId sid) {
+        std::lock_guard lock(mutex);
+        live.erase(sid);
+    });
+    ASSERT_TRUE(mgr.listen(kPort, Protocol::TCP).hasValue());
+
+    std::vector<std::unique_ptr<LoopbackClient>> steady;
+    for (std::size_t i = 0; i < kSteady; ++i) {
+        steady.push_back(std::make_unique<LoopbackClient>(kPort));
+    }
+    ASSERT_TRUE(waitUntil([&] { return mgr.sessionCount() == kSteady; }));
+
+    std::atomic<bool> churnDone{false};
+    std::thread churn([&] {
+        for (uint32_t i = 0; i < kChurn; ++i) {
+            LoopbackClient client(kPort);
+        }
+        churnDone.store(true);
+    });
+    // Sends to sessions that may be leaving, broadcasts and flushes walk
+    // whichever snapshot is current.
+    std::thread sender([&] {
+        const NetworkMessage msg = tagged(0x0042, 7);
+        while (!churnDone.load()) {
+            std::vector<SessionId> targets;
+            {
+                std::lock_guard lock(mutex);
+                targets.assign(live.begin(), live.end());
+            }
+            for (const SessionId sid : targets) {
+                (void)mgr.send(sid, msg);
+            }
+            EXPECT_TRUE(mgr.broadcast(msg).hasValue());
+            mgr.flush();
+        }
+    });
+    std::thread counter([&] {
+        while (!churnDone.load()) {
+            EXPECT_GE(mgr.sessionCount(), kSteady);
+        }
+    });
+    churn.join();
+    sender.join();
+    counter.join();
+
+    EXPECT_TRUE(waitUntil([&] { return mgr.sessionCount() == kSteady; }));
+    {
+        std::lock_guard lock(mutex);
+        EXPECT_EQ(live.size(), mgr.sessionCount());
+        for (const SessionId sid : live) {
+            EXPECT_TRUE(mgr.sessionInfo(sid).has_value()) << "session " << sid.value();
+        }
+    }
+    EXPECT_TRUE(mgr.broadcast(tagged(0x0042, 8)).hasValue());
+    mgr.flush();
+    for (const auto& client : steady) {
+        EXPECT_TRUE(waitUntil([&] { return client->receivedBytes() > 0; }));
+    }
+    steady.clear();
+    mgr.stopAll();
+}
+
+TEST(GameNetworkManagerConcurrencyTest, SessionLookupsAndDisconnectsFollowTheSnapshot) {
+    constexpr uint16_t kPort = 19104;
+    constexpr std::size_t kThreads = 4;
+    constexpr uint32_t kChurnPerThread = 50;
+
+    GameNetworkManager mgr;
+    std::mutex mutex;
+    std::set<SessionId> live;
+    std::unordered_map<uint64_t, int> connects;
+    std::unordered_map<uint64_t, int> disconnects;
+    std::atomic<uint32_t> badLookups{0};
+    // A session is in the index before onConnected and out of it before
+    // onDisconnected; the disconnect resolves the transport's ID back to
+    // the SessionId handed out at connect.
+    mgr.onConnected.connect([&](SessionId sid) {
+        if (!mgr.sessionInfo(sid).has_value() || mgr.sessionCount() == 0) {
+            badLookups.fetch_add(1);
+        }
+        std::lock_guard lock(mutex);
+        live.insert(sid);
+        ++connects[sid.value()];
+    });
+    mgr.onDisconnected.connect([&](SessionId sid) {
+        if (mgr.sessionInfo(sid).has_value()) {
+            badLookups.fetch_add(1);
+        }
+        std::lock_guard lock(mutex);
+        live.erase(sid);
+        ++disconnects[sid.value()];
+    });
+    ASSERT_TRUE(mgr.listen(kPort, Protocol::TCP).hasValue());
+
+    std::atomic<bool> stop{false};
+    std::thread reader([&] {
+        while (!stop.load()) {
+            std::vector<SessionId> sessions;
+            {
+                std::lock_guard lock(mutex);
+                sessions.assign(live.begin(), live.end());
+            }
+            for (const SessionId sid : sessions) {
+                if (auto info = mgr.sessionInfo(sid)) {
+                    EXPECT_EQ(info->id, sid);
+                    EXPECT_EQ(info->protocol, Protocol::TCP);
+                }
+            }
+        }
+    });
+    std::vector<std::thread> churn;
+    for (std::size_t t = 0; t < kThreads; ++t) {
+        churn.emplace_back([&] {
+            for (uint32_t i = 0; i < kChurnPerThread; ++i) {
+                LoopbackClient client(kPort);
+            }
+        });
+    }
+    for (auto& thread : churn) {
+        thread.join();
+    }
+    EXPECT_TRUE(waitUntil([&] { return mgr.sessionCount() == 0; }));
+    stop.store(true);
+    reader.join();
+    mgr.stopAll();
+
+    EXPECT_EQ(badLookups.load(), 0u);
+    std::lock_guard lock(mutex);
+    EXPECT_TRUE(live.empty());
+    EXPECT_EQ(connects.size(), kThreads * kChurnPerThread);
+    EXPECT_EQ(disconnects.size(), connects.size());
+    for (const auto& [sid, count] : connects) {
+        EXPECT_EQ(count, 1) << "session " << sid;
+        EXPECT_EQ(disconnects[sid], 1) << "session " << sid;
+    }
+}
+
 // ===========================================================================
 // TlsConfig: validation
 // ===========================================================================
@@ -443,6 +1676,147 @@ TEST(TlsConfigTest, DefaultVerifyPeerIsFalse) {
     EXPECT_FALSE(cfg.verifyPeer);
 }
 
+TEST(TlsConfigTest, ResumptionAndOffloadOffByDefault) {
+    TlsConfig cfg;
+    EXPECT_EQ(cfg.ticketKeys, nullptr);
+    EXPECT_FALSE(cfg.kernelOffload);
+    EXPECT_GT(cfg.ticketLifetime.count(), 0);
+}
+
+// ===========================================================================
+// TlsTicketKeyRing: shared session-ticket keys
+// ===========================================================================
+
+namespace {
+
+TlsTicketKey ticketKey(uint8_t seed) {
+    TlsTicketKey key;
+    key.name.fill(seed);
+    key.hmacSecret.fill(static_cast<uint8_t>(seed + 1));
+    key.aesKey.fill(static_cast<uint8_t>(seed + 2));
+    return key;
+}
+
+std::filesystem::path writeKeyFile(const std::string& name, const std::vector<uint8_t>& bytes) {
+    auto path = std::filesystem::temp_directory_path() / name;
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(bytes.data()),
+              static_cast<std::streamsize>(bytes.size()));
+    return path;
+}
+
+std::vector<uint8_t> keyRecord(const TlsTicketKey& key) {
+    std::vector<uint8_t> record(key.name.begin(), key.name.end());
+    record.insert(record.end(), key.hmacSecret.begin(), key.hmacSecret.end());
+    record.insert(record.end(), key.aesKey.begin(), key.aesKey.end());
+    return record;
+}
+
+}  // namespace
+
+TEST(TlsTicketKeyRingTest, FirstKeyEncryptsEveryKeyDecrypts) {
+    TlsTicketKeyRing ring;
+    EXPECT_TRUE(ring.empty());
+    EXPECT_FALSE(ring.encryptionKey().has_value());
+
+    ASSERT_TRUE(ring.setKeys({ticketKey(1), ticketKey(2)}).hasValue());
+    EXPECT_EQ(ring.encryptionKey(), ticketKey(1));
+    EXPECT_EQ(ring.find(ticketKey(2).name), ticketKey(2));
+    EXPECT_FALSE(ring.find(ticketKey(3).name).has_value());
+    EXPECT_EQ(ring.generation(), 1u);
+}
+
+TEST(TlsTicketKeyRingTest, SetKeysRejectsEmptyOversizedAndDuplicateLists) {
+    TlsTicketKeyRing ring;
+    EXPECT_EQ(ring.setKeys({}).error().code(), ErrorCode::InvalidArgument);
+    std::vector<TlsTicketKey> many;
+    for (uint8_t i = 0; i <= TlsTicketKeyRing::kMaxKeys; ++i) {
+        many.push_back(ticketKey(static_cast<uint8_t>(i * 3)));
+    }
+    EXPECT_EQ(ring.setKeys(many).error().code(), ErrorCode::InvalidArgument);
+    EXPECT_EQ(ring.setKeys({ticketKey(1), ticketKey(1)}).error().code(),
+              ErrorCode::InvalidArgument);
+    EXPECT_TRUE(ring.empty());
+    EXPECT_EQ(ring.generation(), 0u);
+}
+
+TEST(TlsTicketKeyRingTest, RotateKeepsPreviousKeysForDecryption) {
+    TlsTicketKeyRing ring;
+    for (uint8_t i = 1; i <= TlsTicketKeyRing::kMaxKeys + 1; ++i) {
+        ring.rotate(ticketKey(static_cast<uint8_t>(i * 3)));
+    }
+    EXPECT_EQ(ring.size(), TlsTicketKeyRing::kMaxKeys);
+    EXPECT_EQ(ring.encryptionKey(),
+              ticketKey(static_cast<uint8_t>((TlsTicketKeyRing::kMaxKeys + 1) * 3)));
+    EXPECT_TRUE(ring.find(ticketKey(6).name).has_value());
+    EXPECT_FALSE(ring.find(ticketKey(3).name).has_value());  // Oldest dropped.
+
+    // Re-promoting a key already in the ring does not duplicate it.
+    ring.rotate(ticketKey(6));
+    EXPECT_EQ(ring.size(), TlsTicketKeyRing::kMaxKeys);
+    EXPECT_EQ(ring.encryptionKey(), ticketKey(6));
+}
+
+TEST(TlsTicketKeyRingTest, ReplicasLoadingOneFileAgree) {
+    auto bytes = keyRecord(ticketKey(10));
+    auto staged = keyRecord(ticketKey(20));
+    bytes.insert(bytes.end(), staged.begin(), staged.end());
+    const auto path = writeKeyFile("cgs_ticket_keys_test.key", bytes);
+
+    TlsTicketKeyRing gatewayA;
+    TlsTicketKeyRing gatewayB;
+    ASSERT_TRUE(gatewayA.loadFile(path).hasValue());
+    ASSERT_TRUE(gatewayB.loadFile(path).hasValue());
+    EXPECT_EQ(gatewayA.encryptionKey(), ticketKey(10));
+    // A ticket issued by A resumes on B, and B already accepts the staged key.
+    EXPECT_EQ(gatewayB.find(gatewayA.encryptionKey()->name), ticketKey(10));
+    EXPECT_EQ(gatewayB.find(ticketKey(20).name), ticketKey(20));
+    std::filesystem::remove(path);
+}
+
+TEST(TlsTicketKeyRingTest, LoadFileRejectsPartialRecordsAndKeepsKeys) {
+    TlsTicketKeyRing ring;
+    ring.rotate(ticketKey(1));
+    auto bytes = keyRecord(ticketKey(2));
+    bytes.pop_back();
+    const auto path = writeKeyFile("cgs_ticket_keys_short.key", bytes);
+
+    auto result = ring.loadFile(path);
+    ASSERT_TRUE(result.hasError());
+    EXPECT_EQ(result.error().code(), ErrorCode::ConfigLoadFailed);
+    EXPECT_EQ(ring.encryptionKey(), ticketKey(1));
+    EXPECT_EQ(ring.loadFile(path.string() + ".missing").error().code(),
+              ErrorCode::ConfigLoadFailed);
+    std::filesystem::remove(path);
+}
+
+TEST(GameNetworkManagerTest, TlsListenRejectsTicketKeysUntilInstallable) {
+    GameNetworkManager mgr;
+    TlsConfig tls;
+    tls.certPath = "/path/to/cert.pem";
+    tls.keyPath = "/path/to/key.pem";
+    tls.ticketKeys = std::make_shared<TlsTicketKeyRing>();
+    tls.ticketKeys->rotate(ticketKey(1));
+
+    auto result = mgr.listen(8443, Protocol::TCP, tls);
+    ASSERT_TRUE(result.hasError());
+    EXPECT_EQ(result.error().code(), ErrorCode::TlsNotSupported);
+    EXPECT_EQ(mgr.stop(Protocol::TCP).error().code(), ErrorCode::NotFound);  // not listening
+}
+
+TEST(GameNetworkManagerTest, TlsListenRejectsKernelOffloadUntilSupported) {
+    GameNetworkManager mgr;
+    TlsConfig tls;
+    tls.certPath = "/path/to/cert.pem";
+    tls.keyPath = "/path/to/key.pem";
+    tls.kernelOffload = true;
+
+    auto result = mgr.listen(8443, Protocol::TCP, tls);
+    ASSERT_TRUE(result.hasError());
+    EXPECT_EQ(result.error().code(), ErrorCode::TlsNotSupported);
+    EXPECT_EQ(mgr.stop(Protocol::TCP).error().code(), ErrorCode::NotFound);  // not listening
+}
+
 // ===========================================================================
 // GameNetworkManager: TLS listen (SRS-NFR-015)
 // ===========================================================================
@@ -506,6 +1880,7 @@ TEST(TlsErrorCodeTest, SubsystemIsNetwork) {
     EXPECT_EQ(errorSubsystem(ErrorCode::TlsHandshakeFailed), "Network");
     EXPECT_EQ(errorSubsystem(ErrorCode::TlsCertificateInvalid), "Network");
     EXPECT_EQ(errorSubsystem(ErrorCode::TlsNotSupported), "Network");
+    EXPECT_EQ(errorSubsystem(ErrorCode::SendQueueFull), "Network");
 }
 
 // ===========================================================================
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+
+#include "cgs/foundation/game_metrics.hpp"
+#include "cgs/foundation/profiled_mutex.hpp"
+
+using namespace cgs::foundation;
+
+class ProfiledMutexTest : public ::testing::Test {
+protected:
+    void SetUp() override { LockProfiler::Reset(); }
+    void TearDown() override {
+        LockProfiler::Disable();
+        LockProfiler::Reset();
+    }
+};
+
+// ── Sites ───────────────────────────────────────────────────────────────────
+
+TEST_F(ProfiledMutexTest, InstancesWithTheSameNameShareASite) {
+    ProfiledMutex a("test.shared_site");
+    ProfiledMutex b("test.shared_site");
+    ProfiledMutex c("test.other_site");
+    EXPECT_NE(a.site(), LockProfiler::kUnnamed);
+    EXPECT_EQ(a.site(), b.site());
+    EXPECT_NE(a.site(), c.site());
+    EXPECT_EQ(LockProfiler::Name(a.site()), "test.shared_site");
+    EXPECT_EQ(ProfiledMutex().site(), LockProfiler::kUnnamed);
+}
+
+// ── Sampling ────────────────────────────────────────────────────────────────
+
+TEST_F(ProfiledMutexTest, DisabledRecordsNothing) {
+    ProfiledMutex mutex("test.disabled");
+    for (int i = 0; i < 100; ++i) {
+        std::lock_guard lock(mutex);
+    }
+    const auto stats = LockProfiler::Stats(mutex.site());
+    EXPECT_EQ(stats.wait.count, 0u);
+    EXPECT_EQ(stats.hold.count, 0u);
+    EXPECT_EQ(stats.contended, 0u);
+}
+
+TEST_F(ProfiledMutexTest, SamplesOneAcquisitionInN) {
+    ProfiledMutex mutex("test.sampled");
+    LockProfiler::Enable(4);
+    for (int i = 0; i < 400; ++i) {
+        std::lock_guard lock(mutex);
+    }
+    LockProfiler::Disable();
+
+    const auto stats = LockProfiler::Stats(mutex.site());
+    // The first sample may come early (the countdown starts at 1).
+    EXPECT_GE(stats.wait.count, 99u);
+    EXPECT_LE(stats.wait.count, 101u);
+    EXPECT_EQ(stats.hold.count, stats.wait.count);
+    EXPECT_EQ(stats.contended, 0u);
+}
+
+TEST_F(ProfiledMutexTest, HoldTimeLandsInTheRightBucket) {
+    ProfiledMutex mutex("test.hold");
+    LockProfiler::Enable(1);
+    {
+        std::lock_guard lock(mutex);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    LockProfiler::Disable();
+
+    const auto stats = LockProfiler::Stats(mutex.site());
+    ASSERT_EQ(stats.hold.count, 1u);
+    EXPECT_GE(stats.hold.sumNs, 2'000'000u);
+    // >= 2 ms falls past the 1024 us bound.
+    uint64_t below = 0;
+    for (std::size_t i = 0; i <= 5; ++i) {
+        below += stats.hold.buckets[i];
+    }
+    EXPECT_EQ(below, 0u);
+}
+
+TEST_F(ProfiledMutexTest, CountsContention) {
+    ProfiledMutex mutex("test.contended");
+    LockProfiler::Enable(1);
+
+    std::atomic<bool> held{false};
+    std::thread holder([&] {
+        std::lock_guard lock(mutex);
+        held = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    });
+    while (!held.load()) {
+        std::this_thread::yield();
+    }
+    {
+        std::lock_guard lock(mutex);  // Blocks until the holder is done.
+    }
+    holder.join();
+    LockProfiler::Disable();
+
+    const auto stats = LockProfiler::Stats(mutex.site());
+    EXPECT_EQ(stats.contended, 1u);
+    EXPECT_EQ(stats.wait.count, 2u);
+    EXPECT_GE(stats.wait.sumNs, 1'000'000u);
+}
+
+TEST_F(ProfiledMutexTest, SharedMutexRecordsSharedWaitsAndExclusiveHolds) {
+    ProfiledSharedMutex mutex("test.shared_mutex");
+    LockProfiler::Enable(1);
+    {
+        std::shared_lock lock(mutex);
+    }
+    {
+        std::unique_lock lock(mutex);
+    }
+    LockProfiler::Disable();
+
+    const auto stats = LockProfiler::Stats(mutex.site());
+    EXPECT_EQ(stats.wait.count, 2u);
+    EXPECT_EQ(stats.hold.count, 1u);
+}
+
+TEST_F(ProfiledMutexTest, WorksWithConditionVariableAny) {
+    ProfiledMutex mutex("test.condvar");
+    std::condition_variable_any ready;
+    bool flag = false;
+    LockProfiler::Enable(1);
+
+    std::thread setter([&] {
+        std::lock_guard lock(mutex);
+        flag = true;
+        ready.notify_one();
+    });
+    {
+        std::unique_lock lock(mutex);
+        ready.wait(lock, [&] { return flag; });
+    }
+    setter.join();
+    LockProfiler::Disable();
+    EXPECT_TRUE(flag);
+    EXPECT_GE(LockProfiler::Stats(mutex.site()).hold.count, 2u);
+}
+
+// ── Export ──────────────────────────────────────────────────────────────────
+
+TEST_F(ProfiledMutexTest, ScrapePublishesSitesWithData) {
+    ProfiledMutex mutex("test.scrape-site");
+    LockProfiler::Enable(1);
+    {
+        std::lock_guard lock(mutex);
+    }
+    LockProfiler::Disable();
+
+    GameMetrics metrics;
+    const std::string text = metrics.scrape();
+    EXPECT_NE(text.find("# TYPE cgs_lock_test_scrape_site_wait_us histogram"), std::string::npos);
+    EXPECT_NE(text.find("cgs_lock_test_scrape_site_wait_us_bucket{le=\"+Inf\"} 1"),
+              std::string::npos);
+    EXPECT_NE(text.find("cgs_lock_test_scrape_site_hold_us_count 1"), std::string::npos);
+    EXPECT_NE(text.find("cgs_lock_test_scrape_site_contended_total 0"), std::string::npos);
+    EXPECT_EQ(text.find("cgs_lock_test_disabled"), std::string::npos);
+}
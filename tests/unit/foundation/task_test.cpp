@@ -0,0 +1,209 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cgs/foundation/blocking_executor.hpp"
+#include "cgs/foundation/resume_queue.hpp"
+#include "cgs/foundation/task.hpp"
+
+using namespace cgs::foundation;
+using namespace std::chrono_literals;
+
+namespace {
+
+Task<int> answer() {
+    co_return 42;
+}
+
+Task<int> doubled() {
+    const int value = co_await answer();
+    co_return value * 2;
+}
+
+Task<std::string> failing() {
+    throw std::runtime_error("boom");
+    co_return std::string{};
+}
+
+Task<int> deepChain(int depth) {
+    if (depth == 0) {
+        co_return 0;
+    }
+    co_return 1 + co_await deepChain(depth - 1);
+}
+
+/// Callback-style API completing on @p executor.
+void addLater(BlockingExecutor& executor, int a, int b, std::function<void(int)> onDone) {
+    executor.post([a, b, onDone] { onDone(a + b); });
+}
+
+Task<int> addTask(BlockingExecutor& executor, int a, int b) {
+    co_return co_await awaitCallback<int>(
+        [&](auto complete) { addLater(executor, a, b, std::move(complete)); });
+}
+
+}  // namespace
+
+// ===========================================================================
+// Task<T>
+// ===========================================================================
+
+TEST(TaskTest, IsLazyUntilAwaited) {
+    bool started = false;
+    auto make = [&]() -> Task<void> {
+        started = true;
+        co_return;
+    };
+    auto task = make();
+    EXPECT_FALSE(started);
+    syncWait(std::move(task));
+    EXPECT_TRUE(started);
+}
+
+TEST(TaskTest, AwaitsNestedTasks) {
+    EXPECT_EQ(syncWait(doubled()), 84);
+}
+
+TEST(TaskTest, PropagatesExceptions) {
+    EXPECT_THROW(syncWait(failing()), std::runtime_error);
+}
+
+TEST(TaskTest, AwaitsLongChains) {
+    EXPECT_EQ(syncWait(deepChain(1000)), 1000);
+}
+
+TEST(TaskTest, DestroyingUnstartedTaskFreesFrame) {
+    auto token = std::make_shared<int>(0);
+    {
+        auto make = [](std::shared_ptr<int> held) -> Task<void> {
+            (void)held;
+            co_return;
+        };
+        auto task = make(token);
+        EXPECT_EQ(token.use_count(), 2);
+    }
+    EXPECT_EQ(token.use_count(), 1);
+}
+
+// ===========================================================================
+// awaitCallback
+// ===========================================================================
+
+TEST(TaskTest, AwaitCallbackCompletedInline) {
+    auto task = []() -> Task<int> {
+        co_return co_await awaitCallback<int>([](auto complete) { complete(7); });
+    };
+    EXPECT_EQ(syncWait(task()), 7);
+}
+
+TEST(TaskTest, AwaitCallbackResumesOnCompletingThread) {
+    BlockingExecutor executor(2);
+    EXPECT_EQ(syncWait(addTask(executor, 2, 3)), 5);
+}
+
+TEST(TaskTest, ThousandsOfConcurrentTasksOnFewThreads) {
+    constexpr int kTasks = 5000;
+    BlockingExecutor executor(4);
+    std::atomic<int> finished{0};
+    std::atomic<long> sum{0};
+
+    auto one = [&](int i) -> Task<void> {
+        const int value = co_await addTask(executor, i, 1);
+        sum.fetch_add(value);
+        finished.fetch_add(1);
+    };
+    for (int i = 0; i < kTasks; ++i) {
+        spawn(one(i));
+    }
+    while (finished.load() < kTasks) {
+        std::this_thread::sleep_for(1ms);
+    }
+    EXPECT_EQ(sum.load(), static_cast<long>(kTasks) * (kTasks + 1) / 2);
+    EXPECT_EQ(executor.threadCount(), 4u);
+}
+
+// ===========================================================================
+// ResumeQueue
+// ===========================================================================
+
+TEST(ResumeQueueTest, NextTickResumesOnDrainingThread) {
+    ResumeQueue queue;
+    BlockingExecutor executor(1);
+    std::thread::id resumedOn;
+    std::atomic<bool> done{false};
+
+    auto hop = [&]() -> Task<void> {
+        (void)co_await addTask(executor, 1, 1);  // Now on the executor thread
+        co_await queue.nextTick();               // Back on the draining thread
+        resumedOn = std::this_thread::get_id();
+        done.store(true);
+    };
+    spawn(hop());
+
+    while (queue.pending() == 0) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(queue.drain(), 1u);
+    EXPECT_TRUE(done.load());
+    EXPECT_EQ(resumedOn, std::this_thread::get_id());
+}
+
+TEST(ResumeQueueTest, ReentrantWaitsGoToNextDrain) {
+    ResumeQueue queue;
+    int ticks = 0;
+    auto loop = [&]() -> Task<void> {
+        for (int i = 0; i < 3; ++i) {
+            co_await queue.nextTick();
+            ++ticks;
+        }
+    };
+    spawn(loop());
+
+    for (int expected = 1; expected <= 3; ++expected) {
+        queue.drain();
+        EXPECT_EQ(ticks, expected);
+    }
+    EXPECT_EQ(queue.drain(), 0u);
+}
+
+TEST(ResumeQueueTest, SleepResumesInDeadlineOrder) {
+    ResumeQueue queue;
+    std::vector<int> order;
+    const auto start = ResumeQueue::Clock::now();
+
+    auto sleeper = [&](int id, std::chrono::milliseconds delay) -> Task<void> {
+        co_await queue.sleepUntil(start + delay);
+        order.push_back(id);
+    };
+    spawn(sleeper(3, 300ms));
+    spawn(sleeper(1, 100ms));
+    spawn(sleeper(2, 200ms));
+
+    EXPECT_EQ(queue.drain(start + 50ms), 0u);
+    EXPECT_EQ(queue.drain(start + 150ms), 1u);
+    EXPECT_EQ(queue.drain(start + 1s), 2u);
+    EXPECT_EQ(order, (std::vector<int>{1, 2, 3}));
+    EXPECT_EQ(queue.pending(), 0u);
+}
+
+// ===========================================================================
+// BlockingExecutor
+// ===========================================================================
+
+TEST(BlockingExecutorTest, DrainsQueuedWorkOnDestruction) {
+    std::atomic<int> ran{0};
+    {
+        BlockingExecutor executor(2);
+        for (int i = 0; i < 100; ++i) {
+            ASSERT_TRUE(executor.post([&ran] { ran.fetch_add(1); }));
+        }
+    }
+    EXPECT_EQ(ran.load(), 100);
+}
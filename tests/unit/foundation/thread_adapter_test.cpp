@@ -1,13 +1,19 @@
 #include <gtest/gtest.h>
 
+#include <array>
 #include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
 #include <string>
 #include <thread>
 #include <vector>
 
 #include "cgs/foundation/error_code.hpp"
 #include "cgs/foundation/job_scheduler.hpp"
+#include "cgs/foundation/task.hpp"
 
 using namespace cgs::foundation;
 using namespace std::chrono_literals;
@@ -254,6 +260,103 @@ TEST(GameJobSchedulerTest, MultipleTickJobsDifferentIntervals) {
     EXPECT_GE(slowTicks.load(), 1);
 }
 
+TEST(GameJobSchedulerTest, TickJobCatchesUpAtFixedRate) {
+    GameJobScheduler scheduler(0);  // No workers: due jobs run inside processTick()
+    int ticks = 0;
+    scheduler.scheduleTick(20ms, [&] { ++ticks; });
+
+    scheduler.processTick(100ms);
+    EXPECT_EQ(ticks, 5);
+
+    // 30ms steps: deadlines at 120, 140, 160 fall within the first two.
+    scheduler.processTick(30ms);
+    scheduler.processTick(30ms);
+    EXPECT_EQ(ticks, 8);
+}
+
+TEST(GameJobSchedulerTest, ScheduleDelayFiresOnce) {
+    GameJobScheduler scheduler(0);
+    int fired = 0;
+    ASSERT_TRUE(scheduler.scheduleDelay(30ms, [&] { ++fired; }).hasValue());
+
+    scheduler.processTick(20ms);
+    EXPECT_EQ(fired, 0);
+    scheduler.processTick(10ms);
+    EXPECT_EQ(fired, 1);
+    scheduler.processTick(100ms);
+    EXPECT_EQ(fired, 1);
+    EXPECT_EQ(scheduler.tickTime(), 130ms);
+}
+
+TEST(GameJobSchedulerTest, ScheduleAtUsesTickTime) {
+    GameJobScheduler scheduler(0);
+    std::vector<int> order;
+    scheduler.processTick(1000ms);
+
+    scheduler.scheduleAt(1500ms, [&] { order.push_back(2); });
+    scheduler.scheduleAt(1200ms, [&] { order.push_back(1); });
+    scheduler.scheduleAt(500ms, [&] { order.push_back(0); });  // Already passed
+
+    scheduler.processTick(0ms);
+    EXPECT_EQ(order, (std::vector<int>{0}));
+    scheduler.processTick(600ms);
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 2}));
+}
+
+TEST(GameJobSchedulerTest, CancelDelayedJob) {
+    GameJobScheduler scheduler(0);
+    int fired = 0;
+    auto id = scheduler.scheduleDelay(10ms, [&] { ++fired; });
+    ASSERT_TRUE(id.hasValue());
+
+    EXPECT_TRUE(scheduler.cancel(id.value()).hasValue());
+    auto again = scheduler.cancel(id.value());
+    ASSERT_TRUE(again.hasError());
+    EXPECT_EQ(again.error().code(), ErrorCode::JobNotFound);
+
+    scheduler.processTick(50ms);
+    EXPECT_EQ(fired, 0);
+}
+
+TEST(GameJobSchedulerTest, LongDelaysCascadeToTheirTick) {
+    GameJobScheduler scheduler(0);
+    std::vector<int64_t> firedAt;
+    auto record = [&] { firedAt.push_back(scheduler.tickTime().count()); };
+    scheduler.scheduleDelay(70005ms, record);                // Second level
+    scheduler.scheduleDelay(std::chrono::hours(2), record);  // Fourth level
+
+    for (int i = 0; i < 70; ++i) {
+        scheduler.processTick(1000ms);
+    }
+    scheduler.processTick(4ms);
+    EXPECT_TRUE(firedAt.empty());
+    scheduler.processTick(1ms);
+    ASSERT_EQ(firedAt.size(), 1u);
+    EXPECT_EQ(firedAt[0], 70005);
+
+    scheduler.processTick(std::chrono::hours(2));
+    EXPECT_EQ(firedAt.size(), 2u);
+}
+
+TEST(GameJobSchedulerTest, ManyTimersFireAtTheirDeadline) {
+    GameJobScheduler scheduler(0);
+    constexpr int kTimers = 20000;
+    int fired = 0;
+    int late = 0;
+    for (int i = 0; i < kTimers; ++i) {
+        const auto delay = std::chrono::milliseconds{(i * 7) % 3000};
+        scheduler.scheduleDelay(delay, [&scheduler, &fired, &late, delay] {
+            ++fired;
+            late += scheduler.tickTime() != delay ? 1 : 0;
+        });
+    }
+    for (int step = 0; step <= 3000; ++step) {
+        scheduler.processTick(step == 0 ? 0ms : 1ms);
+    }
+    EXPECT_EQ(fired, kTimers);
+    EXPECT_EQ(late, 0);
+}
+
 // ---------------------------------------------------------------------------
 // Job control: wait
 // ---------------------------------------------------------------------------
@@ -370,3 +473,333 @@ TEST(GameJobSchedulerTest, ScheduleAfterReturnsCorrectErrorCode) {
     EXPECT_EQ(result.error().code(), ErrorCode::JobNotFound);
     EXPECT_EQ(result.error().subsystem(), "Thread");
 }
+
+// ---------------------------------------------------------------------------
+// submit() (native work-stealing path)
+// ---------------------------------------------------------------------------
+
+TEST(InlineJobTest, SmallCallableIsStoredInline) {
+    int value = 0;
+    InlineJob job([&value] { value = 42; });
+    EXPECT_TRUE(job);
+    EXPECT_TRUE(job.isInline());
+    job();
+    EXPECT_EQ(value, 42);
+}
+
+TEST(InlineJobTest, LargeCallableFallsBackToHeap) {
+    std::array<uint64_t, 16> payload{};
+    payload.fill(3);
+    uint64_t sum = 0;
+    InlineJob job([payload, &sum] {
+        for (auto v : payload) {
+            sum += v;
+        }
+    });
+    EXPECT_FALSE(job.isInline());
+    job();
+    EXPECT_EQ(sum, 48u);
+}
+
+TEST(InlineJobTest, MoveTransfersCallable) {
+    int calls = 0;
+    InlineJob a([&calls] { ++calls; });
+    InlineJob b(std::move(a));
+    EXPECT_FALSE(a);  // NOLINT(bugprone-use-after-move)
+    ASSERT_TRUE(b);
+    b();
+    EXPECT_EQ(calls, 1);
+    b.reset();
+    EXPECT_FALSE(b);
+}
+
+TEST(GameJobSchedulerTest, SubmitAndWait) {
+    GameJobScheduler scheduler(4);
+    std::atomic<int> counter{0};
+    std::vector<GameJobScheduler::JobId> ids;
+    for (int i = 0; i < 1000; ++i) {
+        auto result = scheduler.submit([&counter] { counter.fetch_add(1); });
+        ASSERT_TRUE(result.hasValue());
+        ids.push_back(result.value());
+    }
+    for (auto id : ids) {
+        EXPECT_TRUE(scheduler.wait(id).hasValue());
+    }
+    EXPECT_EQ(counter.load(), 1000);
+
+    auto stats = scheduler.stats();
+    EXPECT_EQ(stats.submitted, 1000u);
+    EXPECT_EQ(stats.executed, 1000u);
+    EXPECT_EQ(stats.heapJobs, 0u);
+}
+
+TEST(GameJobSchedulerTest, PinnedWorkersStayOnTheirCpus) {
+    const CpuSet allowed = allowedCpus();
+    GameJobScheduler scheduler(2, allowed);
+    std::mutex mutex;
+    std::vector<CpuSet> seen;
+    std::vector<GameJobScheduler::JobId> ids;
+    for (int i = 0; i < 64; ++i) {
+        auto result = scheduler.submit([&] {
+            std::lock_guard lock(mutex);
+            seen.push_back(allowedCpus());
+        });
+        ASSERT_TRUE(result.hasValue());
+        ids.push_back(result.value());
+    }
+    for (auto id : ids) {
+        ASSERT_TRUE(scheduler.wait(id).hasValue());
+    }
+
+    // Each worker sits on one CPU of the set (wait() may also run jobs
+    // on this, unpinned, thread).
+    for (const auto& cpus : seen) {
+        if (cpus.size() == 1) {
+            EXPECT_TRUE(allowed.contains(cpus[0]));
+        } else {
+            EXPECT_EQ(cpus, allowed);
+        }
+    }
+}
+
+TEST(GameJobSchedulerTest, SubmitFromWorkerWaitsForChildren) {
+    GameJobScheduler scheduler(2);
+    std::atomic<int> children{0};
+    auto parent = scheduler.submit([&] {
+        std::vector<GameJobScheduler::JobId> ids;
+        for (int i = 0; i < 64; ++i) {
+            ids.push_back(scheduler.submit([&children] { children.fetch_add(1); }).value());
+        }
+        for (auto id : ids) {
+            (void)scheduler.wait(id);
+        }
+    });
+    ASSERT_TRUE(parent.hasValue());
+    EXPECT_TRUE(scheduler.wait(parent.value()).hasValue());
+    EXPECT_EQ(children.load(), 64);
+}
+
+TEST(GameJobSchedulerTest, SubmitCancelSemantics) {
+    GameJobScheduler scheduler(1);
+    std::atomic<bool> release{false};
+    std::atomic<bool> targetRan{false};
+
+    auto blocker = scheduler.submit([&] {
+        while (!release.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+    });
+    ASSERT_TRUE(blocker.hasValue());
+    auto target = scheduler.submit([&] { targetRan.store(true); });
+    ASSERT_TRUE(target.hasValue());
+
+    EXPECT_TRUE(scheduler.cancel(target.value()).hasValue());
+    release.store(true, std::memory_order_release);
+    EXPECT_TRUE(scheduler.wait(blocker.value()).hasValue());
+    EXPECT_TRUE(scheduler.wait(target.value()).hasValue());
+    EXPECT_FALSE(targetRan.load());
+    EXPECT_EQ(scheduler.stats().cancelled, 1u);
+
+    auto again = scheduler.cancel(blocker.value());
+    ASSERT_TRUE(again.hasError());
+    EXPECT_EQ(again.error().code(), ErrorCode::JobCancelled);
+}
+
+TEST(GameJobSchedulerTest, SubmitUnknownIdReturnsNotFound) {
+    GameJobScheduler scheduler(2);
+    constexpr GameJobScheduler::JobId kForeign = (uint64_t{1} << 63) | 12345;
+
+    auto waitResult = scheduler.wait(kForeign);
+    ASSERT_TRUE(waitResult.hasError());
+    EXPECT_EQ(waitResult.error().code(), ErrorCode::JobNotFound);
+
+    auto cancelResult = scheduler.cancel(kForeign);
+    ASSERT_TRUE(cancelResult.hasError());
+    EXPECT_EQ(cancelResult.error().code(), ErrorCode::JobNotFound);
+}
+
+TEST(GameJobSchedulerTest, ScheduleAfterSubmittedJob) {
+    GameJobScheduler scheduler(2);
+    std::atomic<int> order{0};
+    int firstSeen = -1;
+    int secondSeen = -1;
+
+    auto first = scheduler.submit([&] {
+        std::this_thread::sleep_for(20ms);
+        firstSeen = order.fetch_add(1);
+    });
+    ASSERT_TRUE(first.hasValue());
+    auto second = scheduler.scheduleAfter(first.value(), [&] { secondSeen = order.fetch_add(1); });
+    ASSERT_TRUE(second.hasValue());
+    EXPECT_TRUE(scheduler.wait(second.value()).hasValue());
+
+    EXPECT_EQ(firstSeen, 0);
+    EXPECT_EQ(secondSeen, 1);
+}
+
+TEST(GameJobSchedulerTest, SubmitCountsThrowingJobsAsFailed) {
+    GameJobScheduler scheduler(2);
+    auto result = scheduler.submit([] { throw std::runtime_error("boom"); });
+    ASSERT_TRUE(result.hasValue());
+    EXPECT_TRUE(scheduler.wait(result.value()).hasValue());
+    EXPECT_EQ(scheduler.stats().failed, 1u);
+}
+
+// ---------------------------------------------------------------------------
+// Job graphs, parallelFor, parallelReduce
+// ---------------------------------------------------------------------------
+
+TEST(JobGraphTest, FanInRunsAfterAllPredecessors) {
+    GameJobScheduler scheduler(4);
+    std::atomic<int> producers{0};
+    int seenAtJoin = -1;
+
+    JobGraph graph;
+    std::vector<JobGraph::NodeId> inputs;
+    for (int i = 0; i < 8; ++i) {
+        inputs.push_back(graph.add([&producers] {
+            std::this_thread::sleep_for(1ms);
+            producers.fetch_add(1);
+        }));
+    }
+    auto join = graph.add([&] { seenAtJoin = producers.load(); });
+    for (auto input : inputs) {
+        ASSERT_TRUE(graph.precede(input, join).hasValue());
+    }
+
+    ASSERT_TRUE(scheduler.run(graph).hasValue());
+    EXPECT_EQ(seenAtJoin, 8);
+}
+
+TEST(JobGraphTest, DiamondCanBeRunRepeatedly) {
+    GameJobScheduler scheduler(2);
+    std::vector<int> order;
+    std::mutex orderMutex;
+    auto record = [&](int step) {
+        std::lock_guard lock(orderMutex);
+        order.push_back(step);
+    };
+
+    JobGraph graph;
+    auto a = graph.add([&] { record(0); });
+    auto b = graph.add([&] { record(1); });
+    auto c = graph.add([&] { record(1); });
+    auto d = graph.add([&] { record(2); });
+    graph.precede(a, b);
+    graph.precede(a, c);
+    graph.precede(b, d);
+    graph.precede(c, d);
+
+    for (int run = 0; run < 3; ++run) {
+        order.clear();
+        ASSERT_TRUE(scheduler.run(graph).hasValue());
+        ASSERT_EQ(order.size(), 4u);
+        EXPECT_EQ(order.front(), 0);
+        EXPECT_EQ(order.back(), 2);
+    }
+}
+
+TEST(JobGraphTest, CycleIsRejected) {
+    GameJobScheduler scheduler(2);
+    JobGraph graph;
+    auto a = graph.add([] {});
+    auto b = graph.add([] {});
+    graph.precede(a, b);
+    graph.precede(b, a);
+
+    auto result = scheduler.run(graph);
+    ASSERT_TRUE(result.hasError());
+    EXPECT_EQ(result.error().code(), ErrorCode::JobDependencyFailed);
+}
+
+TEST(JobGraphTest, PrecedeUnknownNodeReturnsNotFound) {
+    JobGraph graph;
+    auto a = graph.add([] {});
+    auto result = graph.precede(a, 7);
+    ASSERT_TRUE(result.hasError());
+    EXPECT_EQ(result.error().code(), ErrorCode::JobNotFound);
+}
+
+TEST(GameJobSchedulerTest, ParallelForCoversRangeOnce) {
+    GameJobScheduler scheduler(4);
+    std::vector<std::atomic<int>> hits(10007);
+
+    scheduler.parallelFor(0, hits.size(), 64, [&](std::size_t first, std::size_t last) {
+        EXPECT_LE(last - first, 64u);
+        for (auto i = first; i < last; ++i) {
+            hits[i].fetch_add(1);
+        }
+    });
+
+    for (const auto& hit : hits) {
+        ASSERT_EQ(hit.load(), 1);
+    }
+}
+
+TEST(GameJobSchedulerTest, NestedParallelForFromJobs) {
+    GameJobScheduler scheduler(2);
+    std::atomic<int> total{0};
+
+    scheduler.parallelFor(0, 8, 1, [&](std::size_t, std::size_t) {
+        scheduler.parallelFor(0, 100, 10, [&](std::size_t first, std::size_t last) {
+            total.fetch_add(static_cast<int>(last - first));
+        });
+    });
+
+    EXPECT_EQ(total.load(), 800);
+}
+
+TEST(GameJobSchedulerTest, ParallelForRethrowsFirstException) {
+    GameJobScheduler scheduler(2);
+    EXPECT_THROW(scheduler.parallelFor(0, 100, 1,
+                                       [](std::size_t first, std::size_t) {
+                                           if (first == 50) {
+                                               throw std::runtime_error("chunk");
+                                           }
+                                       }),
+                 std::runtime_error);
+}
+
+TEST(GameJobSchedulerTest, ParallelReduceIsDeterministic) {
+    GameJobScheduler scheduler(4);
+    auto sum = scheduler.parallelReduce(
+        std::size_t{1}, std::size_t{100001}, 1000, uint64_t{0},
+        [](std::size_t first, std::size_t last) {
+            uint64_t partial = 0;
+            for (auto i = first; i < last; ++i) {
+                partial += i;
+            }
+            return partial;
+        },
+        [](uint64_t a, uint64_t b) { return a + b; });
+    EXPECT_EQ(sum, 5000050000u);
+
+    auto concat = scheduler.parallelReduce(
+        std::size_t{0}, std::size_t{10}, 3, std::string{},
+        [](std::size_t first, std::size_t) { return std::to_string(first); },
+        [](std::string a, const std::string& b) { return a + b; });
+    EXPECT_EQ(concat, "0369");
+}
+
+TEST(GameJobSchedulerTest, RunBatchExecutesAllTasks) {
+    GameJobScheduler scheduler(3);
+    std::atomic<int> ran{0};
+    std::vector<std::function<void()>> tasks(50, [&ran] { ran.fetch_add(1); });
+    scheduler.runBatch(tasks);
+    EXPECT_EQ(ran.load(), 50);
+}
+
+// ---------------------------------------------------------------------------
+// Coroutines
+// ---------------------------------------------------------------------------
+
+TEST(GameJobSchedulerTest, ResumeOnWorkerHopsThreads) {
+    GameJobScheduler scheduler(2);
+    const auto caller = std::this_thread::get_id();
+
+    auto hop = [&]() -> Task<std::thread::id> {
+        co_await scheduler.resumeOnWorker();
+        co_return std::this_thread::get_id();
+    };
+    EXPECT_NE(syncWait(hop()), caller);
+}
@@ -1,7 +1,10 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <cmath>
+#include <functional>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "cgs/ecs/component_storage.hpp"
@@ -13,8 +16,10 @@
 #include "cgs/game/ai_types.hpp"
 #include "cgs/game/behavior_tree.hpp"
 #include "cgs/game/combat_components.hpp"
+#include "cgs/game/compiled_behavior_tree.hpp"
 #include "cgs/game/components.hpp"
 #include "cgs/game/math_types.hpp"
+#include "cgs/game/pathfinding.hpp"
 
 using namespace cgs::ecs;
 using namespace cgs::game;
@@ -134,6 +139,80 @@ TEST(BlackboardTest, ConstAccess) {
     EXPECT_EQ(*val, 99);
 }
 
+TEST(BlackboardTest, InternedKeyAddressesTheStringEntry) {
+    const BlackboardKey<Entity> kTarget("target");
+    Blackboard bb;
+    bb.Set<Entity>("target", Entity(7, 0));
+
+    auto* viaKey = bb.Get(kTarget);
+    ASSERT_NE(viaKey, nullptr);
+    EXPECT_EQ(*viaKey, Entity(7, 0));
+    EXPECT_TRUE(bb.Has(kTarget));
+
+    bb.Set(kTarget, Entity(8, 0));
+    EXPECT_EQ(*bb.Get<Entity>("target"), Entity(8, 0));
+    EXPECT_EQ(BlackboardKey<Entity>("target").id, kTarget.id);
+
+    EXPECT_EQ(bb.Get(BlackboardKey<float>("target")), nullptr);  // wrong type
+    bb.Erase(kTarget);
+    EXPECT_FALSE(bb.Has("target"));
+}
+
+TEST(BlackboardTest, PodEntriesStayInline) {
+    Blackboard bb;
+    for (std::size_t i = 0; i < Blackboard::kInlineSlots; ++i) {
+        bb.Set<Vector3>("p" + std::to_string(i), Vector3(static_cast<float>(i), 0.0f, 0.0f));
+    }
+    EXPECT_TRUE(bb.IsInline());
+    EXPECT_EQ(bb.Size(), Blackboard::kInlineSlots);
+
+    // Past the inline slots the entries move, values intact.
+    bb.Set<std::vector<Vector3>>("waypoints", std::vector<Vector3>(3));
+    EXPECT_FALSE(bb.IsInline());
+    for (std::size_t i = 0; i < Blackboard::kInlineSlots; ++i) {
+        auto* p = bb.Get<Vector3>("p" + std::to_string(i));
+        ASSERT_NE(p, nullptr);
+        EXPECT_FLOAT_EQ(p->x, static_cast<float>(i));
+    }
+    ASSERT_NE(bb.Get<std::vector<Vector3>>("waypoints"), nullptr);
+    EXPECT_EQ(bb.Get<std::vector<Vector3>>("waypoints")->size(), 3u);
+}
+
+TEST(BlackboardTest, RetypingAnEntryReplacesIt) {
+    Blackboard bb;
+    bb.Set<std::string>("last_action", "patrol");
+    bb.Set<int>("last_action", 3);
+    EXPECT_EQ(bb.Get<std::string>("last_action"), nullptr);
+    ASSERT_NE(bb.Get<int>("last_action"), nullptr);
+    EXPECT_EQ(*bb.Get<int>("last_action"), 3);
+
+    bb.Set<std::string>("last_action", "flee");
+    EXPECT_EQ(bb.Get<int>("last_action"), nullptr);
+    EXPECT_EQ(*bb.Get<std::string>("last_action"), "flee");
+    EXPECT_EQ(bb.Size(), 1u);
+}
+
+TEST(BlackboardTest, EraseKeepsOtherEntries) {
+    Blackboard bb;
+    bb.Set<int>("a", 1);
+    bb.Set<std::string>("b", "two");
+    bb.Set<float>("c", 3.0f);
+    bb.Erase("a");
+    bb.Erase("never_set");
+
+    EXPECT_EQ(bb.Size(), 2u);
+    EXPECT_EQ(*bb.Get<std::string>("b"), "two");
+    EXPECT_FLOAT_EQ(*bb.Get<float>("c"), 3.0f);
+    auto keys = bb.Keys();
+    std::sort(keys.begin(), keys.end());
+    EXPECT_EQ(keys, (std::vector<std::string>{"b", "c"}));
+
+    // Copies are independent.
+    Blackboard copy = bb;
+    copy.Set<std::string>("b", "changed");
+    EXPECT_EQ(*bb.Get<std::string>("b"), "two");
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // BT leaf node tests
 // ═══════════════════════════════════════════════════════════════════════════
@@ -507,6 +586,174 @@ TEST(BTRepeaterTest, MaxRepeatsAccessor) {
     EXPECT_EQ(rep.MaxRepeats(), 5u);
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// CompiledBehaviorTree tests
+// ═══════════════════════════════════════════════════════════════════════════
+
+namespace {
+
+/// Node type unknown to the compiler; Running on every other tick.
+class AlternatingNode : public BTNode {
+public:
+    BTStatus Tick(BTContext&) override {
+        return (ticks_++ % 2 == 0) ? BTStatus::Running : BTStatus::Success;
+    }
+    void Reset() override { ticks_ = 0; }
+
+private:
+    uint32_t ticks_ = 0;
+};
+
+/// Leaf whose result cycles through a fixed pattern per entity, counted
+/// in the blackboard, and which logs its id when ticked.
+std::unique_ptr<BTNode> scriptedAction(uint32_t id, std::vector<uint32_t>& log) {
+    return std::make_unique<BTAction>([id, &log](BTContext& ctx) {
+        static constexpr BTStatus kPattern[] = {BTStatus::Success,
+                                                BTStatus::Running,
+                                                BTStatus::Failure,
+                                                BTStatus::Success,
+                                                BTStatus::Running};
+        const std::string key = "n" + std::to_string(id);
+        auto* n = ctx.blackboard->Get<uint32_t>(key);
+        const uint32_t count = n ? *n : 0;
+        ctx.blackboard->Set<uint32_t>(key, count + 1);
+        log.push_back(id);
+        return kPattern[(id * 3 + count) % 5];
+    });
+}
+
+std::unique_ptr<BTNode> scriptedCondition(uint32_t id, std::vector<uint32_t>& log) {
+    return std::make_unique<BTCondition>([id, &log](BTContext& ctx) {
+        const std::string key = "n" + std::to_string(id);
+        auto* n = ctx.blackboard->Get<uint32_t>(key);
+        const uint32_t count = n ? *n : 0;
+        ctx.blackboard->Set<uint32_t>(key, count + 1);
+        log.push_back(id);
+        return (id + count) % 3 != 0;
+    });
+}
+
+/// One tree using every node type.
+std::shared_ptr<BTNode> buildMixedTree(std::vector<uint32_t>& log) {
+    auto sequence = std::make_unique<BTSequence>();
+    sequence->AddChild(scriptedCondition(1, log));
+    sequence->AddChild(scriptedAction(2, log));
+    sequence->AddChild(std::make_unique<BTRepeater>(scriptedAction(3, log), 3));
+
+    auto all = std::make_unique<BTParallel>(BTParallelPolicy::RequireAll);
+    all->AddChild(scriptedAction(4, log));
+    all->AddChild(std::make_unique<BTInverter>(scriptedAction(5, log)));
+
+    auto one = std::make_unique<BTParallel>(BTParallelPolicy::RequireOne);
+    one->AddChild(scriptedCondition(6, log));
+    one->AddChild(std::make_unique<AlternatingNode>());
+
+    auto inner = std::make_unique<BTSequence>();
+    inner->AddChild(scriptedAction(7, log));
+    inner->AddChild(scriptedAction(8, log));
+
+    auto root = std::make_shared<BTSelector>();
+    root->AddChild(std::move(sequence));
+    root->AddChild(std::move(all));
+    root->AddChild(std::move(one));
+    root->AddChild(std::make_unique<BTRepeater>(std::move(inner), 2));
+    return root;
+}
+
+}  // namespace
+
+TEST(CompiledBehaviorTreeTest, FlattensInPreOrder) {
+    auto root = std::make_shared<BTSequence>();
+    root->AddChild(std::make_unique<BTCondition>([](BTContext&) { return true; }));
+    root->AddChild(std::make_unique<BTInverter>(
+        std::make_unique<BTAction>([](BTContext&) { return BTStatus::Failure; })));
+
+    auto tree = CompiledBehaviorTree::Compile(root);
+    ASSERT_NE(tree, nullptr);
+    const auto nodes = tree->Nodes();
+    ASSERT_EQ(nodes.size(), 4u);
+    EXPECT_EQ(nodes[0].op, BTOpcode::Sequence);
+    EXPECT_EQ(nodes[0].end, 4u);
+    EXPECT_EQ(nodes[1].op, BTOpcode::Condition);
+    EXPECT_EQ(nodes[1].end, 2u);  // next sibling
+    EXPECT_EQ(nodes[2].op, BTOpcode::Inverter);
+    EXPECT_EQ(nodes[3].op, BTOpcode::Action);
+    EXPECT_EQ(tree->HandlerCount(), 2u);
+    EXPECT_EQ(tree->StateSize(), 1u);  // the sequence cursor
+
+    std::vector<uint32_t> state(tree->StateSize());
+    BTContext ctx;
+    EXPECT_EQ(tree->Tick(ctx, state), BTStatus::Success);
+    EXPECT_EQ(CompiledBehaviorTree::Compile(nullptr), nullptr);
+}
+
+TEST(CompiledBehaviorTreeTest, MatchesPointerTree) {
+    std::vector<uint32_t> pointerLog;
+    std::vector<uint32_t> compiledLog;
+    auto pointerTree = buildMixedTree(pointerLog);
+    auto compiled = CompiledBehaviorTree::Compile(buildMixedTree(compiledLog));
+    ASSERT_NE(compiled, nullptr);
+
+    Blackboard pointerBoard;
+    Blackboard compiledBoard;
+    BTContext pointerCtx;
+    pointerCtx.blackboard = &pointerBoard;
+    BTContext compiledCtx;
+    compiledCtx.blackboard = &compiledBoard;
+    std::vector<uint32_t> state(compiled->StateSize());
+
+    for (int tick = 0; tick < 200; ++tick) {
+        ASSERT_EQ(compiled->Tick(compiledCtx, state), pointerTree->Tick(pointerCtx))
+            << "tick " << tick;
+        if (tick == 100) {
+            pointerTree->Reset();
+            compiled->Reset(state);
+        }
+    }
+    EXPECT_EQ(compiledLog, pointerLog);
+    EXPECT_GT(pointerLog.size(), 200u);
+}
+
+TEST(CompiledBehaviorTreeTest, AgentsSharingATreeKeepTheirOwnProgress) {
+    // Sequence(step, step): each step is Running on its first tick.
+    auto step = [](uint32_t id) {
+        return std::make_unique<BTAction>([id](BTContext& ctx) {
+            const std::string key = "s" + std::to_string(id);
+            if (ctx.blackboard->Has(key)) {
+                ctx.blackboard->Erase(key);
+                return BTStatus::Success;
+            }
+            ctx.blackboard->Set<bool>(key, true);
+            return BTStatus::Running;
+        });
+    };
+    auto root = std::make_shared<BTSequence>();
+    root->AddChild(step(1));
+    root->AddChild(step(2));
+    auto tree = CompiledBehaviorTree::Compile(root);
+
+    Blackboard boards[2];
+    std::vector<uint32_t> states[2] = {std::vector<uint32_t>(tree->StateSize()),
+                                       std::vector<uint32_t>(tree->StateSize())};
+    BTAgent agents[2];
+    for (int a = 0; a < 2; ++a) {
+        agents[a].context.blackboard = &boards[a];
+        agents[a].state = states[a];
+    }
+
+    // Agent 0 gets to its second step while agent 1 has not started.
+    EXPECT_EQ(tree->Tick(agents[0].context, agents[0].state), BTStatus::Running);
+    EXPECT_EQ(tree->Tick(agents[0].context, agents[0].state), BTStatus::Running);
+    EXPECT_TRUE(boards[0].Has("s2"));
+
+    // Agent 1 still starts at the first step.
+    tree->TickBatch(std::span<BTAgent>(agents, 2));
+    EXPECT_EQ(agents[0].status, BTStatus::Success);
+    EXPECT_EQ(agents[1].status, BTStatus::Running);
+    EXPECT_TRUE(boards[1].Has("s1"));
+    EXPECT_FALSE(boards[1].Has("s2"));
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // AIBrain component tests (SRS-GML-004.1)
 // ═══════════════════════════════════════════════════════════════════════════
@@ -673,6 +920,190 @@ TEST_F(AISystemTest, TimerResetsAfterTick) {
     EXPECT_FLOAT_EQ(brains.Get(e).timeSinceLastTick, 0.0f);
 }
 
+TEST_F(AISystemTest, TicksCompiledTreesBatchedPerTree) {
+    std::vector<uint32_t> ticked;
+    auto makeTree = [&ticked](uint32_t tag) {
+        auto root = std::make_shared<BTSequence>();
+        root->AddChild(std::make_unique<BTAction>([&ticked, tag](BTContext& ctx) {
+            ticked.push_back(tag * 100 + ctx.entity.id());
+            return BTStatus::Running;
+        }));
+        return CompiledBehaviorTree::Compile(root);
+    };
+    auto treeA = makeTree(1);
+    auto treeB = makeTree(2);
+
+    for (uint32_t id = 0; id < 4; ++id) {
+        createAIEntity(id, Vector3(0.0f, 0.0f, 0.0f));
+        brains.Get(Entity(id, 0)).compiledTree = (id % 2 == 0) ? treeA : treeB;
+    }
+    // A brain with only a pointer tree still runs alongside.
+    createAIEntity(4, Vector3(0.0f, 0.0f, 0.0f));
+
+    AISystem system(brains, transforms, movements, stats, threatLists, 0.1f);
+    system.Execute(0.1f);
+
+    EXPECT_EQ(system.GetLastTickUpdateCount(), 5u);
+    ASSERT_EQ(ticked.size(), 4u);
+    // Each tree's agents run together, in storage order.
+    const bool aFirst = ticked[0] / 100 == 1;
+    const std::vector<uint32_t> expected =
+        aFirst ? std::vector<uint32_t>{100, 102, 201, 203}
+               : std::vector<uint32_t>{201, 203, 100, 102};
+    EXPECT_EQ(ticked, expected);
+    EXPECT_EQ(brains.Get(Entity(0, 0)).treeState.size(), treeA->StateSize());
+    EXPECT_FLOAT_EQ(brains.Get(Entity(0, 0)).timeSinceLastTick, 0.0f);
+}
+
+TEST_F(AISystemTest, SharedTreeKeepsPerAgentProgress) {
+    // Sequence(step 1, step 2): each step is Running on its first tick.
+    std::vector<uint32_t> log;
+    auto step = [&log](uint32_t id) {
+        return std::make_unique<BTAction>([id, &log](BTContext& ctx) {
+            log.push_back(ctx.entity.id() * 10 + id);
+            const std::string key = "s" + std::to_string(id);
+            if (ctx.blackboard->Has(key)) {
+                ctx.blackboard->Erase(key);
+                return BTStatus::Success;
+            }
+            ctx.blackboard->Set<bool>(key, true);
+            return BTStatus::Running;
+        });
+    };
+    auto root = std::make_shared<BTSequence>();
+    root->AddChild(step(1));
+    root->AddChild(step(2));
+
+    for (uint32_t id = 0; id < 2; ++id) {
+        createAIEntity(id, Vector3(0.0f, 0.0f, 0.0f));
+        brains.Get(Entity(id, 0)).behaviorTree = root;
+    }
+    brains.Get(Entity(1, 0)).tickInterval = 10.0f;  // joins later
+
+    AISystem system(brains, transforms, movements, stats, threatLists, 0.1f);
+    system.Execute(0.1f);  // agent 0: step 1 Running
+    system.Execute(0.1f);  // agent 0: step 1 Success, step 2 Running
+    EXPECT_EQ(system.CompiledTreeCount(), 1u);
+
+    // Agent 1 starts at step 1 although agent 0 is parked on step 2.
+    brains.Get(Entity(1, 0)).tickInterval = 0.0f;
+    log.clear();
+    system.Execute(0.1f);
+    EXPECT_EQ(log, (std::vector<uint32_t>{2, 11}));
+    EXPECT_EQ(brains.Get(Entity(0, 0)).treeState.size(), 1u);
+    EXPECT_EQ(brains.Get(Entity(1, 0)).treeState[0], 0u);  // parked on its first child
+}
+
+TEST_F(AISystemTest, ReplacingATreeResetsStateAndReleasesTheOldOne) {
+    auto running = [] {
+        auto root = std::make_shared<BTSequence>();
+        root->AddChild(std::make_unique<BTAction>([](BTContext&) { return BTStatus::Success; }));
+        root->AddChild(std::make_unique<BTAction>([](BTContext&) { return BTStatus::Running; }));
+        return root;
+    };
+    Entity e = createAIEntity(0, Vector3(0.0f, 0.0f, 0.0f));
+    brains.Get(e).behaviorTree = running();
+
+    AISystem system(brains, transforms, movements, stats, threatLists, 0.0f);
+    system.Execute(0.1f);
+    EXPECT_EQ(brains.Get(e).treeState[0], 1u);  // parked on the second child
+    EXPECT_EQ(system.CompiledTreeCount(), 1u);
+
+    brains.Get(e).behaviorTree = running();
+    system.Execute(0.1f);
+    EXPECT_EQ(brains.Get(e).treeState[0], 1u);  // fresh state, same progress
+    EXPECT_EQ(system.CompiledTreeCount(), 1u);  // the old tree was dropped
+
+    brains.Get(e).behaviorTree.reset();
+    system.Execute(0.1f);
+    EXPECT_EQ(system.CompiledTreeCount(), 0u);
+}
+
+// ── Level of detail ─────────────────────────────────────────────────
+
+TEST_F(AISystemTest, LodTicksByDistanceAndSuspendsFarAgents) {
+    std::vector<uint32_t> ticks(3, 0);
+    SpatialIndex index;
+    const float distances[] = {5.0f, 50.0f, 500.0f};
+    for (uint32_t id = 0; id < 3; ++id) {
+        Entity e = createAIEntity(id, Vector3(distances[id], 0.0f, 0.0f));
+        brains.Get(e).behaviorTree = std::make_shared<BTAction>([&ticks](BTContext& ctx) {
+            ++ticks[ctx.entity.id()];
+            return BTStatus::Success;
+        });
+        index.Insert(e, transforms.Get(e).position);
+    }
+
+    AISystem system(brains, transforms, movements, stats, threatLists, 0.1f);
+    system.SetLodPolicy({{{100.0f, 0.5f}, {10.0f, 0.1f}}});  // sorted on set
+    EXPECT_TRUE(system.LodEnabled());
+    const AILodObserver player{Vector3(0.0f, 0.0f, 0.0f), &index};
+    system.SetLodObservers(std::span<const AILodObserver>(&player, 1));
+
+    for (int frame = 0; frame < 20; ++frame) {
+        system.Execute(0.1f);
+        EXPECT_EQ(system.GetLastAwakeCount(), 2u);
+    }
+    EXPECT_GE(ticks[0], 19u);  // every frame, after its phase
+    EXPECT_GE(ticks[1], 3u);
+    EXPECT_LE(ticks[1], 4u);
+    EXPECT_EQ(ticks[2], 0u);  // dormant
+    EXPECT_FLOAT_EQ(brains.Get(Entity(2, 0)).timeSinceLastTick, 0.0f);  // untouched
+
+    // Without observers every agent is dormant.
+    system.SetLodObservers({});
+    const auto before = ticks;
+    system.Execute(1.0f);
+    EXPECT_EQ(system.GetLastAwakeCount(), 0u);
+    EXPECT_EQ(ticks, before);
+}
+
+TEST_F(AISystemTest, LodSpreadsWakingAgentsOverTheInterval) {
+    constexpr uint32_t kCount = 100;
+    SpatialIndex index;
+    for (uint32_t id = 0; id < kCount; ++id) {
+        Entity e = createAIEntity(id, Vector3(static_cast<float>(id % 10), 0.0f, 0.0f));
+        index.Insert(e, transforms.Get(e).position);
+    }
+
+    AISystem system(brains, transforms, movements, stats, threatLists, 0.1f);
+    system.SetLodPolicy({{{50.0f, 1.0f}}});
+    const AILodObserver player{Vector3(0.0f, 0.0f, 0.0f), &index};
+    system.SetLodObservers(std::span<const AILodObserver>(&player, 1));
+
+    // One second at 10 Hz: each agent ticks once, about a tenth per frame.
+    uint32_t total = 0;
+    for (int frame = 0; frame < 10; ++frame) {
+        system.Execute(0.1f);
+        EXPECT_LE(system.GetLastTickUpdateCount(), 15u) << "frame " << frame;
+        total += system.GetLastTickUpdateCount();
+    }
+    EXPECT_EQ(total, kCount);
+}
+
+TEST_F(AISystemTest, LodUsesTheNearestObserver) {
+    std::vector<uint32_t> ticks(1, 0);
+    SpatialIndex index;
+    Entity e = createAIEntity(0, Vector3(100.0f, 0.0f, 0.0f));
+    brains.Get(e).behaviorTree = std::make_shared<BTAction>([&ticks](BTContext&) {
+        ++ticks[0];
+        return BTStatus::Success;
+    });
+    index.Insert(e, transforms.Get(e).position);
+
+    AISystem system(brains, transforms, movements, stats, threatLists, 0.1f);
+    system.SetLodPolicy({{{10.0f, 0.1f}, {200.0f, 10.0f}}});
+    const AILodObserver players[] = {{Vector3(0.0f, 0.0f, 0.0f), &index},
+                                     {Vector3(95.0f, 0.0f, 0.0f), &index}};
+    system.SetLodObservers(players);
+
+    for (int frame = 0; frame < 10; ++frame) {
+        system.Execute(0.1f);
+    }
+    EXPECT_GE(ticks[0], 9u);  // the close player sets the rate
+    EXPECT_FLOAT_EQ(brains.Get(e).lodDistanceSq, 25.0f);
+}
+
 // ── Built-in task tests (SRS-GML-004.3) ─────────────────────────────
 
 TEST_F(AISystemTest, MoveToTaskArrivesAtTarget) {
@@ -924,6 +1355,302 @@ TEST_F(AISystemTest, IdleTaskSetsIdleState) {
     EXPECT_FLOAT_EQ(movements.Get(e).direction.x, 0.0f);
 }
 
+// ── Pathfinding (SRS-GML-004.3) ─────────────────────────────────────
+
+namespace {
+
+/// World length of the polyline @p from -> @p waypoints.
+float polylineLength(Vector3 from, const std::vector<Vector3>& waypoints) {
+    float length = 0.0f;
+    for (const auto& point : waypoints) {
+        length += (point - from).Length();
+        from = point;
+    }
+    return length;
+}
+
+/// World length of a FindGridPath() result with 1-unit cells.
+float cellPathLength(NavCell from, const std::vector<NavCell>& cells) {
+    float length = 0.0f;
+    for (const auto& cell : cells) {
+        length += (cell.x != from.x && cell.y != from.y) ? std::sqrt(2.0f) : 1.0f;
+        from = cell;
+    }
+    return length;
+}
+
+}  // namespace
+
+TEST(PathfindingTest, FindGridPathRoutesAroundAWall) {
+    NavGrid grid(10, 10);
+    grid.SetWalkable({5, 0}, {5, 8}, false);
+
+    std::vector<NavCell> path;
+    ASSERT_TRUE(FindGridPath(grid, {0, 0}, {9, 0}, path));
+    ASSERT_FALSE(path.empty());
+    EXPECT_EQ(path.back(), (NavCell{9, 0}));
+
+    NavCell previous{0, 0};
+    bool passedGap = false;
+    for (const auto& cell : path) {
+        EXPECT_TRUE(grid.IsWalkable(cell));
+        EXPECT_LE(std::abs(cell.x - previous.x), 1);
+        EXPECT_LE(std::abs(cell.y - previous.y), 1);
+        passedGap = passedGap || (cell.x == 5 && cell.y == 9);
+        previous = cell;
+    }
+    EXPECT_TRUE(passedGap);
+}
+
+TEST(PathfindingTest, FindGridPathDoesNotCutCorners) {
+    NavGrid grid(3, 3);
+    grid.SetWalkable({1, 0}, false);
+
+    std::vector<NavCell> path;
+    ASSERT_TRUE(FindGridPath(grid, {0, 0}, {2, 0}, path));
+    // (0,0) -> (1,1) would clip the blocked cell's corner.
+    EXPECT_EQ(path.front(), (NavCell{0, 1}));
+}
+
+TEST(PathfindingTest, ServiceDeliversOnALaterUpdate) {
+    PathfindingService service(NavGrid(20, 20));
+    const Vector3 destination(15.3f, 0.0f, 2.7f);
+    auto id = service.Request(Vector3(1.5f, 0.0f, 1.5f), destination);
+
+    std::vector<Vector3> path;
+    EXPECT_EQ(service.Poll(id, path), PathStatus::Pending);
+    service.Update();  // dispatch
+    EXPECT_EQ(service.Poll(id, path), PathStatus::Pending);
+    service.Update();  // collect
+    ASSERT_EQ(service.Poll(id, path), PathStatus::Ready);
+    ASSERT_FALSE(path.empty());
+    EXPECT_FLOAT_EQ(path.back().x, destination.x);
+    EXPECT_FLOAT_EQ(path.back().z, destination.z);
+
+    // Consumed.
+    EXPECT_EQ(service.Poll(id, path), PathStatus::Unknown);
+    EXPECT_EQ(service.RequestCount(), 0u);
+}
+
+TEST(PathfindingTest, ServiceCachesByCell) {
+    PathfindingService service(NavGrid(20, 20));
+    std::vector<Vector3> path;
+
+    auto first = service.Request(Vector3(1.2f, 0.0f, 1.2f), Vector3(18.5f, 0.0f, 9.5f));
+    service.Update();
+    service.Update();
+    ASSERT_EQ(service.Poll(first, path), PathStatus::Ready);
+    EXPECT_EQ(service.CacheSize(), 1u);
+
+    // Other positions inside the same cells: answered in one Update.
+    auto second = service.Request(Vector3(1.8f, 0.0f, 1.7f), Vector3(18.1f, 0.0f, 9.9f));
+    service.Update();
+    ASSERT_EQ(service.Poll(second, path), PathStatus::Ready);
+    EXPECT_FLOAT_EQ(path.back().x, 18.1f);
+    EXPECT_EQ(service.CacheHits(), 1u);
+    EXPECT_EQ(service.SearchCount(), 1u);
+}
+
+TEST(PathfindingTest, ServiceCoalescesAPackChasingOneTarget) {
+    NavGrid grid(40, 40);
+    grid.SetWalkable({20, 0}, {20, 30}, false);
+    PathfindingService service(grid);
+
+    const Vector3 target(35.5f, 0.0f, 5.5f);
+    std::vector<PathRequestId> ids;
+    for (int i = 0; i < 8; ++i) {
+        ids.push_back(service.Request(Vector3(2.5f + static_cast<float>(i), 0.0f, 4.5f), target));
+    }
+    ids.push_back(service.Request(Vector3(2.5f, 0.0f, 4.5f), target));  // exact duplicate
+
+    service.Update();
+    service.Update();
+    EXPECT_EQ(service.SearchCount(), 1u);
+    EXPECT_EQ(service.CoalescedRequests(), 8u);
+
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        std::vector<Vector3> path;
+        ASSERT_EQ(service.Poll(ids[i], path), PathStatus::Ready) << i;
+        std::vector<NavCell> reference;
+        const NavCell start{2 + static_cast<int32_t>(i % 8), 4};
+        ASSERT_TRUE(FindGridPath(grid, start, {35, 5}, reference));
+        // Backward Dijkstra is optimal too.
+        EXPECT_NEAR(polylineLength(grid.CenterOf(start), path),
+                    cellPathLength(start, reference),
+                    0.01f)
+            << i;
+    }
+}
+
+TEST(PathfindingTest, ServiceRunsSearchesThroughTheSubmitter) {
+    PathfindingService service(NavGrid(20, 20));
+    std::vector<std::function<void()>> jobs;
+    service.SetJobSubmitter([&jobs](std::function<void()> job) { jobs.push_back(std::move(job)); });
+
+    auto id = service.Request(Vector3(0.5f, 0.0f, 0.5f), Vector3(10.5f, 0.0f, 10.5f));
+    service.Update();
+    ASSERT_EQ(jobs.size(), 1u);
+
+    std::vector<Vector3> path;
+    service.Update();  // job not run yet
+    EXPECT_EQ(service.Poll(id, path), PathStatus::Pending);
+
+    jobs.front()();
+    service.Update();
+    EXPECT_EQ(service.Poll(id, path), PathStatus::Ready);
+}
+
+TEST(PathfindingTest, ServiceResearchesAfterTheGridChanges) {
+    PathfindingService service(NavGrid(20, 20));
+    std::vector<std::function<void()>> jobs;
+    service.SetJobSubmitter([&jobs](std::function<void()> job) { jobs.push_back(std::move(job)); });
+
+    auto id = service.Request(Vector3(0.5f, 0.0f, 10.5f), Vector3(19.5f, 0.0f, 10.5f));
+    service.Update();
+
+    NavGrid walled(20, 20);
+    walled.SetWalkable({10, 0}, {10, 18}, false);
+    service.SetGrid(walled);
+    for (auto& job : jobs) {
+        job();  // searched the old grid; discarded
+    }
+    jobs.clear();
+    service.Update();
+    ASSERT_EQ(jobs.size(), 1u);
+    jobs.front()();
+    service.Update();
+
+    std::vector<Vector3> path;
+    ASSERT_EQ(service.Poll(id, path), PathStatus::Ready);
+    // The old grid's path was a straight line; the new one detours
+    // through the gap at the top row.
+    bool throughGap = false;
+    for (const auto& point : path) {
+        throughGap = throughGap || walled.CellOf(point).y == 19;
+    }
+    EXPECT_TRUE(throughGap);
+}
+
+TEST(PathfindingTest, LongPathsStayCloseToOptimal) {
+    // Staggered walls force long detours across many clusters.
+    NavGrid grid(128, 128);
+    for (int32_t x = 16; x < 128; x += 24) {
+        if ((x / 24) % 2 == 0) {
+            grid.SetWalkable({x, 0}, {x, 110}, false);
+        } else {
+            grid.SetWalkable({x, 17}, {x, 127}, false);
+        }
+    }
+    PathfindingService service(grid);
+
+    const NavCell start{2, 64};
+    const NavCell goal{125, 64};
+    auto id = service.Request(grid.CenterOf(start), grid.CenterOf(goal));
+    service.Update();
+    service.Update();
+
+    std::vector<Vector3> path;
+    ASSERT_EQ(service.Poll(id, path), PathStatus::Ready);
+    std::vector<NavCell> reference;
+    ASSERT_TRUE(FindGridPath(grid, start, goal, reference));
+    const float optimal = cellPathLength(start, reference);
+    const float hierarchical = polylineLength(grid.CenterOf(start), path);
+    EXPECT_GE(hierarchical, optimal - 0.01f);
+    EXPECT_LE(hierarchical, optimal * 1.1f);
+}
+
+TEST(PathfindingTest, UnreachableAndInvalidRequestsAreNotFound) {
+    NavGrid grid(100, 100);
+    // Box in the far corner.
+    grid.SetWalkable({80, 80}, {99, 80}, false);
+    grid.SetWalkable({80, 80}, {80, 99}, false);
+    grid.SetWalkable({10, 10}, false);
+    PathfindingService service(grid);
+
+    auto boxed = service.Request(Vector3(1.5f, 0.0f, 1.5f), Vector3(90.5f, 0.0f, 90.5f));
+    auto blocked = service.Request(Vector3(1.5f, 0.0f, 1.5f), Vector3(10.5f, 0.0f, 10.5f));
+    auto outside = service.Request(Vector3(1.5f, 0.0f, 1.5f), Vector3(-5.0f, 0.0f, 1.5f));
+    service.Update();
+    service.Update();
+
+    std::vector<Vector3> path;
+    EXPECT_EQ(service.Poll(boxed, path), PathStatus::NotFound);
+    EXPECT_EQ(service.Poll(blocked, path), PathStatus::NotFound);
+    EXPECT_EQ(service.Poll(outside, path), PathStatus::NotFound);
+    EXPECT_EQ(service.RequestCount(), 0u);
+}
+
+TEST(PathfindingTest, CancelledRequestsAreDropped) {
+    PathfindingService service(NavGrid(20, 20));
+    auto id = service.Request(Vector3(0.5f, 0.0f, 0.5f), Vector3(10.5f, 0.0f, 10.5f));
+    service.Cancel(id);
+    service.Update();
+    service.Update();
+
+    std::vector<Vector3> path;
+    EXPECT_EQ(service.Poll(id, path), PathStatus::Unknown);
+    EXPECT_EQ(service.SearchCount(), 0u);
+}
+
+TEST_F(AISystemTest, MoveToTaskFollowsServicePath) {
+    Entity e = createAIEntity(0, Vector3(2.5f, 0.0f, 5.5f));
+
+    NavGrid grid(20, 20);
+    grid.SetWalkable({5, 0}, {5, 15}, false);
+    PathfindingService service(grid);
+
+    AISystem system(brains, transforms, movements, stats, threatLists, 0.0f);
+    system.SetPathfindingResolver([&service](Entity) { return &service; });
+    auto moveToTask = system.CreateMoveToTask();
+
+    Blackboard bb;
+    bb.Set<Vector3>("move_target", Vector3(8.5f, 0.0f, 5.5f));
+    BTContext ctx{e, 0.016f, &bb};
+
+    // Path pending: steer straight at the target.
+    EXPECT_EQ(moveToTask->Tick(ctx), BTStatus::Running);
+    EXPECT_GT(movements.Get(e).direction.x, 0.99f);
+
+    service.Update();
+    service.Update();
+
+    // Path ready: head for the gap at the wall's far end (+Z).
+    EXPECT_EQ(moveToTask->Tick(ctx), BTStatus::Running);
+    EXPECT_GT(movements.Get(e).direction.z, 0.5f);
+    EXPECT_EQ(service.RequestCount(), 0u);
+
+    // Walk the waypoints.
+    auto path = *bb.Get<std::vector<Vector3>>("path");
+    for (const auto& point : path) {
+        transforms.Get(e).position = point;
+        moveToTask->Tick(ctx);
+    }
+    EXPECT_EQ(movements.Get(e).state, MovementState::Idle);
+    EXPECT_FALSE(bb.Has("path"));
+}
+
+TEST_F(AISystemTest, MoveToTaskFailsWhenNoPathExists) {
+    Entity e = createAIEntity(0, Vector3(2.5f, 0.0f, 5.5f));
+
+    NavGrid grid(20, 20);
+    grid.SetWalkable({5, 0}, {5, 19}, false);
+    PathfindingService service(grid);
+
+    AISystem system(brains, transforms, movements, stats, threatLists, 0.0f);
+    system.SetPathfindingResolver([&service](Entity) { return &service; });
+    auto moveToTask = system.CreateMoveToTask();
+
+    Blackboard bb;
+    bb.Set<Vector3>("move_target", Vector3(8.5f, 0.0f, 5.5f));
+    BTContext ctx{e, 0.016f, &bb};
+
+    EXPECT_EQ(moveToTask->Tick(ctx), BTStatus::Running);
+    service.Update();
+    service.Update();
+    EXPECT_EQ(moveToTask->Tick(ctx), BTStatus::Failure);
+    EXPECT_EQ(movements.Get(e).state, MovementState::Idle);
+}
+
 // ── System metadata tests ───────────────────────────────────────────
 
 TEST_F(AISystemTest, SystemMetadata) {
@@ -1043,6 +1770,43 @@ TEST(AIIntegration, SchedulerRegistration) {
     scheduler.Execute(1.0f / 60.0f);
 }
 
+TEST(AIIntegration, SlicedSystemSplitsBrainsAcrossTicks) {
+    ComponentStorage<AIBrain> brains;
+    ComponentStorage<Transform> transforms;
+    ComponentStorage<Movement> movements;
+    ComponentStorage<Stats> stats;
+    ComponentStorage<ThreatList> threatLists;
+
+    std::vector<std::vector<uint32_t>> ticked(1);
+    auto tree = std::make_shared<BTAction>([&ticked](BTContext& ctx) {
+        ticked.back().push_back(ctx.entity.id());
+        return BTStatus::Success;
+    });
+    for (uint32_t i = 0; i < 4; ++i) {
+        AIBrain brain;
+        brain.behaviorTree = tree;
+        brains.Add(Entity(i, 0), std::move(brain));
+    }
+
+    SystemScheduler scheduler;
+    scheduler.Register<AISystem>(brains, transforms, movements, stats, threatLists, 0.1f);
+    scheduler.SetUpdateSlices(SystemType<AISystem>::Id(), 2);
+    ASSERT_TRUE(scheduler.Build());
+
+    for (int tick = 0; tick < 4; ++tick) {
+        scheduler.Execute(0.1f);
+        std::sort(ticked.back().begin(), ticked.back().end());
+        ticked.emplace_back();
+    }
+
+    // Even ids on even ticks, odd ids on odd ticks, each still due
+    // because its slice receives the time since it last ran.
+    EXPECT_EQ(ticked[0], (std::vector<uint32_t>{0, 2}));
+    EXPECT_EQ(ticked[1], (std::vector<uint32_t>{1, 3}));
+    EXPECT_EQ(ticked[2], (std::vector<uint32_t>{0, 2}));
+    EXPECT_EQ(ticked[3], (std::vector<uint32_t>{1, 3}));
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // Performance test: throttled AI on many entities (SRS-GML-004.4)
 // ═══════════════════════════════════════════════════════════════════════════
@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <random>
+#include <vector>
+
 #include "cgs/ecs/component_storage.hpp"
 #include "cgs/ecs/entity.hpp"
 #include "cgs/ecs/entity_manager.hpp"
@@ -85,6 +89,132 @@ TEST(SpellCastTest, StateTransitionCastingToComplete) {
     EXPECT_FLOAT_EQ(casts.Get(e).remainingTime, 0.0f);
 }
 
+TEST(SpellCastTest, CompletedCastsAreReportedAsOneBatch) {
+    ComponentStorage<SpellCast> casts;
+    ComponentStorage<AuraHolder> auras;
+    ComponentStorage<DamageEvent> damages;
+    ComponentStorage<Stats> stats;
+    ComponentStorage<ThreatList> threats;
+
+    // Enough casters for full SIMD groups plus a tail; every third one
+    // finishes this tick, and one finished cast is already interrupted.
+    constexpr uint32_t kCasters = 11;
+    for (uint32_t i = 0; i < kCasters; ++i) {
+        casts.Add(Entity(i, 0)).Begin(100 + i, Entity(50 + i, 0), i % 3 == 0 ? 0.2f : 1.0f);
+    }
+    casts.Get(Entity(3, 0)).Interrupt();
+    casts.Add(Entity(kCasters, 0));  // Idle
+
+    CombatSystem system(casts, auras, damages, stats, threats);
+    system.Execute(0.25f);
+
+    std::vector<uint32_t> completed;
+    for (const CastCompletion& done : system.CastCompletions()) {
+        EXPECT_EQ(done.spellId, 100 + done.caster.id());
+        EXPECT_EQ(done.target, Entity(50 + done.caster.id(), 0));
+        completed.push_back(done.caster.id());
+    }
+    EXPECT_EQ(completed, (std::vector<uint32_t>{0, 6, 9}));
+    for (uint32_t i = 0; i < kCasters; ++i) {
+        const SpellCast& cast = casts.Get(Entity(i, 0));
+        if (i == 3) {
+            EXPECT_EQ(cast.state, CastState::Interrupted);
+        } else if (i % 3 == 0) {
+            EXPECT_EQ(cast.state, CastState::Complete);
+        } else {
+            EXPECT_EQ(cast.state, CastState::Casting);
+            EXPECT_NEAR(cast.remainingTime, 0.75f, 1e-5f);
+        }
+    }
+
+    // The batch holds only the last tick's completions.
+    system.Execute(0.25f);
+    EXPECT_TRUE(system.CastCompletions().empty());
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// AbilityCooldowns tests
+// ═══════════════════════════════════════════════════════════════════════════
+
+TEST(AbilityCooldownsTest, SlotAndGlobalCooldowns) {
+    AbilityCooldowns cooldowns;
+    EXPECT_TRUE(cooldowns.IsIdle());
+    EXPECT_TRUE(cooldowns.IsReady(3));
+
+    cooldowns.Start(3, 8.0f);
+    EXPECT_FALSE(cooldowns.IsSlotReady(3));
+    EXPECT_TRUE(cooldowns.IsReady(4));
+    EXPECT_FLOAT_EQ(cooldowns.Remaining(3), 8.0f);
+
+    cooldowns.StartGlobal(1.5f);
+    cooldowns.StartGlobal(1.0f);  // Shorter one does not cut it
+    EXPECT_FLOAT_EQ(cooldowns.globalRemaining, 1.5f);
+    EXPECT_FALSE(cooldowns.IsReady(4));
+    EXPECT_TRUE(cooldowns.IsSlotReady(4));
+
+    cooldowns.Clear(3);
+    EXPECT_TRUE(cooldowns.IsSlotReady(3));
+    cooldowns.ClearAll();
+    EXPECT_TRUE(cooldowns.IsIdle());
+}
+
+TEST(AbilityCooldownsTest, UseAbilityChecksGlobalThenSlotCooldown) {
+    ComponentStorage<SpellCast> casts;
+    ComponentStorage<AuraHolder> auras;
+    ComponentStorage<DamageEvent> damages;
+    ComponentStorage<Stats> stats;
+    ComponentStorage<ThreatList> threats;
+    ComponentStorage<AbilityCooldowns> cooldowns;
+
+    const Entity mage(0, 0);
+    const Entity boss(1, 0);
+    casts.Add(mage);
+    cooldowns.Add(mage);
+
+    CombatSystem system(casts, auras, damages, stats, threats);
+    system.SetCooldowns(&cooldowns);
+
+    const AbilityUse fireball{.slot = 2,
+                              .spellId = 133,
+                              .target = boss,
+                              .castTime = 0.5f,
+                              .cooldown = 4.0f,
+                              .globalCooldown = 1.5f};
+    AbilityUse blink = fireball;  // Instant, off the global cooldown
+    blink.slot = 5;
+    blink.spellId = 1953;
+    blink.castTime = 0.0f;
+    blink.cooldown = 15.0f;
+    blink.globalCooldown = 0.0f;
+
+    EXPECT_EQ(system.UseAbility(mage, fireball), AbilityUseResult::Started);
+    EXPECT_EQ(system.UseAbility(mage, fireball), AbilityUseResult::OnGlobalCooldown);
+    EXPECT_EQ(system.UseAbility(mage, blink), AbilityUseResult::Busy);
+    EXPECT_EQ(system.UseAbility(boss, fireball), AbilityUseResult::NoCaster);
+    blink.slot = kAbilitySlots;
+    EXPECT_EQ(system.UseAbility(mage, blink), AbilityUseResult::InvalidSlot);
+    blink.slot = 5;
+
+    system.Execute(1.0f);  // Fireball lands; 0.5 s of global cooldown left
+    ASSERT_EQ(system.CastCompletions().size(), 1u);
+    EXPECT_EQ(system.CastCompletions()[0].spellId, 133u);
+    casts.Get(mage).Reset();
+    EXPECT_EQ(system.UseAbility(mage, blink), AbilityUseResult::Started);
+
+    system.Execute(1.0f);  // Global cooldown over, fireball slot has 2 s left
+    casts.Get(mage).Reset();
+    EXPECT_TRUE(cooldowns.Get(mage).IsSlotReady(1));
+    EXPECT_FLOAT_EQ(cooldowns.Get(mage).globalRemaining, 0.0f);
+    EXPECT_NEAR(cooldowns.Get(mage).Remaining(2), 2.0f, 1e-5f);
+    EXPECT_NEAR(cooldowns.Get(mage).Remaining(5), 14.0f, 1e-5f);
+    EXPECT_EQ(system.UseAbility(mage, fireball), AbilityUseResult::OnCooldown);
+
+    system.Execute(2.0f);
+    EXPECT_FALSE(cooldowns.Get(mage).IsSlotReady(5));
+    EXPECT_EQ(cooldowns.Get(mage).coolingSlots, 1u << 5);
+    EXPECT_EQ(system.UseAbility(mage, fireball), AbilityUseResult::Started);
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // AuraHolder component tests (SRS-GML-002.2)
 // ═══════════════════════════════════════════════════════════════════════════
@@ -337,6 +467,36 @@ TEST(DamageCalcTest, CritWithArmor) {
     EXPECT_EQ(damage, 100);
 }
 
+TEST(DamageCalcTest, BatchMatchesCalculateDamage) {
+    // 103 rows: full four-row blocks plus a scalar tail.
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int32_t> base(-50, 20000);
+    std::uniform_int_distribution<int32_t> stat(-100, 3000);
+    std::uniform_int_distribution<int> type(0, static_cast<int>(kDamageTypeCount) - 1);
+
+    DamageBatch batch;
+    std::vector<int32_t> expected;
+    for (int i = 0; i < 103; ++i) {
+        DamageCalcParams params;
+        params.armor = stat(rng);
+        for (auto& resistance : params.resistances) {
+            resistance = stat(rng);
+        }
+        const int32_t baseDamage = i % 17 == 0 ? 0 : base(rng);
+        const auto damageType = static_cast<DamageType>(type(rng));
+        const bool isCritical = i % 3 == 0;
+        batch.Add(baseDamage, damageType, isCritical, params);
+        expected.push_back(CombatSystem::CalculateDamage(baseDamage, damageType, isCritical, params));
+    }
+
+    CombatSystem::CalculateDamageBatch(batch);
+    EXPECT_EQ(batch.finalDamage, expected);
+
+    batch.Clear();
+    CombatSystem::CalculateDamageBatch(batch);
+    EXPECT_TRUE(batch.finalDamage.empty());
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // DamageEvent processing tests (SRS-GML-002.4)
 // ═══════════════════════════════════════════════════════════════════════════
@@ -426,6 +586,29 @@ TEST_F(CombatSystemTest, MagicDamageUsesResistance) {
     EXPECT_EQ(damageEvents.Get(dmgEntity).finalDamage, 50);
 }
 
+TEST_F(CombatSystemTest, EquipmentStatsAddToMitigation) {
+    ComponentStorage<EquipmentStats> gear;
+    EquipmentStats victimGear;
+    victimGear.bonuses.armor = 200;
+    victimGear.bonuses.attributes[static_cast<std::size_t>(DamageType::Fire) + 1] = 200;
+    victimGear.dirty = false;
+    gear.Add(victim, victimGear);
+
+    Entity physical(2, 0);
+    Entity fire(3, 0);
+    damageEvents.Add(physical, DamageEvent{attacker, victim, DamageType::Physical, 100});
+    damageEvents.Add(fire, DamageEvent{attacker, victim, DamageType::Fire, 100});
+
+    CombatSystem system(spellCasts, auraHolders, damageEvents, stats, threatLists);
+    system.SetEquipmentStats(&gear);
+    system.Execute(0.016f);
+
+    // Armor 100 + 200 from gear: 300/(300+400) mitigated.
+    EXPECT_EQ(damageEvents.Get(physical).finalDamage, 57);
+    // Fire resistance only from gear: 50%.
+    EXPECT_EQ(damageEvents.Get(fire).finalDamage, 50);
+}
+
 TEST_F(CombatSystemTest, CriticalHit) {
     Entity dmgEntity(2, 0);
     DamageEvent event;
@@ -459,6 +642,161 @@ TEST_F(CombatSystemTest, HealthDoesNotGoBelowZero) {
     EXPECT_EQ(stats.Get(victim).health, 0);  // Clamped by Stats::SetHealth.
 }
 
+TEST_F(CombatSystemTest, AppliesEventsFromDamageChannel) {
+    EventChannel<DamageEvent> channel;
+    for (int i = 0; i < 2; ++i) {
+        DamageEvent event;
+        event.attacker = attacker;
+        event.victim = victim;
+        event.type = DamageType::Physical;
+        event.baseDamage = 100;
+        channel.Send(std::move(event));
+    }
+    channel.Swap();
+
+    CombatSystem system(spellCasts, auraHolders, damageEvents, stats, threatLists);
+    system.SetDamageChannel(&channel);
+    EXPECT_TRUE(system.GetAccessInfo().eventReads.contains(ComponentType<DamageEvent>::Id()));
+    system.Execute(0.016f);
+
+    // Two hits of 100 * (1 - 100/500) = 80 each, no event entities needed.
+    EXPECT_EQ(stats.Get(victim).health, 1000 - 2 * 80);
+    EXPECT_GT(threatLists.Get(victim).GetThreat(attacker), 0.0f);
+    EXPECT_EQ(damageEvents.Size(), 0u);
+}
+
+TEST_F(CombatSystemTest, ResolvesInterleavedHitsPerVictim) {
+    // A second victim with fire resistance, hit alongside the first.
+    Entity other(5, 0);
+    Stats otherStats;
+    otherStats.maxHealth = 500;
+    otherStats.health = 500;
+    otherStats.attributes[static_cast<std::size_t>(DamageType::Fire) + 1] = 200;
+    stats.Add(other, std::move(otherStats));
+    threatLists.Add(other);
+    Entity healer(6, 0);
+
+    EventChannel<DamageEvent> channel;
+    const auto hit = [&](Entity from, Entity to, DamageType type, int32_t amount) {
+        DamageEvent event;
+        event.attacker = from;
+        event.victim = to;
+        event.type = type;
+        event.baseDamage = amount;
+        return event;
+    };
+    channel.Send(hit(attacker, other, DamageType::Fire, 100));       // 50
+    channel.Send(hit(attacker, victim, DamageType::Physical, 100));  // 80
+    channel.Send(hit(healer, other, DamageType::Fire, 40));          // 20
+    channel.Send(hit(healer, victim, DamageType::Physical, 0));      // 0
+    channel.Swap();
+    Entity dmgEntity(2, 0);
+    damageEvents.Add(dmgEntity, hit(healer, victim, DamageType::Physical, 50));  // 40
+
+    CombatSystem system(spellCasts, auraHolders, damageEvents, stats, threatLists);
+    system.SetDamageChannel(&channel);
+    system.Execute(0.016f);
+
+    EXPECT_EQ(stats.Get(victim).health, 1000 - 80 - 40);
+    EXPECT_EQ(stats.Get(other).health, 500 - 50 - 20);
+    EXPECT_EQ(damageEvents.Get(dmgEntity).finalDamage, 40);
+    EXPECT_TRUE(damageEvents.Get(dmgEntity).isProcessed);
+    EXPECT_FLOAT_EQ(threatLists.Get(victim).GetThreat(attacker), 80.0f);
+    EXPECT_FLOAT_EQ(threatLists.Get(victim).GetThreat(healer), 40.0f);
+    EXPECT_FLOAT_EQ(threatLists.Get(other).GetThreat(attacker), 50.0f);
+    EXPECT_FLOAT_EQ(threatLists.Get(other).GetThreat(healer), 20.0f);
+
+    // Processed component events are not applied again.
+    channel.Swap();
+    system.Execute(0.016f);
+    EXPECT_EQ(stats.Get(victim).health, 1000 - 80 - 40);
+}
+
+TEST_F(CombatSystemTest, TimerWheelCompletesDueCastsOnly) {
+    Entity interrupted(2, 0);
+    spellCasts.Add(attacker);
+    spellCasts.Add(interrupted);
+
+    CombatSystem system(spellCasts, auraHolders, damageEvents, stats, threatLists);
+    system.SetTimerWheel(true);
+    EXPECT_FALSE(system.BeginCast(victim, 1, attacker, 1.0f));  // no SpellCast
+    ASSERT_TRUE(system.BeginCast(attacker, 7, victim, 1.5f));
+    ASSERT_TRUE(system.BeginCast(interrupted, 8, victim, 0.5f));
+    spellCasts.Get(interrupted).Interrupt();
+
+    system.Execute(1.0f);
+    EXPECT_EQ(spellCasts.Get(attacker).state, CastState::Casting);
+    EXPECT_EQ(spellCasts.Get(interrupted).state, CastState::Interrupted);
+
+    // Restarting a cast replaces its pending completion.
+    ASSERT_TRUE(system.BeginCast(attacker, 9, victim, 1.0f));
+    system.Execute(0.5f);
+    EXPECT_EQ(spellCasts.Get(attacker).state, CastState::Casting);
+    system.Execute(0.5f);
+    EXPECT_EQ(spellCasts.Get(attacker).state, CastState::Complete);
+    EXPECT_EQ(spellCasts.Get(attacker).spellId, 9u);
+    EXPECT_FLOAT_EQ(spellCasts.Get(attacker).remainingTime, 0.0f);
+}
+
+TEST(CombatTimerWheelTest, AurasMatchPerTickStepping) {
+    struct Rig {
+        ComponentStorage<SpellCast> casts;
+        ComponentStorage<AuraHolder> auras;
+        ComponentStorage<DamageEvent> damages;
+        ComponentStorage<Stats> stats;
+        ComponentStorage<ThreatList> threats;
+        CombatSystem system{casts, auras, damages, stats, threats};
+    };
+    Rig stepped;
+    Rig wheel;
+    wheel.system.SetTimerWheel(true);
+
+    const Entity target(0, 0);
+    const auto aura = [](uint32_t id, uint32_t caster, float duration, float interval,
+                         int32_t damage) {
+        AuraInstance a;
+        a.auraId = id;
+        a.caster = Entity(caster, 0);
+        a.duration = duration;
+        a.remainingTime = duration;
+        a.tickInterval = interval;
+        a.tickTimer = interval;
+        a.tickDamage = damage;
+        return a;
+    };
+    for (Rig* rig : {&stepped, &wheel}) {
+        rig->stats.Add(target, Stats{1000, 1000, 0, 0, {}});
+        rig->auras.Add(target);
+        ASSERT_TRUE(rig->system.ApplyAura(target, aura(1, 1, 5.0f, 1.0f, 10)));
+        ASSERT_TRUE(rig->system.ApplyAura(target, aura(2, 1, 3.0f, 0.0f, 0)));
+        ASSERT_TRUE(rig->system.ApplyAura(target, aura(1, 2, 2.5f, 0.5f, 3)));
+    }
+
+    for (int step = 1; step <= 32; ++step) {
+        if (step == 8) {
+            // Stack the first DoT: refreshes its duration, keeps its tick phase.
+            for (Rig* rig : {&stepped, &wheel}) {
+                rig->system.ApplyAura(target, aura(1, 1, 5.0f, 1.0f, 10));
+            }
+        }
+        stepped.system.Execute(0.25f);
+        wheel.system.Execute(0.25f);
+
+        EXPECT_EQ(wheel.stats.Get(target).health, stepped.stats.Get(target).health)
+            << "step " << step;
+        const auto& expected = stepped.auras.Get(target).auras;
+        const auto& actual = wheel.auras.Get(target).auras;
+        ASSERT_EQ(actual.size(), expected.size()) << "step " << step;
+        for (const AuraInstance& a : expected) {
+            EXPECT_TRUE(std::any_of(actual.begin(), actual.end(), [&a](const AuraInstance& b) {
+                return b.auraId == a.auraId && b.caster == a.caster && b.stacks == a.stacks;
+            })) << "step " << step << ", aura " << a.auraId;
+        }
+    }
+    EXPECT_TRUE(wheel.auras.Get(target).auras.empty());
+    EXPECT_LT(wheel.stats.Get(target).health, 1000);
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // ThreatList tests
 // ═══════════════════════════════════════════════════════════════════════════
@@ -511,6 +849,77 @@ TEST(ThreatListTest, Clear) {
     EXPECT_TRUE(threats.entries.empty());
 }
 
+TEST(ThreatListTest, DecayDropsFadedSourcesAndWipeKeepsThem) {
+    ThreatList threats;
+    for (uint32_t i = 0; i < 12; ++i) {
+        threats.AddThreat(Entity(i, 0), static_cast<float>(10 * (i + 1)));
+    }
+    EXPECT_EQ(threats.GetTopThreat(), Entity(11, 0));
+
+    // 10 * 0.5 = 5 and 20 * 0.5 = 10 are dropped; the rest keep their order.
+    threats.Decay(0.5f, 10.0f);
+    EXPECT_EQ(threats.Size(), 10u);
+    EXPECT_FLOAT_EQ(threats.GetThreat(Entity(0, 0)), 0.0f);
+    EXPECT_FLOAT_EQ(threats.GetThreat(Entity(2, 0)), 15.0f);
+    EXPECT_EQ(threats.GetTopThreat(), Entity(11, 0));
+
+    threats.Wipe();
+    EXPECT_EQ(threats.Size(), 10u);
+    EXPECT_FLOAT_EQ(threats.GetThreat(Entity(11, 0)), 0.0f);
+    threats.AddThreat(Entity(3, 0), 1.0f);
+    EXPECT_EQ(threats.GetTopThreat(), Entity(3, 0));
+}
+
+TEST(ThreatListTest, MatchesBruteForcePastInlineCapacity) {
+    std::mt19937 rng(32);
+    std::uniform_int_distribution<uint32_t> source(0, 63);
+    std::uniform_real_distribution<float> amount(-20.0f, 100.0f);
+    std::uniform_int_distribution<int> action(0, 9);
+
+    ThreatList threats;
+    std::vector<float> expected(64, 0.0f);
+    std::vector<bool> listed(64, false);
+    for (int step = 0; step < 5000; ++step) {
+        const uint32_t id = source(rng);
+        const Entity e(id, 0);
+        const int act = action(rng);
+        if (act == 0) {
+            threats.Remove(e);
+            listed[id] = false;
+            expected[id] = 0.0f;
+        } else if (act == 1 && step % 50 == 0) {
+            threats.Decay(0.75f, 5.0f);
+            for (std::size_t i = 0; i < expected.size(); ++i) {
+                expected[i] *= 0.75f;
+                if (listed[i] && expected[i] <= 5.0f) {
+                    listed[i] = false;
+                    expected[i] = 0.0f;
+                }
+            }
+        } else {
+            const float delta = amount(rng);
+            threats.AddThreat(e, delta);
+            expected[id] = listed[id] ? expected[id] + delta : delta;
+            listed[id] = true;
+        }
+
+        std::size_t count = 0;
+        float top = 0.0f;
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            if (listed[i]) {
+                top = count == 0 ? expected[i] : std::max(top, expected[i]);
+                ++count;
+            }
+        }
+        ASSERT_EQ(threats.Size(), count) << "step " << step;
+        if (count != 0) {
+            const Entity topSource = threats.GetTopThreat();
+            EXPECT_FLOAT_EQ(expected[topSource.id()], top) << "step " << step;
+        }
+        EXPECT_FLOAT_EQ(threats.GetThreat(e), expected[id]) << "step " << step;
+    }
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // Integration: full combat scenario
 // ═══════════════════════════════════════════════════════════════════════════
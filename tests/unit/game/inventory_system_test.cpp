@@ -1,5 +1,12 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <optional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "cgs/ecs/component_storage.hpp"
 #include "cgs/ecs/entity.hpp"
 #include "cgs/ecs/entity_manager.hpp"
@@ -442,6 +449,108 @@ TEST_F(InventoryTest, AutoInitializesOnAdd) {
     EXPECT_EQ(inv.slots.size(), 5u);
 }
 
+TEST_F(InventoryTest, RemovingFromFullStackReopensIt) {
+    Inventory inv;
+    inv.capacity = 5;
+    inv.Initialize();
+
+    auto tmpl = makeStackable(100, 10);
+    inv.AddItem(tmpl, 20);  // Two full stacks.
+    ASSERT_TRUE(inv.RemoveItem(0, 3));
+
+    EXPECT_EQ(inv.AddItem(tmpl, 4), 4u);
+    EXPECT_EQ(inv.slots[0].count, 10u);
+    EXPECT_EQ(inv.slots[2].count, 1u);
+    EXPECT_EQ(inv.FreeSlots(), 2u);
+}
+
+TEST_F(InventoryTest, EmptiedSlotIsReusedFirst) {
+    Inventory inv;
+    inv.capacity = 4;
+    inv.Initialize();
+
+    auto sword = makeNonStackable(100);
+    inv.AddItem(sword, 3);
+    ASSERT_TRUE(inv.RemoveItem(1, 1));
+
+    inv.AddItem(makeNonStackable(200), 1);
+    EXPECT_EQ(inv.slots[1].itemId, 200u);
+    inv.AddItem(makeNonStackable(300), 1);
+    EXPECT_EQ(inv.slots[3].itemId, 300u);
+    EXPECT_EQ(inv.AddItem(sword, 1), 0u);
+}
+
+TEST_F(InventoryTest, StacksFollowSwappedSlots) {
+    Inventory inv;
+    inv.capacity = 5;
+    inv.Initialize();
+
+    auto potion = makeStackable(100, 10);
+    inv.AddItem(makeNonStackable(200), 1);
+    inv.AddItem(potion, 4);  // Slot 1.
+    ASSERT_TRUE(inv.SwapSlots(1, 4));
+    EXPECT_FALSE(inv.SwapSlots(2, 2));
+
+    inv.AddItem(potion, 3);
+    EXPECT_EQ(inv.slots[4].count, 7u);
+    EXPECT_TRUE(inv.slots[1].IsEmpty());
+
+    inv.AddItem(makeNonStackable(300), 1);
+    EXPECT_EQ(inv.slots[1].itemId, 300u);
+}
+
+TEST_F(InventoryTest, SplitHalvesAcceptMoreItems) {
+    Inventory inv;
+    inv.capacity = 5;
+    inv.Initialize();
+
+    auto potion = makeStackable(100, 10);
+    inv.AddItem(potion, 10);
+    auto newSlot = inv.SplitStack(0, 4);
+    ASSERT_EQ(newSlot, std::optional<uint32_t>(1u));
+
+    EXPECT_EQ(inv.AddItem(potion, 8), 8u);
+    EXPECT_EQ(inv.slots[0].count, 10u);
+    EXPECT_EQ(inv.slots[1].count, 8u);
+    EXPECT_EQ(inv.FreeSlots(), 3u);
+}
+
+TEST_F(InventoryTest, ReindexPicksUpDirectWrites) {
+    Inventory inv;
+    inv.capacity = 3;
+    inv.Initialize();
+
+    auto potion = makeStackable(100, 10);
+    inv.AddItem(potion, 5);
+    inv.slots[0].Clear();
+    inv.slots[1].itemId = 100;
+    inv.slots[1].count = 2;
+    inv.Reindex();
+
+    EXPECT_EQ(inv.AddItem(potion, 12), 12u);
+    EXPECT_EQ(inv.slots[0].count, 4u);
+    EXPECT_EQ(inv.slots[1].count, 10u);
+}
+
+TEST_F(InventoryTest, AddItemsPlacesABatch) {
+    std::vector<ItemTemplate> templates = {makeStackable(100, 10), makeNonStackable(200)};
+    auto db = ItemTemplateDatabase::Build(std::move(templates));
+
+    Inventory inv;
+    inv.capacity = 3;
+    inv.Initialize();
+
+    const std::vector<std::pair<uint32_t, uint32_t>> loot = {
+        {100, 15}, {200, 2}, {999, 1}, {100, 5}};
+    std::vector<uint32_t> added(loot.size());
+    EXPECT_EQ(inv.AddItems(*db, loot, added), 21u);
+
+    EXPECT_EQ(added, (std::vector<uint32_t>{15, 1, 0, 5}));
+    EXPECT_EQ(inv.CountItem(100), 20u);
+    EXPECT_EQ(inv.CountItem(200), 1u);
+    EXPECT_EQ(inv.FreeSlots(), 0u);
+}
+
 // =============================================================================
 // Equipment component tests (SRS-GML-006.3)
 // =============================================================================
@@ -755,6 +864,47 @@ TEST_F(InventorySystemTest, InventoryEnchantExpiration) {
     EXPECT_TRUE(inv.slots[0].enchants.empty());
 }
 
+TEST_F(InventorySystemTest, TimerWheelExpiresEnchantsThatFollowTheirItem) {
+    auto& equip = equipment.Get(player);
+    auto& inv = inventories.Get(player);
+
+    InventorySlot sword;
+    sword.itemId = 1001;
+    sword.count = 1;
+    equip.Equip(EquipSlot::MainHand, sword);
+    inv.slots[0].itemId = 500;
+    inv.slots[0].count = 1;
+
+    Enchant permanent;
+    permanent.enchantId = 1;
+    Enchant timed;
+    timed.enchantId = 2;
+    timed.durationRemaining = 3.0f;
+    Enchant brief;
+    brief.enchantId = 10;
+    brief.durationRemaining = 1.0f;
+
+    InventorySystem system(inventories, equipment, durabilityEvents);
+    system.SetTimerWheel(true);
+    EXPECT_FALSE(system.ApplyEnchant(player, EquipSlot::Head, timed));  // empty slot
+    EXPECT_FALSE(system.ApplyEnchant(player, 1u, timed));               // empty slot
+    ASSERT_TRUE(system.ApplyEnchant(player, EquipSlot::MainHand, permanent));
+    ASSERT_TRUE(system.ApplyEnchant(player, EquipSlot::MainHand, timed));
+    ASSERT_TRUE(system.ApplyEnchant(player, 0u, brief));
+
+    system.Execute(2.0f);
+    EXPECT_TRUE(inv.slots[0].enchants.empty());
+    ASSERT_EQ(equip.GetEquipped(EquipSlot::MainHand)->enchants.size(), 2u);
+
+    // Unequip into the bag: the timed enchant still expires on schedule.
+    inv.slots[1] = equip.Unequip(EquipSlot::MainHand);
+    system.Execute(0.5f);
+    EXPECT_EQ(inv.slots[1].enchants.size(), 2u);
+    system.Execute(0.5f);
+    ASSERT_EQ(inv.slots[1].enchants.size(), 1u);
+    EXPECT_EQ(inv.slots[1].enchants[0].enchantId, 1u);
+}
+
 // =============================================================================
 // InventorySystem template registry
 // =============================================================================
@@ -807,6 +957,266 @@ TEST(InventorySystemTemplateTest, RegisterOverwritesExisting) {
     EXPECT_EQ(system.GetTemplate(1)->name, "Version 2");
 }
 
+TEST(ItemTemplateDatabaseTest, DenseIdsUseTheDenseIndex) {
+    std::vector<ItemTemplate> templates;
+    for (uint32_t id = 100; id < 200; id += 2) {
+        ItemTemplate tmpl;
+        tmpl.id = id;
+        tmpl.name = "item" + std::to_string(id);
+        templates.push_back(std::move(tmpl));
+    }
+    auto db = ItemTemplateDatabase::Build(std::move(templates));
+
+    EXPECT_TRUE(db->IsDense());
+    EXPECT_EQ(db->Size(), 50u);
+    ASSERT_NE(db->Find(150), nullptr);
+    EXPECT_EQ(db->Find(150)->name, "item150");
+    EXPECT_EQ(db->Find(151), nullptr);
+    EXPECT_EQ(db->Find(99), nullptr);
+    EXPECT_EQ(db->Find(200), nullptr);
+}
+
+TEST(ItemTemplateDatabaseTest, SparseIdsUseTheHashTable) {
+    std::vector<ItemTemplate> templates;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        ItemTemplate tmpl;
+        tmpl.id = i * 7919u + 1'000'000u;
+        tmpl.vendorPrice = i;
+        templates.push_back(std::move(tmpl));
+    }
+    auto db = ItemTemplateDatabase::Build(templates);
+
+    EXPECT_FALSE(db->IsDense());
+    for (const auto& tmpl : templates) {
+        const auto* found = db->Find(tmpl.id);
+        ASSERT_NE(found, nullptr);
+        EXPECT_EQ(found->vendorPrice, tmpl.vendorPrice);
+        EXPECT_EQ(db->Find(tmpl.id + 1), nullptr);
+    }
+    EXPECT_TRUE(std::is_sorted(db->begin(), db->end(), [](const auto& a, const auto& b) {
+        return a.id < b.id;
+    }));
+}
+
+TEST(ItemTemplateDatabaseTest, LaterDuplicatesWin) {
+    ItemTemplate v1;
+    v1.id = 7;
+    v1.name = "Version 1";
+    ItemTemplate v2 = v1;
+    v2.name = "Version 2";
+    auto db = ItemTemplateDatabase::Build({v1, v2});
+
+    EXPECT_EQ(db->Size(), 1u);
+    EXPECT_EQ(db->Find(7)->name, "Version 2");
+    EXPECT_EQ(ItemTemplateDatabase::Build({})->Find(0), nullptr);
+}
+
+TEST(InventorySystemTemplateTest, SharesALoadedDatabase) {
+    ComponentStorage<Inventory> invs;
+    ComponentStorage<Equipment> equips;
+    ComponentStorage<DurabilityEvent> events;
+
+    ItemTemplate potion;
+    potion.id = 1;
+    potion.maxStackSize = 20;
+    ItemTemplate helmet;
+    helmet.id = 2;
+    helmet.equipSlot = EquipSlot::Head;
+    helmet.statBonuses.armor = 12;
+    auto db = ItemTemplateDatabase::Build({potion, helmet});
+
+    InventorySystem system(invs, equips, events);
+    system.SetTemplates(db);
+    EXPECT_EQ(system.GetTemplateDatabase(), db);
+    EXPECT_EQ(system.GetTemplate(2)->statBonuses.armor, 12);
+
+    // Inventory and Equipment read the same database.
+    Inventory inv;
+    EXPECT_EQ(inv.AddItem(*db, 1, 30), 30u);
+    EXPECT_EQ(inv.slots[0].count, 20u);
+    EXPECT_EQ(inv.AddItem(*db, 99, 1), 0u);
+
+    Equipment equip;
+    InventorySlot worn;
+    worn.itemId = 2;
+    worn.count = 1;
+    equip.Equip(EquipSlot::Head, worn);
+    EXPECT_EQ(equip.CalculateStatBonuses(*db).armor, 12);
+
+    // Registering afterwards copies; the shared database is untouched.
+    ItemTemplate extra;
+    extra.id = 3;
+    system.RegisterTemplate(extra);
+    EXPECT_NE(system.GetTemplate(3), nullptr);
+    EXPECT_EQ(db->Find(3), nullptr);
+
+    system.SetTemplates(nullptr);
+    EXPECT_EQ(system.GetTemplate(1), nullptr);
+}
+
+// =============================================================================
+// InventorySystem equipment stats cache
+// =============================================================================
+
+class EquipmentStatsTest : public ::testing::Test {
+protected:
+    ComponentStorage<Inventory> inventories;
+    ComponentStorage<Equipment> equipment;
+    ComponentStorage<DurabilityEvent> durabilityEvents;
+    ComponentStorage<EquipmentStats> gear;
+    InventorySystem system{inventories, equipment, durabilityEvents};
+
+    void SetUp() override {
+        ItemTemplate helmet;
+        helmet.id = 1;
+        helmet.equipSlot = EquipSlot::Head;
+        helmet.maxDurability = 10;
+        helmet.statBonuses.armor = 20;
+        ItemTemplate sword;
+        sword.id = 2;
+        sword.equipSlot = EquipSlot::MainHand;
+        sword.statBonuses.minDamage = 5;
+        sword.statBonuses.maxDamage = 9;
+        sword.statBonuses.attackSpeed = 0.25f;
+        system.SetTemplates(ItemTemplateDatabase::Build({helmet, sword}));
+        system.SetEquipmentStats(&gear);
+    }
+
+    static InventorySlot item(uint32_t id, int32_t durability = kIndestructible) {
+        InventorySlot slot;
+        slot.itemId = id;
+        slot.count = 1;
+        slot.durability = durability;
+        slot.maxDurability = durability;
+        return slot;
+    }
+
+    [[nodiscard]] StatBonuses expected(Entity e) const {
+        return equipment.Get(e).CalculateStatBonuses(*system.GetTemplateDatabase());
+    }
+};
+
+TEST_F(EquipmentStatsTest, FirstTickFillsTheCacheThenOnlyDirtyEntitiesRecompute) {
+    Entity a(0, 0);
+    Entity b(1, 0);
+    equipment.Add(a).Equip(EquipSlot::Head, item(1));
+    equipment.Add(b).Equip(EquipSlot::MainHand, item(2));
+    system.MarkStatsDirty(a);
+    system.MarkStatsDirty(b);
+    system.Execute(0.1f);
+    EXPECT_EQ(system.LastStatsRecomputeCount(), 2u);
+    EXPECT_EQ(gear.Get(a).bonuses.armor, 20);
+    EXPECT_EQ(gear.Get(b).bonuses.maxDamage, 9);
+    EXPECT_FALSE(gear.Get(a).dirty);
+
+    system.Execute(0.1f);
+    EXPECT_EQ(system.LastStatsRecomputeCount(), 0u);
+
+    // A direct write needs MarkStatsDirty(); only b is recomputed.
+    equipment.Get(b).Unequip(EquipSlot::MainHand);
+    system.MarkStatsDirty(b);
+    system.Execute(0.1f);
+    EXPECT_EQ(system.LastStatsRecomputeCount(), 1u);
+    EXPECT_EQ(gear.Get(b).bonuses, StatBonuses{});
+}
+
+TEST_F(EquipmentStatsTest, EquipUnequipAndEnchantsApplyDeltas) {
+    Entity e(0, 0);
+    equipment.Add(e);
+    system.Execute(0.1f);  // creates the cache
+    ASSERT_TRUE(gear.Has(e));
+
+    system.Equip(e, EquipSlot::Head, item(1));
+    system.Equip(e, EquipSlot::MainHand, item(2));
+    EXPECT_EQ(gear.Get(e).bonuses, expected(e));  // no tick needed
+
+    Enchant shine;
+    shine.bonuses.armor = 7;
+    shine.durationRemaining = 0.5f;
+    ASSERT_TRUE(system.ApplyEnchant(e, EquipSlot::Head, shine));
+    EXPECT_EQ(gear.Get(e).bonuses.armor, 27);
+
+    system.Execute(1.0f);  // enchant expires
+    EXPECT_EQ(gear.Get(e).bonuses.armor, 20);
+    EXPECT_EQ(system.LastStatsRecomputeCount(), 0u);
+
+    InventorySlot removed = system.Unequip(e, EquipSlot::MainHand);
+    EXPECT_EQ(removed.itemId, 2u);
+    EXPECT_EQ(gear.Get(e).bonuses, expected(e));
+    EXPECT_EQ(gear.Get(e).bonuses.maxDamage, 0);
+}
+
+TEST_F(EquipmentStatsTest, TimerWheelExpiryAndBreakingApplyDeltas) {
+    system.SetTimerWheel(true);
+    Entity e(0, 0);
+    equipment.Add(e);
+    system.Execute(0.1f);
+    system.Equip(e, EquipSlot::Head, item(1, 10));
+
+    Enchant shine;
+    shine.bonuses.armor = 7;
+    shine.durationRemaining = 0.5f;
+    ASSERT_TRUE(system.ApplyEnchant(e, EquipSlot::Head, shine));
+    system.Execute(1.0f);
+    EXPECT_EQ(gear.Get(e).bonuses.armor, 20);
+
+    Entity hit(5, 0);
+    durabilityEvents.Add(hit, DurabilityEvent{e, EquipSlot::Head, 10});
+    system.Execute(0.1f);
+    EXPECT_EQ(gear.Get(e).bonuses.armor, 0);  // broken
+    EXPECT_EQ(gear.Get(e).bonuses, expected(e));
+    EXPECT_EQ(system.LastStatsRecomputeCount(), 0u);
+}
+
+TEST_F(EquipmentStatsTest, RandomChangesMatchAFullRecompute) {
+    std::mt19937 rng(39);
+    std::vector<Entity> entities;
+    for (uint32_t i = 0; i < 8; ++i) {
+        entities.emplace_back(i, 0);
+        equipment.Add(entities.back());
+    }
+    system.Execute(0.1f);
+
+    for (int step = 0; step < 500; ++step) {
+        const Entity e = entities[rng() % entities.size()];
+        switch (rng() % 4) {
+            case 0:
+                system.Equip(e, EquipSlot::Head, item(1, 3));
+                break;
+            case 1:
+                system.Unequip(e, (rng() % 2) ? EquipSlot::Head : EquipSlot::MainHand);
+                system.Equip(e, EquipSlot::MainHand, item(2));
+                break;
+            case 2: {
+                Enchant enchant;
+                enchant.bonuses.armor = static_cast<int32_t>(rng() % 5);
+                enchant.durationRemaining = static_cast<float>(rng() % 3) * 0.1f + 0.05f;
+                system.ApplyEnchant(e, EquipSlot::Head, enchant);
+                break;
+            }
+            case 3:
+                durabilityEvents.Add(Entity(100 + static_cast<uint32_t>(step), 0),
+                                     DurabilityEvent{e, EquipSlot::Head, 1});
+                break;
+        }
+        system.Execute(0.1f);
+        for (const auto& entity : entities) {
+            const StatBonuses want = expected(entity);
+            const StatBonuses& have = gear.Get(entity).bonuses;
+            ASSERT_EQ(have.armor, want.armor) << step;
+            ASSERT_EQ(have.maxDamage, want.maxDamage) << step;
+            ASSERT_NEAR(have.attackSpeed, want.attackSpeed, 1e-4f) << step;
+        }
+    }
+}
+
+TEST_F(EquipmentStatsTest, AccessInfoDeclaresTheCacheWrite) {
+    EXPECT_TRUE(system.GetAccessInfo().writes.count(ComponentType<EquipmentStats>::Id()));
+
+    system.SetEquipmentStats(nullptr);
+    EXPECT_FALSE(system.GetAccessInfo().writes.count(ComponentType<EquipmentStats>::Id()));
+}
+
 // =============================================================================
 // InventorySystem metadata
 // =============================================================================
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 
 #include <cmath>
+#include <cstddef>
+#include <vector>
 
 #include "cgs/ecs/component_storage.hpp"
 #include "cgs/ecs/entity.hpp"
@@ -357,6 +359,22 @@ TEST_F(ObjectUpdateSystemTest, SkipsIdleEntities) {
     EXPECT_FLOAT_EQ(t.position.z, 5.0f);
 }
 
+TEST_F(ObjectUpdateSystemTest, MarksOnlyMovedTransformsChanged) {
+    Entity moving(0, 0);
+    Entity idle(1, 0);
+    transforms.Add(moving, Transform{});
+    movements.Add(moving, Movement{1.0f, 1.0f, {1.0f, 0.0f, 0.0f}, MovementState::Walking});
+    transforms.Add(idle, Transform{});
+    movements.Add(idle, Movement{1.0f, 1.0f, {1.0f, 0.0f, 0.0f}, MovementState::Idle});
+    const uint32_t since = CurrentChangeVersion();
+
+    ObjectUpdateSystem system(transforms, movements);
+    system.Execute(0.1f);
+
+    EXPECT_TRUE(transforms.HasChanged(moving, since));
+    EXPECT_FALSE(transforms.HasChanged(idle, since));
+}
+
 TEST_F(ObjectUpdateSystemTest, UpdatesMultipleEntities) {
     Entity e1(0, 0);
     Entity e2(1, 0);
@@ -421,6 +439,106 @@ TEST_F(ObjectUpdateSystemTest, SystemMetadata) {
     EXPECT_FALSE(access.writes.empty());
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// Batch integration
+// ═══════════════════════════════════════════════════════════════════════════
+
+namespace {
+
+/// Eleven movers (two SIMD blocks plus a tail) with every third idle.
+std::vector<Movement> makeMovers(std::size_t count) {
+    std::vector<Movement> movers(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto f = static_cast<float>(i);
+        movers[i].speed = 1.5f + f;
+        movers[i].direction = Vector3(0.6f, -0.1f * f, 0.8f).Normalized();
+        movers[i].state = i % 3 == 0 ? MovementState::Idle : MovementState::Running;
+    }
+    return movers;
+}
+
+}  // namespace
+
+TEST_F(ObjectUpdateSystemTest, ColumnsKernelMatchesPerMoverIntegration) {
+    const auto movers = makeMovers(11);
+    for (const auto precision : {MovementPrecision::Float, MovementPrecision::Quantized}) {
+        std::vector<Vector3> positions;
+        std::vector<Vector3> directions;
+        std::vector<float> speeds;
+        std::vector<MovementState> states;
+        for (std::size_t i = 0; i < movers.size(); ++i) {
+            positions.emplace_back(-3.25f * static_cast<float>(i), 10.0f, 0.5f);
+            directions.push_back(movers[i].direction);
+            speeds.push_back(movers[i].speed);
+            states.push_back(movers[i].state);
+        }
+        const auto start = positions;
+
+        ObjectUpdateSystem::IntegrateColumns({positions, directions, speeds, states}, 0.05f,
+                                             precision);
+        for (std::size_t i = 0; i < movers.size(); ++i) {
+            const Vector3 expected = movers[i].state == MovementState::Idle
+                                         ? start[i]
+                                         : ObjectUpdateSystem::IntegratePosition(
+                                               start[i], movers[i], 0.05f, precision);
+            EXPECT_EQ(positions[i].x, expected.x) << i;
+            EXPECT_EQ(positions[i].y, expected.y) << i;
+            EXPECT_EQ(positions[i].z, expected.z) << i;
+        }
+    }
+}
+
+TEST_F(ObjectUpdateSystemTest, QuantizedStepsSnapToTheQuantum) {
+    Movement movement{4.0f, 4.0f, {0.6f, 0.0f, -0.8f}, MovementState::Running};
+    Vector3 position{100.0f, 2.0f, -7.0f};
+    for (int tick = 0; tick < 20; ++tick) {
+        position = ObjectUpdateSystem::IntegratePosition(position, movement, 0.05f,
+                                                         MovementPrecision::Quantized);
+    }
+
+    // 20 ticks of 0.2 units: 0.6 * 0.2 * 256 = 30.72 -> 31 quanta per tick
+    // along x, -0.8 * 0.2 * 256 = -40.96 -> -41 along z.
+    EXPECT_EQ(position.x, 100.0f + 20.0f * 31.0f * kMovementQuantum);
+    EXPECT_EQ(position.y, 2.0f);
+    EXPECT_EQ(position.z, -7.0f - 20.0f * 41.0f * kMovementQuantum);
+}
+
+TEST_F(ObjectUpdateSystemTest, GroupPathMatchesQueryPath) {
+    ComponentStorage<Transform> groupTransforms;
+    ComponentStorage<Movement> groupMovements;
+    const auto movers = makeMovers(11);
+    for (uint32_t i = 0; i < movers.size(); ++i) {
+        const Transform start{{1.0f * static_cast<float>(i), 0.0f, 2.0f}, {}, {}};
+        transforms.Add(Entity(i, 0), start);
+        movements.Add(Entity(i, 0), movers[i]);
+        groupTransforms.Add(Entity(i, 0), start);
+        groupMovements.Add(Entity(i, 0), movers[i]);
+    }
+    // A transform without Movement stays out of the group.
+    groupTransforms.Add(Entity(50, 0), Transform{});
+
+    ObjectUpdateSystem::MoverGroup group(groupTransforms, groupMovements);
+    ObjectUpdateSystem reference(transforms, movements);
+    ObjectUpdateSystem grouped(groupTransforms, groupMovements);
+    grouped.SetGroup(&group);
+    reference.SetPrecision(MovementPrecision::Quantized);
+    grouped.SetPrecision(MovementPrecision::Quantized);
+    EXPECT_EQ(grouped.GetPrecision(), MovementPrecision::Quantized);
+
+    const uint32_t since = CurrentChangeVersion();
+    for (int tick = 0; tick < 3; ++tick) {
+        reference.Execute(0.05f);
+        grouped.Execute(0.05f);
+    }
+    for (uint32_t i = 0; i < movers.size(); ++i) {
+        const Entity e(i, 0);
+        EXPECT_EQ(groupTransforms.Get(e).position.x, transforms.Get(e).position.x) << i;
+        EXPECT_EQ(groupTransforms.Get(e).position.z, transforms.Get(e).position.z) << i;
+        EXPECT_EQ(groupTransforms.HasChanged(e, since), movers[i].state != MovementState::Idle);
+    }
+    EXPECT_FALSE(groupTransforms.HasChanged(Entity(50, 0), since));
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // Integration test: full entity lifecycle with all components
 // ═══════════════════════════════════════════════════════════════════════════
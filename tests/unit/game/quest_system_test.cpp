@@ -216,6 +216,35 @@ TEST_F(QuestLogTest, AbandonNonexistentQuestFails) {
     EXPECT_FALSE(log.Abandon(999));
 }
 
+TEST_F(QuestLogTest, LookupsStayCorrectPastInlineQuests) {
+    QuestLog log;
+    constexpr auto kQuests = static_cast<uint32_t>(QuestLog::kInlineQuests * 2);
+    for (uint32_t id = 1; id <= kQuests; ++id) {
+        ASSERT_TRUE(log.Accept(makeSimpleTemplate(id)));
+    }
+    EXPECT_FALSE(log.Accept(makeSimpleTemplate(3)));
+
+    EXPECT_TRUE(log.Abandon(2));
+    EXPECT_TRUE(log.Abandon(kQuests));
+    EXPECT_FALSE(log.HasQuest(2));
+    for (uint32_t id : {1u, 3u, kQuests / 2 + 1, kQuests - 1}) {
+        ASSERT_NE(log.GetQuest(id), nullptr);
+        EXPECT_EQ(log.GetQuest(id)->questId, id);
+    }
+
+    for (auto& quest : log.activeQuests) {
+        if (quest.questId % 2 == 1) {
+            quest.state = QuestState::Failed;
+        }
+    }
+    log.CleanupFinished();
+    EXPECT_FALSE(log.HasQuest(1));
+    ASSERT_NE(log.GetQuest(4), nullptr);
+    EXPECT_EQ(log.GetQuest(4)->questId, 4u);
+    EXPECT_TRUE(log.Accept(makeSimpleTemplate(1)));
+    EXPECT_EQ(log.GetQuest(1), &log.activeQuests.back());
+}
+
 TEST_F(QuestLogTest, TurnInCompletedQuest) {
     QuestLog log;
     auto tmpl = makeSimpleTemplate(1, 100, 1);
@@ -597,6 +626,95 @@ TEST_F(QuestSystemTest, MultipleEventsInSingleTick) {
     EXPECT_EQ(log.GetQuest(1)->state, QuestState::ObjectivesComplete);
 }
 
+TEST_F(QuestSystemTest, ObjectiveIndexMergesEventsPerObjective) {
+    auto& log = questLogs.Get(player);
+    QuestSystem system(questLogs, questEvents);
+    system.SetObjectiveIndex(true);
+    EXPECT_TRUE(system.ObjectiveIndexEnabled());
+
+    QuestTemplate wolves = makeKillTemplate(1, 100, 5);
+    QuestObjective pelts;
+    pelts.type = ObjectiveType::Collect;
+    pelts.targetId = 100;
+    pelts.required = 2;
+    wolves.objectives.push_back(pelts);
+    system.RegisterTemplate(wolves);
+    system.RegisterTemplate(makeKillTemplate(2, 100, 2));
+    system.RegisterTemplate(makeKillTemplate(3, 300, 1));
+    ASSERT_TRUE(system.AcceptQuest(player, 1));
+    ASSERT_TRUE(system.AcceptQuest(player, 2));
+    ASSERT_TRUE(system.AcceptQuest(player, 3));
+    EXPECT_EQ(system.IndexedObjectiveCount(), 4u);
+
+    cgs::ecs::EventChannel<QuestEvent> channel;
+    system.SetEventChannel(&channel);
+
+    // Three kills of creature 100 (two as components, one on the channel)
+    // and one of an unrelated creature.
+    for (uint32_t i = 0; i < 3; ++i) {
+        QuestEvent event;
+        event.player = player;
+        event.type = QuestEventType::Kill;
+        event.targetId = i < 2 ? 100 : 999;
+        questEvents.Add(Entity(10 + i, 0), std::move(event));
+    }
+    QuestEvent kill;
+    kill.player = player;
+    kill.type = QuestEventType::Kill;
+    kill.targetId = 100;
+    channel.Send(kill);
+    channel.Swap();
+
+    system.Execute(0.016f);
+    EXPECT_EQ(log.GetQuest(1)->objectives[0].current, 3);
+    EXPECT_EQ(log.GetQuest(1)->objectives[1].current, 0);  // Collect, not Kill
+    EXPECT_EQ(log.GetQuest(2)->objectives[0].current, 2);
+    EXPECT_EQ(log.GetQuest(2)->state, QuestState::ObjectivesComplete);
+    EXPECT_EQ(log.GetQuest(3)->objectives[0].current, 0);
+    EXPECT_TRUE(questEvents.Get(Entity(12, 0)).processed);
+
+    // Quest 2's finished objective left the index.
+    EXPECT_EQ(system.IndexedObjectiveCount(), 3u);
+}
+
+TEST_F(QuestSystemTest, ObjectiveIndexFollowsAcceptAbandonAndFailure) {
+    auto& log = questLogs.Get(player);
+    QuestTemplate timed = makeKillTemplate(1, 100, 5);
+    timed.timeLimitSeconds = 1.0f;
+    QuestSystem system(questLogs, questEvents);
+    system.RegisterTemplate(timed);
+    system.RegisterTemplate(makeKillTemplate(2, 100, 5));
+
+    // Quests accepted before enabling are indexed by SetObjectiveIndex().
+    ASSERT_TRUE(system.AcceptQuest(player, 2));
+    system.SetObjectiveIndex(true);
+    EXPECT_EQ(system.IndexedObjectiveCount(), 1u);
+    ASSERT_TRUE(system.AcceptQuest(player, 1));
+    EXPECT_EQ(system.IndexedObjectiveCount(), 2u);
+
+    EXPECT_FALSE(system.AbandonQuest(player, 99));
+    EXPECT_FALSE(system.AbandonQuest(Entity(5, 0), 2));
+    ASSERT_TRUE(system.AbandonQuest(player, 2));
+    EXPECT_FALSE(log.HasQuest(2));
+    EXPECT_EQ(system.IndexedObjectiveCount(), 1u);
+
+    system.Execute(2.0f);
+    EXPECT_EQ(log.GetQuest(1)->state, QuestState::Failed);
+    EXPECT_EQ(system.IndexedObjectiveCount(), 0u);
+
+    QuestEvent event;
+    event.player = player;
+    event.type = QuestEventType::Kill;
+    event.targetId = 100;
+    questEvents.Add(Entity(10, 0), std::move(event));
+    system.Execute(0.016f);
+    EXPECT_EQ(log.GetQuest(1)->objectives[0].current, 0);
+    EXPECT_TRUE(questEvents.Get(Entity(10, 0)).processed);
+
+    system.SetObjectiveIndex(false);
+    EXPECT_EQ(system.IndexedObjectiveCount(), 0u);
+}
+
 // =============================================================================
 // Timed quest tests
 // =============================================================================
@@ -652,6 +770,49 @@ TEST_F(QuestSystemTest, CompletedQuestTimerDoesNotTick) {
     EXPECT_EQ(log.GetQuest(1)->state, QuestState::ObjectivesComplete);
 }
 
+TEST_F(QuestSystemTest, TimerWheelFailsTimedQuestsAtTheirLimit) {
+    auto& log = questLogs.Get(player);
+    QuestSystem system(questLogs, questEvents);
+    system.SetTimerWheel(true);
+
+    QuestTemplate timed = makeKillTemplate(1, 100, 5);
+    timed.timeLimitSeconds = 10.0f;
+    QuestTemplate finished = makeKillTemplate(2, 200, 1);
+    finished.timeLimitSeconds = 5.0f;
+    QuestTemplate restarted = makeKillTemplate(3, 300, 1);
+    restarted.timeLimitSeconds = 4.0f;
+    system.RegisterTemplate(timed);
+    system.RegisterTemplate(finished);
+    system.RegisterTemplate(restarted);
+
+    EXPECT_FALSE(system.AcceptQuest(player, 99));       // unknown template
+    EXPECT_FALSE(system.AcceptQuest(Entity(5, 0), 1));  // no QuestLog
+    ASSERT_TRUE(system.AcceptQuest(player, 1));
+    ASSERT_TRUE(system.AcceptQuest(player, 2));
+    ASSERT_TRUE(system.AcceptQuest(player, 3));
+    EXPECT_FALSE(system.AcceptQuest(player, 1));  // already active
+    log.GetQuest(2)->UpdateObjective(ObjectiveType::Kill, 200);
+
+    // Abandoning and accepting again restarts the limit.
+    system.Execute(3.0f);
+    ASSERT_TRUE(log.Abandon(3));
+    ASSERT_TRUE(system.AcceptQuest(player, 3));
+
+    system.Execute(3.0f);
+    EXPECT_EQ(log.GetQuest(1)->state, QuestState::Accepted);
+    EXPECT_EQ(log.GetQuest(2)->state, QuestState::ObjectivesComplete);
+    EXPECT_EQ(log.GetQuest(3)->state, QuestState::Accepted);
+
+    system.Execute(1.0f);
+    EXPECT_EQ(log.GetQuest(3)->state, QuestState::Failed);
+    EXPECT_EQ(log.GetQuest(1)->state, QuestState::Accepted);
+
+    system.Execute(3.0f);
+    EXPECT_EQ(log.GetQuest(1)->state, QuestState::Failed);
+    EXPECT_FLOAT_EQ(log.GetQuest(1)->elapsedTime, 10.0f);
+    EXPECT_EQ(log.GetQuest(2)->state, QuestState::ObjectivesComplete);
+}
+
 // =============================================================================
 // QuestSystem template registry
 // =============================================================================
@@ -701,6 +862,26 @@ TEST(QuestSystemTemplateTest, RegisterTemplateOverwritesExisting) {
     EXPECT_EQ(system.GetTemplate(1)->name, "Version 2");
 }
 
+TEST(QuestSystemTemplateTest, AcceptsFromASharedDatabase) {
+    ComponentStorage<QuestLog> logs;
+    ComponentStorage<QuestEvent> events;
+
+    std::vector<QuestTemplate> templates(3);
+    for (uint32_t i = 0; i < templates.size(); ++i) {
+        templates[i].id = 10 + i;
+    }
+    auto db = QuestTemplateDatabase::Build(std::move(templates));
+
+    QuestSystem system(logs, events);
+    system.SetTemplates(db);
+
+    Entity player(1, 0);
+    logs.Add(player, QuestLog{});
+    EXPECT_TRUE(system.AcceptQuest(player, 11));
+    EXPECT_FALSE(system.AcceptQuest(player, 13));
+    EXPECT_EQ(system.GetTemplateDatabase()->Size(), 3u);
+}
+
 // =============================================================================
 // QuestSystem metadata
 // =============================================================================
@@ -0,0 +1,285 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "cgs/ecs/component_storage.hpp"
+#include "cgs/ecs/component_type_id.hpp"
+#include "cgs/ecs/entity.hpp"
+#include "cgs/ecs/system_scheduler.hpp"
+#include "cgs/game/components.hpp"
+#include "cgs/game/math_types.hpp"
+#include "cgs/game/replication_system.hpp"
+#include "cgs/game/world_components.hpp"
+#include "cgs/game/world_system.hpp"
+
+using namespace cgs::ecs;
+using namespace cgs::game;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Delta snapshot tests
+// ═══════════════════════════════════════════════════════════════════════════
+
+class ReplicationTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        replication.Replicate(transforms);
+        replication.Replicate(movements);
+        replica.Register<Transform>();
+        replica.Register<Movement>();
+        replication.AddClient(viewer);
+    }
+
+    Entity spawn(uint32_t id, const Vector3& pos) {
+        Entity e(id, 0);
+        transforms.Add(e, Transform{pos, {}, {1.0f, 1.0f, 1.0f}});
+        return e;
+    }
+
+    /// Capture a snapshot, write the viewer's packet and apply it.
+    std::vector<uint8_t> tick(bool ack = true) {
+        replication.Execute(0.05f);
+        std::vector<uint8_t> packet;
+        EXPECT_TRUE(replication.WriteSnapshot(viewer, packet));
+        const auto sequence = replica.Apply(packet);
+        EXPECT_TRUE(sequence.has_value());
+        if (ack && sequence) {
+            replication.Acknowledge(viewer, *sequence);
+        }
+        return packet;
+    }
+
+    ComponentStorage<Transform> transforms;
+    ComponentStorage<Movement> movements;
+    ReplicationSystem replication;
+    ReplicaState replica;
+    Entity viewer{1, 0};
+};
+
+TEST_F(ReplicationTest, FullSnapshotRoundTrips) {
+    spawn(1, Vector3(1.0f, 2.0f, 3.0f));
+    spawn(40, Vector3(-5.0f, 0.0f, 9.0f));
+    Movement run;
+    run.speed = 7.5f;
+    run.direction = Vector3(0.0f, 0.0f, 1.0f);
+    run.state = MovementState::Running;
+    movements.Add(Entity(40, 0), run);
+
+    std::vector<uint8_t> other;
+    EXPECT_FALSE(replication.WriteSnapshot(viewer, other));  // nothing captured yet
+    tick();
+
+    EXPECT_EQ(replica.Sequence(), 1u);
+    ASSERT_EQ(replica.Entities().size(), 2u);
+    EXPECT_EQ(replica.Entities()[0], 1u);
+    EXPECT_EQ(replica.Entities()[1], 40u);
+
+    Transform t;
+    ASSERT_TRUE(replica.Get(40, t));
+    EXPECT_FLOAT_EQ(t.position.x, -5.0f);
+    EXPECT_FLOAT_EQ(t.position.z, 9.0f);
+    Movement m;
+    ASSERT_TRUE(replica.Get(40, m));
+    EXPECT_FLOAT_EQ(m.speed, 7.5f);
+    EXPECT_EQ(m.state, MovementState::Running);
+    EXPECT_FALSE(replica.Get(1, m));
+    EXPECT_FALSE(replica.Get(2, t));
+}
+
+TEST_F(ReplicationTest, AckedBaselineShrinksPacketsToChangedFields) {
+    for (uint32_t id = 1; id <= 50; ++id) {
+        spawn(id, Vector3(static_cast<float>(id), 0.0f, 0.0f));
+    }
+    const auto full = tick();
+
+    // Nothing changed: only the header and the end marker.
+    const auto idle = tick();
+    EXPECT_EQ(idle.size(), 9u);
+
+    transforms.Get(Entity(7, 0)).position.y = 4.0f;
+    const auto delta = tick();
+    EXPECT_LT(delta.size(), full.size() / 20);
+    EXPECT_GT(delta.size(), idle.size());
+
+    Transform t;
+    ASSERT_TRUE(replica.Get(7, t));
+    EXPECT_FLOAT_EQ(t.position.x, 7.0f);
+    EXPECT_FLOAT_EQ(t.position.y, 4.0f);
+    ASSERT_TRUE(replica.Get(8, t));
+    EXPECT_FLOAT_EQ(t.position.x, 8.0f);
+}
+
+TEST_F(ReplicationTest, UnackedPacketsStayDeltasAgainstLastAck) {
+    spawn(1, Vector3(1.0f, 0.0f, 0.0f));
+    tick();
+
+    // Two lost packets: the third is still a delta against snapshot 1.
+    transforms.Get(Entity(1, 0)).position.x = 2.0f;
+    replication.Execute(0.05f);
+    transforms.Get(Entity(1, 0)).position.x = 3.0f;
+    replication.Execute(0.05f);
+    tick();
+
+    EXPECT_EQ(replica.Sequence(), 4u);
+    Transform t;
+    ASSERT_TRUE(replica.Get(1, t));
+    EXPECT_FLOAT_EQ(t.position.x, 3.0f);
+}
+
+TEST_F(ReplicationTest, RemovalsAndComponentChangesApply) {
+    spawn(1, Vector3());
+    spawn(2, Vector3());
+    spawn(3, Vector3());
+    tick();
+
+    transforms.Remove(Entity(2, 0));
+    movements.Add(Entity(3, 0), Movement{});
+    movements.Get(Entity(3, 0)).speed = 2.0f;
+    spawn(4, Vector3(4.0f, 0.0f, 0.0f));
+    tick();
+
+    ASSERT_EQ(replica.Entities().size(), 3u);
+    EXPECT_EQ(replica.Entities()[0], 1u);
+    EXPECT_EQ(replica.Entities()[1], 3u);
+    EXPECT_EQ(replica.Entities()[2], 4u);
+    Movement m;
+    ASSERT_TRUE(replica.Get(3, m));
+    EXPECT_FLOAT_EQ(m.speed, 2.0f);
+
+    transforms.Remove(Entity(3, 0));
+    tick();
+    Transform t;
+    EXPECT_FALSE(replica.Get(3, t));
+    ASSERT_TRUE(replica.Get(3, m));
+    EXPECT_FLOAT_EQ(m.speed, 2.0f);
+}
+
+TEST_F(ReplicationTest, RejectsUnknownBaselineAndMalformedPackets) {
+    spawn(1, Vector3());
+    tick();
+    spawn(2, Vector3());
+    replication.Execute(0.05f);
+    std::vector<uint8_t> delta;
+    ASSERT_TRUE(replication.WriteSnapshot(viewer, delta));
+
+    ReplicaState fresh;
+    fresh.Register<Transform>();
+    fresh.Register<Movement>();
+    EXPECT_FALSE(fresh.Apply(delta).has_value());  // baseline 1 never applied
+    EXPECT_EQ(fresh.Sequence(), 0u);
+
+    std::vector<uint8_t> truncated(delta.begin(), delta.end() - 1);
+    EXPECT_FALSE(replica.Apply(truncated).has_value());
+    EXPECT_FALSE(replica.Apply({}).has_value());
+    EXPECT_EQ(replica.Sequence(), 1u);
+
+    EXPECT_EQ(replica.Apply(delta), std::optional<uint32_t>(2u));
+    EXPECT_EQ(replica.Entities().size(), 2u);
+}
+
+TEST_F(ReplicationTest, ClientBookkeeping) {
+    EXPECT_EQ(replication.ClientCount(), 1u);
+    replication.AddClient(viewer);
+    replication.AddClient(Entity(2, 0));
+    EXPECT_EQ(replication.ClientCount(), 2u);
+    replication.RemoveClient(Entity(2, 0));
+    EXPECT_EQ(replication.ClientCount(), 1u);
+
+    replication.Execute(0.05f);
+    std::vector<uint8_t> packet;
+    EXPECT_FALSE(replication.WriteSnapshot(Entity(2, 0), packet));
+    EXPECT_TRUE(packet.empty());
+
+    // Acks for snapshots not yet taken are ignored.
+    replication.Acknowledge(viewer, 5);
+    replication.Execute(0.05f);
+    ASSERT_TRUE(replication.WriteSnapshot(viewer, packet));
+    EXPECT_EQ(replica.Apply(packet), std::optional<uint32_t>(2u));
+}
+
+TEST(ReplicationSystemTest, DeclaresReadAccessInPostUpdate) {
+    ComponentStorage<Transform> transforms;
+    ReplicationSystem replication;
+    replication.Replicate(transforms);
+    EXPECT_EQ(replication.GetStage(), SystemStage::PostUpdate);
+    EXPECT_EQ(replication.GetName(), "ReplicationSystem");
+    const auto access = replication.GetAccessInfo();
+    EXPECT_EQ(access.reads.count(ComponentType<Transform>::Id()), 1u);
+    EXPECT_TRUE(access.writes.empty());
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// Interest filtering tests
+// ═══════════════════════════════════════════════════════════════════════════
+
+class ReplicationInterestTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        mapInstances.Add(mapEntity, MapInstance{1, 1, MapType::OpenWorld});
+        world = &scheduler.Register<WorldSystem>(transforms, memberships, mapInstances,
+                                                 visibilityRanges, zones);
+        world->SetInterestManagement(true);
+        replication = &scheduler.Register<ReplicationSystem>(world);
+        replication->Replicate(transforms);
+        ASSERT_TRUE(scheduler.Build());
+        replica.Register<Transform>();
+    }
+
+    Entity createEntityOnMap(uint32_t id, const Vector3& pos) {
+        Entity e(id, 0);
+        transforms.Add(e, Transform{pos, {}, {1.0f, 1.0f, 1.0f}});
+        memberships.Add(e, MapMembership{mapEntity, 0});
+        return e;
+    }
+
+    void moveTo(Entity e, float x, float z) {
+        transforms.Get(e).position = Vector3(x, 0.0f, z);
+        transforms.MarkChanged(e);
+    }
+
+    void tick(Entity viewer) {
+        scheduler.Execute(0.05f);
+        std::vector<uint8_t> packet;
+        ASSERT_TRUE(replication->WriteSnapshot(viewer, packet));
+        const auto sequence = replica.Apply(packet);
+        ASSERT_TRUE(sequence.has_value());
+        replication->Acknowledge(viewer, *sequence);
+    }
+
+    ComponentStorage<Transform> transforms;
+    ComponentStorage<MapMembership> memberships;
+    ComponentStorage<MapInstance> mapInstances;
+    ComponentStorage<VisibilityRange> visibilityRanges;
+    ComponentStorage<Zone> zones;
+    Entity mapEntity{0, 0};
+
+    SystemScheduler scheduler;
+    WorldSystem* world = nullptr;
+    ReplicationSystem* replication = nullptr;
+    ReplicaState replica;
+};
+
+TEST_F(ReplicationInterestTest, ReplicatesOnlyTheViewersInterestSet) {
+    Entity viewer = createEntityOnMap(1, Vector3(16.0f, 0.0f, 16.0f));
+    visibilityRanges.Add(viewer, VisibilityRange{32.0f});
+    Entity near = createEntityOnMap(2, Vector3(40.0f, 0.0f, 16.0f));
+    Entity far = createEntityOnMap(3, Vector3(900.0f, 0.0f, 900.0f));
+    replication->AddClient(viewer);
+
+    tick(viewer);
+    ASSERT_EQ(replica.Entities().size(), 2u);
+    EXPECT_EQ(replica.Entities()[0], viewer.id());
+    EXPECT_EQ(replica.Entities()[1], near.id());
+
+    // The far entity walks in and the near one walks out of range.
+    moveTo(far, 30.0f, 20.0f);
+    moveTo(near, 900.0f, 16.0f);
+    tick(viewer);
+    ASSERT_EQ(replica.Entities().size(), 2u);
+    EXPECT_EQ(replica.Entities()[1], far.id());
+
+    Transform t;
+    ASSERT_TRUE(replica.Get(far.id(), t));
+    EXPECT_FLOAT_EQ(t.position.x, 30.0f);
+    EXPECT_FALSE(replica.Get(near.id(), t));
+}
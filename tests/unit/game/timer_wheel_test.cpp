@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "cgs/game/timer_wheel.hpp"
+
+using namespace cgs::game;
+
+// ── Scheduling ──────────────────────────────────────────────────────────────
+
+TEST(TimerWheelTest, FiresOnTheAdvanceThatReachesTheDeadline) {
+    TimerWheel wheel;
+    std::vector<uint64_t> fired;
+    const auto record = [&fired](uint64_t payload) { fired.push_back(payload); };
+
+    wheel.Schedule(5.0f, 7);
+    for (int i = 0; i < 4; ++i) {
+        wheel.Advance(1.0f, record);
+    }
+    EXPECT_TRUE(fired.empty());
+    EXPECT_EQ(wheel.Size(), 1u);
+
+    wheel.Advance(1.0f, record);
+    EXPECT_EQ(fired, std::vector<uint64_t>{7});
+    EXPECT_TRUE(wheel.Empty());
+    EXPECT_EQ(wheel.Now(), 5000u);
+}
+
+TEST(TimerWheelTest, SubTickFramesAccumulate) {
+    TimerWheel wheel;
+    std::size_t fired = 0;
+    wheel.Schedule(0.1f, 1);
+
+    // 0.016 s frames: due on the seventh frame (0.112 s).
+    for (int frame = 1; frame <= 7; ++frame) {
+        fired += wheel.Advance(0.016f, [](uint64_t) {});
+        EXPECT_EQ(fired, frame < 7 ? 0u : 1u) << "frame " << frame;
+    }
+}
+
+TEST(TimerWheelTest, ZeroDelayFiresOnTheNextAdvance) {
+    TimerWheel wheel;
+    std::size_t fired = 0;
+    wheel.Schedule(0.0f, 1);
+    EXPECT_EQ(wheel.Advance(0.0f, [&fired](uint64_t) { ++fired; }), 0u);
+    EXPECT_EQ(wheel.Advance(0.016f, [&fired](uint64_t) { ++fired; }), 1u);
+    EXPECT_EQ(fired, 1u);
+}
+
+TEST(TimerWheelTest, CancelInvalidatesTheHandle) {
+    TimerWheel wheel;
+    const TimerId first = wheel.Schedule(1.0f, 1);
+    EXPECT_TRUE(wheel.IsPending(first));
+    EXPECT_EQ(wheel.DeadlineOf(first), 1000u);
+
+    EXPECT_TRUE(wheel.Cancel(first));
+    EXPECT_FALSE(wheel.IsPending(first));
+    EXPECT_FALSE(wheel.Cancel(first));
+    EXPECT_FALSE(wheel.Cancel(TimerId{}));
+
+    // The node is reused; the stale handle must not match it.
+    const TimerId second = wheel.Schedule(1.0f, 2);
+    EXPECT_EQ(second.index, first.index);
+    EXPECT_FALSE(wheel.IsPending(first));
+    EXPECT_FALSE(wheel.Cancel(first));
+    EXPECT_TRUE(wheel.IsPending(second));
+
+    std::vector<uint64_t> fired;
+    wheel.Advance(2.0f, [&fired](uint64_t payload) { fired.push_back(payload); });
+    EXPECT_EQ(fired, std::vector<uint64_t>{2});
+    EXPECT_FALSE(wheel.IsPending(second));
+}
+
+TEST(TimerWheelTest, VisitorMayRescheduleAndCancel) {
+    TimerWheel wheel;
+    std::vector<uint64_t> fired;
+    TimerId victim;
+
+    wheel.ScheduleAt(10, 1);
+    victim = wheel.ScheduleAt(10, 2);
+    wheel.ScheduleAt(10, 3);
+    wheel.AdvanceTo(20, [&](uint64_t payload) {
+        fired.push_back(payload);
+        if (payload != 2) {
+            wheel.Cancel(victim);  // drops 2 if it has not fired yet
+        }
+        if (payload == 3) {
+            wheel.ScheduleAt(15, 4);  // due later in the same advance
+        }
+    });
+
+    ASSERT_GE(fired.size(), 3u);
+    EXPECT_EQ(fired.back(), 4u);
+    EXPECT_LE(fired.size(), 4u);
+    EXPECT_TRUE(wheel.Empty());
+}
+
+TEST(TimerWheelTest, ClearDropsEveryTimer) {
+    TimerWheel wheel;
+    const TimerId near = wheel.Schedule(0.5f, 1);
+    wheel.ScheduleAt(uint64_t{1} << 40, 2);
+    wheel.Clear();
+    EXPECT_TRUE(wheel.Empty());
+    EXPECT_FALSE(wheel.IsPending(near));
+    EXPECT_EQ(wheel.AdvanceTo(uint64_t{1} << 41, [](uint64_t) {}), 0u);
+}
+
+// ── Levels and cascading ────────────────────────────────────────────────────
+
+TEST(TimerWheelTest, MatchesBruteForceAcrossLevels) {
+    std::mt19937_64 rng(31);
+    // Deadline spans that land on every level and in the overflow list.
+    const uint64_t spans[] = {uint64_t{1} << 8,
+                              uint64_t{1} << 16,
+                              uint64_t{1} << 24,
+                              uint64_t{1} << 32,
+                              uint64_t{1} << 36};
+
+    TimerWheel wheel;
+    std::multimap<uint64_t, uint64_t> expected;  // deadline -> payload
+    std::map<uint64_t, TimerId> handles;
+    uint64_t payload = 0;
+    for (const uint64_t span : spans) {
+        std::uniform_int_distribution<uint64_t> delay(1, span);
+        for (int i = 0; i < 200; ++i, ++payload) {
+            const uint64_t deadline = delay(rng);
+            handles[payload] = wheel.ScheduleAt(deadline, payload);
+            expected.emplace(deadline, payload);
+        }
+    }
+    // Cancel every tenth timer.
+    for (uint64_t p = 0; p < payload; p += 10) {
+        ASSERT_TRUE(wheel.Cancel(handles[p]));
+        std::erase_if(expected, [p](const auto& entry) { return entry.second == p; });
+    }
+
+    uint64_t lastDeadline = 0;
+    std::size_t fired = 0;
+    std::uniform_int_distribution<uint64_t> step(1, uint64_t{1} << 30);
+    while (!wheel.Empty()) {
+        const uint64_t target = wheel.Now() + step(rng);
+        wheel.AdvanceTo(target, [&](uint64_t p) {
+            const auto it = std::find_if(expected.begin(), expected.end(), [p](const auto& e) {
+                return e.second == p;
+            });
+            ASSERT_NE(it, expected.end()) << "unexpected payload " << p;
+            EXPECT_EQ(it->first, wheel.Now()) << "payload " << p;
+            EXPECT_GE(it->first, lastDeadline);
+            lastDeadline = it->first;
+            expected.erase(it);
+            ++fired;
+        });
+        ASSERT_LE(wheel.Now(), target);
+    }
+    EXPECT_TRUE(expected.empty());
+    EXPECT_EQ(fired, 900u);
+}
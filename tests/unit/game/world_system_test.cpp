@@ -2,6 +2,15 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory_resource>
+#include <numbers>
+#include <random>
+#include <set>
+#include <vector>
 
 #include "cgs/ecs/component_storage.hpp"
 #include "cgs/ecs/entity.hpp"
@@ -9,6 +18,7 @@
 #include "cgs/ecs/system_scheduler.hpp"
 #include "cgs/game/components.hpp"
 #include "cgs/game/math_types.hpp"
+#include "cgs/game/spatial_filter.hpp"
 #include "cgs/game/spatial_index.hpp"
 #include "cgs/game/world_components.hpp"
 #include "cgs/game/world_system.hpp"
@@ -160,6 +170,70 @@ TEST(VisibilityRangeTest, CustomRange) {
     EXPECT_FLOAT_EQ(vr.range, 50.0f);
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// Spatial filter kernel tests
+// ═══════════════════════════════════════════════════════════════════════════
+
+namespace {
+
+/// Rows ForEachMatch() visits, next to the rows the scalar test accepts.
+template <typename Shape>
+void ExpectKernelMatchesScalar(const std::vector<float>& xs, const std::vector<float>& zs,
+                               const Shape& shape) {
+    std::vector<std::size_t> scalar;
+    for (std::size_t row = 0; row < xs.size(); ++row) {
+        if (shape.Contains(xs[row], zs[row])) {
+            scalar.push_back(row);
+        }
+    }
+    std::vector<std::size_t> packed;
+    ForEachMatch(xs.data(), zs.data(), xs.size(), shape,
+                 [&](std::size_t row) { packed.push_back(row); });
+    EXPECT_EQ(packed, scalar);
+    EXPECT_FALSE(scalar.empty());
+    EXPECT_LT(scalar.size(), xs.size());
+}
+
+}  // namespace
+
+TEST(SpatialFilterTest, PackedKernelsMatchScalarTests) {
+    // 37 rows: four full blocks of eight plus a scalar tail.
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> coord(-50.0f, 50.0f);
+    std::vector<float> xs(37);
+    std::vector<float> zs(37);
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        xs[i] = coord(rng);
+        zs[i] = coord(rng);
+    }
+
+    ExpectKernelMatchesScalar(xs, zs, CircleXZ::Make(Vector3(5.0f, 0.0f, -5.0f), 30.0f));
+    ExpectKernelMatchesScalar(xs, zs,
+                              ConeXZ::Make(Vector3(0.0f, 0.0f, 0.0f), Vector3(1.0f, 0.0f, 1.0f),
+                                           45.0f, std::numbers::pi_v<float> / 4.0f));
+    ExpectKernelMatchesScalar(xs, zs,
+                              ConeXZ::Make(Vector3(0.0f, 0.0f, 0.0f), Vector3(0.0f, 0.0f, -1.0f),
+                                           60.0f, 2.5f));  // wider than a half plane
+    ExpectKernelMatchesScalar(xs, zs, BoxXZ{-20.0f, -10.0f, 25.0f, 40.0f});
+    ExpectKernelMatchesScalar(
+        xs, zs, SegmentXZ::Make(Vector3(-40.0f, 0.0f, -30.0f), Vector3(35.0f, 0.0f, 20.0f), 8.0f));
+    ExpectKernelMatchesScalar(
+        xs, zs, SegmentXZ::Make(Vector3(10.0f, 0.0f, 10.0f), Vector3(10.0f, 0.0f, 10.0f), 25.0f));
+}
+
+TEST(SpatialFilterTest, MatchMaskSetsOneBitPerRow) {
+    const float xs[8] = {0.0f, 10.0f, 1.0f, 10.0f, 2.0f, 10.0f, 3.0f, 10.0f};
+    const float zs[8] = {};
+    EXPECT_EQ(MatchMask8(xs, zs, CircleXZ::Make(Vector3(0.0f, 0.0f, 0.0f), 5.0f)), 0b0101'0101u);
+
+    // The apex itself is inside, points behind it are not.
+    const float behind[8] = {0.0f, -1.0f, -2.0f, -3.0f, 1.0f, 2.0f, 3.0f, 4.0f};
+    EXPECT_EQ(MatchMask8(behind, zs,
+                         ConeXZ::Make(Vector3(0.0f, 0.0f, 0.0f), Vector3(1.0f, 0.0f, 0.0f), 10.0f,
+                                      0.1f)),
+              0b1111'0001u);
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // SpatialIndex tests (SRS-GML-003.3)
 // ═══════════════════════════════════════════════════════════════════════════
@@ -291,6 +365,309 @@ TEST_F(SpatialIndexTest, QueryRadiusFindsNearbyEntities) {
     EXPECT_EQ(it, nearby.end());
 }
 
+TEST_F(SpatialIndexTest, CellEntitiesViewsOccupiedCells) {
+    Entity e1(0, 0);
+    Entity e2(1, 0);
+    index.Insert(e1, Vector3(1.0f, 0.0f, 1.0f));
+    index.Insert(e2, Vector3(2.0f, 0.0f, 2.0f));
+
+    auto cell = index.CellEntities(CellCoord{0, 0});
+    ASSERT_EQ(cell.size(), 2u);
+    EXPECT_EQ(cell[0], e1);
+    EXPECT_EQ(cell[1], e2);
+    EXPECT_TRUE(index.CellEntities(CellCoord{5, 5}).empty());
+}
+
+TEST_F(SpatialIndexTest, BufferAndVisitorQueriesMatchQueryRadius) {
+    for (uint32_t i = 0; i < 20; ++i) {
+        const float offset = static_cast<float>(i) * 7.0f;
+        index.Insert(Entity(i, 0), Vector3(offset, 0.0f, offset - 40.0f));
+    }
+    const Vector3 center(30.0f, 0.0f, 0.0f);
+    const auto expected = index.QueryRadius(center, 40.0f);
+
+    std::vector<Entity> buffer{Entity(99, 0)};
+    index.QueryRadius(center, 40.0f, buffer);
+    ASSERT_EQ(buffer.size(), expected.size() + 1);  // appended, not replaced
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), buffer.begin() + 1));
+
+    std::vector<Entity> visited;
+    index.ForEachInRadius(center, 40.0f, [&](Entity e) { visited.push_back(e); });
+    EXPECT_EQ(visited, expected);
+}
+
+TEST_F(SpatialIndexTest, RadiusFiltersOnStoredPositions) {
+    Entity near(0, 0);
+    Entity far(1, 0);
+    index.Insert(near, Vector3(2.0f, 50.0f, 2.0f));  // Y is ignored.
+    index.Insert(far, Vector3(14.0f, 0.0f, 14.0f));  // same cell, outside radius
+
+    EXPECT_EQ(index.QueryRadius(Vector3(0.0f, 0.0f, 0.0f), 5.0f), std::vector<Entity>{near});
+
+    // Moving within the cell updates the stored position.
+    index.Update(far, Vector3(3.0f, 0.0f, 3.0f));
+    ASSERT_EQ(index.CellCount(), 1u);
+    ASSERT_EQ(index.CellPositions(CellCoord{0, 0}).x.size(), 2u);
+    EXPECT_FLOAT_EQ(index.CellPositions(CellCoord{0, 0}).x[1], 3.0f);
+    EXPECT_EQ(index.QueryRadius(Vector3(0.0f, 0.0f, 0.0f), 5.0f).size(), 2u);
+}
+
+TEST_F(SpatialIndexTest, RemovalKeepsCellRowsConsistentAcrossTableGrowth) {
+    // 400 entities over 100 cells forces several table doublings.
+    for (uint32_t i = 0; i < 400; ++i) {
+        const float x = static_cast<float>(i % 10) * 16.0f - 80.0f;
+        const float z = static_cast<float>((i / 10) % 10) * 16.0f - 80.0f;
+        index.Insert(Entity(i, 0), Vector3(x + 1.0f, 0.0f, z + 1.0f));
+    }
+    for (uint32_t i = 0; i < 400; i += 3) {
+        index.Remove(Entity(i, 0));
+    }
+    EXPECT_EQ(index.CellCount(), 100u);
+
+    std::size_t seen = 0;
+    for (int32_t cx = -5; cx < 5; ++cx) {
+        for (int32_t cy = -5; cy < 5; ++cy) {
+            const auto entities = index.CellEntities(CellCoord{cx, cy});
+            const auto positions = index.CellPositions(CellCoord{cx, cy});
+            ASSERT_EQ(entities.size(), positions.x.size());
+            ASSERT_EQ(entities.size(), positions.z.size());
+            for (std::size_t row = 0; row < entities.size(); ++row) {
+                EXPECT_NE(entities[row].id() % 3, 0u);
+                EXPECT_EQ(index.WorldToCell(Vector3(positions.x[row], 0.0f, positions.z[row])),
+                          (CellCoord{cx, cy}));
+            }
+            seen += entities.size();
+        }
+    }
+    EXPECT_EQ(seen, index.Size());
+    EXPECT_EQ(index.Size(), 266u);
+}
+
+TEST_F(SpatialIndexTest, NewVersionReplacesStaleHandle) {
+    index.Insert(Entity(5, 0), Vector3(1.0f, 0.0f, 1.0f));
+    index.Insert(Entity(5, 1), Vector3(40.0f, 0.0f, 40.0f));
+
+    EXPECT_FALSE(index.Contains(Entity(5, 0)));
+    EXPECT_TRUE(index.Contains(Entity(5, 1)));
+    EXPECT_EQ(index.Size(), 1u);
+    EXPECT_TRUE(index.QueryCell(0, 0).empty());
+
+    index.Remove(Entity(5, 0));  // stale handle: no-op
+    EXPECT_EQ(index.Size(), 1u);
+}
+
+TEST_F(SpatialIndexTest, ConeAndBoxQueries) {
+    Entity ahead(0, 0);
+    Entity wide(1, 0);
+    Entity behind(2, 0);
+    Entity far(3, 0);
+    index.Insert(ahead, Vector3(0.0f, 0.0f, 20.0f));
+    index.Insert(wide, Vector3(20.0f, 0.0f, 5.0f));
+    index.Insert(behind, Vector3(0.0f, 0.0f, -10.0f));
+    index.Insert(far, Vector3(0.0f, 0.0f, 80.0f));
+
+    // 30 degree half angle facing +Z.
+    const auto cone = index.QueryCone(Vector3(0.0f, 0.0f, 0.0f), Vector3(0.0f, 0.0f, 1.0f),
+                                      50.0f, std::numbers::pi_v<float> / 6.0f);
+    EXPECT_EQ(cone, std::vector<Entity>{ahead});
+
+    auto box = index.QueryBox(Vector3(-5.0f, 0.0f, -15.0f), Vector3(25.0f, 0.0f, 10.0f));
+    std::sort(box.begin(), box.end());
+    EXPECT_EQ(box, (std::vector<Entity>{wide, behind}));
+
+    EXPECT_TRUE(index.QueryCone(Vector3(0.0f, 0.0f, 0.0f), Vector3(0.0f, 0.0f, 1.0f), 0.0f, 1.0f)
+                    .empty());
+    EXPECT_TRUE(index.QueryBox(Vector3(10.0f, 0.0f, 0.0f), Vector3(0.0f, 0.0f, 0.0f)).empty());
+}
+
+TEST(SpatialIndexTwoLevelTest, MatchesSingleLevelGridForEveryRadius) {
+    SpatialIndex flat(8.0f);
+    SpatialIndex twoLevel(8.0f, 4);
+    ASSERT_EQ(twoLevel.CoarseFactor(), 4u);
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> coord(-300.0f, 300.0f);
+    for (uint32_t i = 0; i < 2000; ++i) {
+        const Vector3 pos(coord(rng), 0.0f, coord(rng));
+        flat.Insert(Entity(i, 0), pos);
+        twoLevel.Insert(Entity(i, 0), pos);
+    }
+    // Move and remove some entities so coarse lists see emptied cells.
+    for (uint32_t i = 0; i < 2000; i += 5) {
+        const Vector3 pos(coord(rng), 0.0f, coord(rng));
+        flat.Update(Entity(i, 0), pos);
+        twoLevel.Update(Entity(i, 0), pos);
+    }
+    for (uint32_t i = 1; i < 2000; i += 7) {
+        flat.Remove(Entity(i, 0));
+        twoLevel.Remove(Entity(i, 0));
+    }
+    EXPECT_GT(twoLevel.CoarseCellCount(), 0u);
+    EXPECT_EQ(flat.CoarseCellCount(), 0u);
+
+    for (const float radius : {3.0f, 20.0f, 75.0f, 200.0f}) {
+        for (const Vector3& center :
+             {Vector3(0.0f, 0.0f, 0.0f), Vector3(-123.0f, 0.0f, 57.0f), Vector3(290.0f, 0.0f, -290.0f)}) {
+            auto expected = flat.QueryRadius(center, radius);
+            auto actual = twoLevel.QueryRadius(center, radius);
+            std::sort(expected.begin(), expected.end());
+            std::sort(actual.begin(), actual.end());
+            EXPECT_EQ(actual, expected) << "radius " << radius;
+        }
+    }
+
+    auto expectedBox = flat.QueryBox(Vector3(-250.0f, 0.0f, -40.0f), Vector3(250.0f, 0.0f, 10.0f));
+    auto actualBox = twoLevel.QueryBox(Vector3(-250.0f, 0.0f, -40.0f), Vector3(250.0f, 0.0f, 10.0f));
+    std::sort(expectedBox.begin(), expectedBox.end());
+    std::sort(actualBox.begin(), actualBox.end());
+    EXPECT_EQ(actualBox, expectedBox);
+
+    twoLevel.Clear();
+    EXPECT_EQ(twoLevel.CoarseCellCount(), 0u);
+    EXPECT_TRUE(twoLevel.QueryRadius(Vector3(0.0f, 0.0f, 0.0f), 200.0f).empty());
+}
+
+TEST(SpatialIndexBatchTest, UpdateBatchMatchesPerEntityUpdates) {
+    SpatialIndex single(16.0f);
+    SpatialIndex batched(16.0f);
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> coord(-200.0f, 200.0f);
+    std::uniform_real_distribution<float> step(-4.0f, 4.0f);
+
+    std::vector<Vector3> positions;
+    for (uint32_t i = 0; i < 500; ++i) {
+        positions.emplace_back(coord(rng), 0.0f, coord(rng));
+        single.Insert(Entity(i, 0), positions.back());
+        batched.Insert(Entity(i, 0), positions.back());
+    }
+
+    std::vector<SpatialUpdate> updates;
+    for (uint32_t i = 0; i < 500; i += 2) {
+        // Small steps: mostly same-cell moves, some cell crossers.
+        positions[i] = positions[i] + Vector3(step(rng), 0.0f, step(rng));
+        updates.push_back(SpatialUpdate{Entity(i, 0), positions[i]});
+    }
+    updates.push_back(SpatialUpdate{Entity(700, 0), Vector3(5.0f, 0.0f, 5.0f)});  // new
+    updates.push_back(SpatialUpdate{Entity(3, 1), Vector3(-7.0f, 0.0f, 9.0f)});   // reused id
+    for (const auto& update : updates) {
+        single.Update(update.entity, update.position);
+    }
+    batched.UpdateBatch(updates);
+
+    EXPECT_EQ(batched.Size(), single.Size());
+    EXPECT_TRUE(batched.Contains(Entity(700, 0)));
+    EXPECT_TRUE(batched.Contains(Entity(3, 1)));
+    EXPECT_FALSE(batched.Contains(Entity(3, 0)));
+    for (const Vector3& center : {Vector3(0.0f, 0.0f, 0.0f), Vector3(120.0f, 0.0f, -80.0f)}) {
+        auto expected = single.QueryRadius(center, 90.0f);
+        auto actual = batched.QueryRadius(center, 90.0f);
+        std::sort(expected.begin(), expected.end());
+        std::sort(actual.begin(), actual.end());
+        EXPECT_EQ(actual, expected);
+    }
+
+    batched.UpdateBatch({});
+    EXPECT_EQ(batched.Size(), single.Size());
+}
+
+namespace {
+
+float DistSqXZ(const Vector3& a, const Vector3& b) {
+    const float dx = a.x - b.x;
+    const float dz = a.z - b.z;
+    return dx * dx + dz * dz;
+}
+
+}  // namespace
+
+TEST(SpatialIndexNearestTest, MatchesSortedBruteForce) {
+    SpatialIndex index(16.0f);
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> coord(-300.0f, 300.0f);
+    std::vector<Vector3> positions;
+    for (uint32_t i = 0; i < 1500; ++i) {
+        positions.emplace_back(coord(rng), 0.0f, coord(rng));
+        index.Insert(Entity(i, 0), positions.back());
+    }
+    const auto evenIds = [](Entity entity) { return entity.id() % 2 == 0; };
+
+    for (int query = 0; query < 40; ++query) {
+        // Some centers lie outside the occupied area.
+        const Vector3 center(coord(rng) * 1.5f, 0.0f, coord(rng) * 1.5f);
+        for (const std::size_t k : {std::size_t{1}, std::size_t{7}, std::size_t{40}}) {
+            for (const float maxRadius : {std::numeric_limits<float>::infinity(), 60.0f}) {
+                std::vector<std::pair<float, uint32_t>> brute;
+                for (uint32_t i = 0; i < positions.size(); ++i) {
+                    const float d = DistSqXZ(positions[i], center);
+                    if (i % 2 == 0 && d <= maxRadius * maxRadius) {
+                        brute.emplace_back(d, i);
+                    }
+                }
+                std::sort(brute.begin(), brute.end());
+                brute.resize(std::min(brute.size(), k));
+
+                std::vector<Entity> nearest{Entity(9999, 0)};  // kept in front
+                index.QueryNearest(center, k, nearest, evenIds, maxRadius);
+                ASSERT_EQ(nearest.size(), brute.size() + 1) << "k " << k;
+                EXPECT_EQ(nearest.front(), Entity(9999, 0));
+                for (std::size_t i = 0; i < brute.size(); ++i) {
+                    EXPECT_EQ(nearest[i + 1].id(), brute[i].second) << "rank " << i;
+                }
+            }
+        }
+    }
+
+    // The allocating form has no filter.
+    const auto all = index.QueryNearest(positions[3], 1);
+    EXPECT_EQ(all, std::vector<Entity>{Entity(3, 0)});
+    EXPECT_TRUE(index.QueryNearest(positions[3], 0).empty());
+    EXPECT_TRUE(SpatialIndex().QueryNearest(positions[3], 5).empty());
+}
+
+TEST(SpatialIndexRaycastTest, MatchesBruteForceCapsuleTest) {
+    SpatialIndex index(16.0f);
+    std::mt19937 rng(13);
+    std::uniform_real_distribution<float> coord(-200.0f, 200.0f);
+    std::vector<Vector3> positions;
+    for (uint32_t i = 0; i < 800; ++i) {
+        positions.emplace_back(coord(rng), 0.0f, coord(rng));
+        index.Insert(Entity(i, 0), positions.back());
+    }
+    const auto notMultipleOfThree = [](Entity entity) { return entity.id() % 3 != 0; };
+
+    for (int query = 0; query < 60; ++query) {
+        const Vector3 from(coord(rng), 0.0f, coord(rng));
+        const Vector3 to = query % 10 == 0 ? from : Vector3(coord(rng), 0.0f, coord(rng));
+        // Radii below and above one cell, so the walk widens by 1 or 3 cells.
+        for (const float radius : {0.75f, 40.0f}) {
+            const SegmentXZ segment = SegmentXZ::Make(from, to, radius);
+            std::vector<std::pair<float, uint32_t>> brute;
+            for (uint32_t i = 0; i < positions.size(); ++i) {
+                if (segment.Contains(positions[i].x, positions[i].z)) {
+                    brute.emplace_back(segment.Along(positions[i].x, positions[i].z), i);
+                }
+            }
+            std::sort(brute.begin(), brute.end());
+
+            std::vector<Entity> along;
+            index.QuerySegment(from, to, radius, along);
+            ASSERT_EQ(along.size(), brute.size());
+            for (std::size_t i = 0; i < brute.size(); ++i) {
+                EXPECT_EQ(along[i].id(), brute[i].second);
+            }
+
+            const auto hit = index.Raycast(from, to, radius, notMultipleOfThree);
+            const auto first = std::find_if(brute.begin(), brute.end(),
+                                            [](const auto& e) { return e.second % 3 != 0; });
+            ASSERT_EQ(hit.has_value(), first != brute.end());
+            if (hit) {
+                EXPECT_EQ(hit->entity.id(), first->second);
+                EXPECT_FLOAT_EQ(hit->distance, first->first);
+            }
+        }
+    }
+}
+
 TEST_F(SpatialIndexTest, QueryRadiusZeroReturnsEmpty) {
     Entity e(0, 0);
     index.Insert(e, Vector3(0.0f, 0.0f, 0.0f));
@@ -340,6 +717,40 @@ TEST_F(SpatialIndexTest, ClearRemovesAllEntities) {
     EXPECT_TRUE(result.empty());
 }
 
+TEST_F(SpatialIndexTest, AreasAreFoundFromTheCellsTheyOverlap) {
+    // Radius 20 around (8, 8) reaches cells -1..1 on both axes.
+    index.InsertArea(7, Vector3(8.0f, 0.0f, 8.0f), 20.0f);
+    index.InsertArea(9, Vector3(40.0f, 0.0f, 8.0f), 4.0f);
+    EXPECT_EQ(index.AreaCount(), 2u);
+    EXPECT_EQ(index.Size(), 0u);
+
+    const auto areasAt = [this](float x, float z) {
+        std::vector<uint32_t> areas;
+        index.ForEachAreaAt(Vector3(x, 0.0f, z), [&](uint32_t area) { areas.push_back(area); });
+        std::sort(areas.begin(), areas.end());
+        return areas;
+    };
+    EXPECT_EQ(areasAt(8.0f, 8.0f), std::vector<uint32_t>{7});
+    EXPECT_EQ(areasAt(-12.0f, 8.0f), std::vector<uint32_t>{7});  // boundary
+    EXPECT_TRUE(areasAt(-12.5f, 8.0f).empty());
+    EXPECT_TRUE(areasAt(-8.0f, -8.0f).empty());  // a covered cell, outside the circle
+    EXPECT_EQ(areasAt(26.0f, 8.0f), std::vector<uint32_t>{7});
+    EXPECT_EQ(areasAt(38.0f, 8.0f), std::vector<uint32_t>{9});
+
+    // Re-inserting moves the area; removing drops it from every cell.
+    index.InsertArea(7, Vector3(100.0f, 0.0f, 100.0f), 5.0f);
+    EXPECT_TRUE(areasAt(8.0f, 8.0f).empty());
+    EXPECT_EQ(areasAt(101.0f, 99.0f), std::vector<uint32_t>{7});
+    index.RemoveArea(7);
+    index.RemoveArea(7);
+    EXPECT_TRUE(areasAt(101.0f, 99.0f).empty());
+    EXPECT_EQ(index.AreaCount(), 1u);
+
+    index.Clear();
+    EXPECT_EQ(index.AreaCount(), 0u);
+    EXPECT_TRUE(areasAt(38.0f, 8.0f).empty());
+}
+
 TEST_F(SpatialIndexTest, WorldToCellMapping) {
     // Cell size is 16.0f
     auto c1 = index.WorldToCell(Vector3(0.0f, 0.0f, 0.0f));
@@ -359,6 +770,17 @@ TEST_F(SpatialIndexTest, WorldToCellMapping) {
     EXPECT_EQ(c4.y, -1);
 }
 
+TEST_F(SpatialIndexTest, MortonCodeInterleavesCellCoordinates) {
+    // Z-order within a 2x2 block.
+    EXPECT_LT(MortonCode({0, 0}), MortonCode({1, 0}));
+    EXPECT_LT(MortonCode({1, 0}), MortonCode({0, 1}));
+    EXPECT_LT(MortonCode({0, 1}), MortonCode({1, 1}));
+    // The block finishes before the next one starts.
+    EXPECT_LT(MortonCode({1, 1}), MortonCode({2, 0}));
+    // Negative coordinates order before non-negative ones.
+    EXPECT_LT(MortonCode({-1, -1}), MortonCode({0, 0}));
+}
+
 TEST_F(SpatialIndexTest, InvalidCellSizeFallsBackToDefault) {
     SpatialIndex badIndex(0.0f);
     EXPECT_FLOAT_EQ(badIndex.CellSize(), kDefaultCellSize);
@@ -479,6 +901,114 @@ TEST_F(WorldSystemTest, PositionUpdatesReflectInIndex) {
     EXPECT_NE(found, newEntities.end());  // In new cell.
 }
 
+TEST_F(WorldSystemTest, ScheduledRunsOnlyResyncChangedTransforms) {
+    Entity marked = createEntityOnMap(1, Vector3(0.0f, 0.0f, 0.0f));
+    Entity unmarked = createEntityOnMap(2, Vector3(0.0f, 0.0f, 0.0f));
+
+    SystemScheduler scheduler;
+    auto& system = scheduler.Register<WorldSystem>(
+        transforms, memberships, mapInstances, visibilityRanges, zones);
+    ASSERT_TRUE(scheduler.Build());
+    scheduler.Execute(0.016f);
+
+    const Vector3 target(200.0f, 0.0f, 200.0f);
+    transforms.Get(marked).position = target;
+    transforms.MarkChanged(marked);
+    transforms.Get(unmarked).position = target;  // No MarkChanged().
+    scheduler.Execute(0.016f);
+
+    const auto* spatial = system.GetSpatialIndex(mapEntity);
+    ASSERT_NE(spatial, nullptr);
+    auto cell = spatial->WorldToCell(target);
+    auto entities = spatial->QueryCell(cell.x, cell.y);
+    EXPECT_NE(std::find(entities.begin(), entities.end(), marked), entities.end());
+    EXPECT_EQ(std::find(entities.begin(), entities.end(), unmarked), entities.end());
+}
+
+/// Queries WorldSystem (PreUpdate) from inside the tick.
+class VisibilityProbeSystem : public ISystem {
+public:
+    VisibilityProbeSystem(const WorldSystem& world, Entity viewer)
+        : world_(world), viewer_(viewer) {}
+
+    void Execute(float) override {
+        std::pmr::vector<Entity> visible(FrameMemory());
+        world_.GetVisibleEntities(viewer_, visible);
+        visibleCount = visible.size();
+        usedFrameMemory = FrameMemory() != std::pmr::get_default_resource();
+    }
+
+    [[nodiscard]] std::string_view GetName() const override { return "VisibilityProbeSystem"; }
+
+    std::size_t visibleCount = 0;
+    bool usedFrameMemory = false;
+
+private:
+    const WorldSystem& world_;
+    Entity viewer_;
+};
+
+TEST_F(WorldSystemTest, InTickQueriesAllocateFromFrameArena) {
+    Entity viewer = createEntityOnMap(1, Vector3(0.0f, 0.0f, 0.0f));
+    createEntityOnMap(2, Vector3(10.0f, 0.0f, 10.0f));
+    createEntityOnMap(3, Vector3(500.0f, 0.0f, 500.0f));
+
+    SystemScheduler scheduler;
+    auto& world = scheduler.Register<WorldSystem>(
+        transforms, memberships, mapInstances, visibilityRanges, zones);
+    auto& probe = scheduler.Register<VisibilityProbeSystem>(world, viewer);  // Update stage
+    ASSERT_TRUE(scheduler.Build());
+    scheduler.Execute(0.016f);
+
+    EXPECT_TRUE(probe.usedFrameMemory);
+    EXPECT_EQ(probe.visibleCount, 2u);
+    EXPECT_GT(scheduler.GetFrameArenas().HighWaterMark(), 0u);
+
+    // Outside a tick the value overloads still return owning vectors.
+    EXPECT_EQ(world.GetVisibleEntities(viewer).size(), 2u);
+}
+
+TEST_F(WorldSystemTest, SpatialReorderSpreadsMortonOrderAcrossTicks) {
+    // Insertion order deliberately unrelated to position.
+    const float xs[] = {300.0f, 10.0f, 170.0f, 40.0f, 250.0f, 90.0f, 20.0f, 200.0f};
+    for (uint32_t i = 0; i < 8; ++i) {
+        createEntityOnMap(i + 1, Vector3(xs[i], 0.0f, xs[(i + 3) % 8]));
+    }
+    std::vector<uint32_t> versions;
+    for (uint32_t i = 0; i < 8; ++i) {
+        versions.push_back(transforms.GetVersion(Entity(i + 1, 0)));
+    }
+
+    WorldSystem system(transforms, memberships, mapInstances, visibilityRanges, zones);
+    EXPECT_FALSE(system.GetAccessInfo().writes.contains(ComponentType<Transform>::Id()));
+    system.SetSpatialReorder(3);
+    EXPECT_TRUE(system.GetAccessInfo().writes.contains(ComponentType<Transform>::Id()));
+
+    // 8 entities at 3 per tick: the pass completes on the third tick.
+    system.Execute(0.016f);
+    system.Execute(0.016f);
+    EXPECT_EQ(system.SpatialReorderPasses(), 0u);
+    system.Execute(0.016f);
+    EXPECT_EQ(system.SpatialReorderPasses(), 1u);
+
+    const auto* spatial = system.GetSpatialIndex(mapEntity);
+    ASSERT_NE(spatial, nullptr);
+    uint64_t previous = 0;
+    for (std::size_t i = 0; i < transforms.Size(); ++i) {
+        const Entity e(transforms.EntityAt(i), 0);
+        const uint64_t code = MortonCode(spatial->WorldToCell(transforms.Get(e).position));
+        EXPECT_LE(previous, code) << "dense slot " << i;
+        previous = code;
+    }
+
+    // Components kept their data and change versions.
+    for (uint32_t i = 0; i < 8; ++i) {
+        const Entity e(i + 1, 0);
+        EXPECT_FLOAT_EQ(transforms.Get(e).position.x, xs[i]);
+        EXPECT_EQ(transforms.GetVersion(e), versions[i]);
+    }
+}
+
 // ── Interest management tests (SRS-GML-003.4) ───────────────────────────
 
 TEST_F(WorldSystemTest, GetVisibleEntitiesDefaultRange) {
@@ -526,6 +1056,484 @@ TEST_F(WorldSystemTest, GetVisibleEntitiesCustomRange) {
     EXPECT_EQ(hasOutside, visible.end());
 }
 
+TEST_F(WorldSystemTest, VisitorAndBufferQueriesMatchAllocatingQueries) {
+    Entity viewer = createEntityOnMap(1, Vector3(0.0f, 0.0f, 0.0f));
+    createEntityOnMap(2, Vector3(10.0f, 0.0f, 10.0f));
+    createEntityOnMap(3, Vector3(60.0f, 0.0f, 0.0f));
+    createEntityOnMap(4, Vector3(500.0f, 0.0f, 500.0f));
+
+    WorldSystem system(transforms, memberships, mapInstances,
+                       visibilityRanges, zones);
+    system.Execute(0.016f);
+
+    const auto expected = system.QueryRadius(mapEntity, Vector3(0.0f, 0.0f, 0.0f), 50.0f);
+    EXPECT_EQ(expected.size(), 2u);
+
+    std::vector<Entity> buffer;
+    buffer.reserve(8);
+    system.QueryRadius(mapEntity, Vector3(0.0f, 0.0f, 0.0f), 50.0f, buffer);
+    EXPECT_EQ(buffer, expected);
+
+    std::vector<Entity> visited;
+    system.ForEachInRadius(mapEntity, Vector3(0.0f, 0.0f, 0.0f), 50.0f,
+                           [&](Entity e) { visited.push_back(e); });
+    EXPECT_EQ(visited, expected);
+
+    std::size_t visible = 0;
+    system.ForEachVisible(viewer, [&](Entity) { ++visible; });
+    EXPECT_EQ(visible, system.GetVisibleEntities(viewer).size());
+    EXPECT_EQ(visible, 3u);
+}
+
+TEST_F(WorldSystemTest, QueryConeSelectsFrontalEntities) {
+    createEntityOnMap(1, Vector3(0.0f, 0.0f, 0.0f));
+    Entity front = createEntityOnMap(2, Vector3(15.0f, 0.0f, 1.0f));
+    createEntityOnMap(3, Vector3(-15.0f, 0.0f, 0.0f));
+    createEntityOnMap(4, Vector3(0.0f, 0.0f, 15.0f));
+
+    WorldSystem system(transforms, memberships, mapInstances,
+                       visibilityRanges, zones);
+    system.Execute(0.016f);
+
+    const auto hit = system.QueryCone(mapEntity, Vector3(1.0f, 0.0f, 0.0f),
+                                      Vector3(1.0f, 0.0f, 0.0f), 20.0f, 0.5f);
+    EXPECT_EQ(hit, std::vector<Entity>{front});
+
+    transforms.Remove(front);
+    EXPECT_TRUE(system.QueryCone(mapEntity, Vector3(1.0f, 0.0f, 0.0f),
+                                 Vector3(1.0f, 0.0f, 0.0f), 20.0f, 0.5f)
+                    .empty());
+}
+
+TEST_F(WorldSystemTest, NearestAndLineOfSightQueries) {
+    Entity shooter = createEntityOnMap(1, Vector3(0.0f, 0.0f, 0.0f));
+    Entity blocker = createEntityOnMap(2, Vector3(20.0f, 0.0f, 0.5f));
+    Entity target = createEntityOnMap(3, Vector3(40.0f, 0.0f, 0.0f));
+    Entity bystander = createEntityOnMap(4, Vector3(-30.0f, 0.0f, 0.0f));
+
+    WorldSystem system(transforms, memberships, mapInstances,
+                       visibilityRanges, zones);
+    system.Execute(0.016f);
+
+    const auto others = [&](Entity entity) { return entity != shooter; };
+    std::vector<Entity> nearest;
+    system.QueryNearest(mapEntity, Vector3(0.0f, 0.0f, 0.0f), 2, nearest, others);
+    EXPECT_EQ(nearest, (std::vector<Entity>{blocker, bystander}));
+
+    const auto between = [&](Entity entity) { return entity != shooter && entity != target; };
+    const auto hit = system.Raycast(mapEntity, Vector3(0.0f, 0.0f, 0.0f),
+                                    Vector3(40.0f, 0.0f, 0.0f), 1.0f, between);
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_EQ(hit->entity, blocker);
+    EXPECT_FLOAT_EQ(hit->distance, 20.0f);
+
+    // Without a Transform the blocker no longer blocks line of sight.
+    transforms.Remove(blocker);
+    EXPECT_FALSE(system.Raycast(mapEntity, Vector3(0.0f, 0.0f, 0.0f),
+                                Vector3(40.0f, 0.0f, 0.0f), 1.0f, between)
+                     .has_value());
+    nearest.clear();
+    system.QueryNearest(mapEntity, Vector3(0.0f, 0.0f, 0.0f), 2, nearest, others);
+    EXPECT_EQ(nearest, (std::vector<Entity>{bystander, target}));
+}
+
+TEST_F(WorldSystemTest, MapInstanceSelectsGridSettings) {
+    Entity wideMap(900, 0);
+    MapInstance settings{3, 1, MapType::OpenWorld};
+    settings.cellSize = 32.0f;
+    settings.coarseFactor = 8;
+    mapInstances.Add(wideMap, settings);
+
+    createEntityOnMap(1, Vector3(0.0f, 0.0f, 0.0f));
+    Entity far(2, 0);
+    transforms.Add(far, Transform{Vector3(150.0f, 0.0f, 0.0f), {}, {1.0f, 1.0f, 1.0f}});
+    memberships.Add(far, MapMembership{wideMap, 0});
+
+    WorldSystem system(transforms, memberships, mapInstances,
+                       visibilityRanges, zones);
+    system.Execute(0.016f);
+
+    const auto* defaultIndex = system.GetSpatialIndex(mapEntity);
+    ASSERT_NE(defaultIndex, nullptr);
+    EXPECT_FLOAT_EQ(defaultIndex->CellSize(), kDefaultCellSize);
+    EXPECT_EQ(defaultIndex->CoarseFactor(), 0u);
+
+    const auto* wideIndex = system.GetSpatialIndex(wideMap);
+    ASSERT_NE(wideIndex, nullptr);
+    EXPECT_FLOAT_EQ(wideIndex->CellSize(), 32.0f);
+    EXPECT_EQ(wideIndex->CoarseFactor(), 8u);
+    EXPECT_EQ(system.QueryRadius(wideMap, Vector3(0.0f, 0.0f, 0.0f), 200.0f),
+              std::vector<Entity>{far});
+}
+
+TEST_F(WorldSystemTest, ParallelExecutorRunsOneSyncTaskPerMap) {
+    Entity map2Entity(101, 0);
+    mapInstances.Add(map2Entity, MapInstance{2, 1, MapType::Dungeon});
+    Entity onFirst = createEntityOnMap(1, Vector3(0.0f, 0.0f, 0.0f));
+    Entity onSecond(2, 0);
+    transforms.Add(onSecond, Transform{Vector3(3.0f, 0.0f, 0.0f), {}, {1.0f, 1.0f, 1.0f}});
+    memberships.Add(onSecond, MapMembership{map2Entity, 0});
+
+    std::vector<std::size_t> batchSizes;
+    SystemScheduler scheduler;
+    auto& system = scheduler.Register<WorldSystem>(
+        transforms, memberships, mapInstances, visibilityRanges, zones);
+    system.SetParallelExecutor([&](const std::vector<std::function<void()>>& tasks) {
+        batchSizes.push_back(tasks.size());
+        for (const auto& task : tasks) {
+            task();
+        }
+    });
+    ASSERT_TRUE(scheduler.Build());
+    scheduler.Execute(0.016f);
+
+    EXPECT_EQ(batchSizes, std::vector<std::size_t>{2});
+    EXPECT_EQ(system.QueryRadius(mapEntity, Vector3(0.0f, 0.0f, 0.0f), 5.0f),
+              std::vector<Entity>{onFirst});
+    EXPECT_EQ(system.QueryRadius(map2Entity, Vector3(0.0f, 0.0f, 0.0f), 5.0f),
+              std::vector<Entity>{onSecond});
+
+    // A tick that moves entities on one map only runs inline.
+    transforms.Get(onFirst).position = Vector3(40.0f, 0.0f, 0.0f);
+    transforms.MarkChanged(onFirst);
+    scheduler.Execute(0.016f);
+    EXPECT_EQ(batchSizes.size(), 1u);
+    EXPECT_EQ(system.QueryRadius(mapEntity, Vector3(40.0f, 0.0f, 0.0f), 5.0f),
+              std::vector<Entity>{onFirst});
+}
+
+/// Interest management runs through a scheduler so that only entities
+/// marked changed are re-synced.
+class WorldInterestTest : public WorldSystemTest {
+protected:
+    void SetUp() override {
+        WorldSystemTest::SetUp();
+        system = &scheduler.Register<WorldSystem>(transforms, memberships, mapInstances,
+                                                  visibilityRanges, zones);
+        system->SetInterestManagement(true);
+        ASSERT_TRUE(scheduler.Build());
+    }
+
+    void moveTo(Entity e, float x, float z) {
+        transforms.Get(e).position = Vector3(x, 0.0f, z);
+        transforms.MarkChanged(e);
+    }
+
+    std::vector<InterestEvent> tick() {
+        scheduler.Execute(0.016f);
+        return {system->InterestEvents().begin(), system->InterestEvents().end()};
+    }
+
+    SystemScheduler scheduler;
+    WorldSystem* system = nullptr;
+};
+
+TEST_F(WorldInterestTest, TransferEntitiesMovesAGroupInOneBatch) {
+    Entity dungeon(100, 0);
+    mapInstances.Add(dungeon, MapInstance{2, 1, MapType::Dungeon});
+    Entity guard(200, 0);
+    transforms.Add(guard, Transform{{0.0f, 0.0f, 0.0f}, {}, {1.0f, 1.0f, 1.0f}});
+    memberships.Add(guard, MapMembership{dungeon, 0});
+    visibilityRanges.Add(guard, VisibilityRange{100.0f});
+
+    std::vector<Entity> raid;
+    std::vector<TransferRequest> requests;
+    for (uint32_t i = 1; i <= 40; ++i) {
+        raid.push_back(createEntityOnMap(i, Vector3(300.0f, 0.0f, 300.0f)));
+        const float offset = static_cast<float>(i % 8) * 5.0f;
+        requests.push_back(TransferRequest{raid.back(), dungeon, Vector3(offset, 0.0f, -offset)});
+    }
+    EXPECT_TRUE(tick().empty());
+
+    requests.push_back(TransferRequest{raid[1], Entity(999, 0), Vector3()});
+    requests.push_back(TransferRequest{Entity(998, 0), dungeon, Vector3()});
+    // The last request for raid[0] wins: it stays on the world map.
+    requests.push_back(TransferRequest{raid[0], mapEntity, Vector3(5.0f, 0.0f, 5.0f)});
+
+    std::vector<TransitionResult> results(requests.size());
+    EXPECT_EQ(system->TransferEntities(requests, results), 41u);
+    EXPECT_EQ(results[40], TransitionResult::InvalidMap);
+    EXPECT_EQ(results[41], TransitionResult::EntityNotFound);
+    EXPECT_EQ(results[42], TransitionResult::Success);
+
+    const SpatialIndex* world = system->GetSpatialIndex(mapEntity);
+    const SpatialIndex* instance = system->GetSpatialIndex(dungeon);
+    ASSERT_NE(world, nullptr);
+    ASSERT_NE(instance, nullptr);
+    EXPECT_EQ(world->Size(), 1u);
+    EXPECT_TRUE(world->Contains(raid[0]));
+    EXPECT_EQ(instance->Size(), 40u);  // the guard and 39 raid members
+    EXPECT_FALSE(instance->Contains(raid[0]));
+    EXPECT_EQ(memberships.Get(raid[0]).mapEntity, mapEntity);
+    EXPECT_FLOAT_EQ(transforms.Get(raid[0]).position.x, 5.0f);
+
+    // The guard sees the whole group arrive in one tick.
+    const auto events = tick();
+    std::vector<InterestEvent> expected;
+    for (std::size_t i = 1; i < raid.size(); ++i) {
+        expected.push_back(InterestEvent{guard, raid[i], InterestChange::Enter});
+    }
+    EXPECT_EQ(events, expected);
+    EXPECT_TRUE(tick().empty());
+}
+
+TEST_F(WorldInterestTest, HysteresisDelaysLeaveByOneCell) {
+    // 32-unit cells, range 64: enter within 2 cells, leave beyond 3.
+    Entity viewer = createEntityOnMap(1, Vector3(16.0f, 0.0f, 16.0f));
+    visibilityRanges.Add(viewer, VisibilityRange{64.0f});
+    Entity subject = createEntityOnMap(2, Vector3(48.0f, 0.0f, 16.0f));
+
+    EXPECT_EQ(tick(), (std::vector<InterestEvent>{{viewer, subject, InterestChange::Enter}}));
+    EXPECT_EQ(system->InterestSet(viewer).size(), 1u);
+    EXPECT_TRUE(tick().empty());
+
+    moveTo(subject, 112.0f, 16.0f);  // cell 3: inside the hysteresis band
+    EXPECT_EQ(tick(), (std::vector<InterestEvent>{{viewer, subject, InterestChange::Update}}));
+
+    moveTo(subject, 144.0f, 16.0f);  // cell 4
+    EXPECT_EQ(tick(), (std::vector<InterestEvent>{{viewer, subject, InterestChange::Leave}}));
+    EXPECT_TRUE(system->InterestSet(viewer).empty());
+
+    moveTo(subject, 112.0f, 16.0f);  // back to cell 3: not close enough to enter
+    EXPECT_TRUE(tick().empty());
+
+    moveTo(subject, 80.0f, 16.0f);  // cell 2
+    EXPECT_EQ(tick(), (std::vector<InterestEvent>{{viewer, subject, InterestChange::Enter}}));
+}
+
+TEST_F(WorldInterestTest, ViewerMovesAndLeavesInterest) {
+    Entity viewer = createEntityOnMap(1, Vector3(0.0f, 0.0f, 0.0f));
+    visibilityRanges.Add(viewer, VisibilityRange{32.0f});
+    Entity near = createEntityOnMap(2, Vector3(10.0f, 0.0f, 10.0f));
+    Entity far = createEntityOnMap(3, Vector3(500.0f, 0.0f, 500.0f));
+    tick();
+    ASSERT_EQ(system->InterestSet(viewer).size(), 1u);
+
+    moveTo(viewer, 490.0f, 490.0f);
+    EXPECT_EQ(tick(), (std::vector<InterestEvent>{{viewer, near, InterestChange::Leave},
+                                                  {viewer, far, InterestChange::Enter}}));
+
+    // A subject losing its Transform leaves every set that holds it.
+    transforms.Remove(far);
+    EXPECT_EQ(tick(), (std::vector<InterestEvent>{{viewer, far, InterestChange::Leave}}));
+
+    // A viewer losing its VisibilityRange drops its set.
+    moveTo(viewer, 0.0f, 0.0f);
+    tick();
+    ASSERT_EQ(system->InterestSet(viewer).size(), 1u);
+    visibilityRanges.Remove(viewer);
+    EXPECT_EQ(tick(), (std::vector<InterestEvent>{{viewer, near, InterestChange::Leave}}));
+    EXPECT_TRUE(system->InterestSet(viewer).empty());
+}
+
+TEST_F(WorldInterestTest, SetsStayWithinRingsUnderRandomMovement) {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> coord(-256.0f, 256.0f);
+    std::uniform_real_distribution<float> step(-40.0f, 40.0f);
+
+    std::vector<Entity> entities;
+    for (uint32_t i = 1; i <= 120; ++i) {
+        entities.push_back(createEntityOnMap(i, Vector3(coord(rng), 0.0f, coord(rng))));
+        if (i % 10 == 0) {
+            visibilityRanges.Add(entities.back(), VisibilityRange{80.0f});  // 3 cells
+        }
+    }
+
+    // Replay the event stream into per-viewer sets and compare each tick.
+    std::map<Entity, std::set<Entity>> replayed;
+    for (int t = 0; t < 30; ++t) {
+        for (Entity e : entities) {
+            if (rng() % 3 == 0) {
+                const Vector3 p = transforms.Get(e).position;
+                moveTo(e, p.x + step(rng), p.z + step(rng));
+            }
+        }
+        for (const InterestEvent& event : tick()) {
+            auto& set = replayed[event.viewer];
+            if (event.change == InterestChange::Enter) {
+                EXPECT_TRUE(set.insert(event.subject).second);
+            } else if (event.change == InterestChange::Leave) {
+                EXPECT_EQ(set.erase(event.subject), 1u);
+            } else {
+                EXPECT_TRUE(set.contains(event.subject));
+            }
+        }
+
+        const SpatialIndex* index = system->GetSpatialIndex(mapEntity);
+        for (std::size_t i = 9; i < entities.size(); i += 10) {
+            const Entity viewer = entities[i];
+            const auto current = system->InterestSet(viewer);
+            EXPECT_EQ(std::set<Entity>(current.begin(), current.end()), replayed[viewer]);
+
+            const CellCoord home = index->WorldToCell(transforms.Get(viewer).position);
+            for (Entity subject : entities) {
+                if (subject == viewer) {
+                    continue;
+                }
+                const CellCoord cell = index->WorldToCell(transforms.Get(subject).position);
+                const int32_t d = std::max(std::abs(cell.x - home.x), std::abs(cell.y - home.y));
+                const bool seen = replayed[viewer].contains(subject);
+                if (d <= 3) {
+                    EXPECT_TRUE(seen) << "tick " << t;
+                } else if (d > 4) {
+                    EXPECT_FALSE(seen) << "tick " << t;
+                }
+            }
+        }
+    }
+}
+
+// ── Area effect tests ───────────────────────────────────────────────────
+
+/// Area effects run through a scheduler so that only entities marked
+/// changed are re-checked.
+class WorldAreaEffectTest : public WorldSystemTest {
+protected:
+    void SetUp() override {
+        WorldSystemTest::SetUp();
+        system = &scheduler.Register<WorldSystem>(transforms, memberships, mapInstances,
+                                                  visibilityRanges, zones);
+        ASSERT_TRUE(scheduler.Build());
+    }
+
+    void moveTo(Entity e, float x, float z) {
+        transforms.Get(e).position = Vector3(x, 0.0f, z);
+        transforms.MarkChanged(e);
+    }
+
+    std::vector<AreaEffectEvent> tick(float dt = 1.0f) {
+        scheduler.Execute(dt);
+        return {system->AreaEffectEvents().begin(), system->AreaEffectEvents().end()};
+    }
+
+    std::vector<AreaEffectPulse> pulses() const {
+        return {system->AreaEffectPulses().begin(), system->AreaEffectPulses().end()};
+    }
+
+    std::vector<Entity> occupants(AreaEffectId area) const {
+        const auto span = system->AreaEffectOccupants(area);
+        return {span.begin(), span.end()};
+    }
+
+    SystemScheduler scheduler;
+    WorldSystem* system = nullptr;
+};
+
+TEST_F(WorldAreaEffectTest, MovementEntersAndLeavesAndPulsesReachOccupants) {
+    Entity inside = createEntityOnMap(1, Vector3(3.0f, 0.0f, 0.0f));
+    Entity outside = createEntityOnMap(2, Vector3(50.0f, 0.0f, 0.0f));
+    EXPECT_TRUE(tick().empty());
+
+    EXPECT_EQ(system->CreateAreaEffect({mapEntity, Vector3(), 0.0f, 1.0f, 0.0f}),
+              kInvalidAreaEffect);
+    const AreaEffectId fire = system->CreateAreaEffect({mapEntity, Vector3(), 10.0f, 1.0f, 0.0f});
+    ASSERT_NE(fire, kInvalidAreaEffect);
+    EXPECT_TRUE(system->HasAreaEffect(fire));
+    EXPECT_TRUE(occupants(fire).empty());  // seeded by the next Execute()
+
+    EXPECT_EQ(tick(), (std::vector<AreaEffectEvent>{{fire, inside, AreaEffectChange::Enter}}));
+    EXPECT_TRUE(pulses().empty());
+    EXPECT_EQ(occupants(fire), std::vector<Entity>{inside});
+
+    EXPECT_TRUE(tick().empty());
+    EXPECT_EQ(pulses(), (std::vector<AreaEffectPulse>{{fire, 1}}));
+    tick(2.5f);
+    EXPECT_EQ(pulses(), (std::vector<AreaEffectPulse>{{fire, 2}}));
+
+    moveTo(outside, 0.0f, 6.0f);
+    moveTo(inside, 40.0f, 0.0f);
+    EXPECT_EQ(tick(), (std::vector<AreaEffectEvent>{{fire, inside, AreaEffectChange::Exit},
+                                                    {fire, outside, AreaEffectChange::Enter}}));
+    EXPECT_EQ(occupants(fire), std::vector<Entity>{outside});
+
+    // Moving within the area is not an event.
+    moveTo(outside, 1.0f, 1.0f);
+    EXPECT_TRUE(tick().empty());
+
+    EXPECT_TRUE(system->RemoveAreaEffect(fire));
+    EXPECT_FALSE(system->RemoveAreaEffect(fire));
+    EXPECT_FALSE(system->HasAreaEffect(fire));
+    EXPECT_EQ(tick(), (std::vector<AreaEffectEvent>{{fire, outside, AreaEffectChange::Exit}}));
+    EXPECT_EQ(system->AreaEffectCount(), 0u);
+    EXPECT_EQ(system->GetSpatialIndex(mapEntity)->AreaCount(), 0u);
+}
+
+TEST_F(WorldAreaEffectTest, DurationDestructionAndTransfersEndMembership) {
+    Entity map2(10, 0);
+    mapInstances.Add(map2, MapInstance{2, 1, MapType::Dungeon});
+    Entity doomed = createEntityOnMap(1, Vector3(1.0f, 0.0f, 1.0f));
+    Entity traveller = createEntityOnMap(2, Vector3(2.0f, 0.0f, 2.0f));
+    Entity stayer = createEntityOnMap(3, Vector3(-2.0f, 0.0f, 2.0f));
+
+    const AreaEffectId patch = system->CreateAreaEffect({mapEntity, Vector3(), 8.0f, 1.0f, 2.0f});
+    const AreaEffectId trap = system->CreateAreaEffect({map2, Vector3(50.0f, 0.0f, 50.0f), 3.0f});
+    EXPECT_EQ(tick().size(), 3u);
+
+    transforms.Remove(doomed);
+    EXPECT_EQ(system->TransferEntity(traveller, map2, Vector3(51.0f, 0.0f, 50.0f)),
+              TransitionResult::Success);
+    EXPECT_EQ(tick(), (std::vector<AreaEffectEvent>{{patch, doomed, AreaEffectChange::Exit},
+                                                    {patch, traveller, AreaEffectChange::Exit},
+                                                    {trap, traveller, AreaEffectChange::Enter}}));
+    EXPECT_EQ(pulses(), (std::vector<AreaEffectPulse>{{patch, 1}}));
+
+    // The patch pulses once more, then ends.
+    EXPECT_TRUE(tick().empty());
+    EXPECT_EQ(pulses(), (std::vector<AreaEffectPulse>{{patch, 1}}));
+    EXPECT_TRUE(system->HasAreaEffect(patch));
+    EXPECT_EQ(tick(), (std::vector<AreaEffectEvent>{{patch, stayer, AreaEffectChange::Exit}}));
+    EXPECT_FALSE(system->HasAreaEffect(patch));
+    EXPECT_EQ(occupants(trap), std::vector<Entity>{traveller});
+}
+
+TEST_F(WorldAreaEffectTest, OccupantsMatchRadiusQueriesUnderRandomMovement) {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> coord(-128.0f, 128.0f);
+    std::uniform_real_distribution<float> step(-12.0f, 12.0f);
+    std::uniform_real_distribution<float> radius(2.0f, 40.0f);
+
+    std::vector<Entity> entities;
+    for (uint32_t i = 1; i <= 200; ++i) {
+        entities.push_back(createEntityOnMap(i, Vector3(coord(rng), 0.0f, coord(rng))));
+    }
+    struct Area {
+        AreaEffectId id;
+        Vector3 center;
+        float radius;
+    };
+    std::vector<Area> areas;
+    for (int i = 0; i < 40; ++i) {
+        const Area area{0, Vector3(coord(rng), 0.0f, coord(rng)), radius(rng)};
+        areas.push_back(area);
+        areas.back().id = system->CreateAreaEffect({mapEntity, area.center, area.radius, 0.5f});
+    }
+
+    // Replay the events per area and compare with a radius query.
+    std::map<AreaEffectId, std::set<Entity>> replayed;
+    for (int t = 0; t < 25; ++t) {
+        for (Entity e : entities) {
+            if (rng() % 2 == 0) {
+                const Vector3 p = transforms.Get(e).position;
+                moveTo(e, p.x + step(rng), p.z + step(rng));
+            }
+        }
+        for (const AreaEffectEvent& event : tick()) {
+            auto& set = replayed[event.area];
+            if (event.change == AreaEffectChange::Enter) {
+                EXPECT_TRUE(set.insert(event.entity).second);
+            } else {
+                EXPECT_EQ(set.erase(event.entity), 1u);
+            }
+        }
+        for (const Area& area : areas) {
+            auto expected = system->QueryRadius(mapEntity, area.center, area.radius);
+            std::sort(expected.begin(), expected.end());
+            EXPECT_EQ(occupants(area.id), expected) << "tick " << t;
+            EXPECT_EQ(replayed[area.id], std::set<Entity>(expected.begin(), expected.end()));
+        }
+    }
+}
+
 TEST_F(WorldSystemTest, GetVisibleEntitiesNoMembership) {
     Entity orphan(99, 0);
     transforms.Add(orphan, Transform{{0.0f, 0.0f, 0.0f}, {}, {1.0f, 1.0f, 1.0f}});
@@ -652,6 +1660,40 @@ TEST_F(WorldSystemTest, TransferPreservesStateExceptPosition) {
 
 // ── System metadata tests ───────────────────────────────────────────────
 
+TEST_F(WorldSystemTest, ZoneFlagsIndexFollowsZoneChanges) {
+    Entity player = createEntityOnMap(1, Vector3(0.0f, 0.0f, 0.0f));
+    memberships.Get(player).zoneId = 7;
+
+    Entity otherMap(50, 0);
+    mapInstances.Add(otherMap, MapInstance{2, 1, MapType::Dungeon});
+    zones.Add(Entity(60, 0), Zone{7, ZoneType::PvP, ZoneFlags::FreeForAll, otherMap});
+    Entity sanctuary(61, 0);
+    zones.Add(sanctuary, Zone{7, ZoneType::Safe, ZoneFlags::Sanctuary, mapEntity});
+
+    WorldSystem system(transforms, memberships, mapInstances,
+                       visibilityRanges, zones);
+    // Before the first run the Zone storage is scanned.
+    EXPECT_EQ(system.GetEntityZoneFlags(player), ZoneFlags::Sanctuary);
+
+    system.Execute(0.016f);
+    EXPECT_EQ(system.GetEntityZoneFlags(player), ZoneFlags::Sanctuary);
+
+    // Changed zones are seen at once, then re-indexed by the next run.
+    zones.Replace(sanctuary, Zone{7, ZoneType::Safe, ZoneFlags::NoCombat, mapEntity});
+    EXPECT_EQ(system.GetEntityZoneFlags(player), ZoneFlags::NoCombat);
+    system.Execute(0.016f);
+    EXPECT_EQ(system.GetEntityZoneFlags(player), ZoneFlags::NoCombat);
+
+    zones.Remove(sanctuary);
+    EXPECT_EQ(system.GetEntityZoneFlags(player), ZoneFlags::None);
+    system.Execute(0.016f);
+    EXPECT_EQ(system.GetEntityZoneFlags(player), ZoneFlags::None);
+
+    memberships.Get(player).mapEntity = otherMap;
+    EXPECT_EQ(system.GetEntityZoneFlags(player), ZoneFlags::FreeForAll);
+    EXPECT_EQ(system.GetEntityZoneFlags(Entity(99, 0)), ZoneFlags::None);
+}
+
 TEST_F(WorldSystemTest, SystemMetadata) {
     WorldSystem system(transforms, memberships, mapInstances,
                        visibilityRanges, zones);
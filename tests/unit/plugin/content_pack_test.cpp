@@ -0,0 +1,215 @@
+/// @file content_pack_test.cpp
+/// @brief Unit tests for the content pack compiler and mapped loader.
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "cgs/plugin/content_pack.hpp"
+
+using namespace cgs::plugin;
+using cgs::foundation::ErrorCode;
+using cgs::game::EquipSlot;
+using cgs::game::ItemTemplate;
+using cgs::game::ObjectiveType;
+using cgs::game::QuestFlags;
+using cgs::game::QuestObjective;
+using cgs::game::QuestTemplate;
+namespace fs = std::filesystem;
+
+namespace {
+
+ItemTemplate makeItem(uint32_t id) {
+    ItemTemplate item;
+    item.id = id;
+    item.name = "item" + std::to_string(id);
+    item.maxStackSize = id % 3 + 1;
+    item.equipSlot = EquipSlot::Chest;
+    item.statBonuses.attributes[2] = static_cast<int32_t>(id);
+    item.statBonuses.attackSpeed = 1.5f;
+    item.vendorPrice = id * 10;
+    return item;
+}
+
+QuestTemplate makeQuest(uint32_t id) {
+    QuestTemplate quest;
+    quest.id = id;
+    quest.name = "quest" + std::to_string(id);
+    quest.description = "Slay the beast.";
+    quest.level = 12;
+    QuestObjective kill;
+    kill.type = ObjectiveType::Kill;
+    kill.targetId = 500;
+    kill.required = 8;
+    kill.current = 3;  // Progress is not content: the pack drops it.
+    quest.objectives.push_back(kill);
+    quest.rewards.experience = 1200;
+    quest.rewards.items.emplace_back(1, 2);
+    quest.flags = QuestFlags::Repeatable | QuestFlags::Shareable;
+    return quest;
+}
+
+ContentPackSource makeSource() {
+    ContentPackSource source;
+    for (uint32_t id = 1; id <= 100; ++id) {
+        source.items.push_back(makeItem(id));
+    }
+    source.quests.push_back(makeQuest(10));
+    auto second = makeQuest(11);
+    second.prerequisites.push_back(10);
+    source.quests.push_back(second);
+    source.quests[0].chainNext = 11;
+    source.classes.push_back({CharacterClass::Mage, 80, 200, 5.0f});
+    source.classes.push_back({CharacterClass::Warrior, 150, 0, 5.5f});
+    return source;
+}
+
+/// A pack file removed when the test ends.
+class PackFile {
+public:
+    explicit PackFile(const std::string& name)
+        : path_(fs::temp_directory_path() / ("cgs_pack_" + name)) {}
+
+    ~PackFile() {
+        std::error_code ec;
+        fs::remove(path_, ec);
+    }
+
+    PackFile(const PackFile&) = delete;
+    PackFile& operator=(const PackFile&) = delete;
+
+    [[nodiscard]] const fs::path& Path() const { return path_; }
+
+private:
+    fs::path path_;
+};
+
+}  // anonymous namespace
+
+TEST(ContentPackTest, RecordsRoundTripThroughImage) {
+    auto image = CompileContentPack(makeSource());
+    ASSERT_TRUE(image.hasValue());
+    auto opened = ContentPack::FromBytes(image.value());
+    ASSERT_TRUE(opened.hasValue());
+    const auto& pack = opened.value();
+
+    EXPECT_FALSE(pack->IsMapped());
+    EXPECT_EQ(pack->ItemCount(), 100u);
+    EXPECT_EQ(pack->QuestCount(), 2u);
+
+    auto item = pack->FindItem(42);
+    ASSERT_TRUE(item.has_value());
+    EXPECT_EQ(item->Name(), "item42");
+    EXPECT_EQ(item->Record().vendorPrice, 420u);
+    auto tmpl = item->ToTemplate();
+    EXPECT_EQ(tmpl.name, "item42");
+    EXPECT_EQ(tmpl.equipSlot, EquipSlot::Chest);
+    EXPECT_EQ(tmpl.statBonuses.attributes[2], 42);
+    EXPECT_FLOAT_EQ(tmpl.statBonuses.attackSpeed, 1.5f);
+    EXPECT_FALSE(pack->FindItem(0).has_value());
+    EXPECT_FALSE(pack->FindItem(101).has_value());
+
+    auto quest = pack->FindQuest(11);
+    ASSERT_TRUE(quest.has_value());
+    EXPECT_EQ(quest->Description(), "Slay the beast.");
+    ASSERT_EQ(quest->Prerequisites().size(), 1u);
+    EXPECT_EQ(quest->Prerequisites()[0], 10u);
+    auto questTmpl = pack->FindQuest(10)->ToTemplate();
+    EXPECT_EQ(questTmpl.chainNext, 11u);
+    EXPECT_EQ(questTmpl.flags, QuestFlags::Repeatable | QuestFlags::Shareable);
+    ASSERT_EQ(questTmpl.objectives.size(), 1u);
+    EXPECT_EQ(questTmpl.objectives[0].required, 8);
+    EXPECT_EQ(questTmpl.objectives[0].current, 0);
+    EXPECT_EQ(questTmpl.rewards.experience, 1200);
+    ASSERT_EQ(questTmpl.rewards.items.size(), 1u);
+    EXPECT_EQ(questTmpl.rewards.items[0], std::make_pair(1u, 2u));
+    EXPECT_FALSE(pack->FindQuest(11)->ToTemplate().chainNext.has_value());
+
+    auto mage = pack->FindClass(CharacterClass::Mage);
+    ASSERT_TRUE(mage.has_value());
+    EXPECT_EQ(mage->baseMana, 200);
+    EXPECT_FALSE(pack->FindClass(CharacterClass::Rogue).has_value());
+    ASSERT_EQ(pack->Classes().size(), 2u);
+    EXPECT_EQ(pack->Classes()[0].characterClass, CharacterClass::Warrior);
+}
+
+TEST(ContentPackTest, CompileRejectsInvalidContent) {
+    auto source = makeSource();
+    source.quests[1].prerequisites.push_back(99);
+    auto dangling = CompileContentPack(std::move(source));
+    ASSERT_TRUE(dangling.hasError());
+    EXPECT_EQ(dangling.error().code(), ErrorCode::InvalidArgument);
+
+    ContentPackSource badClass;
+    badClass.classes.push_back({CharacterClass::COUNT, 1, 1, 1.0f});
+    EXPECT_TRUE(CompileContentPack(std::move(badClass)).hasError());
+}
+
+TEST(ContentPackTest, OpenMapsWrittenPack) {
+    PackFile file("mapped");
+    ASSERT_TRUE(WriteContentPack(makeSource(), file.Path()).hasValue());
+    EXPECT_FALSE(fs::exists(fs::path(file.Path()) += ".tmp"));
+
+    auto opened = ContentPack::Open(file.Path());
+    ASSERT_TRUE(opened.hasValue());
+    const auto& pack = opened.value();
+#if defined(__unix__) || defined(__APPLE__)
+    EXPECT_TRUE(pack->IsMapped());
+#endif
+    EXPECT_EQ(pack->SizeBytes(), fs::file_size(file.Path()));
+
+    auto fragment = pack->ToFragment();
+    ASSERT_EQ(fragment.items.size(), 100u);
+    EXPECT_EQ(fragment.items.front().id, 1u);
+    EXPECT_EQ(fragment.items.back().name, "item100");
+    EXPECT_TRUE(cgs::game::ContentDatabase::Build(1, std::move(fragment.items),
+                                                  std::move(fragment.quests))
+                    .hasValue());
+}
+
+TEST(ContentPackTest, OpenRejectsDamagedPacks) {
+    auto image = CompileContentPack(makeSource()).value();
+
+    auto truncated = image;
+    truncated.resize(truncated.size() - 8);
+    auto result = ContentPack::FromBytes(truncated);
+    ASSERT_TRUE(result.hasError());
+    EXPECT_EQ(result.error().code(), ErrorCode::ConfigLoadFailed);
+
+    auto badMagic = image;
+    badMagic[0] = 'X';
+    EXPECT_TRUE(ContentPack::FromBytes(badMagic).hasError());
+
+    auto newer = image;
+    uint32_t version = pack::kFormatVersion + 1;
+    std::memcpy(newer.data() + offsetof(pack::Header, formatVersion), &version, sizeof(version));
+    EXPECT_TRUE(ContentPack::FromBytes(newer).hasError());
+
+    // A string reference pointing past the string section.
+    pack::Header header;
+    std::memcpy(&header, image.data(), sizeof(header));
+    auto badString = image;
+    pack::StringRef ref{0, static_cast<uint32_t>(header.strings.count + 1)};
+    std::memcpy(badString.data() + header.items.offset + offsetof(pack::ItemRecord, name), &ref,
+                sizeof(ref));
+    EXPECT_TRUE(ContentPack::FromBytes(badString).hasError());
+
+    EXPECT_TRUE(ContentPack::Open(fs::temp_directory_path() / "cgs_pack_missing").hasError());
+}
+
+TEST(ContentPackTest, ReloaderLoadsPackWithoutTextParsing) {
+    PackFile file("reloader");
+    ASSERT_TRUE(WriteContentPack(makeSource(), file.Path()).hasValue());
+
+    ContentReloader reloader;
+    ASSERT_TRUE(reloader.Watch(file.Path(), ContentPackParser()).hasValue());
+    ASSERT_TRUE(reloader.Reload().hasValue());
+    ASSERT_NE(reloader.Current(), nullptr);
+    EXPECT_EQ(reloader.Current()->Items()->Size(), 100u);
+    EXPECT_TRUE(reloader.Current()->Quests()->Contains(11));
+}
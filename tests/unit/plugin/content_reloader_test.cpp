@@ -0,0 +1,298 @@
+/// @file content_reloader_test.cpp
+/// @brief Unit tests for ContentDatabase and ContentReloader.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "cgs/game/content_database.hpp"
+#include "cgs/plugin/content_reloader.hpp"
+
+using namespace cgs::plugin;
+using cgs::foundation::ErrorCode;
+using cgs::foundation::GameError;
+using cgs::foundation::GameResult;
+using cgs::game::ContentDatabase;
+using cgs::game::ItemTemplate;
+using cgs::game::QuestTemplate;
+namespace fs = std::filesystem;
+
+namespace {
+
+ItemTemplate makeItem(uint32_t id, uint32_t stack = 1) {
+    ItemTemplate item;
+    item.id = id;
+    item.name = "item" + std::to_string(id);
+    item.maxStackSize = stack;
+    return item;
+}
+
+QuestTemplate makeQuest(uint32_t id, uint32_t rewardItem = 0) {
+    QuestTemplate quest;
+    quest.id = id;
+    quest.name = "quest" + std::to_string(id);
+    if (rewardItem != 0) {
+        quest.rewards.items.emplace_back(rewardItem, 1);
+    }
+    return quest;
+}
+
+/// Content file of lines "item <id> <stack>" and "quest <id> <reward>".
+class ContentFile {
+public:
+    ContentFile(const std::string& name, const std::string& text)
+        : path_(fs::temp_directory_path() / ("cgs_content_" + name)) {
+        Write(text);
+    }
+
+    ~ContentFile() {
+        std::error_code ec;
+        fs::remove(path_, ec);
+    }
+
+    ContentFile(const ContentFile&) = delete;
+    ContentFile& operator=(const ContentFile&) = delete;
+
+    void Write(const std::string& text) {
+        std::ofstream ofs(path_, std::ios::trunc);
+        ofs << text;
+    }
+
+    [[nodiscard]] const fs::path& Path() const { return path_; }
+
+private:
+    fs::path path_;
+};
+
+/// Parser for ContentFile's format; counts calls per file.
+class CountingParser {
+public:
+    ContentParser Parser() {
+        return [this](const fs::path& path) { return parse(path); };
+    }
+
+    int Calls(const fs::path& path) {
+        std::lock_guard lock(mutex_);
+        return calls_[path.string()];
+    }
+
+private:
+    GameResult<ContentFragment> parse(const fs::path& path) {
+        {
+            std::lock_guard lock(mutex_);
+            ++calls_[path.string()];
+        }
+        std::ifstream in(path);
+        ContentFragment fragment;
+        std::string kind;
+        uint32_t id = 0;
+        uint32_t value = 0;
+        while (in >> kind >> id >> value) {
+            if (kind == "item") {
+                fragment.items.push_back(makeItem(id, value));
+            } else if (kind == "quest") {
+                fragment.quests.push_back(makeQuest(id, value));
+            } else {
+                return GameResult<ContentFragment>::err(
+                    GameError(ErrorCode::InvalidJsonData, "unknown kind " + kind));
+            }
+        }
+        return GameResult<ContentFragment>::ok(std::move(fragment));
+    }
+
+    std::mutex mutex_;
+    std::map<std::string, int> calls_;
+};
+
+/// Poll @p reloader until @p done or a timeout.
+template <typename Pred>
+bool pollUntil(ContentReloader& reloader, Pred done) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (std::chrono::steady_clock::now() < deadline) {
+        reloader.Poll();
+        if (done()) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return false;
+}
+
+}  // anonymous namespace
+
+// ============================================================================
+// ContentDatabase
+// ============================================================================
+
+TEST(ContentDatabaseTest, BuildsValidContent) {
+    auto built = ContentDatabase::Build(3, {makeItem(1, 20), makeItem(2)}, {makeQuest(10, 1)});
+    ASSERT_TRUE(built.hasValue());
+    const auto& db = built.value();
+    EXPECT_EQ(db->Version(), 3u);
+    EXPECT_EQ(db->Items()->Size(), 2u);
+    EXPECT_TRUE(db->Quests()->Contains(10));
+}
+
+TEST(ContentDatabaseTest, RejectsDanglingReferences) {
+    auto reward = ContentDatabase::Build(1, {makeItem(1)}, {makeQuest(10, 99)});
+    ASSERT_TRUE(reward.hasError());
+    EXPECT_EQ(reward.error().code(), ErrorCode::InvalidArgument);
+
+    auto prerequisite = makeQuest(11);
+    prerequisite.prerequisites.push_back(42);
+    EXPECT_TRUE(ContentDatabase::Build(1, {}, {prerequisite}).hasError());
+
+    auto chained = makeQuest(12);
+    chained.chainNext = 43;
+    EXPECT_TRUE(ContentDatabase::Build(1, {}, {chained}).hasError());
+
+    EXPECT_TRUE(ContentDatabase::Build(1, {makeItem(5, 0)}, {}).hasError());
+}
+
+TEST(ContentDatabaseTest, TemplatePointersKeepVersionAlive) {
+    std::weak_ptr<const ContentDatabase> weak;
+    std::shared_ptr<const cgs::game::ItemTemplateDatabase> items;
+    {
+        auto db = ContentDatabase::Build(1, {makeItem(1)}, {}).value();
+        weak = db;
+        items = db->Items();
+    }
+    EXPECT_FALSE(weak.expired());
+    ASSERT_NE(items->Find(1), nullptr);
+    items.reset();
+    EXPECT_TRUE(weak.expired());
+}
+
+// ============================================================================
+// ContentReloader
+// ============================================================================
+
+class ContentReloaderTest : public ::testing::Test {
+protected:
+    void SetUp() override { reloader_.SetDebounceMs(0); }
+
+    ContentReloader reloader_;
+    CountingParser parser_;
+};
+
+TEST_F(ContentReloaderTest, WatchMissingFileFails) {
+    auto result = reloader_.Watch(fs::temp_directory_path() / "cgs_content_missing", {});
+    ASSERT_TRUE(result.hasError());
+    EXPECT_EQ(result.error().code(), ErrorCode::ConfigLoadFailed);
+    EXPECT_EQ(reloader_.WatchedFileCount(), 0u);
+}
+
+TEST_F(ContentReloaderTest, ReloadPublishesInitialVersion) {
+    ContentFile items("initial_items", "item 1 20\nitem 2 1\n");
+    ContentFile quests("initial_quests", "quest 10 1\n");
+    ASSERT_TRUE(reloader_.Watch(items.Path(), parser_.Parser()).hasValue());
+    ASSERT_TRUE(reloader_.Watch(quests.Path(), parser_.Parser()).hasValue());
+
+    std::shared_ptr<const cgs::game::ItemTemplateDatabase> systemItems;
+    reloader_.OnPublish([&](const auto& db) { systemItems = db->Items(); });
+
+    ASSERT_TRUE(reloader_.Reload().hasValue());
+    EXPECT_EQ(reloader_.CurrentVersion(), 1u);
+    EXPECT_EQ(reloader_.PublishCount(), 1u);
+    ASSERT_NE(systemItems, nullptr);
+    EXPECT_EQ(systemItems->Find(1)->maxStackSize, 20u);
+    EXPECT_TRUE(reloader_.Current()->Quests()->Contains(10));
+
+    // Nothing changed: no new version.
+    ASSERT_TRUE(reloader_.Reload().hasValue());
+    EXPECT_EQ(reloader_.PublishCount(), 1u);
+}
+
+TEST_F(ContentReloaderTest, ChangedFileRebuiltInBackgroundAndOldVersionRetired) {
+    ContentFile items("swap_items", "item 1 20\n");
+    ContentFile quests("swap_quests", "quest 10 1\n");
+    ASSERT_TRUE(reloader_.Watch(items.Path(), parser_.Parser()).hasValue());
+    ASSERT_TRUE(reloader_.Watch(quests.Path(), parser_.Parser()).hasValue());
+
+    std::shared_ptr<const cgs::game::ItemTemplateDatabase> systemItems;
+    reloader_.OnPublish([&](const auto& db) { systemItems = db->Items(); });
+    ASSERT_TRUE(reloader_.Reload().hasValue());
+
+    // A tick still holds a template of version 1.
+    auto inFlight = systemItems;
+    const ItemTemplate* held = inFlight->Find(1);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    items.Write("item 1 50\n");
+    ASSERT_TRUE(pollUntil(reloader_, [&] { return reloader_.PublishCount() == 2; }));
+
+    EXPECT_EQ(reloader_.CurrentVersion(), 2u);
+    EXPECT_EQ(systemItems->Find(1)->maxStackSize, 50u);
+    EXPECT_EQ(held->maxStackSize, 20u);  // Version 1 is still alive
+    EXPECT_EQ(reloader_.LiveVersionCount(), 2u);
+    EXPECT_EQ(reloader_.RetiredVersionCount(), 0u);
+
+    // Only the changed file was parsed again.
+    EXPECT_EQ(parser_.Calls(items.Path()), 2);
+    EXPECT_EQ(parser_.Calls(quests.Path()), 1);
+
+    inFlight.reset();
+    reloader_.Poll();
+    EXPECT_EQ(reloader_.LiveVersionCount(), 1u);
+    EXPECT_EQ(reloader_.RetiredVersionCount(), 1u);
+}
+
+TEST_F(ContentReloaderTest, InvalidBuildKeepsRunningVersion) {
+    ContentFile items("invalid_items", "item 1 1\n");
+    ContentFile quests("invalid_quests", "quest 10 1\n");
+    ASSERT_TRUE(reloader_.Watch(items.Path(), parser_.Parser()).hasValue());
+    ASSERT_TRUE(reloader_.Watch(quests.Path(), parser_.Parser()).hasValue());
+    ASSERT_TRUE(reloader_.Reload().hasValue());
+
+    // Quest 11 rewards an item that does not exist yet.
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    quests.Write("quest 10 1\nquest 11 2\n");
+    ASSERT_TRUE(pollUntil(reloader_, [&] { return reloader_.LastError().has_value(); }));
+    EXPECT_EQ(reloader_.LastError()->code(), ErrorCode::InvalidArgument);
+    EXPECT_EQ(reloader_.CurrentVersion(), 1u);
+    EXPECT_FALSE(reloader_.Current()->Quests()->Contains(11));
+
+    // Adding the item fixes it; the quest file is parsed again with it.
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    items.Write("item 1 1\nitem 2 1\n");
+    ASSERT_TRUE(pollUntil(reloader_, [&] { return reloader_.PublishCount() == 2; }));
+    EXPECT_FALSE(reloader_.LastError().has_value());
+    EXPECT_TRUE(reloader_.Current()->Quests()->Contains(11));
+    EXPECT_TRUE(reloader_.Current()->Items()->Contains(2));
+}
+
+TEST_F(ContentReloaderTest, ParseErrorIsReportedWithPath) {
+    ContentFile items("parse_items", "item 1 1\n");
+    ASSERT_TRUE(reloader_.Watch(items.Path(), parser_.Parser()).hasValue());
+    ASSERT_TRUE(reloader_.Reload().hasValue());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    items.Write("weapon 1 1\n");
+    ASSERT_TRUE(pollUntil(reloader_, [&] { return reloader_.LastError().has_value(); }));
+    EXPECT_EQ(reloader_.LastError()->code(), ErrorCode::InvalidJsonData);
+    EXPECT_NE(reloader_.LastError()->message().find(items.Path().string()), std::string::npos);
+    EXPECT_EQ(reloader_.CurrentVersion(), 1u);
+}
+
+TEST_F(ContentReloaderTest, UnwatchDropsTemplates) {
+    ContentFile base("unwatch_base", "item 1 1\n");
+    ContentFile extra("unwatch_extra", "item 2 1\n");
+    ASSERT_TRUE(reloader_.Watch(base.Path(), parser_.Parser()).hasValue());
+    ASSERT_TRUE(reloader_.Watch(extra.Path(), parser_.Parser()).hasValue());
+    ASSERT_TRUE(reloader_.Reload().hasValue());
+    EXPECT_TRUE(reloader_.Current()->Items()->Contains(2));
+
+    reloader_.Unwatch(extra.Path());
+    EXPECT_EQ(reloader_.WatchedFileCount(), 1u);
+    ASSERT_TRUE(reloader_.Reload().hasValue());
+    EXPECT_EQ(reloader_.CurrentVersion(), 2u);
+    EXPECT_FALSE(reloader_.Current()->Items()->Contains(2));
+    EXPECT_EQ(parser_.Calls(base.Path()), 1);
+}
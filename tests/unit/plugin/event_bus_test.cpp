@@ -4,7 +4,10 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <span>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "cgs/plugin/event_bus.hpp"
@@ -297,6 +300,66 @@ TEST_F(EventBusTest, MixedSyncAndDeferred) {
     EXPECT_EQ(order[2], 2);
 }
 
+TEST_F(EventBusTest, DeferredEventsGroupedByType) {
+    std::vector<std::string> order;
+    bus_.Subscribe<IntEvent>([&](const IntEvent& e) {
+        order.push_back(std::to_string(e.value));
+    });
+    bus_.Subscribe<StringEvent>([&](const StringEvent& e) {
+        order.push_back(e.message);
+    });
+
+    bus_.PublishDeferred(IntEvent{1});
+    bus_.PublishDeferred(StringEvent{"a"});
+    bus_.PublishDeferred(IntEvent{2});
+    bus_.PublishDeferred(StringEvent{"b"});
+    EXPECT_EQ(bus_.DeferredCount(), 4u);
+
+    bus_.ProcessDeferred();
+
+    EXPECT_EQ(order, (std::vector<std::string>{"1", "2", "a", "b"}));
+    EXPECT_EQ(bus_.DeferredCount(), 0u);
+}
+
+TEST_F(EventBusTest, BatchHandlerReceivesDeferredEventsInOneCall) {
+    std::vector<std::vector<int>> batches;
+    std::vector<int> single;
+    bus_.SubscribeBatch<IntEvent>([&](std::span<const IntEvent> events) {
+        std::vector<int> values;
+        for (const auto& e : events) {
+            values.push_back(e.value);
+        }
+        batches.push_back(values);
+    });
+    bus_.Subscribe<IntEvent>([&](const IntEvent& e) { single.push_back(e.value); }, 1);
+
+    for (int i = 1; i <= 3; ++i) {
+        bus_.PublishDeferred(IntEvent{i});
+    }
+    bus_.ProcessDeferred();
+
+    ASSERT_EQ(batches.size(), 1u);
+    EXPECT_EQ(batches[0], (std::vector<int>{1, 2, 3}));
+    EXPECT_EQ(single, (std::vector<int>{1, 2, 3}));
+
+    bus_.Publish(IntEvent{4});
+    ASSERT_EQ(batches.size(), 2u);
+    EXPECT_EQ(batches[1], (std::vector<int>{4}));
+    EXPECT_EQ(bus_.HandlerCountFor<IntEvent>(), 2u);
+}
+
+TEST_F(EventBusTest, UnsubscribeBatchHandler) {
+    int calls = 0;
+    auto id = bus_.SubscribeBatch<IntEvent>([&](std::span<const IntEvent>) { ++calls; });
+
+    bus_.Unsubscribe(id);
+    bus_.PublishDeferred(IntEvent{1});
+    bus_.ProcessDeferred();
+
+    EXPECT_EQ(calls, 0);
+    EXPECT_EQ(bus_.HandlerCount(), 0u);
+}
+
 // ============================================================================
 // Subscription IDs
 // ============================================================================
@@ -338,6 +401,73 @@ TEST_F(EventBusTest, SubscribeDuringPublishDoesNotAffectCurrentDispatch) {
     EXPECT_EQ(order.size(), 2u);
 }
 
+TEST_F(EventBusTest, UnsubscribeSelfDuringPublish) {
+    int calls = 0;
+    SubscriptionId self = 0;
+    self = bus_.Subscribe<IntEvent>([&](const IntEvent&) {
+        ++calls;
+        bus_.Unsubscribe(self);
+    });
+    bus_.Subscribe<IntEvent>([&](const IntEvent&) { ++calls; });
+
+    bus_.Publish(IntEvent{0});
+    EXPECT_EQ(calls, 2);
+    bus_.Publish(IntEvent{0});
+    EXPECT_EQ(calls, 3);
+    EXPECT_EQ(bus_.HandlerCountFor<IntEvent>(), 1u);
+}
+
+// ============================================================================
+// Typed channels: no copies, lock-free publish
+// ============================================================================
+
+namespace {
+struct CopyCountingEvent {
+    CopyCountingEvent() = default;
+    CopyCountingEvent(const CopyCountingEvent& other) : copies(other.copies + 1) {}
+    CopyCountingEvent& operator=(const CopyCountingEvent&) = default;
+    int copies = 0;
+};
+}  // namespace
+
+TEST_F(EventBusTest, PublishPassesEventByReference) {
+    const CopyCountingEvent event;
+    const CopyCountingEvent* seen = nullptr;
+    bus_.Subscribe<CopyCountingEvent>([&](const CopyCountingEvent& e) { seen = &e; });
+    bus_.Subscribe<CopyCountingEvent>([&](const CopyCountingEvent& e) {
+        EXPECT_EQ(e.copies, 0);
+    });
+
+    bus_.Publish(event);
+    EXPECT_EQ(seen, &event);
+}
+
+TEST_F(EventBusTest, ConcurrentPublishWhileSubscribing) {
+    std::atomic<int> received{0};
+    bus_.Subscribe<IntEvent>([&](const IntEvent& e) { received.fetch_add(e.value); });
+
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> publishers;
+    for (int t = 0; t < 4; ++t) {
+        publishers.emplace_back([&] {
+            do {
+                bus_.Publish(IntEvent{1});
+            } while (!stop.load());
+        });
+    }
+    for (int i = 0; i < 200; ++i) {
+        auto id = bus_.Subscribe<IntEvent>([](const IntEvent&) {}, i % 3);
+        bus_.Unsubscribe(id);
+    }
+    stop.store(true);
+    for (auto& t : publishers) {
+        t.join();
+    }
+
+    EXPECT_GT(received.load(), 0);
+    EXPECT_EQ(bus_.HandlerCount(), 1u);
+}
+
 // ============================================================================
 // Plugin Lifecycle Events via PluginManager
 // ============================================================================
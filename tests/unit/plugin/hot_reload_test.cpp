@@ -7,6 +7,7 @@
 #include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <memory>
 #include <string>
 #include <thread>
 #include <vector>
@@ -15,6 +16,7 @@
 #include "cgs/plugin/hot_reload_manager.hpp"
 #include "cgs/plugin/hot_reloadable.hpp"
 #include "cgs/plugin/iplugin.hpp"
+#include "cgs/plugin/plugin_export.hpp"
 #include "cgs/plugin/plugin_manager.hpp"
 
 using namespace cgs::plugin;
@@ -191,6 +193,73 @@ TEST_F(FileWatcherTest, WatchMultipleFiles) {
     EXPECT_EQ(changed.size(), 2u);
 }
 
+TEST_F(FileWatcherTest, DetectsFileReplacedByRename) {
+    TempFile tmp("replace_target.so");
+    TempFile staging("replace_staging.so");
+    watcher_.SetDebounceMs(0);
+
+    int callCount = 0;
+    watcher_.SetCallback([&](const fs::path&) { callCount++; });
+    watcher_.Watch(tmp.Path());
+
+    // Build tools write the new library elsewhere and rename it over.
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    staging.Touch();
+    fs::rename(staging.Path(), tmp.Path());
+
+    watcher_.Poll();
+    EXPECT_EQ(callCount, 1);
+}
+
+TEST_F(FileWatcherTest, WriteBurstYieldsOneCallback) {
+    TempFile tmp("burst.txt");
+    watcher_.SetDebounceMs(100);
+
+    int callCount = 0;
+    watcher_.SetCallback([&](const fs::path&) { callCount++; });
+    watcher_.Watch(tmp.Path());
+
+    for (int i = 0; i < 5; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        tmp.Touch();
+        watcher_.Poll();
+    }
+    EXPECT_EQ(callCount, 0);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(120));
+    watcher_.Poll();
+    watcher_.Poll();
+    EXPECT_EQ(callCount, 1);
+}
+
+TEST(FileWatcherBackendTest, PollingBackendDetectsModification) {
+    FileWatcher watcher(FileWatchBackend::Polling);
+    TempFile tmp("polling_backend.txt");
+    watcher.SetDebounceMs(0);
+
+    int callCount = 0;
+    watcher.SetCallback([&](const fs::path&) { callCount++; });
+    ASSERT_TRUE(watcher.Watch(tmp.Path()));
+    EXPECT_FALSE(watcher.IsEventDriven(tmp.Path()));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    tmp.Touch();
+    watcher.Poll();
+    EXPECT_EQ(callCount, 1);
+}
+
+#if defined(__linux__) || defined(__APPLE__) || defined(_WIN32)
+TEST(FileWatcherBackendTest, LocalFilesUseNativeNotifications) {
+    FileWatcher watcher;
+    TempFile tmp("native_backend.txt");
+    ASSERT_TRUE(watcher.Watch(tmp.Path()));
+    EXPECT_TRUE(watcher.IsEventDriven(tmp.Path()));
+
+    watcher.Unwatch(tmp.Path());
+    EXPECT_FALSE(watcher.IsEventDriven(tmp.Path()));
+}
+#endif
+
 // ============================================================================
 // IHotReloadable Tests
 // ============================================================================
@@ -363,6 +432,104 @@ TEST_F(HotReloadManagerTest, SetDebounceMsDoesNotCrash) {
     // Just verify it doesn't crash.
 }
 
+TEST_F(HotReloadManagerTest, BeginReloadNotWatchedFails) {
+    auto result = hotReloadManager_.BeginReload("NonExistent");
+    EXPECT_TRUE(result.hasError());
+    EXPECT_EQ(hotReloadManager_.PendingReloadCount(), 0u);
+}
+
+// ============================================================================
+// PluginManager staged replacement
+// ============================================================================
+
+namespace {
+
+/// Plugin that records its lifecycle calls, tagged by generation.
+class StagedTestPlugin : public IPlugin {
+public:
+    StagedTestPlugin(std::string generation, std::vector<std::string>& log, bool initOk = true)
+        : generation_(std::move(generation)), log_(log), initOk_(initOk) {}
+
+    const PluginInfo& GetInfo() const override { return info_; }
+    bool OnLoad(PluginContext&) override { return record("load"); }
+    bool OnInit() override { return record("init") && initOk_; }
+    void OnUpdate(float) override { record("update"); }
+    void OnShutdown() override { record("shutdown"); }
+    void OnUnload() override { record("unload"); }
+
+private:
+    bool record(const char* call) {
+        log_.push_back(generation_ + ":" + call);
+        return true;
+    }
+
+    PluginInfo info_{"StagedPlugin", "Staged reload test plugin", {1, 0, 0}, {},
+                     kPluginApiVersion};
+    std::string generation_;
+    std::vector<std::string>& log_;
+    bool initOk_;
+};
+
+} // anonymous namespace
+
+class StagedReloadTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        auto& registry = StaticPluginRegistry();
+        auto saved = std::move(registry);
+        registry.clear();
+        registry.push_back({"StagedPlugin", [this]() -> std::unique_ptr<IPlugin> {
+                                return std::make_unique<StagedTestPlugin>("v1", log_);
+                            }});
+        auto result = manager_.RegisterStaticPlugins();
+        registry = std::move(saved);
+        ASSERT_TRUE(result.hasValue());
+        ASSERT_TRUE(manager_.InitializeAll().hasValue());
+        ASSERT_TRUE(manager_.ActivateAll().hasValue());
+        log_.clear();
+    }
+
+    std::vector<std::string> log_;
+    PluginManager manager_;
+};
+
+TEST_F(StagedReloadTest, StagedInstanceReplacesRunningOnSwap) {
+    auto* running = manager_.GetPlugin("StagedPlugin");
+
+    auto staged = manager_.StagePlugin(std::make_unique<StagedTestPlugin>("v2", log_));
+    ASSERT_TRUE(staged.hasValue()) << staged.error().message();
+    EXPECT_EQ(manager_.GetPlugin("StagedPlugin"), running);
+
+    manager_.UpdateAll(0.016f);
+    ASSERT_TRUE(manager_.SwapPlugin(std::move(staged).value()).hasValue());
+    manager_.UpdateAll(0.016f);
+
+    EXPECT_NE(manager_.GetPlugin("StagedPlugin"), running);
+    EXPECT_EQ(manager_.GetPluginState("StagedPlugin").value(), PluginState::Active);
+    EXPECT_EQ(log_, (std::vector<std::string>{"v2:load", "v2:init", "v1:update", "v1:shutdown",
+                                               "v1:unload", "v2:update"}));
+}
+
+TEST_F(StagedReloadTest, FailedStagingLeavesRunningInstance) {
+    auto* running = manager_.GetPlugin("StagedPlugin");
+
+    auto staged = manager_.StagePlugin(std::make_unique<StagedTestPlugin>("v2", log_, false));
+    EXPECT_TRUE(staged.hasError());
+
+    manager_.UpdateAll(0.016f);
+    EXPECT_EQ(manager_.GetPlugin("StagedPlugin"), running);
+    EXPECT_EQ(log_, (std::vector<std::string>{"v2:load", "v2:init", "v2:unload", "v1:update"}));
+}
+
+TEST_F(StagedReloadTest, DiscardedStagedInstanceIsShutDown) {
+    {
+        auto staged = manager_.StagePlugin(std::make_unique<StagedTestPlugin>("v2", log_));
+        ASSERT_TRUE(staged.hasValue());
+    }
+    EXPECT_EQ(log_, (std::vector<std::string>{"v2:load", "v2:init", "v2:shutdown", "v2:unload"}));
+    EXPECT_EQ(manager_.GetPluginState("StagedPlugin").value(), PluginState::Active);
+}
+
 // ============================================================================
 // PluginStateSnapshot Tests
 // ============================================================================
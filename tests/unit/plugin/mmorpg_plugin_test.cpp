@@ -319,6 +319,66 @@ TEST_F(MMORPGPluginTest, LeaveGuildFailsIfNotInGuild) {
     EXPECT_FALSE(plugin_.LeaveGuild(player));
 }
 
+TEST_F(MMORPGPluginTest, GuildRosterSlotsFollowSwapRemove) {
+    auto leader = plugin_.CreateCharacter(
+        "Leader", CharacterClass::Warrior, Vector3{}, defaultMap_);
+    auto guildId = plugin_.CreateGuild("Roster", leader);
+    std::vector<Entity> members;
+    for (int i = 0; i < 6; ++i) {
+        members.push_back(plugin_.CreateCharacter(
+            "Member" + std::to_string(i), CharacterClass::Mage, Vector3{}, defaultMap_));
+        ASSERT_TRUE(plugin_.JoinGuild(members.back(), guildId));
+    }
+
+    EXPECT_TRUE(plugin_.LeaveGuild(members[1]));
+    plugin_.RemoveCharacter(members[3]);
+
+    const auto* guild = plugin_.GetGuild(guildId);
+    ASSERT_NE(guild, nullptr);
+    ASSERT_EQ(guild->members.size(), 5u);
+    for (std::size_t slot = 0; slot < guild->members.size(); ++slot) {
+        const auto* data = plugin_.GetCharacterData(guild->members[slot].entity);
+        ASSERT_NE(data, nullptr);
+        EXPECT_EQ(data->guildSlot, slot);
+        EXPECT_EQ(data->guildId, guildId);
+    }
+}
+
+TEST_F(MMORPGPluginTest, OnlineGuildRosterTracksLogins) {
+    auto leader = plugin_.CreateCharacter(
+        "Leader", CharacterClass::Warrior, Vector3{}, defaultMap_);
+    auto a = plugin_.CreateCharacter("A", CharacterClass::Mage, Vector3{}, defaultMap_);
+    auto b = plugin_.CreateCharacter("B", CharacterClass::Priest, Vector3{}, defaultMap_);
+    auto guildId = plugin_.CreateGuild("Online", leader);
+    ASSERT_TRUE(plugin_.JoinGuild(a, guildId));
+
+    // Offline characters may join; they stay out of the online roster.
+    ASSERT_TRUE(plugin_.SetCharacterOnline(b, false));
+    ASSERT_TRUE(plugin_.JoinGuild(b, guildId));
+    EXPECT_EQ(plugin_.GetOnlineGuildMembers(guildId).size(), 2u);
+
+    ASSERT_TRUE(plugin_.SetCharacterOnline(leader, false));
+    auto online = plugin_.GetOnlineGuildMembers(guildId);
+    ASSERT_EQ(online.size(), 1u);
+    EXPECT_EQ(online[0].entity, a);
+
+    ASSERT_TRUE(plugin_.SetCharacterOnline(b, true));
+    EXPECT_TRUE(plugin_.SetCharacterOnline(b, true));  // already online
+    online = plugin_.GetOnlineGuildMembers(guildId);
+    ASSERT_EQ(online.size(), 2u);
+    EXPECT_TRUE(online[0].entity == b || online[1].entity == b);
+
+    // An online member leaving shrinks the online run.
+    EXPECT_TRUE(plugin_.LeaveGuild(a));
+    online = plugin_.GetOnlineGuildMembers(guildId);
+    ASSERT_EQ(online.size(), 1u);
+    EXPECT_EQ(online[0].entity, b);
+    EXPECT_EQ(plugin_.GetGuild(guildId)->members.size(), 2u);
+
+    EXPECT_FALSE(plugin_.SetCharacterOnline(Entity(9999, 0), true));
+    EXPECT_TRUE(plugin_.GetOnlineGuildMembers(9999).empty());
+}
+
 TEST_F(MMORPGPluginTest, LeaveGuildDisbandIfLastMember) {
     auto leader = plugin_.CreateCharacter(
         "Leader", CharacterClass::Warrior, Vector3{}, defaultMap_);
@@ -401,6 +461,50 @@ TEST_F(MMORPGPluginTest, EmptyHistoryReturnsEmpty) {
     EXPECT_TRUE(history.empty());
 }
 
+TEST_F(MMORPGPluginTest, ChatHistoryRingKeepsTheLatestMessages) {
+    auto player = plugin_.CreateCharacter(
+        "Chatter", CharacterClass::Mage, Vector3{}, defaultMap_);
+    const std::size_t sent = kMaxChatHistoryPerChannel + 50;
+    for (std::size_t i = 0; i < sent; ++i) {
+        plugin_.SendChat(player, ChatChannel::Trade, "WTS " + std::to_string(i));
+    }
+
+    auto history = plugin_.GetSharedChatHistory(ChatChannel::Trade, sent);
+    ASSERT_EQ(history.size(), kMaxChatHistoryPerChannel);
+    EXPECT_EQ(history.front()->content, "WTS 50");
+    EXPECT_EQ(history.back()->content, "WTS " + std::to_string(sent - 1));
+
+    auto latest = plugin_.GetChatHistory(ChatChannel::Trade, 1);
+    ASSERT_EQ(latest.size(), 1u);
+    EXPECT_EQ(latest[0].content, history.back()->content);
+}
+
+TEST_F(MMORPGPluginTest, ChatSubscribersShareOneMessage) {
+    auto player = plugin_.CreateCharacter(
+        "Trader", CharacterClass::Rogue, Vector3{}, defaultMap_);
+    std::vector<SharedChatMessage> first;
+    std::vector<SharedChatMessage> second;
+    const auto a = plugin_.SubscribeChat(
+        ChatChannel::Trade, [&](const SharedChatMessage& m) { first.push_back(m); });
+    const auto b = plugin_.SubscribeChat(
+        ChatChannel::Trade, [&](const SharedChatMessage& m) { second.push_back(m); });
+    EXPECT_NE(a, b);
+    EXPECT_EQ(plugin_.SubscribeChat(ChatChannel::COUNT, [](const SharedChatMessage&) {}), 0u);
+
+    plugin_.SendChat(player, ChatChannel::Trade, "WTB ore");
+    plugin_.SendChat(player, ChatChannel::Global, "not trade");
+    ASSERT_EQ(first.size(), 1u);
+    ASSERT_EQ(second.size(), 1u);
+    EXPECT_EQ(first[0].get(), second[0].get());
+    EXPECT_EQ(first[0].get(), plugin_.GetSharedChatHistory(ChatChannel::Trade, 1)[0].get());
+    EXPECT_EQ(first[0]->senderName, "Trader");
+
+    plugin_.UnsubscribeChat(a);
+    plugin_.SendChat(player, ChatChannel::Trade, "WTB more ore");
+    EXPECT_EQ(first.size(), 1u);
+    EXPECT_EQ(second.size(), 2u);
+}
+
 // ============================================================================
 // Map Instance Tests
 // ============================================================================
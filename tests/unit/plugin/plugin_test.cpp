@@ -1,11 +1,16 @@
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <functional>
+#include <memory>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <vector>
 
 #include "cgs/foundation/error_code.hpp"
 #include "cgs/plugin/iplugin.hpp"
+#include "cgs/plugin/plugin_events.hpp"
 #include "cgs/plugin/plugin_export.hpp"
 #include "cgs/plugin/plugin_manager.hpp"
 #include "cgs/plugin/plugin_types.hpp"
@@ -423,6 +428,130 @@ TEST(PluginManagerTest, UnloadPluginFailsIfActive) {
     EXPECT_EQ(result.error().code(), ErrorCode::PluginInvalidState);
 }
 
+// ===========================================================================
+// PluginManager: Update scheduling, timing and budgets
+// ===========================================================================
+
+/// Plugin with an update policy that sleeps in OnUpdate().
+class PolicyPlugin : public TestPlugin {
+public:
+    PolicyPlugin(std::string name, PluginUpdatePolicy policy,
+                 std::chrono::microseconds work = std::chrono::microseconds{0})
+        : TestPlugin(std::move(name)), policy_(std::move(policy)), work_(work) {}
+
+    PluginUpdatePolicy GetUpdatePolicy() const override { return policy_; }
+
+    void OnUpdate(float deltaTime) override {
+        if (work_.count() > 0) {
+            std::this_thread::sleep_for(work_);
+        }
+        TestPlugin::OnUpdate(deltaTime);
+    }
+
+private:
+    PluginUpdatePolicy policy_;
+    std::chrono::microseconds work_;
+};
+
+/// Load @p plugins into @p mgr through the static registry and activate them.
+static void LoadAndActivate(PluginManager& mgr,
+                            std::vector<PluginFactory> plugins) {
+    auto& registry = StaticPluginRegistry();
+    auto saved = std::move(registry);
+    registry.clear();
+    for (auto& factory : plugins) {
+        registry.push_back({"PolicyPlugin", std::move(factory)});
+    }
+    auto result = mgr.RegisterStaticPlugins();
+    registry = std::move(saved);
+    ASSERT_TRUE(result.hasValue()) << result.error().message();
+    ASSERT_TRUE(mgr.InitializeAll().hasValue());
+    ASSERT_TRUE(mgr.ActivateAll().hasValue());
+}
+
+TEST(PluginManagerTest, ThreadSafePluginsUpdateOnExecutorAfterDependencies) {
+    PluginManager mgr;
+    PluginUpdatePolicy parallel;
+    parallel.threadSafe = true;
+    PluginUpdatePolicy afterWorkers = parallel;
+    afterWorkers.updateAfter = {"WorkerA", "WorkerB"};
+
+    LoadAndActivate(mgr, {
+        [=] { return std::make_unique<PolicyPlugin>("WorkerA", parallel); },
+        [=] { return std::make_unique<PolicyPlugin>("WorkerB", parallel); },
+        [=] { return std::make_unique<PolicyPlugin>("Collector", afterWorkers); },
+    });
+
+    std::vector<std::size_t> batchSizes;
+    mgr.SetParallelExecutor([&](const std::vector<std::function<void()>>& tasks) {
+        batchSizes.push_back(tasks.size());
+        for (const auto& task : tasks) {
+            task();
+        }
+    });
+
+    mgr.UpdateAll(0.016f);
+
+    // WorkerA and WorkerB share a wave; Collector runs alone afterwards.
+    ASSERT_EQ(batchSizes.size(), 1u);
+    EXPECT_EQ(batchSizes[0], 2u);
+    for (const char* name : {"WorkerA", "WorkerB", "Collector"}) {
+        auto* plugin = dynamic_cast<TestPlugin*>(mgr.GetPlugin(name));
+        ASSERT_NE(plugin, nullptr);
+        EXPECT_EQ(plugin->updateCalls.size(), 1u) << name;
+    }
+}
+
+TEST(PluginManagerTest, UpdateStatsAndBudgetOverrun) {
+    PluginManager mgr;
+    PluginUpdatePolicy policy;
+    policy.budget = std::chrono::microseconds{100};
+    LoadAndActivate(mgr, {[=] {
+        return std::make_unique<PolicyPlugin>("Slow", policy, std::chrono::milliseconds{2});
+    }});
+
+    std::vector<std::string> exceeded;
+    mgr.GetEventBus().Subscribe<PluginBudgetExceededEvent>(
+        [&](const PluginBudgetExceededEvent& e) { exceeded.push_back(e.pluginName); });
+
+    mgr.UpdateAll(0.016f);
+
+    auto stats = mgr.GetUpdateStats("Slow");
+    ASSERT_TRUE(stats.hasValue());
+    EXPECT_EQ(stats.value().updates, 1u);
+    EXPECT_EQ(stats.value().overruns, 1u);
+    EXPECT_GE(stats.value().lastTime, std::chrono::milliseconds{2});
+    EXPECT_EQ(exceeded, (std::vector<std::string>{"Slow"}));
+
+    EXPECT_EQ(mgr.GetUpdateStats("Missing").error().code(), ErrorCode::PluginNotFound);
+}
+
+TEST(PluginManagerTest, DeferrablePluginSkipsOneTickWhenBudgetSpent) {
+    PluginManager mgr;
+    PluginUpdatePolicy deferrable;
+    deferrable.deferrable = true;
+    deferrable.updateAfter = {"Heavy"};
+    LoadAndActivate(mgr, {
+        [] {
+            return std::make_unique<PolicyPlugin>("Heavy", PluginUpdatePolicy{},
+                                                  std::chrono::milliseconds{2});
+        },
+        [=] { return std::make_unique<PolicyPlugin>("Optional", deferrable); },
+    });
+    mgr.SetUpdateBudget(std::chrono::microseconds{500});
+
+    mgr.UpdateAll(0.016f);
+    auto* optional = dynamic_cast<TestPlugin*>(mgr.GetPlugin("Optional"));
+    ASSERT_NE(optional, nullptr);
+    EXPECT_TRUE(optional->updateCalls.empty());
+
+    // Never deferred twice in a row; the skipped time is carried over.
+    mgr.UpdateAll(0.016f);
+    ASSERT_EQ(optional->updateCalls.size(), 1u);
+    EXPECT_FLOAT_EQ(optional->updateCalls[0], 0.032f);
+    EXPECT_EQ(mgr.GetUpdateStats("Optional").value().deferrals, 1u);
+}
+
 // ===========================================================================
 // PluginManager: Full lifecycle integration
 // ===========================================================================
@@ -523,6 +652,165 @@ TEST(PluginManagerTest, ShutdownAllReverseOrder) {
     EXPECT_EQ(stateB.value(), PluginState::Loaded);
 }
 
+// ===========================================================================
+// PluginManager: Level-parallel init and lazy map-type activation
+// ===========================================================================
+
+/// Test plugin with a caller-supplied PluginInfo.
+class InfoPlugin : public TestPlugin {
+public:
+    explicit InfoPlugin(PluginInfo info) : TestPlugin(info.name), info_(std::move(info)) {}
+
+    const PluginInfo& GetInfo() const override { return info_; }
+
+private:
+    PluginInfo info_;
+};
+
+/// Load @p infos into @p mgr through the static registry.
+static void LoadInfos(PluginManager& mgr, const std::vector<PluginInfo>& infos) {
+    auto& registry = StaticPluginRegistry();
+    auto saved = std::move(registry);
+    registry.clear();
+    for (const auto& info : infos) {
+        registry.push_back({info.name, [info] { return std::make_unique<InfoPlugin>(info); }});
+    }
+    auto result = mgr.RegisterStaticPlugins();
+    registry = std::move(saved);
+    ASSERT_TRUE(result.hasValue()) << result.error().message();
+}
+
+static PluginState StateOf(const PluginManager& mgr, std::string_view name) {
+    return mgr.GetPluginState(name).value();
+}
+
+TEST(PluginManagerTest, InitializeAllRunsIndependentPluginsInParallelByLevel) {
+    PluginManager mgr;
+    PluginInfo base{"Base", "", {1, 0, 0}, {}, kPluginApiVersion};
+    base.threadSafeInit = true;
+    PluginInfo assets = base;
+    assets.name = "Assets";
+    PluginInfo world = base;
+    world.name = "World";
+    world.dependencies = {"Base", "Assets"};
+    PluginInfo serial{"Serial", "", {1, 0, 0}, {}, kPluginApiVersion};
+    LoadInfos(mgr, {world, base, assets, serial});
+
+    auto report = mgr.ValidateDependencies();
+    ASSERT_EQ(report.loadLevels.size(), 2u);
+    EXPECT_EQ(report.loadLevels[0].size(), 3u);
+    EXPECT_EQ(report.loadLevels[1], (std::vector<std::string>{"World"}));
+
+    std::vector<std::size_t> batchSizes;
+    mgr.SetParallelExecutor([&](const std::vector<std::function<void()>>& tasks) {
+        batchSizes.push_back(tasks.size());
+        std::vector<std::thread> threads;
+        for (const auto& task : tasks) {
+            threads.emplace_back(task);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    });
+    std::vector<std::string> initialized;
+    mgr.GetEventBus().Subscribe<PluginInitializedEvent>(
+        [&](const PluginInitializedEvent& e) { initialized.push_back(e.pluginName); });
+
+    ASSERT_TRUE(mgr.InitializeAll().hasValue());
+
+    // Base and Assets in one batch; World alone after them; Serial inline.
+    EXPECT_EQ(batchSizes, (std::vector<std::size_t>{2}));
+    ASSERT_EQ(initialized.size(), 4u);
+    EXPECT_EQ(initialized.back(), "World");
+    for (const char* name : {"Base", "Assets", "World", "Serial"}) {
+        EXPECT_EQ(StateOf(mgr, name), PluginState::Initialized) << name;
+    }
+}
+
+TEST(PluginManagerTest, ParallelInitFailureStopsLaterLevels) {
+    PluginManager mgr;
+    PluginInfo good{"Good", "", {1, 0, 0}, {}, kPluginApiVersion};
+    good.threadSafeInit = true;
+    PluginInfo bad = good;
+    bad.name = "Bad";
+    PluginInfo later = good;
+    later.name = "Later";
+    later.dependencies = {"Good"};
+    LoadInfos(mgr, {good, bad, later});
+    dynamic_cast<TestPlugin*>(mgr.GetPlugin("Bad"))->initResult = false;
+    mgr.SetParallelExecutor([](const std::vector<std::function<void()>>& tasks) {
+        for (const auto& task : tasks) {
+            task();
+        }
+    });
+
+    auto result = mgr.InitializeAll();
+    ASSERT_TRUE(result.hasError());
+    EXPECT_EQ(result.error().code(), ErrorCode::PluginInitFailed);
+    EXPECT_EQ(StateOf(mgr, "Good"), PluginState::Initialized);
+    EXPECT_EQ(StateOf(mgr, "Bad"), PluginState::Error);
+    EXPECT_EQ(StateOf(mgr, "Later"), PluginState::Loaded);
+}
+
+TEST(PluginManagerTest, MapTypePluginsActivateLazily) {
+    PluginManager mgr;
+    PluginInfo core{"Core", "", {1, 0, 0}, {}, kPluginApiVersion};
+    PluginInfo pathing{"Pathing", "", {1, 0, 0}, {"Core"}, kPluginApiVersion};
+    pathing.mapTypes = {"dungeon", "battleground"};
+    PluginInfo bosses{"Bosses", "", {1, 0, 0}, {"Pathing"}, kPluginApiVersion};
+    bosses.mapTypes = {"dungeon"};
+    LoadInfos(mgr, {core, pathing, bosses});
+
+    EXPECT_EQ(mgr.AcquireMapType("dungeon").error().code(), ErrorCode::PluginInvalidState);
+
+    ASSERT_TRUE(mgr.InitializeAll().hasValue());
+    ASSERT_TRUE(mgr.ActivateAll().hasValue());
+    EXPECT_EQ(StateOf(mgr, "Core"), PluginState::Active);
+    EXPECT_EQ(StateOf(mgr, "Pathing"), PluginState::Loaded);
+    EXPECT_EQ(StateOf(mgr, "Bosses"), PluginState::Loaded);
+
+    ASSERT_TRUE(mgr.AcquireMapType("dungeon").hasValue());
+    ASSERT_TRUE(mgr.AcquireMapType("dungeon").hasValue());
+    ASSERT_TRUE(mgr.AcquireMapType("battleground").hasValue());
+    EXPECT_EQ(mgr.MapTypeRefCount("dungeon"), 2u);
+    EXPECT_EQ(StateOf(mgr, "Pathing"), PluginState::Active);
+    EXPECT_EQ(StateOf(mgr, "Bosses"), PluginState::Active);
+
+    mgr.UpdateAll(0.016f);
+    EXPECT_EQ(dynamic_cast<TestPlugin*>(mgr.GetPlugin("Bosses"))->updateCalls.size(), 1u);
+
+    // The last dungeon goes; battlegrounds still need Pathing.
+    mgr.ReleaseMapType("dungeon");
+    EXPECT_EQ(StateOf(mgr, "Bosses"), PluginState::Active);
+    mgr.ReleaseMapType("dungeon");
+    EXPECT_EQ(StateOf(mgr, "Bosses"), PluginState::Loaded);
+    EXPECT_EQ(StateOf(mgr, "Pathing"), PluginState::Active);
+
+    mgr.ReleaseMapType("battleground");
+    EXPECT_EQ(StateOf(mgr, "Pathing"), PluginState::Loaded);
+    EXPECT_EQ(StateOf(mgr, "Core"), PluginState::Active);
+
+    // A later instance brings them back.
+    ASSERT_TRUE(mgr.AcquireMapType("dungeon").hasValue());
+    EXPECT_EQ(StateOf(mgr, "Bosses"), PluginState::Active);
+}
+
+TEST(PluginManagerTest, MapTypePluginNeededByCoreIsEager) {
+    PluginManager mgr;
+    PluginInfo shared{"Shared", "", {1, 0, 0}, {}, kPluginApiVersion};
+    shared.mapTypes = {"dungeon"};
+    PluginInfo core{"Core", "", {1, 0, 0}, {"Shared"}, kPluginApiVersion};
+    LoadInfos(mgr, {shared, core});
+
+    ASSERT_TRUE(mgr.InitializeAll().hasValue());
+    EXPECT_EQ(StateOf(mgr, "Shared"), PluginState::Initialized);
+
+    ASSERT_TRUE(mgr.ActivateAll().hasValue());
+    ASSERT_TRUE(mgr.AcquireMapType("dungeon").hasValue());
+    mgr.ReleaseMapType("dungeon");
+    EXPECT_EQ(StateOf(mgr, "Shared"), PluginState::Active);
+}
+
 // ===========================================================================
 // PluginManager: Error handling
 // ===========================================================================
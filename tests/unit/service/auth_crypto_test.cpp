@@ -1,19 +1,26 @@
 #include <gtest/gtest.h>
 
+#include "cgs/service/auth_server.hpp"
 #include "cgs/service/auth_types.hpp"
 #include "cgs/service/password_hasher.hpp"
 #include "cgs/service/token_blacklist.hpp"
+#include "cgs/service/token_cache.hpp"
 #include "cgs/service/token_provider.hpp"
+#include "cgs/service/token_store.hpp"
+#include "cgs/service/user_repository.hpp"
 
+#include <atomic>
 #include <chrono>
 #include <future>
 #include <set>
+#include <span>
 #include <string>
 #include <thread>
 #include <vector>
 
 #include <openssl/bio.h>
 #include <openssl/evp.h>
+#include <openssl/hmac.h>
 #include <openssl/pem.h>
 
 using namespace cgs::service;
@@ -140,6 +147,41 @@ TEST_F(PasswordHasherTest, GenerateSaltUniqueness) {
     EXPECT_EQ(salts.size(), 100u);
 }
 
+TEST(PasswordHasherScryptTest, HashRecordsSchemeAndVerifies) {
+    PasswordHasher scrypt(10);
+    EXPECT_EQ(scrypt.cost(), 10u);
+
+    auto result = scrypt.hash("my_secret_pass");
+    EXPECT_EQ(result.hash.rfind("scrypt$10$", 0), 0u);
+    EXPECT_TRUE(scrypt.verify("my_secret_pass", result.hash, result.salt));
+    EXPECT_FALSE(scrypt.verify("wrong_password", result.hash, result.salt));
+}
+
+TEST(PasswordHasherScryptTest, VerifiesHashesOfOtherCosts) {
+    PasswordHasher legacy;
+    PasswordHasher low(8);
+    PasswordHasher high(10);
+
+    // Raising the cost keeps stored passwords valid.
+    auto old = legacy.hash("password123");
+    EXPECT_TRUE(high.verify("password123", old.hash, old.salt));
+    auto lowHash = low.hash("password123");
+    EXPECT_TRUE(high.verify("password123", lowHash.hash, lowHash.salt));
+    EXPECT_TRUE(legacy.verify("password123", lowHash.hash, lowHash.salt));
+}
+
+TEST(PasswordHasherScryptTest, RejectsMalformedScryptHash) {
+    PasswordHasher scrypt(8);
+    auto result = scrypt.hash("password123");
+    EXPECT_FALSE(scrypt.verify("password123", "scrypt$", result.salt));
+    EXPECT_FALSE(scrypt.verify("password123", "scrypt$99$00", result.salt));
+    EXPECT_FALSE(scrypt.verify("password123", "scrypt$8", result.salt));
+}
+
+TEST(PasswordHasherScryptTest, ClampsCost) {
+    EXPECT_EQ(PasswordHasher(99).cost(), PasswordHasher::kMaxCost);
+}
+
 // =============================================================================
 // TokenProvider tests — HS256 backward compatibility (SRS-SVC-001.3, SRS-SVC-001.4)
 // =============================================================================
@@ -341,6 +383,83 @@ TEST_F(TokenProviderTest, SpecialCharactersInClaims) {
     EXPECT_EQ(result.value().username, "user@domain.com");
 }
 
+TEST_F(TokenProviderTest, EscapedClaimsRoundTrip) {
+    TokenClaims claims;
+    claims.subject = "id\\with\\backslashes";
+    claims.username = "tab\there";
+    claims.roles = {"role\"with\"quotes", "line\nbreak", "plain"};
+
+    auto token = provider.generateAccessToken(claims, std::chrono::seconds{60});
+    auto result = provider.validateAccessToken(token);
+    ASSERT_TRUE(result.hasValue());
+    EXPECT_EQ(result.value().subject, claims.subject);
+    EXPECT_EQ(result.value().username, claims.username);
+    EXPECT_EQ(result.value().roles, claims.roles);
+}
+
+namespace {
+
+std::string base64url(std::string_view input) {
+    std::string out(4 * ((input.size() + 2) / 3) + 1, '\0');
+    auto n = EVP_EncodeBlock(reinterpret_cast<unsigned char*>(out.data()),
+                             reinterpret_cast<const unsigned char*>(input.data()),
+                             static_cast<int>(input.size()));
+    out.resize(static_cast<std::size_t>(n));
+    while (!out.empty() && out.back() == '=') {
+        out.pop_back();
+    }
+    for (auto& c : out) {
+        c = c == '+' ? '-' : (c == '/' ? '_' : c);
+    }
+    return out;
+}
+
+std::string signHs256(std::string_view key, std::string_view header, std::string_view payload) {
+    auto input = base64url(header) + "." + base64url(payload);
+    unsigned char mac[32];
+    unsigned int macLength = sizeof(mac);
+    HMAC(EVP_sha256(), key.data(), static_cast<int>(key.size()),
+         reinterpret_cast<const unsigned char*>(input.data()), input.size(), mac, &macLength);
+    return input + "." +
+           base64url(std::string_view(reinterpret_cast<const char*>(mac), macLength));
+}
+
+} // namespace
+
+TEST_F(TokenProviderTest, AcceptsOtherIssuersLayout) {
+    auto exp = std::chrono::duration_cast<std::chrono::seconds>(
+                   (std::chrono::system_clock::now() + std::chrono::hours{1})
+                       .time_since_epoch())
+                   .count();
+    auto token = signHs256(config_.signingKey,
+                           R"({"typ":"JWT", "alg":"HS256", "kid":"k1"})",
+                           R"({ "iss":"other", "exp":)" + std::to_string(exp) +
+                               R"(, "sub":"7", "ext":{"a":[1,{"b":"]"}]}, "roles":["player"],)"
+                               R"( "usr":"x", "jti":"j", "iat":1, "ok":true })");
+
+    auto result = provider.validateAccessToken(token);
+    ASSERT_TRUE(result.hasValue()) << result.error().message();
+    EXPECT_EQ(result.value().subject, "7");
+    EXPECT_EQ(result.value().username, "x");
+    EXPECT_EQ(result.value().roles, std::vector<std::string>{"player"});
+    EXPECT_EQ(result.value().jti, "j");
+}
+
+TEST_F(TokenProviderTest, RejectsMalformedPayloadAndNonCanonicalSignature) {
+    auto malformed = signHs256(config_.signingKey, R"({"alg":"HS256"})", R"({"sub":"7",)");
+    EXPECT_TRUE(provider.validateAccessToken(malformed).hasError());
+
+    // The last character of a 32-byte MAC carries two unused bits; a token
+    // differing only there must not validate.
+    auto token = provider.generateAccessToken(makeTestClaims(), std::chrono::seconds{60});
+    static constexpr std::string_view kAlphabet =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+    token.back() = kAlphabet[kAlphabet.find(token.back()) ^ 1];
+    auto result = provider.validateAccessToken(token);
+    ASSERT_TRUE(result.hasError());
+    EXPECT_EQ(result.error().code(), cgs::foundation::ErrorCode::InvalidToken);
+}
+
 TEST_F(TokenProviderTest, EmptyTokenString) {
     auto result = provider.validateAccessToken("");
     ASSERT_TRUE(result.hasError());
@@ -571,6 +690,183 @@ TEST_F(TokenBlacklistTest, ThreadSafety) {
               static_cast<std::size_t>(kWriterCount * kOpsPerWriter));
 }
 
+TEST_F(TokenBlacklistTest, RevokeEmitsOnRevoked) {
+    std::vector<std::string> revoked;
+    blacklist.onRevoked.connect([&](std::string_view jti) { revoked.emplace_back(jti); });
+
+    blacklist.revoke("jti-001", std::chrono::system_clock::now() + std::chrono::seconds{300});
+    ASSERT_EQ(revoked.size(), 1u);
+    EXPECT_EQ(revoked[0], "jti-001");
+}
+
+TEST_F(TokenBlacklistTest, CleanupKeepsFilterAccurate) {
+    const auto now = std::chrono::system_clock::now();
+    for (int i = 0; i < 100; ++i) {
+        blacklist.revoke("old-" + std::to_string(i), now - std::chrono::seconds{5});
+    }
+    blacklist.revoke("live", now + std::chrono::seconds{300});
+    EXPECT_EQ(blacklist.cleanup(), 100u);
+
+    // Survivors stay revoked through the rebuilt filter; dropped ones go.
+    EXPECT_TRUE(blacklist.isRevoked("live"));
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_FALSE(blacklist.isRevoked("old-" + std::to_string(i)));
+    }
+    EXPECT_EQ(blacklist.cleanup(), 0u);
+}
+
+TEST_F(TokenBlacklistTest, ReplicatesThroughRecords) {
+    std::vector<uint8_t> stream;
+    blacklist.onReplicate.connect([&](std::span<const uint8_t> record) {
+        stream.insert(stream.end(), record.begin(), record.end());
+    });
+    const auto expiresAt = std::chrono::system_clock::now() + std::chrono::seconds{300};
+    blacklist.revoke("jti-a", expiresAt);
+    blacklist.revoke("jti-b", expiresAt);
+    blacklist.revoke("jti-a", expiresAt);  // already known: not re-sent
+    ASSERT_EQ(stream.size(), 2 * TokenBlacklist::kRecordSize);
+
+    TokenBlacklist peer{std::chrono::seconds{60}};
+    EXPECT_EQ(peer.merge(stream), 2u);
+    EXPECT_EQ(peer.merge(stream), 0u);
+    EXPECT_TRUE(peer.isRevoked("jti-a"));
+    EXPECT_TRUE(peer.isRevoked("jti-b"));
+    EXPECT_FALSE(peer.isRevoked("jti-c"));
+
+    // A late joiner loads a snapshot; a torn trailing record is ignored.
+    auto snapshot = peer.exportRecords();
+    EXPECT_EQ(snapshot.size(), 2 * TokenBlacklist::kRecordSize);
+    snapshot.push_back(0xFF);
+    TokenBlacklist joiner{std::chrono::seconds{60}};
+    EXPECT_EQ(joiner.merge(snapshot), 2u);
+    EXPECT_TRUE(joiner.isRevoked("jti-b"));
+}
+
+TEST_F(TokenBlacklistTest, MergeSkipsExpiredRecords) {
+    std::vector<uint8_t> stream;
+    blacklist.onReplicate.connect([&](std::span<const uint8_t> record) {
+        stream.insert(stream.end(), record.begin(), record.end());
+    });
+    blacklist.revoke("gone", std::chrono::system_clock::now() - std::chrono::seconds{5});
+
+    TokenBlacklist peer{std::chrono::seconds{60}};
+    EXPECT_EQ(peer.merge(stream), 0u);
+    EXPECT_EQ(peer.size(), 0u);
+}
+
+TEST_F(TokenBlacklistTest, ReadersRaceCleanup) {
+    const auto now = std::chrono::system_clock::now();
+    blacklist.revoke("live", now + std::chrono::seconds{300});
+
+    std::atomic<bool> stop{false};
+    std::atomic<int> misses{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; ++r) {
+        readers.emplace_back([&] {
+            while (!stop.load()) {
+                if (!blacklist.isRevoked("live")) {
+                    misses.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (int round = 0; round < 50; ++round) {
+        blacklist.revoke("old-" + std::to_string(round), now - std::chrono::seconds{5});
+        (void)blacklist.cleanup();
+    }
+    stop.store(true);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(misses.load(), 0);
+}
+
+// =============================================================================
+// VerifiedTokenCache tests (SRS-NFR-014)
+// =============================================================================
+
+namespace {
+
+TokenClaims cacheClaims(std::string jti, std::chrono::seconds ttl) {
+    TokenClaims claims;
+    claims.subject = "user-cache";
+    claims.jti = std::move(jti);
+    claims.expiresAt = std::chrono::system_clock::now() + ttl;
+    return claims;
+}
+
+}  // namespace
+
+TEST(VerifiedTokenCacheTest, FindAfterInsert) {
+    VerifiedTokenCache cache(16);
+    EXPECT_FALSE(cache.find("token-a").has_value());
+
+    cache.insert("token-a", cacheClaims("jti-a", std::chrono::seconds{60}));
+    auto hit = cache.find("token-a");
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_EQ(hit->jti, "jti-a");
+    EXPECT_FALSE(cache.find("token-b").has_value());
+}
+
+TEST(VerifiedTokenCacheTest, InvalidateByJti) {
+    VerifiedTokenCache cache(16);
+    cache.insert("token-a", cacheClaims("jti-a", std::chrono::seconds{60}));
+    cache.insert("token-b", cacheClaims("jti-b", std::chrono::seconds{60}));
+
+    cache.invalidate("jti-a");
+    EXPECT_FALSE(cache.find("token-a").has_value());
+    EXPECT_TRUE(cache.find("token-b").has_value());
+    EXPECT_EQ(cache.size(), 1u);
+}
+
+TEST(VerifiedTokenCacheTest, ExpiredEntriesMissAndMakeRoom) {
+    VerifiedTokenCache cache(2);
+    cache.insert("old", cacheClaims("jti-old", std::chrono::seconds{-1}));
+    EXPECT_FALSE(cache.find("old").has_value());
+
+    cache.insert("a", cacheClaims("jti-a", std::chrono::seconds{60}));
+    cache.insert("b", cacheClaims("jti-b", std::chrono::seconds{60}));
+    EXPECT_TRUE(cache.find("a").has_value());
+    EXPECT_TRUE(cache.find("b").has_value());
+    EXPECT_LE(cache.size(), 2u);
+}
+
+TEST(VerifiedTokenCacheTest, ZeroCapacityDisables) {
+    VerifiedTokenCache cache(0);
+    cache.insert("token-a", cacheClaims("jti-a", std::chrono::seconds{60}));
+    EXPECT_FALSE(cache.find("token-a").has_value());
+}
+
+TEST(AuthServerRs256Test, ValidateTokenAsyncVerifiesOnWorker) {
+    auto config = makeRs256Config();
+    config.tokenVerifyThreads = 1;
+    AuthServer server(std::move(config),
+                      std::make_shared<InMemoryUserRepository>(),
+                      std::make_shared<InMemoryTokenStore>());
+    ASSERT_TRUE(server.registerUser({"rsauser", "rsa@example.com", "StrongPass1!"}).hasValue());
+    auto login = server.login("rsauser", "StrongPass1!", "127.0.0.1");
+    ASSERT_TRUE(login.hasValue());
+    const auto token = login.value().accessToken;
+
+    auto validate = [&] {
+        std::promise<std::pair<bool, std::thread::id>> done;
+        server.validateTokenAsync(token, [&](cgs::foundation::GameResult<TokenClaims> result) {
+            done.set_value({result.hasValue(), std::this_thread::get_id()});
+        });
+        return done.get_future().get();
+    };
+
+    auto [firstOk, firstThread] = validate();
+    EXPECT_TRUE(firstOk);
+    EXPECT_NE(firstThread, std::this_thread::get_id());
+    EXPECT_EQ(server.cachedTokenCount(), 1u);
+
+    // Cached now: completes inline.
+    auto [secondOk, secondThread] = validate();
+    EXPECT_TRUE(secondOk);
+    EXPECT_EQ(secondThread, std::this_thread::get_id());
+}
+
 // =============================================================================
 // TokenProvider + Blacklist integration (SRS-NFR-014)
 // =============================================================================
@@ -5,13 +5,18 @@
 #include "cgs/service/auth_types.hpp"
 #include "cgs/service/input_validator.hpp"
 #include "cgs/service/rate_limiter.hpp"
+#include "cgs/service/token_blacklist.hpp"
 #include "cgs/service/token_store.hpp"
+#include "cgs/service/user_cache.hpp"
 #include "cgs/service/user_repository.hpp"
 
 #include <chrono>
+#include <future>
 #include <memory>
+#include <span>
 #include <string>
 #include <thread>
+#include <vector>
 
 using namespace cgs::service;
 using cgs::foundation::ErrorCode;
@@ -414,6 +419,219 @@ TEST_F(AuthServerTest, ValidateInvalidToken) {
     EXPECT_EQ(result.error().code(), ErrorCode::InvalidToken);
 }
 
+TEST_F(AuthServerTest, ValidateCachesVerifiedToken) {
+    registerTestUser();
+    auto loginResult = server_->login("testuser", "StrongPass1!", "127.0.0.1");
+    ASSERT_TRUE(loginResult.hasValue());
+    const auto& token = loginResult.value().accessToken;
+
+    EXPECT_EQ(server_->cachedTokenCount(), 0u);
+    ASSERT_TRUE(server_->validateToken(token).hasValue());
+    EXPECT_EQ(server_->cachedTokenCount(), 1u);
+
+    auto again = server_->validateToken(token);
+    ASSERT_TRUE(again.hasValue());
+    EXPECT_EQ(again.value().username, "testuser");
+    EXPECT_EQ(server_->cachedTokenCount(), 1u);
+}
+
+TEST_F(AuthServerTest, RevokedTokenLeavesCache) {
+    registerTestUser();
+    auto loginResult = server_->login("testuser", "StrongPass1!", "127.0.0.1");
+    ASSERT_TRUE(loginResult.hasValue());
+    const auto& token = loginResult.value().accessToken;
+    ASSERT_TRUE(server_->validateToken(token).hasValue());
+
+    ASSERT_TRUE(server_->revokeAccessToken(token).hasValue());
+    EXPECT_EQ(server_->cachedTokenCount(), 0u);
+
+    auto result = server_->validateToken(token);
+    ASSERT_TRUE(result.hasError());
+    EXPECT_EQ(result.error().code(), ErrorCode::TokenRevoked);
+}
+
+TEST_F(AuthServerTest, ReplicatedRevocationRejectsCachedToken) {
+    registerTestUser();
+    auto loginResult = server_->login("testuser", "StrongPass1!", "127.0.0.1");
+    ASSERT_TRUE(loginResult.hasValue());
+    const auto& token = loginResult.value().accessToken;
+
+    // A second node (e.g. a gateway) with the same key has the token cached.
+    AuthConfig peerConfig;
+    peerConfig.signingKey = "test-key-must-be-at-least-32-bytes-long!!";
+    AuthServer peer(std::move(peerConfig), userRepo_, tokenStore_);
+    ASSERT_TRUE(peer.validateToken(token).hasValue());
+    EXPECT_EQ(peer.cachedTokenCount(), 1u);
+
+    server_->blacklist().onReplicate.connect(
+        [&](std::span<const uint8_t> record) { (void)peer.blacklist().merge(record); });
+    ASSERT_TRUE(server_->revokeAccessToken(token).hasValue());
+
+    auto result = peer.validateToken(token);
+    ASSERT_TRUE(result.hasError());
+    EXPECT_EQ(result.error().code(), ErrorCode::TokenRevoked);
+    EXPECT_EQ(peer.cachedTokenCount(), 0u);
+}
+
+TEST_F(AuthServerTest, ValidateTokenAsyncWithoutRsaKeyRunsInline) {
+    registerTestUser();
+    auto loginResult = server_->login("testuser", "StrongPass1!", "127.0.0.1");
+    ASSERT_TRUE(loginResult.hasValue());
+
+    bool called = false;
+    server_->validateTokenAsync(loginResult.value().accessToken,
+                                [&](cgs::foundation::GameResult<TokenClaims> result) {
+                                    called = true;
+                                    EXPECT_TRUE(result.hasValue());
+                                });
+    EXPECT_TRUE(called);
+}
+
+// =============================================================================
+// Async login (password hashing pool)
+// =============================================================================
+
+TEST_F(AuthServerTest, LoginAsyncIssuesTokensOnWorker) {
+    registerTestUser();
+
+    std::promise<cgs::foundation::GameResult<TokenPair>> done;
+    auto future = done.get_future();
+    server_->loginAsync("testuser", "StrongPass1!", "127.0.0.1",
+                        [&](cgs::foundation::GameResult<TokenPair> result) {
+                            done.set_value(std::move(result));
+                        });
+    auto result = future.get();
+    ASSERT_TRUE(result.hasValue());
+    EXPECT_TRUE(server_->validateToken(result.value().accessToken).hasValue());
+
+    auto stats = server_->loginPoolStats();
+    EXPECT_EQ(stats.completed, 1u);
+    EXPECT_EQ(stats.shed, 0u);
+    EXPECT_EQ(stats.pending, 0u);
+}
+
+TEST_F(AuthServerTest, LoginAsyncWrongPassword) {
+    registerTestUser();
+
+    std::promise<cgs::foundation::GameResult<TokenPair>> done;
+    auto future = done.get_future();
+    server_->loginAsync("testuser", "WrongPass1!", "127.0.0.1",
+                        [&](cgs::foundation::GameResult<TokenPair> result) {
+                            done.set_value(std::move(result));
+                        });
+    auto result = future.get();
+    ASSERT_TRUE(result.hasError());
+    EXPECT_EQ(result.error().code(), ErrorCode::InvalidCredentials);
+}
+
+TEST_F(AuthServerTest, LoginAsyncRateLimitedInline) {
+    registerTestUser();
+    for (int i = 0; i < 3; ++i) {
+        (void)server_->login("testuser", "WrongPass1!", "10.0.0.1");
+    }
+
+    bool called = false;
+    server_->loginAsync("testuser", "StrongPass1!", "10.0.0.1",
+                        [&](cgs::foundation::GameResult<TokenPair> result) {
+                            called = true;
+                            ASSERT_TRUE(result.hasError());
+                            EXPECT_EQ(result.error().code(), ErrorCode::RateLimitExceeded);
+                        });
+    EXPECT_TRUE(called);
+}
+
+TEST_F(AuthServerTest, LoginAsyncShedsWhenQueueFull) {
+    AuthConfig config;
+    config.signingKey = "test-key-must-be-at-least-32-bytes-long!!";
+    config.passwordHashThreads = 1;
+    config.passwordHashQueueLimit = 1;
+    AuthServer server(std::move(config), userRepo_, tokenStore_);
+    ASSERT_TRUE(server.registerUser(validCredentials()).hasValue());
+
+    // Hold the only worker inside the first login's callback, so the
+    // second login stays queued.
+    std::promise<void> entered;
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    server.loginAsync("testuser", "StrongPass1!", "10.0.0.1",
+                      [&, released](cgs::foundation::GameResult<TokenPair> result) {
+                          EXPECT_TRUE(result.hasValue());
+                          entered.set_value();
+                          released.wait();
+                      });
+    entered.get_future().wait();
+
+    std::promise<void> second;
+    server.loginAsync("testuser", "StrongPass1!", "10.0.0.2",
+                      [&](cgs::foundation::GameResult<TokenPair> result) {
+                          EXPECT_TRUE(result.hasValue());
+                          second.set_value();
+                      });
+    EXPECT_EQ(server.loginPoolStats().pending, 1u);
+
+    bool shed = false;
+    server.loginAsync("testuser", "StrongPass1!", "10.0.0.3",
+                      [&](cgs::foundation::GameResult<TokenPair> result) {
+                          shed = true;
+                          ASSERT_TRUE(result.hasError());
+                          EXPECT_EQ(result.error().code(), ErrorCode::AuthOverloaded);
+                      });
+    EXPECT_TRUE(shed);
+
+    release.set_value();
+    second.get_future().wait();
+    EXPECT_EQ(server.loginPoolStats().shed, 1u);
+}
+
+TEST_F(AuthServerTest, LoginAsyncExpiresPastQueueDeadline) {
+    AuthConfig config;
+    config.signingKey = "test-key-must-be-at-least-32-bytes-long!!";
+    config.passwordHashThreads = 1;
+    config.passwordHashQueueDeadline = std::chrono::milliseconds{5};
+    AuthServer server(std::move(config), userRepo_, tokenStore_);
+    ASSERT_TRUE(server.registerUser(validCredentials()).hasValue());
+
+    // The first login occupies the worker past the second's deadline.
+    server.loginAsync("testuser", "StrongPass1!", "10.0.0.1",
+                      [](cgs::foundation::GameResult<TokenPair>) {
+                          std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                      });
+    std::promise<cgs::foundation::GameResult<TokenPair>> done;
+    auto future = done.get_future();
+    server.loginAsync("testuser", "StrongPass1!", "10.0.0.2",
+                      [&](cgs::foundation::GameResult<TokenPair> result) {
+                          done.set_value(std::move(result));
+                      });
+
+    auto result = future.get();
+    ASSERT_TRUE(result.hasError());
+    EXPECT_EQ(result.error().code(), ErrorCode::AuthOverloaded);
+
+    auto stats = server.loginPoolStats();
+    EXPECT_EQ(stats.expired, 1u);
+    EXPECT_EQ(stats.completed, 1u);
+    EXPECT_GE(stats.maxQueueWait, std::chrono::milliseconds{5});
+}
+
+TEST_F(AuthServerTest, LoginAsyncWithoutWorkersRunsInline) {
+    AuthConfig config;
+    config.signingKey = "test-key-must-be-at-least-32-bytes-long!!";
+    config.passwordHashThreads = 0;
+    config.passwordHashCost = 8;
+    AuthServer server(std::move(config), userRepo_, tokenStore_);
+    ASSERT_TRUE(server.registerUser(validCredentials()).hasValue());
+    EXPECT_EQ(userRepo_->findByUsername("testuser")->passwordHash.rfind("scrypt$8$", 0), 0u);
+
+    bool called = false;
+    server.loginAsync("testuser", "StrongPass1!", "127.0.0.1",
+                      [&](cgs::foundation::GameResult<TokenPair> result) {
+                          called = true;
+                          EXPECT_TRUE(result.hasValue());
+                      });
+    EXPECT_TRUE(called);
+    EXPECT_GT(server.loginPoolStats().totalHashTime.count(), 0);
+}
+
 TEST_F(AuthServerTest, ValidateExpiredToken) {
     // Create server with very short token expiry.
     auto shortRepo = std::make_shared<InMemoryUserRepository>();
@@ -458,6 +676,174 @@ TEST_F(AuthServerTest, UserRepositoryFindByEmail) {
     EXPECT_EQ(found->username, "testuser");
 }
 
+// =============================================================================
+// Cached and SQL user repositories
+// =============================================================================
+
+namespace {
+
+/// InMemoryUserRepository that counts the reads reaching it.
+class CountingUserRepository : public InMemoryUserRepository {
+public:
+    std::optional<UserRecord> findById(uint64_t id) const override {
+        ++reads;
+        return InMemoryUserRepository::findById(id);
+    }
+    std::optional<UserRecord> findByUsername(std::string_view username) const override {
+        ++reads;
+        return InMemoryUserRepository::findByUsername(username);
+    }
+    std::optional<UserRecord> findByEmail(std::string_view email) const override {
+        ++reads;
+        return InMemoryUserRepository::findByEmail(email);
+    }
+
+    mutable int reads = 0;
+};
+
+UserRecord makeUser(std::string name) {
+    UserRecord user;
+    user.username = name;
+    user.email = name + "@example.com";
+    user.passwordHash = "hash";
+    user.roles = {"player", "tester"};
+    return user;
+}
+
+}  // namespace
+
+TEST(CachedUserRepositoryTest, ServesRepeatedReadsFromCache) {
+    auto backing = std::make_shared<CountingUserRepository>();
+    CachedUserRepository users(backing);
+    auto id = users.create(makeUser("alice"));
+
+    ASSERT_TRUE(users.findByUsername("alice").has_value());
+    EXPECT_EQ(backing->reads, 1);
+    EXPECT_EQ(users.findById(id)->username, "alice");
+    EXPECT_EQ(users.findByEmail("alice@example.com")->id, id);
+    EXPECT_EQ(users.findByUsername("alice")->roles, (std::vector<std::string>{"player", "tester"}));
+    EXPECT_EQ(backing->reads, 1);
+    EXPECT_EQ(users.hitCount(), 3u);
+    EXPECT_EQ(users.missCount(), 1u);
+}
+
+TEST(CachedUserRepositoryTest, CachesFreeUsernamesUntilCreated) {
+    auto backing = std::make_shared<CountingUserRepository>();
+    CachedUserRepository users(backing);
+
+    EXPECT_FALSE(users.findByUsername("bob").has_value());
+    EXPECT_FALSE(users.findByUsername("bob").has_value());
+    EXPECT_EQ(backing->reads, 1);
+
+    users.create(makeUser("bob"));
+    EXPECT_TRUE(users.findByUsername("bob").has_value());
+    EXPECT_EQ(backing->reads, 2);
+}
+
+TEST(CachedUserRepositoryTest, UpdateInvalidatesOldIndexes) {
+    auto backing = std::make_shared<CountingUserRepository>();
+    CachedUserRepository users(backing);
+    auto id = users.create(makeUser("carol"));
+    auto user = users.findById(id);
+    ASSERT_TRUE(user.has_value());
+
+    user->username = "caroline";
+    ASSERT_TRUE(users.update(*user));
+    EXPECT_FALSE(users.findByUsername("carol").has_value());
+    EXPECT_EQ(users.findById(id)->username, "caroline");
+}
+
+TEST(CachedUserRepositoryTest, InvalidationReachesPeers) {
+    auto backing = std::make_shared<CountingUserRepository>();
+    CachedUserRepository nodeA(backing);
+    CachedUserRepository nodeB(backing);
+    nodeA.onInvalidate.connect([&](std::span<const uint8_t> record) {
+        EXPECT_TRUE(nodeB.applyInvalidation(record));
+    });
+
+    // Node B has seen the name free and the old status.
+    EXPECT_FALSE(nodeB.findByUsername("dave").has_value());
+    auto id = nodeA.create(makeUser("dave"));
+    ASSERT_TRUE(nodeB.findByUsername("dave").has_value());
+
+    auto user = *nodeA.findById(id);
+    user.status = UserStatus::Suspended;
+    ASSERT_TRUE(nodeA.update(user));
+    EXPECT_EQ(nodeB.findById(id)->status, UserStatus::Suspended);
+
+    const std::vector<uint8_t> truncated{1, 2, 3};
+    EXPECT_FALSE(nodeB.applyInvalidation(truncated));
+}
+
+TEST(CachedUserRepositoryTest, EvictsWhenFull) {
+    auto backing = std::make_shared<CountingUserRepository>();
+    CachedUserRepository users(backing, UserCacheConfig{.capacity = 2});
+    for (auto name : {"u1", "u2", "u3", "u4"}) {
+        users.create(makeUser(name));
+        ASSERT_TRUE(users.findByUsername(name).has_value());
+    }
+    EXPECT_EQ(users.size(), 2u);
+}
+
+TEST(SqlUserRepositoryTest, MapsRecordsToStatements) {
+    std::vector<std::string> statements;
+    UserStoreBackend backend;
+    backend.query = [&](const cgs::foundation::PreparedStatement& stmt) {
+        statements.push_back(stmt.resolve());
+        cgs::foundation::QueryResult result({"id", "username", "email", "password_hash", "salt",
+                                             "status", "roles", "created_at", "updated_at"});
+        result.push_back({{"id", int64_t{7}},
+                          {"username", std::string("erin")},
+                          {"email", std::string("erin@example.com")},
+                          {"password_hash", std::string("hash")},
+                          {"salt", std::string("")},
+                          {"status", int64_t{1}},
+                          {"roles", std::string("player,admin")},
+                          {"created_at", int64_t{1000}},
+                          {"updated_at", int64_t{2000}}});
+        return cgs::foundation::GameResult<cgs::foundation::QueryResult>::ok(std::move(result));
+    };
+    backend.execute = [&](const cgs::foundation::PreparedStatement& stmt) {
+        statements.push_back(stmt.resolve());
+        return cgs::foundation::GameResult<uint64_t>::ok(1);
+    };
+    SqlUserRepository users(backend);
+
+    auto user = users.findByUsername("erin");
+    ASSERT_TRUE(user.has_value());
+    EXPECT_EQ(user->id, 7u);
+    EXPECT_EQ(user->status, UserStatus::Suspended);
+    EXPECT_EQ(user->roles, (std::vector<std::string>{"player", "admin"}));
+    EXPECT_EQ(user->createdAt.time_since_epoch(), std::chrono::milliseconds(1000));
+    EXPECT_NE(statements.back().find("WHERE username = 'erin'"), std::string::npos);
+
+    EXPECT_EQ(users.create(makeUser("erin")), 7u);
+    EXPECT_EQ(statements[1].rfind("INSERT INTO users", 0), 0u);
+    EXPECT_NE(statements[1].find("'player,tester'"), std::string::npos);
+
+    EXPECT_TRUE(users.update(*user));
+    EXPECT_NE(statements.back().find("WHERE id = 7"), std::string::npos);
+}
+
+TEST(SqlUserRepositoryTest, FailedReadIsAnError) {
+    UserStoreBackend backend;
+    backend.query = [](const cgs::foundation::PreparedStatement&) {
+        return cgs::foundation::GameResult<cgs::foundation::QueryResult>::err(
+            cgs::foundation::GameError(ErrorCode::QueryFailed, "down"));
+    };
+    backend.execute = [](const cgs::foundation::PreparedStatement&) {
+        return cgs::foundation::GameResult<uint64_t>::ok(0);
+    };
+    auto sql = std::make_shared<SqlUserRepository>(backend);
+    EXPECT_TRUE(sql->lookupByUsername("frank").hasError());
+
+    // The cache does not take a failed read for a free name.
+    CachedUserRepository users(sql);
+    EXPECT_TRUE(users.lookupByUsername("frank").hasError());
+    EXPECT_TRUE(users.lookupByUsername("frank").hasError());
+    EXPECT_EQ(users.missCount(), 2u);
+}
+
 // =============================================================================
 // Token store direct tests
 // =============================================================================
@@ -501,6 +887,76 @@ TEST_F(AuthServerTest, TokenStoreRevokeAllForUser) {
     EXPECT_TRUE(check2->revoked);
 }
 
+namespace {
+
+RefreshTokenRecord makeToken(std::string token,
+                             uint64_t userId,
+                             std::chrono::system_clock::duration ttl) {
+    RefreshTokenRecord record;
+    record.token = std::move(token);
+    record.userId = userId;
+    record.expiresAt = std::chrono::system_clock::now() + ttl;
+    return record;
+}
+
+}  // namespace
+
+TEST(InMemoryTokenStoreTest, RemoveExpiredKeepsLiveAndDropsRevoked) {
+    InMemoryTokenStore store(4);
+    for (int i = 0; i < 50; ++i) {
+        store.store(makeToken("old-" + std::to_string(i), 1, -std::chrono::minutes{i + 1}));
+        store.store(makeToken("live-" + std::to_string(i), 1, std::chrono::hours{1}));
+    }
+    EXPECT_TRUE(store.revoke("live-0"));
+    EXPECT_EQ(store.size(), 100u);
+
+    store.removeExpired();
+
+    EXPECT_EQ(store.size(), 49u);
+    EXPECT_FALSE(store.find("old-7").has_value());
+    EXPECT_FALSE(store.find("live-0").has_value());
+    auto live = store.find("live-1");
+    ASSERT_TRUE(live.has_value());
+    EXPECT_EQ(live->token, "live-1");
+    EXPECT_EQ(live->userId, 1u);
+    EXPECT_FALSE(live->revoked);
+}
+
+TEST(InMemoryTokenStoreTest, RevokeAllForUserLeavesOtherUsers) {
+    InMemoryTokenStore store(8);
+    for (int i = 0; i < 20; ++i) {
+        store.store(makeToken("a-" + std::to_string(i), 1, std::chrono::hours{1}));
+        store.store(makeToken("b-" + std::to_string(i), 2, std::chrono::hours{1}));
+    }
+
+    store.revokeAllForUser(1);
+
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_TRUE(store.find("a-" + std::to_string(i))->revoked);
+        EXPECT_FALSE(store.find("b-" + std::to_string(i))->revoked);
+    }
+    store.removeExpired();
+    EXPECT_EQ(store.size(), 20u);
+
+    // The user's index is rebuilt by new logins.
+    store.store(makeToken("a-new", 1, std::chrono::hours{1}));
+    store.revokeAllForUser(1);
+    EXPECT_TRUE(store.find("a-new")->revoked);
+}
+
+TEST(InMemoryTokenStoreTest, StoringATokenTwiceKeepsTheFirst) {
+    InMemoryTokenStore store(1);
+    store.store(makeToken("dup", 1, std::chrono::hours{1}));
+    store.store(makeToken("dup", 2, -std::chrono::hours{1}));
+
+    store.removeExpired();
+
+    auto record = store.find("dup");
+    ASSERT_TRUE(record.has_value());
+    EXPECT_EQ(record->userId, 1u);
+    EXPECT_EQ(store.size(), 1u);
+}
+
 // =============================================================================
 // Rate limiter direct tests
 // =============================================================================
@@ -537,6 +993,48 @@ TEST(RateLimiterTest, IndependentKeys) {
     EXPECT_TRUE(limiter.allow("key2"));
 }
 
+TEST(RateLimiterTest, BudgetReturnsGradually) {
+    RateLimiter limiter(2, std::chrono::seconds{1});
+    EXPECT_TRUE(limiter.allow("key1"));
+    EXPECT_TRUE(limiter.allow("key1"));
+    EXPECT_FALSE(limiter.allow("key1"));
+    EXPECT_EQ(limiter.remaining("key1"), 0u);
+
+    // One attempt's worth (window / maxAttempts) frees one slot.
+    std::this_thread::sleep_for(std::chrono::milliseconds{550});
+    EXPECT_EQ(limiter.remaining("key1"), 1u);
+    EXPECT_TRUE(limiter.allow("key1"));
+    EXPECT_FALSE(limiter.allow("key1"));
+}
+
+TEST(RateLimiterTest, TableIsBoundedWithLruEviction) {
+    RateLimiter limiter(1, std::chrono::seconds{60}, 16);
+    EXPECT_TRUE(limiter.allow("10.0.0.1"));
+    EXPECT_FALSE(limiter.allow("10.0.0.1"));
+
+    for (int i = 0; i < 10000; ++i) {
+        (void)limiter.allow("172.16." + std::to_string(i / 256) + "." + std::to_string(i % 256));
+    }
+    EXPECT_LE(limiter.trackedKeys(), 16u);
+
+    // The limited key was least recently used and has been evicted.
+    EXPECT_TRUE(limiter.allow("10.0.0.1"));
+}
+
+TEST(RateLimiterTest, AddressKeysAreCanonical) {
+    EXPECT_EQ(RateLimitKey::from("10.0.0.1"), RateLimitKey::from("::ffff:10.0.0.1"));
+    EXPECT_EQ(RateLimitKey::from("2001:db8::1"), RateLimitKey::from("2001:0DB8:0:0:0:0:0:1"));
+    EXPECT_NE(RateLimitKey::from("2001:db8::1"), RateLimitKey::from("2001:db8::2"));
+    EXPECT_EQ(RateLimitKey::from("::1").low, 1u);
+    EXPECT_NE(RateLimitKey::from("10.0.0.256"), RateLimitKey::from("10.0.0.0"));
+
+    RateLimiter limiter(1, std::chrono::seconds{60});
+    EXPECT_TRUE(limiter.allow("10.0.0.1"));
+    EXPECT_FALSE(limiter.allow("::ffff:10.0.0.1"));
+    EXPECT_TRUE(limiter.allow("not-an-address"));
+    EXPECT_FALSE(limiter.allow("not-an-address"));
+}
+
 // =============================================================================
 // Full auth flow integration test
 // =============================================================================
@@ -3,9 +3,15 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
 #include <string>
 #include <thread>
+#include <variant>
 #include <vector>
 
 #include "cgs/foundation/error_code.hpp"
@@ -14,6 +20,12 @@
 #include "cgs/service/dbproxy_server.hpp"
 #include "cgs/service/dbproxy_types.hpp"
 #include "cgs/service/query_cache.hpp"
+#include "cgs/service/query_shape_registry.hpp"
+#include "cgs/service/read_coalescer.hpp"
+#include "cgs/service/replica_balancer.hpp"
+#include "cgs/service/shared_result_cache.hpp"
+#include "cgs/service/sql_normalizer.hpp"
+#include "cgs/service/write_combiner.hpp"
 
 using namespace cgs::service;
 using namespace cgs::foundation;
@@ -30,6 +42,9 @@ TEST(DBProxyTypesTest, DBEndpointConfigDefaults) {
     EXPECT_EQ(config.minConnections, 2u);
     EXPECT_EQ(config.maxConnections, 10u);
     EXPECT_EQ(config.connectionTimeout.count(), 30);
+    EXPECT_EQ(config.growAfterWait.count(), 0);
+    EXPECT_EQ(config.idleTimeout.count(), 0);
+    EXPECT_EQ(config.maxLifetime.count(), 0);
 }
 
 TEST(DBProxyTypesTest, CacheConfigDefaults) {
@@ -38,6 +53,10 @@ TEST(DBProxyTypesTest, CacheConfigDefaults) {
     EXPECT_EQ(config.maxEntries, 10000u);
     EXPECT_EQ(config.defaultTtl.count(), 300);
     EXPECT_EQ(config.maxValueSizeBytes, 1048576u);
+    EXPECT_EQ(config.shards, 16u);
+    EXPECT_EQ(config.maxTotalBytes, 268435456u);
+    EXPECT_TRUE(config.admissionFilter);
+    EXPECT_TRUE(config.tableQuotaBytes.empty());
 }
 
 TEST(DBProxyTypesTest, DBProxyConfigDefaults) {
@@ -45,6 +64,21 @@ TEST(DBProxyTypesTest, DBProxyConfigDefaults) {
     EXPECT_TRUE(config.replicas.empty());
     EXPECT_TRUE(config.cache.enabled);
     EXPECT_EQ(config.healthCheckInterval.count(), 30);
+    EXPECT_EQ(config.poolMaintenanceInterval.count(), 1000);
+    EXPECT_TRUE(config.coalesceReads);
+    EXPECT_FALSE(config.trackReplicationLag);
+    EXPECT_EQ(config.lagProbeInterval.count(), 1000);
+    EXPECT_EQ(config.maxReplicaLag.count(), 5000);
+    EXPECT_EQ(config.readYourWritesWindow.count(), 0);
+    EXPECT_FALSE(config.writeBatch.enabled);
+    EXPECT_EQ(config.writeBatch.window.count(), 2);
+    EXPECT_EQ(config.writeBatch.maxStatements, 64u);
+    EXPECT_TRUE(config.normalizeQueries);
+    EXPECT_FALSE(config.prepareQueries);
+    EXPECT_EQ(config.maxQueryShapes, 1024u);
+    EXPECT_EQ(config.sharedCache.keyPrefix, "cgs:dbproxy:");
+    EXPECT_EQ(config.sharedCache.ttl.count(), 300);
+    EXPECT_EQ(config.sharedCache.maxValueSizeBytes, 1048576u);
 }
 
 TEST(DBProxyTypesTest, PoolStatsDefaults) {
@@ -56,6 +90,21 @@ TEST(DBProxyTypesTest, PoolStatsDefaults) {
     EXPECT_EQ(stats.replicaCount, 0u);
     EXPECT_EQ(stats.cacheEntries, 0u);
     EXPECT_DOUBLE_EQ(stats.cacheHitRate, 0.0);
+    EXPECT_EQ(stats.cacheBytes, 0u);
+    EXPECT_EQ(stats.cacheRejected, 0u);
+    EXPECT_EQ(stats.coalescedReads, 0u);
+    EXPECT_EQ(stats.sharedCacheHits, 0u);
+    EXPECT_EQ(stats.sharedCacheMisses, 0u);
+    EXPECT_EQ(stats.sharedCacheStale, 0u);
+    EXPECT_TRUE(stats.cacheTableBytes.empty());
+    EXPECT_EQ(stats.pinnedReads, 0u);
+    EXPECT_EQ(stats.streams, 0u);
+    EXPECT_EQ(stats.streamedRows, 0u);
+    EXPECT_TRUE(stats.replicas.empty());
+    EXPECT_EQ(stats.writeGroups, 0u);
+    EXPECT_EQ(stats.combinedWrites, 0u);
+    EXPECT_EQ(stats.primaryPool.checkouts, 0u);
+    EXPECT_EQ(stats.replicaPool.opened, 0u);
 }
 
 // ============================================================================
@@ -163,6 +212,140 @@ TEST_F(QueryCacheTest, LruPromotionOnGet) {
     EXPECT_TRUE(smallCache.get("q4").has_value());
 }
 
+TEST_F(QueryCacheTest, ExpiredEntryEvictedDespiteReference) {
+    CacheConfig small;
+    small.maxEntries = 2;
+    small.defaultTtl = 300s;
+    QueryCache smallCache(small);
+
+    smallCache.put("q1", makeResult(1));
+    smallCache.put("q2", makeResult(1));
+    (void)smallCache.get("q1");
+    (void)smallCache.get("q2");
+    smallCache.put("q1", makeResult(1), 0s);  // Referenced, but expiring.
+    std::this_thread::sleep_for(1ms);
+
+    smallCache.put("q3", makeResult(1));
+    EXPECT_EQ(smallCache.size(), 2u);
+    EXPECT_FALSE(smallCache.get("q1").has_value());
+    EXPECT_TRUE(smallCache.get("q2").has_value());
+    EXPECT_TRUE(smallCache.get("q3").has_value());
+}
+
+TEST_F(QueryCacheTest, ByteBudgetBoundsTotalSize) {
+    const auto entryBytes = makeResult(20).memoryBytes() + std::string("q1").size();
+    CacheConfig small;
+    small.maxEntries = 100;
+    small.maxTotalBytes = entryBytes * 5 / 2;  // Room for two entries.
+    QueryCache smallCache(small);
+
+    for (int i = 1; i <= 5; ++i) {
+        smallCache.put("q" + std::to_string(i), makeResult(20));
+        EXPECT_LE(smallCache.bytes(), small.maxTotalBytes);
+    }
+    EXPECT_EQ(smallCache.size(), 2u);
+    EXPECT_EQ(smallCache.bytes(), 2 * entryBytes);
+    EXPECT_TRUE(smallCache.get("q5").has_value());
+
+    smallCache.clear();
+    EXPECT_EQ(smallCache.bytes(), 0u);
+}
+
+TEST_F(QueryCacheTest, OversizedValueNotCached) {
+    CacheConfig small;
+    small.maxValueSizeBytes = makeResult(10).memoryBytes();
+    QueryCache smallCache(small);
+
+    smallCache.put("SELECT * FROM logs", makeResult(100));
+    EXPECT_EQ(smallCache.size(), 0u);
+    EXPECT_EQ(smallCache.rejectedCount(), 1u);
+
+    smallCache.put("SELECT 1", makeResult(1));
+    EXPECT_EQ(smallCache.size(), 1u);
+}
+
+TEST_F(QueryCacheTest, AdmissionKeepsHotEntriesFromScans) {
+    for (const bool filter : {true, false}) {
+        CacheConfig small;
+        small.maxEntries = 3;
+        small.admissionFilter = filter;
+        QueryCache smallCache(small);
+
+        for (const char* hot : {"h1", "h2", "h3"}) {
+            smallCache.put(hot, makeResult(1));
+            for (int i = 0; i < 3; ++i) {
+                (void)smallCache.get(hot);
+            }
+        }
+        // A scan: each query missed once, then stored.
+        for (int i = 0; i < 10; ++i) {
+            const auto sql = "SELECT * FROM logs WHERE id = " + std::to_string(i);
+            EXPECT_FALSE(smallCache.get(sql).has_value());
+            smallCache.put(sql, makeResult(1));
+        }
+
+        EXPECT_EQ(smallCache.get("h1").has_value(), filter);
+        EXPECT_EQ(smallCache.get("h2").has_value(), filter);
+        EXPECT_EQ(smallCache.get("h3").has_value(), filter);
+        EXPECT_EQ(smallCache.rejectedCount(), filter ? 10u : 0u);
+    }
+}
+
+TEST_F(QueryCacheTest, AdmissionLetsRepeatedQueriesIn) {
+    CacheConfig small;
+    small.maxEntries = 1;
+    QueryCache smallCache(small);
+
+    smallCache.put("SELECT * FROM players", makeResult(1));
+    (void)smallCache.get("SELECT * FROM players");
+
+    // Looked up more often than the cached entry, so it is admitted.
+    for (int i = 0; i < 2; ++i) {
+        (void)smallCache.get("SELECT * FROM items");
+    }
+    smallCache.put("SELECT * FROM items", makeResult(1));
+    EXPECT_TRUE(smallCache.get("SELECT * FROM items").has_value());
+    EXPECT_EQ(smallCache.rejectedCount(), 0u);
+}
+
+TEST_F(QueryCacheTest, TableQuotaCapsTableBytes) {
+    auto sql = [](int id) { return "SELECT * FROM items WHERE id = " + std::to_string(id); };
+    const auto entryBytes = makeResult(5).memoryBytes() + sql(10).size();
+    CacheConfig quota;
+    quota.tableQuotaBytes["Items"] = entryBytes * 3;
+    QueryCache quotaCache(quota);
+
+    for (int id = 10; id < 20; ++id) {
+        quotaCache.put(sql(id), makeResult(5));
+    }
+    quotaCache.put("SELECT * FROM players", makeResult(5));
+
+    auto usage = quotaCache.tableBytes();
+    ASSERT_EQ(usage.size(), 1u);
+    EXPECT_EQ(usage["items"], entryBytes * 3);
+    EXPECT_EQ(quotaCache.size(), 4u);
+    EXPECT_TRUE(quotaCache.get("SELECT * FROM players").has_value());
+
+    EXPECT_EQ(quotaCache.invalidateByTable("items"), 3u);
+    EXPECT_EQ(quotaCache.tableBytes()["items"], 0u);
+}
+
+TEST_F(QueryCacheTest, ShardedCacheHoldsMaxEntries) {
+    CacheConfig sharded;
+    sharded.maxEntries = 1024;
+    sharded.shards = 16;
+    QueryCache shardedCache(sharded);
+
+    for (int i = 0; i < 4000; ++i) {
+        shardedCache.put("SELECT * FROM items WHERE id = " + std::to_string(i), makeResult(1));
+    }
+    EXPECT_EQ(shardedCache.size(), 1024u);
+    EXPECT_TRUE(shardedCache.get("SELECT * FROM items WHERE id = 3999").has_value());
+
+    EXPECT_EQ(shardedCache.invalidateByTable("items"), 1024u);
+    EXPECT_EQ(shardedCache.size(), 0u);
+}
+
 TEST_F(QueryCacheTest, TtlExpiration) {
     CacheConfig shortTtl;
     shortTtl.maxEntries = 100;
@@ -224,6 +407,40 @@ TEST_F(QueryCacheTest, InvalidateByTableCaseInsensitive) {
     EXPECT_EQ(cache_->size(), 0u);
 }
 
+TEST_F(QueryCacheTest, InvalidateByTableFollowsJoinsAndFromLists) {
+    cache_->put("SELECT * FROM players p JOIN guilds g ON p.guild = g.id", makeResult(1));
+    cache_->put("SELECT * FROM items, `game`.`Inventories` WHERE 1", makeResult(1));
+    cache_->put("SELECT * FROM (SELECT id FROM quests) q", makeResult(1));
+
+    EXPECT_EQ(cache_->invalidateByTable("guilds"), 1u);
+    EXPECT_EQ(cache_->invalidateByTable("inventories"), 1u);
+    EXPECT_EQ(cache_->invalidateByTable("quests"), 1u);
+    EXPECT_EQ(cache_->size(), 0u);
+}
+
+TEST_F(QueryCacheTest, InvalidateByTableMatchesWholeNames) {
+    cache_->put("SELECT * FROM items_archive", makeResult(1));
+    cache_->put("SELECT 'items' FROM players", makeResult(1));
+
+    EXPECT_EQ(cache_->invalidateByTable("items"), 0u);
+    EXPECT_EQ(cache_->size(), 2u);
+}
+
+TEST_F(QueryCacheTest, EvictedEntriesLeaveTableIndex) {
+    CacheConfig config;
+    config.maxEntries = 2;
+    QueryCache cache(config);
+
+    cache.put("SELECT * FROM items WHERE id = 1", makeResult(1));
+    cache.put("SELECT * FROM items WHERE id = 2", makeResult(1));
+    cache.put("SELECT * FROM players", makeResult(1));  // Evicts id = 1.
+    EXPECT_TRUE(cache.invalidate("SELECT * FROM players"));
+
+    EXPECT_EQ(cache.invalidateByTable("items"), 1u);
+    EXPECT_EQ(cache.invalidateByTable("players"), 0u);
+    EXPECT_EQ(cache.size(), 0u);
+}
+
 TEST_F(QueryCacheTest, Clear) {
     cache_->put("q1", makeResult(1));
     cache_->put("q2", makeResult(2));
@@ -291,6 +508,42 @@ TEST_F(QueryCacheTest, ConcurrentAccess) {
     EXPECT_GT(cache_->hitCount(), 0u);
 }
 
+TEST_F(QueryCacheTest, ConcurrentHitsAndInvalidation) {
+    CacheConfig sharded;
+    sharded.maxEntries = 4096;
+    QueryCache shardedCache(sharded);
+    for (int i = 0; i < 64; ++i) {
+        shardedCache.put("SELECT * FROM items WHERE id = " + std::to_string(i), makeResult(1));
+    }
+
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&]() {
+            while (!stop.load()) {
+                for (int i = 0; i < 64; ++i) {
+                    auto hit = shardedCache.get("SELECT * FROM items WHERE id = " +
+                                                std::to_string(i));
+                    if (hit) {
+                        EXPECT_EQ(hit->size(), 1u);
+                    }
+                }
+            }
+        });
+    }
+    for (int round = 0; round < 50; ++round) {
+        (void)shardedCache.invalidateByTable("items");
+        for (int i = 0; i < 64; ++i) {
+            shardedCache.put("SELECT * FROM items WHERE id = " + std::to_string(i), makeResult(1));
+        }
+    }
+    stop = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(shardedCache.size(), 64u);
+}
+
 // ============================================================================
 // SQL Helper Tests (via DBProxyServer behavior)
 // ============================================================================
@@ -436,6 +689,707 @@ TEST(SqlInjectionTest, BackslashNotSpecial) {
     EXPECT_EQ(stmt.resolve(), "SELECT * FROM t WHERE path = 'C:\\Users\\test'");
 }
 
+// ============================================================================
+// ReadCoalescer Tests
+// ============================================================================
+
+namespace {
+
+QueryResult singleRow(std::int64_t id) {
+    QueryResult result({"id"});
+    result.set(result.addRow(), 0, id);
+    return result;
+}
+
+/// Spin until @p done holds (bounded, so a broken test fails instead of
+/// hanging).
+template <typename Pred>
+bool waitFor(Pred done) {
+    for (int i = 0; i < 5000 && !done(); ++i) {
+        std::this_thread::sleep_for(1ms);
+    }
+    return done();
+}
+
+}  // anonymous namespace
+
+TEST(ReadCoalescerTest, NormalizeCollapsesWhitespaceOutsideLiterals) {
+    EXPECT_EQ(ReadCoalescer::normalize("  SELECT *\n  FROM\titems  "), "SELECT * FROM items");
+    EXPECT_EQ(ReadCoalescer::normalize("SELECT 'a  b' FROM t"), "SELECT 'a  b' FROM t");
+    EXPECT_EQ(ReadCoalescer::normalize("SELECT 'it''s  ok'   FROM t"), "SELECT 'it''s  ok' FROM t");
+}
+
+TEST(ReadCoalescerTest, ConcurrentReadsShareOneFetch) {
+    std::atomic<int> stores{0};
+    ReadCoalescer flights({}, [&](std::string_view, const QueryResult&) { ++stores; });
+
+    std::atomic<int> fetches{0};
+    std::atomic<bool> release{false};
+    auto fetch = [&] {
+        ++fetches;
+        while (!release.load()) {
+            std::this_thread::sleep_for(1ms);
+        }
+        return ReadCoalescer::Result::ok(singleRow(7));
+    };
+
+    constexpr int kReaders = 8;
+    std::vector<std::thread> threads;
+    std::atomic<int> served{0};
+    auto reader = [&](const char* sql) {
+        auto result = flights.read(sql, fetch);
+        if (result.hasValue() && result.value()[0].getInt("id") == 7) {
+            ++served;
+        }
+    };
+    threads.emplace_back(reader, "SELECT * FROM guilds WHERE id = 7");
+    ASSERT_TRUE(waitFor([&] { return fetches.load() == 1; }));
+    for (int i = 1; i < kReaders; ++i) {
+        threads.emplace_back(reader, "SELECT *  FROM guilds\nWHERE id = 7");
+    }
+    ASSERT_TRUE(waitFor([&] { return flights.coalescedCount() == kReaders - 1; }));
+    release.store(true);
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(fetches.load(), 1);
+    EXPECT_EQ(served.load(), kReaders);
+    EXPECT_EQ(stores.load(), 1);
+    EXPECT_EQ(flights.inFlight(), 0u);
+}
+
+TEST(ReadCoalescerTest, AsyncReadsJoinWithoutPosting) {
+    std::vector<std::function<void()>> jobs;
+    ReadCoalescer flights(
+        [&](std::function<void()> job) {
+            jobs.push_back(std::move(job));
+            return true;
+        },
+        {});
+
+    int fetches = 0;
+    std::vector<std::int64_t> ids;
+    for (int i = 0; i < 3; ++i) {
+        flights.readAsync(
+            "SELECT * FROM instances WHERE id = 3",
+            [&] {
+                ++fetches;
+                return ReadCoalescer::Result::ok(singleRow(3));
+            },
+            [&](ReadCoalescer::Result result) {
+                ids.push_back(result.value()[0].getInt("id").value_or(0));
+            });
+    }
+    ASSERT_EQ(jobs.size(), 1u);
+    EXPECT_EQ(flights.coalescedCount(), 2u);
+
+    jobs.front()();
+    EXPECT_EQ(fetches, 1);
+    EXPECT_EQ(ids, (std::vector<std::int64_t>{3, 3, 3}));
+    EXPECT_EQ(flights.inFlight(), 0u);
+}
+
+TEST(ReadCoalescerTest, WriteDetachesReadsInFlight) {
+    std::vector<std::function<void()>> jobs;
+    std::vector<std::string> stored;
+    ReadCoalescer flights(
+        [&](std::function<void()> job) {
+            jobs.push_back(std::move(job));
+            return true;
+        },
+        [&](std::string_view sql, const QueryResult&) { stored.emplace_back(sql); });
+
+    auto fetch = [] { return ReadCoalescer::Result::ok(singleRow(1)); };
+    int done = 0;
+    auto onDone = [&](ReadCoalescer::Result) { ++done; };
+
+    flights.readAsync("SELECT * FROM Items i JOIN bags b ON i.bag = b.id", fetch, onDone);
+    EXPECT_EQ(flights.invalidateTable("players"), 0u);
+    EXPECT_EQ(flights.invalidateTable("`game`.`bags`"), 1u);
+    EXPECT_EQ(flights.inFlight(), 0u);
+
+    // A read after the write does not join the detached one.
+    flights.readAsync("SELECT * FROM Items i JOIN bags b ON i.bag = b.id", fetch, onDone);
+    ASSERT_EQ(jobs.size(), 2u);
+    EXPECT_EQ(flights.coalescedCount(), 0u);
+
+    jobs[0]();
+    EXPECT_TRUE(stored.empty());  // Possibly stale: not cached.
+    jobs[1]();
+    EXPECT_EQ(stored.size(), 1u);
+    EXPECT_EQ(done, 2);
+}
+
+TEST(ReadCoalescerTest, ErrorsReachEveryWaiter) {
+    ReadCoalescer flights({}, [](std::string_view, const QueryResult&) { FAIL(); });
+
+    int errors = 0;
+    flights.readAsync(
+        "SELECT 1",
+        [] {
+            return ReadCoalescer::Result::err(GameError(ErrorCode::DBProxyError, "replica down"));
+        },
+        [&](ReadCoalescer::Result result) { errors += result.hasError() ? 1 : 0; });
+    EXPECT_EQ(errors, 1);  // No executor: ran inline.
+    EXPECT_EQ(flights.inFlight(), 0u);
+}
+
+// ============================================================================
+// SharedResultCache Tests
+// ============================================================================
+
+TEST(SharedResultCacheTest, EncodingRoundTripsEveryCellType) {
+    QueryResult result({"id", "name", "score", "active", "note"});
+    for (std::int64_t i = 0; i < 3; ++i) {
+        const auto row = result.addRow();
+        result.set(row, 0, i == 1 ? -i * 1000000007 : i);
+        result.set(row, 1, "player" + std::to_string(i));
+        result.set(row, 2, 0.5 * static_cast<double>(i));
+        result.set(row, 3, i % 2 == 0);
+    }
+
+    auto decoded = decodeQueryResult(encodeQueryResult(result));
+    ASSERT_TRUE(decoded.has_value());
+    ASSERT_EQ(decoded->size(), 3u);
+    EXPECT_EQ(decoded->columnNames(), result.columnNames());
+    for (std::size_t r = 0; r < 3; ++r) {
+        for (std::size_t c = 0; c < 5; ++c) {
+            EXPECT_EQ(decoded->isNull(r, c), result.isNull(r, c));
+            EXPECT_EQ(decoded->getInt(r, c), result.getInt(r, c));
+            EXPECT_EQ(decoded->getString(r, c), result.getString(r, c));
+            EXPECT_EQ(decoded->getDouble(r, c), result.getDouble(r, c));
+            EXPECT_EQ(decoded->getBool(r, c), result.getBool(r, c));
+        }
+    }
+    EXPECT_EQ(decoded->getInt(1, 0), -1000000007);
+    EXPECT_TRUE(decoded->isNull(2, 4));
+}
+
+TEST(SharedResultCacheTest, EncodingRoundTripsEmptyResult) {
+    auto decoded = decodeQueryResult(encodeQueryResult(QueryResult({"id"})));
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_TRUE(decoded->empty());
+    EXPECT_EQ(decoded->columnCount(), 1u);
+}
+
+TEST(SharedResultCacheTest, MalformedEncodingRejected) {
+    const auto bytes = encodeQueryResult(singleRow(42));
+    EXPECT_FALSE(decodeQueryResult("").has_value());
+    EXPECT_FALSE(decodeQueryResult(bytes.substr(0, bytes.size() - 1)).has_value());
+    EXPECT_FALSE(decodeQueryResult(bytes + "x").has_value());
+    EXPECT_FALSE(decodeQueryResult("\x02" + bytes.substr(1)).has_value());
+}
+
+TEST(SharedResultCacheTest, MissThenHit) {
+    auto store = std::make_shared<InMemorySharedResultStore>();
+    SharedResultCache l2(SharedCacheConfig{}, store);
+    const std::string sql = "SELECT * FROM items WHERE id = 1";
+
+    auto miss = l2.lookup(sql);
+    EXPECT_FALSE(miss.result.has_value());
+    l2.put(sql, miss.stamp, singleRow(1));
+
+    auto hit = l2.lookup(sql);
+    ASSERT_TRUE(hit.result.has_value());
+    EXPECT_EQ(hit.result->front().getInt("id"), 1);
+    EXPECT_EQ(l2.hitCount(), 1u);
+    EXPECT_EQ(l2.missCount(), 1u);
+    EXPECT_EQ(l2.putCount(), 1u);
+}
+
+TEST(SharedResultCacheTest, TableWriteOnOneInstanceRetiresEntriesOnAll) {
+    auto store = std::make_shared<InMemorySharedResultStore>();
+    SharedResultCache nodeA(SharedCacheConfig{}, store);
+    SharedResultCache nodeB(SharedCacheConfig{}, store);
+    const std::string items = "SELECT * FROM items WHERE id = 1";
+    const std::string guilds = "SELECT * FROM guilds WHERE id = 1";
+
+    nodeA.put(items, nodeA.lookup(items).stamp, singleRow(1));
+    nodeA.put(guilds, nodeA.lookup(guilds).stamp, singleRow(2));
+    EXPECT_TRUE(nodeB.lookup(items).result.has_value());
+
+    nodeB.invalidateTable("Items");
+    EXPECT_FALSE(nodeA.lookup(items).result.has_value());
+    EXPECT_EQ(nodeA.staleCount(), 1u);
+    EXPECT_TRUE(nodeA.lookup(guilds).result.has_value());
+}
+
+TEST(SharedResultCacheTest, ResultReadBeforeConcurrentWriteIsNotServed) {
+    auto store = std::make_shared<InMemorySharedResultStore>();
+    SharedResultCache l2(SharedCacheConfig{}, store);
+    const std::string sql = "SELECT * FROM items";
+
+    auto miss = l2.lookup(sql);
+    l2.invalidateTable("items");  // Write lands while the miss is fetched
+    l2.put(sql, miss.stamp, singleRow(1));
+    EXPECT_FALSE(l2.lookup(sql).result.has_value());
+
+    auto again = l2.lookup(sql);
+    l2.put(sql, again.stamp, singleRow(2));
+    auto hit = l2.lookup(sql);
+    ASSERT_TRUE(hit.result.has_value());
+    EXPECT_EQ(hit.result->front().getInt("id"), 2);
+}
+
+TEST(SharedResultCacheTest, OversizedResultNotStored) {
+    auto store = std::make_shared<InMemorySharedResultStore>();
+    SharedCacheConfig config;
+    config.maxValueSizeBytes = 16;
+    SharedResultCache l2(config, store);
+    QueryResult big({"text"});
+    big.set(big.addRow(), 0, std::string(64, 'x'));
+
+    l2.put("SELECT * FROM t", "", big);
+    EXPECT_EQ(l2.putCount(), 0u);
+    EXPECT_EQ(store->size(), 0u);
+}
+
+TEST(SharedResultCacheTest, StoreExpiresValues) {
+    InMemorySharedResultStore store;
+    store.set("k", "v", 0s);
+    EXPECT_FALSE(store.getMany({"k"})[0].has_value());
+    EXPECT_EQ(store.increment("c"), 1u);
+    EXPECT_EQ(store.increment("c"), 2u);
+    EXPECT_EQ(store.getMany({"c"})[0], "2");
+}
+
+// ============================================================================
+// ReplicaBalancer Tests
+// ============================================================================
+
+namespace {
+
+bool anyReplica(std::size_t) {
+    return true;
+}
+
+void timedRead(ReplicaBalancer& balancer,
+               std::size_t replica,
+               std::chrono::nanoseconds latency,
+               bool ok = true) {
+    balancer.begin(replica);
+    balancer.finish(replica, latency, ok);
+}
+
+}  // anonymous namespace
+
+TEST(ReplicaBalancerTest, SlowestReplicaNeverPicked) {
+    ReplicaBalancer balancer(3);
+    timedRead(balancer, 0, 2ms);
+    timedRead(balancer, 1, 2ms);
+    timedRead(balancer, 2, 200ms);
+
+    // Any pair sampled holds a faster replica than 2.
+    for (int i = 0; i < 200; ++i) {
+        EXPECT_NE(balancer.pick(anyReplica), 2u);
+    }
+}
+
+TEST(ReplicaBalancerTest, OutstandingReadsSpreadLoad) {
+    ReplicaBalancer balancer(2);
+    for (int i = 0; i < 4; ++i) {
+        balancer.begin(0);
+    }
+
+    // Equal latency: the idle replica wins every sample.
+    for (int i = 0; i < 50; ++i) {
+        EXPECT_EQ(balancer.pick(anyReplica), 1u);
+    }
+    EXPECT_GT(balancer.score(0), balancer.score(1));
+}
+
+TEST(ReplicaBalancerTest, PickHonorsUsable) {
+    ReplicaBalancer balancer(4);
+    timedRead(balancer, 2, 500ms);
+
+    for (int i = 0; i < 50; ++i) {
+        EXPECT_EQ(balancer.pick([](std::size_t r) { return r == 2; }), 2u);
+    }
+    EXPECT_EQ(balancer.pick([](std::size_t) { return false; }), ReplicaBalancer::npos);
+
+    ReplicaBalancer none(0);
+    EXPECT_EQ(none.pick(anyReplica), ReplicaBalancer::npos);
+}
+
+TEST(ReplicaBalancerTest, FailuresPenalizeReplica) {
+    ReplicaBalancer balancer(2);
+    timedRead(balancer, 0, 1ms, false);
+    timedRead(balancer, 1, 5ms);
+
+    EXPECT_GT(balancer.score(0), balancer.score(1));
+    for (int i = 0; i < 50; ++i) {
+        EXPECT_EQ(balancer.pick(anyReplica), 1u);
+    }
+}
+
+TEST(ReplicaBalancerTest, IdleCostDecays) {
+    ReplicaBalancer balancer(1, 10ms);
+    timedRead(balancer, 0, 100ms);
+    const double before = balancer.score(0);
+
+    std::this_thread::sleep_for(50ms);
+    EXPECT_LT(balancer.score(0), before / 10);
+}
+
+TEST(ReplicaBalancerTest, StatsReportCountersAndLag) {
+    ReplicaBalancer balancer(2);
+    timedRead(balancer, 0, 3ms);
+    timedRead(balancer, 0, 3ms, false);
+    balancer.begin(1);
+    balancer.setLag(1, 250ms);
+
+    EXPECT_EQ(balancer.lag(1), 250ms);
+    EXPECT_EQ(balancer.lag(0), 0ms);
+
+    auto stats = balancer.stats();
+    ASSERT_EQ(stats.size(), 2u);
+    EXPECT_EQ(stats[0].reads, 2u);
+    EXPECT_EQ(stats[0].failures, 1u);
+    EXPECT_EQ(stats[0].inFlight, 0u);
+    EXPECT_GT(stats[0].latencyMs, 0.0);
+    EXPECT_EQ(stats[1].reads, 1u);
+    EXPECT_EQ(stats[1].inFlight, 1u);
+    EXPECT_DOUBLE_EQ(stats[1].lagMs, 250.0);
+    EXPECT_FALSE(stats[1].connected);
+}
+
+TEST(ReplicaBalancerTest, ConcurrentPicksAndCompletions) {
+    ReplicaBalancer balancer(3);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 2000; ++i) {
+                auto r = balancer.pick(anyReplica);
+                timedRead(balancer, r, std::chrono::microseconds(50 * (r + 1)));
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+
+    uint64_t reads = 0;
+    for (const auto& replica : balancer.stats()) {
+        EXPECT_EQ(replica.inFlight, 0u);
+        reads += replica.reads;
+    }
+    EXPECT_EQ(reads, 8000u);
+}
+
+// ============================================================================
+// WriteCombiner Tests
+// ============================================================================
+
+namespace {
+
+/// The id a test write updates, "... WHERE id = N".
+uint64_t writeId(const std::string& sql) {
+    return std::stoull(sql.substr(sql.rfind('=') + 1));
+}
+
+std::string writeFor(uint64_t id) {
+    return "UPDATE players SET gold = 0 WHERE id = " + std::to_string(id);
+}
+
+}  // anonymous namespace
+
+TEST(WriteCombinerTest, CombinableWrites) {
+    EXPECT_TRUE(WriteCombiner::combinable("INSERT INTO items VALUES (1)"));
+    EXPECT_TRUE(WriteCombiner::combinable("  update players SET gold = 1;  "));
+    EXPECT_TRUE(WriteCombiner::combinable("DELETE FROM auras WHERE id = 3"));
+
+    EXPECT_FALSE(WriteCombiner::combinable("SELECT * FROM items"));
+    EXPECT_FALSE(WriteCombiner::combinable("CREATE TABLE t (id INT)"));
+    EXPECT_FALSE(WriteCombiner::combinable("UPDATEX SET a = 1"));
+    EXPECT_FALSE(WriteCombiner::combinable("UPDATE a SET b = 1; COMMIT"));
+    EXPECT_FALSE(WriteCombiner::combinable(""));
+}
+
+TEST(WriteCombinerTest, ConcurrentWritesShareOneCommit) {
+    constexpr int kWriters = 8;
+    std::mutex mutex;
+    std::vector<std::size_t> groups;
+    WriteBatchConfig config;
+    config.window = std::chrono::milliseconds(5000);  // Closed by maxStatements.
+    config.maxStatements = kWriters;
+    WriteCombiner writes(config, [&](const std::vector<std::string>& statements) {
+        {
+            std::lock_guard lock(mutex);
+            groups.push_back(statements.size());
+        }
+        std::vector<WriteCombiner::Result> results;
+        for (const auto& sql : statements) {
+            results.push_back(WriteCombiner::Result::ok(writeId(sql)));
+        }
+        return results;
+    });
+
+    std::atomic<int> matched{0};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kWriters; ++i) {
+        threads.emplace_back([&, id = static_cast<uint64_t>(i + 1)] {
+            auto result = writes.execute(writeFor(id));
+            if (result.hasValue() && result.value() == id) {
+                matched.fetch_add(1);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(matched.load(), kWriters);  // Each caller got its own result.
+    ASSERT_EQ(groups.size(), 1u);
+    EXPECT_EQ(groups.front(), static_cast<std::size_t>(kWriters));
+    EXPECT_EQ(writes.groupCount(), 1u);
+    EXPECT_EQ(writes.combinedCount(), static_cast<uint64_t>(kWriters));
+}
+
+TEST(WriteCombinerTest, LoneWriteCommitsAfterWindow) {
+    WriteBatchConfig config;
+    config.window = std::chrono::milliseconds(1);
+    std::size_t commits = 0;
+    WriteCombiner writes(config, [&](const std::vector<std::string>& statements) {
+        ++commits;
+        return std::vector<WriteCombiner::Result>(statements.size(),
+                                                  WriteCombiner::Result::ok(1));
+    });
+
+    auto result = writes.execute(writeFor(1));
+    ASSERT_TRUE(result.hasValue());
+    EXPECT_EQ(result.value(), 1u);
+    EXPECT_EQ(commits, 1u);
+    EXPECT_EQ(writes.groupCount(), 0u);  // A group of one is not combined.
+}
+
+TEST(WriteCombinerTest, FailureReachesOnlyItsCaller) {
+    WriteBatchConfig config;
+    config.window = std::chrono::milliseconds(5000);
+    config.maxStatements = 2;
+    WriteCombiner writes(config, [](const std::vector<std::string>& statements) {
+        std::vector<WriteCombiner::Result> results;
+        for (const auto& sql : statements) {
+            results.push_back(writeId(sql) == 2 ? WriteCombiner::Result::err(GameError(
+                                                      ErrorCode::DBProxyError, "constraint"))
+                                                : WriteCombiner::Result::ok(1));
+        }
+        return results;
+    });
+
+    bool firstOk = false;
+    std::thread first([&] { firstOk = writes.execute(writeFor(1)).hasValue(); });
+    auto second = writes.execute(writeFor(2));
+    first.join();
+
+    EXPECT_TRUE(firstOk);
+    EXPECT_TRUE(second.hasError());
+}
+
+TEST(WriteCombinerTest, ThrowingCommitFailsTheGroup) {
+    WriteCombiner writes({}, [](const std::vector<std::string>&) {
+        throw std::runtime_error("primary down");
+        return std::vector<WriteCombiner::Result>{};
+    });
+
+    auto result = writes.execute(writeFor(1));
+    ASSERT_TRUE(result.hasError());
+    EXPECT_EQ(result.error().code(), ErrorCode::DBProxyError);
+}
+
+TEST(WriteCombinerTest, SequentialGroupsUnderLoad) {
+    WriteBatchConfig config;
+    config.window = std::chrono::milliseconds(1);
+    config.maxStatements = 4;
+    std::atomic<uint64_t> committed{0};
+    WriteCombiner writes(config, [&](const std::vector<std::string>& statements) {
+        committed.fetch_add(statements.size());
+        std::vector<WriteCombiner::Result> results;
+        for (const auto& sql : statements) {
+            results.push_back(WriteCombiner::Result::ok(writeId(sql)));
+        }
+        return results;
+    });
+
+    std::atomic<int> mismatches{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 200; ++i) {
+                const auto id = static_cast<uint64_t>(t * 1000 + i);
+                auto result = writes.execute(writeFor(id));
+                if (!result.hasValue() || result.value() != id) {
+                    mismatches.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+
+    EXPECT_EQ(mismatches.load(), 0);
+    EXPECT_EQ(committed.load(), 800u);
+    EXPECT_LE(writes.combinedCount(), 800u);
+}
+
+// ============================================================================
+// SQL Normalizer Tests
+// ============================================================================
+
+TEST(SqlNormalizerTest, LiteralsBecomePlaceholders) {
+    auto n = normalizeSql("SELECT * FROM players WHERE id = 42 AND name = 'O''Brien'");
+    EXPECT_EQ(n.shape, "select * from players where id = $_1 and name = $_2");
+    EXPECT_EQ(n.text, "select * from players where id = 42 and name = 'O''Brien'");
+    ASSERT_EQ(n.parameters.size(), 2u);
+    EXPECT_EQ(std::get<std::int64_t>(n.parameters[0]), 42);
+    EXPECT_EQ(std::get<std::string>(n.parameters[1]), "O'Brien");
+    EXPECT_TRUE(n.read);
+    EXPECT_TRUE(n.parameterizable);
+    EXPECT_FALSE(n.opaque);
+}
+
+TEST(SqlNormalizerTest, SameShapeAcrossValuesAndSpelling) {
+    auto a = normalizeSql("SELECT * FROM items WHERE id = 1");
+    auto b = normalizeSql("select *\n  from ITEMS -- lookup\n where id=2");
+    auto c = normalizeSql("SELECT * FROM items WHERE owner = 1");
+
+    EXPECT_EQ(a.fingerprint, b.fingerprint);
+    EXPECT_EQ(a.shape, b.shape);
+    EXPECT_NE(a.text, b.text);
+    EXPECT_NE(a.fingerprint, c.fingerprint);
+
+    // Equal text for the same query spelled differently.
+    EXPECT_EQ(normalizeSql("SELECT a FROM t WHERE x IN (1,2)").text,
+              normalizeSql("select  a /* x */ from t where x in ( 1 , 2 )").text);
+}
+
+TEST(SqlNormalizerTest, NumbersAndUnaryMinus) {
+    auto n = normalizeSql("SELECT * FROM t WHERE a > -5 AND b < 2.5 AND c = 1e3 AND d = x - 1");
+    ASSERT_EQ(n.parameters.size(), 4u);
+    EXPECT_EQ(std::get<std::int64_t>(n.parameters[0]), -5);
+    EXPECT_DOUBLE_EQ(std::get<double>(n.parameters[1]), 2.5);
+    EXPECT_DOUBLE_EQ(std::get<double>(n.parameters[2]), 1000.0);
+    EXPECT_EQ(std::get<std::int64_t>(n.parameters[3]), 1);  // Subtraction keeps its minus.
+    EXPECT_NE(n.shape.find("x - $_4"), std::string::npos);
+    EXPECT_FALSE(n.parameterizable);  // 1 is an operand of -, not a comparison.
+}
+
+TEST(SqlNormalizerTest, ParameterizableOnlyForValueOperands) {
+    EXPECT_TRUE(normalizeSql("SELECT * FROM t WHERE id IN (1, 2, 3) LIMIT 10 OFFSET 5")
+                    .parameterizable);
+    EXPECT_TRUE(normalizeSql("SELECT * FROM t WHERE name LIKE 'a%'").parameterizable);
+    EXPECT_TRUE(normalizeSql("SELECT * FROM t").parameterizable);
+
+    EXPECT_FALSE(normalizeSql("SELECT 1").parameterizable);
+    EXPECT_FALSE(normalizeSql("SELECT * FROM t ORDER BY 2").parameterizable);
+    EXPECT_FALSE(normalizeSql("SELECT * FROM t WHERE d > DATE '2026-01-01'").parameterizable);
+    EXPECT_FALSE(normalizeSql("SELECT * FROM t WHERE id IN (SELECT 1)").parameterizable);
+    EXPECT_FALSE(normalizeSql("SELECT * FROM t WHERE id = $id").parameterizable);
+}
+
+TEST(SqlNormalizerTest, UnmodeledSqlStaysOpaque) {
+    for (const char* sql : {"SELECT E'a\\'b'", "SELECT $$x$$", "SELECT 'unterminated",
+                            "SELECT 0x1F", "SELECT * FROM caf\xc3\xa9"}) {
+        auto n = normalizeSql(sql);
+        EXPECT_TRUE(n.opaque) << sql;
+        EXPECT_EQ(n.text, sql);
+        EXPECT_TRUE(n.parameters.empty());
+        EXPECT_FALSE(n.parameterizable);
+        EXPECT_TRUE(n.read);
+    }
+}
+
+TEST(SqlNormalizerTest, QuotedIdentifiersKeepCase) {
+    auto n = normalizeSql(R"(SELECT "Name" FROM "Players" WHERE "Id" = 3)");
+    EXPECT_EQ(n.shape, R"(select "Name" from "Players" where "Id" = $_1)");
+}
+
+TEST(SqlNormalizerTest, StatementRebindsLiterals) {
+    auto n = normalizeSql("SELECT * FROM t WHERE a = 'x' AND b = 7 AND c = 0.5");
+    auto stmt = n.statement();
+    EXPECT_EQ(stmt.sql(), n.shape);
+    EXPECT_EQ(stmt.resolve(), "select * from t where a = 'x' and b = 7 and c = 0.5");
+    EXPECT_EQ(stmt.positionalSql(), "select * from t where a = $1 and b = $2 and c = $3");
+}
+
+TEST(SqlNormalizerTest, ReadAndWriteStatements) {
+    EXPECT_TRUE(normalizeSql("  select 1").read);
+    EXPECT_FALSE(normalizeSql("UPDATE t SET a = 1 WHERE id = 2").read);
+    EXPECT_FALSE(normalizeSql("selected").read);
+    EXPECT_EQ(normalizeSql("INSERT INTO t (a, b) VALUES (1, 'x')").shape,
+              "insert into t(a, b) values($_1, $_2)");
+}
+
+// ============================================================================
+// QueryShapeRegistry Tests
+// ============================================================================
+
+TEST(QueryShapeRegistryTest, CountsAndLatencyPerShape) {
+    QueryShapeRegistry shapes(16);
+    shapes.record(1, "select a", 2ms);
+    shapes.record(1, "select a", 4ms);
+    shapes.record(2, "select b", 1ms);
+
+    auto stats = shapes.snapshot();
+    ASSERT_EQ(stats.size(), 2u);
+    EXPECT_EQ(stats[0].fingerprint, 1u);  // Costliest first.
+    EXPECT_EQ(stats[0].shape, "select a");
+    EXPECT_EQ(stats[0].count, 2u);
+    EXPECT_DOUBLE_EQ(stats[0].totalMs, 6.0);
+    EXPECT_DOUBLE_EQ(stats[0].maxMs, 4.0);
+    EXPECT_EQ(stats[1].count, 1u);
+}
+
+TEST(QueryShapeRegistryTest, ShapesPastLimitShareOther) {
+    QueryShapeRegistry shapes(2);
+    shapes.record(1, "a", 1ms);
+    shapes.record(2, "b", 1ms);
+    shapes.record(3, "c", 1ms);
+    shapes.record(4, "d", 1ms);
+    shapes.record(1, "a", 1ms);
+
+    EXPECT_EQ(shapes.size(), 2u);
+    auto stats = shapes.snapshot();
+    ASSERT_EQ(stats.size(), 3u);
+    auto other = std::find_if(
+        stats.begin(), stats.end(), [](const QueryShapeStats& s) { return s.fingerprint == 0; });
+    ASSERT_NE(other, stats.end());
+    EXPECT_EQ(other->shape, "(other)");
+    EXPECT_EQ(other->count, 2u);
+
+    shapes.clear();
+    EXPECT_TRUE(shapes.snapshot().empty());
+}
+
+TEST(QueryShapeRegistryTest, ConcurrentRecords) {
+    QueryShapeRegistry shapes(8);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 1000; ++i) {
+                const auto fp = static_cast<uint64_t>(i % 16);
+                shapes.record(fp, "shape " + std::to_string(fp), std::chrono::microseconds(10));
+            }
+        });
+    }
+    threads.emplace_back([&] {
+        for (int i = 0; i < 50; ++i) {
+            (void)shapes.snapshot();
+        }
+    });
+    for (auto& th : threads) {
+        th.join();
+    }
+
+    uint64_t total = 0;
+    for (const auto& s : shapes.snapshot()) {
+        total += s.count;
+    }
+    EXPECT_EQ(total, 4000u);
+    EXPECT_EQ(shapes.size(), 8u);
+}
+
 // ============================================================================
 // DBProxyServer PreparedStatement Tests
 // ============================================================================
@@ -478,6 +1432,16 @@ TEST(DBProxyServerPreparedTest, QueryAsyncReturnsNotStarted) {
     EXPECT_EQ(result.error().code(), ErrorCode::DBProxyNotStarted);
 }
 
+TEST(DBProxyServerPreparedTest, QueryStreamReturnsNotStarted) {
+    DBProxyConfig config;
+    DBProxyServer proxy(config);
+
+    auto result = proxy.queryStream("SELECT * FROM t", [](const QueryResult&) { return true; });
+    EXPECT_TRUE(result.hasError());
+    EXPECT_EQ(result.error().code(), ErrorCode::DBProxyNotStarted);
+    EXPECT_EQ(proxy.poolStats().streams, 0u);
+}
+
 // ============================================================================
 // ConnectionPoolManager PreparedStatement Tests
 // ============================================================================
@@ -505,3 +1469,19 @@ TEST(ConnectionPoolManagerPreparedTest, ExecuteReturnsNotStarted) {
     EXPECT_TRUE(result.hasError());
     EXPECT_EQ(result.error().code(), ErrorCode::DBProxyNotStarted);
 }
+
+TEST(ConnectionPoolManagerPreparedTest, QueryStreamReturnsNotStarted) {
+    DBProxyConfig config;
+    ConnectionPoolManager pool(config);
+
+    auto result = pool.queryStream("SELECT * FROM t", [](const QueryResult&) { return true; });
+    EXPECT_TRUE(result.hasError());
+    EXPECT_EQ(result.error().code(), ErrorCode::DBProxyNotStarted);
+}
+
+TEST(ConnectionPoolManagerPreparedTest, NoPinningWithoutWindow) {
+    DBProxyConfig config;
+    ConnectionPoolManager pool(config);
+    EXPECT_FALSE(pool.pinnedToPrimary(0));
+    EXPECT_FALSE(pool.pinnedToPrimary(42));
+}
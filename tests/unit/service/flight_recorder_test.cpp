@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "cgs/service/flight_recorder.hpp"
+
+using namespace cgs::service;
+
+namespace {
+
+/// A tick of @p budget budgets, started @p number * 50 ms after zero.
+FlightTick makeTick(uint64_t number, float budget = 0.5f) {
+    FlightTick tick;
+    tick.tickNumber = number;
+    tick.startUs = static_cast<int64_t>(number) * 50'000;
+    tick.updateUs = static_cast<uint32_t>(budget * 50'000.0f);
+    tick.frameUs = 50'000;
+    tick.budgetUtilization = budget;
+    tick.overrun = budget > 1.0f;
+    tick.entities = 10;
+    tick.systems.push_back({0, 0, 100, 200, 3});
+    return tick;
+}
+
+FlightRecorderConfig withCapacity(std::size_t capacity) {
+    FlightRecorderConfig config;
+    config.capacity = capacity;
+    return config;
+}
+
+std::string readFile(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+
+}  // namespace
+
+// ── Ring ────────────────────────────────────────────────────────────────────
+
+TEST(FlightRecorderTest, KeepsTheLastCapacityTicks) {
+    FlightRecorder recorder(withCapacity(4));
+    for (uint64_t i = 0; i < 10; ++i) {
+        recorder.record(makeTick(i));
+    }
+    const auto ticks = recorder.ticks(100);
+    ASSERT_EQ(ticks.size(), 4u);
+    EXPECT_EQ(ticks.front().tickNumber, 6u);
+    EXPECT_EQ(ticks.back().tickNumber, 9u);
+    EXPECT_EQ(recorder.ticks(2).front().tickNumber, 8u);
+}
+
+TEST(FlightRecorderTest, TruncatesSystemsPerTick) {
+    auto config = withCapacity(2);
+    config.maxSystemsPerTick = 2;
+    FlightRecorder recorder(config);
+    auto tick = makeTick(0);
+    tick.systems.assign(5, FlightSystemTiming{});
+    recorder.record(tick);
+    EXPECT_EQ(recorder.ticks(1).front().systems.size(), 2u);
+}
+
+TEST(FlightRecorderTest, NetworkTrafficGoesToTheNextTick) {
+    FlightRecorder recorder(withCapacity(4));
+    recorder.addNetworkTraffic(3, 300, 5, 500);
+    recorder.record(makeTick(0));
+    recorder.record(makeTick(1));
+
+    const auto ticks = recorder.ticks(2);
+    EXPECT_EQ(ticks[0].messagesIn, 3u);
+    EXPECT_EQ(ticks[0].bytesOut, 500u);
+    EXPECT_EQ(ticks[1].messagesIn, 0u);
+}
+
+TEST(FlightRecorderTest, EventsAreBoundedAndTagged) {
+    auto config = withCapacity(4);
+    config.eventCapacity = 2;
+    FlightRecorder recorder(config);
+    recorder.record(makeTick(7));
+    recorder.note(FlightEventKind::InstanceCreated, "instance=1");
+    recorder.note(FlightEventKind::HotReload, "plugin=a");
+    recorder.note(FlightEventKind::Snapshot);
+
+    const auto events = recorder.events();
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(events[0].kind, FlightEventKind::HotReload);
+    EXPECT_EQ(events[0].tickNumber, 8u);
+    EXPECT_EQ(flightEventKindName(events[1].kind), "snapshot");
+}
+
+// ── Trace ───────────────────────────────────────────────────────────────────
+
+TEST(FlightRecorderTest, TraceJsonCoversTheWindow) {
+    FlightRecorder recorder(withCapacity(100));
+    const uint16_t movement = recorder.registerSystem("MovementSystem");
+    EXPECT_EQ(recorder.registerSystem("MovementSystem"), movement);
+    for (uint64_t i = 0; i < 100; ++i) {
+        recorder.record(makeTick(i));
+    }
+
+    // 50 ms ticks: one second before tick 99 starts at tick 79.
+    const std::string json = recorder.traceJson(std::chrono::seconds(1));
+    EXPECT_EQ(json.rfind("{\"traceEvents\":[", 0), 0u);
+    EXPECT_NE(json.find("\"name\":\"MovementSystem\""), std::string::npos);
+    EXPECT_NE(json.find("\"tick\":79,"), std::string::npos);
+    EXPECT_EQ(json.find("\"tick\":78,"), std::string::npos);
+    EXPECT_NE(json.find("\"allocs\":3"), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"population\""), std::string::npos);
+    EXPECT_EQ(json.find("otherData"), std::string::npos);
+}
+
+// ── Dumps ───────────────────────────────────────────────────────────────────
+
+class FlightRecorderDumpTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir = std::filesystem::temp_directory_path() /
+              ("cgs_flight_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) +
+               "_" + ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove_all(dir);
+    }
+    void TearDown() override { std::filesystem::remove_all(dir); }
+
+    FlightRecorderConfig config() const {
+        auto cfg = withCapacity(64);
+        cfg.ticksBefore = 5;
+        cfg.ticksAfter = 3;
+        cfg.dumpDirectory = dir;
+        return cfg;
+    }
+
+    std::filesystem::path dir;
+};
+
+TEST_F(FlightRecorderDumpTest, WritesTheWindowAroundAnOverrun) {
+    FlightRecorder recorder(config());
+    for (uint64_t i = 0; i < 20; ++i) {
+        recorder.record(makeTick(i, i == 10 ? 4.0f : 0.5f));
+        if (i == 12) {
+            // Two of the three ticks after the trigger: not written yet.
+            recorder.flushDumps();
+            EXPECT_EQ(recorder.dumpStats().written, 0u);
+        }
+    }
+    recorder.flushDumps();
+
+    const auto stats = recorder.dumpStats();
+    EXPECT_EQ(stats.triggers, 1u);
+    ASSERT_EQ(stats.written, 1u);
+    ASSERT_TRUE(stats.lastPath.has_value());
+    EXPECT_EQ(stats.lastPath->parent_path(), dir);
+
+    const std::string json = readFile(*stats.lastPath);
+    EXPECT_NE(json.find("\"otherData\":{\"triggerTick\":10}"), std::string::npos);
+    EXPECT_NE(json.find("\"tick\":5,"), std::string::npos);
+    EXPECT_NE(json.find("\"tick\":13,"), std::string::npos);
+    EXPECT_EQ(json.find("\"tick\":4,"), std::string::npos);
+    EXPECT_EQ(json.find("\"tick\":14,"), std::string::npos);
+}
+
+TEST_F(FlightRecorderDumpTest, CooldownLimitsDumps) {
+    FlightRecorder recorder(config());
+    for (uint64_t i = 0; i < 40; ++i) {
+        recorder.record(makeTick(i, i % 10 == 0 ? 5.0f : 0.5f));
+    }
+    recorder.flushDumps();
+
+    const auto stats = recorder.dumpStats();
+    EXPECT_EQ(stats.triggers, 4u);
+    EXPECT_EQ(stats.written, 1u);
+}
+
+TEST_F(FlightRecorderDumpTest, NoDirectoryMeansNoDumps) {
+    auto cfg = config();
+    cfg.dumpDirectory.clear();
+    FlightRecorder recorder(cfg);
+    for (uint64_t i = 0; i < 20; ++i) {
+        recorder.record(makeTick(i, i == 2 ? 9.0f : 0.5f));
+    }
+    recorder.flushDumps();
+    EXPECT_EQ(recorder.dumpStats().triggers, 1u);
+    EXPECT_EQ(recorder.dumpStats().written, 0u);
+    EXPECT_FALSE(std::filesystem::exists(dir));
+}
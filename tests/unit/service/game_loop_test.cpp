@@ -5,6 +5,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <mutex>
 #include <thread>
 #include <vector>
 
@@ -194,6 +195,117 @@ TEST_F(GameLoopTest, DestructorStopsRunningLoop) {
     delete loop; // Should call stop() in destructor.
 }
 
+TEST_F(GameLoopTest, PinnedLoopRunsOnItsCpu) {
+    const auto cpu = cgs::foundation::allowedCpus()[0];
+    ASSERT_TRUE(loop_.setAffinity(cgs::foundation::CpuSet{cpu}).hasValue());
+
+    std::atomic<bool> ranOnCpu{false};
+    loop_.setTickCallback([&](float) {
+        ranOnCpu.store(cgs::foundation::allowedCpus() == cgs::foundation::CpuSet{cpu});
+    });
+    ASSERT_TRUE(loop_.start());
+    std::this_thread::sleep_for(120ms);
+
+    // Changing placement under a running loop is refused.
+    EXPECT_FALSE(loop_.setAffinity({}).hasValue());
+    loop_.stop();
+
+#if defined(__linux__)
+    EXPECT_TRUE(ranOnCpu.load());
+#endif
+    EXPECT_EQ(loop_.affinity(), cgs::foundation::CpuSet{cpu});
+}
+
+TEST_F(GameLoopTest, TimingDefaultsToSleepAndSkip) {
+    EXPECT_EQ(loop_.timing().mode, TickTimingMode::Sleep);
+    EXPECT_EQ(loop_.timing().overrun, OverrunPolicy::Skip);
+    EXPECT_EQ(loop_.timerSlack(), 0us);
+
+    auto metrics = loop_.tick();
+    EXPECT_EQ(metrics.jitter, 0us);
+    EXPECT_EQ(metrics.droppedTicks, 0u);
+}
+
+TEST_F(GameLoopTest, PreciseTimingCalibratesSlack) {
+    GameLoop loop(100);
+    ASSERT_TRUE(loop.setTiming({TickTimingMode::Precise}).hasValue());
+
+    std::mutex mutex;
+    std::vector<TickMetrics> ticks;
+    loop.setMetricsCallback([&](const TickMetrics& m) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ticks.push_back(m);
+    });
+    ASSERT_TRUE(loop.start());
+    std::this_thread::sleep_for(150ms);
+
+    // Changing timing under a running loop is refused.
+    EXPECT_FALSE(loop.setTiming({}).hasValue());
+    loop.stop();
+
+    EXPECT_GT(loop.timerSlack(), 0us);
+    EXPECT_LE(loop.timerSlack(), loop.targetFrameTime() / 2);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_GE(ticks.size(), 3u);
+    for (std::size_t i = 1; i < ticks.size(); ++i) {
+        EXPECT_GE(ticks[i].jitter, 0us);
+        EXPECT_GE(ticks[i].frameTime, loop.targetFrameTime() - 1ms);
+    }
+}
+
+TEST_F(GameLoopTest, SkipPolicyDropsMissedTicks) {
+    GameLoop loop(100);  // 10 ms frames
+
+    std::mutex mutex;
+    std::vector<TickMetrics> ticks;
+    loop.setTickCallback([&](float) {
+        if (loop.tickCount() == 0) {
+            std::this_thread::sleep_for(35ms);
+        }
+    });
+    loop.setMetricsCallback([&](const TickMetrics& m) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ticks.push_back(m);
+    });
+    ASSERT_TRUE(loop.start());
+    std::this_thread::sleep_for(100ms);
+    loop.stop();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_GE(ticks.size(), 3u);
+    EXPECT_GE(ticks[1].droppedTicks, 2u);
+    EXPECT_EQ(ticks[1].jitter, 0us);  // ran at once, no wait
+}
+
+TEST_F(GameLoopTest, CatchUpPolicyRunsMissedTicks) {
+    GameLoop loop(100);  // 10 ms frames
+    ASSERT_TRUE(loop.setTiming({TickTimingMode::Sleep, OverrunPolicy::CatchUp, 2}).hasValue());
+
+    std::mutex mutex;
+    std::vector<TickMetrics> ticks;
+    loop.setTickCallback([&](float) {
+        if (loop.tickCount() == 0) {
+            std::this_thread::sleep_for(45ms);
+        }
+    });
+    loop.setMetricsCallback([&](const TickMetrics& m) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ticks.push_back(m);
+    });
+    ASSERT_TRUE(loop.start());
+    std::this_thread::sleep_for(120ms);
+    loop.stop();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_GE(ticks.size(), 4u);
+    // Two missed ticks run back to back, then the rest are dropped.
+    EXPECT_EQ(ticks[1].droppedTicks, 0u);
+    EXPECT_EQ(ticks[2].droppedTicks, 0u);
+    EXPECT_LT(ticks[2].frameTime, 5ms);
+    EXPECT_GE(ticks[3].droppedTicks, 1u);
+}
+
 // ============================================================================
 // MapInstanceManager Tests
 // ============================================================================
@@ -359,6 +471,26 @@ TEST_F(MapInstanceManagerTest, CannotTransitionBackToActive) {
     EXPECT_FALSE(mgr_.setInstanceState(id, InstanceState::Active));
 }
 
+TEST_F(MapInstanceManagerTest, PooledInstanceCyclesThroughActive) {
+    auto result =
+        mgr_.createInstance(1, cgs::game::MapType::Dungeon, 5, InstanceState::Pooled);
+    ASSERT_TRUE(result.hasValue());
+    auto id = result.value();
+
+    // Pooled instances take no players and are not offered.
+    EXPECT_FALSE(mgr_.addPlayer(id));
+    EXPECT_TRUE(mgr_.findAvailableInstances(1).empty());
+
+    EXPECT_TRUE(mgr_.setInstanceState(id, InstanceState::Active));
+    EXPECT_TRUE(mgr_.addPlayer(id));
+
+    // Back to the pool only once empty.
+    EXPECT_FALSE(mgr_.setInstanceState(id, InstanceState::Pooled));
+    EXPECT_TRUE(mgr_.removePlayer(id));
+    EXPECT_TRUE(mgr_.setInstanceState(id, InstanceState::Pooled));
+    EXPECT_EQ(mgr_.instanceCount(InstanceState::Pooled), 1u);
+}
+
 TEST_F(MapInstanceManagerTest, CannotAddPlayerToDrainingInstance) {
     auto result = mgr_.createInstance(1);
     ASSERT_TRUE(result.hasValue());
@@ -462,6 +594,52 @@ TEST_F(MapInstanceManagerTest, FindAvailableInstances) {
     EXPECT_EQ(available2[0], r3.value());
 }
 
+TEST_F(MapInstanceManagerTest, AvailableInstancesFullestFirst) {
+    auto r1 = mgr_.createInstance(1, cgs::game::MapType::OpenWorld, 4);
+    auto r2 = mgr_.createInstance(1, cgs::game::MapType::OpenWorld, 4);
+    auto r3 = mgr_.createInstance(1, cgs::game::MapType::OpenWorld, 4);
+    ASSERT_TRUE(r1.hasValue());
+    ASSERT_TRUE(r2.hasValue());
+    ASSERT_TRUE(r3.hasValue());
+
+    EXPECT_TRUE(mgr_.addPlayer(r2.value()));
+    EXPECT_TRUE(mgr_.addPlayer(r2.value()));
+    EXPECT_TRUE(mgr_.addPlayer(r3.value()));
+
+    EXPECT_EQ(mgr_.findAvailableInstances(1),
+              (std::vector<uint32_t>{r2.value(), r3.value(), r1.value()}));
+    EXPECT_EQ(mgr_.bestAvailableInstance(1), r2.value());
+
+    // Full and no longer available: the next fullest takes over.
+    EXPECT_TRUE(mgr_.addPlayer(r2.value()));
+    EXPECT_TRUE(mgr_.addPlayer(r2.value()));
+    EXPECT_EQ(mgr_.bestAvailableInstance(1), r3.value());
+
+    EXPECT_TRUE(mgr_.removePlayer(r2.value()));
+    EXPECT_EQ(mgr_.bestAvailableInstance(1), r2.value());
+    EXPECT_FALSE(mgr_.bestAvailableInstance(2).has_value());
+}
+
+TEST_F(MapInstanceManagerTest, IndicesFollowStateAndDestroy) {
+    auto r1 = mgr_.createInstance(1);
+    auto r2 = mgr_.createInstance(1);
+    ASSERT_TRUE(r1.hasValue());
+    ASSERT_TRUE(r2.hasValue());
+
+    EXPECT_TRUE(mgr_.setInstanceState(r1.value(), InstanceState::Draining));
+    EXPECT_EQ(mgr_.findAvailableInstances(1), std::vector<uint32_t>{r2.value()});
+    EXPECT_EQ(mgr_.instanceCount(InstanceState::Active), 1u);
+
+    EXPECT_TRUE(mgr_.destroyInstance(r1.value()).hasValue());
+    EXPECT_EQ(mgr_.instanceCount(InstanceState::Draining), 0u);
+    EXPECT_EQ(mgr_.getInstancesByMap(1).size(), 1u);
+    EXPECT_EQ(mgr_.findEmptyInstances(), std::vector<uint32_t>{r2.value()});
+
+    EXPECT_TRUE(mgr_.destroyInstance(r2.value()).hasValue());
+    EXPECT_TRUE(mgr_.getInstancesByMap(1).empty());
+    EXPECT_FALSE(mgr_.bestAvailableInstance(1).has_value());
+}
+
 TEST_F(MapInstanceManagerTest, InstanceCreatedAtTimestamp) {
     auto before = std::chrono::steady_clock::now();
     auto result = mgr_.createInstance(1);
@@ -475,6 +653,50 @@ TEST_F(MapInstanceManagerTest, InstanceCreatedAtTimestamp) {
     EXPECT_LE(info->createdAt, after);
 }
 
+TEST_F(MapInstanceManagerTest, HibernatesOnlyWhenEmpty) {
+    auto result = mgr_.createInstance(1);
+    ASSERT_TRUE(result.hasValue());
+    auto id = result.value();
+
+    EXPECT_TRUE(mgr_.addPlayer(id));
+    EXPECT_FALSE(mgr_.setInstanceState(id, InstanceState::Hibernating));
+    EXPECT_TRUE(mgr_.removePlayer(id));
+    EXPECT_TRUE(mgr_.setInstanceState(id, InstanceState::Hibernating));
+    EXPECT_EQ(mgr_.instanceCount(InstanceState::Hibernating), 1u);
+
+    // Asleep, it takes no players and offers no room.
+    EXPECT_FALSE(mgr_.addPlayer(id));
+    EXPECT_FALSE(mgr_.bestAvailableInstance(1).has_value());
+    EXPECT_FALSE(mgr_.setInstanceState(id, InstanceState::Draining));
+
+    EXPECT_TRUE(mgr_.setInstanceState(id, InstanceState::Active));
+    EXPECT_TRUE(mgr_.addPlayer(id));
+}
+
+TEST_F(MapInstanceManagerTest, FindIdleInstances) {
+    auto idle = mgr_.createInstance(1);
+    auto busy = mgr_.createInstance(1);
+    auto drained = mgr_.createInstance(1);
+    ASSERT_TRUE(idle.hasValue());
+    ASSERT_TRUE(busy.hasValue());
+    ASSERT_TRUE(drained.hasValue());
+    EXPECT_TRUE(mgr_.addPlayer(busy.value()));
+    EXPECT_TRUE(mgr_.addPlayer(drained.value()));
+    EXPECT_TRUE(mgr_.removePlayer(drained.value()));
+
+    const auto emptied = mgr_.getInstance(drained.value())->emptySince;
+    EXPECT_GE(emptied, mgr_.getInstance(idle.value())->emptySince);
+
+    const auto later = emptied + std::chrono::minutes(5);
+    EXPECT_EQ(mgr_.findIdleInstances(std::chrono::minutes(5), later),
+              (std::vector<uint32_t>{idle.value(), drained.value()}));
+    EXPECT_TRUE(mgr_.findIdleInstances(std::chrono::minutes(10), later).empty());
+
+    EXPECT_TRUE(mgr_.setInstanceState(idle.value(), InstanceState::Hibernating));
+    EXPECT_EQ(mgr_.findIdleInstances(std::chrono::minutes(5), later),
+              std::vector<uint32_t>{drained.value()});
+}
+
 TEST_F(MapInstanceManagerTest, StateTransitionOnNonexistentInstanceFails) {
     EXPECT_FALSE(mgr_.setInstanceState(999, InstanceState::Draining));
 }
@@ -2,10 +2,14 @@
 
 #include "cgs/ecs/entity.hpp"
 #include "cgs/foundation/error_code.hpp"
+#include "cgs/foundation/task.hpp"
 #include "cgs/foundation/types.hpp"
 #include "cgs/service/game_server.hpp"
 
+#include <chrono>
 #include <optional>
+#include <string>
+#include <thread>
 #include <vector>
 
 using namespace cgs::service;
@@ -57,6 +61,42 @@ TEST_F(GameServerTest, MultipleManualTicks) {
     }
 }
 
+TEST_F(GameServerTest, SystemTraceCoversRecentTicks) {
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(server_->tick().hasValue());
+    }
+
+    auto trace = server_->systemTrace(2);
+    EXPECT_EQ(trace.rfind("{\"traceEvents\":[", 0), 0u);
+    EXPECT_NE(trace.find("\"name\":\"WorldSystem\""), std::string::npos);
+    EXPECT_NE(trace.find("\"tick\":3"), std::string::npos);
+    EXPECT_EQ(trace.find("\"tick\":1}"), std::string::npos);
+}
+
+namespace {
+
+cgs::foundation::Task<void> twoTicks(cgs::foundation::ResumeQueue& queue, int& stage) {
+    stage = 1;
+    co_await queue.nextTick();
+    stage = 2;
+    co_await queue.nextTick();
+    stage = 3;
+}
+
+}  // namespace
+
+TEST_F(GameServerTest, ResumeQueueDrainsEachTick) {
+    int stage = 0;
+    cgs::foundation::spawn(twoTicks(server_->resumeQueue(), stage));
+    EXPECT_EQ(stage, 1);
+
+    ASSERT_TRUE(server_->tick().hasValue());
+    EXPECT_EQ(stage, 2);
+    ASSERT_TRUE(server_->tick().hasValue());
+    EXPECT_EQ(stage, 3);
+    EXPECT_EQ(server_->resumeQueue().pending(), 0u);
+}
+
 // =============================================================================
 // Instance management tests
 // =============================================================================
@@ -206,6 +246,31 @@ TEST_F(GameServerTest, TransferPlayerBetweenInstances) {
     EXPECT_EQ(session->instanceId, inst2.value());
 }
 
+TEST_F(GameServerTest, TransferWithinWorldMovesPlayerBetweenSpatialIndices) {
+    auto inst1 = server_->createInstance(1);
+    auto inst2 = server_->createInstance(2);
+    ASSERT_TRUE(inst1.hasValue());
+    ASSERT_TRUE(inst2.hasValue());
+
+    auto entity = server_->addPlayer(pid(1), inst1.value());
+    ASSERT_TRUE(entity.hasValue());
+    ASSERT_TRUE(server_->tick().hasValue());
+
+    const cgs::game::Vector3 origin{0.0f, 0.0f, 0.0f};
+    auto near1 = server_->entitiesNear(inst1.value(), origin, 10.0f);
+    ASSERT_EQ(near1.size(), 1u);
+    EXPECT_EQ(near1[0], entity.value());
+
+    ASSERT_TRUE(server_->transferPlayer(pid(1), inst2.value()).hasValue());
+    ASSERT_TRUE(server_->tick().hasValue());
+
+    // No ghost left behind on the old map.
+    EXPECT_TRUE(server_->entitiesNear(inst1.value(), origin, 10.0f).empty());
+    auto near2 = server_->entitiesNear(inst2.value(), origin, 10.0f);
+    ASSERT_EQ(near2.size(), 1u);
+    EXPECT_EQ(near2[0], entity.value());
+}
+
 TEST_F(GameServerTest, TransferPlayerToSameInstance) {
     auto instId = server_->createInstance(1);
     ASSERT_TRUE(instId.hasValue());
@@ -244,6 +309,53 @@ TEST_F(GameServerTest, TransferNonexistentPlayer) {
     EXPECT_EQ(result.error().code(), ErrorCode::PlayerNotInWorld);
 }
 
+// =============================================================================
+// Abilities
+// =============================================================================
+
+TEST(GameServerAbilityTest, CompletedCastDamagesTarget) {
+    GameServerConfig config;
+    config.tickRate = 20;
+    config.spellDamage[7] = SpellDamage{cgs::game::DamageType::Physical, 30};
+    GameServer server(std::move(config));
+
+    auto instId = server.createInstance(1);
+    ASSERT_TRUE(instId.hasValue());
+    ASSERT_TRUE(server.addPlayer(PlayerId(1), instId.value()).hasValue());
+    auto target = server.addPlayer(PlayerId(2), instId.value());
+    ASSERT_TRUE(target.hasValue());
+
+    cgs::game::AbilityUse use;
+    use.slot = 0;
+    use.spellId = 7;
+    use.target = target.value();
+    use.castTime = 0.1f;
+    use.cooldown = 5.0f;
+
+    auto early = server.useAbility(PlayerId(1), use);
+    ASSERT_TRUE(early.hasError());
+    EXPECT_EQ(early.error().code(), ErrorCode::GameLoopNotRunning);
+
+    ASSERT_TRUE(server.tick().hasValue());
+    auto started = server.useAbility(PlayerId(1), use);
+    ASSERT_TRUE(started.hasValue());
+    EXPECT_EQ(started.value(), cgs::game::AbilityUseResult::Started);
+
+    // The cast completes within a few ticks; its hit resolves the next.
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(server.tick().hasValue());
+    }
+    EXPECT_EQ(server.stats().spellHits, 1u);
+
+    auto again = server.useAbility(PlayerId(1), use);
+    ASSERT_TRUE(again.hasValue());
+    EXPECT_EQ(again.value(), cgs::game::AbilityUseResult::OnCooldown);
+
+    auto missing = server.useAbility(PlayerId(99), use);
+    ASSERT_TRUE(missing.hasError());
+    EXPECT_EQ(missing.error().code(), ErrorCode::PlayerNotInWorld);
+}
+
 // =============================================================================
 // Statistics tests
 // =============================================================================
@@ -344,3 +456,577 @@ TEST_F(GameServerTest, PlayerSlotReusedAfterRemoval) {
     auto result = server_->addPlayer(pid(2), instId.value());
     EXPECT_TRUE(result.hasValue());
 }
+
+// =============================================================================
+// World shards
+// =============================================================================
+
+class ShardedGameServerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        GameServerConfig config;
+        config.maxInstances = 100;
+        config.worldShards = 3;
+        server_ = std::make_unique<GameServer>(std::move(config));
+    }
+
+    static PlayerId pid(uint64_t id) { return PlayerId(id); }
+
+    std::unique_ptr<GameServer> server_;
+};
+
+TEST_F(ShardedGameServerTest, InstancesSpreadAcrossWorlds) {
+    for (uint32_t map = 1; map <= 6; ++map) {
+        ASSERT_TRUE(server_->createInstance(map).hasValue());
+    }
+
+    auto s = server_->stats();
+    EXPECT_EQ(s.worldCount, 3u);
+    EXPECT_EQ(s.activeInstances, 6u);
+    EXPECT_EQ(s.entityCount, 6u);  // one map entity per instance
+}
+
+TEST_F(ShardedGameServerTest, WorldsTickTogether) {
+    std::vector<uint32_t> instances;
+    for (uint32_t map = 1; map <= 3; ++map) {
+        auto inst = server_->createInstance(map);
+        ASSERT_TRUE(inst.hasValue());
+        instances.push_back(inst.value());
+    }
+    for (uint64_t p = 1; p <= 9; ++p) {
+        ASSERT_TRUE(server_->addPlayer(pid(p), instances[p % 3]).hasValue());
+    }
+
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(server_->tick().hasValue());
+    }
+    EXPECT_EQ(server_->stats().playerCount, 9u);
+    EXPECT_EQ(server_->stats().entityCount, 12u);
+}
+
+TEST_F(ShardedGameServerTest, TransferAcrossWorldsArrivesAfterTicks) {
+    // Consecutive instances land in different worlds.
+    auto inst1 = server_->createInstance(1);
+    auto inst2 = server_->createInstance(2);
+    ASSERT_TRUE(inst1.hasValue());
+    ASSERT_TRUE(inst2.hasValue());
+    ASSERT_TRUE(server_->addPlayer(pid(1), inst1.value()).hasValue());
+
+    ASSERT_TRUE(server_->transferPlayer(pid(1), inst2.value()).hasValue());
+    auto session = server_->getPlayerSession(pid(1));
+    ASSERT_TRUE(session.has_value());
+    EXPECT_EQ(session->instanceId, inst2.value());
+    EXPECT_TRUE(session->inTransit);
+
+    // A second move waits for the first to land.
+    auto again = server_->transferPlayer(pid(1), inst1.value());
+    ASSERT_TRUE(again.hasError());
+    EXPECT_EQ(again.error().code(), ErrorCode::PlayerInTransit);
+
+    ASSERT_TRUE(server_->tick().hasValue());
+    ASSERT_TRUE(server_->tick().hasValue());
+
+    session = server_->getPlayerSession(pid(1));
+    ASSERT_TRUE(session.has_value());
+    EXPECT_FALSE(session->inTransit);
+    EXPECT_EQ(server_->stats().entityCount, 3u);  // two maps + the player
+    EXPECT_EQ(server_->stats().crossWorldTransfers, 1u);
+
+    EXPECT_TRUE(server_->transferPlayer(pid(1), inst1.value()).hasValue());
+}
+
+TEST_F(ShardedGameServerTest, RemoveDuringTransferDropsArrival) {
+    auto inst1 = server_->createInstance(1);
+    auto inst2 = server_->createInstance(2);
+    ASSERT_TRUE(server_->addPlayer(pid(1), inst1.value()).hasValue());
+    ASSERT_TRUE(server_->transferPlayer(pid(1), inst2.value()).hasValue());
+
+    ASSERT_TRUE(server_->removePlayer(pid(1)).hasValue());
+    ASSERT_TRUE(server_->tick().hasValue());
+    ASSERT_TRUE(server_->tick().hasValue());
+
+    EXPECT_FALSE(server_->getPlayerSession(pid(1)).has_value());
+    EXPECT_EQ(server_->stats().entityCount, 2u);  // only the maps remain
+    EXPECT_TRUE(server_->addPlayer(pid(2), inst2.value()).hasValue());
+}
+
+TEST_F(ShardedGameServerTest, ThreadedLoopRunsShards) {
+    auto inst1 = server_->createInstance(1);
+    auto inst2 = server_->createInstance(2);
+    ASSERT_TRUE(server_->addPlayer(pid(1), inst1.value()).hasValue());
+    ASSERT_TRUE(server_->addPlayer(pid(2), inst2.value()).hasValue());
+
+    ASSERT_TRUE(server_->start().hasValue());
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    server_->stop();
+
+    EXPECT_GT(server_->stats().totalTicks, 0u);
+}
+
+// =============================================================================
+// Instance pools
+// =============================================================================
+
+class InstancePoolTest : public ::testing::Test {
+protected:
+    static constexpr uint32_t kMap = 7;
+    static constexpr std::size_t kEntitiesPerInstance = 6;  // map + 2 zones + 3 NPCs
+
+    void SetUp() override {
+        GameServerConfig config;
+        config.maxInstances = 100;
+        config.worldShards = 2;
+        server_ = std::make_unique<GameServer>(std::move(config));
+    }
+
+    static InstanceTemplate dungeon(uint32_t warmCount) {
+        InstanceTemplate tmpl;
+        tmpl.maxPlayers = 5;
+        tmpl.warmCount = warmCount;
+        tmpl.zones.resize(2);
+        tmpl.zones[0].zoneId = 1;
+        tmpl.zones[1].zoneId = 2;
+        tmpl.npcs.resize(3);
+        for (auto& npc : tmpl.npcs) {
+            npc.identity.type = cgs::game::ObjectType::Creature;
+            npc.stats.health = 50;
+            npc.stats.maxHealth = 50;
+        }
+        return tmpl;
+    }
+
+    void ticks(int count) {
+        for (int i = 0; i < count; ++i) {
+            ASSERT_TRUE(server_->tick().hasValue());
+        }
+    }
+
+    static PlayerId pid(uint64_t id) { return PlayerId(id); }
+
+    std::unique_ptr<GameServer> server_;
+};
+
+TEST_F(InstancePoolTest, PoolFillsOnTicks) {
+    ASSERT_TRUE(server_->registerInstanceTemplate(kMap, dungeon(2)).hasValue());
+    EXPECT_EQ(server_->pooledInstances(kMap), 0u);
+
+    ticks(3);
+    EXPECT_EQ(server_->pooledInstances(kMap), 2u);
+
+    auto s = server_->stats();
+    EXPECT_EQ(s.pooledInstances, 2u);
+    EXPECT_EQ(s.activeInstances, 0u);
+    EXPECT_EQ(s.entityCount, 2 * kEntitiesPerInstance);
+    EXPECT_TRUE(server_->availableInstances(kMap).empty());
+}
+
+TEST_F(InstancePoolTest, AcquireTakesPooledInstanceAndRefills) {
+    ASSERT_TRUE(server_->registerInstanceTemplate(kMap, dungeon(2)).hasValue());
+    ticks(3);
+
+    auto inst = server_->acquireInstance(kMap);
+    ASSERT_TRUE(inst.hasValue());
+    EXPECT_EQ(server_->pooledInstances(kMap), 1u);
+    EXPECT_EQ(server_->availableInstances(kMap), std::vector<uint32_t>{inst.value()});
+    EXPECT_TRUE(server_->addPlayer(pid(1), inst.value()).hasValue());
+
+    ticks(2);
+    EXPECT_EQ(server_->pooledInstances(kMap), 2u);
+    EXPECT_EQ(server_->stats().entityCount, 3 * kEntitiesPerInstance + 1);
+}
+
+TEST_F(InstancePoolTest, AcquireFromEmptyPoolBuildsOnTheSpot) {
+    ASSERT_TRUE(server_->registerInstanceTemplate(kMap, dungeon(1)).hasValue());
+
+    auto inst = server_->acquireInstance(kMap);
+    ASSERT_TRUE(inst.hasValue());
+    EXPECT_EQ(server_->stats().activeInstances, 1u);
+    EXPECT_EQ(server_->stats().entityCount, kEntitiesPerInstance);
+    EXPECT_TRUE(server_->addPlayer(pid(1), inst.value()).hasValue());
+}
+
+TEST_F(InstancePoolTest, ReleaseResetsIntoPool) {
+    ASSERT_TRUE(server_->registerInstanceTemplate(kMap, dungeon(2)).hasValue());
+    ticks(3);
+
+    auto inst = server_->acquireInstance(kMap);
+    ASSERT_TRUE(inst.hasValue());
+    ASSERT_TRUE(server_->addPlayer(pid(1), inst.value()).hasValue());
+
+    auto busy = server_->releaseInstance(inst.value());
+    ASSERT_TRUE(busy.hasError());
+    EXPECT_EQ(busy.error().code(), ErrorCode::MapInstanceInvalidState);
+
+    ASSERT_TRUE(server_->removePlayer(pid(1)).hasValue());
+    ASSERT_TRUE(server_->releaseInstance(inst.value()).hasValue());
+    EXPECT_FALSE(server_->addPlayer(pid(2), inst.value()).hasValue());
+
+    ticks(2);
+    EXPECT_EQ(server_->pooledInstances(kMap), 2u);
+    EXPECT_EQ(server_->stats().entityCount, 2 * kEntitiesPerInstance);
+
+    // The reset instance is handed out again.
+    auto again = server_->acquireInstance(kMap);
+    ASSERT_TRUE(again.hasValue());
+    EXPECT_TRUE(server_->addPlayer(pid(2), again.value()).hasValue());
+}
+
+TEST_F(InstancePoolTest, ReleaseBeyondWarmCountDestroys) {
+    ASSERT_TRUE(server_->registerInstanceTemplate(kMap, dungeon(1)).hasValue());
+    ticks(1);
+
+    auto first = server_->acquireInstance(kMap);
+    auto second = server_->acquireInstance(kMap);
+    ASSERT_TRUE(first.hasValue());
+    ASSERT_TRUE(second.hasValue());
+    ticks(1);
+    EXPECT_EQ(server_->pooledInstances(kMap), 1u);
+
+    ASSERT_TRUE(server_->releaseInstance(first.value()).hasValue());
+    ticks(1);
+    EXPECT_EQ(server_->pooledInstances(kMap), 1u);
+    EXPECT_EQ(server_->stats().activeInstances, 1u);
+    EXPECT_EQ(server_->stats().entityCount, 2 * kEntitiesPerInstance);
+}
+
+TEST_F(InstancePoolTest, Errors) {
+    auto unknown = server_->acquireInstance(kMap);
+    ASSERT_TRUE(unknown.hasError());
+    EXPECT_EQ(unknown.error().code(), ErrorCode::MapInstanceNotFound);
+
+    ASSERT_TRUE(server_->registerInstanceTemplate(kMap, dungeon(1)).hasValue());
+    auto twice = server_->registerInstanceTemplate(kMap, dungeon(1));
+    ASSERT_TRUE(twice.hasError());
+    EXPECT_EQ(twice.error().code(), ErrorCode::AlreadyExists);
+
+    auto plain = server_->createInstance(1);
+    ASSERT_TRUE(plain.hasValue());
+    auto release = server_->releaseInstance(plain.value());
+    ASSERT_TRUE(release.hasError());
+    EXPECT_EQ(release.error().code(), ErrorCode::MapInstanceNotFound);
+}
+
+TEST_F(InstancePoolTest, DestroyAcquiredInstanceRemovesContents) {
+    ASSERT_TRUE(server_->registerInstanceTemplate(kMap, dungeon(1)).hasValue());
+    ticks(1);
+
+    auto inst = server_->acquireInstance(kMap);
+    ASSERT_TRUE(inst.hasValue());
+    ticks(1);
+
+    // Pooled instances stay with their pool.
+    const auto pooled = inst.value() + 1;
+    auto refused = server_->destroyInstance(pooled);
+    ASSERT_TRUE(refused.hasError());
+    EXPECT_EQ(refused.error().code(), ErrorCode::MapInstanceInvalidState);
+
+    ASSERT_TRUE(server_->destroyInstance(inst.value()).hasValue());
+    EXPECT_EQ(server_->stats().entityCount, kEntitiesPerInstance);
+    EXPECT_EQ(server_->pooledInstances(kMap), 1u);
+}
+
+// =============================================================================
+// Join pipeline
+// =============================================================================
+
+class JoinPipelineTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        GameServerConfig config;
+        config.maxInstances = 10;
+        config.joinsPerTick = 2;
+        config.leavesPerTick = 2;
+        server_ = std::make_unique<GameServer>(std::move(config));
+        auto inst = server_->createInstance(1, 100);
+        ASSERT_TRUE(inst.hasValue());
+        instance_ = inst.value();
+
+        server_->joinFinished().connect(
+            [this](PlayerId playerId, ErrorCode code) { finished_.emplace_back(playerId, code); });
+    }
+
+    static PlayerId pid(uint64_t id) { return PlayerId(id); }
+
+    std::unique_ptr<GameServer> server_;
+    uint32_t instance_ = 0;
+    std::vector<std::pair<PlayerId, ErrorCode>> finished_;
+};
+
+TEST_F(JoinPipelineTest, JoinsMaterializeWithinBudget) {
+    for (uint64_t p = 1; p <= 5; ++p) {
+        ASSERT_TRUE(server_->joinPlayer(pid(p), instance_).hasValue());
+    }
+    EXPECT_EQ(server_->stats().joinsQueued, 5u);
+
+    auto status = server_->joinStatus(pid(5));
+    ASSERT_TRUE(status.has_value());
+    EXPECT_EQ(status->stage, JoinStage::Queued);
+    EXPECT_EQ(status->position, 4u);
+    EXPECT_EQ(status->ticksRemaining, 3u);
+
+    ASSERT_TRUE(server_->tick().hasValue());
+    EXPECT_EQ(server_->stats().playerCount, 2u);
+    EXPECT_TRUE(server_->getPlayerSession(pid(1)).has_value());
+    EXPECT_FALSE(server_->joinStatus(pid(1)).has_value());
+    EXPECT_EQ(server_->joinStatus(pid(5))->ticksRemaining, 2u);
+
+    ASSERT_TRUE(server_->tick().hasValue());
+    ASSERT_TRUE(server_->tick().hasValue());
+    EXPECT_EQ(server_->stats().playerCount, 5u);
+    EXPECT_EQ(server_->stats().joinsQueued, 0u);
+    ASSERT_EQ(finished_.size(), 5u);
+    for (const auto& [playerId, code] : finished_) {
+        EXPECT_EQ(code, ErrorCode::Success);
+    }
+}
+
+TEST_F(JoinPipelineTest, LoaderCompletesAsynchronously) {
+    std::vector<std::pair<PlayerId, std::function<void(cgs::foundation::GameResult<CharacterData>)>>>
+        pending;
+    server_->setCharacterLoader([&](PlayerId playerId, auto done) {
+        pending.emplace_back(playerId, std::move(done));
+    });
+
+    ASSERT_TRUE(server_->joinPlayer(pid(1), instance_).hasValue());
+    ASSERT_TRUE(server_->joinPlayer(pid(2), instance_).hasValue());
+    EXPECT_EQ(server_->joinStatus(pid(1))->stage, JoinStage::Loading);
+    EXPECT_EQ(server_->stats().joinsLoading, 2u);
+
+    auto dup = server_->joinPlayer(pid(1), instance_);
+    ASSERT_TRUE(dup.hasError());
+    EXPECT_EQ(dup.error().code(), ErrorCode::PlayerAlreadyInWorld);
+
+    ASSERT_TRUE(server_->tick().hasValue());
+    EXPECT_EQ(server_->stats().playerCount, 0u);
+
+    CharacterData character;
+    character.name = "Aria";
+    character.stats.health = 42;
+    pending[0].second(cgs::foundation::GameResult<CharacterData>::ok(std::move(character)));
+    pending[1].second(cgs::foundation::GameResult<CharacterData>::err(
+        cgs::foundation::GameError(ErrorCode::NotFound, "no such character")));
+
+    ASSERT_TRUE(server_->tick().hasValue());
+    EXPECT_TRUE(server_->getPlayerSession(pid(1)).has_value());
+    EXPECT_FALSE(server_->getPlayerSession(pid(2)).has_value());
+    ASSERT_EQ(finished_.size(), 2u);
+    EXPECT_EQ(finished_[0].first, pid(2));
+    EXPECT_EQ(finished_[0].second, ErrorCode::NotFound);
+    EXPECT_EQ(finished_[1].first, pid(1));
+    EXPECT_EQ(finished_[1].second, ErrorCode::Success);
+}
+
+TEST_F(JoinPipelineTest, LeaveCancelsPendingJoin) {
+    std::function<void(cgs::foundation::GameResult<CharacterData>)> done;
+    server_->setCharacterLoader([&](PlayerId, auto callback) { done = std::move(callback); });
+
+    ASSERT_TRUE(server_->joinPlayer(pid(1), instance_).hasValue());
+    ASSERT_TRUE(server_->leavePlayer(pid(1)).hasValue());
+    done(cgs::foundation::GameResult<CharacterData>::ok(CharacterData{}));
+
+    ASSERT_TRUE(server_->tick().hasValue());
+    EXPECT_FALSE(server_->getPlayerSession(pid(1)).has_value());
+    EXPECT_TRUE(finished_.empty());
+}
+
+TEST_F(JoinPipelineTest, LeavesAreBatched) {
+    for (uint64_t p = 1; p <= 3; ++p) {
+        ASSERT_TRUE(server_->addPlayer(pid(p), instance_).hasValue());
+        ASSERT_TRUE(server_->leavePlayer(pid(p)).hasValue());
+    }
+    ASSERT_TRUE(server_->leavePlayer(pid(3)).hasValue());  // queued once
+    EXPECT_EQ(server_->stats().leavesQueued, 3u);
+
+    ASSERT_TRUE(server_->tick().hasValue());
+    EXPECT_EQ(server_->stats().playerCount, 1u);
+    EXPECT_EQ(server_->stats().entityCount, 2u);  // both leavers destroyed together
+    ASSERT_TRUE(server_->tick().hasValue());
+    EXPECT_EQ(server_->stats().playerCount, 0u);
+    EXPECT_EQ(server_->stats().playersLeft, 3u);
+    EXPECT_EQ(server_->stats().entityCount, 1u);  // the map
+
+    auto unknown = server_->leavePlayer(pid(9));
+    ASSERT_TRUE(unknown.hasError());
+    EXPECT_EQ(unknown.error().code(), ErrorCode::PlayerNotInWorld);
+}
+
+TEST_F(JoinPipelineTest, JoinToFullInstanceReportsError) {
+    auto small = server_->createInstance(2, 1);
+    ASSERT_TRUE(small.hasValue());
+    ASSERT_TRUE(server_->joinPlayer(pid(1), small.value()).hasValue());
+    ASSERT_TRUE(server_->joinPlayer(pid(2), small.value()).hasValue());
+
+    ASSERT_TRUE(server_->tick().hasValue());
+    ASSERT_EQ(finished_.size(), 2u);
+    // Failures are reported ahead of the batch's successes.
+    EXPECT_EQ(finished_[0].first, pid(2));
+    EXPECT_EQ(finished_[0].second, ErrorCode::InstanceFull);
+    EXPECT_EQ(finished_[1].second, ErrorCode::Success);
+    EXPECT_FALSE(server_->getPlayerSession(pid(2)).has_value());
+}
+
+// =============================================================================
+// Hibernation
+// =============================================================================
+
+class HibernationTest : public ::testing::Test {
+protected:
+    static constexpr uint32_t kMap = 9;
+    static constexpr std::size_t kEntitiesPerInstance = 4;  // map + zone + 2 NPCs
+
+    void start(std::chrono::milliseconds hibernateAfter = std::chrono::milliseconds{0}) {
+        GameServerConfig config;
+        config.maxInstances = 10;
+        config.hibernateAfter = hibernateAfter;
+        server_ = std::make_unique<GameServer>(std::move(config));
+    }
+
+    /// A wounded NPC away from its AI home, and a full-health one.
+    static InstanceTemplate crypt() {
+        InstanceTemplate tmpl;
+        tmpl.maxPlayers = 5;
+        tmpl.warmCount = 1;
+        tmpl.zones.resize(1);
+        tmpl.zones[0].zoneId = 1;
+        tmpl.npcs.resize(2);
+        for (auto& npc : tmpl.npcs) {
+            npc.identity.type = cgs::game::ObjectType::Creature;
+            npc.stats.health = 50;
+            npc.stats.maxHealth = 50;
+        }
+        tmpl.npcs[0].identity.entry = 11;
+        tmpl.npcs[0].stats.health = 20;
+        tmpl.npcs[0].transform.position = {30.0f, 0.0f, 30.0f};
+        tmpl.npcs[0].brain.emplace();
+        tmpl.npcs[0].brain->homePosition = {5.0f, 0.0f, 5.0f};
+        return tmpl;
+    }
+
+    static PlayerId pid(uint64_t id) { return PlayerId(id); }
+
+    std::unique_ptr<GameServer> server_;
+};
+
+TEST_F(HibernationTest, HibernatePagesContentsOutUntilAPlayerEnters) {
+    start();
+    ASSERT_TRUE(server_->registerInstanceTemplate(kMap, crypt()).hasValue());
+    auto inst = server_->acquireInstance(kMap);
+    ASSERT_TRUE(inst.hasValue());
+    ASSERT_TRUE(server_->tick().hasValue());  // Refill the pool.
+    const std::size_t pooled = kEntitiesPerInstance;
+    ASSERT_EQ(server_->stats().entityCount, pooled + kEntitiesPerInstance);
+
+    ASSERT_TRUE(server_->hibernateInstance(inst.value()).hasValue());
+    auto s = server_->stats();
+    EXPECT_EQ(s.hibernatingInstances, 1u);
+    EXPECT_EQ(s.activeInstances, 0u);
+    EXPECT_EQ(s.entityCount, pooled + 1);  // Only the map entity stays.
+    EXPECT_TRUE(server_->availableInstances(kMap).empty());
+    EXPECT_EQ(server_->bestAvailableInstance(kMap), inst.value());
+
+    ASSERT_TRUE(server_->tick().hasValue());
+    ASSERT_TRUE(server_->addPlayer(pid(1), inst.value()).hasValue());
+    s = server_->stats();
+    EXPECT_EQ(s.hibernatingInstances, 0u);
+    EXPECT_EQ(s.activeInstances, 1u);
+    EXPECT_EQ(s.entityCount, pooled + kEntitiesPerInstance + 1);
+
+    // Back in the pool, the woken instance resets like any other.
+    ASSERT_TRUE(server_->removePlayer(pid(1)).hasValue());
+    ASSERT_TRUE(server_->hibernateInstance(inst.value()).hasValue());
+    ASSERT_TRUE(server_->releaseInstance(inst.value()).hasValue());
+    ASSERT_TRUE(server_->tick().hasValue());
+    EXPECT_EQ(server_->stats().entityCount, pooled);
+    EXPECT_EQ(server_->stats().hibernatingInstances, 0u);
+}
+
+TEST_F(HibernationTest, WakeFastForwardsNpcs) {
+    start();
+    ASSERT_TRUE(server_->registerInstanceTemplate(kMap, crypt()).hasValue());
+    auto inst = server_->acquireInstance(kMap);
+    ASSERT_TRUE(inst.hasValue());
+    ASSERT_TRUE(server_->hibernateInstance(inst.value()).hasValue());
+    ASSERT_TRUE(server_->wakeInstance(inst.value()).hasValue());
+
+    // The export snapshot shows the restored contents.
+    auto snapshot = server_->beginInstanceExport(inst.value());
+    ASSERT_TRUE(snapshot.hasValue());
+    auto chunk = decodeMigrationChunk(snapshot.value());
+    ASSERT_TRUE(chunk.hasValue());
+    std::size_t zones = 0;
+    std::size_t npcs = 0;
+    for (const auto& record : chunk.value().upserts) {
+        if (record.kind == MigratedKind::Zone) {
+            ++zones;
+            continue;
+        }
+        ++npcs;
+        EXPECT_EQ(record.stats.health, 50);
+        if (record.identity.entry == 11) {
+            EXPECT_TRUE(record.hasBrain);
+            EXPECT_FLOAT_EQ(record.transform.position.x, 5.0f);
+            EXPECT_FLOAT_EQ(record.transform.position.z, 5.0f);
+        }
+    }
+    EXPECT_EQ(zones, 1u);
+    EXPECT_EQ(npcs, 2u);
+}
+
+TEST_F(HibernationTest, IdleInstancesHibernateAutomatically) {
+    start(std::chrono::milliseconds{1});
+    auto idle = server_->createInstance(1);
+    auto busy = server_->createInstance(1);
+    ASSERT_TRUE(idle.hasValue());
+    ASSERT_TRUE(busy.hasValue());
+    ASSERT_TRUE(server_->addPlayer(pid(1), busy.value()).hasValue());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    ASSERT_TRUE(server_->tick().hasValue());
+    auto s = server_->stats();
+    EXPECT_EQ(s.hibernatingInstances, 1u);
+    EXPECT_EQ(s.activeInstances, 1u);
+
+    // Joining through the queue wakes it too.
+    ASSERT_TRUE(server_->joinPlayer(pid(2), idle.value()).hasValue());
+    ASSERT_TRUE(server_->tick().hasValue());
+    EXPECT_EQ(server_->getPlayerSession(pid(2))->instanceId, idle.value());
+    EXPECT_EQ(server_->stats().hibernatingInstances, 0u);
+
+    // Transfers wake the target, and the emptied source sleeps later.
+    ASSERT_TRUE(server_->removePlayer(pid(2)).hasValue());
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    ASSERT_TRUE(server_->tick().hasValue());
+    ASSERT_EQ(server_->stats().hibernatingInstances, 1u);
+    ASSERT_TRUE(server_->transferPlayer(pid(1), idle.value()).hasValue());
+    EXPECT_EQ(server_->stats().hibernatingInstances, 0u);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    ASSERT_TRUE(server_->tick().hasValue());
+    EXPECT_EQ(server_->stats().hibernatingInstances, 1u);
+    EXPECT_EQ(server_->stats().activeInstances, 1u);
+}
+
+TEST_F(HibernationTest, Errors) {
+    start();
+    auto inst = server_->createInstance(1);
+    ASSERT_TRUE(inst.hasValue());
+
+    auto missing = server_->hibernateInstance(999);
+    ASSERT_TRUE(missing.hasError());
+    EXPECT_EQ(missing.error().code(), ErrorCode::MapInstanceNotFound);
+
+    auto awake = server_->wakeInstance(inst.value());
+    ASSERT_TRUE(awake.hasError());
+    EXPECT_EQ(awake.error().code(), ErrorCode::MapInstanceInvalidState);
+
+    ASSERT_TRUE(server_->addPlayer(pid(1), inst.value()).hasValue());
+    auto occupied = server_->hibernateInstance(inst.value());
+    ASSERT_TRUE(occupied.hasError());
+    EXPECT_EQ(occupied.error().code(), ErrorCode::MapInstanceInvalidState);
+
+    // A hibernating instance can be destroyed outright.
+    ASSERT_TRUE(server_->removePlayer(pid(1)).hasValue());
+    ASSERT_TRUE(server_->hibernateInstance(inst.value()).hasValue());
+    ASSERT_TRUE(server_->destroyInstance(inst.value()).hasValue());
+    EXPECT_EQ(server_->stats().entityCount, 0u);
+    EXPECT_EQ(server_->stats().hibernatingInstances, 0u);
+}
@@ -4,11 +4,16 @@
 #include "cgs/service/gateway_session_manager.hpp"
 #include "cgs/service/gateway_types.hpp"
 #include "cgs/service/route_table.hpp"
+#include "cgs/service/service_link.hpp"
 #include "cgs/service/token_bucket.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <span>
 #include <string>
 #include <thread>
+#include <vector>
 
 using namespace cgs::service;
 using cgs::foundation::SessionId;
@@ -126,6 +131,78 @@ TEST_F(TokenBucketTest, ConsumeMoreThanAvailable) {
     EXPECT_EQ(bucket.available("key1"), 10u);
 }
 
+TEST_F(TokenBucketTest, SessionKeysAreIndependentOfAddresses) {
+    const SessionId session(0x0A000001);  // same bits as 10.0.0.1
+    EXPECT_TRUE(bucket.consume(session, 10));
+    EXPECT_FALSE(bucket.consume(session));
+    EXPECT_EQ(bucket.available(TokenBucket::sessionKey(session)), 0u);
+    EXPECT_EQ(bucket.available("10.0.0.1"), 10u);
+    EXPECT_EQ(bucket.available(TokenBucket::sessionKey(SessionId(2))), 10u);
+}
+
+TEST_F(TokenBucketTest, AddressStringsShareIntegerKey) {
+    EXPECT_TRUE(bucket.consume("::ffff:10.0.0.1", 10));
+    EXPECT_FALSE(bucket.consume(RateLimitKey::from("10.0.0.1")));
+    bucket.remove(RateLimitKey::from("10.0.0.1"));
+    EXPECT_EQ(bucket.available("::ffff:10.0.0.1"), 10u);
+}
+
+TEST_F(TokenBucketTest, ConcurrentKeysAcrossShards) {
+    std::vector<std::thread> threads;
+    for (uint64_t t = 0; t < 4; ++t) {
+        threads.emplace_back([this, t] {
+            for (uint64_t i = 0; i < 256; ++i) {
+                const SessionId session(t * 1000 + i);
+                EXPECT_TRUE(bucket.consume(session, 10));
+                EXPECT_FALSE(bucket.consume(session));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+TEST(AtomicTokenBucketTest, ConsumeAndReset) {
+    AtomicTokenBucket bucket(3, 0);
+    EXPECT_EQ(bucket.available(), 3u);
+    EXPECT_TRUE(bucket.consume(2));
+    EXPECT_FALSE(bucket.consume(2));
+    EXPECT_TRUE(bucket.consume());
+    EXPECT_EQ(bucket.available(), 0u);
+
+    bucket.reset();
+    EXPECT_EQ(bucket.available(), 3u);
+}
+
+TEST(AtomicTokenBucketTest, ConcurrentConsumersNeverOverdraw) {
+    AtomicTokenBucket bucket(1000, 0);
+    std::atomic<uint32_t> granted{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 500; ++i) {
+                if (bucket.consume()) {
+                    granted.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(granted.load(), 1000u);
+}
+
+TEST_F(TokenBucketTest, SharedBucketMatchesKey) {
+    auto shared = bucket.bucket("key1");
+    EXPECT_TRUE(shared->consume(4));
+    EXPECT_LE(bucket.available("key1"), 6u);
+
+    bucket.reset("key1");
+    EXPECT_EQ(shared->available(), 10u);
+}
+
 // =============================================================================
 // Route table tests
 // =============================================================================
@@ -216,6 +293,62 @@ TEST_F(RouteTableTest, AddRouteEntry) {
     EXPECT_EQ(match->service, "inventory");
 }
 
+TEST_F(RouteTableTest, OverlappingRoutesFirstAddedWins) {
+    routes.addRoute(0x0180, 0x027F, "shadow", false);
+
+    EXPECT_EQ(routes.resolve(0x0180)->service, "game");
+    EXPECT_EQ(routes.resolve(0x0250)->service, "lobby");
+
+    routes.removeRoutesForService("game");
+    auto match = routes.resolve(0x0180);
+    ASSERT_TRUE(match.has_value());
+    EXPECT_EQ(match->service, "shadow");
+    EXPECT_FALSE(match->requiresAuth);
+    EXPECT_FALSE(routes.resolve(0x0150).has_value());
+}
+
+TEST_F(RouteTableTest, ServiceIdsAreInternedAndStable) {
+    routes.addRoute(0x0400, 0x04FF, "game");
+
+    auto game = routes.serviceId("game");
+    ASSERT_TRUE(game.has_value());
+    EXPECT_EQ(routes.resolve(0x0150)->serviceId, *game);
+    EXPECT_EQ(routes.resolve(0x0450)->serviceId, *game);
+    EXPECT_NE(routes.resolve(0x0250)->serviceId, *game);
+    EXPECT_EQ(routes.serviceName(*game), "game");
+    EXPECT_FALSE(routes.serviceId("missing").has_value());
+
+    // Removing and re-adding a service keeps its id.
+    routes.removeRoutesForService("game");
+    routes.addRoute(0x0100, 0x01FF, "game");
+    EXPECT_EQ(routes.resolve(0x0150)->serviceId, *game);
+}
+
+TEST_F(RouteTableTest, ResolveDuringRouteUpdates) {
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> misrouted{0};
+    std::thread reader([&] {
+        while (!stop.load()) {
+            for (uint32_t op = 0x0200; op <= 0x02FF; ++op) {
+                auto match = routes.resolve(static_cast<uint16_t>(op));
+                if (!match.has_value() || match->service != "lobby") {
+                    misrouted.fetch_add(1);
+                }
+            }
+        }
+    });
+
+    for (int i = 0; i < 50; ++i) {
+        routes.removeRoutesForService("game");
+        routes.addRoute(0x0100, 0x01FF, "game");
+    }
+    stop.store(true);
+    reader.join();
+
+    EXPECT_EQ(misrouted.load(), 0u);
+    EXPECT_EQ(routes.resolve(0x0150)->service, "game");
+}
+
 // =============================================================================
 // Gateway session manager tests
 // =============================================================================
@@ -401,6 +534,211 @@ TEST_F(GatewaySessionManagerTest, FindIdleExcludesUnauthenticated) {
     EXPECT_TRUE(idle.empty());
 }
 
+TEST_F(GatewaySessionManagerTest, HandleSeesStateAndActivity) {
+    EXPECT_TRUE(mgr.createSession(sid(1), "10.0.0.1"));
+    auto handle = mgr.handle(sid(1));
+    ASSERT_TRUE(handle.open());
+    EXPECT_EQ(handle.sessionId(), sid(1));
+    EXPECT_EQ(handle.state(), ClientState::Unauthenticated);
+    EXPECT_TRUE(handle.consume());  // no rate limit attached
+
+    EXPECT_TRUE(mgr.authenticateSession(sid(1), testClaims("alice"), 1));
+    EXPECT_EQ(handle.state(), ClientState::Authenticated);
+
+    EXPECT_EQ(mgr.findIdleSessions(std::chrono::seconds{0}).size(), 1u);
+    handle.touch();
+    EXPECT_TRUE(mgr.findIdleSessions(std::chrono::seconds{3600}).empty());
+    EXPECT_EQ(mgr.getSession(sid(1))->lastActivity, handle.lastActivity());
+
+    mgr.removeSession(sid(1));
+    EXPECT_TRUE(handle);
+    EXPECT_FALSE(handle.open());
+    EXPECT_FALSE(mgr.handle(sid(1)));
+}
+
+TEST_F(GatewaySessionManagerTest, HandleConsumesAttachedRateLimit) {
+    auto bucket = std::make_shared<AtomicTokenBucket>(2, 0);
+    EXPECT_TRUE(mgr.createSession(sid(1), "10.0.0.1", bucket));
+    auto handle = mgr.handle(sid(1));
+    EXPECT_TRUE(handle.consume());
+    EXPECT_TRUE(handle.consume());
+    EXPECT_FALSE(handle.consume());
+    EXPECT_EQ(bucket->available(), 0u);
+}
+
+TEST_F(GatewaySessionManagerTest, IdleSessionsReportedUntilTouchedOrRemoved) {
+    for (uint64_t id = 1; id <= 3; ++id) {
+        EXPECT_TRUE(mgr.createSession(sid(id), "10.0.0.1"));
+        EXPECT_TRUE(mgr.authenticateSession(sid(id), testClaims("p"), id));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+
+    EXPECT_EQ(mgr.findIdleSessions(std::chrono::seconds{1}).size(), 3u);
+    EXPECT_EQ(mgr.findIdleSessions(std::chrono::seconds{1}).size(), 3u);
+    // A longer timeout than the last sweep's does not report them.
+    EXPECT_TRUE(mgr.findIdleSessions(std::chrono::seconds{3600}).empty());
+
+    mgr.removeSession(sid(1));
+    mgr.handle(sid(2)).touch();
+
+    auto idle = mgr.findIdleSessions(std::chrono::seconds{1});
+    ASSERT_EQ(idle.size(), 1u);
+    EXPECT_EQ(idle[0], sid(3));
+}
+
+TEST_F(GatewaySessionManagerTest, ExpiredAuthSessionsSkipAuthenticated) {
+    EXPECT_TRUE(mgr.createSession(sid(1), "10.0.0.1"));
+    EXPECT_TRUE(mgr.createSession(sid(2), "10.0.0.2"));
+    EXPECT_TRUE(mgr.authenticateSession(sid(2), testClaims("bob"), 2));
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    auto expired = mgr.findExpiredAuthSessions(std::chrono::seconds{0});
+    ASSERT_EQ(expired.size(), 1u);
+    EXPECT_EQ(expired[0], sid(1));
+
+    EXPECT_TRUE(mgr.authenticateSession(sid(1), testClaims("alice"), 1));
+    EXPECT_TRUE(mgr.findExpiredAuthSessions(std::chrono::seconds{0}).empty());
+}
+
+TEST_F(GatewaySessionManagerTest, StateCountsFollowTransitions) {
+    for (uint64_t id = 1; id <= 40; ++id) {
+        EXPECT_TRUE(mgr.createSession(sid(id), "10.0.0.1"));
+    }
+    for (uint64_t id = 1; id <= 10; ++id) {
+        EXPECT_TRUE(mgr.authenticateSession(sid(id), testClaims("p"), id));
+    }
+    EXPECT_TRUE(mgr.beginMigration(sid(1), "game-2"));
+    mgr.removeSession(sid(2));
+    mgr.removeSession(sid(40));
+
+    EXPECT_EQ(mgr.sessionCount(), 38u);
+    EXPECT_EQ(mgr.sessionCount(ClientState::Unauthenticated), 29u);
+    EXPECT_EQ(mgr.sessionCount(ClientState::Authenticated), 8u);
+    EXPECT_EQ(mgr.sessionCount(ClientState::Migrating), 1u);
+    EXPECT_EQ(mgr.getSessionsByState(ClientState::Authenticated).size(), 8u);
+}
+
+TEST(GatewaySessionManagerCapacityTest, ConcurrentCreatesRespectCapacity) {
+    GatewaySessionManager mgr{64};
+    std::atomic<uint32_t> created{0};
+    std::vector<std::thread> threads;
+    for (uint64_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            for (uint64_t i = 0; i < 50; ++i) {
+                if (mgr.createSession(SessionId(t * 1000 + i + 1), "10.0.0.1")) {
+                    created.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(created.load(), 64u);
+    EXPECT_EQ(mgr.sessionCount(), 64u);
+}
+
+// =============================================================================
+// ServiceLink tests
+// =============================================================================
+
+namespace {
+
+struct CapturedFrame {
+    SessionId sessionId;
+    uint16_t opcode;
+    std::vector<uint8_t> payload;
+};
+
+// Concatenate gather chunks as a socket would put them on the wire.
+std::vector<uint8_t> joinChunks(std::span<const std::span<const uint8_t>> chunks) {
+    std::vector<uint8_t> bytes;
+    for (auto chunk : chunks) {
+        bytes.insert(bytes.end(), chunk.begin(), chunk.end());
+    }
+    return bytes;
+}
+
+}  // namespace
+
+TEST(ServiceLinkTest, FlushGathersHeadersAndPayloadsWithoutCopying) {
+    const std::vector<uint8_t> first{1, 2, 3};
+    const std::vector<uint8_t> second{4, 5};
+    std::vector<const uint8_t*> payloadPointers;
+    std::vector<uint8_t> wire;
+
+    ServiceLink link([&](std::span<const std::span<const uint8_t>> chunks) {
+        for (auto chunk : chunks) {
+            if (chunk.size() != ServiceLink::kHeaderSize) {
+                payloadPointers.push_back(chunk.data());
+            }
+        }
+        wire = joinChunks(chunks);
+    });
+
+    link.forward(SessionId(7), 0x0150, first);
+    link.forward(SessionId(8), 0x0151, second);
+    EXPECT_EQ(link.pendingFrames(), 2u);
+    EXPECT_EQ(link.flush(), 2u);
+    EXPECT_EQ(link.pendingFrames(), 0u);
+    EXPECT_EQ(link.framesForwarded(), 2u);
+
+    // Payloads reach the writer as views of the caller's buffers.
+    ASSERT_EQ(payloadPointers.size(), 2u);
+    EXPECT_EQ(payloadPointers[0], first.data());
+    EXPECT_EQ(payloadPointers[1], second.data());
+
+    ASSERT_EQ(wire.size(), 2 * ServiceLink::kHeaderSize + 5);
+    EXPECT_EQ(wire[3], ServiceLink::kHeaderSize + 3);  // length covers the frame
+    EXPECT_EQ(wire[11], 7);                            // session id
+    EXPECT_EQ(wire[12], 0x01);                         // opcode
+    EXPECT_EQ(wire[13], 0x50);
+    EXPECT_EQ(link.flush(), 0u);
+}
+
+TEST(ServiceLinkTest, ReceiveDemultiplexesFramesSplitAcrossReads) {
+    std::vector<uint8_t> wire;
+    ServiceLink sender([&](std::span<const std::span<const uint8_t>> chunks) {
+        wire = joinChunks(chunks);
+    });
+    const std::vector<uint8_t> payload{9, 8, 7, 6};
+    sender.forward(SessionId(1), 0x0200, payload);
+    sender.forward(SessionId(0x0102030405060708ULL), 0x0201, {});
+    sender.forward(SessionId(3), 0x0202, payload);
+    sender.flush();
+
+    // Feed one byte at a time, then everything at once: same frames.
+    for (std::size_t step : {std::size_t{1}, wire.size()}) {
+        ServiceLink receiver([](std::span<const std::span<const uint8_t>>) {});
+        std::vector<CapturedFrame> frames;
+        auto onFrame = [&](SessionId sid, uint16_t opcode, std::span<const uint8_t> bytes) {
+            frames.push_back({sid, opcode, {bytes.begin(), bytes.end()}});
+        };
+        for (std::size_t offset = 0; offset < wire.size(); offset += step) {
+            const std::size_t n = std::min(step, wire.size() - offset);
+            ASSERT_TRUE(receiver.receive(std::span<const uint8_t>(wire).subspan(offset, n), onFrame));
+        }
+
+        ASSERT_EQ(frames.size(), 3u);
+        EXPECT_EQ(frames[0].sessionId, SessionId(1));
+        EXPECT_EQ(frames[0].opcode, 0x0200);
+        EXPECT_EQ(frames[0].payload, payload);
+        EXPECT_EQ(frames[1].sessionId, SessionId(0x0102030405060708ULL));
+        EXPECT_TRUE(frames[1].payload.empty());
+        EXPECT_EQ(frames[2].opcode, 0x0202);
+    }
+}
+
+TEST(ServiceLinkTest, ReceiveRejectsMalformedLength) {
+    ServiceLink link([](std::span<const std::span<const uint8_t>>) {});
+    int frames = 0;
+    auto onFrame = [&](SessionId, uint16_t, std::span<const uint8_t>) { ++frames; };
+
+    const std::vector<uint8_t> tooShort{0, 0, 0, 5, 0, 0};
+    EXPECT_FALSE(link.receive(tooShort, onFrame));
+    EXPECT_EQ(frames, 0);
+}
+
 // =============================================================================
 // Integration: session lifecycle with state transitions
 // =============================================================================
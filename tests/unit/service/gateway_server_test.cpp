@@ -10,6 +10,7 @@
 
 #include <chrono>
 #include <memory>
+#include <span>
 #include <string>
 #include <thread>
 #include <vector>
@@ -261,6 +262,107 @@ TEST_F(GatewayServerTest, MessageToNonexistentSession) {
     EXPECT_EQ(result.error().code(), ErrorCode::SessionNotFound);
 }
 
+TEST_F(GatewayServerTest, HandleMessageThroughSessionHandle) {
+    ASSERT_TRUE(gateway_->handleConnect(sid(1), "10.0.0.1").hasValue());
+    auto session = gateway_->sessionHandle(sid(1));
+    ASSERT_TRUE(session.open());
+    EXPECT_EQ(session.remoteAddress(), "10.0.0.1");
+
+    auto denied = gateway_->handleMessage(session, 0x0150, {});
+    EXPECT_TRUE(denied.hasError());
+    EXPECT_EQ(denied.error().code(), ErrorCode::ClientNotAuthenticated);
+
+    ASSERT_TRUE(gateway_->handleMessage(session, GatewayOpcode::Authenticate, tokenPayload())
+                    .hasValue());
+    EXPECT_EQ(session.state(), ClientState::Authenticated);
+
+    auto routed = gateway_->handleMessage(session, 0x0150, {});
+    ASSERT_TRUE(routed.hasValue());
+    EXPECT_EQ(routed.value().type, GatewayActionType::Forward);
+    EXPECT_EQ(routed.value().targetService, "game");
+}
+
+TEST_F(GatewayServerTest, SessionHandleClosedOnDisconnect) {
+    ASSERT_TRUE(gateway_->handleConnect(sid(1), "10.0.0.1").hasValue());
+    auto session = gateway_->sessionHandle(sid(1));
+    gateway_->handleDisconnect(sid(1));
+
+    EXPECT_FALSE(session.open());
+    auto result = gateway_->handleMessage(session, 0x0350, {});
+    EXPECT_TRUE(result.hasError());
+    EXPECT_EQ(result.error().code(), ErrorCode::SessionNotFound);
+    EXPECT_FALSE(gateway_->sessionHandle(sid(1)));
+}
+
+TEST_F(GatewayServerTest, RouteMessageForwardsOntoServiceLink) {
+    GatewayConfig config;
+    config.rateLimitCapacity = 50;
+    GatewayServer gateway(config, authServer_);
+    gateway.addRoute(0x0100, 0x01FF, "game");
+    gateway.addRoute(0x0300, 0x03FF, "chat", false);
+
+    std::vector<std::vector<uint8_t>> written;
+    auto writer = [&](std::span<const std::span<const uint8_t>> chunks) {
+        for (auto chunk : chunks) {
+            written.emplace_back(chunk.begin(), chunk.end());
+        }
+    };
+    auto& gameLink = gateway.addServiceLink("game", writer);
+    ASSERT_TRUE(gateway.start().hasValue());
+
+    ASSERT_TRUE(gateway.handleConnect(sid(1), "10.0.0.1").hasValue());
+    auto session = gateway.sessionHandle(sid(1));
+    ASSERT_TRUE(
+        gateway.routeMessage(session, GatewayOpcode::Authenticate, tokenPayload()).hasValue());
+
+    const std::vector<uint8_t> payload{0xAA, 0xBB};
+    auto toGame = gateway.routeMessage(session, 0x0150, payload);
+    ASSERT_TRUE(toGame.hasValue());
+    EXPECT_EQ(toGame.value().type, GatewayActionType::Forward);
+    EXPECT_EQ(toGame.value().targetService, "game");
+    EXPECT_EQ(gameLink.pendingFrames(), 1u);
+
+    // "chat" has no link: the decision is returned, nothing is queued.
+    auto toChat = gateway.routeMessage(session, 0x0350, payload);
+    ASSERT_TRUE(toChat.hasValue());
+    EXPECT_EQ(toChat.value().targetService, "chat");
+    EXPECT_EQ(gameLink.pendingFrames(), 1u);
+
+    EXPECT_EQ(gateway.flushServiceLinks(), 1u);
+    ASSERT_EQ(written.size(), 2u);  // header, payload
+    EXPECT_EQ(written[0].size(), ServiceLink::kHeaderSize);
+    EXPECT_EQ(written[1], payload);
+}
+
+TEST_F(GatewayServerTest, ServiceLinksPlaceSessionsAndDrain) {
+    GatewayServer gateway(GatewayConfig{}, authServer_);
+    gateway.addRoute(0x0300, 0x03FF, "chat", false);
+    auto& first = gateway.addServiceLink("chat", [](auto) {});
+    auto& second = gateway.addServiceLink("chat", [](auto) {});
+    ASSERT_TRUE(gateway.start().hasValue());
+
+    constexpr uint64_t kSessions = 200;
+    for (uint64_t id = 1; id <= kSessions; ++id) {
+        ASSERT_TRUE(gateway.handleConnect(sid(id), "10.0.0." + std::to_string(id)).hasValue());
+        ASSERT_TRUE(gateway.routeMessage(gateway.sessionHandle(sid(id)), 0x0300, {}).hasValue());
+    }
+    EXPECT_EQ(first.pendingFrames() + second.pendingFrames(), kSessions);
+    EXPECT_GT(first.pendingFrames(), kSessions / 4);
+    EXPECT_GT(second.pendingFrames(), kSessions / 4);
+    gateway.flushServiceLinks();
+
+    // Draining the first link moves every session to the second.
+    auto* placement = gateway.serviceLinkPlacement("chat");
+    ASSERT_NE(placement, nullptr);
+    ASSERT_TRUE(placement->setState(0, PlacementNodeState::Draining));
+    for (uint64_t id = 1; id <= kSessions; ++id) {
+        ASSERT_TRUE(gateway.routeMessage(gateway.sessionHandle(sid(id)), 0x0300, {}).hasValue());
+    }
+    EXPECT_EQ(first.pendingFrames(), 0u);
+    EXPECT_EQ(second.pendingFrames(), kSessions);
+    EXPECT_EQ(gateway.serviceLinkPlacement("lobby"), nullptr);
+}
+
 // =============================================================================
 // Migration tests (SRS-SVC-002.4)
 // =============================================================================
@@ -338,6 +440,30 @@ TEST_F(GatewayServerTest, RateLimitExceeded) {
     EXPECT_GT(limitedGw->stats().rateLimitHits, 0u);
 }
 
+TEST_F(GatewayServerTest, RateLimitSharedBySessionsFromOneAddress) {
+    GatewayConfig limitedConfig;
+    limitedConfig.rateLimitCapacity = 4;
+    limitedConfig.rateLimitRefillRate = 1;
+
+    auto limitedGw = std::make_unique<GatewayServer>(std::move(limitedConfig), authServer_);
+    limitedGw->addRoute(0x0300, 0x03FF, "chat", false);
+    ASSERT_TRUE(limitedGw->start().hasValue());
+
+    ASSERT_TRUE(limitedGw->handleConnect(sid(1), "10.0.0.1").hasValue());
+    ASSERT_TRUE(limitedGw->handleConnect(sid(2), "10.0.0.1").hasValue());
+    ASSERT_TRUE(limitedGw->handleConnect(sid(3), "10.0.0.2").hasValue());
+    auto first = limitedGw->sessionHandle(sid(1));
+    auto second = limitedGw->sessionHandle(sid(2));
+
+    for (int i = 0; i < 2; ++i) {
+        ASSERT_TRUE(limitedGw->handleMessage(first, 0x0350, {}).hasValue());
+        ASSERT_TRUE(limitedGw->handleMessage(second, 0x0350, {}).hasValue());
+    }
+    EXPECT_TRUE(limitedGw->handleMessage(first, 0x0350, {}).hasError());
+    EXPECT_TRUE(limitedGw->handleMessage(sid(2), 0x0350, {}).hasError());
+    EXPECT_TRUE(limitedGw->handleMessage(sid(3), 0x0350, {}).hasValue());
+}
+
 // =============================================================================
 // Heartbeat tests
 // =============================================================================
@@ -0,0 +1,280 @@
+#include <gtest/gtest.h>
+
+#include "cgs/foundation/error_code.hpp"
+#include "cgs/foundation/types.hpp"
+#include "cgs/service/game_server.hpp"
+#include "cgs/service/instance_migration.hpp"
+#include "cgs/service/map_instance_manager.hpp"
+
+#include <memory>
+#include <vector>
+
+using namespace cgs::service;
+using cgs::foundation::ErrorCode;
+using cgs::foundation::PlayerId;
+
+// =============================================================================
+// Chunk encoding
+// =============================================================================
+
+TEST(InstanceMigrationChunkTest, RoundTrips) {
+    InstanceMigrationChunk chunk;
+    chunk.sequence = 3;
+    chunk.final = true;
+    chunk.mapId = 7;
+    chunk.type = cgs::game::MapType::Battleground;
+    chunk.maxPlayers = 25;
+
+    MigratedEntity zone;
+    zone.key = 4;
+    zone.kind = MigratedKind::Zone;
+    zone.zoneId = 2;
+    zone.zoneFlags = cgs::game::ZoneFlags::Sanctuary;
+    chunk.upserts.push_back(zone);
+
+    MigratedEntity player;
+    player.key = 9;
+    player.kind = MigratedKind::Player;
+    player.playerId = 42;
+    player.identity.name = "Ayla";
+    player.transform.position = {1.0f, 2.0f, 3.0f};
+    player.stats.health = 77;
+    player.stats.attributes[2] = -5;
+    player.movement.speed = 3.5f;
+    player.memberZoneId = 2;
+    chunk.upserts.push_back(player);
+    chunk.removed = {1, 5};
+
+    auto decoded = decodeMigrationChunk(encodeMigrationChunk(chunk));
+    ASSERT_TRUE(decoded.hasValue());
+    const auto& out = decoded.value();
+    EXPECT_EQ(out.sequence, 3u);
+    EXPECT_TRUE(out.final);
+    EXPECT_EQ(out.mapId, 7u);
+    EXPECT_EQ(out.type, cgs::game::MapType::Battleground);
+    EXPECT_EQ(out.maxPlayers, 25u);
+    ASSERT_EQ(out.upserts.size(), 2u);
+    EXPECT_EQ(out.upserts[0].kind, MigratedKind::Zone);
+    EXPECT_EQ(out.upserts[0].zoneFlags, cgs::game::ZoneFlags::Sanctuary);
+    EXPECT_EQ(out.upserts[1].playerId, 42u);
+    EXPECT_EQ(out.upserts[1].identity.name, "Ayla");
+    EXPECT_FLOAT_EQ(out.upserts[1].transform.position.z, 3.0f);
+    EXPECT_EQ(out.upserts[1].stats.health, 77);
+    EXPECT_EQ(out.upserts[1].stats.attributes[2], -5);
+    EXPECT_FLOAT_EQ(out.upserts[1].movement.speed, 3.5f);
+    EXPECT_EQ(out.upserts[1].memberZoneId, 2u);
+    EXPECT_EQ(out.removed, (std::vector<uint32_t>{1, 5}));
+}
+
+TEST(InstanceMigrationChunkTest, RejectsTruncatedInput) {
+    InstanceMigrationChunk chunk;
+    chunk.upserts.resize(2);
+    auto bytes = encodeMigrationChunk(chunk);
+
+    for (std::size_t size : {std::size_t{0}, std::size_t{4}, bytes.size() - 1}) {
+        auto decoded = decodeMigrationChunk(std::span<const uint8_t>(bytes.data(), size));
+        ASSERT_TRUE(decoded.hasError());
+        EXPECT_EQ(decoded.error().code(), ErrorCode::SerializationError);
+    }
+}
+
+// =============================================================================
+// Server to server
+// =============================================================================
+
+class InstanceMigrationTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        source_ = std::make_unique<GameServer>(GameServerConfig{});
+        target_ = std::make_unique<GameServer>(GameServerConfig{});
+        ASSERT_TRUE(source_->registerInstanceTemplate(kMap, dungeon()).hasValue());
+        ASSERT_TRUE(target_->registerInstanceTemplate(kMap, dungeon()).hasValue());
+    }
+
+    static InstanceTemplate dungeon() {
+        InstanceTemplate tmpl;
+        tmpl.maxPlayers = 5;
+        tmpl.warmCount = 1;
+        tmpl.zones.resize(2);
+        tmpl.zones[0].zoneId = 1;
+        tmpl.zones[1].zoneId = 2;
+        tmpl.npcs.resize(3);
+        for (auto& npc : tmpl.npcs) {
+            npc.identity.type = cgs::game::ObjectType::Creature;
+            npc.identity.entry = 100;
+        }
+        return tmpl;
+    }
+
+    /// A source instance with two players in it.
+    uint32_t populated() {
+        auto id = source_->acquireInstance(kMap);
+        EXPECT_TRUE(id.hasValue());
+        EXPECT_TRUE(source_->addPlayer(PlayerId(1), id.value()).hasValue());
+        EXPECT_TRUE(source_->addPlayer(PlayerId(2), id.value()).hasValue());
+        return id.value();
+    }
+
+    static constexpr uint32_t kMap = 9;
+
+    std::unique_ptr<GameServer> source_;
+    std::unique_ptr<GameServer> target_;
+};
+
+TEST_F(InstanceMigrationTest, MovesInstanceWithPlayers) {
+    const uint32_t id = populated();
+    const auto sourceEntities = source_->stats().entityCount;
+    const auto targetEntities = target_->stats().entityCount;
+
+    auto snapshot = source_->beginInstanceExport(id);
+    ASSERT_TRUE(snapshot.hasValue());
+    EXPECT_EQ(source_->stats().migratingInstances, 1u);
+    EXPECT_TRUE(source_->getPlayerSession(PlayerId(1)).has_value());
+
+    auto newId = target_->importInstance(snapshot.value());
+    ASSERT_TRUE(newId.hasValue());
+    EXPECT_EQ(target_->stats().migratingInstances, 1u);
+    // Map entity, 2 zones, 3 NPCs and 2 players.
+    EXPECT_EQ(target_->stats().entityCount, targetEntities + 8);
+    EXPECT_FALSE(target_->getPlayerSession(PlayerId(1)).has_value());
+
+    auto final = source_->finishInstanceExport(id);
+    ASSERT_TRUE(final.hasValue());
+    ASSERT_TRUE(target_->applyInstanceChunk(newId.value(), final.value()).hasValue());
+
+    EXPECT_EQ(source_->stats().entityCount, sourceEntities - 8);
+    EXPECT_FALSE(source_->getPlayerSession(PlayerId(1)).has_value());
+    EXPECT_TRUE(source_->instancePlayers(id).empty());
+
+    auto session = target_->getPlayerSession(PlayerId(2));
+    ASSERT_TRUE(session.has_value());
+    EXPECT_EQ(session->instanceId, newId.value());
+    EXPECT_EQ(target_->instancePlayers(newId.value()).size(), 2u);
+    EXPECT_EQ(target_->stats().migratingInstances, 0u);
+    EXPECT_EQ(target_->stats().activeInstances, 1u);
+    EXPECT_TRUE(target_->tick().hasValue());
+}
+
+TEST_F(InstanceMigrationTest, DeltasCarryOnlyChanges) {
+    const uint32_t id = populated();
+    auto snapshot = source_->beginInstanceExport(id);
+    ASSERT_TRUE(snapshot.hasValue());
+    auto newId = target_->importInstance(snapshot.value());
+    ASSERT_TRUE(newId.hasValue());
+    const auto imported = target_->stats().entityCount;
+
+    auto idle = source_->exportInstanceDelta(id);
+    ASSERT_TRUE(idle.hasValue());
+    auto decoded = decodeMigrationChunk(idle.value());
+    ASSERT_TRUE(decoded.hasValue());
+    EXPECT_TRUE(decoded.value().upserts.empty());
+    EXPECT_TRUE(decoded.value().removed.empty());
+    ASSERT_TRUE(target_->applyInstanceChunk(newId.value(), idle.value()).hasValue());
+
+    // A player leaving mid-migration is replicated as a removal.
+    ASSERT_TRUE(source_->removePlayer(PlayerId(1)).hasValue());
+    auto left = source_->exportInstanceDelta(id);
+    ASSERT_TRUE(left.hasValue());
+    decoded = decodeMigrationChunk(left.value());
+    ASSERT_TRUE(decoded.hasValue());
+    EXPECT_EQ(decoded.value().removed.size(), 1u);
+    ASSERT_TRUE(target_->applyInstanceChunk(newId.value(), left.value()).hasValue());
+    EXPECT_EQ(target_->stats().entityCount, imported - 1);
+
+    auto final = source_->finishInstanceExport(id);
+    ASSERT_TRUE(final.hasValue());
+    ASSERT_TRUE(target_->applyInstanceChunk(newId.value(), final.value()).hasValue());
+    EXPECT_FALSE(target_->getPlayerSession(PlayerId(1)).has_value());
+    EXPECT_TRUE(target_->getPlayerSession(PlayerId(2)).has_value());
+}
+
+TEST_F(InstanceMigrationTest, RejectsChunksOutOfSequence) {
+    const uint32_t id = populated();
+    auto snapshot = source_->beginInstanceExport(id);
+    ASSERT_TRUE(snapshot.hasValue());
+    auto newId = target_->importInstance(snapshot.value());
+    ASSERT_TRUE(newId.hasValue());
+
+    auto first = source_->exportInstanceDelta(id);
+    auto second = source_->exportInstanceDelta(id);
+    ASSERT_TRUE(first.hasValue());
+    ASSERT_TRUE(second.hasValue());
+
+    auto skipped = target_->applyInstanceChunk(newId.value(), second.value());
+    ASSERT_TRUE(skipped.hasError());
+    EXPECT_EQ(skipped.error().code(), ErrorCode::MapInstanceInvalidState);
+    EXPECT_TRUE(target_->applyInstanceChunk(newId.value(), first.value()).hasValue());
+    EXPECT_TRUE(target_->applyInstanceChunk(newId.value(), second.value()).hasValue());
+
+    // Only snapshots start an import.
+    auto notSnapshot = target_->importInstance(first.value());
+    ASSERT_TRUE(notSnapshot.hasError());
+    EXPECT_EQ(notSnapshot.error().code(), ErrorCode::MapInstanceInvalidState);
+}
+
+TEST_F(InstanceMigrationTest, ReUpsertedNpcIsReindexed) {
+    MigratedEntity npc;
+    npc.key = 1;
+    npc.kind = MigratedKind::Npc;
+    npc.transform.position = {10.0f, 0.0f, 10.0f};
+
+    InstanceMigrationChunk snapshot;
+    snapshot.mapId = kMap;
+    snapshot.upserts.push_back(npc);
+    auto newId = target_->importInstance(encodeMigrationChunk(snapshot));
+    ASSERT_TRUE(newId.hasValue());
+    ASSERT_TRUE(target_->tick().hasValue());
+
+    const cgs::game::Vector3 before{10.0f, 0.0f, 10.0f};
+    const cgs::game::Vector3 after{200.0f, 0.0f, 200.0f};
+    ASSERT_EQ(target_->entitiesNear(newId.value(), before, 1.0f).size(), 1u);
+
+    InstanceMigrationChunk delta;
+    delta.sequence = 1;
+    delta.mapId = kMap;
+    npc.transform.position = after;
+    delta.upserts.push_back(npc);
+    ASSERT_TRUE(target_->applyInstanceChunk(newId.value(), encodeMigrationChunk(delta))
+                    .hasValue());
+    ASSERT_TRUE(target_->tick().hasValue());
+
+    EXPECT_TRUE(target_->entitiesNear(newId.value(), before, 1.0f).empty());
+    EXPECT_EQ(target_->entitiesNear(newId.value(), after, 1.0f).size(), 1u);
+}
+
+TEST_F(InstanceMigrationTest, MigratingInstanceTakesNoNewPlayers) {
+    const uint32_t id = populated();
+    ASSERT_TRUE(source_->beginInstanceExport(id).hasValue());
+
+    auto joined = source_->addPlayer(PlayerId(3), id);
+    ASSERT_TRUE(joined.hasError());
+    EXPECT_EQ(joined.error().code(), ErrorCode::InstanceFull);
+
+    auto again = source_->beginInstanceExport(id);
+    ASSERT_TRUE(again.hasError());
+    EXPECT_EQ(again.error().code(), ErrorCode::MapInstanceInvalidState);
+}
+
+TEST_F(InstanceMigrationTest, CancelReturnsInstanceToActive) {
+    const uint32_t id = populated();
+    ASSERT_TRUE(source_->beginInstanceExport(id).hasValue());
+    ASSERT_TRUE(source_->cancelInstanceExport(id).hasValue());
+
+    EXPECT_EQ(source_->stats().migratingInstances, 0u);
+    EXPECT_TRUE(source_->addPlayer(PlayerId(3), id).hasValue());
+    EXPECT_TRUE(source_->exportInstanceDelta(id).hasError());
+    EXPECT_TRUE(source_->cancelInstanceExport(id).hasError());
+}
+
+TEST_F(InstanceMigrationTest, AbandonedImportCanBeDestroyed) {
+    const uint32_t id = populated();
+    const auto targetEntities = target_->stats().entityCount;
+    auto snapshot = source_->beginInstanceExport(id);
+    ASSERT_TRUE(snapshot.hasValue());
+    auto newId = target_->importInstance(snapshot.value());
+    ASSERT_TRUE(newId.hasValue());
+
+    ASSERT_TRUE(target_->destroyInstance(newId.value()).hasValue());
+    EXPECT_EQ(target_->stats().entityCount, targetEntities);
+    EXPECT_TRUE(target_->applyInstanceChunk(newId.value(), snapshot.value()).hasError());
+}
@@ -191,6 +191,50 @@ TEST_F(LobbyServerTest, DequeuePartyNotFoundFails) {
     EXPECT_EQ(result.error().code(), ErrorCode::PartyNotFound);
 }
 
+TEST_F(LobbyServerTest, QueuedPartyTracksMemberChanges) {
+    auto partyId = lobby_->createParty(1, "Alice", makeRating(1500));
+    (void)lobby_->addPartyMember(partyId.value(), 2, "Bob", makeRating(1600));
+    ASSERT_TRUE(lobby_->enqueueParty(partyId.value()).hasValue());
+
+    ASSERT_TRUE(lobby_->addPartyMember(partyId.value(), 3, "Carol", makeRating(1700)).hasValue());
+    EXPECT_TRUE(lobby_->isPlayerQueued(3));
+    EXPECT_EQ(lobby_->partySummary(partyId.value())->averageRating, 1600);
+
+    ASSERT_TRUE(lobby_->removePartyMember(partyId.value(), 2).hasValue());
+    EXPECT_FALSE(lobby_->isPlayerQueued(2));
+    EXPECT_TRUE(lobby_->isPlayerQueued(1));
+    EXPECT_TRUE(lobby_->isPlayerQueued(3));
+}
+
+TEST_F(LobbyServerTest, QueuedPartyLeaderLeavingDequeuesAll) {
+    auto partyId = lobby_->createParty(1, "Alice", makeRating(1500));
+    (void)lobby_->addPartyMember(partyId.value(), 2, "Bob", makeRating(1600));
+    ASSERT_TRUE(lobby_->enqueueParty(partyId.value()).hasValue());
+
+    ASSERT_TRUE(lobby_->removePartyMember(partyId.value(), 1).hasValue());
+    EXPECT_FALSE(lobby_->isPlayerQueued(1));
+    EXPECT_FALSE(lobby_->isPlayerQueued(2));
+}
+
+TEST_F(LobbyServerTest, DisbandQueuedPartyDequeuesMembers) {
+    auto partyId = lobby_->createParty(1, "Alice", makeRating(1500));
+    (void)lobby_->addPartyMember(partyId.value(), 2, "Bob", makeRating(1600));
+    ASSERT_TRUE(lobby_->enqueueParty(partyId.value()).hasValue());
+
+    ASSERT_TRUE(lobby_->disbandParty(partyId.value(), 1).hasValue());
+    EXPECT_FALSE(lobby_->isPlayerQueued(1));
+    EXPECT_FALSE(lobby_->isPlayerQueued(2));
+}
+
+TEST_F(LobbyServerTest, UnqueuedPartyMemberChangesLeaveQueueAlone) {
+    auto partyId = lobby_->createParty(1, "Alice", makeRating(1500));
+    (void)lobby_->addPartyMember(partyId.value(), 2, "Bob", makeRating(1600));
+    EXPECT_FALSE(lobby_->isPlayerQueued(2));
+
+    ASSERT_TRUE(lobby_->setPartyMemberReady(partyId.value(), 2, true).hasValue());
+    EXPECT_EQ(lobby_->partySummary(partyId.value())->readyCount, 2u);
+}
+
 // -- Match processing ---------------------------------------------------------
 
 TEST_F(LobbyServerTest, ProcessMatchmakingFormsMatch) {
@@ -218,6 +262,50 @@ TEST_F(LobbyServerTest, ProcessMatchmakingMultipleMatches) {
     EXPECT_EQ(matches.size(), 2u);
 }
 
+TEST_F(LobbyServerTest, ProcessMatchmakingPlacesMatchOnGameServer) {
+    auto matches = lobby_->processMatchmaking();
+    EXPECT_TRUE(matches.empty());
+
+    (void)lobby_->enqueuePlayer(1, makeRating(1500));
+    (void)lobby_->enqueuePlayer(2, makeRating(1510));
+    matches = lobby_->processMatchmaking();
+    ASSERT_EQ(matches.size(), 1u);
+    EXPECT_TRUE(matches[0].gameServer.empty());  // no servers registered
+
+    auto drained = lobby_->gameServers().addNode("game-1");
+    ASSERT_TRUE(drained.has_value());
+    ASSERT_TRUE(lobby_->gameServers().addNode("game-2").has_value());
+    ASSERT_TRUE(lobby_->gameServers().setState(*drained, PlacementNodeState::Draining));
+
+    (void)lobby_->enqueuePlayer(3, makeRating(1500));
+    (void)lobby_->enqueuePlayer(4, makeRating(1510));
+    matches = lobby_->processMatchmaking();
+    ASSERT_EQ(matches.size(), 1u);
+    EXPECT_EQ(matches[0].gameServer, "game-2");
+}
+
+TEST_F(LobbyServerTest, ProcessMatchmakingRunsShardsThroughExecutor) {
+    std::size_t jobs = 0;
+    lobby_->setMatchmakingExecutor([&](const std::vector<std::function<void()>>& batch) {
+        for (const auto& job : batch) {
+            job();
+            ++jobs;
+        }
+    });
+    (void)lobby_->enqueuePlayer(1, makeRating(1500), GameMode::Arena, Region::EU);
+    (void)lobby_->enqueuePlayer(2, makeRating(1510), GameMode::Arena, Region::EU);
+
+    auto matches = lobby_->processMatchmaking();
+    ASSERT_EQ(matches.size(), 1u);
+    EXPECT_EQ(jobs, MatchmakingEngine::kShards);
+
+    uint64_t formed = 0;
+    for (const auto& shard : lobby_->matchmakingStats()) {
+        formed += shard.matchesFormed;
+    }
+    EXPECT_EQ(formed, 1u);
+}
+
 // -- ELO updates --------------------------------------------------------------
 
 TEST_F(LobbyServerTest, UpdateRatingsWinnerGains) {
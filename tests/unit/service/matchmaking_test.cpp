@@ -5,11 +5,13 @@
 
 #include <chrono>
 #include <cmath>
+#include <set>
 #include <thread>
 #include <vector>
 
 #include "cgs/service/elo_calculator.hpp"
 #include "cgs/service/lobby_types.hpp"
+#include "cgs/service/matchmaking_engine.hpp"
 #include "cgs/service/matchmaking_queue.hpp"
 
 using namespace cgs::service;
@@ -161,6 +163,74 @@ TEST(LobbyTypesTest, QueueConfigDefaults) {
     EXPECT_EQ(config.expansionStep, 50);
     EXPECT_EQ(config.expansionInterval.count(), 10);
     EXPECT_EQ(config.maxQueueSize, 10000u);
+    EXPECT_EQ(config.teamCount, 2u);
+}
+
+TEST_F(EloCalculatorTest, ExpectedScoresMatchScalar) {
+    std::vector<int32_t> a{1500, 1600, 1200, 2000, 1500};
+    std::vector<int32_t> b{1500, 1400, 1800, 1000, 1900};
+    std::vector<float> out(a.size());
+    EloCalculator::expectedScores(a, b, out);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        EXPECT_NEAR(out[i], EloCalculator::expectedScore(a[i], b[i]), 1e-5f);
+    }
+}
+
+TEST_F(EloCalculatorTest, ExpectedScoresStopsAtShortestSpan) {
+    std::vector<int32_t> a{1500, 1600, 1700};
+    std::vector<int32_t> b{1500, 1600};
+    std::vector<float> out(3, -1.0f);
+    EloCalculator::expectedScores(a, b, out);
+    EXPECT_NEAR(out[0], 0.5f, 1e-5f);
+    EXPECT_FLOAT_EQ(out[2], -1.0f);
+}
+
+TEST_F(EloCalculatorTest, BalanceTeamsSplitsEvenly) {
+    // Greedy placement leaves 4450 vs 4350; a swap reaches equal sums.
+    std::vector<int32_t> ratings{1600, 1550, 1500, 1450, 1400, 1300};
+    auto teams = EloCalculator::balanceTeams(ratings, 2);
+    ASSERT_EQ(teams.size(), ratings.size());
+
+    int32_t sums[2] = {0, 0};
+    int counts[2] = {0, 0};
+    for (std::size_t i = 0; i < ratings.size(); ++i) {
+        ASSERT_LT(teams[i], 2u);
+        sums[teams[i]] += ratings[i];
+        ++counts[teams[i]];
+    }
+    EXPECT_EQ(counts[0], 3);
+    EXPECT_EQ(counts[1], 3);
+    EXPECT_EQ(sums[0], sums[1]);
+    EXPECT_FLOAT_EQ(EloCalculator::teamBalance(ratings, teams, 2), 1.0f);
+}
+
+TEST_F(EloCalculatorTest, BalanceTeamsUnevenSizes) {
+    std::vector<int32_t> ratings{1500, 1500, 1500, 1500, 1500, 1500, 1500};
+    auto teams = EloCalculator::balanceTeams(ratings, 3);
+    ASSERT_EQ(teams.size(), 7u);
+    int counts[3] = {0, 0, 0};
+    for (auto t : teams) {
+        ++counts[t];
+    }
+    EXPECT_EQ(counts[0], 3);
+    EXPECT_EQ(counts[1], 2);
+    EXPECT_EQ(counts[2], 2);
+}
+
+TEST_F(EloCalculatorTest, BalanceTeamsNeedsEnoughPlayers) {
+    std::vector<int32_t> ratings{1500, 1600};
+    EXPECT_TRUE(EloCalculator::balanceTeams(ratings, 3).empty());
+    EXPECT_TRUE(EloCalculator::balanceTeams(ratings, 1).empty());
+}
+
+TEST_F(EloCalculatorTest, TeamBalanceFallsWithGap) {
+    std::vector<int32_t> ratings{1800, 1700, 1300, 1200};
+    std::vector<uint32_t> even{0, 1, 1, 0};
+    std::vector<uint32_t> lopsided{0, 0, 1, 1};
+    EXPECT_FLOAT_EQ(EloCalculator::teamBalance(ratings, even, 2), 1.0f);
+    float skewed = EloCalculator::teamBalance(ratings, lopsided, 2);
+    EXPECT_LT(skewed, 0.2f);
+    EXPECT_GT(skewed, 0.0f);
 }
 
 // ============================================================================
@@ -449,3 +519,300 @@ TEST_F(MatchmakingQueueTest, ConsecutiveMatchesFromLargerPool) {
     EXPECT_EQ(m2->players.size(), 2u);
     EXPECT_EQ(queue_->queueSize(), 0u);
 }
+
+TEST_F(MatchmakingQueueTest, MatchAllFormsEveryMatchInOnePass) {
+    for (uint64_t id = 1; id <= 10; ++id) {
+        (void)queue_->enqueue(makeTicket(id, 1500 + static_cast<int32_t>(id) * 10));
+    }
+    (void)queue_->enqueue(makeTicket(11, 3000));
+
+    auto matches = queue_->matchAll();
+    EXPECT_EQ(matches.size(), 5u);
+    EXPECT_EQ(queue_->queueSize(), 1u);
+    EXPECT_TRUE(queue_->isQueued(11));
+    EXPECT_TRUE(queue_->matchAll().empty());
+}
+
+TEST_F(MatchmakingQueueTest, AnchorTakesClosestRating) {
+    (void)queue_->enqueue(makeTicket(1, 1500));
+    (void)queue_->enqueue(makeTicket(2, 1590));
+    (void)queue_->enqueue(makeTicket(3, 1505));
+
+    auto match = queue_->tryMatch();
+    ASSERT_TRUE(match.has_value());
+    ASSERT_EQ(match->players.size(), 2u);
+    EXPECT_EQ(match->players[0].playerId, 1u);
+    EXPECT_EQ(match->players[1].playerId, 3u);
+    EXPECT_TRUE(queue_->isQueued(2));
+}
+
+TEST_F(MatchmakingQueueTest, LongestWaitingAnchorFirst) {
+    auto waited = makeTicket(2, 1550);
+    waited.enqueuedAt -= 5s;
+    (void)queue_->enqueue(makeTicket(1, 1500));
+    (void)queue_->enqueue(makeTicket(3, 1600));
+    (void)queue_->enqueue(std::move(waited));
+
+    // Player 2 anchors and takes the closer of 1 (50) and 3 (50): player 1.
+    auto match = queue_->tryMatch();
+    ASSERT_TRUE(match.has_value());
+    EXPECT_EQ(match->players[0].playerId, 2u);
+    EXPECT_EQ(match->players[1].playerId, 1u);
+}
+
+TEST_F(MatchmakingQueueTest, ExpandedToleranceReachesFartherRatings) {
+    // 300 apart: outside the initial 100, inside after 4 expansions.
+    auto waited = makeTicket(1, 1500);
+    waited.enqueuedAt -= 40s;
+    (void)queue_->enqueue(std::move(waited));
+    (void)queue_->enqueue(makeTicket(2, 1800));
+
+    auto matches = queue_->matchAll();
+    ASSERT_EQ(matches.size(), 1u);
+    EXPECT_EQ(queue_->queueSize(), 0u);
+}
+
+TEST_F(MatchmakingQueueTest, MatchAllKeepsModesAndRegionsApart) {
+    (void)queue_->enqueue(makeTicket(1, 1500, GameMode::Duel, Region::EU));
+    (void)queue_->enqueue(makeTicket(2, 1500, GameMode::Duel, Region::Asia));
+    (void)queue_->enqueue(makeTicket(3, 1500, GameMode::Arena, Region::EU));
+    (void)queue_->enqueue(makeTicket(4, 1500, GameMode::Duel, Region::Any));
+
+    auto matches = queue_->matchAll();
+    ASSERT_EQ(matches.size(), 1u);
+    for (const auto& player : matches[0].players) {
+        EXPECT_EQ(player.mode, GameMode::Duel);
+    }
+    EXPECT_EQ(queue_->queueSize(), 2u);
+    EXPECT_TRUE(queue_->isQueued(3));
+}
+
+TEST_F(MatchmakingQueueTest, DequeuedPlayerIsNotMatched) {
+    (void)queue_->enqueue(makeTicket(1, 1500));
+    (void)queue_->enqueue(makeTicket(2, 1510));
+    EXPECT_TRUE(queue_->dequeue(2));
+    EXPECT_FALSE(queue_->tryMatch().has_value());
+
+    (void)queue_->enqueue(makeTicket(2, 1510));
+    EXPECT_TRUE(queue_->tryMatch().has_value());
+}
+
+// ============================================================================
+// MatchmakingEngine Tests
+// ============================================================================
+
+class MatchmakingEngineTest : public ::testing::Test {
+protected:
+    QueueConfig config_;
+
+    void SetUp() override {
+        config_.minPlayersPerMatch = 2;
+        config_.maxPlayersPerMatch = 2;
+        config_.initialRatingTolerance = 100;
+        config_.maxQueueSize = 1000;
+    }
+
+    static MatchmakingTicket makeTicket(uint64_t playerId, int32_t mmr, GameMode mode,
+                                        Region region) {
+        MatchmakingTicket ticket;
+        ticket.playerId = playerId;
+        ticket.rating.mmr = mmr;
+        ticket.mode = mode;
+        ticket.region = region;
+        ticket.enqueuedAt = std::chrono::steady_clock::now();
+        return ticket;
+    }
+};
+
+TEST_F(MatchmakingEngineTest, MatchesEachShardInOneCycle) {
+    MatchmakingEngine engine(config_);
+    uint64_t id = 1;
+    for (auto mode : {GameMode::Duel, GameMode::Arena}) {
+        for (auto region : {Region::EU, Region::Asia, Region::NAWest}) {
+            (void)engine.enqueue(makeTicket(id++, 1500, mode, region));
+            (void)engine.enqueue(makeTicket(id++, 1520, mode, region));
+        }
+    }
+    EXPECT_EQ(engine.queueSize(), 12u);
+
+    EXPECT_EQ(engine.runCycle(), 6u);
+    std::vector<MatchResult> matches;
+    EXPECT_EQ(engine.drainMatches(matches), 6u);
+    EXPECT_EQ(engine.queueSize(), 0u);
+
+    std::set<uint64_t> ids;
+    for (const auto& match : matches) {
+        ids.insert(match.matchId);
+        EXPECT_EQ(match.players[0].mode, match.players[1].mode);
+        EXPECT_EQ(match.players[0].region, match.players[1].region);
+    }
+    EXPECT_EQ(ids.size(), 6u);
+}
+
+TEST_F(MatchmakingEngineTest, RejectsDuplicatesAcrossShards) {
+    MatchmakingEngine engine(config_);
+    ASSERT_TRUE(engine.enqueue(makeTicket(1, 1500, GameMode::Duel, Region::EU)).hasValue());
+    auto dup = engine.enqueue(makeTicket(1, 1500, GameMode::Arena, Region::Asia));
+    ASSERT_TRUE(dup.hasError());
+    EXPECT_EQ(dup.error().code(), cgs::foundation::ErrorCode::AlreadyInQueue);
+
+    EXPECT_TRUE(engine.isQueued(1));
+    EXPECT_TRUE(engine.dequeue(1));
+    EXPECT_FALSE(engine.isQueued(1));
+    EXPECT_EQ(engine.queueSize(), 0u);
+}
+
+TEST_F(MatchmakingEngineTest, QueueLimitSpansShards) {
+    config_.maxQueueSize = 2;
+    MatchmakingEngine engine(config_);
+    ASSERT_TRUE(engine.enqueue(makeTicket(1, 1500, GameMode::Duel, Region::EU)).hasValue());
+    ASSERT_TRUE(engine.enqueue(makeTicket(2, 1500, GameMode::Arena, Region::Asia)).hasValue());
+    auto full = engine.enqueue(makeTicket(3, 1500, GameMode::Raid, Region::Oceania));
+    ASSERT_TRUE(full.hasError());
+    EXPECT_EQ(full.error().code(), cgs::foundation::ErrorCode::QueueFull);
+}
+
+TEST_F(MatchmakingEngineTest, AnyTicketReachesEveryRegionOnce) {
+    MatchmakingEngine engine(config_);
+    (void)engine.enqueue(makeTicket(1, 1500, GameMode::Duel, Region::Any));
+    (void)engine.enqueue(makeTicket(2, 1500, GameMode::Duel, Region::Oceania));
+    (void)engine.enqueue(makeTicket(3, 1500, GameMode::Duel, Region::EU));
+
+    // Ownership rotates one region per cycle; the Any ticket is matched
+    // exactly once, by whichever region claims it first.
+    std::vector<MatchResult> matches;
+    for (std::size_t cycle = 0; cycle < MatchmakingEngine::kRegions; ++cycle) {
+        (void)engine.runCycle();
+        engine.drainMatches(matches);
+    }
+    ASSERT_EQ(matches.size(), 1u);
+    bool hasAny = false;
+    for (const auto& player : matches[0].players) {
+        hasAny = hasAny || player.playerId == 1;
+    }
+    EXPECT_TRUE(hasAny);
+    EXPECT_EQ(engine.queueSize(), 1u);
+}
+
+TEST_F(MatchmakingEngineTest, AnyTicketsMatchEachOther) {
+    MatchmakingEngine engine(config_);
+    (void)engine.enqueue(makeTicket(1, 1500, GameMode::Arena, Region::Any));
+    (void)engine.enqueue(makeTicket(2, 1510, GameMode::Arena, Region::Any));
+
+    EXPECT_EQ(engine.runCycle(), 1u);
+    EXPECT_FALSE(engine.isQueued(1));
+    EXPECT_FALSE(engine.isQueued(2));
+}
+
+TEST_F(MatchmakingEngineTest, FullOutputHoldsMatchesBack) {
+    MatchmakingEngine engine(config_, 2);
+    for (uint64_t id = 1; id <= 8; ++id) {
+        (void)engine.enqueue(makeTicket(id, 1500, GameMode::Duel, Region::EU));
+    }
+
+    EXPECT_EQ(engine.runCycle(), 2u);
+    EXPECT_EQ(engine.runCycle(), 0u);  // Output still full.
+    EXPECT_EQ(engine.queueSize(), 4u);
+
+    std::vector<MatchResult> matches;
+    EXPECT_EQ(engine.drainMatches(matches), 2u);
+    EXPECT_EQ(engine.runCycle(), 2u);
+    EXPECT_EQ(engine.drainMatches(matches), 2u);
+    EXPECT_EQ(engine.queueSize(), 0u);
+}
+
+TEST_F(MatchmakingEngineTest, ParallelExecutorRunsEveryShard) {
+    MatchmakingEngine engine(config_);
+    std::size_t batches = 0;
+    engine.setParallelExecutor([&](const std::vector<std::function<void()>>& jobs) {
+        ++batches;
+        std::vector<std::thread> threads;
+        for (const auto& job : jobs) {
+            threads.emplace_back(job);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    });
+
+    uint64_t id = 1;
+    for (int i = 0; i < 50; ++i) {
+        for (auto region : {Region::NAEast, Region::EU, Region::Asia}) {
+            (void)engine.enqueue(makeTicket(id++, 1500 + i, GameMode::Battleground, region));
+        }
+    }
+    for (int i = 0; i < 20; ++i) {
+        (void)engine.enqueue(makeTicket(id++, 1500 + i, GameMode::Battleground, Region::Any));
+    }
+
+    std::vector<MatchResult> matches;
+    (void)engine.runCycle();
+    engine.drainMatches(matches);
+    EXPECT_EQ(batches, 1u);
+
+    std::set<uint64_t> seen;
+    for (const auto& match : matches) {
+        for (const auto& player : match.players) {
+            EXPECT_TRUE(seen.insert(player.playerId).second);
+        }
+    }
+    EXPECT_EQ(seen.size() + engine.queueSize(), 170u);
+
+    std::size_t formed = 0;
+    for (const auto& stats : engine.shardStats()) {
+        formed += stats.matchesFormed;
+    }
+    EXPECT_EQ(formed, matches.size());
+}
+
+TEST_F(MatchmakingEngineTest, ShardStatsReportRate) {
+    MatchmakingEngine engine(config_);
+    (void)engine.enqueue(makeTicket(1, 1500, GameMode::Dungeon, Region::Asia));
+    (void)engine.enqueue(makeTicket(2, 1500, GameMode::Dungeon, Region::Asia));
+    std::this_thread::sleep_for(5ms);
+    (void)engine.runCycle();
+
+    auto stats = engine.shardStats();
+    ASSERT_EQ(stats.size(), MatchmakingEngine::kShards);
+    for (const auto& s : stats) {
+        if (s.mode == GameMode::Dungeon && s.region == Region::Asia) {
+            EXPECT_EQ(s.matchesFormed, 1u);
+            EXPECT_GT(s.matchesPerSecond, 0.0);
+        } else {
+            EXPECT_EQ(s.matchesFormed, 0u);
+        }
+    }
+}
+
+TEST_F(MatchmakingQueueTest, TeamMatchIsBalanced) {
+    config_.minPlayersPerMatch = 6;
+    config_.maxPlayersPerMatch = 6;
+    config_.initialRatingTolerance = 400;
+    MatchmakingQueue arena(config_);
+    uint64_t id = 1;
+    for (int32_t mmr : {1800, 1750, 1500, 1450, 1400, 1300}) {
+        (void)arena.enqueue(makeTicket(id++, mmr, GameMode::Arena));
+    }
+
+    auto match = arena.tryMatch();
+    ASSERT_TRUE(match.has_value());
+    ASSERT_EQ(match->teams.size(), 6u);
+    int32_t sums[2] = {0, 0};
+    for (std::size_t i = 0; i < 6; ++i) {
+        sums[match->teams[i]] += match->players[i].rating.mmr;
+    }
+    EXPECT_LE(std::abs(sums[0] - sums[1]), 100);
+    EXPECT_GT(match->teamBalance, 0.95f);
+}
+
+TEST_F(MatchmakingQueueTest, FreeForAllHasNoTeams) {
+    config_.teamCount = 0;
+    MatchmakingQueue ffa(config_);
+    (void)ffa.enqueue(makeTicket(1, 1500));
+    (void)ffa.enqueue(makeTicket(2, 1510));
+
+    auto match = ffa.tryMatch();
+    ASSERT_TRUE(match.has_value());
+    EXPECT_TRUE(match->teams.empty());
+    EXPECT_FLOAT_EQ(match->teamBalance, 1.0f);
+}
@@ -7,6 +7,8 @@
 #include "cgs/service/lobby_types.hpp"
 #include "cgs/service/party_manager.hpp"
 
+#include <vector>
+
 using namespace cgs::service;
 using cgs::foundation::ErrorCode;
 
@@ -274,6 +276,84 @@ TEST_F(PartyManagerTest, AveragePartyRatingNotFound) {
     EXPECT_FALSE(avg.has_value());
 }
 
+TEST_F(PartyManagerTest, AveragePartyRatingTracksMemberChanges) {
+    auto partyId = pm_.createParty(1, "Alice", makeRating(1500));
+    (void)pm_.addMember(partyId.value(), 2, "Bob", makeRating(1700));
+    EXPECT_EQ(pm_.averagePartyRating(partyId.value()), 1600);
+
+    (void)pm_.addMember(partyId.value(), 3, "Charlie", makeRating(2000));
+    EXPECT_EQ(pm_.averagePartyRating(partyId.value()), 1733);
+
+    (void)pm_.removeMember(partyId.value(), 3);
+    EXPECT_EQ(pm_.averagePartyRating(partyId.value()), 1600);
+
+    (void)pm_.removeMember(partyId.value(), 2);
+    EXPECT_EQ(pm_.averagePartyRating(partyId.value()), 1500);
+}
+
+TEST_F(PartyManagerTest, SetReadyUpdatesReadyCount) {
+    auto partyId = pm_.createParty(1, "Alice", makeRating(1500));
+    (void)pm_.addMember(partyId.value(), 2, "Bob", makeRating(1500));
+    (void)pm_.addMember(partyId.value(), 3, "Charlie", makeRating(1500));
+    EXPECT_EQ(pm_.partySummary(partyId.value())->readyCount, 1u);  // leader
+
+    EXPECT_TRUE(pm_.setReady(partyId.value(), 2, true).hasValue());
+    EXPECT_TRUE(pm_.setReady(partyId.value(), 2, true).hasValue());  // no double count
+    EXPECT_EQ(pm_.partySummary(partyId.value())->readyCount, 2u);
+
+    (void)pm_.removeMember(partyId.value(), 2);
+    EXPECT_EQ(pm_.partySummary(partyId.value())->readyCount, 1u);
+
+    EXPECT_TRUE(pm_.setReady(partyId.value(), 1, false).hasValue());
+    EXPECT_EQ(pm_.partySummary(partyId.value())->readyCount, 0u);
+}
+
+TEST_F(PartyManagerTest, SetReadyErrors) {
+    auto partyId = pm_.createParty(1, "Alice", makeRating(1500));
+
+    auto missingParty = pm_.setReady(999, 1, true);
+    ASSERT_TRUE(missingParty.hasError());
+    EXPECT_EQ(missingParty.error().code(), ErrorCode::PartyNotFound);
+
+    auto missingMember = pm_.setReady(partyId.value(), 2, true);
+    ASSERT_TRUE(missingMember.hasError());
+    EXPECT_EQ(missingMember.error().code(), ErrorCode::PlayerNotInParty);
+}
+
+TEST_F(PartyManagerTest, PartySummaryMatchesParty) {
+    auto partyId = pm_.createParty(1, "Alice", makeRating(1500));
+    (void)pm_.addMember(partyId.value(), 2, "Bob", makeRating(1600));
+    (void)pm_.setInQueue(partyId.value(), true);
+
+    auto summary = pm_.partySummary(partyId.value());
+    ASSERT_TRUE(summary.has_value());
+    EXPECT_EQ(summary->id, partyId.value());
+    EXPECT_EQ(summary->leaderId, 1u);
+    EXPECT_EQ(summary->memberCount, 2u);
+    EXPECT_EQ(summary->averageRating, 1550);
+    EXPECT_EQ(summary->maxSize, 5u);
+    EXPECT_TRUE(summary->inQueue);
+
+    EXPECT_FALSE(pm_.partySummary(999).has_value());
+}
+
+TEST_F(PartyManagerTest, VisitPartyReadsInPlace) {
+    auto partyId = pm_.createParty(1, "Alice", makeRating(1500));
+    (void)pm_.addMember(partyId.value(), 2, "Bob", makeRating(1600));
+
+    std::vector<uint64_t> ids;
+    EXPECT_TRUE(pm_.visitParty(partyId.value(), [&](const Party& party) {
+        for (const auto& member : party.members) {
+            ids.push_back(member.playerId);
+        }
+    }));
+    EXPECT_EQ(ids, (std::vector<uint64_t>{1, 2}));
+
+    bool called = false;
+    EXPECT_FALSE(pm_.visitParty(999, [&](const Party&) { called = true; }));
+    EXPECT_FALSE(called);
+}
+
 TEST_F(PartyManagerTest, UniquePartyIds) {
     auto p1 = pm_.createParty(1, "Alice", makeRating(1500));
     (void)pm_.disbandParty(p1.value(), 1);
@@ -1,15 +1,22 @@
 /// @file persistence_test.cpp
 /// @brief Unit tests for WAL, SnapshotManager, PersistenceManager,
-///        and GracefulShutdown.
+///        GracefulShutdown and StartupGraph.
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cstring>
 #include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
 #include <string>
 #include <thread>
 #include <vector>
 
+#include "cgs/service/crc32c.hpp"
 #include "cgs/service/persistence_manager.hpp"
 #include "cgs/service/service_runner.hpp"
 #include "cgs/service/snapshot_manager.hpp"
@@ -243,6 +250,514 @@ TEST_F(WriteAheadLogTest, PersistenceAcrossReopen) {
     }
 }
 
+// ===========================================================================
+// CRC-32C
+// ===========================================================================
+
+TEST(Crc32cTest, KnownVectors) {
+    EXPECT_EQ(crc32c("", 0), 0u);
+    EXPECT_EQ(crc32c("123456789", 9), 0xE3069283u);
+
+    std::vector<uint8_t> zeros(32, 0x00);
+    std::vector<uint8_t> ones(32, 0xFF);
+    EXPECT_EQ(crc32c(zeros.data(), zeros.size()), 0x8A9136AAu);  // RFC 3720 B.4
+    EXPECT_EQ(crc32c(ones.data(), ones.size()), 0x62A8AB43u);
+}
+
+TEST(Crc32cTest, AcceleratedMatchesPortable) {
+    std::vector<uint8_t> data(1024);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(i * 131 + 7);
+    }
+    // Every small offset and length covers the unaligned heads and tails.
+    for (std::size_t offset = 0; offset < 9; ++offset) {
+        for (std::size_t length : {0u, 1u, 3u, 7u, 8u, 9u, 15u, 16u, 17u, 100u, 1000u}) {
+            EXPECT_EQ(crc32c(data.data() + offset, length),
+                      crc32cPortable(data.data() + offset, length))
+                << "offset " << offset << " length " << length;
+        }
+    }
+}
+
+TEST(Crc32cTest, Continues) {
+    const char text[] = "write-ahead log frame";
+    auto whole = crc32c(text, sizeof(text) - 1);
+    auto head = crc32c(text, 5);
+    EXPECT_EQ(crc32c(text + 5, sizeof(text) - 1 - 5, head), whole);
+    EXPECT_EQ(crc32cPortable(text + 5, sizeof(text) - 1 - 5, head), whole);
+}
+
+// ===========================================================================
+// WriteAheadLog: Group commit
+// ===========================================================================
+
+namespace {
+
+WalEntry makeEntry(uint64_t player) {
+    WalEntry entry;
+    entry.playerId = PlayerId(player);
+    entry.operation = WalOperation::StateUpdate;
+    entry.data = {static_cast<uint8_t>(player & 0xFF)};
+    return entry;
+}
+
+/// WAL segment files in @p dir, oldest first.
+std::vector<std::filesystem::path> segmentFiles(const std::filesystem::path& dir) {
+    std::vector<std::filesystem::path> files;
+    for (const auto& item : std::filesystem::directory_iterator(dir)) {
+        files.push_back(item.path());
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+}  // namespace
+
+TEST_F(WriteAheadLogTest, SyncedAppendsSurviveReopen) {
+    config_.syncOnWrite = true;
+    {
+        WriteAheadLog wal(config_);
+        ASSERT_TRUE(wal.open().hasValue());
+        for (uint64_t i = 1; i <= 3; ++i) {
+            auto result = wal.append(makeEntry(i));
+            ASSERT_TRUE(result.hasValue());
+            EXPECT_EQ(result.value(), i);
+        }
+        EXPECT_EQ(wal.syncCount(), 3u);  // No concurrency: one sync each.
+        EXPECT_EQ(wal.entryCount(), 3u);
+    }
+
+    WriteAheadLog wal(config_);
+    ASSERT_TRUE(wal.open().hasValue());
+    EXPECT_EQ(wal.entryCount(), 3u);
+    EXPECT_EQ(wal.currentSequence(), 3u);
+}
+
+TEST_F(WriteAheadLogTest, ConcurrentAppendsShareSyncs) {
+    config_.syncOnWrite = true;
+    config_.groupCommitDelay = std::chrono::milliseconds(1);
+
+    constexpr int kThreads = 8;
+    constexpr int kPerThread = 50;
+    std::vector<std::vector<uint64_t>> sequences(kThreads);
+    {
+        WriteAheadLog wal(config_);
+        ASSERT_TRUE(wal.open().hasValue());
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads; ++t) {
+            threads.emplace_back([&, t] {
+                for (int i = 0; i < kPerThread; ++i) {
+                    auto result = wal.append(makeEntry(static_cast<uint64_t>(t + 1)));
+                    ASSERT_TRUE(result.hasValue());
+                    sequences[static_cast<std::size_t>(t)].push_back(result.value());
+                }
+            });
+        }
+        for (auto& th : threads) {
+            th.join();
+        }
+
+        EXPECT_EQ(wal.entryCount(), static_cast<std::size_t>(kThreads * kPerThread));
+        EXPECT_LT(wal.syncCount(), static_cast<uint64_t>(kThreads * kPerThread));
+    }
+
+    std::vector<uint64_t> all;
+    for (const auto& seqs : sequences) {
+        EXPECT_TRUE(std::is_sorted(seqs.begin(), seqs.end()));
+        all.insert(all.end(), seqs.begin(), seqs.end());
+    }
+    std::sort(all.begin(), all.end());
+    for (std::size_t i = 0; i < all.size(); ++i) {
+        EXPECT_EQ(all[i], i + 1);
+    }
+
+    WriteAheadLog wal(config_);
+    ASSERT_TRUE(wal.open().hasValue());
+    uint64_t expected = 1;
+    auto result = wal.replay(0, [&](const WalEntry& e) { EXPECT_EQ(e.sequence, expected++); });
+    ASSERT_TRUE(result.hasValue());
+    EXPECT_EQ(result.value(), static_cast<uint64_t>(kThreads * kPerThread));
+}
+
+TEST_F(WriteAheadLogTest, AppendBatchTakesConsecutiveSequences) {
+    config_.syncOnWrite = true;
+    WriteAheadLog wal(config_);
+    ASSERT_TRUE(wal.open().hasValue());
+    ASSERT_TRUE(wal.append(makeEntry(1)).hasValue());
+
+    std::vector<WalEntry> batch{makeEntry(2), makeEntry(3), makeEntry(4)};
+    auto result = wal.appendBatch(batch);
+    ASSERT_TRUE(result.hasValue());
+    EXPECT_EQ(result.value(), 2u);
+    EXPECT_EQ(wal.currentSequence(), 4u);
+    EXPECT_EQ(wal.syncCount(), 2u);  // One per call.
+
+    uint64_t expected = 1;
+    ASSERT_TRUE(wal.replay(0, [&](const WalEntry& e) {
+                       EXPECT_EQ(e.sequence, expected);
+                       EXPECT_EQ(e.playerId, PlayerId(expected));
+                       ++expected;
+                   })
+                    .hasValue());
+    EXPECT_EQ(expected, 5u);
+}
+
+TEST_F(WriteAheadLogTest, FlushWritesBufferedEntries) {
+    WriteAheadLog wal(config_);
+    ASSERT_TRUE(wal.open().hasValue());
+    ASSERT_TRUE(wal.append(makeEntry(1)).hasValue());
+    ASSERT_TRUE(wal.append(makeEntry(2)).hasValue());
+    ASSERT_TRUE(wal.flush().hasValue());
+
+    // A second reader sees the entries without the writer closing.
+    WriteAheadLog reader(config_);
+    ASSERT_TRUE(reader.open().hasValue());
+    EXPECT_EQ(reader.entryCount(), 2u);
+}
+
+TEST_F(WriteAheadLogTest, TornTailIsTrimmedOnOpen) {
+    {
+        WriteAheadLog wal(config_);
+        ASSERT_TRUE(wal.open().hasValue());
+        ASSERT_TRUE(wal.append(makeEntry(1)).hasValue());
+        ASSERT_TRUE(wal.append(makeEntry(2)).hasValue());
+    }
+    {
+        // Half a frame, as left by a crash mid-write.
+        std::ofstream out(segmentFiles(config_.directory).back(),
+                          std::ios::binary | std::ios::app);
+        const char torn[] = {0x40, 0x00, 0x00, 0x00, 0x07};
+        out.write(torn, sizeof(torn));
+    }
+    {
+        WriteAheadLog wal(config_);
+        ASSERT_TRUE(wal.open().hasValue());
+        EXPECT_EQ(wal.entryCount(), 2u);
+        ASSERT_TRUE(wal.append(makeEntry(3)).hasValue());
+    }
+
+    WriteAheadLog wal(config_);
+    ASSERT_TRUE(wal.open().hasValue());
+    EXPECT_EQ(wal.entryCount(), 3u);
+    EXPECT_EQ(wal.currentSequence(), 3u);
+}
+
+// ===========================================================================
+// WriteAheadLog: Segments
+// ===========================================================================
+
+// Frames of makeEntry() are 4 + 29 + 1 + 4 = 38 bytes: three per segment
+// after the 8-byte header.
+class WriteAheadLogSegmentTest : public WriteAheadLogTest {
+protected:
+    void SetUp() override { config_.maxFileSize = 8 + 3 * 38; }
+
+    void appendEntries(WriteAheadLog& wal, uint64_t count) {
+        for (uint64_t i = 0; i < count; ++i) {
+            ASSERT_TRUE(wal.append(makeEntry(i + 1)).hasValue());
+        }
+    }
+};
+
+TEST_F(WriteAheadLogSegmentTest, RollsOverAtMaxFileSize) {
+    {
+        WriteAheadLog wal(config_);
+        ASSERT_TRUE(wal.open().hasValue());
+        appendEntries(wal, 10);
+        EXPECT_EQ(wal.segmentCount(), 4u);
+    }
+
+    auto files = segmentFiles(config_.directory);
+    ASSERT_EQ(files.size(), 4u);
+    EXPECT_EQ(files[0].filename(), "wal-00000000000000000001.bin");
+    EXPECT_EQ(files[1].filename(), "wal-00000000000000000004.bin");
+    EXPECT_EQ(files[3].filename(), "wal-00000000000000000010.bin");
+    EXPECT_EQ(std::filesystem::file_size(files[0]), 8u + 3u * 38u);
+
+    WriteAheadLog wal(config_);
+    ASSERT_TRUE(wal.open().hasValue());
+    EXPECT_EQ(wal.entryCount(), 10u);
+    EXPECT_EQ(wal.segmentCount(), 4u);
+    uint64_t expected = 1;
+    (void)wal.replay(0, [&](const WalEntry& e) { EXPECT_EQ(e.sequence, expected++); });
+    EXPECT_EQ(expected, 11u);
+}
+
+TEST_F(WriteAheadLogSegmentTest, TruncateUnlinksCoveredSegments) {
+    WriteAheadLog wal(config_);
+    ASSERT_TRUE(wal.open().hasValue());
+    appendEntries(wal, 10);
+
+    // Segments hold 1-3, 4-6, 7-9, 10: 7 covers only the first two.
+    ASSERT_TRUE(wal.truncateBefore(7).hasValue());
+    EXPECT_EQ(wal.entryCount(), 3u);
+    EXPECT_EQ(wal.segmentCount(), 2u);
+    auto files = segmentFiles(config_.directory);
+    ASSERT_EQ(files.size(), 2u);
+    EXPECT_EQ(files[0].filename(), "wal-00000000000000000007.bin");
+
+    std::vector<uint64_t> remaining;
+    (void)wal.replay(0, [&](const WalEntry& e) { remaining.push_back(e.sequence); });
+    EXPECT_EQ(remaining, (std::vector<uint64_t>{8, 9, 10}));
+}
+
+TEST_F(WriteAheadLogSegmentTest, TruncateAllKeepsSequence) {
+    {
+        WriteAheadLog wal(config_);
+        ASSERT_TRUE(wal.open().hasValue());
+        appendEntries(wal, 5);
+        ASSERT_TRUE(wal.truncateBefore(wal.currentSequence()).hasValue());
+        EXPECT_EQ(wal.entryCount(), 0u);
+        EXPECT_EQ(wal.segmentCount(), 1u);
+    }
+
+    // Only an empty segment named after the next sequence is left.
+    auto files = segmentFiles(config_.directory);
+    ASSERT_EQ(files.size(), 1u);
+    EXPECT_EQ(files[0].filename(), "wal-00000000000000000006.bin");
+
+    WriteAheadLog wal(config_);
+    ASSERT_TRUE(wal.open().hasValue());
+    EXPECT_EQ(wal.currentSequence(), 5u);
+    auto result = wal.append(makeEntry(1));
+    ASSERT_TRUE(result.hasValue());
+    EXPECT_EQ(result.value(), 6u);
+}
+
+TEST_F(WriteAheadLogSegmentTest, AdoptsSingleFileLog) {
+    {
+        WriteAheadLog wal(config_);
+        ASSERT_TRUE(wal.open().hasValue());
+        appendEntries(wal, 2);
+    }
+    std::filesystem::rename(segmentFiles(config_.directory).front(),
+                            config_.directory / "wal.bin");
+
+    WriteAheadLog wal(config_);
+    ASSERT_TRUE(wal.open().hasValue());
+    EXPECT_EQ(wal.entryCount(), 2u);
+    EXPECT_FALSE(std::filesystem::exists(config_.directory / "wal.bin"));
+    EXPECT_TRUE(std::filesystem::exists(config_.directory / "wal-00000000000000000001.bin"));
+}
+
+namespace {
+
+/// CRC32 (ISO 3309) as written by format version 1.
+uint32_t legacyCrc32(const uint8_t* data, std::size_t length) {
+    uint32_t crc = 0xFFFFFFFF;
+    for (std::size_t i = 0; i < length; ++i) {
+        crc ^= data[i];
+        for (int j = 0; j < 8; ++j) {
+            crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320u : 0u);
+        }
+    }
+    return crc ^ 0xFFFFFFFF;
+}
+
+/// A version 1 frame (no segment header, CRC32) for @p sequence.
+std::vector<uint8_t> legacyFrame(uint64_t sequence, uint64_t player) {
+    std::vector<uint8_t> body(8 + 8 + 8 + 1 + 4 + 1);
+    uint64_t timestamp = 1;
+    uint32_t dataSize = 1;
+    std::memcpy(body.data(), &sequence, 8);
+    std::memcpy(body.data() + 8, &timestamp, 8);
+    std::memcpy(body.data() + 16, &player, 8);
+    body[24] = static_cast<uint8_t>(WalOperation::StateUpdate);
+    std::memcpy(body.data() + 25, &dataSize, 4);
+    body[29] = static_cast<uint8_t>(player);
+
+    uint32_t totalSize = static_cast<uint32_t>(body.size() + 4);
+    uint32_t crc = legacyCrc32(body.data(), body.size());
+    std::vector<uint8_t> frame(4);
+    std::memcpy(frame.data(), &totalSize, 4);
+    frame.insert(frame.end(), body.begin(), body.end());
+    frame.resize(frame.size() + 4);
+    std::memcpy(frame.data() + frame.size() - 4, &crc, 4);
+    return frame;
+}
+
+}  // namespace
+
+TEST_F(WriteAheadLogSegmentTest, ReadsVersion1Log) {
+    std::filesystem::create_directories(config_.directory);
+    {
+        std::ofstream out(config_.directory / "wal.bin", std::ios::binary);
+        for (uint64_t seq = 1; seq <= 2; ++seq) {
+            auto frame = legacyFrame(seq, seq * 10);
+            out.write(reinterpret_cast<const char*>(frame.data()),
+                      static_cast<std::streamsize>(frame.size()));
+        }
+    }
+    {
+        WriteAheadLog wal(config_);
+        ASSERT_TRUE(wal.open().hasValue());
+        EXPECT_EQ(wal.entryCount(), 2u);
+        auto result = wal.append(makeEntry(3));
+        ASSERT_TRUE(result.hasValue());
+        EXPECT_EQ(result.value(), 3u);
+        EXPECT_EQ(wal.segmentCount(), 2u);  // New entries start a version 2 segment.
+    }
+
+    WriteAheadLog wal(config_);
+    ASSERT_TRUE(wal.open().hasValue());
+    std::vector<uint64_t> players;
+    (void)wal.replay(0, [&](const WalEntry& e) { players.push_back(e.playerId.value()); });
+    EXPECT_EQ(players, (std::vector<uint64_t>{10, 20, 3}));
+}
+
+TEST_F(WriteAheadLogSegmentTest, PreallocationKeepsLogicalSize) {
+    config_.syncOnWrite = true;
+    config_.preallocateSegments = true;
+    {
+        WriteAheadLog wal(config_);
+        ASSERT_TRUE(wal.open().hasValue());
+        appendEntries(wal, 4);
+    }
+
+    auto files = segmentFiles(config_.directory);
+    ASSERT_EQ(files.size(), 2u);
+    EXPECT_EQ(std::filesystem::file_size(files[1]), 8u + 38u);
+
+    WriteAheadLog wal(config_);
+    ASSERT_TRUE(wal.open().hasValue());
+    EXPECT_EQ(wal.entryCount(), 4u);
+}
+
+// ===========================================================================
+// WriteAheadLog: Recovery scan and compaction
+// ===========================================================================
+
+TEST_F(WriteAheadLogTest, ParallelScanKeepsSequenceOrder) {
+    constexpr uint64_t kEntries = 20000;  // Enough frames for several scan workers.
+    {
+        WriteAheadLog wal(config_);
+        ASSERT_TRUE(wal.open().hasValue());
+        for (uint64_t i = 1; i <= kEntries; ++i) {
+            ASSERT_TRUE(wal.append(makeEntry(i)).hasValue());
+        }
+    }
+
+    for (std::size_t threads : {1u, 4u}) {
+        config_.replayThreads = threads;
+        WriteAheadLog wal(config_);
+        ASSERT_TRUE(wal.open().hasValue());
+        EXPECT_EQ(wal.entryCount(), kEntries);
+
+        uint64_t expected = 1;
+        bool inOrder = true;
+        (void)wal.replay(0, [&](const WalEntry& e) {
+            inOrder = inOrder && e.sequence == expected && e.playerId.value() == expected;
+            ++expected;
+        });
+        EXPECT_TRUE(inOrder) << threads << " threads";
+        EXPECT_EQ(expected, kEntries + 1);
+    }
+}
+
+TEST_F(WriteAheadLogTest, ParallelScanStopsAtCorruptFrame) {
+    constexpr uint64_t kEntries = 20000;
+    {
+        WriteAheadLog wal(config_);
+        ASSERT_TRUE(wal.open().hasValue());
+        for (uint64_t i = 1; i <= kEntries; ++i) {
+            ASSERT_TRUE(wal.append(makeEntry(i)).hasValue());
+        }
+    }
+
+    // Flip the data byte of entry 15000 (38-byte frames after the header).
+    auto segment = segmentFiles(config_.directory).back();
+    {
+        std::fstream file(segment, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(8 + 38 * 14999 + 33);
+        file.put('\x55');
+    }
+
+    config_.replayThreads = 4;
+    WriteAheadLog wal(config_);
+    ASSERT_TRUE(wal.open().hasValue());
+    EXPECT_EQ(wal.entryCount(), 14999u);
+    EXPECT_EQ(std::filesystem::file_size(segment), 8u + 38u * 14999u);
+
+    auto result = wal.append(makeEntry(1));
+    ASSERT_TRUE(result.hasValue());
+    EXPECT_EQ(result.value(), 15000u);
+}
+
+TEST_F(WriteAheadLogTest, ReplayCompactedKeepsLastFullState) {
+    WriteAheadLog wal(config_);
+    ASSERT_TRUE(wal.open().hasValue());
+
+    auto append = [&](uint64_t player, WalOperation op) {
+        auto entry = makeEntry(player);
+        entry.operation = op;
+        ASSERT_TRUE(wal.append(entry).hasValue());
+    };
+    append(1, WalOperation::StateUpdate);      // 1: superseded by 4
+    append(2, WalOperation::StateUpdate);      // 2
+    append(1, WalOperation::InventoryChange);  // 3: not compacted
+    append(1, WalOperation::StateUpdate);      // 4
+    append(1, WalOperation::InventoryChange);  // 5
+
+    std::vector<uint64_t> delivered;
+    auto collect = [&](const WalEntry& e) { delivered.push_back(e.sequence); };
+
+    auto result = wal.replayCompacted(0, {WalOperation::StateUpdate}, collect);
+    ASSERT_TRUE(result.hasValue());
+    EXPECT_EQ(result.value(), 4u);
+    EXPECT_EQ(delivered, (std::vector<uint64_t>{2, 3, 4, 5}));
+
+    delivered.clear();
+    (void)wal.replayCompacted(
+        0, {WalOperation::StateUpdate, WalOperation::InventoryChange}, collect);
+    EXPECT_EQ(delivered, (std::vector<uint64_t>{2, 4, 5}));
+
+    delivered.clear();
+    (void)wal.replayCompacted(3, {WalOperation::StateUpdate}, collect);
+    EXPECT_EQ(delivered, (std::vector<uint64_t>{4, 5}));
+}
+
+TEST_F(WriteAheadLogTest, IoUringGroupCommitsSurviveReopen) {
+    // Same results with or without io_uring in this kernel; the ring only
+    // changes how each group commit reaches the disk.
+    config_.syncOnWrite = true;
+    config_.useIoUring = true;
+    config_.maxFileSize = 4096;  // Roll over a few segments along the way.
+
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 100;
+    {
+        WriteAheadLog wal(config_);
+        ASSERT_TRUE(wal.open().hasValue());
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads; ++t) {
+            threads.emplace_back([&, t] {
+                for (int i = 0; i < kPerThread; ++i) {
+                    ASSERT_TRUE(wal.append(makeEntry(static_cast<uint64_t>(t + 1))).hasValue());
+                }
+            });
+        }
+        for (auto& th : threads) {
+            th.join();
+        }
+        EXPECT_GT(wal.segmentCount(), 1u);
+        wal.close();
+        EXPECT_FALSE(wal.ioUringActive());
+    }
+
+    WriteAheadLog wal(config_);
+    ASSERT_TRUE(wal.open().hasValue());
+    uint64_t expected = 1;
+    auto result = wal.replay(0, [&](const WalEntry& e) {
+        EXPECT_EQ(e.sequence, expected++);
+        ASSERT_EQ(e.data.size(), 1u);
+        EXPECT_EQ(e.data[0], static_cast<uint8_t>(e.playerId.value()));
+    });
+    ASSERT_TRUE(result.hasValue());
+    EXPECT_EQ(result.value(), static_cast<uint64_t>(kThreads * kPerThread));
+}
+
 // ===========================================================================
 // SnapshotManager: Basic operations
 // ===========================================================================
@@ -366,6 +881,238 @@ TEST_F(SnapshotManagerTest, LoadReturnsErrorWhenEmpty) {
     mgr.close();
 }
 
+TEST_F(SnapshotManagerTest, DetectsCorruption) {
+    SnapshotManager mgr(config_);
+    ASSERT_TRUE(mgr.open().hasValue());
+
+    Snapshot snap;
+    snap.walSequence = 7;
+    snap.timestampUs = 1000000;
+    snap.players.push_back({PlayerId(1), 1, {1, 2, 3, 4}});
+    ASSERT_TRUE(mgr.save(snap).hasValue());
+
+    auto path = config_.directory / "snapshot_1000000.bin";
+    auto corruptAt = [&](std::streamoff offset, std::ios::seekdir dir) {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(offset, dir);
+        file.put('\x7F');
+    };
+
+    corruptAt(8 + 16, std::ios::beg);  // Inside the player data of the only block.
+
+    auto loadResult = mgr.loadLatest();
+    ASSERT_TRUE(loadResult.hasError());
+    EXPECT_EQ(loadResult.error().code(), ErrorCode::SnapshotCorrupted);
+
+    // The index is intact: the file opens and the damage shows per block.
+    auto reader = mgr.openLatest();
+    ASSERT_TRUE(reader.hasValue());
+    auto player = reader.value().loadPlayer(PlayerId(1));
+    ASSERT_TRUE(player.hasError());
+    EXPECT_EQ(player.error().code(), ErrorCode::SnapshotCorrupted);
+
+    corruptAt(-1, std::ios::end);  // Index checksum.
+    reader = mgr.openLatest();
+    ASSERT_TRUE(reader.hasError());
+    EXPECT_EQ(reader.error().code(), ErrorCode::SnapshotCorrupted);
+}
+
+TEST_F(SnapshotManagerTest, LoadsSinglePlayerFromItsBlock) {
+    config_.blockSize = 1024;
+    SnapshotManager mgr(config_);
+    ASSERT_TRUE(mgr.open().hasValue());
+
+    Snapshot snap;
+    snap.walSequence = 5;
+    snap.timestampUs = 1000000;
+    std::size_t rawBytes = 0;
+    for (uint64_t i = 1; i <= 100; ++i) {
+        // Descending ids: the index is sorted, the blocks keep save order.
+        PlayerSnapshot p{PlayerId(101 - i), 1, std::vector<uint8_t>(200, static_cast<uint8_t>(i))};
+        rawBytes += p.data.size();
+        snap.players.push_back(std::move(p));
+    }
+    ASSERT_TRUE(mgr.save(snap).hasValue());
+
+    auto fileSize = std::filesystem::file_size(config_.directory / "snapshot_1000000.bin");
+    EXPECT_LT(fileSize, rawBytes / 4);  // Repetitive data compresses.
+
+    auto reader = mgr.openLatest();
+    ASSERT_TRUE(reader.hasValue());
+    EXPECT_EQ(reader.value().walSequence(), 5u);
+    EXPECT_TRUE(reader.value().contains(PlayerId(57)));
+    EXPECT_FALSE(reader.value().contains(PlayerId(1000)));
+
+    auto ids = reader.value().playerIds();
+    ASSERT_EQ(ids.size(), 100u);
+    EXPECT_TRUE(std::is_sorted(ids.begin(), ids.end()));
+
+    auto player = reader.value().loadPlayer(PlayerId(57));
+    ASSERT_TRUE(player.hasValue());
+    EXPECT_EQ(player.value().data, std::vector<uint8_t>(200, 44));
+
+    auto missing = reader.value().loadPlayer(PlayerId(1000));
+    ASSERT_TRUE(missing.hasError());
+    EXPECT_EQ(missing.error().code(), ErrorCode::NotFound);
+
+    auto all = mgr.loadLatest();
+    ASSERT_TRUE(all.hasValue());
+    ASSERT_EQ(all.value().players.size(), 100u);
+    EXPECT_EQ(all.value().players.front().playerId, PlayerId(100));
+    EXPECT_EQ(all.value().players.back().playerId, PlayerId(1));
+}
+
+TEST_F(SnapshotManagerTest, ReaderResolvesIncrementalSnapshot) {
+    SnapshotManager mgr(config_);
+    ASSERT_TRUE(mgr.open().hasValue());
+
+    Snapshot base;
+    base.walSequence = 10;
+    base.timestampUs = 1000000;
+    base.players.push_back({PlayerId(1), 1, {0x01}});
+    base.players.push_back({PlayerId(2), 1, {0x02}});
+    base.players.push_back({PlayerId(3), 1, {0x03}});
+    ASSERT_TRUE(mgr.save(base).hasValue());
+
+    Snapshot delta;
+    delta.incremental = true;
+    delta.baseSequence = 10;
+    delta.walSequence = 12;
+    delta.timestampUs = 1000001;
+    delta.players.push_back({PlayerId(2), 1, {0x22}});
+    delta.players.push_back({PlayerId(4), 1, {0x04}});
+    delta.removedPlayers.push_back(PlayerId(3));
+    ASSERT_TRUE(mgr.save(delta).hasValue());
+
+    auto reader = mgr.openLatest();
+    ASSERT_TRUE(reader.hasValue());
+    const auto& r = reader.value();
+    EXPECT_EQ(r.walSequence(), 12u);
+    EXPECT_EQ(r.playerIds(), (std::vector<PlayerId>{PlayerId(1), PlayerId(2), PlayerId(4)}));
+    EXPECT_FALSE(r.contains(PlayerId(3)));
+    EXPECT_EQ(r.loadPlayer(PlayerId(1)).value().data, (std::vector<uint8_t>{0x01}));
+    EXPECT_EQ(r.loadPlayer(PlayerId(2)).value().data, (std::vector<uint8_t>{0x22}));
+    EXPECT_EQ(r.loadPlayer(PlayerId(3)).error().code(), ErrorCode::NotFound);
+}
+
+TEST_F(SnapshotManagerTest, LoadsVersion1Snapshot) {
+    SnapshotManager mgr(config_);
+    ASSERT_TRUE(mgr.open().hasValue());
+
+    // Version 1: walSequence, timestampUs, playerCount, players; no header.
+    std::vector<uint8_t> body(8 + 8 + 4 + 8 + 4 + 4 + 2);
+    uint64_t walSequence = 9;
+    uint64_t timestampUs = 500;
+    uint32_t count = 1;
+    uint64_t pid = 42;
+    uint32_t instance = 3;
+    uint32_t dataSize = 2;
+    std::memcpy(body.data(), &walSequence, 8);
+    std::memcpy(body.data() + 8, &timestampUs, 8);
+    std::memcpy(body.data() + 16, &count, 4);
+    std::memcpy(body.data() + 20, &pid, 8);
+    std::memcpy(body.data() + 28, &instance, 4);
+    std::memcpy(body.data() + 32, &dataSize, 4);
+    body[36] = 0xAB;
+    body[37] = 0xCD;
+    {
+        std::ofstream out(config_.directory / "snapshot_500.bin", std::ios::binary);
+        out.write(reinterpret_cast<const char*>(body.data()),
+                  static_cast<std::streamsize>(body.size()));
+    }
+
+    auto loadResult = mgr.loadLatest();
+    ASSERT_TRUE(loadResult.hasValue());
+    EXPECT_EQ(loadResult.value().walSequence, 9u);
+    ASSERT_EQ(loadResult.value().players.size(), 1u);
+    EXPECT_EQ(loadResult.value().players[0].playerId, PlayerId(42));
+    EXPECT_EQ(loadResult.value().players[0].data, (std::vector<uint8_t>{0xAB, 0xCD}));
+}
+
+TEST_F(SnapshotManagerTest, MergesIncrementalSnapshot) {
+    SnapshotManager mgr(config_);
+    ASSERT_TRUE(mgr.open().hasValue());
+
+    Snapshot base;
+    base.walSequence = 10;
+    base.timestampUs = 1000000;
+    base.players.push_back({PlayerId(1), 1, {0x01}});
+    base.players.push_back({PlayerId(2), 1, {0x02}});
+    base.players.push_back({PlayerId(3), 1, {0x03}});
+    ASSERT_TRUE(mgr.save(base).hasValue());
+
+    for (uint64_t i = 1; i <= 2; ++i) {
+        Snapshot delta;
+        delta.incremental = true;
+        delta.baseSequence = 10;
+        delta.walSequence = 10 + i;
+        delta.timestampUs = 1000000 + i;
+        delta.players.push_back({PlayerId(2), 1, {static_cast<uint8_t>(0x20 + i)}});
+        delta.removedPlayers.push_back(PlayerId(3));
+        ASSERT_TRUE(mgr.save(delta).hasValue());
+    }
+
+    // Incremental snapshots are cumulative: only the newest is kept.
+    EXPECT_EQ(mgr.snapshotCount(), 1u);
+    EXPECT_EQ(mgr.incrementalCount(), 1u);
+
+    auto loadResult = mgr.loadLatest();
+    ASSERT_TRUE(loadResult.hasValue());
+    const auto& merged = loadResult.value();
+    EXPECT_FALSE(merged.incremental);
+    EXPECT_EQ(merged.walSequence, 12u);
+    ASSERT_EQ(merged.players.size(), 2u);
+    EXPECT_EQ(merged.players[0].playerId, PlayerId(1));
+    EXPECT_EQ(merged.players[1].playerId, PlayerId(2));
+    EXPECT_EQ(merged.players[1].data, (std::vector<uint8_t>{0x22}));
+
+    // A new full snapshot supersedes the incremental one.
+    base.walSequence = 20;
+    base.timestampUs = 2000000;
+    ASSERT_TRUE(mgr.save(base).hasValue());
+    EXPECT_EQ(mgr.incrementalCount(), 0u);
+}
+
+TEST_F(SnapshotManagerTest, IgnoresIncrementalOfOtherBase) {
+    SnapshotManager mgr(config_);
+    ASSERT_TRUE(mgr.open().hasValue());
+
+    Snapshot base;
+    base.walSequence = 10;
+    base.timestampUs = 1000000;
+    base.players.push_back({PlayerId(1), 1, {0x01}});
+    ASSERT_TRUE(mgr.save(base).hasValue());
+
+    Snapshot delta;
+    delta.incremental = true;
+    delta.baseSequence = 5;
+    delta.walSequence = 12;
+    delta.timestampUs = 1000001;
+    delta.removedPlayers.push_back(PlayerId(1));
+    ASSERT_TRUE(mgr.save(delta).hasValue());
+
+    auto loadResult = mgr.loadLatest();
+    ASSERT_TRUE(loadResult.hasValue());
+    EXPECT_EQ(loadResult.value().walSequence, 10u);
+    EXPECT_EQ(loadResult.value().players.size(), 1u);
+}
+
+TEST_F(SnapshotManagerTest, SaveLeavesNoTemporaryFile) {
+    SnapshotManager mgr(config_);
+    ASSERT_TRUE(mgr.open().hasValue());
+
+    Snapshot snap;
+    snap.walSequence = 1;
+    snap.timestampUs = 1000000;
+    ASSERT_TRUE(mgr.save(snap).hasValue());
+
+    std::vector<std::string> names;
+    for (const auto& entry : std::filesystem::directory_iterator(config_.directory)) {
+        names.push_back(entry.path().filename().string());
+    }
+    EXPECT_EQ(names, (std::vector<std::string>{"snapshot_1000000.bin"}));
+}
+
 TEST_F(SnapshotManagerTest, EmptyPlayerList) {
     SnapshotManager mgr(config_);
     ASSERT_TRUE(mgr.open().hasValue());
@@ -385,6 +1132,44 @@ TEST_F(SnapshotManagerTest, EmptyPlayerList) {
     mgr.close();
 }
 
+TEST_F(SnapshotManagerTest, IoUringSaveRoundTrips) {
+    config_.useIoUring = true;
+    config_.blockSize = 256;  // Many blocks, each submitted as it is encoded.
+    SnapshotManager mgr(config_);
+    ASSERT_TRUE(mgr.open().hasValue());
+
+    Snapshot snap;
+    snap.walSequence = 7;
+    snap.timestampUs = 1000000;
+    for (uint64_t i = 1; i <= 200; ++i) {
+        PlayerSnapshot p;
+        p.playerId = PlayerId(i);
+        p.instanceId = static_cast<uint32_t>(i % 3);
+        p.data.assign(static_cast<std::size_t>(i % 50) + 1, static_cast<uint8_t>(i));
+        snap.players.push_back(std::move(p));
+    }
+    ASSERT_TRUE(mgr.save(snap).hasValue());
+
+    std::vector<std::string> names;
+    for (const auto& entry : std::filesystem::directory_iterator(config_.directory)) {
+        names.push_back(entry.path().filename().string());
+    }
+    EXPECT_EQ(names, (std::vector<std::string>{"snapshot_1000000.bin"}));
+
+    auto loaded = mgr.loadLatest();
+    ASSERT_TRUE(loaded.hasValue());
+    EXPECT_EQ(loaded.value().walSequence, 7u);
+    ASSERT_EQ(loaded.value().players.size(), snap.players.size());
+    for (std::size_t i = 0; i < snap.players.size(); ++i) {
+        EXPECT_EQ(loaded.value().players[i].playerId, snap.players[i].playerId);
+        EXPECT_EQ(loaded.value().players[i].instanceId, snap.players[i].instanceId);
+        EXPECT_EQ(loaded.value().players[i].data, snap.players[i].data);
+    }
+
+    mgr.close();
+    EXPECT_FALSE(mgr.ioUringActive());
+}
+
 // ===========================================================================
 // PersistenceManager: Coordinated operations
 // ===========================================================================
@@ -514,6 +1299,264 @@ TEST_F(PersistenceManagerTest, ManualSnapshotAndRecovery) {
     }
 }
 
+TEST_F(PersistenceManagerTest, IncrementalSnapshotsHoldOnlyChangedPlayers) {
+    auto config = makeConfig();
+    config.fullSnapshotEvery = 3;
+
+    {
+        std::vector<PlayerSnapshot> worldState;
+        worldState.push_back({PlayerId(1), 10, {0xAA}});
+        worldState.push_back({PlayerId(2), 20, {0xBB}});
+        worldState.push_back({PlayerId(3), 30, {0xCC}});
+        std::vector<PlayerId> requested;
+
+        PersistenceManager pm(config);
+        ASSERT_TRUE(pm.start(
+            [&]() { return worldState; },
+            [&](const std::vector<PlayerId>& ids) {
+                requested = ids;
+                std::vector<PlayerSnapshot> states;
+                for (const auto& p : worldState) {
+                    if (std::find(ids.begin(), ids.end(), p.playerId) != ids.end()) {
+                        states.push_back(p);
+                    }
+                }
+                return states;
+            },
+            [](const Snapshot&) {},
+            [](const WalEntry&) {}
+        ).hasValue());
+
+        ASSERT_TRUE(pm.takeSnapshot().hasValue());  // Full.
+
+        worldState[1].data = {0xBD};
+        worldState.pop_back();
+        for (auto id : {PlayerId(2), PlayerId(3)}) {
+            WalEntry entry;
+            entry.playerId = id;
+            entry.operation = WalOperation::StateUpdate;
+            ASSERT_TRUE(pm.recordChange(entry).hasValue());
+        }
+
+        ASSERT_TRUE(pm.takeSnapshot().hasValue());  // Incremental.
+        std::sort(requested.begin(), requested.end());
+        EXPECT_EQ(requested, (std::vector<PlayerId>{PlayerId(2), PlayerId(3)}));
+
+        pm.stop();  // Incremental.
+    }
+
+    SnapshotManager snapshots(config.snapshot);
+    EXPECT_EQ(snapshots.snapshotCount(), 1u);
+    EXPECT_EQ(snapshots.incrementalCount(), 1u);
+
+    Snapshot recovered;
+    PersistenceManager pm(config);
+    ASSERT_TRUE(pm.start(
+        []() -> std::vector<PlayerSnapshot> { return {}; },
+        [&](const Snapshot& s) { recovered = s; },
+        [](const WalEntry&) {}
+    ).hasValue());
+
+    ASSERT_EQ(recovered.players.size(), 2u);
+    EXPECT_EQ(recovered.players[0].playerId, PlayerId(1));
+    EXPECT_EQ(recovered.players[1].playerId, PlayerId(2));
+    EXPECT_EQ(recovered.players[1].data, (std::vector<uint8_t>{0xBD}));
+
+    pm.stop();
+}
+
+TEST_F(PersistenceManagerTest, CaptureRunsCollectorOnCallingThread) {
+    auto config = makeConfig();
+    config.snapshotInterval = std::chrono::seconds(0);
+
+    std::thread::id collectorThread;
+    PersistenceManager pm(config);
+    ASSERT_TRUE(pm.start(
+        [&]() -> std::vector<PlayerSnapshot> {
+            collectorThread = std::this_thread::get_id();
+            return {{PlayerId(1), 10, {0xAA}}};
+        },
+        [](const Snapshot&) {},
+        [](const WalEntry&) {}
+    ).hasValue());
+
+    for (int i = 0; i < 3; ++i) {
+        WalEntry entry;
+        entry.playerId = PlayerId(1);
+        entry.operation = WalOperation::StateUpdate;
+        ASSERT_TRUE(pm.recordChange(entry).hasValue());
+    }
+
+    ASSERT_TRUE(pm.captureSnapshot().hasValue());
+    EXPECT_EQ(collectorThread, std::this_thread::get_id());
+
+    ASSERT_TRUE(pm.waitForSnapshots().hasValue());
+    EXPECT_EQ(pm.pendingWalEntries(), 0u);
+    EXPECT_EQ(SnapshotManager(config.snapshot).snapshotCount(), 1u);
+
+    pm.stop();
+}
+
+TEST_F(PersistenceManagerTest, FailedWriteKeepsWal) {
+    auto config = makeConfig();
+    config.snapshotInterval = std::chrono::seconds(0);
+
+    PersistenceManager pm(config);
+    ASSERT_TRUE(pm.start(
+        []() -> std::vector<PlayerSnapshot> { return {}; },
+        [](const Snapshot&) {},
+        [](const WalEntry&) {}
+    ).hasValue());
+
+    // Replace the snapshot directory with a file so writes fail.
+    std::filesystem::remove_all(config.snapshot.directory);
+    std::ofstream(config.snapshot.directory).put('x');
+
+    WalEntry entry;
+    entry.playerId = PlayerId(1);
+    entry.operation = WalOperation::StateUpdate;
+    ASSERT_TRUE(pm.recordChange(entry).hasValue());
+
+    ASSERT_TRUE(pm.captureSnapshot().hasValue());
+    auto result = pm.waitForSnapshots();
+    ASSERT_TRUE(result.hasError());
+    EXPECT_EQ(result.error().code(), ErrorCode::SnapshotWriteFailed);
+    EXPECT_EQ(pm.pendingWalEntries(), 1u);
+
+    // Each failure is reported once.
+    EXPECT_TRUE(pm.waitForSnapshots().hasValue());
+
+    pm.stop();
+}
+
+TEST_F(PersistenceManagerTest, SubmittedChangesGetTheirTicketsAsSequences) {
+    auto config = makeConfig();
+    config.wal.syncOnWrite = true;
+    config.submitQueueCapacity = 64;
+
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 100;
+    std::vector<std::vector<std::pair<uint64_t, PlayerId>>> tickets(kThreads);
+    {
+        PersistenceManager pm(config);
+        ASSERT_TRUE(pm.start(
+            []() -> std::vector<PlayerSnapshot> { return {}; },
+            [](const Snapshot&) {},
+            [](const WalEntry&) {}
+        ).hasValue());
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads; ++t) {
+            threads.emplace_back([&, t] {
+                for (int i = 0; i < kPerThread; ++i) {
+                    WalEntry entry;
+                    entry.playerId = PlayerId(static_cast<uint64_t>(t * kPerThread + i + 1));
+                    entry.operation = WalOperation::StateUpdate;
+                    auto ticket = pm.submitChange(entry);
+                    ASSERT_TRUE(ticket.hasValue());
+                    tickets[static_cast<std::size_t>(t)].emplace_back(ticket.value(),
+                                                                      entry.playerId);
+                }
+            });
+        }
+        for (auto& th : threads) {
+            th.join();
+        }
+
+        auto last = tickets[0].back().first;
+        ASSERT_TRUE(pm.waitDurable(last).hasValue());
+        EXPECT_GE(pm.currentWalSequence(), last);
+
+        // recordChange() goes through the ring too and waits for its entry.
+        auto sequence = pm.recordChange(WalEntry{});
+        ASSERT_TRUE(sequence.hasValue());
+        EXPECT_EQ(sequence.value(), kThreads * kPerThread + 1u);
+        EXPECT_EQ(pm.submitQueueDepth(), 0u);
+
+        // Read the WAL before stop() snapshots and truncates it.
+        WriteAheadLog wal(config.wal);
+        ASSERT_TRUE(wal.open().hasValue());
+        std::vector<PlayerId> bySequence(kThreads * kPerThread + 2);
+        ASSERT_TRUE(
+            wal.replay(0, [&](const WalEntry& e) { bySequence[e.sequence] = e.playerId; })
+                .hasValue());
+        for (const auto& perThread : tickets) {
+            for (const auto& [ticket, player] : perThread) {
+                EXPECT_EQ(bySequence[ticket], player);
+            }
+        }
+
+        pm.stop();
+    }
+}
+
+TEST_F(PersistenceManagerTest, FullRingRejectsUnderRejectPolicy) {
+    auto config = makeConfig();
+    config.submitQueueCapacity = 2;
+    config.submitBackpressure = SubmitBackpressure::Reject;
+
+    PersistenceManager pm(config);
+    ASSERT_TRUE(pm.start(
+        []() -> std::vector<PlayerSnapshot> { return {}; },
+        [](const Snapshot&) {},
+        [](const WalEntry&) {}
+    ).hasValue());
+
+    std::size_t rejected = 0;
+    std::vector<uint64_t> accepted;
+    for (int i = 0; i < 10000; ++i) {
+        WalEntry entry;
+        entry.playerId = PlayerId(1);
+        auto ticket = pm.submitChange(entry);
+        if (ticket.hasError()) {
+            EXPECT_EQ(ticket.error().code(), ErrorCode::WalQueueFull);
+            ++rejected;
+        } else {
+            accepted.push_back(ticket.value());
+        }
+    }
+    EXPECT_GT(rejected, 0u);
+    ASSERT_FALSE(accepted.empty());
+    for (std::size_t i = 0; i < accepted.size(); ++i) {
+        EXPECT_EQ(accepted[i], i + 1);  // Rejected entries take no ticket.
+    }
+    ASSERT_TRUE(pm.waitDurable(accepted.back()).hasValue());
+    EXPECT_EQ(pm.currentWalSequence(), accepted.back());
+
+    pm.stop();
+}
+
+TEST_F(PersistenceManagerTest, StopDrainsSubmittedChanges) {
+    auto config = makeConfig();
+    config.submitQueueCapacity = 1024;
+
+    {
+        PersistenceManager pm(config);
+        ASSERT_TRUE(pm.start(
+            []() -> std::vector<PlayerSnapshot> { return {}; },
+            [](const Snapshot&) {},
+            [](const WalEntry&) {}
+        ).hasValue());
+        for (uint64_t i = 1; i <= 500; ++i) {
+            WalEntry entry;
+            entry.playerId = PlayerId(i);
+            ASSERT_TRUE(pm.submitChange(entry).hasValue());
+        }
+        pm.stop();
+        EXPECT_EQ(pm.currentWalSequence(), 500u);
+
+        WalEntry late;
+        auto ticket = pm.submitChange(late);
+        ASSERT_TRUE(ticket.hasError());
+        EXPECT_EQ(ticket.error().code(), ErrorCode::PersistenceNotStarted);
+    }
+
+    // The final snapshot covers all of them.
+    auto snapshot = SnapshotManager(config.snapshot).loadLatest();
+    ASSERT_TRUE(snapshot.hasValue());
+    EXPECT_EQ(snapshot.value().walSequence, 500u);
+}
+
 TEST_F(PersistenceManagerTest, DoubleStartFails) {
     PersistenceManager pm(makeConfig());
 
@@ -605,6 +1648,142 @@ TEST(GracefulShutdownTest, DrainTimeoutRespected) {
     EXPECT_GE(order.size(), 1u);
 }
 
+TEST(GracefulShutdownTest, ConcurrentHooksDrainInParallel) {
+    GracefulShutdown shutdown;
+    std::vector<int> order;
+    std::mutex orderMutex;
+    auto record = [&](int step) {
+        std::lock_guard lock(orderMutex);
+        order.push_back(step);
+    };
+
+    shutdown.addHook("readiness", [&]() { record(1); });
+    for (int i = 0; i < 3; ++i) {
+        shutdown.addConcurrentHook("drain", [&]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            record(2);
+        });
+    }
+    shutdown.addHook("stop", [&]() { record(3); });
+
+    auto started = std::chrono::steady_clock::now();
+    shutdown.execute();
+    auto elapsed = std::chrono::steady_clock::now() - started;
+
+    EXPECT_EQ(order, (std::vector<int>{1, 2, 2, 2, 3}));
+    EXPECT_LT(elapsed, std::chrono::milliseconds(500));
+}
+
+// ===========================================================================
+// StartupGraph: Dependency-ordered startup
+// ===========================================================================
+
+TEST(StartupGraphTest, IndependentStagesRunConcurrently) {
+    StartupGraph startup;
+    std::atomic<int> inFlight{0};
+    std::atomic<int> maxInFlight{0};
+    auto stage = [&]() -> GameResult<void> {
+        int now = ++inFlight;
+        int seen = maxInFlight.load();
+        while (now > seen && !maxInFlight.compare_exchange_weak(seen, now)) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        --inFlight;
+        return GameResult<void>::ok();
+    };
+    startup.addStage("db_pool", stage);
+    startup.addStage("cache", stage);
+    startup.addStage("plugins", stage);
+
+    auto started = std::chrono::steady_clock::now();
+    ASSERT_TRUE(startup.run().hasValue());
+    EXPECT_LT(std::chrono::steady_clock::now() - started, std::chrono::milliseconds(250));
+    EXPECT_EQ(maxInFlight.load(), 3);
+}
+
+TEST(StartupGraphTest, StagesWaitForTheirDependencies) {
+    StartupGraph startup;
+    std::mutex orderMutex;
+    std::vector<std::string> order;
+    auto stage = [&](std::string name) {
+        return [&, name]() -> GameResult<void> {
+            std::lock_guard lock(orderMutex);
+            order.push_back(name);
+            return GameResult<void>::ok();
+        };
+    };
+    startup.addStage("listeners", stage("listeners"), {"db_pool", "templates"});
+    startup.addWarmup("templates", stage("templates"), {"db_pool"});
+    startup.addStage("db_pool", stage("db_pool"));
+
+    ASSERT_TRUE(startup.run().hasValue());
+    EXPECT_EQ(order, (std::vector<std::string>{"db_pool", "templates", "listeners"}));
+
+    ASSERT_EQ(startup.results().size(), 3u);
+    EXPECT_EQ(startup.results()[1].kind, StartupStageKind::Warmup);
+    for (const auto& result : startup.results()) {
+        EXPECT_EQ(result.status, StartupStageResult::Status::Succeeded);
+    }
+}
+
+TEST(StartupGraphTest, FailedSubsystemSkipsDependents) {
+    StartupGraph startup;
+    bool listenersRan = false;
+    startup.addStage("db_pool", []() -> GameResult<void> {
+        return GameResult<void>::err(GameError(ErrorCode::ConnectionFailed, "no database"));
+    });
+    startup.addStage("listeners", [&]() -> GameResult<void> {
+        listenersRan = true;
+        return GameResult<void>::ok();
+    }, {"db_pool"});
+
+    auto result = startup.run();
+    ASSERT_TRUE(result.hasError());
+    EXPECT_EQ(result.error().code(), ErrorCode::ConnectionFailed);
+    EXPECT_FALSE(listenersRan);
+    EXPECT_EQ(startup.results()[0].status, StartupStageResult::Status::Failed);
+    EXPECT_EQ(startup.results()[1].status, StartupStageResult::Status::Skipped);
+}
+
+TEST(StartupGraphTest, FailedWarmupDoesNotBlockStartup) {
+    StartupGraph startup;
+    bool listenersRan = false;
+    startup.addWarmup("instance_pools", []() -> GameResult<void> {
+        throw std::runtime_error("template missing");
+    });
+    startup.addStage("listeners", [&]() -> GameResult<void> {
+        listenersRan = true;
+        return GameResult<void>::ok();
+    }, {"instance_pools"});
+
+    EXPECT_TRUE(startup.run().hasValue());
+    EXPECT_TRUE(listenersRan);
+    EXPECT_EQ(startup.results()[0].status, StartupStageResult::Status::Failed);
+}
+
+TEST(StartupGraphTest, RejectsInvalidGraphs) {
+    auto ok = []() -> GameResult<void> { return GameResult<void>::ok(); };
+
+    StartupGraph unknown;
+    unknown.addStage("listeners", ok, {"db_pool"});
+    auto result = unknown.run();
+    ASSERT_TRUE(result.hasError());
+    EXPECT_EQ(result.error().code(), ErrorCode::InvalidArgument);
+
+    StartupGraph cycle;
+    cycle.addStage("a", ok, {"b"});
+    cycle.addStage("b", ok, {"a"});
+    result = cycle.run();
+    ASSERT_TRUE(result.hasError());
+    EXPECT_EQ(result.error().code(), ErrorCode::InvalidArgument);
+    EXPECT_EQ(cycle.results()[0].status, StartupStageResult::Status::NotRun);
+
+    StartupGraph duplicate;
+    duplicate.addStage("a", ok);
+    duplicate.addStage("a", ok);
+    EXPECT_TRUE(duplicate.run().hasError());
+}
+
 // ===========================================================================
 // Integration: WAL + Snapshot recovery cycle
 // ===========================================================================
@@ -3,7 +3,9 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
 #include <chrono>
+#include <optional>
 #include <string>
 #include <thread>
 #include <vector>
@@ -14,6 +16,7 @@
 
 #include "cgs/service/circuit_breaker.hpp"
 #include "cgs/service/health_server.hpp"
+#include "cgs/service/service_placement.hpp"
 #include "cgs/foundation/game_metrics.hpp"
 
 using namespace cgs::service;
@@ -154,6 +157,108 @@ TEST_F(CircuitBreakerTest, FullCycleClosedOpenHalfOpenClosed) {
     EXPECT_EQ(cb_.state(), ServiceCircuitBreaker::State::Closed);
 }
 
+// ===========================================================================
+// Circuit Breaker: Failure-rate mode
+// ===========================================================================
+
+namespace {
+
+CircuitBreakerConfig rateConfig(std::chrono::milliseconds window) {
+    CircuitBreakerConfig config;
+    config.recoveryTimeout = std::chrono::seconds(1);
+    config.mode = CircuitBreakerMode::FailureRate;
+    config.failureRateThreshold = 0.5;
+    config.minimumRequests = 10;
+    config.window = window;
+    config.windowBuckets = 4;
+    config.name = "rate";
+    return config;
+}
+
+}  // namespace
+
+TEST(CircuitBreakerRateTest, OpensWhenFailureRateReachesThreshold) {
+    ServiceCircuitBreaker cb(rateConfig(std::chrono::seconds(60)));
+
+    // Consecutive failures do not matter, only their share of the calls.
+    for (int i = 0; i < 6; ++i) {
+        cb.recordSuccess();
+    }
+    for (int i = 0; i < 5; ++i) {
+        cb.recordFailure();
+    }
+    EXPECT_EQ(cb.state(), ServiceCircuitBreaker::State::Closed);
+    EXPECT_EQ(cb.failureCount(), 5u);
+    EXPECT_NEAR(cb.failureRate(), 5.0 / 11.0, 1e-9);
+
+    cb.recordFailure();  // 6 of 12.
+    EXPECT_EQ(cb.state(), ServiceCircuitBreaker::State::Open);
+    EXPECT_FALSE(cb.allowRequest());
+}
+
+TEST(CircuitBreakerRateTest, WaitsForMinimumRequests) {
+    ServiceCircuitBreaker cb(rateConfig(std::chrono::seconds(60)));
+    for (int i = 0; i < 9; ++i) {
+        cb.recordFailure();
+    }
+    EXPECT_EQ(cb.state(), ServiceCircuitBreaker::State::Closed);
+    cb.recordFailure();
+    EXPECT_EQ(cb.state(), ServiceCircuitBreaker::State::Open);
+}
+
+TEST(CircuitBreakerRateTest, OldCallsSlideOutOfTheWindow) {
+    ServiceCircuitBreaker cb(rateConfig(std::chrono::milliseconds(80)));
+    for (int i = 0; i < 9; ++i) {
+        cb.recordFailure();
+    }
+    EXPECT_EQ(cb.failureCount(), 9u);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    EXPECT_EQ(cb.failureCount(), 0u);
+    cb.recordFailure();
+    EXPECT_EQ(cb.state(), ServiceCircuitBreaker::State::Closed);
+}
+
+TEST(CircuitBreakerRateTest, ClosingClearsTheWindow) {
+    ServiceCircuitBreaker cb(rateConfig(std::chrono::seconds(60)));
+    for (int i = 0; i < 10; ++i) {
+        cb.recordFailure();
+    }
+    ASSERT_EQ(cb.state(), ServiceCircuitBreaker::State::Open);
+
+    cb.forceState(ServiceCircuitBreaker::State::HalfOpen);
+    cb.recordSuccess();
+    cb.recordSuccess();
+    ASSERT_EQ(cb.state(), ServiceCircuitBreaker::State::Closed);
+    EXPECT_EQ(cb.failureCount(), 0u);
+    EXPECT_DOUBLE_EQ(cb.failureRate(), 0.0);
+}
+
+TEST(CircuitBreakerRateTest, CountsCallsFromManyThreads) {
+    auto config = rateConfig(std::chrono::seconds(60));
+    config.minimumRequests = 1000000;  // Stay closed.
+    ServiceCircuitBreaker cb(config);
+
+    constexpr int kThreads = 8;
+    constexpr int kIterations = 5000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&cb] {
+            for (int i = 0; i < kIterations; ++i) {
+                if (i % 4 == 0) {
+                    cb.recordFailure();
+                } else {
+                    cb.recordSuccess();
+                }
+            }
+        });
+    }
+    for (auto& t : threads) { t.join(); }
+
+    EXPECT_EQ(cb.failureCount(), static_cast<uint32_t>(kThreads * kIterations / 4));
+    EXPECT_DOUBLE_EQ(cb.failureRate(), 0.25);
+}
+
 // ===========================================================================
 // Circuit Breaker: Thread safety
 // ===========================================================================
@@ -402,3 +507,147 @@ TEST_F(HealthServerTest, HealthzShowsDegradedComponents) {
 
     server.stop();
 }
+
+TEST_F(HealthServerTest, AddedEndpointReceivesQuery) {
+    constexpr uint16_t kPort = 19885;
+    HealthServer server({.port = kPort, .serviceName = "test-svc"}, metrics_);
+    server.addEndpoint("/debug/echo", [](std::string_view query) {
+        return "{\"query\":\"" + std::string(query) + "\"}";
+    });
+
+    auto result = server.start();
+    if (!result.hasValue()) { GTEST_SKIP() << "Port unavailable"; }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    auto response = httpGet(kPort, "/debug/echo?seconds=5");
+    EXPECT_TRUE(response.find("200 OK") != std::string::npos);
+    EXPECT_TRUE(response.find("application/json") != std::string::npos);
+    EXPECT_TRUE(response.find("{\"query\":\"seconds=5\"}") != std::string::npos);
+    EXPECT_TRUE(httpGet(kPort, "/debug/other").find("404") != std::string::npos);
+
+    server.stop();
+}
+
+// =============================================================================
+// ServicePlacement tests
+// =============================================================================
+
+namespace {
+
+constexpr uint64_t kPlacementKeys = 20000;
+
+std::vector<std::optional<PlacementNodeId>> placeAll(const ServicePlacement& placement) {
+    std::vector<std::optional<PlacementNodeId>> owners;
+    owners.reserve(kPlacementKeys);
+    for (uint64_t key = 0; key < kPlacementKeys; ++key) {
+        owners.push_back(placement.place(key));
+    }
+    return owners;
+}
+
+}  // namespace
+
+TEST(ServicePlacementTest, EmptyPlacementHasNoOwner) {
+    ServicePlacement placement;
+    EXPECT_FALSE(placement.place(uint64_t{42}).has_value());
+    EXPECT_FALSE(placement.place("map-1").has_value());
+}
+
+TEST(ServicePlacementTest, RejectsDuplicateNamesAndBadWeights) {
+    ServicePlacement placement;
+    ASSERT_TRUE(placement.addNode("a").has_value());
+    EXPECT_FALSE(placement.addNode("a").has_value());
+    EXPECT_FALSE(placement.addNode("b", 0.0).has_value());
+    EXPECT_FALSE(placement.addNode("c", -1.0).has_value());
+    EXPECT_FALSE(placement.setWeight(0, 0.0));
+    EXPECT_FALSE(placement.setState(7, PlacementNodeState::Draining));
+    EXPECT_EQ(placement.size(), 1u);
+    EXPECT_EQ(placement.find("a"), PlacementNodeId{0});
+}
+
+TEST(ServicePlacementTest, PlacementDependsOnNamesNotInsertionOrder) {
+    ServicePlacement forward;
+    ServicePlacement backward;
+    for (const char* name : {"game-1", "game-2", "game-3"}) {
+        (void)forward.addNode(name);
+    }
+    for (const char* name : {"game-3", "game-2", "game-1"}) {
+        (void)backward.addNode(name);
+    }
+    for (uint64_t key = 0; key < 1000; ++key) {
+        EXPECT_EQ(forward.node(*forward.place(key))->name,
+                  backward.node(*backward.place(key))->name);
+    }
+}
+
+TEST(ServicePlacementTest, AddingNodeMovesOnlyItsShare) {
+    ServicePlacement placement;
+    for (int i = 0; i < 4; ++i) {
+        (void)placement.addNode("node-" + std::to_string(i));
+    }
+    const auto before = placeAll(placement);
+    const auto added = placement.addNode("node-4");
+    const auto after = placeAll(placement);
+
+    uint64_t moved = 0;
+    for (uint64_t key = 0; key < kPlacementKeys; ++key) {
+        if (before[key] != after[key]) {
+            EXPECT_EQ(after[key], added);  // keys only move to the new node
+            ++moved;
+        }
+    }
+    // About 1/5 of the keys.
+    EXPECT_GT(moved, kPlacementKeys / 5 - kPlacementKeys / 25);
+    EXPECT_LT(moved, kPlacementKeys / 5 + kPlacementKeys / 25);
+}
+
+TEST(ServicePlacementTest, WeightScalesShare) {
+    ServicePlacement placement;
+    (void)placement.addNode("small", 1.0);
+    (void)placement.addNode("large", 3.0);
+
+    std::array<uint64_t, 2> counts{};
+    for (const auto& owner : placeAll(placement)) {
+        ++counts[*owner];
+    }
+    const double share = static_cast<double>(counts[1]) / kPlacementKeys;
+    EXPECT_NEAR(share, 0.75, 0.03);
+}
+
+TEST(ServicePlacementTest, DrainingMovesOnlyTheDrainedNodesKeys) {
+    ServicePlacement placement;
+    for (int i = 0; i < 3; ++i) {
+        (void)placement.addNode("node-" + std::to_string(i));
+    }
+    const auto before = placeAll(placement);
+    ASSERT_TRUE(placement.setState(1, PlacementNodeState::Draining));
+    const auto drained = placeAll(placement);
+
+    for (uint64_t key = 0; key < kPlacementKeys; ++key) {
+        EXPECT_NE(drained[key], PlacementNodeId{1});
+        if (before[key] != PlacementNodeId{1}) {
+            EXPECT_EQ(drained[key], before[key]);
+        }
+    }
+
+    // Removing the drained node afterwards moves nothing.
+    ASSERT_TRUE(placement.removeNode(1));
+    EXPECT_EQ(placeAll(placement), drained);
+    EXPECT_EQ(placement.size(), 2u);
+    EXPECT_FALSE(placement.node(1).has_value());
+
+    ASSERT_TRUE(placement.setState(0, PlacementNodeState::Draining));
+    ASSERT_TRUE(placement.setState(2, PlacementNodeState::Draining));
+    EXPECT_FALSE(placement.place(uint64_t{5}).has_value());
+}
+
+TEST(ServicePlacementTest, StringKeysHashStably) {
+    EXPECT_EQ(ServicePlacement::hashKey("map-1"), ServicePlacement::hashKey("map-1"));
+    EXPECT_NE(ServicePlacement::hashKey("map-1"), ServicePlacement::hashKey("map-2"));
+
+    ServicePlacement placement;
+    (void)placement.addNode("zone-a");
+    (void)placement.addNode("zone-b");
+    EXPECT_EQ(placement.place("map-1"), placement.place(ServicePlacement::hashKey("map-1")));
+}